@@ -31,6 +31,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <getopt.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
 #include "autotest/autotest.h"
 
 void usage()
@@ -49,6 +53,8 @@ void usage()
     printf("  -v            verbose\n");
     printf("  -q            quiet\n");
     printf("  -o <filename> output file (json)\n");
+    printf("  -j <n>        run tests in <n> parallel worker processes\n");
+    printf("  -b <seconds>  fail tests taking longer than <seconds> wall time\n");
 }
 
 // define autotest function pointer
@@ -66,6 +72,8 @@ typedef struct {
     float percent_passed;           // percent of checks that passed
     int executed;                   // was the test executed?
     int pass;                       // did the test pass? (i.e. no failures)
+    double elapsed;                 // wall-clock execution time [s]
+    int slow;                       // did the test exceed the time budget?
 } autotest_t;
 
 // define package_t
@@ -87,6 +95,9 @@ typedef struct {
 //   struct package_t packages[NUM_PACKAGES]
 #include "../autotest_include.h"
 
+// per-test wall-clock time budget [s], zero for none
+double autotest_time_budget = 0.0;
+
 // 
 // helper functions:
 //
@@ -100,6 +111,22 @@ void execute_package(package_t * _p, int _verbose);
 // execute a specific package if string matches
 void execute_package_search(package_t * _p, char * _str, int _verbose);
 
+// execute list of tests in parallel worker processes, returning the
+// number of tests executed
+//  _list           :   script indices [size: _n x 1]
+//  _n              :   number of tests
+//  _num_workers    :   number of worker processes
+//  _stop_on_fail   :   stop dispatching after first failure
+//  _verbose        :   verbose output flag
+unsigned int execute_parallel(unsigned int * _list,
+                              unsigned int   _n,
+                              unsigned int   _num_workers,
+                              int            _stop_on_fail,
+                              int            _verbose);
+
+// print tests taking the most wall-clock time
+void print_slowest_tests(unsigned int _n);
+
 // print all autotest results
 void print_autotest_results(autotest_t * _test);
 
@@ -110,6 +137,37 @@ void print_package_results(package_t * _p);
 void print_unstable_tests(void);
 
 // print list of tests
+// print tests taking the most wall-clock time
+void print_slowest_tests(unsigned int _n)
+{
+    // selection of the _n slowest executed tests
+    unsigned int idx[_n];
+    unsigned int num = 0;
+    unsigned int t, k;
+    for (t=0; t<NUM_AUTOSCRIPTS; t++) {
+        if (!scripts[t].executed)
+            continue;
+        // insert in descending order of elapsed time
+        for (k=num; k>0 && scripts[idx[k-1]].elapsed < scripts[t].elapsed; k--) {
+            if (k < _n)
+                idx[k] = idx[k-1];
+        }
+        if (k < _n)
+            idx[k] = t;
+        num += num < _n ? 1 : 0;
+    }
+    if (num == 0)
+        return;
+
+    printf("==================================\n");
+    printf(" SLOWEST TESTS:\n");
+    for (k=0; k<num; k++) {
+        printf("    %3u : %8.3f s %s\n", scripts[idx[k]].id,
+                                        scripts[idx[k]].elapsed,
+                                        scripts[idx[k]].name);
+    }
+}
+
 void print_test_list(void);
 
 // print list of packages
@@ -126,7 +184,8 @@ int main(int argc, char *argv[])
           RUN_ALL_RANDOM,       // run all tests (random order)
           RUN_SINGLE_TEST,      // run just a single test
           RUN_SINGLE_PACKAGE,   // run just a single package
-          RUN_SEARCH
+          RUN_SEARCH,           // run all tests matching search string
+          RUN_PARALLEL          // run selected tests in worker processes
     } mode = RUN_ALL;
 
     // set defaults
@@ -137,12 +196,13 @@ int main(int argc, char *argv[])
     int          rseed              = 0;
     char         search_string[128] = "";
     char         filename[256]      = "";
+    unsigned int num_workers        = 1;
 
     unsigned int i;
 
     // get input options
     int d;
-    while((d = getopt(argc,argv,"ht:p:rLlxs:vqo:")) != EOF){
+    while((d = getopt(argc,argv,"ht:p:rLlxs:vqo:j:b:")) != EOF){
         switch (d) {
         case 'h':
             usage();
@@ -186,6 +246,13 @@ int main(int argc, char *argv[])
             strncpy(filename,optarg,255);
             filename[255] = '\0';
             break;
+        case 'j':
+            num_workers = atoi(optarg);
+            num_workers = num_workers < 1 ? 1 : num_workers;
+            break;
+        case 'b':
+            autotest_time_budget = atof(optarg);
+            break;
         default:
             return 1;
         }
@@ -201,6 +268,32 @@ int main(int argc, char *argv[])
     }
 
     unsigned int n=0;
+
+    // select tests to distribute among worker processes
+    unsigned int list[NUM_AUTOSCRIPTS];
+    if (num_workers > 1 && (mode == RUN_ALL || mode == RUN_SINGLE_PACKAGE || mode == RUN_SEARCH)) {
+        for (i=0; i<NUM_AUTOSCRIPTS; i++) {
+            package_t * p = NULL;
+            unsigned int k;
+            for (k=0; k<NUM_PACKAGES; k++) {
+                if (i >= packages[k].index && i < packages[k].index + packages[k].num_scripts)
+                    p = &packages[k];
+            }
+            if (p == NULL)
+                continue;
+            if ( (mode == RUN_ALL) ||
+                 (mode == RUN_SINGLE_PACKAGE && p->id == package_id) ||
+                 (mode == RUN_SEARCH && (strstr(p->name, search_string) != NULL ||
+                                         strstr(scripts[i].name, search_string) != NULL)) )
+            {
+                list[n++] = i;
+            }
+        }
+        if (mode == RUN_SEARCH)
+            printf("running all scripts matching '%s'...\n", search_string);
+        mode = RUN_PARALLEL;
+    }
+
     switch (mode) {
     case RUN_ALL:
         for (i=0; i<NUM_PACKAGES; i++) {
@@ -258,6 +351,15 @@ int main(int argc, char *argv[])
         for (i=0; i<NUM_PACKAGES; i++)
             execute_package_search( &packages[i], search_string, verbose);
 
+        // print results
+        for (i=0; i<NUM_PACKAGES; i++) {
+            if (verbose && packages[i].executed)
+                print_package_results( &packages[i] );
+        }
+        break;
+    case RUN_PARALLEL:
+        execute_parallel(list, n, num_workers, stop_on_fail, verbose);
+
         // print results
         for (i=0; i<NUM_PACKAGES; i++) {
             if (verbose && packages[i].executed)
@@ -266,8 +368,10 @@ int main(int argc, char *argv[])
         break;
     }
 
-    if (liquid_autotest_verbose)
+    if (liquid_autotest_verbose) {
+        print_slowest_tests(10);
         print_unstable_tests();
+    }
 
     autotest_print_results();
 
@@ -275,7 +379,15 @@ int main(int argc, char *argv[])
     if (strcmp(filename,"")!=0)
         export_results(filename);
 
-    return 0;
+    return liquid_autotest_num_failed > 0 ? 1 : 0;
+}
+
+// wall-clock time [s]
+static double autotest_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9*(double)ts.tv_nsec;
 }
 
 // execute a specific autotest
@@ -289,7 +401,18 @@ void execute_autotest(autotest_t * _test,
     unsigned long int autotest_num_warnings_init = liquid_autotest_num_warnings;
 
     // execute test
+    double t0 = autotest_clock();
     _test->api();
+    _test->elapsed = autotest_clock() - t0;
+
+    // exceeding the time budget counts as a failed check
+    _test->slow = autotest_time_budget > 0 && _test->elapsed > autotest_time_budget;
+    if (_test->slow) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "%s exceeded time budget (%.3f s > %.3f s)",
+                _test->name, _test->elapsed, autotest_time_budget);
+        liquid_autotest_failed_msg(__FILE__, __LINE__, msg);
+    }
 
     _test->num_passed = liquid_autotest_num_passed - autotest_num_passed_init;
     _test->num_failed = liquid_autotest_num_failed - autotest_num_failed_init;
@@ -347,6 +470,147 @@ void execute_package_search(package_t * _p, char * _str, int _verbose)
     }
 }
 
+// result record passed from worker processes
+typedef struct {
+    unsigned int index;             // script index
+    int finished;                   // zero when test is starting
+    long unsigned int num_passed;   // number of checks that passed
+    long unsigned int num_failed;   // number of checks that failed
+    long unsigned int num_warnings; // number of warnings
+    double elapsed;                 // wall-clock execution time [s]
+    int slow;                       // exceeded time budget
+} autotest_result_t;
+
+// execute list of tests in parallel worker processes; indices are
+// queued on a pipe that all workers read from so long tests do not
+// hold up the rest, and each worker reports a record when a test
+// starts and when it finishes; a test that starts but never finishes
+// (e.g. its worker crashed) is counted as failed
+unsigned int execute_parallel(unsigned int * _list,
+                              unsigned int   _n,
+                              unsigned int   _num_workers,
+                              int            _stop_on_fail,
+                              int            _verbose)
+{
+    int task[2];
+    int result[2];
+    if (pipe(task) < 0 || pipe(result) < 0) {
+        perror("pipe");
+        exit(1);
+    }
+
+    // queue all tasks before starting workers
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        if (write(task[1], &_list[i], sizeof(unsigned int)) != sizeof(unsigned int)) {
+            perror("write");
+            exit(1);
+        }
+    }
+    close(task[1]);
+
+    // start workers
+    pid_t pid[_num_workers];
+    fflush(stdout);
+    fflush(stderr);
+    for (i=0; i<_num_workers; i++) {
+        pid[i] = fork();
+        if (pid[i] < 0) {
+            perror("fork");
+            exit(1);
+        } else if (pid[i] == 0) {
+            close(result[0]);
+            unsigned int index;
+            while (read(task[0], &index, sizeof(unsigned int)) == sizeof(unsigned int)) {
+                autotest_result_t r = {.index = index, .finished = 0};
+                if (write(result[1], &r, sizeof(r)) != sizeof(r))
+                    _exit(1);
+
+                execute_autotest(&scripts[index], _verbose);
+                fflush(stdout);
+
+                r.finished     = 1;
+                r.num_passed   = scripts[index].num_passed;
+                r.num_failed   = scripts[index].num_failed;
+                r.num_warnings = scripts[index].num_warnings;
+                r.elapsed      = scripts[index].elapsed;
+                r.slow         = scripts[index].slow;
+                if (write(result[1], &r, sizeof(r)) != sizeof(r))
+                    _exit(1);
+            }
+            _exit(0);
+        }
+    }
+    close(task[0]);
+    close(result[1]);
+
+    // collect results
+    int started[NUM_AUTOSCRIPTS];
+    memset(started, 0, sizeof(started));
+    unsigned int num_executed = 0;
+    autotest_result_t r;
+    while (read(result[0], &r, sizeof(r)) == sizeof(r)) {
+        if (!r.finished) {
+            started[r.index] = 1;
+            continue;
+        }
+        started[r.index] = 0;
+
+        autotest_t * t = &scripts[r.index];
+        t->num_passed     = r.num_passed;
+        t->num_failed     = r.num_failed;
+        t->num_warnings   = r.num_warnings;
+        t->elapsed        = r.elapsed;
+        t->slow           = r.slow;
+        t->num_checks     = t->num_passed + t->num_failed;
+        t->pass           = t->num_failed == 0;
+        t->percent_passed = t->num_checks > 0 ?
+            100.0f * (float)t->num_passed / (float)t->num_checks : 0.0f;
+        t->executed       = 1;
+        num_executed++;
+
+        liquid_autotest_num_passed   += t->num_passed;
+        liquid_autotest_num_failed   += t->num_failed;
+        liquid_autotest_num_warnings += t->num_warnings;
+        liquid_autotest_num_checks   += t->num_checks;
+
+        if (_stop_on_fail && t->num_failed > 0) {
+            for (i=0; i<_num_workers; i++)
+                kill(pid[i], SIGTERM);
+            break;
+        }
+    }
+    close(result[0]);
+
+    // reap workers
+    int stopped = _stop_on_fail && liquid_autotest_num_failed > 0;
+    for (i=0; i<_num_workers; i++)
+        waitpid(pid[i], NULL, 0);
+
+    // tests whose worker terminated part-way through
+    for (i=0; i<NUM_AUTOSCRIPTS && !stopped; i++) {
+        if (!started[i])
+            continue;
+        scripts[i].executed = 1;
+        scripts[i].pass     = 0;
+        char msg[256];
+        snprintf(msg, sizeof(msg), "%s terminated before completing", scripts[i].name);
+        liquid_autotest_failed_msg(__FILE__, __LINE__, msg);
+        scripts[i].num_failed = 1;
+        scripts[i].num_checks = scripts[i].num_passed + 1;
+        num_executed++;
+    }
+
+    // flag packages with executed tests
+    unsigned int k;
+    for (k=0; k<NUM_PACKAGES; k++) {
+        for (i=packages[k].index; i<packages[k].index + packages[k].num_scripts; i++)
+            packages[k].executed |= scripts[i].executed;
+    }
+
+    return num_executed;
+}
+
 // print results of a particular test
 void print_autotest_results(autotest_t * _test)
 {
@@ -357,10 +621,11 @@ void print_autotest_results(autotest_t * _test)
     else
         printf("    %3u : <<FAIL>>  ", _test->id);
 
-    printf("passed %4lu / %4lu checks (%5.1f%%) : %s\n",
+    printf("passed %4lu / %4lu checks (%5.1f%%) %8.3f s : %s\n",
             _test->num_passed,
             _test->num_checks,
             _test->percent_passed,
+            _test->elapsed,
             _test->name);
 }
 
@@ -391,7 +656,11 @@ void print_unstable_tests(void)
     unsigned int t;
     for (t=0; t<NUM_AUTOSCRIPTS; t++) {
         if (scripts[t].executed) {
-            if (!scripts[t].pass) {
+            if (scripts[t].slow) {
+                printf("    %3u : <<SLOW>> %s (%.3f s)\n", scripts[t].id,
+                                                          scripts[t].name,
+                                                          scripts[t].elapsed);
+            } else if (!scripts[t].pass) {
                 printf("    %3u : <<FAIL>> %s\n", scripts[t].id,
                                                   scripts[t].name);
             }
@@ -442,11 +711,12 @@ int export_results(char * _filename)
     // print each individual test as opposed to package
     unsigned int i;
     for (i=0; i<NUM_AUTOSCRIPTS; i++) {
-        fprintf(fid,"    {\"id\":%3u, \"pass\":%s, \"num_checks\":%4lu, \"num_passed\":%4lu, \"name\":\"%s\"}%s\n",
+        fprintf(fid,"    {\"id\":%3u, \"pass\":%s, \"num_checks\":%4lu, \"num_passed\":%4lu, \"elapsed\":%.6f, \"name\":\"%s\"}%s\n",
                 scripts[i].id,
                 scripts[i].num_failed == 0 ? "true" : "false",
                 scripts[i].num_checks,
                 scripts[i].num_passed,
+                scripts[i].elapsed,
                 scripts[i].name,
                 i==NUM_AUTOSCRIPTS-1 ? "" : ",");
     }
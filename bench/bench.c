@@ -28,13 +28,36 @@
 //
 
 
+// pthread_setaffinity_np() and CPU_SET() for pinning threads (-j)
+#define _GNU_SOURCE
+
 // default include headers
 #include <stdio.h>
 #include <stdlib.h>
 #include <getopt.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
+#include <unistd.h>
 #include <sys/resource.h>
+#include <sys/utsname.h>
+
+#include "config.h"
+#include "liquid.h"
+
+#if HAVE_LINUX_PERF_EVENT_H
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#include <sched.h>
+#define BENCH_THREADS (1)
+#else
+#define BENCH_THREADS (0)
+#endif
 
 // define benchmark function pointer
 typedef void(benchmark_function_t) (
@@ -42,6 +65,16 @@ typedef void(benchmark_function_t) (
     struct rusage *_finish,
     unsigned long int *_num_iterations);
 
+// hardware events counted with -P
+enum {
+    PERF_CYCLES=0,          // cpu cycles
+    PERF_INSTRUCTIONS,      // retired instructions
+    PERF_L1D_MISSES,        // L1 data cache read misses
+    PERF_LLC_MISSES,        // last-level cache misses
+    PERF_BRANCH_MISSES,     // mispredicted branches
+    PERF_NUM_EVENTS
+};
+
 // define benchmark_t
 typedef struct {
     unsigned int id;
@@ -52,6 +85,13 @@ typedef struct {
     float extime;
     float rate;
     float cycles_per_trial;
+    unsigned int num_runs;      // number of timed runs
+    float cycles_min;           // fastest run (cycles/trial)
+    float cycles_p99;           // 99th percentile run (cycles/trial)
+    float perf[PERF_NUM_EVENTS];// hardware events/trial (negative if unavailable)
+    unsigned int num_threads;   // number of concurrent instances (-j)
+    float rate_aggregate;       // trials/s summed over all instances
+    float efficiency;           // aggregate rate / (num_threads * rate)
 } benchmark_t;
 
 // define package_t
@@ -76,20 +116,44 @@ typedef struct {
 void estimate_cpu_clock(void);
 void set_num_trials_from_cpu_speed(void);
 void execute_benchmark(benchmark_t* _benchmark, int _verbose);
+void execute_benchmark_threaded(benchmark_t* _benchmark, unsigned long int _num_trials);
 void execute_package(package_t* _package, int _verbose);
 
 char convert_units(float * _s);
 void print_benchmark_results(benchmark_t* _benchmark);
 void print_package_results(package_t* _package);
 double calculate_execution_time(struct rusage, struct rusage);
+double benchmark_clock(void);
+int compare_float(const void * _a, const void * _b);
+
+// hardware event counters
+int  perf_open(void);
+void perf_close(void);
+void perf_start(void);
+void perf_stop(double * _counts);
 
 unsigned long int num_base_trials = 1<<12;
 float cpu_clock = 1.0f; // cpu clock speed (Hz)
 float runtime=0.100f;   // minimum run time (s)
+unsigned int num_runs = 5;      // number of timed runs per benchmark
+unsigned int num_warmup = 1;    // number of untimed warm-up runs
+int perf_enable = 0;            // count hardware events?
+int perf_fd[PERF_NUM_EVENTS];   // event counter file descriptors
+unsigned int num_threads = 1;   // number of concurrent instances (-j)
 
 FILE * fid; // output file id
 void output_benchmark_to_file(FILE * _fid, benchmark_t * _benchmark);
 
+// export formats
+enum {
+    OUTPUT_TEXT=0,  // whitespace-separated columns (default)
+    OUTPUT_CSV,     // comma-separated values
+    OUTPUT_JSON,    // JSON object, one benchmark per line
+};
+const char * benchmark_package_name(benchmark_t * _benchmark);
+void output_csv(FILE * _fid);
+void output_json(FILE * _fid, int _argc, char * _argv[], int _cpu_clock_detect);
+
 void usage()
 {
     // help
@@ -104,10 +168,17 @@ void usage()
     printf("  -p[ID]        run specific package\n");
     printf("  -b[ID]        run specific benchmark\n");
     printf("  -t[SECONDS]   set minimum execution time (s)\n");
+    printf("  -r[COUNT]     set number of timed runs per benchmark\n");
+    printf("  -w[COUNT]     set number of warm-up runs per benchmark\n");
+    printf("  -P            count hardware events (cycles, instructions, cache\n");
+    printf("                and branch misses) with Linux perf_event\n");
+    printf("  -j[COUNT]     also run COUNT instances of each benchmark concurrently\n");
+    printf("                on pinned threads and report scaling efficiency\n");
     printf("  -l            list available packages\n");
     printf("  -L            list all available scripts\n");
     printf("  -s[STRING]    run all packages/benchmarks matching search string\n");
     printf("  -o[FILENAME]  export output\n");
+    printf("  -f[FORMAT]    export format: text, csv, json (default: text)\n");
 }
 
 // main function
@@ -128,12 +199,13 @@ int main(int argc, char *argv[])
     int autoscale = 1;
     int cpu_clock_detect = 1;
     int output_to_file = 0;
+    int output_format = OUTPUT_TEXT;
     char filename[128];
     char search_string[128];
 
     // get input options
     int d;
-    while((d = getopt(argc,argv,"uhvqec:n:b:p:t:lLs:o:")) != EOF){
+    while((d = getopt(argc,argv,"uhvqec:n:b:p:t:r:w:Pj:lLs:o:f:")) != EOF){
         switch (d) {
         case 'u':
         case 'h':   usage();        return 0;
@@ -178,6 +250,32 @@ int main(int argc, char *argv[])
             else if (runtime > 10.f) runtime = 10.0f;
             printf("minimum runtime: %d ms\n", (int) roundf(runtime*1e3));
             break;
+        case 'r':
+            num_runs = atoi(optarg);
+            if (num_runs < 1) {
+                printf("error: number of runs must be at least 1\n");
+                return -1;
+            }
+            break;
+        case 'w':
+            num_warmup = atoi(optarg);
+            break;
+        case 'P':
+            perf_enable = 1;
+            break;
+        case 'j':
+            num_threads = atoi(optarg);
+            if (num_threads < 1) {
+                printf("error: number of threads must be at least 1\n");
+                return -1;
+            }
+#if !BENCH_THREADS
+            if (num_threads > 1) {
+                printf("error: threaded benchmarks require pthread support\n");
+                return -1;
+            }
+#endif
+            break;
         case 'l':
             // list only packages and exit
             for (i=0; i<NUM_PACKAGES; i++)
@@ -200,6 +298,15 @@ int main(int argc, char *argv[])
             output_to_file = 1;
             strcpy(filename, optarg);
             break;
+        case 'f':
+            if      (strcmp(optarg,"text")==0) output_format = OUTPUT_TEXT;
+            else if (strcmp(optarg,"csv") ==0) output_format = OUTPUT_CSV;
+            else if (strcmp(optarg,"json")==0) output_format = OUTPUT_JSON;
+            else {
+                printf("error: unknown export format '%s'\n", optarg);
+                return -1;
+            }
+            break;
         default:
             usage();
             return 0;
@@ -219,6 +326,16 @@ int main(int argc, char *argv[])
     if (autoscale)
         set_num_trials_from_cpu_speed();
 
+    if (perf_enable)
+        perf_enable = perf_open();
+
+    if (num_threads > 1) {
+        long int num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        printf("  running %u concurrent instances on %ld cores\n", num_threads, num_cpus);
+        if (num_threads > num_cpus)
+            fprintf(stderr,"warning: more threads than cores; scaling efficiency will be limited\n");
+    }
+
     switch (mode) {
     case RUN_ALL:
         for (i=0; i<NUM_PACKAGES; i++)
@@ -258,6 +375,9 @@ int main(int argc, char *argv[])
         exit(1);
     }
 
+    if (perf_enable)
+        perf_close();
+
     if (output_to_file) {
         fid = fopen(filename,"w");
         if (!fid) {
@@ -265,6 +385,18 @@ int main(int argc, char *argv[])
             return 1;
         }
 
+        if (output_format == OUTPUT_CSV) {
+            output_csv(fid);
+            fclose(fid);
+            printf("results written to %s\n", filename);
+            return 0;
+        } else if (output_format == OUTPUT_JSON) {
+            output_json(fid, argc, argv, cpu_clock_detect);
+            fclose(fid);
+            printf("results written to %s\n", filename);
+            return 0;
+        }
+
         // print header
         fprintf(fid,"# %s : auto-generated file (autoscript version %s)\n", filename, AUTOSCRIPT_VERSION);
         fprintf(fid,"#\n");
@@ -283,9 +415,18 @@ int main(int argc, char *argv[])
         fprintf(fid,"#  cpu_clock           :   %e Hz\n", cpu_clock);
         fprintf(fid,"#  cpu_clock determined:   %s\n", cpu_clock_detect ? "estimated" : "specified");
         fprintf(fid,"#  num_trials          :   %lu\n", num_base_trials);
+        fprintf(fid,"#  num_runs            :   %u\n", num_runs);
+        fprintf(fid,"#  num_warmup          :   %u\n", num_warmup);
+        fprintf(fid,"#  num_threads         :   %u\n", num_threads);
+        fprintf(fid,"#  timer               :   monotonic wall clock\n");
+        fprintf(fid,"#  simd level          :   %s (host: %s)\n",
+                liquid_simd_level_str(liquid_simd_get_level()),
+                liquid_simd_level_str(liquid_simd_get_host_level()));
         fprintf(fid,"#\n");
-        fprintf(fid,"# %-5s %-30s %12s %12s %12s %12s\n",
-                "id", "name", "num trials", "ex.time [s]", "rate [t/s]", "[cycles/t]");
+        fprintf(fid,"# ex.time, rate and cycles/t are the median over all timed runs\n");
+        fprintf(fid,"# %-5s %-30s %12s %12s %12s %12s %12s %12s\n",
+                "id", "name", "num trials", "ex.time [s]", "rate [t/s]", "[cycles/t]",
+                "min [c/t]", "p99 [c/t]");
 
         for (i=0; i<NUM_AUTOSCRIPTS; i++) {
             if (scripts[i].num_trials > 0)
@@ -304,8 +445,7 @@ void estimate_cpu_clock(void)
 {
     printf("  estimating cpu clock frequency...\n");
     unsigned long int i, n = 1<<4;
-    struct rusage start, finish;
-    double extime;
+    double start, extime;
     
     // run trials until execution time threshold is exceeded
     do {
@@ -320,14 +460,12 @@ void estimate_cpu_clock(void)
         unsigned int k = 366001;    // large prime number
         unsigned int g = 184903;    // another large prime number
         unsigned int s = 1;
-        getrusage(RUSAGE_SELF, &start);
+        start = benchmark_clock();
         for (i=0; i<n; i++) {
             // perform mindless task
             s = (s*k) % g;
         }
-        getrusage(RUSAGE_SELF, &finish);
-
-        extime = calculate_execution_time(start, finish);
+        extime = benchmark_clock() - start;
 
         // print results to screen
         // NOTE: it is necessary to do something with the variable 's' so that
@@ -354,10 +492,22 @@ void set_num_trials_from_cpu_speed(void)
     printf("  setting number of base trials to %ld\n", num_base_trials);
 }
 
+// Execute a benchmark: the number of trials is first scaled until a
+// single run exceeds runtime/num_runs, then the benchmark is run
+// num_warmup times untimed and num_runs times timed.  Each run is timed
+// against the monotonic wall clock (rather than the coarse user+system
+// time reported by getrusage()), and the median, minimum and 99th
+// percentile of the per-trial cycle counts are recorded.
 void execute_benchmark(benchmark_t* _benchmark, int _verbose)
 {
     unsigned long int n = num_base_trials;
     struct rusage start, finish;
+    double t0, extime;
+
+    // minimum duration of a single run
+    double run_time = runtime / num_runs;
+    if (run_time < 1e-3)
+        run_time = 1e-3;
 
     unsigned int num_attempts = 0;
     unsigned long int num_trials;
@@ -367,11 +517,12 @@ void execute_benchmark(benchmark_t* _benchmark, int _verbose)
 
         // set number of trials and run benchmark
         num_trials = n;
+        t0 = benchmark_clock();
         _benchmark->api(&start, &finish, &num_trials);
-        _benchmark->extime = calculate_execution_time(start, finish);
+        extime = benchmark_clock() - t0;
 
         // check exit criteria
-        if (_benchmark->extime >= runtime) {
+        if (extime >= run_time) {
             break;
         } else if (num_attempts == 30) {
             fprintf(stderr,"warning: benchmark could not execute over minimum run time\n");
@@ -382,14 +533,162 @@ void execute_benchmark(benchmark_t* _benchmark, int _verbose)
         }
     } while (1);
 
+    // warm-up runs (untimed)
+    unsigned int i;
+    for (i=0; i<num_warmup; i++) {
+        num_trials = n;
+        _benchmark->api(&start, &finish, &num_trials);
+    }
+
+    // timed runs
+    float * extimes = (float*) malloc(num_runs*sizeof(float));
+    double perf_counts[PERF_NUM_EVENTS] = {0};
+    for (i=0; i<num_runs; i++) {
+        num_trials = n;
+        if (perf_enable) perf_start();
+        t0 = benchmark_clock();
+        _benchmark->api(&start, &finish, &num_trials);
+        extimes[i] = benchmark_clock() - t0;
+        if (perf_enable) perf_stop(perf_counts);
+    }
+    for (i=0; i<PERF_NUM_EVENTS; i++) {
+        _benchmark->perf[i] = perf_counts[i] < 0 ? -1.0f :
+                              perf_counts[i] / ((double)num_runs * num_trials);
+    }
+    qsort(extimes, num_runs, sizeof(float), compare_float);
+
+    // nearest-rank 99th percentile
+    unsigned int i99 = (unsigned int) ceil(0.99*num_runs) - 1;
+
     _benchmark->num_trials = num_trials;
-    _benchmark->rate = (float)(_benchmark->num_trials) / _benchmark->extime;
+    _benchmark->num_runs   = num_runs;
+    _benchmark->extime     = extimes[num_runs/2];
+    _benchmark->rate       = (float)(_benchmark->num_trials) / _benchmark->extime;
     _benchmark->cycles_per_trial = cpu_clock / (_benchmark->rate);
+    _benchmark->cycles_min = cpu_clock * extimes[0]   / num_trials;
+    _benchmark->cycles_p99 = cpu_clock * extimes[i99] / num_trials;
+    free(extimes);
+
+    // concurrent instances, with the same number of trials each
+    _benchmark->num_threads    = 1;
+    _benchmark->rate_aggregate = _benchmark->rate;
+    _benchmark->efficiency     = 1.0f;
+    if (num_threads > 1)
+        execute_benchmark_threaded(_benchmark, n);
 
     if (_verbose)
         print_benchmark_results(_benchmark);
 }
 
+
+#if BENCH_THREADS
+// state shared by concurrent benchmark instances
+struct bench_thread_s {
+    benchmark_t *     benchmark;    // benchmark to run
+    unsigned long int num_trials;   // trials per instance
+    unsigned int      cpu;          // core to pin instance to
+    unsigned int *    num_ready;    // instances waiting at start gate
+    int *             go;           // start gate open?
+    pthread_mutex_t * mutex;        // protects num_ready, go
+    pthread_cond_t *  cond;         // signals changes to num_ready, go
+};
+
+// pin thread to its core, wait at start gate, then run benchmark once
+void * bench_thread_worker(void * _arg)
+{
+    struct bench_thread_s * t = (struct bench_thread_s*) _arg;
+#ifdef CPU_SET
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(t->cpu, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus);
+#endif
+
+    pthread_mutex_lock(t->mutex);
+    (*t->num_ready)++;
+    pthread_cond_broadcast(t->cond);
+    while (!*t->go)
+        pthread_cond_wait(t->cond, t->mutex);
+    pthread_mutex_unlock(t->mutex);
+
+    struct rusage start, finish;
+    unsigned long int num_trials = t->num_trials;
+    t->benchmark->api(&start, &finish, &num_trials);
+    return NULL;
+}
+#endif
+
+// Run num_threads independent instances of a benchmark concurrently,
+// each pinned to its own core (wrapping around when there are more
+// threads than cores) and released together from a start gate.  Each
+// run is timed from the release until the last instance finishes, and
+// the aggregate rate over the median run is compared against num_threads
+// times the single-threaded rate.  An efficiency well below one points
+// at shared state (locks, global tables, false sharing) or a memory
+// bandwidth ceiling.
+void execute_benchmark_threaded(benchmark_t*      _benchmark,
+                                unsigned long int _num_trials)
+{
+#if BENCH_THREADS
+    long int num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_cpus < 1)
+        num_cpus = 1;
+
+    pthread_t * threads = (pthread_t*) malloc(num_threads*sizeof(pthread_t));
+    struct bench_thread_s * t = (struct bench_thread_s*) malloc(num_threads*sizeof(struct bench_thread_s));
+    float * extimes = (float*) malloc(num_runs*sizeof(float));
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&cond, NULL);
+
+    // warm-up runs are untimed
+    unsigned int i, r;
+    for (r=0; r<num_warmup+num_runs; r++) {
+        unsigned int num_ready = 0;
+        int go = 0;
+        for (i=0; i<num_threads; i++) {
+            t[i].benchmark  = _benchmark;
+            t[i].num_trials = _num_trials;
+            t[i].cpu        = i % num_cpus;
+            t[i].num_ready  = &num_ready;
+            t[i].go         = &go;
+            t[i].mutex      = &mutex;
+            t[i].cond       = &cond;
+            if (pthread_create(&threads[i], NULL, bench_thread_worker, &t[i]) != 0) {
+                fprintf(stderr,"error: execute_benchmark_threaded(), could not create thread\n");
+                exit(1);
+            }
+        }
+
+        // open start gate once all instances are pinned and waiting
+        pthread_mutex_lock(&mutex);
+        while (num_ready < num_threads)
+            pthread_cond_wait(&cond, &mutex);
+        go = 1;
+        pthread_cond_broadcast(&cond);
+        double t0 = benchmark_clock();
+        pthread_mutex_unlock(&mutex);
+
+        for (i=0; i<num_threads; i++)
+            pthread_join(threads[i], NULL);
+        if (r >= num_warmup)
+            extimes[r-num_warmup] = benchmark_clock() - t0;
+    }
+    qsort(extimes, num_runs, sizeof(float), compare_float);
+
+    _benchmark->num_threads    = num_threads;
+    _benchmark->rate_aggregate = (float)num_threads * _benchmark->num_trials / extimes[num_runs/2];
+    _benchmark->efficiency     = _benchmark->rate_aggregate / (num_threads * _benchmark->rate);
+
+    pthread_cond_destroy(&cond);
+    pthread_mutex_destroy(&mutex);
+    free(extimes);
+    free(t);
+    free(threads);
+#endif
+}
+
 void execute_package(package_t* _package, int _verbose)
 {
     if (_verbose)
@@ -437,12 +736,48 @@ void print_benchmark_results(benchmark_t* _b)
     float cycles_format = _b->cycles_per_trial;
     char cycles_units = convert_units(&cycles_format);
 
-    printf("  %-3u: %-30s: %6.2f %c trials / %6.2f %cs (%6.2f %c t/s, %6.2f %c c/t)\n",
+    // format cycle spread over runs
+    float min_format = _b->cycles_min;
+    char min_units = convert_units(&min_format);
+    float p99_format = _b->cycles_p99;
+    char p99_units = convert_units(&p99_format);
+
+    printf("  %-3u: %-30s: %6.2f %c trials / %6.2f %cs (%6.2f %c t/s, %6.2f %c c/t) [%6.2f %c .. %6.2f %c]\n",
         _b->id, _b->name,
         trials_format, trials_units,
         extime_format, extime_units,
         rate_format, rate_units,
-        cycles_format, cycles_units);
+        cycles_format, cycles_units,
+        min_format, min_units,
+        p99_format, p99_units);
+
+    // concurrent instances
+    if (_b->num_threads > 1) {
+        float aggregate_format = _b->rate_aggregate;
+        char aggregate_units = convert_units(&aggregate_format);
+        printf("        x%-3u threads: %6.2f %c t/s aggregate, scaling efficiency %5.1f%%\n",
+            _b->num_threads, aggregate_format, aggregate_units, 100.0f*_b->efficiency);
+    }
+
+    if (!perf_enable)
+        return;
+
+    // hardware events per trial
+    const char * labels[PERF_NUM_EVENTS] = {"cycles", "instr", "L1d miss", "LLC miss", "br miss"};
+    unsigned int i;
+    printf("       ");
+    for (i=0; i<PERF_NUM_EVENTS; i++) {
+        float v = _b->perf[i];
+        if (v < 0) {
+            printf(" %s:      -  ", labels[i]);
+        } else {
+            char units = convert_units(&v);
+            printf(" %s: %6.2f %c", labels[i], v, units);
+        }
+        if (i == PERF_INSTRUCTIONS && _b->perf[PERF_CYCLES] > 0 && _b->perf[PERF_INSTRUCTIONS] >= 0)
+            printf(" (ipc %4.2f)", _b->perf[PERF_INSTRUCTIONS] / _b->perf[PERF_CYCLES]);
+        printf("%s", i+1 < PERF_NUM_EVENTS ? "," : " /t\n");
+    }
 }
 
 void print_package_results(package_t* _package)
@@ -463,14 +798,257 @@ double calculate_execution_time(struct rusage _start, struct rusage _finish)
         + 1e-6*(_finish.ru_stime.tv_usec - _start.ru_stime.tv_usec);
 }
 
+// monotonic wall-clock time (s)
+double benchmark_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+// compare floats for qsort()
+int compare_float(const void * _a, const void * _b)
+{
+    float a = *(const float*)_a;
+    float b = *(const float*)_b;
+    return (a > b) - (a < b);
+}
+
 void output_benchmark_to_file(FILE * _fid, benchmark_t * _benchmark)
 {
-    fprintf(_fid,"  %-5u %-30s %12u %12.4e %12.4e %12.4e\n",
+    fprintf(_fid,"  %-5u %-30s %12u %12.4e %12.4e %12.4e %12.4e %12.4e\n",
                  _benchmark->id,
                  _benchmark->name,
                  _benchmark->num_trials,
                  _benchmark->extime,
                  _benchmark->rate,
-                 _benchmark->cycles_per_trial);
+                 _benchmark->cycles_per_trial,
+                 _benchmark->cycles_min,
+                 _benchmark->cycles_p99);
 }
 
+
+// find name of package containing benchmark
+const char * benchmark_package_name(benchmark_t * _benchmark)
+{
+    unsigned int i;
+    for (i=0; i<NUM_PACKAGES; i++) {
+        if (_benchmark->id >= packages[i].index &&
+            _benchmark->id <  packages[i].index + packages[i].num_scripts)
+        {
+            return packages[i].name;
+        }
+    }
+    return "";
+}
+
+// export results as comma-separated values; the columns follow the
+// text format with the package name appended
+void output_csv(FILE * _fid)
+{
+    struct utsname host;
+    uname(&host);
+
+    fprintf(_fid,"# host: %s %s %s %s, cpu clock %e Hz, simd %s\n",
+            host.nodename, host.sysname, host.release, host.machine,
+            cpu_clock, liquid_simd_level_str(liquid_simd_get_level()));
+    fprintf(_fid,"id,name,num_trials,ex_time,rate,cycles_per_trial,cycles_min,cycles_p99,package%s\n",
+            num_threads > 1 ? ",num_threads,rate_aggregate,efficiency" : "");
+
+    unsigned int i;
+    for (i=0; i<NUM_AUTOSCRIPTS; i++) {
+        if (scripts[i].num_trials == 0)
+            continue;
+        fprintf(_fid,"%u,%s,%u,%.4e,%.4e,%.4e,%.4e,%.4e,%s",
+                scripts[i].id,
+                scripts[i].name,
+                scripts[i].num_trials,
+                scripts[i].extime,
+                scripts[i].rate,
+                scripts[i].cycles_per_trial,
+                scripts[i].cycles_min,
+                scripts[i].cycles_p99,
+                benchmark_package_name(&scripts[i]));
+        if (num_threads > 1) {
+            fprintf(_fid,",%u,%.4e,%.4f",
+                    scripts[i].num_threads,
+                    scripts[i].rate_aggregate,
+                    scripts[i].efficiency);
+        }
+        fprintf(_fid,"\n");
+    }
+}
+
+// export results as a JSON object with host, SIMD and run settings;
+// each benchmark is written on its own line
+void output_json(FILE * _fid,
+                 int    _argc,
+                 char * _argv[],
+                 int    _cpu_clock_detect)
+{
+    struct utsname host;
+    uname(&host);
+
+    unsigned int i;
+    fprintf(_fid,"{\n");
+    fprintf(_fid,"  \"autoscript_version\": \"%s\",\n", AUTOSCRIPT_VERSION);
+    fprintf(_fid,"  \"command\": \"");
+    for (i=0; i<_argc; i++) {
+        // escape quotes and backslashes
+        char * c;
+        fprintf(_fid,"%s", i==0 ? "" : " ");
+        for (c=_argv[i]; *c != '\0'; c++)
+            fprintf(_fid, (*c=='"' || *c=='\\') ? "\\%c" : "%c", *c);
+    }
+    fprintf(_fid,"\",\n");
+    fprintf(_fid,"  \"host\": {\"name\": \"%s\", \"system\": \"%s\", \"release\": \"%s\", \"machine\": \"%s\",\n",
+            host.nodename, host.sysname, host.release, host.machine);
+    fprintf(_fid,"           \"cpu_clock\": %e, \"cpu_clock_determined\": \"%s\"},\n",
+            cpu_clock, _cpu_clock_detect ? "estimated" : "specified");
+    fprintf(_fid,"  \"simd\": {\"host_level\": \"%s\", \"level\": \"%s\", \"kernels\": {",
+            liquid_simd_level_str(liquid_simd_get_host_level()),
+            liquid_simd_level_str(liquid_simd_get_level()));
+    for (i=0; i<LIQUID_SIMD_NUM_FAMILIES; i++) {
+        fprintf(_fid,"%s\"%s\": \"%s\"", i==0 ? "" : ", ",
+                liquid_simd_family_str(i),
+                liquid_simd_level_str(liquid_simd_get_kernel(i)));
+    }
+    fprintf(_fid,"}},\n");
+    fprintf(_fid,"  \"settings\": {\"runtime\": %f, \"num_runs\": %u, \"num_warmup\": %u, \"num_base_trials\": %lu, \"perf_events\": %s, \"num_threads\": %u},\n",
+            runtime, num_runs, num_warmup, num_base_trials, perf_enable ? "true" : "false", num_threads);
+    fprintf(_fid,"  \"benchmarks\": [\n");
+
+    int first = 1;
+    for (i=0; i<NUM_AUTOSCRIPTS; i++) {
+        if (scripts[i].num_trials == 0)
+            continue;
+        fprintf(_fid,"%s    {\"id\": %u, \"name\": \"%s\", \"package\": \"%s\", \"num_trials\": %u, "
+                     "\"ex_time\": %.4e, \"rate\": %.4e, \"cycles_per_trial\": %.4e, "
+                     "\"cycles_min\": %.4e, \"cycles_p99\": %.4e",
+                first ? "" : ",\n",
+                scripts[i].id,
+                scripts[i].name,
+                benchmark_package_name(&scripts[i]),
+                scripts[i].num_trials,
+                scripts[i].extime,
+                scripts[i].rate,
+                scripts[i].cycles_per_trial,
+                scripts[i].cycles_min,
+                scripts[i].cycles_p99);
+
+        // hardware events per trial; null when unavailable
+        if (perf_enable) {
+            const char * keys[PERF_NUM_EVENTS] = {"hw_cycles", "instructions",
+                "l1d_misses", "llc_misses", "branch_misses"};
+            unsigned int k;
+            for (k=0; k<PERF_NUM_EVENTS; k++) {
+                if (scripts[i].perf[k] < 0) fprintf(_fid,", \"%s\": null", keys[k]);
+                else                        fprintf(_fid,", \"%s\": %.4e", keys[k], scripts[i].perf[k]);
+            }
+        }
+
+        // concurrent instances
+        if (num_threads > 1) {
+            fprintf(_fid,", \"num_threads\": %u, \"rate_aggregate\": %.4e, \"efficiency\": %.4f",
+                    scripts[i].num_threads,
+                    scripts[i].rate_aggregate,
+                    scripts[i].efficiency);
+        }
+        fprintf(_fid,"}");
+        first = 0;
+    }
+    fprintf(_fid,"\n  ]\n");
+    fprintf(_fid,"}\n");
+}
+
+// open hardware event counters for this process (user space only),
+// returning 1 if at least one counter is available
+int perf_open(void)
+{
+#if HAVE_LINUX_PERF_EVENT_H
+    const unsigned int type[PERF_NUM_EVENTS] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+    const unsigned long long config[PERF_NUM_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+
+    unsigned int i;
+    int num_open = 0;
+    for (i=0; i<PERF_NUM_EVENTS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = type[i];
+        attr.config         = config[i];
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                              PERF_FORMAT_TOTAL_TIME_RUNNING;
+        perf_fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        num_open += perf_fd[i] >= 0;
+    }
+    if (num_open == 0) {
+        fprintf(stderr,"warning: could not open hardware event counters; check /proc/sys/kernel/perf_event_paranoid\n");
+        return 0;
+    }
+    printf("  counting %d of %d hardware events\n", num_open, PERF_NUM_EVENTS);
+    return 1;
+#else
+    fprintf(stderr,"warning: hardware event counters not supported on this platform\n");
+    return 0;
+#endif
+}
+
+void perf_close(void)
+{
+#if HAVE_LINUX_PERF_EVENT_H
+    unsigned int i;
+    for (i=0; i<PERF_NUM_EVENTS; i++) {
+        if (perf_fd[i] >= 0)
+            close(perf_fd[i]);
+    }
+#endif
+}
+
+// reset and enable counters
+void perf_start(void)
+{
+#if HAVE_LINUX_PERF_EVENT_H
+    unsigned int i;
+    for (i=0; i<PERF_NUM_EVENTS; i++) {
+        if (perf_fd[i] < 0)
+            continue;
+        ioctl(perf_fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+// disable counters and accumulate their values into _counts, scaled
+// for multiplexing; unavailable events are set to -1
+void perf_stop(double * _counts)
+{
+#if HAVE_LINUX_PERF_EVENT_H
+    unsigned int i;
+    for (i=0; i<PERF_NUM_EVENTS; i++) {
+        if (perf_fd[i] >= 0)
+            ioctl(perf_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (i=0; i<PERF_NUM_EVENTS; i++) {
+        unsigned long long v[3];    // value, time enabled, time running
+        if (_counts[i] < 0 || perf_fd[i] < 0 ||
+            read(perf_fd[i], v, sizeof(v)) != sizeof(v) || v[2] == 0)
+        {
+            _counts[i] = -1;
+            continue;
+        }
+        _counts[i] += (double)v[0] * v[1] / v[2];
+    }
+#endif
+}
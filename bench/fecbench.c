@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fecbench.c : benchmark fec encoder/decoder throughput
+//
+// Sweeps every fec scheme over a range of message lengths and reports
+// encoder, hard-decision decoder, and soft-decision decoder throughput
+// in message bits per second and cycles per message bit.
+//
+
+// default include headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <string.h>
+#include <math.h>
+#include <sys/resource.h>
+
+#include "liquid.h"
+
+void usage()
+{
+    // help
+    printf("Usage: fecbench [OPTION]\n");
+    printf("Sweep fec schemes and message lengths for liquid-dsp library.\n");
+    printf("  -h            display this help and exit\n");
+    printf("  -v/q          verbose/quiet\n");
+    printf("  -t[SECONDS]   set minimum execution time (s)\n");
+    printf("  -c[CLOCK]     set cpu clock frequency (Hz), otherwise estimate\n");
+    printf("  -o[FILENAME]  export output\n");
+    printf("  -n[MIN]       minimum message length (bytes), default: 16\n");
+    printf("  -N[MAX]       maximum message length (bytes), default: 65536\n");
+    printf("  -f[SCHEME]    benchmark single fec scheme (default: all)\n");
+    liquid_print_fec_schemes();
+}
+
+typedef enum {
+    FEC_OP_ENCODE=0,    // encode
+    FEC_OP_DECODE,      // hard-decision decode
+    FEC_OP_DECODE_SOFT, // soft-decision decode
+} fecbench_op;
+
+// benchmark structure
+struct benchmark_s {
+    // fec options
+    fec_scheme   fs;            // fec scheme
+    unsigned int n;             // decoded message length (bytes)
+
+    // benchmark results, indexed by fecbench_op
+    unsigned long int num_trials[3];    // number of trials
+    float extime[3];                    // execution time (s)
+
+    // derived values
+    float rate[3];              // throughput (message bits/s)
+    float cycles_per_bit[3];    // cycles per message bit
+};
+
+// simulation structure
+struct fecbench_s {
+    int verbose;
+    float runtime;          // minimum run time (s)
+    float cpu_clock;        // cpu clock frequency (Hz)
+    fec_scheme fs;          // single scheme (LIQUID_FEC_UNKNOWN: all)
+
+    unsigned int n_min;     // minimum message length (bytes)
+    unsigned int n_max;     // maximum message length (bytes)
+
+    // output file
+    char filename[128];     // output filename
+    FILE * fid;             // output file pointer
+    int output_to_file;     // output file write flag
+};
+
+// helper functions:
+double calculate_execution_time(struct rusage, struct rusage);
+float estimate_cpu_clock(void);
+
+// run all benchmarks
+void fecbench_execute(struct fecbench_s * _fecbench);
+
+// execute single benchmark (all operations)
+void execute_benchmark_fec(struct benchmark_s * _benchmark,
+                           float                _runtime,
+                           float                _cpu_clock);
+
+void benchmark_print_to_file(FILE *               _fid,
+                             struct benchmark_s * _benchmark);
+
+void benchmark_print(struct benchmark_s * _benchmark);
+
+// main function
+int main(int argc, char *argv[])
+{
+    // options
+    struct fecbench_s fecbench;
+    fecbench.verbose    = 1;
+    fecbench.runtime    = 0.05f;
+    fecbench.cpu_clock  = 0.0f;
+    fecbench.fs         = LIQUID_FEC_UNKNOWN;
+    fecbench.n_min      = 16;
+    fecbench.n_max      = 65536;
+    fecbench.filename[0]= '\0';
+    fecbench.fid        = NULL;
+    fecbench.output_to_file = 0;
+
+    // get input options
+    int d;
+    while((d = getopt(argc,argv,"hvqt:c:o:n:N:f:")) != EOF){
+        switch (d) {
+        case 'h':   usage();        return 0;
+        case 'v':   fecbench.verbose = 1;    break;
+        case 'q':   fecbench.verbose = 0;    break;
+        case 't':
+            fecbench.runtime = atof(optarg);
+            if (fecbench.runtime < 1e-3f)     fecbench.runtime = 1e-3f;
+            else if (fecbench.runtime > 10.f) fecbench.runtime = 10.0f;
+            printf("minimum runtime: %d ms\n", (int) roundf(fecbench.runtime*1e3));
+            break;
+        case 'c':
+            fecbench.cpu_clock = atof(optarg);
+            if (fecbench.cpu_clock <= 0) {
+                fprintf(stderr,"error: %s, cpu clock speed must be positive\n", argv[0]);
+                exit(1);
+            }
+            break;
+        case 'o':
+            fecbench.output_to_file = 1;
+            strncpy(fecbench.filename, optarg, sizeof(fecbench.filename)-1);
+            fecbench.filename[sizeof(fecbench.filename)-1] = '\0';
+            break;
+        case 'n':   fecbench.n_min = atoi(optarg);  break;
+        case 'N':   fecbench.n_max = atoi(optarg);  break;
+        case 'f':
+            fecbench.fs = liquid_getopt_str2fec(optarg);
+            if (fecbench.fs == LIQUID_FEC_UNKNOWN) {
+                fprintf(stderr,"error: %s, unknown/unsupported fec scheme '%s'\n", argv[0], optarg);
+                exit(1);
+            }
+            break;
+        default:
+            usage();
+            return 0;
+        }
+    }
+
+    // validate input
+    if (fecbench.n_min == 0 || fecbench.n_min > fecbench.n_max) {
+        fprintf(stderr,"error: %s, invalid message length range [%u,%u]\n",
+                argv[0], fecbench.n_min, fecbench.n_max);
+        exit(1);
+    }
+
+    // estimate cpu clock frequency if not specified
+    if (fecbench.cpu_clock == 0.0f)
+        fecbench.cpu_clock = estimate_cpu_clock();
+    printf("cpu clock frequency: %.3f GHz\n", fecbench.cpu_clock*1e-9f);
+
+    // open output file (if applicable)
+    unsigned int i;
+    if (fecbench.output_to_file) {
+        fecbench.fid = fopen(fecbench.filename,"w");
+        if (!fecbench.fid) {
+            fprintf(stderr,"error: %s, could not open file '%s' for writing\n", argv[0], fecbench.filename);
+            exit(1);
+        }
+        FILE * fid = fecbench.fid;
+
+        // print header
+        fprintf(fid,"# %s : auto-generated file\n", fecbench.filename);
+        fprintf(fid,"#\n");
+        fprintf(fid,"# invoked as:\n");
+        fprintf(fid,"#   ");
+        for (i=0; i<argc; i++)
+            fprintf(fid," %s", argv[i]);
+        fprintf(fid,"\n");
+        fprintf(fid,"#\n");
+        fprintf(fid,"# properties:\n");
+        fprintf(fid,"#  runtime             :   %12.8f s\n", fecbench.runtime);
+        fprintf(fid,"#  cpu clock           :   %12.4e Hz\n", fecbench.cpu_clock);
+        fprintf(fid,"#\n");
+        fprintf(fid,"# rates are in decoded message bits per second\n");
+        fprintf(fid,"# %-12s %8s %12s %12s %12s %10s %10s %10s %8s\n",
+                "scheme", "bytes",
+                "enc [b/s]", "dec [b/s]", "soft [b/s]",
+                "enc c/b", "dec c/b", "soft c/b", "soft/dec");
+    }
+
+    // run benchmarks
+    fecbench_execute(&fecbench);
+
+    if (fecbench.output_to_file) {
+        fclose(fecbench.fid);
+        printf("results written to %s\n", fecbench.filename);
+    }
+
+    return 0;
+}
+
+double calculate_execution_time(struct rusage _start, struct rusage _finish)
+{
+    return _finish.ru_utime.tv_sec - _start.ru_utime.tv_sec
+        + 1e-6*(_finish.ru_utime.tv_usec - _start.ru_utime.tv_usec)
+        + _finish.ru_stime.tv_sec - _start.ru_stime.tv_sec
+        + 1e-6*(_finish.ru_stime.tv_usec - _start.ru_stime.tv_usec);
+}
+
+// estimate cpu clock frequency (same method as benchmark program)
+float estimate_cpu_clock(void)
+{
+    unsigned long int i, n = 1<<4;
+    struct rusage start, finish;
+    double extime;
+    unsigned int k = 366001;    // large prime number
+    unsigned int g = 184903;    // another large prime number
+    volatile unsigned int s = 1;
+    do {
+        n <<= 1;
+        getrusage(RUSAGE_SELF, &start);
+        for (i=0; i<n; i++)
+            s = (s*k) % g;
+        getrusage(RUSAGE_SELF, &finish);
+        extime = calculate_execution_time(start, finish);
+    } while (extime < 0.5 && n < (1<<28));
+
+    return 9.5 * n / extime;
+}
+
+// run all benchmarks
+void fecbench_execute(struct fecbench_s * _fecbench)
+{
+    struct benchmark_s benchmark;
+
+    if (_fecbench->verbose) {
+        printf("  %-12s %8s %10s %10s %10s %9s %9s %9s %8s\n",
+                "scheme", "bytes",
+                "enc Mb/s", "dec Mb/s", "soft Mb/s",
+                "enc c/b", "dec c/b", "soft c/b", "soft/dec");
+    }
+
+    unsigned int i;
+    for (i=LIQUID_FEC_NONE; i<LIQUID_FEC_NUM_SCHEMES; i++) {
+        if (_fecbench->fs != LIQUID_FEC_UNKNOWN && i != _fecbench->fs)
+            continue;
+
+        unsigned int n;
+        for (n=_fecbench->n_min; n<=_fecbench->n_max; n*=2) {
+            benchmark.fs = (fec_scheme)i;
+            benchmark.n  = n;
+            execute_benchmark_fec(&benchmark, _fecbench->runtime, _fecbench->cpu_clock);
+
+            if (_fecbench->verbose)
+                benchmark_print(&benchmark);
+
+            if (_fecbench->output_to_file)
+                benchmark_print_to_file(_fecbench->fid, &benchmark);
+        }
+    }
+}
+
+// execute single benchmark (all operations)
+void execute_benchmark_fec(struct benchmark_s * _benchmark,
+                           float                _runtime,
+                           float                _cpu_clock)
+{
+    unsigned int n     = _benchmark->n;
+    unsigned int n_enc = fec_get_enc_msg_length(_benchmark->fs, n);
+
+    // allocate memory
+    unsigned char * msg      = (unsigned char*) malloc(n*sizeof(unsigned char));
+    unsigned char * msg_enc  = (unsigned char*) malloc(n_enc*sizeof(unsigned char));
+    unsigned char * msg_soft = (unsigned char*) malloc(8*n_enc*sizeof(unsigned char));
+    unsigned char * msg_dec  = (unsigned char*) malloc(n*sizeof(unsigned char));
+
+    // create fec object and initialize message
+    fec q = fec_create(_benchmark->fs, NULL);
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    // encode message and expand to soft bits
+    fec_encode(q, n, msg, msg_enc);
+    for (i=0; i<n_enc; i++)
+        liquid_unpack_soft_bits(msg_enc[i], 8, &msg_soft[8*i]);
+
+    // run each operation until minimum run time is exceeded
+    struct rusage start, finish;
+    unsigned int op;
+    for (op=0; op<3; op++) {
+        unsigned long int num_trials = 1;
+        unsigned long int t;
+        unsigned int num_attempts = 0;
+        do {
+            num_attempts++;
+            getrusage(RUSAGE_SELF, &start);
+            switch (op) {
+            case FEC_OP_ENCODE:
+                for (t=0; t<num_trials; t++)
+                    fec_encode(q, n, msg, msg_enc);
+                break;
+            case FEC_OP_DECODE:
+                for (t=0; t<num_trials; t++)
+                    fec_decode(q, n, msg_enc, msg_dec);
+                break;
+            case FEC_OP_DECODE_SOFT:
+                for (t=0; t<num_trials; t++)
+                    fec_decode_soft(q, n, msg_soft, msg_dec);
+                break;
+            default:;
+            }
+            getrusage(RUSAGE_SELF, &finish);
+            _benchmark->extime[op] = calculate_execution_time(start, finish);
+
+            // check exit criteria
+            if (_benchmark->extime[op] >= _runtime) {
+                break;
+            } else if (num_attempts == 40) {
+                fprintf(stderr,"warning: benchmark could not execute over minimum run time\n");
+                break;
+            } else {
+                // increase number of trials
+                num_trials *= 2;
+            }
+        } while (1);
+        _benchmark->num_trials[op] = num_trials;
+
+        // compute derived values
+        double bits = 8.0 * (double)n * (double)num_trials;
+        _benchmark->rate[op] = bits / _benchmark->extime[op];
+        _benchmark->cycles_per_bit[op] = _cpu_clock / _benchmark->rate[op];
+    }
+
+    // verify decoded message against original (noiseless channel)
+    if (memcmp(msg, msg_dec, n) != 0) {
+        fprintf(stderr,"warning: %s, n=%u: decoded message mismatch\n",
+                fec_scheme_str[_benchmark->fs][0], n);
+    }
+
+    // clean up allocated objects and memory
+    fec_destroy(q);
+    free(msg);
+    free(msg_enc);
+    free(msg_soft);
+    free(msg_dec);
+}
+
+void benchmark_print_to_file(FILE *               _fid,
+                             struct benchmark_s * _benchmark)
+{
+    fprintf(_fid,"  %-12s %8u %12.4e %12.4e %12.4e %10.3f %10.3f %10.3f %8.3f\n",
+            fec_scheme_str[_benchmark->fs][0],
+            _benchmark->n,
+            _benchmark->rate[FEC_OP_ENCODE],
+            _benchmark->rate[FEC_OP_DECODE],
+            _benchmark->rate[FEC_OP_DECODE_SOFT],
+            _benchmark->cycles_per_bit[FEC_OP_ENCODE],
+            _benchmark->cycles_per_bit[FEC_OP_DECODE],
+            _benchmark->cycles_per_bit[FEC_OP_DECODE_SOFT],
+            _benchmark->rate[FEC_OP_DECODE] / _benchmark->rate[FEC_OP_DECODE_SOFT]);
+}
+
+void benchmark_print(struct benchmark_s * _benchmark)
+{
+    printf("  %-12s %8u %10.3f %10.3f %10.3f %9.2f %9.2f %9.2f %8.2f\n",
+            fec_scheme_str[_benchmark->fs][0],
+            _benchmark->n,
+            _benchmark->rate[FEC_OP_ENCODE]      * 1e-6f,
+            _benchmark->rate[FEC_OP_DECODE]      * 1e-6f,
+            _benchmark->rate[FEC_OP_DECODE_SOFT] * 1e-6f,
+            _benchmark->cycles_per_bit[FEC_OP_ENCODE],
+            _benchmark->cycles_per_bit[FEC_OP_DECODE],
+            _benchmark->cycles_per_bit[FEC_OP_DECODE_SOFT],
+            _benchmark->rate[FEC_OP_DECODE] / _benchmark->rate[FEC_OP_DECODE_SOFT]);
+}
+
@@ -23,6 +23,13 @@
 //
 // fftbench.c : benchmark fft algorithms
 //
+// Transform rates are reported in M flops using the 5 N log2(N)
+// convention of the FFTW benchmarks (http://www.fftw.org/speed/) so
+// that sizes can be compared.  When built with fftw, '-l both' (the
+// default) times the internal transforms against fftw for each size and
+// reports the ratio of their execution times, and '-m objects' sweeps the
+// transform sizes used by the library's own objects.
+//
 
 
 // default include headers
@@ -34,9 +41,16 @@
 #include <complex.h>
 #include <sys/resource.h>
 
-#include <fftw3.h>
+#include "config.h"
 #include "liquid.h"
 
+#if HAVE_FFTW3_H && HAVE_LIBFFTW3F
+#include <fftw3.h>
+#define FFTBENCH_FFTW (1)
+#else
+#define FFTBENCH_FFTW (0)
+#endif
+
 void usage()
 {
     // help
@@ -48,8 +62,11 @@ void usage()
     printf("  -o[FILENAME]  export output\n");
     printf("  -n[NFFT_MIN]  minimum FFT size (benchmark single FFT)\n");
     printf("  -N[NFFT_MAX]  maximum FFT size\n");
-    printf("  -m[MODE]      mode: all, radix2, composite, prime, fftwbench, single\n");
-    printf("  -l[library]   library: float, fftw\n");
+    printf("  -m[MODE]      mode: all, radix2, composite, prime, fftwbench, objects, single\n");
+    printf("  -l[library]   library: float, fftw, both (internal/fftw parity)\n");
+#if !FFTBENCH_FFTW
+    printf("                (built without fftw; only 'float' is available)\n");
+#endif
 }
 
 // benchmark structure
@@ -71,7 +88,26 @@ struct benchmark_s {
 typedef enum {
     LIB_FLOAT=0,
     LIB_FFTW,
+    LIB_BOTH,   // internal and fftw, reporting execution time ratio
 } library_t;
+
+// transform sizes used by the library's objects (-m objects)
+struct fftbench_size_s {
+    unsigned int nfft;      // FFT size
+    const char * users;     // objects planning transforms of this size
+};
+const struct fftbench_size_s fftbench_object_sizes[] = {
+    {  16, "firpfbch2 (M=16)"},
+    {  32, "firpfbch2 (M=32)"},
+    {  64, "ofdmflexframe (M=64), firpfbch2 (M=64)"},
+    { 128, "ofdmflexframe (M=128), qdetector (framesync64)"},
+    { 256, "ofdmflexframe (M=256), qdetector, spgram"},
+    { 512, "ofdmflexframe (M=512), qdetector (flexframesync), spgram"},
+    {1024, "ofdmflexframe (M=1024), qdetector, spgram"},
+    {2048, "ofdmflexframe (M=2048), spgram"},
+    {4096, "spgram"},
+};
+#define FFTBENCH_NUM_OBJECT_SIZES (sizeof(fftbench_object_sizes)/sizeof(struct fftbench_size_s))
     
 // simulation structure
 struct fftbench_s {
@@ -80,6 +116,7 @@ struct fftbench_s {
           RUN_COMPOSITE,
           RUN_PRIME,
           RUN_FFTWBENCH,
+          RUN_OBJECTS,
           RUN_SINGLE,
     } mode;
 
@@ -106,6 +143,12 @@ double calculate_execution_time(struct rusage, struct rusage);
 // run all benchmarks
 void fftbench_execute(struct fftbench_s * _fftbench);
 
+// benchmark single FFT size with the selected library (or both),
+// printing and exporting the results
+void fftbench_run(struct fftbench_s * _fftbench,
+                  unsigned int        _nfft,
+                  const char *        _label);
+
 // execute single benchmark
 void execute_benchmark_fft(struct benchmark_s * _benchmark,
                            float                _runtime,
@@ -116,23 +159,33 @@ void benchmark_fft(struct rusage *      _start,
                    struct rusage *      _finish,
                    struct benchmark_s * _benchmark);
 
+#if FFTBENCH_FFTW
 // main benchmark script (FFTW)
 void benchmark_fftw(struct rusage *      _start,
                     struct rusage *      _finish,
                     struct benchmark_s * _benchmark);
+#endif
 
 void benchmark_print_to_file(FILE * _fid,
                               struct benchmark_s * _benchmark);
 
 void benchmark_print(struct benchmark_s * _benchmark);
 
+// print/export internal and fftw results with execution time ratio
+void benchmark_print_parity_to_file(FILE *               _fid,
+                                    struct benchmark_s * _internal,
+                                    struct benchmark_s * _fftw);
+void benchmark_print_parity(struct benchmark_s * _internal,
+                            struct benchmark_s * _fftw,
+                            const char *         _label);
+
 // main function
 int main(int argc, char *argv[])
 {
     // options
     struct fftbench_s fftbench;
     fftbench.mode       = RUN_RADIX2;
-    fftbench.library    = LIB_FLOAT;
+    fftbench.library    = FFTBENCH_FFTW ? LIB_BOTH : LIB_FLOAT;
     fftbench.verbose    = 1;
     fftbench.runtime    = 0.1f;
     fftbench.nfft_min   = 2;
@@ -170,6 +223,7 @@ int main(int argc, char *argv[])
             else if (strcmp(optarg,"composite")==0) fftbench.mode = RUN_COMPOSITE;
             else if (strcmp(optarg,"prime")==0)     fftbench.mode = RUN_PRIME;
             else if (strcmp(optarg,"fftwbench")==0) fftbench.mode = RUN_FFTWBENCH;
+            else if (strcmp(optarg,"objects")==0)   fftbench.mode = RUN_OBJECTS;
             else if (strcmp(optarg,"single")==0)    fftbench.mode = RUN_SINGLE;
             else {
                 fprintf(stderr,"error: %s, unknown mode '%s'\n", argv[0], optarg);
@@ -179,10 +233,17 @@ int main(int argc, char *argv[])
         case 'l':
             if      (strcmp(optarg,"float")==0)     fftbench.library = LIB_FLOAT;
             else if (strcmp(optarg,"fftw")==0)      fftbench.library = LIB_FFTW;
+            else if (strcmp(optarg,"both")==0)      fftbench.library = LIB_BOTH;
             else {
                 fprintf(stderr,"error: %s, unknown library option '%s'\n", argv[0], optarg);
                 exit(1);
             }
+#if !FFTBENCH_FFTW
+            if (fftbench.library != LIB_FLOAT) {
+                fprintf(stderr,"error: %s, built without fftw; library '%s' unavailable\n", argv[0], optarg);
+                exit(1);
+            }
+#endif
             break;
         default:
             usage();
@@ -220,9 +281,15 @@ int main(int argc, char *argv[])
         fprintf(fid,"#  verbose             :   %s\n", fftbench.verbose ? "true" : "false");
         fprintf(fid,"#  runtime             :   %12.8f s\n", fftbench.runtime);
         fprintf(fid,"#  mode                :   \n");
+        fprintf(fid,"#  flops               :   5 N log2(N) per transform\n");
         fprintf(fid,"#\n");
-        fprintf(fid,"# %12s %12s %12s %12s %12s\n",
-                "nfft", "num trials", "ex. time", "us/trial", "M-flops");
+        if (fftbench.library == LIB_BOTH) {
+            fprintf(fid,"# %12s %12s %12s %12s %12s %12s\n",
+                    "nfft", "us/trial", "M-flops", "fftw us/t", "fftw M-flops", "ratio");
+        } else {
+            fprintf(fid,"# %12s %12s %12s %12s %12s\n",
+                    "nfft", "num trials", "ex. time", "us/trial", "M-flops");
+        }
     }
 
     // run benchmarks
@@ -274,43 +341,23 @@ void fftbench_execute(struct fftbench_s * _fftbench)
         exit(1);
     }
 
-    // create benchmark structure
-    struct benchmark_s benchmark;
-
     if (_fftbench->mode == RUN_SINGLE) {
         // run single benchmark and exit
-
-        // initialize benchmark structure
-        benchmark.nfft       = _fftbench->nfft_min;
-        benchmark.direction  = LIQUID_FFT_FORWARD;
-        benchmark.num_trials = 1;
-        benchmark.flags      = 0;
-        benchmark.extime     = 0.0f;
-        benchmark.flops      = 0.0f;
-
-        // run the benchmark
-        execute_benchmark_fft(&benchmark, _fftbench->runtime, _fftbench->library);
-        benchmark_print(&benchmark);
+        fftbench_run(_fftbench, _fftbench->nfft_min, NULL);
         return;
     } else if (_fftbench->mode == RUN_FFTWBENCH) {
         printf("running composite FFTs from FFTW benchmark\n");
         unsigned int nfftw[18] = {6,9,12,15,18,24,36,80,108,210,504,
                                   1000,1960,4725,10368,27000,75600,165375};
         unsigned int i;
-        for (i=0; i<18; i++) {
-            // initialize benchmark structure
-            benchmark.nfft       = nfftw[i];
-            benchmark.direction  = LIQUID_FFT_FORWARD;
-            benchmark.num_trials = 1;
-            benchmark.flags      = 0;
-
-            // run the benchmark
-            execute_benchmark_fft(&benchmark, _fftbench->runtime, _fftbench->library);
-            benchmark_print(&benchmark);
-
-            if (_fftbench->output_to_file)
-                benchmark_print_to_file(_fftbench->fid, &benchmark);
-        }
+        for (i=0; i<18; i++)
+            fftbench_run(_fftbench, nfftw[i], NULL);
+        return;
+    } else if (_fftbench->mode == RUN_OBJECTS) {
+        printf("running FFT sizes used by library objects\n");
+        unsigned int i;
+        for (i=0; i<FFTBENCH_NUM_OBJECT_SIZES; i++)
+            fftbench_run(_fftbench, fftbench_object_sizes[i].nfft, fftbench_object_sizes[i].users);
         return;
     } else if (_fftbench->mode == RUN_RADIX2) {
         printf("running all power-of-two FFTs from %u to %u:\n",
@@ -319,20 +366,7 @@ void fftbench_execute(struct fftbench_s * _fftbench)
 
         unsigned int nfft = 1 << liquid_nextpow2(_fftbench->nfft_min);
         while ( nfft <= _fftbench->nfft_max) {
-
-            // initialize benchmark structure
-            benchmark.nfft       = nfft;
-            benchmark.direction  = LIQUID_FFT_FORWARD;
-            benchmark.num_trials = 1;
-            benchmark.flags      = 0;
-
-            // run the benchmark
-            execute_benchmark_fft(&benchmark, _fftbench->runtime, _fftbench->library);
-            benchmark_print(&benchmark);
-
-            if (_fftbench->output_to_file)
-                benchmark_print_to_file(_fftbench->fid, &benchmark);
-
+            fftbench_run(_fftbench, nfft, NULL);
             nfft *= 2;
         };
         return;
@@ -362,20 +396,46 @@ void fftbench_execute(struct fftbench_s * _fftbench)
             continue;
 
         // run the transform
-        benchmark.nfft       = nfft;
-        benchmark.direction  = LIQUID_FFT_FORWARD;
-        benchmark.num_trials = 1;
-        benchmark.flags      = 0;
-        benchmark.extime     = 0.0f;
-        benchmark.flops      = 0.0f;
-        execute_benchmark_fft(&benchmark, _fftbench->runtime, _fftbench->library);
+        fftbench_run(_fftbench, nfft, NULL);
+    }
+}
+
+// benchmark single FFT size with the selected library (or both)
+void fftbench_run(struct fftbench_s * _fftbench,
+                  unsigned int        _nfft,
+                  const char *        _label)
+{
+    // run internal transform, then fftw (if applicable)
+    struct benchmark_s benchmark[2];
+    unsigned int i;
+    for (i=0; i<2; i++) {
+        benchmark[i].nfft       = _nfft;
+        benchmark[i].direction  = LIQUID_FFT_FORWARD;
+        benchmark[i].num_trials = 1;
+        benchmark[i].flags      = 0;
+        benchmark[i].extime     = 0.0f;
+        benchmark[i].flops      = 0.0f;
+    }
+
+    if (_fftbench->library != LIB_BOTH) {
+        execute_benchmark_fft(&benchmark[0], _fftbench->runtime, _fftbench->library);
 
-        if (_fftbench->verbose)
-            benchmark_print(&benchmark);
+        if (_fftbench->verbose || _fftbench->mode == RUN_SINGLE)
+            benchmark_print(&benchmark[0]);
 
         if (_fftbench->output_to_file)
-            benchmark_print_to_file(_fftbench->fid, &benchmark);
+            benchmark_print_to_file(_fftbench->fid, &benchmark[0]);
+        return;
     }
+
+    execute_benchmark_fft(&benchmark[0], _fftbench->runtime, LIB_FLOAT);
+    execute_benchmark_fft(&benchmark[1], _fftbench->runtime, LIB_FFTW);
+
+    if (_fftbench->verbose || _fftbench->mode == RUN_SINGLE)
+        benchmark_print_parity(&benchmark[0], &benchmark[1], _label);
+
+    if (_fftbench->output_to_file)
+        benchmark_print_parity_to_file(_fftbench->fid, &benchmark[0], &benchmark[1]);
 }
 
 // execute single benchmark
@@ -399,9 +459,11 @@ void execute_benchmark_fft(struct benchmark_s * _benchmark,
         case LIB_FLOAT:
             benchmark_fft(&start, &finish, _benchmark);
             break;
+#if FFTBENCH_FFTW
         case LIB_FFTW:
             benchmark_fftw(&start, &finish, _benchmark);
             break;
+#endif
         default:
             fprintf(stderr,"error: execute_benchmark_fft(), invalid library\n");
             exit(1);
@@ -470,6 +532,7 @@ void benchmark_fft(struct rusage *      _start,
     free(y);
 }
 
+#if FFTBENCH_FFTW
 // main benchmark script (FFTW)
 void benchmark_fftw(struct rusage *      _start,
                     struct rusage *      _finish,
@@ -511,6 +574,7 @@ void benchmark_fftw(struct rusage *      _start,
     free(x);
     free(y);
 }
+#endif
 
 void benchmark_print_to_file(FILE * _fid,
                              struct benchmark_s * _benchmark)
@@ -537,3 +601,29 @@ void benchmark_print(struct benchmark_s * _benchmark)
             _benchmark->flops * 1e-6f);
 }
 
+void benchmark_print_parity_to_file(FILE *               _fid,
+                                    struct benchmark_s * _internal,
+                                    struct benchmark_s * _fftw)
+{
+    fprintf(_fid,"  %12u %12.6f %12.3f %12.6f %12.3f %12.4f\n",
+            _internal->nfft,
+            _internal->time_per_trial * 1e6f,
+            _internal->flops * 1e-6f,
+            _fftw->time_per_trial * 1e6f,
+            _fftw->flops * 1e-6f,
+            _internal->time_per_trial / _fftw->time_per_trial);
+}
+
+// ratio is internal/fftw execution time: above one, fftw is faster
+void benchmark_print_parity(struct benchmark_s * _internal,
+                            struct benchmark_s * _fftw,
+                            const char *         _label)
+{
+    printf("  %6u: internal %10.3f M flops, fftw %10.3f M flops, ratio %6.2f%s%s\n",
+            _internal->nfft,
+            _internal->flops * 1e-6f,
+            _fftw->flops * 1e-6f,
+            _internal->time_per_trial / _fftw->time_per_trial,
+            _label == NULL ? "" : "  ",
+            _label == NULL ? "" : _label);
+}
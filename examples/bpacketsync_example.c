@@ -47,6 +47,7 @@ void usage()
 
 int main(int argc, char*argv[]) {
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     // options
     unsigned int n=8;                       // original data message length
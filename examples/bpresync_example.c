@@ -35,6 +35,7 @@ void usage()
 int main(int argc, char*argv[])
 {
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     // options
     unsigned int k=2;                   // filter samples/symbol
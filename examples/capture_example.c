@@ -0,0 +1,114 @@
+//
+// capture_example.c
+//
+// Offline reprocessing of a recorded capture file. A number of frames
+// are generated with the flexframegen object and recorded to disk as
+// 16-bit complex integers; the recording is then opened as a
+// memory-mapped source and its block views are fed directly into the
+// flexframesync and spgramcf objects.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <getopt.h>
+
+#include "liquid.h"
+
+void usage()
+{
+    printf("capture_example [options]\n");
+    printf("  h     : print usage\n");
+    printf("  f     : capture file name, default: capture_example.dat\n");
+    printf("  t     : sample format {cf32, ci16}, default: ci16\n");
+    printf("  n     : number of frames, default: 20\n");
+    printf("  b     : processing block size, default: 4096\n");
+}
+
+int main(int argc, char*argv[])
+{
+    // options
+    const char *          filename   = "capture_example.dat";
+    liquid_capture_format format     = LIQUID_CAPTURE_CI16;
+    unsigned int          num_frames = 20;
+    unsigned int          block_size = 4096;
+    unsigned int          nfft       = 1024;
+
+    int dopt;
+    while ((dopt = getopt(argc,argv,"hf:t:n:b:")) != EOF) {
+        switch (dopt) {
+        case 'h': usage();                                     return 0;
+        case 'f': filename   = optarg;                         break;
+        case 't': format     = liquid_getopt_str2capture(optarg); break;
+        case 'n': num_frames = atoi(optarg);                   break;
+        case 'b': block_size = atoi(optarg);                   break;
+        default:
+            exit(1);
+        }
+    }
+    if (format != LIQUID_CAPTURE_CF32 && format != LIQUID_CAPTURE_CI16) {
+        fprintf(stderr,"error: %s, sample format must be complex\n", argv[0]);
+        exit(1);
+    }
+
+    unsigned int i;
+
+    // record frames to capture file
+    capture sink = capture_create(filename, format);
+    if (sink == NULL)
+        exit(1);
+    flexframegen fg = flexframegen_create(NULL);
+    unsigned char header[14];
+    unsigned char payload[120];
+    float complex buf[256];
+    unsigned int n;
+    for (n=0; n<num_frames; n++) {
+        for (i=0; i<14;  i++) header[i]  = n;
+        for (i=0; i<120; i++) payload[i] = rand() & 0xff;
+        flexframegen_assemble(fg, header, payload, 120);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = flexframegen_write_samples(fg, buf, 256);
+            for (i=0; i<256; i++)
+                buf[i] = 0.5f*buf[i] + 0.01f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            capture_writecf(sink, buf, 256);
+        }
+    }
+    flexframegen_destroy(fg);
+    printf("wrote %lu samples to '%s'\n", capture_get_num_samples(sink), filename);
+    capture_destroy(sink);
+
+    // reprocess recording from block views
+    capture       source = capture_open(filename, format);
+    if (source == NULL)
+        exit(1);
+    flexframesync fs     = flexframesync_create(NULL, NULL);
+    spgramcf      periodogram = spgramcf_create_default(nfft);
+    capture_print(source);
+
+    float complex * v;
+    while ( (n = capture_readcf(source, block_size, &v)) > 0 ) {
+        flexframesync_execute(fs, v, n);
+        spgramcf_write(periodogram, v, n);
+    }
+
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    framedatastats_print(&stats);
+
+    // report peak of power spectral density estimate
+    float psd[nfft];
+    spgramcf_get_psd(periodogram, psd);
+    float psd_max = psd[0];
+    for (i=1; i<nfft; i++)
+        psd_max = psd[i] > psd_max ? psd[i] : psd_max;
+    printf("processed %llu samples, peak psd: %.2f dB\n",
+            (unsigned long long)spgramcf_get_num_samples_total(periodogram), psd_max);
+
+    // clean up
+    capture_destroy(source);
+    flexframesync_destroy(fs);
+    spgramcf_destroy(periodogram);
+    remove(filename);
+    printf("done.\n");
+    return 0;
+}
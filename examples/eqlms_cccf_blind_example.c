@@ -40,6 +40,7 @@ void usage()
 int main(int argc, char*argv[])
 {
     //srand(time(NULL));
+    //randf_seed(time(NULL));
 
     // options
     unsigned int num_symbols=800; // number of symbols to observe
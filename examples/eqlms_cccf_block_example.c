@@ -34,7 +34,7 @@ void usage()
 
 int main(int argc, char*argv[])
 {
-    //srand(time(NULL));
+    //randf_seed(time(NULL));
 
     // options
     unsigned int    num_samples = 2400;     // number of symbols to observe
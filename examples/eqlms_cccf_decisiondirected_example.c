@@ -37,6 +37,7 @@ void usage()
 int main(int argc, char*argv[])
 {
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     // options
     unsigned int num_symbols=500;   // number of symbols to observe
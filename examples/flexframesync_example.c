@@ -54,6 +54,7 @@ static int callback(unsigned char *  _header,
 int main(int argc, char *argv[])
 {
     //srand( time(NULL) );
+    //randf_seed( time(NULL) );
 
     // options
     modulation_scheme ms     =  LIQUID_MODEM_QPSK; // mod. scheme
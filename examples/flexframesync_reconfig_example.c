@@ -26,6 +26,7 @@ void usage()
 
 int main(int argc, char *argv[]) {
     srand( time(NULL) );
+    randf_seed( time(NULL) );
 
     // define parameters
     float SNRdB = 30.0f;
@@ -47,6 +47,7 @@ int callback(unsigned char *  _header,
 int main(int argc, char*argv[])
 {
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     unsigned int payload_len = 40;  // length of payload (bytes)
     crc_scheme check = LIQUID_CRC_32;
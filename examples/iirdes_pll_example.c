@@ -32,7 +32,7 @@ void usage()
 }
 
 int main(int argc, char*argv[]) {
-    srand( time(NULL) );
+    randf_seed( time(NULL) );
 
     // options
     float phase_offset = M_PI / 4.0f;   // phase offset
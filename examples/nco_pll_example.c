@@ -34,7 +34,7 @@ void usage()
 int main(int argc, char*argv[])
 {
     // set random seed
-    srand( time(NULL) );
+    randf_seed( time(NULL) );
 
     // parameters
     float phase_offset     = 0.0f;      // initial phase offset
@@ -36,6 +36,7 @@ void usage()
 
 int main(int argc, char*argv[]) {
     srand( time(NULL) );
+    randf_seed( time(NULL) );
     // parameters
     float phase_offset = M_PI/10;
     float frequency_offset = 0.001f;
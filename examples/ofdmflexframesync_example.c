@@ -44,6 +44,7 @@ int callback(unsigned char *  _header,
 int main(int argc, char*argv[])
 {
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     // options
     unsigned int M = 64;                // number of subcarriers
@@ -51,6 +51,7 @@ int main(int argc, char*argv[])
 {
     // set the random seed differently for each run
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     // options
     unsigned int M           = 1200;    // number of subcarriers
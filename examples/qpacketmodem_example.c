@@ -35,6 +35,7 @@ void usage()
 int main(int argc, char *argv[])
 {
     //srand( time(NULL) );
+    //randf_seed( time(NULL) );
 
     // options
     modulation_scheme ms     = LIQUID_MODEM_QPSK;        // mod. scheme
@@ -27,7 +27,7 @@ void usage()
 
 int main(int argc, char *argv[])
 {
-    //srand( time(NULL) );
+    //randf_seed( time(NULL) );
 
     // options
     int          ms            = LIQUID_MODEM_QAM16;        // mod. scheme
@@ -40,7 +40,7 @@ void usage()
 
 int main(int argc, char*argv[])
 {
-    srand(time(NULL));
+    randf_seed(time(NULL));
     unsigned long int num_trials = 100000; // number of trials
     unsigned int num_bins = 30;
     enum {
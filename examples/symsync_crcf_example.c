@@ -34,6 +34,7 @@ void usage()
 
 int main(int argc, char*argv[]) {
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     // options
     unsigned int k           = 2;       // samples/symbol (input)
@@ -36,6 +36,7 @@ void usage(void)
 int main(int argc, char*argv[])
 {
     srand(time(NULL));
+    randf_seed(time(NULL));
 
     // options
     unsigned int k           =   2;     // samples/symbol (input)
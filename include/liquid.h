@@ -70,6 +70,25 @@ int liquid_libversion_number(void);
 #define LIQUID_CONCAT(prefix, name) prefix ## name
 #define LIQUID_VALIDATE_INPUT
 
+//
+// Thread safety
+//
+// Objects are not internally locked: a single object must not be used
+// by more than one thread at a time, but independent objects may be
+// used concurrently without synchronization. Objects which draw random
+// numbers (channel impairments, noise and modem sources, symstream,
+// gasearch) carry their own generator state, seeded from the creating
+// thread's generator (see randf_seed()); randf() and its relatives use
+// a per-thread generator. The remaining process-wide state is
+//  - the SIMD dispatch level (liquid_simd_set_level()),
+//  - the allocator hooks (liquid_set_allocator()),
+//  - the frame trace sink and its drain callback,
+//  - the firdes and kaiser window design caches (mutex-protected),
+//  - the shared fec object pool (lock-free),
+// of which the first three should be configured before any other
+// thread uses the library.
+//
+
 /* 
  * Compile-time complex data type definitions
  *
@@ -90,6 +109,21 @@ int liquid_libversion_number(void);
 LIQUID_DEFINE_COMPLEX(float,  liquid_float_complex);
 LIQUID_DEFINE_COMPLEX(double, liquid_double_complex);
 
+// 16-bit fixed-point (Q15) sample types: values represent [-1,1)
+// scaled by 2^15
+typedef int16_t q16_t;
+typedef struct {q16_t real; q16_t imag;} cq16_t;
+
+// convert floating-point value to Q15, saturating outside [-1,1)
+q16_t q16_float_to_fixed(float _x);
+
+// convert Q15 value to floating-point
+float q16_fixed_to_float(q16_t _x);
+
+// accelerator offload queue, used by objects in several modules (see
+// liquid_offload_create())
+typedef struct liquid_offload_s * liquid_offload;
+
 // 
 // MODULE : agc (automatic gain control)
 //
@@ -134,6 +168,14 @@ void AGC(_execute_block)(AGC()        _q,                       \
                          unsigned int _n,                       \
                          TC *         _y);                      \
                                                                 \
+/* get/set sub-block length for execute_block(): with a     */  \
+/* non-zero length the energy is measured once per          */  \
+/* sub-block, the gain is updated once per sub-block and    */  \
+/* ramped linearly across it; 0 (default) updates the gain  */  \
+/* on every sample, as execute()                            */  \
+unsigned int AGC(_get_block_len)(AGC() _q);                     \
+void AGC(_set_block_len)(AGC() _q, unsigned int _block_len);    \
+                                                                \
 /* lock/unlock gain control */                                  \
 void AGC(_lock)(  AGC() _q);                                    \
 void AGC(_unlock)(AGC() _q);                                    \
@@ -166,6 +208,166 @@ void AGC(_init)(AGC()        _q,                                \
 LIQUID_AGC_DEFINE_API(AGC_MANGLE_CRCF, float, liquid_float_complex)
 LIQUID_AGC_DEFINE_API(AGC_MANGLE_RRRF, float, float)
 
+// execute automatic gain control on block of 16-bit integer samples,
+// widening each sub-block (x*scale) into the output array and applying
+// the gain in place; results match execute_block() on widened input
+//  _q      : automatic gain control object
+//  _x      : input array [size: _n x 1], interleaved I/Q pairs for
+//            complex inputs [size: 2*_n x 1]
+//  _n      : number of input, output samples
+//  _scale  : input scaling factor (e.g. 1/32768)
+//  _y      : output array [size: _n x 1]
+void agc_crcf_execute_block_ci16(agc_crcf               _q,
+                                 const int16_t *        _x,
+                                 unsigned int           _n,
+                                 float                  _scale,
+                                 liquid_float_complex * _y);
+void agc_rrrf_execute_block_s16(agc_rrrf        _q,
+                                const int16_t * _x,
+                                unsigned int    _n,
+                                float           _scale,
+                                float *         _y);
+
+//
+// multi-channel automatic gain control with squelch
+//
+
+#define AGCBANK_MANGLE_CRCF(name)   LIQUID_CONCAT(agcbank_crcf, name)
+#define AGCBANK_MANGLE_RRRF(name)   LIQUID_CONCAT(agcbank_rrrf, name)
+
+// large macro
+//   AGCBANK    : name-mangling macro
+//   T          : primitive data type
+//   TC         : input/output data type
+#define LIQUID_AGCBANK_DEFINE_API(AGCBANK,T,TC)                 \
+typedef struct AGCBANK(_s) * AGCBANK();                         \
+                                                                \
+/* create bank of independent gain control loops, one per   */  \
+/* channel, sharing bandwidth and sub-block length          */  \
+/*  _num_channels   : number of channels, M > 0             */  \
+AGCBANK() AGCBANK(_create)(unsigned int _num_channels);         \
+                                                                \
+/* destroy object, freeing all internally-allocated memory  */  \
+void AGCBANK(_destroy)(AGCBANK() _q);                           \
+                                                                \
+/* print object properties to stdout                        */  \
+void AGCBANK(_print)(AGCBANK() _q);                             \
+                                                                \
+/* reset object's internal state                            */  \
+void AGCBANK(_reset)(AGCBANK() _q);                             \
+                                                                \
+/* execute gain control on channel-interleaved block, e.g.  */  \
+/* firpfbch2 analyzer output; each channel behaves as an    */  \
+/* agc object run on that channel with execute_block()      */  \
+/*  _q      : agcbank object                                */  \
+/*  _x      : input, sample i of channel k at _x[i*M+k]     */  \
+/*            [size: _n*M x 1]                              */  \
+/*  _n      : number of samples per channel                 */  \
+/*  _y      : output (may equal _x) [size: _n*M x 1]        */  \
+void AGCBANK(_execute)(AGCBANK()    _q,                         \
+                       TC *         _x,                         \
+                       unsigned int _n,                         \
+                       TC *         _y);                        \
+                                                                \
+/* get number of channels                                   */  \
+unsigned int AGCBANK(_get_num_channels)(AGCBANK() _q);          \
+                                                                \
+/* get/set sub-block length (see agc set_block_len())       */  \
+unsigned int AGCBANK(_get_block_len)(AGCBANK() _q);             \
+void AGCBANK(_set_block_len)(AGCBANK()    _q,                   \
+                             unsigned int _block_len);          \
+                                                                \
+/* get/set loop filter bandwidth, common to all channels    */  \
+float AGCBANK(_get_bandwidth)(AGCBANK() _q);                    \
+void  AGCBANK(_set_bandwidth)(AGCBANK() _q, float _bt);         \
+                                                                \
+/* get signal level (dB) of channel                         */  \
+float AGCBANK(_get_rssi)(AGCBANK() _q, unsigned int _channel);  \
+                                                                \
+/* get/set gain value (linear) of channel                   */  \
+float AGCBANK(_get_gain)(AGCBANK() _q, unsigned int _channel);  \
+void  AGCBANK(_set_gain)(AGCBANK()    _q,                       \
+                         unsigned int _channel,                 \
+                         float        _gain);                   \
+                                                                \
+/* enable/disable squelch; when enabled, a channel is       */  \
+/* active while its signal level is at or above the         */  \
+/* threshold, and for timeout samples after it drops below; */  \
+/* status is updated at the end of each execute() call      */  \
+void AGCBANK(_squelch_enable)(AGCBANK() _q);                    \
+void AGCBANK(_squelch_disable)(AGCBANK() _q);                   \
+int  AGCBANK(_squelch_is_enabled)(AGCBANK() _q);                \
+                                                                \
+/* get/set squelch threshold (dB)                           */  \
+float AGCBANK(_squelch_get_threshold)(AGCBANK() _q);            \
+void  AGCBANK(_squelch_set_threshold)(AGCBANK() _q,             \
+                                      float     _threshold);    \
+                                                                \
+/* enable/disable automatic squelch threshold: when        */  \
+/* enabled, the threshold (e.g. 10 dB) is relative to each  */  \
+/* channel's noise floor, the lower quartile of its signal  */  \
+/* level over execute() calls (default: disabled)           */  \
+void AGCBANK(_squelch_enable_auto)(AGCBANK() _q);               \
+void AGCBANK(_squelch_disable_auto)(AGCBANK() _q);              \
+int  AGCBANK(_squelch_is_auto)(AGCBANK() _q);                   \
+                                                                \
+/* get noise floor estimate (dB) of channel (automatic      */  \
+/* threshold only)                                          */  \
+float AGCBANK(_squelch_get_noise_floor)(AGCBANK()    _q,        \
+                                        unsigned int _channel); \
+                                                                \
+/* get/set squelch timeout (samples)                        */  \
+unsigned int AGCBANK(_squelch_get_timeout)(AGCBANK() _q);       \
+void AGCBANK(_squelch_set_timeout)(AGCBANK()    _q,             \
+                                   unsigned int _timeout);      \
+                                                                \
+/* get squelch status of channel: 1 if active, 0 if silent  */  \
+int AGCBANK(_squelch_get_status)(AGCBANK()    _q,               \
+                                 unsigned int _channel);        \
+                                                                \
+/* get active channel indices, ascending, so downstream     */  \
+/* per-channel processing can skip silent channels          */  \
+/*  _q      : agcbank object                                */  \
+/*  _active : active channel indices (may be NULL) [M x 1]  */  \
+/*  returns number of active channels                       */  \
+unsigned int AGCBANK(_squelch_get_active)(AGCBANK() _q,         \
+                                          unsigned int * _active);\
+
+// Define agcbank APIs
+LIQUID_AGCBANK_DEFINE_API(AGCBANK_MANGLE_CRCF, float, liquid_float_complex)
+LIQUID_AGCBANK_DEFINE_API(AGCBANK_MANGLE_RRRF, float, float)
+
+//
+// streaming noise floor estimator
+//
+
+// Tracks a quantile (e.g. the median) of a stream of block energies
+// with exponential forgetting at O(1) cost per block; used by energy
+// gates and squelch, which compare a block's energy to the floor.
+typedef struct noisefloor_s * noisefloor;
+
+// create noise floor estimator
+//  _quantile   :   quantile of block energies to track, 0 < _quantile < 1
+//                  (0.5: median; lower values tolerate higher signal
+//                  duty cycles)
+//  _memory     :   effective number of blocks retained, _memory > 1
+noisefloor noisefloor_create(float        _quantile,
+                             unsigned int _memory);
+void noisefloor_destroy(noisefloor _q);
+void noisefloor_print  (noisefloor _q);
+void noisefloor_reset  (noisefloor _q);
+
+// push block energy (e.g. mean |x|^2 over block) into estimator
+void noisefloor_push(noisefloor _q,
+                     float      _x2);
+
+// get noise floor estimate: quantile of block energies (linear,
+// resolved to 0.5 dB bins), or zero if no blocks have been pushed
+float noisefloor_get_level(noisefloor _q);
+
+// get number of blocks pushed since last reset
+unsigned int noisefloor_get_num_blocks(noisefloor _q);
+
 
 
 //
@@ -184,12 +386,30 @@ cvsd cvsd_create(unsigned int _num_bits,
                  float _zeta,
                  float _alpha);
 
+// create multi-channel cvsd object; _num_channels independent
+// signals are coded from interleaved samples by cvsd_encode_block()
+// and cvsd_decode_block()
+//  _num_bits       :   number of adjacent bits to observe
+//  _zeta           :   slope adjustment multiplier
+//  _alpha          :   pre-/post-emphasis filter coefficient
+//  _num_channels   :   number of channels
+cvsd cvsd_create_multi(unsigned int _num_bits,
+                       float        _zeta,
+                       float        _alpha,
+                       unsigned int _num_channels);
+
 // destroy cvsd object
 void cvsd_destroy(cvsd _q);
 
 // print cvsd object parameters
 void cvsd_print(cvsd _q);
 
+// reset internal state of all channels
+void cvsd_reset(cvsd _q);
+
+// get number of channels
+unsigned int cvsd_get_num_channels(cvsd _q);
+
 // encode/decode single sample
 unsigned char   cvsd_encode(cvsd _q, float _audio_sample);
 float           cvsd_decode(cvsd _q, unsigned char _bit);
@@ -198,12 +418,37 @@ float           cvsd_decode(cvsd _q, unsigned char _bit);
 void cvsd_encode8(cvsd _q, float * _audio, unsigned char * _data);
 void cvsd_decode8(cvsd _q, unsigned char _data, float * _audio);
 
+// encode block of samples, eight samples to each byte (msb first); for
+// multi-channel objects _audio[i*num_channels + c] is sample i of
+// channel c and _data[j*num_channels + c] is byte j of channel c
+//  _q      :   cvsd object
+//  _audio  :   audio samples [size: 8*_n*num_channels x 1]
+//  _n      :   number of output bytes per channel
+//  _data   :   encoded bytes [size: _n*num_channels x 1]
+void cvsd_encode_block(cvsd            _q,
+                       const float *   _audio,
+                       unsigned int    _n,
+                       unsigned char * _data);
+
+// decode block of bytes, eight samples from each byte (msb first),
+// interleaved by channel as in cvsd_encode_block()
+//  _q      :   cvsd object
+//  _data   :   encoded bytes [size: _n*num_channels x 1]
+//  _n      :   number of input bytes per channel
+//  _audio  :   audio samples [size: 8*_n*num_channels x 1]
+void cvsd_decode_block(cvsd                  _q,
+                       const unsigned char * _data,
+                       unsigned int          _n,
+                       float *               _audio);
+
 
 //
 // MODULE : buffer
 //
 
-// circular buffer
+// circular buffer; safe without locking for one producer thread
+// (push, write, reserve/commit) and one consumer thread (pop,
+// read/release)
 #define CBUFFER_MANGLE_FLOAT(name)  LIQUID_CONCAT(cbufferf,  name)
 #define CBUFFER_MANGLE_CFLOAT(name) LIQUID_CONCAT(cbuffercf, name)
 
@@ -263,6 +508,20 @@ void CBUFFER(_write)(CBUFFER()    _q,                           \
                      T *          _v,                           \
                      unsigned int _n);                          \
                                                                 \
+/* reserve contiguous space for writing samples in place    */  \
+/*  _q              : circular buffer object                */  \
+/*  _num_requested  : number of elements requested          */  \
+/*  _v              : output pointer                        */  \
+/*  _num_reserved   : number of elements referenced by _v   */  \
+void CBUFFER(_reserve)(CBUFFER()      _q,                       \
+                       unsigned int   _num_requested,           \
+                       T **           _v,                       \
+                       unsigned int * _num_reserved);           \
+                                                                \
+/* commit _n samples written in place after _reserve()      */  \
+void CBUFFER(_commit)(CBUFFER()    _q,                          \
+                      unsigned int _n);                         \
+                                                                \
 /* remove and return a single element from the buffer       */  \
 /*  _q  : circular buffer object                            */  \
 /*  _v  : pointer to sample output                          */  \
@@ -314,6 +573,9 @@ void WINDOW(_destroy)(WINDOW() _q);                             \
 /* print window object to stdout                            */  \
 void WINDOW(_print)(WINDOW() _q);                               \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int WINDOW(_get_memory_usage)(WINDOW() _q);       \
+                                                                \
 /* print window object to stdout (with extra information)   */  \
 void WINDOW(_debug_print)(WINDOW() _q);                         \
                                                                 \
@@ -380,6 +642,9 @@ void WDELAY(_destroy)(WDELAY() _q);                             \
 /* print delay buffer object's state to stdout              */  \
 void WDELAY(_print)(WDELAY() _q);                               \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int WDELAY(_get_memory_usage)(WDELAY() _q);       \
+                                                                \
 /* clear/reset state of object                              */  \
 void WDELAY(_clear)(WDELAY() _q);                               \
                                                                 \
@@ -394,6 +659,18 @@ void WDELAY(_read)(WDELAY() _q,                                 \
 /*  _v  :   new value to be added to buffer                 */  \
 void WDELAY(_push)(WDELAY() _q,                                 \
                    T        _v);                                \
+                                                                \
+/* execute delay on block of samples, equivalent to read()  */  \
+/* followed by push() for each sample                       */  \
+/*  _q  :   delay buffer object                             */  \
+/*  _x  :   input samples [size: _n x 1]                    */  \
+/*  _n  :   number of input, output samples                 */  \
+/*  _y  :   output samples, must not overlap _x             */  \
+/*          [size: _n x 1]                                  */  \
+void WDELAY(_execute_block)(WDELAY()     _q,                    \
+                            T *          _x,                    \
+                            unsigned int _n,                    \
+                            T *          _y);                   \
 
 // Define wdelay APIs
 LIQUID_WDELAY_DEFINE_API(WDELAY_MANGLE_FLOAT,  float)
@@ -470,14 +747,22 @@ void CHANNEL(_add_shadowing)(CHANNEL()    _q,                   \
                              float        _sigma,               \
                              float        _fd);                 \
                                                                 \
+/* set seed for noise and shadowing; objects with distinct  */  \
+/* seeds are independent and may be run concurrently        */  \
+/*  _q      : channel object                                */  \
+/*  _seed   : seed value                                    */  \
+void CHANNEL(_set_seed)(CHANNEL()    _q,                        \
+                        unsigned int _seed);                    \
+                                                                \
 /* get nominal delay [samples]                              */  \
 unsigned int CHANNEL(_get_delay)(CHANNEL() _q);                 \
                                                                 \
-/* apply channel impairments on input array                 */  \
+/* apply channel impairments on input array; impairments    */  \
+/* are applied stage by stage over the whole block          */  \
 /*  _q      : channel object                                */  \
 /*  _x      : input array [size: _nx x 1]                   */  \
 /*  _nx     : input array length                            */  \
-/*  _y      : output array                                  */  \
+/*  _y      : output array, must not overlap _x             */  \
 /*  _ny     : output array length                           */  \
 void CHANNEL(_execute)(CHANNEL()      _q,                       \
                        TI *           _x,                       \
@@ -523,6 +808,13 @@ void TVMPCH(_reset)(TVMPCH() _q);                               \
 /* print channel object internals to standard output        */  \
 void TVMPCH(_print)(TVMPCH() _q);                               \
                                                                 \
+/* set seed for coefficient variation; objects with         */  \
+/* distinct seeds are independent                           */  \
+/*  _q      : channel object                                */  \
+/*  _seed   : seed value                                    */  \
+void TVMPCH(_set_seed)(TVMPCH()     _q,                         \
+                       unsigned int _seed);                     \
+                                                                \
 /* push sample into emulator                                */  \
 /*  _q      : channel object                                */  \
 /*  _x      : input sample                                  */  \
@@ -555,6 +847,70 @@ LIQUID_TVMPCH_DEFINE_API(TVMPCH_MANGLE_CCCF,
 // MODULE : dotprod (vector dot product)
 //
 
+// SIMD kernel levels; x86 levels are ordered by capability
+typedef enum {
+    LIQUID_SIMD_PORTABLE=0, // portable C
+    LIQUID_SIMD_SSE,        // x86 SSE/SSE2/SSE3
+    LIQUID_SIMD_AVX2,       // x86 AVX2 with FMA
+    LIQUID_SIMD_AVX512F,    // x86 AVX-512F
+    LIQUID_SIMD_NEON,       // ARM Neon
+    LIQUID_SIMD_ALTIVEC,    // PowerPC AltiVec
+    LIQUID_SIMD_NUM_LEVELS
+} liquid_simd_level;
+
+// kernel families dispatched on the SIMD level
+typedef enum {
+    LIQUID_SIMD_DOTPROD_RRRF=0, // dotprod_rrrf objects
+    LIQUID_SIMD_DOTPROD_CRCF,   // dotprod_crcf objects
+    LIQUID_SIMD_DOTPROD_CCCF,   // dotprod_cccf objects
+    LIQUID_SIMD_DOTPROD_BLOCK,  // dotprod_xxxt_run_block()
+    LIQUID_SIMD_DOTPROD_BATCH,  // dotprod_xxxt_execute_batch_shared()
+    LIQUID_SIMD_SUMSQ,          // liquid_sumsqf(), liquid_sumsqcf()
+    LIQUID_SIMD_VECTOR,         // liquid_vectorf_*(), liquid_vectorcf_*()
+    LIQUID_SIMD_DOTPROD_Q16,    // dotprod_rrrq16, dotprod_crcq16 objects
+    LIQUID_SIMD_FFT,            // internal radix-2 fft butterflies
+    LIQUID_SIMD_SPGRAM,         // spgram windowing, psd accumulation
+    LIQUID_SIMD_VITERBI,        // convolutional decoder add-compare-select
+    LIQUID_SIMD_MODEM,          // modem_*_block() slicers, freqdem blocks
+    LIQUID_SIMD_NCO,            // nco_crcf_mix_block_*()
+    LIQUID_SIMD_OFDM,           // ofdmframegen taper overlap-add
+    LIQUID_SIMD_MATRIX,         // matrixf, matrixcf multiply/factorization
+    LIQUID_SIMD_AUDIO,          // multi-channel cvsd_*_block(), companding
+    LIQUID_SIMD_SCRAMBLE,       // scramble_data(), unscramble_data[_soft]()
+    LIQUID_SIMD_DOTPROD_F16,    // dotprod_rrrh_run(), half-precision banks
+    LIQUID_SIMD_TRIG,           // liquid_sincosf_block()
+    LIQUID_SIMD_EQUALIZER,      // eqlms fused update/dot product
+    LIQUID_SIMD_NUM_FAMILIES
+} liquid_simd_family;
+
+// get string describing SIMD level (e.g. "avx2")
+const char * liquid_simd_level_str(liquid_simd_level _level);
+
+// get string describing kernel family (e.g. "dotprod_crcf")
+const char * liquid_simd_family_str(liquid_simd_family _family);
+
+// get highest SIMD level supported by both the host cpu and this build
+liquid_simd_level liquid_simd_get_host_level(void);
+
+// get SIMD level currently used for dispatch; this defaults to the
+// host level
+liquid_simd_level liquid_simd_get_level(void);
+
+// set SIMD level used for dispatch, returning the level in effect.
+// Levels which are not supported by the host or the build are
+// rejected with a warning and the current level is kept. Dotprod
+// objects bind their kernel when created (or re-created); the
+// stateless methods (e.g. liquid_sumsqf) follow the level on every
+// call.
+liquid_simd_level liquid_simd_set_level(liquid_simd_level _level);
+
+// get SIMD level of the kernel a family resolves to at the current
+// dispatch level
+liquid_simd_level liquid_simd_get_kernel(liquid_simd_family _family);
+
+// print host level, dispatch level and resolved kernel of each family
+void liquid_simd_print(void);
+
 #define DOTPROD_MANGLE_RRRF(name)   LIQUID_CONCAT(dotprod_rrrf,name)
 #define DOTPROD_MANGLE_CCCF(name)   LIQUID_CONCAT(dotprod_cccf,name)
 #define DOTPROD_MANGLE_CRCF(name)   LIQUID_CONCAT(dotprod_crcf,name)
@@ -574,6 +930,31 @@ LIQUID_TVMPCH_DEFINE_API(TVMPCH_MANGLE_CCCF,
 void DOTPROD(_run)( TC *_v, TI *_x, unsigned int _n, TO *_y);   \
 void DOTPROD(_run4)(TC *_v, TI *_x, unsigned int _n, TO *_y);   \
                                                                 \
+/* run dot product on block of consecutive outputs          */  \
+/*  _v      : coefficients array [size: _n x 1]             */  \
+/*  _n      : dotprod length, _n > 0                        */  \
+/*  _x      : input [size: (_num-1)*_stride + _n x 1]       */  \
+/*  _stride : input offset between outputs, _stride > 0     */  \
+/*  _num    : number of outputs                             */  \
+/*  _y      : output array [size: _num x 1]                 */  \
+void DOTPROD(_run_block)(TC *         _v,                       \
+                         unsigned int _n,                       \
+                         TI *         _x,                       \
+                         unsigned int _stride,                  \
+                         unsigned int _num,                     \
+                         TO *         _y);                      \
+                                                                \
+/* run folded symmetric dot product, pre-adding mirrored    */  \
+/* inputs for even-symmetric coefficients h[i] = h[_n-1-i]  */  \
+/*  _h      : first half of coefficients [size: ceil(_n/2)] */  \
+/*  _n      : full dot product length, _n > 0               */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _y      : output sample pointer                         */  \
+void DOTPROD(_run_sym)(TC *         _h,                         \
+                       unsigned int _n,                         \
+                       TI *         _x,                         \
+                       TO *         _y);                        \
+                                                                \
 typedef struct DOTPROD(_s) * DOTPROD();                         \
                                                                 \
 /* create dot product object                                */  \
@@ -582,7 +963,8 @@ typedef struct DOTPROD(_s) * DOTPROD();                         \
 DOTPROD() DOTPROD(_create)(TC *         _v,                     \
                            unsigned int _n);                    \
                                                                 \
-/* re-create dot product object                             */  \
+/* re-create dot product object; coefficients are updated  */  \
+/* in place (without allocation) if _n is unchanged         */  \
 /*  _q      : old dotprod object                            */  \
 /*  _v      : coefficients array [size: _n x 1]             */  \
 /*  _n      : dotprod length, _n > 0                        */  \
@@ -590,12 +972,22 @@ DOTPROD() DOTPROD(_recreate)(DOTPROD()    _q,                   \
                              TC *         _v,                   \
                              unsigned int _n);                  \
                                                                 \
+/* overwrite coefficients in place without allocation       */  \
+/*  _q      : dotprod object                                */  \
+/*  _v      : coefficients array [size: _n x 1] where _n is */  \
+/*            the length the object was created with        */  \
+void DOTPROD(_update_coefficients)(DOTPROD() _q,                \
+                                   TC *      _v);               \
+                                                                \
 /* destroy dotprod object, freeing all internal memory      */  \
 void DOTPROD(_destroy)(DOTPROD() _q);                           \
                                                                 \
 /* print dotprod object internals to standard output        */  \
 void DOTPROD(_print)(DOTPROD() _q);                             \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int DOTPROD(_get_memory_usage)(DOTPROD() _q);     \
+                                                                \
 /* execute dot product                                      */  \
 /*  _q      : dotprod object                                */  \
 /*  _x      : input array [size: _n x 1]                    */  \
@@ -603,6 +995,62 @@ void DOTPROD(_print)(DOTPROD() _q);                             \
 void DOTPROD(_execute)(DOTPROD() _q,                            \
                        TI *      _x,                            \
                        TO *      _y);                           \
+                                                                \
+/* batched dot product object: computes several dot         */  \
+/* products of equal length against separate coefficient    */  \
+/* sets and input arrays in a single call                   */  \
+typedef struct DOTPROD(_batch_s) * DOTPROD(_batch);             \
+                                                                \
+/* create batched dot product object                        */  \
+/*  _v      : coefficients, one set after another           */  \
+/*            [size: _num*_n x 1]                           */  \
+/*  _n      : length of each dot product, _n > 0            */  \
+/*  _num    : number of dot products, _num > 0              */  \
+DOTPROD(_batch) DOTPROD(_batch_create)(TC *         _v,         \
+                                       unsigned int _n,         \
+                                       unsigned int _num);      \
+                                                                \
+/* overwrite coefficients in place without allocation       */  \
+/*  _q      : batched dotprod object                        */  \
+/*  _v      : coefficients, one set after another           */  \
+/*            [size: _num*_n x 1]                           */  \
+void DOTPROD(_batch_update_coefficients)(DOTPROD(_batch) _q,    \
+                                         TC *            _v);   \
+                                                                \
+/* read back coefficients, one set after another            */  \
+/*  _q      : batched dotprod object                        */  \
+/*  _v      : coefficients array [size: _num*_n x 1]        */  \
+void DOTPROD(_batch_get_coefficients)(DOTPROD(_batch) _q,       \
+                                      TC *            _v);      \
+                                                                \
+/* destroy batched dotprod object, freeing internal memory  */  \
+void DOTPROD(_batch_destroy)(DOTPROD(_batch) _q);               \
+                                                                \
+/* print batched dotprod object internals to stdout         */  \
+void DOTPROD(_batch_print)(DOTPROD(_batch) _q);                 \
+                                                                \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int DOTPROD(_batch_get_memory_usage)(             \
+                        DOTPROD(_batch) _q);                    \
+                                                                \
+/* execute batched dot product                              */  \
+/*  _q      : batched dotprod object                        */  \
+/*  _x      : input array pointers [size: _num x 1], each   */  \
+/*            pointing to an array of [size: _n x 1]        */  \
+/*  _y      : output samples [size: _num x 1]               */  \
+void DOTPROD(_execute_batch)(DOTPROD(_batch) _q,                \
+                             TI **           _x,                \
+                             TO *            _y);               \
+                                                                \
+/* execute batched dot product with all coefficient sets    */  \
+/* applied to one shared input, loading each input sample   */  \
+/* once for all outputs                                     */  \
+/*  _q      : batched dotprod object                        */  \
+/*  _x      : shared input array [size: _n x 1]             */  \
+/*  _y      : output samples [size: _num x 1]               */  \
+void DOTPROD(_execute_batch_shared)(DOTPROD(_batch) _q,         \
+                                    TI *            _x,         \
+                                    TO *            _y);        \
 
 LIQUID_DOTPROD_DEFINE_API(DOTPROD_MANGLE_RRRF,
                           float,
@@ -619,6 +1067,125 @@ LIQUID_DOTPROD_DEFINE_API(DOTPROD_MANGLE_CRCF,
                           float,
                           liquid_float_complex)
 
+#define DOTPROD_MANGLE_RRRQ16(name) LIQUID_CONCAT(dotprod_rrrq16,name)
+#define DOTPROD_MANGLE_CRCQ16(name) LIQUID_CONCAT(dotprod_crcq16,name)
+
+// fixed-point (Q15) dot product: products are accumulated with
+// 32-bit precision and the result is rounded and saturated back to
+// Q15. The accumulator cannot overflow as long as the sum of the
+// absolute values of the coefficients does not exceed one.
+//   DOTPROD    : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_DOTPRODQ16_DEFINE_API(DOTPROD,TO,TC,TI)          \
+                                                                \
+/* run dot product without creating object                  */  \
+/*  _v      : coefficients array [size: _n x 1]             */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _n      : dotprod length, _n > 0                        */  \
+/*  _y      : output sample pointer                         */  \
+void DOTPROD(_run)(TC *_v, TI *_x, unsigned int _n, TO *_y);    \
+                                                                \
+typedef struct DOTPROD(_s) * DOTPROD();                         \
+                                                                \
+/* create dot product object                                */  \
+/*  _v      : coefficients array [size: _n x 1]             */  \
+/*  _n      : dotprod length, _n > 0                        */  \
+DOTPROD() DOTPROD(_create)(TC *         _v,                     \
+                           unsigned int _n);                    \
+                                                                \
+/* re-create dot product object; coefficients are updated  */  \
+/* in place (without allocation) if _n is unchanged         */  \
+DOTPROD() DOTPROD(_recreate)(DOTPROD()    _q,                   \
+                             TC *         _v,                   \
+                             unsigned int _n);                  \
+                                                                \
+/* overwrite coefficients in place without allocation       */  \
+void DOTPROD(_update_coefficients)(DOTPROD() _q,                \
+                                   TC *      _v);               \
+                                                                \
+/* destroy dotprod object, freeing all internal memory      */  \
+void DOTPROD(_destroy)(DOTPROD() _q);                           \
+                                                                \
+/* print dotprod object internals to standard output        */  \
+void DOTPROD(_print)(DOTPROD() _q);                             \
+                                                                \
+/* execute dot product                                      */  \
+/*  _q      : dotprod object                                */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _y      : output sample pointer                         */  \
+void DOTPROD(_execute)(DOTPROD() _q,                            \
+                       TI *      _x,                            \
+                       TO *      _y);                           \
+
+LIQUID_DOTPRODQ16_DEFINE_API(DOTPROD_MANGLE_RRRQ16,
+                             q16_t,
+                             q16_t,
+                             q16_t)
+
+LIQUID_DOTPRODQ16_DEFINE_API(DOTPROD_MANGLE_CRCQ16,
+                             cq16_t,
+                             q16_t,
+                             cq16_t)
+
+// half-precision (IEEE 754 binary16) coefficients: large filter banks
+// may store their coefficients at half precision to halve their
+// memory footprint; inputs and accumulation remain single precision
+typedef uint16_t liquid_float16;
+
+// convert single-precision value to half precision (round to nearest
+// even, saturating to infinity)
+liquid_float16 liquid_float_to_float16(float _x);
+
+// convert half-precision value to single precision (exact)
+float liquid_float16_to_float(liquid_float16 _h);
+
+// convert array to half precision
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of values
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorf_to_float16(const float *    _x,
+                               unsigned int     _n,
+                               liquid_float16 * _y);
+
+// dot products with half-precision coefficients (no object interface)
+//  _h      :   coefficients [size: _n x 1, 2*_n x 1 interleaved for ccch]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dotprod length
+//  _y      :   output sample pointer
+void dotprod_rrrh_run(const liquid_float16 * _h,
+                      const float *          _x,
+                      unsigned int           _n,
+                      float *                _y);
+void dotprod_crch_run(const liquid_float16 *       _h,
+                      const liquid_float_complex * _x,
+                      unsigned int                 _n,
+                      liquid_float_complex *       _y);
+void dotprod_ccch_run(const liquid_float16 *       _h,
+                      const liquid_float_complex * _x,
+                      unsigned int                 _n,
+                      liquid_float_complex *       _y);
+
+// dot products on split-complex inputs, with real and imaginary parts
+// held in separate arrays (see liquid_vectorcf_split())
+//  _hr,_hi :   coefficients, real/imaginary parts [size: _n x 1]
+//  _h      :   real coefficients [size: _n x 1]
+//  _xr,_xi :   input array, real/imaginary parts [size: _n x 1]
+//  _n      :   dotprod length
+//  _y      :   output sample pointer
+void dotprod_cccf_run_split(const float *          _hr,
+                            const float *          _hi,
+                            const float *          _xr,
+                            const float *          _xi,
+                            unsigned int           _n,
+                            liquid_float_complex * _y);
+void dotprod_crcf_run_split(const float *          _h,
+                            const float *          _xr,
+                            const float *          _xi,
+                            unsigned int           _n,
+                            liquid_float_complex * _y);
+
 // 
 // sum squared methods
 //
@@ -629,6 +1196,18 @@ float liquid_sumsqf(float *      _v,
 float liquid_sumsqcf(liquid_float_complex * _v,
                      unsigned int           _n);
 
+// sum of squares and peak magnitude, computed in a single pass
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length
+//  _peak   :   output peak magnitude, max(|_v[i]|)
+float liquid_sumsqf_peak(float *      _v,
+                         unsigned int _n,
+                         float *      _peak);
+
+float liquid_sumsqcf_peak(liquid_float_complex * _v,
+                          unsigned int           _n,
+                          float *                _peak);
+
 
 //
 // MODULE : equalization
@@ -685,6 +1264,9 @@ void EQLMS(_reset)(EQLMS() _q);                                 \
 /* print equalizer internal state                           */  \
 void EQLMS(_print)(EQLMS() _q);                                 \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int EQLMS(_get_memory_usage)(EQLMS() _q);         \
+                                                                \
 /* get/set equalizer learning rate                          */  \
 float EQLMS(_get_bw)(EQLMS() _q);                               \
 void  EQLMS(_set_bw)(EQLMS() _q,                                \
@@ -753,10 +1335,90 @@ void EQLMS(_train)(EQLMS()      _q,                             \
                    T *          _x,                             \
                    T *          _d,                             \
                    unsigned int _n);                            \
+                                                                \
+/* run equalizer over block of symbols, training on each;   */  \
+/* equivalent to push (x _k), execute and step per symbol   */  \
+/* with the weight update fused into the next dot product   */  \
+/*  _q      :   equalizer object                            */  \
+/*  _k      :   samples per symbol                          */  \
+/*  _x      :   input sample array [size: _k*_n x 1]        */  \
+/*  _d      :   desired outputs [size: _n x 1], NULL: blind */  \
+/*  _n      :   number of symbols                           */  \
+/*  _y      :   outputs [size: _n x 1], ignored if NULL     */  \
+void EQLMS(_train_block)(EQLMS()      _q,                       \
+                         unsigned int _k,                       \
+                         T *          _x,                       \
+                         T *          _d,                       \
+                         unsigned int _n,                       \
+                         T *          _y);                      \
 
 LIQUID_EQLMS_DEFINE_API(EQLMS_MANGLE_RRRF, float);
 LIQUID_EQLMS_DEFINE_API(EQLMS_MANGLE_CCCF, liquid_float_complex);
 
+// block frequency-domain least mean-squares (FLMS): weights are
+// updated once per block of h_len samples through transforms of size
+// 2*h_len (constrained overlap-save), for O(log h_len) operations
+// per sample on long equalizers
+typedef struct eqflms_cccf_s * eqflms_cccf;
+
+// create FLMS EQ initialized with external coefficients
+//  _h      : filter coefficients in eqlms order (NULL for {1,0,0...})
+//  _h_len  : filter length (block length)
+eqflms_cccf eqflms_cccf_create(liquid_float_complex * _h,
+                               unsigned int           _h_len);
+void eqflms_cccf_destroy(eqflms_cccf _q);
+void eqflms_cccf_reset(  eqflms_cccf _q);
+void eqflms_cccf_print(  eqflms_cccf _q);
+
+// get/set equalizer learning rate, normalized as eqlms
+float eqflms_cccf_get_bw(eqflms_cccf _q);
+void  eqflms_cccf_set_bw(eqflms_cccf _q,
+                         float       _mu);
+
+// execute equalizer with block of samples using constant modulus
+// algorithm, operating on a decimation rate of _k samples; the
+// output does not depend on how input is split across calls
+//  _q      :   equalizer object
+//  _k      :   down-sampling rate
+//  _x      :   input sample array [size: _n x 1]
+//  _n      :   input sample array length
+//  _y      :   output sample array [size: _n x 1]
+void eqflms_cccf_execute_block(eqflms_cccf            _q,
+                               unsigned int           _k,
+                               liquid_float_complex * _x,
+                               unsigned int           _n,
+                               liquid_float_complex * _y);
+
+// execute equalizer with block of samples and known desired output
+//  _q      :   equalizer object
+//  _x      :   input sample array [size: _n x 1]
+//  _d      :   desired output array [size: _n x 1]
+//  _n      :   input sample array length
+//  _y      :   output sample array [size: _n x 1]
+void eqflms_cccf_execute_training(eqflms_cccf            _q,
+                                  liquid_float_complex * _x,
+                                  liquid_float_complex * _d,
+                                  unsigned int           _n,
+                                  liquid_float_complex * _y);
+
+// get equalizer weights, y[n] = sum_k w[k] x[n-k] (as eqlms)
+//  _q      :   equalizer object
+//  _w      :   weights [size: _h_len x 1]
+void eqflms_cccf_get_weights(eqflms_cccf            _q,
+                             liquid_float_complex * _w);
+
+// train equalizer object on group of samples
+//  _q      :   equalizer object
+//  _w      :   input/output weights, as get_weights() [size: _h_len x 1]
+//  _x      :   received sample vector [size: _n x 1]
+//  _d      :   desired output vector  [size: _n x 1]
+//  _n      :   input, output vector length
+void eqflms_cccf_train(eqflms_cccf            _q,
+                       liquid_float_complex * _w,
+                       liquid_float_complex * _x,
+                       liquid_float_complex * _d,
+                       unsigned int           _n);
+
 
 // recursive least-squares (RLS)
 #define EQRLS_MANGLE_RRRF(name)     LIQUID_CONCAT(eqrls_rrrf,name)
@@ -774,6 +1436,14 @@ typedef struct EQRLS(_s) * EQRLS();                             \
 EQRLS() EQRLS(_create)(T *          _h,                         \
                        unsigned int _p);                        \
                                                                 \
+/* create RLS EQ using the stabilized fast transversal      */  \
+/* filter recursion: O(_p) rather than O(_p^2) operations   */  \
+/* per update with the same push/execute/step interface     */  \
+/*  _h  : filter coefficients (NULL for {1,0,0...})         */  \
+/*  _p  : filter length                                     */  \
+EQRLS() EQRLS(_create_fast)(T *          _h,                    \
+                            unsigned int _p);                   \
+                                                                \
 /* re-create RLS EQ initialized with external coefficients  */  \
 /*  _q  : initial equalizer object                          */  \
 /*  _h  : filter coefficients (NULL for {1,0,0...})         */  \
@@ -844,7 +1514,7 @@ LIQUID_EQRLS_DEFINE_API(EQRLS_MANGLE_CCCF, liquid_float_complex);
 #define LIQUID_SOFTBIT_ERASURE  (127)
 
 // available CRC schemes
-#define LIQUID_CRC_NUM_SCHEMES  7
+#define LIQUID_CRC_NUM_SCHEMES  8
 typedef enum {
     LIQUID_CRC_UNKNOWN=0,   // unknown/unavailable CRC scheme
     LIQUID_CRC_NONE,        // no error-detection
@@ -852,7 +1522,8 @@ typedef enum {
     LIQUID_CRC_8,           // 8-bit CRC
     LIQUID_CRC_16,          // 16-bit CRC
     LIQUID_CRC_24,          // 24-bit CRC
-    LIQUID_CRC_32           // 32-bit CRC
+    LIQUID_CRC_32,          // 32-bit CRC
+    LIQUID_CRC_32C          // 32-bit CRC (Castagnoli polynomial)
 } crc_scheme;
 
 // pretty names for crc schemes
@@ -906,7 +1577,7 @@ unsigned int crc_sizeof_key(crc_scheme _scheme);
 
 
 // available FEC schemes
-#define LIQUID_FEC_NUM_SCHEMES  28
+#define LIQUID_FEC_NUM_SCHEMES  31
 typedef enum {
     LIQUID_FEC_UNKNOWN=0,       // unknown/unsupported scheme
     LIQUID_FEC_NONE,            // no error-correction
@@ -943,7 +1614,12 @@ typedef enum {
     LIQUID_FEC_CONV_V29P78,     // r7/8, K=9, dfree=4
 
     // Reed-Solomon codes
-    LIQUID_FEC_RS_M8            // m=8, n=255, k=223
+    LIQUID_FEC_RS_M8,           // m=8, n=255, k=223
+
+    // low-density parity-check codes, n=648
+    LIQUID_FEC_LDPC_R12,        // r1/2, k=324
+    LIQUID_FEC_LDPC_R23,        // r2/3, k=432
+    LIQUID_FEC_LDPC_R34         // r3/4, k=486
 } fec_scheme;
 
 // pretty names for fec schemes
@@ -969,6 +1645,20 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
 // correction scheme (object-independent method)
 float fec_get_rate(fec_scheme _scheme);
 
+// count codewords of an encoded message whose syndromes indicate an
+// error pattern beyond the correcting capability of the code, without
+// decoding (object-independent method); only Hamming(8,4), Golay(24,12)
+// and SEC-DED codes detect such errors, other schemes report no
+// codewords checked
+//  _scheme         :   forward error-correction scheme
+//  _dec_msg_len    :   decoded message length
+//  _msg_enc        :   encoded message
+//  _num_codewords  :   number of codewords checked
+unsigned int fec_count_uncorrectable(fec_scheme            _scheme,
+                                     unsigned int          _dec_msg_len,
+                                     const unsigned char * _msg_enc,
+                                     unsigned int *        _num_codewords);
+
 // create a fec object of a particular scheme
 //  _scheme     :   error-correction scheme
 //  _opts       :   (ignored)
@@ -1019,6 +1709,25 @@ void fec_decode_soft(fec _q,
                      unsigned char * _msg_enc,
                      unsigned char * _msg_dec);
 
+// Shared fec object pool: objects are borrowed only for the duration of
+// an encode/decode operation, so that many users of the same scheme
+// share a small number of objects. Acquire and release are lock-free
+// and may be called from any thread.
+
+// borrow fec object from pool, creating one if none is idle; the caller
+// has exclusive use of the object until it is released
+//  _scheme     :   error-correction scheme
+fec fec_pool_acquire(fec_scheme _scheme);
+
+// return fec object obtained from fec_pool_acquire() to pool
+void fec_pool_release(fec _q);
+
+// destroy all idle objects in pool
+void fec_pool_clear();
+
+// get number of idle objects of scheme in pool
+unsigned int fec_pool_get_num_idle(fec_scheme _scheme);
+
 // 
 // Packetizer
 //
@@ -1077,6 +1786,9 @@ void packetizer_destroy(packetizer _p);
 // print packetizer object internals
 void packetizer_print(packetizer _p);
 
+// get memory footprint of object and its buffers [bytes]
+unsigned long int packetizer_get_memory_usage(packetizer _p);
+
 // access methods
 unsigned int packetizer_get_dec_msg_len(packetizer _p);
 unsigned int packetizer_get_enc_msg_len(packetizer _p);
@@ -1114,6 +1826,20 @@ int packetizer_decode_soft(packetizer            _p,
                            const unsigned char * _pkt,
                            unsigned char *       _msg);
 
+// Check an encoded message before decoding: de-interleave the outer
+// (last applied) error-correction code and count codewords whose
+// syndromes flag uncorrectable errors (see fec_count_uncorrectable),
+// returning 0 if their fraction exceeds _threshold (the message is
+// almost certainly noise), and 1 otherwise or if the outer code cannot
+// detect such errors
+//
+//  _p          :   packetizer object
+//  _pkt        :   input message (coded bytes)
+//  _threshold  :   maximum fraction of uncorrectable codewords
+int packetizer_precheck(packetizer            _p,
+                        const unsigned char * _pkt,
+                        float                 _threshold);
+
 
 //
 // interleaver
@@ -1130,6 +1856,9 @@ void interleaver_destroy(interleaver _q);
 // print interleaver object internals
 void interleaver_print(interleaver _q);
 
+// get memory footprint of object and its buffers [bytes]
+unsigned long int interleaver_get_memory_usage(interleaver _q);
+
 // set depth (number of internal iterations)
 //  _q      :   interleaver object
 //  _depth  :   depth
@@ -1197,8 +1926,29 @@ typedef enum {
     // modified discrete cosine transform
     LIQUID_FFT_MDCT     =  30,  // MDCT
     LIQUID_FFT_IMDCT    =  31,  // IMDCT
+
+    // real-input/real-output complex transforms
+    LIQUID_FFT_R2C      =  40,  // real input, _n/2+1 complex outputs (forward)
+    LIQUID_FFT_C2R      =  41,  // _n/2+1 complex inputs, real output (backward)
 } liquid_fft_type;
 
+// plan flags (_flags argument of fft_create_plan()); at most one
+// LIQUID_FFT_FORCE_* value may be given and it only applies to the
+// top-level transform (sub-transforms are planned as usual)
+#define LIQUID_FFT_ESTIMATE             (0)     // choose method by size (default)
+#define LIQUID_FFT_MEASURE              (1<<0)  // time candidate methods, keep fastest
+#define LIQUID_FFT_FORCE_RADIX2         (1<<4)  // force radix-2 transform
+#define LIQUID_FFT_FORCE_MIXED_RADIX    (2<<4)  // force Cooley-Tukey mixed-radix transform
+#define LIQUID_FFT_FORCE_RADER          (3<<4)  // force Rader's method (prime length)
+#define LIQUID_FFT_FORCE_RADER2         (4<<4)  // force Rader's alternate method (prime length)
+#define LIQUID_FFT_FORCE_DFT            (5<<4)  // force regular DFT
+#define LIQUID_FFT_FORCE_STOCKHAM       (6<<4)  // force Stockham auto-sort transform
+#define LIQUID_FFT_FORCE_MASK           (7<<4)  // mask for LIQUID_FFT_FORCE_* values
+
+// pruned side of fft_create_plan_pruned()
+#define LIQUID_FFT_PRUNE_INPUT          (0)     // input zero outside band
+#define LIQUID_FFT_PRUNE_OUTPUT         (1)     // output only needed on band
+
 #define LIQUID_FFT_MANGLE_FLOAT(name)   LIQUID_CONCAT(fft,name)
 
 // Macro    :   FFT
@@ -1214,7 +1964,7 @@ typedef struct FFT(plan_s) * FFT(plan);                         \
 /*  _x      :   pointer to input array  [size: _n x 1]      */  \
 /*  _y      :   pointer to output array [size: _n x 1]      */  \
 /*  _dir    :   direction (e.g. LIQUID_FFT_FORWARD)         */  \
-/*  _flags  :   options, optimization                       */  \
+/*  _flags  :   options, e.g. LIQUID_FFT_MEASURE            */  \
 FFT(plan) FFT(_create_plan)(unsigned int _n,                    \
                             TC *         _x,                    \
                             TC *         _y,                    \
@@ -1233,12 +1983,104 @@ FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _n,             \
                                    int          _type,          \
                                    int          _flags);        \
                                                                 \
+/* create real-to-complex (forward) transform; only the     */  \
+/* non-negative frequencies are computed, the remainder is  */  \
+/* given by Y[_n-k] = conj(Y[k])                            */  \
+/*  _n      :   transform size                              */  \
+/*  _x      :   pointer to real input array [size: _n x 1]  */  \
+/*  _y      :   pointer to output array [size: _n/2+1 x 1]  */  \
+/*  _flags  :   options, e.g. LIQUID_FFT_MEASURE            */  \
+FFT(plan) FFT(_create_plan_r2c_1d)(unsigned int _n,             \
+                                   T *          _x,             \
+                                   TC *         _y,             \
+                                   int          _flags);        \
+                                                                \
+/* create complex-to-real (backward, unnormalized) transform */ \
+/* from the non-negative frequencies of a Hermitian input   */  \
+/*  _n      :   transform size                              */  \
+/*  _x      :   pointer to input array [size: _n/2+1 x 1]   */  \
+/*  _y      :   pointer to real output array [size: _n x 1] */  \
+/*  _flags  :   options, e.g. LIQUID_FFT_MEASURE            */  \
+FFT(plan) FFT(_create_plan_c2r_1d)(unsigned int _n,             \
+                                   TC *         _x,             \
+                                   T *          _y,             \
+                                   int          _flags);        \
+                                                                \
+/* create plan computing _howmany transforms of equal size  */  \
+/* at once; transform b reads _x[b*_idist + i*_istride] and */  \
+/* writes _y[b*_odist + k*_ostride], and may run in place   */  \
+/*  _n      :   transform size                              */  \
+/*  _howmany:   number of transforms                        */  \
+/*  _x      :   pointer to input array                      */  \
+/*  _istride:   input sample stride within a transform      */  \
+/*  _idist  :   input distance between transforms           */  \
+/*  _y      :   pointer to output array                     */  \
+/*  _ostride:   output sample stride within a transform     */  \
+/*  _odist  :   output distance between transforms          */  \
+/*  _dir    :   direction (e.g. LIQUID_FFT_FORWARD)         */  \
+/*  _flags  :   options, e.g. LIQUID_FFT_MEASURE            */  \
+FFT(plan) FFT(_create_plan_many)(unsigned int _n,               \
+                                 unsigned int _howmany,         \
+                                 TC *         _x,               \
+                                 unsigned int _istride,         \
+                                 unsigned int _idist,           \
+                                 TC *         _y,               \
+                                 unsigned int _ostride,         \
+                                 unsigned int _odist,           \
+                                 int          _dir,             \
+                                 int          _flags);          \
+                                                                \
+/* create transform restricted on one side to the cyclic    */  \
+/* band of _len bins starting at _k0: with                  */  \
+/* LIQUID_FFT_PRUNE_INPUT the input outside the band must   */  \
+/* be zero, with LIQUID_FFT_PRUNE_OUTPUT only the output on */  \
+/* the band is computed (the rest is left unspecified);     */  \
+/* falls back to a regular transform when the band is not   */  \
+/* small enough for pruning to pay off                      */  \
+/*  _n      :   transform size                              */  \
+/*  _x      :   pointer to input array  [size: _n x 1]      */  \
+/*  _y      :   pointer to output array [size: _n x 1]      */  \
+/*  _dir    :   direction (e.g. LIQUID_FFT_FORWARD)         */  \
+/*  _flags  :   options, e.g. LIQUID_FFT_MEASURE            */  \
+/*  _k0     :   first bin of band, _k0 < _n                 */  \
+/*  _len    :   band length, _len in [1,_n]                 */  \
+/*  _prune  :   pruned side (e.g. LIQUID_FFT_PRUNE_INPUT)   */  \
+FFT(plan) FFT(_create_plan_pruned)(unsigned int _n,             \
+                                   TC *         _x,             \
+                                   TC *         _y,             \
+                                   int          _dir,           \
+                                   int          _flags,         \
+                                   unsigned int _k0,            \
+                                   unsigned int _len,           \
+                                   int          _prune);        \
+                                                                \
+/* create transform on split-complex arrays, with real and  */  \
+/* imaginary parts held separately (see                     */  \
+/* liquid_vectorcf_split()); may run in place               */  \
+/*  _n      :   transform size                              */  \
+/*  _xr     :   input array, real part [size: _n x 1]       */  \
+/*  _xi     :   input array, imaginary part [size: _n x 1]  */  \
+/*  _yr     :   output array, real part [size: _n x 1]      */  \
+/*  _yi     :   output array, imaginary part [size: _n x 1] */  \
+/*  _dir    :   direction (e.g. LIQUID_FFT_FORWARD)         */  \
+/*  _flags  :   options, e.g. LIQUID_FFT_MEASURE            */  \
+FFT(plan) FFT(_create_plan_split)(unsigned int _n,              \
+                                  T *          _xr,             \
+                                  T *          _xi,             \
+                                  T *          _yr,             \
+                                  T *          _yi,             \
+                                  int          _dir,            \
+                                  int          _flags);         \
+                                                                \
 /* destroy transform                                        */  \
 void FFT(_destroy_plan)(FFT(plan) _p);                          \
                                                                 \
 /* print transform plan and internal strategy               */  \
 void FFT(_print_plan)(FFT(plan) _p);                            \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int FFT(_get_memory_usage)(FFT(plan) _p);         \
+                                                                \
 /* run the transform                                        */  \
 void FFT(_execute)(FFT(plan) _p);                               \
                                                                 \
@@ -1256,6 +2098,23 @@ void FFT(_run)(unsigned int _n,                                 \
                int          _dir,                               \
                int          _flags);                            \
                                                                 \
+/* perform n-point FFT on split-complex arrays allocating   */  \
+/* plan internally                                          */  \
+/*  _n      : fft size                                      */  \
+/*  _xr     : input array, real part [size: _n x 1]         */  \
+/*  _xi     : input array, imaginary part [size: _n x 1]    */  \
+/*  _yr     : output array, real part [size: _n x 1]        */  \
+/*  _yi     : output array, imaginary part [size: _n x 1]   */  \
+/*  _dir    : fft direction: LIQUID_FFT_{FORWARD,BACKWARD}  */  \
+/*  _flags  : fft flags                                     */  \
+void FFT(_run_split)(unsigned int _n,                           \
+                     T *          _xr,                          \
+                     T *          _xi,                          \
+                     T *          _yr,                          \
+                     T *          _yi,                          \
+                     int          _dir,                         \
+                     int          _flags);                      \
+                                                                \
 /* perform n-point real FFT allocating plan internally      */  \
 /*  _nfft   : fft size                                      */  \
 /*  _x      : input array [size: _nfft x 1]                 */  \
@@ -1271,6 +2130,33 @@ void FFT(_r2r_1d_run)(unsigned int _n,                          \
 /* perform _n-point fft shift                               */  \
 void FFT(_shift)(TC *         _x,                               \
                  unsigned int _n);                              \
+                                                                \
+/* wisdom: transform methods chosen by LIQUID_FFT_MEASURE,  */  \
+/* kept per size and direction and re-used by every later   */  \
+/* plan (in any planning mode) of the same size/direction   */  \
+                                                                \
+/* export wisdom to file, returning 0 on success            */  \
+int FFT(_wisdom_export)(const char * _filename);                \
+                                                                \
+/* import wisdom from file (merged with existing wisdom),   */  \
+/* returning number of entries imported or -1 on error      */  \
+int FFT(_wisdom_import)(const char * _filename);                \
+                                                                \
+/* export wisdom to string, returning length of the full    */  \
+/* string; output is truncated to fit _n bytes (including   */  \
+/* the terminating null)                                    */  \
+int FFT(_wisdom_export_string)(char *       _buf,               \
+                               unsigned int _n);                \
+                                                                \
+/* import wisdom from string (merged with existing wisdom), */  \
+/* returning number of entries imported                     */  \
+int FFT(_wisdom_import_string)(const char * _str);              \
+                                                                \
+/* forget all wisdom                                        */  \
+void FFT(_wisdom_forget)(void);                                 \
+                                                                \
+/* print wisdom to stdout                                   */  \
+void FFT(_wisdom_print)(void);                                  \
 
 
 LIQUID_FFT_DEFINE_API(LIQUID_FFT_MANGLE_FLOAT,float,liquid_float_complex)
@@ -1323,6 +2209,16 @@ void SPGRAM(_print)(SPGRAM() _q);                               \
                                                                 \
 /* set methods                                              */  \
 int          SPGRAM(_set_alpha)(SPGRAM() _q, float _alpha);     \
+int          SPGRAM(_set_delay)(SPGRAM()     _q,                \
+                                unsigned int _delay);           \
+                                                                \
+/* limit transforms to _max_rate per second of input at     */  \
+/* _sample_rate; transforms due over budget are skipped and */  \
+/* counted (see _get_num_transforms_skipped()), _max_rate=0 */  \
+/* skips all transforms                                     */  \
+int SPGRAM(_set_transform_budget)(SPGRAM() _q,                  \
+                                  float    _sample_rate,        \
+                                  float    _max_rate);          \
                                                                 \
 /* access methods                                           */  \
 unsigned int SPGRAM(_get_nfft)                (SPGRAM() _q);    \
@@ -1332,6 +2228,7 @@ uint64_t     SPGRAM(_get_num_samples)         (SPGRAM() _q);    \
 uint64_t     SPGRAM(_get_num_samples_total)   (SPGRAM() _q);    \
 uint64_t     SPGRAM(_get_num_transforms)      (SPGRAM() _q);    \
 uint64_t     SPGRAM(_get_num_transforms_total)(SPGRAM() _q);    \
+uint64_t     SPGRAM(_get_num_transforms_skipped)(SPGRAM() _q);  \
 float        SPGRAM(_get_alpha)               (SPGRAM() _q);    \
                                                                 \
 /* push a single sample into the spgram object              */  \
@@ -1372,6 +2269,65 @@ void SPGRAM(_estimate_psd)(unsigned int _nfft,                  \
                            TI *         _x,                     \
                            unsigned int _n,                     \
                            T *          _psd);                  \
+                                                                \
+/* multi-stream spgram: independent PSD estimates of        */  \
+/* several streams sharing one window, one FFT plan and one */  \
+/* pair of FFT buffers (streams must not be written to      */  \
+/* concurrently)                                            */  \
+typedef struct SPGRAM(_multi_s) * SPGRAM(_multi);               \
+                                                                \
+/* create multi-stream spgram object                        */  \
+/*  _num_streams: number of streams, _num_streams > 0       */  \
+/*  _nfft       : FFT size                                  */  \
+/*  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING   */  \
+/*  _window_len : window length, _window_len in [1,_nfft]   */  \
+/*  _delay      : delay between transforms, _delay > 0      */  \
+SPGRAM(_multi) SPGRAM(_multi_create)(unsigned int _num_streams, \
+                                     unsigned int _nfft,        \
+                                     int          _wtype,       \
+                                     unsigned int _window_len,  \
+                                     unsigned int _delay);      \
+                                                                \
+/* destroy multi-stream spgram object                       */  \
+void SPGRAM(_multi_destroy)(SPGRAM(_multi) _q);                 \
+                                                                \
+/* resets the internal state of all streams                 */  \
+void SPGRAM(_multi_reset)(SPGRAM(_multi) _q);                   \
+                                                                \
+/* print object parameters                                  */  \
+void SPGRAM(_multi_print)(SPGRAM(_multi) _q);                   \
+                                                                \
+/* set forgetting factor of all streams                     */  \
+int SPGRAM(_multi_set_alpha)(SPGRAM(_multi) _q, float _alpha);  \
+                                                                \
+/* get number of streams                                    */  \
+unsigned int SPGRAM(_multi_get_num_streams)(SPGRAM(_multi) _q); \
+                                                                \
+/* get spgram object of a stream for per-stream settings    */  \
+/* and counters; owned by _q, not to be destroyed           */  \
+/*  _q      :   multi-stream spgram object                  */  \
+/*  _stream :   stream index, _stream < num_streams         */  \
+SPGRAM() SPGRAM(_multi_get_stream)(SPGRAM(_multi) _q,           \
+                                   unsigned int   _stream);     \
+                                                                \
+/* write a block of samples to one stream                   */  \
+/*  _q      :   multi-stream spgram object                  */  \
+/*  _stream :   stream index, _stream < num_streams         */  \
+/*  _x      :   input buffer [size: _n x 1]                 */  \
+/*  _n      :   input buffer length                         */  \
+void SPGRAM(_multi_write)(SPGRAM(_multi) _q,                    \
+                          unsigned int   _stream,               \
+                          TI *           _x,                    \
+                          unsigned int   _n);                   \
+                                                                \
+/* compute spectral periodogram output of one stream        */  \
+/* (fft-shifted values in dB)                               */  \
+/*  _q      :   multi-stream spgram object                  */  \
+/*  _stream :   stream index, _stream < num_streams         */  \
+/*  _X      :   output spectrum (dB) [size: _nfft x 1]      */  \
+void SPGRAM(_multi_get_psd)(SPGRAM(_multi) _q,                  \
+                            unsigned int   _stream,             \
+                            T *            _X);                 \
 
 LIQUID_SPGRAM_DEFINE_API(LIQUID_SPGRAM_MANGLE_CFLOAT,
                          float,
@@ -1592,6 +2548,47 @@ void firdespm_print(firdespm _q);
 // execute filter design, storing result in _h
 void firdespm_execute(firdespm _q, float * _h);
 
+// execute filter design starting from a previous extremal set (e.g.
+// from firdespm_get_extremals() on a similar design), storing result
+// in _h; converges in fewer iterations when the designs are close
+//  _q      :   firdespm object
+//  _fext   :   initial extremal frequencies (NULL for default guess)
+//              [size: (_h_len+1)/2 + 1 x 1]
+//  _h      :   output coefficients array [size: _h_len x 1]
+void firdespm_execute_warm(firdespm _q,
+                           float *  _fext,
+                           float *  _h);
+
+// get extremal frequencies from most recent execution
+//  _q      :   firdespm object
+//  _fext   :   output extremal frequencies [size: (_h_len+1)/2 + 1 x 1]
+void firdespm_get_extremals(firdespm _q,
+                            float *  _fext);
+
+
+// Filter design cache (opt-in, disabled by default). When enabled,
+// liquid_firdes_prototype(), liquid_firdes_rkaiser() and
+// firdespm_run() store their results keyed by the full set of design
+// parameters (e.g. type, k, m, beta, dt) and return stored results
+// for identical requests. Access is thread-safe where POSIX threads
+// are available.
+void liquid_firdes_cache_enable();
+void liquid_firdes_cache_disable();
+int  liquid_firdes_cache_is_enabled();
+
+// remove all entries from filter design cache
+void liquid_firdes_cache_clear();
+
+// get number of entries in filter design cache
+unsigned int liquid_firdes_cache_get_num_entries();
+
+// save filter design cache to file (text, exact values); returns 0
+// on success, -1 on failure
+int liquid_firdes_cache_save(const char * _filename);
+
+// load filter design cache entries from file, keeping entries
+// already present; returns 0 on success, -1 on failure
+int liquid_firdes_cache_load(const char * _filename);
 
 // Design FIR using kaiser window
 //  _n      : filter length, _n > 0
@@ -1929,6 +2926,25 @@ int iirdes_isstable(float * _b,
                     float * _a,
                     unsigned int _n);
 
+// compute number of coefficients for a polyphase all-pass half-band
+// filter meeting a transition bandwidth and stop-band attenuation
+//  _ft     :   transition bandwidth, centered at 0.25, 0 < _ft < 0.5
+//  _As     :   stop-band attenuation [dB], _As > 0
+unsigned int iirdes_allpass_halfband_len(float _ft,
+                                         float _As);
+
+// design polyphase all-pass half-band filter (elliptic prototype)
+//   H(z) = [ A0(z^2) + z^-1 A1(z^2) ] / 2
+// where each branch is a cascade of first-order sections in z^2,
+//   (c + z^-2) / (1 + c z^-2);
+// even-indexed coefficients belong to A0, odd-indexed to A1
+//  _n      :   number of coefficients
+//  _ft     :   transition bandwidth, centered at 0.25, 0 < _ft < 0.5
+//  _c      :   output all-pass coefficients [size: _n x 1]
+void iirdes_allpass_halfband(unsigned int _n,
+                             float        _ft,
+                             float *      _c);
+
 //
 // linear prediction
 //
@@ -1990,6 +3006,13 @@ void AUTOCORR(_reset)(AUTOCORR() _q);                           \
 /* print auto-correlator parameters to stdout               */  \
 void AUTOCORR(_print)(AUTOCORR() _q);                           \
                                                                 \
+/* set/get recursive mode: output is kept as a running sum  */  \
+/* of lag products, O(1) per sample, re-computed exactly    */  \
+/* once per window to bound drift (default: disabled)       */  \
+void AUTOCORR(_set_recursive)(AUTOCORR() _q,                    \
+                              int        _recursive);           \
+int  AUTOCORR(_get_recursive)(AUTOCORR() _q);                   \
+                                                                \
 /* push sample into auto-correlator object                  */  \
 void AUTOCORR(_push)(AUTOCORR() _q,                             \
                      TI         _x);                            \
@@ -2074,6 +3097,29 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT()    _q,                   \
                              TC *         _h,                   \
                              unsigned int _n);                  \
                                                                 \
+/* set filter coefficients in place without allocation,    */  \
+/* retaining the internal buffer                            */  \
+/*  _q      : filter object                                 */  \
+/*  _h      : coefficients [size: _n x 1], _n = length      */  \
+void FIRFILT(_set_coefficients)(FIRFILT() _q,                   \
+                                TC *      _h);                  \
+                                                                \
+/* get filter coefficients                                  */  \
+/*  _q      : filter object                                 */  \
+/*  _h      : coefficients [size: _n x 1], _n = length      */  \
+void FIRFILT(_get_coefficients)(FIRFILT() _q,                   \
+                                TC *      _h);                  \
+                                                                \
+/* adapt coefficients with least mean-squares update using  */  \
+/* the internal buffer: h <- h + mu*e*conj(x), with the     */  \
+/* real part taken for real coefficients                    */  \
+/*  _q      : filter object                                 */  \
+/*  _mu     : step size                                     */  \
+/*  _e      : error, desired minus actual last output       */  \
+void FIRFILT(_adapt)(FIRFILT() _q,                              \
+                     float     _mu,                             \
+                     TO        _e);                             \
+                                                                \
 /* destroy filter object and free all internal memory       */  \
 void FIRFILT(_destroy)(FIRFILT() _q);                           \
                                                                 \
@@ -2110,9 +3156,31 @@ void FIRFILT(_execute_block)(FIRFILT()    _q,                   \
                              unsigned int _n,                   \
                              TO *         _y);                  \
                                                                 \
+/* prime the internal buffer with a block of input samples  */  \
+/* without computing outputs, e.g. the first get_delay()    */  \
+/* samples of a signal so later outputs align with inputs   */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : pointer to input array [size: _n x 1]         */  \
+/*  _n      : number of input samples                       */  \
+void FIRFILT(_prime)(FIRFILT()    _q,                           \
+                     TI *         _x,                           \
+                     unsigned int _n);                          \
+                                                                \
+/* flush the internal buffer with zero-valued inputs,       */  \
+/* computing the final outputs of a primed signal           */  \
+/*  _q      : filter object                                 */  \
+/*  _n      : number of output samples                      */  \
+/*  _y      : pointer to output array [size: _n x 1]        */  \
+void FIRFILT(_flush)(FIRFILT()    _q,                           \
+                     unsigned int _n,                           \
+                     TO *         _y);                          \
+                                                                \
 /* return length of filter object                           */  \
 unsigned int FIRFILT(_get_length)(FIRFILT() _q);                \
                                                                 \
+/* return nominal filter delay (samples)                    */  \
+float FIRFILT(_get_delay)(FIRFILT() _q);                        \
+                                                                \
 /* compute complex frequency response of filter object      */  \
 /*  _q      : filter object                                 */  \
 /*  _fc     : frequency to evaluate                         */  \
@@ -2142,6 +3210,95 @@ LIQUID_FIRFILT_DEFINE_API(FIRFILT_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+// execute the filter on a block of 16-bit integer input samples,
+// widening each (x*scale) directly into the filter's buffer
+//  _q      : filter object
+//  _x      : input array [size: _n x 1], interleaved I/Q pairs
+//            for complex inputs [size: 2*_n x 1]
+//  _n      : number of input, output samples
+//  _scale  : input scaling factor (e.g. 1/32768)
+//  _y      : output array [size: _n x 1]
+void firfilt_rrrf_execute_block_s16(firfilt_rrrf    _q,
+                                    const int16_t * _x,
+                                    unsigned int    _n,
+                                    float           _scale,
+                                    float *         _y);
+void firfilt_crcf_execute_block_ci16(firfilt_crcf           _q,
+                                     const int16_t *        _x,
+                                     unsigned int           _n,
+                                     float                  _scale,
+                                     liquid_float_complex * _y);
+void firfilt_cccf_execute_block_ci16(firfilt_cccf           _q,
+                                     const int16_t *        _x,
+                                     unsigned int           _n,
+                                     float                  _scale,
+                                     liquid_float_complex * _y);
+
+#define FIRFILT_MANGLE_RRRQ16(name) LIQUID_CONCAT(firfilt_rrrq16,name)
+#define FIRFILT_MANGLE_CRCQ16(name) LIQUID_CONCAT(firfilt_crcq16,name)
+
+// Macro: fixed-point (Q15) finite impulse response filter
+//   FIRFILT    : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_FIRFILTQ16_DEFINE_API(FIRFILT,TO,TC,TI)          \
+typedef struct FIRFILT(_s) * FIRFILT();                         \
+                                                                \
+/* create filter from Q15 coefficients                      */  \
+/*  _h      : filter coefficients [size: _n x 1]            */  \
+/*  _n      : filter length, _n > 0                         */  \
+FIRFILT() FIRFILT(_create)(TC * _h, unsigned int _n);           \
+                                                                \
+/* re-create filter                                         */  \
+/*  _q      : original filter object                        */  \
+/*  _h      : pointer to filter coefficients [size: _n x 1] */  \
+/*  _n      : filter length, _n > 0                         */  \
+FIRFILT() FIRFILT(_recreate)(FIRFILT()    _q,                   \
+                             TC *         _h,                   \
+                             unsigned int _n);                  \
+                                                                \
+/* destroy filter object and free all internal memory       */  \
+void FIRFILT(_destroy)(FIRFILT() _q);                           \
+                                                                \
+/* reset filter object's internal buffer                    */  \
+void FIRFILT(_reset)(FIRFILT() _q);                             \
+                                                                \
+/* print filter object information                          */  \
+void FIRFILT(_print)(FIRFILT() _q);                             \
+                                                                \
+/* push sample into filter object's internal buffer         */  \
+void FIRFILT(_push)(FIRFILT() _q,                               \
+                    TI        _x);                              \
+                                                                \
+/* execute the filter on internal buffer and coefficients   */  \
+void FIRFILT(_execute)(FIRFILT() _q,                            \
+                       TO *      _y);                           \
+                                                                \
+/* execute the filter on a block of input samples; the      */  \
+/* input and output buffers may be the same                 */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : pointer to input array [size: _n x 1]         */  \
+/*  _n      : number of input, output samples               */  \
+/*  _y      : pointer to output array [size: _n x 1]        */  \
+void FIRFILT(_execute_block)(FIRFILT()    _q,                   \
+                             TI *         _x,                   \
+                             unsigned int _n,                   \
+                             TO *         _y);                  \
+                                                                \
+/* return length of filter object                           */  \
+unsigned int FIRFILT(_get_length)(FIRFILT() _q);                \
+
+LIQUID_FIRFILTQ16_DEFINE_API(FIRFILT_MANGLE_RRRQ16,
+                             q16_t,
+                             q16_t,
+                             q16_t)
+
+LIQUID_FIRFILTQ16_DEFINE_API(FIRFILT_MANGLE_CRCQ16,
+                             cq16_t,
+                             q16_t,
+                             cq16_t)
+
 //
 // FIR Hilbert transform
 //  2:1 real-to-complex decimator
@@ -2172,6 +3329,9 @@ void FIRHILB(_print)(FIRHILB() _q);                             \
 /* reset firhilb object internal state                      */  \
 void FIRHILB(_reset)(FIRHILB() _q);                             \
                                                                 \
+/* get real-to-complex delay (samples)                      */  \
+unsigned int FIRHILB(_get_delay)(FIRHILB() _q);                 \
+                                                                \
 /* execute Hilbert transform (real to complex)              */  \
 /*  _q      :   Hilbert transform object                    */  \
 /*  _x      :   real-valued input sample                    */  \
@@ -2188,6 +3348,28 @@ void FIRHILB(_c2r_execute)(FIRHILB() _q,                        \
                            TC        _x,                        \
                            T *       _y);                       \
                                                                 \
+/* execute Hilbert transform (real to complex) on a block   */  \
+/* of samples, equivalent to _n calls to _r2c_execute()     */  \
+/*  _q      :   Hilbert transform object                    */  \
+/*  _x      :   real-valued input array [size: _n x 1]      */  \
+/*  _n      :   number of input, output samples             */  \
+/*  _y      :   complex-valued output array [size: _n x 1]  */  \
+void FIRHILB(_r2c_execute_block)(FIRHILB()    _q,               \
+                                 T *          _x,               \
+                                 unsigned int _n,               \
+                                 TC *         _y);              \
+                                                                \
+/* execute Hilbert transform (complex to real) on a block   */  \
+/* of samples                                               */  \
+/*  _q      :   Hilbert transform object                    */  \
+/*  _x      :   complex-valued input array [size: _n x 1]   */  \
+/*  _n      :   number of input, output samples             */  \
+/*  _y      :   real-valued output array [size: _n x 1]     */  \
+void FIRHILB(_c2r_execute_block)(FIRHILB()    _q,               \
+                                 TC *         _x,               \
+                                 unsigned int _n,               \
+                                 T *          _y);              \
+                                                                \
 /* execute Hilbert transform decimator (real to complex)    */  \
 /*  _q      :   Hilbert transform object                    */  \
 /*  _x      :   real-valued input array [size: 2 x 1]       */  \
@@ -2254,8 +3436,31 @@ FFTFILT() FFTFILT(_create)(TC *         _h,                     \
                            unsigned int _h_len,                 \
                            unsigned int _n);                    \
                                                                 \
-/* destroy filter object and free all internal memory       */  \
-void FFTFILT(_destroy)(FFTFILT() _q);                           \
+/* create FFT-based FIR filter with explicit transform size */  \
+/* to trade block latency against throughput (see also      */  \
+/* liquid_fftfilt_select())                                 */  \
+/*  _h      : filter coefficients [size: _h_len x 1]        */  \
+/*  _h_len  : filter length, _h_len > 0                     */  \
+/*  _n      : block size, _n > 0                            */  \
+/*  _nfft   : transform size, at least _n+_h_len-1          */  \
+FFTFILT() FFTFILT(_create_nfft)(TC *         _h,                \
+                                unsigned int _h_len,            \
+                                unsigned int _n,                \
+                                unsigned int _nfft);            \
+                                                                \
+/* create FFT-based FIR filter using uniformly partitioned  */  \
+/* overlap-save: taps are split into partitions of _n that  */  \
+/* share one frequency-domain delay line, giving a latency  */  \
+/* of one block of _n samples for any filter length         */  \
+/*  _h      : filter coefficients [size: _h_len x 1]        */  \
+/*  _h_len  : filter length, _h_len > 0                     */  \
+/*  _n      : block size and partition length, _n > 0       */  \
+FFTFILT() FFTFILT(_create_partitioned)(TC *         _h,         \
+                                       unsigned int _h_len,     \
+                                       unsigned int _n);        \
+                                                                \
+/* destroy filter object and free all internal memory       */  \
+void FFTFILT(_destroy)(FFTFILT() _q);                           \
                                                                 \
 /* reset filter object's internal buffer                    */  \
 void FFTFILT(_reset)(FFTFILT() _q);                             \
@@ -2277,6 +3482,13 @@ void FFTFILT(_execute)(FFTFILT() _q,                            \
                                                                 \
 /* return length of filter object's internal coefficients   */  \
 unsigned int FFTFILT(_get_length)(FFTFILT() _q);                \
+                                                                \
+/* return block size and transform size                     */  \
+unsigned int FFTFILT(_get_block_len)(FFTFILT() _q);             \
+unsigned int FFTFILT(_get_nfft)(FFTFILT() _q);                  \
+                                                                \
+/* return number of coefficient partitions                  */  \
+unsigned int FFTFILT(_get_num_partitions)(FFTFILT() _q);        \
 
 LIQUID_FFTFILT_DEFINE_API(FFTFILT_MANGLE_RRRF,
                           float,
@@ -2293,6 +3505,18 @@ LIQUID_FFTFILT_DEFINE_API(FFTFILT_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+// Select between direct-form (firfilt) and FFT-based (fftfilt)
+// filtering for a filter of _h_len taps whose block latency may not
+// exceed _max_block_len samples. Returns 0 when firfilt is expected
+// to be faster; otherwise returns the fftfilt block size and sets
+// *_nfft to the transform size to pass to fftfilt_xxxt_create_nfft().
+//  _h_len          : filter length, _h_len > 0
+//  _max_block_len  : maximum block size (latency budget)
+//  _nfft           : transform size output (power of two)
+unsigned int liquid_fftfilt_select(unsigned int   _h_len,
+                                   unsigned int   _max_block_len,
+                                   unsigned int * _nfft);
+
 
 //
 // Infinite impulse response filter
@@ -2430,6 +3654,96 @@ LIQUID_IIRFILT_DEFINE_API(IIRFILT_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+//
+// Multi-channel infinite impulse response filter (second-order
+// sections with real coefficients shared by all channels)
+//
+#define IIRFILTMC_MANGLE_RRRF(name)  LIQUID_CONCAT(iirfiltmc_rrrf,name)
+#define IIRFILTMC_MANGLE_CRCF(name)  LIQUID_CONCAT(iirfiltmc_crcf,name)
+
+// Macro:
+//   IIRFILTMC  : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type (real)
+//   TI         : input data type
+#define LIQUID_IIRFILTMC_DEFINE_API(IIRFILTMC,TO,TC,TI)         \
+                                                                \
+typedef struct IIRFILTMC(_s) * IIRFILTMC();                     \
+                                                                \
+/* create multi-channel IIR filter using 2nd-order sections */  \
+/*  _B      : feed-forward coefficients [size: _nsos x 3]   */  \
+/*  _A      : feed-back coefficients    [size: _nsos x 3]   */  \
+/*  _nsos   : number of second-order sections               */  \
+/*  _num_channels : number of independent channels          */  \
+IIRFILTMC() IIRFILTMC(_create_sos)(TC *         _B,             \
+                                   TC *         _A,             \
+                                   unsigned int _nsos,          \
+                                   unsigned int _num_channels); \
+                                                                \
+/* create multi-channel IIR filter from design template     */  \
+/*  _ftype  : filter type (e.g. LIQUID_IIRDES_BUTTER)       */  \
+/*  _btype  : band type (e.g. LIQUID_IIRDES_BANDPASS)       */  \
+/*  _order  : filter order                                  */  \
+/*  _fc     : low-pass prototype cut-off frequency          */  \
+/*  _f0     : center frequency (band-pass, band-stop)       */  \
+/*  _Ap     : pass-band ripple in dB                        */  \
+/*  _As     : stop-band ripple in dB                        */  \
+/*  _num_channels : number of independent channels          */  \
+IIRFILTMC() IIRFILTMC(_create_prototype)(                       \
+            liquid_iirdes_filtertype _ftype,                    \
+            liquid_iirdes_bandtype   _btype,                    \
+            unsigned int             _order,                    \
+            float                    _fc,                       \
+            float                    _f0,                       \
+            float                    _Ap,                       \
+            float                    _As,                       \
+            unsigned int             _num_channels);            \
+                                                                \
+/* create multi-channel DC-blocking filter                  */  \
+IIRFILTMC() IIRFILTMC(_create_dc_blocker)(float        _alpha,  \
+                                          unsigned int _num_channels); \
+                                                                \
+/* destroy object, freeing all internal memory              */  \
+void IIRFILTMC(_destroy)(IIRFILTMC() _q);                       \
+                                                                \
+/* print object properties to stdout                        */  \
+void IIRFILTMC(_print)(IIRFILTMC() _q);                         \
+                                                                \
+/* clear/reset object internals                             */  \
+void IIRFILTMC(_reset)(IIRFILTMC() _q);                         \
+                                                                \
+/* get number of channels                                   */  \
+unsigned int IIRFILTMC(_get_num_channels)(IIRFILTMC() _q);      \
+                                                                \
+/* compute filter output for one sample on every channel    */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input samples [size: num_channels x 1]        */  \
+/*  _y      : output samples [size: num_channels x 1]       */  \
+void IIRFILTMC(_execute)(IIRFILTMC() _q,                        \
+                         TI *        _x,                        \
+                         TO *        _y);                       \
+                                                                \
+/* execute the filter on a block of channel-interleaved     */  \
+/* samples; the input and output buffers may be the same    */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input array [size: _n x num_channels]         */  \
+/*  _n      : number of samples per channel                 */  \
+/*  _y      : output array [size: _n x num_channels]        */  \
+void IIRFILTMC(_execute_block)(IIRFILTMC()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
+
+LIQUID_IIRFILTMC_DEFINE_API(IIRFILTMC_MANGLE_RRRF,
+                            float,
+                            float,
+                            float)
+
+LIQUID_IIRFILTMC_DEFINE_API(IIRFILTMC_MANGLE_CRCF,
+                            liquid_float_complex,
+                            float,
+                            liquid_float_complex)
+
 
 //
 // FIR Polyphase filter bank
@@ -2499,16 +3813,42 @@ FIRPFB() FIRPFB(_recreate)(FIRPFB()     _q,                     \
                            TC *         _h,                     \
                            unsigned int _h_len);                \
                                                                 \
+/* create filterbank sharing the read-only coefficients of  */  \
+/* an existing filterbank; objects sharing coefficients may */  \
+/* execute concurrently but must be created/destroyed       */  \
+/* serially                                                 */  \
+/*  _proto  : prototype filterbank                          */  \
+FIRPFB() FIRPFB(_create_shared)(FIRPFB() _proto);               \
+                                                                \
 /* destroy firpfb object, freeing all internal memory       */  \
 void FIRPFB(_destroy)(FIRPFB() _q);                             \
                                                                 \
 /* print firpfb object's parameters                         */  \
 void FIRPFB(_print)(FIRPFB() _q);                               \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int FIRPFB(_get_memory_usage)(FIRPFB() _q);       \
+                                                                \
 /* set output scaling for filter                            */  \
 void FIRPFB(_set_scale)(FIRPFB() _q,                            \
                         TC       _g);                           \
                                                                 \
+/* enable/disable half-precision (binary16) coefficient     */  \
+/* storage, halving the cache footprint of large banks;     */  \
+/* inputs and accumulation remain single precision          */  \
+/*  _q      : firpfb object                                 */  \
+/*  _enable : non-zero to run from half-precision copy      */  \
+void FIRPFB(_set_coeff_fp16)(FIRPFB() _q,                       \
+                             int      _enable);                 \
+                                                                \
+/* get half-precision coefficient storage flag              */  \
+int FIRPFB(_get_coeff_fp16)(FIRPFB() _q);                       \
+                                                                \
+/* get relative error of half-precision coefficients of     */  \
+/* filter _i, 10 log10(sum|h-h16|^2 / sum|h|^2) [dB]        */  \
+float FIRPFB(_get_coeff_fp16_error)(FIRPFB()     _q,            \
+                                    unsigned int _i);           \
+                                                                \
 /* clear/reset firpfb object internal state                 */  \
 void FIRPFB(_reset)(FIRPFB() _q);                               \
                                                                 \
@@ -2522,6 +3862,23 @@ void FIRPFB(_push)(FIRPFB() _q, TI _x);                         \
 void FIRPFB(_execute)(FIRPFB()     _q,                          \
                       unsigned int _i,                          \
                       TO *         _y);                         \
+                                                                \
+/* execute all filters in the bank on internal buffer       */  \
+/*  _q      : firpfb object                                 */  \
+/*  _y      : output samples, one per filter [size: M x 1]  */  \
+void FIRPFB(_execute_batch)(FIRPFB() _q,                        \
+                            TO *     _y);                       \
+                                                                \
+/* push block of samples into filterbank, executing all     */  \
+/* filters after each sample                                */  \
+/*  _q      : firpfb object                                 */  \
+/*  _x      : input samples [size: _n x 1]                  */  \
+/*  _n      : number of input samples                       */  \
+/*  _y      : output samples [size: _n*M x 1]               */  \
+void FIRPFB(_execute_block)(FIRPFB()     _q,                    \
+                            TI *         _x,                    \
+                            unsigned int _n,                    \
+                            TO *         _y);                   \
 
 LIQUID_FIRPFB_DEFINE_API(FIRPFB_MANGLE_RRRF,
                          float,
@@ -2588,6 +3945,16 @@ void FIRINTERP(_print)(FIRINTERP() _q);                         \
 /* reset internal state                                     */  \
 void FIRINTERP(_reset)(FIRINTERP() _q);                         \
                                                                 \
+/* get interpolator delay (output samples)                  */  \
+float FIRINTERP(_get_delay)(FIRINTERP() _q);                    \
+                                                                \
+/* push input sample into internal buffer without computing */  \
+/* output, e.g. to restore a known state                    */  \
+/*  _q      : firinterp object                              */  \
+/*  _x      : input sample                                  */  \
+void FIRINTERP(_push)(FIRINTERP() _q,                           \
+                      TI          _x);                          \
+                                                                \
 /* execute interpolation on single input sample             */  \
 /*  _q      : firinterp object                              */  \
 /*  _x      : input sample                                  */  \
@@ -2621,6 +3988,62 @@ LIQUID_FIRINTERP_DEFINE_API(FIRINTERP_MANGLE_CCCF,
                             liquid_float_complex,
                             liquid_float_complex)
 
+#define FIRINTERP_MANGLE_RRRQ16(name) LIQUID_CONCAT(firinterp_rrrq16,name)
+#define FIRINTERP_MANGLE_CRCQ16(name) LIQUID_CONCAT(firinterp_crcq16,name)
+
+// Macro: fixed-point (Q15) interpolator
+//   FIRINTERP  : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_FIRINTERPQ16_DEFINE_API(FIRINTERP,TO,TC,TI)      \
+typedef struct FIRINTERP(_s) * FIRINTERP();                     \
+                                                                \
+/* create interpolator from Q15 prototype                   */  \
+/*  _M      : interpolation factor, _M >= 2                 */  \
+/*  _h      : filter coefficients [size: _h_len x 1]        */  \
+/*  _h_len  : filter length, _h_len >= _M                   */  \
+FIRINTERP() FIRINTERP(_create)(unsigned int _M,                 \
+                               TC *         _h,                 \
+                               unsigned int _h_len);            \
+                                                                \
+/* destroy interpolator object and free internal memory     */  \
+void FIRINTERP(_destroy)(FIRINTERP() _q);                       \
+                                                                \
+/* print interpolator object internals                      */  \
+void FIRINTERP(_print)(FIRINTERP() _q);                         \
+                                                                \
+/* reset internal state                                     */  \
+void FIRINTERP(_reset)(FIRINTERP() _q);                         \
+                                                                \
+/* execute interpolation on single input sample             */  \
+/*  _q      : firinterp object                              */  \
+/*  _x      : input sample                                  */  \
+/*  _y      : output sample array [size: _M x 1]            */  \
+void FIRINTERP(_execute)(FIRINTERP() _q,                        \
+                         TI          _x,                        \
+                         TO *        _y);                       \
+                                                                \
+/* execute interpolation on block of input samples          */  \
+/*  _q      : firinterp object                              */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _n      : size of input array                           */  \
+/*  _y      : output sample array [size: _M*_n x 1]         */  \
+void FIRINTERP(_execute_block)(FIRINTERP()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
+
+LIQUID_FIRINTERPQ16_DEFINE_API(FIRINTERP_MANGLE_RRRQ16,
+                               q16_t,
+                               q16_t,
+                               q16_t)
+
+LIQUID_FIRINTERPQ16_DEFINE_API(FIRINTERP_MANGLE_CRCQ16,
+                               cq16_t,
+                               q16_t,
+                               cq16_t)
+
 // iirinterp : infinite impulse response interpolator
 #define IIRINTERP_MANGLE_RRRF(name)  LIQUID_CONCAT(iirinterp_rrrf,name)
 #define IIRINTERP_MANGLE_CRCF(name)  LIQUID_CONCAT(iirinterp_crcf,name)
@@ -2661,6 +4084,14 @@ IIRINTERP() IIRINTERP(_create_prototype)(                       \
                 float _Ap,                                      \
                 float _As);                                     \
                                                                 \
+/* create half-band interpolator (M = 2) from polyphase     */  \
+/* all-pass branches running at the input rate; unlike the  */  \
+/* zero-stuffing forms the pass-band gain is unity          */  \
+/*  _ft     : transition bandwidth, centered at 0.25        */  \
+/*  _As     : stop-band attenuation [dB]                    */  \
+IIRINTERP() IIRINTERP(_create_halfband)(float _ft,              \
+                                        float _As);             \
+                                                                \
 /* destroy interpolator object and free internal memory     */  \
 void IIRINTERP(_destroy)(IIRINTERP() _q);                       \
                                                                 \
@@ -2755,6 +4186,10 @@ void FIRDECIM(_print)(FIRDECIM() _q);                           \
 /* reset decimator object internal state                    */  \
 void FIRDECIM(_clear)(FIRDECIM() _q);                           \
                                                                 \
+/* get decimator delay (output samples), relative to the    */  \
+/* first input sample of each block                         */  \
+float FIRDECIM(_get_delay)(FIRDECIM() _q);                      \
+                                                                \
 /* execute decimator on _M input samples                    */  \
 /*  _q      : decimator object                              */  \
 /*  _x      : input samples [size: _M x 1]                  */  \
@@ -2837,6 +4272,13 @@ IIRDECIM() IIRDECIM(_create_prototype)(                         \
                 float                    _Ap,                   \
                 float                    _As);                  \
                                                                 \
+/* create half-band decimator (M = 2) from polyphase        */  \
+/* all-pass branches running at the output rate             */  \
+/*  _ft     : transition bandwidth, centered at 0.25        */  \
+/*  _As     : stop-band attenuation [dB]                    */  \
+IIRDECIM() IIRDECIM(_create_halfband)(float _ft,                \
+                                      float _As);               \
+                                                                \
 /* destroy decimator object and free internal memory        */  \
 void IIRDECIM(_destroy)(IIRDECIM() _q);                         \
                                                                 \
@@ -2965,6 +4407,28 @@ void RESAMP2(_decim_execute)(RESAMP2() _q,                      \
 void RESAMP2(_interp_execute)(RESAMP2() _q,                     \
                               TI        _x,                     \
                               TO *      _y);                    \
+                                                                \
+/* execute resamp2 as half-band decimator on a block of     */  \
+/* samples                                                  */  \
+/*  _q      :   resamp2 object                              */  \
+/*  _x      :   input array  [size: 2*_n x 1]               */  \
+/*  _n      :   number of output samples                    */  \
+/*  _y      :   output array [size: _n x 1]                 */  \
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,             \
+                                   TI *         _x,             \
+                                   unsigned int _n,             \
+                                   TO *         _y);            \
+                                                                \
+/* execute resamp2 as half-band interpolator on a block of  */  \
+/* samples                                                  */  \
+/*  _q      :   resamp2 object                              */  \
+/*  _x      :   input array  [size: _n x 1]                 */  \
+/*  _n      :   number of input samples                     */  \
+/*  _y      :   output array [size: 2*_n x 1]               */  \
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,            \
+                                    TI *         _x,            \
+                                    unsigned int _n,            \
+                                    TO *         _y);           \
 
 LIQUID_RESAMP2_DEFINE_API(RESAMP2_MANGLE_RRRF,
                           float,
@@ -3021,6 +4485,11 @@ void RESAMP(_print)(RESAMP() _q);                               \
 /* reset resamp object internals                            */  \
 void RESAMP(_reset)(RESAMP() _q);                               \
                                                                 \
+/* enable/disable half-precision storage of the resampler's */  \
+/* filterbank coefficients (see firpfb_xxxt_set_coeff_fp16) */  \
+void RESAMP(_set_coeff_fp16)(RESAMP() _q,                       \
+                             int      _enable);                 \
+                                                                \
 /* get resampler delay (output samples)                     */  \
 unsigned int RESAMP(_get_delay)(RESAMP() _q);                   \
                                                                 \
@@ -3067,6 +4536,253 @@ LIQUID_RESAMP_DEFINE_API(RESAMP_MANGLE_CCCF,
                          liquid_float_complex,
                          liquid_float_complex)
 
+#define RESAMP_MANGLE_RRRQ16(name)  LIQUID_CONCAT(resamp_rrrq16,name)
+#define RESAMP_MANGLE_CRCQ16(name)  LIQUID_CONCAT(resamp_crcq16,name)
+
+// Macro: fixed-point (Q15) arbitrary resampler; output timing is kept
+// by an integer phase accumulator and outputs interpolate linearly
+// between adjacent Q15 polyphase sub-filters, so execution uses no
+// floating-point arithmetic
+//   RESAMP     : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_RESAMPQ16_DEFINE_API(RESAMP,TO,TC,TI)            \
+typedef struct RESAMP(_s) * RESAMP();                           \
+                                                                \
+/* create arbitrary resampler object                        */  \
+/*  _rate   : resampling rate, 1/128 <= _rate <= 65536      */  \
+/*  _m      : filter semi-length (delay)                    */  \
+/*  _fc     : filter cutoff frequency, 0 < _fc < 0.5        */  \
+/*  _As     : filter stop-band attenuation [dB]             */  \
+/*  _npfb   : number of filters in the bank, rounded up to  */  \
+/*            a power of two, 0 < _npfb <= 512              */  \
+RESAMP() RESAMP(_create)(float        _rate,                    \
+                         unsigned int _m,                       \
+                         float        _fc,                      \
+                         float        _As,                      \
+                         unsigned int _npfb);                   \
+                                                                \
+/* create arbitrary resampler object with default           */  \
+/* parameters: m = 7, fc = 0.25, As = 60 dB, npfb = 64      */  \
+RESAMP() RESAMP(_create_default)(float _rate);                  \
+                                                                \
+/* destroy arbitrary resampler object                       */  \
+void RESAMP(_destroy)(RESAMP() _q);                             \
+                                                                \
+/* print resamp object internals to stdout                  */  \
+void RESAMP(_print)(RESAMP() _q);                               \
+                                                                \
+/* reset resamp object internals                            */  \
+void RESAMP(_reset)(RESAMP() _q);                               \
+                                                                \
+/* get resampler delay (output samples)                     */  \
+unsigned int RESAMP(_get_delay)(RESAMP() _q);                   \
+                                                                \
+/* get/set rate of arbitrary resampler; the phase step is   */  \
+/* rounded to 2^-24 input samples                           */  \
+float RESAMP(_get_rate)(RESAMP() _q);                           \
+void RESAMP(_set_rate)(RESAMP() _q, float _rate);               \
+                                                                \
+/* adjust rate of arbitrary resampler by _delta in          */  \
+/* [-0.1,0.1]                                               */  \
+void RESAMP(_adjust_rate)(RESAMP() _q, float _delta);           \
+                                                                \
+/* execute arbitrary resampler                              */  \
+/*  _q              :   resamp object                       */  \
+/*  _x              :   single input sample                 */  \
+/*  _y              :   output sample array (pointer)       */  \
+/*  _num_written    :   number of samples written to _y     */  \
+void RESAMP(_execute)(RESAMP()       _q,                        \
+                      TI             _x,                        \
+                      TO *           _y,                        \
+                      unsigned int * _num_written);             \
+                                                                \
+/* execute arbitrary resampler on a block of samples        */  \
+/*  _q              :   resamp object                       */  \
+/*  _x              :   input buffer [size: _nx x 1]        */  \
+/*  _nx             :   input buffer                        */  \
+/*  _y              :   output sample array (pointer)       */  \
+/*  _ny             :   number of samples written to _y     */  \
+void RESAMP(_execute_block)(RESAMP()       _q,                  \
+                            TI *           _x,                  \
+                            unsigned int   _nx,                 \
+                            TO *           _y,                  \
+                            unsigned int * _ny);                \
+
+LIQUID_RESAMPQ16_DEFINE_API(RESAMP_MANGLE_RRRQ16,
+                            q16_t,
+                            q16_t,
+                            q16_t)
+
+LIQUID_RESAMPQ16_DEFINE_API(RESAMP_MANGLE_CRCQ16,
+                            cq16_t,
+                            q16_t,
+                            cq16_t)
+
+//
+// Arbitrary-rate resampler on a Farrow-structure filter
+//
+#define RESAMPFARROW_MANGLE_RRRF(name)  LIQUID_CONCAT(resamp_farrow_rrrf,name)
+#define RESAMPFARROW_MANGLE_CRCF(name)  LIQUID_CONCAT(resamp_farrow_crcf,name)
+
+#define LIQUID_RESAMPFARROW_DEFINE_API(RESAMPFARROW,TO,TC,TI)   \
+typedef struct RESAMPFARROW(_s) * RESAMPFARROW();               \
+                                                                \
+/* create Farrow resampler object; the filter taps are      */  \
+/* polynomials in the fractional delay so that the rate may */  \
+/* be changed at any time without redesigning the filter    */  \
+/*  _rate   : resampling rate (output/input), _rate > 0     */  \
+/*  _m      : filter semi-length (delay) [input samples]    */  \
+/*  _fc     : filter cutoff frequency, 0 < _fc < 0.5        */  \
+/*  _As     : filter stop-band attenuation [dB]             */  \
+/*  _order  : polynomial order, _order > 0                  */  \
+RESAMPFARROW() RESAMPFARROW(_create)(float        _rate,        \
+                                     unsigned int _m,           \
+                                     float        _fc,          \
+                                     float        _As,          \
+                                     unsigned int _order);      \
+                                                                \
+/* create Farrow resampler object with a specified rate and */  \
+/* default parameters: m = 8, fc = 0.4, As = 60 dB, order 4 */  \
+RESAMPFARROW() RESAMPFARROW(_create_default)(float _rate);      \
+                                                                \
+/* destroy Farrow resampler object                          */  \
+void RESAMPFARROW(_destroy)(RESAMPFARROW() _q);                 \
+                                                                \
+/* print Farrow resampler object internals to stdout        */  \
+void RESAMPFARROW(_print)(RESAMPFARROW() _q);                   \
+                                                                \
+/* reset Farrow resampler object internals                  */  \
+void RESAMPFARROW(_reset)(RESAMPFARROW() _q);                   \
+                                                                \
+/* get resampler delay [input samples]                      */  \
+unsigned int RESAMPFARROW(_get_delay)(RESAMPFARROW() _q);       \
+                                                                \
+/* get resampling rate                                      */  \
+float RESAMPFARROW(_get_rate)(RESAMPFARROW() _q);               \
+                                                                \
+/* set resampling rate; O(1), takes effect on next output   */  \
+void RESAMPFARROW(_set_rate)(RESAMPFARROW() _q, float _rate);   \
+                                                                \
+/* adjust resampling rate by _delta in [-0.1,0.1]           */  \
+void RESAMPFARROW(_adjust_rate)(RESAMPFARROW() _q,              \
+                                float          _delta);         \
+                                                                \
+/* execute Farrow resampler on a single input sample        */  \
+/*  _q              :   resampler object                    */  \
+/*  _x              :   single input sample                 */  \
+/*  _y              :   output array [size: ceil(rate) x 1] */  \
+/*  _num_written    :   number of samples written to _y     */  \
+void RESAMPFARROW(_execute)(RESAMPFARROW() _q,                  \
+                            TI             _x,                  \
+                            TO *           _y,                  \
+                            unsigned int * _num_written);       \
+                                                                \
+/* execute Farrow resampler on a block of samples           */  \
+/*  _q      :   resampler object                            */  \
+/*  _x      :   input array [size: _nx x 1]                 */  \
+/*  _nx     :   number of input samples                     */  \
+/*  _y      :   output array [size: ceil(_nx*rate) x 1]     */  \
+/*  _ny     :   number of samples written to _y             */  \
+void RESAMPFARROW(_execute_block)(RESAMPFARROW() _q,            \
+                                  TI *           _x,            \
+                                  unsigned int   _nx,           \
+                                  TO *           _y,            \
+                                  unsigned int * _ny);          \
+
+LIQUID_RESAMPFARROW_DEFINE_API(RESAMPFARROW_MANGLE_RRRF,
+                               float,
+                               float,
+                               float)
+
+LIQUID_RESAMPFARROW_DEFINE_API(RESAMPFARROW_MANGLE_CRCF,
+                               liquid_float_complex,
+                               float,
+                               liquid_float_complex)
+
+
+
+//
+// Rational-rate resampler
+//
+#define RRESAMP_MANGLE_RRRF(name)   LIQUID_CONCAT(rresamp_rrrf,name)
+#define RRESAMP_MANGLE_CRCF(name)   LIQUID_CONCAT(rresamp_crcf,name)
+#define RRESAMP_MANGLE_CCCF(name)   LIQUID_CONCAT(rresamp_cccf,name)
+
+#define LIQUID_RRESAMP_DEFINE_API(RRESAMP,TO,TC,TI)             \
+typedef struct RRESAMP(_s) * RRESAMP();                         \
+                                                                \
+/* create rational-rate resampler object with rate _P/_Q;   */  \
+/* each frame of _Q input samples yields _P output samples  */  \
+/*  _P      : interpolation factor, _P > 0                  */  \
+/*  _Q      : decimation factor, _Q > 0                     */  \
+/*  _m      : filter semi-length (delay) [input samples]    */  \
+/*  _bw     : filter bandwidth relative to the lower of the */  \
+/*            input and output rates, 0 < _bw < 0.5         */  \
+/*  _As     : filter stop-band attenuation [dB]             */  \
+RRESAMP() RRESAMP(_create)(unsigned int _P,                     \
+                           unsigned int _Q,                     \
+                           unsigned int _m,                     \
+                           float        _bw,                    \
+                           float        _As);                   \
+                                                                \
+/* create rational-rate resampler object with default       */  \
+/* parameters: m = 12, bw = 0.45, As = 60 dB                */  \
+RRESAMP() RRESAMP(_create_default)(unsigned int _P,             \
+                                   unsigned int _Q);            \
+                                                                \
+/* destroy rational-rate resampler object                   */  \
+void RRESAMP(_destroy)(RRESAMP() _q);                           \
+                                                                \
+/* print rresamp object internals to stdout                 */  \
+void RRESAMP(_print)(RRESAMP() _q);                             \
+                                                                \
+/* reset rresamp object internals                           */  \
+void RRESAMP(_reset)(RRESAMP() _q);                             \
+                                                                \
+/* get resampler delay (input samples)                      */  \
+unsigned int RRESAMP(_get_delay)(RRESAMP() _q);                 \
+                                                                \
+/* get interpolation/decimation factors (reduced to lowest  */  \
+/* terms) and resampling rate P/Q                           */  \
+unsigned int RRESAMP(_get_P)(RRESAMP() _q);                     \
+unsigned int RRESAMP(_get_Q)(RRESAMP() _q);                     \
+float        RRESAMP(_get_rate)(RRESAMP() _q);                  \
+                                                                \
+/* execute rational-rate resampler on one frame             */  \
+/*  _q      :   rresamp object                              */  \
+/*  _x      :   input frame [size: Q x 1]                   */  \
+/*  _y      :   output frame [size: P x 1]                  */  \
+void RRESAMP(_execute)(RRESAMP() _q,                            \
+                       TI *      _x,                            \
+                       TO *      _y);                           \
+                                                                \
+/* execute rational-rate resampler on a block of frames     */  \
+/*  _q      :   rresamp object                              */  \
+/*  _x      :   input buffer [size: _n*Q x 1]               */  \
+/*  _n      :   number of frames                            */  \
+/*  _y      :   output buffer [size: _n*P x 1]              */  \
+void RRESAMP(_execute_block)(RRESAMP()    _q,                   \
+                             TI *         _x,                   \
+                             unsigned int _n,                   \
+                             TO *         _y);                  \
+
+LIQUID_RRESAMP_DEFINE_API(RRESAMP_MANGLE_RRRF,
+                          float,
+                          float,
+                          float)
+
+LIQUID_RRESAMP_DEFINE_API(RRESAMP_MANGLE_CRCF,
+                          liquid_float_complex,
+                          float,
+                          liquid_float_complex)
+
+LIQUID_RRESAMP_DEFINE_API(RRESAMP_MANGLE_CCCF,
+                          liquid_float_complex,
+                          liquid_float_complex,
+                          liquid_float_complex)
+
 
 // 
 // Multi-stage half-band resampler
@@ -3118,6 +4834,22 @@ float MSRESAMP2(_get_delay)(MSRESAMP2() _q);                    \
 void MSRESAMP2(_execute)(MSRESAMP2() _q,                        \
                          TI *        _x,                        \
                          TO *        _y);                       \
+                                                                \
+/* execute multi-stage resampler on a block, equivalent to  */  \
+/* _n calls to _execute(); all stages run over the block in */  \
+/* turn, passing intermediate results through internal      */  \
+/* buffers                                                  */  \
+/*  LIQUID_RESAMP_INTERP:   input: _n,  output: _n*M        */  \
+/*  LIQUID_RESAMP_DECIM:    input: _n*M, output: _n         */  \
+/*  _q      : msresamp object                               */  \
+/*  _x      : input sample array                            */  \
+/*  _n      : number of blocks of M samples (decimator) or  */  \
+/*            input samples (interpolator)                  */  \
+/*  _y      : output sample array                           */  \
+void MSRESAMP2(_execute_block)(MSRESAMP2()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
 
 LIQUID_MSRESAMP2_DEFINE_API(MSRESAMP2_MANGLE_RRRF,
                             float,
@@ -3163,6 +4895,9 @@ void MSRESAMP(_reset)(MSRESAMP() _q);                           \
 /* get filter delay (output samples)                        */  \
 float MSRESAMP(_get_delay)(MSRESAMP() _q);                      \
                                                                 \
+/* get composite resampling rate (output/input)             */  \
+float MSRESAMP(_get_rate)(MSRESAMP() _q);                       \
+                                                                \
 /* execute multi-stage resampler                            */  \
 /*  _q      :   msresamp object                             */  \
 /*  _x      :   input sample array  [size: _nx x 1]         */  \
@@ -3243,10 +4978,18 @@ void SYMSYNC(_print)(SYMSYNC() _q);                             \
 /* reset symsync internal state                             */  \
 void SYMSYNC(_reset)(SYMSYNC() _q);                             \
                                                                 \
+/* get nominal matched filter delay (output samples)        */  \
+float SYMSYNC(_get_delay)(SYMSYNC() _q);                        \
+                                                                \
 /* lock/unlock loop control                                 */  \
 void SYMSYNC(_lock)(  SYMSYNC() _q);                            \
 void SYMSYNC(_unlock)(SYMSYNC() _q);                            \
                                                                 \
+/* enable/disable half-precision storage of the matched and */  \
+/* derivative matched filterbank coefficients               */  \
+void SYMSYNC(_set_coeff_fp16)(SYMSYNC() _q,                     \
+                              int       _enable);               \
+                                                                \
 /* set synchronizer output rate (samples/symbol)            */  \
 /*  _q      : synchronizer object                           */  \
 /*  _k_out  : output samples/symbol                         */  \
@@ -3410,7 +5153,7 @@ typedef struct {
 } framesyncstats_s;
 
 // external framesyncstats default object
-extern framesyncstats_s framesyncstats_default;
+extern const framesyncstats_s framesyncstats_default;
 
 // initialize framesyncstats object on default
 void framesyncstats_init_default(framesyncstats_s * _stats);
@@ -3434,6 +5177,165 @@ void framedatastats_reset(framedatastats_s * _stats);
 void framedatastats_print(framedatastats_s * _stats);
 
 
+// amcselect : adaptive modulation and coding selector. Tracks the link
+// SNR from received frame statistics (-evm, averaged) and recommends
+// the scheme (mod_scheme, fec0, fec1) with the highest expected
+// goodput, rate*(1-PER), from a table of packet error rates vs. SNR,
+// e.g. to pass to flexframegen_setprops() for the next frame. Moving
+// to a higher-rate scheme requires it to remain better with the SNR
+// lowered by a hysteresis margin (default: 1 dB); moving down is
+// immediate.
+typedef struct amcselect_s * amcselect;
+
+// create selector with built-in table: BPSK through QAM256 with
+// punctured K=7 convolutional codes, measured for 256-byte payloads
+// with CRC-32 over AWGN, -4 to 36 dB
+amcselect amcselect_create();
+
+// create selector from packet error rate table
+//  _ms         :   modulation schemes [size: _num_schemes x 1]
+//  _fec0       :   inner codes [size: _num_schemes x 1], NULL for none
+//  _fec1       :   outer codes [size: _num_schemes x 1], NULL for none
+//  _num_schemes:   number of schemes
+//  _per        :   packet error rates, one row of _num_snr values per
+//                  scheme [size: _num_schemes x _num_snr]
+//  _num_snr    :   number of SNR points per scheme, _num_snr > 1
+//  _snr0       :   SNR of first point [dB]
+//  _dsnr       :   SNR spacing of points [dB], _dsnr > 0
+amcselect amcselect_create_table(const int *   _ms,
+                                 const int *   _fec0,
+                                 const int *   _fec1,
+                                 unsigned int  _num_schemes,
+                                 const float * _per,
+                                 unsigned int  _num_snr,
+                                 float         _snr0,
+                                 float         _dsnr);
+void amcselect_destroy(amcselect _q);
+void amcselect_print(amcselect _q);
+
+// reset selector: forget SNR estimate, select lowest-rate scheme
+void amcselect_reset(amcselect _q);
+
+// set margin required to switch to a higher-rate scheme [dB]
+void amcselect_set_hysteresis(amcselect _q, float _hysteresis);
+
+// set SNR averaging factor, 0 < _alpha <= 1 (default: 0.25)
+void amcselect_set_alpha(amcselect _q, float _alpha);
+
+// update from received frame statistics and re-select scheme; stats
+// with evm of exactly zero (not measured by the synchronizer) are
+// ignored
+void amcselect_push(amcselect _q, framesyncstats_s _stats);
+
+// update from measured SNR [dB] and re-select scheme
+void amcselect_push_snr(amcselect _q, float _snr);
+
+// get averaged SNR estimate [dB]
+float amcselect_get_snr(amcselect _q);
+
+// get selected scheme and its index in the table
+void amcselect_get_scheme(amcselect _q,
+                          int *     _ms,
+                          int *     _fec0,
+                          int *     _fec1);
+unsigned int amcselect_get_index(amcselect _q);
+
+// get expected goodput of selected scheme at the current SNR
+// estimate [information bits/symbol]
+float amcselect_get_goodput(amcselect _q);
+
+// get packet error rate of scheme _i at SNR _snr [dB], interpolated
+// from the table
+float amcselect_get_per(amcselect _q, unsigned int _i, float _snr);
+
+
+// number of bins in frameperfstats latency histogram; bin 0 counts
+// latencies below 2 us, bin k>0 counts [2^k, 2^(k+1)) us
+#define FRAMEPERFSTATS_LATENCY_BINS (24)
+
+// frameperfstats : receiver hot-path counters, gathered only while
+// enabled on the synchronizer (*_perfstats_enable())
+typedef struct {
+    unsigned long int num_samples_detect;   // samples processed seeking frame
+    unsigned long int num_samples_preamble; // samples processed in preamble
+    unsigned long int num_samples_header;   // samples processed in header
+    unsigned long int num_samples_payload;  // samples processed in payload
+    unsigned long int num_detector_passes;  // frame detector correlation passes
+    unsigned long int num_decode_attempts;  // header/payload decode attempts
+    unsigned long int num_header_rejects;   // headers rejected before decoding
+    double            time_fec;             // time decoding header/payload [s]
+    double            time_callback;        // time in user callback [s]
+
+    // latency from entry of the execute() call holding the last
+    // sample of a frame to its callback being invoked
+    unsigned long int num_latency;          // number of frames measured
+    double            latency_min;          // minimum latency [s]
+    double            latency_max;          // maximum latency [s]
+    double            latency_sum;          // sum of latencies [s]
+    unsigned long int latency_hist[FRAMEPERFSTATS_LATENCY_BINS];
+} frameperfstats_s;
+
+// reset frameperfstats object
+void frameperfstats_reset(frameperfstats_s * _stats);
+
+// print frameperfstats object
+void frameperfstats_print(frameperfstats_s * _stats);
+
+
+// frametrace : timestamped receiver events (frame detected, header and
+// payload decoded, state transitions) for building timelines under
+// live load. While enabled, frame synchronizers append events to a
+// buffer owned by the calling thread; whenever it fills, and on
+// frametrace_flush(), its records are handed to the drain callback on
+// that same thread. The hooks cost a single branch while disabled and
+// are removed entirely when configured with --enable-traceoverride.
+typedef enum {
+    LIQUID_FRAMETRACE_FRAME_DETECTED=0, // frame detected
+    LIQUID_FRAMETRACE_HEADER_DECODED,   // header decoded (arg: valid)
+    LIQUID_FRAMETRACE_PAYLOAD_DECODED,  // payload decoded (arg: valid)
+    LIQUID_FRAMETRACE_STATE,            // state transition (arg: new state)
+    LIQUID_FRAMETRACE_NUM_EVENTS
+} liquid_frametrace_event;
+
+// number of records buffered per thread before draining
+#define FRAMETRACE_BUFFER_LEN (256)
+
+// frametrace record
+typedef struct {
+    double       time;      // monotonic time stamp [s]
+    const void * source;    // object which emitted event
+    const char * object;    // object type, e.g. "flexframesync"
+    int          event;     // event type (liquid_frametrace_event)
+    int          arg;       // event argument
+} frametrace_record_s;
+
+// frametrace drain callback, invoked on the thread which emitted the
+// records; the records are only valid for the duration of the call
+//  _records    :   trace records, oldest first [size: _n x 1]
+//  _n          :   number of records
+//  _userdata   :   user-defined data pointer
+typedef void (*frametrace_drain_callback)(const frametrace_record_s * _records,
+                                          unsigned int                _n,
+                                          void *                      _userdata);
+
+// enable tracing, handing buffered records to _drain; returns 0 on
+// success, -1 if tracing was removed at compile time
+int  frametrace_enable(frametrace_drain_callback _drain,
+                       void *                    _userdata);
+
+// disable tracing, draining the calling thread's buffer; records still
+// buffered by other threads are discarded (call frametrace_flush() on
+// those threads first to keep them)
+void frametrace_disable();
+int  frametrace_is_enabled();
+
+// drain records buffered by the calling thread
+void frametrace_flush();
+
+// get string name of frametrace event
+const char * frametrace_event_str(int _event);
+
+
 // Generic frame synchronizer callback function type
 //  _header         :   header data [size: 8 bytes]
 //  _header_valid   :   is header valid? (0:no, 1:yes)
@@ -3454,6 +5356,28 @@ typedef int (*framesync_callback)(unsigned char *  _header,
 //  _userdata       :   user-defined data pointer
 typedef void (*framesync_csma_callback)(void * _userdata);
 
+// Queued frame delivery: rather than invoking the callback from within
+// execute(), a frame synchronizer may copy each received frame (header,
+// payload and statistics, including the frame symbols) into one of a
+// fixed number of pooled slots. Frames are then either popped by the
+// application, possibly from another thread, or delivered to the
+// callback by a dedicated thread. Slot buffers are kept across frames,
+// so nothing is allocated once they have grown to the largest frame
+// received. When every slot is occupied the frame is dropped and
+// counted; the sample thread never waits on the consumer.
+
+// frame popped from a synchronizer's queue; buffers belong to the
+// queue and remain valid until the next pop
+typedef struct {
+    unsigned char *  header;        // header data [size: header_len]
+    unsigned int     header_len;    // header length [bytes]
+    int              header_valid;  // is header valid? (0:no, 1:yes)
+    unsigned char *  payload;       // payload data [size: payload_len]
+    unsigned int     payload_len;   // payload length [bytes]
+    int              payload_valid; // is payload valid? (0:no, 1:yes)
+    framesyncstats_s stats;         // frame statistics
+} framesync_frame_s;
+
 //
 // packet encoder/decoder
 //
@@ -3466,6 +5390,9 @@ void         qpacketmodem_destroy(qpacketmodem _q);
 void         qpacketmodem_reset  (qpacketmodem _q);
 void         qpacketmodem_print  (qpacketmodem _q);
 
+// get memory footprint of object and its buffers [bytes]
+unsigned long int qpacketmodem_get_memory_usage(qpacketmodem _q);
+
 int qpacketmodem_configure(qpacketmodem _q,
                            unsigned int _payload_len,
                            crc_scheme   _check,
@@ -3526,6 +5453,20 @@ int qpacketmodem_decode(qpacketmodem           _q,
                         liquid_float_complex * _frame,
                         unsigned char *        _payload);
 
+// decode packet from modulated frame samples as qpacketmodem_decode(),
+// but first check the syndromes of the outer code (see
+// packetizer_precheck) and skip decoding, returning -1, if the fraction
+// of uncorrectable codewords exceeds _threshold
+// NOTE: hard-decision decoding
+//  _q          :   qpacketmodem object
+//  _frame      :   encoded/modulated payload symbols
+//  _payload    :   recovered decoded payload bytes
+//  _threshold  :   maximum fraction of uncorrectable codewords
+int qpacketmodem_decode_precheck(qpacketmodem           _q,
+                                 liquid_float_complex * _frame,
+                                 unsigned char *        _payload,
+                                 float                  _threshold);
+
 // decode packet from modulated frame samples, returning flag if CRC passed
 // NOTE: soft-decision decoding
 //  _q          :   qpacketmodem object
@@ -3535,6 +5476,32 @@ int qpacketmodem_decode_soft(qpacketmodem           _q,
                              liquid_float_complex * _frame,
                              unsigned char *        _payload);
 
+// incremental soft-decision decoding: symbols are demodulated to soft
+// bits as they are pushed so that only the de-interleaving, FEC and CRC
+// remain once the last symbol has arrived; qpacketmodem_reset() and
+// qpacketmodem_configure() restart the frame
+
+// push received symbol, returning 1 once the whole frame has been pushed
+//  _q          :   qpacketmodem object
+//  _sym        :   received payload symbol
+int qpacketmodem_decode_soft_push(qpacketmodem         _q,
+                                  liquid_float_complex _sym);
+
+// push block of received symbols, stopping at the end of the frame;
+// returns number of symbols consumed
+//  _q          :   qpacketmodem object
+//  _syms       :   received payload symbols [size: _n x 1]
+//  _n          :   number of input symbols
+unsigned int qpacketmodem_decode_soft_push_block(qpacketmodem           _q,
+                                                 liquid_float_complex * _syms,
+                                                 unsigned int           _n);
+
+// decode packet from pushed symbols, returning flag if CRC passed
+//  _q          :   qpacketmodem object
+//  _payload    :   recovered decoded payload bytes
+int qpacketmodem_decode_soft_finish(qpacketmodem    _q,
+                                    unsigned char * _payload);
+
 //
 // pilot generator for streaming applications
 //
@@ -3576,6 +5543,20 @@ void qpilotsync_destroy(qpilotsync _q);
 void qpilotsync_reset(  qpilotsync _q);
 void qpilotsync_print(  qpilotsync _q);
 
+// enable/disable direct carrier frequency estimation from the pilot
+// autocorrelation (Mengali & Morelli) in place of the default FFT
+// search, releasing the transform. Faster and smaller for short pilot
+// sequences and as accurate down to about 0 dB SNR, but with roughly
+// twice the outliers below that. Ignored (with a warning) for more than
+// 32 pilots.
+//  _q      :   qpilotsync object
+//  _direct :   non-zero to estimate directly
+void qpilotsync_set_direct(qpilotsync _q,
+                           int        _direct);
+
+// get memory footprint of object and its buffers [bytes]
+unsigned long int qpilotsync_get_memory_usage(qpilotsync _q);
+
 unsigned int qpilotsync_get_frame_len(qpilotsync _q);
 
 // recover frame symbols from received frame
@@ -3641,6 +5622,20 @@ void framesync64_reset(framesync64 _q);
 void framesync64_execute(framesync64            _q,
                          liquid_float_complex * _x,
                          unsigned int           _n);
+// energy gate on frame detector: bypass the preamble correlation while
+// the input level stays within the threshold [dB] of the noise floor
+void         framesync64_gate_enable         (framesync64 _q);
+void         framesync64_gate_disable        (framesync64 _q);
+void         framesync64_gate_set_threshold  (framesync64 _q, float _threshold);
+unsigned int framesync64_gate_get_num_blocks (framesync64 _q);
+unsigned int framesync64_gate_get_num_skipped(framesync64 _q);
+
+// receiver performance counters (samples per state, detector passes,
+// decode attempts, FEC and callback time); disabled by default
+void             framesync64_perfstats_enable (framesync64 _q);
+void             framesync64_perfstats_disable(framesync64 _q);
+void             framesync64_reset_perfstats  (framesync64 _q);
+frameperfstats_s framesync64_get_perfstats    (framesync64 _q);
 
 // enable/disable debugging
 void framesync64_debug_enable(framesync64 _q);
@@ -3707,6 +5702,24 @@ void flexframegen_assemble(flexframegen          _q,
                            const unsigned char * _payload,
                            unsigned int          _payload_len);
 
+// assemble a batch of frames, written back to back by write_block()
+// with '_gap_len' zero-valued samples between consecutive frames; each
+// frame is encoded in the background while the previous frame is
+// being written. Buffers are not copied and must remain valid until
+// write_block() returns '1' for the last frame of the batch
+//  _q              :   frame generator object
+//  _num_frames     :   number of frames in batch
+//  _headers        :   frame headers [size: _num_frames x 1]
+//  _payloads       :   payload data [size: _num_frames x 1]
+//  _payload_lens   :   payload data lengths [size: _num_frames x 1]
+//  _gap_len        :   number of zero-valued samples between frames
+void flexframegen_assemble_batch(flexframegen     _q,
+                                 unsigned int     _num_frames,
+                                 unsigned char ** _headers,
+                                 unsigned char ** _payloads,
+                                 unsigned int *   _payload_lens,
+                                 unsigned int     _gap_len);
+
 // write samples of assembled frame, two samples at a time, returning
 // '1' when frame is complete, '0' otherwise. Zeros will be written
 // to the buffer if the frame is not assembled
@@ -3717,6 +5730,19 @@ int flexframegen_write_samples(flexframegen           _q,
                                liquid_float_complex * _buffer,
                                unsigned int           _buffer_len);
 
+// write samples of assembled frame (or batch) into a buffer of
+// arbitrary length, stopping at the end of the frame; returns '1' when
+// the final sample of the frame (or of the last frame of the batch)
+// has been written, '0' otherwise
+//  _q          :   frame generator object
+//  _buffer     :   output buffer [size: _buffer_len x 1]
+//  _buffer_len :   output buffer length
+//  _num_written:   number of samples written to buffer
+int flexframegen_write_block(flexframegen           _q,
+                             liquid_float_complex * _buffer,
+                             unsigned int           _buffer_len,
+                             unsigned int *         _num_written);
+
 // frame synchronizer
 
 typedef struct flexframesync_s * flexframesync;
@@ -3727,12 +5753,26 @@ typedef struct flexframesync_s * flexframesync;
 flexframesync flexframesync_create(framesync_callback _callback,
                                    void *             _userdata);
 
+// create flexframesync object sharing the read-only frame detector
+// template and matched filter coefficients of an existing object;
+// objects sharing state may execute concurrently but must be
+// created/destroyed serially
+//  _proto      :   prototype frame synchronizer
+//  _callback   :   callback function
+//  _userdata   :   user data pointer passed to callback function
+flexframesync flexframesync_create_shared(flexframesync      _proto,
+                                          framesync_callback _callback,
+                                          void *             _userdata);
+
 // destroy frame synchronizer
 void flexframesync_destroy(flexframesync _q);
 
 // print frame synchronizer internal properties
 void flexframesync_print(flexframesync _q);
 
+// get memory footprint of object and its buffers [bytes]
+unsigned long int flexframesync_get_memory_usage(flexframesync _q);
+
 // reset frame synchronizer internal state
 void flexframesync_reset(flexframesync _q);
 
@@ -3748,12 +5788,196 @@ void flexframesync_execute(flexframesync          _q,
 void             flexframesync_reset_framedatastats(flexframesync _q);
 framedatastats_s flexframesync_get_framedatastats  (flexframesync _q);
 
+// receiver performance counters (samples per state, detector passes,
+// decode attempts, FEC and callback time); disabled by default
+void             flexframesync_perfstats_enable (flexframesync _q);
+void             flexframesync_perfstats_disable(flexframesync _q);
+void             flexframesync_reset_perfstats  (flexframesync _q);
+frameperfstats_s flexframesync_get_perfstats    (flexframesync _q);
+
+// header-only mode: once a valid header has been decoded the callback
+// is invoked with the header and payload configuration (NULL payload,
+// zero length, payload invalid) and the payload samples are skipped
+// without being demodulated or decoded; disabled by default
+void flexframesync_set_header_only(flexframesync _q, int _header_only);
+int  flexframesync_get_header_only(flexframesync _q);
+
+// queued frame delivery (see framesync_frame_s): _num_slots pooled
+// frame slots, or 0 to invoke the callback from execute() (default);
+// with _thread set a dedicated thread drains the queue into the
+// callback, otherwise frames are retrieved with pop_frame(), which
+// returns 1 if a frame was popped and 0 if the queue is empty.
+// Reconfiguring discards queued frames not yet popped.
+void flexframesync_set_frame_queue(flexframesync _q, unsigned int _num_slots, int _thread);
+int  flexframesync_pop_frame      (flexframesync _q, framesync_frame_s * _frame);
+unsigned int flexframesync_get_frame_queue_drops(flexframesync _q);
+
+// energy gate on frame detector: bypass the preamble correlation while
+// the input level stays within the threshold [dB] of the noise floor
+void         flexframesync_gate_enable         (flexframesync _q);
+void         flexframesync_gate_disable        (flexframesync _q);
+void         flexframesync_gate_set_threshold  (flexframesync _q, float _threshold);
+unsigned int flexframesync_gate_get_num_blocks (flexframesync _q);
+unsigned int flexframesync_gate_get_num_skipped(flexframesync _q);
+
 // enable/disable debugging
 void flexframesync_debug_enable(flexframesync _q);
 void flexframesync_debug_disable(flexframesync _q);
 void flexframesync_debug_print(flexframesync _q,
                                const char *  _filename);
 
+// multi-stream frame synchronizer: bank of flexframesync objects
+// sharing read-only state, with streams executed across a pool of
+// threads; callbacks are serialized but may be invoked from any of
+// the bank's threads
+
+typedef struct flexframesyncbank_s * flexframesyncbank;
+
+// create multi-stream frame synchronizer
+//  _num_streams    :   number of input streams
+//  _num_threads    :   number of threads executing streams, including the caller
+//  _callback       :   callback function
+//  _userdata       :   per-stream user data passed to callback [size: _num_streams x 1], or NULL
+flexframesyncbank flexframesyncbank_create(unsigned int       _num_streams,
+                                           unsigned int       _num_threads,
+                                           framesync_callback _callback,
+                                           void **            _userdata);
+void flexframesyncbank_destroy(flexframesyncbank _q);
+void flexframesyncbank_print  (flexframesyncbank _q);
+void flexframesyncbank_reset  (flexframesyncbank _q);
+
+// get number of input streams
+unsigned int flexframesyncbank_get_num_streams(flexframesyncbank _q);
+
+// get synchronizer for stream _i, e.g. to configure it or read its
+// frame data statistics
+flexframesync flexframesyncbank_get_stream(flexframesyncbank _q,
+                                           unsigned int      _i);
+
+// push a block of samples from each stream through its synchronizer
+//  _q      :   multi-stream frame synchronizer
+//  _x      :   input samples, one buffer per stream [size: _num_streams x _n]
+//  _n      :   number of input samples per stream
+void flexframesyncbank_execute(flexframesyncbank       _q,
+                               liquid_float_complex ** _x,
+                               unsigned int            _n);
+
+//
+// Monte Carlo simulation harness, e.g. for packet error rate curves:
+// independent trials run across a pool of threads, each thread holding
+// its own objects created through _create
+//
+
+// create per-thread state (e.g. frame generator, channel, synchronizer);
+// create and destroy callbacks are never run concurrently
+typedef void * (*montecarlo_create_callback)(void * _userdata);
+
+// run one trial seeded with _seed, returning its number of errors
+// (e.g. 1 for a lost packet); seed objects with channel_cccf_set_seed(),
+// randf_seed_r(), etc. so that trials are independent and repeatable
+typedef unsigned int (*montecarlo_trial_callback)(void *       _state,
+                                                  unsigned int _seed);
+
+// destroy per-thread state
+typedef void (*montecarlo_destroy_callback)(void * _state);
+
+// run trials, returning total number of errors; trial seeds depend
+// only on _seed and the trial index, so results do not depend on the
+// number of threads
+//  _create     :   create per-thread state (NULL: _userdata is the state)
+//  _trial      :   trial function
+//  _destroy    :   destroy per-thread state (may be NULL)
+//  _userdata   :   user-defined data passed to _create
+//  _num_trials :   number of trials
+//  _num_threads:   number of threads, including the caller
+//  _seed       :   simulation seed
+unsigned long int montecarlo_run(montecarlo_create_callback  _create,
+                                 montecarlo_trial_callback   _trial,
+                                 montecarlo_destroy_callback _destroy,
+                                 void *                      _userdata,
+                                 unsigned int                _num_trials,
+                                 unsigned int                _num_threads,
+                                 unsigned int                _seed);
+
+//
+// batch decoding of recorded captures: the capture is split into
+// shards, each decoded by an independent synchronizer on a pool of
+// threads. Every shard starts _overlap samples early so that frames
+// straddling a shard boundary are seen whole; a frame is reported only
+// by the shard whose span contains the sample position at which its
+// decoding completed, so frames found twice in an overlap are dropped.
+// Frames are reported in capture order on the calling thread.
+//
+
+// samples pushed to a synchronizer per call during batch decoding;
+// frame positions are reported with this granularity
+#define LIQUID_FRAMESYNC_BATCH_BLOCK (64)
+
+// batch decoding callback
+//  _position       :   capture index of the sample block in which
+//                      frame decoding completed (end of block)
+//  _header ... _userdata : as framesync_callback; _stats.framesyms is
+//                      NULL
+typedef int (*framesync_batch_callback)(unsigned long int _position,
+                                        unsigned char *   _header,
+                                        int               _header_valid,
+                                        unsigned char *   _payload,
+                                        unsigned int      _payload_len,
+                                        int               _payload_valid,
+                                        framesyncstats_s  _stats,
+                                        void *            _userdata);
+
+// synchronizer operations for batch decoding
+typedef struct {
+    // create synchronizer invoking _callback(..., _userdata) per frame
+    void * (*create) (framesync_callback _callback,
+                      void *             _userdata,
+                      void *             _context);
+    void   (*execute)(void * _q, liquid_float_complex * _x, unsigned int _n);
+    void   (*reset)  (void * _q);
+    void   (*destroy)(void * _q);
+    unsigned int header_len;    // header length passed to callback [bytes]
+    void *       context;       // user-defined data passed to create
+} framesync_batch_s;
+
+// decode capture in overlapping shards across a pool of threads,
+// returning the number of frames reported
+//  _sync       :   synchronizer operations
+//  _x          :   capture samples [size: _n x 1]
+//  _n          :   number of samples
+//  _overlap    :   shard overlap [samples], at least the longest frame
+//  _num_threads:   number of threads, including the caller
+//  _callback   :   frame callback, invoked on the calling thread
+//  _userdata   :   user-defined data passed to callback
+unsigned int framesync_batch_decode(const framesync_batch_s * _sync,
+                                    liquid_float_complex *    _x,
+                                    unsigned long int         _n,
+                                    unsigned int              _overlap,
+                                    unsigned int              _num_threads,
+                                    framesync_batch_callback  _callback,
+                                    void *                    _userdata);
+
+// decode capture with default flexframesync synchronizers
+unsigned int flexframesync_decode_batch(liquid_float_complex *   _x,
+                                        unsigned long int        _n,
+                                        unsigned int             _overlap,
+                                        unsigned int             _num_threads,
+                                        framesync_batch_callback _callback,
+                                        void *                   _userdata);
+
+// decode capture with ofdmflexframesync synchronizers
+//  _M, _cp_len, _taper_len, _p :   as ofdmflexframesync_create()
+unsigned int ofdmflexframesync_decode_batch(unsigned int             _M,
+                                            unsigned int             _cp_len,
+                                            unsigned int             _taper_len,
+                                            unsigned char *          _p,
+                                            liquid_float_complex *   _x,
+                                            unsigned long int        _n,
+                                            unsigned int             _overlap,
+                                            unsigned int             _num_threads,
+                                            framesync_batch_callback _callback,
+                                            void *                   _userdata);
+
 //
 // bpacket : binary packet suitable for data streaming
 //
@@ -3868,6 +6092,18 @@ unsigned int gmskframegen_getframelen(gmskframegen _q);
 int gmskframegen_write_samples(gmskframegen _q,
                                liquid_float_complex * _y);
 
+// write samples of assembled frame into a buffer of arbitrary length,
+// stopping at the end of the frame; returns '1' when the final sample
+// of the frame has been written, '0' otherwise
+//  _q          :   frame generator object
+//  _buffer     :   output buffer [size: _buffer_len x 1]
+//  _buffer_len :   output buffer length
+//  _num_written:   number of samples written to buffer
+int gmskframegen_write_block(gmskframegen           _q,
+                             liquid_float_complex * _buffer,
+                             unsigned int           _buffer_len,
+                             unsigned int *         _num_written);
+
 
 //
 // GMSK frame synchronizer
@@ -3887,6 +6123,40 @@ void gmskframesync_execute(gmskframesync _q,
                            liquid_float_complex * _x,
                            unsigned int _n);
 
+// receiver performance counters (samples per state, detector passes,
+// decode attempts, FEC and callback time); disabled by default
+void             gmskframesync_perfstats_enable (gmskframesync _q);
+void             gmskframesync_perfstats_disable(gmskframesync _q);
+void             gmskframesync_reset_perfstats  (gmskframesync _q);
+frameperfstats_s gmskframesync_get_perfstats    (gmskframesync _q);
+
+// frame detection with an FFT block detector (one correlation sweep
+// over all carrier offsets per block) in place of the default
+// time-domain correlator bank; the search range may be widened
+void gmskframesync_fft_detector_enable   (gmskframesync _q);
+void gmskframesync_fft_detector_disable  (gmskframesync _q);
+void gmskframesync_fft_detector_set_range(gmskframesync _q, float _dphi_max);
+
+// header-only mode: once a valid header has been decoded the callback
+// is invoked with the header and payload configuration (NULL payload,
+// zero length, payload invalid) and the payload samples are skipped
+// without being demodulated or decoded; disabled by default
+void gmskframesync_set_header_only(gmskframesync _q, int _header_only);
+int  gmskframesync_get_header_only(gmskframesync _q);
+
+// queued frame delivery; see flexframesync_set_frame_queue()
+void gmskframesync_set_frame_queue(gmskframesync _q, unsigned int _num_slots, int _thread);
+int  gmskframesync_pop_frame      (gmskframesync _q, framesync_frame_s * _frame);
+unsigned int gmskframesync_get_frame_queue_drops(gmskframesync _q);
+
+// energy gate on FFT block detector: bypass the preamble correlation
+// while the input level stays within the threshold [dB] of the noise floor
+void         gmskframesync_gate_enable         (gmskframesync _q);
+void         gmskframesync_gate_disable        (gmskframesync _q);
+void         gmskframesync_gate_set_threshold  (gmskframesync _q, float _threshold);
+unsigned int gmskframesync_gate_get_num_blocks (gmskframesync _q);
+unsigned int gmskframesync_gate_get_num_skipped(gmskframesync _q);
+
 // debugging
 void gmskframesync_debug_enable(gmskframesync _q);
 void gmskframesync_debug_disable(gmskframesync _q);
@@ -3956,12 +6226,43 @@ void ofdmflexframegen_assemble(ofdmflexframegen      _q,
                                const unsigned char * _payload,
                                unsigned int          _payload_len);
 
+// assemble a batch of frames, written back to back by write_block()
+// with '_gap_len' zero-valued samples between consecutive frames; each
+// frame is encoded in the background while the previous frame is
+// being written. Buffers are not copied and must remain valid until
+// write_block() returns '1' for the last frame of the batch
+//  _q              :   OFDM frame generator object
+//  _num_frames     :   number of frames in batch
+//  _headers        :   frame headers [size: _num_frames x 1]
+//  _payloads       :   payload data [size: _num_frames x 1]
+//  _payload_lens   :   payload data lengths [size: _num_frames x 1]
+//  _gap_len        :   number of zero-valued samples between frames
+void ofdmflexframegen_assemble_batch(ofdmflexframegen _q,
+                                     unsigned int     _num_frames,
+                                     unsigned char ** _headers,
+                                     unsigned char ** _payloads,
+                                     unsigned int *   _payload_lens,
+                                     unsigned int     _gap_len);
+
 // write symbols of assembled frame
 //  _q              :   OFDM frame generator object
 //  _buffer         :   output buffer [size: M+cp_len x 1]
 int ofdmflexframegen_writesymbol(ofdmflexframegen       _q,
                                  liquid_float_complex * _buffer);
 
+// write samples of assembled frame (or batch) into a buffer of
+// arbitrary length, stopping at the end of the frame; returns '1' when
+// the final sample of the frame (or of the last frame of the batch)
+// has been written, '0' otherwise
+//  _q              :   OFDM frame generator object
+//  _buffer         :   output buffer [size: _buffer_len x 1]
+//  _buffer_len     :   output buffer length
+//  _num_written    :   number of samples written to buffer
+int ofdmflexframegen_write_block(ofdmflexframegen       _q,
+                                 liquid_float_complex * _buffer,
+                                 unsigned int           _buffer_len,
+                                 unsigned int *         _num_written);
+
 // 
 // OFDM flex frame synchronizer
 //
@@ -3984,23 +6285,182 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
 
 void ofdmflexframesync_destroy(ofdmflexframesync _q);
 void ofdmflexframesync_print(ofdmflexframesync _q);
+unsigned long int ofdmflexframesync_get_memory_usage(ofdmflexframesync _q);
 void ofdmflexframesync_reset(ofdmflexframesync _q);
 void ofdmflexframesync_execute(ofdmflexframesync _q,
                                liquid_float_complex * _x,
                                unsigned int _n);
 
+// execute synchronizer on interleaved 16-bit I/Q samples, widened
+// (x*scale) in short cache-resident blocks ahead of the synchronizer
+//  _q      :   synchronizer object
+//  _x      :   interleaved input array [size: 2*_n x 1]
+//  _n      :   number of complex samples
+//  _scale  :   input scaling factor (e.g. 1/32768)
+void ofdmflexframesync_execute_ci16(ofdmflexframesync _q,
+                                    const int16_t *   _x,
+                                    unsigned int      _n,
+                                    float             _scale);
+
 // query the received signal strength indication
 float ofdmflexframesync_get_rssi(ofdmflexframesync _q);
 
 // query the received carrier offset estimate
 float ofdmflexframesync_get_cfo(ofdmflexframesync _q);
 
+// set/get payload decoding type: soft-decision demodulation and
+// decoding if _soft is non-zero, hard-decision otherwise (default)
+void ofdmflexframesync_set_payload_soft(ofdmflexframesync _q,
+                                        int               _soft);
+int  ofdmflexframesync_get_payload_soft(ofdmflexframesync _q);
+
+// set/get number of payload decode threads; when non-zero, payloads
+// are decoded off the sample thread and the callback is invoked from
+// a decode thread in the order frames were received (the callback
+// must not call back into the synchronizer); zero decodes inline
+// within ofdmflexframesync_execute() (default)
+void ofdmflexframesync_set_decode_threads(ofdmflexframesync _q,
+                                          unsigned int      _num_threads);
+unsigned int ofdmflexframesync_get_decode_threads(ofdmflexframesync _q);
+
+// set/get number of OFDM symbols demodulated as a block; received
+// symbols are accumulated into a contiguous matrix and the payload is
+// demodulated in batches of up to _K symbols; zero demodulates each
+// OFDM symbol as it is received (default)
+void ofdmflexframesync_set_symbol_batch(ofdmflexframesync _q,
+                                        unsigned int      _K);
+unsigned int ofdmflexframesync_get_symbol_batch(ofdmflexframesync _q);
+
+// set/get header-only mode: once a valid header has been decoded the
+// callback is invoked with the header and payload configuration (NULL
+// payload, zero length, payload invalid) and the remaining OFDM
+// symbols of the frame are skipped without being transformed,
+// demodulated or decoded; disabled by default
+void ofdmflexframesync_set_header_only(ofdmflexframesync _q,
+                                       int               _header_only);
+int  ofdmflexframesync_get_header_only(ofdmflexframesync _q);
+
+// block until all received frames have been delivered to the callback,
+// including those waiting for the frame queue's delivery thread
+void ofdmflexframesync_wait(ofdmflexframesync _q);
+
+// queued frame delivery; see flexframesync_set_frame_queue(). With
+// payload decode threads, frames enter the queue in reception order.
+void ofdmflexframesync_set_frame_queue(ofdmflexframesync _q, unsigned int _num_slots, int _thread);
+int  ofdmflexframesync_pop_frame      (ofdmflexframesync _q, framesync_frame_s * _frame);
+unsigned int ofdmflexframesync_get_frame_queue_drops(ofdmflexframesync _q);
+
+// receiver performance counters (samples per state, detector passes,
+// decode attempts, FEC and callback time); disabled by default
+void             ofdmflexframesync_perfstats_enable (ofdmflexframesync _q);
+void             ofdmflexframesync_perfstats_disable(ofdmflexframesync _q);
+void             ofdmflexframesync_reset_perfstats  (ofdmflexframesync _q);
+frameperfstats_s ofdmflexframesync_get_perfstats    (ofdmflexframesync _q);
+
 // enable/disable debugging
 void ofdmflexframesync_debug_enable(ofdmflexframesync _q);
 void ofdmflexframesync_debug_disable(ofdmflexframesync _q);
 void ofdmflexframesync_debug_print(ofdmflexframesync _q,
                                    const char *      _filename);
 
+//
+// OFDMA multi-user frame generator/synchronizer: users share the PLCP,
+// pilots and transform of one OFDM frame and occupy disjoint sets of
+// data subcarriers, each carrying an ofdmflexframe header and payload;
+// the receiver runs a single ofdmframesync for all users
+//
+
+typedef struct ofdmmuframegen_s * ofdmmuframegen;
+
+// create OFDMA multi-user frame generator
+//  _M          :   number of subcarriers
+//  _cp_len     :   cyclic prefix length
+//  _taper_len  :   taper length (OFDM symbol overlap)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _num_users  :   number of users
+//  _user_map   :   user of each data subcarrier, [size: _M x 1]
+ofdmmuframegen ofdmmuframegen_create(unsigned int    _M,
+                                     unsigned int    _cp_len,
+                                     unsigned int    _taper_len,
+                                     unsigned char * _p,
+                                     unsigned int    _num_users,
+                                     unsigned char * _user_map);
+void ofdmmuframegen_destroy(ofdmmuframegen _q);
+void ofdmmuframegen_print(ofdmmuframegen _q);
+
+// reset generator, discarding assembled frames of all users
+void ofdmmuframegen_reset(ofdmmuframegen _q);
+
+// get number of users
+unsigned int ofdmmuframegen_get_num_users(ofdmmuframegen _q);
+
+// get/set payload properties of user (defaults if _props is NULL)
+void ofdmmuframegen_getprops(ofdmmuframegen            _q,
+                             unsigned int              _user,
+                             ofdmflexframegenprops_s * _props);
+void ofdmmuframegen_setprops(ofdmmuframegen            _q,
+                             unsigned int              _user,
+                             ofdmflexframegenprops_s * _props);
+
+// get length of frame (OFDM symbols); the frame spans the longest
+// assembled user
+unsigned int ofdmmuframegen_getframelen(ofdmmuframegen _q);
+
+// assemble frame of one user; all users must be assembled before the
+// first symbol is written, and users left unassembled are idle
+//  _q              :   OFDMA frame generator object
+//  _user           :   user index
+//  _header         :   frame header [8 bytes]
+//  _payload        :   payload data [size: _payload_len x 1]
+//  _payload_len    :   payload data length
+void ofdmmuframegen_assemble(ofdmmuframegen        _q,
+                             unsigned int          _user,
+                             const unsigned char * _header,
+                             const unsigned char * _payload,
+                             unsigned int          _payload_len);
+
+// write symbol of assembled frame, returning '1' on the last symbol
+//  _q              :   OFDMA frame generator object
+//  _buffer         :   output buffer [size: M+cp_len x 1]
+int ofdmmuframegen_writesymbol(ofdmmuframegen         _q,
+                               liquid_float_complex * _buffer);
+
+typedef struct ofdmmuframesync_s * ofdmmuframesync;
+
+// create OFDMA multi-user frame synchronizer; each user's callback is
+// invoked once per frame (with an invalid header for idle users)
+//  _M          :   number of subcarriers
+//  _cp_len     :   cyclic prefix length
+//  _taper_len  :   taper length (OFDM symbol overlap)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _num_users  :   number of users
+//  _user_map   :   user of each data subcarrier, [size: _M x 1]
+//  _callbacks  :   callback of each user, [size: _num_users x 1]
+//  _userdata   :   user data of each user, [size: _num_users x 1], or NULL
+ofdmmuframesync ofdmmuframesync_create(unsigned int         _M,
+                                       unsigned int         _cp_len,
+                                       unsigned int         _taper_len,
+                                       unsigned char *      _p,
+                                       unsigned int         _num_users,
+                                       unsigned char *      _user_map,
+                                       framesync_callback * _callbacks,
+                                       void **              _userdata);
+void ofdmmuframesync_destroy(ofdmmuframesync _q);
+void ofdmmuframesync_print(ofdmmuframesync _q);
+void ofdmmuframesync_reset(ofdmmuframesync _q);
+void ofdmmuframesync_execute(ofdmmuframesync        _q,
+                             liquid_float_complex * _x,
+                             unsigned int           _n);
+
+// get number of users
+unsigned int ofdmmuframesync_get_num_users(ofdmmuframesync _q);
+
+// query the received signal strength indication
+float ofdmmuframesync_get_rssi(ofdmmuframesync _q);
+
+// query the received carrier offset estimate
+float ofdmmuframesync_get_cfo(ofdmmuframesync _q);
+
 
 
 //
@@ -4142,8 +6602,15 @@ qdetector_cccf qdetector_cccf_create_gmsk(unsigned char * _sequence,
                                           unsigned int    _m,
                                           float           _beta);
 
+// create detector sharing the read-only template of an existing
+// detector, copying its configuration; objects sharing a template
+// may execute concurrently but must be created/destroyed serially
+//  _proto          :   prototype detector
+qdetector_cccf qdetector_cccf_create_shared(qdetector_cccf _proto);
+
 void qdetector_cccf_destroy(qdetector_cccf _q);
 void qdetector_cccf_print  (qdetector_cccf _q);
+unsigned long int qdetector_cccf_get_memory_usage(qdetector_cccf _q);
 void qdetector_cccf_reset  (qdetector_cccf _q);
 
 // run detector, looking for sequence; return pointer to aligned, buffered samples
@@ -4151,12 +6618,31 @@ void * qdetector_cccf_execute(qdetector_cccf       _q,
                               liquid_float_complex _x);
 
 // set detection threshold (should be between 0 and 1, good starting point is 0.5)
-void qdetector_cccf_set_threshold(qdetector_cccf _q,
-                                  float          _threshold);
+void  qdetector_cccf_set_threshold(qdetector_cccf _q,
+                                   float          _threshold);
+float qdetector_cccf_get_threshold(qdetector_cccf _q);
 
 // set carrier offset search range
-void qdetector_cccf_set_range(qdetector_cccf _q,
-                              float          _dphi_max);
+void  qdetector_cccf_set_range(qdetector_cccf _q,
+                               float          _dphi_max);
+float qdetector_cccf_get_range(qdetector_cccf _q);
+
+// set carrier offset search grid step [subcarriers]; offsets are first
+// evaluated on a grid of this step and then refined about the best grid
+// point (default 1: exhaustive search)
+void         qdetector_cccf_set_range_step(qdetector_cccf _q,
+                                           unsigned int   _step);
+unsigned int qdetector_cccf_get_range_step(qdetector_cccf _q);
+
+// set offload queue for the carrier offset grid sweep: half of the grid
+// offsets are correlated as one batched job while the detector sweeps
+// the rest in place (NULL: sweep in place); the queue must outlive the
+// detector or be replaced first
+void qdetector_cccf_set_offload(qdetector_cccf _q,
+                                liquid_offload _offload);
+
+// get offload queue (NULL if none)
+liquid_offload qdetector_cccf_get_offload(qdetector_cccf _q);
 
 // access methods
 unsigned int qdetector_cccf_get_seq_len (qdetector_cccf _q); // sequence length
@@ -4167,6 +6653,62 @@ float        qdetector_cccf_get_gamma   (qdetector_cccf _q); // channel gain
 float        qdetector_cccf_get_dphi    (qdetector_cccf _q); // carrier frequency offset estimate
 float        qdetector_cccf_get_phi     (qdetector_cccf _q); // carrier phase offset estimate
 
+// energy gate: when enabled, the correlation sweep is bypassed while
+// the input level stays within the gate threshold [dB] of an adaptive
+// noise floor estimate (disabled by default, threshold 2 dB)
+void  qdetector_cccf_gate_enable       (qdetector_cccf _q);
+void  qdetector_cccf_gate_disable      (qdetector_cccf _q);
+int   qdetector_cccf_gate_is_enabled   (qdetector_cccf _q);
+void  qdetector_cccf_gate_set_threshold(qdetector_cccf _q, float _threshold);
+float qdetector_cccf_gate_get_threshold(qdetector_cccf _q);
+
+// energy gate statistics
+float        qdetector_cccf_gate_get_noise_floor(qdetector_cccf _q); // noise floor estimate [dB]
+unsigned int qdetector_cccf_gate_get_num_blocks (qdetector_cccf _q); // seek blocks processed
+unsigned int qdetector_cccf_gate_get_num_skipped(qdetector_cccf _q); // seek blocks bypassed
+void         qdetector_cccf_gate_reset_stats    (qdetector_cccf _q); // reset block counters
+
+//
+// Multi-template frame detector
+//
+
+typedef struct qdetectorbank_cccf_s * qdetectorbank_cccf;
+
+// create detector correlating one forward transform of the input
+// against the templates of several detectors, each transformed at a
+// common FFT size; thresholds and search ranges are copied from the
+// prototypes, which may be destroyed afterwards
+//  _proto  :   prototype detectors, [size: _num x 1]
+//  _num    :   number of templates
+qdetectorbank_cccf qdetectorbank_cccf_create(qdetector_cccf * _proto,
+                                             unsigned int     _num);
+
+void qdetectorbank_cccf_destroy(qdetectorbank_cccf _q);
+void qdetectorbank_cccf_print  (qdetectorbank_cccf _q);
+void qdetectorbank_cccf_reset  (qdetectorbank_cccf _q);
+
+// run detector, looking for any of the sequences; return pointer to
+// aligned, buffered samples (see qdetectorbank_cccf_get_index())
+void * qdetectorbank_cccf_execute(qdetectorbank_cccf   _q,
+                                  liquid_float_complex _x);
+
+// set detection threshold and carrier offset search range of template
+void qdetectorbank_cccf_set_threshold(qdetectorbank_cccf _q,
+                                      unsigned int       _index,
+                                      float              _threshold);
+void qdetectorbank_cccf_set_range    (qdetectorbank_cccf _q,
+                                      unsigned int       _index,
+                                      float              _dphi_max);
+
+// access methods
+unsigned int qdetectorbank_cccf_get_num_templates(qdetectorbank_cccf _q); // number of templates
+unsigned int qdetectorbank_cccf_get_index  (qdetectorbank_cccf _q); // template of last detection
+unsigned int qdetectorbank_cccf_get_buf_len(qdetectorbank_cccf _q); // buffer length
+float        qdetectorbank_cccf_get_tau    (qdetectorbank_cccf _q); // fractional timing offset estimate
+float        qdetectorbank_cccf_get_gamma  (qdetectorbank_cccf _q); // channel gain
+float        qdetectorbank_cccf_get_dphi   (qdetectorbank_cccf _q); // carrier frequency offset estimate
+float        qdetectorbank_cccf_get_phi    (qdetectorbank_cccf _q); // carrier phase offset estimate
+
 //
 // Pre-demodulation detector
 //
@@ -4205,6 +6747,20 @@ int detector_cccf_correlate(detector_cccf        _q,
                             float *              _dphi_hat,
                             float *              _gamma_hat);
 
+// energy gate: when enabled, correlation is bypassed while seeking and
+// the input level over the last sequence length stays within the gate
+// threshold [dB] of an adaptive noise floor estimate (disabled by
+// default, threshold 2 dB)
+void  detector_cccf_gate_enable       (detector_cccf _q);
+void  detector_cccf_gate_disable      (detector_cccf _q);
+int   detector_cccf_gate_is_enabled   (detector_cccf _q);
+void  detector_cccf_gate_set_threshold(detector_cccf _q, float _threshold);
+float detector_cccf_gate_get_threshold(detector_cccf _q);
+
+// energy gate statistics
+float        detector_cccf_gate_get_noise_floor(detector_cccf _q); // noise floor estimate [dB]
+unsigned int detector_cccf_gate_get_num_skipped(detector_cccf _q); // correlations bypassed
+
 
 // 
 // symbol streaming for testing (no meaningful data, just symbols)
@@ -4312,6 +6868,15 @@ void MSOURCE(_set_frequency)(MSOURCE() _q,                      \
 void MSOURCE(_write_samples)(MSOURCE()    _q,                   \
                              TO *         _buf,                 \
                              unsigned int _buf_len);            \
+                                                                \
+/* set number of threads generating sources, including the  */  \
+/* caller (default 1); sources are generated in blocks and  */  \
+/* independent sources in parallel. Every noise and modem   */  \
+/* source has its own generator state, so output does not   */  \
+/* depend on the number of threads.                         */  \
+void MSOURCE(_set_num_threads)(MSOURCE()    _q,                 \
+                               unsigned int _num_threads);      \
+unsigned int MSOURCE(_get_num_threads)(MSOURCE() _q);           \
     
 LIQUID_MSOURCE_DEFINE_API(MSOURCE_MANGLE_CFLOAT, liquid_float_complex)
 
@@ -4410,6 +6975,14 @@ LIQUID_SYMTRACK_DEFINE_API(SYMTRACK_MANGLE_CCCF,
 // ln( Gamma(z) )
 float liquid_lngammaf(float _z);
 
+// ln( Gamma(z) ) over an array
+//  _z      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_lngammaf_block(float *      _z,
+                           unsigned int _n,
+                           float *      _y);
+
 // Gamma(z)
 float liquid_gammaf(float _z);
 
@@ -4439,6 +7012,15 @@ float liquid_besselif(float _nu, float _z);
 // I_0(z) : Modified Bessel function of the first kind (order zero)
 float liquid_besseli0f(float _z);
 
+// I_0(z) : Modified Bessel function of the first kind (order zero)
+// over an array
+//  _z      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_besseli0f_block(float *      _z,
+                            unsigned int _n,
+                            float *      _y);
+
 // J_v(z) : Bessel function of the first kind
 float liquid_besseljf(float _nu, float _z);
 
@@ -4461,6 +7043,35 @@ float liquid_MarcumQ1f(float _alpha,
 // sin(pi x) / (pi x)
 float sincf(float _x);
 
+// sin(pi x) / (pi x) over an array
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void sincf_block(float *      _x,
+                 unsigned int _n,
+                 float *      _y);
+
+// accuracy of block trigonometric functions
+typedef enum {
+    LIQUID_TRIG_EXACT=0,    // C library sinf(), cosf()
+    LIQUID_TRIG_FAST,       // minimax polynomials, within a few ulp
+    LIQUID_TRIG_COARSE,     // short polynomials, |error| < 2e-6
+} liquid_trig_accuracy;
+
+// sine and cosine over an array; polynomial tiers are evaluated for
+// |theta| <= 8192, larger or non-finite arguments are handed to the
+// C library
+//  _theta      :   input array [size: _n x 1]
+//  _n          :   array length
+//  _s          :   output sine array [size: _n x 1]
+//  _c          :   output cosine array [size: _n x 1]
+//  _accuracy   :   accuracy tier
+void liquid_sincosf_block(float *              _theta,
+                          unsigned int         _n,
+                          float *              _s,
+                          float *              _c,
+                          liquid_trig_accuracy _accuracy);
+
 // next power of 2 : y = ceil(log2(_x))
 unsigned int liquid_nextpow2(unsigned int _x);
 
@@ -4520,6 +7131,17 @@ float kaiser(unsigned int _n,
              float        _beta,
              float        _dt);
 
+// Kaiser window (full window); repeated requests for the same
+// parameters are served from a small internal table
+//  _n      :   window length
+//  _beta   :   Kaiser-Bessel window shape parameter
+//  _mu     :   fractional sample offset
+//  _w      :   resulting window [size: _n x 1]
+void liquid_kaiser_window(unsigned int _n,
+                          float        _beta,
+                          float        _mu,
+                          float *      _w);
+
 // Hamming window
 //  _n      :   window index
 //  _N      :   full window length
@@ -4584,6 +7206,18 @@ float liquid_rcostaper_windowf(unsigned int _n,
 /* evaluate polynomial _p (order _k-1) at value _x  */          \
 T POLY(_val)(T * _p, unsigned int _k, T _x);                    \
                                                                 \
+/* evaluate polynomial _p (order _k-1) at _n values */          \
+/*  _p      : poly array, ascending powers [size: _k x 1]   */  \
+/*  _k      : poly length (poly order = _k - 1)             */  \
+/*  _x      : input values [size: _n x 1]                   */  \
+/*  _n      : number of values                              */  \
+/*  _y      : output values [size: _n x 1]                  */  \
+void POLY(_val_batch)(T *          _p,                          \
+                      unsigned int _k,                          \
+                      T *          _x,                          \
+                      unsigned int _n,                          \
+                      T *          _y);                         \
+                                                                \
 /* least-squares polynomial fit (order _k-1) */                 \
 void POLY(_fit)(T * _x,                                         \
                 T * _y,                                         \
@@ -4665,6 +7299,12 @@ void POLY(_findroots)(T *          _poly,                       \
                       unsigned int _n,                          \
                       TC *         _roots);                     \
                                                                 \
+/* find the complex roots of the polynomial as the          */  \
+/* eigenvalues of its companion matrix                      */  \
+void POLY(_findroots_companion)(T *          _poly,             \
+                                unsigned int _k,                \
+                                TC *         _roots);           \
+                                                                \
 /* find the complex roots of the polynomial using the       */  \
 /* Durand-Kerner method                                     */  \
 void POLY(_findroots_durandkerner)(T *          _poly,          \
@@ -5154,6 +7794,52 @@ void SMATRIX(_mul)(SMATRIX() _x,                                \
 void SMATRIX(_vmul)(SMATRIX() _q,                               \
                     T *       _x,                               \
                     T *       _y);                              \
+                                                                \
+/* immutable compressed (CSR/CSC) copy, built once from   */  \
+/* the list form above for fast repeated products          */  \
+typedef struct SMATRIX(_csr_s) * SMATRIX(_csr);                 \
+                                                                \
+/* create compressed copy of sparse matrix _q */                \
+SMATRIX(_csr) SMATRIX(_csr_create)(SMATRIX() _q);               \
+                                                                \
+/* destroy compressed object */                                 \
+void SMATRIX(_csr_destroy)(SMATRIX(_csr) _q);                   \
+                                                                \
+/* query properties methods */                                  \
+void SMATRIX(_csr_size)(SMATRIX(_csr)  _q,                      \
+                        unsigned int * _m,                      \
+                        unsigned int * _n);                     \
+                                                                \
+/* get element value at index (zero if not set) */              \
+T SMATRIX(_csr_get)(SMATRIX(_csr) _q,                           \
+                    unsigned int  _m,                           \
+                    unsigned int  _n);                          \
+                                                                \
+/* get sorted non-zero column indices of row _m (returned    */ \
+/* pointer is owned by the object), returning row weight     */ \
+unsigned int SMATRIX(_csr_row)(SMATRIX(_csr)         _q,        \
+                               unsigned int          _m,        \
+                               unsigned short int ** _idx);     \
+                                                                \
+/* get sorted non-zero row indices of column _n, returning   */ \
+/* column weight                                             */ \
+unsigned int SMATRIX(_csr_col)(SMATRIX(_csr)         _q,        \
+                               unsigned int          _n,        \
+                               unsigned short int ** _idx);     \
+                                                                \
+/* multiply two compressed matrices into sparse matrix _c    */ \
+/* (reset, then only non-zero entries are set)               */ \
+void SMATRIX(_csr_mul)(SMATRIX(_csr) _a,                        \
+                       SMATRIX(_csr) _b,                        \
+                       SMATRIX()     _c);                       \
+                                                                \
+/* multiply compressed matrix by vector                      */ \
+/*  _q  :   compressed sparse matrix                         */ \
+/*  _x  :   input vector [size: _N x 1]                      */ \
+/*  _y  :   output vector [size: _M x 1]                     */ \
+void SMATRIX(_csr_vmul)(SMATRIX(_csr) _q,                       \
+                        T *           _x,                       \
+                        T *           _y);                      \
 
 LIQUID_SMATRIX_DEFINE_API(SMATRIX_MANGLE_BOOL,  unsigned char)
 LIQUID_SMATRIX_DEFINE_API(SMATRIX_MANGLE_FLOAT, float)
@@ -5183,6 +7869,26 @@ void smatrixb_vmulf(smatrixb _q,
                     float *  _x,
                     float *  _y);
 
+// multiply compressed sparse binary matrix by floating-point matrix
+//  _q  :   compressed sparse matrix [size: A->M x A->N]
+//  _x  :   input vector  [size:  mx  x  nx ]
+//  _y  :   output vector [size:  my  x  ny ]
+void smatrixb_csr_mulf(smatrixb_csr _A,
+                       float *      _x,
+                       unsigned int _mx,
+                       unsigned int _nx,
+                       float *      _y,
+                       unsigned int _my,
+                       unsigned int _ny);
+
+// multiply compressed sparse binary matrix by floating-point vector
+//  _q  :   compressed sparse matrix
+//  _x  :   input vector [size: _N x 1]
+//  _y  :   output vector [size: _M x 1]
+void smatrixb_csr_vmulf(smatrixb_csr _q,
+                        float *      _x,
+                        float *      _y);
+
 
 //
 // MODULE : modem (modulator/demodulator)
@@ -5305,6 +8011,51 @@ void liquid_unpack_soft_bits(unsigned int _sym_in,
                              unsigned int _bps,
                              unsigned char * _soft_bits);
 
+// unpack block of symbols into soft bits
+//  _syms       :   input symbols, values in [0,2^_bps) [size: _n x 1]
+//  _n          :   number of symbols
+//  _bps        :   bits per symbol
+//  _soft_bits  :   soft output bits [size: _n*_bps x 1]
+void liquid_unpack_soft_bits_block(const unsigned int * _syms,
+                                   unsigned int         _n,
+                                   unsigned int         _bps,
+                                   unsigned char *      _soft_bits);
+
+// pack block of soft bits into symbols using hard decisions
+//  _soft_bits  :   soft input bits [size: _n*_bps x 1]
+//  _n          :   number of symbols
+//  _bps        :   bits per symbol
+//  _syms       :   output symbols, values in [0,2^_bps) [size: _n x 1]
+void liquid_pack_soft_bits_block(const unsigned char * _soft_bits,
+                                 unsigned int          _n,
+                                 unsigned int          _bps,
+                                 unsigned int *        _syms);
+
+// pack soft bits into bytes using hard decisions, msb first
+//  _soft_bits  :   soft input bits [size: 8*_n x 1]
+//  _n          :   number of output bytes
+//  _bytes      :   packed output bytes [size: _n x 1]
+void liquid_pack_soft_bytes(const unsigned char * _soft_bits,
+                            unsigned int          _n,
+                            unsigned char *       _bytes);
+
+// unpack bytes into soft bits, msb first
+//  _bytes      :   input bytes [size: _n x 1]
+//  _n          :   number of input bytes
+//  _soft_bits  :   soft output bits [size: 8*_n x 1]
+void liquid_unpack_soft_bytes(const unsigned char * _bytes,
+                              unsigned int          _n,
+                              unsigned char *       _soft_bits);
+
+// scale soft bits about the erasure point, saturating to [0,255] while
+// preserving each hard decision
+//  _soft_bits  :   soft bits [size: _n x 1]
+//  _n          :   number of soft bits
+//  _scale      :   scaling factor, _scale > 0
+void liquid_scale_soft_bits(unsigned char * _soft_bits,
+                            unsigned int    _n,
+                            float           _scale);
+
 
 //
 // Linear modem
@@ -5337,6 +8088,7 @@ MODEM() MODEM(_recreate)(MODEM()           _q,                  \
                                                                 \
 void MODEM(_destroy)(MODEM() _q);                               \
 void MODEM(_print)(  MODEM() _q);                               \
+unsigned long int MODEM(_get_memory_usage)(MODEM() _q);         \
 void MODEM(_reset)(  MODEM() _q);                               \
                                                                 \
 /* generate random symbol                                   */  \
@@ -5373,6 +8125,74 @@ void MODEM(_demodulate_soft)(MODEM()         _q,                \
                              unsigned int  * _s,                \
                              unsigned char * _soft_bits);       \
                                                                 \
+/* modulate block of symbols; the scheme is resolved once   */  \
+/* per block rather than once per symbol                    */  \
+/*  _q  :   modem object                                    */  \
+/*  _s  :   input symbols [size: _n x 1]                    */  \
+/*  _n  :   number of symbols                               */  \
+/*  _y  :   output samples [size: _n x 1]                   */  \
+void MODEM(_modulate_block)(MODEM()              _q,            \
+                            const unsigned int * _s,            \
+                            unsigned int         _n,            \
+                            TC *                 _y);           \
+                                                                \
+/* hard-decision demodulation of block of samples; output   */  \
+/* and internal state are identical to calling              */  \
+/* MODEM(_demodulate)() on each sample in turn              */  \
+/*  _q  :   modem object                                    */  \
+/*  _x  :   input samples [size: _n x 1]                    */  \
+/*  _n  :   number of samples                               */  \
+/*  _s  :   output symbols [size: _n x 1]                   */  \
+void MODEM(_demodulate_block)(MODEM()        _q,                \
+                              const TC *     _x,                \
+                              unsigned int   _n,                \
+                              unsigned int * _s);               \
+                                                                \
+/* soft-decision demodulation of block of samples           */  \
+/*  _q          :   modem object                            */  \
+/*  _x          :   input samples [size: _n x 1]            */  \
+/*  _n          :   number of samples                       */  \
+/*  _s          :   output hard symbols [size: _n x 1]      */  \
+/*  _soft_bits  :   output soft bits [size: _n*bps x 1]     */  \
+void MODEM(_demodulate_soft_block)(MODEM()         _q,          \
+                                   const TC *      _x,          \
+                                   unsigned int    _n,          \
+                                   unsigned int *  _s,          \
+                                   unsigned char * _soft_bits); \
+                                                                \
+/* remove slowly varying carrier phase from block of        */  \
+/* received samples without a feedback loop; the phase is   */  \
+/* estimated over windows of _window samples (M-th power    */  \
+/* for BPSK/QPSK/PSK8, decision-directed otherwise), each   */  \
+/* relative to the previous window, and interpolated        */  \
+/* linearly between window centres. Input should be         */  \
+/* corrected to within the decision region (e.g. from       */  \
+/* pilots); differential schemes are left unchanged.        */  \
+/*  _q      :   modem object                                */  \
+/*  _x      :   samples, corrected in place [size: _n x 1]  */  \
+/*  _n      :   number of samples                           */  \
+/*  _window :   estimation window size, _window > 0         */  \
+void MODEM(_recover_phase_block)(MODEM()      _q,               \
+                                 TC *         _x,               \
+                                 unsigned int _n,               \
+                                 unsigned int _window);         \
+                                                                \
+/* set noise variance of received samples, E{|n|^2}, so    */  \
+/* that soft bits are scaled log-likelihood ratios; e.g.    */  \
+/* powf(10,evm/10) from framesyncstats. Zero restores the   */  \
+/* fixed approximation for the constellation size.          */  \
+/*  _q      :   modem object                                */  \
+/*  _sigma2 :   noise variance, _sigma2 >= 0                */  \
+void MODEM(_set_noise_variance)(MODEM() _q,                     \
+                                T       _sigma2);               \
+                                                                \
+/* set soft bit precision; soft bits keep the full 8-bit    */  \
+/* range but only 2^_nbits levels are used (default: 8)     */  \
+/*  _q      :   modem object                                */  \
+/*  _nbits  :   precision in bits, 4 <= _nbits <= 8         */  \
+void MODEM(_set_soft_precision)(MODEM()      _q,                \
+                                unsigned int _nbits);           \
+                                                                \
 /* get demodulator's estimated transmit sample */               \
 void MODEM(_get_demodulator_sample)(MODEM() _q,                 \
                                     TC *    _x_hat);            \
@@ -5408,6 +8228,16 @@ void gmskmod_modulate(gmskmod _q,
                       unsigned int _sym,
                       liquid_float_complex * _y);
 
+// modulate block of symbols
+//  _q      :   modulator object
+//  _s      :   input symbols [size: _n x 1]
+//  _n      :   number of input symbols
+//  _y      :   output samples [size: _k*_n x 1]
+void gmskmod_modulate_block(gmskmod              _q,
+                            const unsigned int * _s,
+                            unsigned int         _n,
+                            liquid_float_complex * _y);
+
 
 // gmskdem : GMSK demodulator
 typedef struct gmskdem_s * gmskdem;
@@ -5544,6 +8374,20 @@ cpfskdem cpfskdem_create(unsigned int _bps,
                          unsigned int _m,
                          float        _beta,
                          int          _type);
+
+// create cpfskdem object with non-coherent receiver: each symbol is
+// decided by the largest output of a bank of correlators matched to
+// the phase trajectory of each symbol (tones for square pulses, for
+// which a zero-padded FFT is used when the tones fall on its bins and
+// it is cheaper), so no carrier phase recovery is required; cpfskdem_create() selects
+// this receiver for _h > 2/3. Its receive delay is zero. Arguments as
+// for cpfskdem_create().
+cpfskdem cpfskdem_create_noncoherent(unsigned int _bps,
+                                     float        _h,
+                                     unsigned int _k,
+                                     unsigned int _m,
+                                     float        _beta,
+                                     int          _type);
 //cpfskdem cpfskdem_create_msk(unsigned int _k);
 //cpfskdem cpfskdem_create_gmsk(unsigned int _k, float _BT);
 
@@ -5635,6 +8479,15 @@ void fskdem_print(fskdem _q);
 // reset state
 void fskdem_reset(fskdem _q);
 
+// set demodulation method: Goertzel filters evaluating only the 2^_m
+// tone bins (_enable=1) or a full transform per symbol (_enable=0);
+// the cheaper method is selected when the object is created
+int fskdem_set_goertzel(fskdem _q,
+                        int    _enable);
+
+// get demodulation method (1: Goertzel filters, 0: full transform)
+int fskdem_get_goertzel(fskdem _q);
+
 // demodulate symbol, assuming perfect symbol timing
 //  _q      :   fskdem object
 //  _y      :   input sample array [size: _k x 1]
@@ -5664,6 +8517,14 @@ typedef struct FREQDEM(_s) * FREQDEM();                         \
 /*  _kf      :   modulation factor                          */  \
 FREQDEM() FREQDEM(_create)(float _kf);                          \
                                                                 \
+/* create multi-channel freqdem object; _num_channels       */  \
+/* independent signals are demodulated from interleaved     */  \
+/* input by freqdem_demodulate_block()                      */  \
+/*  _kf             :   modulation factor                   */  \
+/*  _num_channels   :   number of channels                  */  \
+FREQDEM() FREQDEM(_create_multi)(float        _kf,              \
+                                 unsigned int _num_channels);   \
+                                                                \
 /* destroy freqdem object                                   */  \
 void FREQDEM(_destroy)(FREQDEM() _q);                           \
                                                                 \
@@ -5673,6 +8534,14 @@ void FREQDEM(_print)(FREQDEM() _q);                             \
 /* reset state                                              */  \
 void FREQDEM(_reset)(FREQDEM() _q);                             \
                                                                 \
+/* set arctangent approximation order: 0 computes the      */  \
+/* phase exactly (default); odd orders 3 through 13 use a   */  \
+/* minimax polynomial with max. phase error of about        */  \
+/* 5e-3 (3), 6e-4 (5), 8e-5 (7), 1e-5 (9), 2e-6 (11) and    */  \
+/* 2.5e-7 (13) radians and enable SIMD block processing     */  \
+void FREQDEM(_set_accuracy)(FREQDEM()    _q,                    \
+                            unsigned int _order);               \
+                                                                \
 /* demodulate sample                                        */  \
 /*  _q      :   frequency modulator object                  */  \
 /*  _r      :   received signal r(t)                        */  \
@@ -5681,11 +8550,13 @@ void FREQDEM(_demodulate)(FREQDEM() _q,                         \
                           TC        _r,                         \
                           T *       _m);                        \
                                                                 \
-/* demodulate block of samples                              */  \
+/* demodulate block of samples; for multi-channel objects  */  \
+/* the input and output are interleaved by channel, i.e.    */  \
+/* _r[i*num_channels + c] is sample i of channel c          */  \
 /*  _q      :   frequency demodulator object                */  \
-/*  _r      :   received signal r(t) [size: _n x 1]         */  \
-/*  _n      :   number of input, output samples             */  \
-/*  _m      :   message signal m(t), [size: _n x 1]         */  \
+/*  _r      :   received signal r(t) [size: _n*C x 1]       */  \
+/*  _n      :   number of input, output samples per channel */  \
+/*  _m      :   message signal m(t), [size: _n*C x 1]       */  \
 void FREQDEM(_demodulate_block)(FREQDEM()    _q,                \
                                 TC *         _r,                \
                                 unsigned int _n,                \
@@ -5729,6 +8600,12 @@ void ampmodem_modulate(ampmodem _fm,
                        float _x,
                        liquid_float_complex *_y);
 
+// modulate block of samples with block Hilbert transform and mixer;
+// equivalent to ampmodem_modulate() on each sample
+//  _q      :   ampmodem object
+//  _m      :   message signal m(t), [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _s      :   complex baseband signal s(t) [size: _n x 1]
 void ampmodem_modulate_block(ampmodem _q,
                              float * _m,
                              unsigned int _n,
@@ -5739,6 +8616,13 @@ void ampmodem_demodulate(ampmodem _fm,
                          liquid_float_complex _y,
                          float *_x);
 
+// demodulate block of samples; coherent (suppressed-carrier DSB)
+// demodulation mixes with the block mixer and updates the carrier loop
+// once per sub-block, otherwise equivalent to ampmodem_demodulate()
+//  _q      :   ampmodem object
+//  _r      :   received signal r(t) [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _m      :   message signal m(t), [size: _n x 1]
 void ampmodem_demodulate_block(ampmodem _q,
                                liquid_float_complex * _r,
                                unsigned int _n,
@@ -5823,6 +8707,17 @@ void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,              \
                                     TI *       _x,              \
                                     TO *       _y);             \
                                                                 \
+/* execute filterbank as synthesizer on _n blocks of        */  \
+/* samples, equivalent to _n calls to synthesizer_execute() */  \
+/*  _q      : filterbank channelizer object                 */  \
+/*  _x      : channelized input, [size: _n*num_channels]    */  \
+/*  _n      : number of blocks                              */  \
+/*  _y      : output time series, [size: _n*num_channels]   */  \
+void FIRPFBCH(_synthesizer_execute_block)(FIRPFBCH()   _q,      \
+                                          TI *         _x,      \
+                                          unsigned int _n,      \
+                                          TO *         _y);     \
+                                                                \
 /* execute filterbank as analyzer on block of samples       */  \
 /*  _q      : filterbank channelizer object                 */  \
 /*  _x      : input time series, [size: num_channels x 1]   */  \
@@ -5830,6 +8725,17 @@ void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,              \
 void FIRPFBCH(_analyzer_execute)(FIRPFBCH() _q,                 \
                                  TI *       _x,                 \
                                  TO *       _y);                \
+                                                                \
+/* execute filterbank as analyzer on _n blocks of samples,  */  \
+/* equivalent to _n calls to analyzer_execute()             */  \
+/*  _q      : filterbank channelizer object                 */  \
+/*  _x      : input time series, [size: _n*num_channels]    */  \
+/*  _n      : number of blocks                              */  \
+/*  _y      : channelized output, [size: _n*num_channels]   */  \
+void FIRPFBCH(_analyzer_execute_block)(FIRPFBCH()   _q,         \
+                                       TI *         _x,         \
+                                       unsigned int _n,         \
+                                       TO *         _y);        \
 
 
 LIQUID_FIRPFBCH_DEFINE_API(FIRPFBCH_MANGLE_CRCF,
@@ -5887,6 +8793,30 @@ void FIRPFBCH2(_reset)(FIRPFBCH2() _q);                         \
 /* print firpfbch2 object internals                         */  \
 void FIRPFBCH2(_print)(FIRPFBCH2() _q);                         \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int FIRPFBCH2(_get_memory_usage)(FIRPFBCH2() _q); \
+                                                                \
+/* get channelizer type (LIQUID_ANALYZER/LIQUID_SYNTHESIZER) */ \
+int FIRPFBCH2(_get_type)(FIRPFBCH2() _q);                       \
+                                                                \
+/* get number of channels, M                                */  \
+unsigned int FIRPFBCH2(_get_M)(FIRPFBCH2() _q);                 \
+                                                                \
+/* set active channel subset (analyzer only); inactive      */  \
+/* channel outputs are zero and, when few channels are      */  \
+/* active, only the active outputs are computed             */  \
+/*  _q      :   firpfbch2 object                            */  \
+/*  _mask   :   non-zero for active channels [size: M x 1]  */  \
+/*              (NULL: all channels active, default)        */  \
+void FIRPFBCH2(_set_channel_mask)(FIRPFBCH2()     _q,           \
+                                  unsigned char * _mask);       \
+                                                                \
+/* enable/disable half-precision storage of the polyphase   */  \
+/* sub-filter coefficients; inputs and accumulation remain  */  \
+/* single precision                                         */  \
+void FIRPFBCH2(_set_coeff_fp16)(FIRPFBCH2() _q,                 \
+                                int         _enable);           \
+                                                                \
 /* execute filterbank channelizer                           */  \
 /* LIQUID_ANALYZER:     input: M/2, output: M               */  \
 /* LIQUID_SYNTHESIZER:  input: M,   output: M/2             */  \
@@ -5895,6 +8825,18 @@ void FIRPFBCH2(_print)(FIRPFBCH2() _q);                         \
 void FIRPFBCH2(_execute)(FIRPFBCH2() _q,                        \
                          TI *        _x,                        \
                          TO *        _y);                       \
+                                                                \
+/* execute filterbank channelizer on block of transforms,   */  \
+/* equivalent to _n successive calls to execute()           */  \
+/* LIQUID_ANALYZER:     input: _n*M/2, output: _n*M         */  \
+/* LIQUID_SYNTHESIZER:  input: _n*M,   output: _n*M/2       */  \
+/*  _x      :   channelizer input                           */  \
+/*  _n      :   number of transforms                        */  \
+/*  _y      :   channelizer output                          */  \
+void FIRPFBCH2(_execute_block)(FIRPFBCH2()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
 
 
 LIQUID_FIRPFBCH2_DEFINE_API(FIRPFBCH2_MANGLE_CRCF,
@@ -5902,6 +8844,61 @@ LIQUID_FIRPFBCH2_DEFINE_API(FIRPFBCH2_MANGLE_CRCF,
                             float,
                             liquid_float_complex)
 
+//
+// multichannel receiver: distributes channelizer output blocks to
+// per-channel processing callbacks (e.g. symtrack or flexframesync
+// objects) executed across a pool of worker threads; each channel is
+// fed through a lock-free single-producer/single-consumer ring buffer
+// and is drained by one worker at a time, so callbacks for a channel
+// are invoked in order and never concurrently, while callbacks for
+// different channels may run concurrently
+//
+
+typedef struct mcrx_s * mcrx;
+
+// per-channel processing callback
+//  _channel    :   channel index
+//  _x          :   channel samples, in order [size: _n x 1]
+//  _n          :   number of samples
+//  _userdata   :   per-channel user data
+typedef int (*mcrx_callback)(unsigned int           _channel,
+                             liquid_float_complex * _x,
+                             unsigned int           _n,
+                             void *                 _userdata);
+
+// create multichannel receiver
+//  _num_channels   :   number of channels, e.g. channelizer size M
+//  _num_threads    :   number of worker threads; 0 executes callbacks
+//                      in the calling thread
+//  _ring_len       :   per-channel ring buffer length (rounded up to power of 2)
+//  _callback       :   per-channel processing callback
+//  _userdata       :   per-channel user data passed to callback [size: _num_channels x 1], or NULL
+mcrx mcrx_create(unsigned int  _num_channels,
+                 unsigned int  _num_threads,
+                 unsigned int  _ring_len,
+                 mcrx_callback _callback,
+                 void **       _userdata);
+
+// destroy multichannel receiver, processing any samples still queued
+void mcrx_destroy(mcrx _q);
+void mcrx_print  (mcrx _q);
+
+// get number of channels, worker threads
+unsigned int mcrx_get_num_channels(mcrx _q);
+unsigned int mcrx_get_num_threads (mcrx _q);
+
+// push block of channelizer outputs to the per-channel pipelines,
+// blocking only while a channel's ring buffer is full
+//  _q      :   multichannel receiver
+//  _y      :   channelizer output, interleaved [size: _n x num_channels]
+//  _n      :   number of transforms
+void mcrx_execute(mcrx                   _q,
+                  liquid_float_complex * _y,
+                  unsigned int           _n);
+
+// block until every queued sample has been processed
+void mcrx_flush(mcrx _q);
+
 
 
 #define OFDMFRAME_SCTYPE_NULL   0
@@ -5976,6 +8973,33 @@ void ofdmframegen_writesymbol(ofdmframegen _q,
 void ofdmframegen_writetail(ofdmframegen _q,
                             liquid_float_complex * _x);
 
+// create OFDM framing generator object producing real passband samples
+// directly from a Hermitian-symmetric transform of length _D*_M, with
+// the subcarriers centered at _fc; equivalent to interpolating the
+// baseband output by _D, mixing up to _fc and taking the real part
+//  _M          :   number of subcarriers, >10 typical
+//  _cp_len     :   cyclic prefix length (baseband samples)
+//  _taper_len  :   taper length (baseband samples)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _D          :   real samples per baseband sample, _D >= 2
+//  _fc         :   center frequency relative to real sample rate, (0,0.5)
+ofdmframegen ofdmframegen_create_passband(unsigned int    _M,
+                                          unsigned int    _cp_len,
+                                          unsigned int    _taper_len,
+                                          unsigned char * _p,
+                                          unsigned int    _D,
+                                          float           _fc);
+
+// write real passband symbols; each writes _D*(_M+_cp_len) samples,
+// except the tail which writes _D*_taper_len
+void ofdmframegen_write_S0a_real(ofdmframegen _q, float * _y);
+void ofdmframegen_write_S0b_real(ofdmframegen _q, float * _y);
+void ofdmframegen_write_S1_real( ofdmframegen _q, float * _y);
+void ofdmframegen_writesymbol_real(ofdmframegen           _q,
+                                   liquid_float_complex * _x,
+                                   float *                _y);
+void ofdmframegen_writetail_real(ofdmframegen _q, float * _y);
+
 // 
 // OFDM frame (symbol) synchronizer
 //
@@ -5983,6 +9007,18 @@ typedef int (*ofdmframesync_callback)(liquid_float_complex * _y,
                                       unsigned char * _p,
                                       unsigned int _M,
                                       void * _userdata);
+
+// symbol-batch callback (see ofdmframesync_set_batch())
+//  _Y          :   equalized symbols, row-major [size: _num_symbols x _M]
+//  _num_symbols:   number of OFDM symbols in batch
+//  _p          :   subcarrier allocation, [size: _M x 1]
+//  _M          :   number of subcarriers
+//  _userdata   :   user-defined data pointer
+typedef int (*ofdmframesync_batch_callback)(liquid_float_complex * _Y,
+                                            unsigned int           _num_symbols,
+                                            unsigned char *        _p,
+                                            unsigned int           _M,
+                                            void *                 _userdata);
 typedef struct ofdmframesync_s * ofdmframesync;
 
 // create OFDM framing synchronizer object
@@ -6000,15 +9036,97 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
                                    void *                 _userdata);
 void ofdmframesync_destroy(ofdmframesync _q);
 void ofdmframesync_print(ofdmframesync _q);
+unsigned long int ofdmframesync_get_memory_usage(ofdmframesync _q);
 void ofdmframesync_reset(ofdmframesync _q);
 void ofdmframesync_execute(ofdmframesync _q,
                            liquid_float_complex * _x,
                            unsigned int _n);
 
+// create OFDM framing synchronizer object for real passband samples
+// (see ofdmframegen_create_passband()); carrier offset is not
+// corrected, residual phase is tracked with pilots
+//  _M          :   number of subcarriers, >10 typical
+//  _cp_len     :   cyclic prefix length (baseband samples)
+//  _taper_len  :   taper length (baseband samples)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _D          :   real samples per baseband sample, _D >= 2
+//  _fc         :   center frequency relative to real sample rate, (0,0.5)
+//  _callback   :   user-defined callback function
+//  _userdata   :   user-defined data pointer
+ofdmframesync ofdmframesync_create_passband(unsigned int           _M,
+                                            unsigned int           _cp_len,
+                                            unsigned int           _taper_len,
+                                            unsigned char *        _p,
+                                            unsigned int           _D,
+                                            float                  _fc,
+                                            ofdmframesync_callback _callback,
+                                            void *                 _userdata);
+
+// execute synchronizer on real passband samples
+void ofdmframesync_execute_real(ofdmframesync _q,
+                                float *       _x,
+                                unsigned int  _n);
+
 // query methods
 float ofdmframesync_get_rssi(ofdmframesync _q); // received signal strength indication
 float ofdmframesync_get_cfo(ofdmframesync _q);  // carrier offset estimate
 
+// set decision-directed subcarrier gain tracking
+//  _q      :   synchronizer object
+//  _mu     :   tracking gain, 0 <= _mu < 1 (default: 0, disabled)
+//  _ms     :   data modulation scheme (LIQUID_MODEM_UNKNOWN: pilots only)
+void ofdmframesync_set_eq_tracking(ofdmframesync     _q,
+                                   float             _mu,
+                                   modulation_scheme _ms);
+
+// set running-autocorrelation (Schmidl-Cox) PLCP seek: the transform-
+// based detector is only evaluated while the normalized lag-M/2
+// autocorrelation of the input exceeds _threshold
+//  _q          :   synchronizer object
+//  _threshold  :   metric threshold, 0 <= _threshold < 1, 0.5 typical
+//                  (default: 0, detector evaluated every M samples)
+void ofdmframesync_set_seek_autocorr(ofdmframesync _q,
+                                     float         _threshold);
+
+// squelch: when enabled, PLCP detection is skipped while the input
+// level stays within the squelch threshold [dB] of an adaptive noise
+// floor estimate, the median of block levels seen while seeking
+// (disabled by default, threshold 2 dB)
+void  ofdmframesync_squelch_enable(ofdmframesync _q);
+void  ofdmframesync_squelch_disable(ofdmframesync _q);
+int   ofdmframesync_squelch_is_enabled(ofdmframesync _q);
+void  ofdmframesync_squelch_set_threshold(ofdmframesync _q,
+                                          float         _threshold);
+float ofdmframesync_squelch_get_threshold(ofdmframesync _q);
+
+// get squelch noise floor estimate [dB]
+float ofdmframesync_squelch_get_noise_floor(ofdmframesync _q);
+
+// set symbol-batch callback: equalized symbols are accumulated into a
+// contiguous K x M matrix and passed to _callback, in place of the
+// per-symbol callback, each time the batch length is reached
+//  _q          :   synchronizer object
+//  _K          :   maximum batch size (0: per-symbol callback, default)
+//  _callback   :   batch callback function
+void ofdmframesync_set_batch(ofdmframesync                _q,
+                             unsigned int                 _K,
+                             ofdmframesync_batch_callback _callback);
+
+// set number of symbols in next batch (default: K), e.g. from within
+// the batch callback to align batches with frame sections
+//  _q          :   synchronizer object
+//  _n          :   batch length, 1 <= _n <= K
+void ofdmframesync_set_batch_len(ofdmframesync _q,
+                                 unsigned int  _n);
+
+// discard the next _num_symbols OFDM symbols without transforming
+// them, then reset to seek the next frame, e.g. from within the
+// callback to skip the remainder of a frame
+//  _q              :   synchronizer object
+//  _num_symbols    :   number of symbols to discard
+void ofdmframesync_skip_symbols(ofdmframesync _q,
+                                unsigned int  _num_symbols);
+
 // debugging
 void ofdmframesync_debug_enable(ofdmframesync _q);
 void ofdmframesync_debug_disable(ofdmframesync _q);
@@ -6020,11 +9138,14 @@ void ofdmframesync_debug_print(ofdmframesync _q, const char * _filename);
 //
 
 // oscillator type
-//  LIQUID_NCO  :   numerically-controlled oscillator (fast)
-//  LIQUID_VCO  :   "voltage"-controlled oscillator (precise)
+//  LIQUID_NCO          :   numerically-controlled oscillator (fast)
+//  LIQUID_VCO          :   "voltage"-controlled oscillator (precise)
+//  LIQUID_NCO_INTERP   :   interpolated table with 32-bit phase
+//                          accumulator (fast and precise)
 typedef enum {
     LIQUID_NCO=0,
-    LIQUID_VCO
+    LIQUID_VCO,
+    LIQUID_NCO_INTERP
 } liquid_ncotype;
 
 #define NCO_MANGLE_FLOAT(name)  LIQUID_CONCAT(nco_crcf, name)
@@ -6037,9 +9158,18 @@ typedef enum {
 typedef struct NCO(_s) * NCO();                                 \
                                                                 \
 NCO() NCO(_create)(liquid_ncotype _type);                       \
+                                                                \
+/* create interpolated-table oscillator (type           */      \
+/* LIQUID_NCO_INTERP) with sine table of 2^_table_bits  */      \
+/* entries, _table_bits in [4,16]; LIQUID_NCO_INTERP    */      \
+/* passed to create() uses 2^10 entries                 */      \
+NCO() NCO(_create_interp)(unsigned int _table_bits);            \
 void NCO(_destroy)(NCO() _q);                                   \
 void NCO(_print)(NCO() _q);                                     \
                                                                 \
+/* get memory footprint of object and its buffers [bytes]   */  \
+unsigned long int NCO(_get_memory_usage)(NCO() _q);             \
+                                                                \
 /* set phase/frequency to zero, reset pll filter        */      \
 void NCO(_reset)(NCO() _q);                                     \
                                                                 \
@@ -6060,10 +9190,20 @@ T NCO(_cos)(NCO() _q);                                          \
 void NCO(_sincos)(NCO() _q, T* _s, T* _c);                      \
 void NCO(_cexpf)(NCO() _q, TC * _y);                            \
                                                                 \
+/* compute complex exponential for _n samples, stepping */      \
+/* the phase after each                                 */      \
+void NCO(_cexpf_block)(NCO() _q, TC * _y, unsigned int _n);     \
+                                                                \
 /* pll : phase-locked loop                              */      \
 void NCO(_pll_set_bandwidth)(NCO() _q, T _bandwidth);           \
 void NCO(_pll_step)(NCO() _q, T _dphi);                         \
                                                                 \
+/* advance pll once for a block of _n samples, with the */      \
+/* phase error _dphi averaged over the block: applies   */      \
+/* the gains of _n single steps at once, with the phase */      \
+/* gain limited to 1/2 to keep the loop stable          */      \
+void NCO(_pll_step_block)(NCO() _q, T _dphi, unsigned int _n);  \
+                                                                \
 /* Rotate input sample up by NCO angle (no stepping)    */      \
 void NCO(_mix_up)(NCO() _q, TC _x, TC *_y);                     \
                                                                 \
@@ -6094,6 +9234,69 @@ void NCO(_mix_block_down)(NCO() _q,                             \
 LIQUID_NCO_DEFINE_API(NCO_MANGLE_FLOAT, float, liquid_float_complex)
 
 
+//
+// block carrier-tracking loop: mixes with the block mixer and
+// updates the second-order loop filter once per sub-block from the
+// phase error estimated over that sub-block
+//
+typedef struct blockpll_cccf_s * blockpll_cccf;
+
+// create block carrier-tracking loop
+//  _ms         :   modulation scheme (decision-directed detector),
+//                  differential schemes are not supported
+//  _block_len  :   sub-block length (samples per loop update)
+blockpll_cccf blockpll_cccf_create(int          _ms,
+                                   unsigned int _block_len);
+void blockpll_cccf_destroy(blockpll_cccf _q);
+void blockpll_cccf_reset(  blockpll_cccf _q);
+void blockpll_cccf_print(  blockpll_cccf _q);
+
+// set loop bandwidth (per sample, as nco_crcf_pll_set_bandwidth)
+void blockpll_cccf_set_bandwidth(blockpll_cccf _q,
+                                 float         _bw);
+
+// set/get oscillator frequency, phase
+void  blockpll_cccf_set_frequency(blockpll_cccf _q, float _dtheta);
+void  blockpll_cccf_set_phase    (blockpll_cccf _q, float _theta);
+float blockpll_cccf_get_frequency(blockpll_cccf _q);
+float blockpll_cccf_get_phase    (blockpll_cccf _q);
+
+// get phase error estimate of last sub-block
+float blockpll_cccf_get_phase_error(blockpll_cccf _q);
+
+// track carrier over block of samples, decision-directed
+//  _q      :   loop object
+//  _x      :   input samples [size: _n x 1]
+//  _y      :   output samples, may be _x [size: _n x 1]
+//  _n      :   number of samples
+void blockpll_cccf_execute(blockpll_cccf          _q,
+                           liquid_float_complex * _x,
+                           liquid_float_complex * _y,
+                           unsigned int           _n);
+
+// track carrier over block of samples with known (pilot) symbols
+//  _q      :   loop object
+//  _x      :   input samples [size: _n x 1]
+//  _pilots :   transmitted symbols [size: _n x 1]
+//  _y      :   output samples, may be _x [size: _n x 1]
+//  _n      :   number of samples
+void blockpll_cccf_execute_pilots(blockpll_cccf          _q,
+                                  liquid_float_complex * _x,
+                                  liquid_float_complex * _pilots,
+                                  liquid_float_complex * _y,
+                                  unsigned int           _n);
+
+// split loop for receivers with processing between mixer and
+// detector (e.g. an equalizer): mix block down without updating the
+// loop, then update it with a phase error averaged over _n samples
+void blockpll_cccf_mix_down(blockpll_cccf          _q,
+                            liquid_float_complex * _x,
+                            liquid_float_complex * _y,
+                            unsigned int           _n);
+void blockpll_cccf_update(blockpll_cccf _q,
+                          float         _dphi,
+                          unsigned int  _n);
+
 // nco utilities
 
 // unwrap phase of array (basic)
@@ -6113,6 +9316,30 @@ typedef float (*utility_function)(void *       _userdata,
                                   float *      _v,
                                   unsigned int _n);
 
+// gradient function pointer definition; computes the gradient of the
+// utility at _v, replacing finite-difference estimates
+//  _userdata   :   user-defined data structure (convenience)
+//  _v          :   input vector [size: _n x 1]
+//  _n          :   input vector size
+//  _gradient   :   output gradient [size: _n x 1]
+typedef void (*gradient_function)(void *       _userdata,
+                                  float *      _v,
+                                  unsigned int _n,
+                                  float *      _gradient);
+
+// batched utility function pointer definition; evaluates the utility at
+// _k independent points in a single call (e.g. in parallel or vectorized)
+//  _userdata   :   user-defined data structure (convenience)
+//  _v          :   input vectors, row-major [size: _k x _n]
+//  _n          :   input vector size
+//  _u          :   output utilities [size: _k x 1]
+//  _k          :   number of points
+typedef void (*utility_function_batch)(void *       _userdata,
+                                       float *      _v,
+                                       unsigned int _n,
+                                       float *      _u,
+                                       unsigned int _k);
+
 // n-dimensional Rosenbrock utility function (minimum at _v = {1,1,1...}
 //  _userdata   :   user-defined data structure (convenience)
 //  _v          :   input vector [size: _n x 1]
@@ -6173,6 +9400,15 @@ void gradsearch_destroy(gradsearch _q);
 // Prints current status of search
 void gradsearch_print(gradsearch _q);
 
+// Set analytic gradient callback (NULL reverts to finite differences)
+void gradsearch_set_gradient(gradsearch        _q,
+                             gradient_function _gradient);
+
+// Set batched utility callback used to evaluate the finite-difference
+// gradient points in a single call (NULL reverts to serial evaluation)
+void gradsearch_set_utility_batch(gradsearch             _q,
+                                  utility_function_batch _utility);
+
 // Iterate once
 float gradsearch_step(gradsearch _q);
 
@@ -6203,6 +9439,16 @@ void qnsearch_destroy(qnsearch _g);
 // Prints current status of search
 void qnsearch_print(qnsearch _g);
 
+// Set analytic gradient callback (NULL reverts to finite differences)
+void qnsearch_set_gradient(qnsearch          _g,
+                           gradient_function _gradient);
+
+// Set batched utility callback used to evaluate the finite-difference
+// gradient and Hessian points in a single call (NULL reverts to serial
+// evaluation)
+void qnsearch_set_utility_batch(qnsearch               _g,
+                                utility_function_batch _utility);
+
 // Resets internal state
 void qnsearch_reset(qnsearch _g);
 
@@ -6284,6 +9530,16 @@ typedef struct gasearch_s * gasearch;
 
 typedef float (*gasearch_utility)(void * _userdata, chromosome _c);
 
+// batched utility: compute fitness of _n chromosomes in one call
+//  _userdata   :   user data, void pointer passed to callback
+//  _c          :   chromosomes to evaluate [size: _n x 1]
+//  _u          :   output utility of each chromosome [size: _n x 1]
+//  _n          :   number of chromosomes
+typedef void (*gasearch_utility_batch)(void *       _userdata,
+                                       chromosome * _c,
+                                       float *      _u,
+                                       unsigned int _n);
+
 // Create a simple gasearch object; parameters are specified internally
 //  _utility            :   chromosome fitness utility function
 //  _userdata           :   user data, void pointer passed to _get_utility() callback
@@ -6319,6 +9575,19 @@ void gasearch_print(gasearch _q);
 void gasearch_set_mutation_rate(gasearch _q,
                                 float _mutation_rate);
 
+// set batched utility callback used to evaluate the population in
+// place of the per-chromosome utility (NULL reverts to per-chromosome)
+void gasearch_set_utility_batch(gasearch               _q,
+                                gasearch_utility_batch _utility);
+
+// set number of threads evaluating the population, including the
+// caller (default 1). With more than one thread the utility callback
+// (or batched callback, on disjoint slices of the population) is
+// invoked concurrently and must be safe to call that way with the
+// same _userdata.
+void gasearch_set_num_threads(gasearch     _q,
+                              unsigned int _num_threads);
+
 // set population/selection size
 //  _q                  :   ga search object
 //  _population_size    :   new population size (number of chromosomes)
@@ -6356,20 +9625,46 @@ float expand_mulaw(float _x, float _mu);
 void compress_cf_mulaw(liquid_float_complex _x, float _mu, liquid_float_complex * _y);
 void expand_cf_mulaw(liquid_float_complex _y, float _mu, liquid_float_complex * _x);
 
-//float compress_alaw(float _x, float _a);
-//float expand_alaw(float _x, float _a);
+float compress_alaw(float _x, float _a);
+float expand_alaw(float _y, float _a);
+
+// compress/expand block of samples; the logarithm and exponential
+// are approximated (relative error below 1e-6) with branch-free
+// kernels so that samples are processed in parallel
+//  _x, _y  :   input samples [size: _n x 1]
+//  _n      :   number of samples
+//  _mu, _a :   companding parameter, _mu > 0, _a >= 1
+//  _y, _x  :   output samples [size: _n x 1], may equal input
+void compress_mulaw_block(const float * _x, unsigned int _n, float _mu, float * _y);
+void expand_mulaw_block  (const float * _y, unsigned int _n, float _mu, float * _x);
+void compress_alaw_block (const float * _x, unsigned int _n, float _a,  float * _y);
+void expand_alaw_block   (const float * _y, unsigned int _n, float _a,  float * _x);
 
 // inline quantizer: 'analog' signal in [-1, 1]
 unsigned int quantize_adc(float _x, unsigned int _num_bits);
 float quantize_dac(unsigned int _s, unsigned int _num_bits);
 
+// block quantizer
+//  _x          :   input/output values [size: _n x 1]
+//  _n          :   number of values
+//  _num_bits   :   number of bits per sample
+//  _s          :   output/input samples [size: _n x 1]
+void quantize_adc_block(const float *  _x,
+                        unsigned int   _n,
+                        unsigned int   _num_bits,
+                        unsigned int * _s);
+void quantize_dac_block(const unsigned int * _s,
+                        unsigned int         _n,
+                        unsigned int         _num_bits,
+                        float *              _x);
+
 // structured quantizer
 
 typedef enum {
     LIQUID_COMPANDER_NONE=0,
     LIQUID_COMPANDER_LINEAR,
-    LIQUID_COMPANDER_MULAW,
-    LIQUID_COMPANDER_ALAW
+    LIQUID_COMPANDER_MULAW,     // mu = 255
+    LIQUID_COMPANDER_ALAW       // A = 87.6
 } liquid_compander_type;
 
 #define QUANTIZER_MANGLE_FLOAT(name)    LIQUID_CONCAT(quantizerf,  name)
@@ -6378,8 +9673,15 @@ typedef enum {
 // large macro
 //   QUANTIZER  : name-mangling macro
 //   T          : data type
-#define LIQUID_QUANTIZER_DEFINE_API(QUANTIZER,T)                \
+//   TQ         : fixed-point data type
+#define LIQUID_QUANTIZER_DEFINE_API(QUANTIZER,T,TQ)             \
 typedef struct QUANTIZER(_s) * QUANTIZER();                     \
+                                                                \
+/* create quantizer; complex samples carry the in-phase code */ \
+/* in the upper and the quadrature code in the lower bits     */ \
+/*  _ctype      :   compander type                          */  \
+/*  _range      :   maximum absolute input, _range > 0      */  \
+/*  _num_bits   :   bits per (real) component               */  \
 QUANTIZER() QUANTIZER(_create)(liquid_compander_type _ctype,    \
                                float _range,                    \
                                unsigned int _num_bits);         \
@@ -6390,10 +9692,31 @@ void QUANTIZER(_execute_adc)(QUANTIZER() _q,                    \
                              unsigned int * _sample);           \
 void QUANTIZER(_execute_dac)(QUANTIZER() _q,                    \
                              unsigned int _sample,              \
-                             T * _x);
-
-LIQUID_QUANTIZER_DEFINE_API(QUANTIZER_MANGLE_FLOAT,  float)
-LIQUID_QUANTIZER_DEFINE_API(QUANTIZER_MANGLE_CFLOAT, liquid_float_complex)
+                             T * _x);                           \
+                                                                \
+/* quantize/reconstruct block of samples                    */  \
+void QUANTIZER(_execute_adc_block)(QUANTIZER()    _q,           \
+                                   T *            _x,           \
+                                   unsigned int   _n,           \
+                                   unsigned int * _sample);     \
+void QUANTIZER(_execute_dac_block)(QUANTIZER()    _q,           \
+                                   unsigned int * _sample,      \
+                                   unsigned int   _n,           \
+                                   T *            _x);          \
+                                                                \
+/* quantize/reconstruct block of Q15 samples, full scale    */  \
+/* corresponding to the range of the quantizer              */  \
+void QUANTIZER(_execute_adc_block_q16)(QUANTIZER()    _q,       \
+                                       TQ *           _x,       \
+                                       unsigned int   _n,       \
+                                       unsigned int * _sample); \
+void QUANTIZER(_execute_dac_block_q16)(QUANTIZER()    _q,       \
+                                       unsigned int * _sample,  \
+                                       unsigned int   _n,       \
+                                       TQ *           _x);      \
+
+LIQUID_QUANTIZER_DEFINE_API(QUANTIZER_MANGLE_FLOAT,  float,                q16_t)
+LIQUID_QUANTIZER_DEFINE_API(QUANTIZER_MANGLE_CFLOAT, liquid_float_complex, cq16_t)
 
 
 //
@@ -6401,11 +9724,29 @@ LIQUID_QUANTIZER_DEFINE_API(QUANTIZER_MANGLE_CFLOAT, liquid_float_complex)
 //
 
 
-// Uniform random number generator, (0,1]
+// Uniform random number generator, (0,1]. randf() and the generators
+// built on it (randnf(), crandnf(), randexpf(), ...) draw from a
+// generator private to the calling thread, so threads neither contend
+// nor disturb each other's sequences. A thread which never calls
+// randf_seed() is seeded by the order in which threads first draw.
 float randf();
 float randf_pdf(float _x);
 float randf_cdf(float _x);
 
+// seed the calling thread's generator; objects with internal noise
+// (e.g. channel_cccf, msourcecf) seed their own generators from it
+// when created. srand() has no effect on these generators: without a
+// call to randf_seed() a program draws the same sequence on every run,
+// so use randf_seed(time(NULL)) where srand(time(NULL)) was used before.
+void randf_seed(uint64_t _seed);
+
+// Reentrant uniform random number generator, (0,1], with state held
+// by the caller (e.g. one independent stream per thread)
+//  _state  :   generator state, updated in place
+//  _seed   :   seed value (scrambled, so consecutive seeds are fine)
+float randf_r(uint64_t * _state);
+void  randf_seed_r(uint64_t * _state, uint64_t _seed);
+
 // Gauss random number generator, N(0,1)
 //   f(x) = 1/sqrt(2*pi*sigma^2) * exp{-(x-eta)^2/(2*sigma^2)}
 //
@@ -6420,6 +9761,22 @@ void cawgn(liquid_float_complex *_x, float _nstd);
 float randnf_pdf(float _x, float _eta, float _sig);
 float randnf_cdf(float _x, float _eta, float _sig);
 
+// Reentrant Gauss random number generator, N(0,1) (Ziggurat method)
+//  _state  :   generator state (see randf_r())
+float randnf_r(uint64_t * _state);
+
+// Gauss random number block generators, N(0,1); randnf_block() uses
+// both outputs of each Box-Muller transform, randnf_block_r() the
+// Ziggurat method. Complex blocks have real and imaginary parts each
+// N(0,1), as with crandnf().
+//  _state  :   reentrant generator state (see randf_r())
+//  _y      :   output array [size: _n x 1]
+//  _n      :   number of samples
+void randnf_block(float * _y, unsigned int _n);
+void randnf_block_r(uint64_t * _state, float * _y, unsigned int _n);
+void crandnf_block(liquid_float_complex * _y, unsigned int _n);
+void crandnf_block_r(uint64_t * _state, liquid_float_complex * _y, unsigned int _n);
+
 // Exponential
 //  f(x) = lambda exp{ -lambda x }
 // where
@@ -6594,6 +9951,15 @@ unsigned int msequence_advance(msequence _ms);
 unsigned int msequence_generate_symbol(msequence _ms,
                                        unsigned int _bps);
 
+// generate _n bytes of the sequence, most-significant bit first;
+// equivalent to _n calls to msequence_generate_symbol(_ms,8)
+//  _ms     :   m-sequence object
+//  _buf    :   output buffer, [size: _n x 1]
+//  _n      :   number of bytes to generate
+void msequence_generate_block(msequence       _ms,
+                              unsigned char * _buf,
+                              unsigned int    _n);
+
 // reset msequence shift register to original state, typically '1'
 void msequence_reset(msequence _ms);
 
@@ -6642,6 +10008,36 @@ void liquid_unpack_array(unsigned char * _src,
                          unsigned int _b,
                          unsigned char * _sym_out);
 
+// pack block of symbols into binary array, equivalent to calling
+// liquid_pack_array() for each symbol at bit indices _k, _k+_b, ...
+//  _src        :   destination array [size: _n x 1]
+//  _n          :   destination array length
+//  _k          :   bit index of first symbol
+//  _b          :   number of bits per symbol, _b <= 8
+//  _syms       :   input symbols [size: _num_symbols x 1]
+//  _num_symbols:   number of input symbols
+void liquid_pack_array_block(unsigned char * _src,
+                             unsigned int    _n,
+                             unsigned int    _k,
+                             unsigned int    _b,
+                             unsigned int *  _syms,
+                             unsigned int    _num_symbols);
+
+// unpack block of symbols from binary array, equivalent to calling
+// liquid_unpack_array() for each symbol at bit indices _k, _k+_b, ...
+//  _src        :   source array [size: _n x 1]
+//  _n          :   source array length
+//  _k          :   bit index of first symbol
+//  _b          :   number of bits per symbol, _b <= 8
+//  _syms       :   output symbols [size: _num_symbols x 1]
+//  _num_symbols:   number of output symbols
+void liquid_unpack_array_block(unsigned char * _src,
+                               unsigned int    _n,
+                               unsigned int    _k,
+                               unsigned int    _b,
+                               unsigned int *  _syms,
+                               unsigned int    _num_symbols);
+
 // pack one-bit symbols into bytes (8-bit symbols)
 //  _sym_in             :   input symbols array [size: _sym_in_len x 1]
 //  _sym_in_len         :   number of input symbols
@@ -6775,6 +10171,446 @@ unsigned int  liquid_reverse_uint16(unsigned int  _x);
 unsigned int  liquid_reverse_uint24(unsigned int  _x);
 unsigned int  liquid_reverse_uint32(unsigned int  _x);
 
+//
+// sample capture files
+//
+
+// raw interleaved sample formats (native byte order)
+#define LIQUID_CAPTURE_NUM_FORMATS (4)
+typedef enum {
+    LIQUID_CAPTURE_UNKNOWN=0,   // unknown/unsupported format
+    LIQUID_CAPTURE_CF32,        // complex 32-bit floating-point
+    LIQUID_CAPTURE_CI16,        // complex 16-bit signed integer
+    LIQUID_CAPTURE_F32,         // real 32-bit floating-point
+} liquid_capture_format;
+
+// returns capture format based on input string (e.g. "ci16")
+liquid_capture_format liquid_getopt_str2capture(const char * _str);
+
+typedef struct capture_s * capture;
+
+// open existing capture file as a memory-mapped sample source;
+// returns NULL if the file cannot be opened
+capture capture_open(const char *          _filename,
+                     liquid_capture_format _format);
+
+// create capture file as a sample sink, truncating any existing
+// file; returns NULL if the file cannot be opened
+capture capture_create(const char *          _filename,
+                       liquid_capture_format _format);
+
+// close capture file and free all internal memory
+void capture_destroy(capture _q);
+
+// print capture object properties
+void capture_print(capture _q);
+
+// get total number of samples in source, or written to sink
+unsigned long capture_get_num_samples(capture _q);
+
+// get number of samples remaining to be read from source
+unsigned long capture_get_num_remaining(capture _q);
+
+// move source read position to sample _index
+void capture_seek(capture       _q,
+                  unsigned long _index);
+
+// read block view of complex samples from a cf32/ci16 source; cf32
+// views point directly into the mapped file (no copy). The view is
+// valid until the next read; returns the number of samples referenced
+// by _v (0 at end of file)
+//  _q      :   capture object
+//  _n      :   number of samples requested
+//  _v      :   output view pointer
+unsigned int capture_readcf(capture                 _q,
+                            unsigned int            _n,
+                            liquid_float_complex ** _v);
+
+// read block view of real samples from an f32 source
+unsigned int capture_readf(capture      _q,
+                           unsigned int _n,
+                           float **     _v);
+
+// write block of complex samples to a cf32/ci16 sink
+void capture_writecf(capture                _q,
+                     liquid_float_complex * _v,
+                     unsigned int           _n);
+
+// write block of real samples to an f32 sink
+void capture_writef(capture      _q,
+                    float *      _v,
+                    unsigned int _n);
+
+//
+// arena allocator
+//
+
+// alignment of each region handed out by an arena (one cache line)
+#define LIQUID_ARENA_ALIGNMENT (64)
+
+// size of a region of _size bytes, rounded up to the arena alignment;
+// the capacity needed for a set of regions is the sum of their sizes
+#define LIQUID_ARENA_SIZE(_size) \
+    ((((unsigned long)(_size)) + LIQUID_ARENA_ALIGNMENT - 1) & ~(unsigned long)(LIQUID_ARENA_ALIGNMENT - 1))
+
+// one contiguous block of memory carved into cache-line-aligned
+// regions and released in a single operation
+typedef struct liquid_arena_s * liquid_arena;
+
+// create arena with capacity of _size bytes
+liquid_arena liquid_arena_create(unsigned long _size);
+
+// destroy arena, releasing all regions at once
+void liquid_arena_destroy(liquid_arena _a);
+
+// print arena object properties
+void liquid_arena_print(liquid_arena _a);
+
+// release all regions, keeping the underlying block
+void liquid_arena_reset(liquid_arena _a);
+
+// get next region of _size bytes (uninitialized), aligned to
+// LIQUID_ARENA_ALIGNMENT; exceeding the capacity is an error
+void * liquid_arena_alloc(liquid_arena  _a,
+                          unsigned long _size);
+
+// get next region for _num elements of _size bytes, set to zero
+void * liquid_arena_calloc(liquid_arena  _a,
+                           unsigned long _num,
+                           unsigned long _size);
+
+// get capacity of arena (bytes)
+unsigned long liquid_arena_get_size(liquid_arena _a);
+
+// get number of bytes handed out, including alignment padding
+unsigned long liquid_arena_get_used(liquid_arena _a);
+
+//
+// memory allocation
+//
+
+// user-defined allocator for all library memory; reallocate may be
+// NULL, in which case blocks are resized by allocate, copy and release.
+// Blocks are always released to the allocator that provided them, so
+// an allocator must remain valid until all of its blocks are released.
+typedef struct {
+    void * (*allocate)  (unsigned long _size, void * _userdata);
+    void * (*reallocate)(void * _ptr, unsigned long _size, void * _userdata);
+    void   (*release)   (void * _ptr, void * _userdata);
+    void *   userdata;
+} liquid_allocator;
+
+// set global allocator for all library allocations, or restore the
+// standard library allocator if _a is NULL; set before creating objects
+void liquid_set_allocator(const liquid_allocator * _a);
+
+// set allocator for library allocations made by the calling thread,
+// overriding the global allocator, or clear it if _a is NULL; objects
+// created while it is set take all of their memory from it
+void liquid_set_thread_allocator(const liquid_allocator * _a);
+
+// get allocator set for the calling thread, or NULL if none
+const liquid_allocator * liquid_get_thread_allocator(void);
+
+// start counting each allocation and release made by the library on
+// the calling thread, e.g. around *_execute() calls, reporting each
+// one to stderr if _report is set
+void liquid_allocator_audit_begin(int _report);
+
+// stop reporting allocations made on the calling thread, returning the
+// number of allocations and releases since the audit began
+unsigned long liquid_allocator_audit_end(void);
+
+//
+// execution contexts: cpu affinity and NUMA-local object memory
+//
+
+// get number of configured cpus
+unsigned int liquid_get_num_cpus(void);
+
+// get number of NUMA nodes (1 when the topology is unavailable)
+unsigned int liquid_get_num_numa_nodes(void);
+
+// get NUMA node of cpu _cpu (0 when the topology is unavailable)
+unsigned int liquid_get_cpu_numa_node(unsigned int _cpu);
+
+// pin calling thread to cpu _cpu, returning 0 on success and -1 if the
+// cpu is unavailable to the process or affinity is unsupported
+int liquid_set_thread_cpu(unsigned int _cpu);
+
+// execution context: a thread entering a context is pinned to its cpu
+// and objects it creates until it leaves take all of their memory from
+// a pool bound to the cpu's NUMA node, so that receivers created and
+// run by worker threads keep their buffers local. Released blocks are
+// reused by later objects; the pool is returned on destroy, after all
+// objects created under the context have been destroyed (on any
+// thread).
+typedef struct liquid_context_s * liquid_context;
+
+// create execution context for cpu _cpu (memory bound to its node); a
+// negative value neither pins threads nor binds memory
+liquid_context liquid_context_create(int _cpu);
+
+// destroy execution context, releasing its memory pool
+void liquid_context_destroy(liquid_context _q);
+
+// print execution context
+void liquid_context_print(liquid_context _q);
+
+// get cpu (-1: none) and NUMA node (-1: none) of context
+int liquid_context_get_cpu (liquid_context _q);
+int liquid_context_get_node(liquid_context _q);
+
+// get bytes reserved by the context, including its memory pool
+unsigned long liquid_context_get_memory_usage(liquid_context _q);
+
+// get number of blocks currently allocated from the pool
+unsigned long liquid_context_get_num_blocks(liquid_context _q);
+
+// enter context on the calling thread, pinning it to the context's cpu
+// and routing library allocations to the context's pool; returns 0 if
+// pinned (or the context has no cpu), -1 if pinning failed. Contexts
+// do not nest.
+int liquid_context_enter(liquid_context _q);
+
+// leave context entered by the calling thread, restoring its previous
+// cpu affinity and allocator
+void liquid_context_leave(void);
+
+// get context entered by the calling thread (NULL if none)
+liquid_context liquid_context_get_current(void);
+
+//
+// autotune: microbenchmark implementation alternatives whose
+// crossovers depend on the host and record the fastest in a profile
+// consulted when objects select their implementation. Like the SIMD
+// dispatch level, the profile is process-wide and should be tuned or
+// imported before other threads use the library.
+//
+
+// tuned parameters
+typedef enum {
+    LIQUID_AUTOTUNE_SIMD_LEVEL=0,   // dot product SIMD dispatch level
+    LIQUID_AUTOTUNE_FFTFILT_COST,   // fftfilt cost per transform point
+                                    // and stage (liquid_fftfilt_select)
+    LIQUID_AUTOTUNE_NUM_PARAMS
+} liquid_autotune_param;
+
+// run microbenchmarks (SIMD level, direct-form/FFT filtering crossover,
+// transform methods of common sizes into fft wisdom) and store the
+// results in the profile; takes about a second. Returns 0 on success.
+int liquid_autotune(void);
+
+// get/set profile value of parameter; setting the SIMD level applies
+// it (see liquid_simd_set_level())
+float liquid_autotune_get(liquid_autotune_param _p);
+void  liquid_autotune_set(liquid_autotune_param _p, float _value);
+
+// test whether parameter has been tuned or imported
+int liquid_autotune_is_tuned(liquid_autotune_param _p);
+
+// restore built-in defaults (fft wisdom is kept)
+void liquid_autotune_forget(void);
+
+// export profile (tuned parameters and fft wisdom) to file, returning
+// 0 on success
+int liquid_autotune_export(const char * _filename);
+
+// import profile from file, returning number of entries applied or -1
+// on error; a SIMD level unavailable on this host is skipped
+int liquid_autotune_import(const char * _filename);
+
+// print profile to stdout
+void liquid_autotune_print(void);
+
+//
+// accelerator offload: batched kernels (transforms, polyphase filter
+// matrix products, multi-hypothesis correlation) are submitted to a
+// queue and run asynchronously by a backend, in submission order. A
+// backend supplies the kernels and host buffer allocators (e.g. pinned
+// memory for a device); the built-in backend runs on the host.
+//
+
+// offload backend: kernels return 0 on success
+typedef struct {
+    const char * name;
+    // allocate/release host buffers (NULL: aligned heap memory)
+    void * (*alloc_host)(unsigned long _size, void * _userdata);
+    void   (*free_host) (void * _ptr, void * _userdata);
+    // _num transforms of length _n stored back to back
+    int (*fft_batch)(void * _userdata, int _dir, unsigned int _n, unsigned int _num,
+                     const liquid_float_complex * _x, liquid_float_complex * _y);
+    // Y = H X, H: _m x _k (real), X: _k x _n, Y: _m x _n, row-major
+    int (*pfb)(void * _userdata, unsigned int _m, unsigned int _k, unsigned int _n,
+               const float * _h, const liquid_float_complex * _x, liquid_float_complex * _y);
+    // y_k = ifft( X[i] S[(i-offsets[k]) mod _n] ), k = 0.._num-1, unscaled
+    int (*xcorr)(void * _userdata, unsigned int _n,
+                 const liquid_float_complex * _x, const liquid_float_complex * _s,
+                 unsigned int _num, const int * _offsets, liquid_float_complex * _y);
+    void * userdata;
+} liquid_offload_backend;
+
+// create offload queue; _backend is copied (NULL: built-in host backend)
+liquid_offload liquid_offload_create(const liquid_offload_backend * _backend);
+
+// destroy offload queue, completing jobs still queued
+void liquid_offload_destroy(liquid_offload _q);
+
+// print offload queue
+void liquid_offload_print(liquid_offload _q);
+
+// get backend name
+const char * liquid_offload_get_backend_name(liquid_offload _q);
+
+// allocate/release host buffer suited to the backend
+void * liquid_offload_alloc(liquid_offload _q, unsigned long _size);
+void   liquid_offload_free (liquid_offload _q, void * _ptr);
+
+// submit jobs, returning a ticket; buffers must remain valid and
+// unmodified until the job completes
+unsigned long liquid_offload_fft_batch(liquid_offload               _q,
+                                       int                          _dir,
+                                       unsigned int                 _n,
+                                       unsigned int                 _num,
+                                       const liquid_float_complex * _x,
+                                       liquid_float_complex *       _y);
+unsigned long liquid_offload_pfb(liquid_offload               _q,
+                                 unsigned int                 _m,
+                                 unsigned int                 _k,
+                                 unsigned int                 _n,
+                                 const float *                _h,
+                                 const liquid_float_complex * _x,
+                                 liquid_float_complex *       _y);
+unsigned long liquid_offload_xcorr(liquid_offload               _q,
+                                   unsigned int                 _n,
+                                   const liquid_float_complex * _x,
+                                   const liquid_float_complex * _s,
+                                   unsigned int                 _num,
+                                   const int *                  _offsets,
+                                   liquid_float_complex *       _y);
+
+// get number of jobs completed
+unsigned long liquid_offload_get_num_completed(liquid_offload _q);
+
+// test whether job _ticket and all jobs before it completed
+int liquid_offload_is_done(liquid_offload _q, unsigned long _ticket);
+
+// wait for job _ticket and all jobs before it (0: all jobs submitted)
+void liquid_offload_wait(liquid_offload _q, unsigned long _ticket);
+
+//
+// flowgraph: streaming dataflow runtime connecting processing blocks
+// (user callbacks or adapters around the *_execute_block() methods of
+// existing objects) through bounded lock-free single-producer/single-
+// consumer edges; a pool of worker threads claims runnable blocks,
+// scanning from a home block and stealing from the rest, so that
+// successive stages are pipelined across cores while each block runs on
+// at most one thread at a time. A block only runs while every output
+// edge has space, so full edges apply backpressure all the way back to
+// the sources. The graph must be acyclic.
+//
+
+typedef struct flowgraph_s * flowgraph;
+
+// flowgraph_callback return value signalling that a block is finished
+#define LIQUID_FLOWGRAPH_DONE (1)
+
+// block work callback; inputs and outputs are contiguous item arrays
+//  _userdata   :   user-defined data
+//  _x          :   input item arrays [size: num_inputs x 1]
+//  _nx         :   in: items available on each input,
+//                  out: items consumed from each input
+//  _y          :   output item arrays [size: num_outputs x 1]
+//  _ny         :   in: space available on each output,
+//                  out: items written to each output
+// Returns LIQUID_FLOWGRAPH_DONE once the block will produce nothing
+// more (sources, or sinks that want to stop), 0 otherwise. Blocks with
+// inputs finish automatically once their producers have finished and
+// they stop consuming.
+typedef int (*flowgraph_callback)(void *         _userdata,
+                                  void **        _x,
+                                  unsigned int * _nx,
+                                  void **        _y,
+                                  unsigned int * _ny);
+
+// per-block execution statistics
+typedef struct {
+    unsigned long int num_calls;    // work callback invocations
+    unsigned long int num_consumed; // items consumed (all inputs)
+    unsigned long int num_produced; // items produced (all outputs)
+    unsigned long int num_blocked;  // times held back by a full output:
+                                    // skipped, or filled an output edge
+    double            time;         // time spent in work callback [s]
+} flowgraph_blockstats_s;
+
+// create flowgraph
+//  _num_threads    :   number of worker threads; 0 executes blocks in
+//                      the thread calling flowgraph_run()
+flowgraph flowgraph_create(unsigned int _num_threads);
+
+// destroy flowgraph, its edges and any adapter state (wrapped objects
+// are not destroyed)
+void flowgraph_destroy(flowgraph _g);
+
+// print flowgraph blocks, edges and block statistics
+void flowgraph_print(flowgraph _g);
+
+// add block with user-defined work callback, returning block id
+//  _g          :   flowgraph
+//  _name       :   block name (for printing)
+//  _num_inputs :   number of input ports
+//  _in_size    :   input item size [bytes]
+//  _num_outputs:   number of output ports
+//  _out_size   :   output item size [bytes]
+//  _callback   :   work callback
+//  _userdata   :   user-defined data passed to callback
+unsigned int flowgraph_add_block(flowgraph          _g,
+                                 const char *       _name,
+                                 unsigned int       _num_inputs,
+                                 unsigned int       _in_size,
+                                 unsigned int       _num_outputs,
+                                 unsigned int       _out_size,
+                                 flowgraph_callback _callback,
+                                 void *             _userdata);
+
+// adapters wrapping existing objects (complex float items); the object
+// must not be used elsewhere while the graph runs
+unsigned int flowgraph_add_agc_crcf        (flowgraph _g, agc_crcf      _q);
+unsigned int flowgraph_add_nco_crcf_mix_up (flowgraph _g, nco_crcf      _q);
+unsigned int flowgraph_add_nco_crcf_mix_down(flowgraph _g, nco_crcf     _q);
+unsigned int flowgraph_add_firfilt_crcf    (flowgraph _g, firfilt_crcf  _q);
+unsigned int flowgraph_add_msresamp_crcf   (flowgraph _g, msresamp_crcf _q);
+unsigned int flowgraph_add_flexframesync   (flowgraph _g, flexframesync _q);
+
+// analysis channelizer adapter: one input, one output per channel
+unsigned int flowgraph_add_firpfbch2_crcf(flowgraph _g, firpfbch2_crcf _q);
+
+// connect output port of one block to input port of another
+//  _g          :   flowgraph
+//  _src        :   producing block id
+//  _src_port   :   producing block output port
+//  _dst        :   consuming block id
+//  _dst_port   :   consuming block input port
+//  _capacity   :   edge capacity [items] (rounded up to power of 2)
+void flowgraph_connect(flowgraph    _g,
+                       unsigned int _src,
+                       unsigned int _src_port,
+                       unsigned int _dst,
+                       unsigned int _dst_port,
+                       unsigned int _capacity);
+
+// get number of blocks, worker threads
+unsigned int flowgraph_get_num_blocks (flowgraph _g);
+unsigned int flowgraph_get_num_threads(flowgraph _g);
+
+// run graph until every block has finished
+void flowgraph_run(flowgraph _g);
+
+// get block execution statistics
+void flowgraph_get_blockstats(flowgraph                _g,
+                              unsigned int             _id,
+                              flowgraph_blockstats_s * _stats);
+
 // 
 // MODULE : vector
 //
@@ -6849,9 +10685,65 @@ void VECTOR(_normalize)(T *          _x,                        \
 LIQUID_VECTOR_DEFINE_API(VECTOR_MANGLE_RF, float,                float);
 LIQUID_VECTOR_DEFINE_API(VECTOR_MANGLE_CF, liquid_float_complex, float);
 
-// 
+//
 // mixed types
 //
+
+// convert 16-bit integers to floating-point: y[i] = x[i] * scale
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of values
+//  _scale  :   scaling factor (e.g. 1/32768)
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorf_from_s16(const int16_t * _x,
+                             unsigned int    _n,
+                             float           _scale,
+                             float *         _y);
+
+// convert interleaved 16-bit in-phase/quadrature pairs to complex
+// floating-point: y[i] = (x[2i] + j x[2i+1]) * scale
+//  _x      :   interleaved input array [size: 2*_n x 1]
+//  _n      :   number of complex samples
+//  _scale  :   scaling factor (e.g. 1/32768)
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorcf_from_ci16(const int16_t *        _x,
+                               unsigned int           _n,
+                               float                  _scale,
+                               liquid_float_complex * _y);
+
+// split-complex vectors: real and imaginary parts held in separate
+// arrays, so that complex arithmetic needs no de-interleaving (see
+// also dotprod_cccf_run_split(), fft_create_plan_split())
+
+// split complex array into real and imaginary parts
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of values
+//  _xr     :   output real parts [size: _n x 1]
+//  _xi     :   output imaginary parts [size: _n x 1]
+void liquid_vectorcf_split(const liquid_float_complex * _x,
+                           unsigned int                 _n,
+                           float *                      _xr,
+                           float *                      _xi);
+
+// merge real and imaginary parts into complex array
+//  _xr     :   input real parts [size: _n x 1]
+//  _xi     :   input imaginary parts [size: _n x 1]
+//  _n      :   number of values
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorcf_merge(const float *          _xr,
+                           const float *          _xi,
+                           unsigned int           _n,
+                           liquid_float_complex * _y);
+
+// multiply each element of split-complex arrays: z[i] = x[i] * y[i];
+// the output may alias either input
+void liquid_vectorcf_mul_split(const float * _xr,
+                               const float * _xi,
+                               const float * _yr,
+                               const float * _yi,
+                               unsigned int  _n,
+                               float *       _zr,
+                               float *       _zi);
+
 #if 0
 void liquid_vectorf_add(float *      _a,
                         float *      _b,
@@ -36,12 +36,10 @@
 #include "config.h"
 
 #include <complex.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "liquid.h"
 
-#if defined HAVE_FEC_H && defined HAVE_LIBFEC
-#  define LIBFEC_ENABLED 1
-#endif
-
 
 //
 // Debugging macros
@@ -54,6 +52,15 @@
 #define PRINTVAL_FLOAT(X,F)     printf(#F,crealf(X));
 #define PRINTVAL_CFLOAT(X,F)    printf(#F "+j*" #F, crealf(X), cimagf(X));
 
+// storage class for per-thread library state
+#if defined __STDC_VERSION__ && __STDC_VERSION__ >= 201112L && !defined __STDC_NO_THREADS__
+#   define LIQUID_THREAD_LOCAL _Thread_local
+#elif defined __GNUC__
+#   define LIQUID_THREAD_LOCAL __thread
+#else
+#   define LIQUID_THREAD_LOCAL  // state shared by all threads
+#endif
+
 //
 // MODULE : agc
 //
@@ -63,6 +70,74 @@
 // MODULE : audio
 //
 
+// cvsd codec state for one or more independent channels, stored as
+// structure of arrays so that channels map onto SIMD lanes
+struct liquid_cvsd_lanes_s {
+    unsigned int num_channels;  // number of interleaved channels
+    unsigned int bitmask;       // historical bit reference mask
+    float zeta;                 // delta step factor
+    float delta_min;            // minimum delta
+    float delta_max;            // maximum delta
+    float alpha;                // pre-emphasis filter coefficient
+    float a1;                   // de-emphasis filter feed-back coefficients
+    float a2;                   //
+
+    // per-channel state [size: num_channels x 1]
+    unsigned int * bitref;      // historical bit reference
+    float *        ref;         // internal reference
+    float *        delta;       // current step size
+    float *        x_prev;      // pre-emphasis filter state (encoder)
+    float *        v1;          // de-emphasis filter state (decoder)
+    float *        v2;          //
+};
+
+// encode/decode single sample on channel _c (cvsd_kernels.c)
+unsigned char liquid_cvsd_encode_sample(struct liquid_cvsd_lanes_s * _s,
+                                        unsigned int                 _c,
+                                        float                        _x);
+float liquid_cvsd_decode_sample(struct liquid_cvsd_lanes_s * _s,
+                                unsigned int                 _c,
+                                unsigned char                _bit);
+
+// encode _n bytes per channel on channels [_c0,_c1)
+//  _s      :   codec state
+//  _c0     :   first channel
+//  _c1     :   one past last channel
+//  _audio  :   audio samples, interleaved by channel [size: 8*_n*C x 1]
+//  _n      :   number of output bytes per channel
+//  _data   :   encoded bytes, interleaved by channel [size: _n*C x 1]
+void liquid_cvsd_encode_lanes(struct liquid_cvsd_lanes_s * _s,
+                              unsigned int                 _c0,
+                              unsigned int                 _c1,
+                              const float *                _audio,
+                              unsigned int                 _n,
+                              unsigned char *              _data);
+
+// decode _n bytes per channel on channels [_c0,_c1)
+//  _s      :   codec state
+//  _c0     :   first channel
+//  _c1     :   one past last channel
+//  _data   :   encoded bytes, interleaved by channel [size: _n*C x 1]
+//  _n      :   number of input bytes per channel
+//  _audio  :   audio samples, interleaved by channel [size: 8*_n*C x 1]
+void liquid_cvsd_decode_lanes(struct liquid_cvsd_lanes_s * _s,
+                              unsigned int                 _c0,
+                              unsigned int                 _c1,
+                              const unsigned char *        _data,
+                              unsigned int                 _n,
+                              float *                      _audio);
+#if HAVE_DOTPROD_AVX
+// x86 kernels (cvsd_kernels.avx.c), all channels
+void liquid_cvsd_encode_lanes_avx2(struct liquid_cvsd_lanes_s * _s,
+                                   const float *                _audio,
+                                   unsigned int                 _n,
+                                   unsigned char *              _data);
+void liquid_cvsd_decode_lanes_avx2(struct liquid_cvsd_lanes_s * _s,
+                                   const unsigned char *        _data,
+                                   unsigned int                 _n,
+                                   float *                      _audio);
+#endif
+
 
 //
 // MODULE : buffer
@@ -73,6 +148,162 @@
 // MODULE : dotprod
 //
 
+// detect highest SIMD level supported by the host cpu for which
+// kernels are available in this build
+liquid_simd_level liquid_simd_detect(void);
+
+// test whether kernels of SIMD level _level can run on this host
+int liquid_simd_level_supported(liquid_simd_level _level);
+
+// alignment of dotprod coefficient storage [bytes]; sufficient for
+// aligned loads of the widest (AVX-512) registers
+#define LIQUID_SIMD_ALIGNMENT (64)
+
+// allocate/free memory aligned to LIQUID_SIMD_ALIGNMENT
+void * liquid_malloc_aligned(size_t _size);
+void liquid_free_aligned(void * _ptr);
+
+// round 32-bit fixed-point (Q30) dot product accumulator to Q15,
+// saturating to [-1,1)
+q16_t liquid_q16_round(int32_t _acc);
+
+#if HAVE_DOTPROD_AVX
+// x86 AVX2/FMA and AVX-512F kernels operating on the coefficient
+// layout of the corresponding SSE dotprod objects
+void dotprod_rrrf_execute_avx2(float *      _h,
+                               float *      _x,
+                               unsigned int _n,
+                               float *      _y);
+void dotprod_rrrf_execute_avx512f(float *      _h,
+                                  float *      _x,
+                                  unsigned int _n,
+                                  float *      _y);
+void dotprod_crcf_execute_avx2(float *                _h,
+                               liquid_float_complex * _x,
+                               unsigned int           _n,
+                               liquid_float_complex * _y);
+void dotprod_crcf_execute_avx512f(float *                _h,
+                                  liquid_float_complex * _x,
+                                  unsigned int           _n,
+                                  liquid_float_complex * _y);
+void dotprod_cccf_execute_avx2(float *                _hi,
+                               float *                _hq,
+                               liquid_float_complex * _x,
+                               unsigned int           _n,
+                               liquid_float_complex * _y);
+void dotprod_cccf_execute_avx512f(float *                _hi,
+                                  float *                _hq,
+                                  liquid_float_complex * _x,
+                                  unsigned int           _n,
+                                  liquid_float_complex * _y);
+
+// x86 AVX2/FMA and AVX-512F block kernels computing _num consecutive
+// (unit stride) outputs; coefficients are in natural order and need
+// not be aligned
+void dotprod_rrrf_run_block_avx2(float *      _h,
+                                 unsigned int _n,
+                                 float *      _x,
+                                 unsigned int _num,
+                                 float *      _y);
+void dotprod_rrrf_run_block_avx512f(float *      _h,
+                                    unsigned int _n,
+                                    float *      _x,
+                                    unsigned int _num,
+                                    float *      _y);
+void dotprod_crcf_run_block_avx2(float *                _h,
+                                 unsigned int           _n,
+                                 liquid_float_complex * _x,
+                                 unsigned int           _num,
+                                 liquid_float_complex * _y);
+void dotprod_crcf_run_block_avx512f(float *                _h,
+                                    unsigned int           _n,
+                                    liquid_float_complex * _x,
+                                    unsigned int           _num,
+                                    liquid_float_complex * _y);
+void dotprod_cccf_run_block_avx2(liquid_float_complex * _h,
+                                 unsigned int           _n,
+                                 liquid_float_complex * _x,
+                                 unsigned int           _num,
+                                 liquid_float_complex * _y);
+void dotprod_cccf_run_block_avx512f(liquid_float_complex * _h,
+                                    unsigned int           _n,
+                                    liquid_float_complex * _x,
+                                    unsigned int           _num,
+                                    liquid_float_complex * _y);
+
+// x86 AVX2/FMA batched dot product kernels on a single shared input;
+// coefficients are interleaved in groups of four sets (see
+// dotprod_xxxt_batch objects)
+void dotprod_rrrf_execute_batch_shared_avx2(float *      _h,
+                                            unsigned int _n,
+                                            unsigned int _num,
+                                            float *      _x,
+                                            float *      _y);
+void dotprod_crcf_execute_batch_shared_avx2(float *                _h,
+                                            unsigned int           _n,
+                                            unsigned int           _num,
+                                            liquid_float_complex * _x,
+                                            liquid_float_complex * _y);
+
+// x86 AVX2/FMA and AVX-512F sum of squares kernels; the peak variants
+// return the sum and write the peak squared magnitude to _peak2,
+// treating adjacent values as (real,imag) pairs if _pair is set
+float liquid_sumsqf_avx2(float *      _v,
+                         unsigned int _n);
+float liquid_sumsqf_avx512f(float *      _v,
+                            unsigned int _n);
+float liquid_sumsq_peak_avx2(float *      _v,
+                             unsigned int _n,
+                             int          _pair,
+                             float *      _peak2);
+float liquid_sumsq_peak_avx512f(float *      _v,
+                                unsigned int _n,
+                                int          _pair,
+                                float *      _peak2);
+#endif
+
+
+//
+// MODULE : equalization
+//
+
+// fused LMS kernels (eqlms_kernels.c): apply the weight update
+// w += g r0 of a training step and compute the conjugate dot product
+// y = w^H r1 of the next output with the updated weights in one pass
+//  _w      :   weights [size: _n x 1]
+//  _g      :   update gain
+//  _r0     :   window of the training step [size: _n x 1], NULL to skip update
+//  _r1     :   window of the output [size: _n x 1], NULL to skip dot product
+//  _n      :   number of weights
+//  _y      :   output sample (ignored if NULL)
+void liquid_eqlms_update_dot_cf(float complex *       _w,
+                                float complex         _g,
+                                const float complex * _r0,
+                                const float complex * _r1,
+                                unsigned int          _n,
+                                float complex *       _y);
+void liquid_eqlms_update_dot_f(float *       _w,
+                               float         _g,
+                               const float * _r0,
+                               const float * _r1,
+                               unsigned int  _n,
+                               float *       _y);
+#if HAVE_DOTPROD_AVX
+// x86 kernels (eqlms_kernels.avx.c)
+void liquid_eqlms_update_dot_cf_avx2(float complex *       _w,
+                                     float complex         _g,
+                                     const float complex * _r0,
+                                     const float complex * _r1,
+                                     unsigned int          _n,
+                                     float complex *       _y);
+void liquid_eqlms_update_dot_f_avx2(float *       _w,
+                                    float         _g,
+                                    const float * _r0,
+                                    const float * _r1,
+                                    unsigned int  _n,
+                                    float *       _y);
+#endif
+
 
 //
 // MODULE : fec (forward error-correction)
@@ -84,13 +315,52 @@
 #define CRC16_POLY 0x8005
 #define CRC24_POLY 0x5D6DCB
 #define CRC32_POLY 0x04C11DB7
+#define CRC32C_POLY 0x1EDC6F41
 
 unsigned int checksum_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc8_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc16_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc24_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc32_generate_key(unsigned char * _msg, unsigned int _msg_len);
+unsigned int crc32c_generate_key(unsigned char * _msg, unsigned int _msg_len);
+
+// slicing-by-8 tables for reflected polynomials (crc_gentab.c)
+extern const unsigned int crc8_gentab[8][256];
+extern const unsigned int crc16_gentab[8][256];
+extern const unsigned int crc24_gentab[8][256];
+extern const unsigned int crc32_gentab[8][256];
+extern const unsigned int crc32c_gentab[8][256];
+
+// update (non-inverted) crc register over message using slicing-by-8
+//  _tab    :   slicing-by-8 tables
+//  _crc    :   crc register
+//  _msg    :   input data message [size: _n x 1]
+//  _n      :   input data message size
+unsigned int crc_update_slice8(const unsigned int _tab[8][256],
+                               unsigned int        _crc,
+                               const unsigned char * _msg,
+                               unsigned int        _n);
+
+#if HAVE_CRC_SSE42
+// hardware crc kernels (x86 sse4.2/pclmulqdq, selected at run time);
+// operate on the non-inverted crc register
+unsigned int crc32c_update_sse42(unsigned int          _crc,
+                                 const unsigned char * _msg,
+                                 unsigned int          _n);
+unsigned int crc32_update_pclmul(unsigned int          _crc,
+                                 const unsigned char * _msg,
+                                 unsigned int          _n);
+#endif
+
+
+// viterbi decoder for rate 1/R convolutional codes (viterbi.c)
+typedef struct viterbi_s * viterbi;
+
+// Reed-Solomon codec over GF(2^8) (rscodec.c)
+typedef struct rscodec_s * rscodec;
 
+// quasi-cyclic LDPC codec (ldpccodec.c)
+typedef struct ldpccodec_s * ldpccodec;
 
 // fec : basic object
 struct fec_s {
@@ -106,21 +376,13 @@ struct fec_s {
 
     // convolutional : internal memory structure
     unsigned char * enc_bits;
-    void * vp;      // decoder object
+    viterbi vp;     // decoder object
     int * poly;     // polynomial
     unsigned int R; // primitive rate, inverted (e.g. R=3 for 1/3)
     unsigned int K; // constraint length
     unsigned int P; // puncturing rate (e.g. p=3 for 3/4)
     int * puncturing_matrix;
 
-    // viterbi decoder function pointers
-    void*(*create_viterbi)(int);
-    //void (*set_viterbi_polynomial)(int*);
-    int  (*init_viterbi)(void*,int);
-    int  (*update_viterbi_blk)(void*,unsigned char*,int);
-    int  (*chainback_viterbi)(void*,unsigned char*,unsigned int,unsigned int);
-    void (*delete_viterbi)(void*);
-
     // Reed-Solomon
     int symsize;    // symbol size (bits per symbol)
     int genpoly;    // generator polynomial
@@ -131,7 +393,7 @@ struct fec_s {
     unsigned int rspad; // number of implicit padded symbols
     int nn;         // 2^symsize - 1
     int kk;         // nn - nroots
-    void * rs;      // Reed-Solomon internal object
+    rscodec rs;     // Reed-Solomon internal object
 
     // Reed-Solomon decoder
     unsigned int num_blocks;    // number of blocks: ceil(dec_msg_len / nn)
@@ -140,9 +402,10 @@ struct fec_s {
     unsigned int res_block_len; // residual bytes in last block
     unsigned int pad;           // padding for each block
     unsigned char * tblock;     // decoder input sequence [size: 1 x n]
-    int * errlocs;              // error locations [size: 1 x n]
-    int * derrlocs;             // decoded error locations [size: 1 x n]
-    int erasures;               // number of erasures
+
+    // LDPC
+    ldpccodec lp;               // LDPC internal object
+    int8_t * llr;               // decoder input LLRs [size: n x 1]
 
     // encode function pointer
     void (*encode_func)(fec _q,
@@ -169,6 +432,7 @@ int fec_scheme_is_punctured(fec_scheme _scheme);
 int fec_scheme_is_reedsolomon(fec_scheme _scheme);
 int fec_scheme_is_hamming(fec_scheme _scheme);
 int fec_scheme_is_repeat(fec_scheme _scheme);
+int fec_scheme_is_ldpc(fec_scheme _scheme);
 
 // Pass
 fec fec_pass_create(void *_opts);
@@ -303,6 +567,12 @@ extern unsigned int golay2412_P[12];
 extern unsigned int golay2412_Gt[24];
 extern unsigned int golay2412_H[12];
 
+// encoder, syndrome and syndrome-decoding tables (fec_golay2412_gentab.c)
+extern const unsigned int       golay2412_enc0_gentab[256];
+extern const unsigned int       golay2412_enc1_gentab[16];
+extern const unsigned short int golay2412_syn_gentab[3][256];
+extern const unsigned short int golay2412_dec_gentab[4096];
+
 // multiply input vector with matrix
 unsigned int golay2412_matrix_mul(unsigned int   _v,
                                   unsigned int * _A,
@@ -355,6 +625,10 @@ extern unsigned char secded2216_P[12];
 // syndrome vectors of errors with weight exactly equal to 1
 extern unsigned char secded2216_syndrome_w1[22];
 
+// parity and error location tables (fec_secded_gentab.c)
+extern const unsigned char secded2216_parity_gentab[2][256];
+extern const unsigned char secded2216_errloc_gentab[64];
+
 fec fec_secded2216_create(void *_opts);
 void fec_secded2216_destroy(fec _q);
 void fec_secded2216_print(fec _q);
@@ -399,6 +673,10 @@ extern unsigned char secded3932_P[28];
 // syndrome vectors of errors with weight exactly equal to 1
 extern unsigned char secded3932_syndrome_w1[39];
 
+// parity and error location tables (fec_secded_gentab.c)
+extern const unsigned char secded3932_parity_gentab[4][256];
+extern const unsigned char secded3932_errloc_gentab[128];
+
 fec fec_secded3932_create(void *_opts);
 void fec_secded3932_destroy(fec _q);
 void fec_secded3932_print(fec _q);
@@ -440,6 +718,10 @@ int fec_secded7264_decode_symbol(unsigned char * _sym_enc,
 extern unsigned char secded7264_P[64];
 extern unsigned char secded7264_syndrome_w1[72];
 
+// parity and error location tables (fec_secded_gentab.c)
+extern const unsigned char secded7264_parity_gentab[8][256];
+extern const unsigned char secded7264_errloc_gentab[256];
+
 fec fec_secded7264_create(void *_opts);
 void fec_secded7264_destroy(fec _q);
 void fec_secded7264_print(fec _q);
@@ -474,7 +756,21 @@ unsigned int fec_conv_get_enc_msg_len(unsigned int _dec_msg_len,
                                       unsigned int _K,
                                       unsigned int _p);
 
-// convolutional code polynomials
+// convolutional code polynomials (as defined by libfec)
+#define LIQUID_V27POLYA  (0x4f)
+#define LIQUID_V27POLYB  (0x6d)
+#define LIQUID_V29POLYA  (0x1af)
+#define LIQUID_V29POLYB  (0x11d)
+#define LIQUID_V39POLYA  (0x1ed)
+#define LIQUID_V39POLYB  (0x19b)
+#define LIQUID_V39POLYC  (0x127)
+#define LIQUID_V615POLYA (042631)
+#define LIQUID_V615POLYB (047245)
+#define LIQUID_V615POLYC (056507)
+#define LIQUID_V615POLYD (073363)
+#define LIQUID_V615POLYE (077267)
+#define LIQUID_V615POLYF (064537)
+
 extern int fec_conv27_poly[2];
 extern int fec_conv29_poly[2];
 extern int fec_conv39_poly[3];
@@ -515,7 +811,7 @@ void fec_conv_decode(fec _q,
 void fec_conv_setlength(fec _q,
                         unsigned int _dec_msg_len);
 
-// internal initialization methods (sets r, K, viterbi methods)
+// internal initialization methods (sets r, K, polynomials)
 void fec_conv_init_v27(fec _q);
 void fec_conv_init_v29(fec _q);
 void fec_conv_init_v39(fec _q);
@@ -540,8 +836,8 @@ void fec_conv_punctured_decode_soft(fec _q,
 void fec_conv_punctured_setlength(fec _q,
                                   unsigned int _dec_msg_len);
 
-// internal initialization methods (sets r, K, viterbi methods,
-// and puncturing matrix)
+// internal initialization methods (sets r, K, polynomials, and
+// puncturing matrix)
 void fec_conv_init_v27p23(fec _q);
 void fec_conv_init_v27p34(fec _q);
 void fec_conv_init_v27p45(fec _q);
@@ -556,6 +852,68 @@ void fec_conv_init_v29p56(fec _q);
 void fec_conv_init_v29p67(fec _q);
 void fec_conv_init_v29p78(fec _q);
 
+// viterbi decoder
+//
+// Soft-decision (8-bit) maximum-likelihood decoder for rate 1/R,
+// constraint length K codes whose polynomials all have their first
+// and last taps set; the path metrics, branch metrics and tie-breaking
+// follow the libfec portable decoders and the SIMD add-compare-select
+// kernels produce identical decisions.
+//  _K          :   constraint length, 3 <= _K <= 15
+//  _R          :   inverse rate, 1 < _R <= 8
+//  _poly       :   polynomials [size: _R x 1]
+//  _num_bits   :   maximum number of decoded bits (excluding tail)
+viterbi viterbi_create(unsigned int _K,
+                       unsigned int _R,
+                       int *        _poly,
+                       unsigned int _num_bits);
+void viterbi_destroy(viterbi _q);
+
+// reset path metrics, favoring starting state _state
+void viterbi_init(viterbi      _q,
+                  unsigned int _state);
+
+// run add-compare-select over _n decoded bits
+//  _syms       :   soft input symbols [size: _R*_n x 1]
+void viterbi_update_blk(viterbi         _q,
+                        unsigned char * _syms,
+                        unsigned int    _n);
+
+// trace back from ending state, writing _n bits (msb first); the
+// K-1 tail bits following the data are skipped
+//  _data       :   decoded bytes [size: ceil(_n/8) x 1]
+void viterbi_chainback(viterbi         _q,
+                       unsigned char * _data,
+                       unsigned int    _n,
+                       unsigned int    _endstate);
+
+// viterbi add-compare-select kernel (see viterbi_kernels.c): advance
+// path metrics one decoded bit, setting decision bit s of _d for each
+// new state s (_d must be cleared by the caller); the vector variants
+// are selected at run time by the SIMD level
+//  _old        :   path metrics at current step [size: _num_states x 1]
+//  _new        :   path metrics at next step [size: _num_states x 1]
+//  _branchtab  :   expected symbols [size: _R x _num_states/2]
+//  _syms       :   soft input symbols [size: _R x 1]
+void liquid_viterbi_acs(uint32_t *            _old,
+                        uint32_t *            _new,
+                        const uint32_t *      _branchtab,
+                        const unsigned char * _syms,
+                        unsigned int          _R,
+                        unsigned int          _num_states,
+                        uint32_t *            _d);
+
+#if HAVE_DOTPROD_AVX
+// x86 AVX2 kernel
+void liquid_viterbi_acs_avx2(uint32_t *            _old,
+                             uint32_t *            _new,
+                             const uint32_t *      _branchtab,
+                             const unsigned char * _syms,
+                             unsigned int          _R,
+                             unsigned int          _num_states,
+                             uint32_t *            _d);
+#endif
+
 // Reed-Solomon
 
 // compute encoded message length for Reed-Solomon codes
@@ -570,6 +928,7 @@ unsigned int fec_rs_get_enc_msg_len(unsigned int _dec_msg_len,
 
 
 fec fec_rs_create(fec_scheme _fs);
+void fec_rs_destroy(fec _q);
 void fec_rs_init_p8(fec _q);
 void fec_rs_setlength(fec _q,
                       unsigned int _dec_msg_len);
@@ -582,6 +941,146 @@ void fec_rs_decode(fec _q,
                    unsigned char * _msg_enc,
                    unsigned char * _msg_dec);
 
+// Reed-Solomon codec
+//
+// Systematic encoder and errors-only decoder for codes with 8-bit
+// symbols, compatible with libfec's init_rs_char(8,_genpoly,_fcs,
+// _prim,_nroots,_pad): blocks carry 255-_pad symbols, the last _nroots
+// of which are parity.
+//  _genpoly    :   field generator polynomial, e.g. 0x11d
+//  _fcs        :   first consecutive root of the code generator (log)
+//  _prim       :   primitive element (log), must be 1
+//  _nroots     :   number of parity symbols
+//  _pad        :   number of implicit leading zero symbols
+rscodec rscodec_create(unsigned int _genpoly,
+                       unsigned int _fcs,
+                       unsigned int _prim,
+                       unsigned int _nroots,
+                       unsigned int _pad);
+void rscodec_destroy(rscodec _q);
+
+// compute parity symbols for message
+//  _data       :   message [size: 255-_pad-_nroots x 1]
+//  _parity     :   parity [size: _nroots x 1]
+void rscodec_encode(rscodec               _q,
+                    const unsigned char * _data,
+                    unsigned char *       _parity);
+
+// correct errors in received block in place, returning the number of
+// corrected symbols, or -1 (block unchanged) when uncorrectable
+//  _block      :   message and parity [size: 255-_pad x 1]
+int rscodec_decode(rscodec         _q,
+                   unsigned char * _block);
+
+#if HAVE_DOTPROD_AVX
+// x86 syndrome kernels (rscodec.avx.c): sixteen lane accumulators for
+// each root using the nibble product tables for alpha^(16*root), and
+// for alpha^(32*root) in the thirty-two lane kernel
+//  _tab16      :   low/high nibble products [size: _nroots x 32]
+//  _tab32      :   low/high nibble products [size: _nroots x 32]
+//  _r          :   received block [size: _n x 1]
+//  _acc        :   lane accumulators [size: _nroots x 16]
+int  liquid_rs_have_ssse3(void);
+void liquid_rs_syndromes_ssse3(const unsigned char * _tab16,
+                               const unsigned char * _r,
+                               unsigned int          _n,
+                               unsigned int          _nroots,
+                               unsigned char *       _acc);
+void liquid_rs_syndromes_avx2(const unsigned char * _tab32,
+                              const unsigned char * _tab16,
+                              const unsigned char * _r,
+                              unsigned int          _n,
+                              unsigned int          _nroots,
+                              unsigned char *       _acc);
+#endif
+
+// LDPC
+
+// compute encoded message length for LDPC codes
+unsigned int fec_ldpc_get_enc_msg_len(fec_scheme   _fs,
+                                      unsigned int _dec_msg_len);
+
+fec fec_ldpc_create(fec_scheme _fs);
+void fec_ldpc_destroy(fec _q);
+void fec_ldpc_encode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char * _msg_dec,
+                     unsigned char * _msg_enc);
+void fec_ldpc_decode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char * _msg_enc,
+                     unsigned char * _msg_dec);
+void fec_ldpc_decode_soft(fec _q,
+                          unsigned int _dec_msg_len,
+                          unsigned char * _msg_enc,
+                          unsigned char * _msg_dec);
+
+// base matrices, n=648 (Z=27) [size: (24-k) x 24]
+extern const signed char fec_ldpc_r12_base[12*24];
+extern const signed char fec_ldpc_r23_base[ 8*24];
+extern const signed char fec_ldpc_r34_base[ 6*24];
+
+// quasi-cyclic LDPC codec
+//
+// The parity-check matrix is defined by a base matrix [size: _mb x _nb]
+// of cyclic shifts (-1 for zero blocks) of the _Z x _Z identity, the
+// last _mb columns of which carry the IEEE 802.11n dual-diagonal
+// parity structure. Bits are packed msb first.
+//  _base       :   base matrix, row-major [size: _mb x _nb]
+//  _mb         :   number of block rows
+//  _nb         :   number of block columns
+//  _Z          :   lifting factor, 2 <= _Z <= LDPCCODEC_MAX_Z
+#define LDPCCODEC_MAX_Z (32)
+ldpccodec ldpccodec_create(const signed char * _base,
+                           unsigned int        _mb,
+                           unsigned int        _nb,
+                           unsigned int        _Z);
+void ldpccodec_destroy(ldpccodec _q);
+
+// get number of information bits (K) and codeword bits (N)
+unsigned int ldpccodec_get_k(ldpccodec _q);
+unsigned int ldpccodec_get_n(ldpccodec _q);
+
+// compute parity bits for message
+//  _msg        :   information bits [size: ceil(K/8) x 1]
+//  _parity     :   parity bits [size: ceil((N-K)/8) x 1]
+void ldpccodec_encode(ldpccodec             _q,
+                      const unsigned char * _msg,
+                      unsigned char *       _parity);
+
+// check codeword (information bits then parity bits, contiguous),
+// returning 1 if all parity checks are satisfied
+int ldpccodec_check(ldpccodec             _q,
+                    const unsigned char * _codeword);
+
+// decode codeword from channel LLRs (positive for bit 0), returning
+// the number of iterations or -1 if the parity checks were not met
+//  _llr            :   channel LLRs [size: N x 1]
+//  _max_iterations :   maximum number of decoder iterations
+//  _msg            :   decoded information bits [size: ceil(K/8) x 1]
+int ldpccodec_decode(ldpccodec       _q,
+                     const int8_t *  _llr,
+                     unsigned int    _max_iterations,
+                     unsigned char * _msg);
+
+// normalized min-sum check-node update of one layer on 8-bit LLRs: for
+// each of _d edges, 32 lanes (one check node each, lanes >= _z unused)
+// of posteriors _Q are updated in place along with check messages _R
+void liquid_ldpc_layer(int8_t *     _Q,
+                       int8_t *     _R,
+                       unsigned int _d,
+                       unsigned int _z);
+#if HAVE_DOTPROD_AVX
+// x86 layer kernels (ldpccodec.avx.c), all 32 lanes
+int  liquid_ldpc_have_ssse3(void);
+void liquid_ldpc_layer_ssse3(int8_t *     _Q,
+                             int8_t *     _R,
+                             unsigned int _d);
+void liquid_ldpc_layer_avx2(int8_t *     _Q,
+                            int8_t *     _R,
+                            unsigned int _d);
+#endif
+
 // phi(x) = -logf( tanhf( x/2 ) )
 float sumproduct_phi(float _x);
 
@@ -603,7 +1102,7 @@ int fec_sumproduct(unsigned int    _m,
 // sum-product algorithm, returns 1 if parity checks, 0 otherwise
 //  _m      :   rows
 //  _n      :   cols
-//  _H      :   sparse binary parity check matrix [size: _m x _n]
+//  _H      :   compressed parity check matrix [size: _m x _n]
 //  _c_hat  :   estimated transmitted signal [size: _n x 1]
 //
 // internal state arrays
@@ -614,7 +1113,7 @@ int fec_sumproduct(unsigned int    _m,
 //  _parity :   _H * _c_hat [size: _m x 1]
 int fec_sumproduct_step(unsigned int    _m,
                         unsigned int    _n,
-                        smatrixb        _H,
+                        smatrixb_csr    _H,
                         unsigned char * _c_hat,
                         float *         _Lq,
                         float *         _Lr,
@@ -631,15 +1130,15 @@ struct fecintlv_plan {
     unsigned int dec_msg_len;
     unsigned int enc_msg_len;
 
-    // fec codec
+    // fec codec (objects are borrowed from the shared pool)
     fec_scheme fs;
-    fec f;
 
     // interleaver
     interleaver q;
 };
 
 // packetizer object
+#define PACKETIZER_CACHE_LEN (3)
 struct packetizer_s {
     unsigned int msg_len;
     unsigned int packet_len;
@@ -654,6 +1153,10 @@ struct packetizer_s {
     unsigned int buffer_len;
     unsigned char * buffer_0;
     unsigned char * buffer_1;
+
+    // packetizers previously replaced by packetizer_recreate(), most
+    // recently used first; kept so that switching back does not allocate
+    packetizer cache[PACKETIZER_CACHE_LEN];
 };
 
 
@@ -669,8 +1172,24 @@ typedef enum {
     LIQUID_FFT_METHOD_RADER,        // Rader's method for FFTs of prime length
     LIQUID_FFT_METHOD_RADER2,       // Rader's method for FFTs of prime length (alternate)
     LIQUID_FFT_METHOD_DFT,          // regular discrete Fourier transform
+    LIQUID_FFT_METHOD_BATCH,        // batch of equal-size transforms (fft_create_plan_many)
+    LIQUID_FFT_METHOD_STOCKHAM,     // Stockham auto-sort (no reordering passes)
+    LIQUID_FFT_METHOD_PRUNED,       // pruned input or output (fft_create_plan_pruned)
+    LIQUID_FFT_METHOD_SPLIT,        // split-complex arrays (fft_create_plan_split)
 } liquid_fft_method;
 
+// shared fft table type
+typedef enum {
+    LIQUID_FFT_TABLE_INDEX_REV=0,       // bit-reversed indices (radix-2)
+    LIQUID_FFT_TABLE_TWIDDLE_RADIX2,    // per-stage twiddle factors, aligned (radix-2)
+    LIQUID_FFT_TABLE_TWIDDLE,           // exp(d*j*2*pi*i/n) (mixed-radix, real-to-complex)
+    LIQUID_FFT_TABLE_RADER_SEQ,         // primitive root sequence (Rader)
+    LIQUID_FFT_TABLE_RADER_R,           // transformed sequence (Rader)
+    LIQUID_FFT_TABLE_RADER2_R,          // transformed sequence (Rader, alternate)
+    LIQUID_FFT_TABLE_DFT,               // dot product objects (DFT)
+    LIQUID_FFT_TABLE_STOCKHAM,          // per-stage roots and twiddle factors (Stockham)
+} liquid_fft_table;
+
 // Macro    :   FFT (internal)
 //  FFT     :   name-mangling macro
 //  T       :   primitive data type
@@ -696,6 +1215,7 @@ FFT(_create_t) FFT(_create_plan_radix2);                        \
 FFT(_create_t) FFT(_create_plan_mixed_radix);                   \
 FFT(_create_t) FFT(_create_plan_rader);                         \
 FFT(_create_t) FFT(_create_plan_rader2);                        \
+FFT(_create_t) FFT(_create_plan_stockham);                      \
                                                                 \
 /* FFT destroy methods */                                       \
 FFT(_destroy_t) FFT(_destroy_plan_dft);                         \
@@ -703,6 +1223,7 @@ FFT(_destroy_t) FFT(_destroy_plan_radix2);                      \
 FFT(_destroy_t) FFT(_destroy_plan_mixed_radix);                 \
 FFT(_destroy_t) FFT(_destroy_plan_rader);                       \
 FFT(_destroy_t) FFT(_destroy_plan_rader2);                      \
+FFT(_destroy_t) FFT(_destroy_plan_stockham);                    \
                                                                 \
 /* FFT execute methods */                                       \
 FFT(_execute_t) FFT(_execute_dft);                              \
@@ -710,6 +1231,7 @@ FFT(_execute_t) FFT(_execute_radix2);                           \
 FFT(_execute_t) FFT(_execute_mixed_radix);                      \
 FFT(_execute_t) FFT(_execute_rader);                            \
 FFT(_execute_t) FFT(_execute_rader2);                           \
+FFT(_execute_t) FFT(_execute_stockham);                         \
                                                                 \
 /* specific codelets for small DFTs */                          \
 FFT(_execute_t) FFT(_execute_dft_2);                            \
@@ -724,6 +1246,16 @@ FFT(_execute_t) FFT(_execute_dft_16);                           \
 /* additional methods */                                        \
 unsigned int FFT(_estimate_mixed_radix)(unsigned int _nfft);    \
                                                                 \
+/* create mixed-radix plan computing _Q transforms of size  */  \
+/* _nfft/_Q followed by _nfft/_Q transforms of size _Q      */  \
+FFT(plan) FFT(_create_plan_mixed_radix_factor)(                 \
+                                    unsigned int _nfft,         \
+                                    TC *         _x,            \
+                                    TC *         _y,            \
+                                    int          _dir,          \
+                                    int          _flags,        \
+                                    unsigned int _Q);           \
+                                                                \
 /* discrete cosine transform (DCT) prototypes */                \
 void FFT(_execute_REDFT00)(FFT(plan) _q);   /* DCT-I   */       \
 void FFT(_execute_REDFT10)(FFT(plan) _q);   /* DCT-II  */       \
@@ -736,11 +1268,50 @@ void FFT(_execute_RODFT10)(FFT(plan) _q);   /* DST-II  */       \
 void FFT(_execute_RODFT01)(FFT(plan) _q);   /* DST-III */       \
 void FFT(_execute_RODFT11)(FFT(plan) _q);   /* DST-IV  */       \
                                                                 \
+/* per-stage twiddle factors of radix-2 transform of size   */  \
+/* 2^_m (see fft_radix4_stage()), allocated aligned         */  \
+TC * FFT(_create_twiddles_radix2)(unsigned int _m, int _dir);   \
+                                                                \
+/* shared, reference-counted tables (see fft_tables.c);     */  \
+/* every table returned must be released exactly once        */  \
+void * FFT(_table_find)(liquid_fft_table _kind,                 \
+                        unsigned int     _n,                    \
+                        int              _dir);                 \
+void * FFT(_table_insert)(liquid_fft_table _kind,               \
+                          unsigned int     _n,                  \
+                          int              _dir,                \
+                          void *           _data);              \
+void FFT(_table_release)(void * _data);                         \
+unsigned int FFT(_table_num_entries)(void);                     \
+unsigned int * FFT(_table_index_rev)(unsigned int _nfft);       \
+TC * FFT(_table_twiddle_radix2)(unsigned int _nfft, int _dir);  \
+TC * FFT(_table_twiddle)(unsigned int _nfft, int _dir);         \
+unsigned int * FFT(_table_rader_seq)(unsigned int _nfft);       \
+                                                                \
+/* batch of equal-size transforms */                            \
+void FFT(_execute_many)(FFT(plan) _q);                          \
+void FFT(_destroy_plan_many)(FFT(plan) _q);                     \
+                                                                \
+/* pruned transforms */                                         \
+void FFT(_execute_pruned_input)(FFT(plan) _q);                  \
+void FFT(_execute_pruned_output)(FFT(plan) _q);                 \
+void FFT(_destroy_plan_pruned)(FFT(plan) _q);                   \
+                                                                \
+/* split-complex transforms */                                  \
+void FFT(_execute_split)(FFT(plan) _q);                         \
+void FFT(_destroy_plan_split)(FFT(plan) _q);                    \
+                                                                \
 /* destroy real-to-real one-dimensional plan */                 \
 void FFT(_destroy_plan_r2r_1d)(FFT(plan) _q);                   \
                                                                 \
 /* print real-to-real one-dimensional plan */                   \
 void FFT(_print_plan_r2r_1d)(FFT(plan) _q);                     \
+                                                                \
+/* real-to-complex/complex-to-real transforms */                \
+void FFT(_execute_r2c)(FFT(plan) _q);                           \
+void FFT(_execute_c2r)(FFT(plan) _q);                           \
+void FFT(_destroy_plan_r2c)(FFT(plan) _q);                      \
+void FFT(_print_plan_r2c)(FFT(plan) _q);                        \
 
 // determine best FFT method based on size
 liquid_fft_method liquid_fft_estimate_method(unsigned int _nfft);
@@ -751,6 +1322,133 @@ int fft_is_radix2(unsigned int _n);
 // miscellaneous functions
 unsigned int fft_reverse_index(unsigned int _i, unsigned int _n);
 
+// largest radix and number of stages of the Stockham transform
+#define LIQUID_FFT_STOCKHAM_MAX_RADIX   (13)
+#define LIQUID_FFT_STOCKHAM_MAX_STAGES  (32)
+
+// relative cost per band bin and sample of the direct evaluation in
+// fft_create_plan_pruned(), against n*log2(n) for a regular transform
+#define LIQUID_FFT_PRUNE_COST_INPUT     (4.0f)
+#define LIQUID_FFT_PRUNE_COST_OUTPUT    (0.5f)
+
+// factor transform size into Stockham stages, returning the number of
+// stages (zero if _n cannot be factored)
+unsigned int fft_stockham_factor(unsigned int   _n,
+                                 unsigned int * _radix);
+
+// radix-4 (radix-2^2) decimation-in-time stage of the internal radix-2
+// transform, operating in place on bit-reversed data: each block of
+// 4*_L values is combined from four consecutive transforms of size _L
+//  _y      :   input/output array [size: _n x 1]
+//  _n      :   transform size
+//  _L      :   sub-transform size
+//  _w      :   stage twiddles [size: 2*_L x 1], W^i followed by W^(2i)
+//              for i in [0,_L) with W = exp(d*j*2*pi/(4*_L))
+//  _dir    :   direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+void fft_radix4_stage(liquid_float_complex * _y,
+                      unsigned int           _n,
+                      unsigned int           _L,
+                      liquid_float_complex * _w,
+                      int                    _dir);
+
+// radix-4 stage of _H interleaved transforms of size _n, value i of
+// transform b at _y[i*_H + b]; the twiddles of each butterfly are
+// loaded once for the whole batch
+void fft_radix4_stage_batch(liquid_float_complex * _y,
+                            unsigned int           _n,
+                            unsigned int           _L,
+                            liquid_float_complex * _w,
+                            unsigned int           _H,
+                            int                    _dir);
+
+#if HAVE_DOTPROD_AVX
+// x86 AVX2/FMA and AVX-512F radix-4 stages (_L at least 4 and 8,
+// respectively) and batched stages (_H a multiple of 4 and 8)
+void fft_radix4_stage_avx2(liquid_float_complex * _y,
+                           unsigned int           _n,
+                           unsigned int           _L,
+                           liquid_float_complex * _w,
+                           int                    _dir);
+void fft_radix4_stage_avx512f(liquid_float_complex * _y,
+                              unsigned int           _n,
+                              unsigned int           _L,
+                              liquid_float_complex * _w,
+                              int                    _dir);
+void fft_radix4_stage_batch_avx2(liquid_float_complex * _y,
+                                 unsigned int           _n,
+                                 unsigned int           _L,
+                                 liquid_float_complex * _w,
+                                 unsigned int           _H,
+                                 int                    _dir);
+void fft_radix4_stage_batch_avx512f(liquid_float_complex * _y,
+                                    unsigned int           _n,
+                                    unsigned int           _L,
+                                    liquid_float_complex * _w,
+                                    unsigned int           _H,
+                                    int                    _dir);
+#endif
+
+// spectral periodogram kernels (see spgram_kernels.c); the vector
+// variants are selected at run time by the SIMD level
+
+// apply window to complex input: _y[i] = _x[i]*_w[i], i in [0,_n)
+void liquid_spgram_window_cf(liquid_float_complex * _x,
+                             float *                _w,
+                             unsigned int           _n,
+                             liquid_float_complex * _y);
+
+// apply window to real input: _y[i] = _x[i]*_w[i], i in [0,_n)
+void liquid_spgram_window_f(float *      _x,
+                            float *      _w,
+                            unsigned int _n,
+                            float *      _y);
+
+// set power spectral density from transform: _psd[i] = |_X[i]|^2
+void liquid_spgram_psd_set(liquid_float_complex * _X,
+                           unsigned int           _n,
+                           float *                _psd);
+
+// update power spectral density from transform with exponential
+// average: _psd[i] = _gamma*_psd[i] + _alpha*|_X[i]|^2
+void liquid_spgram_psd_update(liquid_float_complex * _X,
+                              unsigned int           _n,
+                              float                  _gamma,
+                              float                  _alpha,
+                              float *                _psd);
+
+#if HAVE_DOTPROD_AVX
+// x86 AVX2/FMA and AVX-512F kernels; _set selects liquid_spgram_psd_set()
+// over liquid_spgram_psd_update()
+void liquid_spgram_window_cf_avx2(liquid_float_complex * _x,
+                                  float *                _w,
+                                  unsigned int           _n,
+                                  liquid_float_complex * _y);
+void liquid_spgram_window_cf_avx512f(liquid_float_complex * _x,
+                                     float *                _w,
+                                     unsigned int           _n,
+                                     liquid_float_complex * _y);
+void liquid_spgram_window_f_avx2(float *      _x,
+                                 float *      _w,
+                                 unsigned int _n,
+                                 float *      _y);
+void liquid_spgram_window_f_avx512f(float *      _x,
+                                    float *      _w,
+                                    unsigned int _n,
+                                    float *      _y);
+void liquid_spgram_psd_update_avx2(liquid_float_complex * _X,
+                                   unsigned int           _n,
+                                   float                  _gamma,
+                                   float                  _alpha,
+                                   float *                _psd,
+                                   int                    _set);
+void liquid_spgram_psd_update_avx512f(liquid_float_complex * _X,
+                                      unsigned int           _n,
+                                      float                  _gamma,
+                                      float                  _alpha,
+                                      float *                _psd,
+                                      int                    _set);
+#endif
+
 
 LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_complex)
 
@@ -765,6 +1463,9 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   define FFT_DIR_FORWARD      FFTW_FORWARD
 #   define FFT_DIR_BACKWARD     FFTW_BACKWARD
 #   define FFT_METHOD           FFTW_ESTIMATE
+#   define FFT_CREATE_PLAN_R2C  fftwf_plan_dft_r2c_1d
+#   define FFT_CREATE_PLAN_C2R  fftwf_plan_dft_c2r_1d
+#   define FFT_GET_MEMORY_USAGE(P) (0UL)  // plan memory is internal to fftw
 #else
 #   define FFT_PLAN             fftplan
 #   define FFT_CREATE_PLAN      fft_create_plan
@@ -773,6 +1474,9 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   define FFT_DIR_FORWARD      LIQUID_FFT_FORWARD
 #   define FFT_DIR_BACKWARD     LIQUID_FFT_BACKWARD
 #   define FFT_METHOD           0
+#   define FFT_CREATE_PLAN_R2C  fft_create_plan_r2c_1d
+#   define FFT_CREATE_PLAN_C2R  fft_create_plan_c2r_1d
+#   define FFT_GET_MEMORY_USAGE fft_get_memory_usage
 #endif
 
 
@@ -798,7 +1502,17 @@ float estimate_req_filter_len_Herrmann(float _df,
 
 // fir_farrow
 #define LIQUID_FIRFARROW_DEFINE_INTERNAL_API(FIRFARROW,TO,TC,TI)  \
-void FIRFARROW(_genpoly)(FIRFARROW() _q);
+void FIRFARROW(_genpoly)(FIRFARROW() _q);                           \
+                                                                    \
+/* evaluate Farrow structure at fractional delay _mu on window  */  \
+/* _r [size: h_len x 1] using the branch filters directly       */  \
+void FIRFARROW(_execute_window)(FIRFARROW() _q,                     \
+                                TI *        _r,                     \
+                                float       _mu,                    \
+                                TO *        _y);                    \
+                                                                    \
+/* get pointer to input window [size: h_len x 1]                */  \
+TI * FIRFARROW(_get_window)(FIRFARROW() _q);
 
 LIQUID_FIRFARROW_DEFINE_INTERNAL_API(FIRFARROW_MANGLE_RRRF,
                                      float,
@@ -904,6 +1618,30 @@ LIQUID_IIRFILTSOS_DEFINE_INTERNAL_API(IIRFILTSOS_MANGLE_CCCF,
 
 // firdes : finite impulse response filter design
 
+// filter design cache designer identifiers
+#define LIQUID_FIRDES_CACHE_PROTOTYPE   (1) // key: type, k, m, beta, dt
+#define LIQUID_FIRDES_CACHE_FIRDESPM    (2) // key: firdespm_run() arguments
+
+// look up filter design in cache, copying coefficients to _h and
+// returning 1 if the cache is enabled and holds a matching entry
+//  _designer   :   designer identifier (e.g. LIQUID_FIRDES_CACHE_PROTOTYPE)
+//  _key        :   design parameters [size: _key_len x 1]
+//  _key_len    :   number of design parameters
+//  _h          :   output coefficients [size: _h_len x 1]
+//  _h_len      :   number of coefficients
+int liquid_firdes_cache_lookup(int           _designer,
+                               const float * _key,
+                               unsigned int  _key_len,
+                               float *       _h,
+                               unsigned int  _h_len);
+
+// store filter design in cache if the cache is enabled
+void liquid_firdes_cache_insert(int           _designer,
+                                const float * _key,
+                                unsigned int  _key_len,
+                                const float * _h,
+                                unsigned int  _h_len);
+
 // Find approximate bandwidth adjustment factor rho based on
 // filter delay and desired excess bandwdith factor.
 //
@@ -994,6 +1732,10 @@ void firdespm_init_grid(firdespm _q);
 // compute interpolating polynomial
 void firdespm_compute_interp(firdespm _q);
 
+// update Chebyshev points and barycentric weights for the current
+// extremal set, reusing weights from the previous set where possible
+void firdespm_compute_weights(firdespm _q);
+
 // compute error signal from actual response (interpolator
 // output), desired response, and weights
 void firdespm_compute_error(firdespm _q);
@@ -1049,6 +1791,25 @@ void liquid_cplxpair_cleanup(float complex * _p,
                              unsigned int _n,
                              unsigned int _num_pairs);
 
+// compute frequency response of polyphase all-pass half-band filter
+// (see iirdes_allpass_halfband()) at frequency _f, returning
+//   [ A0(z^2) + z^-1 A1(z^2) ] / 2
+//  _c      :   all-pass coefficients [size: _n x 1]
+//  _n      :   number of coefficients
+//  _f      :   frequency
+float complex iirdes_allpass_halfband_freqresponse(float *      _c,
+                                                   unsigned int _n,
+                                                   float        _f);
+
+// compute group delay of polyphase all-pass half-band filter at
+// frequency _f [samples]
+//  _c      :   all-pass coefficients [size: _n x 1]
+//  _n      :   number of coefficients
+//  _f      :   frequency
+float iirdes_allpass_halfband_groupdelay(float *      _c,
+                                         unsigned int _n,
+                                         float        _f);
+
 // Jacobian elliptic functions (src/filter/src/ellip.c)
 
 // Landen transformation (_n iterations)
@@ -1104,6 +1865,7 @@ void bpacketgen_assemble_header(bpacketgen _q);
 
 // synchronizer
 void bpacketsync_assemble_pnsequence(bpacketsync _q);
+float bpacketsync_correlate_pn(bpacketsync _q, uint64_t _brx);
 void bpacketsync_execute_seekpn(bpacketsync _q, unsigned char _bit);
 void bpacketsync_execute_rxheader(bpacketsync _q, unsigned char _bit);
 void bpacketsync_execute_rxpayload(bpacketsync _q, unsigned char _bit);
@@ -1111,6 +1873,106 @@ void bpacketsync_decode_header(bpacketsync _q);
 void bpacketsync_decode_payload(bpacketsync _q);
 void bpacketsync_reconfig(bpacketsync _q);
 
+//
+// bpresync
+//
+
+// coarse search over all frequency hypotheses using packed sign bits;
+// returns strongest hypothesis index, _conj set if conjugated product
+unsigned int bpresync_cccf_search(bpresync_cccf _q,
+                                  int *         _conj);
+
+//
+// qdetector
+//
+
+// multiply complex arrays: z[i] = x[i] * y[i]
+void qdetector_cccf_cmul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z);
+
+// monotonic time [s] for frameperfstats timing
+double frameperfstats_time();
+
+// add execute-to-callback latency [s] to frameperfstats object
+void frameperfstats_add_latency(frameperfstats_s * _stats,
+                                double             _latency);
+
+// accumulate latency statistics of _src into _dst
+void frameperfstats_merge_latency(frameperfstats_s * _dst,
+                                  frameperfstats_s * _src);
+
+// frametrace hooks: a single branch on a global flag while disabled,
+// nothing at all when configured with --enable-traceoverride
+#if defined LIQUID_TRACEOVERRIDE
+#   define FRAMETRACE(_q,_object,_event,_arg) do { } while (0)
+#else
+extern volatile int frametrace_enabled;
+void frametrace_push(const void * _q,
+                     const char * _object,
+                     int          _event,
+                     int          _arg);
+#   define FRAMETRACE(_q,_object,_event,_arg)                   \
+    do {                                                        \
+        if (frametrace_enabled)                                 \
+            frametrace_push(_q,_object,_event,_arg);            \
+    } while (0)
+#endif
+
+//
+// framequeue : pooled, lock-free queue of received frames
+//
+
+typedef struct framequeue_s * framequeue;
+
+framequeue framequeue_create(unsigned int       _num_slots,
+                             unsigned int       _header_len,
+                             framesync_callback _callback,
+                             void *             _userdata,
+                             int                _thread);
+void framequeue_destroy(framequeue _q);
+
+// (re)configure queued delivery, redirecting the synchronizer's
+// callback and user data to the queue (_num_slots=0: restore them)
+framequeue framequeue_reconfigure(framequeue           _q,
+                                  unsigned int         _num_slots,
+                                  unsigned int         _header_len,
+                                  int                  _thread,
+                                  framesync_callback * _callback,
+                                  void **              _userdata);
+
+unsigned long int framequeue_get_memory_usage(framequeue _q);
+unsigned int      framequeue_get_num_dropped (framequeue _q);
+
+// copy frame into queue; framesync_callback with the queue as user data
+int framequeue_push(unsigned char *  _header,
+                    int              _header_valid,
+                    unsigned char *  _payload,
+                    unsigned int     _payload_len,
+                    int              _payload_valid,
+                    framesyncstats_s _stats,
+                    void *           _userdata);
+int  framequeue_pop(framequeue _q, framesync_frame_s * _frame);
+void framequeue_wait(framequeue _q);
+int  framequeue_is_threaded(framequeue _q);
+
+//
+// framegen_lookahead : background encoding of next frame in a batch
+//
+
+typedef struct framegen_lookahead_s * framegen_lookahead;
+
+// frame encoding function: encode frame '_index' of batch
+typedef void (*framegen_lookahead_callback)(void *       _userdata,
+                                            unsigned int _index);
+
+framegen_lookahead framegen_lookahead_create(framegen_lookahead_callback _encode,
+                                             void *                      _userdata);
+void framegen_lookahead_destroy(framegen_lookahead _q);
+void framegen_lookahead_submit(framegen_lookahead _q, unsigned int _index);
+void framegen_lookahead_wait(framegen_lookahead _q);
+
 
 // 
 // flexframe
@@ -1122,13 +1984,13 @@ void bpacketsync_reconfig(bpacketsync _q);
 // header description
 // NOTE: The flexframe header can be improved with crc24, secded7264, v29
 //       which also generates a 54-byte frame. Improves header decoding
-//       by about 1 dB (99% probability of decoding with SNR = -1 dB);
-//       however this requires that the 'libfec' libraries are installed.
+//       by about 1 dB (99% probability of decoding with SNR = -1 dB).
 #define FLEXFRAME_H_USER    (14)                    // user-defined array
 #define FLEXFRAME_H_DEC     (FLEXFRAME_H_USER+6)    // decoded length
 #define FLEXFRAME_H_CRC     (LIQUID_CRC_32)         // header CRC
 #define FLEXFRAME_H_FEC0    (LIQUID_FEC_SECDED7264) // header FEC (inner)
 #define FLEXFRAME_H_FEC1    (LIQUID_FEC_HAMMING84)  // header FEC (outer)
+#define FLEXFRAME_H_PRECHECK (0.25f)                // header pre-check threshold
 
 
 // 
@@ -1157,6 +2019,7 @@ void bpacketsync_reconfig(bpacketsync _q);
 #define OFDMFLEXFRAME_H_DEC     (OFDMFLEXFRAME_H_USER+6)    // decoded length
 #define OFDMFLEXFRAME_H_CRC     (LIQUID_CRC_32)             // header CRC
 #define OFDMFLEXFRAME_H_FEC     (LIQUID_FEC_GOLAY2412)      // header FEC
+#define OFDMFLEXFRAME_H_PRECHECK (0.25f)                    // header pre-check threshold
 #define OFDMFLEXFRAME_H_ENC     (36)                        // encoded length
 #define OFDMFLEXFRAME_H_MOD     (LIQUID_MODEM_BPSK)         // modulation scheme
 #define OFDMFLEXFRAME_H_BPS     (1)                         // modulation depth
@@ -1178,6 +2041,22 @@ void  liquid_sincosf(float _x,
 float liquid_expf(float _x);
 float liquid_logf(float _x);
 
+// sine and cosine of array by polynomial approximation, for the fast
+// (_coarse=0) and coarse (_coarse=1) tiers of liquid_sincosf_block()
+void liquid_sincosf_block_poly(float *      _theta,
+                               unsigned int _n,
+                               float *      _s,
+                               float *      _c,
+                               int          _coarse);
+#if HAVE_DOTPROD_AVX
+// x86 kernel (math.trig.avx.c)
+void liquid_sincosf_block_avx2(float *      _theta,
+                               unsigned int _n,
+                               float *      _s,
+                               float *      _c,
+                               int          _coarse);
+#endif
+
 // 
 // complex math operations
 //
@@ -1214,7 +2093,20 @@ float liquid_cargf_approx(float complex _z);
 #define LIQUID_MATRIX_DEFINE_INTERNAL_API(MATRIX,T)             \
 T    MATRIX(_det2x2)(T * _x,                                    \
                      unsigned int _rx,                          \
-                     unsigned int _cx);
+                     unsigned int _cx);                         \
+                                                                \
+/* in-place blocked LU factorization with partial pivoting,  */ \
+/* returning the number of zero pivots (see matrix.blocked.c) */ \
+int  MATRIX(_lufactor)(T *            _A,                       \
+                       unsigned int   _n,                       \
+                       unsigned int * _piv);                    \
+                                                                \
+/* solve A*X = B in place from _lufactor() output           */  \
+void MATRIX(_lusolve)(T *            _LU,                       \
+                      unsigned int   _n,                        \
+                      unsigned int * _piv,                      \
+                      T *            _B,                        \
+                      unsigned int   _nrhs);
 
 
 LIQUID_MATRIX_DEFINE_INTERNAL_API(MATRIX_MANGLE_FLOAT,   float)
@@ -1223,6 +2115,32 @@ LIQUID_MATRIX_DEFINE_INTERNAL_API(MATRIX_MANGLE_DOUBLE,  double)
 LIQUID_MATRIX_DEFINE_INTERNAL_API(MATRIX_MANGLE_CFLOAT,  liquid_float_complex)
 LIQUID_MATRIX_DEFINE_INTERNAL_API(MATRIX_MANGLE_CDOUBLE, liquid_double_complex)
 
+// matrix multiply tile kernels (see matrix_kernels.c) used by the
+// cache-blocked multiply and factorizations: dot products of two rows
+// of X with four rows of Y, each of length _n,
+//   _z[4*i+j] = sum_k _x[i][k] * _y[j][k],  i in [0,2), j in [0,4)
+// The vector variants are selected at run time by the SIMD level.
+void liquid_matrixf_dot2x4(float *      _x[2],
+                           float *      _y[4],
+                           unsigned int _n,
+                           float *      _z);
+void liquid_matrixcf_dot2x4(liquid_float_complex * _x[2],
+                            liquid_float_complex * _y[4],
+                            unsigned int           _n,
+                            liquid_float_complex * _z);
+
+#if HAVE_DOTPROD_AVX
+// x86 AVX2/FMA tile kernels, selected for both wide x86 SIMD levels
+void liquid_matrixf_dot2x4_avx2(float *      _x[2],
+                                float *      _y[4],
+                                unsigned int _n,
+                                float *      _z);
+void liquid_matrixcf_dot2x4_avx2(liquid_float_complex * _x[2],
+                                 liquid_float_complex * _y[4],
+                                 unsigned int           _n,
+                                 liquid_float_complex * _z);
+#endif
+
 
 // sparse 'alist' matrix type (similar to MacKay, Davey Lafferty convention)
 // large macro
@@ -1295,6 +2213,16 @@ void MODEM(_init)(MODEM() _q, unsigned int _bits_per_symbol);   \
 /* initialize symbol map for fast modulation */                 \
 void MODEM(_init_map)(MODEM() _q);                              \
                                                                 \
+/* process-wide cache of per-scheme tables (symbol map,     */  \
+/* soft-demodulation neighbors, arbitrary-modem grid):      */  \
+/* acquire attaches cached tables and returns 1 on a hit;   */  \
+/* otherwise the caller generates them and publishes them   */  \
+int  MODEM(_tables_acquire)(MODEM() _q, modulation_scheme _ms); \
+void MODEM(_tables_publish)(MODEM() _q, modulation_scheme _ms); \
+                                                                \
+/* copy shared tables before modifying the constellation */     \
+void MODEM(_tables_unshare)(MODEM() _q);                        \
+                                                                \
 /* generic modem create routines */                             \
 MODEM() MODEM(_create_ask)( unsigned int _bits_per_symbol);     \
 MODEM() MODEM(_create_qam)( unsigned int _bits_per_symbol);     \
@@ -1325,6 +2253,10 @@ MODEM() MODEM(_create_arb128opt)(void);                         \
 MODEM() MODEM(_create_arb256opt)(void);                         \
 MODEM() MODEM(_create_arb64vt)(void);                           \
                                                                 \
+/* build grid index for nearest-point search of arbitrary   */  \
+/* constellation (called once the symbol map is final)      */  \
+void MODEM(_arb_init_grid)(MODEM() _q);                         \
+                                                                \
 /* Scale arbitrary modem energy to unity */                     \
 void MODEM(_arb_scale)(MODEM() _q);                             \
                                                                 \
@@ -1362,6 +2294,12 @@ void MODEM(_demodulate_ook)    ( MODEM(), TC, unsigned int *);  \
 void MODEM(_demodulate_sqam32) ( MODEM(), TC, unsigned int *);  \
 void MODEM(_demodulate_sqam128)( MODEM(), TC, unsigned int *);  \
                                                                 \
+/* modem demodulate block routines */                           \
+void MODEM(_demodulate_apsk_block)(MODEM(),                     \
+                                   const TC *,                  \
+                                   unsigned int,                \
+                                   unsigned int *);             \
+                                                                \
 /* modem demodulate (soft) routines */                          \
 void MODEM(_demodulate_soft_bpsk)(MODEM()         _q,           \
                                   TC              _x,           \
@@ -1375,6 +2313,24 @@ void MODEM(_demodulate_soft_arb)( MODEM()         _q,           \
                                   TC              _x,           \
                                   unsigned int *  _sym_out,     \
                                   unsigned char * _soft_bits);  \
+void MODEM(_demodulate_soft_ask)( MODEM()         _q,           \
+                                  TC              _x,           \
+                                  unsigned int *  _sym_out,     \
+                                  unsigned char * _soft_bits);  \
+void MODEM(_demodulate_soft_qam)( MODEM()         _q,           \
+                                  TC              _x,           \
+                                  unsigned int *  _sym_out,     \
+                                  unsigned char * _soft_bits);  \
+                                                                \
+/* soft-demodulation gamma for BPSK and QPSK, from noise    */  \
+/* variance if set                                          */  \
+T MODEM(_get_soft_gamma_bpsk)(MODEM() _q);                      \
+T MODEM(_get_soft_gamma_qpsk)(MODEM() _q);                      \
+                                                                \
+/* quantize soft bits to object's soft bit precision        */  \
+void MODEM(_quantize_soft_bits)(MODEM()         _q,             \
+                                unsigned char * _soft_bits,     \
+                                unsigned int    _n);            \
                                                                 \
 /* generate soft demodulation look-up table */                  \
 void MODEM(_demodsoft_gentab)(MODEM()      _q,                  \
@@ -1412,12 +2368,149 @@ void MODEM(_demodulate_linear_array_ref)(T              _v,     \
                                          T *            _ref,   \
                                          unsigned int * _s,     \
                                          T *            _res);  \
+                                                                \
+/* Soft-demodulate a Gray-coded linear constellation axis   */  \
+/* using exact max-log bit metrics                          */  \
+/*  _v          :   input value             */                  \
+/*  _m          :   bits per symbol         */                  \
+/*  _alpha      :   scaling factor          */                  \
+/*  _gamma      :   log-likelihood scale    */                  \
+/*  _s          :   demodulated symbol      */                  \
+/*  _v_hat      :   demodulated level       */                  \
+/*  _soft_bits  :   soft bits [size: _m]    */                  \
+void MODEM(_demodulate_soft_pam)(T               _v,            \
+                                 unsigned int    _m,            \
+                                 T               _alpha,        \
+                                 T               _gamma,        \
+                                 unsigned int *  _s,            \
+                                 T *             _v_hat,        \
+                                 unsigned char * _soft_bits);   \
 
 
 
 // define internal modem APIs
 LIQUID_MODEM_DEFINE_INTERNAL_API(LIQUID_MODEM_MANGLE_FLOAT,float,float complex)
 
+// block slicers for linear modems (modem_slicers.c), bit exact with
+// the per-sample demodulators; soft bits are computed only if
+// _soft_bits is not NULL
+//  _x          :   input samples [size: _n x 1]
+//  _n          :   number of samples
+//  _gamma      :   soft-demodulation gamma (LLR = -2 x gamma)
+//  _s          :   output symbols [size: _n x 1]
+//  _soft_bits  :   output soft bits [size: _n*bps x 1]
+void liquid_modem_slice_bpsk(const float complex * _x,
+                             unsigned int          _n,
+                             float                 _gamma,
+                             unsigned int *        _s,
+                             unsigned char *       _soft_bits);
+void liquid_modem_slice_qpsk(const float complex * _x,
+                             unsigned int          _n,
+                             float                 _gamma,
+                             unsigned int *        _s,
+                             unsigned char *       _soft_bits);
+
+// rectangular QAM hard slicer with _m_i in-phase and _m_q quadrature
+// bits and linear-array thresholds _ref
+void liquid_modem_slice_qam(const float complex * _x,
+                            unsigned int          _n,
+                            unsigned int          _m_i,
+                            unsigned int          _m_q,
+                            const float *         _ref,
+                            unsigned int *        _s);
+
+// square 16-QAM and 64-QAM soft slicers specialized for their
+// constellation size; exact max-log soft bits as computed by
+// MODEM(_demodulate_soft_qam)()
+//  _x          :   input samples [size: _n x 1]
+//  _n          :   number of samples
+//  _alpha      :   level spacing (half the distance between levels)
+//  _gamma      :   soft-demodulation gamma
+//  _s          :   output symbols [size: _n x 1]
+//  _soft_bits  :   output soft bits [size: _n*bps x 1]
+void liquid_modem_slice_qam16_soft(const float complex * _x,
+                                   unsigned int          _n,
+                                   float                 _alpha,
+                                   float                 _gamma,
+                                   unsigned int *        _s,
+                                   unsigned char *       _soft_bits);
+void liquid_modem_slice_qam64_soft(const float complex * _x,
+                                   unsigned int          _n,
+                                   float                 _alpha,
+                                   float                 _gamma,
+                                   unsigned int *        _s,
+                                   unsigned char *       _soft_bits);
+#if HAVE_DOTPROD_AVX
+// x86 slicers (modem_slicers.avx.c)
+void liquid_modem_slice_bpsk_avx2(const float complex * _x,
+                                  unsigned int          _n,
+                                  float                 _gamma,
+                                  unsigned int *        _s,
+                                  unsigned char *       _soft_bits);
+void liquid_modem_slice_qpsk_avx2(const float complex * _x,
+                                  unsigned int          _n,
+                                  float                 _gamma,
+                                  unsigned int *        _s,
+                                  unsigned char *       _soft_bits);
+void liquid_modem_slice_qam_avx2(const float complex * _x,
+                                 unsigned int          _n,
+                                 unsigned int          _m_i,
+                                 unsigned int          _m_q,
+                                 const float *         _ref,
+                                 unsigned int *        _s);
+void liquid_modem_slice_qam16_soft_avx2(const float complex * _x,
+                                        unsigned int          _n,
+                                        float                 _alpha,
+                                        float                 _gamma,
+                                        unsigned int *        _s,
+                                        unsigned char *       _soft_bits);
+void liquid_modem_slice_qam64_soft_avx2(const float complex * _x,
+                                        unsigned int          _n,
+                                        float                 _alpha,
+                                        float                 _gamma,
+                                        unsigned int *        _s,
+                                        unsigned char *       _soft_bits);
+#endif
+
+// block phase-difference kernels for freqdem (freqdem_kernels.c)
+#define LIQUID_FREQDEM_NUM_ORDERS   (6)     // polynomial orders 3, 5, ..., 13
+#define LIQUID_FREQDEM_MAX_COEFF    (7)     // coefficients for order 13
+
+// minimax coefficients of the arctangent on [0,1], indexed by (order-3)/2
+extern const float liquid_freqdem_atan_coeff[LIQUID_FREQDEM_NUM_ORDERS][LIQUID_FREQDEM_MAX_COEFF];
+
+// approximate atan2f(_y,_x) with _num_c polynomial coefficients _c
+float liquid_freqdem_atan2f(float         _y,
+                            float         _x,
+                            const float * _c,
+                            unsigned int  _num_c);
+
+// compute scaled phase difference arg(conj(_x_prev[i]) _x[i]) * _scale
+//  _x          :   input samples [size: _n x 1]
+//  _x_prev     :   previous input samples [size: _n x 1]
+//  _n          :   number of samples
+//  _c          :   arctangent polynomial coefficients [size: _num_c x 1]
+//  _num_c      :   number of coefficients
+//  _scale      :   output scaling factor
+//  _m          :   output [size: _n x 1]
+void liquid_freqdem_phase_block(const float complex * _x,
+                                const float complex * _x_prev,
+                                unsigned int          _n,
+                                const float *         _c,
+                                unsigned int          _num_c,
+                                float                 _scale,
+                                float *               _m);
+#if HAVE_DOTPROD_AVX
+// x86 kernel (freqdem_kernels.avx.c)
+void liquid_freqdem_phase_block_avx2(const float complex * _x,
+                                     const float complex * _x_prev,
+                                     unsigned int          _n,
+                                     const float *         _c,
+                                     unsigned int          _num_c,
+                                     float                 _scale,
+                                     float *               _m);
+#endif
+
 // APSK constants (container for apsk structure definitions)
 struct liquid_apsk_s {
     modulation_scheme scheme;   // APSK modulation scheme
@@ -1457,6 +2550,40 @@ extern const float complex modem_arb64opt[64];
 extern const float complex modem_arb128opt[128];
 extern const float complex modem_arb256opt[256];
 
+// continuous-phase modulators (gmskmod, cpfskmod) render each symbol
+// from a table of phase trajectories indexed by the symbols spanned by
+// the pulse, provided the table index needs at most this many bits
+#define LIQUID_CPM_TABLE_MAX_BITS   (12)
+
+// cpfskmod : design transmit frequency pulse with unit area, shared
+// with the non-coherent cpfskdem receiver
+//  _k      :   samples/symbol
+//  _m      :   filter delay (symbols)
+//  _beta   :   filter bandwidth parameter
+//  _type   :   filter type (e.g. LIQUID_CPFSK_SQUARE)
+//  _h      :   output pulse [size: _h_len x 1]
+//  _h_len  :   pulse length
+void cpfskmod_firdes(unsigned int _k,
+                     unsigned int _m,
+                     float        _beta,
+                     int          _type,
+                     float *      _h,
+                     unsigned int _h_len);
+
+// gmskmod : get phase state
+float gmskmod_get_phase(gmskmod _q);
+
+// gmskmod : restore state after modulating symbols from reset without
+// computing output, e.g. following a pre-rendered sequence
+//  _q      :   modulator object
+//  _s      :   symbols modulated since reset [size: _n x 1]
+//  _n      :   number of symbols
+//  _theta  :   phase state after modulating symbols
+void gmskmod_load_state(gmskmod         _q,
+                        unsigned char * _s,
+                        unsigned int    _n,
+                        float           _theta);
+
 
 //
 // MODULE : multichannel
@@ -1488,38 +2615,180 @@ void ofdmframe_init_S1(unsigned char * _p,
                        float complex * _s1,
                        unsigned int *  _M_S1);
 
+// build index tables of pilot and data subcarriers, in fftshift order
+// (from -M/2 to M/2-1) or in natural order if _natural is set
+//  _p          :   subcarrier allocation array
+//  _M          :   total number of subcarriers
+//  _natural    :   list indices in natural rather than fftshift order?
+//  _pilot_idx  :   output pilot subcarrier indices [size: M_pilot x 1], or NULL
+//  _data_idx   :   output data subcarrier indices [size: M_data x 1], or NULL
+void ofdmframe_index_sctype(unsigned char * _p,
+                            unsigned int    _M,
+                            int             _natural,
+                            unsigned int *  _pilot_idx,
+                            unsigned int *  _data_idx);
+
+// build index table (natural order) of the data subcarriers assigned
+// to one user of a multi-user allocation; returns number of indices
+//  _p          :   subcarrier allocation array
+//  _M          :   total number of subcarriers
+//  _user_map   :   user index of each subcarrier
+//  _user       :   user index
+//  _data_idx   :   output data subcarrier indices of user, or NULL
+unsigned int ofdmframe_index_user(unsigned char * _p,
+                                  unsigned int    _M,
+                                  unsigned char * _user_map,
+                                  unsigned int    _user,
+                                  unsigned int *  _data_idx);
+
+// find smallest cyclic band containing all enabled subcarriers
+//  _p      :   subcarrier allocation array
+//  _M      :   total number of subcarriers
+//  _k0     :   output first subcarrier of band
+//  _len    :   output band length (zero if no subcarriers enabled)
+void ofdmframe_sctype_band(unsigned char * _p,
+                           unsigned int    _M,
+                           unsigned int *  _k0,
+                           unsigned int *  _len);
+
+// create transform plan restricted to enabled subcarriers (input
+// pruned for backward, output pruned for forward transform)
+//  _p      :   subcarrier allocation array
+//  _M      :   total number of subcarriers
+//  _x      :   transform input
+//  _y      :   transform output
+//  _dir    :   transform direction
+FFT_PLAN ofdmframe_create_plan(unsigned char * _p,
+                               unsigned int    _M,
+                               float complex * _x,
+                               float complex * _y,
+                               int             _dir);
+
+// tapered overlap-add kernels (ofdmframe_kernels.c): complex samples
+// are passed as interleaved floats with window coefficients duplicated
+//  _x      :   input samples [size: _n x 1]
+//  _p      :   overlapping post-fix samples [size: _n x 1]
+//  _w      :   window applied to _x [size: _n x 1]
+//  _v      :   window applied to _p [size: _n x 1]
+//  _y      :   output, _y[i] = _x[i]*_w[i] + _p[i]*_v[i], [size: _n x 1]
+//  _n      :   number of (real) values
+void liquid_ofdm_taper(const float * _x,
+                       const float * _p,
+                       const float * _w,
+                       const float * _v,
+                       float *       _y,
+                       unsigned int  _n);
+#if HAVE_DOTPROD_AVX
+// x86 kernel (ofdmframe_kernels.avx.c)
+void liquid_ofdm_taper_avx2(const float * _x,
+                            const float * _p,
+                            const float * _w,
+                            const float * _v,
+                            float *       _y,
+                            unsigned int  _n);
+#endif
+
 // generate symbol (add cyclic prefix/postfix, overlap)
 void ofdmframegen_gensymbol(ofdmframegen    _q,
                             float complex * _buffer);
 
+// tapered overlap-add, _y = _x.*_w + _p.*_v, dispatched at run time
+void ofdmframegen_overlap_add(const float * _x,
+                              const float * _p,
+                              const float * _w,
+                              const float * _v,
+                              float *       _y,
+                              unsigned int  _n);
+
+// ensure generator was created for real passband output
+void ofdmframegen_validate_real(ofdmframegen _q,
+                                const char * _method);
+
+// load data and pilot subcarriers of next symbol into _q->X
+void ofdmframegen_load_symbol(ofdmframegen    _q,
+                              float complex * _x);
+
+// map baseband subcarriers in _X to passband bins and compute real
+// time-domain symbol
+void ofdmframegen_passband_transform(ofdmframegen    _q,
+                                     float complex * _X);
+
+// generate real passband symbol (add cyclic prefix/postfix, overlap)
+void ofdmframegen_gensymbol_real(ofdmframegen _q,
+                                 float *      _buffer);
+
 void ofdmframesync_cpcorrelate(ofdmframesync _q);
 void ofdmframesync_findrxypeak(ofdmframesync _q);
 void ofdmframesync_rxpayload(ofdmframesync _q);
 
+// advance state machine by one (baseband) sample
+void ofdmframesync_step(ofdmframesync _q);
+
+// compute subcarrier values in _q->X from the M (baseband) samples of
+// the input buffer starting at _offset
+void ofdmframesync_transform(ofdmframesync _q,
+                             unsigned int  _offset);
+
+// update running autocorrelation with most recent input sample
+void ofdmframesync_autocorr_push(ofdmframesync _q);
+
+// seek PLCP over a block of input samples with the running
+// autocorrelator; returns number of samples consumed
+unsigned int ofdmframesync_seek_block(ofdmframesync   _q,
+                                      float complex * _x,
+                                      unsigned int    _n);
+
 void ofdmframesync_execute_seekplcp(ofdmframesync _q);
+
+// check input level against squelch threshold, updating noise floor;
+// returns 1 if PLCP detection should be skipped
+int ofdmframesync_squelch_update(ofdmframesync _q);
+
+// evaluate transform-based PLCP detector on most recent M samples
+void ofdmframesync_detect_plcp(ofdmframesync _q);
 void ofdmframesync_execute_S0a(ofdmframesync _q);
 void ofdmframesync_execute_S0b(ofdmframesync _q);
 void ofdmframesync_execute_S1( ofdmframesync _q);
 void ofdmframesync_execute_rxsymbols(ofdmframesync _q);
 
+// receive remainder of payload symbol as a block; consumes
+// timer samples of _x, mixing them down and buffering them at once
+void ofdmframesync_execute_rxsymbols_block(ofdmframesync   _q,
+                                           float complex * _x);
+
+// append recovered symbol to batch, invoking batch callback once the
+// batch length has been reached
+void ofdmframesync_batch_push(ofdmframesync _q);
+
+// discard up to _n input samples while skipping symbols; returns
+// number of samples consumed
+unsigned int ofdmframesync_skip_block(ofdmframesync _q,
+                                      unsigned int  _n);
+
+// performance counters (gathered through ofdmflexframesync)
+//  _samples    :   samples processed seeking PLCP, in PLCP, receiving
+//                  symbols [size: 3 x 1]
+//  _passes     :   number of PLCP detection passes
+void ofdmframesync_perf_enable(ofdmframesync _q, int _enable);
+void ofdmframesync_reset_perfcounts(ofdmframesync _q);
+void ofdmframesync_get_perfcounts(ofdmframesync       _q,
+                                  unsigned long int * _samples,
+                                  unsigned long int * _passes);
+
 void ofdmframesync_S0_metrics(ofdmframesync _q,
                               float complex * _G,
                               float complex * _s_hat);
 
 // estimate short sequence gain
-//  _q      :   ofdmframesync object
-//  _x      :   input array (time)
+//  _q      :   ofdmframesync object (transform in _q->X)
 //  _G      :   output gain (freq)
 void ofdmframesync_estimate_gain_S0(ofdmframesync   _q,
-                                    float complex * _x,
                                     float complex * _G);
 
 // estimate long sequence gain
-//  _q      :   ofdmframesync object
-//  _x      :   input array (time)
+//  _q      :   ofdmframesync object (transform in _q->X)
 //  _G      :   output gain (freq)
 void ofdmframesync_estimate_gain_S1(ofdmframesync _q,
-                                    float complex * _x,
                                     float complex * _G);
 
 // estimate complex equalizer gain from G0 and G1
@@ -1537,6 +2806,9 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 void ofdmframesync_rxsymbol(ofdmframesync _q);
 
+// decision-directed per-subcarrier gain tracking
+void ofdmframesync_track_eqgain(ofdmframesync _q);
+
 // 
 // MODULE : nco (numerically-controlled oscillator)
 //
@@ -1552,15 +2824,72 @@ void NCO(_constrain_frequency)(NCO() _q);                       \
 /* compute trigonometric functions for nco/vco type     */      \
 void NCO(_compute_sincos_nco)(NCO() _q);                        \
 void NCO(_compute_sincos_vco)(NCO() _q);                        \
+void NCO(_compute_sincos_interp)(NCO() _q);                     \
+                                                                \
+/* convert between radians and 32-bit phase accumulator */      \
+/* units (LIQUID_NCO_INTERP)                            */      \
+uint32_t NCO(_rad2phase)(T _theta);                             \
+T        NCO(_phase2rad)(uint32_t _phase);                      \
                                                                 \
 /* reset internal phase-locked loop filter              */      \
 void NCO(_pll_reset)(NCO() _q);                                 \
+                                                                \
+/* rotate block up (_dir=1) or down (_dir=-1), stepping */      \
+void NCO(_mix_block)(NCO()        _q,                           \
+                     TC *         _x,                           \
+                     TC *         _y,                           \
+                     unsigned int _n,                           \
+                     int          _dir);                        \
 
 // Define nco internal APIs
 LIQUID_NCO_DEFINE_INTERNAL_API(NCO_MANGLE_FLOAT,
                                float,
                                float complex)
 
+// block mixing kernels for nco (nco_kernels.c)
+#define LIQUID_NCO_MIX_LANES    (8)     // phasors rotated in parallel
+#define LIQUID_NCO_MIX_SEGMENT  (256)   // samples between re-anchoring
+
+// block mixing state: the anchor phasor (phase of the first sample of
+// each segment) is kept in double precision and renormalized as it
+// advances, so single-precision lane phasors can be re-derived from it
+struct liquid_nco_mix_s {
+    double a[2];                        // anchor phasor
+    double s[2];                        // rotation per segment
+    double o[2*LIQUID_NCO_MIX_LANES];   // lane offsets exp{j k dtheta}
+    float  r[2];                        // rotation per iteration
+};
+
+// initialize block mixing state for phase _theta and step _dtheta
+void liquid_nco_mix_init(struct liquid_nco_mix_s * _m,
+                         float                     _theta,
+                         float                     _dtheta);
+
+// compute interleaved lane phasors for the current segment
+// [size: 2*LIQUID_NCO_MIX_LANES x 1] and advance the anchor
+void liquid_nco_mix_segment(struct liquid_nco_mix_s * _m,
+                            float *                   _p);
+
+// rotate samples by exp{j (_theta + i _dtheta)}, i=0.._n-1
+//  _x          :   input samples [size: _n x 1]
+//  _y          :   output samples [size: _n x 1], may equal _x
+//  _n          :   number of samples
+//  _theta      :   phase of first sample
+//  _dtheta     :   phase step
+void liquid_nco_mix_block(const float complex * _x,
+                          float complex *       _y,
+                          unsigned int          _n,
+                          float                 _theta,
+                          float                 _dtheta);
+#if HAVE_DOTPROD_AVX
+// x86 kernel (nco_kernels.avx.c)
+void liquid_nco_mix_block_avx2(const float complex * _x,
+                               float complex *       _y,
+                               unsigned int          _n,
+                               float                 _theta,
+                               float                 _dtheta);
+#endif
+
 // 
 // MODULE : optim (non-linear optimization)
 //
@@ -1591,6 +2920,21 @@ void gradsearch_gradient(utility_function _utility,
                          float            _delta,
                          float *          _gradient);
 
+// compute the gradient of a function at a particular point, evaluating
+// all _n+1 points with a single call to the batched utility
+//  _utility    :   user-defined batched function
+//  _userdata   :   user-defined data object
+//  _x          :   operating point, [size: _n x 1]
+//  _n          :   dimensionality of search
+//  _delta      :   step value for which to compute gradient
+//  _gradient   :   resulting gradient
+void gradsearch_gradient_batch(utility_function_batch _utility,
+                               void  *                _userdata,
+                               float *                _x,
+                               unsigned int           _n,
+                               float                  _delta,
+                               float *                _gradient);
+
 // execute line search; loosely solve:
 //
 //    min|max phi(alpha) := f(_x - alpha*_p)
@@ -1638,6 +2982,10 @@ struct qnsearch_s {
 
     // External utility function.
     utility_function get_utility;
+    gradient_function get_gradient;         // analytic gradient (optional)
+    utility_function_batch get_utility_batch; // batched utility (optional)
+    float * v_batch;    // batched evaluation points
+    float * u_batch;    // batched evaluation utilities
     float utility;      // current utility
     void * userdata;    // userdata pointer passed to utility callback
     int minimize;       // minimize/maximimze utility (search direction)
@@ -1652,6 +3000,10 @@ void qnsearch_normalize_gradient(qnsearch _q);
 // compute Hessian (estimate)
 void qnsearch_compute_Hessian(qnsearch _q);
 
+// compute Hessian (estimate) with a single batched utility call
+void qnsearch_compute_Hessian_batch(qnsearch _q,
+                                    float    _delta);
+
 // compute the updated inverse hessian matrix using the Broyden, Fletcher,
 // Goldfarb & Shanno method (BFGS)
 void qnsearch_update_hessian_bfgs(qnsearch _q);
@@ -1693,8 +3045,14 @@ struct gasearch_s {
     //   - for multiple objectives, utility should be high \em only when
     //         all objectives are met (multiplicative, not additive)
     gasearch_utility get_utility;       // utility function pointer
+    gasearch_utility_batch get_utility_batch;   // batched utility (optional)
     void * userdata;                    // object to optimize
     int minimize;                       // minimize/maximize utility (search direction)
+
+    // parallel evaluation (see gasearch_set_num_threads())
+    unsigned int num_threads;           // number of threads, including caller
+    struct gasearch_pool_s * pool;      // worker thread pool
+    uint64_t rng;                       // selection/mutation generator state
 };
 
 //
@@ -1704,6 +3062,11 @@ struct gasearch_s {
 // evaluate fitness of entire population
 void gasearch_evaluate(gasearch _q);
 
+// evaluate fitness of population slice [_i0, _i1)
+void gasearch_evaluate_range(gasearch     _q,
+                             unsigned int _i0,
+                             unsigned int _i1);
+
 // crossover population
 void gasearch_crossover(gasearch _q);
 
@@ -1724,11 +3087,70 @@ void optim_sort(float *_v,
                 int _descending);
 
 
+//
+// MODULE : quantization
+//
+
+// constants for block companding kernels (compand.c): samples with
+// magnitude below t are scaled linearly by g2, the rest are mapped by
+//  mu-law compress : g1 ln(1 + g0 v)       expand : g1 (exp(g0 v) - 1)
+//  A-law compress  : g1 (1 + ln(g0 v))     expand : g1 exp(g0 v - 1)
+struct liquid_compand_s {
+    liquid_compander_type ctype;    // compander type
+    int   expand;                   // expand (1) or compress (0)
+    float g0, g1, g2, t;
+};
+
+// set up companding constants for parameter _p (mu or A)
+void liquid_compand_init(struct liquid_compand_s * _c,
+                         liquid_compander_type     _ctype,
+                         int                       _expand,
+                         float                     _p);
+
+// compress or expand block of samples, dispatching on SIMD level
+//  _ctype  :   compander type
+//  _expand :   expand (1) or compress (0)
+//  _p      :   companding parameter (mu or A)
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of samples
+//  _y      :   output samples [size: _n x 1], may equal _x
+void liquid_compand_block(liquid_compander_type _ctype,
+                          int                   _expand,
+                          float                 _p,
+                          const float *         _x,
+                          unsigned int          _n,
+                          float *               _y);
+
+// portable block kernel
+void liquid_compand_block_kernel(const struct liquid_compand_s * _c,
+                                 const float *                   _x,
+                                 unsigned int                    _n,
+                                 float *                         _y);
+#if HAVE_DOTPROD_AVX
+// x86 kernel (compand.avx.c)
+void liquid_compand_block_avx2(const struct liquid_compand_s * _c,
+                               const float *                   _x,
+                               unsigned int                    _n,
+                               float *                         _y);
+#endif
+
+
 //
 // MODULE : random
 //
 
-#define randf_inline() ((float) rand() / (float) RAND_MAX)
+// calling thread's generator state behind randf(), randnf(), etc.
+// (seeded on first use, see randf_seed())
+uint64_t * liquid_rand_state(void);
+
+// seed generator state of a new object from the calling thread's
+// generator, so randf_seed() governs the object's default sequence
+#define liquid_rand_seed_object(_state) \
+    randf_seed_r(_state, randu64_r(liquid_rand_state()))
+
+// reentrant 64-bit random word (see randf_r())
+uint64_t randu64_r(uint64_t * _state);
+void randu64_block_r(uint64_t * _state, uint64_t * _y, unsigned int _n);
 
 float complex icrandnf();
 
@@ -1741,6 +3163,20 @@ float randgammaf_delta(float _delta);
 #define LIQUID_SCRAMBLE_MASK2   (0x8b)
 #define LIQUID_SCRAMBLE_MASK3   (0xc5)
 
+// xor _n bytes with a keystream repeating every 32 bytes; both hard
+// (repeated masks) and soft (0x00/0xff per bit, as x^0xff = 255-x)
+// scrambling reduce to this (scramble.c)
+void liquid_scramble_xor(unsigned char *       _x,
+                         unsigned int          _n,
+                         const unsigned char * _key);
+
+#if HAVE_DOTPROD_AVX
+// x86 kernel (scramble.avx.c), returns number of bytes processed
+unsigned int liquid_scramble_xor_avx2(unsigned char *       _x,
+                                      unsigned int          _n,
+                                      const unsigned char * _key);
+#endif
+
 //
 // MODULE : sequence
 //
@@ -1754,6 +3190,10 @@ struct msequence_s {
     unsigned int n;     // length of sequence, n = (2^m)-1
     unsigned int v;     // shift register
     unsigned int b;     // return bit
+
+    // word-parallel stepping: the 32 bits output from state v are
+    // t[v & 0xff] ^ t[256 + (v >> 8)], built on first use
+    unsigned int * t;
 };
 
 // Default msequence generator objects
@@ -1764,6 +3204,19 @@ extern struct msequence_s msequence_default[16];
 // MODULE : utility
 //
 
+// library memory allocation through the user-defined allocator (see
+// liquid_set_allocator()); blocks must be released with liquid_free()
+void * liquid_malloc(size_t _size);
+void * liquid_calloc(size_t _num, size_t _size);
+void * liquid_realloc(void * _ptr, size_t _size);
+void   liquid_free(void * _ptr);
+
+// attach adapter state to flowgraph block, released with _destroy()
+// when the graph is destroyed
+void flowgraph_set_block_state(flowgraph    _g,
+                               unsigned int _id,
+                               void (*_destroy)(void *));
+
 // number of ones in a byte
 //  0   0000 0000   :   0
 //  1   0000 0001   :   1
@@ -1791,12 +3244,26 @@ extern const unsigned char liquid_c_ones[256];
     liquid_c_ones[ ((x)>> 8) & 0xff ] +         \
     liquid_c_ones[ ((x)>>16) & 0xff ])
 
+// 32- and 64-bit words use the compiler's population count where
+// available (a single instruction on targets with popcnt)
+#if defined(__GNUC__)
+#define liquid_count_ones_uint32(x)             \
+    ((unsigned int)__builtin_popcount((uint32_t)(x)))
+
+#define liquid_count_ones_uint64(x)             \
+    ((unsigned int)__builtin_popcountll((uint64_t)(x)))
+#else
 #define liquid_count_ones_uint32(x) (           \
     liquid_c_ones[  (x)      & 0xff ] +         \
     liquid_c_ones[ ((x)>> 8) & 0xff ] +         \
     liquid_c_ones[ ((x)>>16) & 0xff ] +         \
     liquid_c_ones[ ((x)>>24) & 0xff ])
 
+#define liquid_count_ones_uint64(x) (           \
+    liquid_count_ones_uint32((uint64_t)(x)      ) + \
+    liquid_count_ones_uint32((uint64_t)(x) >> 32))
+#endif
+
 
 // number of ones in a byte, modulo 2
 //  0   0000 0000   :   0
@@ -1836,5 +3303,34 @@ extern unsigned int liquid_c_leading_zeros[256];
 
 // byte reversal and manipulation
 extern const unsigned char liquid_reverse_byte_gentab[256];
+
+
+//
+// MODULE : vector
+//
+
+#if HAVE_DOTPROD_AVX
+// x86 AVX2/FMA element-wise kernels (see vectorf.avx.c, vectorcf.avx.c),
+// selected at run time for both wide x86 SIMD levels; arguments are as
+// in LIQUID_VECTOR_DEFINE_API
+#define LIQUID_VECTOR_DEFINE_INTERNAL_API(VECTOR,T,TP)          \
+void VECTOR(_init_avx2)(T _c, T * _x, unsigned int _n);         \
+void VECTOR(_addscalar_avx2)(T * _x, unsigned int _n, T _c,     \
+                             T * _y);                           \
+void VECTOR(_mul_avx2)(T * _x, T * _y, unsigned int _n, T * _z);\
+void VECTOR(_mulscalar_avx2)(T * _x, unsigned int _n, T _c,     \
+                             T * _y);                           \
+void VECTOR(_cexpj_avx2)(TP * _theta, unsigned int _n, T * _x); \
+void VECTOR(_carg_avx2)(T * _x, unsigned int _n, TP * _theta);  \
+void VECTOR(_abs_avx2)(T * _x, unsigned int _n, TP * _y);       \
+
+LIQUID_VECTOR_DEFINE_INTERNAL_API(VECTOR_MANGLE_RF, float,                float)
+LIQUID_VECTOR_DEFINE_INTERNAL_API(VECTOR_MANGLE_CF, liquid_float_complex, float)
+
+// real addition kernel, also used for complex vectors (interleaved
+// components)
+void liquid_vectorf_add_avx2(float * _x, float * _y, unsigned int _n, float * _z);
+#endif
+
 #endif // __LIQUID_INTERNAL_H__
 
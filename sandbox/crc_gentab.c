@@ -21,47 +21,66 @@
  */
 
 //
-// CRC table generator
+// CRC slicing-by-8 table generator; prints src/fec/src/crc_gentab.c
 //
 
 #include <stdio.h>
 #include <stdlib.h>
 
-// generator polynomial
-#define CRC32_POLY 0xEDB88320 // 0x04C11DB7
+#include "liquid.internal.h"
 
-int main() {
-    unsigned int crc;
-    unsigned int mask;
-    unsigned int crcpoly = CRC32_POLY;
-
-    unsigned int crc_gentab[256];
+// print slicing-by-8 tables for reflected (lsb-first) polynomial
+//  _name   :   table name
+//  _poly   :   bit-reversed generator polynomial
+//  _width  :   number of hex digits per table entry
+void crc_gentab_print(const char * _name,
+                      unsigned int _poly,
+                      unsigned int _width)
+{
+    unsigned int tab[8][256];
+    unsigned int i, j, k;
 
-    // generate table
-    unsigned int i, j;
+    // first table: single byte, one bit at a time
     for (i=0; i<256; i++) {
-        crc = i;
-        for (j=0; j<8; j++) {
-            mask = -(crc & 0x01);
-            crc = (crc >> 1) ^ (crcpoly & mask);
-        }
-        crc_gentab[i] = crc;
+        unsigned int crc = i;
+        for (j=0; j<8; j++)
+            crc = (crc >> 1) ^ (_poly & -(crc & 1));
+        tab[0][i] = crc;
     }
 
-    printf("\n");
-    printf("unsigned char crc_gentab[%u] = {\n    ", 256);
-    for (i=0; i<256; i++) {
-        printf("0x%.2x", crc_gentab[i]);
-        if (i==255)
-            printf("};\n");
-        else if (((i+1)%8)==0)
-            printf(",\n    ");
-        else
-            printf(", ");
+    // remaining tables: byte followed by k zero bytes
+    for (k=1; k<8; k++) {
+        for (i=0; i<256; i++)
+            tab[k][i] = tab[0][tab[k-1][i] & 0xff] ^ (tab[k-1][i] >> 8);
     }
 
-    // test it...
+    printf("const unsigned int %s[8][256] = {\n", _name);
+    for (k=0; k<8; k++) {
+        printf("  {");
+        for (i=0; i<256; i++) {
+            if ((i % 8) == 0)
+                printf("\n    ");
+            printf("0x%.*x%s", _width, tab[k][i], i==255 ? "" : ", ");
+        }
+        printf("\n  }%s\n", k==7 ? "" : ",");
+    }
+    printf("};\n\n");
+}
+
+int main() {
+    printf("//\n");
+    printf("// cyclic redundancy check slicing-by-8 tables (generated by\n");
+    printf("// sandbox/crc_gentab)\n");
+    printf("//\n");
+    printf("// table k holds the register contribution of a byte followed by k zero\n");
+    printf("// bytes for the bit-reversed generator polynomial\n");
+    printf("//\n\n");
+
+    crc_gentab_print("crc8_gentab",  liquid_reverse_byte_gentab[CRC8_POLY],  2);
+    crc_gentab_print("crc16_gentab", liquid_reverse_uint16(CRC16_POLY),      4);
+    crc_gentab_print("crc24_gentab", liquid_reverse_uint24(CRC24_POLY),      6);
+    crc_gentab_print("crc32_gentab", liquid_reverse_uint32(CRC32_POLY),      8);
+    crc_gentab_print("crc32c_gentab",liquid_reverse_uint32(CRC32C_POLY),     8);
 
     return 0;
 }
-
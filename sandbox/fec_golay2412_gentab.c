@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Golay(24,12) encoder/syndrome-decoder table generator; prints
+// src/fec/src/fec_golay2412_gentab.c
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+// algebraic decoding of syndrome vector [Lin:2004], returning estimated
+// error vector
+unsigned int golay2412_estimate_ehat(unsigned int _s)
+{
+    // step 2: w(s) <= 3, e_hat = [s 0(12)]
+    if (liquid_count_ones_uint16(_s) <= 3)
+        return (_s << 12) & 0xfff000;
+
+    // step 3: search for p[i] s.t. w(s+p[i]) <= 2
+    int s_index = golay2412_parity_search(_s);
+    if (s_index >= 0)
+        return ((_s ^ golay2412_P[s_index]) << 12) | (1 << (11-s_index));
+
+    // step 4: compute s*P
+    unsigned int sP = golay2412_matrix_mul(_s, golay2412_P, 12);
+
+    // step 5: w(s*P) in [2,3], e_hat = [0(12) s*P]
+    unsigned int wsP = liquid_count_ones_uint16(sP);
+    if (wsP == 2 || wsP == 3)
+        return sP;
+
+    // step 6: search for p[i] s.t. w(s*P + p[i]) == 2
+    int sP_index = golay2412_parity_search(sP);
+    if (sP_index >= 0)
+        return (1 << (23-sP_index)) | (sP ^ golay2412_P[sP_index]);
+
+    // step 7: decoding error
+    return 0;
+}
+
+// print table of values
+void golay2412_gentab_print(const char *   _decl,
+                            unsigned int * _v,
+                            unsigned int   _n,
+                            unsigned int   _width)
+{
+    unsigned int i;
+    printf("%s = {", _decl);
+    for (i=0; i<_n; i++) {
+        if ((i % 8) == 0)
+            printf("\n    ");
+        printf("0x%.*x%s", _width, _v[i], i==_n-1 ? "" : ", ");
+    }
+    printf("};\n\n");
+}
+
+int main() {
+    unsigned int enc0[256];
+    unsigned int enc1[16];
+    unsigned int syn[3*256];
+    unsigned int dec[4096];
+    unsigned int i, k;
+
+    // encoder is linear: codeword is sum of contributions from low
+    // byte and high nibble of the 12-bit message
+    for (i=0; i<256; i++) enc0[i] = golay2412_matrix_mul(i,    golay2412_Gt, 24);
+    for (i=0; i<16;  i++) enc1[i] = golay2412_matrix_mul(i<<8, golay2412_Gt, 24);
+
+    // syndrome contributions from each byte of the 24-bit received word
+    for (k=0; k<3; k++) {
+        for (i=0; i<256; i++)
+            syn[256*k+i] = golay2412_matrix_mul(i << (8*k), golay2412_H, 12);
+    }
+
+    // message correction (last 12 bits of error vector) for each syndrome
+    for (i=0; i<4096; i++)
+        dec[i] = golay2412_estimate_ehat(i) & 0x0fff;
+
+    printf("//\n");
+    printf("// Golay(24,12) generated tables (generated by\n");
+    printf("// sandbox/fec_golay2412_gentab)\n");
+    printf("//\n\n");
+
+    printf("// encoding tables: v = enc0[m & 0xff] ^ enc1[m >> 8]\n");
+    golay2412_gentab_print("const unsigned int golay2412_enc0_gentab[256]", enc0, 256, 6);
+    golay2412_gentab_print("const unsigned int golay2412_enc1_gentab[16]",  enc1, 16,  6);
+
+    printf("// syndrome tables: s = syn[0][r&0xff] ^ syn[1][(r>>8)&0xff] ^ syn[2][r>>16]\n");
+    printf("const unsigned short int golay2412_syn_gentab[3][256] = {\n");
+    for (k=0; k<3; k++) {
+        printf("  {");
+        for (i=0; i<256; i++) {
+            if ((i % 8) == 0)
+                printf("\n    ");
+            printf("0x%.3x%s", syn[256*k+i], i==255 ? "" : ", ");
+        }
+        printf("\n  }%s\n", k==2 ? "" : ",");
+    }
+    printf("};\n\n");
+
+    printf("// message correction for each 12-bit syndrome: m = (r ^ dec[s]) & 0xfff\n");
+    golay2412_gentab_print("const unsigned short int golay2412_dec_gentab[4096]", dec, 4096, 3);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// SEC-DED parity/syndrome table generator; prints
+// src/fec/src/fec_secded_gentab.c
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+// print parity and error-location tables for SEC-DED code
+//  _name   :   code name, e.g. "secded7264"
+//  _P      :   parity matrix [_m x _k bytes]
+//  _w1     :   syndrome vectors for errors of weight 1 [size: _n x 1]
+//  _k      :   number of message bytes
+//  _m      :   number of parity bits
+//  _n      :   number of encoded bits
+void secded_gentab_print(const char *    _name,
+                         unsigned char * _P,
+                         unsigned char * _w1,
+                         unsigned int    _k,
+                         unsigned int    _m,
+                         unsigned int    _n)
+{
+    unsigned int i, j, b;
+
+    // parity contribution of each message byte
+    printf("const unsigned char %s_parity_gentab[%u][256] = {\n", _name, _k);
+    for (j=0; j<_k; j++) {
+        printf("  {");
+        for (b=0; b<256; b++) {
+            unsigned char parity = 0x00;
+            for (i=0; i<_m; i++) {
+                parity <<= 1;
+                parity |= liquid_c_ones[ _P[_k*i+j] & b ] & 0x01;
+            }
+            if ((b % 8) == 0)
+                printf("\n    ");
+            printf("0x%.2x%s", parity, b==255 ? "" : ", ");
+        }
+        printf("\n  }%s\n", j==_k-1 ? "" : ",");
+    }
+    printf("};\n\n");
+
+    // error location for each syndrome (0xff: no weight-1 match)
+    unsigned int num_syndromes = 1 << _m;
+    unsigned char loc[256];
+    for (i=0; i<num_syndromes; i++)
+        loc[i] = 0xff;
+    for (i=0; i<_n; i++)
+        loc[_w1[i]] = i;
+
+    printf("const unsigned char %s_errloc_gentab[%u] = {", _name, num_syndromes);
+    for (i=0; i<num_syndromes; i++) {
+        if ((i % 8) == 0)
+            printf("\n    ");
+        printf("0x%.2x%s", loc[i], i==num_syndromes-1 ? "" : ", ");
+    }
+    printf("};\n\n");
+}
+
+int main() {
+    printf("//\n");
+    printf("// SEC-DED generated tables (generated by sandbox/fec_secded_gentab)\n");
+    printf("//\n");
+    printf("// parity table k holds the parity contribution of message byte k;\n");
+    printf("// error location table maps each syndrome to the bit index of a\n");
+    printf("// single error, or 0xff if the syndrome does not match any error of\n");
+    printf("// weight one\n");
+    printf("//\n\n");
+
+    secded_gentab_print("secded2216", secded2216_P, secded2216_syndrome_w1, 2, 6, 22);
+    secded_gentab_print("secded3932", secded3932_P, secded3932_syndrome_w1, 4, 7, 39);
+    secded_gentab_print("secded7264", secded7264_P, secded7264_syndrome_w1, 8, 8, 72);
+
+    return 0;
+}
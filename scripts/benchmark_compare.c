@@ -23,18 +23,22 @@
 // 
 // benchmark_compare.c
 // 
-// compare benchmark runs
+// compare benchmark runs; files may be in any of the formats exported
+// by the benchmark program (text, csv or json)
 //
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <getopt.h>
 
 // print usage/help message
 void usage()
 {
-    printf("benchmark_compare [old_benchmark] [new_benchmark]\n");
+    printf("benchmark_compare [-t threshold] [old_benchmark] [new_benchmark]\n");
+    printf("  -t[PERCENT]   report benchmarks whose cycles/trial increased by more\n");
+    printf("                than this amount and exit with status 1 if any did\n");
 }
 
 // define benchmark_t
@@ -84,33 +88,62 @@ void readline(FILE * _fid,
 // is line a comment?
 int line_is_comment(char * _buffer);
 
+// parse single line of a results file (text, csv or json), returning 1
+// if a benchmark was found
+int parse_line(char * _buffer,
+               char * _name,
+               float * _cycles_per_trial);
+
+// print benchmarks whose cycles/trial increased by more than the
+// threshold (fraction), returning the number of regressions
+unsigned int benchlist_regressions(benchlist _q,
+                                   float     _threshold);
+
 int main(int argc, char*argv[])
 {
-    if (argc != 3) {
+    float threshold = -1.0f;    // regression threshold (disabled)
+
+    int dopt;
+    while ((dopt = getopt(argc,argv,"ht:")) != EOF) {
+        switch (dopt) {
+        case 'h': usage(); return 0;
+        case 't': threshold = 0.01f*atof(optarg); break;
+        default:
+            usage();
+            exit(1);
+        }
+    }
+
+    if (argc - optind != 2) {
         usage();
         exit(1);
     }
 
     // parse old benchmarks
     benchlist benchmarks_old = benchlist_create();
-    parse_file(argv[1], benchmarks_old);
+    parse_file(argv[optind], benchmarks_old);
     //benchlist_print(benchmarks_old);
 
     // parse new benchmarks
     benchlist benchmarks_new = benchlist_create();
-    parse_file(argv[2], benchmarks_new);
+    parse_file(argv[optind+1], benchmarks_new);
     //benchlist_print(benchmarks_new);
 
     // link benchmarks and print results
     benchlist_link(benchmarks_old, benchmarks_new);
     benchlist_print(benchmarks_old);
 
+    // check for regressions
+    unsigned int num_regressions = 0;
+    if (threshold >= 0.0f)
+        num_regressions = benchlist_regressions(benchmarks_old, threshold);
+
     // destroy benchmark lists
     benchlist_destroy(benchmarks_old);
     benchlist_destroy(benchmarks_new);
 
     printf("done.\n");
-    return 0;
+    return num_regressions > 0 ? 1 : 0;
 }
 
 // 
@@ -197,6 +230,33 @@ void benchlist_print(benchlist _q)
 }
 #endif
 
+unsigned int benchlist_regressions(benchlist _q,
+                                   float     _threshold)
+{
+    unsigned int i;
+    unsigned int num_compared    = 0;
+    unsigned int num_regressions = 0;
+    printf("regressions (threshold %.1f %%):\n", 100*_threshold);
+    for (i=0; i<_q->num_benchmarks; i++) {
+        if (_q->benchmarks[i].link == NULL)
+            continue;
+
+        num_compared++;
+        float cycles_old = _q->benchmarks[i].cycles_per_trial;
+        float cycles_new = _q->benchmarks[i].link->cycles_per_trial;
+        if (cycles_new <= cycles_old*(1.0f + _threshold))
+            continue;
+
+        printf("  - %-28s %12.2f -> %12.2f cycles/trial (%+7.1f %%)\n",
+                _q->benchmarks[i].name, cycles_old, cycles_new,
+                100.0f*(cycles_new - cycles_old)/cycles_old);
+        num_regressions++;
+    }
+    printf("%u of %u benchmarks regressed (%u not found in both files)\n",
+            num_regressions, num_compared, _q->num_benchmarks - num_compared);
+    return num_regressions;
+}
+
 void benchlist_append(benchlist _q,
                       char * _name,
                       float _cycles_per_trial)
@@ -260,32 +320,21 @@ int parse_file(const char * _filename,
     }
 
     printf("parsing '%s'...\n", _filename);
-    char buffer[256];   // line buffer
+    char buffer[512];   // line buffer
 
-    int id;
     char name[64];
-    unsigned long int num_trials;
-    float execution_time;
-    float rate;
     float cycles_per_trial;
 
     do {
         // read line into buffer
-        readline(fid, buffer, 256);
+        readline(fid, buffer, 512);
 
         // skip comment lines
         if (line_is_comment(buffer))
             continue;
 
         // scan line for results
-        int results = sscanf(buffer,"%d %s %lu %f %f %f\n",
-                             &id,
-                             name,
-                             &num_trials,
-                             &execution_time,
-                             &rate,
-                             &cycles_per_trial);
-        if (results < 6) {
+        if (!parse_line(buffer, name, &cycles_per_trial)) {
             //fprintf(stderr,"warning: skipping line '%s'\n", buffer);
             continue;
         }
@@ -303,6 +352,37 @@ int parse_file(const char * _filename,
 }
 
 
+int parse_line(char * _buffer,
+               char * _name,
+               float * _cycles_per_trial)
+{
+    int id;
+    unsigned long int num_trials;
+    float execution_time;
+    float rate;
+
+    // json: one benchmark object per line
+    char * p = strstr(_buffer, "\"name\": \"");
+    if (p != NULL) {
+        char * q = strstr(_buffer, "\"cycles_per_trial\": ");
+        return q != NULL &&
+               sscanf(p + strlen("\"name\": \""), "%63[^\"]", _name) == 1 &&
+               sscanf(q + strlen("\"cycles_per_trial\": "), "%f", _cycles_per_trial) == 1;
+    }
+
+    // csv
+    if (strchr(_buffer, ',') != NULL) {
+        return sscanf(_buffer,"%d,%63[^,],%lu,%f,%f,%f",
+                      &id, _name, &num_trials, &execution_time, &rate,
+                      _cycles_per_trial) == 6;
+    }
+
+    // text
+    return sscanf(_buffer,"%d %63s %lu %f %f %f",
+                  &id, _name, &num_trials, &execution_time, &rate,
+                  _cycles_per_trial) == 6;
+}
+
 // read line from file
 //  _fid    :   input file
 //  _buffer :   output buffer
@@ -57,3 +57,31 @@ void benchmark_agc_crcf(struct rusage *     _start,
     agc_crcf_destroy(q);
 }
 
+
+// block mode, gain updated once per 32 samples
+void benchmark_agc_crcf_block(struct rusage *     _start,
+                              struct rusage *     _finish,
+                              unsigned long int * _num_iterations)
+{
+    unsigned int i;
+
+    // initialize AGC object
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q,0.05f);
+    agc_crcf_set_block_len(q,32);
+
+    float complex x[256];       // input samples
+    float complex y[256];       // output samples
+    for (i=0; i<256; i++)
+        x[i] = 1e-6f;
+
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        agc_crcf_execute_block(q, x, 256, y);
+    getrusage(RUSAGE_SELF, _finish);
+
+    *_num_iterations *= 256;
+
+    // destroy object
+    agc_crcf_destroy(q);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include "liquid.h"
+
+// helper function to keep code base small
+//  _M          :   number of channels
+//  _block_len  :   sub-block length
+//  _bank       :   use bank (1) or independent agc objects (0)
+void agcbank_crcf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _M,
+                        unsigned int        _block_len,
+                        int                 _bank)
+{
+    unsigned int n = 64;    // samples per channel per call
+    unsigned int i, k;
+
+    // normalize number of iterations
+    *_num_iterations /= n*_M;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create objects
+    agcbank_crcf q = agcbank_crcf_create(_M);
+    agcbank_crcf_set_bandwidth(q, 0.05f);
+    agcbank_crcf_set_block_len(q, _block_len);
+    agc_crcf agc[_M];
+    for (k=0; k<_M; k++) {
+        agc[k] = agc_crcf_create();
+        agc_crcf_set_bandwidth(agc[k], 0.05f);
+        agc_crcf_set_block_len(agc[k], _block_len);
+    }
+
+    // channel-interleaved input
+    float complex * x = (float complex*) malloc(n*_M*sizeof(float complex));
+    float complex * y = (float complex*) malloc(n*_M*sizeof(float complex));
+    float complex xk[n];
+    float complex yk[n];
+    for (i=0; i<n*_M; i++)
+        x[i] = 1e-3f * cexpf(_Complex_I*0.1f*i);
+
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_bank) {
+            agcbank_crcf_execute(q, x, n, y);
+        } else {
+            // de-interleave, run each channel, re-interleave
+            unsigned int j;
+            for (k=0; k<_M; k++) {
+                for (j=0; j<n; j++)
+                    xk[j] = x[j*_M+k];
+                agc_crcf_execute_block(agc[k], xk, n, yk);
+                for (j=0; j<n; j++)
+                    y[j*_M+k] = yk[j];
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n*_M;
+
+    // destroy objects
+    agcbank_crcf_destroy(q);
+    for (k=0; k<_M; k++)
+        agc_crcf_destroy(agc[k]);
+    free(x);
+    free(y);
+}
+
+#define AGCBANK_CRCF_BENCHMARK_API(M,BLOCK_LEN,BANK)    \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ agcbank_crcf_bench(_start, _finish, _num_iterations, M, BLOCK_LEN, BANK); }
+
+// per-sample gain update
+void benchmark_agcbank_crcf_M16_agc     AGCBANK_CRCF_BENCHMARK_API(16,  0, 0)
+void benchmark_agcbank_crcf_M16         AGCBANK_CRCF_BENCHMARK_API(16,  0, 1)
+
+// gain updated once per 16 samples
+void benchmark_agcbank_crcf_M16_b16_agc AGCBANK_CRCF_BENCHMARK_API(16, 16, 0)
+void benchmark_agcbank_crcf_M16_b16     AGCBANK_CRCF_BENCHMARK_API(16, 16, 1)
+void benchmark_agcbank_crcf_M64_b16_agc AGCBANK_CRCF_BENCHMARK_API(64, 16, 0)
+void benchmark_agcbank_crcf_M64_b16     AGCBANK_CRCF_BENCHMARK_API(64, 16, 1)
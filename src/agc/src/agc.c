@@ -47,17 +47,23 @@ struct AGC(_s) {
 
     // AGC locked flag
     int is_locked;
+
+    // block mode: sub-block length (0: update gain per sample)
+    unsigned int block_len;
 };
 
 // create agc object
 AGC() AGC(_create)(void)
 {
     // create object and initialize to default parameters
-    AGC() _q = (AGC()) malloc(sizeof(struct AGC(_s)));
+    AGC() _q = (AGC()) liquid_malloc(sizeof(struct AGC(_s)));
 
     // initialize bandwidth
     AGC(_set_bandwidth)(_q, AGC_DEFAULT_BW);
 
+    // update gain per sample
+    _q->block_len = 0;
+
     // reset object
     AGC(_reset)(_q);
 
@@ -69,7 +75,7 @@ AGC() AGC(_create)(void)
 void AGC(_destroy)(AGC() _q)
 {
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print agc object internals
@@ -121,6 +127,51 @@ void AGC(_execute)(AGC() _q,
         _q->g = 1e6f;
 }
 
+// execute automatic gain control on sub-block of samples: the
+// energy is measured once over the sub-block, the loop is advanced
+// by _n samples at once, and the gain is ramped linearly from its
+// current to its updated value across the sub-block
+//  _q      : automatic gain control object
+//  _x      : input data array, [size: _n x 1]
+//  _n      : number of input, output samples
+//  _y      : output data array, [size: _n x 1]
+static void AGC(_execute_subblock)(AGC()        _q,
+                                   TC *         _x,
+                                   unsigned int _n,
+                                   TC *         _y)
+{
+    // output signal energy at current gain
+#if TC_COMPLEX
+    T x2 = liquid_sumsqcf(_x, _n);
+#else
+    T x2 = liquid_sumsqf(_x, _n);
+#endif
+    T y2 = x2 * _q->g * _q->g / (T)_n;
+
+    // advance single-pole energy filter by _n samples of y2
+    _q->y2_prime = y2 + powf(1.0f - _q->alpha, (float)_n) * (_q->y2_prime - y2);
+
+    // update gain according to output energy, limiting the step to
+    // a full correction to keep the loop stable for long sub-blocks
+    T g0 = _q->g;
+    if (!_q->is_locked) {
+        T a = _q->alpha * (T)_n;
+        if (a > 1.0f) a = 1.0f;
+        if (_q->y2_prime > 1e-6f)
+            _q->g *= expf( -0.5f*a*logf(_q->y2_prime) );
+
+        // clamp to 120 dB gain
+        if (_q->g > 1e6f)
+            _q->g = 1e6f;
+    }
+
+    // apply gain ramp
+    T dg = (_q->g - g0) / (T)_n;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = _x[i] * (g0 + (T)(i+1)*dg);
+}
+
 // execute automatic gain control on block of samples
 //  _q      : automatic gain control object
 //  _x      : input data array, [size: _n x 1]
@@ -132,8 +183,71 @@ void AGC(_execute_block)(AGC()        _q,
                          TC *         _y)
 {
     unsigned int i;
-    for (i=0; i<_n; i++)
-        AGC(_execute)(_q, _x[i], &_y[i]);
+    if (_q->block_len == 0) {
+        for (i=0; i<_n; i++)
+            AGC(_execute)(_q, _x[i], &_y[i]);
+        return;
+    }
+
+    for (i=0; i<_n; i+=_q->block_len) {
+        unsigned int n = _n - i < _q->block_len ? _n - i : _q->block_len;
+        if (n == 1)
+            AGC(_execute)(_q, _x[i], &_y[i]);
+        else
+            AGC(_execute_subblock)(_q, &_x[i], n, &_y[i]);
+    }
+}
+
+// execute automatic gain control on block of 16-bit integer samples
+// (interleaved I/Q pairs for complex inputs); each run of whole
+// sub-blocks is widened into the output array while still in cache
+// and the gain applied in place
+//  _q      : automatic gain control object
+//  _x      : input data array, [size: _n x 1 (2_n x 1 for complex)]
+//  _n      : number of input, output samples
+//  _scale  : input scaling factor
+//  _y      : output data array, [size: _n x 1]
+#if TC_COMPLEX
+void AGC(_execute_block_ci16)(AGC()           _q,
+#else
+void AGC(_execute_block_s16)(AGC()           _q,
+#endif
+                              const int16_t * _x,
+                              unsigned int    _n,
+                              float           _scale,
+                              TC *            _y)
+{
+    // run length: whole sub-blocks so that gain updates fall on the
+    // same samples as execute_block() over the full array
+    unsigned int num = 256;
+    if (_q->block_len > 0)
+        num = _q->block_len * (_q->block_len < 256 ? 256 / _q->block_len : 1);
+
+    unsigned int i;
+    for (i=0; i<_n; i+=num) {
+        unsigned int n = _n - i < num ? _n - i : num;
+#if TC_COMPLEX
+        liquid_vectorcf_from_ci16(&_x[2*i], n, _scale, &_y[i]);
+#else
+        liquid_vectorf_from_s16(&_x[i], n, _scale, &_y[i]);
+#endif
+        AGC(_execute_block)(_q, &_y[i], n, &_y[i]);
+    }
+}
+
+// get sub-block length for execute_block()
+unsigned int AGC(_get_block_len)(AGC() _q)
+{
+    return _q->block_len;
+}
+
+// set sub-block length for execute_block()
+//  _q          :   agc object
+//  _block_len  :   samples per gain update (0: every sample)
+void AGC(_set_block_len)(AGC()        _q,
+                         unsigned int _block_len)
+{
+    _q->block_len = _block_len;
 }
 
 // lock agc
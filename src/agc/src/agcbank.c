@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Multi-channel automatic gain control with per-channel squelch,
+// operating on channel-interleaved blocks (e.g. firpfbch2 output);
+// per-channel state is held in arrays indexed by channel so that each
+// update is a loop across channels
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// automatic squelch noise floor: lower quartile of each channel's
+// signal level over an effective memory of this many execute() calls
+#define AGCBANK_SQUELCH_QUANTILE    (0.25f)
+#define AGCBANK_SQUELCH_MEMORY      (64)
+
+// agcbank structure object
+struct AGCBANK(_s) {
+    unsigned int num_channels;  // number of channels, M
+
+    // gain control loop filter parameters
+    float bandwidth;            // bandwidth-time constant
+    T alpha;                    // feed-back gain
+
+    // block mode: sub-block length (0: update gain per sample)
+    unsigned int block_len;
+
+    // per-channel state [size: M x 1]
+    T * g;                      // current gain
+    T * y2_prime;               // filtered output signal energy estimate
+    T * g0;                     // gain at start of sub-block
+    T * dg;                     // gain ramp step across sub-block
+    T * x2;                     // sub-block input energy
+
+    // squelch
+    int            squelch_enabled;     // squelch enabled flag
+    float          squelch_threshold;   // squelch threshold [dB]
+    unsigned int   squelch_timeout;     // hold time after drop [samples]
+    unsigned int * squelch_timer;       // remaining hold time [size: M x 1]
+    int *          squelch_status;      // channel active flag [size: M x 1]
+    noisefloor *   squelch_floor;       // noise floors, automatic threshold
+                                        // (NULL: absolute) [size: M x 1]
+};
+
+// update gain once for each channel from its sub-block energy and
+// compute the gain ramp, as agc's sub-block update
+//  _q      :   agcbank object
+//  _n      :   number of samples in sub-block
+static void AGCBANK(_update_subblock)(AGCBANK()    _q,
+                                      unsigned int _n);
+
+// update squelch status of each channel after _n samples
+static void AGCBANK(_update_squelch)(AGCBANK()    _q,
+                                     unsigned int _n);
+
+// create agcbank object
+//  _num_channels   :   number of channels, M > 0
+AGCBANK() AGCBANK(_create)(unsigned int _num_channels)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: agcbank_%s_create(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create object and initialize to default parameters
+    AGCBANK() q = (AGCBANK()) liquid_malloc(sizeof(struct AGCBANK(_s)));
+    q->num_channels = _num_channels;
+
+    // allocate per-channel state
+    q->g              = (T*) liquid_malloc(q->num_channels*sizeof(T));
+    q->y2_prime       = (T*) liquid_malloc(q->num_channels*sizeof(T));
+    q->g0             = (T*) liquid_malloc(q->num_channels*sizeof(T));
+    q->dg             = (T*) liquid_malloc(q->num_channels*sizeof(T));
+    q->x2             = (T*) liquid_malloc(q->num_channels*sizeof(T));
+    q->squelch_timer  = (unsigned int*) liquid_malloc(q->num_channels*sizeof(unsigned int));
+    q->squelch_status = (int*)          liquid_malloc(q->num_channels*sizeof(int));
+
+    // initialize bandwidth
+    AGCBANK(_set_bandwidth)(q, AGC_DEFAULT_BW);
+
+    // update gain per sample
+    q->block_len = 0;
+
+    // squelch disabled
+    q->squelch_enabled   = 0;
+    q->squelch_threshold = -100.0f;
+    q->squelch_timeout   = 0;
+    q->squelch_floor     = NULL;
+
+    // reset object
+    AGCBANK(_reset)(q);
+
+    // return object
+    return q;
+}
+
+// destroy agcbank object, freeing all internally-allocated memory
+void AGCBANK(_destroy)(AGCBANK() _q)
+{
+    liquid_free(_q->g);
+    liquid_free(_q->y2_prime);
+    liquid_free(_q->g0);
+    liquid_free(_q->dg);
+    liquid_free(_q->x2);
+    liquid_free(_q->squelch_timer);
+    liquid_free(_q->squelch_status);
+    AGCBANK(_squelch_disable_auto)(_q);
+    liquid_free(_q);
+}
+
+// print agcbank object internals
+void AGCBANK(_print)(AGCBANK() _q)
+{
+    printf("agcbank [%u channels, bw: %g, block: %u]:\n",
+            _q->num_channels, _q->bandwidth, _q->block_len);
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        printf("  %4u : rssi: %12.4fdB%s\n", i,
+                AGCBANK(_get_rssi)(_q,i),
+                _q->squelch_status[i] ? "" : " (squelch)");
+    }
+}
+
+// reset agcbank object's internal state
+void AGCBANK(_reset)(AGCBANK() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        _q->g[i]              = 1.0f;
+        _q->y2_prime[i]       = 1.0f;
+        _q->squelch_timer[i]  = 0;
+        _q->squelch_status[i] = _q->squelch_enabled ? 0 : 1;
+        if (_q->squelch_floor != NULL)
+            noisefloor_reset(_q->squelch_floor[i]);
+    }
+}
+
+// execute automatic gain control on channel-interleaved block
+//  _q      :   agcbank object
+//  _x      :   input array, sample i of channel k at _x[i*M+k] [size: _n*M x 1]
+//  _n      :   number of samples per channel
+//  _y      :   output array (may equal _x) [size: _n*M x 1]
+void AGCBANK(_execute)(AGCBANK()    _q,
+                       TC *         _x,
+                       unsigned int _n,
+                       TC *         _y)
+{
+    unsigned int M = _q->num_channels;
+    unsigned int i, k;
+
+    if (_q->block_len == 0) {
+        // update gain per sample, as agc's execute()
+        T a = _q->alpha;
+        for (i=0; i<_n; i++) {
+            TC * x = &_x[i*M];
+            TC * y = &_y[i*M];
+
+            // apply gain and smooth output energy estimate
+            for (k=0; k<M; k++) {
+                y[k] = x[k] * _q->g[k];
+#if TC_COMPLEX
+                T y2 = crealf(y[k])*crealf(y[k]) + cimagf(y[k])*cimagf(y[k]);
+#else
+                T y2 = y[k]*y[k];
+#endif
+                _q->y2_prime[k] = (1.0f-a)*_q->y2_prime[k] + a*y2;
+            }
+
+            // update gain according to output energy
+            for (k=0; k<M; k++) {
+                if (_q->y2_prime[k] > 1e-6f)
+                    _q->g[k] *= expf( -0.5f*a*logf(_q->y2_prime[k]) );
+
+                // clamp to 120 dB gain
+                if (_q->g[k] > 1e6f)
+                    _q->g[k] = 1e6f;
+            }
+        }
+    } else {
+        for (i=0; i<_n; i+=_q->block_len) {
+            unsigned int n = _n - i < _q->block_len ? _n - i : _q->block_len;
+            TC * x = &_x[i*M];
+            TC * y = &_y[i*M];
+
+            // measure input energy of each channel over sub-block
+            unsigned int j;
+            for (k=0; k<M; k++)
+                _q->x2[k] = 0.0f;
+            for (j=0; j<n; j++) {
+                for (k=0; k<M; k++) {
+#if TC_COMPLEX
+                    _q->x2[k] += crealf(x[j*M+k])*crealf(x[j*M+k]) +
+                                 cimagf(x[j*M+k])*cimagf(x[j*M+k]);
+#else
+                    _q->x2[k] += x[j*M+k]*x[j*M+k];
+#endif
+                }
+            }
+
+            // update gains
+            AGCBANK(_update_subblock)(_q, n);
+
+            // apply gain ramps
+            for (j=0; j<n; j++) {
+                T r = (T)(j+1);
+                for (k=0; k<M; k++)
+                    y[j*M+k] = x[j*M+k] * (_q->g0[k] + r*_q->dg[k]);
+            }
+        }
+    }
+
+    // update squelch
+    if (_q->squelch_enabled)
+        AGCBANK(_update_squelch)(_q, _n);
+}
+
+// get number of channels
+unsigned int AGCBANK(_get_num_channels)(AGCBANK() _q)
+{
+    return _q->num_channels;
+}
+
+// get sub-block length for execute()
+unsigned int AGCBANK(_get_block_len)(AGCBANK() _q)
+{
+    return _q->block_len;
+}
+
+// set sub-block length for execute()
+//  _q          :   agcbank object
+//  _block_len  :   samples per channel per gain update (0: every sample)
+void AGCBANK(_set_block_len)(AGCBANK()    _q,
+                             unsigned int _block_len)
+{
+    _q->block_len = _block_len;
+}
+
+// get agcbank loop bandwidth
+float AGCBANK(_get_bandwidth)(AGCBANK() _q)
+{
+    return _q->bandwidth;
+}
+
+// set agcbank loop bandwidth, common to all channels
+//  _q      :   agcbank object
+//  _bt     :   bandwidth
+void AGCBANK(_set_bandwidth)(AGCBANK() _q,
+                             float     _bt)
+{
+    // check to ensure bandwidth is reasonable
+    if ( _bt < 0 ) {
+        fprintf(stderr,"error: agcbank_%s_set_bandwidth(), bandwidth must be positive\n", EXTENSION_FULL);
+        exit(-1);
+    } else if ( _bt > 1.0f ) {
+        fprintf(stderr,"error: agcbank_%s_set_bandwidth(), bandwidth must less than 1.0\n", EXTENSION_FULL);
+        exit(-1);
+    }
+
+    // set internal bandwidth and filter coefficient
+    _q->bandwidth = _bt;
+    _q->alpha     = _q->bandwidth;
+}
+
+// get estimated signal level (dB) of channel
+float AGCBANK(_get_rssi)(AGCBANK()    _q,
+                         unsigned int _channel)
+{
+    return -20*log10f(AGCBANK(_get_gain)(_q, _channel));
+}
+
+// get internal gain of channel
+float AGCBANK(_get_gain)(AGCBANK()    _q,
+                         unsigned int _channel)
+{
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: agcbank_%s_get_gain(), channel index (%u) exceeds maximum (%u)\n",
+                EXTENSION_FULL, _channel, _q->num_channels-1);
+        exit(-1);
+    }
+    return _q->g[_channel];
+}
+
+// set internal gain of channel
+void AGCBANK(_set_gain)(AGCBANK()    _q,
+                        unsigned int _channel,
+                        float        _gain)
+{
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: agcbank_%s_set_gain(), channel index (%u) exceeds maximum (%u)\n",
+                EXTENSION_FULL, _channel, _q->num_channels-1);
+        exit(-1);
+    } else if ( _gain <= 0 ) {
+        fprintf(stderr,"error: agcbank_%s_set_gain(), gain must be greater than zero\n", EXTENSION_FULL);
+        exit(-1);
+    }
+    _q->g[_channel] = _gain;
+}
+
+// enable squelch; channels start squelched until their signal level
+// is observed above the threshold
+void AGCBANK(_squelch_enable)(AGCBANK() _q)
+{
+    if (!_q->squelch_enabled) {
+        unsigned int i;
+        for (i=0; i<_q->num_channels; i++) {
+            _q->squelch_status[i] = 0;
+            _q->squelch_timer[i]  = 0;
+        }
+    }
+    _q->squelch_enabled = 1;
+}
+
+// disable squelch; all channels are reported active
+void AGCBANK(_squelch_disable)(AGCBANK() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        _q->squelch_status[i] = 1;
+    _q->squelch_enabled = 0;
+}
+
+// is squelch enabled?
+int AGCBANK(_squelch_is_enabled)(AGCBANK() _q)
+{
+    return _q->squelch_enabled;
+}
+
+// get/set squelch threshold [dB]
+float AGCBANK(_squelch_get_threshold)(AGCBANK() _q)
+{
+    return _q->squelch_threshold;
+}
+
+void AGCBANK(_squelch_set_threshold)(AGCBANK() _q,
+                                     float     _threshold)
+{
+    _q->squelch_threshold = _threshold;
+}
+
+// enable automatic squelch threshold: the threshold is taken relative
+// to each channel's noise floor, estimated from its signal level over
+// execute() calls
+void AGCBANK(_squelch_enable_auto)(AGCBANK() _q)
+{
+    if (_q->squelch_floor != NULL)
+        return;
+
+    _q->squelch_floor = (noisefloor*) liquid_malloc(_q->num_channels*sizeof(noisefloor));
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        _q->squelch_floor[i] = noisefloor_create(AGCBANK_SQUELCH_QUANTILE, AGCBANK_SQUELCH_MEMORY);
+}
+
+// disable automatic squelch threshold (threshold is absolute)
+void AGCBANK(_squelch_disable_auto)(AGCBANK() _q)
+{
+    if (_q->squelch_floor == NULL)
+        return;
+
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        noisefloor_destroy(_q->squelch_floor[i]);
+    liquid_free(_q->squelch_floor);
+    _q->squelch_floor = NULL;
+}
+
+// is automatic squelch threshold enabled?
+int AGCBANK(_squelch_is_auto)(AGCBANK() _q)
+{
+    return _q->squelch_floor != NULL;
+}
+
+// get noise floor estimate (dB) of channel for automatic squelch
+float AGCBANK(_squelch_get_noise_floor)(AGCBANK()    _q,
+                                        unsigned int _channel)
+{
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: agcbank_%s_squelch_get_noise_floor(), channel index (%u) exceeds maximum (%u)\n",
+                EXTENSION_FULL, _channel, _q->num_channels-1);
+        exit(-1);
+    }
+
+    // not enabled or not yet estimated
+    if (_q->squelch_floor == NULL || noisefloor_get_num_blocks(_q->squelch_floor[_channel]) == 0)
+        return -1e6f;
+
+    return 10.0f*log10f(noisefloor_get_level(_q->squelch_floor[_channel]) + 1e-36f);
+}
+
+// get/set squelch timeout: number of samples a channel is held active
+// after its signal level drops below the threshold
+unsigned int AGCBANK(_squelch_get_timeout)(AGCBANK() _q)
+{
+    return _q->squelch_timeout;
+}
+
+void AGCBANK(_squelch_set_timeout)(AGCBANK()    _q,
+                                   unsigned int _timeout)
+{
+    _q->squelch_timeout = _timeout;
+}
+
+// get squelch status of channel: 1 if active, 0 if squelched
+int AGCBANK(_squelch_get_status)(AGCBANK()    _q,
+                                 unsigned int _channel)
+{
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: agcbank_%s_squelch_get_status(), channel index (%u) exceeds maximum (%u)\n",
+                EXTENSION_FULL, _channel, _q->num_channels-1);
+        exit(-1);
+    }
+    return _q->squelch_status[_channel];
+}
+
+// get list of active (not squelched) channels
+//  _q      :   agcbank object
+//  _active :   active channel indices, ascending (ignored if NULL) [size: M x 1]
+//  returns number of active channels
+unsigned int AGCBANK(_squelch_get_active)(AGCBANK()      _q,
+                                          unsigned int * _active)
+{
+    unsigned int i;
+    unsigned int num_active = 0;
+    for (i=0; i<_q->num_channels; i++) {
+        if (!_q->squelch_status[i])
+            continue;
+        if (_active != NULL)
+            _active[num_active] = i;
+        num_active++;
+    }
+    return num_active;
+}
+
+//
+// internal methods
+//
+
+// update gain once for each channel from its sub-block energy
+static void AGCBANK(_update_subblock)(AGCBANK()    _q,
+                                      unsigned int _n)
+{
+    unsigned int k;
+
+    // energy filter decay over sub-block and gain step, limited to a
+    // full correction to keep the loop stable for long sub-blocks
+    T p = powf(1.0f - _q->alpha, (float)_n);
+    T a = _q->alpha * (T)_n;
+    if (a > 1.0f) a = 1.0f;
+
+    for (k=0; k<_q->num_channels; k++) {
+        // output signal energy at current gain
+        T y2 = _q->x2[k] * _q->g[k] * _q->g[k] / (T)_n;
+
+        // advance single-pole energy filter by _n samples of y2
+        _q->y2_prime[k] = y2 + p*(_q->y2_prime[k] - y2);
+
+        // update gain according to output energy
+        _q->g0[k] = _q->g[k];
+        if (_q->y2_prime[k] > 1e-6f)
+            _q->g[k] *= expf( -0.5f*a*logf(_q->y2_prime[k]) );
+
+        // clamp to 120 dB gain
+        if (_q->g[k] > 1e6f)
+            _q->g[k] = 1e6f;
+
+        // ramp gain across sub-block; a single sample uses the
+        // current gain, as agc's execute()
+        _q->dg[k] = _n > 1 ? (_q->g[k] - _q->g0[k]) / (T)_n : 0.0f;
+    }
+}
+
+// update squelch status of each channel after _n samples
+static void AGCBANK(_update_squelch)(AGCBANK()    _q,
+                                     unsigned int _n)
+{
+    // gain threshold equivalent to rssi threshold
+    T g_threshold = powf(10.0f, -_q->squelch_threshold/20.0f);
+
+    unsigned int k;
+    for (k=0; k<_q->num_channels; k++) {
+        int present;
+        if (_q->squelch_floor != NULL) {
+            // signal level relative to noise floor; closed until the
+            // floor has been estimated
+            noisefloor f = _q->squelch_floor[k];
+            T x2 = 1.0f / (_q->g[k]*_q->g[k]);
+            present = noisefloor_get_num_blocks(f) > 0 &&
+                      x2*g_threshold*g_threshold >= noisefloor_get_level(f);
+            noisefloor_push(f, x2);
+        } else {
+            present = _q->g[k] <= g_threshold;
+        }
+
+        if (present) {
+            // signal present: open and reload timer
+            _q->squelch_status[k] = 1;
+            _q->squelch_timer[k]  = _q->squelch_timeout;
+        } else if (_q->squelch_timer[k] > _n) {
+            // signal absent: hold open until timer expires
+            _q->squelch_timer[k] -= _n;
+        } else {
+            _q->squelch_timer[k]  = 0;
+            _q->squelch_status[k] = 0;
+        }
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Streaming noise floor estimator: tracks a quantile (e.g. the median)
+// of block energies with exponential forgetting. Energies are binned
+// on a dB grid; the histogram decays implicitly by growing the weight
+// of each new block, and the bin holding the quantile is tracked
+// incrementally so that each update is O(1) (amortized).
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// histogram grid [dB]
+#define NOISEFLOOR_DB_MIN       (-160.0f)
+#define NOISEFLOOR_DB_STEP      (0.5f)
+#define NOISEFLOOR_NUM_BINS     (480)
+
+// renormalize histogram once block weight exceeds this value
+#define NOISEFLOOR_WEIGHT_MAX   (1e12f)
+
+struct noisefloor_s {
+    float        quantile;      // tracked quantile, 0 < quantile < 1
+    unsigned int memory;        // effective number of blocks retained
+    float        lambda;        // forgetting factor, 1 - 1/memory
+
+    float h[NOISEFLOOR_NUM_BINS];   // weighted histogram of block energies [dB]
+    float w;                    // weight of next block
+    float total;                // sum of histogram weights
+    float below;                // sum of weights in bins below index
+    unsigned int index;         // bin containing quantile
+    unsigned int num_blocks;    // number of blocks pushed
+};
+
+// rescale histogram weights so that next block has unit weight
+static void noisefloor_renormalize(noisefloor _q);
+
+// create noise floor estimator
+//  _quantile   :   quantile of block energies to track, 0 < _quantile < 1
+//  _memory     :   effective number of blocks retained, _memory > 1
+noisefloor noisefloor_create(float        _quantile,
+                             unsigned int _memory)
+{
+    // validate input
+    if (_quantile <= 0.0f || _quantile >= 1.0f) {
+        fprintf(stderr,"error: noisefloor_create(), quantile must be in (0,1)\n");
+        exit(1);
+    } else if (_memory < 2) {
+        fprintf(stderr,"error: noisefloor_create(), memory must be greater than one\n");
+        exit(1);
+    }
+
+    noisefloor q = (noisefloor) liquid_malloc(sizeof(struct noisefloor_s));
+    q->quantile = _quantile;
+    q->memory   = _memory;
+    q->lambda   = 1.0f - 1.0f / (float)(q->memory);
+
+    // reset object
+    noisefloor_reset(q);
+
+    return q;
+}
+
+// destroy noise floor estimator
+void noisefloor_destroy(noisefloor _q)
+{
+    liquid_free(_q);
+}
+
+// print noise floor estimator
+void noisefloor_print(noisefloor _q)
+{
+    printf("noisefloor [quantile: %g, memory: %u, blocks: %u]: %.2f dB\n",
+            _q->quantile, _q->memory, _q->num_blocks,
+            10.0f*log10f(noisefloor_get_level(_q) + 1e-36f));
+}
+
+// reset noise floor estimator, clearing histogram
+void noisefloor_reset(noisefloor _q)
+{
+    memset(_q->h, 0x00, sizeof(_q->h));
+    _q->w          = 1.0f;
+    _q->total      = 0.0f;
+    _q->below      = 0.0f;
+    _q->index      = 0;
+    _q->num_blocks = 0;
+}
+
+// push block energy (e.g. mean |x|^2 over block) into estimator
+void noisefloor_push(noisefloor _q,
+                     float      _x2)
+{
+    // histogram bin of block energy, clamped to grid
+    int b = 0;
+    if (_x2 > 0.0f) {
+        b = (int) floorf((10.0f*log10f(_x2) - NOISEFLOOR_DB_MIN) / NOISEFLOOR_DB_STEP);
+        if (b < 0)                        b = 0;
+        if (b > NOISEFLOOR_NUM_BINS-1)    b = NOISEFLOOR_NUM_BINS-1;
+    }
+
+    // start search at first block
+    if (_q->num_blocks == 0)
+        _q->index = b;
+    _q->num_blocks++;
+
+    // add block; older blocks decay relative to newer ones
+    _q->h[b]  += _q->w;
+    _q->total += _q->w;
+    if ((unsigned int)b < _q->index)
+        _q->below += _q->w;
+    _q->w /= _q->lambda;
+
+    // move index to bin containing quantile; the quantile moves by at
+    // most one block's weight per update
+    float t = _q->quantile * _q->total;
+    while (_q->index > 0 && _q->below > t) {
+        _q->index--;
+        _q->below -= _q->h[_q->index];
+    }
+    while (_q->index < NOISEFLOOR_NUM_BINS-1 && _q->below + _q->h[_q->index] <= t) {
+        _q->below += _q->h[_q->index];
+        _q->index++;
+    }
+
+    if (_q->w > NOISEFLOOR_WEIGHT_MAX)
+        noisefloor_renormalize(_q);
+}
+
+// get noise floor estimate: quantile of block energies (linear), or
+// zero if no blocks have been pushed
+float noisefloor_get_level(noisefloor _q)
+{
+    if (_q->num_blocks == 0)
+        return 0.0f;
+
+    // interpolate within bin
+    float h = _q->h[_q->index];
+    float f = h > 0.0f ? (_q->quantile*_q->total - _q->below) / h : 0.5f;
+    if (f < 0.0f) f = 0.0f;
+    if (f > 1.0f) f = 1.0f;
+    float v = NOISEFLOOR_DB_MIN + ((float)(_q->index) + f)*NOISEFLOOR_DB_STEP;
+    return powf(10.0f, v/10.0f);
+}
+
+// get number of blocks pushed since last reset
+unsigned int noisefloor_get_num_blocks(noisefloor _q)
+{
+    return _q->num_blocks;
+}
+
+// rescale histogram weights so that next block has unit weight; the
+// partial sum below the index is recomputed to shed rounding drift,
+// and negligible weights are flushed to avoid denormals
+static void noisefloor_renormalize(noisefloor _q)
+{
+    float g = 1.0f / _q->w;
+    unsigned int i;
+    _q->total = 0.0f;
+    _q->below = 0.0f;
+    for (i=0; i<NOISEFLOOR_NUM_BINS; i++) {
+        _q->h[i] *= g;
+        if (_q->h[i] < 1e-20f)
+            _q->h[i] = 0.0f;
+        _q->total += _q->h[i];
+        if (i < _q->index)
+            _q->below += _q->h[i];
+    }
+    _q->w = 1.0f;
+}
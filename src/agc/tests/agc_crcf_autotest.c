@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+#include <math.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -145,18 +147,22 @@ void autotest_agc_crcf_rssi_noise()
     agc_crcf q = agc_crcf_create();
     agc_crcf_set_bandwidth(q, bt);
 
+    // the instantaneous estimate on noise has a standard deviation of
+    // about 0.3 dB at this bandwidth, so average it once settled
     unsigned int i;
     float complex x, y;
-    for (i=0; i<3000; i++) {
+    float rssi = 0.0f;
+    for (i=0; i<13000; i++) {
         // generate sample (circular complex noise)
         x = nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
 
         // execute agc
         agc_crcf_execute(q, x, &y);
-    }
 
-    // get received signal strength indication
-    float rssi = agc_crcf_get_rssi(q);
+        // accumulate received signal strength indication
+        if (i >= 1000)
+            rssi += agc_crcf_get_rssi(q) / 12000.0f;
+    }
 
     if (liquid_autotest_verbose)
         printf("gamma : %12.8f, rssi : %12.8f\n", gamma, rssi);
@@ -170,3 +176,135 @@ void autotest_agc_crcf_rssi_noise()
 
 
 
+
+// 
+// Test block mode: gain control on sinusoid with level step
+//
+void agc_crcf_test_block(unsigned int _block_len,
+                         float        _bt)
+{
+    float gamma0 = 0.1f;    // initial signal level
+    float gamma1 = 3.0f;    // signal level after step
+    float dphi   = 0.1f;    // signal frequency
+    float tol    = 0.001f;  // error tolerance
+
+    // create AGC object and initialize
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q, _bt);
+    agc_crcf_set_block_len(q, _block_len);
+    CONTEND_EQUALITY(agc_crcf_get_block_len(q), _block_len);
+
+    unsigned int i, n = 4000;
+    float complex * x = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y = (float complex*) malloc(n*sizeof(float complex));
+    for (i=0; i<n; i++)
+        x[i] = (i < n/2 ? gamma0 : gamma1) * cexpf(_Complex_I*dphi*i);
+
+    // run in calls of odd length, in place for the second half
+    unsigned int i0 = 0;
+    while (i0 < n) {
+        unsigned int len = n - i0 < 37 ? n - i0 : 37;
+        if (i0 < n/2) agc_crcf_execute_block(q, &x[i0], len, &y[i0]);
+        else          agc_crcf_execute_block(q, &x[i0], len, &x[i0]);
+        i0 += len;
+
+        // check level once settled on first step
+        if (i0 >= n/2 - 37 && i0 < n/2)
+            CONTEND_DELTA( agc_crcf_get_signal_level(q), gamma0, tol*gamma0 );
+    }
+
+    // Check results
+    CONTEND_DELTA( agc_crcf_get_signal_level(q), gamma1, tol*gamma1 );
+    for (i=n-100; i<n; i++)
+        CONTEND_DELTA( cabsf(x[i]), 1.0f, tol );
+
+    // destroy AGC object
+    agc_crcf_destroy(q);
+    free(x);
+    free(y);
+}
+void autotest_agc_crcf_block_per_sample()   { agc_crcf_test_block( 0, 0.02f); }
+void autotest_agc_crcf_block_16()           { agc_crcf_test_block(16, 0.02f); }
+void autotest_agc_crcf_block_64()           { agc_crcf_test_block(64, 0.02f); }
+void autotest_agc_crcf_block_wide()         { agc_crcf_test_block(32, 0.5f);  }
+
+// 
+// Test block mode matches per-sample gain on noise input
+//
+void autotest_agc_crcf_block_rssi_noise()
+{
+    float gamma = -30.0f;   // nominal signal level [dB]
+    float bt    =  0.01f;   // agc bandwidth
+    float tol   =  0.2f;    // error tolerance [dB]
+    float nstd  = powf(10.0f, gamma/20);
+
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q, bt);
+    agc_crcf_set_block_len(q, 32);
+
+    // average estimate over blocks once settled (see rssi_noise)
+    unsigned int i, j;
+    float complex x[32];
+    float rssi = 0.0f;
+    for (i=0; i<13000/32; i++) {
+        for (j=0; j<32; j++)
+            x[j] = nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        agc_crcf_execute_block(q, x, 32, x);
+        if (i >= 1000/32)
+            rssi += agc_crcf_get_rssi(q) / (float)(13000/32 - 1000/32);
+    }
+
+    // Check results
+    CONTEND_DELTA( rssi, gamma, tol );
+
+    agc_crcf_destroy(q);
+}
+
+//
+// Test 16-bit integer block input matches block mode on widened input
+//
+void agc_crcf_test_block_ci16(unsigned int _block_len)
+{
+    float g = 1.0f / 32768.0f;
+    agc_crcf q0 = agc_crcf_create();
+    agc_crcf q1 = agc_crcf_create();
+    agc_crcf_set_bandwidth(q0, 0.02f);
+    agc_crcf_set_bandwidth(q1, 0.02f);
+    agc_crcf_set_block_len(q0, _block_len);
+    agc_crcf_set_block_len(q1, _block_len);
+
+    unsigned int i, n = 2000;
+    int16_t * x = (int16_t*) malloc(2*n*sizeof(int16_t));
+    float complex * v  = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(n*sizeof(float complex));
+    for (i=0; i<n; i++) {
+        float complex s = (i < n/2 ? 300.0f : 8000.0f) * cexpf(_Complex_I*0.1f*i);
+        x[2*i  ] = (int16_t) lrintf(crealf(s));
+        x[2*i+1] = (int16_t) lrintf(cimagf(s));
+        v[i] = ((float)x[2*i] + (float)x[2*i+1]*_Complex_I) * g;
+    }
+
+    // whole array against calls spanning whole sub-blocks
+    agc_crcf_execute_block(q0, v, n, y0);
+    unsigned int i0 = 0;
+    while (i0 < n) {
+        unsigned int len = n - i0 < 320 ? n - i0 : 320;
+        agc_crcf_execute_block_ci16(q1, &x[2*i0], len, g, &y1[i0]);
+        i0 += len;
+    }
+
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( y1[i], y0[i] );
+    for (i=n-100; i<n; i++)
+        CONTEND_DELTA( cabsf(y1[i]), 1.0f, 0.01f );
+
+    agc_crcf_destroy(q0);
+    agc_crcf_destroy(q1);
+    free(x);
+    free(v);
+    free(y0);
+    free(y1);
+}
+void autotest_agc_crcf_block_ci16_per_sample()  { agc_crcf_test_block_ci16( 0); }
+void autotest_agc_crcf_block_ci16_64()          { agc_crcf_test_block_ci16(64); }
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// Test each channel of bank matches independent agc object
+//
+void agcbank_crcf_test_match(unsigned int _block_len)
+{
+    unsigned int M   = 5;       // number of channels
+    unsigned int n   = 250;     // samples per channel
+    float        bt  = 0.05f;   // loop bandwidth
+    float        tol = 1e-4f;   // relative error tolerance
+    unsigned int i, k;
+
+    // channel levels span 100 dB
+    float gamma[5] = {1e-4f, 1e-2f, 0.3f, 1.0f, 10.0f};
+
+    agcbank_crcf q = agcbank_crcf_create(M);
+    agcbank_crcf_set_bandwidth(q, bt);
+    agcbank_crcf_set_block_len(q, _block_len);
+    CONTEND_EQUALITY(agcbank_crcf_get_num_channels(q), M);
+    CONTEND_EQUALITY(agcbank_crcf_get_block_len(q), _block_len);
+
+    agc_crcf agc[M];
+    for (k=0; k<M; k++) {
+        agc[k] = agc_crcf_create();
+        agc_crcf_set_bandwidth(agc[k], bt);
+        agc_crcf_set_block_len(agc[k], _block_len);
+    }
+
+    // channel-interleaved input
+    float complex * x = (float complex*) malloc(n*M*sizeof(float complex));
+    float complex * y = (float complex*) malloc(n*M*sizeof(float complex));
+    for (i=0; i<n; i++) {
+        for (k=0; k<M; k++)
+            x[i*M+k] = gamma[k] * cexpf(_Complex_I*(0.1f*i + 0.7f*k));
+    }
+
+    // run bank in place, in calls of odd length
+    memmove(y, x, n*M*sizeof(float complex));
+    unsigned int i0 = 0;
+    while (i0 < n) {
+        unsigned int len = n - i0 < 37 ? n - i0 : 37;
+        agcbank_crcf_execute(q, &y[i0*M], len, &y[i0*M]);
+
+        // run each channel through its own agc object
+        for (k=0; k<M; k++) {
+            float complex xk[37];
+            float complex yk[37];
+            for (i=0; i<len; i++)
+                xk[i] = x[(i0+i)*M+k];
+            agc_crcf_execute_block(agc[k], xk, len, yk);
+            for (i=0; i<len; i++) {
+                float complex yq = y[(i0+i)*M+k];
+                CONTEND_DELTA( crealf(yq), crealf(yk[i]), tol*(1+cabsf(yk[i])) );
+                CONTEND_DELTA( cimagf(yq), cimagf(yk[i]), tol*(1+cabsf(yk[i])) );
+            }
+        }
+        i0 += len;
+    }
+
+    for (k=0; k<M; k++) {
+        float g0 = agc_crcf_get_gain(agc[k]);
+        CONTEND_DELTA( agcbank_crcf_get_gain(q,k), g0, tol*g0 );
+        agc_crcf_destroy(agc[k]);
+    }
+
+    agcbank_crcf_destroy(q);
+    free(x);
+    free(y);
+}
+void autotest_agcbank_crcf_match_per_sample()   { agcbank_crcf_test_match( 0); }
+void autotest_agcbank_crcf_match_block_16()     { agcbank_crcf_test_match(16); }
+
+//
+// Test squelch reports only channels carrying signal
+//
+void autotest_agcbank_crcf_squelch()
+{
+    unsigned int M       = 8;       // number of channels
+    unsigned int n       = 64;      // samples per channel per call
+    unsigned int timeout = 256;     // squelch timeout [samples]
+    unsigned int i, k;
+
+    agcbank_crcf q = agcbank_crcf_create(M);
+    agcbank_crcf_set_bandwidth(q, 0.1f);
+    agcbank_crcf_set_block_len(q, 16);
+    agcbank_crcf_squelch_set_threshold(q, -40.0f);
+    agcbank_crcf_squelch_set_timeout(q, timeout);
+    agcbank_crcf_squelch_enable(q);
+    CONTEND_EQUALITY(agcbank_crcf_squelch_is_enabled(q), 1);
+    CONTEND_EQUALITY(agcbank_crcf_squelch_get_active(q, NULL), 0);
+
+    // signal (-10 dB) on channels 1 and 6; noise floor (-80 dB) elsewhere
+    float complex x[n*M];
+    float complex y[n*M];
+    unsigned int t;
+    for (t=0; t<20; t++) {
+        for (i=0; i<n; i++) {
+            for (k=0; k<M; k++) {
+                float gamma = (k==1 || k==6) ? 0.316f : 1e-4f;
+                x[i*M+k] = gamma * cexpf(_Complex_I*(0.3f*(i+t*n) + k));
+            }
+        }
+        agcbank_crcf_execute(q, x, n, y);
+    }
+    if (liquid_autotest_verbose)
+        agcbank_crcf_print(q);
+
+    unsigned int active[M];
+    CONTEND_EQUALITY(agcbank_crcf_squelch_get_active(q, active), 2);
+    CONTEND_EQUALITY(active[0], 1);
+    CONTEND_EQUALITY(active[1], 6);
+    for (k=0; k<M; k++)
+        CONTEND_EQUALITY(agcbank_crcf_squelch_get_status(q,k), k==1 || k==6);
+
+    // signal on channel 1 stops: held active until timeout expires
+    unsigned int num_calls = 0;
+    while (agcbank_crcf_squelch_get_status(q,1) && num_calls < 100) {
+        for (i=0; i<n; i++)
+            x[i*M+1] = 1e-4f;
+        agcbank_crcf_execute(q, x, n, y);
+        num_calls++;
+    }
+    CONTEND_EQUALITY(agcbank_crcf_squelch_get_status(q,1), 0);
+    CONTEND_EXPRESSION(num_calls*n >= timeout);
+    CONTEND_EQUALITY(agcbank_crcf_squelch_get_status(q,6), 1);
+
+    // disabling squelch reports all channels
+    agcbank_crcf_squelch_disable(q);
+    CONTEND_EQUALITY(agcbank_crcf_squelch_get_active(q, NULL), M);
+
+    agcbank_crcf_destroy(q);
+}
+
+//
+// Test automatic squelch threshold follows per-channel noise floors
+//
+void autotest_agcbank_crcf_squelch_auto()
+{
+    unsigned int M = 6;         // number of channels
+    unsigned int n = 64;        // samples per channel per call
+    unsigned int i, k, t;
+
+    agcbank_crcf q = agcbank_crcf_create(M);
+    agcbank_crcf_set_bandwidth(q, 0.1f);
+    agcbank_crcf_set_block_len(q, 16);
+    agcbank_crcf_squelch_set_threshold(q, 10.0f);
+    agcbank_crcf_squelch_enable(q);
+    agcbank_crcf_squelch_enable_auto(q);
+    CONTEND_EQUALITY(agcbank_crcf_squelch_is_auto(q), 1);
+
+    // noise floors span 50 dB (-80 dB + 10 dB*k), which no absolute
+    // threshold separates from signals 20 dB above their floors
+    float nstd[M];
+    for (k=0; k<M; k++)
+        nstd[k] = powf(10.0f, (-80.0f + 10.0f*k)/20.0f);
+
+    float complex x[n*M];
+    float complex y[n*M];
+    for (t=0; t<100; t++) {
+        for (i=0; i<n; i++) {
+            for (k=0; k<M; k++) {
+                x[i*M+k] = nstd[k]*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+
+                // signal on channel 2 for last 20 calls
+                if (k==2 && t >= 80)
+                    x[i*M+k] += 10.0f*nstd[k]*cexpf(_Complex_I*0.3f*(i+t*n));
+            }
+        }
+        agcbank_crcf_execute(q, x, n, y);
+
+        // nothing active on noise alone
+        if (t == 79)
+            CONTEND_EQUALITY(agcbank_crcf_squelch_get_active(q, NULL), 0);
+    }
+    if (liquid_autotest_verbose) {
+        agcbank_crcf_print(q);
+        for (k=0; k<M; k++)
+            printf("  %u : noise floor %8.2f dB\n", k, agcbank_crcf_squelch_get_noise_floor(q,k));
+    }
+
+    for (k=0; k<M; k++) {
+        CONTEND_EQUALITY(agcbank_crcf_squelch_get_status(q,k), k==2);
+        CONTEND_DELTA(agcbank_crcf_squelch_get_noise_floor(q,k), -80.0f + 10.0f*k, 1.5f);
+    }
+
+    // absolute threshold again
+    agcbank_crcf_squelch_disable_auto(q);
+    CONTEND_EQUALITY(agcbank_crcf_squelch_is_auto(q), 0);
+    CONTEND_LESS_THAN(agcbank_crcf_squelch_get_noise_floor(q,0), -1e5f);
+
+    agcbank_crcf_destroy(q);
+}
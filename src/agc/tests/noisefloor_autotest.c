@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// Test median of noise blocks is unaffected by sparse bursts
+//
+void autotest_noisefloor_bursts()
+{
+    unsigned int num_blocks = 2000;
+    unsigned int n          = 64;       // samples per block
+    float        nstd       = 0.01f;    // noise standard deviation (-40 dB)
+    unsigned int i, j;
+
+    noisefloor q = noisefloor_create(0.5f, 64);
+    CONTEND_EQUALITY(noisefloor_get_level(q), 0.0f);
+
+    for (i=0; i<num_blocks; i++) {
+        // one block in eight carries a burst 30 dB above noise
+        float g = (i % 8) == 0 ? 31.6f*nstd : nstd;
+        float x2 = 0.0f;
+        for (j=0; j<n; j++) {
+            float complex x = g*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            x2 += crealf(x)*crealf(x) + cimagf(x)*cimagf(x);
+        }
+        noisefloor_push(q, x2 / (float)n);
+    }
+
+    float level = 10.0f*log10f(noisefloor_get_level(q));
+    if (liquid_autotest_verbose)
+        noisefloor_print(q);
+    CONTEND_EQUALITY(noisefloor_get_num_blocks(q), num_blocks);
+    CONTEND_DELTA(level, -40.0f, 1.0f);
+
+    // reset clears estimate
+    noisefloor_reset(q);
+    CONTEND_EQUALITY(noisefloor_get_num_blocks(q), 0);
+    CONTEND_EQUALITY(noisefloor_get_level(q), 0.0f);
+
+    noisefloor_destroy(q);
+}
+
+//
+// Test estimate follows change in noise level and tracks quantile
+//
+void autotest_noisefloor_tracking()
+{
+    unsigned int i;
+
+    // uniform energies in dB over [-60,-40): quantiles map linearly
+    noisefloor q = noisefloor_create(0.25f, 100);
+    for (i=0; i<20000; i++)
+        noisefloor_push(q, powf(10.0f, (-60.0f + 20.0f*randf())/10.0f));
+    CONTEND_DELTA(10.0f*log10f(noisefloor_get_level(q)), -55.0f, 1.5f);
+
+    // level rises by 30 dB; estimate follows within a few memories
+    for (i=0; i<1000; i++)
+        noisefloor_push(q, powf(10.0f, (-30.0f + 20.0f*randf())/10.0f));
+    CONTEND_DELTA(10.0f*log10f(noisefloor_get_level(q)), -25.0f, 1.5f);
+
+    // zero energy clamps to bottom of range and is ignored thereafter
+    noisefloor_reset(q);
+    noisefloor_push(q, 0.0f);
+    CONTEND_LESS_THAN(10.0f*log10f(noisefloor_get_level(q)), -150.0f);
+    for (i=0; i<1000; i++)
+        noisefloor_push(q, 1e-3f);
+    CONTEND_DELTA(10.0f*log10f(noisefloor_get_level(q)), -30.0f, 0.5f);
+
+    noisefloor_destroy(q);
+}
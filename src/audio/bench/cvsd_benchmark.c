@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <math.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -104,3 +105,50 @@ void benchmark_cvsd_decode(struct rusage *_start,
     cvsd_destroy(decoder);
 }
 
+
+// multi-channel block encoder/decoder benchmark helper
+void cvsd_block_bench(struct rusage *     _start,
+                      struct rusage *     _finish,
+                      unsigned long int * _num_iterations,
+                      unsigned int        _num_channels,
+                      int                 _decode)
+{
+    unsigned long int i;
+
+    // create cvsd codec
+    unsigned int C = _num_channels;
+    unsigned int n = 32;            // bytes per channel
+    cvsd q = cvsd_create_multi(4, 1.5f, 0.95f, C);
+
+    float         x[8*n*C];         // audio samples, interleaved
+    unsigned char b[n*C];           // encoded bytes, interleaved
+    for (i=0; i<8*n*C; i++)
+        x[i] = 0.5f*sinf(0.07f*(i/C) + 0.3f*(i%C));
+    cvsd_encode_block(q, x, n, b);
+
+    // start trials
+    *_num_iterations /= n*C;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_decode)
+            cvsd_decode_block(q, b, n, x);
+        else
+            cvsd_encode_block(q, x, n, b);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 8*n*C;
+
+    cvsd_destroy(q);
+}
+
+#define CVSD_BLOCK_BENCHMARK_API(C,D)   \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ cvsd_block_bench(_start, _finish, _num_iterations, C, D); }
+
+void benchmark_cvsd_encode_block_c1     CVSD_BLOCK_BENCHMARK_API( 1, 0)
+void benchmark_cvsd_encode_block_c64    CVSD_BLOCK_BENCHMARK_API(64, 0)
+void benchmark_cvsd_decode_block_c1     CVSD_BLOCK_BENCHMARK_API( 1, 1)
+void benchmark_cvsd_decode_block_c64    CVSD_BLOCK_BENCHMARK_API(64, 1)
@@ -29,26 +29,13 @@
 
 #include "liquid.internal.h"
 
-// enable use of the pre-emphasis and post-emphasis filters
-#define CVSD_ENABLE_SIGNAL_CONDITIONING (1)
-
 struct cvsd_s {
     unsigned int num_bits;
-    unsigned char bitref;   // historical bit reference
-    unsigned char bitmask;  // historical bit reference mask
-    float ref;              // internal reference
-
-    float zeta;             // delta step factor
-    float delta;            // current step size
-    float delta_min;        // minimum delta
-    float delta_max;        // maximum delta
-
-#if CVSD_ENABLE_SIGNAL_CONDITIONING
-    float alpha;            // pre-/de-emphasis filter coefficient
-    float beta;             // DC-blocking coefficient (decoder)
-    iirfilt_rrrf prefilt;   // pre-emphasis filter (encoder)
-    iirfilt_rrrf postfilt;  // e-emphasis filter (decoder)
-#endif
+    unsigned int num_channels;  // number of interleaved channels
+
+    // codec parameters and per-channel state, including pre-emphasis
+    // (encoder) and de-emphasis (decoder) filters
+    struct liquid_cvsd_lanes_s s;
 };
 
 // create cvsd object
@@ -59,6 +46,19 @@ struct cvsd_s {
 cvsd cvsd_create(unsigned int _num_bits,
                  float _zeta,
                  float _alpha)
+{
+    return cvsd_create_multi(_num_bits, _zeta, _alpha, 1);
+}
+
+// create multi-channel cvsd object
+//  _num_bits       :   number of adjacent bits to observe
+//  _zeta           :   slope adjustment multiplier
+//  _alpha          :   pre-/post-emphasis filter coefficient
+//  _num_channels   :   number of interleaved channels
+cvsd cvsd_create_multi(unsigned int _num_bits,
+                       float        _zeta,
+                       float        _alpha,
+                       unsigned int _num_channels)
 {
     if (_num_bits == 0) {
         fprintf(stderr, "error: cvsd_create(), _num_bits must be positive\n");
@@ -69,32 +69,39 @@ cvsd cvsd_create(unsigned int _num_bits,
     } else if (_alpha < 0.0f || _alpha > 1.0f) {
         fprintf(stderr, "error: cvsd_create(), alpha must be in [0,1]\n");
         exit(1);
+    } else if (_num_channels == 0) {
+        fprintf(stderr, "error: cvsd_create_multi(), number of channels must be greater than zero\n");
+        exit(1);
     }
 
-    cvsd q = (cvsd) malloc(sizeof(struct cvsd_s));
-    q->num_bits = _num_bits;
-    q->bitref = 0;
-    q->bitmask = (1<<(q->num_bits)) - 1;
-
-    q->ref = 0.0f;
-    q->zeta = _zeta;
-    q->delta = 0.01f;
-    q->delta_min = 0.01f;
-    q->delta_max = 1.0f;
-
-#if CVSD_ENABLE_SIGNAL_CONDITIONING
-    // design pre-emphasis filter
-    q->alpha = _alpha;
-    float b_pre[2] = {1.0f, -q->alpha};
-    float a_pre[2] = {1.0f, 0.0f};
-    q->prefilt  = iirfilt_rrrf_create(b_pre,2,a_pre,2);
-
-    // design post-emphasis filter
-    q->beta = 0.99f;    // DC-blocking parameter
-    float b_post[3] = {1.0f, -1.0f, 0.0f};
-    float a_post[3] = {1.0f, -(q->alpha + q->beta), q->alpha*q->beta};
-    q->postfilt = iirfilt_rrrf_create(b_post,3,a_post,3);
-#endif
+    cvsd q = (cvsd) liquid_malloc(sizeof(struct cvsd_s));
+    q->num_bits     = _num_bits;
+    q->num_channels = _num_channels;
+
+    q->s.num_channels = _num_channels;
+    q->s.bitmask   = (unsigned char)((1<<(q->num_bits)) - 1);
+    q->s.zeta      = _zeta;
+    q->s.delta_min = 0.01f;
+    q->s.delta_max = 1.0f;
+
+    // pre-emphasis filter: H(z) = 1 - alpha z^-1
+    q->s.alpha = _alpha;
+
+    // de-emphasis filter with DC blocking parameter beta:
+    //  H(z) = (1 - z^-1) / (1 - (alpha+beta) z^-1 + alpha beta z^-2)
+    float beta = 0.99f;
+    q->s.a1 = -(_alpha + beta);
+    q->s.a2 = _alpha*beta;
+
+    // allocate per-channel state
+    unsigned int C = _num_channels;
+    q->s.bitref = (unsigned int*) liquid_malloc(C*sizeof(unsigned int));
+    q->s.ref    = (float*) liquid_malloc(C*sizeof(float));
+    q->s.delta  = (float*) liquid_malloc(C*sizeof(float));
+    q->s.x_prev = (float*) liquid_malloc(C*sizeof(float));
+    q->s.v1     = (float*) liquid_malloc(C*sizeof(float));
+    q->s.v2     = (float*) liquid_malloc(C*sizeof(float));
+    cvsd_reset(q);
 
     return q;
 }
@@ -102,14 +109,16 @@ cvsd cvsd_create(unsigned int _num_bits,
 // destroy cvsd object
 void cvsd_destroy(cvsd _q)
 {
-#if CVSD_ENABLE_SIGNAL_CONDITIONING
-    // destroy filters
-    iirfilt_rrrf_destroy(_q->prefilt);
-    iirfilt_rrrf_destroy(_q->postfilt);
-#endif
+    // free per-channel state
+    liquid_free(_q->s.bitref);
+    liquid_free(_q->s.ref);
+    liquid_free(_q->s.delta);
+    liquid_free(_q->s.x_prev);
+    liquid_free(_q->s.v1);
+    liquid_free(_q->s.v2);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print cvsd object parameters
@@ -117,87 +126,55 @@ void cvsd_print(cvsd _q)
 {
     printf("cvsd codec:\n");
     printf("    num bits: %u\n", _q->num_bits);
-    printf("    zeta    : %8.4f\n", _q->zeta);
-#if CVSD_ENABLE_SIGNAL_CONDITIONING
-    printf("    alpha   : %8.4f\n", _q->alpha);
-#endif
+    printf("    zeta    : %8.4f\n", _q->s.zeta);
+    printf("    alpha   : %8.4f\n", _q->s.alpha);
+    printf("    channels: %u\n", _q->num_channels);
 }
 
-// encode single sample
-unsigned char cvsd_encode(cvsd _q,
-                          float _audio_sample)
+// reset internal state of all channels
+void cvsd_reset(cvsd _q)
 {
-    // push audio sample through pre-filter
-    float y;
-#if CVSD_ENABLE_SIGNAL_CONDITIONING
-    iirfilt_rrrf_execute(_q->prefilt, _audio_sample, &y);
-#else
-    y = _audio_sample;
-#endif
-
-    // determine output value
-    unsigned char bit = (_q->ref > y) ? 0 : 1;
-
-    // shift last value into buffer
-    _q->bitref <<= 1;
-    _q->bitref |= bit;
-    _q->bitref &= _q->bitmask;
-
-    // update delta
-    if (_q->bitref == 0 || _q->bitref == _q->bitmask)
-        _q->delta *= _q->zeta;  // increase delta
-    else
-        _q->delta /= _q->zeta;  // decrease delta
-
-    // limit delta
-    _q->delta = (_q->delta > _q->delta_max) ? _q->delta_max : _q->delta;
-    _q->delta = (_q->delta < _q->delta_min) ? _q->delta_min : _q->delta;
+    unsigned int c;
+    for (c=0; c<_q->num_channels; c++) {
+        _q->s.bitref[c] = 0;
+        _q->s.ref[c]    = 0.0f;
+        _q->s.delta[c]  = _q->s.delta_min;
+        _q->s.x_prev[c] = 0.0f;
+        _q->s.v1[c]     = 0.0f;
+        _q->s.v2[c]     = 0.0f;
+    }
+}
 
-    // update reference
-    _q->ref += (bit) ? _q->delta : -_q->delta;
+// get number of channels
+unsigned int cvsd_get_num_channels(cvsd _q)
+{
+    return _q->num_channels;
+}
 
-    // limit reference
-    _q->ref = (_q->ref >  1.0f) ?  1.0f : _q->ref;
-    _q->ref = (_q->ref < -1.0f) ? -1.0f : _q->ref;
+// validate single-channel object
+static void cvsd_check_single(cvsd _q, const char * _method)
+{
+    if (_q->num_channels != 1) {
+        fprintf(stderr,"error: cvsd_%s(), object has %u channels; use block methods\n",
+                _method, _q->num_channels);
+        exit(1);
+    }
+}
 
-    return bit;
+// encode single sample
+unsigned char cvsd_encode(cvsd _q,
+                          float _audio_sample)
+{
+    cvsd_check_single(_q, "encode");
+    return liquid_cvsd_encode_sample(&_q->s, 0, _audio_sample);
 }
 
 // decode single sample
 float cvsd_decode(cvsd _q,
                   unsigned char _bit)
 {
-    // append bit into register
-    _q->bitref <<= 1;
-    _q->bitref |= (_bit & 0x01);
-    _q->bitref &= _q->bitmask;
-
-    // update delta
-    if (_q->bitref == 0 || _q->bitref == _q->bitmask)
-        _q->delta *= _q->zeta;  // increase delta
-    else
-        _q->delta /= _q->zeta;  // decrease delta
-
-    // limit delta
-    _q->delta = (_q->delta > _q->delta_max) ? _q->delta_max : _q->delta;
-    _q->delta = (_q->delta < _q->delta_min) ? _q->delta_min : _q->delta;
-
-    // update reference
-    _q->ref += (_bit&0x01) ? _q->delta : -_q->delta;
-
-    // limit reference
-    _q->ref = (_q->ref >  1.0f) ?  1.0f : _q->ref;
-    _q->ref = (_q->ref < -1.0f) ? -1.0f : _q->ref;
-
-    // push reference value through post-filter
-    float y;
-#if CVSD_ENABLE_SIGNAL_CONDITIONING
-    iirfilt_rrrf_execute(_q->postfilt, _q->ref, &y);
-#else
-    y = _q->ref;
-#endif
-
-    return y;
+    cvsd_check_single(_q, "decode");
+    return liquid_cvsd_decode_sample(&_q->s, 0, _bit);
 }
 
 // encode 8 samples
@@ -205,15 +182,8 @@ void cvsd_encode8(cvsd _q,
                   float * _audio,
                   unsigned char * _data)
 {
-    unsigned char data=0x00;
-    unsigned int i;
-    for (i=0; i<8; i++) {
-        data <<= 1;
-        data |= cvsd_encode(_q, _audio[i]);
-    }
-
-    // set return value
-    *_data = data;
+    cvsd_check_single(_q, "encode8");
+    liquid_cvsd_encode_lanes(&_q->s, 0, 1, _audio, 1, _data);
 }
 
 // decode 8 samples
@@ -221,11 +191,48 @@ void cvsd_decode8(cvsd _q,
                   unsigned char _data,
                   float * _audio)
 {
-    unsigned char bit;
-    unsigned int i;
-    for (i=0; i<8; i++) {
-        bit = (_data >> (8-i-1)) & 0x01;
-        _audio[i] = cvsd_decode(_q, bit);
+    cvsd_check_single(_q, "decode8");
+    liquid_cvsd_decode_lanes(&_q->s, 0, 1, &_data, 1, _audio);
+}
+
+// encode block of samples, eight samples to each output byte (most
+// significant bit first); for multi-channel objects the input and
+// output are interleaved by channel
+//  _q      :   cvsd object
+//  _audio  :   audio samples [size: 8*_n*C x 1]
+//  _n      :   number of output bytes per channel
+//  _data   :   encoded bytes [size: _n*C x 1]
+void cvsd_encode_block(cvsd            _q,
+                       const float *   _audio,
+                       unsigned int    _n,
+                       unsigned char * _data)
+{
+#if HAVE_DOTPROD_AVX
+    if (_q->num_channels >= 8 && liquid_simd_get_kernel(LIQUID_SIMD_AUDIO) == LIQUID_SIMD_AVX2) {
+        liquid_cvsd_encode_lanes_avx2(&_q->s, _audio, _n, _data);
+        return;
     }
+#endif
+    liquid_cvsd_encode_lanes(&_q->s, 0, _q->num_channels, _audio, _n, _data);
 }
 
+// decode block of bytes, eight samples from each input byte (most
+// significant bit first); for multi-channel objects the input and
+// output are interleaved by channel
+//  _q      :   cvsd object
+//  _data   :   encoded bytes [size: _n*C x 1]
+//  _n      :   number of input bytes per channel
+//  _audio  :   audio samples [size: 8*_n*C x 1]
+void cvsd_decode_block(cvsd                  _q,
+                       const unsigned char * _data,
+                       unsigned int          _n,
+                       float *               _audio)
+{
+#if HAVE_DOTPROD_AVX
+    if (_q->num_channels >= 8 && liquid_simd_get_kernel(LIQUID_SIMD_AUDIO) == LIQUID_SIMD_AVX2) {
+        liquid_cvsd_decode_lanes_avx2(&_q->s, _data, _n, _audio);
+        return;
+    }
+#endif
+    liquid_cvsd_decode_lanes(&_q->s, 0, _q->num_channels, _data, _n, _audio);
+}
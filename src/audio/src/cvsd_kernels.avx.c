@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// cvsd_kernels.avx.c : multi-channel cvsd encode/decode kernels
+// (x86 AVX2)
+//
+// Eight channels are processed per vector with the same sequence of
+// operations as the portable kernels in cvsd_kernels.c; remaining
+// channels fall back to the portable kernels. These kernels are
+// compiled with per-function target attributes and are selected at
+// run time.
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// update bit history, step size and reference for eight channels
+// given the bit of each lane as 0 or 1
+__attribute__((target("avx2")))
+static inline void liquid_cvsd_step8(__m256i   _bit,
+                                     __m256i   _mask,
+                                     __m256    _zeta,
+                                     __m256    _dmin,
+                                     __m256    _dmax,
+                                     __m256i * _bitref,
+                                     __m256 *  _delta,
+                                     __m256 *  _ref)
+{
+    __m256 one  = _mm256_set1_ps( 1.0f);
+    __m256 mone = _mm256_set1_ps(-1.0f);
+
+    // shift bit into history
+    __m256i bitref = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi32(*_bitref,1), _bit), _mask);
+    *_bitref = bitref;
+
+    // update delta on runs of identical bits, then limit
+    __m256i run = _mm256_or_si256(_mm256_cmpeq_epi32(bitref, _mm256_setzero_si256()),
+                                  _mm256_cmpeq_epi32(bitref, _mask));
+    __m256 delta = _mm256_blendv_ps(_mm256_div_ps(*_delta, _zeta),
+                                    _mm256_mul_ps(*_delta, _zeta),
+                                    _mm256_castsi256_ps(run));
+    delta = _mm256_min_ps(_dmax, delta);
+    delta = _mm256_max_ps(_dmin, delta);
+    *_delta = delta;
+
+    // update and limit reference, negating delta for zero bits
+    __m256 neg = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_xor_si256(_bit, _mm256_set1_epi32(1)), 31));
+    __m256 ref = _mm256_add_ps(*_ref, _mm256_xor_ps(delta, neg));
+    ref = _mm256_min_ps(one,  ref);
+    ref = _mm256_max_ps(mone, ref);
+    *_ref = ref;
+}
+
+// encode all channels (see liquid.internal.h)
+__attribute__((target("avx2")))
+void liquid_cvsd_encode_lanes_avx2(struct liquid_cvsd_lanes_s * _s,
+                                   const float *                _audio,
+                                   unsigned int                 _n,
+                                   unsigned char *              _data)
+{
+    unsigned int C = _s->num_channels;
+    __m256i mask  = _mm256_set1_epi32((int)_s->bitmask);
+    __m256  zeta  = _mm256_set1_ps(_s->zeta);
+    __m256  dmin  = _mm256_set1_ps(_s->delta_min);
+    __m256  dmax  = _mm256_set1_ps(_s->delta_max);
+    __m256  alpha = _mm256_set1_ps(_s->alpha);
+    unsigned int c, i, k, j;
+    for (c=0; c+8<=C; c+=8) {
+        // load channel state into registers for the entire block
+        __m256i bitref = _mm256_loadu_si256((const __m256i*)&_s->bitref[c]);
+        __m256  delta  = _mm256_loadu_ps(&_s->delta[c]);
+        __m256  ref    = _mm256_loadu_ps(&_s->ref[c]);
+        __m256  x_prev = _mm256_loadu_ps(&_s->x_prev[c]);
+
+        for (i=0; i<_n; i++) {
+            __m256i acc = _mm256_setzero_si256();
+            for (k=0; k<8; k++) {
+                // pre-emphasis filter
+                __m256 x = _mm256_loadu_ps(&_audio[(8*i+k)*C + c]);
+                __m256 y = _mm256_sub_ps(x, _mm256_mul_ps(alpha, x_prev));
+                x_prev = x;
+
+                // bit is set unless reference exceeds filtered sample
+                __m256i bit = _mm256_srli_epi32(_mm256_castps_si256(_mm256_cmp_ps(ref, y, _CMP_NGT_UQ)), 31);
+                liquid_cvsd_step8(bit, mask, zeta, dmin, dmax, &bitref, &delta, &ref);
+                acc = _mm256_or_si256(_mm256_slli_epi32(acc,1), bit);
+            }
+
+            // store one byte per channel
+            unsigned int b[8];
+            _mm256_storeu_si256((__m256i*)b, acc);
+            for (j=0; j<8; j++)
+                _data[i*C + c + j] = (unsigned char)b[j];
+        }
+
+        _mm256_storeu_si256((__m256i*)&_s->bitref[c], bitref);
+        _mm256_storeu_ps(&_s->delta[c],  delta);
+        _mm256_storeu_ps(&_s->ref[c],    ref);
+        _mm256_storeu_ps(&_s->x_prev[c], x_prev);
+    }
+
+    // remaining channels
+    liquid_cvsd_encode_lanes(_s, c, C, _audio, _n, _data);
+}
+
+// decode all channels (see liquid.internal.h)
+__attribute__((target("avx2")))
+void liquid_cvsd_decode_lanes_avx2(struct liquid_cvsd_lanes_s * _s,
+                                   const unsigned char *        _data,
+                                   unsigned int                 _n,
+                                   float *                      _audio)
+{
+    unsigned int C = _s->num_channels;
+    __m256i mask = _mm256_set1_epi32((int)_s->bitmask);
+    __m256  zeta = _mm256_set1_ps(_s->zeta);
+    __m256  dmin = _mm256_set1_ps(_s->delta_min);
+    __m256  dmax = _mm256_set1_ps(_s->delta_max);
+    __m256  a1   = _mm256_set1_ps(_s->a1);
+    __m256  a2   = _mm256_set1_ps(_s->a2);
+    __m256i one  = _mm256_set1_epi32(1);
+    unsigned int c, i, k;
+    for (c=0; c+8<=C; c+=8) {
+        // load channel state into registers for the entire block
+        __m256i bitref = _mm256_loadu_si256((const __m256i*)&_s->bitref[c]);
+        __m256  delta  = _mm256_loadu_ps(&_s->delta[c]);
+        __m256  ref    = _mm256_loadu_ps(&_s->ref[c]);
+        __m256  v1     = _mm256_loadu_ps(&_s->v1[c]);
+        __m256  v2     = _mm256_loadu_ps(&_s->v2[c]);
+
+        for (i=0; i<_n; i++) {
+            // widen one byte per channel to 32-bit lanes
+            __m256i data = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&_data[i*C + c]));
+            for (k=0; k<8; k++) {
+                __m256i bit = _mm256_and_si256(_mm256_srli_epi32(data, 7-k), one);
+                liquid_cvsd_step8(bit, mask, zeta, dmin, dmax, &bitref, &delta, &ref);
+
+                // de-emphasis (and DC-blocking) filter, direct form II
+                __m256 v0 = _mm256_sub_ps(_mm256_sub_ps(ref, _mm256_mul_ps(a1, v1)), _mm256_mul_ps(a2, v2));
+                _mm256_storeu_ps(&_audio[(8*i+k)*C + c], _mm256_sub_ps(v0, v1));
+                v2 = v1;
+                v1 = v0;
+            }
+        }
+
+        _mm256_storeu_si256((__m256i*)&_s->bitref[c], bitref);
+        _mm256_storeu_ps(&_s->delta[c], delta);
+        _mm256_storeu_ps(&_s->ref[c],   ref);
+        _mm256_storeu_ps(&_s->v1[c],    v1);
+        _mm256_storeu_ps(&_s->v2[c],    v2);
+    }
+
+    // remaining channels
+    liquid_cvsd_decode_lanes(_s, c, C, _data, _n, _audio);
+}
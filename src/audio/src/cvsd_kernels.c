@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// cvsd_kernels.c : cvsd encode/decode kernels (portable C)
+//
+// Channel state is held as structure of arrays; the per-sample step
+// below is shared by the single-channel methods and the block kernels
+// so that both produce identical output.
+//
+
+#include "liquid.internal.h"
+
+// update bit history, step size and reference for one channel,
+// returning the updated reference
+static inline float liquid_cvsd_step(struct liquid_cvsd_lanes_s * _s,
+                                     unsigned int                 _c,
+                                     unsigned int                 _bit)
+{
+    // shift bit into history
+    unsigned int bitref = ((_s->bitref[_c] << 1) | _bit) & _s->bitmask;
+    _s->bitref[_c] = bitref;
+
+    // update delta: increase on runs of identical bits, otherwise decrease
+    float delta = _s->delta[_c];
+    delta = (bitref == 0 || bitref == _s->bitmask) ? delta * _s->zeta : delta / _s->zeta;
+
+    // limit delta
+    delta = (delta > _s->delta_max) ? _s->delta_max : delta;
+    delta = (delta < _s->delta_min) ? _s->delta_min : delta;
+    _s->delta[_c] = delta;
+
+    // update and limit reference
+    float ref = _s->ref[_c] + (_bit ? delta : -delta);
+    ref = (ref >  1.0f) ?  1.0f : ref;
+    ref = (ref < -1.0f) ? -1.0f : ref;
+    _s->ref[_c] = ref;
+    return ref;
+}
+
+// encode single sample on channel _c
+unsigned char liquid_cvsd_encode_sample(struct liquid_cvsd_lanes_s * _s,
+                                        unsigned int                 _c,
+                                        float                        _x)
+{
+    // pre-emphasis filter
+    float y = _x - _s->alpha * _s->x_prev[_c];
+    _s->x_prev[_c] = _x;
+
+    // determine output value and update state
+    unsigned int bit = (_s->ref[_c] > y) ? 0 : 1;
+    liquid_cvsd_step(_s, _c, bit);
+    return bit;
+}
+
+// decode single sample on channel _c
+float liquid_cvsd_decode_sample(struct liquid_cvsd_lanes_s * _s,
+                                unsigned int                 _c,
+                                unsigned char                _bit)
+{
+    float ref = liquid_cvsd_step(_s, _c, _bit & 0x01);
+
+    // de-emphasis (and DC-blocking) filter, direct form II
+    float v0 = ref - _s->a1 * _s->v1[_c] - _s->a2 * _s->v2[_c];
+    float y  = v0 - _s->v1[_c];
+    _s->v2[_c] = _s->v1[_c];
+    _s->v1[_c] = v0;
+    return y;
+}
+
+// encode _n bytes per channel on channels [_c0,_c1)
+void liquid_cvsd_encode_lanes(struct liquid_cvsd_lanes_s * _s,
+                              unsigned int                 _c0,
+                              unsigned int                 _c1,
+                              const float *                _audio,
+                              unsigned int                 _n,
+                              unsigned char *              _data)
+{
+    unsigned int C = _s->num_channels;
+    unsigned int i, k, c;
+    for (i=0; i<_n; i++) {
+        for (c=_c0; c<_c1; c++) {
+            unsigned char data = 0x00;
+            for (k=0; k<8; k++)
+                data = (data << 1) | liquid_cvsd_encode_sample(_s, c, _audio[(8*i+k)*C + c]);
+            _data[i*C + c] = data;
+        }
+    }
+}
+
+// decode _n bytes per channel on channels [_c0,_c1)
+void liquid_cvsd_decode_lanes(struct liquid_cvsd_lanes_s * _s,
+                              unsigned int                 _c0,
+                              unsigned int                 _c1,
+                              const unsigned char *        _data,
+                              unsigned int                 _n,
+                              float *                      _audio)
+{
+    unsigned int C = _s->num_channels;
+    unsigned int i, k, c;
+    for (i=0; i<_n; i++) {
+        for (c=_c0; c<_c1; c++) {
+            unsigned char data = _data[i*C + c];
+            for (k=0; k<8; k++)
+                _audio[(8*i+k)*C + c] = liquid_cvsd_decode_sample(_s, c, (data >> (7-k)) & 0x01);
+        }
+    }
+}
@@ -61,3 +61,86 @@ void autotest_cvsd_rmse_sine() {
     cvsd_destroy(cvsd_decoder);
 }
 
+
+// 
+// AUTOTEST: multi-channel block coding against single-channel objects
+//
+void autotest_cvsd_block_multi()
+{
+    unsigned int C = 13;    // channels (not a multiple of the lane width)
+    unsigned int n = 24;    // bytes per channel
+    unsigned int i, c;
+
+    // interleaved test signals with different frequency on each channel
+    float x[8*n*C];
+    for (i=0; i<8*n; i++) {
+        for (c=0; c<C; c++)
+            x[i*C + c] = 0.5f*sinf(0.05f*(c+1)*i + 0.3f*c);
+    }
+
+    // reference: one single-channel codec per channel
+    unsigned char b0[n*C];
+    float         y0[8*n*C];
+    for (c=0; c<C; c++) {
+        cvsd enc = cvsd_create(4, 1.5f, 0.9f);
+        cvsd dec = cvsd_create(4, 1.5f, 0.9f);
+        for (i=0; i<n; i++) {
+            float xc[8], yc[8];
+            unsigned int k;
+            for (k=0; k<8; k++)
+                xc[k] = x[(8*i+k)*C + c];
+            cvsd_encode8(enc, xc, &b0[i*C + c]);
+            cvsd_decode8(dec, b0[i*C + c], yc);
+            for (k=0; k<8; k++)
+                y0[(8*i+k)*C + c] = yc[k];
+        }
+        cvsd_destroy(enc);
+        cvsd_destroy(dec);
+    }
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        // code in two blocks to check state is carried over
+        cvsd enc = cvsd_create_multi(4, 1.5f, 0.9f, C);
+        cvsd dec = cvsd_create_multi(4, 1.5f, 0.9f, C);
+        CONTEND_EQUALITY(cvsd_get_num_channels(enc), C);
+        unsigned char b1[n*C];
+        float         y1[8*n*C];
+        cvsd_encode_block(enc, x,         n/2,     b1);
+        cvsd_encode_block(enc, x+4*n*C,   n-n/2,   b1+(n/2)*C);
+        cvsd_decode_block(dec, b0,        n/2,     y1);
+        cvsd_decode_block(dec, b0+(n/2)*C,n-n/2,   y1+4*n*C);
+
+        // bits are exact at the portable level; vector kernels may
+        // round the emphasis filters differently, which can flip a bit
+        // whose filtered sample lies on the reference
+        unsigned int num_diff = 0;
+        for (i=0; i<n*C; i++)
+            num_diff += b0[i] != b1[i];
+        if (level == LIQUID_SIMD_PORTABLE) {
+            CONTEND_EQUALITY(num_diff, 0);
+        } else {
+            CONTEND_LESS_THAN(num_diff, n*C/50 + 1);
+        }
+
+        // decoding the same bits differs only by rounding
+        for (i=0; i<8*n*C; i++)
+            CONTEND_DELTA(y1[i], y0[i], 1e-4f);
+
+        // reset restores the initial state
+        cvsd_reset(dec);
+        cvsd_decode_block(dec, b0, n, y1);
+        for (i=0; i<8*n*C; i++)
+            CONTEND_DELTA(y1[i], y0[i], 1e-4f);
+
+        cvsd_destroy(enc);
+        cvsd_destroy(dec);
+    }
+    liquid_simd_set_level(host);
+}
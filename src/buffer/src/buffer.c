@@ -48,7 +48,7 @@ struct BUFFER(_s) {
 
 BUFFER() BUFFER(_create)(buffer_type _type, unsigned int _n)
 {
-    BUFFER() b = (BUFFER()) malloc(sizeof(struct BUFFER(_s)));
+    BUFFER() b = (BUFFER()) liquid_malloc(sizeof(struct BUFFER(_s)));
     b->type = _type;
     b->len = _n;
 
@@ -57,7 +57,7 @@ BUFFER() BUFFER(_create)(buffer_type _type, unsigned int _n)
     else
         b->N = b->len;
 
-    b->v = (T*) malloc((b->N)*sizeof(T));
+    b->v = (T*) liquid_malloc((b->N)*sizeof(T));
     b->num_elements = 0;
     b->read_index = 0;
     b->write_index = 0;
@@ -67,8 +67,8 @@ BUFFER() BUFFER(_create)(buffer_type _type, unsigned int _n)
 
 void BUFFER(_destroy)(BUFFER() _b)
 {
-    free(_b->v);
-    free(_b);
+    liquid_free(_b->v);
+    liquid_free(_b);
 }
 
 void BUFFER(_print)(BUFFER() _b)
@@ -23,6 +23,13 @@
 //
 // circular buffer
 //
+// The buffer may be shared by exactly one producer thread (push,
+// write, reserve/commit) and one consumer thread (pop, read/release)
+// without locking: each side owns its own index and a running count
+// of elements it has handed over, published with release/acquire
+// ordering so that the other side only ever observes fully written
+// (or fully consumed) samples.
+//
 
 #include <stdio.h>
 #include <string.h>
@@ -30,8 +37,9 @@
 
 #include "liquid.internal.h"
 
-// linearize buffer (if necessary)
-void CBUFFER(_linearize)(CBUFFER() _q);
+// copy the first _n elements of the buffer past its end so that a
+// read straddling the wrap point is contiguous in memory
+void CBUFFER(_linearize)(CBUFFER() _q, unsigned int _n);
 
 // cbuffer object
 struct CBUFFER(_s) {
@@ -46,17 +54,28 @@ struct CBUFFER(_s) {
 
     // number of elements allocated in memory
     unsigned int num_allocated;
-    
-    // number of elements currently in buffer
-    unsigned int num_elements;
-    
-    // index to read
+
+    // consumer state: index to read, running count of elements released
     unsigned int read_index;
-    
-    // index to write
+    unsigned int num_released;
+
+    // producer state: index to write, running count of elements written
     unsigned int write_index;
+    unsigned int num_written;
 };
 
+// number of elements the consumer may read
+static inline unsigned int CBUFFER(_readable)(CBUFFER() _q)
+{
+    return __atomic_load_n(&_q->num_written, __ATOMIC_ACQUIRE) - _q->num_released;
+}
+
+// number of elements the producer may write
+static inline unsigned int CBUFFER(_writable)(CBUFFER() _q)
+{
+    return _q->max_size - (_q->num_written - __atomic_load_n(&_q->num_released, __ATOMIC_ACQUIRE));
+}
+
 // create circular buffer object of a particular size
 CBUFFER() CBUFFER(_create)(unsigned int _max_size)
 {
@@ -74,7 +93,7 @@ CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,
                                unsigned int _max_read)
 {
     // create main object
-    CBUFFER() q = (CBUFFER()) malloc(sizeof(struct CBUFFER(_s)));
+    CBUFFER() q = (CBUFFER()) liquid_malloc(sizeof(struct CBUFFER(_s)));
 
     // set internal properties
     q->max_size = _max_size;
@@ -84,7 +103,7 @@ CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,
     q->num_allocated = q->max_size + q->max_read - 1;
 
     // allocate internal memory array
-    q->v = (T*) malloc((q->num_allocated)*sizeof(T));
+    q->v = (T*) liquid_malloc((q->num_allocated)*sizeof(T));
 
     // reset object
     CBUFFER(_clear)(q);
@@ -97,23 +116,24 @@ CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,
 void CBUFFER(_destroy)(CBUFFER() _q)
 {
     // free internal memory
-    free(_q->v);
+    liquid_free(_q->v);
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print cbuffer object properties
 void CBUFFER(_print)(CBUFFER() _q)
 {
+    unsigned int num_elements = CBUFFER(_size)(_q);
     printf("cbuffer%s [max size: %u, max read: %u, elements: %u]\n",
             EXTENSION,
             _q->max_size,
             _q->max_read,
-            _q->num_elements);
+            num_elements);
 
     unsigned int i;
-    for (i=0; i<_q->num_elements; i++) {
+    for (i=0; i<num_elements; i++) {
         printf("%u", i);
         BUFFER_PRINT_LINE(_q,(_q->read_index+i)%(_q->max_size))
         printf("\n");
@@ -127,7 +147,7 @@ void CBUFFER(_debug_print)(CBUFFER() _q)
             EXTENSION,
             _q->max_size,
             _q->max_read,
-            _q->num_elements);
+            CBUFFER(_size)(_q));
 
     unsigned int i;
     for (i=0; i<_q->max_size; i++) {
@@ -157,18 +177,21 @@ void CBUFFER(_debug_print)(CBUFFER() _q)
     }
 }
 
-// clear internal buffer
+// clear internal buffer; not safe while either side is active
 void CBUFFER(_clear)(CBUFFER() _q)
 {
     _q->read_index   = 0;
     _q->write_index  = 0;
-    _q->num_elements = 0;
+    __atomic_store_n(&_q->num_released, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&_q->num_written,  0, __ATOMIC_RELEASE);
 }
 
 // get the number of elements currently in the buffer
 unsigned int CBUFFER(_size)(CBUFFER() _q)
 {
-    return _q->num_elements;
+    unsigned int num_released = __atomic_load_n(&_q->num_released, __ATOMIC_ACQUIRE);
+    unsigned int num_written  = __atomic_load_n(&_q->num_written,  __ATOMIC_ACQUIRE);
+    return num_written - num_released;
 }
 
 // get the maximum number of elements the buffer can hold
@@ -187,13 +210,13 @@ unsigned int CBUFFER(_max_read)(CBUFFER() _q)
 // return number of elements available for writing
 unsigned int CBUFFER(_space_available)(CBUFFER() _q)
 {
-    return _q->max_size - _q->num_elements;
+    return _q->max_size - CBUFFER(_size)(_q);
 }
 
 // is buffer full?
 int CBUFFER(_is_full)(CBUFFER() _q)
 {
-    return (_q->num_elements == _q->max_size ? 1 : 0);
+    return (CBUFFER(_size)(_q) == _q->max_size ? 1 : 0);
 }
 
 // write a single sample into the buffer
@@ -203,7 +226,7 @@ void CBUFFER(_push)(CBUFFER() _q,
                     T         _v)
 {
     // ensure buffer isn't already full
-    if (_q->num_elements == _q->max_size) {
+    if (CBUFFER(_writable)(_q) == 0) {
         fprintf(stderr,"warning: cbuffer%s_push(), no space available\n",
                 EXTENSION);
         return;
@@ -215,8 +238,8 @@ void CBUFFER(_push)(CBUFFER() _q,
     // update write index
     _q->write_index = (_q->write_index+1) % _q->max_size;
 
-    // increment number of elements
-    _q->num_elements++;
+    // publish sample to consumer
+    __atomic_store_n(&_q->num_written, _q->num_written + 1, __ATOMIC_RELEASE);
 }
 
 // write samples to the buffer
@@ -228,12 +251,11 @@ void CBUFFER(_write)(CBUFFER()    _q,
                      unsigned int _n)
 {
     // ensure number of samples to write doesn't exceed space available
-    if (_n > (_q->max_size - _q->num_elements)) {
+    if (_n > CBUFFER(_writable)(_q)) {
         printf("warning: cbuffer%s_write(), cannot write more elements than are available\n", EXTENSION);
         return;
     }
 
-    _q->num_elements += _n;
     // space available at end of buffer
     unsigned int k = _q->max_size - _q->write_index;
     //printf("n : %u, k : %u\n", _n, k);
@@ -245,8 +267,45 @@ void CBUFFER(_write)(CBUFFER()    _q,
         _q->write_index = _n - k;
     } else {
         memmove(_q->v + _q->write_index, _v, _n*sizeof(T));
-        _q->write_index += _n;
+        _q->write_index = (_q->write_index + _n) % _q->max_size;
     }
+
+    // publish samples to consumer
+    __atomic_store_n(&_q->num_written, _q->num_written + _n, __ATOMIC_RELEASE);
+}
+
+// reserve contiguous space in the buffer for writing in place
+//  _q              : circular buffer object
+//  _num_requested  : number of elements requested
+//  _v              : output pointer
+//  _num_reserved   : number of elements referenced by _v
+void CBUFFER(_reserve)(CBUFFER()      _q,
+                       unsigned int   _num_requested,
+                       T **           _v,
+                       unsigned int * _num_reserved)
+{
+    // limit to space available and to the end of the memory array
+    unsigned int n = CBUFFER(_writable)(_q);
+    if (_num_requested > n)
+        _num_requested = n;
+    if (_num_requested > _q->max_size - _q->write_index)
+        _num_requested = _q->max_size - _q->write_index;
+
+    *_v            = _q->v + _q->write_index;
+    *_num_reserved = _num_requested;
+}
+
+// commit _n samples written in place after cbuffer_reserve()
+void CBUFFER(_commit)(CBUFFER()    _q,
+                      unsigned int _n)
+{
+    if (_n > CBUFFER(_writable)(_q) || _n > _q->max_size - _q->write_index) {
+        printf("error: cbuffer%s_commit(), cannot commit more elements than were reserved\n", EXTENSION);
+        return;
+    }
+
+    _q->write_index = (_q->write_index + _n) % _q->max_size;
+    __atomic_store_n(&_q->num_written, _q->num_written + _n, __ATOMIC_RELEASE);
 }
 
 // remove and return a single element from the buffer
@@ -256,7 +315,7 @@ void CBUFFER(_pop)(CBUFFER()    _q,
                    T *          _v)
 {
     // ensure there is at least one element
-    if (_q->num_elements == 0) {
+    if (CBUFFER(_readable)(_q) == 0) {
         fprintf(stderr,"warning: cbuffer%s_pop(), no elements available\n",
                 EXTENSION);
         return;
@@ -269,8 +328,8 @@ void CBUFFER(_pop)(CBUFFER()    _q,
     // increment read index
     _q->read_index = (_q->read_index + 1) % _q->max_size;
 
-    // decrement number of elements in the buffer
-    _q->num_elements--;
+    // hand slot back to producer
+    __atomic_store_n(&_q->num_released, _q->num_released + 1, __ATOMIC_RELEASE);
 }
 
 // read buffer contents
@@ -284,16 +343,18 @@ void CBUFFER(_read)(CBUFFER()      _q,
                     unsigned int * _num_read)
 {
     // adjust number requested depending upon availability
-    if (_num_requested > _q->num_elements)
-        _num_requested = _q->num_elements;
+    unsigned int num_elements = CBUFFER(_readable)(_q);
+    if (_num_requested > num_elements)
+        _num_requested = num_elements;
     
     // restrict maximum number of elements to originally specified value
     if (_num_requested > _q->max_read)
         _num_requested = _q->max_read;
 
-    // linearize tail end of buffer if necessary
-    if (_num_requested > (_q->max_size - _q->read_index))
-        CBUFFER(_linearize)(_q);
+    // linearize wrapped portion of buffer if necessary
+    unsigned int k = _q->max_size - _q->read_index;
+    if (_num_requested > k)
+        CBUFFER(_linearize)(_q, _num_requested - k);
     
     // set output pointer appropriately
     *_v        = _q->v + _q->read_index;
@@ -305,13 +366,13 @@ void CBUFFER(_release)(CBUFFER()    _q,
                        unsigned int _n)
 {
     // advance read_index by _n making sure not to step on write_index
-    if (_n > _q->num_elements) {
+    if (_n > CBUFFER(_readable)(_q)) {
         printf("error: cbuffer%s_release(), cannot release more elements in buffer than exist\n", EXTENSION);
         return;
     }
 
     _q->read_index = (_q->read_index + _n) % _q->max_size;
-    _q->num_elements -= _n;
+    __atomic_store_n(&_q->num_released, _q->num_released + _n, __ATOMIC_RELEASE);
 }
 
 
@@ -319,19 +380,14 @@ void CBUFFER(_release)(CBUFFER()    _q,
 // internal methods
 //
 
-// internal linearization
-void CBUFFER(_linearize)(CBUFFER() _q)
+// internal linearization; only the elements being read are copied,
+// and these are owned by the consumer until released
+void CBUFFER(_linearize)(CBUFFER()    _q,
+                         unsigned int _n)
 {
-#if 0
-    // check to see if anything needs to be done
-    if ( (_q->max_size - _q->read_index) > _q->num_elements)
-        return;
-#endif
-
-    //printf("cbuffer linearize: [%6u : %6u], num elements: %6u, read index: %6u, write index: %6u\n",
-    //        _q->max_size, _q->max_read-1, _q->num_elements, _q->read_index, _q->write_index);
+    //printf("cbuffer linearize: [%6u : %6u], read index: %6u, write index: %6u, n: %u\n",
+    //        _q->max_size, _q->max_read-1, _q->read_index, _q->write_index, _n);
 
-    // move maximum amount
-    memmove(_q->v + _q->max_size, _q->v, (_q->max_read-1)*sizeof(T));
+    memmove(_q->v + _q->max_size, _q->v, _n*sizeof(T));
 }
 
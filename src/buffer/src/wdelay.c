@@ -40,13 +40,13 @@ struct WDELAY(_s) {
 WDELAY() WDELAY(_create)(unsigned int _delay)
 {
     // create main object
-    WDELAY() q = (WDELAY()) malloc(sizeof(struct WDELAY(_s)));
+    WDELAY() q = (WDELAY()) liquid_malloc(sizeof(struct WDELAY(_s)));
 
     // set internal values
     q->delay = _delay;
 
     // allocte memory
-    q->v = (T*) malloc((q->delay)*sizeof(T));
+    q->v = (T*) liquid_malloc((q->delay)*sizeof(T));
     q->read_index = 0;
 
     // clear window
@@ -63,7 +63,7 @@ WDELAY() WDELAY(_recreate)(WDELAY()     _q,
 {
     // copy internal buffer, re-aligned
     unsigned int ktmp = _q->delay;
-    T * vtmp = (T*) malloc(_q->delay * sizeof(T));
+    T * vtmp = (T*) liquid_malloc(_q->delay * sizeof(T));
     unsigned int i;
     for (i=0; i<_q->delay; i++)
         vtmp[i] = _q->v[ (i + _q->read_index) % _q->delay ];
@@ -77,7 +77,7 @@ WDELAY() WDELAY(_recreate)(WDELAY()     _q,
         WDELAY(_push)(_q, vtmp[i]);
 
     // free temporary array
-    free(vtmp);
+    liquid_free(vtmp);
 
     // return object
     return _q;
@@ -87,10 +87,10 @@ WDELAY() WDELAY(_recreate)(WDELAY()     _q,
 void WDELAY(_destroy)(WDELAY() _q)
 {
     // free internal array buffer
-    free(_q->v);
+    liquid_free(_q->v);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print delay buffer object's state to stdout
@@ -106,6 +106,12 @@ void WDELAY(_print)(WDELAY() _q)
     }
 }
 
+// get memory footprint of object and its buffers [bytes]
+unsigned long int WDELAY(_get_memory_usage)(WDELAY() _q)
+{
+    return sizeof(struct WDELAY(_s)) + _q->delay*sizeof(T);
+}
+
 // clear/reset state of object
 void WDELAY(_clear)(WDELAY() _q)
 {
@@ -139,3 +145,38 @@ void WDELAY(_push)(WDELAY() _q,
     _q->read_index %= _q->delay;
 }
 
+// execute delay on block of samples, equivalent to read() followed by
+// push() for each sample: the buffer contents are copied out in at most
+// two spans and the input copied in, with no per-sample work
+//  _q  :   delay buffer object
+//  _x  :   input samples [size: _n x 1]
+//  _n  :   number of input, output samples
+//  _y  :   output samples, must not overlap _x [size: _n x 1]
+void WDELAY(_execute_block)(WDELAY()     _q,
+                            T *          _x,
+                            unsigned int _n,
+                            T *          _y)
+{
+    unsigned int d = _q->delay;
+    unsigned int r = _q->read_index;
+
+    if (d == 0) {
+        memmove(_y, _x, _n*sizeof(T));
+    } else if (_n <= d) {
+        // output oldest _n samples, overwriting them with input
+        unsigned int n0 = d - r < _n ? d - r : _n;  // span before wrap
+        memmove(_y,        _q->v + r, n0*sizeof(T));
+        memmove(_y + n0,   _q->v,     (_n - n0)*sizeof(T));
+        memmove(_q->v + r, _x,        n0*sizeof(T));
+        memmove(_q->v,     _x + n0,   (_n - n0)*sizeof(T));
+        _q->read_index = (r + _n) % d;
+    } else {
+        // output buffer contents followed by leading input; trailing
+        // input refills buffer
+        memmove(_y,         _q->v + r,   (d - r)*sizeof(T));
+        memmove(_y + d - r, _q->v,       r*sizeof(T));
+        memmove(_y + d,     _x,          (_n - d)*sizeof(T));
+        memmove(_q->v,      _x + _n - d, d*sizeof(T));
+        _q->read_index = 0;
+    }
+}
@@ -23,6 +23,11 @@
 //
 // Windows, defined by macro
 //
+// The window is kept in a mirrored ring of twice its length: every
+// element is stored both at its ring position i and at i+len, so the
+// len most recent elements are always contiguous starting at the read
+// index. Pushing costs two stores and never moves the buffer contents.
+//
 
 #include "liquid.internal.h"
 
@@ -33,12 +38,9 @@
 struct WINDOW(_s) {
     T * v;                      // allocated array pointer
     unsigned int len;           // length of window
-    unsigned int m;             // floor(log2(len)) + 1
-    unsigned int n;             // 2^m
-    unsigned int mask;          // n-1
     unsigned int num_allocated; // number of elements allocated
-                                // in memory
-    unsigned int read_index;
+                                // in memory (2*len)
+    unsigned int read_index;    // ring index of oldest element
 };
 
 // create window buffer object of length _n
@@ -52,19 +54,16 @@ WINDOW() WINDOW(_create)(unsigned int _n)
     }
 
     // create initial object
-    WINDOW() q = (WINDOW()) malloc(sizeof(struct WINDOW(_s)));
+    WINDOW() q = (WINDOW()) liquid_malloc(sizeof(struct WINDOW(_s)));
 
     // set internal parameters
     q->len  = _n;                   // nominal window size
-    q->m    = liquid_msb_index(_n); // effectively floor(log2(len))+1
-    q->n    = 1<<(q->m);            // 2^m
-    q->mask = q->n - 1;             // bit mask
 
-    // number of elements to allocate to memory
-    q->num_allocated = q->n + q->len - 1;
+    // number of elements to allocate to memory (mirrored ring)
+    q->num_allocated = 2*q->len;
 
     // allocte memory
-    q->v = (T*) malloc((q->num_allocated)*sizeof(T));
+    q->v = (T*) liquid_malloc((q->num_allocated)*sizeof(T));
     q->read_index = 0;
 
     // clear window
@@ -114,10 +113,10 @@ WINDOW() WINDOW(_recreate)(WINDOW() _q, unsigned int _n)
 void WINDOW(_destroy)(WINDOW() _q)
 {
     // free internal memory array
-    free(_q->v);
+    liquid_free(_q->v);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print window object to stdout
@@ -157,6 +156,12 @@ void WINDOW(_debug_print)(WINDOW() _q)
     }
 }
 
+// get memory footprint of object and its buffers [bytes]
+unsigned long int WINDOW(_get_memory_usage)(WINDOW() _q)
+{
+    return sizeof(struct WINDOW(_s)) + _q->num_allocated*sizeof(T);
+}
+
 // clear/reset window object (initialize to zeros)
 void WINDOW(_clear)(WINDOW() _q)
 {
@@ -199,18 +204,14 @@ void WINDOW(_index)(WINDOW()     _q,
 //  _v      : single input element
 void WINDOW(_push)(WINDOW() _q, T _v)
 {
-    // increment index
-    _q->read_index++;
-
-    // wrap around pointer
-    _q->read_index &= _q->mask;
+    // overwrite oldest element and its mirror
+    _q->v[_q->read_index]           = _v;
+    _q->v[_q->read_index + _q->len] = _v;
 
-    // if pointer wraps around, copy excess memory
-    if (_q->read_index == 0)
-        memmove(_q->v, _q->v + _q->n, (_q->len-1)*sizeof(T));
-
-    // append value to end of buffer
-    _q->v[_q->read_index + _q->len - 1] = _v;
+    // advance read index to new oldest element
+    _q->read_index++;
+    if (_q->read_index == _q->len)
+        _q->read_index = 0;
 }
 
 // write array of elements onto window buffer
@@ -221,9 +222,25 @@ void WINDOW(_write)(WINDOW()     _q,
                     T *          _v,
                     unsigned int _n)
 {
-    // TODO make this more efficient
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        WINDOW(_push)(_q, _v[i]);
-}
+    // only the most recent len elements remain
+    if (_n >= _q->len) {
+        memmove(_q->v,          _v + _n - _q->len, _q->len*sizeof(T));
+        memmove(_q->v + _q->len, _v + _n - _q->len, _q->len*sizeof(T));
+        _q->read_index = 0;
+        return;
+    }
 
+    // copy in at most two segments around the wrap point, each with
+    // its mirror
+    unsigned int n0 = _q->len - _q->read_index;
+    if (n0 > _n)
+        n0 = _n;
+    memmove(_q->v + _q->read_index,           _v, n0*sizeof(T));
+    memmove(_q->v + _q->read_index + _q->len, _v, n0*sizeof(T));
+    memmove(_q->v,           _v + n0, (_n - n0)*sizeof(T));
+    memmove(_q->v + _q->len, _v + n0, (_n - n0)*sizeof(T));
+
+    _q->read_index += _n;
+    if (_q->read_index >= _q->len)
+        _q->read_index -= _q->len;
+}
@@ -26,7 +26,11 @@
 
 #include <stdlib.h>
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif
 
 // floating point
 void autotest_cbufferf()
@@ -292,3 +296,107 @@ void autotest_cbufferf_flow()
 }
 
 
+
+// write in place with reserve/commit, wrapping around the end
+void autotest_cbufferf_reserve()
+{
+    cbufferf q = cbufferf_create_max(10, 4);
+    float * w;
+    float * r;
+    unsigned int n, i;
+
+    // reserve more than available: limited to the buffer size
+    cbufferf_reserve(q, 16, &w, &n);
+    CONTEND_EQUALITY(n, 10);
+    for (i=0; i<7; i++)
+        w[i] = (float)i;
+    cbufferf_commit(q, 7);
+    CONTEND_EQUALITY(cbufferf_size(q), 7);
+
+    // consume 6, leaving one sample at index 6
+    cbufferf_read(q, 4, &r, &n);
+    CONTEND_EQUALITY(n, 4);
+    cbufferf_release(q, 4);
+    cbufferf_pop(q, NULL);
+    cbufferf_pop(q, NULL);
+
+    // reservation stops at the end of the memory array
+    cbufferf_reserve(q, 8, &w, &n);
+    CONTEND_EQUALITY(n, 3);
+    for (i=0; i<n; i++)
+        w[i] = (float)(7+i);
+    cbufferf_commit(q, n);
+    cbufferf_reserve(q, 8, &w, &n);
+    CONTEND_EQUALITY(n, 6);
+    w[0] = 10.0f;
+    cbufferf_commit(q, 1);
+
+    // read across the wrap point
+    float test[4] = {6, 7, 8, 9};
+    cbufferf_read(q, 4, &r, &n);
+    CONTEND_EQUALITY(n, 4);
+    CONTEND_SAME_DATA(r, test, 4*sizeof(float));
+    cbufferf_release(q, 4);
+    float v;
+    cbufferf_pop(q, &v);
+    CONTEND_EQUALITY(v, 10.0f);
+    CONTEND_EQUALITY(cbufferf_size(q), 0);
+
+    cbufferf_destroy(q);
+}
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#define CBUFFER_TEST_NUM_SAMPLES (200000)
+
+// producer thread: write a ramp in variable-sized blocks
+static void * cbufferf_test_producer(void * _arg)
+{
+    cbufferf q = (cbufferf) _arg;
+    unsigned int n = 0, k = 0;
+    float block[13];
+    while (n < CBUFFER_TEST_NUM_SAMPLES) {
+        unsigned int i, m = 1 + (k++ % 13);
+        if (m > CBUFFER_TEST_NUM_SAMPLES - n)
+            m = CBUFFER_TEST_NUM_SAMPLES - n;
+        if (cbufferf_space_available(q) < m)
+            continue;
+        if (k & 1) {
+            for (i=0; i<m; i++)
+                block[i] = (float)(n+i);
+            cbufferf_write(q, block, m);
+        } else {
+            float * w;
+            cbufferf_reserve(q, m, &w, &m);
+            for (i=0; i<m; i++)
+                w[i] = (float)(n+i);
+            cbufferf_commit(q, m);
+        }
+        n += m;
+    }
+    return NULL;
+}
+
+// samples handed from one thread to another arrive intact and in order
+void autotest_cbufferf_spsc()
+{
+    cbufferf q = cbufferf_create_max(64, 16);
+    pthread_t producer;
+    pthread_create(&producer, NULL, cbufferf_test_producer, q);
+
+    unsigned int n = 0, num_errors = 0;
+    while (n < CBUFFER_TEST_NUM_SAMPLES) {
+        float * r;
+        unsigned int i, num_read;
+        cbufferf_read(q, 1 + n % 16, &r, &num_read);
+        for (i=0; i<num_read; i++)
+            num_errors += r[i] != (float)(n+i);
+        cbufferf_release(q, num_read);
+        n += num_read;
+    }
+    pthread_join(producer, NULL);
+    CONTEND_EQUALITY(num_errors, 0);
+    CONTEND_EQUALITY(cbufferf_size(q), 0);
+
+    cbufferf_destroy(q);
+}
+#endif
@@ -141,3 +141,41 @@ void autotest_windowf()
     printf("done.\n");
 }
 
+
+//
+// AUTOTEST: windowcf block writes (wrapping and longer than window)
+//
+void autotest_windowcf_write()
+{
+    unsigned int n = 4000;
+    float complex x[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = (float)i + _Complex_I*(float)(n-i);
+
+    windowcf w0 = windowcf_create(37);
+    windowcf w1 = windowcf_create(37);
+    float complex * r0;
+    float complex * r1;
+    unsigned int lens[] = {1, 5, 36, 37, 38, 100, 3, 0, 36, 2};
+    unsigned int k = 0;
+    for (i=0; k+200<n; i++) {
+        unsigned int j;
+        unsigned int len = lens[i % 10];
+        for (j=0; j<len; j++)
+            windowcf_push(w0, x[k+j]);
+        windowcf_write(w1, x+k, len);
+        k += len;
+
+        windowcf_read(w0, &r0);
+        windowcf_read(w1, &r1);
+        CONTEND_SAME_DATA(r0, r1, 37*sizeof(float complex));
+
+        // the most recent sample is last
+        if (k > 0)
+            CONTEND_EQUALITY(crealf(r1[36]), crealf(x[k-1]));
+    }
+
+    windowcf_destroy(w0);
+    windowcf_destroy(w1);
+}
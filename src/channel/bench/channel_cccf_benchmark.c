@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define CHANNEL_CCCF_BENCH_API(MULTIPATH,SHADOWING)     \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ channel_cccf_bench(_start, _finish, _num_iterations, MULTIPATH, SHADOWING); }
+
+// Helper function to keep code base small
+void channel_cccf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _h_len,
+                        int                 _shadowing)
+{
+    unsigned int n = 1024;      // block length
+    unsigned int i;
+
+    // channel: noise, carrier offset, optional multipath and shadowing
+    channel_cccf q = channel_cccf_create();
+    channel_cccf_add_awgn(q, -60.0f, 20.0f);
+    channel_cccf_add_carrier_offset(q, 0.02f, 0.0f);
+    if (_h_len > 0)
+        channel_cccf_add_multipath(q, NULL, _h_len);
+    if (_shadowing)
+        channel_cccf_add_shadowing(q, 1.0f, 0.1f);
+
+    float complex x[n];
+    float complex y[n+8];
+    unsigned int ny;
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*0.3f*i);
+
+    // normalize number of iterations
+    *_num_iterations /= 400;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        channel_cccf_execute(q, x, n, y, &ny);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    channel_cccf_destroy(q);
+}
+
+// benchmarks: samples through channel
+void benchmark_channel_cccf_awgn        CHANNEL_CCCF_BENCH_API(0, 0)
+void benchmark_channel_cccf_multipath   CHANNEL_CCCF_BENCH_API(8, 0)
+void benchmark_channel_cccf_shadowing   CHANNEL_CCCF_BENCH_API(8, 1)
+
@@ -62,6 +62,11 @@ struct CHANNEL(_s) {
     IIRFILT()       shadowing_filter;   // shadowing filter object
     float           shadowing_std;      // shadowing standard deviation
     float           shadowing_fd;       // shadowing Doppler frequency
+
+    // random number generation
+    uint64_t        rng;                // generator state (see randf_r())
+    float *         buf;                // Gauss variates
+    unsigned int    buf_len;            // Gauss variate buffer length
 };
 
 // create structured channel object with default parameters
@@ -80,7 +85,7 @@ CHANNEL() CHANNEL(_create_delay)(unsigned int _m)
         exit(1);
     }
 
-    CHANNEL() q = (CHANNEL()) malloc(sizeof(struct CHANNEL(_s)));
+    CHANNEL() q = (CHANNEL()) liquid_malloc(sizeof(struct CHANNEL(_s)));
 
     // initialize all options as off
     q->enabled_resamp    = 0;
@@ -95,11 +100,17 @@ CHANNEL() CHANNEL(_create_delay)(unsigned int _m)
     q->resamp           = RESAMP(_create)(q->resamp_rate, q->resamp_m, 0.45f, 50.0f, 64);
     q->nco              = NCO(_create)(LIQUID_VCO);
     q->h_len            = 1;
-    q->h                = (TC*) malloc(q->h_len*sizeof(TC));
+    q->h                = (TC*) liquid_malloc(q->h_len*sizeof(TC));
     q->h[0]             = 1.0f;
     q->channel_filter   = FIRFILT(_create)(q->h, q->h_len);
     q->shadowing_filter = NULL;
 
+    // seed from the calling thread's generator so randf_seed() still
+    // governs the default noise sequence
+    liquid_rand_seed_object(&q->rng);
+    q->buf_len          = 0;
+    q->buf              = NULL;
+
     // return object
     return q;
 }
@@ -112,10 +123,11 @@ void CHANNEL(_destroy)(CHANNEL() _q)
     FIRFILT(_destroy)(_q->channel_filter);
     if (_q->shadowing_filter != NULL)
         IIRFILT(_destroy)(_q->shadowing_filter);
-    free(_q->h);
+    liquid_free(_q->h);
+    liquid_free(_q->buf);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print channel object
@@ -219,7 +231,7 @@ void CHANNEL(_add_multipath)(CHANNEL()    _q,
     // set values appropriately
     // TODO: test for types other than float complex
     if (_q->h_len != _h_len)
-        _q->h = (TC*) realloc(_q->h, _h_len*sizeof(TC));
+        _q->h = (TC*) liquid_realloc(_q->h, _h_len*sizeof(TC));
 
     // update length
     _q->h_len = _h_len;
@@ -281,17 +293,29 @@ void CHANNEL(_add_shadowing)(CHANNEL() _q,
     _q->shadowing_filter = IIRFILT(_create)(b,2,a,2);
 }
 
+// set seed for noise and shadowing generation; channel objects with
+// different seeds produce independent impairments and may be run
+// concurrently
+//  _q      : channel object
+//  _seed   : seed value
+void CHANNEL(_set_seed)(CHANNEL()    _q,
+                        unsigned int _seed)
+{
+    randf_seed_r(&_q->rng, _seed);
+}
+
 // get nominal channel delay [samples]
 unsigned int CHANNEL(_get_delay)(CHANNEL() _q)
 {
     return 2*RESAMP(_get_delay)(_q->resamp) + 1;
 }
 
-// apply channel impairments on input array
+// apply channel impairments on input array; each impairment is applied
+// to the whole block in turn, in place on the output array
 //  _q      : channel object
 //  _x      : input array [size: _nx x 1]
 //  _nx     : input array length
-//  _y      : output array
+//  _y      : output array, must not overlap _x
 //  _ny     : output array length
 void CHANNEL(_execute)(CHANNEL()      _q,
                        TI *           _x,
@@ -300,50 +324,47 @@ void CHANNEL(_execute)(CHANNEL()      _q,
                        unsigned int * _ny)
 {
     unsigned int i;
-    unsigned int j;
-    unsigned int num_resamp;    // resampler output length
     unsigned int n=0;           // number of output samples
 
-    // apply channel effects on each input sample
-    for (i=0; i<_nx; i++) {
-
-        // apply resampler (always push through resampling filter)
-        RESAMP(_execute)(_q->resamp, _x[i], _q->resamp_buf, &num_resamp);
-
-        // run resulting resampled result through remaining channel objects
-        for (j=0; j<num_resamp; j++) {
-            // apply filter
-            if (_q->enabled_multipath) {
-                FIRFILT(_push)(   _q->channel_filter,  _q->resamp_buf[j]);
-                FIRFILT(_execute)(_q->channel_filter, &_y[n]);
-            } else
-                _y[n] = _q->resamp_buf[j];
-
-            // apply shadowing if enabled
-            if (_q->enabled_shadowing) {
-                // TODO: use type-specific value other than float
-                float g = 0;
-                IIRFILT(_execute)(_q->shadowing_filter, randnf()*_q->shadowing_std, &g);
-                g /= _q->shadowing_fd * 6.9f;
-                g = powf(10.0f, g/20.0f);
-                _y[n] *= g;
-            }
-
-            // apply carrier if enabled
-            if (_q->enabled_carrier) {
-                NCO(_mix_up)(_q->nco, _y[n], &_y[n]);
-                NCO(_step)  (_q->nco);
-            }
-
-            // apply AWGN if enabled
-            if (_q->enabled_awgn) {
-                _y[n] *= _q->gamma;
-                _y[n] += _q->nstd * ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
-            }
-
-            // increment output sample counter
-            n++;
-        }
+    // apply resampler (always push through resampling filter)
+    RESAMP(_execute_block)(_q->resamp, _x, _nx, _y, &n);
+
+    // Gauss variates: one per sample for shadowing, two for AWGN
+    if (2*n > _q->buf_len) {
+        _q->buf_len = 2*n;
+        _q->buf     = (float*) liquid_realloc(_q->buf, _q->buf_len*sizeof(float));
+    }
+
+    // apply filter
+    if (_q->enabled_multipath)
+        FIRFILT(_execute_block)(_q->channel_filter, _y, n, _y);
+
+    // apply shadowing if enabled
+    if (_q->enabled_shadowing) {
+        // TODO: use type-specific value other than float
+        float * g = _q->buf;
+        randnf_block_r(&_q->rng, g, n);
+        for (i=0; i<n; i++)
+            g[i] *= _q->shadowing_std;
+        IIRFILT(_execute_block)(_q->shadowing_filter, g, n, g);
+
+        // g = 10^(g/(20*6.9*fd))
+        float k = M_LN10 / (20.0f * _q->shadowing_fd * 6.9f);
+        for (i=0; i<n; i++)
+            _y[i] *= expf(k*g[i]);
+    }
+
+    // apply carrier if enabled
+    if (_q->enabled_carrier)
+        NCO(_mix_block_up)(_q->nco, _y, _y, n);
+
+    // apply AWGN if enabled
+    if (_q->enabled_awgn) {
+        float * v = _q->buf;
+        randnf_block_r(&_q->rng, v, 2*n);
+        float nstd = _q->nstd * M_SQRT1_2;
+        for (i=0; i<n; i++)
+            _y[i] = _y[i]*_q->gamma + nstd*(v[2*i] + _Complex_I*v[2*i+1]);
     }
 
     // set output sample length
@@ -40,6 +40,10 @@ struct TVMPCH(_s) {
     float std;
     float alpha;
     float beta;
+
+    // random number generation
+    uint64_t rng;       // generator state (see randf_r())
+    float *  buf;       // Gauss variates [size: 2*(h_len-1) x 1]
 };
 
 // create time-varying multi-path channel emulator object
@@ -63,9 +67,9 @@ TVMPCH() TVMPCH(_create)(unsigned int _n,
     }
 
     // create filter object and initialize
-    TVMPCH() q = (TVMPCH()) malloc(sizeof(struct TVMPCH(_s)));
+    TVMPCH() q = (TVMPCH()) liquid_malloc(sizeof(struct TVMPCH(_s)));
     q->h_len = _n;
-    q->h     = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h     = (TC *) liquid_malloc((q->h_len)*sizeof(TC));
     q->beta  = _tau;
     q->std   = 2.0f * _std / sqrtf(q->beta);
     q->alpha = 1.0f - q->beta;
@@ -79,6 +83,10 @@ TVMPCH() TVMPCH(_create)(unsigned int _n,
     // create window (internal buffer)
     q->w = WINDOW(_create)(q->h_len);
 
+    // random number generation; seeded from the calling thread's generator
+    liquid_rand_seed_object(&q->rng);
+    q->buf = (float*) liquid_malloc(2*q->h_len*sizeof(float));
+
     // reset filter state (clear buffer)
     TVMPCH(_reset)(q);
 
@@ -90,8 +98,9 @@ TVMPCH() TVMPCH(_create)(unsigned int _n,
 void TVMPCH(_destroy)(TVMPCH() _q)
 {
     WINDOW(_destroy)(_q->w);
-    free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q->buf);
+    liquid_free(_q);
 }
 
 // reset internal state of filter object
@@ -100,6 +109,16 @@ void TVMPCH(_reset)(TVMPCH() _q)
     WINDOW(_clear)(_q->w);
 }
 
+// set seed for coefficient variation; objects with different seeds
+// evolve independently and may be run concurrently
+//  _q      :   filter object
+//  _seed   :   seed value
+void TVMPCH(_set_seed)(TVMPCH()     _q,
+                       unsigned int _seed)
+{
+    randf_seed_r(&_q->rng, _seed);
+}
+
 // print filter object internals (taps, buffer)
 void TVMPCH(_print)(TVMPCH() _q)
 {
@@ -120,10 +139,14 @@ void TVMPCH(_print)(TVMPCH() _q)
 void TVMPCH(_push)(TVMPCH() _q,
                    TI       _x)
 {
-    // update coefficients
+    // update coefficients; Gauss variates for all taps are drawn at once
     unsigned int i;
-    for (i=0; i<_q->h_len-1; i++)
-        _q->h[i] = _q->alpha*_q->h[i] + _q->beta*(randnf() + _Complex_I*randnf()) * _q->std * M_SQRT1_2;
+    unsigned int n = _q->h_len-1;
+    float g = _q->beta * _q->std * M_SQRT1_2;
+    float * v = _q->buf;
+    randnf_block_r(&_q->rng, v, 2*n);
+    for (i=0; i<n; i++)
+        _q->h[i] = _q->alpha*_q->h[i] + g*(v[2*i] + _Complex_I*v[2*i+1]);
 
     // push sample into window buffer
     WINDOW(_push)(_q->w, _x);
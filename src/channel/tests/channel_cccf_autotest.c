@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// AWGN: noise power matches noise floor, signal is scaled by SNR
+void autotest_channel_cccf_awgn()
+{
+    unsigned int n        = 40000;
+    float        noise_dB = -20.0f;
+    float        SNRdB    = 10.0f;
+    unsigned int i;
+
+    channel_cccf q = channel_cccf_create();
+    channel_cccf_add_awgn(q, noise_dB, SNRdB);
+    channel_cccf_set_seed(q, 1);
+
+    // noise only
+    float complex x[n];
+    float complex y[n+8];
+    unsigned int ny;
+    for (i=0; i<n; i++)
+        x[i] = 0.0f;
+    channel_cccf_execute(q, x, n, y, &ny);
+    CONTEND_EQUALITY(ny, n);
+    float e = 0.0f;
+    for (i=0; i<ny; i++)
+        e += crealf(y[i]*conjf(y[i]));
+    e /= (float)ny;
+    CONTEND_DELTA(10*log10f(e), noise_dB, 0.1f);
+
+    channel_cccf_destroy(q);
+}
+
+// channels with equal seeds produce identical impairments, different
+// seeds independent ones
+void autotest_channel_cccf_seed()
+{
+    unsigned int n = 2000;
+    unsigned int i;
+
+    channel_cccf q[3];
+    for (i=0; i<3; i++) {
+        q[i] = channel_cccf_create();
+        channel_cccf_add_awgn(q[i], -30.0f, 20.0f);
+        channel_cccf_add_shadowing(q[i], 1.0f, 0.1f);
+        channel_cccf_add_carrier_offset(q[i], 0.01f, 0.3f);
+    }
+    channel_cccf_set_seed(q[0], 42);
+    channel_cccf_set_seed(q[1], 42);
+    channel_cccf_set_seed(q[2], 43);
+
+    float complex x[n];
+    float complex y[3][n+8];
+    unsigned int ny;
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*0.1f*i);
+    for (i=0; i<3; i++)
+        channel_cccf_execute(q[i], x, n, y[i], &ny);
+
+    CONTEND_SAME_DATA(y[0], y[1], ny*sizeof(float complex));
+    CONTEND_EXPRESSION(memcmp(y[0], y[2], ny*sizeof(float complex)) != 0);
+
+    for (i=0; i<3; i++)
+        channel_cccf_destroy(q[i]);
+}
+
+// multipath applied to the block matches filtering the unimpaired
+// channel output, across several calls of different lengths
+void autotest_channel_cccf_multipath()
+{
+    unsigned int h_len = 7;
+    unsigned int n     = 600;
+    float tol = 1e-5f;
+    unsigned int i;
+
+    float complex h[h_len];
+    for (i=0; i<h_len; i++)
+        h[i] = 0.3f*cexpf(_Complex_I*1.3f*i) / (float)(i+1);
+
+    channel_cccf q0 = channel_cccf_create();
+    channel_cccf q1 = channel_cccf_create();
+    channel_cccf_add_multipath(q1, h, h_len);
+    firfilt_cccf f = firfilt_cccf_create(h, h_len);
+
+    float complex x[n];
+    float complex y0[n+8];
+    float complex y1[n+8];
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*0.7f*i*i);
+
+    unsigned int num_blocks[3] = {1, 97, 502};
+    unsigned int j, k = 0;
+    for (j=0; j<3; j++) {
+        unsigned int ny0, ny1;
+        channel_cccf_execute(q0, &x[k], num_blocks[j], y0, &ny0);
+        channel_cccf_execute(q1, &x[k], num_blocks[j], y1, &ny1);
+        CONTEND_EQUALITY(ny0, ny1);
+        firfilt_cccf_execute_block(f, y0, ny0, y0);
+        for (i=0; i<ny0; i++) {
+            CONTEND_DELTA(crealf(y1[i]), crealf(y0[i]), tol);
+            CONTEND_DELTA(cimagf(y1[i]), cimagf(y0[i]), tol);
+        }
+        k += num_blocks[j];
+    }
+
+    channel_cccf_destroy(q0);
+    channel_cccf_destroy(q1);
+    firfilt_cccf_destroy(f);
+}
+
+// time-varying multipath: repeatable for a given seed
+void autotest_tvmpch_cccf_seed()
+{
+    unsigned int n = 500;
+    unsigned int i;
+
+    tvmpch_cccf q0 = tvmpch_cccf_create(5, 0.1f, 0.01f);
+    tvmpch_cccf q1 = tvmpch_cccf_create(5, 0.1f, 0.01f);
+    tvmpch_cccf_set_seed(q0, 9);
+    tvmpch_cccf_set_seed(q1, 9);
+
+    float complex x[n];
+    float complex y0[n];
+    float complex y1[n];
+    for (i=0; i<n; i++)
+        x[i] = (i%3==0) ? 1.0f : -1.0f;
+    tvmpch_cccf_execute_block(q0, x, n, y0);
+    tvmpch_cccf_execute_block(q1, x, n, y1);
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float complex));
+
+    tvmpch_cccf_destroy(q0);
+    tvmpch_cccf_destroy(q1);
+}
+
@@ -98,14 +98,14 @@ void DOTPROD(_run4)(TC *         _h,
 DOTPROD() DOTPROD(_create)(TC *         _h,
                            unsigned int _n)
 {
-    DOTPROD() q = (DOTPROD()) malloc(sizeof(struct DOTPROD(_s)));
+    DOTPROD() q = (DOTPROD()) liquid_malloc(sizeof(struct DOTPROD(_s)));
     q->n = _n;
 
-    // allocate memory for coefficients
-    q->h = (TC*) malloc((q->n)*sizeof(TC));
+    // allocate memory for coefficients (aligned)
+    q->h = (TC*) liquid_malloc_aligned((q->n)*sizeof(TC));
 
     // move coefficients
-    memmove(q->h, _h, (q->n)*sizeof(TC));
+    DOTPROD(_update_coefficients)(q, _h);
 
     // return object
     return q;
@@ -124,22 +124,32 @@ DOTPROD() DOTPROD(_recreate)(DOTPROD()    _q,
         // set new length
         _q->n = _n;
 
-        // re-allocate memory
-        _q->h = (TC*) realloc(_q->h, (_q->n)*sizeof(TC));
+        // re-allocate memory (realloc does not preserve alignment)
+        liquid_free_aligned(_q->h);
+        _q->h = (TC*) liquid_malloc_aligned((_q->n)*sizeof(TC));
     }
 
     // move new coefficients
-    memmove(_q->h, _h, (_q->n)*sizeof(TC));
+    DOTPROD(_update_coefficients)(_q, _h);
 
     // return re-structured object
     return _q;
 }
 
+// overwrite coefficients in place
+//  _q      :   dot product object
+//  _h      :   new coefficients [size: 1 x _n]
+void DOTPROD(_update_coefficients)(DOTPROD() _q,
+                                   TC *      _h)
+{
+    memmove(_q->h, _h, (_q->n)*sizeof(TC));
+}
+
 // destroy dot product object
 void DOTPROD(_destroy)(DOTPROD() _q)
 {
-    free(_q->h);    // free coefficients memory
-    free(_q);       // free main object memory
+    liquid_free_aligned(_q->h); // free coefficients memory
+    liquid_free(_q);       // free main object memory
 }
 
 // print dot product object
@@ -154,6 +164,12 @@ void DOTPROD(_print)(DOTPROD() _q)
     }
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int DOTPROD(_get_memory_usage)(DOTPROD() _q)
+{
+    return sizeof(struct DOTPROD(_s)) + _q->n*sizeof(TC);
+}
+
 // execute structured dot product
 //  _q      :   dot product object
 //  _x      :   input array [size: 1 x _n]
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Batched dot product: compute several dot products of equal length
+// against separate coefficient sets and input arrays in one call
+//
+// Coefficients are stored interleaved in groups of DOTPROD_BATCH_WIDTH
+// sets so that each tap of the inner loop updates a full group of
+// accumulators at once,
+//  h = { h0[0], h1[0], h2[0], h3[0], h0[1], h1[1], ... h3[n-1],
+//        h4[0], h5[0], ... }
+// Groups are padded with zero-valued coefficients when the number of
+// sets is not a multiple of the group width.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// number of coefficient sets interleaved in a group
+#define DOTPROD_BATCH_WIDTH (4)
+
+// batched dot product object
+struct DOTPROD(_batch_s) {
+    TC * h;             // interleaved coefficients array
+    unsigned int n;     // length of each dot product
+    unsigned int num;   // number of dot products
+    unsigned int num_groups; // number of interleaved groups
+};
+
+// create batched dot product object
+//  _h      :   coefficients array, one set after another [size: _num*_n x 1]
+//  _n      :   length of each dot product
+//  _num    :   number of dot products (coefficient sets)
+DOTPROD(_batch) DOTPROD(_batch_create)(TC *         _h,
+                                       unsigned int _n,
+                                       unsigned int _num)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: dotprod_batch_create(), dot product length must be greater than zero\n");
+        exit(1);
+    } else if (_num == 0) {
+        fprintf(stderr,"error: dotprod_batch_create(), number of dot products must be greater than zero\n");
+        exit(1);
+    }
+
+    DOTPROD(_batch) q = (DOTPROD(_batch)) liquid_malloc(sizeof(struct DOTPROD(_batch_s)));
+    q->n          = _n;
+    q->num        = _num;
+    q->num_groups = (_num + DOTPROD_BATCH_WIDTH - 1) / DOTPROD_BATCH_WIDTH;
+
+    // allocate memory for interleaved coefficients (aligned)
+    unsigned int h_len = q->num_groups * DOTPROD_BATCH_WIDTH * q->n;
+    q->h = (TC*) liquid_malloc_aligned(h_len*sizeof(TC));
+
+    // interleave coefficients
+    DOTPROD(_batch_update_coefficients)(q, _h);
+
+    // return object
+    return q;
+}
+
+// overwrite coefficients in place (no allocation)
+//  _q      :   batched dot product object
+//  _h      :   coefficients array, one set after another [size: _num*_n x 1]
+void DOTPROD(_batch_update_coefficients)(DOTPROD(_batch) _q,
+                                         TC *            _h)
+{
+    // interleave coefficients, padding unused lanes with zeros
+    unsigned int g, k, l;
+    for (g=0; g<_q->num_groups; g++) {
+        for (k=0; k<_q->n; k++) {
+            for (l=0; l<DOTPROD_BATCH_WIDTH; l++) {
+                unsigned int j = g*DOTPROD_BATCH_WIDTH + l;
+                _q->h[(g*_q->n + k)*DOTPROD_BATCH_WIDTH + l] = j < _q->num ? _h[j*_q->n + k] : 0;
+            }
+        }
+    }
+}
+
+// read back coefficients
+//  _q      :   batched dot product object
+//  _h      :   coefficients array, one set after another [size: _num*_n x 1]
+void DOTPROD(_batch_get_coefficients)(DOTPROD(_batch) _q,
+                                      TC *            _h)
+{
+    unsigned int j, k;
+    for (j=0; j<_q->num; j++) {
+        unsigned int g = j / DOTPROD_BATCH_WIDTH;
+        unsigned int l = j % DOTPROD_BATCH_WIDTH;
+        for (k=0; k<_q->n; k++)
+            _h[j*_q->n + k] = _q->h[(g*_q->n + k)*DOTPROD_BATCH_WIDTH + l];
+    }
+}
+
+// destroy batched dot product object
+void DOTPROD(_batch_destroy)(DOTPROD(_batch) _q)
+{
+    liquid_free_aligned(_q->h); // free coefficients memory
+    liquid_free(_q);       // free main object memory
+}
+
+// print batched dot product object
+void DOTPROD(_batch_print)(DOTPROD(_batch) _q)
+{
+    printf("dotprod_batch [%u x %u coefficients]:\n", _q->num, _q->n);
+    unsigned int j, k;
+    for (j=0; j<_q->num; j++) {
+        printf("  set %3u:\n", j);
+        unsigned int g = j / DOTPROD_BATCH_WIDTH;
+        unsigned int l = j % DOTPROD_BATCH_WIDTH;
+        for (k=0; k<_q->n; k++) {
+            TC h = _q->h[(g*_q->n + k)*DOTPROD_BATCH_WIDTH + l];
+            printf("  %4u: %12.8f + j*%12.8f\n", k, crealf(h), cimagf(h));
+        }
+    }
+}
+
+// get memory footprint of object and its interleaved coefficients,
+// including the zero padding of the last group [bytes]
+unsigned long int DOTPROD(_batch_get_memory_usage)(DOTPROD(_batch) _q)
+{
+    unsigned long int h_len = _q->num_groups * DOTPROD_BATCH_WIDTH * _q->n;
+    return sizeof(struct DOTPROD(_batch_s)) + h_len*sizeof(TC);
+}
+
+// execute batched dot product
+//  _q      :   batched dot product object
+//  _x      :   array of input array pointers [size: _num x 1], each [size: _n x 1]
+//  _y      :   output dot products [size: _num x 1]
+void DOTPROD(_execute_batch)(DOTPROD(_batch) _q,
+                             TI **           _x,
+                             TO *            _y)
+{
+    unsigned int g, k, l;
+    for (g=0; g<_q->num_groups; g++) {
+        unsigned int j0 = g*DOTPROD_BATCH_WIDTH;
+
+        // input pointers for this group; padded lanes re-use the
+        // first input (their coefficients are zero)
+        TI * x[DOTPROD_BATCH_WIDTH];
+        for (l=0; l<DOTPROD_BATCH_WIDTH; l++)
+            x[l] = _x[ j0+l < _q->num ? j0+l : j0 ];
+
+        // accumulate full group for each tap
+        TO r[DOTPROD_BATCH_WIDTH] = {0};
+        TC * h = &_q->h[g*_q->n*DOTPROD_BATCH_WIDTH];
+        for (k=0; k<_q->n; k++) {
+            for (l=0; l<DOTPROD_BATCH_WIDTH; l++)
+                r[l] += h[l] * x[l][k];
+            h += DOTPROD_BATCH_WIDTH;
+        }
+
+        // store results
+        for (l=0; l<DOTPROD_BATCH_WIDTH && j0+l<_q->num; l++)
+            _y[j0+l] = r[l];
+    }
+}
+
+
+// execute batched dot product with every coefficient set applied to
+// the same input (e.g. all phases of a polyphase filterbank on one
+// window): each input sample is loaded once per group and accumulated
+// into all of its outputs
+//  _q      :   batched dot product object
+//  _x      :   shared input array [size: _n x 1]
+//  _y      :   output dot products [size: _num x 1]
+void DOTPROD(_execute_batch_shared)(DOTPROD(_batch) _q,
+                                    TI *            _x,
+                                    TO *            _y)
+{
+#if HAVE_DOTPROD_AVX && defined(DOTPROD_BATCH_SHARED_AVX2)
+    liquid_simd_level level = liquid_simd_get_level();
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        DOTPROD_BATCH_SHARED_AVX2(_q->h, _q->n, _q->num, _x, _y);
+        return;
+    }
+#endif
+
+    unsigned int g, k, l;
+    for (g=0; g<_q->num_groups; g++) {
+        unsigned int j0 = g*DOTPROD_BATCH_WIDTH;
+
+        // accumulate full group for each tap
+        TO r[DOTPROD_BATCH_WIDTH] = {0};
+        TC * h = &_q->h[g*_q->n*DOTPROD_BATCH_WIDTH];
+        for (k=0; k<_q->n; k++) {
+            TI x = _x[k];
+            for (l=0; l<DOTPROD_BATCH_WIDTH; l++)
+                r[l] += h[l] * x;
+            h += DOTPROD_BATCH_WIDTH;
+        }
+
+        // store results
+        for (l=0; l<DOTPROD_BATCH_WIDTH && j0+l<_q->num; l++)
+            _y[j0+l] = r[l];
+    }
+}
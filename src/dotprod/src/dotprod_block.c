@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Block dot product: compute several consecutive outputs of a
+// finite impulse response filter from one contiguous input span
+//
+// Outputs are computed in groups of DOTPROD_BLOCK_WIDTH; the taps are
+// iterated on the outer loop so that each coefficient is loaded once
+// and applied to every output in the group while the accumulators
+// stay in registers:
+//
+//  y[k] = sum_{i=0}^{n-1} h[i] x[k*stride + i],  k = 0, 1, ... num-1
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// number of outputs computed simultaneously
+#define DOTPROD_BLOCK_WIDTH (4)
+
+// run block dot product
+//  _h      :   coefficients array [size: _n x 1]
+//  _n      :   dot product length
+//  _x      :   input array [size: (_num-1)*_stride + _n x 1]
+//  _stride :   input offset between consecutive outputs, _stride > 0
+//  _num    :   number of outputs
+//  _y      :   output array [size: _num x 1]
+void DOTPROD(_run_block)(TC *         _h,
+                         unsigned int _n,
+                         TI *         _x,
+                         unsigned int _stride,
+                         unsigned int _num,
+                         TO *         _y)
+{
+#if HAVE_DOTPROD_AVX
+    // consecutive outputs: use vector kernel with one output per lane
+    if (_stride == 1) {
+        switch (liquid_simd_get_level()) {
+        case LIQUID_SIMD_AVX512F:
+            DOTPROD(_run_block_avx512f)(_h, _n, _x, _num, _y);
+            return;
+        case LIQUID_SIMD_AVX2:
+            DOTPROD(_run_block_avx2)(_h, _n, _x, _num, _y);
+            return;
+        default:;
+        }
+    }
+#endif
+
+    unsigned int i, k, l;
+
+    // full groups
+    for (k=0; k + DOTPROD_BLOCK_WIDTH <= _num; k += DOTPROD_BLOCK_WIDTH) {
+        TO r[DOTPROD_BLOCK_WIDTH] = {0};
+        TI * x = &_x[k*_stride];
+
+        if (_stride == 1) {
+            // inputs of consecutive outputs overlap; re-use each
+            // loaded input across the group
+            for (i=0; i<_n; i++) {
+                TC h = _h[i];
+                for (l=0; l<DOTPROD_BLOCK_WIDTH; l++)
+                    r[l] += h * x[i+l];
+            }
+        } else {
+            for (i=0; i<_n; i++) {
+                TC h = _h[i];
+                for (l=0; l<DOTPROD_BLOCK_WIDTH; l++)
+                    r[l] += h * x[i + l*_stride];
+            }
+        }
+
+        for (l=0; l<DOTPROD_BLOCK_WIDTH; l++)
+            _y[k+l] = r[l];
+    }
+
+    // remaining outputs
+    for ( ; k<_num; k++)
+        DOTPROD(_run4)(_h, &_x[k*_stride], _n, &_y[k]);
+}
+
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Complex floating-point dot product (AVX2/FMA, AVX-512F)
+//
+// Coefficients are split into repeated real and imaginary arrays
+//  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
+//  hq = { cimagf(_h[0]), cimagf(_h[0]), ... cimagf(_h[n-1]), cimagf(_h[n-1])}
+// and accumulated against the interleaved input separately:
+//
+//  sumi = { x.real * h.real, x.imag * h.real, ... }
+//  sumq = { x.real * h.imag, x.imag * h.imag, ... }
+//
+// (a + jb)(c + jd) = (ac - bd) + j(ad + bc) gives
+//  y.real = sum(sumi[even]) - sum(sumq[odd])
+//  y.imag = sum(sumi[odd])  + sum(sumq[even])
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// AVX2/FMA dot product
+//  _hi     :   repeated real coefficients, 32-byte aligned [size: 2*_n x 1]
+//  _hq     :   repeated imag coefficients, 32-byte aligned [size: 2*_n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dot product length
+//  _y      :   output sample pointer
+__attribute__((target("avx2,fma")))
+void dotprod_cccf_execute_avx2(float *         _hi,
+                               float *         _hq,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m256 sumi0 = _mm256_setzero_ps();
+    __m256 sumi1 = _mm256_setzero_ps();
+    __m256 sumq0 = _mm256_setzero_ps();
+    __m256 sumq1 = _mm256_setzero_ps();
+    __m256 v0, v1;
+
+    // r = 16*floor(n/16)
+    unsigned int r = (n >> 4) << 4;
+
+    unsigned int i;
+    for (i=0; i<r; i+=16) {
+        // load inputs into register (unaligned)
+        v0 = _mm256_loadu_ps(&x[i  ]);
+        v1 = _mm256_loadu_ps(&x[i+8]);
+
+        // multiply by coefficients (aligned) and accumulate
+        sumi0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hi[i  ]), sumi0);
+        sumq0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hq[i  ]), sumq0);
+        sumi1 = _mm256_fmadd_ps(v1, _mm256_load_ps(&_hi[i+8]), sumi1);
+        sumq1 = _mm256_fmadd_ps(v1, _mm256_load_ps(&_hq[i+8]), sumq1);
+    }
+
+    // t = 8*floor(n/8)
+    unsigned int t = (n >> 3) << 3;
+    for ( ; i<t; i+=8) {
+        v0 = _mm256_loadu_ps(&x[i]);
+        sumi0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hi[i]), sumi0);
+        sumq0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hq[i]), sumq0);
+    }
+
+    // fold down
+    sumi0 = _mm256_add_ps(sumi0, sumi1);
+    sumq0 = _mm256_add_ps(sumq0, sumq1);
+
+    // swap real/imag pairs of quadrature sum and combine:
+    //  { sumi[0] - sumq[1], sumi[1] + sumq[0], ... }
+    sumq0 = _mm256_permute_ps(sumq0, _MM_SHUFFLE(2,3,0,1));
+    sumi0 = _mm256_addsub_ps(sumi0, sumq0);
+    __m128 s = _mm_add_ps( _mm256_castps256_ps128(sumi0), _mm256_extractf128_ps(sumi0, 1) );
+
+    // unload packed array
+    float w[4] __attribute__((aligned(16)));
+    _mm_store_ps(w, s);
+    float complex total = (w[0] + w[2]) + (w[1] + w[3]) * _Complex_I;
+
+    // cleanup
+    for (i=t/2; i<_n; i++)
+        total += _x[i] * ( _hi[2*i] + _hq[2*i]*_Complex_I );
+
+    // set return value
+    *_y = total;
+}
+
+// AVX-512F dot product
+//  _hi     :   repeated real coefficients, 64-byte aligned [size: 2*_n x 1]
+//  _hq     :   repeated imag coefficients, 64-byte aligned [size: 2*_n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dot product length
+//  _y      :   output sample pointer
+__attribute__((target("avx512f")))
+void dotprod_cccf_execute_avx512f(float *         _hi,
+                                  float *         _hq,
+                                  float complex * _x,
+                                  unsigned int    _n,
+                                  float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m512 sumi0 = _mm512_setzero_ps();
+    __m512 sumi1 = _mm512_setzero_ps();
+    __m512 sumq0 = _mm512_setzero_ps();
+    __m512 sumq1 = _mm512_setzero_ps();
+    __m512 v0, v1;
+
+    // r = 32*floor(n/32)
+    unsigned int r = (n >> 5) << 5;
+
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        v0 = _mm512_loadu_ps(&x[i   ]);
+        v1 = _mm512_loadu_ps(&x[i+16]);
+
+        sumi0 = _mm512_fmadd_ps(v0, _mm512_load_ps(&_hi[i   ]), sumi0);
+        sumq0 = _mm512_fmadd_ps(v0, _mm512_load_ps(&_hq[i   ]), sumq0);
+        sumi1 = _mm512_fmadd_ps(v1, _mm512_load_ps(&_hi[i+16]), sumi1);
+        sumq1 = _mm512_fmadd_ps(v1, _mm512_load_ps(&_hq[i+16]), sumq1);
+    }
+
+    // remaining samples using masked loads
+    for ( ; i<n; i+=16) {
+        __mmask16 m = (n - i) >= 16 ? 0xffff : (__mmask16)((1u << (n - i)) - 1);
+        v0 = _mm512_maskz_loadu_ps(m, &x[i]);
+        sumi0 = _mm512_fmadd_ps(v0, _mm512_maskz_load_ps(m, &_hi[i]), sumi0);
+        sumq0 = _mm512_fmadd_ps(v0, _mm512_maskz_load_ps(m, &_hq[i]), sumq0);
+    }
+
+    // fold down
+    sumi0 = _mm512_add_ps(sumi0, sumi1);
+    sumq0 = _mm512_add_ps(sumq0, sumq1);
+
+    // set return value
+    *_y = (_mm512_mask_reduce_add_ps(0x5555, sumi0) - _mm512_mask_reduce_add_ps(0xaaaa, sumq0)) +
+          (_mm512_mask_reduce_add_ps(0xaaaa, sumi0) + _mm512_mask_reduce_add_ps(0x5555, sumq0)) * _Complex_I;
+}
+
+
+// AVX2/FMA block dot product: each pair of vector lanes accumulates a
+// different (complex) output. The real and imaginary coefficient
+// parts are broadcast and applied to the input and its pair-swapped
+// copy, respectively, for two vectors of consecutive outputs:
+//
+//  yi = { x.real * h.real, x.imag * h.real, ... }
+//  yq = { x.imag * h.imag, x.real * h.imag, ... }
+//  y  = { yi[0] - yq[0], yi[1] + yq[1], ... }
+//
+//  _h      :   coefficients array [size: _n x 1]
+//  _n      :   dot product length
+//  _x      :   input array [size: _num + _n - 1 x 1]
+//  _num    :   number of outputs
+//  _y      :   output array [size: _num x 1]
+__attribute__((target("avx2,fma")))
+void dotprod_cccf_run_block_avx2(float complex * _h,
+                                 unsigned int    _n,
+                                 float complex * _x,
+                                 unsigned int    _num,
+                                 float complex * _y)
+{
+    float * h = (float*) _h;
+    __m256 hi, hq, v0, v1, yi0, yi1, yq0, yq1;
+    unsigned int i, k;
+
+    // groups of 8 outputs
+    for (k=0; k+8 <= _num; k+=8) {
+        float * x = (float*) &_x[k];
+        float * y = (float*) &_y[k];
+        yi0 = _mm256_setzero_ps();
+        yi1 = _mm256_setzero_ps();
+        yq0 = _mm256_setzero_ps();
+        yq1 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++) {
+            hi  = _mm256_broadcast_ss(&h[2*i  ]);
+            hq  = _mm256_broadcast_ss(&h[2*i+1]);
+            v0  = _mm256_loadu_ps(&x[2*i  ]);
+            v1  = _mm256_loadu_ps(&x[2*i+8]);
+            yi0 = _mm256_fmadd_ps(hi, v0, yi0);
+            yi1 = _mm256_fmadd_ps(hi, v1, yi1);
+            yq0 = _mm256_fmadd_ps(hq, _mm256_permute_ps(v0, 0xb1), yq0);
+            yq1 = _mm256_fmadd_ps(hq, _mm256_permute_ps(v1, 0xb1), yq1);
+        }
+        _mm256_storeu_ps(&y[0], _mm256_addsub_ps(yi0, yq0));
+        _mm256_storeu_ps(&y[8], _mm256_addsub_ps(yi1, yq1));
+    }
+
+    // remaining outputs (in groups of 4, last group masked)
+    for ( ; k<_num; k+=4) {
+        float * x = (float*) &_x[k];
+        unsigned int r = _num - k < 4 ? _num - k : 4;
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(2*r),
+                                          _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+        yi0 = _mm256_setzero_ps();
+        yq0 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++) {
+            v0  = _mm256_maskload_ps(&x[2*i], mask);
+            yi0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&h[2*i  ]), v0, yi0);
+            yq0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&h[2*i+1]), _mm256_permute_ps(v0, 0xb1), yq0);
+        }
+        _mm256_maskstore_ps((float*) &_y[k], mask, _mm256_addsub_ps(yi0, yq0));
+    }
+}
+
+// AVX-512F block dot product (see dotprod_cccf_run_block_avx2)
+__attribute__((target("avx512f")))
+void dotprod_cccf_run_block_avx512f(float complex * _h,
+                                    unsigned int    _n,
+                                    float complex * _x,
+                                    unsigned int    _num,
+                                    float complex * _y)
+{
+    float * h = (float*) _h;
+    __m512 one = _mm512_set1_ps(1.0f);
+    __m512 hi, hq, v0, v1, yi0, yi1, yq0, yq1;
+    unsigned int i, k;
+
+    // groups of 16 outputs
+    for (k=0; k+16 <= _num; k+=16) {
+        float * x = (float*) &_x[k];
+        float * y = (float*) &_y[k];
+        yi0 = _mm512_setzero_ps();
+        yi1 = _mm512_setzero_ps();
+        yq0 = _mm512_setzero_ps();
+        yq1 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++) {
+            hi  = _mm512_set1_ps(h[2*i  ]);
+            hq  = _mm512_set1_ps(h[2*i+1]);
+            v0  = _mm512_loadu_ps(&x[2*i   ]);
+            v1  = _mm512_loadu_ps(&x[2*i+16]);
+            yi0 = _mm512_fmadd_ps(hi, v0, yi0);
+            yi1 = _mm512_fmadd_ps(hi, v1, yi1);
+            yq0 = _mm512_fmadd_ps(hq, _mm512_permute_ps(v0, 0xb1), yq0);
+            yq1 = _mm512_fmadd_ps(hq, _mm512_permute_ps(v1, 0xb1), yq1);
+        }
+        // y = yi*1 -/+ yq (subtract in even lanes, add in odd lanes)
+        _mm512_storeu_ps(&y[ 0], _mm512_fmaddsub_ps(yi0, one, yq0));
+        _mm512_storeu_ps(&y[16], _mm512_fmaddsub_ps(yi1, one, yq1));
+    }
+
+    // remaining outputs (in groups of 8, last group masked)
+    for ( ; k<_num; k+=8) {
+        float * x = (float*) &_x[k];
+        unsigned int r = _num - k < 8 ? _num - k : 8;
+        __mmask16 mask = (__mmask16)((1u << (2*r)) - 1);
+        yi0 = _mm512_setzero_ps();
+        yq0 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++) {
+            v0  = _mm512_maskz_loadu_ps(mask, &x[2*i]);
+            yi0 = _mm512_fmadd_ps(_mm512_set1_ps(h[2*i  ]), v0, yi0);
+            yq0 = _mm512_fmadd_ps(_mm512_set1_ps(h[2*i+1]), _mm512_permute_ps(v0, 0xb1), yq0);
+        }
+        _mm512_mask_storeu_ps((float*) &_y[k], mask, _mm512_fmaddsub_ps(yi0, one, yq0));
+    }
+}
@@ -109,29 +109,24 @@ struct dotprod_cccf_s {
     unsigned int n;     // length
     float * hi;         // in-phase
     float * hq;         // quadrature
+    liquid_simd_level simd; // kernel selected at run time
 };
 
 dotprod_cccf dotprod_cccf_create(float complex * _h,
                                  unsigned int    _n)
 {
-    dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
+    dotprod_cccf q = (dotprod_cccf)liquid_malloc(sizeof(struct dotprod_cccf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->hi = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
-    q->hq = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
+    // select kernel based on host cpu capabilities
+    q->simd = liquid_simd_get_level();
 
-    // set coefficients, repeated
-    //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
-    //  hq = { cimagf(_h[0]), cimagf(_h[0]), ... cimagf(_h[n-1]), cimagf(_h[n-1])}
-    unsigned int i;
-    for (i=0; i<q->n; i++) {
-        q->hi[2*i+0] = crealf(_h[i]);
-        q->hi[2*i+1] = crealf(_h[i]);
+    // allocate memory for coefficients, aligned for widest (AVX-512) loads
+    q->hi = (float*) liquid_malloc_aligned(2*q->n*sizeof(float));
+    q->hq = (float*) liquid_malloc_aligned(2*q->n*sizeof(float));
 
-        q->hq[2*i+0] = cimagf(_h[i]);
-        q->hq[2*i+1] = cimagf(_h[i]);
-    }
+    // set coefficients
+    dotprod_cccf_update_coefficients(q, _h);
 
     // return object
     return q;
@@ -142,27 +137,71 @@ dotprod_cccf dotprod_cccf_recreate(dotprod_cccf    _q,
                                    float complex * _h,
                                    unsigned int    _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        _q->simd = liquid_simd_get_level();
+        dotprod_cccf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_cccf_destroy(_q);
     return dotprod_cccf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation)
+void dotprod_cccf_update_coefficients(dotprod_cccf    _q,
+                                      float complex * _h)
+{
+    // set coefficients, repeated
+    //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
+    //  hq = { cimagf(_h[0]), cimagf(_h[0]), ... cimagf(_h[n-1]), cimagf(_h[n-1])}
+    unsigned int i;
+    for (i=0; i<_q->n; i++) {
+        _q->hi[2*i+0] = crealf(_h[i]);
+        _q->hi[2*i+1] = crealf(_h[i]);
+
+        _q->hq[2*i+0] = cimagf(_h[i]);
+        _q->hq[2*i+1] = cimagf(_h[i]);
+    }
+}
+
 
 void dotprod_cccf_destroy(dotprod_cccf _q)
 {
-    _mm_free(_q->hi);
-    _mm_free(_q->hq);
-    free(_q);
+    liquid_free_aligned(_q->hi);
+    liquid_free_aligned(_q->hq);
+    liquid_free(_q);
 }
 
 void dotprod_cccf_print(dotprod_cccf _q)
 {
-    printf("dotprod_cccf [mmx, %u coefficients]\n", _q->n);
+    printf("dotprod_cccf [%s, %u coefficients]\n", liquid_simd_level_str(_q->simd), _q->n);
     unsigned int i;
     for (i=0; i<_q->n; i++)
         printf("  %3u : %12.9f +j%12.9f\n", i, _q->hi[i], _q->hq[i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_cccf_get_memory_usage(dotprod_cccf _q)
+{
+    // in-phase and quadrature arrays, each holding 2*n values
+    return sizeof(struct dotprod_cccf_s) + 4*_q->n*sizeof(float);
+}
+
+// portable C (selected with liquid_simd_set_level())
+static void dotprod_cccf_execute_portable(dotprod_cccf    _q,
+                                          float complex * _x,
+                                          float complex * _y)
+{
+    // coefficients are stored split and repeated
+    float complex r = 0;
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        r += (_q->hi[2*i] + _q->hq[2*i]*_Complex_I) * _x[i];
+    *_y = r;
+}
+
 // execute structured dot product
 //  _q      :   dotprod object
 //  _x      :   input array
@@ -171,6 +210,16 @@ void dotprod_cccf_execute(dotprod_cccf    _q,
                           float complex * _x,
                           float complex * _y)
 {
+    // run-time dispatch
+    switch (_q->simd) {
+#if HAVE_DOTPROD_AVX
+    case LIQUID_SIMD_AVX512F: dotprod_cccf_execute_avx512f(_q->hi, _q->hq, _x, _q->n, _y); return;
+    case LIQUID_SIMD_AVX2:    dotprod_cccf_execute_avx2   (_q->hi, _q->hq, _x, _q->n, _y); return;
+#endif
+    case LIQUID_SIMD_PORTABLE: dotprod_cccf_execute_portable(_q, _x, _y); return;
+    default:;
+    }
+
     // switch based on size
     if (_q->n < 32) {
         dotprod_cccf_execute_mmx(_q, _x, _y);
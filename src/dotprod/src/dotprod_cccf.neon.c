@@ -44,6 +44,12 @@ void dotprod_cccf_execute_neon4(dotprod_cccf    _q,
                                 float complex * _x,
                                 float complex * _y);
 
+#if defined(__aarch64__)
+void dotprod_cccf_execute_neon8(dotprod_cccf    _q,
+                                float complex * _x,
+                                float complex * _y);
+#endif
+
 // basic dot product (ordinal calculation)
 void dotprod_cccf_run(float complex * _h,
                       float complex * _x,
@@ -93,29 +99,28 @@ struct dotprod_cccf_s {
     unsigned int n;     // length
     float * hi;         // in-phase
     float * hq;         // quadrature
+#if defined(__aarch64__)
+    float * hi1;        // in-phase, one value per coefficient
+    float * hq1;        // quadrature, one value per coefficient
+#endif
 };
 
 dotprod_cccf dotprod_cccf_create(float complex * _h,
                                  unsigned int    _n)
 {
-    dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
+    dotprod_cccf q = (dotprod_cccf)liquid_malloc(sizeof(struct dotprod_cccf_s));
     q->n = _n;
 
     // allocate memory for coefficients
-    q->hi = (float*) malloc( 2*q->n*sizeof(float) );
-    q->hq = (float*) malloc( 2*q->n*sizeof(float) );
+    q->hi = (float*) liquid_malloc_aligned( 2*q->n*sizeof(float) );
+    q->hq = (float*) liquid_malloc_aligned( 2*q->n*sizeof(float) );
+#if defined(__aarch64__)
+    q->hi1 = (float*) liquid_malloc_aligned( q->n*sizeof(float) );
+    q->hq1 = (float*) liquid_malloc_aligned( q->n*sizeof(float) );
+#endif
 
-    // set coefficients, repeated
-    //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
-    //  hq = { cimagf(_h[0]), cimagf(_h[0]), ... cimagf(_h[n-1]), cimagf(_h[n-1])}
-    unsigned int i;
-    for (i=0; i<q->n; i++) {
-        q->hi[2*i+0] = crealf(_h[i]);
-        q->hi[2*i+1] = crealf(_h[i]);
-
-        q->hq[2*i+0] = cimagf(_h[i]);
-        q->hq[2*i+1] = cimagf(_h[i]);
-    }
+    // set coefficients
+    dotprod_cccf_update_coefficients(q, _h);
 
     // return object
     return q;
@@ -126,20 +131,55 @@ dotprod_cccf dotprod_cccf_recreate(dotprod_cccf    _q,
                                    float complex * _h,
                                    unsigned int    _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        dotprod_cccf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_cccf_destroy(_q);
     return dotprod_cccf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation)
+void dotprod_cccf_update_coefficients(dotprod_cccf    _q,
+                                      float complex * _h)
+{
+    // set coefficients, repeated
+    //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
+    //  hq = { cimagf(_h[0]), cimagf(_h[0]), ... cimagf(_h[n-1]), cimagf(_h[n-1])}
+    unsigned int i;
+    for (i=0; i<_q->n; i++) {
+        _q->hi[2*i+0] = crealf(_h[i]);
+        _q->hi[2*i+1] = crealf(_h[i]);
+
+        _q->hq[2*i+0] = cimagf(_h[i]);
+        _q->hq[2*i+1] = cimagf(_h[i]);
+    }
+
+#if defined(__aarch64__)
+    // set coefficients, split (for de-interleaved input loads)
+    for (i=0; i<_q->n; i++) {
+        _q->hi1[i] = crealf(_h[i]);
+        _q->hq1[i] = cimagf(_h[i]);
+    }
+#endif
+}
+
 
 void dotprod_cccf_destroy(dotprod_cccf _q)
 {
     // free coefficients arrays
-    free(_q->hi);
-    free(_q->hq);
+    liquid_free_aligned(_q->hi);
+    liquid_free_aligned(_q->hq);
+#if defined(__aarch64__)
+    liquid_free_aligned(_q->hi1);
+    liquid_free_aligned(_q->hq1);
+#endif
 
     // free main memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void dotprod_cccf_print(dotprod_cccf _q)
@@ -150,6 +190,17 @@ void dotprod_cccf_print(dotprod_cccf _q)
         printf("  %3u : %12.9f +j%12.9f\n", i, _q->hi[i], _q->hq[i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_cccf_get_memory_usage(dotprod_cccf _q)
+{
+    unsigned long int n = sizeof(struct dotprod_cccf_s) + 4*_q->n*sizeof(float);
+#if defined(__aarch64__)
+    // single-value in-phase and quadrature arrays
+    n += 2*_q->n*sizeof(float);
+#endif
+    return n;
+}
+
 // execute structured dot product
 //  _q      :   dotprod object
 //  _x      :   input array
@@ -158,6 +209,15 @@ void dotprod_cccf_execute(dotprod_cccf    _q,
                           float complex * _x,
                           float complex * _y)
 {
+#if defined(__aarch64__)
+    // fused multiply-add kernel; the ARMv7 paths below are retained
+    // for short filters where the unrolled loop does not engage
+    if (_q->n >= 16) {
+        dotprod_cccf_execute_neon8(_q, _x, _y);
+        return;
+    }
+#endif
+
     // switch based on size
     if (_q->n < 32) {
         dotprod_cccf_execute_neon(_q, _x, _y);
@@ -340,3 +400,85 @@ void dotprod_cccf_execute_neon4(dotprod_cccf    _q,
     *_y = total;
 }
 
+#if defined(__aarch64__)
+// use AArch64 Neon extensions (fused multiply-add)
+//
+// De-interleaving loads split 4 complex inputs into vectors of real
+// and imaginary parts so that each complex product is accumulated
+// with fused multiply-add instructions against the split
+// coefficients:
+//
+//  yi += x.real * h.real - x.imag * h.imag
+//  yq += x.real * h.imag + x.imag * h.real
+//
+// Four groups are processed per iteration with separate (8 total)
+// accumulators to hide the fused multiply-add latency.
+void dotprod_cccf_execute_neon8(dotprod_cccf    _q,
+                                float complex * _x,
+                                float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    float32x4x2_t v0,  v1,  v2,  v3;    // de-interleaved input vectors
+    float32x4_t   hi0, hi1, hi2, hi3;   // coefficients vectors (real)
+    float32x4_t   hq0, hq1, hq2, hq3;   // coefficients vectors (imag)
+
+    // load zeros into sum registers
+    float32x4_t yi0 = vdupq_n_f32(0.0f), yq0 = vdupq_n_f32(0.0f);
+    float32x4_t yi1 = vdupq_n_f32(0.0f), yq1 = vdupq_n_f32(0.0f);
+    float32x4_t yi2 = vdupq_n_f32(0.0f), yq2 = vdupq_n_f32(0.0f);
+    float32x4_t yi3 = vdupq_n_f32(0.0f), yq3 = vdupq_n_f32(0.0f);
+
+    // r = 16*floor(n/16)
+    unsigned int r = (_q->n >> 4) << 4;
+
+    unsigned int i;
+    for (i=0; i<r; i+=16) {
+        // load inputs into registers, splitting real and imaginary
+        v0 = vld2q_f32(&x[2*i   ]);
+        v1 = vld2q_f32(&x[2*i+ 8]);
+        v2 = vld2q_f32(&x[2*i+16]);
+        v3 = vld2q_f32(&x[2*i+24]);
+
+        // load coefficients into registers
+        hi0 = vld1q_f32(&_q->hi1[i   ]);    hq0 = vld1q_f32(&_q->hq1[i   ]);
+        hi1 = vld1q_f32(&_q->hi1[i+ 4]);    hq1 = vld1q_f32(&_q->hq1[i+ 4]);
+        hi2 = vld1q_f32(&_q->hi1[i+ 8]);    hq2 = vld1q_f32(&_q->hq1[i+ 8]);
+        hi3 = vld1q_f32(&_q->hi1[i+12]);    hq3 = vld1q_f32(&_q->hq1[i+12]);
+
+        // accumulate real part
+        yi0 = vfmaq_f32(yi0, v0.val[0], hi0);   yi0 = vfmsq_f32(yi0, v0.val[1], hq0);
+        yi1 = vfmaq_f32(yi1, v1.val[0], hi1);   yi1 = vfmsq_f32(yi1, v1.val[1], hq1);
+        yi2 = vfmaq_f32(yi2, v2.val[0], hi2);   yi2 = vfmsq_f32(yi2, v2.val[1], hq2);
+        yi3 = vfmaq_f32(yi3, v3.val[0], hi3);   yi3 = vfmsq_f32(yi3, v3.val[1], hq3);
+
+        // accumulate imaginary part
+        yq0 = vfmaq_f32(yq0, v0.val[0], hq0);   yq0 = vfmaq_f32(yq0, v0.val[1], hi0);
+        yq1 = vfmaq_f32(yq1, v1.val[0], hq1);   yq1 = vfmaq_f32(yq1, v1.val[1], hi1);
+        yq2 = vfmaq_f32(yq2, v2.val[0], hq2);   yq2 = vfmaq_f32(yq2, v2.val[1], hi2);
+        yq3 = vfmaq_f32(yq3, v3.val[0], hq3);   yq3 = vfmaq_f32(yq3, v3.val[1], hi3);
+    }
+
+    // remaining groups of 4
+    for ( ; i+4 <= _q->n; i+=4) {
+        v0  = vld2q_f32(&x[2*i]);
+        hi0 = vld1q_f32(&_q->hi1[i]);
+        hq0 = vld1q_f32(&_q->hq1[i]);
+        yi0 = vfmaq_f32(yi0, v0.val[0], hi0);   yi0 = vfmsq_f32(yi0, v0.val[1], hq0);
+        yq0 = vfmaq_f32(yq0, v0.val[0], hq0);   yq0 = vfmaq_f32(yq0, v0.val[1], hi0);
+    }
+
+    // fold down
+    yi0 = vaddq_f32(vaddq_f32(yi0, yi1), vaddq_f32(yi2, yi3));
+    yq0 = vaddq_f32(vaddq_f32(yq0, yq1), vaddq_f32(yq2, yq3));
+    float complex total = vaddvq_f32(yi0) + vaddvq_f32(yq0)*_Complex_I;
+
+    // cleanup
+    for ( ; i<_q->n; i++)
+        total += _x[i] * ( _q->hi1[i] + _q->hq1[i]*_Complex_I );
+
+    // set return value
+    *_y = total;
+}
+#endif
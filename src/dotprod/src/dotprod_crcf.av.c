@@ -101,7 +101,7 @@ struct dotprod_crcf_s {
 dotprod_crcf dotprod_crcf_create(float *      _h,
                                  unsigned int _n)
 {
-    dotprod_crcf dp = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
+    dotprod_crcf dp = (dotprod_crcf)liquid_malloc(sizeof(struct dotprod_crcf_s));
     dp->n = _n;
 
     // create 4 copies of the input coefficients (one for each
@@ -113,14 +113,12 @@ dotprod_crcf dotprod_crcf_create(float *      _h,
     // NOTE: double allocation size; coefficients are real, but
     //       need to be multiplied by real and complex components
     //       of input.
-    unsigned int i,j;
-    for (i=0; i<4; i++) {
-        dp->h[i] = calloc(1+(2*dp->n+i-1)/4,2*sizeof(vector float));
-        for (j=0; j<dp->n; j++) {
-            dp->h[i][2*j+0+i] = _h[j];
-            dp->h[i][2*j+1+i] = _h[j];
-        }
-    }
+    unsigned int i;
+    for (i=0; i<4; i++)
+        dp->h[i] = liquid_calloc(1+(2*dp->n+i-1)/4,2*sizeof(vector float));
+
+    // set coefficients
+    dotprod_crcf_update_coefficients(dp, _h);
 
     return dp;
 }
@@ -130,21 +128,41 @@ dotprod_crcf dotprod_crcf_recreate(dotprod_crcf _q,
                                    float *      _h,
                                    unsigned int _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        dotprod_crcf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_crcf_destroy(_q);
     return dotprod_crcf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation); the padding
+// introduced by the alignment offsets remains zero
+void dotprod_crcf_update_coefficients(dotprod_crcf _q,
+                                      float *      _h)
+{
+    unsigned int i,j;
+    for (i=0; i<4; i++) {
+        for (j=0; j<_q->n; j++) {
+            _q->h[i][2*j+0+i] = _h[j];
+            _q->h[i][2*j+1+i] = _h[j];
+        }
+    }
+}
+
 // destroy the structured dotprod object
 void dotprod_crcf_destroy(dotprod_crcf _q)
 {
     // clean up coefficients arrays
     unsigned int i;
     for (i=0; i<4; i++)
-        free(_q->h[i]);
+        liquid_free(_q->h[i]);
 
     // free allocated object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print the dotprod object
@@ -156,6 +174,17 @@ void dotprod_crcf_print(dotprod_crcf _q)
         printf("  %3u : %12.9f\n", i, _q->h[0][2*i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_crcf_get_memory_usage(dotprod_crcf _q)
+{
+    // one padded copy of the coefficients for each input alignment
+    unsigned long int n = sizeof(struct dotprod_crcf_s);
+    unsigned int i;
+    for (i=0; i<4; i++)
+        n += (1+(2*_q->n+i-1)/4)*2*sizeof(vector float);
+    return n;
+}
+
 // exectue vectorized structured inner dot product
 void dotprod_crcf_execute(dotprod_crcf    _q,
                           float complex * _x,
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Complex floating-point dot product, real coefficients
+// (AVX2/FMA, AVX-512F)
+//
+// Coefficients are stored repeated to match the interleaved layout
+// of the complex input,
+//  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
+// so the complex dot product reduces to a real dot product of twice
+// the length whose even/odd lanes accumulate the real/imaginary
+// components, respectively.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// AVX2/FMA dot product
+//  _h      :   repeated coefficients array, 32-byte aligned [size: 2*_n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dot product length
+//  _y      :   output sample pointer
+__attribute__((target("avx2,fma")))
+void dotprod_crcf_execute_avx2(float *         _h,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    // r = 32*floor(n/32)
+    unsigned int r = (n >> 5) << 5;
+
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i   ]), _mm256_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 8]), _mm256_load_ps(&_h[i+ 8]), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+16]), _mm256_load_ps(&_h[i+16]), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+24]), _mm256_load_ps(&_h[i+24]), sum3);
+    }
+
+    // t = 8*floor(n/8)
+    unsigned int t = (n >> 3) << 3;
+    for ( ; i<t; i+=8)
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i]), _mm256_load_ps(&_h[i]), sum0);
+
+    // fold down to { re, im, re, im }
+    sum0 = _mm256_add_ps( _mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3) );
+    __m128 s = _mm_add_ps( _mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1) );
+
+    // aligned output array
+    float w[4] __attribute__((aligned(16)));
+    _mm_store_ps(w, s);
+    w[0] += w[2];
+    w[1] += w[3];
+
+    // cleanup (note: n _must_ be even)
+    for ( ; i<n; i+=2) {
+        w[0] += x[i  ] * _h[i  ];
+        w[1] += x[i+1] * _h[i+1];
+    }
+
+    // set return value
+    *_y = w[0] + _Complex_I*w[1];
+}
+
+// AVX-512F dot product
+//  _h      :   repeated coefficients array, 64-byte aligned [size: 2*_n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dot product length
+//  _y      :   output sample pointer
+__attribute__((target("avx512f")))
+void dotprod_crcf_execute_avx512f(float *         _h,
+                                  float complex * _x,
+                                  unsigned int    _n,
+                                  float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    __m512 sum2 = _mm512_setzero_ps();
+    __m512 sum3 = _mm512_setzero_ps();
+
+    // r = 64*floor(n/64)
+    unsigned int r = (n >> 6) << 6;
+
+    unsigned int i;
+    for (i=0; i<r; i+=64) {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i   ]), _mm512_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+16]), _mm512_load_ps(&_h[i+16]), sum1);
+        sum2 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+32]), _mm512_load_ps(&_h[i+32]), sum2);
+        sum3 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+48]), _mm512_load_ps(&_h[i+48]), sum3);
+    }
+
+    // t = 16*floor(n/16)
+    unsigned int t = (n >> 4) << 4;
+    for ( ; i<t; i+=16)
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i]), _mm512_load_ps(&_h[i]), sum0);
+
+    // remaining samples using masked loads
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+        sum1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &x[i]),
+                               _mm512_maskz_load_ps (m, &_h[i]), sum1);
+    }
+
+    // fold down
+    sum0 = _mm512_add_ps( _mm512_add_ps(sum0, sum1), _mm512_add_ps(sum2, sum3) );
+
+    // set return value: even lanes are real, odd lanes are imaginary
+    *_y = _mm512_mask_reduce_add_ps(0x5555, sum0) +
+          _mm512_mask_reduce_add_ps(0xaaaa, sum0) * _Complex_I;
+}
+
+
+// AVX2/FMA block dot product: each pair of vector lanes accumulates a
+// different (complex) output; every broadcast coefficient is applied
+// to four vectors of consecutive outputs before moving to the next tap
+//  _h      :   coefficients array [size: _n x 1]
+//  _n      :   dot product length
+//  _x      :   input array [size: _num + _n - 1 x 1]
+//  _num    :   number of outputs
+//  _y      :   output array [size: _num x 1]
+__attribute__((target("avx2,fma")))
+void dotprod_crcf_run_block_avx2(float *         _h,
+                                 unsigned int    _n,
+                                 float complex * _x,
+                                 unsigned int    _num,
+                                 float complex * _y)
+{
+    __m256 h, y0, y1, y2, y3;
+    unsigned int i, k;
+
+    // groups of 16 outputs
+    for (k=0; k+16 <= _num; k+=16) {
+        float * x = (float*) &_x[k];
+        float * y = (float*) &_y[k];
+        y0 = _mm256_setzero_ps();
+        y1 = _mm256_setzero_ps();
+        y2 = _mm256_setzero_ps();
+        y3 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++) {
+            h  = _mm256_broadcast_ss(&_h[i]);
+            y0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[2*i   ]), y0);
+            y1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[2*i+ 8]), y1);
+            y2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[2*i+16]), y2);
+            y3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[2*i+24]), y3);
+        }
+        _mm256_storeu_ps(&y[ 0], y0);
+        _mm256_storeu_ps(&y[ 8], y1);
+        _mm256_storeu_ps(&y[16], y2);
+        _mm256_storeu_ps(&y[24], y3);
+    }
+
+    // groups of 4 outputs
+    for ( ; k+4 <= _num; k+=4) {
+        float * x = (float*) &_x[k];
+        y0 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_h[i]), _mm256_loadu_ps(&x[2*i]), y0);
+        _mm256_storeu_ps((float*) &_y[k], y0);
+    }
+
+    // remaining outputs (masked)
+    if (k < _num) {
+        float * x = (float*) &_x[k];
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(2*(_num-k)),
+                                          _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+        y0 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_h[i]), _mm256_maskload_ps(&x[2*i], mask), y0);
+        _mm256_maskstore_ps((float*) &_y[k], mask, y0);
+    }
+}
+
+// AVX-512F block dot product (see dotprod_crcf_run_block_avx2)
+__attribute__((target("avx512f")))
+void dotprod_crcf_run_block_avx512f(float *         _h,
+                                    unsigned int    _n,
+                                    float complex * _x,
+                                    unsigned int    _num,
+                                    float complex * _y)
+{
+    __m512 h, y0, y1, y2, y3;
+    unsigned int i, k;
+
+    // groups of 32 outputs
+    for (k=0; k+32 <= _num; k+=32) {
+        float * x = (float*) &_x[k];
+        float * y = (float*) &_y[k];
+        y0 = _mm512_setzero_ps();
+        y1 = _mm512_setzero_ps();
+        y2 = _mm512_setzero_ps();
+        y3 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++) {
+            h  = _mm512_set1_ps(_h[i]);
+            y0 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[2*i   ]), y0);
+            y1 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[2*i+16]), y1);
+            y2 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[2*i+32]), y2);
+            y3 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[2*i+48]), y3);
+        }
+        _mm512_storeu_ps(&y[ 0], y0);
+        _mm512_storeu_ps(&y[16], y1);
+        _mm512_storeu_ps(&y[32], y2);
+        _mm512_storeu_ps(&y[48], y3);
+    }
+
+    // groups of 8 outputs
+    for ( ; k+8 <= _num; k+=8) {
+        float * x = (float*) &_x[k];
+        y0 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm512_fmadd_ps(_mm512_set1_ps(_h[i]), _mm512_loadu_ps(&x[2*i]), y0);
+        _mm512_storeu_ps((float*) &_y[k], y0);
+    }
+
+    // remaining outputs (masked)
+    if (k < _num) {
+        float * x = (float*) &_x[k];
+        __mmask16 mask = (__mmask16)((1u << (2*(_num-k))) - 1);
+        y0 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm512_fmadd_ps(_mm512_set1_ps(_h[i]), _mm512_maskz_loadu_ps(mask, &x[2*i]), y0);
+        _mm512_mask_storeu_ps((float*) &_y[k], mask, y0);
+    }
+}
+
+// AVX2/FMA batched dot product on a single shared input: coefficient
+// sets are interleaved in groups of four (see dotprod_batch.c), so the
+// four complex outputs of a group occupy the lane pairs of one vector;
+// every input sample is broadcast once per group and the four
+// coefficients of a tap are repeated to match the (real,imag) lanes
+//  _h      :   interleaved coefficients [size: 4*ceil(_num/4)*_n x 1]
+//  _n      :   dot product length
+//  _num    :   number of dot products
+//  _x      :   shared input array [size: _n x 1]
+//  _y      :   output array [size: _num x 1]
+__attribute__((target("avx2,fma")))
+void dotprod_crcf_execute_batch_shared_avx2(float *         _h,
+                                            unsigned int    _n,
+                                            unsigned int    _num,
+                                            float complex * _x,
+                                            float complex * _y)
+{
+    const __m256i dup = _mm256_setr_epi32(0,0,1,1,2,2,3,3);
+    const double * x = (const double*) _x;
+
+    unsigned int num_groups = (_num + 3) / 4;
+    unsigned int g, i;
+    for (g=0; g<num_groups; g++) {
+        float * h = &_h[4*g*_n];
+        __m256 y0 = _mm256_setzero_ps();
+        __m256 y1 = _mm256_setzero_ps();
+        __m256 y2 = _mm256_setzero_ps();
+        __m256 y3 = _mm256_setzero_ps();
+        for (i=0; i+4<=_n; i+=4) {
+            y0 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&h[4*i   ])), dup),
+                                 _mm256_castpd_ps(_mm256_broadcast_sd(&x[i  ])), y0);
+            y1 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&h[4*i+ 4])), dup),
+                                 _mm256_castpd_ps(_mm256_broadcast_sd(&x[i+1])), y1);
+            y2 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&h[4*i+ 8])), dup),
+                                 _mm256_castpd_ps(_mm256_broadcast_sd(&x[i+2])), y2);
+            y3 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&h[4*i+12])), dup),
+                                 _mm256_castpd_ps(_mm256_broadcast_sd(&x[i+3])), y3);
+        }
+        y0 = _mm256_add_ps(_mm256_add_ps(y0, y1), _mm256_add_ps(y2, y3));
+        for ( ; i<_n; i++)
+            y0 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&h[4*i])), dup),
+                                 _mm256_castpd_ps(_mm256_broadcast_sd(&x[i])), y0);
+
+        if (4*g + 4 <= _num) {
+            _mm256_storeu_ps((float*) &_y[4*g], y0);
+        } else {
+            float complex v[4];
+            _mm256_storeu_ps((float*) v, y0);
+            for (i=0; 4*g+i<_num; i++)
+                _y[4*g+i] = v[i];
+        }
+    }
+}
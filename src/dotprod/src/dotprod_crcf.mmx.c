@@ -90,24 +90,23 @@ void dotprod_crcf_run4(float *         _h,
 struct dotprod_crcf_s {
     unsigned int n;     // length
     float * h;          // coefficients array
+    liquid_simd_level simd; // kernel selected at run time
 };
 
 dotprod_crcf dotprod_crcf_create(float *      _h,
                                  unsigned int _n)
 {
-    dotprod_crcf q = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
+    dotprod_crcf q = (dotprod_crcf)liquid_malloc(sizeof(struct dotprod_crcf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
+    // select kernel based on host cpu capabilities
+    q->simd = liquid_simd_get_level();
 
-    // set coefficients, repeated
-    //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
-    unsigned int i;
-    for (i=0; i<q->n; i++) {
-        q->h[2*i+0] = _h[i];
-        q->h[2*i+1] = _h[i];
-    }
+    // allocate memory for coefficients, aligned for widest (AVX-512) loads
+    q->h = (float*) liquid_malloc_aligned(2*q->n*sizeof(float));
+
+    // set coefficients
+    dotprod_crcf_update_coefficients(q, _h);
 
     // return object
     return q;
@@ -118,33 +117,83 @@ dotprod_crcf dotprod_crcf_recreate(dotprod_crcf _q,
                                    float *      _h,
                                    unsigned int _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        _q->simd = liquid_simd_get_level();
+        dotprod_crcf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_crcf_destroy(_q);
     return dotprod_crcf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation)
+void dotprod_crcf_update_coefficients(dotprod_crcf _q,
+                                      float *      _h)
+{
+    // set coefficients, repeated
+    //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
+    unsigned int i;
+    for (i=0; i<_q->n; i++) {
+        _q->h[2*i+0] = _h[i];
+        _q->h[2*i+1] = _h[i];
+    }
+}
+
 
 void dotprod_crcf_destroy(dotprod_crcf _q)
 {
-    _mm_free(_q->h);
-    free(_q);
+    liquid_free_aligned(_q->h);
+    liquid_free(_q);
 }
 
 void dotprod_crcf_print(dotprod_crcf _q)
 {
     // print coefficients to screen, skipping odd entries (due
     // to repeated coefficients)
-    printf("dotprod_crcf [mmx, %u coefficients]\n", _q->n);
+    printf("dotprod_crcf [%s, %u coefficients]\n", liquid_simd_level_str(_q->simd), _q->n);
     unsigned int i;
     for (i=0; i<_q->n; i++)
         printf("  %3u : %12.9f\n", i, _q->h[2*i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_crcf_get_memory_usage(dotprod_crcf _q)
+{
+    // coefficients are duplicated to match interleaved input
+    return sizeof(struct dotprod_crcf_s) + 2*_q->n*sizeof(float);
+}
+
+// portable C (selected with liquid_simd_set_level())
+static void dotprod_crcf_execute_portable(dotprod_crcf    _q,
+                                          float complex * _x,
+                                          float complex * _y)
+{
+    // coefficients are stored repeated: h[2*i] = h[2*i+1]
+    float complex r = 0;
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        r += _q->h[2*i] * _x[i];
+    *_y = r;
+}
+
 // 
 void dotprod_crcf_execute(dotprod_crcf    _q,
                           float complex * _x,
                           float complex * _y)
 {
+    // run-time dispatch
+    switch (_q->simd) {
+#if HAVE_DOTPROD_AVX
+    case LIQUID_SIMD_AVX512F: dotprod_crcf_execute_avx512f(_q->h, _x, _q->n, _y); return;
+    case LIQUID_SIMD_AVX2:    dotprod_crcf_execute_avx2   (_q->h, _x, _q->n, _y); return;
+#endif
+    case LIQUID_SIMD_PORTABLE: dotprod_crcf_execute_portable(_q, _x, _y); return;
+    default:;
+    }
+
     // switch based on size
     if (_q->n < 32) {
         dotprod_crcf_execute_mmx(_q, _x, _y);
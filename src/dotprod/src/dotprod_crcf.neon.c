@@ -102,19 +102,14 @@ struct dotprod_crcf_s {
 dotprod_crcf dotprod_crcf_create(float *      _h,
                                  unsigned int _n)
 {
-    dotprod_crcf q = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
+    dotprod_crcf q = (dotprod_crcf)liquid_malloc(sizeof(struct dotprod_crcf_s));
     q->n = _n;
 
     // allocate memory for coefficients (double size)
-    q->h = (float*) malloc( 2*q->n*sizeof(float) );
+    q->h = (float*) liquid_malloc_aligned( 2*q->n*sizeof(float) );
 
-    // set coefficients, repeated
-    //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
-    unsigned int i;
-    for (i=0; i<q->n; i++) {
-        q->h[2*i+0] = _h[i];
-        q->h[2*i+1] = _h[i];
-    }
+    // set coefficients
+    dotprod_crcf_update_coefficients(q, _h);
 
     // return object
     return q;
@@ -125,19 +120,38 @@ dotprod_crcf dotprod_crcf_recreate(dotprod_crcf _q,
                                    float *      _h,
                                    unsigned int _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        dotprod_crcf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_crcf_destroy(_q);
     return dotprod_crcf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation)
+void dotprod_crcf_update_coefficients(dotprod_crcf _q,
+                                      float *      _h)
+{
+    // set coefficients, repeated
+    //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
+    unsigned int i;
+    for (i=0; i<_q->n; i++) {
+        _q->h[2*i+0] = _h[i];
+        _q->h[2*i+1] = _h[i];
+    }
+}
+
 
 void dotprod_crcf_destroy(dotprod_crcf _q)
 {
     // free coefficients array
-    free(_q->h);
+    liquid_free_aligned(_q->h);
 
     // free main memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void dotprod_crcf_print(dotprod_crcf _q)
@@ -150,6 +164,13 @@ void dotprod_crcf_print(dotprod_crcf _q)
         printf("  %3u : %12.9f\n", i, _q->h[2*i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_crcf_get_memory_usage(dotprod_crcf _q)
+{
+    // coefficients are duplicated to match interleaved input
+    return sizeof(struct dotprod_crcf_s) + 2*_q->n*sizeof(float);
+}
+
 // 
 void dotprod_crcf_execute(dotprod_crcf    _q,
                           float complex * _x,
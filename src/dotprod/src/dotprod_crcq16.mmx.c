@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Fixed-point (Q15) dot product, complex input/output, real
+// coefficients (SSE2)
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+// internal methods
+void dotprod_crcq16_execute_sse2(dotprod_crcq16 _q,
+                                 cq16_t *       _x,
+                                 cq16_t *       _y);
+
+//
+// structured SSE2 dot product
+//
+
+struct dotprod_crcq16_s {
+    unsigned int n;     // length
+    q16_t * h;          // coefficients array [size: n x 1]
+
+    // coefficients re-ordered for pmaddwd: for each group of four
+    // taps {h0,h1,h2,h3} stores {h0,h1,h0,h1,h2,h3,h2,h3}
+    // [size: 2*floor(n/4)*4 x 1]
+    q16_t * hx;
+    liquid_simd_level simd; // kernel selected at run time
+};
+
+dotprod_crcq16 dotprod_crcq16_create(q16_t *      _h,
+                                     unsigned int _n)
+{
+    dotprod_crcq16 q = (dotprod_crcq16)liquid_malloc(sizeof(struct dotprod_crcq16_s));
+    q->n = _n;
+
+    // select kernel based on host cpu capabilities
+    q->simd = liquid_simd_get_level();
+
+    // allocate memory for coefficients (aligned)
+    q->h  = (q16_t*) liquid_malloc_aligned(q->n*sizeof(q16_t));
+    q->hx = (q16_t*) liquid_malloc_aligned((2*q->n+1)*sizeof(q16_t));
+
+    // set coefficients
+    dotprod_crcq16_update_coefficients(q, _h);
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_crcq16 dotprod_crcq16_recreate(dotprod_crcq16 _q,
+                                       q16_t *        _h,
+                                       unsigned int   _n)
+{
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        _q->simd = liquid_simd_get_level();
+        dotprod_crcq16_update_coefficients(_q, _h);
+        return _q;
+    }
+
+    // completely destroy and re-create dotprod object
+    dotprod_crcq16_destroy(_q);
+    return dotprod_crcq16_create(_h,_n);
+}
+
+// overwrite coefficients in place (no allocation)
+void dotprod_crcq16_update_coefficients(dotprod_crcq16 _q,
+                                        q16_t *        _h)
+{
+    memmove(_q->h, _h, _q->n*sizeof(q16_t));
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_q->n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=2) {
+        _q->hx[2*i+0] = _h[i];
+        _q->hx[2*i+1] = _h[i+1];
+        _q->hx[2*i+2] = _h[i];
+        _q->hx[2*i+3] = _h[i+1];
+    }
+}
+
+void dotprod_crcq16_destroy(dotprod_crcq16 _q)
+{
+    liquid_free_aligned(_q->h);
+    liquid_free_aligned(_q->hx);
+    liquid_free(_q);
+}
+
+void dotprod_crcq16_print(dotprod_crcq16 _q)
+{
+    printf("dotprod_crcq16 [%s, %u coefficients]\n",
+            liquid_simd_level_str(liquid_simd_get_kernel(LIQUID_SIMD_DOTPROD_Q16)), _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("%3u : %6d\n", i, _q->h[i]);
+}
+
+// 
+void dotprod_crcq16_execute(dotprod_crcq16 _q,
+                            cq16_t *       _x,
+                            cq16_t *       _y)
+{
+    // run-time dispatch (portable C selected with liquid_simd_set_level())
+    if (_q->simd == LIQUID_SIMD_PORTABLE) {
+        dotprod_crcq16_run(_q->h, _x, _q->n, _y);
+        return;
+    }
+
+    dotprod_crcq16_execute_sse2(_q, _x, _y);
+}
+
+// use SSE2 extensions: the input {r0,i0,r1,i1,...} is shuffled to
+// {r0,r1,i0,i1,...} so that pmaddwd with the re-ordered coefficients
+// yields {r0*h0+r1*h1, i0*h0+i1*h1, ...} in 32-bit accumulators
+void dotprod_crcq16_execute_sse2(dotprod_crcq16 _q,
+                                 cq16_t *       _x,
+                                 cq16_t *       _y)
+{
+    __m128i v0, v1; // input vectors
+    __m128i h0, h1; // coefficients vectors
+
+    // load zeros into sum registers
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+
+    // input as array of interleaved 16-bit values
+    q16_t * x = (q16_t*) _x;
+
+    // r = 8*floor(n/8), t = 4*floor(n/4)
+    unsigned int r = (_q->n >> 3) << 3;
+    unsigned int t = (_q->n >> 2) << 2;
+
+    unsigned int i;
+    for (i=0; i<r; i+=8) {
+        // load inputs into register (unaligned)
+        v0 = _mm_loadu_si128((__m128i*)&x[2*i]);
+        v1 = _mm_loadu_si128((__m128i*)&x[2*i+8]);
+
+        // pair up real and imaginary components of adjacent samples
+        v0 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v0, _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0));
+        v1 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v1, _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0));
+
+        // load coefficients into register (aligned)
+        h0 = _mm_load_si128((__m128i*)&_q->hx[2*i]);
+        h1 = _mm_load_si128((__m128i*)&_q->hx[2*i+8]);
+
+        // multiply and accumulate
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(v0, h0));
+        sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(v1, h1));
+    }
+
+    // remaining group of 4
+    if (i < t) {
+        v0 = _mm_loadu_si128((__m128i*)&x[2*i]);
+        v0 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v0, _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0));
+        h0 = _mm_load_si128((__m128i*)&_q->hx[2*i]);
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(v0, h0));
+        i += 4;
+    }
+
+    // fold down: {re, im, re, im} -> {re, im}
+    sum0 = _mm_add_epi32(sum0, sum1);
+    sum0 = _mm_add_epi32(sum0, _mm_shuffle_epi32(sum0, _MM_SHUFFLE(1,0,3,2)));
+    int32_t ri = _mm_cvtsi128_si32(sum0);
+    int32_t rq = _mm_cvtsi128_si32(_mm_srli_si128(sum0, 4));
+
+    // cleanup
+    for (; i<_q->n; i++) {
+        ri += (int32_t)_q->h[i] * (int32_t)_x[i].real;
+        rq += (int32_t)_q->h[i] * (int32_t)_x[i].imag;
+    }
+
+    // set return value
+    _y->real = liquid_q16_round(ri);
+    _y->imag = liquid_q16_round(rq);
+}
+
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Fixed-point (Q15) dot product (ARM Neon)
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+//
+// structured Neon dot product
+//
+
+struct dotprod_crcq16_s {
+    unsigned int n;     // length
+    q16_t * h;          // coefficients array
+};
+
+dotprod_crcq16 dotprod_crcq16_create(q16_t *      _h,
+                                     unsigned int _n)
+{
+    dotprod_crcq16 q = (dotprod_crcq16)liquid_malloc(sizeof(struct dotprod_crcq16_s));
+    q->n = _n;
+
+    // allocate memory for coefficients
+    q->h = (q16_t*) liquid_malloc_aligned( q->n*sizeof(q16_t) );
+
+    // set coefficients
+    dotprod_crcq16_update_coefficients(q, _h);
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_crcq16 dotprod_crcq16_recreate(dotprod_crcq16 _q,
+                                       q16_t *        _h,
+                                       unsigned int   _n)
+{
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        dotprod_crcq16_update_coefficients(_q, _h);
+        return _q;
+    }
+
+    // completely destroy and re-create dotprod object
+    dotprod_crcq16_destroy(_q);
+    return dotprod_crcq16_create(_h,_n);
+}
+
+// overwrite coefficients in place (no allocation)
+void dotprod_crcq16_update_coefficients(dotprod_crcq16 _q,
+                                        q16_t *        _h)
+{
+    memmove(_q->h, _h, _q->n*sizeof(q16_t));
+}
+
+void dotprod_crcq16_destroy(dotprod_crcq16 _q)
+{
+    liquid_free_aligned(_q->h);
+    liquid_free(_q);
+}
+
+void dotprod_crcq16_print(dotprod_crcq16 _q)
+{
+    printf("dotprod_crcq16 [neon, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("%3u : %6d\n", i, _q->h[i]);
+}
+
+// 
+void dotprod_crcq16_execute(dotprod_crcq16 _q,
+                            cq16_t *       _x,
+                            cq16_t *       _y)
+{
+    int16x8x2_t v;  // input vectors (de-interleaved real, imag)
+    int16x8_t   h;  // coefficients vector
+
+    // load zeros into sum registers
+    int32x4_t sumi0 = vdupq_n_s32(0);
+    int32x4_t sumi1 = vdupq_n_s32(0);
+    int32x4_t sumq0 = vdupq_n_s32(0);
+    int32x4_t sumq1 = vdupq_n_s32(0);
+
+    // t = 8*(floor(_n/8))
+    unsigned int t = (_q->n >> 3) << 3;
+
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        // load and de-interleave inputs into registers (unaligned)
+        v = vld2q_s16((int16_t*)&_x[i]);
+
+        // load coefficients into register (aligned)
+        h = vld1q_s16(&_q->h[i]);
+
+        // widening multiply and accumulate
+        sumi0 = vmlal_s16(sumi0, vget_low_s16(v.val[0]),  vget_low_s16(h));
+        sumi1 = vmlal_s16(sumi1, vget_high_s16(v.val[0]), vget_high_s16(h));
+        sumq0 = vmlal_s16(sumq0, vget_low_s16(v.val[1]),  vget_low_s16(h));
+        sumq1 = vmlal_s16(sumq1, vget_high_s16(v.val[1]), vget_high_s16(h));
+    }
+
+    // unload packed arrays
+    int32_t wi[4];
+    int32_t wq[4];
+    vst1q_s32(wi, vaddq_s32(sumi0, sumi1));
+    vst1q_s32(wq, vaddq_s32(sumq0, sumq1));
+    int32_t ri = wi[0] + wi[1] + wi[2] + wi[3];
+    int32_t rq = wq[0] + wq[1] + wq[2] + wq[3];
+
+    // cleanup
+    for (; i<_q->n; i++) {
+        ri += (int32_t)_q->h[i] * (int32_t)_x[i].real;
+        rq += (int32_t)_q->h[i] * (int32_t)_x[i].imag;
+    }
+
+    // set return value
+    _y->real = liquid_q16_round(ri);
+    _y->imag = liquid_q16_round(rq);
+}
+
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// dotprod_f16.c : dot products with half-precision coefficients
+//
+// Large filter banks (e.g. the polyphase banks of resamp and symsync)
+// can keep their coefficients in IEEE 754 binary16, halving their
+// cache footprint. Only the coefficients are stored at reduced
+// precision: inputs, products and accumulation are single-precision.
+// The x86 kernels widen eight coefficients at a time with the F16C
+// conversion instruction and are selected at run time; the portable
+// versions convert in software. Conversions round to nearest even.
+//
+
+#include <string.h>
+#include "liquid.internal.h"
+
+#if HAVE_DOTPROD_AVX
+#include <immintrin.h>
+#endif
+
+// reinterpret bits of single-precision value
+static uint32_t liquid_float16_bits(float _x)
+{
+    uint32_t u;
+    memmove(&u, &_x, sizeof(float));
+    return u;
+}
+
+static float liquid_float16_value(uint32_t _u)
+{
+    float x;
+    memmove(&x, &_u, sizeof(float));
+    return x;
+}
+
+// convert single-precision value to half precision, rounding to
+// nearest even; values beyond the half-precision range saturate to
+// infinity and values below it become subnormal or zero
+liquid_float16 liquid_float_to_float16(float _x)
+{
+    uint32_t x    = liquid_float16_bits(_x);
+    uint32_t sign = x & 0x80000000u;
+    x ^= sign;
+
+    uint16_t h;
+    if (x >= (127u + 16u) << 23) {
+        // overflow, infinity or NaN
+        h = x > 0x7f800000u ? 0x7e00 : 0x7c00;
+    } else if (x < 113u << 23) {
+        // subnormal or zero: let the floating-point adder round
+        uint32_t magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+        float    f     = liquid_float16_value(x) + liquid_float16_value(magic);
+        h = (uint16_t)(liquid_float16_bits(f) - magic);
+    } else {
+        // normal: rebias exponent and round mantissa
+        uint32_t mant_odd = (x >> 13) & 1;
+        x += ((15u - 127u) << 23) + 0xfff + mant_odd;
+        h = (uint16_t)(x >> 13);
+    }
+    return h | (uint16_t)(sign >> 16);
+}
+
+// convert half-precision value to single precision (exact)
+float liquid_float16_to_float(liquid_float16 _h)
+{
+    uint32_t shifted_exp = 0x7c00u << 13;
+    uint32_t x   = ((uint32_t)_h & 0x7fff) << 13;
+    uint32_t exp = x & shifted_exp;
+    x += (127u - 15u) << 23;
+    if (exp == shifted_exp) {
+        // infinity or NaN
+        x += (128u - 16u) << 23;
+    } else if (exp == 0) {
+        // zero or subnormal: renormalize
+        x += 1u << 23;
+        x  = liquid_float16_bits(liquid_float16_value(x) - liquid_float16_value(113u << 23));
+    }
+    x |= ((uint32_t)_h & 0x8000) << 16;
+    return liquid_float16_value(x);
+}
+
+// convert array to half precision
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of values
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorf_to_float16(const float *    _x,
+                               unsigned int     _n,
+                               liquid_float16 * _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = liquid_float_to_float16(_x[i]);
+}
+
+#if HAVE_DOTPROD_AVX
+// use F16C kernels? (AVX2 dispatch level and host support)
+static int dotprod_f16_use_avx2(void)
+{
+    if (liquid_simd_get_kernel(LIQUID_SIMD_DOTPROD_F16) != LIQUID_SIMD_AVX2)
+        return 0;
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("f16c") ? 1 : 0;
+}
+
+// horizontal sum of eight lanes
+__attribute__((target("avx2")))
+static float dotprod_f16_hsum_avx2(__m256 _v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(_v), _mm256_extractf128_ps(_v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x1));
+    return _mm_cvtss_f32(s);
+}
+
+// widen eight half-precision coefficients
+__attribute__((target("avx2,f16c")))
+static __m256 dotprod_f16_load_avx2(const liquid_float16 * _h)
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)_h));
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void dotprod_rrrh_run_avx2(const liquid_float16 * _h,
+                                  const float *          _x,
+                                  unsigned int           _n,
+                                  float *                _y)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    unsigned int i;
+    for (i=0; i+16<=_n; i+=16) {
+        acc0 = _mm256_fmadd_ps(dotprod_f16_load_avx2(&_h[i  ]), _mm256_loadu_ps(&_x[i  ]), acc0);
+        acc1 = _mm256_fmadd_ps(dotprod_f16_load_avx2(&_h[i+8]), _mm256_loadu_ps(&_x[i+8]), acc1);
+    }
+    if (i+8 <= _n) {
+        acc0 = _mm256_fmadd_ps(dotprod_f16_load_avx2(&_h[i]), _mm256_loadu_ps(&_x[i]), acc0);
+        i += 8;
+    }
+    float r = dotprod_f16_hsum_avx2(_mm256_add_ps(acc0, acc1));
+    for ( ; i<_n; i++)
+        r += liquid_float16_to_float(_h[i]) * _x[i];
+    *_y = r;
+}
+
+// real coefficients against interleaved complex input: each widened
+// coefficient is duplicated across the in-phase/quadrature lanes
+__attribute__((target("avx2,fma,f16c")))
+static void dotprod_crch_run_avx2(const liquid_float16 * _h,
+                                  const float complex *  _x,
+                                  unsigned int           _n,
+                                  float complex *        _y)
+{
+    const float * x = (const float*)_x;
+    __m256i lo = _mm256_setr_epi32(0,0,1,1,2,2,3,3);
+    __m256i hi = _mm256_setr_epi32(4,4,5,5,6,6,7,7);
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 h = dotprod_f16_load_avx2(&_h[i]);
+        acc0 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(h, lo), _mm256_loadu_ps(&x[2*i  ]), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(h, hi), _mm256_loadu_ps(&x[2*i+8]), acc1);
+    }
+
+    // sum in-phase (even) and quadrature (odd) lanes separately
+    float t[8];
+    _mm256_storeu_ps(t, _mm256_add_ps(acc0, acc1));
+    float re = t[0] + t[2] + t[4] + t[6];
+    float im = t[1] + t[3] + t[5] + t[7];
+    for ( ; i<_n; i++) {
+        float h = liquid_float16_to_float(_h[i]);
+        re += h * x[2*i  ];
+        im += h * x[2*i+1];
+    }
+    *_y = re + _Complex_I*im;
+}
+
+// interleaved complex coefficients and input: accumulate h*x and
+// h*swap(x) lane-wise, and combine the lanes once at the end
+__attribute__((target("avx2,fma,f16c")))
+static void dotprod_ccch_run_avx2(const liquid_float16 * _h,
+                                  const float complex *  _x,
+                                  unsigned int           _n,
+                                  float complex *        _y)
+{
+    const float * x = (const float*)_x;
+    __m256 acc_a = _mm256_setzero_ps();     // hr*xr, hi*xi
+    __m256 acc_b = _mm256_setzero_ps();     // hr*xi, hi*xr
+    unsigned int i;
+    for (i=0; i+4<=_n; i+=4) {
+        __m256 h  = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&_h[2*i]));
+        __m256 xv = _mm256_loadu_ps(&x[2*i]);
+        acc_a = _mm256_fmadd_ps(h, xv, acc_a);
+        acc_b = _mm256_fmadd_ps(h, _mm256_permute_ps(xv, 0xb1), acc_b);
+    }
+
+    float a[8], b[8];
+    _mm256_storeu_ps(a, acc_a);
+    _mm256_storeu_ps(b, acc_b);
+    float re = (a[0] + a[2] + a[4] + a[6]) - (a[1] + a[3] + a[5] + a[7]);
+    float im = b[0] + b[1] + b[2] + b[3] + b[4] + b[5] + b[6] + b[7];
+    for ( ; i<_n; i++) {
+        float hr = liquid_float16_to_float(_h[2*i  ]);
+        float hi = liquid_float16_to_float(_h[2*i+1]);
+        re += hr*x[2*i] - hi*x[2*i+1];
+        im += hr*x[2*i+1] + hi*x[2*i];
+    }
+    *_y = re + _Complex_I*im;
+}
+#endif
+
+// dot product, half-precision real coefficients, real input
+//  _h      :   coefficients [size: _n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dotprod length
+//  _y      :   output sample pointer
+void dotprod_rrrh_run(const liquid_float16 * _h,
+                      const float *          _x,
+                      unsigned int           _n,
+                      float *                _y)
+{
+#if HAVE_DOTPROD_AVX
+    if (dotprod_f16_use_avx2()) {
+        dotprod_rrrh_run_avx2(_h, _x, _n, _y);
+        return;
+    }
+#endif
+    float r = 0.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += liquid_float16_to_float(_h[i]) * _x[i];
+    *_y = r;
+}
+
+// dot product, half-precision real coefficients, complex input
+//  _h      :   coefficients [size: _n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dotprod length
+//  _y      :   output sample pointer
+void dotprod_crch_run(const liquid_float16 * _h,
+                      const float complex *  _x,
+                      unsigned int           _n,
+                      float complex *        _y)
+{
+#if HAVE_DOTPROD_AVX
+    if (dotprod_f16_use_avx2()) {
+        dotprod_crch_run_avx2(_h, _x, _n, _y);
+        return;
+    }
+#endif
+    float complex r = 0.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += liquid_float16_to_float(_h[i]) * _x[i];
+    *_y = r;
+}
+
+// dot product, half-precision complex coefficients, complex input
+//  _h      :   coefficients, interleaved real/imaginary [size: 2*_n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dotprod length
+//  _y      :   output sample pointer
+void dotprod_ccch_run(const liquid_float16 * _h,
+                      const float complex *  _x,
+                      unsigned int           _n,
+                      float complex *        _y)
+{
+#if HAVE_DOTPROD_AVX
+    if (dotprod_f16_use_avx2()) {
+        dotprod_ccch_run_avx2(_h, _x, _n, _y);
+        return;
+    }
+#endif
+    float complex r = 0.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += (liquid_float16_to_float(_h[2*i]) + _Complex_I*liquid_float16_to_float(_h[2*i+1])) * _x[i];
+    *_y = r;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Fixed-point (Q15) dot product: conversion and ordinal methods
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// convert floating-point value to Q15, saturating outside [-1,1)
+q16_t q16_float_to_fixed(float _x)
+{
+    float v = roundf(_x * 32768.0f);
+    if (v >  32767.0f) return  32767;
+    if (v < -32768.0f) return -32768;
+    return (q16_t) v;
+}
+
+// convert Q15 value to floating-point
+float q16_fixed_to_float(q16_t _x)
+{
+    return (float)_x / 32768.0f;
+}
+
+// round 32-bit fixed-point (Q30) dot product accumulator to Q15,
+// saturating to [-1,1)
+q16_t liquid_q16_round(int32_t _acc)
+{
+    int64_t v = ((int64_t)_acc + (1<<14)) >> 15;
+    if (v >  32767) return  32767;
+    if (v < -32768) return -32768;
+    return (q16_t) v;
+}
+
+// basic dot product (ordinal calculation)
+void dotprod_rrrq16_run(q16_t *      _h,
+                        q16_t *      _x,
+                        unsigned int _n,
+                        q16_t *      _y)
+{
+    int32_t r = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += (int32_t)_h[i] * (int32_t)_x[i];
+    *_y = liquid_q16_round(r);
+}
+
+// basic dot product (ordinal calculation)
+void dotprod_crcq16_run(q16_t *      _h,
+                        cq16_t *     _x,
+                        unsigned int _n,
+                        cq16_t *     _y)
+{
+    int32_t ri = 0;
+    int32_t rq = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        ri += (int32_t)_h[i] * (int32_t)_x[i].real;
+        rq += (int32_t)_h[i] * (int32_t)_x[i].imag;
+    }
+    _y->real = liquid_q16_round(ri);
+    _y->imag = liquid_q16_round(rq);
+}
+
@@ -101,7 +101,7 @@ struct dotprod_rrrf_s {
 dotprod_rrrf dotprod_rrrf_create(float *      _h,
                                  unsigned int _n)
 {
-    dotprod_rrrf dp = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    dotprod_rrrf dp = (dotprod_rrrf)liquid_malloc(sizeof(struct dotprod_rrrf_s));
     dp->n = _n;
 
     // create 4 copies of the input coefficients (one for each
@@ -110,12 +110,12 @@ dotprod_rrrf dotprod_rrrf_create(float *      _h,
     //  dp->h[1] = {. 1,2,3,4,5,6}
     //  dp->h[2] = {. . 1,2,3,4,5,6}
     //  dp->h[3] = {. . . 1,2,3,4,5,6}
-    unsigned int i,j;
-    for (i=0; i<4; i++) {
-        dp->h[i] = calloc(1+(dp->n+i-1)/4,sizeof(vector float));
-        for (j=0; j<dp->n; j++)
-            dp->h[i][j+i] = _h[j];
-    }
+    unsigned int i;
+    for (i=0; i<4; i++)
+        dp->h[i] = liquid_calloc(1+(dp->n+i-1)/4,sizeof(vector float));
+
+    // set coefficients
+    dotprod_rrrf_update_coefficients(dp, _h);
 
     return dp;
 }
@@ -125,21 +125,39 @@ dotprod_rrrf dotprod_rrrf_recreate(dotprod_rrrf _q,
                                    float *      _h,
                                    unsigned int _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        dotprod_rrrf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_rrrf_destroy(_q);
     return dotprod_rrrf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation); the padding
+// introduced by the alignment offsets remains zero
+void dotprod_rrrf_update_coefficients(dotprod_rrrf _q,
+                                      float *      _h)
+{
+    unsigned int i,j;
+    for (i=0; i<4; i++) {
+        for (j=0; j<_q->n; j++)
+            _q->h[i][j+i] = _h[j];
+    }
+}
+
 // destroy the structured dotprod object
 void dotprod_rrrf_destroy(dotprod_rrrf _q)
 {
     // clean up coefficients arrays
     unsigned int i;
     for (i=0; i<4; i++)
-        free(_q->h[i]);
+        liquid_free(_q->h[i]);
 
     // free allocated object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print the dotprod object
@@ -151,6 +169,17 @@ void dotprod_rrrf_print(dotprod_rrrf _q)
         printf("  %3u : %12.9f\n", i, _q->h[0][i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_rrrf_get_memory_usage(dotprod_rrrf _q)
+{
+    // one padded copy of the coefficients for each input alignment
+    unsigned long int n = sizeof(struct dotprod_rrrf_s);
+    unsigned int i;
+    for (i=0; i<4; i++)
+        n += (1+(_q->n+i-1)/4)*sizeof(vector float);
+    return n;
+}
+
 // exectue vectorized structured inner dot product
 void dotprod_rrrf_execute(dotprod_rrrf _q,
                           float *      _x,
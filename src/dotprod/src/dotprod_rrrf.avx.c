@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Floating-point dot product (AVX2/FMA, AVX-512F)
+//
+// These kernels are compiled with per-function target attributes so
+// that they can live in the same binary as the baseline SSE methods;
+// dotprod_rrrf_create() selects one at run time based on the host cpu.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// AVX2/FMA dot product
+//  _h      :   coefficients array, 32-byte aligned [size: _n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dot product length
+//  _y      :   output sample pointer
+__attribute__((target("avx2,fma")))
+void dotprod_rrrf_execute_avx2(float *      _h,
+                               float *      _x,
+                               unsigned int _n,
+                               float *      _y)
+{
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    // r = 32*floor(n/32)
+    unsigned int r = (_n >> 5) << 5;
+
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        // multiply inputs (unaligned) by coefficients (aligned) and accumulate
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i   ]), _mm256_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+ 8]), _mm256_load_ps(&_h[i+ 8]), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+16]), _mm256_load_ps(&_h[i+16]), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+24]), _mm256_load_ps(&_h[i+24]), sum3);
+    }
+
+    // t = 8*floor(n/8)
+    unsigned int t = (_n >> 3) << 3;
+    for ( ; i<t; i+=8)
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i]), _mm256_load_ps(&_h[i]), sum0);
+
+    // fold down
+    sum0 = _mm256_add_ps( _mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3) );
+    __m128 s = _mm_add_ps( _mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1) );
+    s = _mm_hadd_ps(s, s);
+    s = _mm_hadd_ps(s, s);
+    float total = _mm_cvtss_f32(s);
+
+    // cleanup
+    for ( ; i<_n; i++)
+        total += _h[i] * _x[i];
+
+    // set return value
+    *_y = total;
+}
+
+// AVX-512F dot product
+//  _h      :   coefficients array, 64-byte aligned [size: _n x 1]
+//  _x      :   input array [size: _n x 1]
+//  _n      :   dot product length
+//  _y      :   output sample pointer
+__attribute__((target("avx512f")))
+void dotprod_rrrf_execute_avx512f(float *      _h,
+                                  float *      _x,
+                                  unsigned int _n,
+                                  float *      _y)
+{
+    // load zeros into sum registers
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    __m512 sum2 = _mm512_setzero_ps();
+    __m512 sum3 = _mm512_setzero_ps();
+
+    // r = 64*floor(n/64)
+    unsigned int r = (_n >> 6) << 6;
+
+    unsigned int i;
+    for (i=0; i<r; i+=64) {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i   ]), _mm512_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i+16]), _mm512_load_ps(&_h[i+16]), sum1);
+        sum2 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i+32]), _mm512_load_ps(&_h[i+32]), sum2);
+        sum3 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i+48]), _mm512_load_ps(&_h[i+48]), sum3);
+    }
+
+    // t = 16*floor(n/16)
+    unsigned int t = (_n >> 4) << 4;
+    for ( ; i<t; i+=16)
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i]), _mm512_load_ps(&_h[i]), sum0);
+
+    // remaining samples using masked loads
+    if (i < _n) {
+        __mmask16 m = (__mmask16)((1u << (_n - i)) - 1);
+        sum1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &_x[i]),
+                               _mm512_maskz_load_ps (m, &_h[i]), sum1);
+    }
+
+    // fold down
+    sum0 = _mm512_add_ps( _mm512_add_ps(sum0, sum1), _mm512_add_ps(sum2, sum3) );
+
+    // set return value
+    *_y = _mm512_reduce_add_ps(sum0);
+}
+
+
+// AVX2/FMA block dot product: each vector lane accumulates a
+// different output; every broadcast coefficient is applied to four
+// vectors of consecutive outputs before moving to the next tap
+//  _h      :   coefficients array [size: _n x 1]
+//  _n      :   dot product length
+//  _x      :   input array [size: _num + _n - 1 x 1]
+//  _num    :   number of outputs
+//  _y      :   output array [size: _num x 1]
+__attribute__((target("avx2,fma")))
+void dotprod_rrrf_run_block_avx2(float *      _h,
+                                 unsigned int _n,
+                                 float *      _x,
+                                 unsigned int _num,
+                                 float *      _y)
+{
+    __m256 h, y0, y1, y2, y3;
+    unsigned int i, k;
+
+    // groups of 32 outputs
+    for (k=0; k+32 <= _num; k+=32) {
+        float * x = &_x[k];
+        y0 = _mm256_setzero_ps();
+        y1 = _mm256_setzero_ps();
+        y2 = _mm256_setzero_ps();
+        y3 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++) {
+            h  = _mm256_broadcast_ss(&_h[i]);
+            y0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[i   ]), y0);
+            y1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[i+ 8]), y1);
+            y2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[i+16]), y2);
+            y3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[i+24]), y3);
+        }
+        _mm256_storeu_ps(&_y[k   ], y0);
+        _mm256_storeu_ps(&_y[k+ 8], y1);
+        _mm256_storeu_ps(&_y[k+16], y2);
+        _mm256_storeu_ps(&_y[k+24], y3);
+    }
+
+    // groups of 8 outputs
+    for ( ; k+8 <= _num; k+=8) {
+        float * x = &_x[k];
+        y0 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_h[i]), _mm256_loadu_ps(&x[i]), y0);
+        _mm256_storeu_ps(&_y[k], y0);
+    }
+
+    // remaining outputs (masked)
+    if (k < _num) {
+        float * x = &_x[k];
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(_num-k),
+                                          _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+        y0 = _mm256_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_h[i]), _mm256_maskload_ps(&x[i], mask), y0);
+        _mm256_maskstore_ps(&_y[k], mask, y0);
+    }
+}
+
+// AVX-512F block dot product (see dotprod_rrrf_run_block_avx2)
+__attribute__((target("avx512f")))
+void dotprod_rrrf_run_block_avx512f(float *      _h,
+                                    unsigned int _n,
+                                    float *      _x,
+                                    unsigned int _num,
+                                    float *      _y)
+{
+    __m512 h, y0, y1, y2, y3;
+    unsigned int i, k;
+
+    // groups of 64 outputs
+    for (k=0; k+64 <= _num; k+=64) {
+        float * x = &_x[k];
+        y0 = _mm512_setzero_ps();
+        y1 = _mm512_setzero_ps();
+        y2 = _mm512_setzero_ps();
+        y3 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++) {
+            h  = _mm512_set1_ps(_h[i]);
+            y0 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[i   ]), y0);
+            y1 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[i+16]), y1);
+            y2 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[i+32]), y2);
+            y3 = _mm512_fmadd_ps(h, _mm512_loadu_ps(&x[i+48]), y3);
+        }
+        _mm512_storeu_ps(&_y[k   ], y0);
+        _mm512_storeu_ps(&_y[k+16], y1);
+        _mm512_storeu_ps(&_y[k+32], y2);
+        _mm512_storeu_ps(&_y[k+48], y3);
+    }
+
+    // groups of 16 outputs
+    for ( ; k+16 <= _num; k+=16) {
+        float * x = &_x[k];
+        y0 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm512_fmadd_ps(_mm512_set1_ps(_h[i]), _mm512_loadu_ps(&x[i]), y0);
+        _mm512_storeu_ps(&_y[k], y0);
+    }
+
+    // remaining outputs (masked)
+    if (k < _num) {
+        float * x = &_x[k];
+        __mmask16 mask = (__mmask16)((1u << (_num-k)) - 1);
+        y0 = _mm512_setzero_ps();
+        for (i=0; i<_n; i++)
+            y0 = _mm512_fmadd_ps(_mm512_set1_ps(_h[i]), _mm512_maskz_loadu_ps(mask, &x[i]), y0);
+        _mm512_mask_storeu_ps(&_y[k], mask, y0);
+    }
+}
+
+// AVX2/FMA batched dot product on a single shared input: coefficient
+// sets are interleaved in groups of four (see dotprod_batch.c), so the
+// four outputs of a group occupy the lanes of one 128-bit half; each
+// vector covers two taps of a group and every input sample is loaded
+// once per group
+//  _h      :   interleaved coefficients [size: 4*ceil(_num/4)*_n x 1]
+//  _n      :   dot product length
+//  _num    :   number of dot products
+//  _x      :   shared input array [size: _n x 1]
+//  _y      :   output array [size: _num x 1]
+__attribute__((target("avx2,fma")))
+void dotprod_rrrf_execute_batch_shared_avx2(float *      _h,
+                                            unsigned int _n,
+                                            unsigned int _num,
+                                            float *      _x,
+                                            float *      _y)
+{
+    // lane selection: taps (i,i+1) and (i+2,i+3) of four loaded inputs
+    const __m256i sel0 = _mm256_setr_epi32(0,0,0,0,1,1,1,1);
+    const __m256i sel1 = _mm256_setr_epi32(2,2,2,2,3,3,3,3);
+
+    unsigned int num_groups = (_num + 3) / 4;
+    unsigned int g, i;
+    for (g=0; g<num_groups; g++) {
+        float * h = &_h[4*g*_n];
+        __m256 y0 = _mm256_setzero_ps();
+        __m256 y1 = _mm256_setzero_ps();
+        __m256 y2 = _mm256_setzero_ps();
+        __m256 y3 = _mm256_setzero_ps();
+        for (i=0; i+8<=_n; i+=8) {
+            __m256 x0 = _mm256_castps128_ps256(_mm_loadu_ps(&_x[i  ]));
+            __m256 x1 = _mm256_castps128_ps256(_mm_loadu_ps(&_x[i+4]));
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(&h[4*i   ]), _mm256_permutevar8x32_ps(x0, sel0), y0);
+            y1 = _mm256_fmadd_ps(_mm256_loadu_ps(&h[4*i+ 8]), _mm256_permutevar8x32_ps(x0, sel1), y1);
+            y2 = _mm256_fmadd_ps(_mm256_loadu_ps(&h[4*i+16]), _mm256_permutevar8x32_ps(x1, sel0), y2);
+            y3 = _mm256_fmadd_ps(_mm256_loadu_ps(&h[4*i+24]), _mm256_permutevar8x32_ps(x1, sel1), y3);
+        }
+        y0 = _mm256_add_ps(_mm256_add_ps(y0, y1), _mm256_add_ps(y2, y3));
+
+        // fold halves (taps i and i+1) and finish remaining taps
+        __m128 r = _mm_add_ps(_mm256_castps256_ps128(y0), _mm256_extractf128_ps(y0, 1));
+        for ( ; i<_n; i++)
+            r = _mm_fmadd_ps(_mm_loadu_ps(&h[4*i]), _mm_set1_ps(_x[i]), r);
+
+        if (4*g + 4 <= _num) {
+            _mm_storeu_ps(&_y[4*g], r);
+        } else {
+            float v[4];
+            _mm_storeu_ps(v, r);
+            for (i=0; 4*g+i<_num; i++)
+                _y[4*g+i] = v[i];
+        }
+    }
+}
@@ -108,19 +108,23 @@ void dotprod_rrrf_run4(float *      _h,
 struct dotprod_rrrf_s {
     unsigned int n;     // length
     float * h;          // coefficients array
+    liquid_simd_level simd; // kernel selected at run time
 };
 
 dotprod_rrrf dotprod_rrrf_create(float *      _h,
                                  unsigned int _n)
 {
-    dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    dotprod_rrrf q = (dotprod_rrrf)liquid_malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( q->n*sizeof(float), 16);
+    // select kernel based on host cpu capabilities
+    q->simd = liquid_simd_get_level();
+
+    // allocate memory for coefficients, aligned for widest (AVX-512) loads
+    q->h = (float*) liquid_malloc_aligned(q->n*sizeof(float));
 
     // set coefficients
-    memmove(q->h, _h, _n*sizeof(float));
+    dotprod_rrrf_update_coefficients(q, _h);
 
     // return object
     return q;
@@ -131,31 +135,74 @@ dotprod_rrrf dotprod_rrrf_recreate(dotprod_rrrf _q,
                                    float * _h,
                                    unsigned int _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        _q->simd = liquid_simd_get_level();
+        dotprod_rrrf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_rrrf_destroy(_q);
     return dotprod_rrrf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation)
+void dotprod_rrrf_update_coefficients(dotprod_rrrf _q,
+                                      float *      _h)
+{
+    // set coefficients
+    memmove(_q->h, _h, _q->n*sizeof(float));
+}
+
 
 void dotprod_rrrf_destroy(dotprod_rrrf _q)
 {
-    _mm_free(_q->h);
-    free(_q);
+    liquid_free_aligned(_q->h);
+    liquid_free(_q);
 }
 
 void dotprod_rrrf_print(dotprod_rrrf _q)
 {
-    printf("dotprod_rrrf [mmx, %u coefficients]\n", _q->n);
+    printf("dotprod_rrrf [%s, %u coefficients]\n", liquid_simd_level_str(_q->simd), _q->n);
     unsigned int i;
     for (i=0; i<_q->n; i++)
         printf("%3u : %12.9f\n", i, _q->h[i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_rrrf_get_memory_usage(dotprod_rrrf _q)
+{
+    return sizeof(struct dotprod_rrrf_s) + _q->n*sizeof(float);
+}
+
+// portable C (selected with liquid_simd_set_level())
+static void dotprod_rrrf_execute_portable(dotprod_rrrf _q,
+                                          float *      _x,
+                                          float *      _y)
+{
+    float r = 0;
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        r += _q->h[i] * _x[i];
+    *_y = r;
+}
+
 // 
 void dotprod_rrrf_execute(dotprod_rrrf _q,
                           float *      _x,
                           float *      _y)
 {
+    // run-time dispatch
+    switch (_q->simd) {
+#if HAVE_DOTPROD_AVX
+    case LIQUID_SIMD_AVX512F: dotprod_rrrf_execute_avx512f(_q->h, _x, _q->n, _y); return;
+    case LIQUID_SIMD_AVX2:    dotprod_rrrf_execute_avx2   (_q->h, _x, _q->n, _y); return;
+#endif
+    case LIQUID_SIMD_PORTABLE: dotprod_rrrf_execute_portable(_q, _x, _y); return;
+    default:;
+    }
+
     // switch based on size
     if (_q->n < 16) {
         dotprod_rrrf_execute_mmx(_q, _x, _y);
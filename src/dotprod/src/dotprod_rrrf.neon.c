@@ -165,14 +165,14 @@ struct dotprod_rrrf_s {
 dotprod_rrrf dotprod_rrrf_create(float *      _h,
                                  unsigned int _n)
 {
-    dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    dotprod_rrrf q = (dotprod_rrrf)liquid_malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
     // allocate memory for coefficients
-    q->h = (float*) malloc( q->n*sizeof(float) );
+    q->h = (float*) liquid_malloc_aligned( q->n*sizeof(float) );
 
     // set coefficients
-    memmove(q->h, _h, _n*sizeof(float));
+    dotprod_rrrf_update_coefficients(q, _h);
 
     // return object
     return q;
@@ -183,19 +183,33 @@ dotprod_rrrf dotprod_rrrf_recreate(dotprod_rrrf _q,
                                    float *      _h,
                                    unsigned int _n)
 {
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        dotprod_rrrf_update_coefficients(_q, _h);
+        return _q;
+    }
+
     // completely destroy and re-create dotprod object
     dotprod_rrrf_destroy(_q);
     return dotprod_rrrf_create(_h,_n);
 }
 
+// overwrite coefficients in place (no allocation)
+void dotprod_rrrf_update_coefficients(dotprod_rrrf _q,
+                                      float *      _h)
+{
+    // set coefficients
+    memmove(_q->h, _h, _q->n*sizeof(float));
+}
+
 // destroy dotprod object, freeing internal memory
 void dotprod_rrrf_destroy(dotprod_rrrf _q)
 {
     // free coefficients
-    free(_q->h);
+    liquid_free_aligned(_q->h);
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print dotprod internal state
@@ -207,6 +221,12 @@ void dotprod_rrrf_print(dotprod_rrrf _q)
         printf("%3u : %12.9f\n", i, _q->h[i]);
 }
 
+// get memory footprint of object and its coefficients [bytes]
+unsigned long int dotprod_rrrf_get_memory_usage(dotprod_rrrf _q)
+{
+    return sizeof(struct dotprod_rrrf_s) + _q->n*sizeof(float);
+}
+
 // execute dot product on input vector
 void dotprod_rrrf_execute(dotprod_rrrf _q,
                           float *      _x,
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Fixed-point (Q15) dot product (SSE2)
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+// internal methods
+void dotprod_rrrq16_execute_sse2(dotprod_rrrq16 _q,
+                                 q16_t *        _x,
+                                 q16_t *        _y);
+
+//
+// structured SSE2 dot product
+//
+
+struct dotprod_rrrq16_s {
+    unsigned int n;     // length
+    q16_t * h;          // coefficients array
+    liquid_simd_level simd; // kernel selected at run time
+};
+
+dotprod_rrrq16 dotprod_rrrq16_create(q16_t *      _h,
+                                     unsigned int _n)
+{
+    dotprod_rrrq16 q = (dotprod_rrrq16)liquid_malloc(sizeof(struct dotprod_rrrq16_s));
+    q->n = _n;
+
+    // select kernel based on host cpu capabilities
+    q->simd = liquid_simd_get_level();
+
+    // allocate memory for coefficients (aligned)
+    q->h = (q16_t*) liquid_malloc_aligned(q->n*sizeof(q16_t));
+
+    // set coefficients
+    dotprod_rrrq16_update_coefficients(q, _h);
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_rrrq16 dotprod_rrrq16_recreate(dotprod_rrrq16 _q,
+                                       q16_t *        _h,
+                                       unsigned int   _n)
+{
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        _q->simd = liquid_simd_get_level();
+        dotprod_rrrq16_update_coefficients(_q, _h);
+        return _q;
+    }
+
+    // completely destroy and re-create dotprod object
+    dotprod_rrrq16_destroy(_q);
+    return dotprod_rrrq16_create(_h,_n);
+}
+
+// overwrite coefficients in place (no allocation)
+void dotprod_rrrq16_update_coefficients(dotprod_rrrq16 _q,
+                                        q16_t *        _h)
+{
+    memmove(_q->h, _h, _q->n*sizeof(q16_t));
+}
+
+void dotprod_rrrq16_destroy(dotprod_rrrq16 _q)
+{
+    liquid_free_aligned(_q->h);
+    liquid_free(_q);
+}
+
+void dotprod_rrrq16_print(dotprod_rrrq16 _q)
+{
+    printf("dotprod_rrrq16 [%s, %u coefficients]\n",
+            liquid_simd_level_str(liquid_simd_get_kernel(LIQUID_SIMD_DOTPROD_Q16)), _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("%3u : %6d\n", i, _q->h[i]);
+}
+
+// 
+void dotprod_rrrq16_execute(dotprod_rrrq16 _q,
+                            q16_t *        _x,
+                            q16_t *        _y)
+{
+    // run-time dispatch (portable C selected with liquid_simd_set_level())
+    if (_q->simd == LIQUID_SIMD_PORTABLE) {
+        dotprod_rrrq16_run(_q->h, _x, _q->n, _y);
+        return;
+    }
+
+    dotprod_rrrq16_execute_sse2(_q, _x, _y);
+}
+
+// use SSE2 extensions: pmaddwd multiplies eight pairs of 16-bit
+// values and sums adjacent products into four 32-bit accumulators
+void dotprod_rrrq16_execute_sse2(dotprod_rrrq16 _q,
+                                 q16_t *        _x,
+                                 q16_t *        _y)
+{
+    __m128i v0, v1; // input vectors
+    __m128i h0, h1; // coefficients vectors
+
+    // load zeros into sum registers
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+
+    // r = 16*floor(n/16)
+    unsigned int r = (_q->n >> 4) << 4;
+
+    unsigned int i;
+    for (i=0; i<r; i+=16) {
+        // load inputs into register (unaligned)
+        v0 = _mm_loadu_si128((__m128i*)&_x[i]);
+        v1 = _mm_loadu_si128((__m128i*)&_x[i+8]);
+
+        // load coefficients into register (aligned)
+        h0 = _mm_load_si128((__m128i*)&_q->h[i]);
+        h1 = _mm_load_si128((__m128i*)&_q->h[i+8]);
+
+        // multiply and accumulate
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(v0, h0));
+        sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(v1, h1));
+    }
+
+    // remaining group of 8
+    if (i + 8 <= _q->n) {
+        v0 = _mm_loadu_si128((__m128i*)&_x[i]);
+        h0 = _mm_load_si128((__m128i*)&_q->h[i]);
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(v0, h0));
+        i += 8;
+    }
+
+    // fold down into single value
+    sum0 = _mm_add_epi32(sum0, sum1);
+    sum0 = _mm_add_epi32(sum0, _mm_shuffle_epi32(sum0, _MM_SHUFFLE(1,0,3,2)));
+    sum0 = _mm_add_epi32(sum0, _mm_shuffle_epi32(sum0, _MM_SHUFFLE(2,3,0,1)));
+    int32_t total = _mm_cvtsi128_si32(sum0);
+
+    // cleanup
+    for (; i<_q->n; i++)
+        total += (int32_t)_q->h[i] * (int32_t)_x[i];
+
+    // set return value
+    *_y = liquid_q16_round(total);
+}
+
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Fixed-point (Q15) dot product (ARM Neon)
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+//
+// structured Neon dot product
+//
+
+struct dotprod_rrrq16_s {
+    unsigned int n;     // length
+    q16_t * h;          // coefficients array
+};
+
+dotprod_rrrq16 dotprod_rrrq16_create(q16_t *      _h,
+                                     unsigned int _n)
+{
+    dotprod_rrrq16 q = (dotprod_rrrq16)liquid_malloc(sizeof(struct dotprod_rrrq16_s));
+    q->n = _n;
+
+    // allocate memory for coefficients
+    q->h = (q16_t*) liquid_malloc_aligned( q->n*sizeof(q16_t) );
+
+    // set coefficients
+    dotprod_rrrq16_update_coefficients(q, _h);
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_rrrq16 dotprod_rrrq16_recreate(dotprod_rrrq16 _q,
+                                       q16_t *        _h,
+                                       unsigned int   _n)
+{
+    // overwrite coefficients in place if length is unchanged
+    if (_n == _q->n) {
+        dotprod_rrrq16_update_coefficients(_q, _h);
+        return _q;
+    }
+
+    // completely destroy and re-create dotprod object
+    dotprod_rrrq16_destroy(_q);
+    return dotprod_rrrq16_create(_h,_n);
+}
+
+// overwrite coefficients in place (no allocation)
+void dotprod_rrrq16_update_coefficients(dotprod_rrrq16 _q,
+                                        q16_t *        _h)
+{
+    memmove(_q->h, _h, _q->n*sizeof(q16_t));
+}
+
+void dotprod_rrrq16_destroy(dotprod_rrrq16 _q)
+{
+    liquid_free_aligned(_q->h);
+    liquid_free(_q);
+}
+
+void dotprod_rrrq16_print(dotprod_rrrq16 _q)
+{
+    printf("dotprod_rrrq16 [neon, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("%3u : %6d\n", i, _q->h[i]);
+}
+
+// 
+void dotprod_rrrq16_execute(dotprod_rrrq16 _q,
+                            q16_t *        _x,
+                            q16_t *        _y)
+{
+    int16x8_t v;    // input vector
+    int16x8_t h;    // coefficients vector
+
+    // load zeros into sum registers
+    int32x4_t sum0 = vdupq_n_s32(0);
+    int32x4_t sum1 = vdupq_n_s32(0);
+
+    // t = 8*(floor(_n/8))
+    unsigned int t = (_q->n >> 3) << 3;
+
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        // load inputs into register (unaligned)
+        v = vld1q_s16(&_x[i]);
+
+        // load coefficients into register (aligned)
+        h = vld1q_s16(&_q->h[i]);
+
+        // widening multiply and accumulate
+        sum0 = vmlal_s16(sum0, vget_low_s16(v),  vget_low_s16(h));
+        sum1 = vmlal_s16(sum1, vget_high_s16(v), vget_high_s16(h));
+    }
+
+    // unload packed array
+    int32_t w[4];
+    vst1q_s32(w, vaddq_s32(sum0, sum1));
+    int32_t total = w[0] + w[1] + w[2] + w[3];
+
+    // cleanup
+    for (; i<_q->n; i++)
+        total += (int32_t)_q->h[i] * (int32_t)_x[i];
+
+    // set return value
+    *_y = liquid_q16_round(total);
+}
+
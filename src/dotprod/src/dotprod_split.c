@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// dotprod_split.c : dot products on split-complex inputs
+//
+// Inputs (and complex coefficients) are given as separate arrays of
+// real and imaginary parts (see liquid_vectorcf_split()), so that
+// each complex multiply-accumulate is four (cccf) or two (crcf) real
+// multiply-accumulates without de-interleaving. The x86 kernels are
+// selected at run time.
+//
+
+#include "liquid.internal.h"
+
+#if HAVE_DOTPROD_AVX
+#include <immintrin.h>
+
+// horizontal sum of eight lanes
+__attribute__((target("avx2")))
+static float dotprod_split_hsum_avx2(__m256 _v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(_v), _mm256_extractf128_ps(_v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x1));
+    return _mm_cvtss_f32(s);
+}
+
+// four independent accumulators of eight lanes each hide the latency
+// of the fused multiply-adds
+__attribute__((target("avx2,fma")))
+static void dotprod_cccf_run_split_avx2(const float *   _hr,
+                                        const float *   _hi,
+                                        const float *   _xr,
+                                        const float *   _xi,
+                                        unsigned int    _n,
+                                        float complex * _y)
+{
+    __m256 accr[4], acci[4];
+    unsigned int i, k;
+    for (k=0; k<4; k++) {
+        accr[k] = _mm256_setzero_ps();
+        acci[k] = _mm256_setzero_ps();
+    }
+    for (i=0; i+32<=_n; i+=32) {
+        for (k=0; k<4; k++) {
+            __m256 hr = _mm256_loadu_ps(&_hr[i+8*k]);
+            __m256 hi = _mm256_loadu_ps(&_hi[i+8*k]);
+            __m256 xr = _mm256_loadu_ps(&_xr[i+8*k]);
+            __m256 xi = _mm256_loadu_ps(&_xi[i+8*k]);
+            accr[k] = _mm256_fmadd_ps (hr, xr, accr[k]);
+            accr[k] = _mm256_fnmadd_ps(hi, xi, accr[k]);
+            acci[k] = _mm256_fmadd_ps (hr, xi, acci[k]);
+            acci[k] = _mm256_fmadd_ps (hi, xr, acci[k]);
+        }
+    }
+    for ( ; i+8<=_n; i+=8) {
+        __m256 hr = _mm256_loadu_ps(&_hr[i]);
+        __m256 hi = _mm256_loadu_ps(&_hi[i]);
+        __m256 xr = _mm256_loadu_ps(&_xr[i]);
+        __m256 xi = _mm256_loadu_ps(&_xi[i]);
+        accr[0] = _mm256_fmadd_ps (hr, xr, accr[0]);
+        accr[1] = _mm256_fnmadd_ps(hi, xi, accr[1]);
+        acci[0] = _mm256_fmadd_ps (hr, xi, acci[0]);
+        acci[1] = _mm256_fmadd_ps (hi, xr, acci[1]);
+    }
+    accr[0] = _mm256_add_ps(_mm256_add_ps(accr[0], accr[1]), _mm256_add_ps(accr[2], accr[3]));
+    acci[0] = _mm256_add_ps(_mm256_add_ps(acci[0], acci[1]), _mm256_add_ps(acci[2], acci[3]));
+    float yr = dotprod_split_hsum_avx2(accr[0]);
+    float yi = dotprod_split_hsum_avx2(acci[0]);
+    for ( ; i<_n; i++) {
+        yr += _hr[i]*_xr[i] - _hi[i]*_xi[i];
+        yi += _hr[i]*_xi[i] + _hi[i]*_xr[i];
+    }
+    *_y = yr + _Complex_I*yi;
+}
+
+__attribute__((target("avx2,fma")))
+static void dotprod_crcf_run_split_avx2(const float *   _h,
+                                        const float *   _xr,
+                                        const float *   _xi,
+                                        unsigned int    _n,
+                                        float complex * _y)
+{
+    __m256 accr[4], acci[4];
+    unsigned int i, k;
+    for (k=0; k<4; k++) {
+        accr[k] = _mm256_setzero_ps();
+        acci[k] = _mm256_setzero_ps();
+    }
+    for (i=0; i+32<=_n; i+=32) {
+        for (k=0; k<4; k++) {
+            __m256 h = _mm256_loadu_ps(&_h[i+8*k]);
+            accr[k] = _mm256_fmadd_ps(h, _mm256_loadu_ps(&_xr[i+8*k]), accr[k]);
+            acci[k] = _mm256_fmadd_ps(h, _mm256_loadu_ps(&_xi[i+8*k]), acci[k]);
+        }
+    }
+    for ( ; i+8<=_n; i+=8) {
+        __m256 h = _mm256_loadu_ps(&_h[i]);
+        accr[0] = _mm256_fmadd_ps(h, _mm256_loadu_ps(&_xr[i]), accr[0]);
+        acci[0] = _mm256_fmadd_ps(h, _mm256_loadu_ps(&_xi[i]), acci[0]);
+    }
+    accr[0] = _mm256_add_ps(_mm256_add_ps(accr[0], accr[1]), _mm256_add_ps(accr[2], accr[3]));
+    acci[0] = _mm256_add_ps(_mm256_add_ps(acci[0], acci[1]), _mm256_add_ps(acci[2], acci[3]));
+    float yr = dotprod_split_hsum_avx2(accr[0]);
+    float yi = dotprod_split_hsum_avx2(acci[0]);
+    for ( ; i<_n; i++) {
+        yr += _h[i]*_xr[i];
+        yi += _h[i]*_xi[i];
+    }
+    *_y = yr + _Complex_I*yi;
+}
+
+// sixteen lanes per accumulator (AVX-512F)
+__attribute__((target("avx512f")))
+static void dotprod_cccf_run_split_avx512f(const float *   _hr,
+                                           const float *   _hi,
+                                           const float *   _xr,
+                                           const float *   _xi,
+                                           unsigned int    _n,
+                                           float complex * _y)
+{
+    __m512 accr[4], acci[4];
+    unsigned int i, k;
+    for (k=0; k<4; k++) {
+        accr[k] = _mm512_setzero_ps();
+        acci[k] = _mm512_setzero_ps();
+    }
+    for (i=0; i+64<=_n; i+=64) {
+        for (k=0; k<4; k++) {
+            __m512 hr = _mm512_loadu_ps(&_hr[i+16*k]);
+            __m512 hi = _mm512_loadu_ps(&_hi[i+16*k]);
+            __m512 xr = _mm512_loadu_ps(&_xr[i+16*k]);
+            __m512 xi = _mm512_loadu_ps(&_xi[i+16*k]);
+            accr[k] = _mm512_fmadd_ps (hr, xr, accr[k]);
+            accr[k] = _mm512_fnmadd_ps(hi, xi, accr[k]);
+            acci[k] = _mm512_fmadd_ps (hr, xi, acci[k]);
+            acci[k] = _mm512_fmadd_ps (hi, xr, acci[k]);
+        }
+    }
+    for ( ; i+16<=_n; i+=16) {
+        __m512 hr = _mm512_loadu_ps(&_hr[i]);
+        __m512 hi = _mm512_loadu_ps(&_hi[i]);
+        __m512 xr = _mm512_loadu_ps(&_xr[i]);
+        __m512 xi = _mm512_loadu_ps(&_xi[i]);
+        accr[0] = _mm512_fmadd_ps (hr, xr, accr[0]);
+        accr[1] = _mm512_fnmadd_ps(hi, xi, accr[1]);
+        acci[0] = _mm512_fmadd_ps (hr, xi, acci[0]);
+        acci[1] = _mm512_fmadd_ps (hi, xr, acci[1]);
+    }
+    accr[0] = _mm512_add_ps(_mm512_add_ps(accr[0], accr[1]), _mm512_add_ps(accr[2], accr[3]));
+    acci[0] = _mm512_add_ps(_mm512_add_ps(acci[0], acci[1]), _mm512_add_ps(acci[2], acci[3]));
+    float yr = _mm512_reduce_add_ps(accr[0]);
+    float yi = _mm512_reduce_add_ps(acci[0]);
+    for ( ; i<_n; i++) {
+        yr += _hr[i]*_xr[i] - _hi[i]*_xi[i];
+        yi += _hr[i]*_xi[i] + _hi[i]*_xr[i];
+    }
+    *_y = yr + _Complex_I*yi;
+}
+
+__attribute__((target("avx512f")))
+static void dotprod_crcf_run_split_avx512f(const float *   _h,
+                                           const float *   _xr,
+                                           const float *   _xi,
+                                           unsigned int    _n,
+                                           float complex * _y)
+{
+    __m512 accr[4], acci[4];
+    unsigned int i, k;
+    for (k=0; k<4; k++) {
+        accr[k] = _mm512_setzero_ps();
+        acci[k] = _mm512_setzero_ps();
+    }
+    for (i=0; i+64<=_n; i+=64) {
+        for (k=0; k<4; k++) {
+            __m512 h = _mm512_loadu_ps(&_h[i+16*k]);
+            accr[k] = _mm512_fmadd_ps(h, _mm512_loadu_ps(&_xr[i+16*k]), accr[k]);
+            acci[k] = _mm512_fmadd_ps(h, _mm512_loadu_ps(&_xi[i+16*k]), acci[k]);
+        }
+    }
+    for ( ; i+16<=_n; i+=16) {
+        __m512 h = _mm512_loadu_ps(&_h[i]);
+        accr[0] = _mm512_fmadd_ps(h, _mm512_loadu_ps(&_xr[i]), accr[0]);
+        acci[0] = _mm512_fmadd_ps(h, _mm512_loadu_ps(&_xi[i]), acci[0]);
+    }
+    accr[0] = _mm512_add_ps(_mm512_add_ps(accr[0], accr[1]), _mm512_add_ps(accr[2], accr[3]));
+    acci[0] = _mm512_add_ps(_mm512_add_ps(acci[0], acci[1]), _mm512_add_ps(acci[2], acci[3]));
+    float yr = _mm512_reduce_add_ps(accr[0]);
+    float yi = _mm512_reduce_add_ps(acci[0]);
+    for ( ; i<_n; i++) {
+        yr += _h[i]*_xr[i];
+        yi += _h[i]*_xi[i];
+    }
+    *_y = yr + _Complex_I*yi;
+}
+#endif
+
+// complex dot product on split-complex coefficients and input
+void dotprod_cccf_run_split(const float *   _hr,
+                            const float *   _hi,
+                            const float *   _xr,
+                            const float *   _xi,
+                            unsigned int    _n,
+                            float complex * _y)
+{
+#if HAVE_DOTPROD_AVX
+    liquid_simd_level level = liquid_simd_get_kernel(LIQUID_SIMD_DOTPROD_CCCF);
+    if (level == LIQUID_SIMD_AVX512F) {
+        dotprod_cccf_run_split_avx512f(_hr, _hi, _xr, _xi, _n, _y);
+        return;
+    } else if (level == LIQUID_SIMD_AVX2) {
+        dotprod_cccf_run_split_avx2(_hr, _hi, _xr, _xi, _n, _y);
+        return;
+    }
+#endif
+    float yr = 0.0f;
+    float yi = 0.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        yr += _hr[i]*_xr[i] - _hi[i]*_xi[i];
+        yi += _hr[i]*_xi[i] + _hi[i]*_xr[i];
+    }
+    *_y = yr + _Complex_I*yi;
+}
+
+// real coefficients, split-complex input
+void dotprod_crcf_run_split(const float *   _h,
+                            const float *   _xr,
+                            const float *   _xi,
+                            unsigned int    _n,
+                            float complex * _y)
+{
+#if HAVE_DOTPROD_AVX
+    liquid_simd_level level = liquid_simd_get_kernel(LIQUID_SIMD_DOTPROD_CRCF);
+    if (level == LIQUID_SIMD_AVX512F) {
+        dotprod_crcf_run_split_avx512f(_h, _xr, _xi, _n, _y);
+        return;
+    } else if (level == LIQUID_SIMD_AVX2) {
+        dotprod_crcf_run_split_avx2(_h, _xr, _xi, _n, _y);
+        return;
+    }
+#endif
+    float yr = 0.0f;
+    float yi = 0.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        yr += _h[i]*_xr[i];
+        yi += _h[i]*_xi[i];
+    }
+    *_y = yr + _Complex_I*yi;
+}
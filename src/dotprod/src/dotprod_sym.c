@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Folded symmetric dot product: for a filter of length n whose
+// coefficients are even-symmetric, h[i] = h[n-1-i], mirrored input
+// samples are pre-added so that only the first ceil(n/2) coefficients
+// are applied:
+//
+//  y = sum_{i=0}^{n/2-1} h[i] (x[i] + x[n-1-i])  [ + h[n/2] x[n/2] ]
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// defined:
+//  DOTPROD()       name-mangling macro
+//  TO, TC, TI      output, coefficient, and input types
+
+// run folded symmetric dot product
+//  _h      :   first half of coefficients array [size: ceil(_n/2) x 1]
+//  _n      :   full dot product length, _n > 0
+//  _x      :   input array [size: _n x 1]
+//  _y      :   output sample pointer
+void DOTPROD(_run_sym)(TC *         _h,
+                       unsigned int _n,
+                       TI *         _x,
+                       TO *         _y)
+{
+    unsigned int h = _n / 2;    // number of folded taps
+    TI * x1 = &_x[_n-1];        // mirrored input (reversed)
+
+    // fold in groups of 4 with separate accumulators
+    TO r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+    unsigned int i;
+    for (i=0; i+4<=h; i+=4) {
+        r0 += _h[i  ] * (_x[i  ] + x1[-(int)i  ]);
+        r1 += _h[i+1] * (_x[i+1] + x1[-(int)i-1]);
+        r2 += _h[i+2] * (_x[i+2] + x1[-(int)i-2]);
+        r3 += _h[i+3] * (_x[i+3] + x1[-(int)i-3]);
+    }
+
+    // clean up remaining folded taps
+    for ( ; i<h; i++)
+        r0 += _h[i] * (_x[i] + x1[-(int)i]);
+
+    // center tap for odd length
+    if (_n & 1)
+        r1 += _h[h] * _x[h];
+
+    *_y = (r0 + r1) + (r2 + r3);
+}
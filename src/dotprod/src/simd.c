@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// simd.c : run-time SIMD capability detection, kernel selection and
+//          aligned coefficient storage
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+// SIMD level used for dispatch (negative until first queried); read
+// and written atomically as dispatch may first query it from several
+// threads at once
+static int liquid_simd_level_active = -1;
+
+// detect highest SIMD level supported by the host cpu for which
+// kernels are available in this build
+liquid_simd_level liquid_simd_detect(void)
+{
+#if HAVE_DOTPROD_AVX
+    // result is cached as this is called on every invocation of the
+    // light-weight methods (e.g. liquid_sumsqf)
+    // (every thread detects the same level, so racing stores agree)
+    static int cached = -1;
+    int level = __atomic_load_n(&cached, __ATOMIC_RELAXED);
+    if (level >= 0)
+        return (liquid_simd_level) level;
+
+    // query cpu features (also verifies that the operating system
+    // saves the extended register state)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        level = LIQUID_SIMD_AVX512F;
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        level = LIQUID_SIMD_AVX2;
+    else
+        level = LIQUID_SIMD_SSE;
+
+    __atomic_store_n(&cached, level, __ATOMIC_RELAXED);
+    return (liquid_simd_level) level;
+#elif HAVE_DOTPROD_SSE
+    return LIQUID_SIMD_SSE;
+#elif HAVE_DOTPROD_NEON
+    return LIQUID_SIMD_NEON;
+#elif HAVE_DOTPROD_ALTIVEC
+    return LIQUID_SIMD_ALTIVEC;
+#else
+    return LIQUID_SIMD_PORTABLE;
+#endif
+}
+
+// get string describing SIMD level
+const char * liquid_simd_level_str(liquid_simd_level _level)
+{
+    switch (_level) {
+    case LIQUID_SIMD_PORTABLE:  return "portable";
+    case LIQUID_SIMD_SSE:       return "sse";
+    case LIQUID_SIMD_AVX2:      return "avx2";
+    case LIQUID_SIMD_AVX512F:   return "avx512f";
+    case LIQUID_SIMD_NEON:      return "neon";
+    case LIQUID_SIMD_ALTIVEC:   return "altivec";
+    default:;
+    }
+    return "unknown";
+}
+
+// get string describing kernel family
+const char * liquid_simd_family_str(liquid_simd_family _family)
+{
+    switch (_family) {
+    case LIQUID_SIMD_DOTPROD_RRRF:  return "dotprod_rrrf";
+    case LIQUID_SIMD_DOTPROD_CRCF:  return "dotprod_crcf";
+    case LIQUID_SIMD_DOTPROD_CCCF:  return "dotprod_cccf";
+    case LIQUID_SIMD_DOTPROD_BLOCK: return "dotprod_block";
+    case LIQUID_SIMD_DOTPROD_BATCH: return "dotprod_batch";
+    case LIQUID_SIMD_SUMSQ:         return "sumsq";
+    case LIQUID_SIMD_VECTOR:        return "vector";
+    case LIQUID_SIMD_DOTPROD_Q16:   return "dotprod_q16";
+    case LIQUID_SIMD_FFT:           return "fft";
+    case LIQUID_SIMD_SPGRAM:        return "spgram";
+    case LIQUID_SIMD_VITERBI:       return "viterbi";
+    case LIQUID_SIMD_MODEM:         return "modem";
+    case LIQUID_SIMD_NCO:           return "nco";
+    case LIQUID_SIMD_OFDM:          return "ofdm";
+    case LIQUID_SIMD_MATRIX:        return "matrix";
+    case LIQUID_SIMD_AUDIO:         return "audio";
+    case LIQUID_SIMD_SCRAMBLE:      return "scramble";
+    case LIQUID_SIMD_DOTPROD_F16:   return "dotprod_f16";
+    case LIQUID_SIMD_TRIG:          return "trig";
+    case LIQUID_SIMD_EQUALIZER:     return "equalizer";
+    default:;
+    }
+    return "unknown";
+}
+
+// get highest SIMD level supported by both the host cpu and this build
+liquid_simd_level liquid_simd_get_host_level(void)
+{
+    return liquid_simd_detect();
+}
+
+// get SIMD level currently used for dispatch
+liquid_simd_level liquid_simd_get_level(void)
+{
+    int level = __atomic_load_n(&liquid_simd_level_active, __ATOMIC_RELAXED);
+    if (level >= 0)
+        return (liquid_simd_level) level;
+
+    // resolve default level once; a level set concurrently through
+    // liquid_simd_set_level() takes precedence
+    int unset = -1;
+    level = liquid_simd_detect();
+    if (!__atomic_compare_exchange_n(&liquid_simd_level_active, &unset, level, 0,
+                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        level = unset;
+    return (liquid_simd_level) level;
+}
+
+// test whether kernels of SIMD level _level can run on this host: x86
+// builds carry portable, SSE and (if supported by the compiler) AVX
+// kernels side by side; other builds only provide the one set of
+// kernels chosen at configure time
+int liquid_simd_level_supported(liquid_simd_level _level)
+{
+    liquid_simd_level host = liquid_simd_detect();
+#if HAVE_DOTPROD_SSE
+    return _level <= host;
+#else
+    return _level == host;
+#endif
+}
+
+// set SIMD level used for dispatch, returning the level in effect
+liquid_simd_level liquid_simd_set_level(liquid_simd_level _level)
+{
+    if ((int)_level < 0 || _level >= LIQUID_SIMD_NUM_LEVELS) {
+        fprintf(stderr,"error: liquid_simd_set_level(), invalid level\n");
+        exit(1);
+    }
+
+    if (!liquid_simd_level_supported(_level)) {
+        fprintf(stderr,"warning: liquid_simd_set_level(), %s kernels not available (host: %s)\n",
+                liquid_simd_level_str(_level), liquid_simd_level_str(liquid_simd_detect()));
+        return liquid_simd_get_level();
+    }
+
+    __atomic_store_n(&liquid_simd_level_active, (int)_level, __ATOMIC_RELAXED);
+    return _level;
+}
+
+// get SIMD level of the kernel a family resolves to at the current
+// dispatch level
+liquid_simd_level liquid_simd_get_kernel(liquid_simd_family _family)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+
+    switch (_family) {
+    case LIQUID_SIMD_DOTPROD_RRRF:
+    case LIQUID_SIMD_DOTPROD_CRCF:
+        return level;
+    case LIQUID_SIMD_DOTPROD_CCCF:
+    case LIQUID_SIMD_SUMSQ:
+    case LIQUID_SIMD_FFT:
+    case LIQUID_SIMD_SPGRAM:
+        // no AltiVec kernels
+        return level == LIQUID_SIMD_ALTIVEC ? LIQUID_SIMD_PORTABLE : level;
+    case LIQUID_SIMD_DOTPROD_BLOCK:
+        // wide x86 kernels only
+        return level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F ? level : LIQUID_SIMD_PORTABLE;
+    case LIQUID_SIMD_DOTPROD_BATCH:
+        // shared-input kernels (real coefficients) only; AVX2 kernels
+        // serve both wide x86 levels
+        return level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F ? LIQUID_SIMD_AVX2 : LIQUID_SIMD_PORTABLE;
+    case LIQUID_SIMD_VITERBI:
+    case LIQUID_SIMD_VECTOR:
+    case LIQUID_SIMD_MATRIX:
+        // AVX-512F level uses the AVX2 kernel; no AltiVec kernel
+        if (level == LIQUID_SIMD_AVX512F)
+            return LIQUID_SIMD_AVX2;
+        return level == LIQUID_SIMD_ALTIVEC ? LIQUID_SIMD_PORTABLE : level;
+    case LIQUID_SIMD_MODEM:
+    case LIQUID_SIMD_NCO:
+    case LIQUID_SIMD_OFDM:
+    case LIQUID_SIMD_AUDIO:
+    case LIQUID_SIMD_SCRAMBLE:
+    case LIQUID_SIMD_DOTPROD_F16:
+    case LIQUID_SIMD_TRIG:
+    case LIQUID_SIMD_EQUALIZER:
+        // AVX2 kernels serve both wide x86 levels
+        return level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F ? LIQUID_SIMD_AVX2 : LIQUID_SIMD_PORTABLE;
+    case LIQUID_SIMD_DOTPROD_Q16:
+        // SSE2 kernels serve all x86 levels; no AltiVec kernels
+        if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F)
+            return LIQUID_SIMD_SSE;
+        return level == LIQUID_SIMD_ALTIVEC ? LIQUID_SIMD_PORTABLE : level;
+    default:;
+    }
+
+    fprintf(stderr,"error: liquid_simd_get_kernel(), invalid family\n");
+    exit(1);
+    return LIQUID_SIMD_PORTABLE;
+}
+
+// print host level, dispatch level and resolved kernel of each family
+void liquid_simd_print(void)
+{
+    printf("simd [host: %s, dispatch: %s]\n",
+            liquid_simd_level_str(liquid_simd_get_host_level()),
+            liquid_simd_level_str(liquid_simd_get_level()));
+
+    unsigned int i;
+    for (i=0; i<LIQUID_SIMD_NUM_FAMILIES; i++) {
+        printf("  %-16s: %s\n",
+                liquid_simd_family_str((liquid_simd_family)i),
+                liquid_simd_level_str(liquid_simd_get_kernel((liquid_simd_family)i)));
+    }
+}
+
+// allocate memory aligned to LIQUID_SIMD_ALIGNMENT; the block is
+// taken from the library allocator with room for alignment, and the
+// original pointer is kept just ahead of the aligned address
+void * liquid_malloc_aligned(size_t _size)
+{
+    unsigned char * p = (unsigned char*) liquid_malloc(_size + LIQUID_SIMD_ALIGNMENT + sizeof(void*));
+    uintptr_t a = ((uintptr_t)(p + sizeof(void*)) + LIQUID_SIMD_ALIGNMENT - 1) &
+                  ~(uintptr_t)(LIQUID_SIMD_ALIGNMENT - 1);
+    ((void**)a)[-1] = p;
+    return (void*)a;
+}
+
+// free memory allocated with liquid_malloc_aligned()
+void liquid_free_aligned(void * _ptr)
+{
+    if (_ptr != NULL)
+        liquid_free(((void**)_ptr)[-1]);
+}
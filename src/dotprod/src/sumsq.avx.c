@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// sumsq.avx.c : floating-point sum of squares (AVX2/FMA, AVX-512F)
+//
+// These kernels are compiled with per-function target attributes and
+// are selected at run time by the methods in sumsq.mmx.c. The peak
+// variants additionally track the maximum squared magnitude; for
+// complex input adjacent (real,imag) lanes are summed before the
+// comparison.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// mask selecting the first _r lanes of an AVX2 register, _r <= 8
+__attribute__((target("avx2,fma")))
+static __m256i sumsq_mask_avx2(unsigned int _r)
+{
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(_r),
+                              _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+}
+
+// horizontal sum of AVX2 register
+__attribute__((target("avx2,fma")))
+static float sumsq_hsum_avx2(__m256 _v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(_v), _mm256_extractf128_ps(_v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+// horizontal maximum of AVX2 register
+__attribute__((target("avx2,fma")))
+static float sumsq_hmax_avx2(__m256 _v)
+{
+    __m128 s = _mm_max_ps(_mm256_castps256_ps128(_v), _mm256_extractf128_ps(_v, 1));
+    s = _mm_max_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_max_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+// sum squares (AVX2/FMA)
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length
+__attribute__((target("avx2,fma")))
+float liquid_sumsqf_avx2(float *      _v,
+                         unsigned int _n)
+{
+    __m256 s0 = _mm256_setzero_ps();
+    __m256 s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps();
+    __m256 s3 = _mm256_setzero_ps();
+    __m256 v0, v1, v2, v3;
+
+    // t = 32*floor(_n/32)
+    unsigned int t = (_n >> 5) << 5;
+
+    unsigned int i;
+    for (i=0; i<t; i+=32) {
+        v0 = _mm256_loadu_ps(&_v[i   ]);
+        v1 = _mm256_loadu_ps(&_v[i+ 8]);
+        v2 = _mm256_loadu_ps(&_v[i+16]);
+        v3 = _mm256_loadu_ps(&_v[i+24]);
+        s0 = _mm256_fmadd_ps(v0, v0, s0);
+        s1 = _mm256_fmadd_ps(v1, v1, s1);
+        s2 = _mm256_fmadd_ps(v2, v2, s2);
+        s3 = _mm256_fmadd_ps(v3, v3, s3);
+    }
+
+    // remaining samples in groups of 8, last group masked
+    for ( ; i<_n; i+=8) {
+        v0 = _mm256_maskload_ps(&_v[i], sumsq_mask_avx2(_n-i < 8 ? _n-i : 8));
+        s0 = _mm256_fmadd_ps(v0, v0, s0);
+    }
+
+    // fold down into single value
+    s0 = _mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3));
+    return sumsq_hsum_avx2(s0);
+}
+
+// sum squares (AVX-512F)
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length
+__attribute__((target("avx512f")))
+float liquid_sumsqf_avx512f(float *      _v,
+                            unsigned int _n)
+{
+    __m512 s0 = _mm512_setzero_ps();
+    __m512 s1 = _mm512_setzero_ps();
+    __m512 s2 = _mm512_setzero_ps();
+    __m512 s3 = _mm512_setzero_ps();
+    __m512 v0, v1, v2, v3;
+
+    // t = 64*floor(_n/64)
+    unsigned int t = (_n >> 6) << 6;
+
+    unsigned int i;
+    for (i=0; i<t; i+=64) {
+        v0 = _mm512_loadu_ps(&_v[i   ]);
+        v1 = _mm512_loadu_ps(&_v[i+16]);
+        v2 = _mm512_loadu_ps(&_v[i+32]);
+        v3 = _mm512_loadu_ps(&_v[i+48]);
+        s0 = _mm512_fmadd_ps(v0, v0, s0);
+        s1 = _mm512_fmadd_ps(v1, v1, s1);
+        s2 = _mm512_fmadd_ps(v2, v2, s2);
+        s3 = _mm512_fmadd_ps(v3, v3, s3);
+    }
+
+    // remaining samples in groups of 16, last group masked
+    for ( ; i<_n; i+=16) {
+        unsigned int r = _n-i < 16 ? _n-i : 16;
+        v0 = _mm512_maskz_loadu_ps((__mmask16)((1u << r) - 1), &_v[i]);
+        s0 = _mm512_fmadd_ps(v0, v0, s0);
+    }
+
+    // fold down into single value
+    s0 = _mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3));
+    return _mm512_reduce_add_ps(s0);
+}
+
+// sum squares and peak squared magnitude (AVX2/FMA)
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length (number of floats)
+//  _pair   :   treat adjacent values as (real,imag) pairs?
+//  _peak2  :   output peak squared magnitude
+__attribute__((target("avx2,fma")))
+float liquid_sumsq_peak_avx2(float *      _v,
+                             unsigned int _n,
+                             int          _pair,
+                             float *      _peak2)
+{
+    __m256 s0 = _mm256_setzero_ps();
+    __m256 s1 = _mm256_setzero_ps();
+    __m256 p0 = _mm256_setzero_ps();
+    __m256 p1 = _mm256_setzero_ps();
+    __m256 v0, v1;
+
+    // t = 16*floor(_n/16)
+    unsigned int t = (_n >> 4) << 4;
+
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        v0 = _mm256_loadu_ps(&_v[i  ]);
+        v1 = _mm256_loadu_ps(&_v[i+8]);
+        v0 = _mm256_mul_ps(v0, v0);
+        v1 = _mm256_mul_ps(v1, v1);
+        s0 = _mm256_add_ps(s0, v0);
+        s1 = _mm256_add_ps(s1, v1);
+        if (_pair) {
+            v0 = _mm256_add_ps(v0, _mm256_permute_ps(v0, 0xb1));
+            v1 = _mm256_add_ps(v1, _mm256_permute_ps(v1, 0xb1));
+        }
+        p0 = _mm256_max_ps(p0, v0);
+        p1 = _mm256_max_ps(p1, v1);
+    }
+
+    // remaining samples in groups of 8, last group masked (zeros
+    // affect neither the sum nor the peak)
+    for ( ; i<_n; i+=8) {
+        v0 = _mm256_maskload_ps(&_v[i], sumsq_mask_avx2(_n-i < 8 ? _n-i : 8));
+        v0 = _mm256_mul_ps(v0, v0);
+        s0 = _mm256_add_ps(s0, v0);
+        if (_pair)
+            v0 = _mm256_add_ps(v0, _mm256_permute_ps(v0, 0xb1));
+        p0 = _mm256_max_ps(p0, v0);
+    }
+
+    *_peak2 = sumsq_hmax_avx2(_mm256_max_ps(p0, p1));
+    return sumsq_hsum_avx2(_mm256_add_ps(s0, s1));
+}
+
+// sum squares and peak squared magnitude (AVX-512F)
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length (number of floats)
+//  _pair   :   treat adjacent values as (real,imag) pairs?
+//  _peak2  :   output peak squared magnitude
+__attribute__((target("avx512f")))
+float liquid_sumsq_peak_avx512f(float *      _v,
+                                unsigned int _n,
+                                int          _pair,
+                                float *      _peak2)
+{
+    __m512 s0 = _mm512_setzero_ps();
+    __m512 s1 = _mm512_setzero_ps();
+    __m512 p0 = _mm512_setzero_ps();
+    __m512 p1 = _mm512_setzero_ps();
+    __m512 v0, v1;
+
+    // t = 32*floor(_n/32)
+    unsigned int t = (_n >> 5) << 5;
+
+    unsigned int i;
+    for (i=0; i<t; i+=32) {
+        v0 = _mm512_loadu_ps(&_v[i   ]);
+        v1 = _mm512_loadu_ps(&_v[i+16]);
+        v0 = _mm512_mul_ps(v0, v0);
+        v1 = _mm512_mul_ps(v1, v1);
+        s0 = _mm512_add_ps(s0, v0);
+        s1 = _mm512_add_ps(s1, v1);
+        if (_pair) {
+            v0 = _mm512_add_ps(v0, _mm512_permute_ps(v0, 0xb1));
+            v1 = _mm512_add_ps(v1, _mm512_permute_ps(v1, 0xb1));
+        }
+        p0 = _mm512_max_ps(p0, v0);
+        p1 = _mm512_max_ps(p1, v1);
+    }
+
+    // remaining samples in groups of 16, last group masked
+    for ( ; i<_n; i+=16) {
+        unsigned int r = _n-i < 16 ? _n-i : 16;
+        v0 = _mm512_maskz_loadu_ps((__mmask16)((1u << r) - 1), &_v[i]);
+        v0 = _mm512_mul_ps(v0, v0);
+        s0 = _mm512_add_ps(s0, v0);
+        if (_pair)
+            v0 = _mm512_add_ps(v0, _mm512_permute_ps(v0, 0xb1));
+        p0 = _mm512_max_ps(p0, v0);
+    }
+
+    *_peak2 = _mm512_reduce_max_ps(_mm512_max_ps(p0, p1));
+    return _mm512_reduce_add_ps(_mm512_add_ps(s0, s1));
+}
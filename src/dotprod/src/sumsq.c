@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 #include "liquid.internal.h"
 
@@ -71,3 +72,51 @@ float liquid_sumsqcf(float complex * _v,
     return liquid_sumsqf(v, 2*_n);
 }
 
+
+// sum squares and peak magnitude
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+//  _peak   :   output peak magnitude
+float liquid_sumsqf_peak(float *      _v,
+                         unsigned int _n,
+                         float *      _peak)
+{
+    // initialize accumulator, peak squared magnitude
+    float r=0;
+    float p=0;
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float v2 = _v[i] * _v[i];
+        r += v2;
+        if (v2 > p) p = v2;
+    }
+
+    // set output values
+    *_peak = sqrtf(p);
+    return r;
+}
+
+// sum squares and peak magnitude
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+//  _peak   :   output peak magnitude
+float liquid_sumsqcf_peak(float complex * _v,
+                          unsigned int    _n,
+                          float *         _peak)
+{
+    // initialize accumulator, peak squared magnitude
+    float r=0;
+    float p=0;
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float v2 = crealf(_v[i])*crealf(_v[i]) + cimagf(_v[i])*cimagf(_v[i]);
+        r += v2;
+        if (v2 > p) p = v2;
+    }
+
+    // set output values
+    *_peak = sqrtf(p);
+    return r;
+}
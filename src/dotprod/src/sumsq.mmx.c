@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 #include "liquid.internal.h"
 
@@ -49,12 +50,57 @@
 #include <pmmintrin.h>  // SSE3
 #endif
 
+// sum squares, portable C (selected with liquid_simd_set_level())
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+static float liquid_sumsqf_portable(float *      _v,
+                                    unsigned int _n)
+{
+    float r = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += _v[i] * _v[i];
+    return r;
+}
+
+// sum squares and peak squared magnitude, portable C
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length (number of floats)
+//  _pair   :   treat adjacent values as (real,imag) pairs?
+//  _peak2  :   output peak squared magnitude
+static float liquid_sumsq_peak_portable(float *      _v,
+                                        unsigned int _n,
+                                        int          _pair,
+                                        float *      _peak2)
+{
+    float r = 0;
+    float p = 0;
+    unsigned int i;
+    for (i=0; i<_n; i += _pair ? 2 : 1) {
+        float v2 = _pair ? _v[i]*_v[i] + _v[i+1]*_v[i+1] : _v[i]*_v[i];
+        r += v2;
+        p = v2 > p ? v2 : p;
+    }
+    *_peak2 = p;
+    return r;
+}
+
 // sum squares, basic loop
 //  _v      :   input array [size: 1 x _n]
 //  _n      :   input length
 float liquid_sumsqf(float *      _v,
                     unsigned int _n)
 {
+    // run-time dispatch
+    switch (liquid_simd_get_level()) {
+#if HAVE_DOTPROD_AVX
+    case LIQUID_SIMD_AVX512F: return liquid_sumsqf_avx512f(_v, _n);
+    case LIQUID_SIMD_AVX2:    return liquid_sumsqf_avx2(_v, _n);
+#endif
+    case LIQUID_SIMD_PORTABLE: return liquid_sumsqf_portable(_v, _n);
+    default:;
+    }
+
     // first cut: ...
     __m128 v;   // input vector
     __m128 s;   // dot product
@@ -113,3 +159,96 @@ float liquid_sumsqcf(float complex * _v,
     float * v = (float*) _v;
     return liquid_sumsqf(v, 2*_n);
 }
+
+// sum squares and peak squared magnitude
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length (number of floats)
+//  _pair   :   treat adjacent values as (real,imag) pairs?
+//  _peak2  :   output peak squared magnitude
+static float liquid_sumsq_peak(float *      _v,
+                                   unsigned int _n,
+                                   int          _pair,
+                                   float *      _peak2)
+{
+    // run-time dispatch
+    switch (liquid_simd_get_level()) {
+#if HAVE_DOTPROD_AVX
+    case LIQUID_SIMD_AVX512F: return liquid_sumsq_peak_avx512f(_v, _n, _pair, _peak2);
+    case LIQUID_SIMD_AVX2:    return liquid_sumsq_peak_avx2(_v, _n, _pair, _peak2);
+#endif
+    case LIQUID_SIMD_PORTABLE: return liquid_sumsq_peak_portable(_v, _n, _pair, _peak2);
+    default:;
+    }
+
+    __m128 v;                       // input vector
+    __m128 sum  = _mm_setzero_ps(); // sum of squares
+    __m128 peak = _mm_setzero_ps(); // peak squared magnitude
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // load inputs into register (unaligned) and square
+        v = _mm_loadu_ps(&_v[i]);
+        v = _mm_mul_ps(v, v);
+
+        // accumulate
+        sum = _mm_add_ps(sum, v);
+
+        // combine (real,imag) pairs and track maximum
+        if (_pair)
+            v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2,3,0,1)));
+        peak = _mm_max_ps(peak, v);
+    }
+
+    // unload packed arrays
+    float w[4] __attribute__((aligned(16)));
+    float p[4] __attribute__((aligned(16)));
+    _mm_store_ps(w, sum);
+    _mm_store_ps(p, peak);
+    float total = w[0] + w[1] + w[2] + w[3];
+    float peak2 = p[0];
+    for (t=1; t<4; t++)
+        peak2 = p[t] > peak2 ? p[t] : peak2;
+
+    // cleanup (at most one remaining pair for complex input)
+    for (; i<_n; i += _pair ? 2 : 1) {
+        float v2 = _pair ? _v[i]*_v[i] + _v[i+1]*_v[i+1] : _v[i]*_v[i];
+        total += v2;
+        peak2 = v2 > peak2 ? v2 : peak2;
+    }
+
+    // set return values
+    *_peak2 = peak2;
+    return total;
+}
+
+// sum squares and peak magnitude
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+//  _peak   :   output peak magnitude
+float liquid_sumsqf_peak(float *      _v,
+                         unsigned int _n,
+                         float *      _peak)
+{
+    float peak2;
+    float r = liquid_sumsq_peak(_v, _n, 0, &peak2);
+    *_peak = sqrtf(peak2);
+    return r;
+}
+
+// sum squares and peak magnitude
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+//  _peak   :   output peak magnitude
+float liquid_sumsqcf_peak(float complex * _v,
+                          unsigned int    _n,
+                          float *         _peak)
+{
+    // type cast input as real pointer, pairing adjacent values
+    float peak2;
+    float r = liquid_sumsq_peak((float*)_v, 2*_n, 1, &peak2);
+    *_peak = sqrtf(peak2);
+    return r;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// sumsq.neon.c : floating-point sum of squares (ARM Neon)
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+// sum squares, basic loop
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+float liquid_sumsqf(float *      _v,
+                    unsigned int _n)
+{
+    float32x4_t v0, v1;
+    float32x4_t sum0 = vdupq_n_f32(0.0f);
+    float32x4_t sum1 = vdupq_n_f32(0.0f);
+
+    // t = 8*(floor(_n/8))
+    unsigned int t = (_n >> 3) << 3;
+
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        // load inputs into register (unaligned)
+        v0 = vld1q_f32(&_v[i  ]);
+        v1 = vld1q_f32(&_v[i+4]);
+
+        // multiply and accumulate
+        sum0 = vmlaq_f32(sum0, v0, v0);
+        sum1 = vmlaq_f32(sum1, v1, v1);
+    }
+
+    // fold down into single value
+    sum0 = vaddq_f32(sum0, sum1);
+    float32x2_t s = vadd_f32(vget_low_f32(sum0), vget_high_f32(sum0));
+    float total = vget_lane_f32(s, 0) + vget_lane_f32(s, 1);
+
+    // cleanup
+    for (; i<_n; i++)
+        total += _v[i] * _v[i];
+
+    // set return value
+    return total;
+}
+
+// sum squares, basic loop
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+float liquid_sumsqcf(float complex * _v,
+                     unsigned int    _n)
+{
+    // simple method: type cast input as real pointer, run double
+    // length sumsqf method
+    float * v = (float*) _v;
+    return liquid_sumsqf(v, 2*_n);
+}
+
+// sum squares and peak squared magnitude
+//  _v      :   input array [size: _n x 1]
+//  _n      :   input length (number of floats)
+//  _pair   :   treat adjacent values as (real,imag) pairs?
+//  _peak2  :   output peak squared magnitude
+static float liquid_sumsq_peak(float *      _v,
+                               unsigned int _n,
+                               int          _pair,
+                               float *      _peak2)
+{
+    float32x4_t v;                          // input vector
+    float32x4_t sum  = vdupq_n_f32(0.0f);   // sum of squares
+    float32x4_t peak = vdupq_n_f32(0.0f);   // peak squared magnitude
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // load inputs into register (unaligned) and square
+        v = vld1q_f32(&_v[i]);
+        v = vmulq_f32(v, v);
+
+        // accumulate
+        sum = vaddq_f32(sum, v);
+
+        // combine (real,imag) pairs and track maximum
+        if (_pair)
+            v = vaddq_f32(v, vrev64q_f32(v));
+        peak = vmaxq_f32(peak, v);
+    }
+
+    // fold down into single values
+    float32x2_t s = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    float32x2_t p = vmax_f32(vget_low_f32(peak), vget_high_f32(peak));
+    s = vpadd_f32(s, s);
+    p = vpmax_f32(p, p);
+    float total = vget_lane_f32(s, 0);
+    float peak2 = vget_lane_f32(p, 0);
+
+    // cleanup (at most one remaining pair for complex input)
+    for (; i<_n; i += _pair ? 2 : 1) {
+        float v2 = _pair ? _v[i]*_v[i] + _v[i+1]*_v[i+1] : _v[i]*_v[i];
+        total += v2;
+        peak2 = v2 > peak2 ? v2 : peak2;
+    }
+
+    // set return values
+    *_peak2 = peak2;
+    return total;
+}
+
+// sum squares and peak magnitude
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+//  _peak   :   output peak magnitude
+float liquid_sumsqf_peak(float *      _v,
+                         unsigned int _n,
+                         float *      _peak)
+{
+    float peak2;
+    float r = liquid_sumsq_peak(_v, _n, 0, &peak2);
+    *_peak = sqrtf(peak2);
+    return r;
+}
+
+// sum squares and peak magnitude
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+//  _peak   :   output peak magnitude
+float liquid_sumsqcf_peak(float complex * _v,
+                          unsigned int    _n,
+                          float *         _peak)
+{
+    // type cast input as real pointer, pairing adjacent values
+    float peak2;
+    float r = liquid_sumsq_peak((float*)_v, 2*_n, 1, &peak2);
+    *_peak = sqrtf(peak2);
+    return r;
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// 
+// AUTOTEST: batched dot product compared against individual objects
+//
+
+// helper function
+//  _n      :   length of each dot product
+//  _num    :   number of dot products in batch
+void runtest_dotprod_batch_rrrf(unsigned int _n,
+                                unsigned int _num)
+{
+    float tol = 1e-4;
+    float h[_num*_n];
+    float x[_num*_n];
+    float * xp[_num];
+
+    unsigned int i, j;
+    for (i=0; i<_num*_n; i++) {
+        h[i] = randnf();
+        x[i] = randnf();
+    }
+    for (j=0; j<_num; j++)
+        xp[j] = &x[j*_n];
+
+    // execute batch
+    float y[_num];
+    dotprod_rrrf_batch q = dotprod_rrrf_batch_create(h, _n, _num);
+    dotprod_rrrf_execute_batch(q, xp, y);
+    dotprod_rrrf_batch_destroy(q);
+
+    // compare to ordinal computation
+    for (j=0; j<_num; j++) {
+        float y_test;
+        dotprod_rrrf_run(&h[j*_n], xp[j], _n, &y_test);
+        CONTEND_DELTA(y[j], y_test, tol);
+    }
+}
+
+void runtest_dotprod_batch_crcf(unsigned int _n,
+                                unsigned int _num)
+{
+    float tol = 1e-4;
+    float h[_num*_n];
+    float complex x[_num*_n];
+    float complex * xp[_num];
+
+    unsigned int i, j;
+    for (i=0; i<_num*_n; i++) {
+        h[i] = randnf();
+        x[i] = randnf() + randnf()*_Complex_I;
+    }
+    // use same input for several dot products
+    for (j=0; j<_num; j++)
+        xp[j] = &x[(j/2)*_n];
+
+    // execute batch
+    float complex y[_num];
+    dotprod_crcf_batch q = dotprod_crcf_batch_create(h, _n, _num);
+    dotprod_crcf_execute_batch(q, xp, y);
+    dotprod_crcf_batch_destroy(q);
+
+    // compare to ordinal computation
+    for (j=0; j<_num; j++) {
+        float complex y_test;
+        dotprod_crcf_run(&h[j*_n], xp[j], _n, &y_test);
+        CONTEND_DELTA(crealf(y[j]), crealf(y_test), tol);
+        CONTEND_DELTA(cimagf(y[j]), cimagf(y_test), tol);
+    }
+}
+
+void runtest_dotprod_batch_cccf(unsigned int _n,
+                                unsigned int _num)
+{
+    float tol = 1e-4;
+    float complex h[_num*_n];
+    float complex x[_num*_n];
+    float complex * xp[_num];
+
+    unsigned int i, j;
+    for (i=0; i<_num*_n; i++) {
+        h[i] = randnf() + randnf()*_Complex_I;
+        x[i] = randnf() + randnf()*_Complex_I;
+    }
+    for (j=0; j<_num; j++)
+        xp[j] = &x[j*_n];
+
+    // execute batch
+    float complex y[_num];
+    dotprod_cccf_batch q = dotprod_cccf_batch_create(h, _n, _num);
+    dotprod_cccf_execute_batch(q, xp, y);
+    dotprod_cccf_batch_destroy(q);
+
+    // compare to ordinal computation
+    for (j=0; j<_num; j++) {
+        float complex y_test;
+        dotprod_cccf_run(&h[j*_n], xp[j], _n, &y_test);
+        CONTEND_DELTA(crealf(y[j]), crealf(y_test), tol);
+        CONTEND_DELTA(cimagf(y[j]), cimagf(y_test), tol);
+    }
+}
+
+void autotest_dotprod_batch_rrrf_n1()   { runtest_dotprod_batch_rrrf( 1,  1); }
+void autotest_dotprod_batch_rrrf_n7()   { runtest_dotprod_batch_rrrf( 7,  5); }
+void autotest_dotprod_batch_rrrf_n32()  { runtest_dotprod_batch_rrrf(32, 64); }
+
+void autotest_dotprod_batch_crcf_n1()   { runtest_dotprod_batch_crcf( 1,  3); }
+void autotest_dotprod_batch_crcf_n7()   { runtest_dotprod_batch_crcf( 7,  6); }
+void autotest_dotprod_batch_crcf_n32()  { runtest_dotprod_batch_crcf(32, 64); }
+
+void autotest_dotprod_batch_cccf_n1()   { runtest_dotprod_batch_cccf( 1,  2); }
+void autotest_dotprod_batch_cccf_n7()   { runtest_dotprod_batch_cccf( 7,  9); }
+void autotest_dotprod_batch_cccf_n32()  { runtest_dotprod_batch_cccf(32, 64); }
+
+
+// 
+// AUTOTEST: batched dot product on shared input at each available
+// SIMD level, compared against individual dot products
+//
+
+// helper function
+//  _n      :   length of each dot product
+//  _num    :   number of dot products in batch
+void runtest_dotprod_batch_shared(unsigned int _n,
+                                  unsigned int _num)
+{
+    float tol = 1e-4;
+    float         hr[_num*_n];
+    float complex hc[_num*_n];
+    float         xr[_n];
+    float complex xc[_n];
+    unsigned int i, j;
+    for (i=0; i<_num*_n; i++) {
+        hr[i] = randnf();
+        hc[i] = randnf() + randnf()*_Complex_I;
+    }
+    for (i=0; i<_n; i++) {
+        xr[i] = randnf();
+        xc[i] = randnf() + randnf()*_Complex_I;
+    }
+
+    liquid_simd_level level = liquid_simd_get_level();
+    int l;
+    for (l=0; l<LIQUID_SIMD_NUM_LEVELS; l++) {
+        if (!liquid_simd_level_supported((liquid_simd_level)l))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)l);
+
+        float         yr[_num];
+        float complex yc[_num];
+        float complex yz[_num];
+        dotprod_rrrf_batch qr = dotprod_rrrf_batch_create(hr, _n, _num);
+        dotprod_crcf_batch qc = dotprod_crcf_batch_create(hr, _n, _num);
+        dotprod_cccf_batch qz = dotprod_cccf_batch_create(hc, _n, _num);
+        dotprod_rrrf_execute_batch_shared(qr, xr, yr);
+        dotprod_crcf_execute_batch_shared(qc, xc, yc);
+        dotprod_cccf_execute_batch_shared(qz, xc, yz);
+        dotprod_rrrf_batch_destroy(qr);
+        dotprod_crcf_batch_destroy(qc);
+        dotprod_cccf_batch_destroy(qz);
+
+        for (j=0; j<_num; j++) {
+            float         vr;
+            float complex vc, vz;
+            dotprod_rrrf_run(&hr[j*_n], xr, _n, &vr);
+            dotprod_crcf_run(&hr[j*_n], xc, _n, &vc);
+            dotprod_cccf_run(&hc[j*_n], xc, _n, &vz);
+            CONTEND_DELTA(yr[j], vr, tol);
+            CONTEND_DELTA(crealf(yc[j]), crealf(vc), tol);
+            CONTEND_DELTA(cimagf(yc[j]), cimagf(vc), tol);
+            CONTEND_DELTA(crealf(yz[j]), crealf(vz), tol);
+            CONTEND_DELTA(cimagf(yz[j]), cimagf(vz), tol);
+        }
+    }
+    liquid_simd_set_level(level);
+}
+
+void autotest_dotprod_batch_shared_n1()  { runtest_dotprod_batch_shared( 1,  1); }
+void autotest_dotprod_batch_shared_n5()  { runtest_dotprod_batch_shared( 5,  3); }
+void autotest_dotprod_batch_shared_n13() { runtest_dotprod_batch_shared(13,  8); }
+void autotest_dotprod_batch_shared_n32() { runtest_dotprod_batch_shared(32, 13); }
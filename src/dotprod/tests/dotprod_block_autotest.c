@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// 
+// AUTOTEST: block dot product compared against ordinal computation
+//
+
+// helper function
+//  _n      :   dot product length
+//  _stride :   input offset between consecutive outputs
+//  _num    :   number of outputs
+void runtest_dotprod_block_crcf(unsigned int _n,
+                                unsigned int _stride,
+                                unsigned int _num)
+{
+    float tol = 1e-4;
+    unsigned int nx = (_num-1)*_stride + _n;
+    float h[_n];
+    float complex x[nx];
+
+    unsigned int i;
+    for (i=0; i<_n; i++) h[i] = randnf();
+    for (i=0; i<nx; i++) x[i] = randnf() + randnf()*_Complex_I;
+
+    // run block
+    float complex y[_num];
+    dotprod_crcf_run_block(h, _n, x, _stride, _num, y);
+
+    // compare to ordinal computation
+    for (i=0; i<_num; i++) {
+        float complex y_test;
+        dotprod_crcf_run(h, &x[i*_stride], _n, &y_test);
+        CONTEND_DELTA(crealf(y[i]), crealf(y_test), tol);
+        CONTEND_DELTA(cimagf(y[i]), cimagf(y_test), tol);
+    }
+}
+
+void runtest_dotprod_block_rrrf(unsigned int _n,
+                                unsigned int _stride,
+                                unsigned int _num)
+{
+    float tol = 1e-4;
+    unsigned int nx = (_num-1)*_stride + _n;
+    float h[_n];
+    float x[nx];
+
+    unsigned int i;
+    for (i=0; i<_n; i++) h[i] = randnf();
+    for (i=0; i<nx; i++) x[i] = randnf();
+
+    // run block
+    float y[_num];
+    dotprod_rrrf_run_block(h, _n, x, _stride, _num, y);
+
+    // compare to ordinal computation
+    for (i=0; i<_num; i++) {
+        float y_test;
+        dotprod_rrrf_run(h, &x[i*_stride], _n, &y_test);
+        CONTEND_DELTA(y[i], y_test, tol);
+    }
+}
+
+void runtest_dotprod_block_cccf(unsigned int _n,
+                                unsigned int _stride,
+                                unsigned int _num)
+{
+    float tol = 1e-4;
+    unsigned int nx = (_num-1)*_stride + _n;
+    float complex h[_n];
+    float complex x[nx];
+
+    unsigned int i;
+    for (i=0; i<_n; i++) h[i] = randnf() + randnf()*_Complex_I;
+    for (i=0; i<nx; i++) x[i] = randnf() + randnf()*_Complex_I;
+
+    // run block
+    float complex y[_num];
+    dotprod_cccf_run_block(h, _n, x, _stride, _num, y);
+
+    // compare to ordinal computation
+    for (i=0; i<_num; i++) {
+        float complex y_test;
+        dotprod_cccf_run(h, &x[i*_stride], _n, &y_test);
+        CONTEND_DELTA(crealf(y[i]), crealf(y_test), tol);
+        CONTEND_DELTA(cimagf(y[i]), cimagf(y_test), tol);
+    }
+}
+
+void autotest_dotprod_block_rrrf_s1()   { runtest_dotprod_block_rrrf(13, 1, 37); }
+void autotest_dotprod_block_rrrf_s1_long() { runtest_dotprod_block_rrrf(57, 1, 75); }
+void autotest_dotprod_block_rrrf_s3()   { runtest_dotprod_block_rrrf(21, 3, 11); }
+void autotest_dotprod_block_crcf_s1()   { runtest_dotprod_block_crcf(32, 1, 64); }
+void autotest_dotprod_block_crcf_s1_long() { runtest_dotprod_block_crcf(45, 1, 45); }
+void autotest_dotprod_block_crcf_s4()   { runtest_dotprod_block_crcf( 7, 4,  6); }
+void autotest_dotprod_block_cccf_s1()   { runtest_dotprod_block_cccf( 1, 1,  3); }
+void autotest_dotprod_block_cccf_s1_long() { runtest_dotprod_block_cccf(40, 1, 35); }
+void autotest_dotprod_block_cccf_s2()   { runtest_dotprod_block_cccf(17, 2, 19); }
+
@@ -220,3 +220,69 @@ void autotest_dotprod_cccf_struct_vs_ordinal()
         runtest_dotprod_cccf(i);
 }
 
+// update coefficients in place and re-create with same length;
+// both must match a freshly created object
+void autotest_dotprod_cccf_update_coefficients()
+{
+    float tol = 1e-3;
+    unsigned int n = 37;
+    float complex h0[n], h1[n], h2[n];
+    float complex x[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        h0[i] = randnf() + randnf() * _Complex_I;
+        h1[i] = randnf() + randnf() * _Complex_I;
+        h2[i] = randnf() + randnf() * _Complex_I;
+        x[i]  = randnf() + randnf() * _Complex_I;
+    }
+
+    float complex y, y_test, y_test2;
+    dotprod_cccf_run(h1, x, n, &y_test);
+    dotprod_cccf_run(h2, x, n, &y_test2);
+
+    // overwrite coefficients
+    dotprod_cccf dp = dotprod_cccf_create(h0, n);
+    dotprod_cccf_update_coefficients(dp, h1);
+    dotprod_cccf_execute(dp, x, &y);
+    CONTEND_DELTA(crealf(y), crealf(y_test), tol);
+    CONTEND_DELTA(cimagf(y), cimagf(y_test), tol);
+
+    // re-create with same length returns same object
+    dotprod_cccf dp2 = dotprod_cccf_recreate(dp, h2, n);
+    CONTEND_EQUALITY(dp2 == dp, 1);
+    dotprod_cccf_execute(dp2, x, &y);
+    CONTEND_DELTA(crealf(y), crealf(y_test2), tol);
+    CONTEND_DELTA(cimagf(y), cimagf(y_test2), tol);
+
+    dotprod_cccf_destroy(dp2);
+}
+
+// split-complex dot products against interleaved dot products
+void autotest_dotprod_cccf_run_split()
+{
+    float tol = 1e-4f;
+    unsigned int lengths[] = {1, 7, 8, 16, 31, 100};
+    unsigned int i, k;
+    for (k=0; k<6; k++) {
+        unsigned int n = lengths[k];
+        float complex h[n], x[n], y0, y1;
+        float hr[n], hi[n], xr[n], xi[n];
+        for (i=0; i<n; i++) {
+            h[i] = randnf() + _Complex_I*randnf();
+            x[i] = randnf() + _Complex_I*randnf();
+        }
+        liquid_vectorcf_split(h, n, hr, hi);
+        liquid_vectorcf_split(x, n, xr, xi);
+
+        dotprod_cccf_run(h, x, n, &y0);
+        dotprod_cccf_run_split(hr, hi, xr, xi, n, &y1);
+        CONTEND_DELTA(crealf(y1), crealf(y0), tol);
+        CONTEND_DELTA(cimagf(y1), cimagf(y0), tol);
+
+        dotprod_crcf_run(hr, x, n, &y0);
+        dotprod_crcf_run_split(hr, xr, xi, n, &y1);
+        CONTEND_DELTA(crealf(y1), crealf(y0), tol);
+        CONTEND_DELTA(cimagf(y1), cimagf(y0), tol);
+    }
+}
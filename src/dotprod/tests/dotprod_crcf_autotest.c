@@ -165,3 +165,40 @@ void autotest_dotprod_crcf_struct_vs_ordinal()
         runtest_dotprod_crcf(i);
 }
 
+// update coefficients in place and re-create with same length;
+// both must match a freshly created object
+void autotest_dotprod_crcf_update_coefficients()
+{
+    float tol = 1e-3;
+    unsigned int n = 37;
+    float h0[n], h1[n], h2[n];
+    float complex x[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        h0[i] = randnf();
+        h1[i] = randnf();
+        h2[i] = randnf();
+        x[i]  = randnf() + randnf() * _Complex_I;
+    }
+
+    float complex y, y_test, y_test2;
+    dotprod_crcf_run(h1, x, n, &y_test);
+    dotprod_crcf_run(h2, x, n, &y_test2);
+
+    // overwrite coefficients
+    dotprod_crcf dp = dotprod_crcf_create(h0, n);
+    dotprod_crcf_update_coefficients(dp, h1);
+    dotprod_crcf_execute(dp, x, &y);
+    CONTEND_DELTA(crealf(y), crealf(y_test), tol);
+    CONTEND_DELTA(cimagf(y), cimagf(y_test), tol);
+
+    // re-create with same length returns same object
+    dotprod_crcf dp2 = dotprod_crcf_recreate(dp, h2, n);
+    CONTEND_EQUALITY(dp2 == dp, 1);
+    dotprod_crcf_execute(dp2, x, &y);
+    CONTEND_DELTA(crealf(y), crealf(y_test2), tol);
+    CONTEND_DELTA(cimagf(y), cimagf(y_test2), tol);
+
+    dotprod_crcf_destroy(dp2);
+}
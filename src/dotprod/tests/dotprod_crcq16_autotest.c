@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// random Q15 value with magnitude scaled down by _d
+static q16_t dotprod_crcq16_autotest_rand(unsigned int _d)
+{
+    return (q16_t)(((int)(rand() & 0xffff) - 32768) / (int)_d);
+}
+
+// 
+// AUTOTEST: basic dot product, fixed-point complex input
+//
+void autotest_dotprod_crcq16_basic()
+{
+    // 0.5, -0.25, 0.125, 0.25
+    q16_t  h[4] = { 16384, -8192, 4096, 8192 };
+    // 0.5+0.25j, 0.5-0.5j, -1.0+0j, 0.75+0.125j
+    cq16_t x[4] = { {16384, 8192}, {16384, -16384}, {-32768, 0}, {24576, 4096} };
+
+    // real: 0.25 - 0.125 - 0.125 + 0.1875     = 0.1875
+    // imag: 0.125 + 0.125 + 0     + 0.03125   = 0.28125
+    cq16_t y;
+
+    dotprod_crcq16_run(h, x, 4, &y);
+    CONTEND_EQUALITY(y.real, 6144);
+    CONTEND_EQUALITY(y.imag, 9216);
+
+    dotprod_crcq16 dp = dotprod_crcq16_create(h, 4);
+    dotprod_crcq16_execute(dp, x, &y);
+    CONTEND_EQUALITY(y.real, 6144);
+    CONTEND_EQUALITY(y.imag, 9216);
+    dotprod_crcq16_destroy(dp);
+}
+
+// structured object matches ordinal computation exactly
+void autotest_dotprod_crcq16_struct_vs_ordinal()
+{
+    unsigned int n;
+    for (n=1; n<=100; n++) {
+        q16_t  h[n];
+        cq16_t x[n];
+        unsigned int i;
+        for (i=0; i<n; i++) {
+            h[i]      = dotprod_crcq16_autotest_rand(n);
+            x[i].real = dotprod_crcq16_autotest_rand(1);
+            x[i].imag = dotprod_crcq16_autotest_rand(1);
+        }
+
+        cq16_t y, y_test;
+        dotprod_crcq16_run(h, x, n, &y_test);
+
+        dotprod_crcq16 dp = dotprod_crcq16_create(h, n);
+        dotprod_crcq16_execute(dp, x, &y);
+        dotprod_crcq16_destroy(dp);
+
+        if (liquid_autotest_verbose)
+            printf("  dotprod-crcq16-%-4u : %6d+j%6d (expected %6d+j%6d)\n",
+                    n, y.real, y.imag, y_test.real, y_test.imag);
+
+        CONTEND_EQUALITY(y.real, y_test.real);
+        CONTEND_EQUALITY(y.imag, y_test.imag);
+    }
+}
+
+// update coefficients in place and re-create with same length
+void autotest_dotprod_crcq16_update_coefficients()
+{
+    unsigned int n = 37;
+    q16_t  h0[n], h1[n];
+    cq16_t x[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        h0[i]     = dotprod_crcq16_autotest_rand(n);
+        h1[i]     = dotprod_crcq16_autotest_rand(n);
+        x[i].real = dotprod_crcq16_autotest_rand(1);
+        x[i].imag = dotprod_crcq16_autotest_rand(1);
+    }
+
+    cq16_t y, y_test;
+    dotprod_crcq16_run(h1, x, n, &y_test);
+
+    dotprod_crcq16 dp = dotprod_crcq16_create(h0, n);
+    dotprod_crcq16_update_coefficients(dp, h1);
+    dotprod_crcq16_execute(dp, x, &y);
+    CONTEND_EQUALITY(y.real, y_test.real);
+    CONTEND_EQUALITY(y.imag, y_test.imag);
+
+    // re-create with same length returns same object
+    dotprod_crcq16 dp2 = dotprod_crcq16_recreate(dp, h0, n);
+    CONTEND_EQUALITY(dp2 == dp, 1);
+    dotprod_crcq16_run(h0, x, n, &y_test);
+    dotprod_crcq16_execute(dp2, x, &y);
+    CONTEND_EQUALITY(y.real, y_test.real);
+    CONTEND_EQUALITY(y.imag, y_test.imag);
+    dotprod_crcq16_destroy(dp2);
+}
+
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST: half-precision conversion of known values
+//
+void autotest_float16_convert()
+{
+    CONTEND_EQUALITY(liquid_float_to_float16( 0.0f),     0x0000);
+    CONTEND_EQUALITY(liquid_float_to_float16(-0.0f),     0x8000);
+    CONTEND_EQUALITY(liquid_float_to_float16( 1.0f),     0x3c00);
+    CONTEND_EQUALITY(liquid_float_to_float16(-2.0f),     0xc000);
+    CONTEND_EQUALITY(liquid_float_to_float16( 65504.0f), 0x7bff);   // largest normal
+    CONTEND_EQUALITY(liquid_float_to_float16( 65520.0f), 0x7c00);   // rounds to infinity
+    CONTEND_EQUALITY(liquid_float_to_float16( 1e9f),     0x7c00);
+    CONTEND_EQUALITY(liquid_float_to_float16( 0x1p-14f), 0x0400);   // smallest normal
+    CONTEND_EQUALITY(liquid_float_to_float16( 0x1p-24f), 0x0001);   // smallest subnormal
+    CONTEND_EQUALITY(liquid_float_to_float16( 0x1p-26f), 0x0000);   // underflow
+    CONTEND_EQUALITY(liquid_float_to_float16( 1.0f/3.0f),0x3555);
+
+    // ties round to even mantissa
+    CONTEND_EQUALITY(liquid_float_to_float16(1.0f + 0x1p-11f),       0x3c00);
+    CONTEND_EQUALITY(liquid_float_to_float16(1.0f + 3.0f*0x1p-11f),  0x3c02);
+
+    CONTEND_EQUALITY(liquid_float16_to_float(0x3c00),  1.0f);
+    CONTEND_EQUALITY(liquid_float16_to_float(0x0001),  0x1p-24f);
+    CONTEND_EQUALITY(liquid_float16_to_float(0xfbff), -65504.0f);
+    CONTEND_EXPRESSION(isinf(liquid_float16_to_float(0x7c00)));
+    CONTEND_EXPRESSION(isnan(liquid_float16_to_float(0x7e00)));
+}
+
+// every finite half-precision value converts to single precision and
+// back without change
+void autotest_float16_round_trip()
+{
+    unsigned int i;
+    unsigned int num_errors = 0;
+    for (i=0; i<65536; i++) {
+        liquid_float16 h = (liquid_float16)i;
+        if ((h & 0x7c00) == 0x7c00)
+            continue;
+        num_errors += liquid_float_to_float16(liquid_float16_to_float(h)) != h;
+    }
+    CONTEND_EQUALITY(num_errors, 0);
+}
+
+// half-precision kernels match a reference computed from the widened
+// coefficients, at each available dispatch level and for lengths
+// which exercise the vector bodies and scalar tails
+void autotest_dotprod_f16_kernels()
+{
+    float tol = 1e-4f;
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        unsigned int n;
+        for (n=1; n<=67; n++) {
+            float          hf[2*n];
+            liquid_float16 h[2*n];
+            float          x[n];
+            float complex  xc[n];
+            unsigned int i;
+            for (i=0; i<2*n; i++)
+                hf[i] = randnf() / (float)n;
+            liquid_vectorf_to_float16(hf, 2*n, h);
+            for (i=0; i<n; i++) {
+                x[i]  = randnf();
+                xc[i] = randnf() + _Complex_I*randnf();
+            }
+
+            // reference from widened coefficients
+            float         y0 = 0.0f;
+            float complex y1 = 0.0f;
+            float complex y2 = 0.0f;
+            for (i=0; i<n; i++) {
+                float hr = liquid_float16_to_float(h[2*i  ]);
+                float hi = liquid_float16_to_float(h[2*i+1]);
+                y0 += liquid_float16_to_float(h[i]) * x[i];
+                y1 += liquid_float16_to_float(h[i]) * xc[i];
+                y2 += (hr + _Complex_I*hi) * xc[i];
+            }
+
+            float         y;
+            float complex yc;
+            dotprod_rrrh_run(h, x, n, &y);
+            CONTEND_DELTA(y, y0, tol);
+            dotprod_crch_run(h, xc, n, &yc);
+            CONTEND_DELTA(crealf(yc), crealf(y1), tol);
+            CONTEND_DELTA(cimagf(yc), cimagf(y1), tol);
+            dotprod_ccch_run(h, xc, n, &yc);
+            CONTEND_DELTA(crealf(yc), crealf(y2), tol);
+            CONTEND_DELTA(cimagf(yc), cimagf(y2), tol);
+        }
+    }
+    liquid_simd_set_level(host);
+}
@@ -370,3 +370,38 @@ void autotest_dotprod_rrrf_struct_vs_ordinal()
         runtest_dotprod_rrrf(i);
 }
 
+// update coefficients in place and re-create with same length;
+// both must match a freshly created object
+void autotest_dotprod_rrrf_update_coefficients()
+{
+    float tol = 1e-3;
+    unsigned int n = 37;
+    float h0[n], h1[n], h2[n];
+    float x[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        h0[i] = randnf();
+        h1[i] = randnf();
+        h2[i] = randnf();
+        x[i]  = randnf();
+    }
+
+    float y, y_test, y_test2;
+    dotprod_rrrf_run(h1, x, n, &y_test);
+    dotprod_rrrf_run(h2, x, n, &y_test2);
+
+    // overwrite coefficients
+    dotprod_rrrf dp = dotprod_rrrf_create(h0, n);
+    dotprod_rrrf_update_coefficients(dp, h1);
+    dotprod_rrrf_execute(dp, x, &y);
+    CONTEND_DELTA(y, y_test, tol);
+
+    // re-create with same length returns same object
+    dotprod_rrrf dp2 = dotprod_rrrf_recreate(dp, h2, n);
+    CONTEND_EQUALITY(dp2 == dp, 1);
+    dotprod_rrrf_execute(dp2, x, &y);
+    CONTEND_DELTA(y, y_test2, tol);
+
+    dotprod_rrrf_destroy(dp2);
+}
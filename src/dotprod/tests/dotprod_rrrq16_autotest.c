@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// random Q15 value with magnitude scaled down by _d
+static q16_t dotprod_rrrq16_autotest_rand(unsigned int _d)
+{
+    return (q16_t)(((int)(rand() & 0xffff) - 32768) / (int)_d);
+}
+
+// 
+// AUTOTEST: basic dot product, fixed-point
+//
+void autotest_dotprod_rrrq16_basic()
+{
+    // 0.5, -0.25, 0.125, 0.25
+    q16_t h[4] = { 16384, -8192, 4096, 8192 };
+    // 0.5, 0.5, -1.0, 0.75
+    q16_t x[4] = { 16384, 16384, -32768, 24576 };
+
+    // 0.25 - 0.125 - 0.125 + 0.1875 = 0.1875
+    q16_t y_test = 6144;
+    q16_t y;
+
+    dotprod_rrrq16_run(h, x, 4, &y);
+    CONTEND_EQUALITY(y, y_test);
+
+    dotprod_rrrq16 dp = dotprod_rrrq16_create(h, 4);
+    dotprod_rrrq16_execute(dp, x, &y);
+    CONTEND_EQUALITY(y, y_test);
+    dotprod_rrrq16_destroy(dp);
+}
+
+// output saturates rather than wrapping around
+void autotest_dotprod_rrrq16_saturate()
+{
+    q16_t h[2] = { 32767, 32767 };
+    q16_t x[2] = { 32767, 32767 };
+    q16_t y;
+
+    // 2*(1-2^-15)^2 > 1
+    dotprod_rrrq16_run(h, x, 2, &y);
+    CONTEND_EQUALITY(y, 32767);
+
+    x[0] = -32768;
+    x[1] = -32768;
+    dotprod_rrrq16_run(h, x, 2, &y);
+    CONTEND_EQUALITY(y, -32768);
+}
+
+// structured object matches ordinal computation exactly
+void autotest_dotprod_rrrq16_struct_vs_ordinal()
+{
+    unsigned int n;
+    for (n=1; n<=100; n++) {
+        q16_t h[n];
+        q16_t x[n];
+        unsigned int i;
+        for (i=0; i<n; i++) {
+            h[i] = dotprod_rrrq16_autotest_rand(n);
+            x[i] = dotprod_rrrq16_autotest_rand(1);
+        }
+
+        q16_t y, y_test;
+        dotprod_rrrq16_run(h, x, n, &y_test);
+
+        dotprod_rrrq16 dp = dotprod_rrrq16_create(h, n);
+        dotprod_rrrq16_execute(dp, x, &y);
+        dotprod_rrrq16_destroy(dp);
+
+        if (liquid_autotest_verbose)
+            printf("  dotprod-rrrq16-%-4u : %6d (expected %6d)\n", n, y, y_test);
+
+        CONTEND_EQUALITY(y, y_test);
+    }
+}
+
+// fixed-point result is within one LSB of floating-point result
+void autotest_dotprod_rrrq16_float()
+{
+    unsigned int n = 57;
+    q16_t h[n];
+    q16_t x[n];
+    float hf[n];
+    float xf[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        h[i]  = dotprod_rrrq16_autotest_rand(n);
+        x[i]  = dotprod_rrrq16_autotest_rand(1);
+        hf[i] = q16_fixed_to_float(h[i]);
+        xf[i] = q16_fixed_to_float(x[i]);
+    }
+
+    q16_t y;
+    float y_test;
+    dotprod_rrrq16 dp = dotprod_rrrq16_create(h, n);
+    dotprod_rrrq16_execute(dp, x, &y);
+    dotprod_rrrq16_destroy(dp);
+    dotprod_rrrf_run(hf, xf, n, &y_test);
+
+    CONTEND_DELTA(q16_fixed_to_float(y), y_test, 1.0f/32768.0f);
+}
+
+// update coefficients in place and re-create with same length
+void autotest_dotprod_rrrq16_update_coefficients()
+{
+    unsigned int n = 37;
+    q16_t h0[n], h1[n];
+    q16_t x[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        h0[i] = dotprod_rrrq16_autotest_rand(n);
+        h1[i] = dotprod_rrrq16_autotest_rand(n);
+        x[i]  = dotprod_rrrq16_autotest_rand(1);
+    }
+
+    q16_t y, y_test;
+    dotprod_rrrq16_run(h1, x, n, &y_test);
+
+    dotprod_rrrq16 dp = dotprod_rrrq16_create(h0, n);
+    dotprod_rrrq16_update_coefficients(dp, h1);
+    dotprod_rrrq16_execute(dp, x, &y);
+    CONTEND_EQUALITY(y, y_test);
+
+    // re-create with same length returns same object
+    dotprod_rrrq16 dp2 = dotprod_rrrq16_recreate(dp, h0, n);
+    CONTEND_EQUALITY(dp2 == dp, 1);
+    dotprod_rrrq16_run(h0, x, n, &y_test);
+    dotprod_rrrq16_execute(dp2, x, &y);
+    CONTEND_EQUALITY(y, y_test);
+    dotprod_rrrq16_destroy(dp2);
+}
+
+// floating-point conversion saturates outside [-1,1)
+void autotest_q16_float_to_fixed()
+{
+    CONTEND_EQUALITY(q16_float_to_fixed( 0.5f),    16384);
+    CONTEND_EQUALITY(q16_float_to_fixed(-0.25f),   -8192);
+    CONTEND_EQUALITY(q16_float_to_fixed(-1.0f),   -32768);
+    CONTEND_EQUALITY(q16_float_to_fixed( 1.0f),    32767);
+    CONTEND_EQUALITY(q16_float_to_fixed( 3.7f),    32767);
+    CONTEND_EQUALITY(q16_float_to_fixed(-3.7f),   -32768);
+    CONTEND_DELTA(q16_fixed_to_float(-16384), -0.5f, 1e-9f);
+}
+
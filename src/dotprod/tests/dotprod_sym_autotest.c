@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// 
+// AUTOTEST: folded symmetric dot product compared against ordinal
+//           computation on the full symmetric coefficients
+//
+
+// helper function
+//  _n      :   maximum dot product length
+void runtest_dotprod_sym(unsigned int _n)
+{
+    float tol = 1e-4f;
+    float         hf[_n];
+    float complex hc[_n];
+    float         xf[_n];
+    float complex xc[_n];
+    unsigned int i, n;
+    for (i=0; i<_n; i++) {
+        hf[i] = randnf();
+        hc[i] = randnf() + randnf()*_Complex_I;
+        xf[i] = randnf();
+        xc[i] = randnf() + randnf()*_Complex_I;
+    }
+
+    for (n=1; n<=_n; n++) {
+        // expand to full symmetric coefficients
+        float         hf_full[n];
+        float complex hc_full[n];
+        for (i=0; i<n; i++) {
+            hf_full[i] = hf[i < n-1-i ? i : n-1-i];
+            hc_full[i] = hc[i < n-1-i ? i : n-1-i];
+        }
+
+        float         yr, yr_test;
+        float complex yc, yc_test;
+
+        dotprod_rrrf_run_sym(hf, n, xf, &yr);
+        dotprod_rrrf_run(hf_full, xf, n, &yr_test);
+        CONTEND_DELTA(yr, yr_test, tol);
+
+        dotprod_crcf_run_sym(hf, n, xc, &yc);
+        dotprod_crcf_run(hf_full, xc, n, &yc_test);
+        CONTEND_DELTA(crealf(yc), crealf(yc_test), tol);
+        CONTEND_DELTA(cimagf(yc), cimagf(yc_test), tol);
+
+        dotprod_cccf_run_sym(hc, n, xc, &yc);
+        dotprod_cccf_run(hc_full, xc, n, &yc_test);
+        CONTEND_DELTA(crealf(yc), crealf(yc_test), tol);
+        CONTEND_DELTA(cimagf(yc), cimagf(yc_test), tol);
+    }
+}
+
+void autotest_dotprod_sym()     { runtest_dotprod_sym( 80); }
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// check whether SIMD level can be selected on this host/build
+static int simd_autotest_supported(liquid_simd_level _level)
+{
+    liquid_simd_level host = liquid_simd_get_host_level();
+    switch (host) {
+    case LIQUID_SIMD_SSE:
+    case LIQUID_SIMD_AVX2:
+    case LIQUID_SIMD_AVX512F:
+        return _level <= host;
+    default:;
+    }
+    return _level == host;
+}
+
+// run kernels at SIMD level and compare to ordinal computation
+static void simd_autotest_run(liquid_simd_level _level)
+{
+    float tol = 1e-4f;
+    unsigned int n   = 57;  // dotprod length
+    unsigned int num = 21;  // number of block outputs
+    unsigned int nx  = n + num - 1;
+
+    // generate random coefficients and input
+    float         hf[n];
+    float complex hc[n];
+    float         xf[nx];
+    float complex xc[nx];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        hf[i] = randnf();
+        hc[i] = randnf() + randnf()*_Complex_I;
+    }
+    for (i=0; i<nx; i++) {
+        xf[i] = randnf();
+        xc[i] = randnf() + randnf()*_Complex_I;
+    }
+
+    CONTEND_EQUALITY(liquid_simd_set_level(_level), _level);
+    CONTEND_EQUALITY(liquid_simd_get_level(),       _level);
+
+    // objects bind their kernel at creation
+    dotprod_rrrf qr = dotprod_rrrf_create(hf, n);
+    dotprod_crcf qc = dotprod_crcf_create(hf, n);
+    dotprod_cccf qz = dotprod_cccf_create(hc, n);
+
+    float         yr, yr_test;
+    float complex yc, yc_test;
+    for (i=0; i<num; i++) {
+        dotprod_rrrf_execute(qr, &xf[i], &yr);
+        dotprod_rrrf_run(hf, &xf[i], n, &yr_test);
+        CONTEND_DELTA(yr, yr_test, tol);
+
+        dotprod_crcf_execute(qc, &xc[i], &yc);
+        dotprod_crcf_run(hf, &xc[i], n, &yc_test);
+        CONTEND_DELTA(crealf(yc), crealf(yc_test), tol);
+        CONTEND_DELTA(cimagf(yc), cimagf(yc_test), tol);
+
+        dotprod_cccf_execute(qz, &xc[i], &yc);
+        dotprod_cccf_run(hc, &xc[i], n, &yc_test);
+        CONTEND_DELTA(crealf(yc), crealf(yc_test), tol);
+        CONTEND_DELTA(cimagf(yc), cimagf(yc_test), tol);
+    }
+    dotprod_rrrf_destroy(qr);
+    dotprod_crcf_destroy(qc);
+    dotprod_cccf_destroy(qz);
+
+    // block kernel
+    float complex yb[num];
+    dotprod_crcf_run_block(hf, n, xc, 1, num, yb);
+    for (i=0; i<num; i++) {
+        dotprod_crcf_run(hf, &xc[i], n, &yc_test);
+        CONTEND_DELTA(crealf(yb[i]), crealf(yc_test), tol);
+        CONTEND_DELTA(cimagf(yb[i]), cimagf(yc_test), tol);
+    }
+
+    // sum of squares and peak
+    float e_test = 0.0f, p_test = 0.0f;
+    for (i=0; i<nx; i++) {
+        float v2 = crealf(xc[i])*crealf(xc[i]) + cimagf(xc[i])*cimagf(xc[i]);
+        e_test += v2;
+        p_test  = v2 > p_test ? v2 : p_test;
+    }
+    float peak;
+    CONTEND_DELTA(liquid_sumsqcf(xc, nx),            e_test, tol*e_test);
+    CONTEND_DELTA(liquid_sumsqcf_peak(xc, nx, &peak), e_test, tol*e_test);
+    CONTEND_DELTA(peak, sqrtf(p_test), tol);
+
+    // radix-2 transform (radix-4 butterflies) against the regular DFT
+    unsigned int nfft = 256;
+    float complex xf_fft[nfft], y_fft[nfft], y_dft[nfft];
+    for (i=0; i<nfft; i++)
+        xf_fft[i] = randnf() + randnf()*_Complex_I;
+    fft_run(nfft, xf_fft, y_fft, LIQUID_FFT_FORWARD, LIQUID_FFT_FORCE_RADIX2);
+    fft_run(nfft, xf_fft, y_dft, LIQUID_FFT_FORWARD, LIQUID_FFT_FORCE_DFT);
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA(cabsf(y_fft[i] - y_dft[i]), 0.0f, 1e-3f);
+
+    // spectral periodogram windowing and psd accumulation
+    float w_sp[nx], yf_sp[nx], psd[nx], psd_test[nx];
+    float complex yc_sp[nx];
+    for (i=0; i<nx; i++)
+        w_sp[i] = randnf();
+    liquid_spgram_window_cf(xc, w_sp, nx, yc_sp);
+    liquid_spgram_window_f (xf, w_sp, nx, yf_sp);
+    for (i=0; i<nx; i++) {
+        CONTEND_DELTA(crealf(yc_sp[i]), crealf(xc[i])*w_sp[i], tol);
+        CONTEND_DELTA(cimagf(yc_sp[i]), cimagf(xc[i])*w_sp[i], tol);
+        CONTEND_DELTA(yf_sp[i], xf[i]*w_sp[i], tol);
+    }
+    liquid_spgram_psd_set(xc, nx, psd);
+    for (i=0; i<nx; i++) {
+        psd_test[i] = crealf(xc[i])*crealf(xc[i]) + cimagf(xc[i])*cimagf(xc[i]);
+        CONTEND_DELTA(psd[i], psd_test[i], tol*(1+psd_test[i]));
+    }
+    liquid_spgram_psd_update(yc_sp, nx, 0.7f, 0.3f, psd);
+    for (i=0; i<nx; i++) {
+        float v = crealf(yc_sp[i])*crealf(yc_sp[i]) + cimagf(yc_sp[i])*cimagf(yc_sp[i]);
+        psd_test[i] = 0.7f*psd_test[i] + 0.3f*v;
+        CONTEND_DELTA(psd[i], psd_test[i], tol*(1+psd_test[i]));
+    }
+
+    // ofdm tapered overlap-add
+    float yf_ov[nx];
+    ofdmframegen_overlap_add(xf, &xf[1], w_sp, psd, yf_ov, nx-1);
+    for (i=0; i<nx-1; i++)
+        CONTEND_DELTA(yf_ov[i], xf[i]*w_sp[i] + xf[i+1]*psd[i], tol*(1+fabsf(yf_ov[i])));
+
+    // no family resolves to a level other than the dispatch level or
+    // the portable fallback; the fixed-point kernels run SSE2 code at
+    // all x86 levels and the viterbi, modem, nco, ofdm, vector,
+    // matrix, audio, scramble, half-precision, trig, equalizer and
+    // shared-input batch dotprod kernels run AVX2 code at AVX-512F
+    for (i=0; i<LIQUID_SIMD_NUM_FAMILIES; i++) {
+        liquid_simd_level k = liquid_simd_get_kernel((liquid_simd_family)i);
+        if (i == LIQUID_SIMD_DOTPROD_Q16 && k == LIQUID_SIMD_SSE && _level >= LIQUID_SIMD_SSE && _level <= LIQUID_SIMD_AVX512F)
+            continue;
+        if ((i == LIQUID_SIMD_VITERBI || i == LIQUID_SIMD_MODEM || i == LIQUID_SIMD_NCO ||
+             i == LIQUID_SIMD_OFDM || i == LIQUID_SIMD_VECTOR || i == LIQUID_SIMD_MATRIX ||
+             i == LIQUID_SIMD_AUDIO || i == LIQUID_SIMD_SCRAMBLE ||
+             i == LIQUID_SIMD_DOTPROD_F16 || i == LIQUID_SIMD_TRIG ||
+             i == LIQUID_SIMD_EQUALIZER || i == LIQUID_SIMD_DOTPROD_BATCH) &&
+            k == LIQUID_SIMD_AVX2 && _level == LIQUID_SIMD_AVX512F)
+            continue;
+        CONTEND_EXPRESSION(k == _level || k == LIQUID_SIMD_PORTABLE);
+    }
+}
+
+// run kernels at every level available on this host
+void autotest_simd_levels()
+{
+    liquid_simd_level host = liquid_simd_get_host_level();
+    CONTEND_EQUALITY(simd_autotest_supported(host), 1);
+
+    unsigned int i;
+    for (i=0; i<LIQUID_SIMD_NUM_LEVELS; i++) {
+        if (!simd_autotest_supported((liquid_simd_level)i))
+            continue;
+
+        if (liquid_autotest_verbose)
+            printf("  testing simd level '%s'\n", liquid_simd_level_str((liquid_simd_level)i));
+        simd_autotest_run((liquid_simd_level)i);
+    }
+
+    // restore default
+    CONTEND_EQUALITY(liquid_simd_set_level(host), host);
+}
+
+// unsupported level is rejected and current level is kept
+void autotest_simd_set_unsupported()
+{
+    liquid_simd_level host = liquid_simd_get_host_level();
+    liquid_simd_level other = host == LIQUID_SIMD_NEON ? LIQUID_SIMD_ALTIVEC : LIQUID_SIMD_NEON;
+
+    CONTEND_EQUALITY(liquid_simd_set_level(other), host);
+    CONTEND_EQUALITY(liquid_simd_get_level(),      host);
+}
@@ -54,6 +54,42 @@ void autotest_sumsqcf_8()   {   sumsqcf_runtest( sumsqcf_test_x8,  8,  sumsqcf_t
 void autotest_sumsqcf_15()  {   sumsqcf_runtest( sumsqcf_test_x15, 15, sumsqcf_test_y15 );  }
 void autotest_sumsqcf_16()  {   sumsqcf_runtest( sumsqcf_test_x16, 16, sumsqcf_test_y16 );  }
 
+// compare sum of squares and fused peak magnitude against ordinal
+// computation on random data of arbitrary length
+void sumsqcf_peak_runtest(unsigned int _n)
+{
+    float tol = 1e-4;   // error tolerance (relative)
+
+    float complex x[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // ordinal computation
+    float y_test    = 0.0f;
+    float peak_test = 0.0f;
+    for (i=0; i<_n; i++) {
+        float v2 = crealf(x[i])*crealf(x[i]) + cimagf(x[i])*cimagf(x[i]);
+        y_test += v2;
+        peak_test = v2 > peak_test ? v2 : peak_test;
+    }
+    peak_test = sqrtf(peak_test);
+
+    // run tests
+    float peak;
+    float y0 = liquid_sumsqcf(x, _n);
+    float y1 = liquid_sumsqcf_peak(x, _n, &peak);
+
+    CONTEND_DELTA( y0,   y_test,    tol*y_test );
+    CONTEND_DELTA( y1,   y_test,    tol*y_test );
+    CONTEND_DELTA( peak, peak_test, tol );
+}
+
+void autotest_sumsqcf_peak_1()   { sumsqcf_peak_runtest(  1); }
+void autotest_sumsqcf_peak_11()  { sumsqcf_peak_runtest( 11); }
+void autotest_sumsqcf_peak_64()  { sumsqcf_peak_runtest( 64); }
+void autotest_sumsqcf_peak_203() { sumsqcf_peak_runtest(203); }
+
 float complex sumsqcf_test_x3[3] = {
   -0.143606511525 +  -0.137405158308*_Complex_I,
   -0.155077565599 +  -0.128712786230*_Complex_I,
@@ -54,6 +54,42 @@ void autotest_sumsqf_8()    {   sumsqf_runtest( sumsqf_test_x8,  8,  sumsqf_test
 void autotest_sumsqf_15()   {   sumsqf_runtest( sumsqf_test_x15, 15, sumsqf_test_y15 ); }
 void autotest_sumsqf_16()   {   sumsqf_runtest( sumsqf_test_x16, 16, sumsqf_test_y16 ); }
 
+// compare sum of squares and fused peak magnitude against ordinal
+// computation on random data of arbitrary length
+void sumsqf_peak_runtest(unsigned int _n)
+{
+    float tol = 1e-4;   // error tolerance (relative)
+
+    float x[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        x[i] = randnf();
+
+    // ordinal computation
+    float y_test    = 0.0f;
+    float peak_test = 0.0f;
+    for (i=0; i<_n; i++) {
+        float v2 = x[i]*x[i];
+        y_test += v2;
+        peak_test = v2 > peak_test ? v2 : peak_test;
+    }
+    peak_test = sqrtf(peak_test);
+
+    // run tests
+    float peak;
+    float y0 = liquid_sumsqf(x, _n);
+    float y1 = liquid_sumsqf_peak(x, _n, &peak);
+
+    CONTEND_DELTA( y0,   y_test,    tol*y_test );
+    CONTEND_DELTA( y1,   y_test,    tol*y_test );
+    CONTEND_DELTA( peak, peak_test, tol );
+}
+
+void autotest_sumsqf_peak_1()   { sumsqf_peak_runtest(  1); }
+void autotest_sumsqf_peak_11()  { sumsqf_peak_runtest( 11); }
+void autotest_sumsqf_peak_64()  { sumsqf_peak_runtest( 64); }
+void autotest_sumsqf_peak_203() { sumsqf_peak_runtest(203); }
+
 float sumsqf_test_x3[3] = {
   -0.4546496371984978f,
    0.4451201395218938f,
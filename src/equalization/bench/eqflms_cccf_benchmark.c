@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define EQFLMS_CCCF_TRAIN_BENCH_API(N)  \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ eqflms_cccf_train_bench(_start, _finish, _num_iterations, N); }
+
+// Helper function to keep code base small
+void eqflms_cccf_train_bench(struct rusage *_start,
+                             struct rusage *_finish,
+                             unsigned long int *_num_iterations,
+                             unsigned int _h_len)
+{
+    // scale number of iterations appropriately
+    *_num_iterations /= 4;
+    *_num_iterations = (*_num_iterations < 4) ? 4 : *_num_iterations;
+
+    eqflms_cccf eq = eqflms_cccf_create(NULL,_h_len);
+
+    unsigned long int i;
+
+    // set up initial arrays to 'randomize' inputs/outputs
+    float complex x[256], d[256], y[256];
+    for (i=0; i<256; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        d[i] = randnf() + _Complex_I*randnf();
+    }
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i+=256)
+        eqflms_cccf_execute_training(eq, x, d, 256, y);
+    getrusage(RUSAGE_SELF, _finish);
+
+    eqflms_cccf_destroy(eq);
+}
+
+// 
+void benchmark_eqflms_cccf_n16  EQFLMS_CCCF_TRAIN_BENCH_API(16)
+void benchmark_eqflms_cccf_n32  EQFLMS_CCCF_TRAIN_BENCH_API(32)
+void benchmark_eqflms_cccf_n64  EQFLMS_CCCF_TRAIN_BENCH_API(64)
+void benchmark_eqflms_cccf_n128 EQFLMS_CCCF_TRAIN_BENCH_API(128)
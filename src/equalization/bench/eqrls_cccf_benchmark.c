@@ -29,21 +29,31 @@
 (   struct rusage *_start,              \
     struct rusage *_finish,             \
     unsigned long int *_num_iterations) \
-{ eqrls_cccf_train_bench(_start, _finish, _num_iterations, N); }
+{ eqrls_cccf_train_bench(_start, _finish, _num_iterations, N, 0); }
+
+#define EQRLS_CCCF_FAST_BENCH_API(N)    \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ eqrls_cccf_train_bench(_start, _finish, _num_iterations, N, 1); }
 
 // Helper function to keep code base small
 void eqrls_cccf_train_bench(struct rusage *_start,
                             struct rusage *_finish,
                             unsigned long int *_num_iterations,
-                            unsigned int _h_len)
+                            unsigned int _h_len,
+                            int _fast)
 {
     // scale number of iterations appropriately
     // log(cycles/trial) ~ 5.57 + 2.74*log(_h_len)
     *_num_iterations *= 2400;
-    *_num_iterations /= (unsigned int) expf(5.57f + 2.64f*logf(_h_len));
+    // fast transversal filter recursion is linear in _h_len
+    *_num_iterations /= _fast ? (unsigned int) (200 + 40*_h_len)
+                              : (unsigned int) expf(5.57f + 2.64f*logf(_h_len));
     *_num_iterations = (*_num_iterations < 4) ? 4 : *_num_iterations;
 
-    eqrls_cccf eq = eqrls_cccf_create(NULL,_h_len);
+    eqrls_cccf eq = _fast ? eqrls_cccf_create_fast(NULL,_h_len)
+                          : eqrls_cccf_create     (NULL,_h_len);
     
     unsigned long int i;
 
@@ -84,3 +94,8 @@ void benchmark_eqrls_cccf_n16   EQRLS_CCCF_TRAIN_BENCH_API(16)
 void benchmark_eqrls_cccf_n32   EQRLS_CCCF_TRAIN_BENCH_API(32)
 void benchmark_eqrls_cccf_n64   EQRLS_CCCF_TRAIN_BENCH_API(64)
 
+void benchmark_eqrls_cccf_fast_n4    EQRLS_CCCF_FAST_BENCH_API(4)
+void benchmark_eqrls_cccf_fast_n8    EQRLS_CCCF_FAST_BENCH_API(8)
+void benchmark_eqrls_cccf_fast_n16   EQRLS_CCCF_FAST_BENCH_API(16)
+void benchmark_eqrls_cccf_fast_n32   EQRLS_CCCF_FAST_BENCH_API(32)
+void benchmark_eqrls_cccf_fast_n64   EQRLS_CCCF_FAST_BENCH_API(64)
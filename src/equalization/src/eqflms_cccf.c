@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Block frequency-domain least mean-squares (FLMS) equalizer
+//
+// Constrained overlap-save FLMS: input is processed in blocks of
+// L = h_len samples with transforms of size N = 2 h_len. Each block is
+// filtered in the frequency domain, and the gradient
+//      g[k] = sum_n e[n] conj(x[n-k]),  k = 0..h_len-1
+// accumulated over the block is computed as a circular correlation
+// with its non-causal half discarded. The weights are updated once per
+// block as h += mu g / sum{|x|^2}, which matches one normalized LMS
+// step per sample for white input.
+//
+// Samples of a block which is not yet complete (calls of arbitrary
+// length) are filtered directly in the time domain with the current
+// weights; the block update runs when the block completes, so the
+// output does not depend on how the input is split across calls.
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+struct eqflms_cccf_s {
+    unsigned int    h_len;      // filter length, block length
+    unsigned int    nfft;       // transform size (2 h_len)
+    float           mu;         // LMS step size
+
+    float complex * h0;         // initial coefficients (eqlms order)
+    float complex * h;          // filter taps, y[n] = sum h[k] x[n-k]
+    float complex * W;          // transform of zero-padded taps
+
+    float complex * x;          // input: previous, current block
+    float complex * e;          // error of current block
+    unsigned int    pos;        // samples in current block
+    unsigned int    count;      // total input sample count
+
+    float complex * X;          // transform of input
+    int             X_valid;    // X is transform of current block?
+    float complex * buf_time;   // transform buffer (time)
+    float complex * buf_freq;   // transform buffer (freq)
+    fftplan         fft_x;      // x        -> X
+    fftplan         fft;        // buf_time -> buf_freq
+    fftplan         ifft;       // buf_freq -> buf_time
+};
+
+// filter current block in the frequency domain (block complete)
+static void eqflms_cccf_filter_block(eqflms_cccf _q, float complex * _y);
+
+// update weights from errors of current block and advance block
+static void eqflms_cccf_update_block(eqflms_cccf _q);
+
+// create block frequency-domain LMS equalizer object
+//  _h      :   initial coefficients [size: _h_len x 1], default if NULL
+//  _h_len  :   equalizer length (number of taps)
+eqflms_cccf eqflms_cccf_create(float complex * _h,
+                               unsigned int    _h_len)
+{
+    if (_h_len == 0) {
+        fprintf(stderr,"error: eqflms_cccf_create(), filter length must be greater than 0\n");
+        exit(1);
+    }
+
+    eqflms_cccf q = (eqflms_cccf) liquid_malloc(sizeof(struct eqflms_cccf_s));
+
+    // set filter order, other params
+    q->h_len = _h_len;
+    q->nfft  = 2*_h_len;
+    q->mu    = 0.5f;
+
+    q->h0       = (float complex*) liquid_malloc(q->h_len*sizeof(float complex));
+    q->h        = (float complex*) liquid_malloc(q->h_len*sizeof(float complex));
+    q->e        = (float complex*) liquid_malloc(q->h_len*sizeof(float complex));
+    q->W        = (float complex*) liquid_malloc(q->nfft *sizeof(float complex));
+    q->x        = (float complex*) liquid_malloc(q->nfft *sizeof(float complex));
+    q->X        = (float complex*) liquid_malloc(q->nfft *sizeof(float complex));
+    q->buf_time = (float complex*) liquid_malloc(q->nfft *sizeof(float complex));
+    q->buf_freq = (float complex*) liquid_malloc(q->nfft *sizeof(float complex));
+
+    q->fft_x = fft_create_plan(q->nfft, q->x,        q->X,        LIQUID_FFT_FORWARD,  0);
+    q->fft   = fft_create_plan(q->nfft, q->buf_time, q->buf_freq, LIQUID_FFT_FORWARD,  0);
+    q->ifft  = fft_create_plan(q->nfft, q->buf_freq, q->buf_time, LIQUID_FFT_BACKWARD, 0);
+
+    // copy coefficients (if not NULL)
+    unsigned int i;
+    for (i=0; i<q->h_len; i++)
+        q->h0[i] = _h == NULL ? (i==0 ? 1.0f : 0.0f) : _h[i];
+
+    // reset equalizer object and return
+    eqflms_cccf_reset(q);
+    return q;
+}
+
+// destroy equalizer object, freeing all internal memory
+void eqflms_cccf_destroy(eqflms_cccf _q)
+{
+    fft_destroy_plan(_q->fft_x);
+    fft_destroy_plan(_q->fft);
+    fft_destroy_plan(_q->ifft);
+
+    liquid_free(_q->h0);
+    liquid_free(_q->h);
+    liquid_free(_q->e);
+    liquid_free(_q->W);
+    liquid_free(_q->x);
+    liquid_free(_q->X);
+    liquid_free(_q->buf_time);
+    liquid_free(_q->buf_freq);
+    liquid_free(_q);
+}
+
+// set taps from coefficients in eqlms order, y = sum conj(w[i]) r[i]
+// with r[i] oldest sample first, and compute their transform
+static void eqflms_cccf_set_taps(eqflms_cccf     _q,
+                                 float complex * _h)
+{
+    unsigned int i;
+    for (i=0; i<_q->h_len; i++)
+        _q->h[i] = conjf(_h[_q->h_len-i-1]);
+
+    memmove(_q->buf_time, _q->h, _q->h_len*sizeof(float complex));
+    memset(&_q->buf_time[_q->h_len], 0, _q->h_len*sizeof(float complex));
+    fft_execute(_q->fft);
+    memmove(_q->W, _q->buf_freq, _q->nfft*sizeof(float complex));
+}
+
+// reset equalizer
+void eqflms_cccf_reset(eqflms_cccf _q)
+{
+    eqflms_cccf_set_taps(_q, _q->h0);
+
+    memset(_q->x, 0, _q->nfft *sizeof(float complex));
+    memset(_q->e, 0, _q->h_len*sizeof(float complex));
+    _q->pos     = 0;
+    _q->count   = 0;
+    _q->X_valid = 0;
+}
+
+// print equalizer internals
+void eqflms_cccf_print(eqflms_cccf _q)
+{
+    printf("equalizer (FLMS):\n");
+    printf("    order:      %u\n", _q->h_len);
+    printf("    fft size:   %u\n", _q->nfft);
+    unsigned int i;
+    for (i=0; i<_q->h_len; i++)
+        printf("  h(%3u) = %12.4e + j*%12.4e;\n", i+1, crealf(_q->h[i]), cimagf(_q->h[i]));
+}
+
+// get learning rate of equalizer
+float eqflms_cccf_get_bw(eqflms_cccf _q)
+{
+    return _q->mu;
+}
+
+// set learning rate of equalizer
+//  _q      :   equalizer object
+//  _mu     :   LMS learning rate, 0 <= _mu < 2
+void eqflms_cccf_set_bw(eqflms_cccf _q,
+                        float       _mu)
+{
+    if (_mu < 0.0f) {
+        fprintf(stderr,"error: eqflms_cccf_set_bw(), learning rate cannot be less than zero\n");
+        exit(1);
+    }
+
+    _q->mu = _mu;
+}
+
+// run equalizer on block of samples
+//  _q      :   equalizer object
+//  _x      :   input samples [size: _n x 1]
+//  _d      :   desired output [size: _n x 1], NULL for blind
+//  _k      :   blind: down-sampling rate of constant-modulus error
+//  _n      :   number of samples
+//  _y      :   output samples [size: _n x 1]
+static void eqflms_cccf_run(eqflms_cccf     _q,
+                            float complex * _x,
+                            float complex * _d,
+                            unsigned int    _k,
+                            unsigned int    _n,
+                            float complex * _y)
+{
+    unsigned int M = _q->h_len;
+    unsigned int i = 0;
+    unsigned int j;
+    while (i < _n) {
+        unsigned int n;
+        float complex * x = &_q->x[M + _q->pos];
+        if (_q->pos == 0 && _n - i >= M) {
+            // full block: filter in frequency domain
+            n = M;
+            memmove(x, &_x[i], M*sizeof(float complex));
+            eqflms_cccf_filter_block(_q, &_y[i]);
+        } else {
+            // partial block: filter directly with current taps
+            n = 1;
+            x[0] = _x[i];
+            float complex y = 0.0f;
+            for (j=0; j<M; j++)
+                y += _q->h[j] * x[-(int)j];
+            _y[i] = y;
+        }
+
+        // compute errors
+        for (j=0; j<n; j++) {
+            float complex y = _y[i+j];
+            float complex e = 0.0f;
+            if (_d != NULL) {
+                e = _d[i+j] - y;
+            } else if ( ((_q->count + j) % _k) == 0 ) {
+                // constant modulus
+                float g = cabsf(y);
+                e = g > 0.0f ? y/g - y : 0.0f;
+            }
+            _q->e[_q->pos + j] = e;
+        }
+        _q->pos   += n;
+        _q->count += n;
+        i += n;
+
+        if (_q->pos == M)
+            eqflms_cccf_update_block(_q);
+    }
+}
+
+// execute equalizer with block of samples using constant modulus
+// algorithm, operating on a decimation rate of _k samples
+//  _q      :   equalizer object
+//  _k      :   down-sampling rate
+//  _x      :   input sample array [size: _n x 1]
+//  _n      :   input sample array length
+//  _y      :   output sample array [size: _n x 1]
+void eqflms_cccf_execute_block(eqflms_cccf     _q,
+                               unsigned int    _k,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    if (_k == 0) {
+        fprintf(stderr,"error: eqflms_cccf_execute_block(), down-sampling rate 'k' must be greater than 0\n");
+        exit(1);
+    }
+    eqflms_cccf_run(_q, _x, NULL, _k, _n, _y);
+}
+
+// execute equalizer with block of samples and known desired output
+//  _q      :   equalizer object
+//  _x      :   input sample array [size: _n x 1]
+//  _d      :   desired output array [size: _n x 1]
+//  _n      :   input sample array length
+//  _y      :   output sample array [size: _n x 1]
+void eqflms_cccf_execute_training(eqflms_cccf     _q,
+                                  float complex * _x,
+                                  float complex * _d,
+                                  unsigned int    _n,
+                                  float complex * _y)
+{
+    eqflms_cccf_run(_q, _x, _d, 1, _n, _y);
+}
+
+// retrieve internal filter coefficients, y[n] = sum w[k] x[n-k]
+void eqflms_cccf_get_weights(eqflms_cccf     _q,
+                             float complex * _w)
+{
+    memmove(_w, _q->h, _q->h_len*sizeof(float complex));
+}
+
+// train equalizer object on group of samples
+//  _q      :   equalizer object
+//  _w      :   initial weights / output weights [size: h_len x 1]
+//  _x      :   received sample vector [size: _n x 1]
+//  _d      :   desired output vector [size: _n x 1]
+//  _n      :   vector length
+void eqflms_cccf_train(eqflms_cccf     _q,
+                       float complex * _w,
+                       float complex * _x,
+                       float complex * _d,
+                       unsigned int    _n)
+{
+    unsigned int M = _q->h_len;
+    if (_n < 2*M) {
+        fprintf(stderr,"warning: eqflms_cccf_train(), training sequence less than two blocks\n");
+    }
+
+    // reset equalizer state and set initial weights (given in the
+    // same order as the output weights)
+    eqflms_cccf_reset(_q);
+    unsigned int i;
+    float complex w[M];
+    for (i=0; i<M; i++)
+        w[i] = conjf(_w[M-i-1]);
+    eqflms_cccf_set_taps(_q, w);
+
+    // run through training sequence in blocks
+    float complex y[M];
+    for (i=0; i<_n; i+=M) {
+        unsigned int n = _n - i < M ? _n - i : M;
+        eqflms_cccf_run(_q, &_x[i], &_d[i], 1, n, y);
+    }
+
+    // copy output weight vector
+    eqflms_cccf_get_weights(_q, _w);
+}
+
+//
+// internal methods
+//
+
+// filter current block in the frequency domain (block complete)
+void eqflms_cccf_filter_block(eqflms_cccf     _q,
+                              float complex * _y)
+{
+    unsigned int i;
+    unsigned int M = _q->h_len;
+
+    // overlap-save: Y = X W, keeping last h_len outputs
+    fft_execute(_q->fft_x);
+    _q->X_valid = 1;
+    for (i=0; i<_q->nfft; i++)
+        _q->buf_freq[i] = _q->X[i] * _q->W[i];
+    fft_execute(_q->ifft);
+
+    float g = 1.0f / (float)_q->nfft;
+    for (i=0; i<M; i++)
+        _y[i] = _q->buf_time[M+i] * g;
+}
+
+// update weights from errors of current block and advance block
+void eqflms_cccf_update_block(eqflms_cccf _q)
+{
+    unsigned int i;
+    unsigned int M = _q->h_len;
+
+    // input transform, unless already computed by the
+    // frequency-domain filter
+    if (!_q->X_valid)
+        fft_execute(_q->fft_x);
+
+    // gradient: correlate error with input, keeping causal half
+    memset(_q->buf_time, 0, M*sizeof(float complex));
+    memmove(&_q->buf_time[M], _q->e, M*sizeof(float complex));
+    fft_execute(_q->fft);
+    for (i=0; i<_q->nfft; i++)
+        _q->buf_freq[i] *= conjf(_q->X[i]);
+    fft_execute(_q->ifft);
+
+    // normalized step: mu / (nfft sum{|x|^2}) over current block
+    float x2 = liquid_sumsqcf(&_q->x[M], M);
+    float g  = _q->mu / ((float)_q->nfft * (x2 + 1e-12f));
+    for (i=0; i<M; i++)
+        _q->h[i] += g * _q->buf_time[i];
+
+    // transform constrained taps
+    memmove(_q->buf_time, _q->h, M*sizeof(float complex));
+    memset(&_q->buf_time[M], 0, M*sizeof(float complex));
+    fft_execute(_q->fft);
+    memmove(_q->W, _q->buf_freq, _q->nfft*sizeof(float complex));
+
+    // advance block
+    memmove(_q->x, &_q->x[M], M*sizeof(float complex));
+    _q->pos     = 0;
+    _q->X_valid = 0;
+}
@@ -23,6 +23,13 @@
 //
 // Least mean-squares (LMS) equalizer
 //
+// Input samples are appended to a linear buffer whose last h_len
+// values form the current window. A training step only computes its
+// update gain; the weight update itself is deferred and applied by
+// the next dot product in the same pass over the weights (see
+// eqlms_kernels.c). Windows of pending updates stay valid until the
+// buffer is compacted, at which point the update is applied on its own.
+//
 
 #include <math.h>
 #include <stdlib.h>
@@ -31,6 +38,17 @@
 
 //#define DEBUG
 
+#if T_COMPLEX
+#  define EQLMS_CONJ(x)     conjf(x)
+#  define EQLMS_KERNEL      liquid_eqlms_update_dot_cf
+#else
+#  define EQLMS_CONJ(x)     (x)
+#  define EQLMS_KERNEL      liquid_eqlms_update_dot_f
+#endif
+
+// minimum number of samples appended between buffer compactions
+#define EQLMS_BUFFER_EXTRA  (256)
+
 struct EQLMS(_s) {
     unsigned int h_len;     // filter length
     float        mu;        // LMS step size
@@ -38,17 +56,26 @@ struct EQLMS(_s) {
     // internal matrices
     T *          h0;        // initial coefficients
     T *          w0;        // weights [px1]
-    T *          w1;        // weights [px1]
 
     unsigned int count;     // input sample count
     int          buf_full;  // input buffer full flag
-    WINDOW()     buffer;    // input buffer
+    T *          buf;       // input buffer, window is last h_len values
+    unsigned int buf_len;   // allocated length of input buffer
+    unsigned int buf_index; // number of values in input buffer
     wdelayf      x2;        // buffer of |x|^2 values
     float        x2_sum;    // sum{ |x|^2 }
+
+    // deferred weight update
+    int          pending;   // update not yet applied to weights
+    T            g;         // update gain
+    unsigned int r0_index;  // buffer index of update window
 };
 
 // update sum{|x|^2}
-void EQLMS(_update_sumsq)(EQLMS() _q, T _x);
+static void EQLMS(_update_sumsq)(EQLMS() _q, T _x);
+
+// apply pending weight update
+static void EQLMS(_flush)(EQLMS() _q);
 
 // create least mean-squares (LMS) equalizer object
 //  _h      :   initial coefficients [size: _h_len x 1], default if NULL
@@ -56,17 +83,17 @@ void EQLMS(_update_sumsq)(EQLMS() _q, T _x);
 EQLMS() EQLMS(_create)(T *          _h,
                        unsigned int _h_len)
 {
-    EQLMS() q = (EQLMS()) malloc(sizeof(struct EQLMS(_s)));
+    EQLMS() q = (EQLMS()) liquid_malloc(sizeof(struct EQLMS(_s)));
 
     // set filter order, other params
     q->h_len = _h_len;
     q->mu    = 0.5f;
 
-    q->h0 = (T*) malloc((q->h_len)*sizeof(T));
-    q->w0 = (T*) malloc((q->h_len)*sizeof(T));
-    q->w1 = (T*) malloc((q->h_len)*sizeof(T));
-    q->buffer = WINDOW(_create)(q->h_len);
-    q->x2     = wdelayf_create(q->h_len);
+    q->h0 = (T*) liquid_malloc((q->h_len)*sizeof(T));
+    q->w0 = (T*) liquid_malloc((q->h_len)*sizeof(T));
+    q->buf_len = q->h_len + (q->h_len > EQLMS_BUFFER_EXTRA ? q->h_len : EQLMS_BUFFER_EXTRA);
+    q->buf     = (T*) liquid_malloc((q->buf_len)*sizeof(T));
+    q->x2      = wdelayf_create(q->h_len);
 
     // copy coefficients (if not NULL)
     if (_h == NULL) {
@@ -186,13 +213,12 @@ EQLMS() EQLMS(_recreate)(EQLMS()      _q,
 // destroy eqlms object
 void EQLMS(_destroy)(EQLMS() _q)
 {
-    free(_q->h0);
-    free(_q->w0);
-    free(_q->w1);
+    liquid_free(_q->h0);
+    liquid_free(_q->w0);
+    liquid_free(_q->buf);
 
-    WINDOW(_destroy)(_q->buffer);
     wdelayf_destroy(_q->x2);
-    free(_q);
+    liquid_free(_q);
 }
 
 // reset equalizer
@@ -200,8 +226,11 @@ void EQLMS(_reset)(EQLMS() _q)
 {
     // copy default coefficients
     memmove(_q->w0, _q->h0, (_q->h_len)*sizeof(T));
+    _q->pending = 0;
 
-    WINDOW(_clear)(_q->buffer);
+    // clear window
+    memset(_q->buf, 0x00, (_q->h_len)*sizeof(T));
+    _q->buf_index = _q->h_len;
     wdelayf_clear(_q->x2);
 
     // reset input count
@@ -217,11 +246,21 @@ void EQLMS(_print)(EQLMS() _q)
 {
     printf("equalizer (LMS):\n");
     printf("    order:      %u\n", _q->h_len);
+    EQLMS(_flush)(_q);
     unsigned int i;
     for (i=0; i<_q->h_len; i++)
         printf("  h(%3u) = %12.4e + j*%12.4e;\n", i+1, creal(_q->w0[i]), cimag(_q->w0[i]));
 }
 
+// get memory footprint of object, weights and input buffers [bytes]
+unsigned long int EQLMS(_get_memory_usage)(EQLMS() _q)
+{
+    return sizeof(struct EQLMS(_s))
+         + 2*_q->h_len*sizeof(T)                    // h0, w0
+         + _q->buf_len*sizeof(T)                    // input buffer
+         + wdelayf_get_memory_usage(_q->x2);
+}
+
 // get learning rate of equalizer
 float EQLMS(_get_bw)(EQLMS() _q)
 {
@@ -248,8 +287,16 @@ void EQLMS(_set_bw)(EQLMS() _q,
 void EQLMS(_push)(EQLMS() _q,
                   T _x)
 {
+    // compact buffer when full, keeping the last h_len-1 values
+    if (_q->buf_index == _q->buf_len) {
+        // window of pending update is about to be overwritten
+        EQLMS(_flush)(_q);
+        memmove(_q->buf, _q->buf + _q->buf_len - _q->h_len + 1, (_q->h_len-1)*sizeof(T));
+        _q->buf_index = _q->h_len - 1;
+    }
+
     // push value into buffer
-    WINDOW(_push)(_q->buffer, _x);
+    _q->buf[_q->buf_index++] = _x;
 
     // update sum{|x|^2}
     EQLMS(_update_sumsq)(_q, _x);
@@ -277,20 +324,11 @@ void EQLMS(_push_block)(EQLMS()      _q,
 void EQLMS(_execute)(EQLMS() _q,
                      T *     _y)
 {
-    T y = 0;    // temporary accumulator
-    T * r;      // read buffer
-    WINDOW(_read)(_q->buffer, &r);
-
-    // compute conjugate vector dot product
-    //DOTPROD(_run)(_q->w0, r, _q->h_len, &y);
-    unsigned int i;
-    for (i=0; i<_q->h_len; i++) {
-        T sum = conj(_q->w0[i])*r[i];
-        y += sum;
-    }
-
-    // set output
-    *_y = y;
+    // compute conjugate vector dot product, applying pending update
+    T * r0 = _q->pending ? _q->buf + _q->r0_index : NULL;
+    T * r1 = _q->buf + _q->buf_index - _q->h_len;
+    EQLMS_KERNEL(_q->w0, _q->g, r0, r1, _q->h_len, _y);
+    _q->pending = 0;
 }
 
 // execute equalizer with block of samples using constant
@@ -349,35 +387,17 @@ void EQLMS(_step)(EQLMS() _q,
             _q->buf_full = 1;
     }
 
-    unsigned int i;
+    // only one update may be pending
+    EQLMS(_flush)(_q);
 
     // compute error (a priori)
     T alpha = _d - _d_hat;
 
-    // read buffer
-    T * r;      // read buffer
-    WINDOW(_read)(_q->buffer, &r);
-
-    // update weighting vector
+    // defer update of weighting vector to next dot product
     // w[n+1] = w[n] + mu*conj(d-d_hat)*x[n]/(x[n]' * conj(x[n]))
-    for (i=0; i<_q->h_len; i++)
-        _q->w1[i] = _q->w0[i] + (_q->mu)*conj(alpha)*r[i]/_q->x2_sum;
-
-#ifdef DEBUG
-    printf("w0: \n");
-    for (i=0; i<_q->h_len; i++) {
-        PRINTVAL(_q->w0[i]);
-        printf("\n");
-    }
-    printf("w1: \n");
-    for (i=0; i<_q->h_len; i++) {
-        PRINTVAL(_q->w1[i]);
-        printf("\n");
-    }
-#endif
-
-    // copy old values
-    memmove(_q->w0, _q->w1, _q->h_len*sizeof(T));
+    _q->g        = (_q->mu)*EQLMS_CONJ(alpha)/_q->x2_sum;
+    _q->r0_index = _q->buf_index - _q->h_len;
+    _q->pending  = 1;
 }
 
 // step through one cycle of equalizer training
@@ -398,10 +418,13 @@ void EQLMS(_step_blind)(EQLMS() _q,
 // retrieve internal filter coefficients
 void EQLMS(_get_weights)(EQLMS() _q, T * _w)
 {
+    // apply pending update
+    EQLMS(_flush)(_q);
+
     // copy output weight vector
     unsigned int i;
     for (i=0; i<_q->h_len; i++)
-        _w[i] = conj(_q->w0[_q->h_len-i-1]);
+        _w[i] = EQLMS_CONJ(_q->w0[_q->h_len-i-1]);
 }
 
 // train equalizer object
@@ -430,20 +453,52 @@ void EQLMS(_train)(EQLMS()      _q,
     for (i=0; i<p; i++)
         _q->w0[i] = _w[p - i - 1];
 
+    // run training sequence
+    EQLMS(_train_block)(_q, 1, _x, _d, _n, NULL);
+
+    // copy output weight vector
+    EQLMS(_get_weights)(_q, _w);
+}
+
+// run equalizer over a block of symbols, training on each
+//  _q      :   equalizer object
+//  _k      :   samples per symbol
+//  _x      :   input sample array [size: _k*_n x 1]
+//  _d      :   desired output array [size: _n x 1], NULL for blind
+//  _n      :   number of symbols
+//  _y      :   equalizer output array [size: _n x 1], ignored if NULL
+void EQLMS(_train_block)(EQLMS()      _q,
+                         unsigned int _k,
+                         T *          _x,
+                         T *          _d,
+                         unsigned int _n,
+                         T *          _y)
+{
+    if (_k == 0) {
+        fprintf(stderr,"error: eqlms_%s_train_block(), samples per symbol 'k' must be greater than 0\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    unsigned int i;
+    unsigned int j;
     T d_hat;
     for (i=0; i<_n; i++) {
-        // push sample into internal buffer
-        EQLMS(_push)(_q, _x[i]);
+        // push symbol samples into internal buffer
+        for (j=0; j<_k; j++)
+            EQLMS(_push)(_q, _x[i*_k+j]);
 
-        // execute vector dot product
+        // compute output, applying update of previous symbol
         EQLMS(_execute)(_q, &d_hat);
 
         // step through training cycle
-        EQLMS(_step)(_q, _d[i], d_hat);
-    }
+        if (_d == NULL)
+            EQLMS(_step_blind)(_q, d_hat);
+        else
+            EQLMS(_step)(_q, _d[i], d_hat);
 
-    // copy output weight vector
-    EQLMS(_get_weights)(_q, _w);
+        if (_y != NULL)
+            _y[i] = d_hat;
+    }
 }
 
 // 
@@ -451,7 +506,7 @@ void EQLMS(_train)(EQLMS()      _q,
 //
 
 // update sum{|x|^2}
-void EQLMS(_update_sumsq)(EQLMS() _q, T _x)
+static void EQLMS(_update_sumsq)(EQLMS() _q, T _x)
 {
     // update estimate of signal magnitude squared
     // |x[n-1]|^2 (input sample)
@@ -470,3 +525,12 @@ void EQLMS(_update_sumsq)(EQLMS() _q, T _x)
     _q->x2_sum = _q->x2_sum + x2_n - x2_0;
 }
 
+// apply pending weight update
+static void EQLMS(_flush)(EQLMS() _q)
+{
+    if (!_q->pending)
+        return;
+
+    EQLMS_KERNEL(_q->w0, _q->g, _q->buf + _q->r0_index, NULL, _q->h_len, NULL);
+    _q->pending = 0;
+}
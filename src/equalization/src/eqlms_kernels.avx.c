@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// eqlms_kernels.avx.c : fused weight update and dot product kernels
+// for eqlms (x86 AVX2)
+//
+// Four complex (eight real) weights are processed per iteration with
+// weights and windows held interleaved (re,im); the complex update
+// w += g r0 uses fmaddsub against the swapped window, and the
+// conjugate dot product keeps two accumulators, w.*r1 and w.*swap(r1),
+// which are reduced after the loop. Results agree with the portable
+// kernels to within floating-point rounding.
+//
+
+#include <immintrin.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+// horizontal sum of eight values
+__attribute__((target("avx2,fma")))
+static inline float liquid_eqlms_hsum8(__m256 _v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(_v), _mm256_extractf128_ps(_v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+// fused complex kernel (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_eqlms_update_dot_cf_avx2(float complex *       _w,
+                                     float complex         _g,
+                                     const float complex * _r0,
+                                     const float complex * _r1,
+                                     unsigned int          _n,
+                                     float complex *       _y)
+{
+    float *       w    = (float*) _w;
+    const float * r0   = (const float*) _r0;
+    const float * r1   = (const float*) _r1;
+    float         g_re = crealf(_g);
+    float         g_im = cimagf(_g);
+    __m256 gr = _mm256_set1_ps(g_re);
+    __m256 gi = _mm256_set1_ps(g_im);
+    __m256 a0 = _mm256_setzero_ps();    // [w_re r_re, w_im r_im]
+    __m256 a1 = _mm256_setzero_ps();    // [w_re r_im, w_im r_re]
+
+    unsigned int n = 2*_n;
+    unsigned int i;
+    for (i=0; i+8<=n; i+=8) {
+        __m256 wv = _mm256_loadu_ps(&w[i]);
+        if (r0 != NULL) {
+            __m256 x = _mm256_loadu_ps(&r0[i]);
+            __m256 t = _mm256_fmaddsub_ps(x, gr, _mm256_mul_ps(_mm256_permute_ps(x, 0xb1), gi));
+            wv = _mm256_add_ps(wv, t);
+            _mm256_storeu_ps(&w[i], wv);
+        }
+        if (r1 != NULL) {
+            __m256 x = _mm256_loadu_ps(&r1[i]);
+            a0 = _mm256_fmadd_ps(wv, x, a0);
+            a1 = _mm256_fmadd_ps(wv, _mm256_permute_ps(x, 0xb1), a1);
+        }
+    }
+
+    // reduce: y_re = sum(even + odd) of a0, y_im = sum(even - odd) of a1
+    __m256 sign = _mm256_setr_ps(1,-1,1,-1,1,-1,1,-1);
+    float y_re = liquid_eqlms_hsum8(a0);
+    float y_im = liquid_eqlms_hsum8(_mm256_mul_ps(a1, sign));
+
+    // remaining weights
+    for ( ; i<n; i+=2) {
+        if (r0 != NULL) {
+            float w_re = w[i]   + g_re*r0[i]   - g_im*r0[i+1];
+            float w_im = w[i+1] + g_re*r0[i+1] + g_im*r0[i];
+            w[i]   = w_re;
+            w[i+1] = w_im;
+        }
+        if (r1 != NULL) {
+            y_re += w[i]*r1[i]   + w[i+1]*r1[i+1];
+            y_im += w[i]*r1[i+1] - w[i+1]*r1[i];
+        }
+    }
+    if (_y != NULL)
+        *_y = y_re + _Complex_I*y_im;
+}
+
+// fused real kernel (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_eqlms_update_dot_f_avx2(float *       _w,
+                                    float         _g,
+                                    const float * _r0,
+                                    const float * _r1,
+                                    unsigned int  _n,
+                                    float *       _y)
+{
+    __m256 g   = _mm256_set1_ps(_g);
+    __m256 acc = _mm256_setzero_ps();
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 wv = _mm256_loadu_ps(&_w[i]);
+        if (_r0 != NULL) {
+            wv = _mm256_fmadd_ps(g, _mm256_loadu_ps(&_r0[i]), wv);
+            _mm256_storeu_ps(&_w[i], wv);
+        }
+        if (_r1 != NULL)
+            acc = _mm256_fmadd_ps(wv, _mm256_loadu_ps(&_r1[i]), acc);
+    }
+    float y = liquid_eqlms_hsum8(acc);
+    for ( ; i<_n; i++) {
+        if (_r0 != NULL)
+            _w[i] += _g*_r0[i];
+        if (_r1 != NULL)
+            y += _w[i]*_r1[i];
+    }
+    if (_y != NULL)
+        *_y = y;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// eqlms_kernels.c : fused weight update and dot product kernels for
+// eqlms (portable C)
+//
+// The weight update of one training step and the dot product of the
+// next output share a single pass over the weights: each weight is
+// updated with the window of the step and immediately multiplied with
+// the window of the output. Real and imaginary parts are kept in
+// separate accumulators so the loops vectorize.
+//
+
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+// fused complex kernel (see liquid.internal.h)
+void liquid_eqlms_update_dot_cf(float complex *       _w,
+                                float complex         _g,
+                                const float complex * _r0,
+                                const float complex * _r1,
+                                unsigned int          _n,
+                                float complex *       _y)
+{
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_EQUALIZER) == LIQUID_SIMD_AVX2) {
+        liquid_eqlms_update_dot_cf_avx2(_w, _g, _r0, _r1, _n, _y);
+        return;
+    }
+#endif
+    float *       w    = (float*) _w;
+    const float * r0   = (const float*) _r0;
+    const float * r1   = (const float*) _r1;
+    float         g_re = crealf(_g);
+    float         g_im = cimagf(_g);
+    float         y_re = 0.0f;
+    float         y_im = 0.0f;
+    unsigned int i;
+    if (_r0 == NULL) {
+        // dot product only
+        for (i=0; i<2*_n; i+=2) {
+            y_re += w[i]*r1[i]   + w[i+1]*r1[i+1];
+            y_im += w[i]*r1[i+1] - w[i+1]*r1[i];
+        }
+    } else if (_r1 == NULL) {
+        // weight update only
+        for (i=0; i<2*_n; i+=2) {
+            float w_re = w[i]   + g_re*r0[i]   - g_im*r0[i+1];
+            float w_im = w[i+1] + g_re*r0[i+1] + g_im*r0[i];
+            w[i]   = w_re;
+            w[i+1] = w_im;
+        }
+    } else {
+        // w += g r0, y = w^H r1
+        for (i=0; i<2*_n; i+=2) {
+            float w_re = w[i]   + g_re*r0[i]   - g_im*r0[i+1];
+            float w_im = w[i+1] + g_re*r0[i+1] + g_im*r0[i];
+            w[i]   = w_re;
+            w[i+1] = w_im;
+            y_re += w_re*r1[i]   + w_im*r1[i+1];
+            y_im += w_re*r1[i+1] - w_im*r1[i];
+        }
+    }
+    if (_y != NULL)
+        *_y = y_re + _Complex_I*y_im;
+}
+
+// fused real kernel (see liquid.internal.h)
+void liquid_eqlms_update_dot_f(float *       _w,
+                               float         _g,
+                               const float * _r0,
+                               const float * _r1,
+                               unsigned int  _n,
+                               float *       _y)
+{
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_EQUALIZER) == LIQUID_SIMD_AVX2) {
+        liquid_eqlms_update_dot_f_avx2(_w, _g, _r0, _r1, _n, _y);
+        return;
+    }
+#endif
+    float y = 0.0f;
+    unsigned int i;
+    if (_r0 == NULL) {
+        for (i=0; i<_n; i++)
+            y += _w[i]*_r1[i];
+    } else if (_r1 == NULL) {
+        for (i=0; i<_n; i++)
+            _w[i] += _g*_r0[i];
+    } else {
+        for (i=0; i<_n; i++) {
+            _w[i] += _g*_r0[i];
+            y += _w[i]*_r1[i];
+        }
+    }
+    if (_y != NULL)
+        *_y = y;
+}
@@ -23,13 +23,40 @@
 //
 // Recursive least-squares (RLS) equalizer
 //
+// The default object runs the conventional O(p^2) recursion on the
+// inverse correlation matrix.  Objects created with EQRLS(_create_fast)
+// instead run the stabilized fast transversal filter (FTF) of Slock and
+// Kailath, which propagates forward/backward predictors and the a priori
+// gain vector in O(p) operations per sample.  The stabilization feeds
+// back the difference between the two available estimates of the
+// backward prediction error; should the conversion factor still leave
+// (0,1] the predictor state is re-initialized ("rescued") while the
+// joint-process weights are kept.
+//
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 //#define DEBUG
 
+#if T_COMPLEX
+#  define EQRLS_CONJ(x)     conjf(x)
+#  define EQRLS_ABS2(x)     (crealf(x)*crealf(x) + cimagf(x)*cimagf(x))
+#else
+#  define EQRLS_CONJ(x)     (x)
+#  define EQRLS_ABS2(x)     ((x)*(x))
+#endif
+
+// FTF stabilization constants (Slock & Kailath, 1991)
+#define EQRLS_FTF_K1    (1.5f)
+#define EQRLS_FTF_K2    (2.5f)
+
+// rescue threshold on the squared discrepancy between the two backward
+// prediction error estimates, relative to its expected variance
+#define EQRLS_FTF_RESCUE (100.0f)
+
 struct EQRLS(_s) {
     unsigned int p;     // filter order
     float lambda;       // RLS forgetting factor
@@ -50,8 +77,28 @@ struct EQRLS(_s) {
 
     unsigned int n;     // input counter
     WINDOW() buffer;    // input buffer
+
+    // fast transversal filter (FTF) state
+    int fast;           // use FTF recursion?
+    WINDOW() ubuf;      // extended regressor [(p+1)x1]
+    T * fa;             // forward predictor [px1]
+    T * fb;             // backward predictor [px1]
+    T * kt;             // a priori gain, newest sample first [px1]
+    T * kt1;            // extended a priori gain [(p+1)x1]
+    float gamma_inv;    // inverse conversion factor
+    float xi_f;         // forward prediction error energy
+    float xi_b;         // backward prediction error energy
+    unsigned int num_rescues;   // number of predictor re-initializations
 };
 
+// initialize fast transversal filter predictor state
+//  _q      :   equalizer object
+//  _delta  :   initial forward prediction error energy
+static void EQRLS(_ftf_init)(EQRLS() _q, float _delta);
+
+// update fast transversal filter predictors with newest sample
+static void EQRLS(_ftf_update)(EQRLS() _q);
+
 
 // create recursive least-squares (RLS) equalizer object
 //  _h      :   initial coefficients [size: _p x 1], default if NULL
@@ -59,24 +106,31 @@ struct EQRLS(_s) {
 EQRLS() EQRLS(_create)(T *          _h,
                        unsigned int _p)
 {
-    EQRLS() q = (EQRLS()) malloc(sizeof(struct EQRLS(_s)));
+    EQRLS() q = (EQRLS()) liquid_malloc(sizeof(struct EQRLS(_s)));
 
     // set filter order, other parameters
     q->p      = _p;     // filter order
     q->lambda = 0.99f;  // learning rate
     q->delta  = 0.1f;   // initialization factor
+    q->fast   = 0;      // conventional recursion
+
+    q->ubuf = NULL;
+    q->fa   = NULL;
+    q->fb   = NULL;
+    q->kt   = NULL;
+    q->kt1  = NULL;
 
     // allocate memory for matrices
-    q->h0 = (T*) malloc((q->p)*sizeof(T));
-    q->w0 = (T*) malloc((q->p)*sizeof(T));
-    q->w1 = (T*) malloc((q->p)*sizeof(T));
-    q->P0 = (T*) malloc((q->p)*(q->p)*sizeof(T));
-    q->P1 = (T*) malloc((q->p)*(q->p)*sizeof(T));
-    q->g  = (T*) malloc((q->p)*sizeof(T));
+    q->h0 = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->w0 = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->w1 = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->P0 = (T*) liquid_malloc((q->p)*(q->p)*sizeof(T));
+    q->P1 = (T*) liquid_malloc((q->p)*(q->p)*sizeof(T));
+    q->g  = (T*) liquid_malloc((q->p)*sizeof(T));
 
-    q->xP0 =   (T*) malloc((q->p)*sizeof(T));
-    q->gxl =   (T*) malloc((q->p)*(q->p)*sizeof(T));
-    q->gxlP0 = (T*) malloc((q->p)*(q->p)*sizeof(T));
+    q->xP0 =   (T*) liquid_malloc((q->p)*sizeof(T));
+    q->gxl =   (T*) liquid_malloc((q->p)*(q->p)*sizeof(T));
+    q->gxlP0 = (T*) liquid_malloc((q->p)*(q->p)*sizeof(T));
 
     q->buffer = WINDOW(_create)(q->p);
 
@@ -98,6 +152,59 @@ EQRLS() EQRLS(_create)(T *          _h,
     return q;
 }
 
+// create recursive least-squares (RLS) equalizer object using the
+// O(p) fast transversal filter recursion
+//  _h      :   initial coefficients [size: _p x 1], default if NULL
+//  _p      :   equalizer length (number of taps)
+EQRLS() EQRLS(_create_fast)(T *          _h,
+                            unsigned int _p)
+{
+    EQRLS() q = (EQRLS()) liquid_malloc(sizeof(struct EQRLS(_s)));
+
+    // set filter order, other parameters
+    q->p      = _p;     // filter order
+    q->lambda = 0.99f;  // learning rate
+    q->delta  = 0.1f;   // initialization factor
+    q->fast   = 1;      // fast transversal filter recursion
+
+    // allocate memory for vectors; no [pxp] matrices are needed
+    q->h0 = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->w0 = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->w1 = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->P0 = NULL;
+    q->P1 = NULL;
+    q->g  = NULL;
+
+    q->xP0   = NULL;
+    q->gxl   = NULL;
+    q->gxlP0 = NULL;
+
+    q->fa  = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->fb  = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->kt  = (T*) liquid_malloc((q->p)*sizeof(T));
+    q->kt1 = (T*) liquid_malloc((q->p+1)*sizeof(T));
+
+    q->buffer = WINDOW(_create)(q->p);
+    q->ubuf   = WINDOW(_create)(q->p+1);
+
+    // copy coefficients (if not NULL)
+    if (_h == NULL) {
+        // initial coefficients with delta at first index
+        unsigned int i;
+        for (i=0; i<q->p; i++)
+            q->h0[i] = (i==0) ? 1.0 : 0.0;
+    } else {
+        // copy user-defined initial coefficients
+        memmove(q->h0, _h, (q->p)*sizeof(T));
+    }
+
+    // reset equalizer
+    EQRLS(_reset)(q);
+
+    // return object
+    return q;
+}
+
 
 // re-create recursive least-squares (RLS) equalizer object
 //  _q  : old equalizer object
@@ -116,33 +223,42 @@ EQRLS() EQRLS(_recreate)(EQRLS()      _q,
         return _q;
     }
 
-    // completely destroy old equalizer object
+    // completely destroy old equalizer object, retaining its recursion
+    int fast = _q->fast;
     EQRLS(_destroy)(_q);
 
     // create new one and return
-    return EQRLS(_create)(_h,_p);
+    return fast ? EQRLS(_create_fast)(_h,_p) : EQRLS(_create)(_h,_p);
 }
 
 // destroy eqrls object
 void EQRLS(_destroy)(EQRLS() _q)
 {
     // free vectors and matrices
-    free(_q->h0);
-    free(_q->w0);
-    free(_q->w1);
-    free(_q->P0);
-    free(_q->P1);
-    free(_q->g);
-
-    free(_q->xP0);
-    free(_q->gxl);
-    free(_q->gxlP0);
-
-    // destroy window buffer
+    liquid_free(_q->h0);
+    liquid_free(_q->w0);
+    liquid_free(_q->w1);
+    liquid_free(_q->P0);
+    liquid_free(_q->P1);
+    liquid_free(_q->g);
+
+    liquid_free(_q->xP0);
+    liquid_free(_q->gxl);
+    liquid_free(_q->gxlP0);
+
+    // free fast transversal filter state
+    liquid_free(_q->fa);
+    liquid_free(_q->fb);
+    liquid_free(_q->kt);
+    liquid_free(_q->kt1);
+
+    // destroy window buffers
     WINDOW(_destroy)(_q->buffer);
+    if (_q->ubuf != NULL)
+        WINDOW(_destroy)(_q->ubuf);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print eqrls object internals
@@ -150,8 +266,13 @@ void EQRLS(_print)(EQRLS() _q)
 {
     printf("equalizer (RLS):\n");
     printf("    order:      %u\n", _q->p);
+    printf("    recursion:  %s\n", _q->fast ? "fast transversal filter" : "conventional");
+    if (_q->fast)
+        printf("    rescues:    %u\n", _q->num_rescues);
 
 #ifdef DEBUG
+    if (_q->fast)
+        return;
     unsigned int r,c,p=_q->p;
     printf("P0:\n");
     for (r=0; r<p; r++) {
@@ -185,6 +306,21 @@ void EQRLS(_reset)(EQRLS() _q)
     // reset input counter
     _q->n = 0;
 
+    // copy default coefficients
+    memmove(_q->w0, _q->h0, (_q->p)*sizeof(T));
+    memmove(_q->w1, _q->h0, (_q->p)*sizeof(T));
+
+    // clear window object
+    WINDOW(_clear)(_q->buffer);
+
+    if (_q->fast) {
+        // reset predictors and extended regressor
+        WINDOW(_clear)(_q->ubuf);
+        EQRLS(_ftf_init)(_q, _q->delta);
+        _q->num_rescues = 0;
+        return;
+    }
+
     unsigned int i, j;
     // initialize...
     for (i=0; i<_q->p; i++) {
@@ -193,12 +329,6 @@ void EQRLS(_reset)(EQRLS() _q)
             else        _q->P0[(_q->p)*i + j] = 0;
         }
     }
-
-    // copy default coefficients
-    memmove(_q->w0, _q->h0, (_q->p)*sizeof(T));
-
-    // clear window object
-    WINDOW(_clear)(_q->buffer);
 }
 
 // get learning rate of equalizer
@@ -220,6 +350,10 @@ void EQRLS(_set_bw)(EQRLS() _q,
 
     // set internal value
     _q->lambda = _lambda;
+
+    // the initial backward energy depends upon lambda
+    if (_q->fast)
+        EQRLS(_ftf_init)(_q, _q->delta);
 }
 
 // push sample into equalizer internal buffer
@@ -230,6 +364,13 @@ void EQRLS(_push)(EQRLS() _q,
 {
     // push value into buffer
     WINDOW(_push)(_q->buffer, _x);
+
+    // the predictors depend only upon the input; update them here so
+    // that step() only has to adjust the joint-process weights
+    if (_q->fast) {
+        WINDOW(_push)(_q->ubuf, _x);
+        EQRLS(_ftf_update)(_q);
+    }
 }
 
 // execute internal dot product
@@ -259,6 +400,16 @@ void EQRLS(_step)(EQRLS() _q,
     // compute error (a priori)
     T alpha = _d - _d_hat;
 
+    if (_q->fast) {
+        // w += gamma * conj(kt) * alpha; kt is ordered newest sample
+        // first whereas w0 is aligned to the buffer (oldest first)
+        T ga = alpha / _q->gamma_inv;
+        for (i=0; i<p; i++)
+            _q->w0[p-i-1] += EQRLS_CONJ(_q->kt[i]) * ga;
+        memmove(_q->w1, _q->w0, p*sizeof(T));
+        return;
+    }
+
     // read buffer
     T * x;
     WINDOW(_read)(_q->buffer, &x);
@@ -356,6 +507,87 @@ void EQRLS(_step)(EQRLS() _q,
 
 }
 
+// initialize fast transversal filter predictor state; the
+// soft-constrained initial correlation delta*diag(1,1/lambda,...)
+// keeps the forward and backward partitions consistent
+static void EQRLS(_ftf_init)(EQRLS() _q, float _delta)
+{
+    memset(_q->fa, 0x00, (_q->p)*sizeof(T));
+    memset(_q->fb, 0x00, (_q->p)*sizeof(T));
+    memset(_q->kt, 0x00, (_q->p)*sizeof(T));
+    _q->gamma_inv = 1.0f;
+    _q->xi_f      = _delta;
+    _q->xi_b      = _delta * powf(_q->lambda, -(float)(_q->p));
+}
+
+// update fast transversal filter predictors with newest sample
+static void EQRLS(_ftf_update)(EQRLS() _q)
+{
+    unsigned int i;
+    unsigned int p   = _q->p;
+    float        lam = _q->lambda;
+
+    // extended regressor: u[p] is the newest sample, u[0] the sample
+    // which just dropped out of the length-p window
+    T * u;
+    WINDOW(_read)(_q->ubuf, &u);
+
+    // forward a priori prediction error (previous regressor)
+    T eta = u[p];
+    for (i=0; i<p; i++)
+        eta -= EQRLS_CONJ(_q->fa[i]) * u[p-1-i];
+
+    // extended a priori gain: [0; kt] + eta/(lambda xi_f) [1; -a]
+    T   v = eta / (lam * _q->xi_f);
+    _q->kt1[0] = v;
+    for (i=0; i<p; i++)
+        _q->kt1[i+1] = _q->kt[i] - v * _q->fa[i];
+    float gamma_inv1 = _q->gamma_inv + crealf(EQRLS_CONJ(eta) * v);
+
+    // forward predictor update uses the previous gain and conversion
+    float gamma = 1.0f / _q->gamma_inv;
+    T     ge    = EQRLS_CONJ(eta) * gamma;
+    for (i=0; i<p; i++)
+        _q->fa[i] += _q->kt[i] * ge;
+    _q->xi_f = lam*_q->xi_f + gamma*EQRLS_ABS2(eta);
+
+    // backward a priori prediction error, computed both directly from the
+    // filter and from the last element of the extended gain
+    T kl    = _q->kt1[p];
+    T psi_f = u[0];
+    for (i=0; i<p; i++)
+        psi_f -= EQRLS_CONJ(_q->fb[i]) * u[p-i];
+    T psi_s = lam * _q->xi_b * kl;
+    T psi_1 = EQRLS_FTF_K1*psi_f + (1.0f-EQRLS_FTF_K1)*psi_s;
+    T psi_2 = EQRLS_FTF_K2*psi_f + (1.0f-EQRLS_FTF_K2)*psi_s;
+
+    // down-date gain and conversion factor to order p
+    for (i=0; i<p; i++)
+        _q->kt[i] = _q->kt1[i] + kl * _q->fb[i];
+    _q->gamma_inv = gamma_inv1 - crealf(EQRLS_CONJ(psi_1) * kl);
+
+    // rescue: the conversion factor must remain in (0,1] and the two
+    // backward error estimates must agree; re-initialize the predictors
+    // with the current forward energy so the weights are not disturbed
+    // by a fresh start-up transient
+    if ( !(_q->gamma_inv > 1.0f - 1e-3f) || !isfinite(_q->gamma_inv) ||
+         !(_q->xi_f > 0.0f) || !isfinite(_q->xi_f) ||
+         EQRLS_ABS2(psi_f - psi_s) > EQRLS_FTF_RESCUE*(1.0f-lam)*lam*_q->xi_b )
+    {
+        float delta = (isfinite(_q->xi_f) && _q->xi_f > _q->delta) ? lam*_q->xi_f : _q->delta;
+        EQRLS(_ftf_init)(_q, delta);
+        _q->num_rescues++;
+        return;
+    }
+
+    // backward predictor update
+    gamma = 1.0f / _q->gamma_inv;
+    T gp = EQRLS_CONJ(psi_2) * gamma;
+    for (i=0; i<p; i++)
+        _q->fb[i] += _q->kt[i] * gp;
+    _q->xi_b = lam*_q->xi_b + gamma*EQRLS_ABS2(psi_f);
+}
+
 // retrieve internal filter coefficients
 //  _q      :   equalizer object
 //  _w      :   weights [size: _p x 1]
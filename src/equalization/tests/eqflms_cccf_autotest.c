@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST: identify long channel from training sequence
+//
+void eqflms_cccf_test_train(unsigned int _h_len)
+{
+    float        tol = 1e-3f;   // error tolerance
+    unsigned int n   = 40*_h_len;
+    unsigned int i, j;
+
+    // target response: random taps with exponential decay
+    float complex ht[_h_len];
+    for (i=0; i<_h_len; i++)
+        ht[i] = (randnf() + _Complex_I*randnf()) * expf(-4.0f*i/_h_len);
+
+    // training sequence, desired output
+    float complex * x = (float complex*) malloc(n*sizeof(float complex));
+    float complex * d = (float complex*) malloc(n*sizeof(float complex));
+    for (i=0; i<n; i++)
+        x[i] = (rand() & 1 ? M_SQRT1_2 : -M_SQRT1_2) + (rand() & 1 ? M_SQRT1_2 : -M_SQRT1_2)*_Complex_I;
+    for (i=0; i<n; i++) {
+        d[i] = 0;
+        for (j=0; j<_h_len && j<=i; j++)
+            d[i] += ht[j]*x[i-j];
+    }
+
+    // train from zero weights
+    eqflms_cccf q = eqflms_cccf_create(NULL, _h_len);
+    float complex w[_h_len];
+    for (i=0; i<_h_len; i++)
+        w[i] = 0.0f;
+    eqflms_cccf_train(q, w, x, d, n);
+
+    for (i=0; i<_h_len; i++) {
+        CONTEND_DELTA( crealf(w[i]), crealf(ht[i]), tol );
+        CONTEND_DELTA( cimagf(w[i]), cimagf(ht[i]), tol );
+    }
+
+    eqflms_cccf_destroy(q);
+    free(x);
+    free(d);
+}
+void autotest_eqflms_cccf_train_n8()   { eqflms_cccf_test_train(  8); }
+void autotest_eqflms_cccf_train_n64()  { eqflms_cccf_test_train( 64); }
+void autotest_eqflms_cccf_train_n128() { eqflms_cccf_test_train(128); }
+
+// 
+// AUTOTEST: output does not depend on how input is split
+//
+void autotest_eqflms_cccf_split()
+{
+    float        tol   = 1e-4f;
+    unsigned int h_len = 32;
+    unsigned int n     = 1000;
+    unsigned int i;
+
+    float complex * x  = (float complex*) malloc(n*sizeof(float complex));
+    float complex * d  = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(n*sizeof(float complex));
+    for (i=0; i<n; i++) {
+        // QPSK through channel
+        d[i] = (rand() & 1 ? M_SQRT1_2 : -M_SQRT1_2) + (rand() & 1 ? M_SQRT1_2 : -M_SQRT1_2)*_Complex_I;
+        x[i] = i > 0 ? d[i] - 0.3f*_Complex_I*d[i-1] : d[i];
+    }
+
+    // initial weights: delta at most recent sample (eqlms order)
+    float complex h[h_len];
+    for (i=0; i<h_len; i++)
+        h[i] = i == h_len-1 ? 1.0f : 0.0f;
+    eqflms_cccf q0 = eqflms_cccf_create(h, h_len);
+    eqflms_cccf q1 = eqflms_cccf_create(h, h_len);
+
+    // training: single call, calls of varying length
+    eqflms_cccf_execute_training(q0, x, d, n, y0);
+    unsigned int i0 = 0, len = 1;
+    while (i0 < n) {
+        unsigned int m = n - i0 < len ? n - i0 : len;
+        eqflms_cccf_execute_training(q1, &x[i0], &d[i0], m, &y1[i0]);
+        i0 += m;
+        len = (len * 7 + 3) % 71;
+    }
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( cabsf(y0[i]-y1[i]), 0.0f, tol );
+
+    // blind: single call, calls of varying length
+    eqflms_cccf_reset(q0);
+    eqflms_cccf_reset(q1);
+    eqflms_cccf_execute_block(q0, 2, x, n, y0);
+    for (i0=0, len=5; i0<n; i0+=len)
+        eqflms_cccf_execute_block(q1, 2, &x[i0], n-i0 < len ? n-i0 : len, &y1[i0]);
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( cabsf(y0[i]-y1[i]), 0.0f, tol );
+
+    eqflms_cccf_destroy(q0);
+    eqflms_cccf_destroy(q1);
+    free(x);
+    free(d);
+    free(y0);
+    free(y1);
+}
+
+// 
+// AUTOTEST: static channel filter, blind equalization on QPSK symbols
+//
+void autotest_eqflms_cccf_blind()
+{
+    float        tol   = 0.02f; // modulus error tolerance
+    unsigned int h_len = 16;
+    unsigned int n     = 8000;
+    unsigned int i, j;
+
+    float complex h[3] = {1.0f, 0.2f*_Complex_I, -0.1f};
+
+    float complex * y = (float complex*) malloc(n*sizeof(float complex));
+    msequence ms = msequence_create_default(12);
+    float complex s[n];
+    for (i=0; i<n; i++) {
+        s[i] = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) +
+               ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) * _Complex_I;
+        y[i] = 0;
+        for (j=0; j<3 && j<=i; j++)
+            y[i] += h[j]*s[i-j];
+    }
+
+    // initial weights: delta at most recent sample (eqlms order)
+    float complex h0[h_len];
+    for (i=0; i<h_len; i++)
+        h0[i] = i == h_len-1 ? 1.0f : 0.0f;
+    eqflms_cccf q = eqflms_cccf_create(h0, h_len);
+    eqflms_cccf_set_bw(q, 0.1f);
+    eqflms_cccf_execute_block(q, 1, y, n, y);
+
+    // output has converged to constant modulus
+    for (i=n-500; i<n; i++)
+        CONTEND_DELTA( cabsf(y[i]), 1.0f, tol );
+
+    eqflms_cccf_destroy(q);
+    msequence_destroy(ms);
+    free(y);
+}
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -210,3 +211,137 @@ void autotest_eqlms_cccf_decisiondirected()
     msequence_destroy(ms);
 }
 
+
+// 
+// AUTOTEST: batched training against direct normalized LMS recursion,
+// and against per-symbol push/execute/step, at all kernel levels
+//
+void autotest_eqlms_cccf_train_block()
+{
+    unsigned int k     = 2;     // samples/symbol
+    unsigned int h_len = 13;    // equalizer length
+    unsigned int n     = 400;   // number of symbols (buffer is compacted)
+    float        mu    = 0.3f;  // learning rate
+    float        tol   = 1e-4f;
+
+    // random input, desired symbols and initial weights
+    float complex x[k*n];
+    float complex d[n];
+    float complex h[h_len];
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<k*n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    for (i=0; i<n; i++)
+        d[i] = (rand() % 2 ? M_SQRT1_2 : -M_SQRT1_2) + (rand() % 2 ? M_SQRT1_2 : -M_SQRT1_2)*_Complex_I;
+    for (i=0; i<h_len; i++)
+        h[i] = (i==0 ? 1.0f : 0.0f) + 0.1f*(randnf() + _Complex_I*randnf());
+
+    // direct recursion on full input history, y = w^H r
+    float complex y_ref[n];
+    float complex w[h_len];
+    for (i=0; i<h_len; i++)
+        w[i] = h[i];
+    for (i=0; i<n; i++) {
+        unsigned int t = k*i + k;   // samples received
+        float complex y  = 0.0f;
+        float         x2 = 0.0f;
+        for (j=0; j<h_len; j++) {
+            float complex r = t+j >= h_len ? x[t+j-h_len] : 0.0f;
+            y  += conjf(w[j])*r;
+            x2 += crealf(r*conjf(r));
+        }
+        y_ref[i] = y;
+        if (t < h_len)
+            continue;
+        float complex g = mu*conjf(d[i] - y)/x2;
+        for (j=0; j<h_len; j++)
+            w[j] += g*x[t+j-h_len];
+    }
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        eqlms_cccf q0 = eqlms_cccf_create(h, h_len);
+        eqlms_cccf q1 = eqlms_cccf_create(h, h_len);
+        eqlms_cccf_set_bw(q0, mu);
+        eqlms_cccf_set_bw(q1, mu);
+
+        // batched, split across two calls
+        float complex y0[n];
+        eqlms_cccf_train_block(q0, k, x, d, n/2, y0);
+        eqlms_cccf_train_block(q0, k, x+k*(n/2), d+n/2, n-n/2, y0+n/2);
+
+        // per symbol
+        float complex y1[n];
+        for (i=0; i<n; i++) {
+            eqlms_cccf_push_block(q1, x+k*i, k);
+            eqlms_cccf_execute(q1, &y1[i]);
+            eqlms_cccf_step(q1, d[i], y1[i]);
+        }
+
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA(crealf(y0[i]), crealf(y_ref[i]), tol);
+            CONTEND_DELTA(cimagf(y0[i]), cimagf(y_ref[i]), tol);
+            CONTEND_EQUALITY(crealf(y0[i]), crealf(y1[i]));
+            CONTEND_EQUALITY(cimagf(y0[i]), cimagf(y1[i]));
+        }
+
+        // final weights (pending update applied)
+        float complex w0[h_len];
+        eqlms_cccf_get_weights(q0, w0);
+        for (i=0; i<h_len; i++) {
+            float complex w_ref = conjf(w[h_len-i-1]);
+            CONTEND_DELTA(crealf(w0[i]), crealf(w_ref), tol);
+            CONTEND_DELTA(cimagf(w0[i]), cimagf(w_ref), tol);
+        }
+
+        eqlms_cccf_destroy(q0);
+        eqlms_cccf_destroy(q1);
+    }
+    liquid_simd_set_level(host);
+}
+
+// 
+// AUTOTEST: blind batched training matches execute/step_blind
+//
+void autotest_eqlms_cccf_train_block_blind()
+{
+    unsigned int k     = 2;
+    unsigned int h_len = 21;
+    unsigned int n     = 300;
+    float complex x[k*n];
+    unsigned int i;
+    for (i=0; i<k*n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    eqlms_cccf q0 = eqlms_cccf_create_rnyquist(LIQUID_FIRFILT_ARKAISER,k,5,0.3f,0);
+    eqlms_cccf q1 = eqlms_cccf_create_rnyquist(LIQUID_FIRFILT_ARKAISER,k,5,0.3f,0);
+    eqlms_cccf_set_bw(q0, 0.1f);
+    eqlms_cccf_set_bw(q1, 0.1f);
+
+    float complex y0[n];
+    eqlms_cccf_train_block(q0, k, x, NULL, n, y0);
+    for (i=0; i<n; i++) {
+        float complex y1;
+        eqlms_cccf_push_block(q1, x+k*i, k);
+        eqlms_cccf_execute(q1, &y1);
+        eqlms_cccf_step_blind(q1, y1);
+        CONTEND_EQUALITY(crealf(y0[i]), crealf(y1));
+        CONTEND_EQUALITY(cimagf(y0[i]), cimagf(y1));
+    }
+
+    float complex w0[h_len];
+    float complex w1[h_len];
+    eqlms_cccf_get_weights(q0, w0);
+    eqlms_cccf_get_weights(q1, w1);
+    CONTEND_SAME_DATA(w0, w1, sizeof(w0));
+
+    eqlms_cccf_destroy(q0);
+    eqlms_cccf_destroy(q1);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// train conventional and fast RLS equalizers on the same system
+// identification problem and compare the resulting weights
+//  _p      :   equalizer length
+//  _n      :   number of training samples
+void eqrls_cccf_test_fast(unsigned int _p,
+                          unsigned int _n)
+{
+    float tol = 1e-3f;
+    unsigned int i;
+
+    // unknown system
+    float complex h[_p];
+    for (i=0; i<_p; i++)
+        h[i] = (randnf() + _Complex_I*randnf()) * expf(-0.2f*i);
+    firfilt_cccf f = firfilt_cccf_create(h, _p);
+
+    // input and (noiseless) desired response
+    float complex x[_n];
+    float complex d[_n];
+    for (i=0; i<_n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        firfilt_cccf_push(f, x[i]);
+        firfilt_cccf_execute(f, &d[i]);
+    }
+
+    // train both equalizers from zero initial weights
+    eqrls_cccf q0 = eqrls_cccf_create     (NULL, _p);
+    eqrls_cccf q1 = eqrls_cccf_create_fast(NULL, _p);
+    float complex w0[_p];
+    float complex w1[_p];
+    for (i=0; i<_p; i++) {
+        w0[i] = 0.0f;
+        w1[i] = 0.0f;
+    }
+    eqrls_cccf_train(q0, w0, x, d, _n);
+    eqrls_cccf_train(q1, w1, x, d, _n);
+
+    // weights should match the unknown system
+    for (i=0; i<_p; i++) {
+        if (liquid_autotest_verbose)
+            printf("  %3u : %8.4f %8.4f %8.4f\n", i, crealf(h[i]), crealf(w0[i]), crealf(w1[i]));
+        CONTEND_DELTA(crealf(w1[i]), crealf(w0[i]),     tol);
+        CONTEND_DELTA(cimagf(w1[i]), cimagf(w0[i]),     tol);
+        CONTEND_DELTA(crealf(w1[i]), crealf(h[i]), tol);
+        CONTEND_DELTA(cimagf(w1[i]), cimagf(h[i]), tol);
+    }
+
+    firfilt_cccf_destroy(f);
+    eqrls_cccf_destroy(q0);
+    eqrls_cccf_destroy(q1);
+}
+
+void autotest_eqrls_cccf_fast_n4()  { eqrls_cccf_test_fast( 4, 200); }
+void autotest_eqrls_cccf_fast_n16() { eqrls_cccf_test_fast(16, 400); }
+void autotest_eqrls_cccf_fast_n32() { eqrls_cccf_test_fast(32, 800); }
+
+// run fast RLS equalizer over a long, noisy, poorly-conditioned record
+// and ensure it keeps tracking
+void autotest_eqrls_cccf_fast_long()
+{
+    unsigned int p = 12;
+    unsigned int n = 200000;
+    unsigned int i;
+
+    // low-pass channel colours the input; target filter is random
+    firfilt_cccf fc = firfilt_cccf_create_kaiser(15, 0.1f, 60.0f, 0.0f);
+    float complex h[p];
+    for (i=0; i<p; i++)
+        h[i] = (randnf() + _Complex_I*randnf()) / sqrtf(p);
+    firfilt_cccf ft = firfilt_cccf_create(h, p);
+
+    eqrls_cccf q = eqrls_cccf_create_fast(NULL, p);
+    eqrls_cccf_set_bw(q, 0.98f);
+
+    float rmse = 0.0f;
+    unsigned int num_err = 0;
+    for (i=0; i<n; i++) {
+        float complex x, d, y;
+        firfilt_cccf_push(fc, randnf() + _Complex_I*randnf());
+        firfilt_cccf_execute(fc, &x);
+        x += 1e-3f*(randnf() + _Complex_I*randnf());
+
+        firfilt_cccf_push(ft, x);
+        firfilt_cccf_execute(ft, &d);
+
+        eqrls_cccf_push(q, x);
+        eqrls_cccf_execute(q, &y);
+        eqrls_cccf_step(q, d, y);
+
+        // accumulate error over last portion of run
+        if (i >= n - 1000) {
+            float e = cabsf(d - y);
+            rmse += e*e;
+            num_err++;
+        }
+    }
+    rmse = sqrtf(rmse / (float)num_err);
+    if (liquid_autotest_verbose)
+        printf("fast RLS rmse over last %u samples: %12.4e\n", num_err, rmse);
+    CONTEND_EXPRESSION(isfinite(rmse));
+    CONTEND_LESS_THAN(rmse, 1e-2f);
+
+    firfilt_cccf_destroy(fc);
+    firfilt_cccf_destroy(ft);
+    eqrls_cccf_destroy(q);
+}
+
@@ -38,7 +38,7 @@ const float eqrls_rrrf_autotest_data_sequence[64] = {
 // 
 // AUTOTEST: channel filter: delta with zero delay
 //
-void autotest_eqrls_rrrf_01()
+void eqrls_rrrf_test_01(int _fast)
 {
     float tol=1e-2f;        // error tolerance
 
@@ -55,7 +55,8 @@ void autotest_eqrls_rrrf_01()
     unsigned int i;
 
     // create equalizer
-    eqrls_rrrf eq = eqrls_rrrf_create(NULL, p);
+    eqrls_rrrf eq = _fast ? eqrls_rrrf_create_fast(NULL, p)
+                          : eqrls_rrrf_create     (NULL, p);
 
     // create channel filter
     h[0] = 1.0f;
@@ -87,3 +88,6 @@ void autotest_eqrls_rrrf_01()
     eqrls_rrrf_destroy(eq);
 }
 
+void autotest_eqrls_rrrf_01()       { eqrls_rrrf_test_01(0); }
+void autotest_eqrls_rrrf_fast_01()  { eqrls_rrrf_test_01(1); }
+
@@ -30,6 +30,17 @@
 
 #include "liquid.internal.h"
 
+#if defined(__ARM_FEATURE_CRC32)
+#include <stdint.h>
+#include <arm_acle.h>
+
+// ARMv8 crc instructions
+unsigned int crc32_update_armv8(unsigned int          _crc,
+                                const unsigned char * _msg,
+                                unsigned int          _n,
+                                int                   _castagnoli);
+#endif
+
 
 // object-independent methods
 
@@ -41,7 +52,8 @@ const char * crc_scheme_str[LIQUID_CRC_NUM_SCHEMES][2] = {
     {"crc8",        "CRC (8-bit)"},
     {"crc16",       "CRC (16-bit)"},
     {"crc24",       "CRC (24-bit)"},
-    {"crc32",       "CRC (32-bit)"}
+    {"crc32",       "CRC (32-bit)"},
+    {"crc32c",      "CRC (32-bit, Castagnoli)"}
 };
 
 
@@ -93,6 +105,7 @@ unsigned int crc_get_length(crc_scheme _scheme)
     case LIQUID_CRC_16:        return 2;
     case LIQUID_CRC_24:        return 3;
     case LIQUID_CRC_32:        return 4;
+    case LIQUID_CRC_32C:       return 4;
     default:
         fprintf(stderr,"error: crc_get_length(), unknown/unsupported scheme: %d\n", _scheme);
         exit(1);
@@ -119,6 +132,7 @@ unsigned int crc_generate_key(crc_scheme      _scheme,
     case LIQUID_CRC_16:        return crc16_generate_key(_msg, _n);
     case LIQUID_CRC_24:        return crc24_generate_key(_msg, _n);
     case LIQUID_CRC_32:        return crc32_generate_key(_msg, _n);
+    case LIQUID_CRC_32C:       return crc32c_generate_key(_msg, _n);
     default:
         fprintf(stderr,"error: crc_generate_key(), unknown/unsupported scheme: %d\n", _scheme);
         exit(1);
@@ -203,6 +217,7 @@ unsigned int crc_sizeof_key(crc_scheme _scheme)
     case LIQUID_CRC_16:        return 2;
     case LIQUID_CRC_24:        return 3;
     case LIQUID_CRC_32:        return 4;
+    case LIQUID_CRC_32C:       return 4;
     default:
         fprintf(stderr,"error: crc_sizeof_key(), unknown/unsupported scheme: %d\n", _scheme);
         exit(1);
@@ -237,30 +252,91 @@ unsigned int checksum_generate_key(unsigned char *_data,
 }
 
 
+//
+// slicing-by-8 engine
+//
+
+// update (non-inverted) crc register over message using slicing-by-8
+//
+// All schemes use reflected (lsb-first) polynomials of at most 32
+// bits held in a 32-bit register, so a single engine serves every
+// width: each table entry is the register contribution of one byte
+// followed by k zero bytes, and eight bytes are folded per iteration.
+//
+//  _tab    :   slicing-by-8 tables
+//  _crc    :   crc register
+//  _msg    :   input data message [size: _n x 1]
+//  _n      :   input data message size
+unsigned int crc_update_slice8(const unsigned int    _tab[8][256],
+                               unsigned int          _crc,
+                               const unsigned char * _msg,
+                               unsigned int          _n)
+{
+    unsigned int i;
+    unsigned int t = _n & ~7u;
+    for (i=0; i<t; i+=8) {
+        // little-endian loads irrespective of host byte order/alignment
+        unsigned int lo = _crc ^ ( (unsigned int)_msg[i  ]        |
+                                  ((unsigned int)_msg[i+1] <<  8) |
+                                  ((unsigned int)_msg[i+2] << 16) |
+                                  ((unsigned int)_msg[i+3] << 24) );
+        unsigned int hi =         (unsigned int)_msg[i+4]        |
+                                 ((unsigned int)_msg[i+5] <<  8) |
+                                 ((unsigned int)_msg[i+6] << 16) |
+                                 ((unsigned int)_msg[i+7] << 24);
+        _crc = _tab[7][ lo        & 0xff] ^
+               _tab[6][(lo >>  8) & 0xff] ^
+               _tab[5][(lo >> 16) & 0xff] ^
+               _tab[4][(lo >> 24)       ] ^
+               _tab[3][ hi        & 0xff] ^
+               _tab[2][(hi >>  8) & 0xff] ^
+               _tab[1][(hi >> 16) & 0xff] ^
+               _tab[0][(hi >> 24)       ];
+    }
+
+    // remaining bytes
+    for ( ; i<_n; i++)
+        _crc = _tab[0][(_crc ^ _msg[i]) & 0xff] ^ (_crc >> 8);
+
+    return _crc;
+}
+
+#if HAVE_CRC_SSE42
+// hardware crc support on host cpu (negative until first queried)
+static int crc_hw_sse42  = -1;
+static int crc_hw_pclmul = -1;
+
+// query host cpu for hardware crc instructions; disabled along with
+// the SIMD kernels when the dispatch level is set to portable. Threads
+// racing here compute the same result; the pclmul flag is published
+// before the sse4.2 flag which marks detection as complete.
+static void crc_hw_detect(void)
+{
+    if (__atomic_load_n(&crc_hw_sse42, __ATOMIC_ACQUIRE) < 0) {
+        __builtin_cpu_init();
+        int sse42  = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+        int pclmul = sse42 && __builtin_cpu_supports("pclmul");
+        __atomic_store_n(&crc_hw_pclmul, pclmul, __ATOMIC_RELAXED);
+        __atomic_store_n(&crc_hw_sse42,  sse42,  __ATOMIC_RELEASE);
+    }
+}
+#endif
+
+
 // 
 // CRC-8
 //
 
 // generate 8-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
+// table-driven method, slicing-by-8 (sandbox/crc_gentab)
 //
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc8_generate_key(unsigned char *_msg,
                                unsigned int _n)
 {
-    unsigned int i, j, b, mask, key8=~0;
-    unsigned int poly = liquid_reverse_byte_gentab[CRC8_POLY];
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key8 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key8 & 1);
-            key8 = (key8>>1) ^ (poly & mask);
-        }
-    }
+    unsigned int key8 = crc_update_slice8(crc8_gentab, ~0u, _msg, _n);
     return (~key8) & 0xff;
 }
 
@@ -271,24 +347,14 @@ unsigned int crc8_generate_key(unsigned char *_msg,
 
 // generate 16-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
+// table-driven method, slicing-by-8 (sandbox/crc_gentab)
 //
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc16_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key16=~0;
-    unsigned int poly = liquid_reverse_uint16(CRC16_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key16 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key16 & 1);
-            key16 = (key16>>1) ^ (poly & mask);
-        }
-    }
+    unsigned int key16 = crc_update_slice8(crc16_gentab, ~0u, _msg, _n);
     return (~key16) & 0xffff;
 }
 
@@ -299,24 +365,14 @@ unsigned int crc16_generate_key(unsigned char *_msg,
 
 // generate 24-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
+// table-driven method, slicing-by-8 (sandbox/crc_gentab)
 //
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc24_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key24=~0;
-    unsigned int poly = liquid_reverse_uint24(CRC24_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key24 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key24 & 1);
-            key24 = (key24>>1) ^ (poly & mask);
-        }
-    }
+    unsigned int key24 = crc_update_slice8(crc24_gentab, ~0u, _msg, _n);
     return (~key24) & 0xffffff;
 }
 
@@ -327,27 +383,84 @@ unsigned int crc24_generate_key(unsigned char *_msg,
 
 // generate 32-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
+// carry-less multiply folding (pclmulqdq) where available, otherwise
+// table-driven method, slicing-by-8 (sandbox/crc_gentab)
 //
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc32_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key32=~0;
-    unsigned int poly = liquid_reverse_uint32(CRC32_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key32 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key32 & 1);
-            key32 = (key32>>1) ^ (poly & mask);
-        }
+    unsigned int key32 = ~0u;
+#if defined(__ARM_FEATURE_CRC32)
+    key32 = crc32_update_armv8(key32, _msg, _n, 0);
+#else
+#  if HAVE_CRC_SSE42
+    crc_hw_detect();
+    if (_n >= 64 && crc_hw_pclmul && liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        // fold multiples of 16 bytes, finish remainder with tables
+        unsigned int t = _n & ~15u;
+        key32 = crc32_update_pclmul(key32, _msg, t);
+        _msg += t;
+        _n   -= t;
     }
+#  endif
+    key32 = crc_update_slice8(crc32_gentab, key32, _msg, _n);
+#endif
     return (~key32) & 0xffffffff;
 }
 
+
+// 
+// CRC-32C
+//
+
+// generate 32-bit cyclic redundancy check key (Castagnoli polynomial).
+//
+// sse4.2 crc32 instruction where available, otherwise table-driven
+// method, slicing-by-8 (sandbox/crc_gentab)
+//
+//  _msg    :   input data message [size: _n x 1]
+//  _n      :   input data message size
+unsigned int crc32c_generate_key(unsigned char *_msg,
+                                 unsigned int _n)
+{
+    unsigned int key32 = ~0u;
+#if defined(__ARM_FEATURE_CRC32)
+    key32 = crc32_update_armv8(key32, _msg, _n, 1);
+#else
+#  if HAVE_CRC_SSE42
+    crc_hw_detect();
+    if (crc_hw_sse42 && liquid_simd_get_level() != LIQUID_SIMD_PORTABLE)
+        key32 = crc32c_update_sse42(key32, _msg, _n);
+    else
+#  endif
+        key32 = crc_update_slice8(crc32c_gentab, key32, _msg, _n);
+#endif
+    return (~key32) & 0xffffffff;
+}
+
+#if defined(__ARM_FEATURE_CRC32)
+// ARMv8 crc instructions (compiled in when targeting +crc); update
+// (non-inverted) crc register using the IEEE or Castagnoli polynomial
+unsigned int crc32_update_armv8(unsigned int          _crc,
+                                const unsigned char * _msg,
+                                unsigned int          _n,
+                                int                   _castagnoli)
+{
+    unsigned int i;
+    unsigned int t = _n & ~7u;
+    for (i=0; i<t; i+=8) {
+        uint64_t v;
+        memmove(&v, &_msg[i], sizeof(uint64_t));
+        _crc = _castagnoli ? __crc32cd(_crc, v) : __crc32d(_crc, v);
+    }
+    for ( ; i<_n; i++)
+        _crc = _castagnoli ? __crc32cb(_crc, _msg[i]) : __crc32b(_crc, _msg[i]);
+    return _crc;
+}
+#endif
+
 #if 0
 void crc32_generate_key(unsigned char *_msg,
                         unsigned int _n,
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Hardware cyclic redundancy check kernels (SSE4.2, PCLMULQDQ)
+//
+// These kernels are compiled with per-function target attributes so
+// that they can live in the same binary as the table-driven methods;
+// crc32_generate_key() and crc32c_generate_key() select them at run
+// time based on the host cpu.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// update (non-inverted) crc register over message with the sse4.2
+// crc32 instruction (Castagnoli polynomial)
+//  _crc    :   crc register
+//  _msg    :   input data message [size: _n x 1]
+//  _n      :   input data message size
+__attribute__((target("sse4.2")))
+unsigned int crc32c_update_sse42(unsigned int          _crc,
+                                 const unsigned char * _msg,
+                                 unsigned int          _n)
+{
+    unsigned int i = 0;
+#if defined(__x86_64__)
+    uint64_t crc = _crc;
+    unsigned int t = _n & ~7u;
+    for ( ; i<t; i+=8) {
+        uint64_t v;
+        memmove(&v, &_msg[i], sizeof(uint64_t));
+        crc = _mm_crc32_u64(crc, v);
+    }
+    _crc = (unsigned int) crc;
+#endif
+    for ( ; i<_n; i++)
+        _crc = _mm_crc32_u8(_crc, _msg[i]);
+    return _crc;
+}
+
+// folding constants for the bit-reflected IEEE polynomial 0x04C11DB7
+// (x^n mod P for the 512/128/64-bit folds followed by Barrett
+// reduction), from "Fast CRC Computation for Generic Polynomials Using
+// PCLMULQDQ Instruction", Intel (2009)
+static const uint64_t crc32_pclmul_k1k2[2] __attribute__((aligned(16))) = {0x0154442bd4ULL, 0x01c6e41596ULL};
+static const uint64_t crc32_pclmul_k3k4[2] __attribute__((aligned(16))) = {0x01751997d0ULL, 0x00ccaa009eULL};
+static const uint64_t crc32_pclmul_k5k0[2] __attribute__((aligned(16))) = {0x0163cd6124ULL, 0x0000000000ULL};
+static const uint64_t crc32_pclmul_poly[2] __attribute__((aligned(16))) = {0x01db710641ULL, 0x01f7011641ULL};
+
+// update (non-inverted) crc register over message by folding with
+// carry-less multiplication (IEEE polynomial)
+//  _crc    :   crc register
+//  _msg    :   input data message [size: _n x 1]
+//  _n      :   input data message size, multiple of 16 and at least 64
+__attribute__((target("sse4.2,pclmul")))
+unsigned int crc32_update_pclmul(unsigned int          _crc,
+                                 const unsigned char * _msg,
+                                 unsigned int          _n)
+{
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    // load first 64 bytes, folding in the initial register
+    x1 = _mm_loadu_si128((const __m128i*)(_msg + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(_msg + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(_msg + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(_msg + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)_crc));
+    x0 = _mm_load_si128((const __m128i*)crc32_pclmul_k1k2);
+    _msg += 64;
+    _n   -= 64;
+
+    // fold 64 bytes at a time
+    while (_n >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        y5 = _mm_loadu_si128((const __m128i*)(_msg + 0x00));
+        y6 = _mm_loadu_si128((const __m128i*)(_msg + 0x10));
+        y7 = _mm_loadu_si128((const __m128i*)(_msg + 0x20));
+        y8 = _mm_loadu_si128((const __m128i*)(_msg + 0x30));
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+        _msg += 64;
+        _n   -= 64;
+    }
+
+    // fold four 128-bit values into one
+    x0 = _mm_load_si128((const __m128i*)crc32_pclmul_k3k4);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // fold remaining 16 bytes at a time
+    while (_n >= 16) {
+        x2 = _mm_loadu_si128((const __m128i*)_msg);
+
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+        _msg += 16;
+        _n   -= 16;
+    }
+
+    // fold 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64((const __m128i*)crc32_pclmul_k5k0);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128((const __m128i*)crc32_pclmul_poly);
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (unsigned int) _mm_extract_epi32(x1, 1);
+}
@@ -61,7 +61,10 @@ const char * fec_scheme_str[LIQUID_FEC_NUM_SCHEMES][2] = {
     {"v29p56",      "convolutional r5/6 K=9 (punctured)"},
     {"v29p67",      "convolutional r6/7 K=9 (punctured)"},
     {"v29p78",      "convolutional r7/8 K=9 (punctured)"},
-    {"rs8",         "Reed-Solomon, 223/255"}
+    {"rs8",         "Reed-Solomon, 223/255"},
+    {"ldpc12",      "LDPC r1/2 n=648"},
+    {"ldpc23",      "LDPC r2/3 n=648"},
+    {"ldpc34",      "LDPC r3/4 n=648"}
 };
 
 // Print compact list of existing and available fec schemes
@@ -73,10 +76,6 @@ void liquid_print_fec_schemes()
     // print all available MOD schemes
     printf("          ");
     for (i=0; i<LIQUID_FEC_NUM_SCHEMES; i++) {
-#if !LIBFEC_ENABLED
-        if ( fec_scheme_is_convolutional(i) || fec_scheme_is_reedsolomon(i) )
-            continue;
-#endif
         printf("%s", fec_scheme_str[i][0]);
 
         if (i != LIQUID_FEC_NUM_SCHEMES-1)
@@ -174,6 +173,19 @@ int fec_scheme_is_reedsolomon(fec_scheme _scheme)
     return 0;
 }
 
+// is scheme LDPC?
+int fec_scheme_is_ldpc(fec_scheme _scheme)
+{
+    switch (_scheme) {
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:
+        return 1;
+    default:;
+    }
+    return 0;
+}
+
 // is scheme Hamming?
 int fec_scheme_is_hamming(fec_scheme _scheme)
 {
@@ -220,7 +232,6 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_SECDED3932:     return _msg_len + _msg_len/4 + ((_msg_len%4) ? 1 : 0);
     case LIQUID_FEC_SECDED7264:     return _msg_len + _msg_len/8 + ((_msg_len%8) ? 1 : 0);
 
-#if LIBFEC_ENABLED
     // convolutional codes
     case LIQUID_FEC_CONV_V27:       return 2*_msg_len + 2;  // (K-1)/r=12, round up to 2 bytes
     case LIQUID_FEC_CONV_V29:       return 2*_msg_len + 2;  // (K-1)/r=16, 2 bytes
@@ -242,32 +253,11 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
 
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:          return fec_rs_get_enc_msg_len(_msg_len,32,255,223);
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
-
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
 
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr, "error: fec_get_enc_msg_length(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr, "error: fec_get_enc_msg_length(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+    // low-density parity-check codes
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:       return fec_ldpc_get_enc_msg_len(_scheme,_msg_len);
     default:
         printf("error: fec_get_enc_msg_length(), unknown/unsupported scheme: %d\n", _scheme);
         exit(-1);
@@ -415,7 +405,6 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_SECDED7264:     return 8./9.;
 
     // convolutional codes
-#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:       return 1./2.;
     case LIQUID_FEC_CONV_V29:       return 1./2.;
     case LIQUID_FEC_CONV_V39:       return 1./3.;
@@ -435,32 +424,11 @@ float fec_get_rate(fec_scheme _scheme)
 
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:          return 223./255.;
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
 
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr,"error: fec_get_rate(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_get_rate(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+    // low-density parity-check codes
+    case LIQUID_FEC_LDPC_R12:       return 1./2.;
+    case LIQUID_FEC_LDPC_R23:       return 2./3.;
+    case LIQUID_FEC_LDPC_R34:       return 3./4.;
 
     default:
         printf("error: fec_get_rate(), unknown/unsupported scheme: %d\n", _scheme);
@@ -469,6 +437,60 @@ float fec_get_rate(fec_scheme _scheme)
     return 0;
 }
 
+// count codewords of an encoded message whose syndromes indicate an
+// error pattern beyond the correcting capability of the code (see
+// liquid.h); a received word is flagged when its distance to the
+// re-encoded decoder output exceeds the number of correctable errors,
+// and SEC-DED blocks when their syndrome flags a double error. Only
+// complete SEC-DED blocks are checked.
+unsigned int fec_count_uncorrectable(fec_scheme            _scheme,
+                                     unsigned int          _dec_msg_len,
+                                     const unsigned char * _msg_enc,
+                                     unsigned int *        _num_codewords)
+{
+    unsigned int enc_msg_len = fec_get_enc_msg_length(_scheme, _dec_msg_len);
+    unsigned int num_uncorrectable = 0;
+    unsigned int n = 0;
+    unsigned char e_hat[9];
+    unsigned int i;
+
+    switch (_scheme) {
+    case LIQUID_FEC_HAMMING84:
+        // one byte per codeword
+        for (n=0; n<enc_msg_len; n++) {
+            unsigned char r = _msg_enc[n];
+            unsigned char c = hamming84_enc_gentab[hamming84_dec_gentab[r]];
+            num_uncorrectable += liquid_count_ones(r ^ c) > 1;
+        }
+        break;
+    case LIQUID_FEC_GOLAY2412:
+        // three bytes per codeword
+        for (i=0; i+3<=enc_msg_len; i+=3, n++) {
+            unsigned int r = (_msg_enc[i] << 16) | (_msg_enc[i+1] << 8) | _msg_enc[i+2];
+            unsigned int c = fec_golay2412_encode_symbol(fec_golay2412_decode_symbol(r));
+            num_uncorrectable += liquid_count_ones(r ^ c) > 3;
+        }
+        break;
+    case LIQUID_FEC_SECDED2216:
+        for (i=0; i+3<=enc_msg_len && n<_dec_msg_len/2; i+=3, n++)
+            num_uncorrectable += fec_secded2216_estimate_ehat((unsigned char*)&_msg_enc[i], e_hat) == 2;
+        break;
+    case LIQUID_FEC_SECDED3932:
+        for (i=0; i+5<=enc_msg_len && n<_dec_msg_len/4; i+=5, n++)
+            num_uncorrectable += fec_secded3932_estimate_ehat((unsigned char*)&_msg_enc[i], e_hat) == 2;
+        break;
+    case LIQUID_FEC_SECDED7264:
+        for (i=0; i+9<=enc_msg_len && n<_dec_msg_len/8; i+=9, n++)
+            num_uncorrectable += fec_secded7264_estimate_ehat((unsigned char*)&_msg_enc[i], e_hat) == 2;
+        break;
+    default:;
+    }
+
+    if (_num_codewords != NULL)
+        *_num_codewords = n;
+    return num_uncorrectable;
+}
+
 // create a fec object of a particular scheme
 //  _scheme     :   error-correction scheme
 //  _opts       :   (ignored)
@@ -503,7 +525,6 @@ fec fec_create(fec_scheme _scheme, void *_opts)
         return fec_secded7264_create(_opts);
 
     // convolutional codes
-#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
@@ -529,32 +550,12 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:
         return fec_rs_create(_scheme);
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
 
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr,"error: fec_create(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_create(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+    // low-density parity-check codes
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:
+        return fec_ldpc_create(_scheme);
 
     default:
         printf("error: fec_create(), unknown/unsupported scheme: %d\n", _scheme);
@@ -587,7 +588,22 @@ fec fec_recreate(fec _q,
 // destroy fec object
 void fec_destroy(fec _q)
 {
-    free(_q);
+    // convolutional, Reed-Solomon and LDPC codes hold decoder memory
+    if (fec_scheme_is_convolutional(_q->scheme)) {
+        if (fec_scheme_is_punctured(_q->scheme))
+            fec_conv_punctured_destroy(_q);
+        else
+            fec_conv_destroy(_q);
+        return;
+    } else if (fec_scheme_is_reedsolomon(_q->scheme)) {
+        fec_rs_destroy(_q);
+        return;
+    } else if (fec_scheme_is_ldpc(_q->scheme)) {
+        fec_ldpc_destroy(_q);
+        return;
+    }
+
+    liquid_free(_q);
 }
 
 // print basic fec object internals
@@ -26,32 +26,20 @@
 
 #include "liquid.internal.h"
 
-#if LIBFEC_ENABLED
-#include <fec.h>
-
-int fec_conv27_poly[2]  = {V27POLYA,
-                           V27POLYB};
-
-int fec_conv29_poly[2]  = {V29POLYA,
-                           V29POLYB};
-
-int fec_conv39_poly[3]  = {V39POLYA,
-                           V39POLYB,
-                           V39POLYC};
-
-int fec_conv615_poly[6] = {V615POLYA,
-                           V615POLYB,
-                           V615POLYC,
-                           V615POLYD,
-                           V615POLYE,
-                           V615POLYF};
-
-#else
-
-int fec_conv27_poly[2]  = {0,0};
-int fec_conv29_poly[2]  = {0,0};
-int fec_conv39_poly[3]  = {0,0,0};
-int fec_conv615_poly[6] = {0,0,0,0,0,0};
-
-#endif
+int fec_conv27_poly[2]  = {LIQUID_V27POLYA,
+                           LIQUID_V27POLYB};
+
+int fec_conv29_poly[2]  = {LIQUID_V29POLYA,
+                           LIQUID_V29POLYB};
+
+int fec_conv39_poly[3]  = {LIQUID_V39POLYA,
+                           LIQUID_V39POLYB,
+                           LIQUID_V39POLYC};
+
+int fec_conv615_poly[6] = {LIQUID_V615POLYA,
+                           LIQUID_V615POLYB,
+                           LIQUID_V615POLYC,
+                           LIQUID_V615POLYD,
+                           LIQUID_V615POLYE,
+                           LIQUID_V615POLYF};
 
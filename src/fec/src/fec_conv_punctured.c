@@ -32,12 +32,9 @@
 
 #define VERBOSE_FEC_CONV_PUNCTURED    0
 
-#if LIBFEC_ENABLED
-#include "fec.h"
-
 fec fec_conv_punctured_create(fec_scheme _fs)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     q->scheme = _fs;
     q->rate = fec_get_rate(q->scheme);
@@ -77,9 +74,10 @@ void fec_conv_punctured_destroy(fec _q)
 {
     // delete viterbi decoder
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        viterbi_destroy(_q->vp);
 
-    free(_q);
+    liquid_free(_q->enc_bits);
+    liquid_free(_q);
 }
 
 void fec_conv_punctured_encode(fec _q,
@@ -109,7 +107,7 @@ void fec_conv_punctured_encode(fec _q,
             for (r=0; r<_q->R; r++) {
                 // enable output determined by puncturing matrix
                 if (_q->puncturing_matrix[r*(_q->P)+p]) {
-                    byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                    byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                     _msg_enc[n/8] = byte_out;
                     n++;
                 } else {
@@ -131,7 +129,7 @@ void fec_conv_punctured_encode(fec _q,
         // compute parity bits for each polynomial
         for (r=0; r<_q->R; r++) {
             if (_q->puncturing_matrix[r*(_q->P)+p]) {
-                byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                 _msg_enc[n/8] = byte_out;
                 n++;
             }
@@ -205,10 +203,10 @@ void fec_conv_punctured_decode_hard(fec _q,
 #endif
 
     // run decoder
-    _q->init_viterbi(_q->vp,0);
+    viterbi_init(_q->vp, 0);
     // TODO : check to see if this shouldn't be num_enc_bits (punctured)
-    _q->update_viterbi_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
-    _q->chainback_viterbi(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
+    viterbi_update_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
+    viterbi_chainback(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
 
 #if VERBOSE_FEC_CONV_PUNCTURED
     for (ii=0; ii<_dec_msg_len; ii++)
@@ -258,10 +256,10 @@ void fec_conv_punctured_decode_soft(fec _q,
 #endif
 
     // run decoder
-    _q->init_viterbi(_q->vp,0);
+    viterbi_init(_q->vp, 0);
     // TODO : check to see if this shouldn't be num_enc_bits (punctured)
-    _q->update_viterbi_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
-    _q->chainback_viterbi(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
+    viterbi_update_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
+    viterbi_chainback(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
 
 #if VERBOSE_FEC_CONV_PUNCTURED
     for (ii=0; ii<_dec_msg_len; ii++)
@@ -300,11 +298,11 @@ void fec_conv_punctured_setlength(fec _q, unsigned int _dec_msg_len)
 
     // delete old decoder if necessary
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        viterbi_destroy(_q->vp);
 
     // re-create / re-allocate memory buffers
-    _q->vp = _q->create_viterbi(8*_q->num_dec_bytes);
-    _q->enc_bits = (unsigned char*) realloc(_q->enc_bits,
+    _q->vp = viterbi_create(_q->K, _q->R, _q->poly, 8*_q->num_dec_bytes);
+    _q->enc_bits = (unsigned char*) liquid_realloc(_q->enc_bits,
                                             num_enc_bits*sizeof(unsigned char));
 
 }
@@ -315,7 +313,7 @@ void fec_conv_punctured_setlength(fec _q, unsigned int _dec_msg_len)
 
 void fec_conv_init_v27p23(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 2;
@@ -324,7 +322,7 @@ void fec_conv_init_v27p23(fec _q)
 
 void fec_conv_init_v27p34(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 3;
@@ -333,7 +331,7 @@ void fec_conv_init_v27p34(fec _q)
 
 void fec_conv_init_v27p45(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 4;
@@ -342,7 +340,7 @@ void fec_conv_init_v27p45(fec _q)
 
 void fec_conv_init_v27p56(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 5;
@@ -352,7 +350,7 @@ void fec_conv_init_v27p56(fec _q)
 
 void fec_conv_init_v27p67(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 6;
@@ -361,7 +359,7 @@ void fec_conv_init_v27p67(fec _q)
 
 void fec_conv_init_v27p78(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 7;
@@ -371,7 +369,7 @@ void fec_conv_init_v27p78(fec _q)
 
 void fec_conv_init_v29p23(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 2;
@@ -380,7 +378,7 @@ void fec_conv_init_v29p23(fec _q)
 
 void fec_conv_init_v29p34(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 3;
@@ -389,7 +387,7 @@ void fec_conv_init_v29p34(fec _q)
 
 void fec_conv_init_v29p45(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 4;
@@ -398,7 +396,7 @@ void fec_conv_init_v29p45(fec _q)
 
 void fec_conv_init_v29p56(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 5;
@@ -408,7 +406,7 @@ void fec_conv_init_v29p56(fec _q)
 
 void fec_conv_init_v29p67(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 6;
@@ -417,39 +415,10 @@ void fec_conv_init_v29p67(fec _q)
 
 void fec_conv_init_v29p78(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 7;
     _q->puncturing_matrix = fec_conv29p78_matrix;
 }
 
-
-#else   // LIBFEC_ENABLED
-
-fec fec_conv_punctured_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_conv_punctured_destroy(fec _q)
-{
-}
-
-void fec_conv_punctured_encode(fec _q,
-                               unsigned int _dec_msg_len,
-                               unsigned char *_msg_dec,
-                               unsigned char *_msg_enc)
-{
-}
-
-//unsigned int
-void fec_conv_punctured_decode(fec _q,
-                               unsigned int _dec_msg_len,
-                               unsigned char *_msg_enc,
-                               unsigned char *_msg_dec)
-{
-}
-
-#endif  // LIBFEC_ENABLED
-
@@ -98,8 +98,10 @@ unsigned int fec_golay2412_encode_symbol(unsigned int _sym_dec)
         exit(1);
     }
 
-    // compute encoded/transmitted message: v = m*G
-    return golay2412_matrix_mul(_sym_dec, golay2412_Gt, 24);
+    // compute encoded/transmitted message: v = m*G, exploiting linearity
+    // of the code to sum contributions from the low byte and high nibble
+    return golay2412_enc0_gentab[_sym_dec & 0xff] ^
+           golay2412_enc1_gentab[_sym_dec >> 8];
 }
 
 // search for p[i] such that w(v+p[i]) <= 2, return -1 on fail
@@ -135,109 +137,28 @@ unsigned int fec_golay2412_decode_symbol(unsigned int _sym_enc)
         exit(1);
     }
 
-    // state variables
-    unsigned int s=0;       // syndrome vector
-    unsigned int e_hat=0;   // estimated error vector
-    unsigned int v_hat=0;   // estimated transmitted message
-    unsigned int m_hat=0;   // estimated original message
-    
-    // compute syndrome vector, s = r*H^T = ( H*r^T )^T
-    s = golay2412_matrix_mul(_sym_enc, golay2412_H, 12);
+    // compute syndrome vector, s = r*H^T = ( H*r^T )^T, from the
+    // contributions of each byte of the received vector
+    unsigned int s = golay2412_syn_gentab[0][(_sym_enc      ) & 0xff] ^
+                     golay2412_syn_gentab[1][(_sym_enc >>  8) & 0xff] ^
+                     golay2412_syn_gentab[2][(_sym_enc >> 16) & 0xff];
 #if DEBUG_FEC_GOLAY2412
     printf("s (syndrome vector): "); liquid_print_bitstring(s,12); printf("\n");
 #endif
 
-    // compute weight of s (12 bits)
-    unsigned int ws = liquid_count_ones_uint16(s);
-#if DEBUG_FEC_GOLAY2412
-    printf("w(s) = %u\n", ws);
-#endif
-
-    // step 2:
-    e_hat = 0;
-    if (ws <= 3) {
-#if DEBUG_FEC_GOLAY2412
-        printf("    w(s) <= 3: estimating error vector as [s, 0(12)]\n");
-#endif
-        // set e_hat = [s 0(12)]
-        e_hat = (s << 12) & 0xfff000;
-    } else {
-        // step 3: search for p[i] s.t. w(s+p[i]) <= 2
-#if DEBUG_FEC_GOLAY2412
-        printf("    searching for w(s + p_i) <= 2...\n");
-#endif
-        int s_index = golay2412_parity_search(s);
-
-        if (s_index >= 0) {
-            // vector found!
-#if DEBUG_FEC_GOLAY2412
-            printf("    w(s + p[%2u]) <= 2: estimating error vector as [s+p[%2u],u[%2u]]\n", s_index, s_index, s_index);
-#endif
-            // NOTE : uj = 1 << (12-j-1)
-            e_hat = ((s ^ golay2412_P[s_index]) << 12) | (1 << (11-s_index));
-        } else {
-            // step 4: compute s*P
-            unsigned int sP = golay2412_matrix_mul(s, golay2412_P, 12);
-#if DEBUG_FEC_GOLAY2412
-            printf("s*P: "); liquid_print_bitstring(sP,12); printf("\n");
-#endif
-
-            // compute weight of sP (12 bits)
-            unsigned int wsP = liquid_count_ones_uint16(sP);
-#if DEBUG_FEC_GOLAY2412
-            printf("w(s*P) = %u\n", wsP);
-#endif
-
-            if (wsP == 2 || wsP == 3) {
-                // step 5: set e = [0, s*P]
-#if DEBUG_FEC_GOLAY2412
-                printf("    w(s*P) in [2,3]: estimating error vector as [0(12), s*P]\n");
-#endif
-                e_hat = sP;
-            } else {
-                // step 6: search for p[i] s.t. w(s*P + p[i]) == 2...
-
-#if DEBUG_FEC_GOLAY2412
-                printf("    searching for w(s*P + p_i) == 2...\n");
-#endif
-                int sP_index = golay2412_parity_search(sP);
-
-                if (sP_index >= 0) {
-                    // vector found!
-#if DEBUG_FEC_GOLAY2412
-                    printf("    w(s*P + p[%2u]) == 2: estimating error vector as [u[%2u],s*P+p[%2u]]\n", sP_index, sP_index, sP_index);
-#endif
-                    // NOTE : uj = 1 << (12-j-1)
-                    //      [      uj << 1 2    ] [    sP + p[j]    ]
-                    e_hat = (1 << (23-sP_index)) | (sP ^ golay2412_P[sP_index]);
-                } else {
-                    // step 7: decoding error
-#if DEBUG_FEC_GOLAY2412
-                    printf("  **** decoding error\n");
-#endif
-                }
-            }
-        }
-    }
-
-    // step 8: compute estimated transmitted message: v_hat = r + e_hat
-    v_hat = _sym_enc ^ e_hat;
-#if DEBUG_FEC_GOLAY2412
-    printf("r (recevied vector):            "); liquid_print_bitstring(_sym_enc,24); printf("\n");
-    printf("e-hat (estimated error vector): "); liquid_print_bitstring(e_hat,24);    printf("\n");
-    printf("v-hat (estimated tx vector):    "); liquid_print_bitstring(v_hat,24);    printf("\n");
-#endif
-    
-    // compute estimated original message: (last 12 bits of encoded message)
-    m_hat = v_hat & 0x0fff;
+    // look up estimated error vector (last 12 bits only) from syndrome;
+    // table generated from algebraic decoding steps 2-7 of [Lin:2004]
+    // (see sandbox/fec_golay2412_gentab.c)
+    unsigned int e_hat = golay2412_dec_gentab[s];
 
-    return m_hat;
+    // compute estimated original message: (last 12 bits of r + e_hat)
+    return (_sym_enc ^ e_hat) & 0x0fff;
 }
 
 // create Golay(24,12) codec object
 fec fec_golay2412_create(void * _opts)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     // set scheme
     q->scheme = LIQUID_FEC_GOLAY2412;
@@ -254,7 +175,7 @@ fec fec_golay2412_create(void * _opts)
 // destroy Golay(24,12) object
 void fec_golay2412_destroy(fec _q)
 {
-    free(_q);
+    liquid_free(_q);
 }
 
 // encode block of data using Golay(24,12) encoder
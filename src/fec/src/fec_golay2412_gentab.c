@@ -0,0 +1,686 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Golay(24,12) generated tables (generated by
+// sandbox/fec_golay2412_gentab)
+//
+
+// encoding tables: v = enc0[m & 0xff] ^ enc1[m >> 8]
+const unsigned int golay2412_enc0_gentab[256] = {
+    0x000000, 0xffe001, 0x477002, 0xb89003, 0xa3b004, 0x5c5005, 0xe4c006, 0x1b2007, 
+    0xd1d008, 0x2e3009, 0x96a00a, 0x69400b, 0x72600c, 0x8d800d, 0x35100e, 0xcaf00f, 
+    0x68f010, 0x971011, 0x2f8012, 0xd06013, 0xcb4014, 0x34a015, 0x8c3016, 0x73d017, 
+    0xb92018, 0x46c019, 0xfe501a, 0x01b01b, 0x1a901c, 0xe5701d, 0x5de01e, 0xa2001f, 
+    0xb47020, 0x4b9021, 0xf30022, 0x0ce023, 0x17c024, 0xe82025, 0x50b026, 0xaf5027, 
+    0x65a028, 0x9a4029, 0x22d02a, 0xdd302b, 0xc6102c, 0x39f02d, 0x81602e, 0x7e802f, 
+    0xdc8030, 0x236031, 0x9bf032, 0x641033, 0x7f3034, 0x80d035, 0x384036, 0xc7a037, 
+    0x0d5038, 0xf2b039, 0x4a203a, 0xb5c03b, 0xaee03c, 0x51003d, 0xe9903e, 0x16703f, 
+    0xda3040, 0x25d041, 0x9d4042, 0x62a043, 0x798044, 0x866045, 0x3ef046, 0xc11047, 
+    0x0be048, 0xf40049, 0x4c904a, 0xb3704b, 0xa8504c, 0x57b04d, 0xef204e, 0x10c04f, 
+    0xb2c050, 0x4d2051, 0xf5b052, 0x0a5053, 0x117054, 0xee9055, 0x560056, 0xa9e057, 
+    0x631058, 0x9cf059, 0x24605a, 0xdb805b, 0xc0a05c, 0x3f405d, 0x87d05e, 0x78305f, 
+    0x6e4060, 0x91a061, 0x293062, 0xd6d063, 0xcdf064, 0x321065, 0x8a8066, 0x756067, 
+    0xbf9068, 0x407069, 0xf8e06a, 0x07006b, 0x1c206c, 0xe3c06d, 0x5b506e, 0xa4b06f, 
+    0x06b070, 0xf95071, 0x41c072, 0xbe2073, 0xa50074, 0x5ae075, 0xe27076, 0x1d9077, 
+    0xd76078, 0x288079, 0x90107a, 0x6ff07b, 0x74d07c, 0x8b307d, 0x33a07e, 0xcc407f, 
+    0xed1080, 0x12f081, 0xaa6082, 0x558083, 0x4ea084, 0xb14085, 0x09d086, 0xf63087, 
+    0x3cc088, 0xc32089, 0x7bb08a, 0x84508b, 0x9f708c, 0x60908d, 0xd8008e, 0x27e08f, 
+    0x85e090, 0x7a0091, 0xc29092, 0x3d7093, 0x265094, 0xd9b095, 0x612096, 0x9ec097, 
+    0x543098, 0xabd099, 0x13409a, 0xeca09b, 0xf7809c, 0x08609d, 0xb0f09e, 0x4f109f, 
+    0x5960a0, 0xa680a1, 0x1e10a2, 0xe1f0a3, 0xfad0a4, 0x0530a5, 0xbda0a6, 0x4240a7, 
+    0x88b0a8, 0x7750a9, 0xcfc0aa, 0x3020ab, 0x2b00ac, 0xd4e0ad, 0x6c70ae, 0x9390af, 
+    0x3190b0, 0xce70b1, 0x76e0b2, 0x8900b3, 0x9220b4, 0x6dc0b5, 0xd550b6, 0x2ab0b7, 
+    0xe040b8, 0x1fa0b9, 0xa730ba, 0x58d0bb, 0x43f0bc, 0xbc10bd, 0x0480be, 0xfb60bf, 
+    0x3720c0, 0xc8c0c1, 0x7050c2, 0x8fb0c3, 0x9490c4, 0x6b70c5, 0xd3e0c6, 0x2c00c7, 
+    0xe6f0c8, 0x1910c9, 0xa180ca, 0x5e60cb, 0x4540cc, 0xbaa0cd, 0x0230ce, 0xfdd0cf, 
+    0x5fd0d0, 0xa030d1, 0x18a0d2, 0xe740d3, 0xfc60d4, 0x0380d5, 0xbb10d6, 0x44f0d7, 
+    0x8e00d8, 0x71e0d9, 0xc970da, 0x3690db, 0x2db0dc, 0xd250dd, 0x6ac0de, 0x9520df, 
+    0x8350e0, 0x7cb0e1, 0xc420e2, 0x3bc0e3, 0x20e0e4, 0xdf00e5, 0x6790e6, 0x9870e7, 
+    0x5280e8, 0xad60e9, 0x15f0ea, 0xea10eb, 0xf130ec, 0x0ed0ed, 0xb640ee, 0x49a0ef, 
+    0xeba0f0, 0x1440f1, 0xacd0f2, 0x5330f3, 0x4810f4, 0xb7f0f5, 0x0f60f6, 0xf080f7, 
+    0x3a70f8, 0xc590f9, 0x7d00fa, 0x82e0fb, 0x99c0fc, 0x6620fd, 0xdeb0fe, 0x2150ff};
+
+const unsigned int golay2412_enc1_gentab[16] = {
+    0x000000, 0x769100, 0x3b5200, 0x4dc300, 0x1db400, 0x6b2500, 0x26e600, 0x507700, 
+    0x8ed800, 0xf84900, 0xb58a00, 0xc31b00, 0x936c00, 0xe5fd00, 0xa83e00, 0xdeaf00};
+
+// syndrome tables: s = syn[0][r&0xff] ^ syn[1][(r>>8)&0xff] ^ syn[2][r>>16]
+const unsigned short int golay2412_syn_gentab[3][256] = {
+  {
+    0x000, 0xffe, 0x477, 0xb89, 0xa3b, 0x5c5, 0xe4c, 0x1b2, 
+    0xd1d, 0x2e3, 0x96a, 0x694, 0x726, 0x8d8, 0x351, 0xcaf, 
+    0x68f, 0x971, 0x2f8, 0xd06, 0xcb4, 0x34a, 0x8c3, 0x73d, 
+    0xb92, 0x46c, 0xfe5, 0x01b, 0x1a9, 0xe57, 0x5de, 0xa20, 
+    0xb47, 0x4b9, 0xf30, 0x0ce, 0x17c, 0xe82, 0x50b, 0xaf5, 
+    0x65a, 0x9a4, 0x22d, 0xdd3, 0xc61, 0x39f, 0x816, 0x7e8, 
+    0xdc8, 0x236, 0x9bf, 0x641, 0x7f3, 0x80d, 0x384, 0xc7a, 
+    0x0d5, 0xf2b, 0x4a2, 0xb5c, 0xaee, 0x510, 0xe99, 0x167, 
+    0xda3, 0x25d, 0x9d4, 0x62a, 0x798, 0x866, 0x3ef, 0xc11, 
+    0x0be, 0xf40, 0x4c9, 0xb37, 0xa85, 0x57b, 0xef2, 0x10c, 
+    0xb2c, 0x4d2, 0xf5b, 0x0a5, 0x117, 0xee9, 0x560, 0xa9e, 
+    0x631, 0x9cf, 0x246, 0xdb8, 0xc0a, 0x3f4, 0x87d, 0x783, 
+    0x6e4, 0x91a, 0x293, 0xd6d, 0xcdf, 0x321, 0x8a8, 0x756, 
+    0xbf9, 0x407, 0xf8e, 0x070, 0x1c2, 0xe3c, 0x5b5, 0xa4b, 
+    0x06b, 0xf95, 0x41c, 0xbe2, 0xa50, 0x5ae, 0xe27, 0x1d9, 
+    0xd76, 0x288, 0x901, 0x6ff, 0x74d, 0x8b3, 0x33a, 0xcc4, 
+    0xed1, 0x12f, 0xaa6, 0x558, 0x4ea, 0xb14, 0x09d, 0xf63, 
+    0x3cc, 0xc32, 0x7bb, 0x845, 0x9f7, 0x609, 0xd80, 0x27e, 
+    0x85e, 0x7a0, 0xc29, 0x3d7, 0x265, 0xd9b, 0x612, 0x9ec, 
+    0x543, 0xabd, 0x134, 0xeca, 0xf78, 0x086, 0xb0f, 0x4f1, 
+    0x596, 0xa68, 0x1e1, 0xe1f, 0xfad, 0x053, 0xbda, 0x424, 
+    0x88b, 0x775, 0xcfc, 0x302, 0x2b0, 0xd4e, 0x6c7, 0x939, 
+    0x319, 0xce7, 0x76e, 0x890, 0x922, 0x6dc, 0xd55, 0x2ab, 
+    0xe04, 0x1fa, 0xa73, 0x58d, 0x43f, 0xbc1, 0x048, 0xfb6, 
+    0x372, 0xc8c, 0x705, 0x8fb, 0x949, 0x6b7, 0xd3e, 0x2c0, 
+    0xe6f, 0x191, 0xa18, 0x5e6, 0x454, 0xbaa, 0x023, 0xfdd, 
+    0x5fd, 0xa03, 0x18a, 0xe74, 0xfc6, 0x038, 0xbb1, 0x44f, 
+    0x8e0, 0x71e, 0xc97, 0x369, 0x2db, 0xd25, 0x6ac, 0x952, 
+    0x835, 0x7cb, 0xc42, 0x3bc, 0x20e, 0xdf0, 0x679, 0x987, 
+    0x528, 0xad6, 0x15f, 0xea1, 0xf13, 0x0ed, 0xb64, 0x49a, 
+    0xeba, 0x144, 0xacd, 0x533, 0x481, 0xb7f, 0x0f6, 0xf08, 
+    0x3a7, 0xc59, 0x7d0, 0x82e, 0x99c, 0x662, 0xdeb, 0x215
+  },
+  {
+    0x000, 0x769, 0x3b5, 0x4dc, 0x1db, 0x6b2, 0x26e, 0x507, 
+    0x8ed, 0xf84, 0xb58, 0xc31, 0x936, 0xe5f, 0xa83, 0xdea, 
+    0x001, 0x768, 0x3b4, 0x4dd, 0x1da, 0x6b3, 0x26f, 0x506, 
+    0x8ec, 0xf85, 0xb59, 0xc30, 0x937, 0xe5e, 0xa82, 0xdeb, 
+    0x002, 0x76b, 0x3b7, 0x4de, 0x1d9, 0x6b0, 0x26c, 0x505, 
+    0x8ef, 0xf86, 0xb5a, 0xc33, 0x934, 0xe5d, 0xa81, 0xde8, 
+    0x003, 0x76a, 0x3b6, 0x4df, 0x1d8, 0x6b1, 0x26d, 0x504, 
+    0x8ee, 0xf87, 0xb5b, 0xc32, 0x935, 0xe5c, 0xa80, 0xde9, 
+    0x004, 0x76d, 0x3b1, 0x4d8, 0x1df, 0x6b6, 0x26a, 0x503, 
+    0x8e9, 0xf80, 0xb5c, 0xc35, 0x932, 0xe5b, 0xa87, 0xdee, 
+    0x005, 0x76c, 0x3b0, 0x4d9, 0x1de, 0x6b7, 0x26b, 0x502, 
+    0x8e8, 0xf81, 0xb5d, 0xc34, 0x933, 0xe5a, 0xa86, 0xdef, 
+    0x006, 0x76f, 0x3b3, 0x4da, 0x1dd, 0x6b4, 0x268, 0x501, 
+    0x8eb, 0xf82, 0xb5e, 0xc37, 0x930, 0xe59, 0xa85, 0xdec, 
+    0x007, 0x76e, 0x3b2, 0x4db, 0x1dc, 0x6b5, 0x269, 0x500, 
+    0x8ea, 0xf83, 0xb5f, 0xc36, 0x931, 0xe58, 0xa84, 0xded, 
+    0x008, 0x761, 0x3bd, 0x4d4, 0x1d3, 0x6ba, 0x266, 0x50f, 
+    0x8e5, 0xf8c, 0xb50, 0xc39, 0x93e, 0xe57, 0xa8b, 0xde2, 
+    0x009, 0x760, 0x3bc, 0x4d5, 0x1d2, 0x6bb, 0x267, 0x50e, 
+    0x8e4, 0xf8d, 0xb51, 0xc38, 0x93f, 0xe56, 0xa8a, 0xde3, 
+    0x00a, 0x763, 0x3bf, 0x4d6, 0x1d1, 0x6b8, 0x264, 0x50d, 
+    0x8e7, 0xf8e, 0xb52, 0xc3b, 0x93c, 0xe55, 0xa89, 0xde0, 
+    0x00b, 0x762, 0x3be, 0x4d7, 0x1d0, 0x6b9, 0x265, 0x50c, 
+    0x8e6, 0xf8f, 0xb53, 0xc3a, 0x93d, 0xe54, 0xa88, 0xde1, 
+    0x00c, 0x765, 0x3b9, 0x4d0, 0x1d7, 0x6be, 0x262, 0x50b, 
+    0x8e1, 0xf88, 0xb54, 0xc3d, 0x93a, 0xe53, 0xa8f, 0xde6, 
+    0x00d, 0x764, 0x3b8, 0x4d1, 0x1d6, 0x6bf, 0x263, 0x50a, 
+    0x8e0, 0xf89, 0xb55, 0xc3c, 0x93b, 0xe52, 0xa8e, 0xde7, 
+    0x00e, 0x767, 0x3bb, 0x4d2, 0x1d5, 0x6bc, 0x260, 0x509, 
+    0x8e3, 0xf8a, 0xb56, 0xc3f, 0x938, 0xe51, 0xa8d, 0xde4, 
+    0x00f, 0x766, 0x3ba, 0x4d3, 0x1d4, 0x6bd, 0x261, 0x508, 
+    0x8e2, 0xf8b, 0xb57, 0xc3e, 0x939, 0xe50, 0xa8c, 0xde5
+  },
+  {
+    0x000, 0x010, 0x020, 0x030, 0x040, 0x050, 0x060, 0x070, 
+    0x080, 0x090, 0x0a0, 0x0b0, 0x0c0, 0x0d0, 0x0e0, 0x0f0, 
+    0x100, 0x110, 0x120, 0x130, 0x140, 0x150, 0x160, 0x170, 
+    0x180, 0x190, 0x1a0, 0x1b0, 0x1c0, 0x1d0, 0x1e0, 0x1f0, 
+    0x200, 0x210, 0x220, 0x230, 0x240, 0x250, 0x260, 0x270, 
+    0x280, 0x290, 0x2a0, 0x2b0, 0x2c0, 0x2d0, 0x2e0, 0x2f0, 
+    0x300, 0x310, 0x320, 0x330, 0x340, 0x350, 0x360, 0x370, 
+    0x380, 0x390, 0x3a0, 0x3b0, 0x3c0, 0x3d0, 0x3e0, 0x3f0, 
+    0x400, 0x410, 0x420, 0x430, 0x440, 0x450, 0x460, 0x470, 
+    0x480, 0x490, 0x4a0, 0x4b0, 0x4c0, 0x4d0, 0x4e0, 0x4f0, 
+    0x500, 0x510, 0x520, 0x530, 0x540, 0x550, 0x560, 0x570, 
+    0x580, 0x590, 0x5a0, 0x5b0, 0x5c0, 0x5d0, 0x5e0, 0x5f0, 
+    0x600, 0x610, 0x620, 0x630, 0x640, 0x650, 0x660, 0x670, 
+    0x680, 0x690, 0x6a0, 0x6b0, 0x6c0, 0x6d0, 0x6e0, 0x6f0, 
+    0x700, 0x710, 0x720, 0x730, 0x740, 0x750, 0x760, 0x770, 
+    0x780, 0x790, 0x7a0, 0x7b0, 0x7c0, 0x7d0, 0x7e0, 0x7f0, 
+    0x800, 0x810, 0x820, 0x830, 0x840, 0x850, 0x860, 0x870, 
+    0x880, 0x890, 0x8a0, 0x8b0, 0x8c0, 0x8d0, 0x8e0, 0x8f0, 
+    0x900, 0x910, 0x920, 0x930, 0x940, 0x950, 0x960, 0x970, 
+    0x980, 0x990, 0x9a0, 0x9b0, 0x9c0, 0x9d0, 0x9e0, 0x9f0, 
+    0xa00, 0xa10, 0xa20, 0xa30, 0xa40, 0xa50, 0xa60, 0xa70, 
+    0xa80, 0xa90, 0xaa0, 0xab0, 0xac0, 0xad0, 0xae0, 0xaf0, 
+    0xb00, 0xb10, 0xb20, 0xb30, 0xb40, 0xb50, 0xb60, 0xb70, 
+    0xb80, 0xb90, 0xba0, 0xbb0, 0xbc0, 0xbd0, 0xbe0, 0xbf0, 
+    0xc00, 0xc10, 0xc20, 0xc30, 0xc40, 0xc50, 0xc60, 0xc70, 
+    0xc80, 0xc90, 0xca0, 0xcb0, 0xcc0, 0xcd0, 0xce0, 0xcf0, 
+    0xd00, 0xd10, 0xd20, 0xd30, 0xd40, 0xd50, 0xd60, 0xd70, 
+    0xd80, 0xd90, 0xda0, 0xdb0, 0xdc0, 0xdd0, 0xde0, 0xdf0, 
+    0xe00, 0xe10, 0xe20, 0xe30, 0xe40, 0xe50, 0xe60, 0xe70, 
+    0xe80, 0xe90, 0xea0, 0xeb0, 0xec0, 0xed0, 0xee0, 0xef0, 
+    0xf00, 0xf10, 0xf20, 0xf30, 0xf40, 0xf50, 0xf60, 0xf70, 
+    0xf80, 0xf90, 0xfa0, 0xfb0, 0xfc0, 0xfd0, 0xfe0, 0xff0
+  }
+};
+
+// message correction for each 12-bit syndrome: m = (r ^ dec[s]) & 0xfff
+const unsigned short int golay2412_dec_gentab[4096] = {
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0xa20, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x081, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x510, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x10c, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x041, 0x090, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x070, 0x000, 0x800, 0x600, 0x000, 
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x288, 0x901, 0x000, 0x024, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x101, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x086, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x424, 
+    0x000, 0x000, 0x000, 0x302, 0x000, 0x800, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x890, 0x000, 0x200, 0x048, 0x000, 
+    0x000, 0x021, 0x048, 0x000, 0x048, 0x000, 0x048, 0x048, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x2c0, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x800, 0x023, 0x000, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x038, 0x804, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x300, 0x000, 0x000, 0x400, 
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x800, 0x110, 0x000, 
+    0x000, 0x800, 0x084, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x144, 0x220, 0x000, 0x481, 0x000, 0x000, 0x002, 
+    0x012, 0x000, 0x000, 0x400, 0x000, 0x800, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x081, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x054, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x008, 0x102, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x081, 
+    0x000, 0x000, 0x000, 0x081, 0x000, 0x081, 0x081, 0x081, 
+    0x000, 0x000, 0x000, 0x128, 0x000, 0x200, 0xc00, 0x000, 
+    0x000, 0x842, 0x210, 0x000, 0x024, 0x000, 0x000, 0x081, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x212, 0x840, 0x000, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x980, 0x209, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x024, 0x000, 0x000, 0x400, 
+    0x000, 0x000, 0x000, 0xa04, 0x000, 0x448, 0x110, 0x000, 
+    0x000, 0x100, 0x00a, 0x000, 0x024, 0x000, 0x000, 0x081, 
+    0x000, 0x011, 0x0c0, 0x000, 0x024, 0x000, 0x000, 0x002, 
+    0x024, 0x000, 0x000, 0x400, 0x024, 0x024, 0x024, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x80a, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x160, 0x204, 0x000, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x200, 0x0a0, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x811, 0x000, 0x000, 0x400, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x200, 0x110, 0x000, 
+    0x000, 0x01c, 0x820, 0x000, 0x402, 0x000, 0x000, 0x081, 
+    0x000, 0x200, 0x007, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x180, 0x000, 0x000, 0x400, 0x000, 0x200, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x005, 0x110, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x088, 0x000, 0x000, 0x400, 
+    0x000, 0x400, 0x400, 0x400, 0x042, 0x000, 0x000, 0x400, 
+    0x400, 0x400, 0x400, 0x400, 0x000, 0x400, 0x400, 0x400, 
+    0x000, 0x0a2, 0x110, 0x000, 0x110, 0x000, 0x110, 0x110, 
+    0x241, 0x000, 0x000, 0x400, 0x000, 0x800, 0x110, 0x000, 
+    0x808, 0x000, 0x000, 0x400, 0x000, 0x200, 0x110, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x024, 0x000, 0x000, 0x400, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x488, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x041, 0x102, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x940, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x02a, 0x600, 0x000, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x200, 0x031, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x880, 0x000, 0x000, 0x004, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020, 
+    0x000, 0x000, 0x000, 0x882, 0x000, 0x041, 0x600, 0x000, 
+    0x000, 0x000, 0x000, 0x310, 0x000, 0x041, 0x804, 0x000, 
+    0x000, 0x041, 0x028, 0x000, 0x041, 0x041, 0x000, 0x041, 
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x094, 0x600, 0x000, 
+    0x000, 0x100, 0x600, 0x000, 0x600, 0x000, 0x600, 0x600, 
+    0x000, 0xc20, 0x0c0, 0x000, 0x108, 0x000, 0x000, 0x002, 
+    0x012, 0x000, 0x000, 0x004, 0x000, 0x041, 0x600, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x000, 0x000, 0x000, 0x062, 0x000, 0x200, 0x804, 0x000, 
+    0x000, 0x908, 0x281, 0x000, 0x420, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x200, 0x082, 0x000, 
+    0x000, 0x4c0, 0x820, 0x000, 0x105, 0x000, 0x000, 0x010, 
+    0x000, 0x200, 0x500, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x012, 0x000, 0x000, 0x004, 0x000, 0x200, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x502, 0x804, 0x000, 
+    0x000, 0x224, 0x140, 0x000, 0x088, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x804, 0x000, 0x804, 0x000, 0x804, 0x804, 
+    0x012, 0x000, 0x000, 0x400, 0x000, 0x041, 0x804, 0x000, 
+    0x000, 0x009, 0x009, 0x009, 0x060, 0x000, 0x000, 0x009, 
+    0x012, 0x000, 0x000, 0x009, 0x000, 0x800, 0x600, 0x000, 
+    0x012, 0x000, 0x000, 0x009, 0x000, 0x200, 0x804, 0x000, 
+    0x012, 0x012, 0x012, 0x000, 0x012, 0x000, 0x000, 0x1a0, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020, 
+    0x000, 0x000, 0x000, 0x248, 0x000, 0xc04, 0x102, 0x000, 
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x200, 0x102, 0x000, 
+    0x000, 0x0b0, 0x102, 0x000, 0x102, 0x000, 0x102, 0x102, 
+    0x000, 0x000, 0x000, 0x412, 0x000, 0x200, 0x00c, 0x000, 
+    0x000, 0x100, 0x820, 0x000, 0x050, 0x000, 0x000, 0x081, 
+    0x000, 0x200, 0x0c0, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x409, 0x000, 0x000, 0x004, 0x000, 0x200, 0x102, 0x000, 
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0x000, 0x100, 0x015, 0x000, 0x088, 0x000, 0x000, 0x020, 
+    0x000, 0x00e, 0x0c0, 0x000, 0x410, 0x000, 0x000, 0x020, 
+    0xa00, 0x000, 0x000, 0x400, 0x000, 0x041, 0x102, 0x000, 
+    0x000, 0x100, 0x0c0, 0x000, 0x803, 0x000, 0x000, 0x020, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x600, 0x000, 
+    0x0c0, 0x000, 0x0c0, 0x0c0, 0x000, 0x200, 0x0c0, 0x000, 
+    0x000, 0x100, 0x0c0, 0x000, 0x024, 0x000, 0x000, 0x818, 
+    0x000, 0x000, 0x000, 0x184, 0x000, 0x200, 0x441, 0x000, 
+    0x000, 0x003, 0x820, 0x000, 0x088, 0x000, 0x000, 0x010, 
+    0x000, 0x200, 0x018, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x044, 0x000, 0x000, 0x400, 0x000, 0x200, 0x102, 0x000, 
+    0x000, 0x200, 0x820, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x820, 0x000, 0x820, 0x820, 0x000, 0x200, 0x820, 0x000, 
+    0x200, 0x200, 0x000, 0x200, 0x200, 0x200, 0x200, 0x200, 
+    0x000, 0x200, 0x820, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x000, 0x850, 0x202, 0x000, 0x088, 0x000, 0x000, 0x020, 
+    0x088, 0x000, 0x000, 0x400, 0x088, 0x088, 0x088, 0x000, 
+    0x121, 0x000, 0x000, 0x400, 0x000, 0x200, 0x804, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x088, 0x000, 0x000, 0x400, 
+    0x404, 0x000, 0x000, 0x009, 0x000, 0x200, 0x110, 0x000, 
+    0x000, 0x100, 0x820, 0x000, 0x088, 0x000, 0x000, 0x046, 
+    0x000, 0x200, 0x0c0, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x012, 0x000, 0x000, 0x400, 0x000, 0x200, 0x001, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x1c0, 0x000, 0x008, 0x405, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0xc08, 0x000, 0x244, 0x120, 0x000, 
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x021, 0x210, 0x000, 0x880, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x4a0, 0x840, 0x000, 
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x814, 0x028, 0x000, 0x300, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x100, 0x084, 0x000, 0x019, 0x000, 0x000, 0x002, 
+    0x000, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 
+    0x440, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x000, 0x000, 0x000, 0x20c, 0x000, 0xc40, 0x0a0, 0x000, 
+    0x000, 0x021, 0x802, 0x000, 0x300, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x188, 0xa01, 0x000, 
+    0x000, 0x021, 0x084, 0x000, 0x402, 0x000, 0x000, 0x010, 
+    0x000, 0x021, 0x500, 0x000, 0x014, 0x000, 0x000, 0x002, 
+    0x021, 0x021, 0x000, 0x021, 0x000, 0x021, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x920, 0x000, 0x005, 0x408, 0x000, 
+    0x000, 0x04a, 0x084, 0x000, 0x300, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x051, 0x000, 0x300, 0x000, 0x000, 0x002, 
+    0x300, 0x000, 0x000, 0x400, 0x300, 0x300, 0x300, 0x000, 
+    0x000, 0x610, 0x084, 0x000, 0x060, 0x000, 0x000, 0x002, 
+    0x084, 0x000, 0x084, 0x084, 0x000, 0x800, 0x084, 0x000, 
+    0x808, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x021, 0x084, 0x000, 0x300, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x700, 
+    0x000, 0x000, 0x000, 0x026, 0x000, 0x008, 0x840, 0x000, 
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x008, 0x0a0, 0x000, 
+    0x000, 0x008, 0x210, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x830, 0x00c, 0x000, 
+    0x000, 0x100, 0x210, 0x000, 0x402, 0x000, 0x000, 0x081, 
+    0x000, 0x484, 0x210, 0x000, 0x141, 0x000, 0x000, 0x002, 
+    0x210, 0x000, 0x210, 0x210, 0x000, 0x008, 0x210, 0x000, 
+    0x000, 0x000, 0x000, 0x098, 0x000, 0x005, 0x840, 0x000, 
+    0x000, 0x100, 0x840, 0x000, 0x840, 0x000, 0x840, 0x840, 
+    0x000, 0x260, 0x104, 0x000, 0x410, 0x000, 0x000, 0x002, 
+    0x083, 0x000, 0x000, 0x400, 0x000, 0x008, 0x840, 0x000, 
+    0x000, 0x100, 0x421, 0x000, 0x280, 0x000, 0x000, 0x002, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x840, 0x000, 
+    0x808, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x100, 0x210, 0x000, 0x024, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x005, 0x0a0, 0x000, 
+    0x000, 0xa80, 0x109, 0x000, 0x402, 0x000, 0x000, 0x010, 
+    0x000, 0x112, 0x0a0, 0x000, 0x0a0, 0x000, 0x0a0, 0x0a0, 
+    0x044, 0x000, 0x000, 0x400, 0x000, 0x008, 0x0a0, 0x000, 
+    0x000, 0x040, 0x040, 0x040, 0x402, 0x000, 0x000, 0x040, 
+    0x402, 0x000, 0x000, 0x040, 0x402, 0x402, 0x402, 0x000, 
+    0x808, 0x000, 0x000, 0x040, 0x000, 0x200, 0x0a0, 0x000, 
+    0x000, 0x021, 0x210, 0x000, 0x402, 0x000, 0x000, 0x904, 
+    0x000, 0x005, 0x202, 0x000, 0x005, 0x005, 0x000, 0x005, 
+    0x030, 0x000, 0x000, 0x400, 0x000, 0x005, 0x840, 0x000, 
+    0x808, 0x000, 0x000, 0x400, 0x000, 0x005, 0x0a0, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x300, 0x000, 0x000, 0x400, 
+    0x808, 0x000, 0x000, 0x040, 0x000, 0x005, 0x110, 0x000, 
+    0x000, 0x100, 0x084, 0x000, 0x402, 0x000, 0x000, 0x228, 
+    0x808, 0x808, 0x808, 0x000, 0x808, 0x000, 0x000, 0x002, 
+    0x808, 0x000, 0x000, 0x400, 0x000, 0x0d0, 0x001, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x124, 0x240, 0x000, 
+    0x000, 0x602, 0x028, 0x000, 0x880, 0x000, 0x000, 0x010, 
+    0x000, 0x000, 0x000, 0x2a0, 0x000, 0x401, 0x00c, 0x000, 
+    0x000, 0x100, 0x043, 0x000, 0x880, 0x000, 0x000, 0x010, 
+    0x000, 0x058, 0x500, 0x000, 0x880, 0x000, 0x000, 0x002, 
+    0x880, 0x000, 0x000, 0x004, 0x880, 0x880, 0x880, 0x000, 
+    0x000, 0x000, 0x000, 0x444, 0x000, 0xa08, 0x181, 0x000, 
+    0x000, 0x100, 0x028, 0x000, 0x006, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x028, 0x000, 0x410, 0x000, 0x000, 0x002, 
+    0x028, 0x000, 0x028, 0x028, 0x000, 0x041, 0x028, 0x000, 
+    0x000, 0x100, 0x810, 0x000, 0x060, 0x000, 0x000, 0x002, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x600, 0x000, 
+    0x205, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x000, 0x100, 0x028, 0x000, 0x880, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x000, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 
+    0x000, 0x080, 0x500, 0x000, 0x00b, 0x000, 0x000, 0x010, 
+    0x044, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x000, 0x806, 0x500, 0x000, 0x060, 0x000, 0x000, 0x010, 
+    0x208, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x500, 0x000, 0x500, 0x500, 0x000, 0x200, 0x500, 0x000, 
+    0x000, 0x021, 0x500, 0x000, 0x880, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x202, 0x000, 0x060, 0x000, 0x000, 0x010, 
+    0xc01, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x804, 0x000, 
+    0x000, 0x080, 0x028, 0x000, 0x300, 0x000, 0x000, 0x010, 
+    0x060, 0x000, 0x000, 0x009, 0x060, 0x060, 0x060, 0x000, 
+    0x000, 0x100, 0x084, 0x000, 0x060, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x500, 0x000, 0x060, 0x000, 0x000, 0x002, 
+    0x012, 0x000, 0x000, 0xa40, 0x000, 0x40c, 0x001, 0x000, 
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x0c2, 0x00c, 0x000, 
+    0x000, 0x100, 0x480, 0x000, 0x221, 0x000, 0x000, 0x010, 
+    0x000, 0x801, 0x801, 0x801, 0x410, 0x000, 0x000, 0x801, 
+    0x044, 0x000, 0x000, 0x801, 0x000, 0x008, 0x102, 0x000, 
+    0x000, 0x100, 0x00c, 0x000, 0x00c, 0x000, 0x00c, 0x00c, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x00c, 0x000, 
+    0x022, 0x000, 0x000, 0x801, 0x000, 0x200, 0x00c, 0x000, 
+    0x000, 0x100, 0x210, 0x000, 0x880, 0x000, 0x000, 0x460, 
+    0x000, 0x100, 0x202, 0x000, 0x410, 0x000, 0x000, 0x020, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x840, 0x000, 
+    0x410, 0x000, 0x000, 0x801, 0x410, 0x410, 0x410, 0x000, 
+    0x000, 0x100, 0x028, 0x000, 0x410, 0x000, 0x000, 0x284, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x00c, 0x000, 
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x000, 0x100, 
+    0x000, 0x100, 0x0c0, 0x000, 0x410, 0x000, 0x000, 0x002, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x001, 0x000, 
+    0x000, 0x428, 0x202, 0x000, 0x900, 0x000, 0x000, 0x010, 
+    0x044, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x044, 0x000, 0x000, 0x801, 0x000, 0x200, 0x0a0, 0x000, 
+    0x044, 0x044, 0x044, 0x000, 0x044, 0x000, 0x000, 0x010, 
+    0x091, 0x000, 0x000, 0x040, 0x000, 0x200, 0x00c, 0x000, 
+    0x000, 0x100, 0x820, 0x000, 0x402, 0x000, 0x000, 0x010, 
+    0x000, 0x200, 0x500, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x044, 0x000, 0x000, 0x08a, 0x000, 0x200, 0x001, 0x000, 
+    0x202, 0x000, 0x202, 0x202, 0x000, 0x005, 0x202, 0x000, 
+    0x000, 0x100, 0x202, 0x000, 0x088, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x202, 0x000, 0x410, 0x000, 0x000, 0x148, 
+    0x044, 0x000, 0x000, 0x400, 0x000, 0x822, 0x001, 0x000, 
+    0x000, 0x100, 0x202, 0x000, 0x060, 0x000, 0x000, 0xc80, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x001, 0x000, 
+    0x808, 0x000, 0x000, 0x034, 0x000, 0x200, 0x001, 0x000, 
+    0x000, 0x100, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x442, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x101, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x008, 0x090, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x218, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x800, 0x120, 0x000, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x0e0, 0xc00, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x203, 0x000, 0x000, 0x004, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020, 
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x800, 0x090, 0x000, 
+    0x000, 0x000, 0x000, 0x848, 0x000, 0x604, 0x090, 0x000, 
+    0x000, 0x122, 0x090, 0x000, 0x090, 0x000, 0x090, 0x090, 
+    0x000, 0x000, 0x000, 0x580, 0x000, 0x800, 0x045, 0x000, 
+    0x000, 0x800, 0x00a, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x011, 0x220, 0x000, 0x108, 0x000, 0x000, 0x002, 
+    0x440, 0x000, 0x000, 0x004, 0x000, 0x800, 0x090, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x101, 
+    0x000, 0x000, 0x000, 0x0a8, 0x000, 0x800, 0x204, 0x000, 
+    0x000, 0x000, 0x000, 0x101, 0x000, 0x101, 0x101, 0x101, 
+    0x000, 0x250, 0x802, 0x000, 0x420, 0x000, 0x000, 0x101, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x800, 0x082, 0x000, 
+    0x000, 0x800, 0x411, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x40a, 0x220, 0x000, 0x014, 0x000, 0x000, 0x101, 
+    0x180, 0x000, 0x000, 0x004, 0x000, 0x800, 0x048, 0x000, 
+    0x000, 0x000, 0x000, 0x016, 0x000, 0x800, 0x408, 0x000, 
+    0x000, 0x800, 0x140, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x080, 0x220, 0x000, 0x042, 0x000, 0x000, 0x101, 
+    0x00d, 0x000, 0x000, 0x400, 0x000, 0x800, 0x090, 0x000, 
+    0x000, 0x800, 0x220, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x800, 0x800, 0x000, 0x800, 0x800, 0x800, 0x800, 0x800, 
+    0x220, 0x000, 0x220, 0x220, 0x000, 0x800, 0x220, 0x000, 
+    0x000, 0x800, 0x220, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020, 
+    0x000, 0x000, 0x000, 0x910, 0x000, 0x008, 0x204, 0x000, 
+    0x000, 0x000, 0x000, 0x282, 0x000, 0x008, 0xc00, 0x000, 
+    0x000, 0x008, 0x061, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x106, 0xc00, 0x000, 
+    0x000, 0x620, 0x00a, 0x000, 0x050, 0x000, 0x000, 0x081, 
+    0x000, 0x011, 0xc00, 0x000, 0xc00, 0x000, 0xc00, 0xc00, 
+    0x180, 0x000, 0x000, 0x004, 0x000, 0x008, 0xc00, 0x000, 
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0x000, 0x0c4, 0x00a, 0x000, 0x501, 0x000, 0x000, 0x020, 
+    0x000, 0x011, 0x104, 0x000, 0x042, 0x000, 0x000, 0x020, 
+    0xa00, 0x000, 0x000, 0x400, 0x000, 0x008, 0x090, 0x000, 
+    0x000, 0x011, 0x00a, 0x000, 0x280, 0x000, 0x000, 0x020, 
+    0x00a, 0x000, 0x00a, 0x00a, 0x000, 0x800, 0x00a, 0x000, 
+    0x011, 0x011, 0x000, 0x011, 0x000, 0x011, 0xc00, 0x000, 
+    0x000, 0x011, 0x00a, 0x000, 0x024, 0x000, 0x000, 0x340, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x490, 0x204, 0x000, 
+    0x000, 0x003, 0x204, 0x000, 0x204, 0x000, 0x204, 0x204, 
+    0x000, 0x824, 0x018, 0x000, 0x042, 0x000, 0x000, 0x101, 
+    0x180, 0x000, 0x000, 0x400, 0x000, 0x008, 0x204, 0x000, 
+    0x000, 0x040, 0x040, 0x040, 0x029, 0x000, 0x000, 0x040, 
+    0x180, 0x000, 0x000, 0x040, 0x000, 0x800, 0x204, 0x000, 
+    0x180, 0x000, 0x000, 0x040, 0x000, 0x200, 0xc00, 0x000, 
+    0x180, 0x180, 0x180, 0x000, 0x180, 0x000, 0x000, 0x032, 
+    0x000, 0x308, 0x881, 0x000, 0x042, 0x000, 0x000, 0x020, 
+    0x030, 0x000, 0x000, 0x400, 0x000, 0x800, 0x204, 0x000, 
+    0x042, 0x000, 0x000, 0x400, 0x042, 0x042, 0x042, 0x000, 
+    0x000, 0x400, 0x400, 0x400, 0x042, 0x000, 0x000, 0x400, 
+    0x404, 0x000, 0x000, 0x040, 0x000, 0x800, 0x110, 0x000, 
+    0x000, 0x800, 0x00a, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x011, 0x220, 0x000, 0x042, 0x000, 0x000, 0x08c, 
+    0x180, 0x000, 0x000, 0x400, 0x000, 0x800, 0x001, 0x000, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x380, 0x809, 0x000, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x812, 0x240, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x420, 0x000, 0x000, 0x004, 
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x401, 0x082, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x050, 0x000, 0x000, 0x004, 
+    0x000, 0x004, 0x004, 0x004, 0x108, 0x000, 0x000, 0x004, 
+    0x004, 0x004, 0x004, 0x004, 0x000, 0x004, 0x004, 0x004, 
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0x000, 0x418, 0x140, 0x000, 0x006, 0x000, 0x000, 0x020, 
+    0x000, 0x080, 0x403, 0x000, 0x108, 0x000, 0x000, 0x020, 
+    0xa00, 0x000, 0x000, 0x004, 0x000, 0x041, 0x090, 0x000, 
+    0x000, 0x242, 0x810, 0x000, 0x108, 0x000, 0x000, 0x020, 
+    0x0a1, 0x000, 0x000, 0x004, 0x000, 0x800, 0x600, 0x000, 
+    0x108, 0x000, 0x000, 0x004, 0x108, 0x108, 0x108, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x108, 0x000, 0x000, 0x004, 
+    0x000, 0x000, 0x000, 0xe00, 0x000, 0x04c, 0x082, 0x000, 
+    0x000, 0x003, 0x140, 0x000, 0x420, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x018, 0x000, 0x420, 0x000, 0x000, 0x101, 
+    0x420, 0x000, 0x000, 0x004, 0x420, 0x420, 0x420, 0x000, 
+    0x000, 0x130, 0x082, 0x000, 0x082, 0x000, 0x082, 0x082, 
+    0x208, 0x000, 0x000, 0x004, 0x000, 0x800, 0x082, 0x000, 
+    0x841, 0x000, 0x000, 0x004, 0x000, 0x200, 0x082, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x420, 0x000, 0x000, 0x004, 
+    0x000, 0x080, 0x140, 0x000, 0x211, 0x000, 0x000, 0x020, 
+    0x140, 0x000, 0x140, 0x140, 0x000, 0x800, 0x140, 0x000, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x804, 0x000, 
+    0x000, 0x080, 0x140, 0x000, 0x420, 0x000, 0x000, 0x20a, 
+    0x404, 0x000, 0x000, 0x009, 0x000, 0x800, 0x082, 0x000, 
+    0x000, 0x800, 0x140, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x080, 0x220, 0x000, 0x108, 0x000, 0x000, 0x450, 
+    0x012, 0x000, 0x000, 0x004, 0x000, 0x800, 0x001, 0x000, 
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0x000, 0x003, 0x480, 0x000, 0x050, 0x000, 0x000, 0x020, 
+    0x000, 0x540, 0x018, 0x000, 0x085, 0x000, 0x000, 0x020, 
+    0xa00, 0x000, 0x000, 0x004, 0x000, 0x008, 0x102, 0x000, 
+    0x000, 0x888, 0x301, 0x000, 0x050, 0x000, 0x000, 0x020, 
+    0x050, 0x000, 0x000, 0x004, 0x050, 0x050, 0x050, 0x000, 
+    0x022, 0x000, 0x000, 0x004, 0x000, 0x200, 0xc00, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x050, 0x000, 0x000, 0x004, 
+    0x000, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 
+    0xa00, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0xa00, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0xa00, 0xa00, 0xa00, 0x000, 0xa00, 0x000, 0x000, 0x020, 
+    0x404, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0x000, 0x100, 0x00a, 0x000, 0x050, 0x000, 0x000, 0x020, 
+    0x000, 0x011, 0x0c0, 0x000, 0x108, 0x000, 0x000, 0x020, 
+    0xa00, 0x000, 0x000, 0x004, 0x000, 0x482, 0x001, 0x000, 
+    0x000, 0x003, 0x018, 0x000, 0x900, 0x000, 0x000, 0x020, 
+    0x003, 0x003, 0x000, 0x003, 0x000, 0x003, 0x204, 0x000, 
+    0x018, 0x000, 0x018, 0x018, 0x000, 0x200, 0x018, 0x000, 
+    0x000, 0x003, 0x018, 0x000, 0x420, 0x000, 0x000, 0x8c0, 
+    0x404, 0x000, 0x000, 0x040, 0x000, 0x200, 0x082, 0x000, 
+    0x000, 0x003, 0x820, 0x000, 0x050, 0x000, 0x000, 0x508, 
+    0x000, 0x200, 0x018, 0x000, 0x200, 0x200, 0x000, 0x200, 
+    0x180, 0x000, 0x000, 0x004, 0x000, 0x200, 0x001, 0x000, 
+    0x404, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0x000, 0x003, 0x140, 0x000, 0x088, 0x000, 0x000, 0x020, 
+    0x000, 0x080, 0x018, 0x000, 0x042, 0x000, 0x000, 0x020, 
+    0xa00, 0x000, 0x000, 0x400, 0x000, 0x114, 0x001, 0x000, 
+    0x404, 0x404, 0x404, 0x000, 0x404, 0x000, 0x000, 0x020, 
+    0x404, 0x000, 0x000, 0x290, 0x000, 0x800, 0x001, 0x000, 
+    0x404, 0x000, 0x000, 0x902, 0x000, 0x200, 0x001, 0x000, 
+    0x000, 0x068, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x884, 
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x008, 0x120, 0x000, 
+    0x000, 0x000, 0x000, 0x430, 0x000, 0x008, 0x240, 0x000, 
+    0x000, 0x008, 0x802, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x401, 0x120, 0x000, 
+    0x000, 0x092, 0x120, 0x000, 0x120, 0x000, 0x120, 0x120, 
+    0x000, 0xb00, 0x089, 0x000, 0x014, 0x000, 0x000, 0x002, 
+    0x440, 0x000, 0x000, 0x004, 0x000, 0x008, 0x120, 0x000, 
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x150, 0x408, 0x000, 
+    0x000, 0x201, 0x201, 0x201, 0x006, 0x000, 0x000, 0x201, 
+    0x000, 0x080, 0x104, 0x000, 0x821, 0x000, 0x000, 0x002, 
+    0x440, 0x000, 0x000, 0x201, 0x000, 0x008, 0x090, 0x000, 
+    0x000, 0x02c, 0x810, 0x000, 0x280, 0x000, 0x000, 0x002, 
+    0x440, 0x000, 0x000, 0x201, 0x000, 0x800, 0x120, 0x000, 
+    0x440, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002, 
+    0x440, 0x440, 0x440, 0x000, 0x440, 0x000, 0x000, 0x002, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x222, 0x408, 0x000, 
+    0x000, 0x504, 0x802, 0x000, 0x0c1, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x802, 0x000, 0x014, 0x000, 0x000, 0x101, 
+    0x802, 0x000, 0x802, 0x802, 0x000, 0x008, 0x802, 0x000, 
+    0x000, 0x040, 0x040, 0x040, 0x014, 0x000, 0x000, 0x040, 
+    0x208, 0x000, 0x000, 0x040, 0x000, 0x800, 0x120, 0x000, 
+    0x014, 0x000, 0x000, 0x040, 0x014, 0x014, 0x014, 0x000, 
+    0x000, 0x021, 0x802, 0x000, 0x014, 0x000, 0x000, 0x680, 
+    0x000, 0x080, 0x408, 0x000, 0x408, 0x000, 0x408, 0x408, 
+    0x030, 0x000, 0x000, 0x201, 0x000, 0x800, 0x408, 0x000, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x408, 0x000, 
+    0x000, 0x080, 0x802, 0x000, 0x300, 0x000, 0x000, 0x064, 
+    0x103, 0x000, 0x000, 0x040, 0x000, 0x800, 0x408, 0x000, 
+    0x000, 0x800, 0x084, 0x000, 0x800, 0x800, 0x000, 0x800, 
+    0x000, 0x080, 0x220, 0x000, 0x014, 0x000, 0x000, 0x002, 
+    0x440, 0x000, 0x000, 0x118, 0x000, 0x800, 0x001, 0x000, 
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x008, 0x013, 0x000, 
+    0x000, 0x008, 0x480, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x000, 0x008, 0x104, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x008, 0x008, 0x000, 0x008, 0x008, 0x008, 0x008, 0x008, 
+    0x000, 0x040, 0x040, 0x040, 0x280, 0x000, 0x000, 0x040, 
+    0x805, 0x000, 0x000, 0x040, 0x000, 0x008, 0x120, 0x000, 
+    0x022, 0x000, 0x000, 0x040, 0x000, 0x008, 0xc00, 0x000, 
+    0x000, 0x008, 0x210, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x000, 0xc02, 0x104, 0x000, 0x280, 0x000, 0x000, 0x020, 
+    0x030, 0x000, 0x000, 0x201, 0x000, 0x008, 0x840, 0x000, 
+    0x104, 0x000, 0x104, 0x104, 0x000, 0x008, 0x104, 0x000, 
+    0x000, 0x008, 0x104, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x280, 0x000, 0x000, 0x040, 0x280, 0x280, 0x280, 0x000, 
+    0x000, 0x100, 0x00a, 0x000, 0x280, 0x000, 0x000, 0x414, 
+    0x000, 0x011, 0x104, 0x000, 0x280, 0x000, 0x000, 0x002, 
+    0x440, 0x000, 0x000, 0x8a0, 0x000, 0x008, 0x001, 0x000, 
+    0x000, 0x040, 0x040, 0x040, 0x900, 0x000, 0x000, 0x040, 
+    0x030, 0x000, 0x000, 0x040, 0x000, 0x008, 0x204, 0x000, 
+    0x601, 0x000, 0x000, 0x040, 0x000, 0x008, 0x0a0, 0x000, 
+    0x000, 0x008, 0x802, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x040, 0x040, 0x040, 0x040, 0x000, 0x040, 0x040, 0x040, 
+    0x000, 0x040, 0x040, 0x040, 0x402, 0x000, 0x000, 0x040, 
+    0x000, 0x040, 0x040, 0x040, 0x014, 0x000, 0x000, 0x040, 
+    0x180, 0x000, 0x000, 0x040, 0x000, 0x008, 0x001, 0x000, 
+    0x030, 0x000, 0x000, 0x040, 0x000, 0x005, 0x408, 0x000, 
+    0x030, 0x030, 0x030, 0x000, 0x030, 0x000, 0x000, 0x182, 
+    0x000, 0x080, 0x104, 0x000, 0x042, 0x000, 0x000, 0xa10, 
+    0x030, 0x000, 0x000, 0x400, 0x000, 0x008, 0x001, 0x000, 
+    0x000, 0x040, 0x040, 0x040, 0x280, 0x000, 0x000, 0x040, 
+    0x030, 0x000, 0x000, 0x040, 0x000, 0x800, 0x001, 0x000, 
+    0x808, 0x000, 0x000, 0x040, 0x000, 0x520, 0x001, 0x000, 
+    0x000, 0x206, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x000, 0x000, 0x000, 0x10a, 0x000, 0x401, 0x240, 0x000, 
+    0x000, 0x860, 0x480, 0x000, 0x006, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x240, 0x000, 0x240, 0x000, 0x240, 0x240, 
+    0x111, 0x000, 0x000, 0x004, 0x000, 0x008, 0x240, 0x000, 
+    0x000, 0x401, 0x810, 0x000, 0x401, 0x401, 0x000, 0x401, 
+    0x208, 0x000, 0x000, 0x004, 0x000, 0x401, 0x120, 0x000, 
+    0x022, 0x000, 0x000, 0x004, 0x000, 0x401, 0x240, 0x000, 
+    0x000, 0x004, 0x004, 0x004, 0x880, 0x000, 0x000, 0x004, 
+    0x000, 0x080, 0x810, 0x000, 0x006, 0x000, 0x000, 0x020, 
+    0x006, 0x000, 0x000, 0x201, 0x006, 0x006, 0x006, 0x000, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x240, 0x000, 
+    0x000, 0x080, 0x028, 0x000, 0x006, 0x000, 0x000, 0xd00, 
+    0x810, 0x000, 0x810, 0x810, 0x000, 0x401, 0x810, 0x000, 
+    0x000, 0x100, 0x810, 0x000, 0x006, 0x000, 0x000, 0x0c8, 
+    0x000, 0x080, 0x810, 0x000, 0x108, 0x000, 0x000, 0x002, 
+    0x440, 0x000, 0x000, 0x004, 0x000, 0x230, 0x001, 0x000, 
+    0x000, 0x080, 0x025, 0x000, 0x900, 0x000, 0x000, 0x010, 
+    0x208, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x240, 0x000, 
+    0x000, 0x080, 0x802, 0x000, 0x420, 0x000, 0x000, 0x010, 
+    0x208, 0x000, 0x000, 0x040, 0x000, 0x401, 0x082, 0x000, 
+    0x208, 0x208, 0x208, 0x000, 0x208, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x500, 0x000, 0x014, 0x000, 0x000, 0x828, 
+    0x208, 0x000, 0x000, 0x004, 0x000, 0x142, 0x001, 0x000, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x408, 0x000, 
+    0x000, 0x080, 0x140, 0x000, 0x006, 0x000, 0x000, 0x010, 
+    0x080, 0x080, 0x080, 0x080, 0x080, 0x080, 0x000, 0x080, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x001, 0x000, 
+    0x000, 0x080, 0x810, 0x000, 0x060, 0x000, 0x000, 0x304, 
+    0x208, 0x000, 0x000, 0x422, 0x000, 0x800, 0x001, 0x000, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x001, 0x000, 
+    0x000, 0x080, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x000, 0x214, 0x480, 0x000, 0x900, 0x000, 0x000, 0x020, 
+    0x480, 0x000, 0x480, 0x480, 0x000, 0x008, 0x480, 0x000, 
+    0x022, 0x000, 0x000, 0x801, 0x000, 0x008, 0x240, 0x000, 
+    0x000, 0x008, 0x480, 0x000, 0x008, 0x008, 0x000, 0x008, 
+    0x022, 0x000, 0x000, 0x040, 0x000, 0x401, 0x00c, 0x000, 
+    0x000, 0x100, 0x480, 0x000, 0x050, 0x000, 0x000, 0xa02, 
+    0x022, 0x022, 0x022, 0x000, 0x022, 0x000, 0x000, 0x190, 
+    0x022, 0x000, 0x000, 0x004, 0x000, 0x008, 0x001, 0x000, 
+    0x049, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020, 
+    0x000, 0x100, 0x480, 0x000, 0x006, 0x000, 0x000, 0x020, 
+    0x000, 0x080, 0x104, 0x000, 0x410, 0x000, 0x000, 0x020, 
+    0xa00, 0x000, 0x000, 0x052, 0x000, 0x008, 0x001, 0x000, 
+    0x000, 0x100, 0x810, 0x000, 0x280, 0x000, 0x000, 0x020, 
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x001, 0x000, 
+    0x022, 0x000, 0x000, 0x608, 0x000, 0x844, 0x001, 0x000, 
+    0x000, 0x100, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x900, 0x000, 0x000, 0x040, 0x900, 0x900, 0x900, 0x000, 
+    0x000, 0x003, 0x480, 0x000, 0x900, 0x000, 0x000, 0x010, 
+    0x000, 0x080, 0x018, 0x000, 0x900, 0x000, 0x000, 0x406, 
+    0x044, 0x000, 0x000, 0x320, 0x000, 0x008, 0x001, 0x000, 
+    0x000, 0x040, 0x040, 0x040, 0x900, 0x000, 0x000, 0x040, 
+    0x208, 0x000, 0x000, 0x040, 0x000, 0x0a4, 0x001, 0x000, 
+    0x022, 0x000, 0x000, 0x040, 0x000, 0x200, 0x001, 0x000, 
+    0x000, 0xc10, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x000, 0x080, 0x202, 0x000, 0x900, 0x000, 0x000, 0x020, 
+    0x030, 0x000, 0x000, 0x80c, 0x000, 0x640, 0x001, 0x000, 
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x001, 0x000, 
+    0x000, 0x080, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x404, 0x000, 0x000, 0x040, 0x000, 0x01a, 0x001, 0x000, 
+    0x000, 0x100, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x000, 0x080, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001, 
+    0x001, 0x000, 0x001, 0x001, 0x001, 0x001, 0x001, 0x001};
@@ -30,6 +30,9 @@
 
 #include "liquid.internal.h"
 
+// number of message bytes per block of packed/unpacked symbols
+#define HAMMING74_BLOCK_LEN (32)
+
 // encoder look-up table
 unsigned char hamming74_enc_gentab[16] = {
     0x00, 0x69, 0x2a, 0x43, 0x4c, 0x25, 0x66, 0x0f,
@@ -57,7 +60,7 @@ unsigned char hamming74_dec_gentab[128] = {
 // create Hamming(7,4) codec object
 fec fec_hamming74_create(void * _opts)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     // set scheme
     q->scheme = LIQUID_FEC_HAMMING74;
@@ -74,7 +77,7 @@ fec fec_hamming74_create(void * _opts)
 // destroy Hamming(7,4) object
 void fec_hamming74_destroy(fec _q)
 {
-    free(_q);
+    liquid_free(_q);
 }
 
 // encode block of data using Hamming(7,4) encoder
@@ -88,31 +91,27 @@ void fec_hamming74_encode(fec _q,
                           unsigned char *_msg_dec,
                           unsigned char *_msg_enc)
 {
-    unsigned int i;         // input byte counter
+    unsigned int i, j;      // input byte counters
     unsigned int k=0;       // array bit index
 
     // compute encoded message length
     unsigned int enc_msg_len = fec_block_get_enc_msg_len(_dec_msg_len,4,7);
 
-    unsigned char s0, s1;   // decoded symbols
-    unsigned char m0, m1;   // encoded symbols
+    // encoded symbols, packed a block at a time
+    unsigned int m[2*HAMMING74_BLOCK_LEN];
 
-    for (i=0; i<_dec_msg_len; i++) {
-        // strip two 4-bit symbols from input byte
-        s0 = (_msg_dec[i] >> 4) & 0x0f;
-        s1 = (_msg_dec[i] >> 0) & 0x0f;
+    for (i=0; i<_dec_msg_len; i+=HAMMING74_BLOCK_LEN) {
+        unsigned int n = _dec_msg_len - i < HAMMING74_BLOCK_LEN ? _dec_msg_len - i : HAMMING74_BLOCK_LEN;
 
-        // encode two 7-bit symbols
-        m0 = hamming74_enc_gentab[s0];
-        m1 = hamming74_enc_gentab[s1];
+        // encode two 7-bit symbols from the 4-bit halves of each byte
+        for (j=0; j<n; j++) {
+            m[2*j+0] = hamming74_enc_gentab[(_msg_dec[i+j] >> 4) & 0x0f];
+            m[2*j+1] = hamming74_enc_gentab[(_msg_dec[i+j] >> 0) & 0x0f];
+        }
 
         // pack encoded symbols into output array
-        liquid_pack_array(_msg_enc, enc_msg_len, k, 7, m0);
-        k += 7;
-        liquid_pack_array(_msg_enc, enc_msg_len, k, 7, m1);
-        k += 7;
-
-        //printf("  %3u : 0x%.2x > 0x%.2x,  0x%.2x > 0x%.2x (k=%u)\n", i, s0, m0, s1, m1, k);
+        liquid_pack_array_block(_msg_enc, enc_msg_len, k, 7, m, 2*n);
+        k += 14*n;
     }
 }
 
@@ -129,31 +128,25 @@ void fec_hamming74_decode(fec _q,
                           unsigned char *_msg_enc,
                           unsigned char *_msg_dec)
 {
-    unsigned int i;
+    unsigned int i, j;
     unsigned int k=0;       // array bit index
 
     // compute encoded message length
     unsigned int enc_msg_len = fec_block_get_enc_msg_len(_dec_msg_len,4,7);
 
-    unsigned char r0, r1;   // received 7-bit symbols
-    unsigned char s0, s1;   // decoded 4-bit symbols
+    // received 7-bit symbols, unpacked a block at a time
+    unsigned int r[2*HAMMING74_BLOCK_LEN];
 
-    //unsigned char num_errors=0;
-    for (i=0; i<_dec_msg_len; i++) {
-        // strip two 7-bit symbols from 
-        liquid_unpack_array(_msg_enc, enc_msg_len, k, 7, &r0);
-        k += 7;
-        liquid_unpack_array(_msg_enc, enc_msg_len, k, 7, &r1);
-        k += 7;
-
-        s0 = hamming74_dec_gentab[r0];
-        s1 = hamming74_dec_gentab[r1];
+    for (i=0; i<_dec_msg_len; i+=HAMMING74_BLOCK_LEN) {
+        unsigned int n = _dec_msg_len - i < HAMMING74_BLOCK_LEN ? _dec_msg_len - i : HAMMING74_BLOCK_LEN;
 
-        _msg_dec[i] = (s0 << 4) | s1;
+        // strip two 7-bit symbols per output byte
+        liquid_unpack_array_block(_msg_enc, enc_msg_len, k, 7, r, 2*n);
+        k += 14*n;
 
-        //printf("  %3u : 0x%.2x > 0x%.2x,  0x%.2x > 0x%.2x (k=%u)\n", i, r0, s0, r1, s1, k);
+        for (j=0; j<n; j++)
+            _msg_dec[i+j] = (hamming74_dec_gentab[r[2*j]] << 4) | hamming74_dec_gentab[r[2*j+1]];
     }
-    //return num_errors;
 }
 
 // decode block of data using Hamming(7,4) soft decoder
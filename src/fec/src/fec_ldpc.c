@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Low-density parity-check codes
+//
+// Quasi-cyclic codes of length n=648 (lifting factor Z=27) with the
+// base matrix dimensions and dual-diagonal parity structure of the
+// IEEE 802.11n codes. Messages are split into blocks of up to K/8 bytes
+// (the remaining information bits are zero and are not transmitted);
+// each encoded block holds the message bytes followed by the parity
+// bits, packed msb first and padded to a byte boundary.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+// maximum number of decoder iterations
+#define FEC_LDPC_MAX_ITERATIONS (20)
+
+// channel LLR magnitude for hard-decision input
+#define FEC_LDPC_LLR_HARD       (16)
+
+// lifting factor
+#define FEC_LDPC_Z              (27)
+
+// base matrices; -1 denotes an all-zero block, otherwise the entry is
+// the cyclic shift of the identity
+// rate 1/2 base matrix [12 x 24]
+const signed char fec_ldpc_r12_base[12*24] = {
+     0, -1, -1, -1,  0,  0, -1, -1,  0, -1, -1,  0,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    22,  0, -1, -1, 17, -1,  0,  0, 12, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     6, -1,  0, -1, 10, -1, -1, -1, 24, -1,  0, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1,
+     2, -1, -1,  0, 20, -1, -1, -1, 25,  0, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1,
+    23, -1, -1, -1,  3, -1, -1, -1,  0, -1,  9, 11, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1,
+    24, -1, 23,  1, 17, -1,  3, -1, 10, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1,
+    25, -1, -1, -1,  8, -1, -1, -1,  7, 18, -1, -1,  0, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1,
+    13, 24, -1, -1,  0, -1,  8, -1,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1,
+     7, 20, -1, 16, 22, 10, -1, -1, 23, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1,
+    11, -1, -1, -1, 19, -1, -1, -1, 13, -1,  3, 17, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1,
+    25, -1,  8, -1, 23, 18, -1, 14,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,
+     3, -1, -1, -1, 16, -1, -1,  2, 25,  5, -1, -1,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0};
+
+// rate 2/3 base matrix [8 x 24]
+const signed char fec_ldpc_r23_base[8*24] = {
+    25, 26, 14, -1, 20, -1,  2, -1,  4, -1, -1,  8, -1, 16, -1, 18,  1,  0, -1, -1, -1, -1, -1, -1,
+    10,  9, 15, 11, -1,  0, -1,  1, -1, -1, 18, -1,  8, -1, 10, -1, -1,  0,  0, -1, -1, -1, -1, -1,
+    16,  2, 20, 26, 21, -1,  6, -1,  1, 26, -1,  7, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1,
+    10, 13,  5,  0, -1,  3, -1,  7, -1, -1, 26, -1, -1, 13, -1, 16, -1, -1, -1,  0,  0, -1, -1, -1,
+    23, 14, 24, -1, 12, -1, 19, -1, 17, -1, -1, -1, 20, -1, 21, -1,  0, -1, -1, -1,  0,  0, -1, -1,
+     6, 22,  9, 20, -1, 25, -1, 17, -1,  8, -1, 14, -1, 18, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1,
+    14, 23, 21, 11, 20, -1, 24, -1, 18, -1, 19, -1, -1, -1, -1, 22, -1, -1, -1, -1, -1, -1,  0,  0,
+    17, 11, 11, 20, -1, 21, -1, 26, -1,  3, -1, -1, 18, -1, 26, -1,  1, -1, -1, -1, -1, -1, -1,  0};
+
+// rate 3/4 base matrix [6 x 24]
+const signed char fec_ldpc_r34_base[6*24] = {
+    16, 17, 22, 24,  9,  3, 14, -1,  4,  2,  7, -1, 26, -1,  2, -1, 21, -1,  1,  0, -1, -1, -1, -1,
+    25, 12, 12,  3,  3, 26,  6, 21, -1, 15, 22, -1, 15, -1,  4, -1, -1, 16, -1,  0,  0, -1, -1, -1,
+     5, 18, 26, 16, 22, 23,  9, -1,  0, -1,  4, -1,  4, -1,  8, 23, 11, -1, -1, -1,  0,  0, -1, -1,
+     9,  7,  0,  1, 17, -1, -1,  7,  2, -1,  3, 23, -1, 16, -1, -1, 21, -1,  0, -1, -1,  0,  0, -1,
+    24,  5, 26,  7,  1, -1, -1, 15, 24, 15, -1,  8, -1, 13, -1, 13, -1, 11, -1, -1, -1, -1,  0,  0,
+     2,  2, 19, 14, 24,  1, 15, 19, -1, 21, -1,  2, -1, 24, -1,  3, -1,  2,  1, -1, -1, -1, -1,  0};
+
+// get base matrix and number of block rows for scheme
+static const signed char * fec_ldpc_get_base(fec_scheme     _fs,
+                                             unsigned int * _mb)
+{
+    switch (_fs) {
+    case LIQUID_FEC_LDPC_R12: *_mb = 12; return fec_ldpc_r12_base;
+    case LIQUID_FEC_LDPC_R23: *_mb =  8; return fec_ldpc_r23_base;
+    case LIQUID_FEC_LDPC_R34: *_mb =  6; return fec_ldpc_r34_base;
+    default:
+        fprintf(stderr,"error: fec_ldpc_get_base(), invalid type\n");
+        exit(1);
+    }
+    return NULL;
+}
+
+// compute encoded message length for LDPC codes
+//  _fs             :   LDPC scheme
+//  _dec_msg_len    :   decoded message length (bytes)
+unsigned int fec_ldpc_get_enc_msg_len(fec_scheme   _fs,
+                                      unsigned int _dec_msg_len)
+{
+    unsigned int mb;
+    fec_ldpc_get_base(_fs, &mb);
+
+    // bytes per block and parity bytes per block
+    unsigned int kbytes = (24-mb)*FEC_LDPC_Z / 8;
+    unsigned int pbytes = (mb*FEC_LDPC_Z + 7) / 8;
+
+    unsigned int num_blocks = (_dec_msg_len + kbytes - 1) / kbytes;
+    return _dec_msg_len + num_blocks*pbytes;
+}
+
+// create LDPC codec object
+fec fec_ldpc_create(fec_scheme _fs)
+{
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
+
+    q->scheme = _fs;
+    q->rate = fec_get_rate(q->scheme);
+
+    q->encode_func      = &fec_ldpc_encode;
+    q->decode_func      = &fec_ldpc_decode;
+    q->decode_soft_func = &fec_ldpc_decode_soft;
+
+    unsigned int mb;
+    const signed char * base = fec_ldpc_get_base(_fs, &mb);
+    q->lp = ldpccodec_create(base, mb, 24, FEC_LDPC_Z);
+
+    // block lengths
+    unsigned int K = ldpccodec_get_k(q->lp);
+    unsigned int N = ldpccodec_get_n(q->lp);
+    q->dec_block_len = K / 8;
+    q->enc_block_len = q->dec_block_len + (N - K + 7)/8;
+
+    // buffers: packed information bits, parity bits, channel LLRs
+    q->tblock = (unsigned char*) liquid_malloc((K+7)/8 + (N-K+7)/8);
+    q->llr    = (int8_t*) liquid_malloc(N);
+
+    return q;
+}
+
+// destroy LDPC codec object
+void fec_ldpc_destroy(fec _q)
+{
+    ldpccodec_destroy(_q->lp);
+    liquid_free(_q->tblock);
+    liquid_free(_q->llr);
+    liquid_free(_q);
+}
+
+// split message into blocks of near-equal length, returning the number
+// of bytes in block _i
+static unsigned int fec_ldpc_block_len(fec          _q,
+                                       unsigned int _dec_msg_len,
+                                       unsigned int _i)
+{
+    unsigned int num_blocks = (_dec_msg_len + _q->dec_block_len - 1) / _q->dec_block_len;
+    unsigned int n = _dec_msg_len / num_blocks;
+    return n + (_i < _dec_msg_len % num_blocks ? 1 : 0);
+}
+
+// encode block of data using LDPC encoder
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_dec        :   decoded message [size: 1 x _dec_msg_len]
+//  _msg_enc        :   encoded message [size: 1 x enc_msg_len]
+void fec_ldpc_encode(fec             _q,
+                     unsigned int    _dec_msg_len,
+                     unsigned char * _msg_dec,
+                     unsigned char * _msg_enc)
+{
+    unsigned int kbytes  = (ldpccodec_get_k(_q->lp) + 7) / 8;
+    unsigned int pbytes  = _q->enc_block_len - _q->dec_block_len;
+    unsigned char * info   = _q->tblock;
+    unsigned char * parity = _q->tblock + kbytes;
+
+    unsigned int n0 = 0;    // input index
+    unsigned int n1 = 0;    // output index
+    unsigned int i;
+    for (i=0; n0<_dec_msg_len; i++) {
+        unsigned int n = fec_ldpc_block_len(_q, _dec_msg_len, i);
+
+        // shortened information bits are zero
+        memset(info, 0x00, kbytes);
+        memmove(info, &_msg_dec[n0], n);
+
+        // message bytes followed by parity
+        memset(parity, 0x00, pbytes);
+        ldpccodec_encode(_q->lp, info, parity);
+        memmove(&_msg_enc[n1],   info,   n);
+        memmove(&_msg_enc[n1+n], parity, pbytes);
+
+        n0 += n;
+        n1 += n + pbytes;
+    }
+
+    assert( n1 == fec_get_enc_msg_length(_q->scheme, _dec_msg_len) );
+}
+
+// decode blocks from hard bits or soft bits
+static void fec_ldpc_decode_blocks(fec             _q,
+                                   unsigned int    _dec_msg_len,
+                                   unsigned char * _msg_enc,
+                                   unsigned char * _msg_dec,
+                                   int             _soft)
+{
+    unsigned int K = ldpccodec_get_k(_q->lp);
+    unsigned int N = ldpccodec_get_n(_q->lp);
+    unsigned int pbytes = _q->enc_block_len - _q->dec_block_len;
+
+    unsigned int n0 = 0;    // output index
+    unsigned int n1 = 0;    // input index (bytes)
+    unsigned int i, j;
+    for (i=0; n0<_dec_msg_len; i++) {
+        unsigned int n = fec_ldpc_block_len(_q, _dec_msg_len, i);
+
+        // channel LLRs (positive for bit 0): message bits, shortened
+        // (known zero) bits, then parity bits
+        for (j=0; j<N; j++) {
+            unsigned int k;     // received bit index within block
+            if (j < 8*n)
+                k = j;
+            else if (j < K)
+                k = N;          // shortened
+            else
+                k = 8*n + (j - K);
+
+            if (k == N) {
+                _q->llr[j] = 127;
+            } else if (_soft) {
+                _q->llr[j] = (127 - (int)_msg_enc[8*n1 + k]) / 4;
+            } else {
+                unsigned int b = (_msg_enc[n1 + k/8] >> (7 - (k%8))) & 1;
+                _q->llr[j] = b ? -FEC_LDPC_LLR_HARD : FEC_LDPC_LLR_HARD;
+            }
+        }
+
+        ldpccodec_decode(_q->lp, _q->llr, FEC_LDPC_MAX_ITERATIONS, _q->tblock);
+        memmove(&_msg_dec[n0], _q->tblock, n);
+
+        n0 += n;
+        n1 += n + pbytes;
+    }
+}
+
+// decode block of data using LDPC decoder
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 1 x enc_msg_len]
+//  _msg_dec        :   decoded message [size: 1 x _dec_msg_len]
+void fec_ldpc_decode(fec             _q,
+                     unsigned int    _dec_msg_len,
+                     unsigned char * _msg_enc,
+                     unsigned char * _msg_dec)
+{
+    fec_ldpc_decode_blocks(_q, _dec_msg_len, _msg_enc, _msg_dec, 0);
+}
+
+// decode block of data using LDPC decoder (soft bits)
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 8 x enc_msg_len]
+//  _msg_dec        :   decoded message [size: 1 x _dec_msg_len]
+void fec_ldpc_decode_soft(fec             _q,
+                          unsigned int    _dec_msg_len,
+                          unsigned char * _msg_enc,
+                          unsigned char * _msg_dec)
+{
+    fec_ldpc_decode_blocks(_q, _dec_msg_len, _msg_enc, _msg_dec, 1);
+}
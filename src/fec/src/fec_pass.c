@@ -31,7 +31,7 @@
 
 fec fec_pass_create(void * _opts)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     q->scheme = LIQUID_FEC_NONE;
     q->rate = fec_get_rate(q->scheme);
@@ -45,7 +45,7 @@ fec fec_pass_create(void * _opts)
 
 void fec_pass_destroy(fec _q)
 {
-    free(_q);
+    liquid_free(_q);
 }
 
 void fec_pass_print(fec _q)
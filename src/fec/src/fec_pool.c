@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Shared fec object pool
+//
+// Idle fec objects are kept in a fixed number of slots per scheme.
+// Acquiring an object atomically exchanges a slot with NULL, and
+// releasing one atomically installs it in an empty slot, so neither
+// operation takes a lock and a slot is never handed to two callers
+// (no ABA hazard, unlike a linked free list). An object is created
+// when no idle one is available and destroyed on release when all
+// slots are occupied; the number of live objects therefore follows
+// the number of concurrent operations rather than the number of
+// users holding a scheme.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+// number of idle objects retained per scheme
+#define FEC_POOL_NUM_SLOTS (64)
+
+static fec fec_pool_slots[LIQUID_FEC_NUM_SCHEMES][FEC_POOL_NUM_SLOTS];
+
+// borrow fec object of a particular scheme from the shared pool, creating
+// one if none is idle; the caller has exclusive use until it is released
+//  _scheme     :   error-correction scheme
+fec fec_pool_acquire(fec_scheme _scheme)
+{
+    if (_scheme == LIQUID_FEC_UNKNOWN || _scheme >= LIQUID_FEC_NUM_SCHEMES) {
+        fprintf(stderr,"error: fec_pool_acquire(), unknown/unsupported scheme: %d\n", _scheme);
+        exit(1);
+    }
+
+    fec * slots = fec_pool_slots[_scheme];
+    unsigned int i;
+    for (i=0; i<FEC_POOL_NUM_SLOTS; i++) {
+        // cheap test before claiming the slot
+        if (__atomic_load_n(&slots[i], __ATOMIC_RELAXED) == NULL)
+            continue;
+
+        fec q = __atomic_exchange_n(&slots[i], NULL, __ATOMIC_ACQUIRE);
+        if (q != NULL)
+            return q;
+    }
+
+    return fec_create(_scheme, NULL);
+}
+
+// return fec object to the shared pool
+//  _q          :   fec object obtained from fec_pool_acquire()
+void fec_pool_release(fec _q)
+{
+    fec * slots = fec_pool_slots[_q->scheme];
+    unsigned int i;
+    for (i=0; i<FEC_POOL_NUM_SLOTS; i++) {
+        fec empty = NULL;
+        if (__atomic_load_n(&slots[i], __ATOMIC_RELAXED) == NULL &&
+            __atomic_compare_exchange_n(&slots[i], &empty, _q, 0,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+            return;
+        }
+    }
+
+    // pool is full
+    fec_destroy(_q);
+}
+
+// destroy all idle objects in the shared pool; objects currently
+// borrowed are unaffected and return to the pool when released
+void fec_pool_clear()
+{
+    unsigned int s, i;
+    for (s=0; s<LIQUID_FEC_NUM_SCHEMES; s++) {
+        for (i=0; i<FEC_POOL_NUM_SLOTS; i++) {
+            fec q = __atomic_exchange_n(&fec_pool_slots[s][i], NULL, __ATOMIC_ACQUIRE);
+            if (q != NULL)
+                fec_destroy(q);
+        }
+    }
+}
+
+// get number of idle objects of a particular scheme in the shared pool
+//  _scheme     :   error-correction scheme
+unsigned int fec_pool_get_num_idle(fec_scheme _scheme)
+{
+    if (_scheme >= LIQUID_FEC_NUM_SCHEMES)
+        return 0;
+
+    unsigned int i, n = 0;
+    for (i=0; i<FEC_POOL_NUM_SLOTS; i++)
+        n += __atomic_load_n(&fec_pool_slots[_scheme][i], __ATOMIC_RELAXED) != NULL;
+    return n;
+}
@@ -32,7 +32,7 @@
 // create rep3 codec object
 fec fec_rep3_create(void * _opts)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     q->scheme = LIQUID_FEC_REP3;
     q->rate = fec_get_rate(q->scheme);
@@ -47,7 +47,7 @@ fec fec_rep3_create(void * _opts)
 // destroy rep3 object
 void fec_rep3_destroy(fec _q)
 {
-    free(_q);
+    liquid_free(_q);
 }
 
 // print rep3 object
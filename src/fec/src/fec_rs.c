@@ -33,12 +33,9 @@
 
 #define VERBOSE_FEC_RS    0
 
-#if LIBFEC_ENABLED
-#include "fec.h"
-
 fec fec_rs_create(fec_scheme _fs)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     q->scheme = _fs;
     q->rate = fec_get_rate(q->scheme);
@@ -63,9 +60,7 @@ fec fec_rs_create(fec_scheme _fs)
     q->rs = NULL;
 
     // allocate memory for arrays
-    q->tblock   = (unsigned char*) malloc(q->nn*sizeof(unsigned char));
-    q->errlocs  = (int *) malloc(q->nn*sizeof(int));
-    q->derrlocs = (int *) malloc(q->nn*sizeof(int));
+    q->tblock   = (unsigned char*) liquid_malloc(q->nn*sizeof(unsigned char));
 
     return q;
 }
@@ -73,15 +68,14 @@ fec fec_rs_create(fec_scheme _fs)
 void fec_rs_destroy(fec _q)
 {
     // delete internal Reed-Solomon decoder object
-    free_rs_char(_q->rs);
+    if (_q->rs != NULL)
+        rscodec_destroy(_q->rs);
 
     // delete internal memory arrays
-    free(_q->tblock);
-    free(_q->errlocs);
-    free(_q->derrlocs);
+    liquid_free(_q->tblock);
 
     // delete fec object
-    free(_q);
+    liquid_free(_q);
 }
 
 void fec_rs_encode(fec _q,
@@ -115,7 +109,7 @@ void fec_rs_encode(fec _q,
         // necessary as these bits are going to be thrown away anyway
 
         // encode data, appending parity bits to end of sequence
-        encode_rs_char(_q->rs, _q->tblock, &_q->tblock[_q->dec_block_len]);
+        rscodec_encode(_q->rs, _q->tblock, &_q->tblock[_q->dec_block_len]);
 
         // copy result to output
         memmove(&_msg_enc[n1], _q->tblock, _q->enc_block_len*sizeof(unsigned char));
@@ -145,11 +139,6 @@ void fec_rs_decode(fec _q,
     // re-allocate resources if necessary
     fec_rs_setlength(_q, _dec_msg_len);
 
-    // set erasures, error locations to zero
-    memset(_q->errlocs,  0x00, _q->nn*sizeof(unsigned char));
-    memset(_q->derrlocs, 0x00, _q->nn*sizeof(unsigned char));
-    _q->erasures = 0;
-
     unsigned int i;
     unsigned int n0=0;
     unsigned int n1=0;
@@ -164,12 +153,9 @@ void fec_rs_decode(fec _q,
         // copy sequence
         memmove(_q->tblock, &_msg_enc[n0], _q->enc_block_len*sizeof(unsigned char));
 
-        // decode block
+        // decode block (uncorrectable blocks are passed through)
         //derrors = 
-        decode_rs_char(_q->rs,
-                       _q->tblock,
-                       _q->derrlocs,
-                       _q->erasures);
+        rscodec_decode(_q->rs, _q->tblock);
 
         // copy result
         memmove(&_msg_dec[n1], _q->tblock, block_size*sizeof(unsigned char));
@@ -212,8 +198,8 @@ void fec_rs_decode(fec _q,
 // Thus, the 1024-byte input message is broken into 5 blocks, the first
 // four have a length 205, and the last block has a length 204 (which is
 // externally padded to 205, e.g. res_block_len = 1). This code adds 32
-// parity symbols, so each block is extended to 237 bytes. libfec auto-
-// matically extends the internal data to 255 bytes by padding with 18
+// parity symbols, so each block is extended to 237 bytes. The codec
+// implicitly extends the internal data to 255 bytes by padding with 18
 // symbols.  Therefore, the final output length is 237 * 5 = 1185 symbols.
 void fec_rs_setlength(fec _q,
                       unsigned int _dec_msg_len)
@@ -242,7 +228,7 @@ void fec_rs_setlength(fec _q,
     // mod(num_blocks*dec_block_len, num_dec_bytes)
     _q->res_block_len = (_q->num_blocks*_q->dec_block_len) % _q->num_dec_bytes;
 
-    // compute the internal libfec padding factor: kk - dec_block_len
+    // compute the internal codec padding factor: kk - dec_block_len
     _q->pad = _q->kk - _q->dec_block_len;
 
     // compute the final encoded block length: enc_block_len * num_blocks
@@ -260,15 +246,14 @@ void fec_rs_setlength(fec _q,
 
     // delete old decoder if necessary
     if (_q->rs != NULL)
-        free_rs_char(_q->rs);
+        rscodec_destroy(_q->rs);
 
     // Reed-Solomon specific decoding
-    _q->rs = init_rs_char(_q->symsize,
-                          _q->genpoly,
-                          _q->fcs,
-                          _q->prim,
-                          _q->nroots,
-                          _q->pad);
+    _q->rs = rscodec_create(_q->genpoly,
+                            _q->fcs,
+                            _q->prim,
+                            _q->nroots,
+                            _q->pad);
 }
 
 // 
@@ -284,31 +269,3 @@ void fec_rs_init_p8(fec _q)
     _q->nroots = 32;
 }
 
-#else   // LIBFEC_ENABLED
-
-fec fec_rs_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_rs_destroy(fec _q)
-{
-}
-
-void fec_rs_encode(fec _q,
-                   unsigned int _dec_msg_len,
-                   unsigned char *_msg_dec,
-                   unsigned char *_msg_enc)
-{
-}
-
-//unsigned int
-void fec_rs_decode(fec _q,
-                   unsigned int _dec_msg_len,
-                   unsigned char *_msg_enc,
-                   unsigned char *_msg_dec)
-{
-}
-
-#endif  // LIBFEC_ENABLED
-
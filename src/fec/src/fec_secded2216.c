@@ -64,41 +64,16 @@ unsigned char secded2216_syndrome_w1[22] = {
 // compute parity on 16-bit input
 unsigned char fec_secded2216_compute_parity(unsigned char * _m)
 {
-    // compute encoded/transmitted message: v = m*G
-    unsigned char parity = 0x00;
-
-    // TODO : unwrap this loop
-    unsigned int i;
-    for (i=0; i<6; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded2216_P[2*i+0] & _m[0] ] +
-                         liquid_c_ones[ secded2216_P[2*i+1] & _m[1] ];
-
-        parity |= p & 0x01;
-    }
-
-    return parity;
+    // sum parity contributions of each message byte
+    return secded2216_parity_gentab[0][_m[0]] ^
+           secded2216_parity_gentab[1][_m[1]];
 }
 
 // compute syndrome on 22-bit input
 unsigned char fec_secded2216_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<6; i++) {
-        syndrome <<= 1;
-
-        unsigned int p =
-            ( (_v[0] & (1<<(6-i-1))) ? 1 : 0 )+
-            liquid_c_ones[ secded2216_P[2*i+0] & _v[1] ] +
-            liquid_c_ones[ secded2216_P[2*i+1] & _v[2] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // received parity bits plus parity computed on received message
+    return (_v[0] & 0x3f) ^ fec_secded2216_compute_parity(_v+1);
 }
 
 // encode symbol
@@ -166,38 +141,27 @@ int fec_secded2216_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded2216_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
+    if (s == 0) {
         // no errors detected
         return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<22; n++) {
-            if (s == secded2216_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[3-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
+    }
 
+    // look up location of error with weight one matching syndrome
+    unsigned int n = secded2216_errloc_gentab[s];
+    if (n == 0xff) {
+        // no syndrome match; multiple errors detected
+        return 2;
     }
 
-    // no syndrome match; multiple errors detected
-    return 2;
+    // single error detected at location 'n'
+    _e_hat[3-(n>>3)-1] = 1 << (n & 7);
+    return 1;
 }
 
 // create SEC-DED (22,16) codec object
 fec fec_secded2216_create(void * _opts)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     // set scheme
     q->scheme = LIQUID_FEC_SECDED2216;
@@ -214,7 +178,7 @@ fec fec_secded2216_create(void * _opts)
 // destroy SEC-DEC (22,16) object
 void fec_secded2216_destroy(fec _q)
 {
-    free(_q);
+    liquid_free(_q);
 }
 
 // encode block of data using SEC-DEC (22,16) encoder
@@ -72,53 +72,22 @@ unsigned char secded7264_syndrome_w1[72] = {
 // compute parity byte on 64-byte input
 unsigned char fec_secded7264_compute_parity(unsigned char * _v)
 {
-    // compute parity byte on message
-    unsigned int i;
-    unsigned char parity = 0x00;
-    for (i=0; i<8; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded7264_P[8*i+0] & _v[0] ] +
-                         liquid_c_ones[ secded7264_P[8*i+1] & _v[1] ] +
-                         liquid_c_ones[ secded7264_P[8*i+2] & _v[2] ] +
-                         liquid_c_ones[ secded7264_P[8*i+3] & _v[3] ] +
-                         liquid_c_ones[ secded7264_P[8*i+4] & _v[4] ] +
-                         liquid_c_ones[ secded7264_P[8*i+5] & _v[5] ] +
-                         liquid_c_ones[ secded7264_P[8*i+6] & _v[6] ] +
-                         liquid_c_ones[ secded7264_P[8*i+7] & _v[7] ];
-
-        parity |= p & 0x01;
-    }
-
-    // return parity byte
-    return parity;
+    // sum parity contributions of each message byte
+    return secded7264_parity_gentab[0][_v[0]] ^
+           secded7264_parity_gentab[1][_v[1]] ^
+           secded7264_parity_gentab[2][_v[2]] ^
+           secded7264_parity_gentab[3][_v[3]] ^
+           secded7264_parity_gentab[4][_v[4]] ^
+           secded7264_parity_gentab[5][_v[5]] ^
+           secded7264_parity_gentab[6][_v[6]] ^
+           secded7264_parity_gentab[7][_v[7]];
 }
 
 // compute syndrome on 72-bit input
 unsigned char fec_secded7264_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<8; i++) {
-        syndrome <<= 1;
-
-        // compute parity bit
-        unsigned int p =
-            ( (_v[0] & (1<<(8-i-1))) ? 1 : 0 ) +
-            liquid_c_ones[ secded7264_P[8*i+0] & _v[1] ] +
-            liquid_c_ones[ secded7264_P[8*i+1] & _v[2] ] +
-            liquid_c_ones[ secded7264_P[8*i+2] & _v[3] ] +
-            liquid_c_ones[ secded7264_P[8*i+3] & _v[4] ] +
-            liquid_c_ones[ secded7264_P[8*i+4] & _v[5] ] +
-            liquid_c_ones[ secded7264_P[8*i+5] & _v[6] ] +
-            liquid_c_ones[ secded7264_P[8*i+6] & _v[7] ] +
-            liquid_c_ones[ secded7264_P[8*i+7] & _v[8] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // received parity bits plus parity computed on received message
+    return _v[0] ^ fec_secded7264_compute_parity(_v+1);
 }
 
 void fec_secded7264_encode_symbol(unsigned char * _sym_dec,
@@ -185,38 +154,27 @@ int fec_secded7264_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded7264_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
+    if (s == 0) {
         // no errors detected
         return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<72; n++) {
-            if (s == secded7264_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[9-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
+    }
 
+    // look up location of error with weight one matching syndrome
+    unsigned int n = secded7264_errloc_gentab[s];
+    if (n == 0xff) {
+        // no syndrome match; multiple errors detected
+        return 2;
     }
 
-    // no syndrome match; multiple errors detected
-    return 2;
+    // single error detected at location 'n'
+    _e_hat[9-(n>>3)-1] = 1 << (n & 7);
+    return 1;
 }
 
 // create SEC-DED (72,64) codec object
 fec fec_secded7264_create(void * _opts)
 {
-    fec q = (fec) malloc(sizeof(struct fec_s));
+    fec q = (fec) liquid_malloc(sizeof(struct fec_s));
 
     // set scheme
     q->scheme = LIQUID_FEC_SECDED7264;
@@ -233,7 +191,7 @@ fec fec_secded7264_create(void * _opts)
 // destroy SEC-DEC (72,64) object
 void fec_secded7264_destroy(fec _q)
 {
-    free(_q);
+    liquid_free(_q);
 }
 
 // encode block of data using SEC-DEC (72,64) encoder
@@ -29,40 +29,50 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <math.h>
 
 #include "liquid.internal.h"
 
+// number of permutation stages (maximum interleaving depth)
+#define INTERLEAVER_NUM_STAGES (4)
+
 // 
 // internal methods
 //
 
-// permute one iteration
+// compute swap indices for one permutation stage
+void interleaver_plan(unsigned int   _n,
+                      unsigned int   _M,
+                      unsigned int   _N,
+                      unsigned int * _p);
+
+// permute one stage
 void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N);
+                         unsigned int    _n2,
+                         unsigned int  * _p);
 
-// permute one iteration (soft bit input)
+// permute one stage (soft bit input)
 void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N);
+                              unsigned int    _n2,
+                              unsigned int  * _p);
 
-// permute one iteration with mask
+// permute one stage with mask
 void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
+                              unsigned int    _n2,
+                              unsigned int  * _p,
                               unsigned char   _mask);
 
-// permute one iteration (soft bit input) with mask
+// permute one stage (soft bit input) with mask
 void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
+                                   unsigned int    _n2,
+                                   unsigned int  * _p,
                                    unsigned char   _mask);
 
+// column offset and bit mask for each permutation stage; the first
+// stage swaps entire bytes
+static const unsigned int  interleaver_stage_offset[INTERLEAVER_NUM_STAGES] = {0, 2, 4, 8};
+static const unsigned char interleaver_stage_mask[INTERLEAVER_NUM_STAGES]   = {0xff, 0x0f, 0x55, 0x33};
 
 // structured interleaver object
 struct interleaver_s {
@@ -73,12 +83,16 @@ struct interleaver_s {
 
     // interleaving depth (number of permutations)
     unsigned int depth;
+
+    // swap indices for each permutation stage, computed once on
+    // creation [size: INTERLEAVER_NUM_STAGES x n/2]
+    unsigned int * plan;
 };
 
 // create interleaver of length _n input/output bytes
 interleaver interleaver_create(unsigned int _n)
 {
-    interleaver q = (interleaver) malloc(sizeof(struct interleaver_s));
+    interleaver q = (interleaver) liquid_malloc(sizeof(struct interleaver_s));
     q->n = _n;
 
     // set internal properties
@@ -90,14 +104,25 @@ interleaver interleaver_create(unsigned int _n)
     q->N = q->n / q->M;
     while (q->n >= (q->M*q->N)) q->N++;  // ensures M*N >= n
 
+    // compute swap indices for each stage
+    unsigned int k;
+    unsigned int n2 = q->n / 2;
+    // NOTE: extra element per stage keeps allocation non-empty for n < 2
+    q->plan = (unsigned int*) liquid_malloc(INTERLEAVER_NUM_STAGES*(n2+1)*sizeof(unsigned int));
+    for (k=0; k<INTERLEAVER_NUM_STAGES; k++)
+        interleaver_plan(q->n, q->M, q->N + interleaver_stage_offset[k], &q->plan[k*n2]);
+
     return q;
 }
 
 // destroy interleaver object
 void interleaver_destroy(interleaver _q)
 {
+    // free permutation plan
+    liquid_free(_q->plan);
+
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print interleaver internals
@@ -109,6 +134,13 @@ void interleaver_print(interleaver _q)
     printf("    depth   :   %u\n", _q->depth);
 }
 
+// get memory footprint of object and its permutation plan [bytes]
+unsigned long int interleaver_get_memory_usage(interleaver _q)
+{
+    return sizeof(struct interleaver_s) +
+           INTERLEAVER_NUM_STAGES*(_q->n/2+1)*sizeof(unsigned int);
+}
+
 // set depth (number of internal iterations)
 void interleaver_set_depth(interleaver  _q,
                            unsigned int _depth)
@@ -127,10 +159,11 @@ void interleaver_encode(interleaver _q,
     // copy data to output
     memmove(_msg_enc, _msg_dec, _q->n);
 
-    if (_q->depth > 0) interleaver_permute(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    unsigned int n2 = _q->n / 2;
+    if (_q->depth > 0) interleaver_permute(_msg_enc, n2, &_q->plan[0]);
+    if (_q->depth > 1) interleaver_permute_mask(_msg_enc, n2, &_q->plan[1*n2], interleaver_stage_mask[1]);
+    if (_q->depth > 2) interleaver_permute_mask(_msg_enc, n2, &_q->plan[2*n2], interleaver_stage_mask[2]);
+    if (_q->depth > 3) interleaver_permute_mask(_msg_enc, n2, &_q->plan[3*n2], interleaver_stage_mask[3]);
 }
 
 // execute forward interleaver (encoder) on soft bits
@@ -144,10 +177,11 @@ void interleaver_encode_soft(interleaver _q,
     // copy data to output
     memmove(_msg_enc, _msg_dec, 8*_q->n);
 
-    if (_q->depth > 0) interleaver_permute_soft(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    unsigned int n2 = _q->n / 2;
+    if (_q->depth > 0) interleaver_permute_soft(_msg_enc, n2, &_q->plan[0]);
+    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_enc, n2, &_q->plan[1*n2], interleaver_stage_mask[1]);
+    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_enc, n2, &_q->plan[2*n2], interleaver_stage_mask[2]);
+    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_enc, n2, &_q->plan[3*n2], interleaver_stage_mask[3]);
 }
 
 // execute reverse interleaver (decoder)
@@ -161,10 +195,11 @@ void interleaver_decode(interleaver _q,
     // copy data to output
     memmove(_msg_dec, _msg_enc, _q->n);
 
-    if (_q->depth > 3) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute(_msg_dec, _q->n, _q->M, _q->N);
+    unsigned int n2 = _q->n / 2;
+    if (_q->depth > 3) interleaver_permute_mask(_msg_dec, n2, &_q->plan[3*n2], interleaver_stage_mask[3]);
+    if (_q->depth > 2) interleaver_permute_mask(_msg_dec, n2, &_q->plan[2*n2], interleaver_stage_mask[2]);
+    if (_q->depth > 1) interleaver_permute_mask(_msg_dec, n2, &_q->plan[1*n2], interleaver_stage_mask[1]);
+    if (_q->depth > 0) interleaver_permute(_msg_dec, n2, &_q->plan[0]);
 }
 
 // execute reverse interleaver (decoder) on soft bits
@@ -178,30 +213,31 @@ void interleaver_decode_soft(interleaver _q,
     // copy data to output
     memmove(_msg_dec, _msg_enc, 8*_q->n);
 
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute_soft(_msg_dec, _q->n, _q->M, _q->N);
+    unsigned int n2 = _q->n / 2;
+    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_dec, n2, &_q->plan[3*n2], interleaver_stage_mask[3]);
+    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_dec, n2, &_q->plan[2*n2], interleaver_stage_mask[2]);
+    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_dec, n2, &_q->plan[1*n2], interleaver_stage_mask[1]);
+    if (_q->depth > 0) interleaver_permute_soft(_msg_dec, n2, &_q->plan[0]);
 }
 
 // 
 // internal permutation methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N)
+// compute swap indices for one permutation stage: byte 2*i is swapped
+// with byte 2*p[i]+1, where p is a permutation of [0,n/2) found by
+// scanning an _M x _N block column-wise, starting at column n/3
+void interleaver_plan(unsigned int   _n,
+                      unsigned int   _M,
+                      unsigned int   _N,
+                      unsigned int * _p)
 {
     unsigned int i;
     unsigned int j;
     unsigned int m=0;
     unsigned int n=_n/3;
     unsigned int n2=_n/2;
-    unsigned char tmp;
     for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
         do {
             j = m*_N + n; // output
             m++;
@@ -211,112 +247,81 @@ void interleaver_permute(unsigned char * _x,
             }
         } while (j>=n2);
 
+        _p[i] = j;
+    }
+}
+
+// permute one stage
+void interleaver_permute(unsigned char * _x,
+                         unsigned int    _n2,
+                         unsigned int  * _p)
+{
+    unsigned int i;
+    unsigned char tmp;
+    for (i=0; i<_n2; i++) {
         // swap indices
-        tmp = _x[2*j+1];
-        _x[2*j+1] = _x[2*i+0];
+        tmp = _x[2*_p[i]+1];
+        _x[2*_p[i]+1] = _x[2*i+0];
         _x[2*i+0] = tmp;
     }
 }
 
-// permute one iteration (soft bit input)
+// permute one stage (soft bit input)
 void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N)
+                              unsigned int    _n2,
+                              unsigned int  * _p)
 {
     unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp[8];
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-    
+    uint64_t a, b;
+    for (i=0; i<_n2; i++) {
         // swap soft bits at indices
-        memmove( tmp,            &_x[8*(2*j+1)], 8);
-        memmove( &_x[8*(2*j+1)], &_x[8*(2*i+0)], 8);
-        memmove( &_x[8*(2*i+0)], tmp,            8);
+        memcpy(&a, &_x[8*(2*i+0)],     8);
+        memcpy(&b, &_x[8*(2*_p[i]+1)], 8);
+        memcpy(&_x[8*(2*i+0)],     &b, 8);
+        memcpy(&_x[8*(2*_p[i]+1)], &a, 8);
     }
-    //printf("\n");
 }
 
-
-// permute one iteration with mask
+// permute one stage with mask
 void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
+                              unsigned int    _n2,
+                              unsigned int  * _p,
                               unsigned char   _mask)
 {
     unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp0;
-    unsigned char tmp1;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-
-        // swap indices, applying mask
-        tmp0 = (_x[2*i+0] & (~_mask)) | (_x[2*j+1] & ( _mask));
-        tmp1 = (_x[2*i+0] & ( _mask)) | (_x[2*j+1] & (~_mask));
-        _x[2*i+0] = tmp0;
-        _x[2*j+1] = tmp1;
+    unsigned char t;
+    for (i=0; i<_n2; i++) {
+        // swap bits matching the mask
+        t = (_x[2*i+0] ^ _x[2*_p[i]+1]) & _mask;
+        _x[2*i+0]     ^= t;
+        _x[2*_p[i]+1] ^= t;
     }
 }
 
-// permute one iteration (soft bit input)
+// permute one stage (soft bit input) with mask
 void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
+                                   unsigned int    _n2,
+                                   unsigned int  * _p,
                                    unsigned char   _mask)
 {
-    unsigned int i;
-    unsigned int j;
+    // expand bit mask to one byte per soft bit, msb first
     unsigned int k;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
+    unsigned char mask_bytes[8];
+    for (k=0; k<8; k++)
+        mask_bytes[k] = ((_mask >> (8-k-1)) & 0x01) ? 0xff : 0x00;
+    uint64_t mask;
+    memcpy(&mask, mask_bytes, 8);
 
-        // swap bits matching the mask
-        for (k=0; k<8; k++) {
-            if ( (_mask >> (8-k-1)) & 0x01 ) {
-                tmp = _x[8*(2*j+1)+k];
-                _x[8*(2*j+1)+k] = _x[8*(2*i+0)+k];
-                _x[8*(2*i+0)+k] = tmp;
-            }
-        }
+    unsigned int i;
+    uint64_t a, b, t;
+    for (i=0; i<_n2; i++) {
+        // swap soft bits matching the mask, eight at a time
+        memcpy(&a, &_x[8*(2*i+0)],     8);
+        memcpy(&b, &_x[8*(2*_p[i]+1)], 8);
+        t = (a ^ b) & mask;
+        a ^= t;
+        b ^= t;
+        memcpy(&_x[8*(2*i+0)],     &a, 8);
+        memcpy(&_x[8*(2*_p[i]+1)], &b, 8);
     }
-    //printf("\n");
 }
-
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ldpccodec.avx.c : LDPC layered min-sum check-node kernels (x86 SSSE3
+//                   and AVX2)
+//
+// The 32 lanes of each edge hold the Z <= 32 check nodes of one block
+// row, so a layer is updated with one (AVX2) or two (SSSE3) vectors per
+// edge using saturating 8-bit arithmetic; results are bit exact with
+// liquid_ldpc_layer() in ldpccodec.c. These kernels are compiled with
+// per-function target attributes and are selected at run time.
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// cached run-time check for SSSE3 (see liquid.internal.h)
+int liquid_ldpc_have_ssse3(void)
+{
+    static int have_ssse3 = -1;
+    if (have_ssse3 < 0) {
+        __builtin_cpu_init();
+        have_ssse3 = __builtin_cpu_supports("ssse3");
+    }
+    return have_ssse3;
+}
+
+// sixteen lanes
+__attribute__((target("ssse3")))
+static void liquid_ldpc_layer_ssse3_half(int8_t *     _Q,
+                                         int8_t *     _R,
+                                         unsigned int _d)
+{
+    __m128i lim  = _mm_set1_epi8(-128);
+    __m128i one  = _mm_set1_epi8(1);
+    __m128i mask = _mm_set1_epi8(0x3f);
+    __m128i min1 = _mm_set1_epi8(127);
+    __m128i min2 = _mm_set1_epi8(127);
+    __m128i sgn  = _mm_setzero_si128();
+    unsigned int e;
+    for (e=0; e<_d; e++) {
+        __m128i q = _mm_subs_epi8(_mm_load_si128((__m128i*)(_Q+32*e)),
+                                  _mm_load_si128((__m128i*)(_R+32*e)));
+        q = _mm_sub_epi8(q, _mm_cmpeq_epi8(q, lim));    // -128 > -127
+        __m128i a = _mm_abs_epi8(q);
+        _mm_store_si128((__m128i*)(_Q+32*e), q);
+        min2 = _mm_min_epu8(_mm_max_epu8(min1, a), min2);
+        min1 = _mm_min_epu8(min1, a);
+        sgn  = _mm_xor_si128(sgn, q);
+    }
+
+    // normalized magnitudes: m - (m >> 2)
+    __m128i m1 = _mm_sub_epi8(min1, _mm_and_si128(_mm_srli_epi16(min1, 2), mask));
+    __m128i m2 = _mm_sub_epi8(min2, _mm_and_si128(_mm_srli_epi16(min2, 2), mask));
+    for (e=0; e<_d; e++) {
+        __m128i q   = _mm_load_si128((__m128i*)(_Q+32*e));
+        __m128i sel = _mm_cmpeq_epi8(_mm_abs_epi8(q), min1);
+        __m128i mag = _mm_or_si128(_mm_and_si128(sel, m2), _mm_andnot_si128(sel, m1));
+        __m128i r   = _mm_sign_epi8(mag, _mm_or_si128(_mm_xor_si128(sgn, q), one));
+        _mm_store_si128((__m128i*)(_R+32*e), r);
+        q = _mm_adds_epi8(q, r);
+        _mm_store_si128((__m128i*)(_Q+32*e), _mm_sub_epi8(q, _mm_cmpeq_epi8(q, lim)));
+    }
+}
+
+// thirty-two lanes as two halves
+__attribute__((target("ssse3")))
+void liquid_ldpc_layer_ssse3(int8_t *     _Q,
+                             int8_t *     _R,
+                             unsigned int _d)
+{
+    liquid_ldpc_layer_ssse3_half(_Q,    _R,    _d);
+    liquid_ldpc_layer_ssse3_half(_Q+16, _R+16, _d);
+}
+
+// thirty-two lanes
+__attribute__((target("avx2")))
+void liquid_ldpc_layer_avx2(int8_t *     _Q,
+                            int8_t *     _R,
+                            unsigned int _d)
+{
+    __m256i lim  = _mm256_set1_epi8(-127);
+    __m256i one  = _mm256_set1_epi8(1);
+    __m256i mask = _mm256_set1_epi8(0x3f);
+    __m256i min1 = _mm256_set1_epi8(127);
+    __m256i min2 = _mm256_set1_epi8(127);
+    __m256i sgn  = _mm256_setzero_si256();
+    unsigned int e;
+    for (e=0; e<_d; e++) {
+        __m256i q = _mm256_subs_epi8(_mm256_load_si256((__m256i*)(_Q+32*e)),
+                                     _mm256_load_si256((__m256i*)(_R+32*e)));
+        q = _mm256_max_epi8(q, lim);
+        __m256i a = _mm256_abs_epi8(q);
+        _mm256_store_si256((__m256i*)(_Q+32*e), q);
+        min2 = _mm256_min_epu8(_mm256_max_epu8(min1, a), min2);
+        min1 = _mm256_min_epu8(min1, a);
+        sgn  = _mm256_xor_si256(sgn, q);
+    }
+
+    // normalized magnitudes: m - (m >> 2)
+    __m256i m1 = _mm256_sub_epi8(min1, _mm256_and_si256(_mm256_srli_epi16(min1, 2), mask));
+    __m256i m2 = _mm256_sub_epi8(min2, _mm256_and_si256(_mm256_srli_epi16(min2, 2), mask));
+    for (e=0; e<_d; e++) {
+        __m256i q   = _mm256_load_si256((__m256i*)(_Q+32*e));
+        __m256i sel = _mm256_cmpeq_epi8(_mm256_abs_epi8(q), min1);
+        __m256i mag = _mm256_blendv_epi8(m1, m2, sel);
+        __m256i r   = _mm256_sign_epi8(mag, _mm256_or_si256(_mm256_xor_si256(sgn, q), one));
+        _mm256_store_si256((__m256i*)(_R+32*e), r);
+        _mm256_store_si256((__m256i*)(_Q+32*e), _mm256_max_epi8(_mm256_adds_epi8(q, r), lim));
+    }
+}
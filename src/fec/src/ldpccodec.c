@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ldpccodec.c : quasi-cyclic low-density parity-check codec
+//
+// Codes are defined by a base matrix of Z x Z cyclic-permutation blocks
+// with the dual-diagonal parity structure of IEEE 802.11n: the first
+// parity column has shifts {a, 0, a} in its top, middle and bottom rows
+// and the remaining parity columns form a staircase of identities, so
+// encoding is a linear-time back substitution. Decoding is layered,
+// normalized (3/4) min-sum on saturated 8-bit fixed-point LLRs; the Z
+// check nodes of each block row are updated in parallel (SIMD kernels
+// where available) and decoding stops as soon as all parity checks are
+// satisfied.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_DOTPROD_NEON && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+struct ldpccodec_s {
+    unsigned int mb;            // base matrix rows (block rows)
+    unsigned int nb;            // base matrix columns (block columns)
+    unsigned int kb;            // information block columns, nb - mb
+    unsigned int Z;             // lifting factor (block size)
+    unsigned int K;             // information bits, kb*Z
+    unsigned int M;             // parity bits, mb*Z
+    unsigned int N;             // codeword bits, nb*Z
+    uint32_t     mask;          // Z-bit block mask
+
+    // non-zero blocks of the base matrix, ordered by row
+    unsigned int    num_edges;  // number of non-zero blocks
+    unsigned int *  row_start;  // first block of each row [mb+1]
+    unsigned char * col;        // block column [num_edges]
+    unsigned char * shift;      // cyclic shift [num_edges]
+    unsigned int    max_degree; // maximum row degree
+
+    // parity structure
+    unsigned int    x;          // middle row of first parity column
+    unsigned int    a;          // outer shift of first parity column
+
+    // decoder buffers
+    int8_t *        L;          // posterior LLRs [N]
+    int8_t *        R;          // check messages [num_edges x 32]
+    int8_t *        Q;          // layer workspace [max_degree x 32]
+    uint32_t *      v;          // block vectors [nb]
+};
+
+// cyclic shift of Z-bit block vector: bit z of result is bit (z+s)%Z
+static uint32_t ldpccodec_rotate(ldpccodec    _q,
+                                 uint32_t     _v,
+                                 unsigned int _s)
+{
+    if (_s == 0)
+        return _v;
+    return ((_v >> _s) | (_v << (_q->Z - _s))) & _q->mask;
+}
+
+// read block vector from packed bit array at bit offset _n (msb first)
+static uint32_t ldpccodec_get_block(ldpccodec             _q,
+                                    const unsigned char * _b,
+                                    unsigned int          _n)
+{
+    uint32_t v = 0;
+    unsigned int z;
+    for (z=0; z<_q->Z; z++) {
+        unsigned int i = _n + z;
+        v |= (uint32_t)((_b[i >> 3] >> (7 - (i & 7))) & 1) << z;
+    }
+    return v;
+}
+
+// write block vector to packed bit array at bit offset _n (msb first)
+static void ldpccodec_set_block(ldpccodec       _q,
+                                unsigned char * _b,
+                                unsigned int    _n,
+                                uint32_t        _v)
+{
+    unsigned int z;
+    for (z=0; z<_q->Z; z++) {
+        unsigned int i = _n + z;
+        unsigned char m = 0x80 >> (i & 7);
+        _b[i >> 3] = ((_v >> z) & 1) ? (_b[i >> 3] | m) : (_b[i >> 3] & ~m);
+    }
+}
+
+// create LDPC codec object (see liquid.internal.h)
+ldpccodec ldpccodec_create(const signed char * _base,
+                           unsigned int        _mb,
+                           unsigned int        _nb,
+                           unsigned int        _Z)
+{
+    // validate input
+    if (_Z < 2 || _Z > LDPCCODEC_MAX_Z) {
+        fprintf(stderr,"error: ldpccodec_create(), lifting factor must be in [2,%u]\n", LDPCCODEC_MAX_Z);
+        exit(1);
+    } else if (_mb < 3 || _nb <= _mb || _nb > 255) {
+        fprintf(stderr,"error: ldpccodec_create(), invalid base matrix dimensions\n");
+        exit(1);
+    }
+
+    ldpccodec q = (ldpccodec) liquid_malloc(sizeof(struct ldpccodec_s));
+    q->mb   = _mb;
+    q->nb   = _nb;
+    q->kb   = _nb - _mb;
+    q->Z    = _Z;
+    q->K    = q->kb * _Z;
+    q->M    = _mb * _Z;
+    q->N    = _nb * _Z;
+    q->mask = _Z == 32 ? 0xffffffff : (((uint32_t)1 << _Z) - 1);
+
+    // count non-zero blocks
+    unsigned int r, c, e;
+    q->num_edges = 0;
+    for (r=0; r<_mb*_nb; r++) {
+        if (_base[r] >= (int)_Z) {
+            fprintf(stderr,"error: ldpccodec_create(), shift exceeds lifting factor\n");
+            exit(1);
+        }
+        q->num_edges += _base[r] >= 0;
+    }
+
+    // store non-zero blocks by row
+    q->row_start = (unsigned int *) liquid_malloc((_mb+1)*sizeof(unsigned int));
+    q->col       = (unsigned char*) liquid_malloc(q->num_edges);
+    q->shift     = (unsigned char*) liquid_malloc(q->num_edges);
+    q->max_degree = 0;
+    e = 0;
+    for (r=0; r<_mb; r++) {
+        q->row_start[r] = e;
+        for (c=0; c<_nb; c++) {
+            if (_base[r*_nb+c] < 0)
+                continue;
+            q->col[e]   = c;
+            q->shift[e] = _base[r*_nb+c];
+            e++;
+        }
+        if (e - q->row_start[r] > q->max_degree)
+            q->max_degree = e - q->row_start[r];
+    }
+    q->row_start[_mb] = e;
+
+    // validate dual-diagonal parity structure
+    const signed char * p0 = _base + q->kb;
+    q->a = p0[0];
+    q->x = 0;
+    int valid = p0[0] >= 0 && p0[0] == p0[(_mb-1)*_nb];
+    for (r=1; r<_mb-1; r++) {
+        if (p0[r*_nb] == 0 && q->x == 0)
+            q->x = r;
+        else if (p0[r*_nb] >= 0)
+            valid = 0;
+    }
+    for (r=0; r<_mb && valid; r++) {
+        for (c=1; c<_mb; c++) {
+            int s = _base[r*_nb + q->kb + c];
+            int diagonal = (c == r) || (c == r+1);
+            if ((diagonal && s != 0) || (!diagonal && s >= 0))
+                valid = 0;
+        }
+    }
+    if (!valid || q->x == 0) {
+        fprintf(stderr,"error: ldpccodec_create(), base matrix lacks dual-diagonal parity structure\n");
+        exit(1);
+    }
+
+    // decoder buffers
+    q->L = (int8_t*)   liquid_malloc(q->N);
+    q->R = (int8_t*)   liquid_malloc_aligned(q->num_edges*32);
+    q->Q = (int8_t*)   liquid_malloc_aligned(q->max_degree*32);
+    q->v = (uint32_t*) liquid_malloc(_nb*sizeof(uint32_t));
+    memset(q->Q, 0x00, q->max_degree*32);
+
+    return q;
+}
+
+// destroy LDPC codec object
+void ldpccodec_destroy(ldpccodec _q)
+{
+    liquid_free(_q->row_start);
+    liquid_free(_q->col);
+    liquid_free(_q->shift);
+    liquid_free(_q->L);
+    liquid_free_aligned(_q->R);
+    liquid_free_aligned(_q->Q);
+    liquid_free(_q->v);
+    liquid_free(_q);
+}
+
+// get number of information bits
+unsigned int ldpccodec_get_k(ldpccodec _q)
+{
+    return _q->K;
+}
+
+// get number of codeword bits
+unsigned int ldpccodec_get_n(ldpccodec _q)
+{
+    return _q->N;
+}
+
+// compute parity bits for message (see liquid.internal.h)
+void ldpccodec_encode(ldpccodec             _q,
+                      const unsigned char * _msg,
+                      unsigned char *       _parity)
+{
+    unsigned int r, c, e;
+    uint32_t * u = _q->v;
+    for (c=0; c<_q->kb; c++)
+        u[c] = ldpccodec_get_block(_q, _msg, c*_q->Z);
+
+    // lambda[r]: contribution of information blocks to each block row,
+    // stored in place of the parity blocks
+    uint32_t * lambda = u + _q->kb;
+    for (r=0; r<_q->mb; r++) {
+        lambda[r] = 0;
+        for (e=_q->row_start[r]; e<_q->row_start[r+1] && _q->col[e]<_q->kb; e++)
+            lambda[r] ^= ldpccodec_rotate(_q, u[_q->col[e]], _q->shift[e]);
+    }
+
+    // first parity block: sum of all rows cancels the staircase and the
+    // first parity column sums to the identity
+    uint32_t p0 = 0;
+    for (r=0; r<_q->mb; r++)
+        p0 ^= lambda[r];
+
+    // remaining parity blocks by back substitution
+    uint32_t t = ldpccodec_rotate(_q, p0, _q->a);
+    uint32_t p = lambda[0] ^ t;
+    ldpccodec_set_block(_q, _parity, 0,     p0);
+    ldpccodec_set_block(_q, _parity, _q->Z, p);
+    for (r=1; r<_q->mb-1; r++) {
+        p ^= lambda[r];
+        if (r == _q->x)
+            p ^= p0;
+        ldpccodec_set_block(_q, _parity, (r+1)*_q->Z, p);
+    }
+}
+
+// check parity of codeword, returning 1 if all checks are satisfied
+int ldpccodec_check(ldpccodec             _q,
+                    const unsigned char * _codeword)
+{
+    unsigned int r, c, e;
+    for (c=0; c<_q->nb; c++)
+        _q->v[c] = ldpccodec_get_block(_q, _codeword, c*_q->Z);
+
+    for (r=0; r<_q->mb; r++) {
+        uint32_t s = 0;
+        for (e=_q->row_start[r]; e<_q->row_start[r+1]; e++)
+            s ^= ldpccodec_rotate(_q, _q->v[_q->col[e]], _q->shift[e]);
+        if (s)
+            return 0;
+    }
+    return 1;
+}
+
+// saturate to symmetric 8-bit range
+static int8_t ldpccodec_sat(int _v)
+{
+    return _v > 127 ? 127 : (_v < -127 ? -127 : _v);
+}
+
+// check-node update of one layer (see liquid.internal.h), portable C
+void liquid_ldpc_layer(int8_t *     _Q,
+                       int8_t *     _R,
+                       unsigned int _d,
+                       unsigned int _z)
+{
+    unsigned int e, z;
+    for (z=0; z<_z; z++) {
+        int min1 = 127;
+        int min2 = 127;
+        int sgn  = 0;
+        for (e=0; e<_d; e++) {
+            int q = ldpccodec_sat(_Q[32*e+z] - _R[32*e+z]);
+            int a = q < 0 ? -q : q;
+            _Q[32*e+z] = q;
+            min2 = a < min1 ? min1 : (a < min2 ? a : min2);
+            min1 = a < min1 ? a : min1;
+            sgn ^= q < 0;
+        }
+
+        // normalized magnitudes for the minimum and all other edges
+        int m1 = min1 - (min1 >> 2);
+        int m2 = min2 - (min2 >> 2);
+        for (e=0; e<_d; e++) {
+            int q   = _Q[32*e+z];
+            int mag = (q == min1 || q == -min1) ? m2 : m1;
+            int r   = (sgn ^ (q < 0)) ? -mag : mag;
+            _R[32*e+z] = r;
+            _Q[32*e+z] = ldpccodec_sat(q + r);
+        }
+    }
+}
+
+#if HAVE_DOTPROD_NEON && defined(__aarch64__)
+// check-node update of one layer, two sixteen-lane halves
+static void liquid_ldpc_layer_neon(int8_t *     _Q,
+                                   int8_t *     _R,
+                                   unsigned int _d)
+{
+    int8x16_t lim = vdupq_n_s8(-127);
+    unsigned int e, h;
+    for (h=0; h<32; h+=16) {
+        int8x16_t min1 = vdupq_n_s8(127);
+        int8x16_t min2 = vdupq_n_s8(127);
+        int8x16_t sgn  = vdupq_n_s8(0);
+        for (e=0; e<_d; e++) {
+            int8x16_t q = vmaxq_s8(vqsubq_s8(vld1q_s8(_Q+32*e+h), vld1q_s8(_R+32*e+h)), lim);
+            int8x16_t a = vabsq_s8(q);
+            vst1q_s8(_Q+32*e+h, q);
+            min2 = vminq_s8(vmaxq_s8(min1, a), min2);
+            min1 = vminq_s8(min1, a);
+            sgn  = veorq_s8(sgn, q);
+        }
+        int8x16_t m1 = vsubq_s8(min1, vshrq_n_s8(min1, 2));
+        int8x16_t m2 = vsubq_s8(min2, vshrq_n_s8(min2, 2));
+        for (e=0; e<_d; e++) {
+            int8x16_t q   = vld1q_s8(_Q+32*e+h);
+            int8x16_t mag = vbslq_s8(vceqq_s8(vabsq_s8(q), min1), m2, m1);
+            uint8x16_t neg = vcltq_s8(veorq_s8(sgn, q), vdupq_n_s8(0));
+            int8x16_t r   = vbslq_s8(neg, vnegq_s8(mag), mag);
+            vst1q_s8(_R+32*e+h, r);
+            vst1q_s8(_Q+32*e+h, vmaxq_s8(vqaddq_s8(q, r), lim));
+        }
+    }
+}
+#endif
+
+// decode codeword (see liquid.internal.h)
+int ldpccodec_decode(ldpccodec       _q,
+                     const int8_t *  _llr,
+                     unsigned int    _max_iterations,
+                     unsigned char * _msg)
+{
+    unsigned int Z = _q->Z;
+    unsigned int i, r, c, e, z;
+
+    // resolve check-node kernel once per codeword
+    void (*layer)(int8_t *, int8_t *, unsigned int) = NULL;
+#if HAVE_DOTPROD_AVX
+    liquid_simd_level level = liquid_simd_get_level();
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F)
+        layer = liquid_ldpc_layer_avx2;
+    else if (level == LIQUID_SIMD_SSE && liquid_ldpc_have_ssse3())
+        layer = liquid_ldpc_layer_ssse3;
+#elif HAVE_DOTPROD_NEON && defined(__aarch64__)
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE)
+        layer = liquid_ldpc_layer_neon;
+#endif
+
+    // initialize posteriors with channel values and clear messages
+    for (i=0; i<_q->N; i++)
+        _q->L[i] = _llr[i] < -127 ? -127 : _llr[i];
+    memset(_q->R, 0x00, _q->num_edges*32);
+
+    int num_iterations = -1;
+    for (i=0; i<_max_iterations && num_iterations < 0; i++) {
+        for (r=0; r<_q->mb; r++) {
+            unsigned int e0 = _q->row_start[r];
+            unsigned int d  = _q->row_start[r+1] - e0;
+
+            // gather rotated posteriors: lane z of edge e holds variable
+            // (z + shift) % Z of its block column
+            for (e=0; e<d; e++) {
+                const int8_t * p = _q->L + _q->col[e0+e]*Z;
+                unsigned int   s = _q->shift[e0+e];
+                memcpy(_q->Q + 32*e,         p + s, Z - s);
+                memcpy(_q->Q + 32*e + Z - s, p,     s);
+            }
+
+            if (layer != NULL)
+                layer(_q->Q, _q->R + 32*e0, d);
+            else
+                liquid_ldpc_layer(_q->Q, _q->R + 32*e0, d, Z);
+
+            // scatter updated posteriors
+            for (e=0; e<d; e++) {
+                int8_t *     p = _q->L + _q->col[e0+e]*Z;
+                unsigned int s = _q->shift[e0+e];
+                memcpy(p + s, _q->Q + 32*e,         Z - s);
+                memcpy(p,     _q->Q + 32*e + Z - s, s);
+            }
+        }
+
+        // early termination: hard decisions satisfy all checks
+        for (c=0; c<_q->nb; c++) {
+            uint32_t v = 0;
+            for (z=0; z<Z; z++)
+                v |= (uint32_t)(_q->L[c*Z+z] < 0) << z;
+            _q->v[c] = v;
+        }
+        int valid = 1;
+        for (r=0; r<_q->mb && valid; r++) {
+            uint32_t s = 0;
+            for (e=_q->row_start[r]; e<_q->row_start[r+1]; e++)
+                s ^= ldpccodec_rotate(_q, _q->v[_q->col[e]], _q->shift[e]);
+            valid = s == 0;
+        }
+        if (valid)
+            num_iterations = i+1;
+    }
+
+    // pack hard decisions of information bits
+    memset(_msg, 0x00, (_q->K + 7)/8);
+    for (i=0; i<_q->K; i++)
+        _msg[i >> 3] |= (_q->L[i] < 0) << (7 - (i & 7));
+
+    return num_iterations;
+}
@@ -30,8 +30,14 @@
 
 #include "liquid.internal.h"
 
-// reallocate memory for buffers
-void packetizer_realloc_buffers(packetizer _p, unsigned int _len);
+// run hard-decision de-interleaver and decoder for plans _n-1 down to 0,
+// leaving the result in buffer[0]
+void packetizer_decode_plans(packetizer            _p,
+                             unsigned int          _n,
+                             const unsigned char * _pkt);
+
+// strip crc from buffer[0], copy result to output, and return validity
+int packetizer_validate(packetizer _p, unsigned char * _msg);
 
 // computes the number of encoded bytes after packetizing
 //
@@ -95,21 +101,23 @@ packetizer packetizer_create(unsigned int _n,
                              int _fec0,
                              int _fec1)
 {
-    packetizer p = (packetizer) malloc(sizeof(struct packetizer_s));
+    packetizer p = (packetizer) liquid_malloc(sizeof(struct packetizer_s));
 
     p->msg_len      = _n;
     p->packet_len   = packetizer_compute_enc_msg_len(_n, _crc, _fec0, _fec1);
     p->check        = _crc;
     p->crc_length   = crc_get_length(p->check);
 
-    // allocate memory for buffers (scale by 8 for soft decoding)
+    // allocate memory for buffers (scale by 8 for soft decoding); these
+    // serve as the workspace for every encode/decode call
     p->buffer_len = p->packet_len;
-    p->buffer_0 = (unsigned char*) malloc(8*p->buffer_len);
-    p->buffer_1 = (unsigned char*) malloc(8*p->buffer_len);
+    p->buffer_0 = (unsigned char*) liquid_malloc(8*p->buffer_len);
+    p->buffer_1 = (unsigned char*) liquid_malloc(8*p->buffer_len);
+    memset(p->cache, 0x00, sizeof(p->cache));
 
     // create plan
     p->plan_len = 2;
-    p->plan = (struct fecintlv_plan*) malloc((p->plan_len)*sizeof(struct fecintlv_plan));
+    p->plan = (struct fecintlv_plan*) liquid_malloc((p->plan_len)*sizeof(struct fecintlv_plan));
 
     // set schemes
     unsigned int i;
@@ -123,8 +131,8 @@ packetizer packetizer_create(unsigned int _n,
         p->plan[i].enc_msg_len = fec_get_enc_msg_length(p->plan[i].fs,
                                                         p->plan[i].dec_msg_len);
 
-        // create objects
-        p->plan[i].f = fec_create(p->plan[i].fs, NULL);
+        // create interleaver; fec objects are borrowed from the shared
+        // pool for each operation
         p->plan[i].q = interleaver_create(p->plan[i].enc_msg_len);
 
         // set interleaver depth to zero if no error correction scheme
@@ -139,6 +147,19 @@ packetizer packetizer_create(unsigned int _n,
     return p;
 }
 
+// check whether packetizer has the given configuration
+static int packetizer_matches(packetizer   _p,
+                              unsigned int _n,
+                              int          _crc,
+                              int          _fec0,
+                              int          _fec1)
+{
+    return _p->msg_len    == _n    &&
+           _p->check      == _crc  &&
+           _p->plan[0].fs == _fec0 &&
+           _p->plan[1].fs == _fec1;
+}
+
 // re-create packetizer object
 //
 //  _p      :   initialz packetizer object
@@ -158,40 +179,68 @@ packetizer packetizer_recreate(packetizer _p,
     }
 
     // check values
-    if (_p->msg_len     ==  _n      &&
-        _p->check       ==  _crc    &&
-        _p->plan[0].fs  ==  _fec0   &&
-        _p->plan[1].fs  ==  _fec1 )
-    {
+    if (packetizer_matches(_p, _n, _crc, _fec0, _fec1)) {
         // no change; return input pointer
         return _p;
-    } else {
-        // something has changed; destroy old object and create new one
-        // TODO : rather than completely destroying object, only change values that are necessary
-        packetizer_destroy(_p);
-        return packetizer_create(_n,_crc,_fec0,_fec1);
     }
+
+    // something has changed; the replaced object is kept in a small
+    // cache handed on to the returned object, and a cached object of
+    // the requested configuration is reused rather than created
+    packetizer c[PACKETIZER_CACHE_LEN];
+    memmove(c, _p->cache, sizeof(c));
+    memset(_p->cache, 0x00, sizeof(_p->cache));
+
+    packetizer p = NULL;
+    unsigned int i;
+    for (i=0; i<PACKETIZER_CACHE_LEN; i++) {
+        if (c[i] != NULL && packetizer_matches(c[i], _n, _crc, _fec0, _fec1)) {
+            p = c[i];
+            c[i] = NULL;
+            break;
+        }
+    }
+    if (p == NULL) {
+        p = packetizer_create(_n,_crc,_fec0,_fec1);
+        if (c[PACKETIZER_CACHE_LEN-1] != NULL) {
+            packetizer_destroy(c[PACKETIZER_CACHE_LEN-1]);
+            c[PACKETIZER_CACHE_LEN-1] = NULL;
+        }
+    }
+
+    // replaced object becomes most recently used
+    unsigned int n = 0;
+    p->cache[n++] = _p;
+    for (i=0; i<PACKETIZER_CACHE_LEN; i++) {
+        if (c[i] != NULL)
+            p->cache[n++] = c[i];
+    }
+    return p;
 }
 
 // destroy packetizer object
 void packetizer_destroy(packetizer _p)
 {
-    // free fec, interleaver objects
+    // free interleaver objects
     unsigned int i;
-    for (i=0; i<_p->plan_len; i++) {
-        fec_destroy(_p->plan[i].f);
+    for (i=0; i<_p->plan_len; i++)
         interleaver_destroy(_p->plan[i].q);
-    };
 
     // free plan
-    free(_p->plan);
+    liquid_free(_p->plan);
 
     // free buffers
-    free(_p->buffer_0);
-    free(_p->buffer_1);
+    liquid_free(_p->buffer_0);
+    liquid_free(_p->buffer_1);
+
+    // destroy cached packetizers
+    for (i=0; i<PACKETIZER_CACHE_LEN; i++) {
+        if (_p->cache[i] != NULL)
+            packetizer_destroy(_p->cache[i]);
+    }
 
     // free packetizer object
-    free(_p);
+    liquid_free(_p);
 }
 
 // print packetizer object internals
@@ -212,6 +261,19 @@ void packetizer_print(packetizer _p)
     }
 }
 
+// get memory footprint of packetizer [bytes]; fec codecs are borrowed
+// from the shared pool for each operation and are not counted
+unsigned long int packetizer_get_memory_usage(packetizer _p)
+{
+    unsigned long int n = sizeof(struct packetizer_s)
+                        + 2*8*_p->buffer_len*sizeof(unsigned char)
+                        + _p->plan_len*sizeof(struct fecintlv_plan);
+    unsigned int i;
+    for (i=0; i<_p->plan_len; i++)
+        n += interleaver_get_memory_usage(_p->plan[i].q);
+    return n;
+}
+
 // get decoded message length
 unsigned int packetizer_get_dec_msg_len(packetizer _p)
 {
@@ -263,54 +325,78 @@ void packetizer_encode(packetizer            _p,
         key >>= 8;
     }
 
-    // execute fec/interleaver plans
+    // find last plan which applies error correction; plans without
+    // error correction (and hence without interleaving) are skipped
+    // entirely rather than copied through
+    unsigned int num_plans = 0;
     for (i=0; i<_p->plan_len; i++) {
+        if (_p->plan[i].fs != LIQUID_FEC_NONE)
+            num_plans = i+1;
+    }
+
+    // execute fec/interleaver plans
+    for (i=0; i<num_plans; i++) {
+        if (_p->plan[i].fs == LIQUID_FEC_NONE)
+            continue;
+
         // run the encoder: buffer[0] > buffer[1]
-        fec_encode(_p->plan[i].f,
-                   _p->plan[i].dec_msg_len,
-                   _p->buffer_0,
-                   _p->buffer_1);
+        fec f = fec_pool_acquire(_p->plan[i].fs);
+        fec_encode(f, _p->plan[i].dec_msg_len, _p->buffer_0, _p->buffer_1);
+        fec_pool_release(f);
 
-        // run the interleaver: buffer[1] > buffer[0]
+        // run the interleaver: buffer[1] > buffer[0], or directly to
+        // the output on the last plan
         interleaver_encode(_p->plan[i].q,
                            _p->buffer_1,
-                           _p->buffer_0);
+                           i == num_plans-1 ? _pkt : _p->buffer_0);
     }
 
-    // copy result to output
-    memmove(_pkt, _p->buffer_0, _p->packet_len);
+    // copy result to output if no plan wrote it there
+    if (num_plans == 0)
+        memmove(_pkt, _p->buffer_0, _p->packet_len);
 }
 
-// Execute the packetizer to decode an input message, return validity
-// check of resulting data
-//
+// run hard-decision de-interleaver and decoder for plans _n-1 down to 0,
+// reading from _pkt and leaving the result in buffer[0]
 //  _p      :   packetizer object
-//  _pkt    :   input message (coded bytes)
-//  _msg    :   decoded output message
-int packetizer_decode(packetizer            _p,
-                      const unsigned char * _pkt,
-                      unsigned char *       _msg)
+//  _n      :   number of plans to decode
+//  _pkt    :   input message (coded bytes), can be buffer[0]
+void packetizer_decode_plans(packetizer            _p,
+                             unsigned int          _n,
+                             const unsigned char * _pkt)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, _p->packet_len);
+    // NOTE: de-interleaver only reads from its input
+    unsigned char * r = (unsigned char*) _pkt;
 
-    // execute fec/interleaver plans
     unsigned int i;
-    for (i=_p->plan_len; i>0; i--) {
-        // run the de-interleaver: buffer[0] > buffer[1]
-        interleaver_decode(_p->plan[i-1].q,
-                           _p->buffer_0,
-                           _p->buffer_1);
+    for (i=_n; i>0; i--) {
+        if (_p->plan[i-1].fs == LIQUID_FEC_NONE)
+            continue;
+
+        // run the de-interleaver: input > buffer[1]
+        interleaver_decode(_p->plan[i-1].q, r, _p->buffer_1);
 
         // run the decoder: buffer[1] > buffer[0]
-        fec_decode(_p->plan[i-1].f,
-                   _p->plan[i-1].dec_msg_len,
-                   _p->buffer_1,
-                   _p->buffer_0);
+        fec f = fec_pool_acquire(_p->plan[i-1].fs);
+        fec_decode(f, _p->plan[i-1].dec_msg_len, _p->buffer_1, _p->buffer_0);
+        fec_pool_release(f);
+
+        r = _p->buffer_0;
     }
 
+    // copy input to buffer[0] if no plan applied error correction
+    if (r != _p->buffer_0)
+        memmove(_p->buffer_0, r, _p->plan[0].dec_msg_len);
+}
+
+// strip crc from buffer[0], copy result to output, and return crc
+// validity
+int packetizer_validate(packetizer      _p,
+                        unsigned char * _msg)
+{
     // strip crc, validate message
     unsigned int key = 0;
+    unsigned int i;
     for (i=0; i<_p->crc_length; i++) {
         key <<= 8;
 
@@ -327,6 +413,23 @@ int packetizer_decode(packetizer            _p,
                                 key);
 }
 
+// Execute the packetizer to decode an input message, return validity
+// check of resulting data
+//
+//  _p      :   packetizer object
+//  _pkt    :   input message (coded bytes)
+//  _msg    :   decoded output message
+int packetizer_decode(packetizer            _p,
+                      const unsigned char * _pkt,
+                      unsigned char *       _msg)
+{
+    // execute fec/interleaver plans: coded message > buffer[0]
+    packetizer_decode_plans(_p, _p->plan_len, _pkt);
+
+    // strip crc, validate message
+    return packetizer_validate(_p, _msg);
+}
+
 // Execute the packetizer to decode an input message, return validity
 // check of resulting data
 //
@@ -337,71 +440,72 @@ int packetizer_decode_soft(packetizer            _p,
                            const unsigned char * _pkt,
                            unsigned char *       _msg)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, 8*_p->packet_len);
+    struct fecintlv_plan * plan = &_p->plan[_p->plan_len-1];
 
     // 
     // decode outer level using soft decoding
     //
 
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode_soft(_p->plan[1].q,
-                            _p->buffer_0,
-                            _p->buffer_1);
-
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode_soft(_p->plan[1].f,
-                    _p->plan[1].dec_msg_len,
-                    _p->buffer_1,
-                    _p->buffer_0);
+    fec f = fec_pool_acquire(plan->fs);
+    if (f->decode_soft_func != NULL) {
+        // run the de-interleaver: input > buffer[1]
+        // NOTE: de-interleaver only reads from its input
+        interleaver_decode_soft(plan->q,
+                                (unsigned char*) _pkt,
+                                _p->buffer_1);
 
-    // 
-    // decode inner level using hard decoding
-    //
+        // run the decoder: buffer[1] > buffer[0]
+        fec_decode_soft(f, plan->dec_msg_len, _p->buffer_1, _p->buffer_0);
+        fec_pool_release(f);
 
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode(_p->plan[0].q,
-                       _p->buffer_0,
-                       _p->buffer_1);
+        // decode inner levels using hard decoding
+        packetizer_decode_plans(_p, _p->plan_len-1, _p->buffer_0);
+    } else {
+        fec_pool_release(f);
 
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode(_p->plan[0].f,
-               _p->plan[0].dec_msg_len,
-               _p->buffer_1,
-               _p->buffer_0);
+        // no soft decoder for outer level: make hard decisions up front
+        // (interleaving soft bits and hard bits is equivalent) and decode
+        // all levels using hard decoding
+        liquid_pack_soft_bytes(_pkt, _p->packet_len, _p->buffer_0);
+        packetizer_decode_plans(_p, _p->plan_len, _p->buffer_0);
+    }
 
     // strip crc, validate message
-    unsigned int key = 0;
-    unsigned int i;
-    for (i=0; i<_p->crc_length; i++) {
-        key <<= 8;
+    return packetizer_validate(_p, _msg);
+}
 
-        key |= _p->buffer_0[_p->msg_len+i];
+// Check an encoded message before decoding (see liquid.h)
+//  _p          :   packetizer object
+//  _pkt        :   input message (coded bytes)
+//  _threshold  :   maximum fraction of uncorrectable codewords
+int packetizer_precheck(packetizer            _p,
+                        const unsigned char * _pkt,
+                        float                 _threshold)
+{
+    // find outer plan which applies error correction
+    unsigned int i;
+    for (i=_p->plan_len; i>0; i--) {
+        if (_p->plan[i-1].fs != LIQUID_FEC_NONE)
+            break;
     }
+    if (i == 0)
+        return 1;
+    struct fecintlv_plan * plan = &_p->plan[i-1];
 
-    // copy result to output
-    memmove(_msg, _p->buffer_0, _p->msg_len);
+    // run the de-interleaver: input > buffer[1]
+    interleaver_decode(plan->q, (unsigned char*) _pkt, _p->buffer_1);
 
-    // return crc validity
-    return crc_validate_message(_p->check,
-                                _p->buffer_0,
-                                _p->msg_len,
-                                key);
+    // count codewords with uncorrectable error patterns
+    unsigned int num_codewords = 0;
+    unsigned int num_uncorrectable = fec_count_uncorrectable(plan->fs,
+                                                             plan->dec_msg_len,
+                                                             _p->buffer_1,
+                                                             &num_codewords);
+
+    return (float)num_uncorrectable <= _threshold*(float)num_codewords;
 }
 
 void packetizer_set_scheme(packetizer _p, int _fec0, int _fec1)
 {
     //
 }
-
-// 
-// internal methods
-//
-
-void packetizer_realloc_buffers(packetizer _p, unsigned int _len)
-{
-    _p->buffer_len = _len;
-    _p->buffer_0 = (unsigned char*) realloc(_p->buffer_0, _p->buffer_len);
-    _p->buffer_1 = (unsigned char*) realloc(_p->buffer_1, _p->buffer_len);
-}
-
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// rscodec.avx.c : Reed-Solomon syndrome kernels (x86 SSSE3 and AVX2)
+//
+// Each syndrome is evaluated with Horner's rule over W interleaved
+// lanes (W=16 or 32): lane l accumulates the symbols at positions
+// congruent to l (mod W), multiplied by alpha^(W*root) every step, so
+// all lanes share one constant and the GF(2^8) product is two PSHUFB
+// nibble-table lookups. The lanes are combined in rscodec.c. These
+// kernels are compiled with per-function target attributes and are
+// selected at run time.
+//
+
+#include <string.h>
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// cached run-time check for SSSE3 (see liquid.internal.h)
+int liquid_rs_have_ssse3(void)
+{
+    static int have_ssse3 = -1;
+    if (have_ssse3 < 0) {
+        __builtin_cpu_init();
+        have_ssse3 = __builtin_cpu_supports("ssse3");
+    }
+    return have_ssse3;
+}
+
+// sixteen lanes
+__attribute__((target("ssse3")))
+void liquid_rs_syndromes_ssse3(const unsigned char * _tab16,
+                               const unsigned char * _r,
+                               unsigned int          _n,
+                               unsigned int          _nroots,
+                               unsigned char *       _acc)
+{
+    // leading zeros align the block to the lane width
+    unsigned int z = (16 - _n%16) % 16;
+    unsigned int m = (_n + z) / 16;
+    unsigned char head[16];
+    memset(head, 0x00, z);
+    memcpy(head + z, _r, 16 - z);
+    const unsigned char * p = _r + 16 - z;
+
+    __m128i mask = _mm_set1_epi8(0x0f);
+    unsigned int j, k;
+    for (j=0; j<_nroots; j++) {
+        __m128i tlo = _mm_load_si128((const __m128i*)(_tab16 + 32*j));
+        __m128i thi = _mm_load_si128((const __m128i*)(_tab16 + 32*j + 16));
+        __m128i a   = _mm_loadu_si128((const __m128i*)head);
+        for (k=1; k<m; k++) {
+            __m128i lo = _mm_shuffle_epi8(tlo, _mm_and_si128(a, mask));
+            __m128i hi = _mm_shuffle_epi8(thi, _mm_and_si128(_mm_srli_epi16(a, 4), mask));
+            a = _mm_xor_si128(_mm_xor_si128(lo, hi),
+                              _mm_loadu_si128((const __m128i*)(p + 16*(k-1))));
+        }
+        _mm_storeu_si128((__m128i*)(_acc + 16*j), a);
+    }
+}
+
+// thirty-two lanes, folded to sixteen: lane l of the wide register
+// precedes lane l+16 by sixteen positions, so the low half is scaled by
+// the sixteen-lane constant from _tab16 before adding the high half
+__attribute__((target("avx2")))
+void liquid_rs_syndromes_avx2(const unsigned char * _tab32,
+                              const unsigned char * _tab16,
+                              const unsigned char * _r,
+                              unsigned int          _n,
+                              unsigned int          _nroots,
+                              unsigned char *       _acc)
+{
+    unsigned int z = (32 - _n%32) % 32;
+    unsigned int m = (_n + z) / 32;
+    unsigned char head[32];
+    memset(head, 0x00, z);
+    memcpy(head + z, _r, 32 - z);
+    const unsigned char * p = _r + 32 - z;
+
+    __m256i mask = _mm256_set1_epi8(0x0f);
+    unsigned int j, k;
+    for (j=0; j<_nroots; j++) {
+        // PSHUFB looks up within each 128-bit lane
+        __m256i tlo = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(_tab32 + 32*j)));
+        __m256i thi = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(_tab32 + 32*j + 16)));
+        __m256i a   = _mm256_loadu_si256((const __m256i*)head);
+        for (k=1; k<m; k++) {
+            __m256i lo = _mm256_shuffle_epi8(tlo, _mm256_and_si256(a, mask));
+            __m256i hi = _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi16(a, 4), mask));
+            a = _mm256_xor_si256(_mm256_xor_si256(lo, hi),
+                                 _mm256_loadu_si256((const __m256i*)(p + 32*(k-1))));
+        }
+
+        // fold
+        __m128i a0 = _mm256_castsi256_si128(a);
+        __m128i a1 = _mm256_extracti128_si256(a, 1);
+        __m128i m0 = _mm_set1_epi8(0x0f);
+        __m128i lo = _mm_shuffle_epi8(_mm_load_si128((const __m128i*)(_tab16 + 32*j)),
+                                      _mm_and_si128(a0, m0));
+        __m128i hi = _mm_shuffle_epi8(_mm_load_si128((const __m128i*)(_tab16 + 32*j + 16)),
+                                      _mm_and_si128(_mm_srli_epi16(a0, 4), m0));
+        _mm_storeu_si128((__m128i*)(_acc + 16*j), _mm_xor_si128(_mm_xor_si128(lo, hi), a1));
+    }
+}
+
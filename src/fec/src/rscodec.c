@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// rscodec.c : Reed-Solomon codec over GF(2^8)
+//
+// Systematic encoder and errors-only decoder for (possibly shortened)
+// codes with 8-bit symbols; the generator polynomial, parity ordering
+// and padding convention follow libfec's init_rs_char() so that encoded
+// blocks are interchangeable. Decoding computes the syndromes (with
+// SIMD nibble-table kernels where available), returns immediately for
+// valid codewords, and otherwise runs Berlekamp-Massey, a Chien search
+// that stops once all roots are found, and Forney's algorithm.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_DOTPROD_NEON && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#define RSCODEC_NN  (255)   // symbols per full codeword
+#define RSCODEC_A0  (255)   // log of zero
+
+struct rscodec_s {
+    unsigned int nroots;        // number of parity symbols
+    unsigned int fcs;           // first consecutive root (log form)
+    unsigned int n;             // shortened codeword length, 255 - pad
+
+    unsigned char alog[2*RSCODEC_NN];   // alpha^i, i in [0,510)
+    unsigned char log[256];             // log_alpha(x), log(0) = A0
+
+    unsigned char * gtab;       // feedback products [256 x nroots]
+    unsigned char * rmul;       // multiply by root j [nroots x 256]
+    unsigned char * tab16;      // nibble tables, alpha^(16*root j) [nroots x 32]
+    unsigned char * tab32;      // nibble tables, alpha^(32*root j) [nroots x 32]
+
+    // decoder buffers
+    unsigned char * syndromes;  // [nroots]
+    unsigned char * acc;        // lane accumulators [nroots x 16]
+    unsigned char * lambda;     // error locator [nroots+1]
+    unsigned char * b;          // previous locator [nroots+1]
+    unsigned char * t;          // temporary [nroots+1]
+    unsigned char * omega;      // error evaluator [nroots]
+    unsigned int  * loc;        // root degrees [nroots]
+};
+
+// multiply two field elements
+static unsigned char rscodec_mul(rscodec       _q,
+                                 unsigned char _a,
+                                 unsigned char _b)
+{
+    if (_a == 0 || _b == 0)
+        return 0;
+    return _q->alog[_q->log[_a] + _q->log[_b]];
+}
+
+// alpha^_e for any non-negative exponent
+static unsigned char rscodec_pow(rscodec      _q,
+                                 unsigned int _e)
+{
+    return _q->alog[_e % RSCODEC_NN];
+}
+
+// fill 16-entry nibble product tables for multiplying by _c
+static void rscodec_nibble_tables(rscodec         _q,
+                                  unsigned char   _c,
+                                  unsigned char * _tab)
+{
+    unsigned int i;
+    for (i=0; i<16; i++) {
+        _tab[i]    = rscodec_mul(_q, _c, i);
+        _tab[16+i] = rscodec_mul(_q, _c, i << 4);
+    }
+}
+
+// create Reed-Solomon codec object (see liquid.internal.h)
+rscodec rscodec_create(unsigned int _genpoly,
+                       unsigned int _fcs,
+                       unsigned int _prim,
+                       unsigned int _nroots,
+                       unsigned int _pad)
+{
+    // validate input
+    if (_genpoly < 0x100 || _genpoly > 0x1ff) {
+        fprintf(stderr,"error: rscodec_create(), field polynomial must have degree 8\n");
+        exit(1);
+    } else if (_prim != 1) {
+        fprintf(stderr,"error: rscodec_create(), only primitive element 1 is supported\n");
+        exit(1);
+    } else if (_nroots == 0 || _nroots >= RSCODEC_NN) {
+        fprintf(stderr,"error: rscodec_create(), number of roots must be in [1,254]\n");
+        exit(1);
+    } else if (_pad >= RSCODEC_NN - _nroots) {
+        fprintf(stderr,"error: rscodec_create(), padding exceeds message length\n");
+        exit(1);
+    }
+
+    rscodec q = (rscodec) liquid_malloc(sizeof(struct rscodec_s));
+    q->nroots = _nroots;
+    q->fcs    = _fcs % RSCODEC_NN;
+    q->n      = RSCODEC_NN - _pad;
+
+    // log/antilog tables
+    unsigned int i, j, sr = 1;
+    q->log[0] = RSCODEC_A0;
+    for (i=0; i<RSCODEC_NN; i++) {
+        q->alog[i] = sr;
+        q->alog[i+RSCODEC_NN] = sr;
+        q->log[sr] = i;
+        sr <<= 1;
+        if (sr & 0x100)
+            sr ^= _genpoly;
+    }
+    if (sr != 1) {
+        fprintf(stderr,"error: rscodec_create(), field polynomial 0x%x is not primitive\n", _genpoly);
+        exit(1);
+    }
+
+    // generator polynomial: prod_j (x - alpha^(fcs+j)), g[nroots] = 1
+    unsigned char g[_nroots+1];
+    memset(g, 0x00, _nroots+1);
+    g[0] = 1;
+    for (j=0; j<_nroots; j++) {
+        unsigned char r = rscodec_pow(q, q->fcs + j);
+        for (i=j+1; i>0; i--)
+            g[i] = g[i-1] ^ rscodec_mul(q, g[i], r);
+        g[0] = rscodec_mul(q, g[0], r);
+    }
+
+    // feedback products: gtab[fb][k] = fb * g[nroots-1-k]
+    q->gtab = (unsigned char*) liquid_malloc(256*_nroots);
+    for (i=0; i<256; i++) {
+        for (j=0; j<_nroots; j++)
+            q->gtab[i*_nroots + j] = rscodec_mul(q, i, g[_nroots-1-j]);
+    }
+
+    // syndrome tables
+    q->rmul  = (unsigned char*) liquid_malloc(_nroots*256);
+    q->tab16 = (unsigned char*) liquid_malloc_aligned(_nroots*32);
+    q->tab32 = (unsigned char*) liquid_malloc_aligned(_nroots*32);
+    for (j=0; j<_nroots; j++) {
+        unsigned char r = rscodec_pow(q, q->fcs + j);
+        for (i=0; i<256; i++)
+            q->rmul[j*256 + i] = rscodec_mul(q, r, i);
+        rscodec_nibble_tables(q, rscodec_pow(q, 16*(q->fcs + j)), q->tab16 + 32*j);
+        rscodec_nibble_tables(q, rscodec_pow(q, 32*(q->fcs + j)), q->tab32 + 32*j);
+    }
+
+    // decoder buffers
+    q->syndromes = (unsigned char*) liquid_malloc(_nroots);
+    q->acc       = (unsigned char*) liquid_malloc_aligned(_nroots*16);
+    q->lambda    = (unsigned char*) liquid_malloc(_nroots+1);
+    q->b         = (unsigned char*) liquid_malloc(_nroots+1);
+    q->t         = (unsigned char*) liquid_malloc(_nroots+1);
+    q->omega     = (unsigned char*) liquid_malloc(_nroots);
+    q->loc       = (unsigned int *) liquid_malloc(_nroots*sizeof(unsigned int));
+
+    return q;
+}
+
+// destroy Reed-Solomon codec object
+void rscodec_destroy(rscodec _q)
+{
+    liquid_free(_q->gtab);
+    liquid_free(_q->rmul);
+    liquid_free_aligned(_q->tab16);
+    liquid_free_aligned(_q->tab32);
+    liquid_free(_q->syndromes);
+    liquid_free_aligned(_q->acc);
+    liquid_free(_q->lambda);
+    liquid_free(_q->b);
+    liquid_free(_q->t);
+    liquid_free(_q->omega);
+    liquid_free(_q->loc);
+    liquid_free(_q);
+}
+
+// compute parity symbols for message (see liquid.internal.h)
+void rscodec_encode(rscodec               _q,
+                    const unsigned char * _data,
+                    unsigned char *       _parity)
+{
+    unsigned int nroots = _q->nroots;
+    unsigned int k = _q->n - nroots;
+    unsigned int i, j;
+
+    // linear feedback shift register; each feedback symbol adds one row
+    // of the product table
+    memset(_parity, 0x00, nroots);
+    for (i=0; i<k; i++) {
+        unsigned char fb = _data[i] ^ _parity[0];
+        const unsigned char * row = _q->gtab + fb*nroots;
+        for (j=0; j<nroots-1; j++)
+            _parity[j] = _parity[j+1] ^ row[j];
+        _parity[nroots-1] = row[nroots-1];
+    }
+}
+
+#if HAVE_DOTPROD_AVX || (HAVE_DOTPROD_NEON && defined(__aarch64__))
+// combine _w interleaved lane accumulators into syndromes: lane l holds
+// the symbols at positions congruent to l (mod _w), so it is scaled by
+// root^(_w-1-l), i.e. Horner's rule across the lanes
+static void rscodec_combine_lanes(rscodec      _q,
+                                  unsigned int _w)
+{
+    unsigned int j, l;
+    for (j=0; j<_q->nroots; j++) {
+        const unsigned char * mul = _q->rmul + j*256;
+        const unsigned char * acc = _q->acc  + j*_w;
+        unsigned char s = 0;
+        for (l=0; l<_w; l++)
+            s = mul[s] ^ acc[l];
+        _q->syndromes[j] = s;
+    }
+}
+#endif
+
+#if HAVE_DOTPROD_NEON && defined(__aarch64__)
+// sixteen-lane syndromes using table lookups (see rscodec.avx.c)
+static void rscodec_syndromes_neon(rscodec               _q,
+                                   const unsigned char * _r)
+{
+    unsigned int n = _q->n;
+    unsigned int z = (16 - n%16) % 16;
+    unsigned int m = (n + z) / 16;
+    unsigned char head[16];
+    memset(head, 0x00, z);
+    memcpy(head + z, _r, 16 - z);
+    const unsigned char * p = _r + 16 - z;
+
+    uint8x16_t mask = vdupq_n_u8(0x0f);
+    unsigned int j, k;
+    for (j=0; j<_q->nroots; j++) {
+        uint8x16_t tlo = vld1q_u8(_q->tab16 + 32*j);
+        uint8x16_t thi = vld1q_u8(_q->tab16 + 32*j + 16);
+        uint8x16_t a   = vld1q_u8(head);
+        for (k=1; k<m; k++) {
+            uint8x16_t lo = vqtbl1q_u8(tlo, vandq_u8(a, mask));
+            uint8x16_t hi = vqtbl1q_u8(thi, vshrq_n_u8(a, 4));
+            a = veorq_u8(veorq_u8(lo, hi), vld1q_u8(p + 16*(k-1)));
+        }
+        vst1q_u8(_q->acc + 16*j, a);
+    }
+}
+#endif
+
+// evaluate received block at each root of the generator polynomial
+static void rscodec_syndromes(rscodec               _q,
+                              const unsigned char * _r)
+{
+#if HAVE_DOTPROD_AVX
+    liquid_simd_level level = liquid_simd_get_level();
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_rs_syndromes_avx2(_q->tab32, _q->tab16, _r, _q->n, _q->nroots, _q->acc);
+        rscodec_combine_lanes(_q, 16);
+        return;
+    }
+    if (level == LIQUID_SIMD_SSE && liquid_rs_have_ssse3()) {
+        liquid_rs_syndromes_ssse3(_q->tab16, _r, _q->n, _q->nroots, _q->acc);
+        rscodec_combine_lanes(_q, 16);
+        return;
+    }
+#elif HAVE_DOTPROD_NEON && defined(__aarch64__)
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        rscodec_syndromes_neon(_q, _r);
+        rscodec_combine_lanes(_q, 16);
+        return;
+    }
+#endif
+
+    // portable: Horner's rule with a multiply table for each root
+    unsigned int i, j;
+    for (j=0; j<_q->nroots; j++) {
+        const unsigned char * mul = _q->rmul + j*256;
+        unsigned char s = 0;
+        for (i=0; i<_q->n; i++)
+            s = mul[s] ^ _r[i];
+        _q->syndromes[j] = s;
+    }
+}
+
+// correct errors in received block (see liquid.internal.h)
+int rscodec_decode(rscodec         _q,
+                   unsigned char * _block)
+{
+    unsigned int nroots = _q->nroots;
+    unsigned char * s = _q->syndromes;
+    unsigned int i, j;
+
+    rscodec_syndromes(_q, _block);
+
+    // valid codeword: nothing to correct
+    unsigned char any = 0;
+    for (j=0; j<nroots; j++)
+        any |= s[j];
+    if (any == 0)
+        return 0;
+
+    // Berlekamp-Massey: shortest LFSR generating the syndromes
+    unsigned char * c  = _q->lambda;
+    unsigned char * b  = _q->b;
+    unsigned char * t  = _q->t;
+    memset(c, 0x00, nroots+1);
+    memset(b, 0x00, nroots+1);
+    c[0] = 1;
+    b[0] = 1;
+    unsigned int  L  = 0;     // current locator degree
+    unsigned int  m  = 1;     // steps since last length change
+    unsigned char bd = 1;     // last non-zero discrepancy
+    unsigned int  n;
+    for (n=0; n<nroots; n++) {
+        unsigned char d = s[n];
+        for (i=1; i<=L; i++)
+            d ^= rscodec_mul(_q, c[i], s[n-i]);
+
+        if (d == 0) {
+            m++;
+            continue;
+        }
+
+        // c(x) -= (d/bd) x^m b(x)
+        unsigned int coef = _q->log[d] + RSCODEC_NN - _q->log[bd];
+        int grow = 2*L <= n;
+        if (grow)
+            memmove(t, c, nroots+1);
+        for (i=0; i+m<=nroots; i++) {
+            if (b[i])
+                c[i+m] ^= _q->alog[(coef + _q->log[b[i]]) % RSCODEC_NN];
+        }
+        if (grow) {
+            L  = n + 1 - L;
+            bd = d;
+            m  = 1;
+            memmove(b, t, nroots+1);
+        } else {
+            m++;
+        }
+    }
+
+    // more errors than the code can correct
+    if (2*L > nroots || c[L] == 0)
+        return -1;
+
+    // Chien search over the transmitted (unpadded) degrees; the terms
+    // c[i] alpha^(-e i) are kept in log form and stepped by alpha^-i
+    unsigned int * loc = _q->loc;
+    unsigned int   lt[nroots+1];
+    for (i=1; i<=L; i++)
+        lt[i] = _q->log[c[i]];
+    unsigned int count = 0;
+    unsigned int e;
+    for (e=0; e<_q->n && count < L; e++) {
+        unsigned char v = 1;
+        for (i=1; i<=L; i++) {
+            if (lt[i] != RSCODEC_A0) {
+                v ^= _q->alog[lt[i]];
+                lt[i] = (lt[i] + RSCODEC_NN - i) % RSCODEC_NN;
+            }
+        }
+        if (v == 0)
+            loc[count++] = e;
+    }
+
+    // roots missing or in the padded region
+    if (count != L)
+        return -1;
+
+    // error evaluator: omega(x) = s(x) lambda(x) mod x^L
+    unsigned char * omega = _q->omega;
+    for (i=0; i<L; i++) {
+        unsigned char v = 0;
+        for (j=0; j<=i; j++)
+            v ^= rscodec_mul(_q, c[j], s[i-j]);
+        omega[i] = v;
+    }
+
+    // Forney: error magnitude at X = alpha^e is
+    //   X^(1-fcs) omega(1/X) / lambda'(1/X)
+    unsigned char y[nroots];
+    for (j=0; j<count; j++) {
+        unsigned int xinv = (RSCODEC_NN - loc[j]) % RSCODEC_NN;   // log(1/X)
+        unsigned char num = 0;
+        unsigned char den = 0;
+        for (i=0; i<L; i++) {
+            if (omega[i])
+                num ^= _q->alog[(_q->log[omega[i]] + i*xinv) % RSCODEC_NN];
+        }
+        for (i=1; i<=L; i+=2) {
+            if (c[i])
+                den ^= _q->alog[(_q->log[c[i]] + (i-1)*xinv) % RSCODEC_NN];
+        }
+        if (den == 0)
+            return -1;
+        if (num == 0) {
+            y[j] = 0;
+            continue;
+        }
+        unsigned int ly = _q->log[num] + RSCODEC_NN - _q->log[den]
+                        + (loc[j]*(RSCODEC_NN + 1 - _q->fcs)) % RSCODEC_NN;
+        y[j] = _q->alog[ly % RSCODEC_NN];
+    }
+
+    // apply corrections; degree e is symbol n-1-e of the block
+    for (j=0; j<count; j++)
+        _block[_q->n - 1 - loc[j]] ^= y[j];
+
+    return count;
+}
+
@@ -77,10 +77,18 @@ int fec_sumproduct(unsigned int    _m,
         Lc[i] = _LLR[i];
         //Lc[i] = 2.0f * _y[i] / (sigma*sigma);
 
+    // compressed copy of parity check matrix for row/column walks
+    smatrixb_csr H = smatrixb_csr_create(_H);
+
+    unsigned short int * idx;
+    unsigned int num_idx;
+    unsigned int k;
+    for (j=0; j<_m*_n; j++)
+        Lq[j] = 0.0f;
     for (j=0; j<_m; j++) {
-        for (i=0; i<_n; i++) {
-            Lq[j*_n+i] = smatrixb_get(_H,j,i) ? Lc[i] : 0.0f;
-        }
+        num_idx = smatrixb_csr_row(H, j, &idx);
+        for (k=0; k<num_idx; k++)
+            Lq[j*_n+idx[k]] = Lc[idx[k]];
     }
 
 #if DEBUG_SUMPRODUCT
@@ -98,7 +106,7 @@ int fec_sumproduct(unsigned int    _m,
 
         // step sum-product algorithm
         //parity_pass = fec_sumproduct_step(_H,_m,_n,_c_hat,Lq,Lr,Lc,LQ,parity);
-        parity_pass = fec_sumproduct_step(_m,_n,_H,_c_hat,Lq,Lr,Lc,LQ,parity);
+        parity_pass = fec_sumproduct_step(_m,_n,H,_c_hat,Lq,Lr,Lc,LQ,parity);
 
         // update...
         num_iterations++;
@@ -106,16 +114,17 @@ int fec_sumproduct(unsigned int    _m,
             continue_running = 0;
     }
 
+    smatrixb_csr_destroy(H);
     return parity_pass;
 }
 
 // sum-product algorithm, returns 1 if parity checks, 0 otherwise
 //  _m      :   rows
 //  _n      :   cols
-//  _H      :   sparse binary parity check matrix [size: _m x _n]
+//  _H      :   compressed parity check matrix [size: _m x _n]
 //  _c_hat  :   estimated transmitted signal [size: _n x 1]
 //
-// internal state arrays
+// internal state arrays (only entries where _H is non-zero are used)
 //  _Lq     :   [size: _m x _n]
 //  _Lr     :   [size: _m x _n]
 //  _Lc     :   [size: _n x 1]
@@ -123,7 +132,7 @@ int fec_sumproduct(unsigned int    _m,
 //  _parity :   _H * _c_hat [size: _m x 1]
 int fec_sumproduct_step(unsigned int    _m,
                         unsigned int    _n,
-                        smatrixb        _H,
+                        smatrixb_csr    _H,
                         unsigned char * _c_hat,
                         float *         _Lq,
                         float *         _Lr,
@@ -133,25 +142,29 @@ int fec_sumproduct_step(unsigned int    _m,
 {
     unsigned int i;
     unsigned int j;
-    unsigned int ip;
-    unsigned int jp;
+    unsigned int k;
+    unsigned int kp;
+    unsigned short int * idx;
+    unsigned int num_idx;
     float alpha_prod;
     float phi_sum;
     int parity_pass;
 
-    // compute Lr
-    for (i=0; i<_n; i++) {
-        for (j=0; j<_m; j++) {
+    // compute Lr on the non-zero entries of each check (row)
+    for (j=0; j<_m; j++) {
+        num_idx = smatrixb_csr_row(_H, j, &idx);
+        for (k=0; k<num_idx; k++) {
+            i = idx[k];
             alpha_prod = 1.0f;
             phi_sum    = 0.0f;
-            for (ip=0; ip<_n; ip++) {
-                //if (_H[j*_n+ip]==1 && i != ip) {
-                if (smatrixb_get(_H,j,ip)==1 && i != ip) {
-                    float alpha = _Lq[j*_n+ip] > 0.0f ? 1.0f : -1.0f;
-                    float beta  = fabsf(_Lq[j*_n+ip]);
-                    phi_sum += sumproduct_phi(beta);
-                    alpha_prod *= alpha;
-                }
+            for (kp=0; kp<num_idx; kp++) {
+                if (kp == k)
+                    continue;
+                float Lq = _Lq[j*_n+idx[kp]];
+                float alpha = Lq > 0.0f ? 1.0f : -1.0f;
+                float beta  = fabsf(Lq);
+                phi_sum += sumproduct_phi(beta);
+                alpha_prod *= alpha;
             }
             _Lr[j*_n+i] = alpha_prod * sumproduct_phi(phi_sum);
         }
@@ -165,16 +178,18 @@ int fec_sumproduct_step(unsigned int    _m,
     matrixf_print(_Lr,_m,_n);
 #endif
 
-    // compute next iteration of Lq
+    // compute next iteration of Lq on the non-zero entries of each
+    // variable (column)
     for (i=0; i<_n; i++) {
-        for (j=0; j<_m; j++) {
+        num_idx = smatrixb_csr_col(_H, i, &idx);
+        for (k=0; k<num_idx; k++) {
+            j = idx[k];
             // initialize with LLR
             _Lq[j*_n+i] = _Lc[i];
 
-            for (jp=0; jp<_m; jp++) {
-                //if (_H[jp*_n+i]==1 && j != jp)
-                if (smatrixb_get(_H,jp,i)==1 && j != jp)
-                    _Lq[j*_n+i] += _Lr[jp*_n+i];
+            for (kp=0; kp<num_idx; kp++) {
+                if (kp != k)
+                    _Lq[j*_n+i] += _Lr[idx[kp]*_n+i];
             }
         }
     }
@@ -188,11 +203,9 @@ int fec_sumproduct_step(unsigned int    _m,
     for (i=0; i<_n; i++) {
         _LQ[i] = _Lc[i];  // initialize with LLR value
 
-        for (j=0; j<_m; j++) {
-            //if (_H[j*_n+i]==1)
-            if (smatrixb_get(_H,j,i)==1)
-                _LQ[i] += _Lr[j*_n+i];
-        }
+        num_idx = smatrixb_csr_col(_H, i, &idx);
+        for (k=0; k<num_idx; k++)
+            _LQ[i] += _Lr[idx[k]*_n+i];
     }
 
 #if DEBUG_SUMPRODUCT
@@ -205,7 +218,7 @@ int fec_sumproduct_step(unsigned int    _m,
         _c_hat[i] = _LQ[i] < 0.0f ? 1 : 0;
 
     // compute parity check: p = H*c_hat
-    smatrixb_vmul(_H, _c_hat, _parity);
+    smatrixb_csr_vmul(_H, _c_hat, _parity);
 
     // check parity
     parity_pass = 1;
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// viterbi.c : soft-decision viterbi decoder for rate 1/R convolutional
+//             codes
+//
+// The path and branch metrics, decision layout and tie-breaking follow
+// the portable decoders from Phil Karn's libfec, so decoded output is
+// independent of the add-compare-select kernel selected at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+struct viterbi_s {
+    unsigned int K;             // constraint length
+    unsigned int R;             // inverse rate
+    unsigned int num_states;    // number of states, 2^(K-1)
+    unsigned int num_words;     // decision words per step
+    unsigned int num_steps;     // maximum steps (data + tail bits)
+    unsigned int step;          // current step
+
+    uint32_t * branchtab;       // expected symbols [R x num_states/2]
+    uint32_t * metrics0;        // path metrics [num_states]
+    uint32_t * metrics1;        // path metrics [num_states]
+    uint32_t * decisions;       // decision bits [num_steps x num_words]
+};
+
+// create viterbi decoder object (see liquid.internal.h)
+viterbi viterbi_create(unsigned int _K,
+                       unsigned int _R,
+                       int *        _poly,
+                       unsigned int _num_bits)
+{
+    // validate input
+    if (_K < 3 || _K > 15) {
+        fprintf(stderr,"error: viterbi_create(), constraint length must be in [3,15]\n");
+        exit(1);
+    } else if (_R < 2 || _R > 8) {
+        fprintf(stderr,"error: viterbi_create(), inverse rate must be in [2,8]\n");
+        exit(1);
+    }
+    unsigned int r;
+    for (r=0; r<_R; r++) {
+        unsigned int p = (unsigned int)_poly[r];
+        if ( !(p & 1) || !(p & (1u<<(_K-1))) || (p >> _K) ) {
+            fprintf(stderr,"error: viterbi_create(), polynomial 0x%x invalid for K=%u\n", p, _K);
+            exit(1);
+        }
+    }
+
+    viterbi q = (viterbi) liquid_malloc(sizeof(struct viterbi_s));
+    q->K          = _K;
+    q->R          = _R;
+    q->num_states = 1u << (_K-1);
+    q->num_words  = (q->num_states + 31) / 32;
+    q->num_steps  = _num_bits + _K - 1;
+
+    // expected symbol for each branch (0 or 255), indexed by the
+    // butterfly feeding states 2i and 2i+1
+    unsigned int h = q->num_states / 2;
+    q->branchtab = (uint32_t*) liquid_malloc_aligned(_R*h*sizeof(uint32_t));
+    unsigned int i;
+    for (r=0; r<_R; r++) {
+        for (i=0; i<h; i++)
+            q->branchtab[r*h+i] = liquid_count_ones_mod2((2*i) & _poly[r]) ? 255 : 0;
+    }
+
+    // allocate path metrics and decisions
+    q->metrics0  = (uint32_t*) liquid_malloc_aligned(q->num_states*sizeof(uint32_t));
+    q->metrics1  = (uint32_t*) liquid_malloc_aligned(q->num_states*sizeof(uint32_t));
+    q->decisions = (uint32_t*) liquid_malloc(q->num_steps*q->num_words*sizeof(uint32_t));
+
+    viterbi_init(q, 0);
+    return q;
+}
+
+// destroy viterbi decoder object
+void viterbi_destroy(viterbi _q)
+{
+    liquid_free_aligned(_q->branchtab);
+    liquid_free_aligned(_q->metrics0);
+    liquid_free_aligned(_q->metrics1);
+    liquid_free(_q->decisions);
+    liquid_free(_q);
+}
+
+// reset path metrics, favoring starting state _state
+void viterbi_init(viterbi      _q,
+                  unsigned int _state)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_states; i++)
+        _q->metrics0[i] = 63;
+    _q->metrics0[_state & (_q->num_states-1)] = 0;
+    _q->step = 0;
+}
+
+// run add-compare-select over _n decoded bits
+void viterbi_update_blk(viterbi         _q,
+                        unsigned char * _syms,
+                        unsigned int    _n)
+{
+    if (_q->step + _n > _q->num_steps) {
+        fprintf(stderr,"error: viterbi_update_blk(), decision storage exceeded\n");
+        exit(1);
+    }
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        uint32_t * d = _q->decisions + _q->step*_q->num_words;
+        memset(d, 0x00, _q->num_words*sizeof(uint32_t));
+        liquid_viterbi_acs(_q->metrics0, _q->metrics1, _q->branchtab,
+                           _syms + i*_q->R, _q->R, _q->num_states, d);
+
+        // swap metrics
+        uint32_t * tmp = _q->metrics0;
+        _q->metrics0 = _q->metrics1;
+        _q->metrics1 = tmp;
+        _q->step++;
+    }
+}
+
+// trace back from ending state, writing _n bits (msb first)
+void viterbi_chainback(viterbi         _q,
+                       unsigned char * _data,
+                       unsigned int    _n,
+                       unsigned int    _endstate)
+{
+    unsigned int K = _q->K;
+    if (_n + K - 1 > _q->step) {
+        fprintf(stderr,"error: viterbi_chainback(), requested %u bits but only %u decoded\n",
+                _n, _q->step < K-1 ? 0 : _q->step - (K-1));
+        exit(1);
+    }
+
+    memset(_data, 0x00, (_n+7)/8);
+
+    // the decision at step t recovers the oldest bit in the register
+    // of the surviving predecessor, i.e. data bit t-K+1; start at the
+    // last step so that the K-1 tail bits are skipped
+    unsigned int s = _endstate & (_q->num_states-1);
+    unsigned int t;
+    for (t=_n+K-1; t>K-1; t--) {
+        const uint32_t * d = _q->decisions + (t-1)*_q->num_words;
+        unsigned int k = (d[s/32] >> (s%32)) & 1;
+        unsigned int j = t-K;
+        _data[j/8] |= k << (7 - (j%8));
+        s = (s >> 1) | (k << (K-2));
+    }
+}
+
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// viterbi_kernels.avx.c : viterbi decoder add-compare-select (x86 AVX2)
+//
+// This kernel is compiled with a per-function target attribute and is
+// selected at run time by the dispatch in viterbi_kernels.mmx.c.
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// eight butterflies per iteration; the in-lane unpack is followed by a
+// cross-lane permute so that sixteen consecutive states are stored
+__attribute__((target("avx2")))
+void liquid_viterbi_acs_avx2(uint32_t *            _old,
+                             uint32_t *            _new,
+                             const uint32_t *      _branchtab,
+                             const unsigned char * _syms,
+                             unsigned int          _R,
+                             unsigned int          _num_states,
+                             uint32_t *            _d)
+{
+    unsigned int h  = _num_states / 2;
+    unsigned int t  = h & ~7u;
+    __m256i mx   = _mm256_set1_epi32(255*_R);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i sym[8];
+    unsigned int i, r;
+    for (r=0; r<_R; r++)
+        sym[r] = _mm256_set1_epi32(_syms[r]);
+
+    for (i=0; i<t; i+=8) {
+        __m256i metric = zero;
+        for (r=0; r<_R; r++) {
+            __m256i b = _mm256_loadu_si256((const __m256i*)(_branchtab + r*h + i));
+            metric = _mm256_add_epi32(metric, _mm256_xor_si256(b, sym[r]));
+        }
+        __m256i mc = _mm256_sub_epi32(mx, metric);
+        __m256i a  = _mm256_loadu_si256((const __m256i*)(_old + i));
+        __m256i b  = _mm256_loadu_si256((const __m256i*)(_old + i + h));
+
+        // even states: 2i
+        __m256i m0 = _mm256_add_epi32(a, metric);
+        __m256i m1 = _mm256_add_epi32(b, mc);
+        __m256i d0 = _mm256_cmpgt_epi32(_mm256_sub_epi32(m0, m1), zero);
+        __m256i s0 = _mm256_blendv_epi8(m0, m1, d0);
+
+        // odd states: 2i+1
+        m0 = _mm256_add_epi32(a, mc);
+        m1 = _mm256_add_epi32(b, metric);
+        __m256i d1 = _mm256_cmpgt_epi32(_mm256_sub_epi32(m0, m1), zero);
+        __m256i s1 = _mm256_blendv_epi8(m0, m1, d1);
+
+        __m256i lo = _mm256_unpacklo_epi32(s0, s1);
+        __m256i hi = _mm256_unpackhi_epi32(s0, s1);
+        _mm256_storeu_si256((__m256i*)(_new + 2*i),     _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i*)(_new + 2*i + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+
+        lo = _mm256_unpacklo_epi32(d0, d1);
+        hi = _mm256_unpackhi_epi32(d0, d1);
+        unsigned int b0 = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_permute2x128_si256(lo, hi, 0x20)));
+        unsigned int b1 = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_permute2x128_si256(lo, hi, 0x31)));
+        _d[(2*i)/32] |= (uint32_t)(b0 | (b1 << 8)) << ((2*i)&31);
+    }
+
+    // remaining butterflies
+    uint32_t m = 255*_R;
+    for (i=t; i<h; i++) {
+        uint32_t metric = 0;
+        for (r=0; r<_R; r++)
+            metric += _branchtab[r*h+i] ^ _syms[r];
+
+        uint32_t m0 = _old[i]   + metric;
+        uint32_t m1 = _old[i+h] + (m - metric);
+        uint32_t decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i] = decision ? m1 : m0;
+        _d[(2*i)/32] |= decision << ((2*i)&31);
+
+        m0 = _old[i]   + (m - metric);
+        m1 = _old[i+h] + metric;
+        decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i+1] = decision ? m1 : m0;
+        _d[(2*i+1)/32] |= decision << ((2*i+1)&31);
+    }
+}
+
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// viterbi_kernels.c : viterbi decoder add-compare-select (portable C)
+//
+
+#include "liquid.internal.h"
+
+// advance path metrics one step (see liquid.internal.h); each butterfly
+// i joins states i and i+S/2 to states 2i and 2i+1
+void liquid_viterbi_acs(uint32_t *            _old,
+                        uint32_t *            _new,
+                        const uint32_t *      _branchtab,
+                        const unsigned char * _syms,
+                        unsigned int          _R,
+                        unsigned int          _num_states,
+                        uint32_t *            _d)
+{
+    unsigned int h  = _num_states / 2;
+    uint32_t     mx = 255*_R;
+    unsigned int i, r;
+    for (i=0; i<h; i++) {
+        uint32_t metric = 0;
+        for (r=0; r<_R; r++)
+            metric += _branchtab[r*h+i] ^ _syms[r];
+
+        uint32_t m0 = _old[i]   + metric;
+        uint32_t m1 = _old[i+h] + (mx - metric);
+        uint32_t decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i] = decision ? m1 : m0;
+        _d[(2*i)/32] |= decision << ((2*i)&31);
+
+        m0 = _old[i]   + (mx - metric);
+        m1 = _old[i+h] + metric;
+        decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i+1] = decision ? m1 : m0;
+        _d[(2*i+1)/32] |= decision << ((2*i+1)&31);
+    }
+}
+
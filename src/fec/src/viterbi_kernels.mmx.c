@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// viterbi_kernels.mmx.c : viterbi decoder add-compare-select (SSE2 with
+//                         AVX2 dispatch)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+// portable butterflies [_i0,_num_states/2) (dispatch fallback and tail)
+static void liquid_viterbi_acs_portable(uint32_t *            _old,
+                                        uint32_t *            _new,
+                                        const uint32_t *      _branchtab,
+                                        const unsigned char * _syms,
+                                        unsigned int          _R,
+                                        unsigned int          _num_states,
+                                        uint32_t *            _d,
+                                        unsigned int          _i0)
+{
+    unsigned int h  = _num_states / 2;
+    uint32_t     mx = 255*_R;
+    unsigned int i, r;
+    for (i=_i0; i<h; i++) {
+        uint32_t metric = 0;
+        for (r=0; r<_R; r++)
+            metric += _branchtab[r*h+i] ^ _syms[r];
+
+        uint32_t m0 = _old[i]   + metric;
+        uint32_t m1 = _old[i+h] + (mx - metric);
+        uint32_t decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i] = decision ? m1 : m0;
+        _d[(2*i)/32] |= decision << ((2*i)&31);
+
+        m0 = _old[i]   + (mx - metric);
+        m1 = _old[i+h] + metric;
+        decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i+1] = decision ? m1 : m0;
+        _d[(2*i+1)/32] |= decision << ((2*i+1)&31);
+    }
+}
+
+#if HAVE_EMMINTRIN_H
+// four butterflies per iteration; the even and odd survivors and their
+// decisions are interleaved to yield eight consecutive states
+static void liquid_viterbi_acs_sse2(uint32_t *            _old,
+                                    uint32_t *            _new,
+                                    const uint32_t *      _branchtab,
+                                    const unsigned char * _syms,
+                                    unsigned int          _R,
+                                    unsigned int          _num_states,
+                                    uint32_t *            _d)
+{
+    unsigned int h = _num_states / 2;
+    unsigned int t = h & ~3u;
+    __m128i mx   = _mm_set1_epi32(255*_R);
+    __m128i zero = _mm_setzero_si128();
+    __m128i sym[8];
+    unsigned int i, r;
+    for (r=0; r<_R; r++)
+        sym[r] = _mm_set1_epi32(_syms[r]);
+
+    for (i=0; i<t; i+=4) {
+        __m128i metric = zero;
+        for (r=0; r<_R; r++) {
+            __m128i b = _mm_loadu_si128((const __m128i*)(_branchtab + r*h + i));
+            metric = _mm_add_epi32(metric, _mm_xor_si128(b, sym[r]));
+        }
+        __m128i mc = _mm_sub_epi32(mx, metric);
+        __m128i a  = _mm_loadu_si128((const __m128i*)(_old + i));
+        __m128i b  = _mm_loadu_si128((const __m128i*)(_old + i + h));
+
+        // even states: 2i
+        __m128i m0 = _mm_add_epi32(a, metric);
+        __m128i m1 = _mm_add_epi32(b, mc);
+        __m128i d0 = _mm_cmpgt_epi32(_mm_sub_epi32(m0, m1), zero);
+        __m128i s0 = _mm_or_si128(_mm_and_si128(d0, m1), _mm_andnot_si128(d0, m0));
+
+        // odd states: 2i+1
+        m0 = _mm_add_epi32(a, mc);
+        m1 = _mm_add_epi32(b, metric);
+        __m128i d1 = _mm_cmpgt_epi32(_mm_sub_epi32(m0, m1), zero);
+        __m128i s1 = _mm_or_si128(_mm_and_si128(d1, m1), _mm_andnot_si128(d1, m0));
+
+        _mm_storeu_si128((__m128i*)(_new + 2*i),     _mm_unpacklo_epi32(s0, s1));
+        _mm_storeu_si128((__m128i*)(_new + 2*i + 4), _mm_unpackhi_epi32(s0, s1));
+        unsigned int lo = _mm_movemask_ps(_mm_castsi128_ps(_mm_unpacklo_epi32(d0, d1)));
+        unsigned int hi = _mm_movemask_ps(_mm_castsi128_ps(_mm_unpackhi_epi32(d0, d1)));
+        _d[(2*i)/32] |= (uint32_t)(lo | (hi << 4)) << ((2*i)&31);
+    }
+    liquid_viterbi_acs_portable(_old, _new, _branchtab, _syms, _R, _num_states, _d, t);
+}
+#endif
+
+// advance path metrics one step (see liquid.internal.h)
+void liquid_viterbi_acs(uint32_t *            _old,
+                        uint32_t *            _new,
+                        const uint32_t *      _branchtab,
+                        const unsigned char * _syms,
+                        unsigned int          _R,
+                        unsigned int          _num_states,
+                        uint32_t *            _d)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_viterbi_acs_avx2(_old, _new, _branchtab, _syms, _R, _num_states, _d);
+        return;
+    }
+#endif
+#if HAVE_EMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_viterbi_acs_sse2(_old, _new, _branchtab, _syms, _R, _num_states, _d);
+        return;
+    }
+#endif
+    liquid_viterbi_acs_portable(_old, _new, _branchtab, _syms, _R, _num_states, _d, 0);
+}
+
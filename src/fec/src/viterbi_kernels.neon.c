@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// viterbi_kernels.neon.c : viterbi decoder add-compare-select (ARM Neon)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+// advance path metrics one step (see liquid.internal.h); four
+// butterflies per iteration, with the even and odd survivors and their
+// decisions zipped to yield eight consecutive states
+void liquid_viterbi_acs(uint32_t *            _old,
+                        uint32_t *            _new,
+                        const uint32_t *      _branchtab,
+                        const unsigned char * _syms,
+                        unsigned int          _R,
+                        unsigned int          _num_states,
+                        uint32_t *            _d)
+{
+    unsigned int h  = _num_states / 2;
+    uint32_t     mx = 255*_R;
+    unsigned int i = 0;
+    unsigned int r;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        static const uint32_t bits[4] = {1, 2, 4, 8};
+        uint32x4_t vbits = vld1q_u32(bits);
+        uint32x4_t vmx   = vdupq_n_u32(mx);
+        int32x4_t  zero  = vdupq_n_s32(0);
+        unsigned int t = h & ~3u;
+        for (; i<t; i+=4) {
+            uint32x4_t metric = vdupq_n_u32(0);
+            for (r=0; r<_R; r++) {
+                uint32x4_t b = vld1q_u32(_branchtab + r*h + i);
+                metric = vaddq_u32(metric, veorq_u32(b, vdupq_n_u32(_syms[r])));
+            }
+            uint32x4_t mc = vsubq_u32(vmx, metric);
+            uint32x4_t a  = vld1q_u32(_old + i);
+            uint32x4_t b  = vld1q_u32(_old + i + h);
+
+            // even states: 2i
+            uint32x4_t m0 = vaddq_u32(a, metric);
+            uint32x4_t m1 = vaddq_u32(b, mc);
+            uint32x4_t d0 = vcgtq_s32(vreinterpretq_s32_u32(vsubq_u32(m0, m1)), zero);
+            uint32x4_t s0 = vbslq_u32(d0, m1, m0);
+
+            // odd states: 2i+1
+            m0 = vaddq_u32(a, mc);
+            m1 = vaddq_u32(b, metric);
+            uint32x4_t d1 = vcgtq_s32(vreinterpretq_s32_u32(vsubq_u32(m0, m1)), zero);
+            uint32x4_t s1 = vbslq_u32(d1, m1, m0);
+
+            uint32x4x2_t s = vzipq_u32(s0, s1);
+            vst1q_u32(_new + 2*i,     s.val[0]);
+            vst1q_u32(_new + 2*i + 4, s.val[1]);
+
+            // collapse decision masks to bits
+            uint32x4x2_t d = vzipq_u32(d0, d1);
+            uint32x4_t   v = vorrq_u32(vandq_u32(d.val[0], vbits),
+                                       vshlq_n_u32(vandq_u32(d.val[1], vbits), 4));
+            uint32x2_t   p = vorr_u32(vget_low_u32(v), vget_high_u32(v));
+            uint32_t     m = vget_lane_u32(p, 0) | vget_lane_u32(p, 1);
+            _d[(2*i)/32] |= m << ((2*i)&31);
+        }
+    }
+
+    // portable butterflies (fallback and tail)
+    for (; i<h; i++) {
+        uint32_t metric = 0;
+        for (r=0; r<_R; r++)
+            metric += _branchtab[r*h+i] ^ _syms[r];
+
+        uint32_t m0 = _old[i]   + metric;
+        uint32_t m1 = _old[i+h] + (mx - metric);
+        uint32_t decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i] = decision ? m1 : m0;
+        _d[(2*i)/32] |= decision << ((2*i)&31);
+
+        m0 = _old[i]   + (mx - metric);
+        m1 = _old[i+h] + metric;
+        decision = (int32_t)(m0 - m1) > 0;
+        _new[2*i+1] = decision ? m1 : m0;
+        _d[(2*i+1)/32] |= decision << ((2*i+1)&31);
+    }
+}
+
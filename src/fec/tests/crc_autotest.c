@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "autotest/autotest.h"
@@ -118,5 +119,73 @@ void autotest_crc8()     { validate_crc(LIQUID_CRC_8,           16); }
 void autotest_crc16()    { validate_crc(LIQUID_CRC_16,          64); }
 void autotest_crc24()    { validate_crc(LIQUID_CRC_24,          64); }
 void autotest_crc32()    { validate_crc(LIQUID_CRC_32,          64); }
+void autotest_crc32c()   { validate_crc(LIQUID_CRC_32C,         64); }
+
+// 
+// AUTOTEST : standard check values ("123456789")
+//
+void autotest_crc_check_values()
+{
+    unsigned char msg[9] = {'1','2','3','4','5','6','7','8','9'};
+    CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_32,  msg, 9), 0xcbf43926);
+    CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_32C, msg, 9), 0xe3069283);
+    CONTEND_EQUALITY(crc_get_length(LIQUID_CRC_32C), 4);
+    CONTEND_EQUALITY(liquid_getopt_str2crc("crc32c"), LIQUID_CRC_32C);
+}
+
+// autotest helper function: bit-serial crc key (32-bit register with
+// reflected polynomial, as the original implementation)
+unsigned int crc_autotest_bitwise(unsigned int    _poly,
+                                  unsigned int    _mask,
+                                  unsigned char * _msg,
+                                  unsigned int    _n)
+{
+    unsigned int i, j, mask, key=~0;
+    for (i=0; i<_n; i++) {
+        key ^= _msg[i];
+        for (j=0; j<8; j++) {
+            mask = -(key & 1);
+            key = (key>>1) ^ (_poly & mask);
+        }
+    }
+    return (~key) & _mask;
+}
+
+// 
+// AUTOTEST : table-driven and hardware keys match bit-serial method for
+//            all lengths and alignments, with and without SIMD dispatch
+//
+void autotest_crc_slice8()
+{
+    unsigned char buf[300];
+    unsigned int i;
+    for (i=0; i<300; i++)
+        buf[i] = rand() & 0xff;
+
+    liquid_simd_level level = liquid_simd_get_level();
+    unsigned int pass;
+    for (pass=0; pass<2; pass++) {
+        if (pass == 1)
+            liquid_simd_set_level(LIQUID_SIMD_PORTABLE);
+
+        unsigned int n, offset;
+        for (offset=0; offset<8; offset++) {
+            for (n=0; n<=290; n += (n < 80 ? 1 : 13)) {
+                unsigned char * m = buf + offset;
+                CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_8, m, n),
+                                 crc_autotest_bitwise(liquid_reverse_byte(0x07), 0xff, m, n));
+                CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_16, m, n),
+                                 crc_autotest_bitwise(liquid_reverse_uint16(0x8005), 0xffff, m, n));
+                CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_24, m, n),
+                                 crc_autotest_bitwise(liquid_reverse_uint24(0x5D6DCB), 0xffffff, m, n));
+                CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_32, m, n),
+                                 crc_autotest_bitwise(liquid_reverse_uint32(0x04C11DB7), 0xffffffff, m, n));
+                CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_32C, m, n),
+                                 crc_autotest_bitwise(liquid_reverse_uint32(0x1EDC6F41), 0xffffffff, m, n));
+            }
+        }
+    }
+    liquid_simd_set_level(level);
+}
 
 
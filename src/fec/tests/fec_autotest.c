@@ -28,30 +28,6 @@
 // Helper function to keep code base small
 void fec_test_codec(fec_scheme _fs, unsigned int _n, void * _opts)
 {
-#if !LIBFEC_ENABLED
-    if ( _fs == LIQUID_FEC_CONV_V27    ||
-         _fs == LIQUID_FEC_CONV_V29    ||
-         _fs == LIQUID_FEC_CONV_V39    ||
-         _fs == LIQUID_FEC_CONV_V615   ||
-         _fs == LIQUID_FEC_CONV_V27P23 ||
-         _fs == LIQUID_FEC_CONV_V27P34 ||
-         _fs == LIQUID_FEC_CONV_V27P45 ||
-         _fs == LIQUID_FEC_CONV_V27P56 ||
-         _fs == LIQUID_FEC_CONV_V27P67 ||
-         _fs == LIQUID_FEC_CONV_V27P78 ||
-         _fs == LIQUID_FEC_CONV_V29P23 ||
-         _fs == LIQUID_FEC_CONV_V29P34 ||
-         _fs == LIQUID_FEC_CONV_V29P45 ||
-         _fs == LIQUID_FEC_CONV_V29P56 ||
-         _fs == LIQUID_FEC_CONV_V29P67 ||
-         _fs == LIQUID_FEC_CONV_V29P78 ||
-         _fs == LIQUID_FEC_RS_M8)
-    {
-        AUTOTEST_WARN("convolutional, Reed-Solomon codes unavailable (install libfec)\n");
-        return;
-    }
-#endif
-
     // generate fec object
     fec q = fec_create(_fs,_opts);
 
@@ -129,4 +105,59 @@ void autotest_fec_v29p78()  { fec_test_codec(LIQUID_FEC_CONV_V29P78,   64, NULL)
 // Reed-Solomon block codes
 void autotest_fec_rs8()     { fec_test_codec(LIQUID_FEC_RS_M8,         64, NULL); }
 
+// low-density parity-check codes
+void autotest_fec_ldpc12()  { fec_test_codec(LIQUID_FEC_LDPC_R12,      64, NULL); }
+void autotest_fec_ldpc23()  { fec_test_codec(LIQUID_FEC_LDPC_R23,      64, NULL); }
+void autotest_fec_ldpc34()  { fec_test_codec(LIQUID_FEC_LDPC_R34,      64, NULL); }
+
+
+
+// 
+// AUTOTESTS: syndrome counts of uncorrectable codewords
+//
+void fec_test_count_uncorrectable(fec_scheme _fs, unsigned int _n)
+{
+    fec q = fec_create(_fs, NULL);
+    unsigned int n_enc = fec_get_enc_msg_length(_fs, _n);
+    unsigned char msg[_n];
+    unsigned char msg_enc[n_enc];
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    fec_encode(q, _n, msg, msg_enc);
+
+    // valid codewords, and a correctable error
+    unsigned int num_codewords = 0;
+    CONTEND_EQUALITY(fec_count_uncorrectable(_fs, _n, msg_enc, &num_codewords), 0);
+    CONTEND_GREATER_THAN(num_codewords, 0);
+    msg_enc[0] ^= 0x01;
+    CONTEND_EQUALITY(fec_count_uncorrectable(_fs, _n, msg_enc, NULL), 0);
+
+    // double error in first codeword is detected
+    msg_enc[0] ^= 0x02;
+    if (_fs != LIQUID_FEC_GOLAY2412)
+        CONTEND_EQUALITY(fec_count_uncorrectable(_fs, _n, msg_enc, NULL), 1);
+
+    // random data: a large fraction of codewords is uncorrectable
+    for (i=0; i<n_enc; i++)
+        msg_enc[i] = rand() & 0xff;
+    unsigned int num_uncorrectable = fec_count_uncorrectable(_fs, _n, msg_enc, &num_codewords);
+    CONTEND_GREATER_THAN((float)num_uncorrectable, 0.2f*num_codewords);
+
+    fec_destroy(q);
+}
+
+void autotest_fec_count_uncorrectable_h84()        { fec_test_count_uncorrectable(LIQUID_FEC_HAMMING84,  200); }
+void autotest_fec_count_uncorrectable_g2412()      { fec_test_count_uncorrectable(LIQUID_FEC_GOLAY2412,  200); }
+void autotest_fec_count_uncorrectable_secded2216() { fec_test_count_uncorrectable(LIQUID_FEC_SECDED2216, 201); }
+void autotest_fec_count_uncorrectable_secded3932() { fec_test_count_uncorrectable(LIQUID_FEC_SECDED3932, 202); }
+void autotest_fec_count_uncorrectable_secded7264() { fec_test_count_uncorrectable(LIQUID_FEC_SECDED7264, 203); }
 
+// schemes without error detection check no codewords
+void autotest_fec_count_uncorrectable_none()
+{
+    unsigned char msg_enc[256] = {0};
+    unsigned int num_codewords = 1;
+    CONTEND_EQUALITY(fec_count_uncorrectable(LIQUID_FEC_CONV_V27, 64, msg_enc, &num_codewords), 0);
+    CONTEND_EQUALITY(num_codewords, 0);
+}
@@ -105,3 +105,40 @@ void autotest_golay2412_codec()
     }
 }
 
+
+//
+// AUTOTEST: Golay(24,12) codec, all error patterns of weight 3 or less
+//
+void autotest_golay2412_codec_exhaustive()
+{
+    // total error patterns: 1 + 24 + nchoosek(24,2) + nchoosek(24,3) = 2325
+    unsigned int i, j, k;
+    unsigned int num_patterns = 0;
+
+    for (i=0; i<=24; i++) {
+        for (j=i; j<=24; j++) {
+            for (k=j; k<=24; k++) {
+                // bit positions equal to 24 denote no error; skip
+                // duplicate positions to enumerate each pattern once
+                if ((i<24 && i==j) || (j<24 && j==k))
+                    continue;
+
+                unsigned int e = ((1<<i) | (1<<j) | (1<<k)) & 0xffffff;
+
+                // encode random symbol, add errors, and decode
+                unsigned int sym_org = rand() % (1<<12);
+                unsigned int sym_enc = fec_golay2412_encode_symbol(sym_org);
+                unsigned int sym_dec = fec_golay2412_decode_symbol(sym_enc ^ e);
+
+                CONTEND_EQUALITY(sym_org, sym_dec);
+                num_patterns++;
+            }
+        }
+    }
+    CONTEND_EQUALITY(num_patterns, 2325);
+
+    // encoder must match generator matrix for every message
+    for (i=0; i<(1<<12); i++)
+        CONTEND_EQUALITY(fec_golay2412_encode_symbol(i),
+                         golay2412_matrix_mul(i, golay2412_Gt, 24));
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// copy _n bits from _src (offset _i0) to _dst (offset _j0), msb first
+static void fec_ldpc_test_copy_bits(const unsigned char * _src,
+                                    unsigned int          _i0,
+                                    unsigned char *       _dst,
+                                    unsigned int          _j0,
+                                    unsigned int          _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        unsigned int b = (_src[(_i0+i)>>3] >> (7-((_i0+i)&7))) & 1;
+        unsigned int j = _j0 + i;
+        _dst[j>>3] = (_dst[j>>3] & ~(0x80 >> (j&7))) | (b << (7-(j&7)));
+    }
+}
+
+// create codec for scheme
+static ldpccodec fec_ldpc_test_create(fec_scheme _fs)
+{
+    switch (_fs) {
+    case LIQUID_FEC_LDPC_R12: return ldpccodec_create(fec_ldpc_r12_base, 12, 24, 27);
+    case LIQUID_FEC_LDPC_R23: return ldpccodec_create(fec_ldpc_r23_base,  8, 24, 27);
+    case LIQUID_FEC_LDPC_R34: return ldpccodec_create(fec_ldpc_r34_base,  6, 24, 27);
+    default:;
+    }
+    AUTOTEST_FAIL("invalid scheme");
+    return NULL;
+}
+
+// encoded codewords satisfy all parity checks, and single bit errors
+// are detected
+void fec_ldpc_test_encode(fec_scheme _fs)
+{
+    ldpccodec q = fec_ldpc_test_create(_fs);
+    unsigned int K = ldpccodec_get_k(q);
+    unsigned int N = ldpccodec_get_n(q);
+    unsigned char msg[(K+7)/8];
+    unsigned char parity[(N-K+7)/8];
+    unsigned char codeword[(N+7)/8];
+    unsigned int i, trial;
+
+    for (trial=0; trial<20; trial++) {
+        for (i=0; i<(K+7)/8; i++)
+            msg[i] = rand() & 0xff;
+        ldpccodec_encode(q, msg, parity);
+
+        fec_ldpc_test_copy_bits(msg,    0, codeword, 0, K);
+        fec_ldpc_test_copy_bits(parity, 0, codeword, K, N-K);
+        CONTEND_EQUALITY(ldpccodec_check(q, codeword), 1);
+
+        unsigned int p = rand() % N;
+        codeword[p>>3] ^= 0x80 >> (p&7);
+        CONTEND_EQUALITY(ldpccodec_check(q, codeword), 0);
+    }
+    ldpccodec_destroy(q);
+}
+
+// decode noisy codewords at every SIMD level available on this host;
+// all kernels are bit exact
+//  _fs     :   scheme
+//  _sigma  :   noise standard deviation relative to unit amplitude
+void fec_ldpc_test_decode(fec_scheme _fs,
+                          float      _sigma)
+{
+    ldpccodec q = fec_ldpc_test_create(_fs);
+    unsigned int K = ldpccodec_get_k(q);
+    unsigned int N = ldpccodec_get_n(q);
+    unsigned char msg[(K+7)/8];
+    unsigned char parity[(N-K+7)/8];
+    unsigned char codeword[(N+7)/8];
+    unsigned char msg_dec[(K+7)/8];
+    unsigned char msg_ref[(K+7)/8];
+    int8_t llr[N];
+    unsigned int i, trial;
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+
+    for (trial=0; trial<8; trial++) {
+        for (i=0; i<(K+7)/8; i++)
+            msg[i] = rand() & 0xff;
+        msg[K/8] &= (K%8) ? 0xff << (8-K%8) : 0xff;
+        ldpccodec_encode(q, msg, parity);
+        fec_ldpc_test_copy_bits(msg,    0, codeword, 0, K);
+        fec_ldpc_test_copy_bits(parity, 0, codeword, K, N-K);
+
+        // BPSK over AWGN, LLRs scaled to 8 units per amplitude
+        for (i=0; i<N; i++) {
+            float v = ((codeword[i>>3] >> (7-(i&7))) & 1) ? -1.0f : 1.0f;
+            v = 8.0f*(v + _sigma*randnf());
+            llr[i] = v > 127 ? 127 : (v < -127 ? -127 : (int8_t)roundf(v));
+        }
+
+        int num_ref = 0;
+        unsigned int level;
+        for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+            if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+                continue;
+            liquid_simd_set_level((liquid_simd_level)level);
+
+            int num = ldpccodec_decode(q, llr, 20, msg_dec);
+            if (level == LIQUID_SIMD_PORTABLE) {
+                num_ref = num;
+                memmove(msg_ref, msg_dec, sizeof(msg_ref));
+                CONTEND_GREATER_THAN(num, 0);
+                CONTEND_SAME_DATA(msg_dec, msg, sizeof(msg));
+            } else {
+                CONTEND_EQUALITY(num, num_ref);
+                CONTEND_SAME_DATA(msg_dec, msg_ref, sizeof(msg_ref));
+            }
+        }
+        liquid_simd_set_level(host);
+    }
+    ldpccodec_destroy(q);
+}
+
+// fec interface: hard-decision errors and soft-decision noise over
+// multiple (shortened) blocks
+void fec_ldpc_test_codec(fec_scheme   _fs,
+                         unsigned int _n,
+                         unsigned int _num_errors)
+{
+    fec q = fec_create(_fs, NULL);
+    unsigned int n_enc = fec_get_enc_msg_length(_fs, _n);
+    unsigned char msg[_n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[_n];
+    unsigned int i;
+
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    fec_encode(q, _n, msg, msg_enc);
+
+    // soft bits with random reliability, some of the wrong sign
+    for (i=0; i<8*n_enc; i++) {
+        unsigned int b = (msg_enc[i>>3] >> (7-(i&7))) & 1;
+        unsigned int r = 32 + (rand() % 96);
+        msg_soft[i] = b ? 127 + r : 127 - r;
+    }
+    for (i=0; i<_num_errors; i++) {
+        unsigned int p = rand() % (8*n_enc);
+        msg_enc[p>>3] ^= 0x80 >> (p&7);
+        msg_soft[p] = 255 - msg_soft[p];
+    }
+
+    memset(msg_dec, 0x00, _n);
+    fec_decode(q, _n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+
+    memset(msg_dec, 0x00, _n);
+    fec_decode_soft(q, _n, msg_soft, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+
+    fec_destroy(q);
+}
+
+void autotest_fec_ldpc_r12_encode() { fec_ldpc_test_encode(LIQUID_FEC_LDPC_R12); }
+void autotest_fec_ldpc_r23_encode() { fec_ldpc_test_encode(LIQUID_FEC_LDPC_R23); }
+void autotest_fec_ldpc_r34_encode() { fec_ldpc_test_encode(LIQUID_FEC_LDPC_R34); }
+
+void autotest_fec_ldpc_r12_decode() { fec_ldpc_test_decode(LIQUID_FEC_LDPC_R12, 0.70f); }
+void autotest_fec_ldpc_r23_decode() { fec_ldpc_test_decode(LIQUID_FEC_LDPC_R23, 0.55f); }
+void autotest_fec_ldpc_r34_decode() { fec_ldpc_test_decode(LIQUID_FEC_LDPC_R34, 0.50f); }
+
+void autotest_fec_ldpc_r12_codec()  { fec_ldpc_test_codec(LIQUID_FEC_LDPC_R12, 200, 8); }
+void autotest_fec_ldpc_r23_codec()  { fec_ldpc_test_codec(LIQUID_FEC_LDPC_R23, 200, 6); }
+void autotest_fec_ldpc_r34_codec()  { fec_ldpc_test_codec(LIQUID_FEC_LDPC_R34, 200, 4); }
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif
+
+// objects are reused after release, and the pool retains a bounded
+// number of idle objects
+void autotest_fec_pool_reuse()
+{
+    fec_pool_clear();
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_CONV_V27), 0);
+
+    fec q0 = fec_pool_acquire(LIQUID_FEC_CONV_V27);
+    fec q1 = fec_pool_acquire(LIQUID_FEC_CONV_V27);
+    CONTEND_EXPRESSION(q0 != q1);
+    fec_pool_release(q0);
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_CONV_V27), 1);
+
+    // idle object is handed out again
+    fec q2 = fec_pool_acquire(LIQUID_FEC_CONV_V27);
+    CONTEND_EXPRESSION(q2 == q0);
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_CONV_V27), 0);
+    fec_pool_release(q1);
+    fec_pool_release(q2);
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_CONV_V27), 2);
+
+    // schemes are kept separately
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_RS_M8), 0);
+
+    // releasing more objects than the pool holds destroys the excess
+    unsigned int i, n = 100;
+    fec q[n];
+    for (i=0; i<n; i++)
+        q[i] = fec_pool_acquire(LIQUID_FEC_HAMMING74);
+    for (i=0; i<n; i++)
+        fec_pool_release(q[i]);
+    unsigned int num_idle = fec_pool_get_num_idle(LIQUID_FEC_HAMMING74);
+    CONTEND_GREATER_THAN(num_idle, 0);
+    CONTEND_LESS_THAN(num_idle, n);
+
+    fec_pool_clear();
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_CONV_V27),  0);
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_HAMMING74), 0);
+}
+
+// many packetizers sharing a scheme borrow a single decoder when used
+// one at a time
+void autotest_fec_pool_packetizer()
+{
+    fec_pool_clear();
+
+    unsigned int i, n = 32;
+    unsigned int num_packetizers = 20;
+    packetizer p[num_packetizers];
+    for (i=0; i<num_packetizers; i++)
+        p[i] = packetizer_create(n, LIQUID_CRC_32, LIQUID_FEC_RS_M8, LIQUID_FEC_CONV_V29);
+
+    unsigned int k = packetizer_get_enc_msg_len(p[0]);
+    unsigned char msg[n];
+    unsigned char pkt[k];
+    unsigned char msg_dec[n];
+    for (i=0; i<num_packetizers; i++) {
+        unsigned int j;
+        for (j=0; j<n; j++)
+            msg[j] = rand() & 0xff;
+        packetizer_encode(p[i], msg, pkt);
+        pkt[i % k] ^= 0x01;
+        CONTEND_EQUALITY(packetizer_decode(p[i], pkt, msg_dec), 1);
+        CONTEND_SAME_DATA(msg, msg_dec, n);
+    }
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_RS_M8),    1);
+    CONTEND_EQUALITY(fec_pool_get_num_idle(LIQUID_FEC_CONV_V29), 1);
+
+    for (i=0; i<num_packetizers; i++)
+        packetizer_destroy(p[i]);
+    fec_pool_clear();
+}
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+// worker: encode and decode packets with private packetizer, counting
+// failures
+void * fec_pool_test_worker(void * _arg)
+{
+    unsigned int * num_errors = (unsigned int*) _arg;
+    unsigned int n = 64;
+    packetizer p = packetizer_create(n, LIQUID_CRC_32, LIQUID_FEC_RS_M8, LIQUID_FEC_LDPC_R12);
+    unsigned int k = packetizer_get_enc_msg_len(p);
+    unsigned char msg[n];
+    unsigned char pkt[k];
+    unsigned char msg_dec[n];
+    unsigned int i, t;
+    for (t=0; t<200; t++) {
+        for (i=0; i<n; i++)
+            msg[i] = (t*131 + i*7) & 0xff;
+        packetizer_encode(p, msg, pkt);
+        pkt[t % k] ^= 0x10;
+        if (!packetizer_decode(p, pkt, msg_dec) || memcmp(msg, msg_dec, n))
+            (*num_errors)++;
+    }
+    packetizer_destroy(p);
+    return NULL;
+}
+
+// concurrent borrowers never share an object
+void autotest_fec_pool_threads()
+{
+    unsigned int i, num_threads = 8;
+    pthread_t threads[num_threads];
+    unsigned int num_errors[num_threads];
+    for (i=0; i<num_threads; i++) {
+        num_errors[i] = 0;
+        pthread_create(&threads[i], NULL, fec_pool_test_worker, &num_errors[i]);
+    }
+    for (i=0; i<num_threads; i++) {
+        pthread_join(threads[i], NULL);
+        CONTEND_EQUALITY(num_errors[i], 0);
+    }
+    CONTEND_LESS_THAN(fec_pool_get_num_idle(LIQUID_FEC_LDPC_R12), num_threads+1);
+    fec_pool_clear();
+}
+#endif
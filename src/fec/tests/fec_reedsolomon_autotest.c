@@ -31,11 +31,6 @@
 //
 void autotest_reedsolomon_223_255()
 {
-#if !LIBFEC_ENABLED
-    printf("warning: Reed-Solomon codes unavailable\n");
-    return;
-#endif
-
     unsigned int dec_msg_len = 223;
 
     // compute and test encoded message length
@@ -83,3 +78,160 @@ void autotest_reedsolomon_223_255()
     fec_destroy(q);
 }
 
+
+// run codec directly: valid blocks, correctable and uncorrectable
+// error patterns, at every SIMD level available on this host
+void fec_reedsolomon_test_codec(unsigned int _pad)
+{
+    unsigned int n = 255 - _pad;    // block length
+    unsigned int k = n - 32;        // message length
+    unsigned char block[n];
+    unsigned char rec[n];
+    unsigned int i, t, trial;
+
+    rscodec q = rscodec_create(0x11d, 1, 1, 32, _pad);
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        for (trial=0; trial<8; trial++) {
+            for (i=0; i<k; i++)
+                block[i] = rand() & 0xff;
+            rscodec_encode(q, block, block + k);
+
+            // valid codeword
+            memmove(rec, block, n);
+            CONTEND_EQUALITY(rscodec_decode(q, rec), 0);
+            CONTEND_SAME_DATA(rec, block, n);
+
+            // t errors at distinct random positions
+            for (t=1; t<=16; t+=5) {
+                memmove(rec, block, n);
+                unsigned int num = 0;
+                while (num < t) {
+                    unsigned int p = rand() % n;
+                    if (rec[p] != block[p])
+                        continue;
+                    rec[p] ^= 1 + (rand() % 255);
+                    num++;
+                }
+                CONTEND_EQUALITY(rscodec_decode(q, rec), (int)t);
+                CONTEND_SAME_DATA(rec, block, n);
+            }
+
+            // too many errors: the detected failure leaves the block as
+            // received (a miscorrection is possible but improbable)
+            memmove(rec, block, n);
+            for (i=0; i<20; i++)
+                rec[i] ^= 0x5a;
+            unsigned char tmp[n];
+            memmove(tmp, rec, n);
+            if (rscodec_decode(q, rec) < 0)
+                CONTEND_SAME_DATA(rec, tmp, n);
+        }
+    }
+    liquid_simd_set_level(host);
+    rscodec_destroy(q);
+}
+
+void autotest_reedsolomon_codec_n255() { fec_reedsolomon_test_codec(  0); }
+void autotest_reedsolomon_codec_n237() { fec_reedsolomon_test_codec( 18); }
+void autotest_reedsolomon_codec_n45()  { fec_reedsolomon_test_codec(210); }
+
+// multi-block messages with errors in every block
+void autotest_reedsolomon_blocks()
+{
+    unsigned int dec_msg_len = 1024;
+    unsigned int enc_msg_len = fec_get_enc_msg_length(LIQUID_FEC_RS_M8,dec_msg_len);
+    CONTEND_EQUALITY( enc_msg_len, 1185 );
+
+    unsigned char msg_org[dec_msg_len];
+    unsigned char msg_enc[enc_msg_len];
+    unsigned char msg_dec[dec_msg_len];
+    unsigned int i;
+    for (i=0; i<dec_msg_len; i++)
+        msg_org[i] = rand() & 0xff;
+
+    fec q = fec_create(LIQUID_FEC_RS_M8,NULL);
+    fec_encode(q, dec_msg_len, msg_org, msg_enc);
+
+    // 16 symbol errors in each of the five 237-symbol blocks
+    for (i=0; i<enc_msg_len; i++) {
+        if ((i % 237) % 15 == 3)
+            msg_enc[i] ^= 0xc3;
+    }
+
+    fec_decode(q, dec_msg_len, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg_org, msg_dec, dec_msg_len);
+    fec_destroy(q);
+}
+
+
+// known answers for libfec's init_rs_char(8,0x11d,1,1,32,_pad): parity
+// of the message m[i] = 37*i + 11 (mod 256), then a fixed pattern of 16
+// symbol errors spread over message and parity, at every SIMD level
+void fec_reedsolomon_test_kat(unsigned int _pad, unsigned char * _parity)
+{
+    unsigned int n = 255 - _pad;    // block length
+    unsigned int k = n - 32;        // message length
+    unsigned char block[n];
+    unsigned char rec[n];
+    unsigned int i;
+    for (i=0; i<k; i++)
+        block[i] = (37*i + 11) & 0xff;
+
+    rscodec q = rscodec_create(0x11d, 1, 1, 32, _pad);
+    rscodec_encode(q, block, block + k);
+    CONTEND_SAME_DATA(block + k, _parity, 32);
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+        memmove(rec, block, n);
+        for (i=0; i<16; i++)
+            rec[(15*i + 7) % n] ^= 0x80 | (11*i);
+        CONTEND_EQUALITY(rscodec_decode(q, rec), 16);
+        CONTEND_SAME_DATA(rec, block, n);
+    }
+    liquid_simd_set_level(host);
+    rscodec_destroy(q);
+}
+
+void autotest_reedsolomon_kat_n255()
+{
+    unsigned char parity[32] = {
+        0x62, 0x9c, 0xa0, 0xbf, 0xc3, 0x72, 0x69, 0xb5, 0x95, 0xec, 0x60, 0xe8,
+        0xfb, 0x40, 0x21, 0x2d, 0xad, 0xae, 0xed, 0xd5, 0x45, 0x14, 0xe0, 0xf1,
+        0xbe, 0x01, 0xc1, 0x69, 0x32, 0x82, 0x8a, 0xca};
+    fec_reedsolomon_test_kat(0, parity);
+
+    // a single 223-byte message through the fec interface is one block
+    unsigned char msg_org[223];
+    unsigned char msg_enc[255];
+    unsigned int i;
+    for (i=0; i<223; i++)
+        msg_org[i] = (37*i + 11) & 0xff;
+    fec q = fec_create(LIQUID_FEC_RS_M8,NULL);
+    fec_encode(q, 223, msg_org, msg_enc);
+    CONTEND_SAME_DATA(msg_enc, msg_org, 223);
+    CONTEND_SAME_DATA(msg_enc + 223, parity, 32);
+    fec_destroy(q);
+}
+
+void autotest_reedsolomon_kat_n237()
+{
+    unsigned char parity[32] = {
+        0xb1, 0x6a, 0xea, 0xcb, 0xb7, 0x5c, 0x69, 0x0e, 0xb6, 0xbe, 0x8d, 0xc9,
+        0xa2, 0xb4, 0xf9, 0x78, 0x29, 0xe3, 0x80, 0x0a, 0x8a, 0x1b, 0x80, 0x70,
+        0x1f, 0x48, 0xdf, 0xd6, 0xb8, 0xd4, 0x90, 0x2e};
+    fec_reedsolomon_test_kat(18, parity);
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// decode noisy soft bits at every SIMD level available on this host and
+// compare against the portable decoder
+void fec_viterbi_test_levels(fec_scheme _fs, unsigned int _n)
+{
+    unsigned int n_enc = fec_get_enc_msg_length(_fs,_n);
+    unsigned char msg[_n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[_n];
+    unsigned char msg_ref[_n];
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(_fs,NULL);
+    fec_encode(q, _n, msg, msg_enc);
+
+    // soft bits with additive noise, saturating; the noise is strong
+    // enough that some symbols flip sign and paths tie
+    for (i=0; i<8*n_enc; i++) {
+        int v = ((msg_enc[i/8] >> (7-(i%8))) & 1) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+        v += (rand() % 321) - 160;
+        msg_soft[i] = v < 0 ? 0 : (v > 255 ? 255 : v);
+    }
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    liquid_simd_set_level(LIQUID_SIMD_PORTABLE);
+    fec_decode_soft(q, _n, msg_soft, msg_ref);
+
+    unsigned int k;
+    for (k=0; k<LIQUID_SIMD_NUM_LEVELS; k++) {
+        // x86 hosts support every level up to their own
+        int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+        if (k != host && !(x86 && k < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)k);
+        if (liquid_autotest_verbose)
+            printf("  %s (%s)\n", fec_scheme_str[_fs][0], liquid_simd_level_str((liquid_simd_level)k));
+        memset(msg_dec, 0x00, _n);
+        fec_decode_soft(q, _n, msg_soft, msg_dec);
+        CONTEND_SAME_DATA(msg_dec, msg_ref, _n);
+    }
+    liquid_simd_set_level(host);
+
+    fec_destroy(q);
+}
+
+void autotest_fec_viterbi_levels_v27()  { fec_viterbi_test_levels(LIQUID_FEC_CONV_V27,   200); }
+void autotest_fec_viterbi_levels_v29()  { fec_viterbi_test_levels(LIQUID_FEC_CONV_V29,   200); }
+void autotest_fec_viterbi_levels_v39()  { fec_viterbi_test_levels(LIQUID_FEC_CONV_V39,   200); }
+void autotest_fec_viterbi_levels_v615() { fec_viterbi_test_levels(LIQUID_FEC_CONV_V615,   64); }
+void autotest_fec_viterbi_levels_v27p34() { fec_viterbi_test_levels(LIQUID_FEC_CONV_V27P34, 200); }
+
+// hard-decision decoder corrects isolated bit errors
+void autotest_fec_viterbi_v27_errors()
+{
+    unsigned int n = 64;
+    unsigned int n_enc = fec_get_enc_msg_length(LIQUID_FEC_CONV_V27,n);
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(LIQUID_FEC_CONV_V27,NULL);
+    fec_encode(q, n, msg, msg_enc);
+
+    // flip one bit in every 4th byte (well within the free distance)
+    for (i=0; i<n_enc; i+=4)
+        msg_enc[i] ^= 1 << (i % 8);
+
+    fec_decode(q, n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, n);
+    fec_destroy(q);
+}
+
+// decoder is re-created when the message length changes
+void autotest_fec_viterbi_recreate()
+{
+    fec q = fec_create(LIQUID_FEC_CONV_V29,NULL);
+    unsigned int lens[3] = {13, 100, 7};
+    unsigned int k;
+    for (k=0; k<3; k++) {
+        unsigned int n = lens[k];
+        unsigned int n_enc = fec_get_enc_msg_length(LIQUID_FEC_CONV_V29,n);
+        unsigned char msg[n];
+        unsigned char msg_enc[n_enc];
+        unsigned char msg_dec[n];
+        unsigned int i;
+        for (i=0; i<n; i++)
+            msg[i] = rand() & 0xff;
+        fec_encode(q, n, msg, msg_enc);
+        fec_decode(q, n, msg_enc, msg_dec);
+        CONTEND_SAME_DATA(msg, msg_dec, n);
+    }
+    fec_destroy(q);
+}
+
+
+// deterministic soft-bit noise for the known-answer tests: uniform in
+// [-300,300] from a 32-bit linear congruential generator, saturated
+unsigned char fec_viterbi_kat_noise(unsigned int * _s, unsigned char _bit)
+{
+    *_s = *_s * 1103515245u + 12345u;
+    int v = (_bit ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0) + (int)(((*_s >> 16) & 0x7fff) % 601) - 300;
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+// known answers from a model of the libfec encoder and portable
+// decoders (same shift register, branch metrics, tie-breaking and
+// chainback); the noise is strong enough to leave residual bit errors,
+// so the decoded vector pins down the survivor path, not just the
+// message
+void fec_viterbi_test_kat(fec_scheme      _fs,
+                          unsigned int    _seed,
+                          unsigned char * _enc_ref,
+                          unsigned int    _n_enc,
+                          unsigned char * _dec_ref)
+{
+    unsigned int n = 16;
+    unsigned char msg[16] = {
+        0x4c, 0x69, 0x71, 0x75, 0x69, 0x64, 0x20, 0x44, 0x53, 0x50, 0x2d, 0x4b,
+        0x41, 0x54, 0xa5, 0x3c};
+    CONTEND_EQUALITY( fec_get_enc_msg_length(_fs,n), _n_enc );
+    unsigned char msg_enc[_n_enc];
+    unsigned char msg_soft[8*_n_enc];
+    unsigned char msg_dec[n];
+
+    fec q = fec_create(_fs,NULL);
+    fec_encode(q, n, msg, msg_enc);
+    CONTEND_SAME_DATA(msg_enc, _enc_ref, _n_enc);
+
+    unsigned int i;
+    unsigned int s = _seed;
+    for (i=0; i<8*_n_enc; i++)
+        msg_soft[i] = fec_viterbi_kat_noise(&s, (msg_enc[i/8] >> (7-(i%8))) & 1);
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    unsigned int k;
+    for (k=0; k<LIQUID_SIMD_NUM_LEVELS; k++) {
+        int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+        if (k != LIQUID_SIMD_PORTABLE && k != host && !(x86 && k < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)k);
+        memset(msg_dec, 0x00, n);
+        fec_decode_soft(q, n, msg_soft, msg_dec);
+        CONTEND_SAME_DATA(msg_dec, _dec_ref, n);
+    }
+    liquid_simd_set_level(host);
+
+    fec_destroy(q);
+}
+
+// V27: 46 bit errors remain after decoding
+void autotest_fec_viterbi_kat_v27()
+{
+    unsigned char enc[34] = {
+        0x3b, 0x13, 0xee, 0xda, 0x56, 0xf9, 0x3a, 0xc2, 0xfe, 0xaa, 0x55, 0x7d,
+        0x09, 0xf1, 0xfb, 0xfc, 0xff, 0x76, 0x05, 0xcb, 0x7e, 0x26, 0x9c, 0x55,
+        0x6a, 0x74, 0x84, 0x30, 0x56, 0xd5, 0xb6, 0xe9, 0x6b, 0x00};
+    unsigned char dec[16] = {
+        0xce, 0xcf, 0xfd, 0x9e, 0x26, 0xac, 0x20, 0x44, 0x51, 0x04, 0x60, 0xcd,
+        0x4b, 0xcd, 0x4b, 0x3c};
+    fec_viterbi_test_kat(LIQUID_FEC_CONV_V27, 7, enc, 34, dec);
+}
+
+// V29: 53 bit errors remain after decoding
+void autotest_fec_viterbi_kat_v29()
+{
+    unsigned char enc[34] = {
+        0x3b, 0x0c, 0x3f, 0xb2, 0x75, 0xdb, 0x9c, 0x20, 0x47, 0xf9, 0x76, 0x5e,
+        0x4a, 0x46, 0x17, 0xe3, 0x50, 0xd8, 0x48, 0xc2, 0x35, 0x21, 0x10, 0xc1,
+        0xa2, 0xbc, 0x35, 0xd5, 0x02, 0x1c, 0x84, 0xa4, 0x1d, 0x70};
+    unsigned char dec[16] = {
+        0x7c, 0x71, 0xe0, 0xcd, 0x4f, 0x72, 0x36, 0xf9, 0xfb, 0x04, 0x8b, 0x39,
+        0xe1, 0xc7, 0xf4, 0x2b};
+    fec_viterbi_test_kat(LIQUID_FEC_CONV_V29, 9, enc, 34, dec);
+}
+
+// V39: 71 bit errors remain after decoding
+void autotest_fec_viterbi_kat_v39()
+{
+    unsigned char enc[51] = {
+        0x1d, 0xd3, 0x9f, 0x5e, 0xca, 0x10, 0x78, 0xd5, 0x7b, 0x9d, 0xca, 0xa6,
+        0x57, 0x7f, 0x27, 0x78, 0xa3, 0xd3, 0x8e, 0xf6, 0x55, 0x86, 0x5d, 0x71,
+        0x0b, 0x66, 0x22, 0xbc, 0xa9, 0x51, 0x6c, 0xc4, 0xa1, 0x6d, 0xda, 0x89,
+        0x59, 0xc0, 0x24, 0xb6, 0x81, 0x34, 0x48, 0xe2, 0xe9, 0xc5, 0xa5, 0x23,
+        0xb4, 0x53, 0xc0};
+    unsigned char dec[16] = {
+        0xff, 0x6c, 0xd0, 0xce, 0x57, 0xd9, 0x1b, 0x4c, 0x80, 0xb3, 0xbf, 0xfc,
+        0xef, 0x33, 0x79, 0x00};
+    fec_viterbi_test_kat(LIQUID_FEC_CONV_V39, 9, enc, 51, dec);
+}
+
+// V615: 5 bit errors remain after decoding
+void autotest_fec_viterbi_kat_v615()
+{
+    unsigned char enc[107] = {
+        0x03, 0xf3, 0xdb, 0x79, 0x70, 0xb7, 0xc2, 0x7f, 0x51, 0x07, 0x81, 0x5f,
+        0x1a, 0x46, 0xed, 0xbd, 0x34, 0x49, 0x14, 0xff, 0x03, 0x5f, 0xbe, 0xc7,
+        0xb5, 0x05, 0x71, 0x47, 0x96, 0x24, 0x9a, 0x2f, 0xdc, 0x9c, 0x8f, 0xca,
+        0xf4, 0x1c, 0xa4, 0x3e, 0x2e, 0x10, 0xa4, 0x78, 0x72, 0x7c, 0x35, 0xd1,
+        0xa3, 0x13, 0xd7, 0x0d, 0xb6, 0x5b, 0xbe, 0xfb, 0xbd, 0xe3, 0x7d, 0x24,
+        0x3f, 0xe2, 0x91, 0x45, 0xeb, 0xe2, 0x0d, 0xc7, 0x11, 0xa4, 0x18, 0x97,
+        0xe4, 0xdc, 0x53, 0x3f, 0xbc, 0x29, 0x7e, 0xf4, 0xb4, 0x6f, 0xf2, 0x67,
+        0xa3, 0x22, 0x7a, 0x02, 0xeb, 0xcb, 0x5a, 0xd6, 0x28, 0xef, 0x20, 0xdb,
+        0xbf, 0xa6, 0x35, 0xc2, 0x5f, 0x6c, 0xb7, 0x6e, 0x3f, 0x00, 0x00};
+    unsigned char dec[16] = {
+        0xed, 0x59, 0x71, 0x75, 0x69, 0x64, 0x20, 0x44, 0x53, 0x50, 0x2d, 0x4b,
+        0x41, 0x54, 0xa5, 0x3c};
+    fec_viterbi_test_kat(LIQUID_FEC_CONV_V615, 15, enc, 107, dec);
+}
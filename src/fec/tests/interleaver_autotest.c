@@ -75,6 +75,44 @@ void interleaver_test_soft(unsigned int _n)
     interleaver_destroy(q);
 }
 
+// 
+// AUTOTESTS: soft-bit interleaver matches hard-bit interleaver
+//
+void interleaver_test_hard_soft(unsigned int _n,
+                                unsigned int _depth)
+{
+    unsigned int i;
+    unsigned int k;
+    unsigned char x[_n];
+    unsigned char y[_n];
+    unsigned char x_soft[8*_n];
+    unsigned char y_soft[8*_n];
+    unsigned char y_test[8*_n];
+
+    // expand bytes into soft bits, msb first
+    for (i=0; i<_n; i++) {
+        x[i] = rand() & 0xFF;
+        for (k=0; k<8; k++)
+            x_soft[8*i+k] = ((x[i] >> (8-k-1)) & 0x01) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+    }
+
+    // create interleaver object
+    interleaver q = interleaver_create(_n);
+    interleaver_set_depth(q, _depth);
+
+    interleaver_encode(q,x,y);
+    interleaver_encode_soft(q,x_soft,y_soft);
+
+    for (i=0; i<_n; i++) {
+        for (k=0; k<8; k++)
+            y_test[8*i+k] = ((y[i] >> (8-k-1)) & 0x01) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+    }
+    CONTEND_SAME_DATA(y_soft, y_test, 8*_n);
+
+    // destroy interleaver object
+    interleaver_destroy(q);
+}
+
 void autotest_interleaver_hard_8()      { interleaver_test_hard(8   ); }
 void autotest_interleaver_hard_16()     { interleaver_test_hard(16  ); }
 void autotest_interleaver_hard_64()     { interleaver_test_hard(64  ); }
@@ -85,3 +123,6 @@ void autotest_interleaver_soft_16()     { interleaver_test_soft(16  ); }
 void autotest_interleaver_soft_64()     { interleaver_test_soft(64  ); }
 void autotest_interleaver_soft_256()    { interleaver_test_soft(256 ); }
 
+void autotest_interleaver_hard_soft_d1()  { interleaver_test_hard_soft(67,  1); }
+void autotest_interleaver_hard_soft_d4()  { interleaver_test_hard_soft(67,  4); }
+void autotest_interleaver_hard_soft_256() { interleaver_test_hard_soft(256, 4); }
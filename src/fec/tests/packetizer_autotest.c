@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -65,3 +67,82 @@ void autotest_packetizer_n16_0_0()  { packetizer_test_codec(16, LIQUID_CRC_32, L
 void autotest_packetizer_n16_0_1()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_REP3);       }
 void autotest_packetizer_n16_0_2()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_HAMMING74);  }
 
+
+// Help function to keep code base small (soft-decision decoding)
+void packetizer_test_codec_soft(unsigned int _n,
+                                crc_scheme _crc,
+                                fec_scheme _fec0,
+                                fec_scheme _fec1)
+{
+    unsigned char msg_tx[_n];
+    unsigned char msg_rx[_n];
+    unsigned int pkt_len = packetizer_compute_enc_msg_len(_n,_crc,_fec0,_fec1);
+    unsigned char packet[pkt_len];
+    unsigned char packet_soft[8*pkt_len];
+
+    // create object
+    packetizer p = packetizer_create(_n,_crc,_fec0,_fec1);
+
+    // initialize data
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        msg_tx[i] = rand() & 0xff;
+        msg_rx[i] = 0;
+    }
+
+    // encode packet and convert to soft bits, flipping one bit
+    packetizer_encode(p, msg_tx, packet);
+    packet[pkt_len/2] ^= 0x10;
+    for (i=0; i<8*pkt_len; i++)
+        packet_soft[i] = ((packet[i/8] >> (8-(i%8)-1)) & 0x01) ? 192 : 64;
+
+    // decode packet
+    int crc_pass = packetizer_decode_soft(p, packet_soft, msg_rx);
+
+    CONTEND_SAME_DATA(msg_tx, msg_rx, _n);
+    CONTEND_EQUALITY(crc_pass, 1);
+
+    // clean up objects
+    packetizer_destroy(p);
+}
+
+void autotest_packetizer_soft_n16_1_0() { packetizer_test_codec_soft(16, LIQUID_CRC_32, LIQUID_FEC_HAMMING128, LIQUID_FEC_NONE);       }
+void autotest_packetizer_soft_n16_1_1() { packetizer_test_codec_soft(16, LIQUID_CRC_32, LIQUID_FEC_GOLAY2412,  LIQUID_FEC_SECDED7264);  }
+void autotest_packetizer_soft_n16_1_2() { packetizer_test_codec_soft(16, LIQUID_CRC_32, LIQUID_FEC_NONE,       LIQUID_FEC_CONV_V27);    }
+void autotest_packetizer_soft_n37_1_3() { packetizer_test_codec_soft(37, LIQUID_CRC_32, LIQUID_FEC_SECDED7264, LIQUID_FEC_HAMMING128);  }
+
+// valid packets pass the syndrome pre-check and noise is rejected; a
+// random Golay(24,12) or Hamming(8,4) word is uncorrectable with
+// probability of only about 0.43, so packets must hold enough codewords
+// that noise stays above the 25% threshold (failure rate below 1e-9)
+void packetizer_test_precheck(unsigned int _n,
+                              fec_scheme   _fec0,
+                              fec_scheme   _fec1,
+                              int          _detects)
+{
+    packetizer p = packetizer_create(_n, LIQUID_CRC_32, _fec0, _fec1);
+    unsigned int k = packetizer_get_enc_msg_len(p);
+    unsigned char msg[_n];
+    unsigned char pkt[k];
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    packetizer_encode(p, msg, pkt);
+    CONTEND_EQUALITY(packetizer_precheck(p, pkt, 0.0f), 1);
+
+    // a few bit errors
+    for (i=0; i<4; i++)
+        pkt[(7*i) % k] ^= 0x80 >> i;
+    CONTEND_EQUALITY(packetizer_precheck(p, pkt, 0.25f), 1);
+
+    // noise: rejected only if the outer code detects errors
+    for (i=0; i<k; i++)
+        pkt[i] = rand() & 0xff;
+    CONTEND_EQUALITY(packetizer_precheck(p, pkt, 0.25f), _detects ? 0 : 1);
+
+    packetizer_destroy(p);
+}
+
+void autotest_packetizer_precheck_h84()   { packetizer_test_precheck(128, LIQUID_FEC_SECDED7264, LIQUID_FEC_HAMMING84, 1); }
+void autotest_packetizer_precheck_g2412() { packetizer_test_precheck(400, LIQUID_FEC_GOLAY2412,  LIQUID_FEC_NONE,      1); }
+void autotest_packetizer_precheck_v27()   { packetizer_test_precheck( 20, LIQUID_FEC_NONE,       LIQUID_FEC_CONV_V27,  0); }
@@ -55,13 +55,13 @@ ASGRAM() ASGRAM(_create)(unsigned int _nfft)
     }
 
     // create main object
-    ASGRAM() q = (ASGRAM()) malloc(sizeof(struct ASGRAM(_s)));
+    ASGRAM() q = (ASGRAM()) liquid_malloc(sizeof(struct ASGRAM(_s)));
 
     q->nfft = _nfft;
 
     // allocate memory for PSD estimate
-    q->X   = (TC *   ) malloc((q->nfft)*sizeof(TC)   );
-    q->psd = (float *) malloc((q->nfft)*sizeof(float));
+    q->X   = (TC *   ) liquid_malloc((q->nfft)*sizeof(TC)   );
+    q->psd = (float *) liquid_malloc((q->nfft)*sizeof(float));
 
     // create spectral periodogram object
     q->periodogram = SPGRAM(_create_default)(q->nfft);
@@ -91,11 +91,11 @@ void ASGRAM(_destroy)(ASGRAM() _q)
     SPGRAM(_destroy)(_q->periodogram);
 
     // free PSD estimate array
-    free(_q->X);
-    free(_q->psd);
+    liquid_free(_q->X);
+    liquid_free(_q->psd);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // resets the internal state of the asgram object
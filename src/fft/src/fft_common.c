@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include "liquid.internal.h"
 
 struct FFT(plan_s)
@@ -50,15 +51,15 @@ struct FFT(plan_s)
     union {
         // DFT
         struct {
-            TC * twiddle;               // twiddle factors
-            DOTPROD() * dotprod;        // inner dot products
+            TC * twiddle;               // twiddle factors (unused)
+            DOTPROD() * dotprod;        // inner dot products (shared)
         } dft;
 
         // radix-2 transform data
         struct {
             unsigned int m;             // log2(nfft)
-            unsigned int * index_rev;   // reversed indices
-            TC * twiddle;               // twiddle factors
+            unsigned int * index_rev;   // reversed indices (shared)
+            TC * twiddle;               // per-stage twiddle factors (shared, aligned)
         } radix2;
 
         // recursive mixed-radix transform data:
@@ -72,15 +73,15 @@ struct FFT(plan_s)
             TC * x;             // input buffer (copied)
             TC * t0;            // temporary buffer (small FFT input)
             TC * t1;            // temporary buffer (small FFT output)
-            TC * twiddle;       // twiddle factors
+            TC * twiddle;       // twiddle factors (shared)
             FFT(plan) fft_P;    // sub-transform of size P
             FFT(plan) fft_Q;    // sub-transform of size Q
         } mixedradix;
 
         // Rader's algorithm for computing FFTs of prime length
         struct {
-            unsigned int * seq; // transformation sequence, size: nfft-1
-            TC * R;             // DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft-1
+            unsigned int * seq; // transformation sequence, size: nfft-1 (shared)
+            TC * R;             // DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft-1 (shared)
             TC * x_prime;       // sub-transform time-domain buffer
             TC * X_prime;       // sub-transform freq-domain buffer
             FFT(plan) fft;      // sub-FFT of size nfft-1
@@ -90,34 +91,178 @@ struct FFT(plan_s)
         // Rader's alternate algorithm for computing FFTs of prime length
         struct {
             unsigned int nfft_prime;
-            unsigned int * seq; // transformation sequence, size: nfft_prime
-            TC * R;             // DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft_prime
+            unsigned int * seq; // transformation sequence, size: nfft-1 (shared)
+            TC * R;             // DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft_prime (shared)
             TC * x_prime;       // sub-transform time-domain buffer
             TC * X_prime;       // sub-transform freq-domain buffer
             FFT(plan) fft;      // sub-FFT of size nfft_prime
             FFT(plan) ifft;     // sub-IFFT of size nfft_prime
         } rader2;
+
+        // Stockham auto-sort transform
+        struct {
+            unsigned int num_stages;    // number of stages
+            unsigned int radix[LIQUID_FFT_STOCKHAM_MAX_STAGES]; // stage radices
+            TC * twiddle;               // per-stage roots and twiddle factors (shared)
+            TC * buf;                   // ping-pong buffer (aligned)
+        } stockham;
+
+        // real-to-complex/complex-to-real transforms: even sizes pack
+        // pairs of real samples into a half-length complex transform,
+        // odd sizes run a full-length complex transform
+        struct {
+            TC * z;             // sub-transform input  [size: nfft/2 (even), nfft (odd)]
+            TC * Z;             // sub-transform output [size: nfft/2 (even), nfft (odd)]
+            TC * twiddle;       // exp(-j*2*pi*k/nfft), k in [0,nfft/2) (shared)
+            FFT(plan) fft;      // complex sub-transform
+        } r2c;
+
+        // real-to-real transforms (DCT/DST): the input is rearranged
+        // and rotated into a real or complex sub-transform whose
+        // output is rotated back, O(n log n) for all types
+        struct {
+            T * t;              // real sub-transform buffer
+            TC * z;             // complex sub-transform input
+            TC * Z;             // complex sub-transform output
+            TC * twiddle;       // pre/post-rotation factors
+            FFT(plan) fft;      // sub-transform
+        } r2r;
+
+        // batch of equal-size transforms: radix-2 sizes run all
+        // transforms together on an interleaved buffer, other sizes
+        // run a single plan on each transform in turn
+        struct {
+            unsigned int howmany;       // number of transforms
+            unsigned int istride;       // input stride
+            unsigned int idist;         // input distance between transforms
+            unsigned int ostride;       // output stride
+            unsigned int odist;         // output distance between transforms
+            unsigned int m;             // log2(nfft) (radix-2 only)
+            unsigned int * index_rev;   // reversed indices (shared, radix-2 only)
+            TC * twiddle;               // per-stage twiddle factors (shared, radix-2 only)
+            TC * buf;                   // interleaved buffer, aligned (radix-2 only)
+            TC * x;                     // sub-transform input (other sizes)
+            TC * y;                     // sub-transform output (other sizes)
+            FFT(plan) fft;              // sub-transform (other sizes)
+        } many;
+
+        // pruned transform: input zero or output needed only on the
+        // cyclic band [k0,k0+len), evaluated directly on the band
+        struct {
+            int prune;                  // pruned side (input/output)
+            unsigned int k0;            // first bin of band
+            unsigned int len;           // band length
+            TC * twiddle;               // W^((k0+l)*i), l in [0,len), i in [0,nfft)
+            TC * buf;                   // band buffer [size: len x 1]
+            dotprod_cccf * dp;          // dot product per band bin (output pruned only)
+        } pruned;
+
+        // split-complex transform: radix-2 sizes run on the split
+        // arrays directly (input/output real parts in xr/yr above),
+        // other sizes through a regular transform
+        struct {
+            T * xi;                     // input array, imaginary part (not allocated)
+            T * yi;                     // output array, imaginary part (not allocated)
+            unsigned int m;             // log2(nfft) (radix-2 only)
+            unsigned int * index_rev;   // reversed indices (shared, radix-2 only)
+            T * twiddle;                // split per-stage twiddles, aligned (radix-2 only)
+            TC * x;                     // sub-transform input, aligned (other sizes)
+            TC * y;                     // sub-transform output, aligned (other sizes)
+            FFT(plan) fft;              // sub-transform (other sizes)
+        } split;
     } data;
 };
 
-// create FFT plan, regular complex one-dimensional transform
-//  _nfft   :   FFT size
-//  _x      :   input array [size: _nfft x 1]
-//  _y      :   output array [size: _nfft x 1]
-//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
-//  _flags  :   fft method
-FFT(plan) FFT(_create_plan)(unsigned int _nfft,
-                            TC *         _x,
-                            TC *         _y,
-                            int          _dir,
-                            int          _flags)
+// minimum time to run each candidate plan when measuring [seconds]
+#define LIQUID_FFT_MEASURE_TIME     (2e-4)
+
+// largest transform for which the regular DFT is measured
+#define LIQUID_FFT_MEASURE_DFT_MAX  (64)
+
+// fastest method found by measuring (or imported with
+// fft_wisdom_import()), remembered by transform size and direction so
+// that sub-transforms shared between candidate plans (and plans
+// created later) are only measured once
+#define LIQUID_FFT_WISDOM_LEN       (64)
+static struct {
+    unsigned int      nfft;     // transform size
+    int               dir;      // transform direction
+    liquid_fft_method method;   // fastest method
+    unsigned int      Q;        // mixed-radix factor
+} FFT(_wisdom)[LIQUID_FFT_WISDOM_LEN];
+static unsigned int FFT(_wisdom_len) = 0;
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+static pthread_mutex_t FFT(_wisdom_mutex) = PTHREAD_MUTEX_INITIALIZER;
+#define LIQUID_FFT_WISDOM_LOCK()   pthread_mutex_lock(&FFT(_wisdom_mutex))
+#define LIQUID_FFT_WISDOM_UNLOCK() pthread_mutex_unlock(&FFT(_wisdom_mutex))
+#else
+#define LIQUID_FFT_WISDOM_LOCK()
+#define LIQUID_FFT_WISDOM_UNLOCK()
+#endif
+
+// find wisdom entry for transform, returning -1 if none exists; wisdom
+// must be locked
+static int FFT(_wisdom_find)(unsigned int _nfft,
+                             int          _dir)
 {
-    // determine best method for execution
-    // TODO : check flags and allow user override
-    liquid_fft_method method = liquid_fft_estimate_method(_nfft);
+    unsigned int i;
+    for (i=0; i<FFT(_wisdom_len); i++) {
+        if (FFT(_wisdom)[i].nfft == _nfft && FFT(_wisdom)[i].dir == _dir)
+            return (int)i;
+    }
+    return -1;
+}
 
+// store wisdom entry for transform, replacing an existing entry for
+// the same size and direction; returns 0 on success, -1 if full
+static int FFT(_wisdom_store)(unsigned int      _nfft,
+                              int               _dir,
+                              liquid_fft_method _method,
+                              unsigned int      _Q)
+{
+    LIQUID_FFT_WISDOM_LOCK();
+    int i = FFT(_wisdom_find)(_nfft, _dir);
+    if (i < 0 && FFT(_wisdom_len) < LIQUID_FFT_WISDOM_LEN)
+        i = FFT(_wisdom_len)++;
+    if (i >= 0) {
+        FFT(_wisdom)[i].nfft   = _nfft;
+        FFT(_wisdom)[i].dir    = _dir;
+        FFT(_wisdom)[i].method = _method;
+        FFT(_wisdom)[i].Q      = _method == LIQUID_FFT_METHOD_MIXED_RADIX ? _Q : 0;
+    }
+    LIQUID_FFT_WISDOM_UNLOCK();
+    return i < 0 ? -1 : 0;
+}
+
+// look up wisdom for transform; returns 1 and sets method and
+// mixed-radix factor if an entry exists, 0 otherwise
+static int FFT(_wisdom_lookup)(unsigned int        _nfft,
+                               int                 _dir,
+                               liquid_fft_method * _method,
+                               unsigned int *      _Q)
+{
+    LIQUID_FFT_WISDOM_LOCK();
+    int i = FFT(_wisdom_find)(_nfft, _dir);
+    if (i >= 0) {
+        *_method = FFT(_wisdom)[i].method;
+        *_Q      = FFT(_wisdom)[i].Q;
+    }
+    LIQUID_FFT_WISDOM_UNLOCK();
+    return i >= 0;
+}
+
+// create FFT plan using specific method
+static FFT(plan) FFT(_create_plan_method)(unsigned int      _nfft,
+                                          TC *              _x,
+                                          TC *              _y,
+                                          int               _dir,
+                                          int               _flags,
+                                          liquid_fft_method _method)
+{
     // initialize fft based on method
-    switch (method) {
+    switch (_method) {
     case LIQUID_FFT_METHOD_RADIX2:
         // use radix-2 decimation-in-time method
         return FFT(_create_plan_radix2)(_nfft, _x, _y, _dir, _flags);
@@ -138,6 +283,10 @@ FFT(plan) FFT(_create_plan)(unsigned int _nfft,
         // use slow DFT
         return FFT(_create_plan_dft)(_nfft, _x, _y, _dir, _flags);
 
+    case LIQUID_FFT_METHOD_STOCKHAM:
+        // use Stockham auto-sort algorithm
+        return FFT(_create_plan_stockham)(_nfft, _x, _y, _dir, _flags);
+
     case LIQUID_FFT_METHOD_UNKNOWN:
     default:
         fprintf(stderr,"error: fft_create_plan(), unknown/invalid fft method\n");
@@ -147,6 +296,196 @@ FFT(plan) FFT(_create_plan)(unsigned int _nfft,
     return NULL;
 }
 
+// get method requested with LIQUID_FFT_FORCE_* flag, falling back to
+// the estimated method if it cannot compute a transform of this size
+static liquid_fft_method FFT(_get_forced_method)(unsigned int _nfft,
+                                                 int          _force)
+{
+    int prime = liquid_is_prime(_nfft);
+    liquid_fft_method method = LIQUID_FFT_METHOD_UNKNOWN;
+    int valid = 0;
+    switch (_force) {
+    case LIQUID_FFT_FORCE_RADIX2:
+        method = LIQUID_FFT_METHOD_RADIX2;
+        valid  = _nfft > 1 && fft_is_radix2(_nfft);
+        break;
+    case LIQUID_FFT_FORCE_MIXED_RADIX:
+        method = LIQUID_FFT_METHOD_MIXED_RADIX;
+        valid  = _nfft > 3 && !prime;
+        break;
+    case LIQUID_FFT_FORCE_RADER:
+        method = LIQUID_FFT_METHOD_RADER;
+        valid  = _nfft > 2 && prime;
+        break;
+    case LIQUID_FFT_FORCE_RADER2:
+        method = LIQUID_FFT_METHOD_RADER2;
+        valid  = _nfft > 2 && prime;
+        break;
+    case LIQUID_FFT_FORCE_DFT:
+        method = LIQUID_FFT_METHOD_DFT;
+        valid  = 1;
+        break;
+    case LIQUID_FFT_FORCE_STOCKHAM: {
+        unsigned int radix[LIQUID_FFT_STOCKHAM_MAX_STAGES];
+        method = LIQUID_FFT_METHOD_STOCKHAM;
+        valid  = fft_stockham_factor(_nfft, radix) > 0;
+        } break;
+    default:
+        fprintf(stderr,"error: fft_create_plan(), invalid method override flag\n");
+        exit(1);
+    }
+
+    if (!valid) {
+        fprintf(stderr,"warning: fft_create_plan(), forced method cannot compute %u-point transform; using default\n", _nfft);
+        return liquid_fft_estimate_method(_nfft);
+    }
+    return method;
+}
+
+// get monotonic time [seconds]
+static double FFT(_measure_clock)(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + 1e-9*(double)t.tv_nsec;
+}
+
+// measure average execution time of plan [seconds]
+static double FFT(_measure_plan)(FFT(plan) _q)
+{
+    // warm up caches
+    FFT(_execute)(_q);
+
+    // double number of trials until run time is long enough to measure
+    unsigned long num_trials = 1;
+    while (1) {
+        unsigned long i;
+        double t0 = FFT(_measure_clock)();
+        for (i=0; i<num_trials; i++)
+            FFT(_execute)(_q);
+        double dt = FFT(_measure_clock)() - t0;
+
+        if (dt >= LIQUID_FFT_MEASURE_TIME || num_trials >= (1UL<<20))
+            return dt / (double)num_trials;
+
+        num_trials <<= 1;
+    }
+    return 0.0;
+}
+
+// measure candidate plan, keeping it if faster than current best and
+// destroying it otherwise
+static void FFT(_measure_candidate)(FFT(plan)   _q,
+                                    FFT(plan) * _best,
+                                    double *    _best_time)
+{
+    double t = FFT(_measure_plan)(_q);
+    if (*_best == NULL || t < *_best_time) {
+        if (*_best != NULL)
+            FFT(_destroy_plan)(*_best);
+        *_best      = _q;
+        *_best_time = t;
+    } else {
+        FFT(_destroy_plan)(_q);
+    }
+}
+
+// create FFT plan by timing each method (and each factorization for
+// mixed-radix transforms) which can compute a transform of this size
+static FFT(plan) FFT(_create_plan_measure)(unsigned int _nfft,
+                                           TC *         _x,
+                                           TC *         _y,
+                                           int          _dir,
+                                           int          _flags)
+{
+    unsigned int i;
+
+    // run candidates on internal buffers so that user arrays are
+    // not overwritten
+    TC * x = (TC*) liquid_malloc(_nfft*sizeof(TC));
+    TC * y = (TC*) liquid_malloc(_nfft*sizeof(TC));
+    for (i=0; i<_nfft; i++)
+        x[i] = (T)((int)(i % 7) - 3) + _Complex_I*(T)((int)(i % 5) - 2);
+
+    FFT(plan) best = NULL;
+    double best_time = 0.0;
+
+    if (_nfft <= LIQUID_FFT_MEASURE_DFT_MAX || _nfft < 4)
+        FFT(_measure_candidate)(FFT(_create_plan_dft)(_nfft, x, y, _dir, _flags), &best, &best_time);
+
+    if (_nfft > 1 && fft_is_radix2(_nfft))
+        FFT(_measure_candidate)(FFT(_create_plan_radix2)(_nfft, x, y, _dir, _flags), &best, &best_time);
+
+    unsigned int radix[LIQUID_FFT_STOCKHAM_MAX_STAGES];
+    if (fft_stockham_factor(_nfft, radix) > 0)
+        FFT(_measure_candidate)(FFT(_create_plan_stockham)(_nfft, x, y, _dir, _flags), &best, &best_time);
+
+    if (_nfft > 2 && liquid_is_prime(_nfft)) {
+        FFT(_measure_candidate)(FFT(_create_plan_rader)( _nfft, x, y, _dir, _flags), &best, &best_time);
+        FFT(_measure_candidate)(FFT(_create_plan_rader2)(_nfft, x, y, _dir, _flags), &best, &best_time);
+    } else if (_nfft > 3) {
+        // every factorization _nfft = P*Q
+        unsigned int Q;
+        for (Q=2; Q<_nfft; Q++) {
+            if ((_nfft % Q) == 0)
+                FFT(_measure_candidate)(FFT(_create_plan_mixed_radix_factor)(_nfft, x, y, _dir, _flags, Q), &best, &best_time);
+        }
+    }
+
+    // remember fastest method
+    FFT(_wisdom_store)(_nfft, _dir, best->method,
+                       best->method == LIQUID_FFT_METHOD_MIXED_RADIX ? best->data.mixedradix.Q : 0);
+
+    // point plan to user arrays; sub-transforms only operate on
+    // internally allocated buffers
+    best->x = _x;
+    best->y = _y;
+    liquid_free(x);
+    liquid_free(y);
+
+    return best;
+}
+
+// create FFT plan, regular complex one-dimensional transform
+//  _nfft   :   FFT size
+//  _x      :   input array [size: _nfft x 1]
+//  _y      :   output array [size: _nfft x 1]
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags: LIQUID_FFT_ESTIMATE (default), LIQUID_FFT_MEASURE
+//              or a single LIQUID_FFT_FORCE_* method override
+// Unless a method is forced, existing wisdom for this size and
+// direction is used regardless of the planning mode.
+FFT(plan) FFT(_create_plan)(unsigned int _nfft,
+                            TC *         _x,
+                            TC *         _y,
+                            int          _dir,
+                            int          _flags)
+{
+    // method override only applies to this transform, not to its
+    // sub-transforms
+    int force = _flags &  LIQUID_FFT_FORCE_MASK;
+    int flags = _flags & ~LIQUID_FFT_FORCE_MASK;
+
+    if (force)
+        return FFT(_create_plan_method)(_nfft, _x, _y, _dir, flags, FFT(_get_forced_method)(_nfft, force));
+
+    // re-use previous measurement (or imported wisdom)
+    liquid_fft_method w_method;
+    unsigned int      w_Q;
+    if (FFT(_wisdom_lookup)(_nfft, _dir, &w_method, &w_Q)) {
+        if (w_method == LIQUID_FFT_METHOD_MIXED_RADIX)
+            return FFT(_create_plan_mixed_radix_factor)(_nfft, _x, _y, _dir, flags, w_Q);
+        return FFT(_create_plan_method)(_nfft, _x, _y, _dir, flags, w_method);
+    }
+
+    if (flags & LIQUID_FFT_MEASURE)
+        return FFT(_create_plan_measure)(_nfft, _x, _y, _dir, flags);
+
+    // determine best method for execution based on size
+    liquid_fft_method method = liquid_fft_estimate_method(_nfft);
+    return FFT(_create_plan_method)(_nfft, _x, _y, _dir, flags, method);
+}
+
 // destroy FFT plan
 void FFT(_destroy_plan)(FFT(plan) _q)
 {
@@ -160,6 +499,10 @@ void FFT(_destroy_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: FFT(_destroy_plan_mixed_radix)(_q); return;
         case LIQUID_FFT_METHOD_RADER:       FFT(_destroy_plan_rader)(_q);       return;
         case LIQUID_FFT_METHOD_RADER2:      FFT(_destroy_plan_rader2)(_q);      return;
+        case LIQUID_FFT_METHOD_BATCH:       FFT(_destroy_plan_many)(_q);        return;
+        case LIQUID_FFT_METHOD_STOCKHAM:    FFT(_destroy_plan_stockham)(_q);    return;
+        case LIQUID_FFT_METHOD_PRUNED:      FFT(_destroy_plan_pruned)(_q);      return;
+        case LIQUID_FFT_METHOD_SPLIT:       FFT(_destroy_plan_split)(_q);       return;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
@@ -183,6 +526,12 @@ void FFT(_destroy_plan)(FFT(plan) _q)
     case LIQUID_FFT_MDCT:   break;
     case LIQUID_FFT_IMDCT:  break;
 
+    // real-to-complex/complex-to-real transforms
+    case LIQUID_FFT_R2C:
+    case LIQUID_FFT_C2R:
+        FFT(_destroy_plan_r2c)(_q);
+        break;
+
     case LIQUID_FFT_UNKNOWN:
     default:
         fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft type\n");
@@ -206,6 +555,10 @@ void FFT(_print_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: printf("Cooley-Tukey\n");       break;
         case LIQUID_FFT_METHOD_RADER:       printf("Rader (Type I)\n");     break;
         case LIQUID_FFT_METHOD_RADER2:      printf("Rader (Type II)\n");    break;
+        case LIQUID_FFT_METHOD_BATCH:       printf("batch\n");              break;
+        case LIQUID_FFT_METHOD_STOCKHAM:    printf("Stockham\n");           break;
+        case LIQUID_FFT_METHOD_PRUNED:      printf("pruned\n");             break;
+        case LIQUID_FFT_METHOD_SPLIT:       printf("split-complex\n");      break;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
@@ -224,13 +577,19 @@ void FFT(_print_plan)(FFT(plan) _q)
     case LIQUID_FFT_RODFT10:
     case LIQUID_FFT_RODFT01:
     case LIQUID_FFT_RODFT11:
-        FFT(_print_plan)(_q);
+        FFT(_print_plan_r2r_1d)(_q);
         break;
 
     // modified discrete cosine transform
     case LIQUID_FFT_MDCT:   break;
     case LIQUID_FFT_IMDCT:  break;
 
+    // real-to-complex/complex-to-real transforms
+    case LIQUID_FFT_R2C:
+    case LIQUID_FFT_C2R:
+        FFT(_print_plan_r2c)(_q);
+        break;
+
     case LIQUID_FFT_UNKNOWN:
     default:
         fprintf(stderr,"error: fft_print_plan(), unknown/invalid fft type\n");
@@ -238,6 +597,77 @@ void FFT(_print_plan)(FFT(plan) _q)
     }
 }
 
+// get memory footprint of plan, its buffers and sub-transforms [bytes];
+// shared transform tables (see fft_tables.c) belong to the process
+// rather than to any one plan and are not counted
+unsigned long int FFT(_get_memory_usage)(FFT(plan) _q)
+{
+    unsigned long int n = sizeof(struct FFT(plan_s));
+    unsigned int l;
+
+    // only the complex transforms and the real-to-complex transforms
+    // allocate memory beyond the plan itself
+    if (_q->type == LIQUID_FFT_R2C || _q->type == LIQUID_FFT_C2R) {
+        unsigned int len = (_q->nfft % 2) ? _q->nfft : _q->nfft/2;
+        return n + 2*len*sizeof(TC) + FFT(_get_memory_usage)(_q->data.r2c.fft);
+    } else if (_q->type != LIQUID_FFT_FORWARD && _q->type != LIQUID_FFT_BACKWARD) {
+        return n;
+    }
+
+    switch (_q->method) {
+    case LIQUID_FFT_METHOD_MIXED_RADIX:
+        l = _q->data.mixedradix.P > _q->data.mixedradix.Q ?
+            _q->data.mixedradix.P : _q->data.mixedradix.Q;
+        n += (2*l + _q->nfft)*sizeof(TC);
+        n += FFT(_get_memory_usage)(_q->data.mixedradix.fft_P);
+        n += FFT(_get_memory_usage)(_q->data.mixedradix.fft_Q);
+        break;
+    case LIQUID_FFT_METHOD_RADER:
+        n += 2*(_q->nfft-1)*sizeof(TC);
+        n += FFT(_get_memory_usage)(_q->data.rader.fft);
+        n += FFT(_get_memory_usage)(_q->data.rader.ifft);
+        break;
+    case LIQUID_FFT_METHOD_RADER2:
+        n += 2*_q->data.rader2.nfft_prime*sizeof(TC);
+        n += FFT(_get_memory_usage)(_q->data.rader2.fft);
+        n += FFT(_get_memory_usage)(_q->data.rader2.ifft);
+        break;
+    case LIQUID_FFT_METHOD_BATCH:
+        if (_q->data.many.fft == NULL) {
+            n += _q->nfft*_q->data.many.howmany*sizeof(TC);
+        } else {
+            n += 2*_q->nfft*sizeof(TC);
+            n += FFT(_get_memory_usage)(_q->data.many.fft);
+        }
+        break;
+    case LIQUID_FFT_METHOD_STOCKHAM:
+        n += _q->nfft*sizeof(TC);
+        break;
+    case LIQUID_FFT_METHOD_PRUNED:
+        n += (_q->data.pruned.len*_q->nfft + _q->data.pruned.len)*sizeof(TC);
+        if (_q->data.pruned.dp != NULL) {
+            n += _q->data.pruned.len*sizeof(dotprod_cccf);
+            for (l=0; l<_q->data.pruned.len; l++)
+                n += dotprod_cccf_get_memory_usage(_q->data.pruned.dp[l]);
+        }
+        break;
+    case LIQUID_FFT_METHOD_SPLIT:
+        if (_q->data.split.fft != NULL) {
+            n += 2*_q->nfft*sizeof(TC);
+            n += FFT(_get_memory_usage)(_q->data.split.fft);
+        } else {
+            // split copy of twiddles: W^i and W^(2i) per radix-4 stage
+            for (l=(_q->data.split.m & 1) ? 2 : 1; l<_q->nfft; l*=4)
+                n += 4*l*sizeof(T);
+        }
+        break;
+    default:
+        // DFT and radix-2 transforms use shared tables only
+        break;
+    }
+    return n;
+}
+
 // print FFT plan (recursively)
 void FFT(_print_plan_recursive)(FFT(plan)    _q,
                                 unsigned int _level)
@@ -276,6 +706,41 @@ void FFT(_print_plan_recursive)(FFT(plan)    _q,
         FFT(_print_plan_recursive)(_q->data.rader2.fft, _level+1);
         break;
 
+    case LIQUID_FFT_METHOD_STOCKHAM:
+        printf("Stockham auto-sort, radix=");
+        for (i=0; i<_q->data.stockham.num_stages; i++)
+            printf("%s%u", i==0 ? "" : ",", _q->data.stockham.radix[i]);
+        printf("\n");
+        break;
+
+    case LIQUID_FFT_METHOD_BATCH:
+        printf("batch of %u transforms\n", _q->data.many.howmany);
+        if (_q->data.many.fft == NULL) {
+            for (i=0; i<_level+1; i++)
+                printf("  ");
+            printf("%u, Radix-2 (interleaved)\n", _q->nfft);
+        } else {
+            FFT(_print_plan_recursive)(_q->data.many.fft, _level+1);
+        }
+        break;
+
+    case LIQUID_FFT_METHOD_PRUNED:
+        printf("%s pruned to %u bins from %u\n",
+                _q->data.pruned.prune == LIQUID_FFT_PRUNE_INPUT ? "input" : "output",
+                _q->data.pruned.len, _q->data.pruned.k0);
+        break;
+
+    case LIQUID_FFT_METHOD_SPLIT:
+        printf("split-complex\n");
+        if (_q->data.split.fft == NULL) {
+            for (i=0; i<_level+1; i++)
+                printf("  ");
+            printf("%u, Radix-2 (split)\n", _q->nfft);
+        } else {
+            FFT(_print_plan_recursive)(_q->data.split.fft, _level+1);
+        }
+        break;
+
     case LIQUID_FFT_METHOD_UNKNOWN:     printf("(unknown)\n");      break;
     default:                            printf("(unknown)\n");      break;
     }
@@ -42,7 +42,7 @@ FFT(plan) FFT(_create_plan_dft)(unsigned int _nfft,
                                 int          _flags)
 {
     // allocate plan and initialize all internal arrays to NULL
-    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
 
     q->nfft      = _nfft;
     q->x         = _x;
@@ -67,11 +67,16 @@ FFT(plan) FFT(_create_plan_dft)(unsigned int _nfft,
     else {
         q->execute = FFT(_execute_dft);
 
-        // initialize twiddle factors
-        q->data.dft.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
+        // re-use shared dotprod objects if they exist
+        q->data.dft.dotprod = (DOTPROD()*) FFT(_table_find)(LIQUID_FFT_TABLE_DFT, q->nfft, q->direction);
+        if (q->data.dft.dotprod != NULL)
+            return q;
+
+        // initialize twiddle factors (one row at a time)
+        TC * twiddle = (TC *) liquid_malloc(q->nfft * sizeof(TC));
 
         // create dotprod objects
-        q->data.dft.dotprod = (DOTPROD()*) malloc(q->nfft * sizeof(DOTPROD()));
+        DOTPROD() * dotprod = (DOTPROD()*) liquid_malloc(q->nfft * sizeof(DOTPROD()));
         
         // create dotprod objects
         // twiddles: exp(-j*2*pi*W/n), W=
@@ -89,11 +94,13 @@ FFT(plan) FFT(_create_plan_dft)(unsigned int _nfft,
             // initialize twiddle factors
             // NOTE: no need to compute first twiddle because exp(-j*2*pi*0) = 1
             for (k=1; k<q->nfft; k++)
-                q->data.dft.twiddle[k-1] = cexpf(_Complex_I*d*2*M_PI*(T)(k*i) / (T)(q->nfft));
+                twiddle[k-1] = cexpf(_Complex_I*d*2*M_PI*(T)((k*i) % q->nfft) / (T)(q->nfft));
 
             // create dotprod object
-            q->data.dft.dotprod[i] = DOTPROD(_create)(q->data.dft.twiddle, q->nfft-1);
+            dotprod[i] = DOTPROD(_create)(twiddle, q->nfft-1);
         }
+        liquid_free(twiddle);
+        q->data.dft.dotprod = (DOTPROD()*) FFT(_table_insert)(LIQUID_FFT_TABLE_DFT, q->nfft, q->direction, dotprod);
     }
 
     return q;
@@ -102,22 +109,11 @@ FFT(plan) FFT(_create_plan_dft)(unsigned int _nfft,
 // destroy FFT plan
 void FFT(_destroy_plan_dft)(FFT(plan) _q)
 {
-    // free twiddle factors
-    if (_q->data.dft.twiddle != NULL)
-        free(_q->data.dft.twiddle);
-
-    // free dotprod objects
-    if (_q->data.dft.dotprod != NULL) {
-        unsigned int i;
-        for (i=0; i<_q->nfft; i++)
-            DOTPROD(_destroy)(_q->data.dft.dotprod[i]);
-
-        // free dotprod array
-        free(_q->data.dft.dotprod);
-    }
+    // release shared dotprod objects
+    FFT(_table_release)(_q->data.dft.dotprod);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // execute DFT (slow but functionally correct)
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_many.c : batches of equal-size transforms
+//
+// Radix-2 sizes gather all transforms into one interleaved buffer
+// (value i of transform b at buf[i*howmany + b]) and run the radix-4
+// stages across the whole batch, so each twiddle factor is loaded
+// once per butterfly and shared by every transform. Other sizes run
+// a single plan on each transform in turn.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create plan computing _howmany transforms of size _n
+//  _n      :   transform size
+//  _howmany:   number of transforms
+//  _x      :   input array
+//  _istride:   input sample stride within a transform
+//  _idist  :   input distance between transforms
+//  _y      :   output array
+//  _ostride:   output sample stride within a transform
+//  _odist  :   output distance between transforms
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags (see fft_create_plan())
+FFT(plan) FFT(_create_plan_many)(unsigned int _n,
+                                 unsigned int _howmany,
+                                 TC *         _x,
+                                 unsigned int _istride,
+                                 unsigned int _idist,
+                                 TC *         _y,
+                                 unsigned int _ostride,
+                                 unsigned int _odist,
+                                 int          _dir,
+                                 int          _flags)
+{
+    if (_n == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), transform size must be greater than zero\n");
+        exit(1);
+    } else if (_howmany == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), number of transforms must be greater than zero\n");
+        exit(1);
+    } else if (_istride == 0 || _ostride == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), strides must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _n;
+    q->x         = _x;
+    q->y         = _y;
+    q->xr        = NULL;
+    q->yr        = NULL;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_BATCH;
+    q->execute   = FFT(_execute_many);
+
+    q->data.many.howmany   = _howmany;
+    q->data.many.istride   = _istride;
+    q->data.many.idist     = _idist;
+    q->data.many.ostride   = _ostride;
+    q->data.many.odist     = _odist;
+    q->data.many.m         = 0;
+    q->data.many.index_rev = NULL;
+    q->data.many.twiddle   = NULL;
+    q->data.many.buf       = NULL;
+    q->data.many.x         = NULL;
+    q->data.many.y         = NULL;
+    q->data.many.fft       = NULL;
+
+    // run interleaved radix-2 transforms unless another method is forced
+    int force = _flags & LIQUID_FFT_FORCE_MASK;
+    if (_n > 1 && fft_is_radix2(_n) && (force == 0 || force == LIQUID_FFT_FORCE_RADIX2)) {
+        q->data.many.m = liquid_msb_index(_n) - 1;  // m = log2(nfft)
+
+        q->data.many.index_rev = FFT(_table_index_rev)(_n);
+        q->data.many.twiddle   = FFT(_table_twiddle_radix2)(_n, q->direction);
+        q->data.many.buf       = (TC *) liquid_malloc_aligned(_n*_howmany*sizeof(TC));
+    } else {
+        q->data.many.x   = (TC *) liquid_malloc(_n*sizeof(TC));
+        q->data.many.y   = (TC *) liquid_malloc(_n*sizeof(TC));
+        q->data.many.fft = FFT(_create_plan)(_n, q->data.many.x, q->data.many.y, _dir, _flags);
+    }
+
+    return q;
+}
+
+// destroy batch plan
+void FFT(_destroy_plan_many)(FFT(plan) _q)
+{
+    if (_q->data.many.fft == NULL) {
+        FFT(_table_release)(_q->data.many.index_rev);
+        FFT(_table_release)(_q->data.many.twiddle);
+        liquid_free_aligned(_q->data.many.buf);
+    } else {
+        FFT(_destroy_plan)(_q->data.many.fft);
+        liquid_free(_q->data.many.x);
+        liquid_free(_q->data.many.y);
+    }
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// execute batch of transforms
+void FFT(_execute_many)(FFT(plan) _q)
+{
+    unsigned int n  = _q->nfft;
+    unsigned int H  = _q->data.many.howmany;
+    unsigned int is = _q->data.many.istride;
+    unsigned int id = _q->data.many.idist;
+    unsigned int os = _q->data.many.ostride;
+    unsigned int od = _q->data.many.odist;
+    unsigned int i, b;
+
+    if (_q->data.many.fft != NULL) {
+        // run each transform in turn
+        for (b=0; b<H; b++) {
+            for (i=0; i<n; i++)
+                _q->data.many.x[i] = _q->x[b*id + i*is];
+            FFT(_execute)(_q->data.many.fft);
+            for (i=0; i<n; i++)
+                _q->y[b*od + i*os] = _q->data.many.y[i];
+        }
+        return;
+    }
+
+    // gather bit-reversed input of all transforms into interleaved
+    // buffer; every input is read before any output is written, so
+    // the transforms may run in place
+    TC * buf = _q->data.many.buf;
+    for (i=0; i<n; i++) {
+        TC * x = _q->x + _q->data.many.index_rev[i]*is;
+        TC * v = buf + i*H;
+        for (b=0; b<H; b++)
+            v[b] = x[b*id];
+    }
+
+    unsigned int L = 1;
+
+    // odd number of radix-2 stages: start with a single stage of
+    // 2-point butterflies
+    if (_q->data.many.m & 1) {
+        for (i=0; i<n*H; i+=2*H) {
+            for (b=0; b<H; b++) {
+                TC yp        = buf[i+H+b];
+                buf[i+H+b]   = buf[i+b] - yp;
+                buf[i+b]    += yp;
+            }
+        }
+        L = 2;
+    }
+
+    // remaining stages combined pairwise in radix-4 butterflies
+    TC * w = _q->data.many.twiddle;
+    for ( ; L<n; L*=4) {
+        fft_radix4_stage_batch(buf, n, L, w, H, _q->direction);
+        w += 2*L;
+    }
+
+    // scatter result
+    for (i=0; i<n; i++) {
+        TC * y = _q->y + i*os;
+        TC * v = buf + i*H;
+        for (b=0; b<H; b++)
+            y[b*od] = v[b];
+    }
+}
@@ -44,9 +44,35 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
                                         TC *         _y,
                                         int          _dir,
                                         int          _flags)
+{
+    // find first 'prime' factor of _nfft
+    unsigned int Q = FFT(_estimate_mixed_radix)(_nfft);
+
+    // estimate may select a codelet for the whole transform (e.g.
+    // _nfft=16); split off smallest factor instead
+    if (Q == _nfft) {
+        for (Q=2; Q<_nfft && (_nfft % Q) != 0; Q++);
+    }
+
+    return FFT(_create_plan_mixed_radix_factor)(_nfft, _x, _y, _dir, _flags, Q);
+}
+
+// create mixed-radix FFT plan with explicit factorization
+//  _nfft   :   FFT size
+//  _x      :   input array [size: _nfft x 1]
+//  _y      :   output array [size: _nfft x 1]
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags
+//  _Q      :   number of P-point transforms, 1 < _Q < _nfft, _nfft = P*_Q
+FFT(plan) FFT(_create_plan_mixed_radix_factor)(unsigned int _nfft,
+                                               TC *         _x,
+                                               TC *         _y,
+                                               int          _dir,
+                                               int          _flags,
+                                               unsigned int _Q)
 {
     // allocate plan and initialize all internal arrays to NULL
-    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
 
     q->nfft      = _nfft;
     q->x         = _x;
@@ -58,12 +84,13 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
 
     q->execute   = FFT(_execute_mixed_radix);
 
-    // find first 'prime' factor of _nfft
-    unsigned int i;
-    unsigned int Q = FFT(_estimate_mixed_radix)(_nfft);
+    unsigned int Q = _Q;
     if (Q==0) {
         fprintf(stderr,"error: fft_create_plan_mixed_radix(), _nfft=%u is prime\n", _nfft);
         exit(1);
+    } else if (Q == 1 || Q >= _nfft) {
+        fprintf(stderr,"error: fft_create_plan_mixed_radix(), invalid factor Q=%u for _nfft=%u\n", Q, _nfft);
+        exit(1);
     } else if ( (_nfft % Q) != 0 ) {
         fprintf(stderr,"error: fft_create_plan_mixed_radix(), _nfft=%u is not divisible by Q=%u\n", _nfft, Q);
         exit(1);
@@ -76,11 +103,11 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
 
     // allocate memory for buffers
     unsigned int t_len = Q > P ? Q : P;
-    q->data.mixedradix.t0 = (TC *) malloc(t_len * sizeof(TC));
-    q->data.mixedradix.t1 = (TC *) malloc(t_len * sizeof(TC));
+    q->data.mixedradix.t0 = (TC *) liquid_malloc(t_len * sizeof(TC));
+    q->data.mixedradix.t1 = (TC *) liquid_malloc(t_len * sizeof(TC));
 
     // allocate memory for input buffers
-    q->data.mixedradix.x = (TC *) malloc(q->nfft * sizeof(TC));
+    q->data.mixedradix.x = (TC *) liquid_malloc(q->nfft * sizeof(TC));
 
     // create P-point FFT plan
     q->data.mixedradix.fft_P = FFT(_create_plan)(q->data.mixedradix.P,
@@ -96,13 +123,8 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
                                                  q->direction,
                                                  q->flags);
 
-    // initialize twiddle factors, indices for mixed-radix transforms
-    // TODO : only allocate necessary twiddle factors
-    q->data.mixedradix.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
-    
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft; i++)
-        q->data.mixedradix.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
+    // shared twiddle factors for mixed-radix transforms
+    q->data.mixedradix.twiddle = FFT(_table_twiddle)(q->nfft, q->direction);
 
     return q;
 }
@@ -115,13 +137,13 @@ void FFT(_destroy_plan_mixed_radix)(FFT(plan) _q)
     FFT(_destroy_plan)(_q->data.mixedradix.fft_Q);
 
     // free data specific to mixed-radix transforms
-    free(_q->data.mixedradix.t0);
-    free(_q->data.mixedradix.t1);
-    free(_q->data.mixedradix.x);
-    free(_q->data.mixedradix.twiddle);
+    liquid_free(_q->data.mixedradix.t0);
+    liquid_free(_q->data.mixedradix.t1);
+    liquid_free(_q->data.mixedradix.x);
+    FFT(_table_release)(_q->data.mixedradix.twiddle);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // execute mixed-radix FFT
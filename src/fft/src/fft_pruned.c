@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_pruned.c : transforms with known-zero inputs or unneeded outputs
+//
+// Both variants restrict one side of the transform to a cyclic band
+// of _len bins starting at _k0 and evaluate the transform directly on
+// that band, with W = exp(d*j*2*pi/n):
+//
+//  input pruned  (x zero outside band):
+//    y[i] = sum_l x[k0+l] W^((k0+l)*i)
+//
+//  output pruned (only y on band needed):
+//    y[k0+l] = sum_i x[i] W^((k0+l)*i)
+//
+// The output-pruned variant runs one vectorized dot product per band
+// bin; the input-pruned variant accumulates one scaled row of the
+// transform matrix per band bin. Decomposing the band into smaller
+// transforms did not outrun the regular radix-2
+// kernels here, so bands for which the direct evaluation is not
+// expected to be faster fall back to a regular plan.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create pruned FFT plan (see liquid.h)
+//  _n      :   transform size
+//  _x      :   input array [size: _n x 1]
+//  _y      :   output array [size: _n x 1]
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags (see fft_create_plan())
+//  _k0     :   first bin of band
+//  _len    :   band length, 0 < _len <= _n
+//  _prune  :   pruned side: {LIQUID_FFT_PRUNE_INPUT, LIQUID_FFT_PRUNE_OUTPUT}
+FFT(plan) FFT(_create_plan_pruned)(unsigned int _n,
+                                   TC *         _x,
+                                   TC *         _y,
+                                   int          _dir,
+                                   int          _flags,
+                                   unsigned int _k0,
+                                   unsigned int _len,
+                                   int          _prune)
+{
+    if (_n == 0) {
+        fprintf(stderr,"error: fft_create_plan_pruned(), transform size must be greater than zero\n");
+        exit(1);
+    } else if (_len == 0 || _len > _n) {
+        fprintf(stderr,"error: fft_create_plan_pruned(), band length must be in [1,%u]\n", _n);
+        exit(1);
+    } else if (_k0 >= _n) {
+        fprintf(stderr,"error: fft_create_plan_pruned(), first bin must be less than %u\n", _n);
+        exit(1);
+    } else if (_prune != LIQUID_FFT_PRUNE_INPUT && _prune != LIQUID_FFT_PRUNE_OUTPUT) {
+        fprintf(stderr,"error: fft_create_plan_pruned(), invalid pruning type\n");
+        exit(1);
+    }
+
+    // compare cost of direct evaluation (per band bin and sample)
+    // against a regular transform (per sample and stage)
+    float cost_fft    = (float)_n * log2f((float)_n);
+    float cost_direct = (float)_n * (float)_len *
+        (_prune == LIQUID_FFT_PRUNE_INPUT ? LIQUID_FFT_PRUNE_COST_INPUT
+                                          : LIQUID_FFT_PRUNE_COST_OUTPUT);
+    if (cost_direct >= cost_fft)
+        return FFT(_create_plan)(_n, _x, _y, _dir, _flags);
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _n;
+    q->x         = _x;
+    q->y         = _y;
+    q->xr        = NULL;
+    q->yr        = NULL;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_PRUNED;
+    q->execute   = (_prune == LIQUID_FFT_PRUNE_INPUT) ? FFT(_execute_pruned_input)
+                                                      : FFT(_execute_pruned_output);
+
+    q->data.pruned.prune = _prune;
+    q->data.pruned.k0    = _k0;
+    q->data.pruned.len   = _len;
+
+    // transform matrix rows W^((k0+l)*i) for l in [0,len), i in [0,n)
+    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    unsigned int i, l;
+    q->data.pruned.twiddle = (TC *) liquid_malloc(_len*_n*sizeof(TC));
+    for (l=0; l<_len; l++) {
+        unsigned int k = (_k0 + l) % _n;
+        for (i=0; i<_n; i++)
+            q->data.pruned.twiddle[l*_n + i] = cexpf(_Complex_I*d*2*M_PI*(T)((k*i) % _n) / (T)_n);
+    }
+    q->data.pruned.buf = (TC *) liquid_malloc(_len*sizeof(TC));
+
+    // one dot product per band bin for output pruning
+    q->data.pruned.dp = NULL;
+    if (_prune == LIQUID_FFT_PRUNE_OUTPUT) {
+        q->data.pruned.dp = (dotprod_cccf *) liquid_malloc(_len*sizeof(dotprod_cccf));
+        for (l=0; l<_len; l++)
+            q->data.pruned.dp[l] = dotprod_cccf_create(&q->data.pruned.twiddle[l*_n], _n);
+    }
+
+    return q;
+}
+
+// destroy pruned plan
+void FFT(_destroy_plan_pruned)(FFT(plan) _q)
+{
+    unsigned int l;
+    if (_q->data.pruned.dp != NULL) {
+        for (l=0; l<_q->data.pruned.len; l++)
+            dotprod_cccf_destroy(_q->data.pruned.dp[l]);
+        liquid_free(_q->data.pruned.dp);
+    }
+    liquid_free(_q->data.pruned.twiddle);
+    liquid_free(_q->data.pruned.buf);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// execute input-pruned transform
+void FFT(_execute_pruned_input)(FFT(plan) _q)
+{
+    unsigned int n   = _q->nfft;
+    unsigned int k0  = _q->data.pruned.k0;
+    unsigned int len = _q->data.pruned.len;
+    unsigned int i, l;
+
+    // read band before any output is written so that the transform
+    // may run in place
+    for (l=0; l<len; l++)
+        _q->data.pruned.buf[l] = _q->x[(k0 + l) % n];
+
+    // accumulate scaled matrix rows in real arithmetic (avoids the
+    // special-value handling of the C complex product and vectorizes)
+    T * restrict y = (T *) _q->y;
+    memset(y, 0, n*sizeof(TC));
+    for (l=0; l<len; l++) {
+        T vr = crealf(_q->data.pruned.buf[l]);
+        T vi = cimagf(_q->data.pruned.buf[l]);
+        const T * restrict w = (const T *) &_q->data.pruned.twiddle[l*n];
+        for (i=0; i<n; i++) {
+            T wr = w[2*i  ];
+            T wi = w[2*i+1];
+            y[2*i  ] += vr*wr - vi*wi;
+            y[2*i+1] += vr*wi + vi*wr;
+        }
+    }
+}
+
+// execute output-pruned transform
+void FFT(_execute_pruned_output)(FFT(plan) _q)
+{
+    unsigned int n   = _q->nfft;
+    unsigned int k0  = _q->data.pruned.k0;
+    unsigned int len = _q->data.pruned.len;
+    unsigned int l;
+
+    // compute band completely before writing so that the transform
+    // may run in place
+    for (l=0; l<len; l++)
+        dotprod_cccf_execute(_q->data.pruned.dp[l], _q->x, &_q->data.pruned.buf[l]);
+    for (l=0; l<len; l++)
+        _q->y[(k0 + l) % n] = _q->data.pruned.buf[l];
+}
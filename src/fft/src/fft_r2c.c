@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_r2c.c : real-to-complex and complex-to-real transforms
+//
+// For even sizes the n real samples are packed into n/2 complex
+// values z[k] = x[2k] + j*x[2k+1] and transformed with a half-length
+// complex FFT; the spectra of the even and odd samples are then
+// separated using the symmetry of real sequences and combined with
+// one final radix-2 step. The inverse runs the same steps backwards.
+// Odd sizes fall back to a full-length complex transform.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create real-to-complex or complex-to-real plan
+static FFT(plan) FFT(_create_plan_r2c_internal)(unsigned int _nfft,
+                                                int          _type,
+                                                int          _flags)
+{
+    if (_nfft == 0) {
+        fprintf(stderr,"error: fft_create_plan_%s_1d(), transform size must be greater than zero\n",
+                _type == LIQUID_FFT_R2C ? "r2c" : "c2r");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->x         = NULL;
+    q->y         = NULL;
+    q->xr        = NULL;
+    q->yr        = NULL;
+    q->flags     = _flags;
+    q->type      = _type;
+    q->direction = _type == LIQUID_FFT_R2C ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_UNKNOWN;
+    q->execute   = _type == LIQUID_FFT_R2C ? FFT(_execute_r2c) : FFT(_execute_c2r);
+
+    // sub-transform buffers
+    unsigned int n = (q->nfft % 2) ? q->nfft : q->nfft/2;
+    q->data.r2c.z = (TC *) liquid_malloc(n*sizeof(TC));
+    q->data.r2c.Z = (TC *) liquid_malloc(n*sizeof(TC));
+
+    // twiddle factors for separating even/odd spectra: first half of
+    // shared forward twiddles, exp(-j*2*pi*k/nfft)
+    q->data.r2c.twiddle = NULL;
+    if ((q->nfft % 2) == 0)
+        q->data.r2c.twiddle = FFT(_table_twiddle)(q->nfft, LIQUID_FFT_FORWARD);
+
+    // create complex sub-transform
+    q->data.r2c.fft = FFT(_create_plan)(n, q->data.r2c.z, q->data.r2c.Z, q->direction, _flags);
+
+    return q;
+}
+
+// create real-to-complex (forward) transform
+//  _nfft   :   FFT size
+//  _x      :   real input array [size: _nfft x 1]
+//  _y      :   output array, non-negative frequencies [size: _nfft/2+1 x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_r2c_1d)(unsigned int _nfft,
+                                   T *          _x,
+                                   TC *         _y,
+                                   int          _flags)
+{
+    FFT(plan) q = FFT(_create_plan_r2c_internal)(_nfft, LIQUID_FFT_R2C, _flags);
+    q->xr = _x;
+    q->y  = _y;
+    return q;
+}
+
+// create complex-to-real (backward, unnormalized) transform
+//  _nfft   :   FFT size
+//  _x      :   input array, non-negative frequencies [size: _nfft/2+1 x 1]
+//  _y      :   real output array [size: _nfft x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_c2r_1d)(unsigned int _nfft,
+                                   TC *         _x,
+                                   T *          _y,
+                                   int          _flags)
+{
+    FFT(plan) q = FFT(_create_plan_r2c_internal)(_nfft, LIQUID_FFT_C2R, _flags);
+    q->x  = _x;
+    q->yr = _y;
+    return q;
+}
+
+// destroy real-to-complex/complex-to-real transform plan
+void FFT(_destroy_plan_r2c)(FFT(plan) _q)
+{
+    FFT(_destroy_plan)(_q->data.r2c.fft);
+    liquid_free(_q->data.r2c.z);
+    liquid_free(_q->data.r2c.Z);
+    FFT(_table_release)(_q->data.r2c.twiddle);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// print real-to-complex/complex-to-real transform plan
+void FFT(_print_plan_r2c)(FFT(plan) _q)
+{
+    printf("fft plan [%s], n=%u, %s\n",
+            _q->type == LIQUID_FFT_R2C ? "real-to-complex" : "complex-to-real",
+            _q->nfft,
+            (_q->nfft % 2) ? "full-length complex transform" : "half-length complex transform");
+    FFT(_print_plan_recursive)(_q->data.r2c.fft, 1);
+}
+
+// execute real-to-complex transform
+void FFT(_execute_r2c)(FFT(plan) _q)
+{
+    unsigned int i;
+    TC * z = _q->data.r2c.z;
+    TC * Z = _q->data.r2c.Z;
+
+    if (_q->nfft % 2) {
+        // odd size: full-length complex transform
+        for (i=0; i<_q->nfft; i++)
+            z[i] = _q->xr[i];
+        FFT(_execute)(_q->data.r2c.fft);
+        for (i=0; i<=_q->nfft/2; i++)
+            _q->y[i] = Z[i];
+        return;
+    }
+
+    // pack pairs of real samples into half-length complex array
+    unsigned int M = _q->nfft/2;
+    T * zr = (T*) z;
+    for (i=0; i<_q->nfft; i++)
+        zr[i] = _q->xr[i];
+    FFT(_execute)(_q->data.r2c.fft);
+
+    // separate even/odd spectra E, O and combine: Y[k] = E[k] + W^k O[k]
+    T * Zr = (T*) Z;
+    T * y  = (T*) _q->y;
+    T * w  = (T*) _q->data.r2c.twiddle;
+    y[0]   = Zr[0] + Zr[1];
+    y[1]   = 0;
+    y[2*M] = Zr[0] - Zr[1];
+    y[2*M+1] = 0;
+    for (i=1; i<M; i++) {
+        T ar = Zr[2*i],     ai = Zr[2*i+1];
+        T br = Zr[2*(M-i)], bi = Zr[2*(M-i)+1];
+
+        // E = (Z[k] + conj(Z[M-k]))/2, O = (Z[k] - conj(Z[M-k]))/(2j)
+        T Er = 0.5f*(ar + br), Ei = 0.5f*(ai - bi);
+        T Or = 0.5f*(ai + bi), Oi = 0.5f*(br - ar);
+
+        T wr = w[2*i], wi = w[2*i+1];
+        y[2*i  ] = Er + wr*Or - wi*Oi;
+        y[2*i+1] = Ei + wr*Oi + wi*Or;
+    }
+}
+
+// execute complex-to-real transform
+void FFT(_execute_c2r)(FFT(plan) _q)
+{
+    unsigned int i;
+    TC * z = _q->data.r2c.z;
+    TC * Z = _q->data.r2c.Z;
+
+    if (_q->nfft % 2) {
+        // odd size: extend Hermitian input and run full-length transform
+        z[0] = _q->x[0];
+        for (i=1; i<=_q->nfft/2; i++) {
+            z[i]           = _q->x[i];
+            z[_q->nfft-i]  = conjf(_q->x[i]);
+        }
+        FFT(_execute)(_q->data.r2c.fft);
+        for (i=0; i<_q->nfft; i++)
+            _q->yr[i] = crealf(Z[i]);
+        return;
+    }
+
+    // combine non-negative frequencies into half-length spectrum of
+    // packed samples: z[k] = (X[k] + conj(X[M-k])) + j*W^-k*(X[k] - conj(X[M-k]))
+    unsigned int M = _q->nfft/2;
+    T * x  = (T*) _q->x;
+    T * zr = (T*) z;
+    T * w  = (T*) _q->data.r2c.twiddle;
+    for (i=0; i<M; i++) {
+        T ar = x[2*i],     ai = x[2*i+1];
+        T br = x[2*(M-i)], bi = x[2*(M-i)+1];
+
+        T sr = ar + br, si = ai - bi;   // X[k] + conj(X[M-k])
+        T dr = ar - br, di = ai + bi;   // X[k] - conj(X[M-k])
+
+        T wr = w[2*i], wi = w[2*i+1];
+        zr[2*i  ] = sr - (wr*di - wi*dr);
+        zr[2*i+1] = si + (wr*dr + wi*di);
+    }
+    FFT(_execute)(_q->data.r2c.fft);
+
+    // unpack real samples
+    T * Zr = (T*) Z;
+    for (i=0; i<_q->nfft; i++)
+        _q->yr[i] = Zr[i];
+}
@@ -20,15 +20,49 @@
  * THE SOFTWARE.
  */
 
+
 //
 // fft_r2r_1d.c : real-to-real methods (DCT/DST)
 //
+// Each transform is computed in O(n log n) from a single sub-transform:
+//  DCT-I/DST-I     : real transform of the even/odd extension of the
+//                    input, size 2(n-1) and 2(n+1)
+//  DCT-II/DST-II   : real transform of the even/odd-reordered input,
+//                    size n, with post-rotation by exp(-j*pi*k/(2n))
+//  DCT-III/DST-III : inverse of the above, complex-to-real transform
+//                    of size n with pre-rotation
+//  DCT-IV/DST-IV   : complex transform of size n/2 with pre- and
+//                    post-rotation (even n), or of the zero-padded,
+//                    rotated input of size 2n (odd n)
+// The DST types use the DCT of the reversed or sign-alternated input.
+//
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include "liquid.internal.h"
 
+// is real-to-real type a discrete sine transform?
+static int FFT(_r2r_is_dst)(int _type)
+{
+    return _type == LIQUID_FFT_RODFT00 || _type == LIQUID_FFT_RODFT10 ||
+           _type == LIQUID_FFT_RODFT01 || _type == LIQUID_FFT_RODFT11;
+}
+
+// compute rotation factors exp(j*pi*(_a*i + _b)/_d), i in [0,_n)
+static void FFT(_r2r_rotation)(TC *         _w,
+                               unsigned int _n,
+                               double       _a,
+                               double       _b,
+                               double       _d)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        double theta = M_PI*(_a*(double)i + _b) / _d;
+        _w[i] = cos(theta) + _Complex_I*sin(theta);
+    }
+}
+
 // create DCT/DST plan
 //  _nfft   :   FFT size
 //  _x      :   input array [size: _nfft x 1]
@@ -41,28 +75,92 @@ FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _nfft,
                                    int          _type,
                                    int          _flags)
 {
+    if (_nfft == 0) {
+        fprintf(stderr,"error: fft_create_plan_r2r_1d(), transform size must be greater than zero\n");
+        exit(1);
+    }
+
     // allocate plan and initialize all internal arrays to NULL
-    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
 
     q->nfft   = _nfft;
+    q->x      = NULL;
+    q->y      = NULL;
     q->xr     = _x;
     q->yr     = _y;
     q->type   = _type;
     q->flags  = _flags;
+    q->method = LIQUID_FFT_METHOD_UNKNOWN;
 
-    // TODO : use separate 'method' for real-to-real types
-    //q->method = LIQUID_FFT_METHOD_NONE;
+    q->data.r2r.t       = NULL;
+    q->data.r2r.z       = NULL;
+    q->data.r2r.Z       = NULL;
+    q->data.r2r.twiddle = NULL;
+    q->data.r2r.fft     = NULL;
 
+    unsigned int n = q->nfft;
+    unsigned int L;
     switch (q->type) {
-    case LIQUID_FFT_REDFT00:  q->execute = &FFT(_execute_REDFT00);  break;  // DCT-I
-    case LIQUID_FFT_REDFT10:  q->execute = &FFT(_execute_REDFT10);  break;  // DCT-II
-    case LIQUID_FFT_REDFT01:  q->execute = &FFT(_execute_REDFT01);  break;  // DCT-III
-    case LIQUID_FFT_REDFT11:  q->execute = &FFT(_execute_REDFT11);  break;  // DCT-IV
-
-    case LIQUID_FFT_RODFT00:  q->execute = &FFT(_execute_RODFT00);  break;  // DST-I
-    case LIQUID_FFT_RODFT10:  q->execute = &FFT(_execute_RODFT10);  break;  // DST-II
-    case LIQUID_FFT_RODFT01:  q->execute = &FFT(_execute_RODFT01);  break;  // DST-III
-    case LIQUID_FFT_RODFT11:  q->execute = &FFT(_execute_RODFT11);  break;  // DST-IV
+    case LIQUID_FFT_REDFT00:    // DCT-I
+    case LIQUID_FFT_RODFT00:    // DST-I
+        q->execute = q->type == LIQUID_FFT_REDFT00 ? &FFT(_execute_REDFT00) : &FFT(_execute_RODFT00);
+
+        // DCT-I of a single sample has no extension
+        if (q->type == LIQUID_FFT_REDFT00 && n == 1)
+            break;
+
+        // real transform of even/odd extension
+        L = q->type == LIQUID_FFT_REDFT00 ? 2*(n-1) : 2*(n+1);
+        q->data.r2r.t   = (T *)  liquid_malloc(L*sizeof(T));
+        q->data.r2r.Z   = (TC *) liquid_malloc((L/2+1)*sizeof(TC));
+        q->data.r2r.fft = FFT(_create_plan_r2c_1d)(L, q->data.r2r.t, q->data.r2r.Z, _flags);
+        break;
+
+    case LIQUID_FFT_REDFT10:    // DCT-II
+    case LIQUID_FFT_RODFT10:    // DST-II
+        q->execute = q->type == LIQUID_FFT_REDFT10 ? &FFT(_execute_REDFT10) : &FFT(_execute_RODFT10);
+
+        // real transform with post-rotation exp(-j*pi*k/(2n))
+        q->data.r2r.t       = (T *)  liquid_malloc(n*sizeof(T));
+        q->data.r2r.Z       = (TC *) liquid_malloc((n/2+1)*sizeof(TC));
+        q->data.r2r.twiddle = (TC *) liquid_malloc(n*sizeof(TC));
+        FFT(_r2r_rotation)(q->data.r2r.twiddle, n, -1.0, 0.0, 2.0*n);
+        q->data.r2r.fft = FFT(_create_plan_r2c_1d)(n, q->data.r2r.t, q->data.r2r.Z, _flags);
+        break;
+
+    case LIQUID_FFT_REDFT01:    // DCT-III
+    case LIQUID_FFT_RODFT01:    // DST-III
+        q->execute = q->type == LIQUID_FFT_REDFT01 ? &FFT(_execute_REDFT01) : &FFT(_execute_RODFT01);
+
+        // complex-to-real transform with pre-rotation exp(j*pi*k/(2n))
+        q->data.r2r.t       = (T *)  liquid_malloc(n*sizeof(T));
+        q->data.r2r.Z       = (TC *) liquid_malloc((n/2+1)*sizeof(TC));
+        q->data.r2r.twiddle = (TC *) liquid_malloc((n/2+1)*sizeof(TC));
+        FFT(_r2r_rotation)(q->data.r2r.twiddle, n/2+1, 1.0, 0.0, 2.0*n);
+        q->data.r2r.fft = FFT(_create_plan_c2r_1d)(n, q->data.r2r.Z, q->data.r2r.t, _flags);
+        break;
+
+    case LIQUID_FFT_REDFT11:    // DCT-IV
+    case LIQUID_FFT_RODFT11:    // DST-IV
+        q->execute = q->type == LIQUID_FFT_REDFT11 ? &FFT(_execute_REDFT11) : &FFT(_execute_RODFT11);
+
+        // complex transform of size n/2 (even) or 2n (odd) with pre-
+        // and post-rotation, stored consecutively
+        L = (n % 2) ? 2*n : n/2;
+        q->data.r2r.z       = (TC *) liquid_malloc(L*sizeof(TC));
+        q->data.r2r.Z       = (TC *) liquid_malloc(L*sizeof(TC));
+        if (n % 2) {
+            q->data.r2r.twiddle = (TC *) liquid_malloc(2*n*sizeof(TC));
+            FFT(_r2r_rotation)(q->data.r2r.twiddle,   n, -2.0,  0.0, 4.0*n);
+            FFT(_r2r_rotation)(q->data.r2r.twiddle+n, n, -2.0, -1.0, 4.0*n);
+        } else {
+            q->data.r2r.twiddle = (TC *) liquid_malloc(n*sizeof(TC));
+            FFT(_r2r_rotation)(q->data.r2r.twiddle,     L, -4.0, -1.0, 4.0*n);
+            FFT(_r2r_rotation)(q->data.r2r.twiddle + L, L, -1.0,  0.0, (double)n);
+        }
+        q->data.r2r.fft = FFT(_create_plan)(L, q->data.r2r.z, q->data.r2r.Z, LIQUID_FFT_FORWARD, _flags);
+        break;
+
     default:
         fprintf(stderr,"error: fft_create_plan_r2r_1d(), invalid type, %d\n", q->type);
         exit(1);
@@ -74,176 +172,242 @@ FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _nfft,
 // destroy real-to-real transform plan
 void FFT(_destroy_plan_r2r_1d)(FFT(plan) _q)
 {
+    if (_q->data.r2r.fft != NULL)
+        FFT(_destroy_plan)(_q->data.r2r.fft);
+    liquid_free(_q->data.r2r.t);
+    liquid_free(_q->data.r2r.z);
+    liquid_free(_q->data.r2r.Z);
+    liquid_free(_q->data.r2r.twiddle);
+
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print real-to-real transform plan
 void FFT(_print_plan_r2r_1d)(FFT(plan) _q)
 {
-    printf("real-to-real transform...\n");
-    // TODO: print actual transform type
+    const char * name = "";
+    switch (_q->type) {
+    case LIQUID_FFT_REDFT00: name = "REDFT00 (DCT-I)";   break;
+    case LIQUID_FFT_REDFT10: name = "REDFT10 (DCT-II)";  break;
+    case LIQUID_FFT_REDFT01: name = "REDFT01 (DCT-III)"; break;
+    case LIQUID_FFT_REDFT11: name = "REDFT11 (DCT-IV)";  break;
+    case LIQUID_FFT_RODFT00: name = "RODFT00 (DST-I)";   break;
+    case LIQUID_FFT_RODFT10: name = "RODFT10 (DST-II)";  break;
+    case LIQUID_FFT_RODFT01: name = "RODFT01 (DST-III)"; break;
+    case LIQUID_FFT_RODFT11: name = "RODFT11 (DST-IV)";  break;
+    default:;
+    }
+    printf("fft plan [real-to-real], n=%u, %s\n", _q->nfft, name);
+    if (_q->data.r2r.fft != NULL)
+        FFT(_print_plan_recursive)(_q->data.r2r.fft, 1);
 }
 
 //
-// DCT : Discrete Cosine Transforms
+// DCT-I/DST-I : even/odd extension
 //
 
 // DCT-I
 void FFT(_execute_REDFT00)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft-1);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        T x0 = _q->xr[0];       // first element
-        T xn = _q->xr[_q->nfft-1]; // last element
-        _q->yr[i] = 0.5f*( x0 + (i%2 ? -xn : xn));
-        for (k=1; k<_q->nfft-1; k++) {
-            phi = M_PI*n_inv*((float)k)*((float)i);
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
+    unsigned int i;
+    unsigned int n = _q->nfft;
+    if (n == 1) {
+        _q->yr[0] = 2.0f*_q->xr[0];
+        return;
     }
+
+    // even extension: t = { x[0], ..., x[n-1], x[n-2], ..., x[1] }
+    T *  t = _q->data.r2r.t;
+    TC * Z = _q->data.r2r.Z;
+    unsigned int L = 2*(n-1);
+    for (i=0; i<n; i++)
+        t[i] = _q->xr[i];
+    for (i=1; i<n-1; i++)
+        t[L-i] = _q->xr[i];
+
+    FFT(_execute)(_q->data.r2r.fft);
+
+    for (i=0; i<n; i++)
+        _q->yr[i] = crealf(Z[i]);
 }
 
-// DCT-II (regular 'dct')
-void FFT(_execute_REDFT10)(FFT(plan) _q)
+// DST-I
+void FFT(_execute_RODFT00)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)_q->nfft;
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k + 0.5f)*i;
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
+    unsigned int i;
+    unsigned int n = _q->nfft;
 
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
+    // odd extension: t = { 0, x[0], ..., x[n-1], 0, -x[n-1], ..., -x[0] }
+    T *  t = _q->data.r2r.t;
+    TC * Z = _q->data.r2r.Z;
+    unsigned int L = 2*(n+1);
+    t[0]   = 0.0f;
+    t[n+1] = 0.0f;
+    for (i=0; i<n; i++) {
+        t[i+1]   =  _q->xr[i];
+        t[L-1-i] = -_q->xr[i];
     }
+
+    FFT(_execute)(_q->data.r2r.fft);
+
+    for (i=0; i<n; i++)
+        _q->yr[i] = -cimagf(Z[i+1]);
 }
 
-// DCT-III (regular 'idct')
-void FFT(_execute_REDFT01)(FFT(plan) _q)
+//
+// DCT-II/DST-II : reordered real transform with post-rotation
+//
+
+// compute DCT-II of input, or DST-II (DCT-II of the sign-alternated
+// input, output reversed)
+static void FFT(_r2r_execute_type2)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)_q->nfft;
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = _q->xr[0]*0.5f;
-        for (k=1; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)i + 0.5f)*k;
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
+    unsigned int i;
+    unsigned int n = _q->nfft;
+    int dst = FFT(_r2r_is_dst)(_q->type);
+    T s = dst ? -1.0f : 1.0f;
+
+    // reorder: even samples ascending, odd samples descending
+    T *  t = _q->data.r2r.t;
+    TC * Z = _q->data.r2r.Z;
+    TC * w = _q->data.r2r.twiddle;
+    for (i=0; 2*i<n; i++)
+        t[i] = _q->xr[2*i];
+    for (i=0; 2*i+1<n; i++)
+        t[n-1-i] = s*_q->xr[2*i+1];
+
+    FFT(_execute)(_q->data.r2r.fft);
 
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
+    // y[k] = 2 Re{ V[k] w[k] }, using V[n-k] = conj(V[k])
+    T * y = _q->yr;
+    for (i=0; i<=n/2; i++) {
+        T v0 = 2.0f*crealf(Z[i]*w[i]);
+        y[dst ? n-1-i : i] = v0;
+        if (i > 0 && i < n-i) {
+            T v1 = 2.0f*crealf(conjf(Z[i])*w[n-i]);
+            y[dst ? i-1 : n-i] = v1;
+        }
     }
 }
 
-// DCT-IV
-void FFT(_execute_REDFT11)(FFT(plan) _q)
+// DCT-II (regular 'dct')
+void FFT(_execute_REDFT10)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k+0.5f)*((float)i+0.5f);
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
+    FFT(_r2r_execute_type2)(_q);
+}
 
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+// DST-II
+void FFT(_execute_RODFT10)(FFT(plan) _q)
+{
+    FFT(_r2r_execute_type2)(_q);
 }
 
 //
-// DST : Discrete Sine Transforms
+// DCT-III/DST-III : pre-rotated complex-to-real transform
 //
 
-// DST-I
-void FFT(_execute_RODFT00)(FFT(plan) _q)
+// compute DCT-III of input, or DST-III (DCT-III of the reversed input,
+// sign-alternated output)
+static void FFT(_r2r_execute_type3)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft+1);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*(float)((k+1)*(i+1));
-            _q->yr[i] += _q->xr[k]*sinf(phi);
-        }
+    unsigned int i;
+    unsigned int n = _q->nfft;
+    int dst = FFT(_r2r_is_dst)(_q->type);
 
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
+    // V[k] = (u[k] - j*u[n-k]) w[k], u[n] = 0
+    T *  t = _q->data.r2r.t;
+    TC * Z = _q->data.r2r.Z;
+    TC * w = _q->data.r2r.twiddle;
+    T *  x = _q->xr;
+    for (i=0; i<=n/2; i++) {
+        T a = dst ? x[n-1-i] : x[i];
+        T b = i == 0 ? 0.0f : (dst ? x[i-1] : x[n-i]);
+        Z[i] = (a - _Complex_I*b) * w[i];
     }
+
+    FFT(_execute)(_q->data.r2r.fft);
+
+    // undo reordering: even samples ascending, odd samples descending
+    T * y = _q->yr;
+    T s = dst ? -1.0f : 1.0f;
+    for (i=0; 2*i<n; i++)
+        y[2*i] = t[i];
+    for (i=0; 2*i+1<n; i++)
+        y[2*i+1] = s*t[n-1-i];
 }
 
-// DST-II
-void FFT(_execute_RODFT10)(FFT(plan) _q)
+// DCT-III (regular 'idct')
+void FFT(_execute_REDFT01)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k+0.5f)*(i+1);
-            _q->yr[i] += _q->xr[k]*sinf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    FFT(_r2r_execute_type3)(_q);
 }
 
 // DST-III
 void FFT(_execute_RODFT01)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = ((i%2)==0 ? 0.5f : -0.5f) * _q->xr[_q->nfft-1];
-        for (k=0; k<_q->nfft-1; k++) {
-            phi = M_PI*n_inv*((float)k+1)*((float)i+0.5f);
-            _q->yr[i] += _q->xr[k]*sinf(phi);
+    FFT(_r2r_execute_type3)(_q);
+}
+
+//
+// DCT-IV/DST-IV : rotated complex transform
+//
+
+// compute DCT-IV of input, or DST-IV (DCT-IV of the reversed input,
+// sign-alternated output)
+static void FFT(_r2r_execute_type4)(FFT(plan) _q)
+{
+    unsigned int i;
+    unsigned int n = _q->nfft;
+    int dst = FFT(_r2r_is_dst)(_q->type);
+
+    TC * z = _q->data.r2r.z;
+    TC * Z = _q->data.r2r.Z;
+    TC * w = _q->data.r2r.twiddle;
+    T *  x = _q->xr;
+    T *  y = _q->yr;
+
+    if (n % 2) {
+        // odd: zero-padded transform of size 2n
+        for (i=0; i<n; i++) {
+            z[i]   = (dst ? x[n-1-i] : x[i]) * w[i];
+            z[n+i] = 0.0f;
         }
+        FFT(_execute)(_q->data.r2r.fft);
+        for (i=0; i<n; i++) {
+            T v = 2.0f*crealf(Z[i]*w[n+i]);
+            y[i] = (dst && (i % 2)) ? -v : v;
+        }
+        return;
+    }
 
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
+    // even: pair samples from either end into a transform of size n/2,
+    //  z[m] = (u[2m] + j*u[n-1-2m]) exp(-j*pi*(4m+1)/(4n))
+    unsigned int M = n/2;
+    for (i=0; i<M; i++) {
+        T a = dst ? x[n-1-2*i] : x[2*i];
+        T b = dst ? x[2*i]     : x[n-1-2*i];
+        z[i] = (a + _Complex_I*b) * w[i];
     }
+    FFT(_execute)(_q->data.r2r.fft);
+
+    // v[m] = Z[m] exp(-j*pi*m/n); y[2m] = 2 Re{v}, y[n-1-2m] = -2 Im{v}
+    for (i=0; i<M; i++) {
+        TC v = Z[i]*w[M+i];
+        y[2*i]     =  2.0f*crealf(v);
+        y[n-1-2*i] = (dst ? 2.0f : -2.0f)*cimagf(v);
+    }
+}
+
+// DCT-IV
+void FFT(_execute_REDFT11)(FFT(plan) _q)
+{
+    FFT(_r2r_execute_type4)(_q);
 }
 
 // DST-IV
 void FFT(_execute_RODFT11)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k+0.5f)*((float)i+0.5f);
-            _q->yr[i] += _q->xr[k]*sinf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    FFT(_r2r_execute_type4)(_q);
 }
 
@@ -51,7 +51,7 @@ FFT(plan) FFT(_create_plan_rader)(unsigned int _nfft,
                                   int          _flags)
 {
     // allocate plan and initialize all internal arrays to NULL
-    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
 
     q->nfft      = _nfft;
     q->x         = _x;
@@ -64,8 +64,8 @@ FFT(plan) FFT(_create_plan_rader)(unsigned int _nfft,
     q->execute   = FFT(_execute_rader);
 
     // allocate memory for sub-transforms
-    q->data.rader.x_prime = (TC*)malloc((q->nfft-1)*sizeof(TC));
-    q->data.rader.X_prime = (TC*)malloc((q->nfft-1)*sizeof(TC));
+    q->data.rader.x_prime = (TC*)liquid_malloc((q->nfft-1)*sizeof(TC));
+    q->data.rader.X_prime = (TC*)liquid_malloc((q->nfft-1)*sizeof(TC));
 
     // create sub-FFT of size nfft-1
     q->data.rader.fft = FFT(_create_plan)(q->nfft-1,
@@ -81,27 +81,28 @@ FFT(plan) FFT(_create_plan_rader)(unsigned int _nfft,
                                            LIQUID_FFT_BACKWARD,
                                            q->flags);
 
-    // compute primitive root of nfft
-    unsigned int g = liquid_primitive_root_prime(q->nfft);
+    // shared sequence g^(i+1) mod nfft, g = primitive root of nfft
+    q->data.rader.seq = FFT(_table_rader_seq)(q->nfft);
+
+    // re-use shared transform of sequence if it exists
+    q->data.rader.R = (TC*) FFT(_table_find)(LIQUID_FFT_TABLE_RADER_R, q->nfft, q->direction);
+    if (q->data.rader.R != NULL)
+        return q;
 
-    // create and initialize sequence
-    q->data.rader.seq = (unsigned int *)malloc((q->nfft-1)*sizeof(unsigned int));
-    unsigned int i;
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader.seq[i] = liquid_modpow(g, i+1, q->nfft);
-    
     // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft-1
     // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
     // (use newly-created FFT plan of length nfft-1)
+    unsigned int i;
     T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
     for (i=0; i<q->nfft-1; i++)
         q->data.rader.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*q->data.rader.seq[i]/(T)(q->nfft));
     FFT(_execute)(q->data.rader.fft);
 
     // copy result to R
-    q->data.rader.R = (TC*)malloc((q->nfft-1)*sizeof(TC));
-    memmove(q->data.rader.R, q->data.rader.X_prime, (q->nfft-1)*sizeof(TC));
-    
+    TC * R = (TC*)liquid_malloc((q->nfft-1)*sizeof(TC));
+    memmove(R, q->data.rader.X_prime, (q->nfft-1)*sizeof(TC));
+    q->data.rader.R = (TC*) FFT(_table_insert)(LIQUID_FFT_TABLE_RADER_R, q->nfft, q->direction, R);
+
     // return main object
     return q;
 }
@@ -110,16 +111,16 @@ FFT(plan) FFT(_create_plan_rader)(unsigned int _nfft,
 void FFT(_destroy_plan_rader)(FFT(plan) _q)
 {
     // free data specific to Rader's algorithm
-    free(_q->data.rader.seq);       // sequence
-    free(_q->data.rader.R);         // pre-computed transform of exp(j*2*pi*seq)
-    free(_q->data.rader.x_prime);   // sub-transform input array
-    free(_q->data.rader.X_prime);   // sub-transform output array
+    FFT(_table_release)(_q->data.rader.seq);    // sequence
+    FFT(_table_release)(_q->data.rader.R);      // pre-computed transform of exp(j*2*pi*seq)
+    liquid_free(_q->data.rader.x_prime);   // sub-transform input array
+    liquid_free(_q->data.rader.X_prime);   // sub-transform output array
 
     FFT(_destroy_plan)(_q->data.rader.fft);
     FFT(_destroy_plan)(_q->data.rader.ifft);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // execute Rader's algorithm
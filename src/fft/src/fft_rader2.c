@@ -50,7 +50,7 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
                                          int          _flags)
 {
     // allocate plan and initialize all internal arrays to NULL
-    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
 
     q->nfft      = _nfft;
     q->x         = _x;
@@ -64,13 +64,8 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
 
     unsigned int i;
 
-    // compute primitive root of nfft
-    unsigned int g = liquid_primitive_root_prime(q->nfft);
-
-    // create and initialize sequence
-    q->data.rader2.seq = (unsigned int *)malloc((q->nfft-1)*sizeof(unsigned int));
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader2.seq[i] = liquid_modpow(g, i+1, q->nfft);
+    // shared sequence g^(i+1) mod nfft, g = primitive root of nfft
+    q->data.rader2.seq = FFT(_table_rader_seq)(q->nfft);
 
 #if 0
     // compute larger FFT length greater than 2*nfft-4
@@ -129,8 +124,8 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
     // assert(nfft_prime > 2*nfft-4)
 
     // allocate memory for sub-transforms
-    q->data.rader2.x_prime = (TC*)malloc((q->data.rader2.nfft_prime)*sizeof(TC));
-    q->data.rader2.X_prime = (TC*)malloc((q->data.rader2.nfft_prime)*sizeof(TC));
+    q->data.rader2.x_prime = (TC*)liquid_malloc((q->data.rader2.nfft_prime)*sizeof(TC));
+    q->data.rader2.X_prime = (TC*)liquid_malloc((q->data.rader2.nfft_prime)*sizeof(TC));
 
     // create sub-FFT of size nfft-1
     q->data.rader2.fft = FFT(_create_plan)(q->data.rader2.nfft_prime,
@@ -146,6 +141,11 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
                                             LIQUID_FFT_BACKWARD,
                                             q->flags);
 
+    // re-use shared transform of sequence if it exists
+    q->data.rader2.R = (TC*) FFT(_table_find)(LIQUID_FFT_TABLE_RADER2_R, q->nfft, q->direction);
+    if (q->data.rader2.R != NULL)
+        return q;
+
     // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft_prime
     // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
     // (use newly-created FFT plan of length nfft_prime)
@@ -155,8 +155,9 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
     FFT(_execute)(q->data.rader2.fft);
     
     // copy result to R
-    q->data.rader2.R = (TC*)malloc(q->data.rader2.nfft_prime*sizeof(TC));
-    memmove(q->data.rader2.R, q->data.rader2.X_prime, q->data.rader2.nfft_prime*sizeof(TC));
+    TC * R = (TC*)liquid_malloc(q->data.rader2.nfft_prime*sizeof(TC));
+    memmove(R, q->data.rader2.X_prime, q->data.rader2.nfft_prime*sizeof(TC));
+    q->data.rader2.R = (TC*) FFT(_table_insert)(LIQUID_FFT_TABLE_RADER2_R, q->nfft, q->direction, R);
 
     // return main object
     return q;
@@ -166,17 +167,17 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
 void FFT(_destroy_plan_rader2)(FFT(plan) _q)
 {
     // free data specific to Rader's algorithm
-    free(_q->data.rader2.seq);      // sequence
-    free(_q->data.rader2.R);        // pre-computed transform of exp(j*2*pi*seq)
+    FFT(_table_release)(_q->data.rader2.seq);   // sequence
+    FFT(_table_release)(_q->data.rader2.R);     // pre-computed transform of exp(j*2*pi*seq)
 
-    free(_q->data.rader2.x_prime);   // sub-transform input array
-    free(_q->data.rader2.X_prime);   // sub-transform output array
+    liquid_free(_q->data.rader2.x_prime);   // sub-transform input array
+    liquid_free(_q->data.rader2.X_prime);   // sub-transform output array
 
     FFT(_destroy_plan)(_q->data.rader2.fft);
     FFT(_destroy_plan)(_q->data.rader2.ifft);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // execute Rader's algorithm
@@ -42,7 +42,7 @@ FFT(plan) FFT(_create_plan_radix2)(unsigned int _nfft,
                                    int          _flags)
 {
     // allocate plan and initialize all internal arrays to NULL
-    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
 
     q->nfft      = _nfft;
     q->x         = _x;
@@ -57,37 +57,56 @@ FFT(plan) FFT(_create_plan_radix2)(unsigned int _nfft,
     // initialize twiddle factors, indices for radix-2 transforms
     q->data.radix2.m = liquid_msb_index(q->nfft) - 1;  // m = log2(nfft)
     
-    q->data.radix2.index_rev = (unsigned int *) malloc((q->nfft)*sizeof(unsigned int));
-    unsigned int i;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.index_rev[i] = fft_reverse_index(i,q->data.radix2.m);
-
-    // initialize twiddle factors
-    q->data.radix2.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
-    
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
+    // shared bit-reversed indices and per-stage twiddle factors
+    q->data.radix2.index_rev = FFT(_table_index_rev)(q->nfft);
+    q->data.radix2.twiddle   = FFT(_table_twiddle_radix2)(q->nfft, q->direction);
 
     return q;
 }
 
+// create per-stage twiddle factors for radix-4 stages of size 4*L,
+// preceded by one radix-2 stage (with unit twiddles) if _m is odd;
+// each stage stores W^i followed by W^(2i), W=exp(d*j*2*pi/(4L))
+//  _m      :   log2(nfft)
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+TC * FFT(_create_twiddles_radix2)(unsigned int _m,
+                                  int          _dir)
+{
+    unsigned int nfft = 1 << _m;
+    unsigned int L0 = (_m & 1) ? 2 : 1;
+    unsigned int i, L, num_twiddles = 0;
+    for (L=L0; L<nfft; L*=4)
+        num_twiddles += 2*L;
+    TC * twiddle = (TC *) liquid_malloc_aligned((num_twiddles ? num_twiddles : 1) * sizeof(TC));
+
+    T d = (_dir == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    TC * w = twiddle;
+    for (L=L0; L<nfft; L*=4) {
+        for (i=0; i<L; i++) {
+            w[  i] = cexpf(_Complex_I*d*2*M_PI*(T)(  i) / (T)(4*L));
+            w[L+i] = cexpf(_Complex_I*d*2*M_PI*(T)(2*i) / (T)(4*L));
+        }
+        w += 2*L;
+    }
+    return twiddle;
+}
+
 // destroy FFT plan
 void FFT(_destroy_plan_radix2)(FFT(plan) _q)
 {
     // free data specific to radix-2 transforms
-    free(_q->data.radix2.index_rev);
-    free(_q->data.radix2.twiddle);
+    FFT(_table_release)(_q->data.radix2.index_rev);
+    FFT(_table_release)(_q->data.radix2.twiddle);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // execute radix-2 FFT
 void FFT(_execute_radix2)(FFT(plan) _q)
 {
     // swap values
-    unsigned int i,j,k;
+    unsigned int i;
 
     // unroll loop
     unsigned int nfft4 = (_q->nfft>>2)<<2;  // floor(_nfft/4)
@@ -98,40 +117,29 @@ void FFT(_execute_radix2)(FFT(plan) _q)
         _q->y[i+3] = _q->x[ _q->data.radix2.index_rev[i+3] ];
     }
 
-#if 0
     // clean up remaining
     // NOTE : this only happens when _nfft=2 because we know (_nfft%4)==0 otherwise
     for ( ; i<_q->nfft; i++)
         _q->y[i] = _q->x[ _q->data.radix2.index_rev[i] ];
-#endif
-
-    TC yp;
-    TC *y=_q->y;
-    unsigned int n1 = 0;
-    unsigned int n2 = 1;
-
-    TC t;   // twiddle value
-    unsigned int stride = _q->nfft;
-    unsigned int twiddle_index;
 
-    for (i=0; i<_q->data.radix2.m; i++) {
-        n1 = n2;
-        n2 *= 2;
-        stride >>= 1;
+    TC * y = _q->y;
+    unsigned int L = 1;
 
-        twiddle_index = 0;
-    
-        for (j=0; j<n1; j++) {
-            t = _q->data.radix2.twiddle[twiddle_index];
-            twiddle_index = (twiddle_index + stride) % _q->nfft;
-
-            for (k=j; k<_q->nfft; k+=n2) {
-                // NOTE: most computation is with the multiplication in next line
-                yp      =  y[k+n1]*t;
-                y[k+n1] =  y[k] - yp;
-                y[k]    += yp;
-            }
+    // odd number of radix-2 stages: start with a single stage of
+    // 2-point butterflies
+    if (_q->data.radix2.m & 1) {
+        for (i=0; i<_q->nfft; i+=2) {
+            TC yp  = y[i+1];
+            y[i+1] = y[i] - yp;
+            y[i]  += yp;
         }
+        L = 2;
     }
-}
 
+    // remaining stages combined pairwise in radix-4 butterflies
+    TC * w = _q->data.radix2.twiddle;
+    for ( ; L<_q->nfft; L*=4) {
+        fft_radix4_stage(y, _q->nfft, L, w, _q->direction);
+        w += 2*L;
+    }
+}
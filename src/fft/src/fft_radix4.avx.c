@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_radix4.avx.c : radix-4 stages of the internal radix-2 transform
+//                    (AVX2/FMA, AVX-512F)
+//
+// These kernels are compiled with per-function target attributes and
+// are selected at run time by fft_radix4_stage() and
+// fft_radix4_stage_batch() in fft_radix4.mmx.c.
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// multiply 4 pairs of complex values (AVX2/FMA)
+__attribute__((target("avx2,fma")))
+static inline __m256 fft_radix4_cmul_avx2(__m256 _a, __m256 _w)
+{
+    __m256 as = _mm256_permute_ps(_a, _MM_SHUFFLE(2,3,0,1));
+    return _mm256_fmaddsub_ps(_a, _mm256_moveldup_ps(_w),
+                              _mm256_mul_ps(as, _mm256_movehdup_ps(_w)));
+}
+
+// 4 radix-4 butterflies on the values at _p, _p+_s, _p+2*_s and
+// _p+3*_s (offsets in floats)
+__attribute__((target("avx2,fma")))
+static inline void fft_radix4_butterfly_avx2(float *      _p,
+                                             unsigned int _s,
+                                             __m256       _w1,
+                                             __m256       _w2,
+                                             __m256       _sign)
+{
+    __m256 x0 = _mm256_loadu_ps(_p);
+    __m256 t1 = fft_radix4_cmul_avx2(_mm256_loadu_ps(_p +   _s), _w2);
+    __m256 x2 = _mm256_loadu_ps(_p + 2*_s);
+    __m256 t3 = fft_radix4_cmul_avx2(_mm256_loadu_ps(_p + 3*_s), _w2);
+
+    __m256 a0 = _mm256_add_ps(x0, t1);
+    __m256 a1 = _mm256_sub_ps(x0, t1);
+    __m256 b2 = fft_radix4_cmul_avx2(_mm256_add_ps(x2, t3), _w1);
+    __m256 b3 = fft_radix4_cmul_avx2(_mm256_sub_ps(x2, t3), _w1);
+    b3 = _mm256_permute_ps(b3, _MM_SHUFFLE(2,3,0,1));
+    b3 = _mm256_xor_ps(b3, _sign);
+
+    _mm256_storeu_ps(_p,        _mm256_add_ps(a0, b2));
+    _mm256_storeu_ps(_p + 2*_s, _mm256_sub_ps(a0, b2));
+    _mm256_storeu_ps(_p +   _s, _mm256_add_ps(a1, b3));
+    _mm256_storeu_ps(_p + 3*_s, _mm256_sub_ps(a1, b3));
+}
+
+// compute radix-4 stage, 4 butterflies at a time (AVX2/FMA); _L
+// must be a multiple of 4
+__attribute__((target("avx2,fma")))
+void fft_radix4_stage_avx2(liquid_float_complex * _y,
+                           unsigned int           _n,
+                           unsigned int           _L,
+                           liquid_float_complex * _w,
+                           int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    __m256 sign = _dir == LIQUID_FFT_FORWARD
+                ? _mm256_setr_ps(0.0f,-0.0f,0.0f,-0.0f,0.0f,-0.0f,0.0f,-0.0f)
+                : _mm256_setr_ps(-0.0f,0.0f,-0.0f,0.0f,-0.0f,0.0f,-0.0f,0.0f);
+
+    unsigned int L2 = 2*_L;     // offsets in floats
+    unsigned int b, j;
+    for (b=0; b<2*_n; b+=8*_L) {
+        for (j=0; j<L2; j+=8)
+            fft_radix4_butterfly_avx2(y + b + j, L2, _mm256_loadu_ps(w + j), _mm256_loadu_ps(w + L2 + j), sign);
+    }
+}
+
+// compute batched radix-4 stage, 4 transforms at a time with
+// broadcast twiddles (AVX2/FMA); _H must be a multiple of 4
+__attribute__((target("avx2,fma")))
+void fft_radix4_stage_batch_avx2(liquid_float_complex * _y,
+                                 unsigned int           _n,
+                                 unsigned int           _L,
+                                 liquid_float_complex * _w,
+                                 unsigned int           _H,
+                                 int                    _dir)
+{
+    float * y = (float*) _y;
+    __m256 sign = _dir == LIQUID_FFT_FORWARD
+                ? _mm256_setr_ps(0.0f,-0.0f,0.0f,-0.0f,0.0f,-0.0f,0.0f,-0.0f)
+                : _mm256_setr_ps(-0.0f,0.0f,-0.0f,0.0f,-0.0f,0.0f,-0.0f,0.0f);
+
+    unsigned int s = 2*_L*_H;   // offset between quarter blocks in floats
+    unsigned int b, j, k;
+    for (b=0; b<2*_n*_H; b+=4*s) {
+        for (j=0; j<_L; j++) {
+            __m256 w1 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_w[j]));
+            __m256 w2 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_w[_L+j]));
+            float * p = y + b + 2*j*_H;
+            for (k=0; k<2*_H; k+=8)
+                fft_radix4_butterfly_avx2(p + k, s, w1, w2, sign);
+        }
+    }
+}
+
+// multiply 8 pairs of complex values (AVX-512F)
+__attribute__((target("avx512f")))
+static inline __m512 fft_radix4_cmul_avx512f(__m512 _a, __m512 _w)
+{
+    __m512 as = _mm512_permute_ps(_a, _MM_SHUFFLE(2,3,0,1));
+    return _mm512_fmaddsub_ps(_a, _mm512_moveldup_ps(_w),
+                              _mm512_mul_ps(as, _mm512_movehdup_ps(_w)));
+}
+
+// 8 radix-4 butterflies on the values at _p, _p+_s, _p+2*_s and
+// _p+3*_s (offsets in floats)
+__attribute__((target("avx512f")))
+static inline void fft_radix4_butterfly_avx512f(float *      _p,
+                                                unsigned int _s,
+                                                __m512       _w1,
+                                                __m512       _w2,
+                                                __m512i      _sign)
+{
+    __m512 x0 = _mm512_loadu_ps(_p);
+    __m512 t1 = fft_radix4_cmul_avx512f(_mm512_loadu_ps(_p +   _s), _w2);
+    __m512 x2 = _mm512_loadu_ps(_p + 2*_s);
+    __m512 t3 = fft_radix4_cmul_avx512f(_mm512_loadu_ps(_p + 3*_s), _w2);
+
+    __m512 a0 = _mm512_add_ps(x0, t1);
+    __m512 a1 = _mm512_sub_ps(x0, t1);
+    __m512 b2 = fft_radix4_cmul_avx512f(_mm512_add_ps(x2, t3), _w1);
+    __m512 b3 = fft_radix4_cmul_avx512f(_mm512_sub_ps(x2, t3), _w1);
+    b3 = _mm512_permute_ps(b3, _MM_SHUFFLE(2,3,0,1));
+    b3 = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(b3), _sign));
+
+    _mm512_storeu_ps(_p,        _mm512_add_ps(a0, b2));
+    _mm512_storeu_ps(_p + 2*_s, _mm512_sub_ps(a0, b2));
+    _mm512_storeu_ps(_p +   _s, _mm512_add_ps(a1, b3));
+    _mm512_storeu_ps(_p + 3*_s, _mm512_sub_ps(a1, b3));
+}
+
+// compute radix-4 stage, 8 butterflies at a time (AVX-512F); _L
+// must be a multiple of 8
+__attribute__((target("avx512f")))
+void fft_radix4_stage_avx512f(liquid_float_complex * _y,
+                              unsigned int           _n,
+                              unsigned int           _L,
+                              liquid_float_complex * _w,
+                              int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    __m512i sign = _dir == LIQUID_FFT_FORWARD
+                 ? _mm512_set1_epi64((long long)0x8000000000000000ULL)
+                 : _mm512_set1_epi64((long long)0x0000000080000000ULL);
+
+    unsigned int L2 = 2*_L;     // offsets in floats
+    unsigned int b, j;
+    for (b=0; b<2*_n; b+=8*_L) {
+        for (j=0; j<L2; j+=16)
+            fft_radix4_butterfly_avx512f(y + b + j, L2, _mm512_loadu_ps(w + j), _mm512_loadu_ps(w + L2 + j), sign);
+    }
+}
+
+// compute batched radix-4 stage, 8 transforms at a time with
+// broadcast twiddles (AVX-512F); _H must be a multiple of 8
+__attribute__((target("avx512f")))
+void fft_radix4_stage_batch_avx512f(liquid_float_complex * _y,
+                                    unsigned int           _n,
+                                    unsigned int           _L,
+                                    liquid_float_complex * _w,
+                                    unsigned int           _H,
+                                    int                    _dir)
+{
+    float * y = (float*) _y;
+    __m512i sign = _dir == LIQUID_FFT_FORWARD
+                 ? _mm512_set1_epi64((long long)0x8000000000000000ULL)
+                 : _mm512_set1_epi64((long long)0x0000000080000000ULL);
+
+    unsigned int s = 2*_L*_H;   // offset between quarter blocks in floats
+    unsigned int b, j, k;
+    for (b=0; b<2*_n*_H; b+=4*s) {
+        for (j=0; j<_L; j++) {
+            __m512 w1 = _mm512_castpd_ps(_mm512_broadcastsd_pd(_mm_load_sd((double*)&_w[j])));
+            __m512 w2 = _mm512_castpd_ps(_mm512_broadcastsd_pd(_mm_load_sd((double*)&_w[_L+j])));
+            float * p = y + b + 2*j*_H;
+            for (k=0; k<2*_H; k+=16)
+                fft_radix4_butterfly_avx512f(p + k, s, w1, w2, sign);
+        }
+    }
+}
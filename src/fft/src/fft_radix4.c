@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_radix4.c : radix-4 stages of the internal radix-2 transform
+//                (portable C)
+//
+
+#include "liquid.internal.h"
+
+// radix-4 butterfly on the values at _p, _p+_s, _p+2*_s and _p+3*_s
+// (offsets in floats) with twiddles W^i (_w1) and W^(2i) (_w2)
+static inline void fft_radix4_butterfly(float *       _p,
+                                        unsigned int  _s,
+                                        const float * _w1,
+                                        const float * _w2,
+                                        float         _d)
+{
+    float * y0 = _p;
+    float * y1 = y0 + _s;
+    float * y2 = y1 + _s;
+    float * y3 = y2 + _s;
+
+    // first radix-2 step: twiddle W^(2i)
+    float t1r = y1[0]*_w2[0] - y1[1]*_w2[1];
+    float t1i = y1[0]*_w2[1] + y1[1]*_w2[0];
+    float t3r = y3[0]*_w2[0] - y3[1]*_w2[1];
+    float t3i = y3[0]*_w2[1] + y3[1]*_w2[0];
+
+    float a0r = y0[0] + t1r, a0i = y0[1] + t1i;
+    float a1r = y0[0] - t1r, a1i = y0[1] - t1i;
+    float a2r = y2[0] + t3r, a2i = y2[1] + t3i;
+    float a3r = y2[0] - t3r, a3i = y2[1] - t3i;
+
+    // second radix-2 step: twiddles W^i and d*j*W^i
+    float b2r = a2r*_w1[0] - a2i*_w1[1];
+    float b2i = a2r*_w1[1] + a2i*_w1[0];
+    float b3r = -_d*(a3r*_w1[1] + a3i*_w1[0]);
+    float b3i =  _d*(a3r*_w1[0] - a3i*_w1[1]);
+
+    y0[0] = a0r + b2r;  y0[1] = a0i + b2i;
+    y2[0] = a0r - b2r;  y2[1] = a0i - b2i;
+    y1[0] = a1r + b3r;  y1[1] = a1i + b3i;
+    y3[0] = a1r - b3r;  y3[1] = a1i - b3i;
+}
+
+// compute radix-4 decimation-in-time stage (see liquid.internal.h)
+void fft_radix4_stage(liquid_float_complex * _y,
+                      unsigned int           _n,
+                      unsigned int           _L,
+                      liquid_float_complex * _w,
+                      int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+
+    // rotation by exp(d*j*pi/2) = d*j
+    float d = _dir == LIQUID_FFT_FORWARD ? -1.0f : 1.0f;
+
+    unsigned int L2 = 2*_L;     // offsets in floats
+    unsigned int b, j;
+    for (b=0; b<2*_n; b+=8*_L) {
+        for (j=0; j<L2; j+=2)
+            fft_radix4_butterfly(y + b + j, L2, w + j, w + L2 + j, d);
+    }
+}
+
+// compute radix-4 stage on batch of interleaved transforms (see
+// liquid.internal.h)
+void fft_radix4_stage_batch(liquid_float_complex * _y,
+                            unsigned int           _n,
+                            unsigned int           _L,
+                            liquid_float_complex * _w,
+                            unsigned int           _H,
+                            int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    float d = _dir == LIQUID_FFT_FORWARD ? -1.0f : 1.0f;
+
+    unsigned int s = 2*_L*_H;   // offset between quarter blocks in floats
+    unsigned int b, j, k;
+    for (b=0; b<2*_n*_H; b+=4*s) {
+        for (j=0; j<_L; j++) {
+            // twiddles are shared by all transforms in the batch
+            float * p = y + b + 2*j*_H;
+            for (k=0; k<2*_H; k+=2)
+                fft_radix4_butterfly(p + k, s, w + 2*j, w + 2*_L + 2*j, d);
+        }
+    }
+}
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_radix4.mmx.c : radix-4 stages of the internal radix-2 transform
+//                    (SSE3 with AVX2/AVX-512F dispatch)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
+// radix-4 butterfly on the values at _p, _p+_s, _p+2*_s and _p+3*_s
+// (offsets in floats) with twiddles W^i (_w1) and W^(2i) (_w2)
+static inline void fft_radix4_butterfly(float *       _p,
+                                        unsigned int  _s,
+                                        const float * _w1,
+                                        const float * _w2,
+                                        float         _d)
+{
+    float * y0 = _p;
+    float * y1 = y0 + _s;
+    float * y2 = y1 + _s;
+    float * y3 = y2 + _s;
+
+    // first radix-2 step: twiddle W^(2i)
+    float t1r = y1[0]*_w2[0] - y1[1]*_w2[1];
+    float t1i = y1[0]*_w2[1] + y1[1]*_w2[0];
+    float t3r = y3[0]*_w2[0] - y3[1]*_w2[1];
+    float t3i = y3[0]*_w2[1] + y3[1]*_w2[0];
+
+    float a0r = y0[0] + t1r, a0i = y0[1] + t1i;
+    float a1r = y0[0] - t1r, a1i = y0[1] - t1i;
+    float a2r = y2[0] + t3r, a2i = y2[1] + t3i;
+    float a3r = y2[0] - t3r, a3i = y2[1] - t3i;
+
+    // second radix-2 step: twiddles W^i and d*j*W^i
+    float b2r = a2r*_w1[0] - a2i*_w1[1];
+    float b2i = a2r*_w1[1] + a2i*_w1[0];
+    float b3r = -_d*(a3r*_w1[1] + a3i*_w1[0]);
+    float b3i =  _d*(a3r*_w1[0] - a3i*_w1[1]);
+
+    y0[0] = a0r + b2r;  y0[1] = a0i + b2i;
+    y2[0] = a0r - b2r;  y2[1] = a0i - b2i;
+    y1[0] = a1r + b3r;  y1[1] = a1i + b3i;
+    y3[0] = a1r - b3r;  y3[1] = a1i - b3i;
+}
+
+// compute radix-4 stage, portable C (small stages and
+// selected with liquid_simd_set_level())
+static void fft_radix4_stage_portable(liquid_float_complex * _y,
+                                      unsigned int           _n,
+                                      unsigned int           _L,
+                                      liquid_float_complex * _w,
+                                      int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+
+    // rotation by exp(d*j*pi/2) = d*j
+    float d = _dir == LIQUID_FFT_FORWARD ? -1.0f : 1.0f;
+
+    unsigned int L2 = 2*_L;     // offsets in floats
+    unsigned int b, j;
+    for (b=0; b<2*_n; b+=8*_L) {
+        for (j=0; j<L2; j+=2)
+            fft_radix4_butterfly(y + b + j, L2, w + j, w + L2 + j, d);
+    }
+}
+
+// compute batched radix-4 stage, portable C
+static void fft_radix4_stage_batch_portable(liquid_float_complex * _y,
+                                            unsigned int           _n,
+                                            unsigned int           _L,
+                                            liquid_float_complex * _w,
+                                            unsigned int           _H,
+                                            int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    float d = _dir == LIQUID_FFT_FORWARD ? -1.0f : 1.0f;
+
+    unsigned int s = 2*_L*_H;   // offset between quarter blocks in floats
+    unsigned int b, j, k;
+    for (b=0; b<2*_n*_H; b+=4*s) {
+        for (j=0; j<_L; j++) {
+            // twiddles are shared by all transforms in the batch
+            float * p = y + b + 2*j*_H;
+            for (k=0; k<2*_H; k+=2)
+                fft_radix4_butterfly(p + k, s, w + 2*j, w + 2*_L + 2*j, d);
+        }
+    }
+}
+
+#if HAVE_PMMINTRIN_H
+// multiply two pairs of complex values (SSE3)
+static inline __m128 fft_radix4_cmul_sse(__m128 _a, __m128 _w)
+{
+    __m128 wr = _mm_moveldup_ps(_w);
+    __m128 wi = _mm_movehdup_ps(_w);
+    __m128 as = _mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1));
+    return _mm_addsub_ps(_mm_mul_ps(_a, wr), _mm_mul_ps(as, wi));
+}
+
+// two radix-4 butterflies on the values at _p, _p+_s, _p+2*_s and
+// _p+3*_s (offsets in floats)
+static inline void fft_radix4_butterfly_sse(float *      _p,
+                                            unsigned int _s,
+                                            __m128       _w1,
+                                            __m128       _w2,
+                                            __m128       _sign)
+{
+    __m128 x0 = _mm_loadu_ps(_p);
+    __m128 t1 = fft_radix4_cmul_sse(_mm_loadu_ps(_p +   _s), _w2);
+    __m128 x2 = _mm_loadu_ps(_p + 2*_s);
+    __m128 t3 = fft_radix4_cmul_sse(_mm_loadu_ps(_p + 3*_s), _w2);
+
+    __m128 a0 = _mm_add_ps(x0, t1);
+    __m128 a1 = _mm_sub_ps(x0, t1);
+    __m128 b2 = fft_radix4_cmul_sse(_mm_add_ps(x2, t3), _w1);
+    __m128 b3 = fft_radix4_cmul_sse(_mm_sub_ps(x2, t3), _w1);
+    b3 = _mm_xor_ps(_mm_shuffle_ps(b3, b3, _MM_SHUFFLE(2,3,0,1)), _sign);
+
+    _mm_storeu_ps(_p,        _mm_add_ps(a0, b2));
+    _mm_storeu_ps(_p + 2*_s, _mm_sub_ps(a0, b2));
+    _mm_storeu_ps(_p +   _s, _mm_add_ps(a1, b3));
+    _mm_storeu_ps(_p + 3*_s, _mm_sub_ps(a1, b3));
+}
+
+// sign mask for rotation by d*j: swap (real,imag) and negate the real
+// part (d=+1) or the imaginary part (d=-1) of the result
+static inline __m128 fft_radix4_sign_sse(int _dir)
+{
+    return _dir == LIQUID_FFT_FORWARD ? _mm_setr_ps(0.0f,-0.0f,0.0f,-0.0f)
+                                      : _mm_setr_ps(-0.0f,0.0f,-0.0f,0.0f);
+}
+
+// compute radix-4 stage, two butterflies at a time (SSE3); _L must
+// be even
+static void fft_radix4_stage_sse(liquid_float_complex * _y,
+                                 unsigned int           _n,
+                                 unsigned int           _L,
+                                 liquid_float_complex * _w,
+                                 int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    __m128 sign = fft_radix4_sign_sse(_dir);
+
+    unsigned int L2 = 2*_L;     // offsets in floats
+    unsigned int b, j;
+    for (b=0; b<2*_n; b+=8*_L) {
+        for (j=0; j<L2; j+=4)
+            fft_radix4_butterfly_sse(y + b + j, L2, _mm_load_ps(w + j), _mm_load_ps(w + L2 + j), sign);
+    }
+}
+
+// compute batched radix-4 stage, two transforms at a time with
+// broadcast twiddles (SSE3); _H must be even
+static void fft_radix4_stage_batch_sse(liquid_float_complex * _y,
+                                       unsigned int           _n,
+                                       unsigned int           _L,
+                                       liquid_float_complex * _w,
+                                       unsigned int           _H,
+                                       int                    _dir)
+{
+    float * y = (float*) _y;
+    __m128 sign = fft_radix4_sign_sse(_dir);
+
+    unsigned int s = 2*_L*_H;   // offset between quarter blocks in floats
+    unsigned int b, j, k;
+    for (b=0; b<2*_n*_H; b+=4*s) {
+        for (j=0; j<_L; j++) {
+            __m128 w1 = _mm_castpd_ps(_mm_load1_pd((double*)&_w[j]));
+            __m128 w2 = _mm_castpd_ps(_mm_load1_pd((double*)&_w[_L+j]));
+            float * p = y + b + 2*j*_H;
+            for (k=0; k<2*_H; k+=4)
+                fft_radix4_butterfly_sse(p + k, s, w1, w2, sign);
+        }
+    }
+}
+#endif
+
+// compute radix-4 decimation-in-time stage (see liquid.internal.h)
+void fft_radix4_stage(liquid_float_complex * _y,
+                      unsigned int           _n,
+                      unsigned int           _L,
+                      liquid_float_complex * _w,
+                      int                    _dir)
+{
+    // run-time dispatch; stages narrower than the vector width use
+    // the next smaller kernel
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX512F && _L >= 8) {
+        fft_radix4_stage_avx512f(_y, _n, _L, _w, _dir);
+        return;
+    }
+    if ((level == LIQUID_SIMD_AVX512F || level == LIQUID_SIMD_AVX2) && _L >= 4) {
+        fft_radix4_stage_avx2(_y, _n, _L, _w, _dir);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE && _L >= 2) {
+        fft_radix4_stage_sse(_y, _n, _L, _w, _dir);
+        return;
+    }
+#endif
+    fft_radix4_stage_portable(_y, _n, _L, _w, _dir);
+}
+
+// compute radix-4 stage on batch of interleaved transforms (see
+// liquid.internal.h)
+void fft_radix4_stage_batch(liquid_float_complex * _y,
+                            unsigned int           _n,
+                            unsigned int           _L,
+                            liquid_float_complex * _w,
+                            unsigned int           _H,
+                            int                    _dir)
+{
+    // run-time dispatch; the vector width must divide the batch size
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX512F && (_H % 8) == 0) {
+        fft_radix4_stage_batch_avx512f(_y, _n, _L, _w, _H, _dir);
+        return;
+    }
+    if ((level == LIQUID_SIMD_AVX512F || level == LIQUID_SIMD_AVX2) && (_H % 4) == 0) {
+        fft_radix4_stage_batch_avx2(_y, _n, _L, _w, _H, _dir);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE && (_H % 2) == 0) {
+        fft_radix4_stage_batch_sse(_y, _n, _L, _w, _H, _dir);
+        return;
+    }
+#endif
+    fft_radix4_stage_batch_portable(_y, _n, _L, _w, _H, _dir);
+}
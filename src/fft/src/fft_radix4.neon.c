@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_radix4.neon.c : radix-4 stages of the internal radix-2 transform
+//                     (ARM Neon)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+// radix-4 butterfly on the values at _p, _p+_s, _p+2*_s and _p+3*_s
+// (offsets in floats) with twiddles W^i (_w1) and W^(2i) (_w2)
+static inline void fft_radix4_butterfly(float *       _p,
+                                        unsigned int  _s,
+                                        const float * _w1,
+                                        const float * _w2,
+                                        float         _d)
+{
+    float * y0 = _p;
+    float * y1 = y0 + _s;
+    float * y2 = y1 + _s;
+    float * y3 = y2 + _s;
+
+    // first radix-2 step: twiddle W^(2i)
+    float t1r = y1[0]*_w2[0] - y1[1]*_w2[1];
+    float t1i = y1[0]*_w2[1] + y1[1]*_w2[0];
+    float t3r = y3[0]*_w2[0] - y3[1]*_w2[1];
+    float t3i = y3[0]*_w2[1] + y3[1]*_w2[0];
+
+    float a0r = y0[0] + t1r, a0i = y0[1] + t1i;
+    float a1r = y0[0] - t1r, a1i = y0[1] - t1i;
+    float a2r = y2[0] + t3r, a2i = y2[1] + t3i;
+    float a3r = y2[0] - t3r, a3i = y2[1] - t3i;
+
+    // second radix-2 step: twiddles W^i and d*j*W^i
+    float b2r = a2r*_w1[0] - a2i*_w1[1];
+    float b2i = a2r*_w1[1] + a2i*_w1[0];
+    float b3r = -_d*(a3r*_w1[1] + a3i*_w1[0]);
+    float b3i =  _d*(a3r*_w1[0] - a3i*_w1[1]);
+
+    y0[0] = a0r + b2r;  y0[1] = a0i + b2i;
+    y2[0] = a0r - b2r;  y2[1] = a0i - b2i;
+    y1[0] = a1r + b3r;  y1[1] = a1i + b3i;
+    y3[0] = a1r - b3r;  y3[1] = a1i - b3i;
+}
+
+// compute radix-4 stage, portable C (small stages and
+// selected with liquid_simd_set_level())
+static void fft_radix4_stage_portable(liquid_float_complex * _y,
+                                      unsigned int           _n,
+                                      unsigned int           _L,
+                                      liquid_float_complex * _w,
+                                      int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+
+    // rotation by exp(d*j*pi/2) = d*j
+    float d = _dir == LIQUID_FFT_FORWARD ? -1.0f : 1.0f;
+
+    unsigned int L2 = 2*_L;     // offsets in floats
+    unsigned int b, j;
+    for (b=0; b<2*_n; b+=8*_L) {
+        for (j=0; j<L2; j+=2)
+            fft_radix4_butterfly(y + b + j, L2, w + j, w + L2 + j, d);
+    }
+}
+
+// compute batched radix-4 stage, portable C
+static void fft_radix4_stage_batch_portable(liquid_float_complex * _y,
+                                            unsigned int           _n,
+                                            unsigned int           _L,
+                                            liquid_float_complex * _w,
+                                            unsigned int           _H,
+                                            int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    float d = _dir == LIQUID_FFT_FORWARD ? -1.0f : 1.0f;
+
+    unsigned int s = 2*_L*_H;   // offset between quarter blocks in floats
+    unsigned int b, j, k;
+    for (b=0; b<2*_n*_H; b+=4*s) {
+        for (j=0; j<_L; j++) {
+            // twiddles are shared by all transforms in the batch
+            float * p = y + b + 2*j*_H;
+            for (k=0; k<2*_H; k+=2)
+                fft_radix4_butterfly(p + k, s, w + 2*j, w + 2*_L + 2*j, d);
+        }
+    }
+}
+
+// four radix-4 butterflies on de-interleaved (real,imag) vectors at
+// _p, _p+_s, _p+2*_s and _p+3*_s (offsets in floats)
+static inline void fft_radix4_butterfly_neon(float *       _p,
+                                             unsigned int  _s,
+                                             float32x4x2_t _w1,
+                                             float32x4x2_t _w2,
+                                             int           _forward)
+{
+    float32x4x2_t x0 = vld2q_f32(_p);
+    float32x4x2_t x1 = vld2q_f32(_p +   _s);
+    float32x4x2_t x2 = vld2q_f32(_p + 2*_s);
+    float32x4x2_t x3 = vld2q_f32(_p + 3*_s);
+
+    // first radix-2 step: twiddle W^(2i)
+    float32x4_t t1r = vmlsq_f32(vmulq_f32(x1.val[0], _w2.val[0]), x1.val[1], _w2.val[1]);
+    float32x4_t t1i = vmlaq_f32(vmulq_f32(x1.val[0], _w2.val[1]), x1.val[1], _w2.val[0]);
+    float32x4_t t3r = vmlsq_f32(vmulq_f32(x3.val[0], _w2.val[0]), x3.val[1], _w2.val[1]);
+    float32x4_t t3i = vmlaq_f32(vmulq_f32(x3.val[0], _w2.val[1]), x3.val[1], _w2.val[0]);
+
+    float32x4_t a0r = vaddq_f32(x0.val[0], t1r), a0i = vaddq_f32(x0.val[1], t1i);
+    float32x4_t a1r = vsubq_f32(x0.val[0], t1r), a1i = vsubq_f32(x0.val[1], t1i);
+    float32x4_t a2r = vaddq_f32(x2.val[0], t3r), a2i = vaddq_f32(x2.val[1], t3i);
+    float32x4_t a3r = vsubq_f32(x2.val[0], t3r), a3i = vsubq_f32(x2.val[1], t3i);
+
+    // second radix-2 step: twiddles W^i and d*j*W^i
+    float32x4_t b2r = vmlsq_f32(vmulq_f32(a2r, _w1.val[0]), a2i, _w1.val[1]);
+    float32x4_t b2i = vmlaq_f32(vmulq_f32(a2r, _w1.val[1]), a2i, _w1.val[0]);
+    float32x4_t c3r = vmlsq_f32(vmulq_f32(a3r, _w1.val[0]), a3i, _w1.val[1]);
+    float32x4_t c3i = vmlaq_f32(vmulq_f32(a3r, _w1.val[1]), a3i, _w1.val[0]);
+
+    // d*j*(c3r + j*c3i) = -d*c3i + j*d*c3r
+    float32x4_t b3r = _forward ? c3i : vnegq_f32(c3i);
+    float32x4_t b3i = _forward ? vnegq_f32(c3r) : c3r;
+
+    float32x4x2_t v;
+    v.val[0] = vaddq_f32(a0r, b2r); v.val[1] = vaddq_f32(a0i, b2i); vst2q_f32(_p,        v);
+    v.val[0] = vsubq_f32(a0r, b2r); v.val[1] = vsubq_f32(a0i, b2i); vst2q_f32(_p + 2*_s, v);
+    v.val[0] = vaddq_f32(a1r, b3r); v.val[1] = vaddq_f32(a1i, b3i); vst2q_f32(_p +   _s, v);
+    v.val[0] = vsubq_f32(a1r, b3r); v.val[1] = vsubq_f32(a1i, b3i); vst2q_f32(_p + 3*_s, v);
+}
+
+// compute radix-4 stage, four butterflies at a time (Neon); _L must
+// be a multiple of 4
+static void fft_radix4_stage_neon(liquid_float_complex * _y,
+                                  unsigned int           _n,
+                                  unsigned int           _L,
+                                  liquid_float_complex * _w,
+                                  int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    int forward = _dir == LIQUID_FFT_FORWARD;
+
+    unsigned int L2 = 2*_L;     // offsets in floats
+    unsigned int b, j;
+    for (b=0; b<2*_n; b+=8*_L) {
+        for (j=0; j<L2; j+=8)
+            fft_radix4_butterfly_neon(y + b + j, L2, vld2q_f32(w + j), vld2q_f32(w + L2 + j), forward);
+    }
+}
+
+// compute batched radix-4 stage, four transforms at a time with
+// broadcast twiddles (Neon); _H must be a multiple of 4
+static void fft_radix4_stage_batch_neon(liquid_float_complex * _y,
+                                        unsigned int           _n,
+                                        unsigned int           _L,
+                                        liquid_float_complex * _w,
+                                        unsigned int           _H,
+                                        int                    _dir)
+{
+    float * y = (float*) _y;
+    float * w = (float*) _w;
+    int forward = _dir == LIQUID_FFT_FORWARD;
+
+    unsigned int s = 2*_L*_H;   // offset between quarter blocks in floats
+    unsigned int b, j, k;
+    for (b=0; b<2*_n*_H; b+=4*s) {
+        for (j=0; j<_L; j++) {
+            float32x4x2_t w1, w2;
+            w1.val[0] = vdupq_n_f32(w[2*j]);
+            w1.val[1] = vdupq_n_f32(w[2*j+1]);
+            w2.val[0] = vdupq_n_f32(w[2*(_L+j)]);
+            w2.val[1] = vdupq_n_f32(w[2*(_L+j)+1]);
+            float * p = y + b + 2*j*_H;
+            for (k=0; k<2*_H; k+=8)
+                fft_radix4_butterfly_neon(p + k, s, w1, w2, forward);
+        }
+    }
+}
+
+// compute radix-4 decimation-in-time stage (see liquid.internal.h)
+void fft_radix4_stage(liquid_float_complex * _y,
+                      unsigned int           _n,
+                      unsigned int           _L,
+                      liquid_float_complex * _w,
+                      int                    _dir)
+{
+    if (liquid_simd_get_level() == LIQUID_SIMD_PORTABLE || _L < 4)
+        fft_radix4_stage_portable(_y, _n, _L, _w, _dir);
+    else
+        fft_radix4_stage_neon(_y, _n, _L, _w, _dir);
+}
+
+// compute radix-4 stage on batch of interleaved transforms (see
+// liquid.internal.h)
+void fft_radix4_stage_batch(liquid_float_complex * _y,
+                            unsigned int           _n,
+                            unsigned int           _L,
+                            liquid_float_complex * _w,
+                            unsigned int           _H,
+                            int                    _dir)
+{
+    if (liquid_simd_get_level() == LIQUID_SIMD_PORTABLE || (_H % 4) != 0)
+        fft_radix4_stage_batch_portable(_y, _n, _L, _w, _H, _dir);
+    else
+        fft_radix4_stage_batch_neon(_y, _n, _L, _w, _H, _dir);
+}
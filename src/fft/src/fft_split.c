@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_split.c : transforms on split-complex arrays
+//
+// The input and output are given as separate arrays of real and
+// imaginary parts (see liquid_vectorcf_split()). Radix-2 sizes run
+// the radix-2/radix-4 decimation-in-time stages of fft_radix2.c
+// directly on the split arrays, where each butterfly lane is a plain
+// real multiply-add and consecutive butterflies map onto full vectors
+// without de-interleaving. Other sizes merge the input into a regular
+// transform and split its output.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "liquid.internal.h"
+
+#if HAVE_DOTPROD_AVX
+#include <immintrin.h>
+#endif
+
+// create split-complex FFT plan (see liquid.h)
+//  _n      :   transform size
+//  _xr     :   input array, real part [size: _n x 1]
+//  _xi     :   input array, imaginary part [size: _n x 1]
+//  _yr     :   output array, real part [size: _n x 1]
+//  _yi     :   output array, imaginary part [size: _n x 1]
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags (see fft_create_plan())
+FFT(plan) FFT(_create_plan_split)(unsigned int _n,
+                                  T *          _xr,
+                                  T *          _xi,
+                                  T *          _yr,
+                                  T *          _yi,
+                                  int          _dir,
+                                  int          _flags)
+{
+    if (_n == 0) {
+        fprintf(stderr,"error: fft_create_plan_split(), transform size must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _n;
+    q->x         = NULL;
+    q->y         = NULL;
+    q->xr        = _xr;
+    q->yr        = _yr;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_SPLIT;
+    q->execute   = FFT(_execute_split);
+
+    q->data.split.xi        = _xi;
+    q->data.split.yi        = _yi;
+    q->data.split.m         = 0;
+    q->data.split.index_rev = NULL;
+    q->data.split.twiddle   = NULL;
+    q->data.split.x         = NULL;
+    q->data.split.y         = NULL;
+    q->data.split.fft       = NULL;
+
+    if (_n >= 2 && fft_is_radix2(_n)) {
+        // split copy of the shared radix-2 stage twiddles: each
+        // radix-4 stage of size 4*L holds real and imaginary parts of
+        // W^i followed by those of W^(2i), i in [0,L)
+        unsigned int m  = liquid_msb_index(_n) - 1;
+        unsigned int L0 = (m & 1) ? 2 : 1;
+        unsigned int i, L, num_twiddles = 0;
+        for (L=L0; L<_n; L*=4)
+            num_twiddles += 2*L;
+        q->data.split.m         = m;
+        q->data.split.index_rev = FFT(_table_index_rev)(_n);
+        q->data.split.twiddle   = (T *) liquid_malloc_aligned((num_twiddles ? 2*num_twiddles : 1)*sizeof(T));
+
+        TC * w0 = FFT(_table_twiddle_radix2)(_n, q->direction);
+        TC * w  = w0;
+        T  * v  = q->data.split.twiddle;
+        for (L=L0; L<_n; L*=4) {
+            for (i=0; i<2*L; i++) {
+                v[i/L*2*L +     i%L] = crealf(w[i]);
+                v[i/L*2*L + L + i%L] = cimagf(w[i]);
+            }
+            v += 4*L;
+            w += 2*L;
+        }
+        FFT(_table_release)(w0);
+    } else {
+        // regular transform between interleaved buffers
+        q->data.split.x   = (TC *) liquid_malloc_aligned(_n*sizeof(TC));
+        q->data.split.y   = (TC *) liquid_malloc_aligned(_n*sizeof(TC));
+        q->data.split.fft = FFT(_create_plan)(_n, q->data.split.x, q->data.split.y, _dir, _flags);
+    }
+    return q;
+}
+
+// destroy split-complex plan
+void FFT(_destroy_plan_split)(FFT(plan) _q)
+{
+    if (_q->data.split.fft != NULL) {
+        FFT(_destroy_plan)(_q->data.split.fft);
+        liquid_free_aligned(_q->data.split.x);
+        liquid_free_aligned(_q->data.split.y);
+    } else {
+        FFT(_table_release)(_q->data.split.index_rev);
+        liquid_free_aligned(_q->data.split.twiddle);
+    }
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// radix-4 stage on split arrays, scalar (see fft_radix4_stage())
+//  _yr, _yi:   input/output array, real and imaginary parts
+//  _n      :   transform size
+//  _L      :   sub-transform size
+//  _w      :   stage twiddles [size: 4*_L x 1] (see fft_create_plan_split())
+//  _d      :   rotation by d*j: -1 (forward), +1 (backward)
+static void FFT(_split_radix4_stage)(T *          _yr,
+                                     T *          _yi,
+                                     unsigned int _n,
+                                     unsigned int _L,
+                                     const T *    _w,
+                                     T            _d)
+{
+    const T * w1r = _w;
+    const T * w1i = _w +   _L;
+    const T * w2r = _w + 2*_L;
+    const T * w2i = _w + 3*_L;
+    unsigned int b, j;
+    for (b=0; b<_n; b+=4*_L) {
+        T * y0r = _yr + b,  * y0i = _yi + b;
+        T * y1r = y0r + _L, * y1i = y0i + _L;
+        T * y2r = y1r + _L, * y2i = y1i + _L;
+        T * y3r = y2r + _L, * y3i = y2i + _L;
+        for (j=0; j<_L; j++) {
+            // first radix-2 step: twiddle W^(2i)
+            T t1r = y1r[j]*w2r[j] - y1i[j]*w2i[j];
+            T t1i = y1r[j]*w2i[j] + y1i[j]*w2r[j];
+            T t3r = y3r[j]*w2r[j] - y3i[j]*w2i[j];
+            T t3i = y3r[j]*w2i[j] + y3i[j]*w2r[j];
+
+            T a0r = y0r[j] + t1r, a0i = y0i[j] + t1i;
+            T a1r = y0r[j] - t1r, a1i = y0i[j] - t1i;
+            T a2r = y2r[j] + t3r, a2i = y2i[j] + t3i;
+            T a3r = y2r[j] - t3r, a3i = y2i[j] - t3i;
+
+            // second radix-2 step: twiddles W^i and d*j*W^i
+            T b2r = a2r*w1r[j] - a2i*w1i[j];
+            T b2i = a2r*w1i[j] + a2i*w1r[j];
+            T b3r = -_d*(a3r*w1i[j] + a3i*w1r[j]);
+            T b3i =  _d*(a3r*w1r[j] - a3i*w1i[j]);
+
+            y0r[j] = a0r + b2r;  y0i[j] = a0i + b2i;
+            y2r[j] = a0r - b2r;  y2i[j] = a0i - b2i;
+            y1r[j] = a1r + b3r;  y1i[j] = a1i + b3i;
+            y3r[j] = a1r - b3r;  y3i[j] = a1i - b3i;
+        }
+    }
+}
+
+// radix-2 stage of 2-point butterflies on split arrays, scalar
+static void FFT(_split_radix2_stage)(T *          _yr,
+                                     T *          _yi,
+                                     unsigned int _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i+=2) {
+        T pr = _yr[i+1], pi = _yi[i+1];
+        _yr[i+1] = _yr[i] - pr;  _yi[i+1] = _yi[i] - pi;
+        _yr[i  ] += pr;          _yi[i  ] += pi;
+    }
+}
+
+#if HAVE_DOTPROD_AVX
+// radix-4 butterflies on the four quarters _r[k], _i[k] (real and
+// imaginary parts), eight lanes (AVX2/FMA)
+__attribute__((target("avx2,fma")))
+static inline void FFT(_split_butterfly_avx2)(__m256 * _r,
+                                              __m256 * _i,
+                                              __m256   _w1r,
+                                              __m256   _w1i,
+                                              __m256   _w2r,
+                                              __m256   _w2i,
+                                              __m256   _d)
+{
+    // first radix-2 step: twiddle W^(2i)
+    __m256 t1r = _mm256_fmsub_ps(_r[1], _w2r, _mm256_mul_ps(_i[1], _w2i));
+    __m256 t1i = _mm256_fmadd_ps(_r[1], _w2i, _mm256_mul_ps(_i[1], _w2r));
+    __m256 t3r = _mm256_fmsub_ps(_r[3], _w2r, _mm256_mul_ps(_i[3], _w2i));
+    __m256 t3i = _mm256_fmadd_ps(_r[3], _w2i, _mm256_mul_ps(_i[3], _w2r));
+
+    __m256 a0r = _mm256_add_ps(_r[0], t1r), a0i = _mm256_add_ps(_i[0], t1i);
+    __m256 a1r = _mm256_sub_ps(_r[0], t1r), a1i = _mm256_sub_ps(_i[0], t1i);
+    __m256 a2r = _mm256_add_ps(_r[2], t3r), a2i = _mm256_add_ps(_i[2], t3i);
+    __m256 a3r = _mm256_sub_ps(_r[2], t3r), a3i = _mm256_sub_ps(_i[2], t3i);
+
+    // second radix-2 step: twiddles W^i and d*j*W^i
+    __m256 b2r = _mm256_fmsub_ps(a2r, _w1r, _mm256_mul_ps(a2i, _w1i));
+    __m256 b2i = _mm256_fmadd_ps(a2r, _w1i, _mm256_mul_ps(a2i, _w1r));
+    __m256 c3r = _mm256_fmsub_ps(a3r, _w1r, _mm256_mul_ps(a3i, _w1i));
+    __m256 c3i = _mm256_fmadd_ps(a3r, _w1i, _mm256_mul_ps(a3i, _w1r));
+    __m256 b3r = _mm256_fnmadd_ps(_d, c3i, _mm256_setzero_ps());
+    __m256 b3i = _mm256_mul_ps(_d, c3r);
+
+    _r[0] = _mm256_add_ps(a0r, b2r);  _i[0] = _mm256_add_ps(a0i, b2i);
+    _r[2] = _mm256_sub_ps(a0r, b2r);  _i[2] = _mm256_sub_ps(a0i, b2i);
+    _r[1] = _mm256_add_ps(a1r, b3r);  _i[1] = _mm256_add_ps(a1i, b3i);
+    _r[3] = _mm256_sub_ps(a1r, b3r);  _i[3] = _mm256_sub_ps(a1i, b3i);
+}
+
+// radix-4 butterflies, four lanes (SSE with FMA)
+__attribute__((target("avx2,fma")))
+static inline void FFT(_split_butterfly_sse)(__m128 * _r,
+                                             __m128 * _i,
+                                             __m128   _w1r,
+                                             __m128   _w1i,
+                                             __m128   _w2r,
+                                             __m128   _w2i,
+                                             __m128   _d)
+{
+    __m128 t1r = _mm_fmsub_ps(_r[1], _w2r, _mm_mul_ps(_i[1], _w2i));
+    __m128 t1i = _mm_fmadd_ps(_r[1], _w2i, _mm_mul_ps(_i[1], _w2r));
+    __m128 t3r = _mm_fmsub_ps(_r[3], _w2r, _mm_mul_ps(_i[3], _w2i));
+    __m128 t3i = _mm_fmadd_ps(_r[3], _w2i, _mm_mul_ps(_i[3], _w2r));
+
+    __m128 a0r = _mm_add_ps(_r[0], t1r), a0i = _mm_add_ps(_i[0], t1i);
+    __m128 a1r = _mm_sub_ps(_r[0], t1r), a1i = _mm_sub_ps(_i[0], t1i);
+    __m128 a2r = _mm_add_ps(_r[2], t3r), a2i = _mm_add_ps(_i[2], t3i);
+    __m128 a3r = _mm_sub_ps(_r[2], t3r), a3i = _mm_sub_ps(_i[2], t3i);
+
+    __m128 b2r = _mm_fmsub_ps(a2r, _w1r, _mm_mul_ps(a2i, _w1i));
+    __m128 b2i = _mm_fmadd_ps(a2r, _w1i, _mm_mul_ps(a2i, _w1r));
+    __m128 c3r = _mm_fmsub_ps(a3r, _w1r, _mm_mul_ps(a3i, _w1i));
+    __m128 c3i = _mm_fmadd_ps(a3r, _w1i, _mm_mul_ps(a3i, _w1r));
+    __m128 b3r = _mm_fnmadd_ps(_d, c3i, _mm_setzero_ps());
+    __m128 b3i = _mm_mul_ps(_d, c3r);
+
+    _r[0] = _mm_add_ps(a0r, b2r);  _i[0] = _mm_add_ps(a0i, b2i);
+    _r[2] = _mm_sub_ps(a0r, b2r);  _i[2] = _mm_sub_ps(a0i, b2i);
+    _r[1] = _mm_add_ps(a1r, b3r);  _i[1] = _mm_add_ps(a1i, b3i);
+    _r[3] = _mm_sub_ps(a1r, b3r);  _i[3] = _mm_sub_ps(a1i, b3i);
+}
+
+// transpose 4x4 blocks within each 128-bit lane (AVX2)
+__attribute__((target("avx2")))
+static inline void FFT(_split_transpose_avx2)(__m256 * _v)
+{
+    __m256 t0 = _mm256_unpacklo_ps(_v[0], _v[1]);
+    __m256 t1 = _mm256_unpackhi_ps(_v[0], _v[1]);
+    __m256 t2 = _mm256_unpacklo_ps(_v[2], _v[3]);
+    __m256 t3 = _mm256_unpackhi_ps(_v[2], _v[3]);
+    _v[0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+    _v[1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+    _v[2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+    _v[3] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+}
+
+// run all butterfly stages on bit-reversed split arrays (AVX2/FMA):
+// stages too narrow for full vectors regroup butterflies so that
+// each lane still holds one butterfly
+__attribute__((target("avx2,fma")))
+static void FFT(_split_stages_avx2)(T *          _yr,
+                                    T *          _yi,
+                                    unsigned int _n,
+                                    unsigned int _m,
+                                    const T *    _w,
+                                    T            _d)
+{
+    __m256 d   = _mm256_set1_ps(_d);
+    __m128 d4  = _mm_set1_ps(_d);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 zero= _mm256_setzero_ps();
+    __m256 r[4], q[4];
+    __m128 r4[4], q4[4];
+    unsigned int b, j, k;
+
+    unsigned int L = 1;
+    if (_m & 1) {
+        // radix-2 stage: even/odd values of 16 at a time
+        if (_n >= 16) {
+            for (b=0; b<_n; b+=16) {
+                T * p[2] = {_yr + b, _yi + b};
+                for (k=0; k<2; k++) {
+                    __m256 v0 = _mm256_loadu_ps(p[k]);
+                    __m256 v1 = _mm256_loadu_ps(p[k]+8);
+                    __m256 e  = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+                    __m256 o  = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+                    __m256 s  = _mm256_add_ps(e, o);
+                    __m256 t  = _mm256_sub_ps(e, o);
+                    _mm256_storeu_ps(p[k],   _mm256_unpacklo_ps(s, t));
+                    _mm256_storeu_ps(p[k]+8, _mm256_unpackhi_ps(s, t));
+                }
+            }
+        } else {
+            FFT(_split_radix2_stage)(_yr, _yi, _n);
+        }
+        L = 2;
+    }
+
+    for ( ; L<_n; L*=4) {
+        if (L >= 8) {
+            for (b=0; b<_n; b+=4*L) {
+                for (j=0; j<L; j+=8) {
+                    for (k=0; k<4; k++) {
+                        r[k] = _mm256_loadu_ps(_yr + b + k*L + j);
+                        q[k] = _mm256_loadu_ps(_yi + b + k*L + j);
+                    }
+                    FFT(_split_butterfly_avx2)(r, q,
+                            _mm256_loadu_ps(_w +     j), _mm256_loadu_ps(_w +   L + j),
+                            _mm256_loadu_ps(_w + 2*L+j), _mm256_loadu_ps(_w + 3*L + j), d);
+                    for (k=0; k<4; k++) {
+                        _mm256_storeu_ps(_yr + b + k*L + j, r[k]);
+                        _mm256_storeu_ps(_yi + b + k*L + j, q[k]);
+                    }
+                }
+            }
+        } else if (L == 4) {
+            // one quarter per 128-bit vector
+            __m128 w1r = _mm_loadu_ps(_w   ), w1i = _mm_loadu_ps(_w+ 4);
+            __m128 w2r = _mm_loadu_ps(_w+ 8), w2i = _mm_loadu_ps(_w+12);
+            for (b=0; b<_n; b+=16) {
+                for (k=0; k<4; k++) {
+                    r4[k] = _mm_loadu_ps(_yr + b + 4*k);
+                    q4[k] = _mm_loadu_ps(_yi + b + 4*k);
+                }
+                FFT(_split_butterfly_sse)(r4, q4, w1r, w1i, w2r, w2i, d4);
+                for (k=0; k<4; k++) {
+                    _mm_storeu_ps(_yr + b + 4*k, r4[k]);
+                    _mm_storeu_ps(_yi + b + 4*k, q4[k]);
+                }
+            }
+        } else if (L == 2 && _n >= 16) {
+            // quarters of two consecutive blocks share a vector
+            __m128 w1r = _mm_setr_ps(_w[0], _w[1], _w[0], _w[1]);
+            __m128 w1i = _mm_setr_ps(_w[2], _w[3], _w[2], _w[3]);
+            __m128 w2r = _mm_setr_ps(_w[4], _w[5], _w[4], _w[5]);
+            __m128 w2i = _mm_setr_ps(_w[6], _w[7], _w[6], _w[7]);
+            for (b=0; b<_n; b+=16) {
+                for (k=0; k<4; k++) {
+                    r4[k] = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (__m64*)(_yr+b+2*k)), (__m64*)(_yr+b+8+2*k));
+                    q4[k] = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (__m64*)(_yi+b+2*k)), (__m64*)(_yi+b+8+2*k));
+                }
+                FFT(_split_butterfly_sse)(r4, q4, w1r, w1i, w2r, w2i, d4);
+                for (k=0; k<4; k++) {
+                    _mm_storel_pi((__m64*)(_yr+b+2*k),   r4[k]);
+                    _mm_storeh_pi((__m64*)(_yr+b+8+2*k), r4[k]);
+                    _mm_storel_pi((__m64*)(_yi+b+2*k),   q4[k]);
+                    _mm_storeh_pi((__m64*)(_yi+b+8+2*k), q4[k]);
+                }
+            }
+        } else if (L == 1 && _n >= 32) {
+            // eight 4-point butterflies on 32 consecutive values,
+            // transposed so that each lane holds one butterfly
+            for (b=0; b<_n; b+=32) {
+                for (k=0; k<4; k++) {
+                    r[k] = _mm256_loadu_ps(_yr + b + 8*k);
+                    q[k] = _mm256_loadu_ps(_yi + b + 8*k);
+                }
+                FFT(_split_transpose_avx2)(r);
+                FFT(_split_transpose_avx2)(q);
+                FFT(_split_butterfly_avx2)(r, q, one, zero, one, zero, d);
+                FFT(_split_transpose_avx2)(r);
+                FFT(_split_transpose_avx2)(q);
+                for (k=0; k<4; k++) {
+                    _mm256_storeu_ps(_yr + b + 8*k, r[k]);
+                    _mm256_storeu_ps(_yi + b + 8*k, q[k]);
+                }
+            }
+        } else {
+            FFT(_split_radix4_stage)(_yr, _yi, _n, L, _w, _d);
+        }
+        _w += 4*L;
+    }
+}
+#endif
+
+// execute split-complex transform
+void FFT(_execute_split)(FFT(plan) _q)
+{
+    unsigned int n = _q->nfft;
+    T * xr = _q->xr;
+    T * xi = _q->data.split.xi;
+    T * yr = _q->yr;
+    T * yi = _q->data.split.yi;
+    unsigned int i;
+
+    if (_q->data.split.fft != NULL) {
+        // read input completely before writing so that the transform
+        // may run in place
+        liquid_vectorcf_merge(xr, xi, n, _q->data.split.x);
+        FFT(_execute)(_q->data.split.fft);
+        liquid_vectorcf_split(_q->data.split.y, n, yr, yi);
+        return;
+    }
+
+    // bit-reversal permutation, swapping pairs when in place
+    const unsigned int * rev = _q->data.split.index_rev;
+    if (xr == yr && xi == yi) {
+        for (i=0; i<n; i++) {
+            unsigned int k = rev[i];
+            if (k > i) {
+                T tr = yr[i]; yr[i] = yr[k]; yr[k] = tr;
+                T ti = yi[i]; yi[i] = yi[k]; yi[k] = ti;
+            }
+        }
+    } else {
+        for (i=0; i<n; i++) {
+            yr[i] = xr[rev[i]];
+            yi[i] = xi[rev[i]];
+        }
+    }
+
+    T d = _q->direction == LIQUID_FFT_FORWARD ? -1.0f : 1.0f;
+    const T * w = _q->data.split.twiddle;
+#if HAVE_DOTPROD_AVX
+    liquid_simd_level level = liquid_simd_get_kernel(LIQUID_SIMD_FFT);
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        FFT(_split_stages_avx2)(yr, yi, n, _q->data.split.m, w, d);
+        return;
+    }
+#endif
+
+    // odd number of radix-2 stages: start with a single stage of
+    // 2-point butterflies
+    unsigned int L = 1;
+    if (_q->data.split.m & 1) {
+        FFT(_split_radix2_stage)(yr, yi, n);
+        L = 2;
+    }
+
+    // remaining stages combined pairwise in radix-4 butterflies
+    for ( ; L<n; L*=4) {
+        FFT(_split_radix4_stage)(yr, yi, n, L, w, d);
+        w += 4*L;
+    }
+}
+
+// perform n-point split-complex FFT allocating plan internally
+//  _n      :   fft size
+//  _xr     :   input array, real part [size: _n x 1]
+//  _xi     :   input array, imaginary part [size: _n x 1]
+//  _yr     :   output array, real part [size: _n x 1]
+//  _yi     :   output array, imaginary part [size: _n x 1]
+//  _dir    :   fft direction: LIQUID_FFT_{FORWARD,BACKWARD}
+//  _flags  :   fft flags
+void FFT(_run_split)(unsigned int _n,
+                     T *          _xr,
+                     T *          _xi,
+                     T *          _yr,
+                     T *          _yi,
+                     int          _dir,
+                     int          _flags)
+{
+    FFT(plan) q = FFT(_create_plan_split)(_n, _xr, _xi, _yr, _yi, _dir, _flags);
+    FFT(_execute)(q);
+    FFT(_destroy_plan)(q);
+}
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_stockham.c : Stockham auto-sort transform
+//
+// Each stage of radix r reads the whole array once and writes it once
+// to a second buffer in an order which is already sorted for the next
+// stage, so neither a bit-reversal permutation nor a final transpose
+// is needed. For a stage with current sub-transform length n, stride s
+// and m = n/r, the stage computes
+//
+//   y[q + s*(r*p + k)] = W_n^(p*k) sum_t x[q + s*(p + t*m)] W_r^(t*k)
+//
+// for p in [0,m), q in [0,s) and k in [0,r), with W_n = exp(d*j*2*pi/n)
+// and d=-1 (forward) or d=+1 (backward). The inner loop over q streams
+// through contiguous memory with constant twiddle factors.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// get size of shared twiddle table: for each stage, r roots of unity
+// W_r^t followed by (r-1) twiddle factors W_n^(p*k) for each p
+static unsigned int FFT(_stockham_table_len)(unsigned int   _nfft,
+                                             unsigned int * _radix,
+                                             unsigned int   _num_stages)
+{
+    unsigned int i, n = _nfft, len = 0;
+    for (i=0; i<_num_stages; i++) {
+        len += _radix[i] + (n/_radix[i])*(_radix[i]-1);
+        n /= _radix[i];
+    }
+    return len;
+}
+
+// create FFT plan for Stockham auto-sort transform
+//  _nfft   :   FFT size (only prime factors up to LIQUID_FFT_STOCKHAM_MAX_RADIX)
+//  _x      :   input array [size: _nfft x 1]
+//  _y      :   output array [size: _nfft x 1]
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_stockham)(unsigned int _nfft,
+                                     TC *         _x,
+                                     TC *         _y,
+                                     int          _dir,
+                                     int          _flags)
+{
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) liquid_malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->x         = _x;
+    q->y         = _y;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_STOCKHAM;
+
+    q->execute   = FFT(_execute_stockham);
+
+    q->data.stockham.num_stages = fft_stockham_factor(q->nfft, q->data.stockham.radix);
+    if (q->data.stockham.num_stages == 0) {
+        fprintf(stderr,"error: fft_create_plan_stockham(), _nfft=%u has prime factor larger than %u\n",
+                _nfft, LIQUID_FFT_STOCKHAM_MAX_RADIX);
+        exit(1);
+    }
+
+    // ping-pong buffer
+    q->data.stockham.buf = (TC *) liquid_malloc_aligned(q->nfft*sizeof(TC));
+
+    // shared roots of unity and twiddle factors
+    q->data.stockham.twiddle = (TC *) FFT(_table_find)(LIQUID_FFT_TABLE_STOCKHAM, q->nfft, q->direction);
+    if (q->data.stockham.twiddle != NULL)
+        return q;
+
+    TC * twiddle = (TC *) liquid_malloc(FFT(_stockham_table_len)(q->nfft,
+                                                          q->data.stockham.radix,
+                                                          q->data.stockham.num_stages)*sizeof(TC));
+    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    TC * w = twiddle;
+    unsigned int i, p, k, n = q->nfft;
+    for (i=0; i<q->data.stockham.num_stages; i++) {
+        unsigned int r = q->data.stockham.radix[i];
+        unsigned int m = n / r;
+        for (k=0; k<r; k++)
+            *w++ = cexpf(_Complex_I*d*2*M_PI*(T)k / (T)r);
+        for (p=0; p<m; p++) {
+            for (k=1; k<r; k++)
+                *w++ = cexpf(_Complex_I*d*2*M_PI*(T)((p*k) % n) / (T)n);
+        }
+        n = m;
+    }
+    q->data.stockham.twiddle = (TC *) FFT(_table_insert)(LIQUID_FFT_TABLE_STOCKHAM, q->nfft, q->direction, twiddle);
+
+    return q;
+}
+
+// destroy FFT plan
+void FFT(_destroy_plan_stockham)(FFT(plan) _q)
+{
+    // free data specific to Stockham transforms
+    liquid_free_aligned(_q->data.stockham.buf);
+    FFT(_table_release)(_q->data.stockham.twiddle);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// compute single Stockham stage
+//  _x      :   stage input
+//  _y      :   stage output
+//  _n      :   current sub-transform length
+//  _s      :   stride (product of previous radices)
+//  _r      :   radix
+//  _w      :   roots of unity [size: _r x 1] followed by twiddle factors
+//  _d      :   direction sign (-1 forward, +1 backward)
+static void FFT(_stockham_stage)(TC *         _x,
+                                 TC *         _y,
+                                 unsigned int _n,
+                                 unsigned int _s,
+                                 unsigned int _r,
+                                 TC *         _w,
+                                 T            _d)
+{
+    unsigned int m = _n / _r;
+    unsigned int p, q, k, t;
+    TC * tw = _w + _r;
+
+    switch (_r) {
+    case 2:
+        for (p=0; p<m; p++) {
+            TC w1 = tw[p];
+            TC * x0 = _x + _s*p;
+            TC * x1 = _x + _s*(p+m);
+            TC * y0 = _y + _s*2*p;
+            TC * y1 = y0 + _s;
+            for (q=0; q<_s; q++) {
+                TC a = x0[q];
+                TC b = x1[q];
+                y0[q] =  a + b;
+                y1[q] = (a - b)*w1;
+            }
+        }
+        break;
+
+    case 4:
+        for (p=0; p<m; p++) {
+            TC w1 = tw[3*p  ];
+            TC w2 = tw[3*p+1];
+            TC w3 = tw[3*p+2];
+            TC * x0 = _x + _s*p;
+            TC * x1 = x0 + _s*m;
+            TC * x2 = x1 + _s*m;
+            TC * x3 = x2 + _s*m;
+            TC * y0 = _y + _s*4*p;
+            TC * y1 = y0 + _s;
+            TC * y2 = y1 + _s;
+            TC * y3 = y2 + _s;
+            for (q=0; q<_s; q++) {
+                TC apc = x0[q] + x2[q];
+                TC amc = x0[q] - x2[q];
+                TC bpd = x1[q] + x3[q];
+                TC bmd = x1[q] - x3[q];
+                // rotate by W_4 = d*j
+                TC jbmd = _d*(-cimagf(bmd) + _Complex_I*crealf(bmd));
+                y0[q] =  apc + bpd;
+                y1[q] = (amc + jbmd)*w1;
+                y2[q] = (apc - bpd)*w2;
+                y3[q] = (amc - jbmd)*w3;
+            }
+        }
+        break;
+
+    case 3:
+        for (p=0; p<m; p++) {
+            TC w1 = tw[2*p  ];
+            TC w2 = tw[2*p+1];
+            TC * x0 = _x + _s*p;
+            TC * x1 = x0 + _s*m;
+            TC * x2 = x1 + _s*m;
+            TC * y0 = _y + _s*3*p;
+            TC * y1 = y0 + _s;
+            TC * y2 = y1 + _s;
+            for (q=0; q<_s; q++) {
+                TC bpc = x1[q] + x2[q];
+                TC bmc = x1[q] - x2[q];
+                TC t0  = x0[q] - 0.5f*bpc;
+                // (d*j*sqrt(3)/2)*(b-c)
+                TC t1  = _d*0.866025403784439f*(-cimagf(bmc) + _Complex_I*crealf(bmc));
+                y0[q] =  x0[q] + bpc;
+                y1[q] = (t0 + t1)*w1;
+                y2[q] = (t0 - t1)*w2;
+            }
+        }
+        break;
+
+    case 5:
+        for (p=0; p<m; p++) {
+            TC * x0 = _x + _s*p;
+            TC * x1 = x0 + _s*m;
+            TC * x2 = x1 + _s*m;
+            TC * x3 = x2 + _s*m;
+            TC * x4 = x3 + _s*m;
+            TC * y0 = _y + _s*5*p;
+            TC * w  = tw + 4*p;
+            for (q=0; q<_s; q++) {
+                // cos(2*pi/5), cos(4*pi/5), sin(2*pi/5), sin(4*pi/5)
+                const T c1 =  0.309016994374947f;
+                const T c2 = -0.809016994374947f;
+                const T s1 =  0.951056516295154f;
+                const T s2 =  0.587785252292473f;
+                TC t1 = x1[q] + x4[q];
+                TC t2 = x1[q] - x4[q];
+                TC t3 = x2[q] + x3[q];
+                TC t4 = x2[q] - x3[q];
+                TC a1 = x0[q] + c1*t1 + c2*t3;
+                TC a2 = x0[q] + c2*t1 + c1*t3;
+                // rotate by d*j
+                TC b1 = s1*t2 + s2*t4;
+                TC b2 = s2*t2 - s1*t4;
+                b1 = _d*(-cimagf(b1) + _Complex_I*crealf(b1));
+                b2 = _d*(-cimagf(b2) + _Complex_I*crealf(b2));
+                y0[q      ] =  x0[q] + t1 + t3;
+                y0[q +   _s] = (a1 + b1)*w[0];
+                y0[q + 2*_s] = (a2 + b2)*w[1];
+                y0[q + 3*_s] = (a2 - b2)*w[2];
+                y0[q + 4*_s] = (a1 - b1)*w[3];
+            }
+        }
+        break;
+
+    default:
+        // generic radix (odd primes above 5)
+        for (p=0; p<m; p++) {
+            TC * y = _y + _s*_r*p;
+            for (q=0; q<_s; q++) {
+                TC v[LIQUID_FFT_STOCKHAM_MAX_RADIX];
+                for (t=0; t<_r; t++)
+                    v[t] = _x[q + _s*(p + t*m)];
+                for (k=0; k<_r; k++) {
+                    TC sum = v[0];
+                    for (t=1; t<_r; t++)
+                        sum += v[t] * _w[(t*k) % _r];
+                    y[q + _s*k] = k == 0 ? sum : sum * tw[(_r-1)*p + k-1];
+                }
+            }
+        }
+    }
+}
+
+// execute Stockham auto-sort transform
+void FFT(_execute_stockham)(FFT(plan) _q)
+{
+    unsigned int num_stages = _q->data.stockham.num_stages;
+    T d = (_q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+
+    // alternate between output and internal buffer such that the last
+    // stage writes to the output; in-place transforms with an odd
+    // number of stages first copy the input to the internal buffer
+    TC * x = _q->x;
+    TC * a = (num_stages & 1) ? _q->y : _q->data.stockham.buf;
+    TC * b = (num_stages & 1) ? _q->data.stockham.buf : _q->y;
+    if (x == a) {
+        memmove(_q->data.stockham.buf, x, _q->nfft*sizeof(TC));
+        x = _q->data.stockham.buf;
+    }
+
+    TC * w = _q->data.stockham.twiddle;
+    unsigned int i, n = _q->nfft, s = 1;
+    for (i=0; i<num_stages; i++) {
+        unsigned int r = _q->data.stockham.radix[i];
+        FFT(_stockham_stage)(x, a, n, s, r, w, d);
+        w += r + (n/r)*(r-1);
+
+        // next stage reads this stage's output
+        x = a;
+        a = b;
+        b = x;
+        n /= r;
+        s *= r;
+    }
+}
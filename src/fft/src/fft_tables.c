@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_tables.c : shared twiddle factor and index tables
+//
+// Tables depend only on the transform size and direction, so every
+// plan of the same size shares a single immutable copy. Each table is
+// reference counted: the first plan to request it computes it, later
+// plans only increment the count, and the table is freed when the last
+// plan using it is destroyed. The table list is shared by the whole
+// process and is guarded by a mutex, so plans may be created and
+// destroyed from multiple threads.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// shared table entry
+struct FFT(_table_s) {
+    liquid_fft_table        kind;       // table type
+    unsigned int            n;          // transform size
+    int                     dir;        // transform direction
+    void *                  data;       // table data
+    unsigned int            count;      // number of plans using table
+    struct FFT(_table_s) *  next;       // next entry in list
+};
+
+// list of shared tables
+static struct FFT(_table_s) * FFT(_tables) = NULL;
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+static pthread_mutex_t FFT(_tables_mutex) = PTHREAD_MUTEX_INITIALIZER;
+#define LIQUID_FFT_TABLES_LOCK()   pthread_mutex_lock(&FFT(_tables_mutex))
+#define LIQUID_FFT_TABLES_UNLOCK() pthread_mutex_unlock(&FFT(_tables_mutex))
+#else
+#define LIQUID_FFT_TABLES_LOCK()
+#define LIQUID_FFT_TABLES_UNLOCK()
+#endif
+
+// free table data
+static void FFT(_table_free)(struct FFT(_table_s) * _t);
+
+// find table in list, incrementing its reference count; list must be locked
+static void * FFT(_table_find_locked)(liquid_fft_table _kind,
+                                      unsigned int     _n,
+                                      int              _dir)
+{
+    struct FFT(_table_s) * t;
+    for (t=FFT(_tables); t!=NULL; t=t->next) {
+        if (t->kind == _kind && t->n == _n && t->dir == _dir) {
+            t->count++;
+            return t->data;
+        }
+    }
+    return NULL;
+}
+
+// find shared table, incrementing its reference count; returns NULL
+// if the table does not exist
+//  _kind   :   table type
+//  _n      :   transform size
+//  _dir    :   transform direction (ignored by direction-independent tables)
+void * FFT(_table_find)(liquid_fft_table _kind,
+                        unsigned int     _n,
+                        int              _dir)
+{
+    LIQUID_FFT_TABLES_LOCK();
+    void * data = FFT(_table_find_locked)(_kind, _n, _dir);
+    LIQUID_FFT_TABLES_UNLOCK();
+    return data;
+}
+
+// insert newly computed table with a reference count of one, returning
+// the table data; if another thread inserted the same table in the
+// meantime, the new copy is freed and the existing table is returned
+//  _kind   :   table type
+//  _n      :   transform size
+//  _dir    :   transform direction
+//  _data   :   table data (ownership is transferred to the table list)
+void * FFT(_table_insert)(liquid_fft_table _kind,
+                          unsigned int     _n,
+                          int              _dir,
+                          void *           _data)
+{
+    struct FFT(_table_s) * t = (struct FFT(_table_s) *) liquid_malloc(sizeof(struct FFT(_table_s)));
+    t->kind  = _kind;
+    t->n     = _n;
+    t->dir   = _dir;
+    t->data  = _data;
+    t->count = 1;
+
+    LIQUID_FFT_TABLES_LOCK();
+    void * data = FFT(_table_find_locked)(_kind, _n, _dir);
+    if (data == NULL) {
+        t->next  = FFT(_tables);
+        FFT(_tables) = t;
+        data = _data;
+    }
+    LIQUID_FFT_TABLES_UNLOCK();
+
+    if (data != _data) {
+        // lost the race; discard duplicate copy
+        FFT(_table_free)(t);
+        liquid_free(t);
+    }
+    return data;
+}
+
+// free table data
+static void FFT(_table_free)(struct FFT(_table_s) * _t)
+{
+    unsigned int i;
+    switch (_t->kind) {
+    case LIQUID_FFT_TABLE_TWIDDLE_RADIX2:
+        liquid_free_aligned(_t->data);
+        break;
+    case LIQUID_FFT_TABLE_DFT:
+        for (i=0; i<_t->n; i++)
+            DOTPROD(_destroy)(((DOTPROD()*)_t->data)[i]);
+        liquid_free(_t->data);
+        break;
+    default:
+        liquid_free(_t->data);
+    }
+}
+
+// release table, freeing it once no plan uses it anymore
+//  _data   :   table data returned by a table function (ignored if NULL)
+void FFT(_table_release)(void * _data)
+{
+    if (_data == NULL)
+        return;
+
+    struct FFT(_table_s) * t = NULL;
+    struct FFT(_table_s) ** p;
+    int found = 0;
+    LIQUID_FFT_TABLES_LOCK();
+    for (p=&FFT(_tables); *p!=NULL; p=&(*p)->next) {
+        if ((*p)->data != _data)
+            continue;
+
+        found = 1;
+        if (--(*p)->count == 0) {
+            // unlink; free outside of lock
+            t = *p;
+            *p = t->next;
+        }
+        break;
+    }
+    LIQUID_FFT_TABLES_UNLOCK();
+
+    if (!found) {
+        fprintf(stderr,"error: fft_table_release(), table not found\n");
+        exit(1);
+    }
+
+    if (t != NULL) {
+        FFT(_table_free)(t);
+        liquid_free(t);
+    }
+}
+
+// get number of shared tables currently allocated
+unsigned int FFT(_table_num_entries)(void)
+{
+    unsigned int n = 0;
+    struct FFT(_table_s) * t;
+    LIQUID_FFT_TABLES_LOCK();
+    for (t=FFT(_tables); t!=NULL; t=t->next)
+        n++;
+    LIQUID_FFT_TABLES_UNLOCK();
+    return n;
+}
+
+// get shared bit-reversed indices for radix-2 transform
+//  _nfft   :   transform size (power of two)
+unsigned int * FFT(_table_index_rev)(unsigned int _nfft)
+{
+    unsigned int * index_rev = (unsigned int *) FFT(_table_find)(LIQUID_FFT_TABLE_INDEX_REV, _nfft, 0);
+    if (index_rev != NULL)
+        return index_rev;
+
+    unsigned int m = liquid_msb_index(_nfft) - 1;  // m = log2(nfft)
+    index_rev = (unsigned int *) liquid_malloc(_nfft*sizeof(unsigned int));
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        index_rev[i] = fft_reverse_index(i,m);
+    return (unsigned int *) FFT(_table_insert)(LIQUID_FFT_TABLE_INDEX_REV, _nfft, 0, index_rev);
+}
+
+// get shared per-stage twiddle factors for radix-2 transform (see
+// fft_create_twiddles_radix2())
+//  _nfft   :   transform size (power of two)
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+TC * FFT(_table_twiddle_radix2)(unsigned int _nfft,
+                                int          _dir)
+{
+    TC * twiddle = (TC *) FFT(_table_find)(LIQUID_FFT_TABLE_TWIDDLE_RADIX2, _nfft, _dir);
+    if (twiddle != NULL)
+        return twiddle;
+
+    twiddle = FFT(_create_twiddles_radix2)(liquid_msb_index(_nfft) - 1, _dir);
+    return (TC *) FFT(_table_insert)(LIQUID_FFT_TABLE_TWIDDLE_RADIX2, _nfft, _dir, twiddle);
+}
+
+// get shared twiddle factors exp(d*j*2*pi*i/nfft), i in [0,nfft)
+//  _nfft   :   transform size
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+TC * FFT(_table_twiddle)(unsigned int _nfft,
+                         int          _dir)
+{
+    TC * twiddle = (TC *) FFT(_table_find)(LIQUID_FFT_TABLE_TWIDDLE, _nfft, _dir);
+    if (twiddle != NULL)
+        return twiddle;
+
+    twiddle = (TC *) liquid_malloc(_nfft*sizeof(TC));
+    T d = (_dir == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(_nfft));
+    return (TC *) FFT(_table_insert)(LIQUID_FFT_TABLE_TWIDDLE, _nfft, _dir, twiddle);
+}
+
+// get shared sequence g^(i+1) mod nfft, i in [0,nfft-1), for Rader's
+// algorithm, where g is the primitive root of nfft
+//  _nfft   :   transform size (prime)
+unsigned int * FFT(_table_rader_seq)(unsigned int _nfft)
+{
+    unsigned int * seq = (unsigned int *) FFT(_table_find)(LIQUID_FFT_TABLE_RADER_SEQ, _nfft, 0);
+    if (seq != NULL)
+        return seq;
+
+    // compute primitive root of nfft
+    unsigned int g = liquid_primitive_root_prime(_nfft);
+
+    seq = (unsigned int *) liquid_malloc((_nfft-1)*sizeof(unsigned int));
+    // successive powers, keeping plan creation linear in nfft
+    unsigned int i;
+    unsigned long int c = 1;
+    for (i=0; i<_nfft-1; i++) {
+        c = (c * g) % _nfft;
+        seq[i] = (unsigned int) c;
+    }
+    return (unsigned int *) FFT(_table_insert)(LIQUID_FFT_TABLE_RADER_SEQ, _nfft, 0, seq);
+}
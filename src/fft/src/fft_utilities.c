@@ -43,14 +43,9 @@ liquid_fft_method liquid_fft_estimate_method(unsigned int _nfft)
         return LIQUID_FFT_METHOD_DFT;
 
     } else if (fft_is_radix2(_nfft)) {
-        // transform is of the form 2^m
-#if 0
-        // use radix-2 algorithm
+        // transform is of the form 2^m: use radix-2 algorithm (radix-4
+        // SIMD stages)
         return LIQUID_FFT_METHOD_RADIX2;
-#else
-        // acutally, prefer Cooley-Tukey algorithm
-        return LIQUID_FFT_METHOD_MIXED_RADIX;
-#endif
 
     } else if (liquid_is_prime(_nfft)) {
         // prefer Rader's alternate method (using radix-2 transform)
@@ -62,6 +57,11 @@ liquid_fft_method liquid_fft_estimate_method(unsigned int _nfft)
             return LIQUID_FFT_METHOD_RADER2;
     }
 
+    // only small prime factors: use Stockham auto-sort algorithm
+    unsigned int radix[LIQUID_FFT_STOCKHAM_MAX_STAGES];
+    if (fft_stockham_factor(_nfft, radix) > 0)
+        return LIQUID_FFT_METHOD_STOCKHAM;
+
     // last resort
     //return LIQUID_FFT_METHOD_DFT;         // use slow DFT method
     return LIQUID_FFT_METHOD_MIXED_RADIX;   // use mixed radix method
@@ -98,4 +98,35 @@ unsigned int fft_reverse_index(unsigned int _i, unsigned int _n)
     return j;
 }
 
+// factor transform size into stages of the Stockham auto-sort
+// transform: radix-4 stages first, then radix-2, then odd primes up
+// to LIQUID_FFT_STOCKHAM_MAX_RADIX; returns the number of stages, or
+// zero if _n has a larger prime factor (or is less than 2)
+//  _n      :   transform size
+//  _radix  :   output stage radices [size: LIQUID_FFT_STOCKHAM_MAX_STAGES x 1]
+unsigned int fft_stockham_factor(unsigned int   _n,
+                                 unsigned int * _radix)
+{
+    if (_n < 2)
+        return 0;
+
+    unsigned int num_stages = 0;
+    while ((_n % 4) == 0) {
+        _radix[num_stages++] = 4;
+        _n /= 4;
+    }
+    if ((_n % 2) == 0) {
+        _radix[num_stages++] = 2;
+        _n /= 2;
+    }
+
+    unsigned int r;
+    for (r=3; r<=LIQUID_FFT_STOCKHAM_MAX_RADIX && _n > 1; r+=2) {
+        while ((_n % r) == 0) {
+            _radix[num_stages++] = r;
+            _n /= r;
+        }
+    }
 
+    return _n == 1 ? num_stages : 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_wisdom.c : import/export of FFT plan decisions
+//
+// Wisdom is stored as plain text, one transform per line:
+//
+//      # quiet-dsp fft wisdom
+//      # nfft direction method Q
+//      120 forward mixed-radix 8
+//      157 backward rader2 0
+//
+// where Q is the mixed-radix factor (zero for other methods).
+// Blank lines and lines starting with '#' are ignored. Wisdom is shared
+// by the whole process; every access holds the wisdom lock.
+//
+
+#include <string.h>
+
+// get method name
+static const char * FFT(_wisdom_method_str)(liquid_fft_method _method)
+{
+    switch (_method) {
+    case LIQUID_FFT_METHOD_RADIX2:      return "radix2";
+    case LIQUID_FFT_METHOD_MIXED_RADIX: return "mixed-radix";
+    case LIQUID_FFT_METHOD_RADER:       return "rader";
+    case LIQUID_FFT_METHOD_RADER2:      return "rader2";
+    case LIQUID_FFT_METHOD_DFT:         return "dft";
+    case LIQUID_FFT_METHOD_STOCKHAM:    return "stockham";
+    default:;
+    }
+    return "unknown";
+}
+
+// get method from name
+static liquid_fft_method FFT(_wisdom_method_from_str)(const char * _str)
+{
+    if      (strcmp(_str,"radix2")      == 0) return LIQUID_FFT_METHOD_RADIX2;
+    else if (strcmp(_str,"mixed-radix") == 0) return LIQUID_FFT_METHOD_MIXED_RADIX;
+    else if (strcmp(_str,"rader")       == 0) return LIQUID_FFT_METHOD_RADER;
+    else if (strcmp(_str,"rader2")      == 0) return LIQUID_FFT_METHOD_RADER2;
+    else if (strcmp(_str,"dft")         == 0) return LIQUID_FFT_METHOD_DFT;
+    else if (strcmp(_str,"stockham")    == 0) return LIQUID_FFT_METHOD_STOCKHAM;
+    return LIQUID_FFT_METHOD_UNKNOWN;
+}
+
+// check that method (and factor) can compute transform of this size
+static int FFT(_wisdom_valid)(unsigned int      _nfft,
+                              liquid_fft_method _method,
+                              unsigned int      _Q)
+{
+    switch (_method) {
+    case LIQUID_FFT_METHOD_RADIX2:      return _nfft > 1 && fft_is_radix2(_nfft);
+    case LIQUID_FFT_METHOD_MIXED_RADIX: return _Q > 1 && _Q < _nfft && (_nfft % _Q) == 0;
+    case LIQUID_FFT_METHOD_RADER:
+    case LIQUID_FFT_METHOD_RADER2:      return _nfft > 2 && liquid_is_prime(_nfft);
+    case LIQUID_FFT_METHOD_DFT:         return _nfft > 0;
+    case LIQUID_FFT_METHOD_STOCKHAM: {
+        unsigned int radix[LIQUID_FFT_STOCKHAM_MAX_STAGES];
+        return fft_stockham_factor(_nfft, radix) > 0;
+        }
+    default:;
+    }
+    return 0;
+}
+
+// print wisdom entry to buffer (same semantics as snprintf); wisdom
+// must be locked
+static int FFT(_wisdom_print_entry)(char *       _buf,
+                                    size_t       _n,
+                                    unsigned int _i)
+{
+    return snprintf(_buf, _n, "%u %s %s %u\n",
+                    FFT(_wisdom)[_i].nfft,
+                    FFT(_wisdom)[_i].dir == LIQUID_FFT_FORWARD ? "forward" : "backward",
+                    FFT(_wisdom_method_str)(FFT(_wisdom)[_i].method),
+                    FFT(_wisdom)[_i].Q);
+}
+
+// parse single line of wisdom, storing entry if valid; returns 1 if
+// entry was stored, 0 if line is blank or a comment, -1 if invalid
+static int FFT(_wisdom_parse_line)(const char * _line)
+{
+    // skip leading white space
+    while (*_line == ' ' || *_line == '\t')
+        _line++;
+    if (*_line == '\0' || *_line == '\n' || *_line == '\r' || *_line == '#')
+        return 0;
+
+    unsigned int nfft;
+    unsigned int Q;
+    char dir_str[16];
+    char method_str[16];
+    if (sscanf(_line, "%u %15s %15s %u", &nfft, dir_str, method_str, &Q) != 4)
+        return -1;
+
+    int dir;
+    if      (strcmp(dir_str,"forward")  == 0) dir = LIQUID_FFT_FORWARD;
+    else if (strcmp(dir_str,"backward") == 0) dir = LIQUID_FFT_BACKWARD;
+    else return -1;
+
+    liquid_fft_method method = FFT(_wisdom_method_from_str)(method_str);
+    if (!FFT(_wisdom_valid)(nfft, method, Q))
+        return -1;
+
+    if (FFT(_wisdom_store)(nfft, dir, method, Q) < 0) {
+        fprintf(stderr,"warning: fft_wisdom_import(), wisdom full; ignoring %u-point transform\n", nfft);
+        return 0;
+    }
+    return 1;
+}
+
+// export wisdom to file
+//  _filename   :   output filename
+// returns 0 on success, -1 if file could not be written
+int FFT(_wisdom_export)(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"w");
+    if (fid == NULL) {
+        fprintf(stderr,"warning: fft_wisdom_export(), could not open '%s' for writing\n", _filename);
+        return -1;
+    }
+
+    char line[64];
+    unsigned int i;
+    fprintf(fid,"# quiet-dsp fft wisdom\n");
+    fprintf(fid,"# nfft direction method Q\n");
+    LIQUID_FFT_WISDOM_LOCK();
+    for (i=0; i<FFT(_wisdom_len); i++) {
+        FFT(_wisdom_print_entry)(line, sizeof(line), i);
+        fputs(line, fid);
+    }
+    LIQUID_FFT_WISDOM_UNLOCK();
+
+    int rc = ferror(fid) ? -1 : 0;
+    if (fclose(fid) != 0)
+        rc = -1;
+    return rc;
+}
+
+// import wisdom from file, merging with existing wisdom (entries in
+// the file replace those for the same size and direction)
+//  _filename   :   input filename
+// returns number of entries imported, -1 if file could not be read
+int FFT(_wisdom_import)(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"r");
+    if (fid == NULL) {
+        fprintf(stderr,"warning: fft_wisdom_import(), could not open '%s' for reading\n", _filename);
+        return -1;
+    }
+
+    char line[256];
+    unsigned int lineno = 0;
+    int num_imported = 0;
+    while (fgets(line, sizeof(line), fid) != NULL) {
+        lineno++;
+        int rc = FFT(_wisdom_parse_line)(line);
+        if (rc < 0)
+            fprintf(stderr,"warning: fft_wisdom_import(), '%s' line %u invalid; ignoring\n", _filename, lineno);
+        else
+            num_imported += rc;
+    }
+    fclose(fid);
+    return num_imported;
+}
+
+// export wisdom to string
+//  _buf        :   output buffer (may be NULL if _n is zero)
+//  _n          :   size of output buffer (including terminating null)
+// returns length of full wisdom string (excluding terminating null);
+// the output is truncated if this is not less than _n
+int FFT(_wisdom_export_string)(char *       _buf,
+                               unsigned int _n)
+{
+    const char * header = "# quiet-dsp fft wisdom\n# nfft direction method Q\n";
+    size_t len = strlen(header);
+    if (_n > 0)
+        snprintf(_buf, _n, "%s", header);
+
+    unsigned int i;
+    LIQUID_FFT_WISDOM_LOCK();
+    for (i=0; i<FFT(_wisdom_len); i++) {
+        char * p = len < _n ? _buf + len  : NULL;
+        size_t r = len < _n ? _n   - len  : 0;
+        len += FFT(_wisdom_print_entry)(p, r, i);
+    }
+    LIQUID_FFT_WISDOM_UNLOCK();
+    return (int)len;
+}
+
+// import wisdom from string, merging with existing wisdom
+//  _str        :   null-terminated wisdom string
+// returns number of entries imported
+int FFT(_wisdom_import_string)(const char * _str)
+{
+    char line[256];
+    unsigned int lineno = 0;
+    int num_imported = 0;
+    while (*_str != '\0') {
+        // copy next line
+        size_t n = strcspn(_str, "\n");
+        size_t k = n < sizeof(line)-1 ? n : sizeof(line)-1;
+        memmove(line, _str, k);
+        line[k] = '\0';
+        _str += n;
+        if (*_str == '\n')
+            _str++;
+
+        lineno++;
+        int rc = FFT(_wisdom_parse_line)(line);
+        if (rc < 0)
+            fprintf(stderr,"warning: fft_wisdom_import_string(), line %u invalid; ignoring\n", lineno);
+        else
+            num_imported += rc;
+    }
+    return num_imported;
+}
+
+// forget all wisdom
+void FFT(_wisdom_forget)(void)
+{
+    LIQUID_FFT_WISDOM_LOCK();
+    FFT(_wisdom_len) = 0;
+    LIQUID_FFT_WISDOM_UNLOCK();
+}
+
+// print wisdom to stdout
+void FFT(_wisdom_print)(void)
+{
+    char line[64];
+    unsigned int i;
+    LIQUID_FFT_WISDOM_LOCK();
+    printf("fft wisdom [%u entries]:\n", FFT(_wisdom_len));
+    for (i=0; i<FFT(_wisdom_len); i++) {
+        FFT(_wisdom_print_entry)(line, sizeof(line), i);
+        printf("  %s", line);
+    }
+    LIQUID_FFT_WISDOM_UNLOCK();
+}
@@ -38,10 +38,17 @@
 
 // include main files
 #include "fft_common.c"         // common source must come first (object definition)
+#include "fft_tables.c"         // shared twiddle factor and index tables
 #include "fft_dft.c"            // FFT definitions for DFT
 #include "fft_radix2.c"         // FFT definitions for radix-2 transforms
 #include "fft_mixed_radix.c"    // FFT definitions for mixed-radix transforms (Cooley-Tukey)
 #include "fft_rader.c"          // FFT definitions for transforms of prime length (Rader's algorithm)
 #include "fft_rader2.c"         // FFT definitions for transforms of prime length (Rader's alternate algorithm)
+#include "fft_stockham.c"       // FFT definitions for Stockham auto-sort transforms
 #include "fft_r2r_1d.c"         // real-to-real definitions (DCT/DST)
+#include "fft_r2c.c"            // real-to-complex/complex-to-real definitions
+#include "fft_many.c"           // batches of equal-size transforms
+#include "fft_pruned.c"         // transforms with pruned input or output
+#include "fft_split.c"          // transforms on split-complex arrays
+#include "fft_wisdom.c"         // import/export of plan decisions
 
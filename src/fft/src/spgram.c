@@ -43,11 +43,16 @@ struct SPGRAM(_s) {
     float           gamma;          // spectrum smoothing filter: feedback parameter
     int             accumulate;     // accumulate? or use time-average
 
-    WINDOW()        buffer;         // input buffer
-    TC *            buf_time;       // pointer to input array (allocated)
-    TC *            buf_freq;       // output fft (allocated)
+    TI *            ring;           // input ring buffer [size: window_len x 1]
+    unsigned int    ring_index;     // ring write index (oldest sample)
+    TI *            buf_time;       // pointer to input array (allocated)
+    TC *            buf_freq;       // output fft (allocated); real input
+                                    // only keeps the nfft/2+1 non-negative
+                                    // frequencies
     T  *            w;              // tapering window [size: window_len x 1]
     FFT_PLAN        fft;            // FFT plan
+    int             shared;         // window, FFT buffers and plan borrowed
+                                    // from another object (see _multi)
 
     // psd accumulation
     T *             psd;                    // accumulated power spectral density estimate (linear)
@@ -56,6 +61,12 @@ struct SPGRAM(_s) {
     uint64_t        num_samples_total;      // total number of samples since start
     uint64_t        num_transforms;         // total number of transforms since reset
     uint64_t        num_transforms_total;   // total number of transforms since start
+    uint64_t        num_transforms_skipped; // transforms skipped over budget since reset
+
+    // transform budget
+    int             budget;         // limit transform rate?
+    float           budget_rate;    // transforms allowed per sample
+    float           budget_credit;  // transforms currently allowed, in [0,2]
 };
 
 //
@@ -66,6 +77,17 @@ struct SPGRAM(_s) {
 // from current buffer contents
 void SPGRAM(_step)(SPGRAM() _q);
 
+// write samples to ring buffer, keeping only the most recent
+// window_len of them
+void SPGRAM(_ring_write)(SPGRAM()     _q,
+                         TI *         _x,
+                         unsigned int _n);
+
+// create spgram object sharing window, FFT buffers and plan of _q
+// (which must outlive it); only the input ring buffer, PSD estimate
+// and counters are allocated
+SPGRAM() SPGRAM(_create_shared)(SPGRAM() _q);
+
 // create spgram object
 //  _nfft       : FFT size
 //  _window     : window coefficients [size: _window_len x 1]
@@ -95,28 +117,39 @@ SPGRAM() SPGRAM(_create)(unsigned int _nfft,
     }
 
     // allocate memory for main object
-    SPGRAM() q = (SPGRAM()) malloc(sizeof(struct SPGRAM(_s)));
+    SPGRAM() q = (SPGRAM()) liquid_malloc(sizeof(struct SPGRAM(_s)));
 
     // set input parameters
     q->nfft       = _nfft;
     q->wtype      = _wtype;
     q->window_len = _window_len;
     q->delay      = _delay;
+    q->shared     = 0;
 
     // set object for full accumulation
     SPGRAM(_set_alpha)(q, -1.0f);
 
     // create FFT arrays, object
-    q->buf_time = (TC*) malloc((q->nfft)*sizeof(TC));
-    q->buf_freq = (TC*) malloc((q->nfft)*sizeof(TC));
-    q->psd      = (T *) malloc((q->nfft)*sizeof(T ));
+    q->buf_time = (TI*) liquid_malloc((q->nfft)*sizeof(TI));
+    q->psd      = (T *) liquid_malloc((q->nfft)*sizeof(T ));
+#if TI_COMPLEX
+    q->buf_freq = (TC*) liquid_malloc((q->nfft)*sizeof(TC));
     q->fft      = FFT_CREATE_PLAN(q->nfft, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, FFT_METHOD);
+#else
+    q->buf_freq = (TC*) liquid_malloc((q->nfft/2+1)*sizeof(TC));
+    q->fft      = FFT_CREATE_PLAN_R2C(q->nfft, q->buf_time, q->buf_freq, FFT_METHOD);
+#endif
 
-    // create buffer
-    q->buffer = WINDOW(_create)(q->window_len);
+    // create input ring buffer (initially zero)
+    q->ring       = (TI*) liquid_calloc(q->window_len, sizeof(TI));
+    q->ring_index = 0;
+
+    // no transform budget
+    q->budget      = 0;
+    q->budget_rate = 0.0f;
 
     // create window
-    q->w = (T*) malloc((q->window_len)*sizeof(T));
+    q->w = (T*) liquid_malloc((q->window_len)*sizeof(T));
     unsigned int i;
     unsigned int n = q->window_len;
     float beta = 10.0f;
@@ -169,27 +202,48 @@ SPGRAM() SPGRAM(_create_default)(unsigned int _nfft)
     return SPGRAM(_create)(_nfft, LIQUID_WINDOW_KAISER, _nfft/2, _nfft/4);
 }
 
+// create spgram object sharing resources of _q (see above)
+SPGRAM() SPGRAM(_create_shared)(SPGRAM() _q)
+{
+    // copy options and shared pointers
+    SPGRAM() q = (SPGRAM()) liquid_malloc(sizeof(struct SPGRAM(_s)));
+    memmove(q, _q, sizeof(struct SPGRAM(_s)));
+    q->shared = 1;
+
+    // allocate per-object state
+    q->ring       = (TI*) liquid_calloc(q->window_len, sizeof(TI));
+    q->ring_index = 0;
+    q->psd        = (T *) liquid_malloc((q->nfft)*sizeof(T ));
+
+    // reset the spgram object
+    q->num_samples_total    = 0;
+    q->num_transforms_total = 0;
+    SPGRAM(_reset)(q);
+
+    // return new object
+    return q;
+}
+
 // destroy spgram object
 void SPGRAM(_destroy)(SPGRAM() _q)
 {
     // free allocated memory
-    free(_q->buf_time);
-    free(_q->buf_freq);
-    free(_q->w);
-    free(_q->psd);
-    WINDOW(_destroy)(_q->buffer);
-    FFT_DESTROY_PLAN(_q->fft);
+    if (!_q->shared) {
+        liquid_free(_q->buf_time);
+        liquid_free(_q->buf_freq);
+        liquid_free(_q->w);
+        FFT_DESTROY_PLAN(_q->fft);
+    }
+    liquid_free(_q->psd);
+    liquid_free(_q->ring);
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // resets the internal state of the spgram object
 void SPGRAM(_reset)(SPGRAM() _q)
 {
-    // clear the window buffer
-    //WINDOW(_clear)(_q->buffer);
-
     // clear FFT input
     unsigned int i;
     for (i=0; i<_q->nfft; i++)
@@ -199,6 +253,8 @@ void SPGRAM(_reset)(SPGRAM() _q)
     _q->sample_timer   = _q->delay;
     _q->num_transforms = 0;
     _q->num_samples    = 0;
+    _q->num_transforms_skipped = 0;
+    _q->budget_credit  = _q->budget_rate > 0.0f ? 1.0f : 0.0f;
 
     // clear PSD accumulation
     for (i=0; i<_q->nfft; i++)
@@ -208,8 +264,11 @@ void SPGRAM(_reset)(SPGRAM() _q)
 // prints the spgram object's parameters
 void SPGRAM(_print)(SPGRAM() _q)
 {
-    printf("spgram%s: nfft=%u, window=%u, delay=%u\n",
+    printf("spgram%s: nfft=%u, window=%u, delay=%u",
             EXTENSION, _q->nfft, _q->window_len, _q->delay);
+    if (_q->budget)
+        printf(", budget=%g transforms/sample", _q->budget_rate);
+    printf("\n");
 }
 
 // set forgetting factor
@@ -235,6 +294,42 @@ int SPGRAM(_set_alpha)(SPGRAM() _q,
     return 0;
 }
 
+// set delay between transforms
+int SPGRAM(_set_delay)(SPGRAM()     _q,
+                       unsigned int _delay)
+{
+    // validate input
+    if (_delay == 0) {
+        fprintf(stderr,"warning: spgram%s_set_delay(), delay must be greater than 0\n", EXTENSION);
+        return -1;
+    }
+
+    // next transform is due after the new delay
+    _q->delay        = _delay;
+    _q->sample_timer = _delay;
+    return 0;
+}
+
+// set transform budget
+int SPGRAM(_set_transform_budget)(SPGRAM() _q,
+                                  float    _sample_rate,
+                                  float    _max_rate)
+{
+    // validate input
+    if (_sample_rate <= 0.0f) {
+        fprintf(stderr,"warning: spgram%s_set_transform_budget(), sample rate must be greater than 0\n", EXTENSION);
+        return -1;
+    } else if (_max_rate < 0.0f) {
+        fprintf(stderr,"warning: spgram%s_set_transform_budget(), transform rate cannot be negative\n", EXTENSION);
+        return -1;
+    }
+
+    _q->budget        = 1;
+    _q->budget_rate   = _max_rate / _sample_rate;
+    _q->budget_credit = _max_rate > 0.0f ? 1.0f : 0.0f;
+    return 0;
+}
+
 // get FFT size
 unsigned int SPGRAM(_get_nfft)(SPGRAM() _q)
 {
@@ -277,31 +372,24 @@ uint64_t SPGRAM(_get_num_transforms_total)(SPGRAM() _q)
     return _q->num_transforms_total;
 }
 
+// get number of transforms skipped over budget since reset
+uint64_t SPGRAM(_get_num_transforms_skipped)(SPGRAM() _q)
+{
+    return _q->num_transforms_skipped;
+}
+
 // push a single sample into the spgram object
 //  _q      :   spgram object
 //  _x      :   input sample
 void SPGRAM(_push)(SPGRAM() _q,
                    TI       _x)
 {
-    // push sample into internal window
-    WINDOW(_push)(_q->buffer, _x);
-
-    // update counters
-    _q->num_samples++;
-    _q->num_samples_total++;
-
-    // adjust timer
-    _q->sample_timer--;
-
-    if (_q->sample_timer)
-        return;
-
-    // reset timer and step through computation
-    _q->sample_timer = _q->delay;
-    SPGRAM(_step)(_q);
+    SPGRAM(_write)(_q, &_x, 1);
 }
 
-// write a block of samples to the spgram object
+// write a block of samples to the spgram object; samples are copied
+// into the ring buffer up to the next transform, and the window is
+// only formed when that transform is run
 //  _q      :   spgram object
 //  _x      :   input buffer [size: _n x 1]
 //  _n      :   input buffer length
@@ -309,15 +397,62 @@ void SPGRAM(_write)(SPGRAM()     _q,
                     TI *         _x,
                     unsigned int _n)
 {
-#if 0
-    // write a block of samples to the internal window
-    WINDOW(_write)(_q->buffer, _x, _n);
-#else
-    // TODO: be smarter about how to write and execute samples
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        SPGRAM(_push)(_q, _x[i]);
-#endif
+    while (_n > 0) {
+        // write samples up to next transform
+        unsigned int k = _n < _q->sample_timer ? _n : _q->sample_timer;
+        SPGRAM(_ring_write)(_q, _x, k);
+        _x += k;
+        _n -= k;
+
+        // update counters
+        _q->num_samples       += k;
+        _q->num_samples_total += k;
+        _q->sample_timer      -= k;
+
+        // accrue transform budget, allowing one transform of burst
+        if (_q->budget) {
+            _q->budget_credit += k * _q->budget_rate;
+            if (_q->budget_credit > 2.0f)
+                _q->budget_credit = 2.0f;
+        }
+
+        if (_q->sample_timer)
+            continue;
+
+        // reset timer and step through computation if within budget
+        _q->sample_timer = _q->delay;
+        if (_q->budget) {
+            if (_q->budget_credit < 1.0f) {
+                _q->num_transforms_skipped++;
+                continue;
+            }
+            _q->budget_credit -= 1.0f;
+        }
+        SPGRAM(_step)(_q);
+    }
+}
+
+// write samples to ring buffer (see above)
+void SPGRAM(_ring_write)(SPGRAM()     _q,
+                         TI *         _x,
+                         unsigned int _n)
+{
+    // samples older than the window are overwritten anyway
+    if (_n > _q->window_len) {
+        _x += _n - _q->window_len;
+        _n  = _q->window_len;
+    }
+
+    // copy in at most two segments around the wrap point
+    unsigned int n0 = _q->window_len - _q->ring_index;
+    if (n0 > _n)
+        n0 = _n;
+    memmove(_q->ring + _q->ring_index, _x, n0*sizeof(TI));
+    memmove(_q->ring, _x + n0, (_n - n0)*sizeof(TI));
+
+    _q->ring_index += _n;
+    if (_q->ring_index >= _q->window_len)
+        _q->ring_index -= _q->window_len;
 }
 
 
@@ -325,26 +460,37 @@ void SPGRAM(_write)(SPGRAM()     _q,
 //  _q      :   spgram object
 void SPGRAM(_step)(SPGRAM() _q)
 {
-    unsigned int i;
-
-    // read buffer, copy to FFT input (applying window)
-    // TODO: use SIMD extensions to speed this up
-    TI * rc;
-    WINDOW(_read)(_q->buffer, &rc);
-    for (i=0; i<_q->window_len; i++)
-        _q->buf_time[i] = rc[i] * _q->w[i];
+    // copy ring buffer to FFT input (applying window); the oldest
+    // sample is at the write index
+    unsigned int n0 = _q->window_len - _q->ring_index;
+#if TI_COMPLEX
+    liquid_spgram_window_cf(_q->ring + _q->ring_index, _q->w, n0, _q->buf_time);
+    liquid_spgram_window_cf(_q->ring, _q->w + n0, _q->ring_index, _q->buf_time + n0);
+#else
+    liquid_spgram_window_f(_q->ring + _q->ring_index, _q->w, n0, _q->buf_time);
+    liquid_spgram_window_f(_q->ring, _q->w + n0, _q->ring_index, _q->buf_time + n0);
+#endif
 
     // execute fft on _q->buf_time and store result in _q->buf_freq
     FFT_EXECUTE(_q->fft);
 
-    // accumulate output
-    for (i=0; i<_q->nfft; i++) {
-        T v = crealf( _q->buf_freq[i] * conjf(_q->buf_freq[i]) );
-        if (_q->num_transforms == 0)
-            _q->psd[i] = v;
-        else
-            _q->psd[i] = _q->gamma*_q->psd[i] + _q->alpha*v;
-    }
+    // accumulate output; real input only has the nfft/2+1 non-negative
+    // frequencies, the negative ones are mirrored below
+#if TI_COMPLEX
+    unsigned int n = _q->nfft;
+#else
+    unsigned int n = _q->nfft/2 + 1;
+#endif
+    if (_q->num_transforms == 0)
+        liquid_spgram_psd_set(_q->buf_freq, n, _q->psd);
+    else
+        liquid_spgram_psd_update(_q->buf_freq, n, _q->gamma, _q->alpha, _q->psd);
+
+#if !TI_COMPLEX
+    unsigned int i;
+    for (i=n; i<_q->nfft; i++)
+        _q->psd[i] = _q->psd[_q->nfft - i];
+#endif
 
     _q->num_transforms++;
     _q->num_transforms_total++;
@@ -396,12 +542,12 @@ int SPGRAM(_export_gnuplot)(SPGRAM()     _q,
     fprintf(fid,"plot '-' w filledcurves x1 lt 1 lw 2 lc rgb '#004080'\n");
 
     // export spectrum data
-    T * psd = (T*) malloc(_q->nfft * sizeof(T));
+    T * psd = (T*) liquid_malloc(_q->nfft * sizeof(T));
     SPGRAM(_get_psd)(_q, psd);
     unsigned int i;
     for (i=0; i<_q->nfft; i++)
         fprintf(fid,"  %12.8f %12.8f\n", (float)i/(float)(_q->nfft)-0.5f, (float)(psd[i]));
-    free(psd);
+    liquid_free(psd);
     fprintf(fid,"e\n");
 
     // close it up
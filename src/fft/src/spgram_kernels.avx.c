@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// spgram_kernels.avx.c : spectral periodogram windowing and power
+//                        spectral density accumulation (x86 AVX2/FMA
+//                        and AVX-512F)
+//
+// These kernels are compiled with per-function target attributes and
+// are selected at run time by the dispatch in spgram_kernels.mmx.c.
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// scalar tail shared by all kernels: magnitude squared of _n complex
+// values, either set or exponentially averaged into _psd
+static void liquid_spgram_psd_tail(float *      _X,
+                                   unsigned int _n,
+                                   float        _gamma,
+                                   float        _alpha,
+                                   float *      _psd,
+                                   int          _set)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float v = _X[2*i]*_X[2*i] + _X[2*i+1]*_X[2*i+1];
+        _psd[i] = _set ? v : _gamma*_psd[i] + _alpha*v;
+    }
+}
+
+//
+// AVX2/FMA
+//
+
+// window eight complex samples per iteration
+__attribute__((target("avx2,fma")))
+void liquid_spgram_window_cf_avx2(liquid_float_complex * _x,
+                                  float *                _w,
+                                  unsigned int           _n,
+                                  liquid_float_complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m256i lo = _mm256_setr_epi32(0,0,1,1,2,2,3,3);
+    __m256i hi = _mm256_setr_epi32(4,4,5,5,6,6,7,7);
+    unsigned int t = _n & ~7u;
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        __m256 w = _mm256_loadu_ps(_w + i);
+        _mm256_storeu_ps(y + 2*i,     _mm256_mul_ps(_mm256_loadu_ps(x + 2*i),     _mm256_permutevar8x32_ps(w, lo)));
+        _mm256_storeu_ps(y + 2*i + 8, _mm256_mul_ps(_mm256_loadu_ps(x + 2*i + 8), _mm256_permutevar8x32_ps(w, hi)));
+    }
+    for (; i<_n; i++) {
+        y[2*i  ] = x[2*i  ] * _w[i];
+        y[2*i+1] = x[2*i+1] * _w[i];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void liquid_spgram_window_f_avx2(float *      _x,
+                                 float *      _w,
+                                 unsigned int _n,
+                                 float *      _y)
+{
+    unsigned int t = _n & ~7u;
+    unsigned int i;
+    for (i=0; i<t; i+=8)
+        _mm256_storeu_ps(_y + i, _mm256_mul_ps(_mm256_loadu_ps(_x + i), _mm256_loadu_ps(_w + i)));
+    for (; i<_n; i++)
+        _y[i] = _x[i] * _w[i];
+}
+
+// magnitude squared of eight complex values per iteration; the
+// in-lane horizontal add leaves the 64-bit pairs in the order 0,2,1,3
+__attribute__((target("avx2,fma")))
+void liquid_spgram_psd_update_avx2(liquid_float_complex * _X,
+                                   unsigned int           _n,
+                                   float                  _gamma,
+                                   float                  _alpha,
+                                   float *                _psd,
+                                   int                    _set)
+{
+    float * X = (float*) _X;
+    __m256 g = _mm256_set1_ps(_gamma);
+    __m256 a = _mm256_set1_ps(_alpha);
+    unsigned int t = _n & ~7u;
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        __m256 x0 = _mm256_loadu_ps(X + 2*i);
+        __m256 x1 = _mm256_loadu_ps(X + 2*i + 8);
+        __m256 v  = _mm256_hadd_ps(_mm256_mul_ps(x0, x0), _mm256_mul_ps(x1, x1));
+        v = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(3,1,2,0)));
+        if (!_set)
+            v = _mm256_fmadd_ps(g, _mm256_loadu_ps(_psd + i), _mm256_mul_ps(a, v));
+        _mm256_storeu_ps(_psd + i, v);
+    }
+    liquid_spgram_psd_tail(X + 2*t, _n - t, _gamma, _alpha, _psd + t, _set);
+}
+
+//
+// AVX-512F
+//
+
+// window sixteen complex samples per iteration
+__attribute__((target("avx512f")))
+void liquid_spgram_window_cf_avx512f(liquid_float_complex * _x,
+                                     float *                _w,
+                                     unsigned int           _n,
+                                     liquid_float_complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m512i lo = _mm512_setr_epi32(0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7);
+    __m512i hi = _mm512_setr_epi32(8,8,9,9,10,10,11,11,12,12,13,13,14,14,15,15);
+    unsigned int t = _n & ~15u;
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        __m512 w = _mm512_loadu_ps(_w + i);
+        _mm512_storeu_ps(y + 2*i,      _mm512_mul_ps(_mm512_loadu_ps(x + 2*i),      _mm512_permutexvar_ps(lo, w)));
+        _mm512_storeu_ps(y + 2*i + 16, _mm512_mul_ps(_mm512_loadu_ps(x + 2*i + 16), _mm512_permutexvar_ps(hi, w)));
+    }
+    for (; i<_n; i++) {
+        y[2*i  ] = x[2*i  ] * _w[i];
+        y[2*i+1] = x[2*i+1] * _w[i];
+    }
+}
+
+__attribute__((target("avx512f")))
+void liquid_spgram_window_f_avx512f(float *      _x,
+                                    float *      _w,
+                                    unsigned int _n,
+                                    float *      _y)
+{
+    unsigned int t = _n & ~15u;
+    unsigned int i;
+    for (i=0; i<t; i+=16)
+        _mm512_storeu_ps(_y + i, _mm512_mul_ps(_mm512_loadu_ps(_x + i), _mm512_loadu_ps(_w + i)));
+    for (; i<_n; i++)
+        _y[i] = _x[i] * _w[i];
+}
+
+// magnitude squared of sixteen complex values per iteration: each
+// square is added to its swapped neighbour and the even lanes of both
+// vectors are gathered with a two-source permute
+__attribute__((target("avx512f")))
+void liquid_spgram_psd_update_avx512f(liquid_float_complex * _X,
+                                      unsigned int           _n,
+                                      float                  _gamma,
+                                      float                  _alpha,
+                                      float *                _psd,
+                                      int                    _set)
+{
+    float * X = (float*) _X;
+    __m512 g = _mm512_set1_ps(_gamma);
+    __m512 a = _mm512_set1_ps(_alpha);
+    __m512i even = _mm512_setr_epi32(0,2,4,6,8,10,12,14,16,18,20,22,24,26,28,30);
+    unsigned int t = _n & ~15u;
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        __m512 x0 = _mm512_loadu_ps(X + 2*i);
+        __m512 x1 = _mm512_loadu_ps(X + 2*i + 16);
+        x0 = _mm512_mul_ps(x0, x0);
+        x1 = _mm512_mul_ps(x1, x1);
+        x0 = _mm512_add_ps(x0, _mm512_permute_ps(x0, _MM_SHUFFLE(2,3,0,1)));
+        x1 = _mm512_add_ps(x1, _mm512_permute_ps(x1, _MM_SHUFFLE(2,3,0,1)));
+        __m512 v = _mm512_permutex2var_ps(x0, even, x1);
+        if (!_set)
+            v = _mm512_fmadd_ps(g, _mm512_loadu_ps(_psd + i), _mm512_mul_ps(a, v));
+        _mm512_storeu_ps(_psd + i, v);
+    }
+    liquid_spgram_psd_tail(X + 2*t, _n - t, _gamma, _alpha, _psd + t, _set);
+}
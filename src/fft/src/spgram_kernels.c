@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// spgram_kernels.c : spectral periodogram windowing and power spectral
+//                    density accumulation (portable C)
+//
+
+#include "liquid.internal.h"
+
+// apply window to complex input (see liquid.internal.h)
+void liquid_spgram_window_cf(liquid_float_complex * _x,
+                             float *                _w,
+                             unsigned int           _n,
+                             liquid_float_complex * _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = _x[i] * _w[i];
+}
+
+// apply window to real input (see liquid.internal.h)
+void liquid_spgram_window_f(float *      _x,
+                            float *      _w,
+                            unsigned int _n,
+                            float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = _x[i] * _w[i];
+}
+
+// set power spectral density from transform (see liquid.internal.h)
+void liquid_spgram_psd_set(liquid_float_complex * _X,
+                           unsigned int           _n,
+                           float *                _psd)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _psd[i] = crealf(_X[i])*crealf(_X[i]) + cimagf(_X[i])*cimagf(_X[i]);
+}
+
+// update power spectral density from transform (see liquid.internal.h)
+void liquid_spgram_psd_update(liquid_float_complex * _X,
+                              unsigned int           _n,
+                              float                  _gamma,
+                              float                  _alpha,
+                              float *                _psd)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float v = crealf(_X[i])*crealf(_X[i]) + cimagf(_X[i])*cimagf(_X[i]);
+        _psd[i] = _gamma*_psd[i] + _alpha*v;
+    }
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// spgram_kernels.mmx.c : spectral periodogram windowing and power
+//                        spectral density accumulation (SSE3 with
+//                        AVX2/AVX-512F dispatch)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
+//
+// portable kernels (dispatch fallback)
+//
+
+static void liquid_spgram_window_cf_portable(float *      _x,
+                                             float *      _w,
+                                             unsigned int _n,
+                                             float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _y[2*i  ] = _x[2*i  ] * _w[i];
+        _y[2*i+1] = _x[2*i+1] * _w[i];
+    }
+}
+
+static void liquid_spgram_window_f_portable(float *      _x,
+                                            float *      _w,
+                                            unsigned int _n,
+                                            float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = _x[i] * _w[i];
+}
+
+static void liquid_spgram_psd_update_portable(float *      _X,
+                                              unsigned int _n,
+                                              float        _gamma,
+                                              float        _alpha,
+                                              float *      _psd,
+                                              int          _set)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float v = _X[2*i]*_X[2*i] + _X[2*i+1]*_X[2*i+1];
+        _psd[i] = _set ? v : _gamma*_psd[i] + _alpha*v;
+    }
+}
+
+#if HAVE_PMMINTRIN_H
+//
+// SSE3 kernels
+//
+
+// window four complex samples per iteration
+static void liquid_spgram_window_cf_sse(float *      _x,
+                                        float *      _w,
+                                        unsigned int _n,
+                                        float *      _y)
+{
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 w  = _mm_loadu_ps(_w + i);
+        __m128 x0 = _mm_loadu_ps(_x + 2*i);
+        __m128 x1 = _mm_loadu_ps(_x + 2*i + 4);
+        _mm_storeu_ps(_y + 2*i,     _mm_mul_ps(x0, _mm_unpacklo_ps(w, w)));
+        _mm_storeu_ps(_y + 2*i + 4, _mm_mul_ps(x1, _mm_unpackhi_ps(w, w)));
+    }
+    liquid_spgram_window_cf_portable(_x + 2*t, _w + t, _n - t, _y + 2*t);
+}
+
+static void liquid_spgram_window_f_sse(float *      _x,
+                                       float *      _w,
+                                       unsigned int _n,
+                                       float *      _y)
+{
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_y + i, _mm_mul_ps(_mm_loadu_ps(_x + i), _mm_loadu_ps(_w + i)));
+    liquid_spgram_window_f_portable(_x + t, _w + t, _n - t, _y + t);
+}
+
+// magnitude squared of four complex values per iteration
+static void liquid_spgram_psd_update_sse(float *      _X,
+                                         unsigned int _n,
+                                         float        _gamma,
+                                         float        _alpha,
+                                         float *      _psd,
+                                         int          _set)
+{
+    __m128 g = _mm_set1_ps(_gamma);
+    __m128 a = _mm_set1_ps(_alpha);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 x0 = _mm_loadu_ps(_X + 2*i);
+        __m128 x1 = _mm_loadu_ps(_X + 2*i + 4);
+        __m128 v  = _mm_hadd_ps(_mm_mul_ps(x0, x0), _mm_mul_ps(x1, x1));
+        if (!_set)
+            v = _mm_add_ps(_mm_mul_ps(g, _mm_loadu_ps(_psd + i)), _mm_mul_ps(a, v));
+        _mm_storeu_ps(_psd + i, v);
+    }
+    liquid_spgram_psd_update_portable(_X + 2*t, _n - t, _gamma, _alpha, _psd + t, _set);
+}
+#endif
+
+//
+// run-time dispatch
+//
+
+// apply window to complex input (see liquid.internal.h)
+void liquid_spgram_window_cf(liquid_float_complex * _x,
+                             float *                _w,
+                             unsigned int           _n,
+                             liquid_float_complex * _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX512F) {
+        liquid_spgram_window_cf_avx512f(_x, _w, _n, _y);
+        return;
+    }
+    if (level == LIQUID_SIMD_AVX2) {
+        liquid_spgram_window_cf_avx2(_x, _w, _n, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_spgram_window_cf_sse((float*)_x, _w, _n, (float*)_y);
+        return;
+    }
+#endif
+    liquid_spgram_window_cf_portable((float*)_x, _w, _n, (float*)_y);
+}
+
+// apply window to real input (see liquid.internal.h)
+void liquid_spgram_window_f(float *      _x,
+                            float *      _w,
+                            unsigned int _n,
+                            float *      _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX512F) {
+        liquid_spgram_window_f_avx512f(_x, _w, _n, _y);
+        return;
+    }
+    if (level == LIQUID_SIMD_AVX2) {
+        liquid_spgram_window_f_avx2(_x, _w, _n, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_spgram_window_f_sse(_x, _w, _n, _y);
+        return;
+    }
+#endif
+    liquid_spgram_window_f_portable(_x, _w, _n, _y);
+}
+
+// common dispatch for setting and updating the power spectral density
+static void liquid_spgram_psd_dispatch(liquid_float_complex * _X,
+                                       unsigned int           _n,
+                                       float                  _gamma,
+                                       float                  _alpha,
+                                       float *                _psd,
+                                       int                    _set)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX512F) {
+        liquid_spgram_psd_update_avx512f(_X, _n, _gamma, _alpha, _psd, _set);
+        return;
+    }
+    if (level == LIQUID_SIMD_AVX2) {
+        liquid_spgram_psd_update_avx2(_X, _n, _gamma, _alpha, _psd, _set);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_spgram_psd_update_sse((float*)_X, _n, _gamma, _alpha, _psd, _set);
+        return;
+    }
+#endif
+    liquid_spgram_psd_update_portable((float*)_X, _n, _gamma, _alpha, _psd, _set);
+}
+
+// set power spectral density from transform (see liquid.internal.h)
+void liquid_spgram_psd_set(liquid_float_complex * _X,
+                           unsigned int           _n,
+                           float *                _psd)
+{
+    liquid_spgram_psd_dispatch(_X, _n, 0.0f, 1.0f, _psd, 1);
+}
+
+// update power spectral density from transform (see liquid.internal.h)
+void liquid_spgram_psd_update(liquid_float_complex * _X,
+                              unsigned int           _n,
+                              float                  _gamma,
+                              float                  _alpha,
+                              float *                _psd)
+{
+    liquid_spgram_psd_dispatch(_X, _n, _gamma, _alpha, _psd, 0);
+}
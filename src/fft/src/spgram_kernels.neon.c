@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// spgram_kernels.neon.c : spectral periodogram windowing and power
+//                         spectral density accumulation (ARM Neon)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+// apply window to complex input (see liquid.internal.h); the samples
+// are de-interleaved so that one window vector scales both parts
+void liquid_spgram_window_cf(liquid_float_complex * _x,
+                             float *                _w,
+                             unsigned int           _n,
+                             liquid_float_complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        unsigned int t = _n & ~3u;
+        for (; i<t; i+=4) {
+            float32x4x2_t v = vld2q_f32(x + 2*i);
+            float32x4_t   w = vld1q_f32(_w + i);
+            v.val[0] = vmulq_f32(v.val[0], w);
+            v.val[1] = vmulq_f32(v.val[1], w);
+            vst2q_f32(y + 2*i, v);
+        }
+    }
+    for (; i<_n; i++) {
+        y[2*i  ] = x[2*i  ] * _w[i];
+        y[2*i+1] = x[2*i+1] * _w[i];
+    }
+}
+
+// apply window to real input (see liquid.internal.h)
+void liquid_spgram_window_f(float *      _x,
+                            float *      _w,
+                            unsigned int _n,
+                            float *      _y)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        unsigned int t = _n & ~3u;
+        for (; i<t; i+=4)
+            vst1q_f32(_y + i, vmulq_f32(vld1q_f32(_x + i), vld1q_f32(_w + i)));
+    }
+    for (; i<_n; i++)
+        _y[i] = _x[i] * _w[i];
+}
+
+// common kernel for setting and updating the power spectral density
+static void liquid_spgram_psd_neon(liquid_float_complex * _X,
+                                   unsigned int           _n,
+                                   float                  _gamma,
+                                   float                  _alpha,
+                                   float *                _psd,
+                                   int                    _set)
+{
+    float * X = (float*) _X;
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t g = vdupq_n_f32(_gamma);
+        float32x4_t a = vdupq_n_f32(_alpha);
+        unsigned int t = _n & ~3u;
+        for (; i<t; i+=4) {
+            float32x4x2_t x = vld2q_f32(X + 2*i);
+            float32x4_t   v = vmlaq_f32(vmulq_f32(x.val[0], x.val[0]), x.val[1], x.val[1]);
+            if (!_set)
+                v = vmlaq_f32(vmulq_f32(a, v), g, vld1q_f32(_psd + i));
+            vst1q_f32(_psd + i, v);
+        }
+    }
+    for (; i<_n; i++) {
+        float v = X[2*i]*X[2*i] + X[2*i+1]*X[2*i+1];
+        _psd[i] = _set ? v : _gamma*_psd[i] + _alpha*v;
+    }
+}
+
+// set power spectral density from transform (see liquid.internal.h)
+void liquid_spgram_psd_set(liquid_float_complex * _X,
+                           unsigned int           _n,
+                           float *                _psd)
+{
+    liquid_spgram_psd_neon(_X, _n, 0.0f, 1.0f, _psd, 1);
+}
+
+// update power spectral density from transform (see liquid.internal.h)
+void liquid_spgram_psd_update(liquid_float_complex * _X,
+                              unsigned int           _n,
+                              float                  _gamma,
+                              float                  _alpha,
+                              float *                _psd)
+{
+    liquid_spgram_psd_neon(_X, _n, _gamma, _alpha, _psd, 0);
+}
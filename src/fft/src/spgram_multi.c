@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// spgram_multi (spectral periodogram of several streams)
+//
+// Each stream keeps its own input ring buffer, PSD estimate and
+// counters; the tapering window, FFT buffers and FFT plan are held once
+// for all streams. Streams are written independently and transform as
+// soon as they are due, so a single plan with a single pair of buffers
+// serves all of them. Because the FFT buffers are shared, the streams
+// of one object must not be written to concurrently.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+struct SPGRAM(_multi_s) {
+    unsigned int num_streams;   // number of streams
+    SPGRAM() *   streams;       // per-stream objects, the first one
+                                // owns the shared resources
+};
+
+// create multi-stream spgram object
+//  _num_streams: number of streams, _num_streams > 0
+//  _nfft       : FFT size
+//  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING
+//  _window_len : window length
+//  _delay      : delay between transforms, _delay > 0
+SPGRAM(_multi) SPGRAM(_multi_create)(unsigned int _num_streams,
+                                     unsigned int _nfft,
+                                     int          _wtype,
+                                     unsigned int _window_len,
+                                     unsigned int _delay)
+{
+    // validate input (remaining parameters validated by spgram)
+    if (_num_streams == 0) {
+        fprintf(stderr,"error: spgram%s_multi_create(), number of streams must be greater than 0\n", EXTENSION);
+        exit(1);
+    }
+
+    // allocate memory for main object
+    SPGRAM(_multi) q = (SPGRAM(_multi)) liquid_malloc(sizeof(struct SPGRAM(_multi_s)));
+    q->num_streams = _num_streams;
+
+    // create streams, sharing resources of the first one
+    q->streams = (SPGRAM()*) liquid_malloc(q->num_streams*sizeof(SPGRAM()));
+    q->streams[0] = SPGRAM(_create)(_nfft, _wtype, _window_len, _delay);
+    unsigned int i;
+    for (i=1; i<q->num_streams; i++)
+        q->streams[i] = SPGRAM(_create_shared)(q->streams[0]);
+
+    // return new object
+    return q;
+}
+
+// destroy multi-stream spgram object
+void SPGRAM(_multi_destroy)(SPGRAM(_multi) _q)
+{
+    // destroy streams, owner of shared resources last
+    unsigned int i;
+    for (i=_q->num_streams; i>0; i--)
+        SPGRAM(_destroy)(_q->streams[i-1]);
+    liquid_free(_q->streams);
+
+    // free main object
+    liquid_free(_q);
+}
+
+// resets the internal state of all streams
+void SPGRAM(_multi_reset)(SPGRAM(_multi) _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_streams; i++)
+        SPGRAM(_reset)(_q->streams[i]);
+}
+
+// prints the object's parameters
+void SPGRAM(_multi_print)(SPGRAM(_multi) _q)
+{
+    SPGRAM() s = _q->streams[0];
+    printf("spgram%s_multi: streams=%u, nfft=%u, window=%u, delay=%u\n",
+            EXTENSION, _q->num_streams, s->nfft, s->window_len, s->delay);
+}
+
+// set forgetting factor of all streams
+int SPGRAM(_multi_set_alpha)(SPGRAM(_multi) _q,
+                             float          _alpha)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_streams; i++) {
+        if (SPGRAM(_set_alpha)(_q->streams[i], _alpha))
+            return -1;
+    }
+    return 0;
+}
+
+// get number of streams
+unsigned int SPGRAM(_multi_get_num_streams)(SPGRAM(_multi) _q)
+{
+    return _q->num_streams;
+}
+
+// get stream object (see liquid.h)
+SPGRAM() SPGRAM(_multi_get_stream)(SPGRAM(_multi) _q,
+                                   unsigned int   _stream)
+{
+    if (_stream >= _q->num_streams) {
+        fprintf(stderr,"error: spgram%s_multi_get_stream(), stream index (%u) out of range\n", EXTENSION, _stream);
+        exit(1);
+    }
+    return _q->streams[_stream];
+}
+
+// write a block of samples to one stream
+//  _q      :   multi-stream spgram object
+//  _stream :   stream index
+//  _x      :   input buffer [size: _n x 1]
+//  _n      :   input buffer length
+void SPGRAM(_multi_write)(SPGRAM(_multi) _q,
+                          unsigned int   _stream,
+                          TI *           _x,
+                          unsigned int   _n)
+{
+    SPGRAM(_write)(SPGRAM(_multi_get_stream)(_q, _stream), _x, _n);
+}
+
+// compute spectral periodogram output of one stream (fft-shifted
+// values in dB)
+//  _q      :   multi-stream spgram object
+//  _stream :   stream index
+//  _X      :   output spectrum (dB) [size: _nfft x 1]
+void SPGRAM(_multi_get_psd)(SPGRAM(_multi) _q,
+                            unsigned int   _stream,
+                            T *            _X)
+{
+    SPGRAM(_get_psd)(SPGRAM(_multi_get_stream)(_q, _stream), _X);
+}
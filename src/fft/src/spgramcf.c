@@ -48,4 +48,5 @@
 // source files
 #include "asgram.c"
 #include "spgram.c"
+#include "spgram_multi.c"
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Complexity regression tests: plan execution time is normalized by
+// N*log2(N) and compared against the power-of-two transform of the same
+// octave; a size whose normalized cost exceeds that of the power of two
+// by more than LIQUID_FFT_COMPLEXITY_MAX_RATIO has most likely fallen
+// back to an O(N^2) method (e.g. a prime factor handled by a plain DFT)
+//
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// largest tolerated ratio of normalized execution cost to that of the
+// power-of-two size in the same octave; the worst sizes on record (high
+// powers of 13) sit near 35 while a plain DFT exceeds 100 from a few
+// hundred points up
+#define LIQUID_FFT_COMPLEXITY_MAX_RATIO (64.0)
+
+// minimum number of N*log2(N) units timed per measurement
+#define LIQUID_FFT_COMPLEXITY_MIN_WORK  (20000.0)
+
+// wall-clock time [s]
+static double fft_complexity_clock(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + 1e-9*(double)t.tv_nsec;
+}
+
+// measure normalized execution cost of transform of size _nfft,
+// t / (N log2 N), as the best of three runs [s]
+//  _nfft   :   transform size
+//  _flags  :   plan flags
+double fft_complexity_cost(unsigned int _nfft,
+                           int          _flags)
+{
+    float complex * x = (float complex*) malloc(_nfft*sizeof(float complex));
+    float complex * y = (float complex*) malloc(_nfft*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    fftplan q = fft_create_plan(_nfft, x, y, LIQUID_FFT_FORWARD, _flags);
+
+    double nlogn = (double)_nfft * log2((double)_nfft);
+    unsigned int num_trials = (unsigned int) ceil(LIQUID_FFT_COMPLEXITY_MIN_WORK / nlogn);
+
+    fft_execute(q);
+    double best = 0.0;
+    unsigned int r;
+    for (r=0; r<3; r++) {
+        double t0 = fft_complexity_clock();
+        for (i=0; i<num_trials; i++)
+            fft_execute(q);
+        double dt = (fft_complexity_clock() - t0) / (double)num_trials;
+        best = (r == 0 || dt < best) ? dt : best;
+    }
+
+    fft_destroy_plan(q);
+    free(x);
+    free(y);
+    return best / nlogn;
+}
+
+// ratio of normalized cost of size _nfft to that of the power of two
+// beginning its octave; a size exceeding the limit is measured again a
+// few times so that a single preemption does not fail the test
+double fft_complexity_ratio(unsigned int _nfft)
+{
+    unsigned int nref = 1;
+    while (2*nref <= _nfft)
+        nref *= 2;
+
+    double ratio = 0.0;
+    unsigned int k;
+    for (k=0; k<3; k++) {
+        ratio = fft_complexity_cost(_nfft, 0) / fft_complexity_cost(nref, 0);
+        if (ratio <= LIQUID_FFT_COMPLEXITY_MAX_RATIO)
+            break;
+    }
+    if (liquid_autotest_verbose && ratio > LIQUID_FFT_COMPLEXITY_MAX_RATIO)
+        printf("  fft size %u : normalized cost %.1f x that of %u\n", _nfft, ratio, nref);
+    return ratio;
+}
+
+// check list of transform sizes
+void fft_complexity_test(unsigned int * _n,
+                         unsigned int   _num)
+{
+    unsigned int i;
+    for (i=0; i<_num; i++)
+        CONTEND_LESS_THAN(fft_complexity_ratio(_n[i]), LIQUID_FFT_COMPLEXITY_MAX_RATIO);
+}
+
+// prime sizes, including those just below powers of two
+void autotest_fft_complexity_primes()
+{
+    unsigned int n[] = {67, 127, 131, 251, 257, 509, 521, 1021, 1031,
+                        2039, 2053, 3469, 4079, 4091, 4093};
+    fft_complexity_test(n, sizeof(n)/sizeof(n[0]));
+}
+
+// prime-power sizes
+void autotest_fft_complexity_prime_powers()
+{
+    unsigned int n[] = {81, 125, 243, 289, 343, 361, 529, 625, 729, 841,
+                        961, 1331, 1369, 2187, 2197, 2401, 3125, 3481, 3721};
+    fft_complexity_test(n, sizeof(n)/sizeof(n[0]));
+}
+
+// every size from 64 through 4096
+void autotest_fft_complexity_all()
+{
+    unsigned int nfft;
+    unsigned int num_failed = 0;
+    for (nfft=64; nfft<=4096; nfft++) {
+        if (fft_complexity_ratio(nfft) > LIQUID_FFT_COMPLEXITY_MAX_RATIO)
+            num_failed++;
+    }
+    CONTEND_EQUALITY(num_failed, 0);
+}
+
+// the bound must be tight enough to catch a quadratic transform
+void autotest_fft_complexity_detects_dft()
+{
+    double ratio = fft_complexity_cost(4093, LIQUID_FFT_FORCE_DFT) /
+                   fft_complexity_cost(2048, 0);
+    CONTEND_GREATER_THAN(ratio, LIQUID_FFT_COMPLEXITY_MAX_RATIO);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_many_autotest.c : test batches of equal-size transforms
+//
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare batch of transforms against individual transforms
+//  _n          :   transform size
+//  _howmany    :   number of transforms
+//  _stride     :   sample stride (input and output)
+//  _dist       :   distance between transforms (input and output)
+//  _dir        :   transform direction
+//  _flags      :   transform flags
+//  _in_place   :   run transform in place?
+void fft_many_test(unsigned int _n,
+                   unsigned int _howmany,
+                   unsigned int _stride,
+                   unsigned int _dist,
+                   int          _dir,
+                   int          _flags,
+                   int          _in_place)
+{
+    float tol = 2e-5f * _n;
+
+    // buffer length covering every sample of every transform
+    unsigned int len = (_howmany-1)*_dist + (_n-1)*_stride + 1;
+    float complex * x = (float complex*) malloc(len*sizeof(float complex));
+    float complex * y = _in_place ? x : (float complex*) malloc(len*sizeof(float complex));
+    float complex * t = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * v = (float complex*) malloc(_howmany*_n*sizeof(float complex));
+
+    unsigned int i, b;
+    for (i=0; i<len; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // expected result of each transform
+    for (b=0; b<_howmany; b++) {
+        for (i=0; i<_n; i++)
+            t[i] = x[b*_dist + i*_stride];
+        fft_run(_n, t, v + b*_n, _dir, 0);
+    }
+
+    fftplan q = fft_create_plan_many(_n, _howmany, x, _stride, _dist,
+                                     y, _stride, _dist, _dir, _flags);
+    fft_execute(q);
+
+    for (b=0; b<_howmany; b++) {
+        for (i=0; i<_n; i++) {
+            CONTEND_DELTA(crealf(y[b*_dist + i*_stride]), crealf(v[b*_n + i]), tol);
+            CONTEND_DELTA(cimagf(y[b*_dist + i*_stride]), cimagf(v[b*_n + i]), tol);
+        }
+    }
+
+    if (liquid_autotest_verbose)
+        fft_print_plan(q);
+
+    fft_destroy_plan(q);
+    free(x);
+    if (!_in_place) free(y);
+    free(t);
+    free(v);
+}
+
+// radix-2 sizes, contiguous transforms
+void autotest_fft_many_64x32()      { fft_many_test(  64, 32,  1,  64, LIQUID_FFT_FORWARD,  0, 0); }
+void autotest_fft_many_64x32_inv()  { fft_many_test(  64, 32,  1,  64, LIQUID_FFT_BACKWARD, 0, 0); }
+void autotest_fft_many_2x8()        { fft_many_test(   2,  8,  1,   2, LIQUID_FFT_FORWARD,  0, 0); }
+void autotest_fft_many_128x4()      { fft_many_test( 128,  4,  1, 128, LIQUID_FFT_FORWARD,  0, 0); }
+void autotest_fft_many_1024x2()     { fft_many_test(1024,  2,  1,1024, LIQUID_FFT_BACKWARD, 0, 0); }
+
+// radix-2 sizes, odd number of transforms
+void autotest_fft_many_32x1()       { fft_many_test(  32,  1,  1,  32, LIQUID_FFT_FORWARD,  0, 0); }
+void autotest_fft_many_256x7()      { fft_many_test( 256,  7,  1, 256, LIQUID_FFT_FORWARD,  0, 0); }
+
+// radix-2 sizes, interleaved and in-place transforms
+void autotest_fft_many_64x32_interleaved() { fft_many_test(64, 32, 32,  1, LIQUID_FFT_FORWARD,  0, 0); }
+void autotest_fft_many_16x6_strided()      { fft_many_test(16,  6,  3, 50, LIQUID_FFT_BACKWARD, 0, 0); }
+void autotest_fft_many_64x32_in_place()    { fft_many_test(64, 32,  1, 64, LIQUID_FFT_FORWARD,  0, 1); }
+void autotest_fft_many_512x8_in_place()    { fft_many_test(512, 8,  8,  1, LIQUID_FFT_BACKWARD, 0, 1); }
+
+// other sizes (one sub-transform at a time)
+void autotest_fft_many_1x4()         { fft_many_test(  1,  4,  1,  1, LIQUID_FFT_FORWARD,  0, 0); }
+void autotest_fft_many_20x5()        { fft_many_test( 20,  5,  1, 20, LIQUID_FFT_FORWARD,  0, 0); }
+void autotest_fft_many_17x3_in_place() { fft_many_test(17, 3,  3,  1, LIQUID_FFT_BACKWARD, 0, 1); }
+void autotest_fft_many_64x4_dft()    { fft_many_test( 64,  4,  1, 64, LIQUID_FFT_FORWARD,  LIQUID_FFT_FORCE_DFT, 0); }
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_plan_autotest.c : test FFT plan flags (measured planning and
+// method override)
+//
+
+#include <stdio.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif
+
+// autotest data definitions
+#include "src/fft/tests/fft_runtest.h"
+
+// 
+// AUTOTESTS: measured plans
+//
+void autotest_fft_measure_20()  { fft_test_flags(fft_test_x20,  fft_test_y20,   20, LIQUID_FFT_MEASURE); }
+void autotest_fft_measure_64()  { fft_test_flags(fft_test_x64,  fft_test_y64,   64, LIQUID_FFT_MEASURE); }
+void autotest_fft_measure_120() { fft_test_flags(fft_test_x120, fft_test_y120, 120, LIQUID_FFT_MEASURE); }
+void autotest_fft_measure_157() { fft_test_flags(fft_test_x157, fft_test_y157, 157, LIQUID_FFT_MEASURE); }
+void autotest_fft_measure_317() { fft_test_flags(fft_test_x317, fft_test_y317, 317, LIQUID_FFT_MEASURE); }
+void autotest_fft_measure_509() { fft_test_flags(fft_test_x509, fft_test_y509, 509, LIQUID_FFT_MEASURE); }
+
+// 
+// AUTOTESTS: method override
+//
+void autotest_fft_force_radix2_64()      { fft_test_flags(fft_test_x64,  fft_test_y64,   64, LIQUID_FFT_FORCE_RADIX2);      }
+void autotest_fft_force_mixed_radix_64() { fft_test_flags(fft_test_x64,  fft_test_y64,   64, LIQUID_FFT_FORCE_MIXED_RADIX); }
+void autotest_fft_force_dft_35()         { fft_test_flags(fft_test_x35,  fft_test_y35,   35, LIQUID_FFT_FORCE_DFT);         }
+void autotest_fft_force_mixed_radix_16() { fft_test_flags(fft_test_x16,  fft_test_y16,   16, LIQUID_FFT_FORCE_MIXED_RADIX); }
+void autotest_fft_force_mixed_radix_120(){ fft_test_flags(fft_test_x120, fft_test_y120, 120, LIQUID_FFT_FORCE_MIXED_RADIX); }
+void autotest_fft_force_mixed_radix_192(){ fft_test_flags(fft_test_x192, fft_test_y192, 192, LIQUID_FFT_FORCE_MIXED_RADIX); }
+void autotest_fft_force_rader_17()       { fft_test_flags(fft_test_x17,  fft_test_y17,   17, LIQUID_FFT_FORCE_RADER);       }
+void autotest_fft_force_rader_317()      { fft_test_flags(fft_test_x317, fft_test_y317, 317, LIQUID_FFT_FORCE_RADER);       }
+void autotest_fft_force_rader2_43()      { fft_test_flags(fft_test_x43,  fft_test_y43,   43, LIQUID_FFT_FORCE_RADER2);      }
+
+// override combined with measured sub-transforms
+void autotest_fft_force_rader2_measure_509()
+{
+    fft_test_flags(fft_test_x509, fft_test_y509, 509, LIQUID_FFT_FORCE_RADER2 | LIQUID_FFT_MEASURE);
+}
+
+// measured plan does not modify user arrays while planning
+void autotest_fft_measure_preserve()
+{
+    unsigned int n = 96;
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        x[i] = fft_test_x96[i];
+        y[i] = 0.0f;
+    }
+
+    fftplan q = fft_create_plan(n, x, y, LIQUID_FFT_FORWARD, LIQUID_FFT_MEASURE);
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(x[i], fft_test_x96[i]);
+        CONTEND_EQUALITY(y[i], 0.0f);
+    }
+
+    fft_execute(q);
+    for (i=0; i<n; i++)
+        CONTEND_DELTA(cabsf(y[i] - fft_test_y96[i]), 0, 2e-4f);
+
+    if (liquid_autotest_verbose)
+        fft_print_plan(q);
+    fft_destroy_plan(q);
+}
+
+
+// 
+// AUTOTESTS: wisdom import/export
+//
+
+// wisdom survives an export/forget/import round trip through a string
+// and is used by estimated plans
+void autotest_fft_wisdom_string()
+{
+    fft_wisdom_forget();
+    fftplan q = fft_create_plan(120, fft_test_x120, fft_test_y120, LIQUID_FFT_FORWARD, LIQUID_FFT_MEASURE);
+    fft_destroy_plan(q);
+
+    // export
+    int n = fft_wisdom_export_string(NULL, 0);
+    CONTEND_GREATER_THAN(n, 0);
+    char buf[n+1];
+    CONTEND_EQUALITY(fft_wisdom_export_string(buf, n+1), n);
+
+    // truncated export is null-terminated
+    char small[8];
+    CONTEND_EQUALITY(fft_wisdom_export_string(small, sizeof(small)), n);
+    CONTEND_EQUALITY(strlen(small), sizeof(small)-1);
+
+    // forget and re-import
+    fft_wisdom_forget();
+    CONTEND_GREATER_THAN(n, fft_wisdom_export_string(NULL, 0));
+    CONTEND_GREATER_THAN(fft_wisdom_import_string(buf), 0);
+
+    char buf2[n+1];
+    CONTEND_EQUALITY(fft_wisdom_export_string(buf2, n+1), n);
+    CONTEND_EQUALITY(strcmp(buf, buf2), 0);
+    if (liquid_autotest_verbose)
+        fft_wisdom_print();
+
+    // estimated plan picks up imported wisdom
+    fft_test_flags(fft_test_x120, fft_test_y120, 120, LIQUID_FFT_ESTIMATE);
+    fft_wisdom_forget();
+}
+
+// wisdom survives a round trip through a file
+void autotest_fft_wisdom_file()
+{
+    const char * filename = "fft_wisdom_autotest.txt";
+    fft_wisdom_forget();
+    fftplan q = fft_create_plan(317, fft_test_x317, fft_test_y317, LIQUID_FFT_BACKWARD, LIQUID_FFT_MEASURE);
+    fft_destroy_plan(q);
+
+    int n = fft_wisdom_export_string(NULL, 0);
+    char buf[n+1];
+    fft_wisdom_export_string(buf, n+1);
+    CONTEND_EQUALITY(fft_wisdom_export(filename), 0);
+
+    fft_wisdom_forget();
+    CONTEND_GREATER_THAN(fft_wisdom_import(filename), 0);
+    remove(filename);
+
+    char buf2[n+1];
+    CONTEND_EQUALITY(fft_wisdom_export_string(buf2, n+1), n);
+    CONTEND_EQUALITY(strcmp(buf, buf2), 0);
+
+    fft_test_flags(fft_test_x317, fft_test_y317, 317, LIQUID_FFT_ESTIMATE);
+    fft_wisdom_forget();
+}
+
+// entries naming a method which cannot compute the transform are ignored
+void autotest_fft_wisdom_invalid()
+{
+    fft_wisdom_forget();
+    const char * wisdom =
+        "# test wisdom\n"
+        "\n"
+        "16 forward rader 0\n"          // not prime
+        "15 forward mixed-radix 4\n"    // not a factor
+        "17 sideways dft 0\n"           // invalid direction
+        "32 forward fastest 0\n"        // invalid method
+        "20 backward mixed-radix 5\n"   // valid
+        "  35 forward dft 0";           // valid, no trailing newline
+    CONTEND_EQUALITY(fft_wisdom_import_string(wisdom), 2);
+
+    fft_test_flags(fft_test_x35, fft_test_y35, 35, LIQUID_FFT_ESTIMATE);
+    fft_wisdom_forget();
+
+    // missing file
+    CONTEND_EQUALITY(fft_wisdom_import("fft_wisdom_autotest_missing.txt"), -1);
+}
+
+//
+// AUTOTESTS: shared tables
+//
+
+// plans of the same size share their tables: only the first plan
+// allocates them, and all are freed with the last plan
+//  _nfft   :   transform size
+//  _flags  :   transform flags
+void fft_test_shared_tables(unsigned int _nfft,
+                            int          _flags)
+{
+    unsigned int num_plans = 4;
+    float complex x[_nfft];
+    float complex y[num_plans][_nfft];
+    unsigned int i, p;
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    unsigned int n0 = fft_table_num_entries();
+    fftplan q[num_plans];
+    q[0] = fft_create_plan(_nfft, x, y[0], LIQUID_FFT_FORWARD, _flags);
+    unsigned int n1 = fft_table_num_entries();
+    CONTEND_GREATER_THAN(n1, n0);
+    for (p=1; p<num_plans; p++) {
+        q[p] = fft_create_plan(_nfft, x, y[p], LIQUID_FFT_FORWARD, _flags);
+        CONTEND_EQUALITY(fft_table_num_entries(), n1);
+    }
+
+    // every plan computes the same result
+    for (p=0; p<num_plans; p++)
+        fft_execute(q[p]);
+    for (p=1; p<num_plans; p++) {
+        for (i=0; i<_nfft; i++) {
+            CONTEND_EQUALITY(crealf(y[p][i]), crealf(y[0][i]));
+            CONTEND_EQUALITY(cimagf(y[p][i]), cimagf(y[0][i]));
+        }
+    }
+
+    // tables remain until the last plan is destroyed
+    for (p=0; p<num_plans; p++) {
+        CONTEND_EQUALITY(fft_table_num_entries(), n1);
+        fft_destroy_plan(q[p]);
+    }
+    CONTEND_EQUALITY(fft_table_num_entries(), n0);
+}
+void autotest_fft_shared_tables_radix2_64()       { fft_test_shared_tables(  64, 0); }
+void autotest_fft_shared_tables_mixed_radix_120() { fft_test_shared_tables( 120, 0); }
+void autotest_fft_shared_tables_rader_317()       { fft_test_shared_tables( 317, LIQUID_FFT_FORCE_RADER);  }
+void autotest_fft_shared_tables_rader2_43()       { fft_test_shared_tables(  43, LIQUID_FFT_FORCE_RADER2); }
+void autotest_fft_shared_tables_dft_35()          { fft_test_shared_tables(  35, LIQUID_FFT_FORCE_DFT);    }
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+// worker: repeatedly create, run and destroy plans of sizes sharing
+// tables with other workers, counting results which differ from the
+// reference transform
+void * fft_test_tables_worker(void * _arg)
+{
+    unsigned int * num_errors = (unsigned int*) _arg;
+    unsigned int sizes[4] = {64, 120, 43, 317};
+    float complex x[317], y[317], y_ref[317];
+    unsigned int i, s, t;
+    for (i=0; i<317; i++)
+        x[i] = cosf(0.1f*i) + _Complex_I*sinf(0.37f*i);
+
+    for (t=0; t<50; t++) {
+        for (s=0; s<4; s++) {
+            unsigned int n = sizes[s];
+            fftplan q_ref = fft_create_plan(n, x, y_ref, LIQUID_FFT_FORWARD, LIQUID_FFT_FORCE_DFT);
+            fftplan q     = fft_create_plan(n, x, y,     LIQUID_FFT_FORWARD, 0);
+            fft_execute(q_ref);
+            fft_execute(q);
+            fft_destroy_plan(q_ref);
+            fft_destroy_plan(q);
+            for (i=0; i<n; i++) {
+                if (cabsf(y[i] - y_ref[i]) > 1e-3f*n)
+                    (*num_errors)++;
+            }
+        }
+    }
+    return NULL;
+}
+
+// plans may be created and destroyed concurrently
+void autotest_fft_shared_tables_threads()
+{
+    unsigned int i, num_threads = 8;
+    pthread_t threads[num_threads];
+    unsigned int num_errors[num_threads];
+    unsigned int n0 = fft_table_num_entries();
+    for (i=0; i<num_threads; i++) {
+        num_errors[i] = 0;
+        pthread_create(&threads[i], NULL, fft_test_tables_worker, &num_errors[i]);
+    }
+    for (i=0; i<num_threads; i++) {
+        pthread_join(threads[i], NULL);
+        CONTEND_EQUALITY(num_errors[i], 0);
+    }
+    CONTEND_EQUALITY(fft_table_num_entries(), n0);
+}
+#endif
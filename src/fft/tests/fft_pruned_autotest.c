@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_pruned_autotest.c : test transforms with pruned input or output
+//
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare pruned transform against regular transform
+//  _n          :   transform size
+//  _k0         :   first bin of band
+//  _len        :   band length
+//  _dir        :   transform direction
+//  _prune      :   pruned side
+//  _in_place   :   run transform in place?
+void fft_pruned_test(unsigned int _n,
+                     unsigned int _k0,
+                     unsigned int _len,
+                     int          _dir,
+                     int          _prune,
+                     int          _in_place)
+{
+    float tol = 2e-5f * _n;
+
+    float complex * x  = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * y  = _in_place ? x : (float complex*) malloc(_n*sizeof(float complex));
+    float complex * x0 = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(_n*sizeof(float complex));
+
+    // create plan before writing input
+    fftplan q = fft_create_plan_pruned(_n, x, y, _dir, 0, _k0, _len, _prune);
+
+    // input zero outside band for input pruning
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        int in_band = ((i + _n - _k0) % _n) < _len;
+        x0[i] = (_prune == LIQUID_FFT_PRUNE_OUTPUT || in_band) ? randnf() + _Complex_I*randnf() : 0.0f;
+        x[i]  = x0[i];
+    }
+    fft_run(_n, x0, y0, _dir, 0);
+    fft_execute(q);
+
+    for (i=0; i<_n; i++) {
+        int in_band = ((i + _n - _k0) % _n) < _len;
+        if (_prune == LIQUID_FFT_PRUNE_OUTPUT && !in_band)
+            continue;
+        CONTEND_DELTA(crealf(y[i]), crealf(y0[i]), tol);
+        CONTEND_DELTA(cimagf(y[i]), cimagf(y0[i]), tol);
+    }
+
+    fft_destroy_plan(q);
+    free(x);
+    if (!_in_place) free(y);
+    free(x0);
+    free(y0);
+}
+
+// input pruned (e.g. OFDM generator: null subcarriers)
+void autotest_fft_pruned_input_64_1()           { fft_pruned_test(  64,    0,  1, LIQUID_FFT_BACKWARD, LIQUID_FFT_PRUNE_INPUT,  0); }
+void autotest_fft_pruned_input_256_1()          { fft_pruned_test( 256,  100,  1, LIQUID_FFT_FORWARD,  LIQUID_FFT_PRUNE_INPUT,  0); }
+void autotest_fft_pruned_input_1024_wrap()      { fft_pruned_test(1024, 1023,  2, LIQUID_FFT_BACKWARD, LIQUID_FFT_PRUNE_INPUT,  0); }
+void autotest_fft_pruned_input_240_inplace()    { fft_pruned_test( 240,  238,  1, LIQUID_FFT_BACKWARD, LIQUID_FFT_PRUNE_INPUT,  1); }
+
+// output pruned (e.g. OFDM synchronizer: null subcarriers)
+void autotest_fft_pruned_output_64_8()          { fft_pruned_test(  64,    0,  8, LIQUID_FFT_FORWARD,  LIQUID_FFT_PRUNE_OUTPUT, 0); }
+void autotest_fft_pruned_output_64_wrap()       { fft_pruned_test(  64,   58, 11, LIQUID_FFT_FORWARD,  LIQUID_FFT_PRUNE_OUTPUT, 0); }
+void autotest_fft_pruned_output_256_15()        { fft_pruned_test( 256,   17, 15, LIQUID_FFT_BACKWARD, LIQUID_FFT_PRUNE_OUTPUT, 0); }
+void autotest_fft_pruned_output_240_inplace()   { fft_pruned_test( 240,  230, 12, LIQUID_FFT_FORWARD,  LIQUID_FFT_PRUNE_OUTPUT, 1); }
+
+// band too wide to prune: regular transform
+void autotest_fft_pruned_input_fallback()       { fft_pruned_test(  64,   60, 12, LIQUID_FFT_BACKWARD, LIQUID_FFT_PRUNE_INPUT,  0); }
+void autotest_fft_pruned_output_fallback()      { fft_pruned_test(  64,    5, 40, LIQUID_FFT_FORWARD,  LIQUID_FFT_PRUNE_OUTPUT, 0); }
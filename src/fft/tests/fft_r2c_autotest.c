@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_r2c_autotest.c : test real-to-complex/complex-to-real transforms
+//
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare real-to-complex transform against complex transform and
+// check that the complex-to-real transform recovers the input
+void fft_r2c_test(unsigned int _n,
+                  int          _flags)
+{
+    float tol = 1e-5f * _n;
+
+    float         x[_n];        // real input
+    float complex xc[_n];       // real input (complex)
+    float complex y[_n/2+1];    // real-to-complex output
+    float complex yc[_n];       // complex transform output
+    float         z[_n];        // real output
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        x[i]  = randnf();
+        xc[i] = x[i];
+    }
+
+    fftplan qf = fft_create_plan_r2c_1d(_n, x, y, _flags);
+    fftplan qr = fft_create_plan_c2r_1d(_n, y, z, _flags);
+    fft_execute(qf);
+    fft_run(_n, xc, yc, LIQUID_FFT_FORWARD, 0);
+
+    for (i=0; i<=_n/2; i++) {
+        CONTEND_DELTA(crealf(y[i]), crealf(yc[i]), tol);
+        CONTEND_DELTA(cimagf(y[i]), cimagf(yc[i]), tol);
+    }
+
+    // inverse (unnormalized)
+    fft_execute(qr);
+    for (i=0; i<_n; i++)
+        CONTEND_DELTA(z[i] / (float)_n, x[i], tol);
+
+    if (liquid_autotest_verbose)
+        fft_print_plan(qf);
+
+    fft_destroy_plan(qf);
+    fft_destroy_plan(qr);
+}
+
+// even sizes (half-length complex transform)
+void autotest_fft_r2c_2()    { fft_r2c_test(  2, 0); }
+void autotest_fft_r2c_4()    { fft_r2c_test(  4, 0); }
+void autotest_fft_r2c_20()   { fft_r2c_test( 20, 0); }
+void autotest_fft_r2c_64()   { fft_r2c_test( 64, 0); }
+void autotest_fft_r2c_314()  { fft_r2c_test(314, 0); }
+void autotest_fft_r2c_1024() { fft_r2c_test(1024, 0); }
+
+// odd sizes (full-length complex transform)
+void autotest_fft_r2c_1()    { fft_r2c_test(  1, 0); }
+void autotest_fft_r2c_35()   { fft_r2c_test( 35, 0); }
+void autotest_fft_r2c_157()  { fft_r2c_test(157, 0); }
+
+// measured sub-transform
+void autotest_fft_r2c_measure_240() { fft_r2c_test(240, LIQUID_FFT_MEASURE); }
+
+// real-input spectral periodogram (real-to-complex transform) matches
+// complex periodogram of the same signal
+void fft_r2c_spgram_test(unsigned int _nfft)
+{
+    unsigned int n = 8*_nfft;
+    spgramf  qr = spgramf_create_default(_nfft);
+    spgramcf qc = spgramcf_create_default(_nfft);
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        float x = randnf();
+        spgramf_push (qr, x);
+        spgramcf_push(qc, x);
+    }
+
+    float psd_r[_nfft];
+    float psd_c[_nfft];
+    spgramf_get_psd (qr, psd_r);
+    spgramcf_get_psd(qc, psd_c);
+    for (i=0; i<_nfft; i++)
+        CONTEND_DELTA(psd_r[i], psd_c[i], 1e-3f);
+
+    spgramf_destroy(qr);
+    spgramcf_destroy(qc);
+}
+void autotest_fft_r2c_spgram_64() { fft_r2c_spgram_test(64); }
+void autotest_fft_r2c_spgram_75() { fft_r2c_spgram_test(75); }
@@ -103,3 +103,79 @@ void autotest_fft_r2r_RODFT10_n27()  { fft_r2r_test(fftdata_r2r_x27, fftdata_r2r
 void autotest_fft_r2r_RODFT01_n27()  { fft_r2r_test(fftdata_r2r_x27, fftdata_r2r_RODFT01_y27, 27, LIQUID_FFT_RODFT01); }
 void autotest_fft_r2r_RODFT11_n27()  { fft_r2r_test(fftdata_r2r_x27, fftdata_r2r_RODFT11_y27, 27, LIQUID_FFT_RODFT11); }
 
+
+//
+// AUTOTESTS: real-to-real ffts against direct evaluation of the
+// definitions, sizes covering the even/odd and small-size paths
+//
+
+// direct double-precision evaluation of real-to-real transform
+void fft_r2r_direct(float *      _x,
+                    double *     _y,
+                    unsigned int _n,
+                    unsigned int _kind)
+{
+    unsigned int i, k;
+    double N = (double)_n;
+    for (k=0; k<_n; k++) {
+        double v = 0.0;
+        for (i=0; i<_n; i++) {
+            double x = (double)_x[i];
+            switch (_kind) {
+            case LIQUID_FFT_REDFT00:
+                if (i == 0 || i == _n-1) v += (i == 0 ? x : ((k % 2) ? -x : x));
+                else                     v += 2*x*cos(M_PI*i*k/(N-1));
+                break;
+            case LIQUID_FFT_REDFT10: v += 2*x*cos(M_PI*(i+0.5)*k/N);       break;
+            case LIQUID_FFT_REDFT01:
+                v += (i == 0) ? x : 2*x*cos(M_PI*i*(k+0.5)/N);
+                break;
+            case LIQUID_FFT_REDFT11: v += 2*x*cos(M_PI*(i+0.5)*(k+0.5)/N); break;
+            case LIQUID_FFT_RODFT00: v += 2*x*sin(M_PI*(i+1)*(k+1)/(N+1)); break;
+            case LIQUID_FFT_RODFT10: v += 2*x*sin(M_PI*(i+0.5)*(k+1)/N);   break;
+            case LIQUID_FFT_RODFT01:
+                v += (i == _n-1) ? ((k % 2) ? -x : x) : 2*x*sin(M_PI*(i+1)*(k+0.5)/N);
+                break;
+            case LIQUID_FFT_RODFT11: v += 2*x*sin(M_PI*(i+0.5)*(k+0.5)/N); break;
+            default:;
+            }
+        }
+        _y[k] = v;
+    }
+}
+
+void fft_r2r_test_direct(unsigned int _n)
+{
+    int kinds[8] = {LIQUID_FFT_REDFT00, LIQUID_FFT_REDFT10,
+                    LIQUID_FFT_REDFT01, LIQUID_FFT_REDFT11,
+                    LIQUID_FFT_RODFT00, LIQUID_FFT_RODFT10,
+                    LIQUID_FFT_RODFT01, LIQUID_FFT_RODFT11};
+    float  x[_n];
+    float  y[_n];
+    double y_test[_n];
+    unsigned int i, t;
+    for (i=0; i<_n; i++)
+        x[i] = randnf();
+
+    for (t=0; t<8; t++) {
+        // DCT-I is defined for at least two samples
+        if (kinds[t] == LIQUID_FFT_REDFT00 && _n < 2)
+            continue;
+
+        fftplan q = fft_create_plan_r2r_1d(_n, x, y, kinds[t], 0);
+        fft_execute(q);
+        fft_destroy_plan(q);
+
+        fft_r2r_direct(x, y_test, _n, kinds[t]);
+        float tol = 2e-5f * _n;
+        for (i=0; i<_n; i++)
+            CONTEND_DELTA(y[i], (float)y_test[i], tol);
+    }
+}
+
+void autotest_fft_r2r_direct_n1()   { fft_r2r_test_direct(  1); }
+void autotest_fft_r2r_direct_n2()   { fft_r2r_test_direct(  2); }
+void autotest_fft_r2r_direct_n3()   { fft_r2r_test_direct(  3); }
+void autotest_fft_r2r_direct_n100() { fft_r2r_test_direct(100); }
+void autotest_fft_r2r_direct_n127() { fft_r2r_test_direct(127); }
+void autotest_fft_r2r_direct_n256() { fft_r2r_test_direct(256); }
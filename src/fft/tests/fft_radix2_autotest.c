@@ -40,3 +40,11 @@ void autotest_fft_16()      { fft_test( fft_test_x16,  fft_test_y16,     16);
 void autotest_fft_32()      { fft_test( fft_test_x32,  fft_test_y32,     32);    }
 void autotest_fft_64()      { fft_test( fft_test_x64,  fft_test_y64,     64);    }
 
+// 
+// AUTOTESTS: power-of-two transforms, forced radix-2 method
+//
+void autotest_fft_radix2_2()  { fft_test_flags(fft_test_x2,  fft_test_y2,   2, LIQUID_FFT_FORCE_RADIX2); }
+void autotest_fft_radix2_4()  { fft_test_flags(fft_test_x4,  fft_test_y4,   4, LIQUID_FFT_FORCE_RADIX2); }
+void autotest_fft_radix2_8()  { fft_test_flags(fft_test_x8,  fft_test_y8,   8, LIQUID_FFT_FORCE_RADIX2); }
+void autotest_fft_radix2_16() { fft_test_flags(fft_test_x16, fft_test_y16, 16, LIQUID_FFT_FORCE_RADIX2); }
+void autotest_fft_radix2_32() { fft_test_flags(fft_test_x32, fft_test_y32, 32, LIQUID_FFT_FORCE_RADIX2); }
@@ -22,6 +22,7 @@
 
 #include "autotest/autotest.h"
 #include "liquid.h"
+#include "src/fft/tests/fft_runtest.h"
 
 // autotest helper function
 //  _x      :   fft input array
@@ -31,7 +32,20 @@ void fft_test(float complex * _x,
               float complex * _test,
               unsigned int    _n)
 {
-    int _method = 0;
+    fft_test_flags(_x, _test, _n, LIQUID_FFT_ESTIMATE);
+}
+
+// autotest helper function with explicit plan flags
+//  _x      :   fft input array
+//  _test   :   expected fft output
+//  _n      :   fft size
+//  _flags  :   fft plan flags, e.g. LIQUID_FFT_MEASURE
+void fft_test_flags(float complex * _x,
+                    float complex * _test,
+                    unsigned int    _n,
+                    int             _flags)
+{
+    int _method = _flags;
     float tol=2e-4f;
 
     unsigned int i;
@@ -35,6 +35,16 @@ void fft_test(float complex * _x,
               float complex * _test,
               unsigned int    _n);
 
+// autotest helper function with explicit plan flags
+//  _x      :   fft input array
+//  _test   :   expected fft output
+//  _n      :   fft size
+//  _flags  :   fft plan flags, e.g. LIQUID_FFT_MEASURE
+void fft_test_flags(float complex * _x,
+                    float complex * _test,
+                    unsigned int    _n,
+                    int             _flags);
+
 // 
 // autotest datasets
 //
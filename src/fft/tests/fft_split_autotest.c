@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_split_autotest.c : test transforms on split-complex arrays
+//
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare split-complex transform against regular transform
+//  _n          :   transform size
+//  _dir        :   transform direction
+//  _in_place   :   run transform in place?
+//  _level      :   SIMD dispatch level
+void fft_split_test(unsigned int      _n,
+                    int               _dir,
+                    int               _in_place,
+                    liquid_simd_level _level)
+{
+    float tol = 2e-5f * _n;
+    liquid_simd_level level = liquid_simd_set_level(_level);
+
+    float *         xr = (float*) malloc(_n*sizeof(float));
+    float *         xi = (float*) malloc(_n*sizeof(float));
+    float *         yr = _in_place ? xr : (float*) malloc(_n*sizeof(float));
+    float *         yi = _in_place ? xi : (float*) malloc(_n*sizeof(float));
+    float complex * x0 = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(_n*sizeof(float complex));
+
+    // create plan before writing input
+    fftplan q = fft_create_plan_split(_n, xr, xi, yr, yi, _dir, 0);
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        x0[i] = randnf() + _Complex_I*randnf();
+    liquid_vectorcf_split(x0, _n, xr, xi);
+    fft_run(_n, x0, y0, _dir, 0);
+    fft_execute(q);
+
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA(yr[i], crealf(y0[i]), tol);
+        CONTEND_DELTA(yi[i], cimagf(y0[i]), tol);
+    }
+
+    fft_destroy_plan(q);
+    free(xr);
+    free(xi);
+    if (!_in_place) {
+        free(yr);
+        free(yi);
+    }
+    free(x0);
+    free(y0);
+    liquid_simd_set_level(level);
+}
+
+// radix-2 sizes (odd and even number of radix-2 stages)
+void autotest_fft_split_2()             { fft_split_test(   2, LIQUID_FFT_FORWARD,  0, liquid_simd_get_host_level()); }
+void autotest_fft_split_4()             { fft_split_test(   4, LIQUID_FFT_BACKWARD, 0, liquid_simd_get_host_level()); }
+void autotest_fft_split_32()            { fft_split_test(  32, LIQUID_FFT_FORWARD,  0, liquid_simd_get_host_level()); }
+void autotest_fft_split_64()            { fft_split_test(  64, LIQUID_FFT_FORWARD,  0, liquid_simd_get_host_level()); }
+void autotest_fft_split_512()           { fft_split_test( 512, LIQUID_FFT_BACKWARD, 0, liquid_simd_get_host_level()); }
+void autotest_fft_split_1024()          { fft_split_test(1024, LIQUID_FFT_FORWARD,  0, liquid_simd_get_host_level()); }
+void autotest_fft_split_1024_inplace()  { fft_split_test(1024, LIQUID_FFT_BACKWARD, 1, liquid_simd_get_host_level()); }
+void autotest_fft_split_2048_portable() { fft_split_test(2048, LIQUID_FFT_FORWARD,  0, LIQUID_SIMD_PORTABLE); }
+
+// other sizes: regular transform
+void autotest_fft_split_1()             { fft_split_test(   1, LIQUID_FFT_FORWARD,  0, liquid_simd_get_host_level()); }
+void autotest_fft_split_17()            { fft_split_test(  17, LIQUID_FFT_FORWARD,  0, liquid_simd_get_host_level()); }
+void autotest_fft_split_240_inplace()   { fft_split_test( 240, LIQUID_FFT_BACKWARD, 1, liquid_simd_get_host_level()); }
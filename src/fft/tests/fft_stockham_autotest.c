@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_stockham_autotest.c : test Stockham auto-sort transforms
+//
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// autotest data definitions
+#include "src/fft/tests/fft_runtest.h"
+
+//
+// AUTOTESTS: Stockham transforms against reference data
+//
+void autotest_fft_stockham_2()   { fft_test_flags(fft_test_x2,   fft_test_y2,     2, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_3()   { fft_test_flags(fft_test_x3,   fft_test_y3,     3, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_4()   { fft_test_flags(fft_test_x4,   fft_test_y4,     4, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_5()   { fft_test_flags(fft_test_x5,   fft_test_y5,     5, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_6()   { fft_test_flags(fft_test_x6,   fft_test_y6,     6, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_7()   { fft_test_flags(fft_test_x7,   fft_test_y7,     7, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_8()   { fft_test_flags(fft_test_x8,   fft_test_y8,     8, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_9()   { fft_test_flags(fft_test_x9,   fft_test_y9,     9, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_10()  { fft_test_flags(fft_test_x10,  fft_test_y10,   10, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_16()  { fft_test_flags(fft_test_x16,  fft_test_y16,   16, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_20()  { fft_test_flags(fft_test_x20,  fft_test_y20,   20, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_21()  { fft_test_flags(fft_test_x21,  fft_test_y21,   21, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_22()  { fft_test_flags(fft_test_x22,  fft_test_y22,   22, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_26()  { fft_test_flags(fft_test_x26,  fft_test_y26,   26, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_32()  { fft_test_flags(fft_test_x32,  fft_test_y32,   32, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_35()  { fft_test_flags(fft_test_x35,  fft_test_y35,   35, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_36()  { fft_test_flags(fft_test_x36,  fft_test_y36,   36, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_63()  { fft_test_flags(fft_test_x63,  fft_test_y63,   63, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_64()  { fft_test_flags(fft_test_x64,  fft_test_y64,   64, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_120() { fft_test_flags(fft_test_x120, fft_test_y120, 120, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_130() { fft_test_flags(fft_test_x130, fft_test_y130, 130, LIQUID_FFT_FORCE_STOCKHAM); }
+void autotest_fft_stockham_192() { fft_test_flags(fft_test_x192, fft_test_y192, 192, LIQUID_FFT_FORCE_STOCKHAM); }
+
+// in-place Stockham transform matches out-of-place default transform
+//  _n      :   transform size
+//  _dir    :   transform direction
+void fft_stockham_in_place_test(unsigned int _n,
+                                int          _dir)
+{
+    float tol = 1e-5f * _n;
+    float complex * x = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * y = (float complex*) malloc(_n*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    fft_run(_n, x, y, _dir, 0);
+
+    fftplan q = fft_create_plan(_n, x, x, _dir, LIQUID_FFT_FORCE_STOCKHAM);
+    fft_execute(q);
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA(crealf(x[i]), crealf(y[i]), tol);
+        CONTEND_DELTA(cimagf(x[i]), cimagf(y[i]), tol);
+    }
+
+    if (liquid_autotest_verbose)
+        fft_print_plan(q);
+
+    fft_destroy_plan(q);
+    free(x);
+    free(y);
+}
+
+// even and odd number of stages
+void autotest_fft_stockham_in_place_1024()     { fft_stockham_in_place_test(1024, LIQUID_FFT_FORWARD);  }
+void autotest_fft_stockham_in_place_2048()     { fft_stockham_in_place_test(2048, LIQUID_FFT_BACKWARD); }
+void autotest_fft_stockham_in_place_1000()     { fft_stockham_in_place_test(1000, LIQUID_FFT_FORWARD);  }
+void autotest_fft_stockham_in_place_243()      { fft_stockham_in_place_test( 243, LIQUID_FFT_BACKWARD); }
+void autotest_fft_stockham_in_place_1001()     { fft_stockham_in_place_test(1001, LIQUID_FFT_FORWARD);  }
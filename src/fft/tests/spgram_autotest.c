@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// spgram_autotest.c : test spectral periodogram input buffering,
+//                     transform budget and multi-stream object
+//
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// writing in blocks of any size matches pushing one sample at a time
+void autotest_spgramcf_write_blocks()
+{
+    unsigned int nfft = 128;
+    unsigned int n    = 3000;
+    spgramcf q0 = spgramcf_create(nfft, LIQUID_WINDOW_HANN, 100, 37);
+    spgramcf q1 = spgramcf_create(nfft, LIQUID_WINDOW_HANN, 100, 37);
+
+    float complex x[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        spgramcf_push(q0, x[i]);
+    }
+    for (i=0; i<n; ) {
+        unsigned int k = 1 + rand() % 250;
+        k = i + k > n ? n - i : k;
+        spgramcf_write(q1, x + i, k);
+        i += k;
+    }
+    CONTEND_EQUALITY(spgramcf_get_num_transforms(q0), n/37);
+    CONTEND_EQUALITY(spgramcf_get_num_transforms(q1), n/37);
+
+    float psd0[nfft], psd1[nfft];
+    spgramcf_get_psd(q0, psd0);
+    spgramcf_get_psd(q1, psd1);
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA(psd0[i], psd1[i], 1e-3f);
+
+    spgramcf_destroy(q0);
+    spgramcf_destroy(q1);
+}
+
+// a delay longer than the window only transforms the latest samples:
+// compare to a contiguous transform of only those segments
+void spgram_test_decimated(unsigned int _window_len,
+                           unsigned int _delay)
+{
+    unsigned int nfft = 64;
+    unsigned int num  = 20;     // number of transforms
+    spgramcf q0 = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, _window_len, _delay);
+    spgramcf q1 = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, _window_len, _window_len);
+
+    float complex x[_delay];
+    unsigned int i, k;
+    for (k=0; k<num; k++) {
+        for (i=0; i<_delay; i++)
+            x[i] = randnf() + _Complex_I*randnf();
+        spgramcf_write(q0, x, _delay);
+        spgramcf_write(q1, x + _delay - _window_len, _window_len);
+    }
+    CONTEND_EQUALITY(spgramcf_get_num_transforms(q0), num);
+    CONTEND_EQUALITY(spgramcf_get_num_transforms(q1), num);
+
+    float psd0[nfft], psd1[nfft];
+    spgramcf_get_psd(q0, psd0);
+    spgramcf_get_psd(q1, psd1);
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA(psd0[i], psd1[i], 1e-3f);
+
+    spgramcf_destroy(q0);
+    spgramcf_destroy(q1);
+}
+void autotest_spgramcf_decimated_2x()  { spgram_test_decimated(48,  96); }
+void autotest_spgramcf_decimated_odd() { spgram_test_decimated(40, 173); }
+
+// transforms due over budget are skipped and counted
+void autotest_spgramcf_transform_budget()
+{
+    // 100 transforms due per second of input, 25 allowed
+    spgramcf q = spgramcf_create(64, LIQUID_WINDOW_HANN, 32, 10);
+    CONTEND_EQUALITY(spgramcf_set_transform_budget(q, 1000.0f, 25.0f), 0);
+
+    float complex x[500];
+    unsigned int i;
+    for (i=0; i<500; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    for (i=0; i<20; i++)
+        spgramcf_write(q, x, 500);
+
+    uint64_t num  = spgramcf_get_num_transforms(q);
+    uint64_t skip = spgramcf_get_num_transforms_skipped(q);
+    CONTEND_EQUALITY(num + skip, 1000);
+    CONTEND_EXPRESSION(num >= 249 && num <= 251);
+
+    // budget larger than the transform rate skips nothing
+    spgramcf_reset(q);
+    CONTEND_EQUALITY(spgramcf_set_transform_budget(q, 1000.0f, 200.0f), 0);
+    spgramcf_write(q, x, 500);
+    CONTEND_EQUALITY(spgramcf_get_num_transforms(q), 50);
+    CONTEND_EQUALITY(spgramcf_get_num_transforms_skipped(q), 0);
+
+    // zero budget skips everything
+    spgramcf_reset(q);
+    CONTEND_EQUALITY(spgramcf_set_transform_budget(q, 1000.0f, 0.0f), 0);
+    spgramcf_write(q, x, 500);
+    CONTEND_EQUALITY(spgramcf_get_num_transforms(q), 0);
+    CONTEND_EQUALITY(spgramcf_get_num_transforms_skipped(q), 50);
+
+    spgramcf_destroy(q);
+}
+
+// changing the delay at run time
+void autotest_spgramf_set_delay()
+{
+    spgramf q = spgramf_create(64, LIQUID_WINDOW_HANN, 64, 16);
+    CONTEND_EQUALITY(spgramf_set_delay(q, 0), -1);
+    CONTEND_EQUALITY(spgramf_set_transform_budget(q, 0.0f, 1.0f), -1);
+    CONTEND_EQUALITY(spgramf_set_transform_budget(q, 1.0f, -1.0f), -1);
+
+    float x[256];
+    unsigned int i;
+    for (i=0; i<256; i++)
+        x[i] = randnf();
+    spgramf_write(q, x, 256);
+    CONTEND_EQUALITY(spgramf_get_num_transforms(q), 16);
+
+    CONTEND_EQUALITY(spgramf_set_delay(q, 64), 0);
+    CONTEND_EQUALITY(spgramf_get_delay(q), 64);
+    spgramf_write(q, x, 256);
+    CONTEND_EQUALITY(spgramf_get_num_transforms(q), 20);
+
+    spgramf_destroy(q);
+}
+
+// streams of a multi-stream object match independent objects, also
+// when written interleaved in blocks of different sizes
+void spgram_test_multi(unsigned int _num_streams)
+{
+    unsigned int nfft = 64;
+    unsigned int n    = 1000;
+    unsigned int s, i;
+    spgramcf_multi qc = spgramcf_multi_create(_num_streams, nfft, LIQUID_WINDOW_HANN, 48, 21);
+    spgramf_multi  qr = spgramf_multi_create (_num_streams, nfft, LIQUID_WINDOW_HANN, 48, 21);
+    CONTEND_EQUALITY(spgramcf_multi_get_num_streams(qc), _num_streams);
+
+    for (s=0; s<_num_streams; s++) {
+        // per-stream settings
+        float alpha = s % 2 ? 0.1f : -1.0f;
+        spgramcf_set_alpha(spgramcf_multi_get_stream(qc,s), alpha);
+        spgramf_set_alpha (spgramf_multi_get_stream (qr,s), alpha);
+    }
+
+    // independent reference objects
+    spgramcf rc[_num_streams];
+    spgramf  rr[_num_streams];
+    float complex xc[_num_streams][n];
+    float         xr[_num_streams][n];
+    for (s=0; s<_num_streams; s++) {
+        rc[s] = spgramcf_create(nfft, LIQUID_WINDOW_HANN, 48, 21);
+        rr[s] = spgramf_create (nfft, LIQUID_WINDOW_HANN, 48, 21);
+        spgramcf_set_alpha(rc[s], s % 2 ? 0.1f : -1.0f);
+        spgramf_set_alpha (rr[s], s % 2 ? 0.1f : -1.0f);
+        for (i=0; i<n; i++) {
+            xc[s][i] = (randnf() + _Complex_I*randnf()) * (1.0f + s);
+            xr[s][i] = randnf() * (1.0f + s);
+        }
+        spgramcf_write(rc[s], xc[s], n);
+        spgramf_write (rr[s], xr[s], n);
+    }
+
+    // write streams interleaved in blocks
+    unsigned int idx[_num_streams];
+    for (s=0; s<_num_streams; s++)
+        idx[s] = 0;
+    unsigned int remaining = _num_streams;
+    while (remaining > 0) {
+        s = rand() % _num_streams;
+        if (idx[s] == n)
+            continue;
+        unsigned int k = 1 + rand() % 50;
+        k = idx[s] + k > n ? n - idx[s] : k;
+        spgramcf_multi_write(qc, s, xc[s] + idx[s], k);
+        spgramf_multi_write (qr, s, xr[s] + idx[s], k);
+        idx[s] += k;
+        if (idx[s] == n)
+            remaining--;
+    }
+
+    float psd0[nfft], psd1[nfft];
+    for (s=0; s<_num_streams; s++) {
+        CONTEND_EQUALITY(spgramcf_get_num_transforms(spgramcf_multi_get_stream(qc,s)), n/21);
+        spgramcf_multi_get_psd(qc, s, psd0);
+        spgramcf_get_psd(rc[s], psd1);
+        for (i=0; i<nfft; i++)
+            CONTEND_DELTA(psd0[i], psd1[i], 1e-3f);
+
+        spgramf_multi_get_psd(qr, s, psd0);
+        spgramf_get_psd(rr[s], psd1);
+        for (i=0; i<nfft; i++)
+            CONTEND_DELTA(psd0[i], psd1[i], 1e-3f);
+
+        spgramcf_destroy(rc[s]);
+        spgramf_destroy(rr[s]);
+    }
+
+    // reset clears all streams
+    spgramcf_multi_reset(qc);
+    for (s=0; s<_num_streams; s++)
+        CONTEND_EQUALITY(spgramcf_get_num_transforms(spgramcf_multi_get_stream(qc,s)), 0);
+
+    spgramcf_multi_destroy(qc);
+    spgramf_multi_destroy(qr);
+}
+void autotest_spgram_multi_1()  { spgram_test_multi( 1); }
+void autotest_spgram_multi_16() { spgram_test_multi(16); }
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void autocorr_cccf_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         unsigned int        _window_size,
+                         int                 _recursive)
+{
+    // normalize number of iterations
+    if (!_recursive)
+        *_num_iterations = *_num_iterations * 16 / _window_size;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    autocorr_cccf q = autocorr_cccf_create(_window_size, _window_size/4);
+    autocorr_cccf_set_recursive(q, _recursive);
+
+    float complex x[64];
+    float complex y[64];
+    unsigned long int i;
+    for (i=0; i<64; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        autocorr_cccf_execute_block(q, x, 64, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 64;
+
+    autocorr_cccf_destroy(q);
+}
+
+#define AUTOCORR_CCCF_BENCHMARK_API(N,R)    \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ autocorr_cccf_bench(_start, _finish, _num_iterations, N, R); }
+
+void benchmark_autocorr_cccf_n16        AUTOCORR_CCCF_BENCHMARK_API(16,  0)
+void benchmark_autocorr_cccf_n64        AUTOCORR_CCCF_BENCHMARK_API(64,  0)
+void benchmark_autocorr_cccf_n256       AUTOCORR_CCCF_BENCHMARK_API(256, 0)
+void benchmark_autocorr_cccf_rec_n16    AUTOCORR_CCCF_BENCHMARK_API(16,  1)
+void benchmark_autocorr_cccf_rec_n64    AUTOCORR_CCCF_BENCHMARK_API(64,  1)
+void benchmark_autocorr_cccf_rec_n256   AUTOCORR_CCCF_BENCHMARK_API(256, 1)
@@ -78,3 +78,32 @@ void benchmark_iirdecim_crcf_M8     IIRDECIM_CRCF_BENCHMARK_API(8, 5)
 void benchmark_iirdecim_crcf_M16    IIRDECIM_CRCF_BENCHMARK_API(16,5)
 void benchmark_iirdecim_cccf_M32    IIRDECIM_CRCF_BENCHMARK_API(32,5)
 
+
+// half-band polyphase all-pass decimator
+void benchmark_iirdecim_crcf_halfband(struct rusage *     _start,
+                                      struct rusage *     _finish,
+                                      unsigned long int * _num_iterations)
+{
+    // normalize number of iterations
+    *_num_iterations /= 5;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    iirdecim_crcf q = iirdecim_crcf_create_halfband(0.1f, 60.0f);
+
+    float complex x[2] = {-1.0f, 1.0f};
+    float complex y;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    unsigned long int i;
+    for (i=0; i<(*_num_iterations); i++) {
+        iirdecim_crcf_execute(q, x, &y);
+        iirdecim_crcf_execute(q, x, &y);
+        iirdecim_crcf_execute(q, x, &y);
+        iirdecim_crcf_execute(q, x, &y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    iirdecim_crcf_destroy(q);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; one trial is one sample
+// on every channel
+void iirfiltmc_crcf_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          unsigned int        _num_channels,
+                          int                 _block)
+{
+    unsigned long int i;
+    unsigned int n = 64;    // samples per block
+
+    // scale number of iterations (trials)
+    *_num_iterations /= _num_channels*n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // 4th-order band-pass filter
+    iirfiltmc_crcf q = iirfiltmc_crcf_create_prototype(LIQUID_IIRDES_BUTTER,
+                                                       LIQUID_IIRDES_BANDPASS,
+                                                       4, 0.1f, 0.25f, 0.1f, 60.0f,
+                                                       _num_channels);
+
+    // initialize input/output
+    float complex x[n*_num_channels];
+    float complex y[n*_num_channels];
+    for (i=0; i<n*_num_channels; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_block) {
+            iirfiltmc_crcf_execute_block(q, x, n, y);
+        } else {
+            unsigned int j;
+            for (j=0; j<n; j++)
+                iirfiltmc_crcf_execute(q, &x[j*_num_channels], &y[j*_num_channels]);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    // destroy filter object
+    iirfiltmc_crcf_destroy(q);
+}
+
+#define IIRFILTMC_CRCF_BENCHMARK_API(C,B)   \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ iirfiltmc_crcf_bench(_start, _finish, _num_iterations, C, B); }
+
+//
+// multi-channel IIR filter benchmark prototypes
+//
+void benchmark_iirfiltmc_crcf_c4          IIRFILTMC_CRCF_BENCHMARK_API( 4, 0)
+void benchmark_iirfiltmc_crcf_c16         IIRFILTMC_CRCF_BENCHMARK_API(16, 0)
+void benchmark_iirfiltmc_crcf_c4_block    IIRFILTMC_CRCF_BENCHMARK_API( 4, 1)
+void benchmark_iirfiltmc_crcf_c16_block   IIRFILTMC_CRCF_BENCHMARK_API(16, 1)
+
@@ -73,3 +73,31 @@ void benchmark_iirinterp_crcf_M8    IIRINTERP_CRCF_BENCHMARK_API(8, 5)
 void benchmark_iirinterp_crcf_M16   IIRINTERP_CRCF_BENCHMARK_API(16,5)
 void benchmark_iirinterp_crcf_M32   IIRINTERP_CRCF_BENCHMARK_API(32,5)
 
+
+// half-band polyphase all-pass interpolator
+void benchmark_iirinterp_crcf_halfband(struct rusage *     _start,
+                                       struct rusage *     _finish,
+                                       unsigned long int * _num_iterations)
+{
+    // normalize number of iterations
+    *_num_iterations *= 8;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    iirinterp_crcf q = iirinterp_crcf_create_halfband(0.1f, 60.0f);
+
+    float complex y[2];
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    unsigned long int i;
+    for (i=0; i<(*_num_iterations); i++) {
+        iirinterp_crcf_execute(q, 1.0f, y);
+        iirinterp_crcf_execute(q, 1.0f, y);
+        iirinterp_crcf_execute(q, 1.0f, y);
+        iirinterp_crcf_execute(q, 1.0f, y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    iirinterp_crcf_destroy(q);
+}
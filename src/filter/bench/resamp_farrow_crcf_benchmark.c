@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void resamp_farrow_crcf_bench(struct rusage *     _start,
+                              struct rusage *     _finish,
+                              unsigned long int * _num_iterations,
+                              unsigned int        _m,
+                              unsigned int        _order)
+{
+    unsigned long int i;
+    float r = 1.03f;        // resampling rate
+    float bw = 0.35f;       // filter bandwidth
+    float As = 60.0f;       // stop-band attenuation [dB]
+
+    resamp_farrow_crcf q = resamp_farrow_crcf_create(r,_m,bw,As,_order);
+
+    float complex x[4] = {1.0f, 1.1f, 0.9f, 1.0f};
+    float complex y[8];
+    unsigned int num_written;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        resamp_farrow_crcf_execute_block(q, x, 4, y, &num_written);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    resamp_farrow_crcf_destroy(q);
+}
+
+#define RESAMP_FARROW_CRCF_BENCHMARK_API(M,ORDER)   \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ resamp_farrow_crcf_bench(_start, _finish, _num_iterations, M, ORDER); }
+
+//
+// Farrow resampler benchmark prototypes
+//
+void benchmark_resamp_farrow_crcf_m4_p3    RESAMP_FARROW_CRCF_BENCHMARK_API(4, 3)
+void benchmark_resamp_farrow_crcf_m8_p3    RESAMP_FARROW_CRCF_BENCHMARK_API(8, 3)
+void benchmark_resamp_farrow_crcf_m8_p5    RESAMP_FARROW_CRCF_BENCHMARK_API(8, 5)
+void benchmark_resamp_farrow_crcf_m16_p3   RESAMP_FARROW_CRCF_BENCHMARK_API(16,3)
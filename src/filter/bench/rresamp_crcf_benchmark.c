@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void rresamp_crcf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _P,
+                        unsigned int        _Q)
+{
+    unsigned long int i;
+    rresamp_crcf q = rresamp_crcf_create(_P, _Q, 12, 0.45f, 60.0f);
+
+    float complex x[_Q];
+    float complex y[_P];
+    for (i=0; i<_Q; i++)
+        x[i] = 1.0f + 0.1f*_Complex_I*i;
+
+    // normalize iterations to one per input sample
+    *_num_iterations /= _Q;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        rresamp_crcf_execute_block(q, x, 1, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _Q;
+
+    rresamp_crcf_destroy(q);
+}
+
+#define RRESAMP_CRCF_BENCHMARK_API(P,Q) \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ rresamp_crcf_bench(_start, _finish, _num_iterations, P, Q); }
+
+//
+// Resampler benchmark prototypes
+//
+void benchmark_rresamp_crcf_P2_Q3       RRESAMP_CRCF_BENCHMARK_API(  2,   3)
+void benchmark_rresamp_crcf_P3_Q2       RRESAMP_CRCF_BENCHMARK_API(  3,   2)
+void benchmark_rresamp_crcf_P147_Q160   RRESAMP_CRCF_BENCHMARK_API(147, 160)
+void benchmark_rresamp_crcf_P160_Q147   RRESAMP_CRCF_BENCHMARK_API(160, 147)
+
@@ -38,6 +38,15 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
+// conjugate and squared magnitude of input sample
+#if TI_COMPLEX
+#  define AUTOCORR_CONJ(x)  conjf(x)
+#  define AUTOCORR_NORM2(x) (crealf(x)*crealf(x) + cimagf(x)*cimagf(x))
+#else
+#  define AUTOCORR_CONJ(x)  (x)
+#  define AUTOCORR_NORM2(x) ((x)*(x))
+#endif
+
 struct AUTOCORR(_s) {
     unsigned int window_size;
     unsigned int delay;
@@ -48,6 +57,12 @@ struct AUTOCORR(_s) {
     float * we2;        // energy buffer
     float e2_sum;       // running sum of energy
     unsigned int ie2;   // read index
+
+    // recursive mode: running sum of lag products, re-computed
+    // exactly each time the ring index wraps to bound drift
+    int recursive;      // recursive mode enabled?
+    TO * wr;            // lag product buffer (shares index ie2)
+    TO rxx_sum;         // running sum of lag products
 };
 
 // create auto-correlator object                            
@@ -57,7 +72,7 @@ AUTOCORR() AUTOCORR(_create)(unsigned int _window_size,
                              unsigned int _delay)
 {
     // create main object
-    AUTOCORR() q = (AUTOCORR()) malloc(sizeof(struct AUTOCORR(_s)));
+    AUTOCORR() q = (AUTOCORR()) liquid_malloc(sizeof(struct AUTOCORR(_s)));
 
     // set user-based parameters
     q->window_size = _window_size;
@@ -68,7 +83,11 @@ AUTOCORR() AUTOCORR(_create)(unsigned int _window_size,
     q->wdelay = WINDOW(_create)(q->window_size + q->delay);
 
     // allocate array for squared energy buffer
-    q->we2 = (float*) malloc( (q->window_size)*sizeof(float) );
+    q->we2 = (float*) liquid_malloc( (q->window_size)*sizeof(float) );
+
+    // allocate array for lag products (recursive mode)
+    q->wr = (TO*) liquid_malloc( (q->window_size)*sizeof(TO) );
+    q->recursive = 0;
 
     // clear object
     AUTOCORR(_reset)(q);
@@ -85,10 +104,11 @@ void AUTOCORR(_destroy)(AUTOCORR() _q)
     WINDOW(_destroy)(_q->wdelay);
 
     // free array for squared energy buffer
-    free(_q->we2);
+    liquid_free(_q->we2);
+    liquid_free(_q->wr);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // reset auto-correlator object's internals
@@ -104,32 +124,115 @@ void AUTOCORR(_reset)(AUTOCORR() _q)
     for (i=0; i<_q->window_size; i++)
         _q->we2[i] = 0.0;
     _q->ie2 = 0;    // reset read index to zero
+
+    // reset running sum of lag products
+    _q->rxx_sum = 0;
+    for (i=0; i<_q->window_size; i++)
+        _q->wr[i] = 0;
 }
 
 // print auto-correlator parameters to stdout
 void AUTOCORR(_print)(AUTOCORR() _q)
 {
-    printf("autocorr [%u window, %u delay]\n", _q->window_size, _q->delay);
+    printf("autocorr [%u window, %u delay%s]\n", _q->window_size, _q->delay,
+            _q->recursive ? ", recursive" : "");
 }
 
+// set recursive mode: when enabled, the output is kept as a running
+// sum of lag products (O(1) per sample) which is re-computed exactly
+// once every _window_size samples; otherwise the full dot product is
+// computed for every output (default)
+void AUTOCORR(_set_recursive)(AUTOCORR() _q,
+                              int        _recursive)
+{
+    if (_recursive && !_q->recursive) {
+        // fill lag product buffer from current windows; index ie2
+        // holds the oldest product
+        TI * rw;
+        TC * rwdelay;
+        WINDOW(_read)(_q->w,      &rw     );
+        WINDOW(_read)(_q->wdelay, &rwdelay);
+        unsigned int i;
+        for (i=0; i<_q->window_size; i++)
+            _q->wr[(_q->ie2 + i) % _q->window_size] = rw[i] * rwdelay[i];
+        DOTPROD(_run4)(rw, rwdelay, _q->window_size, &_q->rxx_sum);
+    }
+    _q->recursive = _recursive ? 1 : 0;
+}
+
+// get recursive mode
+int AUTOCORR(_get_recursive)(AUTOCORR() _q)
+{
+    return _q->recursive;
+}
+
+// internal methods (recursive mode)
+void AUTOCORR(_push_recursive)(AUTOCORR() _q, TI _x);
+void AUTOCORR(_resync)(AUTOCORR() _q);
+
 // push sample into auto-correlator object
 void AUTOCORR(_push)(AUTOCORR() _q, TI _x)
 {
     // push input sample into buffers
     WINDOW(_push)(_q->w,      _x);          // non-delayed buffer
-    WINDOW(_push)(_q->wdelay, conj(_x));    // delayed buffer
+    WINDOW(_push)(_q->wdelay, AUTOCORR_CONJ(_x));   // delayed buffer
 
     // push |_x|^2 into buffer at appropriate location
-    float e2 = creal( _x*conj(_x) );
+    float e2 = AUTOCORR_NORM2(_x);
     _q->e2_sum -= _q->we2[ _q->ie2 ];
     _q->e2_sum += e2;
     _q->we2[ _q->ie2 ] = e2;
-    _q->ie2 = (_q->ie2+1) % _q->window_size;
+
+    if (_q->recursive)
+        AUTOCORR(_push_recursive)(_q, _x);
+
+    _q->ie2++;
+    if (_q->ie2 == _q->window_size)
+        _q->ie2 = 0;
+
+    // re-compute running sums exactly once per pass of the buffers
+    if (_q->recursive && _q->ie2 == 0)
+        AUTOCORR(_resync)(_q);
+}
+
+// recursive mode: replace oldest lag product with that of the sample
+// just pushed and its delayed counterpart
+void AUTOCORR(_push_recursive)(AUTOCORR() _q,
+                               TI         _x)
+{
+    TC * rwdelay;
+    WINDOW(_read)(_q->wdelay, &rwdelay);
+    TO r = _x * rwdelay[_q->window_size - 1];
+    _q->rxx_sum -= _q->wr[ _q->ie2 ];
+    _q->rxx_sum += r;
+    _q->wr[ _q->ie2 ] = r;
+}
+
+// recursive mode: re-compute running sums of lag products and energy
+void AUTOCORR(_resync)(AUTOCORR() _q)
+{
+    TI * rw;
+    TC * rwdelay;
+    WINDOW(_read)(_q->w,      &rw     );
+    WINDOW(_read)(_q->wdelay, &rwdelay);
+    DOTPROD(_run4)(rw, rwdelay, _q->window_size, &_q->rxx_sum);
+
+    float e2_sum = 0.0f;
+    unsigned int i;
+    for (i=0; i<_q->window_size; i++)
+        e2_sum += _q->we2[i];
+    _q->e2_sum = e2_sum;
 }
 
 // compute auto-correlation output
 void AUTOCORR(_execute)(AUTOCORR() _q, TO *_rxx)
 {
+    // recursive mode: running sum is up to date
+    if (_q->recursive) {
+        *_rxx = _q->rxx_sum;
+        return;
+    }
+
     // provide pointers for reading buffer
     TI * rw;        // input buffer read pointer
     TC * rwdelay;   // input buffer read pointer (with delay)
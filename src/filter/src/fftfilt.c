@@ -24,6 +24,18 @@
 // fftfilt : finite impulse response (FIR) filter using fast Fourier
 //           transforms (FFTs)
 //
+// Blocks of n input samples are zero-padded to the transform size
+// nfft >= n + h_len - 1 and filtered in the frequency domain; the
+// nfft - n trailing output samples of each block are overlapped and
+// added onto the following block(s).
+//
+// Partitioned objects (see fftfilt_xxxt_create_partitioned()) instead
+// split the coefficients into partitions of n taps filtered with
+// uniformly partitioned overlap-save: each input block is transformed
+// once with nfft = 2n into a frequency-domain delay line shared by all
+// partitions, so the latency is a single block of n samples regardless
+// of the filter length.
+//
 
 #include <stdio.h>
 #include <string.h>
@@ -41,14 +53,31 @@ struct FFTFILT(_s) {
     TC * h;             // filter coefficients array [size; h_len x 1]
     unsigned int h_len; // filter length
     unsigned int n;     // input/output block size
+    unsigned int nfft;  // transform size, nfft >= n + h_len - 1
+    unsigned int w_len; // overlap length, nfft - n
+    unsigned int nfreq; // number of frequency bins
+
+    // uniformly partitioned convolution
+    int          partitioned;   // partitioned overlap-save enabled?
+    unsigned int num_parts;     // number of partitions (1 if disabled)
+    unsigned int fdl_index;     // delay line index of newest block
+    float complex * fdl;        // frequency-domain delay line [size: num_parts*nfreq x 1]
 
     // internal memory arrays
+#if TI_COMPLEX
     // TODO: make TI/TO type, but ensuring complex
-    // TODO: use special format for fftfilt_rrrf type
-    float complex * time_buf;   // time buffer [size: 2*n x 1]
-    float complex * freq_buf;   // freq buffer [size: 2*n x 1]
-    float complex * H;          // FFT of filter coefficients [size: 2*n x 1]
-    float complex * w;          // overlap array [size: n x 1]
+    float complex * time_buf;   // time buffer [size: nfft x 1]
+    float complex * freq_buf;   // freq buffer [size: nfft x 1]
+    float complex * H;          // FFT of filter coefficients [size: num_parts*nfft x 1]
+    float complex * w;          // overlap array (input history if partitioned) [size: w_len x 1]
+#else
+    // real input and coefficients: real-to-complex transforms only
+    // compute the non-negative frequencies
+    float *         time_buf;   // time buffer [size: nfft x 1]
+    float complex * freq_buf;   // freq buffer [size: nfft/2+1 x 1]
+    float complex * H;          // FFT of filter coefficients [size: num_parts*(nfft/2+1) x 1]
+    float *         w;          // overlap array (input history if partitioned) [size: w_len x 1]
+#endif
 
     // FFT objects
 #ifdef LIQUID_FFTOVERRIDE
@@ -62,6 +91,23 @@ struct FFTFILT(_s) {
     TC scale;           // output scaling factor
 };
 
+// create object (internal)
+//  _h      : filter coefficients [size: _h_len x 1]
+//  _h_len  : filter length
+//  _n      : block size
+//  _nfft   : transform size
+//  _part   : partitioned overlap-save (nfft = 2n)?
+FFTFILT() FFTFILT(_create_internal)(TC *         _h,
+                                    unsigned int _h_len,
+                                    unsigned int _n,
+                                    unsigned int _nfft,
+                                    int          _part);
+
+// execute partitioned overlap-save on one block (internal)
+void FFTFILT(_execute_partitioned)(FFTFILT() _q,
+                                   TI *      _x,
+                                   TO *      _y);
+
 // create FFT-based FIR filter using external coefficients
 //  _h      : filter coefficients [size: _h_len x 1]
 //  _h_len  : filter length, _h_len > 0
@@ -82,41 +128,137 @@ FFTFILT() FFTFILT(_create)(TC *         _h,
         exit(1);
     }
 
+    return FFTFILT(_create_nfft)(_h, _h_len, _n, 2*_n);
+}
+
+// create FFT-based FIR filter with explicit transform size
+//  _h      : filter coefficients [size: _h_len x 1]
+//  _h_len  : filter length, _h_len > 0
+//  _n      : block size, _n > 0
+//  _nfft   : transform size, _nfft >= _n + _h_len - 1
+FFTFILT() FFTFILT(_create_nfft)(TC *         _h,
+                                unsigned int _h_len,
+                                unsigned int _n,
+                                unsigned int _nfft)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: fftfilt_%s_create_nfft(), filter length must be greater than zero\n",
+                EXTENSION_FULL);
+        exit(1);
+    } else if (_n == 0) {
+        fprintf(stderr,"error: fftfilt_%s_create_nfft(), block length must be greater than zero\n",
+                EXTENSION_FULL);
+        exit(1);
+    } else if (_nfft < _n + _h_len - 1) {
+        fprintf(stderr,"error: fftfilt_%s_create_nfft(), transform size must be at least _n+_h_len-1 (%u)\n",
+                EXTENSION_FULL,
+                _n + _h_len - 1);
+        exit(1);
+    }
+
+    return FFTFILT(_create_internal)(_h, _h_len, _n, _nfft, 0);
+}
+
+// create FFT-based FIR filter using uniformly partitioned convolution
+//  _h      : filter coefficients [size: _h_len x 1]
+//  _h_len  : filter length, _h_len > 0
+//  _n      : block size (latency) and partition length, _n > 0
+FFTFILT() FFTFILT(_create_partitioned)(TC *         _h,
+                                       unsigned int _h_len,
+                                       unsigned int _n)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: fftfilt_%s_create_partitioned(), filter length must be greater than zero\n",
+                EXTENSION_FULL);
+        exit(1);
+    } else if (_n == 0) {
+        fprintf(stderr,"error: fftfilt_%s_create_partitioned(), block length must be greater than zero\n",
+                EXTENSION_FULL);
+        exit(1);
+    }
+
+    return FFTFILT(_create_internal)(_h, _h_len, _n, 2*_n, 1);
+}
+
+// create object (internal)
+FFTFILT() FFTFILT(_create_internal)(TC *         _h,
+                                    unsigned int _h_len,
+                                    unsigned int _n,
+                                    unsigned int _nfft,
+                                    int          _part)
+{
     // create filter object and initialize
-    FFTFILT() q = (FFTFILT()) malloc(sizeof(struct FFTFILT(_s)));
-    q->h_len    = _h_len;
-    q->n        = _n;
+    FFTFILT() q = (FFTFILT()) liquid_malloc(sizeof(struct FFTFILT(_s)));
+    q->h_len       = _h_len;
+    q->n           = _n;
+    q->nfft        = _nfft;
+    q->partitioned = _part;
+    q->num_parts   = _part ? (_h_len + _n - 1) / _n : 1;
+    q->fdl_index   = 0;
+    // overlap-add keeps the transform tail; overlap-save keeps the
+    // previous input block
+    q->w_len       = _part ? _n : _nfft - _n;
+#if TI_COMPLEX
+    q->nfreq    = _nfft;
+#else
+    q->nfreq    = _nfft/2 + 1;
+#endif
 
     // copy filter coefficients
-    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC *) liquid_malloc((q->h_len)*sizeof(TC));
     memmove(q->h, _h, _h_len*sizeof(TC));
 
     // allocate internal memory arrays
-    q->time_buf = (float complex *) malloc((2*q->n)* sizeof(float complex)); // time buffer
-    q->freq_buf = (float complex *) malloc((2*q->n)* sizeof(float complex)); // frequency buffer
-    q->H        = (float complex *) malloc((2*q->n)* sizeof(float complex)); // FFT{ h }
-    q->w        = (float complex *) malloc((  q->n)* sizeof(float complex)); // delay buffer
+#if TI_COMPLEX
+    q->time_buf = (float complex *) liquid_malloc((q->nfft) * sizeof(float complex)); // time buffer
+    q->w        = (float complex *) liquid_malloc((q->w_len)* sizeof(float complex)); // delay buffer
+#else
+    q->time_buf = (float *)         liquid_malloc((q->nfft) * sizeof(float));         // time buffer
+    q->w        = (float *)         liquid_malloc((q->w_len)* sizeof(float));         // delay buffer
+#endif
+    q->freq_buf = (float complex *) liquid_malloc((q->nfreq)*sizeof(float complex)); // frequency buffer
+    q->H        = (float complex *) liquid_malloc((q->num_parts*q->nfreq)*sizeof(float complex)); // FFT{ h }
+    q->fdl      = _part ? (float complex *) liquid_malloc((q->num_parts*q->nfreq)*sizeof(float complex)) : NULL;
 
     // create internal FFT objects
-#ifdef LIQUID_FFTOVERRIDE
-    q->fft  = fft_create_plan(2*q->n, q->time_buf, q->freq_buf, LIQUID_FFT_FORWARD,  0);
-    q->ifft = fft_create_plan(2*q->n, q->freq_buf, q->time_buf, LIQUID_FFT_BACKWARD, 0);
+#if TI_COMPLEX
+#  ifdef LIQUID_FFTOVERRIDE
+    q->fft  = fft_create_plan(q->nfft, q->time_buf, q->freq_buf, LIQUID_FFT_FORWARD,  0);
+    q->ifft = fft_create_plan(q->nfft, q->freq_buf, q->time_buf, LIQUID_FFT_BACKWARD, 0);
+#  else
+    q->fft  = FFT_CREATE_PLAN(q->nfft, q->time_buf, q->freq_buf, FFT_DIR_FORWARD,  FFT_METHOD);
+    q->ifft = FFT_CREATE_PLAN(q->nfft, q->freq_buf, q->time_buf, FFT_DIR_BACKWARD, FFT_METHOD);
+#  endif
 #else
-    q->fft  = FFT_CREATE_PLAN(2*q->n, q->time_buf, q->freq_buf, FFT_DIR_FORWARD,  FFT_METHOD);
-    q->ifft = FFT_CREATE_PLAN(2*q->n, q->freq_buf, q->time_buf, FFT_DIR_BACKWARD, FFT_METHOD);
+#  ifdef LIQUID_FFTOVERRIDE
+    q->fft  = fft_create_plan_r2c_1d(q->nfft, q->time_buf, q->freq_buf, 0);
+    q->ifft = fft_create_plan_c2r_1d(q->nfft, q->freq_buf, q->time_buf, 0);
+#  else
+    q->fft  = FFT_CREATE_PLAN_R2C(q->nfft, q->time_buf, q->freq_buf, FFT_METHOD);
+    q->ifft = FFT_CREATE_PLAN_C2R(q->nfft, q->freq_buf, q->time_buf, FFT_METHOD);
+#  endif
 #endif
 
-    // compute FFT of filter coefficients and copy to internal H array
+    // compute FFT of filter coefficients (one partition at a time,
+    // each zero-padded) and copy to internal H array
+    unsigned int part_len = _part ? q->n : q->h_len;
     unsigned int i;
-    for (i=0; i<2*q->n; i++)
-        q->time_buf[i] = (i < q->h_len) ? q->h[i] : 0;
-    // time_buf > {FFT} > freq_buf
+    unsigned int p;
+    for (p=0; p<q->num_parts; p++) {
+        for (i=0; i<q->nfft; i++) {
+            unsigned int k = p*part_len + i;
+            q->time_buf[i] = (i < part_len && k < q->h_len) ? q->h[k] : 0;
+        }
+        // time_buf > {FFT} > freq_buf
 #ifdef LIQUID_FFTOVERRIDE
-    fft_execute(q->fft);
+        fft_execute(q->fft);
 #else
-    FFT_EXECUTE(q->fft);
+        FFT_EXECUTE(q->fft);
 #endif
-    memmove(q->H, q->freq_buf, 2*q->n*sizeof(float complex));
+        memmove(&q->H[p*q->nfreq], q->freq_buf, q->nfreq*sizeof(float complex));
+    }
 
     // set default scaling
     FFTFILT(_set_scale)(q, 1);
@@ -132,11 +274,12 @@ FFTFILT() FFTFILT(_create)(TC *         _h,
 void FFTFILT(_destroy)(FFTFILT() _q)
 {
     // free internal arrays
-    free(_q->h);                // filter coefficients
-    free(_q->time_buf);         // buffer (time domain)
-    free(_q->freq_buf);         // buffer (frequency domain)
-    free(_q->H);                // frequency response of filter coefficients
-    free(_q->w);                // output window buffer
+    liquid_free(_q->h);                // filter coefficients
+    liquid_free(_q->time_buf);         // buffer (time domain)
+    liquid_free(_q->freq_buf);         // buffer (frequency domain)
+    liquid_free(_q->H);                // frequency response of filter coefficients
+    liquid_free(_q->w);                // output window buffer
+    liquid_free(_q->fdl);              // frequency-domain delay line
 
     // destroy FFT objects
 #ifdef LIQUID_FFTOVERRIDE
@@ -148,7 +291,7 @@ void FFTFILT(_destroy)(FFTFILT() _q)
 #endif
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // reset internal state of filter object
@@ -156,14 +299,21 @@ void FFTFILT(_reset)(FFTFILT() _q)
 {
     // reset overlap window
     unsigned int i;
-    for (i=0; i<_q->n; i++)
+    for (i=0; i<_q->w_len; i++)
         _q->w[i] = 0;
+
+    // reset frequency-domain delay line
+    if (_q->partitioned) {
+        memset(_q->fdl, 0, _q->num_parts*_q->nfreq*sizeof(float complex));
+        _q->fdl_index = 0;
+    }
 }
 
 // print filter object internals (taps, buffer)
 void FFTFILT(_print)(FFTFILT() _q)
 {
-    printf("fftfilt_%s: [h_len=%u, n=%u]\n", EXTENSION_FULL, _q->h_len, _q->n);
+    printf("fftfilt_%s: [h_len=%u, n=%u, nfft=%u, partitions=%u]\n", EXTENSION_FULL,
+            _q->h_len, _q->n, _q->nfft, _q->num_parts);
     unsigned int i;
     unsigned int n = _q->h_len;
     for (i=0; i<n; i++) {
@@ -183,7 +333,7 @@ void FFTFILT(_set_scale)(FFTFILT() _q,
                          TC        _scale)
 {
     // set scale, normalized by fft size
-    _q->scale = _scale / (float)(2*_q->n);
+    _q->scale = _scale / (float)(_q->nfft);
 }
 
 // execute the filter on internal buffer and coefficients
@@ -194,6 +344,11 @@ void FFTFILT(_execute)(FFTFILT() _q,
                        TI *      _x,
                        TO *      _y)
 {
+    if (_q->partitioned) {
+        FFTFILT(_execute_partitioned)(_q, _x, _y);
+        return;
+    }
+
     unsigned int i;
 
     // copy input
@@ -201,7 +356,6 @@ void FFTFILT(_execute)(FFTFILT() _q,
     memmove(_q->time_buf, _x, _q->n*sizeof(TI));
 #else
     // manual copy for type conversion
-    // TODO: use DCT or equivalent
     for (i=0; i<_q->n; i++)
         _q->time_buf[i] = _x[i];
 #endif
@@ -211,8 +365,8 @@ void FFTFILT(_execute)(FFTFILT() _q,
 #if 0
     memset(&_q->time_buf[_q->n], 0, _q->n*sizeof(TI));
 #else
-    for (i=0; i<_q->n; i++)
-        _q->time_buf[_q->n + i] = 0;
+    for (i=_q->n; i<_q->nfft; i++)
+        _q->time_buf[i] = 0;
 #endif
 
     // run forward transform
@@ -224,16 +378,24 @@ void FFTFILT(_execute)(FFTFILT() _q,
 
     // compute inner product between FFT{ _x } and FFT{ H }
 #if 1
-    for (i=0; i<2*_q->n; i++)
-        _q->freq_buf[i] *= _q->H[i];
+    // explicit real arithmetic (avoids the special-value handling of
+    // the C complex product)
+    float * X = (float*) _q->freq_buf;
+    float * H = (float*) _q->H;
+    for (i=0; i<_q->nfreq; i++) {
+        float xr = X[2*i], xi = X[2*i+1];
+        float hr = H[2*i], hi = H[2*i+1];
+        X[2*i  ] = xr*hr - xi*hi;
+        X[2*i+1] = xr*hi + xi*hr;
+    }
 #else
     // use SIMD vector extensions
 # if TI_COMPLEX
     // complex floating-point inner product
-    liquid_vectorcf_mul(_q->freq_buf, _q->H, 2*_q->n, _q->freq_buf);
+    liquid_vectorcf_mul(_q->freq_buf, _q->H, _q->nfreq, _q->freq_buf);
 # else
     // real floating-point inner product
-    liquid_vectorf_mul(_q->freq_buf, _q->H, 2*_q->n, _q->freq_buf);
+    liquid_vectorf_mul(_q->freq_buf, _q->H, _q->nfreq, _q->freq_buf);
 # endif
 #endif
 
@@ -244,19 +406,85 @@ void FFTFILT(_execute)(FFTFILT() _q,
     FFT_EXECUTE(_q->ifft);
 #endif
 
-    // copy output summed with buffer and scaled
-#if TI_COMPLEX
-    for (i=0; i<_q->n; i++)
+    // copy output summed with overlap from previous block(s) and scaled
+    unsigned int k = _q->n < _q->w_len ? _q->n : _q->w_len;
+    for (i=0; i<k; i++)
         _y[i] = (_q->time_buf[i] + _q->w[i]) * _q->scale;
+    for (i=k; i<_q->n; i++)
+        _y[i] = _q->time_buf[i] * _q->scale;
+
+    // update overlap: tail of this block plus the part of the previous
+    // overlap extending beyond this block (only when w_len > n)
+    for (i=0; i<_q->w_len; i++) {
+        _q->w[i] = _q->time_buf[_q->n + i];
+        if (_q->n + i < _q->w_len)
+            _q->w[i] += _q->w[_q->n + i];
+    }
+}
+
+// execute partitioned overlap-save on one block (internal)
+//  _q      : filter object
+//  _x      : pointer to input data array  [size: _n x 1]
+//  _y      : pointer to output data array [size: _n x 1]
+void FFTFILT(_execute_partitioned)(FFTFILT() _q,
+                                   TI *      _x,
+                                   TO *      _y)
+{
+    unsigned int n = _q->n;
+    unsigned int i;
+
+    // time buffer holds previous and current input blocks; save the
+    // current block for the next call
+    for (i=0; i<n; i++) {
+        _q->time_buf[i]   = _q->w[i];
+        _q->time_buf[n+i] = _x[i];
+        _q->w[i]          = _x[i];
+    }
+
+    // run forward transform
+#ifdef LIQUID_FFTOVERRIDE
+    fft_execute(_q->fft);
 #else
-    // manual copy for type conversion
-    // TODO: use DCT or equivalent
-    for (i=0; i<_q->n; i++)
-        _y[i] = (T) crealf(_q->time_buf[i] + _q->w[i]) * _q->scale;
+    FFT_EXECUTE(_q->fft);
 #endif
 
-    // copy buffer
-    memmove(_q->w, &_q->time_buf[_q->n], _q->n*sizeof(float complex));
+    // push spectrum onto frequency-domain delay line (newest first)
+    unsigned int P     = _q->num_parts;
+    unsigned int nfreq = _q->nfreq;
+    _q->fdl_index = (_q->fdl_index + P - 1) % P;
+    memmove(&_q->fdl[_q->fdl_index*nfreq], _q->freq_buf, nfreq*sizeof(float complex));
+
+    // accumulate products of delayed spectra with partition responses;
+    // partition p pairs with the input from p blocks ago
+    float * restrict Y = (float*) _q->freq_buf;
+    memset(Y, 0, nfreq*sizeof(float complex));
+    unsigned int p;
+    for (p=0; p<P; p++) {
+        unsigned int slot = (_q->fdl_index + p) % P;
+        const float * restrict X = (const float*) &_q->fdl[slot*nfreq];
+        const float * restrict H = (const float*) &_q->H[p*nfreq];
+        float * restrict       y = Y;
+        for (i=0; i<nfreq; i++) {
+            float xr = X[0], xi = X[1];
+            float hr = H[0], hi = H[1];
+            y[0] += xr*hr - xi*hi;
+            y[1] += xr*hi + xi*hr;
+            X += 2;
+            H += 2;
+            y += 2;
+        }
+    }
+
+    // compute inverse transform
+#ifdef LIQUID_FFTOVERRIDE
+    fft_execute(_q->ifft);
+#else
+    FFT_EXECUTE(_q->ifft);
+#endif
+
+    // second half of circular convolution is free of wrap-around
+    for (i=0; i<n; i++)
+        _y[i] = _q->time_buf[n+i] * _q->scale;
 }
 
 // return length of filter object's internal coefficients
@@ -265,3 +493,21 @@ unsigned int FFTFILT(_get_length)(FFTFILT() _q)
     return _q->h_len;
 }
 
+// return block size
+unsigned int FFTFILT(_get_block_len)(FFTFILT() _q)
+{
+    return _q->n;
+}
+
+// return transform size
+unsigned int FFTFILT(_get_nfft)(FFTFILT() _q)
+{
+    return _q->nfft;
+}
+
+// return number of partitions (1 unless created partitioned)
+unsigned int FFTFILT(_get_num_partitions)(FFTFILT() _q)
+{
+    return _q->num_parts;
+}
+
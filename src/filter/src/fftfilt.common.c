@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fftfilt.common.c
+//
+// Selection between direct-form and FFT-based FIR filtering
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// largest transform size considered
+#define LIQUID_FFTFILT_SELECT_NFFT_MAX  (1<<16)
+
+// Select between direct-form (firfilt) and FFT-based (fftfilt)
+// filtering; returns 0 if firfilt is preferred, otherwise the block
+// size with the transform size in *_nfft
+//  _h_len          : filter length, _h_len > 0
+//  _max_block_len  : maximum block size (latency budget)
+//  _nfft           : transform size output (power of two)
+unsigned int liquid_fftfilt_select(unsigned int   _h_len,
+                                   unsigned int   _max_block_len,
+                                   unsigned int * _nfft)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: liquid_fftfilt_select(), filter length must be greater than zero\n");
+        exit(1);
+    }
+
+    // direct-form cost per output sample
+    float cost_fir = (float)_h_len;
+
+    // relative cost of one fftfilt butterfly stage per transform
+    // point, in direct-form multiply-accumulate operations (includes
+    // forward/inverse transforms, spectral product and overlap-add);
+    // measured by liquid_autotune()
+    float cost_fft = liquid_autotune_get(LIQUID_AUTOTUNE_FFTFILT_COST);
+
+    // search power-of-two transform sizes; the block size for each is
+    // n = nfft - h_len + 1, so per-sample cost is nfft*log2(nfft)/n
+    unsigned int n_opt    = 0;
+    unsigned int nfft_opt = 0;
+    float        cost_opt = cost_fir;
+    unsigned int nfft;
+    for (nfft=2; nfft <= LIQUID_FFTFILT_SELECT_NFFT_MAX; nfft <<= 1) {
+        if (nfft < _h_len)
+            continue;
+
+        // block size, limited by latency budget
+        unsigned int n = nfft - _h_len + 1;
+        if (n > _max_block_len)
+            break;
+
+        float cost = cost_fft * nfft * log2f((float)nfft) / (float)n;
+        if (cost < cost_opt) {
+            n_opt    = n;
+            nfft_opt = nfft;
+            cost_opt = cost;
+        }
+    }
+
+    if (_nfft != NULL)
+        *_nfft = nfft_opt;
+
+    return n_opt;
+}
+
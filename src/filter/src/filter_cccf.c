@@ -46,6 +46,7 @@
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_cccf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_cccf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_cccf,name)
+#define RRESAMP(name)       LIQUID_CONCAT(rresamp_cccf,name)
 //#define SYMSYNC(name)       LIQUID_CONCAT(symsync_cccf,name)
 
 #define T                   float complex   // general
@@ -54,6 +55,7 @@
 #define TI                  float complex   // input
 #define WINDOW(name)        LIQUID_CONCAT(windowcf,name)
 #define DOTPROD(name)       LIQUID_CONCAT(dotprod_cccf,name)
+#define DOTPROD_F16(name)   LIQUID_CONCAT(dotprod_ccch,name)
 #define POLY(name)          LIQUID_CONCAT(polyf,name)
 
 #define TO_COMPLEX          1
@@ -80,4 +82,5 @@
 #include "msresamp2.c"
 #include "resamp.c"
 #include "resamp2.c"
+#include "rresamp.c"
 //#include "symsync.c"
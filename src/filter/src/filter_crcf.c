@@ -41,11 +41,14 @@
 #define IIRDECIM(name)      LIQUID_CONCAT(iirdecim_crcf,name)
 #define IIRFILT(name)       LIQUID_CONCAT(iirfilt_crcf,name)
 #define IIRFILTSOS(name)    LIQUID_CONCAT(iirfiltsos_crcf,name)
+#define IIRFILTMC(name)     LIQUID_CONCAT(iirfiltmc_crcf,name)
 #define IIRINTERP(name)     LIQUID_CONCAT(iirinterp_crcf,name)
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_crcf,name)
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_crcf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_crcf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_crcf,name)
+#define RESAMPFARROW(name)  LIQUID_CONCAT(resamp_farrow_crcf,name)
+#define RRESAMP(name)       LIQUID_CONCAT(rresamp_crcf,name)
 #define SYMSYNC(name)       LIQUID_CONCAT(symsync_crcf,name)
 
 #define T                   float complex   // general
@@ -54,6 +57,7 @@
 #define TI                  float complex   // input
 #define WINDOW(name)        LIQUID_CONCAT(windowcf,name)
 #define DOTPROD(name)       LIQUID_CONCAT(dotprod_crcf,name)
+#define DOTPROD_F16(name)   LIQUID_CONCAT(dotprod_crch,name)
 #define POLY(name)          LIQUID_CONCAT(polyf,name)
 
 #define TO_COMPLEX          1
@@ -75,10 +79,12 @@
 #include "iirdecim.c"
 #include "iirfilt.c"
 #include "iirfiltsos.c"
+#include "iirfiltmc.c"        // real coefficients only
 #include "iirinterp.c"
 #include "msresamp.c"
 #include "msresamp2.c"
 #include "resamp.c"         // floating-point phase version
-//#include "resamp.fixed.c" // fixed-point phase version
 #include "resamp2.c"
+#include "resamp_farrow.c"
+#include "rresamp.c"
 #include "symsync.c"
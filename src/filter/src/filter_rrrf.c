@@ -42,11 +42,14 @@
 #define IIRDECIM(name)      LIQUID_CONCAT(iirdecim_rrrf,name)
 #define IIRFILT(name)       LIQUID_CONCAT(iirfilt_rrrf,name)
 #define IIRFILTSOS(name)    LIQUID_CONCAT(iirfiltsos_rrrf,name)
+#define IIRFILTMC(name)     LIQUID_CONCAT(iirfiltmc_rrrf,name)
 #define IIRINTERP(name)     LIQUID_CONCAT(iirinterp_rrrf,name)
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_rrrf,name)
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_rrrf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_rrrf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_rrrf,name)
+#define RESAMPFARROW(name)  LIQUID_CONCAT(resamp_farrow_rrrf,name)
+#define RRESAMP(name)       LIQUID_CONCAT(rresamp_rrrf,name)
 #define SYMSYNC(name)       LIQUID_CONCAT(symsync_rrrf,name)
 
 #define T                   float   // general
@@ -55,6 +58,7 @@
 #define TI                  float   // input
 #define WINDOW(name)        LIQUID_CONCAT(windowf,name)
 #define DOTPROD(name)       LIQUID_CONCAT(dotprod_rrrf,name)
+#define DOTPROD_F16(name)   LIQUID_CONCAT(dotprod_rrrh,name)
 #define POLY(name)          LIQUID_CONCAT(polyf,name)
 
 #define TO_COMPLEX          0
@@ -77,9 +81,12 @@
 #include "iirdecim.c"
 #include "iirfilt.c"
 #include "iirfiltsos.c"
+#include "iirfiltmc.c"        // real coefficients only
 #include "iirinterp.c"
 #include "msresamp.c"
 #include "msresamp2.c"
 #include "resamp.c"
 #include "resamp2.c"
+#include "resamp_farrow.c"
+#include "rresamp.c"
 #include "symsync.c"
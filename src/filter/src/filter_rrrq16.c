@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Filter API: 16-bit fixed-point (Q15)
+//
+
+#include "liquid.internal.h"
+
+// naming extensions (useful for print statements)
+#define EXTENSION_FULL      "rrrq16"
+
+#define FIRFILT(name)       LIQUID_CONCAT(firfilt_rrrq16,name)
+#define FIRINTERP(name)     LIQUID_CONCAT(firinterp_rrrq16,name)
+#define RESAMP(name)        LIQUID_CONCAT(resamp_rrrq16,name)
+
+#define TO                  q16_t   // output
+#define TC                  q16_t   // coefficients
+#define TI                  q16_t   // input
+#define DOTPROD(name)       LIQUID_CONCAT(dotprod_rrrq16,name)
+
+#define TO_COMPLEX          0
+
+// source files
+#include "firfilt.q16.c"
+#include "firinterp.q16.c"
+#include "resamp.fixed.c"
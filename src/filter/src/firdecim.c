@@ -30,14 +30,36 @@
 #include <stdlib.h>
 #include <string.h>
 
+// smallest decimation factor for which execute_block() computes each
+// output directly from the input; below it, consecutive outputs of
+// polyphase components share vector loads and are faster
+#define LIQUID_FIRDECIM_DIRECT_MIN  (3)
+
+// maximum number of outputs computed at once by the polyphase path
+#define LIQUID_FIRDECIM_BLOCK_LEN   (32)
+
 // decimator structure
 struct FIRDECIM(_s) {
     TC * h;             // coefficients array
     unsigned int h_len; // number of coefficients
     unsigned int M;     // decimation factor
+    float delay;        // prototype filter delay (output samples)
 
     WINDOW() w;         // buffer
     DOTPROD() dp;       // vector dot product
+
+    // block execution: outputs are computed straight from the input
+    // block; only those whose window reaches back into the buffer
+    // history use the span
+    TI * span;          // history and input [size: h_len-1 + max(h_len-1, BLOCK_LEN*M) x 1]
+
+    // polyphase block execution (M < LIQUID_FIRDECIM_DIRECT_MIN): the
+    // filter is split into M polyphase components so that each one
+    // computes consecutive outputs from a unit-stride input sequence
+    unsigned int P;     // polyphase component length, ceil(h_len/M)
+    TC * g;             // polyphase coefficients (zero-padded) [size: M x P]
+    TI * xp;            // polyphase input [size: BLOCK_LEN + P-1 x 1]
+    TO * yp;            // polyphase output [size: BLOCK_LEN x 1]
 };
 
 // create decimator object
@@ -57,12 +79,13 @@ FIRDECIM() FIRDECIM(_create)(unsigned int _M,
         exit(1);
     }
 
-    FIRDECIM() q = (FIRDECIM()) malloc(sizeof(struct FIRDECIM(_s)));
+    FIRDECIM() q = (FIRDECIM()) liquid_malloc(sizeof(struct FIRDECIM(_s)));
     q->h_len = _h_len;
     q->M     = _M;
+    q->delay = 0.5f*(float)(_h_len-1) / (float)_M;
 
     // allocate memory for coefficients
-    q->h = (TC*) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC*) liquid_malloc((q->h_len)*sizeof(TC));
 
     // load filter in reverse order
     unsigned int i;
@@ -75,6 +98,29 @@ FIRDECIM() FIRDECIM(_create)(unsigned int _M,
     // create dot product object
     q->dp = DOTPROD(_create)(q->h, q->h_len);
 
+    // allocate block execution buffers
+    unsigned int span_len = q->h_len - 1 > LIQUID_FIRDECIM_BLOCK_LEN*q->M ?
+                            q->h_len - 1 : LIQUID_FIRDECIM_BLOCK_LEN*q->M;
+    q->span = (TI*) liquid_malloc((q->h_len - 1 + span_len)*sizeof(TI));
+    if (q->M < LIQUID_FIRDECIM_DIRECT_MIN) {
+        // split reversed coefficients into polyphase components,
+        //  g[r*P + p] = h[p*M + r]
+        q->P = (q->h_len + q->M - 1) / q->M;
+        q->g = (TC*) liquid_malloc(q->M*q->P*sizeof(TC));
+        unsigned int r, p;
+        for (r=0; r<q->M; r++) {
+            for (p=0; p<q->P; p++)
+                q->g[r*q->P + p] = p*q->M + r < q->h_len ? q->h[p*q->M + r] : 0;
+        }
+        q->xp = (TI*) liquid_malloc((LIQUID_FIRDECIM_BLOCK_LEN + q->P - 1)*sizeof(TI));
+        q->yp = (TO*) liquid_malloc(LIQUID_FIRDECIM_BLOCK_LEN*sizeof(TO));
+    } else {
+        q->P  = 0;
+        q->g  = NULL;
+        q->xp = NULL;
+        q->yp = NULL;
+    }
+
     // reset filter state (clear buffer)
     FIRDECIM(_clear)(q);
 
@@ -113,8 +159,11 @@ FIRDECIM() FIRDECIM(_create_kaiser)(unsigned int _M,
     for (i=0; i<h_len; i++)
         hc[i] = hf[i];
     
-    // return decimator object
-    return FIRDECIM(_create)(_M, hc, 2*_M*_m);
+    // create decimator object; the prototype is truncated by one
+    // sample, so the delay is that of the original filter
+    FIRDECIM() q = FIRDECIM(_create)(_M, hc, 2*_M*_m);
+    q->delay = (float)_m;
+    return q;
 }
 
 // create square-root Nyquist decimator
@@ -164,8 +213,12 @@ void FIRDECIM(_destroy)(FIRDECIM() _q)
 {
     WINDOW(_destroy)(_q->w);
     DOTPROD(_destroy)(_q->dp);
-    free(_q->h);
-    free(_q);
+    liquid_free(_q->span);
+    liquid_free(_q->g);
+    liquid_free(_q->xp);
+    liquid_free(_q->yp);
+    liquid_free(_q->h);
+    liquid_free(_q);
 }
 
 // print decimator object internals
@@ -182,6 +235,13 @@ void FIRDECIM(_clear)(FIRDECIM() _q)
     WINDOW(_clear)(_q->w);
 }
 
+// get decimator delay (output samples), relative to the first
+// input sample of each block
+float FIRDECIM(_get_delay)(FIRDECIM() _q)
+{
+    return _q->delay;
+}
+
 // execute decimator
 //  _q      :   decimator object
 //  _x      :   input sample array [size: _M x 1]
@@ -205,7 +265,51 @@ void FIRDECIM(_execute)(FIRDECIM() _q,
     }
 }
 
-// execute decimator on block of _n*_M input samples
+// execute decimator on block of _n*_M input samples using polyphase
+// components (small decimation factors)
+static void FIRDECIM(_execute_block_polyphase)(FIRDECIM()   _q,
+                                               TI *         _x,
+                                               unsigned int _n,
+                                               TO *         _y)
+{
+    TI * r; // read pointer
+    unsigned int i, k, m, p;
+    for (i=0; i<_n; i+=LIQUID_FIRDECIM_BLOCK_LEN) {
+        // number of outputs in this block
+        unsigned int num = _n - i < LIQUID_FIRDECIM_BLOCK_LEN ? _n - i : LIQUID_FIRDECIM_BLOCK_LEN;
+        unsigned int nx  = num*_q->M;
+
+        // assemble contiguous span: buffer history followed by input
+        WINDOW(_read)(_q->w, &r);
+        memmove(_q->span, r+1, (_q->h_len-1)*sizeof(TI));
+        memmove(_q->span + _q->h_len - 1, &_x[i*_q->M], nx*sizeof(TI));
+
+        // output k is computed after pushing input sample k*M,
+        //  y[k] = sum_r sum_p g[r*P+p] span[(k+p)*M + r]
+        for (p=0; p<_q->M; p++) {
+            // gather unit-stride input for polyphase component p
+            for (m=0; m<num + _q->P - 1; m++)
+                _q->xp[m] = _q->span[m*_q->M + p];
+
+            if (p == 0) {
+                DOTPROD(_run_block)(_q->g, _q->P, _q->xp, 1, num, &_y[i]);
+            } else {
+                DOTPROD(_run_block)(&_q->g[p*_q->P], _q->P, _q->xp, 1, num, _q->yp);
+                for (k=0; k<num; k++)
+                    _y[i+k] += _q->yp[k];
+            }
+        }
+
+        // only the most recent h_len samples are retained in the buffer
+        unsigned int nw = nx < _q->h_len ? nx : _q->h_len;
+        WINDOW(_write)(_q->w, _q->span + _q->h_len - 1 + nx - nw, nw);
+    }
+}
+
+// execute decimator on block of _n*_M input samples; output k is
+// computed over the h_len input samples ending with sample k*M, read
+// directly from _x once the window lies within it, so that discarded
+// phases cost nothing and the input is not staged through the buffer
 //  _q      : decimator object
 //  _x      : input array [size: _n*_M x 1]
 //  _n      : number of _output_ samples
@@ -215,10 +319,36 @@ void FIRDECIM(_execute_block)(FIRDECIM()   _q,
                               unsigned int _n,
                               TO *         _y)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
-        // execute _M input samples computing just one output each time
-        FIRDECIM(_execute)(_q, &_x[i*_q->M], &_y[i]);
+    if (_q->M < LIQUID_FIRDECIM_DIRECT_MIN) {
+        FIRDECIM(_execute_block_polyphase)(_q, _x, _n, _y);
+        return;
+    } else if (_n == 0) {
+        return;
     }
-}
 
+    unsigned int M  = _q->M;
+    unsigned int L  = _q->h_len;
+    unsigned int nx = _n*M;
+
+    // outputs whose window reaches back into the history: assemble
+    // history followed by the leading input samples they need
+    unsigned int nh = (L - 1 + M - 1) / M;
+    nh = nh < _n ? nh : _n;
+    unsigned int k;
+    if (nh > 0) {
+        TI * r; // read pointer
+        WINDOW(_read)(_q->w, &r);
+        memmove(_q->span,         r+1, (L-1)*sizeof(TI));
+        memmove(_q->span + L - 1, _x,  ((nh-1)*M + 1)*sizeof(TI));
+        for (k=0; k<nh; k++)
+            DOTPROD(_execute)(_q->dp, &_q->span[k*M], &_y[k]);
+    }
+
+    // remaining outputs straight from the input
+    for (k=nh; k<_n; k++)
+        DOTPROD(_execute)(_q->dp, &_x[k*M + 1 - L], &_y[k]);
+
+    // only the most recent h_len samples are retained in the buffer
+    unsigned int nw = nx < L ? nx : L;
+    WINDOW(_write)(_q->w, &_x[nx - nw], nw);
+}
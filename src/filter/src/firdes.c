@@ -262,22 +262,20 @@ void liquid_firdes_kaiser(unsigned int _n,
     // choose kaiser beta parameter (approximate)
     float beta = kaiser_beta_As(_As);
 
-    float t, h1, h2; 
+    // sinc prototype
+    float x[_n];
     unsigned int i;
-    for (i=0; i<_n; i++) {
-        t = (float)i - (float)(_n-1)/2 + _mu;
-     
-        // sinc prototype
-        h1 = sincf(2.0f*_fc*t);
-
-        // kaiser window
-        h2 = kaiser(i,_n,beta,_mu);
+    for (i=0; i<_n; i++)
+        x[i] = 2.0f*_fc*((float)i - (float)(_n-1)/2 + _mu);
+    sincf_block(x, _n, _h);
 
-        //printf("t = %f, h1 = %f, h2 = %f\n", t, h1, h2);
+    // kaiser window
+    float w[_n];
+    liquid_kaiser_window(_n, beta, _mu, w);
 
-        // composite
-        _h[i] = h1*h2;
-    }
+    // composite
+    for (i=0; i<_n; i++)
+        _h[i] *= w[i];
 }
 
 // Design (root-)Nyquist filter from prototype
@@ -296,6 +294,12 @@ void liquid_firdes_prototype(liquid_firfilt_type _type,
 {
     // compute filter parameters
     unsigned int h_len = 2*_k*_m + 1;   // length
+
+    // check filter design cache
+    float key[5] = {(float)_type, (float)_k, (float)_m, _beta, _dt};
+    if (liquid_firdes_cache_lookup(LIQUID_FIRDES_CACHE_PROTOTYPE, key, 5, _h, h_len))
+        return;
+
     float fc = 0.5f / (float)_k;        // cut-off frequency
     float df = _beta / (float)_k;       // transition bandwidth
     float As = estimate_req_filter_As(df,h_len);   // stop-band attenuation
@@ -367,6 +371,9 @@ void liquid_firdes_prototype(liquid_firfilt_type _type,
         fprintf(stderr,"error: liquid_firdes_prototype(), invalid root-Nyquist filter type '%d'\n", _type);
         exit(1);
     }
+
+    // store result in filter design cache
+    liquid_firdes_cache_insert(LIQUID_FIRDES_CACHE_PROTOTYPE, key, 5, _h, h_len);
 }
 
 
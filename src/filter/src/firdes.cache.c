@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Filter design cache
+//
+// Opt-in store of filter design results keyed by the designer and its
+// full parameter set. Keys and coefficients are compared and stored
+// bit-exactly so that a cached design is indistinguishable from a
+// fresh one. All access is serialized with a mutex when POSIX threads
+// are available.
+//
+// The on-disk form is a text file with one entry per record:
+//
+//      # liquid firdes cache v1
+//      <designer> <key length> <filter length>
+//      <key values>
+//      <coefficients>
+//
+// with values written as hexadecimal floating-point so that they are
+// restored exactly.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+static pthread_mutex_t liquid_firdes_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LIQUID_FIRDES_CACHE_LOCK()   pthread_mutex_lock(&liquid_firdes_cache_mutex)
+#define LIQUID_FIRDES_CACHE_UNLOCK() pthread_mutex_unlock(&liquid_firdes_cache_mutex)
+#else
+#define LIQUID_FIRDES_CACHE_LOCK()
+#define LIQUID_FIRDES_CACHE_UNLOCK()
+#endif
+
+#define LIQUID_FIRDES_CACHE_HEADER "# liquid firdes cache v1"
+
+struct liquid_firdes_cache_entry_s {
+    int          designer;  // designer identifier
+    unsigned int key_len;   // number of key values
+    unsigned int h_len;     // number of filter coefficients
+    float *      key;       // design parameters [size: key_len x 1]
+    float *      h;         // filter coefficients [size: h_len x 1]
+};
+
+static int          liquid_firdes_cache_enabled     = 0;
+static unsigned int liquid_firdes_cache_num_entries = 0;
+static unsigned int liquid_firdes_cache_capacity    = 0;
+static struct liquid_firdes_cache_entry_s * liquid_firdes_cache_entries = NULL;
+
+// find entry matching designer and key; cache must be locked
+static struct liquid_firdes_cache_entry_s * liquid_firdes_cache_find(int           _designer,
+                                                                     const float * _key,
+                                                                     unsigned int  _key_len,
+                                                                     unsigned int  _h_len)
+{
+    unsigned int i;
+    for (i=0; i<liquid_firdes_cache_num_entries; i++) {
+        struct liquid_firdes_cache_entry_s * e = &liquid_firdes_cache_entries[i];
+        if (e->designer == _designer &&
+            e->key_len  == _key_len  &&
+            e->h_len    == _h_len    &&
+            memcmp(e->key, _key, _key_len*sizeof(float)) == 0)
+        {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+// append entry to cache if not already present; cache must be locked
+static void liquid_firdes_cache_append(int           _designer,
+                                       const float * _key,
+                                       unsigned int  _key_len,
+                                       const float * _h,
+                                       unsigned int  _h_len)
+{
+    if (liquid_firdes_cache_find(_designer, _key, _key_len, _h_len) != NULL)
+        return;
+
+    // grow entries array as needed
+    if (liquid_firdes_cache_num_entries == liquid_firdes_cache_capacity) {
+        liquid_firdes_cache_capacity = liquid_firdes_cache_capacity ? 2*liquid_firdes_cache_capacity : 16;
+        liquid_firdes_cache_entries = (struct liquid_firdes_cache_entry_s *)
+            liquid_realloc(liquid_firdes_cache_entries,
+                    liquid_firdes_cache_capacity*sizeof(struct liquid_firdes_cache_entry_s));
+    }
+
+    struct liquid_firdes_cache_entry_s * e = &liquid_firdes_cache_entries[liquid_firdes_cache_num_entries++];
+    e->designer = _designer;
+    e->key_len  = _key_len;
+    e->h_len    = _h_len;
+    e->key      = (float*) liquid_malloc(_key_len*sizeof(float));
+    e->h        = (float*) liquid_malloc(_h_len*sizeof(float));
+    memmove(e->key, _key, _key_len*sizeof(float));
+    memmove(e->h,   _h,   _h_len*sizeof(float));
+}
+
+// enable filter design cache
+void liquid_firdes_cache_enable()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    liquid_firdes_cache_enabled = 1;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+}
+
+// disable filter design cache (entries are retained)
+void liquid_firdes_cache_disable()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    liquid_firdes_cache_enabled = 0;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+}
+
+// is filter design cache enabled?
+int liquid_firdes_cache_is_enabled()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    int enabled = liquid_firdes_cache_enabled;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    return enabled;
+}
+
+// remove all entries from filter design cache, freeing memory
+void liquid_firdes_cache_clear()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    unsigned int i;
+    for (i=0; i<liquid_firdes_cache_num_entries; i++) {
+        liquid_free(liquid_firdes_cache_entries[i].key);
+        liquid_free(liquid_firdes_cache_entries[i].h);
+    }
+    liquid_free(liquid_firdes_cache_entries);
+    liquid_firdes_cache_entries     = NULL;
+    liquid_firdes_cache_num_entries = 0;
+    liquid_firdes_cache_capacity    = 0;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+}
+
+// get number of entries in filter design cache
+unsigned int liquid_firdes_cache_get_num_entries()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    unsigned int n = liquid_firdes_cache_num_entries;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    return n;
+}
+
+// save filter design cache to file, returning 0 on success
+int liquid_firdes_cache_save(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"w");
+    if (fid == NULL) {
+        fprintf(stderr,"error: liquid_firdes_cache_save(), could not open '%s' for writing\n", _filename);
+        return -1;
+    }
+
+    LIQUID_FIRDES_CACHE_LOCK();
+    fprintf(fid,"%s\n", LIQUID_FIRDES_CACHE_HEADER);
+    unsigned int i, j;
+    for (i=0; i<liquid_firdes_cache_num_entries; i++) {
+        struct liquid_firdes_cache_entry_s * e = &liquid_firdes_cache_entries[i];
+        fprintf(fid,"%d %u %u\n", e->designer, e->key_len, e->h_len);
+        for (j=0; j<e->key_len; j++)
+            fprintf(fid,"%a%c", e->key[j], j+1 == e->key_len ? '\n' : ' ');
+        for (j=0; j<e->h_len; j++)
+            fprintf(fid,"%a%c", e->h[j], j+1 == e->h_len ? '\n' : ' ');
+    }
+    LIQUID_FIRDES_CACHE_UNLOCK();
+
+    int rc = ferror(fid) ? -1 : 0;
+    fclose(fid);
+    return rc;
+}
+
+// load entries from file into filter design cache, returning 0 on
+// success; entries already present are kept
+int liquid_firdes_cache_load(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"r");
+    if (fid == NULL) {
+        fprintf(stderr,"error: liquid_firdes_cache_load(), could not open '%s' for reading\n", _filename);
+        return -1;
+    }
+
+    char header[64];
+    if (fgets(header, sizeof(header), fid) == NULL ||
+        strncmp(header, LIQUID_FIRDES_CACHE_HEADER, strlen(LIQUID_FIRDES_CACHE_HEADER)) != 0)
+    {
+        fprintf(stderr,"error: liquid_firdes_cache_load(), '%s' is not a filter design cache\n", _filename);
+        fclose(fid);
+        return -1;
+    }
+
+    int rc = 0;
+    int designer;
+    unsigned int key_len, h_len;
+    LIQUID_FIRDES_CACHE_LOCK();
+    while (fscanf(fid,"%d %u %u", &designer, &key_len, &h_len) == 3) {
+        if (key_len == 0 || h_len == 0 || key_len > 4096 || h_len > (1<<20)) {
+            rc = -1;
+            break;
+        }
+        float * v = (float*) liquid_malloc((key_len + h_len)*sizeof(float));
+        unsigned int j;
+        for (j=0; j<key_len+h_len; j++) {
+            if (fscanf(fid,"%a", &v[j]) != 1)
+                break;
+        }
+        if (j == key_len+h_len)
+            liquid_firdes_cache_append(designer, v, key_len, v+key_len, h_len);
+        liquid_free(v);
+        if (j != key_len+h_len) {
+            rc = -1;
+            break;
+        }
+    }
+    if (!rc && !feof(fid))
+        rc = -1;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    fclose(fid);
+
+    if (rc)
+        fprintf(stderr,"error: liquid_firdes_cache_load(), '%s' is malformed\n", _filename);
+    return rc;
+}
+
+// look up filter design, copying coefficients to _h and returning 1
+// if the cache is enabled and holds a matching entry, 0 otherwise
+int liquid_firdes_cache_lookup(int           _designer,
+                               const float * _key,
+                               unsigned int  _key_len,
+                               float *       _h,
+                               unsigned int  _h_len)
+{
+    int hit = 0;
+    LIQUID_FIRDES_CACHE_LOCK();
+    if (liquid_firdes_cache_enabled) {
+        struct liquid_firdes_cache_entry_s * e = liquid_firdes_cache_find(_designer, _key, _key_len, _h_len);
+        if (e != NULL) {
+            memmove(_h, e->h, _h_len*sizeof(float));
+            hit = 1;
+        }
+    }
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    return hit;
+}
+
+// store filter design if the cache is enabled
+void liquid_firdes_cache_insert(int           _designer,
+                                const float * _key,
+                                unsigned int  _key_len,
+                                const float * _h,
+                                unsigned int  _h_len)
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    if (liquid_firdes_cache_enabled)
+        liquid_firdes_cache_append(_designer, _key, _key_len, _h, _h_len);
+    LIQUID_FIRDES_CACHE_UNLOCK();
+}
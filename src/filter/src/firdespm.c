@@ -88,13 +88,18 @@ struct firdespm_s {
     double * D;                 // desired response
     double * W;                 // weight
     double * E;                 // error
+    double * X;                 // Chebyshev grid : cos(2*pi*F)
 
     double * x;                 // Chebyshev points : cos(2*pi*f)
-    double * alpha;             // Lagrange interpolating polynomial
+    double * alpha;             // barycentric weights (unnormalized)
     double * c;                 // interpolants
     double rho;                 // extremal weighted error
 
     unsigned int * iext;        // indices of extrema
+    unsigned int * iext_interp; // extrema for which x, alpha are valid
+    int interp_valid;           // x, alpha computed at least once
+    double * x_tmp;             // Chebyshev points (weight update)
+    double * alpha_tmp;         // barycentric weights (weight update)
     unsigned int num_exchanges; // number of changes in extrema
 
 #if LIQUID_FIRDESPM_DEBUG
@@ -121,6 +126,24 @@ void firdespm_run(unsigned int _h_len,
                   liquid_firdespm_btype _btype,
                   float * _h)
 {
+    // check filter design cache, keyed by all design parameters:
+    // {h_len, num_bands, btype, bands, des, weights, wtype}
+    unsigned int key_len = 3 + 5*_num_bands;
+    float key[key_len];
+    unsigned int i;
+    key[0] = (float)_h_len;
+    key[1] = (float)_num_bands;
+    key[2] = (float)_btype;
+    for (i=0; i<_num_bands; i++) {
+        key[3 + 2*i + 0]             = _bands[2*i+0];
+        key[3 + 2*i + 1]             = _bands[2*i+1];
+        key[3 + 2*_num_bands + i]    = _des[i];
+        key[3 + 3*_num_bands + i]    = _weights == NULL ? 1.0f : _weights[i];
+        key[3 + 4*_num_bands + i]    = _wtype == NULL ? (float)LIQUID_FIRDESPM_FLATWEIGHT : (float)_wtype[i];
+    }
+    if (liquid_firdes_cache_lookup(LIQUID_FIRDES_CACHE_FIRDESPM, key, key_len, _h, _h_len))
+        return;
+
     // create object
     firdespm q = firdespm_create(_h_len,_num_bands,_bands,_des,_weights,_wtype,_btype);
 
@@ -129,6 +152,9 @@ void firdespm_run(unsigned int _h_len,
 
     // destroy
     firdespm_destroy(q);
+
+    // store result in filter design cache
+    liquid_firdes_cache_insert(LIQUID_FIRDES_CACHE_FIRDESPM, key, key_len, _h, _h_len);
 }
 
 // create firdespm object
@@ -174,7 +200,7 @@ firdespm firdespm_create(unsigned int _h_len,
     }
 
     // create object
-    firdespm q = (firdespm) malloc(sizeof(struct firdespm_s));
+    firdespm q = (firdespm) liquid_malloc(sizeof(struct firdespm_s));
 
     // compute number of extremal frequencies
     q->h_len = _h_len;              // filter length
@@ -184,19 +210,23 @@ firdespm firdespm_create(unsigned int _h_len,
     q->btype = _btype;              // set band type
 
     // allocate memory for extremal frequency set, interpolating polynomial
-    q->iext  = (unsigned int*) malloc((q->r+1)*sizeof(unsigned int));
-    q->x     = (double*) malloc((q->r+1)*sizeof(double));
-    q->alpha = (double*) malloc((q->r+1)*sizeof(double));
-    q->c     = (double*) malloc((q->r+1)*sizeof(double));
+    q->iext  = (unsigned int*) liquid_malloc((q->r+1)*sizeof(unsigned int));
+    q->x     = (double*) liquid_malloc((q->r+1)*sizeof(double));
+    q->alpha = (double*) liquid_malloc((q->r+1)*sizeof(double));
+    q->c     = (double*) liquid_malloc((q->r+1)*sizeof(double));
+    q->iext_interp  = (unsigned int*) liquid_malloc((q->r+1)*sizeof(unsigned int));
+    q->x_tmp        = (double*) liquid_malloc((q->r+1)*sizeof(double));
+    q->alpha_tmp    = (double*) liquid_malloc((q->r+1)*sizeof(double));
+    q->interp_valid = 0;
 
     // allocate memory for arrays
     q->num_bands = _num_bands;
-    q->bands    = (double*) malloc(2*q->num_bands*sizeof(double));
-    q->des      = (double*) malloc(  q->num_bands*sizeof(double));
-    q->weights  = (double*) malloc(  q->num_bands*sizeof(double));
+    q->bands    = (double*) liquid_malloc(2*q->num_bands*sizeof(double));
+    q->des      = (double*) liquid_malloc(  q->num_bands*sizeof(double));
+    q->weights  = (double*) liquid_malloc(  q->num_bands*sizeof(double));
 
     // allocate memory for weighting types
-    q->wtype = (liquid_firdespm_wtype*) malloc(q->num_bands*sizeof(liquid_firdespm_wtype));
+    q->wtype = (liquid_firdespm_wtype*) liquid_malloc(q->num_bands*sizeof(liquid_firdespm_wtype));
     if (_wtype == NULL) {
         // set to default (LIQUID_FIRDESPM_FLATWEIGHT)
         for (i=0; i<q->num_bands; i++)
@@ -232,10 +262,11 @@ firdespm firdespm_create(unsigned int _h_len,
     }
 
     // create the grid
-    q->F = (double*) malloc(q->grid_size*sizeof(double));
-    q->D = (double*) malloc(q->grid_size*sizeof(double));
-    q->W = (double*) malloc(q->grid_size*sizeof(double));
-    q->E = (double*) malloc(q->grid_size*sizeof(double));
+    q->F = (double*) liquid_malloc(q->grid_size*sizeof(double));
+    q->D = (double*) liquid_malloc(q->grid_size*sizeof(double));
+    q->W = (double*) liquid_malloc(q->grid_size*sizeof(double));
+    q->E = (double*) liquid_malloc(q->grid_size*sizeof(double));
+    q->X = (double*) liquid_malloc(q->grid_size*sizeof(double));
     firdespm_init_grid(q);
     // TODO : fix grid, weights according to filter type
 
@@ -251,25 +282,29 @@ void firdespm_destroy(firdespm _q)
 #endif
 
     // free memory for extremal frequency set, interpolating polynomial
-    free(_q->iext);
-    free(_q->x);
-    free(_q->alpha);
-    free(_q->c);
+    liquid_free(_q->iext);
+    liquid_free(_q->x);
+    liquid_free(_q->alpha);
+    liquid_free(_q->c);
+    liquid_free(_q->iext_interp);
+    liquid_free(_q->x_tmp);
+    liquid_free(_q->alpha_tmp);
 
     // free dense grid elements
-    free(_q->F);
-    free(_q->D);
-    free(_q->W);
-    free(_q->E);
+    liquid_free(_q->F);
+    liquid_free(_q->D);
+    liquid_free(_q->W);
+    liquid_free(_q->E);
+    liquid_free(_q->X);
 
     // free band description elements
-    free(_q->bands);
-    free(_q->des);
-    free(_q->weights);
-    free(_q->wtype);
+    liquid_free(_q->bands);
+    liquid_free(_q->des);
+    liquid_free(_q->weights);
+    liquid_free(_q->wtype);
 
     // free object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print firdespm object internals
@@ -300,16 +335,55 @@ void firdespm_print(firdespm _q)
 
 // execute filter design, storing result in _h
 void firdespm_execute(firdespm _q, float * _h)
+{
+    firdespm_execute_warm(_q, NULL, _h);
+}
+
+// execute filter design starting from a previous extremal set, e.g.
+// from a similar design, storing result in _h
+//  _q      :   firdespm object
+//  _fext   :   initial extremal frequencies (NULL for default guess)
+//              [size: (_h_len+1)/2 + 1 x 1]
+//  _h      :   output coefficients array [size: _h_len x 1]
+void firdespm_execute_warm(firdespm _q,
+                           float *  _fext,
+                           float *  _h)
 {
     unsigned int i;
 
-    // initial guess of extremal frequencies evenly spaced on F
-    // TODO : guarantee at least one extremal frequency lies in each band
-    for (i=0; i<_q->r+1; i++) {
-        _q->iext[i] = (i * (_q->grid_size-1)) / _q->r;
+    if (_fext == NULL) {
+        // initial guess of extremal frequencies evenly spaced on F
+        // TODO : guarantee at least one extremal frequency lies in each band
+        for (i=0; i<_q->r+1; i++) {
+            _q->iext[i] = (i * (_q->grid_size-1)) / _q->r;
 #if LIQUID_FIRDESPM_DEBUG_PRINT
-        printf("iext_guess[%3u] = %u\n", i, _q->iext[i]);
+            printf("iext_guess[%3u] = %u\n", i, _q->iext[i]);
 #endif
+        }
+    } else {
+        // map frequencies onto nearest grid points (F is non-decreasing)
+        for (i=0; i<_q->r+1; i++) {
+            unsigned int i0 = 0;
+            unsigned int i1 = _q->grid_size-1;
+            while (i1 - i0 > 1) {
+                unsigned int im = (i0 + i1) / 2;
+                if (_q->F[im] < _fext[i]) i0 = im;
+                else                      i1 = im;
+            }
+            _q->iext[i] = fabs(_q->F[i0]-_fext[i]) <= fabs(_q->F[i1]-_fext[i]) ? i0 : i1;
+        }
+
+        // ensure indices are strictly increasing and fit on the grid
+        for (i=1; i<_q->r+1; i++) {
+            if (_q->iext[i] <= _q->iext[i-1])
+                _q->iext[i] = _q->iext[i-1] + 1;
+        }
+        if (_q->iext[_q->r] > _q->grid_size-1)
+            _q->iext[_q->r] = _q->grid_size-1;
+        for (i=_q->r; i>0; i--) {
+            if (_q->iext[i-1] >= _q->iext[i])
+                _q->iext[i-1] = _q->iext[i] - 1;
+        }
     }
 
     // iterate over the Remez exchange algorithm
@@ -338,6 +412,17 @@ void firdespm_execute(firdespm _q, float * _h)
 }
 
 
+// get extremal frequencies from most recent execution
+//  _q      :   firdespm object
+//  _fext   :   output extremal frequencies [size: (_h_len+1)/2 + 1 x 1]
+void firdespm_get_extremals(firdespm _q,
+                            float *  _fext)
+{
+    unsigned int i;
+    for (i=0; i<_q->r+1; i++)
+        _fext[i] = _q->F[_q->iext[i]];
+}
+
 // 
 // internal methods
 //
@@ -450,6 +535,10 @@ void firdespm_init_grid(firdespm _q)
             }
         }
     }
+
+    // Chebyshev grid points, fixed for the life of the object
+    for (i=0; i<_q->grid_size; i++)
+        _q->X[i] = cos(2*M_PI*_q->F[i]);
 }
 
 // compute interpolating polynomial
@@ -457,20 +546,12 @@ void firdespm_compute_interp(firdespm _q)
 {
     unsigned int i;
 
-    // compute Chebyshev points on F[iext[]] : cos(2*pi*f)
-    for (i=0; i<_q->r+1; i++) {
-        _q->x[i] = cos(2*M_PI*_q->F[_q->iext[i]]);
-#if LIQUID_FIRDESPM_DEBUG_PRINT
-        printf("x[%3u] = %12.8f\n", i, _q->x[i]);
-#endif
-    }
-    //printf("\n");
-
-    // compute Lagrange interpolating polynomial
-    poly_fit_lagrange_barycentric(_q->x,_q->r+1,_q->alpha);
+    // compute Chebyshev points on F[iext[]] and barycentric weights of
+    // the Lagrange interpolating polynomial
+    firdespm_compute_weights(_q);
 #if LIQUID_FIRDESPM_DEBUG_PRINT
     for (i=0; i<_q->r+1; i++)
-        printf("a[%3u] = %12.8f\n", i, _q->alpha[i]);
+        printf("x[%3u] = %12.8f, a[%3u] = %12.8e\n", i, _q->x[i], i, _q->alpha[i]);
 #endif
 
     // compute rho
@@ -497,19 +578,139 @@ void firdespm_compute_interp(firdespm _q)
 
 }
 
-void firdespm_compute_error(firdespm _q)
+// update Chebyshev points and barycentric weights for the current
+// extremal set. Between Remez iterations usually only a few extrema
+// move; the weights of the remaining points are then updated by
+// dividing out removed points and multiplying in added ones, costing
+// O(r*d) rather than O(r^2) for d exchanges. The weights are left
+// unnormalized as every use of them is invariant to scale.
+void firdespm_compute_weights(firdespm _q)
 {
-    unsigned int i;
+    unsigned int i, j, k;
+    unsigned int n = _q->r+1;
+    double w;
+
+    // match current extrema against those of the cached weights; both
+    // sets are strictly increasing
+    unsigned int pos[n];        // position in cached set (n: added)
+    unsigned int removed[n];    // cached positions no longer present
+    unsigned int num_removed = 0;
+    unsigned int num_added   = 0;
+    if (_q->interp_valid) {
+        i = 0;
+        k = 0;
+        while (i < n || k < n) {
+            if (k == n || (i < n && _q->iext[i] < _q->iext_interp[k])) {
+                pos[i++] = n;
+                num_added++;
+            } else if (i == n || _q->iext_interp[k] < _q->iext[i]) {
+                removed[num_removed++] = k++;
+            } else {
+                pos[i++] = k++;
+            }
+        }
 
-    double xf;
-    double H;
-    for (i=0; i<_q->grid_size; i++) {
-        // compute actual response
-        xf = cos(2*M_PI*_q->F[i]);
-        H = poly_val_lagrange_barycentric(_q->x,_q->c,_q->alpha,xf,_q->r+1);
+        // nothing changed
+        if (num_added == 0)
+            return;
+    }
 
-        // compute error
-        _q->E[i] = _q->W[i] * (_q->D[i] - H);
+    for (i=0; i<n; i++)
+        _q->x_tmp[i] = _q->X[_q->iext[i]];
+
+    if (!_q->interp_valid || 4*num_added > n) {
+        // compute weights directly
+        for (i=0; i<n; i++) {
+            w = 1.0;
+            for (j=0; j<n; j++) {
+                if (j != i)
+                    w *= _q->x_tmp[i] - _q->x_tmp[j];
+            }
+            _q->alpha_tmp[i] = 1.0 / w;
+        }
+    } else {
+        // update weights of retained points, compute added points directly
+        for (i=0; i<n; i++) {
+            if (pos[i] < n) {
+                double t0 = 1.0;    // removed points
+                double t1 = 1.0;    // added points
+                for (j=0; j<num_removed; j++)
+                    t0 *= _q->x_tmp[i] - _q->x[removed[j]];
+                for (j=0; j<n; j++) {
+                    if (pos[j] == n)
+                        t1 *= _q->x_tmp[i] - _q->x_tmp[j];
+                }
+                _q->alpha_tmp[i] = _q->alpha[pos[i]] * t0 / t1;
+            } else {
+                w = 1.0;
+                for (j=0; j<n; j++) {
+                    if (j != i)
+                        w *= _q->x_tmp[i] - _q->x_tmp[j];
+                }
+                _q->alpha_tmp[i] = 1.0 / w;
+            }
+        }
+    }
+
+    memmove(_q->x,           _q->x_tmp,     n*sizeof(double));
+    memmove(_q->alpha,       _q->alpha_tmp, n*sizeof(double));
+    memmove(_q->iext_interp, _q->iext,      n*sizeof(unsigned int));
+    _q->interp_valid = 1;
+}
+
+void firdespm_compute_error(firdespm _q)
+{
+    unsigned int i, j;
+    unsigned int n = _q->r+1;
+
+    // pre-scale interpolants by barycentric weights
+    double wc[n];
+    for (j=0; j<n; j++)
+        wc[j] = _q->alpha[j] * _q->c[j];
+
+    // evaluate barycentric interpolator over grid, four points at a
+    // time; independent accumulators keep the divisions pipelined
+    for (i=0; i+4<=_q->grid_size; i+=4) {
+        double t00=0., t01=0., t02=0., t03=0.;  // numerator sums
+        double t10=0., t11=0., t12=0., t13=0.;  // denominator sums
+        for (j=0; j<n; j++) {
+            double g0 = 1.0 / (_q->X[i+0] - _q->x[j]);
+            double g1 = 1.0 / (_q->X[i+1] - _q->x[j]);
+            double g2 = 1.0 / (_q->X[i+2] - _q->x[j]);
+            double g3 = 1.0 / (_q->X[i+3] - _q->x[j]);
+            t00 += wc[j]*g0;    t10 += _q->alpha[j]*g0;
+            t01 += wc[j]*g1;    t11 += _q->alpha[j]*g1;
+            t02 += wc[j]*g2;    t12 += _q->alpha[j]*g2;
+            t03 += wc[j]*g3;    t13 += _q->alpha[j]*g3;
+        }
+        _q->E[i+0] = _q->W[i+0] * (_q->D[i+0] - t00/t10);
+        _q->E[i+1] = _q->W[i+1] * (_q->D[i+1] - t01/t11);
+        _q->E[i+2] = _q->W[i+2] * (_q->D[i+2] - t02/t12);
+        _q->E[i+3] = _q->W[i+3] * (_q->D[i+3] - t03/t13);
+    }
+    for ( ; i<_q->grid_size; i++) {
+        double t0 = 0.;
+        double t1 = 0.;
+        for (j=0; j<n; j++) {
+            double g = 1.0 / (_q->X[i] - _q->x[j]);
+            t0 += wc[j]*g;
+            t1 += _q->alpha[j]*g;
+        }
+        _q->E[i] = _q->W[i] * (_q->D[i] - t0/t1);
+    }
+
+    // grid points (numerically) coinciding with an extremal point take
+    // its interpolant exactly, as in poly_val_lagrange_barycentric();
+    // X is monotonic so these are contiguous about each extremal index
+    double tol = 1e-6f;
+    for (j=n; j>0; j--) {
+        unsigned int k = _q->iext[j-1];
+        for (i=k; fabs(_q->X[i] - _q->x[j-1]) < tol; i--) {
+            _q->E[i] = _q->W[i] * (_q->D[i] - _q->c[j-1]);
+            if (i == 0) break;
+        }
+        for (i=k+1; i<_q->grid_size && fabs(_q->X[i] - _q->x[j-1]) < tol; i++)
+            _q->E[i] = _q->W[i] * (_q->D[i] - _q->c[j-1]);
     }
 }
 
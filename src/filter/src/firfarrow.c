@@ -52,6 +52,7 @@ struct FIRFARROW(_s) {
     float mu;           // fractional sample delay
     float * P;          // polynomail coefficients matrix [ h_len x Q+1 ]
     float gamma;        // inverse of DC response (normalization factor)
+    TC * Pb;            // branch filters [ Q+1 x h_len ], Pb[j] = gamma (-1)^j P[:,j]
 
 #if FIRFARROW_USE_DOTPROD
     WINDOW() w;
@@ -84,7 +85,7 @@ FIRFARROW() FIRFARROW(_create)(unsigned int _h_len,
     }
 
     // create main object
-    FIRFARROW() q = (FIRFARROW()) malloc(sizeof(struct FIRFARROW(_s)));
+    FIRFARROW() q = (FIRFARROW()) liquid_malloc(sizeof(struct FIRFARROW(_s)));
 
     // set internal properties
     q->h_len = _h_len;  // filter length
@@ -93,16 +94,17 @@ FIRFARROW() FIRFARROW(_create)(unsigned int _h_len,
     q->fc    = _fc;     // filter cutoff frequency
 
     // allocate memory for filter coefficients
-    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC *) liquid_malloc((q->h_len)*sizeof(TC));
 
 #if FIRFARROW_USE_DOTPROD
     q->w = WINDOW(_create)(q->h_len);
 #else
-    q->v = malloc((q->h_len)*sizeof(TI));
+    q->v = liquid_malloc((q->h_len)*sizeof(TI));
 #endif
 
     // allocate memory for polynomial matrix [ h_len x Q+1 ]
-    q->P = (float*) malloc((q->h_len)*(q->Q+1)*sizeof(float));
+    q->P = (float*) liquid_malloc((q->h_len)*(q->Q+1)*sizeof(float));
+    q->Pb = (TC *)  liquid_malloc((q->h_len)*(q->Q+1)*sizeof(TC));
 
     // reset the filter object
     FIRFARROW(_reset)(q);
@@ -123,13 +125,14 @@ void FIRFARROW(_destroy)(FIRFARROW() _q)
 #if FIRFARROW_USE_DOTPROD
     WINDOW(_destroy)(_q->w);
 #else
-    free(_q->v);
+    liquid_free(_q->v);
 #endif
-    free(_q->h);    // free the filter coefficients array
-    free(_q->P);    // free the polynomial matrix
+    liquid_free(_q->h);    // free the filter coefficients array
+    liquid_free(_q->P);    // free the polynomial matrix
+    liquid_free(_q->Pb);   // free the branch filters
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print firfarrow object's internal properties
@@ -199,7 +202,7 @@ void FIRFARROW(_set_delay)(FIRFARROW() _q,
     for (i=0; i<_q->h_len; i++) {
         // compute filter tap from polynomial using negative
         // value for _mu
-        _q->h[i] = POLY(_val)(_q->P+n, _q->Q, -_mu);
+        _q->h[i] = POLY(_val)(_q->P+n, _q->Q+1, -_mu);
 
         // normalize filter by inverse of DC response
         _q->h[i] *= _q->gamma;
@@ -229,6 +232,44 @@ void FIRFARROW(_execute)(FIRFARROW() _q,
 #endif
 }
 
+// evaluate Farrow structure at fractional delay _mu on window _r
+// without computing the filter taps: each branch filter j yields
+// v_j = Pb[j] . r, and the output is the polynomial sum_j v_j mu^j
+// evaluated with Horner's method
+//  _q      : firfarrow object
+//  _r      : input window [size: h_len x 1]
+//  _mu     : fractional sample delay
+//  _y      : output sample pointer
+void FIRFARROW(_execute_window)(FIRFARROW() _q,
+                                TI *        _r,
+                                float       _mu,
+                                TO *        _y)
+{
+    unsigned int j = _q->Q;
+    TO y;
+    DOTPROD(_run4)(_q->Pb + j*_q->h_len, _r, _q->h_len, &y);
+    while (j > 0) {
+        j--;
+        TO v;
+        DOTPROD(_run4)(_q->Pb + j*_q->h_len, _r, _q->h_len, &v);
+        y = y*_mu + v;
+    }
+    *_y = y;
+}
+
+// get pointer to firfarrow input window [size: h_len x 1]
+TI * FIRFARROW(_get_window)(FIRFARROW() _q)
+{
+#if FIRFARROW_USE_DOTPROD
+    TI * r;
+    WINDOW(_read)(_q->w, &r);
+    return r;
+#else
+    fprintf(stderr,"error: firfarrow_%s_get_window(), window not available\n", EXTENSION_FULL);
+    exit(1);
+#endif
+}
+
 // compute firfarrow filter on block of samples; the input
 // and output arrays may have the same pointer
 //  _q      : firfarrow object
@@ -366,5 +407,12 @@ void FIRFARROW(_genpoly)(FIRFARROW() _q)
         _q->gamma += _q->h[i];
     _q->gamma = 1.0f / (_q->gamma);   // invert result
 
+    // generate normalized branch filters for direct evaluation of
+    // the Farrow structure (see _execute_window())
+    for (j=0; j<=_q->Q; j++) {
+        float g = (j % 2) ? -_q->gamma : _q->gamma;
+        for (i=0; i<_q->h_len; i++)
+            _q->Pb[j*_q->h_len + i] = g * _q->P[i*(_q->Q+1) + j];
+    }
 }
 
@@ -69,9 +69,9 @@ FIRFILT() FIRFILT(_create)(TC * _h,
     }
 
     // create filter object and initialize
-    FIRFILT() q = (FIRFILT()) malloc(sizeof(struct FIRFILT(_s)));
+    FIRFILT() q = (FIRFILT()) liquid_malloc(sizeof(struct FIRFILT(_s)));
     q->h_len = _n;
-    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC *) liquid_malloc((q->h_len)*sizeof(TC));
 
 #if LIQUID_FIRFILT_USE_WINDOW
     // create window (internal buffer)
@@ -80,7 +80,7 @@ FIRFILT() FIRFILT(_create)(TC * _h,
     // initialize array for buffering
     q->w_len   = 1<<liquid_msb_index(q->h_len); // effectively 2^{floor(log2(len))+1}
     q->w_mask  = q->w_len - 1;
-    q->w       = (TI *) malloc((q->w_len + q->h_len + 1)*sizeof(TI));
+    q->w       = (TI *) liquid_malloc((q->w_len + q->h_len + 1)*sizeof(TI));
     q->w_index = 0;
 #endif
 
@@ -208,20 +208,23 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
     if (_n != _q->h_len) {
         // reallocate memory
         _q->h_len = _n;
-        _q->h = (TC*) realloc(_q->h, (_q->h_len)*sizeof(TC));
+        _q->h = (TC*) liquid_realloc(_q->h, (_q->h_len)*sizeof(TC));
 
 #if LIQUID_FIRFILT_USE_WINDOW
         // recreate window object, preserving internal state
         _q->w = WINDOW(_recreate)(_q->w, _q->h_len);
 #else
         // free old array
-        free(_q->w);
+        liquid_free(_q->w);
 
         // initialize array for buffering
         _q->w_len   = 1<<liquid_msb_index(_q->h_len);   // effectively 2^{floor(log2(len))+1}
         _q->w_mask  = _q->w_len - 1;
-        _q->w       = (TI *) malloc((_q->w_len + _q->h_len + 1)*sizeof(TI));
+        _q->w       = (TI *) liquid_malloc((_q->w_len + _q->h_len + 1)*sizeof(TI));
         _q->w_index = 0;
+
+        // clear new buffer
+        FIRFILT(_reset)(_q);
 #endif
     }
 
@@ -229,24 +232,97 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
     for (i=_n; i>0; i--)
         _q->h[i-1] = _h[_n-i];
 
-    // re-create dot product object
-    DOTPROD(_destroy)(_q->dp);
-    _q->dp = DOTPROD(_create)(_q->h, _q->h_len);
+    // re-create dot product object (updated in place, without
+    // allocation, if the filter length is unchanged)
+    _q->dp = DOTPROD(_recreate)(_q->dp, _q->h, _q->h_len);
 
     return _q;
 }
 
+// set filter coefficients in place, without allocation; the filter
+// length is unchanged and the internal buffer is retained
+//  _q      :   filter object
+//  _h      :   new coefficients [size: h_len x 1]
+void FIRFILT(_set_coefficients)(FIRFILT() _q,
+                                TC *      _h)
+{
+    // load filter in reverse order
+    unsigned int i;
+    unsigned int n = _q->h_len;
+    for (i=0; i<n; i++)
+        _q->h[i] = _h[n-i-1];
+
+    // overwrite dot product coefficients
+    DOTPROD(_update_coefficients)(_q->dp, _q->h);
+}
+
+// get filter coefficients
+//  _q      :   filter object
+//  _h      :   output coefficients [size: h_len x 1]
+void FIRFILT(_get_coefficients)(FIRFILT() _q,
+                                TC *      _h)
+{
+    unsigned int i;
+    unsigned int n = _q->h_len;
+    for (i=0; i<n; i++)
+        _h[i] = _q->h[n-i-1];
+}
+
+// adapt filter coefficients with least mean-squares update against
+// the current buffer, h <- h + mu*e*conj(x), where e is the error
+// between the desired and actual output for the most recent execute()
+//  _q      :   filter object
+//  _mu     :   step size
+//  _e      :   output error
+void FIRFILT(_adapt)(FIRFILT() _q,
+                     float     _mu,
+                     TO        _e)
+{
+    // read buffer (retrieve pointer to aligned memory array)
+#if LIQUID_FIRFILT_USE_WINDOW
+    TI *r;
+    WINDOW(_read)(_q->w, &r);
+#else
+    TI *r = _q->w + _q->w_index;
+#endif
+
+    unsigned int i;
+    unsigned int n = _q->h_len;
+#if TC_COMPLEX
+    // complex coefficients: h += (mu*e) * conj(x)
+    TO g = _mu*_e;
+    for (i=0; i<n; i++)
+        _q->h[i] += g*conjf(r[i]);
+#elif TI_COMPLEX
+    // real coefficients, complex input: gradient is real part,
+    // h += mu*Re{ e*conj(x) }, on interleaved I/Q samples
+    float gr = _mu*crealf(_e);
+    float gi = _mu*cimagf(_e);
+    float * rr = (float*) r;
+    for (i=0; i<n; i++)
+        _q->h[i] += gr*rr[2*i] + gi*rr[2*i+1];
+#else
+    // real coefficients and input
+    float g = _mu*_e;
+    for (i=0; i<n; i++)
+        _q->h[i] += g*r[i];
+#endif
+
+    // overwrite dot product coefficients
+    DOTPROD(_update_coefficients)(_q->dp, _q->h);
+}
+
 // destroy firfilt object
 void FIRFILT(_destroy)(FIRFILT() _q)
 {
 #if LIQUID_FIRFILT_USE_WINDOW
     WINDOW(_destroy)(_q->w);
 #else
-    free(_q->w);
+    liquid_free(_q->w);
 #endif
     DOTPROD(_destroy)(_q->dp);
-    free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
 }
 
 // reset internal state of filter object
@@ -349,6 +425,7 @@ void FIRFILT(_execute_block)(FIRFILT()    _q,
                              TO *         _y)
 {
     unsigned int i;
+#if LIQUID_FIRFILT_USE_WINDOW
     for (i=0; i<_n; i++) {
         // push sample into filter
         FIRFILT(_push)(_q, _x[i]);
@@ -356,6 +433,163 @@ void FIRFILT(_execute_block)(FIRFILT()    _q,
         // compute output sample
         FIRFILT(_execute)(_q, &_y[i]);
     }
+#else
+    i = 0;
+    while (i < _n) {
+        // number of samples which can be appended before the
+        // buffer index wraps around
+        unsigned int num = _q->w_mask - _q->w_index;
+
+        if (num == 0) {
+            // next sample wraps buffer; push and execute normally
+            FIRFILT(_push)(_q, _x[i]);
+            FIRFILT(_execute)(_q, &_y[i]);
+            i++;
+            continue;
+        }
+
+        // append block of samples to end of buffer
+        if (num > _n - i)
+            num = _n - i;
+        memmove(_q->w + _q->w_index + _q->h_len, &_x[i], num*sizeof(TI));
+
+        // compute consecutive outputs directly from buffer
+        DOTPROD(_run_block)(_q->h, _q->h_len, _q->w + _q->w_index + 1, 1, num, &_y[i]);
+
+        // apply scaling factor
+        unsigned int k;
+        for (k=0; k<num; k++)
+            _y[i+k] *= _q->scale;
+
+        // update index
+        _q->w_index += num;
+        i += num;
+    }
+#endif
+}
+
+// prime the filter's internal buffer with a block of input samples
+// without computing any outputs; typically used with the first
+// get_delay() samples of a signal so that subsequent outputs are
+// aligned with their inputs
+//  _q      : filter object
+//  _x      : pointer to input array [size: _n x 1]
+//  _n      : number of input samples
+void FIRFILT(_prime)(FIRFILT()    _q,
+                     TI *         _x,
+                     unsigned int _n)
+{
+#if LIQUID_FIRFILT_USE_WINDOW
+    WINDOW(_write)(_q->w, _x, _n);
+#else
+    if (_n < _q->h_len) {
+        // retain part of the existing history
+        unsigned int i;
+        for (i=0; i<_n; i++)
+            FIRFILT(_push)(_q, _x[i]);
+        return;
+    }
+
+    // history is replaced entirely; load the most recent samples
+    // at the start of the buffer
+    memmove(_q->w, &_x[_n - _q->h_len], (_q->h_len)*sizeof(TI));
+    _q->w_index = 0;
+#endif
+}
+
+// flush the filter's internal buffer, computing outputs for
+// zero-valued inputs; typically used with get_delay() samples
+// at the end of a signal to recover the last filtered outputs
+//  _q      : filter object
+//  _n      : number of output samples
+//  _y      : pointer to output array [size: _n x 1]
+void FIRFILT(_flush)(FIRFILT()    _q,
+                     unsigned int _n,
+                     TO *         _y)
+{
+    TI v[64];
+    memset(v, 0x00, sizeof(v));
+    unsigned int i = 0;
+    while (i < _n) {
+        unsigned int num = _n - i < 64 ? _n - i : 64;
+        FIRFILT(_execute_block)(_q, v, num, &_y[i]);
+        i += num;
+    }
+}
+
+// widen block of 16-bit input samples to input type
+static inline void FIRFILT(_widen_i16)(const int16_t * _x,
+                                       unsigned int    _n,
+                                       float           _scale,
+                                       TI *            _y)
+{
+#if TI_COMPLEX
+    liquid_vectorcf_from_ci16(_x, _n, _scale, _y);
+#else
+    liquid_vectorf_from_s16(_x, _n, _scale, _y);
+#endif
+}
+
+// execute the filter on a block of 16-bit integer input samples
+// (interleaved I/Q pairs for complex inputs), widening each sample
+// as it is appended to the internal buffer
+//  _q      :   filter object
+//  _x      :   input array [size: _n x 1 (_2n x 1 for complex)]
+//  _n      :   number of input, output samples
+//  _scale  :   input scaling factor
+//  _y      :   output array [size: _n x 1]
+#if TI_COMPLEX
+void FIRFILT(_execute_block_ci16)(FIRFILT()       _q,
+#else
+void FIRFILT(_execute_block_s16)(FIRFILT()       _q,
+#endif
+                                  const int16_t * _x,
+                                  unsigned int    _n,
+                                  float           _scale,
+                                  TO *            _y)
+{
+    unsigned int stride = TI_COMPLEX ? 2 : 1;
+    unsigned int i = 0;
+#if LIQUID_FIRFILT_USE_WINDOW
+    // widen through short stack buffer
+    TI v[64];
+    while (i < _n) {
+        unsigned int num = _n - i < 64 ? _n - i : 64;
+        FIRFILT(_widen_i16)(&_x[stride*i], num, _scale, v);
+        FIRFILT(_execute_block)(_q, v, num, &_y[i]);
+        i += num;
+    }
+#else
+    while (i < _n) {
+        unsigned int num = _q->w_mask - _q->w_index;
+
+        if (num == 0) {
+            // next sample wraps buffer; push and execute normally
+            TI v;
+            FIRFILT(_widen_i16)(&_x[stride*i], 1, _scale, &v);
+            FIRFILT(_push)(_q, v);
+            FIRFILT(_execute)(_q, &_y[i]);
+            i++;
+            continue;
+        }
+
+        // widen block of samples onto end of buffer
+        if (num > _n - i)
+            num = _n - i;
+        FIRFILT(_widen_i16)(&_x[stride*i], num, _scale, _q->w + _q->w_index + _q->h_len);
+
+        // compute consecutive outputs directly from buffer
+        DOTPROD(_run_block)(_q->h, _q->h_len, _q->w + _q->w_index + 1, 1, num, &_y[i]);
+
+        // apply scaling factor
+        unsigned int k;
+        for (k=0; k<num; k++)
+            _y[i+k] *= _q->scale;
+
+        _q->w_index += num;
+        i += num;
+    }
+#endif
 }
 
 // get filter length
@@ -364,6 +598,13 @@ unsigned int FIRFILT(_get_length)(FIRFILT() _q)
     return _q->h_len;
 }
 
+// get nominal filter delay (samples), (h_len-1)/2 for the
+// linear-phase filters produced by the create methods
+float FIRFILT(_get_delay)(FIRFILT() _q)
+{
+    return 0.5f*(float)(_q->h_len - 1);
+}
+
 // compute complex frequency response
 //  _q      :   filter object
 //  _fc     :   frequency
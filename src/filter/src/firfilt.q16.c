@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// firfilt (fixed-point) : finite impulse response (FIR) filter with
+// 16-bit (Q15) taps and samples
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+// defined:
+//  FIRFILT()       name-mangling macro
+//  TO              output data type
+//  TC              coefficients data type
+//  TI              input data type
+//  DOTPROD()       dotprod macro
+
+// firfilt object structure
+struct FIRFILT(_s) {
+    TC * h;                 // filter coefficients array [size; h_len x 1]
+    unsigned int h_len;     // filter length
+
+    // use array as internal buffer
+    TI * w;                 // internal buffer object
+    unsigned int w_len;     // window length
+    unsigned int w_mask;    // window index mask
+    unsigned int w_index;   // window read index
+
+    DOTPROD() dp;           // dot product object
+};
+
+// create firfilt object
+//  _h      :   coefficients (filter taps) [size: _n x 1]
+//  _n      :   filter length
+FIRFILT() FIRFILT(_create)(TC *         _h,
+                           unsigned int _n)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: firfilt_%s_create(), filter length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create filter object and initialize
+    FIRFILT() q = (FIRFILT()) liquid_malloc(sizeof(struct FIRFILT(_s)));
+    q->h_len = _n;
+    q->h = (TC *) liquid_malloc((q->h_len)*sizeof(TC));
+
+    // initialize array for buffering
+    q->w_len   = 1<<liquid_msb_index(q->h_len); // effectively 2^{floor(log2(len))+1}
+    q->w_mask  = q->w_len - 1;
+    q->w       = (TI *) liquid_malloc((q->w_len + q->h_len + 1)*sizeof(TI));
+    q->w_index = 0;
+
+    // load filter in reverse order
+    unsigned int i;
+    for (i=_n; i>0; i--)
+        q->h[i-1] = _h[_n-i];
+
+    // create dot product object
+    q->dp = DOTPROD(_create)(q->h, q->h_len);
+
+    // reset filter state (clear buffer)
+    FIRFILT(_reset)(q);
+
+    return q;
+}
+
+// re-create firfilt object
+//  _q      :   original firfilt object
+//  _h      :   new coefficients [size: _n x 1]
+//  _n      :   new filter length
+FIRFILT() FIRFILT(_recreate)(FIRFILT()    _q,
+                             TC *         _h,
+                             unsigned int _n)
+{
+    unsigned int i;
+
+    // reallocate memory array if filter length has changed
+    if (_n != _q->h_len) {
+        // reallocate memory
+        _q->h_len = _n;
+        _q->h = (TC*) liquid_realloc(_q->h, (_q->h_len)*sizeof(TC));
+
+        // free old array
+        liquid_free(_q->w);
+
+        // initialize array for buffering
+        _q->w_len   = 1<<liquid_msb_index(_q->h_len);   // effectively 2^{floor(log2(len))+1}
+        _q->w_mask  = _q->w_len - 1;
+        _q->w       = (TI *) liquid_malloc((_q->w_len + _q->h_len + 1)*sizeof(TI));
+        FIRFILT(_reset)(_q);
+    }
+
+    // load filter in reverse order
+    for (i=_n; i>0; i--)
+        _q->h[i-1] = _h[_n-i];
+
+    // re-create dot product object (updated in place, without
+    // allocation, if the filter length is unchanged)
+    _q->dp = DOTPROD(_recreate)(_q->dp, _q->h, _q->h_len);
+
+    return _q;
+}
+
+// destroy firfilt object
+void FIRFILT(_destroy)(FIRFILT() _q)
+{
+    liquid_free(_q->w);
+    DOTPROD(_destroy)(_q->dp);
+    liquid_free(_q->h);
+    liquid_free(_q);
+}
+
+// reset internal state of filter object
+void FIRFILT(_reset)(FIRFILT() _q)
+{
+    memset(_q->w, 0x00, (_q->w_len + _q->h_len + 1)*sizeof(TI));
+    _q->w_index = 0;
+}
+
+// print filter object internals (taps)
+void FIRFILT(_print)(FIRFILT() _q)
+{
+    printf("firfilt_%s:\n", EXTENSION_FULL);
+    unsigned int i;
+    unsigned int n = _q->h_len;
+    for (i=0; i<n; i++)
+        printf("  h(%3u) = %6d\n", i+1, _q->h[n-i-1]);
+}
+
+// push sample into filter object's internal buffer
+//  _q      :   filter object
+//  _x      :   single input sample
+void FIRFILT(_push)(FIRFILT() _q,
+                    TI        _x)
+{
+    // increment index
+    _q->w_index++;
+
+    // wrap around pointer
+    _q->w_index &= _q->w_mask;
+
+    // if pointer wraps around, copy excess memory
+    if (_q->w_index == 0)
+        memmove(_q->w, _q->w + _q->w_len, (_q->h_len)*sizeof(TI));
+
+    // append value to end of buffer
+    _q->w[_q->w_index + _q->h_len - 1] = _x;
+}
+
+// compute output sample (dot product between internal
+// filter coefficients and internal buffer)
+//  _q      :   filter object
+//  _y      :   output sample pointer
+void FIRFILT(_execute)(FIRFILT() _q,
+                       TO *      _y)
+{
+    // execute dot product
+    DOTPROD(_execute)(_q->dp, _q->w + _q->w_index, _y);
+}
+
+// execute the filter on a block of input samples; the
+// input and output buffers may be the same
+//  _q      : filter object
+//  _x      : pointer to input array [size: _n x 1]
+//  _n      : number of input, output samples
+//  _y      : pointer to output array [size: _n x 1]
+void FIRFILT(_execute_block)(FIRFILT()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    unsigned int i = 0;
+    while (i < _n) {
+        // number of samples which can be appended before the
+        // buffer index wraps around
+        unsigned int num = _q->w_mask - _q->w_index;
+
+        if (num == 0) {
+            // next sample wraps buffer; push and execute normally
+            FIRFILT(_push)(_q, _x[i]);
+            FIRFILT(_execute)(_q, &_y[i]);
+            i++;
+            continue;
+        }
+
+        // append block of samples to end of buffer
+        if (num > _n - i)
+            num = _n - i;
+        memmove(_q->w + _q->w_index + _q->h_len, &_x[i], num*sizeof(TI));
+
+        // compute consecutive outputs directly from buffer
+        unsigned int k;
+        for (k=0; k<num; k++)
+            DOTPROD(_execute)(_q->dp, _q->w + _q->w_index + 1 + k, &_y[i+k]);
+
+        // update index
+        _q->w_index += num;
+        i += num;
+    }
+}
+
+// get filter length
+unsigned int FIRFILT(_get_length)(FIRFILT() _q)
+{
+    return _q->h_len;
+}
+
@@ -31,6 +31,9 @@
 #include <stdlib.h>
 #include <math.h>
 
+// number of outputs accumulated together by r2c_execute_block()
+#define FIRHILB_BLOCK_WIDTH (8)
+
 // defined:
 //  FIRHILB()       name-mangling macro
 //  T               coefficients type
@@ -59,6 +62,10 @@ struct FIRHILB(_s) {
 
     // regular real-to-complex/complex-to-real operation
     unsigned int toggle;
+
+    // block real-to-complex operation: full-rate history followed by
+    // leading input samples [size: 8*m x 1]
+    T * span;
 };
 
 // create firhilb object
@@ -74,18 +81,18 @@ FIRHILB() FIRHILB(_create)(unsigned int _m,
     }
 
     // allocate memory for main object
-    FIRHILB() q = (FIRHILB()) malloc(sizeof(struct FIRHILB(_s)));
+    FIRHILB() q = (FIRHILB()) liquid_malloc(sizeof(struct FIRHILB(_s)));
     q->m  = _m;         // filter semi-length
     q->As = fabsf(_As); // stop-band attenuation
 
     // set filter length and allocate memory for coefficients
     q->h_len = 4*(q->m) + 1;
-    q->h     = (T *)         malloc((q->h_len)*sizeof(T));
-    q->hc    = (T complex *) malloc((q->h_len)*sizeof(T complex));
+    q->h     = (T *)         liquid_malloc((q->h_len)*sizeof(T));
+    q->hc    = (T complex *) liquid_malloc((q->h_len)*sizeof(T complex));
 
     // allocate memory for quadrature filter component
     q->hq_len = 2*(q->m);
-    q->hq     = (T *) malloc((q->hq_len)*sizeof(T));
+    q->hq     = (T *) liquid_malloc((q->hq_len)*sizeof(T));
 
     // compute filter coefficients for half-band filter
     liquid_firdes_kaiser(q->h_len, 0.25f, q->As, 0.0f, q->h);
@@ -112,6 +119,9 @@ FIRHILB() FIRHILB(_create)(unsigned int _m,
     // create internal dot product object
     q->dpq = DOTPROD(_create)(q->hq, q->hq_len);
 
+    // allocate block buffer
+    q->span = (T *) liquid_malloc(8*(q->m)*sizeof(T));
+
     // reset internal state and return object
     FIRHILB(_reset)(q);
     return q;
@@ -128,12 +138,13 @@ void FIRHILB(_destroy)(FIRHILB() _q)
     DOTPROD(_destroy)(_q->dpq);
 
     // free coefficients arrays
-    free(_q->h);
-    free(_q->hc);
-    free(_q->hq);
+    liquid_free(_q->h);
+    liquid_free(_q->hc);
+    liquid_free(_q->hq);
+    liquid_free(_q->span);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print firhilb object internals
@@ -165,6 +176,12 @@ void FIRHILB(_reset)(FIRHILB() _q)
     _q->toggle = 0;
 }
 
+// get real-to-complex delay (samples); complex-to-real has no delay
+unsigned int FIRHILB(_get_delay)(FIRHILB() _q)
+{
+    return 2*_q->m;
+}
+
 // execute Hilbert transform (real to complex)
 //  _q      :   firhilb object
 //  _x      :   real-valued input sample
@@ -210,6 +227,102 @@ void FIRHILB(_r2c_execute)(FIRHILB()   _q,
     *_y = yi + _Complex_I * yq;
 }
 
+// compute real-to-complex outputs from full-rate input sequence _s,
+// output k being aligned with input sample _s[k + 4m-1]: the in-phase
+// component is the delayed sample _s[k + 2m-1] and the quadrature
+// component is the odd-tap filter output; its coefficients are
+// antisymmetric, hq[j] = -hq[2m-1-j], so mirrored samples are
+// subtracted before multiplying, halving the number of products
+//  _q      :   firhilb object
+//  _s      :   input sequence [size: _num + 4m-1 x 1]
+//  _num    :   number of outputs
+//  _y      :   complex-valued output array [size: _num x 1]
+static void FIRHILB(_r2c_run)(FIRHILB()   _q,
+                              T *         _s,
+                              unsigned int _num,
+                              T complex * _y)
+{
+    unsigned int m  = _q->m;
+    unsigned int k, j, l;
+
+    // groups of outputs sharing each coefficient load
+    for (k=0; k + FIRHILB_BLOCK_WIDTH <= _num; k += FIRHILB_BLOCK_WIDTH) {
+        T yq[FIRHILB_BLOCK_WIDTH] = {0};
+        for (j=0; j<m; j++) {
+            T   h = _q->hq[j];
+            T * a = &_s[k + 2*j];
+            T * b = &_s[k + 4*m - 2 - 2*j];
+            for (l=0; l<FIRHILB_BLOCK_WIDTH; l++)
+                yq[l] += h * (a[l] - b[l]);
+        }
+        for (l=0; l<FIRHILB_BLOCK_WIDTH; l++)
+            _y[k+l] = _s[k + l + 2*m - 1] + _Complex_I * yq[l];
+    }
+
+    // remaining outputs
+    for ( ; k<_num; k++) {
+        T yq = 0;
+        for (j=0; j<m; j++)
+            yq += _q->hq[j] * (_s[k + 2*j] - _s[k + 4*m - 2 - 2*j]);
+        _y[k] = _s[k + 2*m - 1] + _Complex_I * yq;
+    }
+}
+
+// execute Hilbert transform (real to complex) on a block of samples;
+// outputs are computed from the input array directly, except for the
+// first 4m-1 which reach back into the buffered history
+//  _q      :   firhilb object
+//  _x      :   real-valued input array [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _y      :   complex-valued output array [size: _n x 1]
+void FIRHILB(_r2c_execute_block)(FIRHILB()    _q,
+                                 T *          _x,
+                                 unsigned int _n,
+                                 T complex *  _y)
+{
+    unsigned int m   = _q->m;
+    unsigned int len = 4*m - 1;     // history length
+    unsigned int i, b;
+
+    // interleave branch buffers into full-rate history; the most
+    // recent sample is in the branch not pushed next
+    T * ra; // branch holding most recent sample
+    T * rb; // other branch
+    WINDOW(_read)(_q->toggle ? _q->w0 : _q->w1, &ra);
+    WINDOW(_read)(_q->toggle ? _q->w1 : _q->w0, &rb);
+    for (i=0; i<2*m; i++) {
+        _q->span[len     - 2*i] = ra[2*m - 1 - i];
+        _q->span[len - 1 - 2*i] = rb[2*m - 1 - i];
+    }
+
+    // outputs reaching into the history; the oldest sample in the
+    // span is not needed
+    unsigned int nh = _n < len ? _n : len;
+    memmove(&_q->span[len+1], _x, nh*sizeof(T));
+    FIRHILB(_r2c_run)(_q, &_q->span[1], nh, _y);
+
+    // remaining outputs straight from the input
+    if (_n > len)
+        FIRHILB(_r2c_run)(_q, _x, _n - len, &_y[len]);
+
+    // retain most recent 2m samples of each branch: sample k went to
+    // branch (toggle + k) mod 2
+    T buf[2*m];
+    for (b=0; b<2; b++) {
+        // last input sample in this branch
+        unsigned int k = ((_q->toggle + _n - 1) & 1) == b ? _n - 1 : _n - 2;
+        unsigned int num = 0;
+        if (_n > 0 && k < _n) {
+            num = k/2 + 1;
+            num = num < 2*m ? num : 2*m;
+        }
+        for (i=0; i<num; i++)
+            buf[i] = _x[k - 2*(num - 1 - i)];
+        WINDOW(_write)(b == 0 ? _q->w0 : _q->w1, buf, num);
+    }
+    _q->toggle = (_q->toggle + _n) & 1;
+}
+
 // execute Hilbert transform (complex to real)
 //  _q      :   firhilb object
 //  _y      :   complex-valued input sample
@@ -221,6 +334,21 @@ void FIRHILB(_c2r_execute)(FIRHILB() _q,
     *_y = crealf(_x);
 }
 
+// execute Hilbert transform (complex to real) on a block of samples
+//  _q      :   firhilb object
+//  _x      :   complex-valued input array [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _y      :   real-valued output array [size: _n x 1]
+void FIRHILB(_c2r_execute_block)(FIRHILB()    _q,
+                                 T complex *  _x,
+                                 unsigned int _n,
+                                 T *          _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = crealf(_x[i]);
+}
+
 // execute Hilbert transform decimator (real to complex)
 //  _q      :   firhilb object
 //  _x      :   real-valued input array [size: 2 x 1]
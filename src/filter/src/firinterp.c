@@ -33,6 +33,7 @@ struct FIRINTERP(_s) {
     unsigned int h_len;     // prototype filter length
     unsigned int h_sub_len; // sub-filter length
     unsigned int M;         // interpolation factor
+    float delay;            // prototype filter delay (output samples)
     FIRPFB() filterbank;    // polyphase filterbank object
 };
 
@@ -54,9 +55,10 @@ FIRINTERP() FIRINTERP(_create)(unsigned int _M,
     }
 
     // allocate main object memory and set internal parameters
-    FIRINTERP() q = (FIRINTERP()) malloc(sizeof(struct FIRINTERP(_s)));
+    FIRINTERP() q = (FIRINTERP()) liquid_malloc(sizeof(struct FIRINTERP(_s)));
     q->M = _M;
     q->h_len = _h_len;
+    q->delay = 0.5f*(float)(_h_len-1);
 
     // compute sub-filter length
     q->h_sub_len=0;
@@ -65,7 +67,7 @@ FIRINTERP() FIRINTERP(_create)(unsigned int _M,
 
     // compute effective filter length (pad end of prototype with zeros)
     q->h_len = q->M * q->h_sub_len;
-    q->h = (TC*) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC*) liquid_malloc((q->h_len)*sizeof(TC));
 
     // load filter coefficients in regular order, padding end with zeros
     unsigned int i;
@@ -111,8 +113,11 @@ FIRINTERP() FIRINTERP(_create_kaiser)(unsigned int _M,
     for (i=0; i<h_len; i++)
         hc[i] = hf[i];
     
-    // return interpolator object
-    return FIRINTERP(_create)(_M, hc, 2*_M*_m);
+    // create interpolator object; the prototype is truncated by one
+    // sample, so the delay is that of the original filter
+    FIRINTERP() q = FIRINTERP(_create)(_M, hc, 2*_M*_m);
+    q->delay = (float)(_M*_m);
+    return q;
 }
 
 // create prototype (root-)Nyquist interpolator
@@ -161,8 +166,8 @@ FIRINTERP() FIRINTERP(_create_prototype)(int          _type,
 void FIRINTERP(_destroy)(FIRINTERP() _q)
 {
     FIRPFB(_destroy)(_q->filterbank);
-    free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
 }
 
 // print interpolator state
@@ -180,6 +185,21 @@ void FIRINTERP(_reset)(FIRINTERP() _q)
     FIRPFB(_reset)(_q->filterbank);
 }
 
+// push input sample into internal buffer without computing output
+//  _q      : firinterp object
+//  _x      : input sample
+void FIRINTERP(_push)(FIRINTERP() _q,
+                      TI          _x)
+{
+    FIRPFB(_push)(_q->filterbank, _x);
+}
+
+// get interpolator delay (output samples)
+float FIRINTERP(_get_delay)(FIRINTERP() _q)
+{
+    return _q->delay;
+}
+
 // execute interpolator
 //  _q      : interpolator object
 //  _x      : input sample
@@ -192,9 +212,7 @@ void FIRINTERP(_execute)(FIRINTERP() _q,
     FIRPFB(_push)(_q->filterbank,  _x);
 
     // compute output for each filter in the bank
-    unsigned int i;
-    for (i=0; i<_q->M; i++)
-        FIRPFB(_execute)(_q->filterbank, i, &_y[i]);
+    FIRPFB(_execute_batch)(_q->filterbank, _y);
 }
 
 // execute interpolation on block of input samples
@@ -207,10 +225,7 @@ void FIRINTERP(_execute_block)(FIRINTERP()  _q,
                                unsigned int _n,
                                TO *         _y)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
-        // execute one input at a time with an output stride _M
-        FIRINTERP(_execute)(_q, _x[i], &_y[i*_q->M]);
-    }
+    // compute all _M outputs for each input from one contiguous span
+    FIRPFB(_execute_block)(_q->filterbank, _x, _n, _y);
 }
 
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// firinterp (fixed-point) : finite impulse response interpolator
+// with 16-bit (Q15) taps and samples
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// defined:
+//  FIRINTERP()     name-mangling macro
+//  TO              output data type
+//  TC              coefficients data type
+//  TI              input data type
+//  DOTPROD()       dotprod macro
+
+struct FIRINTERP(_s) {
+    unsigned int h_len;     // prototype filter length
+    unsigned int h_sub_len; // sub-filter length
+    unsigned int M;         // interpolation factor
+
+    // polyphase filterbank: one dot product object per output
+    // phase, each holding its sub-filter in reverse order
+    DOTPROD() * dp;
+
+    // use array as internal buffer (see firfilt)
+    TI * w;                 // internal buffer object
+    unsigned int w_len;     // window length
+    unsigned int w_mask;    // window index mask
+    unsigned int w_index;   // window read index
+};
+
+// create interpolator
+//  _M      :   interpolation factor
+//  _h      :   filter coefficients array [size: _h_len x 1]
+//  _h_len  :   filter length
+FIRINTERP() FIRINTERP(_create)(unsigned int _M,
+                               TC *         _h,
+                               unsigned int _h_len)
+{
+    // validate input
+    if (_M < 2) {
+        fprintf(stderr,"error: firinterp_%s_create(), interp factor must be greater than 1\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_h_len < _M) {
+        fprintf(stderr,"error: firinterp_%s_create(), filter length cannot be less than interp factor\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // allocate main object memory and set internal parameters
+    FIRINTERP() q = (FIRINTERP()) liquid_malloc(sizeof(struct FIRINTERP(_s)));
+    q->M = _M;
+
+    // compute sub-filter length
+    q->h_sub_len=0;
+    while (q->M * q->h_sub_len < _h_len)
+        q->h_sub_len++;
+
+    // compute effective filter length (pad end of prototype with zeros)
+    q->h_len = q->M * q->h_sub_len;
+
+    // create polyphase filterbank: sub-filter i holds prototype
+    // taps h[i], h[i+M], h[i+2M], ... in reverse order
+    q->dp = (DOTPROD()*) liquid_malloc((q->M)*sizeof(DOTPROD()));
+    TC h_sub[q->h_sub_len];
+    unsigned int i, n;
+    for (i=0; i<q->M; i++) {
+        for (n=0; n<q->h_sub_len; n++) {
+            unsigned int k = i + n*q->M;
+            h_sub[q->h_sub_len-n-1] = k < _h_len ? _h[k] : 0;
+        }
+        q->dp[i] = DOTPROD(_create)(h_sub, q->h_sub_len);
+    }
+
+    // initialize array for buffering
+    q->w_len   = 1<<liquid_msb_index(q->h_sub_len); // effectively 2^{floor(log2(len))+1}
+    q->w_mask  = q->w_len - 1;
+    q->w       = (TI *) liquid_malloc((q->w_len + q->h_sub_len + 1)*sizeof(TI));
+
+    // reset filter state (clear buffer)
+    FIRINTERP(_reset)(q);
+
+    // return interpolator object
+    return q;
+}
+
+// destroy interpolator object
+void FIRINTERP(_destroy)(FIRINTERP() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->M; i++)
+        DOTPROD(_destroy)(_q->dp[i]);
+    liquid_free(_q->dp);
+    liquid_free(_q->w);
+    liquid_free(_q);
+}
+
+// print interpolator state
+void FIRINTERP(_print)(FIRINTERP() _q)
+{
+    printf("interp_%s():\n", EXTENSION_FULL);
+    printf("    M       :   %u\n", _q->M);
+    printf("    h_len   :   %u\n", _q->h_len);
+}
+
+// clear internal state
+void FIRINTERP(_reset)(FIRINTERP() _q)
+{
+    memset(_q->w, 0x00, (_q->w_len + _q->h_sub_len + 1)*sizeof(TI));
+    _q->w_index = 0;
+}
+
+// execute interpolator
+//  _q      : interpolator object
+//  _x      : input sample
+//  _y      : output array [size: 1 x _M]
+void FIRINTERP(_execute)(FIRINTERP() _q,
+                         TI          _x,
+                         TO *        _y)
+{
+    // push sample into buffer
+    _q->w_index++;
+    _q->w_index &= _q->w_mask;
+    if (_q->w_index == 0)
+        memmove(_q->w, _q->w + _q->w_len, (_q->h_sub_len)*sizeof(TI));
+    _q->w[_q->w_index + _q->h_sub_len - 1] = _x;
+
+    // compute output for each filter in the bank
+    TI * r = _q->w + _q->w_index;
+    unsigned int i;
+    for (i=0; i<_q->M; i++)
+        DOTPROD(_execute)(_q->dp[i], r, &_y[i]);
+}
+
+// execute interpolation on block of input samples
+//  _q      : firinterp object
+//  _x      : input array [size: _n x 1]
+//  _n      : size of input array
+//  _y      : output sample array [size: _M*_n x 1]
+void FIRINTERP(_execute_block)(FIRINTERP()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        FIRINTERP(_execute)(_q, _x[i], &_y[i*_q->M]);
+}
+
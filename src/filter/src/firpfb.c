@@ -27,18 +27,46 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
+
+// maximum number of input samples processed at once by execute_block()
+#define LIQUID_FIRPFB_BLOCK_LEN     (32)
+
+// half-precision values per coefficient
+#if TC_COMPLEX
+#  define FIRPFB_F16_WIDTH          (2)
+#else
+#  define FIRPFB_F16_WIDTH          (1)
+#endif
 
 struct FIRPFB(_s) {
-    TC * h;                     // filter coefficients array
+    TC * h;                     // sub-filter coefficients, reversed [size: M x h_sub_len]
     unsigned int h_len;         // total number of filter coefficients
     unsigned int h_sub_len;     // sub-sampled filter length
     unsigned int num_filters;   // number of filters
 
     WINDOW() w;                 // window buffer
     DOTPROD() * dp;             // array of vector dot product objects
+    DOTPROD(_batch) dpb;        // batched dot product (all filters)
+    unsigned int * refs;        // number of filterbanks sharing h, dp, dpb
     TC scale;                   // output scaling factor
+
+    // half-precision copy of the sub-filter coefficients, private to
+    // each object; when present all execute methods run from it
+    liquid_float16 * h16;       // [size: M x h_sub_len x FIRPFB_F16_WIDTH], or NULL
+
+    // block execution buffers
+    TI * span;                  // history and input [size: h_sub_len-1 + LIQUID_FIRPFB_BLOCK_LEN]
+    TO * y;                     // single filter output [size: LIQUID_FIRPFB_BLOCK_LEN]
 };
 
+// internal methods for block processing (see below)
+TI * FIRPFB(_get_window)(FIRPFB() _q);
+TI * FIRPFB(_span_load)(FIRPFB() _q, TI * _x, unsigned int _n);
+void FIRPFB(_span_commit)(FIRPFB() _q, unsigned int _n);
+void FIRPFB(_execute_window)(FIRPFB() _q, unsigned int _i, TI * _r, TO * _y);
+void FIRPFB(_update_fp16)(FIRPFB() _q);
+
 // create firpfb from external coefficients
 //  _M      : number of filters in the bank
 //  _h      : coefficients [size: _M*_h_len x 1]
@@ -59,39 +87,52 @@ FIRPFB() FIRPFB(_create)(unsigned int _M,
     }
 
     // create main filter object
-    FIRPFB() q = (FIRPFB()) malloc(sizeof(struct FIRPFB(_s)));
+    FIRPFB() q = (FIRPFB()) liquid_malloc(sizeof(struct FIRPFB(_s)));
 
     // set user-defined parameters
     q->num_filters = _M;
     q->h_len       = _h_len;
 
     // each filter is realized as a dotprod object
-    q->dp = (DOTPROD()*) malloc((q->num_filters)*sizeof(DOTPROD()));
+    q->dp = (DOTPROD()*) liquid_malloc((q->num_filters)*sizeof(DOTPROD()));
 
     // generate bank of sub-samped filters
     // length of each sub-sampled filter
     unsigned int h_sub_len = _h_len / q->num_filters;
-    TC h_sub[h_sub_len];
+    q->h = (TC*) liquid_malloc((q->num_filters*h_sub_len)*sizeof(TC));
+    TC * h_sub = q->h;
     unsigned int i, n;
     for (i=0; i<q->num_filters; i++) {
         for (n=0; n<h_sub_len; n++) {
             // load filter in reverse order
-            h_sub[h_sub_len-n-1] = _h[i + n*(q->num_filters)];
+            h_sub[i*h_sub_len + h_sub_len-n-1] = _h[i + n*(q->num_filters)];
         }
 
         // create dot product object
-        q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
+        q->dp[i] = DOTPROD(_create)(&h_sub[i*h_sub_len],h_sub_len);
     }
 
+    // create batched dot product for executing entire bank at once
+    q->dpb = DOTPROD(_batch_create)(h_sub, h_sub_len, q->num_filters);
+
     // save sub-sampled filter length
     q->h_sub_len = h_sub_len;
+    q->refs  = (unsigned int*) liquid_malloc(sizeof(unsigned int));
+    *q->refs = 1;
 
     // create window buffer
     q->w = WINDOW(_create)(q->h_sub_len);
 
+    // allocate block execution buffers
+    q->span = (TI*) liquid_malloc((q->h_sub_len - 1 + LIQUID_FIRPFB_BLOCK_LEN)*sizeof(TI));
+    q->y    = (TO*) liquid_malloc(LIQUID_FIRPFB_BLOCK_LEN*sizeof(TO));
+
     // set default scaling
     q->scale = 1;
 
+    // single-precision coefficients by default
+    q->h16 = NULL;
+
     // reset object and return
     FIRPFB(_reset)(q);
     return q;
@@ -250,37 +291,95 @@ FIRPFB() FIRPFB(_recreate)(FIRPFB()     _q,
                            TC *         _h,
                            unsigned int _h_len)
 {
-    // check to see if filter length has changed
-    if (_h_len != _q->h_len || _M != _q->num_filters) {
-        // filter length has changed: recreate entire filter
+    // check to see if filter length has changed or if coefficients
+    // are shared with another filterbank
+    if (_h_len != _q->h_len || _M != _q->num_filters || *_q->refs > 1) {
+        // filter length has changed: recreate entire filter, keeping
+        // the coefficient precision
+        int fp16 = _q->h16 != NULL;
         FIRPFB(_destroy)(_q);
         _q = FIRPFB(_create)(_M,_h,_h_len);
+        FIRPFB(_set_coeff_fp16)(_q, fp16);
         return _q;
     }
 
-    // re-create each dotprod object
-    TC h_sub[_q->h_sub_len];
+    // re-create each dotprod object (coefficients are updated in
+    // place as the lengths are unchanged)
+    TC * h_sub = _q->h;
     unsigned int i, n;
     for (i=0; i<_q->num_filters; i++) {
         for (n=0; n<_q->h_sub_len; n++) {
             // load filter in reverse order
-            h_sub[_q->h_sub_len-n-1] = _h[i + n*(_q->num_filters)];
+            h_sub[i*_q->h_sub_len + _q->h_sub_len-n-1] = _h[i + n*(_q->num_filters)];
         }
 
-        _q->dp[i] = DOTPROD(_recreate)(_q->dp[i],h_sub,_q->h_sub_len);
+        _q->dp[i] = DOTPROD(_recreate)(_q->dp[i],&h_sub[i*_q->h_sub_len],_q->h_sub_len);
     }
+
+    // update batched dot product in place
+    DOTPROD(_batch_update_coefficients)(_q->dpb, h_sub);
+
+    // update half-precision coefficients
+    if (_q->h16 != NULL)
+        FIRPFB(_update_fp16)(_q);
     return _q;
 }
 
+// create filterbank sharing the (read-only) coefficients of an
+// existing filterbank; buffers and scaling are private to the new
+// object.  Objects sharing coefficients may run in different threads,
+// but must be created and destroyed from a single thread.
+//  _proto  : prototype filterbank
+FIRPFB() FIRPFB(_create_shared)(FIRPFB() _proto)
+{
+    FIRPFB() q = (FIRPFB()) liquid_malloc(sizeof(struct FIRPFB(_s)));
+
+    // share coefficients and dot product objects
+    q->h           = _proto->h;
+    q->h_len       = _proto->h_len;
+    q->h_sub_len   = _proto->h_sub_len;
+    q->num_filters = _proto->num_filters;
+    q->dp          = _proto->dp;
+    q->dpb         = _proto->dpb;
+    q->refs        = _proto->refs;
+    (*q->refs)++;
+
+    // create window buffer
+    q->w = WINDOW(_create)(q->h_sub_len);
+
+    // allocate block execution buffers
+    q->span = (TI*) liquid_malloc((q->h_sub_len - 1 + LIQUID_FIRPFB_BLOCK_LEN)*sizeof(TI));
+    q->y    = (TO*) liquid_malloc(LIQUID_FIRPFB_BLOCK_LEN*sizeof(TO));
+
+    q->scale = _proto->scale;
+
+    // half-precision coefficients are private: convert again
+    q->h16 = NULL;
+    FIRPFB(_set_coeff_fp16)(q, _proto->h16 != NULL);
+
+    // reset object and return
+    FIRPFB(_reset)(q);
+    return q;
+}
+
 // destroy firpfb object, freeing all internal memory
 void FIRPFB(_destroy)(FIRPFB() _q)
 {
-    unsigned int i;
-    for (i=0; i<_q->num_filters; i++)
-        DOTPROD(_destroy)(_q->dp[i]);
-    free(_q->dp);
+    // release coefficients
+    if (--(*_q->refs) == 0) {
+        unsigned int i;
+        for (i=0; i<_q->num_filters; i++)
+            DOTPROD(_destroy)(_q->dp[i]);
+        liquid_free(_q->dp);
+        DOTPROD(_batch_destroy)(_q->dpb);
+        liquid_free(_q->h);
+        liquid_free(_q->refs);
+    }
     WINDOW(_destroy)(_q->w);
-    free(_q);
+    liquid_free(_q->span);
+    liquid_free(_q->y);
+    liquid_free(_q->h16);
+    liquid_free(_q);
 }
 
 // print firpfb object's parameters
@@ -294,10 +393,36 @@ void FIRPFB(_print)(FIRPFB() _q)
         for (n=0; n<_q->h_len; n++) {
             //printf("%6.4f+j%6.4f ", crealf(_q->dp[i]->h[n]), cimagf(_q->dp[i]->h[n]));
         }
+        // coefficient error of half-precision storage
+        if (_q->h16 != NULL)
+            printf("fp16 error %7.2f dB", FIRPFB(_get_coeff_fp16_error)(_q, i));
         printf("\n");
     }
 }
 
+// get memory footprint of filterbank [bytes]; coefficients and dot
+// products shared with other filterbanks (see FIRPFB(_create_shared))
+// are divided evenly among the objects sharing them
+unsigned long int FIRPFB(_get_memory_usage)(FIRPFB() _q)
+{
+    // shared coefficients and dot product objects
+    unsigned long int n_shared = sizeof(unsigned int)
+                               + _q->num_filters*_q->h_sub_len*sizeof(TC)
+                               + _q->num_filters*sizeof(DOTPROD())
+                               + DOTPROD(_batch_get_memory_usage)(_q->dpb);
+    unsigned int i;
+    for (i=0; i<_q->num_filters; i++)
+        n_shared += DOTPROD(_get_memory_usage)(_q->dp[i]);
+
+    return sizeof(struct FIRPFB(_s))
+         + n_shared / *_q->refs
+         + WINDOW(_get_memory_usage)(_q->w)
+         + (_q->h_sub_len - 1 + LIQUID_FIRPFB_BLOCK_LEN)*sizeof(TI)
+         + LIQUID_FIRPFB_BLOCK_LEN*sizeof(TO)
+         + (_q->h16 == NULL ? 0 :
+            _q->num_filters*_q->h_sub_len*FIRPFB_F16_WIDTH*sizeof(liquid_float16));
+}
+
 // clear/reset firpfb object internal state
 void FIRPFB(_reset)(FIRPFB() _q)
 {
@@ -311,6 +436,54 @@ void FIRPFB(_set_scale)(FIRPFB() _q,
     _q->scale = _scale;
 }
 
+// enable/disable half-precision coefficient storage; inputs and
+// accumulation remain single precision
+//  _q      : firpfb object
+//  _enable : non-zero to run from half-precision coefficients
+void FIRPFB(_set_coeff_fp16)(FIRPFB() _q,
+                             int      _enable)
+{
+    if (_enable && _q->h16 == NULL) {
+        unsigned int n = _q->num_filters*_q->h_sub_len*FIRPFB_F16_WIDTH;
+        _q->h16 = (liquid_float16*) liquid_malloc(n*sizeof(liquid_float16));
+        FIRPFB(_update_fp16)(_q);
+    } else if (!_enable && _q->h16 != NULL) {
+        liquid_free(_q->h16);
+        _q->h16 = NULL;
+    }
+}
+
+// get half-precision coefficient storage flag
+int FIRPFB(_get_coeff_fp16)(FIRPFB() _q)
+{
+    return _q->h16 != NULL;
+}
+
+// get relative error of half-precision coefficients of filter _i,
+// 10 log10( sum |h - h16|^2 / sum |h|^2 ) [dB]; this is available
+// whether or not half-precision storage is enabled
+float FIRPFB(_get_coeff_fp16_error)(FIRPFB()     _q,
+                                    unsigned int _i)
+{
+    if (_i >= _q->num_filters) {
+        fprintf(stderr,"error: firpfb_%s_get_coeff_fp16_error(), filterbank index (%u) exceeds maximum (%u)\n",
+                EXTENSION_FULL, _i, _q->num_filters);
+        exit(1);
+    }
+
+    unsigned int n = _q->h_sub_len*FIRPFB_F16_WIDTH;
+    const float * h = (const float*) &_q->h[_i*_q->h_sub_len];
+    float e2 = 0.0f;
+    float h2 = 0.0f;
+    unsigned int k;
+    for (k=0; k<n; k++) {
+        float e = h[k] - liquid_float16_to_float(liquid_float_to_float16(h[k]));
+        e2 += e*e;
+        h2 += h[k]*h[k];
+    }
+    return h2 > 0.0f ? 10*log10f(e2 / h2) : -INFINITY;
+}
+
 // push sample into firpfb internal buffer
 void FIRPFB(_push)(FIRPFB() _q, TI _x)
 {
@@ -338,9 +511,132 @@ void FIRPFB(_execute)(FIRPFB()     _q,
     WINDOW(_read)(_q->w, &r);
 
     // execute dot product
-    DOTPROD(_execute)(_q->dp[_i], r, _y);
+    FIRPFB(_execute_window)(_q, _i, r, _y);
+}
+
+// execute all filters in the bank on internal buffer and coefficients
+//  _q      : firpfb object
+//  _y      : output samples, one per filter [size: M x 1]
+void FIRPFB(_execute_batch)(FIRPFB() _q,
+                            TO *     _y)
+{
+    // read buffer
+    TI *r;
+    WINDOW(_read)(_q->w, &r);
+
+    unsigned int i;
+    if (_q->h16 != NULL) {
+        // half-precision coefficients: one filter at a time
+        for (i=0; i<_q->num_filters; i++)
+            DOTPROD_F16(_run)(&_q->h16[i*_q->h_sub_len*FIRPFB_F16_WIDTH], r, _q->h_sub_len, &_y[i]);
+    } else {
+        // every filter operates on the same input: load each sample of
+        // the window once for all filters
+        DOTPROD(_execute_batch_shared)(_q->dpb, r, _y);
+    }
 
     // apply scaling factor
+    for (i=0; i<_q->num_filters; i++)
+        _y[i] *= _q->scale;
+}
+
+// push block of samples into filterbank, executing all filters
+// after each sample
+//  _q      : firpfb object
+//  _x      : input samples [size: _n x 1]
+//  _n      : number of input samples
+//  _y      : output samples [size: _n*M x 1]; output j of filter i
+//            is stored at _y[j*M + i]
+void FIRPFB(_execute_block)(FIRPFB()     _q,
+                            TI *         _x,
+                            unsigned int _n,
+                            TO *         _y)
+{
+    unsigned int i, j, k;
+    unsigned int M = _q->num_filters;
+    for (i=0; i<_n; i+=LIQUID_FIRPFB_BLOCK_LEN) {
+        // number of input samples in this block
+        unsigned int num = _n - i < LIQUID_FIRPFB_BLOCK_LEN ? _n - i : LIQUID_FIRPFB_BLOCK_LEN;
+
+        // assemble contiguous span: buffer history followed by input
+        TI * r = FIRPFB(_span_load)(_q, &_x[i], num);
+
+        // compute consecutive outputs of each filter in the bank
+        for (k=0; k<M; k++) {
+            if (_q->h16 != NULL) {
+                const liquid_float16 * h = &_q->h16[k*_q->h_sub_len*FIRPFB_F16_WIDTH];
+                for (j=0; j<num; j++)
+                    DOTPROD_F16(_run)(h, r+j, _q->h_sub_len, &_q->y[j]);
+            } else {
+                DOTPROD(_run_block)(&_q->h[k*_q->h_sub_len], _q->h_sub_len, r, 1, num, _q->y);
+            }
+            for (j=0; j<num; j++)
+                _y[(i+j)*M + k] = _q->y[j] * _q->scale;
+        }
+
+        // retain most recent samples in the buffer
+        FIRPFB(_span_commit)(_q, num);
+    }
+}
+
+//
+// internal methods (block processing by objects built on firpfb)
+//
+
+// read pointer to internal buffer [size: h_sub_len x 1]
+TI * FIRPFB(_get_window)(FIRPFB() _q)
+{
+    TI * r;
+    WINDOW(_read)(_q->w, &r);
+    return r;
+}
+
+// assemble buffer history followed by _n input samples in one
+// contiguous span, so that the buffer contents after pushing sample
+// k of the input start at returned pointer + k; the buffer itself is
+// only updated by FIRPFB(_span_commit)()
+//  _q      : firpfb object
+//  _x      : input samples [size: _n x 1]
+//  _n      : number of input samples, _n <= LIQUID_FIRPFB_BLOCK_LEN
+TI * FIRPFB(_span_load)(FIRPFB()     _q,
+                        TI *         _x,
+                        unsigned int _n)
+{
+    TI * r;
+    WINDOW(_read)(_q->w, &r);
+    memmove(_q->span, r+1, (_q->h_sub_len-1)*sizeof(TI));
+    memmove(_q->span + _q->h_sub_len - 1, _x, _n*sizeof(TI));
+    return _q->span;
+}
+
+// write the _n input samples of the span into the buffer (only the
+// most recent h_sub_len of them are retained)
+void FIRPFB(_span_commit)(FIRPFB()     _q,
+                          unsigned int _n)
+{
+    unsigned int nw = _n < _q->h_sub_len ? _n : _q->h_sub_len;
+    WINDOW(_write)(_q->w, _q->span + _q->h_sub_len - 1 + _n - nw, nw);
+}
+
+// execute filter _i on external buffer _r [size: h_sub_len x 1]
+// without validating the index
+void FIRPFB(_execute_window)(FIRPFB()     _q,
+                             unsigned int _i,
+                             TI *         _r,
+                             TO *         _y)
+{
+    if (_q->h16 != NULL)
+        DOTPROD_F16(_run)(&_q->h16[_i*_q->h_sub_len*FIRPFB_F16_WIDTH], _r, _q->h_sub_len, _y);
+    else
+        DOTPROD(_execute)(_q->dp[_i], _r, _y);
     *_y *= _q->scale;
 }
 
+// convert sub-filter coefficients to half precision (complex
+// coefficients are stored as interleaved real/imaginary pairs)
+void FIRPFB(_update_fp16)(FIRPFB() _q)
+{
+    unsigned int n = _q->num_filters*_q->h_sub_len*FIRPFB_F16_WIDTH;
+    liquid_vectorf_to_float16((const float*)_q->h, n, _q->h16);
+}
+
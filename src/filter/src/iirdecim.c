@@ -30,12 +30,23 @@
 #include <stdlib.h>
 #include <string.h>
 
+// execute half-band decimator (internal)
+void IIRDECIM(_execute_halfband)(IIRDECIM() _q,
+                                 TI *       _x,
+                                 TO *       _y);
+
 // decimator structure
 struct IIRDECIM(_s) {
     unsigned int M;     // decimation factor
 
-    // TODO: use IIR polyphase filterbank
-    IIRFILT() iirfilt;  // filter object
+    IIRFILT() iirfilt;  // filter object (NULL for half-band)
+
+    // polyphase all-pass half-band (M=2): each branch runs at the
+    // output rate so no discarded outputs are computed
+    unsigned int num_ap;    // number of all-pass coefficients
+    float *      ap;        // coefficients, alternating between branches
+    TO *         apx;       // section input state
+    TO *         apy;       // section output state
 };
 
 // create interpolator from external coefficients
@@ -57,8 +68,9 @@ IIRDECIM() IIRDECIM(_create)(unsigned int _M,
     }
 
     // allocate main object memory and set internal parameters
-    IIRDECIM() q = (IIRDECIM()) malloc(sizeof(struct IIRDECIM(_s)));
+    IIRDECIM() q = (IIRDECIM()) liquid_malloc(sizeof(struct IIRDECIM(_s)));
     q->M = _M;
+    q->num_ap = 0;
 
     // create filter
     q->iirfilt = IIRFILT(_create)(_b, _nb, _a, _na);
@@ -103,8 +115,9 @@ IIRDECIM() IIRDECIM(_create_prototype)(unsigned int             _M,
     }
 
     // allocate main object memory and set internal parameters
-    IIRDECIM() q = (IIRDECIM()) malloc(sizeof(struct IIRDECIM(_s)));
+    IIRDECIM() q = (IIRDECIM()) liquid_malloc(sizeof(struct IIRDECIM(_s)));
     q->M = _M;
+    q->num_ap = 0;
 
     // create filter
     q->iirfilt = IIRFILT(_create_prototype)(_ftype, _btype, _format, _order, _fc, _f0, _Ap, _As);
@@ -113,11 +126,43 @@ IIRDECIM() IIRDECIM(_create_prototype)(unsigned int             _M,
     return q;
 }
 
+// create half-band decimator from polyphase all-pass sections
+// (M = 2); the number of sections is the smallest meeting the
+// transition bandwidth and stop-band attenuation
+//  _ft     :   transition bandwidth, centered at 0.25, 0 < _ft < 0.5
+//  _As     :   stop-band attenuation [dB]
+IIRDECIM() IIRDECIM(_create_halfband)(float _ft,
+                                      float _As)
+{
+    // allocate main object memory and set internal parameters
+    IIRDECIM() q = (IIRDECIM()) liquid_malloc(sizeof(struct IIRDECIM(_s)));
+    q->M       = 2;
+    q->iirfilt = NULL;
+
+    // design all-pass branches
+    q->num_ap = iirdes_allpass_halfband_len(_ft, _As);
+    q->ap     = (float *) liquid_malloc(q->num_ap*sizeof(float));
+    q->apx    = (TO *)    liquid_malloc(q->num_ap*sizeof(TO));
+    q->apy    = (TO *)    liquid_malloc(q->num_ap*sizeof(TO));
+    iirdes_allpass_halfband(q->num_ap, _ft, q->ap);
+
+    IIRDECIM(_reset)(q);
+
+    // return decimator object
+    return q;
+}
+
 // destroy interpolator object
 void IIRDECIM(_destroy)(IIRDECIM() _q)
 {
-    IIRFILT(_destroy)(_q->iirfilt);
-    free(_q);
+    if (_q->num_ap > 0) {
+        liquid_free(_q->ap);
+        liquid_free(_q->apx);
+        liquid_free(_q->apy);
+    } else {
+        IIRFILT(_destroy)(_q->iirfilt);
+    }
+    liquid_free(_q);
 }
 
 // print interpolator state
@@ -125,12 +170,24 @@ void IIRDECIM(_print)(IIRDECIM() _q)
 {
     printf("interp():\n");
     printf("    M       :   %u\n", _q->M);
+    if (_q->num_ap > 0) {
+        printf("    half-band all-pass polyphase, %u sections:\n", _q->num_ap);
+        unsigned int i;
+        for (i=0; i<_q->num_ap; i++)
+            printf("      c[%u] = %12.8f (branch %u)\n", i, _q->ap[i], i%2);
+        return;
+    }
     IIRFILT(_print)(_q->iirfilt);
 }
 
 // clear internal state
 void IIRDECIM(_reset)(IIRDECIM() _q)
 {
+    if (_q->num_ap > 0) {
+        memset(_q->apx, 0x00, _q->num_ap*sizeof(TO));
+        memset(_q->apy, 0x00, _q->num_ap*sizeof(TO));
+        return;
+    }
     IIRFILT(_reset)(_q->iirfilt);
 }
 
@@ -143,6 +200,11 @@ void IIRDECIM(_execute)(IIRDECIM()   _q,
                         TI *         _x,
                         TO *         _y)
 {
+    if (_q->num_ap > 0) {
+        IIRDECIM(_execute_halfband)(_q, _x, _y);
+        return;
+    }
+
     TO v; // output value
     unsigned int i;
     for (i=0; i<_q->M; i++) {
@@ -178,6 +240,29 @@ void IIRDECIM(_execute_block)(IIRDECIM()   _q,
 float IIRDECIM(_groupdelay)(IIRDECIM() _q,
                             float      _fc)
 {
+    if (_q->num_ap > 0)
+        return iirdes_allpass_halfband_groupdelay(_q->ap, _q->num_ap, _fc);
     return IIRFILT(_groupdelay)(_q->iirfilt, _fc);
 }
 
+// execute half-band decimator: the later input sample runs through
+// branch A0 and the earlier through A1, each first-order section being
+//   v = c*(u - v[-1]) + u[-1]
+// at the output rate
+//  _q      :   decimator object
+//  _x      :   input sample array [size: 2 x 1]
+//  _y      :   output sample pointer
+void IIRDECIM(_execute_halfband)(IIRDECIM() _q,
+                                 TI *       _x,
+                                 TO *       _y)
+{
+    TO v[2] = {_x[1], _x[0]};
+    unsigned int i;
+    for (i=0; i<_q->num_ap; i++) {
+        TO u = v[i%2];
+        v[i%2] = _q->ap[i]*(u - _q->apy[i]) + _q->apx[i];
+        _q->apx[i] = u;
+        _q->apy[i] = v[i%2];
+    }
+    *_y = 0.5f*(v[0] + v[1]);
+}
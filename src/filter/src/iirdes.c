@@ -703,3 +703,133 @@ int iirdes_isstable(float * _b,
 }
 
 
+
+// compute elliptic selectivity and nome for a half-band filter with
+// transition bandwidth _ft, centered at a quarter of the sample rate
+//  _ft     :   transition bandwidth
+//  _k      :   output selectivity factor
+//  _q      :   output nome
+static void iirdes_allpass_halfband_nome(float    _ft,
+                                         double * _k,
+                                         double * _q)
+{
+    double t  = tan((1.0 - 2.0*_ft) * M_PI / 4.0);
+    double k  = t*t;
+    double kp = pow(1.0 - k*k, 0.25);
+    double e  = 0.5*(1.0 - kp)/(1.0 + kp);
+    double e4 = e*e*e*e;
+    *_k = k;
+    *_q = e*(1.0 + e4*(2.0 + e4*(15.0 + 150.0*e4)));
+}
+
+// compute number of coefficients for a polyphase all-pass half-band
+// filter meeting a transition bandwidth and stop-band attenuation
+//  _ft     :   transition bandwidth, centered at 0.25, 0 < _ft < 0.5
+//  _As     :   stop-band attenuation [dB], _As > 0
+unsigned int iirdes_allpass_halfband_len(float _ft,
+                                         float _As)
+{
+    // validate input
+    if (_ft <= 0.0f || _ft >= 0.5f) {
+        fprintf(stderr,"error: iirdes_allpass_halfband_len(), transition bandwidth must be in (0,0.5)\n");
+        exit(1);
+    } else if (_As <= 0.0f) {
+        fprintf(stderr,"error: iirdes_allpass_halfband_len(), stop-band attenuation must be greater than zero\n");
+        exit(1);
+    }
+
+    double k, q;
+    iirdes_allpass_halfband_nome(_ft, &k, &q);
+
+    // odd elliptic order required for attenuation
+    double d = pow(10.0, -_As/10.0);
+    double a = d / (1.0 - d);
+    unsigned int order = (unsigned int) ceil( log(a*a/16.0) / log(q) );
+    if ((order % 2) == 0) order++;
+    if (order < 3)        order = 3;
+
+    return (order - 1) / 2;
+}
+
+// design polyphase all-pass half-band filter (elliptic prototype)
+//  _n      :   number of coefficients
+//  _ft     :   transition bandwidth, centered at 0.25, 0 < _ft < 0.5
+//  _c      :   output all-pass coefficients [size: _n x 1]
+void iirdes_allpass_halfband(unsigned int _n,
+                             float        _ft,
+                             float *      _c)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: iirdes_allpass_halfband(), number of coefficients must be greater than zero\n");
+        exit(1);
+    } else if (_ft <= 0.0f || _ft >= 0.5f) {
+        fprintf(stderr,"error: iirdes_allpass_halfband(), transition bandwidth must be in (0,0.5)\n");
+        exit(1);
+    }
+
+    double k, q;
+    iirdes_allpass_halfband_nome(_ft, &k, &q);
+    unsigned int order = 2*_n + 1;
+
+    unsigned int i, j;
+    for (i=0; i<_n; i++) {
+        double c = i + 1;
+
+        // theta-function series for elliptic pole locations
+        double num = 0, den = 0, v;
+        double s = 1.0;
+        for (j=0; j<64; j++) {
+            v = pow(q, (double)(j*(j+1))) * sin((2*j+1)*c*M_PI/order) * s;
+            num += v;
+            s = -s;
+            if (fabs(v) < 1e-30) break;
+        }
+        s = -1.0;
+        for (j=1; j<64; j++) {
+            v = pow(q, (double)(j*j)) * cos(2*j*c*M_PI/order) * s;
+            den += v;
+            s = -s;
+            if (fabs(v) < 1e-30) break;
+        }
+        num *= pow(q, 0.25);
+        den += 0.5;
+
+        double w  = num / den;
+        double w2 = w*w;
+        double x  = sqrt((1.0 - w2*k)*(1.0 - w2/k)) / (1.0 + w2);
+        _c[i] = (float) ((1.0 - x) / (1.0 + x));
+    }
+}
+
+// compute frequency response of polyphase all-pass half-band filter
+//  _c      :   all-pass coefficients [size: _n x 1]
+//  _n      :   number of coefficients
+//  _f      :   frequency
+float complex iirdes_allpass_halfband_freqresponse(float *      _c,
+                                                   unsigned int _n,
+                                                   float        _f)
+{
+    float complex z2 = cexpf(-_Complex_I*4.0f*M_PI*_f);   // z^-2
+    float complex a[2] = {1.0f, 1.0f};
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        a[i%2] *= (_c[i] + z2) / (1.0f + _c[i]*z2);
+
+    return 0.5f*(a[0] + cexpf(-_Complex_I*2.0f*M_PI*_f)*a[1]);
+}
+
+// compute group delay of polyphase all-pass half-band filter from the
+// phase slope of its frequency response
+//  _c      :   all-pass coefficients [size: _n x 1]
+//  _n      :   number of coefficients
+//  _f      :   frequency
+float iirdes_allpass_halfband_groupdelay(float *      _c,
+                                         unsigned int _n,
+                                         float        _f)
+{
+    float df = 1e-4f;
+    float complex h0 = iirdes_allpass_halfband_freqresponse(_c, _n, _f - df);
+    float complex h1 = iirdes_allpass_halfband_freqresponse(_c, _n, _f + df);
+    return -cargf(h1*conjf(h0)) / (2.0f*M_PI*2.0f*df);
+}
@@ -91,15 +91,15 @@ IIRFILT() IIRFILT(_create)(TC *         _b,
     }
 
     // create structure and initialize
-    IIRFILT() q = (IIRFILT()) malloc(sizeof(struct IIRFILT(_s)));
+    IIRFILT() q = (IIRFILT()) liquid_malloc(sizeof(struct IIRFILT(_s)));
     q->nb = _nb;
     q->na = _na;
     q->n = (q->na > q->nb) ? q->na : q->nb;
     q->type = IIRFILT_TYPE_NORM;
 
     // allocate memory for numerator, denominator
-    q->a = (TC *) malloc((q->na)*sizeof(TC));
-    q->b = (TC *) malloc((q->nb)*sizeof(TC));
+    q->a = (TC *) liquid_malloc((q->na)*sizeof(TC));
+    q->b = (TC *) liquid_malloc((q->nb)*sizeof(TC));
 
     // normalize coefficients to _a[0]
     TC a0 = _a[0];
@@ -121,7 +121,7 @@ IIRFILT() IIRFILT(_create)(TC *         _b,
 #endif
 
     // create buffer and initialize
-    q->v = (TI *) malloc((q->n)*sizeof(TI));
+    q->v = (TI *) liquid_malloc((q->n)*sizeof(TI));
 
 #if LIQUID_IIRFILT_USE_DOTPROD
     q->dpa = DOTPROD(_create)(q->a+1, q->na-1);
@@ -157,15 +157,15 @@ IIRFILT() IIRFILT(_create_sos)(TC *         _B,
     }
 
     // create structure and initialize
-    IIRFILT() q = (IIRFILT()) malloc(sizeof(struct IIRFILT(_s)));
+    IIRFILT() q = (IIRFILT()) liquid_malloc(sizeof(struct IIRFILT(_s)));
     q->type = IIRFILT_TYPE_SOS;
     q->nsos = _nsos;
-    q->qsos = (IIRFILTSOS()*) malloc( (q->nsos)*sizeof(IIRFILTSOS()) );
+    q->qsos = (IIRFILTSOS()*) liquid_malloc( (q->nsos)*sizeof(IIRFILTSOS()) );
     q->n = _nsos * 2;
 
     // create coefficients array and copy over
-    q->b = (TC *) malloc(3*(q->nsos)*sizeof(TC));
-    q->a = (TC *) malloc(3*(q->nsos)*sizeof(TC));
+    q->b = (TC *) liquid_malloc(3*(q->nsos)*sizeof(TC));
+    q->a = (TC *) liquid_malloc(3*(q->nsos)*sizeof(TC));
     memmove(q->b, _B, 3*(q->nsos)*sizeof(TC));
     memmove(q->a, _A, 3*(q->nsos)*sizeof(TC));
 
@@ -417,20 +417,20 @@ void IIRFILT(_destroy)(IIRFILT() _q)
     DOTPROD(_destroy)(_q->dpa);
     DOTPROD(_destroy)(_q->dpb);
 #endif
-    free(_q->b);
-    free(_q->a);
+    liquid_free(_q->b);
+    liquid_free(_q->a);
     // if filter is comprised of cascaded second-order sections,
     // delete sub-filters separately
     if (_q->type == IIRFILT_TYPE_SOS) {
         unsigned int i;
         for (i=0; i<_q->nsos; i++)
             IIRFILTSOS(_destroy)(_q->qsos[i]);
-        free(_q->qsos);
+        liquid_free(_q->qsos);
     } else {
-        free(_q->v);
+        liquid_free(_q->v);
     }
 
-    free(_q);
+    liquid_free(_q);
 }
 
 // print iirfilt object internals
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Multi-channel infinite impulse response filter (cascaded second-order
+// sections, transposed direct form II)
+//
+// Independent channels sharing one set of real coefficients are
+// interleaved across fixed-width lanes so that each section updates
+// LIQUID_IIRFILTMC_LANES channel states at once. Complex channels
+// occupy two lanes (real and imaginary parts). The block method runs
+// each section over a span of samples before moving to the next, so
+// coefficients and states stay in registers for the whole span.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+// defined:
+//  IIRFILTMC()     name-mangling macro
+//  TO              output type
+//  TC              coefficients type (real)
+//  TI              input type
+
+// number of real lanes processed together
+#define LIQUID_IIRFILTMC_LANES      (8)
+
+// number of samples per span in block execution
+#define LIQUID_IIRFILTMC_BLOCK_LEN  (64)
+
+struct IIRFILTMC(_s) {
+    unsigned int nsos;          // number of second-order sections
+    unsigned int num_channels;  // number of channels
+    unsigned int num_lanes;     // number of real lanes (1 or 2 per channel)
+    unsigned int num_groups;    // number of lane groups
+
+    float * b;                  // feed-forward coefficients [size: nsos x 3]
+    float * a;                  // feed-back coefficients a1,a2 [size: nsos x 2]
+    float * s;                  // section states [size: num_groups x nsos x 2 x LANES]
+    float * buf;                // block span [size: BLOCK_LEN x LANES]
+};
+
+// internal: load/store one sample of a lane group, zero-padding lanes
+// beyond the last channel
+void IIRFILTMC(_load)(IIRFILTMC() _q, unsigned int _g, float * _x, float * _v);
+void IIRFILTMC(_store)(IIRFILTMC() _q, unsigned int _g, float * _v, float * _y);
+
+// create multi-channel IIR filter using 2nd-order sections
+//  _B              : feed-forward coefficients [size: _nsos x 3]
+//  _A              : feed-back coefficients    [size: _nsos x 3]
+//  _nsos           : number of second-order sections
+//  _num_channels   : number of independent channels
+IIRFILTMC() IIRFILTMC(_create_sos)(TC *         _B,
+                                   TC *         _A,
+                                   unsigned int _nsos,
+                                   unsigned int _num_channels)
+{
+    // validate input
+    if (_nsos == 0) {
+        fprintf(stderr,"error: iirfiltmc_%s_create_sos(), filter must have at least one 2nd-order section\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_num_channels == 0) {
+        fprintf(stderr,"error: iirfiltmc_%s_create_sos(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create filter object
+    IIRFILTMC() q = (IIRFILTMC()) liquid_malloc(sizeof(struct IIRFILTMC(_s)));
+    q->nsos         = _nsos;
+    q->num_channels = _num_channels;
+#if TI_COMPLEX
+    q->num_lanes    = 2*_num_channels;
+#else
+    q->num_lanes    = _num_channels;
+#endif
+    q->num_groups   = (q->num_lanes + LIQUID_IIRFILTMC_LANES - 1) / LIQUID_IIRFILTMC_LANES;
+
+    // copy coefficients, normalizing by a0
+    q->b = (float *) liquid_malloc(3*q->nsos*sizeof(float));
+    q->a = (float *) liquid_malloc(2*q->nsos*sizeof(float));
+    unsigned int i;
+    for (i=0; i<q->nsos; i++) {
+        float a0 = _A[3*i+0];
+        q->b[3*i+0] = _B[3*i+0] / a0;
+        q->b[3*i+1] = _B[3*i+1] / a0;
+        q->b[3*i+2] = _B[3*i+2] / a0;
+        q->a[2*i+0] = _A[3*i+1] / a0;
+        q->a[2*i+1] = _A[3*i+2] / a0;
+    }
+
+    // allocate state and block span
+    q->s   = (float *) liquid_malloc(q->num_groups*q->nsos*2*LIQUID_IIRFILTMC_LANES*sizeof(float));
+    q->buf = (float *) liquid_malloc(LIQUID_IIRFILTMC_BLOCK_LEN*LIQUID_IIRFILTMC_LANES*sizeof(float));
+
+    // reset filter state and return
+    IIRFILTMC(_reset)(q);
+    return q;
+}
+
+// create multi-channel IIR filter from design template (second-order
+// sections)
+//  _ftype          : filter type (e.g. LIQUID_IIRDES_BUTTER)
+//  _btype          : band type (e.g. LIQUID_IIRDES_BANDPASS)
+//  _order          : filter order
+//  _fc             : low-pass prototype cut-off frequency
+//  _f0             : center frequency (band-pass, band-stop)
+//  _Ap             : pass-band ripple in dB
+//  _As             : stop-band ripple in dB
+//  _num_channels   : number of independent channels
+IIRFILTMC() IIRFILTMC(_create_prototype)(liquid_iirdes_filtertype _ftype,
+                                         liquid_iirdes_bandtype   _btype,
+                                         unsigned int             _order,
+                                         float                    _fc,
+                                         float                    _f0,
+                                         float                    _Ap,
+                                         float                    _As,
+                                         unsigned int             _num_channels)
+{
+    // derived values : number of second-order sections (order
+    // doubles for band-pass, band-stop filters)
+    unsigned int N = _order;
+    if (_btype == LIQUID_IIRDES_BANDPASS ||
+        _btype == LIQUID_IIRDES_BANDSTOP)
+    {
+        N *= 2;
+    }
+    unsigned int r = N%2;       // odd/even order
+    unsigned int L = (N-r)/2;   // filter semi-length
+
+    // design filter (compute coefficients)
+    float B[3*(L+r)];
+    float A[3*(L+r)];
+    liquid_iirdes(_ftype, _btype, LIQUID_IIRDES_SOS, _order, _fc, _f0, _Ap, _As, B, A);
+
+    // move coefficients to type-specific arrays
+    TC Bc[3*(L+r)];
+    TC Ac[3*(L+r)];
+    unsigned int i;
+    for (i=0; i<3*(L+r); i++) {
+        Bc[i] = B[i];
+        Ac[i] = A[i];
+    }
+
+    return IIRFILTMC(_create_sos)(Bc, Ac, L+r, _num_channels);
+}
+
+// create multi-channel DC-blocking filter
+//  _alpha          : normalized filter bandwidth
+//  _num_channels   : number of independent channels
+IIRFILTMC() IIRFILTMC(_create_dc_blocker)(float        _alpha,
+                                          unsigned int _num_channels)
+{
+    // first-order section as in iirfilt_xxxt_create_dc_blocker()
+    TC B[3] = {1.0f, -1.0f,          0.0f};
+    TC A[3] = {1.0f, -1.0f + _alpha, 0.0f};
+    return IIRFILTMC(_create_sos)(B, A, 1, _num_channels);
+}
+
+// destroy multi-channel IIR filter object
+void IIRFILTMC(_destroy)(IIRFILTMC() _q)
+{
+    liquid_free(_q->b);
+    liquid_free(_q->a);
+    liquid_free(_q->s);
+    liquid_free(_q->buf);
+    liquid_free(_q);
+}
+
+// print multi-channel IIR filter object properties to stdout
+void IIRFILTMC(_print)(IIRFILTMC() _q)
+{
+    printf("iirfiltmc_%s: [channels=%u, sos=%u, lanes=%u x %u]\n", EXTENSION_FULL,
+            _q->num_channels, _q->nsos, _q->num_groups, LIQUID_IIRFILTMC_LANES);
+    unsigned int i;
+    for (i=0; i<_q->nsos; i++) {
+        printf("  %3u : b = {%12.8f,%12.8f,%12.8f}, a = {%12.8f,%12.8f,%12.8f}\n", i,
+                _q->b[3*i+0], _q->b[3*i+1], _q->b[3*i+2],
+                1.0f,         _q->a[2*i+0], _q->a[2*i+1]);
+    }
+}
+
+// clear/reset multi-channel IIR filter object internals
+void IIRFILTMC(_reset)(IIRFILTMC() _q)
+{
+    memset(_q->s, 0, _q->num_groups*_q->nsos*2*LIQUID_IIRFILTMC_LANES*sizeof(float));
+}
+
+// get number of channels
+unsigned int IIRFILTMC(_get_num_channels)(IIRFILTMC() _q)
+{
+    return _q->num_channels;
+}
+
+// compute filter output for one sample on every channel
+//  _q      : filter object
+//  _x      : input sample for each channel [size: num_channels x 1]
+//  _y      : output sample for each channel [size: num_channels x 1]
+void IIRFILTMC(_execute)(IIRFILTMC() _q,
+                         TI *        _x,
+                         TO *        _y)
+{
+    float v[LIQUID_IIRFILTMC_LANES];
+    unsigned int g, k, l;
+    for (g=0; g<_q->num_groups; g++) {
+        IIRFILTMC(_load)(_q, g, (float*)_x, v);
+
+        float * s = _q->s + g*_q->nsos*2*LIQUID_IIRFILTMC_LANES;
+        for (k=0; k<_q->nsos; k++) {
+            float b0 = _q->b[3*k+0], b1 = _q->b[3*k+1], b2 = _q->b[3*k+2];
+            float a1 = _q->a[2*k+0], a2 = _q->a[2*k+1];
+            float * s1 = s + (2*k+0)*LIQUID_IIRFILTMC_LANES;
+            float * s2 = s + (2*k+1)*LIQUID_IIRFILTMC_LANES;
+            for (l=0; l<LIQUID_IIRFILTMC_LANES; l++) {
+                float t = b0*v[l] + s1[l];
+                s1[l] = b1*v[l] - a1*t + s2[l];
+                s2[l] = b2*v[l] - a2*t;
+                v[l]  = t;
+            }
+        }
+
+        IIRFILTMC(_store)(_q, g, v, (float*)_y);
+    }
+}
+
+// execute the filter on a block of samples, channel-interleaved; the
+// input and output buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: _n x num_channels]
+//  _n      : number of samples per channel
+//  _y      : output array [size: _n x num_channels]
+void IIRFILTMC(_execute_block)(IIRFILTMC()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    float * x = (float*)_x;
+    float * y = (float*)_y;
+    unsigned int i, j, g, k, l;
+    for (i=0; i<_n; i+=LIQUID_IIRFILTMC_BLOCK_LEN) {
+        unsigned int num = _n - i < LIQUID_IIRFILTMC_BLOCK_LEN ? _n - i : LIQUID_IIRFILTMC_BLOCK_LEN;
+        for (g=0; g<_q->num_groups; g++) {
+            // gather span for this lane group
+            for (j=0; j<num; j++)
+                IIRFILTMC(_load)(_q, g, x + (i+j)*_q->num_lanes, _q->buf + j*LIQUID_IIRFILTMC_LANES);
+
+            // run each section over the whole span
+            float * s = _q->s + g*_q->nsos*2*LIQUID_IIRFILTMC_LANES;
+            for (k=0; k<_q->nsos; k++) {
+                float b0 = _q->b[3*k+0], b1 = _q->b[3*k+1], b2 = _q->b[3*k+2];
+                float a1 = _q->a[2*k+0], a2 = _q->a[2*k+1];
+                float s1[LIQUID_IIRFILTMC_LANES];
+                float s2[LIQUID_IIRFILTMC_LANES];
+                memmove(s1, s + (2*k+0)*LIQUID_IIRFILTMC_LANES, sizeof(s1));
+                memmove(s2, s + (2*k+1)*LIQUID_IIRFILTMC_LANES, sizeof(s2));
+                for (j=0; j<num; j++) {
+                    float * v = _q->buf + j*LIQUID_IIRFILTMC_LANES;
+                    for (l=0; l<LIQUID_IIRFILTMC_LANES; l++) {
+                        float t = b0*v[l] + s1[l];
+                        s1[l] = b1*v[l] - a1*t + s2[l];
+                        s2[l] = b2*v[l] - a2*t;
+                        v[l]  = t;
+                    }
+                }
+                memmove(s + (2*k+0)*LIQUID_IIRFILTMC_LANES, s1, sizeof(s1));
+                memmove(s + (2*k+1)*LIQUID_IIRFILTMC_LANES, s2, sizeof(s2));
+            }
+
+            // scatter span to output
+            for (j=0; j<num; j++)
+                IIRFILTMC(_store)(_q, g, _q->buf + j*LIQUID_IIRFILTMC_LANES, y + (i+j)*_q->num_lanes);
+        }
+    }
+}
+
+// load lane group _g of one sample [size: num_lanes x 1] into _v
+void IIRFILTMC(_load)(IIRFILTMC() _q,
+                      unsigned int _g,
+                      float *      _x,
+                      float *      _v)
+{
+    unsigned int l0 = _g*LIQUID_IIRFILTMC_LANES;
+    unsigned int nl = _q->num_lanes - l0;
+    if (nl >= LIQUID_IIRFILTMC_LANES) {
+        memmove(_v, _x + l0, LIQUID_IIRFILTMC_LANES*sizeof(float));
+    } else {
+        memmove(_v, _x + l0, nl*sizeof(float));
+        memset(_v + nl, 0, (LIQUID_IIRFILTMC_LANES - nl)*sizeof(float));
+    }
+}
+
+// store valid lanes of group _g from _v into one sample [size: num_lanes x 1]
+void IIRFILTMC(_store)(IIRFILTMC() _q,
+                       unsigned int _g,
+                       float *      _v,
+                       float *      _y)
+{
+    unsigned int l0 = _g*LIQUID_IIRFILTMC_LANES;
+    unsigned int nl = _q->num_lanes - l0;
+    if (nl > LIQUID_IIRFILTMC_LANES)
+        nl = LIQUID_IIRFILTMC_LANES;
+    memmove(_y + l0, _v, nl*sizeof(float));
+}
+
@@ -40,7 +40,7 @@ IIRFILTSOS() IIRFILTSOS(_create)(TC * _b,
                                  TC * _a)
 {
     // create filter object
-    IIRFILTSOS() q = (IIRFILTSOS()) malloc(sizeof(struct IIRFILTSOS(_s)));
+    IIRFILTSOS() q = (IIRFILTSOS()) liquid_malloc(sizeof(struct IIRFILTSOS(_s)));
 
     // set the internal coefficients
     IIRFILTSOS(_set_coefficients)(q, _b, _a);
@@ -79,7 +79,7 @@ void IIRFILTSOS(_set_coefficients)(IIRFILTSOS() _q,
 // destroy iirfiltsos object, freeing all internal memory
 void IIRFILTSOS(_destroy)(IIRFILTSOS() _q)
 {
-    free(_q);
+    liquid_free(_q);
 }
 
 // print iirfiltsos object properties to stdout
@@ -31,9 +31,14 @@
 struct IIRINTERP(_s) {
     unsigned int M;     // interpolation factor
 
-    // TODO: use IIR polyphase filterbank
-    IIRFILT() iirfilt;  // filter object
-
+    IIRFILT() iirfilt;  // filter object (NULL for half-band)
+
+    // polyphase all-pass half-band (M=2): each branch runs at the
+    // input rate so no zero-valued inputs are filtered
+    unsigned int num_ap;    // number of all-pass coefficients
+    float *      ap;        // coefficients, alternating between branches
+    TO *         apx;       // section input state
+    TO *         apy;       // section output state
 };
 
 // create interpolator from external coefficients
@@ -55,8 +60,9 @@ IIRINTERP() IIRINTERP(_create)(unsigned int _M,
     }
 
     // allocate main object memory and set internal parameters
-    IIRINTERP() q = (IIRINTERP()) malloc(sizeof(struct IIRINTERP(_s)));
+    IIRINTERP() q = (IIRINTERP()) liquid_malloc(sizeof(struct IIRINTERP(_s)));
     q->M = _M;
+    q->num_ap = 0;
 
     // create filter
     q->iirfilt = IIRFILT(_create)(_b, _nb, _a, _na);
@@ -101,8 +107,9 @@ IIRINTERP() IIRINTERP(_create_prototype)(unsigned int _M,
     }
 
     // allocate main object memory and set internal parameters
-    IIRINTERP() q = (IIRINTERP()) malloc(sizeof(struct IIRINTERP(_s)));
+    IIRINTERP() q = (IIRINTERP()) liquid_malloc(sizeof(struct IIRINTERP(_s)));
     q->M = _M;
+    q->num_ap = 0;
 
     // create filter
     q->iirfilt = IIRFILT(_create_prototype)(_ftype, _btype, _format, _order, _fc, _f0, _Ap, _As);
@@ -111,11 +118,43 @@ IIRINTERP() IIRINTERP(_create_prototype)(unsigned int _M,
     return q;
 }
 
+// create half-band interpolator from polyphase all-pass sections
+// (M = 2); the number of sections is the smallest meeting the
+// transition bandwidth and stop-band attenuation
+//  _ft     :   transition bandwidth, centered at 0.25, 0 < _ft < 0.5
+//  _As     :   stop-band attenuation [dB]
+IIRINTERP() IIRINTERP(_create_halfband)(float _ft,
+                                        float _As)
+{
+    // allocate main object memory and set internal parameters
+    IIRINTERP() q = (IIRINTERP()) liquid_malloc(sizeof(struct IIRINTERP(_s)));
+    q->M       = 2;
+    q->iirfilt = NULL;
+
+    // design all-pass branches
+    q->num_ap = iirdes_allpass_halfband_len(_ft, _As);
+    q->ap     = (float *) liquid_malloc(q->num_ap*sizeof(float));
+    q->apx    = (TO *)    liquid_malloc(q->num_ap*sizeof(TO));
+    q->apy    = (TO *)    liquid_malloc(q->num_ap*sizeof(TO));
+    iirdes_allpass_halfband(q->num_ap, _ft, q->ap);
+
+    IIRINTERP(_reset)(q);
+
+    // return interpolator object
+    return q;
+}
+
 // destroy interpolator object
 void IIRINTERP(_destroy)(IIRINTERP() _q)
 {
-    IIRFILT(_destroy)(_q->iirfilt);
-    free(_q);
+    if (_q->num_ap > 0) {
+        liquid_free(_q->ap);
+        liquid_free(_q->apx);
+        liquid_free(_q->apy);
+    } else {
+        IIRFILT(_destroy)(_q->iirfilt);
+    }
+    liquid_free(_q);
 }
 
 // print interpolator state
@@ -123,12 +162,24 @@ void IIRINTERP(_print)(IIRINTERP() _q)
 {
     printf("interp():\n");
     printf("    M       :   %u\n", _q->M);
+    if (_q->num_ap > 0) {
+        printf("    half-band all-pass polyphase, %u sections:\n", _q->num_ap);
+        unsigned int i;
+        for (i=0; i<_q->num_ap; i++)
+            printf("      c[%u] = %12.8f (branch %u)\n", i, _q->ap[i], i%2);
+        return;
+    }
     IIRFILT(_print)(_q->iirfilt);
 }
 
 // clear internal state
 void IIRINTERP(_reset)(IIRINTERP() _q)
 {
+    if (_q->num_ap > 0) {
+        memset(_q->apx, 0x00, _q->num_ap*sizeof(TO));
+        memset(_q->apy, 0x00, _q->num_ap*sizeof(TO));
+        return;
+    }
     IIRFILT(_reset)(_q->iirfilt);
 }
 
@@ -140,8 +191,23 @@ void IIRINTERP(_execute)(IIRINTERP() _q,
                          TI          _x,
                          TO *        _y)
 {
-    // TODO: use iirpfb
     unsigned int i;
+    if (_q->num_ap > 0) {
+        // half-band: both branches see the input, each producing one
+        // output phase
+        TO v[2] = {_x, _x};
+        for (i=0; i<_q->num_ap; i++) {
+            TO u = v[i%2];
+            v[i%2] = _q->ap[i]*(u - _q->apy[i]) + _q->apx[i];
+            _q->apx[i] = u;
+            _q->apy[i] = v[i%2];
+        }
+        _y[0] = v[0];
+        _y[1] = v[1];
+        return;
+    }
+
+
     for (i=0; i<_q->M; i++)
         IIRFILT(_execute)(_q->iirfilt, i==0 ? _x : 0.0f, &_y[i]);
 }
@@ -169,6 +235,8 @@ void IIRINTERP(_execute_block)(IIRINTERP()  _q,
 float IIRINTERP(_groupdelay)(IIRINTERP() _q,
                              float       _fc)
 {
+    if (_q->num_ap > 0)
+        return iirdes_allpass_halfband_groupdelay(_q->ap, _q->num_ap, _fc) / 2.0f;
     return IIRFILT(_groupdelay)(_q->iirfilt, _fc) / (float) (_q->M);
 }
 
@@ -88,7 +88,7 @@ MSRESAMP() MSRESAMP(_create)(float _r,
     }
 
     // create object
-    MSRESAMP() q = (MSRESAMP()) malloc(sizeof(struct MSRESAMP(_s)));
+    MSRESAMP() q = (MSRESAMP()) liquid_malloc(sizeof(struct MSRESAMP(_s)));
 
     // set internal properties
     q->rate = _r;       // composite rate
@@ -121,7 +121,7 @@ MSRESAMP() MSRESAMP(_create)(float _r,
 
     // allocate memory for buffer
     q->buffer_len = 4 + (1 << q->num_halfband_stages);
-    q->buffer = (T*) malloc( q->buffer_len*sizeof(T) );
+    q->buffer = (T*) liquid_malloc( q->buffer_len*sizeof(T) );
 
     // create single multi-stage half-band resampler object
     // TODO: compute appropriate cut-off frequency
@@ -144,7 +144,7 @@ MSRESAMP() MSRESAMP(_create)(float _r,
 void MSRESAMP(_destroy)(MSRESAMP() _q)
 {
     // free buffer
-    free(_q->buffer);
+    liquid_free(_q->buffer);
 
     // destroy arbitrary resampler
     RESAMP(_destroy)(_q->arbitrary_resamp);
@@ -153,7 +153,7 @@ void MSRESAMP(_destroy)(MSRESAMP() _q)
     MSRESAMP2(_destroy)(_q->halfband_resamp);
 
     // destroy main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print msresamp object internals
@@ -243,6 +243,12 @@ float MSRESAMP(_get_delay)(MSRESAMP() _q)
     return 0.0f;
 }
 
+// get composite resampling rate (output/input)
+float MSRESAMP(_get_rate)(MSRESAMP() _q)
+{
+    return _q->rate;
+}
+
 // execute multi-stage resampler
 //  _q      :   msresamp object
 //  _x      :   input sample array
@@ -31,6 +31,10 @@
 
 #include "liquid.internal.h"
 
+// number of samples at the widest rate handled per pass of the block
+// cascade
+#define LIQUID_MSRESAMP2_BLOCK_LEN  (1024)
+
 // 
 // forward declaration of internal methods
 //
@@ -54,6 +58,7 @@ struct MSRESAMP2(_s) {
     RESAMP2() * resamp2;        // array of half-band resamplers
     T * buffer0;                // buffer[0]
     T * buffer1;                // buffer[1]
+    unsigned int buffer_len;    // buffer length: max(M, LIQUID_MSRESAMP2_BLOCK_LEN)
     unsigned int buffer_index;  // index of buffer
     float zeta;                 // scaling factor
 };
@@ -111,7 +116,7 @@ MSRESAMP2() MSRESAMP2(_create)(int          _type,
     unsigned int i;
 
     // create object
-    MSRESAMP2() q = (MSRESAMP2()) malloc(sizeof(struct MSRESAMP2(_s)));
+    MSRESAMP2() q = (MSRESAMP2()) liquid_malloc(sizeof(struct MSRESAMP2(_s)));
 
     // set internal properties
     q->type       = _type == LIQUID_RESAMP_INTERP ? LIQUID_RESAMP_INTERP : LIQUID_RESAMP_DECIM;
@@ -124,15 +129,16 @@ MSRESAMP2() MSRESAMP2(_create)(int          _type,
     q->M    = 1 << q->num_stages;
     q->zeta = 1.0f / (float)(q->M);
 
-    // allocate memory for buffers
-    q->buffer0 = (T*) malloc( q->M * sizeof(T) );
-    q->buffer1 = (T*) malloc( q->M * sizeof(T) );
+    // allocate memory for buffers, large enough for the block cascade
+    q->buffer_len = q->M > LIQUID_MSRESAMP2_BLOCK_LEN ? q->M : LIQUID_MSRESAMP2_BLOCK_LEN;
+    q->buffer0 = (T*) liquid_malloc( q->buffer_len * sizeof(T) );
+    q->buffer1 = (T*) liquid_malloc( q->buffer_len * sizeof(T) );
 
     // allocate arrays for half-band resampler parameters
-    q->fc_stage = (float*)        malloc(q->num_stages*sizeof(float)       );
-    q->f0_stage = (float*)        malloc(q->num_stages*sizeof(float)       );
-    q->As_stage = (float*)        malloc(q->num_stages*sizeof(float)       );
-    q->m_stage  = (unsigned int*) malloc(q->num_stages*sizeof(unsigned int));
+    q->fc_stage = (float*)        liquid_malloc(q->num_stages*sizeof(float)       );
+    q->f0_stage = (float*)        liquid_malloc(q->num_stages*sizeof(float)       );
+    q->As_stage = (float*)        liquid_malloc(q->num_stages*sizeof(float)       );
+    q->m_stage  = (unsigned int*) liquid_malloc(q->num_stages*sizeof(unsigned int));
 
     // determine half-band resampler parameters
     float fc = q->fc;
@@ -154,7 +160,7 @@ MSRESAMP2() MSRESAMP2(_create)(int          _type,
     }
 
     // create half-band resampler objects
-    q->resamp2 = (RESAMP2()*) malloc(q->num_stages*sizeof(RESAMP2()));
+    q->resamp2 = (RESAMP2()*) liquid_malloc(q->num_stages*sizeof(RESAMP2()));
     for (i=0; i<q->num_stages; i++) {
         // create half-band resampler
         q->resamp2[i] = RESAMP2(_create)(q->m_stage[i],
@@ -173,14 +179,14 @@ MSRESAMP2() MSRESAMP2(_create)(int          _type,
 void MSRESAMP2(_destroy)(MSRESAMP2() _q)
 {
     // free buffers
-    free(_q->buffer0);
-    free(_q->buffer1);
+    liquid_free(_q->buffer0);
+    liquid_free(_q->buffer1);
 
     // free half-band resampler design parameter arrays
-    free(_q->fc_stage);
-    free(_q->f0_stage);
-    free(_q->As_stage);
-    free(_q->m_stage);
+    liquid_free(_q->fc_stage);
+    liquid_free(_q->f0_stage);
+    liquid_free(_q->As_stage);
+    liquid_free(_q->m_stage);
 
     // destroy/free half-band resampler objects
     unsigned int i;
@@ -188,10 +194,10 @@ void MSRESAMP2(_destroy)(MSRESAMP2() _q)
         RESAMP2(_destroy)(_q->resamp2[i]);
 
     // free half-band resampler array
-    free(_q->resamp2);
+    liquid_free(_q->resamp2);
 
     // destroy main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print msresamp2 object internals
@@ -279,6 +285,73 @@ void MSRESAMP2(_execute)(MSRESAMP2() _q,
     }
 }
 
+// execute multi-stage resampler on a block of samples; each pass
+// covers up to LIQUID_MSRESAMP2_BLOCK_LEN samples at the widest rate
+// and runs every stage over its share before moving on, so early
+// stages see large blocks and intermediate results stay in the two
+// internal buffers
+//  _q      : msresamp object
+//  _x      : input sample array
+//  _n      : number of blocks of M samples (decimator) or input
+//            samples (interpolator)
+//  _y      : output sample array
+void MSRESAMP2(_execute_block)(MSRESAMP2()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int i;
+    if (_q->num_stages == 0) {
+        // pass through
+        memmove(_y, _x, _n*sizeof(T));
+        return;
+    }
+
+    // number of low-rate samples per pass
+    unsigned int c = _q->buffer_len / _q->M;
+    unsigned int s;
+
+    while (_n > 0) {
+        unsigned int n = _n < c ? _n : c;
+
+        if (_q->type == LIQUID_RESAMP_INTERP) {
+            // stages run in reverse order, doubling the block each time
+            T * b0 = _x;
+            T * b1 = _q->buffer0;
+            for (s=0; s<_q->num_stages; s++) {
+                if (s == _q->num_stages-1)
+                    b1 = _y;
+                RESAMP2(_interp_execute_block)(_q->resamp2[_q->num_stages-s-1],
+                                               b0, n << s, b1);
+                b0 = b1;
+                b1 = (b0 == _q->buffer0) ? _q->buffer1 : _q->buffer0;
+            }
+            _x += n;
+            _y += n * _q->M;
+        } else {
+            // stages run in order, halving the block each time
+            T * b0 = _x;
+            T * b1 = _q->buffer0;
+            for (s=0; s<_q->num_stages; s++) {
+                if (s == _q->num_stages-1)
+                    b1 = _y;
+                RESAMP2(_decim_execute_block)(_q->resamp2[s],
+                                              b0, (n*_q->M) >> (s+1), b1);
+                b0 = b1;
+                b1 = (b0 == _q->buffer0) ? _q->buffer1 : _q->buffer0;
+            }
+
+            // scale output appropriately
+            for (i=0; i<n; i++)
+                _y[i] *= _q->zeta;
+
+            _x += n * _q->M;
+            _y += n;
+        }
+        _n -= n;
+    }
+}
+
 //
 // internal methods
 //
@@ -42,6 +42,13 @@
 // internal: update timing
 void RESAMP(_update_timing_state)(RESAMP() _q);
 
+// internal: compute outputs for one input sample, given filterbank
+// buffer contents _r after the sample has been pushed
+void RESAMP(_step)(RESAMP()       _q,
+                   TI *           _r,
+                   TO *           _y,
+                   unsigned int * _num_written);
+
 struct RESAMP(_s) {
     // filter design parameters
     unsigned int m;     // filter semi-length, h_len = 2*m + 1
@@ -101,7 +108,7 @@ RESAMP() RESAMP(_create)(float        _rate,
     }
 
     // allocate memory for resampler
-    RESAMP() q = (RESAMP()) malloc(sizeof(struct RESAMP(_s)));
+    RESAMP() q = (RESAMP()) liquid_malloc(sizeof(struct RESAMP(_s)));
 
     // set rate using formal method (specifies output stride
     // value 'del')
@@ -167,7 +174,7 @@ void RESAMP(_destroy)(RESAMP() _q)
     FIRPFB(_destroy)(_q->f);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print resampler object
@@ -177,6 +184,15 @@ void RESAMP(_print)(RESAMP() _q)
     FIRPFB(_print)(_q->f);
 }
 
+// enable/disable half-precision storage of filterbank coefficients
+//  _q      :   resampler object
+//  _enable :   non-zero to run from half-precision coefficients
+void RESAMP(_set_coeff_fp16)(RESAMP() _q,
+                             int      _enable)
+{
+    FIRPFB(_set_coeff_fp16)(_q->f, _enable);
+}
+
 // reset resampler object
 void RESAMP(_reset)(RESAMP() _q)
 {
@@ -249,6 +265,59 @@ void RESAMP(_execute)(RESAMP()       _q,
 {
     // push input sample into filterbank
     FIRPFB(_push)(_q->f, _x);
+
+    // compute outputs on filterbank buffer
+    RESAMP(_step)(_q, FIRPFB(_get_window)(_q->f), _y, _num_written);
+}
+
+// execute arbitrary resampler on a block of samples
+//  _q              :   resamp object
+//  _x              :   input buffer [size: _nx x 1]
+//  _nx             :   input buffer
+//  _y              :   output sample array (pointer)
+//  _ny             :   number of samples written to _y
+void RESAMP(_execute_block)(RESAMP()       _q,
+                            TI *           _x,
+                            unsigned int   _nx,
+                            TO *           _y,
+                            unsigned int * _ny)
+{
+    // initialize number of output samples to zero
+    unsigned int ny = 0;
+
+    // number of samples written for each individual iteration
+    unsigned int num_written;
+
+    // run over contiguous spans of filterbank history and input,
+    // committing input to the filterbank buffer once per span
+    unsigned int i, j;
+    for (i=0; i<_nx; i+=LIQUID_FIRPFB_BLOCK_LEN) {
+        unsigned int num = _nx - i < LIQUID_FIRPFB_BLOCK_LEN ? _nx - i : LIQUID_FIRPFB_BLOCK_LEN;
+        TI * r = FIRPFB(_span_load)(_q->f, &_x[i], num);
+        for (j=0; j<num; j++) {
+            RESAMP(_step)(_q, r + j, &_y[ny], &num_written);
+
+            // update output counter
+            ny += num_written;
+        }
+        FIRPFB(_span_commit)(_q->f, num);
+    }
+
+    // set return value for number of output samples written
+    *_ny = ny;
+}
+
+
+//
+// internal methods
+// 
+
+// compute outputs for one input sample (see above)
+void RESAMP(_step)(RESAMP()       _q,
+                   TI *           _r,
+                   TO *           _y,
+                   unsigned int * _num_written)
+{
     unsigned int n=0;
     
     while (_q->b < _q->npfb) {
@@ -259,7 +328,7 @@ void RESAMP(_execute)(RESAMP()       _q,
         switch (_q->state) {
         case RESAMP_STATE_BOUNDARY:
             // compute filterbank output
-            FIRPFB(_execute)(_q->f, 0, &_q->y1);
+            FIRPFB(_execute_window)(_q->f, 0, _r, &_q->y1);
 
             // interpolate
             _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
@@ -272,7 +341,7 @@ void RESAMP(_execute)(RESAMP()       _q,
 
         case RESAMP_STATE_INTERP:
             // compute output at base index
-            FIRPFB(_execute)(_q->f, _q->b, &_q->y0);
+            FIRPFB(_execute_window)(_q->f, _q->b, _r, &_q->y0);
 
             // check to see if base index is last filter in the bank, in
             // which case the resampler needs an additional input sample
@@ -286,7 +355,7 @@ void RESAMP(_execute)(RESAMP()       _q,
             } else {
                 // do not need additional input sample; compute
                 // output at incremented base index
-                FIRPFB(_execute)(_q->f, _q->b+1, &_q->y1);
+                FIRPFB(_execute_window)(_q->f, _q->b+1, _r, &_q->y1);
 
                 // perform linear interpolation between filterbank outputs
                 _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
@@ -310,43 +379,6 @@ void RESAMP(_execute)(RESAMP()       _q,
     *_num_written = n;
 }
 
-// execute arbitrary resampler on a block of samples
-//  _q              :   resamp object
-//  _x              :   input buffer [size: _nx x 1]
-//  _nx             :   input buffer
-//  _y              :   output sample array (pointer)
-//  _ny             :   number of samples written to _y
-void RESAMP(_execute_block)(RESAMP()       _q,
-                            TI *           _x,
-                            unsigned int   _nx,
-                            TO *           _y,
-                            unsigned int * _ny)
-{
-    // initialize number of output samples to zero
-    unsigned int ny = 0;
-
-    // number of samples written for each individual iteration
-    unsigned int num_written;
-
-    // iterate over each input sample
-    unsigned int i;
-    for (i=0; i<_nx; i++) {
-        // run resampler on single input
-        RESAMP(_execute)(_q, _x[i], &_y[ny], &num_written);
-
-        // update output counter
-        ny += num_written;
-    }
-
-    // set return value for number of output samples written
-    *_ny = ny;
-}
-
-
-//
-// internal methods
-// 
-
 // update timing state; increment output timing stride and
 // quantize filterbank indices
 void RESAMP(_update_timing_state)(RESAMP() _q)
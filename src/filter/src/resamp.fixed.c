@@ -20,8 +20,20 @@
  * THE SOFTWARE.
  */
 
+
+//
+// resamp (fixed-point) : arbitrary resampler with 16-bit (Q15)
+// polyphase coefficients and samples
 //
-// Arbitrary resampler (fixed-point phase verions)
+// The output timing is an unsigned integer phase accumulator with
+// LIQUID_RESAMPQ16_PHASE_BITS fractional bits so that timing never
+// drifts from rounding of a floating-point stride. The upper bits of
+// the phase select the filter in the bank, the next fifteen bits the
+// Q15 weight used to interpolate linearly between it and its
+// neighbour. The bank holds npfb+1 sub-filters: the last is the first
+// delayed by one input sample, so both neighbours are always computed
+// on the same input window. Floating-point math is used only to
+// design the filter and convert the rate when it is set.
 //
 
 #include <stdio.h>
@@ -29,57 +41,64 @@
 #include <string.h>
 #include <math.h>
 
-#define DEBUG_RESAMP_PRINT  0
-
 // defined:
 //  TO          output data type
 //  TC          coefficient data type
 //  TI          input data type
 //  RESAMP()    name-mangling macro
-//  FIRPFB()    firpfb macro
+//  DOTPROD()   dotprod macro
 
-struct RESAMP(_s) {
-    TC * h;
-    unsigned int h_len;
-    float As;       // stop-band attenuation
-    float fc;       // filter cutoff
+// fractional bits of timing phase (one input sample)
+#define LIQUID_RESAMPQ16_PHASE_BITS (24)
 
-    float r;        // rate
-    int b;          // filterbank index
-    float del;      // fractional delay step
+struct RESAMP(_s) {
+    // filter design parameters
+    unsigned int m;             // filter semi-length
+    float As;                   // filter stop-band attenuation
+    float fc;                   // filter cutoff frequency
 
-    // fixed-point phase
-    unsigned int theta;             // sampling phase
-    unsigned int d_theta;           // phase differential
+    // resampling rate (output/input)
+    float rate;
 
-    unsigned int num_bits_phase;    // number of bits in phase
-    unsigned int max_phase;         // maximum phase value
-    unsigned int num_bits_npfb;     // number of bits in npfb
-    unsigned int num_shift_bits;    // number of bits to shift to compute b
+    // fixed-point timing phase
+    unsigned int theta;         // phase of next output [input samples]
+    unsigned int d_theta;       // phase step between outputs
+    unsigned int num_bits_npfb; // log2(npfb)
+    unsigned int shift_b;       // shift to obtain filterbank index
+    unsigned int shift_mu;      // shift to obtain Q15 interpolation weight
 
+    // polyphase filterbank: npfb+1 sub-filters of length 2*m, each
+    // held in reverse order by a dot product object
     unsigned int npfb;
-    FIRPFB() f;
+    unsigned int h_sub_len;
+    DOTPROD() * dp;
 
-#if 0
-    fir_prototype p;    // prototype object
-#endif
+    // use array as internal buffer (see firfilt)
+    TI * w;                     // internal buffer object
+    unsigned int w_len;         // window length
+    unsigned int w_mask;        // window index mask
+    unsigned int w_index;       // window read index
 };
 
-RESAMP() RESAMP(_create)(float _r,
-                         unsigned int _h_len,
-                         float _fc,
-                         float _As,
+// create arbitrary resampler
+//  _rate   :   resampling rate, 1/128 <= _rate <= 65536
+//  _m      :   prototype filter semi-length
+//  _fc     :   prototype filter cutoff frequency, fc in (0, 0.5)
+//  _As     :   prototype filter stop-band attenuation [dB] (e.g. 60)
+//  _npfb   :   number of filters in polyphase filterbank (rounded up
+//              to a power of two), 0 < _npfb <= 512
+RESAMP() RESAMP(_create)(float        _rate,
+                         unsigned int _m,
+                         float        _fc,
+                         float        _As,
                          unsigned int _npfb)
 {
     // validate input
-    if (_r <= 0) {
-        fprintf(stderr,"error: resamp_%s_create(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+    if (_m == 0) {
+        fprintf(stderr,"error: resamp_%s_create(), filter semi-length must be greater than zero\n", EXTENSION_FULL);
         exit(1);
-    } else if (_h_len == 0) {
-        fprintf(stderr,"error: resamp_%s_create(), filter length must be greater than zero\n", EXTENSION_FULL);
-        exit(1);
-    } else if (_npfb == 0) {
-        fprintf(stderr,"error: resamp_%s_create(), number of filter banks must be greater than zero\n", EXTENSION_FULL);
+    } else if (_npfb == 0 || _npfb > 512) {
+        fprintf(stderr,"error: resamp_%s_create(), number of filter banks must be in [1,512]\n", EXTENSION_FULL);
         exit(1);
     } else if (_fc <= 0.0f || _fc >= 0.5f) {
         fprintf(stderr,"error: resamp_%s_create(), filter cutoff must be in (0,0.5)\n", EXTENSION_FULL);
@@ -89,100 +108,229 @@ RESAMP() RESAMP(_create)(float _r,
         exit(1);
     }
 
-    RESAMP() q = (RESAMP()) malloc(sizeof(struct RESAMP(_s)));
-    q->r     = _r;
-    q->As    = _As;
-    q->fc    = _fc;
-    q->h_len = _h_len;
-
-    q->b   = 0;
-    q->del = 1.0f / q->r;
+    // allocate memory for resampler
+    RESAMP() q = (RESAMP()) liquid_malloc(sizeof(struct RESAMP(_s)));
+    q->m    = _m;
+    q->fc   = _fc;
+    q->As   = _As;
 
+    // filterbank size and phase bit allocation
     q->num_bits_npfb = liquid_nextpow2(_npfb);
-    q->npfb = 1<<q->num_bits_npfb;
-    q->num_bits_phase = 20;
-    q->max_phase = 1 << q->num_bits_phase;
-    q->num_shift_bits = q->num_bits_phase - q->num_bits_npfb;
-    q->theta = 0;
-    q->d_theta = (unsigned int)( q->max_phase * q->del );
-
-    // design filter
-    unsigned int n = 2*_h_len*q->npfb+1;
+    q->npfb          = 1 << q->num_bits_npfb;
+    q->shift_b       = LIQUID_RESAMPQ16_PHASE_BITS - q->num_bits_npfb;
+    q->shift_mu      = q->shift_b - 15;
+
+    // set rate using formal method (computes phase step)
+    RESAMP(_set_rate)(q, _rate);
+
+    // design prototype filter
+    unsigned int n = 2*q->m*q->npfb+1;
     float hf[n];
-    TC h[n];
     liquid_firdes_kaiser(n,q->fc/((float)(q->npfb)),q->As,0.0f,hf);
 
-    // normalize filter coefficients by DC gain
-    unsigned int i;
+    // normalize filter coefficients by DC gain so that each sub-filter
+    // has unity gain
+    unsigned int i, k;
     float gain=0.0f;
     for (i=0; i<n; i++)
         gain += hf[i];
     gain = (q->npfb)/(gain);
 
-    // copy to type-specific array
-    for (i=0; i<n; i++)
-        h[i] = hf[i]*gain;
-    q->f = FIRPFB(_create)(q->npfb,h,n-1);
+    // create filterbank: sub-filter i holds prototype taps h[i],
+    // h[i+npfb], h[i+2*npfb], ... in reverse order
+    q->h_sub_len = 2*q->m;
+    q->dp = (DOTPROD()*) liquid_malloc((q->npfb+1)*sizeof(DOTPROD()));
+    TC h_sub[q->h_sub_len];
+    for (i=0; i<=q->npfb; i++) {
+        for (k=0; k<q->h_sub_len; k++)
+            h_sub[q->h_sub_len-k-1] = q16_float_to_fixed(hf[i + k*q->npfb]*gain);
+        q->dp[i] = DOTPROD(_create)(h_sub, q->h_sub_len);
+    }
 
-    //for (i=0; i<n; i++)
-    //    PRINTVAL_TC(h[i],%12.8f);
-    //exit(0);
+    // initialize array for buffering
+    q->w_len  = 1<<liquid_msb_index(q->h_sub_len); // effectively 2^{floor(log2(len))+1}
+    q->w_mask = q->w_len - 1;
+    q->w      = (TI *) liquid_malloc((q->w_len + q->h_sub_len + 1)*sizeof(TI));
 
+    // reset object and return
+    RESAMP(_reset)(q);
     return q;
 }
 
+// create arbitrary resampler object with a specified resampling rate
+// and default parameters
+//  m (filter semi-length) = 7
+//  fc (filter cutoff frequency) = 0.25
+//  As (filter stop-band attenuation) = 60 dB
+//  npfb (number of filters in the bank) = 64
+RESAMP() RESAMP(_create_default)(float _rate)
+{
+    return RESAMP(_create)(_rate, 7, 0.25f, 60.0f, 64);
+}
+
+// free arbitrary resampler object
 void RESAMP(_destroy)(RESAMP() _q)
 {
-    FIRPFB(_destroy)(_q->f);
-    free(_q);
+    unsigned int i;
+    for (i=0; i<=_q->npfb; i++)
+        DOTPROD(_destroy)(_q->dp[i]);
+    liquid_free(_q->dp);
+    liquid_free(_q->w);
+    liquid_free(_q);
 }
 
+// print resampler object
 void RESAMP(_print)(RESAMP() _q)
 {
-    printf("resampler [rate: %f]\n", _q->r);
-    FIRPFB(_print)(_q->f);
+    printf("resamp_%s:\n", EXTENSION_FULL);
+    printf("    rate    :   %f\n", _q->rate);
+    printf("    m       :   %u\n", _q->m);
+    printf("    npfb    :   %u\n", _q->npfb);
+    printf("    d_theta :   %u / %u\n", _q->d_theta, 1u << LIQUID_RESAMPQ16_PHASE_BITS);
 }
 
+// reset resampler object
 void RESAMP(_reset)(RESAMP() _q)
 {
-    FIRPFB(_reset)(_q->f);
-    _q->b   = 0;
+    memset(_q->w, 0x00, (_q->w_len + _q->h_sub_len + 1)*sizeof(TI));
+    _q->w_index = 0;
+    _q->theta   = 0;
+}
 
-    _q->theta = 0;
+// get resampler delay (output samples)
+unsigned int RESAMP(_get_delay)(RESAMP() _q)
+{
+    return _q->m;
 }
 
-void RESAMP(_setrate)(RESAMP() _q, float _rate)
+// get resampling rate
+float RESAMP(_get_rate)(RESAMP() _q)
 {
-    // TODO : validate rate, validate this method
-    _q->r = _rate;
-    _q->del = 1.0f / _q->r;
+    return _q->rate;
+}
 
-    _q->d_theta = (unsigned int)( _q->max_phase * _q->del );
+// set resampling rate; the phase step is rounded to the nearest
+// 2^-LIQUID_RESAMPQ16_PHASE_BITS input samples
+void RESAMP(_set_rate)(RESAMP() _q,
+                       float    _rate)
+{
+    if (_rate < 1.0f/128.0f || _rate > 65536.0f) {
+        fprintf(stderr,"error: resamp_%s_set_rate(), resampling rate must be in [1/128,65536]\n", EXTENSION_FULL);
+        exit(1);
+    }
+    _q->rate    = _rate;
+    _q->d_theta = (unsigned int) lrint((double)(1u << LIQUID_RESAMPQ16_PHASE_BITS) / (double)_rate);
 }
 
-void RESAMP(_execute)(RESAMP() _q,
-                      TI _x,
-                      TO * _y,
-                      unsigned int *_num_written)
+// adjust resampling rate
+void RESAMP(_adjust_rate)(RESAMP() _q,
+                          float    _delta)
 {
-    FIRPFB(_push)(_q->f, _x);
-    unsigned int n=0;
-    
-    //while (_q->tau < 1.0f) {
-    while (_q->theta < _q->max_phase) {
-
-#if DEBUG_RESAMP_PRINT
-        printf("  [%2u] : theta = %6u, b : %6u\n", n, _q->theta, _q->b);
-#endif
-        FIRPFB(_execute)(_q->f, _q->b, &_y[n]);
+    if (_delta > 0.1f || _delta < -0.1f) {
+        fprintf(stderr,"error: resamp_%s_adjust_rate(), resampling rate must be in [-0.1,0.1]\n", EXTENSION_FULL);
+        exit(1);
+    }
+    RESAMP(_set_rate)(_q, _q->rate + _delta);
+}
 
-        _q->theta += _q->d_theta;
-        _q->b = _q->theta >> _q->num_shift_bits;
+// interpolate between adjacent filterbank outputs with Q15 weight _mu
+static inline q16_t RESAMP(_lerp)(q16_t        _y0,
+                                  q16_t        _y1,
+                                  unsigned int _mu)
+{
+    int32_t d = (int32_t)_y1 - (int32_t)_y0;
+    return (q16_t)(_y0 + ((d * (int32_t)_mu + (1<<14)) >> 15));
+}
+
+// compute outputs for one input sample given its filterbank window,
+// returning the number of samples written to _y
+static unsigned int RESAMP(_step)(RESAMP() _q,
+                                  TI *     _r,
+                                  TO *     _y)
+{
+    const unsigned int one = 1u << LIQUID_RESAMPQ16_PHASE_BITS;
+    unsigned int n = 0;
+    while (_q->theta < one) {
+        unsigned int b  = _q->theta >> _q->shift_b;
+        unsigned int mu = (_q->theta >> _q->shift_mu) & 0x7fff;
+
+        TO y0, y1;
+        DOTPROD(_execute)(_q->dp[b],   _r, &y0);
+        DOTPROD(_execute)(_q->dp[b+1], _r, &y1);
+#if TO_COMPLEX
+        _y[n].real = RESAMP(_lerp)(y0.real, y1.real, mu);
+        _y[n].imag = RESAMP(_lerp)(y0.imag, y1.imag, mu);
+#else
+        _y[n] = RESAMP(_lerp)(y0, y1, mu);
+#endif
         n++;
+        _q->theta += _q->d_theta;
     }
 
-    _q->theta -= _q->max_phase;
-    _q->b = _q->theta >> _q->num_shift_bits;
-    *_num_written = n;
+    // advance timing phase by one input sample
+    _q->theta -= one;
+    return n;
+}
+
+// run arbitrary resampler
+//  _q          :   resampling object
+//  _x          :   single input sample
+//  _y          :   output array
+//  _num_written:   number of samples written to output
+void RESAMP(_execute)(RESAMP()       _q,
+                      TI             _x,
+                      TO *           _y,
+                      unsigned int * _num_written)
+{
+    // push sample into buffer
+    _q->w_index++;
+    _q->w_index &= _q->w_mask;
+    if (_q->w_index == 0)
+        memmove(_q->w, _q->w + _q->w_len, (_q->h_sub_len)*sizeof(TI));
+    _q->w[_q->w_index + _q->h_sub_len - 1] = _x;
+
+    *_num_written = RESAMP(_step)(_q, _q->w + _q->w_index, _y);
 }
 
+// execute arbitrary resampler on a block of samples
+//  _q              :   resamp object
+//  _x              :   input buffer [size: _nx x 1]
+//  _nx             :   input buffer
+//  _y              :   output sample array (pointer)
+//  _ny             :   number of samples written to _y
+void RESAMP(_execute_block)(RESAMP()       _q,
+                            TI *           _x,
+                            unsigned int   _nx,
+                            TO *           _y,
+                            unsigned int * _ny)
+{
+    unsigned int ny = 0;
+    unsigned int i = 0;
+    while (i < _nx) {
+        // number of samples which can be appended before the
+        // buffer index wraps around
+        unsigned int num = _q->w_mask - _q->w_index;
+
+        if (num == 0) {
+            // next sample wraps buffer; push and execute normally
+            unsigned int num_written;
+            RESAMP(_execute)(_q, _x[i], &_y[ny], &num_written);
+            ny += num_written;
+            i++;
+            continue;
+        }
+
+        // append block of samples to end of buffer and compute
+        // outputs directly from successive windows
+        if (num > _nx - i)
+            num = _nx - i;
+        memmove(_q->w + _q->w_index + _q->h_sub_len, &_x[i], num*sizeof(TI));
+        unsigned int j;
+        for (j=0; j<num; j++)
+            ny += RESAMP(_step)(_q, _q->w + _q->w_index + 1 + j, &_y[ny]);
+
+        _q->w_index += num;
+        i += num;
+    }
+    *_ny = ny;
+}
@@ -29,6 +29,16 @@
 #include <stdlib.h>
 #include <math.h>
 
+// longest filter branch run through the folded symmetric dot product
+// when a SIMD kernel is available; beyond this the vector kernel wins
+#define LIQUID_RESAMP2_SYM_MAX_LEN  (32)
+
+// number of outputs per pass of the block decimator/interpolator
+#define LIQUID_RESAMP2_BLOCK_LEN    (256)
+
+// number of outputs accumulated together by the block branch kernel
+#define LIQUID_RESAMP2_BLOCK_WIDTH  (8)
+
 // defined:
 //  RESAMP2()       name-mangling macro
 //  TO              output data type
@@ -38,6 +48,18 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
+// internal: compute filter branch output on buffer _r
+void RESAMP2(_branch_execute)(RESAMP2() _q,
+                              TI *      _r,
+                              TO *      _y);
+
+// internal: compute filter branch outputs for a block; output k is
+// the branch applied to _r[k], ..., _r[k + 2m-1]
+void RESAMP2(_branch_execute_block)(RESAMP2()    _q,
+                                    TI *         _r,
+                                    unsigned int _n,
+                                    TO *         _y);
+
 struct RESAMP2(_s) {
     TC * h;                 // filter prototype
     unsigned int m;         // primitive filter length
@@ -56,6 +78,12 @@ struct RESAMP2(_s) {
 
     // halfband filter operation
     unsigned int toggle;
+
+    // block operation: branch history followed by input samples
+    // [size: 2m + LIQUID_RESAMP2_BLOCK_LEN x 1]
+    TI * span0;             // delay branch span
+    TI * span1;             // filter branch span
+    TO * buf;               // filter branch output [size: LIQUID_RESAMP2_BLOCK_LEN x 1]
 };
 
 // create a resamp2 object
@@ -72,7 +100,7 @@ RESAMP2() RESAMP2(_create)(unsigned int _m,
         exit(1);
     }
 
-    RESAMP2() q = (RESAMP2()) malloc(sizeof(struct RESAMP2(_s)));
+    RESAMP2() q = (RESAMP2()) liquid_malloc(sizeof(struct RESAMP2(_s)));
     q->m  = _m;
     q->f0 = _f0;
     q->As = _As;
@@ -83,10 +111,10 @@ RESAMP2() RESAMP2(_create)(unsigned int _m,
 
     // change filter length as necessary
     q->h_len = 4*(q->m) + 1;
-    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC *) liquid_malloc((q->h_len)*sizeof(TC));
 
     q->h1_len = 2*(q->m);
-    q->h1 = (TC *) malloc((q->h1_len)*sizeof(TC));
+    q->h1 = (TC *) liquid_malloc((q->h1_len)*sizeof(TC));
 
     // design filter prototype
     unsigned int i;
@@ -117,6 +145,11 @@ RESAMP2() RESAMP2(_create)(unsigned int _m,
     q->w0 = WINDOW(_create)(2*(q->m));
     q->w1 = WINDOW(_create)(2*(q->m));
 
+    // allocate block buffers
+    q->span0 = (TI *) liquid_malloc((2*q->m + LIQUID_RESAMP2_BLOCK_LEN)*sizeof(TI));
+    q->span1 = (TI *) liquid_malloc((2*q->m + LIQUID_RESAMP2_BLOCK_LEN)*sizeof(TI));
+    q->buf   = (TO *) liquid_malloc(LIQUID_RESAMP2_BLOCK_LEN*sizeof(TO));
+
     RESAMP2(_clear)(q);
 
     return q;
@@ -178,11 +211,14 @@ void RESAMP2(_destroy)(RESAMP2() _q)
     WINDOW(_destroy)(_q->w1);
 
     // free arrays
-    free(_q->h);
-    free(_q->h1);
+    liquid_free(_q->h);
+    liquid_free(_q->h1);
+    liquid_free(_q->span0);
+    liquid_free(_q->span1);
+    liquid_free(_q->buf);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print a resamp2 object's internals
@@ -243,7 +279,7 @@ void RESAMP2(_filter_execute)(RESAMP2() _q,
 
         // lower branch (filter)
         WINDOW(_read)(_q->w1, &r);
-        DOTPROD(_execute)(_q->dp, r, &yq);
+        RESAMP2(_branch_execute)(_q, r, &yq);
     } else {
         // push sample into lower branch
         WINDOW(_push)(_q->w1, _x);
@@ -253,7 +289,7 @@ void RESAMP2(_filter_execute)(RESAMP2() _q,
 
         // lower branch (filter)
         WINDOW(_read)(_q->w0, &r);
-        DOTPROD(_execute)(_q->dp, r, &yq);
+        RESAMP2(_branch_execute)(_q, r, &yq);
     }
 
     // toggle flag
@@ -279,7 +315,7 @@ void RESAMP2(_analyzer_execute)(RESAMP2() _q,
     // compute filter branch
     WINDOW(_push)(_q->w1, 0.5*_x[0]);
     WINDOW(_read)(_q->w1, &r);
-    DOTPROD(_execute)(_q->dp, r, &y1);
+    RESAMP2(_branch_execute)(_q, r, &y1);
 
     // compute delay branch
     WINDOW(_push)(_q->w0, 0.5*_x[1]);
@@ -309,7 +345,7 @@ void RESAMP2(_synthesizer_execute)(RESAMP2() _q,
     // compute second branch (filter)
     WINDOW(_push)(_q->w1, x1);
     WINDOW(_read)(_q->w1, &r);
-    DOTPROD(_execute)(_q->dp, r, &_y[1]);
+    RESAMP2(_branch_execute)(_q, r, &_y[1]);
 }
 
 
@@ -328,7 +364,7 @@ void RESAMP2(_decim_execute)(RESAMP2() _q,
     // compute filter branch
     WINDOW(_push)(_q->w1, _x[0]);
     WINDOW(_read)(_q->w1, &r);
-    DOTPROD(_execute)(_q->dp, r, &y1);
+    RESAMP2(_branch_execute)(_q, r, &y1);
 
     // compute delay branch
     WINDOW(_push)(_q->w0, _x[1]);
@@ -355,6 +391,151 @@ void RESAMP2(_interp_execute)(RESAMP2() _q,
     // compute second branch (filter)
     WINDOW(_push)(_q->w1, _x);
     WINDOW(_read)(_q->w1, &r);
-    DOTPROD(_execute)(_q->dp, r, &_y[1]);
+    RESAMP2(_branch_execute)(_q, r, &_y[1]);
+}
+
+// execute half-band decimation on a block of samples, equivalent to
+// _n calls to decim_execute(); the even and odd input streams are
+// separated into contiguous spans behind each branch's history so
+// the filter branch runs over the whole block at once
+//  _q      :   resamp2 object
+//  _x      :   input array [size: 2*_n x 1]
+//  _n      :   number of output samples
+//  _y      :   output array [size: _n x 1]
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,
+                                   TI *         _x,
+                                   unsigned int _n,
+                                   TO *         _y)
+{
+    unsigned int m = _q->m;
+    unsigned int i;
+    TI * r;
+
+    while (_n > 0) {
+        unsigned int n = _n < LIQUID_RESAMP2_BLOCK_LEN ? _n : LIQUID_RESAMP2_BLOCK_LEN;
+
+        // history: filter branch needs 2m-1 samples, delay branch 2m
+        WINDOW(_read)(_q->w1, &r);
+        memmove(_q->span1, &r[1], (2*m-1)*sizeof(TI));
+        WINDOW(_read)(_q->w0, &r);
+        memmove(_q->span0, r, 2*m*sizeof(TI));
+
+        // separate input streams
+        for (i=0; i<n; i++) {
+            _q->span1[2*m - 1 + i] = _x[2*i  ];
+            _q->span0[2*m     + i] = _x[2*i+1];
+        }
+
+        // filter branch plus delayed sample
+        RESAMP2(_branch_execute_block)(_q, _q->span1, n, _y);
+        for (i=0; i<n; i++)
+            _y[i] += _q->span0[m + i];
+
+        // retain most recent samples of each stream
+        WINDOW(_write)(_q->w1, &_q->span1[n - 1], 2*m);
+        WINDOW(_write)(_q->w0, &_q->span0[n],     2*m);
+
+        _x += 2*n;
+        _y += n;
+        _n -= n;
+    }
+}
+
+// execute half-band interpolation on a block of samples, equivalent
+// to _n calls to interp_execute()
+//  _q      :   resamp2 object
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   output array [size: 2*_n x 1]
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,
+                                    TI *         _x,
+                                    unsigned int _n,
+                                    TO *         _y)
+{
+    unsigned int m = _q->m;
+    unsigned int i;
+    TI * r;
+
+    while (_n > 0) {
+        unsigned int n = _n < LIQUID_RESAMP2_BLOCK_LEN ? _n : LIQUID_RESAMP2_BLOCK_LEN;
+
+        // both branches see the same input, each behind its own history
+        WINDOW(_read)(_q->w1, &r);
+        memmove(_q->span1, &r[1], (2*m-1)*sizeof(TI));
+        memmove(&_q->span1[2*m-1], _x, n*sizeof(TI));
+        WINDOW(_read)(_q->w0, &r);
+        memmove(_q->span0, r, 2*m*sizeof(TI));
+        memmove(&_q->span0[2*m], _x, n*sizeof(TI));
+
+        // interleave delay and filter branches
+        RESAMP2(_branch_execute_block)(_q, _q->span1, n, _q->buf);
+        for (i=0; i<n; i++) {
+            _y[2*i  ] = _q->span0[m + i];
+            _y[2*i+1] = _q->buf[i];
+        }
+
+        // retain most recent samples
+        WINDOW(_write)(_q->w1, &_q->span1[n - 1], 2*m);
+        WINDOW(_write)(_q->w0, &_q->span0[n],     2*m);
+
+        _x += n;
+        _y += 2*n;
+        _n -= n;
+    }
 }
 
+//
+// internal methods
+//
+
+// compute filter branch output on buffer _r; with real coefficients
+// the branch is even-symmetric (h1[i] = h1[2m-1-i]) for any center
+// frequency, so mirrored samples are pre-added and only the first m
+// coefficients are applied; long branches with a SIMD kernel
+// available keep the full vector dot product
+void RESAMP2(_branch_execute)(RESAMP2() _q,
+                              TI *      _r,
+                              TO *      _y)
+{
+#if TC_COMPLEX == 0
+    if (_q->h1_len <= LIQUID_RESAMP2_SYM_MAX_LEN ||
+        liquid_simd_get_level() == LIQUID_SIMD_PORTABLE)
+    {
+        DOTPROD(_run_sym)(_q->h1, _q->h1_len, _r, _y);
+        return;
+    }
+#endif
+    DOTPROD(_execute)(_q->dp, _r, _y);
+}
+
+// compute filter branch outputs for a block; with real coefficients
+// mirrored samples are pre-added as in branch_execute() and several
+// outputs share each coefficient load, leaving contiguous inner loops
+// the compiler can vectorize
+void RESAMP2(_branch_execute_block)(RESAMP2()    _q,
+                                    TI *         _r,
+                                    unsigned int _n,
+                                    TO *         _y)
+{
+    unsigned int k;
+#if TC_COMPLEX == 0
+    unsigned int m = _q->m;
+    unsigned int j, l;
+    for (k=0; k + LIQUID_RESAMP2_BLOCK_WIDTH <= _n; k += LIQUID_RESAMP2_BLOCK_WIDTH) {
+        TO v[LIQUID_RESAMP2_BLOCK_WIDTH] = {0};
+        for (j=0; j<m; j++) {
+            TC   h = _q->h1[j];
+            TI * a = &_r[k + j];
+            TI * b = &_r[k + 2*m - 1 - j];
+            for (l=0; l<LIQUID_RESAMP2_BLOCK_WIDTH; l++)
+                v[l] += h * (a[l] + b[l]);
+        }
+        for (l=0; l<LIQUID_RESAMP2_BLOCK_WIDTH; l++)
+            _y[k+l] = v[l];
+    }
+#else
+    k = 0;
+#endif
+    for ( ; k<_n; k++)
+        RESAMP2(_branch_execute)(_q, &_r[k], &_y[k]);
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Arbitrary-rate resampler on a Farrow-structure filter
+//
+// The interpolating filter is a firfarrow object whose taps are
+// polynomials in the fractional delay. Each output evaluates the
+// polynomial branch filters directly at its own fractional delay, so
+// a change of rate is a stride update only and the coefficient memory
+// is (order+1) x 2*m values instead of a densely sampled filterbank.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// defined:
+//  TO              output data type
+//  TC              coefficient data type
+//  TI              input data type
+//  RESAMPFARROW()  name-mangling macro
+//  FIRFARROW()     firfarrow macro
+
+// internal: compute outputs for the current input window
+void RESAMPFARROW(_step)(RESAMPFARROW() _q,
+                         TO *           _y,
+                         unsigned int * _num_written);
+
+struct RESAMPFARROW(_s) {
+    // filter design parameters
+    unsigned int m;     // filter semi-length, h_len = 2*m
+    float fc;           // filter cutoff frequency
+    float As;           // filter stop-band attenuation [dB]
+    unsigned int order; // polynomial order
+
+    // resampling properties/states
+    float rate;         // resampling rate (output/input)
+    float del;          // output timing stride [input samples]
+    float tau;          // timing phase of next output, 0 <= tau < 1
+
+    FIRFARROW() f;      // Farrow filter
+};
+
+// create Farrow resampler
+//  _rate   : resampling rate (output/input), _rate > 0
+//  _m      : filter semi-length (delay) [input samples], _m > 0
+//  _fc     : filter cutoff frequency, 0 < _fc < 0.5
+//  _As     : filter stop-band attenuation [dB], _As > 0
+//  _order  : polynomial order, _order > 0
+RESAMPFARROW() RESAMPFARROW(_create)(float        _rate,
+                                     unsigned int _m,
+                                     float        _fc,
+                                     float        _As,
+                                     unsigned int _order)
+{
+    // validate input
+    if (_rate <= 0) {
+        fprintf(stderr,"error: resamp_farrow_%s_create(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: resamp_farrow_%s_create(), filter semi-length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_fc <= 0.0f || _fc >= 0.5f) {
+        fprintf(stderr,"error: resamp_farrow_%s_create(), filter cutoff must be in (0,0.5)\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_As <= 0.0f) {
+        fprintf(stderr,"error: resamp_farrow_%s_create(), filter stop-band suppression must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_order == 0) {
+        fprintf(stderr,"error: resamp_farrow_%s_create(), polynomial order must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // allocate memory for resampler
+    RESAMPFARROW() q = (RESAMPFARROW()) liquid_malloc(sizeof(struct RESAMPFARROW(_s)));
+    q->m     = _m;
+    q->fc    = _fc;
+    q->As    = _As;
+    q->order = _order;
+
+    // set rate using formal method (specifies output stride)
+    RESAMPFARROW(_set_rate)(q, _rate);
+
+    // create Farrow filter of even length so that fractional delays
+    // in [-0.5,0.5] span the interval between the two center taps
+    q->f = FIRFARROW(_create)(2*q->m, q->order, q->fc, q->As);
+
+    // reset object and return
+    RESAMPFARROW(_reset)(q);
+    return q;
+}
+
+// create Farrow resampler with a specified resampling rate and
+// default parameters
+//  m (filter semi-length) = 8
+//  fc (filter cutoff frequency) = 0.4
+//  As (filter stop-band attenuation) = 60 dB
+//  order (polynomial order) = 4
+RESAMPFARROW() RESAMPFARROW(_create_default)(float _rate)
+{
+    // validate input
+    if (_rate <= 0) {
+        fprintf(stderr,"error: resamp_farrow_%s_create_default(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create and return resampler with default parameters
+    return RESAMPFARROW(_create)(_rate, 8, 0.4f, 60.0f, 4);
+}
+
+// destroy Farrow resampler object
+void RESAMPFARROW(_destroy)(RESAMPFARROW() _q)
+{
+    FIRFARROW(_destroy)(_q->f);
+    liquid_free(_q);
+}
+
+// print Farrow resampler object
+void RESAMPFARROW(_print)(RESAMPFARROW() _q)
+{
+    printf("resamp_farrow [rate: %f, m: %u, order: %u]\n", _q->rate, _q->m, _q->order);
+}
+
+// reset Farrow resampler object
+void RESAMPFARROW(_reset)(RESAMPFARROW() _q)
+{
+    FIRFARROW(_reset)(_q->f);
+    _q->tau = 0.0f;
+}
+
+// get resampler filter delay [input samples]
+unsigned int RESAMPFARROW(_get_delay)(RESAMPFARROW() _q)
+{
+    return _q->m;
+}
+
+// get resampling rate
+float RESAMPFARROW(_get_rate)(RESAMPFARROW() _q)
+{
+    return _q->rate;
+}
+
+// set resampling rate; takes effect with the next output sample
+void RESAMPFARROW(_set_rate)(RESAMPFARROW() _q,
+                             float          _rate)
+{
+    if (_rate <= 0) {
+        fprintf(stderr,"error: resamp_farrow_%s_set_rate(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // set internal rate and output stride
+    _q->rate = _rate;
+    _q->del  = 1.0f / _q->rate;
+}
+
+// adjust resampling rate by a small amount
+//  _q      : resampler object
+//  _delta  : rate increment, -0.1 <= _delta <= 0.1
+void RESAMPFARROW(_adjust_rate)(RESAMPFARROW() _q,
+                                float          _delta)
+{
+    if (_delta > 0.1f || _delta < -0.1f) {
+        fprintf(stderr,"error: resamp_farrow_%s_adjust_rate(), rate adjustment must be in [-0.1,0.1]\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    RESAMPFARROW(_set_rate)(_q, _q->rate + _delta);
+}
+
+// execute Farrow resampler on a single input sample
+//  _q              : resampler object
+//  _x              : single input sample
+//  _y              : output array [size: ceil(rate) x 1]
+//  _num_written    : number of samples written to _y
+void RESAMPFARROW(_execute)(RESAMPFARROW() _q,
+                            TI             _x,
+                            TO *           _y,
+                            unsigned int * _num_written)
+{
+    FIRFARROW(_push)(_q->f, _x);
+    RESAMPFARROW(_step)(_q, _y, _num_written);
+}
+
+// execute Farrow resampler on a block of samples
+//  _q      : resampler object
+//  _x      : input array [size: _nx x 1]
+//  _nx     : number of input samples
+//  _y      : output array [size: ceil(_nx*rate) x 1]
+//  _ny     : number of samples written to _y
+void RESAMPFARROW(_execute_block)(RESAMPFARROW() _q,
+                                  TI *           _x,
+                                  unsigned int   _nx,
+                                  TO *           _y,
+                                  unsigned int * _ny)
+{
+    unsigned int i;
+    unsigned int ny = 0;
+    unsigned int num_written;
+    for (i=0; i<_nx; i++) {
+        FIRFARROW(_push)(_q->f, _x[i]);
+        RESAMPFARROW(_step)(_q, &_y[ny], &num_written);
+        ny += num_written;
+    }
+    *_ny = ny;
+}
+
+//
+// internal methods
+//
+
+// compute outputs for the current input window: with a filter of
+// length 2*m the interval between input samples n-m and n-m+1 is
+// covered by fractional delays mu = tau - 0.5 in [-0.5,0.5)
+void RESAMPFARROW(_step)(RESAMPFARROW() _q,
+                         TO *           _y,
+                         unsigned int * _num_written)
+{
+    unsigned int n = 0;
+    TI * r = FIRFARROW(_get_window)(_q->f);
+    while (_q->tau < 1.0f) {
+        FIRFARROW(_execute_window)(_q->f, r, _q->tau - 0.5f, &_y[n++]);
+        _q->tau += _q->del;
+    }
+
+    // advance timing phase by one input sample
+    _q->tau -= 1.0f;
+
+    *_num_written = n;
+}
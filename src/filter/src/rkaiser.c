@@ -65,10 +65,19 @@ void liquid_firdes_rkaiser(unsigned int _k,
         exit(1);
     }
 
+    // check filter design cache (shared with liquid_firdes_prototype())
+    unsigned int h_len = 2*_k*_m + 1;
+    float key[5] = {(float)LIQUID_FIRFILT_RKAISER, (float)_k, (float)_m, _beta, _dt};
+    if (liquid_firdes_cache_lookup(LIQUID_FIRDES_CACHE_PROTOTYPE, key, 5, _h, h_len))
+        return;
+
     // simply call internal method and ignore output rho value
     float rho;
     //liquid_firdes_rkaiser_bisection(_k,_m,_beta,_dt,_h,&rho);
     liquid_firdes_rkaiser_quadratic(_k,_m,_beta,_dt,_h,&rho);
+
+    // store result in filter design cache
+    liquid_firdes_cache_insert(LIQUID_FIRDES_CACHE_PROTOTYPE, key, 5, _h, h_len);
 }
 
 // Design frequency-shifted root-Nyquist filter based on
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Rational-rate resampler: P/Q interpolation/decimation on a polyphase
+// filterbank with a precomputed output schedule
+//
+// Each frame of Q input samples produces P output samples. Output k of
+// a frame lies at input time k*Q/P, i.e. filterbank branch (k*Q) mod P
+// applied to the window ending at input sample floor(k*Q/P); these
+// are computed once at creation so that execution is a table lookup
+// and dot product per output with no phase accumulator.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// defined:
+//  TO          output data type
+//  TC          coefficient data type
+//  TI          input data type
+//  RRESAMP()   name-mangling macro
+//  FIRPFB()    firpfb macro
+
+struct RRESAMP(_s) {
+    // filter design parameters
+    unsigned int P;     // interpolation factor (output samples/frame)
+    unsigned int Q;     // decimation factor (input samples/frame)
+    unsigned int m;     // filter semi-length [input samples]
+    float bw;           // filter bandwidth
+    float As;           // filter stop-band attenuation [dB]
+
+    // polyphase filterbank with P branches, 2*m taps each
+    FIRPFB() f;
+    unsigned int h_sub_len;
+
+    // output schedule [size: P x 1]
+    unsigned int * branch;  // filterbank branch for each output
+    unsigned int * index;   // window offset into buffer for each output
+
+    // input history followed by one frame [size: h_sub_len-1+Q x 1]
+    TI * buf;
+};
+
+// create rational-rate resampler
+//  _P      : interpolation factor, _P > 0
+//  _Q      : decimation factor, _Q > 0
+//  _m      : filter semi-length (delay) [input samples], _m > 0
+//  _bw     : filter bandwidth relative to the lower of the input and
+//            output sample rates, 0 < _bw < 0.5
+//  _As     : filter stop-band attenuation [dB], _As > 0
+RRESAMP() RRESAMP(_create)(unsigned int _P,
+                           unsigned int _Q,
+                           unsigned int _m,
+                           float        _bw,
+                           float        _As)
+{
+    // validate input
+    if (_P == 0 || _Q == 0) {
+        fprintf(stderr,"error: rresamp_%s_create(), resampling factors must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: rresamp_%s_create(), filter semi-length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_bw <= 0.0f || _bw >= 0.5f) {
+        fprintf(stderr,"error: rresamp_%s_create(), filter bandwidth must be in (0,0.5)\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_As <= 0.0f) {
+        fprintf(stderr,"error: rresamp_%s_create(), filter stop-band suppression must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // reduce rate to lowest terms
+    unsigned int a = _P;
+    unsigned int b = _Q;
+    while (b != 0) {
+        unsigned int t = a % b;
+        a = b;
+        b = t;
+    }
+
+    // allocate memory for resampler
+    RRESAMP() q = (RRESAMP()) liquid_malloc(sizeof(struct RRESAMP(_s)));
+    q->P  = _P / a;
+    q->Q  = _Q / a;
+    q->m  = _m;
+    q->bw = _bw;
+    q->As = _As;
+
+    // design prototype filter at P times the input rate with cutoff at
+    // the lower of the input/output rates
+    unsigned int r = q->P > q->Q ? q->P : q->Q;
+    unsigned int n = 2*q->m*q->P+1;
+    float hf[n];
+    TC h[n];
+    liquid_firdes_kaiser(n, q->bw/(float)r, q->As, 0.0f, hf);
+
+    // normalize filter coefficients by DC gain of each branch
+    unsigned int i;
+    float gain=0.0f;
+    for (i=0; i<n; i++)
+        gain += hf[i];
+    gain = (q->P)/(gain);
+
+    // copy to type-specific array, applying gain
+    for (i=0; i<n; i++)
+        h[i] = hf[i]*gain;
+    q->f = FIRPFB(_create)(q->P, h, n-1);
+    q->h_sub_len = 2*q->m;
+
+    // compute output schedule
+    q->branch = (unsigned int *) liquid_malloc(q->P*sizeof(unsigned int));
+    q->index  = (unsigned int *) liquid_malloc(q->P*sizeof(unsigned int));
+    for (i=0; i<q->P; i++) {
+        q->branch[i] = (i*q->Q) % q->P;
+        q->index[i]  = (i*q->Q) / q->P;
+    }
+
+    // allocate buffer
+    q->buf = (TI *) liquid_malloc((q->h_sub_len - 1 + q->Q)*sizeof(TI));
+
+    // reset object and return
+    RRESAMP(_reset)(q);
+    return q;
+}
+
+// create rational-rate resampler with default parameters
+//  m (filter semi-length) = 12
+//  bw (filter bandwidth) = 0.45
+//  As (filter stop-band attenuation) = 60 dB
+RRESAMP() RRESAMP(_create_default)(unsigned int _P,
+                                   unsigned int _Q)
+{
+    // det default parameters
+    unsigned int m  = 12;
+    float        bw = 0.45f;
+    float        As = 60.0f;
+
+    // create and return rresamp object
+    return RRESAMP(_create)(_P, _Q, m, bw, As);
+}
+
+// free rational-rate resampler object
+void RRESAMP(_destroy)(RRESAMP() _q)
+{
+    FIRPFB(_destroy)(_q->f);
+    liquid_free(_q->branch);
+    liquid_free(_q->index);
+    liquid_free(_q->buf);
+    liquid_free(_q);
+}
+
+// print resampler object
+void RRESAMP(_print)(RRESAMP() _q)
+{
+    printf("rresamp_%s: [P=%u, Q=%u, rate=%f, m=%u, bw=%f, As=%.1f dB]\n",
+            EXTENSION_FULL, _q->P, _q->Q, (float)_q->P / (float)_q->Q,
+            _q->m, _q->bw, _q->As);
+}
+
+// reset resampler object
+void RRESAMP(_reset)(RRESAMP() _q)
+{
+    // clear input history
+    unsigned int i;
+    for (i=0; i<_q->h_sub_len-1; i++)
+        _q->buf[i] = 0;
+}
+
+// get resampler delay (input samples)
+unsigned int RRESAMP(_get_delay)(RRESAMP() _q)
+{
+    return _q->m;
+}
+
+// get interpolation factor (output samples per frame)
+unsigned int RRESAMP(_get_P)(RRESAMP() _q)
+{
+    return _q->P;
+}
+
+// get decimation factor (input samples per frame)
+unsigned int RRESAMP(_get_Q)(RRESAMP() _q)
+{
+    return _q->Q;
+}
+
+// get resampling rate, P/Q
+float RRESAMP(_get_rate)(RRESAMP() _q)
+{
+    return (float)_q->P / (float)_q->Q;
+}
+
+// execute rational-rate resampler on one frame
+//  _q      : resamp object
+//  _x      : input frame [size: Q x 1]
+//  _y      : output frame [size: P x 1]
+void RRESAMP(_execute)(RRESAMP() _q,
+                       TI *      _x,
+                       TO *      _y)
+{
+    unsigned int hl = _q->h_sub_len - 1;
+
+    // append frame to history
+    memmove(_q->buf + hl, _x, _q->Q*sizeof(TI));
+
+    // run schedule: window for output k ends at frame sample index[k]
+    unsigned int k;
+    for (k=0; k<_q->P; k++)
+        FIRPFB(_execute_window)(_q->f, _q->branch[k], _q->buf + _q->index[k], &_y[k]);
+
+    // retain history
+    memmove(_q->buf, _q->buf + _q->Q, hl*sizeof(TI));
+}
+
+// execute rational-rate resampler on a block of frames; once the
+// input history is covered by the block, windows are read directly
+// from the input without copying
+//  _q      : resamp object
+//  _x      : input buffer [size: _n*Q x 1]
+//  _n      : number of frames
+//  _y      : output buffer [size: _n*P x 1]
+void RRESAMP(_execute_block)(RRESAMP()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    unsigned int hl = _q->h_sub_len - 1;
+    unsigned int i;
+    unsigned int k;
+
+    // leading frames whose windows reach into the history buffer
+    for (i=0; i<_n && i*_q->Q < hl; i++)
+        RRESAMP(_execute)(_q, &_x[i*_q->Q], &_y[i*_q->P]);
+
+    if (i == _n)
+        return;
+
+    // remaining frames: window for output k of frame i ends at input
+    // sample i*Q + index[k]
+    for ( ; i<_n; i++) {
+        TI * r = _x + i*_q->Q - hl;
+        TO * y = _y + i*_q->P;
+        for (k=0; k<_q->P; k++)
+            FIRPFB(_execute_window)(_q->f, _q->branch[k], r + _q->index[k], &y[k]);
+    }
+
+    // retain history
+    memmove(_q->buf, _x + _n*_q->Q - hl, hl*sizeof(TI));
+}
+
@@ -50,14 +50,22 @@
 
 // step synchronizer
 //  _q      : symsync object
-//  _x      : input sample
+//  _r      : filterbank window after pushing input sample
 //  _y      : output sample array pointer
 //  _ny     : number of output samples written
 void SYMSYNC(_step)(SYMSYNC()      _q,
-                    TI             _x,
+                    TI *           _r,
                     TO *           _y,
                     unsigned int * _ny);
 
+// compute matched and derivative matched filter outputs for
+// filterbank index _b in a single pass over the window _r
+void SYMSYNC(_execute_mf_dmf)(SYMSYNC()    _q,
+                              unsigned int _b,
+                              TI *         _r,
+                              TO *         _mf,
+                              TO *         _dmf);
+
 // advance synchronizer's internal loop filter
 //  _q      : synchronizer object
 //  _mf     : matched-filter output
@@ -72,6 +80,21 @@ void SYMSYNC(_advance_internal_loop)(SYMSYNC() _q,
 void SYMSYNC(_output_debug_file)(SYMSYNC()    _q,
                                  const char * _filename);
 
+// The matched and derivative matched filters share one input window
+// and are stored as a single interleaved bank so that both outputs
+// come from one pass over the window. Each filter is reversed as in
+// firpfb with every tap expanded to one coefficient per real output
+// component:
+//   real input:    {h[n], dh[n]}
+//   complex input: {h[n], h[n], dh[n], dh[n]}
+// so a single fixed-width accumulator holds {mf, dmf} (real) or
+// {re(mf), im(mf), re(dmf), im(dmf)} (complex).
+#if TI_COMPLEX
+#  define SYMSYNC_MD_WIDTH  (4)
+#else
+#  define SYMSYNC_MD_WIDTH  (2)
+#endif
+
 // internal structure
 struct SYMSYNC(_s) {
     unsigned int h_len;         // matched filter length
@@ -99,8 +122,9 @@ struct SYMSYNC(_s) {
     float rate_adjustment;      // internal rate adjustment factor
 
     unsigned int npfb;          // number of filters in the bank
-    FIRPFB()      mf;           // matched filter
-    FIRPFB()     dmf;           // derivative matched filter
+    FIRPFB()      mf;           // matched filter (and input window)
+    float *     hmd;            // interleaved MF/dMF bank (see below)
+    liquid_float16 * dh16;      // half-precision dMF bank, reversed, or NULL
 
 #if DEBUG_SYMSYNC
     windowf debug_rate;
@@ -138,7 +162,7 @@ SYMSYNC() SYMSYNC(_create)(unsigned int _k,
     }
 
     // create main object
-    SYMSYNC() q = (SYMSYNC()) malloc(sizeof(struct SYMSYNC(_s)));
+    SYMSYNC() q = (SYMSYNC()) liquid_malloc(sizeof(struct SYMSYNC(_s)));
 
     // set internal properties
     q->k    = _k;  // input samples per symbol
@@ -173,7 +197,23 @@ SYMSYNC() SYMSYNC(_create)(unsigned int _k,
         dh[i] *= 0.06f / hdh_max;
     
     q->mf  = FIRPFB(_create)(q->npfb, _h, _h_len);
-    q->dmf = FIRPFB(_create)(q->npfb, dh, _h_len);
+
+    // interleave MF/dMF coefficients for each filter in the bank,
+    // reversed as in firpfb so both run on the matched filter window
+    q->hmd = (float*) liquid_malloc(SYMSYNC_MD_WIDTH*q->npfb*q->h_len*sizeof(float));
+    unsigned int n, l;
+    for (i=0; i<q->npfb; i++) {
+        for (n=0; n<q->h_len; n++) {
+            float * c = &q->hmd[SYMSYNC_MD_WIDTH*(i*q->h_len + q->h_len-n-1)];
+            for (l=0; l<SYMSYNC_MD_WIDTH/2; l++) {
+                c[l]                      = crealf(_h[i + n*q->npfb]);
+                c[l + SYMSYNC_MD_WIDTH/2] = crealf(dh[i + n*q->npfb]);
+            }
+        }
+    }
+
+    // single-precision coefficients by default
+    q->dh16 = NULL;
 
     // reset state and initialize loop filter
     q->A[0] = 1.0f;     q->B[0] = 0.0f;
@@ -306,13 +346,14 @@ void SYMSYNC(_destroy)(SYMSYNC() _q)
 
     // destroy filterbank objects
     FIRPFB(_destroy)(_q->mf);
-    FIRPFB(_destroy)(_q->dmf);
+    liquid_free(_q->hmd);
+    liquid_free(_q->dh16);
 
     // destroy timing phase-locked loop filter
     iirfiltsos_rrrf_destroy(_q->pll);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print symsync object's parameters
@@ -343,6 +384,13 @@ void SYMSYNC(_reset)(SYMSYNC() _q)
     iirfiltsos_rrrf_reset(_q->pll);
 }
 
+// get nominal matched filter delay (output samples); the filter
+// spans h_len input samples centered on the symbol
+float SYMSYNC(_get_delay)(SYMSYNC() _q)
+{
+    return 0.5f*(float)(_q->h_len) * (float)(_q->k_out) / (float)(_q->k);
+}
+
 // lock synchronizer object
 void SYMSYNC(_lock)(SYMSYNC() _q)
 {
@@ -355,6 +403,30 @@ void SYMSYNC(_unlock)(SYMSYNC() _q)
     _q->is_locked = 0;
 }
 
+// enable/disable half-precision storage of the matched and
+// derivative matched filterbank coefficients; the matched filter
+// runs from its firpfb and the derivative filter from a separate
+// half-precision bank instead of the interleaved single-precision one
+//  _q      :   synchronizer object
+//  _enable :   non-zero to run from half-precision coefficients
+void SYMSYNC(_set_coeff_fp16)(SYMSYNC() _q,
+                              int       _enable)
+{
+    FIRPFB(_set_coeff_fp16)(_q->mf, _enable);
+
+    if (_enable && _q->dh16 == NULL) {
+        // extract dMF taps from interleaved bank (already reversed)
+        unsigned int n = _q->npfb*_q->h_len;
+        _q->dh16 = (liquid_float16*) liquid_malloc(n*sizeof(liquid_float16));
+        unsigned int i;
+        for (i=0; i<n; i++)
+            _q->dh16[i] = liquid_float_to_float16(_q->hmd[SYMSYNC_MD_WIDTH*i + SYMSYNC_MD_WIDTH/2]);
+    } else if (!_enable && _q->dh16 != NULL) {
+        liquid_free(_q->dh16);
+        _q->dh16 = NULL;
+    }
+}
+
 // set synchronizer output rate (samples/symbol)
 //  _q      :   synchronizer object
 //  _k_out  :   output samples/symbol
@@ -425,11 +497,25 @@ void SYMSYNC(_execute)(SYMSYNC()      _q,
                        TO *           _y,
                        unsigned int * _ny)
 {
-    unsigned int i, ny=0, k=0;
-    for (i=0; i<_nx; i++) {
-        SYMSYNC(_step)(_q, _x[i], &_y[ny], &k);
-        ny += k;
-        //printf("%u\n",k);
+    unsigned int i, j, ny=0, k=0;
+
+    // run over contiguous spans of filterbank history and input,
+    // committing input to the filterbank buffer once per span
+    for (i=0; i<_nx; i+=LIQUID_FIRPFB_BLOCK_LEN) {
+        unsigned int num = _nx - i < LIQUID_FIRPFB_BLOCK_LEN ? _nx - i : LIQUID_FIRPFB_BLOCK_LEN;
+        TI * r = FIRPFB(_span_load)(_q->mf, &_x[i], num);
+        for (j=0; j<num; j++) {
+            if (_q->b >= _q->npfb) {
+                // no output for this sample: roll filterbank index over
+                _q->tau -= 1.0f;
+                _q->bf  -= (float)(_q->npfb);
+                _q->b   -= _q->npfb;
+                continue;
+            }
+            SYMSYNC(_step)(_q, r + j, &_y[ny], &k);
+            ny += k;
+        }
+        FIRPFB(_span_commit)(_q->mf, num);
     }
     *_ny = ny;
 }
@@ -444,19 +530,16 @@ void SYMSYNC(_execute)(SYMSYNC()      _q,
 //  _y      : output sample array pointer
 //  _ny     : number of output samples written
 void SYMSYNC(_step)(SYMSYNC()      _q,
-                    TI             _x,
+                    TI *           _r,
                     TO *           _y,
                     unsigned int * _ny)
 {
-    // push sample into MF and dMF filterbanks
-    FIRPFB(_push)(_q->mf,  _x);
-    FIRPFB(_push)(_q->dmf, _x);
-    
     // matched and derivative matched-filter outputs
     TO  mf; // matched filter output
     TO dmf; // derivative matched filter output
 
     unsigned int n=0;
+    int update;     // update timing loop for this output?
     
     // continue loop until filterbank index rolls over
     while (_q->b < _q->npfb) {
@@ -465,17 +548,15 @@ void SYMSYNC(_step)(SYMSYNC()      _q,
         printf("  [%2u] : tau : %12.8f, b : %4u (%12.8f)\n", n, _q->tau, _q->b, _q->bf);
 #endif
 
-        // compute filterbank output
-        FIRPFB(_execute)(_q->mf, _q->b, &mf);
-
-        // scale output by samples/symbol
-        _y[n] = mf / (float)(_q->k);
-
         // check output count and determine if this is 'ideal' timing output
+        update = 0;
         if (_q->decim_counter == _q->k_out) {
             // reset counter
             _q->decim_counter = 0;
 
+            // if synchronizer is locked, don't update internal timing offset
+            update = !_q->is_locked;
+
 #if DEBUG_SYMSYNC
             // save debugging variables
             windowf_push(_q->debug_rate,   _q->rate);
@@ -485,19 +566,22 @@ void SYMSYNC(_step)(SYMSYNC()      _q,
             windowf_push(_q->debug_b,      _q->b);
             windowf_push(_q->debug_q_hat,  _q->q_hat);
 #endif
+        }
 
-            // if synchronizer is locked, don't update internal timing offset
-            if (_q->is_locked)
-                continue;
-
-            // compute dMF output
-            FIRPFB(_execute)(_q->dmf, _q->b, &dmf);
-            
-            // update internal state
+        if (update) {
+            // compute MF and dMF outputs together and update internal
+            // timing state
+            SYMSYNC(_execute_mf_dmf)(_q, _q->b, _r, &mf, &dmf);
             SYMSYNC(_advance_internal_loop)(_q, mf, dmf);
             _q->tau_decim = _q->tau;    // save return value
+        } else {
+            // compute filterbank output
+            FIRPFB(_execute_window)(_q->mf, _q->b, _r, &mf);
         }
 
+        // scale output by samples/symbol
+        _y[n] = mf / (float)(_q->k);
+
         // increment decimation counter
         _q->decim_counter++;
 
@@ -517,6 +601,67 @@ void SYMSYNC(_step)(SYMSYNC()      _q,
     *_ny = n;
 }
 
+// compute matched and derivative matched filter outputs for
+// filterbank index _b in a single pass over the window _r
+//  _q      : synchronizer object
+//  _b      : filterbank index
+//  _r      : filterbank window [size: h_len x 1]
+//  _mf     : matched-filter output
+//  _dmf    : derivative matched-filter output
+void SYMSYNC(_execute_mf_dmf)(SYMSYNC()    _q,
+                              unsigned int _b,
+                              TI *         _r,
+                              TO *         _mf,
+                              TO *         _dmf)
+{
+    // half-precision coefficients: one pass per filter
+    if (_q->dh16 != NULL) {
+        FIRPFB(_execute_window)(_q->mf, _b, _r, _mf);
+        DOTPROD_F16(_run)(&_q->dh16[_b*_q->h_len], _r, _q->h_len, _dmf);
+        return;
+    }
+
+    const float * c = &_q->hmd[SYMSYNC_MD_WIDTH*_b*_q->h_len];
+    const float * x = (const float*) _r;
+    unsigned int n = _q->h_len;
+    unsigned int i;
+
+    // two taps per iteration with separate accumulators; the
+    // statements are isomorphic so that each group maps onto a
+    // single vector multiply-accumulate
+#if TI_COMPLEX
+    float v[4] = {0,0,0,0};
+    float w[4] = {0,0,0,0};
+    for (i=0; i+1<n; i+=2) {
+        v[0] += c[0]*x[0];  v[1] += c[1]*x[1];
+        v[2] += c[2]*x[0];  v[3] += c[3]*x[1];
+        w[0] += c[4]*x[2];  w[1] += c[5]*x[3];
+        w[2] += c[6]*x[2];  w[3] += c[7]*x[3];
+        c += 8;
+        x += 4;
+    }
+    if (i < n) {
+        v[0] += c[0]*x[0];  v[1] += c[1]*x[1];
+        v[2] += c[2]*x[0];  v[3] += c[3]*x[1];
+    }
+    *_mf  = (v[0] + w[0]) + _Complex_I*(v[1] + w[1]);
+    *_dmf = (v[2] + w[2]) + _Complex_I*(v[3] + w[3]);
+#else
+    float v[4] = {0,0,0,0};
+    for (i=0; i+1<n; i+=2) {
+        v[0] += c[0]*x[0];  v[1] += c[1]*x[0];
+        v[2] += c[2]*x[1];  v[3] += c[3]*x[1];
+        c += 4;
+        x += 2;
+    }
+    if (i < n) {
+        v[0] += c[0]*x[0];  v[1] += c[1]*x[0];
+    }
+    *_mf  = v[0] + v[2];
+    *_dmf = v[1] + v[3];
+#endif
+}
+
 // advance synchronizer's internal loop filter
 //  _q      : synchronizer object
 //  _mf     : matched-filter output
@@ -526,12 +671,8 @@ void SYMSYNC(_advance_internal_loop)(SYMSYNC() _q,
                                      TO        _dmf)
 {
     //  1. compute timing error signal, clipping large levels
-#if 0
+    // real part of conj(mf)*dmf, [Mengali:1997] Eq.~(8.3.5)
     _q->q = crealf(_mf)*crealf(_dmf) + cimagf(_mf)*cimagf(_dmf);
-#else
-    // TODO : use more efficient method to compute this
-    _q->q = crealf( conjf(_mf)*_dmf );  // [Mengali:1997] Eq.~(8.3.5)
-#endif
     // constrain timing error
     if      (_q->q >  1.0f) _q->q =  1.0f;  // clip large positive values
     else if (_q->q < -1.0f) _q->q = -1.0f;  // clip large negative values
@@ -576,19 +717,13 @@ void SYMSYNC(_output_debug_file)(SYMSYNC()    _q,
 
     // save filter responses
     FIRPFB(_reset)(_q->mf);
-    FIRPFB(_reset)(_q->dmf);
     fprintf(fid,"h = [];\n");
     fprintf(fid,"dh = [];\n");
     fprintf(fid,"h_len = %u;\n", _q->h_len);
     for (i=0; i<_q->h_len; i++) {
         // push impulse
-        if (i==0) {
-            FIRPFB(_push)(_q->mf,  1.0f);
-            FIRPFB(_push)(_q->dmf, 1.0f);
-        } else {
-            FIRPFB(_push)(_q->mf,  0.0f);
-            FIRPFB(_push)(_q->dmf, 0.0f);
-        }
+        if (i==0) FIRPFB(_push)(_q->mf, 1.0f);
+        else      FIRPFB(_push)(_q->mf, 0.0f);
 
         // compute output for all filters
         TO  mf;     // matched filter output
@@ -596,8 +731,7 @@ void SYMSYNC(_output_debug_file)(SYMSYNC()    _q,
 
         unsigned int n;
         for (n=0; n<_q->npfb; n++) {
-            FIRPFB(_execute)(_q->mf,  n, &mf);
-            FIRPFB(_execute)(_q->dmf, n, &dmf);
+            SYMSYNC(_execute_mf_dmf)(_q, n, FIRPFB(_get_window)(_q->mf), &mf, &dmf);
 
             fprintf(fid,"h(%4u) = %12.8f; dh(%4u) = %12.8f;\n", i*_q->npfb+n+1, crealf(mf), i*_q->npfb+n+1, crealf(dmf));
         }
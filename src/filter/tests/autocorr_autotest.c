@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <complex.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// helper function: compare recursive auto-correlation against direct
+// computation, switching to recursive mode part way through
+void autocorr_cccf_test_recursive(unsigned int _window_size,
+                                  unsigned int _delay)
+{
+    unsigned int num_samples = 20*_window_size + 37;
+    unsigned int i;
+
+    autocorr_cccf q0 = autocorr_cccf_create(_window_size, _delay);
+    autocorr_cccf q1 = autocorr_cccf_create(_window_size, _delay);
+    CONTEND_EQUALITY( autocorr_cccf_get_recursive(q1), 0 );
+
+    float complex rxx0, rxx1;
+    for (i=0; i<num_samples; i++) {
+        if (i == 3*_window_size/2 + 5)
+            autocorr_cccf_set_recursive(q1, 1);
+
+        float complex x = randnf() + _Complex_I*randnf();
+        autocorr_cccf_push(q0, x);
+        autocorr_cccf_push(q1, x);
+        autocorr_cccf_execute(q0, &rxx0);
+        autocorr_cccf_execute(q1, &rxx1);
+
+        float tol = 1e-4f*autocorr_cccf_get_energy(q0);
+        CONTEND_DELTA( crealf(rxx1), crealf(rxx0), tol );
+        CONTEND_DELTA( cimagf(rxx1), cimagf(rxx0), tol );
+        CONTEND_DELTA( autocorr_cccf_get_energy(q1), autocorr_cccf_get_energy(q0), tol );
+    }
+    CONTEND_EQUALITY( autocorr_cccf_get_recursive(q1), 1 );
+
+    // block execution, after reset
+    autocorr_cccf_reset(q0);
+    autocorr_cccf_reset(q1);
+    float complex x[num_samples];
+    float complex y0[num_samples];
+    float complex y1[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    autocorr_cccf_execute_block(q0, x, num_samples, y0);
+    autocorr_cccf_execute_block(q1, x, num_samples, y1);
+    for (i=0; i<num_samples; i++)
+        CONTEND_DELTA( cabsf(y1[i] - y0[i]), 0.0f, 1e-4f*2*_window_size );
+
+    autocorr_cccf_destroy(q0);
+    autocorr_cccf_destroy(q1);
+}
+
+void autotest_autocorr_cccf_recursive_w16_d4()   { autocorr_cccf_test_recursive( 16,  4); }
+void autotest_autocorr_cccf_recursive_w64_d16()  { autocorr_cccf_test_recursive( 64, 16); }
+void autotest_autocorr_cccf_recursive_w100_d1()  { autocorr_cccf_test_recursive(100,  1); }
+
+// 
+// AUTOTEST : real auto-correlation, recursive mode
+//
+void autotest_autocorr_rrrf_recursive()
+{
+    unsigned int window_size = 32;
+    unsigned int delay       = 8;
+    unsigned int i;
+
+    autocorr_rrrf q0 = autocorr_rrrf_create(window_size, delay);
+    autocorr_rrrf q1 = autocorr_rrrf_create(window_size, delay);
+    autocorr_rrrf_set_recursive(q1, 1);
+
+    float rxx0, rxx1;
+    for (i=0; i<1000; i++) {
+        float x = randnf();
+        autocorr_rrrf_push(q0, x);
+        autocorr_rrrf_push(q1, x);
+        autocorr_rrrf_execute(q0, &rxx0);
+        autocorr_rrrf_execute(q1, &rxx1);
+        CONTEND_DELTA( rxx1, rxx0, 1e-4f*window_size );
+    }
+
+    autocorr_rrrf_destroy(q0);
+    autocorr_rrrf_destroy(q1);
+}
@@ -117,3 +117,145 @@ void autotest_fftfilt_cccf_data_h23x256()
 }
 
 
+
+// compare fftfilt with explicit transform size against firfilt
+void fftfilt_test_nfft(unsigned int _h_len,
+                       unsigned int _n,
+                       unsigned int _nfft)
+{
+    float tol = 1e-3f;
+    unsigned int num_blocks = 6;
+    unsigned int i;
+
+    // generate filter and input
+    float h[_h_len];
+    for (i=0; i<_h_len; i++)
+        h[i] = cosf(0.3f*i) / (float)_h_len;
+    float rx[_n*num_blocks];
+    float complex cx[_n*num_blocks];
+    for (i=0; i<_n*num_blocks; i++) {
+        rx[i] = sinf(0.17f*i) + 0.3f*cosf(1.1f*i);
+        cx[i] = rx[i] + _Complex_I*cosf(0.71f*i);
+    }
+
+    firfilt_rrrf f_rrrf = firfilt_rrrf_create(h, _h_len);
+    firfilt_crcf f_crcf = firfilt_crcf_create(h, _h_len);
+    fftfilt_rrrf q_rrrf = fftfilt_rrrf_create_nfft(h, _h_len, _n, _nfft);
+    fftfilt_crcf q_crcf = fftfilt_crcf_create_nfft(h, _h_len, _n, _nfft);
+    CONTEND_EQUALITY(fftfilt_crcf_get_block_len(q_crcf), _n);
+    CONTEND_EQUALITY(fftfilt_crcf_get_nfft(q_crcf),      _nfft);
+
+    float         ry0[_n*num_blocks], ry1[_n*num_blocks];
+    float complex cy0[_n*num_blocks], cy1[_n*num_blocks];
+    firfilt_rrrf_execute_block(f_rrrf, rx, _n*num_blocks, ry0);
+    firfilt_crcf_execute_block(f_crcf, cx, _n*num_blocks, cy0);
+    for (i=0; i<num_blocks; i++) {
+        fftfilt_rrrf_execute(q_rrrf, &rx[i*_n], &ry1[i*_n]);
+        fftfilt_crcf_execute(q_crcf, &cx[i*_n], &cy1[i*_n]);
+    }
+
+    for (i=0; i<_n*num_blocks; i++) {
+        CONTEND_DELTA( ry1[i], ry0[i], tol );
+        CONTEND_DELTA( crealf(cy1[i]), crealf(cy0[i]), tol );
+        CONTEND_DELTA( cimagf(cy1[i]), cimagf(cy0[i]), tol );
+    }
+
+    firfilt_rrrf_destroy(f_rrrf);
+    firfilt_crcf_destroy(f_crcf);
+    fftfilt_rrrf_destroy(q_rrrf);
+    fftfilt_crcf_destroy(q_crcf);
+}
+
+// block much larger than filter
+void autotest_fftfilt_nfft_h9_n248()  { fftfilt_test_nfft( 9, 248, 256); }
+// block shorter than overlap
+void autotest_fftfilt_nfft_h40_n8()   { fftfilt_test_nfft(40,   8,  64); }
+// oversized transform
+void autotest_fftfilt_nfft_h13_n20()  { fftfilt_test_nfft(13,  20, 128); }
+
+// selection heuristic
+void autotest_fftfilt_select()
+{
+    unsigned int nfft = 0;
+
+    // short filters run direct-form
+    CONTEND_EQUALITY(liquid_fftfilt_select(8, 1<<16, &nfft), 0);
+    CONTEND_EQUALITY(nfft, 0);
+
+    // long filters with generous latency budget run with FFTs
+    unsigned int h_len = 1024;
+    unsigned int n = liquid_fftfilt_select(h_len, 1<<16, &nfft);
+    CONTEND_GREATER_THAN(n, 0);
+    CONTEND_EQUALITY(n, nfft - h_len + 1);
+    CONTEND_EQUALITY(1U << liquid_nextpow2(nfft), nfft);
+
+    // latency budget is respected
+    n = liquid_fftfilt_select(h_len, 2000, &nfft);
+    CONTEND_LESS_THAN(n, 2001);
+
+    // no budget: direct form
+    CONTEND_EQUALITY(liquid_fftfilt_select(h_len, 0, &nfft), 0);
+}
+
+// compare partitioned fftfilt against firfilt
+void fftfilt_test_partitioned(unsigned int _h_len,
+                              unsigned int _n)
+{
+    float tol = 1e-3f;
+    unsigned int num_blocks = (2*_h_len) / _n + 4;
+    unsigned int num_samples = _n*num_blocks;
+    unsigned int i;
+
+    // generate filters and input
+    float         hr[_h_len];
+    float complex hc[_h_len];
+    for (i=0; i<_h_len; i++) {
+        hr[i] = cosf(0.3f*i) * expf(-3.0f*i/(float)_h_len) / sqrtf(_h_len);
+        hc[i] = hr[i] + _Complex_I*0.5f*sinf(0.2f*i) / sqrtf(_h_len);
+    }
+    float         rx[num_samples];
+    float complex cx[num_samples];
+    for (i=0; i<num_samples; i++) {
+        rx[i] = sinf(0.17f*i) + 0.3f*cosf(1.1f*i);
+        cx[i] = rx[i] + _Complex_I*cosf(0.71f*i);
+    }
+
+    firfilt_rrrf f_rrrf = firfilt_rrrf_create(hr, _h_len);
+    firfilt_cccf f_cccf = firfilt_cccf_create(hc, _h_len);
+    fftfilt_rrrf q_rrrf = fftfilt_rrrf_create_partitioned(hr, _h_len, _n);
+    fftfilt_cccf q_cccf = fftfilt_cccf_create_partitioned(hc, _h_len, _n);
+    CONTEND_EQUALITY(fftfilt_cccf_get_block_len(q_cccf),      _n);
+    CONTEND_EQUALITY(fftfilt_cccf_get_num_partitions(q_cccf), (_h_len+_n-1)/_n);
+
+    float         ry0[num_samples], ry1[num_samples];
+    float complex cy0[num_samples], cy1[num_samples];
+    firfilt_rrrf_execute_block(f_rrrf, rx, num_samples, ry0);
+    firfilt_cccf_execute_block(f_cccf, cx, num_samples, cy0);
+    for (i=0; i<num_blocks; i++) {
+        fftfilt_rrrf_execute(q_rrrf, &rx[i*_n], &ry1[i*_n]);
+        fftfilt_cccf_execute(q_cccf, &cx[i*_n], &cy1[i*_n]);
+    }
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( ry1[i], ry0[i], tol );
+        CONTEND_DELTA( crealf(cy1[i]), crealf(cy0[i]), tol );
+        CONTEND_DELTA( cimagf(cy1[i]), cimagf(cy0[i]), tol );
+    }
+
+    // reset restores initial state
+    fftfilt_rrrf_reset(q_rrrf);
+    fftfilt_rrrf_execute(q_rrrf, rx, ry1);
+    for (i=0; i<_n; i++)
+        CONTEND_DELTA( ry1[i], ry0[i], tol );
+
+    firfilt_rrrf_destroy(f_rrrf);
+    firfilt_cccf_destroy(f_cccf);
+    fftfilt_rrrf_destroy(q_rrrf);
+    fftfilt_cccf_destroy(q_cccf);
+}
+
+void autotest_fftfilt_partitioned_h1_n16()   { fftfilt_test_partitioned(   1, 16); }
+void autotest_fftfilt_partitioned_h16_n16()  { fftfilt_test_partitioned(  16, 16); }
+void autotest_fftfilt_partitioned_h203_n32() { fftfilt_test_partitioned( 203, 32); }
+void autotest_fftfilt_partitioned_h1000_n64(){ fftfilt_test_partitioned(1000, 64); }
+
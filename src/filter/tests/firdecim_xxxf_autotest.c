@@ -128,4 +128,93 @@ void autotest_firdecim_cccf_data_M5h23x50()
                        firdecim_cccf_data_M5h23x50_y, 10);
 }
 
+//
+// AUTOTEST: firdecim_crcf block execution matches sample-by-sample
+//  _M      :   decimation factor
+//  _h_len  :   filter length
+//
+void firdecim_crcf_test_block(unsigned int _M,
+                              unsigned int _h_len)
+{
+    float tol = 1e-4f;
+    unsigned int M     = _M;
+    unsigned int h_len = _h_len;
+    unsigned int n     = 100;   // number of outputs
+
+    float h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    float complex x[n*M];
+    for (i=0; i<n*M; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    firdecim_crcf q0 = firdecim_crcf_create(M, h, h_len);
+    firdecim_crcf q1 = firdecim_crcf_create(M, h, h_len);
+
+    // run one output at a time
+    float complex y0[n];
+    for (i=0; i<n; i++)
+        firdecim_crcf_execute(q0, &x[i*M], &y0[i]);
+
+    // run in irregular blocks
+    float complex y1[n];
+    unsigned int num = 1;
+    for (i=0; i<n; i+=num) {
+        num = (num % 41) + 3;
+        if (i + num > n) num = n - i;
+        firdecim_crcf_execute_block(q1, &x[i*M], num, &y1[i]);
+    }
+
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    firdecim_crcf_destroy(q0);
+    firdecim_crcf_destroy(q1);
+}
 
+// polyphase (small factor) and direct block paths, including filters
+// much longer than a block of input
+void autotest_firdecim_crcf_block()       { firdecim_crcf_test_block( 3,  25); }
+void autotest_firdecim_crcf_block_M2()    { firdecim_crcf_test_block( 2,  41); }
+void autotest_firdecim_crcf_block_M4h7()  { firdecim_crcf_test_block( 4,   7); }
+void autotest_firdecim_crcf_block_M16()   { firdecim_crcf_test_block(16, 257); }
+
+
+
+//
+// AUTOTEST: impulse aligned to the first input sample of a block
+// peaks at the reported decimator delay
+//
+void autotest_firdecim_crcf_delay()
+{
+    unsigned int M = 4;
+    unsigned int m = 5;
+    unsigned int n = 4*m;
+    firdecim_crcf q0 = firdecim_crcf_create_kaiser(M, m, 60.0f);
+    firdecim_crcf q1 = firdecim_crcf_create_prototype(LIQUID_FIRFILT_RRC, M, m, 0.3f, 0.0f);
+    CONTEND_EQUALITY(firdecim_crcf_get_delay(q0), (float)m);
+    CONTEND_EQUALITY(firdecim_crcf_get_delay(q1), (float)m);
+
+    unsigned int i;
+    float complex x[n*M];
+    for (i=0; i<n*M; i++)
+        x[i] = (i == 0) ? 1.0f : 0.0f;
+
+    float complex y0[n], y1[n];
+    firdecim_crcf_execute_block(q0, x, n, y0);
+    firdecim_crcf_execute_block(q1, x, n, y1);
+    unsigned int i0 = 0, i1 = 0;
+    for (i=0; i<n; i++) {
+        if (cabsf(y0[i]) > cabsf(y0[i0])) i0 = i;
+        if (cabsf(y1[i]) > cabsf(y1[i1])) i1 = i;
+    }
+    CONTEND_EQUALITY(i0, m);
+    CONTEND_EQUALITY(i1, m);
+
+    firdecim_crcf_destroy(q0);
+    firdecim_crcf_destroy(q1);
+}
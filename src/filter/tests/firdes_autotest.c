@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <stdio.h>
+#include <string.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -118,3 +120,89 @@ void autotest_liquid_firdes_rkaiser()
 }
 
 
+
+// filter design cache returns identical designs and round-trips
+// through its on-disk form
+void autotest_liquid_firdes_cache()
+{
+    const char * filename = "liquid_firdes_cache_autotest.txt";
+    unsigned int k=2, m=7;
+    unsigned int h_len = 2*k*m+1;
+    float h0[h_len], h1[h_len], h2[h_len];
+
+    liquid_firdes_cache_clear();
+    liquid_firdes_cache_enable();
+    CONTEND_EQUALITY(liquid_firdes_cache_is_enabled(), 1);
+
+    // first design populates the cache; repeated design is identical
+    liquid_firdes_prototype(LIQUID_FIRFILT_RKAISER, k, m, 0.3f, 0.0f, h0);
+    unsigned int n = liquid_firdes_cache_get_num_entries();
+    CONTEND_EQUALITY(n, 1);
+    liquid_firdes_prototype(LIQUID_FIRFILT_RKAISER, k, m, 0.3f, 0.0f, h1);
+    CONTEND_EQUALITY(liquid_firdes_cache_get_num_entries(), n);
+    CONTEND_SAME_DATA(h0, h1, h_len*sizeof(float));
+
+    // direct design shares the prototype entry
+    liquid_firdes_rkaiser(k, m, 0.3f, 0.0f, h1);
+    CONTEND_EQUALITY(liquid_firdes_cache_get_num_entries(), n);
+    CONTEND_SAME_DATA(h0, h1, h_len*sizeof(float));
+
+    // different parameters are separate entries
+    liquid_firdes_prototype(LIQUID_FIRFILT_RKAISER, k, m, 0.25f, 0.0f, h2);
+    CONTEND_EQUALITY(liquid_firdes_cache_get_num_entries(), n+1);
+
+    float bands[4] = {0.0f, 0.1f, 0.2f, 0.5f};
+    float des[2]   = {1.0f, 0.0f};
+    float w[2]     = {1.0f, 1.0f};
+    firdespm_run(31, 2, bands, des, w, NULL, LIQUID_FIRDESPM_BANDPASS, h1);
+    firdespm_run(31, 2, bands, des, w, NULL, LIQUID_FIRDESPM_BANDPASS, h1);
+    CONTEND_EQUALITY(liquid_firdes_cache_get_num_entries(), n+2);
+
+    // save, clear, and load
+    CONTEND_EQUALITY(liquid_firdes_cache_save(filename), 0);
+    liquid_firdes_cache_clear();
+    CONTEND_EQUALITY(liquid_firdes_cache_get_num_entries(), 0);
+    CONTEND_EQUALITY(liquid_firdes_cache_load(filename), 0);
+    CONTEND_EQUALITY(liquid_firdes_cache_get_num_entries(), n+2);
+    liquid_firdes_prototype(LIQUID_FIRFILT_RKAISER, k, m, 0.3f, 0.0f, h1);
+    CONTEND_EQUALITY(liquid_firdes_cache_get_num_entries(), n+2);
+    CONTEND_SAME_DATA(h0, h1, h_len*sizeof(float));
+
+    // restore default state
+    liquid_firdes_cache_clear();
+    liquid_firdes_cache_disable();
+    CONTEND_EQUALITY(liquid_firdes_cache_is_enabled(), 0);
+    remove(filename);
+}
+
+// loaded cache entries are returned in place of a fresh design
+void autotest_liquid_firdes_cache_load()
+{
+    const char * filename = "liquid_firdes_cache_load_autotest.txt";
+    FILE * fid = fopen(filename, "w");
+    CONTEND_EXPRESSION(fid != NULL);
+    if (fid == NULL)
+        return;
+    // designer 1 (prototype), key {RRC, k=2, m=1, beta=0.5, dt=0}
+    fprintf(fid,"# liquid firdes cache v1\n");
+    fprintf(fid,"1 5 5\n%a %a %a %a %a\n", (float)LIQUID_FIRFILT_RRC, 2.0f, 1.0f, 0.5f, 0.0f);
+    fprintf(fid,"%a %a %a %a %a\n", 1.0f, 2.0f, 3.0f, 4.0f, 5.0f);
+    fclose(fid);
+
+    liquid_firdes_cache_clear();
+    liquid_firdes_cache_enable();
+    CONTEND_EQUALITY(liquid_firdes_cache_load(filename), 0);
+
+    float h[5];
+    float h_test[5] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    liquid_firdes_prototype(LIQUID_FIRFILT_RRC, 2, 1, 0.5f, 0.0f, h);
+    CONTEND_SAME_DATA(h, h_test, 5*sizeof(float));
+
+    // disabled cache is bypassed
+    liquid_firdes_cache_disable();
+    liquid_firdes_prototype(LIQUID_FIRFILT_RRC, 2, 1, 0.5f, 0.0f, h);
+    CONTEND_EXPRESSION(memcmp(h, h_test, 5*sizeof(float)) != 0);
+
+    liquid_firdes_cache_clear();
+    remove(filename);
+}
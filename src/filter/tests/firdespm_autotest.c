@@ -145,3 +145,39 @@ void autotest_firdespm_bandpass_n32()
         CONTEND_DELTA( h[i], h0[i], tol );
 }
 
+
+// warm start from a nearby design's extremal set converges to the same filter
+void autotest_firdespm_warm()
+{
+    unsigned int n=51;
+    unsigned int num_bands=2;
+    float bands0[4]  = {0.0f,0.100f,0.120f,0.50f};
+    float bands1[4]  = {0.0f,0.102f,0.122f,0.50f};
+    float des[2]     = {1.0f,0.0f};
+    float weights[2] = {1.0f,10.0f};
+    liquid_firdespm_btype btype = LIQUID_FIRDESPM_BANDPASS;
+    float tol = 1e-5f;
+
+    // extremal set of initial design
+    float h[n];
+    float fext[(n+1)/2 + 1];
+    firdespm q = firdespm_create(n,num_bands,bands0,des,weights,NULL,btype);
+    firdespm_execute(q,h);
+    firdespm_get_extremals(q,fext);
+    firdespm_destroy(q);
+
+    // redesign with shifted band edges, cold and warm
+    float h_cold[n];
+    float h_warm[n];
+    q = firdespm_create(n,num_bands,bands1,des,weights,NULL,btype);
+    firdespm_execute(q,h_cold);
+    firdespm_destroy(q);
+
+    q = firdespm_create(n,num_bands,bands1,des,weights,NULL,btype);
+    firdespm_execute_warm(q,fext,h_warm);
+    firdespm_destroy(q);
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( h_warm[i], h_cold[i], tol );
+}
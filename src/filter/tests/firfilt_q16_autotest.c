@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// fixed-point filter is within one LSB of floating-point filter, and
+// block execution matches sample-by-sample execution exactly
+void autotest_firfilt_rrrq16()
+{
+    unsigned int h_len = 31;    // filter length
+    unsigned int num   = 200;   // number of samples
+    float tol = 1.0f / 32768.0f;
+
+    // design filter; normalize taps so accumulator cannot overflow
+    float hf[h_len];
+    liquid_firdes_kaiser(h_len, 0.2f, 60.0f, 0.0f, hf);
+    float g = 0.0f;
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        g += fabsf(hf[i]);
+    q16_t h[h_len];
+    for (i=0; i<h_len; i++) {
+        h[i]  = q16_float_to_fixed(0.9f*hf[i]/g);
+        hf[i] = q16_fixed_to_float(h[i]);
+    }
+
+    firfilt_rrrf   qf = firfilt_rrrf_create(hf, h_len);
+    firfilt_rrrq16 q0 = firfilt_rrrq16_create(h, h_len);
+    firfilt_rrrq16 q1 = firfilt_rrrq16_create(h, h_len);
+
+    q16_t x[num];
+    q16_t y0[num];
+    q16_t y1[num];
+    for (i=0; i<num; i++)
+        x[i] = q16_float_to_fixed(0.9f*sinf(0.1f*i) + 0.05f*randnf());
+
+    // run in uneven blocks to exercise buffer wrap-around
+    unsigned int n = 0;
+    unsigned int b = 1;
+    while (n < num) {
+        unsigned int k = n + b > num ? num - n : b;
+        firfilt_rrrq16_execute_block(q1, &x[n], k, &y1[n]);
+        n += k;
+        b = (b % 13) + 3;
+    }
+
+    for (i=0; i<num; i++) {
+        float yf;
+        firfilt_rrrf_push(qf, q16_fixed_to_float(x[i]));
+        firfilt_rrrf_execute(qf, &yf);
+
+        firfilt_rrrq16_push(q0, x[i]);
+        firfilt_rrrq16_execute(q0, &y0[i]);
+
+        CONTEND_DELTA(q16_fixed_to_float(y0[i]), yf, tol);
+        CONTEND_EQUALITY(y0[i], y1[i]);
+    }
+
+    CONTEND_EQUALITY(firfilt_rrrq16_get_length(q0), h_len);
+
+    firfilt_rrrf_destroy(qf);
+    firfilt_rrrq16_destroy(q0);
+    firfilt_rrrq16_destroy(q1);
+}
+
+// complex fixed-point filter against floating-point filter
+void autotest_firfilt_crcq16()
+{
+    unsigned int h_len = 24;    // filter length
+    unsigned int num   = 100;   // number of samples
+    float tol = 1.0f / 32768.0f;
+
+    float hf[h_len];
+    liquid_firdes_kaiser(h_len, 0.3f, 60.0f, 0.0f, hf);
+    float g = 0.0f;
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        g += fabsf(hf[i]);
+    q16_t h[h_len];
+    for (i=0; i<h_len; i++) {
+        h[i]  = q16_float_to_fixed(0.9f*hf[i]/g);
+        hf[i] = q16_fixed_to_float(h[i]);
+    }
+
+    firfilt_crcf   qf = firfilt_crcf_create(hf, h_len);
+    firfilt_crcq16 q  = firfilt_crcq16_create(h, h_len);
+
+    cq16_t x[num];
+    cq16_t y[num];
+    for (i=0; i<num; i++) {
+        x[i].real = q16_float_to_fixed(0.9f*cosf(0.07f*i));
+        x[i].imag = q16_float_to_fixed(0.9f*sinf(0.07f*i));
+    }
+    firfilt_crcq16_execute_block(q, x, num, y);
+
+    for (i=0; i<num; i++) {
+        float complex yf;
+        firfilt_crcf_push(qf, q16_fixed_to_float(x[i].real) + _Complex_I*q16_fixed_to_float(x[i].imag));
+        firfilt_crcf_execute(qf, &yf);
+
+        CONTEND_DELTA(q16_fixed_to_float(y[i].real), crealf(yf), tol);
+        CONTEND_DELTA(q16_fixed_to_float(y[i].imag), cimagf(yf), tol);
+    }
+
+    // re-create with different length, then restore
+    q = firfilt_crcq16_recreate(q, h, h_len/2);
+    CONTEND_EQUALITY(firfilt_crcq16_get_length(q), h_len/2);
+    q = firfilt_crcq16_recreate(q, h, h_len);
+    CONTEND_EQUALITY(firfilt_crcq16_get_length(q), h_len);
+
+    firfilt_crcf_destroy(qf);
+    firfilt_crcq16_destroy(q);
+}
+
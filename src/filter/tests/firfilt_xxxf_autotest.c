@@ -24,6 +24,7 @@
 // firfilt_xxxf_autotest.c : test floating-point filters
 //
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -116,4 +117,313 @@ void autotest_firfilt_cccf_data_h23x64()
                       firfilt_cccf_data_h23x64_y, 64);
 }
 
+//
+// AUTOTEST: firfilt_crcf block execution matches sample-by-sample
+//
+void autotest_firfilt_crcf_block()
+{
+    float tol = 1e-4f;
+    unsigned int h_len = 21;
+    unsigned int n     = 500;
+
+    float h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    firfilt_crcf q0 = firfilt_crcf_create(h, h_len);
+    firfilt_crcf q1 = firfilt_crcf_create(h, h_len);
+    firfilt_crcf_set_scale(q0, 0.5f);
+    firfilt_crcf_set_scale(q1, 0.5f);
+
+    // run sample by sample
+    float complex y0[n];
+    for (i=0; i<n; i++) {
+        firfilt_crcf_push(q0, x[i]);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+
+    // run in irregular blocks so that buffer wraps at various offsets
+    float complex y1[n];
+    unsigned int num = 1;
+    for (i=0; i<n; i+=num) {
+        num = (num % 37) + 5;
+        if (i + num > n) num = n - i;
+        firfilt_crcf_execute_block(q1, &x[i], num, &y1[i]);
+    }
+
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+
+//
+// AUTOTEST: priming the filter with the first get_delay() samples and
+// flushing it at the end yields outputs aligned with their inputs
+//
+void autotest_firfilt_crcf_prime_flush()
+{
+    float tol = 1e-4f;
+    unsigned int m = 7;
+    unsigned int h_len = 2*m+1;
+    unsigned int n = 300;
+
+    firfilt_crcf q0 = firfilt_crcf_create_kaiser(h_len, 0.2f, 60.0f, 0.0f);
+    firfilt_crcf q1 = firfilt_crcf_create_kaiser(h_len, 0.2f, 60.0f, 0.0f);
+    firfilt_crcf q2 = firfilt_crcf_create_kaiser(h_len, 0.2f, 60.0f, 0.0f);
+    CONTEND_EQUALITY(firfilt_crcf_get_delay(q0), (float)m);
+
+    unsigned int i;
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // reference: run signal followed by zeros and discard delay
+    float complex y0[n+m];
+    for (i=0; i<n+m; i++) {
+        firfilt_crcf_push(q0, i < n ? x[i] : 0.0f);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+
+    // prime with the first m samples (shorter than the filter)
+    float complex y1[n];
+    firfilt_crcf_prime(q1, x, m);
+    firfilt_crcf_execute_block(q1, &x[m], n-m, y1);
+    firfilt_crcf_flush(q1, m, &y1[n-m]);
+
+    // prime with a block longer than the filter, replacing the
+    // history entirely
+    unsigned int p = 3*h_len;
+    float complex y2[n-p+m];
+    firfilt_crcf_execute_block(q2, x, 10, y2);
+    firfilt_crcf_prime(q2, &x[10], p-10);
+    firfilt_crcf_execute_block(q2, &x[p], n-p, y2);
+    firfilt_crcf_flush(q2, m, &y2[n-p]);
+
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i+m]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i+m]), tol );
+    }
+    for (i=0; i<n-p+m; i++) {
+        CONTEND_DELTA( crealf(y2[i]), crealf(y0[i+p]), tol );
+        CONTEND_DELTA( cimagf(y2[i]), cimagf(y0[i+p]), tol );
+    }
+
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+    firfilt_crcf_destroy(q2);
+}
+
+//
+// AUTOTEST: in-place coefficient update matches re-created filter
+//
+void autotest_firfilt_cccf_set_coefficients()
+{
+    float tol = 1e-4f;
+    unsigned int h_len = 13;
+    unsigned int n     = 200;
+
+    unsigned int i;
+    float complex h0[h_len], h1[h_len], h_test[h_len];
+    for (i=0; i<h_len; i++) {
+        h0[i] = randnf() + randnf()*_Complex_I;
+        h1[i] = randnf() + randnf()*_Complex_I;
+    }
+
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    firfilt_cccf q0 = firfilt_cccf_create(h0, h_len);
+    firfilt_cccf q1 = firfilt_cccf_create(h0, h_len);
+
+    // run first half, then swap coefficients mid-stream
+    float complex y0[n], y1[n];
+    firfilt_cccf_execute_block(q0, x, n/2, y0);
+    firfilt_cccf_execute_block(q1, x, n/2, y1);
+    q0 = firfilt_cccf_recreate(q0, h1, h_len);
+    firfilt_cccf_set_coefficients(q1, h1);
+    firfilt_cccf_get_coefficients(q1, h_test);
+    for (i=0; i<h_len; i++) {
+        CONTEND_EQUALITY( crealf(h_test[i]), crealf(h1[i]) );
+        CONTEND_EQUALITY( cimagf(h_test[i]), cimagf(h1[i]) );
+    }
+
+    // alternate single-sample and block execution
+    for (i=n/2; i<n; i++) {
+        firfilt_cccf_push(q0, x[i]);
+        firfilt_cccf_execute(q0, &y0[i]);
+    }
+    firfilt_cccf_execute_block(q1, &x[n/2], n/2, &y1[n/2]);
+
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    firfilt_cccf_destroy(q0);
+    firfilt_cccf_destroy(q1);
+}
+
+//
+// AUTOTEST: least mean-squares adaptation identifies unknown system
+//
+void autotest_firfilt_cccf_adapt()
+{
+    float tol = 1e-3f;
+    unsigned int h_len = 8;
+    unsigned int n     = 2000;
+    float mu = 0.02f;
+
+    unsigned int i;
+    float complex h[h_len], h_hat[h_len];
+    for (i=0; i<h_len; i++)
+        h[i] = (randnf() + randnf()*_Complex_I) * M_SQRT1_2;
+
+    // unknown system and adaptive filter starting from zero
+    firfilt_cccf qs = firfilt_cccf_create(h, h_len);
+    for (i=0; i<h_len; i++)
+        h_hat[i] = 0.0f;
+    firfilt_cccf q = firfilt_cccf_create(h_hat, h_len);
 
+    for (i=0; i<n; i++) {
+        float complex x = (randnf() + randnf()*_Complex_I) * M_SQRT1_2;
+        float complex d, y;
+        firfilt_cccf_push(qs, x);
+        firfilt_cccf_execute(qs, &d);
+        firfilt_cccf_push(q, x);
+        firfilt_cccf_execute(q, &y);
+        firfilt_cccf_adapt(q, mu, d - y);
+    }
+
+    firfilt_cccf_get_coefficients(q, h_hat);
+    for (i=0; i<h_len; i++) {
+        CONTEND_DELTA( crealf(h_hat[i]), crealf(h[i]), tol );
+        CONTEND_DELTA( cimagf(h_hat[i]), cimagf(h[i]), tol );
+    }
+
+    firfilt_cccf_destroy(qs);
+    firfilt_cccf_destroy(q);
+}
+
+// real coefficients with complex input adapt on real part of gradient
+void autotest_firfilt_crcf_adapt()
+{
+    float tol = 1e-3f;
+    unsigned int h_len = 8;
+    unsigned int n     = 2000;
+    float mu = 0.02f;
+
+    unsigned int i;
+    float h[h_len], h_hat[h_len];
+    for (i=0; i<h_len; i++) {
+        h[i]     = randnf();
+        h_hat[i] = 0.0f;
+    }
+
+    firfilt_crcf qs = firfilt_crcf_create(h, h_len);
+    firfilt_crcf q  = firfilt_crcf_create(h_hat, h_len);
+
+    for (i=0; i<n; i++) {
+        float complex x = (randnf() + randnf()*_Complex_I) * M_SQRT1_2;
+        float complex d, y;
+        firfilt_crcf_push(qs, x);
+        firfilt_crcf_execute(qs, &d);
+        firfilt_crcf_push(q, x);
+        firfilt_crcf_execute(q, &y);
+        firfilt_crcf_adapt(q, mu, d - y);
+    }
+
+    firfilt_crcf_get_coefficients(q, h_hat);
+    for (i=0; i<h_len; i++)
+        CONTEND_DELTA( h_hat[i], h[i], tol );
+
+    firfilt_crcf_destroy(qs);
+    firfilt_crcf_destroy(q);
+}
+
+//
+// AUTOTEST: 16-bit integer block execution matches widened input
+//
+void autotest_firfilt_crcf_block_ci16()
+{
+    unsigned int h_len = 21;
+    unsigned int n     = 500;
+    float        g     = 1.0f / 32768.0f;
+
+    float h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    int16_t x[2*n];
+    float complex v[n];
+    for (i=0; i<2*n; i++)
+        x[i] = (int16_t)((rand() & 0xffff) - 32768);
+    for (i=0; i<n; i++)
+        v[i] = ((float)x[2*i] + (float)x[2*i+1]*_Complex_I) * g;
+
+    firfilt_crcf q0 = firfilt_crcf_create(h, h_len);
+    firfilt_crcf q1 = firfilt_crcf_create(h, h_len);
+    firfilt_crcf_set_scale(q0, 0.5f);
+    firfilt_crcf_set_scale(q1, 0.5f);
+
+    // run in irregular blocks so that buffer wraps at various offsets
+    float complex y0[n], y1[n];
+    unsigned int num = 1;
+    for (i=0; i<n; i+=num) {
+        num = (num % 37) + 5;
+        if (i + num > n) num = n - i;
+        firfilt_crcf_execute_block(q0, &v[i], num, &y0[i]);
+        firfilt_crcf_execute_block_ci16(q1, &x[2*i], num, g, &y1[i]);
+    }
+
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( y1[i], y0[i] );
+
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+//
+// AUTOTEST: 16-bit integer block execution (real) matches widened input
+//
+void autotest_firfilt_rrrf_block_s16()
+{
+    unsigned int h_len = 13;
+    unsigned int n     = 300;
+    float        g     = 1e-3f;
+
+    float h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    int16_t x[n];
+    float v[n];
+    for (i=0; i<n; i++) {
+        x[i] = (int16_t)((rand() & 0xffff) - 32768);
+        v[i] = (float)x[i] * g;
+    }
+
+    firfilt_rrrf q0 = firfilt_rrrf_create(h, h_len);
+    firfilt_rrrf q1 = firfilt_rrrf_create(h, h_len);
+    float y0[n], y1[n];
+    firfilt_rrrf_execute_block(q0, v, n, y0);
+    firfilt_rrrf_execute_block_s16(q1, x, n, g, y1);
+
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( y1[i], y0[i] );
+
+    firfilt_rrrf_destroy(q0);
+    firfilt_rrrf_destroy(q1);
+}
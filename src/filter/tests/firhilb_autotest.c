@@ -115,3 +115,86 @@ void autotest_firhilbf_interp()
     firhilbf_destroy(ht);
 }
 
+
+// compare block real-to-complex transform against per-sample execution,
+// splitting the input into irregular block sizes and interleaving
+// single-sample calls to exercise the history hand-off
+void firhilbf_test_r2c_block(unsigned int _m)
+{
+    unsigned int num_samples = 400;
+    unsigned int sizes[] = {1, 0, 3, 17, 2, 64, 5, 1, 1, 93, 8, 4*_m-1, 4*_m, 4*_m+1};
+    unsigned int num_sizes = sizeof(sizes)/sizeof(sizes[0]);
+    float tol = 1e-5f;
+
+    firhilbf q0 = firhilbf_create(_m,60.0f);
+    firhilbf q1 = firhilbf_create(_m,60.0f);
+
+    float         x[num_samples];
+    float complex y0[num_samples];
+    float complex y1[num_samples];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf();
+
+    // reference: one sample at a time
+    for (i=0; i<num_samples; i++)
+        firhilbf_r2c_execute(q0, x[i], &y0[i]);
+
+    // alternate blocks with single-sample calls
+    unsigned int n=0, s=0;
+    while (n < num_samples) {
+        unsigned int b = sizes[s % num_sizes];
+        b = (n + b > num_samples) ? num_samples - n : b;
+        firhilbf_r2c_execute_block(q1, &x[n], b, &y1[n]);
+        n += b;
+        if ((s & 3) == 3 && n < num_samples) {
+            firhilbf_r2c_execute(q1, x[n], &y1[n]);
+            n++;
+        }
+        s++;
+    }
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA(crealf(y1[i]), crealf(y0[i]), tol);
+        CONTEND_DELTA(cimagf(y1[i]), cimagf(y0[i]), tol);
+    }
+
+    // complex-to-real block recovers the in-phase component
+    float z[num_samples];
+    firhilbf_c2r_execute_block(q1, y1, num_samples, z);
+    for (i=0; i<num_samples; i++)
+        CONTEND_EQUALITY(z[i], crealf(y1[i]));
+
+    firhilbf_destroy(q0);
+    firhilbf_destroy(q1);
+}
+
+void autotest_firhilbf_r2c_block_m2()  { firhilbf_test_r2c_block( 2); }
+void autotest_firhilbf_r2c_block_m5()  { firhilbf_test_r2c_block( 5); }
+void autotest_firhilbf_r2c_block_m12() { firhilbf_test_r2c_block(12); }
+
+// in-phase component of the real-to-complex impulse response peaks
+// at the reported delay
+void autotest_firhilbf_delay()
+{
+    unsigned int m = 5;
+    unsigned int n = 8*m;
+    firhilbf q = firhilbf_create(m, 60.0f);
+    CONTEND_EQUALITY(firhilbf_get_delay(q), 2*m);
+
+    unsigned int i;
+    float x[n];
+    for (i=0; i<n; i++)
+        x[i] = (i == 0) ? 1.0f : 0.0f;
+
+    float complex y[n];
+    firhilbf_r2c_execute_block(q, x, n, y);
+    unsigned int imax = 0;
+    for (i=0; i<n; i++) {
+        if (crealf(y[i]) > crealf(y[imax]))
+            imax = i;
+    }
+    CONTEND_EQUALITY(imax, 2*m);
+
+    firhilbf_destroy(q);
+}
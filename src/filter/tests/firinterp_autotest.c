@@ -150,3 +150,170 @@ void autotest_firinterp_crcf_generic()
     firinterp_crcf_destroy(q);
 }
 
+//
+// AUTOTEST: firinterp_crcf block execution matches sample-by-sample
+//
+void autotest_firinterp_crcf_block()
+{
+    float tol = 1e-4f;
+    unsigned int M = 4;     // interpolation factor
+    unsigned int m = 5;     // filter delay
+    unsigned int n = 80;    // number of inputs
+
+    firinterp_crcf q0 = firinterp_crcf_create_kaiser(M, m, 60.0f);
+    firinterp_crcf q1 = firinterp_crcf_create_kaiser(M, m, 60.0f);
+
+    float complex x[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // run one input at a time
+    float complex y0[n*M];
+    for (i=0; i<n; i++)
+        firinterp_crcf_execute(q0, x[i], &y0[i*M]);
+
+    // run in irregular blocks
+    float complex y1[n*M];
+    unsigned int num = 1;
+    for (i=0; i<n; i+=num) {
+        num = (num % 43) + 2;
+        if (i + num > n) num = n - i;
+        firinterp_crcf_execute_block(q1, &x[i], num, &y1[i*M]);
+    }
+
+    for (i=0; i<n*M; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    firinterp_crcf_destroy(q0);
+    firinterp_crcf_destroy(q1);
+}
+
+
+// fixed-point interpolator against floating-point interpolator
+void autotest_firinterp_rrrq16()
+{
+    unsigned int M   = 4;   // interpolation factor
+    unsigned int m   = 5;   // filter delay
+    unsigned int num = 40;  // number of input samples
+    float tol = 1.0f / 32768.0f;
+
+    unsigned int h_len = 2*M*m+1;
+    float hf[h_len];
+    liquid_firdes_kaiser(h_len, 0.5f/(float)M, 60.0f, 0.0f, hf);
+    float g = 0.0f;
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        g += fabsf(hf[i]);
+    q16_t h[h_len];
+    for (i=0; i<h_len; i++) {
+        h[i]  = q16_float_to_fixed(0.9f*hf[i]/g);
+        hf[i] = q16_fixed_to_float(h[i]);
+    }
+
+    firinterp_rrrf   qf = firinterp_rrrf_create(M, hf, h_len);
+    firinterp_rrrq16 q0 = firinterp_rrrq16_create(M, h, h_len);
+    firinterp_rrrq16 q1 = firinterp_rrrq16_create(M, h, h_len);
+
+    q16_t x[num];
+    for (i=0; i<num; i++)
+        x[i] = q16_float_to_fixed(0.9f*sinf(0.3f*i));
+
+    q16_t y0[M*num];
+    q16_t y1[M*num];
+    float yf[M*num];
+    firinterp_rrrq16_execute_block(q1, x, num, y1);
+    for (i=0; i<num; i++) {
+        firinterp_rrrf_execute(qf, q16_fixed_to_float(x[i]), &yf[M*i]);
+        firinterp_rrrq16_execute(q0, x[i], &y0[M*i]);
+    }
+
+    for (i=0; i<M*num; i++) {
+        CONTEND_DELTA(q16_fixed_to_float(y0[i]), yf[i], tol);
+        CONTEND_EQUALITY(y0[i], y1[i]);
+    }
+
+    firinterp_rrrf_destroy(qf);
+    firinterp_rrrq16_destroy(q0);
+    firinterp_rrrq16_destroy(q1);
+}
+
+// complex fixed-point interpolator against floating-point interpolator
+void autotest_firinterp_crcq16()
+{
+    unsigned int M   = 3;   // interpolation factor
+    unsigned int m   = 4;   // filter delay
+    unsigned int num = 30;  // number of input samples
+    float tol = 1.0f / 32768.0f;
+
+    unsigned int h_len = 2*M*m+1;
+    float hf[h_len];
+    liquid_firdes_kaiser(h_len, 0.5f/(float)M, 60.0f, 0.0f, hf);
+    float g = 0.0f;
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        g += fabsf(hf[i]);
+    q16_t h[h_len];
+    for (i=0; i<h_len; i++) {
+        h[i]  = q16_float_to_fixed(0.9f*hf[i]/g);
+        hf[i] = q16_fixed_to_float(h[i]);
+    }
+
+    firinterp_crcf   qf = firinterp_crcf_create(M, hf, h_len);
+    firinterp_crcq16 q  = firinterp_crcq16_create(M, h, h_len);
+
+    cq16_t x[num];
+    for (i=0; i<num; i++) {
+        x[i].real = q16_float_to_fixed(0.9f*cosf(0.2f*i));
+        x[i].imag = q16_float_to_fixed(0.9f*sinf(0.2f*i));
+    }
+
+    cq16_t y[M*num];
+    float complex yf[M*num];
+    firinterp_crcq16_execute_block(q, x, num, y);
+    for (i=0; i<num; i++) {
+        float complex v = q16_fixed_to_float(x[i].real) + _Complex_I*q16_fixed_to_float(x[i].imag);
+        firinterp_crcf_execute(qf, v, &yf[M*i]);
+    }
+
+    for (i=0; i<M*num; i++) {
+        CONTEND_DELTA(q16_fixed_to_float(y[i].real), crealf(yf[i]), tol);
+        CONTEND_DELTA(q16_fixed_to_float(y[i].imag), cimagf(yf[i]), tol);
+    }
+
+    firinterp_crcf_destroy(qf);
+    firinterp_crcq16_destroy(q);
+}
+
+// impulse response peaks at the reported interpolator delay
+void autotest_firinterp_crcf_delay()
+{
+    unsigned int M = 3;
+    unsigned int m = 4;
+    unsigned int n = 4*m;
+    firinterp_crcf q0 = firinterp_crcf_create_kaiser(M, m, 60.0f);
+    firinterp_crcf q1 = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RRC, M, m, 0.3f, 0.0f);
+    CONTEND_EQUALITY(firinterp_crcf_get_delay(q0), (float)(M*m));
+    CONTEND_EQUALITY(firinterp_crcf_get_delay(q1), (float)(M*m));
+
+    unsigned int i;
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = (i == 0) ? 1.0f : 0.0f;
+
+    float complex y0[M*n], y1[M*n];
+    firinterp_crcf_execute_block(q0, x, n, y0);
+    firinterp_crcf_execute_block(q1, x, n, y1);
+    unsigned int i0 = 0, i1 = 0;
+    for (i=0; i<M*n; i++) {
+        if (cabsf(y0[i]) > cabsf(y0[i0])) i0 = i;
+        if (cabsf(y1[i]) > cabsf(y1[i1])) i1 = i;
+    }
+    CONTEND_EQUALITY(i0, M*m);
+    CONTEND_EQUALITY(i1, M*m);
+
+    firinterp_crcf_destroy(q0);
+    firinterp_crcf_destroy(q1);
+}
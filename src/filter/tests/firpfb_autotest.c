@@ -76,3 +76,135 @@ void autotest_firpfb_impulse_response()
     firpfb_rrrf_destroy(f);
 }
 
+
+// shared filterbank produces identical output with private state, and
+// coefficients outlive the prototype
+void autotest_firpfb_create_shared()
+{
+    unsigned int npfb = 16;
+    firpfb_crcf f0 = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, npfb, 2, 7, 0.3f);
+    firpfb_crcf f1 = firpfb_crcf_create_shared(f0);
+    firpfb_crcf f2 = firpfb_crcf_create_shared(f1);
+
+    // push a different sequence through f2 so its state diverges
+    unsigned int i;
+    for (i=0; i<40; i++)
+        firpfb_crcf_push(f2, randnf() + _Complex_I*randnf());
+
+    float complex x[200], y0, y1;
+    for (i=0; i<200; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        firpfb_crcf_push(f0, x[i]);
+        firpfb_crcf_push(f1, x[i]);
+        firpfb_crcf_execute(f0, i % npfb, &y0);
+        firpfb_crcf_execute(f1, i % npfb, &y1);
+        CONTEND_DELTA( crealf(y0), crealf(y1), 1e-6f );
+        CONTEND_DELTA( cimagf(y0), cimagf(y1), 1e-6f );
+    }
+
+    // destroy prototype first; shared objects remain valid
+    firpfb_crcf_destroy(f0);
+    firpfb_crcf_reset(f2);
+    for (i=0; i<200; i++) {
+        firpfb_crcf_push(f1, x[i]);
+        firpfb_crcf_push(f2, x[i]);
+    }
+    for (i=0; i<npfb; i++) {
+        firpfb_crcf_execute(f1, i, &y0);
+        firpfb_crcf_execute(f2, i, &y1);
+        CONTEND_DELTA( crealf(y0), crealf(y1), 1e-6f );
+        CONTEND_DELTA( cimagf(y0), cimagf(y1), 1e-6f );
+    }
+    firpfb_crcf_destroy(f1);
+    firpfb_crcf_destroy(f2);
+}
+
+// half-precision coefficients: each sub-filter is within the expected
+// rounding error and every execute method tracks the single-precision
+// filterbank closely
+void autotest_firpfb_coeff_fp16()
+{
+    unsigned int npfb = 64;
+    firpfb_crcf f0 = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, npfb, 2, 7, 0.3f);
+    firpfb_crcf f1 = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, npfb, 2, 7, 0.3f);
+    firpfb_crcf_set_coeff_fp16(f1, 1);
+    CONTEND_EQUALITY(firpfb_crcf_get_coeff_fp16(f0), 0);
+    CONTEND_EQUALITY(firpfb_crcf_get_coeff_fp16(f1), 1);
+    CONTEND_GREATER_THAN(firpfb_crcf_get_memory_usage(f1), firpfb_crcf_get_memory_usage(f0));
+
+    // binary16 has an 11-bit significand: roughly -70 dB rms error
+    unsigned int i;
+    for (i=0; i<npfb; i++)
+        CONTEND_LESS_THAN(firpfb_crcf_get_coeff_fp16_error(f1, i), -60.0f);
+
+    // single outputs and full bank
+    float complex x[100];
+    float complex y0[npfb], y1[npfb];
+    float e2 = 0.0f, y2 = 0.0f;
+    for (i=0; i<100; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        firpfb_crcf_push(f0, x[i]);
+        firpfb_crcf_push(f1, x[i]);
+        firpfb_crcf_execute(f0, i % npfb, &y0[0]);
+        firpfb_crcf_execute(f1, i % npfb, &y1[0]);
+        e2 += crealf((y0[0]-y1[0])*conjf(y0[0]-y1[0]));
+        y2 += crealf(y0[0]*conjf(y0[0]));
+    }
+    CONTEND_LESS_THAN(10*log10f(e2/y2), -50.0f);
+
+    unsigned int k;
+    firpfb_crcf_execute_batch(f0, y0);
+    firpfb_crcf_execute_batch(f1, y1);
+    for (k=0; k<npfb; k++)
+        CONTEND_DELTA(cabsf(y0[k]-y1[k]), 0.0f, 1e-2f);
+
+    // block execution
+    float complex z0[20*npfb], z1[20*npfb];
+    firpfb_crcf_execute_block(f0, x, 20, z0);
+    firpfb_crcf_execute_block(f1, x, 20, z1);
+    e2 = y2 = 0.0f;
+    for (k=0; k<20*npfb; k++) {
+        e2 += crealf((z0[k]-z1[k])*conjf(z0[k]-z1[k]));
+        y2 += crealf(z0[k]*conjf(z0[k]));
+    }
+    CONTEND_LESS_THAN(10*log10f(e2/y2), -50.0f);
+
+    // shared filterbanks inherit the setting; disabling restores
+    // single-precision output exactly
+    firpfb_crcf f2 = firpfb_crcf_create_shared(f1);
+    CONTEND_EQUALITY(firpfb_crcf_get_coeff_fp16(f2), 1);
+    firpfb_crcf_set_coeff_fp16(f1, 0);
+    firpfb_crcf_execute(f0, 3, &y0[0]);
+    firpfb_crcf_execute(f1, 3, &y1[0]);
+    CONTEND_EQUALITY(y0[0], y1[0]);
+
+    firpfb_crcf_destroy(f0);
+    firpfb_crcf_destroy(f1);
+    firpfb_crcf_destroy(f2);
+}
+
+// half-precision complex coefficients
+void autotest_firpfb_cccf_coeff_fp16()
+{
+    unsigned int npfb = 8;
+    unsigned int h_len = 8*npfb;
+    float complex h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf() + _Complex_I*randnf();
+    firpfb_cccf f0 = firpfb_cccf_create(npfb, h, h_len);
+    firpfb_cccf f1 = firpfb_cccf_create(npfb, h, h_len);
+    firpfb_cccf_set_coeff_fp16(f1, 1);
+
+    float complex y0, y1;
+    for (i=0; i<50; i++) {
+        float complex x = randnf() + _Complex_I*randnf();
+        firpfb_cccf_push(f0, x);
+        firpfb_cccf_push(f1, x);
+        firpfb_cccf_execute(f0, i % npfb, &y0);
+        firpfb_cccf_execute(f1, i % npfb, &y1);
+        CONTEND_LESS_THAN(cabsf(y0-y1), 1e-3f*cabsf(y0) + 1e-3f);
+    }
+    firpfb_cccf_destroy(f0);
+    firpfb_cccf_destroy(f1);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// half-band polyphase decimator: pass-band tone is kept at unity
+// gain, stop-band tone is rejected by the specified attenuation
+void iirdecim_crcf_test_halfband(float _ft, float _As, float _fx, int _pass)
+{
+    unsigned int num_samples = 400; // number of output samples
+    unsigned int num_skip    = 100; // transient
+
+    iirdecim_crcf q = iirdecim_crcf_create_halfband(_ft, _As);
+
+    unsigned int i;
+    float complex x[2];
+    float complex y;
+    for (i=0; i<num_samples; i++) {
+        x[0] = cexpf(_Complex_I*2*M_PI*_fx*(2*i  ));
+        x[1] = cexpf(_Complex_I*2*M_PI*_fx*(2*i+1));
+        iirdecim_crcf_execute(q, x, &y);
+        if (i < num_skip)
+            continue;
+        if (_pass) {
+            CONTEND_DELTA(cabsf(y), 1.0f, 0.01f);
+        } else {
+            // allow for single-precision rounding near the floor
+            CONTEND_LESS_THAN(20*log10f(cabsf(y)), -_As + 1.0f);
+        }
+    }
+
+    iirdecim_crcf_destroy(q);
+}
+
+void autotest_iirdecim_crcf_halfband_pass()    { iirdecim_crcf_test_halfband(0.10f, 60.0f,  0.05f, 1); }
+void autotest_iirdecim_crcf_halfband_pass_neg(){ iirdecim_crcf_test_halfband(0.10f, 60.0f, -0.17f, 1); }
+void autotest_iirdecim_crcf_halfband_stop()    { iirdecim_crcf_test_halfband(0.10f, 60.0f,  0.40f, 0); }
+void autotest_iirdecim_crcf_halfband_stop_neg(){ iirdecim_crcf_test_halfband(0.05f, 80.0f, -0.30f, 0); }
@@ -298,3 +298,32 @@ void autotest_iirdes_isstable_n2_no()
     CONTEND_EQUALITY( stable, 0 );
 }
 
+
+// polyphase all-pass half-band design meets its specification
+void iirdes_test_allpass_halfband(float _ft, float _As)
+{
+    unsigned int n = iirdes_allpass_halfband_len(_ft, _As);
+    float c[n];
+    iirdes_allpass_halfband(n, _ft, c);
+
+    unsigned int i;
+    for (i=0; i<=200; i++) {
+        float f = 0.5f * (float)i / 200.0f;
+        float H = cabsf(iirdes_allpass_halfband_freqresponse(c, n, f));
+        if (f <= 0.25f - 0.5f*_ft) {
+            CONTEND_DELTA(H, 1.0f, 0.01f);
+        } else if (f >= 0.25f + 0.5f*_ft) {
+            CONTEND_LESS_THAN(20*log10f(H), -_As);
+        }
+    }
+
+    // all-pass sections must be stable
+    for (i=0; i<n; i++) {
+        CONTEND_GREATER_THAN(c[i], 0.0f);
+        CONTEND_LESS_THAN   (c[i], 1.0f);
+    }
+}
+
+void autotest_iirdes_allpass_halfband_ft05_As60()  { iirdes_test_allpass_halfband(0.05f, 60.0f); }
+void autotest_iirdes_allpass_halfband_ft10_As80()  { iirdes_test_allpass_halfband(0.10f, 80.0f); }
+void autotest_iirdes_allpass_halfband_ft20_As40()  { iirdes_test_allpass_halfband(0.20f, 40.0f); }
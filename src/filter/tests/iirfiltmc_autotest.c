@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare multi-channel filter against one iirfilt per channel
+//  _num_channels   : number of channels
+//  _block          : use block execution?
+void iirfiltmc_crcf_test(unsigned int _num_channels,
+                         int          _block)
+{
+    float tol = 1e-4f;
+    unsigned int n = 150;   // samples per channel (not a multiple of span)
+    unsigned int C = _num_channels;
+
+    // 4th-order band-pass filter (four second-order sections)
+    float fc = 0.1f, f0 = 0.25f, Ap = 0.1f, As = 60.0f;
+    iirfiltmc_crcf q = iirfiltmc_crcf_create_prototype(LIQUID_IIRDES_BUTTER,
+                                                       LIQUID_IIRDES_BANDPASS,
+                                                       4, fc, f0, Ap, As, C);
+    CONTEND_EQUALITY(iirfiltmc_crcf_get_num_channels(q), C);
+    iirfilt_crcf f[C];
+    unsigned int c;
+    for (c=0; c<C; c++)
+        f[c] = iirfilt_crcf_create_prototype(LIQUID_IIRDES_BUTTER,
+                                             LIQUID_IIRDES_BANDPASS,
+                                             LIQUID_IIRDES_SOS,
+                                             4, fc, f0, Ap, As);
+
+    // channel-interleaved input, different signal on each channel
+    float complex x[n*C];
+    float complex y0[n*C];
+    float complex y1[n*C];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        for (c=0; c<C; c++)
+            x[i*C+c] = cexpf(_Complex_I*(0.2f + 0.3f*c)*i) + 0.1f*c;
+    }
+
+    // reference
+    for (i=0; i<n; i++) {
+        for (c=0; c<C; c++)
+            iirfilt_crcf_execute(f[c], x[i*C+c], &y0[i*C+c]);
+    }
+
+    // run in two pieces to exercise state retention
+    if (_block) {
+        iirfiltmc_crcf_execute_block(q, x, 70, y1);
+        iirfiltmc_crcf_execute_block(q, &x[70*C], n-70, &y1[70*C]);
+    } else {
+        for (i=0; i<n; i++)
+            iirfiltmc_crcf_execute(q, &x[i*C], &y1[i*C]);
+    }
+
+    for (i=0; i<n*C; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    iirfiltmc_crcf_destroy(q);
+    for (c=0; c<C; c++)
+        iirfilt_crcf_destroy(f[c]);
+}
+
+void autotest_iirfiltmc_crcf_c1()         { iirfiltmc_crcf_test( 1, 0); }
+void autotest_iirfiltmc_crcf_c3()         { iirfiltmc_crcf_test( 3, 0); }
+void autotest_iirfiltmc_crcf_c16()        { iirfiltmc_crcf_test(16, 0); }
+void autotest_iirfiltmc_crcf_c3_block()   { iirfiltmc_crcf_test( 3, 1); }
+void autotest_iirfiltmc_crcf_c16_block()  { iirfiltmc_crcf_test(16, 1); }
+
+// real channels, DC blocker, in-place block execution
+void autotest_iirfiltmc_rrrf_dc_blocker()
+{
+    float tol = 1e-5f;
+    unsigned int n = 100;
+    unsigned int C = 5;
+    float alpha = 0.1f;
+    iirfiltmc_rrrf q = iirfiltmc_rrrf_create_dc_blocker(alpha, C);
+    iirfilt_rrrf   f[C];
+    unsigned int c, i;
+    for (c=0; c<C; c++)
+        f[c] = iirfilt_rrrf_create_dc_blocker(alpha);
+
+    float x[n*C];
+    float y[n*C];
+    for (i=0; i<n*C; i++)
+        x[i] = 1.0f + (float)(i%C) + sinf(0.1f*i);
+    for (i=0; i<n; i++) {
+        for (c=0; c<C; c++)
+            iirfilt_rrrf_execute(f[c], x[i*C+c], &y[i*C+c]);
+    }
+
+    iirfiltmc_rrrf_execute_block(q, x, n, x);
+    for (i=0; i<n*C; i++)
+        CONTEND_DELTA( x[i], y[i], tol );
+
+    // reset clears state
+    iirfiltmc_rrrf_reset(q);
+    for (c=0; c<C; c++)
+        x[c] = 1.0f;
+    iirfiltmc_rrrf_execute(q, x, y);
+    for (c=0; c<C; c++)
+        CONTEND_DELTA( y[c], 1.0f, tol );
+
+    iirfiltmc_rrrf_destroy(q);
+    for (c=0; c<C; c++)
+        iirfilt_rrrf_destroy(f[c]);
+}
+
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// half-band polyphase interpolator: the interpolated tone has unity
+// gain and its image is rejected by the specified attenuation
+void iirinterp_crcf_test_halfband(float _ft, float _As, float _fx)
+{
+    unsigned int num_samples = 400; // number of input samples
+    unsigned int num_skip    = 100; // transient
+
+    iirinterp_crcf q = iirinterp_crcf_create_halfband(_ft, _As);
+
+    // correlate output against tone and its image at the output rate
+    float complex r_tone  = 0.0f;
+    float complex r_image = 0.0f;
+    unsigned int i, k;
+    float complex y[2];
+    for (i=0; i<num_samples; i++) {
+        iirinterp_crcf_execute(q, cexpf(_Complex_I*2*M_PI*_fx*i), y);
+        if (i < num_skip)
+            continue;
+        for (k=0; k<2; k++) {
+            unsigned int n = 2*i + k;
+            r_tone  += y[k] * cexpf(-_Complex_I*2*M_PI*(0.5f*_fx       )*n);
+            r_image += y[k] * cexpf(-_Complex_I*2*M_PI*(0.5f*_fx + 0.5f)*n);
+        }
+    }
+    float n = 2*(num_samples - num_skip);
+    CONTEND_DELTA(cabsf(r_tone)/n, 1.0f, 0.01f);
+    CONTEND_LESS_THAN(20*log10f(cabsf(r_image)/n), -_As);
+
+    iirinterp_crcf_destroy(q);
+}
+
+void autotest_iirinterp_crcf_halfband_f10()  { iirinterp_crcf_test_halfband(0.10f, 60.0f,  0.10f); }
+void autotest_iirinterp_crcf_halfband_f30()  { iirinterp_crcf_test_halfband(0.05f, 80.0f, -0.30f); }
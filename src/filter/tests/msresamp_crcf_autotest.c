@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -165,3 +166,57 @@ void autotest_msresamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// compare fused block cascade of msresamp2 against per-sample execution
+void msresamp2_crcf_test_block(int _type, unsigned int _num_stages)
+{
+    unsigned int sizes[] = {1, 5, 200, 2, 37};
+    unsigned int num_sizes = sizeof(sizes)/sizeof(sizes[0]);
+    unsigned int M = 1 << _num_stages;
+    unsigned int num = 0;
+    unsigned int i;
+    for (i=0; i<num_sizes; i++)
+        num += sizes[i];
+    float tol = 1e-5f;
+
+    msresamp2_crcf q0 = msresamp2_crcf_create(_type, _num_stages, 0.4f, 0.0f, 60.0f);
+    msresamp2_crcf q1 = msresamp2_crcf_create(_type, _num_stages, 0.4f, 0.0f, 60.0f);
+
+    float complex * x  = (float complex*) malloc(num*M*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(num*M*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(num*M*sizeof(float complex));
+    for (i=0; i<num*M; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    int decim = _type == LIQUID_RESAMP_DECIM;
+    unsigned int nx = decim ? M : 1;    // input samples per execution
+    unsigned int ny = decim ? 1 : M;    // output samples per execution
+
+    // reference: per-sample execution
+    for (i=0; i<num; i++)
+        msresamp2_crcf_execute(q0, &x[i*nx], &y0[i*ny]);
+
+    unsigned int n = 0;
+    for (i=0; i<num_sizes; i++) {
+        msresamp2_crcf_execute_block(q1, &x[n*nx], sizes[i], &y1[n*ny]);
+        n += sizes[i];
+    }
+
+    for (i=0; i<num*ny; i++) {
+        CONTEND_DELTA(crealf(y1[i]), crealf(y0[i]), tol);
+        CONTEND_DELTA(cimagf(y1[i]), cimagf(y0[i]), tol);
+    }
+
+    msresamp2_crcf_destroy(q0);
+    msresamp2_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_msresamp2_crcf_decim_block_s1()  { msresamp2_crcf_test_block(LIQUID_RESAMP_DECIM,  1); }
+void autotest_msresamp2_crcf_decim_block_s3()  { msresamp2_crcf_test_block(LIQUID_RESAMP_DECIM,  3); }
+void autotest_msresamp2_crcf_decim_block_s5()  { msresamp2_crcf_test_block(LIQUID_RESAMP_DECIM,  5); }
+void autotest_msresamp2_crcf_interp_block_s3() { msresamp2_crcf_test_block(LIQUID_RESAMP_INTERP, 3); }
+void autotest_msresamp2_crcf_interp_block_s5() { msresamp2_crcf_test_block(LIQUID_RESAMP_INTERP, 5); }
+void autotest_msresamp2_crcf_block_s0()        { msresamp2_crcf_test_block(LIQUID_RESAMP_DECIM,  0); }
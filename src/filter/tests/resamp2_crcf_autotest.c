@@ -173,3 +173,52 @@ void autotest_resamp2_synthesis()
     printf("results written to '%s'\n","resamp2_test.m");
 #endif
 }
+
+// compare block decimator/interpolator against per-sample execution,
+// with block lengths crossing the internal pass size
+void resamp2_crcf_test_block(unsigned int _m, int _decim)
+{
+    unsigned int sizes[] = {1, 7, 300, 2, 64, 513, 3};
+    unsigned int num_sizes = sizeof(sizes)/sizeof(sizes[0]);
+    unsigned int num = 0;
+    unsigned int i;
+    for (i=0; i<num_sizes; i++)
+        num += sizes[i];
+    float tol = 1e-5f;
+
+    resamp2_crcf q0 = resamp2_crcf_create(_m, 0.0f, 60.0f);
+    resamp2_crcf q1 = resamp2_crcf_create(_m, 0.0f, 60.0f);
+
+    float complex x [2*num];
+    float complex y0[2*num];
+    float complex y1[2*num];
+    for (i=0; i<2*num; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // reference: per-sample execution
+    for (i=0; i<num; i++) {
+        if (_decim) resamp2_crcf_decim_execute (q0, &x[2*i], &y0[i]);
+        else        resamp2_crcf_interp_execute(q0,   x[i],  &y0[2*i]);
+    }
+
+    unsigned int n = 0;
+    for (i=0; i<num_sizes; i++) {
+        if (_decim) resamp2_crcf_decim_execute_block (q1, &x[2*n], sizes[i], &y1[n]);
+        else        resamp2_crcf_interp_execute_block(q1, &x[n],   sizes[i], &y1[2*n]);
+        n += sizes[i];
+    }
+
+    unsigned int num_out = _decim ? num : 2*num;
+    for (i=0; i<num_out; i++) {
+        CONTEND_DELTA(crealf(y1[i]), crealf(y0[i]), tol);
+        CONTEND_DELTA(cimagf(y1[i]), cimagf(y0[i]), tol);
+    }
+
+    resamp2_crcf_destroy(q0);
+    resamp2_crcf_destroy(q1);
+}
+
+void autotest_resamp2_crcf_decim_block_m3()   { resamp2_crcf_test_block( 3, 1); }
+void autotest_resamp2_crcf_decim_block_m12()  { resamp2_crcf_test_block(12, 1); }
+void autotest_resamp2_crcf_interp_block_m3()  { resamp2_crcf_test_block( 3, 0); }
+void autotest_resamp2_crcf_interp_block_m12() { resamp2_crcf_test_block(12, 0); }
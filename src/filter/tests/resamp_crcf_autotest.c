@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -165,3 +166,73 @@ void autotest_resamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// execute_block() in blocks of any size matches execute() on single
+// samples
+void resamp_crcf_test_block(float _rate)
+{
+    unsigned int nx = 500;
+    resamp_crcf q0 = resamp_crcf_create(_rate, 7, 0.4f, 60.0f, 32);
+    resamp_crcf q1 = resamp_crcf_create(_rate, 7, 0.4f, 60.0f, 32);
+
+    float complex x[nx];
+    float complex y0[4*nx];
+    float complex y1[4*nx];
+    unsigned int i, n0 = 0, n1 = 0, nw;
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    for (i=0; i<nx; i++) {
+        resamp_crcf_execute(q0, x[i], &y0[n0], &nw);
+        n0 += nw;
+    }
+    for (i=0; i<nx; ) {
+        unsigned int k = 1 + rand() % 70;
+        k = i + k > nx ? nx - i : k;
+        resamp_crcf_execute_block(q1, &x[i], k, &y1[n1], &nw);
+        n1 += nw;
+        i  += k;
+    }
+
+    CONTEND_EQUALITY(n0, n1);
+    for (i=0; i<n0 && i<n1; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), 1e-6f);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), 1e-6f);
+    }
+
+    resamp_crcf_destroy(q0);
+    resamp_crcf_destroy(q1);
+}
+void autotest_resamp_crcf_block_0p7()  { resamp_crcf_test_block(0.7f);  }
+void autotest_resamp_crcf_block_2p3()  { resamp_crcf_test_block(2.3f);  }
+
+// half-precision filterbank coefficients track the single-precision
+// resampler output closely
+void autotest_resamp_crcf_coeff_fp16()
+{
+    unsigned int nx = 1000;
+    float rate = 0.7173f;
+    resamp_crcf q0 = resamp_crcf_create_default(rate);
+    resamp_crcf q1 = resamp_crcf_create_default(rate);
+    resamp_crcf_set_coeff_fp16(q1, 1);
+
+    float complex x[nx];
+    float complex y0[2*nx];
+    float complex y1[2*nx];
+    unsigned int i, n0, n1;
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    resamp_crcf_execute_block(q0, x, nx, y0, &n0);
+    resamp_crcf_execute_block(q1, x, nx, y1, &n1);
+
+    CONTEND_EQUALITY(n0, n1);
+    float e2 = 0.0f, y2 = 0.0f;
+    for (i=0; i<n0 && i<n1; i++) {
+        e2 += crealf((y0[i]-y1[i])*conjf(y0[i]-y1[i]));
+        y2 += crealf(y0[i]*conjf(y0[i]));
+    }
+    CONTEND_LESS_THAN(10*log10f(e2/y2), -50.0f);
+
+    resamp_crcf_destroy(q0);
+    resamp_crcf_destroy(q1);
+}
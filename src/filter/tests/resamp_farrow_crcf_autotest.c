@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// test Farrow resampler against an ideal delayed tone
+//  _rate   : resampling rate
+//  _f      : tone frequency (relative to input rate)
+void resamp_farrow_crcf_test_tone(float _rate,
+                                  float _f)
+{
+    float tol = 0.01f;
+    unsigned int m = 8;
+    resamp_farrow_crcf q = resamp_farrow_crcf_create(_rate, m, 0.4f, 60.0f, 4);
+
+    unsigned int nx = 400;
+    unsigned int ny_max = (unsigned int)(nx*_rate) + 4;
+    float complex x[nx];
+    float complex y[ny_max];
+    unsigned int i;
+    for (i=0; i<nx; i++)
+        x[i] = cexpf(_Complex_I*2*M_PI*_f*i);
+
+    unsigned int ny;
+    resamp_farrow_crcf_execute_block(q, x, nx, y, &ny);
+    CONTEND_LESS_THAN(ny, ny_max+1);
+
+    // output k lies at input time k/rate, delayed by m input samples
+    for (i=0; i<ny; i++) {
+        float t = (float)i / _rate;
+        if (t < 2*m)
+            continue;
+        float complex v = cexpf(_Complex_I*2*M_PI*_f*(t - (float)m));
+        CONTEND_DELTA( crealf(y[i]), crealf(v), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(v), tol );
+    }
+
+    resamp_farrow_crcf_destroy(q);
+}
+
+void autotest_resamp_farrow_crcf_1p0001() { resamp_farrow_crcf_test_tone(1.0001f, 0.050f); }
+void autotest_resamp_farrow_crcf_0p9999() { resamp_farrow_crcf_test_tone(0.9999f, 0.050f); }
+void autotest_resamp_farrow_crcf_1p7()    { resamp_farrow_crcf_test_tone(1.7f,    0.100f); }
+void autotest_resamp_farrow_crcf_0p8()    { resamp_farrow_crcf_test_tone(0.8f,    0.100f); }
+
+// rate changes take effect on the next output without disturbing
+// the timing phase
+void autotest_resamp_farrow_crcf_set_rate()
+{
+    float tol = 0.01f;
+    float f = 0.05f;
+    unsigned int m = 8;
+    resamp_farrow_crcf q = resamp_farrow_crcf_create(1.0f, m, 0.4f, 60.0f, 4);
+
+    float t = 0.0f;         // input time of next output
+    float rate = 1.0f;
+    unsigned int i, j;
+    for (i=0; i<2000; i++) {
+        // ramp rate slowly every block of 100 samples
+        if ((i % 100) == 0) {
+            rate = 1.0f + 0.002f*(float)(i/100);
+            resamp_farrow_crcf_set_rate(q, rate);
+            CONTEND_DELTA(resamp_farrow_crcf_get_rate(q), rate, 1e-6f);
+        }
+
+        float complex y[4];
+        unsigned int ny;
+        resamp_farrow_crcf_execute(q, cexpf(_Complex_I*2*M_PI*f*i), y, &ny);
+        for (j=0; j<ny; j++) {
+            if (t >= 2*m) {
+                float complex v = cexpf(_Complex_I*2*M_PI*f*(t - (float)m));
+                CONTEND_DELTA( crealf(y[j]), crealf(v), tol );
+                CONTEND_DELTA( cimagf(y[j]), cimagf(v), tol );
+            }
+            t += 1.0f / rate;
+        }
+    }
+
+    resamp_farrow_crcf_destroy(q);
+}
+
+// block execution matches sample-by-sample execution
+void autotest_resamp_farrow_crcf_block()
+{
+    unsigned int nx = 500;
+    float rate = 1.23f;
+    resamp_farrow_crcf q0 = resamp_farrow_crcf_create_default(rate);
+    resamp_farrow_crcf q1 = resamp_farrow_crcf_create_default(rate);
+
+    float complex x[nx];
+    float complex y0[2*nx];
+    float complex y1[2*nx];
+    unsigned int i;
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    unsigned int n0 = 0;
+    for (i=0; i<nx; i++) {
+        unsigned int nw;
+        resamp_farrow_crcf_execute(q0, x[i], &y0[n0], &nw);
+        n0 += nw;
+    }
+
+    unsigned int lens[] = {1, 7, 0, 33, 64, 2};
+    unsigned int n = 0;
+    unsigned int n1 = 0;
+    for (i=0; n<nx; i++) {
+        unsigned int len = lens[i % 6];
+        if (n + len > nx)
+            len = nx - n;
+        unsigned int nw;
+        resamp_farrow_crcf_execute_block(q1, &x[n], len, &y1[n1], &nw);
+        n  += len;
+        n1 += nw;
+    }
+
+    CONTEND_EQUALITY(n0, n1);
+    CONTEND_SAME_DATA(y0, y1, n0*sizeof(float complex));
+
+    resamp_farrow_crcf_destroy(q0);
+    resamp_farrow_crcf_destroy(q1);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// fixed-point resampler produces the expected number of outputs, and
+// block execution matches sample-by-sample execution exactly
+void resamp_rrrq16_test_count(float _rate)
+{
+    unsigned int num = 1000;    // number of input samples
+    resamp_rrrq16 q0 = resamp_rrrq16_create_default(_rate);
+    resamp_rrrq16 q1 = resamp_rrrq16_create_default(_rate);
+    CONTEND_EQUALITY(resamp_rrrq16_get_delay(q0), 7);
+    CONTEND_EQUALITY(resamp_rrrq16_get_rate(q0), _rate);
+
+    unsigned int ny_max = (unsigned int)(num*_rate) + 4;
+    q16_t x[num];
+    q16_t y0[ny_max];
+    q16_t y1[ny_max];
+    unsigned int i;
+    for (i=0; i<num; i++)
+        x[i] = q16_float_to_fixed(0.5f*sinf(0.05f*i) + 0.1f*randnf());
+
+    // sample by sample
+    unsigned int n0 = 0;
+    for (i=0; i<num; i++) {
+        unsigned int nw;
+        resamp_rrrq16_execute(q0, x[i], &y0[n0], &nw);
+        n0 += nw;
+    }
+
+    // uneven blocks to exercise buffer wrap-around
+    unsigned int n1 = 0;
+    unsigned int b  = 1;
+    for (i=0; i<num; ) {
+        unsigned int k = i + b > num ? num - i : b;
+        unsigned int nw;
+        resamp_rrrq16_execute_block(q1, &x[i], k, &y1[n1], &nw);
+        n1 += nw;
+        i  += k;
+        b = (b % 29) + 3;
+    }
+
+    // integer phase: outputs are those at multiples of the rounded
+    // phase step within the input span
+    unsigned int d_theta = (unsigned int) lrint(16777216.0 / _rate);
+    unsigned int n_expected = (unsigned int)(((unsigned long long)num*16777216ULL - 1) / d_theta) + 1;
+    CONTEND_EQUALITY(n0, n_expected);
+    CONTEND_EQUALITY(n1, n0);
+    for (i=0; i<n0; i++)
+        CONTEND_EQUALITY(y1[i], y0[i]);
+
+    resamp_rrrq16_destroy(q0);
+    resamp_rrrq16_destroy(q1);
+}
+void autotest_resamp_rrrq16_count_interp()  { resamp_rrrq16_test_count(1.7131f); }
+void autotest_resamp_rrrq16_count_decim()   { resamp_rrrq16_test_count(0.3219f); }
+void autotest_resamp_rrrq16_count_unity()   { resamp_rrrq16_test_count(1.0f);    }
+
+// complex fixed-point resampler tracks floating-point resampler
+void autotest_resamp_crcq16()
+{
+    float        rate = 0.7319f;
+    unsigned int num  = 400;
+    float        tol  = 2e-3f;
+
+    resamp_crcf   qf = resamp_crcf_create(rate, 7, 0.25f, 60.0f, 64);
+    resamp_crcq16 q  = resamp_crcq16_create(rate, 7, 0.25f, 60.0f, 64);
+
+    cq16_t x[num];
+    float complex xf[num];
+    unsigned int i;
+    for (i=0; i<num; i++) {
+        x[i].real = q16_float_to_fixed(0.7f*cosf(0.03f*i));
+        x[i].imag = q16_float_to_fixed(0.7f*sinf(0.03f*i));
+        xf[i] = q16_fixed_to_float(x[i].real) + _Complex_I*q16_fixed_to_float(x[i].imag);
+    }
+
+    unsigned int ny_max = (unsigned int)(num*rate) + 4;
+    cq16_t y[ny_max];
+    float complex yf[ny_max];
+    unsigned int ny, nyf;
+    resamp_crcq16_execute_block(q, x, num, y, &ny);
+    resamp_crcf_execute_block(qf, xf, num, yf, &nyf);
+
+    CONTEND_EQUALITY(ny, nyf);
+    for (i=0; i<ny && i<nyf; i++) {
+        CONTEND_DELTA(q16_fixed_to_float(y[i].real), crealf(yf[i]), tol);
+        CONTEND_DELTA(q16_fixed_to_float(y[i].imag), cimagf(yf[i]), tol);
+    }
+
+    resamp_crcf_destroy(qf);
+    resamp_crcq16_destroy(q);
+}
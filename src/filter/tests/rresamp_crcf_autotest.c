@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// test rational resampler against an ideal delayed tone
+//  _P      : interpolation factor
+//  _Q      : decimation factor
+//  _f      : tone frequency (relative to input rate)
+void rresamp_crcf_test_tone(unsigned int _P,
+                            unsigned int _Q,
+                            float        _f)
+{
+    float tol = 0.01f;
+    unsigned int m = 12;
+    rresamp_crcf q = rresamp_crcf_create(_P, _Q, m, 0.45f, 60.0f);
+    unsigned int P = rresamp_crcf_get_P(q);
+    unsigned int Q = rresamp_crcf_get_Q(q);
+
+    // enough frames to span a few filter lengths
+    unsigned int num_frames = (8*m) / Q + 8;
+    float complex x[num_frames*Q];
+    float complex y[num_frames*P];
+    unsigned int i;
+    for (i=0; i<num_frames*Q; i++)
+        x[i] = cexpf(_Complex_I*2*M_PI*_f*i);
+
+    rresamp_crcf_execute_block(q, x, num_frames, y);
+
+    // output k lies at input time k*Q/P, delayed by m input samples
+    for (i=0; i<num_frames*P; i++) {
+        float t = (float)i * (float)Q / (float)P;
+        if (t < 2*m)
+            continue;
+        float complex v = cexpf(_Complex_I*2*M_PI*_f*(t - (float)m));
+        CONTEND_DELTA( crealf(y[i]), crealf(v), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(v), tol );
+    }
+
+    rresamp_crcf_destroy(q);
+}
+
+void autotest_rresamp_crcf_147_160()  { rresamp_crcf_test_tone(147, 160, 0.030f); }
+void autotest_rresamp_crcf_160_147()  { rresamp_crcf_test_tone(160, 147, 0.030f); }
+void autotest_rresamp_crcf_2_3()      { rresamp_crcf_test_tone(  2,   3, 0.100f); }
+void autotest_rresamp_crcf_5_1()      { rresamp_crcf_test_tone(  5,   1, 0.200f); }
+
+// factors are reduced to lowest terms
+void autotest_rresamp_crcf_reduce()
+{
+    rresamp_crcf q = rresamp_crcf_create_default(6, 4);
+    CONTEND_EQUALITY(rresamp_crcf_get_P(q), 3);
+    CONTEND_EQUALITY(rresamp_crcf_get_Q(q), 2);
+    CONTEND_DELTA(rresamp_crcf_get_rate(q), 1.5f, 1e-6f);
+    rresamp_crcf_destroy(q);
+}
+
+// block execution matches frame-by-frame execution across calls
+void autotest_rresamp_crcf_block()
+{
+    unsigned int P = 3;
+    unsigned int Q = 4;
+    unsigned int num_frames = 64;
+    rresamp_crcf q0 = rresamp_crcf_create(P, Q, 7, 0.4f, 60.0f);
+    rresamp_crcf q1 = rresamp_crcf_create(P, Q, 7, 0.4f, 60.0f);
+
+    float complex x[num_frames*Q];
+    float complex y0[num_frames*P];
+    float complex y1[num_frames*P];
+    unsigned int i;
+    for (i=0; i<num_frames*Q; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    for (i=0; i<num_frames; i++)
+        rresamp_crcf_execute(q0, &x[i*Q], &y0[i*P]);
+
+    // irregular block sizes, including ones shorter than the history
+    unsigned int lens[] = {1, 2, 9, 0, 3, 20};
+    unsigned int n = 0;
+    for (i=0; n<num_frames; i++) {
+        unsigned int len = lens[i % 6];
+        if (n + len > num_frames)
+            len = num_frames - n;
+        rresamp_crcf_execute_block(q1, &x[n*Q], len, &y1[n*P]);
+        n += len;
+    }
+
+    CONTEND_SAME_DATA(y0, y1, num_frames*P*sizeof(float complex));
+
+    rresamp_crcf_destroy(q0);
+    rresamp_crcf_destroy(q1);
+}
+
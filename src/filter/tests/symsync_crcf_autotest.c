@@ -175,3 +175,100 @@ void autotest_symsync_crcf_scenario_1() { symsync_crcf_test(2, 7, 0.35, -0.25, 1
 void autotest_symsync_crcf_scenario_2() { symsync_crcf_test(2, 7, 0.35, -0.25, 1.0001f ); }
 void autotest_symsync_crcf_scenario_3() { symsync_crcf_test(2, 7, 0.35, -0.25, 0.9999f ); }
 
+
+// 
+// AUTOTEST: streaming execution over irregular block lengths must
+//           match execution on the entire input at once
+//
+void autotest_symsync_crcf_stream()
+{
+    unsigned int k           = 2;       // samples/symbol
+    unsigned int m           = 7;       // filter delay (symbols)
+    float        beta        = 0.35f;   // filter excess bandwidth
+    unsigned int num_filters = 32;      // number of filters in bank
+    unsigned int num_samples = 4000;    // number of input samples
+    float        tol         = 1e-6f;   // error tolerance
+    unsigned int i;
+
+    // random input signal
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    symsync_crcf q0 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, k, m, beta, num_filters);
+    symsync_crcf q1 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, k, m, beta, num_filters);
+    symsync_crcf_set_lf_bw(q0, 0.02f);
+    symsync_crcf_set_lf_bw(q1, 0.02f);
+
+    // run entire block
+    float complex y0[2*num_samples];
+    unsigned int  n0;
+    symsync_crcf_execute(q0, x, num_samples, y0, &n0);
+
+    // run over irregular block lengths (including some longer than
+    // the internal span length)
+    float complex y1[2*num_samples];
+    unsigned int  n1 = 0;
+    unsigned int  lens[] = {1, 7, 0, 33, 64, 2, 100, 31, 32, 5};
+    unsigned int  j = 0;
+    for (i=0; j<num_samples; i++) {
+        unsigned int len = lens[i % 10];
+        if (j + len > num_samples)
+            len = num_samples - j;
+        unsigned int ny;
+        symsync_crcf_execute(q1, x+j, len, y1+n1, &ny);
+        j  += len;
+        n1 += ny;
+    }
+
+    CONTEND_EQUALITY(n0, n1);
+    for (i=0; i<n0 && i<n1; i++)
+        CONTEND_DELTA(cabsf(y0[i]-y1[i]), 0.0f, tol);
+
+    symsync_crcf_destroy(q0);
+    symsync_crcf_destroy(q1);
+}
+
+// half-precision matched and derivative matched filterbanks track the
+// single-precision synchronizer output closely
+void autotest_symsync_crcf_coeff_fp16()
+{
+    unsigned int k           = 2;       // samples/symbol
+    unsigned int m           = 7;       // filter delay (symbols)
+    float        beta        = 0.35f;   // filter excess bandwidth
+    unsigned int num_filters = 64;      // number of filters in bank
+    unsigned int num_samples = 2000;    // number of input samples
+    unsigned int i;
+
+    // generate QPSK symbols with a fractional timing offset; on a signal
+    // without symbol structure the two timing loops wander independently
+    float complex x[num_samples];
+    firinterp_crcf interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_ARKAISER, k, m, beta, 0.3f);
+    for (i=0; i<num_samples/k; i++) {
+        float complex s = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                          (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+        firinterp_crcf_execute(interp, s, &x[k*i]);
+    }
+    firinterp_crcf_destroy(interp);
+
+    symsync_crcf q0 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, k, m, beta, num_filters);
+    symsync_crcf q1 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, k, m, beta, num_filters);
+    symsync_crcf_set_coeff_fp16(q1, 1);
+
+    float complex y0[2*num_samples];
+    float complex y1[2*num_samples];
+    unsigned int  n0, n1;
+    symsync_crcf_execute(q0, x, num_samples, y0, &n0);
+    symsync_crcf_execute(q1, x, num_samples, y1, &n1);
+
+    CONTEND_EQUALITY(n0, n1);
+    float e2 = 0.0f, y2 = 0.0f;
+    for (i=0; i<n0 && i<n1; i++) {
+        e2 += crealf((y0[i]-y1[i])*conjf(y0[i]-y1[i]));
+        y2 += crealf(y0[i]*conjf(y0[i]));
+    }
+    CONTEND_LESS_THAN(10*log10f(e2/y2), -40.0f);
+
+    symsync_crcf_destroy(q0);
+    symsync_crcf_destroy(q1);
+}
@@ -98,3 +98,33 @@ void benchmark_bpacketsync(struct rusage *_start,
     bpacketsync_destroy(ps);
 }
 
+// p/n search throughput on random bytes (synchronizer never locks)
+void benchmark_bpacketsync_seekpn(struct rusage *_start,
+                                  struct rusage *_finish,
+                                  unsigned long int *_num_iterations)
+{
+    // adjust number of iterations
+    *_num_iterations *= 4;
+
+    unsigned int num_packets_found=0;
+    bpacketsync ps = bpacketsync_create(0, bpacketsync_benchmark_callback, (void*)&num_packets_found);
+
+    unsigned char buf[256];
+    unsigned long int i;
+    for (i=0; i<256; i++)
+        buf[i] = rand() % 256;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        bpacketsync_execute_byte(ps, buf[(4*i+0)&0xff]);
+        bpacketsync_execute_byte(ps, buf[(4*i+1)&0xff]);
+        bpacketsync_execute_byte(ps, buf[(4*i+2)&0xff]);
+        bpacketsync_execute_byte(ps, buf[(4*i+3)&0xff]);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    bpacketsync_destroy(ps);
+}
+
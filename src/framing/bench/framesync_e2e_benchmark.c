@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// framesync_e2e_benchmark.c
+//
+// End-to-end receive throughput of the framing objects: a capture of
+// several frames is generated and passed through a channel_cccf object
+// (AWGN and carrier offset) outside of the timed region, then fed
+// repeatedly through the corresponding frame synchronizer in blocks.
+// One trial is one received sample, so the reported rate is the receive
+// processing rate in samples/s; frames/s and the number of cores needed
+// to sustain FRAMESYNC_E2E_SAMPLE_RATE are printed by each run.
+//
+// The latency benchmarks enable the synchronizer performance counters
+// and print the distribution of the time from entering execute() with
+// the last sample of a frame to the callback being invoked, for several
+// execute() block sizes.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// reference sample rate for the real-time core estimate [samples/s]
+#define FRAMESYNC_E2E_SAMPLE_RATE   (1e6f)
+
+// framing types
+enum {
+    FRAMESYNC_E2E_FRAME64=0,    // framegen64/framesync64
+    FRAMESYNC_E2E_FLEXFRAME,    // flexframegen/flexframesync
+    FRAMESYNC_E2E_GMSKFRAME,    // gmskframegen/gmskframesync
+    FRAMESYNC_E2E_OFDMFLEXFRAME,// ofdmflexframegen/ofdmflexframesync
+};
+
+#define FRAMESYNC_E2E_BENCH_API(TYPE,MS,FEC,LEN,SNR)                \
+(   struct rusage *_start,                                          \
+    struct rusage *_finish,                                         \
+    unsigned long int *_num_iterations)                             \
+{ framesync_e2e_bench(_start, _finish, _num_iterations, TYPE, MS, FEC, LEN, SNR, 256, 0); }
+
+#define FRAMESYNC_E2E_LATENCY_API(TYPE,BLOCK_LEN)                   \
+(   struct rusage *_start,                                          \
+    struct rusage *_finish,                                         \
+    unsigned long int *_num_iterations)                             \
+{ framesync_e2e_bench(_start, _finish, _num_iterations, TYPE,       \
+    LIQUID_MODEM_QPSK, LIQUID_FEC_NONE, 256, 20.0f, BLOCK_LEN, 1); }
+
+typedef struct {
+    unsigned int num_frames_detected;
+    unsigned int num_payloads_valid;
+} framesync_e2e_data;
+
+static int framesync_e2e_callback(unsigned char *  _header,
+                                  int              _header_valid,
+                                  unsigned char *  _payload,
+                                  unsigned int     _payload_len,
+                                  int              _payload_valid,
+                                  framesyncstats_s _stats,
+                                  void *           _userdata)
+{
+    framesync_e2e_data * fd = (framesync_e2e_data*) _userdata;
+    fd->num_frames_detected++;
+    if (_payload_valid)
+        fd->num_payloads_valid++;
+    return 0;
+}
+
+// generate capture of '_num_frames' frames separated by '_gap_len'
+// zero-valued samples, returning the number of samples written to '_x'
+unsigned int framesync_e2e_generate(int              _type,
+                                    modulation_scheme _ms,
+                                    fec_scheme       _fec,
+                                    unsigned int     _payload_len,
+                                    unsigned int     _num_frames,
+                                    unsigned int     _gap_len,
+                                    float complex ** _x)
+{
+    unsigned int i, k;
+    unsigned char header[14];
+    unsigned char payload[_payload_len];
+    for (i=0; i<14; i++)
+        header[i] = i;
+
+    // frame generators
+    framegen64       fg64  = NULL;
+    flexframegen     fgf   = NULL;
+    gmskframegen     fgg   = NULL;
+    ofdmflexframegen fgo   = NULL;
+    switch (_type) {
+    case FRAMESYNC_E2E_FRAME64:
+        fg64 = framegen64_create();
+        break;
+    case FRAMESYNC_E2E_FLEXFRAME: {
+        flexframegenprops_s props;
+        flexframegenprops_init_default(&props);
+        props.check      = LIQUID_CRC_32;
+        props.fec0       = _fec;
+        props.fec1       = LIQUID_FEC_NONE;
+        props.mod_scheme = _ms;
+        fgf = flexframegen_create(&props);
+        } break;
+    case FRAMESYNC_E2E_GMSKFRAME:
+        fgg = gmskframegen_create();
+        break;
+    case FRAMESYNC_E2E_OFDMFLEXFRAME: {
+        ofdmflexframegenprops_s props;
+        ofdmflexframegenprops_init_default(&props);
+        props.check      = LIQUID_CRC_32;
+        props.fec0       = _fec;
+        props.fec1       = LIQUID_FEC_NONE;
+        props.mod_scheme = _ms;
+        fgo = ofdmflexframegen_create(64, 16, 4, NULL, &props);
+        } break;
+    default:
+        fprintf(stderr,"error: framesync_e2e_generate(), invalid framing type\n");
+        exit(1);
+    }
+
+    // write frames into capture buffer, growing as needed
+    unsigned int  buf_len = 4096;
+    float complex buf[buf_len];
+    float complex * x = NULL;
+    unsigned int  n = 0;
+    for (k=0; k<_num_frames; k++) {
+        for (i=0; i<_payload_len; i++)
+            payload[i] = rand() & 0xff;
+
+        // gap
+        x = (float complex*) realloc(x, (n + _gap_len)*sizeof(float complex));
+        memset(x + n, 0, _gap_len*sizeof(float complex));
+        n += _gap_len;
+
+        if (fg64 != NULL) {
+            x = (float complex*) realloc(x, (n + LIQUID_FRAME64_LEN)*sizeof(float complex));
+            framegen64_execute(fg64, header, payload, x + n);
+            n += LIQUID_FRAME64_LEN;
+            continue;
+        }
+
+        if (fgf != NULL) flexframegen_assemble    (fgf, header, payload, _payload_len);
+        if (fgg != NULL) gmskframegen_assemble    (fgg, header, payload, _payload_len,
+                                                   LIQUID_CRC_32, _fec, LIQUID_FEC_NONE);
+        if (fgo != NULL) ofdmflexframegen_assemble(fgo, header, payload, _payload_len);
+
+        int frame_complete = 0;
+        while (!frame_complete) {
+            unsigned int num_written = 0;
+            if (fgf != NULL) frame_complete = flexframegen_write_block    (fgf, buf, buf_len, &num_written);
+            if (fgg != NULL) frame_complete = gmskframegen_write_block    (fgg, buf, buf_len, &num_written);
+            if (fgo != NULL) frame_complete = ofdmflexframegen_write_block(fgo, buf, buf_len, &num_written);
+            x = (float complex*) realloc(x, (n + num_written)*sizeof(float complex));
+            memmove(x + n, buf, num_written*sizeof(float complex));
+            n += num_written;
+        }
+    }
+
+    // trailing gap
+    x = (float complex*) realloc(x, (n + _gap_len)*sizeof(float complex));
+    memset(x + n, 0, _gap_len*sizeof(float complex));
+    n += _gap_len;
+
+    if (fg64 != NULL) framegen64_destroy(fg64);
+    if (fgf  != NULL) flexframegen_destroy(fgf);
+    if (fgg  != NULL) gmskframegen_destroy(fgg);
+    if (fgo  != NULL) ofdmflexframegen_destroy(fgo);
+
+    *_x = x;
+    return n;
+}
+
+// print execute-to-callback latency distribution: mean, extremes and
+// median/99th percentile (upper edge of histogram bin), along with the
+// time to fill one execute() block at FRAMESYNC_E2E_SAMPLE_RATE
+void framesync_e2e_print_latency(frameperfstats_s * _stats,
+                                 unsigned int       _block_len)
+{
+    if (_stats->num_latency == 0) {
+        printf("  latency: no frames received\n");
+        return;
+    }
+
+    unsigned int i;
+    unsigned long int n = 0;
+    unsigned int p50 = 0, p99 = 0;
+    for (i=0; i<FRAMEPERFSTATS_LATENCY_BINS; i++) {
+        n += _stats->latency_hist[i];
+        if (p50 == 0 && 2*n   >= _stats->num_latency) p50 = 2u << i;
+        if (p99 == 0 && 100*n >= 99*_stats->num_latency) p99 = 2u << i;
+    }
+    printf("  latency [us]: mean %9.2f, min %9.2f, max %9.2f, p50 <%6u, p99 <%6u, block fill %9.2f\n",
+            1e6*_stats->latency_sum / _stats->num_latency,
+            1e6*_stats->latency_min,
+            1e6*_stats->latency_max,
+            p50, p99,
+            1e6*_block_len / FRAMESYNC_E2E_SAMPLE_RATE);
+    printf("  histogram [us]:");
+    for (i=0; i<FRAMEPERFSTATS_LATENCY_BINS; i++) {
+        if (_stats->latency_hist[i] > 0)
+            printf(" <%u:%lu", 2u << i, _stats->latency_hist[i]);
+    }
+    printf("\n");
+}
+
+// Helper function to keep code base small
+void framesync_e2e_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         int                 _type,
+                         modulation_scheme   _ms,
+                         fec_scheme          _fec,
+                         unsigned int        _payload_len,
+                         float               _SNRdB,
+                         unsigned int        _block_len,
+                         int                 _latency)
+{
+    unsigned int num_frames = 4;    // frames per capture
+    unsigned int gap_len    = 512;  // samples between frames
+
+    // generate capture and apply channel impairments
+    float complex * x = NULL;
+    unsigned int nx = framesync_e2e_generate(_type, _ms, _fec, _payload_len,
+                                             num_frames, gap_len, &x);
+    float complex * y = (float complex*) malloc((nx + 64)*sizeof(float complex));
+    unsigned int ny = 0;
+    channel_cccf channel = channel_cccf_create();
+    channel_cccf_add_awgn(channel, -60.0f, _SNRdB);
+    channel_cccf_add_carrier_offset(channel, 0.002f, 0.7f);
+    channel_cccf_execute(channel, x, nx, y, &ny);
+    channel_cccf_destroy(channel);
+
+    // create frame synchronizer
+    framesync_e2e_data fd = {0, 0};
+    framesync64       fs64 = NULL;
+    flexframesync     fsf  = NULL;
+    gmskframesync     fsg  = NULL;
+    ofdmflexframesync fso  = NULL;
+    switch (_type) {
+    case FRAMESYNC_E2E_FRAME64:
+        fs64 = framesync64_create(framesync_e2e_callback, (void*)&fd);
+        break;
+    case FRAMESYNC_E2E_FLEXFRAME:
+        fsf = flexframesync_create(framesync_e2e_callback, (void*)&fd);
+        break;
+    case FRAMESYNC_E2E_GMSKFRAME:
+        fsg = gmskframesync_create(framesync_e2e_callback, (void*)&fd);
+        break;
+    case FRAMESYNC_E2E_OFDMFLEXFRAME:
+        fso = ofdmflexframesync_create(64, 16, 4, NULL, framesync_e2e_callback, (void*)&fd);
+        break;
+    default:;
+    }
+
+    // measure latency with the synchronizer performance counters
+    if (_latency) {
+        if (fs64 != NULL) framesync64_perfstats_enable      (fs64);
+        if (fsf  != NULL) flexframesync_perfstats_enable    (fsf);
+        if (fsg  != NULL) gmskframesync_perfstats_enable    (fsg);
+        if (fso  != NULL) ofdmflexframesync_perfstats_enable(fso);
+    }
+
+    // number of passes over the capture
+    unsigned long int num_passes = *_num_iterations / ny + 1;
+    unsigned long int i;
+    unsigned int j;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<num_passes; i++) {
+        for (j=0; j<ny; j+=_block_len) {
+            unsigned int n = (ny - j) < _block_len ? ny - j : _block_len;
+            if (fs64 != NULL) framesync64_execute      (fs64, y+j, n);
+            if (fsf  != NULL) flexframesync_execute    (fsf,  y+j, n);
+            if (fsg  != NULL) gmskframesync_execute    (fsg,  y+j, n);
+            if (fso  != NULL) ofdmflexframesync_execute(fso,  y+j, n);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_passes * ny;
+
+    // print results
+    double extime = _finish->ru_utime.tv_sec  - _start->ru_utime.tv_sec
+             + 1e-6*(_finish->ru_utime.tv_usec - _start->ru_utime.tv_usec)
+             +       _finish->ru_stime.tv_sec  - _start->ru_stime.tv_sec
+             + 1e-6*(_finish->ru_stime.tv_usec - _start->ru_stime.tv_usec);
+    if (extime > 0) {
+        double rate = (double)(*_num_iterations) / extime;
+        printf("  frames detected/valid/transmitted: %6u / %6u / %6lu, "
+               "%7.3f Ms/s, %9.1f frames/s, %6.3f cores @ %.1f Ms/s\n",
+                fd.num_frames_detected, fd.num_payloads_valid, num_passes*num_frames,
+                rate*1e-6, rate*num_frames/ny,
+                FRAMESYNC_E2E_SAMPLE_RATE / rate, FRAMESYNC_E2E_SAMPLE_RATE*1e-6);
+    }
+
+    // print latency distribution
+    if (_latency) {
+        frameperfstats_s stats;
+        if (fs64 != NULL) stats = framesync64_get_perfstats      (fs64);
+        if (fsf  != NULL) stats = flexframesync_get_perfstats    (fsf);
+        if (fsg  != NULL) stats = gmskframesync_get_perfstats    (fsg);
+        if (fso  != NULL) stats = ofdmflexframesync_get_perfstats(fso);
+        framesync_e2e_print_latency(&stats, _block_len);
+    }
+
+    // destroy objects
+    if (fs64 != NULL) framesync64_destroy(fs64);
+    if (fsf  != NULL) flexframesync_destroy(fsf);
+    if (fsg  != NULL) gmskframesync_destroy(fsg);
+    if (fso  != NULL) ofdmflexframesync_destroy(fso);
+    free(x);
+    free(y);
+}
+
+// framesync64 (fixed QPSK, Golay(24,12), 64-byte payload): SNR
+void benchmark_framesync_e2e_f64_s10                  FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_FRAME64,       LIQUID_MODEM_QPSK,    LIQUID_FEC_NONE,        64, 10.0f)
+void benchmark_framesync_e2e_f64_s20                  FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_FRAME64,       LIQUID_MODEM_QPSK,    LIQUID_FEC_NONE,        64, 20.0f)
+
+// flexframe: modulation, FEC, payload length, SNR
+void benchmark_framesync_e2e_flex_bpsk_n64_s10        FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_FLEXFRAME,     LIQUID_MODEM_BPSK,    LIQUID_FEC_NONE,        64, 10.0f)
+void benchmark_framesync_e2e_flex_qpsk_n256_s20       FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_FLEXFRAME,     LIQUID_MODEM_QPSK,    LIQUID_FEC_NONE,       256, 20.0f)
+void benchmark_framesync_e2e_flex_qpsk_h74_n256_s10   FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_FLEXFRAME,     LIQUID_MODEM_QPSK,    LIQUID_FEC_HAMMING74,  256, 10.0f)
+void benchmark_framesync_e2e_flex_qam16_v27_n256_s20  FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_FLEXFRAME,     LIQUID_MODEM_QAM16,   LIQUID_FEC_CONV_V27,   256, 20.0f)
+void benchmark_framesync_e2e_flex_qam64_n1024_s30     FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_FLEXFRAME,     LIQUID_MODEM_QAM64,   LIQUID_FEC_NONE,      1024, 30.0f)
+
+// gmskframe: FEC, payload length, SNR
+void benchmark_framesync_e2e_gmsk_n64_s15             FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_GMSKFRAME,     LIQUID_MODEM_UNKNOWN, LIQUID_FEC_NONE,        64, 15.0f)
+void benchmark_framesync_e2e_gmsk_h74_n256_s15        FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_GMSKFRAME,     LIQUID_MODEM_UNKNOWN, LIQUID_FEC_HAMMING74,  256, 15.0f)
+
+// ofdmflexframe (64 subcarriers): modulation, FEC, payload length, SNR
+void benchmark_framesync_e2e_ofdm_qpsk_n256_s20       FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_OFDMFLEXFRAME, LIQUID_MODEM_QPSK,    LIQUID_FEC_NONE,       256, 20.0f)
+void benchmark_framesync_e2e_ofdm_qam16_v27_n1024_s20 FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_OFDMFLEXFRAME, LIQUID_MODEM_QAM16,   LIQUID_FEC_CONV_V27,  1024, 20.0f)
+void benchmark_framesync_e2e_ofdm_qam64_n1024_s30     FRAMESYNC_E2E_BENCH_API(FRAMESYNC_E2E_OFDMFLEXFRAME, LIQUID_MODEM_QAM64,   LIQUID_FEC_NONE,      1024, 30.0f)
+
+// execute-to-callback latency versus execute() block size
+void benchmark_framesync_e2e_latency_flex_b16        FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_FLEXFRAME,       16)
+void benchmark_framesync_e2e_latency_flex_b256       FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_FLEXFRAME,      256)
+void benchmark_framesync_e2e_latency_flex_b4096      FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_FLEXFRAME,     4096)
+void benchmark_framesync_e2e_latency_gmsk_b16        FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_GMSKFRAME,       16)
+void benchmark_framesync_e2e_latency_gmsk_b256       FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_GMSKFRAME,      256)
+void benchmark_framesync_e2e_latency_gmsk_b4096      FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_GMSKFRAME,     4096)
+void benchmark_framesync_e2e_latency_ofdm_b16        FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_OFDMFLEXFRAME,   16)
+void benchmark_framesync_e2e_latency_ofdm_b256       FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_OFDMFLEXFRAME,  256)
+void benchmark_framesync_e2e_latency_ofdm_b4096      FRAMESYNC_E2E_LATENCY_API(FRAMESYNC_E2E_OFDMFLEXFRAME, 4096)
@@ -135,11 +135,13 @@ void benchmark_gmskframesync(struct rusage *     _start,
     gmskframesync_destroy(fs);
 }
 
-// benchmark regular frame synchronizer with noise; essentially test
+// benchmark frame synchronizer with noise; essentially test
 // complexity when no signal is present
-void benchmark_gmskframesync_noise(struct rusage *     _start,
-                                   struct rusage *     _finish,
-                                   unsigned long int * _num_iterations)
+//  _mode   :   frame detector (0: time-domain, 1: FFT, 2: FFT with energy gate)
+void gmskframesync_noise_bench(struct rusage *     _start,
+                               struct rusage *     _finish,
+                               unsigned long int * _num_iterations,
+                               int                 _mode)
 {
     *_num_iterations /= 400;
     unsigned long int i;
@@ -152,6 +154,10 @@ void benchmark_gmskframesync_noise(struct rusage *     _start,
 
     // create frame synchronizer
     gmskframesync fs = gmskframesync_create(NULL, NULL);
+    if (_mode > 0)
+        gmskframesync_fft_detector_enable(fs);
+    if (_mode > 1)
+        gmskframesync_gate_enable(fs);
 
     // allocate memory for noise buffer and initialize
     unsigned int num_samples = 1024;
@@ -176,3 +182,12 @@ void benchmark_gmskframesync_noise(struct rusage *     _start,
     gmskframesync_destroy(fs);
 }
 
+#define GMSKFRAMESYNC_NOISE_BENCH_API(MODE)     \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ gmskframesync_noise_bench(_start, _finish, _num_iterations, MODE); }
+
+void benchmark_gmskframesync_noise      GMSKFRAMESYNC_NOISE_BENCH_API(0);
+void benchmark_gmskframesync_noise_fft  GMSKFRAMESYNC_NOISE_BENCH_API(1);
+void benchmark_gmskframesync_noise_gate GMSKFRAMESYNC_NOISE_BENCH_API(2);
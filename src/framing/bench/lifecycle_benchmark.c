@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// lifecycle_benchmark.c
+//
+// Start-up cost of the framing, filter and transform objects, for
+// receivers that are created and destroyed frequently. Three operations
+// are timed, one trial each:
+//
+//  create      :   one _create()/_destroy() cycle; the split between
+//                  the two calls is measured separately and printed
+//  reset       :   one _reset() of an existing object
+//  setprops    :   one _setprops() of an existing generator, alternating
+//                  between two configurations so that every call
+//                  reconfigures the payload encoder
+//
+// Creation is timed in two states to show the benefit of the design and
+// plan caches:
+//
+//  cold        :   filter design cache disabled and no other instance
+//                  alive, so every shared table is recomputed
+//  warm        :   filter design cache enabled and primed, and one
+//                  instance kept alive so that transform and modem
+//                  tables are shared rather than recomputed
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// object types
+enum {
+    LIFECYCLE_FRAMESYNC64=0,        // framesync64
+    LIFECYCLE_FLEXFRAMESYNC,        // flexframesync
+    LIFECYCLE_FLEXFRAMESYNC_SHARED, // flexframesync sharing a prototype
+    LIFECYCLE_GMSKFRAMESYNC,        // gmskframesync
+    LIFECYCLE_OFDMFLEXFRAMESYNC,    // ofdmflexframesync (M subcarriers, cp: M/4)
+    LIFECYCLE_FLEXFRAMEGEN,         // flexframegen
+    LIFECYCLE_OFDMFLEXFRAMEGEN,     // ofdmflexframegen (M subcarriers, cp: M/4)
+    LIFECYCLE_FIRFILT_KAISER,       // firfilt_crcf, Kaiser design (n taps)
+    LIFECYCLE_FIRPFB_RNYQUIST,      // firpfb_crcf, rKaiser design (n filters)
+    LIFECYCLE_FFT,                  // fft plan (n points)
+};
+
+// operations
+enum {
+    LIFECYCLE_CREATE=0,             // create/destroy cycle
+    LIFECYCLE_RESET,                // reset
+    LIFECYCLE_SETPROPS,             // set properties
+};
+
+#define LIFECYCLE_BENCH_API(OP,TYPE,N,WARM)             \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ lifecycle_bench(_start, _finish, _num_iterations, OP, TYPE, N, WARM); }
+
+static int lifecycle_callback(unsigned char *  _header,
+                              int              _header_valid,
+                              unsigned char *  _payload,
+                              unsigned int     _payload_len,
+                              int              _payload_valid,
+                              framesyncstats_s _stats,
+                              void *           _userdata)
+{
+    return 0;
+}
+
+// transform buffers (contents are irrelevant to planning)
+static float complex lifecycle_fft_buf[2][4096];
+
+// monotonic time [seconds]
+static double lifecycle_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+// create object of given type and size
+//  _type   :   object type
+//  _n      :   size parameter
+//  _proto  :   prototype for shared objects (may be NULL)
+static void * lifecycle_create(int _type, unsigned int _n, void * _proto)
+{
+    flexframegenprops_s     fgprops;
+    ofdmflexframegenprops_s ofgprops;
+    switch (_type) {
+    case LIFECYCLE_FRAMESYNC64:
+        return framesync64_create(lifecycle_callback, NULL);
+    case LIFECYCLE_FLEXFRAMESYNC:
+        return flexframesync_create(lifecycle_callback, NULL);
+    case LIFECYCLE_FLEXFRAMESYNC_SHARED:
+        return flexframesync_create_shared((flexframesync)_proto, lifecycle_callback, NULL);
+    case LIFECYCLE_GMSKFRAMESYNC:
+        return gmskframesync_create(lifecycle_callback, NULL);
+    case LIFECYCLE_OFDMFLEXFRAMESYNC:
+        return ofdmflexframesync_create(_n, _n/4, 4, NULL, lifecycle_callback, NULL);
+    case LIFECYCLE_FLEXFRAMEGEN:
+        flexframegenprops_init_default(&fgprops);
+        return flexframegen_create(&fgprops);
+    case LIFECYCLE_OFDMFLEXFRAMEGEN:
+        ofdmflexframegenprops_init_default(&ofgprops);
+        return ofdmflexframegen_create(_n, _n/4, 4, NULL, &ofgprops);
+    case LIFECYCLE_FIRFILT_KAISER:
+        return firfilt_crcf_create_kaiser(_n, 0.2f, 60.0f, 0.0f);
+    case LIFECYCLE_FIRPFB_RNYQUIST:
+        return firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_RKAISER, _n, 2, 7, 0.3f);
+    case LIFECYCLE_FFT:
+        return fft_create_plan(_n, lifecycle_fft_buf[0], lifecycle_fft_buf[1],
+                               LIQUID_FFT_FORWARD, 0);
+    default:;
+    }
+    fprintf(stderr,"error: lifecycle_create(), invalid object type\n");
+    exit(1);
+    return NULL;
+}
+
+// destroy object of given type
+static void lifecycle_destroy(int _type, void * _q)
+{
+    switch (_type) {
+    case LIFECYCLE_FRAMESYNC64:          framesync64_destroy      ((framesync64)      _q); break;
+    case LIFECYCLE_FLEXFRAMESYNC:
+    case LIFECYCLE_FLEXFRAMESYNC_SHARED: flexframesync_destroy    ((flexframesync)    _q); break;
+    case LIFECYCLE_GMSKFRAMESYNC:        gmskframesync_destroy    ((gmskframesync)    _q); break;
+    case LIFECYCLE_OFDMFLEXFRAMESYNC:    ofdmflexframesync_destroy((ofdmflexframesync)_q); break;
+    case LIFECYCLE_FLEXFRAMEGEN:         flexframegen_destroy     ((flexframegen)     _q); break;
+    case LIFECYCLE_OFDMFLEXFRAMEGEN:     ofdmflexframegen_destroy ((ofdmflexframegen) _q); break;
+    case LIFECYCLE_FIRFILT_KAISER:       firfilt_crcf_destroy     ((firfilt_crcf)     _q); break;
+    case LIFECYCLE_FIRPFB_RNYQUIST:      firpfb_crcf_destroy      ((firpfb_crcf)      _q); break;
+    case LIFECYCLE_FFT:                  fft_destroy_plan         ((fftplan)          _q); break;
+    default:;
+    }
+}
+
+// reset object of given type
+static void lifecycle_reset(int _type, void * _q)
+{
+    switch (_type) {
+    case LIFECYCLE_FRAMESYNC64:          framesync64_reset      ((framesync64)      _q); break;
+    case LIFECYCLE_FLEXFRAMESYNC:
+    case LIFECYCLE_FLEXFRAMESYNC_SHARED: flexframesync_reset    ((flexframesync)    _q); break;
+    case LIFECYCLE_GMSKFRAMESYNC:        gmskframesync_reset    ((gmskframesync)    _q); break;
+    case LIFECYCLE_OFDMFLEXFRAMESYNC:    ofdmflexframesync_reset((ofdmflexframesync)_q); break;
+    case LIFECYCLE_FLEXFRAMEGEN:         flexframegen_reset     ((flexframegen)     _q); break;
+    case LIFECYCLE_OFDMFLEXFRAMEGEN:     ofdmflexframegen_reset ((ofdmflexframegen) _q); break;
+    case LIFECYCLE_FIRFILT_KAISER:       firfilt_crcf_reset     ((firfilt_crcf)     _q); break;
+    case LIFECYCLE_FIRPFB_RNYQUIST:      firpfb_crcf_reset      ((firpfb_crcf)      _q); break;
+    default:
+        fprintf(stderr,"error: lifecycle_reset(), object type cannot be reset\n");
+        exit(1);
+    }
+}
+
+// set properties of generator, alternating between two configurations
+//  _type   :   object type
+//  _q      :   object
+//  _i      :   trial index
+static void lifecycle_setprops(int _type, void * _q, unsigned long int _i)
+{
+    int          ms  = (_i & 1) ? LIQUID_MODEM_QAM16   : LIQUID_MODEM_QPSK;
+    fec_scheme   fec = (_i & 1) ? LIQUID_FEC_CONV_V27  : LIQUID_FEC_HAMMING128;
+    flexframegenprops_s     fgprops;
+    ofdmflexframegenprops_s ofgprops;
+    switch (_type) {
+    case LIFECYCLE_FLEXFRAMEGEN:
+        flexframegenprops_init_default(&fgprops);
+        fgprops.mod_scheme = ms;
+        fgprops.fec0       = fec;
+        flexframegen_setprops((flexframegen)_q, &fgprops);
+        break;
+    case LIFECYCLE_OFDMFLEXFRAMEGEN:
+        ofdmflexframegenprops_init_default(&ofgprops);
+        ofgprops.mod_scheme = ms;
+        ofgprops.fec0       = fec;
+        ofdmflexframegen_setprops((ofdmflexframegen)_q, &ofgprops);
+        break;
+    default:
+        fprintf(stderr,"error: lifecycle_setprops(), object type has no properties\n");
+        exit(1);
+    }
+}
+
+// Helper function to keep code base small
+void lifecycle_bench(struct rusage *     _start,
+                     struct rusage *     _finish,
+                     unsigned long int * _num_iterations,
+                     int                 _op,
+                     int                 _type,
+                     unsigned int        _n,
+                     int                 _warm)
+{
+    // creating objects is slow (and slower still without caches); scale
+    // trials down
+    if (_op == LIFECYCLE_CREATE) *_num_iterations /= _warm ? 1000 : 10000;
+    else                         *_num_iterations /= 10;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // set filter design cache state, priming it when warm
+    int cache_enabled = liquid_firdes_cache_is_enabled();
+    liquid_firdes_cache_clear();
+    if (_warm) liquid_firdes_cache_enable();
+    else       liquid_firdes_cache_disable();
+
+    // keep one instance alive: prototype for shared objects, shared
+    // tables when warm, and the object under test otherwise
+    void * proto = NULL;
+    if (_type == LIFECYCLE_FLEXFRAMESYNC_SHARED)
+        proto = lifecycle_create(LIFECYCLE_FLEXFRAMESYNC, _n, NULL);
+    else if (_warm || _op != LIFECYCLE_CREATE)
+        proto = lifecycle_create(_type, _n, NULL);
+
+    double t_create  = 0.0;
+    double t_destroy = 0.0;
+    unsigned long int i;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    if (_op == LIFECYCLE_CREATE) {
+        for (i=0; i<(*_num_iterations); i++) {
+            double t0 = lifecycle_clock();
+            void * q = lifecycle_create(_type, _n, proto);
+            double t1 = lifecycle_clock();
+            lifecycle_destroy(_type, q);
+            double t2 = lifecycle_clock();
+            t_create  += t1 - t0;
+            t_destroy += t2 - t1;
+        }
+    } else if (_op == LIFECYCLE_RESET) {
+        for (i=0; i<(*_num_iterations); i++)
+            lifecycle_reset(_type, proto);
+    } else {
+        for (i=0; i<(*_num_iterations); i++)
+            lifecycle_setprops(_type, proto, i);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    // print split between create and destroy (once per benchmark; the
+    // harness calls this function repeatedly while calibrating)
+    static int          last_type = -1;
+    static unsigned int last_n    = 0;
+    static int          last_warm = -1;
+    if (_op == LIFECYCLE_CREATE &&
+        (_type != last_type || _n != last_n || _warm != last_warm))
+    {
+        printf("  create: %10.2f us, destroy: %10.2f us\n",
+                1e6*t_create  / (double)(*_num_iterations),
+                1e6*t_destroy / (double)(*_num_iterations));
+        last_type = _type;
+        last_n    = _n;
+        last_warm = _warm;
+    }
+
+    if (proto != NULL)
+        lifecycle_destroy(_type == LIFECYCLE_FLEXFRAMESYNC_SHARED ? LIFECYCLE_FLEXFRAMESYNC : _type, proto);
+
+    // restore filter design cache state
+    liquid_firdes_cache_clear();
+    if (cache_enabled) liquid_firdes_cache_enable();
+    else               liquid_firdes_cache_disable();
+}
+
+// create/destroy: frame synchronizers
+void benchmark_lifecycle_create_framesync64_cold          LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FRAMESYNC64,          0,    0)
+void benchmark_lifecycle_create_framesync64_warm          LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FRAMESYNC64,          0,    1)
+void benchmark_lifecycle_create_flexframesync_cold        LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FLEXFRAMESYNC,        0,    0)
+void benchmark_lifecycle_create_flexframesync_warm        LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FLEXFRAMESYNC,        0,    1)
+void benchmark_lifecycle_create_flexframesync_shared      LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FLEXFRAMESYNC_SHARED, 0,    1)
+void benchmark_lifecycle_create_gmskframesync_cold        LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_GMSKFRAMESYNC,        0,    0)
+void benchmark_lifecycle_create_gmskframesync_warm        LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_GMSKFRAMESYNC,        0,    1)
+void benchmark_lifecycle_create_ofdmflexframesync_M64_cold  LIFECYCLE_BENCH_API(LIFECYCLE_CREATE, LIFECYCLE_OFDMFLEXFRAMESYNC,   64,    0)
+void benchmark_lifecycle_create_ofdmflexframesync_M64_warm  LIFECYCLE_BENCH_API(LIFECYCLE_CREATE, LIFECYCLE_OFDMFLEXFRAMESYNC,   64,    1)
+void benchmark_lifecycle_create_ofdmflexframesync_M256_cold LIFECYCLE_BENCH_API(LIFECYCLE_CREATE, LIFECYCLE_OFDMFLEXFRAMESYNC,  256,    0)
+void benchmark_lifecycle_create_ofdmflexframesync_M256_warm LIFECYCLE_BENCH_API(LIFECYCLE_CREATE, LIFECYCLE_OFDMFLEXFRAMESYNC,  256,    1)
+
+// create/destroy: frame generators
+void benchmark_lifecycle_create_flexframegen_cold         LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FLEXFRAMEGEN,         0,    0)
+void benchmark_lifecycle_create_flexframegen_warm         LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FLEXFRAMEGEN,         0,    1)
+void benchmark_lifecycle_create_ofdmflexframegen_M64_cold LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_OFDMFLEXFRAMEGEN,    64,    0)
+void benchmark_lifecycle_create_ofdmflexframegen_M64_warm LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_OFDMFLEXFRAMEGEN,    64,    1)
+
+// create/destroy: filter design
+void benchmark_lifecycle_create_firfilt_kaiser_n129_cold  LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FIRFILT_KAISER,     129,    0)
+void benchmark_lifecycle_create_firfilt_kaiser_n129_warm  LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FIRFILT_KAISER,     129,    1)
+void benchmark_lifecycle_create_firpfb_rnyquist_M32_cold  LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FIRPFB_RNYQUIST,     32,    0)
+void benchmark_lifecycle_create_firpfb_rnyquist_M32_warm  LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FIRPFB_RNYQUIST,     32,    1)
+
+// create/destroy: transform plans (radix-2, mixed-radix, prime)
+void benchmark_lifecycle_create_fft_n1024_cold            LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FFT,               1024,    0)
+void benchmark_lifecycle_create_fft_n1024_warm            LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FFT,               1024,    1)
+void benchmark_lifecycle_create_fft_n1000_cold            LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FFT,               1000,    0)
+void benchmark_lifecycle_create_fft_n1000_warm            LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FFT,               1000,    1)
+void benchmark_lifecycle_create_fft_n1021_cold            LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FFT,               1021,    0)
+void benchmark_lifecycle_create_fft_n1021_warm            LIFECYCLE_BENCH_API(LIFECYCLE_CREATE,   LIFECYCLE_FFT,               1021,    1)
+
+// reset
+void benchmark_lifecycle_reset_framesync64                LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_FRAMESYNC64,          0,    0)
+void benchmark_lifecycle_reset_flexframesync              LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_FLEXFRAMESYNC,        0,    0)
+void benchmark_lifecycle_reset_gmskframesync              LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_GMSKFRAMESYNC,        0,    0)
+void benchmark_lifecycle_reset_ofdmflexframesync_M64      LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_OFDMFLEXFRAMESYNC,   64,    0)
+void benchmark_lifecycle_reset_flexframegen               LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_FLEXFRAMEGEN,         0,    0)
+void benchmark_lifecycle_reset_ofdmflexframegen_M64       LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_OFDMFLEXFRAMEGEN,    64,    0)
+void benchmark_lifecycle_reset_firfilt_kaiser_n129        LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_FIRFILT_KAISER,     129,    0)
+void benchmark_lifecycle_reset_firpfb_rnyquist_M32        LIFECYCLE_BENCH_API(LIFECYCLE_RESET,    LIFECYCLE_FIRPFB_RNYQUIST,     32,    0)
+
+// set properties
+void benchmark_lifecycle_setprops_flexframegen            LIFECYCLE_BENCH_API(LIFECYCLE_SETPROPS, LIFECYCLE_FLEXFRAMEGEN,         0,    0)
+void benchmark_lifecycle_setprops_ofdmflexframegen_M64    LIFECYCLE_BENCH_API(LIFECYCLE_SETPROPS, LIFECYCLE_OFDMFLEXFRAMEGEN,    64,    0)
+
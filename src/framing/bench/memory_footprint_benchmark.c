@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// memory_footprint_benchmark.c
+//
+// Memory footprint of the larger receiver objects across parameter
+// sizes, as reported by their get_memory_usage() methods (allocated
+// bytes of each object and all of its internal objects and buffers).
+// One trial is one create/destroy cycle of the object; the footprint
+// is printed by each run, both in total and normalized by the size
+// parameter.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// object types
+enum {
+    MEMORY_FOOTPRINT_FIRPFBCH2=0,       // firpfbch2_crcf analyzer (m=4)
+    MEMORY_FOOTPRINT_QDETECTOR,         // qdetector_cccf (k=2, m=7)
+    MEMORY_FOOTPRINT_FLEXFRAMESYNC,     // flexframesync (size ignored)
+    MEMORY_FOOTPRINT_FLEXFRAMESYNC_SHARED, // flexframesync sharing a prototype
+    MEMORY_FOOTPRINT_OFDMFLEXFRAMESYNC, // ofdmflexframesync (cp: M/4)
+};
+
+#define MEMORY_FOOTPRINT_BENCH_API(TYPE,N)          \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ memory_footprint_bench(_start, _finish, _num_iterations, TYPE, N); }
+
+static int memory_footprint_callback(unsigned char *  _header,
+                                     int              _header_valid,
+                                     unsigned char *  _payload,
+                                     unsigned int     _payload_len,
+                                     int              _payload_valid,
+                                     framesyncstats_s _stats,
+                                     void *           _userdata)
+{
+    return 0;
+}
+
+// create object of given type and size, returning its footprint
+//  _type   :   object type
+//  _n      :   size parameter (channels, sequence length, subcarriers)
+//  _proto  :   prototype for shared objects (may be NULL)
+static unsigned long int memory_footprint_run(int           _type,
+                                              unsigned int  _n,
+                                              flexframesync _proto)
+{
+    unsigned long int num_bytes = 0;
+    switch (_type) {
+    case MEMORY_FOOTPRINT_FIRPFBCH2: {
+        firpfbch2_crcf q = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, _n, 4, 60.0f);
+        num_bytes = firpfbch2_crcf_get_memory_usage(q);
+        firpfbch2_crcf_destroy(q);
+        } break;
+    case MEMORY_FOOTPRINT_QDETECTOR: {
+        float complex s[_n];
+        unsigned int i;
+        for (i=0; i<_n; i++)
+            s[i] = (i*i % 5) < 2 ? 1.0f : -1.0f;
+        qdetector_cccf q = qdetector_cccf_create_linear(s, _n, LIQUID_FIRFILT_ARKAISER, 2, 7, 0.3f);
+        num_bytes = qdetector_cccf_get_memory_usage(q);
+        qdetector_cccf_destroy(q);
+        } break;
+    case MEMORY_FOOTPRINT_FLEXFRAMESYNC: {
+        flexframesync q = flexframesync_create(memory_footprint_callback, NULL);
+        num_bytes = flexframesync_get_memory_usage(q);
+        flexframesync_destroy(q);
+        } break;
+    case MEMORY_FOOTPRINT_FLEXFRAMESYNC_SHARED: {
+        flexframesync q = flexframesync_create_shared(_proto, memory_footprint_callback, NULL);
+        num_bytes = flexframesync_get_memory_usage(q);
+        flexframesync_destroy(q);
+        } break;
+    case MEMORY_FOOTPRINT_OFDMFLEXFRAMESYNC: {
+        ofdmflexframesync q = ofdmflexframesync_create(_n, _n/4, 4, NULL, memory_footprint_callback, NULL);
+        num_bytes = ofdmflexframesync_get_memory_usage(q);
+        ofdmflexframesync_destroy(q);
+        } break;
+    default:
+        fprintf(stderr,"error: memory_footprint_run(), invalid object type\n");
+        exit(1);
+    }
+    return num_bytes;
+}
+
+// Helper function to keep code base small
+void memory_footprint_bench(struct rusage *     _start,
+                            struct rusage *     _finish,
+                            unsigned long int * _num_iterations,
+                            int                 _type,
+                            unsigned int        _n)
+{
+    // create/destroy cycles are slow and grow with the object size;
+    // scale trials down
+    *_num_iterations /= 1000*_n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // objects sharing state need a prototype
+    flexframesync proto = NULL;
+    if (_type == MEMORY_FOOTPRINT_FLEXFRAMESYNC_SHARED)
+        proto = flexframesync_create(memory_footprint_callback, NULL);
+
+    unsigned long int num_bytes = 0;
+    unsigned long int i;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        num_bytes = memory_footprint_run(_type, _n, proto);
+    getrusage(RUSAGE_SELF, _finish);
+
+    // print footprint (once per benchmark; the harness calls this
+    // function repeatedly while calibrating and timing)
+    static int          last_type = -1;
+    static unsigned int last_n    = 0;
+    if (_type != last_type || _n != last_n)
+        printf("  footprint: %10lu bytes (%8.1f kB), %10.1f bytes/unit\n",
+            num_bytes, num_bytes/1024.0f, (float)num_bytes / (float)_n);
+    last_type = _type;
+    last_n    = _n;
+
+    if (proto != NULL)
+        flexframesync_destroy(proto);
+}
+
+// firpfbch2_crcf analyzer: number of channels
+void benchmark_memory_footprint_firpfbch2_M16      MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_FIRPFBCH2,              16)
+void benchmark_memory_footprint_firpfbch2_M64      MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_FIRPFBCH2,              64)
+void benchmark_memory_footprint_firpfbch2_M256     MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_FIRPFBCH2,             256)
+void benchmark_memory_footprint_firpfbch2_M1024    MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_FIRPFBCH2,            1024)
+
+// qdetector_cccf: sequence length
+void benchmark_memory_footprint_qdetector_n64      MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_QDETECTOR,              64)
+void benchmark_memory_footprint_qdetector_n256     MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_QDETECTOR,             256)
+void benchmark_memory_footprint_qdetector_n1024    MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_QDETECTOR,            1024)
+
+// flexframesync: independent and sharing detector/matched filter
+void benchmark_memory_footprint_flexframesync      MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_FLEXFRAMESYNC,           1)
+void benchmark_memory_footprint_flexframesync_shared MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_FLEXFRAMESYNC_SHARED,  1)
+
+// ofdmflexframesync: number of subcarriers
+void benchmark_memory_footprint_ofdmflexframesync_M64   MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_OFDMFLEXFRAMESYNC,   64)
+void benchmark_memory_footprint_ofdmflexframesync_M256  MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_OFDMFLEXFRAMESYNC,  256)
+void benchmark_memory_footprint_ofdmflexframesync_M1024 MEMORY_FOOTPRINT_BENCH_API(MEMORY_FOOTPRINT_OFDMFLEXFRAMESYNC, 1024)
+
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "liquid.internal.h"
+
+// Helper function to keep code base small
+//  _num_tones  :   number of tone sources
+//  _num_noise  :   number of noise sources
+//  _num_modems :   number of modem sources
+void msourcecf_bench(struct rusage *     _start,
+                     struct rusage *     _finish,
+                     unsigned long int * _num_iterations,
+                     unsigned int        _num_tones,
+                     unsigned int        _num_noise,
+                     unsigned int        _num_modems)
+{
+    // adjust number of iterations
+    unsigned int num_sources = _num_tones + _num_noise + _num_modems;
+    *_num_iterations /= num_sources;
+
+    // create source and add signals
+    msourcecf q = msourcecf_create();
+    unsigned int i;
+    for (i=0; i<_num_tones; i++)
+        msourcecf_set_frequency(q, msourcecf_add_tone(q), 0.1f*i - 0.3f);
+    for (i=0; i<_num_noise; i++)
+        msourcecf_set_frequency(q, msourcecf_add_noise(q, 0.1f), 0.2f*i + 0.1f);
+    for (i=0; i<_num_modems; i++)
+        msourcecf_set_frequency(q, msourcecf_add_modem(q, LIQUID_MODEM_QPSK, 2, 7, 0.3f), 0.2f*i - 0.5f);
+
+    unsigned int  buf_len = 2048;
+    float complex buf[buf_len];
+
+    // start trials
+    unsigned long int n;
+    getrusage(RUSAGE_SELF, _start);
+    for (n=0; n<(*_num_iterations); n+=buf_len)
+        msourcecf_write_samples(q, buf, buf_len);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = n;
+
+    // clean up allocated objects
+    msourcecf_destroy(q);
+}
+
+#define MSOURCECF_BENCHMARK_API(T,N,M)      \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ msourcecf_bench(_start, _finish, _num_iterations, T, N, M); }
+
+void benchmark_msourcecf_tone       MSOURCECF_BENCHMARK_API(1, 0, 0);
+void benchmark_msourcecf_noise      MSOURCECF_BENCHMARK_API(0, 1, 0);
+void benchmark_msourcecf_modem      MSOURCECF_BENCHMARK_API(0, 0, 1);
+void benchmark_msourcecf_mix_1_2_2  MSOURCECF_BENCHMARK_API(1, 2, 2);
+
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "liquid.internal.h"
+
+// Helper function to keep code base small
+//  _ms     :   modulation scheme
+void symtrack_cccf_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         int                 _ms)
+{
+    // adjust number of iterations
+    *_num_iterations /= 4;
+
+    // generate input stream
+    unsigned int  buf_len = 2048;
+    float complex x[buf_len];
+    float complex y[buf_len];
+    symstreamcf ss = symstreamcf_create_linear(LIQUID_FIRFILT_ARKAISER, 2, 7, 0.3f, _ms);
+    symstreamcf_write_samples(ss, x, buf_len);
+    symstreamcf_destroy(ss);
+
+    symtrack_cccf q = symtrack_cccf_create(LIQUID_FIRFILT_ARKAISER, 2, 7, 0.3f, _ms);
+    unsigned int ny;
+
+    // start trials
+    unsigned long int n;
+    getrusage(RUSAGE_SELF, _start);
+    for (n=0; n<(*_num_iterations); n+=buf_len)
+        symtrack_cccf_execute_block(q, x, buf_len, y, &ny);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = n;
+
+    // clean up allocated objects
+    symtrack_cccf_destroy(q);
+}
+
+#define SYMTRACK_CCCF_BENCHMARK_API(MS)     \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ symtrack_cccf_bench(_start, _finish, _num_iterations, MS); }
+
+void benchmark_symtrack_cccf_qpsk   SYMTRACK_CCCF_BENCHMARK_API(LIQUID_MODEM_QPSK);
+void benchmark_symtrack_cccf_qam16  SYMTRACK_CCCF_BENCHMARK_API(LIQUID_MODEM_QAM16);
+
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// amcselect.c
+//
+// Adaptive modulation and coding selector: tracks the link SNR from
+// received frame statistics and recommends the modulation/coding
+// scheme with the highest expected goodput from packet error rate
+// tables
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// built-in table dimensions; SNR from -4 dB to 36 dB in 1 dB steps
+#define AMCSELECT_DEFAULT_NUM_SCHEMES   (9)
+#define AMCSELECT_DEFAULT_NUM_SNR       (41)
+#define AMCSELECT_DEFAULT_SNR0          (-4.0f)
+#define AMCSELECT_DEFAULT_DSNR          (1.0f)
+
+static const int amcselect_default_ms[AMCSELECT_DEFAULT_NUM_SCHEMES] = {
+    LIQUID_MODEM_BPSK,   LIQUID_MODEM_QPSK,   LIQUID_MODEM_QPSK,
+    LIQUID_MODEM_QAM16,  LIQUID_MODEM_QAM16,  LIQUID_MODEM_QAM64,
+    LIQUID_MODEM_QAM64,  LIQUID_MODEM_QAM256, LIQUID_MODEM_QAM256};
+
+static const int amcselect_default_fec0[AMCSELECT_DEFAULT_NUM_SCHEMES] = {
+    LIQUID_FEC_CONV_V27,    LIQUID_FEC_CONV_V27,    LIQUID_FEC_CONV_V27P34,
+    LIQUID_FEC_CONV_V27,    LIQUID_FEC_CONV_V27P34, LIQUID_FEC_CONV_V27P23,
+    LIQUID_FEC_CONV_V27P56, LIQUID_FEC_CONV_V27P34, LIQUID_FEC_NONE};
+
+// packet error rate of 256-byte payloads with CRC-32 and hard-decision
+// decoding (qpacketmodem) over an AWGN channel, 400 packets per point
+static const float amcselect_default_per[AMCSELECT_DEFAULT_NUM_SCHEMES*AMCSELECT_DEFAULT_NUM_SNR] = {
+    // bpsk, v27
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 0.817f, 0.203f, 0.013f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qpsk, v27
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 0.772f, 0.177f,
+    0.025f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qpsk, v27p34
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    0.998f, 0.760f, 0.240f, 0.035f, 0.002f, 0.002f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qam16, v27
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 0.993f, 0.860f, 0.373f, 0.075f, 0.005f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qam16, v27p34
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 0.930f, 0.485f, 0.142f,
+    0.018f, 0.002f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qam64, v27p23
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 0.985f, 0.695f, 0.198f, 0.032f, 0.005f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qam64, v27p56
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 0.868f, 0.365f, 0.078f, 0.007f, 0.000f, 0.000f,
+    0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qam256, v27p34
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 0.993f, 0.860f,
+    0.428f, 0.123f, 0.027f, 0.005f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f, 0.000f,
+    0.000f,
+    // qam256, none
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f, 1.000f,
+    1.000f, 1.000f, 0.957f, 0.688f, 0.230f, 0.050f, 0.007f, 0.002f, 0.000f, 0.000f,
+    0.000f,
+};
+
+struct amcselect_s {
+    unsigned int   num_schemes; // number of schemes in table
+    int *          ms;          // modulation schemes [size: num_schemes x 1]
+    int *          fec0;        // inner codes [size: num_schemes x 1]
+    int *          fec1;        // outer codes [size: num_schemes x 1]
+    float *        rate;        // information bits/symbol [size: num_schemes x 1]
+    float *        per;         // PER table [size: num_schemes x num_snr]
+    unsigned int   num_snr;     // number of SNR points in table
+    float          snr0;        // SNR of first table column [dB]
+    float          dsnr;        // SNR spacing of table columns [dB]
+
+    float          hysteresis;  // margin required to switch up [dB]
+    float          alpha;       // SNR averaging factor
+    float          snr_hat;     // averaged SNR estimate [dB]
+    unsigned int   num_updates; // number of statistics consumed
+    unsigned int   index;       // selected scheme
+};
+
+// expected goodput of scheme _i at SNR _snr [bits/symbol]
+float amcselect_goodput(amcselect    _q,
+                        unsigned int _i,
+                        float        _snr);
+
+// create selector with built-in table (see liquid.h)
+amcselect amcselect_create()
+{
+    return amcselect_create_table(amcselect_default_ms,
+                                  amcselect_default_fec0,
+                                  NULL,
+                                  AMCSELECT_DEFAULT_NUM_SCHEMES,
+                                  amcselect_default_per,
+                                  AMCSELECT_DEFAULT_NUM_SNR,
+                                  AMCSELECT_DEFAULT_SNR0,
+                                  AMCSELECT_DEFAULT_DSNR);
+}
+
+// create selector from packet error rate table
+//  _ms         :   modulation schemes [size: _num_schemes x 1]
+//  _fec0       :   inner codes [size: _num_schemes x 1], NULL for none
+//  _fec1       :   outer codes [size: _num_schemes x 1], NULL for none
+//  _num_schemes:   number of schemes
+//  _per        :   packet error rates [size: _num_schemes x _num_snr]
+//  _num_snr    :   number of SNR points per scheme
+//  _snr0       :   SNR of first point [dB]
+//  _dsnr       :   SNR spacing of points [dB]
+amcselect amcselect_create_table(const int *   _ms,
+                                 const int *   _fec0,
+                                 const int *   _fec1,
+                                 unsigned int  _num_schemes,
+                                 const float * _per,
+                                 unsigned int  _num_snr,
+                                 float         _snr0,
+                                 float         _dsnr)
+{
+    // validate input
+    if (_num_schemes == 0) {
+        fprintf(stderr,"error: amcselect_create_table(), number of schemes must be greater than zero\n");
+        exit(1);
+    } else if (_num_snr < 2) {
+        fprintf(stderr,"error: amcselect_create_table(), table needs at least two SNR points\n");
+        exit(1);
+    } else if (_dsnr <= 0.0f) {
+        fprintf(stderr,"error: amcselect_create_table(), SNR spacing must be greater than zero\n");
+        exit(1);
+    }
+
+    unsigned int i;
+    for (i=0; i<_num_schemes; i++) {
+        if (_ms[i] == LIQUID_MODEM_UNKNOWN || _ms[i] >= LIQUID_MODEM_NUM_SCHEMES) {
+            fprintf(stderr,"error: amcselect_create_table(), invalid modulation scheme\n");
+            exit(1);
+        } else if ((_fec0 != NULL && (_fec0[i] == LIQUID_FEC_UNKNOWN || _fec0[i] >= LIQUID_FEC_NUM_SCHEMES)) ||
+                   (_fec1 != NULL && (_fec1[i] == LIQUID_FEC_UNKNOWN || _fec1[i] >= LIQUID_FEC_NUM_SCHEMES))) {
+            fprintf(stderr,"error: amcselect_create_table(), invalid error-correction scheme\n");
+            exit(1);
+        }
+    }
+
+    amcselect q = (amcselect) liquid_malloc(sizeof(struct amcselect_s));
+    q->num_schemes = _num_schemes;
+    q->num_snr     = _num_snr;
+    q->snr0        = _snr0;
+    q->dsnr        = _dsnr;
+
+    // copy table
+    q->ms   = (int*)   liquid_malloc(q->num_schemes*sizeof(int));
+    q->fec0 = (int*)   liquid_malloc(q->num_schemes*sizeof(int));
+    q->fec1 = (int*)   liquid_malloc(q->num_schemes*sizeof(int));
+    q->rate = (float*) liquid_malloc(q->num_schemes*sizeof(float));
+    q->per  = (float*) liquid_malloc(q->num_schemes*q->num_snr*sizeof(float));
+    memmove(q->per, _per, q->num_schemes*q->num_snr*sizeof(float));
+    for (i=0; i<q->num_schemes; i++) {
+        q->ms[i]   = _ms[i];
+        q->fec0[i] = _fec0 == NULL ? LIQUID_FEC_NONE : _fec0[i];
+        q->fec1[i] = _fec1 == NULL ? LIQUID_FEC_NONE : _fec1[i];
+        q->rate[i] = modulation_types[q->ms[i]].bps *
+                     fec_get_rate(q->fec0[i]) *
+                     fec_get_rate(q->fec1[i]);
+    }
+
+    // set default parameters
+    q->hysteresis = 1.0f;
+    q->alpha      = 0.25f;
+
+    // reset and return
+    amcselect_reset(q);
+    return q;
+}
+
+// destroy selector, freeing all internal memory
+void amcselect_destroy(amcselect _q)
+{
+    liquid_free(_q->ms);
+    liquid_free(_q->fec0);
+    liquid_free(_q->fec1);
+    liquid_free(_q->rate);
+    liquid_free(_q->per);
+    liquid_free(_q);
+}
+
+// print selector state
+void amcselect_print(amcselect _q)
+{
+    printf("amcselect [%u schemes, snr: %.2f dB, hysteresis: %.2f dB]:\n",
+            _q->num_schemes, _q->snr_hat, _q->hysteresis);
+    unsigned int i;
+    for (i=0; i<_q->num_schemes; i++) {
+        printf("  %c %2u : %-8s %-8s %-8s rate %5.3f, goodput %5.3f\n",
+                i == _q->index ? '*' : ' ', i,
+                modulation_types[_q->ms[i]].name,
+                fec_scheme_str[_q->fec0[i]][0],
+                fec_scheme_str[_q->fec1[i]][0],
+                _q->rate[i],
+                amcselect_goodput(_q, i, _q->snr_hat));
+    }
+}
+
+// reset selector: forget SNR estimate and fall back to the scheme
+// with the lowest rate
+void amcselect_reset(amcselect _q)
+{
+    _q->snr_hat     = _q->snr0;
+    _q->num_updates = 0;
+
+    unsigned int i;
+    _q->index = 0;
+    for (i=1; i<_q->num_schemes; i++) {
+        if (_q->rate[i] < _q->rate[_q->index])
+            _q->index = i;
+    }
+}
+
+// set margin required before switching to a higher-rate scheme [dB]
+void amcselect_set_hysteresis(amcselect _q,
+                              float     _hysteresis)
+{
+    if (_hysteresis < 0.0f) {
+        fprintf(stderr,"error: amcselect_set_hysteresis(), hysteresis cannot be negative\n");
+        exit(1);
+    }
+    _q->hysteresis = _hysteresis;
+}
+
+// set SNR averaging factor, 0 < _alpha <= 1 (1: no averaging)
+void amcselect_set_alpha(amcselect _q,
+                         float     _alpha)
+{
+    if (_alpha <= 0.0f || _alpha > 1.0f) {
+        fprintf(stderr,"error: amcselect_set_alpha(), averaging factor must be in (0,1]\n");
+        exit(1);
+    }
+    _q->alpha = _alpha;
+}
+
+// update SNR estimate from received frame statistics and re-select
+// scheme; the SNR of a frame is taken as -evm
+void amcselect_push(amcselect        _q,
+                    framesyncstats_s _stats)
+{
+    // synchronizers which do not measure evm report exactly zero
+    if (_stats.evm == 0.0f)
+        return;
+
+    amcselect_push_snr(_q, -_stats.evm);
+}
+
+// update SNR estimate directly and re-select scheme
+//  _q      :   selector object
+//  _snr    :   measured SNR [dB]
+void amcselect_push_snr(amcselect _q,
+                        float     _snr)
+{
+    // update averaged estimate
+    if (_q->num_updates == 0)
+        _q->snr_hat = _snr;
+    else
+        _q->snr_hat += _q->alpha*(_snr - _q->snr_hat);
+    _q->num_updates++;
+
+    // find scheme with the highest expected goodput
+    unsigned int i;
+    unsigned int best = _q->index;
+    float g_best = amcselect_goodput(_q, best, _q->snr_hat);
+    for (i=0; i<_q->num_schemes; i++) {
+        float g = amcselect_goodput(_q, i, _q->snr_hat);
+        if (g > g_best) {
+            best   = i;
+            g_best = g;
+        }
+    }
+    if (best == _q->index)
+        return;
+
+    // switch down right away; switch up only if the new scheme would
+    // still be better with the SNR lowered by the hysteresis margin
+    if (_q->rate[best] > _q->rate[_q->index]) {
+        float snr = _q->snr_hat - _q->hysteresis;
+        if (amcselect_goodput(_q, best, snr) <= amcselect_goodput(_q, _q->index, snr))
+            return;
+    }
+    _q->index = best;
+}
+
+// get averaged SNR estimate [dB]
+float amcselect_get_snr(amcselect _q)
+{
+    return _q->snr_hat;
+}
+
+// get index of selected scheme in table
+unsigned int amcselect_get_index(amcselect _q)
+{
+    return _q->index;
+}
+
+// get selected scheme
+//  _q      :   selector object
+//  _ms     :   modulation scheme
+//  _fec0   :   inner error-correction scheme
+//  _fec1   :   outer error-correction scheme
+void amcselect_get_scheme(amcselect _q,
+                          int *     _ms,
+                          int *     _fec0,
+                          int *     _fec1)
+{
+    *_ms   = _q->ms  [_q->index];
+    *_fec0 = _q->fec0[_q->index];
+    *_fec1 = _q->fec1[_q->index];
+}
+
+// get expected goodput of selected scheme at the current SNR
+// estimate [information bits/symbol]
+float amcselect_get_goodput(amcselect _q)
+{
+    return amcselect_goodput(_q, _q->index, _q->snr_hat);
+}
+
+// get packet error rate of scheme _i at SNR _snr, interpolating
+// linearly between table points and clamping to the table edges
+//  _q      :   selector object
+//  _i      :   scheme index
+//  _snr    :   SNR [dB]
+float amcselect_get_per(amcselect    _q,
+                        unsigned int _i,
+                        float        _snr)
+{
+    if (_i >= _q->num_schemes) {
+        fprintf(stderr,"error: amcselect_get_per(), scheme index (%u) out of range\n", _i);
+        exit(1);
+    }
+    const float * per = &_q->per[_i*_q->num_snr];
+
+    float t = (_snr - _q->snr0) / _q->dsnr;
+    if (t <= 0.0f)
+        return per[0];
+    if (t >= (float)(_q->num_snr-1))
+        return per[_q->num_snr-1];
+
+    unsigned int k = (unsigned int)t;
+    float        f = t - (float)k;
+    return (1.0f-f)*per[k] + f*per[k+1];
+}
+
+//
+// internal methods
+//
+
+// expected goodput of scheme _i at SNR _snr [bits/symbol]
+float amcselect_goodput(amcselect    _q,
+                        unsigned int _i,
+                        float        _snr)
+{
+    return _q->rate[_i] * (1.0f - amcselect_get_per(_q, _i, _snr));
+}
@@ -82,7 +82,7 @@ bpacketgen bpacketgen_create(unsigned int _m,
     // validate input
 
     // create bpacketgen object
-    bpacketgen q = (bpacketgen) malloc(sizeof(struct bpacketgen_s));
+    bpacketgen q = (bpacketgen) liquid_malloc(sizeof(struct bpacketgen_s));
     q->dec_msg_len  = _dec_msg_len;
     q->crc          = _crc;
     q->fec0         = _fec0;
@@ -101,7 +101,7 @@ bpacketgen bpacketgen_create(unsigned int _m,
     bpacketgen_compute_packet_len(q);
 
     // arrays
-    q->pnsequence = (unsigned char*) malloc((q->pnsequence_len)*sizeof(unsigned char));
+    q->pnsequence = (unsigned char*) liquid_malloc((q->pnsequence_len)*sizeof(unsigned char));
 
     // create m-sequence generator
     // TODO : configure sequence from generator polynomial
@@ -157,7 +157,7 @@ bpacketgen bpacketgen_recreate(bpacketgen _q,
     // arrays
     _q->g = 0;
     _q->pnsequence_len = 8;
-    _q->pnsequence = (unsigned char*) realloc(_q->pnsequence, (_q->pnsequence_len)*sizeof(unsigned char));
+    _q->pnsequence = (unsigned char*) liquid_realloc(_q->pnsequence, (_q->pnsequence_len)*sizeof(unsigned char));
 
     // re-create m-sequence generator
     // TODO : configure sequence from generator polynomial
@@ -182,7 +182,7 @@ bpacketgen bpacketgen_recreate(bpacketgen _q,
 void bpacketgen_destroy(bpacketgen _q)
 {
     // free arrays
-    free(_q->pnsequence);
+    liquid_free(_q->pnsequence);
 
     // destroy internal objects
     msequence_destroy(_q->ms);
@@ -190,7 +190,7 @@ void bpacketgen_destroy(bpacketgen _q)
     packetizer_destroy(_q->p_payload);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print bpacketgen internals
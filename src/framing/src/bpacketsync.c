@@ -69,8 +69,8 @@ struct bpacketsync_s {
     msequence ms;
     packetizer p_header;
     packetizer p_payload;
-    bsequence bpn;          // binary p/n sequence
-    bsequence brx;          // binary received sequence
+    uint64_t bpn;           // binary p/n sequence (8 bytes, packed)
+    uint64_t brx;           // binary received sequence (last 64 bits)
 
     // status variables
     enum {
@@ -100,7 +100,7 @@ bpacketsync bpacketsync_create(unsigned int _m,
                                void * _userdata)
 {
     // create bpacketsync object
-    bpacketsync q = (bpacketsync) malloc(sizeof(struct bpacketsync_s));
+    bpacketsync q = (bpacketsync) liquid_malloc(sizeof(struct bpacketsync_s));
     q->callback = _callback;
     q->userdata = _userdata;
 
@@ -122,9 +122,9 @@ bpacketsync bpacketsync_create(unsigned int _m,
     q->header_len = packetizer_compute_enc_msg_len(6, LIQUID_CRC_16, LIQUID_FEC_NONE, LIQUID_FEC_HAMMING128);
 
     // arrays
-    q->pnsequence  = (unsigned char*) malloc((q->pnsequence_len)*sizeof(unsigned char));
-    q->payload_enc = (unsigned char*) malloc((q->enc_msg_len)*sizeof(unsigned char));
-    q->payload_dec = (unsigned char*) malloc((q->dec_msg_len)*sizeof(unsigned char));
+    q->pnsequence  = (unsigned char*) liquid_malloc((q->pnsequence_len)*sizeof(unsigned char));
+    q->payload_enc = (unsigned char*) liquid_malloc((q->enc_msg_len)*sizeof(unsigned char));
+    q->payload_dec = (unsigned char*) liquid_malloc((q->dec_msg_len)*sizeof(unsigned char));
 
     // create m-sequence generator
     // TODO : configure sequence from generator polynomial
@@ -140,9 +140,8 @@ bpacketsync bpacketsync_create(unsigned int _m,
                                      q->fec0,
                                      q->fec1);
 
-    // create binary sequence objects
-    q->bpn = bsequence_create(q->pnsequence_len*8);
-    q->brx = bsequence_create(q->pnsequence_len*8);
+    // p/n sequence is held in a single 64-bit register
+    assert(q->pnsequence_len == 8);
 
     // assemble semi-static framing structures
     bpacketsync_assemble_pnsequence(q);
@@ -156,19 +155,17 @@ bpacketsync bpacketsync_create(unsigned int _m,
 void bpacketsync_destroy(bpacketsync _q)
 {
     // free arrays
-    free(_q->pnsequence);
-    free(_q->payload_enc);
-    free(_q->payload_dec);
+    liquid_free(_q->pnsequence);
+    liquid_free(_q->payload_enc);
+    liquid_free(_q->payload_dec);
 
     // destroy internal objects
     msequence_destroy(_q->ms);
     packetizer_destroy(_q->p_header);
     packetizer_destroy(_q->p_payload);
-    bsequence_destroy(_q->bpn);
-    bsequence_destroy(_q->brx);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void bpacketsync_print(bpacketsync _q)
@@ -188,7 +185,7 @@ void bpacketsync_print(bpacketsync _q)
 void bpacketsync_reset(bpacketsync _q)
 {
     // clear received sequence buffer
-    bsequence_clear(_q->brx);
+    _q->brx = 0;
 
     // reset counters
     _q->num_bytes_received  = 0;
@@ -220,6 +217,23 @@ void bpacketsync_execute_byte(bpacketsync _q,
                               unsigned char _byte)
 {
     unsigned int j;
+
+    // while seeking, test all eight alignments of the byte against
+    // the p/n sequence at once and only drop to the bit path on a hit
+    if (_q->state == BPACKETSYNC_STATE_SEEKPN) {
+        for (j=0; j<8; j++) {
+            uint64_t brx = (_q->brx << (j+1)) | (_byte >> (8-j-1));
+            if ( fabsf(bpacketsync_correlate_pn(_q, brx)) > 0.8f )
+                break;
+        }
+
+        if (j == 8) {
+            // no alignment triggered; advance register by full byte
+            _q->brx = (_q->brx << 8) | _byte;
+            return;
+        }
+    }
+
     for (j=0; j<8; j++) {
         // strip bit from byte
         unsigned char bit = (_byte >> (8-j-1)) & 1;
@@ -288,19 +302,28 @@ void bpacketsync_assemble_pnsequence(bpacketsync _q)
     msequence_reset(_q->ms);
 
     unsigned int i;
+    _q->bpn = 0;
     for (i=0; i<8*_q->pnsequence_len; i++)
-        bsequence_push(_q->bpn, msequence_advance(_q->ms));
+        _q->bpn = (_q->bpn << 1) | msequence_advance(_q->ms);
+}
+
+// normalized p/n sequence correlation of received register _brx:
+// (#agreements - #disagreements) / 64
+float bpacketsync_correlate_pn(bpacketsync _q,
+                               uint64_t    _brx)
+{
+    unsigned int d = liquid_count_ones_uint64(_brx ^ _q->bpn);
+    return 1.0f - 2.0f*(float)d / (float)(_q->pnsequence_len*8);
 }
 
 void bpacketsync_execute_seekpn(bpacketsync _q,
                                 unsigned char _bit)
 {
     // push bit into correlator
-    bsequence_push(_q->brx, _bit);
+    _q->brx = (_q->brx << 1) | _bit;
 
     // compute p/n sequence correlation
-    int rxy = bsequence_correlate(_q->bpn, _q->brx);
-    float r = 2.0f*(float)rxy / (float)(_q->pnsequence_len*8) - 1.0f;
+    float r = bpacketsync_correlate_pn(_q, _q->brx);
 
     // check threshold
     if ( fabsf(r) > 0.8f ) {
@@ -446,11 +469,11 @@ void bpacketsync_reconfig(bpacketsync _q)
     _q->enc_msg_len = packetizer_get_enc_msg_len(_q->p_payload);
 
     // re-allocate memory for encoded packet
-    _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
+    _q->payload_enc = (unsigned char*) liquid_realloc(_q->payload_enc,
                                                _q->enc_msg_len*sizeof(unsigned char));
 
     // re-allocate memory for decoded packet
-    _q->payload_dec = (unsigned char*) realloc(_q->payload_dec,
+    _q->payload_dec = (unsigned char*) liquid_realloc(_q->payload_dec,
                                                _q->dec_msg_len*sizeof(unsigned char));
 }
 
@@ -34,19 +34,60 @@
 struct BPRESYNC(_s) {
     unsigned int n;     // sequence length
     unsigned int m;     // number of binary synchronizers
-    
-    bsequence rx_i;     // received pattern (in-phase)
-    bsequence rx_q;     // received pattern (quadrature)
-    
-    float * dphi;       // array of frequency offsets [size: m x 1]
-    bsequence * sync_i; // synchronization pattern (in-phase)
-    bsequence * sync_q; // synchronization pattern (quadrature)
+    unsigned int nw;    // number of 64-bit words per packed sequence
+    uint64_t mask_msb;  // valid bits in most-significant (oldest) word
+
+    uint64_t * rx_i;    // received sign bits (in-phase)    [size: nw x 1]
+    uint64_t * rx_q;    // received sign bits (quadrature)  [size: nw x 1]
 
-    float * rxy;        // output correlation [size: m x 1]
+    float * dphi;       // array of frequency offsets [size: m x 1]
+    uint64_t * sync_i;  // synchronization pattern (in-phase)   [size: m x nw]
+    uint64_t * sync_q;  // synchronization pattern (quadrature) [size: m x nw]
 
     float n_inv;        // 1/n (pre-computed for speed)
 };
 
+// push bit into packed sequence from the right; the oldest bit is
+// the most-significant valid bit of the first word
+static void BPRESYNC(_pushbit)(BPRESYNC()   _q,
+                               uint64_t *   _s,
+                               unsigned int _bit)
+{
+    unsigned int i;
+    for (i=0; i<_q->nw-1; i++)
+        _s[i] = (_s[i] << 1) | (_s[i+1] >> 63);
+    _s[_q->nw-1] = (_s[_q->nw-1] << 1) | (_bit & 1);
+    _s[0] &= _q->mask_msb;
+}
+
+// compute the four binary correlations for hypothesis _id, each as
+// (#agreements - #disagreements) = n - 2*popcount(x ^ y)
+static void BPRESYNC(_correlate_id)(BPRESYNC()   _q,
+                                    unsigned int _id,
+                                    int *        _rxy_ii,
+                                    int *        _rxy_qq,
+                                    int *        _rxy_iq,
+                                    int *        _rxy_qi)
+{
+    const uint64_t * si = _q->sync_i + _id*_q->nw;
+    const uint64_t * sq = _q->sync_q + _id*_q->nw;
+    unsigned int d_ii = 0;
+    unsigned int d_qq = 0;
+    unsigned int d_iq = 0;
+    unsigned int d_qi = 0;
+    unsigned int k;
+    for (k=0; k<_q->nw; k++) {
+        d_ii += liquid_count_ones_uint64(si[k] ^ _q->rx_i[k]);
+        d_qq += liquid_count_ones_uint64(sq[k] ^ _q->rx_q[k]);
+        d_iq += liquid_count_ones_uint64(si[k] ^ _q->rx_q[k]);
+        d_qi += liquid_count_ones_uint64(sq[k] ^ _q->rx_i[k]);
+    }
+    *_rxy_ii = (int)(_q->n) - 2*(int)d_ii;
+    *_rxy_qq = (int)(_q->n) - 2*(int)d_qq;
+    *_rxy_iq = (int)(_q->n) - 2*(int)d_iq;
+    *_rxy_qi = (int)(_q->n) - 2*(int)d_qi;
+}
+
 /* create binary pre-demod synchronizer                     */
 /*  _v          :   baseband sequence                       */
 /*  _n          :   baseband sequence length                */
@@ -67,43 +108,41 @@ BPRESYNC() BPRESYNC(_create)(TC *         _v,
     }
 
     // allocate main object memory and initialize
-    BPRESYNC() _q = (BPRESYNC()) malloc(sizeof(struct BPRESYNC(_s)));
+    BPRESYNC() _q = (BPRESYNC()) liquid_malloc(sizeof(struct BPRESYNC(_s)));
     _q->n = _n;
     _q->m = _m;
 
     _q->n_inv = 1.0f / (float)(_q->n);
 
+    // packed sign-bit layout
+    _q->nw = (_q->n + 63) / 64;
+    unsigned int r = _q->n % 64;
+    _q->mask_msb = r == 0 ? ~(uint64_t)0 : (((uint64_t)1 << r) - 1);
+
     unsigned int i;
 
     // create internal receive buffers
-    _q->rx_i = bsequence_create(_q->n);
-    _q->rx_q = bsequence_create(_q->n);
+    _q->rx_i = (uint64_t*) liquid_calloc(_q->nw, sizeof(uint64_t));
+    _q->rx_q = (uint64_t*) liquid_calloc(_q->nw, sizeof(uint64_t));
 
     // create internal array of frequency offsets
-    _q->dphi = (float*) malloc( _q->m*sizeof(float) );
+    _q->dphi = (float*) liquid_malloc( _q->m*sizeof(float) );
 
     // create internal synchronizers
-    _q->sync_i = (bsequence*) malloc( _q->m*sizeof(bsequence) );
-    _q->sync_q = (bsequence*) malloc( _q->m*sizeof(bsequence) );
+    _q->sync_i = (uint64_t*) liquid_calloc(_q->m*_q->nw, sizeof(uint64_t));
+    _q->sync_q = (uint64_t*) liquid_calloc(_q->m*_q->nw, sizeof(uint64_t));
 
     for (i=0; i<_q->m; i++) {
-
-        _q->sync_i[i] = bsequence_create(_q->n);
-        _q->sync_q[i] = bsequence_create(_q->n);
-
         // generate signal with frequency offset
         _q->dphi[i] = (float)i / (float)(_q->m-1)*_dphi_max;
         unsigned int k;
         for (k=0; k<_q->n; k++) {
             TC v_prime = _v[k] * cexpf(-_Complex_I*k*_q->dphi[i]);
-            bsequence_push(_q->sync_i[i], crealf(v_prime)>0);
-            bsequence_push(_q->sync_q[i], cimagf(v_prime)>0);
+            BPRESYNC(_pushbit)(_q, _q->sync_i + i*_q->nw, crealf(v_prime)>0);
+            BPRESYNC(_pushbit)(_q, _q->sync_q + i*_q->nw, cimagf(v_prime)>0);
         }
     }
 
-    // allocate memory for cross-correlation
-    _q->rxy = (float*) malloc( _q->m*sizeof(float) );
-
     // reset object
     BPRESYNC(_reset)(_q);
 
@@ -112,28 +151,19 @@ BPRESYNC() BPRESYNC(_create)(TC *         _v,
 
 void BPRESYNC(_destroy)(BPRESYNC() _q)
 {
-    unsigned int i;
-
     // free received symbol buffers
-    free(_q->rx_i);
-    free(_q->rx_q);
+    liquid_free(_q->rx_i);
+    liquid_free(_q->rx_q);
 
-    // free internal syncrhonizer objects
-    for (i=0; i<_q->m; i++) {
-        bsequence_destroy(_q->sync_i[i]);
-        bsequence_destroy(_q->sync_q[i]);
-    }
-    free(_q->sync_i);
-    free(_q->sync_q);
+    // free internal syncrhonizer patterns
+    liquid_free(_q->sync_i);
+    liquid_free(_q->sync_q);
 
     // free internal frequency offset array
-    free(_q->dphi);
-
-    // free internal cross-correlation array
-    free(_q->rxy);
+    liquid_free(_q->dphi);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void BPRESYNC(_print)(BPRESYNC() _q)
@@ -145,8 +175,8 @@ void BPRESYNC(_reset)(BPRESYNC() _q)
 {
     unsigned int i;
     for (i=0; i<_q->n; i++) {
-        bsequence_push(_q->rx_i, (i+0) % 2);
-        bsequence_push(_q->rx_q, (i+1) % 2);
+        BPRESYNC(_pushbit)(_q, _q->rx_i, (i+0) % 2);
+        BPRESYNC(_pushbit)(_q, _q->rx_q, (i+1) % 2);
     }
 }
 
@@ -165,10 +195,8 @@ void BPRESYNC(_correlatex)(BPRESYNC()      _q,
     }
 
     // compute correlations
-    int rxy_ii = 2*bsequence_correlate(_q->sync_i[_id], _q->rx_i) - (int)(_q->n);
-    int rxy_qq = 2*bsequence_correlate(_q->sync_q[_id], _q->rx_q) - (int)(_q->n);
-    int rxy_iq = 2*bsequence_correlate(_q->sync_i[_id], _q->rx_q) - (int)(_q->n);
-    int rxy_qi = 2*bsequence_correlate(_q->sync_q[_id], _q->rx_i) - (int)(_q->n);
+    int rxy_ii, rxy_qq, rxy_iq, rxy_qi;
+    BPRESYNC(_correlate_id)(_q, _id, &rxy_ii, &rxy_qq, &rxy_iq, &rxy_qi);
 
     // non-conjugated
     int rxy_i0 = rxy_ii - rxy_qq;
@@ -188,8 +216,41 @@ void BPRESYNC(_push)(BPRESYNC() _q,
                      TI         _x)
 {
     // push symbol into buffers
-    bsequence_push(_q->rx_i, REAL(_x)>0);
-    bsequence_push(_q->rx_q, IMAG(_x)>0);
+    BPRESYNC(_pushbit)(_q, _q->rx_i, REAL(_x)>0);
+    BPRESYNC(_pushbit)(_q, _q->rx_q, IMAG(_x)>0);
+}
+
+// search all frequency hypotheses on the packed sign bits alone,
+// comparing squared integer magnitudes; returns the index of the
+// strongest hypothesis and sets _conj if its conjugated product won
+unsigned int BPRESYNC(_search)(BPRESYNC() _q,
+                               int *      _conj)
+{
+    unsigned int i;
+    unsigned int i_max = 0;
+    int conj = 0;
+    long int e_max = 0;
+    for (i=0; i<_q->m; i++)  {
+        int rxy_ii, rxy_qq, rxy_iq, rxy_qi;
+        BPRESYNC(_correlate_id)(_q, i, &rxy_ii, &rxy_qq, &rxy_iq, &rxy_qi);
+
+        // non-conjugated
+        long int i0 = rxy_ii - rxy_qq;
+        long int q0 = rxy_iq + rxy_qi;
+        long int e0 = i0*i0 + q0*q0;
+
+        // conjugated
+        long int i1 = rxy_ii + rxy_qq;
+        long int q1 = rxy_iq - rxy_qi;
+        long int e1 = i1*i1 + q1*q1;
+
+        if (e0 > e_max) { e_max = e0; i_max = i; conj = 0; }
+        if (e1 > e_max) { e_max = e1; i_max = i; conj = 1; }
+    }
+
+    if (_conj != NULL)
+        *_conj = conj;
+    return i_max;
 }
 
 /* correlate input sequence                                 */
@@ -200,32 +261,13 @@ void BPRESYNC(_correlate)(BPRESYNC() _q,
                           TO *       _rxy,
                           float *    _dphi_hat)
 {
-    unsigned int i;
-    float complex rxy_max = 0;  // maximum cross-correlation
-    float abs_rxy_max = 0;      // absolute value of rxy_max
+    int conj = 0;
+    unsigned int i = BPRESYNC(_search)(_q, &conj);
+
     float complex rxy0;
     float complex rxy1;
-    float dphi_hat = 0.0f;
-    for (i=0; i<_q->m; i++)  {
-
-        BPRESYNC(_correlatex)(_q, i, &rxy0, &rxy1);
-
-        // check non-conjugated value
-        if ( ABS(rxy0) > abs_rxy_max ) {
-            rxy_max     = rxy0;
-            abs_rxy_max = ABS(rxy0);
-            dphi_hat    = _q->dphi[i];
-        }
+    BPRESYNC(_correlatex)(_q, i, &rxy0, &rxy1);
 
-        // check conjugated value
-        if ( ABS(rxy1) > abs_rxy_max ) {
-            rxy_max     = rxy1;
-            abs_rxy_max = ABS(rxy1);
-            dphi_hat    = -_q->dphi[i];
-        }
-    }
-
-    *_rxy      = rxy_max;
-    *_dphi_hat = dphi_hat;
+    *_rxy      = conj ? rxy1 : rxy0;
+    *_dphi_hat = conj ? -_q->dphi[i] : _q->dphi[i];
 }
-
@@ -48,7 +48,7 @@ struct BSYNC(_s) {
 
 BSYNC() BSYNC(_create)(unsigned int _n, TC * _v)
 {
-    BSYNC() fs = (BSYNC()) malloc(sizeof(struct BSYNC(_s)));
+    BSYNC() fs = (BSYNC()) liquid_malloc(sizeof(struct BSYNC(_s)));
     fs->n = _n;
 
     fs->sync_i  = bsequence_create(fs->n);
@@ -86,7 +86,7 @@ BSYNC() BSYNC(_create_msequence)(unsigned int _g,
     // create/initialize msequence
     msequence ms = msequence_create(m, _g, 1);
 
-    BSYNC() fs = (BSYNC()) malloc(sizeof(struct BSYNC(_s)));
+    BSYNC() fs = (BSYNC()) liquid_malloc(sizeof(struct BSYNC(_s)));
     unsigned int n = msequence_get_length(ms);
 
     fs->sync_i  = bsequence_create(n * _k);
@@ -140,7 +140,7 @@ void BSYNC(_destroy)(BSYNC() _fs)
 #ifdef TI_COMPLEX
     bsequence_destroy(_fs->sym_q);
 #endif
-    free(_fs);
+    liquid_free(_fs);
 }
 
 void BSYNC(_print)(BSYNC() _fs)
@@ -39,6 +39,10 @@
 #define DEBUG_DETECTOR_BUFFER_LEN   (1600)
 #define DEBUG_DETECTOR_FILENAME     "detector_cccf_debug.m"
 
+// energy gate noise floor: median of sequence-length block levels
+// over an effective memory of this many blocks
+#define DETECTOR_GATE_MEMORY        (32)
+
 // 
 // internal method declarations
 //
@@ -86,6 +90,14 @@ struct detector_cccf_s {
     float x2_sum;           // sum{ |x|^2 }
     float x2_hat;           // estimate of E{|x|^2}
 
+    // energy gate
+    int gate_enabled;           // bypass correlation on low energy?
+    float gate_threshold;       // gate threshold above noise floor [dB]
+    float gate_level;           // gate level, E{|x|^2} (zero if unset)
+    noisefloor gate_floor;      // noise floor estimate of block E{|x|^2}
+    unsigned int gate_counter;  // samples in current block
+    unsigned int num_skipped;   // correlations bypassed by gate
+
     // counters/states
     enum {
         DETECTOR_STATE_SEEK=0,  // seek sequence
@@ -120,7 +132,7 @@ detector_cccf detector_cccf_create(float complex * _s,
     }
     
     // allocate memory for main object
-    detector_cccf q = (detector_cccf) malloc(sizeof(struct detector_cccf_s));
+    detector_cccf q = (detector_cccf) liquid_malloc(sizeof(struct detector_cccf_s));
     unsigned int i;
 
     // set internal properties
@@ -143,7 +155,7 @@ detector_cccf detector_cccf_create(float complex * _s,
     q->dphi_max = q->m * q->dphi_step;
 
     // allocate memory for sequence and copy
-    q->s = (float complex*) malloc((q->n)*sizeof(float complex));
+    q->s = (float complex*) liquid_malloc((q->n)*sizeof(float complex));
     memmove(q->s, _s, q->n*sizeof(float complex));
 
     // create internal buffer
@@ -151,11 +163,11 @@ detector_cccf detector_cccf_create(float complex * _s,
     q->x2     = wdelayf_create(q->n);
 
     // create internal correlators (dot products)
-    q->dp   = (dotprod_cccf*) malloc((q->m)*sizeof(dotprod_cccf));
-    q->dphi = (float*)        malloc((q->m)*sizeof(float));
-    q->rxy0 = (float*)        malloc((q->m)*sizeof(float));
-    q->rxy1 = (float*)        malloc((q->m)*sizeof(float));
-    q->rxy  = (float*)        malloc((q->m)*sizeof(float));
+    q->dp   = (dotprod_cccf*) liquid_malloc((q->m)*sizeof(dotprod_cccf));
+    q->dphi = (float*)        liquid_malloc((q->m)*sizeof(float));
+    q->rxy0 = (float*)        liquid_malloc((q->m)*sizeof(float));
+    q->rxy1 = (float*)        liquid_malloc((q->m)*sizeof(float));
+    q->rxy  = (float*)        liquid_malloc((q->m)*sizeof(float));
     unsigned int k;
     float complex sconj[q->n];
     for (k=0; k<q->m; k++) {
@@ -166,6 +178,13 @@ detector_cccf detector_cccf_create(float complex * _s,
         q->dp[k] = dotprod_cccf_create(sconj, q->n);
     }
 
+    // energy gate (disabled by default)
+    q->gate_enabled   = 0;
+    q->gate_threshold = 2.0f;
+    q->gate_level     = 0.0f;
+    q->gate_floor     = noisefloor_create(0.5f, DETECTOR_GATE_MEMORY);
+    q->num_skipped    = 0;
+
     // reset state
     detector_cccf_reset(q);
 
@@ -193,20 +212,21 @@ void detector_cccf_destroy(detector_cccf _q)
     unsigned int k;
     for (k=0; k<_q->m; k++)
         dotprod_cccf_destroy(_q->dp[k]);
-    free(_q->dp);
-    free(_q->dphi);
-    free(_q->rxy);
-    free(_q->rxy0);
-    free(_q->rxy1);
+    liquid_free(_q->dp);
+    liquid_free(_q->dphi);
+    liquid_free(_q->rxy);
+    liquid_free(_q->rxy0);
+    liquid_free(_q->rxy1);
 
-    // destroy |x|^2 buffer
+    // destroy |x|^2 buffer and noise floor estimator
     wdelayf_destroy(_q->x2);
+    noisefloor_destroy(_q->gate_floor);
 
     // free internal buffers/arrays
-    free(_q->s);
+    liquid_free(_q->s);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void detector_cccf_print(detector_cccf _q)
@@ -216,6 +236,11 @@ void detector_cccf_print(detector_cccf _q)
     printf("    threshold           :   %8.4f\n", _q->threshold);
     printf("    maximum carrier     :   %8.4f rad/sample\n", _q->dphi_max);
     printf("    num. correlators    :   %u\n", _q->m);
+    if (_q->gate_enabled) {
+        printf("    energy gate         :   %.2f dB (noise floor %.2f dB)\n",
+                _q->gate_threshold, detector_cccf_gate_get_noise_floor(_q));
+        printf("    skipped             :   %u\n", _q->num_skipped);
+    }
 }
 
 void detector_cccf_reset(detector_cccf _q)
@@ -230,6 +255,7 @@ void detector_cccf_reset(detector_cccf _q)
     _q->imax    = 0;                    // index of maximum rxy value
     _q->idetect = 0;                    // index of detected maximum
     _q->x2_sum  = 0.0f;                 // sum{ |x|^2 }
+    _q->gate_counter = 0;               // samples in gate block
     
     // clear cross-correlator outputs
     //memset(_q->rxy, 0x00, sizeof(_q->rxy));
@@ -256,6 +282,15 @@ int detector_cccf_correlate(detector_cccf _q,
     // update sum{|x|^2}
     detector_cccf_update_sumsq(_q, _x);
 
+    // update gate noise floor once every n samples, when E{|x|^2}
+    // covers a non-overlapping block
+    if (_q->gate_enabled && ++_q->gate_counter == _q->n) {
+        _q->gate_counter = 0;
+        noisefloor_push(_q->gate_floor, _q->x2_hat);
+        _q->gate_level = powf(10.0f, _q->gate_threshold/10.0f) *
+                         noisefloor_get_level(_q->gate_floor);
+    }
+
 #if DEBUG_DETECTOR
     windowcf_push(_q->debug_x, _x);
     windowf_push(_q->debug_x2, _q->x2_hat);
@@ -275,6 +310,18 @@ int detector_cccf_correlate(detector_cccf _q,
     memmove(_q->rxy0, _q->rxy1, _q->m*sizeof(float));
     memmove(_q->rxy1, _q->rxy,  _q->m*sizeof(float));
 
+    // bypass correlation while seeking if energy gate is closed
+    if (_q->gate_enabled && _q->state == DETECTOR_STATE_SEEK &&
+        _q->x2_hat <= _q->gate_level)
+    {
+        _q->num_skipped++;
+        memset(_q->rxy, 0x00, _q->m*sizeof(float));
+#if DEBUG_DETECTOR
+        windowf_push(_q->debug_rxy, 0.0f);
+#endif
+        return 0;
+    }
+
     // compute vector dot products
     detector_cccf_compute_dotprods(_q);
 
@@ -329,6 +376,66 @@ int detector_cccf_correlate(detector_cccf _q,
     return 0;
 }
 
+// enable energy gate; correlation is bypassed while seeking until the
+// input energy rises above the adaptive noise floor estimate
+void detector_cccf_gate_enable(detector_cccf _q)
+{
+    // restart noise floor estimate
+    if (!_q->gate_enabled) {
+        noisefloor_reset(_q->gate_floor);
+        _q->gate_level   = 0.0f;
+        _q->gate_counter = 0;
+    }
+
+    _q->gate_enabled = 1;
+}
+
+// disable energy gate
+void detector_cccf_gate_disable(detector_cccf _q)
+{
+    _q->gate_enabled = 0;
+}
+
+// is energy gate enabled?
+int detector_cccf_gate_is_enabled(detector_cccf _q)
+{
+    return _q->gate_enabled;
+}
+
+// set energy gate threshold above noise floor [dB]
+void detector_cccf_gate_set_threshold(detector_cccf _q,
+                                      float         _threshold)
+{
+    if (_threshold < 0.0f) {
+        fprintf(stderr,"warning: gate threshold (%12.4e) out of range; ignoring\n", _threshold);
+        return;
+    }
+
+    _q->gate_threshold = _threshold;
+}
+
+// get energy gate threshold above noise floor [dB]
+float detector_cccf_gate_get_threshold(detector_cccf _q)
+{
+    return _q->gate_threshold;
+}
+
+// get noise floor estimate, E{|x|^2} [dB]
+float detector_cccf_gate_get_noise_floor(detector_cccf _q)
+{
+    // not yet estimated
+    if (noisefloor_get_num_blocks(_q->gate_floor) == 0)
+        return -1e6f;
+
+    return 10.0f*log10f(noisefloor_get_level(_q->gate_floor) + 1e-36f);
+}
+
+// number of correlations bypassed by energy gate
+unsigned int detector_cccf_gate_get_num_skipped(detector_cccf _q)
+{
+    return _q->num_skipped;
+}
+
 // 
 // internal methods
 //
@@ -40,10 +40,14 @@
 // reconfigure internal properties
 void          flexframegen_reconfigure      (flexframegen _q);
 float complex flexframegen_generate_symbol  (flexframegen _q);
-float complex flexframegen_generate_preamble(flexframegen _q);
+void          flexframegen_write_preamble   (flexframegen _q, float complex * _y, unsigned int _n);
+void          flexframegen_write_symbol     (flexframegen _q, float complex * _y);
 float complex flexframegen_generate_header  (flexframegen _q);
 float complex flexframegen_generate_payload (flexframegen _q);
 float complex flexframegen_generate_tail    (flexframegen _q);
+void          flexframegen_pack_header      (flexframegen _q, unsigned char * _header, unsigned int _payload_dec_len);
+void          flexframegen_batch_encode     (void * _q, unsigned int _index);
+void          flexframegen_batch_next       (flexframegen _q);
 
 // default flexframegen properties
 static flexframegenprops_s flexframegenprops_default = {
@@ -70,6 +74,7 @@ struct flexframegen_s {
 
     // preamble
     float complex * preamble_pn;        // p/n sequence
+    float complex * preamble_samples;   // interpolated p/n sequence [size: 64*k x 1]
 
     // header
     unsigned char * header;             // header data
@@ -97,11 +102,32 @@ struct flexframegen_s {
                     STATE_PAYLOAD,      // write payload symbols
                     STATE_TAIL,         // tail symbols
     }               state;              // write state
+
+    // batch assembly
+    unsigned int    batch_num_frames;   // number of frames in batch (0 if none)
+    unsigned int    batch_index;        // index of frame being written
+    unsigned char ** batch_headers;     // user-defined headers [batch_num_frames]
+    unsigned char ** batch_payloads;    // payloads [batch_num_frames]
+    unsigned int *  batch_payload_lens; // payload lengths [batch_num_frames]
+    unsigned int    batch_gap_len;      // zero-valued samples between frames
+    unsigned int    batch_gap_counter;  // gap samples written
+
+    // next frame of batch, encoded in background (allocated on first batch)
+    framegen_lookahead lookahead;       // background encoder
+    unsigned char * next_header;        // header data
+    qpacketmodem    next_header_encoder;// header encoder/modulator
+    float complex * next_header_mod;    // header symbols (encoded/modulated)
+    qpilotgen       next_header_pilotgen;// header pilot symbol generator
+    float complex * next_header_sym;    // header symbols (pilots added)
+    unsigned int    next_payload_dec_len;// length of decoded payload
+    qpacketmodem    next_payload_encoder;// payload encoder/modulator
+    unsigned int    next_payload_sym_len;// length of encoded/modulated payload
+    float complex * next_payload_sym;   // encoded payload symbols
 };
 
 flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
 {
-    flexframegen q = (flexframegen) malloc(sizeof(struct flexframegen_s));
+    flexframegen q = (flexframegen) liquid_malloc(sizeof(struct flexframegen_s));
     unsigned int i;
 
     // create pulse-shaping filter
@@ -111,7 +137,7 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
     q->interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_ARKAISER,q->k,q->m,q->beta,0);
 
     // generate pn sequence
-    q->preamble_pn = (float complex *) malloc(64*sizeof(float complex));
+    q->preamble_pn = (float complex *) liquid_malloc(64*sizeof(float complex));
     msequence ms = msequence_create(7, 0x0089, 1);
     for (i=0; i<64; i++) {
         q->preamble_pn[i] = (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2) +
@@ -119,8 +145,13 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
     }
     msequence_destroy(ms);
 
+    // render preamble once from reset interpolator state; frames copy it
+    q->preamble_samples = (float complex *) liquid_malloc(64*q->k*sizeof(float complex));
+    for (i=0; i<64; i++)
+        firinterp_crcf_execute(q->interp, q->preamble_pn[i], &q->preamble_samples[i*q->k]);
+
     // create header encoder/modulator
-    q->header     = (unsigned char *) malloc(FLEXFRAME_H_DEC*sizeof(unsigned char));
+    q->header     = (unsigned char *) liquid_malloc(FLEXFRAME_H_DEC*sizeof(unsigned char));
     q->header_encoder = qpacketmodem_create();
     qpacketmodem_configure(q->header_encoder,
                            FLEXFRAME_H_DEC,
@@ -129,19 +160,26 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
                            FLEXFRAME_H_FEC1,
                            LIQUID_MODEM_QPSK);
     q->header_mod_len = qpacketmodem_get_frame_len(q->header_encoder);
-    q->header_mod     = (float complex *) malloc(q->header_mod_len*sizeof(float complex));
+    q->header_mod     = (float complex *) liquid_malloc(q->header_mod_len*sizeof(float complex));
 
     // create header pilot sequence generator
     q->header_pilotgen = qpilotgen_create(q->header_mod_len, 16);
     q->header_sym_len  = qpilotgen_get_frame_len(q->header_pilotgen);
-    q->header_sym      = (float complex *) malloc(q->header_sym_len*sizeof(float complex));
+    q->header_sym      = (float complex *) liquid_malloc(q->header_sym_len*sizeof(float complex));
     //printf("header: %u bytes > %u mod > %u sym\n", 64, q->header_mod_len, q->header_sym_len);
 
     // payload encoder/modulator (initialize with default parameters to be reconfigured later)
     q->payload_encoder = qpacketmodem_create();
     q->payload_dec_len = 64;
     q->payload_sym_len = qpacketmodem_get_frame_len(q->payload_encoder);
-    q->payload_sym     = (float complex *) malloc( q->payload_sym_len*sizeof(float complex));
+    q->payload_sym     = (float complex *) liquid_malloc( q->payload_sym_len*sizeof(float complex));
+
+    // batch assembly (lookahead objects created on first batch)
+    q->batch_num_frames   = 0;
+    q->batch_headers      = NULL;
+    q->batch_payloads     = NULL;
+    q->batch_payload_lens = NULL;
+    q->lookahead          = NULL;
 
     // reset object
     flexframegen_reset(q);
@@ -155,6 +193,21 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
 
 void flexframegen_destroy(flexframegen _q)
 {
+    // stop background encoder and destroy lookahead objects
+    if (_q->lookahead != NULL) {
+        framegen_lookahead_destroy(_q->lookahead);
+        qpacketmodem_destroy(_q->next_header_encoder);
+        qpilotgen_destroy   (_q->next_header_pilotgen);
+        qpacketmodem_destroy(_q->next_payload_encoder);
+        liquid_free(_q->next_header);
+        liquid_free(_q->next_header_mod);
+        liquid_free(_q->next_header_sym);
+        liquid_free(_q->next_payload_sym);
+    }
+    liquid_free(_q->batch_headers);
+    liquid_free(_q->batch_payloads);
+    liquid_free(_q->batch_payload_lens);
+
     // destroy internal objects
     firinterp_crcf_destroy(_q->interp);
     qpacketmodem_destroy  (_q->header_encoder);
@@ -162,13 +215,15 @@ void flexframegen_destroy(flexframegen _q)
     qpacketmodem_destroy  (_q->payload_encoder);
 
     // free buffers/arrays
-    free(_q->preamble_pn);  // preamble symbols
-    free(_q->header);       // header bytes
-    free(_q->header_mod);   // encoded/modulated header symbols 
-    free(_q->payload_sym);  // encoded/modulated payload symbols
+    liquid_free(_q->preamble_pn);  // preamble symbols
+    liquid_free(_q->preamble_samples); // interpolated preamble
+    liquid_free(_q->header);       // header bytes
+    liquid_free(_q->header_mod);   // encoded/modulated header symbols 
+    liquid_free(_q->header_sym);   // header symbols (pilots added)
+    liquid_free(_q->payload_sym);  // encoded/modulated payload symbols
 
     // destroy frame generator
-    free(_q);
+    liquid_free(_q);
 }
 
 // print flexframegen object internals
@@ -199,12 +254,21 @@ void flexframegen_print(flexframegen _q)
 // reset flexframegen object internals
 void flexframegen_reset(flexframegen _q)
 {
+    // abandon batch, waiting for background encoding to finish
+    if (_q->lookahead != NULL)
+        framegen_lookahead_wait(_q->lookahead);
+    _q->batch_num_frames = 0;
+
     // reset internal counters and state
     _q->symbol_counter  = 0;
     _q->sample_counter  = 0;
     _q->frame_assembled = 0;
     _q->frame_complete  = 0;
     _q->state           = STATE_PREAMBLE;
+
+    // frame starts from a clear interpolator so the preamble matches
+    // its rendered samples
+    firinterp_crcf_reset(_q->interp);
 }
 
 // is frame assembled?
@@ -230,7 +294,7 @@ int flexframegen_setprops(flexframegen          _q,
                           flexframegenprops_s * _props)
 {
     // if frame is already assembled, give warning
-    if (_q->frame_assembled) {
+    if (_q->frame_assembled || _q->batch_num_frames > 0) {
         fprintf(stderr, "warning: flexframegen_setprops(), frame is already assembled; must reset() first\n");
         return -1;
     }
@@ -299,26 +363,8 @@ void flexframegen_assemble(flexframegen          _q,
     // copy user-defined header to internal
     memmove(_q->header, _header, FLEXFRAME_H_USER*sizeof(unsigned char));
 
-    // first several bytes of header are user-defined
-    unsigned int n = FLEXFRAME_H_USER;
-
-    // add FLEXFRAME_PROTOCOL
-    _q->header[n+0] = FLEXFRAME_PROTOCOL;
-
-    // add payload length
-    _q->header[n+1] = (_q->payload_dec_len >> 8) & 0xff;
-    _q->header[n+2] = (_q->payload_dec_len     ) & 0xff;
-
-    // add modulation scheme/depth (pack into single byte)
-    _q->header[n+3]  = (unsigned int)(_q->props.mod_scheme);
-
-    // add CRC, forward error-correction schemes
-    //  CRC     : most-significant  3 bits of [n+4]
-    //  fec0    : least-significant 5 bits of [n+4]
-    //  fec1    : least-significant 5 bits of [n+5]
-    _q->header[n+4]  = (_q->props.check & 0x07) << 5;
-    _q->header[n+4] |= (_q->props.fec0) & 0x1f;
-    _q->header[n+5]  = (_q->props.fec1) & 0x1f;
+    // add protocol and payload description
+    flexframegen_pack_header(_q, _q->header, _q->payload_dec_len);
 
     // encode/modulate header
     qpacketmodem_encode(_q->header_encoder, _q->header, _q->header_mod);
@@ -336,6 +382,68 @@ void flexframegen_assemble(flexframegen          _q,
     _q->frame_assembled = 1;
 }
 
+// assemble a batch of frames, written back to back by write_block()
+// with '_gap_len' zero-valued samples between consecutive frames; each
+// frame is encoded in the background while the previous frame is
+// being written. Header and payload buffers are not copied and must
+// remain valid until the batch has been written
+//  _q              :   frame generator object
+//  _num_frames     :   number of frames in batch
+//  _headers        :   user-defined headers [size: _num_frames x 1]
+//  _payloads       :   payloads [size: _num_frames x 1]
+//  _payload_lens   :   payload lengths [size: _num_frames x 1]
+//  _gap_len        :   number of zero-valued samples between frames
+void flexframegen_assemble_batch(flexframegen     _q,
+                                 unsigned int     _num_frames,
+                                 unsigned char ** _headers,
+                                 unsigned char ** _payloads,
+                                 unsigned int *   _payload_lens,
+                                 unsigned int     _gap_len)
+{
+    if (_num_frames == 0) {
+        fprintf(stderr,"error: flexframegen_assemble_batch(), batch must contain at least one frame\n");
+        exit(1);
+    }
+
+    // assemble first frame directly (resets object, abandoning any batch)
+    flexframegen_assemble(_q, _headers[0], _payloads[0], _payload_lens[0]);
+
+    // create lookahead objects on first use
+    if (_q->lookahead == NULL) {
+        _q->next_header          = (unsigned char *) liquid_malloc(FLEXFRAME_H_DEC*sizeof(unsigned char));
+        _q->next_header_encoder  = qpacketmodem_create();
+        qpacketmodem_configure(_q->next_header_encoder,
+                               FLEXFRAME_H_DEC,
+                               FLEXFRAME_H_CRC,
+                               FLEXFRAME_H_FEC0,
+                               FLEXFRAME_H_FEC1,
+                               LIQUID_MODEM_QPSK);
+        _q->next_header_mod      = (float complex *) liquid_malloc(_q->header_mod_len*sizeof(float complex));
+        _q->next_header_pilotgen = qpilotgen_create(_q->header_mod_len, 16);
+        _q->next_header_sym      = (float complex *) liquid_malloc(_q->header_sym_len*sizeof(float complex));
+        _q->next_payload_encoder = qpacketmodem_create();
+        _q->next_payload_sym_len = qpacketmodem_get_frame_len(_q->next_payload_encoder);
+        _q->next_payload_sym     = (float complex *) liquid_malloc(_q->next_payload_sym_len*sizeof(float complex));
+        _q->lookahead = framegen_lookahead_create(flexframegen_batch_encode, _q);
+    }
+
+    // store batch description
+    _q->batch_headers      = (unsigned char **) liquid_realloc(_q->batch_headers,  _num_frames*sizeof(unsigned char *));
+    _q->batch_payloads     = (unsigned char **) liquid_realloc(_q->batch_payloads, _num_frames*sizeof(unsigned char *));
+    _q->batch_payload_lens = (unsigned int *)   liquid_realloc(_q->batch_payload_lens, _num_frames*sizeof(unsigned int));
+    memmove(_q->batch_headers,      _headers,      _num_frames*sizeof(unsigned char *));
+    memmove(_q->batch_payloads,     _payloads,     _num_frames*sizeof(unsigned char *));
+    memmove(_q->batch_payload_lens, _payload_lens, _num_frames*sizeof(unsigned int));
+    _q->batch_num_frames  = _num_frames;
+    _q->batch_index       = 0;
+    _q->batch_gap_len     = _gap_len;
+    _q->batch_gap_counter = 0;
+
+    // start encoding second frame while first is written
+    if (_num_frames > 1)
+        framegen_lookahead_submit(_q->lookahead, 1);
+}
+
 // write samples of assembled frame, two samples at a time, returning
 // '1' when frame is complete, '0' otherwise. Zeros will be written
 // to the buffer if the frame is not assembled
@@ -349,13 +457,8 @@ int flexframegen_write_samples(flexframegen    _q,
     unsigned int i;
     for (i=0; i<_buffer_len; i++) {
         // determine if new sample needs to be written
-        if (_q->sample_counter == 0) {
-            // generate new symbol
-            float complex sym = flexframegen_generate_symbol(_q);
-
-            // interpolate result
-            firinterp_crcf_execute(_q->interp, sym, _q->buf_interp);
-        }
+        if (_q->sample_counter == 0)
+            flexframegen_write_symbol(_q, _q->buf_interp);
         
         // write output sample from interpolator buffer
         _buffer[i] = _q->buf_interp[_q->sample_counter];
@@ -367,6 +470,78 @@ int flexframegen_write_samples(flexframegen    _q,
     return _q->frame_complete;
 }
 
+// write samples of assembled frame (or batch of frames) into a buffer
+// of arbitrary length, stopping at the end of the frame; whole symbols are interpolated
+// directly into the output buffer and only a symbol straddling the end
+// of the buffer is staged internally. Returns '1' when the final
+// sample of the frame (or of the last frame in a batch) has been
+// written, '0' otherwise; nothing is written if no frame is assembled
+//  _q          :   frame generator object
+//  _buffer     :   output buffer [size: _buffer_len x 1]
+//  _buffer_len :   output buffer length
+//  _num_written:   number of samples written to buffer
+int flexframegen_write_block(flexframegen    _q,
+                             float complex * _buffer,
+                             unsigned int    _buffer_len,
+                             unsigned int *  _num_written)
+{
+    unsigned int i = 0;
+    while (i < _buffer_len) {
+        if (_q->sample_counter == 0) {
+            // frame of batch complete: write gap, then start next frame
+            if (_q->frame_complete && _q->batch_index + 1 < _q->batch_num_frames) {
+                if (_q->batch_gap_counter < _q->batch_gap_len) {
+                    unsigned int n = _q->batch_gap_len - _q->batch_gap_counter;
+                    if (n > _buffer_len - i)
+                        n = _buffer_len - i;
+                    memset(&_buffer[i], 0x00, n*sizeof(float complex));
+                    _q->batch_gap_counter += n;
+                    i += n;
+                    continue;
+                }
+                flexframegen_batch_next(_q);
+            }
+
+            // frame complete or not assembled
+            if (!_q->frame_assembled)
+                break;
+
+            // copy as much of the rendered preamble as fits
+            unsigned int n = (_buffer_len - i) / _q->k;
+            if (_q->state == STATE_PREAMBLE && n > 0) {
+                if (n > 64 - _q->symbol_counter)
+                    n = 64 - _q->symbol_counter;
+                flexframegen_write_preamble(_q, &_buffer[i], n);
+                i += n*_q->k;
+                continue;
+            }
+
+            // write symbol directly into output buffer if it fits
+            if (n > 0) {
+                flexframegen_write_symbol(_q, &_buffer[i]);
+                i += _q->k;
+                continue;
+            }
+            flexframegen_write_symbol(_q, _q->buf_interp);
+        }
+
+        // write output sample from interpolator buffer
+        _buffer[i++] = _q->buf_interp[_q->sample_counter];
+        _q->sample_counter = (_q->sample_counter + 1) % _q->k;
+    }
+    *_num_written = i;
+
+    // frame complete once final symbol has been drained
+    if (_q->frame_complete && _q->sample_counter == 0 &&
+        _q->batch_index + 1 >= _q->batch_num_frames)
+    {
+        _q->frame_complete   = 0;
+        _q->batch_num_frames = 0;
+        return 1;
+    }
+    return 0;
+}
+
 //
 // internal
 //
@@ -384,7 +559,7 @@ void flexframegen_reconfigure(flexframegen _q)
 
     // re-allocate memory for encoded message
     _q->payload_sym_len = qpacketmodem_get_frame_len(_q->payload_encoder);
-    _q->payload_sym = (float complex*) realloc(_q->payload_sym,
+    _q->payload_sym = (float complex*) liquid_realloc(_q->payload_sym,
                                                _q->payload_sym_len*sizeof(float complex));
 
     // ensure payload was reallocated appropriately
@@ -394,6 +569,120 @@ void flexframegen_reconfigure(flexframegen _q)
     }
 }
 
+// pack protocol and payload description into header following the
+// user-defined section
+//  _q              :   frame generator object
+//  _header         :   header data [size: FLEXFRAME_H_DEC x 1]
+//  _payload_dec_len:   length of payload
+void flexframegen_pack_header(flexframegen    _q,
+                              unsigned char * _header,
+                              unsigned int    _payload_dec_len)
+{
+    // first several bytes of header are user-defined
+    unsigned int n = FLEXFRAME_H_USER;
+
+    // add FLEXFRAME_PROTOCOL
+    _header[n+0] = FLEXFRAME_PROTOCOL;
+
+    // add payload length
+    _header[n+1] = (_payload_dec_len >> 8) & 0xff;
+    _header[n+2] = (_payload_dec_len     ) & 0xff;
+
+    // add modulation scheme/depth (pack into single byte)
+    _header[n+3]  = (unsigned int)(_q->props.mod_scheme);
+
+    // add CRC, forward error-correction schemes
+    //  CRC     : most-significant  3 bits of [n+4]
+    //  fec0    : least-significant 5 bits of [n+4]
+    //  fec1    : least-significant 5 bits of [n+5]
+    _header[n+4]  = (_q->props.check & 0x07) << 5;
+    _header[n+4] |= (_q->props.fec0) & 0x1f;
+    _header[n+5]  = (_q->props.fec1) & 0x1f;
+}
+
+// encode frame of batch into lookahead buffers (run in background;
+// touches only the 'next_' objects and read-only batch state)
+//  _q      :   frame generator object
+//  _index  :   index of frame within batch
+void flexframegen_batch_encode(void *       _q,
+                               unsigned int _index)
+{
+    flexframegen q = (flexframegen) _q;
+
+    // encode/modulate header and add pilots
+    q->next_payload_dec_len = q->batch_payload_lens[_index];
+    memmove(q->next_header, q->batch_headers[_index], FLEXFRAME_H_USER*sizeof(unsigned char));
+    flexframegen_pack_header(q, q->next_header, q->next_payload_dec_len);
+    qpacketmodem_encode(q->next_header_encoder, q->next_header, q->next_header_mod);
+    qpilotgen_execute(q->next_header_pilotgen, q->next_header_mod, q->next_header_sym);
+
+    // configure payload encoder and encode/modulate payload
+    qpacketmodem_configure(q->next_payload_encoder,
+                           q->next_payload_dec_len,
+                           q->props.check,
+                           q->props.fec0,
+                           q->props.fec1,
+                           q->props.mod_scheme);
+    q->next_payload_sym_len = qpacketmodem_get_frame_len(q->next_payload_encoder);
+    q->next_payload_sym = (float complex*) liquid_realloc(q->next_payload_sym,
+                                                   q->next_payload_sym_len*sizeof(float complex));
+    qpacketmodem_encode(q->next_payload_encoder, q->batch_payloads[_index], q->next_payload_sym);
+}
+
+// start writing next frame of batch from lookahead buffers
+void flexframegen_batch_next(flexframegen _q)
+{
+    // wait for frame to be encoded
+    framegen_lookahead_wait(_q->lookahead);
+
+    // swap encoded frame into place
+    float complex * header_sym = _q->header_sym;
+    _q->header_sym      = _q->next_header_sym;
+    _q->next_header_sym = header_sym;
+
+    qpacketmodem payload_encoder = _q->payload_encoder;
+    _q->payload_encoder      = _q->next_payload_encoder;
+    _q->next_payload_encoder = payload_encoder;
+
+    float complex * payload_sym = _q->payload_sym;
+    unsigned int payload_sym_len = _q->payload_sym_len;
+    _q->payload_sym          = _q->next_payload_sym;
+    _q->payload_sym_len      = _q->next_payload_sym_len;
+    _q->next_payload_sym     = payload_sym;
+    _q->next_payload_sym_len = payload_sym_len;
+
+    _q->payload_dec_len = _q->next_payload_dec_len;
+    memmove(_q->header, _q->next_header, FLEXFRAME_H_DEC*sizeof(unsigned char));
+
+    // reset counters and state for new frame
+    _q->symbol_counter  = 0;
+    _q->sample_counter  = 0;
+    _q->frame_complete  = 0;
+    _q->frame_assembled = 1;
+    _q->state           = STATE_PREAMBLE;
+    firinterp_crcf_reset(_q->interp);
+
+    // start encoding following frame
+    _q->batch_index++;
+    _q->batch_gap_counter = 0;
+    if (_q->batch_index + 1 < _q->batch_num_frames)
+        framegen_lookahead_submit(_q->lookahead, _q->batch_index + 1);
+}
+
+// write next symbol of frame (k samples) to output
+void flexframegen_write_symbol(flexframegen    _q,
+                               float complex * _y)
+{
+    if (_q->frame_assembled && _q->state == STATE_PREAMBLE) {
+        flexframegen_write_preamble(_q, _y, 1);
+        return;
+    }
+
+    // generate new symbol and interpolate result
+    float complex sym = flexframegen_generate_symbol(_q);
+    firinterp_crcf_execute(_q->interp, sym, _y);
+}
+
 // fill interpolator buffer
 float complex flexframegen_generate_symbol(flexframegen _q)
 {
@@ -402,7 +691,6 @@ float complex flexframegen_generate_symbol(flexframegen _q)
         return 0.0f;
 
     switch (_q->state) {
-    case STATE_PREAMBLE: return flexframegen_generate_preamble(_q); break;
     case STATE_HEADER:   return flexframegen_generate_header  (_q); break;
     case STATE_PAYLOAD:  return flexframegen_generate_payload (_q); break;
     case STATE_TAIL:     return flexframegen_generate_tail    (_q); break;
@@ -414,17 +702,27 @@ float complex flexframegen_generate_symbol(flexframegen _q)
     return 0.0f;
 }
 
-// generate preamble
-float complex flexframegen_generate_preamble(flexframegen _q)
+// write preamble symbols from rendered samples
+//  _q      :   frame generator object
+//  _y      :   output samples [size: _n*k x 1]
+//  _n      :   number of preamble symbols to write
+void flexframegen_write_preamble(flexframegen    _q,
+                                 float complex * _y,
+                                 unsigned int    _n)
 {
-    float complex symbol = _q->preamble_pn[_q->symbol_counter++];
+    memmove(_y, &_q->preamble_samples[_q->symbol_counter*_q->k], _n*_q->k*sizeof(float complex));
+    _q->symbol_counter += _n;
 
     // check state
     if (_q->symbol_counter == 64) {
+        // load interpolator with preamble, as if it had been executed
+        unsigned int i;
+        for (i=0; i<64; i++)
+            firinterp_crcf_push(_q->interp, _q->preamble_pn[i]);
+
         _q->symbol_counter = 0;
         _q->state = STATE_HEADER;
     }
-    return symbol;
 }
 
 // generate header
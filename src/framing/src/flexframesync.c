@@ -42,13 +42,25 @@
 
 #define FLEXFRAMESYNC_ENABLE_EQ     0
 
+// payload phase recovery window (symbols)
+#define FLEXFRAMESYNC_PHASE_WINDOW  (64)
+
+// input samples mixed down per block once a frame is detected
+#define FLEXFRAMESYNC_MIX_LEN       (256)
+
+// create frame synchronizer, sharing read-only detector template and
+// matched filter coefficients with prototype if not NULL
+flexframesync flexframesync_create_internal(flexframesync      _proto,
+                                            framesync_callback _callback,
+                                            void *             _userdata);
+
 // push samples through detection stage
 void flexframesync_execute_seekpn(flexframesync _q,
                                   float complex _x);
 
-// step receiver mixer, matched filter, decimator
+// step receiver matched filter, decimator
 //  _q      :   frame synchronizer
-//  _x      :   input sample
+//  _x      :   input sample (mixed down)
 //  _y      :   output symbol
 int flexframesync_step(flexframesync   _q,
                        float complex   _x,
@@ -61,6 +73,9 @@ void flexframesync_execute_rxpreamble(flexframesync _q,
 // decode header and reconfigure payload
 void flexframesync_decode_header(flexframesync _q);
 
+// header-only mode: invoke callback and skip payload samples
+void flexframesync_skip_payload(flexframesync _q);
+
 // receive header symbols
 void flexframesync_execute_rxheader(flexframesync _q,
                                     float complex _x);
@@ -69,6 +84,10 @@ void flexframesync_execute_rxheader(flexframesync _q,
 void flexframesync_execute_rxpayload(flexframesync _q,
                                      float complex _x);
 
+// recover payload carrier phase over the whole block of received
+// symbols and accumulate error-vector magnitude
+void flexframesync_recover_payload(flexframesync _q);
+
 // flexframesync object structure
 struct flexframesync_s {
     // callback
@@ -76,6 +95,10 @@ struct flexframesync_s {
     void *              userdata;       // user-defined data structure
     framesyncstats_s    framesyncstats; // frame statistic object (synchronizer)
     framedatastats_s    framedatastats; // frame statistic object (synchronizer)
+    frameperfstats_s    perfstats;      // receiver performance counters
+    int                 perfstats_enabled; // gather performance counters?
+    unsigned int        perfstats_passes;  // detector passes at last update
+    double              perfstats_t_execute; // time of last execute() call
     
     // synchronizer objects
     unsigned int    m;                  // filter delay (symbols)
@@ -86,7 +109,8 @@ struct flexframesync_s {
     float           phi_hat;            // carrier phase offset estimate
     float           gamma_hat;          // channel gain estimate
     nco_crcf        mixer;              // carrier frequency recovery (coarse)
-    nco_crcf        pll;                // carrier frequency recovery (fine)
+    nco_crcf        pll;                // carrier frequency/phase from header pilots (fine)
+    float complex * mix_buf;            // input mixed down by coarse oscillator
 
     // timing recovery objects, states
     firpfb_crcf     mf;                 // matched filter decimator
@@ -112,13 +136,16 @@ struct flexframesync_s {
     int             header_valid;       // header CRC flag
     
     // payload
-    modem           payload_demod;      // payload demod (for phase recovery only)
+    modem           payload_demod;      // payload demod (for phase recovery, evm only)
     float complex * payload_sym;        // payload symbols (received)
     unsigned int    payload_sym_len;    // payload symbols (length)
     qpacketmodem    payload_decoder;    // payload demodulator/decoder
     unsigned char * payload_dec;        // payload data (bytes)
     unsigned int    payload_dec_len;    // payload data (length)
     int             payload_valid;      // payload CRC flag
+    int             header_only;        // skip payload after valid header?
+    framequeue      fq;                 // queued frame delivery (or NULL)
+    unsigned int    skip_counter;       // counter: payload samples left to skip
     
     // status variables
     unsigned int    preamble_counter;   // counter: num of p/n syms received
@@ -128,6 +155,7 @@ struct flexframesync_s {
         FLEXFRAMESYNC_STATE_RXPREAMBLE,     // receive p/n sequence
         FLEXFRAMESYNC_STATE_RXHEADER,       // receive header data
         FLEXFRAMESYNC_STATE_RXPAYLOAD,      // receive payload data
+        FLEXFRAMESYNC_STATE_SKIPPAYLOAD,    // skip payload (header-only mode)
     }               state;                  // receiver state
 
 #if DEBUG_FLEXFRAMESYNC
@@ -144,17 +172,41 @@ struct flexframesync_s {
 flexframesync flexframesync_create(framesync_callback _callback,
                                    void *             _userdata)
 {
-    flexframesync q = (flexframesync) malloc(sizeof(struct flexframesync_s));
+    return flexframesync_create_internal(NULL, _callback, _userdata);
+}
+
+// create flexframesync object sharing the read-only frame detector
+// template and matched filter coefficients of an existing object;
+// configuration set on the prototype after its creation (e.g. the
+// detector energy gate) is not copied
+//  _proto          :   prototype frame synchronizer
+//  _callback       :   callback function invoked when frame is received
+//  _userdata       :   user-defined data object passed to callback
+flexframesync flexframesync_create_shared(flexframesync      _proto,
+                                          framesync_callback _callback,
+                                          void *             _userdata)
+{
+    return flexframesync_create_internal(_proto, _callback, _userdata);
+}
+
+// create frame synchronizer, sharing read-only detector template and
+// matched filter coefficients with prototype if not NULL
+flexframesync flexframesync_create_internal(flexframesync      _proto,
+                                            framesync_callback _callback,
+                                            void *             _userdata)
+{
+    flexframesync q = (flexframesync) liquid_malloc(sizeof(struct flexframesync_s));
     q->callback = _callback;
     q->userdata = _userdata;
+    q->fq       = NULL;
     q->m        = 7;    // filter delay (symbols)
     q->beta     = 0.3f; // excess bandwidth factor
 
     unsigned int i;
 
     // generate p/n sequence
-    q->preamble_pn = (float complex*) malloc(64*sizeof(float complex));
-    q->preamble_rx = (float complex*) malloc(64*sizeof(float complex));
+    q->preamble_pn = (float complex*) liquid_malloc(64*sizeof(float complex));
+    q->preamble_rx = (float complex*) liquid_malloc(64*sizeof(float complex));
     msequence ms = msequence_create(7, 0x0089, 1);
     for (i=0; i<64; i++) {
         q->preamble_pn[i] = (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2) +
@@ -164,12 +216,20 @@ flexframesync flexframesync_create(framesync_callback _callback,
 
     // create frame detector
     unsigned int k = 2; // samples/symbol
-    q->detector = qdetector_cccf_create_linear(q->preamble_pn, 64, LIQUID_FIRFILT_ARKAISER, k, q->m, q->beta);
+    if (_proto == NULL) {
+        q->detector = qdetector_cccf_create_linear(q->preamble_pn, 64, LIQUID_FIRFILT_ARKAISER, k, q->m, q->beta);
+    } else {
+        q->detector = qdetector_cccf_create_shared(_proto->detector);
+        qdetector_cccf_gate_disable(q->detector);
+    }
     qdetector_cccf_set_threshold(q->detector, 0.5f);
 
     // create symbol timing recovery filters
     q->npfb = 32;   // number of filters in the bank
-    q->mf   = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, q->npfb,k,q->m,q->beta);
+    if (_proto == NULL)
+        q->mf = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, q->npfb,k,q->m,q->beta);
+    else
+        q->mf = firpfb_crcf_create_shared(_proto->mf);
 
 #if FLEXFRAMESYNC_ENABLE_EQ
     // create equalizer
@@ -181,10 +241,10 @@ flexframesync flexframesync_create(framesync_callback _callback,
     // create down-coverters for carrier phase tracking
     q->mixer = nco_crcf_create(LIQUID_NCO);
     q->pll   = nco_crcf_create(LIQUID_NCO);
-    nco_crcf_pll_set_bandwidth(q->pll, 1e-4f); // very low bandwidth
+    q->mix_buf = (float complex *) liquid_malloc(FLEXFRAMESYNC_MIX_LEN*sizeof(float complex));
     
     // header demodulator/decoder
-    q->header_dec     = (unsigned char *) malloc(FLEXFRAME_H_DEC*sizeof(unsigned char));
+    q->header_dec     = (unsigned char *) liquid_malloc(FLEXFRAME_H_DEC*sizeof(unsigned char));
     q->header_decoder = qpacketmodem_create();
     qpacketmodem_configure(q->header_decoder,
                            FLEXFRAME_H_DEC,
@@ -193,12 +253,12 @@ flexframesync flexframesync_create(framesync_callback _callback,
                            FLEXFRAME_H_FEC1,
                            LIQUID_MODEM_QPSK);
     q->header_mod_len = qpacketmodem_get_frame_len(q->header_decoder);
-    q->header_mod     = (float complex*) malloc(q->header_mod_len*sizeof(float complex));
+    q->header_mod     = (float complex*) liquid_malloc(q->header_mod_len*sizeof(float complex));
 
     // header pilot synchronizer
     q->header_pilotsync = qpilotsync_create(q->header_mod_len, 16);
     q->header_sym_len   = qpilotsync_get_frame_len(q->header_pilotsync);
-    q->header_sym       = (float complex*) malloc(q->header_sym_len*sizeof(float complex));
+    q->header_sym       = (float complex*) liquid_malloc(q->header_sym_len*sizeof(float complex));
     
     // payload demodulator for phase recovery
     q->payload_demod = modem_create(LIQUID_MODEM_QPSK);
@@ -216,12 +276,20 @@ flexframesync flexframesync_create(framesync_callback _callback,
     q->payload_sym_len = qpacketmodem_get_frame_len(q->payload_decoder);
 
     // allocate memory for payload symbols and recovered data bytes
-    q->payload_sym = (float complex*) malloc(q->payload_sym_len*sizeof(float complex));
-    q->payload_dec = (unsigned char*) malloc(q->payload_dec_len*sizeof(unsigned char));
+    q->payload_sym = (float complex*) liquid_malloc(q->payload_sym_len*sizeof(float complex));
+    q->payload_dec = (unsigned char*) liquid_malloc(q->payload_dec_len*sizeof(unsigned char));
 
     // reset global data counters
     flexframesync_reset_framedatastats(q);
 
+    // header-only mode (disabled by default)
+    q->header_only  = 0;
+    q->skip_counter = 0;
+
+    // performance counters (disabled by default)
+    q->perfstats_enabled = 0;
+    frameperfstats_reset(&q->perfstats);
+
 #if DEBUG_FLEXFRAMESYNC
     // set debugging flags, objects to NULL
     q->debug_enabled         = 0;
@@ -238,6 +306,10 @@ flexframesync flexframesync_create(framesync_callback _callback,
 // destroy frame synchronizer object, freeing all internal memory
 void flexframesync_destroy(flexframesync _q)
 {
+    // deliver (or discard) queued frames
+    if (_q->fq != NULL)
+        framequeue_destroy(_q->fq);
+
 #if DEBUG_FLEXFRAMESYNC
     // clean up debug objects (if created)
     if (_q->debug_objects_created)
@@ -245,13 +317,14 @@ void flexframesync_destroy(flexframesync _q)
 #endif
 
     // free allocated arrays
-    free(_q->preamble_pn);
-    free(_q->preamble_rx);
-    free(_q->header_sym);
-    free(_q->header_mod);
-    free(_q->header_dec);
-    free(_q->payload_sym);
-    free(_q->payload_dec);
+    liquid_free(_q->preamble_pn);
+    liquid_free(_q->preamble_rx);
+    liquid_free(_q->header_sym);
+    liquid_free(_q->header_mod);
+    liquid_free(_q->header_dec);
+    liquid_free(_q->payload_sym);
+    liquid_free(_q->payload_dec);
+    liquid_free(_q->mix_buf);
 
     // destroy synchronization objects
     qpilotsync_destroy    (_q->header_pilotsync); // header demodulator/decoder
@@ -267,7 +340,7 @@ void flexframesync_destroy(flexframesync _q)
 #endif
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print frame synchronizer object internals
@@ -275,6 +348,48 @@ void flexframesync_print(flexframesync _q)
 {
     printf("flexframesync:\n");
     framedatastats_print(&_q->framedatastats);
+    if (_q->perfstats_enabled)
+        frameperfstats_print(&_q->perfstats);
+}
+
+// get memory footprint of frame synchronizer and all of its internal
+// objects and buffers [bytes]; the detector template and matched filter
+// coefficients shared with other synchronizers (see
+// flexframesync_create_shared()) are divided evenly among them
+unsigned long int flexframesync_get_memory_usage(flexframesync _q)
+{
+    unsigned long int n = sizeof(struct flexframesync_s);
+
+    // detection, carrier recovery and matched filter
+    n += qdetector_cccf_get_memory_usage(_q->detector);
+    n += nco_crcf_get_memory_usage(_q->mixer);
+    n += nco_crcf_get_memory_usage(_q->pll);
+    n += FLEXFRAMESYNC_MIX_LEN*sizeof(float complex);
+    n += firpfb_crcf_get_memory_usage(_q->mf);
+#if FLEXFRAMESYNC_ENABLE_EQ
+    n += eqlms_cccf_get_memory_usage(_q->equalizer);
+#endif
+
+    // preamble
+    n += 2*64*sizeof(float complex);
+
+    // header
+    n += _q->header_sym_len*sizeof(float complex);
+    n += qpilotsync_get_memory_usage(_q->header_pilotsync);
+    n += _q->header_mod_len*sizeof(float complex);
+    n += qpacketmodem_get_memory_usage(_q->header_decoder);
+    n += FLEXFRAME_H_DEC*sizeof(unsigned char);
+
+    // payload
+    n += modem_get_memory_usage(_q->payload_demod);
+    n += _q->payload_sym_len*sizeof(float complex);
+    n += qpacketmodem_get_memory_usage(_q->payload_decoder);
+    n += _q->payload_dec_len*sizeof(unsigned char);
+
+    // queued frame delivery
+    if (_q->fq != NULL)
+        n += framequeue_get_memory_usage(_q->fq);
+    return n;
 }
 
 // reset frame synchronizer object
@@ -293,6 +408,7 @@ void flexframesync_reset(flexframesync _q)
     // reset state
     _q->state           = FLEXFRAMESYNC_STATE_DETECTFRAME;
     _q->preamble_counter= 0;
+    FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_STATE, _q->state);
     _q->symbol_counter  = 0;
     
     // reset frame statistics
@@ -307,35 +423,82 @@ void flexframesync_execute(flexframesync   _q,
                            float complex * _x,
                            unsigned int    _n)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
+    if (_q->perfstats_enabled)
+        _q->perfstats_t_execute = frameperfstats_time();
+
+    unsigned int i = 0;
+    while (i < _n) {
+        // detect frame (look for p/n sequence) on raw input
+        if (_q->state == FLEXFRAMESYNC_STATE_DETECTFRAME) {
 #if DEBUG_FLEXFRAMESYNC
-        // write samples to debug buffer
-        // NOTE: the debug_qdetector_flush prevents samples from being written twice
-        if (_q->debug_enabled && !_q->debug_qdetector_flush)
-            windowcf_push(_q->debug_x, _x[i]);
+            // write samples to debug buffer
+            // NOTE: the debug_qdetector_flush prevents samples from being written twice
+            if (_q->debug_enabled && !_q->debug_qdetector_flush)
+                windowcf_push(_q->debug_x, _x[i]);
 #endif
-        switch (_q->state) {
-        case FLEXFRAMESYNC_STATE_DETECTFRAME:
-            // detect frame (look for p/n sequence)
+            if (_q->perfstats_enabled)
+                _q->perfstats.num_samples_detect++;
             flexframesync_execute_seekpn(_q, _x[i]);
-            break;
-        case FLEXFRAMESYNC_STATE_RXPREAMBLE:
-            // receive p/n sequence symbols
-            flexframesync_execute_rxpreamble(_q, _x[i]);
-            break;
-        case FLEXFRAMESYNC_STATE_RXHEADER:
-            // receive header symbols
-            flexframesync_execute_rxheader(_q, _x[i]);
-            break;
-        case FLEXFRAMESYNC_STATE_RXPAYLOAD:
-            // receive payload symbols
-            flexframesync_execute_rxpayload(_q, _x[i]);
-            break;
-        default:
-            fprintf(stderr,"error: flexframesync_exeucte(), unknown/unsupported state\n");
-            exit(1);
+            i++;
+            continue;
+        }
+
+        // header-only mode: fast-forward over the payload samples without
+        // mixing, filtering or demodulating them
+        if (_q->state == FLEXFRAMESYNC_STATE_SKIPPAYLOAD) {
+            unsigned int n = _n - i < _q->skip_counter ? _n - i : _q->skip_counter;
+            if (_q->perfstats_enabled)
+                _q->perfstats.num_samples_payload += n;
+            _q->skip_counter -= n;
+            i += n;
+            if (_q->skip_counter == 0)
+                flexframesync_reset(_q);
+            continue;
+        }
+
+        // once detected the coarse oscillator frequency is fixed, so
+        // mix a block down at once; samples remaining after the frame
+        // completes are returned to detection un-mixed (the oscillator
+        // is set again on the next detection)
+        unsigned int n = _n - i < FLEXFRAMESYNC_MIX_LEN ? _n - i : FLEXFRAMESYNC_MIX_LEN;
+        nco_crcf_mix_block_down(_q->mixer, &_x[i], _q->mix_buf, n);
+
+        unsigned int j;
+        for (j=0; j<n && _q->state != FLEXFRAMESYNC_STATE_DETECTFRAME &&
+                        _q->state != FLEXFRAMESYNC_STATE_SKIPPAYLOAD; j++) {
+#if DEBUG_FLEXFRAMESYNC
+            if (_q->debug_enabled && !_q->debug_qdetector_flush)
+                windowcf_push(_q->debug_x, _x[i+j]);
+#endif
+            // accumulate samples processed per state
+            if (_q->perfstats_enabled) {
+                switch (_q->state) {
+                case FLEXFRAMESYNC_STATE_RXPREAMBLE:  _q->perfstats.num_samples_preamble++; break;
+                case FLEXFRAMESYNC_STATE_RXHEADER:    _q->perfstats.num_samples_header++;   break;
+                case FLEXFRAMESYNC_STATE_RXPAYLOAD:   _q->perfstats.num_samples_payload++;  break;
+                default:;
+                }
+            }
+
+            switch (_q->state) {
+            case FLEXFRAMESYNC_STATE_RXPREAMBLE:
+                // receive p/n sequence symbols
+                flexframesync_execute_rxpreamble(_q, _q->mix_buf[j]);
+                break;
+            case FLEXFRAMESYNC_STATE_RXHEADER:
+                // receive header symbols
+                flexframesync_execute_rxheader(_q, _q->mix_buf[j]);
+                break;
+            case FLEXFRAMESYNC_STATE_RXPAYLOAD:
+                // receive payload symbols
+                flexframesync_execute_rxpayload(_q, _q->mix_buf[j]);
+                break;
+            default:
+                fprintf(stderr,"error: flexframesync_exeucte(), unknown/unsupported state\n");
+                exit(1);
+            }
         }
+        i += j;
     }
 }
 
@@ -353,6 +516,14 @@ void flexframesync_execute_seekpn(flexframesync _q,
     // push through pre-demod synchronizer
     float complex * v = qdetector_cccf_execute(_q->detector, _x);
 
+    // count correlation passes (blocks not bypassed by energy gate)
+    if (_q->perfstats_enabled) {
+        unsigned int passes = qdetector_cccf_gate_get_num_blocks (_q->detector) -
+                              qdetector_cccf_gate_get_num_skipped(_q->detector);
+        _q->perfstats.num_detector_passes += passes - _q->perfstats_passes;
+        _q->perfstats_passes = passes;
+    }
+
     // check if frame has been detected
     if (v != NULL) {
         // get estimates
@@ -384,6 +555,8 @@ void flexframesync_execute_seekpn(flexframesync _q,
 
         // update state
         _q->state = FLEXFRAMESYNC_STATE_RXPREAMBLE;
+        FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_FRAME_DETECTED, 0);
+        FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_STATE, _q->state);
 
 #if DEBUG_FLEXFRAMESYNC
         // the debug_qdetector_flush prevents samples from being written twice
@@ -398,21 +571,17 @@ void flexframesync_execute_seekpn(flexframesync _q,
     }
 }
 
-// step receiver mixer, matched filter, decimator
+// step receiver matched filter, decimator
 //  _q      :   frame synchronizer
-//  _x      :   input sample
+//  _x      :   input sample (mixed down)
 //  _y      :   output symbol
 int flexframesync_step(flexframesync   _q,
                        float complex   _x,
                        float complex * _y)
 {
-    // mix sample down
-    float complex v;
-    nco_crcf_mix_down(_q->mixer, _x, &v);
-    nco_crcf_step    (_q->mixer);
-    
     // push sample into filterbank
-    firpfb_crcf_push   (_q->mf, v);
+    float complex v;
+    firpfb_crcf_push   (_q->mf, _x);
     firpfb_crcf_execute(_q->mf, _q->pfb_index, &v);
 
 #if FLEXFRAMESYNC_ENABLE_EQ
@@ -477,8 +646,10 @@ void flexframesync_execute_rxpreamble(flexframesync _q,
         _q->preamble_counter++;
 
         // update state
-        if (_q->preamble_counter == 64 + delay)
+        if (_q->preamble_counter == 64 + delay) {
             _q->state = FLEXFRAMESYNC_STATE_RXHEADER;
+            FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_STATE, _q->state);
+        }
     }
 }
 
@@ -504,11 +675,18 @@ void flexframesync_execute_rxheader(flexframesync _q,
         if (_q->symbol_counter == _q->header_sym_len) {
             // decode header
             flexframesync_decode_header(_q);
+            FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_HEADER_DECODED, _q->header_valid);
+
+            if (_q->header_valid && _q->header_only) {
+                flexframesync_skip_payload(_q);
+                return;
+            }
 
             if (_q->header_valid) {
                 // continue on to decoding payload
                 _q->symbol_counter = 0;
                 _q->state = FLEXFRAMESYNC_STATE_RXPAYLOAD;
+                FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_STATE, _q->state);
                 return;
             }
 
@@ -516,6 +694,7 @@ void flexframesync_execute_rxheader(flexframesync _q,
             _q->framedatastats.num_frames_detected++;
 
             // header invalid: invoke callback
+            double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
             if (_q->callback != NULL) {
                 // set framestats internals
                 _q->framesyncstats.evm           = 0.0f; //20*log10f(sqrtf(_q->framesyncstats.evm / 600));
@@ -538,6 +717,10 @@ void flexframesync_execute_rxheader(flexframesync _q,
                              _q->framesyncstats,
                              _q->userdata);
             }
+            if (_q->perfstats_enabled) {
+                _q->perfstats.time_callback += frameperfstats_time() - t0;
+                frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+            }
 
             // reset frame synchronizer
             flexframesync_reset(_q);
@@ -546,16 +729,70 @@ void flexframesync_execute_rxheader(flexframesync _q,
     }
 }
 
+// header-only mode: invoke callback with the decoded header and
+// payload configuration, then skip the payload samples
+void flexframesync_skip_payload(flexframesync _q)
+{
+    // update statistics
+    _q->framedatastats.num_frames_detected++;
+    _q->framedatastats.num_headers_valid++;
+
+    double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+    if (_q->callback != NULL) {
+        // set framestats internals
+        int ms = qpacketmodem_get_modscheme(_q->payload_decoder);
+        _q->framesyncstats.evm           = 0.0f;
+        _q->framesyncstats.rssi          = 20*log10f(_q->gamma_hat);
+        _q->framesyncstats.cfo           = nco_crcf_get_frequency(_q->mixer);
+        _q->framesyncstats.framesyms     = NULL;
+        _q->framesyncstats.num_framesyms = 0;
+        _q->framesyncstats.mod_scheme    = ms;
+        _q->framesyncstats.mod_bps       = modulation_types[ms].bps;
+        _q->framesyncstats.check         = qpacketmodem_get_crc(_q->payload_decoder);
+        _q->framesyncstats.fec0          = qpacketmodem_get_fec0(_q->payload_decoder);
+        _q->framesyncstats.fec1          = qpacketmodem_get_fec1(_q->payload_decoder);
+
+        // invoke callback method
+        _q->callback(_q->header_dec,
+                     _q->header_valid,
+                     NULL,  // payload
+                     0,     // payload length
+                     0,     // payload valid,
+                     _q->framesyncstats,
+                     _q->userdata);
+    }
+    if (_q->perfstats_enabled) {
+        _q->perfstats.time_callback += frameperfstats_time() - t0;
+        frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+    }
+
+    // skip payload symbols at k=2 samples/symbol
+    _q->skip_counter = 2*_q->payload_sym_len;
+    _q->state = FLEXFRAMESYNC_STATE_SKIPPAYLOAD;
+    FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_STATE, _q->state);
+}
+
 // decode header
 void flexframesync_decode_header(flexframesync _q)
 {
     // recover data symbols from pilots
     qpilotsync_execute(_q->header_pilotsync, _q->header_sym, _q->header_mod);
 
-    // decode payload
-    _q->header_valid = qpacketmodem_decode(_q->header_decoder,
-                                           _q->header_mod,
-                                           _q->header_dec);
+    // decode header, rejecting false detections from the syndromes of
+    // the outer code before running the full decoder
+    double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+    int rc = qpacketmodem_decode_precheck(_q->header_decoder,
+                                          _q->header_mod,
+                                          _q->header_dec,
+                                          FLEXFRAME_H_PRECHECK);
+    _q->header_valid = rc == 1;
+    if (_q->perfstats_enabled) {
+        if (rc < 0)
+            _q->perfstats.num_header_rejects++;
+        else
+            _q->perfstats.num_decode_attempts++;
+        _q->perfstats.time_fec += frameperfstats_time() - t0;
+    }
 
     if (!_q->header_valid)
         return;
@@ -612,7 +849,7 @@ void flexframesync_decode_header(flexframesync _q)
         return;
     }
 
-    // re-create payload demodulator for phase-locked loop
+    // re-create payload demodulator for phase recovery
     _q->payload_demod = modem_recreate(_q->payload_demod, mod_scheme);
 
     // reconfigure payload demodulator/decoder
@@ -623,8 +860,8 @@ void flexframesync_decode_header(flexframesync _q)
     _q->payload_sym_len = qpacketmodem_get_frame_len(_q->payload_decoder);
 
     // re-allocate buffers accordingly
-    _q->payload_sym = (float complex*) realloc(_q->payload_sym, (_q->payload_sym_len)*sizeof(float complex));
-    _q->payload_dec = (unsigned char*) realloc(_q->payload_dec, (_q->payload_dec_len)*sizeof(unsigned char));
+    _q->payload_sym = (float complex*) liquid_realloc(_q->payload_sym, (_q->payload_sym_len)*sizeof(float complex));
+    _q->payload_dec = (unsigned char*) liquid_realloc(_q->payload_dec, (_q->payload_dec_len)*sizeof(unsigned char));
 
     if (_q->payload_sym == NULL || _q->payload_dec == NULL) {
         fprintf(stderr,"error: flexframesync_decode_header(), could not re-allocate payload arrays\n");
@@ -664,29 +901,29 @@ void flexframesync_execute_rxpayload(flexframesync _q,
 
     // compute output if timeout
     if (sample_available) {
-        // TODO: clean this up
-        // mix down with fine-tuned oscillator
-        nco_crcf_mix_down(_q->pll, mf_out, &mf_out);
-        // track phase, accumulate error-vector magnitude
-        unsigned int sym;
-        modem_demodulate(_q->payload_demod, mf_out, &sym);
-        float phase_error = modem_get_demodulator_phase_error(_q->payload_demod);
-        float evm         = modem_get_demodulator_evm        (_q->payload_demod);
-        nco_crcf_pll_step(_q->pll, phase_error);
-        nco_crcf_step(_q->pll);
-        _q->framesyncstats.evm += evm*evm;
+        // save payload symbols (modem input/output); carrier is
+        // removed once the full payload has been received
 
-        // save payload symbols (modem input/output)
         _q->payload_sym[_q->symbol_counter] = mf_out;
 
         // increment counter
         _q->symbol_counter++;
 
         if (_q->symbol_counter == _q->payload_sym_len) {
+            // recover phase, accumulate error-vector magnitude
+            flexframesync_recover_payload(_q);
+
             // decode payload
+            double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
             _q->payload_valid = qpacketmodem_decode(_q->payload_decoder,
                                                     _q->payload_sym,
                                                     _q->payload_dec);
+            FRAMETRACE(_q, "flexframesync", LIQUID_FRAMETRACE_PAYLOAD_DECODED, _q->payload_valid);
+            if (_q->perfstats_enabled) {
+                _q->perfstats.num_decode_attempts++;
+                _q->perfstats.time_fec += frameperfstats_time() - t0;
+                t0 = frameperfstats_time();
+            }
 
             // update statistics
             _q->framedatastats.num_frames_detected++;
@@ -718,6 +955,10 @@ void flexframesync_execute_rxpayload(flexframesync _q,
                              _q->framesyncstats,
                              _q->userdata);
             }
+            if (_q->perfstats_enabled) {
+                _q->perfstats.time_callback += frameperfstats_time() - t0;
+                frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+            }
 
             // reset frame synchronizer
             flexframesync_reset(_q);
@@ -726,6 +967,33 @@ void flexframesync_execute_rxpayload(flexframesync _q,
     }
 }
 
+// recover payload carrier phase over the whole block of received
+// symbols and accumulate error-vector magnitude
+void flexframesync_recover_payload(flexframesync _q)
+{
+    // mix down with oscillator tuned from header pilots, then remove
+    // residual phase
+    nco_crcf_mix_block_down(_q->pll, _q->payload_sym, _q->payload_sym, _q->payload_sym_len);
+    modem_recover_phase_block(_q->payload_demod, _q->payload_sym,
+                              _q->payload_sym_len, FLEXFRAMESYNC_PHASE_WINDOW);
+
+    // error vector against hard decisions
+    unsigned int  sym[FLEXFRAMESYNC_PHASE_WINDOW];
+    float complex ref[FLEXFRAMESYNC_PHASE_WINDOW];
+    unsigned int i, j;
+    for (i=0; i<_q->payload_sym_len; i+=FLEXFRAMESYNC_PHASE_WINDOW) {
+        unsigned int n = _q->payload_sym_len - i;
+        if (n > FLEXFRAMESYNC_PHASE_WINDOW)
+            n = FLEXFRAMESYNC_PHASE_WINDOW;
+        modem_demodulate_block(_q->payload_demod, &_q->payload_sym[i], n, sym);
+        modem_modulate_block  (_q->payload_demod, sym, n, ref);
+        for (j=0; j<n; j++) {
+            float complex e = _q->payload_sym[i+j] - ref[j];
+            _q->framesyncstats.evm += crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+        }
+    }
+}
+
 // reset frame data statistics
 void flexframesync_reset_framedatastats(flexframesync _q)
 {
@@ -738,6 +1006,107 @@ framedatastats_s flexframesync_get_framedatastats(flexframesync _q)
     return _q->framedatastats;
 }
 
+// enable receiver performance counters
+void flexframesync_perfstats_enable(flexframesync _q)
+{
+    _q->perfstats_enabled = 1;
+    _q->perfstats_passes  = qdetector_cccf_gate_get_num_blocks (_q->detector) -
+                            qdetector_cccf_gate_get_num_skipped(_q->detector);
+}
+
+// disable receiver performance counters
+void flexframesync_perfstats_disable(flexframesync _q)
+{
+    _q->perfstats_enabled = 0;
+}
+
+// reset receiver performance counters
+void flexframesync_reset_perfstats(flexframesync _q)
+{
+    frameperfstats_reset(&_q->perfstats);
+}
+
+// retrieve receiver performance counters
+frameperfstats_s flexframesync_get_perfstats(flexframesync _q)
+{
+    return _q->perfstats;
+}
+
+// set/get header-only mode
+void flexframesync_set_header_only(flexframesync _q,
+                                   int           _header_only)
+{
+    _q->header_only = _header_only ? 1 : 0;
+}
+
+int flexframesync_get_header_only(flexframesync _q)
+{
+    return _q->header_only;
+}
+
+// set queued frame delivery: frames are copied into _num_slots pooled
+// slots instead of being passed to the callback from execute() (0:
+// direct delivery); with _thread set a delivery thread invokes the
+// callback, otherwise frames are retrieved with flexframesync_pop_frame()
+void flexframesync_set_frame_queue(flexframesync _q,
+                                   unsigned int  _num_slots,
+                                   int           _thread)
+{
+    _q->fq = framequeue_reconfigure(_q->fq, _num_slots, FLEXFRAME_H_USER, _thread,
+                                    &_q->callback, &_q->userdata);
+}
+
+// pop oldest queued frame; buffers remain valid until the next pop
+//  _q      :   frame synchronizer object
+//  _frame  :   received frame [output]
+int flexframesync_pop_frame(flexframesync       _q,
+                            framesync_frame_s * _frame)
+{
+    if (_q->fq == NULL || framequeue_is_threaded(_q->fq)) {
+        fprintf(stderr,"error: flexframesync_pop_frame(), frame queue not enabled or drained by delivery thread\n");
+        exit(1);
+    }
+    return framequeue_pop(_q->fq, _frame);
+}
+
+// get number of frames dropped because the queue was full
+unsigned int flexframesync_get_frame_queue_drops(flexframesync _q)
+{
+    return _q->fq == NULL ? 0 : framequeue_get_num_dropped(_q->fq);
+}
+
+// enable energy gate on frame detector, bypassing the preamble
+// correlation while the input stays near the noise floor
+void flexframesync_gate_enable(flexframesync _q)
+{
+    qdetector_cccf_gate_enable(_q->detector);
+}
+
+// disable energy gate on frame detector
+void flexframesync_gate_disable(flexframesync _q)
+{
+    qdetector_cccf_gate_disable(_q->detector);
+}
+
+// set energy gate threshold above noise floor [dB]
+void flexframesync_gate_set_threshold(flexframesync _q,
+                                      float         _threshold)
+{
+    qdetector_cccf_gate_set_threshold(_q->detector, _threshold);
+}
+
+// number of detector blocks processed
+unsigned int flexframesync_gate_get_num_blocks(flexframesync _q)
+{
+    return qdetector_cccf_gate_get_num_blocks(_q->detector);
+}
+
+// number of detector blocks bypassed by energy gate
+unsigned int flexframesync_gate_get_num_skipped(flexframesync _q)
+{
+    return qdetector_cccf_gate_get_num_skipped(_q->detector);
+}
+
 // enable debugging
 void flexframesync_debug_enable(flexframesync _q)
 {
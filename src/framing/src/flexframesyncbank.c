@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// flexframesyncbank.c
+//
+// multi-stream frame synchronizer: bank of flexframesync objects sharing
+// the read-only frame detector template and matched filter coefficients,
+// with streams executed across a pool of threads
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define FLEXFRAMESYNCBANK_THREADS (1)
+#else
+#define FLEXFRAMESYNCBANK_THREADS (0)
+#endif
+
+// per-stream context passed to internal callback
+struct flexframesyncbank_stream_s {
+    flexframesync     fs;               // frame synchronizer
+    flexframesyncbank q;                // parent bank
+    void *            userdata;         // user-defined data for stream
+};
+
+struct flexframesyncbank_s {
+    unsigned int        num_streams;    // number of input streams
+    unsigned int        num_threads;    // number of threads, including caller
+    framesync_callback  callback;       // user-defined callback function
+    struct flexframesyncbank_stream_s * streams;    // streams [num_streams]
+
+#if FLEXFRAMESYNCBANK_THREADS
+    pthread_t *         threads;        // worker threads [num_threads-1]
+    pthread_mutex_t     mutex;          // protects batch state
+    pthread_cond_t      cv_work;        // signalled when batch is posted
+    pthread_cond_t      cv_done;        // signalled when batch completes
+    pthread_mutex_t     callback_mutex; // serializes user callbacks
+    unsigned long int   batch;          // batch counter
+    unsigned int        next;           // next stream to execute in batch
+    unsigned int        num_done;       // number of streams completed in batch
+    int                 stop;           // worker shutdown flag
+    float complex **    x;              // batch input buffers [num_streams]
+    unsigned int        n;              // batch input length
+#endif
+};
+
+// internal callback: forward frame to user callback with stream userdata
+int flexframesyncbank_callback(unsigned char *  _header,
+                               int              _header_valid,
+                               unsigned char *  _payload,
+                               unsigned int     _payload_len,
+                               int              _payload_valid,
+                               framesyncstats_s _stats,
+                               void *           _userdata);
+
+#if FLEXFRAMESYNCBANK_THREADS
+// execute remaining streams of current batch (mutex held on entry/exit)
+void flexframesyncbank_run_batch(flexframesyncbank _q);
+
+// worker thread main loop
+void * flexframesyncbank_worker(void * _arg);
+#endif
+
+// create multi-stream frame synchronizer
+//  _num_streams    :   number of input streams
+//  _num_threads    :   number of threads executing streams, including the caller
+//  _callback       :   callback function invoked when frame is received
+//  _userdata       :   per-stream user data passed to callback [size: _num_streams x 1], or NULL
+flexframesyncbank flexframesyncbank_create(unsigned int       _num_streams,
+                                           unsigned int       _num_threads,
+                                           framesync_callback _callback,
+                                           void **            _userdata)
+{
+    // validate input
+    if (_num_streams == 0) {
+        fprintf(stderr,"error: flexframesyncbank_create(), number of streams must be greater than zero\n");
+        exit(1);
+    } else if (_num_threads == 0) {
+        fprintf(stderr,"error: flexframesyncbank_create(), number of threads must be greater than zero\n");
+        exit(1);
+    }
+
+    flexframesyncbank q = (flexframesyncbank) liquid_malloc(sizeof(struct flexframesyncbank_s));
+    q->num_streams = _num_streams;
+    q->num_threads = _num_threads > _num_streams ? _num_streams : _num_threads;
+    q->callback    = _callback;
+#if !FLEXFRAMESYNCBANK_THREADS
+    if (q->num_threads > 1)
+        fprintf(stderr,"warning: flexframesyncbank_create(), built without pthreads; executing streams serially\n");
+    q->num_threads = 1;
+#endif
+
+    // create synchronizers, sharing template and filter coefficients of first
+    q->streams = (struct flexframesyncbank_stream_s*) liquid_malloc(q->num_streams*sizeof(struct flexframesyncbank_stream_s));
+    unsigned int i;
+    for (i=0; i<q->num_streams; i++) {
+        struct flexframesyncbank_stream_s * stream = &q->streams[i];
+        stream->q        = q;
+        stream->userdata = _userdata == NULL ? NULL : _userdata[i];
+        framesync_callback callback = _callback == NULL ? NULL : flexframesyncbank_callback;
+        if (i == 0)
+            stream->fs = flexframesync_create(callback, stream);
+        else
+            stream->fs = flexframesync_create_shared(q->streams[0].fs, callback, stream);
+    }
+
+#if FLEXFRAMESYNCBANK_THREADS
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_mutex_init(&q->callback_mutex, NULL);
+    pthread_cond_init(&q->cv_work, NULL);
+    pthread_cond_init(&q->cv_done, NULL);
+    q->batch    = 0;
+    q->next     = q->num_streams;
+    q->num_done = q->num_streams;
+    q->stop     = 0;
+    q->x        = (float complex**) liquid_malloc(q->num_streams*sizeof(float complex*));
+    q->n        = 0;
+
+    // the calling thread executes streams as well
+    q->threads  = (pthread_t*) liquid_malloc(q->num_threads*sizeof(pthread_t));
+    for (i=0; i<q->num_threads-1; i++) {
+        if (pthread_create(&q->threads[i], NULL, flexframesyncbank_worker, q) != 0) {
+            fprintf(stderr,"error: flexframesyncbank_create(), could not create thread\n");
+            exit(1);
+        }
+    }
+#endif
+
+    return q;
+}
+
+// destroy multi-stream frame synchronizer, freeing all internal memory
+void flexframesyncbank_destroy(flexframesyncbank _q)
+{
+    unsigned int i;
+#if FLEXFRAMESYNCBANK_THREADS
+    // stop and join worker threads
+    pthread_mutex_lock(&_q->mutex);
+    _q->stop = 1;
+    pthread_cond_broadcast(&_q->cv_work);
+    pthread_mutex_unlock(&_q->mutex);
+    for (i=0; i<_q->num_threads-1; i++)
+        pthread_join(_q->threads[i], NULL);
+
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_mutex_destroy(&_q->callback_mutex);
+    pthread_cond_destroy(&_q->cv_work);
+    pthread_cond_destroy(&_q->cv_done);
+    liquid_free(_q->threads);
+    liquid_free(_q->x);
+#endif
+
+    // destroy synchronizers, prototype (stream 0) last
+    for (i=_q->num_streams; i>0; i--)
+        flexframesync_destroy(_q->streams[i-1].fs);
+    liquid_free(_q->streams);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// print multi-stream frame synchronizer object internals
+void flexframesyncbank_print(flexframesyncbank _q)
+{
+    printf("flexframesyncbank:\n");
+    printf("    num streams         :   %-u\n", _q->num_streams);
+    printf("    num threads         :   %-u\n", _q->num_threads);
+}
+
+// reset all synchronizers
+void flexframesyncbank_reset(flexframesyncbank _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_streams; i++)
+        flexframesync_reset(_q->streams[i].fs);
+}
+
+// get number of input streams
+unsigned int flexframesyncbank_get_num_streams(flexframesyncbank _q)
+{
+    return _q->num_streams;
+}
+
+// get synchronizer for stream, e.g. to configure it or read its
+// statistics; must not be executed directly while the bank executes
+flexframesync flexframesyncbank_get_stream(flexframesyncbank _q,
+                                           unsigned int      _i)
+{
+    if (_i >= _q->num_streams) {
+        fprintf(stderr,"error: flexframesyncbank_get_stream(), stream index (%u) exceeds maximum (%u)\n",
+                _i, _q->num_streams-1);
+        exit(1);
+    }
+    return _q->streams[_i].fs;
+}
+
+// push a block of samples from each stream through its synchronizer,
+// returning when every stream has been consumed
+//  _q      :   multi-stream frame synchronizer
+//  _x      :   input samples, one buffer per stream [size: _num_streams x _n]
+//  _n      :   number of input samples per stream
+void flexframesyncbank_execute(flexframesyncbank _q,
+                               float complex **  _x,
+                               unsigned int      _n)
+{
+#if FLEXFRAMESYNCBANK_THREADS
+    if (_q->num_threads > 1) {
+        pthread_mutex_lock(&_q->mutex);
+        memmove(_q->x, _x, _q->num_streams*sizeof(float complex*));
+        _q->n        = _n;
+        _q->next     = 0;
+        _q->num_done = 0;
+        _q->batch++;
+        pthread_cond_broadcast(&_q->cv_work);
+
+        // execute streams alongside worker threads, then wait for batch
+        flexframesyncbank_run_batch(_q);
+        while (_q->num_done < _q->num_streams)
+            pthread_cond_wait(&_q->cv_done, &_q->mutex);
+        pthread_mutex_unlock(&_q->mutex);
+        return;
+    }
+#endif
+
+    unsigned int i;
+    for (i=0; i<_q->num_streams; i++)
+        flexframesync_execute(_q->streams[i].fs, _x[i], _n);
+}
+
+//
+// internal methods
+//
+
+// internal callback: forward frame to user callback with stream userdata
+int flexframesyncbank_callback(unsigned char *  _header,
+                               int              _header_valid,
+                               unsigned char *  _payload,
+                               unsigned int     _payload_len,
+                               int              _payload_valid,
+                               framesyncstats_s _stats,
+                               void *           _userdata)
+{
+    struct flexframesyncbank_stream_s * stream = (struct flexframesyncbank_stream_s*) _userdata;
+    flexframesyncbank q = stream->q;
+
+#if FLEXFRAMESYNCBANK_THREADS
+    pthread_mutex_lock(&q->callback_mutex);
+#endif
+    int rc = q->callback(_header, _header_valid, _payload, _payload_len,
+                         _payload_valid, _stats, stream->userdata);
+#if FLEXFRAMESYNCBANK_THREADS
+    pthread_mutex_unlock(&q->callback_mutex);
+#endif
+    return rc;
+}
+
+#if FLEXFRAMESYNCBANK_THREADS
+// execute remaining streams of current batch (mutex held on entry/exit)
+void flexframesyncbank_run_batch(flexframesyncbank _q)
+{
+    while (_q->next < _q->num_streams) {
+        unsigned int i = _q->next++;
+        pthread_mutex_unlock(&_q->mutex);
+
+        flexframesync_execute(_q->streams[i].fs, _q->x[i], _q->n);
+
+        pthread_mutex_lock(&_q->mutex);
+        if (++_q->num_done == _q->num_streams)
+            pthread_cond_signal(&_q->cv_done);
+    }
+}
+
+// worker thread main loop
+void * flexframesyncbank_worker(void * _arg)
+{
+    flexframesyncbank q = (flexframesyncbank) _arg;
+    unsigned long int batch = 0;
+
+    pthread_mutex_lock(&q->mutex);
+    while (1) {
+        while (q->batch == batch && !q->stop)
+            pthread_cond_wait(&q->cv_work, &q->mutex);
+        if (q->stop)
+            break;
+        batch = q->batch;
+        flexframesyncbank_run_batch(q);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+#endif
@@ -50,7 +50,7 @@ struct framegen64_s {
 // create framegen64 object
 framegen64 framegen64_create()
 {
-    framegen64 q = (framegen64) malloc(sizeof(struct framegen64_s));
+    framegen64 q = (framegen64) liquid_malloc(sizeof(struct framegen64_s));
     q->m    = 7;
     q->beta = 0.3f;
 
@@ -93,7 +93,7 @@ void framegen64_destroy(framegen64 _q)
     qpilotgen_destroy(_q->pilotgen);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print framegen64 object internals
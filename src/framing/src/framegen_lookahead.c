@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// framegen_lookahead.c
+//
+// background frame encoder for batch frame assembly: encodes the next
+// frame of a batch on a helper thread while the current frame's
+// samples are written
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define FRAMEGEN_LOOKAHEAD_THREAD (1)
+#else
+#define FRAMEGEN_LOOKAHEAD_THREAD (0)
+#endif
+
+#if FRAMEGEN_LOOKAHEAD_THREAD
+void * framegen_lookahead_worker(void * _arg);
+#endif
+
+struct framegen_lookahead_s {
+    framegen_lookahead_callback encode; // frame encoding function
+    void *          userdata;           // generator object
+
+#if FRAMEGEN_LOOKAHEAD_THREAD
+    pthread_t       thread;             // encoding thread
+    pthread_mutex_t mutex;              // protects request state
+    pthread_cond_t  cv_request;         // signalled when frame submitted
+    pthread_cond_t  cv_done;            // signalled when frame encoded
+    unsigned int    index;              // index of submitted frame
+    int             pending;            // frame submitted, not yet encoded
+    int             stop;               // thread exit request
+#endif
+};
+
+// create lookahead encoder
+//  _encode     :   function encoding frame '_index' of the batch
+//  _userdata   :   first argument passed to _encode
+framegen_lookahead framegen_lookahead_create(framegen_lookahead_callback _encode,
+                                             void *                      _userdata)
+{
+    framegen_lookahead q = (framegen_lookahead) liquid_malloc(sizeof(struct framegen_lookahead_s));
+    q->encode   = _encode;
+    q->userdata = _userdata;
+
+#if FRAMEGEN_LOOKAHEAD_THREAD
+    q->pending = 0;
+    q->stop    = 0;
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init(&q->cv_request, NULL);
+    pthread_cond_init(&q->cv_done,    NULL);
+    if (pthread_create(&q->thread, NULL, framegen_lookahead_worker, q) != 0) {
+        fprintf(stderr,"error: framegen_lookahead_create(), could not create encoding thread\n");
+        exit(1);
+    }
+#endif
+    return q;
+}
+
+// destroy lookahead encoder, waiting for any submitted frame
+void framegen_lookahead_destroy(framegen_lookahead _q)
+{
+#if FRAMEGEN_LOOKAHEAD_THREAD
+    pthread_mutex_lock(&_q->mutex);
+    _q->stop = 1;
+    pthread_cond_signal(&_q->cv_request);
+    pthread_mutex_unlock(&_q->mutex);
+    pthread_join(_q->thread, NULL);
+
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy(&_q->cv_request);
+    pthread_cond_destroy(&_q->cv_done);
+#endif
+    liquid_free(_q);
+}
+
+// start encoding frame in the background; without thread support the
+// frame is encoded before returning
+//  _q      :   lookahead encoder
+//  _index  :   index of frame within batch
+void framegen_lookahead_submit(framegen_lookahead _q,
+                               unsigned int       _index)
+{
+#if FRAMEGEN_LOOKAHEAD_THREAD
+    pthread_mutex_lock(&_q->mutex);
+    while (_q->pending)
+        pthread_cond_wait(&_q->cv_done, &_q->mutex);
+    _q->index   = _index;
+    _q->pending = 1;
+    pthread_cond_signal(&_q->cv_request);
+    pthread_mutex_unlock(&_q->mutex);
+#else
+    _q->encode(_q->userdata, _index);
+#endif
+}
+
+// wait for submitted frame (if any) to finish encoding
+void framegen_lookahead_wait(framegen_lookahead _q)
+{
+#if FRAMEGEN_LOOKAHEAD_THREAD
+    pthread_mutex_lock(&_q->mutex);
+    while (_q->pending)
+        pthread_cond_wait(&_q->cv_done, &_q->mutex);
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+}
+
+#if FRAMEGEN_LOOKAHEAD_THREAD
+// encoding thread main loop
+void * framegen_lookahead_worker(void * _arg)
+{
+    framegen_lookahead q = (framegen_lookahead) _arg;
+
+    pthread_mutex_lock(&q->mutex);
+    while (1) {
+        // wait for request; finish submitted frame before exiting
+        while (!q->pending && !q->stop)
+            pthread_cond_wait(&q->cv_request, &q->mutex);
+        if (!q->pending)
+            break;
+        unsigned int index = q->index;
+        pthread_mutex_unlock(&q->mutex);
+
+        q->encode(q->userdata, index);
+
+        pthread_mutex_lock(&q->mutex);
+        q->pending = 0;
+        pthread_cond_broadcast(&q->cv_done);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// frameperfstats.c
+//
+// Receiver hot-path performance counters
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "liquid.internal.h"
+
+// reset frameperfstats object
+void frameperfstats_reset(frameperfstats_s * _stats)
+{
+    if (_stats == NULL)
+        return;
+
+    _stats->num_samples_detect   = 0;
+    _stats->num_samples_preamble = 0;
+    _stats->num_samples_header   = 0;
+    _stats->num_samples_payload  = 0;
+    _stats->num_detector_passes  = 0;
+    _stats->num_decode_attempts  = 0;
+    _stats->num_header_rejects   = 0;
+    _stats->time_fec             = 0.0;
+    _stats->time_callback        = 0.0;
+    _stats->num_latency          = 0;
+    _stats->latency_min          = 0.0;
+    _stats->latency_max          = 0.0;
+    _stats->latency_sum          = 0.0;
+
+    unsigned int i;
+    for (i=0; i<FRAMEPERFSTATS_LATENCY_BINS; i++)
+        _stats->latency_hist[i] = 0;
+}
+
+// print frameperfstats object
+void frameperfstats_print(frameperfstats_s * _stats)
+{
+    if (_stats == NULL)
+        return;
+
+    printf("  samples (detect)  : %lu\n", _stats->num_samples_detect);
+    printf("  samples (preamble): %lu\n", _stats->num_samples_preamble);
+    printf("  samples (header)  : %lu\n", _stats->num_samples_header);
+    printf("  samples (payload) : %lu\n", _stats->num_samples_payload);
+    printf("  detector passes   : %lu\n", _stats->num_detector_passes);
+    printf("  decode attempts   : %lu\n", _stats->num_decode_attempts);
+    printf("  header rejects    : %lu\n", _stats->num_header_rejects);
+    printf("  time (fec)        : %12.6f s\n", _stats->time_fec);
+    printf("  time (callback)   : %12.6f s\n", _stats->time_callback);
+    if (_stats->num_latency == 0)
+        return;
+
+    printf("  latency           : %12.3f us (min %.3f, max %.3f, %lu frames)\n",
+            1e6*_stats->latency_sum / (double)_stats->num_latency,
+            1e6*_stats->latency_min,
+            1e6*_stats->latency_max,
+            _stats->num_latency);
+    unsigned int i;
+    for (i=0; i<FRAMEPERFSTATS_LATENCY_BINS; i++) {
+        if (_stats->latency_hist[i] == 0)
+            continue;
+        printf("    < %8u us    : %lu\n", 2u << i, _stats->latency_hist[i]);
+    }
+}
+
+// add execute-to-callback latency [s] to frameperfstats object
+void frameperfstats_add_latency(frameperfstats_s * _stats,
+                                double             _latency)
+{
+    if (_latency < 0.0)
+        _latency = 0.0;
+
+    if (_stats->num_latency == 0 || _latency < _stats->latency_min)
+        _stats->latency_min = _latency;
+    if (_stats->num_latency == 0 || _latency > _stats->latency_max)
+        _stats->latency_max = _latency;
+    _stats->num_latency++;
+    _stats->latency_sum += _latency;
+
+    // histogram bin: floor(log2(latency in us)), saturating
+    unsigned int bin = 0;
+    double us = 1e6*_latency;
+    while (us >= 2.0 && bin < FRAMEPERFSTATS_LATENCY_BINS-1) {
+        us *= 0.5;
+        bin++;
+    }
+    _stats->latency_hist[bin]++;
+}
+
+// accumulate latency statistics of _src into _dst
+void frameperfstats_merge_latency(frameperfstats_s * _dst,
+                                  frameperfstats_s * _src)
+{
+    if (_src->num_latency == 0)
+        return;
+
+    if (_dst->num_latency == 0 || _src->latency_min < _dst->latency_min)
+        _dst->latency_min = _src->latency_min;
+    if (_dst->num_latency == 0 || _src->latency_max > _dst->latency_max)
+        _dst->latency_max = _src->latency_max;
+    _dst->num_latency += _src->num_latency;
+    _dst->latency_sum += _src->latency_sum;
+
+    unsigned int i;
+    for (i=0; i<FRAMEPERFSTATS_LATENCY_BINS; i++)
+        _dst->latency_hist[i] += _src->latency_hist[i];
+}
+
+// monotonic time [s] for perfstats timing
+double frameperfstats_time()
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + 1e-9*(double)t.tv_nsec;
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
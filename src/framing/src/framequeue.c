@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+//
+// framequeue.c
+//
+// queued delivery of received frames: a frame synchronizer's callback
+// is redirected to framequeue_push(), which copies the frame into one
+// of a fixed number of pooled slots. Slots form a single-producer,
+// single-consumer ring indexed by free-running counters, so pushing
+// and popping take no lock. Frames are popped by the application or
+// by a delivery thread which invokes the user's callback.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define FRAMEQUEUE_THREAD (1)
+#else
+#define FRAMEQUEUE_THREAD (0)
+#endif
+
+#if FRAMEQUEUE_THREAD
+void * framequeue_worker(void * _arg);
+#endif
+
+// pooled frame slot; buffers are kept across frames and only grow
+struct framequeue_slot_s {
+    unsigned char *  header;        // header copy [header_len]
+    int              header_valid;  // header valid?
+    unsigned char *  payload;       // payload copy [payload_alloc]
+    unsigned int     payload_len;   // payload length
+    unsigned int     payload_alloc; // payload buffer size
+    int              payload_valid; // payload valid?
+    framesyncstats_s stats;         // frame statistics
+    float complex *  syms;          // frame symbols copy [syms_alloc]
+    unsigned int     syms_alloc;    // frame symbols buffer size
+};
+
+struct framequeue_s {
+    unsigned int                num_slots;  // number of pooled slots
+    unsigned int                header_len; // user header length
+    struct framequeue_slot_s *  slots;      // slots [num_slots]
+    unsigned long int           head;       // frames pushed (producer)
+    unsigned long int           tail;       // frames released (consumer)
+    int                         held;       // consumer holds slot at tail?
+    unsigned int                num_dropped;// frames dropped on full queue
+    framesync_callback          callback;   // user callback
+    void *                      userdata;   // user data
+
+    int                         thread;     // delivery thread running?
+#if FRAMEQUEUE_THREAD
+    pthread_t                   worker;     // delivery thread
+    pthread_mutex_t             mutex;      // protects wake-up
+    pthread_cond_t              cv_push;    // signalled when frame pushed
+    pthread_cond_t              cv_drained; // signalled when queue drained
+    int                         stop;       // thread exit request
+#endif
+};
+
+// create frame queue
+//  _num_slots  :   number of pooled frame slots, _num_slots > 0
+//  _header_len :   user header length [bytes]
+//  _callback   :   user callback (invoked by the delivery thread)
+//  _userdata   :   user data passed to callback
+//  _thread     :   start delivery thread?
+framequeue framequeue_create(unsigned int       _num_slots,
+                             unsigned int       _header_len,
+                             framesync_callback _callback,
+                             void *             _userdata,
+                             int                _thread)
+{
+    if (_num_slots == 0) {
+        fprintf(stderr,"error: framequeue_create(), number of slots must be greater than zero\n");
+        exit(1);
+    }
+
+    framequeue q = (framequeue) liquid_malloc(sizeof(struct framequeue_s));
+    q->num_slots   = _num_slots;
+    q->header_len  = _header_len;
+    q->head        = 0;
+    q->tail        = 0;
+    q->held        = 0;
+    q->num_dropped = 0;
+    q->callback    = _callback;
+    q->userdata    = _userdata;
+    q->thread      = _thread ? 1 : 0;
+
+    q->slots = (struct framequeue_slot_s*) liquid_calloc(_num_slots, sizeof(struct framequeue_slot_s));
+    unsigned int i;
+    for (i=0; i<_num_slots; i++)
+        q->slots[i].header = (unsigned char*) liquid_malloc(_header_len*sizeof(unsigned char));
+
+#if FRAMEQUEUE_THREAD
+    if (q->thread) {
+        q->stop = 0;
+        pthread_mutex_init(&q->mutex, NULL);
+        pthread_cond_init(&q->cv_push, NULL);
+        pthread_cond_init(&q->cv_drained, NULL);
+        if (pthread_create(&q->worker, NULL, framequeue_worker, q) != 0) {
+            fprintf(stderr,"error: framequeue_create(), could not create delivery thread\n");
+            exit(1);
+        }
+    }
+#endif
+    return q;
+}
+
+// destroy frame queue; the delivery thread (if any) delivers frames
+// still queued before exiting, otherwise they are discarded
+void framequeue_destroy(framequeue _q)
+{
+#if FRAMEQUEUE_THREAD
+    if (_q->thread) {
+        pthread_mutex_lock(&_q->mutex);
+        _q->stop = 1;
+        pthread_cond_signal(&_q->cv_push);
+        pthread_mutex_unlock(&_q->mutex);
+        pthread_join(_q->worker, NULL);
+        pthread_mutex_destroy(&_q->mutex);
+        pthread_cond_destroy(&_q->cv_push);
+        pthread_cond_destroy(&_q->cv_drained);
+    }
+#endif
+
+    unsigned int i;
+    for (i=0; i<_q->num_slots; i++) {
+        liquid_free(_q->slots[i].header);
+        liquid_free(_q->slots[i].payload);
+        liquid_free(_q->slots[i].syms);
+    }
+    liquid_free(_q->slots);
+    liquid_free(_q);
+}
+
+// (re)configure queued delivery for a frame synchronizer whose callback
+// and user data are held in *_callback and *_userdata. An existing
+// queue is destroyed first and the user's callback restored; with
+// _num_slots > 0 a new queue takes over the user's callback and the
+// synchronizer's callback is redirected to framequeue_push().
+//  _q          :   existing queue, or NULL
+//  _num_slots  :   number of pooled frame slots (0: direct delivery)
+//  _header_len :   user header length [bytes]
+//  _thread     :   start delivery thread?
+//  _callback   :   synchronizer's callback, updated in place
+//  _userdata   :   synchronizer's user data, updated in place
+framequeue framequeue_reconfigure(framequeue           _q,
+                                  unsigned int         _num_slots,
+                                  unsigned int         _header_len,
+                                  int                  _thread,
+                                  framesync_callback * _callback,
+                                  void **              _userdata)
+{
+    if (_q != NULL) {
+        *_callback = _q->callback;
+        *_userdata = _q->userdata;
+        framequeue_destroy(_q);
+    }
+    if (_num_slots == 0)
+        return NULL;
+
+    framequeue q = framequeue_create(_num_slots, _header_len, *_callback, *_userdata, _thread);
+    *_callback = framequeue_push;
+    *_userdata = (void*)q;
+    return q;
+}
+
+// get memory footprint of queue and its buffers [bytes]
+unsigned long int framequeue_get_memory_usage(framequeue _q)
+{
+    unsigned long int n = sizeof(struct framequeue_s) +
+                          _q->num_slots*(sizeof(struct framequeue_slot_s) + _q->header_len);
+    unsigned int i;
+    for (i=0; i<_q->num_slots; i++) {
+        n += _q->slots[i].payload_alloc*sizeof(unsigned char);
+        n += _q->slots[i].syms_alloc*sizeof(float complex);
+    }
+    return n;
+}
+
+// get number of frames dropped because every slot was occupied
+unsigned int framequeue_get_num_dropped(framequeue _q)
+{
+    return __atomic_load_n(&_q->num_dropped, __ATOMIC_RELAXED);
+}
+
+// copy frame into next free slot; has the framesync_callback signature
+// with the queue as user data. Never blocks: the frame is dropped and
+// counted if every slot is occupied.
+int framequeue_push(unsigned char *  _header,
+                    int              _header_valid,
+                    unsigned char *  _payload,
+                    unsigned int     _payload_len,
+                    int              _payload_valid,
+                    framesyncstats_s _stats,
+                    void *           _userdata)
+{
+    framequeue q = (framequeue) _userdata;
+
+    // slots up to the tail (including one held by the consumer) are busy
+    unsigned long int tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    if (q->head - tail >= q->num_slots) {
+        __atomic_store_n(&q->num_dropped, q->num_dropped+1, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    // slot is owned by the producer until published
+    struct framequeue_slot_s * s = &q->slots[q->head % q->num_slots];
+    memmove(s->header, _header, q->header_len*sizeof(unsigned char));
+    s->header_valid  = _header_valid;
+    s->payload_len   = _payload != NULL ? _payload_len : 0;
+    s->payload_valid = _payload_valid;
+    if (s->payload_len > s->payload_alloc) {
+        s->payload = (unsigned char*) liquid_realloc(s->payload, s->payload_len*sizeof(unsigned char));
+        s->payload_alloc = s->payload_len;
+    }
+    if (s->payload_len > 0)
+        memmove(s->payload, _payload, s->payload_len*sizeof(unsigned char));
+
+    s->stats = _stats;
+    if (_stats.framesyms != NULL && _stats.num_framesyms > 0) {
+        if (_stats.num_framesyms > s->syms_alloc) {
+            s->syms = (float complex*) liquid_realloc(s->syms, _stats.num_framesyms*sizeof(float complex));
+            s->syms_alloc = _stats.num_framesyms;
+        }
+        memmove(s->syms, _stats.framesyms, _stats.num_framesyms*sizeof(float complex));
+        s->stats.framesyms = s->syms;
+    } else {
+        s->stats.framesyms     = NULL;
+        s->stats.num_framesyms = 0;
+    }
+
+    // publish slot
+    __atomic_store_n(&q->head, q->head+1, __ATOMIC_RELEASE);
+
+#if FRAMEQUEUE_THREAD
+    if (q->thread) {
+        pthread_mutex_lock(&q->mutex);
+        pthread_cond_signal(&q->cv_push);
+        pthread_mutex_unlock(&q->mutex);
+    }
+#else
+    // no thread support: deliver before returning
+    if (q->thread) {
+        framesync_frame_s frame;
+        while (framequeue_pop(q, &frame)) {
+            if (q->callback != NULL)
+                q->callback(frame.header, frame.header_valid, frame.payload, frame.payload_len,
+                            frame.payload_valid, frame.stats, q->userdata);
+        }
+    }
+#endif
+    return 0;
+}
+
+// pop oldest frame, releasing the slot of the previously popped frame;
+// returns 1 if a frame was popped, 0 if the queue is empty
+//  _q      :   frame queue
+//  _frame  :   frame, buffers valid until the next pop [output]
+int framequeue_pop(framequeue          _q,
+                   framesync_frame_s * _frame)
+{
+    if (_q->held) {
+        __atomic_store_n(&_q->tail, _q->tail+1, __ATOMIC_RELEASE);
+        _q->held = 0;
+    }
+
+    if (__atomic_load_n(&_q->head, __ATOMIC_ACQUIRE) == _q->tail)
+        return 0;
+
+    struct framequeue_slot_s * s = &_q->slots[_q->tail % _q->num_slots];
+    _frame->header        = s->header;
+    _frame->header_len    = _q->header_len;
+    _frame->header_valid  = s->header_valid;
+    _frame->payload       = s->payload_len > 0 ? s->payload : NULL;
+    _frame->payload_len   = s->payload_len;
+    _frame->payload_valid = s->payload_valid;
+    _frame->stats         = s->stats;
+    _q->held = 1;
+    return 1;
+}
+
+// block until the delivery thread (if any) has delivered every frame
+// pushed so far
+void framequeue_wait(framequeue _q)
+{
+#if FRAMEQUEUE_THREAD
+    if (!_q->thread)
+        return;
+    pthread_mutex_lock(&_q->mutex);
+    while (__atomic_load_n(&_q->tail, __ATOMIC_ACQUIRE) != _q->head)
+        pthread_cond_wait(&_q->cv_drained, &_q->mutex);
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+}
+
+// is queue drained by a delivery thread?
+int framequeue_is_threaded(framequeue _q)
+{
+    return _q->thread;
+}
+
+#if FRAMEQUEUE_THREAD
+// delivery thread main loop
+void * framequeue_worker(void * _arg)
+{
+    framequeue q = (framequeue) _arg;
+    framesync_frame_s frame;
+
+    while (1) {
+        // deliver everything queued without holding the lock
+        while (framequeue_pop(q, &frame)) {
+            if (q->callback != NULL)
+                q->callback(frame.header, frame.header_valid, frame.payload, frame.payload_len,
+                            frame.payload_valid, frame.stats, q->userdata);
+        }
+
+        // wait for frame (popping released the last slot); exit only
+        // once the queue has drained
+        pthread_mutex_lock(&q->mutex);
+        pthread_cond_broadcast(&q->cv_drained);
+        while (__atomic_load_n(&q->head, __ATOMIC_ACQUIRE) == q->tail && !q->stop)
+            pthread_cond_wait(&q->cv_push, &q->mutex);
+        int done = q->stop && __atomic_load_n(&q->head, __ATOMIC_ACQUIRE) == q->tail;
+        pthread_mutex_unlock(&q->mutex);
+        if (done)
+            break;
+    }
+    return NULL;
+}
+#endif
@@ -42,25 +42,34 @@
 
 #define FRAMESYNC64_ENABLE_EQ       0
 
+// maximum number of samples mixed down at once while receiving
+#define FRAMESYNC64_RUN_LEN         (256)
+
 // push samples through detection stage
 void framesync64_execute_seekpn(framesync64   _q,
                                 float complex _x);
 
-// step receiver mixer, matched filter, decimator
+// receive run of samples after frame detection, returning the number
+// of samples consumed (fewer than _n when the frame ends in the run)
+unsigned int framesync64_execute_rx(framesync64     _q,
+                                    float complex * _x,
+                                    unsigned int    _n);
+
+// step receiver matched filter, decimator
 //  _q      :   frame synchronizer
-//  _x      :   input sample
+//  _x      :   input sample, mixed down
 //  _y      :   output symbol
 int framesync64_step(framesync64     _q,
                      float complex   _x,
                      float complex * _y);
 
-// push samples through synchronizer, saving received p/n symbols
-void framesync64_execute_rxpreamble(framesync64   _q,
-                                    float complex _x);
+// save received p/n symbol
+void framesync64_rxpreamble_symbol(framesync64   _q,
+                                   float complex _sym);
 
-// receive payload symbols
-void framesync64_execute_rxpayload(framesync64   _q,
-                                   float complex _x);
+// save received payload symbol, decoding payload when complete
+void framesync64_rxpayload_symbol(framesync64   _q,
+                                  float complex _sym);
 
 // framesync64 object structure
 struct framesync64_s {
@@ -68,6 +77,10 @@ struct framesync64_s {
     framesync_callback  callback;   // user-defined callback function
     void *              userdata;   // user-defined data structure
     framesyncstats_s    framestats; // frame statistic object
+    frameperfstats_s    perfstats;  // receiver performance counters
+    int           perfstats_enabled;// gather performance counters?
+    unsigned int  perfstats_passes; // detector passes at last update
+    double        perfstats_t_execute; // time of last execute() call
     
     // synchronizer objects
     unsigned int        m;          // filter delay (symbols)
@@ -91,6 +104,7 @@ struct framesync64_s {
     // preamble
     float complex preamble_pn[64];  // known 64-symbol p/n sequence
     float complex preamble_rx[64];  // received p/n symbols
+    float complex run_buf[FRAMESYNC64_RUN_LEN]; // mixed-down samples
     
     // payload decoder
     float complex payload_rx [630]; // received payload symbols with pilots
@@ -122,7 +136,7 @@ struct framesync64_s {
 framesync64 framesync64_create(framesync_callback _callback,
                                void *             _userdata)
 {
-    framesync64 q = (framesync64) malloc(sizeof(struct framesync64_s));
+    framesync64 q = (framesync64) liquid_malloc(sizeof(struct framesync64_s));
     q->callback = _callback;
     q->userdata = _userdata;
     q->m        = 7;    // filter delay (symbols)
@@ -180,6 +194,10 @@ framesync64 framesync64_create(framesync_callback _callback,
 
     // reset state and return
     framesync64_reset(q);
+
+    // performance counters (disabled by default)
+    q->perfstats_enabled = 0;
+    frameperfstats_reset(&q->perfstats);
     return q;
 }
 
@@ -204,13 +222,15 @@ void framesync64_destroy(framesync64 _q)
 #endif
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print frame synchronizer object internals
 void framesync64_print(framesync64 _q)
 {
     printf("framesync64:\n");
+    if (_q->perfstats_enabled)
+        frameperfstats_print(&_q->perfstats);
 }
 
 // reset frame synchronizer object
@@ -229,6 +249,7 @@ void framesync64_reset(framesync64 _q)
     _q->state           = FRAMESYNC64_STATE_DETECTFRAME;
     _q->preamble_counter= 0;
     _q->payload_counter = 0;
+    FRAMETRACE(_q, "framesync64", LIQUID_FRAMETRACE_STATE, _q->state);
     
     // reset frame statistics
     _q->framestats.evm = 0.0f;
@@ -242,29 +263,27 @@ void framesync64_execute(framesync64     _q,
                          float complex * _x,
                          unsigned int    _n)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
+    if (_q->perfstats_enabled)
+        _q->perfstats_t_execute = frameperfstats_time();
+
+    unsigned int i = 0;
+    while (i < _n) {
+        if (_q->state != FRAMESYNC64_STATE_DETECTFRAME) {
+            // receive frame symbols
+            i += framesync64_execute_rx(_q, &_x[i], _n - i);
+            continue;
+        }
+
 #if DEBUG_FRAMESYNC64
         if (_q->debug_enabled)
             windowcf_push(_q->debug_x, _x[i]);
 #endif
-        switch (_q->state) {
-        case FRAMESYNC64_STATE_DETECTFRAME:
-            // detect frame (look for p/n sequence)
-            framesync64_execute_seekpn(_q, _x[i]);
-            break;
-        case FRAMESYNC64_STATE_RXPREAMBLE:
-            // receive p/n sequence symbols
-            framesync64_execute_rxpreamble(_q, _x[i]);
-            break;
-        case FRAMESYNC64_STATE_RXPAYLOAD:
-            // receive payload symbols
-            framesync64_execute_rxpayload(_q, _x[i]);
-            break;
-        default:
-            fprintf(stderr,"error: framesync64_exeucte(), unknown/unsupported state\n");
-            exit(1);
-        }
+        if (_q->perfstats_enabled)
+            _q->perfstats.num_samples_detect++;
+
+        // detect frame (look for p/n sequence)
+        framesync64_execute_seekpn(_q, _x[i]);
+        i++;
     }
 }
 
@@ -282,6 +301,14 @@ void framesync64_execute_seekpn(framesync64   _q,
     // push through pre-demod synchronizer
     float complex * v = qdetector_cccf_execute(_q->detector, _x);
 
+    // count correlation passes (blocks not bypassed by energy gate)
+    if (_q->perfstats_enabled) {
+        unsigned int passes = qdetector_cccf_gate_get_num_blocks (_q->detector) -
+                              qdetector_cccf_gate_get_num_skipped(_q->detector);
+        _q->perfstats.num_detector_passes += passes - _q->perfstats_passes;
+        _q->perfstats_passes = passes;
+    }
+
     // check if frame has been detected
     if (v != NULL) {
         // get estimates
@@ -313,6 +340,8 @@ void framesync64_execute_seekpn(framesync64   _q,
 
         // update state
         _q->state = FRAMESYNC64_STATE_RXPREAMBLE;
+        FRAMETRACE(_q, "framesync64", LIQUID_FRAMETRACE_FRAME_DETECTED, 0);
+        FRAMETRACE(_q, "framesync64", LIQUID_FRAMETRACE_STATE, _q->state);
 
         // run buffered samples through synchronizer
         unsigned int buf_len = qdetector_cccf_get_buf_len(_q->detector);
@@ -320,25 +349,64 @@ void framesync64_execute_seekpn(framesync64   _q,
     }
 }
 
-// step receiver mixer, matched filter, decimator
+// receive run of samples after frame detection: the run is mixed down
+// as a block, then each sample is pushed through the matched filter
+// and decimator, saving the resulting preamble or payload symbols
+//  _q      :   frame synchronizer object
+//  _x      :   input sample array [size: _n x 1]
+//  _n      :   number of input samples
+unsigned int framesync64_execute_rx(framesync64     _q,
+                                    float complex * _x,
+                                    unsigned int    _n)
+{
+    // mix samples down; the mixer is re-initialized on the next
+    // detection, so overshooting the end of the frame is harmless
+    unsigned int n = _n < FRAMESYNC64_RUN_LEN ? _n : FRAMESYNC64_RUN_LEN;
+    nco_crcf_mix_block_down(_q->mixer, _x, _q->run_buf, n);
+
+    unsigned int i = 0;
+    while (i < n && _q->state != FRAMESYNC64_STATE_DETECTFRAME) {
+#if DEBUG_FRAMESYNC64
+        if (_q->debug_enabled)
+            windowcf_push(_q->debug_x, _x[i]);
+#endif
+        int rxpreamble = _q->state == FRAMESYNC64_STATE_RXPREAMBLE;
+        if (_q->perfstats_enabled) {
+            if (rxpreamble) _q->perfstats.num_samples_preamble++;
+            else            _q->perfstats.num_samples_payload++;
+        }
+
+        // step matched filter, decimator
+        float complex mf_out = 0.0f;
+        int sample_available = framesync64_step(_q, _q->run_buf[i++], &mf_out);
+        if (!sample_available)
+            continue;
+
+        // save symbol
+        if (rxpreamble)
+            framesync64_rxpreamble_symbol(_q, mf_out);
+        else
+            framesync64_rxpayload_symbol(_q, mf_out);
+    }
+    return i;
+}
+
+// step receiver matched filter, decimator
 //  _q      :   frame synchronizer
-//  _x      :   input sample
+//  _x      :   input sample, mixed down
 //  _y      :   output symbol
 int framesync64_step(framesync64     _q,
                      float complex   _x,
                      float complex * _y)
 {
-    // mix sample down
     float complex v;
-    nco_crcf_mix_down(_q->mixer, _x, &v);
-    nco_crcf_step    (_q->mixer);
-    
+
     // push sample into filterbank
-    firpfb_crcf_push   (_q->mf, v);
-    firpfb_crcf_execute(_q->mf, _q->pfb_index, &v);
+    firpfb_crcf_push(_q->mf, _x);
 
 #if FRAMESYNC64_ENABLE_EQ
     // push sample through equalizer
+    firpfb_crcf_execute(_q->mf, _q->pfb_index, &v);
     eqlms_cccf_push(_q->equalizer, v);
 #endif
 
@@ -346,11 +414,14 @@ int framesync64_step(framesync64     _q,
     _q->mf_counter++;
     int sample_available = (_q->mf_counter >= 1) ? 1 : 0;
     
-    // set output sample if available
+    // set output sample if available, computing the matched filter
+    // output only for the samples kept by the decimator
     if (sample_available) {
 #if FRAMESYNC64_ENABLE_EQ
         // compute equalizer output
         eqlms_cccf_execute(_q->equalizer, &v);
+#else
+        firpfb_crcf_execute(_q->mf, _q->pfb_index, &v);
 #endif
 
         // set output
@@ -364,105 +435,159 @@ int framesync64_step(framesync64     _q,
     return sample_available;
 }
 
-// execute synchronizer, receiving p/n sequence
-//  _q     :   frame synchronizer object
-//  _x      :   input sample
-//  _sym    :   demodulated symbol
-void framesync64_execute_rxpreamble(framesync64   _q,
-                                    float complex _x)
+// save received p/n symbol
+//  _q      :   frame synchronizer object
+//  _sym    :   matched filter output symbol
+void framesync64_rxpreamble_symbol(framesync64   _q,
+                                   float complex _sym)
 {
-    // step synchronizer
-    float complex mf_out = 0.0f;
-    int sample_available = framesync64_step(_q, _x, &mf_out);
-
-    // compute output if timeout
-    if (sample_available) {
-
-        // save output in p/n symbols buffer
+    // save output in p/n symbols buffer
 #if FRAMESYNC64_ENABLE_EQ
-        unsigned int delay = 2*_q->m + 3; // delay from matched filter and equalizer
+    unsigned int delay = 2*_q->m + 3; // delay from matched filter and equalizer
 #else
-        unsigned int delay = 2*_q->m;     // delay from matched filter
+    unsigned int delay = 2*_q->m;     // delay from matched filter
 #endif
-        if (_q->preamble_counter >= delay) {
-            unsigned int index = _q->preamble_counter-delay;
+    if (_q->preamble_counter >= delay) {
+        unsigned int index = _q->preamble_counter-delay;
 
-            _q->preamble_rx[index] = mf_out;
-        
+        _q->preamble_rx[index] = _sym;
+    
 #if FRAMESYNC64_ENABLE_EQ
-            // train equalizer
-            eqlms_cccf_step(_q->equalizer, _q->preamble_pn[index], mf_out);
+        // train equalizer
+        eqlms_cccf_step(_q->equalizer, _q->preamble_pn[index], _sym);
 #endif
-        }
+    }
 
-        // update p/n counter
-        _q->preamble_counter++;
+    // update p/n counter
+    _q->preamble_counter++;
 
-        // update state
-        if (_q->preamble_counter == 64 + delay)
-            _q->state = FRAMESYNC64_STATE_RXPAYLOAD;
+    // update state
+    if (_q->preamble_counter == 64 + delay) {
+        _q->state = FRAMESYNC64_STATE_RXPAYLOAD;
+        FRAMETRACE(_q, "framesync64", LIQUID_FRAMETRACE_STATE, _q->state);
     }
 }
 
-// execute synchronizer, receiving payload
+// save received payload symbol, decoding payload when complete
 //  _q      :   frame synchronizer object
-//  _x      :   input sample
-//  _sym    :   demodulated symbol
-void framesync64_execute_rxpayload(framesync64   _q,
-                                   float complex _x)
+//  _sym    :   matched filter output symbol
+void framesync64_rxpayload_symbol(framesync64   _q,
+                                  float complex _sym)
 {
-    // step synchronizer
-    float complex mf_out = 0.0f;
-    int sample_available = framesync64_step(_q, _x, &mf_out);
+    // save payload symbols (modem input/output)
+    _q->payload_rx[_q->payload_counter] = _sym;
+
+    // increment counter
+    _q->payload_counter++;
+
+    if (_q->payload_counter == 630) {
+        // recover data symbols from pilots
+        qpilotsync_execute(_q->pilotsync, _q->payload_rx, _q->payload_sym);
+
+        // decode payload
+        double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+        _q->payload_valid = qpacketmodem_decode(_q->dec,
+                                                _q->payload_sym,
+                                                _q->payload_dec);
+        FRAMETRACE(_q, "framesync64", LIQUID_FRAMETRACE_PAYLOAD_DECODED, _q->payload_valid);
+        if (_q->perfstats_enabled) {
+            _q->perfstats.num_decode_attempts++;
+            _q->perfstats.time_fec += frameperfstats_time() - t0;
+            t0 = frameperfstats_time();
+        }
 
-    // compute output if timeout
-    if (sample_available) {
-        // save payload symbols (modem input/output)
-        _q->payload_rx[_q->payload_counter] = mf_out;
-
-        // increment counter
-        _q->payload_counter++;
-
-        if (_q->payload_counter == 630) {
-            // recover data symbols from pilots
-            qpilotsync_execute(_q->pilotsync, _q->payload_rx, _q->payload_sym);
-
-            // decode payload
-            _q->payload_valid = qpacketmodem_decode(_q->dec,
-                                                    _q->payload_sym,
-                                                    _q->payload_dec);
-
-            // invoke callback
-            if (_q->callback != NULL) {
-                // set framestats internals
-                _q->framestats.evm           = 0.0f; //20*log10f(sqrtf(_q->framestats.evm / 600));
-                _q->framestats.rssi          = 20*log10f(_q->gamma_hat);
-                _q->framestats.cfo           = nco_crcf_get_frequency(_q->mixer);
-                _q->framestats.framesyms     = _q->payload_sym;
-                _q->framestats.num_framesyms = 600;
-                _q->framestats.mod_scheme    = LIQUID_MODEM_QPSK;
-                _q->framestats.mod_bps       = 2;
-                _q->framestats.check         = LIQUID_CRC_24;
-                _q->framestats.fec0          = LIQUID_FEC_NONE;
-                _q->framestats.fec1          = LIQUID_FEC_GOLAY2412;
-
-                // invoke callback method
-                _q->callback(&_q->payload_dec[0],   // header is first 8 bytes
-                             _q->payload_valid,
-                             &_q->payload_dec[8],   // payload is last 64 bytes
-                             64,
-                             _q->payload_valid,
-                             _q->framestats,
-                             _q->userdata);
-            }
-
-            // reset frame synchronizer
-            framesync64_reset(_q);
-            return;
+        // invoke callback
+        if (_q->callback != NULL) {
+            // set framestats internals
+            _q->framestats.evm           = 0.0f; //20*log10f(sqrtf(_q->framestats.evm / 600));
+            _q->framestats.rssi          = 20*log10f(_q->gamma_hat);
+            _q->framestats.cfo           = nco_crcf_get_frequency(_q->mixer);
+            _q->framestats.framesyms     = _q->payload_sym;
+            _q->framestats.num_framesyms = 600;
+            _q->framestats.mod_scheme    = LIQUID_MODEM_QPSK;
+            _q->framestats.mod_bps       = 2;
+            _q->framestats.check         = LIQUID_CRC_24;
+            _q->framestats.fec0          = LIQUID_FEC_NONE;
+            _q->framestats.fec1          = LIQUID_FEC_GOLAY2412;
+
+            // invoke callback method
+            _q->callback(&_q->payload_dec[0],   // header is first 8 bytes
+                         _q->payload_valid,
+                         &_q->payload_dec[8],   // payload is last 64 bytes
+                         64,
+                         _q->payload_valid,
+                         _q->framestats,
+                         _q->userdata);
+        }
+        if (_q->perfstats_enabled) {
+            _q->perfstats.time_callback += frameperfstats_time() - t0;
+            frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
         }
+
+        // reset frame synchronizer
+        framesync64_reset(_q);
     }
 }
 
+// enable energy gate on frame detector, bypassing the preamble
+// correlation while the input stays near the noise floor
+void framesync64_gate_enable(framesync64 _q)
+{
+    qdetector_cccf_gate_enable(_q->detector);
+}
+
+// disable energy gate on frame detector
+void framesync64_gate_disable(framesync64 _q)
+{
+    qdetector_cccf_gate_disable(_q->detector);
+}
+
+// set energy gate threshold above noise floor [dB]
+void framesync64_gate_set_threshold(framesync64 _q,
+                                    float       _threshold)
+{
+    qdetector_cccf_gate_set_threshold(_q->detector, _threshold);
+}
+
+// number of detector blocks processed
+unsigned int framesync64_gate_get_num_blocks(framesync64 _q)
+{
+    return qdetector_cccf_gate_get_num_blocks(_q->detector);
+}
+
+// number of detector blocks bypassed by energy gate
+unsigned int framesync64_gate_get_num_skipped(framesync64 _q)
+{
+    return qdetector_cccf_gate_get_num_skipped(_q->detector);
+}
+
+// enable receiver performance counters
+void framesync64_perfstats_enable(framesync64 _q)
+{
+    _q->perfstats_enabled = 1;
+    _q->perfstats_passes  = qdetector_cccf_gate_get_num_blocks (_q->detector) -
+                            qdetector_cccf_gate_get_num_skipped(_q->detector);
+}
+
+// disable receiver performance counters
+void framesync64_perfstats_disable(framesync64 _q)
+{
+    _q->perfstats_enabled = 0;
+}
+
+// reset receiver performance counters
+void framesync64_reset_perfstats(framesync64 _q)
+{
+    frameperfstats_reset(&_q->perfstats);
+}
+
+// retrieve receiver performance counters (the header is carried in
+// the payload, so no samples are attributed to a header state)
+frameperfstats_s framesync64_get_perfstats(framesync64 _q)
+{
+    return _q->perfstats;
+}
+
 // enable debugging
 void framesync64_debug_enable(framesync64 _q)
 {
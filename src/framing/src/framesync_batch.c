@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// framesync_batch.c
+//
+// batch decoding of recorded captures: the capture is split into
+// overlapping shards decoded by independent synchronizers across a pool
+// of threads; frames are attributed to the shard whose span contains the
+// position at which their decoding completed, which removes duplicates
+// found in the overlaps
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define FRAMESYNC_BATCH_THREADS (1)
+#else
+#define FRAMESYNC_BATCH_THREADS (0)
+#endif
+
+// number of shards per thread, for load balancing
+#define FRAMESYNC_BATCH_SHARDS_PER_THREAD (4)
+
+// frame found by a shard
+struct framesync_batch_frame_s {
+    unsigned long int position;     // capture index at end of block
+    unsigned char *   header;       // header copy [header_len]
+    int               header_valid; // header valid?
+    unsigned char *   payload;      // payload copy [payload_len]
+    unsigned int      payload_len;  // payload length
+    int               payload_valid;// payload valid?
+    framesyncstats_s  stats;        // frame statistics (no framesyms)
+};
+
+// frames found by a shard, in capture order
+struct framesync_batch_shard_s {
+    struct framesync_batch_frame_s * frames;
+    unsigned int                     num_frames;
+};
+
+struct framesync_batch_job_s {
+    const framesync_batch_s *  sync;        // synchronizer operations
+    liquid_float_complex *     x;           // capture samples
+    unsigned long int          n;           // number of samples
+    unsigned long int          overlap;     // overlap, multiple of block
+    unsigned long int          shard_len;   // shard span, multiple of block
+    unsigned int               num_shards;  // number of shards
+    struct framesync_batch_shard_s * shards;// frames per shard [num_shards]
+    unsigned int               next;        // next unclaimed shard
+#if FRAMESYNC_BATCH_THREADS
+    pthread_mutex_t            mutex;       // protects next
+#endif
+};
+
+// per-thread synchronizer
+struct framesync_batch_worker_s {
+    struct framesync_batch_job_s * job;     // parent job
+    void *              sync;               // synchronizer
+    unsigned int        shard;              // shard being decoded
+    unsigned long int   position;           // capture index at end of block
+};
+
+// synchronizer callback: keep frames whose position lies in the span
+// of the shard being decoded
+int framesync_batch_frame(unsigned char *  _header,
+                          int              _header_valid,
+                          unsigned char *  _payload,
+                          unsigned int     _payload_len,
+                          int              _payload_valid,
+                          framesyncstats_s _stats,
+                          void *           _userdata);
+
+// decode shards until none remain
+void * framesync_batch_worker(void * _arg);
+
+// decode capture in overlapping shards across a pool of threads,
+// returning the number of frames reported
+//  _sync       :   synchronizer operations
+//  _x          :   capture samples [size: _n x 1]
+//  _n          :   number of samples
+//  _overlap    :   shard overlap [samples], at least the longest frame
+//  _num_threads:   number of threads, including the caller
+//  _callback   :   frame callback, invoked on the calling thread
+//  _userdata   :   user-defined data passed to callback
+unsigned int framesync_batch_decode(const framesync_batch_s * _sync,
+                                    liquid_float_complex *    _x,
+                                    unsigned long int         _n,
+                                    unsigned int              _overlap,
+                                    unsigned int              _num_threads,
+                                    framesync_batch_callback  _callback,
+                                    void *                    _userdata)
+{
+    // validate input
+    if (_sync == NULL || _sync->create == NULL || _sync->execute == NULL ||
+        _sync->reset == NULL || _sync->destroy == NULL)
+    {
+        fprintf(stderr,"error: framesync_batch_decode(), synchronizer operations cannot be NULL\n");
+        exit(1);
+    } else if (_num_threads == 0) {
+        fprintf(stderr,"error: framesync_batch_decode(), number of threads must be greater than zero\n");
+        exit(1);
+    }
+#if !FRAMESYNC_BATCH_THREADS
+    if (_num_threads > 1)
+        fprintf(stderr,"warning: framesync_batch_decode(), built without pthreads; decoding serially\n");
+    _num_threads = 1;
+#endif
+
+    // shards start on block boundaries so that every shard pushes the
+    // same blocks through its synchronizer and reports a frame seen by
+    // two shards at the same position
+    unsigned long int B = LIQUID_FRAMESYNC_BATCH_BLOCK;
+    struct framesync_batch_job_s job;
+    job.sync    = _sync;
+    job.x       = _x;
+    job.n       = _n;
+    job.overlap = ((_overlap + B - 1) / B) * B;
+    if (_num_threads == 1) {
+        job.shard_len = _n;
+    } else {
+        unsigned long int d = FRAMESYNC_BATCH_SHARDS_PER_THREAD*_num_threads;
+        job.shard_len = (_n + d - 1) / d;
+        if (job.shard_len < 4*job.overlap)
+            job.shard_len = 4*job.overlap;
+    }
+    job.shard_len = ((job.shard_len + B - 1) / B) * B;
+    if (job.shard_len == 0)
+        job.shard_len = B;
+    job.num_shards = (_n + job.shard_len - 1) / job.shard_len;
+    job.shards = (struct framesync_batch_shard_s*) liquid_calloc(job.num_shards > 0 ? job.num_shards : 1,
+                                                                 sizeof(struct framesync_batch_shard_s));
+    job.next = 0;
+
+    unsigned int num_threads = _num_threads < job.num_shards ? _num_threads : job.num_shards;
+    if (num_threads == 0)
+        num_threads = 1;
+
+    // synchronizers are created serially: some share state which may
+    // only be created and destroyed from one thread at a time
+    struct framesync_batch_worker_s w[num_threads];
+    unsigned int i, j;
+    for (i=0; i<num_threads; i++) {
+        w[i].job      = &job;
+        w[i].shard    = 0;
+        w[i].position = 0;
+        w[i].sync     = _sync->create(framesync_batch_frame, &w[i], _sync->context);
+    }
+
+#if FRAMESYNC_BATCH_THREADS
+    pthread_mutex_init(&job.mutex, NULL);
+
+    // the calling thread decodes shards as well
+    pthread_t threads[num_threads];
+    for (i=1; i<num_threads; i++) {
+        if (pthread_create(&threads[i], NULL, framesync_batch_worker, &w[i]) != 0) {
+            fprintf(stderr,"error: framesync_batch_decode(), could not create thread\n");
+            exit(1);
+        }
+    }
+    framesync_batch_worker(&w[0]);
+    for (i=1; i<num_threads; i++)
+        pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&job.mutex);
+#else
+    framesync_batch_worker(&w[0]);
+#endif
+
+    for (i=0; i<num_threads; i++)
+        _sync->destroy(w[i].sync);
+
+    // report frames in capture order
+    unsigned int num_frames = 0;
+    for (i=0; i<job.num_shards; i++) {
+        struct framesync_batch_shard_s * s = &job.shards[i];
+        for (j=0; j<s->num_frames; j++) {
+            struct framesync_batch_frame_s * f = &s->frames[j];
+            if (_callback != NULL) {
+                _callback(f->position, f->header, f->header_valid,
+                          f->payload, f->payload_len, f->payload_valid,
+                          f->stats, _userdata);
+            }
+            liquid_free(f->header);
+            liquid_free(f->payload);
+        }
+        num_frames += s->num_frames;
+        liquid_free(s->frames);
+    }
+    liquid_free(job.shards);
+    return num_frames;
+}
+
+//
+// synchronizer adapters
+//
+
+static void * framesync_batch_flexframesync_create(framesync_callback _callback,
+                                                   void *             _userdata,
+                                                   void *             _context)
+{
+    return flexframesync_create(_callback, _userdata);
+}
+
+static void framesync_batch_flexframesync_execute(void *                 _q,
+                                                  liquid_float_complex * _x,
+                                                  unsigned int           _n)
+{
+    flexframesync_execute((flexframesync)_q, _x, _n);
+}
+
+static void framesync_batch_flexframesync_reset(void * _q)
+{
+    flexframesync_reset((flexframesync)_q);
+}
+
+static void framesync_batch_flexframesync_destroy(void * _q)
+{
+    flexframesync_destroy((flexframesync)_q);
+}
+
+// decode capture with default flexframesync synchronizers
+unsigned int flexframesync_decode_batch(liquid_float_complex *   _x,
+                                        unsigned long int        _n,
+                                        unsigned int             _overlap,
+                                        unsigned int             _num_threads,
+                                        framesync_batch_callback _callback,
+                                        void *                   _userdata)
+{
+    framesync_batch_s sync;
+    sync.create     = framesync_batch_flexframesync_create;
+    sync.execute    = framesync_batch_flexframesync_execute;
+    sync.reset      = framesync_batch_flexframesync_reset;
+    sync.destroy    = framesync_batch_flexframesync_destroy;
+    sync.header_len = FLEXFRAME_H_USER;
+    sync.context    = NULL;
+    return framesync_batch_decode(&sync, _x, _n, _overlap, _num_threads, _callback, _userdata);
+}
+
+// ofdmflexframesync configuration
+struct framesync_batch_ofdm_s {
+    unsigned int    M;
+    unsigned int    cp_len;
+    unsigned int    taper_len;
+    unsigned char * p;
+};
+
+static void * framesync_batch_ofdmflexframesync_create(framesync_callback _callback,
+                                                       void *             _userdata,
+                                                       void *             _context)
+{
+    struct framesync_batch_ofdm_s * c = (struct framesync_batch_ofdm_s*) _context;
+    return ofdmflexframesync_create(c->M, c->cp_len, c->taper_len, c->p, _callback, _userdata);
+}
+
+static void framesync_batch_ofdmflexframesync_execute(void *                 _q,
+                                                      liquid_float_complex * _x,
+                                                      unsigned int           _n)
+{
+    ofdmflexframesync_execute((ofdmflexframesync)_q, _x, _n);
+}
+
+static void framesync_batch_ofdmflexframesync_reset(void * _q)
+{
+    ofdmflexframesync_reset((ofdmflexframesync)_q);
+}
+
+static void framesync_batch_ofdmflexframesync_destroy(void * _q)
+{
+    ofdmflexframesync_destroy((ofdmflexframesync)_q);
+}
+
+// decode capture with ofdmflexframesync synchronizers
+unsigned int ofdmflexframesync_decode_batch(unsigned int             _M,
+                                            unsigned int             _cp_len,
+                                            unsigned int             _taper_len,
+                                            unsigned char *          _p,
+                                            liquid_float_complex *   _x,
+                                            unsigned long int        _n,
+                                            unsigned int             _overlap,
+                                            unsigned int             _num_threads,
+                                            framesync_batch_callback _callback,
+                                            void *                   _userdata)
+{
+    struct framesync_batch_ofdm_s c = {_M, _cp_len, _taper_len, _p};
+    framesync_batch_s sync;
+    sync.create     = framesync_batch_ofdmflexframesync_create;
+    sync.execute    = framesync_batch_ofdmflexframesync_execute;
+    sync.reset      = framesync_batch_ofdmflexframesync_reset;
+    sync.destroy    = framesync_batch_ofdmflexframesync_destroy;
+    sync.header_len = OFDMFLEXFRAME_H_USER;
+    sync.context    = &c;
+    return framesync_batch_decode(&sync, _x, _n, _overlap, _num_threads, _callback, _userdata);
+}
+
+//
+// internal methods
+//
+
+// synchronizer callback: keep frames whose position lies in the span
+// of the shard being decoded; earlier positions belong to the previous
+// shard, which decodes the same blocks
+int framesync_batch_frame(unsigned char *  _header,
+                          int              _header_valid,
+                          unsigned char *  _payload,
+                          unsigned int     _payload_len,
+                          int              _payload_valid,
+                          framesyncstats_s _stats,
+                          void *           _userdata)
+{
+    struct framesync_batch_worker_s * w = (struct framesync_batch_worker_s*) _userdata;
+    struct framesync_batch_job_s * job = w->job;
+    if (w->position <= w->shard*job->shard_len)
+        return 0;
+
+    struct framesync_batch_shard_s * s = &job->shards[w->shard];
+    s->frames = (struct framesync_batch_frame_s*) liquid_realloc(s->frames,
+                    (s->num_frames+1)*sizeof(struct framesync_batch_frame_s));
+    struct framesync_batch_frame_s * f = &s->frames[s->num_frames++];
+    unsigned int header_len = job->sync->header_len;
+    f->position      = w->position;
+    f->header        = (unsigned char*) liquid_malloc(header_len);
+    f->header_valid  = _header_valid;
+    f->payload       = (unsigned char*) liquid_malloc(_payload_len);
+    f->payload_len   = _payload_len;
+    f->payload_valid = _payload_valid;
+    f->stats         = _stats;
+    f->stats.framesyms     = NULL;
+    f->stats.num_framesyms = 0;
+    if (_header != NULL)
+        memmove(f->header, _header, header_len);
+    else
+        memset(f->header, 0x00, header_len);
+    if (_payload != NULL)
+        memmove(f->payload, _payload, _payload_len);
+    return 0;
+}
+
+// decode shards until none remain
+void * framesync_batch_worker(void * _arg)
+{
+    struct framesync_batch_worker_s * w = (struct framesync_batch_worker_s*) _arg;
+    struct framesync_batch_job_s * job = w->job;
+    unsigned long int B = LIQUID_FRAMESYNC_BATCH_BLOCK;
+
+    while (1) {
+        // claim shard
+#if FRAMESYNC_BATCH_THREADS
+        pthread_mutex_lock(&job->mutex);
+#endif
+        unsigned int k = job->next;
+        if (k < job->num_shards)
+            job->next++;
+#if FRAMESYNC_BATCH_THREADS
+        pthread_mutex_unlock(&job->mutex);
+#endif
+        if (k >= job->num_shards)
+            break;
+
+        // decode shard span, starting early by the overlap
+        unsigned long int s0    = k*job->shard_len;
+        unsigned long int start = s0 > job->overlap ? s0 - job->overlap : 0;
+        unsigned long int end   = s0 + job->shard_len < job->n ? s0 + job->shard_len : job->n;
+        unsigned long int i;
+        w->shard = k;
+        job->sync->reset(w->sync);
+        for (i=start; i<end; i+=B) {
+            unsigned int n = end - i < B ? end - i : B;
+            w->position = i + n;
+            job->sync->execute(w->sync, job->x + i, n);
+        }
+    }
+    return NULL;
+}
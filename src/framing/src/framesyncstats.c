@@ -34,7 +34,7 @@
 
 #include "liquid.internal.h"
 
-framesyncstats_s framesyncstats_default = {
+const framesyncstats_s framesyncstats_default = {
     // signal quality
     0.0f,                   // error vector magnitude
     0.0f,                   // rssi
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// frametrace.c
+//
+// Timestamped receiver event tracing
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+// trace buffer; records left from an earlier session (before tracing
+// was last re-enabled) are discarded on the next push
+struct frametrace_buffer_s {
+    unsigned int        session;    // session records belong to
+    unsigned int        num_records;// number of buffered records
+    frametrace_record_s records[FRAMETRACE_BUFFER_LEN];
+};
+
+#if !defined LIQUID_TRACEOVERRIDE
+volatile int frametrace_enabled = 0;
+
+static frametrace_drain_callback frametrace_drain_cb = NULL;
+static void *                    frametrace_userdata = NULL;
+static volatile unsigned int     frametrace_session  = 0;
+
+// per-thread storage for trace buffers
+static LIQUID_THREAD_LOCAL struct frametrace_buffer_s frametrace_buffer;
+
+// hand buffered records to drain callback and empty buffer
+static void frametrace_drain(struct frametrace_buffer_s * _b)
+{
+    if (_b->num_records > 0 && frametrace_drain_cb != NULL)
+        frametrace_drain_cb(_b->records, _b->num_records, frametrace_userdata);
+    _b->num_records = 0;
+}
+
+// append event to calling thread's buffer, draining it when full
+void frametrace_push(const void * _q,
+                     const char * _object,
+                     int          _event,
+                     int          _arg)
+{
+    struct frametrace_buffer_s * b = &frametrace_buffer;
+    if (b->session != frametrace_session) {
+        b->session     = frametrace_session;
+        b->num_records = 0;
+    }
+
+    frametrace_record_s * r = &b->records[b->num_records++];
+    r->time   = frameperfstats_time();
+    r->source = _q;
+    r->object = _object;
+    r->event  = _event;
+    r->arg    = _arg;
+
+    if (b->num_records == FRAMETRACE_BUFFER_LEN)
+        frametrace_drain(b);
+}
+#endif
+
+// enable tracing, handing buffered records to _drain
+int frametrace_enable(frametrace_drain_callback _drain,
+                      void *                    _userdata)
+{
+    if (_drain == NULL) {
+        fprintf(stderr,"error: frametrace_enable(), drain callback cannot be NULL\n");
+        exit(1);
+    }
+#if defined LIQUID_TRACEOVERRIDE
+    return -1;
+#else
+    frametrace_enabled  = 0;
+    frametrace_drain_cb = _drain;
+    frametrace_userdata = _userdata;
+    frametrace_session++;
+    frametrace_enabled  = 1;
+    return 0;
+#endif
+}
+
+// disable tracing, draining the calling thread's buffer
+void frametrace_disable()
+{
+#if !defined LIQUID_TRACEOVERRIDE
+    if (!frametrace_enabled)
+        return;
+    frametrace_flush();
+    frametrace_enabled = 0;
+#endif
+}
+
+int frametrace_is_enabled()
+{
+#if defined LIQUID_TRACEOVERRIDE
+    return 0;
+#else
+    return frametrace_enabled;
+#endif
+}
+
+// drain records buffered by the calling thread
+void frametrace_flush()
+{
+#if !defined LIQUID_TRACEOVERRIDE
+    struct frametrace_buffer_s * b = &frametrace_buffer;
+    if (frametrace_enabled && b->session == frametrace_session)
+        frametrace_drain(b);
+#endif
+}
+
+// get string name of frametrace event
+const char * frametrace_event_str(int _event)
+{
+    switch (_event) {
+    case LIQUID_FRAMETRACE_FRAME_DETECTED:  return "frame-detected";
+    case LIQUID_FRAMETRACE_HEADER_DECODED:  return "header-decoded";
+    case LIQUID_FRAMETRACE_PAYLOAD_DECODED: return "payload-decoded";
+    case LIQUID_FRAMETRACE_STATE:           return "state";
+    default:;
+    }
+    return "unknown";
+}
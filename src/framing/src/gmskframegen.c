@@ -37,11 +37,21 @@
 
 // gmskframegen
 void gmskframegen_encode_header( gmskframegen _q, const unsigned char * _header);
-void gmskframegen_write_preamble(gmskframegen _q, float complex * _y);
-void gmskframegen_write_header(  gmskframegen _q, float complex * _y);
-void gmskframegen_write_payload( gmskframegen _q, float complex * _y);
+void gmskframegen_write_preamble(gmskframegen _q, float complex * _y, unsigned int _n);
+void gmskframegen_write_header(  gmskframegen _q, float complex * _y, unsigned int _n);
+void gmskframegen_write_payload( gmskframegen _q, float complex * _y, unsigned int _n);
 void gmskframegen_write_tail(    gmskframegen _q, float complex * _y);
 
+// write one symbol (k samples) according to current state
+void gmskframegen_write_symbol(gmskframegen _q, float complex * _y);
+
+// modulate encoded bits, most-significant bit first
+void gmskframegen_modulate_bits(gmskframegen          _q,
+                                const unsigned char * _bytes,
+                                unsigned int          _offset,
+                                float complex *       _y,
+                                unsigned int          _n);
+
 
 // gmskframe object structure
 struct gmskframegen_s {
@@ -55,10 +65,14 @@ struct gmskframegen_s {
     unsigned int header_len;    // length of header (encoded)
     unsigned int payload_len;   //
     unsigned int tail_len;      //
+    float * ramp;               // ramp window [size: 2*m*k x 1]
 
     // preamble
     //unsigned int genpoly_header;// generator polynomial
     msequence ms_preamble;      // preamble p/n sequence
+    unsigned char * preamble_bits;      // preamble bits [preamble_len]
+    float complex * preamble_samples;   // rendered preamble [size: k*preamble_len x 1]
+    float preamble_theta;       // modulator phase following preamble
 
     // header
     unsigned char * header_dec; // uncoded header [GMSKFRAME_H_DEC]
@@ -84,12 +98,16 @@ struct gmskframegen_s {
     int frame_assembled;        // frame assembled flag
     int frame_complete;         // frame completed flag
     unsigned int symbol_counter;//
+
+    // block writes
+    float complex * buf_block;  // partial symbol [size: k x 1]
+    unsigned int buf_block_index; // read index of buf_block (k if empty)
 };
 
 // create gmskframegen object
 gmskframegen gmskframegen_create()
 {
-    gmskframegen q = (gmskframegen) malloc(sizeof(struct gmskframegen_s));
+    gmskframegen q = (gmskframegen) liquid_malloc(sizeof(struct gmskframegen_s));
 
     // set internal properties
     q->k  = 2;      // samples/symbol
@@ -104,12 +122,35 @@ gmskframegen gmskframegen_create()
     // create modulator
     q->mod = gmskmod_create(q->k, q->m, q->BT);
 
+    // ramp window: first half applied to preamble, second half to tail
+    unsigned int i, j;
+    q->ramp = (float*) liquid_malloc(2*q->m*q->k*sizeof(float));
+    for (i=0; i<2*q->m*q->k; i++)
+        q->ramp[i] = hamming(i, 2*q->m*q->k);
+
     // preamble objects/arrays
     q->ms_preamble = msequence_create(6, 0x6d, 1);
 
+    // render preamble once from reset modulator state (including ramp
+    // window); frames copy it and restore the modulator state after it
+    q->preamble_bits    = (unsigned char*) liquid_malloc(q->preamble_len*sizeof(unsigned char));
+    q->preamble_samples = (float complex*) liquid_malloc(q->k*q->preamble_len*sizeof(float complex));
+    for (i=0; i<q->preamble_len; i++) {
+        float complex * y = &q->preamble_samples[i*q->k];
+        q->preamble_bits[i] = msequence_advance(q->ms_preamble);
+        gmskmod_modulate(q->mod, q->preamble_bits[i], y);
+
+        // apply ramping window to first 'm' symbols
+        if (i < q->m) {
+            for (j=0; j<q->k; j++)
+                y[j] *= q->ramp[i*q->k + j];
+        }
+    }
+    q->preamble_theta = gmskmod_get_phase(q->mod);
+
     // header objects/arrays
-    q->header_dec = (unsigned char*)malloc(GMSKFRAME_H_DEC*sizeof(unsigned char));
-    q->header_enc = (unsigned char*)malloc(GMSKFRAME_H_ENC*sizeof(unsigned char));
+    q->header_dec = (unsigned char*)liquid_malloc(GMSKFRAME_H_DEC*sizeof(unsigned char));
+    q->header_enc = (unsigned char*)liquid_malloc(GMSKFRAME_H_ENC*sizeof(unsigned char));
     q->header_len = GMSKFRAME_H_ENC * 8;
     q->p_header   = packetizer_create(GMSKFRAME_H_DEC,
                                       GMSKFRAME_H_CRC,
@@ -130,7 +171,10 @@ gmskframegen gmskframegen_create()
     q->payload_len = 8*q->enc_msg_len;
 
     // allocate memory for encoded packet
-    q->payload_enc = (unsigned char*) malloc(q->enc_msg_len*sizeof(unsigned char));
+    q->payload_enc = (unsigned char*) liquid_malloc(q->enc_msg_len*sizeof(unsigned char));
+
+    // partial symbol buffer for block writes
+    q->buf_block = (float complex*) liquid_malloc(q->k*sizeof(float complex));
 
     // reset framing object
     gmskframegen_reset(q);
@@ -147,18 +191,23 @@ void gmskframegen_destroy(gmskframegen _q)
 
     // destroy/free preamble objects/arrays
     msequence_destroy(_q->ms_preamble);
+    liquid_free(_q->preamble_bits);
+    liquid_free(_q->preamble_samples);
 
     // destroy/free header objects/arrays
-    free(_q->header_dec);
-    free(_q->header_enc);
+    liquid_free(_q->header_dec);
+    liquid_free(_q->header_enc);
     packetizer_destroy(_q->p_header);
 
     // destroy/free payload objects/arrays
-    free(_q->payload_enc);
+    liquid_free(_q->payload_enc);
     packetizer_destroy(_q->p_payload);
 
+    liquid_free(_q->buf_block);
+    liquid_free(_q->ramp);
+
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // reset frame generator object
@@ -173,6 +222,7 @@ void gmskframegen_reset(gmskframegen _q)
     _q->frame_assembled = 0;
     _q->frame_complete  = 0;
     _q->symbol_counter  = 0;
+    _q->buf_block_index = _q->k;
 }
 
 // is frame assembled?
@@ -238,7 +288,7 @@ void gmskframegen_assemble(gmskframegen          _q,
         _q->payload_len = 8*_q->enc_msg_len;
 
         // re-allocate memory
-        _q->payload_enc = (unsigned char*) realloc(_q->payload_enc, _q->enc_msg_len*sizeof(unsigned char));
+        _q->payload_enc = (unsigned char*) liquid_realloc(_q->payload_enc, _q->enc_msg_len*sizeof(unsigned char));
     }
     
     // set assembled flag
@@ -272,31 +322,7 @@ unsigned int gmskframegen_getframelen(gmskframegen _q)
 int gmskframegen_write_samples(gmskframegen _q,
                                float complex * _y)
 {
-    switch (_q->state) {
-    case STATE_PREAMBLE:
-        // write preamble
-        gmskframegen_write_preamble(_q, _y);
-        break;
-
-    case STATE_HEADER:
-        // write header
-        gmskframegen_write_header(_q, _y);
-        break;
-
-    case STATE_PAYLOAD:
-        // write payload symbols
-        gmskframegen_write_payload(_q, _y);
-        break;
-
-    case STATE_TAIL:
-        // write tail symbols
-        gmskframegen_write_tail(_q, _y);
-        break;
-
-    default:
-        fprintf(stderr,"error: gmskframegen_writesymbol(), unknown/unsupported internal state\n");
-        exit(1);
-    }
+    gmskframegen_write_symbol(_q, _y);
 
     if (_q->frame_complete) {
         // reset framing object
@@ -310,6 +336,69 @@ int gmskframegen_write_samples(gmskframegen _q,
     return 0;
 }
 
+// write samples of assembled frame into a buffer of arbitrary length,
+// stopping at the end of the frame; whole symbols are modulated
+// directly into the output buffer and only a symbol straddling the end
+// of the buffer is staged internally. Returns '1' when the final
+// sample of the frame has been written, '0' otherwise; nothing is
+// written if no frame is assembled
+//  _q          :   frame generator object
+//  _buffer     :   output buffer [size: _buffer_len x 1]
+//  _buffer_len :   output buffer length
+//  _num_written:   number of samples written to buffer
+int gmskframegen_write_block(gmskframegen    _q,
+                             float complex * _buffer,
+                             unsigned int    _buffer_len,
+                             unsigned int *  _num_written)
+{
+    unsigned int i = 0;
+    while (i < _buffer_len) {
+        if (_q->buf_block_index < _q->k) {
+            // drain partial symbol
+            _buffer[i++] = _q->buf_block[_q->buf_block_index++];
+        } else if (_q->frame_complete || !_q->frame_assembled) {
+            break;
+        } else if (_buffer_len - i >= _q->k && _q->state == STATE_PREAMBLE) {
+            // copy as much of the rendered preamble as fits
+            unsigned int n = (_buffer_len - i) / _q->k;
+            if (n > _q->preamble_len - _q->symbol_counter)
+                n = _q->preamble_len - _q->symbol_counter;
+            gmskframegen_write_preamble(_q, &_buffer[i], n);
+            i += n*_q->k;
+        } else if (_buffer_len - i >= _q->k && _q->state == STATE_HEADER) {
+            // modulate as many header symbols as fit
+            unsigned int n = (_buffer_len - i) / _q->k;
+            if (n > _q->header_len - _q->symbol_counter)
+                n = _q->header_len - _q->symbol_counter;
+            gmskframegen_write_header(_q, &_buffer[i], n);
+            i += n*_q->k;
+        } else if (_buffer_len - i >= _q->k && _q->state == STATE_PAYLOAD) {
+            // modulate as many payload symbols as fit
+            unsigned int n = (_buffer_len - i) / _q->k;
+            if (n > _q->payload_len - _q->symbol_counter)
+                n = _q->payload_len - _q->symbol_counter;
+            gmskframegen_write_payload(_q, &_buffer[i], n);
+            i += n*_q->k;
+        } else if (_buffer_len - i >= _q->k) {
+            // write symbol directly into output buffer
+            gmskframegen_write_symbol(_q, &_buffer[i]);
+            i += _q->k;
+        } else {
+            // stage symbol straddling end of output buffer
+            gmskframegen_write_symbol(_q, _q->buf_block);
+            _q->buf_block_index = 0;
+        }
+    }
+    *_num_written = i;
+
+    // frame complete once final symbol has been drained
+    if (_q->frame_complete && _q->buf_block_index == _q->k) {
+        gmskframegen_reset(_q);
+        return 1;
+    }
+    return 0;
+}
+
 
 // 
 // internal methods
@@ -351,60 +440,111 @@ void gmskframegen_encode_header(gmskframegen          _q,
 #endif
 }
 
-void gmskframegen_write_preamble(gmskframegen    _q,
-                                 float complex * _y)
+// write one symbol (k samples) according to current state
+void gmskframegen_write_symbol(gmskframegen    _q,
+                               float complex * _y)
 {
-    unsigned char bit = msequence_advance(_q->ms_preamble);
-    gmskmod_modulate(_q->mod, bit, _y);
+    switch (_q->state) {
+    case STATE_PREAMBLE:
+        // write preamble
+        gmskframegen_write_preamble(_q, _y, 1);
+        break;
 
-    // apply ramping window to first 'm' symbols
-    if (_q->symbol_counter < _q->m) {
-        unsigned int i;
-        for (i=0; i<_q->k; i++)
-            _y[i] *= hamming(_q->symbol_counter*_q->k + i, 2*_q->m*_q->k);
+    case STATE_HEADER:
+        // write header
+        gmskframegen_write_header(_q, _y, 1);
+        break;
+
+    case STATE_PAYLOAD:
+        // write payload symbols
+        gmskframegen_write_payload(_q, _y, 1);
+        break;
+
+    case STATE_TAIL:
+        // write tail symbols
+        gmskframegen_write_tail(_q, _y);
+        break;
+
+    default:
+        fprintf(stderr,"error: gmskframegen_write_symbol(), unknown/unsupported internal state\n");
+        exit(1);
     }
+}
 
-    _q->symbol_counter++;
+// write preamble symbols from rendered samples
+//  _q      :   frame generator object
+//  _y      :   output samples [size: _n*k x 1]
+//  _n      :   number of preamble symbols to write
+void gmskframegen_write_preamble(gmskframegen    _q,
+                                 float complex * _y,
+                                 unsigned int    _n)
+{
+    memmove(_y, &_q->preamble_samples[_q->symbol_counter*_q->k], _n*_q->k*sizeof(float complex));
+    _q->symbol_counter += _n;
 
     if (_q->symbol_counter == _q->preamble_len) {
-        msequence_reset(_q->ms_preamble);
+        // restore modulator state as if preamble had been modulated
+        gmskmod_load_state(_q->mod, _q->preamble_bits, _q->preamble_len, _q->preamble_theta);
         _q->symbol_counter = 0;
         _q->state = STATE_HEADER;
     }
 }
 
-void gmskframegen_write_header(gmskframegen    _q,
-                               float complex * _y)
+// modulate encoded bits, most-significant bit first
+//  _q      :   frame generator object
+//  _bytes  :   encoded bytes
+//  _offset :   index of first bit to modulate
+//  _y      :   output samples [size: _n*k x 1]
+//  _n      :   number of bits (symbols) to modulate
+void gmskframegen_modulate_bits(gmskframegen          _q,
+                                const unsigned char * _bytes,
+                                unsigned int          _offset,
+                                float complex *       _y,
+                                unsigned int          _n)
 {
-    div_t d = div(_q->symbol_counter, 8);
-    unsigned int byte_index = d.quot;
-    unsigned int bit_index  = d.rem;
-    unsigned char byte = _q->header_enc[byte_index];
-    unsigned char bit  = (byte >> (8-bit_index-1)) & 0x01;
+    // unpack bits in chunks and modulate each chunk as a block
+    unsigned int syms[64];
+    unsigned int i = 0;
+    while (i < _n) {
+        unsigned int num_syms = _n - i < 64 ? _n - i : 64;
+        unsigned int j;
+        for (j=0; j<num_syms; j++) {
+            unsigned int b = _offset + i + j;
+            syms[j] = (_bytes[b >> 3] >> (7 - (b & 7))) & 0x01;
+        }
+        gmskmod_modulate_block(_q->mod, syms, num_syms, &_y[i*_q->k]);
+        i += num_syms;
+    }
+}
 
-    gmskmod_modulate(_q->mod, bit, _y);
+// write header symbols
+//  _q      :   frame generator object
+//  _y      :   output samples [size: _n*k x 1]
+//  _n      :   number of header symbols to write
+void gmskframegen_write_header(gmskframegen    _q,
+                               float complex * _y,
+                               unsigned int    _n)
+{
+    gmskframegen_modulate_bits(_q, _q->header_enc, _q->symbol_counter, _y, _n);
+    _q->symbol_counter += _n;
 
-    _q->symbol_counter++;
-    
     if (_q->symbol_counter == _q->header_len) {
         _q->symbol_counter = 0;
         _q->state = STATE_PAYLOAD;
     }
 }
 
+// write payload symbols
+//  _q      :   frame generator object
+//  _y      :   output samples [size: _n*k x 1]
+//  _n      :   number of payload symbols to write
 void gmskframegen_write_payload(gmskframegen    _q,
-                                float complex * _y)
+                                float complex * _y,
+                                unsigned int    _n)
 {
-    div_t d = div(_q->symbol_counter, 8);
-    unsigned int byte_index = d.quot;
-    unsigned int bit_index  = d.rem;
-    unsigned char byte = _q->payload_enc[byte_index];
-    unsigned char bit  = (byte >> (8-bit_index-1)) & 0x01;
+    gmskframegen_modulate_bits(_q, _q->payload_enc, _q->symbol_counter, _y, _n);
+    _q->symbol_counter += _n;
 
-    gmskmod_modulate(_q->mod, bit, _y);
-
-    _q->symbol_counter++;
-    
     if (_q->symbol_counter == _q->payload_len) {
         _q->symbol_counter = 0;
         _q->state = STATE_TAIL;
@@ -414,14 +554,14 @@ void gmskframegen_write_payload(gmskframegen    _q,
 void gmskframegen_write_tail(gmskframegen    _q,
                              float complex * _y)
 {
-    unsigned char bit = rand() % 2;
+    unsigned char bit = randu64_r(liquid_rand_state()) & 1;
     gmskmod_modulate(_q->mod, bit, _y);
 
     // apply ramping window to last 'm' symbols
     if (_q->symbol_counter >= _q->m) {
         unsigned int i;
         for (i=0; i<_q->k; i++)
-            _y[i] *= hamming(_q->m*_q->k + (_q->symbol_counter-_q->m)*_q->k + i, 2*_q->m*_q->k);
+            _y[i] *= _q->ramp[_q->symbol_counter*_q->k + i];
     }
 
     _q->symbol_counter++;
@@ -41,9 +41,6 @@
 // enable pre-demodulation filter (remove out-of-band noise)
 #define GMSKFRAMESYNC_PREFILTER         1
 
-// push buffered p/n sequence through synchronizer
-void gmskframesync_pushpn(gmskframesync _q);
-
 // ...
 void gmskframesync_syncpn(gmskframesync _q);
 
@@ -59,6 +56,18 @@ int gmskframesync_update_symsync(gmskframesync _q,
                                  float         _x,
                                  float *       _y);
 
+// push buffered p/n sequence (and any following samples) through
+// synchronizer once a frame has been detected
+//  _q      :   frame synchronizer object
+//  _x      :   buffered samples, starting m symbols before the p/n sequence
+//  _n      :   number of buffered samples, at least k*(preamble_len+m)
+void gmskframesync_pushpn(gmskframesync   _q,
+                          float complex * _x,
+                          unsigned int    _n);
+
+// run a single (pre-filtered) sample through the current state
+void gmskframesync_execute_sample(gmskframesync _q, float complex _x);
+
 // execute stages
 void gmskframesync_execute_detectframe(gmskframesync _q, float complex _x);
 void gmskframesync_execute_rxpreamble( gmskframesync _q, float complex _x);
@@ -68,6 +77,9 @@ void gmskframesync_execute_rxpayload(  gmskframesync _q, float complex _x);
 // decode header
 void gmskframesync_decode_header(gmskframesync _q);
 
+// header-only mode: invoke callback and skip payload samples
+void gmskframesync_skip_payload(gmskframesync _q);
+
 // gmskframesync object structure
 struct gmskframesync_s {
 #if GMSKFRAMESYNC_PREFILTER
@@ -96,6 +108,8 @@ struct gmskframesync_s {
 
     // synchronizer objects
     detector_cccf frame_detector;   // pre-demod detector
+    qdetector_cccf fft_detector;    // pre-demod FFT block detector
+    int fft_detector_enabled;       // use FFT block detector?
     float tau_hat;                  // fractional timing offset estimate
     float dphi_hat;                 // carrier frequency offset estimate
     float gamma_hat;                // channel gain estimate
@@ -125,6 +139,9 @@ struct gmskframesync_s {
     unsigned char * payload_dec;    // payload data (encoded bytes)
     packetizer p_payload;           // payload packetizer
     int payload_valid;              // did payload pass crc?
+    int header_only;                // skip payload after valid header?
+    framequeue fq;                  // queued frame delivery (or NULL)
+    unsigned int skip_counter;      // counter: payload samples left to skip
     
     // status variables
     enum {
@@ -132,10 +149,18 @@ struct gmskframesync_s {
         STATE_RXPREAMBLE,           // receive p/n sequence
         STATE_RXHEADER,             // receive header data
         STATE_RXPAYLOAD,            // receive payload data
+        STATE_SKIPPAYLOAD,          // skip payload (header-only mode)
     } state;
     unsigned int preamble_counter;  // counter: num of p/n syms received
     unsigned int header_counter;    // counter: num of header syms received
     unsigned int payload_counter;   // counter: num of payload syms received
+
+    // performance counters
+    frameperfstats_s perfstats;     // receiver performance counters
+    int perfstats_enabled;          // gather performance counters?
+    double perfstats_t_execute;     // time of last execute() call
+    unsigned int perfstats_passes;  // FFT detector passes at last update
+
     // debugging structures
 #if DEBUG_GMSKFRAMESYNC
     int debug_enabled;              // debugging enabled?
@@ -153,9 +178,10 @@ struct gmskframesync_s {
 gmskframesync gmskframesync_create(framesync_callback _callback,
                                    void *             _userdata)
 {
-    gmskframesync q = (gmskframesync) malloc(sizeof(struct gmskframesync_s));
+    gmskframesync q = (gmskframesync) liquid_malloc(sizeof(struct gmskframesync_s));
     q->callback = _callback;
     q->userdata = _userdata;
+    q->fq       = NULL;
     q->k        = 2;        // samples/symbol
     q->m        = 3;        // filter delay (symbols)
     q->BT       = 0.5f;     // filter bandwidth-time product
@@ -169,9 +195,10 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
 
     // frame detector
     q->preamble_len = 63;
-    q->preamble_pn = (float*)malloc(q->preamble_len*sizeof(float));
-    q->preamble_rx = (float*)malloc(q->preamble_len*sizeof(float));
+    q->preamble_pn = (float*)liquid_malloc(q->preamble_len*sizeof(float));
+    q->preamble_rx = (float*)liquid_malloc(q->preamble_len*sizeof(float));
     float complex preamble_samples[q->preamble_len*q->k];
+    unsigned char preamble_bits[q->preamble_len];
     msequence ms = msequence_create(6, 0x6d, 1);
     gmskmod mod = gmskmod_create(q->k, q->m, q->BT);
 
@@ -179,8 +206,10 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
         unsigned char bit = msequence_advance(ms);
 
         // save p/n sequence
-        if (i < q->preamble_len)
+        if (i < q->preamble_len) {
             q->preamble_pn[i] = bit ? 1.0f : -1.0f;
+            preamble_bits[i]  = bit;
+        }
         
         // modulate/interpolate
         if (i < q->m) gmskmod_modulate(mod, bit, &preamble_samples[0]);
@@ -199,6 +228,14 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
     float threshold = 0.5f;     // detection threshold
     float dphi_max  = 0.05f;    // maximum carrier offset allowable
     q->frame_detector = detector_cccf_create(preamble_samples, q->preamble_len*q->k, threshold, dphi_max);
+
+    // create FFT block detector (disabled by default); its template
+    // includes the modulator delay, so detected buffers are aligned
+    // with those of the time-domain detector
+    q->fft_detector = qdetector_cccf_create_gmsk(preamble_bits, q->preamble_len, q->k, q->m, q->BT);
+    qdetector_cccf_set_threshold(q->fft_detector, threshold);
+    qdetector_cccf_set_range    (q->fft_detector, dphi_max);
+    q->fft_detector_enabled = 0;
     q->buffer = windowcf_create(q->k*(q->preamble_len+q->m));
 
     // create symbol timing recovery filters
@@ -210,9 +247,9 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
     q->nco_coarse = nco_crcf_create(LIQUID_NCO);
 
     // create/allocate header objects/arrays
-    q->header_mod = (unsigned char*)malloc(GMSKFRAME_H_SYM*sizeof(unsigned char));
-    q->header_enc = (unsigned char*)malloc(GMSKFRAME_H_ENC*sizeof(unsigned char));
-    q->header_dec = (unsigned char*)malloc(GMSKFRAME_H_DEC*sizeof(unsigned char));
+    q->header_mod = (unsigned char*)liquid_malloc(GMSKFRAME_H_SYM*sizeof(unsigned char));
+    q->header_enc = (unsigned char*)liquid_malloc(GMSKFRAME_H_ENC*sizeof(unsigned char));
+    q->header_dec = (unsigned char*)liquid_malloc(GMSKFRAME_H_DEC*sizeof(unsigned char));
     q->p_header   = packetizer_create(GMSKFRAME_H_DEC,
                                       GMSKFRAME_H_CRC,
                                       GMSKFRAME_H_FEC,
@@ -228,8 +265,8 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
                                      q->fec0,
                                      q->fec1);
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
-    q->payload_dec = (unsigned char*) malloc(q->payload_dec_len*sizeof(unsigned char));
-    q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
+    q->payload_dec = (unsigned char*) liquid_malloc(q->payload_dec_len*sizeof(unsigned char));
+    q->payload_enc = (unsigned char*) liquid_malloc(q->payload_enc_len*sizeof(unsigned char));
 
 #if DEBUG_GMSKFRAMESYNC
     // debugging structures
@@ -241,9 +278,17 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
     q->debug_framesyms       = NULL;
 #endif
 
+    // header-only mode (disabled by default)
+    q->header_only  = 0;
+    q->skip_counter = 0;
+
     // reset synchronizer
     gmskframesync_reset(q);
 
+    // performance counters (disabled by default)
+    q->perfstats_enabled = 0;
+    frameperfstats_reset(&q->perfstats);
+
     // return synchronizer object
     return q;
 }
@@ -252,6 +297,10 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
 // destroy frame synchronizer object, freeing all internal memory
 void gmskframesync_destroy(gmskframesync _q)
 {
+    // deliver (or discard) queued frames
+    if (_q->fq != NULL)
+        framequeue_destroy(_q->fq);
+
 #if DEBUG_GMSKFRAMESYNC
     // destroy debugging objects
     if (_q->debug_objects_created) {
@@ -272,29 +321,32 @@ void gmskframesync_destroy(gmskframesync _q)
 
     // preamble
     detector_cccf_destroy(_q->frame_detector);
+    qdetector_cccf_destroy(_q->fft_detector);
     windowcf_destroy(_q->buffer);
-    free(_q->preamble_pn);
-    free(_q->preamble_rx);
+    liquid_free(_q->preamble_pn);
+    liquid_free(_q->preamble_rx);
     
     // header
     packetizer_destroy(_q->p_header);
-    free(_q->header_mod);
-    free(_q->header_enc);
-    free(_q->header_dec);
+    liquid_free(_q->header_mod);
+    liquid_free(_q->header_enc);
+    liquid_free(_q->header_dec);
 
     // payload
     packetizer_destroy(_q->p_payload);
-    free(_q->payload_enc);
-    free(_q->payload_dec);
+    liquid_free(_q->payload_enc);
+    liquid_free(_q->payload_dec);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print frame synchronizer object internals
 void gmskframesync_print(gmskframesync _q)
 {
     printf("gmskframesync:\n");
+    if (_q->perfstats_enabled)
+        frameperfstats_print(&_q->perfstats);
 }
 
 // reset frame synchronizer object
@@ -305,12 +357,14 @@ void gmskframesync_reset(gmskframesync _q)
     _q->preamble_counter = 0;
     _q->header_counter   = 0;
     _q->payload_counter  = 0;
+    FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_STATE, _q->state);
     
     // clear pre-demod buffer
     windowcf_clear(_q->buffer);
 
     // reset internal objects
     detector_cccf_reset(_q->frame_detector);
+    qdetector_cccf_reset(_q->fft_detector);
     
     // reset carrier recovery objects
     nco_crcf_reset(_q->nco_coarse);
@@ -334,6 +388,9 @@ void gmskframesync_execute(gmskframesync   _q,
                            float complex * _x,
                            unsigned int    _n)
 {
+    if (_q->perfstats_enabled)
+        _q->perfstats_t_execute = frameperfstats_time();
+
     // push through synchronizer
     unsigned int i;
     for (i=0; i<_n; i++) {
@@ -349,27 +406,27 @@ void gmskframesync_execute(gmskframesync   _q,
             windowcf_push(_q->debug_x, xf);
 #endif
 
-        switch (_q->state) {
-        case STATE_DETECTFRAME:
-            // look for p/n sequence
-            gmskframesync_execute_detectframe(_q, xf);
-            break;
-
-        case STATE_RXPREAMBLE:
-            // receive p/n sequence symbols
-            gmskframesync_execute_rxpreamble(_q, xf);
-            break;
-
-        case STATE_RXHEADER:
-            // receive header
-            gmskframesync_execute_rxheader(_q, xf);
-            break;
-
-        case STATE_RXPAYLOAD:
-            // receive payload
-            gmskframesync_execute_rxpayload(_q, xf);
-            break;
+        // accumulate samples processed per state
+        if (_q->perfstats_enabled) {
+            switch (_q->state) {
+            case STATE_DETECTFRAME: _q->perfstats.num_samples_detect++;   break;
+            case STATE_RXPREAMBLE:  _q->perfstats.num_samples_preamble++; break;
+            case STATE_RXHEADER:    _q->perfstats.num_samples_header++;   break;
+            case STATE_RXPAYLOAD:   _q->perfstats.num_samples_payload++;  break;
+            case STATE_SKIPPAYLOAD: _q->perfstats.num_samples_payload++;  break;
+            }
+        }
+
+        // header-only mode: count off payload samples without mixing,
+        // filtering or demodulating them (the pre-filter above keeps
+        // running so detection resumes on a settled filter)
+        if (_q->state == STATE_SKIPPAYLOAD) {
+            if (--_q->skip_counter == 0)
+                gmskframesync_reset(_q);
+            continue;
         }
+
+        gmskframesync_execute_sample(_q, xf);
     }
 }
 
@@ -377,6 +434,37 @@ void gmskframesync_execute(gmskframesync   _q,
 // internal methods
 //
 
+// run a single (pre-filtered) sample through the current state
+void gmskframesync_execute_sample(gmskframesync _q,
+                                  float complex _x)
+{
+    switch (_q->state) {
+    case STATE_DETECTFRAME:
+        // look for p/n sequence
+        gmskframesync_execute_detectframe(_q, _x);
+        break;
+
+    case STATE_RXPREAMBLE:
+        // receive p/n sequence symbols
+        gmskframesync_execute_rxpreamble(_q, _x);
+        break;
+
+    case STATE_RXHEADER:
+        // receive header
+        gmskframesync_execute_rxheader(_q, _x);
+        break;
+
+    case STATE_RXPAYLOAD:
+        // receive payload
+        gmskframesync_execute_rxpayload(_q, _x);
+        break;
+
+    case STATE_SKIPPAYLOAD:
+        // skipped in gmskframesync_execute()
+        break;
+    }
+}
+
 // update symbol synchronizer internal state (filtered error, index, etc.)
 //  _q      :   frame synchronizer
 //  _x      :   input sample
@@ -452,8 +540,11 @@ int gmskframesync_update_symsync(gmskframesync _q,
     return sample_available;
 }
 
-// push buffered p/n sequence through synchronizer
-void gmskframesync_pushpn(gmskframesync _q)
+// push buffered p/n sequence (and any following samples) through
+// synchronizer once a frame has been detected
+void gmskframesync_pushpn(gmskframesync   _q,
+                          float complex * _x,
+                          unsigned int    _n)
 {
     unsigned int i;
 
@@ -461,10 +552,6 @@ void gmskframesync_pushpn(gmskframesync _q)
     firpfb_rrrf_reset(_q->mf);
     firpfb_rrrf_reset(_q->dmf);
 
-    // read buffer
-    float complex * rc;
-    windowcf_read(_q->buffer, &rc);
-
     // compute delay and filterbank index
     //  tau_hat < 0 :   delay = 2*k*m-1, index = round(   tau_hat *npfb), flag = 0
     //  tau_hat > 0 :   delay = 2*k*m-2, index = round((1-tau_hat)*npfb), flag = 0
@@ -478,6 +565,7 @@ void gmskframesync_pushpn(gmskframesync _q)
         _q->pfb_soft  += _q->npfb;
     }
     _q->pfb_timer = 0;
+    FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_FRAME_DETECTED, 0);
 
     // set coarse carrier frequency offset
     nco_crcf_set_frequency(_q->nco_coarse, _q->dphi_hat);
@@ -486,7 +574,7 @@ void gmskframesync_pushpn(gmskframesync _q)
     for (i=0; i<buffer_len; i++) {
         if (i < delay) {
             float complex y;
-            nco_crcf_mix_down(_q->nco_coarse, rc[i], &y);
+            nco_crcf_mix_down(_q->nco_coarse, _x[i], &y);
             nco_crcf_step(_q->nco_coarse);
 
             // update instantanenous frequency estimate
@@ -497,13 +585,18 @@ void gmskframesync_pushpn(gmskframesync _q)
             firpfb_rrrf_push(_q->dmf, _q->fi_hat);
         } else {
             // run remaining samples through p/n sequence recovery
-            gmskframesync_execute_rxpreamble(_q, rc[i]);
+            gmskframesync_execute_rxpreamble(_q, _x[i]);
         }
     }
 
     // set state (still need a few more samples before entire p/n
     // sequence has been received)
     _q->state = STATE_RXPREAMBLE;
+    FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_STATE, _q->state);
+
+    // run remaining buffered samples through synchronizer
+    for (i=buffer_len; i<_n; i++)
+        gmskframesync_execute_sample(_q, _x[i]);
 }
 
 // 
@@ -531,10 +624,40 @@ void gmskframesync_update_fi(gmskframesync _q,
 void gmskframesync_execute_detectframe(gmskframesync _q,
                                        float complex _x)
 {
+    if (_q->fft_detector_enabled) {
+        // push through FFT block detector
+        float complex * v = qdetector_cccf_execute(_q->fft_detector, _x);
+
+        // count correlation passes (blocks not bypassed by energy gate)
+        if (_q->perfstats_enabled) {
+            unsigned int passes = qdetector_cccf_gate_get_num_blocks (_q->fft_detector) -
+                                  qdetector_cccf_gate_get_num_skipped(_q->fft_detector);
+            _q->perfstats.num_detector_passes += passes - _q->perfstats_passes;
+            _q->perfstats_passes = passes;
+        }
+
+        if (v == NULL)
+            return;
+
+        // get estimates; the block detector's timing estimate has the
+        // opposite sign and its buffer starts one sample earlier than
+        // that of the time-domain detector
+        float tau_hat = -qdetector_cccf_get_tau(_q->fft_detector);
+        _q->tau_hat   = tau_hat > 0.499f ? 0.499f : (tau_hat < -0.499f ? -0.499f : tau_hat);
+        _q->dphi_hat  = qdetector_cccf_get_dphi (_q->fft_detector);
+        _q->gamma_hat = qdetector_cccf_get_gamma(_q->fft_detector);
+
+        // run buffered samples through synchronizer
+        gmskframesync_pushpn(_q, v+1, qdetector_cccf_get_buf_len(_q->fft_detector)-1);
+        return;
+    }
+
     // push sample into pre-demod p/n sequence buffer
     windowcf_push(_q->buffer, _x);
 
-    // push through pre-demod synchronizer
+    // push through pre-demod synchronizer (one correlation per sample)
+    if (_q->perfstats_enabled)
+        _q->perfstats.num_detector_passes++;
     int detected = detector_cccf_correlate(_q->frame_detector,
                                            _x,
                                            &_q->tau_hat,
@@ -548,7 +671,9 @@ void gmskframesync_execute_detectframe(gmskframesync _q,
 
         // push buffered samples through synchronizer
         // NOTE: state will be updated to STATE_RXPREAMBLE internally
-        gmskframesync_pushpn(_q);
+        float complex * rc;
+        windowcf_read(_q->buffer, &rc);
+        gmskframesync_pushpn(_q, rc, (_q->preamble_len + _q->m) * _q->k);
     }
 }
 
@@ -584,6 +709,7 @@ void gmskframesync_execute_rxpreamble(gmskframesync _q,
         if (_q->preamble_counter == _q->preamble_len) {
             gmskframesync_syncpn(_q);
             _q->state = STATE_RXHEADER;
+            FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_STATE, _q->state);
         }
     }
 }
@@ -617,7 +743,14 @@ void gmskframesync_execute_rxheader(gmskframesync _q,
         _q->header_counter++;
         if (_q->header_counter == GMSKFRAME_H_SYM) {
             // decode header
+            double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
             gmskframesync_decode_header(_q);
+            FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_HEADER_DECODED, _q->header_valid);
+            if (_q->perfstats_enabled) {
+                _q->perfstats.num_decode_attempts++;
+                _q->perfstats.time_fec += frameperfstats_time() - t0;
+                t0 = frameperfstats_time();
+            }
 
             // invoke callback if header is invalid
             if (!_q->header_valid && _q->callback != NULL) {
@@ -641,6 +774,11 @@ void gmskframesync_execute_rxheader(gmskframesync _q,
                              _q->framestats,
                              _q->userdata);
 
+                if (_q->perfstats_enabled) {
+                    _q->perfstats.time_callback += frameperfstats_time() - t0;
+                    frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+                }
+
                 gmskframesync_reset(_q);
             }
 
@@ -650,8 +788,14 @@ void gmskframesync_execute_rxheader(gmskframesync _q,
                 return;
             }
 
+            if (_q->header_only) {
+                gmskframesync_skip_payload(_q);
+                return;
+            }
+
             // update state
             _q->state = STATE_RXPAYLOAD;
+            FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_STATE, _q->state);
         }
     }
 }
@@ -688,9 +832,16 @@ void gmskframesync_execute_rxpayload(gmskframesync _q,
 
         if (_q->payload_counter == 8*_q->payload_enc_len) {
             // decode payload
+            double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
             _q->payload_valid = packetizer_decode(_q->p_payload,
                                                   _q->payload_enc,
                                                   _q->payload_dec);
+            FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_PAYLOAD_DECODED, _q->payload_valid);
+            if (_q->perfstats_enabled) {
+                _q->perfstats.num_decode_attempts++;
+                _q->perfstats.time_fec += frameperfstats_time() - t0;
+                t0 = frameperfstats_time();
+            }
 
             // invoke callback
             if (_q->callback != NULL) {
@@ -714,6 +865,10 @@ void gmskframesync_execute_rxpayload(gmskframesync _q,
                              _q->framestats,
                              _q->userdata);
             }
+            if (_q->perfstats_enabled) {
+                _q->perfstats.time_callback += frameperfstats_time() - t0;
+                frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+            }
 
             // reset frame synchronizer
             gmskframesync_reset(_q);
@@ -721,6 +876,47 @@ void gmskframesync_execute_rxpayload(gmskframesync _q,
     }
 }
 
+// header-only mode: invoke callback with the decoded header and
+// payload configuration, then skip the payload samples
+void gmskframesync_skip_payload(gmskframesync _q)
+{
+    double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+    if (_q->callback != NULL) {
+        // set framestats internals
+        _q->framestats.rssi          = 20*log10f(_q->gamma_hat);
+        _q->framestats.evm           = 0.0f;
+        _q->framestats.framesyms     = NULL;
+        _q->framestats.num_framesyms = 0;
+        _q->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
+        _q->framestats.mod_bps       = 1;
+        _q->framestats.check         = _q->check;
+        _q->framestats.fec0          = _q->fec0;
+        _q->framestats.fec1          = _q->fec1;
+
+        // invoke callback method
+        _q->callback(_q->header_dec,
+                     _q->header_valid,
+                     NULL,
+                     0,
+                     0,
+                     _q->framestats,
+                     _q->userdata);
+    }
+    if (_q->perfstats_enabled) {
+        _q->perfstats.time_callback += frameperfstats_time() - t0;
+        frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+    }
+
+    // skip one payload bit per symbol at k samples/symbol
+    _q->skip_counter = 8*_q->payload_enc_len*_q->k;
+    if (_q->skip_counter == 0) {
+        gmskframesync_reset(_q);
+        return;
+    }
+    _q->state = STATE_SKIPPAYLOAD;
+    FRAMETRACE(_q, "gmskframesync", LIQUID_FRAMETRACE_STATE, _q->state);
+}
+
 // decode header and re-configure payload decoder
 void gmskframesync_decode_header(gmskframesync _q)
 {
@@ -812,13 +1008,142 @@ void gmskframesync_decode_header(gmskframesync _q)
 #endif
 
         // re-allocate buffers accordingly
-        _q->payload_enc = (unsigned char*) realloc(_q->payload_enc, _q->payload_enc_len*sizeof(unsigned char));
-        _q->payload_dec = (unsigned char*) realloc(_q->payload_dec, _q->payload_dec_len*sizeof(unsigned char));
+        _q->payload_enc = (unsigned char*) liquid_realloc(_q->payload_enc, _q->payload_enc_len*sizeof(unsigned char));
+        _q->payload_dec = (unsigned char*) liquid_realloc(_q->payload_dec, _q->payload_dec_len*sizeof(unsigned char));
     }
     //
 }
 
 
+// enable receiver performance counters
+void gmskframesync_perfstats_enable(gmskframesync _q)
+{
+    _q->perfstats_enabled = 1;
+    _q->perfstats_passes  = qdetector_cccf_gate_get_num_blocks (_q->fft_detector) -
+                            qdetector_cccf_gate_get_num_skipped(_q->fft_detector);
+}
+
+// disable receiver performance counters
+void gmskframesync_perfstats_disable(gmskframesync _q)
+{
+    _q->perfstats_enabled = 0;
+}
+
+// reset receiver performance counters
+void gmskframesync_reset_perfstats(gmskframesync _q)
+{
+    frameperfstats_reset(&_q->perfstats);
+}
+
+// retrieve receiver performance counters
+frameperfstats_s gmskframesync_get_perfstats(gmskframesync _q)
+{
+    return _q->perfstats;
+}
+
+// use FFT block detector for frame detection in place of the
+// time-domain correlator
+void gmskframesync_fft_detector_enable(gmskframesync _q)
+{
+    if (_q->fft_detector_enabled)
+        return;
+    _q->fft_detector_enabled = 1;
+    if (_q->state == STATE_DETECTFRAME)
+        gmskframesync_reset(_q);
+}
+
+// use time-domain correlator for frame detection (default)
+void gmskframesync_fft_detector_disable(gmskframesync _q)
+{
+    if (!_q->fft_detector_enabled)
+        return;
+    _q->fft_detector_enabled = 0;
+    if (_q->state == STATE_DETECTFRAME)
+        gmskframesync_reset(_q);
+}
+
+// set/get header-only mode
+void gmskframesync_set_header_only(gmskframesync _q,
+                                   int           _header_only)
+{
+    _q->header_only = _header_only ? 1 : 0;
+}
+
+int gmskframesync_get_header_only(gmskframesync _q)
+{
+    return _q->header_only;
+}
+
+// set queued frame delivery: frames are copied into _num_slots pooled
+// slots instead of being passed to the callback from execute() (0:
+// direct delivery); with _thread set a delivery thread invokes the
+// callback, otherwise frames are retrieved with gmskframesync_pop_frame()
+void gmskframesync_set_frame_queue(gmskframesync _q,
+                                   unsigned int  _num_slots,
+                                   int           _thread)
+{
+    _q->fq = framequeue_reconfigure(_q->fq, _num_slots, GMSKFRAME_H_USER, _thread,
+                                    &_q->callback, &_q->userdata);
+}
+
+// pop oldest queued frame; buffers remain valid until the next pop
+//  _q      :   frame synchronizer object
+//  _frame  :   received frame [output]
+int gmskframesync_pop_frame(gmskframesync       _q,
+                            framesync_frame_s * _frame)
+{
+    if (_q->fq == NULL || framequeue_is_threaded(_q->fq)) {
+        fprintf(stderr,"error: gmskframesync_pop_frame(), frame queue not enabled or drained by delivery thread\n");
+        exit(1);
+    }
+    return framequeue_pop(_q->fq, _frame);
+}
+
+// get number of frames dropped because the queue was full
+unsigned int gmskframesync_get_frame_queue_drops(gmskframesync _q)
+{
+    return _q->fq == NULL ? 0 : framequeue_get_num_dropped(_q->fq);
+}
+
+// set carrier offset search range of FFT block detector [radians/sample]
+void gmskframesync_fft_detector_set_range(gmskframesync _q,
+                                          float         _dphi_max)
+{
+    qdetector_cccf_set_range(_q->fft_detector, _dphi_max);
+}
+
+// enable energy gate on FFT block detector, bypassing the preamble
+// correlation while the input stays near the noise floor
+void gmskframesync_gate_enable(gmskframesync _q)
+{
+    qdetector_cccf_gate_enable(_q->fft_detector);
+}
+
+// disable energy gate on FFT block detector
+void gmskframesync_gate_disable(gmskframesync _q)
+{
+    qdetector_cccf_gate_disable(_q->fft_detector);
+}
+
+// set energy gate threshold above noise floor [dB]
+void gmskframesync_gate_set_threshold(gmskframesync _q,
+                                      float         _threshold)
+{
+    qdetector_cccf_gate_set_threshold(_q->fft_detector, _threshold);
+}
+
+// number of FFT detector blocks processed
+unsigned int gmskframesync_gate_get_num_blocks(gmskframesync _q)
+{
+    return qdetector_cccf_gate_get_num_blocks(_q->fft_detector);
+}
+
+// number of FFT detector blocks bypassed by energy gate
+unsigned int gmskframesync_gate_get_num_skipped(gmskframesync _q)
+{
+    return qdetector_cccf_gate_get_num_skipped(_q->fft_detector);
+}
+
 void gmskframesync_debug_enable(gmskframesync _q)
 {
     // create debugging objects if necessary
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// montecarlo.c
+//
+// Monte Carlo simulation harness: independent trials (e.g. one packet
+// through generator, channel and synchronizer) executed across a pool of
+// threads, each thread holding its own objects
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define MONTECARLO_THREADS (1)
+#else
+#define MONTECARLO_THREADS (0)
+#endif
+
+// number of trials claimed by a thread at a time
+#define MONTECARLO_CHUNK (16)
+
+struct montecarlo_s {
+    montecarlo_create_callback  create;     // per-thread state constructor
+    montecarlo_trial_callback   trial;      // trial function
+    montecarlo_destroy_callback destroy;    // per-thread state destructor
+    void *                      userdata;   // user-defined data
+    unsigned int                num_trials; // total number of trials
+    unsigned int                seed;       // simulation seed
+    unsigned int                next;       // next unclaimed trial
+    unsigned long int           num_errors; // accumulated errors
+#if MONTECARLO_THREADS
+    pthread_mutex_t             mutex;      // protects next, num_errors
+#endif
+};
+
+// derive seed for trial _i from simulation seed
+unsigned int montecarlo_trial_seed(unsigned int _seed,
+                                   unsigned int _i);
+
+// run trials until none remain, accumulating errors
+void * montecarlo_worker(void * _arg);
+
+// run independent Monte Carlo trials across a pool of threads; trial
+// _i is handed a seed derived from (_seed, _i) alone, so the result does
+// not depend on the number of threads or the order trials complete in,
+// provided trials draw random numbers only from that seed (e.g. through
+// randf_r() and channel_cccf_set_seed()) rather than from randf()
+//  _create     :   create per-thread state from _userdata (may be NULL)
+//  _trial      :   run trial, returning its number of errors
+//  _destroy    :   destroy per-thread state (may be NULL)
+//  _userdata   :   user-defined data passed to _create
+//  _num_trials :   number of trials
+//  _num_threads:   number of threads, including the caller
+//  _seed       :   simulation seed
+unsigned long int montecarlo_run(montecarlo_create_callback  _create,
+                                 montecarlo_trial_callback   _trial,
+                                 montecarlo_destroy_callback _destroy,
+                                 void *                      _userdata,
+                                 unsigned int                _num_trials,
+                                 unsigned int                _num_threads,
+                                 unsigned int                _seed)
+{
+    // validate input
+    if (_trial == NULL) {
+        fprintf(stderr,"error: montecarlo_run(), trial callback cannot be NULL\n");
+        exit(1);
+    } else if (_num_threads == 0) {
+        fprintf(stderr,"error: montecarlo_run(), number of threads must be greater than zero\n");
+        exit(1);
+    }
+
+    struct montecarlo_s q;
+    q.create     = _create;
+    q.trial      = _trial;
+    q.destroy    = _destroy;
+    q.userdata   = _userdata;
+    q.num_trials = _num_trials;
+    q.seed       = _seed;
+    q.next       = 0;
+    q.num_errors = 0;
+
+    unsigned int num_threads = _num_threads;
+    unsigned int max_threads = (_num_trials + MONTECARLO_CHUNK - 1) / MONTECARLO_CHUNK;
+    if (num_threads > max_threads)
+        num_threads = max_threads > 0 ? max_threads : 1;
+
+#if MONTECARLO_THREADS
+    pthread_mutex_init(&q.mutex, NULL);
+
+    // the calling thread runs trials as well
+    pthread_t threads[num_threads];
+    unsigned int i;
+    for (i=0; i<num_threads-1; i++) {
+        if (pthread_create(&threads[i], NULL, montecarlo_worker, &q) != 0) {
+            fprintf(stderr,"error: montecarlo_run(), could not create thread\n");
+            exit(1);
+        }
+    }
+    montecarlo_worker(&q);
+    for (i=0; i<num_threads-1; i++)
+        pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&q.mutex);
+#else
+    if (num_threads > 1)
+        fprintf(stderr,"warning: montecarlo_run(), built without pthreads; running trials serially\n");
+    montecarlo_worker(&q);
+#endif
+
+    return q.num_errors;
+}
+
+//
+// internal methods
+//
+
+// derive seed for trial
+//  _seed   :   simulation seed
+//  _i      :   trial index
+unsigned int montecarlo_trial_seed(unsigned int _seed,
+                                   unsigned int _i)
+{
+    uint64_t z;
+    randf_seed_r(&z, ((uint64_t)_seed << 32) | _i);
+    return (unsigned int)(z >> 32);
+}
+
+// run trials until none remain, accumulating errors
+void * montecarlo_worker(void * _arg)
+{
+    struct montecarlo_s * q = (struct montecarlo_s *) _arg;
+
+    // per-thread state (e.g. frame generator, channel, synchronizer);
+    // created and destroyed serially as objects may share state which
+    // the callbacks cannot lock themselves
+#if MONTECARLO_THREADS
+    pthread_mutex_lock(&q->mutex);
+#endif
+    void * state = q->create == NULL ? q->userdata : q->create(q->userdata);
+#if MONTECARLO_THREADS
+    pthread_mutex_unlock(&q->mutex);
+#endif
+
+    unsigned long int num_errors = 0;
+    while (1) {
+        // claim chunk of trials
+#if MONTECARLO_THREADS
+        pthread_mutex_lock(&q->mutex);
+#endif
+        unsigned int i0 = q->next;
+        unsigned int i1 = i0 + MONTECARLO_CHUNK < q->num_trials ? i0 + MONTECARLO_CHUNK : q->num_trials;
+        q->next = i1;
+#if MONTECARLO_THREADS
+        pthread_mutex_unlock(&q->mutex);
+#endif
+        if (i0 >= i1)
+            break;
+
+        unsigned int i;
+        for (i=i0; i<i1; i++)
+            num_errors += q->trial(state, montecarlo_trial_seed(q->seed, i));
+    }
+
+    // destroy per-thread state and accumulate errors
+#if MONTECARLO_THREADS
+    pthread_mutex_lock(&q->mutex);
+#endif
+    if (q->create != NULL && q->destroy != NULL)
+        q->destroy(state);
+    q->num_errors += num_errors;
+#if MONTECARLO_THREADS
+    pthread_mutex_unlock(&q->mutex);
+#endif
+    return NULL;
+}
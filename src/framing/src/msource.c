@@ -29,6 +29,16 @@
 #include <string.h>
 #include <math.h>
 
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define MSOURCE_THREADS (1)
+#else
+#define MSOURCE_THREADS (0)
+#endif
+
+// number of samples each source generates per block
+#define MSOURCE_BLOCK_LEN (1024)
+
 // forward declaration of internal single source object and methods
 typedef struct QSOURCE(_s) * QSOURCE();
 
@@ -45,6 +55,7 @@ struct QSOURCE(_s) {
         // wide-band noise
         struct {
             IIRFILT() filter;
+            uint64_t  rng;      // generator state (reentrant)
         } noise;
 
         // linear modulation
@@ -62,6 +73,8 @@ struct QSOURCE(_s) {
     nco_crcf mixer;
     float    gain;
     int      enabled;
+
+    TO       buf[MSOURCE_BLOCK_LEN];    // generated block
 };
 
 QSOURCE() QSOURCE(_create_tone)(int _id);
@@ -89,8 +102,35 @@ void QSOURCE(_set_gain)(QSOURCE() _q,
 void QSOURCE(_set_frequency)(QSOURCE() _q,
                              float     _dphi);
 
-void QSOURCE(_gen_sample)(QSOURCE() _q,
-                          TO *      _v);
+// generate block of samples into internal buffer
+void QSOURCE(_gen_block)(QSOURCE()    _q,
+                         unsigned int _n);
+
+#if MSOURCE_THREADS
+// worker pool generating sources of a block in parallel
+struct MSOURCE(_pool_s) {
+    MSOURCE()           q;              // parent object
+    pthread_t *         threads;        // worker threads [num_threads-1]
+    pthread_mutex_t     mutex;          // protects batch state
+    pthread_cond_t      cv_work;        // signalled when batch is posted
+    pthread_cond_t      cv_done;        // signalled when batch completes
+    unsigned long int   batch;          // batch counter
+    unsigned int        block_len;      // samples per source in batch
+    unsigned int        next;           // next source to generate in batch
+    unsigned int        num_done;       // number of sources completed in batch
+    int                 stop;           // worker shutdown flag
+};
+
+// create/destroy worker pool
+void MSOURCE(_pool_create)(MSOURCE() _q);
+void MSOURCE(_pool_destroy)(MSOURCE() _q);
+
+// generate remaining sources of current batch (mutex held on entry/exit)
+void MSOURCE(_pool_run_batch)(struct MSOURCE(_pool_s) * _p);
+
+// worker thread main loop
+void * MSOURCE(_pool_worker)(void * _arg);
+#endif
 
 // internal structure
 struct MSOURCE(_s)
@@ -99,6 +139,11 @@ struct MSOURCE(_s)
     unsigned int num_sources;
 
     int id_counter;
+
+    unsigned int num_threads;   // threads generating sources, including caller
+#if MSOURCE_THREADS
+    struct MSOURCE(_pool_s) * pool;
+#endif
 };
 
 //
@@ -113,12 +158,16 @@ int MSOURCE(_add_source)(MSOURCE() _q,
 MSOURCE() MSOURCE(_create)(void)
 {
     // allocate memory for main object
-    MSOURCE() q = (MSOURCE()) malloc( sizeof(struct MSOURCE(_s)) );
+    MSOURCE() q = (MSOURCE()) liquid_malloc( sizeof(struct MSOURCE(_s)) );
 
     //
     q->sources = NULL;
     q->num_sources = 0;
     q->id_counter  = 0;
+    q->num_threads = 1;
+#if MSOURCE_THREADS
+    q->pool = NULL;
+#endif
 
     // reset and return main object
     MSOURCE(_reset)(q);
@@ -128,16 +177,21 @@ MSOURCE() MSOURCE(_create)(void)
 // destroy msource object, freeing all internal memory
 void MSOURCE(_destroy)(MSOURCE() _q)
 {
+#if MSOURCE_THREADS
+    // stop worker threads
+    MSOURCE(_pool_destroy)(_q);
+#endif
+
     // destroy internal objects
     unsigned int i;
     for (i=0; i<_q->num_sources; i++)
         QSOURCE(_destroy)(_q->sources[i]);
 
     // free list of sources
-    free(_q->sources);
+    liquid_free(_q->sources);
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // reset msource internal state
@@ -317,22 +371,73 @@ void MSOURCE(_write_samples)(MSOURCE()    _q,
                              TO *         _buf,
                              unsigned int _buf_len)
 {
-    TO sample;
-    TO accumulation;
     unsigned int i;
     unsigned int j;
-    for (i=0; i<_buf_len; i++) {
-        accumulation = 0;
+    for (i=0; i<_buf_len; i+=MSOURCE_BLOCK_LEN) {
+        unsigned int n = _buf_len - i < MSOURCE_BLOCK_LEN ? _buf_len - i : MSOURCE_BLOCK_LEN;
+
+        if (_q->num_sources == 0) {
+            memset(&_buf[i], 0x00, n*sizeof(TO));
+            continue;
+        }
 
-        for (j=0; j<_q->num_sources; j++) {
-            QSOURCE(_gen_sample)(_q->sources[j], &sample);
-            accumulation += sample;
+        // each source generates a block into its own buffer
+#if MSOURCE_THREADS
+        if (_q->pool != NULL && _q->num_sources > 1) {
+            struct MSOURCE(_pool_s) * p = _q->pool;
+            pthread_mutex_lock(&p->mutex);
+            p->block_len = n;
+            p->next      = 0;
+            p->num_done  = 0;
+            p->batch++;
+            pthread_cond_broadcast(&p->cv_work);
+
+            // generate alongside worker threads, then wait for batch
+            MSOURCE(_pool_run_batch)(p);
+            while (p->num_done < _q->num_sources)
+                pthread_cond_wait(&p->cv_done, &p->mutex);
+            pthread_mutex_unlock(&p->mutex);
+        } else
+#endif
+        {
+            for (j=0; j<_q->num_sources; j++)
+                QSOURCE(_gen_block)(_q->sources[j], n);
         }
 
-        _buf[i] = accumulation;
+        // combine sources
+        memmove(&_buf[i], _q->sources[0]->buf, n*sizeof(TO));
+        for (j=1; j<_q->num_sources; j++)
+            VECTOR(_add)(&_buf[i], _q->sources[j]->buf, n, &_buf[i]);
     }
 }
 
+// set number of threads generating sources, including the caller
+void MSOURCE(_set_num_threads)(MSOURCE()    _q,
+                               unsigned int _num_threads)
+{
+    if (_num_threads == 0) {
+        fprintf(stderr,"error: msource%s_set_num_threads(), number of threads must be greater than zero\n", EXTENSION);
+        exit(1);
+    }
+
+#if MSOURCE_THREADS
+    MSOURCE(_pool_destroy)(_q);
+    _q->num_threads = _num_threads;
+    if (_q->num_threads > 1)
+        MSOURCE(_pool_create)(_q);
+#else
+    if (_num_threads > 1)
+        fprintf(stderr,"warning: msource%s_set_num_threads(), built without pthreads; generating serially\n", EXTENSION);
+    _q->num_threads = 1;
+#endif
+}
+
+// get number of threads generating sources
+unsigned int MSOURCE(_get_num_threads)(MSOURCE() _q)
+{
+    return _q->num_threads;
+}
+
 //
 // internal msource methods
 //
@@ -346,9 +451,9 @@ int MSOURCE(_add_source)(MSOURCE() _q,
 
     // reallocate
     if (_q->num_sources == 0) {
-        _q->sources = (QSOURCE()*) malloc(sizeof(QSOURCE()));
+        _q->sources = (QSOURCE()*) liquid_malloc(sizeof(QSOURCE()));
     } else {
-        _q->sources = (QSOURCE()*) realloc(_q->sources,
+        _q->sources = (QSOURCE()*) liquid_realloc(_q->sources,
                                            (_q->num_sources+1)*sizeof(QSOURCE()));
     }
 
@@ -382,7 +487,7 @@ QSOURCE() MSOURCE(_get_source)(MSOURCE() _q,
 QSOURCE() QSOURCE(_create_tone)(int _id)
 {
     // allocate memory for main object
-    QSOURCE() q = (QSOURCE()) malloc( sizeof(struct QSOURCE(_s)) );
+    QSOURCE() q = (QSOURCE()) liquid_malloc( sizeof(struct QSOURCE(_s)) );
 
     q->id   = _id;
     q->type = QSOURCE_TONE;
@@ -402,12 +507,13 @@ QSOURCE() QSOURCE(_create_noise)(int   _id,
     // TODO: validate input
 
     // allocate memory for main object
-    QSOURCE() q = (QSOURCE()) malloc( sizeof(struct QSOURCE(_s)) );
+    QSOURCE() q = (QSOURCE()) liquid_malloc( sizeof(struct QSOURCE(_s)) );
 
     q->id   = _id;
     q->type = QSOURCE_NOISE;
 
     unsigned int order = 7;
+    liquid_rand_seed_object(&q->source.noise.rng);
     q->source.noise.filter = IIRFILT(_create_prototype)(LIQUID_IIRDES_ELLIP,
                                                         LIQUID_IIRDES_LOWPASS,
                                                         LIQUID_IIRDES_SOS,
@@ -431,7 +537,7 @@ QSOURCE() QSOURCE(_create_modem)(int          _id,
                                  float        _beta)
 {
     // allocate memory for main object
-    QSOURCE() q = (QSOURCE()) malloc( sizeof(struct QSOURCE(_s)) );
+    QSOURCE() q = (QSOURCE()) liquid_malloc( sizeof(struct QSOURCE(_s)) );
 
     q->id   = _id;
     q->type = QSOURCE_MODEM;
@@ -481,7 +587,7 @@ void QSOURCE(_destroy)(QSOURCE() _q)
     NCO(_destroy)(_q->mixer);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void QSOURCE(_reset)(QSOURCE() _q)
@@ -511,37 +617,118 @@ void QSOURCE(_set_frequency)(QSOURCE() _q,
     NCO(_set_frequency)(_q->mixer, _dphi);
 }
 
-void QSOURCE(_gen_sample)(QSOURCE() _q,
-                          TO *      _v)
+void QSOURCE(_gen_block)(QSOURCE()    _q,
+                         unsigned int _n)
 {
-    TO sample;
-
-    // free internal type-specific objects
+    // generate type-specific samples
     switch (_q->type) {
     case QSOURCE_TONE:
-        sample = 1.0f;
+        VECTOR(_init)(1.0f, _q->buf, _n);
         break;
     case QSOURCE_NOISE:
-        IIRFILT(_execute)(_q->source.noise.filter, (randnf() + _Complex_I*randnf())*M_SQRT1_2, &sample);
+        crandnf_block_r(&_q->source.noise.rng, _q->buf, _n);
+        IIRFILT(_execute_block)(_q->source.noise.filter, _q->buf, _n, _q->buf);
         break;
     case QSOURCE_MODEM:
-        SYMSTREAM(_write_samples)(_q->source.linmod.symstream, &sample, 1);
+        SYMSTREAM(_write_samples)(_q->source.linmod.symstream, _q->buf, _n);
         break;
     default:
-        fprintf(stderr,"error: qsource%s_gen_sample(), internal logic error\n", EXTENSION);
+        fprintf(stderr,"error: qsource%s_gen_block(), internal logic error\n", EXTENSION);
         exit(1);
     }
-    
-    if (!_q->enabled)
-        sample = 0.0f;
 
-    // apply gain
-    sample *= _q->gain;
+    // apply gain (noise is generated with unit variance per component)
+    float g = _q->enabled ? _q->gain : 0.0f;
+    if (_q->type == QSOURCE_NOISE)
+        g *= M_SQRT1_2;
+    VECTOR(_mulscalar)(_q->buf, _n, g, _q->buf);
 
-    // mix sample up
-    NCO(_mix_up)(_q->mixer, sample, _v);
+    // mix block up
+    NCO(_mix_block_up)(_q->mixer, _q->buf, _q->buf, _n);
+}
 
-    // step mixer
-    NCO(_step)(_q->mixer);
+#if MSOURCE_THREADS
+// create worker pool (num_threads-1 workers)
+void MSOURCE(_pool_create)(MSOURCE() _q)
+{
+    struct MSOURCE(_pool_s) * p = (struct MSOURCE(_pool_s)*) liquid_malloc(sizeof(struct MSOURCE(_pool_s)));
+    p->q         = _q;
+    p->batch     = 0;
+    p->block_len = 0;
+    p->next      = 0;
+    p->num_done  = 0;
+    p->stop      = 0;
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->cv_work, NULL);
+    pthread_cond_init(&p->cv_done, NULL);
+
+    // the calling thread generates sources as well
+    p->threads = (pthread_t*) liquid_malloc((_q->num_threads-1)*sizeof(pthread_t));
+    unsigned int i;
+    for (i=0; i<_q->num_threads-1; i++) {
+        if (pthread_create(&p->threads[i], NULL, MSOURCE(_pool_worker), p) != 0) {
+            fprintf(stderr,"error: msource%s_set_num_threads(), could not create thread\n", EXTENSION);
+            exit(1);
+        }
+    }
+    _q->pool = p;
 }
 
+// stop and join worker threads, freeing pool (if any)
+void MSOURCE(_pool_destroy)(MSOURCE() _q)
+{
+    struct MSOURCE(_pool_s) * p = _q->pool;
+    if (p == NULL)
+        return;
+
+    pthread_mutex_lock(&p->mutex);
+    p->stop = 1;
+    pthread_cond_broadcast(&p->cv_work);
+    pthread_mutex_unlock(&p->mutex);
+    unsigned int i;
+    for (i=0; i<_q->num_threads-1; i++)
+        pthread_join(p->threads[i], NULL);
+
+    pthread_mutex_destroy(&p->mutex);
+    pthread_cond_destroy(&p->cv_work);
+    pthread_cond_destroy(&p->cv_done);
+    liquid_free(p->threads);
+    liquid_free(p);
+    _q->pool = NULL;
+}
+
+// generate remaining sources of current batch (mutex held on entry/exit)
+void MSOURCE(_pool_run_batch)(struct MSOURCE(_pool_s) * _p)
+{
+    MSOURCE() q = _p->q;
+    while (_p->next < q->num_sources) {
+        QSOURCE() s = q->sources[_p->next++];
+        pthread_mutex_unlock(&_p->mutex);
+
+        QSOURCE(_gen_block)(s, _p->block_len);
+
+        pthread_mutex_lock(&_p->mutex);
+        if (++_p->num_done == q->num_sources)
+            pthread_cond_signal(&_p->cv_done);
+    }
+}
+
+// worker thread main loop
+void * MSOURCE(_pool_worker)(void * _arg)
+{
+    struct MSOURCE(_pool_s) * p = (struct MSOURCE(_pool_s)*) _arg;
+    unsigned long int batch = 0;
+
+    pthread_mutex_lock(&p->mutex);
+    while (1) {
+        while (p->batch == batch && !p->stop)
+            pthread_cond_wait(&p->cv_work, &p->mutex);
+        if (p->stop)
+            break;
+        batch = p->batch;
+        MSOURCE(_pool_run_batch)(p);
+    }
+    pthread_mutex_unlock(&p->mutex);
+    return NULL;
+}
+#endif
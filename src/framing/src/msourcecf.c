@@ -42,6 +42,7 @@
 #define IIRFILT(name)       LIQUID_CONCAT(iirfilt_crcf,name)
 #define NCO(name)           LIQUID_CONCAT(nco_crcf,name)
 #define SYMSTREAM(name)     LIQUID_CONCAT(symstreamcf,name)
+#define VECTOR(name)        LIQUID_CONCAT(liquid_vectorcf,name)
 
 // source files
 #include "msource.c"
@@ -39,9 +39,24 @@
 // reconfigure internal buffers, objects, etc.
 void ofdmflexframegen_reconfigure(ofdmflexframegen _q);
 
+// reset frame counters and state
+void ofdmflexframegen_reset_frame(ofdmflexframegen _q);
+
+// pack protocol and payload description into header
+void ofdmflexframegen_pack_header(ofdmflexframegen _q,
+                                  unsigned char *  _header,
+                                  unsigned int     _payload_dec_len);
+
 // encode header
 void ofdmflexframegen_encode_header(ofdmflexframegen _q);
 
+// encode frame of batch into lookahead buffers
+void ofdmflexframegen_batch_encode(void *       _q,
+                                   unsigned int _index);
+
+// start writing next frame of batch
+void ofdmflexframegen_batch_next(ofdmflexframegen _q);
+
 // modulate header
 void ofdmflexframegen_modulate_header(ofdmflexframegen _q);
 
@@ -91,9 +106,13 @@ struct ofdmflexframegen_s {
     unsigned int M_data;    // number of data subcarriers
     unsigned int M_S0;      // number of enabled subcarriers in S0
     unsigned int M_S1;      // number of enabled subcarriers in S1
+    unsigned int * data_idx;// data subcarrier indices
 
     // buffers
     float complex * X;      // frequency-domain buffer
+    float complex * buf_block;      // partial symbol for block writes [size: M+cp_len]
+    unsigned int buf_block_index;   // read index of buf_block (M+cp_len if empty)
+    int buf_block_last;             // buf_block holds final symbol of frame
 
     // internal low-level objects
     ofdmframegen fg;        // frame generator object
@@ -134,6 +153,29 @@ struct ofdmflexframegen_s {
 
     // properties
     ofdmflexframegenprops_s props;
+
+    // batch assembly
+    unsigned int batch_num_frames;      // number of frames in batch (0 if none)
+    unsigned int batch_index;           // index of frame being written
+    unsigned char ** batch_headers;     // user-defined headers [batch_num_frames]
+    unsigned char ** batch_payloads;    // payloads [batch_num_frames]
+    unsigned int * batch_payload_lens;  // payload lengths [batch_num_frames]
+    unsigned int batch_gap_len;         // zero-valued samples between frames
+    unsigned int batch_gap_counter;     // gap samples written
+
+    // next frame of batch, encoded in background (allocated on first batch)
+    framegen_lookahead lookahead;       // background encoder
+    packetizer next_p_header;           // header packetizer
+    unsigned char next_header[OFDMFLEXFRAME_H_DEC];     // header data (uncoded)
+    unsigned char next_header_enc[OFDMFLEXFRAME_H_ENC]; // header data (encoded)
+    unsigned char next_header_mod[OFDMFLEXFRAME_H_SYM]; // header symbols
+    packetizer next_p_payload;          // payload packetizer
+    unsigned int next_payload_dec_len;  // payload length (num un-encoded bytes)
+    unsigned char * next_payload_enc;   // payload data (encoded bytes)
+    unsigned char * next_payload_mod;   // payload data (modulated symbols)
+    unsigned int next_payload_enc_len;  // length of encoded payload
+    unsigned int next_payload_mod_len;  // number of modulated symbols in payload
+    unsigned int next_num_symbols_payload; // number of payload OFDM symbols
 };
 
 // create OFDM flexible framing generator object
@@ -157,16 +199,17 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
         exit(1);
     }
 
-    ofdmflexframegen q = (ofdmflexframegen) malloc(sizeof(struct ofdmflexframegen_s));
+    ofdmflexframegen q = (ofdmflexframegen) liquid_malloc(sizeof(struct ofdmflexframegen_s));
     q->M         = _M;          // number of subcarriers
     q->cp_len    = _cp_len;     // cyclic prefix length
     q->taper_len = _taper_len;  // taper length
 
     // allocate memory for transform buffers
-    q->X = (float complex*) malloc((q->M)*sizeof(float complex));
+    q->X = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
+    q->buf_block = (float complex*) liquid_malloc((q->M+q->cp_len)*sizeof(float complex));
 
     // allocate memory for subcarrier allocation IDs
-    q->p = (unsigned char*) malloc((q->M)*sizeof(unsigned char));
+    q->p = (unsigned char*) liquid_malloc((q->M)*sizeof(unsigned char));
     if (_p == NULL) {
         // initialize default subcarrier allocation
         ofdmframe_init_default_sctype(q->M, q->p);
@@ -178,6 +221,12 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
     // validate and count subcarrier allocation
     ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
 
+    // data subcarrier table; pilot and null subcarriers are left
+    // cleared (ofdmframegen handles them)
+    q->data_idx = (unsigned int*) liquid_malloc(q->M_data*sizeof(unsigned int));
+    ofdmframe_index_sctype(q->p, q->M, 1, NULL, q->data_idx);
+    memset(q->X, 0x00, q->M*sizeof(float complex));
+
     // create internal OFDM frame generator object
     q->fg = ofdmframegen_create(q->M, q->cp_len, q->taper_len, q->p);
 
@@ -200,14 +249,21 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
                                      LIQUID_FEC_NONE,
                                      LIQUID_FEC_NONE);
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
-    q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
+    q->payload_enc = (unsigned char*) liquid_malloc(q->payload_enc_len*sizeof(unsigned char));
 
     q->payload_mod_len = 1;
-    q->payload_mod = (unsigned char*) malloc(q->payload_mod_len*sizeof(unsigned char));
+    q->payload_mod = (unsigned char*) liquid_malloc(q->payload_mod_len*sizeof(unsigned char));
 
     // create payload modem (initially QPSK, overridden by properties)
     q->mod_payload = modem_create(LIQUID_MODEM_QPSK);
 
+    // batch assembly (lookahead objects created on first batch)
+    q->batch_num_frames   = 0;
+    q->batch_headers      = NULL;
+    q->batch_payloads     = NULL;
+    q->batch_payload_lens = NULL;
+    q->lookahead          = NULL;
+
     // initialize properties
     ofdmflexframegen_setprops(q, _fgprops);
 
@@ -220,6 +276,18 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
 
 void ofdmflexframegen_destroy(ofdmflexframegen _q)
 {
+    // stop background encoder and destroy lookahead objects
+    if (_q->lookahead != NULL) {
+        framegen_lookahead_destroy(_q->lookahead);
+        packetizer_destroy(_q->next_p_header);
+        packetizer_destroy(_q->next_p_payload);
+        liquid_free(_q->next_payload_enc);
+        liquid_free(_q->next_payload_mod);
+    }
+    liquid_free(_q->batch_headers);
+    liquid_free(_q->batch_payloads);
+    liquid_free(_q->batch_payload_lens);
+
     // destroy internal objects
     ofdmframegen_destroy(_q->fg);       // OFDM frame generator
     packetizer_destroy(_q->p_header);   // header packetizer
@@ -228,16 +296,29 @@ void ofdmflexframegen_destroy(ofdmflexframegen _q)
     modem_destroy(_q->mod_payload);     // payload modulator
 
     // free buffers/arrays
-    free(_q->payload_enc);              // encoded payload bytes
-    free(_q->payload_mod);              // modulated payload symbols
-    free(_q->X);                        // frequency-domain buffer
-    free(_q->p);                        // subcarrier allocation
+    liquid_free(_q->payload_enc);              // encoded payload bytes
+    liquid_free(_q->payload_mod);              // modulated payload symbols
+    liquid_free(_q->X);                        // frequency-domain buffer
+    liquid_free(_q->buf_block);                // partial symbol buffer
+    liquid_free(_q->p);                        // subcarrier allocation
+    liquid_free(_q->data_idx);                 // data subcarrier indices
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void ofdmflexframegen_reset(ofdmflexframegen _q)
+{
+    // abandon batch, waiting for background encoding to finish
+    if (_q->lookahead != NULL)
+        framegen_lookahead_wait(_q->lookahead);
+    _q->batch_num_frames = 0;
+
+    ofdmflexframegen_reset_frame(_q);
+}
+
+// reset frame counters and state
+void ofdmflexframegen_reset_frame(ofdmflexframegen _q)
 {
     // reset symbol counter and state
     _q->symbol_number = 0;
@@ -246,6 +327,8 @@ void ofdmflexframegen_reset(ofdmflexframegen _q)
     _q->frame_complete = 0;
     _q->header_symbol_index = 0;
     _q->payload_symbol_index = 0;
+    _q->buf_block_index = _q->M + _q->cp_len;
+    _q->buf_block_last  = 0;
 
     // reset internal OFDM frame generator object
     // NOTE: this is important for appropriately setting the pilot phases
@@ -304,6 +387,12 @@ void ofdmflexframegen_getprops(ofdmflexframegen _q,
 void ofdmflexframegen_setprops(ofdmflexframegen _q,
                                ofdmflexframegenprops_s * _props)
 {
+    // properties are shared with background encoder during batch
+    if (_q->batch_num_frames > 0) {
+        fprintf(stderr, "warning: ofdmflexframegen_setprops(), batch in progress; must reset() first\n");
+        return;
+    }
+
     // if properties object is NULL, initialize with defaults
     if (_props == NULL) {
         ofdmflexframegen_setprops(_q, &ofdmflexframegenprops_default);
@@ -355,6 +444,10 @@ void ofdmflexframegen_assemble(ofdmflexframegen _q,
                                const unsigned char *  _payload,
                                unsigned int     _payload_len)
 {
+    // abandon batch in progress
+    if (_q->batch_num_frames > 0)
+        ofdmflexframegen_reset(_q);
+
     // check payload length and reconfigure if necessary
     if (_payload_len != _q->payload_dec_len) {
         _q->payload_dec_len = _payload_len;
@@ -394,6 +487,68 @@ void ofdmflexframegen_assemble(ofdmflexframegen _q,
 #endif
 }
 
+// assemble a batch of frames, written back to back by write_block()
+// with '_gap_len' zero-valued samples between consecutive frames; each
+// frame is encoded in the background while the previous frame is
+// being written. Header and payload buffers are not copied and must
+// remain valid until the batch has been written
+//  _q              :   OFDM frame generator object
+//  _num_frames     :   number of frames in batch
+//  _headers        :   frame headers [size: _num_frames x 1]
+//  _payloads       :   payload data [size: _num_frames x 1]
+//  _payload_lens   :   payload data lengths [size: _num_frames x 1]
+//  _gap_len        :   number of zero-valued samples between frames
+void ofdmflexframegen_assemble_batch(ofdmflexframegen _q,
+                                     unsigned int     _num_frames,
+                                     unsigned char ** _headers,
+                                     unsigned char ** _payloads,
+                                     unsigned int *   _payload_lens,
+                                     unsigned int     _gap_len)
+{
+    if (_num_frames == 0) {
+        fprintf(stderr,"error: ofdmflexframegen_assemble_batch(), batch must contain at least one frame\n");
+        exit(1);
+    }
+
+    // abandon any batch and assemble first frame directly
+    ofdmflexframegen_reset(_q);
+    ofdmflexframegen_assemble(_q, _headers[0], _payloads[0], _payload_lens[0]);
+
+    // create lookahead objects on first use
+    if (_q->lookahead == NULL) {
+        _q->next_p_header = packetizer_create(OFDMFLEXFRAME_H_DEC,
+                                              OFDMFLEXFRAME_H_CRC,
+                                              OFDMFLEXFRAME_H_FEC,
+                                              LIQUID_FEC_NONE);
+        _q->next_payload_dec_len = 1;
+        _q->next_p_payload = packetizer_create(_q->next_payload_dec_len,
+                                               LIQUID_CRC_NONE,
+                                               LIQUID_FEC_NONE,
+                                               LIQUID_FEC_NONE);
+        _q->next_payload_enc_len = packetizer_get_enc_msg_len(_q->next_p_payload);
+        _q->next_payload_enc = (unsigned char*) liquid_malloc(_q->next_payload_enc_len*sizeof(unsigned char));
+        _q->next_payload_mod_len = 1;
+        _q->next_payload_mod = (unsigned char*) liquid_malloc(_q->next_payload_mod_len*sizeof(unsigned char));
+        _q->lookahead = framegen_lookahead_create(ofdmflexframegen_batch_encode, _q);
+    }
+
+    // store batch description
+    _q->batch_headers      = (unsigned char **) liquid_realloc(_q->batch_headers,  _num_frames*sizeof(unsigned char *));
+    _q->batch_payloads     = (unsigned char **) liquid_realloc(_q->batch_payloads, _num_frames*sizeof(unsigned char *));
+    _q->batch_payload_lens = (unsigned int *)   liquid_realloc(_q->batch_payload_lens, _num_frames*sizeof(unsigned int));
+    memmove(_q->batch_headers,      _headers,      _num_frames*sizeof(unsigned char *));
+    memmove(_q->batch_payloads,     _payloads,     _num_frames*sizeof(unsigned char *));
+    memmove(_q->batch_payload_lens, _payload_lens, _num_frames*sizeof(unsigned int));
+    _q->batch_num_frames  = _num_frames;
+    _q->batch_index       = 0;
+    _q->batch_gap_len     = _gap_len;
+    _q->batch_gap_counter = 0;
+
+    // start encoding second frame while first is written
+    if (_num_frames > 1)
+        framegen_lookahead_submit(_q->lookahead, 1);
+}
+
 // write symbols of assembled frame
 //  _q              :   OFDM frame generator object
 //  _buffer         :   output buffer [size: N+cp_len x 1]
@@ -446,13 +601,77 @@ int ofdmflexframegen_writesymbol(ofdmflexframegen       _q,
 #if DEBUG_OFDMFLEXFRAMEGEN
         printf(" ...resetting...\n");
 #endif
-        ofdmflexframegen_reset(_q);
+        ofdmflexframegen_reset_frame(_q);
         return 1;
     }
 
     return 0;
 }
 
+// write samples of assembled frame (or batch of frames) into a buffer
+// of arbitrary length, stopping at the end of the frame; whole symbols
+// are written directly into the output buffer and only a symbol
+// straddling the end of the buffer is staged internally. Returns '1'
+// when the final sample of the frame (or of the last frame in a batch)
+// has been written, '0' otherwise; nothing is written if no frame is
+// assembled
+//  _q              :   OFDM frame generator object
+//  _buffer         :   output buffer [size: _buffer_len x 1]
+//  _buffer_len     :   output buffer length
+//  _num_written    :   number of samples written to buffer
+int ofdmflexframegen_write_block(ofdmflexframegen _q,
+                                 float complex *  _buffer,
+                                 unsigned int     _buffer_len,
+                                 unsigned int *   _num_written)
+{
+    unsigned int symbol_len = _q->M + _q->cp_len;
+    unsigned int i = 0;
+    while (i < _buffer_len) {
+        if (_q->buf_block_index < symbol_len) {
+            // drain partial symbol
+            unsigned int n = symbol_len - _q->buf_block_index;
+            if (n > _buffer_len - i)
+                n = _buffer_len - i;
+            memmove(&_buffer[i], &_q->buf_block[_q->buf_block_index], n*sizeof(float complex));
+            _q->buf_block_index += n;
+            i += n;
+        } else if (_q->buf_block_last && _q->batch_index + 1 < _q->batch_num_frames) {
+            // frame of batch complete: write gap, then start next frame
+            if (_q->batch_gap_counter < _q->batch_gap_len) {
+                unsigned int n = _q->batch_gap_len - _q->batch_gap_counter;
+                if (n > _buffer_len - i)
+                    n = _buffer_len - i;
+                memset(&_buffer[i], 0x00, n*sizeof(float complex));
+                _q->batch_gap_counter += n;
+                i += n;
+            } else {
+                ofdmflexframegen_batch_next(_q);
+            }
+        } else if (_q->buf_block_last || !_q->frame_assembled) {
+            break;
+        } else if (_buffer_len - i >= symbol_len) {
+            // write symbol directly into output buffer
+            _q->buf_block_last = ofdmflexframegen_writesymbol(_q, &_buffer[i]);
+            i += symbol_len;
+        } else {
+            // stage symbol straddling end of output buffer
+            _q->buf_block_last  = ofdmflexframegen_writesymbol(_q, _q->buf_block);
+            _q->buf_block_index = 0;
+        }
+    }
+    *_num_written = i;
+
+    // frame complete once final symbol has been drained
+    if (_q->buf_block_last && _q->buf_block_index == symbol_len &&
+        _q->batch_index + 1 >= _q->batch_num_frames)
+    {
+        _q->buf_block_last   = 0;
+        _q->batch_num_frames = 0;
+        return 1;
+    }
+    return 0;
+}
+
 
 //
 // internal
@@ -470,7 +689,7 @@ void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
 
     // re-allocate memory for encoded message
     _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p_payload);
-    _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
+    _q->payload_enc = (unsigned char*) liquid_realloc(_q->payload_enc,
                                                _q->payload_enc_len*sizeof(unsigned char));
 #if DEBUG_OFDMFLEXFRAMEGEN
     printf(">>>> payload : %u (%u encoded)\n", _q->props.payload_len, _q->payload_enc_len);
@@ -484,7 +703,7 @@ void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
     unsigned int bps = modulation_types[_q->props.mod_scheme].bps;
     div_t d = div(8*_q->payload_enc_len, bps);
     _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
-    _q->payload_mod = (unsigned char*)realloc(_q->payload_mod,
+    _q->payload_mod = (unsigned char*)liquid_realloc(_q->payload_mod,
                                               _q->payload_mod_len*sizeof(unsigned char));
 
     // re-compute number of payload OFDM symbols
@@ -492,29 +711,42 @@ void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
     _q->num_symbols_payload = d.quot + (d.rem ? 1 : 0);
 }
 
-// encode header
-void ofdmflexframegen_encode_header(ofdmflexframegen _q)
+// pack protocol and payload description into header following the
+// user-defined section
+//  _q              :   OFDM frame generator object
+//  _header         :   header data [size: OFDMFLEXFRAME_H_DEC x 1]
+//  _payload_dec_len:   payload length
+void ofdmflexframegen_pack_header(ofdmflexframegen _q,
+                                  unsigned char *  _header,
+                                  unsigned int     _payload_dec_len)
 {
     // first 'n' bytes user data
     unsigned int n = OFDMFLEXFRAME_H_USER;
 
     // first byte is for expansion/version validation
-    _q->header[n+0] = OFDMFLEXFRAME_PROTOCOL;
+    _header[n+0] = OFDMFLEXFRAME_PROTOCOL;
 
     // add payload length
-    _q->header[n+1] = (_q->payload_dec_len >> 8) & 0xff;
-    _q->header[n+2] = (_q->payload_dec_len     ) & 0xff;
+    _header[n+1] = (_payload_dec_len >> 8) & 0xff;
+    _header[n+2] = (_payload_dec_len     ) & 0xff;
 
     // add modulation scheme/depth (pack into single byte)
-    _q->header[n+3]  = _q->props.mod_scheme;
+    _header[n+3]  = _q->props.mod_scheme;
 
     // add CRC, forward error-correction schemes
     //  CRC     : most-significant 3 bits of [n+4]
     //  fec0    : least-significant 5 bits of [n+4]
     //  fec1    : least-significant 5 bits of [n+5]
-    _q->header[n+4]  = (_q->props.check & 0x07) << 5;
-    _q->header[n+4] |= (_q->props.fec0) & 0x1f;
-    _q->header[n+5]  = (_q->props.fec1) & 0x1f;
+    _header[n+4]  = (_q->props.check & 0x07) << 5;
+    _header[n+4] |= (_q->props.fec0) & 0x1f;
+    _header[n+5]  = (_q->props.fec1) & 0x1f;
+}
+
+// encode header
+void ofdmflexframegen_encode_header(ofdmflexframegen _q)
+{
+    // add protocol and payload description
+    ofdmflexframegen_pack_header(_q, _q->header, _q->payload_dec_len);
 
     // run packet encoder
     packetizer_encode(_q->p_header, _q->header, _q->header_enc);
@@ -603,31 +835,17 @@ void ofdmflexframegen_write_header(ofdmflexframegen _q,
     printf("writing header symbol\n");
 #endif
 
-    // load data onto data subcarriers
+    // modulate header symbols onto data subcarriers
     unsigned int i;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        //
-        sctype = _q->p[i];
-
-        // 
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // load...
-            if (_q->header_symbol_index < OFDMFLEXFRAME_H_SYM) {
-                // modulate header symbol onto data subcarrier
-                modem_modulate(_q->mod_header, _q->header_mod[_q->header_symbol_index++], &_q->X[i]);
-                //printf("  writing symbol %3u / %3u (x = %8.5f + j%8.5f)\n", _q->header_symbol_index, OFDMFLEXFRAME_H_SYM, crealf(_q->X[i]), cimagf(_q->X[i]));
-            } else {
-                //printf("  random header symbol\n");
-                // load random symbol
-                unsigned int sym = modem_gen_rand_sym(_q->mod_header);
-                modem_modulate(_q->mod_header, sym, &_q->X[i]);
-            }
-        } else {
-            // ignore subcarrier (ofdmframegen handles nulls and pilots)
-            _q->X[i] = 0.0f;
-        }
-    }
+    unsigned int n = OFDMFLEXFRAME_H_SYM - _q->header_symbol_index;
+    if (n > _q->M_data)
+        n = _q->M_data;
+    for (i=0; i<n; i++)
+        modem_modulate(_q->mod_header, _q->header_mod[_q->header_symbol_index++], &_q->X[_q->data_idx[i]]);
+
+    // pad final symbol with random symbols
+    for ( ; i<_q->M_data; i++)
+        modem_modulate(_q->mod_header, modem_gen_rand_sym(_q->mod_header), &_q->X[_q->data_idx[i]]);
 
     // write symbol
     ofdmframegen_writesymbol(_q->fg, _q->X, _buffer);
@@ -647,30 +865,17 @@ void ofdmflexframegen_write_payload(ofdmflexframegen _q,
     printf("writing payload symbol\n");
 #endif
 
-    // load data onto data subcarriers
+    // modulate payload symbols onto data subcarriers
     unsigned int i;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        //
-        sctype = _q->p[i];
-
-        // 
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // load...
-            if (_q->payload_symbol_index < _q->payload_mod_len) {
-                // modulate payload symbol onto data subcarrier
-                modem_modulate(_q->mod_payload, _q->payload_mod[_q->payload_symbol_index++], &_q->X[i]);
-            } else {
-                //printf("  random payload symbol\n");
-                // load random symbol
-                unsigned int sym = modem_gen_rand_sym(_q->mod_payload);
-                modem_modulate(_q->mod_payload, sym, &_q->X[i]);
-            }
-        } else {
-            // ignore subcarrier (ofdmframegen handles nulls and pilots)
-            _q->X[i] = 0.0f;
-        }
-    }
+    unsigned int n = _q->payload_mod_len - _q->payload_symbol_index;
+    if (n > _q->M_data)
+        n = _q->M_data;
+    for (i=0; i<n; i++)
+        modem_modulate(_q->mod_payload, _q->payload_mod[_q->payload_symbol_index++], &_q->X[_q->data_idx[i]]);
+
+    // pad final symbol with random symbols
+    for ( ; i<_q->M_data; i++)
+        modem_modulate(_q->mod_payload, modem_gen_rand_sym(_q->mod_payload), &_q->X[_q->data_idx[i]]);
 
     // write symbol
     ofdmframegen_writesymbol(_q->fg, _q->X, _buffer);
@@ -680,3 +885,90 @@ void ofdmflexframegen_write_payload(ofdmflexframegen _q,
         _q->frame_complete = 1;
 }
 
+// encode frame of batch into lookahead buffers (run in background;
+// touches only the 'next_' objects and read-only batch state)
+//  _q      :   OFDM frame generator object
+//  _index  :   index of frame within batch
+void ofdmflexframegen_batch_encode(void *       _q,
+                                   unsigned int _index)
+{
+    ofdmflexframegen q = (ofdmflexframegen) _q;
+
+    // encode, scramble and repack header
+    q->next_payload_dec_len = q->batch_payload_lens[_index];
+    memmove(q->next_header, q->batch_headers[_index], OFDMFLEXFRAME_H_USER*sizeof(unsigned char));
+    ofdmflexframegen_pack_header(q, q->next_header, q->next_payload_dec_len);
+    packetizer_encode(q->next_p_header, q->next_header, q->next_header_enc);
+    scramble_data(q->next_header_enc, OFDMFLEXFRAME_H_ENC);
+    unsigned int num_written;
+    liquid_repack_bytes(q->next_header_enc, 8, OFDMFLEXFRAME_H_ENC,
+                        q->next_header_mod, modulation_types[OFDMFLEXFRAME_H_MOD].bps, OFDMFLEXFRAME_H_SYM,
+                        &num_written);
+
+    // re-create payload packetizer and re-allocate buffers
+    q->next_p_payload = packetizer_recreate(q->next_p_payload,
+                                            q->next_payload_dec_len,
+                                            q->props.check,
+                                            q->props.fec0,
+                                            q->props.fec1);
+    q->next_payload_enc_len = packetizer_get_enc_msg_len(q->next_p_payload);
+    q->next_payload_enc = (unsigned char*) liquid_realloc(q->next_payload_enc,
+                                                   q->next_payload_enc_len*sizeof(unsigned char));
+    unsigned int bps = modulation_types[q->props.mod_scheme].bps;
+    div_t d = div(8*q->next_payload_enc_len, bps);
+    q->next_payload_mod_len = d.quot + (d.rem ? 1 : 0);
+    q->next_payload_mod = (unsigned char*) liquid_realloc(q->next_payload_mod,
+                                                   q->next_payload_mod_len*sizeof(unsigned char));
+    d = div(q->next_payload_mod_len, q->M_data);
+    q->next_num_symbols_payload = d.quot + (d.rem ? 1 : 0);
+
+    // encode payload and repack into modem symbols
+    packetizer_encode(q->next_p_payload, q->batch_payloads[_index], q->next_payload_enc);
+    memset(q->next_payload_mod, 0x00, q->next_payload_mod_len);
+    liquid_repack_bytes(q->next_payload_enc, 8,   q->next_payload_enc_len,
+                        q->next_payload_mod, bps, q->next_payload_mod_len,
+                        &num_written);
+}
+
+// start writing next frame of batch from lookahead buffers
+void ofdmflexframegen_batch_next(ofdmflexframegen _q)
+{
+    // wait for frame to be encoded
+    framegen_lookahead_wait(_q->lookahead);
+
+    // swap encoded frame into place
+    memmove(_q->header,     _q->next_header,     OFDMFLEXFRAME_H_DEC*sizeof(unsigned char));
+    memmove(_q->header_enc, _q->next_header_enc, OFDMFLEXFRAME_H_ENC*sizeof(unsigned char));
+    memmove(_q->header_mod, _q->next_header_mod, OFDMFLEXFRAME_H_SYM*sizeof(unsigned char));
+
+    packetizer p_payload = _q->p_payload;
+    _q->p_payload      = _q->next_p_payload;
+    _q->next_p_payload = p_payload;
+
+    unsigned char * payload_enc  = _q->payload_enc;
+    unsigned int payload_enc_len = _q->payload_enc_len;
+    _q->payload_enc          = _q->next_payload_enc;
+    _q->payload_enc_len      = _q->next_payload_enc_len;
+    _q->next_payload_enc     = payload_enc;
+    _q->next_payload_enc_len = payload_enc_len;
+
+    unsigned char * payload_mod  = _q->payload_mod;
+    unsigned int payload_mod_len = _q->payload_mod_len;
+    _q->payload_mod          = _q->next_payload_mod;
+    _q->payload_mod_len      = _q->next_payload_mod_len;
+    _q->next_payload_mod     = payload_mod;
+    _q->next_payload_mod_len = payload_mod_len;
+
+    _q->payload_dec_len     = _q->next_payload_dec_len;
+    _q->num_symbols_payload = _q->next_num_symbols_payload;
+
+    // frame counters were reset when previous frame completed
+    _q->frame_assembled = 1;
+    _q->buf_block_last  = 0;
+
+    // start encoding following frame
+    _q->batch_index++;
+    _q->batch_gap_counter = 0;
+    if (_q->batch_index + 1 < _q->batch_num_frames)
+        framegen_lookahead_submit(_q->lookahead, _q->batch_index + 1);
+}
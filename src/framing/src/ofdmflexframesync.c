@@ -34,10 +34,23 @@
 
 #include "liquid.internal.h"
 
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define OFDMFLEXFRAMESYNC_PIPELINE (1)
+#else
+#define OFDMFLEXFRAMESYNC_PIPELINE (0)
+#endif
+
 #define DEBUG_OFDMFLEXFRAMESYNC 0
 
 #define OFDMFLEXFRAME_H_SOFT (0)
 
+// maximum number of payload decode threads
+#define OFDMFLEXFRAMESYNC_MAX_DECODE_THREADS (16)
+
+// number of queued frames per decode thread
+#define OFDMFLEXFRAMESYNC_JOBS_PER_THREAD (2)
+
 // 
 // ofdmflexframesync
 //
@@ -52,12 +65,71 @@ int ofdmflexframesync_internal_callback(float complex * _X,
 void ofdmflexframesync_rxheader(ofdmflexframesync _q,
                                 float complex * _X);
 
-// decode header
-void ofdmflexframesync_decode_header(ofdmflexframesync _q);
+// decode header, returning 0 if rejected by the pre-check without
+// running the decoder
+int ofdmflexframesync_decode_header(ofdmflexframesync _q);
+
+// header-only mode: invoke callback and skip payload symbols
+void ofdmflexframesync_skip_payload(ofdmflexframesync _q);
 
 // receive payload data
 void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
-                                float complex * _X);
+                                 float complex *   _X,
+                                 unsigned int      _num_symbols);
+
+// internal symbol-batch callback
+//  _Y          :   subcarrier symbols [size: _num_symbols x _M]
+//  _num_symbols:   number of OFDM symbols
+//  _p          :   subcarrier allocation
+//  _M          :   number of subcarriers
+//  _userdata   :   user-defined data structure
+int ofdmflexframesync_internal_batch_callback(float complex * _Y,
+                                              unsigned int    _num_symbols,
+                                              unsigned char * _p,
+                                              unsigned int    _M,
+                                              void *          _userdata);
+
+// align length of next symbol batch with remainder of header/payload
+void ofdmflexframesync_update_batch_len(ofdmflexframesync _q);
+
+#if OFDMFLEXFRAMESYNC_PIPELINE
+// decode job: self-contained copy of one received frame
+struct ofdmflexframesync_job_s {
+    unsigned char header[OFDMFLEXFRAME_H_DEC];  // decoded header
+    int header_valid;                   // valid header flag
+    int soft;                           // payload holds soft bits?
+    unsigned int payload_len;           // decoded payload length
+    crc_scheme check;                   // payload validity check
+    fec_scheme fec0;                    // payload FEC (inner)
+    fec_scheme fec1;                    // payload FEC (outer)
+    unsigned char * payload;            // encoded payload (bytes or soft bits)
+    unsigned int payload_alloc;         // allocated length of payload
+    unsigned char * payload_dec;        // decoded payload
+    unsigned int payload_dec_alloc;     // allocated length of payload_dec
+    float complex * syms;               // received payload symbols
+    unsigned int syms_alloc;            // allocated length of syms
+    framesyncstats_s framestats;        // frame statistics
+    double t_execute;                   // time of execute() call completing frame
+};
+
+// decode thread
+struct ofdmflexframesync_worker_s {
+    pthread_t thread;                   // thread handle
+    packetizer p;                       // thread-local payload packetizer
+    ofdmflexframesync q;                // parent synchronizer
+};
+
+// start/stop payload decode threads
+void ofdmflexframesync_pipeline_start(ofdmflexframesync _q,
+                                      unsigned int      _num_threads);
+void ofdmflexframesync_pipeline_stop(ofdmflexframesync _q);
+
+// hand current frame to decode threads (blocks while queue is full)
+void ofdmflexframesync_pipeline_submit(ofdmflexframesync _q);
+
+// decode thread main loop
+void * ofdmflexframesync_pipeline_worker(void * _arg);
+#endif
 
 
 struct ofdmflexframesync_s {
@@ -99,10 +171,21 @@ struct ofdmflexframesync_s {
     modem mod_payload;                  // payload demodulator
     unsigned char * payload_enc;        // payload data (encoded bytes)
     unsigned char * payload_dec;        // payload data (decoded bytes)
+    unsigned char * payload_soft;       // payload data (encoded, soft bits)
+    int payload_soft_enabled;           // soft-decision payload decoding?
+    int payload_soft_frame;             // soft decoding of current payload (latched)
     unsigned int payload_enc_len;       // length of encoded payload
     unsigned int payload_mod_len;       // number of payload modem symbols
     int payload_valid;                  // valid payload flag
+    int header_only;                    // skip payload after valid header?
+    framequeue fq;                      // queued frame delivery (or NULL)
     float complex * payload_syms;       // received payload symbols
+    unsigned int * payload_rxsym;       // demodulated symbols of one batch [batch_max x M]
+    unsigned int * data_idx;            // data subcarrier indices [M_data]
+
+    // symbol batching
+    unsigned int batch_max;             // OFDM symbols per batch (0: per-symbol)
+    unsigned int header_num_symbols;    // OFDM symbols in header
 
     // callback
     framesync_callback callback;        // user-defined callback function
@@ -110,6 +193,12 @@ struct ofdmflexframesync_s {
     framesyncstats_s framestats;        // frame statistic object
     float evm_hat;                      // average error vector magnitude
 
+    // performance counters
+    frameperfstats_s perfstats;         // decode/callback counters
+    int perfstats_enabled;              // gather performance counters?
+    double perfstats_t_execute;         // time of last execute() call
+    unsigned long int perfstats_header_symbols; // OFDM symbols in header
+
     // internal synchronizer objects
     ofdmframesync fs;                   // internal OFDM frame synchronizer
 
@@ -122,6 +211,22 @@ struct ofdmflexframesync_s {
     unsigned int header_symbol_index;   // number of header symbols received
     unsigned int payload_symbol_index;  // number of payload symbols received
     unsigned int payload_buffer_index;  // bit-level index of payload (pack array)
+
+    // pipelined payload decoding
+    unsigned int num_decode_threads;    // number of decode threads (0: inline)
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    struct ofdmflexframesync_worker_s * workers;    // decode threads
+    struct ofdmflexframesync_job_s * jobs;          // job ring [num_jobs]
+    unsigned int num_jobs;              // length of job ring
+    unsigned long int seq_submit;       // number of frames submitted
+    unsigned long int seq_take;         // number of frames taken by threads
+    unsigned long int seq_deliver;      // number of frames delivered
+    int pipeline_stop;                  // decode threads shutdown flag
+    pthread_mutex_t pipeline_mutex;     // protects job ring counters
+    pthread_cond_t  pipeline_job;       // signalled when job submitted
+    pthread_cond_t  pipeline_done;      // signalled when frame delivered
+    frameperfstats_s perfstats_pipeline;// decode thread counters (mutex)
+#endif
 };
 
 // create ofdmflexframesync object
@@ -138,7 +243,7 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
                                            framesync_callback _callback,
                                            void *             _userdata)
 {
-    ofdmflexframesync q = (ofdmflexframesync) malloc(sizeof(struct ofdmflexframesync_s));
+    ofdmflexframesync q = (ofdmflexframesync) liquid_malloc(sizeof(struct ofdmflexframesync_s));
 
     // validate input
     if (_M < 8) {
@@ -157,9 +262,10 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
     q->taper_len = _taper_len;
     q->callback  = _callback;
     q->userdata  = _userdata;
+    q->fq        = NULL;
 
     // allocate memory for subcarrier allocation IDs
-    q->p = (unsigned char*) malloc((q->M)*sizeof(unsigned char));
+    q->p = (unsigned char*) liquid_malloc((q->M)*sizeof(unsigned char));
     if (_p == NULL) {
         // initialize default subcarrier allocation
         ofdmframe_init_default_sctype(q->M, q->p);
@@ -170,6 +276,8 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
 
     // validate and count subcarrier allocation
     ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
+    q->data_idx = (unsigned int*) liquid_malloc(q->M_data*sizeof(unsigned int));
+    ofdmframe_index_sctype(q->p, q->M, 1, NULL, q->data_idx);
 
     // create internal framing object
     q->fs = ofdmframesync_create(_M, _cp_len, _taper_len, _p, ofdmflexframesync_internal_callback, (void*)q);
@@ -195,10 +303,27 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
     q->mod_payload = modem_create(q->ms_payload);
     q->p_payload   = packetizer_create(q->payload_len, q->check, q->fec0, q->fec1);
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
-    q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
-    q->payload_dec = (unsigned char*) malloc(q->payload_len*sizeof(unsigned char));
-    q->payload_syms = (float complex *) malloc(q->payload_len*sizeof(float complex));
+    q->payload_enc = (unsigned char*) liquid_malloc(q->payload_enc_len*sizeof(unsigned char));
+    q->payload_dec = (unsigned char*) liquid_malloc(q->payload_len*sizeof(unsigned char));
+    q->payload_soft = (unsigned char*) liquid_malloc((8*q->payload_enc_len+MAX_MOD_BITS_PER_SYMBOL)*sizeof(unsigned char));
+    q->payload_soft_enabled = 0;
+    q->payload_soft_frame   = 0;
+    q->header_only          = 0;
+    q->payload_syms = (float complex *) liquid_malloc(q->payload_len*sizeof(float complex));
     q->payload_mod_len = 0;
+    q->payload_rxsym = (unsigned int *) liquid_malloc(q->M*sizeof(unsigned int));
+
+    // symbols are demodulated one OFDM symbol at a time by default
+    q->batch_max = 0;
+    q->header_num_symbols = (OFDMFLEXFRAME_H_SYM + q->M_data - 1) / q->M_data;
+
+    // payload is decoded inline by default
+    q->num_decode_threads = 0;
+
+    // performance counters (disabled by default)
+    q->perfstats_enabled = 0;
+    frameperfstats_reset(&q->perfstats);
+    q->perfstats_header_symbols = 0;
 
     // reset state
     ofdmflexframesync_reset(q);
@@ -209,6 +334,15 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
 
 void ofdmflexframesync_destroy(ofdmflexframesync _q)
 {
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    // deliver outstanding frames and join decode threads
+    ofdmflexframesync_pipeline_stop(_q);
+#endif
+
+    // deliver (or discard) queued frames
+    if (_q->fq != NULL)
+        framequeue_destroy(_q->fq);
+
     // destroy internal objects
     ofdmframesync_destroy(_q->fs);
     packetizer_destroy(_q->p_header);
@@ -217,13 +351,16 @@ void ofdmflexframesync_destroy(ofdmflexframesync _q)
     modem_destroy(_q->mod_payload);
 
     // free internal buffers/arrays
-    free(_q->p);
-    free(_q->payload_enc);
-    free(_q->payload_dec);
-    free(_q->payload_syms);
+    liquid_free(_q->p);
+    liquid_free(_q->payload_enc);
+    liquid_free(_q->payload_dec);
+    liquid_free(_q->payload_soft);
+    liquid_free(_q->payload_syms);
+    liquid_free(_q->payload_rxsym);
+    liquid_free(_q->data_idx);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void ofdmflexframesync_print(ofdmflexframesync _q)
@@ -235,12 +372,69 @@ void ofdmflexframesync_print(ofdmflexframesync _q)
     printf("      * data            :   %-u\n", _q->M_data);
     printf("    cyclic prefix len   :   %-u\n", _q->cp_len);
     printf("    taper len           :   %-u\n", _q->taper_len);
+    printf("    payload decoding    :   %s\n", _q->payload_soft_enabled ? "soft" : "hard");
+    if (_q->num_decode_threads > 0)
+        printf("    decode threads      :   %-u\n", _q->num_decode_threads);
+    else
+        printf("    decode threads      :   inline\n");
+    if (_q->perfstats_enabled) {
+        frameperfstats_s stats = ofdmflexframesync_get_perfstats(_q);
+        frameperfstats_print(&stats);
+    }
+}
+
+// get memory footprint of frame synchronizer and all of its internal
+// objects and buffers [bytes]; packetizers private to the decode threads
+// are recreated for each frame and are not counted
+unsigned long int ofdmflexframesync_get_memory_usage(ofdmflexframesync _q)
+{
+    unsigned long int n = sizeof(struct ofdmflexframesync_s);
+
+    // subcarrier allocation and OFDM frame synchronizer
+    n += _q->M*sizeof(unsigned char);
+    n += _q->M_data*sizeof(unsigned int);
+    n += ofdmframesync_get_memory_usage(_q->fs);
+
+    // header and payload objects
+    n += modem_get_memory_usage(_q->mod_header);
+    n += packetizer_get_memory_usage(_q->p_header);
+    n += modem_get_memory_usage(_q->mod_payload);
+    n += packetizer_get_memory_usage(_q->p_payload);
+
+    // payload buffers (payload_syms holds one symbol until the first
+    // header is decoded)
+    n += _q->payload_enc_len*sizeof(unsigned char);
+    n += _q->payload_len*sizeof(unsigned char);
+    n += (8*_q->payload_enc_len+MAX_MOD_BITS_PER_SYMBOL)*sizeof(unsigned char);
+    n += (_q->payload_mod_len > 0 ? _q->payload_mod_len : 1)*sizeof(float complex);
+    n += (_q->batch_max > 1 ? _q->batch_max : 1)*_q->M*sizeof(unsigned int);
+
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    // decode job ring; job buffers only grow, and are resized by the
+    // calling thread alone
+    if (_q->num_decode_threads > 0) {
+        unsigned int i;
+        n += _q->num_decode_threads*sizeof(struct ofdmflexframesync_worker_s);
+        n += _q->num_jobs*sizeof(struct ofdmflexframesync_job_s);
+        for (i=0; i<_q->num_jobs; i++) {
+            n += _q->jobs[i].payload_alloc*sizeof(unsigned char);
+            n += _q->jobs[i].payload_dec_alloc*sizeof(unsigned char);
+            n += _q->jobs[i].syms_alloc*sizeof(float complex);
+        }
+    }
+#endif
+
+    // queued frame delivery
+    if (_q->fq != NULL)
+        n += framequeue_get_memory_usage(_q->fq);
+    return n;
 }
 
 void ofdmflexframesync_reset(ofdmflexframesync _q)
 {
     // reset internal state
     _q->state = OFDMFLEXFRAMESYNC_STATE_HEADER;
+    FRAMETRACE(_q, "ofdmflexframesync", LIQUID_FRAMETRACE_STATE, _q->state);
 
     // reset internal counters
     _q->symbol_counter=0;
@@ -256,6 +450,7 @@ void ofdmflexframesync_reset(ofdmflexframesync _q)
 
     // reset internal OFDM frame synchronizer object
     ofdmframesync_reset(_q->fs);
+    ofdmflexframesync_update_batch_len(_q);
 }
 
 // execute synchronizer object on buffer of samples
@@ -263,10 +458,34 @@ void ofdmflexframesync_execute(ofdmflexframesync _q,
                                float complex * _x,
                                unsigned int _n)
 {
+    if (_q->perfstats_enabled)
+        _q->perfstats_t_execute = frameperfstats_time();
+
     // push samples through ofdmframesync object
     ofdmframesync_execute(_q->fs, _x, _n);
 }
 
+// execute synchronizer object on buffer of interleaved 16-bit I/Q
+// samples; samples are widened in blocks small enough to remain in
+// cache rather than through a full-length intermediate buffer
+//  _q      :   synchronizer object
+//  _x      :   interleaved input array [size: 2*_n x 1]
+//  _n      :   number of complex samples
+//  _scale  :   input scaling factor
+void ofdmflexframesync_execute_ci16(ofdmflexframesync _q,
+                                    const int16_t *   _x,
+                                    unsigned int      _n,
+                                    float             _scale)
+{
+    float complex v[256];
+    unsigned int i;
+    for (i=0; i<_n; i+=256) {
+        unsigned int n = _n - i < 256 ? _n - i : 256;
+        liquid_vectorcf_from_ci16(&_x[2*i], n, _scale, v);
+        ofdmflexframesync_execute(_q, v, n);
+    }
+}
+
 // 
 // query methods
 //
@@ -283,6 +502,199 @@ float ofdmflexframesync_get_cfo(ofdmflexframesync _q)
     return ofdmframesync_get_cfo(_q->fs);
 }
 
+// set payload decoding type: soft-decision demodulation and decoding
+// if _soft is non-zero, hard-decision otherwise (default); takes
+// effect from the next received payload
+void ofdmflexframesync_set_payload_soft(ofdmflexframesync _q,
+                                        int               _soft)
+{
+    _q->payload_soft_enabled = _soft ? 1 : 0;
+}
+
+// get payload decoding type (1 if soft-decision)
+int ofdmflexframesync_get_payload_soft(ofdmflexframesync _q)
+{
+    return _q->payload_soft_enabled;
+}
+
+// set header-only mode: once a valid header has been decoded the
+// callback is invoked without a payload and the remaining symbols of
+// the frame are skipped
+void ofdmflexframesync_set_header_only(ofdmflexframesync _q,
+                                       int               _header_only)
+{
+    _q->header_only = _header_only ? 1 : 0;
+}
+
+// get header-only mode
+int ofdmflexframesync_get_header_only(ofdmflexframesync _q)
+{
+    return _q->header_only;
+}
+
+// set queued frame delivery: frames are copied into _num_slots pooled
+// slots instead of being passed to the callback from execute() (0:
+// direct delivery); with _thread set a delivery thread invokes the
+// callback, otherwise frames are retrieved with ofdmflexframesync_pop_frame()
+void ofdmflexframesync_set_frame_queue(ofdmflexframesync _q,
+                                       unsigned int      _num_slots,
+                                       int               _thread)
+{
+    // decode threads read the callback while delivering
+    ofdmflexframesync_wait(_q);
+    _q->fq = framequeue_reconfigure(_q->fq, _num_slots, OFDMFLEXFRAME_H_USER, _thread,
+                                    &_q->callback, &_q->userdata);
+}
+
+// pop oldest queued frame; buffers remain valid until the next pop
+//  _q      :   frame synchronizer object
+//  _frame  :   received frame [output]
+int ofdmflexframesync_pop_frame(ofdmflexframesync   _q,
+                                framesync_frame_s * _frame)
+{
+    if (_q->fq == NULL || framequeue_is_threaded(_q->fq)) {
+        fprintf(stderr,"error: ofdmflexframesync_pop_frame(), frame queue not enabled or drained by delivery thread\n");
+        exit(1);
+    }
+    return framequeue_pop(_q->fq, _frame);
+}
+
+// get number of frames dropped because the queue was full
+unsigned int ofdmflexframesync_get_frame_queue_drops(ofdmflexframesync _q)
+{
+    return _q->fq == NULL ? 0 : framequeue_get_num_dropped(_q->fq);
+}
+
+// set number of payload decode threads; when non-zero, received
+// payloads are decoded off the sample thread and the callback is
+// invoked from a decode thread, in the order the frames were
+// received; zero decodes inline within ofdmflexframesync_execute()
+// (default); outstanding frames are delivered before the change
+void ofdmflexframesync_set_decode_threads(ofdmflexframesync _q,
+                                          unsigned int      _num_threads)
+{
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    if (_num_threads > OFDMFLEXFRAMESYNC_MAX_DECODE_THREADS) {
+        fprintf(stderr,"warning: ofdmflexframesync_set_decode_threads(), number of threads exceeds maximum (%u); ignoring\n",
+                OFDMFLEXFRAMESYNC_MAX_DECODE_THREADS);
+        return;
+    }
+    if (_num_threads == _q->num_decode_threads)
+        return;
+
+    ofdmflexframesync_pipeline_stop(_q);
+    if (_num_threads > 0)
+        ofdmflexframesync_pipeline_start(_q, _num_threads);
+#else
+    if (_num_threads > 0)
+        fprintf(stderr,"warning: ofdmflexframesync_set_decode_threads(), built without pthreads; ignoring\n");
+#endif
+}
+
+// set number of OFDM symbols demodulated as a block; received symbols
+// are accumulated into a contiguous matrix and the header and payload
+// are demodulated in batches of up to _K symbols rather than one
+// symbol at a time; zero restores per-symbol processing (default);
+// any frame being received is discarded
+void ofdmflexframesync_set_symbol_batch(ofdmflexframesync _q,
+                                        unsigned int      _K)
+{
+    _q->batch_max = _K;
+    if (_K > 0)
+        ofdmframesync_set_batch(_q->fs, _K, ofdmflexframesync_internal_batch_callback);
+    else
+        ofdmframesync_set_batch(_q->fs, 0, NULL);
+
+    unsigned int n = _K > 1 ? _K : 1;
+    _q->payload_rxsym = (unsigned int *) liquid_realloc(_q->payload_rxsym, n*_q->M*sizeof(unsigned int));
+    ofdmflexframesync_reset(_q);
+}
+
+// get number of OFDM symbols demodulated as a block (0 if per-symbol)
+unsigned int ofdmflexframesync_get_symbol_batch(ofdmflexframesync _q)
+{
+    return _q->batch_max;
+}
+
+// get number of payload decode threads (0 if decoding inline)
+unsigned int ofdmflexframesync_get_decode_threads(ofdmflexframesync _q)
+{
+    return _q->num_decode_threads;
+}
+
+// block until all received frames have been delivered to the callback
+void ofdmflexframesync_wait(ofdmflexframesync _q)
+{
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    if (_q->num_decode_threads > 0) {
+        pthread_mutex_lock(&_q->pipeline_mutex);
+        while (_q->seq_deliver != _q->seq_submit)
+            pthread_cond_wait(&_q->pipeline_done, &_q->pipeline_mutex);
+        pthread_mutex_unlock(&_q->pipeline_mutex);
+    }
+#endif
+
+    // frames handed to the queue's delivery thread
+    if (_q->fq != NULL)
+        framequeue_wait(_q->fq);
+}
+
+// enable receiver performance counters
+void ofdmflexframesync_perfstats_enable(ofdmflexframesync _q)
+{
+    _q->perfstats_enabled = 1;
+    ofdmframesync_perf_enable(_q->fs, 1);
+}
+
+// disable receiver performance counters
+void ofdmflexframesync_perfstats_disable(ofdmflexframesync _q)
+{
+    _q->perfstats_enabled = 0;
+    ofdmframesync_perf_enable(_q->fs, 0);
+}
+
+// reset receiver performance counters
+void ofdmflexframesync_reset_perfstats(ofdmflexframesync _q)
+{
+    frameperfstats_reset(&_q->perfstats);
+    _q->perfstats_header_symbols = 0;
+    ofdmframesync_reset_perfcounts(_q->fs);
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    if (_q->num_decode_threads > 0) {
+        pthread_mutex_lock(&_q->pipeline_mutex);
+        frameperfstats_reset(&_q->perfstats_pipeline);
+        pthread_mutex_unlock(&_q->pipeline_mutex);
+    }
+#endif
+}
+
+// retrieve receiver performance counters; the OFDM symbols received
+// after the PLCP are split between header and payload
+frameperfstats_s ofdmflexframesync_get_perfstats(ofdmflexframesync _q)
+{
+    frameperfstats_s stats = _q->perfstats;
+
+    unsigned long int samples[3];
+    unsigned long int header = _q->perfstats_header_symbols * (_q->M + _q->cp_len);
+    ofdmframesync_get_perfcounts(_q->fs, samples, &stats.num_detector_passes);
+    stats.num_samples_detect   = samples[0];
+    stats.num_samples_preamble = samples[1];
+    stats.num_samples_header   = header < samples[2] ? header : samples[2];
+    stats.num_samples_payload  = samples[2] - stats.num_samples_header;
+
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    if (_q->num_decode_threads > 0) {
+        pthread_mutex_lock(&_q->pipeline_mutex);
+        stats.num_decode_attempts += _q->perfstats_pipeline.num_decode_attempts;
+        stats.time_fec            += _q->perfstats_pipeline.time_fec;
+        stats.time_callback       += _q->perfstats_pipeline.time_callback;
+        frameperfstats_merge_latency(&stats, &_q->perfstats_pipeline);
+        pthread_mutex_unlock(&_q->pipeline_mutex);
+    }
+#endif
+    return stats;
+}
+
 // 
 // debugging methods
 //
@@ -335,10 +747,12 @@ int ofdmflexframesync_internal_callback(float complex * _X,
     // extract symbols
     switch (_q->state) {
     case OFDMFLEXFRAMESYNC_STATE_HEADER:
+        if (_q->perfstats_enabled)
+            _q->perfstats_header_symbols++;
         ofdmflexframesync_rxheader(_q, _X);
         break;
     case OFDMFLEXFRAMESYNC_STATE_PAYLOAD:
-        ofdmflexframesync_rxpayload(_q, _X);
+        ofdmflexframesync_rxpayload(_q, _X, 1);
         break;
     default:
         fprintf(stderr,"error: ofdmflexframesync_internal_callback(), unknown/unsupported internal state\n");
@@ -349,6 +763,64 @@ int ofdmflexframesync_internal_callback(float complex * _X,
     return 0;
 }
 
+// internal symbol-batch callback; batches never straddle the header
+// and payload (see ofdmflexframesync_update_batch_len)
+//  _Y          :   subcarrier symbols [size: _num_symbols x _M]
+//  _num_symbols:   number of OFDM symbols
+//  _p          :   subcarrier allocation
+//  _M          :   number of subcarriers
+//  _userdata   :   user-defined data structure
+int ofdmflexframesync_internal_batch_callback(float complex * _Y,
+                                              unsigned int    _num_symbols,
+                                              unsigned char * _p,
+                                              unsigned int    _M,
+                                              void *          _userdata)
+{
+    // type-cast userdata as ofdmflexframesync object
+    ofdmflexframesync _q = (ofdmflexframesync) _userdata;
+
+    unsigned int i;
+    switch (_q->state) {
+    case OFDMFLEXFRAMESYNC_STATE_HEADER:
+        // header is short: demodulate symbol by symbol
+        for (i=0; i<_num_symbols; i++) {
+            _q->symbol_counter++;
+            if (_q->perfstats_enabled)
+                _q->perfstats_header_symbols++;
+            ofdmflexframesync_rxheader(_q, &_Y[i*_M]);
+        }
+        break;
+    case OFDMFLEXFRAMESYNC_STATE_PAYLOAD:
+        _q->symbol_counter += _num_symbols;
+        ofdmflexframesync_rxpayload(_q, _Y, _num_symbols);
+        break;
+    default:
+        fprintf(stderr,"error: ofdmflexframesync_internal_batch_callback(), unknown/unsupported internal state\n");
+        exit(1);
+    }
+
+    ofdmflexframesync_update_batch_len(_q);
+    return 0;
+}
+
+// align length of next symbol batch with remainder of header/payload
+void ofdmflexframesync_update_batch_len(ofdmflexframesync _q)
+{
+    if (_q->batch_max == 0)
+        return;
+
+    unsigned int n;
+    if (_q->state == OFDMFLEXFRAMESYNC_STATE_HEADER) {
+        n = _q->header_num_symbols - _q->symbol_counter;
+    } else {
+        unsigned int r = _q->payload_mod_len - _q->payload_symbol_index;
+        n = (r + _q->M_data - 1) / _q->M_data;
+    }
+    if (n > _q->batch_max) n = _q->batch_max;
+    if (n < 1)             n = 1;
+    ofdmframesync_set_batch_len(_q->fs, n);
+}
+
 // receive header data
 void ofdmflexframesync_rxheader(ofdmflexframesync _q,
                                 float complex * _X)
@@ -357,74 +829,95 @@ void ofdmflexframesync_rxheader(ofdmflexframesync _q,
     printf("  ofdmflexframesync extracting header...\n");
 #endif
 
-    // demodulate header symbols
+    // demodulate header symbols on data subcarriers
     unsigned int i;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        // subcarrier type (PILOT/NULL/DATA)
-        sctype = _q->p[i];
-
-        // ignore pilot and null subcarriers
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // unload header symbols
-            // demodulate header symbol
-            unsigned int sym;
+    for (i=0; i<_q->M_data; i++) {
+        unsigned int k = _q->data_idx[i];
+
+        // unload header symbols
+        // demodulate header symbol
+        unsigned int sym;
 #if OFDMFLEXFRAME_H_SOFT
-            modem_demodulate_soft(_q->mod_header, _X[i], &sym, &_q->header_mod[OFDMFLEXFRAME_H_BPS*_q->header_symbol_index]);
+        modem_demodulate_soft(_q->mod_header, _X[k], &sym, &_q->header_mod[OFDMFLEXFRAME_H_BPS*_q->header_symbol_index]);
 #else
-            modem_demodulate(_q->mod_header, _X[i], &sym);
-            _q->header_mod[_q->header_symbol_index] = sym;
+        modem_demodulate(_q->mod_header, _X[k], &sym);
+        _q->header_mod[_q->header_symbol_index] = sym;
 #endif
-            _q->header_symbol_index++;
-            //printf("  extracting symbol %3u / %3u (x = %8.5f + j%8.5f)\n", _q->header_symbol_index, OFDMFLEXFRAME_H_SYM, crealf(_X[i]), cimagf(_X[i]));
-
-            // get demodulator error vector magnitude
-            float evm = modem_get_demodulator_evm(_q->mod_header);
-            _q->evm_hat += evm*evm;
-
-            // header extracted
-            if (_q->header_symbol_index == OFDMFLEXFRAME_H_SYM) {
-                // decode header
-                ofdmflexframesync_decode_header(_q);
-            
-                // compute error vector magnitude estimate
-                _q->framestats.evm = 10*log10f( _q->evm_hat/OFDMFLEXFRAME_H_SYM );
-
-                // invoke callback if header is invalid
-                if (_q->header_valid)
-                    _q->state = OFDMFLEXFRAMESYNC_STATE_PAYLOAD;
-                else {
-                    //printf("**** header invalid!\n");
-                    // set framestats internals
-                    _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
-                    _q->framestats.cfo              = ofdmframesync_get_cfo(_q->fs);
-                    _q->framestats.framesyms        = NULL;
-                    _q->framestats.num_framesyms    = 0;
-                    _q->framestats.mod_scheme       = LIQUID_MODEM_UNKNOWN;
-                    _q->framestats.mod_bps          = 0;
-                    _q->framestats.check            = LIQUID_CRC_UNKNOWN;
-                    _q->framestats.fec0             = LIQUID_FEC_UNKNOWN;
-                    _q->framestats.fec1             = LIQUID_FEC_UNKNOWN;
-
-                    // invoke callback method
-                    _q->callback(_q->header,
-                                 _q->header_valid,
-                                 NULL,
-                                 0,
-                                 0,
-                                 _q->framestats,
-                                 _q->userdata);
-
+        _q->header_symbol_index++;
+        //printf("  extracting symbol %3u / %3u (x = %8.5f + j%8.5f)\n", _q->header_symbol_index, OFDMFLEXFRAME_H_SYM, crealf(_X[k]), cimagf(_X[k]));
+
+        // get demodulator error vector magnitude
+        float evm = modem_get_demodulator_evm(_q->mod_header);
+        _q->evm_hat += evm*evm;
+
+        // header extracted
+        if (_q->header_symbol_index == OFDMFLEXFRAME_H_SYM) {
+            // decode header
+            double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+            int decoded = ofdmflexframesync_decode_header(_q);
+            FRAMETRACE(_q, "ofdmflexframesync", LIQUID_FRAMETRACE_HEADER_DECODED, _q->header_valid);
+            if (_q->perfstats_enabled) {
+                if (decoded)
+                    _q->perfstats.num_decode_attempts++;
+                else
+                    _q->perfstats.num_header_rejects++;
+                _q->perfstats.time_fec += frameperfstats_time() - t0;
+            }
+        
+            // compute error vector magnitude estimate
+            _q->framestats.evm = 10*log10f( _q->evm_hat/OFDMFLEXFRAME_H_SYM );
+
+            // invoke callback if header is invalid
+            if (_q->header_valid && _q->header_only) {
+                ofdmflexframesync_skip_payload(_q);
+            } else if (_q->header_valid) {
+                _q->state = OFDMFLEXFRAMESYNC_STATE_PAYLOAD;
+                FRAMETRACE(_q, "ofdmflexframesync", LIQUID_FRAMETRACE_STATE, _q->state);
+            } else {
+                //printf("**** header invalid!\n");
+                // set framestats internals
+                _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
+                _q->framestats.cfo              = ofdmframesync_get_cfo(_q->fs);
+                _q->framestats.framesyms        = NULL;
+                _q->framestats.num_framesyms    = 0;
+                _q->framestats.mod_scheme       = LIQUID_MODEM_UNKNOWN;
+                _q->framestats.mod_bps          = 0;
+                _q->framestats.check            = LIQUID_CRC_UNKNOWN;
+                _q->framestats.fec0             = LIQUID_FEC_UNKNOWN;
+                _q->framestats.fec1             = LIQUID_FEC_UNKNOWN;
+
+#if OFDMFLEXFRAMESYNC_PIPELINE
+                // keep callbacks in order with queued frames
+                if (_q->num_decode_threads > 0) {
+                    ofdmflexframesync_pipeline_submit(_q);
                     ofdmflexframesync_reset(_q);
+                    break;
                 }
-                break;
+#endif
+                // invoke callback method
+                t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+                _q->callback(_q->header,
+                             _q->header_valid,
+                             NULL,
+                             0,
+                             0,
+                             _q->framestats,
+                             _q->userdata);
+                if (_q->perfstats_enabled) {
+                    _q->perfstats.time_callback += frameperfstats_time() - t0;
+                    frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+                }
+
+                ofdmflexframesync_reset(_q);
             }
+            break;
         }
     }
 }
 
-// decode header
-void ofdmflexframesync_decode_header(ofdmflexframesync _q)
+// decode header, returning 0 if rejected by the pre-check without
+// running the decoder
+int ofdmflexframesync_decode_header(ofdmflexframesync _q)
 {
 #if OFDMFLEXFRAME_H_SOFT
 #  if 0
@@ -453,6 +946,13 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q)
     // unscramble header
     unscramble_data(_q->header_enc, OFDMFLEXFRAME_H_ENC);
 
+    // reject false detections from the syndromes of the header code
+    // before running the decoder
+    if (!packetizer_precheck(_q->p_header, _q->header_enc, OFDMFLEXFRAME_H_PRECHECK)) {
+        _q->header_valid = 0;
+        return 0;
+    }
+
     // run packet decoder
     _q->header_valid = packetizer_decode(_q->p_header, _q->header_enc, _q->header);
 #endif
@@ -475,7 +975,7 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q)
     printf("****** header extracted [%s]\n", _q->header_valid ? "valid" : "INVALID!");
 #endif
     if (!_q->header_valid)
-        return;
+        return 1;
 
     unsigned int n = OFDMFLEXFRAME_H_USER;
 
@@ -493,7 +993,7 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q)
     if (mod_scheme == 0 || mod_scheme >= LIQUID_MODEM_NUM_SCHEMES) {
         fprintf(stderr,"warning: ofdmflexframesync_decode_header(), invalid modulation scheme\n");
         _q->header_valid = 0;
-        return;
+        return 1;
     }
 
     // strip off CRC, forward error-correction schemes
@@ -563,95 +1063,369 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q)
 #endif
 
         // re-allocate buffers accordingly
-        _q->payload_enc = (unsigned char*) realloc(_q->payload_enc, _q->payload_enc_len*sizeof(unsigned char));
-        _q->payload_dec = (unsigned char*) realloc(_q->payload_dec, _q->payload_len*sizeof(unsigned char));
+        _q->payload_enc = (unsigned char*) liquid_realloc(_q->payload_enc, _q->payload_enc_len*sizeof(unsigned char));
+        _q->payload_dec = (unsigned char*) liquid_realloc(_q->payload_dec, _q->payload_len*sizeof(unsigned char));
+        // soft buffer has room for padding of the final symbol
+        _q->payload_soft = (unsigned char*) liquid_realloc(_q->payload_soft, (8*_q->payload_enc_len+MAX_MOD_BITS_PER_SYMBOL)*sizeof(unsigned char));
+
+        // latch payload decoding type for this frame
+        _q->payload_soft_frame = _q->payload_soft_enabled;
 
         // re-compute number of modulated payload symbols
         div_t d = div(8*_q->payload_enc_len, _q->bps_payload);
         _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
-        _q->payload_syms = (float complex*) realloc(_q->payload_syms, _q->payload_mod_len*sizeof(float complex));
+        _q->payload_syms = (float complex*) liquid_realloc(_q->payload_syms, _q->payload_mod_len*sizeof(float complex));
 #if DEBUG_OFDMFLEXFRAMESYNC
         printf("      * payload mod syms:   %u symbols\n", _q->payload_mod_len);
 #endif
     }
+    return 1;
+}
+
+// header-only mode: invoke callback with the decoded header and
+// payload configuration, then skip the payload OFDM symbols
+void ofdmflexframesync_skip_payload(ofdmflexframesync _q)
+{
+    // set framestats internals
+    _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
+    _q->framestats.cfo              = ofdmframesync_get_cfo(_q->fs);
+    _q->framestats.framesyms        = NULL;
+    _q->framestats.num_framesyms    = 0;
+    _q->framestats.mod_scheme       = _q->ms_payload;
+    _q->framestats.mod_bps          = _q->bps_payload;
+    _q->framestats.check            = _q->check;
+    _q->framestats.fec0             = _q->fec0;
+    _q->framestats.fec1             = _q->fec1;
+
+    // keep callbacks in order with frames already queued for decoding
+    ofdmflexframesync_wait(_q);
+
+    // invoke callback method
+    double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+    if (_q->callback != NULL) {
+        _q->callback(_q->header,
+                     _q->header_valid,
+                     NULL,
+                     0,
+                     0,
+                     _q->framestats,
+                     _q->userdata);
+    }
+    if (_q->perfstats_enabled) {
+        _q->perfstats.time_callback += frameperfstats_time() - t0;
+        frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+    }
+
+    // payload starts on the OFDM symbol following the header
+    unsigned int num_symbols = (_q->payload_mod_len + _q->M_data - 1) / _q->M_data;
+    ofdmflexframesync_reset(_q);
+    ofdmframesync_skip_symbols(_q->fs, num_symbols);
 }
 
 // receive payload data
 void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
-                                 float complex * _X)
+                                 float complex *   _X,
+                                 unsigned int      _num_symbols)
 {
-    // demodulate paylod symbols
-    unsigned int i;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        // subcarrier type (PILOT/NULL/DATA)
-        sctype = _q->p[i];
-
-        // ignore pilot and null subcarriers
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // unload payload symbols
-            unsigned int sym;
-            modem_demodulate(_q->mod_payload, _X[i], &sym);
-
-            // store received symbol
-            _q->payload_syms[_q->payload_symbol_index] = _X[i];
-
-            // pack decoded symbol into array
-            liquid_pack_array(_q->payload_enc,
-                              _q->payload_enc_len,
-                              _q->payload_buffer_index,
-                              _q->bps_payload,
-                              sym);
-
-            // increment...
-            _q->payload_buffer_index += _q->bps_payload;
-
-            // increment symbol counter
-            _q->payload_symbol_index++;
-
-            if (_q->payload_symbol_index == _q->payload_mod_len) {
-                // payload extracted
-
-                // decode payload
-                _q->payload_valid = packetizer_decode(_q->p_payload, _q->payload_enc, _q->payload_dec);
+    // gather data subcarriers of all OFDM symbols into received symbol
+    // buffer; the final symbol may be only partially occupied
+    unsigned int i, j;
+    unsigned int i0 = _q->payload_symbol_index;
+    unsigned int n = _num_symbols*_q->M_data;
+    if (n > _q->payload_mod_len - i0)
+        n = _q->payload_mod_len - i0;
+    float complex * r = &_q->payload_syms[i0];
+    for (j=0; j<n; j+=_q->M_data) {
+        unsigned int m = n - j < _q->M_data ? n - j : _q->M_data;
+        for (i=0; i<m; i++)
+            r[j+i] = _X[_q->data_idx[i]];
+        _X += _q->M;
+    }
+    _q->payload_symbol_index += n;
+
+    // demodulate payload symbols as a block
+    if (_q->payload_soft_frame) {
+        // soft bits of padding of the final symbol are written past
+        // the encoded payload (see ofdmflexframesync_decode_header)
+        modem_demodulate_soft_block(_q->mod_payload,
+                                    &_q->payload_syms[i0],
+                                    n,
+                                    _q->payload_rxsym,
+                                    &_q->payload_soft[_q->payload_buffer_index]);
+        _q->payload_buffer_index += n*_q->bps_payload;
+    } else {
+        modem_demodulate_block(_q->mod_payload, &_q->payload_syms[i0], n, _q->payload_rxsym);
+
+        // pack decoded symbols into array
+        liquid_pack_array_block(_q->payload_enc,
+                                _q->payload_enc_len,
+                                _q->payload_buffer_index,
+                                _q->bps_payload,
+                                _q->payload_rxsym,
+                                n);
+        _q->payload_buffer_index += n*_q->bps_payload;
+    }
+
+    if (_q->payload_symbol_index < _q->payload_mod_len)
+        return;
+
+    // payload extracted; ignore callback if set to NULL
+    if (_q->callback == NULL) {
+        ofdmflexframesync_reset(_q);
+        return;
+    }
+
+    // set framestats internals
+    _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
+    _q->framestats.cfo              = ofdmframesync_get_cfo(_q->fs);
+    _q->framestats.framesyms        = _q->payload_syms;
+    _q->framestats.num_framesyms    = _q->payload_mod_len;
+    _q->framestats.mod_scheme       = _q->ms_payload;
+    _q->framestats.mod_bps          = _q->bps_payload;
+    _q->framestats.check            = _q->check;
+    _q->framestats.fec0             = _q->fec0;
+    _q->framestats.fec1             = _q->fec1;
+
+#if OFDMFLEXFRAMESYNC_PIPELINE
+    // hand payload to decode threads
+    if (_q->num_decode_threads > 0) {
+        ofdmflexframesync_pipeline_submit(_q);
+        ofdmflexframesync_reset(_q);
+        return;
+    }
+#endif
+
+    // decode payload
+    double t0 = _q->perfstats_enabled ? frameperfstats_time() : 0.0;
+    if (_q->payload_soft_frame)
+        _q->payload_valid = packetizer_decode_soft(_q->p_payload, _q->payload_soft, _q->payload_dec);
+    else
+        _q->payload_valid = packetizer_decode(_q->p_payload, _q->payload_enc, _q->payload_dec);
+    FRAMETRACE(_q, "ofdmflexframesync", LIQUID_FRAMETRACE_PAYLOAD_DECODED, _q->payload_valid);
+    if (_q->perfstats_enabled) {
+        _q->perfstats.num_decode_attempts++;
+        _q->perfstats.time_fec += frameperfstats_time() - t0;
+        t0 = frameperfstats_time();
+    }
 #if DEBUG_OFDMFLEXFRAMESYNC
-                printf("****** payload extracted [%s]\n", _q->payload_valid ? "valid" : "INVALID!");
+    printf("****** payload extracted [%s]\n", _q->payload_valid ? "valid" : "INVALID!");
 #endif
 
-                // ignore callback if set to NULL
-                if (_q->callback == NULL) {
-                    ofdmflexframesync_reset(_q);
-                    break;
-                }
+    // invoke callback method
+    _q->callback(_q->header,
+                 _q->header_valid,
+                 _q->payload_dec,
+                 _q->payload_len,
+                 _q->payload_valid,
+                 _q->framestats,
+                 _q->userdata);
+    if (_q->perfstats_enabled) {
+        _q->perfstats.time_callback += frameperfstats_time() - t0;
+        frameperfstats_add_latency(&_q->perfstats, t0 - _q->perfstats_t_execute);
+    }
 
-                // set framestats internals
-                _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
-                _q->framestats.cfo              = ofdmframesync_get_cfo(_q->fs);
-                _q->framestats.framesyms        = _q->payload_syms;
-                _q->framestats.num_framesyms    = _q->payload_mod_len;
-                _q->framestats.mod_scheme       = _q->ms_payload;
-                _q->framestats.mod_bps          = _q->bps_payload;
-                _q->framestats.check            = _q->check;
-                _q->framestats.fec0             = _q->fec0;
-                _q->framestats.fec1             = _q->fec1;
+    // reset object
+    ofdmflexframesync_reset(_q);
+}
 
-                // invoke callback method
-                _q->callback(_q->header,
-                             _q->header_valid,
-                             _q->payload_dec,
-                             _q->payload_len,
-                             _q->payload_valid,
-                             _q->framestats,
-                             _q->userdata);
 
 
-                // reset object
-                ofdmflexframesync_reset(_q);
-                break;
-            }
+
+#if OFDMFLEXFRAMESYNC_PIPELINE
+// 
+// pipelined payload decoding
+//
+// Frames are copied into a ring of jobs indexed by sequence number;
+// the sample thread blocks only when every slot is still waiting to
+// be delivered.  Decode threads take jobs in sequence order, decode
+// concurrently, and invoke the callback strictly in sequence order.
+//
+
+// start payload decode threads
+void ofdmflexframesync_pipeline_start(ofdmflexframesync _q,
+                                      unsigned int      _num_threads)
+{
+    _q->num_jobs = OFDMFLEXFRAMESYNC_JOBS_PER_THREAD * _num_threads;
+    _q->jobs = (struct ofdmflexframesync_job_s*) liquid_calloc(_q->num_jobs, sizeof(struct ofdmflexframesync_job_s));
+    _q->workers = (struct ofdmflexframesync_worker_s*) liquid_malloc(_num_threads*sizeof(struct ofdmflexframesync_worker_s));
+    _q->seq_submit    = 0;
+    _q->seq_take      = 0;
+    _q->seq_deliver   = 0;
+    _q->pipeline_stop = 0;
+    frameperfstats_reset(&_q->perfstats_pipeline);
+    pthread_mutex_init(&_q->pipeline_mutex, NULL);
+    pthread_cond_init(&_q->pipeline_job,  NULL);
+    pthread_cond_init(&_q->pipeline_done, NULL);
+
+    unsigned int i;
+    for (i=0; i<_num_threads; i++) {
+        _q->workers[i].p = NULL;
+        _q->workers[i].q = _q;
+        if (pthread_create(&_q->workers[i].thread, NULL, ofdmflexframesync_pipeline_worker, &_q->workers[i]) != 0) {
+            fprintf(stderr,"error: ofdmflexframesync_pipeline_start(), could not create decode thread\n");
+            exit(1);
+        }
+    }
+    _q->num_decode_threads = _num_threads;
+}
+
+// deliver outstanding frames and stop payload decode threads
+void ofdmflexframesync_pipeline_stop(ofdmflexframesync _q)
+{
+    if (_q->num_decode_threads == 0)
+        return;
+
+    pthread_mutex_lock(&_q->pipeline_mutex);
+    _q->pipeline_stop = 1;
+    pthread_cond_broadcast(&_q->pipeline_job);
+    pthread_mutex_unlock(&_q->pipeline_mutex);
+
+    unsigned int i;
+    for (i=0; i<_q->num_decode_threads; i++) {
+        pthread_join(_q->workers[i].thread, NULL);
+        if (_q->workers[i].p != NULL)
+            packetizer_destroy(_q->workers[i].p);
+    }
+
+    for (i=0; i<_q->num_jobs; i++) {
+        liquid_free(_q->jobs[i].payload);
+        liquid_free(_q->jobs[i].payload_dec);
+        liquid_free(_q->jobs[i].syms);
+    }
+    liquid_free(_q->jobs);
+
+    // keep counters gathered by the decode threads
+    _q->perfstats.num_decode_attempts += _q->perfstats_pipeline.num_decode_attempts;
+    _q->perfstats.time_fec            += _q->perfstats_pipeline.time_fec;
+    _q->perfstats.time_callback       += _q->perfstats_pipeline.time_callback;
+    frameperfstats_merge_latency(&_q->perfstats, &_q->perfstats_pipeline);
+    liquid_free(_q->workers);
+    pthread_mutex_destroy(&_q->pipeline_mutex);
+    pthread_cond_destroy(&_q->pipeline_job);
+    pthread_cond_destroy(&_q->pipeline_done);
+    _q->num_decode_threads = 0;
+}
+
+// hand current frame to decode threads (blocks while queue is full)
+void ofdmflexframesync_pipeline_submit(ofdmflexframesync _q)
+{
+    // wait for the slot's previous frame to be delivered
+    pthread_mutex_lock(&_q->pipeline_mutex);
+    while (_q->seq_submit - _q->seq_deliver >= _q->num_jobs)
+        pthread_cond_wait(&_q->pipeline_done, &_q->pipeline_mutex);
+    pthread_mutex_unlock(&_q->pipeline_mutex);
+
+    // slot is owned by the sample thread until submitted
+    struct ofdmflexframesync_job_s * job = &_q->jobs[_q->seq_submit % _q->num_jobs];
+    memmove(job->header, _q->header, OFDMFLEXFRAME_H_DEC*sizeof(unsigned char));
+    job->header_valid = _q->header_valid;
+    job->framestats   = _q->framestats;
+    job->t_execute    = _q->perfstats_t_execute;
+    if (_q->header_valid) {
+        job->soft        = _q->payload_soft_frame;
+        job->payload_len = _q->payload_len;
+        job->check       = _q->check;
+        job->fec0        = _q->fec0;
+        job->fec1        = _q->fec1;
+
+        unsigned int n = job->soft ? 8*_q->payload_enc_len : _q->payload_enc_len;
+        if (n > job->payload_alloc) {
+            job->payload = (unsigned char*) liquid_realloc(job->payload, n*sizeof(unsigned char));
+            job->payload_alloc = n;
         }
+        memmove(job->payload, job->soft ? _q->payload_soft : _q->payload_enc, n*sizeof(unsigned char));
+
+        if (_q->payload_len > job->payload_dec_alloc) {
+            job->payload_dec = (unsigned char*) liquid_realloc(job->payload_dec, _q->payload_len*sizeof(unsigned char));
+            job->payload_dec_alloc = _q->payload_len;
+        }
+
+        if (_q->payload_mod_len > job->syms_alloc) {
+            job->syms = (float complex*) liquid_realloc(job->syms, _q->payload_mod_len*sizeof(float complex));
+            job->syms_alloc = _q->payload_mod_len;
+        }
+        memmove(job->syms, _q->payload_syms, _q->payload_mod_len*sizeof(float complex));
+        job->framestats.framesyms = job->syms;
     }
+
+    pthread_mutex_lock(&_q->pipeline_mutex);
+    _q->seq_submit++;
+    pthread_cond_signal(&_q->pipeline_job);
+    pthread_mutex_unlock(&_q->pipeline_mutex);
 }
 
+// decode thread main loop
+void * ofdmflexframesync_pipeline_worker(void * _arg)
+{
+    struct ofdmflexframesync_worker_s * w = (struct ofdmflexframesync_worker_s*) _arg;
+    ofdmflexframesync q = w->q;
+
+    pthread_mutex_lock(&q->pipeline_mutex);
+    while (1) {
+        // wait for job; exit only once the queue has drained
+        while (q->seq_take == q->seq_submit && !q->pipeline_stop)
+            pthread_cond_wait(&q->pipeline_job, &q->pipeline_mutex);
+        if (q->seq_take == q->seq_submit)
+            break;
+        unsigned long int seq = q->seq_take++;
+        pthread_mutex_unlock(&q->pipeline_mutex);
+
+        // decode payload
+        struct ofdmflexframesync_job_s * job = &q->jobs[seq % q->num_jobs];
+        int    payload_valid = 0;
+        int    perf          = q->perfstats_enabled;
+        double time_fec      = 0.0;
+        double time_callback = 0.0;
+        double latency       = 0.0;
+        double t0 = perf ? frameperfstats_time() : 0.0;
+        if (job->header_valid) {
+            w->p = packetizer_recreate(w->p, job->payload_len, job->check, job->fec0, job->fec1);
+            if (job->soft)
+                payload_valid = packetizer_decode_soft(w->p, job->payload, job->payload_dec);
+            else
+                payload_valid = packetizer_decode(w->p, job->payload, job->payload_dec);
+            FRAMETRACE(q, "ofdmflexframesync", LIQUID_FRAMETRACE_PAYLOAD_DECODED, payload_valid);
+            if (perf)
+                time_fec = frameperfstats_time() - t0;
+        }
+
+        // wait for turn to deliver
+        pthread_mutex_lock(&q->pipeline_mutex);
+        while (q->seq_deliver != seq)
+            pthread_cond_wait(&q->pipeline_done, &q->pipeline_mutex);
+        pthread_mutex_unlock(&q->pipeline_mutex);
+
+        // invoke callback method; other threads deliver only after
+        // seq_deliver advances, so callbacks never overlap
+        t0 = perf ? frameperfstats_time() : 0.0;
+        latency = t0 - job->t_execute;
+        if (q->callback != NULL) {
+            q->callback(job->header,
+                        job->header_valid,
+                        job->header_valid ? job->payload_dec : NULL,
+                        job->header_valid ? job->payload_len : 0,
+                        payload_valid,
+                        job->framestats,
+                        q->userdata);
+        }
 
+        if (perf)
+            time_callback = frameperfstats_time() - t0;
 
+        pthread_mutex_lock(&q->pipeline_mutex);
+        if (perf) {
+            q->perfstats_pipeline.num_decode_attempts += job->header_valid ? 1 : 0;
+            q->perfstats_pipeline.time_fec            += time_fec;
+            q->perfstats_pipeline.time_callback       += time_callback;
+            frameperfstats_add_latency(&q->perfstats_pipeline, latency);
+        }
+        q->seq_deliver++;
+        pthread_cond_broadcast(&q->pipeline_done);
+    }
+    pthread_mutex_unlock(&q->pipeline_mutex);
+
+    // hand over trace records before the thread's buffer is lost
+    frametrace_flush();
+    return NULL;
+}
+#endif
@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ofdmmuframegen.c
+//
+// OFDMA multi-user frame generator: users share the PLCP, pilots and
+// transform of a single OFDM frame and occupy disjoint sets of data
+// subcarriers. Each user carries an ofdmflexframe header and payload
+// (with its own modulation and coding) on its own subcarriers; users
+// whose frame is shorter than the longest one, or which have nothing
+// assembled, fill their subcarriers with random header symbols.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+#define DEBUG_OFDMMUFRAMEGEN            0
+
+// per-user state
+struct ofdmmuframegen_user_s {
+    unsigned int M_data;                // number of data subcarriers
+    unsigned int * data_idx;            // data subcarrier indices [M_data]
+    ofdmflexframegenprops_s props;      // payload properties
+    int assembled;                      // frame assembled for user?
+
+    // derived lengths
+    unsigned int num_symbols_header;    // number of header OFDM symbols
+    unsigned int num_symbols_payload;   // number of payload OFDM symbols
+
+    // header
+    unsigned char header[OFDMFLEXFRAME_H_DEC];      // header data (uncoded)
+    unsigned char header_enc[OFDMFLEXFRAME_H_ENC];  // header data (encoded)
+    unsigned char header_mod[OFDMFLEXFRAME_H_SYM];  // header symbols
+
+    // payload
+    packetizer p_payload;               // payload packetizer
+    unsigned int payload_dec_len;       // payload length (num un-encoded bytes)
+    modem mod_payload;                  // payload modulator
+    unsigned char * payload_enc;        // payload data (encoded bytes)
+    unsigned char * payload_mod;        // payload data (modulated symbols)
+    unsigned int payload_enc_len;       // length of encoded payload
+    unsigned int payload_mod_len;       // number of modulated symbols in payload
+
+    // counters
+    unsigned int header_symbol_index;   // header symbols written
+    unsigned int payload_symbol_index;  // payload symbols written
+};
+
+struct ofdmmuframegen_s {
+    unsigned int M;         // number of subcarriers
+    unsigned int cp_len;    // cyclic prefix length
+    unsigned int taper_len; // taper length
+    unsigned char * p;      // subcarrier allocation (null, pilot, data)
+
+    // constants
+    unsigned int M_null;    // number of null subcarriers
+    unsigned int M_pilot;   // number of pilot subcarriers
+    unsigned int M_data;    // number of data subcarriers
+
+    // users
+    unsigned int num_users;                 // number of users
+    struct ofdmmuframegen_user_s * users;   // user state [num_users]
+
+    // buffers, internal objects
+    float complex * X;      // frequency-domain buffer
+    ofdmframegen fg;        // frame generator object
+    modem mod_header;       // header modulator (shared)
+    packetizer p_header;    // header packetizer (shared)
+
+    // counters/states
+    unsigned int symbol_number;         // data symbols written
+    unsigned int num_symbols;           // data symbols in frame
+    enum {
+        OFDMMUFRAMEGEN_STATE_S0a=0,     // write S0 symbol (first)
+        OFDMMUFRAMEGEN_STATE_S0b,       // write S0 symbol (second)
+        OFDMMUFRAMEGEN_STATE_S1,        // write S1 symbol
+        OFDMMUFRAMEGEN_STATE_DATA       // write header/payload symbols
+    } state;
+    int frame_assembled;                // any user assembled?
+};
+
+// reconfigure payload objects of user
+void ofdmmuframegen_reconfigure(ofdmmuframegen _q,
+                                unsigned int   _user);
+
+// write one data symbol of user into frequency-domain buffer
+void ofdmmuframegen_write_user(ofdmmuframegen _q,
+                               unsigned int   _user);
+
+// create OFDMA multi-user frame generator
+//  _M          :   number of subcarriers
+//  _cp_len     :   cyclic prefix length
+//  _taper_len  :   taper length (OFDM symbol overlap)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _num_users  :   number of users
+//  _user_map   :   user of each data subcarrier, [size: _M x 1]
+ofdmmuframegen ofdmmuframegen_create(unsigned int    _M,
+                                     unsigned int    _cp_len,
+                                     unsigned int    _taper_len,
+                                     unsigned char * _p,
+                                     unsigned int    _num_users,
+                                     unsigned char * _user_map)
+{
+    // validate input
+    if (_M < 2) {
+        fprintf(stderr,"error: ofdmmuframegen_create(), number of subcarriers must be at least 2\n");
+        exit(1);
+    } else if (_M % 2) {
+        fprintf(stderr,"error: ofdmmuframegen_create(), number of subcarriers must be even\n");
+        exit(1);
+    } else if (_num_users == 0) {
+        fprintf(stderr,"error: ofdmmuframegen_create(), number of users must be greater than zero\n");
+        exit(1);
+    } else if (_user_map == NULL) {
+        fprintf(stderr,"error: ofdmmuframegen_create(), user map must not be NULL\n");
+        exit(1);
+    }
+
+    ofdmmuframegen q = (ofdmmuframegen) liquid_malloc(sizeof(struct ofdmmuframegen_s));
+    q->M         = _M;
+    q->cp_len    = _cp_len;
+    q->taper_len = _taper_len;
+    q->num_users = _num_users;
+
+    // allocate memory for subcarrier allocation IDs
+    q->p = (unsigned char*) liquid_malloc((q->M)*sizeof(unsigned char));
+    if (_p == NULL) {
+        // initialize default subcarrier allocation
+        ofdmframe_init_default_sctype(q->M, q->p);
+    } else {
+        // copy user-defined subcarrier allocation
+        memmove(q->p, _p, q->M*sizeof(unsigned char));
+    }
+
+    // validate and count subcarrier allocation
+    ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
+    unsigned int i;
+    for (i=0; i<q->M; i++) {
+        if (q->p[i] == OFDMFRAME_SCTYPE_DATA && _user_map[i] >= q->num_users) {
+            fprintf(stderr,"error: ofdmmuframegen_create(), user map index exceeds number of users\n");
+            exit(1);
+        }
+    }
+
+    // transform buffer: pilot and null subcarriers are left cleared
+    // (ofdmframegen handles them)
+    q->X = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
+    memset(q->X, 0x00, q->M*sizeof(float complex));
+
+    // create internal OFDM frame generator object
+    q->fg = ofdmframegen_create(q->M, q->cp_len, q->taper_len, q->p);
+
+    // create header objects
+    q->mod_header = modem_create(OFDMFLEXFRAME_H_MOD);
+    q->p_header   = packetizer_create(OFDMFLEXFRAME_H_DEC,
+                                      OFDMFLEXFRAME_H_CRC,
+                                      OFDMFLEXFRAME_H_FEC,
+                                      LIQUID_FEC_NONE);
+    assert(packetizer_get_enc_msg_len(q->p_header)==OFDMFLEXFRAME_H_ENC);
+
+    // create users (properties may only be set between frames)
+    q->state = OFDMMUFRAMEGEN_STATE_S0a;
+    q->users = (struct ofdmmuframegen_user_s*) liquid_malloc(q->num_users*sizeof(struct ofdmmuframegen_user_s));
+    for (i=0; i<q->num_users; i++) {
+        struct ofdmmuframegen_user_s * u = &q->users[i];
+        u->M_data = ofdmframe_index_user(q->p, q->M, _user_map, i, NULL);
+        if (u->M_data == 0) {
+            fprintf(stderr,"error: ofdmmuframegen_create(), user %u has no data subcarriers\n", i);
+            exit(1);
+        }
+        u->data_idx = (unsigned int*) liquid_malloc(u->M_data*sizeof(unsigned int));
+        ofdmframe_index_user(q->p, q->M, _user_map, i, u->data_idx);
+
+        // compute number of header symbols
+        div_t d = div(OFDMFLEXFRAME_H_SYM, u->M_data);
+        u->num_symbols_header = d.quot + (d.rem ? 1 : 0);
+
+        // initial memory allocation for payload
+        u->payload_dec_len = 1;
+        u->p_payload = packetizer_create(u->payload_dec_len,
+                                         LIQUID_CRC_NONE,
+                                         LIQUID_FEC_NONE,
+                                         LIQUID_FEC_NONE);
+        u->payload_enc_len = packetizer_get_enc_msg_len(u->p_payload);
+        u->payload_enc = (unsigned char*) liquid_malloc(u->payload_enc_len*sizeof(unsigned char));
+        u->payload_mod_len = 1;
+        u->payload_mod = (unsigned char*) liquid_malloc(u->payload_mod_len*sizeof(unsigned char));
+        u->mod_payload = modem_create(LIQUID_MODEM_QPSK);
+
+        // initialize properties
+        ofdmmuframegen_setprops(q, i, NULL);
+    }
+
+    // reset
+    ofdmmuframegen_reset(q);
+
+    // return pointer to main object
+    return q;
+}
+
+void ofdmmuframegen_destroy(ofdmmuframegen _q)
+{
+    // destroy users
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++) {
+        struct ofdmmuframegen_user_s * u = &_q->users[i];
+        packetizer_destroy(u->p_payload);
+        modem_destroy(u->mod_payload);
+        liquid_free(u->payload_enc);
+        liquid_free(u->payload_mod);
+        liquid_free(u->data_idx);
+    }
+    liquid_free(_q->users);
+
+    // destroy internal objects
+    ofdmframegen_destroy(_q->fg);
+    packetizer_destroy(_q->p_header);
+    modem_destroy(_q->mod_header);
+
+    // free buffers/arrays
+    liquid_free(_q->X);
+    liquid_free(_q->p);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// reset generator, discarding assembled frames of all users
+void ofdmmuframegen_reset(ofdmmuframegen _q)
+{
+    _q->symbol_number   = 0;
+    _q->num_symbols     = 0;
+    _q->state           = OFDMMUFRAMEGEN_STATE_S0a;
+    _q->frame_assembled = 0;
+
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++) {
+        _q->users[i].assembled            = 0;
+        _q->users[i].header_symbol_index  = 0;
+        _q->users[i].payload_symbol_index = 0;
+    }
+
+    // reset internal OFDM frame generator object
+    // NOTE: this is important for appropriately setting the pilot phases
+    ofdmframegen_reset(_q->fg);
+}
+
+void ofdmmuframegen_print(ofdmmuframegen _q)
+{
+    printf("ofdmmuframegen:\n");
+    printf("    num subcarriers     :   %-u\n", _q->M);
+    printf("      * NULL            :   %-u\n", _q->M_null);
+    printf("      * pilot           :   %-u\n", _q->M_pilot);
+    printf("      * data            :   %-u\n", _q->M_data);
+    printf("    cyclic prefix len   :   %-u\n", _q->cp_len);
+    printf("    taper len           :   %-u\n", _q->taper_len);
+    printf("    num users           :   %-u\n", _q->num_users);
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++) {
+        struct ofdmmuframegen_user_s * u = &_q->users[i];
+        printf("    user %-3u           :   %u subcarriers, %s, %s\n", i, u->M_data,
+                modulation_types[u->props.mod_scheme].name,
+                u->assembled ? "assembled" : "idle");
+    }
+    if (_q->frame_assembled)
+        printf("    total OFDM symbols  :   %-u\n", ofdmmuframegen_getframelen(_q));
+}
+
+// get number of users
+unsigned int ofdmmuframegen_get_num_users(ofdmmuframegen _q)
+{
+    return _q->num_users;
+}
+
+// get payload properties of user
+void ofdmmuframegen_getprops(ofdmmuframegen            _q,
+                             unsigned int              _user,
+                             ofdmflexframegenprops_s * _props)
+{
+    if (_user >= _q->num_users) {
+        fprintf(stderr,"error: ofdmmuframegen_getprops(), user index (%u) out of range\n", _user);
+        exit(1);
+    }
+    memmove(_props, &_q->users[_user].props, sizeof(ofdmflexframegenprops_s));
+}
+
+// set payload properties of user (default properties if NULL)
+void ofdmmuframegen_setprops(ofdmmuframegen            _q,
+                             unsigned int              _user,
+                             ofdmflexframegenprops_s * _props)
+{
+    if (_user >= _q->num_users) {
+        fprintf(stderr,"error: ofdmmuframegen_setprops(), user index (%u) out of range\n", _user);
+        exit(1);
+    } else if (_q->state != OFDMMUFRAMEGEN_STATE_S0a) {
+        fprintf(stderr,"warning: ofdmmuframegen_setprops(), frame in progress; must reset() first\n");
+        return;
+    }
+
+    ofdmflexframegenprops_s props;
+    if (_props == NULL)
+        ofdmflexframegenprops_init_default(&props);
+    else
+        memmove(&props, _props, sizeof(ofdmflexframegenprops_s));
+
+    // validate input
+    if (props.check == LIQUID_CRC_UNKNOWN || props.check >= LIQUID_CRC_NUM_SCHEMES) {
+        fprintf(stderr, "error: ofdmmuframegen_setprops(), invalid/unsupported CRC scheme\n");
+        exit(1);
+    } else if (props.fec0 == LIQUID_FEC_UNKNOWN || props.fec1 == LIQUID_FEC_UNKNOWN) {
+        fprintf(stderr, "error: ofdmmuframegen_setprops(), invalid/unsupported FEC scheme\n");
+        exit(1);
+    } else if (props.mod_scheme == LIQUID_MODEM_UNKNOWN ) {
+        fprintf(stderr, "error: ofdmmuframegen_setprops(), invalid/unsupported modulation scheme\n");
+        exit(1);
+    }
+
+    // copy properties and reconfigure payload objects
+    memmove(&_q->users[_user].props, &props, sizeof(ofdmflexframegenprops_s));
+    ofdmmuframegen_reconfigure(_q, _user);
+}
+
+// get length of frame (OFDM symbols, including PLCP)
+unsigned int ofdmmuframegen_getframelen(ofdmmuframegen _q)
+{
+    return 3 + _q->num_symbols;
+}
+
+// assemble frame of one user; all users must be assembled before the
+// first symbol of the frame is written
+//  _q              :   OFDMA frame generator object
+//  _user           :   user index
+//  _header         :   frame header [8 bytes]
+//  _payload        :   payload data [size: _payload_len x 1]
+//  _payload_len    :   payload data length
+void ofdmmuframegen_assemble(ofdmmuframegen        _q,
+                             unsigned int          _user,
+                             const unsigned char * _header,
+                             const unsigned char * _payload,
+                             unsigned int          _payload_len)
+{
+    if (_user >= _q->num_users) {
+        fprintf(stderr,"error: ofdmmuframegen_assemble(), user index (%u) out of range\n", _user);
+        exit(1);
+    } else if (_q->state != OFDMMUFRAMEGEN_STATE_S0a) {
+        fprintf(stderr,"warning: ofdmmuframegen_assemble(), frame in progress; must reset() first\n");
+        return;
+    }
+    struct ofdmmuframegen_user_s * u = &_q->users[_user];
+
+    // check payload length and reconfigure if necessary
+    if (_payload_len != u->payload_dec_len) {
+        u->payload_dec_len = _payload_len;
+        ofdmmuframegen_reconfigure(_q, _user);
+    }
+
+    // copy user-defined header data and add protocol and payload
+    // description (see ofdmflexframegen_pack_header)
+    unsigned int n = OFDMFLEXFRAME_H_USER;
+    memmove(u->header, _header, n*sizeof(unsigned char));
+    u->header[n+0]  = OFDMFLEXFRAME_PROTOCOL;
+    u->header[n+1]  = (u->payload_dec_len >> 8) & 0xff;
+    u->header[n+2]  = (u->payload_dec_len     ) & 0xff;
+    u->header[n+3]  = u->props.mod_scheme;
+    u->header[n+4]  = (u->props.check & 0x07) << 5;
+    u->header[n+4] |= (u->props.fec0) & 0x1f;
+    u->header[n+5]  = (u->props.fec1) & 0x1f;
+
+    // encode, scramble and repack header
+    unsigned int num_written;
+    packetizer_encode(_q->p_header, u->header, u->header_enc);
+    scramble_data(u->header_enc, OFDMFLEXFRAME_H_ENC);
+    liquid_repack_bytes(u->header_enc, 8,                   OFDMFLEXFRAME_H_ENC,
+                        u->header_mod, OFDMFLEXFRAME_H_BPS, OFDMFLEXFRAME_H_SYM,
+                        &num_written);
+
+    // encode payload and repack into modem symbols
+    packetizer_encode(u->p_payload, _payload, u->payload_enc);
+    memset(u->payload_mod, 0x00, u->payload_mod_len);
+    unsigned int bps = modulation_types[u->props.mod_scheme].bps;
+    liquid_repack_bytes(u->payload_enc, 8,   u->payload_enc_len,
+                        u->payload_mod, bps, u->payload_mod_len,
+                        &num_written);
+
+    u->assembled            = 1;
+    u->header_symbol_index  = 0;
+    u->payload_symbol_index = 0;
+    _q->frame_assembled     = 1;
+
+    // frame spans the longest user
+    unsigned int num_symbols = u->num_symbols_header + u->num_symbols_payload;
+    if (num_symbols > _q->num_symbols)
+        _q->num_symbols = num_symbols;
+}
+
+// write symbol of assembled frame, returning '1' when the final symbol
+// of the frame has been written (and the generator has been reset)
+//  _q              :   OFDMA frame generator object
+//  _buffer         :   output buffer [size: M+cp_len x 1]
+int ofdmmuframegen_writesymbol(ofdmmuframegen         _q,
+                               liquid_float_complex * _buffer)
+{
+    // check if frame is actually assembled
+    if ( !_q->frame_assembled ) {
+        fprintf(stderr,"warning: ofdmmuframegen_writesymbol(), frame not assembled\n");
+        return 1;
+    }
+
+    switch (_q->state) {
+    case OFDMMUFRAMEGEN_STATE_S0a:
+        ofdmframegen_write_S0a(_q->fg, _buffer);
+        _q->state = OFDMMUFRAMEGEN_STATE_S0b;
+        return 0;
+    case OFDMMUFRAMEGEN_STATE_S0b:
+        ofdmframegen_write_S0b(_q->fg, _buffer);
+        _q->state = OFDMMUFRAMEGEN_STATE_S1;
+        return 0;
+    case OFDMMUFRAMEGEN_STATE_S1:
+        ofdmframegen_write_S1(_q->fg, _buffer);
+        _q->state = OFDMMUFRAMEGEN_STATE_DATA;
+        return 0;
+    case OFDMMUFRAMEGEN_STATE_DATA:
+        break;
+    default:
+        fprintf(stderr,"error: ofdmmuframegen_writesymbol(), unknown/unsupported internal state\n");
+        exit(1);
+    }
+
+    // fill subcarriers of each user and write symbol
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++)
+        ofdmmuframegen_write_user(_q, i);
+    ofdmframegen_writesymbol(_q->fg, _q->X, _buffer);
+
+    _q->symbol_number++;
+    if (_q->symbol_number < _q->num_symbols)
+        return 0;
+
+    // frame complete
+#if DEBUG_OFDMMUFRAMEGEN
+    printf(" ...resetting...\n");
+#endif
+    ofdmmuframegen_reset(_q);
+    return 1;
+}
+
+//
+// internal
+//
+
+// reconfigure payload objects of user
+void ofdmmuframegen_reconfigure(ofdmmuframegen _q,
+                                unsigned int   _user)
+{
+    struct ofdmmuframegen_user_s * u = &_q->users[_user];
+
+    // re-create payload packetizer and re-allocate encoded message
+    u->p_payload = packetizer_recreate(u->p_payload,
+                                       u->payload_dec_len,
+                                       u->props.check,
+                                       u->props.fec0,
+                                       u->props.fec1);
+    u->payload_enc_len = packetizer_get_enc_msg_len(u->p_payload);
+    u->payload_enc = (unsigned char*) liquid_realloc(u->payload_enc,
+                                              u->payload_enc_len*sizeof(unsigned char));
+
+    // re-create modem and re-allocate payload modem symbols
+    u->mod_payload = modem_recreate(u->mod_payload, u->props.mod_scheme);
+    unsigned int bps = modulation_types[u->props.mod_scheme].bps;
+    div_t d = div(8*u->payload_enc_len, bps);
+    u->payload_mod_len = d.quot + (d.rem ? 1 : 0);
+    u->payload_mod = (unsigned char*)liquid_realloc(u->payload_mod,
+                                             u->payload_mod_len*sizeof(unsigned char));
+
+    // re-compute number of payload OFDM symbols
+    d = div(u->payload_mod_len, u->M_data);
+    u->num_symbols_payload = d.quot + (d.rem ? 1 : 0);
+}
+
+// write one data symbol of user into frequency-domain buffer: header
+// symbols, then payload symbols, with the final symbol of each padded
+// with random symbols; idle users are filled with random header symbols
+void ofdmmuframegen_write_user(ofdmmuframegen _q,
+                               unsigned int   _user)
+{
+    struct ofdmmuframegen_user_s * u = &_q->users[_user];
+    unsigned int i = 0;
+    unsigned int n;
+
+    if (!u->assembled || _q->symbol_number >= u->num_symbols_header + u->num_symbols_payload) {
+        // idle
+    } else if (_q->symbol_number < u->num_symbols_header) {
+        // header symbols
+        n = OFDMFLEXFRAME_H_SYM - u->header_symbol_index;
+        if (n > u->M_data)
+            n = u->M_data;
+        for (i=0; i<n; i++)
+            modem_modulate(_q->mod_header, u->header_mod[u->header_symbol_index++], &_q->X[u->data_idx[i]]);
+    } else {
+        // payload symbols
+        n = u->payload_mod_len - u->payload_symbol_index;
+        if (n > u->M_data)
+            n = u->M_data;
+        for (i=0; i<n; i++)
+            modem_modulate(u->mod_payload, u->payload_mod[u->payload_symbol_index++], &_q->X[u->data_idx[i]]);
+        for ( ; i<u->M_data; i++)
+            modem_modulate(u->mod_payload, modem_gen_rand_sym(u->mod_payload), &_q->X[u->data_idx[i]]);
+    }
+
+    // pad with random header symbols
+    for ( ; i<u->M_data; i++)
+        modem_modulate(_q->mod_header, modem_gen_rand_sym(_q->mod_header), &_q->X[u->data_idx[i]]);
+}
@@ -0,0 +1,562 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ofdmmuframesync.c
+//
+// OFDMA multi-user frame synchronizer: a single ofdmframesync object
+// (one PLCP search, one transform per OFDM symbol) feeds the header
+// and payload decoders of all users, each of which extracts only its
+// own data subcarriers; the per-user cost is demodulation and
+// decoding. See ofdmmuframegen.c for the frame structure.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+#define DEBUG_OFDMMUFRAMESYNC 0
+
+// per-user state
+struct ofdmmuframesync_user_s {
+    unsigned int M_data;                // number of data subcarriers
+    unsigned int * data_idx;            // data subcarrier indices [M_data]
+
+    // header
+    unsigned char header[OFDMFLEXFRAME_H_DEC];      // header data (uncoded)
+    unsigned char header_enc[OFDMFLEXFRAME_H_ENC];  // header data (encoded)
+    unsigned char header_mod[OFDMFLEXFRAME_H_SYM];  // header symbols
+    int header_valid;                   // valid header flag
+
+    // header properties
+    modulation_scheme ms_payload;       // payload modulation scheme
+    unsigned int bps_payload;           // payload modulation depth (bits/symbol)
+    unsigned int payload_len;           // payload length (number of bytes)
+    crc_scheme check;                   // payload validity check
+    fec_scheme fec0;                    // payload FEC (inner)
+    fec_scheme fec1;                    // payload FEC (outer)
+
+    // payload
+    packetizer p_payload;               // payload packetizer
+    modem mod_payload;                  // payload demodulator
+    unsigned char * payload_enc;        // payload data (encoded bytes)
+    unsigned char * payload_dec;        // payload data (decoded bytes)
+    unsigned int payload_enc_len;       // length of encoded payload
+    unsigned int payload_mod_len;       // number of payload modem symbols
+    int payload_valid;                  // valid payload flag
+    float complex * payload_syms;       // received payload symbols
+    unsigned int * payload_rxsym;       // demodulated symbols [M_data]
+
+    // callback
+    framesync_callback callback;        // user-defined callback function
+    void * userdata;                    // user-defined data structure
+    framesyncstats_s framestats;        // frame statistic object
+    float evm_hat;                      // average error vector magnitude
+
+    // counters/states
+    enum {
+        OFDMMUFRAMESYNC_STATE_HEADER=0, // extract header
+        OFDMMUFRAMESYNC_STATE_PAYLOAD,  // extract payload symbols
+        OFDMMUFRAMESYNC_STATE_DONE      // frame delivered
+    } state;
+    unsigned int header_symbol_index;   // number of header symbols received
+    unsigned int payload_symbol_index;  // number of payload symbols received
+    unsigned int payload_buffer_index;  // bit-level index of payload (pack array)
+};
+
+struct ofdmmuframesync_s {
+    unsigned int M;         // number of subcarriers
+    unsigned int cp_len;    // cyclic prefix length
+    unsigned int taper_len; // taper length
+    unsigned char * p;      // subcarrier allocation (null, pilot, data)
+
+    // constants
+    unsigned int M_null;    // number of null subcarriers
+    unsigned int M_pilot;   // number of pilot subcarriers
+    unsigned int M_data;    // number of data subcarriers
+
+    // users
+    unsigned int num_users;                 // number of users
+    struct ofdmmuframesync_user_s * users;  // user state [num_users]
+    unsigned int num_active;                // users yet to deliver frame
+
+    // internal objects
+    ofdmframesync fs;       // internal OFDM frame synchronizer (shared)
+    modem mod_header;       // header demodulator (shared)
+    packetizer p_header;    // header packetizer (shared)
+};
+
+// internal callback
+int ofdmmuframesync_internal_callback(float complex * _X,
+                                      unsigned char * _p,
+                                      unsigned int    _M,
+                                      void *          _userdata);
+
+// receive header data of user
+void ofdmmuframesync_rxheader(ofdmmuframesync _q,
+                              unsigned int    _user,
+                              float complex * _X);
+
+// decode header of user
+void ofdmmuframesync_decode_header(ofdmmuframesync _q,
+                                   unsigned int    _user);
+
+// receive payload data of user
+void ofdmmuframesync_rxpayload(ofdmmuframesync _q,
+                               unsigned int    _user,
+                               float complex * _X);
+
+// deliver frame of user to its callback and mark user as done
+void ofdmmuframesync_deliver(ofdmmuframesync _q,
+                             unsigned int    _user);
+
+// create OFDMA multi-user frame synchronizer
+//  _M          :   number of subcarriers
+//  _cp_len     :   cyclic prefix length
+//  _taper_len  :   taper length (OFDM symbol overlap)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _num_users  :   number of users
+//  _user_map   :   user of each data subcarrier, [size: _M x 1]
+//  _callbacks  :   user-defined callback of each user, [size: _num_users x 1]
+//  _userdata   :   user-defined data of each user, [size: _num_users x 1], or NULL
+ofdmmuframesync ofdmmuframesync_create(unsigned int         _M,
+                                       unsigned int         _cp_len,
+                                       unsigned int         _taper_len,
+                                       unsigned char *      _p,
+                                       unsigned int         _num_users,
+                                       unsigned char *      _user_map,
+                                       framesync_callback * _callbacks,
+                                       void **              _userdata)
+{
+    // validate input
+    if (_M < 8) {
+        fprintf(stderr,"warning: ofdmmuframesync_create(), less than 8 subcarriers\n");
+    } else if (_M % 2) {
+        fprintf(stderr,"error: ofdmmuframesync_create(), number of subcarriers must be even\n");
+        exit(1);
+    } else if (_cp_len > _M) {
+        fprintf(stderr,"error: ofdmmuframesync_create(), cyclic prefix length cannot exceed number of subcarriers\n");
+        exit(1);
+    }
+    if (_num_users == 0) {
+        fprintf(stderr,"error: ofdmmuframesync_create(), number of users must be greater than zero\n");
+        exit(1);
+    } else if (_user_map == NULL || _callbacks == NULL) {
+        fprintf(stderr,"error: ofdmmuframesync_create(), user map and callbacks must not be NULL\n");
+        exit(1);
+    }
+
+    ofdmmuframesync q = (ofdmmuframesync) liquid_malloc(sizeof(struct ofdmmuframesync_s));
+    q->M         = _M;
+    q->cp_len    = _cp_len;
+    q->taper_len = _taper_len;
+    q->num_users = _num_users;
+
+    // allocate memory for subcarrier allocation IDs
+    q->p = (unsigned char*) liquid_malloc((q->M)*sizeof(unsigned char));
+    if (_p == NULL) {
+        // initialize default subcarrier allocation
+        ofdmframe_init_default_sctype(q->M, q->p);
+    } else {
+        // copy user-defined subcarrier allocation
+        memmove(q->p, _p, q->M*sizeof(unsigned char));
+    }
+
+    // validate and count subcarrier allocation
+    ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
+    unsigned int i;
+    for (i=0; i<q->M; i++) {
+        if (q->p[i] == OFDMFRAME_SCTYPE_DATA && _user_map[i] >= q->num_users) {
+            fprintf(stderr,"error: ofdmmuframesync_create(), user map index exceeds number of users\n");
+            exit(1);
+        }
+    }
+
+    // create internal framing object
+    q->fs = ofdmframesync_create(q->M, q->cp_len, q->taper_len, q->p,
+                                 ofdmmuframesync_internal_callback, (void*)q);
+
+    // create header objects
+    q->mod_header = modem_create(OFDMFLEXFRAME_H_MOD);
+    q->p_header   = packetizer_create(OFDMFLEXFRAME_H_DEC,
+                                      OFDMFLEXFRAME_H_CRC,
+                                      OFDMFLEXFRAME_H_FEC,
+                                      LIQUID_FEC_NONE);
+    assert(packetizer_get_enc_msg_len(q->p_header)==OFDMFLEXFRAME_H_ENC);
+
+    // create users
+    q->users = (struct ofdmmuframesync_user_s*) liquid_malloc(q->num_users*sizeof(struct ofdmmuframesync_user_s));
+    for (i=0; i<q->num_users; i++) {
+        struct ofdmmuframesync_user_s * u = &q->users[i];
+        u->M_data = ofdmframe_index_user(q->p, q->M, _user_map, i, NULL);
+        if (u->M_data == 0) {
+            fprintf(stderr,"error: ofdmmuframesync_create(), user %u has no data subcarriers\n", i);
+            exit(1);
+        }
+        u->data_idx = (unsigned int*) liquid_malloc(u->M_data*sizeof(unsigned int));
+        ofdmframe_index_user(q->p, q->M, _user_map, i, u->data_idx);
+
+        u->callback = _callbacks[i];
+        u->userdata = _userdata == NULL ? NULL : _userdata[i];
+
+        // frame properties (default values to be overwritten when frame
+        // header is received and properly decoded)
+        u->ms_payload  = LIQUID_MODEM_QPSK;
+        u->bps_payload = 2;
+        u->payload_len = 1;
+        u->check       = LIQUID_CRC_NONE;
+        u->fec0        = LIQUID_FEC_NONE;
+        u->fec1        = LIQUID_FEC_NONE;
+
+        // create payload objects
+        u->mod_payload = modem_create(u->ms_payload);
+        u->p_payload   = packetizer_create(u->payload_len, u->check, u->fec0, u->fec1);
+        u->payload_enc_len = packetizer_get_enc_msg_len(u->p_payload);
+        u->payload_enc = (unsigned char*) liquid_malloc(u->payload_enc_len*sizeof(unsigned char));
+        u->payload_dec = (unsigned char*) liquid_malloc(u->payload_len*sizeof(unsigned char));
+        u->payload_mod_len = 0;
+        u->payload_syms  = (float complex*) liquid_malloc(u->payload_len*sizeof(float complex));
+        u->payload_rxsym = (unsigned int*)  liquid_malloc(u->M_data*sizeof(unsigned int));
+    }
+
+    // reset state
+    ofdmmuframesync_reset(q);
+
+    // return object
+    return q;
+}
+
+void ofdmmuframesync_destroy(ofdmmuframesync _q)
+{
+    // destroy users
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++) {
+        struct ofdmmuframesync_user_s * u = &_q->users[i];
+        packetizer_destroy(u->p_payload);
+        modem_destroy(u->mod_payload);
+        liquid_free(u->payload_enc);
+        liquid_free(u->payload_dec);
+        liquid_free(u->payload_syms);
+        liquid_free(u->payload_rxsym);
+        liquid_free(u->data_idx);
+    }
+    liquid_free(_q->users);
+
+    // destroy internal objects
+    ofdmframesync_destroy(_q->fs);
+    packetizer_destroy(_q->p_header);
+    modem_destroy(_q->mod_header);
+
+    // free internal buffers/arrays
+    liquid_free(_q->p);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+void ofdmmuframesync_print(ofdmmuframesync _q)
+{
+    printf("ofdmmuframesync:\n");
+    printf("    num subcarriers     :   %-u\n", _q->M);
+    printf("      * NULL            :   %-u\n", _q->M_null);
+    printf("      * pilot           :   %-u\n", _q->M_pilot);
+    printf("      * data            :   %-u\n", _q->M_data);
+    printf("    cyclic prefix len   :   %-u\n", _q->cp_len);
+    printf("    taper len           :   %-u\n", _q->taper_len);
+    printf("    num users           :   %-u\n", _q->num_users);
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++)
+        printf("    user %-3u           :   %u subcarriers\n", i, _q->users[i].M_data);
+}
+
+void ofdmmuframesync_reset(ofdmmuframesync _q)
+{
+    // reset all users
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++) {
+        struct ofdmmuframesync_user_s * u = &_q->users[i];
+        u->state                = OFDMMUFRAMESYNC_STATE_HEADER;
+        u->header_symbol_index  = 0;
+        u->payload_symbol_index = 0;
+        u->payload_buffer_index = 0;
+        u->evm_hat              = 1e-12f;   // slight offset to ensure no log(0)
+        framesyncstats_init_default(&u->framestats);
+    }
+    _q->num_active = _q->num_users;
+
+    // reset internal OFDM frame synchronizer object
+    ofdmframesync_reset(_q->fs);
+}
+
+// execute synchronizer object on buffer of samples
+void ofdmmuframesync_execute(ofdmmuframesync        _q,
+                             liquid_float_complex * _x,
+                             unsigned int           _n)
+{
+    // push samples through shared ofdmframesync object
+    ofdmframesync_execute(_q->fs, _x, _n);
+}
+
+// get number of users
+unsigned int ofdmmuframesync_get_num_users(ofdmmuframesync _q)
+{
+    return _q->num_users;
+}
+
+// received signal strength indication
+float ofdmmuframesync_get_rssi(ofdmmuframesync _q)
+{
+    return ofdmframesync_get_rssi(_q->fs);
+}
+
+// received carrier frequency offset
+float ofdmmuframesync_get_cfo(ofdmmuframesync _q)
+{
+    return ofdmframesync_get_cfo(_q->fs);
+}
+
+//
+// internal methods
+//
+
+// internal callback: demultiplex subcarriers of received OFDM symbol
+// to the decoders of all users still receiving
+//  _X          :   subcarrier symbols
+//  _p          :   subcarrier allocation
+//  _M          :   number of subcarriers
+//  _userdata   :   user-defined data structure
+int ofdmmuframesync_internal_callback(float complex * _X,
+                                      unsigned char * _p,
+                                      unsigned int    _M,
+                                      void *          _userdata)
+{
+    ofdmmuframesync _q = (ofdmmuframesync) _userdata;
+
+    unsigned int i;
+    for (i=0; i<_q->num_users; i++) {
+        switch (_q->users[i].state) {
+        case OFDMMUFRAMESYNC_STATE_HEADER:  ofdmmuframesync_rxheader (_q, i, _X); break;
+        case OFDMMUFRAMESYNC_STATE_PAYLOAD: ofdmmuframesync_rxpayload(_q, i, _X); break;
+        default:;
+        }
+    }
+
+    // frame is complete once every user has been delivered
+    if (_q->num_active == 0)
+        ofdmmuframesync_reset(_q);
+    return 0;
+}
+
+// receive header data of user
+void ofdmmuframesync_rxheader(ofdmmuframesync _q,
+                              unsigned int    _user,
+                              float complex * _X)
+{
+    struct ofdmmuframesync_user_s * u = &_q->users[_user];
+
+    // demodulate header symbols on data subcarriers of user
+    unsigned int i;
+    unsigned int n = OFDMFLEXFRAME_H_SYM - u->header_symbol_index;
+    if (n > u->M_data)
+        n = u->M_data;
+    for (i=0; i<n; i++) {
+        unsigned int sym;
+        modem_demodulate(_q->mod_header, _X[u->data_idx[i]], &sym);
+        u->header_mod[u->header_symbol_index++] = sym;
+
+        // get demodulator error vector magnitude
+        float evm = modem_get_demodulator_evm(_q->mod_header);
+        u->evm_hat += evm*evm;
+    }
+    if (u->header_symbol_index < OFDMFLEXFRAME_H_SYM)
+        return;
+
+    // header extracted
+    ofdmmuframesync_decode_header(_q, _user);
+    u->framestats.evm = 10*log10f( u->evm_hat/OFDMFLEXFRAME_H_SYM );
+#if DEBUG_OFDMMUFRAMESYNC
+    printf("****** user %u header extracted [%s]\n", _user, u->header_valid ? "valid" : "INVALID!");
+#endif
+
+    if (u->header_valid)
+        u->state = OFDMMUFRAMESYNC_STATE_PAYLOAD;
+    else
+        ofdmmuframesync_deliver(_q, _user);
+}
+
+// decode header of user (see ofdmflexframesync_decode_header)
+void ofdmmuframesync_decode_header(ofdmmuframesync _q,
+                                   unsigned int    _user)
+{
+    struct ofdmmuframesync_user_s * u = &_q->users[_user];
+
+    // pack 1-bit header symbols into 8-bit bytes and unscramble
+    unsigned int num_written;
+    liquid_repack_bytes(u->header_mod, OFDMFLEXFRAME_H_BPS, OFDMFLEXFRAME_H_SYM,
+                        u->header_enc, 8,                   OFDMFLEXFRAME_H_ENC,
+                        &num_written);
+    assert(num_written==OFDMFLEXFRAME_H_ENC);
+    unscramble_data(u->header_enc, OFDMFLEXFRAME_H_ENC);
+
+    // reject noise from the syndromes of the header code before
+    // running the decoder
+    if (!packetizer_precheck(_q->p_header, u->header_enc, OFDMFLEXFRAME_H_PRECHECK)) {
+        u->header_valid = 0;
+        return;
+    }
+    u->header_valid = packetizer_decode(_q->p_header, u->header_enc, u->header);
+    if (!u->header_valid)
+        return;
+
+    unsigned int n = OFDMFLEXFRAME_H_USER;
+
+    // strip off protocol, payload length, modulation scheme, CRC and
+    // forward error-correction schemes
+    unsigned int payload_len = (u->header[n+1] << 8) | (u->header[n+2]);
+    unsigned int mod_scheme  =  u->header[n+3];
+    unsigned int check       = (u->header[n+4] >> 5 ) & 0x07;
+    unsigned int fec0        = (u->header[n+4]      ) & 0x1f;
+    unsigned int fec1        = (u->header[n+5]      ) & 0x1f;
+
+    // validate properties
+    if (u->header[n+0] != OFDMFLEXFRAME_PROTOCOL) {
+        fprintf(stderr,"warning: ofdmmuframesync_decode_header(), invalid framing version\n");
+        u->header_valid = 0;
+    } else if (mod_scheme == 0 || mod_scheme >= LIQUID_MODEM_NUM_SCHEMES) {
+        fprintf(stderr,"warning: ofdmmuframesync_decode_header(), invalid modulation scheme\n");
+        u->header_valid = 0;
+    } else if (check >= LIQUID_CRC_NUM_SCHEMES) {
+        fprintf(stderr,"warning: ofdmmuframesync_decode_header(), decoded CRC exceeds available\n");
+        u->header_valid = 0;
+    } else if (fec0 >= LIQUID_FEC_NUM_SCHEMES || fec1 >= LIQUID_FEC_NUM_SCHEMES) {
+        fprintf(stderr,"warning: ofdmmuframesync_decode_header(), decoded FEC exceeds available\n");
+        u->header_valid = 0;
+    }
+    if (!u->header_valid)
+        return;
+
+    // configure modem
+    if (mod_scheme != u->ms_payload) {
+        u->ms_payload  = mod_scheme;
+        u->bps_payload = modulation_types[mod_scheme].bps;
+        u->mod_payload = modem_recreate(u->mod_payload, u->ms_payload);
+    }
+
+    // recreate packetizer object and re-allocate buffers accordingly
+    u->payload_len = payload_len;
+    u->check       = check;
+    u->fec0        = fec0;
+    u->fec1        = fec1;
+    u->p_payload = packetizer_recreate(u->p_payload, u->payload_len, u->check, u->fec0, u->fec1);
+    u->payload_enc_len = packetizer_get_enc_msg_len(u->p_payload);
+    u->payload_enc = (unsigned char*) liquid_realloc(u->payload_enc, u->payload_enc_len*sizeof(unsigned char));
+    u->payload_dec = (unsigned char*) liquid_realloc(u->payload_dec, u->payload_len*sizeof(unsigned char));
+
+    // re-compute number of modulated payload symbols
+    div_t d = div(8*u->payload_enc_len, u->bps_payload);
+    u->payload_mod_len = d.quot + (d.rem ? 1 : 0);
+    u->payload_syms = (float complex*) liquid_realloc(u->payload_syms, u->payload_mod_len*sizeof(float complex));
+}
+
+// receive payload data of user
+void ofdmmuframesync_rxpayload(ofdmmuframesync _q,
+                               unsigned int    _user,
+                               float complex * _X)
+{
+    struct ofdmmuframesync_user_s * u = &_q->users[_user];
+
+    // gather data subcarriers of user; the final symbol may be only
+    // partially occupied
+    unsigned int i;
+    unsigned int i0 = u->payload_symbol_index;
+    unsigned int n  = u->payload_mod_len - i0;
+    if (n > u->M_data)
+        n = u->M_data;
+    for (i=0; i<n; i++)
+        u->payload_syms[i0+i] = _X[u->data_idx[i]];
+    u->payload_symbol_index += n;
+
+    // demodulate as a block and pack decoded symbols into array
+    modem_demodulate_block(u->mod_payload, &u->payload_syms[i0], n, u->payload_rxsym);
+    liquid_pack_array_block(u->payload_enc,
+                            u->payload_enc_len,
+                            u->payload_buffer_index,
+                            u->bps_payload,
+                            u->payload_rxsym,
+                            n);
+    u->payload_buffer_index += n*u->bps_payload;
+    if (u->payload_symbol_index < u->payload_mod_len)
+        return;
+
+    // payload extracted
+    u->payload_valid = packetizer_decode(u->p_payload, u->payload_enc, u->payload_dec);
+#if DEBUG_OFDMMUFRAMESYNC
+    printf("****** user %u payload extracted [%s]\n", _user, u->payload_valid ? "valid" : "INVALID!");
+#endif
+    ofdmmuframesync_deliver(_q, _user);
+}
+
+// deliver frame of user to its callback and mark user as done
+void ofdmmuframesync_deliver(ofdmmuframesync _q,
+                             unsigned int    _user)
+{
+    struct ofdmmuframesync_user_s * u = &_q->users[_user];
+
+    // set framestats internals
+    u->framestats.rssi = ofdmframesync_get_rssi(_q->fs);
+    u->framestats.cfo  = ofdmframesync_get_cfo(_q->fs);
+    if (u->header_valid) {
+        u->framestats.framesyms     = u->payload_syms;
+        u->framestats.num_framesyms = u->payload_mod_len;
+        u->framestats.mod_scheme    = u->ms_payload;
+        u->framestats.mod_bps       = u->bps_payload;
+        u->framestats.check         = u->check;
+        u->framestats.fec0          = u->fec0;
+        u->framestats.fec1          = u->fec1;
+    } else {
+        u->framestats.framesyms     = NULL;
+        u->framestats.num_framesyms = 0;
+        u->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
+        u->framestats.mod_bps       = 0;
+        u->framestats.check         = LIQUID_CRC_UNKNOWN;
+        u->framestats.fec0          = LIQUID_FEC_UNKNOWN;
+        u->framestats.fec1          = LIQUID_FEC_UNKNOWN;
+    }
+
+    // invoke callback method; ignore if set to NULL
+    if (u->callback != NULL) {
+        u->callback(u->header,
+                    u->header_valid,
+                    u->header_valid ? u->payload_dec : NULL,
+                    u->header_valid ? u->payload_len : 0,
+                    u->header_valid ? u->payload_valid : 0,
+                    u->framestats,
+                    u->userdata);
+    }
+
+    u->state = OFDMMUFRAMESYNC_STATE_DONE;
+    _q->num_active--;
+}
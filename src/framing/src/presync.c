@@ -45,6 +45,10 @@ struct PRESYNC(_s) {
     float * rxy;        // output correlation [size: m x 1]
 
     float n_inv;        // 1/n (pre-computed for speed)
+
+    // sign-bit correlator used to find the peak hypothesis; the
+    // floating-point correlation is only evaluated around it
+    BPRESYNC() coarse;
 };
 
 /* create binary pre-demod synchronizer                     */
@@ -67,7 +71,7 @@ PRESYNC() PRESYNC(_create)(TC *         _v,
     }
 
     // allocate main object memory and initialize
-    PRESYNC() _q = (PRESYNC()) malloc(sizeof(struct PRESYNC(_s)));
+    PRESYNC() _q = (PRESYNC()) liquid_malloc(sizeof(struct PRESYNC(_s)));
     _q->n = _n;
     _q->m = _m;
 
@@ -80,11 +84,11 @@ PRESYNC() PRESYNC(_create)(TC *         _v,
     _q->rx_q = WINDOW(_create)(_q->n);
 
     // create internal array of frequency offsets
-    _q->dphi = (float*) malloc( _q->m*sizeof(float) );
+    _q->dphi = (float*) liquid_malloc( _q->m*sizeof(float) );
 
     // create internal synchronizers
-    _q->sync_i = (DOTPROD()*) malloc( _q->m*sizeof(DOTPROD()) );
-    _q->sync_q = (DOTPROD()*) malloc( _q->m*sizeof(DOTPROD()) );
+    _q->sync_i = (DOTPROD()*) liquid_malloc( _q->m*sizeof(DOTPROD()) );
+    _q->sync_q = (DOTPROD()*) liquid_malloc( _q->m*sizeof(DOTPROD()) );
 
     // buffer
     T vi_prime[_n];
@@ -104,7 +108,10 @@ PRESYNC() PRESYNC(_create)(TC *         _v,
     }
 
     // allocate memory for cross-correlation
-    _q->rxy = (float*) malloc( _q->m*sizeof(float) );
+    _q->rxy = (float*) liquid_malloc( _q->m*sizeof(float) );
+
+    // create coarse (binary) synchronizer over the same hypotheses
+    _q->coarse = BPRESYNC(_create)(_v, _n, _dphi_max, _m);
 
     // reset object
     PRESYNC(_reset)(_q);
@@ -125,17 +132,20 @@ void PRESYNC(_destroy)(PRESYNC() _q)
         DOTPROD(_destroy)(_q->sync_i[i]);
         DOTPROD(_destroy)(_q->sync_q[i]);
     }
-    free(_q->sync_i);
-    free(_q->sync_q);
+    liquid_free(_q->sync_i);
+    liquid_free(_q->sync_q);
 
     // free internal frequency offset array
-    free(_q->dphi);
+    liquid_free(_q->dphi);
 
     // free internal cross-correlation array
-    free(_q->rxy);
+    liquid_free(_q->rxy);
+
+    // destroy coarse synchronizer
+    BPRESYNC(_destroy)(_q->coarse);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void PRESYNC(_print)(PRESYNC() _q)
@@ -147,6 +157,7 @@ void PRESYNC(_reset)(PRESYNC() _q)
 {
     WINDOW(_clear)(_q->rx_i);
     WINDOW(_clear)(_q->rx_q);
+    BPRESYNC(_reset)(_q->coarse);
 }
 
 // correlate input sequence with particular 
@@ -194,7 +205,8 @@ void PRESYNC(_push)(PRESYNC() _q,
 {
     // push symbol into buffers
     WINDOW(_push)(_q->rx_i, REAL(_x));
-    WINDOW(_push)(_q->rx_q, REAL(_x));
+    WINDOW(_push)(_q->rx_q, IMAG(_x));
+    BPRESYNC(_push)(_q->coarse, _x);
 }
 
 /* correlate input sequence                                 */
@@ -211,7 +223,13 @@ void PRESYNC(_correlate)(PRESYNC() _q,
     float complex rxy0;
     float complex rxy1;
     float dphi_hat = 0.0f;
-    for (i=0; i<_q->m; i++)  {
+
+    // locate peak on sign bits, then refine with the full-precision
+    // correlation on it and its immediate neighbors only
+    unsigned int i_peak = BPRESYNC(_search)(_q->coarse, NULL);
+    unsigned int i0 = i_peak > 0 ? i_peak-1 : 0;
+    unsigned int i1 = i_peak+1 < _q->m ? i_peak+1 : _q->m-1;
+    for (i=i0; i<=i1; i++)  {
 
         PRESYNC(_correlatex)(_q, i, &rxy0, &rxy1);
 
@@ -46,6 +46,7 @@
 #define WINDOW(name)        LIQUID_CONCAT(windowf,name)
 #define DOTPROD(name)       LIQUID_CONCAT(dotprod_rrrf,name)
 #define BSYNC(name)         LIQUID_CONCAT(bsync_cccf,name)
+#define BPRESYNC(name)      LIQUID_CONCAT(bpresync_cccf,name)
 
 #define TO_COMPLEX
 #define TC_COMPLEX
@@ -36,6 +36,10 @@
 #define DEBUG_QDETECTOR_PRINT        0
 #define DEBUG_QDETECTOR_FILENAME     "qdetector_cccf_debug.m"
 
+// energy gate noise floor: median of half-buffer block levels over
+// an effective memory of this many blocks
+#define QDETECTOR_GATE_MEMORY        (32)
+
 // seek signal (initial detection)
 void qdetector_cccf_execute_seek(qdetector_cccf _q,
                                  float complex  _x);
@@ -44,12 +48,40 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
 void qdetector_cccf_execute_align(qdetector_cccf _q,
                                   float complex  _x);
 
+// update energy gate with latest buffer levels, returning 1 if the
+// correlation sweep should be run
+int qdetector_cccf_gate_update(qdetector_cccf _q);
+
+// cross-correlate transformed buffer with template at carrier offset
+// (subcarriers), returning the peak |rxy|^2 (unscaled) and its index
+float qdetector_cccf_sweep_offset(qdetector_cccf _q,
+                                  int            _offset,
+                                  unsigned int * _index);
+
+// search correlator output for peak |rxy|^2 (unscaled) and its index
+float qdetector_cccf_peak(qdetector_cccf  _q,
+                          float complex * _rxy,
+                          unsigned int *  _index);
+
+// sweep carrier offset grid, half through the offload queue, returning
+// the peak |rxy|^2 (unscaled) and its index and offset
+float qdetector_cccf_sweep_offload(qdetector_cccf _q,
+                                   unsigned int * _index,
+                                   int *          _offset);
+
+// multiply complex arrays: z[i] = x[i] * y[i]
+void qdetector_cccf_cmul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z);
+
 // main object definition
 struct qdetector_cccf_s {
     unsigned int    s_len;          // template (time) length: k * (sequence_len + 2*m)
     float complex * s;              // template (time), [size: s_len x 1]
-    float complex * S;              // template (freq), [size: nfft x 1]
+    float complex * S;              // conjugated template (freq), [size: nfft x 1]
     float           s2_sum;         // sum{ s^2 }
+    unsigned int *  refs;           // number of detectors sharing s, S
 
     float complex * buf_time_0;     // time-domain buffer (FFT)
     float complex * buf_freq_0;     // frequence-domain buffer (FFT)
@@ -62,11 +94,25 @@ struct qdetector_cccf_s {
     unsigned int    counter;        // sample counter for determining when to compute FFTs
     float           threshold;      // detection threshold
     int             range;          // carrier offset search range (subcarriers)
+    unsigned int    range_step;     // coarse carrier offset search grid step
     unsigned int    num_transforms; // number of transforms taken (debugging)
 
     float           x2_sum_0;       // sum{ |x|^2 } of first half of buffer
     float           x2_sum_1;       // sum{ |x|^2 } of second half of buffer
 
+    // energy gate
+    int             gate_enabled;   // bypass correlation on low energy?
+    float           gate_threshold; // gate threshold above noise floor [dB]
+    noisefloor      gate_floor;     // noise floor estimate of block mean |x|^2
+    unsigned int    num_blocks;     // number of seek blocks processed
+    unsigned int    num_skipped;    // number of seek blocks bypassed by gate
+
+    // offload of coarse carrier offset sweep
+    liquid_offload  offload;        // offload queue (NULL: sweep in place)
+    float complex * buf_sweep;      // correlator outputs, [size: num_sweep*nfft x 1]
+    int *           sweep_offsets;  // grid offsets, [size: num_sweep x 1]
+    unsigned int    num_sweep;      // number of offloaded grid offsets
+
     int             offset;         // FFT offset index for peak correlation (coarse carrier estimate)
     float           tau_hat;        // timing offset estimate
     float           gamma_hat;      // signal level estimate (channel gain)
@@ -93,36 +139,50 @@ qdetector_cccf qdetector_cccf_create(float complex * _s,
     }
     
     // allocate memory for main object and set internal properties
-    qdetector_cccf q = (qdetector_cccf) malloc(sizeof(struct qdetector_cccf_s));
+    qdetector_cccf q = (qdetector_cccf) liquid_malloc(sizeof(struct qdetector_cccf_s));
     q->s_len = _s_len;
 
     // allocate memory and copy sequence
-    q->s = (float complex*) malloc(q->s_len * sizeof(float complex));
+    q->s = (float complex*) liquid_malloc(q->s_len * sizeof(float complex));
     memmove(q->s, _s, q->s_len*sizeof(float complex));
     q->s2_sum = liquid_sumsqcf(q->s, q->s_len); // compute sum{ s^2 }
 
     // prepare transforms
     q->nfft       = 1 << liquid_nextpow2( (unsigned int)( 2 * q->s_len ) ); // NOTE: must be even
-    q->buf_time_0 = (float complex*) malloc(q->nfft * sizeof(float complex));
-    q->buf_freq_0 = (float complex*) malloc(q->nfft * sizeof(float complex));
-    q->buf_freq_1 = (float complex*) malloc(q->nfft * sizeof(float complex));
-    q->buf_time_1 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->buf_time_0 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_0 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_1 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_time_1 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
 
     q->fft  = fft_create_plan(q->nfft, q->buf_time_0, q->buf_freq_0, LIQUID_FFT_FORWARD,  0);
     q->ifft = fft_create_plan(q->nfft, q->buf_freq_1, q->buf_time_1, LIQUID_FFT_BACKWARD, 0);
 
-    // create frequency-domain template by taking nfft-point transform on 's', storing in 'S'
-    q->S = (float complex*) malloc(q->nfft * sizeof(float complex));
+    // create frequency-domain template by taking nfft-point transform on 's', storing
+    // its conjugate in 'S' for cross-correlation
+    q->S = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
     memset(q->buf_time_0, 0x00, q->nfft*sizeof(float complex));
     memmove(q->buf_time_0, q->s, q->s_len*sizeof(float complex));
     fft_execute(q->fft);
-    memmove(q->S, q->buf_freq_0, q->nfft*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<q->nfft; i++)
+        q->S[i] = conjf(q->buf_freq_0[i]);
+    q->refs  = (unsigned int*) liquid_malloc(sizeof(unsigned int));
+    *q->refs = 1;
 
     // reset state variables
     q->counter        = q->nfft/2;
     q->num_transforms = 0;
     q->x2_sum_0       = 0.0f;
     q->x2_sum_1       = 0.0f;
+    q->gate_enabled   = 0;
+    q->gate_threshold = 2.0f;
+    q->gate_floor     = noisefloor_create(0.5f, QDETECTOR_GATE_MEMORY);
+    q->num_blocks     = 0;
+    q->num_skipped    = 0;
+    q->offload        = NULL;
+    q->buf_sweep      = NULL;
+    q->sweep_offsets  = NULL;
+    q->num_sweep      = 0;
     q->state          = QDETECTOR_STATE_SEEK;
     q->frame_detected = 0;
     memset(q->buf_time_0, 0x00, q->nfft*sizeof(float complex));
@@ -135,6 +195,7 @@ qdetector_cccf qdetector_cccf_create(float complex * _s,
 
     qdetector_cccf_set_threshold(q,0.5f);
     qdetector_cccf_set_range    (q,0.3f); // set initial range for higher detection
+    q->range_step = 1;                    // exhaustive carrier offset search
 
     // return object
     return q;
@@ -172,7 +233,7 @@ qdetector_cccf qdetector_cccf_create_linear(float complex * _sequence,
     
     // create time-domain template
     unsigned int    s_len = _k * (_sequence_len + 2*_m);
-    float complex * s     = (float complex*) malloc(s_len * sizeof(float complex));
+    float complex * s     = (float complex*) liquid_malloc(s_len * sizeof(float complex));
     firinterp_crcf interp = firinterp_crcf_create_prototype(_ftype, _k, _m, _beta, 0);
     unsigned int i;
     for (i=0; i<_sequence_len + 2*_m; i++)
@@ -183,7 +244,7 @@ qdetector_cccf qdetector_cccf_create_linear(float complex * _sequence,
     qdetector_cccf q = qdetector_cccf_create(s, s_len);
 
     // free allocated temporary array
-    free(s);
+    liquid_free(s);
 
     // return object
     return q;
@@ -218,7 +279,7 @@ qdetector_cccf qdetector_cccf_create_gmsk(unsigned char * _sequence,
     
     // create time-domain template using GMSK modem
     unsigned int    s_len = _k * (_sequence_len + 2*_m);
-    float complex * s     = (float complex*) malloc(s_len * sizeof(float complex));
+    float complex * s     = (float complex*) liquid_malloc(s_len * sizeof(float complex));
     gmskmod mod = gmskmod_create(_k, _m, _beta);
     unsigned int i;
     for (i=0; i<_sequence_len + 2*_m; i++)
@@ -229,28 +290,97 @@ qdetector_cccf qdetector_cccf_create_gmsk(unsigned char * _sequence,
     qdetector_cccf q = qdetector_cccf_create(s, s_len);
 
     // free allocated temporary array
-    free(s);
+    liquid_free(s);
 
     // return object
     return q;
 }
 
+// create detector sharing the (read-only) template of an existing
+// detector; configuration is copied from the prototype while buffers,
+// transforms and state are private to the new object.  Objects sharing
+// a template may run in different threads, but must be created and
+// destroyed from a single thread.
+//  _proto  :   prototype detector
+qdetector_cccf qdetector_cccf_create_shared(qdetector_cccf _proto)
+{
+    qdetector_cccf q = (qdetector_cccf) liquid_malloc(sizeof(struct qdetector_cccf_s));
+
+    // share template
+    q->s_len  = _proto->s_len;
+    q->s      = _proto->s;
+    q->S      = _proto->S;
+    q->s2_sum = _proto->s2_sum;
+    q->refs   = _proto->refs;
+    (*q->refs)++;
+
+    // prepare transforms
+    q->nfft       = _proto->nfft;
+    q->buf_time_0 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_0 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_1 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_time_1 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+
+    q->fft  = fft_create_plan(q->nfft, q->buf_time_0, q->buf_freq_0, LIQUID_FFT_FORWARD,  0);
+    q->ifft = fft_create_plan(q->nfft, q->buf_freq_1, q->buf_time_1, LIQUID_FFT_BACKWARD, 0);
+
+    // copy configuration
+    q->threshold      = _proto->threshold;
+    q->range          = _proto->range;
+    q->range_step     = _proto->range_step;
+    q->gate_enabled   = _proto->gate_enabled;
+    q->gate_threshold = _proto->gate_threshold;
+
+    // reset state variables
+    q->counter        = q->nfft/2;
+    q->num_transforms = 0;
+    q->x2_sum_0       = 0.0f;
+    q->x2_sum_1       = 0.0f;
+    q->gate_floor     = noisefloor_create(0.5f, QDETECTOR_GATE_MEMORY);
+    q->num_blocks     = 0;
+    q->num_skipped    = 0;
+    q->offload        = NULL;
+    q->buf_sweep      = NULL;
+    q->sweep_offsets  = NULL;
+    q->num_sweep      = 0;
+    q->state          = QDETECTOR_STATE_SEEK;
+    q->frame_detected = 0;
+    memset(q->buf_time_0, 0x00, q->nfft*sizeof(float complex));
+
+    // reset estimates
+    q->offset    = 0;
+    q->tau_hat   = 0.0f;
+    q->gamma_hat = 0.0f;
+    q->dphi_hat  = 0.0f;
+    q->phi_hat   = 0.0f;
+    return q;
+}
+
 void qdetector_cccf_destroy(qdetector_cccf _q)
 {
+    // release template
+    if (--(*_q->refs) == 0) {
+        liquid_free(_q->s   );
+        liquid_free(_q->S   );
+        liquid_free(_q->refs);
+    }
+
+    // release offload buffers
+    qdetector_cccf_set_offload(_q, NULL);
+
     // free allocated arrays
-    free(_q->s         );
-    free(_q->S         );
-    free(_q->buf_time_0);
-    free(_q->buf_freq_0);
-    free(_q->buf_freq_1);
-    free(_q->buf_time_1);
+    liquid_free(_q->buf_time_0);
+    liquid_free(_q->buf_freq_0);
+    liquid_free(_q->buf_freq_1);
+    liquid_free(_q->buf_time_1);
 
     // destroy objects
     fft_destroy_plan(_q->fft);
     fft_destroy_plan(_q->ifft);
+    noisefloor_destroy(_q->gate_floor);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void qdetector_cccf_print(qdetector_cccf _q)
@@ -260,10 +390,45 @@ void qdetector_cccf_print(qdetector_cccf _q)
     printf("  FFT size              :   %-u\n",   _q->nfft);
     printf("  detection threshold   :   %6.4f\n", _q->threshold);
     printf("  sum{ s^2 }            :   %.2f\n",  _q->s2_sum);
+    if (_q->gate_enabled) {
+        printf("  energy gate           :   %.2f dB (noise floor %.2f dB)\n",
+                _q->gate_threshold, qdetector_cccf_gate_get_noise_floor(_q));
+        printf("  blocks skipped        :   %u / %u\n", _q->num_skipped, _q->num_blocks);
+    }
+}
+
+// get memory footprint of detector [bytes]; the template shared with
+// other detectors (see qdetector_cccf_create_shared()) is divided
+// evenly among the objects sharing it
+unsigned long int qdetector_cccf_get_memory_usage(qdetector_cccf _q)
+{
+    unsigned long int n_shared = sizeof(unsigned int)
+                               + (_q->s_len + _q->nfft)*sizeof(float complex);
+
+    return sizeof(struct qdetector_cccf_s)
+         + n_shared / *_q->refs
+         + 4*_q->nfft*sizeof(float complex)
+         + fft_get_memory_usage(_q->fft)
+         + fft_get_memory_usage(_q->ifft);
 }
 
 void qdetector_cccf_reset(qdetector_cccf _q)
 {
+    // clear buffer; after a detection it still holds samples from the
+    // start of the detected frame which would otherwise be correlated
+    // together with the next input
+    _q->counter        = _q->nfft/2;
+    _q->x2_sum_0       = 0.0f;
+    _q->x2_sum_1       = 0.0f;
+    _q->state          = QDETECTOR_STATE_SEEK;
+    _q->frame_detected = 0;
+    memset(_q->buf_time_0, 0x00, _q->nfft*sizeof(float complex));
+
+    // reset estimates
+    _q->tau_hat   = 0.0f;
+    _q->gamma_hat = 0.0f;
+    _q->dphi_hat  = 0.0f;
+    _q->phi_hat   = 0.0f;
 }
 
 void * qdetector_cccf_execute(qdetector_cccf _q,
@@ -307,6 +472,12 @@ void qdetector_cccf_set_threshold(qdetector_cccf _q,
     _q->threshold = _threshold;
 }
 
+// get detection threshold
+float qdetector_cccf_get_threshold(qdetector_cccf _q)
+{
+    return _q->threshold;
+}
+
 // set carrier offset search range
 void qdetector_cccf_set_range(qdetector_cccf _q,
                               float          _dphi_max)
@@ -322,6 +493,52 @@ void qdetector_cccf_set_range(qdetector_cccf _q,
     //printf("range: %d / %u\n", _q->range, _q->nfft);
 }
 
+// get carrier offset search range
+float qdetector_cccf_get_range(qdetector_cccf _q)
+{
+    return (float)(_q->range) * 2*M_PI / (float)(_q->nfft);
+}
+
+// set carrier offset search grid step; offsets are first evaluated on
+// a grid of this step (subcarriers), then refined about the best grid
+// point (1 for an exhaustive search)
+void qdetector_cccf_set_range_step(qdetector_cccf _q,
+                                   unsigned int   _step)
+{
+    if (_step == 0) {
+        fprintf(stderr,"warning: carrier offset search step must be greater than zero; ignoring\n");
+        return;
+    }
+
+    _q->range_step = _step;
+}
+
+// get carrier offset search grid step
+unsigned int qdetector_cccf_get_range_step(qdetector_cccf _q)
+{
+    return _q->range_step;
+}
+
+// set offload queue for the carrier offset grid sweep (NULL: sweep in
+// place); the queue must outlive the detector or be replaced first
+void qdetector_cccf_set_offload(qdetector_cccf _q,
+                                liquid_offload _offload)
+{
+    if (_q->offload != NULL)
+        liquid_offload_free(_q->offload, _q->buf_sweep);
+    liquid_free(_q->sweep_offsets);
+    _q->offload       = _offload;
+    _q->buf_sweep     = NULL;
+    _q->sweep_offsets = NULL;
+    _q->num_sweep     = 0;
+}
+
+// get offload queue (NULL if none)
+liquid_offload qdetector_cccf_get_offload(qdetector_cccf _q)
+{
+    return _q->offload;
+}
+
 // get sequence length
 unsigned int qdetector_cccf_get_seq_len(qdetector_cccf _q)
 {
@@ -364,6 +581,76 @@ float qdetector_cccf_get_phi(qdetector_cccf _q)
     return _q->phi_hat;
 }
 
+// enable energy gate; the correlation sweep is bypassed until the
+// input energy rises above the adaptive noise floor estimate
+void qdetector_cccf_gate_enable(qdetector_cccf _q)
+{
+    // restart noise floor estimate
+    if (!_q->gate_enabled)
+        noisefloor_reset(_q->gate_floor);
+
+    _q->gate_enabled = 1;
+}
+
+// disable energy gate
+void qdetector_cccf_gate_disable(qdetector_cccf _q)
+{
+    _q->gate_enabled = 0;
+}
+
+// is energy gate enabled?
+int qdetector_cccf_gate_is_enabled(qdetector_cccf _q)
+{
+    return _q->gate_enabled;
+}
+
+// set energy gate threshold above noise floor [dB]
+void qdetector_cccf_gate_set_threshold(qdetector_cccf _q,
+                                       float          _threshold)
+{
+    if (_threshold < 0.0f) {
+        fprintf(stderr,"warning: gate threshold (%12.4e) out of range; ignoring\n", _threshold);
+        return;
+    }
+
+    _q->gate_threshold = _threshold;
+}
+
+// get energy gate threshold above noise floor [dB]
+float qdetector_cccf_gate_get_threshold(qdetector_cccf _q)
+{
+    return _q->gate_threshold;
+}
+
+// get noise floor estimate, mean |x|^2 [dB]
+float qdetector_cccf_gate_get_noise_floor(qdetector_cccf _q)
+{
+    // not yet estimated
+    if (noisefloor_get_num_blocks(_q->gate_floor) == 0)
+        return -1e6f;
+
+    return 10.0f*log10f(noisefloor_get_level(_q->gate_floor) + 1e-36f);
+}
+
+// number of seek blocks processed
+unsigned int qdetector_cccf_gate_get_num_blocks(qdetector_cccf _q)
+{
+    return _q->num_blocks;
+}
+
+// number of seek blocks bypassed by energy gate
+unsigned int qdetector_cccf_gate_get_num_skipped(qdetector_cccf _q)
+{
+    return _q->num_skipped;
+}
+
+// reset energy gate statistics
+void qdetector_cccf_gate_reset_stats(qdetector_cccf _q)
+{
+    _q->num_blocks  = 0;
+    _q->num_skipped = 0;
+}
+
 
 //
 // internal methods
@@ -385,6 +672,20 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
     // reset counter (last half of time buffer)
     _q->counter = _q->nfft/2;
 
+    // bypass correlation if energy gate is closed
+    _q->num_blocks++;
+    if (!qdetector_cccf_gate_update(_q)) {
+        _q->num_skipped++;
+
+        // copy last half of fft input buffer to front
+        memmove(_q->buf_time_0, _q->buf_time_0 + _q->nfft/2, (_q->nfft/2)*sizeof(float complex));
+
+        // swap accumulated signal levels
+        _q->x2_sum_0 = _q->x2_sum_1;
+        _q->x2_sum_1 = 0.0f;
+        return;
+    }
+
     // run forward transform
     fft_execute(_q->fft);
 
@@ -392,59 +693,44 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
     float g0 = sqrtf(_q->x2_sum_0 + _q->x2_sum_1) * sqrtf((float)(_q->s_len) / (float)(_q->nfft));
     float g = 1.0f / ( (float)(_q->nfft) * g0 * sqrtf(_q->s2_sum) );
     
-    // sweep over carrier frequency offset range
-    int offset;
-    unsigned int i;
-    float        rxy_peak   = 0.0f;
+    // sweep over carrier frequency offset range, first on grid of
+    // range_step subcarriers and then about best grid point; peak is
+    // found on unscaled |rxy|^2 so only the peak is scaled
+    // NOTE: this offset may be coarse as a fine carrier estimate is computed later
+    int          offset;
+    unsigned int index;
+    int          step       = (int)_q->range_step;
+    float        rxy2_peak  = 0.0f;
     unsigned int rxy_index  = 0;
     int          rxy_offset = 0;
-    // NOTE: this offset may be coarse as a fine carrier estimate is computed later
-    for (offset=-_q->range; offset<=_q->range; offset++) {
-
-        // cross-multiply, aligning appropriately
-        for (i=0; i<_q->nfft; i++) {
-            // shifted index
-            unsigned int j = (i + _q->nfft - offset) % _q->nfft;
-
-            _q->buf_freq_1[i] = _q->buf_freq_0[i] * conjf(_q->S[j]);
+    if (_q->offload != NULL) {
+        rxy2_peak = qdetector_cccf_sweep_offload(_q, &rxy_index, &rxy_offset);
+    } else {
+        for (offset=-_q->range; offset<=_q->range; offset+=step) {
+            float rxy2 = qdetector_cccf_sweep_offset(_q, offset, &index);
+            if (rxy2 > rxy2_peak) {
+                rxy2_peak  = rxy2;
+                rxy_index  = index;
+                rxy_offset = offset;
+            }
         }
-
-        // run inverse transform
-        fft_execute(_q->ifft);
-        
-        // scale output appropriately
-        liquid_vectorcf_mulscalar(_q->buf_time_1, _q->nfft, g, _q->buf_time_1);
-
-#if DEBUG_QDETECTOR
-        // debug output
-        char filename[64];
-        sprintf(filename,"qdetector_out_%u_%d.m", _q->num_transforms, offset+2);
-        FILE * fid = fopen(filename, "w");
-        fprintf(fid,"clear all; close all;\n");
-        fprintf(fid,"nfft = %u;\n", _q->nfft);
-        for (i=0; i<_q->nfft; i++)
-            fprintf(fid,"rxy(%6u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(_q->buf_time_1[i]), cimagf(_q->buf_time_1[i]));
-        fprintf(fid,"figure;\n");
-        fprintf(fid,"t=[0:(nfft-1)];\n");
-        fprintf(fid,"plot(t,abs(rxy));\n");
-        fprintf(fid,"grid on;\n");
-        fprintf(fid,"axis([0 %u 0 1.5]);\n", _q->nfft);
-        fprintf(fid,"[v i] = max(abs(rxy));\n");
-        fprintf(fid,"title(sprintf('peak of %%12.8f at index %%u', v, i));\n");
-        fclose(fid);
-        printf("debug: %s\n", filename);
-#endif
-        // search for peak
-        // TODO: only search over range [-nfft/2, nfft/2)
-        for (i=0; i<_q->nfft; i++) {
-            float rxy_abs = cabsf(_q->buf_time_1[i]);
-            if (rxy_abs > rxy_peak) {
-                rxy_peak   = rxy_abs;
-                rxy_index  = i;
+    }
+    if (step > 1) {
+        int grid_offset = rxy_offset;
+        int offset_min  = grid_offset - step + 1 < -_q->range ? -_q->range : grid_offset - step + 1;
+        int offset_max  = grid_offset + step - 1 >  _q->range ?  _q->range : grid_offset + step - 1;
+        for (offset=offset_min; offset<=offset_max; offset++) {
+            if (offset == grid_offset)
+                continue;
+            float rxy2 = qdetector_cccf_sweep_offset(_q, offset, &index);
+            if (rxy2 > rxy2_peak) {
+                rxy2_peak  = rxy2;
+                rxy_index  = index;
                 rxy_offset = offset;
             }
         }
     }
+    float rxy_peak = g * sqrtf(rxy2_peak);
 
     // increment number of transforms (debugging)
     _q->num_transforms++;
@@ -493,11 +779,9 @@ void qdetector_cccf_execute_align(qdetector_cccf _q,
     // cross-multiply frequency-domain components, aligning appropriately with
     // estimated FFT offset index due to carrier frequency offset in received signal
     unsigned int i;
-    for (i=0; i<_q->nfft; i++) {
-        // shifted index
-        unsigned int j = (i + _q->nfft - _q->offset) % _q->nfft;
-        _q->buf_freq_1[i] = _q->buf_freq_0[i] * conjf(_q->S[j]);
-    }
+    unsigned int o = (unsigned int)(_q->offset + (int)_q->nfft) % _q->nfft;
+    qdetector_cccf_cmul(_q->buf_freq_0,     _q->S + _q->nfft - o, o,            _q->buf_freq_1    );
+    qdetector_cccf_cmul(_q->buf_freq_0 + o, _q->S,                _q->nfft - o, _q->buf_freq_1 + o);
     fft_execute(_q->ifft);
     // time aligned to index 0
     // NOTE: taking the sqrt removes bias in the timing estimate, but messes up gamma estimate
@@ -513,12 +797,24 @@ void qdetector_cccf_execute_align(qdetector_cccf _q,
     float g_hat   = (a*_q->tau_hat*_q->tau_hat + b*_q->tau_hat + c);
     _q->gamma_hat = g_hat * g_hat / ((float)(_q->nfft) * _q->s2_sum); // g_hat^2 because of sqrt for yneg/y0/ypos
 
-    // copy buffer to preserve data integrity
-    memmove(_q->buf_time_1, _q->buf_time_0, _q->nfft*sizeof(float complex));
+    // advance received signal by the fractional timing estimate so that it
+    // lines up with the sequence; otherwise inter-symbol interference leaves
+    // a random phase slope in the de-modulated sequence which biases the
+    // carrier frequency estimate and, through it, the phase estimate
+    for (i=0; i<_q->nfft; i++) {
+        int   k = i < _q->nfft/2 ? (int)i : (int)i - (int)_q->nfft;
+        float f = (float)k / (float)(_q->nfft);
+        _q->buf_freq_1[i] = _q->buf_freq_0[i] * cexpf(_Complex_I*2*M_PI*f*_q->tau_hat);
+    }
+    fft_execute(_q->ifft);
 
-    // estimate carrier frequency offset
-    for (i=0; i<_q->nfft; i++)
-        _q->buf_time_0[i] *= i < _q->s_len ? conjf(_q->s[i]) : 0.0f;
+    // copy buffer to preserve data integrity while de-modulating aligned
+    // signal to estimate carrier frequency offset
+    for (i=0; i<_q->nfft; i++) {
+        float complex v = _q->buf_time_1[i] / (float)(_q->nfft);
+        _q->buf_time_1[i] = _q->buf_time_0[i];
+        _q->buf_time_0[i] = i < _q->s_len ? v * conjf(_q->s[i]) : 0.0f;
+    }
     fft_execute(_q->fft);
 #if DEBUG_QDETECTOR
     // debug output
@@ -577,9 +873,29 @@ void qdetector_cccf_execute_align(qdetector_cccf _q,
     for (i=0; i<_q->s_len; i++)
         metric += _q->buf_time_0[i] * cexpf(-_Complex_I*_q->dphi_hat*i);
     //printf("metric : %12.8f <%12.8f>\n", cabsf(metric), cargf(metric));
-    _q->phi_hat = cargf(metric);
+    // remove phase accumulated by advancing signal
+    _q->phi_hat = cargf(metric) - _q->dphi_hat*_q->tau_hat;
 #endif
 
+    // refine timing offset estimate: the coarse correlation above only
+    // removes the carrier offset to within an FFT bin, and the residual
+    // skews the correlation peak (notably for GMSK). Correlate the saved
+    // signal, de-rotated by the fine estimate, at lags -1, 0, +1.
+    float complex r[3] = {0.0f, 0.0f, 0.0f};
+    for (i=0; i<_q->s_len; i++) {
+        unsigned int l;
+        for (l=0; l<3; l++) {
+            unsigned int n = (i + l + _q->nfft - 1) % _q->nfft;
+            r[l] += _q->buf_time_1[n] * cexpf(-_Complex_I*_q->dphi_hat*n) * conjf(_q->s[i]);
+        }
+    }
+    yneg = sqrtf(cabsf(r[0]));
+    y0   = sqrtf(cabsf(r[1]));
+    ypos = sqrtf(cabsf(r[2]));
+    a    =  0.5f*(ypos + yneg) - y0;
+    b    =  0.5f*(ypos - yneg);
+    _q->tau_hat = -b / (2.0f*a);
+
 #if DEBUG_QDETECTOR_PRINT
     printf("  y[    -1] : %12.8f\n", yneg);
     printf("  y[     0] : %12.8f\n", y0  );
@@ -606,3 +922,182 @@ void qdetector_cccf_execute_align(qdetector_cccf _q,
     _q->counter = _q->nfft/2;
 }
 
+// update energy gate with latest buffer levels, returning 1 if the
+// correlation sweep should be run
+int qdetector_cccf_gate_update(qdetector_cccf _q)
+{
+    if (!_q->gate_enabled)
+        return 1;
+
+    // mean |x|^2 in each half of buffer; a frame contained in the
+    // buffer raises the level of at least one half
+    float e0 = _q->x2_sum_0 / (float)(_q->nfft/2);
+    float e1 = _q->x2_sum_1 / (float)(_q->nfft/2);
+
+    // initialize noise floor on first block and run sweep
+    if (noisefloor_get_num_blocks(_q->gate_floor) == 0) {
+        noisefloor_push(_q->gate_floor, e1);
+        return 1;
+    }
+
+    float g = powf(10.0f, _q->gate_threshold/10.0f) * noisefloor_get_level(_q->gate_floor);
+    int open = e0 > g || e1 > g;
+
+    // track noise floor from newest half; the median ignores sparse
+    // frames, while persistent interference eventually closes the gate
+    noisefloor_push(_q->gate_floor, e1);
+
+    return open;
+}
+
+// cross-correlate transformed buffer with template at carrier offset
+// (subcarriers), returning the peak |rxy|^2 (unscaled) and its index
+float qdetector_cccf_sweep_offset(qdetector_cccf _q,
+                                  int            _offset,
+                                  unsigned int * _index)
+{
+    // cross-multiply, aligning appropriately: the template shifted by
+    // _offset subcarriers wraps around, giving two contiguous spans
+    unsigned int o = (unsigned int)(_offset + (int)_q->nfft) % _q->nfft;
+    qdetector_cccf_cmul(_q->buf_freq_0,     _q->S + _q->nfft - o, o,            _q->buf_freq_1    );
+    qdetector_cccf_cmul(_q->buf_freq_0 + o, _q->S,                _q->nfft - o, _q->buf_freq_1 + o);
+
+    // run inverse transform
+    fft_execute(_q->ifft);
+
+#if DEBUG_QDETECTOR
+    // debug output
+    unsigned int i;
+    char filename[64];
+    sprintf(filename,"qdetector_out_%u_%d.m", _q->num_transforms, _offset+2);
+    FILE * fid = fopen(filename, "w");
+    fprintf(fid,"clear all; close all;\n");
+    fprintf(fid,"nfft = %u;\n", _q->nfft);
+    for (i=0; i<_q->nfft; i++)
+        fprintf(fid,"rxy(%6u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(_q->buf_time_1[i]), cimagf(_q->buf_time_1[i]));
+    fprintf(fid,"figure;\n");
+    fprintf(fid,"t=[0:(nfft-1)];\n");
+    fprintf(fid,"plot(t,abs(rxy));\n");
+    fprintf(fid,"grid on;\n");
+    fprintf(fid,"[v i] = max(abs(rxy));\n");
+    fprintf(fid,"title(sprintf('peak of %%12.8f (unscaled) at index %%u', v, i));\n");
+    fclose(fid);
+    printf("debug: %s\n", filename);
+#endif
+
+    // search for peak
+    return qdetector_cccf_peak(_q, _q->buf_time_1, _index);
+}
+
+// search correlator output for peak |rxy|^2 (unscaled) and its index
+float qdetector_cccf_peak(qdetector_cccf  _q,
+                          float complex * _rxy,
+                          unsigned int *  _index)
+{
+    // TODO: only search over range [-nfft/2, nfft/2)
+    float *      r         = (float*) _rxy;
+    float        rxy2_peak = 0.0f;
+    unsigned int rxy_index = 0;
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++) {
+        float rxy2 = r[2*i]*r[2*i] + r[2*i+1]*r[2*i+1];
+        if (rxy2 > rxy2_peak) {
+            rxy2_peak = rxy2;
+            rxy_index = i;
+        }
+    }
+
+    *_index = rxy_index;
+    return rxy2_peak;
+}
+
+// sweep carrier offset grid, returning the peak |rxy|^2 (unscaled) and
+// its index and offset; the lower half of the grid is submitted to the
+// offload queue as one job while the upper half is swept in place
+float qdetector_cccf_sweep_offload(qdetector_cccf _q,
+                                   unsigned int * _index,
+                                   int *          _offset)
+{
+    // grid of carrier offsets; buffers are resized when the number of
+    // offloaded offsets changes
+    int          step    = (int)_q->range_step;
+    unsigned int num     = (unsigned int)(2*_q->range / step) + 1;
+    unsigned int num_off = (num + 1) / 2;
+    if (num_off != _q->num_sweep) {
+        liquid_offload_free(_q->offload, _q->buf_sweep);
+        _q->buf_sweep = (float complex*) liquid_offload_alloc(_q->offload, num_off*_q->nfft*sizeof(float complex));
+        _q->sweep_offsets = (int*) liquid_realloc(_q->sweep_offsets, num_off*sizeof(int));
+        _q->num_sweep = num_off;
+    }
+    unsigned int k;
+    for (k=0; k<num_off; k++)
+        _q->sweep_offsets[k] = -_q->range + (int)k*step;
+
+    unsigned long ticket = liquid_offload_xcorr(_q->offload, _q->nfft,
+            _q->buf_freq_0, _q->S, num_off, _q->sweep_offsets, _q->buf_sweep);
+
+    // sweep remaining offsets while the job runs; the job only reads
+    // the transformed input and template
+    float        cpu_peak   = 0.0f;
+    unsigned int cpu_index  = 0;
+    int          cpu_offset = 0;
+    unsigned int index;
+    for (k=num_off; k<num; k++) {
+        int   offset = -_q->range + (int)k*step;
+        float rxy2   = qdetector_cccf_sweep_offset(_q, offset, &index);
+        if (rxy2 > cpu_peak) {
+            cpu_peak   = rxy2;
+            cpu_index  = index;
+            cpu_offset = offset;
+        }
+    }
+
+    // search offloaded outputs, then merge in grid order so ties
+    // resolve as in the in-place sweep
+    liquid_offload_wait(_q->offload, ticket);
+    float rxy2_peak = 0.0f;
+    *_index  = 0;
+    *_offset = 0;
+    for (k=0; k<num_off; k++) {
+        float rxy2 = qdetector_cccf_peak(_q, _q->buf_sweep + k*_q->nfft, &index);
+        if (rxy2 > rxy2_peak) {
+            rxy2_peak = rxy2;
+            *_index   = index;
+            *_offset  = _q->sweep_offsets[k];
+        }
+    }
+    if (cpu_peak > rxy2_peak) {
+        rxy2_peak = cpu_peak;
+        *_index   = cpu_index;
+        *_offset  = cpu_offset;
+    }
+    return rxy2_peak;
+}
+
+// multiply complex arrays: z[i] = x[i] * y[i]; computed on (real,imag)
+// pairs, two samples at a time, so that the loop body vectorizes
+void qdetector_cccf_cmul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+    unsigned int i;
+    for (i=0; i+2<=_n; i+=2) {
+        float a0 = x[2*i  ], b0 = x[2*i+1], c0 = y[2*i  ], d0 = y[2*i+1];
+        float a1 = x[2*i+2], b1 = x[2*i+3], c1 = y[2*i+2], d1 = y[2*i+3];
+        z[2*i  ] = a0*c0 - b0*d0;
+        z[2*i+1] = a0*d0 + b0*c0;
+        z[2*i+2] = a1*c1 - b1*d1;
+        z[2*i+3] = a1*d1 + b1*c1;
+    }
+
+    // clean up remaining sample
+    if (i < _n) {
+        float a0 = x[2*i], b0 = x[2*i+1], c0 = y[2*i], d0 = y[2*i+1];
+        z[2*i  ] = a0*c0 - b0*d0;
+        z[2*i+1] = a0*d0 + b0*c0;
+    }
+}
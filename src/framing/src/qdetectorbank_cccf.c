@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// qdetectorbank_cccf.c
+//
+// Multi-template frame detector: one forward transform of the input
+// buffer is correlated against the spectra of several templates, so
+// a receiver listening for several frame formats pays for a single
+// FFT per block instead of one per format.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+#define DEBUG_QDETECTORBANK_PRINT   0
+
+// template
+struct qdetectorbank_template_s {
+    unsigned int    s_len;          // template (time) length
+    float complex * s;              // template (time), [size: s_len x 1]
+    float complex * S;              // conjugated template (freq), [size: nfft x 1]
+    float           s2_sum;         // sum{ s^2 }
+    float           threshold;      // detection threshold
+    int             range;          // carrier offset search range (subcarriers)
+};
+
+// seek signal (initial detection)
+void qdetectorbank_cccf_execute_seek(qdetectorbank_cccf _q,
+                                     float complex      _x);
+
+// align signal in time, compute offset estimates
+void qdetectorbank_cccf_execute_align(qdetectorbank_cccf _q,
+                                      float complex      _x);
+
+// cross-correlate transformed buffer with template at carrier offset
+// (subcarriers), returning the peak |rxy|^2 (unscaled) and its index
+float qdetectorbank_cccf_sweep_offset(qdetectorbank_cccf _q,
+                                      unsigned int       _t,
+                                      int                _offset,
+                                      unsigned int *     _index);
+
+// main object definition
+struct qdetectorbank_cccf_s {
+    unsigned int    num;            // number of templates
+    struct qdetectorbank_template_s * templates;
+
+    float complex * buf_time_0;     // time-domain buffer (FFT)
+    float complex * buf_freq_0;     // frequence-domain buffer (FFT)
+    float complex * buf_freq_1;     // frequence-domain buffer (IFFT)
+    float complex * buf_time_1;     // time-domain buffer (IFFT)
+    unsigned int    nfft;           // fft size (largest of prototypes)
+    fftplan         fft;            // FFT object:  buf_time_0 > buf_freq_0
+    fftplan         ifft;           // IFFT object: buf_freq_1 > buf_time_1
+
+    unsigned int    counter;        // sample counter for determining when to compute FFTs
+    float           x2_sum_0;       // sum{ |x|^2 } of first half of buffer
+    float           x2_sum_1;       // sum{ |x|^2 } of second half of buffer
+
+    unsigned int    index;          // template of detected frame
+    int             offset;         // FFT offset index for peak correlation (coarse carrier estimate)
+    float           tau_hat;        // timing offset estimate
+    float           gamma_hat;      // signal level estimate (channel gain)
+    float           dphi_hat;       // carrier frequency offset estimate
+    float           phi_hat;        // carrier phase offset estimate
+
+    enum {
+        QDETECTORBANK_STATE_SEEK,   // seek sequence
+        QDETECTORBANK_STATE_ALIGN,  // align sequence
+    }               state;          // execution state
+    int             frame_detected; // frame detected?
+};
+
+// create detector correlating one forward transform of the input
+// against the templates of several detectors
+//  _proto  :   prototype detectors, [size: _num x 1]
+//  _num    :   number of templates
+qdetectorbank_cccf qdetectorbank_cccf_create(qdetector_cccf * _proto,
+                                             unsigned int     _num)
+{
+    // validate input
+    if (_num == 0) {
+        fprintf(stderr,"error: qdetectorbank_cccf_create(), number of templates must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate memory for main object and set internal properties
+    qdetectorbank_cccf q = (qdetectorbank_cccf) liquid_malloc(sizeof(struct qdetectorbank_cccf_s));
+    q->num       = _num;
+    q->templates = (struct qdetectorbank_template_s*) liquid_malloc(q->num*sizeof(struct qdetectorbank_template_s));
+
+    // common transform size: that of the longest template
+    unsigned int i;
+    unsigned int t;
+    q->nfft = 0;
+    for (t=0; t<q->num; t++) {
+        unsigned int nfft = qdetector_cccf_get_buf_len(_proto[t]);
+        q->nfft = nfft > q->nfft ? nfft : q->nfft;
+    }
+
+    // prepare transforms
+    q->buf_time_0 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_0 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_1 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+    q->buf_time_1 = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+
+    q->fft  = fft_create_plan(q->nfft, q->buf_time_0, q->buf_freq_0, LIQUID_FFT_FORWARD,  0);
+    q->ifft = fft_create_plan(q->nfft, q->buf_freq_1, q->buf_time_1, LIQUID_FFT_BACKWARD, 0);
+
+    // copy templates, storing conjugate of nfft-point transform of each
+    for (t=0; t<q->num; t++) {
+        struct qdetectorbank_template_s * p = &q->templates[t];
+        p->s_len  = qdetector_cccf_get_seq_len(_proto[t]);
+        p->s      = (float complex*) liquid_malloc(p->s_len * sizeof(float complex));
+        memmove(p->s, qdetector_cccf_get_sequence(_proto[t]), p->s_len*sizeof(float complex));
+        p->s2_sum = liquid_sumsqcf(p->s, p->s_len);
+
+        p->S = (float complex*) liquid_malloc(q->nfft * sizeof(float complex));
+        memset(q->buf_time_0, 0x00, q->nfft*sizeof(float complex));
+        memmove(q->buf_time_0, p->s, p->s_len*sizeof(float complex));
+        fft_execute(q->fft);
+        for (i=0; i<q->nfft; i++)
+            p->S[i] = conjf(q->buf_freq_0[i]);
+
+        // copy configuration
+        p->threshold = qdetector_cccf_get_threshold(_proto[t]);
+        qdetectorbank_cccf_set_range(q, t, qdetector_cccf_get_range(_proto[t]));
+    }
+
+    // reset state variables
+    qdetectorbank_cccf_reset(q);
+
+    // return object
+    return q;
+}
+
+void qdetectorbank_cccf_destroy(qdetectorbank_cccf _q)
+{
+    // free templates
+    unsigned int t;
+    for (t=0; t<_q->num; t++) {
+        liquid_free(_q->templates[t].s);
+        liquid_free(_q->templates[t].S);
+    }
+    liquid_free(_q->templates);
+
+    // free allocated arrays
+    liquid_free(_q->buf_time_0);
+    liquid_free(_q->buf_freq_0);
+    liquid_free(_q->buf_freq_1);
+    liquid_free(_q->buf_time_1);
+
+    // destroy objects
+    fft_destroy_plan(_q->fft);
+    fft_destroy_plan(_q->ifft);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+void qdetectorbank_cccf_print(qdetectorbank_cccf _q)
+{
+    printf("qdetectorbank_cccf:\n");
+    printf("  FFT size              :   %-u\n", _q->nfft);
+    printf("  templates             :   %-u\n", _q->num);
+    unsigned int t;
+    for (t=0; t<_q->num; t++) {
+        printf("  [%2u] length %5u, threshold %6.4f, range %d\n", t,
+                _q->templates[t].s_len, _q->templates[t].threshold, _q->templates[t].range);
+    }
+}
+
+void qdetectorbank_cccf_reset(qdetectorbank_cccf _q)
+{
+    _q->counter        = _q->nfft/2;
+    _q->x2_sum_0       = 0.0f;
+    _q->x2_sum_1       = 0.0f;
+    _q->state          = QDETECTORBANK_STATE_SEEK;
+    _q->frame_detected = 0;
+    memset(_q->buf_time_0, 0x00, _q->nfft*sizeof(float complex));
+
+    // reset estimates
+    _q->index     = 0;
+    _q->offset    = 0;
+    _q->tau_hat   = 0.0f;
+    _q->gamma_hat = 0.0f;
+    _q->dphi_hat  = 0.0f;
+    _q->phi_hat   = 0.0f;
+}
+
+void * qdetectorbank_cccf_execute(qdetectorbank_cccf _q,
+                                  float complex      _x)
+{
+    switch (_q->state) {
+    case QDETECTORBANK_STATE_SEEK:
+        // seek signal
+        qdetectorbank_cccf_execute_seek(_q, _x);
+        break;
+
+    case QDETECTORBANK_STATE_ALIGN:
+        // align signal
+        qdetectorbank_cccf_execute_align(_q, _x);
+        break;
+    }
+
+    // check if frame was detected
+    if (_q->frame_detected) {
+        // clear flag
+        _q->frame_detected = 0;
+
+        // return pointer to internal buffer of saved samples
+        return (void*)(_q->buf_time_1);
+    }
+
+    // frame not yet ready
+    return NULL;
+}
+
+// set detection threshold of template (should be between 0 and 1)
+void qdetectorbank_cccf_set_threshold(qdetectorbank_cccf _q,
+                                      unsigned int       _index,
+                                      float              _threshold)
+{
+    if (_index >= _q->num) {
+        fprintf(stderr,"error: qdetectorbank_cccf_set_threshold(), index (%u) out of range\n", _index);
+        exit(1);
+    } else if (_threshold <= 0.0f || _threshold > 2.0f) {
+        fprintf(stderr,"warning: threshold (%12.4e) out of range; ignoring\n", _threshold);
+        return;
+    }
+
+    _q->templates[_index].threshold = _threshold;
+}
+
+// set carrier offset search range of template
+void qdetectorbank_cccf_set_range(qdetectorbank_cccf _q,
+                                  unsigned int       _index,
+                                  float              _dphi_max)
+{
+    if (_index >= _q->num) {
+        fprintf(stderr,"error: qdetectorbank_cccf_set_range(), index (%u) out of range\n", _index);
+        exit(1);
+    } else if (_dphi_max < 0.0f || _dphi_max > 0.5f) {
+        fprintf(stderr,"warning: carrier offset search range (%12.4e) out of range; ignoring\n", _dphi_max);
+        return;
+    }
+
+    // set internal search range, rounded to nearest subcarrier as the
+    // prototype's range may have been quantized at a smaller FFT size
+    int range = (int)roundf(_dphi_max * _q->nfft / (2*M_PI));
+    _q->templates[_index].range = range < 0 ? 0 : range;
+}
+
+// number of templates
+unsigned int qdetectorbank_cccf_get_num_templates(qdetectorbank_cccf _q)
+{
+    return _q->num;
+}
+
+// template of last detection
+unsigned int qdetectorbank_cccf_get_index(qdetectorbank_cccf _q)
+{
+    return _q->index;
+}
+
+// buffer length
+unsigned int qdetectorbank_cccf_get_buf_len(qdetectorbank_cccf _q)
+{
+    return _q->nfft;
+}
+
+// fractional timing offset estimate
+float qdetectorbank_cccf_get_tau(qdetectorbank_cccf _q)
+{
+    return _q->tau_hat;
+}
+
+// channel gain
+float qdetectorbank_cccf_get_gamma(qdetectorbank_cccf _q)
+{
+    return _q->gamma_hat;
+}
+
+// carrier frequency offset estimate
+float qdetectorbank_cccf_get_dphi(qdetectorbank_cccf _q)
+{
+    return _q->dphi_hat;
+}
+
+// carrier phase offset estimate
+float qdetectorbank_cccf_get_phi(qdetectorbank_cccf _q)
+{
+    return _q->phi_hat;
+}
+
+
+//
+// internal methods
+//
+
+// seek signal (initial detection)
+void qdetectorbank_cccf_execute_seek(qdetectorbank_cccf _q,
+                                     float complex      _x)
+{
+    // write sample to buffer and increment counter
+    _q->buf_time_0[_q->counter++] = _x;
+
+    // accumulate signal magnitude
+    _q->x2_sum_1 += crealf(_x)*crealf(_x) + cimagf(_x)*cimagf(_x);
+
+    if (_q->counter < _q->nfft)
+        return;
+
+    // reset counter (last half of time buffer)
+    _q->counter = _q->nfft/2;
+
+    // run forward transform, shared by all templates
+    fft_execute(_q->fft);
+
+    // sweep each template over its carrier frequency offset range,
+    // keeping the template whose peak exceeds its threshold by the
+    // largest margin
+    float        x2_sum      = _q->x2_sum_0 + _q->x2_sum_1;
+    float        best_margin = 0.0f;
+    unsigned int best_t      = 0;
+    unsigned int best_index  = 0;
+    int          best_offset = 0;
+    int          detected    = 0;
+    unsigned int t;
+    for (t=0; t<_q->num; t++) {
+        struct qdetectorbank_template_s * p = &_q->templates[t];
+
+        // compute scaling factor
+        float g0 = sqrtf(x2_sum) * sqrtf((float)(p->s_len) / (float)(_q->nfft));
+        float g  = 1.0f / ( (float)(_q->nfft) * g0 * sqrtf(p->s2_sum) );
+
+        int          offset;
+        unsigned int index;
+        float        rxy2_peak  = 0.0f;
+        unsigned int rxy_index  = 0;
+        int          rxy_offset = 0;
+        for (offset=-p->range; offset<=p->range; offset++) {
+            float rxy2 = qdetectorbank_cccf_sweep_offset(_q, t, offset, &index);
+            if (rxy2 > rxy2_peak) {
+                rxy2_peak  = rxy2;
+                rxy_index  = index;
+                rxy_offset = offset;
+            }
+        }
+        float rxy_peak = g * sqrtf(rxy2_peak);
+#if DEBUG_QDETECTORBANK_PRINT
+        printf("  template %u: rxy = %12.8f, time index=%u, freq. offset=%d\n", t, rxy_peak, rxy_index, rxy_offset);
+#endif
+
+        float margin = rxy_peak / p->threshold;
+        if (rxy_peak > p->threshold && rxy_index < _q->nfft - p->s_len && margin > best_margin) {
+            detected    = 1;
+            best_margin = margin;
+            best_t      = t;
+            best_index  = rxy_index;
+            best_offset = rxy_offset;
+        }
+    }
+
+    if (detected) {
+#if DEBUG_QDETECTORBANK_PRINT
+        printf("*** frame detected! template=%u, time index=%u, freq. offset=%d\n", best_t, best_index, best_offset);
+#endif
+        // update state, reset counter, copy buffer appropriately
+        _q->state  = QDETECTORBANK_STATE_ALIGN;
+        _q->index  = best_t;
+        _q->offset = best_offset;
+
+        // copy last part of fft input buffer to front
+        memmove(_q->buf_time_0, _q->buf_time_0 + best_index, (_q->nfft - best_index)*sizeof(float complex));
+        _q->counter = _q->nfft - best_index;
+        return;
+    }
+
+    // copy last half of fft input buffer to front
+    memmove(_q->buf_time_0, _q->buf_time_0 + _q->nfft/2, (_q->nfft/2)*sizeof(float complex));
+
+    // swap accumulated signal levels
+    _q->x2_sum_0 = _q->x2_sum_1;
+    _q->x2_sum_1 = 0.0f;
+}
+
+// align signal in time, compute offset estimates using the template
+// of the detected frame
+void qdetectorbank_cccf_execute_align(qdetectorbank_cccf _q,
+                                      float complex      _x)
+{
+    // write sample to buffer and increment counter
+    _q->buf_time_0[_q->counter++] = _x;
+
+    if (_q->counter < _q->nfft)
+        return;
+
+    struct qdetectorbank_template_s * p = &_q->templates[_q->index];
+
+    // estimate timing offset
+    fft_execute(_q->fft);
+    unsigned int i;
+    unsigned int index;
+    qdetectorbank_cccf_sweep_offset(_q, _q->index, _q->offset, &index);
+    // time aligned to index 0
+    float yneg = sqrtf(cabsf(_q->buf_time_1[_q->nfft-1]));
+    float y0   = sqrtf(cabsf(_q->buf_time_1[         0]));
+    float ypos = sqrtf(cabsf(_q->buf_time_1[         1]));
+    // compute timing offset estimate from quadratic polynomial fit
+    float a       =  0.5f*(ypos + yneg) - y0;
+    float b       =  0.5f*(ypos - yneg);
+    float c       =  y0;
+    _q->tau_hat   = -b / (2.0f*a);
+    float g_hat   = (a*_q->tau_hat*_q->tau_hat + b*_q->tau_hat + c);
+    _q->gamma_hat = g_hat * g_hat / ((float)(_q->nfft) * p->s2_sum);
+
+    // advance received signal by the fractional timing estimate before
+    // de-modulating the sequence (see qdetector_cccf_execute_align())
+    for (i=0; i<_q->nfft; i++) {
+        int   n = i < _q->nfft/2 ? (int)i : (int)i - (int)_q->nfft;
+        float f = (float)n / (float)(_q->nfft);
+        _q->buf_freq_1[i] = _q->buf_freq_0[i] * cexpf(_Complex_I*2*M_PI*f*_q->tau_hat);
+    }
+    fft_execute(_q->ifft);
+
+    // copy buffer to preserve data integrity while de-modulating aligned
+    // signal to estimate carrier frequency offset
+    for (i=0; i<_q->nfft; i++) {
+        float complex v = _q->buf_time_1[i] / (float)(_q->nfft);
+        _q->buf_time_1[i] = _q->buf_time_0[i];
+        _q->buf_time_0[i] = i < p->s_len ? v * conjf(p->s[i]) : 0.0f;
+    }
+    fft_execute(_q->fft);
+    float        v0 = 0.0f;
+    unsigned int i0 = 0;
+    for (i=0; i<_q->nfft; i++) {
+        float v_abs = cabsf(_q->buf_freq_0[i]);
+        if (v_abs > v0) {
+            v0 = v_abs;
+            i0 = i;
+        }
+    }
+    // interpolate using quadratic polynomial for carrier frequency estimate
+    unsigned int ineg = (i0 + _q->nfft - 1)%_q->nfft;
+    unsigned int ipos = (i0            + 1)%_q->nfft;
+    float        vneg = cabsf(_q->buf_freq_0[ineg]);
+    float        vpos = cabsf(_q->buf_freq_0[ipos]);
+    a            =  0.5f*(vpos + vneg) - v0;
+    b            =  0.5f*(vpos - vneg);
+    float idx    = -b / (2.0f*a);
+    float k      = (float)i0 + idx;
+    _q->dphi_hat = (i0 > _q->nfft/2 ? k-(float)_q->nfft : k) * 2*M_PI / (float)(_q->nfft);
+
+    // estimate carrier phase offset by de-rotating signal
+    float complex metric = 0;
+    for (i=0; i<p->s_len; i++)
+        metric += _q->buf_time_0[i] * cexpf(-_Complex_I*_q->dphi_hat*i);
+    _q->phi_hat = cargf(metric) - _q->dphi_hat*_q->tau_hat;
+
+    // refine timing offset estimate by correlating the saved signal,
+    // de-rotated by the fine carrier estimate, at lags -1, 0, +1
+    float complex r[3] = {0.0f, 0.0f, 0.0f};
+    for (i=0; i<p->s_len; i++) {
+        unsigned int l;
+        for (l=0; l<3; l++) {
+            unsigned int n = (i + l + _q->nfft - 1) % _q->nfft;
+            r[l] += _q->buf_time_1[n] * cexpf(-_Complex_I*_q->dphi_hat*n) * conjf(p->s[i]);
+        }
+    }
+    yneg = sqrtf(cabsf(r[0]));
+    y0   = sqrtf(cabsf(r[1]));
+    ypos = sqrtf(cabsf(r[2]));
+    a    =  0.5f*(ypos + yneg) - y0;
+    b    =  0.5f*(ypos - yneg);
+    _q->tau_hat = -b / (2.0f*a);
+
+    // set flag
+    _q->frame_detected = 1;
+
+    // reset state
+    // copy saved buffer state (last half of buf_time_1 to front half of buf_time_0)
+    memmove(_q->buf_time_0, _q->buf_time_1 + _q->nfft/2, (_q->nfft/2)*sizeof(float complex));
+    _q->state    = QDETECTORBANK_STATE_SEEK;
+    _q->x2_sum_0 = liquid_sumsqcf(_q->buf_time_0, _q->nfft/2);
+    _q->x2_sum_1 = 0;
+    _q->counter  = _q->nfft/2;
+}
+
+// cross-correlate transformed buffer with template at carrier offset
+// (subcarriers), returning the peak |rxy|^2 (unscaled) and its index
+float qdetectorbank_cccf_sweep_offset(qdetectorbank_cccf _q,
+                                      unsigned int       _t,
+                                      int                _offset,
+                                      unsigned int *     _index)
+{
+    // cross-multiply, aligning appropriately: the template shifted by
+    // _offset subcarriers wraps around, giving two contiguous spans
+    float complex * S = _q->templates[_t].S;
+    unsigned int    o = (unsigned int)(_offset + (int)_q->nfft) % _q->nfft;
+    qdetector_cccf_cmul(_q->buf_freq_0,     S + _q->nfft - o, o,            _q->buf_freq_1    );
+    qdetector_cccf_cmul(_q->buf_freq_0 + o, S,                _q->nfft - o, _q->buf_freq_1 + o);
+
+    // run inverse transform
+    fft_execute(_q->ifft);
+
+    // search for peak
+    float *      r         = (float*) _q->buf_time_1;
+    float        rxy2_peak = 0.0f;
+    unsigned int rxy_index = 0;
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++) {
+        float rxy2 = r[2*i]*r[2*i] + r[2*i+1]*r[2*i+1];
+        if (rxy2 > rxy2_peak) {
+            rxy2_peak = rxy2;
+            rxy_index = i;
+        }
+    }
+
+    *_index = rxy_index;
+    return rxy2_peak;
+}
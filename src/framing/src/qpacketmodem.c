@@ -35,6 +35,20 @@
 
 #include "liquid.internal.h"
 
+// number of pushed symbols collected before soft-demodulating them as a
+// block (block demodulation is considerably cheaper per symbol)
+#define QPACKETMODEM_SOFT_CHUNK (32)
+
+// demodulate frame samples (hard decisions) into decoder input buffer
+void qpacketmodem_demodulate(qpacketmodem    _q,
+                             float complex * _frame);
+
+// soft-demodulate block of symbols into decoder input buffer at the
+// current position of the incremental soft decoder
+void qpacketmodem_demodulate_soft_push(qpacketmodem    _q,
+                                       float complex * _syms,
+                                       unsigned int    _n);
+
 struct qpacketmodem_s {
     // properties
     modem           mod_payload;        // payload modulator/demodulator
@@ -43,16 +57,20 @@ struct qpacketmodem_s {
     unsigned int    payload_dec_len;    // number of decoded payload bytes
     unsigned char * payload_enc;        // payload data (encoded bytes)
     unsigned char * payload_mod;        // payload symbols (modulator output, demod input)
+    unsigned int *  payload_sym;        // payload symbols (block modulator/demodulator)
     unsigned int    payload_enc_len;    // number of encoded payload bytes
     unsigned int    payload_bit_len;    // number of bits in encoded payload
     unsigned int    payload_mod_len;    // number of symbols in encoded payload
+    unsigned int    num_soft_syms;      // symbols demodulated by incremental soft decoder
+    float complex   soft_buf[QPACKETMODEM_SOFT_CHUNK]; // pushed symbols awaiting demodulation
+    unsigned int    num_soft_buf;       // number of symbols in soft_buf
 };
 
 // create packet encoder
 qpacketmodem qpacketmodem_create()
 {
     // allocate memory for main object
-    qpacketmodem q = (qpacketmodem) malloc(sizeof(struct qpacketmodem_s));
+    qpacketmodem q = (qpacketmodem) liquid_malloc(sizeof(struct qpacketmodem_s));
 
     // create payload modem (initially QPSK, overridden by properties)
     q->mod_payload = modem_create(LIQUID_MODEM_QPSK);
@@ -76,11 +94,14 @@ qpacketmodem qpacketmodem_create()
     q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
 
     // soft demodulator uses one byte to represent each soft bit
-    q->payload_enc = (unsigned char*) malloc(q->bits_per_symbol*q->payload_mod_len*sizeof(unsigned char));
+    q->payload_enc = (unsigned char*) liquid_malloc(q->bits_per_symbol*q->payload_mod_len*sizeof(unsigned char));
 
     // set symbol length appropriately
     q->payload_mod_len = q->payload_enc_len * q->bits_per_symbol;   // for QPSK
-    q->payload_mod = (unsigned char*) malloc(q->payload_mod_len*sizeof(unsigned char));
+    q->payload_mod = (unsigned char*) liquid_malloc(q->payload_mod_len*sizeof(unsigned char));
+    q->payload_sym = (unsigned int*)  liquid_malloc(q->payload_mod_len*sizeof(unsigned int));
+    q->num_soft_syms = 0;
+    q->num_soft_buf  = 0;
 
     // return pointer to main object
     return q;
@@ -94,14 +115,20 @@ void qpacketmodem_destroy(qpacketmodem _q)
     modem_destroy(_q->mod_payload);
 
     // free arrays
-    free(_q->payload_enc);
-    free(_q->payload_mod);
+    liquid_free(_q->payload_enc);
+    liquid_free(_q->payload_mod);
+    liquid_free(_q->payload_sym);
+
+    // free main object memory
+    liquid_free(_q);
 }
 
 // reset object
 void qpacketmodem_reset(qpacketmodem _q)
 {
     modem_reset(_q->mod_payload);
+    _q->num_soft_syms = 0;
+    _q->num_soft_buf  = 0;
 }
 
 // print object internals
@@ -118,6 +145,17 @@ void qpacketmodem_print(qpacketmodem _q)
     printf("  payload mod len   :   %u\n", _q->payload_mod_len);
 }
 
+// get memory footprint of object, its modem, packetizer and
+// payload buffers [bytes]
+unsigned long int qpacketmodem_get_memory_usage(qpacketmodem _q)
+{
+    return sizeof(struct qpacketmodem_s)
+         + modem_get_memory_usage(_q->mod_payload)
+         + packetizer_get_memory_usage(_q->p)
+         + _q->bits_per_symbol*_q->payload_mod_len*sizeof(unsigned char)
+         + _q->payload_mod_len*(sizeof(unsigned char) + sizeof(unsigned int));
+}
+
 //
 int qpacketmodem_configure(qpacketmodem _q,
                            unsigned int _payload_len,
@@ -145,12 +183,18 @@ int qpacketmodem_configure(qpacketmodem _q,
     _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
 
     // encoded payload array (leave room for soft-decision decoding)
-    _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
+    _q->payload_enc = (unsigned char*) liquid_realloc(_q->payload_enc,
             _q->bits_per_symbol*_q->payload_mod_len*sizeof(unsigned char));
 
     // reallocate memory for modem symbols
-    _q->payload_mod = (unsigned char*) realloc(_q->payload_mod,
+    _q->payload_mod = (unsigned char*) liquid_realloc(_q->payload_mod,
                                                _q->payload_mod_len*sizeof(unsigned char));
+    _q->payload_sym = (unsigned int*)  liquid_realloc(_q->payload_sym,
+                                               _q->payload_mod_len*sizeof(unsigned int));
+
+    // restart incremental soft decoder
+    _q->num_soft_syms = 0;
+    _q->num_soft_buf  = 0;
 
     return 0;
 }
@@ -258,7 +302,8 @@ void qpacketmodem_encode(qpacketmodem          _q,
     // modulate symbols
     unsigned int i;
     for (i=0; i<_q->payload_mod_len; i++)
-        modem_modulate(_q->mod_payload, _q->payload_mod[i], &_frame[i]);
+        _q->payload_sym[i] = _q->payload_mod[i];
+    modem_modulate_block(_q->mod_payload, _q->payload_sym, _q->payload_mod_len, _frame);
 }
 
 // decode packet from modulated frame samples, returning flag if CRC passed
@@ -269,27 +314,54 @@ int qpacketmodem_decode(qpacketmodem    _q,
                         float complex * _frame,
                         unsigned char * _payload)
 {
-    unsigned int i;
+    // demodulate into decoder input buffer
+    qpacketmodem_demodulate(_q, _frame);
 
-    // demodulate and pack bytes into decoder input buffer
-    unsigned int sym;
-    //memset(_q->payload_enc, 0x00, _q->payload_enc_len*sizeof(unsigned char));
-    for (i=0; i<_q->payload_mod_len; i++) {
-        // demodulate symbol
-        modem_demodulate(_q->mod_payload, _frame[i], &sym);
-
-        // pack decoded symbol into array
-        liquid_pack_array(_q->payload_enc,
-                          _q->payload_enc_len,
-                          i * _q->bits_per_symbol,
-                          _q->bits_per_symbol,
-                          sym);
-    }
+    // decode payload, returning flag if decoded payload is valid
+    return packetizer_decode(_q->p, _q->payload_enc, _payload);
+}
+
+// decode packet from modulated frame samples, returning flag if CRC
+// passed, or -1 if rejected by the syndrome pre-check
+//  _q          :   qpacketmodem object
+//  _frame      :   encoded/modulated payload symbols
+//  _payload    :   recovered decoded payload bytes
+//  _threshold  :   maximum fraction of uncorrectable codewords
+int qpacketmodem_decode_precheck(qpacketmodem    _q,
+                                 float complex * _frame,
+                                 unsigned char * _payload,
+                                 float           _threshold)
+{
+    // demodulate into decoder input buffer
+    qpacketmodem_demodulate(_q, _frame);
+
+    // reject before decoding if outer code flags too many errors
+    if (!packetizer_precheck(_q->p, _q->payload_enc, _threshold))
+        return -1;
 
     // decode payload, returning flag if decoded payload is valid
     return packetizer_decode(_q->p, _q->payload_enc, _payload);
 }
 
+// demodulate frame samples (hard decisions) and pack bits into decoder
+// input buffer
+//  _q          :   qpacketmodem object
+//  _frame      :   encoded/modulated payload symbols
+void qpacketmodem_demodulate(qpacketmodem    _q,
+                             float complex * _frame)
+{
+    // demodulate symbols
+    modem_demodulate_block(_q->mod_payload, _frame, _q->payload_mod_len, _q->payload_sym);
+
+    // pack decoded symbols into array
+    liquid_pack_array_block(_q->payload_enc,
+                            _q->payload_enc_len,
+                            0,
+                            _q->bits_per_symbol,
+                            _q->payload_sym,
+                            _q->payload_mod_len);
+}
+
 // decode packet from modulated frame samples, returning flag if CRC passed
 //  _q          :   qpacketmodem object
 //  _frame      :   encoded/modulated payload symbols
@@ -298,21 +370,99 @@ int qpacketmodem_decode_soft(qpacketmodem    _q,
                              float complex * _frame,
                              unsigned char * _payload)
 {
-    unsigned int i;
+    // demodulate soft bits into decoder input buffer
+    modem_demodulate_soft_block(_q->mod_payload,
+                                _frame,
+                                _q->payload_mod_len,
+                                _q->payload_sym,
+                                _q->payload_enc);
 
-    // demodulate and pack bytes into decoder input buffer
-    unsigned int sym;
-    //memset(_q->payload_enc, 0x00, _q->payload_enc_len*sizeof(unsigned char));
-    unsigned int n = 0;
-    for (i=0; i<_q->payload_mod_len; i++) {
-        // demodulate symbol
-        modem_demodulate_soft(_q->mod_payload, _frame[i], &sym, _q->payload_enc+n);
-        n += _q->bits_per_symbol;
+    // decode payload, returning flag if decoded payload is valid
+    return packetizer_decode_soft(_q->p, _q->payload_enc, _payload);
+}
+
+// push received symbol to incremental soft decoder; symbols are soft-
+// demodulated in small blocks as they arrive; returns 1 once the whole
+// frame has been pushed
+//  _q          :   qpacketmodem object
+//  _sym        :   received payload symbol
+int qpacketmodem_decode_soft_push(qpacketmodem  _q,
+                                  float complex _sym)
+{
+    if (_q->num_soft_syms + _q->num_soft_buf == _q->payload_mod_len) {
+        fprintf(stderr,"error: qpacketmodem_decode_soft_push(), frame already complete\n");
+        exit(1);
     }
-    //printf("received %u bits (expected %u)\n", n, _q->payload_mod_len * _q->bits_per_symbol);
-    assert( n == _q->payload_mod_len * _q->bits_per_symbol);
+
+    _q->soft_buf[_q->num_soft_buf++] = _sym;
+
+    // demodulate once a chunk has been collected or the frame is complete
+    if (_q->num_soft_buf == QPACKETMODEM_SOFT_CHUNK ||
+        _q->num_soft_syms + _q->num_soft_buf == _q->payload_mod_len)
+    {
+        qpacketmodem_demodulate_soft_push(_q, _q->soft_buf, _q->num_soft_buf);
+        _q->num_soft_buf = 0;
+    }
+
+    return _q->num_soft_syms == _q->payload_mod_len;
+}
+
+// push block of received symbols to incremental soft decoder, stopping
+// at the end of the frame; returns number of symbols consumed
+//  _q          :   qpacketmodem object
+//  _syms       :   received payload symbols [size: _n x 1]
+//  _n          :   number of input symbols
+unsigned int qpacketmodem_decode_soft_push_block(qpacketmodem    _q,
+                                                 float complex * _syms,
+                                                 unsigned int    _n)
+{
+    unsigned int n = _q->payload_mod_len - _q->num_soft_syms - _q->num_soft_buf;
+    if (_n < n)
+        n = _n;
+
+    // complete any partially collected chunk first to preserve order
+    unsigned int i = 0;
+    while (_q->num_soft_buf > 0 && i < n)
+        qpacketmodem_decode_soft_push(_q, _syms[i++]);
+
+    // demodulate remainder directly
+    if (i < n)
+        qpacketmodem_demodulate_soft_push(_q, &_syms[i], n - i);
+
+    return n;
+}
+
+// decode packet from soft bits accumulated with _decode_soft_push(),
+// returning flag if CRC passed; restarts the incremental decoder
+//  _q          :   qpacketmodem object
+//  _payload    :   recovered decoded payload bytes
+int qpacketmodem_decode_soft_finish(qpacketmodem    _q,
+                                    unsigned char * _payload)
+{
+    if (_q->num_soft_syms != _q->payload_mod_len) {
+        fprintf(stderr,"error: qpacketmodem_decode_soft_finish(), frame incomplete (%u of %u symbols)\n",
+                _q->num_soft_syms + _q->num_soft_buf, _q->payload_mod_len);
+        exit(1);
+    }
+    _q->num_soft_syms = 0;
 
     // decode payload, returning flag if decoded payload is valid
     return packetizer_decode_soft(_q->p, _q->payload_enc, _payload);
 }
 
+// soft-demodulate block of symbols into decoder input buffer at the
+// current position of the incremental soft decoder
+//  _q          :   qpacketmodem object
+//  _syms       :   received payload symbols [size: _n x 1]
+//  _n          :   number of input symbols
+void qpacketmodem_demodulate_soft_push(qpacketmodem    _q,
+                                       float complex * _syms,
+                                       unsigned int    _n)
+{
+    modem_demodulate_soft_block(_q->mod_payload,
+                                _syms,
+                                _n,
+                                _q->payload_sym,
+                                &_q->payload_enc[_q->num_soft_syms * _q->bits_per_symbol]);
+    _q->num_soft_syms += _n;
+}
@@ -60,7 +60,7 @@ qpilotgen qpilotgen_create(unsigned int _payload_len,
     unsigned int i;
 
     // allocate memory for main object
-    qpilotgen q = (qpilotgen) malloc(sizeof(struct qpilotgen_s));
+    qpilotgen q = (qpilotgen) liquid_malloc(sizeof(struct qpilotgen_s));
 
     // set internal properties
     q->payload_len   = _payload_len;
@@ -72,7 +72,7 @@ qpilotgen qpilotgen_create(unsigned int _payload_len,
     q->frame_len  = q->payload_len + q->num_pilots;
 
     // allocate memory for pilots
-    q->pilots = (float complex*) malloc(q->num_pilots*sizeof(float complex));
+    q->pilots = (float complex*) liquid_malloc(q->num_pilots*sizeof(float complex));
 
     // find appropriate sequence size
     unsigned int m = liquid_nextpow2(q->num_pilots);
@@ -111,10 +111,10 @@ qpilotgen qpilotgen_recreate(qpilotgen    _q,
 void qpilotgen_destroy(qpilotgen _q)
 {
     // free arrays
-    free(_q->pilots);
+    liquid_free(_q->pilots);
     
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void qpilotgen_reset(qpilotgen _q)
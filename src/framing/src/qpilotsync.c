@@ -38,6 +38,14 @@
 
 #define DEBUG_QPILOTSYNC 0
 
+// largest number of pilots for which the carrier frequency may be
+// estimated directly in the time domain (see qpilotsync_set_direct())
+#define QPILOTSYNC_DIRECT_MAX_PILOTS (32)
+
+// carrier frequency estimation methods
+void qpilotsync_estimate_fft   (qpilotsync _q);
+void qpilotsync_estimate_direct(qpilotsync _q);
+
 struct qpilotsync_s {
     // properties
     unsigned int    payload_len;    // number of samples in payload
@@ -47,9 +55,10 @@ struct qpilotsync_s {
     float complex * pilots;         // pilot sequence
 
     unsigned int    nfft;           // FFT size
-    float complex * buf_time;       // FFT time buffer
-    float complex * buf_freq;       // FFT freq buffer
-    fftplan         fft;            // transform object
+    float complex * buf_time;       // de-rotated pilots, FFT time buffer
+    float complex * buf_freq;       // FFT freq buffer (NULL if direct)
+    fftplan         fft;            // transform object (NULL if direct)
+    int             direct;         // estimate frequency without transform?
 
     float           dphi_hat;       // carrier frequency offset estimate
     float           phi_hat;        // carrier phase offset estimate
@@ -71,7 +80,7 @@ qpilotsync qpilotsync_create(unsigned int _payload_len,
     unsigned int i;
 
     // allocate memory for main object
-    qpilotsync q = (qpilotsync) malloc(sizeof(struct qpilotsync_s));
+    qpilotsync q = (qpilotsync) liquid_malloc(sizeof(struct qpilotsync_s));
 
     // set internal properties
     q->payload_len   = _payload_len;
@@ -83,7 +92,7 @@ qpilotsync qpilotsync_create(unsigned int _payload_len,
     q->frame_len  = q->payload_len + q->num_pilots;
 
     // allocate memory for pilots
-    q->pilots = (float complex*) malloc(q->num_pilots*sizeof(float complex));
+    q->pilots = (float complex*) liquid_malloc(q->num_pilots*sizeof(float complex));
 
     // find appropriate sequence size
     unsigned int m = liquid_nextpow2(q->num_pilots);
@@ -102,9 +111,10 @@ qpilotsync qpilotsync_create(unsigned int _payload_len,
 
     // compute fft size and create transform objects
     q->nfft = 1 << liquid_nextpow2(q->num_pilots + (q->num_pilots>>1));
-    q->buf_time = (float complex*) malloc(q->nfft*sizeof(float complex));
-    q->buf_freq = (float complex*) malloc(q->nfft*sizeof(float complex));
+    q->buf_time = (float complex*) liquid_malloc(q->nfft*sizeof(float complex));
+    q->buf_freq = (float complex*) liquid_malloc(q->nfft*sizeof(float complex));
     q->fft      = fft_create_plan(q->nfft, q->buf_time, q->buf_freq, LIQUID_FFT_FORWARD, 0);
+    q->direct   = 0;
 
     // reset and return pointer to main object
     qpilotsync_reset(q);
@@ -116,28 +126,42 @@ qpilotsync qpilotsync_recreate(qpilotsync   _q,
                                unsigned int _payload_len,
                                unsigned int _pilot_spacing)
 {
-    // TODO: only re-generate objects as necessary
+    // keep existing object (pilots, buffers, transform) if the
+    // configuration has not changed
+    if (_q != NULL && _q->payload_len   == _payload_len &&
+                      _q->pilot_spacing == _pilot_spacing)
+    {
+        qpilotsync_reset(_q);
+        return _q;
+    }
 
-    // destroy object
-    if (_q != NULL)
+    // destroy object, keeping estimation method
+    int direct = 0;
+    if (_q != NULL) {
+        direct = _q->direct;
         qpilotsync_destroy(_q);
+    }
 
     // create new object
-    return qpilotsync_create(_payload_len, _pilot_spacing);
+    qpilotsync q = qpilotsync_create(_payload_len, _pilot_spacing);
+    if (direct && q->num_pilots <= QPILOTSYNC_DIRECT_MAX_PILOTS)
+        qpilotsync_set_direct(q, 1);
+    return q;
 }
 
 void qpilotsync_destroy(qpilotsync _q)
 {
     // free arrays
-    free(_q->pilots);
-    free(_q->buf_time);
-    free(_q->buf_freq);
+    liquid_free(_q->pilots);
+    liquid_free(_q->buf_time);
+    liquid_free(_q->buf_freq);
 
     // destroy objects
-    fft_destroy_plan(_q->fft);
+    if (_q->fft != NULL)
+        fft_destroy_plan(_q->fft);
     
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void qpilotsync_reset(qpilotsync _q)
@@ -160,7 +184,48 @@ void qpilotsync_print(qpilotsync _q)
     printf("  pilot spacing :   %u\n", _q->pilot_spacing);
     printf("  num pilots    :   %u\n", _q->num_pilots);
     printf("  frame len     :   %u\n", _q->frame_len);
-    printf("  nfft          :   %u\n", _q->nfft);
+    if (_q->direct)
+        printf("  estimation    :   direct\n");
+    else
+        printf("  nfft          :   %u\n", _q->nfft);
+}
+
+// enable/disable direct (time-domain) carrier frequency estimation
+void qpilotsync_set_direct(qpilotsync _q,
+                           int        _direct)
+{
+    if (_direct && _q->num_pilots > QPILOTSYNC_DIRECT_MAX_PILOTS) {
+        fprintf(stderr,"warning: qpilotsync_set_direct(), %u pilots exceeds maximum (%u); ignoring\n",
+                _q->num_pilots, QPILOTSYNC_DIRECT_MAX_PILOTS);
+        return;
+    }
+
+    if (_direct && !_q->direct) {
+        // release transform; pilots still use the front of buf_time
+        fft_destroy_plan(_q->fft);
+        liquid_free(_q->buf_freq);
+        _q->fft      = NULL;
+        _q->buf_freq = NULL;
+    } else if (!_direct && _q->direct) {
+        // restore transform; padding in buf_time is still zero
+        _q->buf_freq = (float complex*) liquid_malloc(_q->nfft*sizeof(float complex));
+        _q->fft      = fft_create_plan(_q->nfft, _q->buf_time, _q->buf_freq, LIQUID_FFT_FORWARD, 0);
+    }
+    _q->direct = _direct ? 1 : 0;
+}
+
+// get memory footprint of object, pilots and transform [bytes]
+unsigned long int qpilotsync_get_memory_usage(qpilotsync _q)
+{
+    if (_q->direct) {
+        return sizeof(struct qpilotsync_s)
+             + _q->num_pilots*sizeof(float complex)
+             + _q->nfft*sizeof(float complex);
+    }
+    return sizeof(struct qpilotsync_s)
+         + _q->num_pilots*sizeof(float complex)
+         + 2*_q->nfft*sizeof(float complex)
+         + fft_get_memory_usage(_q->fft);
 }
 
 // get length of frame in symbols
@@ -195,41 +260,11 @@ void qpilotsync_execute(qpilotsync      _q,
 #endif
     }
 
-    // compute frequency offset by computing transform and finding peak
-    fft_execute(_q->fft);
-    unsigned int i0 = 0;
-    float        y0 = 0;
-    for (i=0; i<_q->nfft; i++) {
-#if DEBUG_QPILOTSYNC
-        printf("X(%3u) = %12.8f + 1i*%12.8f; %% %12.8f\n",
-                i+1, crealf(_q->buf_freq[i]), cimagf(_q->buf_freq[i]), cabsf(_q->buf_freq[i]));
-#endif
-        if (i==0 || cabsf(_q->buf_freq[i]) > y0) {
-            i0 = i;
-            y0 = cabsf(_q->buf_freq[i]);
-        }
-    }
-
-    // interpolate and recover frequency
-    unsigned int ineg = (i0 + _q->nfft - 1) % _q->nfft;
-    unsigned int ipos = (i0 +            1) % _q->nfft;
-    float        ypos = cabsf(_q->buf_freq[ipos]);
-    float        yneg = cabsf(_q->buf_freq[ineg]);
-    float        a    =  0.5f*(ypos + yneg) - y0;
-    float        b    =  0.5f*(ypos - yneg);
-    //float        c    =  y0;
-    float        idx  = -b / (2.0f*a); //-0.5f*(ypos - yneg) / (ypos + yneg - 2*y0);
-    float index = (float)i0 + idx;
-    _q->dphi_hat = (i0 > _q->nfft/2 ? index-(float)_q->nfft : index) * 2*M_PI / (float)(_q->nfft * _q->pilot_spacing);
-#if DEBUG_QPILOTSYNC
-    printf("X[%3u] = %12.8f <%12.8f>\n", ineg, yneg, cargf(_q->buf_freq[ineg]));
-    printf("X[%3u] = %12.8f <%12.8f>\n", i0,   y0,   cargf(_q->buf_freq[i0]));
-    printf("X[%3u] = %12.8f <%12.8f>\n", ipos, ypos, cargf(_q->buf_freq[ipos]));
-    printf("yneg  = %12.8f;\n", yneg);
-    printf("ypos  = %12.8f;\n", ypos);
-    printf("y0    = %12.8f;\n", y0);
-    printf("interpolated peak at %12.8f (%u + %12.8f)\n", index, i0, idx);
-#endif
+    // estimate carrier frequency offset
+    if (_q->direct)
+        qpilotsync_estimate_direct(_q);
+    else
+        qpilotsync_estimate_fft(_q);
 
     // estimate carrier phase offset
 #if 0
@@ -248,8 +283,12 @@ void qpilotsync_execute(qpilotsync      _q,
     // NOTE: this is possibly more accurate than the above method but might also
     //       be more computationally complex
     float complex metric = 0;
-    for (i=0; i<_q->num_pilots; i++)
-        metric += _q->buf_time[i] * cexpf(-_Complex_I*_q->dphi_hat*i*(float)(_q->pilot_spacing));
+    float complex dr = cexpf(-_Complex_I*_q->dphi_hat*(float)(_q->pilot_spacing));
+    float complex r  = 1.0f;
+    for (i=0; i<_q->num_pilots; i++) {
+        metric += _q->buf_time[i] * r;
+        r *= dr;
+    }
     //printf("metric : %12.8f <%12.8f>\n", cabsf(metric), cargf(metric));
     _q->phi_hat = cargf(metric);
     _q->g_hat   = cabsf(metric) / (float)(_q->num_pilots);
@@ -265,12 +304,17 @@ void qpilotsync_execute(qpilotsync      _q,
     // frequency correction
     float g = 1.0f / _q->g_hat;
 
-    // recover frame symbols
+    // recover frame symbols; the correction phasor is computed exactly
+    // at each pilot and advanced by a fixed rotation in between
+    dr = cexpf(-_Complex_I*_q->dphi_hat);
     for (i=0; i<_q->frame_len; i++) {
-        if ( (i % _q->pilot_spacing)==0 )
+        if ( (i % _q->pilot_spacing)==0 ) {
+            r = g * cexpf(-_Complex_I*(_q->dphi_hat*i + _q->phi_hat));
             p++;
-        else
-            _payload[n++] = g * _frame[i] * cexpf(-_Complex_I*(_q->dphi_hat*i + _q->phi_hat));
+        } else {
+            _payload[n++] = _frame[i] * r;
+        }
+        r *= dr;
     }
 #if DEBUG_QPILOTSYNC
     printf("n = %u (expected %u)\n", n, _q->payload_len);
@@ -296,4 +340,80 @@ float qpilotsync_get_gain(qpilotsync _q)
     return _q->g_hat;
 }
 
+// 
+// internal methods
+//
 
+// estimate carrier frequency offset by computing transform of the
+// de-rotated pilots and interpolating its peak
+void qpilotsync_estimate_fft(qpilotsync _q)
+{
+    unsigned int i;
+
+    // compute frequency offset by computing transform and finding peak
+    fft_execute(_q->fft);
+    unsigned int i0 = 0;
+    float        y0 = 0;
+    for (i=0; i<_q->nfft; i++) {
+#if DEBUG_QPILOTSYNC
+        printf("X(%3u) = %12.8f + 1i*%12.8f; %% %12.8f\n",
+                i+1, crealf(_q->buf_freq[i]), cimagf(_q->buf_freq[i]), cabsf(_q->buf_freq[i]));
+#endif
+        if (i==0 || cabsf(_q->buf_freq[i]) > y0) {
+            i0 = i;
+            y0 = cabsf(_q->buf_freq[i]);
+        }
+    }
+
+    // interpolate and recover frequency
+    unsigned int ineg = (i0 + _q->nfft - 1) % _q->nfft;
+    unsigned int ipos = (i0 +            1) % _q->nfft;
+    float        ypos = cabsf(_q->buf_freq[ipos]);
+    float        yneg = cabsf(_q->buf_freq[ineg]);
+    float        a    =  0.5f*(ypos + yneg) - y0;
+    float        b    =  0.5f*(ypos - yneg);
+    //float        c    =  y0;
+    float        idx  = -b / (2.0f*a); //-0.5f*(ypos - yneg) / (ypos + yneg - 2*y0);
+    float index = (float)i0 + idx;
+    _q->dphi_hat = (i0 > _q->nfft/2 ? index-(float)_q->nfft : index) * 2*M_PI / (float)(_q->nfft * _q->pilot_spacing);
+#if DEBUG_QPILOTSYNC
+    printf("X[%3u] = %12.8f <%12.8f>\n", ineg, yneg, cargf(_q->buf_freq[ineg]));
+    printf("X[%3u] = %12.8f <%12.8f>\n", i0,   y0,   cargf(_q->buf_freq[i0]));
+    printf("X[%3u] = %12.8f <%12.8f>\n", ipos, ypos, cargf(_q->buf_freq[ipos]));
+    printf("yneg  = %12.8f;\n", yneg);
+    printf("ypos  = %12.8f;\n", ypos);
+    printf("y0    = %12.8f;\n", y0);
+    printf("interpolated peak at %12.8f (%u + %12.8f)\n", index, i0, idx);
+#endif
+}
+
+// estimate carrier frequency offset directly from the de-rotated pilots
+// (Mengali & Morelli): least-squares weighted sum of the phase
+// increments between successive autocorrelation lags 0..n/2
+void qpilotsync_estimate_direct(qpilotsync _q)
+{
+    unsigned int i, m;
+    unsigned int n = _q->num_pilots;
+    float complex * b = _q->buf_time;
+
+    // phase slope from autocorrelation lags 1..k
+    unsigned int k = n/2 > 0 ? n/2 : 1;
+    float complex r_prev = 0.0f;
+    for (i=0; i<n; i++)
+        r_prev += b[i] * conjf(b[i]);
+    float w = 0.0f;
+    float dk = (float)k;
+    float dn = (float)n;
+    float scale = 3.0f / (dk*(4.0f*dk*dk - 6.0f*dk*dn + 3.0f*dn*dn - 1.0f));
+    for (m=1; m<=k && m<n; m++) {
+        float complex r = 0.0f;
+        for (i=m; i<n; i++)
+            r += b[i] * conjf(b[i-m]);
+        r /= (float)(n-m);
+        float wm = scale*((dn-m)*(dn-m+1.0f) - dk*(dn-dk));
+        w += wm * cargf(r * conjf(r_prev));
+        r_prev = r;
+    }
+
+    _q->dphi_hat = w / (float)(_q->pilot_spacing);
+}
@@ -40,6 +40,7 @@ struct SYMSTREAM(_s) {
     FIRINTERP()     interp;         // interpolator
     TO *            buf;            // output buffer
     unsigned int    buf_index;      // output buffer sample index
+    uint64_t        rng;            // symbol generator state
 };
 
 // create symstream object using default parameters
@@ -80,7 +81,7 @@ SYMSTREAM() SYMSTREAM(_create_linear)(int          _ftype,
     }
 
     // allocate memory for main object
-    SYMSTREAM() q = (SYMSTREAM()) malloc( sizeof(struct SYMSTREAM(_s)) );
+    SYMSTREAM() q = (SYMSTREAM()) liquid_malloc( sizeof(struct SYMSTREAM(_s)) );
 
     // set input parameters
     q->filter_type = _ftype;
@@ -91,12 +92,13 @@ SYMSTREAM() SYMSTREAM(_create_linear)(int          _ftype,
 
     // modulator
     q->mod = MODEM(_create)(q->mod_scheme);
+    liquid_rand_seed_object(&q->rng);
 
     // interpolator
     q->interp = FIRINTERP(_create_prototype)(q->filter_type, q->k, q->m, q->beta, 0);
 
     // sample buffer
-    q->buf = (TO*) malloc(q->k*sizeof(TO));
+    q->buf = (TO*) liquid_malloc(q->k*sizeof(TO));
 
     // reset and return main object
     SYMSTREAM(_reset)(q);
@@ -110,10 +112,10 @@ void SYMSTREAM(_destroy)(SYMSTREAM() _q)
     MODEM    (_destroy)(_q->mod);
     FIRINTERP(_destroy)(_q->interp);
 
-    free(_q->buf);
+    liquid_free(_q->buf);
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print symstream object's parameters
@@ -135,7 +137,7 @@ void SYMSTREAM(_reset)(SYMSTREAM() _q)
 void SYMSTREAM(_fill_buffer)(SYMSTREAM() _q)
 {
     // generate random symbol
-    unsigned int sym = MODEM(_gen_rand_sym)(_q->mod);
+    unsigned int sym = (unsigned int)(randu64_r(&_q->rng) % (1u << MODEM(_get_bps)(_q->mod)));
 
     // modulate
     TO v;
@@ -34,6 +34,14 @@
 #define DEBUG_SYMTRACK_FILENAME  "symtrack_internal_debug.m"
 #define DEBUG_BUFFER_LEN        (1024)
 
+// input samples per phase-locked loop update in execute_block()
+#define SYMTRACK_BLOCK_LEN      (16)
+
+// input samples per pass of execute_block(): each stage runs over the
+// whole pass before the next, split into sub-blocks of
+// SYMTRACK_BLOCK_LEN only where the carrier loop feeds back
+#define SYMTRACK_STAGE_LEN      (16*SYMTRACK_BLOCK_LEN)
+
 //
 // forward declaration of internal methods
 //
@@ -50,11 +58,13 @@ struct SYMTRACK(_s) {
     // automatic gain control
     AGC()           agc;                // agc object
     float           agc_bandwidth;      // agc bandwidth
+    TI              agc_buf[SYMTRACK_STAGE_LEN]; // agc output buffer
 
     // symbol timing recovery
     SYMSYNC()       symsync;            // symbol timing recovery object
     float           symsync_bandwidth;  // symsync loop bandwidth
-    TO              symsync_buf[8];     // symsync output buffer
+    TO              symsync_buf[8*SYMTRACK_STAGE_LEN]; // symsync output buffer
+    unsigned int    symsync_len[SYMTRACK_STAGE_LEN/SYMTRACK_BLOCK_LEN]; // outputs per sub-block
     unsigned int    symsync_index;      // symsync output sample index
 
     // equalizer/decimator
@@ -98,7 +108,7 @@ SYMTRACK() SYMTRACK(_create)(int          _ftype,
     }
 
     // allocate memory for main object
-    SYMTRACK() q = (SYMTRACK()) malloc( sizeof(struct SYMTRACK(_s)) );
+    SYMTRACK() q = (SYMTRACK()) liquid_malloc( sizeof(struct SYMTRACK(_s)) );
 
     // set input parameters
     q->filter_type = _ftype;
@@ -107,8 +117,9 @@ SYMTRACK() SYMTRACK(_create)(int          _ftype,
     q->beta        = _beta;
     q->mod_scheme  = _ms == LIQUID_MODEM_UNKNOWN ? LIQUID_MODEM_BPSK : _ms;
 
-    // create automatic gain control
+    // create automatic gain control, updating gain once per block
     q->agc = AGC(_create)();
+    AGC(_set_block_len)(q->agc, SYMTRACK_BLOCK_LEN);
     
     // create symbol synchronizer (output rate: 2 samples per symbol)
     if (q->filter_type == LIQUID_FIRFILT_UNKNOWN)
@@ -157,7 +168,7 @@ void SYMTRACK(_destroy)(SYMTRACK() _q)
     MODEM  (_destroy)(_q->demod);
 
     // free main object
-    free(_q);
+    liquid_free(_q);
 }
 
 // print symtrack object's parameters
@@ -231,76 +242,126 @@ void SYMTRACK(_adjust_phase)(SYMTRACK() _q,
     NCO(_adjust_phase)(_q->nco, _dphi);
 }
 
-// execute synchronizer on single input sample
+// run pass of input samples through synchronizer, one stage at a
+// time: the automatic gain control and symbol synchronizer run over
+// the entire pass; the carrier mixer, equalizer and demodulator then
+// run over each sub-block of SYMTRACK_BLOCK_LEN input samples in turn,
+// updating the phase-locked loop once per sub-block with the average
+// phase error
 //  _q      : synchronizer object
-//  _x      : input data sample
+//  _x      : input data array [size: _nx x 1, _nx <= SYMTRACK_STAGE_LEN]
+//  _nx     : number of input samples
 //  _y      : output data array
 //  _ny     : number of samples written to output buffer
-void SYMTRACK(_execute)(SYMTRACK()     _q,
-                        TI             _x,
-                        TO *           _y,
-                        unsigned int * _ny)
+static void SYMTRACK(_execute_chunk)(SYMTRACK()     _q,
+                                     TI *           _x,
+                                     unsigned int   _nx,
+                                     TO *           _y,
+                                     unsigned int * _ny)
 {
-    TO v;   // output sample
     unsigned int i;
+    unsigned int j;
     unsigned int num_outputs = 0;
 
-    // run sample through automatic gain control
-    AGC(_execute)(_q->agc, _x, &v);
-
-    // symbol synchronizer
-    unsigned int nw = 0;
-    SYMSYNC(_execute)(_q->symsync, &v, 1, _q->symsync_buf, &nw);
-
-    // process each output sample
-    for (i=0; i<nw; i++) {
-        // update phase-locked loop
-        NCO(_step)(_q->nco);
-        nco_crcf_mix_down(_q->nco, _q->symsync_buf[i], &v);
-
-        // equalizer/decimator
-        EQLMS(_push)(_q->eq, v);
-
-        // decimate result, noting that symsync outputs at exactly 2 samples/symbol
-        _q->symsync_index++;
-        if ( !(_q->symsync_index % 2) )
-            continue;
-
-        // increment number of symbols received
-        _q->num_syms_rx++;
-
-        // compute equalizer output
-        TO d_hat;
-        EQLMS(_execute)(_q->eq, &d_hat);
-
-        // demodulate result, apply phase correction
-        unsigned int sym_out;
-        MODEM(_demodulate)(_q->demod, d_hat, &sym_out);
-        float phase_error = MODEM(_get_demodulator_phase_error)(_q->demod);
+    // automatic gain control (one gain update per sub-block)
+    AGC(_execute_block)(_q->agc, _x, _nx, _q->agc_buf);
 
-        // update equalizer independent of the signal: estimate error
-        // assuming constant modulus signal
-        // TODO: use decision-directed feedback when modulation scheme is known
-        // TODO: check lock conditions of previous object to determine when to run equalizer
-        if (_q->num_syms_rx > 200)
-            EQLMS(_step)(_q->eq, d_hat/cabsf(d_hat), d_hat);
-
-        // update pll
-        NCO(_pll_step)(_q->nco, phase_error);
+    // symbol synchronizer, keeping sub-block boundaries in its output
+    unsigned int num_blocks = 0;
+    unsigned int nb = 0;
+    for (i=0; i<_nx; i+=SYMTRACK_BLOCK_LEN) {
+        unsigned int n = _nx - i < SYMTRACK_BLOCK_LEN ? _nx - i : SYMTRACK_BLOCK_LEN;
+        SYMSYNC(_execute)(_q->symsync, &_q->agc_buf[i], n, &_q->symsync_buf[nb], &_q->symsync_len[num_blocks]);
+        nb += _q->symsync_len[num_blocks++];
+    }
 
-        // save result to output
-        _y[num_outputs++] = d_hat;
+    // carrier recovery, equalizer and demodulator per sub-block
+    TO * v = _q->symsync_buf;
+    for (j=0; j<num_blocks; j++) {
+        unsigned int n = _q->symsync_len[j];
+
+        // mix down with current carrier estimate
+        NCO(_mix_block_down)(_q->nco, v, v, n);
+
+        // equalizer/decimator; symsync outputs at exactly 2 samples/symbol
+        unsigned int num_syms = 0;
+        for (i=0; i<n; i++) {
+            // once blind adaptation runs on every symbol, equalize and
+            // train all whole symbols remaining in the block at once
+            if (_q->num_syms_rx >= 200 && (_q->symsync_index % 2) && i+1 < n) {
+                unsigned int ns = (n - i) / 2;
+                EQLMS(_train_block)(_q->eq, 2, &v[i], NULL, ns, &_y[num_outputs + num_syms]);
+                _q->symsync_index += 2*ns;
+                _q->num_syms_rx   += ns;
+                num_syms          += ns;
+                i                 += 2*ns - 1;
+                continue;
+            }
+
+            EQLMS(_push)(_q->eq, v[i]);
+
+            _q->symsync_index++;
+            if ( !(_q->symsync_index % 2) )
+                continue;
+
+            // increment number of symbols received
+            _q->num_syms_rx++;
+
+            // compute equalizer output
+            TO d_hat;
+            EQLMS(_execute)(_q->eq, &d_hat);
+
+            // update equalizer independent of the signal: estimate error
+            // assuming constant modulus signal
+            // TODO: use decision-directed feedback when modulation scheme is known
+            // TODO: check lock conditions of previous object to determine when to run equalizer
+            if (_q->num_syms_rx > 200)
+                EQLMS(_step)(_q->eq, d_hat/cabsf(d_hat), d_hat);
+
+            // save result to output
+            _y[num_outputs + num_syms++] = d_hat;
+        }
+
+        // demodulate symbols, accumulating phase error
+        float phase_error = 0.0f;
+        for (i=0; i<num_syms; i++) {
+            unsigned int sym_out;
+            MODEM(_demodulate)(_q->demod, _y[num_outputs + i], &sym_out);
+            phase_error += MODEM(_get_demodulator_phase_error)(_q->demod);
+        }
+
+        // update pll once for the sub-block
+        if (num_syms > 0)
+            NCO(_pll_step_block)(_q->nco, phase_error / (float)num_syms, num_syms);
+
+        num_outputs += num_syms;
+        v += n;
     }
 
 #if DEBUG_SYMTRACK
-    printf("symsync wrote %u samples, %u outputs\n", nw, num_outputs);
+    printf("symsync wrote %u samples, %u outputs\n", nb, num_outputs);
 #endif
 
     //
     *_ny = num_outputs;
 }
 
-// execute synchronizer on input data array
+// execute synchronizer on single input sample
+//  _q      : synchronizer object
+//  _x      : input data sample
+//  _y      : output data array
+//  _ny     : number of samples written to output buffer
+void SYMTRACK(_execute)(SYMTRACK()     _q,
+                        TI             _x,
+                        TO *           _y,
+                        unsigned int * _ny)
+{
+    SYMTRACK(_execute_chunk)(_q, &_x, 1, _y, _ny);
+}
+
+// execute synchronizer on input data array, updating the
+// phase-locked loop once per SYMTRACK_BLOCK_LEN input samples and
+// running each stage over SYMTRACK_STAGE_LEN input samples at a time
 //  _q      : synchronizer object
 //  _x      : input data array
 //  _nx     : number of input samples
@@ -317,9 +378,10 @@ void SYMTRACK(_execute_block)(SYMTRACK()     _q,
     unsigned int num_written = 0;
 
     //
-    for (i=0; i<_nx; i++) {
+    for (i=0; i<_nx; i+=SYMTRACK_STAGE_LEN) {
+        unsigned int n  = _nx - i < SYMTRACK_STAGE_LEN ? _nx - i : SYMTRACK_STAGE_LEN;
         unsigned int nw = 0;
-        SYMTRACK(_execute)(_q, _x[i], &_y[num_written], &nw);
+        SYMTRACK(_execute_chunk)(_q, &_x[i], n, &_y[num_written], &nw);
 
         num_written += nw;
     }
@@ -327,4 +389,3 @@ void SYMTRACK(_execute_block)(SYMTRACK()     _q,
     //
     *_ny = num_written;
 }
-
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// built-in table: robust scheme at low SNR, uncoded QAM256 at high
+// SNR, and rate never decreasing as the SNR rises
+void autotest_amcselect_default()
+{
+    amcselect q = amcselect_create();
+    amcselect_set_alpha(q, 1.0f);
+    amcselect_set_hysteresis(q, 0.0f);
+
+    int ms, fec0, fec1;
+    amcselect_get_scheme(q, &ms, &fec0, &fec1);
+    CONTEND_EQUALITY(ms,   LIQUID_MODEM_BPSK);
+    CONTEND_EQUALITY(fec0, LIQUID_FEC_CONV_V27);
+    CONTEND_EQUALITY(fec1, LIQUID_FEC_NONE);
+
+    float snr;
+    float goodput = 0.0f;
+    for (snr=-10.0f; snr<=40.0f; snr+=0.5f) {
+        amcselect_push_snr(q, snr);
+        CONTEND_GREATER_THAN(amcselect_get_goodput(q), goodput - 1e-6f);
+        goodput = amcselect_get_goodput(q);
+    }
+    amcselect_get_scheme(q, &ms, &fec0, &fec1);
+    CONTEND_EQUALITY(ms,   LIQUID_MODEM_QAM256);
+    CONTEND_EQUALITY(fec0, LIQUID_FEC_NONE);
+    CONTEND_DELTA(goodput, 8.0f, 1e-6f);
+
+    // frame statistics: snr is -evm; evm of zero is not a measurement
+    framesyncstats_s stats;
+    framesyncstats_init_default(&stats);
+    stats.evm = 0.0f;
+    amcselect_push(q, stats);
+    CONTEND_DELTA(amcselect_get_snr(q), 40.0f, 1e-6f);
+    stats.evm = -6.0f;
+    amcselect_push(q, stats);
+    CONTEND_DELTA(amcselect_get_snr(q), 6.0f, 1e-6f);
+    amcselect_get_scheme(q, &ms, &fec0, &fec1);
+    CONTEND_EQUALITY(ms,   LIQUID_MODEM_QPSK);
+    CONTEND_EQUALITY(fec0, LIQUID_FEC_CONV_V27);
+
+    amcselect_destroy(q);
+}
+
+// switching up requires the hysteresis margin, switching down does not
+void autotest_amcselect_hysteresis()
+{
+    // scheme 1 (rate 2) beats scheme 0 (rate 1) above 5 dB
+    int   ms[2]    = {LIQUID_MODEM_BPSK, LIQUID_MODEM_QPSK};
+    float per[2*11] = {
+        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+        1,   1,   1,   1,   1,   0.5, 0,   0,   0,   0,   0};
+    amcselect q = amcselect_create_table(ms, NULL, NULL, 2, per, 11, 0.0f, 1.0f);
+    amcselect_set_alpha(q, 1.0f);
+    amcselect_set_hysteresis(q, 1.0f);
+    CONTEND_EQUALITY(amcselect_get_index(q), 0);
+    CONTEND_DELTA(amcselect_get_per(q, 1, 4.5f), 0.75f, 1e-6f);
+    CONTEND_DELTA(amcselect_get_per(q, 1, 20.0f), 0.0f, 1e-6f);
+
+    amcselect_push_snr(q, 5.5f);    // better, but not by the margin
+    CONTEND_EQUALITY(amcselect_get_index(q), 0);
+    amcselect_push_snr(q, 6.5f);    // better by the margin
+    CONTEND_EQUALITY(amcselect_get_index(q), 1);
+    amcselect_push_snr(q, 5.5f);    // still better: stay
+    CONTEND_EQUALITY(amcselect_get_index(q), 1);
+    amcselect_push_snr(q, 4.5f);    // worse: switch down right away
+    CONTEND_EQUALITY(amcselect_get_index(q), 0);
+
+    // averaging
+    amcselect_reset(q);
+    amcselect_set_alpha(q, 0.5f);
+    amcselect_push_snr(q, 10.0f);
+    amcselect_push_snr(q, 2.0f);
+    CONTEND_DELTA(amcselect_get_snr(q), 6.0f, 1e-6f);
+
+    amcselect_destroy(q);
+}
+
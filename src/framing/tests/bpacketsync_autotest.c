@@ -95,3 +95,59 @@ void autotest_bpacketsync()
     bpacketsync_destroy(ps);
 }
 
+// packets at arbitrary bit offsets within random bytes: the byte-wise
+// p/n search must find exactly what the bit-serial path finds
+void autotest_bpacketsync_unaligned()
+{
+    unsigned int num_packets = 20;
+    unsigned int dec_msg_len = 32;
+    unsigned int gap_len     = 13;  // random bytes between packets
+
+    bpacketgen pg = bpacketgen_create(0, dec_msg_len, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+    unsigned int enc_msg_len = bpacketgen_get_packet_len(pg);
+
+    // assemble bit stream: gap, packet shifted by 0..7 bits, gap, ...
+    unsigned int num_bytes = num_packets*(enc_msg_len + gap_len + 1) + gap_len;
+    unsigned char stream[num_bytes];
+    unsigned char msg_org[dec_msg_len];
+    unsigned char msg_enc[enc_msg_len];
+    unsigned int i, n, k=0;
+    for (i=0; i<num_bytes; i++)
+        stream[i] = rand() & 0xff;
+    for (n=0; n<num_packets; n++) {
+        for (i=0; i<dec_msg_len; i++)
+            msg_org[i] = rand() & 0xff;
+        bpacketgen_encode(pg, msg_org, msg_enc);
+
+        // write packet starting at bit (8*(k+gap_len) + n%8)
+        unsigned int b0 = 8*(k + gap_len) + (n % 8);
+        for (i=0; i<8*enc_msg_len; i++) {
+            unsigned int bit = (msg_enc[i/8] >> (7 - i%8)) & 1;
+            unsigned int b   = b0 + i;
+            stream[b/8] = (stream[b/8] & ~(0x80 >> (b%8))) | (bit << (7 - b%8));
+        }
+        k += enc_msg_len + gap_len + 1;
+    }
+
+    // byte-wise
+    unsigned int num_found_byte = 0;
+    bpacketsync q0 = bpacketsync_create(0, bpacketsync_autotest_callback, (void*)&num_found_byte);
+    bpacketsync_execute(q0, stream, num_bytes);
+
+    // bit-serial
+    unsigned int num_found_bit = 0;
+    bpacketsync q1 = bpacketsync_create(0, bpacketsync_autotest_callback, (void*)&num_found_bit);
+    for (i=0; i<8*num_bytes; i++)
+        bpacketsync_execute_bit(q1, (stream[i/8] >> (7 - i%8)) & 1);
+
+    if (liquid_autotest_verbose)
+        printf("found %u (byte) / %u (bit) / %u packets\n", num_found_byte, num_found_bit, num_packets);
+
+    CONTEND_EQUALITY( num_found_byte, num_packets );
+    CONTEND_EQUALITY( num_found_bit,  num_packets );
+
+    bpacketgen_destroy(pg);
+    bpacketsync_destroy(q0);
+    bpacketsync_destroy(q1);
+}
+
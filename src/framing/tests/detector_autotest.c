@@ -172,3 +172,60 @@ void detector_cccf_runtest(unsigned int _n,
 }
 
 
+
+//
+// AUTOTEST : energy gate bypasses correlation on noise and still
+//            detects sequence
+//
+void autotest_detector_cccf_gate()
+{
+    unsigned int n        = 128;    // sequence length
+    unsigned int num_idle = 8192;   // idle (noise-only) samples
+    float        nstd     = 0.01f;  // noise standard deviation (-40 dB)
+    float        gamma    = 0.1f;   // signal level (SNR: 20 dB)
+    unsigned int i;
+
+    // generate synchronization sequence
+    float complex s[n];
+    msequence ms = msequence_create_default(7);
+    for (i=0; i<n; i++)
+        s[i] = msequence_advance(ms) ? 1.0f : -1.0f;
+    msequence_destroy(ms);
+
+    // create detector with gate enabled
+    detector_cccf q = detector_cccf_create(s, n, 0.5f, 0.02f);
+    detector_cccf_gate_enable(q);
+    CONTEND_EQUALITY( detector_cccf_gate_is_enabled(q), 1 );
+
+    // run idle period; no sequence should be detected
+    float tau_hat, dphi_hat, gamma_hat;
+    int false_positive = 0;
+    for (i=0; i<num_idle; i++) {
+        float complex x = nstd*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+        if (detector_cccf_correlate(q, x, &tau_hat, &dphi_hat, &gamma_hat))
+            false_positive = 1;
+    }
+    unsigned int num_skipped = detector_cccf_gate_get_num_skipped(q);
+    float        noise_floor = detector_cccf_gate_get_noise_floor(q);
+
+    // push sequence followed by noise
+    int detected = 0;
+    for (i=0; i<2*n && !detected; i++) {
+        float complex x = (i < n ? gamma*s[i] : 0.0f) +
+                          nstd*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+        detected = detector_cccf_correlate(q, x, &tau_hat, &dphi_hat, &gamma_hat);
+    }
+
+    if (liquid_autotest_verbose) {
+        detector_cccf_print(q);
+        printf("  skipped %u / %u idle samples, noise floor %.2f dB\n",
+                num_skipped, num_idle, noise_floor);
+    }
+
+    CONTEND_EQUALITY( false_positive, 0 );
+    CONTEND_EQUALITY( detected, 1 );
+    CONTEND_GREATER_THAN( num_skipped, 0.9f*num_idle );
+    CONTEND_DELTA( noise_floor, -40.0f, 1.0f );
+
+    detector_cccf_destroy(q);
+}
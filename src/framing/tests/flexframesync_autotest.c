@@ -89,3 +89,100 @@ void autotest_flexframesync()
     flexframesync_destroy(fs);
 }
 
+
+//
+// AUTOTEST : memory footprint, with and without shared state
+//
+void autotest_flexframesync_memory_usage()
+{
+    flexframesync fs0 = flexframesync_create(NULL,NULL);
+    unsigned long int n0 = flexframesync_get_memory_usage(fs0);
+
+    // sharing the detector template and matched filter divides their
+    // memory between both objects
+    flexframesync fs1 = flexframesync_create_shared(fs0,NULL,NULL);
+    unsigned long int n0_shared = flexframesync_get_memory_usage(fs0);
+    unsigned long int n1_shared = flexframesync_get_memory_usage(fs1);
+    if (liquid_autotest_verbose) {
+        printf("flexframesync memory usage: %lu bytes (independent), %lu + %lu bytes (shared)\n",
+                n0, n0_shared, n1_shared);
+    }
+    CONTEND_LESS_THAN( n0_shared, n0 );
+    CONTEND_EQUALITY ( n0_shared, n1_shared );
+    CONTEND_LESS_THAN( n0_shared + n1_shared, 2*n0 );
+
+    // destroying the shared object restores the original footprint
+    flexframesync_destroy(fs1);
+    CONTEND_EQUALITY( flexframesync_get_memory_usage(fs0), n0 );
+
+    flexframesync_destroy(fs0);
+}
+
+// count valid headers delivered without payload, checking user data
+static int flexframesync_autotest_header_callback(unsigned char *  _header,
+                                                  int              _header_valid,
+                                                  unsigned char *  _payload,
+                                                  unsigned int     _payload_len,
+                                                  int              _payload_valid,
+                                                  framesyncstats_s _stats,
+                                                  void *           _userdata)
+{
+    unsigned int * num_headers = (unsigned int*) _userdata;
+    if (_header_valid && _payload == NULL && _payload_len == 0 && !_payload_valid &&
+        _header[0] == *num_headers && _stats.mod_scheme == LIQUID_MODEM_QAM16)
+    {
+        (*num_headers)++;
+    }
+    return 0;
+}
+
+//
+// AUTOTEST : header-only mode recovers back-to-back frame headers
+//
+void autotest_flexframesync_header_only()
+{
+    unsigned int num_frames  = 4;
+    unsigned int payload_len = 200;
+    unsigned int i, n;
+
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme = LIQUID_MODEM_QAM16;
+    fgprops.fec0       = LIQUID_FEC_HAMMING74;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    unsigned int num_headers = 0;
+    flexframesync fs = flexframesync_create(flexframesync_autotest_header_callback, &num_headers);
+    flexframesync_set_header_only(fs, 1);
+    CONTEND_EQUALITY(flexframesync_get_header_only(fs), 1);
+
+    unsigned char header[14] = {0};
+    unsigned char payload[payload_len];
+    float complex buf[64];
+    for (n=0; n<num_frames; n++) {
+        header[0] = n;
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        flexframegen_assemble(fg, header, payload, payload_len);
+
+        // frame, followed by a short gap
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = flexframegen_write_samples(fg, buf, 64);
+            flexframesync_execute(fs, buf, 64);
+        }
+        for (i=0; i<64; i++)
+            buf[i] = 0.0f;
+        flexframesync_execute(fs, buf, 64);
+    }
+
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    if (liquid_autotest_verbose)
+        printf("flexframesync header-only: %u / %u headers\n", num_headers, num_frames);
+    CONTEND_EQUALITY(num_headers,               num_frames);
+    CONTEND_EQUALITY(stats.num_headers_valid,   num_frames);
+    CONTEND_EQUALITY(stats.num_payloads_valid,  0);
+
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
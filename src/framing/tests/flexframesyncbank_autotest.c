@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// per-stream record of received frames
+struct flexframesyncbank_autotest_s {
+    unsigned int num_valid;     // number of valid payloads
+    unsigned int stream;        // stream index (from header)
+    int          mismatch;      // header did not match stream?
+};
+
+static int flexframesyncbank_autotest_callback(unsigned char *  _header,
+                                               int              _header_valid,
+                                               unsigned char *  _payload,
+                                               unsigned int     _payload_len,
+                                               int              _payload_valid,
+                                               framesyncstats_s _stats,
+                                               void *           _userdata)
+{
+    struct flexframesyncbank_autotest_s * r = (struct flexframesyncbank_autotest_s*) _userdata;
+    if (!_header_valid || !_payload_valid)
+        return 0;
+    r->num_valid++;
+    if (_header[0] != r->stream || _payload_len != 100 + 20*r->stream)
+        r->mismatch = 1;
+    return 0;
+}
+
+// helper function: generate one frame per stream at staggered offsets
+// and run the streams through a bank
+//  _num_streams    :   number of streams
+//  _num_threads    :   number of threads
+void flexframesyncbank_autotest_run(unsigned int _num_streams,
+                                    unsigned int _num_threads)
+{
+    unsigned int i, j;
+    unsigned int num_samples = 12000;
+    unsigned int block_len   = 256;
+
+    // recorders, indexed by stream
+    struct flexframesyncbank_autotest_s r[_num_streams];
+    void * userdata[_num_streams];
+    for (i=0; i<_num_streams; i++) {
+        r[i].num_valid = 0;
+        r[i].stream    = i;
+        r[i].mismatch  = 0;
+        userdata[i]    = &r[i];
+    }
+
+    // generate streams: noise with one frame each, at staggered offsets
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.check = LIQUID_CRC_32;
+    flexframegen fg = flexframegen_create(&fgprops);
+    float complex * x[_num_streams];
+    for (i=0; i<_num_streams; i++) {
+        x[i] = (float complex*) malloc(num_samples*sizeof(float complex));
+        for (j=0; j<num_samples; j++)
+            x[i][j] = 0.01f*(randnf() + _Complex_I*randnf());
+
+        unsigned char header[14] = {0};
+        unsigned char payload[200];
+        unsigned int payload_len = 100 + 20*i;
+        header[0] = i;
+        for (j=0; j<payload_len; j++)
+            payload[j] = rand() & 0xff;
+        flexframegen_assemble(fg, header, payload, payload_len);
+        unsigned int frame_len = flexframegen_getframelen(fg);
+        unsigned int offset = 300 + 700*i;
+        CONTEND_LESS_THAN( offset + frame_len, num_samples );
+        float complex buf[frame_len];
+        flexframegen_write_samples(fg, buf, frame_len);
+        for (j=0; j<frame_len; j++)
+            x[i][offset+j] += buf[j];
+    }
+    flexframegen_destroy(fg);
+
+    // run through bank in blocks
+    flexframesyncbank q = flexframesyncbank_create(_num_streams, _num_threads,
+                                                   flexframesyncbank_autotest_callback,
+                                                   userdata);
+    CONTEND_EQUALITY( flexframesyncbank_get_num_streams(q), _num_streams );
+    float complex * p[_num_streams];
+    for (j=0; j+block_len<=num_samples; j+=block_len) {
+        for (i=0; i<_num_streams; i++)
+            p[i] = x[i] + j;
+        flexframesyncbank_execute(q, p, block_len);
+    }
+
+    // each stream received exactly its own frame
+    for (i=0; i<_num_streams; i++) {
+        CONTEND_EQUALITY( r[i].num_valid, 1 );
+        CONTEND_EQUALITY( r[i].mismatch,  0 );
+        framedatastats_s stats = flexframesync_get_framedatastats(flexframesyncbank_get_stream(q,i));
+        CONTEND_EQUALITY( stats.num_payloads_valid, 1 );
+        free(x[i]);
+    }
+
+    if (liquid_autotest_verbose)
+        flexframesyncbank_print(q);
+    flexframesyncbank_destroy(q);
+}
+
+void autotest_flexframesyncbank_s1_t1() { flexframesyncbank_autotest_run(1, 1); }
+void autotest_flexframesyncbank_s4_t1() { flexframesyncbank_autotest_run(4, 1); }
+void autotest_flexframesyncbank_s4_t3() { flexframesyncbank_autotest_run(4, 3); }
+void autotest_flexframesyncbank_s6_t8() { flexframesyncbank_autotest_run(6, 8); }
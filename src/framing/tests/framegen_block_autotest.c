@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// output buffer lengths for block writes, including lengths shorter
+// than, equal to and longer than one symbol
+static unsigned int framegen_block_autotest_lens[] = {1, 7, 80, 81, 2, 300, 3, 1000, 64};
+#define FRAMEGEN_BLOCK_AUTOTEST_NUM_LENS (9)
+
+// compare frames written by block against reference
+//  _ref        :   reference frame samples
+//  _ref_len    :   reference frame length
+//  _y          :   block-written samples
+//  _y_len      :   number of block-written samples
+void framegen_block_autotest_compare(float complex * _ref,
+                                     unsigned int    _ref_len,
+                                     float complex * _y,
+                                     unsigned int    _y_len)
+{
+    CONTEND_EQUALITY( _y_len, _ref_len );
+    if (_y_len == _ref_len)
+        CONTEND_SAME_DATA( _y, _ref, _ref_len*sizeof(float complex) );
+}
+
+// 
+// AUTOTEST : ofdmflexframegen block writes match symbol writes
+//
+void autotest_ofdmflexframegen_write_block()
+{
+    unsigned int M      = 64;
+    unsigned int cp_len = 16;
+    unsigned int i, n;
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[120];
+    for (i=0; i<120; i++)
+        payload[i] = rand() & 0xff;
+
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, 4, NULL, NULL);
+
+    // reference: one symbol at a time (padding symbols are random;
+    // seed generator identically for each frame)
+    ofdmflexframegen_assemble(fg, header, payload, 120);
+    unsigned int frame_len = ofdmflexframegen_getframelen(fg)*(M+cp_len);
+    float complex ref[frame_len];
+    randf_seed(7);
+    for (n=0; n<frame_len; n+=M+cp_len) {
+        if (ofdmflexframegen_writesymbol(fg, &ref[n]))
+            break;
+    }
+    CONTEND_EQUALITY( n+M+cp_len, frame_len );
+
+    // block writes, twice to check frame boundary handling
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        float complex y[frame_len + 1000];
+        unsigned int num_written, total = 0, num_calls = 0;
+        int complete = 0;
+        ofdmflexframegen_assemble(fg, header, payload, 120);
+        randf_seed(7);
+        while (!complete && num_calls < 10000) {
+            unsigned int len = framegen_block_autotest_lens[num_calls++ % FRAMEGEN_BLOCK_AUTOTEST_NUM_LENS];
+            complete = ofdmflexframegen_write_block(fg, &y[total], len, &num_written);
+            total += num_written;
+            if (!complete)
+                CONTEND_EQUALITY( num_written, len );
+        }
+        framegen_block_autotest_compare(ref, frame_len, y, total);
+
+        // nothing written once frame is complete
+        CONTEND_EQUALITY( ofdmflexframegen_write_block(fg, y, 100, &num_written), 0 );
+        CONTEND_EQUALITY( num_written, 0 );
+    }
+    ofdmflexframegen_destroy(fg);
+}
+
+// 
+// AUTOTEST : flexframegen block writes match sample writes
+//
+void autotest_flexframegen_write_block()
+{
+    unsigned int i;
+    unsigned char header[14] = {0};
+    unsigned char payload[120];
+    for (i=0; i<120; i++)
+        payload[i] = rand() & 0xff;
+
+    flexframegen fg = flexframegen_create(NULL);
+
+    // reference: entire frame at once
+    flexframegen_assemble(fg, header, payload, 120);
+    unsigned int frame_len = flexframegen_getframelen(fg);
+    float complex ref[frame_len];
+    CONTEND_EQUALITY( flexframegen_write_samples(fg, ref, frame_len), 1 );
+
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        float complex y[frame_len + 1000];
+        unsigned int num_written, total = 0, num_calls = 0;
+        int complete = 0;
+        flexframegen_assemble(fg, header, payload, 120);
+        while (!complete && num_calls < 10000) {
+            unsigned int len = framegen_block_autotest_lens[num_calls++ % FRAMEGEN_BLOCK_AUTOTEST_NUM_LENS];
+            complete = flexframegen_write_block(fg, &y[total], len, &num_written);
+            total += num_written;
+            if (!complete)
+                CONTEND_EQUALITY( num_written, len );
+        }
+        framegen_block_autotest_compare(ref, frame_len, y, total);
+
+        CONTEND_EQUALITY( flexframegen_write_block(fg, y, 100, &num_written), 0 );
+        CONTEND_EQUALITY( num_written, 0 );
+    }
+    flexframegen_destroy(fg);
+}
+
+// 
+// AUTOTEST : gmskframegen block writes match sample writes
+//
+void autotest_gmskframegen_write_block()
+{
+    unsigned int i, n;
+    unsigned char header[8] = {0};
+    unsigned char payload[40];
+    for (i=0; i<40; i++)
+        payload[i] = rand() & 0xff;
+
+    gmskframegen fg = gmskframegen_create();
+
+    // reference: one symbol at a time (tail bits are random; seed
+    // generator identically for each frame)
+    gmskframegen_assemble(fg, header, payload, 40, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+    unsigned int frame_len = gmskframegen_getframelen(fg);
+    float complex ref[frame_len];
+    randf_seed(7);
+    for (n=0; n<frame_len; n+=2) {
+        if (gmskframegen_write_samples(fg, &ref[n]))
+            break;
+    }
+    CONTEND_EQUALITY( n+2, frame_len );
+
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        float complex y[frame_len + 1000];
+        unsigned int num_written, total = 0, num_calls = 0;
+        int complete = 0;
+        gmskframegen_assemble(fg, header, payload, 40, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+        randf_seed(7);
+        while (!complete && num_calls < 10000) {
+            unsigned int len = framegen_block_autotest_lens[num_calls++ % FRAMEGEN_BLOCK_AUTOTEST_NUM_LENS];
+            complete = gmskframegen_write_block(fg, &y[total], len, &num_written);
+            total += num_written;
+            if (!complete)
+                CONTEND_EQUALITY( num_written, len );
+        }
+        framegen_block_autotest_compare(ref, frame_len, y, total);
+
+        CONTEND_EQUALITY( gmskframegen_write_block(fg, y, 100, &num_written), 0 );
+        CONTEND_EQUALITY( num_written, 0 );
+    }
+    gmskframegen_destroy(fg);
+}
+
+// number of frames, payload lengths and gap for batch tests
+#define FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES (4)
+static unsigned int framegen_batch_autotest_lens[] = {120, 37, 200, 1};
+
+// 
+// AUTOTEST : ofdmflexframegen batch matches individually assembled frames
+//
+void autotest_ofdmflexframegen_batch()
+{
+    unsigned int M       = 64;
+    unsigned int cp_len  = 16;
+    unsigned int gap_len = 101;
+    unsigned int i, j;
+    unsigned char   header[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES][8];
+    unsigned char   payload[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES][200];
+    unsigned char * headers[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES];
+    unsigned char * payloads[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES];
+    for (i=0; i<FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES; i++) {
+        for (j=0; j<8;   j++) header[i][j]  = rand() & 0xff;
+        for (j=0; j<200; j++) payload[i][j] = rand() & 0xff;
+        headers[i]  = header[i];
+        payloads[i] = payload[i];
+    }
+
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, 4, NULL, NULL);
+
+    // reference: frames assembled one at a time, separated by zeros
+    unsigned int n = 50000;
+    float complex ref[n];
+    float complex y[n];
+    unsigned int num_written, ref_len = 0;
+    randf_seed(7);
+    for (i=0; i<FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES; i++) {
+        if (i > 0) {
+            memset(&ref[ref_len], 0x00, gap_len*sizeof(float complex));
+            ref_len += gap_len;
+        }
+        ofdmflexframegen_assemble(fg, headers[i], payloads[i], framegen_batch_autotest_lens[i]);
+        CONTEND_EQUALITY( ofdmflexframegen_write_block(fg, &ref[ref_len], n-ref_len, &num_written), 1 );
+        ref_len += num_written;
+    }
+
+    // batch, written with assorted buffer lengths
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        unsigned int total = 0, num_calls = 0;
+        int complete = 0;
+        ofdmflexframegen_assemble_batch(fg, FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES, headers, payloads,
+                                        framegen_batch_autotest_lens, gap_len);
+        randf_seed(7);
+        while (!complete && num_calls < 10000) {
+            unsigned int len = framegen_block_autotest_lens[num_calls++ % FRAMEGEN_BLOCK_AUTOTEST_NUM_LENS];
+            complete = ofdmflexframegen_write_block(fg, &y[total], len, &num_written);
+            total += num_written;
+            if (!complete)
+                CONTEND_EQUALITY( num_written, len );
+        }
+        framegen_block_autotest_compare(ref, ref_len, y, total);
+        CONTEND_EQUALITY( ofdmflexframegen_write_block(fg, y, 100, &num_written), 0 );
+        CONTEND_EQUALITY( num_written, 0 );
+    }
+    ofdmflexframegen_destroy(fg);
+}
+
+// 
+// AUTOTEST : flexframegen batch matches individually assembled frames
+//
+void autotest_flexframegen_batch()
+{
+    unsigned int gap_len = 101;
+    unsigned int i, j;
+    unsigned char   header[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES][14];
+    unsigned char   payload[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES][200];
+    unsigned char * headers[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES];
+    unsigned char * payloads[FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES];
+    for (i=0; i<FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES; i++) {
+        for (j=0; j<14;  j++) header[i][j]  = rand() & 0xff;
+        for (j=0; j<200; j++) payload[i][j] = rand() & 0xff;
+        headers[i]  = header[i];
+        payloads[i] = payload[i];
+    }
+
+    flexframegen fg = flexframegen_create(NULL);
+
+    // reference: frames assembled one at a time, separated by zeros
+    unsigned int n = 20000;
+    float complex ref[n];
+    float complex y[n];
+    unsigned int num_written, ref_len = 0;
+    for (i=0; i<FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES; i++) {
+        if (i > 0) {
+            memset(&ref[ref_len], 0x00, gap_len*sizeof(float complex));
+            ref_len += gap_len;
+        }
+        flexframegen_assemble(fg, headers[i], payloads[i], framegen_batch_autotest_lens[i]);
+        CONTEND_EQUALITY( flexframegen_write_block(fg, &ref[ref_len], n-ref_len, &num_written), 1 );
+        ref_len += num_written;
+    }
+
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        unsigned int total = 0, num_calls = 0;
+        int complete = 0;
+        flexframegen_assemble_batch(fg, FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES, headers, payloads,
+                                    framegen_batch_autotest_lens, gap_len);
+        while (!complete && num_calls < 10000) {
+            unsigned int len = framegen_block_autotest_lens[num_calls++ % FRAMEGEN_BLOCK_AUTOTEST_NUM_LENS];
+            complete = flexframegen_write_block(fg, &y[total], len, &num_written);
+            total += num_written;
+            if (!complete)
+                CONTEND_EQUALITY( num_written, len );
+        }
+        framegen_block_autotest_compare(ref, ref_len, y, total);
+        CONTEND_EQUALITY( flexframegen_write_block(fg, y, 100, &num_written), 0 );
+        CONTEND_EQUALITY( num_written, 0 );
+    }
+
+    // batch abandoned by reset
+    flexframegen_assemble_batch(fg, FRAMEGEN_BATCH_AUTOTEST_NUM_FRAMES, headers, payloads,
+                                framegen_batch_autotest_lens, gap_len);
+    flexframegen_write_block(fg, y, 1000, &num_written);
+    flexframegen_reset(fg);
+    CONTEND_EQUALITY( flexframegen_write_block(fg, y, 100, &num_written), 0 );
+    CONTEND_EQUALITY( num_written, 0 );
+
+    flexframegen_destroy(fg);
+}
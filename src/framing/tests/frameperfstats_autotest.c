@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// count frames with valid payloads
+static int frameperfstats_autotest_callback(unsigned char *  _header,
+                                            int              _header_valid,
+                                            unsigned char *  _payload,
+                                            unsigned int     _payload_len,
+                                            int              _payload_valid,
+                                            framesyncstats_s _stats,
+                                            void *           _userdata)
+{
+    unsigned int * num_valid = (unsigned int*) _userdata;
+    if (_header_valid && _payload_valid)
+        (*num_valid)++;
+    return 0;
+}
+
+// helper function: check counters of a receiver which never had them enabled
+static void frameperfstats_autotest_contend_zero(frameperfstats_s * _stats)
+{
+    CONTEND_EQUALITY( _stats->num_samples_detect,   0 );
+    CONTEND_EQUALITY( _stats->num_samples_preamble, 0 );
+    CONTEND_EQUALITY( _stats->num_samples_header,   0 );
+    CONTEND_EQUALITY( _stats->num_samples_payload,  0 );
+    CONTEND_EQUALITY( _stats->num_detector_passes,  0 );
+    CONTEND_EQUALITY( _stats->num_decode_attempts,  0 );
+    CONTEND_EQUALITY( _stats->time_fec,             0 );
+    CONTEND_EQUALITY( _stats->time_callback,        0 );
+    CONTEND_EQUALITY( _stats->num_latency,          0 );
+}
+
+// helper function: check counters after receiving frames
+//  _stats          :   performance counters
+//  _num_samples    :   number of samples pushed through receiver
+//  _num_attempts   :   expected number of decode attempts
+//  _header         :   does the receiver have a separate header state?
+static void frameperfstats_autotest_contend(frameperfstats_s * _stats,
+                                            unsigned long int  _num_samples,
+                                            unsigned long int  _num_attempts,
+                                            int                _header)
+{
+    unsigned long int num_counted = _stats->num_samples_detect   +
+                                    _stats->num_samples_preamble +
+                                    _stats->num_samples_header   +
+                                    _stats->num_samples_payload;
+    if (liquid_autotest_verbose) {
+        printf("  samples pushed : %lu, counted : %lu\n", _num_samples, num_counted);
+        frameperfstats_print(_stats);
+    }
+
+    // samples buffered by the detector are re-run once a frame is found
+    CONTEND_EXPRESSION( num_counted >= _num_samples );
+    CONTEND_GREATER_THAN( _stats->num_samples_detect,   0 );
+    CONTEND_GREATER_THAN( _stats->num_samples_preamble, 0 );
+    CONTEND_GREATER_THAN( _stats->num_samples_payload,  0 );
+    if (_header) {
+        CONTEND_GREATER_THAN( _stats->num_samples_header, 0 );
+    } else {
+        CONTEND_EQUALITY( _stats->num_samples_header, 0 );
+    }
+    CONTEND_GREATER_THAN( _stats->num_detector_passes, 0 );
+    CONTEND_EQUALITY( _stats->num_decode_attempts, _num_attempts );
+    CONTEND_EXPRESSION( _stats->time_fec      >= 0.0 );
+    CONTEND_EXPRESSION( _stats->time_callback >= 0.0 );
+
+    // one latency measurement per callback, each counted in histogram
+    unsigned long int i, num_hist = 0;
+    for (i=0; i<FRAMEPERFSTATS_LATENCY_BINS; i++)
+        num_hist += _stats->latency_hist[i];
+    CONTEND_GREATER_THAN( _stats->num_latency, 0 );
+    CONTEND_EQUALITY( num_hist, _stats->num_latency );
+    CONTEND_EXPRESSION( _stats->latency_min >= 0.0 );
+    CONTEND_EXPRESSION( _stats->latency_min*_stats->num_latency <= _stats->latency_sum + 1e-12 );
+    CONTEND_EXPRESSION( _stats->latency_max*_stats->num_latency >= _stats->latency_sum - 1e-12 );
+}
+
+// 
+// AUTOTEST : flexframesync performance counters
+//
+void autotest_flexframesync_perfstats()
+{
+    unsigned int num_frames  = 3;
+    unsigned int payload_len = 120;
+    unsigned int i;
+
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.check = LIQUID_CRC_32;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    unsigned int num_valid = 0;
+    flexframesync fs = flexframesync_create(frameperfstats_autotest_callback, &num_valid);
+
+    unsigned char header[14] = {0};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    float complex buf[64];
+    unsigned long int num_samples = 0;
+    unsigned int n;
+    for (n=0; n<num_frames+1; n++) {
+        // first frame is received with counters disabled
+        if (n == 1) {
+            frameperfstats_s stats = flexframesync_get_perfstats(fs);
+            frameperfstats_autotest_contend_zero(&stats);
+            flexframesync_perfstats_enable(fs);
+        }
+
+        flexframegen_assemble(fg, header, payload, payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = flexframegen_write_samples(fg, buf, 64);
+            flexframesync_execute(fs, buf, 64);
+            num_samples += n > 0 ? 64 : 0;
+        }
+
+        // flush receiver
+        memset(buf, 0x00, sizeof(buf));
+        for (i=0; i<4; i++) {
+            flexframesync_execute(fs, buf, 64);
+            num_samples += n > 0 ? 64 : 0;
+        }
+    }
+    CONTEND_EQUALITY( num_valid, num_frames+1 );
+
+    // header and payload decoded for each frame
+    frameperfstats_s stats = flexframesync_get_perfstats(fs);
+    frameperfstats_autotest_contend(&stats, num_samples, 2*num_frames, 1);
+
+    // reset and disable
+    flexframesync_reset_perfstats(fs);
+    flexframesync_perfstats_disable(fs);
+    flexframesync_execute(fs, buf, 64);
+    stats = flexframesync_get_perfstats(fs);
+    frameperfstats_autotest_contend_zero(&stats);
+
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+// 
+// AUTOTEST : framesync64 performance counters
+//
+void autotest_framesync64_perfstats()
+{
+    unsigned int num_frames = 3;
+    unsigned int i;
+
+    framegen64 fg = framegen64_create();
+    unsigned int num_valid = 0;
+    framesync64 fs = framesync64_create(frameperfstats_autotest_callback, &num_valid);
+
+    unsigned char header[8] = {0};
+    unsigned char payload[64];
+    for (i=0; i<64; i++)
+        payload[i] = rand() & 0xff;
+
+    float complex frame[LIQUID_FRAME64_LEN];
+    float complex buf[200];
+    memset(buf, 0x00, sizeof(buf));
+    framesync64_perfstats_enable(fs);
+    for (i=0; i<num_frames; i++) {
+        framegen64_execute(fg, header, payload, frame);
+        framesync64_execute(fs, frame, LIQUID_FRAME64_LEN);
+        framesync64_execute(fs, buf, 200);
+    }
+    CONTEND_EQUALITY( num_valid, num_frames );
+
+    // header is carried in the payload: one decode attempt per frame
+    frameperfstats_s stats = framesync64_get_perfstats(fs);
+    frameperfstats_autotest_contend(&stats, num_frames*(LIQUID_FRAME64_LEN+200), num_frames, 0);
+
+    framesync64_reset_perfstats(fs);
+    stats = framesync64_get_perfstats(fs);
+    CONTEND_EQUALITY( stats.num_samples_detect,  0 );
+    CONTEND_EQUALITY( stats.num_decode_attempts, 0 );
+
+    framegen64_destroy(fg);
+    framesync64_destroy(fs);
+}
+
+// 
+// AUTOTEST : gmskframesync performance counters
+//
+void autotest_gmskframesync_perfstats()
+{
+    unsigned int num_frames  = 3;
+    unsigned int payload_len = 40;
+    unsigned int i;
+
+    gmskframegen fg = gmskframegen_create();
+    unsigned int num_valid = 0;
+    gmskframesync fs = gmskframesync_create(frameperfstats_autotest_callback, &num_valid);
+
+    unsigned char header[8] = {0};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    float complex buf[100];
+    unsigned long int num_samples = 0;
+    gmskframesync_perfstats_enable(fs);
+    for (i=0; i<num_frames; i++) {
+        gmskframegen_assemble(fg, header, payload, payload_len,
+                              LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            unsigned int num_written;
+            frame_complete = gmskframegen_write_block(fg, buf, 100, &num_written);
+            gmskframesync_execute(fs, buf, num_written);
+            num_samples += num_written;
+        }
+        memset(buf, 0x00, sizeof(buf));
+        gmskframesync_execute(fs, buf, 100);
+        num_samples += 100;
+    }
+    CONTEND_EQUALITY( num_valid, num_frames );
+
+    frameperfstats_s stats = gmskframesync_get_perfstats(fs);
+    frameperfstats_autotest_contend(&stats, num_samples, 2*num_frames, 1);
+
+    gmskframegen_destroy(fg);
+    gmskframesync_destroy(fs);
+}
+
+// helper function: ofdmflexframesync performance counters
+//  _num_threads    :   number of payload decode threads
+static void ofdmflexframesync_perfstats_test(unsigned int _num_threads)
+{
+    unsigned int M           = 64;
+    unsigned int cp_len      = 16;
+    unsigned int taper_len   = 4;
+    unsigned int num_frames  = 3;
+    unsigned int payload_len = 120;
+    unsigned int i, j;
+
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check = LIQUID_CRC_32;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, &fgprops);
+
+    unsigned int num_valid = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL,
+                                                    frameperfstats_autotest_callback,
+                                                    &num_valid);
+    ofdmflexframesync_set_decode_threads(fs, _num_threads);
+
+    unsigned char header[8] = {0};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    float complex buf[M + cp_len];
+    unsigned long int num_samples = 0;
+    ofdmflexframesync_perfstats_enable(fs);
+    for (i=0; i<num_frames; i++) {
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+        int last_symbol = 0;
+        while (!last_symbol) {
+            last_symbol = ofdmflexframegen_writesymbol(fg, buf);
+            ofdmflexframesync_execute(fs, buf, M+cp_len);
+            num_samples += M + cp_len;
+        }
+        for (j=0; j<M+cp_len; j++)
+            buf[j] = 0.0f;
+        for (j=0; j<2; j++) {
+            ofdmflexframesync_execute(fs, buf, M+cp_len);
+            num_samples += M + cp_len;
+        }
+    }
+    ofdmflexframesync_wait(fs);
+    CONTEND_EQUALITY( num_valid, num_frames );
+
+    frameperfstats_s stats = ofdmflexframesync_get_perfstats(fs);
+    frameperfstats_autotest_contend(&stats, num_samples, 2*num_frames, 1);
+    if (liquid_autotest_verbose)
+        ofdmflexframesync_print(fs);
+
+    ofdmflexframesync_reset_perfstats(fs);
+    stats = ofdmflexframesync_get_perfstats(fs);
+    CONTEND_EQUALITY( stats.num_samples_payload, 0 );
+    CONTEND_EQUALITY( stats.num_decode_attempts, 0 );
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+// 
+// AUTOTEST : ofdmflexframesync performance counters, inline and
+//            pipelined payload decoding
+//
+void autotest_ofdmflexframesync_perfstats()
+{
+    ofdmflexframesync_perfstats_test(0);
+}
+
+void autotest_ofdmflexframesync_perfstats_pipelined()
+{
+    ofdmflexframesync_perfstats_test(2);
+}
+
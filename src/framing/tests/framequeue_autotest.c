@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// frames received through a callback
+struct framequeue_autotest_log_s {
+    unsigned int num_frames;        // frames delivered
+    unsigned int index[16];         // header byte 0, in order
+    unsigned int num_valid;         // frames with valid payload
+};
+
+static int framequeue_autotest_callback(unsigned char *  _header,
+                                        int              _header_valid,
+                                        unsigned char *  _payload,
+                                        unsigned int     _payload_len,
+                                        int              _payload_valid,
+                                        framesyncstats_s _stats,
+                                        void *           _userdata)
+{
+    struct framequeue_autotest_log_s * log = (struct framequeue_autotest_log_s*) _userdata;
+    if (log->num_frames < 16)
+        log->index[log->num_frames] = _header[0];
+    log->num_frames++;
+    log->num_valid += _header_valid && _payload_valid && _payload[0] == _header[0];
+    return 0;
+}
+
+// run frames through flexframesync: frame i carries i in the first
+// header and payload bytes and has payload length 20+10i
+static void framequeue_autotest_flexframe(flexframesync _fs,
+                                          unsigned int  _num_frames)
+{
+    flexframegen fg = flexframegen_create(NULL);
+    unsigned char header[14];
+    unsigned char payload[200];
+    float complex buf[256];
+    unsigned int i, j;
+    for (i=0; i<_num_frames; i++) {
+        unsigned int payload_len = 20 + 10*i;
+        memset(header, i, sizeof(header));
+        for (j=0; j<payload_len; j++)
+            payload[j] = j == 0 ? i : (i + 3*j) & 0xff;
+        flexframegen_assemble(fg, header, payload, payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            unsigned int num_written;
+            frame_complete = flexframegen_write_block(fg, buf, 256, &num_written);
+            flexframesync_execute(_fs, buf, num_written);
+        }
+        memset(buf, 0, sizeof(buf));
+        flexframesync_execute(_fs, buf, 256);
+    }
+    flexframegen_destroy(fg);
+}
+
+// frames are queued rather than delivered from execute(), and popped
+// in order with their contents and frame symbols
+void autotest_framequeue_flexframesync_pop()
+{
+    unsigned int num_frames = 6;
+    struct framequeue_autotest_log_s log;
+    memset(&log, 0, sizeof(log));
+    flexframesync fs = flexframesync_create(framequeue_autotest_callback, &log);
+    flexframesync_set_frame_queue(fs, num_frames, 0);
+    framequeue_autotest_flexframe(fs, num_frames);
+    CONTEND_EQUALITY( log.num_frames, 0 );
+
+    unsigned int i, j;
+    framesync_frame_s frame;
+    for (i=0; i<num_frames; i++) {
+        CONTEND_EQUALITY( flexframesync_pop_frame(fs, &frame), 1 );
+        CONTEND_EQUALITY( frame.header_len,    14 );
+        CONTEND_EQUALITY( frame.header_valid,  1 );
+        CONTEND_EQUALITY( frame.payload_valid, 1 );
+        CONTEND_EQUALITY( frame.header[0],     i );
+        CONTEND_EQUALITY( frame.payload_len,   20 + 10*i );
+        unsigned int num_errors = 0;
+        for (j=1; j<frame.payload_len; j++)
+            num_errors += frame.payload[j] != ((i + 3*j) & 0xff);
+        CONTEND_EQUALITY( num_errors, 0 );
+        CONTEND_EXPRESSION( frame.stats.framesyms != NULL );
+        CONTEND_GREATER_THAN( frame.stats.num_framesyms, 0 );
+    }
+    CONTEND_EQUALITY( flexframesync_pop_frame(fs, &frame), 0 );
+    CONTEND_EQUALITY( flexframesync_get_frame_queue_drops(fs), 0 );
+
+    // each slot's buffers have grown to fit its frame: repeating the
+    // frames (which land in the same slots) allocates nothing further
+    unsigned long int n0 = flexframesync_get_memory_usage(fs);
+    framequeue_autotest_flexframe(fs, num_frames);
+    for (i=0; i<num_frames; i++)
+        CONTEND_EQUALITY( flexframesync_pop_frame(fs, &frame), 1 );
+    CONTEND_EQUALITY( flexframesync_get_memory_usage(fs), n0 );
+
+    // direct delivery restored
+    flexframesync_set_frame_queue(fs, 0, 0);
+    framequeue_autotest_flexframe(fs, 2);
+    CONTEND_EQUALITY( log.num_frames, 2 );
+    CONTEND_EQUALITY( log.num_valid,  2 );
+    flexframesync_destroy(fs);
+}
+
+// full queue drops (and counts) frames instead of blocking
+void autotest_framequeue_flexframesync_drop()
+{
+    flexframesync fs = flexframesync_create(NULL, NULL);
+    flexframesync_set_frame_queue(fs, 2, 0);
+    framequeue_autotest_flexframe(fs, 5);
+
+    framesync_frame_s frame;
+    CONTEND_EQUALITY( flexframesync_pop_frame(fs, &frame), 1 );
+    CONTEND_EQUALITY( frame.header[0], 0 );
+    CONTEND_EQUALITY( flexframesync_pop_frame(fs, &frame), 1 );
+    CONTEND_EQUALITY( frame.header[0], 1 );
+    CONTEND_EQUALITY( flexframesync_pop_frame(fs, &frame), 0 );
+    CONTEND_EQUALITY( flexframesync_get_frame_queue_drops(fs), 3 );
+    flexframesync_destroy(fs);
+}
+
+// delivery thread invokes the callback in order; destroying the
+// synchronizer delivers frames still queued
+void autotest_framequeue_flexframesync_thread()
+{
+    unsigned int num_frames = 6;
+    struct framequeue_autotest_log_s log;
+    memset(&log, 0, sizeof(log));
+    flexframesync fs = flexframesync_create(framequeue_autotest_callback, &log);
+    flexframesync_set_frame_queue(fs, 4, 1);
+    framequeue_autotest_flexframe(fs, num_frames);
+    unsigned int num_dropped = flexframesync_get_frame_queue_drops(fs);
+    flexframesync_destroy(fs);
+
+    CONTEND_EQUALITY( log.num_frames + num_dropped, num_frames );
+    CONTEND_EQUALITY( log.num_valid, log.num_frames );
+    unsigned int i;
+    for (i=1; i<log.num_frames; i++)
+        CONTEND_GREATER_THAN( log.index[i], log.index[i-1] );
+}
+
+// gmskframesync frames popped from queue
+void autotest_framequeue_gmskframesync()
+{
+    unsigned int num_frames = 4;
+    unsigned int i, j;
+    gmskframegen fg = gmskframegen_create();
+    gmskframesync fs = gmskframesync_create(NULL, NULL);
+    gmskframesync_set_frame_queue(fs, 4, 0);
+
+    unsigned char header[8];
+    unsigned char payload[40];
+    float complex buf[100];
+    for (i=0; i<num_frames; i++) {
+        memset(header, i, sizeof(header));
+        for (j=0; j<40; j++)
+            payload[j] = j == 0 ? i : (7*j) & 0xff;
+        gmskframegen_assemble(fg, header, payload, 40,
+                              LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            unsigned int num_written;
+            frame_complete = gmskframegen_write_block(fg, buf, 100, &num_written);
+            gmskframesync_execute(fs, buf, num_written);
+        }
+        memset(buf, 0, sizeof(buf));
+        for (j=0; j<5; j++)
+            gmskframesync_execute(fs, buf, 100);
+    }
+    gmskframegen_destroy(fg);
+
+    framesync_frame_s frame;
+    for (i=0; i<num_frames; i++) {
+        CONTEND_EQUALITY( gmskframesync_pop_frame(fs, &frame), 1 );
+        CONTEND_EQUALITY( frame.header_len,    8 );
+        CONTEND_EQUALITY( frame.header[0],     i );
+        CONTEND_EQUALITY( frame.payload_valid, 1 );
+        CONTEND_EQUALITY( frame.payload_len,   40 );
+        CONTEND_EQUALITY( frame.payload[0],    i );
+    }
+    CONTEND_EQUALITY( gmskframesync_pop_frame(fs, &frame), 0 );
+    gmskframesync_destroy(fs);
+}
+
+// run frames through ofdmflexframesync with payload decode threads and
+// queued delivery
+static void framequeue_autotest_ofdmflexframe(unsigned int                       _num_threads,
+                                              int                                _thread,
+                                              struct framequeue_autotest_log_s * _log)
+{
+    unsigned int M = 64, cp_len = 16, taper_len = 4;
+    unsigned int num_frames = 6;
+    unsigned int i, j;
+
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, NULL);
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL,
+                                                    framequeue_autotest_callback, _log);
+    ofdmflexframesync_set_decode_threads(fs, _num_threads);
+    ofdmflexframesync_set_frame_queue(fs, 8, _thread);
+
+    unsigned char header[8];
+    unsigned char payload[120];
+    float complex buf[M + cp_len];
+    for (i=0; i<num_frames; i++) {
+        memset(header, i, sizeof(header));
+        for (j=0; j<120; j++)
+            payload[j] = j == 0 ? i : (5*j) & 0xff;
+        ofdmflexframegen_assemble(fg, header, payload, 120);
+        int last_symbol = 0;
+        while (!last_symbol) {
+            last_symbol = ofdmflexframegen_writesymbol(fg, buf);
+            ofdmflexframesync_execute(fs, buf, M + cp_len);
+        }
+        memset(buf, 0, sizeof(buf));
+        for (j=0; j<2; j++)
+            ofdmflexframesync_execute(fs, buf, M + cp_len);
+    }
+    ofdmflexframesync_wait(fs);
+
+    if (!_thread) {
+        // pop queued frames into log
+        framesync_frame_s frame;
+        while (ofdmflexframesync_pop_frame(fs, &frame)) {
+            framequeue_autotest_callback(frame.header, frame.header_valid, frame.payload,
+                                         frame.payload_len, frame.payload_valid,
+                                         frame.stats, _log);
+        }
+    }
+
+    // every frame delivered by the time wait() returns
+    CONTEND_EQUALITY( _log->num_frames, num_frames );
+    CONTEND_EQUALITY( _log->num_valid,  num_frames );
+    for (i=0; i<_log->num_frames; i++)
+        CONTEND_EQUALITY( _log->index[i], i );
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+void autotest_framequeue_ofdmflexframesync_pop()
+{
+    struct framequeue_autotest_log_s log;
+    memset(&log, 0, sizeof(log));
+    framequeue_autotest_ofdmflexframe(0, 0, &log);
+    memset(&log, 0, sizeof(log));
+    framequeue_autotest_ofdmflexframe(3, 0, &log);
+}
+
+void autotest_framequeue_ofdmflexframesync_thread()
+{
+    struct framequeue_autotest_log_s log;
+    memset(&log, 0, sizeof(log));
+    framequeue_autotest_ofdmflexframe(0, 1, &log);
+    memset(&log, 0, sizeof(log));
+    framequeue_autotest_ofdmflexframe(3, 1, &log);
+}
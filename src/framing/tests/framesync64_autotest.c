@@ -90,3 +90,56 @@ void autotest_framesync64()
     framesync64_destroy(fs);
 }
 
+
+// 
+// AUTOTEST : recover frame after long idle period with energy gate
+//            enabled, checking that idle blocks bypass correlation
+//
+void autotest_framesync64_gate()
+{
+    unsigned int i;
+    unsigned int num_idle = 20000;  // idle (noise-only) samples
+    float        nstd     = 0.01f;  // noise standard deviation
+
+    framegen64 fg = framegen64_create();
+
+    // frame data
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[64];
+    for (i=0; i<64; i++)
+        payload[i] = rand() & 0xff;
+
+    // create framesync64 object with gate enabled
+    int frame_recovered = 0;
+    framesync64 fs = framesync64_create(callback,(void*)&frame_recovered);
+    framesync64_gate_enable(fs);
+
+    // run through idle period
+    float complex x;
+    for (i=0; i<num_idle; i++) {
+        x = nstd*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+        framesync64_execute(fs, &x, 1);
+    }
+    unsigned int num_blocks  = framesync64_gate_get_num_blocks (fs);
+    unsigned int num_skipped = framesync64_gate_get_num_skipped(fs);
+
+    // generate the frame, add noise, and try to find it
+    unsigned int frame_len = LIQUID_FRAME64_LEN;
+    float complex frame[frame_len];
+    framegen64_execute(fg, header, payload, frame);
+    for (i=0; i<frame_len; i++)
+        frame[i] += nstd*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+    framesync64_execute(fs, frame, frame_len);
+
+    if (liquid_autotest_verbose)
+        printf("framesync64 gate: skipped %u / %u idle blocks\n", num_skipped, num_blocks);
+
+    // check that frame was recovered and idle blocks were bypassed
+    CONTEND_EQUALITY( frame_recovered, 1 );
+    CONTEND_GREATER_THAN( num_blocks, 0 );
+    CONTEND_GREATER_THAN( num_skipped, 0.9f*num_blocks );
+
+    // destroy objects
+    framegen64_destroy(fg);
+    framesync64_destroy(fs);
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// record of frames reported: frame index (header byte 0) and position
+struct framesync_batch_autotest_s {
+    unsigned int      num_frames;       // valid frames reported
+    unsigned int      num_invalid;      // invalid frames reported
+    unsigned int      num_false;        // detections on noise (header invalid)
+    unsigned int      index[64];        // frame indices, in order
+    unsigned long int position[64];     // frame positions, in order
+};
+
+static int framesync_batch_autotest_callback(unsigned long int _position,
+                                             unsigned char *   _header,
+                                             int               _header_valid,
+                                             unsigned char *   _payload,
+                                             unsigned int      _payload_len,
+                                             int               _payload_valid,
+                                             framesyncstats_s  _stats,
+                                             void *            _userdata)
+{
+    struct framesync_batch_autotest_s * r = (struct framesync_batch_autotest_s*) _userdata;
+    if (!_header_valid) {
+        // occasional false detection in the noise-only gaps; the
+        // header check rejects it
+        r->num_false++;
+        return 0;
+    }
+    if (!_payload_valid || _payload[0] != _header[0] || r->num_frames == 64) {
+        r->num_invalid++;
+        return 0;
+    }
+    r->index   [r->num_frames] = _header[0];
+    r->position[r->num_frames] = _position;
+    r->num_frames++;
+    return 0;
+}
+
+// check every frame was reported exactly once, in capture order
+static void framesync_batch_autotest_check(struct framesync_batch_autotest_s * _r,
+                                           unsigned int                        _num_frames)
+{
+    unsigned int i;
+    CONTEND_EQUALITY( _r->num_frames,  _num_frames );
+    CONTEND_EQUALITY( _r->num_invalid, 0 );
+    for (i=0; i<_r->num_frames; i++) {
+        CONTEND_EQUALITY( _r->index[i], i );
+        if (i > 0) {
+            CONTEND_EXPRESSION( _r->position[i] > _r->position[i-1] );
+        }
+    }
+}
+
+// generate flexframe capture: frames with varying gaps and noise;
+// returns capture and sets its length and longest frame length
+static float complex * framesync_batch_autotest_flexframe(unsigned int        _num_frames,
+                                                         unsigned long int * _n,
+                                                         unsigned int *      _frame_len)
+{
+    unsigned int i, j;
+    flexframegen fg = flexframegen_create(NULL);
+    unsigned char header[14];
+    unsigned char payload[120];
+    unsigned long int n = 0;
+    float complex * x = NULL;
+    *_frame_len = 0;
+    for (i=0; i<_num_frames; i++) {
+        unsigned int payload_len = 20 + (i*37) % 100;
+        unsigned int gap = 100 + (i*211) % 900;
+        memset(header, i, sizeof(header));
+        for (j=0; j<payload_len; j++)
+            payload[j] = j == 0 ? i : rand() & 0xff;
+        flexframegen_assemble(fg, header, payload, payload_len);
+        unsigned int frame_len = flexframegen_getframelen(fg);
+        if (frame_len > *_frame_len)
+            *_frame_len = frame_len;
+        x = (float complex*) realloc(x, (n + gap + frame_len)*sizeof(float complex));
+        memset(x + n, 0, gap*sizeof(float complex));
+        unsigned int num_written;
+        flexframegen_write_block(fg, x + n + gap, frame_len, &num_written);
+        n += gap + frame_len;
+    }
+    x = (float complex*) realloc(x, (n + 500)*sizeof(float complex));
+    memset(x + n, 0, 500*sizeof(float complex));
+    n += 500;
+    for (i=0; i<n; i++)
+        x[i] = 0.5f*x[i] + 0.02f*(randnf() + _Complex_I*randnf());
+    flexframegen_destroy(fg);
+    *_n = n;
+    return x;
+}
+
+void framesync_batch_autotest_flexframesync(unsigned int _num_threads)
+{
+    unsigned int num_frames = 40;
+    unsigned long int n;
+    unsigned int frame_len;
+    float complex * x = framesync_batch_autotest_flexframe(num_frames, &n, &frame_len);
+
+    struct framesync_batch_autotest_s r;
+    memset(&r, 0, sizeof(r));
+    unsigned int rc = flexframesync_decode_batch(x, n, frame_len + 256, _num_threads,
+                                                 framesync_batch_autotest_callback, &r);
+    CONTEND_EQUALITY( rc, r.num_frames + r.num_false );
+    framesync_batch_autotest_check(&r, num_frames);
+    free(x);
+}
+void autotest_framesync_batch_flexframesync_t1() { framesync_batch_autotest_flexframesync(1); }
+void autotest_framesync_batch_flexframesync_t2() { framesync_batch_autotest_flexframesync(2); }
+void autotest_framesync_batch_flexframesync_t3() { framesync_batch_autotest_flexframesync(3); }
+void autotest_framesync_batch_flexframesync_t8() { framesync_batch_autotest_flexframesync(8); }
+
+// positions do not depend on how the capture was sharded
+void autotest_framesync_batch_positions()
+{
+    unsigned int num_frames = 40;
+    unsigned long int n;
+    unsigned int frame_len;
+    float complex * x = framesync_batch_autotest_flexframe(num_frames, &n, &frame_len);
+
+    struct framesync_batch_autotest_s r1, r4;
+    memset(&r1, 0, sizeof(r1));
+    memset(&r4, 0, sizeof(r4));
+    flexframesync_decode_batch(x, n, frame_len + 256, 1, framesync_batch_autotest_callback, &r1);
+    flexframesync_decode_batch(x, n, frame_len + 256, 4, framesync_batch_autotest_callback, &r4);
+    CONTEND_EQUALITY( r1.num_frames, r4.num_frames );
+    CONTEND_SAME_DATA( r1.position, r4.position, r1.num_frames*sizeof(unsigned long int) );
+    free(x);
+}
+
+void autotest_framesync_batch_ofdmflexframesync()
+{
+    unsigned int M = 64, cp_len = 16, taper_len = 4;
+    unsigned int num_frames = 16;
+    unsigned int i, j;
+
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, NULL);
+    unsigned char header[8];
+    unsigned char payload[80];
+    unsigned long int n = 0;
+    unsigned int max_len = 0;
+    float complex * x = NULL;
+    for (i=0; i<num_frames; i++) {
+        unsigned int payload_len = 20 + (i*29) % 60;
+        unsigned int gap = 200 + (i*173) % 700;
+        memset(header, i, sizeof(header));
+        for (j=0; j<payload_len; j++)
+            payload[j] = j == 0 ? i : rand() & 0xff;
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+        unsigned int frame_len = ofdmflexframegen_getframelen(fg)*(M + cp_len);
+        max_len = frame_len > max_len ? frame_len : max_len;
+        x = (float complex*) realloc(x, (n + gap + frame_len)*sizeof(float complex));
+        memset(x + n, 0, gap*sizeof(float complex));
+        unsigned int num_written;
+        ofdmflexframegen_write_block(fg, x + n + gap, frame_len, &num_written);
+        n += gap + num_written;
+    }
+    x = (float complex*) realloc(x, (n + 1000)*sizeof(float complex));
+    memset(x + n, 0, 1000*sizeof(float complex));
+    n += 1000;
+    for (i=0; i<n; i++)
+        x[i] = 0.1f*x[i] + 0.002f*(randnf() + _Complex_I*randnf());
+    ofdmflexframegen_destroy(fg);
+
+    struct framesync_batch_autotest_s r;
+    memset(&r, 0, sizeof(r));
+    ofdmflexframesync_decode_batch(M, cp_len, taper_len, NULL, x, n, max_len + 512, 3,
+                                   framesync_batch_autotest_callback, &r);
+    framesync_batch_autotest_check(&r, num_frames);
+    free(x);
+}
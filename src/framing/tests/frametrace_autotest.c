@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// collected trace records
+#define FRAMETRACE_AUTOTEST_MAX_RECORDS (2048)
+struct frametrace_autotest_s {
+    frametrace_record_s records[FRAMETRACE_AUTOTEST_MAX_RECORDS];
+    unsigned int        num_records;    // number of records collected
+    unsigned int        num_drains;     // number of drain callbacks
+    unsigned int        max_drain;      // largest number of records in one drain
+};
+
+// drain callback: append records to collection
+static void frametrace_autotest_drain(const frametrace_record_s * _records,
+                                      unsigned int                _n,
+                                      void *                      _userdata)
+{
+    struct frametrace_autotest_s * c = (struct frametrace_autotest_s*) _userdata;
+    unsigned int i;
+    for (i=0; i<_n && c->num_records < FRAMETRACE_AUTOTEST_MAX_RECORDS; i++)
+        c->records[c->num_records++] = _records[i];
+    c->num_drains++;
+    if (_n > c->max_drain)
+        c->max_drain = _n;
+}
+
+static int frametrace_autotest_callback(unsigned char *  _header,
+                                        int              _header_valid,
+                                        unsigned char *  _payload,
+                                        unsigned int     _payload_len,
+                                        int              _payload_valid,
+                                        framesyncstats_s _stats,
+                                        void *           _userdata)
+{
+    return 0;
+}
+
+// 
+// AUTOTEST : frametrace timeline of flexframesync receiving frames
+//
+void autotest_frametrace_flexframesync()
+{
+    unsigned int num_frames  = 3;
+    unsigned int payload_len = 80;
+    unsigned int i;
+
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    flexframegen fg = flexframegen_create(&fgprops);
+    flexframesync fs = flexframesync_create(frametrace_autotest_callback, NULL);
+
+    struct frametrace_autotest_s * c = (struct frametrace_autotest_s*) calloc(1, sizeof(struct frametrace_autotest_s));
+    if (frametrace_enable(frametrace_autotest_drain, c) != 0) {
+        AUTOTEST_WARN("frametrace removed at compile time; skipping");
+        free(c);
+        flexframegen_destroy(fg);
+        flexframesync_destroy(fs);
+        return;
+    }
+    CONTEND_EQUALITY( frametrace_is_enabled(), 1 );
+
+    unsigned char header[14] = {0};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    float complex buf[64];
+    unsigned int n;
+    for (n=0; n<num_frames; n++) {
+        flexframegen_assemble(fg, header, payload, payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = flexframegen_write_samples(fg, buf, 64);
+            flexframesync_execute(fs, buf, 64);
+        }
+    }
+    memset(buf, 0x00, sizeof(buf));
+    for (i=0; i<4; i++)
+        flexframesync_execute(fs, buf, 64);
+
+    // records are delivered once drained
+    CONTEND_EQUALITY( c->num_records, 0 );
+    frametrace_disable();
+    CONTEND_EQUALITY( frametrace_is_enabled(), 0 );
+
+    // every frame is detected, then has its header and payload decoded,
+    // in order and with non-decreasing time stamps
+    unsigned int num_detected = 0, num_headers = 0, num_payloads = 0;
+    for (i=0; i<c->num_records; i++) {
+        frametrace_record_s * r = &c->records[i];
+        if (liquid_autotest_verbose) {
+            printf("  %12.6f  %-14s %-16s %d\n", r->time - c->records[0].time,
+                    r->object, frametrace_event_str(r->event), r->arg);
+        }
+        CONTEND_EXPRESSION( r->source == (void*)fs );
+        CONTEND_EQUALITY( strcmp(r->object, "flexframesync"), 0 );
+        if (i > 0)
+            CONTEND_EXPRESSION( r->time >= c->records[i-1].time );
+
+        switch (r->event) {
+        case LIQUID_FRAMETRACE_FRAME_DETECTED:
+            CONTEND_EQUALITY( num_detected, num_payloads );
+            num_detected++;
+            break;
+        case LIQUID_FRAMETRACE_HEADER_DECODED:
+            CONTEND_EQUALITY( r->arg, 1 );
+            num_headers++;
+            CONTEND_EQUALITY( num_headers, num_detected );
+            break;
+        case LIQUID_FRAMETRACE_PAYLOAD_DECODED:
+            CONTEND_EQUALITY( r->arg, 1 );
+            num_payloads++;
+            CONTEND_EQUALITY( num_payloads, num_headers );
+            break;
+        case LIQUID_FRAMETRACE_STATE:
+            break;
+        default:
+            AUTOTEST_FAIL("unexpected frametrace event");
+        }
+    }
+    CONTEND_EQUALITY( num_detected, num_frames );
+    CONTEND_EQUALITY( num_headers,  num_frames );
+    CONTEND_EQUALITY( num_payloads, num_frames );
+
+    // nothing is recorded while disabled
+    unsigned int num_records = c->num_records;
+    flexframesync_reset(fs);
+    frametrace_flush();
+    CONTEND_EQUALITY( c->num_records, num_records );
+
+    free(c);
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+// 
+// AUTOTEST : frametrace buffer drains when full; records left over
+//            from a previous session are discarded
+//
+void autotest_frametrace_drain()
+{
+    unsigned int num_events = 1000;
+    unsigned int i;
+
+    framesync64 fs = framesync64_create(frametrace_autotest_callback, NULL);
+    struct frametrace_autotest_s * c0 = (struct frametrace_autotest_s*) calloc(1, sizeof(struct frametrace_autotest_s));
+    struct frametrace_autotest_s * c1 = (struct frametrace_autotest_s*) calloc(1, sizeof(struct frametrace_autotest_s));
+    if (frametrace_enable(frametrace_autotest_drain, c0) != 0) {
+        AUTOTEST_WARN("frametrace removed at compile time; skipping");
+        free(c0);
+        free(c1);
+        framesync64_destroy(fs);
+        return;
+    }
+
+    // each reset records a state transition
+    for (i=0; i<num_events; i++)
+        framesync64_reset(fs);
+    CONTEND_EQUALITY( c0->num_drains,  num_events / FRAMETRACE_BUFFER_LEN );
+    CONTEND_EQUALITY( c0->max_drain,   FRAMETRACE_BUFFER_LEN );
+    CONTEND_EQUALITY( c0->num_records, FRAMETRACE_BUFFER_LEN*(num_events / FRAMETRACE_BUFFER_LEN) );
+    frametrace_flush();
+    CONTEND_EQUALITY( c0->num_records, num_events );
+    CONTEND_EQUALITY( c0->records[num_events-1].event, LIQUID_FRAMETRACE_STATE );
+
+    // re-enabling starts a new session, discarding buffered records
+    for (i=0; i<10; i++)
+        framesync64_reset(fs);
+    frametrace_enable(frametrace_autotest_drain, c1);
+    frametrace_flush();
+    CONTEND_EQUALITY( c0->num_records, num_events );
+    CONTEND_EQUALITY( c1->num_records, 0 );
+    for (i=0; i<5; i++)
+        framesync64_reset(fs);
+    frametrace_disable();
+    CONTEND_EQUALITY( c1->num_records, 5 );
+
+    free(c0);
+    free(c1);
+    framesync64_destroy(fs);
+}
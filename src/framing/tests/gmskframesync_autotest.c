@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// count frames with valid header and payload
+static int gmskframesync_autotest_callback(unsigned char *  _header,
+                                           int              _header_valid,
+                                           unsigned char *  _payload,
+                                           unsigned int     _payload_len,
+                                           int              _payload_valid,
+                                           framesyncstats_s _stats,
+                                           void *           _userdata)
+{
+    unsigned int * num_valid = (unsigned int*) _userdata;
+    if (_header_valid && _payload_valid)
+        (*num_valid)++;
+    return 0;
+}
+
+// helper function: recover frames through a carrier offset
+//  _fft        :   use FFT block detector?
+//  _gate       :   enable energy gate (FFT detector only)
+//  _dphi       :   carrier frequency offset [radians/sample]
+//  _dphi_max   :   FFT detector search range (ignored if zero)
+void gmskframesync_test(int   _fft,
+                        int   _gate,
+                        float _dphi,
+                        float _dphi_max)
+{
+    unsigned int num_frames  = 4;
+    unsigned int payload_len = 40;
+    float        nstd        = 0.03f;   // about 27 dB SNR
+    unsigned int i, n;
+
+    gmskframegen fg = gmskframegen_create();
+    unsigned int num_valid = 0;
+    gmskframesync fs = gmskframesync_create(gmskframesync_autotest_callback, &num_valid);
+    if (_fft)
+        gmskframesync_fft_detector_enable(fs);
+    if (_dphi_max > 0)
+        gmskframesync_fft_detector_set_range(fs, _dphi_max);
+    if (_gate)
+        gmskframesync_gate_enable(fs);
+
+    unsigned char header[8] = {0};
+    unsigned char payload[payload_len];
+    float complex buf[100];
+    float phi = 0.0f;
+    for (n=0; n<num_frames; n++) {
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        gmskframegen_assemble(fg, header, payload, payload_len,
+                              LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+        // frame, followed by a gap of noise
+        int frame_complete = 0;
+        unsigned int num_gap = 0;
+        while (num_gap < 1000) {
+            unsigned int num_written = 0;
+            if (!frame_complete) {
+                frame_complete = gmskframegen_write_block(fg, buf, 100, &num_written);
+            }
+            for (i=num_written; i<100; i++)
+                buf[i] = 0.0f;
+            num_gap += 100 - num_written;
+            for (i=0; i<100; i++) {
+                buf[i] = buf[i]*cexpf(_Complex_I*phi) +
+                         nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+                phi += _dphi;
+            }
+            gmskframesync_execute(fs, buf, 100);
+        }
+    }
+    if (liquid_autotest_verbose)
+        printf("  gmskframesync fft:%d gate:%d dphi:%6.3f : %u / %u frames, %u / %u blocks skipped\n",
+                _fft, _gate, _dphi, num_valid, num_frames,
+                gmskframesync_gate_get_num_skipped(fs),
+                gmskframesync_gate_get_num_blocks(fs));
+    CONTEND_EQUALITY(num_valid, num_frames);
+
+    // gate only bypasses blocks of the FFT detector
+    if (!_fft)
+        CONTEND_EQUALITY(gmskframesync_gate_get_num_blocks(fs), 0);
+    if (_fft && _gate)
+        CONTEND_GREATER_THAN(gmskframesync_gate_get_num_skipped(fs), 0);
+
+    gmskframegen_destroy(fg);
+    gmskframesync_destroy(fs);
+}
+
+void autotest_gmskframesync_time()       { gmskframesync_test(0, 0,  0.02f, 0.0f); }
+void autotest_gmskframesync_fft()        { gmskframesync_test(1, 0,  0.02f, 0.0f); }
+void autotest_gmskframesync_fft_gate()   { gmskframesync_test(1, 1, -0.03f, 0.0f); }
+void autotest_gmskframesync_fft_range()  { gmskframesync_test(1, 0,  0.08f, 0.1f); }
+
+
+// count valid headers delivered without payload, checking user data
+static int gmskframesync_autotest_header_callback(unsigned char *  _header,
+                                                  int              _header_valid,
+                                                  unsigned char *  _payload,
+                                                  unsigned int     _payload_len,
+                                                  int              _payload_valid,
+                                                  framesyncstats_s _stats,
+                                                  void *           _userdata)
+{
+    unsigned int * num_headers = (unsigned int*) _userdata;
+    if (_header_valid && _payload == NULL && _payload_len == 0 && !_payload_valid &&
+        _header[0] == *num_headers && _stats.check == LIQUID_CRC_32)
+    {
+        (*num_headers)++;
+    }
+    return 0;
+}
+
+// 
+// AUTOTEST : header-only mode recovers back-to-back frame headers
+//
+void autotest_gmskframesync_header_only()
+{
+    unsigned int num_frames  = 4;
+    unsigned int payload_len = 80;
+    float        nstd        = 0.03f;   // about 27 dB SNR
+    unsigned int i, n;
+
+    gmskframegen fg = gmskframegen_create();
+    unsigned int num_headers = 0;
+    gmskframesync fs = gmskframesync_create(gmskframesync_autotest_header_callback, &num_headers);
+    gmskframesync_set_header_only(fs, 1);
+    CONTEND_EQUALITY(gmskframesync_get_header_only(fs), 1);
+
+    unsigned char header[8] = {0};
+    unsigned char payload[payload_len];
+    float complex buf[100];
+    for (n=0; n<num_frames; n++) {
+        header[0] = n;
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        gmskframegen_assemble(fg, header, payload, payload_len,
+                              LIQUID_CRC_32, LIQUID_FEC_HAMMING128, LIQUID_FEC_NONE);
+
+        // frame, followed by a short gap of noise
+        int frame_complete = 0;
+        unsigned int num_gap = 0;
+        while (num_gap < 200) {
+            unsigned int num_written = 0;
+            if (!frame_complete)
+                frame_complete = gmskframegen_write_block(fg, buf, 100, &num_written);
+            for (i=num_written; i<100; i++)
+                buf[i] = 0.0f;
+            num_gap += 100 - num_written;
+            for (i=0; i<100; i++)
+                buf[i] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            gmskframesync_execute(fs, buf, 100);
+        }
+    }
+    if (liquid_autotest_verbose)
+        printf("  gmskframesync header-only : %u / %u headers\n", num_headers, num_frames);
+    CONTEND_EQUALITY(num_headers, num_frames);
+
+    gmskframegen_destroy(fg);
+    gmskframesync_destroy(fs);
+}
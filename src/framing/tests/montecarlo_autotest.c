@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// per-thread simulation state: frame generator, channel, synchronizer
+struct montecarlo_autotest_s {
+    flexframegen  fg;
+    flexframesync fs;
+    channel_cccf  ch;
+};
+
+// create per-thread state; _userdata points to the SNR [dB]
+void * montecarlo_autotest_create(void * _userdata)
+{
+    float SNRdB = *(float*)_userdata;
+    struct montecarlo_autotest_s * s = (struct montecarlo_autotest_s*) malloc(sizeof(struct montecarlo_autotest_s));
+
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_NONE;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    s->fg = flexframegen_create(&fgprops);
+    s->fs = flexframesync_create(NULL, NULL);
+    s->ch = channel_cccf_create();
+    channel_cccf_add_awgn(s->ch, -SNRdB, SNRdB);
+    return s;
+}
+
+// destroy per-thread state
+void montecarlo_autotest_destroy(void * _state)
+{
+    struct montecarlo_autotest_s * s = (struct montecarlo_autotest_s*) _state;
+    flexframegen_destroy(s->fg);
+    flexframesync_destroy(s->fs);
+    channel_cccf_destroy(s->ch);
+    free(s);
+}
+
+// send one packet through channel; returns 1 if payload was not received
+unsigned int montecarlo_autotest_trial(void *       _state,
+                                       unsigned int _seed)
+{
+    struct montecarlo_autotest_s * s = (struct montecarlo_autotest_s*) _state;
+    unsigned int payload_len = 64;
+    unsigned int i;
+
+    // payload and channel noise both derive from the trial seed
+    uint64_t rng;
+    randf_seed_r(&rng, _seed);
+    unsigned char header[14];
+    unsigned char payload[payload_len];
+    for (i=0; i<14; i++)          header[i]  = (unsigned char)(256*randf_r(&rng));
+    for (i=0; i<payload_len; i++) payload[i] = (unsigned char)(256*randf_r(&rng));
+    channel_cccf_set_seed(s->ch, _seed);
+
+    flexframesync_reset(s->fs);
+    flexframesync_reset_framedatastats(s->fs);
+    flexframegen_assemble(s->fg, header, payload, payload_len);
+
+    float complex x[256];
+    float complex y[256+8];
+    unsigned int ny;
+    int frame_complete = 0;
+    while (!frame_complete) {
+        frame_complete = flexframegen_write_samples(s->fg, x, 256);
+        channel_cccf_execute(s->ch, x, 256, y, &ny);
+        flexframesync_execute(s->fs, y, ny);
+    }
+
+    // flush channel and synchronizer with noise so no part of this
+    // frame is left in their buffers for the next trial
+    for (i=0; i<256; i++)
+        x[i] = 0.0f;
+    for (i=0; i<4; i++) {
+        channel_cccf_execute(s->ch, x, 256, y, &ny);
+        flexframesync_execute(s->fs, y, ny);
+    }
+
+    framedatastats_s stats = flexframesync_get_framedatastats(s->fs);
+    return stats.num_payloads_valid == 1 ? 0 : 1;
+}
+
+// packet error counts are independent of the number of threads
+void autotest_montecarlo_threads()
+{
+    unsigned int num_trials = 100;
+    float SNRdB = 7.0f;
+
+    unsigned long int e1 = montecarlo_run(montecarlo_autotest_create,
+                                          montecarlo_autotest_trial,
+                                          montecarlo_autotest_destroy,
+                                          &SNRdB, num_trials, 1, 1234);
+    unsigned long int e4 = montecarlo_run(montecarlo_autotest_create,
+                                          montecarlo_autotest_trial,
+                                          montecarlo_autotest_destroy,
+                                          &SNRdB, num_trials, 4, 1234);
+    if (liquid_autotest_verbose)
+        printf("  SNR %5.1f dB: %lu / %u packet errors\n", SNRdB, e1, num_trials);
+
+    CONTEND_EQUALITY(e1, e4);
+
+    // operating point yields some, but not all, packet errors
+    CONTEND_GREATER_THAN(e1, 0);
+    CONTEND_LESS_THAN(e1, num_trials);
+}
+
+// packet error rate decreases with SNR
+void autotest_montecarlo_per()
+{
+    unsigned int num_trials = 100;
+    float SNRdB[3] = {4.0f, 7.0f, 12.0f};
+    unsigned long int e[3];
+    unsigned int i;
+    for (i=0; i<3; i++) {
+        e[i] = montecarlo_run(montecarlo_autotest_create,
+                              montecarlo_autotest_trial,
+                              montecarlo_autotest_destroy,
+                              &SNRdB[i], num_trials, 4, 0);
+        if (liquid_autotest_verbose)
+            printf("  SNR %5.1f dB: %lu / %u packet errors\n", SNRdB[i], e[i], num_trials);
+    }
+    CONTEND_GREATER_THAN(e[0], e[1]);
+    CONTEND_EQUALITY(e[2], 0);
+}
+
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// create source with tone, modem and (optionally) noise signals; noise
+// and modem signals are seeded through randf_seed()
+static msourcecf msource_autotest_create(unsigned int _seed,
+                                         int          _noise)
+{
+    randf_seed(_seed);
+    msourcecf q = msourcecf_create();
+    int id_tone  = msourcecf_add_tone(q);
+    int id_modem = msourcecf_add_modem(q, LIQUID_MODEM_QPSK, 4, 9, 0.3f);
+    msourcecf_set_frequency(q, id_tone,   0.7f);
+    msourcecf_set_gain     (q, id_tone,  -6.0f);
+    msourcecf_set_frequency(q, id_modem,  0.3f);
+    if (_noise) {
+        int id_noise = msourcecf_add_noise(q, 0.2f);
+        msourcecf_set_frequency(q, id_noise, -1.1f);
+        msourcecf_set_gain     (q, id_noise, -3.0f);
+    }
+    return q;
+}
+
+// output is independent of how the caller splits its buffer (noise is
+// excluded: its Gauss generator redraws rejected samples at the end of
+// each block, so the sequence depends on block boundaries)
+void autotest_msourcecf_chunking()
+{
+    unsigned int n = 5000;
+    float complex y0[n];
+    float complex y1[n];
+
+    // single call
+    msourcecf q0 = msource_autotest_create(1234, 0);
+    msourcecf_write_samples(q0, y0, n);
+    msourcecf_destroy(q0);
+
+    // uneven calls straddling internal block boundaries
+    msourcecf q1 = msource_autotest_create(1234, 0);
+    unsigned int lengths[] = {1, 17, 1023, 1, 2000, 511, 0, 1447};
+    unsigned int i, num_written = 0;
+    for (i=0; i<sizeof(lengths)/sizeof(lengths[0]); i++) {
+        msourcecf_write_samples(q1, y1 + num_written, lengths[i]);
+        num_written += lengths[i];
+    }
+    msourcecf_destroy(q1);
+
+    // carrier phase may differ in the last bit across block boundaries
+    CONTEND_EQUALITY(num_written, n);
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), 1e-5f);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), 1e-5f);
+    }
+}
+
+// single tone matches gain*exp(j*dphi*n)
+void autotest_msourcecf_tone()
+{
+    unsigned int n     = 3000;
+    float        dphi  = 0.123f;
+    float        g_dB  = -10.0f;
+    float        g     = powf(10.0f, g_dB/20.0f);
+    float        tol   = 1e-3f;
+
+    msourcecf q = msourcecf_create();
+    int id = msourcecf_add_tone(q);
+    msourcecf_set_frequency(q, id, dphi);
+    msourcecf_set_gain     (q, id, g_dB);
+
+    float complex y[n];
+    msourcecf_write_samples(q, y, n);
+    msourcecf_destroy(q);
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        float complex v = g * cexpf(_Complex_I*dphi*(float)i);
+        CONTEND_DELTA(crealf(y[i]), crealf(v), tol);
+        CONTEND_DELTA(cimagf(y[i]), cimagf(v), tol);
+    }
+
+    // empty source writes zeros
+    q = msourcecf_create();
+    msourcecf_write_samples(q, y, n);
+    msourcecf_destroy(q);
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY(y[i], 0.0f);
+}
+
+// sources generated in parallel give the same output as in serial
+void autotest_msourcecf_threads()
+{
+    unsigned int n = 4000;
+    float complex y0[n];
+    float complex y1[n];
+
+    msourcecf q0 = msource_autotest_create(77, 1);
+    msourcecf_write_samples(q0, y0, 1000);
+    msourcecf_write_samples(q0, y0 + 1000, n - 1000);
+    msourcecf_destroy(q0);
+
+    msourcecf q1 = msource_autotest_create(77, 1);
+    msourcecf_set_num_threads(q1, 3);
+    msourcecf_write_samples(q1, y1, 1000);
+    msourcecf_set_num_threads(q1, 2);
+    msourcecf_write_samples(q1, y1 + 1000, n - 1000);
+    msourcecf_destroy(q1);
+
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float complex));
+}
+
@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// count valid payloads
+static int ofdmflexframesync_autotest_callback(unsigned char *  _header,
+                                               int              _header_valid,
+                                               unsigned char *  _payload,
+                                               unsigned int     _payload_len,
+                                               int              _payload_valid,
+                                               framesyncstats_s _stats,
+                                               void *           _userdata)
+{
+    unsigned int * num_valid = (unsigned int*) _userdata;
+    if (_header_valid && _payload_valid)
+        (*num_valid)++;
+    return 0;
+}
+
+// helper function: transmit frames through noise, returning the number
+// of payloads recovered
+//  _soft       :   soft-decision payload decoding?
+//  _SNRdB      :   signal-to-noise ratio [dB]
+//  _num_frames :   number of frames to transmit
+unsigned int ofdmflexframesync_autotest_run(int          _soft,
+                                            float        _SNRdB,
+                                            unsigned int _num_frames)
+{
+    unsigned int M           = 64;      // number of subcarriers
+    unsigned int cp_len      = 16;      // cyclic prefix length
+    unsigned int taper_len   = 4;       // taper length
+    unsigned int payload_len = 200;     // payload length [bytes]
+    float        nstd        = powf(10.0f, -_SNRdB/20.0f);
+    unsigned int i, j;
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    // frame generator with soft-decodable outer code
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = LIQUID_FEC_NONE;
+    fgprops.fec1       = LIQUID_FEC_HAMMING74;
+    fgprops.mod_scheme = LIQUID_MODEM_QPSK;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, p, &fgprops);
+
+    unsigned int num_valid = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, p,
+                                                    ofdmflexframesync_autotest_callback,
+                                                    (void*)&num_valid);
+    ofdmflexframesync_set_payload_soft(fs, _soft);
+    CONTEND_EQUALITY( ofdmflexframesync_get_payload_soft(fs), _soft );
+
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    float complex buffer[M + cp_len];
+    for (i=0; i<_num_frames; i++) {
+        for (j=0; j<payload_len; j++)
+            payload[j] = rand() & 0xff;
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+        // write frame followed by noise-only symbols to flush receiver
+        int last_symbol = 0;
+        unsigned int num_flush = 0;
+        while (num_flush < 2) {
+            if (!last_symbol) {
+                last_symbol = ofdmflexframegen_writesymbol(fg, buffer);
+            } else {
+                for (j=0; j<M+cp_len; j++)
+                    buffer[j] = 0.0f;
+                num_flush++;
+            }
+            for (j=0; j<M+cp_len; j++)
+                buffer[j] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            ofdmflexframesync_execute(fs, buffer, M+cp_len);
+        }
+    }
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+    return num_valid;
+}
+
+// 
+// AUTOTEST : frames recovered at high SNR in either decoding mode, and
+//            soft-decision decoding recovers more frames at low SNR
+//
+void autotest_ofdmflexframesync_soft()
+{
+    unsigned int num_frames = 40;
+
+    CONTEND_EQUALITY( ofdmflexframesync_autotest_run(0, 20.0f, 4), 4 );
+    CONTEND_EQUALITY( ofdmflexframesync_autotest_run(1, 20.0f, 4), 4 );
+
+    unsigned int num_hard = ofdmflexframesync_autotest_run(0, 7.0f, num_frames);
+    unsigned int num_soft = ofdmflexframesync_autotest_run(1, 7.0f, num_frames);
+    if (liquid_autotest_verbose)
+        printf("  SNR 7 dB: hard %u / %u, soft %u / %u\n", num_hard, num_frames, num_soft, num_frames);
+    CONTEND_GREATER_THAN( num_soft, num_hard );
+}
+
+// record of frames delivered to callback
+struct ofdmflexframesync_autotest_log_s {
+    unsigned int num_frames;        // number of frames delivered
+    unsigned int index[64];         // frame index (from header)
+    int          valid[64];         // payload valid flag
+    unsigned int checksum[64];      // sum over payload bytes
+};
+
+// log each delivered frame
+static int ofdmflexframesync_autotest_log_callback(unsigned char *  _header,
+                                                   int              _header_valid,
+                                                   unsigned char *  _payload,
+                                                   unsigned int     _payload_len,
+                                                   int              _payload_valid,
+                                                   framesyncstats_s _stats,
+                                                   void *           _userdata)
+{
+    struct ofdmflexframesync_autotest_log_s * log = (struct ofdmflexframesync_autotest_log_s*) _userdata;
+    if (log->num_frames == 64)
+        return 0;
+
+    unsigned int i;
+    unsigned int checksum = 0;
+    for (i=0; i<_payload_len; i++)
+        checksum += _payload[i];
+
+    log->index[log->num_frames]    = _header_valid ? _header[0] : 0xffff;
+    log->valid[log->num_frames]    = _payload_valid;
+    log->checksum[log->num_frames] = checksum;
+    log->num_frames++;
+    return 0;
+}
+
+// helper function: transmit frames of varying length and modulation,
+// logging the frames delivered to the callback
+//  _num_threads    :   number of payload decode threads (0: inline)
+//  _batch          :   OFDM symbols demodulated per block (0: per-symbol)
+//  _SNRdB          :   signal-to-noise ratio [dB]
+//  _num_frames     :   number of frames to transmit
+//  _log            :   frame log
+void ofdmflexframesync_autotest_run_pipeline(unsigned int _num_threads,
+                                             unsigned int _batch,
+                                             float        _SNRdB,
+                                             unsigned int _num_frames,
+                                             struct ofdmflexframesync_autotest_log_s * _log)
+{
+    unsigned int M           = 64;      // number of subcarriers
+    unsigned int cp_len      = 16;      // cyclic prefix length
+    unsigned int taper_len   = 4;       // taper length
+    float        nstd        = powf(10.0f, -_SNRdB/20.0f);
+    unsigned int i, j;
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = LIQUID_FEC_NONE;
+    fgprops.fec1       = LIQUID_FEC_HAMMING74;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, p, &fgprops);
+
+    _log->num_frames = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, p,
+                                                    ofdmflexframesync_autotest_log_callback,
+                                                    (void*)_log);
+    ofdmflexframesync_set_payload_soft(fs, 1);
+    ofdmflexframesync_set_decode_threads(fs, _num_threads);
+    ofdmflexframesync_set_symbol_batch(fs, _batch);
+
+    // reproducible noise for comparison between runs
+    srand(1);
+    randf_seed(1);
+
+    modulation_scheme ms[3] = {LIQUID_MODEM_QPSK, LIQUID_MODEM_QAM16, LIQUID_MODEM_BPSK};
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[400];
+    float complex buffer[M + cp_len];
+    for (i=0; i<_num_frames; i++) {
+        unsigned int payload_len = 40 + 60*(i % 6);
+        for (j=0; j<payload_len; j++)
+            payload[j] = rand() & 0xff;
+        header[0] = i;
+        fgprops.mod_scheme = ms[i % 3];
+        ofdmflexframegen_setprops(fg, &fgprops);
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+        // write frame followed by noise-only symbols to flush receiver
+        int last_symbol = 0;
+        unsigned int num_flush = 0;
+        while (num_flush < 2) {
+            if (!last_symbol) {
+                last_symbol = ofdmflexframegen_writesymbol(fg, buffer);
+            } else {
+                for (j=0; j<M+cp_len; j++)
+                    buffer[j] = 0.0f;
+                num_flush++;
+            }
+            for (j=0; j<M+cp_len; j++)
+                buffer[j] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            ofdmflexframesync_execute(fs, buffer, M+cp_len);
+        }
+    }
+
+    // wait for outstanding frames
+    ofdmflexframesync_wait(fs);
+    CONTEND_EQUALITY( ofdmflexframesync_get_decode_threads(fs), _num_threads );
+    CONTEND_EQUALITY( ofdmflexframesync_get_symbol_batch(fs),   _batch );
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+// 
+// AUTOTEST : pipelined payload decoding delivers the same frames as
+//            inline decoding, in the order they were received
+//
+void autotest_ofdmflexframesync_pipeline()
+{
+    unsigned int num_frames = 24;
+    struct ofdmflexframesync_autotest_log_s log0;
+    struct ofdmflexframesync_autotest_log_s log1;
+
+    // high SNR: every frame recovered, in order
+    ofdmflexframesync_autotest_run_pipeline(3, 0, 20.0f, num_frames, &log1);
+    CONTEND_EQUALITY( log1.num_frames, num_frames );
+    unsigned int i;
+    for (i=0; i<log1.num_frames; i++) {
+        CONTEND_EQUALITY( log1.index[i], i );
+        CONTEND_EQUALITY( log1.valid[i], 1 );
+    }
+
+    // low SNR: identical to inline decoding
+    ofdmflexframesync_autotest_run_pipeline(0, 0, 9.0f, num_frames, &log0);
+    ofdmflexframesync_autotest_run_pipeline(3, 0, 9.0f, num_frames, &log1);
+    if (liquid_autotest_verbose) {
+        unsigned int num_valid = 0;
+        for (i=0; i<log0.num_frames; i++)
+            num_valid += log0.valid[i];
+        printf("  SNR 9 dB: %u frames delivered, %u valid\n", log0.num_frames, num_valid);
+    }
+    CONTEND_EQUALITY( log1.num_frames, log0.num_frames );
+    for (i=0; i<log0.num_frames && i<log1.num_frames; i++) {
+        CONTEND_EQUALITY( log1.index[i],    log0.index[i]    );
+        CONTEND_EQUALITY( log1.valid[i],    log0.valid[i]    );
+        CONTEND_EQUALITY( log1.checksum[i], log0.checksum[i] );
+    }
+}
+
+// 
+// AUTOTEST : demodulating batches of OFDM symbols delivers the same
+//            frames as per-symbol demodulation
+//
+void autotest_ofdmflexframesync_symbol_batch()
+{
+    unsigned int num_frames = 24;
+    struct ofdmflexframesync_autotest_log_s log0;
+    struct ofdmflexframesync_autotest_log_s log1;
+
+    ofdmflexframesync_autotest_run_pipeline(0, 0, 9.0f, num_frames, &log0);
+
+    unsigned int batch[4] = {1, 3, 8, 64};
+    unsigned int i, k;
+    for (k=0; k<4; k++) {
+        ofdmflexframesync_autotest_run_pipeline(k % 2 ? 2 : 0, batch[k], 9.0f, num_frames, &log1);
+        CONTEND_EQUALITY( log1.num_frames, log0.num_frames );
+        for (i=0; i<log0.num_frames && i<log1.num_frames; i++) {
+            CONTEND_EQUALITY( log1.index[i],    log0.index[i]    );
+            CONTEND_EQUALITY( log1.valid[i],    log0.valid[i]    );
+            CONTEND_EQUALITY( log1.checksum[i], log0.checksum[i] );
+        }
+    }
+}
+
+// count valid headers delivered without payload, checking user data
+static int ofdmflexframesync_autotest_header_callback(unsigned char *  _header,
+                                                      int              _header_valid,
+                                                      unsigned char *  _payload,
+                                                      unsigned int     _payload_len,
+                                                      int              _payload_valid,
+                                                      framesyncstats_s _stats,
+                                                      void *           _userdata)
+{
+    unsigned int * num_headers = (unsigned int*) _userdata;
+    if (_header_valid && _payload == NULL && _payload_len == 0 && !_payload_valid &&
+        _header[0] == (*num_headers & 0xff) && _stats.mod_scheme == LIQUID_MODEM_QPSK)
+    {
+        (*num_headers)++;
+    }
+    return 0;
+}
+
+// helper function: recover back-to-back frame headers in header-only
+// mode, returning the number of headers delivered
+//  _batch      :   symbol batch size (0: per-symbol)
+//  _num_frames :   number of frames to transmit
+unsigned int ofdmflexframesync_autotest_run_header_only(unsigned int _batch,
+                                                        unsigned int _num_frames)
+{
+    unsigned int M           = 64;      // number of subcarriers
+    unsigned int cp_len      = 16;      // cyclic prefix length
+    unsigned int taper_len   = 4;       // taper length
+    unsigned int payload_len = 400;     // payload length [bytes]
+    float        nstd        = 0.01f;   // noise standard deviation
+    unsigned int i, j;
+
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.fec1       = LIQUID_FEC_HAMMING74;
+    fgprops.mod_scheme = LIQUID_MODEM_QPSK;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, &fgprops);
+
+    unsigned int num_headers = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL,
+                                                    ofdmflexframesync_autotest_header_callback,
+                                                    (void*)&num_headers);
+    ofdmflexframesync_set_header_only(fs, 1);
+    CONTEND_EQUALITY( ofdmflexframesync_get_header_only(fs), 1 );
+    if (_batch > 0)
+        ofdmflexframesync_set_symbol_batch(fs, _batch);
+
+    unsigned char header[8] = {0};
+    unsigned char payload[payload_len];
+    float complex buffer[M + cp_len];
+    for (i=0; i<_num_frames; i++) {
+        header[0] = i & 0xff;
+        for (j=0; j<payload_len; j++)
+            payload[j] = rand() & 0xff;
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+        // write frame followed by a single noise-only symbol
+        int last_symbol = 0;
+        unsigned int num_flush = 0;
+        while (num_flush < 1) {
+            if (!last_symbol) {
+                last_symbol = ofdmflexframegen_writesymbol(fg, buffer);
+            } else {
+                for (j=0; j<M+cp_len; j++)
+                    buffer[j] = 0.0f;
+                num_flush++;
+            }
+            for (j=0; j<M+cp_len; j++)
+                buffer[j] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            ofdmflexframesync_execute(fs, buffer, M+cp_len);
+        }
+    }
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+    return num_headers;
+}
+
+// 
+// AUTOTEST : header-only mode recovers back-to-back frame headers,
+//            with and without symbol batching
+//
+void autotest_ofdmflexframesync_header_only()
+{
+    unsigned int num_frames = 8;
+    CONTEND_EQUALITY( ofdmflexframesync_autotest_run_header_only(0, num_frames), num_frames );
+    CONTEND_EQUALITY( ofdmflexframesync_autotest_run_header_only(4, num_frames), num_frames );
+}
+
+//
+// AUTOTEST : frames recovered from interleaved 16-bit samples
+//
+void autotest_ofdmflexframesync_ci16()
+{
+    unsigned int M           = 64;      // number of subcarriers
+    unsigned int cp_len      = 16;      // cyclic prefix length
+    unsigned int taper_len   = 4;       // taper length
+    unsigned int payload_len = 120;     // payload length [bytes]
+    unsigned int num_frames  = 3;       // number of frames
+    float        g           = 1.0f / 32768.0f;
+    unsigned int i, j;
+
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, NULL);
+    unsigned int num_valid = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL,
+                                                    ofdmflexframesync_autotest_callback,
+                                                    (void*)&num_valid);
+
+    // quantize each frame to 16 bits at roughly -20 dBFS; samples are
+    // delivered in calls which span several internal blocks
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    float complex buffer[M + cp_len];
+    int16_t x[2*4*(M + cp_len)];
+    unsigned int n = 0;
+    for (i=0; i<num_frames; i++) {
+        for (j=0; j<payload_len; j++)
+            payload[j] = rand() & 0xff;
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+        int last_symbol = 0;
+        unsigned int num_flush = 0;
+        while (num_flush < 2) {
+            if (!last_symbol) {
+                last_symbol = ofdmflexframegen_writesymbol(fg, buffer);
+            } else {
+                for (j=0; j<M+cp_len; j++)
+                    buffer[j] = 0.0f;
+                num_flush++;
+            }
+            for (j=0; j<M+cp_len; j++) {
+                x[2*n  ] = (int16_t) lrintf(3000.0f * crealf(buffer[j]));
+                x[2*n+1] = (int16_t) lrintf(3000.0f * cimagf(buffer[j]));
+                n++;
+            }
+            if (n == 4*(M+cp_len)) {
+                ofdmflexframesync_execute_ci16(fs, x, n, g);
+                n = 0;
+            }
+        }
+    }
+    ofdmflexframesync_execute_ci16(fs, x, n, g);
+
+    CONTEND_EQUALITY( num_valid, num_frames );
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
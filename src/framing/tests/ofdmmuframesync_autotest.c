@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// record of frames delivered to one user
+struct ofdmmuframesync_autotest_s {
+    unsigned int   user;            // user index
+    unsigned int   num_frames;      // number of frames delivered
+    unsigned int   num_valid;       // number of valid payloads matching
+    unsigned int   num_invalid;     // number of invalid headers
+    unsigned char  payload[512];    // expected payload
+    unsigned int   payload_len;     // expected payload length
+};
+
+static int ofdmmuframesync_autotest_callback(unsigned char *  _header,
+                                             int              _header_valid,
+                                             unsigned char *  _payload,
+                                             unsigned int     _payload_len,
+                                             int              _payload_valid,
+                                             framesyncstats_s _stats,
+                                             void *           _userdata)
+{
+    struct ofdmmuframesync_autotest_s * r = (struct ofdmmuframesync_autotest_s*) _userdata;
+    r->num_frames++;
+    if (!_header_valid) {
+        r->num_invalid++;
+        return 0;
+    }
+    if (_payload_valid && _header[0] == r->user && _payload_len == r->payload_len &&
+        memcmp(_payload, r->payload, _payload_len) == 0)
+    {
+        r->num_valid++;
+    }
+    return 0;
+}
+
+// 
+// AUTOTEST : users on interleaved subcarriers with different payload
+//            lengths and modulation schemes are recovered through a
+//            single synchronizer; an unassembled user sees an invalid
+//            header once per frame
+//
+void autotest_ofdmmuframesync()
+{
+    unsigned int M          = 64;   // number of subcarriers
+    unsigned int cp_len     = 16;   // cyclic prefix length
+    unsigned int taper_len  = 4;    // taper length
+    unsigned int num_users  = 4;    // number of users (last one idle)
+    unsigned int num_frames = 3;    // number of frames
+    float        nstd       = 0.01f;
+    unsigned int payload_len[4] = {120, 37, 240, 0};
+    modulation_scheme ms[4] = {LIQUID_MODEM_QPSK, LIQUID_MODEM_BPSK, LIQUID_MODEM_QAM16, LIQUID_MODEM_QPSK};
+    unsigned int i, j, n;
+
+    // allocate data subcarriers to users in turn
+    unsigned char p[M];
+    unsigned char user_map[M];
+    ofdmframe_init_default_sctype(M, p);
+    for (i=0, n=0; i<M; i++)
+        user_map[i] = p[i] == OFDMFRAME_SCTYPE_DATA ? (n++) % num_users : 0;
+
+    ofdmmuframegen fg = ofdmmuframegen_create(M, cp_len, taper_len, p, num_users, user_map);
+    CONTEND_EQUALITY( ofdmmuframegen_get_num_users(fg), num_users );
+
+    struct ofdmmuframesync_autotest_s r[4];
+    framesync_callback callbacks[4];
+    void * userdata[4];
+    for (i=0; i<num_users; i++) {
+        memset(&r[i], 0x00, sizeof(struct ofdmmuframesync_autotest_s));
+        r[i].user = i;
+        callbacks[i] = ofdmmuframesync_autotest_callback;
+        userdata[i]  = (void*)&r[i];
+
+        ofdmflexframegenprops_s props;
+        ofdmflexframegenprops_init_default(&props);
+        props.mod_scheme = ms[i];
+        props.fec0       = LIQUID_FEC_HAMMING74;
+        ofdmmuframegen_setprops(fg, i, &props);
+    }
+    ofdmmuframesync fs = ofdmmuframesync_create(M, cp_len, taper_len, p, num_users,
+                                                user_map, callbacks, userdata);
+
+    float complex buffer[M + cp_len];
+    for (i=0; i<num_frames; i++) {
+        // assemble all but the last user
+        for (j=0; j+1<num_users; j++) {
+            unsigned char header[8] = {j, 1, 2, 3, 4, 5, 6, 7};
+            r[j].payload_len = payload_len[j];
+            for (n=0; n<payload_len[j]; n++)
+                r[j].payload[n] = rand() & 0xff;
+            ofdmmuframegen_assemble(fg, j, header, r[j].payload, payload_len[j]);
+        }
+
+        // write frame followed by noise-only symbols to flush receiver
+        int last_symbol = 0;
+        unsigned int num_flush = 0;
+        while (num_flush < 2) {
+            if (!last_symbol) {
+                last_symbol = ofdmmuframegen_writesymbol(fg, buffer);
+            } else {
+                for (j=0; j<M+cp_len; j++)
+                    buffer[j] = 0.0f;
+                num_flush++;
+            }
+            for (j=0; j<M+cp_len; j++)
+                buffer[j] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            ofdmmuframesync_execute(fs, buffer, M+cp_len);
+        }
+    }
+
+    for (i=0; i<num_users; i++) {
+        if (liquid_autotest_verbose)
+            printf("  user %u : %u frames, %u valid, %u invalid headers\n",
+                    i, r[i].num_frames, r[i].num_valid, r[i].num_invalid);
+        CONTEND_EQUALITY( r[i].num_frames, num_frames );
+        CONTEND_EQUALITY( r[i].num_valid,   i+1 < num_users ? num_frames : 0 );
+        CONTEND_EQUALITY( r[i].num_invalid, i+1 < num_users ? 0 : num_frames );
+    }
+
+    ofdmmuframegen_destroy(fg);
+    ofdmmuframesync_destroy(fs);
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// reference binary correlation: strongest hypothesis computed directly
+// on +/-1 sign values, one sample at a time
+static void presync_autotest_reference(float complex * _v,
+                                       float complex * _x,
+                                       unsigned int    _n,
+                                       float           _dphi_max,
+                                       unsigned int    _m,
+                                       float complex * _rxy,
+                                       float *         _dphi_hat)
+{
+    float abs_rxy_max = 0.0f;
+    *_rxy = 0.0f;
+    *_dphi_hat = 0.0f;
+    unsigned int i, k;
+    for (i=0; i<_m; i++) {
+        float dphi = (float)i / (float)(_m-1)*_dphi_max;
+        int rxy_ii=0, rxy_qq=0, rxy_iq=0, rxy_qi=0;
+        for (k=0; k<_n; k++) {
+            float complex v_prime = _v[k] * cexpf(-_Complex_I*k*dphi);
+            int si = crealf(v_prime) > 0 ? 1 : -1;
+            int sq = cimagf(v_prime) > 0 ? 1 : -1;
+            int ri = crealf(_x[k])   > 0 ? 1 : -1;
+            int rq = cimagf(_x[k])   > 0 ? 1 : -1;
+            rxy_ii += si*ri;
+            rxy_qq += sq*rq;
+            rxy_iq += si*rq;
+            rxy_qi += sq*ri;
+        }
+        float complex rxy0 = ((rxy_ii - rxy_qq) + (rxy_iq + rxy_qi)*_Complex_I) / (float)_n;
+        float complex rxy1 = ((rxy_ii + rxy_qq) + (rxy_iq - rxy_qi)*_Complex_I) / (float)_n;
+        if (cabsf(rxy0) > abs_rxy_max) { abs_rxy_max = cabsf(rxy0); *_rxy = rxy0; *_dphi_hat =  dphi; }
+        if (cabsf(rxy1) > abs_rxy_max) { abs_rxy_max = cabsf(rxy1); *_rxy = rxy1; *_dphi_hat = -dphi; }
+    }
+}
+
+// packed 64-bit sign correlator against direct computation, for
+// lengths below, at and across word boundaries
+void bpresync_cccf_test_reference(unsigned int _n)
+{
+    unsigned int m        = 5;
+    float        dphi_max = 0.08f;
+
+    float complex v[_n];
+    float complex x[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        v[i] = (rand() % 2 ? 1.0f : -1.0f) + (rand() % 2 ? 1.0f : -1.0f)*_Complex_I;
+        x[i] = randnf() + randnf()*_Complex_I;
+    }
+
+    bpresync_cccf q = bpresync_cccf_create(v, _n, dphi_max, m);
+    for (i=0; i<_n; i++)
+        bpresync_cccf_push(q, x[i]);
+
+    float complex rxy;
+    float         dphi_hat;
+    bpresync_cccf_correlate(q, &rxy, &dphi_hat);
+
+    float complex rxy_ref;
+    float         dphi_hat_ref;
+    presync_autotest_reference(v, x, _n, dphi_max, m, &rxy_ref, &dphi_hat_ref);
+
+    CONTEND_DELTA( crealf(rxy), crealf(rxy_ref), 1e-6f );
+    CONTEND_DELTA( cimagf(rxy), cimagf(rxy_ref), 1e-6f );
+    CONTEND_DELTA( dphi_hat,    dphi_hat_ref,    1e-6f );
+
+    bpresync_cccf_destroy(q);
+}
+void autotest_bpresync_cccf_reference_n17()  { bpresync_cccf_test_reference( 17); }
+void autotest_bpresync_cccf_reference_n64()  { bpresync_cccf_test_reference( 64); }
+void autotest_bpresync_cccf_reference_n100() { bpresync_cccf_test_reference(100); }
+
+// matched sequence with carrier offset on one of the hypotheses: the
+// coarse search must land on the peak and the correlation must be
+// strong (unity for presync; the binary product is not normalized
+// by the I/Q energy so bpresync reaches 2)
+void presync_cccf_test_peak(int _binary)
+{
+    unsigned int n        = 128;
+    unsigned int m        = 6;
+    float        dphi_max = 0.05f;
+    float        dphi     = 0.03f;  // hypothesis 3
+
+    float complex v[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        v[i] = ((rand() % 2 ? 1.0f : -1.0f) + (rand() % 2 ? 1.0f : -1.0f)*_Complex_I) * M_SQRT1_2;
+
+    presync_cccf  q0 = presync_cccf_create (v, n, dphi_max, m);
+    bpresync_cccf q1 = bpresync_cccf_create(v, n, dphi_max, m);
+
+    float complex rxy;
+    float         dphi_hat;
+    for (i=0; i<n; i++) {
+        float complex x = conjf(v[i]) * cexpf(_Complex_I*dphi*i);
+        if (_binary) bpresync_cccf_push(q1, x);
+        else         presync_cccf_push (q0, x);
+    }
+    if (_binary) bpresync_cccf_correlate(q1, &rxy, &dphi_hat);
+    else         presync_cccf_correlate (q0, &rxy, &dphi_hat);
+
+    if (liquid_autotest_verbose)
+        printf("%s: |rxy| = %8.5f, dphi_hat = %8.5f\n", _binary ? "bpresync" : "presync", cabsf(rxy), dphi_hat);
+
+    CONTEND_DELTA( fabsf(dphi_hat), dphi, 1e-4f );
+    CONTEND_GREATER_THAN( cabsf(rxy), _binary ? 0.9f : 0.99f );
+
+    presync_cccf_destroy(q0);
+    bpresync_cccf_destroy(q1);
+}
+void autotest_presync_cccf_peak()  { presync_cccf_test_peak(0); }
+void autotest_bpresync_cccf_peak() { presync_cccf_test_peak(1); }
+
@@ -306,3 +306,207 @@ void qdetector_cccf_runtest_gmsk(unsigned int _sequence_len)
 }
 
 
+
+// 
+// AUTOTEST : energy gate bypasses correlation on noise, tracks noise
+//            floor, and still detects sequence
+//
+void autotest_qdetector_cccf_gate()
+{
+    unsigned int sequence_len =    64;     // sequence length
+    unsigned int k            =     2;     // samples per symbol
+    unsigned int m            =     7;     // filter delay [symbols]
+    float        beta         =  0.3f;     // excess bandwidth factor
+    int          ftype        = LIQUID_FIRFILT_ARKAISER; // filter type
+    float        nstd         = 0.1f;      // noise standard deviation (-20 dB)
+    unsigned int num_idle     = 20000;     // idle (noise-only) samples
+    unsigned int i;
+
+    // generate synchronization sequence (QPSK symbols)
+    float complex sequence[sequence_len];
+    for (i=0; i<sequence_len; i++) {
+        sequence[i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                      (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+    }
+
+    // create detector with gate enabled
+    qdetector_cccf q = qdetector_cccf_create_linear(sequence, sequence_len, ftype, k, m, beta);
+    qdetector_cccf_gate_enable(q);
+    CONTEND_EQUALITY( qdetector_cccf_gate_is_enabled(q), 1 );
+
+    // run idle period; no frame should be detected
+    int false_positive = 0;
+    for (i=0; i<num_idle; i++) {
+        float complex x = nstd*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+        if (qdetector_cccf_execute(q, x) != NULL)
+            false_positive = 1;
+    }
+    unsigned int num_blocks  = qdetector_cccf_gate_get_num_blocks (q);
+    unsigned int num_skipped = qdetector_cccf_gate_get_num_skipped(q);
+    float        noise_floor = qdetector_cccf_gate_get_noise_floor(q);
+
+    // push sequence followed by random symbols through detector
+    firinterp_crcf interp = firinterp_crcf_create_prototype(ftype, k, m, beta, 0);
+    int frame_detected = 0;
+    float complex y[k];
+    for (i=0; i<4*sequence_len && !frame_detected; i++) {
+        float complex sym = i < sequence_len ? sequence[i] : sequence[rand()%sequence_len];
+        firinterp_crcf_execute(interp, sym, y);
+        unsigned int j;
+        for (j=0; j<k; j++) {
+            y[j] += nstd*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+            if (qdetector_cccf_execute(q, y[j]) != NULL)
+                frame_detected = 1;
+        }
+    }
+    firinterp_crcf_destroy(interp);
+
+    if (liquid_autotest_verbose) {
+        qdetector_cccf_print(q);
+        printf("  skipped %u / %u idle blocks, noise floor %.2f dB\n",
+                num_skipped, num_blocks, noise_floor);
+    }
+
+    CONTEND_EQUALITY( false_positive, 0 );
+    CONTEND_EQUALITY( frame_detected, 1 );
+    CONTEND_GREATER_THAN( num_skipped, 0.9f*num_blocks );
+    CONTEND_DELTA( noise_floor, -20.0f, 1.0f );
+
+    // disabling gate runs every block
+    qdetector_cccf_gate_disable(q);
+    qdetector_cccf_gate_reset_stats(q);
+    for (i=0; i<4096; i++)
+        qdetector_cccf_execute(q, nstd*(randnf() + _Complex_I*randnf()) * M_SQRT1_2);
+    CONTEND_EQUALITY( qdetector_cccf_gate_get_num_skipped(q), 0 );
+    CONTEND_GREATER_THAN( qdetector_cccf_gate_get_num_blocks(q), 0 );
+
+    qdetector_cccf_destroy(q);
+}
+
+// autotest helper function: detect sequence with carrier offset using
+// coarse-to-fine carrier offset search
+//  _step   :   carrier offset search grid step
+//  _dphi   :   carrier frequency offset [radians/sample]
+//  _offload:   sweep grid through offload queue?
+void qdetector_cccf_runtest_range_step(unsigned int _step,
+                                       float        _dphi,
+                                       int          _offload)
+{
+    unsigned int sequence_len =    64;     // sequence length
+    unsigned int k            =     2;     // samples per symbol
+    unsigned int m            =     7;     // filter delay [symbols]
+    float        beta         =  0.3f;     // excess bandwidth factor
+    int          ftype        = LIQUID_FIRFILT_ARKAISER; // filter type
+    float        phi          =  0.5f;     // carrier phase offset
+    unsigned int i;
+
+    // generate synchronization sequence (QPSK symbols)
+    float complex sequence[sequence_len];
+    for (i=0; i<sequence_len; i++) {
+        sequence[i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                      (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+    }
+
+    // create detector
+    qdetector_cccf q = qdetector_cccf_create_linear(sequence, sequence_len, ftype, k, m, beta);
+    qdetector_cccf_set_range(q, 0.3f);
+    qdetector_cccf_set_range_step(q, _step);
+    CONTEND_EQUALITY( qdetector_cccf_get_range_step(q), _step );
+    liquid_offload offload = _offload ? liquid_offload_create(NULL) : NULL;
+    qdetector_cccf_set_offload(q, offload);
+    CONTEND_EXPRESSION( qdetector_cccf_get_offload(q) == offload );
+
+    // push sequence followed by random symbols through detector
+    firinterp_crcf interp = firinterp_crcf_create_prototype(ftype, k, m, beta, 0);
+    int   frame_detected = 0;
+    float dphi_hat       = 0.0f;
+    unsigned int n = 0;
+    float complex y[k];
+    for (i=0; i<8*sequence_len && !frame_detected; i++) {
+        float complex sym = i < sequence_len ? sequence[i] : sequence[rand()%sequence_len];
+        firinterp_crcf_execute(interp, sym, y);
+        unsigned int j;
+        for (j=0; j<k && !frame_detected; j++) {
+            y[j] *= cexpf(_Complex_I*(_dphi*n + phi));
+            y[j] += 0.01f*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+            n++;
+            if (qdetector_cccf_execute(q, y[j]) != NULL) {
+                frame_detected = 1;
+                dphi_hat = qdetector_cccf_get_dphi(q);
+            }
+        }
+    }
+    firinterp_crcf_destroy(interp);
+    qdetector_cccf_destroy(q);
+    if (offload != NULL)
+        liquid_offload_destroy(offload);
+
+    if (liquid_autotest_verbose)
+        printf("step %u: dphi hat %8.5f, actual %8.5f\n", _step, dphi_hat, _dphi);
+
+    CONTEND_EQUALITY( frame_detected, 1 );
+    CONTEND_DELTA( dphi_hat, _dphi, 0.01f );
+}
+
+// coarse-to-fine carrier offset search tests
+void autotest_qdetector_cccf_range_step1() { qdetector_cccf_runtest_range_step(1,  0.070f, 0); }
+void autotest_qdetector_cccf_range_step2() { qdetector_cccf_runtest_range_step(2,  0.070f, 0); }
+void autotest_qdetector_cccf_range_step3() { qdetector_cccf_runtest_range_step(3, -0.120f, 0); }
+void autotest_qdetector_cccf_range_step4() { qdetector_cccf_runtest_range_step(4,  0.210f, 0); }
+
+// carrier offset grid swept through offload queue
+void autotest_qdetector_cccf_offload_step1() { qdetector_cccf_runtest_range_step(1, -0.070f, 1); }
+void autotest_qdetector_cccf_offload_step3() { qdetector_cccf_runtest_range_step(3,  0.150f, 1); }
+
+//
+// AUTOTEST : reset discards buffered samples; after a detection the
+//            buffer still holds part of the detected frame
+//
+void autotest_qdetector_cccf_reset()
+{
+    unsigned int sequence_len = 64;     // sequence length
+    unsigned int k            =  2;     // samples per symbol
+    unsigned int m            =  7;     // filter delay [symbols]
+    float        beta         = 0.3f;   // excess bandwidth factor
+    int          ftype        = LIQUID_FIRFILT_ARKAISER;
+    unsigned int i;
+
+    // generate synchronization sequence (QPSK symbols)
+    float complex sequence[sequence_len];
+    for (i=0; i<sequence_len; i++) {
+        sequence[i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                      (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+    }
+
+    // frame of repeated sequences, so that the samples remaining in the
+    // buffer after detection contain a full copy of the sequence
+    unsigned int num_samples = k*(8*sequence_len + 2*m);
+    float complex y[num_samples];
+    firinterp_crcf interp = firinterp_crcf_create_prototype(ftype, k, m, beta, 0);
+    for (i=0; i<num_samples/k; i++)
+        firinterp_crcf_execute(interp, sequence[i % sequence_len], &y[k*i]);
+    firinterp_crcf_destroy(interp);
+
+    // detect frame, then reset as a frame synchronizer does once the
+    // frame has been received
+    qdetector_cccf q = qdetector_cccf_create_linear(sequence, sequence_len, ftype, k, m, beta);
+    unsigned int buf_len = qdetector_cccf_get_buf_len(q);
+    int frame_detected = 0;
+    for (i=0; i<num_samples && !frame_detected; i++)
+        frame_detected = qdetector_cccf_execute(q, y[i]) != NULL;
+    CONTEND_EQUALITY( frame_detected, 1 );
+    qdetector_cccf_reset(q);
+
+    // silence must not be detected
+    frame_detected = 0;
+    for (i=0; i<4*buf_len; i++)
+        frame_detected |= qdetector_cccf_execute(q, 0.0f) != NULL;
+    CONTEND_EQUALITY( frame_detected, 0 );
+
+    // frame is still detected after reset
+    for (i=0; i<num_samples && !frame_detected; i++)
+        frame_detected = qdetector_cccf_execute(q, y[i]) != NULL;
+    CONTEND_EQUALITY( frame_detected, 1 );
+
+    qdetector_cccf_destroy(q);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// autotest helper function: detect frame with either a linear or a
+// GMSK preamble using a single bank holding both templates
+//  _index  :   template of transmitted frame (0: linear, 1: GMSK)
+void qdetectorbank_cccf_runtest(unsigned int _index);
+
+void autotest_qdetectorbank_cccf_linear() { qdetectorbank_cccf_runtest(0); }
+void autotest_qdetectorbank_cccf_gmsk()   { qdetectorbank_cccf_runtest(1); }
+
+void qdetectorbank_cccf_runtest(unsigned int _index)
+{
+    unsigned int k     =     2;     // samples per symbol
+    unsigned int m     =     7;     // filter delay [symbols] (linear)
+    float        beta  =  0.3f;     // excess bandwidth factor (linear)
+    unsigned int m_g   =     3;     // filter delay [symbols] (GMSK)
+    float        BT    =  0.5f;     // bandwidth-time product (GMSK)
+    float        gamma =  1.0f;     // channel gain
+    float        dphi  =  0.002f;   // carrier frequency offset
+    float        phi   =  0.5f;     // carrier phase offset
+    int          ftype = LIQUID_FIRFILT_ARKAISER;
+
+    unsigned int len_linear = 64;   // linear sequence length [symbols]
+    unsigned int len_gmsk   = 200;  // GMSK sequence length [bits]
+
+    unsigned int i;
+
+    // generate synchronization sequences
+    float complex seq_linear[len_linear];
+    for (i=0; i<len_linear; i++) {
+        seq_linear[i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                        (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+    }
+    unsigned char seq_gmsk[len_gmsk];
+    for (i=0; i<len_gmsk; i++)
+        seq_gmsk[i] = rand() & 0x01;
+
+    // create bank from prototype detectors of differing FFT sizes
+    qdetector_cccf proto[2];
+    proto[0] = qdetector_cccf_create_linear(seq_linear, len_linear, ftype, k, m, beta);
+    proto[1] = qdetector_cccf_create_gmsk  (seq_gmsk,   len_gmsk,   k, m_g, BT);
+    qdetectorbank_cccf q = qdetectorbank_cccf_create(proto, 2);
+    qdetector_cccf_destroy(proto[0]);
+    qdetector_cccf_destroy(proto[1]);
+    if (liquid_autotest_verbose)
+        qdetectorbank_cccf_print(q);
+    CONTEND_EQUALITY(qdetectorbank_cccf_get_num_templates(q), 2);
+
+    // generate transmitted signal: sequence, then random symbols
+    unsigned int num_samples = 4*qdetectorbank_cccf_get_buf_len(q);
+    float complex y[num_samples];
+    if (_index == 0) {
+        firinterp_crcf interp = firinterp_crcf_create_prototype(ftype, k, m, beta, 0);
+        for (i=0; i<num_samples/k; i++) {
+            float complex sym = i < len_linear ? seq_linear[i] : seq_linear[rand()%len_linear];
+            firinterp_crcf_execute(interp, sym, &y[k*i]);
+        }
+        firinterp_crcf_destroy(interp);
+    } else {
+        gmskmod mod = gmskmod_create(k, m_g, BT);
+        for (i=0; i<num_samples/k; i++)
+            gmskmod_modulate(mod, i < len_gmsk ? seq_gmsk[i] : rand() & 0x01, &y[k*i]);
+        gmskmod_destroy(mod);
+    }
+
+    // add channel impairments
+    for (i=0; i<num_samples; i++)
+        y[i] *= gamma * cexpf(_Complex_I*(dphi*i + phi));
+
+    // try to detect frame
+    int frame_detected = 0;
+    for (i=0; i<num_samples && !frame_detected; i++)
+        frame_detected = qdetectorbank_cccf_execute(q, y[i]) != NULL;
+
+    unsigned int index     = qdetectorbank_cccf_get_index(q);
+    float        tau_hat   = qdetectorbank_cccf_get_tau  (q);
+    float        gamma_hat = qdetectorbank_cccf_get_gamma(q);
+    float        dphi_hat  = qdetectorbank_cccf_get_dphi (q);
+    float        phi_hat   = qdetectorbank_cccf_get_phi  (q);
+    qdetectorbank_cccf_destroy(q);
+
+    if (liquid_autotest_verbose) {
+        printf("frame detected  :   %s (template %u)\n", frame_detected ? "yes" : "no", index);
+        printf("  gamma hat     : %8.3f, actual=%8.3f\n", gamma_hat, gamma);
+        printf("  tau hat       : %8.3f, actual=%8.3f\n", tau_hat,   0.0f );
+        printf("  dphi hat      : %8.5f, actual=%8.5f\n", dphi_hat,  dphi );
+        printf("  phi hat       : %8.5f, actual=%8.5f\n", phi_hat,   phi  );
+    }
+
+    if (!frame_detected) {
+        AUTOTEST_FAIL("frame not detected");
+    } else {
+        CONTEND_EQUALITY( index, _index );
+        CONTEND_DELTA( tau_hat,  0.0f, 0.05f );
+        CONTEND_DELTA( dphi_hat, dphi, 0.01f );
+        CONTEND_DELTA( phi_hat,  phi,  0.1f  );
+    }
+}
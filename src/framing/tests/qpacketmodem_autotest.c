@@ -140,3 +140,126 @@ void autotest_qpacketmodem_unmod_qam64()  { qpacketmodem_unmodulated(400,LIQUID_
 void autotest_qpacketmodem_unmod_sqam128(){ qpacketmodem_unmodulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_SQAM128); }
 void autotest_qpacketmodem_unmod_qam256() { qpacketmodem_unmodulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_QAM256);  }
 
+
+// 
+// AUTOTEST : syndrome pre-check decodes valid frames and rejects noise
+//
+void autotest_qpacketmodem_decode_precheck()
+{
+    unsigned int payload_len = 20;
+    unsigned int i;
+    qpacketmodem q = qpacketmodem_create();
+    qpacketmodem_configure(q, payload_len, LIQUID_CRC_32, LIQUID_FEC_SECDED7264,
+                           LIQUID_FEC_HAMMING84, LIQUID_MODEM_QPSK);
+
+    unsigned char payload_tx[payload_len];
+    unsigned char payload_rx[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload_tx[i] = rand() & 0xff;
+
+    unsigned int frame_len = qpacketmodem_get_frame_len(q);
+    float complex frame[frame_len];
+    qpacketmodem_encode(q, payload_tx, frame);
+
+    // valid frame is decoded
+    CONTEND_EQUALITY( qpacketmodem_decode_precheck(q, frame, payload_rx, 0.25f), 1 );
+    CONTEND_SAME_DATA( payload_tx, payload_rx, payload_len );
+
+    // noise is rejected before decoding
+    for (i=0; i<frame_len; i++)
+        frame[i] = randnf() + _Complex_I*randnf();
+    CONTEND_EQUALITY( qpacketmodem_decode_precheck(q, frame, payload_rx, 0.25f), -1 );
+
+    qpacketmodem_destroy(q);
+}
+
+// 
+// AUTOTEST : incremental soft decoding matches block soft decoding
+//
+void qpacketmodem_test_soft_push(int _fec0, int _fec1, int _ms)
+{
+    unsigned int payload_len = 120;
+    unsigned int i;
+    qpacketmodem q = qpacketmodem_create();
+    qpacketmodem_configure(q, payload_len, LIQUID_CRC_32, _fec0, _fec1, _ms);
+
+    unsigned char payload_tx[payload_len];
+    unsigned char payload_rx0[payload_len];
+    unsigned char payload_rx1[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload_tx[i] = rand() & 0xff;
+
+    unsigned int frame_len = qpacketmodem_get_frame_len(q);
+    float complex frame[frame_len];
+    qpacketmodem_encode(q, payload_tx, frame);
+    for (i=0; i<frame_len; i++)
+        frame[i] += 0.1f*(randnf() + _Complex_I*randnf());
+
+    // block decoding
+    int crc0 = qpacketmodem_decode_soft(q, frame, payload_rx0);
+
+    // first third one symbol at a time, remainder in uneven blocks
+    qpacketmodem_reset(q);
+    int complete = 0;
+    for (i=0; i<frame_len/3; i++)
+        complete = qpacketmodem_decode_soft_push(q, frame[i]);
+    CONTEND_EQUALITY( complete, 0 );
+    while (i < frame_len)
+        i += qpacketmodem_decode_soft_push_block(q, &frame[i], 17);
+    CONTEND_EQUALITY( i, frame_len );
+    int crc1 = qpacketmodem_decode_soft_finish(q, payload_rx1);
+
+    CONTEND_EQUALITY( crc0, 1 );
+    CONTEND_EQUALITY( crc1, 1 );
+    CONTEND_SAME_DATA( payload_rx0, payload_tx, payload_len );
+    CONTEND_SAME_DATA( payload_rx1, payload_tx, payload_len );
+
+    qpacketmodem_destroy(q);
+}
+void autotest_qpacketmodem_soft_push_v27_qpsk()  { qpacketmodem_test_soft_push(LIQUID_FEC_CONV_V27, LIQUID_FEC_NONE,      LIQUID_MODEM_QPSK);  }
+void autotest_qpacketmodem_soft_push_h84_psk8()  { qpacketmodem_test_soft_push(LIQUID_FEC_NONE,     LIQUID_FEC_HAMMING84, LIQUID_MODEM_PSK8);  }
+void autotest_qpacketmodem_soft_push_v29_qam16() { qpacketmodem_test_soft_push(LIQUID_FEC_NONE,     LIQUID_FEC_CONV_V29,  LIQUID_MODEM_QAM16); }
+
+
+// switching between previously-used configurations should reuse cached
+// modem/packetizer objects and buffer capacity without allocating
+void autotest_qpacketmodem_reconfigure_alloc()
+{
+    unsigned int i, j;
+    int fec0[3] = {LIQUID_FEC_CONV_V27, LIQUID_FEC_NONE,      LIQUID_FEC_GOLAY2412};
+    int fec1[3] = {LIQUID_FEC_NONE,     LIQUID_FEC_HAMMING74, LIQUID_FEC_NONE     };
+    int ms  [3] = {LIQUID_MODEM_QPSK,   LIQUID_MODEM_QAM16,   LIQUID_MODEM_PSK8   };
+    unsigned int payload_len[3] = {64, 200, 31};
+
+    qpacketmodem q = qpacketmodem_create();
+
+    // warm up: visit every configuration once
+    for (i=0; i<3; i++)
+        qpacketmodem_configure(q, payload_len[i], LIQUID_CRC_32, fec0[i], fec1[i], ms[i]);
+
+    // cycle through configurations; no allocations expected
+    liquid_allocator_audit_begin(liquid_autotest_verbose);
+    for (j=0; j<10; j++) {
+        i = (7*j) % 3;
+        qpacketmodem_configure(q, payload_len[i], LIQUID_CRC_32, fec0[i], fec1[i], ms[i]);
+    }
+    unsigned long num_allocs = liquid_allocator_audit_end();
+    CONTEND_EQUALITY( num_allocs, 0 );
+
+    // reused objects must still encode/decode correctly
+    for (i=0; i<3; i++) {
+        qpacketmodem_configure(q, payload_len[i], LIQUID_CRC_32, fec0[i], fec1[i], ms[i]);
+        unsigned char payload_tx[payload_len[i]];
+        unsigned char payload_rx[payload_len[i]];
+        for (j=0; j<payload_len[i]; j++)
+            payload_tx[j] = rand() & 0xff;
+        unsigned int frame_len = qpacketmodem_get_frame_len(q);
+        float complex frame[frame_len];
+        qpacketmodem_encode(q, payload_tx, frame);
+        int crc_pass = qpacketmodem_decode_soft(q, frame, payload_rx);
+        CONTEND_EQUALITY( crc_pass, 1 );
+        CONTEND_SAME_DATA( payload_tx, payload_rx, payload_len[i] );
+    }
+
+    qpacketmodem_destroy(q);
+}
@@ -38,13 +38,15 @@
 //  _phi            :   carrier phase offset
 //  _gamma          :   channel gain
 //  _SNRdB          :   signal-to-noise ratio [dB]
+//  _direct         :   estimate frequency directly (no transform)?
 void qpilotsync_test(modulation_scheme _ms,
                      unsigned int      _payload_len,
                      unsigned int      _pilot_spacing,
                      float             _dphi,
                      float             _phi,
                      float             _gamma,
-                     float             _SNRdB)
+                     float             _SNRdB,
+                     int               _direct)
 {
     unsigned int i;
     // derived values
@@ -53,6 +55,7 @@ void qpilotsync_test(modulation_scheme _ms,
     // create pilot generator and synchronizer objects
     qpilotgen  pg = qpilotgen_create( _payload_len, _pilot_spacing);
     qpilotsync ps = qpilotsync_create(_payload_len, _pilot_spacing);
+    qpilotsync_set_direct(ps, _direct);
 
     // get frame length
     unsigned int frame_len = qpilotgen_get_frame_len(pg);
@@ -176,9 +179,108 @@ void qpilotsync_test(modulation_scheme _ms,
 #endif
 }
 
-void autotest_qpilotsync_100_16() { qpilotsync_test(LIQUID_MODEM_QPSK, 100, 16, 0.07f, 1.2f, 0.7f, 40.0f); }
-void autotest_qpilotsync_200_20() { qpilotsync_test(LIQUID_MODEM_QPSK, 200, 20, 0.07f, 1.2f, 0.7f, 40.0f); }
-void autotest_qpilotsync_300_24() { qpilotsync_test(LIQUID_MODEM_QPSK, 300, 24, 0.07f, 1.2f, 0.7f, 40.0f); }
-void autotest_qpilotsync_400_28() { qpilotsync_test(LIQUID_MODEM_QPSK, 400, 28, 0.07f, 1.2f, 0.7f, 40.0f); }
-void autotest_qpilotsync_500_32() { qpilotsync_test(LIQUID_MODEM_QPSK, 500, 32, 0.07f, 1.2f, 0.7f, 40.0f); }
+void autotest_qpilotsync_100_16() { qpilotsync_test(LIQUID_MODEM_QPSK, 100, 16, 0.07f, 1.2f, 0.7f, 40.0f, 0); }
+void autotest_qpilotsync_200_20() { qpilotsync_test(LIQUID_MODEM_QPSK, 200, 20, 0.07f, 1.2f, 0.7f, 40.0f, 0); }
+void autotest_qpilotsync_300_24() { qpilotsync_test(LIQUID_MODEM_QPSK, 300, 24, 0.07f, 1.2f, 0.7f, 40.0f, 0); }
+void autotest_qpilotsync_400_28() { qpilotsync_test(LIQUID_MODEM_QPSK, 400, 28, 0.07f, 1.2f, 0.7f, 40.0f, 0); }
+void autotest_qpilotsync_500_32() { qpilotsync_test(LIQUID_MODEM_QPSK, 500, 32, 0.07f, 1.2f, 0.7f, 40.0f, 0); }
+void autotest_qpilotsync_1000_20() { qpilotsync_test(LIQUID_MODEM_QPSK, 1000, 20, 0.05f, 1.2f, 0.7f, 40.0f, 0); }
+
+// frequency estimated directly from the pilots (no transform)
+void autotest_qpilotsync_100_16_direct() { qpilotsync_test(LIQUID_MODEM_QPSK, 100, 16, 0.07f, 1.2f, 0.7f, 40.0f, 1); }
+void autotest_qpilotsync_300_24_direct() { qpilotsync_test(LIQUID_MODEM_QPSK, 300, 24, 0.07f, 1.2f, 0.7f, 40.0f, 1); }
+void autotest_qpilotsync_500_32_direct() { qpilotsync_test(LIQUID_MODEM_QPSK, 500, 32, 0.07f, 1.2f, 0.7f, 40.0f, 1); }
+
+// negative offset near the direct estimator's range limit (pi per pilot)
+void autotest_qpilotsync_120_12_neg_direct() { qpilotsync_test(LIQUID_MODEM_QPSK, 120, 12, -0.24f, -2.0f, 1.3f, 40.0f, 1); }
+
+// 
+// AUTOTEST : count frequency outliers at low SNR
+//
+//  _direct         :   estimate frequency directly (no transform)?
+void qpilotsync_test_lowsnr(int _direct)
+{
+    unsigned int payload_len   = 400;   // 20 pilots with spacing 20
+    unsigned int pilot_spacing = 20;
+    unsigned int num_trials    = 200;
+    float        SNRdB         = 0.0f;
+    unsigned int i, t;
+    float nstd = powf(10.0f, -SNRdB/20.0f);
+
+    qpilotgen  pg = qpilotgen_create( payload_len, pilot_spacing);
+    qpilotsync ps = qpilotsync_create(payload_len, pilot_spacing);
+    qpilotsync_set_direct(ps, _direct);
+    unsigned int frame_len = qpilotgen_get_frame_len(pg);
+    modem mod = modem_create(LIQUID_MODEM_QPSK);
+
+    float complex payload_tx[payload_len];
+    float complex frame_tx  [frame_len];
+    float complex frame_rx  [frame_len];
+    float complex payload_rx[payload_len];
+
+    unsigned int num_outliers = 0;
+    for (t=0; t<num_trials; t++) {
+        float dphi = 0.1f*(randf() - 0.5f);
+        for (i=0; i<payload_len; i++)
+            modem_modulate(mod, modem_gen_rand_sym(mod), &payload_tx[i]);
+        qpilotgen_execute(pg, payload_tx, frame_tx);
+        for (i=0; i<frame_len; i++) {
+            frame_rx[i]  = frame_tx[i] * cexpf(_Complex_I*dphi*i);
+            frame_rx[i] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        }
+        qpilotsync_execute(ps, frame_rx, payload_rx);
+        num_outliers += fabsf(qpilotsync_get_dphi(ps) - dphi) > 0.01f;
+    }
+
+    if (liquid_autotest_verbose)
+        printf("  %s: %u / %u outliers at %.1f dB\n",
+                _direct ? "direct" : "fft", num_outliers, num_trials, SNRdB);
+
+    // neither estimator had an outlier in 1000 trials at this SNR (the
+    // direct one doubles the FFT search's outliers from about -3 dB down)
+    CONTEND_LESS_THAN( num_outliers, 3 );
+
+    qpilotgen_destroy(pg);
+    qpilotsync_destroy(ps);
+    modem_destroy(mod);
+}
+void autotest_qpilotsync_lowsnr()        { qpilotsync_test_lowsnr(0); }
+void autotest_qpilotsync_lowsnr_direct() { qpilotsync_test_lowsnr(1); }
+
+// direct estimation releases the transform, is kept when recreated, and
+// is refused for long pilot sequences
+void autotest_qpilotsync_direct_config()
+{
+    qpilotsync q = qpilotsync_create(200, 20);
+    unsigned long int n_fft = qpilotsync_get_memory_usage(q);
+    qpilotsync_set_direct(q, 1);
+    unsigned long int n_direct = qpilotsync_get_memory_usage(q);
+    CONTEND_LESS_THAN( n_direct, n_fft );
+
+    q = qpilotsync_recreate(q, 300, 24);
+    CONTEND_LESS_THAN( qpilotsync_get_memory_usage(q), n_fft );
+    qpilotsync_set_direct(q, 0);
+    CONTEND_GREATER_THAN( qpilotsync_get_memory_usage(q), n_direct );
+    qpilotsync_destroy(q);
+
+    // 1000 payload symbols with spacing 20 needs 53 pilots
+    q = qpilotsync_create(1000, 20);
+    n_fft = qpilotsync_get_memory_usage(q);
+    qpilotsync_set_direct(q, 1);
+    CONTEND_EQUALITY( qpilotsync_get_memory_usage(q), n_fft );
+    qpilotsync_destroy(q);
+}
+
+// recreating with an unchanged configuration keeps the object
+void autotest_qpilotsync_recreate()
+{
+    qpilotsync q = qpilotsync_create(200, 20);
+    qpilotsync r = qpilotsync_recreate(q, 200, 20);
+    CONTEND_EQUALITY( r == q, 1 );
+    CONTEND_EQUALITY( qpilotsync_get_frame_len(r), 211 );
+
+    r = qpilotsync_recreate(r, 300, 24);
+    CONTEND_EQUALITY( qpilotsync_get_frame_len(r), 314 );
+    qpilotsync_destroy(r);
+}
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// generate QPSK stream with carrier offset and noise
+static void symtrack_autotest_gen(float complex * _x,
+                                  unsigned int    _n)
+{
+    randf_seed(3);
+    symstreamcf ss = symstreamcf_create_linear(LIQUID_FIRFILT_ARKAISER, 2, 7, 0.3f, LIQUID_MODEM_QPSK);
+    symstreamcf_write_samples(ss, _x, _n);
+    symstreamcf_destroy(ss);
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _x[i] *= 0.3f*cexpf(_Complex_I*(0.002f*i + 0.7f));
+        _x[i] += 0.01f*(randnf() + _Complex_I*randnf());
+    }
+}
+
+// tracker locks onto QPSK signal with carrier offset
+void autotest_symtrack_cccf_lock()
+{
+    unsigned int n = 8000;
+    float complex x[n];
+    float complex y[n];
+    symtrack_autotest_gen(x, n);
+
+    symtrack_cccf q = symtrack_cccf_create_default();
+    unsigned int ny = 0;
+    symtrack_cccf_execute_block(q, x, n, y, &ny);
+    symtrack_cccf_destroy(q);
+    CONTEND_EQUALITY(ny, n/2);
+
+    // error vector magnitude over last 1000 symbols
+    modem demod = modem_create(LIQUID_MODEM_QPSK);
+    unsigned int i, sym;
+    float e2 = 0.0f;
+    for (i=ny-1000; i<ny; i++) {
+        modem_demodulate(demod, y[i], &sym);
+        float evm = modem_get_demodulator_evm(demod);
+        e2 += evm*evm;
+    }
+    modem_destroy(demod);
+    float evm_dB = 10.0f*log10f(e2 / 1000.0f);
+    if (liquid_autotest_verbose)
+        printf("symtrack evm: %.2f dB\n", evm_dB);
+    CONTEND_LESS_THAN(evm_dB, -15.0f);
+}
+
+// output does not depend on how input is split, so long as each call
+// is a multiple of the loop update interval (16 samples)
+void autotest_symtrack_cccf_block_split()
+{
+    unsigned int n = 4000;
+    float complex x[n];
+    float complex y0[n];
+    float complex y1[n];
+    symtrack_autotest_gen(x, n);
+
+    // single call
+    symtrack_cccf q0 = symtrack_cccf_create_default();
+    unsigned int ny0 = 0;
+    symtrack_cccf_execute_block(q0, x, n, y0, &ny0);
+    symtrack_cccf_destroy(q0);
+
+    // several calls of differing lengths
+    symtrack_cccf q1 = symtrack_cccf_create_default();
+    unsigned int lengths[] = {16, 240, 512, 1024, 48, 2160};
+    unsigned int i, nx = 0, ny1 = 0;
+    for (i=0; i<sizeof(lengths)/sizeof(lengths[0]); i++) {
+        unsigned int ny = 0;
+        symtrack_cccf_execute_block(q1, &x[nx], lengths[i], &y1[ny1], &ny);
+        nx  += lengths[i];
+        ny1 += ny;
+    }
+    symtrack_cccf_destroy(q1);
+
+    CONTEND_EQUALITY(nx,  n);
+    CONTEND_EQUALITY(ny0, ny1);
+    CONTEND_SAME_DATA(y0, y1, ny0*sizeof(float complex));
+}
+
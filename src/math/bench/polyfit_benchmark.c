@@ -63,9 +63,52 @@ void polyf_fit_bench(struct rusage *_start,
     unsigned long int *_num_iterations) \
 { polyf_fit_bench(_start, _finish, _num_iterations, Q, N); }
 
+void benchmark_polyf_fit_q1_n64     POLYF_FIT_BENCHMARK_API(1, 64)
+void benchmark_polyf_fit_q2_n64     POLYF_FIT_BENCHMARK_API(2, 64)
 void benchmark_polyf_fit_q3_n8      POLYF_FIT_BENCHMARK_API(3, 8)
 void benchmark_polyf_fit_q3_n16     POLYF_FIT_BENCHMARK_API(3, 16)
 void benchmark_polyf_fit_q3_n32     POLYF_FIT_BENCHMARK_API(3, 32)
 void benchmark_polyf_fit_q3_n64     POLYF_FIT_BENCHMARK_API(3, 64)
 void benchmark_polyf_fit_q3_n128    POLYF_FIT_BENCHMARK_API(3, 128)
 
+// evaluate polynomial at many points
+void polyf_val_bench(struct rusage *_start,
+                     struct rusage *_finish,
+                     unsigned long int *_num_iterations,
+                     unsigned int _Q,
+                     unsigned int _N,
+                     int _batch)
+{
+    // normalize number of iterations
+    *_num_iterations /= 0.01 * _N * (_Q+1);
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    float p[_Q+1];
+    float x[_N];
+    float y[_N];
+    unsigned int i, j;
+    for (i=0; i<=_Q; i++) p[i] = randnf();
+    for (i=0; i<_N; i++)  x[i] = randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_batch) {
+            polyf_val_batch(p, _Q+1, x, _N, y);
+        } else {
+            for (j=0; j<_N; j++)
+                y[j] = polyf_val(p, _Q+1, x[j]);
+        }
+        x[0] += 1e-9f*y[_N-1];
+    }
+    getrusage(RUSAGE_SELF, _finish);
+}
+
+#define POLYF_VAL_BENCHMARK_API(Q,N,BATCH)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ polyf_val_bench(_start, _finish, _num_iterations, Q, N, BATCH); }
+
+void benchmark_polyf_val_q4_n256        POLYF_VAL_BENCHMARK_API(4, 256, 0)
+void benchmark_polyf_val_batch_q4_n256  POLYF_VAL_BENCHMARK_API(4, 256, 1)
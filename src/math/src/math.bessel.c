@@ -23,9 +23,15 @@
 //
 // Bessel Functions
 //
+// References:
+//  [Abramowitz:1964] M. Abramowitz and I. A. Stegun, "Handbook of
+//      Mathematical Functions," National Bureau of Standards, 1964
+//      (Section 9.8)
+//
 // liquid_lnbesselif    :   log modified Bessel function of the first kind
 // liquid_besselif      :   modified Bessel function of the first kind
 // liquid_besseli0f     :   modified Bessel function of the first kind (order 0)
+// liquid_besseli0f_block : modified Bessel function (order 0) over an array
 // liquid_besseljf      :   Bessel function of the first kind
 // liquid_besselj0f     :   Bessel function of the first kind (order 0)
 //
@@ -82,25 +88,39 @@ float liquid_besselif(float _nu,
 }
 
 // I_0(z) : Modified bessel function of the first kind (order zero)
-#define NUM_BESSELI0_ITERATIONS 32
+// using polynomial approximations [Abramowitz:1964] 9.8.1, 9.8.2 with
+// relative error below 2e-7
 float liquid_besseli0f(float _z)
 {
-    // TODO : use better low-signal approximation
-    if (_z == 0.0f)
-        return 1.0f;
-
-    unsigned int k;
-    float t, y=0.0f;
-    for (k=0; k<NUM_BESSELI0_ITERATIONS; k++) {
-#if 0
-        t = powf(_z/2, (float)k) / tgamma((float)k+1);
-        y += t*t;
-#else
-        t = k * logf(0.5f*_z) - liquid_lngammaf((float)k + 1.0f);
-        y += expf(2*t);
-#endif
+    float z = fabsf(_z);
+    float t;
+    if (z < 3.75f) {
+        t = z / 3.75f;
+        t = t*t;
+        return 1.0f + t*(3.5156229f + t*(3.0899424f + t*(1.2067492f +
+                      t*(0.2659732f + t*(0.0360768f + t*0.0045813f)))));
     }
-    return y;
+
+    t = 3.75f / z;
+    float p = 0.39894228f + t*( 0.01328592f + t*( 0.00225319f +
+                            t*(-0.00157565f + t*( 0.00916281f +
+                            t*(-0.02057706f + t*( 0.02635537f +
+                            t*(-0.01647633f + t*  0.00392377f)))))));
+    return p * expf(z) / sqrtf(z);
+}
+
+// I_0(z) : Modified bessel function of the first kind (order zero)
+// evaluated over an array
+//  _z      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_besseli0f_block(float *      _z,
+                            unsigned int _n,
+                            float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = liquid_besseli0f(_z[i]);
 }
 
 // J_v(z) : Bessel function of the first kind
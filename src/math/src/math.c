@@ -131,6 +131,35 @@ float sincf(float _x) {
     return sinf(M_PI*_x)/(M_PI*_x);
 }
 
+// compute sinc(x) = sin(pi*x) / (pi*x) over an array; sin(pi*x) is
+// reduced to r = x - round(x) in [-0.5,0.5] and evaluated with an odd
+// polynomial (absolute error below 1e-7), avoiding libm calls
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void sincf_block(float *      _x,
+                 unsigned int _n,
+                 float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float x  = _x[i];
+        float k  = floorf(x + 0.5f);
+        float r  = x - k;
+        float r2 = r*r;
+
+        // sin(pi*r)/(pi*r) : Taylor series to r^12
+        float s = 1.0f + r2*(-1.6449341f + r2*( 0.8117424f + r2*(-0.1907518f +
+                         r2*( 0.0261478f + r2*(-0.0023461f + r2*  0.0001484f)))));
+
+        // sin(pi*x) = (-1)^k sin(pi*r)
+        if ((long int)k & 1)
+            s = -s;
+
+        _y[i] = (k == 0.0f) ? s : s*r/x;
+    }
+}
+
 // next power of 2 : y = ceil(log2(_x))
 unsigned int liquid_nextpow2(unsigned int _x)
 {
@@ -24,6 +24,7 @@
 // gamma functions
 //
 // liquid_lngammaf()        :   log( Gamma(z) )
+// liquid_lngammaf_block()  :   log( Gamma(z) ) over an array
 // liquid_gammaf()          :   Gamma(z)
 // liquid_lnlowergammaf()   :   log( gamma(z,a) ), lower incomplete
 // liquid_lnuppergammaf()   :   log( Gamma(z,a) ), upper incomplete
@@ -60,8 +61,15 @@ float liquid_lngammaf(float _z)
         // Use recursive formula:
         //    gamma(z+1) = z * gamma(z)
         // therefore:
-        //    log(Gamma(z)) = log(gamma(z+1)) - ln(z)
-        return liquid_lngammaf(_z + 1.0f) - logf(_z);
+        //    log(Gamma(z)) = log(gamma(z+k)) - ln(z*(z+1)*...*(z+k-1))
+        // shifting z past 10 with a single logarithm
+        float p = _z;
+        float z = _z + 1.0f;
+        while (z < 10.0f) {
+            p *= z;
+            z += 1.0f;
+        }
+        return liquid_lngammaf(z) - logf(p);
 #endif
     } else {
         // high value approximation
@@ -71,6 +79,19 @@ float liquid_lngammaf(float _z)
     return g;
 }
 
+// log( Gamma(z) ) over an array
+//  _z      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_lngammaf_block(float *      _z,
+                           unsigned int _n,
+                           float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = liquid_lngammaf(_z[i]);
+}
+
 float liquid_gammaf(float _z)
 {
     if (_z < 0) {
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// math.trig.avx.c : block trigonometric kernels (x86 AVX2/FMA)
+//
+// Eight arguments are reduced and evaluated per iteration with the
+// same reduction and polynomials as liquid_sincosf_block_poly() in
+// math.trig.c. Blocks containing non-finite or very large arguments
+// are handed to the C library. These kernels are compiled with
+// per-function target attributes and are selected at run time.
+//
+
+#include <immintrin.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// argument limit for polynomial evaluation
+#define LIQUID_SINCOSF_MAX  (8192.0f)
+
+// sine and cosine of eight values with |_x| <= LIQUID_SINCOSF_MAX
+__attribute__((target("avx2,fma")))
+static inline void liquid_sincosf8(__m256   _x,
+                                   int      _coarse,
+                                   __m256 * _s,
+                                   __m256 * _c)
+{
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i two = _mm256_set1_epi32(2);
+    __m256i q   = _mm256_cvtps_epi32(_mm256_mul_ps(_x, _mm256_set1_ps((float)M_2_PI)));
+    __m256  qf  = _mm256_cvtepi32_ps(q);
+    __m256  r   = _mm256_fnmadd_ps(qf, _mm256_set1_ps(1.5703125f), _x);
+    r = _mm256_fnmadd_ps(qf, _mm256_set1_ps(4.837512969970703125e-4f), r);
+    r = _mm256_fnmadd_ps(qf, _mm256_set1_ps(7.54978995489188216e-8f),  r);
+    __m256  z   = _mm256_mul_ps(r, r);
+
+    // sin(r) and cos(r)
+    __m256 ps, pc;
+    if (_coarse) {
+        ps = _mm256_set1_ps(8.1515757475e-3f);
+        ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps(-1.6662755488e-1f));
+        pc = _mm256_set1_ps(-1.3650459585e-3f);
+        pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps( 4.1661166333e-2f));
+    } else {
+        ps = _mm256_set1_ps(-1.9515295891e-4f);
+        ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps( 8.3321608736e-3f));
+        ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps(-1.6666654611e-1f));
+        pc = _mm256_set1_ps( 2.443315711809948e-5f);
+        pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps(-1.388731625493765e-3f));
+        pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps( 4.166664568298827e-2f));
+    }
+    ps = _mm256_fmadd_ps(ps, _mm256_mul_ps(z, r), r);
+    pc = _mm256_fmadd_ps(pc, _mm256_mul_ps(z, z),
+                         _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, _mm256_set1_ps(1.0f)));
+
+    // odd quadrants swap sine and cosine; negate sine in quadrants
+    // 2,3 and cosine in quadrants 1,2
+    __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+    __m256 s = _mm256_blendv_ps(ps, pc, swap);
+    __m256 c = _mm256_blendv_ps(pc, ps, swap);
+    __m256i sn = _mm256_slli_epi32(_mm256_and_si256(q, two), 30);
+    __m256i cn = _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, one), two), 30);
+    *_s = _mm256_xor_ps(s, _mm256_castsi256_ps(sn));
+    *_c = _mm256_xor_ps(c, _mm256_castsi256_ps(cn));
+}
+
+// sine and cosine of array (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_sincosf_block_avx2(float *      _theta,
+                               unsigned int _n,
+                               float *      _s,
+                               float *      _c,
+                               int          _coarse)
+{
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 lim  = _mm256_set1_ps(LIQUID_SINCOSF_MAX);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 theta = _mm256_loadu_ps(_theta + i);
+        if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign, theta), lim, _CMP_NLE_UQ))) {
+            liquid_sincosf_block_poly(_theta + i, 8, _s + i, _c + i, _coarse);
+            continue;
+        }
+
+        __m256 s, c;
+        liquid_sincosf8(theta, _coarse, &s, &c);
+        _mm256_storeu_ps(_s + i, s);
+        _mm256_storeu_ps(_c + i, c);
+    }
+    liquid_sincosf_block_poly(_theta + i, _n - i, _s + i, _c + i, _coarse);
+}
@@ -30,6 +30,9 @@
 
 #include "liquid.internal.h"
 
+// argument limit for polynomial evaluation in liquid_sincosf_block()
+#define LIQUID_SINCOSF_MAX  (8192.0f)
+
 #if 0
 #define LIQUID_SINF_POLYORD (4)
 static float liquid_sinf_poly[LIQUID_SINF_POLYORD] = {
@@ -69,6 +72,88 @@ float liquid_tanf(float _x)
     return s/c;
 }
 
+// sine and cosine over an array
+//  _theta      :   input array [size: _n x 1]
+//  _n          :   array length
+//  _s          :   output sine array [size: _n x 1]
+//  _c          :   output cosine array [size: _n x 1]
+//  _accuracy   :   accuracy tier
+void liquid_sincosf_block(float *              _theta,
+                          unsigned int         _n,
+                          float *              _s,
+                          float *              _c,
+                          liquid_trig_accuracy _accuracy)
+{
+    unsigned int i;
+    switch (_accuracy) {
+    case LIQUID_TRIG_EXACT:
+        for (i=0; i<_n; i++) {
+            _s[i] = sinf(_theta[i]);
+            _c[i] = cosf(_theta[i]);
+        }
+        return;
+    case LIQUID_TRIG_FAST:
+    case LIQUID_TRIG_COARSE:
+        break;
+    default:
+        fprintf(stderr,"error: liquid_sincosf_block(), invalid accuracy tier\n");
+        exit(1);
+    }
+
+    int coarse = _accuracy == LIQUID_TRIG_COARSE;
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_TRIG) == LIQUID_SIMD_AVX2) {
+        liquid_sincosf_block_avx2(_theta, _n, _s, _c, coarse);
+        return;
+    }
+#endif
+    liquid_sincosf_block_poly(_theta, _n, _s, _c, coarse);
+}
+
+// sine and cosine of array by polynomial approximation: reduce by the
+// nearest multiple of pi/2 (three-part Cody-Waite), evaluate sine and
+// cosine polynomials on [-pi/4,pi/4] and select/negate by quadrant;
+// the fast tier uses degree 7/8 minimax polynomials, the coarse tier
+// degree 5/6 least-squares fits
+void liquid_sincosf_block_poly(float *      _theta,
+                               unsigned int _n,
+                               float *      _s,
+                               float *      _c,
+                               int          _coarse)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float x = _theta[i];
+        if (!(fabsf(x) <= LIQUID_SINCOSF_MAX)) {
+            _s[i] = sinf(x);
+            _c[i] = cosf(x);
+            continue;
+        }
+
+        int   q = (int)floorf(x*(float)M_2_PI + 0.5f);
+        float r = x - (float)q*1.5703125f;
+        r -= (float)q*4.837512969970703125e-4f;
+        r -= (float)q*7.54978995489188216e-8f;
+        float z = r*r;
+
+        float ps, pc;
+        if (_coarse) {
+            ps = r + r*z*(-1.6662755488e-1f + z*8.1515757475e-3f);
+            pc = 1.0f - 0.5f*z + z*z*(4.1661166333e-2f + z*-1.3650459585e-3f);
+        } else {
+            ps = r + r*z*(-1.6666654611e-1f + z*(8.3321608736e-3f + z*-1.9515295891e-4f));
+            pc = 1.0f - 0.5f*z + z*z*(4.166664568298827e-2f + z*(-1.388731625493765e-3f + z*2.443315711809948e-5f));
+        }
+
+        // odd quadrants swap sine and cosine; negate sine in quadrants
+        // 2,3 and cosine in quadrants 1,2
+        float s = (q & 1) ? pc : ps;
+        float c = (q & 1) ? ps : pc;
+        _s[i] = (q & 2)       ? -s : s;
+        _c[i] = ((q + 1) & 2) ? -c : c;
+    }
+}
+
 float liquid_expf(float _x)
 {
     return expf(_x);
@@ -31,24 +31,85 @@
 #include <string.h>
 #include <math.h>
 
+// least-squares polynomial fit for order 0, 1, 2 (_k <= 3)
+void POLY(_fit_lowdeg)(T *          _x,
+                       T *          _y,
+                       unsigned int _n,
+                       T *          _p,
+                       unsigned int _k);
+
+// evaluate polynomial using Horner's method
 T POLY(_val)(T * _p, unsigned int _k, T _x)
 {
-    unsigned int i;
-    T xk = 1;
-    T y = 0.0f;
-    for (i=0; i<_k; i++) {
-        y += _p[i]*xk;
-        xk *= _x;
+    if (_k == 0)
+        return 0;
+
+    unsigned int i = _k-1;
+    T y = _p[i];
+    while (i > 0) {
+        i--;
+        y = y*_x + _p[i];
     }
     return y;
 }
 
+// evaluate polynomial at many points using Horner's method
+void POLY(_val_batch)(T *          _p,
+                      unsigned int _k,
+                      T *          _x,
+                      unsigned int _n,
+                      T *          _y)
+{
+    unsigned int i, j;
+    if (_k == 0) {
+        for (i=0; i<_n; i++)
+            _y[i] = 0;
+        return;
+    }
+
+#ifdef POLY_VECTOR
+    // one vector multiply-add per coefficient over blocks small enough
+    // to remain in cache
+    unsigned int b;
+    for (b=0; b<_n; b+=256) {
+        unsigned int n = (_n - b) < 256 ? _n - b : 256;
+        POLY_VECTOR(_init)(_p[_k-1], _y+b, n);
+        for (j=_k-1; j>0; j--) {
+            POLY_VECTOR(_mul)      (_y+b, _x+b, n,         _y+b);
+            POLY_VECTOR(_addscalar)(_y+b,       n, _p[j-1], _y+b);
+        }
+    }
+#else
+    // four independent Horner recursions at a time
+    for (i=0; i+4<=_n; i+=4) {
+        T y0 = _p[_k-1], y1 = y0, y2 = y0, y3 = y0;
+        for (j=_k-1; j>0; j--) {
+            y0 = y0*_x[i+0] + _p[j-1];
+            y1 = y1*_x[i+1] + _p[j-1];
+            y2 = y2*_x[i+2] + _p[j-1];
+            y3 = y3*_x[i+3] + _p[j-1];
+        }
+        _y[i+0] = y0;
+        _y[i+1] = y1;
+        _y[i+2] = y2;
+        _y[i+3] = y3;
+    }
+    for ( ; i<_n; i++)
+        _y[i] = POLY(_val)(_p, _k, _x[i]);
+#endif
+}
+
 void POLY(_fit)(T * _x,
                 T * _y,
                 unsigned int _n,
                 T * _p,
                 unsigned int _k)
 {
+    // low orders: solve normal equations in closed form
+    if (_k <= 3 && _n >= _k) {
+        POLY(_fit_lowdeg)(_x, _y, _n, _p, _k);
+        return;
+    }
 
     // ...
     T X[_n*_k];
@@ -90,3 +151,49 @@ void POLY(_fit)(T * _x,
                  _p, _k, 1);
 }
 
+// least-squares polynomial fit for order 0, 1, 2 (_k <= 3), solving
+// the normal equations [X']*X*p = [X']*y directly without forming X
+void POLY(_fit_lowdeg)(T *          _x,
+                       T *          _y,
+                       unsigned int _n,
+                       T *          _p,
+                       unsigned int _k)
+{
+    // accumulate G = [X']*X and b = [X']*y
+    T G[9] = {0,0,0, 0,0,0, 0,0,0};
+    T b[3] = {0,0,0};
+    unsigned int i, r, c;
+    for (i=0; i<_n; i++) {
+        T v[3]  = {1, _x[i], _x[i]*_x[i]};
+        T vc[3] = {1, T_CONJ(_x[i]), T_CONJ(_x[i]*_x[i])};
+        for (r=0; r<_k; r++) {
+            b[r] += vc[r]*_y[i];
+            for (c=0; c<_k; c++)
+                G[3*r+c] += vc[r]*v[c];
+        }
+    }
+
+    if (_k == 1) {
+        _p[0] = b[0] / G[0];
+    } else if (_k == 2) {
+        // 2x2 inverse
+        T det = G[0]*G[4] - G[1]*G[3];
+        _p[0] = ( G[4]*b[0] - G[1]*b[1]) / det;
+        _p[1] = (-G[3]*b[0] + G[0]*b[1]) / det;
+    } else {
+        // 3x3 inverse via cofactors (Cramer's rule)
+        T c00 = G[4]*G[8] - G[5]*G[7];
+        T c01 = G[5]*G[6] - G[3]*G[8];
+        T c02 = G[3]*G[7] - G[4]*G[6];
+        T det = G[0]*c00 + G[1]*c01 + G[2]*c02;
+        T c10 = G[2]*G[7] - G[1]*G[8];
+        T c11 = G[0]*G[8] - G[2]*G[6];
+        T c12 = G[1]*G[6] - G[0]*G[7];
+        T c20 = G[1]*G[5] - G[2]*G[4];
+        T c21 = G[2]*G[3] - G[0]*G[5];
+        T c22 = G[0]*G[4] - G[1]*G[3];
+        _p[0] = (c00*b[0] + c10*b[1] + c20*b[2]) / det;
+        _p[1] = (c01*b[0] + c11*b[1] + c21*b[2]) / det;
+        _p[2] = (c02*b[0] + c12*b[1] + c22*b[2]) / det;
+    }
+}
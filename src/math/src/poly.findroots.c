@@ -29,6 +29,7 @@
 #include <string.h>
 #include <math.h>
 #include <assert.h>
+#include <complex.h>
 
 #include "liquid.internal.h"
 
@@ -46,6 +47,12 @@ void POLY(_findroots_bairstow_recursion)(T *          _p,
                                          T *          _u,
                                          T *          _v);
 
+// eigenvalues of upper Hessenberg matrix using shifted QR iterations;
+// returns 0 on success
+int POLY(_findroots_hessenberg_qr)(double complex * _H,
+                                   unsigned int     _n,
+                                   TC *             _roots);
+
 
 // finds the complex roots of the polynomial
 //  _p      :   polynomial array, ascending powers [size: _k x 1]
@@ -55,9 +62,49 @@ void POLY(_findroots)(T *          _p,
                       unsigned int _k,
                       TC *         _roots)
 {
-    // find roots of polynomial using Bairstow's method (more
-    // accurate and reliable than Durand-Kerner)
-    POLY(_findroots_bairstow)(_p,_k,_roots);
+    // find roots as eigenvalues of the companion matrix (more
+    // reliable than Bairstow's method, notably for complex or
+    // clustered roots)
+    POLY(_findroots_companion)(_p,_k,_roots);
+}
+
+// finds the complex roots of the polynomial as the eigenvalues of its
+// companion matrix
+//  _p      :   polynomial array, ascending powers [size: _k x 1]
+//  _k      :   polynomials length (poly order = _k - 1)
+//  _roots  :   resulting complex roots [size: _k-1 x 1]
+void POLY(_findroots_companion)(T *          _p,
+                                unsigned int _k,
+                                TC *         _roots)
+{
+    if (_k < 2) {
+        fprintf(stderr,"%s_findroots_companion(), order must be greater than 0\n", POLY_NAME);
+        exit(1);
+    }
+
+    unsigned int n = _k-1;
+    double complex pn = _p[n];
+    if (pn == 0) {
+        fprintf(stderr,"warning: %s_findroots_companion(), irreducible polynomial\n", POLY_NAME);
+        pn = 1e-12;
+    }
+
+    // companion matrix (upper Hessenberg), computed in double precision:
+    //  first row : -p[n-1]/p[n], ..., -p[0]/p[n]
+    //  sub-diagonal : ones
+    double complex * H = (double complex*) liquid_calloc(n*n, sizeof(double complex));
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        H[i] = -(double complex)_p[n-1-i] / pn;
+        if (i > 0)
+            H[i*n + i-1] = 1.0;
+    }
+
+    if (POLY(_findroots_hessenberg_qr)(H, n, _roots) != 0) {
+        fprintf(stderr,"warning: %s_findroots_companion(), QR iterations failed to converge; using Bairstow's method\n", POLY_NAME);
+        POLY(_findroots_bairstow)(_p,_k,_roots);
+    }
+    liquid_free(H);
 }
 
 // finds the complex roots of the polynomial using the Durand-Kerner method
@@ -328,3 +375,98 @@ void POLY(_findroots_bairstow_recursion)(T *          _p,
 
 }
 
+// eigenvalues of upper Hessenberg matrix using single-shift complex QR
+// iterations with Wilkinson shifts and deflation; only the active
+// diagonal block is updated as the eigenvectors are not needed
+//  _H      :   upper Hessenberg matrix (destroyed) [size: _n x _n]
+//  _n      :   matrix dimension
+//  _roots  :   resulting eigenvalues [size: _n x 1]
+int POLY(_findroots_hessenberg_qr)(double complex * _H,
+                                   unsigned int     _n,
+                                   TC *             _roots)
+{
+#define H(r,c) _H[(r)*_n + (c)]
+    double complex cs[_n];  // Givens rotations (cosine)
+    double complex sn[_n];  // Givens rotations (sine)
+    unsigned int hi = _n-1;
+    unsigned int num_iterations = 0;
+    unsigned int max_iterations = 30*_n;
+    unsigned int j, l, r;
+
+    while (1) {
+        // find lower edge of active block: small sub-diagonal element
+        for (l=hi; l>0; l--) {
+            double s = cabs(H(l-1,l-1)) + cabs(H(l,l));
+            if (cabs(H(l,l-1)) <= 1e-15 * (s == 0 ? 1.0 : s)) {
+                H(l,l-1) = 0;
+                break;
+            }
+        }
+
+        // deflate converged eigenvalue
+        if (l == hi) {
+            _roots[hi] = (TC) H(hi,hi);
+            if (hi == 0)
+                break;
+            hi--;
+            continue;
+        }
+
+        if (num_iterations++ == max_iterations)
+            return -1;
+
+        // Wilkinson shift: eigenvalue of trailing 2x2 block closer to
+        // H(hi,hi), with an occasional exceptional shift to break cycles
+        double complex a = H(hi-1,hi-1);
+        double complex b = H(hi-1,hi);
+        double complex c = H(hi,hi-1);
+        double complex d = H(hi,hi);
+        double complex mu;
+        if ((num_iterations % 11) == 10) {
+            mu = d + cabs(c);
+        } else {
+            double complex t    = 0.5*(a + d);
+            double complex disc = csqrt(0.25*(a-d)*(a-d) + b*c);
+            double complex mu0  = t + disc;
+            double complex mu1  = t - disc;
+            mu = cabs(mu0 - d) < cabs(mu1 - d) ? mu0 : mu1;
+        }
+
+        // QR factorization of shifted active block with Givens rotations
+        for (j=l; j<=hi; j++)
+            H(j,j) -= mu;
+        for (j=l; j<hi; j++) {
+            double complex x = H(j,j);
+            double complex y = H(j+1,j);
+            double g = sqrt(creal(x*conj(x)) + creal(y*conj(y)));
+            if (g == 0) {
+                cs[j] = 1;
+                sn[j] = 0;
+                continue;
+            }
+            cs[j] = x / g;
+            sn[j] = y / g;
+            for (r=j; r<=hi; r++) {
+                double complex u = H(j,  r);
+                double complex v = H(j+1,r);
+                H(j,  r) = conj(cs[j])*u + conj(sn[j])*v;
+                H(j+1,r) = -sn[j]*u      + cs[j]*v;
+            }
+        }
+
+        // recombine in reverse order: R*Q, then undo shift
+        for (j=l; j<hi; j++) {
+            unsigned int rmax = j+1 < hi ? j+1 : hi;
+            for (r=l; r<=rmax; r++) {
+                double complex u = H(r,j);
+                double complex v = H(r,j+1);
+                H(r,j)   = u*cs[j]        + v*sn[j];
+                H(r,j+1) = -u*conj(sn[j]) + v*conj(cs[j]);
+            }
+        }
+        for (j=l; j<=hi; j++)
+            H(j,j) += mu;
+    }
+#undef H
+    return 0;
+}
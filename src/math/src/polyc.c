@@ -37,6 +37,7 @@
 
 #define T_ABS(X)        cabs(X)
 #define TC_ABS(X)       cabs(X)
+#define T_CONJ(X)       conj(X)
 
 #include "poly.common.c"
 #include "poly.expand.c"
@@ -37,6 +37,10 @@
 
 #define T_ABS(X)        fabsf(X)
 #define TC_ABS(X)       cabsf(X)
+#define T_CONJ(X)       (X)
+
+// vector operations for batched evaluation
+#define POLY_VECTOR(name) LIQUID_CONCAT(liquid_vectorf, name)
 
 #include "poly.common.c"
 #include "poly.expand.c"
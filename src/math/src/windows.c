@@ -40,6 +40,33 @@
 
 #include "liquid.internal.h"
 
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+static pthread_mutex_t liquid_kaiser_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LIQUID_KAISER_CACHE_LOCK()   pthread_mutex_lock(&liquid_kaiser_cache_mutex)
+#define LIQUID_KAISER_CACHE_UNLOCK() pthread_mutex_unlock(&liquid_kaiser_cache_mutex)
+#else
+#define LIQUID_KAISER_CACHE_LOCK()
+#define LIQUID_KAISER_CACHE_UNLOCK()
+#endif
+
+// table of recently generated Kaiser windows, keyed by (length, beta,
+// offset); filter designs searching over cut-off frequency (e.g.
+// rkaiser) regenerate the same window many times
+#define LIQUID_KAISER_CACHE_SIZE    (8)     // number of cached windows
+#define LIQUID_KAISER_CACHE_MAX_LEN (1024)  // longest cached window
+
+struct liquid_kaiser_cache_entry_s {
+    unsigned int n;                         // window length
+    float        beta;                      // window shape parameter
+    float        mu;                        // fractional sample offset
+    float        w[LIQUID_KAISER_CACHE_MAX_LEN];
+};
+
+static struct liquid_kaiser_cache_entry_s liquid_kaiser_cache[LIQUID_KAISER_CACHE_SIZE];
+static unsigned int liquid_kaiser_cache_num_entries = 0;
+static unsigned int liquid_kaiser_cache_next        = 0;
+
 const char * liquid_window_str[LIQUID_WINDOW_NUM_FUNCTIONS][2] = {
     // short name,  long name
     {"unknown",         "unknown"                   },
@@ -158,8 +185,7 @@ void liquid_kbd_window(unsigned int _n,
 
     // generate regular Kaiser window, length M+1
     float w_kaiser[M+1];
-    for (i=0; i<=M; i++)
-        w_kaiser[i] = kaiser(i,M+1,_beta,0.0f);
+    liquid_kaiser_window(M+1,_beta,0.0f,w_kaiser);
 
     // compute sum(wk[])
     float w_sum = 0.0f;
@@ -208,6 +234,76 @@ float kaiser(unsigned int _n,
     return a / b;
 }
 
+// Kaiser window (full window) [Kaiser:1980]; equivalent to evaluating
+// kaiser() for each sample but computes the normalization once and
+// serves repeated requests from a small table
+//  _n      :   window length (samples)
+//  _beta   :   window taper parameter
+//  _mu     :   fractional sample offset
+//  _w      :   resulting window [size: _n x 1]
+void liquid_kaiser_window(unsigned int _n,
+                          float        _beta,
+                          float        _mu,
+                          float *      _w)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: liquid_kaiser_window(), window length must be greater than zero\n");
+        exit(1);
+    } else if (_beta < 0) {
+        fprintf(stderr,"error: liquid_kaiser_window(), beta must be greater than or equal to zero\n");
+        exit(1);
+    } else if (_mu < -0.5 || _mu > 0.5) {
+        fprintf(stderr,"error: liquid_kaiser_window(), fractional sample offset must be in [-0.5,0.5]\n");
+        exit(1);
+    }
+
+    unsigned int i;
+    int cacheable = _n <= LIQUID_KAISER_CACHE_MAX_LEN;
+    if (cacheable) {
+        int found = 0;
+        LIQUID_KAISER_CACHE_LOCK();
+        for (i=0; i<liquid_kaiser_cache_num_entries; i++) {
+            struct liquid_kaiser_cache_entry_s * e = &liquid_kaiser_cache[i];
+            if (e->n == _n && e->beta == _beta && e->mu == _mu) {
+                memmove(_w, e->w, _n*sizeof(float));
+                found = 1;
+                break;
+            }
+        }
+        LIQUID_KAISER_CACHE_UNLOCK();
+        if (found)
+            return;
+    }
+
+    // window argument beta*sqrt(1-r^2) for each sample
+    float z[_n];
+    for (i=0; i<_n; i++) {
+        float t = (float)i - (float)(_n-1)/2 + _mu;
+        float r = 2.0f*t/(float)(_n);
+        z[i] = r*r < 1.0f ? _beta*sqrtf(1-r*r) : 0.0f;
+    }
+    liquid_besseli0f_block(z, _n, _w);
+
+    // normalize
+    float b = liquid_besseli0f(_beta);
+    for (i=0; i<_n; i++)
+        _w[i] /= b;
+
+    if (cacheable) {
+        LIQUID_KAISER_CACHE_LOCK();
+        struct liquid_kaiser_cache_entry_s * e = &liquid_kaiser_cache[liquid_kaiser_cache_next];
+        e->n    = _n;
+        e->beta = _beta;
+        e->mu   = _mu;
+        memmove(e->w, _w, _n*sizeof(float));
+        liquid_kaiser_cache_next = (liquid_kaiser_cache_next + 1) % LIQUID_KAISER_CACHE_SIZE;
+        if (liquid_kaiser_cache_num_entries < LIQUID_KAISER_CACHE_SIZE)
+            liquid_kaiser_cache_num_entries++;
+        LIQUID_KAISER_CACHE_UNLOCK();
+    }
+}
+
 // Hamming window
 float hamming(unsigned int _n,
               unsigned int _N)
@@ -57,3 +57,29 @@ void autotest_kbd_n16() { liquid_kbd_window_test(16, 10.0f); }
 void autotest_kbd_n32() { liquid_kbd_window_test(32, 20.0f); }
 void autotest_kbd_n48() { liquid_kbd_window_test(48, 12.0f); }
 
+// 
+// AUTOTEST: Kaiser window (full window, cached)
+//
+void autotest_kaiser_window()
+{
+    unsigned int n = 51;
+    float        beta = 6.0f;
+    float        mu   = 0.25f;
+    float w0[n];
+    float w1[n];
+    unsigned int i;
+
+    // first call generates the window, second is served from the table
+    liquid_kaiser_window(n, beta, mu, w0);
+    liquid_kaiser_window(n, beta, mu, w1);
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA(w0[i], kaiser(i,n,beta,mu), 1e-5f);
+        CONTEND_EQUALITY(w0[i], w1[i]);
+    }
+
+    // different offset must not alias the cached entry
+    liquid_kaiser_window(n, beta, 0.0f, w1);
+    for (i=0; i<n; i++)
+        CONTEND_DELTA(w1[i], kaiser(i,n,beta,0.0f), 1e-5f);
+}
+
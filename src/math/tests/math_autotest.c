@@ -50,6 +50,69 @@ void autotest_sincf()
     CONTEND_DELTA(sincf(0.0f), 1.0f, tol);
 }
 
+// 
+// AUTOTEST: sincf (block)
+//
+void autotest_sincf_block()
+{
+    // span integers, half integers, zero and negative arguments
+    unsigned int n = 401;
+    float x[n];
+    float y[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = 0.05f*(float)i - 10.0f;
+    sincf_block(x, n, y);
+
+    float tol = 1e-6f;
+    for (i=0; i<n; i++)
+        CONTEND_DELTA(y[i], sincf(x[i]), tol);
+}
+
+//
+// AUTOTEST: liquid_sincosf_block, all accuracy tiers at each SIMD
+// level available on this host, including arguments beyond the
+// polynomial range and block tails
+//
+void autotest_sincosf_block()
+{
+    unsigned int n = 203;
+    float theta[n], s[n], c[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        theta[i] = 0.37f*(float)i - 30.0f;
+    theta[17] = 1e4f;
+    theta[18] = -2.5e5f;
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        liquid_sincosf_block(theta, n, s, c, LIQUID_TRIG_EXACT);
+        for (i=0; i<n; i++) {
+            CONTEND_EQUALITY(s[i], sinf(theta[i]));
+            CONTEND_EQUALITY(c[i], cosf(theta[i]));
+        }
+
+        liquid_sincosf_block(theta, n, s, c, LIQUID_TRIG_FAST);
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA(s[i], sinf(theta[i]), 1e-6f);
+            CONTEND_DELTA(c[i], cosf(theta[i]), 1e-6f);
+        }
+
+        liquid_sincosf_block(theta, n, s, c, LIQUID_TRIG_COARSE);
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA(s[i], sinf(theta[i]), 2e-6f);
+            CONTEND_DELTA(c[i], cosf(theta[i]), 2e-6f);
+        }
+    }
+    liquid_simd_set_level(host);
+}
+
 // 
 // AUTOTEST: nextpow2
 //
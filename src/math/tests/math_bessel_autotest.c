@@ -105,6 +105,27 @@ void autotest_besseli0f()
     CONTEND_DELTA(liquid_besseli0f(3.0f), 4.88079258586503f, tol);
 }
 
+// 
+// AUTOTEST: Modified Bessel function of the first kind (block)
+//
+void autotest_besseli0f_block()
+{
+    float z[8] = {0.0f, 0.1f, 1.0f, 3.0f, 3.75f, 5.0f, 10.0f, 20.0f};
+    float y_test[8] = {
+        1.00000000000000,   1.00250156293410,   1.26606587775201,
+        4.88079258586503,   9.11894586084457,  27.2398718236044,
+        2815.71662846625,   43558282.5595535};
+    float y[8];
+    liquid_besseli0f_block(z, 8, y);
+
+    // relative error
+    unsigned int i;
+    for (i=0; i<8; i++) {
+        CONTEND_DELTA(y[i]/y_test[i], 1.0f, 1e-5f);
+        CONTEND_EQUALITY(y[i], liquid_besseli0f(z[i]));
+    }
+}
+
 // 
 // AUTOTEST: Bessel function of the first kind
 //
@@ -127,6 +127,27 @@ void autotest_lngamma()
     CONTEND_DELTA( liquid_lngammaf(170), 701.437263808737, tol);
 }
 
+// 
+// AUTOTEST: lngamma (block)
+//
+void autotest_lngamma_block()
+{
+    float z[6] = {1e-3f, 0.5f, 1.0f, 2.5f, 9.9f, 25.0f};
+    float y[6];
+    liquid_lngammaf_block(z, 6, y);
+
+    unsigned int i;
+    for (i=0; i<6; i++)
+        CONTEND_EQUALITY(y[i], liquid_lngammaf(z[i]));
+
+    CONTEND_DELTA( y[0], 6.90717888538385e+00, 1e-4f );
+    CONTEND_DELTA( y[1], 5.72364942924700e-01, 1e-4f );
+    CONTEND_DELTA( y[2], 0.0f,                 1e-4f );
+    CONTEND_DELTA( y[3], 2.84682870472920e-01, 1e-4f );
+    CONTEND_DELTA( y[4], 1.25771799042199e+01, 1e-4f );
+    CONTEND_DELTA( y[5], 5.47847293981123e+01, 1e-4f );
+}
+
 // 
 // AUTOTEST: upper incomplete Gamma
 //
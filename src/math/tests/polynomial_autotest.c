@@ -361,7 +361,7 @@ void autotest_polyf_findroots()
 // 
 // AUTOTEST: polycf_findroots (random roots)
 //
-void xautotest_polycf_findroots_rand()
+void autotest_polycf_findroots_rand()
 {
     unsigned int n=5;
     float tol=1e-4f;
@@ -377,12 +377,8 @@ void xautotest_polycf_findroots_rand()
 
     polycf_findroots(p,n,roots);
 
-    float complex roots_hat[n-1];
-    // convert form...
-    for (i=0; i<n-1; i++)
-        roots_hat[i] = -roots[i];
-
-    polycf_expandroots(roots_hat,n-1,p_hat);
+    // expand roots: (x-r[0])*(x-r[1])*...
+    polycf_expandroots(roots,n-1,p_hat);
 
     if (liquid_autotest_verbose) {
         printf("poly:\n");
@@ -404,3 +400,111 @@ void xautotest_polycf_findroots_rand()
     }
 }
 
+// 
+// AUTOTEST: polyf_val_batch, polycf_val_batch
+//
+void autotest_polyf_val_batch()
+{
+    unsigned int k = 7;     // polynomial length
+    unsigned int n = 531;   // number of points (not a multiple of block)
+    float tol = 1e-4f;
+
+    float p[k];
+    float x[n];
+    float y[n];
+    unsigned int i;
+    for (i=0; i<k; i++) p[i] = randnf();
+    for (i=0; i<n; i++) x[i] = 2.0f*randf() - 1.0f;
+
+    polyf_val_batch(p, k, x, n, y);
+    for (i=0; i<n; i++)
+        CONTEND_DELTA(y[i], polyf_val(p, k, x[i]), tol);
+}
+
+void autotest_polycf_val_batch()
+{
+    unsigned int k = 5;     // polynomial length
+    unsigned int n = 301;   // number of points
+    float tol = 1e-4f;
+
+    float complex p[k];
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    for (i=0; i<k; i++) p[i] = randnf() + _Complex_I*randnf();
+    for (i=0; i<n; i++) x[i] = (randf() - 0.5f) + _Complex_I*(randf() - 0.5f);
+
+    polycf_val_batch(p, k, x, n, y);
+    for (i=0; i<n; i++) {
+        float complex y_test = polycf_val(p, k, x[i]);
+        CONTEND_DELTA(crealf(y[i]), crealf(y_test), tol);
+        CONTEND_DELTA(cimagf(y[i]), cimagf(y_test), tol);
+    }
+}
+
+// 
+// AUTOTEST: polyf_fit linear, closed-form path
+//
+void autotest_polyf_fit_q1n16()
+{
+    unsigned int n = 16;
+    float x[n];
+    float y[n];
+    float p[2];
+    float tol = 1e-4f;
+
+    // y = 0.5 - 1.25 x, with symmetric perturbation
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        x[i] = (float)i / (float)n - 0.3f;
+        y[i] = 0.5f - 1.25f*x[i] + ((i%2) ? 0.01f : -0.01f);
+    }
+
+    polyf_fit(x,y,n, p,2);
+    CONTEND_DELTA(p[0],  0.5f,  0.01f);
+    CONTEND_DELTA(p[1], -1.25f, 0.05f);
+
+    // closed form must agree with a general (higher-order) fit whose
+    // quadratic term is negligible for linear data
+    float y2[n];
+    for (i=0; i<n; i++)
+        y2[i] = 0.5f - 1.25f*x[i];
+    float q[4];
+    polyf_fit(x,y2,n, p,2);
+    polyf_fit(x,y2,n, q,4);
+    CONTEND_DELTA(p[0], q[0], tol);
+    CONTEND_DELTA(p[1], q[1], tol);
+}
+
+// 
+// AUTOTEST: polyf_findroots_companion, complex-conjugate roots
+//
+void autotest_polyf_findroots_companion()
+{
+    float tol = 1e-5f;
+
+    // roots: {1 +/- 2j, -0.5, 3}
+    float complex r[4] = {1.0f+2.0f*_Complex_I, 1.0f-2.0f*_Complex_I, -0.5f, 3.0f};
+    float complex pc[5];
+    polycf_expandroots(r, 4, pc);
+    float p[5];
+    unsigned int i;
+    for (i=0; i<5; i++)
+        p[i] = crealf(pc[i]);
+
+    float complex roots[4];
+    polyf_findroots_companion(p, 5, roots);
+
+    // match each root
+    unsigned int j, num_matched = 0;
+    for (i=0; i<4; i++) {
+        for (j=0; j<4; j++) {
+            if (cabsf(roots[i] - r[j]) < tol) {
+                num_matched++;
+                break;
+            }
+        }
+    }
+    CONTEND_EQUALITY(num_matched, 4);
+}
+
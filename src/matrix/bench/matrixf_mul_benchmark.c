@@ -67,4 +67,5 @@ void benchmark_matrixf_mul_n8      MATRIXF_MUL_BENCHMARK_API(8)
 void benchmark_matrixf_mul_n16     MATRIXF_MUL_BENCHMARK_API(16)
 void benchmark_matrixf_mul_n32     MATRIXF_MUL_BENCHMARK_API(32)
 void benchmark_matrixf_mul_n64     MATRIXF_MUL_BENCHMARK_API(64)
+void benchmark_matrixf_mul_n128    MATRIXF_MUL_BENCHMARK_API(128)
 
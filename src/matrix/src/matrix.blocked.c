@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Cache-blocked matrix kernels: multiply, LU factorization and
+// triangular solves shared by the multiply, inverse, linear solver and
+// Cholesky methods
+//
+// All products are formed as Z = X * Yt^T where both X and Yt are
+// row-major with the inner dimension contiguous, so the innermost
+// kernel is a set of unit-stride dot products (MATRIX_DOT2X4) computing
+// a 2x4 tile of the output at a time.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#if defined(MATRIX_CBLAS_GEMM) && HAVE_CBLAS
+#include <cblas.h>
+#endif
+
+// block sizes: a KC-long slice of NC rows of Yt stays resident in the
+// L2 cache while MC rows of X stream past it
+#define MATRIX_BLOCK_MC     (64)
+#define MATRIX_BLOCK_NC     (64)
+#define MATRIX_BLOCK_KC     (256)
+
+// panel width for the LU/Cholesky factorizations and triangular solves
+#define MATRIX_BLOCK_NB     (32)
+
+// use the external BLAS/LAPACK (if enabled) at or above this dimension
+#define MATRIX_BLAS_MIN     (64)
+
+#ifndef MATRIX_DOT2X4
+// portable tile kernel for types without a vectorized version
+static void MATRIX(_dot2x4_portable)(T *          _x[2],
+                                     T *          _y[4],
+                                     unsigned int _n,
+                                     T *          _z)
+{
+    // independent accumulators for each output
+    T * x0 = _x[0], * x1 = _x[1];
+    T * y0 = _y[0], * y1 = _y[1], * y2 = _y[2], * y3 = _y[3];
+    T z00 = 0, z01 = 0, z02 = 0, z03 = 0;
+    T z10 = 0, z11 = 0, z12 = 0, z13 = 0;
+    unsigned int k;
+    for (k=0; k<_n; k++) {
+        z00 += x0[k] * y0[k];   z10 += x1[k] * y0[k];
+        z01 += x0[k] * y1[k];   z11 += x1[k] * y1[k];
+        z02 += x0[k] * y2[k];   z12 += x1[k] * y2[k];
+        z03 += x0[k] * y3[k];   z13 += x1[k] * y3[k];
+    }
+    _z[0] = z00; _z[1] = z01; _z[2] = z02; _z[3] = z03;
+    _z[4] = z10; _z[5] = z11; _z[6] = z12; _z[7] = z13;
+}
+#define MATRIX_DOT2X4 MATRIX(_dot2x4_portable)
+#endif
+
+// blocked product Z = X * Yt^T
+//  _X      :   input matrix [size: _M x _K, row stride _ldx]
+//  _Yt     :   transposed input matrix [size: _N x _K, row stride _ldy]
+//  _Z      :   output matrix [size: _M x _N, row stride _ldz]
+//  _mode   :   0 : Z = X*Yt^T,  1 : Z += X*Yt^T,  -1 : Z -= X*Yt^T
+static void MATRIX(_gemm_nt)(T *          _X,
+                             unsigned int _ldx,
+                             T *          _Yt,
+                             unsigned int _ldy,
+                             T *          _Z,
+                             unsigned int _ldz,
+                             unsigned int _M,
+                             unsigned int _N,
+                             unsigned int _K,
+                             int          _mode)
+{
+    if (_M == 0 || _N == 0)
+        return;
+    if (_K == 0) {
+        // empty inner dimension: product is zero
+        unsigned int i, j;
+        if (_mode == 0) {
+            for (i=0; i<_M; i++) {
+                for (j=0; j<_N; j++)
+                    _Z[i*_ldz + j] = 0;
+            }
+        }
+        return;
+    }
+
+    unsigned int kk, jj, ii;
+    unsigned int i, j, q;
+    T * x[2];
+    T * y[4];
+    T   z[8];
+    for (kk=0; kk<_K; kk+=MATRIX_BLOCK_KC) {
+        unsigned int kc = _K - kk < MATRIX_BLOCK_KC ? _K - kk : MATRIX_BLOCK_KC;
+        // only the first slice overwrites the output
+        int mode = (kk == 0 || _mode != 0) ? _mode : 1;
+
+        for (jj=0; jj<_N; jj+=MATRIX_BLOCK_NC) {
+            unsigned int jn = _N - jj < MATRIX_BLOCK_NC ? _N : jj + MATRIX_BLOCK_NC;
+
+            for (ii=0; ii<_M; ii+=MATRIX_BLOCK_MC) {
+                unsigned int in = _M - ii < MATRIX_BLOCK_MC ? _M : ii + MATRIX_BLOCK_MC;
+
+                for (i=ii; i<in; i+=2) {
+                    // clamp edge rows/columns to valid data; the
+                    // duplicated results are discarded below
+                    x[0] = _X + i*_ldx + kk;
+                    x[1] = _X + (i+1 < in ? i+1 : i)*_ldx + kk;
+                    unsigned int ni = i+1 < in ? 2 : 1;
+
+                    for (j=jj; j<jn; j+=4) {
+                        for (q=0; q<4; q++)
+                            y[q] = _Yt + (j+q < jn ? j+q : j)*_ldy + kk;
+                        MATRIX_DOT2X4(x, y, kc, z);
+
+                        unsigned int nj = jn - j < 4 ? jn - j : 4;
+                        unsigned int r, c;
+                        for (r=0; r<ni; r++) {
+                            T * zp = _Z + (i+r)*_ldz + j;
+                            if (mode == 0) {
+                                for (c=0; c<nj; c++) zp[c]  = z[4*r+c];
+                            } else if (mode > 0) {
+                                for (c=0; c<nj; c++) zp[c] += z[4*r+c];
+                            } else {
+                                for (c=0; c<nj; c++) zp[c] -= z[4*r+c];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// blocked multiply: Z = X * Y, with Y packed into transposed form
+//  _X      :   input matrix [size: _M x _K]
+//  _Y      :   input matrix [size: _K x _N]
+//  _Z      :   output matrix [size: _M x _N]
+static void MATRIX(_mul_blocked)(T *          _X,
+                                 T *          _Y,
+                                 T *          _Z,
+                                 unsigned int _M,
+                                 unsigned int _N,
+                                 unsigned int _K)
+{
+    T * Yt = (T*) liquid_malloc(_N*_K*sizeof(T));
+    unsigned int k, j;
+    for (k=0; k<_K; k++) {
+        for (j=0; j<_N; j++)
+            Yt[j*_K + k] = _Y[k*_N + j];
+    }
+
+    MATRIX(_gemm_nt)(_X, _K, Yt, _K, _Z, _N, _M, _N, _K, 0);
+    liquid_free(Yt);
+}
+
+// LU factorization with partial pivoting, in place: P*A = L*U with L
+// unit lower-triangular and U upper-triangular stored in _A (right-
+// looking, blocked: each panel of MATRIX_BLOCK_NB columns is factored
+// unblocked and the trailing matrix is updated with one product)
+//  _A      :   input/output matrix [size: _n x _n]
+//  _n      :   matrix dimension
+//  _piv    :   row swapped with row k at step k [size: _n x 1]
+//  returns number of zero pivots (non-zero if A is singular)
+int MATRIX(_lufactor)(T *            _A,
+                      unsigned int   _n,
+                      unsigned int * _piv)
+{
+    int num_zero = 0;
+    T * Ut = (T*) liquid_malloc(_n*MATRIX_BLOCK_NB*sizeof(T));
+
+    unsigned int kb, k, r, c;
+    for (kb=0; kb<_n; kb+=MATRIX_BLOCK_NB) {
+        unsigned int nb = _n - kb < MATRIX_BLOCK_NB ? _n - kb : MATRIX_BLOCK_NB;
+        unsigned int ke = kb + nb;
+
+        // factor panel [kb:_n, kb:ke]
+        for (k=kb; k<ke; k++) {
+            // choose pivot row based on maximum element along column
+            unsigned int r_opt = k;
+            TP v_max = T_ABS(_A[k*_n + k]);
+            for (r=k+1; r<_n; r++) {
+                TP v = T_ABS(_A[r*_n + k]);
+                if (v > v_max) {
+                    r_opt = r;
+                    v_max = v;
+                }
+            }
+            _piv[k] = r_opt;
+            MATRIX(_swaprows)(_A, _n, _n, k, r_opt);
+
+            if (v_max == 0) {
+                num_zero++;
+                continue;
+            }
+
+            T g = 1 / _A[k*_n + k];
+            for (r=k+1; r<_n; r++) {
+                T * a = _A + r*_n;
+                a[k] *= g;
+                T l = a[k];
+                for (c=k+1; c<ke; c++)
+                    a[c] -= l * _A[k*_n + c];
+            }
+        }
+
+        if (ke == _n)
+            break;
+
+        // U12 = inv(L11) * A12
+        for (k=kb; k<ke; k++) {
+            for (r=k+1; r<ke; r++) {
+                T l = _A[r*_n + k];
+                for (c=ke; c<_n; c++)
+                    _A[r*_n + c] -= l * _A[k*_n + c];
+            }
+        }
+
+        // A22 -= L21 * U12
+        unsigned int m = _n - ke;
+        for (c=0; c<m; c++) {
+            for (k=0; k<nb; k++)
+                Ut[c*nb + k] = _A[(kb+k)*_n + ke + c];
+        }
+        MATRIX(_gemm_nt)(_A + ke*_n + kb, _n, Ut, nb,
+                         _A + ke*_n + ke, _n, m, m, nb, -1);
+    }
+
+    liquid_free(Ut);
+    return num_zero;
+}
+
+// solve A * X = B in place given the LU factorization of A
+//  _LU     :   factored matrix from _lufactor() [size: _n x _n]
+//  _n      :   matrix dimension
+//  _piv    :   pivot indices from _lufactor() [size: _n x 1]
+//  _B      :   right-hand side, overwritten with X [size: _n x _nrhs]
+//  _nrhs   :   number of right-hand sides
+void MATRIX(_lusolve)(T *            _LU,
+                      unsigned int   _n,
+                      unsigned int * _piv,
+                      T *            _B,
+                      unsigned int   _nrhs)
+{
+    unsigned int k, r, c;
+
+    // apply row permutation
+    for (k=0; k<_n; k++)
+        MATRIX(_swaprows)(_B, _n, _nrhs, k, _piv[k]);
+
+    if (_nrhs < 4) {
+        // few right-hand sides: unit-stride substitution along rows of LU
+        for (c=0; c<_nrhs; c++) {
+            for (r=0; r<_n; r++) {
+                T sum = _B[r*_nrhs + c];
+                for (k=0; k<r; k++)
+                    sum -= _LU[r*_n + k] * _B[k*_nrhs + c];
+                _B[r*_nrhs + c] = sum;
+            }
+            for (r=_n; r-- > 0; ) {
+                T sum = _B[r*_nrhs + c];
+                for (k=r+1; k<_n; k++)
+                    sum -= _LU[r*_n + k] * _B[k*_nrhs + c];
+                _B[r*_nrhs + c] = sum / _LU[r*_n + r];
+            }
+        }
+        return;
+    }
+
+    // blocked substitution: solve each diagonal block by row operations
+    // and update the remaining rows of B with one product
+    T * Bt = (T*) liquid_malloc(_nrhs*MATRIX_BLOCK_NB*sizeof(T));
+    unsigned int kb;
+
+    // forward substitution: L * Y = P * B
+    for (kb=0; kb<_n; kb+=MATRIX_BLOCK_NB) {
+        unsigned int nb = _n - kb < MATRIX_BLOCK_NB ? _n - kb : MATRIX_BLOCK_NB;
+        unsigned int ke = kb + nb;
+        for (r=kb; r<ke; r++) {
+            for (k=kb; k<r; k++) {
+                T l = _LU[r*_n + k];
+                for (c=0; c<_nrhs; c++)
+                    _B[r*_nrhs + c] -= l * _B[k*_nrhs + c];
+            }
+        }
+        if (ke == _n)
+            break;
+        for (c=0; c<_nrhs; c++) {
+            for (k=0; k<nb; k++)
+                Bt[c*nb + k] = _B[(kb+k)*_nrhs + c];
+        }
+        MATRIX(_gemm_nt)(_LU + ke*_n + kb, _n, Bt, nb,
+                         _B + ke*_nrhs, _nrhs, _n - ke, _nrhs, nb, -1);
+    }
+
+    // backward substitution: U * X = Y
+    unsigned int nblocks = (_n + MATRIX_BLOCK_NB - 1) / MATRIX_BLOCK_NB;
+    while (nblocks-- > 0) {
+        kb = nblocks * MATRIX_BLOCK_NB;
+        unsigned int nb = _n - kb < MATRIX_BLOCK_NB ? _n - kb : MATRIX_BLOCK_NB;
+        unsigned int ke = kb + nb;
+        for (r=ke; r-- > kb; ) {
+            for (k=r+1; k<ke; k++) {
+                T u = _LU[r*_n + k];
+                for (c=0; c<_nrhs; c++)
+                    _B[r*_nrhs + c] -= u * _B[k*_nrhs + c];
+            }
+            T g = 1 / _LU[r*_n + r];
+            for (c=0; c<_nrhs; c++)
+                _B[r*_nrhs + c] *= g;
+        }
+        if (kb == 0)
+            break;
+        for (c=0; c<_nrhs; c++) {
+            for (k=0; k<nb; k++)
+                Bt[c*nb + k] = _B[(kb+k)*_nrhs + c];
+        }
+        MATRIX(_gemm_nt)(_LU + kb, _n, Bt, nb,
+                         _B, _nrhs, kb, _nrhs, nb, -1);
+    }
+
+    liquid_free(Bt);
+}
+
+#if defined(MATRIX_LAPACK) && HAVE_LAPACK
+// LAPACK routines (Fortran calling convention; character arguments
+// carry a hidden trailing length)
+void MATRIX_LAPACK(getrf)(int * _m, int * _n, T * _a, int * _lda, int * _ipiv, int * _info);
+void MATRIX_LAPACK(getri)(int * _n, T * _a, int * _lda, int * _ipiv, T * _work, int * _lwork, int * _info);
+void MATRIX_LAPACK(getrs)(char * _trans, int * _n, int * _nrhs, T * _a, int * _lda, int * _ipiv,
+                          T * _b, int * _ldb, int * _info, size_t _trans_len);
+void MATRIX_LAPACK(potrf)(char * _uplo, int * _n, T * _a, int * _lda, int * _info, size_t _uplo_len);
+#endif
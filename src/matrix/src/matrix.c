@@ -40,6 +40,7 @@
     printf("%12.8f", matrix_access(X,R,C,r,c));
 
 #include "matrix.base.c"
+#include "matrix.blocked.c"
 #include "matrix.cgsolve.c"
 #include "matrix.chol.c"
 #include "matrix.gramschmidt.c"
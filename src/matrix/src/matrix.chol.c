@@ -25,6 +25,9 @@
 //
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "liquid.internal.h"
 
 #define DEBUG_MATRIX_CHOL 0
@@ -38,65 +41,130 @@ void MATRIX(_chol)(T *          _A,
                    unsigned int _n,
                    T *          _L)
 {
-    // reset L
     unsigned int i;
-    for (i=0; i<_n*_n; i++)
-        _L[i] = 0.0;
-
     unsigned int j;
     unsigned int k;
-    T  A_jj;
-    T  L_jj;
-    T  L_ik;
-    T  L_jk;
-    TP t0;
-    T  t1;
-    for (j=0; j<_n; j++) {
-        // assert that A_jj is real, positive
-        A_jj = matrix_access(_A,_n,_n,j,j);
-        if ( creal(A_jj) < 0.0 ) {
-            fprintf(stderr,"warning: matrix_chol(), matrix is not positive definite (real{A[%u,%u]} = %12.4e < 0)\n",j,j,creal(A_jj));
+
+#if defined(MATRIX_LAPACK) && HAVE_LAPACK
+    // the row-major lower factor is the column-major upper factor
+    if (_n >= MATRIX_BLAS_MIN) {
+        int n = (int)_n;
+        int info = 0;
+        char uplo = 'U';
+        memmove(_L, _A, _n*_n*sizeof(T));
+        MATRIX_LAPACK(potrf)(&uplo, &n, _L, &n, &info, 1);
+        if (info == 0) {
+            for (i=0; i<_n; i++) {
+                for (j=i+1; j<_n; j++)
+                    matrix_access(_L,_n,_n,i,j) = 0.0;
+            }
             return;
         }
+        // not positive definite: fall back to the internal path (and
+        // its warnings)
+    }
+#endif
+
+    // copy lower triangle of A into L; the factorization runs in place
+    for (i=0; i<_n; i++) {
+        for (j=0; j<_n; j++)
+            matrix_access(_L,_n,_n,i,j) = j <= i ? matrix_access(_A,_n,_n,i,j) : 0.0;
+    }
+
+    // right-looking blocked factorization: each panel of
+    // MATRIX_BLOCK_NB columns is factored directly and the trailing
+    // lower triangle is updated in row strips with one product each
 #if T_COMPLEX
-        if ( fabs(cimag(A_jj)) > 0.0 ) {
-            fprintf(stderr,"warning: matrix_chol(), matrix is not positive definite (|imag{A[%u,%u]}| = %12.4e > 0)\n",j,j,fabs(cimag(A_jj)));
-            return;
-        }
+    T * Lt = (T*) liquid_malloc(_n*MATRIX_BLOCK_NB*sizeof(T));
 #endif
+    unsigned int jb;
+    T  A_jj;
+    TP L_jj;
+    TP d;
+    for (jb=0; jb<_n; jb+=MATRIX_BLOCK_NB) {
+        unsigned int nb = _n - jb < MATRIX_BLOCK_NB ? _n - jb : MATRIX_BLOCK_NB;
+        unsigned int je = jb + nb;
 
-        // compute L_jj and store it in output matrix
-        t0 = 0.0;
-        for (k=0; k<j; k++) {
-            L_jk = matrix_access(_L,_n,_n,j,k);
+        // factor panel [jb:_n, jb:je]
+        for (j=jb; j<je; j++) {
+            // assert that A_jj is real, positive
+            A_jj = matrix_access(_A,_n,_n,j,j);
+            d = creal( matrix_access(_L,_n,_n,j,j) );
+            if ( creal(A_jj) < 0.0 ) {
+                fprintf(stderr,"warning: matrix_chol(), matrix is not positive definite (real{A[%u,%u]} = %12.4e < 0)\n",j,j,creal(A_jj));
+                goto chol_fail;
+            }
 #if T_COMPLEX
-            t0 += creal( L_jk * conj(L_jk) );
-#else
-            t0 += L_jk * L_jk;
+            if ( fabs(cimag(A_jj)) > 0.0 ) {
+                fprintf(stderr,"warning: matrix_chol(), matrix is not positive definite (|imag{A[%u,%u]}| = %12.4e > 0)\n",j,j,fabs(cimag(A_jj)));
+                goto chol_fail;
+            }
 #endif
-        }
-        // test to ensure A_jj > t0
-        if ( creal(A_jj) < t0 ) {
-            fprintf(stderr,"warning: matrix_chol(), matrix is not positive definite (real{A[%u,%u]} = %12.4e < %12.4e)\n",j,j,creal(A_jj),t0);
-            return;
-        }
-        L_jj = sqrt( A_jj - t0 );
-        matrix_access(_L,_n,_n,j,j) = L_jj;
+            // test to ensure A_jj > sum(|L_jk|^2)
+            if ( d < 0.0 ) {
+                fprintf(stderr,"warning: matrix_chol(), matrix is not positive definite (real{A[%u,%u]} = %12.4e < %12.4e)\n",j,j,creal(A_jj),creal(A_jj)-d);
+                goto chol_fail;
+            }
+            L_jj = sqrt(d);
+            matrix_access(_L,_n,_n,j,j) = L_jj;
 
-        for (i=j+1; i<_n; i++) {
-            t1 = matrix_access(_A,_n,_n,i,j);
-            for (k=0; k<j; k++) {
-                L_ik = matrix_access(_L,_n,_n,i,k);
-                L_jk = matrix_access(_L,_n,_n,j,k);
+            TP g = 1.0 / L_jj;
+            for (i=j+1; i<_n; i++) {
+                T * l = _L + i*_n;
+                l[j] *= g;
+                // update remaining panel columns
+                unsigned int ce = i < je ? i+1 : je;
+                for (k=j+1; k<ce; k++) {
 #if T_COMPLEX
-                t1 -= L_ik * conj(L_jk);
+                    l[k] -= l[j] * conj(matrix_access(_L,_n,_n,k,j));
 #else
-                t1 -= L_ik * L_jk;
+                    l[k] -= l[j] * matrix_access(_L,_n,_n,k,j);
 #endif
+                }
             }
-            // TODO : store inverse of L_jj to reduce number of divisions
-            matrix_access(_L,_n,_n,i,j) = t1 / L_jj;
+        }
+
+        if (je == _n)
+            break;
+
+        // L22 -= L21 * L21^H, lower triangle only
+        unsigned int m = _n - je;
+        T * L21 = _L + je*_n + jb;
+        T * Yt  = L21;
+        unsigned int ldy = _n;
+#if T_COMPLEX
+        for (i=0; i<m; i++) {
+            for (k=0; k<nb; k++)
+                Lt[i*nb + k] = conj(L21[i*_n + k]);
+        }
+        Yt  = Lt;
+        ldy = nb;
+#endif
+        for (i=0; i<m; i+=MATRIX_BLOCK_MC) {
+            unsigned int mi = m - i < MATRIX_BLOCK_MC ? m - i : MATRIX_BLOCK_MC;
+            MATRIX(_gemm_nt)(L21 + i*_n, _n, Yt, ldy,
+                             _L + (je+i)*_n + je, _n, mi, i+mi, nb, -1);
         }
     }
+
+    // clear upper triangle written by the strip updates
+    for (i=0; i<_n; i++) {
+        for (j=i+1; j<_n; j++)
+            matrix_access(_L,_n,_n,i,j) = 0.0;
+    }
+#if T_COMPLEX
+    liquid_free(Lt);
+#endif
+    return;
+
+chol_fail:
+    // keep only the completed columns (0, j]
+    for (i=0; i<_n; i++) {
+        for (k=(i < j ? i+1 : j); k<_n; k++)
+            matrix_access(_L,_n,_n,i,k) = 0.0;
+    }
+#if T_COMPLEX
+    liquid_free(Lt);
+#endif
 }
 
@@ -24,6 +24,9 @@
 // Matrix inverse method definitions
 //
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "liquid.internal.h"
 
 void MATRIX(_inv)(T * _X, unsigned int _XR, unsigned int _XC)
@@ -34,46 +37,43 @@ void MATRIX(_inv)(T * _X, unsigned int _XR, unsigned int _XC)
         exit(1);
     }
 
-    // X:
-    //  x11 x12 ... x1n
-    //  x21 x22 ... x2n
-    //  ...
-    //  xn1 xn2 ... xnn
-
-    // allocate temporary memory
-    T x[2*_XR*_XC];
-    unsigned int xr = _XR;
-    unsigned int xc = _XC*2;
-
-    // x:
-    //  x11 x12 ... x1n 1   0   ... 0
-    //  x21 x22 ... x2n 0   1   ... 0
-    //  ...
-    //  xn1 xn2 ... xnn 0   0   ... 1
-    unsigned int r,c;
-    for (r=0; r<_XR; r++) {
-        // copy matrix elements
-        for (c=0; c<_XC; c++)
-            matrix_access(x,xr,xc,r,c) = matrix_access(_X,_XR,_XC,r,c);
-
-        // append identity matrix
-        for (c=0; c<_XC; c++)
-            matrix_access(x,xr,xc,r,_XC+c) = (r==c) ? 1 : 0;
-    }
-
-    // perform Gauss-Jordan elimination on x
-    // x:
-    //  1   0   ... 0   y11 y12 ... y1n
-    //  0   1   ... 0   y21 y22 ... y2n
-    //  ...
-    //  0   0   ... 1   yn1 yn2 ... ynn
-    MATRIX(_gjelim)(x,xr,xc);
-
-    // copy result from right half of x
-    for (r=0; r<_XR; r++) {
-        for (c=0; c<_XC; c++)
-            matrix_access(_X,_XR,_XC,r,c) = matrix_access(x,xr,xc,r,_XC+c);
+#if defined(MATRIX_LAPACK) && HAVE_LAPACK
+    // row-major X is the transpose of the column-major view, and the
+    // inverse of the transpose is the transpose of the inverse
+    if (_XR >= MATRIX_BLAS_MIN) {
+        int n = (int)_XR;
+        int info = 0;
+        int ipiv[_XR];
+        T * LU = (T*) liquid_malloc(_XR*_XR*sizeof(T));
+        memmove(LU, _X, _XR*_XR*sizeof(T));
+        MATRIX_LAPACK(getrf)(&n, &n, LU, &n, ipiv, &info);
+        if (info == 0) {
+            int lwork = n*MATRIX_BLOCK_NB;
+            T * work = (T*) liquid_malloc(lwork*sizeof(T));
+            MATRIX_LAPACK(getri)(&n, LU, &n, ipiv, work, &lwork, &info);
+            memmove(_X, LU, _XR*_XR*sizeof(T));
+            liquid_free(work);
+            liquid_free(LU);
+            return;
+        }
+        // singular: fall back to the internal path (and its warning)
+        liquid_free(LU);
     }
+#endif
+
+    // factor X = P^T * L * U and solve against the identity
+    unsigned int n = _XR;
+    T * LU = (T*) liquid_malloc(n*n*sizeof(T));
+    unsigned int piv[n];
+    memmove(LU, _X, n*n*sizeof(T));
+    if (MATRIX(_lufactor)(LU, n, piv) > 0)
+        fprintf(stderr,"warning: matrix_inv(), matrix singular to machine precision\n");
+
+    unsigned int i;
+    for (i=0; i<n*n; i++)
+        _X[i] = (i % (n+1)) == 0 ? 1 : 0;
+    MATRIX(_lusolve)(LU, n, piv, _X, n);
+    liquid_free(LU);
 }
 
 // Gauss-Jordan elmination
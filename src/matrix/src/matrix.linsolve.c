@@ -24,6 +24,7 @@
 // Solve linear system of equations
 //
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "liquid.internal.h"
@@ -40,47 +41,37 @@ void MATRIX(_linsolve)(T *          _A,
                        T *          _x,
                        void *       _opts)
 {
-#if 0
-    T A_inv[_n*_n];
-    memmove(A_inv, _A, _n*_n*sizeof(T));
-    MATRIX(_inv)(A_inv,_n,_n);
-
-    MATRIX(_mul)(A_inv, _n, _n,
-                 _b,    _n,  1,
-                 _x,    _n,  1);
-#else
-    unsigned int r;
-    unsigned int c;
-
-    // compute augmented matrix M [size: _n x _n+1] as
-    // T:
-    //  A11 A12 A13 ... A1n b1
-    //  A21 A22 A23 ... A2n b2
-    //  A31 A32 A33 ... A3n b3
-    //  ...
-    //  An1 An2 An3 ... Ann bn
-    T M[_n*_n + _n];    // allocate array
-    unsigned int m=0;   // output matrix index counter
-    unsigned int a=0;   // input matrix index counter
-    for (r=0; r<_n; r++) {
-        for (c=0; c<_n; c++)
-            M[m++] = _A[a++];
-
-        M[m++] = _b[r];
+#if defined(MATRIX_LAPACK) && HAVE_LAPACK
+    // factor the column-major view (A^T) and solve its transpose
+    if (_n >= MATRIX_BLAS_MIN) {
+        int n = (int)_n;
+        int nrhs = 1;
+        int info = 0;
+        int ipiv[_n];
+        T * LU = (T*) liquid_malloc(_n*_n*sizeof(T));
+        memmove(LU, _A, _n*_n*sizeof(T));
+        MATRIX_LAPACK(getrf)(&n, &n, LU, &n, ipiv, &info);
+        if (info == 0) {
+            char trans = 'T';
+            memmove(_x, _b, _n*sizeof(T));
+            MATRIX_LAPACK(getrs)(&trans, &n, &nrhs, LU, &n, ipiv, _x, &n, &info, 1);
+            liquid_free(LU);
+            return;
+        }
+        // singular: fall back to the internal path (and its warning)
+        liquid_free(LU);
     }
+#endif
 
-    // run Gauss-Jordan elimination on M
-    // T:
-    //  1   0   0   ... 0   x1
-    //  0   1   0   ... 0   x2
-    //  0   0   1   ... 0   x3
-    //  ...
-    //  0   0   0   ... 1   xn
-    MATRIX(_gjelim)(M, _n, _n+1);
+    // factor A = P^T * L * U and substitute
+    T * LU = (T*) liquid_malloc(_n*_n*sizeof(T));
+    unsigned int piv[_n];
+    memmove(LU, _A, _n*_n*sizeof(T));
+    if (MATRIX(_lufactor)(LU, _n, piv) > 0)
+        fprintf(stderr,"warning: matrix_linsolve(), matrix singular to machine precision\n");
 
-    // copy result from right-most column of M
-    for (r=0; r<_n; r++)
-        _x[r] = M[(_n+1)*(r+1)-1];
-#endif
+    memmove(_x, _b, _n*sizeof(T));
+    MATRIX(_lusolve)(LU, _n, piv, _x, 1);
+    liquid_free(LU);
 }
 
@@ -108,6 +108,28 @@ void MATRIX(_mul)(T * _X, unsigned int _XR, unsigned int _XC,
         exit(1);
     }
 
+    // large products: cache-blocked kernels (see matrix.blocked.c)
+    if (_ZR*_ZC*_XC >= 4096) {
+#if defined(MATRIX_CBLAS_GEMM) && HAVE_CBLAS
+        if (_ZR >= MATRIX_BLAS_MIN && _ZC >= MATRIX_BLAS_MIN && _XC >= MATRIX_BLAS_MIN) {
+#  if T_COMPLEX
+            T alpha = 1;
+            T beta  = 0;
+            MATRIX_CBLAS_GEMM(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                              _ZR, _ZC, _XC, &alpha, _X, _XC, _Y, _YC,
+                              &beta, _Z, _ZC);
+#  else
+            MATRIX_CBLAS_GEMM(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                              _ZR, _ZC, _XC, 1, _X, _XC, _Y, _YC,
+                              0, _Z, _ZC);
+#  endif
+            return;
+        }
+#endif
+        MATRIX(_mul_blocked)(_X, _Y, _Z, _ZR, _ZC, _XC);
+        return;
+    }
+
     unsigned int r, c, i;
     for (r=0; r<_ZR; r++) {
         for (c=0; c<_ZC; c++) {
@@ -248,6 +270,21 @@ void MATRIX(_mul_transpose)(T * _x,
     unsigned int c;
     unsigned int i;
 
+    // large products: x is already in transposed form for the blocked
+    // kernels (conjugated copy for complex types)
+    if (_m*_m*_n >= 4096) {
+#if T_COMPLEX
+        T * xc = (T*) liquid_malloc(_m*_n*sizeof(T));
+        for (i=0; i<_m*_n; i++)
+            xc[i] = conj(_x[i]);
+        MATRIX(_gemm_nt)(_x, _n, xc, _n, _xxT, _m, _m, _m, _n, 0);
+        liquid_free(xc);
+#else
+        MATRIX(_gemm_nt)(_x, _n, _x, _n, _xxT, _m, _m, _m, _n, 0);
+#endif
+        return;
+    }
+
     // clear _xxT
     for (i=0; i<_m*_m; i++)
         _xxT[i] = 0.0f;
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// matrix_kernels.avx.c : matrix multiply tile kernels (x86 AVX2/FMA)
+//
+// These kernels are compiled with per-function target attributes and
+// are selected at run time by the dispatch in matrix_kernels.mmx.c.
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// horizontal sums of four vectors: [sum(a0) sum(a1) sum(a2) sum(a3)]
+__attribute__((target("avx2,fma")))
+static inline __m128 liquid_matrix_hsum4_avx2(__m256 _a0,
+                                              __m256 _a1,
+                                              __m256 _a2,
+                                              __m256 _a3)
+{
+    __m256 s = _mm256_hadd_ps(_mm256_hadd_ps(_a0, _a1),
+                              _mm256_hadd_ps(_a2, _a3));
+    return _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+}
+
+// real tile kernel (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_matrixf_dot2x4_avx2(float *      _x[2],
+                                float *      _y[4],
+                                unsigned int _n,
+                                float *      _z)
+{
+    __m256 s00 = _mm256_setzero_ps(), s01 = _mm256_setzero_ps();
+    __m256 s02 = _mm256_setzero_ps(), s03 = _mm256_setzero_ps();
+    __m256 s10 = _mm256_setzero_ps(), s11 = _mm256_setzero_ps();
+    __m256 s12 = _mm256_setzero_ps(), s13 = _mm256_setzero_ps();
+    unsigned int t = _n & ~7u;
+    unsigned int k;
+    for (k=0; k<t; k+=8) {
+        __m256 x0 = _mm256_loadu_ps(_x[0] + k);
+        __m256 x1 = _mm256_loadu_ps(_x[1] + k);
+        __m256 y;
+        y = _mm256_loadu_ps(_y[0] + k);
+        s00 = _mm256_fmadd_ps(x0, y, s00);
+        s10 = _mm256_fmadd_ps(x1, y, s10);
+        y = _mm256_loadu_ps(_y[1] + k);
+        s01 = _mm256_fmadd_ps(x0, y, s01);
+        s11 = _mm256_fmadd_ps(x1, y, s11);
+        y = _mm256_loadu_ps(_y[2] + k);
+        s02 = _mm256_fmadd_ps(x0, y, s02);
+        s12 = _mm256_fmadd_ps(x1, y, s12);
+        y = _mm256_loadu_ps(_y[3] + k);
+        s03 = _mm256_fmadd_ps(x0, y, s03);
+        s13 = _mm256_fmadd_ps(x1, y, s13);
+    }
+    _mm_storeu_ps(_z,     liquid_matrix_hsum4_avx2(s00, s01, s02, s03));
+    _mm_storeu_ps(_z + 4, liquid_matrix_hsum4_avx2(s10, s11, s12, s13));
+
+    // clean up remaining
+    unsigned int i, j;
+    for (i=0; i<2; i++) {
+        for (j=0; j<4; j++) {
+            for (k=t; k<_n; k++)
+                _z[4*i+j] += _x[i][k] * _y[j][k];
+        }
+    }
+}
+
+// one row of x at a time: four complex values per iteration, with
+// in-phase and swapped products accumulated separately
+__attribute__((target("avx2,fma")))
+static void liquid_matrixcf_dot1x4_avx2(float *                _x,
+                                        liquid_float_complex * _y[4],
+                                        unsigned int           _n,
+                                        liquid_float_complex * _z)
+{
+    __m256 r0 = _mm256_setzero_ps(), r1 = _mm256_setzero_ps();
+    __m256 r2 = _mm256_setzero_ps(), r3 = _mm256_setzero_ps();
+    __m256 q0 = _mm256_setzero_ps(), q1 = _mm256_setzero_ps();
+    __m256 q2 = _mm256_setzero_ps(), q3 = _mm256_setzero_ps();
+    unsigned int t = _n & ~3u;
+    unsigned int k;
+    for (k=0; k<t; k+=4) {
+        __m256 x  = _mm256_loadu_ps(_x + 2*k);
+        __m256 xs = _mm256_permute_ps(x, _MM_SHUFFLE(2,3,0,1));
+        __m256 y;
+        y = _mm256_loadu_ps((float*)(_y[0] + k));
+        r0 = _mm256_fmadd_ps(x,  y, r0);
+        q0 = _mm256_fmadd_ps(xs, y, q0);
+        y = _mm256_loadu_ps((float*)(_y[1] + k));
+        r1 = _mm256_fmadd_ps(x,  y, r1);
+        q1 = _mm256_fmadd_ps(xs, y, q1);
+        y = _mm256_loadu_ps((float*)(_y[2] + k));
+        r2 = _mm256_fmadd_ps(x,  y, r2);
+        q2 = _mm256_fmadd_ps(xs, y, q2);
+        y = _mm256_loadu_ps((float*)(_y[3] + k));
+        r3 = _mm256_fmadd_ps(x,  y, r3);
+        q3 = _mm256_fmadd_ps(xs, y, q3);
+    }
+
+    // real part: sum{xr*yr} - sum{xi*yi}; imaginary part: sum of all
+    // swapped products
+    __m256 sign = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f,
+                                 0.0f, -0.0f, 0.0f, -0.0f);
+    float re[4], im[4];
+    _mm_storeu_ps(re, liquid_matrix_hsum4_avx2(_mm256_xor_ps(r0, sign),
+                                               _mm256_xor_ps(r1, sign),
+                                               _mm256_xor_ps(r2, sign),
+                                               _mm256_xor_ps(r3, sign)));
+    _mm_storeu_ps(im, liquid_matrix_hsum4_avx2(q0, q1, q2, q3));
+
+    liquid_float_complex * x = (liquid_float_complex*) _x;
+    unsigned int j;
+    for (j=0; j<4; j++) {
+        _z[j] = re[j] + _Complex_I*im[j];
+        for (k=t; k<_n; k++)
+            _z[j] += x[k] * _y[j][k];
+    }
+}
+
+// complex tile kernel (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_matrixcf_dot2x4_avx2(liquid_float_complex * _x[2],
+                                 liquid_float_complex * _y[4],
+                                 unsigned int           _n,
+                                 liquid_float_complex * _z)
+{
+    liquid_matrixcf_dot1x4_avx2((float*)_x[0], _y, _n, _z);
+    liquid_matrixcf_dot1x4_avx2((float*)_x[1], _y, _n, _z + 4);
+}
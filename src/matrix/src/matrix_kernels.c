@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// matrix_kernels.c : matrix multiply tile kernels (portable C)
+//
+
+#include "liquid.internal.h"
+
+// real tile kernel (see liquid.internal.h)
+void liquid_matrixf_dot2x4(float *      _x[2],
+                           float *      _y[4],
+                           unsigned int _n,
+                           float *      _z)
+{
+    // independent accumulators for each output
+    float * x0 = _x[0], * x1 = _x[1];
+    float * y0 = _y[0], * y1 = _y[1], * y2 = _y[2], * y3 = _y[3];
+    float z00 = 0, z01 = 0, z02 = 0, z03 = 0;
+    float z10 = 0, z11 = 0, z12 = 0, z13 = 0;
+    unsigned int k;
+    for (k=0; k<_n; k++) {
+        z00 += x0[k] * y0[k];   z10 += x1[k] * y0[k];
+        z01 += x0[k] * y1[k];   z11 += x1[k] * y1[k];
+        z02 += x0[k] * y2[k];   z12 += x1[k] * y2[k];
+        z03 += x0[k] * y3[k];   z13 += x1[k] * y3[k];
+    }
+    _z[0] = z00; _z[1] = z01; _z[2] = z02; _z[3] = z03;
+    _z[4] = z10; _z[5] = z11; _z[6] = z12; _z[7] = z13;
+}
+
+// complex tile kernel (see liquid.internal.h)
+void liquid_matrixcf_dot2x4(liquid_float_complex * _x[2],
+                            liquid_float_complex * _y[4],
+                            unsigned int           _n,
+                            liquid_float_complex * _z)
+{
+    // independent accumulators for each output
+    liquid_float_complex * x0 = _x[0], * x1 = _x[1];
+    liquid_float_complex * y0 = _y[0], * y1 = _y[1], * y2 = _y[2], * y3 = _y[3];
+    liquid_float_complex z00 = 0, z01 = 0, z02 = 0, z03 = 0;
+    liquid_float_complex z10 = 0, z11 = 0, z12 = 0, z13 = 0;
+    unsigned int k;
+    for (k=0; k<_n; k++) {
+        z00 += x0[k] * y0[k];   z10 += x1[k] * y0[k];
+        z01 += x0[k] * y1[k];   z11 += x1[k] * y1[k];
+        z02 += x0[k] * y2[k];   z12 += x1[k] * y2[k];
+        z03 += x0[k] * y3[k];   z13 += x1[k] * y3[k];
+    }
+    _z[0] = z00; _z[1] = z01; _z[2] = z02; _z[3] = z03;
+    _z[4] = z10; _z[5] = z11; _z[6] = z12; _z[7] = z13;
+}
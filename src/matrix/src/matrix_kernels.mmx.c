@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// matrix_kernels.mmx.c : matrix multiply tile kernels (SSE3 with AVX2
+//                        dispatch)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
+//
+// portable kernels (dispatch fallback)
+//
+
+static void liquid_matrixf_dot2x4_portable(float *      _x[2],
+                                           float *      _y[4],
+                                           unsigned int _n,
+                                           float *      _z)
+{
+    // independent accumulators for each output
+    float * x0 = _x[0], * x1 = _x[1];
+    float * y0 = _y[0], * y1 = _y[1], * y2 = _y[2], * y3 = _y[3];
+    float z00 = 0, z01 = 0, z02 = 0, z03 = 0;
+    float z10 = 0, z11 = 0, z12 = 0, z13 = 0;
+    unsigned int k;
+    for (k=0; k<_n; k++) {
+        z00 += x0[k] * y0[k];   z10 += x1[k] * y0[k];
+        z01 += x0[k] * y1[k];   z11 += x1[k] * y1[k];
+        z02 += x0[k] * y2[k];   z12 += x1[k] * y2[k];
+        z03 += x0[k] * y3[k];   z13 += x1[k] * y3[k];
+    }
+    _z[0] = z00; _z[1] = z01; _z[2] = z02; _z[3] = z03;
+    _z[4] = z10; _z[5] = z11; _z[6] = z12; _z[7] = z13;
+}
+
+static void liquid_matrixcf_dot2x4_portable(float complex * _x[2],
+                                            float complex * _y[4],
+                                            unsigned int    _n,
+                                            float complex * _z)
+{
+    // independent accumulators for each output
+    float complex * x0 = _x[0], * x1 = _x[1];
+    float complex * y0 = _y[0], * y1 = _y[1], * y2 = _y[2], * y3 = _y[3];
+    float complex z00 = 0, z01 = 0, z02 = 0, z03 = 0;
+    float complex z10 = 0, z11 = 0, z12 = 0, z13 = 0;
+    unsigned int k;
+    for (k=0; k<_n; k++) {
+        z00 += x0[k] * y0[k];   z10 += x1[k] * y0[k];
+        z01 += x0[k] * y1[k];   z11 += x1[k] * y1[k];
+        z02 += x0[k] * y2[k];   z12 += x1[k] * y2[k];
+        z03 += x0[k] * y3[k];   z13 += x1[k] * y3[k];
+    }
+    _z[0] = z00; _z[1] = z01; _z[2] = z02; _z[3] = z03;
+    _z[4] = z10; _z[5] = z11; _z[6] = z12; _z[7] = z13;
+}
+
+#if HAVE_PMMINTRIN_H
+//
+// SSE3 kernels
+//
+
+// horizontal sums of four vectors: [sum(a0) sum(a1) sum(a2) sum(a3)]
+static inline __m128 liquid_matrix_hsum4(__m128 _a0,
+                                         __m128 _a1,
+                                         __m128 _a2,
+                                         __m128 _a3)
+{
+    return _mm_hadd_ps(_mm_hadd_ps(_a0, _a1), _mm_hadd_ps(_a2, _a3));
+}
+
+// eight accumulators, four values of each row per iteration
+static void liquid_matrixf_dot2x4_sse(float *      _x[2],
+                                      float *      _y[4],
+                                      unsigned int _n,
+                                      float *      _z)
+{
+    __m128 s00 = _mm_setzero_ps(), s01 = _mm_setzero_ps();
+    __m128 s02 = _mm_setzero_ps(), s03 = _mm_setzero_ps();
+    __m128 s10 = _mm_setzero_ps(), s11 = _mm_setzero_ps();
+    __m128 s12 = _mm_setzero_ps(), s13 = _mm_setzero_ps();
+    unsigned int t = _n & ~3u;
+    unsigned int k;
+    for (k=0; k<t; k+=4) {
+        __m128 x0 = _mm_loadu_ps(_x[0] + k);
+        __m128 x1 = _mm_loadu_ps(_x[1] + k);
+        __m128 y;
+        y = _mm_loadu_ps(_y[0] + k);
+        s00 = _mm_add_ps(s00, _mm_mul_ps(x0, y));
+        s10 = _mm_add_ps(s10, _mm_mul_ps(x1, y));
+        y = _mm_loadu_ps(_y[1] + k);
+        s01 = _mm_add_ps(s01, _mm_mul_ps(x0, y));
+        s11 = _mm_add_ps(s11, _mm_mul_ps(x1, y));
+        y = _mm_loadu_ps(_y[2] + k);
+        s02 = _mm_add_ps(s02, _mm_mul_ps(x0, y));
+        s12 = _mm_add_ps(s12, _mm_mul_ps(x1, y));
+        y = _mm_loadu_ps(_y[3] + k);
+        s03 = _mm_add_ps(s03, _mm_mul_ps(x0, y));
+        s13 = _mm_add_ps(s13, _mm_mul_ps(x1, y));
+    }
+    _mm_storeu_ps(_z,     liquid_matrix_hsum4(s00, s01, s02, s03));
+    _mm_storeu_ps(_z + 4, liquid_matrix_hsum4(s10, s11, s12, s13));
+
+    // clean up remaining
+    unsigned int i, j;
+    for (i=0; i<2; i++) {
+        for (j=0; j<4; j++) {
+            for (k=t; k<_n; k++)
+                _z[4*i+j] += _x[i][k] * _y[j][k];
+        }
+    }
+}
+
+// one row of x at a time: two complex values per iteration, with
+// in-phase and swapped products accumulated separately
+static void liquid_matrixcf_dot1x4_sse(float *         _x,
+                                       float complex * _y[4],
+                                       unsigned int    _n,
+                                       float complex * _z)
+{
+    __m128 r0 = _mm_setzero_ps(), r1 = _mm_setzero_ps();
+    __m128 r2 = _mm_setzero_ps(), r3 = _mm_setzero_ps();
+    __m128 q0 = _mm_setzero_ps(), q1 = _mm_setzero_ps();
+    __m128 q2 = _mm_setzero_ps(), q3 = _mm_setzero_ps();
+    unsigned int t = _n & ~1u;
+    unsigned int k;
+    for (k=0; k<t; k+=2) {
+        __m128 x  = _mm_loadu_ps(_x + 2*k);
+        __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2,3,0,1));
+        __m128 y;
+        y = _mm_loadu_ps((float*)(_y[0] + k));
+        r0 = _mm_add_ps(r0, _mm_mul_ps(x,  y));
+        q0 = _mm_add_ps(q0, _mm_mul_ps(xs, y));
+        y = _mm_loadu_ps((float*)(_y[1] + k));
+        r1 = _mm_add_ps(r1, _mm_mul_ps(x,  y));
+        q1 = _mm_add_ps(q1, _mm_mul_ps(xs, y));
+        y = _mm_loadu_ps((float*)(_y[2] + k));
+        r2 = _mm_add_ps(r2, _mm_mul_ps(x,  y));
+        q2 = _mm_add_ps(q2, _mm_mul_ps(xs, y));
+        y = _mm_loadu_ps((float*)(_y[3] + k));
+        r3 = _mm_add_ps(r3, _mm_mul_ps(x,  y));
+        q3 = _mm_add_ps(q3, _mm_mul_ps(xs, y));
+    }
+
+    // real part: sum{xr*yr} - sum{xi*yi}; imaginary part: sum of all
+    // swapped products
+    __m128 sign = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    float re[4], im[4];
+    _mm_storeu_ps(re, liquid_matrix_hsum4(_mm_xor_ps(r0, sign), _mm_xor_ps(r1, sign),
+                                          _mm_xor_ps(r2, sign), _mm_xor_ps(r3, sign)));
+    _mm_storeu_ps(im, liquid_matrix_hsum4(q0, q1, q2, q3));
+
+    float complex * x = (float complex*) _x;
+    unsigned int j;
+    for (j=0; j<4; j++) {
+        _z[j] = re[j] + _Complex_I*im[j];
+        for (k=t; k<_n; k++)
+            _z[j] += x[k] * _y[j][k];
+    }
+}
+
+static void liquid_matrixcf_dot2x4_sse(float complex * _x[2],
+                                       float complex * _y[4],
+                                       unsigned int    _n,
+                                       float complex * _z)
+{
+    liquid_matrixcf_dot1x4_sse((float*)_x[0], _y, _n, _z);
+    liquid_matrixcf_dot1x4_sse((float*)_x[1], _y, _n, _z + 4);
+}
+#endif
+
+//
+// run-time dispatch
+//
+
+// real tile kernel (see liquid.internal.h)
+void liquid_matrixf_dot2x4(float *      _x[2],
+                           float *      _y[4],
+                           unsigned int _n,
+                           float *      _z)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_matrixf_dot2x4_avx2(_x, _y, _n, _z);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_matrixf_dot2x4_sse(_x, _y, _n, _z);
+        return;
+    }
+#endif
+    liquid_matrixf_dot2x4_portable(_x, _y, _n, _z);
+}
+
+// complex tile kernel (see liquid.internal.h)
+void liquid_matrixcf_dot2x4(float complex * _x[2],
+                            float complex * _y[4],
+                            unsigned int    _n,
+                            float complex * _z)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_matrixcf_dot2x4_avx2(_x, _y, _n, _z);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_matrixcf_dot2x4_sse(_x, _y, _n, _z);
+        return;
+    }
+#endif
+    liquid_matrixcf_dot2x4_portable(_x, _y, _n, _z);
+}
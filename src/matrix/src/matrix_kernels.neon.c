@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// matrix_kernels.neon.c : matrix multiply tile kernels (ARM Neon)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+// horizontal sum of a vector (armv7 compatible)
+static inline float liquid_matrix_hsum_neon(float32x4_t _a)
+{
+    float32x2_t s = vadd_f32(vget_low_f32(_a), vget_high_f32(_a));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+}
+
+// real tile kernel (see liquid.internal.h)
+void liquid_matrixf_dot2x4(float *      _x[2],
+                           float *      _y[4],
+                           unsigned int _n,
+                           float *      _z)
+{
+    unsigned int i, j, k = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t s[2][4];
+        for (i=0; i<2; i++) {
+            for (j=0; j<4; j++)
+                s[i][j] = vdupq_n_f32(0.0f);
+        }
+        for (; k+4<=_n; k+=4) {
+            float32x4_t x0 = vld1q_f32(_x[0] + k);
+            float32x4_t x1 = vld1q_f32(_x[1] + k);
+            for (j=0; j<4; j++) {
+                float32x4_t y = vld1q_f32(_y[j] + k);
+                s[0][j] = vmlaq_f32(s[0][j], x0, y);
+                s[1][j] = vmlaq_f32(s[1][j], x1, y);
+            }
+        }
+        for (i=0; i<2; i++) {
+            for (j=0; j<4; j++)
+                _z[4*i+j] = liquid_matrix_hsum_neon(s[i][j]);
+        }
+    } else {
+        for (i=0; i<8; i++)
+            _z[i] = 0.0f;
+    }
+
+    // clean up remaining
+    unsigned int t = k;
+    for (i=0; i<2; i++) {
+        for (j=0; j<4; j++) {
+            for (k=t; k<_n; k++)
+                _z[4*i+j] += _x[i][k] * _y[j][k];
+        }
+    }
+}
+
+// complex tile kernel (see liquid.internal.h); de-interleaving loads
+// keep real and imaginary parts in separate lanes
+void liquid_matrixcf_dot2x4(float complex * _x[2],
+                            float complex * _y[4],
+                            unsigned int    _n,
+                            float complex * _z)
+{
+    unsigned int i, j, k = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t re[2][4], im[2][4];
+        for (i=0; i<2; i++) {
+            for (j=0; j<4; j++) {
+                re[i][j] = vdupq_n_f32(0.0f);
+                im[i][j] = vdupq_n_f32(0.0f);
+            }
+        }
+        for (; k+4<=_n; k+=4) {
+            float32x4x2_t x0 = vld2q_f32((float*)(_x[0] + k));
+            float32x4x2_t x1 = vld2q_f32((float*)(_x[1] + k));
+            for (j=0; j<4; j++) {
+                float32x4x2_t y = vld2q_f32((float*)(_y[j] + k));
+                re[0][j] = vmlaq_f32(re[0][j], x0.val[0], y.val[0]);
+                re[0][j] = vmlsq_f32(re[0][j], x0.val[1], y.val[1]);
+                im[0][j] = vmlaq_f32(im[0][j], x0.val[0], y.val[1]);
+                im[0][j] = vmlaq_f32(im[0][j], x0.val[1], y.val[0]);
+                re[1][j] = vmlaq_f32(re[1][j], x1.val[0], y.val[0]);
+                re[1][j] = vmlsq_f32(re[1][j], x1.val[1], y.val[1]);
+                im[1][j] = vmlaq_f32(im[1][j], x1.val[0], y.val[1]);
+                im[1][j] = vmlaq_f32(im[1][j], x1.val[1], y.val[0]);
+            }
+        }
+        for (i=0; i<2; i++) {
+            for (j=0; j<4; j++) {
+                _z[4*i+j] = liquid_matrix_hsum_neon(re[i][j]) +
+                            liquid_matrix_hsum_neon(im[i][j])*_Complex_I;
+            }
+        }
+    } else {
+        for (i=0; i<8; i++)
+            _z[i] = 0.0f;
+    }
+
+    // clean up remaining
+    unsigned int t = k;
+    for (i=0; i<2; i++) {
+        for (j=0; j<4; j++) {
+            for (k=t; k<_n; k++)
+                _z[4*i+j] += _x[i][k] * _y[j][k];
+        }
+    }
+}
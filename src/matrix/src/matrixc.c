@@ -42,6 +42,7 @@
         cimagf(matrix_access(X,R,C,r,c)));
 
 #include "matrix.base.c"
+#include "matrix.blocked.c"
 #include "matrix.cgsolve.c"
 #include "matrix.chol.c"
 #include "matrix.gramschmidt.c"
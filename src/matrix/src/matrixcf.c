@@ -36,12 +36,18 @@
 #define T_ABS(X)        cabsf(X)
 #define TP_ABS(X)       fabsf(X)
 
+// vectorized tile kernel and external library hooks (matrix.blocked.c)
+#define MATRIX_DOT2X4           liquid_matrixcf_dot2x4
+#define MATRIX_CBLAS_GEMM       cblas_cgemm
+#define MATRIX_LAPACK(name)     c ## name ## _
+
 #define MATRIX_PRINT_ELEMENT(X,R,C,r,c)     \
     printf("%7.2f+j%6.2f ",                 \
         crealf(matrix_access(X,R,C,r,c)),   \
         cimagf(matrix_access(X,R,C,r,c)));
 
 #include "matrix.base.c"
+#include "matrix.blocked.c"
 #include "matrix.cgsolve.c"
 #include "matrix.chol.c"
 #include "matrix.gramschmidt.c"
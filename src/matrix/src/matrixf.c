@@ -36,10 +36,16 @@
 #define T_ABS(X)        fabsf(X)
 #define TP_ABS(X)       fabsf(X)
 
+// vectorized tile kernel and external library hooks (matrix.blocked.c)
+#define MATRIX_DOT2X4           liquid_matrixf_dot2x4
+#define MATRIX_CBLAS_GEMM       cblas_sgemm
+#define MATRIX_LAPACK(name)     s ## name ## _
+
 #define MATRIX_PRINT_ELEMENT(X,R,C,r,c) \
     printf("%12.7f", matrix_access(X,R,C,r,c));
 
 #include "matrix.base.c"
+#include "matrix.blocked.c"
 #include "matrix.cgsolve.c"
 #include "matrix.chol.c"
 #include "matrix.gramschmidt.c"
@@ -68,7 +68,7 @@ SMATRIX() SMATRIX(_create)(unsigned int _M,
                            unsigned int _N)
 {
     // create object and allocate memory
-    SMATRIX() q = (SMATRIX()) malloc(sizeof(struct SMATRIX(_s)));
+    SMATRIX() q = (SMATRIX()) liquid_malloc(sizeof(struct SMATRIX(_s)));
     q->M = _M;
     q->N = _N;
 
@@ -76,26 +76,26 @@ SMATRIX() SMATRIX(_create)(unsigned int _M,
     unsigned int j;
 
     // initialize size of each pointer list
-    q->num_mlist = (unsigned int*)malloc( q->M*sizeof(unsigned int) );
-    q->num_nlist = (unsigned int*)malloc( q->N*sizeof(unsigned int) );
+    q->num_mlist = (unsigned int*)liquid_malloc( q->M*sizeof(unsigned int) );
+    q->num_nlist = (unsigned int*)liquid_malloc( q->N*sizeof(unsigned int) );
     for (i=0; i<q->M; i++) q->num_mlist[i] = 0;
     for (j=0; j<q->N; j++) q->num_nlist[j] = 0;
 
     // initialize lists
-    q->mlist = (unsigned short int **) malloc( q->M*sizeof(unsigned short int *) );
-    q->nlist = (unsigned short int **) malloc( q->N*sizeof(unsigned short int *) );
+    q->mlist = (unsigned short int **) liquid_malloc( q->M*sizeof(unsigned short int *) );
+    q->nlist = (unsigned short int **) liquid_malloc( q->N*sizeof(unsigned short int *) );
     for (i=0; i<q->M; i++)
-        q->mlist[i] = (unsigned short int *) malloc( q->num_mlist[i]*sizeof(unsigned short int) );
+        q->mlist[i] = (unsigned short int *) liquid_malloc( q->num_mlist[i]*sizeof(unsigned short int) );
     for (j=0; j<q->N; j++)
-        q->nlist[j] = (unsigned short int *) malloc( q->num_nlist[j]*sizeof(unsigned short int) );
+        q->nlist[j] = (unsigned short int *) liquid_malloc( q->num_nlist[j]*sizeof(unsigned short int) );
 
     // initialize values
-    q->mvals = (T **) malloc( q->M*sizeof(T*) );
-    q->nvals = (T **) malloc( q->N*sizeof(T*) );
+    q->mvals = (T **) liquid_malloc( q->M*sizeof(T*) );
+    q->nvals = (T **) liquid_malloc( q->N*sizeof(T*) );
     for (i=0; i<q->M; i++)
-        q->mvals[i] = (T *) malloc( q->num_mlist[i]*sizeof(T) );
+        q->mvals[i] = (T *) liquid_malloc( q->num_mlist[i]*sizeof(T) );
     for (j=0; j<q->N; j++)
-        q->nvals[j] = (T *) malloc( q->num_nlist[j]*sizeof(T) );
+        q->nvals[j] = (T *) liquid_malloc( q->num_nlist[j]*sizeof(T) );
 
     // set maximum list size
     q->max_num_mlist = 0;
@@ -134,23 +134,23 @@ void SMATRIX(_destroy)(SMATRIX() _q)
     unsigned int j;
 
     // free internal memory
-    free(_q->num_mlist);
-    free(_q->num_nlist);
+    liquid_free(_q->num_mlist);
+    liquid_free(_q->num_nlist);
 
     // free lists
-    for (i=0; i<_q->M; i++) free(_q->mlist[i]);
-    for (j=0; j<_q->N; j++) free(_q->nlist[j]);
-    free(_q->mlist);
-    free(_q->nlist);
+    for (i=0; i<_q->M; i++) liquid_free(_q->mlist[i]);
+    for (j=0; j<_q->N; j++) liquid_free(_q->nlist[j]);
+    liquid_free(_q->mlist);
+    liquid_free(_q->nlist);
 
     // free values
-    for (i=0; i<_q->M; i++) free(_q->mvals[i]);
-    for (j=0; j<_q->N; j++) free(_q->nvals[j]);
-    free(_q->mvals);
-    free(_q->nvals);
+    for (i=0; i<_q->M; i++) liquid_free(_q->mvals[i]);
+    for (j=0; j<_q->N; j++) liquid_free(_q->nvals[j]);
+    liquid_free(_q->mvals);
+    liquid_free(_q->nvals);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print compact form
@@ -322,12 +322,12 @@ void SMATRIX(_insert)(SMATRIX()    _q,
     _q->num_nlist[_n]++;
 
     // reallocate indices lists at this index
-    _q->mlist[_m] = (unsigned short int*) realloc(_q->mlist[_m], _q->num_mlist[_m]*sizeof(unsigned short int));
-    _q->nlist[_n] = (unsigned short int*) realloc(_q->nlist[_n], _q->num_nlist[_n]*sizeof(unsigned short int));
+    _q->mlist[_m] = (unsigned short int*) liquid_realloc(_q->mlist[_m], _q->num_mlist[_m]*sizeof(unsigned short int));
+    _q->nlist[_n] = (unsigned short int*) liquid_realloc(_q->nlist[_n], _q->num_nlist[_n]*sizeof(unsigned short int));
     
     // reallocate values lists at this index
-    _q->mvals[_m] = (T*) realloc(_q->mvals[_m], _q->num_mlist[_m]*sizeof(T));
-    _q->nvals[_n] = (T*) realloc(_q->nvals[_n], _q->num_nlist[_n]*sizeof(T));
+    _q->mvals[_m] = (T*) liquid_realloc(_q->mvals[_m], _q->num_mlist[_m]*sizeof(T));
+    _q->nvals[_n] = (T*) liquid_realloc(_q->nvals[_n], _q->num_nlist[_n]*sizeof(T));
 
     // find index within list to insert new value
     unsigned int mindex = smatrix_indexsearch(_q->mlist[_m], _q->num_mlist[_m]-1, _n);
@@ -376,8 +376,10 @@ void SMATRIX(_delete)(SMATRIX()    _q,
         if (_q->mlist[_m][j] == _n)
             t = j;
     }
-    for (j=t; j<_q->num_mlist[_m]-1; j++)
+    for (j=t; j<_q->num_mlist[_m]-1; j++) {
         _q->mlist[_m][j] = _q->mlist[_m][j+1];
+        _q->mvals[_m][j] = _q->mvals[_m][j+1];
+    }
 
     // remove value from nlist (shift left)
     t = 0;
@@ -385,16 +387,20 @@ void SMATRIX(_delete)(SMATRIX()    _q,
         if (_q->nlist[_n][i] == _m)
             t = i;
     }
-    for (i=t; i<_q->num_nlist[_n]-1; i++)
+    for (i=t; i<_q->num_nlist[_n]-1; i++) {
         _q->nlist[_n][i] = _q->nlist[_n][i+1];
+        _q->nvals[_n][i] = _q->nvals[_n][i+1];
+    }
 
     // reduce sizes
     _q->num_mlist[_m]--;
     _q->num_nlist[_n]--;
 
     // reallocate
-    _q->mlist[_m] = (unsigned short int*) realloc(_q->mlist[_m], _q->num_mlist[_m]*sizeof(unsigned short int));
-    _q->nlist[_n] = (unsigned short int*) realloc(_q->nlist[_n], _q->num_nlist[_n]*sizeof(unsigned short int));
+    _q->mlist[_m] = (unsigned short int*) liquid_realloc(_q->mlist[_m], _q->num_mlist[_m]*sizeof(unsigned short int));
+    _q->nlist[_n] = (unsigned short int*) liquid_realloc(_q->nlist[_n], _q->num_nlist[_n]*sizeof(unsigned short int));
+    _q->mvals[_m] = (T*) liquid_realloc(_q->mvals[_m], _q->num_mlist[_m]*sizeof(T));
+    _q->nvals[_n] = (T*) liquid_realloc(_q->nvals[_n], _q->num_nlist[_n]*sizeof(T));
 
     // reset maxima
     if (_q->max_num_mlist == _q->num_mlist[_m]+1)
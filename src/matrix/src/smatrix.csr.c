@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// compressed sparse matrices
+//
+// Immutable copy of an smatrix object with the row (CSR) and column
+// (CSC) lists each held in one contiguous array. Binary matrices also
+// keep every row as a packed bit vector so that GF(2) products reduce
+// to word-wide AND/XOR and a parity count.
+//
+
+// bits per packed word
+#define SMATRIX_CSR_WORD_BITS   (8*sizeof(unsigned int))
+
+// compressed sparse matrix structure
+//
+// for the example in smatrix.c:
+//  row_ptr         :   { 0, 0, 1, 2, 2, 4, 4 }
+//  col_idx         :   { 1, 4, 1, 3 }
+//  row_vals        :   { 2.3, 1.2, 3.4, 4.4 }
+//  col_ptr         :   { 0, 0, 2, 2, 3, 4 }
+//  row_idx         :   { 1, 4, 4, 2 }
+//  col_vals        :   { 2.3, 3.4, 4.4, 1.2 }
+struct SMATRIX(_csr_s) {
+    unsigned int M;                 // number of rows
+    unsigned int N;                 // number of columns
+    unsigned int nnz;               // number of non-zero entries
+    unsigned int * row_ptr;         // start of each row in col_idx [size: M+1]
+    unsigned short int * col_idx;   // column index of each entry, by row
+    T * row_vals;                   // value of each entry, by row
+    unsigned int * col_ptr;         // start of each column in row_idx [size: N+1]
+    unsigned short int * row_idx;   // row index of each entry, by column
+    T * col_vals;                   // value of each entry, by column
+#if SMATRIX_BOOL
+    unsigned int num_words;         // packed words per row
+    unsigned int * bits;            // packed rows [size: M x num_words]
+    int use_bits;                   // use packed rows for vector products
+#endif
+};
+
+// create compressed copy of sparse matrix
+SMATRIX(_csr) SMATRIX(_csr_create)(SMATRIX() _q)
+{
+    SMATRIX(_csr) q = (SMATRIX(_csr)) liquid_malloc(sizeof(struct SMATRIX(_csr_s)));
+    q->M = _q->M;
+    q->N = _q->N;
+
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+
+    // count entries and build offsets; allocated entries holding a
+    // zero value (e.g. after _clear() or _mul()) are dropped
+    q->row_ptr = (unsigned int*) liquid_malloc((q->M+1)*sizeof(unsigned int));
+    q->col_ptr = (unsigned int*) liquid_malloc((q->N+1)*sizeof(unsigned int));
+    q->row_ptr[0] = 0;
+    for (i=0; i<q->M; i++) {
+        q->row_ptr[i+1] = q->row_ptr[i];
+        for (k=0; k<_q->num_mlist[i]; k++)
+            q->row_ptr[i+1] += _q->mvals[i][k] != 0;
+    }
+    q->col_ptr[0] = 0;
+    for (j=0; j<q->N; j++) {
+        q->col_ptr[j+1] = q->col_ptr[j];
+        for (k=0; k<_q->num_nlist[j]; k++)
+            q->col_ptr[j+1] += _q->nvals[j][k] != 0;
+    }
+    q->nnz = q->row_ptr[q->M];
+
+    // copy lists (already sorted by index)
+    q->col_idx  = (unsigned short int*) liquid_malloc(q->nnz*sizeof(unsigned short int));
+    q->row_idx  = (unsigned short int*) liquid_malloc(q->nnz*sizeof(unsigned short int));
+    q->row_vals = (T*) liquid_malloc(q->nnz*sizeof(T));
+    q->col_vals = (T*) liquid_malloc(q->nnz*sizeof(T));
+    unsigned int n = 0;
+    for (i=0; i<q->M; i++) {
+        for (k=0; k<_q->num_mlist[i]; k++) {
+            if (_q->mvals[i][k] == 0)
+                continue;
+            q->col_idx[n]  = _q->mlist[i][k];
+            q->row_vals[n] = _q->mvals[i][k];
+            n++;
+        }
+    }
+    n = 0;
+    for (j=0; j<q->N; j++) {
+        for (k=0; k<_q->num_nlist[j]; k++) {
+            if (_q->nvals[j][k] == 0)
+                continue;
+            q->row_idx[n]  = _q->nlist[j][k];
+            q->col_vals[n] = _q->nvals[j][k];
+            n++;
+        }
+    }
+
+#if SMATRIX_BOOL
+    // pack rows (modulo 2, as in vmul)
+    q->num_words = (q->N + SMATRIX_CSR_WORD_BITS - 1) / SMATRIX_CSR_WORD_BITS;
+    q->bits = (unsigned int*) liquid_calloc(q->M*q->num_words, sizeof(unsigned int));
+    for (i=0; i<q->M; i++) {
+        for (k=q->row_ptr[i]; k<q->row_ptr[i+1]; k++) {
+            if (q->row_vals[k] & 1) {
+                j = q->col_idx[k];
+                q->bits[i*q->num_words + j/SMATRIX_CSR_WORD_BITS] |= 1u << (j % SMATRIX_CSR_WORD_BITS);
+            }
+        }
+    }
+
+    // packed products cost one pass over the input plus one word per
+    // row segment; index lists cost one lookup per entry
+    q->use_bits = q->N + q->M*q->num_words < q->nnz;
+#endif
+
+    return q;
+}
+
+// destroy compressed sparse matrix
+void SMATRIX(_csr_destroy)(SMATRIX(_csr) _q)
+{
+    liquid_free(_q->row_ptr);
+    liquid_free(_q->col_ptr);
+    liquid_free(_q->col_idx);
+    liquid_free(_q->row_idx);
+    liquid_free(_q->row_vals);
+    liquid_free(_q->col_vals);
+#if SMATRIX_BOOL
+    liquid_free(_q->bits);
+#endif
+    liquid_free(_q);
+}
+
+// get compressed matrix dimensions
+void SMATRIX(_csr_size)(SMATRIX(_csr)  _q,
+                        unsigned int * _m,
+                        unsigned int * _n)
+{
+    *_m = _q->M;
+    *_n = _q->N;
+}
+
+// get element value at index (return zero if not set)
+T SMATRIX(_csr_get)(SMATRIX(_csr) _q,
+                    unsigned int  _m,
+                    unsigned int  _n)
+{
+    // validate input
+    if (_m >= _q->M || _n >= _q->N) {
+        fprintf(stderr,"error: SMATRIX(_csr_get)(%u,%u), index exceeds matrix dimension (%u,%u)\n",
+                _m, _n, _q->M, _q->N);
+        exit(1);
+    }
+
+    // bisection over sorted column indices of row
+    unsigned int lo = _q->row_ptr[_m];
+    unsigned int hi = _q->row_ptr[_m+1];
+    while (lo < hi) {
+        unsigned int mid = (lo + hi) / 2;
+        if (_q->col_idx[mid] < _n)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < _q->row_ptr[_m+1] && _q->col_idx[lo] == _n)
+        return _q->row_vals[lo];
+    return 0;
+}
+
+// get non-zero column indices of row
+unsigned int SMATRIX(_csr_row)(SMATRIX(_csr)         _q,
+                               unsigned int          _m,
+                               unsigned short int ** _idx)
+{
+    if (_m >= _q->M) {
+        fprintf(stderr,"error: SMATRIX(_csr_row)(%u), index exceeds matrix dimension (%u)\n",
+                _m, _q->M);
+        exit(1);
+    }
+    *_idx = &_q->col_idx[_q->row_ptr[_m]];
+    return _q->row_ptr[_m+1] - _q->row_ptr[_m];
+}
+
+// get non-zero row indices of column
+unsigned int SMATRIX(_csr_col)(SMATRIX(_csr)         _q,
+                               unsigned int          _n,
+                               unsigned short int ** _idx)
+{
+    if (_n >= _q->N) {
+        fprintf(stderr,"error: SMATRIX(_csr_col)(%u), index exceeds matrix dimension (%u)\n",
+                _n, _q->N);
+        exit(1);
+    }
+    *_idx = &_q->row_idx[_q->col_ptr[_n]];
+    return _q->col_ptr[_n+1] - _q->col_ptr[_n];
+}
+
+// multiply two compressed sparse matrices, _c = _a * _b (output is
+// reset and only non-zero entries are inserted)
+void SMATRIX(_csr_mul)(SMATRIX(_csr) _a,
+                       SMATRIX(_csr) _b,
+                       SMATRIX()     _c)
+{
+    // validate input
+    if (_c->M != _a->M || _c->N != _b->N || _a->N != _b->M) {
+        fprintf(stderr,"error: SMATRIX(_csr_mul)(), invalid dimensions\n");
+        exit(1);
+    }
+
+    SMATRIX(_reset)(_c);
+
+    unsigned int r;
+    unsigned int c;
+    unsigned int k;
+#if SMATRIX_BOOL
+    // XOR packed rows of _b selected by each row of _a
+    unsigned int w;
+    unsigned int acc[_b->num_words > 0 ? _b->num_words : 1];
+    for (r=0; r<_a->M; r++) {
+        for (w=0; w<_b->num_words; w++)
+            acc[w] = 0;
+        for (k=_a->row_ptr[r]; k<_a->row_ptr[r+1]; k++) {
+            if ((_a->row_vals[k] & 1) == 0)
+                continue;
+            unsigned int * row = &_b->bits[_a->col_idx[k]*_b->num_words];
+            for (w=0; w<_b->num_words; w++)
+                acc[w] ^= row[w];
+        }
+        for (w=0; w<_b->num_words; w++) {
+            while (acc[w]) {
+                unsigned int bit = acc[w] & (~acc[w] + 1);
+                c = w*SMATRIX_CSR_WORD_BITS + liquid_count_ones(bit - 1);
+                SMATRIX(_insert)(_c, r, c, 1);
+                acc[w] ^= bit;
+            }
+        }
+    }
+#else
+    // accumulate scaled rows of _b selected by each row of _a
+    T   acc[_b->N > 0 ? _b->N : 1];
+    unsigned char set[_b->N > 0 ? _b->N : 1];
+    unsigned int j;
+    for (r=0; r<_a->M; r++) {
+        memset(set, 0, _b->N);
+        for (k=_a->row_ptr[r]; k<_a->row_ptr[r+1]; k++) {
+            unsigned int m = _a->col_idx[k];
+            T v = _a->row_vals[k];
+            for (j=_b->row_ptr[m]; j<_b->row_ptr[m+1]; j++) {
+                c = _b->col_idx[j];
+                acc[c] = set[c] ? acc[c] + v*_b->row_vals[j] : v*_b->row_vals[j];
+                set[c] = 1;
+            }
+        }
+        for (c=0; c<_b->N; c++) {
+            if (set[c] && acc[c] != 0)
+                SMATRIX(_insert)(_c, r, c, acc[c]);
+        }
+    }
+#endif
+}
+
+// multiply compressed sparse matrix by vector
+//  _q  :   compressed sparse matrix
+//  _x  :   input vector [size: _N x 1]
+//  _y  :   output vector [size: _M x 1]
+void SMATRIX(_csr_vmul)(SMATRIX(_csr) _q,
+                        T *           _x,
+                        T *           _y)
+{
+    unsigned int i;
+    unsigned int k;
+#if SMATRIX_BOOL
+    if (_q->use_bits) {
+        // pack input (modulo 2) and take parity of each masked row
+        unsigned int w;
+        unsigned int xb[_q->num_words > 0 ? _q->num_words : 1];
+        for (w=0; w<_q->num_words; w++)
+            xb[w] = 0;
+        for (k=0; k<_q->N; k++)
+            xb[k/SMATRIX_CSR_WORD_BITS] |= (unsigned int)(_x[k] & 1) << (k % SMATRIX_CSR_WORD_BITS);
+
+        for (i=0; i<_q->M; i++) {
+            unsigned int * row = &_q->bits[i*_q->num_words];
+            unsigned int acc = 0;
+            for (w=0; w<_q->num_words; w++)
+                acc ^= row[w] & xb[w];
+            _y[i] = liquid_count_ones_mod2(acc);
+        }
+        return;
+    }
+#endif
+
+    for (i=0; i<_q->M; i++) {
+        // running total over contiguous entries of row
+        T p = 0;
+        for (k=_q->row_ptr[i]; k<_q->row_ptr[i+1]; k++)
+            p += _q->row_vals[k] * _x[ _q->col_idx[k] ];
+
+        // set output value appropriately
+#if SMATRIX_BOOL
+        _y[i] = p % 2;
+#else
+        _y[i] = p;
+#endif
+    }
+}
@@ -46,6 +46,7 @@
 
 // source files
 #include "smatrix.c"
+#include "smatrix.csr.c"
 
 // 
 // smatrix cross methods
@@ -110,3 +111,56 @@ void smatrixb_vmulf(smatrixb _q,
     }
 }
 
+
+// multiply compressed sparse binary matrix by floating-point matrix
+//  _q  :   compressed sparse matrix [size: A->M x A->N]
+//  _x  :   input vector  [size:  mx  x  nx ]
+//  _y  :   output vector [size:  my  x  ny ]
+void smatrixb_csr_mulf(smatrixb_csr _A,
+                       float *      _x,
+                       unsigned int _mx,
+                       unsigned int _nx,
+                       float *      _y,
+                       unsigned int _my,
+                       unsigned int _ny)
+{
+    // ensure lengths are valid
+    if (_my != _A->M || _ny != _nx || _A->N != _mx ) {
+        fprintf(stderr,"error: matrix_mul(), invalid dimensions\n");
+        exit(1);
+    }
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+
+    for (i=0; i<_A->M; i++) {
+        float * y = &_y[i*_ny];
+        for (j=0; j<_ny; j++)
+            y[j] = 0.0f;
+
+        // sum rows of _x selected by non-zero entries in this row
+        for (k=_A->row_ptr[i]; k<_A->row_ptr[i+1]; k++) {
+            float * x = &_x[_A->col_idx[k]*_nx];
+            for (j=0; j<_ny; j++)
+                y[j] += x[j];
+        }
+    }
+}
+
+// multiply compressed sparse binary matrix by floating-point vector
+//  _q  :   compressed sparse matrix
+//  _x  :   input vector [size: _N x 1]
+//  _y  :   output vector [size: _M x 1]
+void smatrixb_csr_vmulf(smatrixb_csr _q,
+                        float *      _x,
+                        float *      _y)
+{
+    unsigned int i;
+    unsigned int k;
+    for (i=0; i<_q->M; i++) {
+        float sum = 0.0f;
+        for (k=_q->row_ptr[i]; k<_q->row_ptr[i+1]; k++)
+            sum += _x[ _q->col_idx[k] ];
+        _y[i] = sum;
+    }
+}
@@ -46,3 +46,4 @@
 
 // source files
 #include "smatrix.c"
+#include "smatrix.csr.c"
@@ -46,4 +46,5 @@
 
 // source files
 #include "smatrix.c"
+#include "smatrix.csr.c"
 
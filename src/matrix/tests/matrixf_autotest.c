@@ -420,3 +420,92 @@ void autotest_matrixf_transmul()
 
 
 
+
+// check whether SIMD level can be selected on this host/build
+static int matrixf_autotest_supported(liquid_simd_level _level)
+{
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    return _level == LIQUID_SIMD_PORTABLE || _level == host || (x86 && _level < host);
+}
+
+// large multiply crossing all block boundaries, against direct sum
+static void matrixf_autotest_mul_blocked(unsigned int _m,
+                                         unsigned int _k,
+                                         unsigned int _n)
+{
+    float x[_m*_k], y[_k*_n], z[_m*_n];
+    unsigned int i, j, k;
+    for (i=0; i<_m*_k; i++) x[i] = randnf();
+    for (i=0; i<_k*_n; i++) y[i] = randnf();
+
+    matrixf_mul(x, _m, _k, y, _k, _n, z, _m, _n);
+    for (i=0; i<_m; i++) {
+        for (j=0; j<_n; j++) {
+            double sum = 0.0;
+            for (k=0; k<_k; k++)
+                sum += (double)x[i*_k+k] * (double)y[k*_n+j];
+            CONTEND_DELTA( z[i*_n+j], sum, 1e-5f*_k );
+        }
+    }
+}
+
+// large inverse, linear solve and Cholesky decomposition
+static void matrixf_autotest_factor_blocked(unsigned int _n)
+{
+    float tol = 1e-4f;
+    float A[_n*_n], B[_n*_n], C[_n*_n], b[_n], x[_n];
+    unsigned int i, j;
+
+    // diagonally-weighted random system
+    for (i=0; i<_n*_n; i++) A[i] = randnf();
+    for (i=0; i<_n; i++) A[i*_n+i] += 2.0f*sqrtf(_n);
+
+    // A * inv(A) = I
+    memmove(B, A, sizeof(A));
+    matrixf_inv(B, _n, _n);
+    matrixf_mul(A, _n, _n, B, _n, _n, C, _n, _n);
+    for (i=0; i<_n; i++) {
+        for (j=0; j<_n; j++)
+            CONTEND_DELTA( C[i*_n+j], i==j ? 1.0f : 0.0f, tol );
+    }
+
+    // A * x = b
+    for (i=0; i<_n; i++) b[i] = randnf();
+    matrixf_linsolve(A, _n, b, x, NULL);
+    matrixf_mul(A, _n, _n, x, _n, 1, C, _n, 1);
+    for (i=0; i<_n; i++)
+        CONTEND_DELTA( C[i], b[i], tol );
+
+    // L * L^T = A for symmetric positive-definite A = B * B^T + n*I
+    matrixf_mul_transpose(A, _n, _n, B);
+    for (i=0; i<_n; i++) B[i*_n+i] += _n;
+    matrixf_chol(B, _n, A);
+    for (i=0; i<_n; i++) {
+        for (j=i+1; j<_n; j++)
+            CONTEND_EQUALITY( A[i*_n+j], 0.0f );
+    }
+    matrixf_mul_transpose(A, _n, _n, C);
+    for (i=0; i<_n*_n; i++)
+        CONTEND_DELTA( C[i], B[i], tol*_n );
+}
+
+// blocked kernels at every SIMD level available on this host
+void autotest_matrixf_blocked()
+{
+    liquid_simd_level level = liquid_simd_get_level();
+    unsigned int i;
+    for (i=0; i<LIQUID_SIMD_NUM_LEVELS; i++) {
+        if (!matrixf_autotest_supported((liquid_simd_level)i))
+            continue;
+        if (liquid_autotest_verbose)
+            printf("  level: %s\n", liquid_simd_level_str((liquid_simd_level)i));
+        CONTEND_EQUALITY(liquid_simd_set_level((liquid_simd_level)i), (liquid_simd_level)i);
+        matrixf_autotest_mul_blocked(  1, 300,  17);
+        matrixf_autotest_mul_blocked( 67, 300,  45);
+        matrixf_autotest_mul_blocked(130,  33,  70);
+        matrixf_autotest_factor_blocked(37);
+        matrixf_autotest_factor_blocked(101);
+    }
+    liquid_simd_set_level(level);
+}
@@ -365,3 +365,120 @@ void autotest_smatrixb_vmulf()
     smatrixb_destroy(A);
 }
 
+
+// compressed form against list form on a random matrix
+//  _m, _n  :   dimensions
+//  _p      :   probability of a non-zero entry (sets packed/list path)
+static void smatrixb_csr_autotest_run(unsigned int _m,
+                                      unsigned int _n,
+                                      float        _p)
+{
+    unsigned int i;
+    unsigned int j;
+
+    // random matrix with one deleted entry and one explicit zero
+    smatrixb A = smatrixb_create(_m, _n);
+    for (i=0; i<_m; i++) {
+        for (j=0; j<_n; j++) {
+            if (randf() < _p)
+                smatrixb_set(A, i, j, 1);
+        }
+    }
+    smatrixb_set(A, 0, 1, 1);
+    smatrixb_delete(A, 0, 1);
+    smatrixb_set(A, _m-1, _n-1, 1);
+    smatrixb_set(A, _m-1, _n-1, 0);
+
+    smatrixb_csr Ac = smatrixb_csr_create(A);
+    unsigned int m, n;
+    smatrixb_csr_size(Ac, &m, &n);
+    CONTEND_EQUALITY( m, _m );
+    CONTEND_EQUALITY( n, _n );
+
+    // element access, row and column lists
+    unsigned short int * idx;
+    unsigned int k;
+    for (i=0; i<_m; i++) {
+        unsigned int num_idx = smatrixb_csr_row(Ac, i, &idx);
+        k = 0;
+        for (j=0; j<_n; j++) {
+            unsigned char v = smatrixb_get(A, i, j);
+            CONTEND_EQUALITY( smatrixb_csr_get(Ac, i, j), v );
+            if (v) {
+                CONTEND_EQUALITY( k < num_idx, 1 );
+                if (k < num_idx) CONTEND_EQUALITY( idx[k], j );
+                k++;
+            }
+        }
+        CONTEND_EQUALITY( k, num_idx );
+    }
+    for (j=0; j<_n; j++) {
+        unsigned int num_idx = smatrixb_csr_col(Ac, j, &idx);
+        for (k=0; k<num_idx; k++)
+            CONTEND_EQUALITY( smatrixb_get(A, idx[k], j), 1 );
+    }
+
+    // vector products
+    unsigned char x[_n], y[_m], y_test[_m];
+    float xf[_n], yf[_m], yf_test[_m];
+    for (j=0; j<_n; j++) {
+        x[j]  = rand() & 1;
+        xf[j] = randnf();
+    }
+    smatrixb_vmul(A, x, y_test);
+    smatrixb_csr_vmul(Ac, x, y);
+    for (i=0; i<_m; i++)
+        CONTEND_EQUALITY( y[i], y_test[i] );
+
+    // float products against element values (the list-form float
+    // products count allocated zero entries)
+    for (i=0; i<_m; i++) {
+        yf_test[i] = 0.0f;
+        for (j=0; j<_n; j++)
+            yf_test[i] += smatrixb_get(A, i, j) ? xf[j] : 0.0f;
+    }
+    smatrixb_csr_vmulf(Ac, xf, yf);
+    for (i=0; i<_m; i++)
+        CONTEND_DELTA( yf[i], yf_test[i], 1e-5f );
+
+    // matrix products
+    float X[_n*3], Y[_m*3], Y_test[_m*3];
+    for (j=0; j<_n*3; j++)
+        X[j] = randnf();
+    for (i=0; i<_m*3; i++) {
+        Y_test[i] = 0.0f;
+        for (j=0; j<_n; j++)
+            Y_test[i] += smatrixb_get(A, i/3, j) ? X[j*3 + i%3] : 0.0f;
+    }
+    smatrixb_csr_mulf(Ac, X, _n, 3, Y, _m, 3);
+    for (i=0; i<_m*3; i++)
+        CONTEND_DELTA( Y[i], Y_test[i], 1e-5f );
+
+    // A * A^T over GF(2)
+    smatrixb At = smatrixb_create(_n, _m);
+    for (i=0; i<_m; i++) {
+        for (j=0; j<_n; j++) {
+            if (smatrixb_get(A, i, j))
+                smatrixb_set(At, j, i, 1);
+        }
+    }
+    smatrixb_csr Atc = smatrixb_csr_create(At);
+    smatrixb C      = smatrixb_create(_m, _m);
+    smatrixb C_test = smatrixb_create(_m, _m);
+    smatrixb_mul(A, At, C_test);
+    smatrixb_csr_mul(Ac, Atc, C);
+    for (i=0; i<_m; i++) {
+        for (j=0; j<_m; j++)
+            CONTEND_EQUALITY( smatrixb_get(C, i, j), smatrixb_get(C_test, i, j) );
+    }
+
+    smatrixb_csr_destroy(Ac);
+    smatrixb_csr_destroy(Atc);
+    smatrixb_destroy(A);
+    smatrixb_destroy(At);
+    smatrixb_destroy(C);
+    smatrixb_destroy(C_test);
+}
+
+void autotest_smatrixb_csr_sparse() { smatrixb_csr_autotest_run( 24,  48, 0.05f); }
+void autotest_smatrixb_csr_dense()  { smatrixb_csr_autotest_run( 40, 100, 0.50f); }
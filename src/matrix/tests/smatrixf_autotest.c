@@ -125,3 +125,56 @@ void autotest_smatrixf_mul()
     smatrixf_destroy(b);
     smatrixf_destroy(c);
 }
+
+// compressed form against list form on a random matrix
+void autotest_smatrixf_csr()
+{
+    float tol = 1e-5f;
+    unsigned int m = 20;
+    unsigned int n = 30;
+    unsigned int i;
+    unsigned int j;
+
+    smatrixf A = smatrixf_create(m, n);
+    smatrixf B = smatrixf_create(n, m);
+    for (i=0; i<m; i++) {
+        for (j=0; j<n; j++) {
+            if (randf() < 0.2f) smatrixf_set(A, i, j, randnf());
+            if (randf() < 0.2f) smatrixf_set(B, j, i, randnf());
+        }
+    }
+    smatrixf_csr Ac = smatrixf_csr_create(A);
+    smatrixf_csr Bc = smatrixf_csr_create(B);
+
+    // element access
+    for (i=0; i<m; i++) {
+        for (j=0; j<n; j++)
+            CONTEND_EQUALITY( smatrixf_csr_get(Ac, i, j), smatrixf_get(A, i, j) );
+    }
+
+    // vector product
+    float x[n], y[m], y_test[m];
+    for (j=0; j<n; j++)
+        x[j] = randnf();
+    smatrixf_vmul(A, x, y_test);
+    smatrixf_csr_vmul(Ac, x, y);
+    for (i=0; i<m; i++)
+        CONTEND_DELTA( y[i], y_test[i], tol );
+
+    // matrix product
+    smatrixf C      = smatrixf_create(m, m);
+    smatrixf C_test = smatrixf_create(m, m);
+    smatrixf_mul(A, B, C_test);
+    smatrixf_csr_mul(Ac, Bc, C);
+    for (i=0; i<m; i++) {
+        for (j=0; j<m; j++)
+            CONTEND_DELTA( smatrixf_get(C, i, j), smatrixf_get(C_test, i, j), tol );
+    }
+
+    smatrixf_csr_destroy(Ac);
+    smatrixf_csr_destroy(Bc);
+    smatrixf_destroy(A);
+    smatrixf_destroy(B);
+    smatrixf_destroy(C);
+    smatrixf_destroy(C_test);
+}
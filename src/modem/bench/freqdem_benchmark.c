@@ -76,3 +76,35 @@ void benchmark_freqdem(struct rusage *     _start,
 }
 
 
+// multi-channel block demodulator benchmark
+void benchmark_freqdem_block_c24_poly7(struct rusage *     _start,
+                                       struct rusage *     _finish,
+                                       unsigned long int * _num_iterations)
+{
+    // create demodulator: 24 channels, polynomial arctangent
+    unsigned int C = 24;
+    unsigned int n = 64;
+    freqdem dem = freqdem_create_multi(0.05f, C);
+    freqdem_set_accuracy(dem, 7);
+
+    float complex r[n*C];   // modulated signal, interleaved
+    float         m[n*C];   // message signal, interleaved
+
+    unsigned long int i;
+
+    // generate modulated signal
+    for (i=0; i<n*C; i++)
+        r[i] = 0.3f*cexpf(_Complex_I*2*M_PI*i/20.0f);
+
+    // start trials
+    *_num_iterations /= n*C/4;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        freqdem_demodulate_block(dem, r, n, m);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n*C;
+
+    // destroy demodulator
+    freqdem_destroy(dem);
+}
+
@@ -34,6 +34,10 @@
 #define DEBUG_AMPMODEM_FILENAME    "ampmodem_internal_debug.m"
 #define DEBUG_AMPMODEM_BUFFER_LEN  (400)
 
+// sub-block length for block coherent demodulation: the carrier
+// loop is updated once per sub-block
+#define AMPMODEM_BLOCK_LEN         (32)
+
 #if DEBUG_AMPMODEM
 void ampmodem_debug_print(ampmodem _q, const char * _filename);
 #endif
@@ -75,7 +79,7 @@ ampmodem ampmodem_create(float _m,
                          liquid_ampmodem_type _type,
                          int _suppressed_carrier)
 {
-    ampmodem q = (ampmodem) malloc(sizeof(struct ampmodem_s));
+    ampmodem q = (ampmodem) liquid_malloc(sizeof(struct ampmodem_s));
     q->type = _type;
     q->m    = _m;
     q->fc   = _fc;
@@ -127,7 +131,7 @@ void ampmodem_destroy(ampmodem _q)
     firhilbf_destroy(_q->hilbert);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void ampmodem_print(ampmodem _q)
@@ -189,10 +193,29 @@ void ampmodem_modulate_block(ampmodem        _q,
                              unsigned int    _n,
                              float complex * _s)
 {
-    // TODO: implement more efficient method
     unsigned int i;
-    for (i=0; i<_n; i++)
-        ampmodem_modulate(_q, _m[i], &_s[i]);
+
+    // baseband message: real (DSB) or analytic (SSB) signal
+    if (_q->type == LIQUID_AMPMODEM_DSB) {
+        for (i=0; i<_n; i++)
+            _s[i] = _m[i];
+    } else {
+        firhilbf_r2c_execute_block(_q->hilbert, _m, _n, _s);
+
+        if (_q->type == LIQUID_AMPMODEM_LSB) {
+            for (i=0; i<_n; i++)
+                _s[i] = conjf(_s[i]);
+        }
+    }
+
+    // add carrier
+    if (!_q->suppressed_carrier) {
+        for (i=0; i<_n; i++)
+            _s[i] = 0.5f*(_s[i] + 1.0f);
+    }
+
+    // mix up in place with block mixer
+    nco_crcf_mix_block_up(_q->oscillator, _s, _s, _n);
 }
 
 
@@ -258,10 +281,37 @@ void ampmodem_demodulate_block(ampmodem        _q,
                                unsigned int    _n,
                                float *         _m)
 {
-    // TODO: implement more efficient method
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        ampmodem_demodulate(_q, _r[i], &_m[i]);
+    unsigned int i, j;
+
+    if (_q->suppressed_carrier && _q->type != LIQUID_AMPMODEM_DSB) {
+        // single side-band suppressed carrier
+        for (i=0; i<_n; i++)
+            _m[i] = crealf(_r[i]);
+    } else if (_q->suppressed_carrier) {
+        // coherent demodulation: mix each sub-block down with the
+        // block mixer and update the carrier loop with its mean
+        // phase error
+        float complex y[AMPMODEM_BLOCK_LEN];
+        for (i=0; i<_n; i+=AMPMODEM_BLOCK_LEN) {
+            unsigned int n = _n - i < AMPMODEM_BLOCK_LEN ? _n - i : AMPMODEM_BLOCK_LEN;
+            nco_crcf_mix_block_down(_q->oscillator, &_r[i], y, n);
+
+            float phase_error = 0.0f;
+            for (j=0; j<n; j++) {
+                phase_error += tanhf( crealf(y[j]) * cimagf(y[j]) );
+                _m[i+j] = crealf(y[j]);
+            }
+            nco_crcf_pll_step_block(_q->oscillator, phase_error / (float)n, n);
+        }
+    } else {
+        // non-coherent demodulation (peak detector), removing DC bias
+        liquid_vectorcf_abs(_r, _n, _m);
+        for (i=0; i<_n; i++) {
+            _q->ssb_q_hat = (    _q->ssb_alpha)*_m[i] +
+                            (1 - _q->ssb_alpha)*_q->ssb_q_hat;
+            _m[i] = 2.0f*(_m[i] - _q->ssb_q_hat);
+        }
+    }
 }
 
 // export debugging file
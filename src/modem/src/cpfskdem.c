@@ -26,6 +26,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -36,6 +37,15 @@
 // internal methods
 //
 
+// create demodulator of given type (0: coherent, 1: non-coherent)
+cpfskdem cpfskdem_create_type(unsigned int _bps,
+                              float        _h,
+                              unsigned int _k,
+                              unsigned int _m,
+                              float        _beta,
+                              int          _type,
+                              int          _noncoherent);
+
 // initialize coherent demodulator
 void cpfskdem_init_coherent(cpfskdem _q);
 
@@ -107,11 +117,16 @@ struct cpfskdem_s {
             firfilt_crcf mf;    // matched filter
         } coherent;
 
-        // non-coherent demodulator
+        // non-coherent demodulator: bank of correlators over one
+        // symbol, or a zero-padded FFT for square pulses when the
+        // tones fall on its bins and it is cheaper
         struct {
-            firpfb_rrrf mf;     // matched filter
-            firpfb_rrrf dmf;    // matched filter (derivative)
-            eqlms_rrrf equalizer;
+            unsigned int    K;          // FFT size (0: correlator bank)
+            dotprod_cccf *  dp;         // tone correlators [size: M x 1]
+            float complex * buf_time;   // FFT input buffer [size: K x 1]
+            float complex * buf_freq;   // FFT output buffer [size: K x 1]
+            FFT_PLAN        fft;        // FFT object
+            unsigned int *  bin;        // FFT bin of each tone [size: M x 1]
         } noncoherent;
     } data;
 
@@ -119,6 +134,7 @@ struct cpfskdem_s {
     unsigned int  index;    // debug
     unsigned int  counter;  // sample counter
     float complex z_prime;  // (coherent only)
+    unsigned int  s_prime;  // previous decision (non-coherent only)
 };
 
 // create cpfskdem object (frequency demodulator)
@@ -134,6 +150,30 @@ cpfskdem cpfskdem_create(unsigned int _bps,
                          unsigned int _m,
                          float        _beta,
                          int          _type)
+{
+    // coherent or non-coherent?
+    return cpfskdem_create_type(_bps, _h, _k, _m, _beta, _type, _h > 0.66667f);
+}
+
+// create non-coherent cpfskdem object (see cpfskdem_create())
+cpfskdem cpfskdem_create_noncoherent(unsigned int _bps,
+                                     float        _h,
+                                     unsigned int _k,
+                                     unsigned int _m,
+                                     float        _beta,
+                                     int          _type)
+{
+    return cpfskdem_create_type(_bps, _h, _k, _m, _beta, _type, 1);
+}
+
+// create demodulator of given type (0: coherent, 1: non-coherent)
+cpfskdem cpfskdem_create_type(unsigned int _bps,
+                              float        _h,
+                              unsigned int _k,
+                              unsigned int _m,
+                              float        _beta,
+                              int          _type,
+                              int          _noncoherent)
 {
     // validate input
     if (_bps == 0) {
@@ -153,7 +193,7 @@ cpfskdem cpfskdem_create(unsigned int _bps,
     }
 
     // create main object memory
-    cpfskdem q = (cpfskdem) malloc(sizeof(struct cpfskdem_s));
+    cpfskdem q = (cpfskdem) liquid_malloc(sizeof(struct cpfskdem_s));
 
     // set basic internal properties
     q->bps  = _bps;     // bits per symbol
@@ -167,8 +207,7 @@ cpfskdem cpfskdem_create(unsigned int _bps,
     q->M = 1 << q->bps; // constellation size
 
     // coherent or non-coherent?
-    // TODO: allow user to specify
-    if (q->h > 0.66667f) {
+    if (_noncoherent) {
         cpfskdem_init_noncoherent(q);
     } else {
         cpfskdem_init_coherent(q);
@@ -246,15 +285,100 @@ void cpfskdem_init_noncoherent(cpfskdem _q)
     // set demodulate function pointer
     _q->demodulate = cpfskdem_demodulate_noncoherent;
 
-    // create object depending upon input type
+    // Each symbol is correlated over the k-sample block in which the
+    // centre of its frequency pulse falls: the block of the symbol
+    // itself for full-response pulses, one block later for the partial
+    // raised-cosine pulse and m blocks later for GMSK. With the decision
+    // released one block later again, the end-to-end delay equals the
+    // modulator delay and the receive delay is zero.
+    unsigned int ht_len = 0;
+    unsigned int offset = 0;
     switch(_q->type) {
-    case LIQUID_CPFSK_SQUARE:
-    case LIQUID_CPFSK_RCOS_FULL:
-    case LIQUID_CPFSK_RCOS_PARTIAL:
-    case LIQUID_CPFSK_GMSK:
-        break;
+    case LIQUID_CPFSK_SQUARE:       ht_len = _q->k;                     offset = 0;     break;
+    case LIQUID_CPFSK_RCOS_FULL:    ht_len = _q->k;                     offset = 0;     break;
+    case LIQUID_CPFSK_RCOS_PARTIAL: ht_len = 3*_q->k;                   offset = 1;     break;
+    case LIQUID_CPFSK_GMSK:         ht_len = 2*_q->k*_q->m + _q->k + 1; offset = _q->m; break;
+    default:
+        fprintf(stderr,"error: cpfskdem_init_noncoherent(), invalid tx filter type\n");
+        exit(1);
+    }
+    _q->symbol_delay = 0;
+
+    // Correlator templates follow the phase trajectory of the symbol's
+    // own pulse within the window; neighbouring symbols are unknown and
+    // their contributions average out. For square pulses these are tones
+    // with spacing h/k cycles/sample.
+    float ht[ht_len];
+    cpfskmod_firdes(_q->k, _q->m, _q->beta, _q->type, ht, ht_len);
+    unsigned int i;
+    float phi[_q->k];
+    float area = 0.0f;
+    for (i=0; i<_q->k; i++) {
+        unsigned int j = offset*_q->k + i;
+        area += j < ht_len ? ht[j] : 0.0f;
+        phi[i] = M_PI * _q->h * area;
+    }
+
+    // find smallest FFT size (up to 4k) with every tone on a distinct bin
+    unsigned int M = _q->M;
+    unsigned int K = 0;
+    unsigned int K_hat;
+    float df = _q->h / (float)_q->k;
+    for (K_hat=_q->k; K_hat<=4*_q->k && K==0 && _q->type==LIQUID_CPFSK_SQUARE; K_hat++) {
+        float v = 0.5f*df*(float)K_hat; // half tone spacing in bins
+        if (fabsf(roundf(v) - v) < 1e-4f && roundf(v) >= 1.0f && M*2*(unsigned int)roundf(v) <= K_hat)
+            K = K_hat;
     }
 
+    // select FFT only when cheaper than M correlators over k samples,
+    // estimating the transform cost as in fskdem
+    if (K > 0) {
+        float cost_fft = (float)K * log2f((float)K);
+        liquid_fft_method method = liquid_fft_estimate_method(K);
+        if (method == LIQUID_FFT_METHOD_STOCKHAM) {
+            unsigned int radix[LIQUID_FFT_STOCKHAM_MAX_STAGES];
+            unsigned int num_stages = fft_stockham_factor(K, radix);
+            cost_fft = 0.0f;
+            for (i=0; i<num_stages; i++)
+                cost_fft += 0.5f * (float)(K * radix[i]);
+        } else if (method != LIQUID_FFT_METHOD_RADIX2) {
+            cost_fft *= 4.0f;
+        }
+        if ((float)(M * _q->k) <= 1.5f*cost_fft)
+            K = 0;
+    }
+    _q->data.noncoherent.K = K;
+
+    _q->data.noncoherent.dp       = NULL;
+    _q->data.noncoherent.buf_time = NULL;
+    _q->data.noncoherent.buf_freq = NULL;
+    _q->data.noncoherent.bin      = NULL;
+    if (K == 0) {
+        // correlator bank: conjugate phase trajectory templates
+        _q->data.noncoherent.dp = (dotprod_cccf*) liquid_malloc(M*sizeof(dotprod_cccf));
+        float complex h[_q->k];
+        unsigned int s;
+        for (s=0; s<M; s++) {
+            float a = 2.0f*(float)s - (float)M + 1.0f;
+            for (i=0; i<_q->k; i++)
+                h[i] = cexpf(-_Complex_I*a*phi[i]);
+            _q->data.noncoherent.dp[s] = dotprod_cccf_create(h, _q->k);
+        }
+    } else {
+        // zero-padded transform and tone-to-bin map
+        _q->data.noncoherent.buf_time = (float complex*) liquid_malloc(K*sizeof(float complex));
+        _q->data.noncoherent.buf_freq = (float complex*) liquid_malloc(K*sizeof(float complex));
+        _q->data.noncoherent.fft = FFT_CREATE_PLAN(K, _q->data.noncoherent.buf_time,
+                                                   _q->data.noncoherent.buf_freq, FFT_DIR_FORWARD, 0);
+        memset(_q->data.noncoherent.buf_time, 0x00, K*sizeof(float complex));
+        _q->data.noncoherent.bin = (unsigned int*) liquid_malloc(M*sizeof(unsigned int));
+        int v = (int)roundf(0.5f*df*(float)K);
+        unsigned int s;
+        for (s=0; s<M; s++) {
+            int idx = v * (2*(int)s - (int)M + 1);
+            _q->data.noncoherent.bin[s] = (unsigned int)(idx < 0 ? idx + (int)K : idx);
+        }
+    }
 }
 
 // destroy modem object
@@ -265,11 +389,22 @@ void cpfskdem_destroy(cpfskdem _q)
         firfilt_crcf_destroy(_q->data.coherent.mf);
         break;
     case CPFSKDEM_NONCOHERENT:
+        if (_q->data.noncoherent.K == 0) {
+            unsigned int s;
+            for (s=0; s<_q->M; s++)
+                dotprod_cccf_destroy(_q->data.noncoherent.dp[s]);
+            liquid_free(_q->data.noncoherent.dp);
+        } else {
+            FFT_DESTROY_PLAN(_q->data.noncoherent.fft);
+            liquid_free(_q->data.noncoherent.buf_time);
+            liquid_free(_q->data.noncoherent.buf_freq);
+            liquid_free(_q->data.noncoherent.bin);
+        }
         break;
     }
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print modulation internals
@@ -277,6 +412,12 @@ void cpfskdem_print(cpfskdem _q)
 {
     printf("cpfskdem:\n");
     printf("    k   :   %u\n", _q->k);
+    if (_q->demod_type == CPFSKDEM_COHERENT)
+        printf("    demodulation    :   coherent\n");
+    else if (_q->data.noncoherent.K == 0)
+        printf("    demodulation    :   non-coherent (%u correlators)\n", _q->M);
+    else
+        printf("    demodulation    :   non-coherent (%u-point fft)\n", _q->data.noncoherent.K);
 }
 
 // reset modem object
@@ -295,6 +436,7 @@ void cpfskdem_reset(cpfskdem _q)
     _q->index   = 0;
     _q->counter = _q->k-1;
     _q->z_prime = 0;
+    _q->s_prime = 0;
 }
 
 // get transmit delay [symbols]
@@ -454,7 +596,37 @@ unsigned int cpfskdem_demodulate_coherent(cpfskdem        _q,
 unsigned int cpfskdem_demodulate_noncoherent(cpfskdem        _q,
                                              float complex * _y)
 {
-    return 0;
+    // tone energies; no carrier phase is needed
+    unsigned int s;
+    unsigned int s_hat = 0;
+    float        v_max = -1.0f;
+    if (_q->data.noncoherent.K == 0) {
+        for (s=0; s<_q->M; s++) {
+            float complex z;
+            dotprod_cccf_execute(_q->data.noncoherent.dp[s], _y, &z);
+            float v = crealf(z)*crealf(z) + cimagf(z)*cimagf(z);
+            if (v > v_max) {
+                v_max = v;
+                s_hat = s;
+            }
+        }
+    } else {
+        memmove(_q->data.noncoherent.buf_time, _y, _q->k*sizeof(float complex));
+        FFT_EXECUTE(_q->data.noncoherent.fft);
+        for (s=0; s<_q->M; s++) {
+            float complex z = _q->data.noncoherent.buf_freq[_q->data.noncoherent.bin[s]];
+            float v = crealf(z)*crealf(z) + cimagf(z)*cimagf(z);
+            if (v > v_max) {
+                v_max = v;
+                s_hat = s;
+            }
+        }
+    }
+
+    // release previous decision (see cpfskdem_init_noncoherent())
+    unsigned int sym_out = _q->s_prime;
+    _q->s_prime = s_hat;
+    return sym_out;
 }
 #endif
 
@@ -34,13 +34,8 @@
 // internal methods
 //
 
-// design transmit filter
-void cpfskmod_firdes(unsigned int _k,
-                     unsigned int _m,
-                     float        _beta,
-                     int          _type,
-                     float *      _h,
-                     unsigned int _h_len);
+// build phase trajectory table
+void cpfskmod_init_table(cpfskmod _q);
 
 // cpfskmod
 struct cpfskmod_s {
@@ -62,6 +57,19 @@ struct cpfskmod_s {
     // phase integrator
     float * phase_interp;       // phase interpolation buffer
     iirfilt_rrrf integrator;    // integrator
+    float b0;                   // integrator coefficient on current input
+    float b1;                   // integrator coefficient on previous input
+
+    // phase trajectory table, indexed by the last L symbols (newest in
+    // the least-significant bits); NULL if too large
+    unsigned int    L;          // pulse span [symbols]
+    unsigned int    state;      // symbol history
+    unsigned int    num_syms;   // symbols since reset, saturating at L
+    float           theta;      // integrator output at last sample
+    float           u_prev;     // interpolator output at last sample
+    float complex * traj;       // rotation at each sample [M^L x k]
+    float *         dtheta;     // phase change over symbol [M^L x 1]
+    float *         u_last;     // interpolator output at last sample [M^L x 1]
 };
 
 // create cpfskmod object (frequency modulator)
@@ -97,7 +105,7 @@ cpfskmod cpfskmod_create(unsigned int _bps,
     }
 
     // create main object memory
-    cpfskmod q = (cpfskmod) malloc(sizeof(struct cpfskmod_s));
+    cpfskmod q = (cpfskmod) liquid_malloc(sizeof(struct cpfskmod_s));
 
     // set basic internal properties
     q->bps  = _bps;     // bits per symbol
@@ -143,15 +151,25 @@ cpfskmod cpfskmod_create(unsigned int _bps,
     }
 
     // create pulse-shaping filter and scale by modulation index
-    q->ht = (float*) malloc(q->ht_len *sizeof(float));
+    q->ht = (float*) liquid_malloc(q->ht_len *sizeof(float));
     cpfskmod_firdes(q->k, q->m, q->beta, q->type, q->ht, q->ht_len);
     for (i=0; i<q->ht_len; i++)
         q->ht[i] *= M_PI * q->h;
     q->interp = firinterp_rrrf_create(q->k, q->ht, q->ht_len);
 
     // create phase integrator
-    q->phase_interp = (float*) malloc(q->k*sizeof(float));
+    q->phase_interp = (float*) liquid_malloc(q->k*sizeof(float));
     q->integrator = iirfilt_rrrf_create(b,2,a,2);
+    q->b0 = b[0];
+    q->b1 = b[1];
+
+    // build phase trajectory table
+    q->L      = (q->ht_len + q->k - 1) / q->k;
+    q->traj   = NULL;
+    q->dtheta = NULL;
+    q->u_last = NULL;
+    if (q->bps * q->L <= LIQUID_CPM_TABLE_MAX_BITS)
+        cpfskmod_init_table(q);
 
     // reset modem object
     cpfskmod_reset(q);
@@ -163,15 +181,20 @@ cpfskmod cpfskmod_create(unsigned int _bps,
 void cpfskmod_destroy(cpfskmod _q)
 {
     // destroy pulse-shaping filter/interpolator
-    free(_q->ht);
-    free(_q->phase_interp);
+    liquid_free(_q->ht);
+    liquid_free(_q->phase_interp);
     firinterp_rrrf_destroy(_q->interp);
 
     // destroy phase integrator
     iirfilt_rrrf_destroy(_q->integrator);
 
+    // free phase trajectory table
+    liquid_free(_q->traj);
+    liquid_free(_q->dtheta);
+    liquid_free(_q->u_last);
+
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print cpfskmod object internals
@@ -206,6 +229,12 @@ void cpfskmod_reset(cpfskmod _q)
 
     // reset phase integrator
     iirfilt_rrrf_reset(_q->integrator);
+
+    // clear symbol history
+    _q->state    = 0;
+    _q->num_syms = 0;
+    _q->theta    = 0.0f;
+    _q->u_prev   = 0.0f;
 }
 
 // get transmit delay [symbols]
@@ -222,20 +251,50 @@ void cpfskmod_modulate(cpfskmod        _q,
                        unsigned int    _s,
                        float complex * _y)
 {
+    if (_s >= _q->M) {
+        fprintf(stderr,"error: cpfskmod_modulate(), input symbol exceeds constellation size\n");
+        exit(1);
+    }
+
+    // update symbol history
+    _q->state = ((_q->state << _q->bps) | _s) & ((1 << (_q->bps*_q->L)) - 1);
+    if (_q->num_syms < _q->L) _q->num_syms++;
+
+    unsigned int i;
+    if (_q->traj != NULL && _q->num_syms == _q->L) {
+        // pulse spans transmitted symbols only: the first sample also
+        // integrates the last interpolator output of the previous symbol
+        _q->theta += _q->b1 * _q->u_prev;
+        float complex r = liquid_cexpjf(_q->theta);
+        const float complex * t = &_q->traj[_q->state * _q->k];
+        for (i=0; i<_q->k; i++)
+            _y[i] = r * t[i];
+
+        // advance phase state, keeping it in [-pi, pi)
+        _q->theta += _q->dtheta[_q->state];
+        _q->theta -= 2*M_PI*floorf((_q->theta + M_PI) / (2*M_PI));
+        _q->u_prev = _q->u_last[_q->state];
+        return;
+    }
+
     // run interpolator
     float v = 2.0f*_s - (float)(_q->M) + 1.0f;
     firinterp_rrrf_execute(_q->interp, v, _q->phase_interp);
 
     // integrate phase state
-    unsigned int i;
-    float theta;
-    for (i=0; i<_q->k; i++) {
-        // push phase through integrator
-        iirfilt_rrrf_execute(_q->integrator, _q->phase_interp[i], &theta);
+    float theta[_q->k];
+    for (i=0; i<_q->k; i++)
+        iirfilt_rrrf_execute(_q->integrator, _q->phase_interp[i], &theta[i]);
 
-        // compute output
-        _y[i] = liquid_cexpjf(theta);
-    }
+    // compute output
+    float s[_q->k], c[_q->k];
+    liquid_sincosf_block(theta, _q->k, s, c, LIQUID_TRIG_FAST);
+    for (i=0; i<_q->k; i++)
+        _y[i] = c[i] + _Complex_I*s[i];
+
+    // retain integrator state for table
+    _q->theta  = theta[_q->k-1];
+    _q->u_prev = _q->phase_interp[_q->k-1];
 }
 
 // 
@@ -309,3 +368,36 @@ void cpfskmod_firdes(unsigned int _k,
         _ht[i] *= 1.0f / ht_sum;
 }
 
+// build phase trajectory table: for every history of L symbols, the
+// interpolator output is integrated from zero phase over one symbol,
+// omitting the contribution of the previous symbol's last sample
+void cpfskmod_init_table(cpfskmod _q)
+{
+    unsigned int n = 1 << (_q->bps * _q->L);
+    _q->traj   = (float complex*) liquid_malloc(n*_q->k*sizeof(float complex));
+    _q->dtheta = (float*)         liquid_malloc(n*sizeof(float));
+    _q->u_last = (float*)         liquid_malloc(n*sizeof(float));
+
+    unsigned int s, i;
+    for (s=0; s<n; s++) {
+        // push older symbols (most-significant first), then run newest
+        firinterp_rrrf_reset(_q->interp);
+        for (i=_q->L-1; i>0; i--) {
+            unsigned int sym = (s >> (i*_q->bps)) & (_q->M - 1);
+            firinterp_rrrf_push(_q->interp, 2.0f*sym - (float)(_q->M) + 1.0f);
+        }
+        float v = 2.0f*(s & (_q->M - 1)) - (float)(_q->M) + 1.0f;
+        firinterp_rrrf_execute(_q->interp, v, _q->phase_interp);
+
+        float theta = 0.0f;
+        for (i=0; i<_q->k; i++) {
+            theta += _q->b0 * _q->phase_interp[i];
+            if (i > 0)
+                theta += _q->b1 * _q->phase_interp[i-1];
+            _q->traj[s*_q->k + i] = liquid_cexpjf(theta);
+        }
+        _q->dtheta[s] = theta;
+        _q->u_last[s] = _q->phase_interp[_q->k-1];
+    }
+    firinterp_rrrf_reset(_q->interp);
+}
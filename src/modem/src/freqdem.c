@@ -26,6 +26,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -36,21 +37,46 @@ struct FREQDEM(_s) {
     float kf;   // modulation index
     T     ref;  // 1/(2*pi*kf)
 
-    TC r_prime; // previous received sample
+    unsigned int num_channels;  // number of interleaved channels
+    TC * r_prime;               // previous received sample, per channel
+
+    // arctangent approximation
+    unsigned int  order;    // polynomial order (0: exact)
+    const float * c;        // polynomial coefficients
+    unsigned int  num_c;    // number of coefficients
 };
 
+// compute scaled phase differences for a block of samples
+void FREQDEM(_phase_block)(FREQDEM()    _q,
+                           TC *         _x,
+                           TC *         _x_prev,
+                           unsigned int _n,
+                           T *          _m);
+
 // create freqdem object
 //  _kf     :   modulation factor
 FREQDEM() FREQDEM(_create)(float _kf)
+{
+    return FREQDEM(_create_multi)(_kf, 1);
+}
+
+// create multi-channel freqdem object
+//  _kf             :   modulation factor
+//  _num_channels   :   number of interleaved channels
+FREQDEM() FREQDEM(_create_multi)(float        _kf,
+                                 unsigned int _num_channels)
 {
     // validate input
     if (_kf <= 0.0f || _kf > 1.0) {
         fprintf(stderr,"error: freqdem_create(), modulation factor %12.4e out of range [0,1]\n", _kf);
         exit(1);
+    } else if (_num_channels == 0) {
+        fprintf(stderr,"error: freqdem_create_multi(), number of channels must be greater than zero\n");
+        exit(1);
     }
 
     // create main object memory
-    FREQDEM() q = (freqdem) malloc(sizeof(struct FREQDEM(_s)));
+    FREQDEM() q = (freqdem) liquid_malloc(sizeof(struct FREQDEM(_s)));
 
     // set internal modulation factor
     q->kf = _kf;
@@ -58,6 +84,13 @@ FREQDEM() FREQDEM(_create)(float _kf)
     // compute derived values
     q->ref = 1.0f / (2*M_PI*q->kf);
 
+    // allocate per-channel state
+    q->num_channels = _num_channels;
+    q->r_prime = (TC*) liquid_malloc(q->num_channels*sizeof(TC));
+
+    // exact phase computation by default
+    FREQDEM(_set_accuracy)(q, 0);
+
     // reset modem object
     FREQDEM(_reset)(q);
 
@@ -68,8 +101,11 @@ FREQDEM() FREQDEM(_create)(float _kf)
 // destroy modem object
 void FREQDEM(_destroy)(FREQDEM() _q)
 {
+    // free per-channel state
+    liquid_free(_q->r_prime);
+
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print modulation internals
@@ -77,13 +113,38 @@ void FREQDEM(_print)(FREQDEM() _q)
 {
     printf("freqdem:\n");
     printf("    mod. factor :   %8.4f\n", _q->kf);
+    printf("    channels    :   %u\n", _q->num_channels);
+    if (_q->order == 0)
+        printf("    arctangent  :   exact\n");
+    else
+        printf("    arctangent  :   polynomial, order %u\n", _q->order);
 }
 
 // reset modem object
 void FREQDEM(_reset)(FREQDEM() _q)
 {
-    // clear complex phase term
-    _q->r_prime = 0;
+    // clear complex phase terms
+    memset(_q->r_prime, 0x00, _q->num_channels*sizeof(TC));
+}
+
+// set arctangent approximation order (0: exact)
+void FREQDEM(_set_accuracy)(FREQDEM()    _q,
+                            unsigned int _order)
+{
+    if (_order != 0 && (_order < 3 || _order > 2*LIQUID_FREQDEM_NUM_ORDERS+1 || (_order % 2) == 0)) {
+        fprintf(stderr,"error: freqdem_set_accuracy(), order must be 0 or odd in [3,%u]\n",
+                2*LIQUID_FREQDEM_NUM_ORDERS+1);
+        exit(1);
+    }
+
+    _q->order = _order;
+    if (_order == 0) {
+        _q->c     = NULL;
+        _q->num_c = 0;
+    } else {
+        _q->c     = liquid_freqdem_atan_coeff[(_order-3)/2];
+        _q->num_c = (_order+1)/2;
+    }
 }
 
 // demodulate sample
@@ -94,26 +155,65 @@ void FREQDEM(_demodulate)(FREQDEM() _q,
                           TC        _r,
                           T *       _m)
 {
+    if (_q->num_channels != 1) {
+        fprintf(stderr,"error: freqdem_demodulate(), object has %u channels; use freqdem_demodulate_block()\n",
+                _q->num_channels);
+        exit(1);
+    }
+
     // compute phase difference and normalize by modulation index
-    *_m = cargf( conjf(_q->r_prime)*_r ) * _q->ref;
+    FREQDEM(_phase_block)(_q, &_r, _q->r_prime, 1, _m);
 
     // save previous input sample
-    _q->r_prime = _r;
+    _q->r_prime[0] = _r;
 }
 
 // demodulate block of samples
 //  _q      :   frequency demodulator object
-//  _r      :   received signal r(t) [size: _n x 1]
-//  _n      :   number of input, output samples
-//  _m      :   message signal m(t), [size: _n x 1]
+//  _r      :   received signal r(t), interleaved by channel [size: _n*C x 1]
+//  _n      :   number of input, output samples per channel
+//  _m      :   message signal m(t), interleaved by channel [size: _n*C x 1]
 void FREQDEM(_demodulate_block)(FREQDEM()    _q,
                                 TC *         _r,
                                 unsigned int _n,
                                 T *          _m)
 {
-    // TODO: implement more efficient method
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        FREQDEM(_demodulate)(_q, _r[i], &_m[i]);
+    if (_n == 0)
+        return;
+
+    // the first sample of each channel is differenced against the saved
+    // state, the rest against the previous sample of the same channel
+    unsigned int C = _q->num_channels;
+    FREQDEM(_phase_block)(_q, _r,   _q->r_prime, C,        _m);
+    FREQDEM(_phase_block)(_q, _r+C, _r,          (_n-1)*C, _m+C);
+
+    // save last sample of each channel
+    memmove(_q->r_prime, &_r[(_n-1)*C], C*sizeof(TC));
 }
 
+//
+// internal methods
+//
+
+// compute scaled phase differences for a block of samples
+void FREQDEM(_phase_block)(FREQDEM()    _q,
+                           TC *         _x,
+                           TC *         _x_prev,
+                           unsigned int _n,
+                           T *          _m)
+{
+    unsigned int i;
+    if (_q->order == 0) {
+        for (i=0; i<_n; i++)
+            _m[i] = cargf( conjf(_x_prev[i])*_x[i] ) * _q->ref;
+        return;
+    }
+
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_MODEM) == LIQUID_SIMD_AVX2) {
+        liquid_freqdem_phase_block_avx2(_x, _x_prev, _n, _q->c, _q->num_c, _q->ref, _m);
+        return;
+    }
+#endif
+    liquid_freqdem_phase_block(_x, _x_prev, _n, _q->c, _q->num_c, _q->ref, _m);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// freqdem_kernels.avx.c : block phase-difference kernels for freqdem
+// (x86 AVX2)
+//
+// Eight samples are processed per iteration with the same polynomial
+// and octant reflection as the portable kernel in freqdem_kernels.c;
+// results agree to within floating-point rounding. These kernels are
+// compiled with per-function target attributes and are selected at
+// run time.
+//
+
+#include <immintrin.h>
+#include <float.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// load eight complex samples as in-phase and quadrature vectors
+__attribute__((target("avx2")))
+static inline void liquid_freqdem_load8(const float complex * _x,
+                                        __m256 *              _re,
+                                        __m256 *              _im)
+{
+    __m256 a = _mm256_loadu_ps((const float*)(_x  ));
+    __m256 b = _mm256_loadu_ps((const float*)(_x+4));
+
+    // [a0 a2 b0 b2 | a4 a6 b4 b6] -> [0 2 4 6 8 10 12 14]
+    __m256 re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+    __m256 im = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+    *_re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re), _MM_SHUFFLE(3,1,2,0)));
+    *_im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im), _MM_SHUFFLE(3,1,2,0)));
+}
+
+// phase difference block (see liquid.internal.h)
+__attribute__((target("avx2")))
+void liquid_freqdem_phase_block_avx2(const float complex * _x,
+                                     const float complex * _x_prev,
+                                     unsigned int          _n,
+                                     const float *         _c,
+                                     unsigned int          _num_c,
+                                     float                 _scale,
+                                     float *               _m)
+{
+    __m256 sign  = _mm256_set1_ps(-0.0f);
+    __m256 tiny  = _mm256_set1_ps(FLT_MIN);
+    __m256 pi_2  = _mm256_set1_ps((float)M_PI_2);
+    __m256 pi    = _mm256_set1_ps((float)M_PI);
+    __m256 scale = _mm256_set1_ps(_scale);
+    __m256 c[LIQUID_FREQDEM_MAX_COEFF];
+    unsigned int i;
+    int k;
+    for (k=0; k<(int)_num_c; k++)
+        c[k] = _mm256_set1_ps(_c[k]);
+
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 xr, xi, pr, pi_;
+        liquid_freqdem_load8(_x+i,      &xr, &xi);
+        liquid_freqdem_load8(_x_prev+i, &pr, &pi_);
+
+        // z = conj(x_prev) x
+        __m256 zr = _mm256_add_ps(_mm256_mul_ps(pr,xr), _mm256_mul_ps(pi_,xi));
+        __m256 zi = _mm256_sub_ps(_mm256_mul_ps(pr,xi), _mm256_mul_ps(pi_,xr));
+
+        // t = min(|zi|,|zr|) / max(|zi|,|zr|)
+        __m256 a  = _mm256_andnot_ps(sign, zi);
+        __m256 b  = _mm256_andnot_ps(sign, zr);
+        __m256 t  = _mm256_div_ps(_mm256_min_ps(a,b), _mm256_max_ps(_mm256_max_ps(a,b), tiny));
+        __m256 t2 = _mm256_mul_ps(t,t);
+
+        // Horner evaluation
+        __m256 p = c[_num_c-1];
+        for (k=(int)_num_c-2; k>=0; k--)
+            p = _mm256_add_ps(_mm256_mul_ps(p,t2), c[k]);
+        p = _mm256_mul_ps(p,t);
+
+        // reflect into proper octant, quadrant and half plane
+        p = _mm256_blendv_ps(p, _mm256_sub_ps(pi_2,p), _mm256_cmp_ps(a, b, _CMP_GT_OQ));
+        p = _mm256_blendv_ps(p, _mm256_sub_ps(pi,  p), zr);
+        p = _mm256_or_ps(p, _mm256_and_ps(sign, zi));
+
+        _mm256_storeu_ps(&_m[i], _mm256_mul_ps(p, scale));
+    }
+
+    // scalar tail
+    liquid_freqdem_phase_block(_x+i, _x_prev+i, _n-i, _c, _num_c, _scale, _m+i);
+}
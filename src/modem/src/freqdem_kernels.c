@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// freqdem_kernels.c : block phase-difference kernels for freqdem (portable C)
+//
+// The arctangent is approximated by an odd minimax polynomial in
+// t = min(|x|,|y|)/max(|x|,|y|) on [0,1], followed by octant
+// reflection; the code is branch free so that the compiler can
+// vectorize it.
+//
+
+#include <math.h>
+#include <float.h>
+
+#include "liquid.internal.h"
+
+// minimax coefficients of atan(t) ~ t*(c0 + c1 t^2 + c2 t^4 + ...),
+// indexed by (order-3)/2; max. absolute error (radians) by order:
+//   3: 5.0e-3,  5: 6.1e-4,  7: 8.1e-5,  9: 1.1e-5,  11: 1.7e-6,  13: 2.5e-7
+const float liquid_freqdem_atan_coeff[LIQUID_FREQDEM_NUM_ORDERS][LIQUID_FREQDEM_MAX_COEFF] = {
+    { 9.723941179e-01f, -1.919479544e-01f, },
+    { 9.953579548e-01f, -2.886902380e-01f,  7.933904142e-02f, },
+    { 9.992138126e-01f, -3.211749693e-01f,  1.462644636e-01f, -3.898651416e-02f, },
+    { 9.998663295e-01f, -3.303047855e-01f,  1.801592947e-01f, -8.515635090e-02f,
+      2.084511419e-02f, },
+    { 9.999772191e-01f, -3.326228279e-01f,  1.935403761e-01f, -1.164264820e-01f,
+      5.264735147e-02f, -1.171913573e-02f, },
+    { 9.999961115e-01f, -3.331736805e-01f,  1.980781556e-01f, -1.323334210e-01f,
+      7.962367237e-02f, -3.360422057e-02f,  6.811793291e-03f, },
+};
+
+// polynomial approximation to atan2f(_y,_x) (see liquid.internal.h)
+float liquid_freqdem_atan2f(float         _y,
+                            float         _x,
+                            const float * _c,
+                            unsigned int  _num_c)
+{
+    float a  = fabsf(_y);
+    float b  = fabsf(_x);
+    float t  = fminf(a,b) / fmaxf(fmaxf(a,b), FLT_MIN);
+    float t2 = t*t;
+
+    // Horner evaluation
+    float p = _c[_num_c-1];
+    int k;
+    for (k=(int)_num_c-2; k>=0; k--)
+        p = p*t2 + _c[k];
+    p *= t;
+
+    // reflect into proper octant, quadrant and half plane
+    p = a > b        ? (float)M_PI_2 - p : p;
+    p = signbit(_x)  ? (float)M_PI   - p : p;
+    return copysignf(p, _y);
+}
+
+// phase difference block (see liquid.internal.h)
+void liquid_freqdem_phase_block(const float complex * _x,
+                                const float complex * _x_prev,
+                                unsigned int          _n,
+                                const float *         _c,
+                                unsigned int          _num_c,
+                                float                 _scale,
+                                float *               _m)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // z = conj(x_prev) x
+        float xr = crealf(_x[i]),      xi = cimagf(_x[i]);
+        float pr = crealf(_x_prev[i]), pi = cimagf(_x_prev[i]);
+        float zr = pr*xr + pi*xi;
+        float zi = pr*xi - pi*xr;
+        _m[i] = liquid_freqdem_atan2f(zi, zr, _c, _num_c) * _scale;
+    }
+}
@@ -53,7 +53,7 @@ FREQMOD() FREQMOD(_create)(float _kf)
     }
 
     // create main object memory
-    FREQMOD() q = (freqmod) malloc(sizeof(struct FREQMOD(_s)));
+    FREQMOD() q = (freqmod) liquid_malloc(sizeof(struct FREQMOD(_s)));
 
     // set modulation factor
     q->kf  = _kf;
@@ -61,7 +61,7 @@ FREQMOD() FREQMOD(_create)(float _kf)
 
     // initialize look-up table
     q->sincos_table_len = 1024;
-    q->sincos_table     = (TC*) malloc( q->sincos_table_len*sizeof(TC) );
+    q->sincos_table     = (TC*) liquid_malloc( q->sincos_table_len*sizeof(TC) );
     unsigned int i;
     for (i=0; i<q->sincos_table_len; i++) {
         q->sincos_table[i] = cexpf(_Complex_I*2*M_PI*(float)i / (float)(q->sincos_table_len) );
@@ -78,10 +78,10 @@ FREQMOD() FREQMOD(_create)(float _kf)
 void FREQMOD(_destroy)(FREQMOD() _q)
 {
     // free table
-    free(_q->sincos_table);
+    liquid_free(_q->sincos_table);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print modulation internals
@@ -37,6 +37,17 @@
 // internal methods
 //
 
+// run Goertzel filters over the symbol in buf_time, returning the
+// squared magnitude of each bin
+//  _q      :   fskdem object
+//  _w      :   bin phasors exp(-j 2 pi b/K) [size: _n x 1]
+//  _n      :   number of bins, _n <= max(M,3)
+//  _v      :   squared bin magnitudes [size: _n x 1]
+void fskdem_goertzel(fskdem          _q,
+                     float complex * _w,
+                     unsigned int    _n,
+                     float *         _v);
+
 // fskdem
 struct fskdem_s {
     // common
@@ -53,6 +64,11 @@ struct fskdem_s {
     FFT_PLAN        fft;        // FFT object
     unsigned int *  demod_map;  // demodulation map
 
+    // Goertzel demodulation (tone bins only)
+    int             goertzel;   // demodulate with Goertzel filters?
+    float complex * gphasor;    // tone bin phasors exp(-j 2 pi b/K) [size: M x 1]
+    float complex * gstate;     // Goertzel filter states [size: 2 max(M,3) x 1]
+
     // state variables
     unsigned int    s_demod;    // demodulated symbol (used for frequency error)
 };
@@ -78,7 +94,7 @@ fskdem fskdem_create(unsigned int _m,
     }
 
     // create main object memory
-    fskdem q = (fskdem) malloc(sizeof(struct fskdem_s));
+    fskdem q = (fskdem) liquid_malloc(sizeof(struct fskdem_s));
 
     // set basic internal properties
     q->m         = _m;              // bits per symbol
@@ -119,7 +135,7 @@ fskdem fskdem_create(unsigned int _m,
     
     // determine demodulation mapping between tones and frequency bins
     // TODO: use gray coding
-    q->demod_map = (unsigned int *) malloc(q->M * sizeof(unsigned int));
+    q->demod_map = (unsigned int *) liquid_malloc(q->M * sizeof(unsigned int));
     unsigned int i;
     for (i=0; i<q->M; i++) {
         // print frequency bins
@@ -141,10 +157,32 @@ fskdem fskdem_create(unsigned int _m,
     }
 
     // allocate memory for transform
-    q->buf_time = (float complex*) malloc(q->K * sizeof(float complex));
-    q->buf_freq = (float complex*) malloc(q->K * sizeof(float complex));
+    q->buf_time = (float complex*) liquid_malloc(q->K * sizeof(float complex));
+    q->buf_freq = (float complex*) liquid_malloc(q->K * sizeof(float complex));
     q->fft = FFT_CREATE_PLAN(q->K, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, 0);
 
+    // Goertzel filters on the tone bins only
+    q->gphasor = (float complex *) liquid_malloc(q->M * sizeof(float complex));
+    q->gstate  = (float complex *) liquid_malloc(2 * (q->M < 3 ? 3 : q->M) * sizeof(float complex));
+    for (i=0; i<q->M; i++)
+        q->gphasor[i] = cexpf(-_Complex_I*2*M_PI*(float)(q->demod_map[i])/(float)(q->K));
+
+    // select Goertzel filters when M filters over k samples cost less
+    // than the K-point transform, whose cost per point grows with its
+    // radices (Stockham) or is dominated by large prime factors
+    float cost_fft = (float)(q->K) * log2f((float)(q->K));
+    liquid_fft_method method = liquid_fft_estimate_method(q->K);
+    if (method == LIQUID_FFT_METHOD_STOCKHAM) {
+        unsigned int radix[LIQUID_FFT_STOCKHAM_MAX_STAGES];
+        unsigned int num_stages = fft_stockham_factor(q->K, radix);
+        cost_fft = 0.0f;
+        for (i=0; i<num_stages; i++)
+            cost_fft += 0.5f * (float)(q->K * radix[i]);
+    } else if (method != LIQUID_FFT_METHOD_RADIX2) {
+        cost_fft *= 4.0f;
+    }
+    q->goertzel = (float)(q->M * q->k) <= 1.5f*cost_fft;
+
     // reset modem object
     fskdem_reset(q);
 
@@ -156,13 +194,15 @@ fskdem fskdem_create(unsigned int _m,
 void fskdem_destroy(fskdem _q)
 {
     // free allocated arrays
-    free(_q->demod_map);
-    free(_q->buf_time);
-    free(_q->buf_freq);
+    liquid_free(_q->demod_map);
+    liquid_free(_q->buf_time);
+    liquid_free(_q->buf_freq);
+    liquid_free(_q->gphasor);
+    liquid_free(_q->gstate);
     FFT_DESTROY_PLAN(_q->fft);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print fskdem object internals
@@ -172,6 +212,8 @@ void fskdem_print(fskdem _q)
     printf("    bits/symbol     :   %u\n", _q->m);
     printf("    samples/symbol  :   %u\n", _q->k);
     printf("    bandwidth       :   %8.5f\n", _q->bandwidth);
+    printf("    demodulation    :   %s (%u-point fft)\n",
+            _q->goertzel ? "goertzel" : "fft", _q->K);
 }
 
 // reset state
@@ -188,6 +230,21 @@ void fskdem_reset(fskdem _q)
     _q->s_demod = 0;
 }
 
+// set demodulation method: Goertzel filters on the tone bins only, or
+// a full transform
+int fskdem_set_goertzel(fskdem _q,
+                        int    _enable)
+{
+    _q->goertzel = _enable ? 1 : 0;
+    return 0;
+}
+
+// get demodulation method
+int fskdem_get_goertzel(fskdem _q)
+{
+    return _q->goertzel;
+}
+
 // demodulate symbol, assuming perfect symbol timing
 //  _q      :   fskdem object
 //  _y      :   input sample array [size: _k x 1]
@@ -197,13 +254,26 @@ unsigned int fskdem_demodulate(fskdem          _q,
     // copy input to internal time buffer
     memmove(_q->buf_time, _y, _q->k*sizeof(float complex));
 
-    // compute transform, storing result in 'buf_freq'
-    FFT_EXECUTE(_q->fft);
-
     // find maximum by looking at particular bins
     float        vmax  = 0;
     unsigned int s     = 0;
 
+    if (_q->goertzel) {
+        // evaluate tone bins only
+        float v[_q->M];
+        fskdem_goertzel(_q, _q->gphasor, _q->M, v);
+        for (s=0; s<_q->M; s++) {
+            if (s==0 || v[s] > vmax) {
+                _q->s_demod = s;
+                vmax = v[s];
+            }
+        }
+        return _q->s_demod;
+    }
+
+    // compute transform, storing result in 'buf_freq'
+    FFT_EXECUTE(_q->fft);
+
     // run search
     for (s=0; s<_q->M; s++) {
         float v = cabsf( _q->buf_freq[_q->demod_map[s]] );
@@ -227,9 +297,24 @@ float fskdem_get_frequency_error(fskdem _q)
     //unsigned int index = _q->buf_freq[ _q->s_demod ];
 
     // extract peak value of previous, post FFT index
-    float vm = cabsf(_q->buf_freq[(_q->s_demod+_q->K-1)%_q->K]);  // previous
-    float v0 = cabsf(_q->buf_freq[ _q->s_demod               ]);  // peak
-    float vp = cabsf(_q->buf_freq[(_q->s_demod+      1)%_q->K]);  // post
+    unsigned int b[3] = {(_q->s_demod+_q->K-1)%_q->K, _q->s_demod, (_q->s_demod+1)%_q->K};
+    float vm, v0, vp;
+    if (_q->goertzel) {
+        // transform was not computed; evaluate the three bins
+        float complex w[3];
+        float         v[3];
+        unsigned int i;
+        for (i=0; i<3; i++)
+            w[i] = cexpf(-_Complex_I*2*M_PI*(float)b[i]/(float)(_q->K));
+        fskdem_goertzel(_q, w, 3, v);
+        vm = sqrtf(v[0]);   // previous
+        v0 = sqrtf(v[1]);   // peak
+        vp = sqrtf(v[2]);   // post
+    } else {
+        vm = cabsf(_q->buf_freq[b[0]]); // previous
+        v0 = cabsf(_q->buf_freq[b[1]]); // peak
+        vp = cabsf(_q->buf_freq[b[2]]); // post
+    }
 
     // compute derivative
     // TODO: compensate for bin spacing
@@ -237,3 +322,36 @@ float fskdem_get_frequency_error(fskdem _q)
     return (vp - vm) / v0;
 }
 
+// run Goertzel filters over symbol (see above); the filters are
+// updated together so their recursions are independent
+void fskdem_goertzel(fskdem          _q,
+                     float complex * _w,
+                     unsigned int    _n,
+                     float *         _v)
+{
+    float complex * s1 = _q->gstate;        // s[n-1]
+    float complex * s2 = _q->gstate + _n;   // s[n-2]
+    float           c[_n];                  // 2 cos(w)
+    unsigned int i, j;
+    for (j=0; j<_n; j++) {
+        c[j]  = 2.0f*crealf(_w[j]);
+        s1[j] = 0.0f;
+        s2[j] = 0.0f;
+    }
+
+    // s[n] = x[n] + 2 cos(w) s[n-1] - s[n-2]
+    for (i=0; i<_q->k; i++) {
+        float complex x = _q->buf_time[i];
+        for (j=0; j<_n; j++) {
+            float complex s0 = x + c[j]*s1[j] - s2[j];
+            s2[j] = s1[j];
+            s1[j] = s0;
+        }
+    }
+
+    // X[b] = exp(-jw(k-1)) (s[k-1] - exp(-jw) s[k-2]); keep magnitude
+    for (j=0; j<_n; j++) {
+        float complex y = s1[j] - _w[j]*s2[j];
+        _v[j] = crealf(y)*crealf(y) + cimagf(y)*cimagf(y);
+    }
+}
@@ -67,7 +67,7 @@ fskmod fskmod_create(unsigned int _m,
     }
 
     // create main object memory
-    fskmod q = (fskmod) malloc(sizeof(struct fskmod_s));
+    fskmod q = (fskmod) liquid_malloc(sizeof(struct fskmod_s));
 
     // set basic internal properties
     q->m         = _m;              // bits per symbol
@@ -94,7 +94,7 @@ void fskmod_destroy(fskmod _q)
     nco_crcf_destroy(_q->oscillator);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print fskmod object internals
@@ -135,13 +135,6 @@ void fskmod_modulate(fskmod          _q,
     nco_crcf_set_frequency(_q->oscillator, dphi);
 
     // generate output tone
-    unsigned int i;
-    for (i=0; i<_q->k; i++) {
-        // compute complex output
-        nco_crcf_cexpf(_q->oscillator, &_y[i]);
-        
-        // step oscillator
-        nco_crcf_step(_q->oscillator);
-    }
+    nco_crcf_cexpf_block(_q->oscillator, _y, _q->k);
 }
 
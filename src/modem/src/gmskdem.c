@@ -85,7 +85,7 @@ gmskdem gmskdem_create(unsigned int _k,
     }
 
     // allocate memory for main object
-    gmskdem q = (gmskdem)malloc(sizeof(struct gmskdem_s));
+    gmskdem q = (gmskdem)liquid_malloc(sizeof(struct gmskdem_s));
 
     // set properties
     q->k  = _k;
@@ -94,7 +94,7 @@ gmskdem gmskdem_create(unsigned int _k,
 
     // allocate memory for filter taps
     q->h_len = 2*(q->k)*(q->m)+1;
-    q->h = (float*) malloc(q->h_len * sizeof(float));
+    q->h = (float*) liquid_malloc(q->h_len * sizeof(float));
 
     // compute filter coefficients
     liquid_firdes_gmskrx(q->k, q->m, q->BT, 0.0f, q->h);
@@ -142,10 +142,10 @@ void gmskdem_destroy(gmskdem _q)
 #endif
 
     // free filter array
-    free(_q->h);
+    liquid_free(_q->h);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void gmskdem_print(gmskdem _q)
@@ -31,6 +31,10 @@
 
 #include "liquid.internal.h"
 
+// number of symbols between recomputing the output phasor from the
+// phase state (the phasor is otherwise advanced by rotation)
+#define LIQUID_GMSKMOD_RESYNC   (32)
+
 struct gmskmod_s {
     unsigned int k;         // samples/symbol
     unsigned int m;         // symbol delay
@@ -43,8 +47,21 @@ struct gmskmod_s {
 
     float theta;            // phase state
     float k_inv;            // 1/k
+
+    // phase trajectory table, indexed by the last L bits (newest in
+    // the least-significant bit); NULL if too large
+    unsigned int    L;          // pulse span [symbols]
+    unsigned int    state;      // bit history
+    unsigned int    num_syms;   // symbols since reset, saturating at L
+    float complex * traj;       // rotation at each sample [2^L x k]
+    float *         dtheta;     // phase change over symbol [2^L x 1]
+    float complex   phasor;     // exp(j*theta)
+    unsigned int    num_rot;    // rotations since phasor was recomputed
 };
 
+// build phase trajectory table
+void gmskmod_init_table(gmskmod _q);
+
 // create gmskmod object
 //  _k      :   samples/symbol
 //  _m      :   filter delay (symbols)
@@ -64,7 +81,7 @@ gmskmod gmskmod_create(unsigned int _k,
         exit(1);
     }
 
-    gmskmod q = (gmskmod)malloc(sizeof(struct gmskmod_s));
+    gmskmod q = (gmskmod)liquid_malloc(sizeof(struct gmskmod_s));
 
     // set properties
     q->k  = _k;
@@ -76,7 +93,7 @@ gmskmod gmskmod_create(unsigned int _k,
 
     // allocate memory for filter taps
     q->h_len = 2*(q->k)*(q->m)+1;
-    q->h = (float*) malloc(q->h_len * sizeof(float));
+    q->h = (float*) liquid_malloc(q->h_len * sizeof(float));
 
     // compute filter coefficients
     liquid_firdes_gmsktx(q->k, q->m, q->BT, 0.0f, q->h);
@@ -84,6 +101,13 @@ gmskmod gmskmod_create(unsigned int _k,
     // create interpolator object
     q->interp_tx = firinterp_rrrf_create_prototype(LIQUID_FIRFILT_GMSKTX, q->k, q->m, q->BT, 0);
 
+    // build phase trajectory table
+    q->L      = 2*q->m + 1;
+    q->traj   = NULL;
+    q->dtheta = NULL;
+    if (q->L <= LIQUID_CPM_TABLE_MAX_BITS)
+        gmskmod_init_table(q);
+
     // reset modem state
     gmskmod_reset(q);
 
@@ -97,10 +121,14 @@ void gmskmod_destroy(gmskmod _q)
     firinterp_rrrf_destroy(_q->interp_tx);
 
     // free transmit filter array
-    free(_q->h);
+    liquid_free(_q->h);
+
+    // free phase trajectory table
+    liquid_free(_q->traj);
+    liquid_free(_q->dtheta);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void gmskmod_print(gmskmod _q)
@@ -119,12 +147,82 @@ void gmskmod_reset(gmskmod _q)
 
     // clear interpolator buffer
     firinterp_rrrf_reset(_q->interp_tx);
+
+    // clear bit history
+    _q->state    = 0;
+    _q->num_syms = 0;
+
+    _q->phasor  = 1.0f;
+    _q->num_rot = 0;
+}
+
+// get phase state
+float gmskmod_get_phase(gmskmod _q)
+{
+    return _q->theta;
+}
+
+// restore state after modulating symbols from reset without computing
+// output, e.g. following a pre-rendered sequence
+//  _q      :   modulator object
+//  _s      :   symbols modulated since reset [size: _n x 1]
+//  _n      :   number of symbols
+//  _theta  :   phase state after modulating symbols
+void gmskmod_load_state(gmskmod         _q,
+                        unsigned char * _s,
+                        unsigned int    _n,
+                        float           _theta)
+{
+    firinterp_rrrf_reset(_q->interp_tx);
+
+    _q->state    = 0;
+    _q->num_syms = 0;
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        firinterp_rrrf_push(_q->interp_tx, _s[i]==0 ? -_q->k_inv : _q->k_inv);
+        _q->state = (_q->state << 1) | (_s[i] ? 1 : 0);
+        if (_q->num_syms < _q->L) _q->num_syms++;
+    }
+    _q->state &= (1 << _q->L) - 1;
+
+    _q->theta   = _theta;
+    _q->phasor  = liquid_cexpjf(_q->theta);
+    _q->num_rot = 0;
 }
 
 void gmskmod_modulate(gmskmod _q,
                       unsigned int _s,
                       float complex * _y)
 {
+    // update bit history
+    _q->state = ((_q->state << 1) | (_s ? 1 : 0)) & ((1 << _q->L) - 1);
+    if (_q->num_syms < _q->L) _q->num_syms++;
+
+    unsigned int i;
+    if (_q->traj != NULL && _q->num_syms == _q->L) {
+        // pulse spans transmitted symbols only: rotate trajectory for
+        // this bit history by current phase
+        const float complex * t = &_q->traj[_q->state * _q->k];
+        for (i=0; i<_q->k; i++)
+            _y[i] = _q->phasor * t[i];
+
+        // advance phase state
+        _q->theta += _q->dtheta[_q->state];
+        if (_q->theta >  M_PI) _q->theta -= 2*M_PI;
+        if (_q->theta < -M_PI) _q->theta += 2*M_PI;
+
+        // advance phasor by final trajectory rotation, periodically
+        // recomputing it from the phase state to bound round-off
+        if (++_q->num_rot == LIQUID_GMSKMOD_RESYNC) {
+            _q->phasor  = liquid_cexpjf(_q->theta);
+            _q->num_rot = 0;
+        } else {
+            _q->phasor *= t[_q->k-1];
+        }
+        return;
+    }
+
     // generate sample from symbol
     float x = _s==0 ? -_q->k_inv : _q->k_inv;
 
@@ -133,7 +231,7 @@ void gmskmod_modulate(gmskmod _q,
     firinterp_rrrf_execute(_q->interp_tx, x, phi);
 
     // integrate phase state
-    unsigned int i;
+    float theta[_q->k];
     for (i=0; i<_q->k; i++) {
         // integrate phase state
         _q->theta += phi[i];
@@ -141,12 +239,60 @@ void gmskmod_modulate(gmskmod _q,
         // ensure phase in [-pi, pi]
         if (_q->theta >  M_PI) _q->theta -= 2*M_PI;
         if (_q->theta < -M_PI) _q->theta += 2*M_PI;
-
-        // compute output
-        _y[i] = liquid_cexpjf(_q->theta);
+        theta[i] = _q->theta;
     }
 
+    // compute output
+    float s[_q->k], c[_q->k];
+    liquid_sincosf_block(theta, _q->k, s, c, LIQUID_TRIG_FAST);
+    for (i=0; i<_q->k; i++)
+        _y[i] = c[i] + _Complex_I*s[i];
+    _q->phasor  = liquid_cexpjf(_q->theta);
+    _q->num_rot = 0;
+}
 
+// modulate block of symbols
+//  _q      :   modulator object
+//  _s      :   input symbols [size: _n x 1]
+//  _n      :   number of input symbols
+//  _y      :   output samples [size: _k*_n x 1]
+void gmskmod_modulate_block(gmskmod              _q,
+                            const unsigned int * _s,
+                            unsigned int         _n,
+                            float complex *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        gmskmod_modulate(_q, _s[i], &_y[i*_q->k]);
 }
 
+//
+// internal methods
+//
+
+// build phase trajectory table: for every history of L bits, the
+// interpolator output is integrated from zero phase over one symbol
+void gmskmod_init_table(gmskmod _q)
+{
+    unsigned int n = 1 << _q->L;
+    _q->traj   = (float complex*) liquid_malloc(n*_q->k*sizeof(float complex));
+    _q->dtheta = (float*)         liquid_malloc(n*sizeof(float));
+
+    unsigned int s, i;
+    float phi[_q->k];
+    for (s=0; s<n; s++) {
+        // push older bits (most-significant first), then run newest
+        firinterp_rrrf_reset(_q->interp_tx);
+        for (i=_q->L-1; i>0; i--)
+            firinterp_rrrf_push(_q->interp_tx, (s >> i) & 1 ? _q->k_inv : -_q->k_inv);
+        firinterp_rrrf_execute(_q->interp_tx, s & 1 ? _q->k_inv : -_q->k_inv, phi);
 
+        float theta = 0.0f;
+        for (i=0; i<_q->k; i++) {
+            theta += phi[i];
+            _q->traj[s*_q->k + i] = liquid_cexpjf(theta);
+        }
+        _q->dtheta[s] = theta;
+    }
+    firinterp_rrrf_reset(_q->interp_tx);
+}
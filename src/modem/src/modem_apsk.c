@@ -44,7 +44,7 @@ MODEM() MODEM(_create_apsk)(unsigned int _bits_per_symbol)
         exit(1);
     }
 
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     q->scheme = apskdef->scheme;
     MODEM(_init)(q, _bits_per_symbol);
 
@@ -62,28 +62,46 @@ MODEM() MODEM(_create_apsk)(unsigned int _bits_per_symbol)
         q->data.apsk.r_slicer[i] = apskdef->r_slicer[i];
 
     // copy symbol map
-    q->data.apsk.map = (unsigned char *) malloc(q->M*sizeof(unsigned char));
+    q->data.apsk.map = (unsigned char *) liquid_malloc(q->M*sizeof(unsigned char));
     memmove(q->data.apsk.map, apskdef->map, q->M*sizeof(unsigned char));
 
+    // demodulation tables: squared slicer radii, angular scale and
+    // offset of each level, and inverse symbol map
+    unsigned int t = 0;
+    for (i=0; i<q->data.apsk.num_levels; i++) {
+        if (i < q->data.apsk.num_levels-1)
+            q->data.apsk.r2_slicer[i] = q->data.apsk.r_slicer[i]*q->data.apsk.r_slicer[i];
+        q->data.apsk.alpha[i]  = (T)q->data.apsk.p[i] / (2.0f*M_PI);
+        q->data.apsk.beta[i]   = q->data.apsk.phi[i] * q->data.apsk.alpha[i];
+        q->data.apsk.offset[i] = t;
+        t += q->data.apsk.p[i];
+    }
+    q->data.apsk.demap = (unsigned char *) liquid_malloc(q->M*sizeof(unsigned char));
+    for (i=0; i<q->M; i++)
+        q->data.apsk.demap[q->data.apsk.map[i]] = i;
+
     // set modulation/demodulation function pointers
     q->modulate_func = &MODEM(_modulate_apsk);
     q->demodulate_func = &MODEM(_demodulate_apsk);
 
-    // initialize soft-demodulation look-up table
-    switch (q->m) {
-    case 2: MODEM(_demodsoft_gentab)(q, 3); break;
-    case 3: MODEM(_demodsoft_gentab)(q, 3); break;
-    case 4: MODEM(_demodsoft_gentab)(q, 4); break;
-    case 5: MODEM(_demodsoft_gentab)(q, 4); break;
-    case 6: MODEM(_demodsoft_gentab)(q, 4); break;
-    case 7: MODEM(_demodsoft_gentab)(q, 5); break;
-    case 8: MODEM(_demodsoft_gentab)(q, 5); break;
-    default:;
-    }
+    // initialize soft-demodulation look-up table and symbol map,
+    // shared by all modems of this scheme
+    if (!MODEM(_tables_acquire)(q, q->scheme)) {
+        switch (q->m) {
+        case 2: MODEM(_demodsoft_gentab)(q, 3); break;
+        case 3: MODEM(_demodsoft_gentab)(q, 3); break;
+        case 4: MODEM(_demodsoft_gentab)(q, 4); break;
+        case 5: MODEM(_demodsoft_gentab)(q, 4); break;
+        case 6: MODEM(_demodsoft_gentab)(q, 4); break;
+        case 7: MODEM(_demodsoft_gentab)(q, 5); break;
+        case 8: MODEM(_demodsoft_gentab)(q, 5); break;
+        default:;
+        }
 
-    // initialize symbol map
-    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
-    MODEM(_init_map)(q);
+        q->symbol_map = (TC*)liquid_malloc(q->M*sizeof(TC));
+        MODEM(_init_map)(q);
+        MODEM(_tables_publish)(q, q->scheme);
+    }
     q->modulate_using_map = 1;
 
     // reset modem and return
@@ -130,57 +148,55 @@ void MODEM(_modulate_apsk)(MODEM()      _q,
     *_y = r * liquid_cexpjf(phi);
 }
 
-// demodulate APSK
-void MODEM(_demodulate_apsk)(MODEM()        _q,
-                             TC             _x,
-                             unsigned int * _sym_out)
+// angle of sample in [0, 2*pi) using octant reduction and a
+// polynomial approximation of atan on [0,1] (error below 2e-6)
+static inline T MODEM(_apsk_angle)(T _xi,
+                                   T _xq)
+{
+    T ax = fabsf(_xi);
+    T ay = fabsf(_xq);
+    T mx = ax > ay ? ax : ay;
+    T mn = ax > ay ? ay : ax;
+    T t  = mx > 0.0f ? mn / mx : 0.0f;
+    T t2 = t*t;
+    T a  = t*(0.99997726f + t2*(-0.33262347f + t2*(0.19354346f +
+              t2*(-0.11643287f + t2*(0.05265332f + t2*(-0.01172120f))))));
+    if (ay > ax)   a = 0.5f*M_PI - a;
+    if (_xi < 0)   a = M_PI - a;
+    if (_xq < 0)   a = 2.0f*M_PI - a;
+    return a;
+}
+
+// slice sample to (unmapped) constellation index: level from squared
+// radius, then nearest point in level from angle
+static inline unsigned int MODEM(_apsk_slice)(MODEM() _q,
+                                              TC      _x)
 {
-    // compute amplitude
-    T r = cabsf(_x);
+    T xi = crealf(_x);
+    T xq = cimagf(_x);
+    T r2 = xi*xi + xq*xq;
 
     // determine which ring to demodulate with
-    unsigned int i, p=0;
-    for (i=0; i<_q->data.apsk.num_levels-1; i++) {
-        if (r < _q->data.apsk.r_slicer[i]) {
-            p = i;
-            break;
-        } else {
-            p = _q->data.apsk.num_levels-1;
-        }
-    }
+    unsigned int p = 0;
+    while (p < _q->data.apsk.num_levels-1 && r2 >= _q->data.apsk.r2_slicer[p])
+        p++;
 
     // find closest point in ring
-    T theta = cargf(_x);
-    if (theta < 0.0f) theta += 2.0f*M_PI;
-    T dphi = 2.0f*M_PI / (T) _q->data.apsk.p[p];
-    unsigned int s_hat=0;
-    T i_hat = (theta - _q->data.apsk.phi[p]) / dphi;
-    s_hat = roundf(i_hat);      // compute symbol (closest angle)
-    s_hat %= _q->data.apsk.p[p];   // ensure symbol is in range
-    //printf("          i_hat : %12.8f (%3u)\n", i_hat, s_hat);
-
-    // accumulate symbol points
-    for (i=0; i<p; i++)
-        s_hat += _q->data.apsk.p[i];
-    //assert(s_hat < _q->M);
-
-    // reverse symbol mapping
-    unsigned int s_prime=0;
-    for (i=0; i<_q->M; i++) {
-        if ( _q->data.apsk.map[i] == s_hat) {
-            s_prime = i;
-            break;
-        }
-    }
+    int n = (int) _q->data.apsk.p[p];
+    int k = (int) floorf(MODEM(_apsk_angle)(xi,xq)*_q->data.apsk.alpha[p] - _q->data.apsk.beta[p] + 0.5f);
+    k %= n;
+    if (k < 0) k += n;
 
-#if 0
-    printf("              x : %12.8f + j*%12.8f\n", crealf(_x), cimagf(_x));
-    printf("              p : %3u\n", p);
-    printf("          theta : %12.8f\n", theta);
-    printf("           dmin : %12.8f\n", dmin);
-    printf("              s : %3u > %3u\n", s_hat, s_prime);
-#endif
+    return _q->data.apsk.offset[p] + (unsigned int)k;
+}
 
+// demodulate APSK
+void MODEM(_demodulate_apsk)(MODEM()        _q,
+                             TC             _x,
+                             unsigned int * _sym_out)
+{
+    // slice and reverse symbol mapping
+    unsigned int s_prime = _q->data.apsk.demap[MODEM(_apsk_slice)(_q, _x)];
     *_sym_out = s_prime;
 
     // re-modulate symbol and store state
@@ -188,3 +204,15 @@ void MODEM(_demodulate_apsk)(MODEM()        _q,
     _q->r = _x;
 }
 
+// hard-decision demodulation of block of APSK samples, without
+// per-sample state updates
+void MODEM(_demodulate_apsk_block)(MODEM()        _q,
+                                   const TC *     _x,
+                                   unsigned int   _n,
+                                   unsigned int * _s)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _s[i] = _q->data.apsk.demap[MODEM(_apsk_slice)(_q, _x[i])];
+}
+
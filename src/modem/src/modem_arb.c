@@ -50,17 +50,28 @@ MODEM() MODEM(_create_arbitrary)(TC * _table,
 // create an arbitrary modem object
 MODEM() MODEM(_create_arb)(unsigned int _bits_per_symbol)
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     q->scheme = LIQUID_MODEM_ARB;
 
     MODEM(_init)(q, _bits_per_symbol);
 
     q->M = q->M;
-    q->symbol_map = (TC*) calloc( q->M, sizeof(TC) );
+    q->symbol_map = (TC*) liquid_calloc( q->M, sizeof(TC) );
 
     q->modulate_func   = &MODEM(_modulate_arb);
     q->demodulate_func = &MODEM(_demodulate_arb);
 
+    // nearest-point grid is built once the constellation is set
+    q->data.arb.n      = 0;
+    q->data.arb.x0     = 0.0f;
+    q->data.arb.y0     = 0.0f;
+    q->data.arb.inv_dx = 0.0f;
+    q->data.arb.inv_dy = 0.0f;
+    q->data.arb.offset = NULL;
+    q->data.arb.sym    = NULL;
+    q->data.arb.cand_i = NULL;
+    q->data.arb.cand_q = NULL;
+
     return q;
 }
 
@@ -79,26 +90,64 @@ void MODEM(_modulate_arb)(MODEM()      _q,
 }
 
 // demodulate arbitrary modem type
+//
+// The received sample is located on the uniform grid built by
+// MODEM(_arb_init_grid)() and compared (squared distance) only against
+// the candidates of its cell; samples off the grid are compared against
+// every point. Ties resolve to the lowest symbol index in both cases.
 void MODEM(_demodulate_arb)(MODEM()        _q,
                             TC             _x,
                             unsigned int * _sym_out)
 {
-    //printf("modem_demodulate_arb() invoked with I=%d, Q=%d\n", x);
-    
-    // search for symbol nearest to received sample
-    unsigned int i;
-    unsigned int s=0;
-    T d;            // distance
-    T d_min = 0.0f; // minimum distance
-
-    for (i=0; i<_q->M; i++) {
-        // compute distance from received symbol to constellation point
-        d = cabsf(_x - _q->symbol_map[i]);
+    T xi = crealf(_x);
+    T xq = cimagf(_x);
+
+    // default: search entire constellation
+    const unsigned char * sym = NULL;
+    const T * cand_i = NULL;
+    const T * cand_q = NULL;
+    unsigned int n = _q->M;
+
+    T gx = (xi - _q->data.arb.x0) * _q->data.arb.inv_dx;
+    T gy = (xq - _q->data.arb.y0) * _q->data.arb.inv_dy;
+    T g  = (T)_q->data.arb.n;
+    if (gx >= 0 && gx < g && gy >= 0 && gy < g) {
+        unsigned int c = (unsigned int)gy * _q->data.arb.n + (unsigned int)gx;
+        unsigned int k = _q->data.arb.offset[c];
+        sym    = _q->data.arb.sym    + k;
+        cand_i = _q->data.arb.cand_i + k;
+        cand_q = _q->data.arb.cand_q + k;
+        n      = _q->data.arb.offset[c+1] - k;
+    }
 
-        // retain symbol with minimum distance
-        if ( i==0 || d < d_min ) {
-            d_min = d;
-            s = i;
+    unsigned int i;
+    unsigned int s = 0;
+    T d_min = 0.0f;
+    if (sym != NULL) {
+        // compute squared distances to all candidates, then find minimum
+        T d[n];
+        for (i=0; i<n; i++) {
+            T ei = xi - cand_i[i];
+            T eq = xq - cand_q[i];
+            d[i] = ei*ei + eq*eq;
+        }
+        unsigned int j = 0;
+        for (i=1; i<n; i++) {
+            if (d[i] < d[j])
+                j = i;
+        }
+        s = sym[j];
+    } else {
+        for (i=0; i<n; i++) {
+            T ei = xi - crealf(_q->symbol_map[i]);
+            T eq = xq - cimagf(_q->symbol_map[i]);
+            T d  = ei*ei + eq*eq;
+
+            // retain symbol with minimum distance
+            if ( i==0 || d < d_min ) {
+                d_min = d;
+                s = i;
+            }
         }
     }
 
@@ -115,7 +164,10 @@ MODEM() MODEM(_create_V29)()
 {
     MODEM() q = MODEM(_create_arb)(4);
 #if T == float
-    MODEM(_arb_init)(q,(TC*)modem_arb_V29,16);
+    if (!MODEM(_tables_acquire)(q, LIQUID_MODEM_V29)) {
+        MODEM(_arb_init)(q,(TC*)modem_arb_V29,16);
+        MODEM(_tables_publish)(q, LIQUID_MODEM_V29);
+    }
 #endif
     return q;
 }
@@ -125,7 +177,10 @@ MODEM() MODEM(_create_arb16opt)()
 {
     MODEM() q = MODEM(_create_arb)(4);
 #if T == float
-    MODEM(_arb_init)(q,(TC*)modem_arb16opt,16);
+    if (!MODEM(_tables_acquire)(q, LIQUID_MODEM_ARB16OPT)) {
+        MODEM(_arb_init)(q,(TC*)modem_arb16opt,16);
+        MODEM(_tables_publish)(q, LIQUID_MODEM_ARB16OPT);
+    }
 #endif
     return q;
 }
@@ -135,7 +190,10 @@ MODEM() MODEM(_create_arb32opt)()
 {
     MODEM() q = MODEM(_create_arb)(5);
 #if T == float
-    MODEM(_arb_init)(q,(TC*)modem_arb32opt,32);
+    if (!MODEM(_tables_acquire)(q, LIQUID_MODEM_ARB32OPT)) {
+        MODEM(_arb_init)(q,(TC*)modem_arb32opt,32);
+        MODEM(_tables_publish)(q, LIQUID_MODEM_ARB32OPT);
+    }
 #endif
     return q;
 }
@@ -145,7 +203,10 @@ MODEM() MODEM(_create_arb64opt)()
 {
     MODEM() q = MODEM(_create_arb)(6);
 #if T == float
-    MODEM(_arb_init)(q,(TC*)modem_arb64opt,64);
+    if (!MODEM(_tables_acquire)(q, LIQUID_MODEM_ARB64OPT)) {
+        MODEM(_arb_init)(q,(TC*)modem_arb64opt,64);
+        MODEM(_tables_publish)(q, LIQUID_MODEM_ARB64OPT);
+    }
 #endif
     return q;
 }
@@ -155,7 +216,10 @@ MODEM() MODEM(_create_arb128opt)()
 {
     MODEM() q = MODEM(_create_arb)(7);
 #if T == float
-    MODEM(_arb_init)(q,(TC*)modem_arb128opt,128);
+    if (!MODEM(_tables_acquire)(q, LIQUID_MODEM_ARB128OPT)) {
+        MODEM(_arb_init)(q,(TC*)modem_arb128opt,128);
+        MODEM(_tables_publish)(q, LIQUID_MODEM_ARB128OPT);
+    }
 #endif
     return q;
 }
@@ -165,7 +229,10 @@ MODEM() MODEM(_create_arb256opt)()
 {
     MODEM() q = MODEM(_create_arb)(8);
 #if T == float
-    MODEM(_arb_init)(q,(TC*)modem_arb256opt,256);
+    if (!MODEM(_tables_acquire)(q, LIQUID_MODEM_ARB256OPT)) {
+        MODEM(_arb_init)(q,(TC*)modem_arb256opt,256);
+        MODEM(_tables_publish)(q, LIQUID_MODEM_ARB256OPT);
+    }
 #endif
     return q;
 }
@@ -175,7 +242,10 @@ MODEM() MODEM(_create_arb64vt)()
 {
     MODEM() q = MODEM(_create_arb)(6);
 #if T == float
-    MODEM(_arb_init)(q,(TC*)modem_arb_vt64,64);
+    if (!MODEM(_tables_acquire)(q, LIQUID_MODEM_ARB64VT)) {
+        MODEM(_arb_init)(q,(TC*)modem_arb_vt64,64);
+        MODEM(_tables_publish)(q, LIQUID_MODEM_ARB64VT);
+    }
 #endif
     return q;
 }
@@ -198,6 +268,9 @@ void MODEM(_arb_init)(MODEM()      _q,
     }
 #endif
 
+    // constellation of a built-in scheme may be shared
+    MODEM(_tables_unshare)(_q);
+
     unsigned int i;
     for (i=0; i<_len; i++)
         _q->symbol_map[i] = _symbol_map[i];
@@ -209,6 +282,8 @@ void MODEM(_arb_init)(MODEM()      _q,
     // scale modem to have unity energy
     MODEM(_arb_scale)(_q);
 
+    // build nearest-point search grid
+    MODEM(_arb_init_grid)(_q);
 }
 
 // initialize an arbitrary modem object on a file
@@ -224,6 +299,9 @@ void MODEM(_arb_init_file)(MODEM() _q,
         exit(1);
     }
 
+    // constellation of a built-in scheme may be shared
+    MODEM(_tables_unshare)(_q);
+
     unsigned int i, results;
     T sym_i, sym_q;
     for (i=0; i<_q->M; i++) {
@@ -250,6 +328,9 @@ void MODEM(_arb_init_file)(MODEM() _q,
 
     // scale modem to have unity energy
     MODEM(_arb_scale)(_q);
+
+    // build nearest-point search grid
+    MODEM(_arb_init_grid)(_q);
 }
 
 // scale arbitrary modem constellation points
@@ -271,6 +352,97 @@ void MODEM(_arb_scale)(MODEM() _q)
     }
 }
 
+// build grid index for nearest-point search
+//
+// The bounding box of the constellation (extended by a margin for
+// noise) is divided into n x n cells. Each cell lists every point that
+// can be nearest to some location inside it: a point is dropped only
+// if its minimum distance to the cell exceeds the smallest maximum
+// distance of any point to the cell.
+void MODEM(_arb_init_grid)(MODEM() _q)
+{
+    unsigned int M = _q->M;
+    unsigned int i, j, c;
+
+    // release previous grid
+    liquid_free(_q->data.arb.offset);
+    liquid_free(_q->data.arb.sym);
+    liquid_free(_q->data.arb.cand_i);
+    liquid_free(_q->data.arb.cand_q);
+
+    // bounding box
+    T xmin = crealf(_q->symbol_map[0]), xmax = xmin;
+    T ymin = cimagf(_q->symbol_map[0]), ymax = ymin;
+    for (i=1; i<M; i++) {
+        T xi = crealf(_q->symbol_map[i]);
+        T xq = cimagf(_q->symbol_map[i]);
+        xmin = xi < xmin ? xi : xmin;
+        xmax = xi > xmax ? xi : xmax;
+        ymin = xq < ymin ? xq : ymin;
+        ymax = xq > ymax ? xq : ymax;
+    }
+    T extent = (xmax - xmin) > (ymax - ymin) ? (xmax - xmin) : (ymax - ymin);
+    T pad    = 0.15f*extent + 1e-3f;
+    xmin -= pad; xmax += pad;
+    ymin -= pad; ymax += pad;
+
+    // grid dimension: about four cells per constellation point
+    unsigned int n = 2;
+    while (n*n < 4*M)
+        n++;
+    T dx = (xmax - xmin) / (T)n;
+    T dy = (ymax - ymin) / (T)n;
+    _q->data.arb.n      = n;
+    _q->data.arb.x0     = xmin;
+    _q->data.arb.y0     = ymin;
+    _q->data.arb.inv_dx = 1.0f / dx;
+    _q->data.arb.inv_dy = 1.0f / dy;
+
+    // count then fill candidate lists
+    unsigned int * offset = (unsigned int*) liquid_malloc((n*n+1)*sizeof(unsigned int));
+    unsigned char * sym   = (unsigned char*) liquid_malloc(n*n*M*sizeof(unsigned char));
+    unsigned int num = 0;
+    for (c=0; c<n*n; c++) {
+        // cell boundaries (widened slightly against rounding)
+        T x0 = xmin + (c % n)*dx - 1e-6f, x1 = x0 + dx + 2e-6f;
+        T y0 = ymin + (c / n)*dy - 1e-6f, y1 = y0 + dy + 2e-6f;
+
+        // smallest maximum distance of any point to the cell
+        T dmax_min = 0.0f;
+        for (i=0; i<M; i++) {
+            T px = crealf(_q->symbol_map[i]);
+            T py = cimagf(_q->symbol_map[i]);
+            T ex = fabsf(px - x0) > fabsf(px - x1) ? fabsf(px - x0) : fabsf(px - x1);
+            T ey = fabsf(py - y0) > fabsf(py - y1) ? fabsf(py - y0) : fabsf(py - y1);
+            T d  = ex*ex + ey*ey;
+            if (i == 0 || d < dmax_min)
+                dmax_min = d;
+        }
+
+        // retain points whose minimum distance does not exceed it
+        offset[c] = num;
+        for (i=0; i<M; i++) {
+            T px = crealf(_q->symbol_map[i]);
+            T py = cimagf(_q->symbol_map[i]);
+            T ex = px < x0 ? x0 - px : (px > x1 ? px - x1 : 0.0f);
+            T ey = py < y0 ? y0 - py : (py > y1 ? py - y1 : 0.0f);
+            if (ex*ex + ey*ey <= dmax_min)
+                sym[num++] = i;
+        }
+    }
+    offset[n*n] = num;
+
+    // store candidate points contiguously for each cell
+    _q->data.arb.offset = offset;
+    _q->data.arb.sym    = (unsigned char*) liquid_realloc(sym, num*sizeof(unsigned char));
+    _q->data.arb.cand_i = (T*) liquid_malloc(num*sizeof(T));
+    _q->data.arb.cand_q = (T*) liquid_malloc(num*sizeof(T));
+    for (j=0; j<num; j++) {
+        _q->data.arb.cand_i[j] = crealf(_q->symbol_map[_q->data.arb.sym[j]]);
+        _q->data.arb.cand_q[j] = cimagf(_q->symbol_map[_q->data.arb.sym[j]]);
+    }
+}
+
 // balance an arbitrary modem's I/Q points
 void MODEM(_arb_balance_iq)(MODEM() _q)
 {
@@ -299,7 +471,8 @@ void MODEM(_demodulate_soft_arb)(MODEM()         _q,
     unsigned int M   = _q->M;
 
     // gamma = 1/(2*sigma^2), approximate for constellation size
-    T gamma = 1.2f*_q->M;
+    // unless noise variance has been set
+    T gamma = _q->soft_gamma > 0 ? _q->soft_gamma : 1.2f*_q->M;
 
     unsigned int s=0;       // hard decision output
     unsigned int k;         // bit index
@@ -27,7 +27,7 @@
 // create an ask (amplitude-shift keying) modem object
 MODEM() MODEM(_create_ask)(unsigned int _bits_per_symbol)
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
 
     MODEM(_init)(q, _bits_per_symbol);
 
@@ -57,10 +57,6 @@ MODEM() MODEM(_create_ask)(unsigned int _bits_per_symbol)
     q->modulate_func = &MODEM(_modulate_ask);
     q->demodulate_func = &MODEM(_demodulate_ask);
 
-    // initialize soft-demodulation look-up table
-    if (q->m >= 2 && q->m < 8)
-        MODEM(_demodsoft_gentab)(q, 2);
-
     // reset modem and return
     MODEM(_reset)(q);
     return q;
@@ -96,3 +92,23 @@ void MODEM(_demodulate_ask)(MODEM()        _q,
     _q->r = _x;
 }
 
+// demodulate ASK (soft)
+void MODEM(_demodulate_soft_ask)(MODEM()         _q,
+                                 TC              _x,
+                                 unsigned int  * _s,
+                                 unsigned char * _soft_bits)
+{
+    // gamma = 1/(2*sigma^2), approximate for constellation size unless
+    // noise variance has been set; the minimum distance scales with 1/M
+    // (rather than 1/sqrt(M) as for QAM) so this keeps the same scale
+    // relative to it
+    T gamma = _q->soft_gamma > 0 ? _q->soft_gamma : 0.6f*_q->M*_q->M;
+
+    T x_hat;
+    MODEM(_demodulate_soft_pam)(crealf(_x), _q->m, _q->data.ask.alpha, gamma,
+                                _s, &x_hat, _soft_bits);
+
+    // store state
+    _q->x_hat = x_hat;
+    _q->r = _x;
+}
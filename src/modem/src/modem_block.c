@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// modem_block.c : block modulate/demodulate methods
+//
+// The modulation scheme is resolved once per block. BPSK, QPSK and
+// rectangular QAM are sliced across the whole block (see
+// modem_slicers.c), with soft slicers specialized for 16-QAM and
+// 64-QAM, and APSK is sliced with its ring/angle tables (see
+// modem_apsk.c); all other schemes run their per-sample routines
+// directly, bypassing the generic dispatch.
+//
+
+// modulate block of symbols
+void MODEM(_modulate_block)(MODEM()              _q,
+                            const unsigned int * _s,
+                            unsigned int         _n,
+                            TC *                 _y)
+{
+    // validate input
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        if (_s[i] >= _q->M) {
+            fprintf(stderr,"error: modem_modulate_block(), input symbol exceeds constellation size\n");
+            exit(1);
+        }
+    }
+
+    if (_q->modulate_using_map) {
+        // modulate simply using map (look-up table)
+        for (i=0; i<_n; i++)
+            _y[i] = _q->symbol_map[_s[i]];
+    } else if (_q->modulate_func == &MODEM(_modulate_bpsk)) {
+        for (i=0; i<_n; i++)
+            _y[i] = _s[i] ? -1.0f : 1.0f;
+    } else if (_q->modulate_func == &MODEM(_modulate_qpsk)) {
+        for (i=0; i<_n; i++) {
+            _y[i] = (_s[i] & 0x01 ? -M_SQRT1_2 : M_SQRT1_2) +
+                    (_s[i] & 0x02 ? -M_SQRT1_2 : M_SQRT1_2)*_Complex_I;
+        }
+    } else {
+        // invoke method specific to scheme (e.g. differential modems
+        // which update internal state on each symbol)
+        for (i=0; i<_n; i++)
+            _q->modulate_func(_q, _s[i], &_y[i]);
+    }
+}
+
+// run block slicer for linear modems, returning 0 if the scheme has
+// none; soft bits are computed only if _soft_bits is not NULL
+static int MODEM(_slice_block)(MODEM()         _q,
+                               const TC *      _x,
+                               unsigned int    _n,
+                               unsigned int *  _s,
+                               unsigned char * _soft_bits)
+{
+    // BPSK and QPSK slicers
+    void (*slice)(const TC *, unsigned int, T, unsigned int *, unsigned char *) = NULL;
+    T gamma = 0.0f;
+    if (_q->demodulate_func == &MODEM(_demodulate_bpsk)) {
+        slice = liquid_modem_slice_bpsk;
+        gamma = MODEM(_get_soft_gamma_bpsk)(_q);
+    } else if (_q->demodulate_func == &MODEM(_demodulate_qpsk)) {
+        slice = liquid_modem_slice_qpsk;
+        gamma = MODEM(_get_soft_gamma_qpsk)(_q);
+    }
+
+    // rectangular QAM (hard decisions only)
+    int qam = _q->demodulate_func == &MODEM(_demodulate_qam) && _soft_bits == NULL;
+
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_MODEM) == LIQUID_SIMD_AVX2) {
+        if (slice == liquid_modem_slice_bpsk) {
+            slice = liquid_modem_slice_bpsk_avx2;
+        } else if (slice == liquid_modem_slice_qpsk) {
+            slice = liquid_modem_slice_qpsk_avx2;
+        } else if (qam) {
+            liquid_modem_slice_qam_avx2(_x, _n, _q->data.qam.m_i, _q->data.qam.m_q, _q->ref, _s);
+            return 1;
+        }
+    }
+#endif
+
+    if (slice != NULL) {
+        slice(_x, _n, gamma, _s, _soft_bits);
+        return 1;
+    } else if (qam) {
+        liquid_modem_slice_qam(_x, _n, _q->data.qam.m_i, _q->data.qam.m_q, _q->ref, _s);
+        return 1;
+    } else if (_q->demodulate_func == &MODEM(_demodulate_apsk) && _soft_bits == NULL) {
+        // table-driven APSK (hard decisions only)
+        MODEM(_demodulate_apsk_block)(_q, _x, _n, _s);
+        return 1;
+    }
+    return 0;
+}
+
+// hard-decision demodulation of block of samples
+void MODEM(_demodulate_block)(MODEM()        _q,
+                              const TC *     _x,
+                              unsigned int   _n,
+                              unsigned int * _s)
+{
+    if (_n == 0)
+        return;
+
+    unsigned int i;
+    if (MODEM(_slice_block)(_q, _x, _n, _s, NULL)) {
+        // set demodulator state (received and estimated sample) from
+        // the final sample
+        unsigned int s;
+        _q->demodulate_func(_q, _x[_n-1], &s);
+    } else {
+        // invoke method specific to scheme
+        for (i=0; i<_n; i++)
+            _q->demodulate_func(_q, _x[i], &_s[i]);
+    }
+}
+
+// soft-decision demodulation of block of samples
+void MODEM(_demodulate_soft_block)(MODEM()         _q,
+                                   const TC *      _x,
+                                   unsigned int    _n,
+                                   unsigned int *  _s,
+                                   unsigned char * _soft_bits)
+{
+    if (_n == 0)
+        return;
+
+    unsigned int i;
+    unsigned int bps = _q->m;
+    if (_q->scheme == LIQUID_MODEM_ARB) {
+        for (i=0; i<_n; i++)
+            MODEM(_demodulate_soft_arb)(_q, _x[i], &_s[i], &_soft_bits[i*bps]);
+    } else if ((_q->scheme == LIQUID_MODEM_BPSK || _q->scheme == LIQUID_MODEM_QPSK) &&
+               MODEM(_slice_block)(_q, _x, _n, _s, _soft_bits))
+    {
+        // set demodulator state from the final sample
+        unsigned int s;
+        _q->demodulate_func(_q, _x[_n-1], &s);
+    } else if (_q->scheme == LIQUID_MODEM_QAM16 || _q->scheme == LIQUID_MODEM_QAM64) {
+        // slicers specialized for constellation size
+        void (*slice)(const TC *, unsigned int, T, T, unsigned int *, unsigned char *) =
+            _q->scheme == LIQUID_MODEM_QAM16 ? liquid_modem_slice_qam16_soft :
+                                               liquid_modem_slice_qam64_soft;
+#if HAVE_DOTPROD_AVX
+        if (liquid_simd_get_kernel(LIQUID_SIMD_MODEM) == LIQUID_SIMD_AVX2) {
+            slice = _q->scheme == LIQUID_MODEM_QAM16 ? liquid_modem_slice_qam16_soft_avx2 :
+                                                       liquid_modem_slice_qam64_soft_avx2;
+        }
+#endif
+        T gamma = _q->soft_gamma > 0 ? _q->soft_gamma : 1.2f*_q->M;
+        slice(_x, _n, _q->data.qam.alpha, gamma, _s, _soft_bits);
+
+        // set demodulator state from the final sample
+        unsigned int s;
+        _q->demodulate_func(_q, _x[_n-1], &s);
+    } else if (liquid_modem_is_qam(_q->scheme)) {
+        for (i=0; i<_n; i++)
+            MODEM(_demodulate_soft_qam)(_q, _x[i], &_s[i], &_soft_bits[i*bps]);
+    } else if (liquid_modem_is_ask(_q->scheme)) {
+        for (i=0; i<_n; i++)
+            MODEM(_demodulate_soft_ask)(_q, _x[i], &_s[i], &_soft_bits[i*bps]);
+    } else if (_q->demod_soft_neighbors != NULL && _q->demod_soft_p != 0) {
+        // approximate log-likelihood method with look-up table for
+        // nearest neighbors
+        for (i=0; i<_n; i++)
+            MODEM(_demodulate_soft_table)(_q, _x[i], &_s[i], &_soft_bits[i*bps]);
+    } else {
+        // demodulate normally and simply copy the hard-demodulated bits
+        MODEM(_demodulate_block)(_q, _x, _n, _s);
+        liquid_unpack_soft_bits_block(_s, _n, bps, _soft_bits);
+    }
+
+    // reduce soft bit precision
+    if (_q->soft_precision < 8)
+        MODEM(_quantize_soft_bits)(_q, _soft_bits, _n*bps);
+}
+
+
+// estimate residual phase of a window of samples already rotated by
+// the running phase estimate
+//  _q      :   modem object
+//  _x      :   rotated samples [size: _n x 1]
+//  _n      :   number of samples
+//  _power  :   Viterbi-Viterbi power (0: decision-directed)
+//  _s      :   buffer for decisions [size: _n x 1]
+//  _y      :   buffer for reference points [size: _n x 1]
+static T MODEM(_estimate_phase_window)(MODEM()        _q,
+                                       const TC *     _x,
+                                       unsigned int   _n,
+                                       unsigned int   _power,
+                                       unsigned int * _s,
+                                       TC *           _y)
+{
+    unsigned int i;
+    TC acc = 0;
+    if (_power == 0) {
+        // correlate against hard decisions
+        MODEM(_demodulate_block)(_q, _x, _n, _s);
+        MODEM(_modulate_block)(_q, _s, _n, _y);
+        for (i=0; i<_n; i++)
+            acc += conjf(_y[i]) * _x[i];
+        return cargf(acc);
+    }
+
+    // raise unit phasors to the constellation order, weighted by
+    // magnitude, and remove the rotation of the constellation itself
+    for (i=0; i<_n; i++) {
+        T  a = cabsf(_x[i]);
+        TC u = a > 0 ? _x[i] / a : 0;
+        unsigned int p;
+        for (p=1; p<_power; p<<=1)
+            u *= u;
+        acc += u * a;
+    }
+    unsigned int s0 = 0;
+    TC c0;
+    MODEM(_modulate_block)(_q, &s0, 1, &c0);
+    T dphi = cargf(acc) - (T)_power * cargf(c0);
+
+    // wrap to (-pi/power, pi/power]
+    dphi = fmodf(dphi + M_PI, 2*M_PI);
+    if (dphi < 0) dphi += 2*M_PI;
+    return (dphi - M_PI) / (T)_power;
+}
+
+// remove slowly varying carrier phase from block of samples
+void MODEM(_recover_phase_block)(MODEM()      _q,
+                                 TC *         _x,
+                                 unsigned int _n,
+                                 unsigned int _window)
+{
+    if (_window == 0) {
+        fprintf(stderr,"error: modem_recover_phase_block(), window size must be greater than zero\n");
+        exit(1);
+    }
+    if (_n == 0 || liquid_modem_is_dpsk(_q->scheme))
+        return;
+
+    // Viterbi-Viterbi for low-order PSK, decision-directed otherwise
+    unsigned int power = 0;
+    if (_q->scheme == LIQUID_MODEM_BPSK || _q->scheme == LIQUID_MODEM_QPSK ||
+        (liquid_modem_is_psk(_q->scheme) && _q->M <= 8))
+    {
+        power = _q->M;
+    }
+
+    // estimate phase of each window, rotating each by the estimate of
+    // the previous one; the residual is unambiguous as long as it stays
+    // within the decision region
+    unsigned int W = _window < _n ? _window : _n;
+    unsigned int num_windows = (_n + W - 1) / W;
+    T            theta [num_windows];
+    TC           buf   [W];
+    TC           ref   [W];
+    unsigned int sym   [W];
+    unsigned int i, w;
+    T theta_hat = 0;
+    for (w=0; w<num_windows; w++) {
+        unsigned int n0  = w*W;
+        unsigned int len = n0 + W <= _n ? W : _n - n0;
+        TC r = cexpf(-_Complex_I*theta_hat);
+        for (i=0; i<len; i++)
+            buf[i] = _x[n0+i] * r;
+        theta_hat += MODEM(_estimate_phase_window)(_q, buf, len, power, sym, ref);
+        theta[w] = theta_hat;
+    }
+
+    // interpolate linearly between window centres (holding the end
+    // values beyond the first and last centres) and de-rotate
+    w = 0;
+    T c0 = 0.5f*(T)(W-1);   // centre of window w
+    for (i=0; i<_n; ) {
+        // segment [i, i_end) with constant phase increment
+        T theta0, dtheta;
+        unsigned int i_end;
+        if (i < c0 || w+1 == num_windows) {
+            theta0 = theta[w];
+            dtheta = 0;
+            i_end  = w+1 == num_windows ? _n : (unsigned int)ceilf(c0);
+            if (i_end <= i) i_end = i+1;
+        } else {
+            // centre of next window (last window may be short)
+            unsigned int n1 = (w+1)*W;
+            T c1 = (T)n1 + 0.5f*(T)((n1 + W <= _n ? W : _n - n1) - 1);
+            dtheta = (theta[w+1] - theta[w]) / (c1 - c0);
+            theta0 = theta[w] + dtheta*((T)i - c0);
+            i_end  = (unsigned int)ceilf(c1);
+            if (i_end > _n) i_end = _n;
+            w++;
+            c0 = c1;
+        }
+
+        TC r    = cexpf(-_Complex_I*theta0);
+        TC step = cexpf(-_Complex_I*dtheta);
+        for ( ; i<i_end; i++) {
+            _x[i] *= r;
+            r *= step;
+        }
+    }
+}
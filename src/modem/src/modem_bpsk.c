@@ -35,7 +35,7 @@
 // create a bpsk (binary phase-shift keying) modem object
 MODEM() MODEM(_create_bpsk)()
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     q->scheme = LIQUID_MODEM_BPSK;
 
     MODEM(_init)(q, 1);
@@ -70,6 +70,13 @@ void MODEM(_demodulate_bpsk)(MODEM()        _q,
     _q->r = _x;
 }
 
+// get soft-demodulation gamma for BPSK; with noise variance N0 the
+// log-likelihood ratio -2 x gamma is exact for gamma = 2/N0
+T MODEM(_get_soft_gamma_bpsk)(MODEM() _q)
+{
+    return _q->soft_gamma > 0 ? 2.0f*_q->soft_gamma : 4.0f;
+}
+
 // demodulate BPSK (soft)
 void MODEM(_demodulate_soft_bpsk)(MODEM()         _q,
                                   TC              _x,
@@ -77,7 +84,8 @@ void MODEM(_demodulate_soft_bpsk)(MODEM()         _q,
                                   unsigned char * _soft_bits)
 {
     // gamma = 1/(2*sigma^2), approximate for constellation size
-    T gamma = 4.0f;
+    // unless noise variance has been set
+    T gamma = MODEM(_get_soft_gamma_bpsk)(_q);
 
     // approximate log-likelihood ratio
     T LLR = -2.0f * crealf(_x) * gamma;
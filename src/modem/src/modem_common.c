@@ -32,6 +32,9 @@
 
 #define DEBUG_DEMODULATE_SOFT 0
 
+// number of replaced modems kept by MODEM(_recreate)()
+#define MODEM_CACHE_LEN (3)
+
 // modem structure used for both modulation and demodulation 
 //
 // The modem structure implements a variety of common modulation schemes,
@@ -102,6 +105,13 @@ struct MODEM(_s)
             T r_slicer[8];              // slicer radii of levels
             T phi[8];                   // phase offset of levels
             unsigned char * map;        // symbol mapping (allocated)
+
+            // demodulation tables
+            T r2_slicer[8];             // squared slicer radii of levels
+            T alpha[8];                 // points per radian of levels
+            T beta[8];                  // phase offset of levels [points]
+            unsigned int offset[8];     // index of first point of levels
+            unsigned char * demap;      // inverse symbol mapping (allocated)
         } apsk;
 
         // 'square' 32-QAM
@@ -113,6 +123,19 @@ struct MODEM(_s)
         struct {
             TC * map;           // 32-sample sub-map (first quadrant)
         } sqam128;
+
+        // arbitrary modem: uniform grid of nearest-point candidates
+        struct {
+            unsigned int n;             // grid dimension (n x n cells)
+            T x0;                       // grid origin, in-phase
+            T y0;                       // grid origin, quadrature
+            T inv_dx;                   // inverse cell width, in-phase
+            T inv_dy;                   // inverse cell width, quadrature
+            unsigned int *  offset;     // candidate list offsets [n*n+1]
+            unsigned char * sym;        // candidate symbols (ascending)
+            T * cand_i;                 // candidate points, in-phase
+            T * cand_q;                 // candidate points, quadrature
+        } arb;
     } data;
 
     // modulate function pointer
@@ -130,6 +153,16 @@ struct MODEM(_s)
     // neighbors array
     unsigned char * demod_soft_neighbors;   // array of nearest neighbors
     unsigned int demod_soft_p;              // number of neighbors in array
+    T soft_gamma;                           // 1/(noise variance), 0 if not set
+    unsigned int soft_precision;            // soft bit precision (4 to 8 bits)
+
+    // symbol map, soft-demodulation neighbors and arbitrary-modem grid
+    // are owned by the process-wide table cache (see MODEM(_tables_acquire)())
+    int shared_tables;
+
+    // modems previously replaced by MODEM(_recreate)(), most recently
+    // used first; kept so that switching back does not allocate
+    MODEM() cache[MODEM_CACHE_LEN];
 };
 
 // create digital modem of a specific scheme and bits/symbol
@@ -215,43 +248,88 @@ MODEM() MODEM(_create)(modulation_scheme _scheme)
     return NULL;
 }
 
-// recreate modulation scheme, re-allocating memory as necessary
+// recreate modulation scheme, re-allocating memory as necessary; the
+// replaced modem is kept in a small cache handed on to the returned
+// object, and a cached modem of the requested scheme is reused (reset)
+// rather than created
 MODEM() MODEM(_recreate)(MODEM() _q,
                          modulation_scheme _scheme)
 {
-    // TODO : regenerate modem only when truly necessary
-    if (_q->scheme != _scheme) {
-        // destroy and re-create modem
-        MODEM(_destroy)(_q);
-        _q = MODEM(_create)(_scheme);
+    if (_q->scheme == _scheme)
+        return _q;
+
+    // take over cache from replaced object
+    MODEM() c[MODEM_CACHE_LEN];
+    memmove(c, _q->cache, sizeof(c));
+    memset(_q->cache, 0x00, sizeof(_q->cache));
+
+    // find modem of requested scheme (arbitrary constellations are
+    // never reused)
+    MODEM() q = NULL;
+    unsigned int i;
+    for (i=0; i<MODEM_CACHE_LEN && _scheme != LIQUID_MODEM_ARB; i++) {
+        if (c[i] != NULL && c[i]->scheme == _scheme) {
+            q = c[i];
+            c[i] = NULL;
+            MODEM(_reset)(q);
+            break;
+        }
+    }
+    if (q == NULL) {
+        q = MODEM(_create)(_scheme);
+        if (c[MODEM_CACHE_LEN-1] != NULL) {
+            MODEM(_destroy)(c[MODEM_CACHE_LEN-1]);
+            c[MODEM_CACHE_LEN-1] = NULL;
+        }
     }
 
-    // return object
-    return _q;
+    // replaced modem becomes most recently used
+    unsigned int n = 0;
+    if (_q->scheme == LIQUID_MODEM_ARB)
+        MODEM(_destroy)(_q);
+    else
+        q->cache[n++] = _q;
+    for (i=0; i<MODEM_CACHE_LEN; i++) {
+        if (c[i] != NULL)
+            q->cache[n++] = c[i];
+    }
+    return q;
 }
 
 // destroy a modem object
 void MODEM(_destroy)(MODEM() _q)
 {
-    // free symbol map
-    if (_q->symbol_map != NULL)
-        free(_q->symbol_map);
+    // destroy cached modems
+    unsigned int i;
+    for (i=0; i<MODEM_CACHE_LEN; i++) {
+        if (_q->cache[i] != NULL)
+            MODEM(_destroy)(_q->cache[i]);
+    }
 
-    // free soft-demodulation neighbors table
-    if (_q->demod_soft_neighbors != NULL)
-        free(_q->demod_soft_neighbors);
+    // free symbol map and soft-demodulation neighbors table unless
+    // they belong to the table cache
+    if (!_q->shared_tables) {
+        liquid_free(_q->symbol_map);
+        liquid_free(_q->demod_soft_neighbors);
+    }
 
     // free memory in specific data types
     if (_q->scheme == LIQUID_MODEM_SQAM32) {
-        free(_q->data.sqam32.map);
+        liquid_free(_q->data.sqam32.map);
     } else if (_q->scheme == LIQUID_MODEM_SQAM128) {
-        free(_q->data.sqam128.map);
+        liquid_free(_q->data.sqam128.map);
     } else if (liquid_modem_is_apsk(_q->scheme)) {
-        free(_q->data.apsk.map);
+        liquid_free(_q->data.apsk.map);
+        liquid_free(_q->data.apsk.demap);
+    } else if (_q->scheme == LIQUID_MODEM_ARB && !_q->shared_tables) {
+        liquid_free(_q->data.arb.offset);
+        liquid_free(_q->data.arb.sym);
+        liquid_free(_q->data.arb.cand_i);
+        liquid_free(_q->data.arb.cand_q);
     }
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print a modem object
@@ -262,6 +340,37 @@ void MODEM(_print)(MODEM() _q)
     printf("    bits/symbol:    %u\n", _q->m);
 }
 
+// get memory footprint of modem [bytes]; tables owned by the
+// process-wide table cache (see MODEM(_tables_acquire)()) are not
+// counted
+unsigned long int MODEM(_get_memory_usage)(MODEM() _q)
+{
+    unsigned long int n = sizeof(struct MODEM(_s));
+    if (!_q->shared_tables) {
+        if (_q->symbol_map != NULL)
+            n += _q->M*sizeof(TC);
+        if (_q->demod_soft_neighbors != NULL)
+            n += _q->M*_q->demod_soft_p*sizeof(unsigned char);
+    }
+
+    if (_q->scheme == LIQUID_MODEM_SQAM32) {
+        n += 8*sizeof(TC);
+    } else if (_q->scheme == LIQUID_MODEM_SQAM128) {
+        n += 32*sizeof(TC);
+    } else if (liquid_modem_is_apsk(_q->scheme)) {
+        n += 2*_q->M*sizeof(unsigned char);
+    } else if (_q->scheme == LIQUID_MODEM_ARB && !_q->shared_tables &&
+               _q->data.arb.offset != NULL)
+    {
+        // nearest-point candidate grid
+        unsigned int cells = _q->data.arb.n * _q->data.arb.n;
+        unsigned int num   = _q->data.arb.offset[cells];
+        n += (cells+1)*sizeof(unsigned int) +
+             num*(sizeof(unsigned char) + 2*sizeof(T));
+    }
+    return n;
+}
+
 // reset a modem object (only an issue with dpsk)
 void MODEM(_reset)(MODEM() _q)
 {
@@ -299,6 +408,10 @@ void MODEM(_init)(MODEM() _q,
     // soft demodulation
     _q->demod_soft_neighbors = NULL;
     _q->demod_soft_p = 0;
+    _q->soft_gamma = 0.0f;
+    _q->soft_precision = 8;
+
+    _q->shared_tables = 0;
 }
 
 // initialize symbol map for fast modulation
@@ -321,10 +434,160 @@ void MODEM(_init_map)(MODEM() _q)
         _q->modulate_func(_q, i, &_q->symbol_map[i]);
 }
 
+//
+// table cache
+//
+// Symbol maps, soft-demodulation neighbor tables and the nearest-point
+// grid of the built-in arbitrary constellations depend only on the
+// modulation scheme, but are expensive to generate (e.g. the neighbor
+// search is O(M^2) for APSK). The first modem of each scheme generates
+// them as usual and hands them to this cache; later modems of the same
+// scheme reference the cached copy, read-only. Entries are never freed.
+//
+
+struct MODEM(_tables_s) {
+    TC *            symbol_map;             // symbol map [size: M x 1]
+    unsigned char * demod_soft_neighbors;   // neighbors [size: M x p]
+    unsigned int    demod_soft_p;           // number of neighbors
+    int             has_arb;                // arbitrary-modem grid present?
+    unsigned int    arb_n;                  // grid dimension
+    T               arb_x0;                 // grid origin, in-phase
+    T               arb_y0;                 // grid origin, quadrature
+    T               arb_inv_dx;             // inverse cell width, in-phase
+    T               arb_inv_dy;             // inverse cell width, quadrature
+    unsigned int *  arb_offset;             // candidate list offsets
+    unsigned char * arb_sym;                // candidate symbols
+    T *             arb_cand_i;             // candidate points, in-phase
+    T *             arb_cand_q;             // candidate points, quadrature
+};
+
+static struct MODEM(_tables_s) * MODEM(_tables_cache)[LIQUID_MODEM_NUM_SCHEMES];
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+static pthread_mutex_t MODEM(_tables_mutex) = PTHREAD_MUTEX_INITIALIZER;
+#define LIQUID_MODEM_TABLES_LOCK()   pthread_mutex_lock(&MODEM(_tables_mutex))
+#define LIQUID_MODEM_TABLES_UNLOCK() pthread_mutex_unlock(&MODEM(_tables_mutex))
+#else
+#define LIQUID_MODEM_TABLES_LOCK()
+#define LIQUID_MODEM_TABLES_UNLOCK()
+#endif
+
+// point modem at cached tables; cache must be locked
+static void MODEM(_tables_attach)(MODEM()                   _q,
+                                  struct MODEM(_tables_s) * _t)
+{
+    _q->symbol_map           = _t->symbol_map;
+    _q->demod_soft_neighbors = _t->demod_soft_neighbors;
+    _q->demod_soft_p         = _t->demod_soft_p;
+    if (_t->has_arb) {
+        _q->data.arb.n      = _t->arb_n;
+        _q->data.arb.x0     = _t->arb_x0;
+        _q->data.arb.y0     = _t->arb_y0;
+        _q->data.arb.inv_dx = _t->arb_inv_dx;
+        _q->data.arb.inv_dy = _t->arb_inv_dy;
+        _q->data.arb.offset = _t->arb_offset;
+        _q->data.arb.sym    = _t->arb_sym;
+        _q->data.arb.cand_i = _t->arb_cand_i;
+        _q->data.arb.cand_q = _t->arb_cand_q;
+    }
+    _q->shared_tables = 1;
+}
+
+// attach cached tables for scheme _ms to a newly-created modem,
+// releasing any it has allocated; returns 1 on hit, 0 if the tables
+// need to be generated (and then given to MODEM(_tables_publish)())
+int MODEM(_tables_acquire)(MODEM()           _q,
+                           modulation_scheme _ms)
+{
+    LIQUID_MODEM_TABLES_LOCK();
+    struct MODEM(_tables_s) * t = MODEM(_tables_cache)[_ms];
+    if (t != NULL) {
+        liquid_free(_q->symbol_map);
+        if (t->has_arb) {
+            liquid_free(_q->data.arb.offset);
+            liquid_free(_q->data.arb.sym);
+            liquid_free(_q->data.arb.cand_i);
+            liquid_free(_q->data.arb.cand_q);
+        }
+        MODEM(_tables_attach)(_q, t);
+    }
+    LIQUID_MODEM_TABLES_UNLOCK();
+    return t != NULL;
+}
+
+// hand the tables of a newly-created modem of scheme _ms to the cache;
+// if another modem published first, its tables are used instead
+void MODEM(_tables_publish)(MODEM()           _q,
+                            modulation_scheme _ms)
+{
+    LIQUID_MODEM_TABLES_LOCK();
+    if (MODEM(_tables_cache)[_ms] == NULL) {
+        struct MODEM(_tables_s) * t = (struct MODEM(_tables_s) *) liquid_malloc(sizeof(struct MODEM(_tables_s)));
+        t->symbol_map           = _q->symbol_map;
+        t->demod_soft_neighbors = _q->demod_soft_neighbors;
+        t->demod_soft_p         = _q->demod_soft_p;
+        t->has_arb              = _q->scheme == LIQUID_MODEM_ARB;
+        if (t->has_arb) {
+            t->arb_n      = _q->data.arb.n;
+            t->arb_x0     = _q->data.arb.x0;
+            t->arb_y0     = _q->data.arb.y0;
+            t->arb_inv_dx = _q->data.arb.inv_dx;
+            t->arb_inv_dy = _q->data.arb.inv_dy;
+            t->arb_offset = _q->data.arb.offset;
+            t->arb_sym    = _q->data.arb.sym;
+            t->arb_cand_i = _q->data.arb.cand_i;
+            t->arb_cand_q = _q->data.arb.cand_q;
+        }
+        MODEM(_tables_cache)[_ms] = t;
+        _q->shared_tables = 1;
+    } else {
+        // lost the race: release private tables and attach
+        struct MODEM(_tables_s) * t = MODEM(_tables_cache)[_ms];
+        liquid_free(_q->symbol_map);
+        liquid_free(_q->demod_soft_neighbors);
+        if (t->has_arb) {
+            liquid_free(_q->data.arb.offset);
+            liquid_free(_q->data.arb.sym);
+            liquid_free(_q->data.arb.cand_i);
+            liquid_free(_q->data.arb.cand_q);
+        }
+        MODEM(_tables_attach)(_q, t);
+    }
+    LIQUID_MODEM_TABLES_UNLOCK();
+}
+
+// give modem private copies of its tables before they are modified
+void MODEM(_tables_unshare)(MODEM() _q)
+{
+    if (!_q->shared_tables)
+        return;
+
+    TC * symbol_map = (TC*) liquid_malloc(_q->M*sizeof(TC));
+    memmove(symbol_map, _q->symbol_map, _q->M*sizeof(TC));
+    _q->symbol_map = symbol_map;
+
+    if (_q->demod_soft_neighbors != NULL) {
+        unsigned int n = _q->M*_q->demod_soft_p;
+        unsigned char * neighbors = (unsigned char*) liquid_malloc(n*sizeof(unsigned char));
+        memmove(neighbors, _q->demod_soft_neighbors, n*sizeof(unsigned char));
+        _q->demod_soft_neighbors = neighbors;
+    }
+
+    // grid is rebuilt by the caller
+    if (_q->scheme == LIQUID_MODEM_ARB) {
+        _q->data.arb.offset = NULL;
+        _q->data.arb.sym    = NULL;
+        _q->data.arb.cand_i = NULL;
+        _q->data.arb.cand_q = NULL;
+    }
+    _q->shared_tables = 0;
+}
+
 // Generate random symbol
 unsigned int MODEM(_gen_rand_sym)(MODEM() _q)
 {
-    return rand() % (_q->M);
+    return (unsigned int)(randu64_r(liquid_rand_state()) % _q->M);
 }
 
 // Get modem depth (bits/symbol)
@@ -339,6 +602,30 @@ modulation_scheme MODEM(_get_scheme)(MODEM() _q)
     return _q->scheme;
 }
 
+// set noise variance of received samples, E{|n|^2}, so that soft bits
+// are scaled log-likelihood ratios; setting zero restores the fixed
+// approximation for each constellation
+void MODEM(_set_noise_variance)(MODEM() _q,
+                                T       _sigma2)
+{
+    if (_sigma2 < 0.0f) {
+        fprintf(stderr,"error: modem_set_noise_variance(), noise variance must be non-negative\n");
+        exit(1);
+    }
+    _q->soft_gamma = _sigma2 > 0.0f ? 1.0f / _sigma2 : 0.0f;
+}
+
+// set soft bit precision
+void MODEM(_set_soft_precision)(MODEM()      _q,
+                                unsigned int _nbits)
+{
+    if (_nbits < 4 || _nbits > 8) {
+        fprintf(stderr,"error: modem_set_soft_precision(), precision must be in [4,8] bits\n");
+        exit(1);
+    }
+    _q->soft_precision = _nbits;
+}
+
 // generic modulatio function
 //  _q          :   modem object
 //  _symbol_in  :   input symbol
@@ -394,31 +681,35 @@ void MODEM(_demodulate_soft)(MODEM() _q,
                              unsigned int  * _s,
                              unsigned char * _soft_bits)
 {
-    // switch scheme
-    switch (_q->scheme) {
-    case LIQUID_MODEM_ARB:  MODEM(_demodulate_soft_arb)( _q,_x,_s,_soft_bits); return;
-    case LIQUID_MODEM_BPSK: MODEM(_demodulate_soft_bpsk)(_q,_x,_s,_soft_bits); return;
-    case LIQUID_MODEM_QPSK: MODEM(_demodulate_soft_qpsk)(_q,_x,_s,_soft_bits); return;
-    default:;
-    }
-
-    // check if...
-    if (_q->demod_soft_neighbors != NULL && _q->demod_soft_p != 0) {
+    if (_q->scheme == LIQUID_MODEM_ARB) {
+        MODEM(_demodulate_soft_arb)(_q, _x, _s, _soft_bits);
+    } else if (_q->scheme == LIQUID_MODEM_BPSK) {
+        MODEM(_demodulate_soft_bpsk)(_q, _x, _s, _soft_bits);
+    } else if (_q->scheme == LIQUID_MODEM_QPSK) {
+        MODEM(_demodulate_soft_qpsk)(_q, _x, _s, _soft_bits);
+    } else if (liquid_modem_is_qam(_q->scheme)) {
+        // Gray-coded rectangular constellations have closed-form metrics
+        MODEM(_demodulate_soft_qam)(_q, _x, _s, _soft_bits);
+    } else if (liquid_modem_is_ask(_q->scheme)) {
+        MODEM(_demodulate_soft_ask)(_q, _x, _s, _soft_bits);
+    } else if (_q->demod_soft_neighbors != NULL && _q->demod_soft_p != 0) {
         // demodulate using approximate log-likelihood method with
         // look-up table for nearest neighbors
         MODEM(_demodulate_soft_table)(_q, _x, _s, _soft_bits);
-
-        return;
+    } else {
+        // for now demodulate normally and simply copy the
+        // hard-demodulated bits
+        unsigned int symbol_out;
+        _q->demodulate_func(_q, _x, &symbol_out);
+        *_s = symbol_out;
+
+        // unpack soft bits
+        liquid_unpack_soft_bits(symbol_out, _q->m, _soft_bits);
     }
 
-    // for now demodulate normally and simply copy the
-    // hard-demodulated bits
-    unsigned int symbol_out;
-    _q->demodulate_func(_q, _x, &symbol_out);
-    *_s = symbol_out;
-
-    // unpack soft bits
-    liquid_unpack_soft_bits(symbol_out, _q->m, _soft_bits);
+    // reduce soft bit precision
+    if (_q->soft_precision < 8)
+        MODEM(_quantize_soft_bits)(_q, _soft_bits, _q->m);
 }
 
 #if DEBUG_DEMODULATE_SOFT
@@ -450,7 +741,8 @@ void MODEM(_demodulate_soft_table)(MODEM() _q,
     unsigned int bps = MODEM(_get_bps)(_q);
 
     // gamma = 1/(2*sigma^2), approximate for constellation size
-    T gamma = 1.2f*_q->M;
+    // unless noise variance has been set
+    T gamma = _q->soft_gamma > 0 ? _q->soft_gamma : 1.2f*_q->M;
 
     // set and initialize minimum bit values
     unsigned int i;
@@ -516,6 +808,22 @@ void MODEM(_demodulate_soft_table)(MODEM() _q,
 
 
 
+// quantize soft bits to object's precision; the retained bits are
+// replicated into the low-order bits so that levels stay symmetric
+// about LIQUID_SOFTBIT_ERASURE and span the full 8-bit range
+void MODEM(_quantize_soft_bits)(MODEM()         _q,
+                                unsigned char * _soft_bits,
+                                unsigned int    _n)
+{
+    unsigned int shift = 8 - _q->soft_precision;
+    unsigned int fill  = _q->soft_precision - shift;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        unsigned int b = _soft_bits[i] >> shift;
+        _soft_bits[i] = (unsigned char)((b << shift) | (b >> fill));
+    }
+}
+
 // get demodulator's estimated transmit sample
 void MODEM(_get_demodulator_sample)(MODEM() _q,
                                     TC * _x_hat)
@@ -601,6 +909,69 @@ void MODEM(_demodulate_linear_array_ref)(T              _v,
     *_res = _v;
 }
 
+// Soft demodulation of a Gray-coded linear (PAM) axis, exact max-log
+//  _v          :   input value
+//  _m          :   bits per symbol on this axis
+//  _alpha      :   scaling factor, levels at (2j - 2^_m + 1)*_alpha
+//  _gamma      :   log-likelihood scale, 1/(2*sigma^2)
+//  _s          :   demodulated symbol (Gray-coded)
+//  _v_hat      :   demodulated level
+//  _soft_bits  :   soft bits, most-significant first [size: _m x 1]
+//
+// Gray labels are constant on runs of 2^(p+1) levels for bit p, so the
+// nearest level with the opposite bit value is one of the two levels
+// bordering the run which holds the hard decision. Because QAM is the
+// product of two such axes, the per-axis metrics are also the exact
+// max-log metrics of the full constellation.
+void MODEM(_demodulate_soft_pam)(T               _v,
+                                 unsigned int    _m,
+                                 T               _alpha,
+                                 T               _gamma,
+                                 unsigned int *  _s,
+                                 T *             _v_hat,
+                                 unsigned char * _soft_bits)
+{
+    int M = 1 << _m;
+
+    // nearest level; ties resolve to the lower level as in
+    // MODEM(_demodulate_linear_array_ref)()
+    T u = 0.5f*(_v/_alpha + (T)(M-1));
+    u = u < 0.0f ? 0.0f : (u > (T)(M-1) ? (T)(M-1) : u);
+    int j = (int)ceilf(u - 0.5f);
+
+    T e = _v - (T)(2*j - M + 1)*_alpha;
+    T d_hard = e*e;
+    unsigned int s = gray_encode(j);
+
+    unsigned int k;
+    for (k=0; k<_m; k++) {
+        // run of levels with the same value of bit p as level j
+        int p     = _m - k - 1;
+        int half  = 1 << p;
+        int start = ((j + half) & ~(2*half - 1)) - half;
+
+        // bordering levels (at least one exists)
+        int lo = start - 1;
+        int hi = start + 2*half;
+        lo = lo < 0     ? hi : lo;
+        hi = hi > M - 1 ? lo : hi;
+        T e_lo = _v - (T)(2*lo - M + 1)*_alpha;
+        T e_hi = _v - (T)(2*hi - M + 1)*_alpha;
+        T d_lo = e_lo*e_lo;
+        T d_hi = e_hi*e_hi;
+        T d_other = d_lo < d_hi ? d_lo : d_hi;
+
+        // dmin_0 - dmin_1
+        T dd = ((s >> p) & 1) ? d_other - d_hard : d_hard - d_other;
+        int soft_bit = (dd*_gamma)*16 + 127;
+        soft_bit = soft_bit > 255 ? 255 : (soft_bit < 0 ? 0 : soft_bit);
+        _soft_bits[k] = (unsigned char)soft_bit;
+    }
+
+    *_s     = s;
+    *_v_hat = (T)(2*j - M + 1)*_alpha;
+}
+
 
 // generate soft demodulation look-up table
 void MODEM(_demodsoft_gentab)(MODEM()      _q,
@@ -614,7 +985,7 @@ void MODEM(_demodsoft_gentab)(MODEM()      _q,
     
     // allocate internal memory
     _q->demod_soft_p = _p;
-    _q->demod_soft_neighbors = (unsigned char*)malloc(_q->M*_p*sizeof(unsigned char));
+    _q->demod_soft_neighbors = (unsigned char*)liquid_malloc(_q->M*_p*sizeof(unsigned char));
 
     unsigned int i;
     unsigned int j;
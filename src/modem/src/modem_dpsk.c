@@ -27,7 +27,7 @@
 // create a dpsk (differential phase-shift keying) modem object
 MODEM() MODEM(_create_dpsk)(unsigned int _bits_per_symbol)
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     
     switch (_bits_per_symbol) {
     case 1: q->scheme = LIQUID_MODEM_DPSK2;   break;
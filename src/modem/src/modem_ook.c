@@ -35,7 +35,7 @@
 // create an ook (on/off keying) modem object
 MODEM() MODEM(_create_ook)()
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     q->scheme = LIQUID_MODEM_OOK;
 
     MODEM(_init)(q, 1);
@@ -27,7 +27,7 @@
 // create a psk (phase-shift keying) modem object
 MODEM() MODEM(_create_psk)(unsigned int _bits_per_symbol)
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
 
     switch (_bits_per_symbol) {
     case 1: q->scheme = LIQUID_MODEM_PSK2;   break;
@@ -61,15 +61,17 @@ MODEM() MODEM(_create_psk)(unsigned int _bits_per_symbol)
     q->modulate_func = &MODEM(_modulate_psk);
     q->demodulate_func = &MODEM(_demodulate_psk);
 
-    // initialize symbol map
-    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
-    MODEM(_init_map)(q);
+    // initialize symbol map and soft-demodulation look-up table,
+    // shared by all modems of this scheme
+    if (!MODEM(_tables_acquire)(q, q->scheme)) {
+        q->symbol_map = (TC*)liquid_malloc(q->M*sizeof(TC));
+        MODEM(_init_map)(q);
+        if (q->m >= 3)
+            MODEM(_demodsoft_gentab)(q, 2);
+        MODEM(_tables_publish)(q, q->scheme);
+    }
     q->modulate_using_map = 1;
 
-    // initialize soft-demodulation look-up table
-    if (q->m >= 3)
-        MODEM(_demodsoft_gentab)(q, 2);
-
     // reset and return
     MODEM(_reset)(q);
     return q;
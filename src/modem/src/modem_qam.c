@@ -34,7 +34,7 @@ MODEM() MODEM(_create_qam)(unsigned int _bits_per_symbol)
         exit(1);
     }
 
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
 
     MODEM(_init)(q, _bits_per_symbol);
 
@@ -85,15 +85,14 @@ MODEM() MODEM(_create_qam)(unsigned int _bits_per_symbol)
     q->modulate_func = &MODEM(_modulate_qam);
     q->demodulate_func = &MODEM(_demodulate_qam);
 
-    // initialize symbol map
-    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
-    MODEM(_init_map)(q);
+    // initialize symbol map, shared by all modems of this scheme
+    if (!MODEM(_tables_acquire)(q, q->scheme)) {
+        q->symbol_map = (TC*)liquid_malloc(q->M*sizeof(TC));
+        MODEM(_init_map)(q);
+        MODEM(_tables_publish)(q, q->scheme);
+    }
     q->modulate_using_map = 1;
 
-    // initialize soft-demodulation look-up table
-    if      (q->m == 3) MODEM(_demodsoft_gentab)(q, 3);
-    else if (q->m >= 4) MODEM(_demodsoft_gentab)(q, 4);
-
     // reset and return
     MODEM(_reset)(q);
     return q;
@@ -143,3 +142,28 @@ void MODEM(_demodulate_qam)(MODEM()      _q,
     _q->r = _x;
 }
 
+// demodulate QAM (soft)
+void MODEM(_demodulate_soft_qam)(MODEM()         _q,
+                                 TC              _x,
+                                 unsigned int  * _s,
+                                 unsigned char * _soft_bits)
+{
+    // gamma = 1/(2*sigma^2), approximate for constellation size
+    // unless noise variance has been set
+    T gamma = _q->soft_gamma > 0 ? _q->soft_gamma : 1.2f*_q->M;
+
+    // in-phase and quadrature axes are independent
+    unsigned int s_i;   // in-phase symbol
+    unsigned int s_q;   // quadrature symbol
+    T x_i;              // in-phase level
+    T x_q;              // quadrature level
+    MODEM(_demodulate_soft_pam)(crealf(_x), _q->data.qam.m_i, _q->data.qam.alpha, gamma,
+                                &s_i, &x_i, &_soft_bits[0]);
+    MODEM(_demodulate_soft_pam)(cimagf(_x), _q->data.qam.m_q, _q->data.qam.alpha, gamma,
+                                &s_q, &x_q, &_soft_bits[_q->data.qam.m_i]);
+    *_s = ( s_i << _q->data.qam.m_q ) + s_q;
+
+    // store state
+    _q->x_hat = x_i + _Complex_I*x_q;
+    _q->r = _x;
+}
@@ -35,7 +35,7 @@
 // create a qpsk (quaternary phase-shift keying) modem object
 MODEM() MODEM(_create_qpsk)()
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     q->scheme = LIQUID_MODEM_QPSK;
 
     MODEM(_init)(q, 2);
@@ -73,6 +73,13 @@ void MODEM(_demodulate_qpsk)(MODEM() _q,
     _q->r = _x;
 }
 
+// get soft-demodulation gamma for QPSK; with noise variance N0 the
+// log-likelihood ratio -2 x gamma is exact for gamma = sqrt(2)/N0
+T MODEM(_get_soft_gamma_qpsk)(MODEM() _q)
+{
+    return _q->soft_gamma > 0 ? M_SQRT2*_q->soft_gamma : 5.8f;
+}
+
 // demodulate QPSK (soft)
 void MODEM(_demodulate_soft_qpsk)(MODEM()         _q,
                                   TC              _x,
@@ -80,7 +87,8 @@ void MODEM(_demodulate_soft_qpsk)(MODEM()         _q,
                                   unsigned char * _soft_bits)
 {
     // gamma = 1/(2*sigma^2), approximate for constellation size
-    T gamma = 5.8f;
+    // unless noise variance has been set
+    T gamma = MODEM(_get_soft_gamma_qpsk)(_q);
 
     // approximate log-likelihood ratios
     T LLR;
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// modem_slicers.avx.c : block slicers for linear modems (x86 AVX2)
+//
+// Eight complex samples are de-interleaved into in-phase and quadrature
+// vectors and sliced in parallel; results are bit exact with the
+// portable slicers in modem_slicers.c. Remaining samples are handled by
+// a scalar tail. These kernels are compiled with per-function target
+// attributes and are selected at run time.
+//
+
+#include <immintrin.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// load eight complex samples as in-phase and quadrature vectors
+__attribute__((target("avx2")))
+static inline void liquid_modem_load8(const float complex * _x,
+                                      __m256 *              _re,
+                                      __m256 *              _im)
+{
+    __m256 a = _mm256_loadu_ps((const float*)(_x  ));
+    __m256 b = _mm256_loadu_ps((const float*)(_x+4));
+
+    // [a0 a2 b0 b2 | a4 a6 b4 b6] -> [0 2 4 6 8 10 12 14]
+    __m256 re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+    __m256 im = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+    *_re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re), _MM_SHUFFLE(3,1,2,0)));
+    *_im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im), _MM_SHUFFLE(3,1,2,0)));
+}
+
+// soft bit: clip((int)((-2 v gamma) 16 + 127), 0, 255)
+__attribute__((target("avx2")))
+static inline __m256i liquid_modem_soft8(__m256 _v,
+                                         __m256 _gamma)
+{
+    __m256 llr = _mm256_mul_ps(_mm256_mul_ps(_v, _mm256_set1_ps(-2.0f)), _gamma);
+    __m256 b   = _mm256_add_ps(_mm256_mul_ps(llr, _mm256_set1_ps(16.0f)), _mm256_set1_ps(127.0f));
+    __m256i s  = _mm256_cvttps_epi32(b);
+    s = _mm256_min_epi32(s, _mm256_set1_epi32(255));
+    return _mm256_max_epi32(s, _mm256_setzero_si256());
+}
+
+// BPSK
+__attribute__((target("avx2")))
+void liquid_modem_slice_bpsk_avx2(const float complex * _x,
+                                  unsigned int          _n,
+                                  float                 _gamma,
+                                  unsigned int *        _s,
+                                  unsigned char *       _soft_bits)
+{
+    __m256  zero  = _mm256_setzero_ps();
+    __m256i one   = _mm256_set1_epi32(1);
+    __m256  gamma = _mm256_set1_ps(_gamma);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 re, im;
+        liquid_modem_load8(_x+i, &re, &im);
+        __m256i gt = _mm256_castps_si256(_mm256_cmp_ps(re, zero, _CMP_GT_OQ));
+        _mm256_storeu_si256((__m256i*)(_s+i), _mm256_andnot_si256(gt, one));
+
+        if (_soft_bits != NULL) {
+            __m256i b = liquid_modem_soft8(re, gamma);
+            b = _mm256_packus_epi32(b, b);  // [b0..b3 x2 | b4..b7 x2]
+            b = _mm256_packus_epi16(b, b);  // [b0..b3 x4 | b4..b7 x4]
+            int lo = _mm256_extract_epi32(b, 0);
+            int hi = _mm256_extract_epi32(b, 4);
+            memcpy(_soft_bits+i,   &lo, 4);
+            memcpy(_soft_bits+i+4, &hi, 4);
+        }
+    }
+    if (i < _n)
+        liquid_modem_slice_bpsk(_x+i, _n-i, _gamma, _s+i, _soft_bits ? _soft_bits+i : NULL);
+}
+
+// QPSK
+__attribute__((target("avx2")))
+void liquid_modem_slice_qpsk_avx2(const float complex * _x,
+                                  unsigned int          _n,
+                                  float                 _gamma,
+                                  unsigned int *        _s,
+                                  unsigned char *       _soft_bits)
+{
+    __m256  zero  = _mm256_setzero_ps();
+    __m256i one   = _mm256_set1_epi32(1);
+    __m256i two   = _mm256_set1_epi32(2);
+    __m256  gamma = _mm256_set1_ps(_gamma);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 re, im;
+        liquid_modem_load8(_x+i, &re, &im);
+        __m256i gi = _mm256_castps_si256(_mm256_cmp_ps(re, zero, _CMP_GT_OQ));
+        __m256i gq = _mm256_castps_si256(_mm256_cmp_ps(im, zero, _CMP_GT_OQ));
+        __m256i s  = _mm256_or_si256(_mm256_andnot_si256(gi, one),
+                                     _mm256_andnot_si256(gq, two));
+        _mm256_storeu_si256((__m256i*)(_s+i), s);
+
+        if (_soft_bits != NULL) {
+            // first bit from quadrature, second from in-phase component
+            __m256i bq = liquid_modem_soft8(im, gamma);
+            __m256i bi = liquid_modem_soft8(re, gamma);
+            __m256i lo = _mm256_unpacklo_epi32(bq, bi); // q0 i0 q1 i1 | q4 i4 q5 i5
+            __m256i hi = _mm256_unpackhi_epi32(bq, bi); // q2 i2 q3 i3 | q6 i6 q7 i7
+            __m256i b  = _mm256_packus_epi32(lo, hi);   // pairs 0..3  | pairs 4..7
+            b = _mm256_packus_epi16(b, b);
+            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(3,1,2,0));
+            _mm_storeu_si128((__m128i*)(_soft_bits+2*i), _mm256_castsi256_si128(b));
+        }
+    }
+    if (i < _n)
+        liquid_modem_slice_qpsk(_x+i, _n-i, _gamma, _s+i, _soft_bits ? _soft_bits+2*i : NULL);
+}
+
+// slice one rectangular dimension on linearly-spaced array, returning
+// gray-encoded symbols
+__attribute__((target("avx2")))
+static inline __m256i liquid_modem_slice_linear8(__m256        _v,
+                                                 unsigned int  _m,
+                                                 const float * _ref)
+{
+    __m256  zero = _mm256_setzero_ps();
+    __m256  sign = _mm256_set1_ps(-0.0f);
+    __m256i one  = _mm256_set1_epi32(1);
+    __m256i s    = _mm256_setzero_si256();
+    unsigned int k;
+    for (k=0; k<_m; k++) {
+        __m256 gt = _mm256_cmp_ps(_v, zero, _CMP_GT_OQ);
+        s = _mm256_or_si256(_mm256_slli_epi32(s, 1),
+                            _mm256_and_si256(_mm256_castps_si256(gt), one));
+
+        // v > 0 ? v - ref : v + ref
+        __m256 r = _mm256_set1_ps(_ref[_m-k-1]);
+        _v = _mm256_add_ps(_v, _mm256_xor_ps(r, _mm256_and_ps(gt, sign)));
+    }
+    return _mm256_xor_si256(s, _mm256_srli_epi32(s, 1));
+}
+
+// rectangular QAM
+__attribute__((target("avx2")))
+void liquid_modem_slice_qam_avx2(const float complex * _x,
+                                 unsigned int          _n,
+                                 unsigned int          _m_i,
+                                 unsigned int          _m_q,
+                                 const float *         _ref,
+                                 unsigned int *        _s)
+{
+    __m128i shift = _mm_cvtsi32_si128(_m_q);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 re, im;
+        liquid_modem_load8(_x+i, &re, &im);
+        __m256i si = liquid_modem_slice_linear8(re, _m_i, _ref);
+        __m256i sq = liquid_modem_slice_linear8(im, _m_q, _ref);
+        _mm256_storeu_si256((__m256i*)(_s+i),
+                            _mm256_add_epi32(_mm256_sll_epi32(si, shift), sq));
+    }
+    if (i < _n)
+        liquid_modem_slice_qam(_x+i, _n-i, _m_i, _m_q, _ref, _s+i);
+}
+
+
+// one axis of square QAM with a fixed number of bits _m (see
+// liquid_modem_soft_pam() in modem_slicers.c); writes the soft bits
+// for bit k of each lane to _b[k] and returns gray-encoded symbols
+__attribute__((target("avx2"), always_inline))
+static inline __m256i liquid_modem_soft_pam8(__m256    _v,
+                                             const int _m,
+                                             __m256    _alpha,
+                                             __m256    _gamma,
+                                             __m256i * _b)
+{
+    const int M = 1 << _m;
+    __m256 d[8];
+    int l, k;
+#pragma GCC unroll 8
+    for (l=0; l<M; l++) {
+        __m256 e = _mm256_sub_ps(_v, _mm256_mul_ps(_mm256_set1_ps((float)(2*l - M + 1)), _alpha));
+        d[l] = _mm256_mul_ps(e, e);
+    }
+
+    // nearest level, ties to the lower level
+    __m256  dmin = d[0];
+    __m256i j    = _mm256_setzero_si256();
+#pragma GCC unroll 8
+    for (l=1; l<M; l++) {
+        __m256 lt = _mm256_cmp_ps(d[l], dmin, _CMP_LT_OQ);
+        dmin = _mm256_blendv_ps(dmin, d[l], lt);
+        j    = _mm256_blendv_epi8(j, _mm256_set1_epi32(l), _mm256_castps_si256(lt));
+    }
+
+#pragma GCC unroll 4
+    for (k=0; k<_m; k++) {
+        int    p  = _m - k - 1;
+        __m256 d0 = _mm256_set1_ps(INFINITY);
+        __m256 d1 = _mm256_set1_ps(INFINITY);
+#pragma GCC unroll 8
+        for (l=0; l<M; l++) {
+            if (((l ^ (l >> 1)) >> p) & 1) d1 = _mm256_min_ps(d[l], d1);
+            else                           d0 = _mm256_min_ps(d[l], d0);
+        }
+        __m256  b = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(d0, d1), _gamma),
+                                                _mm256_set1_ps(16.0f)),
+                                  _mm256_set1_ps(127.0f));
+        __m256i s = _mm256_cvttps_epi32(b);
+        s = _mm256_min_epi32(s, _mm256_set1_epi32(255));
+        _b[k] = _mm256_max_epi32(s, _mm256_setzero_si256());
+    }
+    return _mm256_xor_si256(j, _mm256_srli_epi32(j, 1));
+}
+
+// square QAM soft with _m bits per axis
+__attribute__((target("avx2"), always_inline))
+static inline void liquid_modem_slice_qam_soft_avx2(const float complex * _x,
+                                                    unsigned int          _n,
+                                                    const int             _m,
+                                                    float                 _alpha,
+                                                    float                 _gamma,
+                                                    unsigned int *        _s,
+                                                    unsigned char *       _soft_bits)
+{
+    __m256 alpha = _mm256_set1_ps(_alpha);
+    __m256 gamma = _mm256_set1_ps(_gamma);
+    unsigned int i, l;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 re, im;
+        liquid_modem_load8(_x+i, &re, &im);
+        __m256i b[6];
+        __m256i si = liquid_modem_soft_pam8(re, _m, alpha, gamma, &b[0]);
+        __m256i sq = liquid_modem_soft_pam8(im, _m, alpha, gamma, &b[_m]);
+        _mm256_storeu_si256((__m256i*)(_s+i),
+                            _mm256_add_epi32(_mm256_slli_epi32(si, _m), sq));
+
+        // interleave soft bits by sample: pack the first four bits of each
+        // sample into one 32-bit lane, and the remaining two (64-QAM) into
+        // the low half of a second lane
+        __m256i lo = _mm256_or_si256(
+                        _mm256_or_si256(b[0], _mm256_slli_epi32(b[1], 8)),
+                        _mm256_or_si256(_mm256_slli_epi32(b[2],16), _mm256_slli_epi32(b[3],24)));
+        unsigned char * soft = _soft_bits + 2*_m*i;
+        if (_m == 2) {
+            _mm256_storeu_si256((__m256i*)soft, lo);
+        } else {
+            __m256i hi = _mm256_or_si256(b[4], _mm256_slli_epi32(b[5], 8));
+            uint64_t buf[8] __attribute__((aligned(32)));
+            _mm256_store_si256((__m256i*)(buf+0), _mm256_permute2x128_si256(
+                _mm256_unpacklo_epi32(lo,hi), _mm256_unpackhi_epi32(lo,hi), 0x20));
+            _mm256_store_si256((__m256i*)(buf+4), _mm256_permute2x128_si256(
+                _mm256_unpacklo_epi32(lo,hi), _mm256_unpackhi_epi32(lo,hi), 0x31));
+            for (l=0; l<8; l++)
+                memcpy(soft + 6*l, &buf[l], 6);
+        }
+    }
+    if (i < _n) {
+        if (_m == 2) liquid_modem_slice_qam16_soft(_x+i, _n-i, _alpha, _gamma, _s+i, _soft_bits+4*i);
+        else         liquid_modem_slice_qam64_soft(_x+i, _n-i, _alpha, _gamma, _s+i, _soft_bits+6*i);
+    }
+}
+
+// 16-QAM soft
+__attribute__((target("avx2")))
+void liquid_modem_slice_qam16_soft_avx2(const float complex * _x,
+                                        unsigned int          _n,
+                                        float                 _alpha,
+                                        float                 _gamma,
+                                        unsigned int *        _s,
+                                        unsigned char *       _soft_bits)
+{
+    liquid_modem_slice_qam_soft_avx2(_x, _n, 2, _alpha, _gamma, _s, _soft_bits);
+}
+
+// 64-QAM soft
+__attribute__((target("avx2")))
+void liquid_modem_slice_qam64_soft_avx2(const float complex * _x,
+                                        unsigned int          _n,
+                                        float                 _alpha,
+                                        float                 _gamma,
+                                        unsigned int *        _s,
+                                        unsigned char *       _soft_bits)
+{
+    liquid_modem_slice_qam_soft_avx2(_x, _n, 3, _alpha, _gamma, _s, _soft_bits);
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// modem_slicers.c : block slicers for linear modems (portable C)
+//
+// Each slicer reproduces the per-sample arithmetic of the corresponding
+// modem demodulator exactly; the block methods in modem_block.c select
+// these or the SIMD versions once per block.
+//
+
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// specialized slicers rely on inlining with constant constellation size
+#if defined(__GNUC__)
+#   define LIQUID_MODEM_SLICER_INLINE static inline __attribute__((always_inline))
+#else
+#   define LIQUID_MODEM_SLICER_INLINE static inline
+#endif
+
+// soft bit: clip((int)((-2 v gamma) 16 + 127), 0, 255)
+static unsigned char liquid_modem_soft_bit(float _v,
+                                           float _gamma)
+{
+    float LLR = -2.0f * _v * _gamma;
+    int soft_bit = LLR*16 + 127;
+    if (soft_bit > 255) soft_bit = 255;
+    if (soft_bit <   0) soft_bit = 0;
+    return (unsigned char) soft_bit;
+}
+
+// BPSK (see liquid.internal.h)
+void liquid_modem_slice_bpsk(const float complex * _x,
+                             unsigned int          _n,
+                             float                 _gamma,
+                             unsigned int *        _s,
+                             unsigned char *       _soft_bits)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _s[i] = crealf(_x[i]) > 0 ? 0 : 1;
+
+    if (_soft_bits != NULL) {
+        for (i=0; i<_n; i++)
+            _soft_bits[i] = liquid_modem_soft_bit(crealf(_x[i]), _gamma);
+    }
+}
+
+// QPSK (see liquid.internal.h)
+void liquid_modem_slice_qpsk(const float complex * _x,
+                             unsigned int          _n,
+                             float                 _gamma,
+                             unsigned int *        _s,
+                             unsigned char *       _soft_bits)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _s[i] = (crealf(_x[i]) > 0 ? 0 : 1) + (cimagf(_x[i]) > 0 ? 0 : 2);
+
+    if (_soft_bits != NULL) {
+        for (i=0; i<_n; i++) {
+            _soft_bits[2*i+0] = liquid_modem_soft_bit(cimagf(_x[i]), _gamma);
+            _soft_bits[2*i+1] = liquid_modem_soft_bit(crealf(_x[i]), _gamma);
+        }
+    }
+}
+
+// slice one rectangular dimension on linearly-spaced array, returning
+// gray-encoded symbol
+static unsigned int liquid_modem_slice_linear(float         _v,
+                                              unsigned int  _m,
+                                              const float * _ref)
+{
+    unsigned int s = 0;
+    unsigned int k;
+    for (k=0; k<_m; k++) {
+        s <<= 1;
+        if (_v > 0) {
+            s |= 1;
+            _v -= _ref[_m-k-1];
+        } else {
+            _v += _ref[_m-k-1];
+        }
+    }
+    return gray_encode(s);
+}
+
+// rectangular QAM (see liquid.internal.h)
+void liquid_modem_slice_qam(const float complex * _x,
+                            unsigned int          _n,
+                            unsigned int          _m_i,
+                            unsigned int          _m_q,
+                            const float *         _ref,
+                            unsigned int *        _s)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        unsigned int s_i = liquid_modem_slice_linear(crealf(_x[i]), _m_i, _ref);
+        unsigned int s_q = liquid_modem_slice_linear(cimagf(_x[i]), _m_q, _ref);
+        _s[i] = (s_i << _m_q) + s_q;
+    }
+}
+
+// soft bit from max-log metric dmin_0 - dmin_1:
+// clip((int)(dd gamma 16 + 127), 0, 255)
+LIQUID_MODEM_SLICER_INLINE unsigned char liquid_modem_soft_metric(float _dd,
+                                                                  float _gamma)
+{
+    int soft_bit = (_dd*_gamma)*16 + 127;
+    if (soft_bit > 255) soft_bit = 255;
+    if (soft_bit <   0) soft_bit = 0;
+    return (unsigned char) soft_bit;
+}
+
+// one axis of square QAM with a fixed number of bits _m, so that the
+// level loops unroll: exact max-log metrics from the distances to
+// every level (see MODEM(_demodulate_soft_pam)()), returning the
+// gray-encoded symbol
+LIQUID_MODEM_SLICER_INLINE unsigned int liquid_modem_soft_pam(float           _v,
+                                                              const int       _m,
+                                                              float           _alpha,
+                                                              float           _gamma,
+                                                              unsigned char * _soft_bits)
+{
+    const int M = 1 << _m;
+    float d[8];
+    int l, j = 0;
+#pragma GCC unroll 8
+    for (l=0; l<M; l++) {
+        float e = _v - (float)(2*l - M + 1)*_alpha;
+        d[l] = e*e;
+    }
+
+    // nearest level, ties to the lower level
+#pragma GCC unroll 8
+    for (l=1; l<M; l++)
+        j = d[l] < d[j] ? l : j;
+
+    int k;
+#pragma GCC unroll 4
+    for (k=0; k<_m; k++) {
+        int   p  = _m - k - 1;
+        float d0 = INFINITY;
+        float d1 = INFINITY;
+#pragma GCC unroll 8
+        for (l=0; l<M; l++) {
+            if (((l ^ (l >> 1)) >> p) & 1) d1 = d[l] < d1 ? d[l] : d1;
+            else                           d0 = d[l] < d0 ? d[l] : d0;
+        }
+        _soft_bits[k] = liquid_modem_soft_metric(d0 - d1, _gamma);
+    }
+    return j ^ (j >> 1);
+}
+
+// 16-QAM soft (see liquid.internal.h)
+void liquid_modem_slice_qam16_soft(const float complex * _x,
+                                   unsigned int          _n,
+                                   float                 _alpha,
+                                   float                 _gamma,
+                                   unsigned int *        _s,
+                                   unsigned char *       _soft_bits)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        unsigned int s_i = liquid_modem_soft_pam(crealf(_x[i]), 2, _alpha, _gamma, &_soft_bits[4*i+0]);
+        unsigned int s_q = liquid_modem_soft_pam(cimagf(_x[i]), 2, _alpha, _gamma, &_soft_bits[4*i+2]);
+        _s[i] = (s_i << 2) + s_q;
+    }
+}
+
+// 64-QAM soft (see liquid.internal.h)
+void liquid_modem_slice_qam64_soft(const float complex * _x,
+                                   unsigned int          _n,
+                                   float                 _alpha,
+                                   float                 _gamma,
+                                   unsigned int *        _s,
+                                   unsigned char *       _soft_bits)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        unsigned int s_i = liquid_modem_soft_pam(crealf(_x[i]), 3, _alpha, _gamma, &_soft_bits[6*i+0]);
+        unsigned int s_q = liquid_modem_soft_pam(cimagf(_x[i]), 3, _alpha, _gamma, &_soft_bits[6*i+3]);
+        _s[i] = (s_i << 3) + s_q;
+    }
+}
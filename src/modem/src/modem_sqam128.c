@@ -27,13 +27,13 @@
 // create a 'square' 128-QAM modem object
 MODEM() MODEM(_create_sqam128)()
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     q->scheme = LIQUID_MODEM_SQAM128;
 
     MODEM(_init)(q, 7);
 
     // allocate memory for 32-point symbol map
-    q->data.sqam128.map = (TC*) malloc( 32*sizeof(TC) );
+    q->data.sqam128.map = (TC*) liquid_malloc( 32*sizeof(TC) );
 #if T == float
     memmove(q->data.sqam128.map, modem_arb_sqam128, 32*sizeof(TC));
 #endif
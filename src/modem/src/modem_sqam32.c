@@ -27,13 +27,13 @@
 // create a 'square' 32-QAM modem object
 MODEM() MODEM(_create_sqam32)()
 {
-    MODEM() q = (MODEM()) malloc( sizeof(struct MODEM(_s)) );
+    MODEM() q = (MODEM()) liquid_calloc(1, sizeof(struct MODEM(_s)));
     q->scheme = LIQUID_MODEM_SQAM32;
 
     MODEM(_init)(q, 5);
 
     // allocate memory for 8-point symbol map
-    q->data.sqam32.map = (TC*) malloc( 8*sizeof(TC) );
+    q->data.sqam32.map = (TC*) liquid_malloc( 8*sizeof(TC) );
 #if T == float
     memmove(q->data.sqam32.map, modem_arb_sqam32, 8*sizeof(TC));
 #endif
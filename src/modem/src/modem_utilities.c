@@ -309,4 +309,149 @@ void liquid_unpack_soft_bits(unsigned int _sym_in,
         _soft_bits[i] = ((_sym_in >> (_bps-i-1)) & 0x0001) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
 }
 
+// unpack a single symbol into soft bits; _bps is a compile-time constant
+// at each call site below so the inner loop unrolls without branches
+static inline void liquid_unpack_soft_bits_fixed(unsigned int    _sym,
+                                                 unsigned int    _bps,
+                                                 unsigned char * _soft_bits)
+{
+    unsigned int i;
+    for (i=0; i<_bps; i++)
+        _soft_bits[i] = (unsigned char)(-((_sym >> (_bps-i-1)) & 1));
+}
+
+// pack a single symbol from soft bits using hard decisions; _bps is a
+// compile-time constant at each call site below
+static inline unsigned int liquid_pack_soft_bits_fixed(const unsigned char * _soft_bits,
+                                                       unsigned int          _bps)
+{
+    unsigned int i;
+    unsigned int s=0;
+    for (i=0; i<_bps; i++)
+        s = (s << 1) | (_soft_bits[i] >> 7);
+    return s;
+}
+
+// unpack block of symbols into soft bits
+//  _syms       :   input symbols, values in [0,2^_bps) [size: _n x 1]
+//  _n          :   number of symbols
+//  _bps        :   bits per symbol
+//  _soft_bits  :   soft output bits [size: _n*_bps x 1]
+void liquid_unpack_soft_bits_block(const unsigned int * _syms,
+                                   unsigned int         _n,
+                                   unsigned int         _bps,
+                                   unsigned char *      _soft_bits)
+{
+    // validate input
+    if (_bps > MAX_MOD_BITS_PER_SYMBOL) {
+        fprintf(stderr,"error: liquid_unpack_soft_bits_block(), bits/symbol exceeds maximum (%u)\n", MAX_MOD_BITS_PER_SYMBOL);
+        exit(1);
+    }
+
+    unsigned int i;
+    switch (_bps) {
+    case 1: for (i=0; i<_n; i++) liquid_unpack_soft_bits_fixed(_syms[i], 1, &_soft_bits[1*i]); break;
+    case 2: for (i=0; i<_n; i++) liquid_unpack_soft_bits_fixed(_syms[i], 2, &_soft_bits[2*i]); break;
+    case 3: for (i=0; i<_n; i++) liquid_unpack_soft_bits_fixed(_syms[i], 3, &_soft_bits[3*i]); break;
+    case 4: for (i=0; i<_n; i++) liquid_unpack_soft_bits_fixed(_syms[i], 4, &_soft_bits[4*i]); break;
+    case 6: for (i=0; i<_n; i++) liquid_unpack_soft_bits_fixed(_syms[i], 6, &_soft_bits[6*i]); break;
+    case 8: for (i=0; i<_n; i++) liquid_unpack_soft_bits_fixed(_syms[i], 8, &_soft_bits[8*i]); break;
+    default:
+        for (i=0; i<_n; i++)
+            liquid_unpack_soft_bits_fixed(_syms[i], _bps, &_soft_bits[i*_bps]);
+    }
+}
+
+// pack block of soft bits into symbols using hard decisions
+//  _soft_bits  :   soft input bits [size: _n*_bps x 1]
+//  _n          :   number of symbols
+//  _bps        :   bits per symbol
+//  _syms       :   output symbols, values in [0,2^_bps) [size: _n x 1]
+void liquid_pack_soft_bits_block(const unsigned char * _soft_bits,
+                                 unsigned int          _n,
+                                 unsigned int          _bps,
+                                 unsigned int *        _syms)
+{
+    // validate input
+    if (_bps > MAX_MOD_BITS_PER_SYMBOL) {
+        fprintf(stderr,"error: liquid_pack_soft_bits_block(), bits/symbol exceeds maximum (%u)\n", MAX_MOD_BITS_PER_SYMBOL);
+        exit(1);
+    }
+
+    unsigned int i;
+    switch (_bps) {
+    case 1: for (i=0; i<_n; i++) _syms[i] = liquid_pack_soft_bits_fixed(&_soft_bits[1*i], 1); break;
+    case 2: for (i=0; i<_n; i++) _syms[i] = liquid_pack_soft_bits_fixed(&_soft_bits[2*i], 2); break;
+    case 3: for (i=0; i<_n; i++) _syms[i] = liquid_pack_soft_bits_fixed(&_soft_bits[3*i], 3); break;
+    case 4: for (i=0; i<_n; i++) _syms[i] = liquid_pack_soft_bits_fixed(&_soft_bits[4*i], 4); break;
+    case 6: for (i=0; i<_n; i++) _syms[i] = liquid_pack_soft_bits_fixed(&_soft_bits[6*i], 6); break;
+    case 8: for (i=0; i<_n; i++) _syms[i] = liquid_pack_soft_bits_fixed(&_soft_bits[8*i], 8); break;
+    default:
+        for (i=0; i<_n; i++)
+            _syms[i] = liquid_pack_soft_bits_fixed(&_soft_bits[i*_bps], _bps);
+    }
+}
+
+// pack soft bits into bytes using hard decisions, most significant
+// bit first
+//  _soft_bits  :   soft input bits [size: 8*_n x 1]
+//  _n          :   number of output bytes
+//  _bytes      :   packed output bytes [size: _n x 1]
+void liquid_pack_soft_bytes(const unsigned char * _soft_bits,
+                            unsigned int          _n,
+                            unsigned char *       _bytes)
+{
+    // independent shift/mask terms avoid a serial dependency chain
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        const unsigned char * r = &_soft_bits[8*i];
+        _bytes[i] = ((r[0] >> 0) & 0x80) | ((r[1] >> 1) & 0x40) |
+                    ((r[2] >> 2) & 0x20) | ((r[3] >> 3) & 0x10) |
+                    ((r[4] >> 4) & 0x08) | ((r[5] >> 5) & 0x04) |
+                    ((r[6] >> 6) & 0x02) | ((r[7] >> 7) & 0x01);
+    }
+}
 
+// unpack bytes into soft bits, most significant bit first
+//  _bytes      :   input bytes [size: _n x 1]
+//  _n          :   number of input bytes
+//  _soft_bits  :   soft output bits [size: 8*_n x 1]
+void liquid_unpack_soft_bytes(const unsigned char * _bytes,
+                              unsigned int          _n,
+                              unsigned char *       _soft_bits)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        liquid_unpack_soft_bits_fixed(_bytes[i], 8, &_soft_bits[8*i]);
+}
+
+// scale soft bits about the erasure point and saturate to [0,255]; the
+// hard decision of each bit is preserved
+//  _soft_bits  :   soft bits [size: _n x 1]
+//  _n          :   number of soft bits
+//  _scale      :   scaling factor, _scale > 0
+void liquid_scale_soft_bits(unsigned char * _soft_bits,
+                            unsigned int    _n,
+                            float           _scale)
+{
+    // validate input
+    if (_scale <= 0.0f) {
+        fprintf(stderr,"error: liquid_scale_soft_bits(), scale must be greater than zero\n");
+        exit(1);
+    }
+
+    // Q8 gain, clipped to keep products within 32 bits
+    int g = _scale >= 256.0f ? 65536 : (int)(256.0f*_scale + 0.5f);
+    if (g < 1) g = 1;
+
+    // work in the odd-valued domain c = 2x-255 so that the erasure point
+    // sits between 127 and 128; scaling the magnitude and forcing it odd
+    // keeps the result symmetric and its sign (the hard decision) intact
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        int c = 2*(int)_soft_bits[i] - 255;
+        int m = (((c < 0 ? -c : c) * g) >> 8) | 1;
+        m = m > 255 ? 255 : m;
+        _soft_bits[i] = (unsigned char)(((c < 0 ? -m : m) + 255) >> 1);
+    }
+}
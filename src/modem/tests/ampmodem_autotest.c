@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// Help function to keep code base small: block modulation and
+// demodulation match single-sample methods
+//  _type               :   AM type (e.g. LIQUID_AMPMODEM_DSB)
+//  _suppressed_carrier :   carrier suppression flag
+void ampmodem_block_test(liquid_ampmodem_type _type,
+                         int                  _suppressed_carrier)
+{
+    unsigned int num_samples = 1000;
+    unsigned int block_len   = 77;      // odd length exercises remainders
+    float        fc          = 0.1f;    // carrier frequency
+    unsigned int i;
+
+    // generate message signal (sum of sines)
+    float m[num_samples];
+    for (i=0; i<num_samples; i++) {
+        m[i] = 0.3f*cosf(2*M_PI*0.013f*i + 0.0f) +
+               0.2f*cosf(2*M_PI*0.021f*i + 0.4f) +
+               0.4f*cosf(2*M_PI*0.037f*i + 1.7f);
+    }
+
+    // modulate
+    ampmodem mod0 = ampmodem_create(1.0f, fc, _type, _suppressed_carrier);
+    ampmodem mod1 = ampmodem_create(1.0f, fc, _type, _suppressed_carrier);
+    float complex s0[num_samples];
+    float complex s1[num_samples];
+    for (i=0; i<num_samples; i++)
+        ampmodem_modulate(mod0, m[i], &s0[i]);
+    for (i=0; i<num_samples; i+=block_len)
+        ampmodem_modulate_block(mod1, &m[i], i + block_len < num_samples ? block_len : num_samples - i, &s1[i]);
+
+    // single-sample mixer uses a 256-point sine table
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(s1[i]), crealf(s0[i]), 0.02f );
+        CONTEND_DELTA( cimagf(s1[i]), cimagf(s0[i]), 0.02f );
+    }
+
+    // demodulate
+    ampmodem dem0 = ampmodem_create(1.0f, fc, _type, _suppressed_carrier);
+    ampmodem dem1 = ampmodem_create(1.0f, fc, _type, _suppressed_carrier);
+    float y0[num_samples];
+    float y1[num_samples];
+    for (i=0; i<num_samples; i++)
+        ampmodem_demodulate(dem0, s1[i], &y0[i]);
+    for (i=0; i<num_samples; i+=block_len)
+        ampmodem_demodulate_block(dem1, &s1[i], i + block_len < num_samples ? block_len : num_samples - i, &y1[i]);
+
+    if (_suppressed_carrier && _type == LIQUID_AMPMODEM_DSB) {
+        // coherent: carrier loop updated per sub-block, so compare
+        // against the message once locked
+        for (i=num_samples/2; i<num_samples; i++)
+            CONTEND_DELTA( y1[i], m[i], 0.05f );
+    } else {
+        for (i=0; i<num_samples; i++)
+            CONTEND_DELTA( y1[i], y0[i], 1e-4f );
+    }
+
+    ampmodem_destroy(mod0);
+    ampmodem_destroy(mod1);
+    ampmodem_destroy(dem0);
+    ampmodem_destroy(dem1);
+}
+
+void autotest_ampmodem_block_dsb()      { ampmodem_block_test(LIQUID_AMPMODEM_DSB, 0); }
+void autotest_ampmodem_block_usb()      { ampmodem_block_test(LIQUID_AMPMODEM_USB, 0); }
+void autotest_ampmodem_block_lsb()      { ampmodem_block_test(LIQUID_AMPMODEM_LSB, 0); }
+void autotest_ampmodem_block_dsb_sc()   { ampmodem_block_test(LIQUID_AMPMODEM_DSB, 1); }
+void autotest_ampmodem_block_usb_sc()   { ampmodem_block_test(LIQUID_AMPMODEM_USB, 1); }
+void autotest_ampmodem_block_lsb_sc()   { ampmodem_block_test(LIQUID_AMPMODEM_LSB, 1); }
@@ -118,3 +118,138 @@ void autotest_cpfskmodem_bps2_h0p0250_k4_m3_square()    { cpfskmodem_test_mod_de
 void autotest_cpfskmodem_bps3_h0p1250_k4_m3_square()    { cpfskmodem_test_mod_demod( 3, 0.1250f, 4, 3, 0.25f, LIQUID_CPFSK_SQUARE ); }
 void autotest_cpfskmodem_bps4_h0p0625_k4_m3_square()    { cpfskmodem_test_mod_demod( 4, 0.0625f, 4, 3, 0.25f, LIQUID_CPFSK_SQUARE ); }
 
+
+// Compare cpfskmod output against reference modulator which filters
+// each symbol and integrates the phase sample by sample
+void cpfskmodem_test_mod(unsigned int _bps,
+                         float        _h,
+                         unsigned int _k,
+                         int          _filter_type)
+{
+    cpfskmod mod = cpfskmod_create(_bps, _h, _k, 3, 0.25f, _filter_type);
+
+    // reference pulse (unit area, scaled by modulation index) and
+    // integrator
+    unsigned int i, j, M = 1 << _bps;
+    unsigned int ht_len = _filter_type == LIQUID_CPFSK_RCOS_PARTIAL ? 3*_k : _k;
+    float ht[ht_len];
+    float b[2] = {0.5f,  0.5f};
+    float a[2] = {1.0f, -1.0f};
+    for (i=0; i<ht_len; i++) {
+        switch (_filter_type) {
+        case LIQUID_CPFSK_SQUARE:    ht[i] = 1.0f; b[0] = 0.0f; b[1] = 1.0f; break;
+        case LIQUID_CPFSK_RCOS_FULL: ht[i] = 1.0f - cosf(2.0f*M_PI*i/(float)_k); break;
+        default:
+            ht[i] = (i >= _k/2 && i < 2*_k + _k/2) ?
+                1.0f - cosf(2.0f*M_PI*(i-_k/2)/(float)(2*_k)) : 0.0f;
+        }
+    }
+    float ht_sum = 0.0f;
+    for (i=0; i<ht_len; i++) ht_sum += ht[i];
+    for (i=0; i<ht_len; i++) ht[i] *= M_PI * _h / ht_sum;
+    firinterp_rrrf interp = firinterp_rrrf_create(_k, ht, ht_len);
+    iirfilt_rrrf integrator = iirfilt_rrrf_create(b,2,a,2);
+
+    unsigned int num_symbols = 400;
+    msequence ms = msequence_create_default(9);
+    float complex y[_k];
+    float phi[_k];
+    for (i=0; i<num_symbols; i++) {
+        unsigned int s = msequence_generate_symbol(ms, _bps);
+        cpfskmod_modulate(mod, s, y);
+
+        // reference
+        firinterp_rrrf_execute(interp, 2.0f*s - (float)M + 1.0f, phi);
+        for (j=0; j<_k; j++) {
+            float theta;
+            iirfilt_rrrf_execute(integrator, phi[j], &theta);
+            CONTEND_DELTA(crealf(y[j]), cosf(theta), 1e-3f);
+            CONTEND_DELTA(cimagf(y[j]), sinf(theta), 1e-3f);
+        }
+    }
+
+    msequence_destroy(ms);
+    firinterp_rrrf_destroy(interp);
+    iirfilt_rrrf_destroy(integrator);
+    cpfskmod_destroy(mod);
+}
+
+//
+// AUTOTESTS: modulator output
+//
+void autotest_cpfskmod_bps1_h0p5000_k4_square()   { cpfskmodem_test_mod( 1, 0.5000f, 4, LIQUID_CPFSK_SQUARE       ); }
+void autotest_cpfskmod_bps2_h0p2500_k8_square()   { cpfskmodem_test_mod( 2, 0.2500f, 8, LIQUID_CPFSK_SQUARE       ); }
+void autotest_cpfskmod_bps1_h0p5000_k4_rcosfull() { cpfskmodem_test_mod( 1, 0.5000f, 4, LIQUID_CPFSK_RCOS_FULL    ); }
+void autotest_cpfskmod_bps3_h0p1250_k6_rcosfull() { cpfskmodem_test_mod( 3, 0.1250f, 6, LIQUID_CPFSK_RCOS_FULL    ); }
+void autotest_cpfskmod_bps1_h0p5000_k4_rcospart() { cpfskmodem_test_mod( 1, 0.5000f, 4, LIQUID_CPFSK_RCOS_PARTIAL ); }
+void autotest_cpfskmod_bps2_h0p2500_k4_rcospart() { cpfskmodem_test_mod( 2, 0.2500f, 4, LIQUID_CPFSK_RCOS_PARTIAL ); }
+void autotest_cpfskmod_bps4_h0p0625_k4_rcospart() { cpfskmodem_test_mod( 4, 0.0625f, 4, LIQUID_CPFSK_RCOS_PARTIAL ); }
+
+// Non-coherent demodulator with unknown carrier phase and slow phase
+// drift, optionally in noise
+void cpfskmodem_test_noncoherent(unsigned int _bps,
+                                 float        _h,
+                                 unsigned int _k,
+                                 unsigned int _m,
+                                 float        _beta,
+                                 int          _filter_type,
+                                 float        _SNRdB)
+{
+    cpfskmod mod = cpfskmod_create            (_bps, _h, _k, _m, _beta, _filter_type);
+    cpfskdem dem = cpfskdem_create_noncoherent(_bps, _h, _k, _m, _beta, _filter_type);
+    if (liquid_autotest_verbose)
+        cpfskdem_print(dem);
+
+    unsigned int delay = cpfskmod_get_delay(mod) + cpfskdem_get_delay(dem);
+    unsigned int num_symbols = 200 + delay;
+    float nstd = powf(10.0f, -_SNRdB/20.0f);
+
+    msequence ms = msequence_create_default(9);
+    float complex buf[_k];
+    unsigned int  sym_in [num_symbols];
+    unsigned int  sym_out[num_symbols];
+    unsigned int i, j, n = 0;
+    for (i=0; i<num_symbols; i++) {
+        sym_in[i] = msequence_generate_symbol(ms, _bps);
+        cpfskmod_modulate(mod, sym_in[i], buf);
+
+        // carrier phase offset and drift, noise
+        for (j=0; j<_k; j++) {
+            buf[j] *= cexpf(_Complex_I*(1.3f + 0.002f*n++));
+            if (_SNRdB < 100.0f)
+                buf[j] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        }
+
+        sym_out[i] = cpfskdem_demodulate(dem, buf);
+    }
+
+    unsigned int num_errors = 0;
+    for (i=delay; i<num_symbols; i++)
+        num_errors += sym_in[i-delay] == sym_out[i] ? 0 : 1;
+    if (liquid_autotest_verbose)
+        printf("  errors : %u / %u\n", num_errors, num_symbols-delay);
+    CONTEND_EQUALITY(num_errors, 0);
+
+    msequence_destroy(ms);
+    cpfskmod_destroy(mod);
+    cpfskdem_destroy(dem);
+}
+
+//
+// AUTOTESTS: non-coherent demodulator
+//
+
+// orthogonal tones (FFT for larger constellations)
+void autotest_cpfskmodem_nc_bps1_h1p0000_k8_square()    { cpfskmodem_test_noncoherent( 1, 1.0000f,  8, 3, 0.25f, LIQUID_CPFSK_SQUARE,       200.0f); }
+void autotest_cpfskmodem_nc_bps3_h1p0000_k8_square()    { cpfskmodem_test_noncoherent( 3, 1.0000f,  8, 3, 0.25f, LIQUID_CPFSK_SQUARE,       200.0f); }
+void autotest_cpfskmodem_nc_bps5_h1p0000_k32_square()   { cpfskmodem_test_noncoherent( 5, 1.0000f, 32, 3, 0.25f, LIQUID_CPFSK_SQUARE,       200.0f); }
+void autotest_cpfskmodem_nc_bps6_h1p0000_k64_square()   { cpfskmodem_test_noncoherent( 6, 1.0000f, 64, 3, 0.25f, LIQUID_CPFSK_SQUARE,        10.0f); }
+
+// continuous-phase pulses
+void autotest_cpfskmodem_nc_bps1_h0p5000_k8_square()    { cpfskmodem_test_noncoherent( 1, 0.5000f,  8, 3, 0.25f, LIQUID_CPFSK_SQUARE,        12.0f); }
+void autotest_cpfskmodem_nc_bps1_h0p7000_k8_rcosfull()  { cpfskmodem_test_noncoherent( 1, 0.7000f,  8, 3, 0.25f, LIQUID_CPFSK_RCOS_FULL,     12.0f); }
+void autotest_cpfskmodem_nc_bps2_h1p0000_k8_rcosfull()  { cpfskmodem_test_noncoherent( 2, 1.0000f,  8, 3, 0.25f, LIQUID_CPFSK_RCOS_FULL,     12.0f); }
+void autotest_cpfskmodem_nc_bps1_h0p5000_k8_rcospart()  { cpfskmodem_test_noncoherent( 1, 0.5000f,  8, 3, 0.25f, LIQUID_CPFSK_RCOS_PARTIAL, 200.0f); }
+void autotest_cpfskmodem_nc_bps1_h0p5000_k8_gmsk()      { cpfskmodem_test_noncoherent( 1, 0.5000f,  8, 3, 0.30f, LIQUID_CPFSK_GMSK,         200.0f); }
+void autotest_cpfskmodem_nc_bps1_h1p0000_k8_gmsk()      { cpfskmodem_test_noncoherent( 1, 1.0000f,  8, 3, 0.50f, LIQUID_CPFSK_GMSK,          12.0f); }
+
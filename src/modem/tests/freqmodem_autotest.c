@@ -69,3 +69,109 @@ void autotest_freqmodem_kf_0_02() { freqmodem_test(0.02f); }
 void autotest_freqmodem_kf_0_04() { freqmodem_test(0.04f); }
 void autotest_freqmodem_kf_0_08() { freqmodem_test(0.08f); }
 
+
+// compare polynomial arctangent approximation against exact demodulator
+//  _order  :   approximation order
+//  _tol    :   maximum phase error (radians)
+void freqdem_test_accuracy(unsigned int _order,
+                           float        _tol)
+{
+    unsigned int num_samples = 1001;   // not a multiple of SIMD width
+    float kf = 0.1f;
+    float ref = 1.0f / (2*M_PI*kf);
+
+    freqdem dem0 = freqdem_create(kf);  // exact
+    freqdem dem1 = freqdem_create(kf);  // approximate
+    freqdem_set_accuracy(dem1, _order);
+
+    // random samples covering all octants, including axes
+    float complex r[num_samples];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        r[i] = (i % 97) == 0 ? cexpf(_Complex_I*M_PI*0.5f*(i/97)) : randnf() + _Complex_I*randnf();
+
+    float y0[num_samples];
+    float y1[num_samples];
+    freqdem_demodulate_block(dem0, r, num_samples, y0);
+    freqdem_demodulate_block(dem1, r, num_samples, y1);
+
+    // phase difference near +/-pi may wrap; compare on circle
+    for (i=0; i<num_samples; i++) {
+        float d = (y1[i] - y0[i]) / ref;
+        if (d >  M_PI) d -= 2*M_PI;
+        if (d < -M_PI) d += 2*M_PI;
+        CONTEND_DELTA( d, 0.0f, _tol );
+    }
+
+    // per-sample interface uses the same approximation
+    freqdem_reset(dem1);
+    for (i=0; i<num_samples; i++) {
+        float y;
+        freqdem_demodulate(dem1, r[i], &y);
+        CONTEND_DELTA( y, y1[i], 1e-5f );
+    }
+
+    freqdem_destroy(dem0);
+    freqdem_destroy(dem1);
+}
+
+// AUTOTESTS: arctangent approximation
+void autotest_freqdem_accuracy_3()  { freqdem_test_accuracy( 3, 5.0e-3f); }
+void autotest_freqdem_accuracy_5()  { freqdem_test_accuracy( 5, 6.2e-4f); }
+void autotest_freqdem_accuracy_7()  { freqdem_test_accuracy( 7, 8.5e-5f); }
+void autotest_freqdem_accuracy_9()  { freqdem_test_accuracy( 9, 1.5e-5f); }
+void autotest_freqdem_accuracy_11() { freqdem_test_accuracy(11, 3.0e-6f); }
+void autotest_freqdem_accuracy_13() { freqdem_test_accuracy(13, 1.0e-6f); }
+
+// demodulate interleaved channels and compare against one
+// single-channel demodulator per channel
+//  _num_channels   :   number of channels
+//  _order          :   approximation order
+void freqdem_test_multi(unsigned int _num_channels,
+                        unsigned int _order)
+{
+    unsigned int num_samples = 240;
+    float kf = 0.05f;
+    unsigned int C = _num_channels;
+    unsigned int i, c;
+
+    freqdem dem = freqdem_create_multi(kf, C);
+    freqdem_set_accuracy(dem, _order);
+    freqdem dems[C];
+    for (c=0; c<C; c++) {
+        dems[c] = freqdem_create(kf);
+        freqdem_set_accuracy(dems[c], _order);
+    }
+
+    // generate interleaved signals with a different tone per channel
+    float complex r[num_samples*C];
+    for (i=0; i<num_samples; i++) {
+        for (c=0; c<C; c++)
+            r[i*C+c] = (0.5f + 0.1f*c) * cexpf(_Complex_I*(0.01f*(c+1)*i*i/(float)num_samples + c));
+    }
+
+    // demodulate in uneven blocks to exercise saved state
+    float y[num_samples*C];
+    freqdem_demodulate_block(dem, r,        1,               y);
+    freqdem_demodulate_block(dem, r+C,      13,              y+C);
+    freqdem_demodulate_block(dem, r+14*C,   0,               y+14*C);
+    freqdem_demodulate_block(dem, r+14*C,   num_samples-14,  y+14*C);
+
+    // reference: one demodulator per channel
+    for (c=0; c<C; c++) {
+        for (i=0; i<num_samples; i++) {
+            float y_ref;
+            freqdem_demodulate(dems[c], r[i*C+c], &y_ref);
+            CONTEND_DELTA( y[i*C+c], y_ref, 1e-5f );
+        }
+        freqdem_destroy(dems[c]);
+    }
+    freqdem_destroy(dem);
+}
+
+// AUTOTESTS: multiple channels
+void autotest_freqdem_multi_c2_exact()  { freqdem_test_multi( 2, 0); }
+void autotest_freqdem_multi_c24_exact() { freqdem_test_multi(24, 0); }
+void autotest_freqdem_multi_c3_poly7()  { freqdem_test_multi( 3, 7); }
+void autotest_freqdem_multi_c24_poly9() { freqdem_test_multi(24, 9); }
+
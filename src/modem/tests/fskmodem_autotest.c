@@ -80,3 +80,49 @@ void autotest_fskmodem_misc_M256()  { fskmodem_test_mod_demod( 8,  500, 0.372145
 void autotest_fskmodem_misc_M512()  { fskmodem_test_mod_demod( 9, 1000, 0.3721451); }
 void autotest_fskmodem_misc_M1024() { fskmodem_test_mod_demod(10, 2000, 0.3721451); }
 
+
+// Goertzel demodulation of the tone bins agrees with the full
+// transform, including the frequency error estimate
+void fskmodem_test_goertzel(unsigned int _m,
+                            unsigned int _k,
+                            float        _bandwidth)
+{
+    fskmod mod = fskmod_create(_m,_k,_bandwidth);
+    fskdem dem0 = fskdem_create(_m,_k,_bandwidth);
+    fskdem dem1 = fskdem_create(_m,_k,_bandwidth);
+    fskdem_set_goertzel(dem0, 0);
+    fskdem_set_goertzel(dem1, 1);
+    CONTEND_EQUALITY(fskdem_get_goertzel(dem0), 0);
+    CONTEND_EQUALITY(fskdem_get_goertzel(dem1), 1);
+
+    unsigned int M = 1 << _m;   // constellation size
+    float complex buf[_k];      // transmit buffer
+    unsigned int i, j;
+    for (i=0; i<4*M; i++) {
+        // modulate and add noise
+        unsigned int sym_in = i % M;
+        fskmod_modulate(mod, sym_in, buf);
+        for (j=0; j<_k; j++)
+            buf[j] += 0.1f*(randnf() + _Complex_I*randnf());
+
+        // demodulate with both methods
+        unsigned int s0 = fskdem_demodulate(dem0, buf);
+        unsigned int s1 = fskdem_demodulate(dem1, buf);
+        CONTEND_EQUALITY(s0, sym_in);
+        CONTEND_EQUALITY(s1, sym_in);
+
+        float e0 = fskdem_get_frequency_error(dem0);
+        float e1 = fskdem_get_frequency_error(dem1);
+        CONTEND_DELTA(e0, e1, 1e-3f*(1.0f + fabsf(e0)));
+    }
+
+    fskmod_destroy(mod);
+    fskdem_destroy(dem0);
+    fskdem_destroy(dem1);
+}
+
+// AUTOTESTS: Goertzel demodulation, binary to 16-FSK
+void autotest_fskmodem_goertzel_M2()  { fskmodem_test_goertzel( 1,    8, 0.25f    ); }
+void autotest_fskmodem_goertzel_M4()  { fskmodem_test_goertzel( 2,   16, 0.3721451); }
+void autotest_fskmodem_goertzel_M8()  { fskmodem_test_goertzel( 3,   64, 0.1f     ); }
+void autotest_fskmodem_goertzel_M16() { fskmodem_test_goertzel( 4,  100, 0.3721451); }
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// Compare gmskmod output against reference modulator which filters
+// each bit and integrates the phase sample by sample
+void gmskmodem_test_mod(unsigned int _k,
+                        unsigned int _m,
+                        float        _BT)
+{
+    gmskmod mod = gmskmod_create(_k, _m, _BT);
+    firinterp_rrrf interp = firinterp_rrrf_create_prototype(LIQUID_FIRFILT_GMSKTX, _k, _m, _BT, 0);
+
+    unsigned int num_symbols = 400;
+    msequence ms = msequence_create_default(7);
+    float complex y[_k];
+    float phi[_k];
+    float theta = 0.0f;
+    unsigned int i, j;
+    for (i=0; i<num_symbols; i++) {
+        unsigned int s = msequence_advance(ms);
+        gmskmod_modulate(mod, s, y);
+
+        // reference
+        firinterp_rrrf_execute(interp, s ? 1.0f/(float)_k : -1.0f/(float)_k, phi);
+        for (j=0; j<_k; j++) {
+            theta += phi[j];
+            if (theta >  M_PI) theta -= 2*M_PI;
+            if (theta < -M_PI) theta += 2*M_PI;
+            CONTEND_DELTA(crealf(y[j]), cosf(theta), 1e-4f);
+            CONTEND_DELTA(cimagf(y[j]), sinf(theta), 1e-4f);
+        }
+    }
+
+    msequence_destroy(ms);
+    firinterp_rrrf_destroy(interp);
+    gmskmod_destroy(mod);
+}
+
+void autotest_gmskmod_k2_m3_BT0p50()  { gmskmodem_test_mod(2, 3, 0.50f); }
+void autotest_gmskmod_k4_m3_BT0p30()  { gmskmodem_test_mod(4, 3, 0.30f); }
+void autotest_gmskmod_k8_m2_BT0p25()  { gmskmodem_test_mod(8, 2, 0.25f); }
+void autotest_gmskmod_k4_m7_BT0p50()  { gmskmodem_test_mod(4, 7, 0.50f); }
+
+
+// Compare block modulation against modulating one symbol at a time
+void autotest_gmskmod_modulate_block()
+{
+    unsigned int k = 4;
+    unsigned int num_symbols = 200;
+    gmskmod mod0 = gmskmod_create(k, 3, 0.3f);
+    gmskmod mod1 = gmskmod_create(k, 3, 0.3f);
+
+    unsigned int s[num_symbols];
+    float complex y0[k*num_symbols];
+    float complex y1[k*num_symbols];
+    unsigned int i;
+    for (i=0; i<num_symbols; i++) {
+        s[i] = rand() & 1;
+        gmskmod_modulate(mod0, s[i], &y0[k*i]);
+    }
+
+    // split into uneven blocks
+    gmskmod_modulate_block(mod1, &s[  0],  37, &y1[k*  0]);
+    gmskmod_modulate_block(mod1, &s[ 37],   1, &y1[k* 37]);
+    gmskmod_modulate_block(mod1, &s[ 38], 162, &y1[k* 38]);
+
+    for (i=0; i<k*num_symbols; i++) {
+        CONTEND_EQUALITY(crealf(y0[i]), crealf(y1[i]));
+        CONTEND_EQUALITY(cimagf(y0[i]), cimagf(y1[i]));
+    }
+
+    gmskmod_destroy(mod0);
+    gmskmod_destroy(mod1);
+}
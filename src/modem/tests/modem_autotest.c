@@ -21,7 +21,7 @@
  */
 
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 // Help function to keep code base small
 void modem_test_mod_demod(modulation_scheme _ms)
@@ -116,3 +116,70 @@ void autotest_mod_demod_arb128opt() { modem_test_mod_demod(LIQUID_MODEM_ARB128OP
 void autotest_mod_demod_arb256opt() { modem_test_mod_demod(LIQUID_MODEM_ARB256OPT); }
 void autotest_mod_demod_arb64vt()   { modem_test_mod_demod(LIQUID_MODEM_ARB64VT);   }
 
+// modems of the same scheme share cached tables, which must remain
+// valid once other instances have been destroyed
+void modem_test_shared_tables(modulation_scheme _ms)
+{
+    modem q0 = modem_create(_ms);
+    modem q1 = modem_create(_ms);
+    unsigned int i, s, M = 1 << modem_get_bps(q0);
+    float complex x0[M], x1[M];
+    unsigned char soft_bits[8];
+    for (i=0; i<M; i++)
+        modem_modulate(q0, i, &x0[i]);
+    modem_destroy(q0);
+
+    modem q2 = modem_create(_ms);
+    for (i=0; i<M; i++) {
+        modem_modulate(q1, i, &x1[i]);
+        modem_demodulate_soft(q2, x0[i], &s, soft_bits);
+        CONTEND_EQUALITY(s, i);
+    }
+    CONTEND_SAME_DATA(x0, x1, M*sizeof(float complex));
+
+    modem_destroy(q1);
+    modem_destroy(q2);
+}
+
+void autotest_modem_shared_tables_psk16()    { modem_test_shared_tables(LIQUID_MODEM_PSK16);    }
+void autotest_modem_shared_tables_qam64()    { modem_test_shared_tables(LIQUID_MODEM_QAM64);    }
+void autotest_modem_shared_tables_apsk256()  { modem_test_shared_tables(LIQUID_MODEM_APSK256);  }
+void autotest_modem_shared_tables_arb64opt() { modem_test_shared_tables(LIQUID_MODEM_ARB64OPT); }
+
+// re-initializing the constellation of a built-in arbitrary modem
+// gives it private tables, leaving other instances unchanged
+void autotest_modem_shared_tables_arb_init()
+{
+    modem q0 = modem_create(LIQUID_MODEM_ARB16OPT);
+    modem q1 = modem_create(LIQUID_MODEM_ARB16OPT);
+    unsigned int i, s;
+    float complex x0[16], x1[16], table[16];
+    for (i=0; i<16; i++) {
+        modem_modulate(q1, i, &x0[i]);
+        table[i] = (float)(2*(int)(i%4)-3) + _Complex_I*(float)(2*(int)(i/4)-3);
+    }
+
+    // square 16-point grid
+    modem_arb_init(q0, table, 16);
+    for (i=0; i<16; i++) {
+        modem_modulate(q0, i, &x1[i]);
+        CONTEND_DELTA(crealf(x1[i]), crealf(table[i])/sqrtf(10.0f), 1e-6f);
+        CONTEND_DELTA(cimagf(x1[i]), cimagf(table[i])/sqrtf(10.0f), 1e-6f);
+        modem_demodulate(q0, x1[i], &s);
+        CONTEND_EQUALITY(s, i);
+    }
+    modem_destroy(q0);
+
+    // other instances, existing and new, keep the built-in constellation
+    modem q2 = modem_create(LIQUID_MODEM_ARB16OPT);
+    for (i=0; i<16; i++) {
+        modem_modulate(q1, i, &x1[i]);
+        CONTEND_SAME_DATA(&x1[i], &x0[i], sizeof(float complex));
+        modem_modulate(q2, i, &x1[i]);
+        CONTEND_SAME_DATA(&x1[i], &x0[i], sizeof(float complex));
+        modem_demodulate(q2, x0[i], &s);
+        CONTEND_EQUALITY(s, i);
+    }
+    modem_destroy(q1);
+    modem_destroy(q2);
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare block methods against per-sample methods at every SIMD
+// level available on this host
+void modem_test_block(modulation_scheme _ms)
+{
+    // odd length exercises the scalar tails of the wide slicers
+    unsigned int n = 203;
+    unsigned int i, k;
+
+    modem q0 = modem_create(_ms);   // per-sample reference
+    modem q1 = modem_create(_ms);   // block methods
+    unsigned int bps = modem_get_bps(q0);
+
+    unsigned int  s[n], s0[n], s1[n];
+    float complex y0[n], y1[n], x[n];
+    unsigned char soft0[n*bps], soft1[n*bps];
+
+    // modulate
+    for (i=0; i<n; i++)
+        s[i] = modem_gen_rand_sym(q0);
+    for (i=0; i<n; i++)
+        modem_modulate(q0, s[i], &y0[i]);
+    modem_modulate_block(q1, s, n, y1);
+    CONTEND_SAME_DATA(y0, y1, sizeof(y0));
+
+    // add noise (and exact zeros to check slicer thresholds)
+    for (i=0; i<n; i++)
+        x[i] = y0[i] + 0.15f*(randnf() + _Complex_I*randnf());
+    x[0] = 0.0f;
+    x[1] = _Complex_I*0.2f;
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        // hard decisions and demodulator state
+        modem_reset(q0);
+        modem_reset(q1);
+        for (i=0; i<n; i++)
+            modem_demodulate(q0, x[i], &s0[i]);
+        modem_demodulate_block(q1, x, n, s1);
+        CONTEND_SAME_DATA(s0, s1, sizeof(s0));
+
+        float complex x_hat0, x_hat1;
+        modem_get_demodulator_sample(q0, &x_hat0);
+        modem_get_demodulator_sample(q1, &x_hat1);
+        CONTEND_EQUALITY(crealf(x_hat0), crealf(x_hat1));
+        CONTEND_EQUALITY(cimagf(x_hat0), cimagf(x_hat1));
+        CONTEND_EQUALITY(modem_get_demodulator_phase_error(q0),
+                         modem_get_demodulator_phase_error(q1));
+
+        // soft decisions; allow one count for contracted arithmetic
+        modem_reset(q0);
+        modem_reset(q1);
+        for (i=0; i<n; i++)
+            modem_demodulate_soft(q0, x[i], &s0[i], &soft0[i*bps]);
+        modem_demodulate_soft_block(q1, x, n, s1, soft1);
+        CONTEND_SAME_DATA(s0, s1, sizeof(s0));
+        for (k=0; k<n*bps; k++)
+            CONTEND_DELTA(soft0[k], soft1[k], 1);
+    }
+    liquid_simd_set_level(host);
+
+    // empty block
+    modem_demodulate_block(q1, x, 0, s1);
+    modem_demodulate_soft_block(q1, x, 0, s1, soft1);
+
+    modem_destroy(q0);
+    modem_destroy(q1);
+}
+
+// AUTOTESTS: specific block slicers
+void autotest_modem_block_bpsk()    { modem_test_block(LIQUID_MODEM_BPSK);    }
+void autotest_modem_block_qpsk()    { modem_test_block(LIQUID_MODEM_QPSK);    }
+void autotest_modem_block_qam4()    { modem_test_block(LIQUID_MODEM_QAM4);    }
+void autotest_modem_block_qam8()    { modem_test_block(LIQUID_MODEM_QAM8);    }
+void autotest_modem_block_qam16()   { modem_test_block(LIQUID_MODEM_QAM16);   }
+void autotest_modem_block_qam32()   { modem_test_block(LIQUID_MODEM_QAM32);   }
+void autotest_modem_block_qam64()   { modem_test_block(LIQUID_MODEM_QAM64);   }
+void autotest_modem_block_qam128()  { modem_test_block(LIQUID_MODEM_QAM128);  }
+void autotest_modem_block_qam256()  { modem_test_block(LIQUID_MODEM_QAM256);  }
+
+// AUTOTESTS: per-sample fallback
+void autotest_modem_block_psk8()    { modem_test_block(LIQUID_MODEM_PSK8);    }
+void autotest_modem_block_dpsk4()   { modem_test_block(LIQUID_MODEM_DPSK4);   }
+void autotest_modem_block_ask4()    { modem_test_block(LIQUID_MODEM_ASK4);    }
+void autotest_modem_block_apsk4()   { modem_test_block(LIQUID_MODEM_APSK4);   }
+void autotest_modem_block_apsk16()  { modem_test_block(LIQUID_MODEM_APSK16);  }
+void autotest_modem_block_apsk64()  { modem_test_block(LIQUID_MODEM_APSK64);  }
+void autotest_modem_block_apsk256() { modem_test_block(LIQUID_MODEM_APSK256); }
+void autotest_modem_block_ook()     { modem_test_block(LIQUID_MODEM_OOK);     }
+void autotest_modem_block_sqam32()  { modem_test_block(LIQUID_MODEM_SQAM32);  }
+void autotest_modem_block_arb16opt(){ modem_test_block(LIQUID_MODEM_ARB16OPT);}
+
+
+// block phase recovery: constant offset plus slow drift and noise
+// must be removed to within a small residual, without symbol errors
+void modem_test_recover_phase(modulation_scheme _ms,
+                              float             _nstd)
+{
+    unsigned int n = 1001;
+    unsigned int i;
+    modem q = modem_create(_ms);
+
+    unsigned int  s[n], s_hat[n];
+    float complex y[n], x[n];
+    for (i=0; i<n; i++)
+        s[i] = modem_gen_rand_sym(q);
+    modem_modulate_block(q, s, n, y);
+
+    // residual phase after coarse correction: 0.1 rad offset, drift
+    // of 2e-4 rad/symbol and slow sinusoidal wander
+    for (i=0; i<n; i++) {
+        float phi = 0.1f + 2e-4f*i + 0.05f*sinf(2*M_PI*i/700.0f);
+        x[i] = y[i]*cexpf(_Complex_I*phi) + _nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+    }
+
+    modem_recover_phase_block(q, x, n, 64);
+
+    // residual phase: average over constellation to reduce noise
+    float complex acc = 0;
+    for (i=0; i<n; i++)
+        acc += conjf(y[i]) * x[i];
+    if (liquid_autotest_verbose)
+        printf("  %-8s : residual phase %12.4e\n", modulation_types[_ms].name, cargf(acc));
+    CONTEND_DELTA(cargf(acc), 0.0f, 0.01f);
+
+    modem_demodulate_block(q, x, n, s_hat);
+    CONTEND_SAME_DATA(s, s_hat, sizeof(s));
+
+    modem_destroy(q);
+}
+
+void autotest_modem_recover_phase_bpsk()   { modem_test_recover_phase(LIQUID_MODEM_BPSK,   0.10f); }
+void autotest_modem_recover_phase_qpsk()   { modem_test_recover_phase(LIQUID_MODEM_QPSK,   0.10f); }
+void autotest_modem_recover_phase_psk8()   { modem_test_recover_phase(LIQUID_MODEM_PSK8,   0.05f); }
+void autotest_modem_recover_phase_psk16()  { modem_test_recover_phase(LIQUID_MODEM_PSK16,  0.02f); }
+void autotest_modem_recover_phase_qam16()  { modem_test_recover_phase(LIQUID_MODEM_QAM16,  0.05f); }
+void autotest_modem_recover_phase_qam64()  { modem_test_recover_phase(LIQUID_MODEM_QAM64,  0.02f); }
+void autotest_modem_recover_phase_apsk32() { modem_test_recover_phase(LIQUID_MODEM_APSK32, 0.02f); }
@@ -24,6 +24,7 @@
 // soft demodulation tests
 //
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -128,3 +129,189 @@ void autotest_demodsoft_arb128opt() { modem_test_demodsoft(LIQUID_MODEM_ARB128OP
 void autotest_demodsoft_arb256opt() { modem_test_demodsoft(LIQUID_MODEM_ARB256OPT); }
 void autotest_demodsoft_arb64vt()   { modem_test_demodsoft(LIQUID_MODEM_ARB64VT);   }
 
+
+// Compare soft bits of noisy samples against exhaustive max-log search
+// over the entire constellation; noise variance is set on the
+// demodulator if _sigma2 is not zero
+void modem_test_demodsoft_maxlog(modulation_scheme _ms,
+                                 float             _sigma2)
+{
+    modem q = modem_create(_ms);
+    modem_set_noise_variance(q, _sigma2);
+
+    unsigned int bps = modem_get_bps(q);
+    unsigned int i, j, k, s, M=1<<bps;
+    float complex c[M];
+    for (i=0; i<M; i++)
+        modem_modulate(q, i, &c[i]);
+
+    // gamma as used by demodulator
+    float gamma = liquid_modem_is_ask(_ms) ? 0.6f*M*M : 1.2f*M;
+    if (_sigma2 > 0)
+        gamma = 1.0f / _sigma2;
+
+    unsigned char soft_bits[bps];
+    for (i=0; i<500; i++) {
+        float complex x = c[rand() % M] + 0.2f*(randnf() + _Complex_I*randnf());
+        modem_demodulate_soft(q, x, &s, soft_bits);
+
+        for (k=0; k<bps; k++) {
+            float dmin_0 = 0.0f, dmin_1 = 0.0f;
+            int have_0 = 0, have_1 = 0;
+            for (j=0; j<M; j++) {
+                float d = crealf((x-c[j])*conjf(x-c[j]));
+                if ((j >> (bps-k-1)) & 1) {
+                    if (!have_1 || d < dmin_1) dmin_1 = d;
+                    have_1 = 1;
+                } else {
+                    if (!have_0 || d < dmin_0) dmin_0 = d;
+                    have_0 = 1;
+                }
+            }
+            int soft_bit = ((dmin_0 - dmin_1)*gamma)*16 + 127;
+            if (soft_bit > 255) soft_bit = 255;
+            if (soft_bit <   0) soft_bit = 0;
+            CONTEND_DELTA(soft_bits[k], soft_bit, 1);
+        }
+    }
+    modem_destroy(q);
+}
+
+// AUTOTESTS: exact max-log metrics for ASK, QAM
+void autotest_demodsoft_maxlog_ask2()      { modem_test_demodsoft_maxlog(LIQUID_MODEM_ASK2,  0.0f); }
+void autotest_demodsoft_maxlog_ask8()      { modem_test_demodsoft_maxlog(LIQUID_MODEM_ASK8,  0.0f); }
+void autotest_demodsoft_maxlog_ask64()     { modem_test_demodsoft_maxlog(LIQUID_MODEM_ASK64, 0.0f); }
+void autotest_demodsoft_maxlog_qam4()      { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM4,  0.0f); }
+void autotest_demodsoft_maxlog_qam8()      { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM8,  0.0f); }
+void autotest_demodsoft_maxlog_qam16()     { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM16, 0.0f); }
+void autotest_demodsoft_maxlog_qam32()     { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM32, 0.0f); }
+void autotest_demodsoft_maxlog_qam64()     { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM64, 0.0f); }
+void autotest_demodsoft_maxlog_qam256()    { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM256, 0.0f); }
+
+// AUTOTESTS: log-likelihood ratios scaled by noise variance
+void autotest_demodsoft_noisevar_bpsk()    { modem_test_demodsoft_maxlog(LIQUID_MODEM_BPSK,  0.50f); }
+void autotest_demodsoft_noisevar_qpsk()    { modem_test_demodsoft_maxlog(LIQUID_MODEM_QPSK,  0.20f); }
+void autotest_demodsoft_noisevar_ask8()    { modem_test_demodsoft_maxlog(LIQUID_MODEM_ASK8,  0.05f); }
+void autotest_demodsoft_noisevar_qam16()   { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM16, 0.04f); }
+void autotest_demodsoft_noisevar_qam64()   { modem_test_demodsoft_maxlog(LIQUID_MODEM_QAM64, 0.01f); }
+
+// Reduced soft bit precision: per-sample and block outputs should both
+// equal the 8-bit soft bits with the low-order bits replaced
+void modem_test_demodsoft_precision(modulation_scheme _ms,
+                                    unsigned int      _nbits)
+{
+    modem q0 = modem_create(_ms);
+    modem q1 = modem_create(_ms);
+    modem q2 = modem_create(_ms);
+    modem_set_soft_precision(q1, _nbits);
+    modem_set_soft_precision(q2, _nbits);
+
+    unsigned int bps = modem_get_bps(q0);
+    unsigned int i, k, n=64;
+    float complex x[n];
+    unsigned int s0[n], s1[n], s2[n];
+    unsigned char soft0[n*bps], soft1[n*bps], soft2[n*bps];
+    for (i=0; i<n; i++) {
+        modem_modulate(q0, modem_gen_rand_sym(q0), &x[i]);
+        x[i] += 0.2f*(randnf() + _Complex_I*randnf());
+        modem_demodulate_soft(q0, x[i], &s0[i], &soft0[i*bps]);
+        modem_demodulate_soft(q1, x[i], &s1[i], &soft1[i*bps]);
+    }
+    modem_demodulate_soft_block(q2, x, n, s2, soft2);
+
+    unsigned int shift = 8 - _nbits;
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(s0[i], s1[i]);
+        CONTEND_EQUALITY(s0[i], s2[i]);
+    }
+    for (k=0; k<n*bps; k++) {
+        unsigned int b = soft0[k] >> shift;
+        unsigned int v = (b << shift) | (b >> (_nbits - shift));
+        CONTEND_EQUALITY(soft1[k], v);
+        CONTEND_DELTA(soft2[k], v, 1 << shift);
+    }
+
+    modem_destroy(q0);
+    modem_destroy(q1);
+    modem_destroy(q2);
+}
+
+// AUTOTESTS: reduced soft bit precision
+void autotest_demodsoft_precision_qpsk4()   { modem_test_demodsoft_precision(LIQUID_MODEM_QPSK,  4); }
+void autotest_demodsoft_precision_qam16_4() { modem_test_demodsoft_precision(LIQUID_MODEM_QAM16, 4); }
+void autotest_demodsoft_precision_qam16_6() { modem_test_demodsoft_precision(LIQUID_MODEM_QAM16, 6); }
+void autotest_demodsoft_precision_psk8_6()  { modem_test_demodsoft_precision(LIQUID_MODEM_PSK8,  6); }
+
+
+// AUTOTEST: block soft-bit conversion against single-symbol reference
+void autotest_demodsoft_block_conversion()
+{
+    unsigned int n = 37;
+    unsigned int bps;
+    unsigned int i;
+    for (bps=1; bps<=8; bps++) {
+        unsigned int  syms[n], syms_out[n], sym;
+        unsigned char soft[8*n], soft_ref[8*n];
+        for (i=0; i<n; i++)
+            syms[i] = (i*0x9d + 7) & ((1<<bps)-1);
+
+        // symbols to soft bits
+        liquid_unpack_soft_bits_block(syms, n, bps, soft);
+        for (i=0; i<n; i++)
+            liquid_unpack_soft_bits(syms[i], bps, &soft_ref[i*bps]);
+        CONTEND_SAME_DATA(soft, soft_ref, n*bps);
+
+        // soft bits to symbols, with intermediate values
+        for (i=0; i<n*bps; i++)
+            soft[i] = soft[i] ? 128 + (i % 128) : 127 - (i % 128);
+        liquid_pack_soft_bits_block(soft, n, bps, syms_out);
+        for (i=0; i<n; i++) {
+            liquid_pack_soft_bits(&soft[i*bps], bps, &sym);
+            CONTEND_EQUALITY(syms_out[i], sym);
+            CONTEND_EQUALITY(syms_out[i], syms[i]);
+        }
+    }
+
+    // bytes to soft bits and back
+    unsigned char msg[n], msg_out[n], soft[8*n];
+    for (i=0; i<n; i++)
+        msg[i] = (i*0x3b + 11) & 0xff;
+    liquid_unpack_soft_bytes(msg, n, soft);
+    for (i=0; i<n; i++) {
+        unsigned int sym;
+        liquid_pack_soft_bits(&soft[8*i], 8, &sym);
+        CONTEND_EQUALITY(sym, msg[i]);
+    }
+    liquid_pack_soft_bytes(soft, n, msg_out);
+    CONTEND_SAME_DATA(msg, msg_out, n);
+}
+
+// AUTOTEST: soft-bit scaling saturates and preserves hard decisions
+void autotest_demodsoft_scale()
+{
+    unsigned char soft[256];
+    unsigned int i;
+
+    // unity scale is lossless
+    for (i=0; i<256; i++) soft[i] = i;
+    liquid_scale_soft_bits(soft, 256, 1.0f);
+    for (i=0; i<256; i++)
+        CONTEND_EQUALITY(soft[i], i);
+
+    // attenuation keeps every hard decision
+    liquid_scale_soft_bits(soft, 256, 0.01f);
+    for (i=0; i<256; i++)
+        CONTEND_EQUALITY(soft[i] > LIQUID_SOFTBIT_ERASURE, i > LIQUID_SOFTBIT_ERASURE);
+    CONTEND_EQUALITY(soft[0],   126);
+    CONTEND_EQUALITY(soft[255], 129);
+
+    // amplification saturates to the soft-bit range
+    for (i=0; i<256; i++) soft[i] = i;
+    liquid_scale_soft_bits(soft, 256, 4.0f);
+    CONTEND_EQUALITY(soft[  0],   0);
+    CONTEND_EQUALITY(soft[ 64],   0);
+    CONTEND_EQUALITY(soft[127], 125);
+    CONTEND_EQUALITY(soft[128], 130);
+    CONTEND_EQUALITY(soft[200], 255);
+    CONTEND_EQUALITY(soft[255], 255);
+}
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -27,7 +28,19 @@
 (   struct rusage *_start,                                  \
     struct rusage *_finish,                                 \
     unsigned long int *_num_iterations)                     \
-{ firpfbch2_crcf_execute_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, TYPE); }
+{ firpfbch2_crcf_execute_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, TYPE, 0); }
+
+#define FIRPFBCH2_MASK_BENCH_API(NUM_CHANNELS,M,NUM_ACTIVE) \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ firpfbch2_crcf_execute_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, LIQUID_ANALYZER, NUM_ACTIVE); }
+
+#define FIRPFBCH2_BLOCK_BENCH_API(NUM_CHANNELS,M,TYPE)      \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ firpfbch2_crcf_block_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, TYPE); }
 
 // Helper function to keep code base small
 void firpfbch2_crcf_execute_bench(struct rusage *     _start,
@@ -35,7 +48,8 @@ void firpfbch2_crcf_execute_bench(struct rusage *     _start,
                                   unsigned long int * _num_iterations,
                                   unsigned int        _num_channels,
                                   unsigned int        _m,
-                                  int                 _type)
+                                  int                 _type,
+                                  unsigned int        _num_active)
 {
     // initialize channelizer
     float As         = 60.0f;
@@ -43,6 +57,14 @@ void firpfbch2_crcf_execute_bench(struct rusage *     _start,
 
     unsigned long int i;
 
+    // active channel subset (0: all channels)
+    if (_num_active > 0) {
+        unsigned char mask[_num_channels];
+        for (i=0; i<_num_channels; i++)
+            mask[i] = (i % (_num_channels/_num_active)) == 0 ? 1 : 0;
+        firpfbch2_crcf_set_channel_mask(q, mask);
+    }
+
     float complex x[_num_channels];
     float complex y[_num_channels];
     for (i=0; i<_num_channels; i++)
@@ -66,6 +88,44 @@ void firpfbch2_crcf_execute_bench(struct rusage *     _start,
     firpfbch2_crcf_destroy(q);
 }
 
+// Helper function to keep code base small (block execution)
+void firpfbch2_crcf_block_bench(struct rusage *     _start,
+                                struct rusage *     _finish,
+                                unsigned long int * _num_iterations,
+                                unsigned int        _num_channels,
+                                unsigned int        _m,
+                                int                 _type)
+{
+    // initialize channelizer
+    float As         = 60.0f;
+    firpfbch2_crcf q = firpfbch2_crcf_create_kaiser(_type,_num_channels,_m,As);
+
+    unsigned long int i;
+
+    // 64 transforms per block
+    unsigned int num = 64;
+    float complex * x = (float complex*) malloc(num*_num_channels*sizeof(float complex));
+    float complex * y = (float complex*) malloc(num*_num_channels*sizeof(float complex));
+    for (i=0; i<num*_num_channels; i++)
+        x[i] = 1.0f + _Complex_I*1.0f;
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= _num_channels*num/4;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        firpfbch2_crcf_execute_block(q, x, num, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num;
+
+    free(x);
+    free(y);
+    firpfbch2_crcf_destroy(q);
+}
+
 // analysis
 void benchmark_firpfbch2_crcf_a4    FIRPFBCH2_EXECUTE_BENCH_API(4,    2,  LIQUID_ANALYZER)
 void benchmark_firpfbch2_crcf_a16   FIRPFBCH2_EXECUTE_BENCH_API(16,   2,  LIQUID_ANALYZER)
@@ -74,6 +134,17 @@ void benchmark_firpfbch2_crcf_a256  FIRPFBCH2_EXECUTE_BENCH_API(256,  2,  LIQUID
 void benchmark_firpfbch2_crcf_a512  FIRPFBCH2_EXECUTE_BENCH_API(512,  2,  LIQUID_ANALYZER)
 void benchmark_firpfbch2_crcf_a1024 FIRPFBCH2_EXECUTE_BENCH_API(1024, 2,  LIQUID_ANALYZER)
 
+// analysis, active channel subset
+void benchmark_firpfbch2_crcf_a64_k1  FIRPFBCH2_MASK_BENCH_API(64,   2,  1)
+void benchmark_firpfbch2_crcf_a64_k4  FIRPFBCH2_MASK_BENCH_API(64,   2,  4)
+void benchmark_firpfbch2_crcf_a64_k8  FIRPFBCH2_MASK_BENCH_API(64,   2,  8)
+void benchmark_firpfbch2_crcf_a64_k16 FIRPFBCH2_MASK_BENCH_API(64,   2,  16)
+void benchmark_firpfbch2_crcf_a256_k4 FIRPFBCH2_MASK_BENCH_API(256,  2,  4)
+
+// analysis, block execution
+void benchmark_firpfbch2_crcf_a64_block     FIRPFBCH2_BLOCK_BENCH_API(64,   2,  LIQUID_ANALYZER)
+void benchmark_firpfbch2_crcf_a256_block    FIRPFBCH2_BLOCK_BENCH_API(256,  2,  LIQUID_ANALYZER)
+
 // synthesis
 void benchmark_firpfbch2_crcf_s4    FIRPFBCH2_EXECUTE_BENCH_API(4,    2,  LIQUID_SYNTHESIZER)
 void benchmark_firpfbch2_crcf_s16   FIRPFBCH2_EXECUTE_BENCH_API(16,   2,  LIQUID_SYNTHESIZER)
@@ -82,4 +153,7 @@ void benchmark_firpfbch2_crcf_s256  FIRPFBCH2_EXECUTE_BENCH_API(256,  2,  LIQUID
 void benchmark_firpfbch2_crcf_s512  FIRPFBCH2_EXECUTE_BENCH_API(512,  2,  LIQUID_SYNTHESIZER)
 void benchmark_firpfbch2_crcf_s1024 FIRPFBCH2_EXECUTE_BENCH_API(1024, 2,  LIQUID_SYNTHESIZER)
 
+// synthesis, block execution
+void benchmark_firpfbch2_crcf_s64_block     FIRPFBCH2_BLOCK_BENCH_API(64,   2,  LIQUID_SYNTHESIZER)
+void benchmark_firpfbch2_crcf_s256_block    FIRPFBCH2_BLOCK_BENCH_API(256,  2,  LIQUID_SYNTHESIZER)
 
@@ -84,4 +84,8 @@ void benchmark_firpfbch_crcf_a256    FIRPFBCH_EXECUTE_BENCH_API(256,  2,  LIQUID
 void benchmark_firpfbch_crcf_a512    FIRPFBCH_EXECUTE_BENCH_API(512,  2,  LIQUID_ANALYZER)
 void benchmark_firpfbch_crcf_a1024   FIRPFBCH_EXECUTE_BENCH_API(1024, 2,  LIQUID_ANALYZER)
 
+void benchmark_firpfbch_crcf_s4      FIRPFBCH_EXECUTE_BENCH_API(4,    2,  LIQUID_SYNTHESIZER)
+void benchmark_firpfbch_crcf_s16     FIRPFBCH_EXECUTE_BENCH_API(16,   2,  LIQUID_SYNTHESIZER)
+void benchmark_firpfbch_crcf_s64     FIRPFBCH_EXECUTE_BENCH_API(64,   2,  LIQUID_SYNTHESIZER)
+void benchmark_firpfbch_crcf_s256    FIRPFBCH_EXECUTE_BENCH_API(256,  2,  LIQUID_SYNTHESIZER)
 
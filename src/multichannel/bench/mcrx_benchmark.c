@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define MCRX_BENCH_API(NUM_CHANNELS,NUM_THREADS)            \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ mcrx_bench(_start, _finish, _num_iterations, NUM_CHANNELS, NUM_THREADS); }
+
+// per-channel pipeline: filter and decimate, standing in for
+// symbol tracking or frame synchronization
+static int mcrx_bench_callback(unsigned int    _channel,
+                               float complex * _x,
+                               unsigned int    _n,
+                               void *          _userdata)
+{
+    firfilt_crcf f = (firfilt_crcf) _userdata;
+    float complex y;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        firfilt_crcf_push(f, _x[i]);
+        firfilt_crcf_execute(f, &y);
+    }
+    return 0;
+}
+
+// Helper function to keep code base small
+void mcrx_bench(struct rusage *     _start,
+                struct rusage *     _finish,
+                unsigned long int * _num_iterations,
+                unsigned int        _num_channels,
+                unsigned int        _num_threads)
+{
+    unsigned long int i;
+    unsigned int block_len = 64;
+
+    // per-channel filters
+    firfilt_crcf f[_num_channels];
+    void * userdata[_num_channels];
+    for (i=0; i<_num_channels; i++) {
+        f[i] = firfilt_crcf_create_kaiser(33, 0.2f, 60.0f, 0.0f);
+        userdata[i] = f[i];
+    }
+    mcrx q = mcrx_create(_num_channels, _num_threads, 4*block_len,
+                         mcrx_bench_callback, userdata);
+
+    float complex * y = (float complex*) malloc(block_len*_num_channels*sizeof(float complex));
+    for (i=0; i<block_len*_num_channels; i++)
+        y[i] = randnf() + _Complex_I*randnf();
+
+    // one iteration per block of transforms
+    *_num_iterations /= _num_channels*block_len;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        mcrx_execute(q, y, block_len);
+    mcrx_flush(q);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _num_channels*block_len;
+
+    mcrx_destroy(q);
+    for (i=0; i<_num_channels; i++)
+        firfilt_crcf_destroy(f[i]);
+    free(y);
+}
+
+// serial execution in calling thread
+void benchmark_mcrx_c16_t0  MCRX_BENCH_API(16, 0)
+void benchmark_mcrx_c64_t0  MCRX_BENCH_API(64, 0)
+
+// worker pool
+void benchmark_mcrx_c16_t1  MCRX_BENCH_API(16, 1)
+void benchmark_mcrx_c16_t3  MCRX_BENCH_API(16, 3)
+void benchmark_mcrx_c64_t3  MCRX_BENCH_API(64, 3)
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define OFDMFRAMESYNC_SEEK_BENCH_API(M,AC)          \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ ofdmframesync_seek_bench(_start, _finish, _num_iterations, M, AC); }
+
+// Helper function to keep code base small; idle channel (noise only)
+//  _num_subcarriers    :   number of subcarriers
+//  _ac                 :   autocorrelation seek threshold (0: disabled)
+void ofdmframesync_seek_bench(struct rusage *_start,
+                              struct rusage *_finish,
+                              unsigned long int *_num_iterations,
+                              unsigned int _num_subcarriers,
+                              float        _ac)
+{
+    // options
+    unsigned int M           = _num_subcarriers;
+    unsigned int cp_len      = M/8;
+    unsigned int num_samples = 1024;
+
+    ofdmframesync fs = ofdmframesync_create(M,cp_len,0,NULL,NULL,NULL);
+    ofdmframesync_set_seek_autocorr(fs, _ac);
+
+    unsigned int i;
+    float complex y[num_samples];
+    for (i=0; i<num_samples; i++)
+        y[i] = 0.1f*(randnf() + _Complex_I*randnf());
+
+    // start trials
+    *_num_iterations /= 256;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        ofdmframesync_execute(fs,y,num_samples);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num_samples;
+
+    ofdmframesync_destroy(fs);
+}
+
+//
+void benchmark_ofdmframesync_seek_n64       OFDMFRAMESYNC_SEEK_BENCH_API(64,  0.0f)
+void benchmark_ofdmframesync_seek_n256      OFDMFRAMESYNC_SEEK_BENCH_API(256, 0.0f)
+void benchmark_ofdmframesync_seek_ac_n64    OFDMFRAMESYNC_SEEK_BENCH_API(64,  0.5f)
+void benchmark_ofdmframesync_seek_ac_n256   OFDMFRAMESYNC_SEEK_BENCH_API(256, 0.5f)
+
@@ -33,6 +33,10 @@
 
 #include "liquid.internal.h"
 
+// history samples beyond the sub-filter length held in each row of the
+// history matrix; rows are compacted once this is used up
+#define FIRPFBCH_HEADROOM   (32)
+
 // firpfbch object structure definition
 struct FIRPFBCH(_s) {
     int type;                   // synthesis/analysis
@@ -43,10 +47,20 @@ struct FIRPFBCH(_s) {
     unsigned int h_len;         // filter length
     TC * h;                     // filter coefficients
     
-    // create separate bank of dotprod and window objects
-    DOTPROD() * dp;             // dot product object array
-    WINDOW() * w;               // window buffer object array
-    unsigned int filter_index;  // running filter index (analysis)
+    // analyzer: batched dot product across all sub-filters, reading
+    // from a history matrix with one row per sub-filter holding its
+    // most recent samples contiguously; all rows advance together
+    DOTPROD(_batch) dpb;        // batched dot product object
+    TI ** r;                    // batch input pointers [size: M x 1]
+    TO *  y;                    // batch output array   [size: M x 1]
+    TI * hist;                  // history matrix [size: M x stride]
+    unsigned int stride;        // row stride: p + FIRPFBCH_HEADROOM
+    unsigned int hn;            // samples in each row, >= p
+
+    // synthesizer: overlap-add accumulator, a ring of the p output
+    // blocks that the most recent transform outputs contribute to
+    TO * acc;                   // partial output blocks [size: p x M]
+    unsigned int acc_index;     // row of next output block
 
     // fft plan
     FFT_PLAN fft;               // fft|ifft object
@@ -54,15 +68,11 @@ struct FIRPFBCH(_s) {
     TO * X;                     // fft|ifft transform output array
 };
 
-// 
+//
 // forward declaration of internal methods
 //
 
-void FIRPFBCH(_analyzer_push)(FIRPFBCH() _q, TI _x);
-
-void FIRPFBCH(_analyzer_run)(FIRPFBCH()   _q,
-                             unsigned int _k,
-                             TO *         _X);
+void FIRPFBCH(_hist_reserve)(FIRPFBCH() _q, unsigned int _n);
 
 
 // create FIR polyphase filterbank channelizer object
@@ -88,7 +98,7 @@ FIRPFBCH() FIRPFBCH(_create)(int          _type,
     }
 
     // create main object
-    FIRPFBCH() q = (FIRPFBCH()) malloc(sizeof(struct FIRPFBCH(_s)));
+    FIRPFBCH() q = (FIRPFBCH()) liquid_malloc(sizeof(struct FIRPFBCH(_s)));
 
     // set user-defined properties
     q->type         = _type;
@@ -98,35 +108,41 @@ FIRPFBCH() FIRPFBCH(_create)(int          _type,
     // derived values
     q->h_len = q->num_channels * q->p;
 
-    // create bank of filters
-    q->dp = (DOTPROD()*) malloc((q->num_channels)*sizeof(DOTPROD()));
-    q->w  = (WINDOW()*)  malloc((q->num_channels)*sizeof(WINDOW()));
-
     // copy filter coefficients
-    q->h = (TC*) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC*) liquid_malloc((q->h_len)*sizeof(TC));
     unsigned int i;
     for (i=0; i<q->h_len; i++)
         q->h[i] = _h[i];
 
-    // generate bank of sub-samped filters
-    unsigned int n;
-    unsigned int h_sub_len = q->p;
-    TC h_sub[h_sub_len];
-    for (i=0; i<q->num_channels; i++) {
-        // sub-sample prototype filter, loading coefficients in reverse order
-        for (n=0; n<h_sub_len; n++) {
-            h_sub[h_sub_len-n-1] = q->h[i + n*(q->num_channels)];
+    if (q->type == LIQUID_ANALYZER) {
+        // generate bank of sub-samped filters
+        unsigned int n;
+        unsigned int h_sub_len = q->p;
+        TC * h_sub = (TC*) liquid_malloc((q->num_channels)*h_sub_len*sizeof(TC));
+        for (i=0; i<q->num_channels; i++) {
+            // sub-sample prototype filter, loading coefficients in reverse order
+            for (n=0; n<h_sub_len; n++) {
+                h_sub[i*h_sub_len + h_sub_len-n-1] = q->h[i + n*(q->num_channels)];
+            }
         }
-        // create window buffer and dotprod object (coefficients
-        // loaded in reverse order)
-        q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
-        q->w[i]  = WINDOW(_create)(h_sub_len);
+
+        // create batched dotprod object and history matrix
+        q->dpb    = DOTPROD(_batch_create)(h_sub, h_sub_len, q->num_channels);
+        q->r      = (TI**) liquid_malloc((q->num_channels)*sizeof(TI*));
+        q->y      = (TO*)  liquid_malloc((q->num_channels)*sizeof(TO));
+        q->stride = h_sub_len + FIRPFBCH_HEADROOM;
+        q->hist   = (TI*)  liquid_malloc((q->num_channels)*q->stride*sizeof(TI));
+        liquid_free(h_sub);
+    } else {
+        // overlap-add accumulator; row n of the prototype, h[n*M + i],
+        // weights the transform output for the n-th following block
+        q->acc = (TO*) liquid_malloc((q->p)*(q->num_channels)*sizeof(TO));
     }
 
     // allocate memory for buffers
     // TODO : use fftw_malloc if HAVE_FFTW3_H
-    q->x = (T*) malloc((q->num_channels)*sizeof(T));
-    q->X = (T*) malloc((q->num_channels)*sizeof(T));
+    q->x = (T*) liquid_malloc((q->num_channels)*sizeof(T));
+    q->X = (T*) liquid_malloc((q->num_channels)*sizeof(T));
 
     // create fft plan
     if (q->type == LIQUID_ANALYZER)
@@ -258,26 +274,26 @@ FIRPFBCH() FIRPFBCH(_create_rnyquist)(int          _type,
 // destroy firpfbch object
 void FIRPFBCH(_destroy)(FIRPFBCH() _q)
 {
-    unsigned int i;
-
-    // free dot product, window objects and arrays
-    for (i=0; i<_q->num_channels; i++) {
-        DOTPROD(_destroy)(_q->dp[i]);
-        WINDOW(_destroy)(_q->w[i]);
+    if (_q->type == LIQUID_ANALYZER) {
+        // free batched dot product object and history
+        DOTPROD(_batch_destroy)(_q->dpb);
+        liquid_free(_q->r);
+        liquid_free(_q->y);
+        liquid_free(_q->hist);
+    } else {
+        liquid_free(_q->acc);
     }
-    free(_q->dp);
-    free(_q->w);
 
     // free transform object
     FFT_DESTROY_PLAN(_q->fft);
 
     // free additional arrays
-    free(_q->h);
-    free(_q->x);
-    free(_q->X);
+    liquid_free(_q->h);
+    liquid_free(_q->x);
+    liquid_free(_q->X);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // clear/reset firpfbch object internals
@@ -285,11 +301,19 @@ void FIRPFBCH(_reset)(FIRPFBCH() _q)
 {
     unsigned int i;
     for (i=0; i<_q->num_channels; i++) {
-        WINDOW(_clear)(_q->w[i]);
         _q->x[i] = 0;
         _q->X[i] = 0;
     }
-    _q->filter_index = _q->num_channels-1;
+
+    if (_q->type == LIQUID_ANALYZER) {
+        // clear history, leaving a full sub-filter length of zeros
+        memset(_q->hist, 0x00, _q->num_channels*_q->stride*sizeof(TI));
+        _q->hn = _q->p;
+    } else {
+        // clear partial output blocks
+        memset(_q->acc, 0x00, _q->p*_q->num_channels*sizeof(TO));
+        _q->acc_index = 0;
+    }
 }
 
 // print firpfbch object
@@ -303,6 +327,7 @@ void FIRPFBCH(_print)(FIRPFBCH() _q)
         printf("  h[%3u] = %12.8f + %12.8f*j\n", i, crealf(_q->h[i]), cimagf(_q->h[i]));
 }
 
+
 // 
 // SYNTHESIZER
 //
@@ -315,23 +340,52 @@ void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,
                                     TI * _x,
                                     TO * _y)
 {
-    unsigned int i;
-
-    // copy channelized symbols to transform input
-    memmove(_q->X, _x, _q->num_channels*sizeof(TI));
-
-    // execute inverse DFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->fft);
+    FIRPFBCH(_synthesizer_execute_block)(_q, _x, 1, _y);
+}
 
-    // push samples into filter bank and execute
-    T * r;      // read pointer
-    for (i=0; i<_q->num_channels; i++) {
-        WINDOW(_push)(_q->w[i], _q->x[i]);
-        WINDOW(_read)(_q->w[i], &r);
-        DOTPROD(_execute)(_q->dp[i], r, &_y[i]);
+// execute filterbank as synthesizer on _n blocks of samples by
+// overlap-add: each transform output, weighted by the p rows of the
+// prototype filter, is accumulated into the current and the p-1
+// following output blocks, so all loops run contiguously across the
+// channels rather than through M sub-filter dot products of length p
+//  _q      :   filterbank channelizer object
+//  _x      :   channelized input, [size: _n*num_channels x 1]
+//  _n      :   number of blocks
+//  _y      :   output time series, [size: _n*num_channels x 1]
+void FIRPFBCH(_synthesizer_execute_block)(FIRPFBCH()   _q,
+                                          TI *         _x,
+                                          unsigned int _n,
+                                          TO *         _y)
+{
+    unsigned int M = _q->num_channels;
+    unsigned int i, j, n;
+
+    for (j=0; j<_n; j++) {
+        // copy channelized symbols to transform input
+        memmove(_q->X, &_x[j*M], M*sizeof(TI));
+
+        // execute inverse DFT, store result in buffer 'x'
+        FFT_EXECUTE(_q->fft);
+        const TO * x = _q->x;
+
+        // complete current output block and clear its row for reuse
+        TO * a = _q->acc + _q->acc_index*M;
+        TO * y = &_y[j*M];
+        for (i=0; i<M; i++) {
+            y[i] = a[i] + _q->h[i]*x[i];
+            a[i] = 0;
+        }
 
-        // normalize by DFT scaling factor
-        //_y[i] /= (float) (_q->num_channels);
+        // accumulate into following blocks
+        unsigned int k = _q->acc_index;
+        for (n=1; n<_q->p; n++) {
+            k = (k + 1 == _q->p) ? 0 : k + 1;
+            a = _q->acc + k*M;
+            const TC * h = _q->h + n*M;
+            for (i=0; i<M; i++)
+                a[i] += h[i]*x[i];
+        }
+        _q->acc_index = (_q->acc_index + 1 == _q->p) ? 0 : _q->acc_index + 1;
     }
 }
 
@@ -347,65 +401,79 @@ void FIRPFBCH(_analyzer_execute)(FIRPFBCH() _q,
                                  TI * _x,
                                  TO * _y)
 {
-    unsigned int i;
+    FIRPFBCH(_analyzer_execute_block)(_q, _x, 1, _y);
+}
 
-    // push samples into buffers
-    for (i=0; i<_q->num_channels; i++)
-        FIRPFBCH(_analyzer_push)(_q, _x[i]);
+// execute filterbank as analyzer on _n blocks of samples; all inputs
+// of a chunk are first written to the history matrix, then the
+// sub-filters and transform are run for each block
+//  _q      :   filterbank channelizer object
+//  _x      :   input time series, [size: _n*num_channels x 1]
+//  _n      :   number of blocks
+//  _y      :   channelized output, [size: _n*num_channels x 1]
+void FIRPFBCH(_analyzer_execute_block)(FIRPFBCH()   _q,
+                                       TI *         _x,
+                                       unsigned int _n,
+                                       TO *         _y)
+{
+    unsigned int M = _q->num_channels;
+    unsigned int i, j;
+
+    while (_n > 0) {
+        unsigned int num = _n < FIRPFBCH_HEADROOM ? _n : FIRPFBCH_HEADROOM;
+        FIRPFBCH(_hist_reserve)(_q, num);
+
+        // push samples into buffers, starting with the last filter
+        // and moving in the negative direction
+        for (j=0; j<num; j++) {
+            TI * h = _q->hist + M*_q->stride + _q->hn + j;
+            const TI * x = &_x[j*M];
+            for (i=0; i<M; i++) {
+                h -= _q->stride;
+                *h = x[i];
+            }
+        }
 
-    // execute analysis filters on the given input starting
-    // with filterbank at index zero
-    FIRPFBCH(_analyzer_run)(_q, 0, _y);
+        for (j=0; j<num; j++) {
+            // execute filter outputs, reversing order of output (not
+            // sure why this is necessary)
+            for (i=0; i<M; i++)
+                _q->r[i] = _q->hist + i*_q->stride + _q->hn + j + 1 - _q->p;
+            DOTPROD(_execute_batch)(_q->dpb, _q->r, _q->y);
+            for (i=0; i<M; i++)
+                _q->X[M-i-1] = _q->y[i];
+
+            // execute DFT, store result in buffer 'x'
+            FFT_EXECUTE(_q->fft);
+
+            // move to output array
+            memmove(&_y[j*M], _q->x, M*sizeof(TO));
+        }
+
+        _q->hn += num;
+        _x += num*M;
+        _y += num*M;
+        _n -= num;
+    }
 }
 
 // 
 // internal methods
 //
 
-// push single sample into analysis filterbank, updating index
-// counter appropriately
-//  _q      :   filterbank channelizer object
-//  _x      :   input sample
-void FIRPFBCH(_analyzer_push)(FIRPFBCH() _q,
-                              TI _x)
+// make room for _n samples in each row of the history matrix, moving
+// the most recent p samples to the start of the rows when necessary
+void FIRPFBCH(_hist_reserve)(FIRPFBCH()   _q,
+                             unsigned int _n)
 {
-    // push sample into filter
-    WINDOW(_push)(_q->w[_q->filter_index], _x);
-
-    // decrement filter index
-    _q->filter_index = (_q->filter_index + _q->num_channels - 1) % _q->num_channels;
-}
+    if (_q->hn + _n <= _q->stride)
+        return;
 
-// run filterbank analyzer dot products, DFT
-//  _q      :   filterbank channelizer object
-//  _k      :   filterbank alignment index
-//  _y      :   output array, [size: num_channels x 1]
-void FIRPFBCH(_analyzer_run)(FIRPFBCH() _q,
-                             unsigned int _k,
-                             TO * _y)
-{
     unsigned int i;
-
-    // execute filter outputs, reversing order of output (not
-    // sure why this is necessary)
-    T * r;  // read pointer
-    unsigned int index;
     for (i=0; i<_q->num_channels; i++) {
-        // compute appropriate index
-        index = (i+_k) % _q->num_channels;
-
-        // read buffer at specified index
-        WINDOW(_read)(_q->w[index], &r);
-
-        // compute dot product
-        DOTPROD(_execute)(_q->dp[i], r, &_q->X[_q->num_channels-i-1]);
+        TI * row = _q->hist + i*_q->stride;
+        memmove(row, row + _q->hn - _q->p, _q->p*sizeof(TI));
     }
-
-    // execute DFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->fft);
-
-    // move to output array
-    memmove(_y, _q->x, _q->num_channels*sizeof(TO));
+    _q->hn = _q->p;
 }
 
-
@@ -32,6 +32,10 @@
 #include <string.h>
 #include <math.h>
 
+// history samples beyond the sub-filter length held in each row of the
+// history matrix; rows are compacted once this is used up
+#define FIRPFBCH2_HEADROOM  (32)
+
 // firpfbch2 object structure definition
 struct FIRPFBCH2(_s) {
     int type;           // synthesis/analysis
@@ -42,19 +46,37 @@ struct FIRPFBCH2(_s) {
     // filter
     unsigned int h_len; // prototype filter length: 2*M*m
     
-    // create separate bank of dotprod and window objects
-    DOTPROD() * dp;     // dot product object array
+    // batched dot product across all sub-filters
+    DOTPROD(_batch) dpb;// batched dot product object
+    TI ** r;            // batch input pointers  [size: M x 1]
+    TO *  y;            // batch output array    [size: M x 1]
+    liquid_float16 * h16; // half-precision sub-filters [size: M x 2m], or NULL
 
     // inverse FFT plan
     FFT_PLAN ifft;      // inverse FFT object
     TO * X;             // IFFT input array  [size: M x 1]
     TO * x;             // IFFT output array [size: M x 1]
 
-    // common data structures shared between analysis and
-    // synthesis algorithms
-    WINDOW() * w0;      // window buffer object array
-    WINDOW() * w1;      // window buffer object array (synthesizer only)
-    int flag;           // flag indicating filter/buffer alignment
+    // active channel subset (analyzer only); when sparse enough the
+    // active outputs are evaluated directly from the dot products
+    // instead of running the full transform
+    unsigned char * mask;           // channel mask, [size: M x 1]
+    unsigned int    num_active;     // number of active channels
+    unsigned int *  active;         // active channel indices
+    int             direct;         // evaluate active outputs directly?
+    dotprod_cccf *  dp_out;         // scaled transform rows, active channels
+    TO *            y_out;          // active channel outputs
+
+    // history matrix, one row per sub-filter buffer (analyzer: M,
+    // synthesizer: 2M), each holding its most recent samples
+    // contiguously so that sub-filter inputs are plain pointers. Rows
+    // form two groups (analyzer: lower/upper half of the filterbank,
+    // synthesizer: buffer 0/1) which are written together.
+    TI * hist;              // history matrix [size: num_rows x stride]
+    unsigned int num_rows;  // number of rows
+    unsigned int stride;    // row stride: 2*m + FIRPFBCH2_HEADROOM
+    unsigned int hn[2];     // samples in each row of group, >= 2*m
+    int flag;               // flag indicating filter/buffer alignment
 };
 
 // create firpfbch2 object
@@ -81,7 +103,7 @@ FIRPFBCH2() FIRPFBCH2(_create)(int          _type,
     }
 
     // create object
-    FIRPFBCH2() q = (FIRPFBCH2()) malloc(sizeof(struct FIRPFBCH2(_s)));
+    FIRPFBCH2() q = (FIRPFBCH2()) liquid_malloc(sizeof(struct FIRPFBCH2(_s)));
 
     // set input parameters
     q->type     = _type;        // channelizer type (e.g. LIQUID_ANALYZER)
@@ -93,35 +115,47 @@ FIRPFBCH2() FIRPFBCH2(_create)(int          _type,
     q->M2       = q->M / 2;     // number of channels / 2
 
     // generate bank of sub-samped filters
-    q->dp = (DOTPROD()*) malloc((q->M)*sizeof(DOTPROD()));
     unsigned int i;
     unsigned int n;
     unsigned int h_sub_len = 2 * q->m;
-    TC h_sub[h_sub_len];
+    TC * h_sub = (TC*) liquid_malloc((q->M)*h_sub_len*sizeof(TC));
     for (i=0; i<q->M; i++) {
         // sub-sample prototype filter, loading coefficients
         // in reverse order
         for (n=0; n<h_sub_len; n++)
-            h_sub[h_sub_len-n-1] = _h[i + n*(q->M)];
-
-        // create dotprod object
-        q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
+            h_sub[i*h_sub_len + h_sub_len-n-1] = _h[i + n*(q->M)];
     }
 
+    // create batched dotprod object and its input/output arrays
+    q->dpb = DOTPROD(_batch_create)(h_sub, h_sub_len, q->M);
+    q->r   = (TI**) liquid_malloc((q->M)*sizeof(TI*));
+    q->y   = (TO*)  liquid_malloc((q->M)*sizeof(TO));
+    q->h16 = NULL;
+    liquid_free(h_sub);
+
     // create FFT plan (inverse transform)
     // TODO : use fftw_malloc if HAVE_FFTW3_H
-    q->X = (T*) malloc((q->M)*sizeof(T));   // IFFT input
-    q->x = (T*) malloc((q->M)*sizeof(T));   // IFFT output
+    q->X = (T*) liquid_malloc((q->M)*sizeof(T));   // IFFT input
+    q->x = (T*) liquid_malloc((q->M)*sizeof(T));   // IFFT output
     q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
 
-    // create buffer objects
-    q->w0 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
-    q->w1 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
+    // all channels active
+    q->mask   = (unsigned char*) liquid_malloc((q->M)*sizeof(unsigned char));
+    q->active = (unsigned int*)  liquid_malloc((q->M)*sizeof(unsigned int));
+    q->y_out  = (TO*)            liquid_malloc((q->M)*sizeof(TO));
+    q->dp_out = NULL;
+    q->direct = 0;
+    q->num_active = q->M;
     for (i=0; i<q->M; i++) {
-        q->w0[i] = WINDOW(_create)(h_sub_len);
-        q->w1[i] = WINDOW(_create)(h_sub_len);
+        q->mask[i]   = 1;
+        q->active[i] = i;
     }
 
+    // create history matrix
+    q->num_rows = (q->type == LIQUID_ANALYZER) ? q->M : 2*q->M;
+    q->stride   = h_sub_len + FIRPFBCH2_HEADROOM;
+    q->hist     = (TI*) liquid_malloc(q->num_rows*q->stride*sizeof(TI));
+
     // reset filterbank object and return
     FIRPFBCH2(_reset)(q);
     return q;
@@ -151,7 +185,7 @@ FIRPFBCH2() FIRPFBCH2(_create_kaiser)(int          _type,
 
     // design prototype filter
     unsigned int h_len = 2*_M*_m+1;
-    float * hf = (float*)malloc(h_len*sizeof(float));
+    float * hf = (float*)liquid_malloc(h_len*sizeof(float));
 
     // filter cut-off frequency (analyzer has twice the
     // bandwidth of the synthesizer)
@@ -167,7 +201,7 @@ FIRPFBCH2() FIRPFBCH2(_create_kaiser)(int          _type,
     for (i=0; i<h_len; i++) hf[i] = hf[i] * (float)_M / hf_sum;
 
     // convert to type-specific array
-    TC * h = (TC*) malloc(h_len * sizeof(TC));
+    TC * h = (TC*) liquid_malloc(h_len * sizeof(TC));
     for (i=0; i<h_len; i++)
         h[i] = (TC) hf[i];
 
@@ -175,50 +209,60 @@ FIRPFBCH2() FIRPFBCH2(_create_kaiser)(int          _type,
     FIRPFBCH2() q = FIRPFBCH2(_create)(_type, _M, _m, h);
 
     // free prototype filter coefficients
-    free(hf);
-    free(h);
+    liquid_free(hf);
+    liquid_free(h);
 
     // return object
     return q;
 }
 
-// destroy firpfbch2 object, freeing internal memory
-void FIRPFBCH2(_destroy)(FIRPFBCH2() _q)
+// destroy direct evaluation objects
+void FIRPFBCH2(_destroy_direct)(FIRPFBCH2() _q)
 {
+    if (_q->dp_out == NULL)
+        return;
+
     unsigned int i;
+    for (i=0; i<_q->num_active; i++)
+        dotprod_cccf_destroy(_q->dp_out[i]);
+    liquid_free(_q->dp_out);
+    _q->dp_out = NULL;
+}
 
-    // free dotprod objects
-    for (i=0; i<_q->M; i++)
-        DOTPROD(_destroy)(_q->dp[i]);
-    free(_q->dp);
+// destroy firpfbch2 object, freeing internal memory
+void FIRPFBCH2(_destroy)(FIRPFBCH2() _q)
+{
+    // free batched dotprod object and arrays
+    DOTPROD(_batch_destroy)(_q->dpb);
+    liquid_free(_q->r);
+    liquid_free(_q->y);
+    liquid_free(_q->h16);
 
     // free transform object and arrays
     FFT_DESTROY_PLAN(_q->ifft);
-    free(_q->X);
-    free(_q->x);
-    
-    // free window objects (buffers)
-    for (i=0; i<_q->M; i++) {
-        WINDOW(_destroy)(_q->w0[i]);
-        WINDOW(_destroy)(_q->w1[i]);
-    }
-    free(_q->w0);
-    free(_q->w1);
+    liquid_free(_q->X);
+    liquid_free(_q->x);
+
+    // free channel mask arrays
+    FIRPFBCH2(_destroy_direct)(_q);
+    liquid_free(_q->mask);
+    liquid_free(_q->active);
+    liquid_free(_q->y_out);
+
+    // free history matrix
+    liquid_free(_q->hist);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // reset firpfbch2 object internals
 void FIRPFBCH2(_reset)(FIRPFBCH2() _q)
 {
-    unsigned int i;
-
-    // clear window buffers
-    for (i=0; i<_q->M; i++) {
-        WINDOW(_clear)(_q->w0[i]);
-        WINDOW(_clear)(_q->w1[i]);
-    }
+    // clear history, leaving a full sub-filter length of zeros
+    memset(_q->hist, 0x00, _q->num_rows*_q->stride*sizeof(TI));
+    _q->hn[0] = 2*_q->m;
+    _q->hn[1] = 2*_q->m;
 
     // reset filter/buffer alignment flag
     _q->flag = 0;
@@ -232,106 +276,308 @@ void FIRPFBCH2(_print)(FIRPFBCH2() _q)
     printf("    h_len       :   %u\n", _q->h_len);
     printf("    semi-length :   %u\n", _q->m);
 
+    if (_q->type == LIQUID_ANALYZER)
+        printf("    active      :   %u (%s)\n", _q->num_active, _q->direct ? "direct" : "transform");
+
     // TODO: print filter coefficients...
-    unsigned int i;
-    for (i=0; i<_q->M; i++)
-        DOTPROD(_print)(_q->dp[i]);
+    DOTPROD(_batch_print)(_q->dpb);
 }
 
-// execute filterbank channelizer (analyzer)
-//  _x      :   channelizer input,  [size: M/2 x 1]
-//  _y      :   channelizer output, [size: M   x 1]
-void FIRPFBCH2(_execute_analyzer)(FIRPFBCH2() _q,
-                                  TI *        _x,
-                                  TO *        _y)
+// get memory footprint of filterbank, its transform and buffers [bytes]
+unsigned long int FIRPFBCH2(_get_memory_usage)(FIRPFBCH2() _q)
 {
-    unsigned int i;
+    unsigned long int n = sizeof(struct FIRPFBCH2(_s));
+
+    // polyphase filters and transform
+    n += DOTPROD(_batch_get_memory_usage)(_q->dpb);
+    n += _q->M*(sizeof(TI*) + 3*sizeof(TO));    // r, y, X, x
+    if (_q->h16 != NULL)
+        n += _q->M*2*_q->m*sizeof(liquid_float16);
+    n += FFT_GET_MEMORY_USAGE(_q->ifft);
+
+    // channel mask, active channels and direct evaluation rows
+    n += _q->M*(sizeof(unsigned char) + sizeof(unsigned int) + sizeof(TO));
+    if (_q->dp_out != NULL) {
+        unsigned int i;
+        n += _q->num_active*sizeof(dotprod_cccf);
+        for (i=0; i<_q->num_active; i++)
+            n += dotprod_cccf_get_memory_usage(_q->dp_out[i]);
+    }
+
+    // history matrix
+    n += _q->num_rows*_q->stride*sizeof(TI);
+    return n;
+}
+
+// get channelizer type (LIQUID_ANALYZER/LIQUID_SYNTHESIZER)
+int FIRPFBCH2(_get_type)(FIRPFBCH2() _q)
+{
+    return _q->type;
+}
+
+// get number of channels
+unsigned int FIRPFBCH2(_get_M)(FIRPFBCH2() _q)
+{
+    return _q->M;
+}
 
-    // load buffers in blocks of num_channels/2 starting
-    // in the middle of the filter bank and moving in the
-    // negative direction
-    unsigned int base_index = _q->flag ? _q->M : _q->M2;
-    for (i=0; i<_q->M2; i++) {
-        // push sample into buffer at filter index
-        WINDOW(_push)(_q->w0[base_index-i-1], _x[i]);
+// set active channel subset (analyzer only); outputs of inactive
+// channels are set to zero. When few enough channels are active the
+// active outputs are evaluated directly, otherwise the full transform
+// is run (see LIQUID_FFT_PRUNE_COST_OUTPUT).
+//  _q      :   firpfbch2 object
+//  _mask   :   channel mask, non-zero for active channels, [size: M x 1]
+//              (NULL: all channels active)
+void FIRPFBCH2(_set_channel_mask)(FIRPFBCH2()     _q,
+                                  unsigned char * _mask)
+{
+    if (_q->type != LIQUID_ANALYZER) {
+        fprintf(stderr,"error: firpfbch2_%s_set_channel_mask(), channel mask requires analyzer\n", EXTENSION_FULL);
+        exit(1);
     }
 
-    // execute filter outputs
-    unsigned int offset = _q->flag ? _q->M2 : 0;
-    TI * r;      // buffer read pointer
+    FIRPFBCH2(_destroy_direct)(_q);
+
+    unsigned int i;
+    _q->num_active = 0;
     for (i=0; i<_q->M; i++) {
-        // compute buffer index
-        unsigned int buffer_index  = (offset+i)%(_q->M);
+        _q->mask[i] = (_mask == NULL || _mask[i]) ? 1 : 0;
+        if (_q->mask[i])
+            _q->active[_q->num_active++] = i;
+    }
 
-        // read buffer at index
-        WINDOW(_read)(_q->w0[buffer_index], &r);
+    // compare cost of direct evaluation (per active channel and
+    // polyphase branch) against the full transform
+    float cost_fft    = (float)(_q->M) * log2f((float)(_q->M));
+    float cost_direct = (float)(_q->M) * (float)(_q->num_active) * LIQUID_FFT_PRUNE_COST_OUTPUT;
+    _q->direct = cost_direct < cost_fft;
+    if (!_q->direct)
+        return;
 
-        // run dot product storing result in IFFT input buffer
-        DOTPROD(_execute)(_q->dp[i], r, &_q->X[buffer_index]);
+    // inverse transform rows, scaled by 1/M: channel k output is the
+    // dot product with the polyphase outputs in natural order; the
+    // half-buffer offset of alternating runs negates odd channels
+    TO * w = (TO*) liquid_malloc((_q->M)*sizeof(TO));
+    unsigned int n;
+    _q->dp_out = (dotprod_cccf*) liquid_malloc(_q->num_active*sizeof(dotprod_cccf));
+    for (i=0; i<_q->num_active; i++) {
+        unsigned int k = _q->active[i];
+        for (n=0; n<_q->M; n++)
+            w[n] = cexpf(_Complex_I*2*M_PI*(float)((k*n) % _q->M) / (float)(_q->M)) / (float)(_q->M);
+        _q->dp_out[i] = dotprod_cccf_create(w, _q->M);
     }
+    liquid_free(w);
+}
 
-    // execute IFFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->ifft);
+// enable/disable half-precision storage of sub-filter coefficients
+//  _q      :   firpfbch2 object
+//  _enable :   non-zero to run from half-precision coefficients
+void FIRPFBCH2(_set_coeff_fp16)(FIRPFBCH2() _q,
+                                int         _enable)
+{
+    unsigned int n = _q->M * 2 * _q->m;
+    if (_enable && _q->h16 == NULL) {
+        TC * h_sub = (TC*) liquid_malloc(n*sizeof(TC));
+        DOTPROD(_batch_get_coefficients)(_q->dpb, h_sub);
+        _q->h16 = (liquid_float16*) liquid_malloc(n*sizeof(liquid_float16));
+        liquid_vectorf_to_float16(h_sub, n, _q->h16);
+        liquid_free(h_sub);
+    } else if (!_enable && _q->h16 != NULL) {
+        liquid_free(_q->h16);
+        _q->h16 = NULL;
+    }
+}
 
-    // scale result by 1/num_channels (C transform)
+// run all sub-filters on inputs _q->r, writing outputs to _q->y
+void FIRPFBCH2(_run_filters)(FIRPFBCH2() _q)
+{
+    if (_q->h16 == NULL) {
+        DOTPROD(_execute_batch)(_q->dpb, _q->r, _q->y);
+        return;
+    }
+
+    unsigned int L = 2*_q->m;
+    unsigned int i;
     for (i=0; i<_q->M; i++)
-        _y[i] = _q->x[i] / (float)(_q->M);
+        DOTPROD_F16(_run)(&_q->h16[i*L], _q->r[i], L, &_q->y[i]);
+}
 
-    // update flag
-    _q->flag = 1 - _q->flag;
+// make room for _n samples in each row of group _g, moving the most
+// recent 2*m samples to the start of the rows when necessary
+void FIRPFBCH2(_hist_reserve)(FIRPFBCH2() _q,
+                              unsigned int _g,
+                              unsigned int _n)
+{
+    if (_q->hn[_g] + _n <= _q->stride)
+        return;
+
+    unsigned int L = 2*_q->m;
+    unsigned int G = _q->num_rows / 2;
+    unsigned int i;
+    for (i=_g*G; i<(_g+1)*G; i++) {
+        TI * row = _q->hist + i*_q->stride;
+        memmove(row, row + _q->hn[_g] - L, L*sizeof(TI));
+    }
+    _q->hn[_g] = L;
 }
 
-// execute filterbank channelizer (synthesizer)
-//  _x      :   channelizer input,  [size: M   x 1]
-//  _y      :   channelizer output, [size: M/2 x 1]
-void FIRPFBCH2(_execute_synthesizer)(FIRPFBCH2() _q,
-                                     TI *        _x,
-                                     TO *        _y)
+// compute analyzer output from sub-filter outputs in _q->y
+//  _flag   :   filter/buffer alignment of this run
+//  _y      :   channelizer output, [size: M x 1]
+void FIRPFBCH2(_analyzer_output)(FIRPFBCH2() _q,
+                                 int         _flag,
+                                 TO *        _y)
 {
     unsigned int i;
 
-    // copy input array to internal IFFT input buffer
-    memmove(_q->X, _x, _q->M * sizeof(TI));
+    // evaluate active channels directly
+    if (_q->direct) {
+        for (i=0; i<_q->num_active; i++)
+            dotprod_cccf_execute(_q->dp_out[i], _q->y, &_q->y_out[i]);
+        memset(_y, 0x00, (_q->M)*sizeof(TO));
+        for (i=0; i<_q->num_active; i++) {
+            unsigned int k = _q->active[i];
+            _y[k] = (_flag && (k & 1)) ? -_q->y_out[i] : _q->y_out[i];
+        }
+        return;
+    }
+
+    // store results in IFFT input buffer at buffer index
+    unsigned int offset = _flag ? _q->M2 : 0;
+    for (i=0; i<_q->M; i++)
+        _q->X[(offset+i)%(_q->M)] = _q->y[i];
 
     // execute IFFT, store result in buffer 'x'
     FFT_EXECUTE(_q->ifft);
 
-    // TODO: ignore this scaling
     // scale result by 1/num_channels (C transform)
     for (i=0; i<_q->M; i++)
-        _q->x[i] *= 1.0f / (float)(_q->M);
-    // scale result by num_channels/2
-    for (i=0; i<_q->M; i++)
-        _q->x[i] *= (float)(_q->M2);
-
-    // push samples into appropriate buffer
-    WINDOW() * buffer = (_q->flag == 0 ? _q->w1 : _q->w0);
-    for (i=0; i<_q->M; i++)
-        WINDOW(_push)(buffer[i], _q->x[i]);
-
-    // compute filter outputs
-    TO * r0, * r1;  // buffer read pointers
-    TO   y0,   y1;  // dotprod outputs
-    for (i=0; i<_q->M2; i++) {
-        // buffer index
-        unsigned int b = (_q->flag == 0) ? i : i+_q->M2;
-
-        // read buffer with index offset
-        WINDOW(_read)(_q->w0[b], &r0);
-        WINDOW(_read)(_q->w1[b], &r1);
+        _y[i] = _q->mask[i] ? _q->x[i] / (float)(_q->M) : 0.0f;
+}
 
-        // swap buffer outputs on alternating runs
-        TO * p0 = _q->flag ? r0 : r1;
-        TO * p1 = _q->flag ? r1 : r0;
+// execute filterbank channelizer (analyzer) on block of inputs; all
+// inputs of a chunk are first written to the history matrix, then
+// the sub-filters are run for each transform
+//  _x      :   channelizer input,  [size: _n*M/2 x 1]
+//  _n      :   number of transforms
+//  _y      :   channelizer output, [size: _n*M   x 1]
+void FIRPFBCH2(_execute_analyzer)(FIRPFBCH2()  _q,
+                                  TI *         _x,
+                                  unsigned int _n,
+                                  TO *         _y)
+{
+    unsigned int L = 2*_q->m;
+    unsigned int i, j;
+
+    while (_n > 0) {
+        // runs alternate between upper (flag 1) and lower (flag 0)
+        // half of the filterbank, starting with group f
+        unsigned int num = _n < 2*FIRPFBCH2_HEADROOM ? _n : 2*FIRPFBCH2_HEADROOM;
+        unsigned int f   = _q->flag;
+        FIRPFBCH2(_hist_reserve)(_q,   f, (num+1)/2);
+        FIRPFBCH2(_hist_reserve)(_q, 1-f,  num   /2);
+
+        // load buffers in blocks of num_channels/2 starting in the
+        // middle of the filter bank and moving in the negative
+        // direction; run j is sample j/2 of its group in this chunk
+        for (j=0; j<num; j++) {
+            unsigned int g = f ^ (j & 1);
+            TI * h = _q->hist + (g ? _q->M : _q->M2)*_q->stride + _q->hn[g] + j/2;
+            const TI * x = &_x[j*_q->M2];
+            for (i=0; i<_q->M2; i++) {
+                h -= _q->stride;
+                *h = x[i];
+            }
+        }
+
+        for (j=0; j<num; j++) {
+            // samples in each group up to and including this run
+            unsigned int g = f ^ (j & 1);
+            unsigned int c[2];
+            c[g]   = _q->hn[g]   + j/2 + 1;
+            c[1-g] = _q->hn[1-g] + (j+1)/2;
+
+            // sub-filter inputs
+            unsigned int offset = g ? _q->M2 : 0;
+            for (i=0; i<_q->M; i++) {
+                unsigned int row = (offset+i) % _q->M;
+                _q->r[i] = _q->hist + row*_q->stride + c[row >= _q->M2] - L;
+            }
+
+            // run all dot products at once
+            FIRPFBCH2(_run_filters)(_q);
+
+            FIRPFBCH2(_analyzer_output)(_q, g, &_y[j*_q->M]);
+        }
+
+        // update counts and flag
+        _q->hn[f]   += (num+1)/2;
+        _q->hn[1-f] +=  num   /2;
+        _q->flag     = (num & 1) ? 1-f : f;
+
+        _x += num*_q->M2;
+        _y += num*_q->M;
+        _n -= num;
+    }
+}
 
-        // run dot products
-        DOTPROD(_execute)(_q->dp[i],        p0, &y0);
-        DOTPROD(_execute)(_q->dp[i+_q->M2], p1, &y1);
+// execute filterbank channelizer (synthesizer) on block of inputs
+//  _x      :   channelizer input,  [size: _n*M   x 1]
+//  _n      :   number of transforms
+//  _y      :   channelizer output, [size: _n*M/2 x 1]
+void FIRPFBCH2(_execute_synthesizer)(FIRPFBCH2()  _q,
+                                     TI *         _x,
+                                     unsigned int _n,
+                                     TO *         _y)
+{
+    unsigned int L = 2*_q->m;
+    unsigned int i, j;
+
+    for (j=0; j<_n; j++) {
+        // copy input array to internal IFFT input buffer
+        memmove(_q->X, &_x[j*_q->M], _q->M * sizeof(TI));
+
+        // execute IFFT, store result in buffer 'x'
+        FFT_EXECUTE(_q->ifft);
+
+        // TODO: ignore this scaling
+        // scale result by 1/num_channels (C transform)
+        for (i=0; i<_q->M; i++)
+            _q->x[i] *= 1.0f / (float)(_q->M);
+        // scale result by num_channels/2
+        for (i=0; i<_q->M; i++)
+            _q->x[i] *= (float)(_q->M2);
+
+        // push samples into appropriate buffer (group)
+        unsigned int g = _q->flag ? 0 : 1;
+        FIRPFBCH2(_hist_reserve)(_q, g, 1);
+        TI * h = _q->hist + g*_q->M*_q->stride + _q->hn[g];
+        for (i=0; i<_q->M; i++)
+            h[i*_q->stride] = _q->x[i];
+        _q->hn[g]++;
+
+        // read buffers for each filter output
+        TI * h0 = _q->hist                          + _q->hn[0] - L;
+        TI * h1 = _q->hist + _q->M*_q->stride       + _q->hn[1] - L;
+        for (i=0; i<_q->M2; i++) {
+            // buffer index
+            unsigned int b = (_q->flag == 0) ? i : i+_q->M2;
+            TI * r0 = h0 + b*_q->stride;
+            TI * r1 = h1 + b*_q->stride;
+
+            // swap buffer outputs on alternating runs
+            _q->r[i]        = _q->flag ? r0 : r1;
+            _q->r[i+_q->M2] = _q->flag ? r1 : r0;
+        }
+
+        // run all dot products at once
+        FIRPFBCH2(_run_filters)(_q);
 
         // save output
-        _y[i] = y0 + y1;
+        for (i=0; i<_q->M2; i++)
+            _y[j*_q->M2 + i] = _q->y[i] + _q->y[i+_q->M2];
+        _q->flag = 1 - _q->flag;
     }
-    _q->flag = 1 - _q->flag;
 }
 
 // execute filterbank channelizer
@@ -342,16 +588,30 @@ void FIRPFBCH2(_execute_synthesizer)(FIRPFBCH2() _q,
 void FIRPFBCH2(_execute)(FIRPFBCH2() _q,
                          TI *        _x,
                          TO *        _y)
+{
+    FIRPFBCH2(_execute_block)(_q, _x, 1, _y);
+}
+
+// execute filterbank channelizer on block of _n transforms
+// LIQUID_ANALYZER:     input: _n*M/2, output: _n*M
+// LIQUID_SYNTHESIZER:  input: _n*M,   output: _n*M/2
+//  _x      :   channelizer input
+//  _n      :   number of transforms
+//  _y      :   channelizer output
+void FIRPFBCH2(_execute_block)(FIRPFBCH2()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
 {
     switch (_q->type) {
     case LIQUID_ANALYZER:
-        FIRPFBCH2(_execute_analyzer)(_q, _x, _y);
+        FIRPFBCH2(_execute_analyzer)(_q, _x, _n, _y);
         return;
     case LIQUID_SYNTHESIZER:
-        FIRPFBCH2(_execute_synthesizer)(_q, _x, _y);
+        FIRPFBCH2(_execute_synthesizer)(_q, _x, _n, _y);
         return;
     default:
-        fprintf(stderr,"error: firpfbch2_%s_execute(), invalid type\n", EXTENSION_FULL);
+        fprintf(stderr,"error: firpfbch2_%s_execute_block(), invalid type\n", EXTENSION_FULL);
         exit(1);
     }
 }
@@ -71,7 +71,7 @@ firpfbch firpfbch_create(unsigned int _num_channels,
                          int _nyquist,
                          int _gradient)
 {
-    firpfbch c = (firpfbch) malloc(sizeof(struct firpfbch_s));
+    firpfbch c = (firpfbch) liquid_malloc(sizeof(struct firpfbch_s));
     c->num_channels = _num_channels;
     c->m            = _m;
     c->beta         = _beta;
@@ -85,13 +85,13 @@ firpfbch firpfbch_create(unsigned int _num_channels,
     }
 
     // create bank of filters
-    c->dp   = (DOTPROD()*) malloc((c->num_channels)*sizeof(DOTPROD()));
-    c->w    = (WINDOW()*) malloc((c->num_channels)*sizeof(WINDOW()));
+    c->dp   = (DOTPROD()*) liquid_malloc((c->num_channels)*sizeof(DOTPROD()));
+    c->w    = (WINDOW()*) liquid_malloc((c->num_channels)*sizeof(WINDOW()));
 
     // design filter
     // TODO: use filter prototype object
     c->h_len = 2*(c->m)*(c->num_channels);
-    c->h = (float*) malloc((c->h_len+1)*sizeof(float));
+    c->h = (float*) liquid_malloc((c->h_len+1)*sizeof(float));
 
     if (c->nyquist == FIRPFBCH_NYQUIST) {
         float fc = 0.5f/(float)(c->num_channels);  // cutoff frequency
@@ -146,9 +146,9 @@ firpfbch firpfbch_create(unsigned int _num_channels,
 
     // allocate memory for buffers
     // TODO : use fftw_malloc if HAVE_FFTW3_H
-    c->x = (float complex*) malloc((c->num_channels)*sizeof(float complex));
-    c->X = (float complex*) malloc((c->num_channels)*sizeof(float complex));
-    c->X_prime = (float complex*) malloc((c->num_channels)*sizeof(float complex));
+    c->x = (float complex*) liquid_malloc((c->num_channels)*sizeof(float complex));
+    c->X = (float complex*) liquid_malloc((c->num_channels)*sizeof(float complex));
+    c->X_prime = (float complex*) liquid_malloc((c->num_channels)*sizeof(float complex));
     firpfbch_clear(c);
 
     // create fft plan
@@ -164,15 +164,15 @@ void firpfbch_destroy(firpfbch _c)
         DOTPROD(_destroy)(_c->dp[i]);
         WINDOW(_destroy)(_c->w[i]);
     }
-    free(_c->dp);
-    free(_c->w);
+    liquid_free(_c->dp);
+    liquid_free(_c->w);
 
     FFT_DESTROY_PLAN(_c->fft);
-    free(_c->h);
-    free(_c->x);
-    free(_c->X);
-    free(_c->X_prime);
-    free(_c);
+    liquid_free(_c->h);
+    liquid_free(_c->x);
+    liquid_free(_c->X);
+    liquid_free(_c->X_prime);
+    liquid_free(_c);
 }
 
 void firpfbch_clear(firpfbch _c)
@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// mcrx.c
+//
+// multichannel receiver: fans channelizer output blocks out to
+// per-channel processing callbacks executed across a pool of worker
+// threads; each channel is fed through a lock-free single-producer/
+// single-consumer ring buffer, and a worker claims a channel exclusively
+// while draining it so per-channel ordering is preserved
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define MCRX_THREADS (1)
+#else
+#define MCRX_THREADS (0)
+#endif
+
+// per-channel ring buffer and state
+struct mcrx_channel_s {
+    float complex *     ring;           // ring buffer [ring_len]
+    unsigned long int   head;           // write index (producer only)
+    unsigned long int   tail;           // read index (owning worker only)
+    int                 owned;          // channel claimed by a worker?
+    void *              userdata;       // user-defined data for channel
+};
+
+// worker thread context
+struct mcrx_worker_s {
+    struct mcrx_s * q;                  // parent object
+    unsigned int    start;              // first (home) channel to scan
+};
+
+struct mcrx_s {
+    unsigned int        num_channels;   // number of channels, M
+    unsigned int        num_threads;    // number of worker threads
+    unsigned int        ring_len;       // ring buffer length (power of 2)
+    unsigned int        ring_mask;      // ring_len - 1
+    mcrx_callback       callback;       // user-defined callback function
+    struct mcrx_channel_s * channels;   // channels [num_channels]
+
+#if MCRX_THREADS
+    pthread_t *         threads;        // worker threads [num_threads]
+    struct mcrx_worker_s * workers;     // worker contexts [num_threads]
+    pthread_mutex_t     mutex;          // protects sleeping/waking
+    pthread_cond_t      cv_work;        // signalled when samples are published
+    pthread_cond_t      cv_progress;    // signalled when samples are consumed
+    unsigned long int   work_seq;       // publish counter
+    unsigned long int   progress_seq;   // consume counter
+    unsigned int        num_sleeping;   // number of workers waiting on cv_work
+    int                 waiting;        // producer waiting on cv_progress?
+    int                 stop;           // worker shutdown flag
+#endif
+};
+
+// push block of samples into channel ring, blocking until space is
+// available
+//  _q      :   multichannel receiver
+//  _c      :   channel index
+//  _x      :   input samples, strided
+//  _n      :   number of samples, _n <= ring_len
+//  _stride :   input sample stride
+void mcrx_push(mcrx            _q,
+               unsigned int    _c,
+               float complex * _x,
+               unsigned int    _n,
+               unsigned int    _stride);
+
+// drain all published samples of channel through callback; caller must
+// own the channel
+void mcrx_consume(mcrx         _q,
+                  unsigned int _c);
+
+#if MCRX_THREADS
+// try to claim and drain each channel once, starting at _start; returns
+// 1 if any samples were consumed, 0 otherwise
+int mcrx_scan(mcrx         _q,
+              unsigned int _start);
+
+// block until consume counter differs from _seq
+void mcrx_wait_progress(mcrx              _q,
+                        unsigned long int _seq);
+
+// worker thread main loop
+void * mcrx_worker(void * _arg);
+
+#endif
+
+// create multichannel receiver
+//  _num_channels   :   number of channels, e.g. channelizer size M
+//  _num_threads    :   number of worker threads; 0 executes callbacks
+//                      in the calling thread
+//  _ring_len       :   per-channel ring buffer length (rounded up to power of 2)
+//  _callback       :   per-channel processing callback
+//  _userdata       :   per-channel user data passed to callback [size: _num_channels x 1], or NULL
+mcrx mcrx_create(unsigned int  _num_channels,
+                 unsigned int  _num_threads,
+                 unsigned int  _ring_len,
+                 mcrx_callback _callback,
+                 void **       _userdata)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: mcrx_create(), number of channels must be greater than zero\n");
+        exit(1);
+    } else if (_ring_len < 2) {
+        fprintf(stderr,"error: mcrx_create(), ring buffer length must be at least 2\n");
+        exit(1);
+    } else if (_callback == NULL) {
+        fprintf(stderr,"error: mcrx_create(), callback must not be NULL\n");
+        exit(1);
+    }
+
+    mcrx q = (mcrx) liquid_malloc(sizeof(struct mcrx_s));
+    q->num_channels = _num_channels;
+    q->num_threads  = _num_threads > _num_channels ? _num_channels : _num_threads;
+    q->callback     = _callback;
+#if !MCRX_THREADS
+    if (q->num_threads > 0)
+        fprintf(stderr,"warning: mcrx_create(), built without pthreads; executing channels serially\n");
+    q->num_threads = 0;
+#endif
+
+    // round ring length up to power of two
+    q->ring_len = 1 << liquid_nextpow2(_ring_len);
+    q->ring_mask = q->ring_len - 1;
+
+    // create channels
+    q->channels = (struct mcrx_channel_s*) liquid_malloc(q->num_channels*sizeof(struct mcrx_channel_s));
+    unsigned int i;
+    for (i=0; i<q->num_channels; i++) {
+        struct mcrx_channel_s * ch = &q->channels[i];
+        ch->ring     = (float complex*) liquid_malloc(q->ring_len*sizeof(float complex));
+        ch->head     = 0;
+        ch->tail     = 0;
+        ch->owned    = 0;
+        ch->userdata = _userdata == NULL ? NULL : _userdata[i];
+    }
+
+#if MCRX_THREADS
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init(&q->cv_work, NULL);
+    pthread_cond_init(&q->cv_progress, NULL);
+    q->work_seq     = 0;
+    q->progress_seq = 0;
+    q->num_sleeping = 0;
+    q->waiting      = 0;
+    q->stop         = 0;
+
+    // spread workers' home channels evenly; each steals from the rest
+    q->threads = (pthread_t*) liquid_malloc(q->num_threads*sizeof(pthread_t));
+    struct mcrx_worker_s * w = (struct mcrx_worker_s*) liquid_malloc(q->num_threads*sizeof(struct mcrx_worker_s));
+    for (i=0; i<q->num_threads; i++) {
+        w[i].q     = q;
+        w[i].start = (i*q->num_channels) / q->num_threads;
+    }
+    q->workers = w;
+    for (i=0; i<q->num_threads; i++) {
+        if (pthread_create(&q->threads[i], NULL, mcrx_worker, &w[i]) != 0) {
+            fprintf(stderr,"error: mcrx_create(), could not create thread\n");
+            exit(1);
+        }
+    }
+#endif
+
+    return q;
+}
+
+// destroy multichannel receiver, processing any samples still queued
+void mcrx_destroy(mcrx _q)
+{
+    unsigned int i;
+    mcrx_flush(_q);
+
+#if MCRX_THREADS
+    // stop and join worker threads
+    pthread_mutex_lock(&_q->mutex);
+    __atomic_store_n(&_q->stop, 1, __ATOMIC_SEQ_CST);
+    pthread_cond_broadcast(&_q->cv_work);
+    pthread_mutex_unlock(&_q->mutex);
+    for (i=0; i<_q->num_threads; i++)
+        pthread_join(_q->threads[i], NULL);
+
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy(&_q->cv_work);
+    pthread_cond_destroy(&_q->cv_progress);
+    liquid_free(_q->threads);
+    liquid_free(_q->workers);
+#endif
+
+    // free channel rings
+    for (i=0; i<_q->num_channels; i++)
+        liquid_free(_q->channels[i].ring);
+    liquid_free(_q->channels);
+
+    // free main object memory
+    liquid_free(_q);
+}
+
+// print multichannel receiver object internals
+void mcrx_print(mcrx _q)
+{
+    printf("mcrx:\n");
+    printf("    num channels        :   %-u\n", _q->num_channels);
+    printf("    num threads         :   %-u\n", _q->num_threads);
+    printf("    ring length         :   %-u\n", _q->ring_len);
+}
+
+// get number of channels
+unsigned int mcrx_get_num_channels(mcrx _q)
+{
+    return _q->num_channels;
+}
+
+// get number of worker threads
+unsigned int mcrx_get_num_threads(mcrx _q)
+{
+    return _q->num_threads;
+}
+
+// push block of channelizer outputs to the per-channel pipelines;
+// returns once every sample has been queued (not necessarily processed)
+//  _q      :   multichannel receiver
+//  _y      :   channelizer output, interleaved [size: _n x num_channels]
+//  _n      :   number of transforms
+void mcrx_execute(mcrx            _q,
+                  float complex * _y,
+                  unsigned int    _n)
+{
+    // publish in chunks of half a ring so workers drain one half while
+    // the next is being written
+    unsigned int chunk = _q->ring_len / 2;
+    unsigned int M = _q->num_channels;
+    unsigned int t, c;
+    for (t=0; t<_n; t+=chunk) {
+        unsigned int n = (_n - t) < chunk ? (_n - t) : chunk;
+        for (c=0; c<M; c++) {
+            mcrx_push(_q, c, _y + t*M + c, n, M);
+
+            // no workers: process channel in calling thread
+            if (_q->num_threads == 0)
+                mcrx_consume(_q, c);
+        }
+
+#if MCRX_THREADS
+        // wake sleeping workers
+        __atomic_add_fetch(&_q->work_seq, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&_q->num_sleeping, __ATOMIC_SEQ_CST) > 0) {
+            pthread_mutex_lock(&_q->mutex);
+            pthread_cond_broadcast(&_q->cv_work);
+            pthread_mutex_unlock(&_q->mutex);
+        }
+#endif
+    }
+}
+
+// block until every queued sample has been processed
+void mcrx_flush(mcrx _q)
+{
+#if MCRX_THREADS
+    while (1) {
+        unsigned long int seq = __atomic_load_n(&_q->progress_seq, __ATOMIC_SEQ_CST);
+        unsigned int c;
+        for (c=0; c<_q->num_channels; c++) {
+            struct mcrx_channel_s * ch = &_q->channels[c];
+            if (__atomic_load_n(&ch->tail,  __ATOMIC_ACQUIRE) != ch->head ||
+                __atomic_load_n(&ch->owned, __ATOMIC_ACQUIRE))
+                break;
+        }
+        if (c == _q->num_channels)
+            break;
+        mcrx_wait_progress(_q, seq);
+    }
+#endif
+}
+
+//
+// internal methods
+//
+
+// push block of samples into channel ring, blocking until space is
+// available
+//  _q      :   multichannel receiver
+//  _c      :   channel index
+//  _x      :   input samples, strided
+//  _n      :   number of samples, _n <= ring_len
+//  _stride :   input sample stride
+void mcrx_push(mcrx            _q,
+               unsigned int    _c,
+               float complex * _x,
+               unsigned int    _n,
+               unsigned int    _stride)
+{
+    struct mcrx_channel_s * ch = &_q->channels[_c];
+    unsigned long int head = ch->head;
+
+#if MCRX_THREADS
+    // wait for consumer to free enough of the ring
+    while (1) {
+        unsigned long int seq = __atomic_load_n(&_q->progress_seq, __ATOMIC_SEQ_CST);
+        if (head - __atomic_load_n(&ch->tail, __ATOMIC_ACQUIRE) + _n <= _q->ring_len)
+            break;
+        mcrx_wait_progress(_q, seq);
+    }
+#endif
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        ch->ring[(head + i) & _q->ring_mask] = _x[i*_stride];
+
+    // publish samples to consumer
+    __atomic_store_n(&ch->head, head + _n, __ATOMIC_RELEASE);
+}
+
+// drain all published samples of channel through callback, in at most
+// two contiguous segments; caller must own the channel
+void mcrx_consume(mcrx         _q,
+                  unsigned int _c)
+{
+    struct mcrx_channel_s * ch = &_q->channels[_c];
+    unsigned long int tail = ch->tail;
+    unsigned long int head = __atomic_load_n(&ch->head, __ATOMIC_ACQUIRE);
+    while (tail != head) {
+        unsigned int k = tail & _q->ring_mask;
+        unsigned int n = head - tail;
+        if (n > _q->ring_len - k)
+            n = _q->ring_len - k;
+        _q->callback(_c, ch->ring + k, n, ch->userdata);
+        tail += n;
+
+        // release segment back to producer
+        __atomic_store_n(&ch->tail, tail, __ATOMIC_RELEASE);
+    }
+}
+
+#if MCRX_THREADS
+// try to claim and drain each channel once, starting at _start; returns
+// 1 if any samples were consumed, 0 otherwise
+int mcrx_scan(mcrx         _q,
+              unsigned int _start)
+{
+    int rc = 0;
+    unsigned int i;
+    unsigned int c = _start;
+    for (i=0; i<_q->num_channels; i++) {
+        struct mcrx_channel_s * ch = &_q->channels[c];
+        int expected = 0;
+        if (__atomic_load_n(&ch->head,  __ATOMIC_RELAXED) != __atomic_load_n(&ch->tail, __ATOMIC_RELAXED) &&
+            __atomic_load_n(&ch->owned, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&ch->owned, &expected, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            mcrx_consume(_q, c);
+            __atomic_store_n(&ch->owned, 0, __ATOMIC_RELEASE);
+
+            // notify producer waiting for ring space or flush
+            __atomic_add_fetch(&_q->progress_seq, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&_q->waiting, __ATOMIC_SEQ_CST)) {
+                pthread_mutex_lock(&_q->mutex);
+                pthread_cond_broadcast(&_q->cv_progress);
+                pthread_mutex_unlock(&_q->mutex);
+            }
+            rc = 1;
+        }
+        c = (c + 1 == _q->num_channels) ? 0 : c + 1;
+    }
+    return rc;
+}
+
+// block until consume counter differs from _seq
+void mcrx_wait_progress(mcrx              _q,
+                        unsigned long int _seq)
+{
+    pthread_mutex_lock(&_q->mutex);
+    __atomic_store_n(&_q->waiting, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&_q->progress_seq, __ATOMIC_SEQ_CST) == _seq)
+        pthread_cond_wait(&_q->cv_progress, &_q->mutex);
+    __atomic_store_n(&_q->waiting, 0, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&_q->mutex);
+}
+
+// worker thread main loop: drain channels starting from home channel,
+// stealing from the others, and sleep when nothing new was published
+void * mcrx_worker(void * _arg)
+{
+    struct mcrx_worker_s * w = (struct mcrx_worker_s*) _arg;
+    mcrx q = w->q;
+
+    while (!__atomic_load_n(&q->stop, __ATOMIC_SEQ_CST)) {
+        unsigned long int seq = __atomic_load_n(&q->work_seq, __ATOMIC_SEQ_CST);
+        if (mcrx_scan(q, w->start))
+            continue;
+
+        pthread_mutex_lock(&q->mutex);
+        __atomic_add_fetch(&q->num_sleeping, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&q->work_seq, __ATOMIC_SEQ_CST) == seq &&
+               !__atomic_load_n(&q->stop, __ATOMIC_SEQ_CST))
+        {
+            pthread_cond_wait(&q->cv_work, &q->mutex);
+        }
+        __atomic_sub_fetch(&q->num_sleeping, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&q->mutex);
+    }
+    return NULL;
+}
+#endif
@@ -253,6 +253,143 @@ void ofdmframe_validate_sctype(unsigned char * _p,
     *_M_data  = M_data;
 }
 
+// build index tables of pilot and data subcarriers, so per-symbol
+// loops visit only the subcarriers of each type; indices are listed in
+// fftshift order (from -M/2 to M/2-1), or in natural order (0 to M-1)
+// if _natural is set
+//  _p          :   subcarrier allocation array, [size: _M x 1]
+//  _M          :   number of subcarriers
+//  _natural    :   list indices in natural rather than fftshift order?
+//  _pilot_idx  :   output pilot subcarrier indices, [size: M_pilot x 1], or NULL
+//  _data_idx   :   output data subcarrier indices, [size: M_data x 1], or NULL
+void ofdmframe_index_sctype(unsigned char * _p,
+                            unsigned int    _M,
+                            int             _natural,
+                            unsigned int *  _pilot_idx,
+                            unsigned int *  _data_idx)
+{
+    unsigned int n_pilot = 0;
+    unsigned int n_data  = 0;
+    unsigned int i;
+    for (i=0; i<_M; i++) {
+        unsigned int k = _natural ? i : (i + _M/2) % _M;
+        if (_p[k] == OFDMFRAME_SCTYPE_PILOT) {
+            if (_pilot_idx != NULL)
+                _pilot_idx[n_pilot] = k;
+            n_pilot++;
+        } else if (_p[k] == OFDMFRAME_SCTYPE_DATA) {
+            if (_data_idx != NULL)
+                _data_idx[n_data] = k;
+            n_data++;
+        }
+    }
+}
+
+// build index table of the data subcarriers assigned to one user of a
+// multi-user allocation, in natural order; returns the number of data
+// subcarriers assigned to the user
+//  _p          :   subcarrier allocation array, [size: _M x 1]
+//  _M          :   number of subcarriers
+//  _user_map   :   user index of each subcarrier, [size: _M x 1]
+//  _user       :   user index
+//  _data_idx   :   output data subcarrier indices of user, or NULL
+unsigned int ofdmframe_index_user(unsigned char * _p,
+                                  unsigned int    _M,
+                                  unsigned char * _user_map,
+                                  unsigned int    _user,
+                                  unsigned int *  _data_idx)
+{
+    unsigned int n = 0;
+    unsigned int i;
+    for (i=0; i<_M; i++) {
+        if (_p[i] != OFDMFRAME_SCTYPE_DATA || _user_map[i] != _user)
+            continue;
+        if (_data_idx != NULL)
+            _data_idx[n] = i;
+        n++;
+    }
+    return n;
+}
+
+// find smallest cyclic band containing all enabled (pilot and data)
+// subcarriers, i.e. the complement of the longest cyclic run of null
+// subcarriers
+//  _p      :   subcarrier allocation array, [size: _M x 1]
+//  _M      :   number of subcarriers
+//  _k0     :   output first subcarrier of band
+//  _len    :   output band length (zero if all subcarriers are null)
+void ofdmframe_sctype_band(unsigned char * _p,
+                           unsigned int    _M,
+                           unsigned int *  _k0,
+                           unsigned int *  _len)
+{
+    // find an enabled subcarrier to start the search from
+    unsigned int i;
+    unsigned int i0 = _M;
+    for (i=0; i<_M; i++) {
+        if (_p[i] != OFDMFRAME_SCTYPE_NULL) {
+            i0 = i;
+            break;
+        }
+    }
+    if (i0 == _M) {
+        *_k0  = 0;
+        *_len = 0;
+        return;
+    }
+
+    // longest run of null subcarriers, starting after an enabled one
+    unsigned int run       = 0;
+    unsigned int run_max   = 0;
+    unsigned int run_start = i0 + 1;
+    for (i=1; i<=_M; i++) {
+        unsigned int k = (i0 + i) % _M;
+        if (_p[k] == OFDMFRAME_SCTYPE_NULL) {
+            run++;
+            if (run > run_max) {
+                run_max   = run;
+                run_start = (k + _M + 1 - run) % _M;
+            }
+        } else {
+            run = 0;
+        }
+    }
+
+    // band begins right after the longest null run
+    *_k0  = (run_start + run_max) % _M;
+    *_len = _M - run_max;
+}
+
+// create transform plan over the subcarriers, skipping computation
+// for null subcarriers where possible: the backward (generator)
+// transform takes null subcarriers as zero input, the forward
+// (synchronizer) transform does not compute their output
+//  _p      :   subcarrier allocation array, [size: _M x 1]
+//  _M      :   number of subcarriers
+//  _x      :   transform input,  [size: _M x 1]
+//  _y      :   transform output, [size: _M x 1]
+//  _dir    :   transform direction {FFT_DIR_FORWARD, FFT_DIR_BACKWARD}
+FFT_PLAN ofdmframe_create_plan(unsigned char * _p,
+                               unsigned int    _M,
+                               float complex * _x,
+                               float complex * _y,
+                               int             _dir)
+{
+#if HAVE_FFTW3_H && !defined LIQUID_FFTOVERRIDE
+    // external library: regular transform
+    return FFT_CREATE_PLAN(_M, _x, _y, _dir, FFT_METHOD);
+#else
+    unsigned int k0;
+    unsigned int len;
+    ofdmframe_sctype_band(_p, _M, &k0, &len);
+    if (len == 0)
+        return FFT_CREATE_PLAN(_M, _x, _y, _dir, FFT_METHOD);
+
+    return fft_create_plan_pruned(_M, _x, _y, _dir, FFT_METHOD, k0, len,
+        _dir == FFT_DIR_BACKWARD ? LIQUID_FFT_PRUNE_INPUT : LIQUID_FFT_PRUNE_OUTPUT);
+#endif
+}
+
 // print subcarrier allocation to screen
 //
 // key: '.' (null), 'P' (pilot), '+' (data)
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ofdmframe_kernels.avx.c : overlap-add kernels for ofdmframegen (x86 AVX2)
+//
+// These kernels are compiled with per-function target attributes and
+// are selected at run time; results agree with ofdmframe_kernels.c to
+// within floating-point rounding (fused multiply-add).
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// tapered overlap-add (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_ofdm_taper_avx2(const float * _x,
+                            const float * _p,
+                            const float * _w,
+                            const float * _v,
+                            float *       _y,
+                            unsigned int  _n)
+{
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 pv = _mm256_mul_ps(_mm256_loadu_ps(_p + i), _mm256_loadu_ps(_v + i));
+        __m256 y  = _mm256_fmadd_ps(_mm256_loadu_ps(_x + i), _mm256_loadu_ps(_w + i), pv);
+        _mm256_storeu_ps(_y + i, y);
+    }
+
+    // remaining samples
+    for ( ; i<_n; i++)
+        _y[i] = _x[i]*_w[i] + _p[i]*_v[i];
+}
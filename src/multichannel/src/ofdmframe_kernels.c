@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ofdmframe_kernels.c : overlap-add kernels for ofdmframegen (portable C)
+//
+// Complex samples are handled as interleaved (re,im) pairs against
+// window tables with each coefficient duplicated, so the same kernel
+// serves both complex baseband and real passband symbols.
+//
+
+#include "liquid.internal.h"
+
+// tapered overlap-add (see liquid.internal.h)
+void liquid_ofdm_taper(const float * _x,
+                       const float * _p,
+                       const float * _w,
+                       const float * _v,
+                       float *       _y,
+                       unsigned int  _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = _x[i]*_w[i] + _p[i]*_v[i];
+}
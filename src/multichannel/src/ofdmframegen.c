@@ -48,6 +48,8 @@ struct ofdmframegen_s {
     // tapering/trasition
     unsigned int taper_len; // number of samples in tapering window/overlap
     float * taper;          // tapering window
+    float * taper_w;        // window, interleaved (re,im) [size: 2*taper_len x 1]
+    float * taper_v;        // reversed window, interleaved [size: 2*taper_len x 1]
     float complex *postfix; // overlapping symbol buffer
 
     // constants
@@ -56,6 +58,8 @@ struct ofdmframegen_s {
     unsigned int M_data;    // number of data subcarriers
     unsigned int M_S0;      // number of enabled subcarriers in S0
     unsigned int M_S1;      // number of enabled subcarriers in S1
+    unsigned int * pilot_idx;   // pilot subcarrier indices (fftshift order)
+    unsigned int * data_idx;    // data subcarrier indices
 
     // scaling factors
     float g_data;           //
@@ -73,10 +77,32 @@ struct ofdmframegen_s {
     float complex * S1;     // long sequence (frequency)
     float complex * s1;     // long sequence (time)
 
+    // rendered PLCP symbols (depend only on configuration)
+    float complex * buf_S0a;    // first S0 symbol [size: M+cp_len x 1]
+    float complex * buf_S0b;    // second S0 symbol [size: M+cp_len x 1]
+    float complex * buf_S1;     // S1 symbol following S0b [size: M+cp_len x 1]
+    int postfix_S0;             // postfix holds S0b overlap?
+
     // pilot sequence
     msequence ms_pilot;
+
+    // real passband mode (D == 0: complex baseband)
+    unsigned int D;             // real samples per baseband sample
+    unsigned int k0;            // transform bin of baseband subcarrier 0
+    FFT_PLAN ifft_r;            // complex-to-real transform
+    float complex * Xr;         // Hermitian half spectrum [size: D*M/2+1 x 1]
+    float * xr;                 // real time-domain symbol [size: D*M x 1]
+    float * taper_r;            // tapering window [size: D*taper_len x 1]
+    float * taper_rv;           // reversed tapering window [size: D*taper_len x 1]
+    float * postfix_r;          // overlapping symbol buffer [size: D*taper_len x 1]
+    float * s0r;                // short sequence (time) [size: D*M x 1]
+    float * s1r;                // long sequence (time) [size: D*M x 1]
+    float * buf_S0a_r;          // first S0 symbol [size: D*(M+cp_len) x 1]
+    float * buf_S0b_r;          // second S0 symbol [size: D*(M+cp_len) x 1]
+    float * buf_S1_r;           // S1 symbol following S0b [size: D*(M+cp_len) x 1]
 };
 
+
 // create OFDM framing generator object
 //  _M          :   number of subcarriers, >10 typical
 //  _cp_len     :   cyclic prefix length
@@ -102,13 +128,13 @@ ofdmframegen ofdmframegen_create(unsigned int    _M,
         exit(1);
     }
 
-    ofdmframegen q = (ofdmframegen) malloc(sizeof(struct ofdmframegen_s));
+    ofdmframegen q = (ofdmframegen) liquid_malloc(sizeof(struct ofdmframegen_s));
     q->M         = _M;
     q->cp_len    = _cp_len;
     q->taper_len = _taper_len;
 
     // allocate memory for subcarrier allocation IDs
-    q->p = (unsigned char*) malloc((q->M)*sizeof(unsigned char));
+    q->p = (unsigned char*) liquid_malloc((q->M)*sizeof(unsigned char));
     if (_p == NULL) {
         // initialize default subcarrier allocation
         ofdmframe_init_default_sctype(q->M, q->p);
@@ -133,26 +159,42 @@ ofdmframegen ofdmframegen_create(unsigned int    _M,
     unsigned int i;
 
     // allocate memory for transform objects
-    q->X = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->x = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
+    q->X = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
+    q->x = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
+    q->ifft = ofdmframe_create_plan(q->p, q->M, q->X, q->x, FFT_DIR_BACKWARD);
+
+    // pilot and data subcarrier tables; null subcarriers are cleared
+    // once here and never written
+    q->pilot_idx = (unsigned int*) liquid_malloc(q->M_pilot*sizeof(unsigned int));
+    q->data_idx  = (unsigned int*) liquid_malloc(q->M_data*sizeof(unsigned int));
+    ofdmframe_index_sctype(q->p, q->M, 0, q->pilot_idx, q->data_idx);
+    memset(q->X, 0x00, q->M*sizeof(float complex));
 
     // allocate memory for PLCP arrays
-    q->S0 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->s0 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->S1 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->s1 = (float complex*) malloc((q->M)*sizeof(float complex));
+    q->S0 = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
+    q->s0 = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
+    q->S1 = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
+    q->s1 = (float complex*) liquid_malloc((q->M)*sizeof(float complex));
     ofdmframe_init_S0(q->p, q->M, q->S0, q->s0, &q->M_S0);
     ofdmframe_init_S1(q->p, q->M, q->S1, q->s1, &q->M_S1);
 
     // create tapering window and transition buffer
-    q->taper   = (float*)         malloc(q->taper_len * sizeof(float));
-    q->postfix = (float complex*) malloc(q->taper_len * sizeof(float complex));
+    q->taper   = (float*)         liquid_malloc(q->taper_len * sizeof(float));
+    q->postfix = (float complex*) liquid_malloc(q->taper_len * sizeof(float complex));
     for (i=0; i<q->taper_len; i++) {
         float t = ((float)i + 0.5f) / (float)(q->taper_len);
         float g = sinf(M_PI_2*t);
         q->taper[i] = g*g;
     }
+
+    // window tables for the overlap-add kernel, applied to complex
+    // samples as interleaved floats
+    q->taper_w = (float*) liquid_malloc(2*q->taper_len * sizeof(float));
+    q->taper_v = (float*) liquid_malloc(2*q->taper_len * sizeof(float));
+    for (i=0; i<q->taper_len; i++) {
+        q->taper_w[2*i  ] = q->taper_w[2*i+1] = q->taper[i];
+        q->taper_v[2*i  ] = q->taper_v[2*i+1] = q->taper[q->taper_len-i-1];
+    }
 #if 0
     // validate window symmetry
     for (i=0; i<q->taper_len; i++) {
@@ -164,9 +206,124 @@ ofdmframegen ofdmframegen_create(unsigned int    _M,
     // compute scaling factor
     q->g_data = 1.0f / sqrtf(q->M_pilot + q->M_data);
 
+    // render PLCP symbols once; frames emit them with a copy
+    unsigned int k;
+    q->buf_S0a = (float complex*) liquid_malloc((q->M + q->cp_len)*sizeof(float complex));
+    q->buf_S0b = (float complex*) liquid_malloc((q->M + q->cp_len)*sizeof(float complex));
+    q->buf_S1  = (float complex*) liquid_malloc((q->M + q->cp_len)*sizeof(float complex));
+    for (i=0; i<q->M + q->cp_len; i++) {
+        k = (i + q->M - 2*q->cp_len) % q->M;
+        q->buf_S0a[i] = q->s0[k];
+
+        k = (i + q->M - q->cp_len) % q->M;
+        q->buf_S0b[i] = q->s0[k];
+    }
+    for (i=0; i<q->taper_len; i++)
+        q->buf_S0a[i] *= q->taper[i];
+
+    // S1 overlaps the postfix of S0b (first 'taper_len' samples of s0)
+    memmove(q->postfix, q->s0, q->taper_len*sizeof(float complex));
+    memmove(q->x, q->s1, (q->M)*sizeof(float complex));
+    ofdmframegen_gensymbol(q, q->buf_S1);
+    for (i=0; i<q->taper_len; i++)
+        q->postfix[i] = 0.0f;
+    q->postfix_S0 = 0;
+
     // set pilot sequence
     q->ms_pilot = msequence_create_default(8);
 
+    // complex baseband output
+    q->D = 0;
+
+    return q;
+}
+
+// create OFDM framing generator object producing real passband samples
+// directly: the subcarriers are placed about bin k0 = round(_fc*_D*_M)
+// of a Hermitian-symmetric transform of length _D*_M, equivalent to
+// interpolating the baseband output by _D, mixing up to _fc and taking
+// the real part (scaled by sqrt(2) so the sample power is unchanged)
+//  _M          :   number of subcarriers, >10 typical
+//  _cp_len     :   cyclic prefix length (baseband samples)
+//  _taper_len  :   taper length (baseband samples)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _D          :   real samples per baseband sample, _D >= 2
+//  _fc         :   center frequency relative to real sample rate, (0,0.5)
+ofdmframegen ofdmframegen_create_passband(unsigned int    _M,
+                                          unsigned int    _cp_len,
+                                          unsigned int    _taper_len,
+                                          unsigned char * _p,
+                                          unsigned int    _D,
+                                          float           _fc)
+{
+    // validate input
+    if (_D < 2) {
+        fprintf(stderr,"error: ofdmframegen_create_passband(), samples per baseband sample must be at least 2\n");
+        exit(1);
+    }
+    unsigned int N  = _D*_M;
+    unsigned int k0 = (unsigned int)roundf(_fc*(float)N);
+    if (_fc <= 0.0f || k0 <= _M/2 || k0 + _M/2 > N/2) {
+        fprintf(stderr,"error: ofdmframegen_create_passband(), band (center %g, width %g) must lie within (0,0.5)\n",
+                _fc, 1.0f/(float)_D);
+        exit(1);
+    }
+
+    ofdmframegen q = ofdmframegen_create(_M, _cp_len, _taper_len, _p);
+    q->D  = _D;
+    q->k0 = k0;
+
+    unsigned int i;
+    unsigned int cp_len    = q->D*q->cp_len;
+    unsigned int taper_len = q->D*q->taper_len;
+
+    // transform (bins outside the band remain zero)
+    q->Xr = (float complex*) liquid_calloc(N/2+1, sizeof(float complex));
+    q->xr = (float*)         liquid_malloc(N*sizeof(float));
+    q->ifft_r = FFT_CREATE_PLAN_C2R(N, q->Xr, q->xr, FFT_METHOD);
+
+    // tapering window and transition buffer
+    q->taper_r   = (float*) liquid_malloc(taper_len*sizeof(float));
+    q->taper_rv  = (float*) liquid_malloc(taper_len*sizeof(float));
+    q->postfix_r = (float*) liquid_calloc(taper_len, sizeof(float));
+    for (i=0; i<taper_len; i++) {
+        float t = ((float)i + 0.5f) / (float)(taper_len);
+        float g = sinf(M_PI_2*t);
+        q->taper_r[i] = g*g;
+    }
+    for (i=0; i<taper_len; i++)
+        q->taper_rv[i] = q->taper_r[taper_len-i-1];
+
+    // PLCP sequences: the baseband sequences are s = ifft(S)*g, so the
+    // passband sequences are the transform of S*g
+    float complex * S = (float complex*) liquid_malloc(q->M*sizeof(float complex));
+    q->s0r = (float*) liquid_malloc(N*sizeof(float));
+    q->s1r = (float*) liquid_malloc(N*sizeof(float));
+    for (i=0; i<q->M; i++) S[i] = q->S0[i] / sqrtf(q->M_S0);
+    ofdmframegen_passband_transform(q, S);
+    memmove(q->s0r, q->xr, N*sizeof(float));
+    for (i=0; i<q->M; i++) S[i] = q->S1[i] / sqrtf(q->M_S1);
+    ofdmframegen_passband_transform(q, S);
+    memmove(q->s1r, q->xr, N*sizeof(float));
+    liquid_free(S);
+
+    // render PLCP symbols once, as for baseband
+    q->buf_S0a_r = (float*) liquid_malloc((N + cp_len)*sizeof(float));
+    q->buf_S0b_r = (float*) liquid_malloc((N + cp_len)*sizeof(float));
+    q->buf_S1_r  = (float*) liquid_malloc((N + cp_len)*sizeof(float));
+    for (i=0; i<N + cp_len; i++) {
+        q->buf_S0a_r[i] = q->s0r[(i + N - (2*cp_len % N)) % N];
+        q->buf_S0b_r[i] = q->s0r[(i + N - cp_len) % N];
+    }
+    for (i=0; i<taper_len; i++)
+        q->buf_S0a_r[i] *= q->taper_r[i];
+    memmove(q->postfix_r, q->s0r, taper_len*sizeof(float));
+    memmove(q->xr, q->s1r, N*sizeof(float));
+    ofdmframegen_gensymbol_real(q, q->buf_S1_r);
+    for (i=0; i<taper_len; i++)
+        q->postfix_r[i] = 0.0f;
+    q->postfix_S0 = 0;
+
     return q;
 }
 
@@ -174,28 +331,50 @@ ofdmframegen ofdmframegen_create(unsigned int    _M,
 void ofdmframegen_destroy(ofdmframegen _q)
 {
     // free subcarrier type array memory
-    free(_q->p);
+    liquid_free(_q->p);
 
     // free transform array memory
-    free(_q->X);
-    free(_q->x);
+    liquid_free(_q->X);
+    liquid_free(_q->x);
     FFT_DESTROY_PLAN(_q->ifft);
+    liquid_free(_q->pilot_idx);
+    liquid_free(_q->data_idx);
 
     // free tapering window and transition buffer
-    free(_q->taper);
-    free(_q->postfix);
+    liquid_free(_q->taper);
+    liquid_free(_q->taper_w);
+    liquid_free(_q->taper_v);
+    liquid_free(_q->postfix);
 
     // free PLCP memory arrays
-    free(_q->S0);
-    free(_q->s0);
-    free(_q->S1);
-    free(_q->s1);
+    liquid_free(_q->S0);
+    liquid_free(_q->s0);
+    liquid_free(_q->S1);
+    liquid_free(_q->s1);
+    liquid_free(_q->buf_S0a);
+    liquid_free(_q->buf_S0b);
+    liquid_free(_q->buf_S1);
 
     // free pilot msequence object memory
     msequence_destroy(_q->ms_pilot);
 
+    // free passband memory
+    if (_q->D > 0) {
+        FFT_DESTROY_PLAN(_q->ifft_r);
+        liquid_free(_q->Xr);
+        liquid_free(_q->xr);
+        liquid_free(_q->taper_r);
+        liquid_free(_q->taper_rv);
+        liquid_free(_q->postfix_r);
+        liquid_free(_q->s0r);
+        liquid_free(_q->s1r);
+        liquid_free(_q->buf_S0a_r);
+        liquid_free(_q->buf_S0b_r);
+        liquid_free(_q->buf_S1_r);
+    }
+
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void ofdmframegen_print(ofdmframegen _q)
@@ -207,6 +386,10 @@ void ofdmframegen_print(ofdmframegen _q)
     printf("      - data            :   %-u\n", _q->M_data);
     printf("    cyclic prefix len   :   %-u\n", _q->cp_len);
     printf("    taper len           :   %-u\n", _q->taper_len);
+    if (_q->D > 0) {
+        printf("    passband            :   %u samples/sample, center bin %u of %u\n",
+                _q->D, _q->k0, _q->D*_q->M);
+    }
     printf("    ");
     ofdmframe_print_sctype(_q->p, _q->M);
 }
@@ -219,6 +402,9 @@ void ofdmframegen_reset(ofdmframegen _q)
     unsigned int i;
     for (i=0; i<_q->taper_len; i++)
         _q->postfix[i] = 0.0f;
+    for (i=0; i<_q->D*_q->taper_len; i++)
+        _q->postfix_r[i] = 0.0f;
+    _q->postfix_S0 = 0;
 }
 
 // write first PLCP short sequence 'symbol' to buffer
@@ -237,35 +423,30 @@ void ofdmframegen_reset(ofdmframegen _q)
 void ofdmframegen_write_S0a(ofdmframegen    _q,
                             float complex * _y)
 {
-    unsigned int i;
-    unsigned int k;
-    for (i=0; i<_q->M + _q->cp_len; i++) {
-        k = (i + _q->M - 2*_q->cp_len) % _q->M;
-        _y[i] = _q->s0[k];
-    }
-
-    // apply tapering window
-    for (i=0; i<_q->taper_len; i++)
-        _y[i] *= _q->taper[i];
+    memmove(_y, _q->buf_S0a, (_q->M + _q->cp_len)*sizeof(float complex));
 }
 
 void ofdmframegen_write_S0b(ofdmframegen _q,
                             float complex * _y)
 {
-    unsigned int i;
-    unsigned int k;
-    for (i=0; i<_q->M + _q->cp_len; i++) {
-        k = (i + _q->M - _q->cp_len) % _q->M;
-        _y[i] = _q->s0[k];
-    }
+    memmove(_y, _q->buf_S0b, (_q->M + _q->cp_len)*sizeof(float complex));
 
     // copy postfix (first 'taper_len' samples of s0 symbol)
     memmove(_q->postfix, _q->s0, _q->taper_len*sizeof(float complex));
+    _q->postfix_S0 = 1;
 }
 
 void ofdmframegen_write_S1(ofdmframegen _q,
                            float complex * _y)
 {
+    if (_q->postfix_S0) {
+        // following S0b: copy rendered symbol and update postfix
+        memmove(_y, _q->buf_S1, (_q->M + _q->cp_len)*sizeof(float complex));
+        memmove(_q->postfix, _q->s1, _q->taper_len*sizeof(float complex));
+        _q->postfix_S0 = 0;
+        return;
+    }
+
     // copy S1 symbol to output, adding cyclic prefix and tapering window
     memmove(_q->x, _q->s1, (_q->M)*sizeof(float complex));
     ofdmframegen_gensymbol(_q, _y);
@@ -281,27 +462,7 @@ void ofdmframegen_writesymbol(ofdmframegen    _q,
                               float complex * _y)
 {
     // move frequency data to internal buffer
-    unsigned int i;
-    unsigned int k;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        // start at mid-point (effective fftshift)
-        k = (i + _q->M/2) % _q->M;
-
-        sctype = _q->p[k];
-        if (sctype==OFDMFRAME_SCTYPE_NULL) {
-            // disabled subcarrier
-            _q->X[k] = 0.0f;
-        } else if (sctype==OFDMFRAME_SCTYPE_PILOT) {
-            // pilot subcarrier
-            _q->X[k] = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f) * _q->g_data;
-        } else {
-            // data subcarrier
-            _q->X[k] = _x[k] * _q->g_data;
-        }
-
-        //printf("X[%3u] = %12.8f + j*%12.8f;\n",i+1,crealf(_q->X[i]),cimagf(_q->X[i]));
-    }
+    ofdmframegen_load_symbol(_q, _x);
 
     // execute transform
     FFT_EXECUTE(_q->ifft);
@@ -315,15 +476,166 @@ void ofdmframegen_writetail(ofdmframegen    _q,
                             float complex * _buffer)
 {
     // write tail to output, applying tapering window
+    float * y = (float*)_buffer;
+    float * p = (float*)_q->postfix;
     unsigned int i;
-    for (i=0; i<_q->taper_len; i++)
-        _buffer[i] = _q->postfix[i] * _q->taper[_q->taper_len-i-1];
+    for (i=0; i<2*_q->taper_len; i++)
+        y[i] = p[i] * _q->taper_v[i];
+}
+
+// write first PLCP short sequence 'symbol' (real passband)
+//  _q      :   framing generator object
+//  _y      :   output samples, [size: _D*(_M+_cp_len) x 1]
+void ofdmframegen_write_S0a_real(ofdmframegen _q,
+                                 float *      _y)
+{
+    ofdmframegen_validate_real(_q, "write_S0a_real");
+    memmove(_y, _q->buf_S0a_r, _q->D*(_q->M + _q->cp_len)*sizeof(float));
+}
+
+// write second PLCP short sequence 'symbol' (real passband)
+void ofdmframegen_write_S0b_real(ofdmframegen _q,
+                                 float *      _y)
+{
+    ofdmframegen_validate_real(_q, "write_S0b_real");
+    memmove(_y, _q->buf_S0b_r, _q->D*(_q->M + _q->cp_len)*sizeof(float));
+
+    // copy postfix (first 'taper_len' samples of s0 symbol)
+    memmove(_q->postfix_r, _q->s0r, _q->D*_q->taper_len*sizeof(float));
+    _q->postfix_S0 = 1;
+}
+
+// write PLCP long sequence 'symbol' (real passband)
+void ofdmframegen_write_S1_real(ofdmframegen _q,
+                                float *      _y)
+{
+    ofdmframegen_validate_real(_q, "write_S1_real");
+    if (_q->postfix_S0) {
+        // following S0b: copy rendered symbol and update postfix
+        memmove(_y, _q->buf_S1_r, _q->D*(_q->M + _q->cp_len)*sizeof(float));
+        memmove(_q->postfix_r, _q->s1r, _q->D*_q->taper_len*sizeof(float));
+        _q->postfix_S0 = 0;
+        return;
+    }
+
+    memmove(_q->xr, _q->s1r, _q->D*_q->M*sizeof(float));
+    ofdmframegen_gensymbol_real(_q, _y);
+}
+
+// write OFDM symbol (real passband)
+//  _q      :   framing generator object
+//  _x      :   input symbols, [size: _M x 1]
+//  _y      :   output samples, [size: _D*(_M+_cp_len) x 1]
+void ofdmframegen_writesymbol_real(ofdmframegen    _q,
+                                   float complex * _x,
+                                   float *         _y)
+{
+    ofdmframegen_validate_real(_q, "writesymbol_real");
+
+    // move frequency data to internal buffer and transform
+    ofdmframegen_load_symbol(_q, _x);
+    ofdmframegen_passband_transform(_q, _q->X);
+
+    // copy result to output, adding cyclic prefix and tapering window
+    ofdmframegen_gensymbol_real(_q, _y);
+}
+
+// write tail to output (real passband)
+//  _q      :   framing generator object
+//  _buffer :   output samples, [size: _D*_taper_len x 1]
+void ofdmframegen_writetail_real(ofdmframegen _q,
+                                 float *      _buffer)
+{
+    ofdmframegen_validate_real(_q, "writetail_real");
+    unsigned int i;
+    unsigned int taper_len = _q->D*_q->taper_len;
+    for (i=0; i<taper_len; i++)
+        _buffer[i] = _q->postfix_r[i] * _q->taper_rv[i];
 }
 
 // 
 // internal methods
 //
 
+// ensure object was created for real passband output
+void ofdmframegen_validate_real(ofdmframegen _q,
+                                const char * _method)
+{
+    if (_q->D == 0) {
+        fprintf(stderr,"error: ofdmframegen_%s(), object not created with ofdmframegen_create_passband()\n", _method);
+        exit(1);
+    }
+}
+
+// load data and pilot subcarriers of next symbol into _q->X
+//  _q      :   framing generator object
+//  _x      :   input symbols, [size: _M x 1]
+void ofdmframegen_load_symbol(ofdmframegen    _q,
+                              float complex * _x)
+{
+    // pilot subcarriers, in fftshift order of the pilot sequence; pilot
+    // bits are drawn up to 32 at a time
+    unsigned int i;
+    unsigned int bits = 0;
+    unsigned int nb   = 0;
+    for (i=0; i<_q->M_pilot; i++) {
+        if (nb == 0) {
+            nb   = (_q->M_pilot - i < 32) ? _q->M_pilot - i : 32;
+            bits = msequence_generate_symbol(_q->ms_pilot, nb);
+        }
+        nb--;
+        _q->X[_q->pilot_idx[i]] = ((bits >> nb) & 1 ? 1.0f : -1.0f) * _q->g_data;
+    }
+
+    // data subcarriers
+    for (i=0; i<_q->M_data; i++) {
+        unsigned int k = _q->data_idx[i];
+        _q->X[k] = _x[k] * _q->g_data;
+    }
+}
+
+// map baseband subcarriers to passband bins and compute real symbol:
+// subcarrier i (frequency i, or i-M for i >= M/2) lands on bin k0+i
+// (or k0+i-M); the unnormalized c2r output is 2*Re{.}, hence the
+// scaling by 1/sqrt(2) for equal sample power
+//  _q      :   framing generator object
+//  _X      :   baseband subcarrier values, [size: _M x 1]
+void ofdmframegen_passband_transform(ofdmframegen    _q,
+                                     float complex * _X)
+{
+    unsigned int i;
+    unsigned int M2 = _q->M/2;
+    for (i=0; i<M2; i++) {
+        _q->Xr[_q->k0 + i]      = _X[i]      * M_SQRT1_2;
+        _q->Xr[_q->k0 - M2 + i] = _X[M2 + i] * M_SQRT1_2;
+    }
+    FFT_EXECUTE(_q->ifft_r);
+}
+
+// generate real passband symbol (add cyclic prefix/postfix, overlap);
+// as ofdmframegen_gensymbol() with all lengths scaled by _q->D
+//  _q->xr          :   input time-domain symbol [size: D*M x 1]
+//  _buffer         :   output sample buffer [size: D*(M + cp_len) x 1]
+void ofdmframegen_gensymbol_real(ofdmframegen _q,
+                                 float *      _buffer)
+{
+    unsigned int N         = _q->D*_q->M;
+    unsigned int cp_len    = _q->D*_q->cp_len;
+    unsigned int taper_len = _q->D*_q->taper_len;
+
+    // tapered head of cyclic prefix, overlapping previous post-fix
+    ofdmframegen_overlap_add(&_q->xr[N-cp_len], _q->postfix_r,
+                             _q->taper_r, _q->taper_rv, _buffer, taper_len);
+
+    // remainder of cyclic prefix and symbol
+    memcpy(&_buffer[taper_len], &_q->xr[N-cp_len+taper_len], (cp_len-taper_len)*sizeof(float));
+    memcpy(&_buffer[cp_len],    &_q->xr[0],                  N                 *sizeof(float));
+
+    // copy post-fix to output (first 'taper_len' samples of input symbol)
+    memcpy(_q->postfix_r, _q->xr, taper_len*sizeof(float));
+    _q->postfix_S0 = 0;
+}
+
 // generate symbol (add cyclic prefix/postfix, overlap)
 //
 //  ->|   |<- taper_len
@@ -338,25 +650,50 @@ void ofdmframegen_writetail(ofdmframegen    _q,
 //  _q->x           :   input time-domain symbol [size: _q->M x 1]
 //  _q->postfix     :   input:  post-fix from previous symbol [size: _q->taper_len x 1]
 //                      output: post-fix from this new symbol
-//  _q->taper       :   tapering window
+//  _q->taper_w     :   tapering window (interleaved)
+//  _q->taper_v     :   reversed tapering window (interleaved)
 //  _q->taper_len   :   tapering window length
 //
 //  _buffer         :   output sample buffer [size: (_q->M + _q->cp_len) x 1]
 void ofdmframegen_gensymbol(ofdmframegen    _q,
                             float complex * _buffer)
 {
-    // copy input symbol with cyclic prefix to output symbol
-    memmove( &_buffer[0],          &_q->x[_q->M-_q->cp_len], _q->cp_len*sizeof(float complex));
-    memmove( &_buffer[_q->cp_len], &_q->x[               0], _q->M    * sizeof(float complex));
-    
-    // apply tapering window to over-lapping regions
-    unsigned int i;
-    for (i=0; i<_q->taper_len; i++) {
-        _buffer[i] *= _q->taper[i];
-        _buffer[i] += _q->postfix[i] * _q->taper[_q->taper_len-i-1];
-    }
+    unsigned int M         = _q->M;
+    unsigned int cp_len    = _q->cp_len;
+    unsigned int taper_len = _q->taper_len;
+
+    // tapered head of cyclic prefix, overlapping previous post-fix
+    ofdmframegen_overlap_add((float*)&_q->x[M-cp_len], (float*)_q->postfix,
+                             _q->taper_w, _q->taper_v, (float*)_buffer, 2*taper_len);
+
+    // remainder of cyclic prefix and symbol
+    memcpy(&_buffer[taper_len], &_q->x[M-cp_len+taper_len], (cp_len-taper_len)*sizeof(float complex));
+    memcpy(&_buffer[cp_len],    &_q->x[0],                  M                 *sizeof(float complex));
 
     // copy post-fix to output (first 'taper_len' samples of input symbol)
-    memmove(_q->postfix, _q->x, _q->taper_len*sizeof(float complex));
+    memcpy(_q->postfix, _q->x, taper_len*sizeof(float complex));
+    _q->postfix_S0 = 0;
+}
+
+// tapered overlap-add, dispatched to the widest available kernel
+//  _x      :   input samples [size: _n x 1]
+//  _p      :   overlapping post-fix samples [size: _n x 1]
+//  _w      :   window applied to _x [size: _n x 1]
+//  _v      :   window applied to _p [size: _n x 1]
+//  _y      :   output samples [size: _n x 1]
+//  _n      :   number of (real) values
+void ofdmframegen_overlap_add(const float * _x,
+                              const float * _p,
+                              const float * _w,
+                              const float * _v,
+                              float *       _y,
+                              unsigned int  _n)
+{
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_OFDM) == LIQUID_SIMD_AVX2)
+        liquid_ofdm_taper_avx2(_x, _p, _w, _v, _y, _n);
+    else
+#endif
+    liquid_ofdm_taper(_x, _p, _w, _v, _y, _n);
 }
 
@@ -39,7 +39,9 @@
 #define DEBUG_OFDMFRAMESYNC_FILENAME    "ofdmframesync_internal_debug.m"
 #define DEBUG_OFDMFRAMESYNC_BUFFER_LEN  (2048)
 
-#define OFDMFRAMESYNC_ENABLE_SQUELCH    0
+// squelch noise floor: median of block levels over an effective
+// memory of this many blocks
+#define OFDMFRAMESYNC_SQUELCH_MEMORY    (32)
 
 struct ofdmframesync_s {
     unsigned int M;         // number of subcarriers
@@ -47,6 +49,9 @@ struct ofdmframesync_s {
     unsigned int cp_len;    // cyclic prefix length
     unsigned char * p;      // subcarrier allocation (null, pilot, data)
 
+    // fixed-size arrays below are regions of a single arena
+    liquid_arena arena;
+
     // constants
     unsigned int M_null;    // number of null subcarriers
     unsigned int M_pilot;   // number of pilot subcarriers
@@ -60,10 +65,22 @@ struct ofdmframesync_s {
     float g_S1;             // S1 training symbols gain
 
     // transform object
-    FFT_PLAN fft;           // ifft object
+    FFT_PLAN fft;           // fft object (enabled subcarriers only)
+    FFT_PLAN fft_window;    // fft object (all outputs, smoothing window)
     float complex * X;      // frequency-domain buffer
     float complex * x;      // time-domain buffer
     windowcf input_buffer;  // input sequence buffer
+    float complex * buf_rx; // mixed-down input block, [size: M+cp_len x 1]
+
+    // real passband mode (D_r == 0: complex baseband)
+    unsigned int D_r;       // real samples per baseband sample
+    unsigned int k0;        // transform bin of baseband subcarrier 0
+    unsigned int tick;      // real samples since last baseband sample
+    float g_r;              // scaling from passband bins to baseband
+    FFT_PLAN fft_r;         // real-to-complex transform
+    float * xr;             // real time-domain buffer [size: D*M x 1]
+    float complex * Xr;     // half spectrum [size: D*M/2+1 x 1]
+    windowf input_buffer_r; // real input sequence buffer
 
     // PLCP sequences
     float complex * S0;     // short sequence (freq)
@@ -85,7 +102,8 @@ struct ofdmframesync_s {
         OFDMFRAMESYNC_STATE_PLCPSHORT0,   // seek first PLCP short sequence
         OFDMFRAMESYNC_STATE_PLCPSHORT1,   // seek second PLCP short sequence
         OFDMFRAMESYNC_STATE_PLCPLONG,     // seek PLCP long sequence
-        OFDMFRAMESYNC_STATE_RXSYMBOLS     // receive payload symbols
+        OFDMFRAMESYNC_STATE_RXSYMBOLS,    // receive payload symbols
+        OFDMFRAMESYNC_STATE_SKIP          // discard remaining symbols of frame
     } state;
 
     // synchronizer objects
@@ -94,19 +112,46 @@ struct ofdmframesync_s {
     float phi_prime;        // ...
     float p1_prime;         // filtered pilot phase slope
 
-#if OFDMFRAMESYNC_ENABLE_SQUELCH
-    // coarse signal detection
-    float squelch_threshold;
-    int squelch_enabled;
-#endif
+    // pilot phase estimation (linear least-squares, closed form)
+    unsigned int * pilot_idx;   // pilot subcarrier indices (fftshift order)
+    float * pilot_fx;           // pilot frequency indices
+    float * pilot_phase;        // pilot phase (unwrapped)
+    float complex * pilot_val;  // pilot symbol values
+    float pilot_sx;             // sum of pilot frequency indices
+    float pilot_den;            // fit denominator, N*sum(x^2) - sum(x)^2
+
+    // decision-directed per-subcarrier gain tracking
+    float eq_mu;                // tracking gain (0: disabled)
+    modem mod_eq;               // decision slicer (NULL: pilots only)
+    unsigned int * data_idx;    // data subcarrier indices
+    float complex * D;          // subcarrier decisions [size: M x 1]
+    float complex * X_data;     // gathered data subcarriers [size: M_data x 1]
+    unsigned int * s_data;      // data subcarrier symbols [size: M_data x 1]
+
+    // squelch
+    int squelch_enabled;        // skip PLCP detection on low energy?
+    float squelch_threshold;    // squelch threshold above noise floor [dB]
+    noisefloor squelch_floor;   // noise floor estimate of block mean |x|^2
 
     // timing
     unsigned int timer;         // input sample timer
     unsigned int num_symbols;   // symbol counter
+    unsigned int skip;          // input samples left to discard
     unsigned int backoff;       // sample timing backoff
     float complex s_hat_0;      // first S0 symbol metrics estimate
     float complex s_hat_1;      // second S0 symbol metrics estimate
 
+    // running autocorrelation (Schmidl-Cox) seek metric over the
+    // repeated S0 half-symbols
+    float ac_thresh;            // |P|/R threshold (0: disabled)
+    float complex * ac_c;       // lagged products, [size: M/2 x 1]
+    float * ac_e;               // sample energies, [size: M/2 x 1]
+    unsigned int ac_index;      // ring index
+    float complex ac_P;         // running correlation
+    float ac_R;                 // running energy
+    float complex ac_P_next;    // exact sums over current ring pass
+    float ac_R_next;            //
+
     // detection thresholds
     float plcp_detect_thresh;   // plcp detection threshold, nominally 0.35
     float plcp_sync_thresh;     // long symbol threshold, nominally 0.30
@@ -115,6 +160,18 @@ struct ofdmframesync_s {
     ofdmframesync_callback callback;
     void * userdata;
 
+    // symbol-batch callback
+    ofdmframesync_batch_callback batch_callback;
+    unsigned int batch_max;     // maximum batch size, K (0: disabled)
+    unsigned int batch_len;     // symbols per batch, 1 <= batch_len <= K
+    unsigned int batch_num;     // symbols accumulated in current batch
+    float complex * Y;          // equalized symbols, [size: K x M]
+
+    // performance counters
+    int perf_enabled;                   // gather counters?
+    unsigned long int perf_samples[3];  // samples: seek, PLCP, symbols
+    unsigned long int perf_passes;      // PLCP detection passes
+
 #if DEBUG_OFDMFRAMESYNC
     int debug_enabled;
     int debug_objects_created;
@@ -144,7 +201,7 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
                                    ofdmframesync_callback _callback,
                                    void *                 _userdata)
 {
-    ofdmframesync q = (ofdmframesync) malloc(sizeof(struct ofdmframesync_s));
+    ofdmframesync q = (ofdmframesync) liquid_malloc(sizeof(struct ofdmframesync_s));
 
     // validate input
     if (_M < 8) {
@@ -163,15 +220,15 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     q->M2 = _M/2;
 
     // subcarrier allocation
-    q->p = (unsigned char*) malloc((q->M)*sizeof(unsigned char));
+    unsigned char p[q->M];
     if (_p == NULL) {
-        ofdmframe_init_default_sctype(q->M, q->p);
+        ofdmframe_init_default_sctype(q->M, p);
     } else {
-        memmove(q->p, _p, q->M*sizeof(unsigned char));
+        memmove(p, _p, q->M*sizeof(unsigned char));
     }
 
     // validate and count subcarrier allocation
-    ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
+    ofdmframe_validate_sctype(p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
     if ( (q->M_pilot + q->M_data) == 0) {
         fprintf(stderr,"error: ofdmframesync_create(), must have at least one enabled subcarrier\n");
         exit(1);
@@ -183,19 +240,39 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
         exit(1);
     }
 
+    // allocate all fixed-size arrays as one block: twelve of M complex
+    // samples, the input block, pilot/data tables and the
+    // autocorrelation arrays
+    unsigned long arena_size =
+        LIQUID_ARENA_SIZE(q->M*sizeof(unsigned char)) +
+        LIQUID_ARENA_SIZE(q->M*sizeof(float complex))*12 +
+        LIQUID_ARENA_SIZE((q->M + q->cp_len)*sizeof(float complex)) +
+        LIQUID_ARENA_SIZE(q->M_pilot*sizeof(unsigned int)) +
+        LIQUID_ARENA_SIZE(q->M_pilot*sizeof(float))*2 +
+        LIQUID_ARENA_SIZE(q->M_pilot*sizeof(float complex)) +
+        LIQUID_ARENA_SIZE(q->M_data*sizeof(unsigned int))*2 +
+        LIQUID_ARENA_SIZE(q->M_data*sizeof(float complex)) +
+        LIQUID_ARENA_SIZE(q->M2*sizeof(float complex)) +
+        LIQUID_ARENA_SIZE(q->M2*sizeof(float));
+    q->arena = liquid_arena_create(arena_size);
+    q->p = (unsigned char*) liquid_arena_alloc(q->arena, q->M*sizeof(unsigned char));
+    memmove(q->p, p, q->M*sizeof(unsigned char));
+
     // create transform object
-    q->X = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->x = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->fft = FFT_CREATE_PLAN(q->M, q->x, q->X, FFT_DIR_FORWARD, FFT_METHOD);
+    q->X = (float complex*) liquid_arena_calloc(q->arena, q->M, sizeof(float complex));
+    q->x = (float complex*) liquid_arena_alloc(q->arena, (q->M)*sizeof(float complex));
+    q->fft = ofdmframe_create_plan(q->p, q->M, q->x, q->X, FFT_DIR_FORWARD);
+    q->fft_window = FFT_CREATE_PLAN(q->M, q->x, q->X, FFT_DIR_FORWARD, FFT_METHOD);
  
     // create input buffer the length of the transform
     q->input_buffer = windowcf_create(q->M + q->cp_len);
+    q->buf_rx = (float complex*) liquid_arena_alloc(q->arena, (q->M + q->cp_len)*sizeof(float complex));
 
     // allocate memory for PLCP arrays
-    q->S0 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->s0 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->S1 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->s1 = (float complex*) malloc((q->M)*sizeof(float complex));
+    q->S0 = (float complex*) liquid_arena_alloc(q->arena, (q->M)*sizeof(float complex));
+    q->s0 = (float complex*) liquid_arena_alloc(q->arena, (q->M)*sizeof(float complex));
+    q->S1 = (float complex*) liquid_arena_alloc(q->arena, (q->M)*sizeof(float complex));
+    q->s1 = (float complex*) liquid_arena_alloc(q->arena, (q->M)*sizeof(float complex));
     ofdmframe_init_S0(q->p, q->M, q->S0, q->s0, &q->M_S0);
     ofdmframe_init_S1(q->p, q->M, q->S1, q->s1, &q->M_S1);
 
@@ -206,18 +283,11 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
 
     // gain
     q->g0 = 1.0f;
-    q->G0 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->G1 = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->G  = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->B  = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->R  = (float complex*) malloc((q->M)*sizeof(float complex));
-
-#if 1
-    memset(q->G0, 0x00, q->M*sizeof(float complex));
-    memset(q->G1, 0x00, q->M*sizeof(float complex));
-    memset(q->G , 0x00, q->M*sizeof(float complex));
-    memset(q->B,  0x00, q->M*sizeof(float complex));
-#endif
+    q->G0 = (float complex*) liquid_arena_calloc(q->arena, q->M, sizeof(float complex));
+    q->G1 = (float complex*) liquid_arena_calloc(q->arena, q->M, sizeof(float complex));
+    q->G  = (float complex*) liquid_arena_calloc(q->arena, q->M, sizeof(float complex));
+    q->B  = (float complex*) liquid_arena_calloc(q->arena, q->M, sizeof(float complex));
+    q->R  = (float complex*) liquid_arena_alloc (q->arena, (q->M)*sizeof(float complex));
 
     // timing backoff
     q->backoff = q->cp_len < 2 ? q->cp_len : 2;
@@ -230,6 +300,13 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     q->callback = _callback;
     q->userdata = _userdata;
 
+    // symbol-batch callback (disabled by default)
+    q->batch_callback = NULL;
+    q->batch_max = 0;
+    q->batch_len = 0;
+    q->batch_num = 0;
+    q->Y         = NULL;
+
     // 
     // synchronizer objects
     //
@@ -237,18 +314,56 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     // numerically-controlled oscillator
     q->nco_rx = nco_crcf_create(LIQUID_NCO);
 
+    // complex baseband input
+    q->D_r  = 0;
+    q->tick = 0;
+
     // set pilot sequence
     q->ms_pilot = msequence_create_default(8);
 
-#if OFDMFRAMESYNC_ENABLE_SQUELCH
-    // coarse detection
-    q->squelch_threshold = -25.0f;
-    q->squelch_enabled = 0;
-#endif
+    // pilot and data subcarrier tables; the pilot phase fit abscissae
+    // are fixed so the denominator is computed once
+    q->pilot_idx   = (unsigned int*)  liquid_arena_alloc(q->arena, q->M_pilot*sizeof(unsigned int));
+    q->pilot_fx    = (float*)         liquid_arena_alloc(q->arena, q->M_pilot*sizeof(float));
+    q->pilot_phase = (float*)         liquid_arena_alloc(q->arena, q->M_pilot*sizeof(float));
+    q->pilot_val   = (float complex*) liquid_arena_alloc(q->arena, q->M_pilot*sizeof(float complex));
+    q->data_idx    = (unsigned int*)  liquid_arena_alloc(q->arena, q->M_data*sizeof(unsigned int));
+    ofdmframe_index_sctype(q->p, q->M, 0, q->pilot_idx, q->data_idx);
+    float sxx = 0.0f;
+    q->pilot_sx = 0.0f;
+    for (i=0; i<q->M_pilot; i++) {
+        unsigned int k = q->pilot_idx[i];
+        float fx = (k > q->M2) ? (float)k - (float)(q->M) : (float)k;
+        q->pilot_fx[i] = fx;
+        q->pilot_sx   += fx;
+        sxx           += fx*fx;
+    }
+    q->pilot_den = (float)(q->M_pilot)*sxx - q->pilot_sx*q->pilot_sx;
+
+    // gain tracking (disabled by default)
+    q->eq_mu  = 0.0f;
+    q->mod_eq = NULL;
+    q->D      = (float complex*) liquid_arena_alloc(q->arena, (q->M)*sizeof(float complex));
+    q->X_data = (float complex*) liquid_arena_alloc(q->arena, q->M_data*sizeof(float complex));
+    q->s_data = (unsigned int*)  liquid_arena_alloc(q->arena, q->M_data*sizeof(unsigned int));
+
+    // autocorrelation seek (disabled by default)
+    q->ac_thresh = 0.0f;
+    q->ac_c = (float complex*) liquid_arena_alloc(q->arena, q->M2*sizeof(float complex));
+    q->ac_e = (float*)         liquid_arena_alloc(q->arena, q->M2*sizeof(float));
+
+    // squelch (disabled by default)
+    q->squelch_enabled   = 0;
+    q->squelch_threshold = 2.0f;
+    q->squelch_floor     = noisefloor_create(0.5f, OFDMFRAMESYNC_SQUELCH_MEMORY);
 
     // reset object
     ofdmframesync_reset(q);
 
+    // performance counters (disabled by default)
+    q->perf_enabled = 0;
+    ofdmframesync_reset_perfcounts(q);
+
 #if DEBUG_OFDMFRAMESYNC
     q->debug_enabled = 0;
     q->debug_objects_created = 0;
@@ -269,6 +384,61 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     return q;
 }
 
+// create OFDM framing synchronizer object operating on real passband
+// samples (see ofdmframegen_create_passband()); each transform window
+// of _D*_M real samples is computed with a real-to-complex transform
+// and the _M bins about the center frequency are taken as the baseband
+// subcarriers, replacing mixing and decimation. Timing is resolved to
+// within _D real samples, the remainder being absorbed by the channel
+// estimate. Carrier frequency offset is not corrected as the carrier
+// is not recovered in passband; residual phase is tracked with pilots.
+//  _M          :   number of subcarriers, >10 typical
+//  _cp_len     :   cyclic prefix length (baseband samples)
+//  _taper_len  :   taper length (baseband samples)
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+//  _D          :   real samples per baseband sample, _D >= 2
+//  _fc         :   center frequency relative to real sample rate, (0,0.5)
+//  _callback   :   user-defined callback function
+//  _userdata   :   user-defined data pointer
+ofdmframesync ofdmframesync_create_passband(unsigned int           _M,
+                                            unsigned int           _cp_len,
+                                            unsigned int           _taper_len,
+                                            unsigned char *        _p,
+                                            unsigned int           _D,
+                                            float                  _fc,
+                                            ofdmframesync_callback _callback,
+                                            void *                 _userdata)
+{
+    // validate input
+    if (_D < 2) {
+        fprintf(stderr,"error: ofdmframesync_create_passband(), samples per baseband sample must be at least 2\n");
+        exit(1);
+    }
+    unsigned int N  = _D*_M;
+    unsigned int k0 = (unsigned int)roundf(_fc*(float)N);
+    if (_fc <= 0.0f || k0 <= _M/2 || k0 + _M/2 > N/2) {
+        fprintf(stderr,"error: ofdmframesync_create_passband(), band (center %g, width %g) must lie within (0,0.5)\n",
+                _fc, 1.0f/(float)_D);
+        exit(1);
+    }
+
+    ofdmframesync q = ofdmframesync_create(_M, _cp_len, _taper_len, _p, _callback, _userdata);
+    q->D_r = _D;
+    q->k0  = k0;
+
+    // bins scale by N/M relative to baseband, and the generator scales
+    // the real signal by 1/sqrt(2)
+    q->g_r = M_SQRT2 / (float)(q->D_r);
+
+    // transform and input buffer
+    q->xr    = (float*)         liquid_malloc(N*sizeof(float));
+    q->Xr    = (float complex*) liquid_malloc((N/2+1)*sizeof(float complex));
+    q->fft_r = FFT_CREATE_PLAN_R2C(N, q->xr, q->Xr, FFT_METHOD);
+    q->input_buffer_r = windowf_create(q->D_r*(q->M + q->cp_len));
+
+    return q;
+}
+
 void ofdmframesync_destroy(ofdmframesync _q)
 {
 #if DEBUG_OFDMFRAMESYNC
@@ -276,41 +446,41 @@ void ofdmframesync_destroy(ofdmframesync _q)
     if (_q->debug_x         != NULL) windowcf_destroy(_q->debug_x);
     if (_q->debug_rssi      != NULL) windowf_destroy(_q->debug_rssi);
     if (_q->debug_framesyms != NULL) windowcf_destroy(_q->debug_framesyms);
-    if (_q->G_hat           != NULL) free(_q->G_hat);
-    if (_q->px              != NULL) free(_q->px);
-    if (_q->py              != NULL) free(_q->py);
+    if (_q->G_hat           != NULL) liquid_free(_q->G_hat);
+    if (_q->px              != NULL) liquid_free(_q->px);
+    if (_q->py              != NULL) liquid_free(_q->py);
     if (_q->debug_pilot_0   != NULL) windowf_destroy(_q->debug_pilot_0);
     if (_q->debug_pilot_1   != NULL) windowf_destroy(_q->debug_pilot_1);
 #endif
 
-    // free subcarrier type array memory
-    free(_q->p);
-
     // free transform object
     windowcf_destroy(_q->input_buffer);
-    free(_q->X);
-    free(_q->x);
     FFT_DESTROY_PLAN(_q->fft);
-
-    // clean up PLCP arrays
-    free(_q->S0);
-    free(_q->s0);
-    free(_q->S1);
-    free(_q->s1);
-
-    // free gain arrays
-    free(_q->G0);
-    free(_q->G1);
-    free(_q->G);
-    free(_q->B);
-    free(_q->R);
+    FFT_DESTROY_PLAN(_q->fft_window);
 
     // destroy synchronizer objects
     nco_crcf_destroy(_q->nco_rx);           // numerically-controlled oscillator
+
+    // free passband objects
+    if (_q->D_r > 0) {
+        FFT_DESTROY_PLAN(_q->fft_r);
+        liquid_free(_q->xr);
+        liquid_free(_q->Xr);
+        windowf_destroy(_q->input_buffer_r);
+    }
     msequence_destroy(_q->ms_pilot);
+    noisefloor_destroy(_q->squelch_floor);
+
+    // free gain tracking objects
+    if (_q->mod_eq != NULL)
+        modem_destroy(_q->mod_eq);
+    liquid_free(_q->Y);
+
+    // free all fixed-size arrays
+    liquid_arena_destroy(_q->arena);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void ofdmframesync_print(ofdmframesync _q)
@@ -321,6 +491,50 @@ void ofdmframesync_print(ofdmframesync _q)
     //printf("    taper len           :   %-u\n", _q->taper_len);
 }
 
+// get memory footprint of synchronizer, its transforms, buffers and
+// internal objects [bytes]
+unsigned long int ofdmframesync_get_memory_usage(ofdmframesync _q)
+{
+    unsigned long int n = sizeof(struct ofdmframesync_s);
+
+    // subcarrier allocation, transforms and input buffer
+    n += _q->M*sizeof(unsigned char);
+    n += 2*_q->M*sizeof(float complex);     // X, x
+    n += FFT_GET_MEMORY_USAGE(_q->fft);
+    n += FFT_GET_MEMORY_USAGE(_q->fft_window);
+    n += windowcf_get_memory_usage(_q->input_buffer);
+    n += (_q->M + _q->cp_len)*sizeof(float complex);
+
+    // real passband mode
+    if (_q->D_r > 0) {
+        unsigned int N = _q->D_r*_q->M;
+        n += N*sizeof(float) + (N/2+1)*sizeof(float complex);
+        n += FFT_GET_MEMORY_USAGE(_q->fft_r);
+        n += windowf_get_memory_usage(_q->input_buffer_r);
+    }
+
+    // PLCP sequences and gain estimates: S0, s0, S1, s1, G0, G1, G, B, R
+    n += 9*_q->M*sizeof(float complex);
+
+    // pilot phase estimation
+    n += nco_crcf_get_memory_usage(_q->nco_rx);
+    n += sizeof(struct msequence_s);
+    n += _q->M_pilot*(sizeof(unsigned int) + 2*sizeof(float) + sizeof(float complex));
+
+    // decision-directed gain tracking
+    if (_q->mod_eq != NULL)
+        n += modem_get_memory_usage(_q->mod_eq);
+    n += _q->M_data*(2*sizeof(unsigned int) + sizeof(float complex));
+    n += _q->M*sizeof(float complex);       // D
+
+    // running autocorrelation
+    n += _q->M2*(sizeof(float complex) + sizeof(float));
+
+    // symbol batch
+    n += _q->batch_max*_q->M*sizeof(float complex);
+    return n;
+}
+
 void ofdmframesync_reset(ofdmframesync _q)
 {
 #if 0
@@ -336,28 +550,75 @@ void ofdmframesync_reset(ofdmframesync _q)
 
     // reset timers
     _q->timer = 0;
+    _q->tick  = 0;
     _q->num_symbols = 0;
+    _q->skip  = 0;
     _q->s_hat_0 = 0.0f;
     _q->s_hat_1 = 0.0f;
     _q->phi_prime = 0.0f;
     _q->p1_prime = 0.0f;
 
+    // reset autocorrelator
+    memset(_q->ac_c, 0x00, _q->M2*sizeof(float complex));
+    memset(_q->ac_e, 0x00, _q->M2*sizeof(float));
+    _q->ac_index  = 0;
+    _q->ac_P      = 0.0f;
+    _q->ac_R      = 0.0f;
+    _q->ac_P_next = 0.0f;
+    _q->ac_R_next = 0.0f;
+
+    // discard partial symbol batch
+    _q->batch_num = 0;
+
     // set thresholds (increase for small number of subcarriers)
     _q->plcp_detect_thresh = (_q->M > 44) ? 0.35f : 0.35f + 0.01f*(44 - _q->M);
     _q->plcp_sync_thresh   = (_q->M > 44) ? 0.30f : 0.30f + 0.01f*(44 - _q->M);
 
     // reset state
     _q->state = OFDMFRAMESYNC_STATE_SEEKPLCP;
+    FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_STATE, _q->state);
 }
 
 void ofdmframesync_execute(ofdmframesync _q,
                            float complex * _x,
                            unsigned int _n)
 {
-    unsigned int i;
+    if (_q->D_r > 0) {
+        fprintf(stderr,"error: ofdmframesync_execute(), passband object requires ofdmframesync_execute_real()\n");
+        exit(1);
+    }
+
+    unsigned int i = 0;
     float complex x;
-    for (i=0; i<_n; i++) {
-        x = _x[i];
+    while (i < _n) {
+        // seeking with autocorrelator: run through block of samples
+        if (_q->state == OFDMFRAMESYNC_STATE_SEEKPLCP && _q->ac_thresh > 0.0f) {
+            i += ofdmframesync_seek_block(_q, &_x[i], _n - i);
+            continue;
+        }
+
+        // skipping symbols: discard input without mixing or buffering
+        if (_q->state == OFDMFRAMESYNC_STATE_SKIP) {
+            i += ofdmframesync_skip_block(_q, _n - i);
+            continue;
+        }
+
+        // receiving payload: process remainder of symbol as a block
+        // once enough input is available (the first symbol after the
+        // long sequence also waits out the timing backoff per sample)
+        if (_q->state == OFDMFRAMESYNC_STATE_RXSYMBOLS &&
+            _q->timer > 0 && _q->timer <= _q->M + _q->cp_len &&
+            _n - i >= _q->timer)
+        {
+            unsigned int num = _q->timer;
+            if (_q->perf_enabled)
+                _q->perf_samples[2] += num;
+            ofdmframesync_execute_rxsymbols_block(_q, &_x[i]);
+            i += num;
+            continue;
+        }
+
+        x = _x[i++];
 
         // correct for carrier frequency offset
         if (_q->state != OFDMFRAMESYNC_STATE_SEEKPLCP) {
@@ -375,28 +636,79 @@ void ofdmframesync_execute(ofdmframesync _q,
         }
 #endif
 
-        switch (_q->state) {
-        case OFDMFRAMESYNC_STATE_SEEKPLCP:
-            ofdmframesync_execute_seekplcp(_q);
-            break;
-        case OFDMFRAMESYNC_STATE_PLCPSHORT0:
-            ofdmframesync_execute_S0a(_q);
-            break;
-        case OFDMFRAMESYNC_STATE_PLCPSHORT1:
-            ofdmframesync_execute_S0b(_q);
-            break;
-        case OFDMFRAMESYNC_STATE_PLCPLONG:
-            ofdmframesync_execute_S1(_q);
-            break;
-        case OFDMFRAMESYNC_STATE_RXSYMBOLS:
-            ofdmframesync_execute_rxsymbols(_q);
-            break;
-        default:;
+        // accumulate samples processed per state
+        if (_q->perf_enabled) {
+            switch (_q->state) {
+            case OFDMFRAMESYNC_STATE_SEEKPLCP:  _q->perf_samples[0]++; break;
+            case OFDMFRAMESYNC_STATE_RXSYMBOLS: _q->perf_samples[2]++; break;
+            default:                            _q->perf_samples[1]++;
+            }
         }
 
-    } // for (i=0; i<_n; i++)
+        // advance state machine
+        ofdmframesync_step(_q);
+
+    } // while (i < _n)
 } // ofdmframesync_execute()
 
+// execute synchronizer on real passband samples (object must have
+// been created with ofdmframesync_create_passband())
+//  _q      :   synchronizer object
+//  _x      :   input samples, [size: _n x 1]
+//  _n      :   number of input samples
+void ofdmframesync_execute_real(ofdmframesync _q,
+                                float *       _x,
+                                unsigned int  _n)
+{
+    if (_q->D_r == 0) {
+        fprintf(stderr,"error: ofdmframesync_execute_real(), object not created with ofdmframesync_create_passband()\n");
+        exit(1);
+    }
+
+    unsigned int i = 0;
+    while (i < _n) {
+        // skipping symbols: discard input without buffering
+        if (_q->state == OFDMFRAMESYNC_STATE_SKIP) {
+            i += ofdmframesync_skip_block(_q, _n - i);
+            continue;
+        }
+
+        // receiving payload: buffer remainder of symbol at once
+        if (_q->state == OFDMFRAMESYNC_STATE_RXSYMBOLS &&
+            _q->timer > 0 && _q->timer <= _q->M + _q->cp_len &&
+            _n - i >= _q->timer*_q->D_r - _q->tick)
+        {
+            unsigned int num = _q->timer*_q->D_r - _q->tick;
+            if (_q->perf_enabled)
+                _q->perf_samples[2] += num;
+            windowf_write(_q->input_buffer_r, &_x[i], num);
+            i += num;
+            _q->tick  = 0;
+            _q->timer = 1;
+            ofdmframesync_execute_rxsymbols(_q);
+            continue;
+        }
+
+        // save input sample to buffer
+        windowf_push(_q->input_buffer_r, _x[i++]);
+
+        // accumulate samples processed per state
+        if (_q->perf_enabled) {
+            switch (_q->state) {
+            case OFDMFRAMESYNC_STATE_SEEKPLCP:  _q->perf_samples[0]++; break;
+            case OFDMFRAMESYNC_STATE_RXSYMBOLS: _q->perf_samples[2]++; break;
+            default:                            _q->perf_samples[1]++;
+            }
+        }
+
+        // advance state machine once per baseband sample
+        if (++_q->tick < _q->D_r)
+            continue;
+        _q->tick = 0;
+        ofdmframesync_step(_q);
+    }
+}
+
 // get receiver RSSI
 float ofdmframesync_get_rssi(ofdmframesync _q)
 {
@@ -409,47 +721,458 @@ float ofdmframesync_get_cfo(ofdmframesync _q)
     return nco_crcf_get_frequency(_q->nco_rx);
 }
 
+// set decision-directed subcarrier gain tracking; after every payload
+// symbol each subcarrier's equalizer gain is nudged toward the pilot
+// (or, given a modulation scheme, the data decision)
+//  _q      :   synchronizer object
+//  _mu     :   tracking gain, 0 <= _mu < 1 (0 disables tracking)
+//  _ms     :   data modulation scheme (LIQUID_MODEM_UNKNOWN: pilots only)
+void ofdmframesync_set_eq_tracking(ofdmframesync     _q,
+                                   float             _mu,
+                                   modulation_scheme _ms)
+{
+    if (_mu < 0.0f || _mu >= 1.0f) {
+        fprintf(stderr,"error: ofdmframesync_set_eq_tracking(), tracking gain must be in [0,1)\n");
+        exit(1);
+    }
+    _q->eq_mu = _mu;
+
+    if (_q->mod_eq != NULL) {
+        modem_destroy(_q->mod_eq);
+        _q->mod_eq = NULL;
+    }
+    if (_ms != LIQUID_MODEM_UNKNOWN)
+        _q->mod_eq = modem_create(_ms);
+}
+
+// set running-autocorrelation PLCP seek; while seeking, the lag-M/2
+// correlation P and energy R of the input are updated recursively
+// each sample and the transform-based detector is run only while
+// |P|/R exceeds the threshold (at most every M/4 samples)
+//  _q          :   synchronizer object
+//  _threshold  :   metric threshold, 0 <= _threshold < 1 (0: disabled)
+void ofdmframesync_set_seek_autocorr(ofdmframesync _q,
+                                     float         _threshold)
+{
+    if (_threshold < 0.0f || _threshold >= 1.0f) {
+        fprintf(stderr,"error: ofdmframesync_set_seek_autocorr(), threshold must be in [0,1)\n");
+        exit(1);
+    }
+    _q->ac_thresh = _threshold;
+    ofdmframesync_reset(_q);
+}
+
+// enable squelch; PLCP detection is skipped until the input energy
+// rises above the adaptive noise floor estimate
+void ofdmframesync_squelch_enable(ofdmframesync _q)
+{
+    // restart noise floor estimate
+    if (!_q->squelch_enabled)
+        noisefloor_reset(_q->squelch_floor);
+
+    _q->squelch_enabled = 1;
+}
+
+// disable squelch
+void ofdmframesync_squelch_disable(ofdmframesync _q)
+{
+    _q->squelch_enabled = 0;
+}
+
+// is squelch enabled?
+int ofdmframesync_squelch_is_enabled(ofdmframesync _q)
+{
+    return _q->squelch_enabled;
+}
+
+// set squelch threshold above noise floor [dB]
+void ofdmframesync_squelch_set_threshold(ofdmframesync _q,
+                                         float         _threshold)
+{
+    if (_threshold < 0.0f) {
+        fprintf(stderr,"warning: ofdmframesync_squelch_set_threshold(), threshold (%12.4e) out of range; ignoring\n", _threshold);
+        return;
+    }
+
+    _q->squelch_threshold = _threshold;
+}
+
+// get squelch threshold above noise floor [dB]
+float ofdmframesync_squelch_get_threshold(ofdmframesync _q)
+{
+    return _q->squelch_threshold;
+}
+
+// get squelch noise floor estimate, mean |x|^2 [dB]
+float ofdmframesync_squelch_get_noise_floor(ofdmframesync _q)
+{
+    // not yet estimated
+    if (noisefloor_get_num_blocks(_q->squelch_floor) == 0)
+        return -1e6f;
+
+    return 10.0f*log10f(noisefloor_get_level(_q->squelch_floor) + 1e-36f);
+}
+
+// set symbol-batch callback: equalized symbols are accumulated into a
+// contiguous K x M matrix and passed to _callback in place of the
+// per-symbol callback once the batch length has been reached
+//  _q          :   synchronizer object
+//  _K          :   maximum batch size (0: per-symbol callback)
+//  _callback   :   batch callback function
+void ofdmframesync_set_batch(ofdmframesync                _q,
+                             unsigned int                 _K,
+                             ofdmframesync_batch_callback _callback)
+{
+    _q->batch_callback = _callback;
+    _q->batch_max = _K;
+    _q->batch_len = _K;
+    _q->batch_num = 0;
+    liquid_free(_q->Y);
+    _q->Y = _K > 0 ? (float complex*) liquid_malloc(_K*_q->M*sizeof(float complex)) : NULL;
+}
+
+// set number of symbols in next batch, e.g. from within the batch
+// callback to align batches with frame sections; persists until changed
+//  _q          :   synchronizer object
+//  _n          :   batch length, 1 <= _n <= K
+void ofdmframesync_set_batch_len(ofdmframesync _q,
+                                 unsigned int  _n)
+{
+    if (_n == 0 || _n > _q->batch_max) {
+        fprintf(stderr,"error: ofdmframesync_set_batch_len(), batch length (%u) must be in [1,%u]\n",
+                _n, _q->batch_max);
+        exit(1);
+    }
+    _q->batch_len = _n;
+}
+
+// discard the next _num_symbols OFDM symbols without transforming or
+// equalizing them, then reset to seek the next frame; intended to be
+// called from within the callback to skip the rest of a frame
+//  _q              :   synchronizer object
+//  _num_symbols    :   number of symbols to discard
+void ofdmframesync_skip_symbols(ofdmframesync _q,
+                                unsigned int  _num_symbols)
+{
+    unsigned int n = _num_symbols*(_q->M + _q->cp_len);
+    if (n == 0) {
+        ofdmframesync_reset(_q);
+        return;
+    }
+    _q->skip  = _q->D_r > 0 ? n*_q->D_r : n;
+    _q->state = OFDMFRAMESYNC_STATE_SKIP;
+    FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_STATE, _q->state);
+}
+
+// enable/disable performance counters
+void ofdmframesync_perf_enable(ofdmframesync _q,
+                               int           _enable)
+{
+    _q->perf_enabled = _enable;
+}
+
+// reset performance counters
+void ofdmframesync_reset_perfcounts(ofdmframesync _q)
+{
+    _q->perf_samples[0] = 0;
+    _q->perf_samples[1] = 0;
+    _q->perf_samples[2] = 0;
+    _q->perf_passes     = 0;
+}
+
+// get performance counters
+//  _q          :   synchronizer object
+//  _samples    :   samples processed seeking PLCP, in PLCP, receiving
+//                  symbols [size: 3 x 1]
+//  _passes     :   number of PLCP detection passes
+void ofdmframesync_get_perfcounts(ofdmframesync       _q,
+                                  unsigned long int * _samples,
+                                  unsigned long int * _passes)
+{
+    _samples[0] = _q->perf_samples[0];
+    _samples[1] = _q->perf_samples[1];
+    _samples[2] = _q->perf_samples[2];
+    *_passes    = _q->perf_passes;
+}
+
 
 //
 // internal methods
 //
 
+// advance state machine by one (baseband) sample
+void ofdmframesync_step(ofdmframesync _q)
+{
+    switch (_q->state) {
+    case OFDMFRAMESYNC_STATE_SEEKPLCP:
+        ofdmframesync_execute_seekplcp(_q);
+        break;
+    case OFDMFRAMESYNC_STATE_PLCPSHORT0:
+        ofdmframesync_execute_S0a(_q);
+        break;
+    case OFDMFRAMESYNC_STATE_PLCPSHORT1:
+        ofdmframesync_execute_S0b(_q);
+        break;
+    case OFDMFRAMESYNC_STATE_PLCPLONG:
+        ofdmframesync_execute_S1(_q);
+        break;
+    case OFDMFRAMESYNC_STATE_RXSYMBOLS:
+        ofdmframesync_execute_rxsymbols(_q);
+        break;
+    default:;
+    }
+}
+
+// compute subcarrier values in _q->X from the M (baseband) samples of
+// the input buffer starting at _offset; in passband mode the D*M real
+// samples are transformed and the bins about the center frequency
+// mapped to baseband subcarriers
+//  _q      :   ofdmframesync object
+//  _offset :   window offset, _offset <= cp_len
+void ofdmframesync_transform(ofdmframesync _q,
+                             unsigned int  _offset)
+{
+    if (_q->D_r == 0) {
+        float complex * rc;
+        windowcf_read(_q->input_buffer, &rc);
+        memmove(_q->x, &rc[_offset], (_q->M)*sizeof(float complex));
+        FFT_EXECUTE(_q->fft);
+        return;
+    }
+
+    float * r;
+    windowf_read(_q->input_buffer_r, &r);
+    memmove(_q->xr, &r[_q->D_r*_offset], _q->D_r*_q->M*sizeof(float));
+    FFT_EXECUTE(_q->fft_r);
+
+    unsigned int i;
+    for (i=0; i<_q->M2; i++) {
+        _q->X[i]          = _q->Xr[_q->k0 + i]          * _q->g_r;
+        _q->X[_q->M2 + i] = _q->Xr[_q->k0 - _q->M2 + i] * _q->g_r;
+    }
+}
+
+// update running autocorrelation with most recent input sample, r[n]:
+//   P = sum conj(r[k-M/2]) r[k],  R = sum |r[k]|^2,  n-M/2 < k <= n
+// In passband mode the real input at baseband sample instants is used;
+// S0 remains (anti-)periodic in M/2 baseband samples. The sums are
+// replaced with exact ones on each pass of the ring so that round-off
+// does not accumulate.
+void ofdmframesync_autocorr_push(ofdmframesync _q)
+{
+    float complex r0;   // r[n]
+    float complex r1;   // r[n-M/2]
+    if (_q->D_r == 0) {
+        float complex * rc;
+        windowcf_read(_q->input_buffer, &rc);
+        r0 = rc[_q->M  + _q->cp_len - 1];
+        r1 = rc[_q->M2 + _q->cp_len - 1];
+    } else {
+        float * rr;
+        windowf_read(_q->input_buffer_r, &rr);
+        unsigned int n = _q->D_r*(_q->M + _q->cp_len) - 1;
+        r0 = rr[n];
+        r1 = rr[n - _q->D_r*_q->M2];
+    }
+
+    float complex c = conjf(r1)*r0;
+    float e = crealf(r0)*crealf(r0) + cimagf(r0)*cimagf(r0);
+
+    unsigned int k = _q->ac_index;
+    _q->ac_P += c - _q->ac_c[k];
+    _q->ac_R += e - _q->ac_e[k];
+    _q->ac_c[k] = c;
+    _q->ac_e[k] = e;
+    _q->ac_P_next += c;
+    _q->ac_R_next += e;
+
+    if (++k == _q->M2) {
+        k = 0;
+        _q->ac_P      = _q->ac_P_next;
+        _q->ac_R      = _q->ac_R_next;
+        _q->ac_P_next = 0.0f;
+        _q->ac_R_next = 0.0f;
+
+        // squelch noise floor tracks completed blocks
+        if (_q->squelch_enabled)
+            noisefloor_push(_q->squelch_floor, _q->ac_R / (float)(_q->M2));
+    }
+    _q->ac_index = k;
+}
+
+// seek PLCP over a block of (complex baseband) input samples with the
+// running autocorrelator, stopping at the first sample for which the
+// metric exceeds the threshold and running the detector there
+//  _q      :   ofdmframesync object
+//  _x      :   input samples, [size: _n x 1]
+//  _n      :   number of input samples
+//  returns number of samples consumed
+unsigned int ofdmframesync_seek_block(ofdmframesync   _q,
+                                      float complex * _x,
+                                      unsigned int    _n)
+{
+    // samples M/2 before the block start still in the input buffer
+    float complex * rc;
+    windowcf_read(_q->input_buffer, &rc);
+    float complex * h = rc + _q->M + _q->cp_len - _q->M2;
+
+    unsigned int  L      = _q->M2;
+    unsigned int  k      = _q->ac_index;
+    unsigned int  timer  = _q->timer;
+    float complex P      = _q->ac_P;
+    float         R      = _q->ac_R;
+    float complex P_next = _q->ac_P_next;
+    float         R_next = _q->ac_R_next;
+    float         t2     = _q->ac_thresh*_q->ac_thresh;
+    int detect = 0;
+
+    unsigned int j;
+    for (j=0; j<_n; j++) {
+        float complex r0 = _x[j];
+        float complex r1 = j < L ? h[j] : _x[j-L];
+        float complex c  = conjf(r1)*r0;
+        float         e  = crealf(r0)*crealf(r0) + cimagf(r0)*cimagf(r0);
+
+        P += c - _q->ac_c[k];
+        R += e - _q->ac_e[k];
+        _q->ac_c[k] = c;
+        _q->ac_e[k] = e;
+        P_next += c;
+        R_next += e;
+        if (++k == L) {
+            k = 0;
+            P = P_next;
+            R = R_next;
+            P_next = 0.0f;
+            R_next = 0.0f;
+
+            // squelch noise floor tracks completed blocks
+            if (_q->squelch_enabled)
+                noisefloor_push(_q->squelch_floor, R / (float)L);
+        }
+
+        timer++;
+        if (timer >= L/2 && crealf(P)*crealf(P) + cimagf(P)*cimagf(P) > t2*R*R) {
+            detect = 1;
+            j++;
+            break;
+        }
+    }
+
+    _q->ac_index  = k;
+    _q->timer     = timer;
+    _q->ac_P      = P;
+    _q->ac_R      = R;
+    _q->ac_P_next = P_next;
+    _q->ac_R_next = R_next;
+
+    windowcf_write(_q->input_buffer, _x, j);
+    if (_q->perf_enabled)
+        _q->perf_samples[0] += j;
+
+    if (detect)
+        ofdmframesync_detect_plcp(_q);
+
+    return j;
+}
+
 // frame detection
 void ofdmframesync_execute_seekplcp(ofdmframesync _q)
 {
     _q->timer++;
 
-    if (_q->timer < _q->M)
+    if (_q->ac_thresh > 0.0f) {
+        // run detector only while autocorrelation metric is high
+        ofdmframesync_autocorr_push(_q);
+        if (_q->timer < _q->M2/2)
+            return;
+        float P2 = crealf(_q->ac_P)*crealf(_q->ac_P) + cimagf(_q->ac_P)*cimagf(_q->ac_P);
+        float t2 = _q->ac_thresh*_q->ac_thresh*_q->ac_R*_q->ac_R;
+        if (P2 <= t2)
+            return;
+    } else if (_q->timer < _q->M) {
         return;
+    }
 
+    ofdmframesync_detect_plcp(_q);
+}
+
+// check input level against squelch threshold, returning 1 if PLCP
+// detection should be skipped; the level is the running energy of
+// the autocorrelator when seeking with it (whose completed blocks
+// update the noise floor), otherwise the mean energy of the most
+// recent M samples, which also updates the noise floor
+int ofdmframesync_squelch_update(ofdmframesync _q)
+{
+    float x2 = 0.0f;
+    unsigned int i;
+    if (_q->ac_thresh > 0.0f) {
+        x2 = _q->ac_R / (float)(_q->M2);
+    } else if (_q->D_r == 0) {
+        float complex * rc;
+        windowcf_read(_q->input_buffer, &rc);
+        for (i=_q->cp_len; i<_q->M + _q->cp_len; i++)
+            x2 += crealf(rc[i])*crealf(rc[i]) + cimagf(rc[i])*cimagf(rc[i]);
+        x2 /= (float)(_q->M);
+    } else {
+        float * rr;
+        windowf_read(_q->input_buffer_r, &rr);
+        unsigned int n0 = _q->D_r*_q->cp_len;
+        unsigned int n1 = _q->D_r*(_q->M + _q->cp_len);
+        for (i=n0; i<n1; i++)
+            x2 += rr[i]*rr[i];
+        x2 /= (float)(n1 - n0);
+    }
+
+    // open until noise floor has been estimated
+    int closed = 0;
+    if (noisefloor_get_num_blocks(_q->squelch_floor) > 0) {
+        float g = powf(10.0f, _q->squelch_threshold/10.0f);
+        closed = x2 <= g*noisefloor_get_level(_q->squelch_floor);
+    }
+
+    if (_q->ac_thresh == 0.0f)
+        noisefloor_push(_q->squelch_floor, x2);
+
+    return closed;
+}
+
+// evaluate transform-based PLCP detector on most recent M samples
+void ofdmframesync_detect_plcp(ofdmframesync _q)
+{
     // reset timer
     _q->timer = 0;
 
-    //
-    float complex * rc;
-    windowcf_read(_q->input_buffer, &rc);
+    // skip detection while input level is near noise floor
+    if (_q->squelch_enabled && ofdmframesync_squelch_update(_q))
+        return;
+
+    if (_q->perf_enabled)
+        _q->perf_passes++;
+
+    // compute transform of most recent symbol
+    ofdmframesync_transform(_q, _q->cp_len);
 
     // estimate gain
     unsigned int i;
     float g = 0.0f;
-    for (i=_q->cp_len; i<_q->M + _q->cp_len; i++) {
-        // compute |rc[i]|^2 efficiently
-        g += crealf(rc[i])*crealf(rc[i]) + cimagf(rc[i])*cimagf(rc[i]);
+    if (_q->D_r == 0) {
+        float complex * rc;
+        windowcf_read(_q->input_buffer, &rc);
+        for (i=_q->cp_len; i<_q->M + _q->cp_len; i++) {
+            // compute |rc[i]|^2 efficiently
+            g += crealf(rc[i])*crealf(rc[i]) + cimagf(rc[i])*cimagf(rc[i]);
+        }
+    } else {
+        // in-band energy of baseband-equivalent signal (Parseval)
+        for (i=0; i<_q->M; i++)
+            g += crealf(_q->X[i])*crealf(_q->X[i]) + cimagf(_q->X[i])*cimagf(_q->X[i]);
+        g /= (float)(_q->M);
     }
     g = (float)(_q->M) / g;
 
-#if OFDMFRAMESYNC_ENABLE_SQUELCH
-    // TODO : squelch here
-    if ( -10*log10f( sqrtf(g) ) < _q->squelch_threshold &&
-         _q->squelch_enabled)
-    {
-        printf("squelch\n");
-        return;
-    }
-#endif
-
     // estimate S0 gain
-    ofdmframesync_estimate_gain_S0(_q, &rc[_q->cp_len], _q->G0);
+    ofdmframesync_estimate_gain_S0(_q, _q->G0);
 
     float complex s_hat;
     ofdmframesync_S0_metrics(_q, _q->G0, &s_hat);
@@ -475,6 +1198,7 @@ void ofdmframesync_execute_seekplcp(ofdmframesync _q)
         _q->timer = (_q->M + dt) % (_q->M2);
         _q->timer += _q->M; // add delay to help ensure good S0 estimate
         _q->state = OFDMFRAMESYNC_STATE_PLCPSHORT0;
+        FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_STATE, _q->state);
 
 #if DEBUG_OFDMFRAMESYNC_PRINT
         printf("********** frame detected! ************\n");
@@ -502,14 +1226,11 @@ void ofdmframesync_execute_S0a(ofdmframesync _q)
     // reset timer
     _q->timer = 0;
 
-    //
-    float complex * rc;
-    windowcf_read(_q->input_buffer, &rc);
-
     // TODO : re-estimate nominal gain
 
     // estimate S0 gain
-    ofdmframesync_estimate_gain_S0(_q, &rc[_q->cp_len], _q->G0);
+    ofdmframesync_transform(_q, _q->cp_len);
+    ofdmframesync_estimate_gain_S0(_q, _q->G0);
 
     float complex s_hat;
     ofdmframesync_S0_metrics(_q, _q->G0, &s_hat);
@@ -536,6 +1257,7 @@ void ofdmframesync_execute_S0a(ofdmframesync _q)
     }
 #endif
     _q->state = OFDMFRAMESYNC_STATE_PLCPSHORT1;
+    FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_STATE, _q->state);
 }
 
 // frame detection
@@ -550,12 +1272,9 @@ void ofdmframesync_execute_S0b(ofdmframesync _q)
     // reset timer
     _q->timer = _q->M + _q->cp_len - _q->backoff;
 
-    //
-    float complex * rc;
-    windowcf_read(_q->input_buffer, &rc);
-
     // estimate S0 gain
-    ofdmframesync_estimate_gain_S0(_q, &rc[_q->cp_len], _q->G1);
+    ofdmframesync_transform(_q, _q->cp_len);
+    ofdmframesync_estimate_gain_S0(_q, _q->G1);
 
     float complex s_hat;
     ofdmframesync_S0_metrics(_q, _q->G1, &s_hat);
@@ -591,6 +1310,13 @@ void ofdmframesync_execute_S0b(ofdmframesync _q)
     }
 #endif
 
+    // carrier is not recovered in passband mode
+    if (_q->D_r > 0) {
+        _q->state = OFDMFRAMESYNC_STATE_PLCPLONG;
+        FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_STATE, _q->state);
+        return;
+    }
+
     float complex g_hat = 0.0f;
     unsigned int i;
     for (i=0; i<_q->M; i++)
@@ -601,6 +1327,8 @@ void ofdmframesync_execute_S0b(ofdmframesync _q)
     float nu_hat = 2.0f * cargf(g_hat) / (float)(_q->M);
 #else
     // compute carrier frequency offset estimate using ML method
+    float complex * rc;
+    windowcf_read(_q->input_buffer, &rc);
     float complex t0 = 0.0f;
     for (i=0; i<_q->M2; i++) {
         t0 += conjf(rc[i])       *       _q->s0[i] * 
@@ -617,6 +1345,7 @@ void ofdmframesync_execute_S0b(ofdmframesync _q)
     nco_crcf_set_frequency(_q->nco_rx, nu_hat);
 
     _q->state = OFDMFRAMESYNC_STATE_PLCPLONG;
+    FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_STATE, _q->state);
 }
 
 void ofdmframesync_execute_S1(ofdmframesync _q)
@@ -629,13 +1358,10 @@ void ofdmframesync_execute_S1(ofdmframesync _q)
     // increment number of symbols observed
     _q->num_symbols++;
 
-    // run fft
-    float complex * rc;
-    windowcf_read(_q->input_buffer, &rc);
-
     // estimate S1 gain
     // TODO : add backoff in gain estimation
-    ofdmframesync_estimate_gain_S1(_q, &rc[_q->cp_len], _q->G);
+    ofdmframesync_transform(_q, _q->cp_len);
+    ofdmframesync_estimate_gain_S1(_q, _q->G);
 
     // compute detector output
     float complex g_hat = 0.0f;
@@ -660,6 +1386,8 @@ void ofdmframesync_execute_S1(ofdmframesync _q)
     if (cabsf(g_hat) > _q->plcp_sync_thresh && fabsf(cargf(g_hat)) < 0.1f*M_PI ) {
         //printf("    acquisition\n");
         _q->state = OFDMFRAMESYNC_STATE_RXSYMBOLS;
+        FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_FRAME_DETECTED, 0);
+        FRAMETRACE(_q, "ofdmframesync", LIQUID_FRAMETRACE_STATE, _q->state);
         // reset timer
         _q->timer = _q->M + _q->cp_len + _q->backoff;
         _q->num_symbols = 0;
@@ -719,10 +1447,7 @@ void ofdmframesync_execute_rxsymbols(ofdmframesync _q)
     if (_q->timer == 0) {
 
         // run fft
-        float complex * rc;
-        windowcf_read(_q->input_buffer, &rc);
-        memmove(_q->x, &rc[_q->cp_len-_q->backoff], (_q->M)*sizeof(float complex));
-        FFT_EXECUTE(_q->fft);
+        ofdmframesync_transform(_q, _q->cp_len - _q->backoff);
 
         // recover symbol in internal _q->X buffer
         ofdmframesync_rxsymbol(_q);
@@ -737,7 +1462,9 @@ void ofdmframesync_execute_rxsymbols(ofdmframesync _q)
         }
 #endif
         // invoke callback
-        if (_q->callback != NULL) {
+        if (_q->batch_max > 0) {
+            ofdmframesync_batch_push(_q);
+        } else if (_q->callback != NULL) {
             int retval = _q->callback(_q->X, _q->p, _q->M, _q->userdata);
 
             if (retval != 0)
@@ -750,6 +1477,65 @@ void ofdmframesync_execute_rxsymbols(ofdmframesync _q)
 
 }
 
+// receive remainder of payload symbol as a block; consumes
+// timer samples of _x, mixing them down and buffering them at once
+void ofdmframesync_execute_rxsymbols_block(ofdmframesync   _q,
+                                           float complex * _x)
+{
+    unsigned int n = _q->timer;
+
+    // correct for carrier frequency offset and save to buffer
+    nco_crcf_mix_block_down(_q->nco_rx, _x, _q->buf_rx, n);
+    windowcf_write(_q->input_buffer, _q->buf_rx, n);
+
+#if DEBUG_OFDMFRAMESYNC
+    if (_q->debug_enabled) {
+        unsigned int i;
+        for (i=0; i<n; i++) {
+            float complex x = _q->buf_rx[i];
+            windowcf_push(_q->debug_x, x);
+            windowf_push(_q->debug_rssi, crealf(x)*crealf(x) + cimagf(x)*cimagf(x));
+        }
+    }
+#endif
+
+    // final sample of symbol: run fft and recover symbol
+    _q->timer = 1;
+    ofdmframesync_execute_rxsymbols(_q);
+}
+
+// discard up to _n input samples while skipping symbols, resetting
+// once all have been discarded; returns number of samples consumed
+unsigned int ofdmframesync_skip_block(ofdmframesync _q,
+                                      unsigned int  _n)
+{
+    unsigned int n = _n < _q->skip ? _n : _q->skip;
+    if (_q->perf_enabled)
+        _q->perf_samples[2] += n;
+    _q->skip -= n;
+    if (_q->skip == 0)
+        ofdmframesync_reset(_q);
+    return n;
+}
+
+// append recovered symbol to batch, invoking batch callback once the
+// batch length has been reached
+void ofdmframesync_batch_push(ofdmframesync _q)
+{
+    memmove(&_q->Y[_q->batch_num*_q->M], _q->X, _q->M*sizeof(float complex));
+    if (++_q->batch_num < _q->batch_len)
+        return;
+
+    unsigned int n = _q->batch_num;
+    _q->batch_num = 0;
+    if (_q->batch_callback != NULL) {
+        int retval = _q->batch_callback(_q->Y, n, _q->p, _q->M, _q->userdata);
+
+        if (retval != 0)
+            ofdmframesync_reset(_q);
+    }
+}
+
 // compute S0 metrics
 void ofdmframesync_S0_metrics(ofdmframesync _q,
                               float complex * _G,
@@ -772,19 +1558,11 @@ void ofdmframesync_S0_metrics(ofdmframesync _q,
 }
 
 // estimate short sequence gain
-//  _q      :   ofdmframesync object
-//  _x      :   input array (time), [size: M x 1]
+//  _q      :   ofdmframesync object (transform in _q->X)
 //  _G      :   output gain (freq)
 void ofdmframesync_estimate_gain_S0(ofdmframesync   _q,
-                                    float complex * _x,
                                     float complex * _G)
 {
-    // move input array into fft input buffer
-    memmove(_q->x, _x, (_q->M)*sizeof(float complex));
-
-    // compute fft, storing result into _q->X
-    FFT_EXECUTE(_q->fft);
-    
     // compute gain, ignoring NULL subcarriers
     unsigned int i;
     float gain = sqrtf(_q->M_S0) / (float)(_q->M);
@@ -805,19 +1583,11 @@ void ofdmframesync_estimate_gain_S0(ofdmframesync   _q,
 }
 
 // estimate long sequence gain
-//  _q      :   ofdmframesync object
-//  _x      :   input array (time), [size: M x 1]
+//  _q      :   ofdmframesync object (transform in _q->X)
 //  _G      :   output gain (freq)
 void ofdmframesync_estimate_gain_S1(ofdmframesync _q,
-                                    float complex * _x,
                                     float complex * _G)
 {
-    // move input array into fft input buffer
-    memmove(_q->x, _x, (_q->M)*sizeof(float complex));
-
-    // compute fft, storing result into _q->X
-    FFT_EXECUTE(_q->fft);
-    
     // compute gain, ignoring NULL subcarriers
     unsigned int i;
     float gain = sqrtf(_q->M_S1) / (float)(_q->M);
@@ -860,7 +1630,7 @@ void ofdmframesync_estimate_eqgain(ofdmframesync _q,
     // generate smoothing window (fft of temporal window)
     for (i=0; i<_q->M; i++)
         _q->x[i] = (i < _ntaps) ? 1.0f : 0.0f;
-    FFT_EXECUTE(_q->fft);
+    FFT_EXECUTE(_q->fft_window);
 
     memmove(_q->G0, _q->G, _q->M*sizeof(float complex));
 
@@ -962,14 +1732,19 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
     polyf_fit(x_freq, y_abs, N, p_abs, _order+1);
     polyf_fit(x_freq, y_arg, N, p_arg, _order+1);
 
-    // compute subcarrier gain
+    // compute subcarrier gain, evaluating both polynomials over all
+    // subcarrier frequencies at once
+    float freq[_q->M];
+    float A[_q->M];
+    float theta[_q->M];
     for (i=0; i<_q->M; i++) {
-        float freq = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
-        freq = freq / (float)(_q->M);
-        float A     = polyf_val(p_abs, _order+1, freq);
-        float theta = polyf_val(p_arg, _order+1, freq);
-        _q->G[i] = (_q->p[i] == OFDMFRAME_SCTYPE_NULL) ? 0.0f : A * liquid_cexpjf(theta);
+        freq[i] = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
+        freq[i] = freq[i] / (float)(_q->M);
     }
+    polyf_val_batch(p_abs, _order+1, freq, _q->M, A);
+    polyf_val_batch(p_arg, _order+1, freq, _q->M, theta);
+    for (i=0; i<_q->M; i++)
+        _q->G[i] = (_q->p[i] == OFDMFRAME_SCTYPE_NULL) ? 0.0f : A[i] * liquid_cexpjf(theta[i]);
 
 #if 0
     for (i=0; i<N; i++)
@@ -993,56 +1768,42 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     for (i=0; i<_q->M; i++)
         _q->X[i] *= _q->R[i];
 
-    // polynomial curve-fit
-    float x_phase[_q->M_pilot];
-    float y_phase[_q->M_pilot];
-    float p_phase[2];
-
-    unsigned int n=0;
-    unsigned int k;
-    float complex pilot = 1.0f;
-    for (i=0; i<_q->M; i++) {
-
-        // start at mid-point (effective fftshift)
-        k = (i + _q->M2) % _q->M;
-
-        if (_q->p[k]==OFDMFRAME_SCTYPE_PILOT) {
-            if (n == _q->M_pilot) {
-                fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-                return;
-            }
-            pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
-#if 0
-            printf("pilot[%3u] = %12.4e + j*%12.4e (expected %12.4e + j*%12.4e)\n",
-                    k,
-                    crealf(_q->X[k]), cimagf(_q->X[k]),
-                    crealf(pilot),    cimagf(pilot));
-#endif
-            // store resulting...
-            x_phase[n] = (k > _q->M2) ? (float)k - (float)(_q->M) : (float)k;
-            y_phase[n] = cargf(_q->X[k]*conjf(pilot));
-
-            // update counter
-            n++;
-
+    // pilot phases (in fftshift order, ready for unwrapping); pilot
+    // bits are drawn up to 32 at a time
+    unsigned int N = _q->M_pilot;
+    unsigned int bits = 0;
+    unsigned int nb   = 0;
+    for (i=0; i<N; i++) {
+        if (nb == 0) {
+            nb   = (N - i < 32) ? N - i : 32;
+            bits = msequence_generate_symbol(_q->ms_pilot, nb);
         }
-    }
-
-    if (n != _q->M_pilot) {
-        fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-        return;
+        nb--;
+        float complex pilot = ((bits >> nb) & 1 ? 1.0f : -1.0f);
+        _q->pilot_val[i]   = pilot;
+        _q->pilot_phase[i] = cargf(_q->X[_q->pilot_idx[i]]*conjf(pilot));
     }
 
     // try to unwrap phase
-    for (i=1; i<_q->M_pilot; i++) {
+    float * y_phase = _q->pilot_phase;
+    for (i=1; i<N; i++) {
         while ((y_phase[i] - y_phase[i-1]) >  M_PI)
             y_phase[i] -= 2*M_PI;
         while ((y_phase[i] - y_phase[i-1]) < -M_PI)
             y_phase[i] += 2*M_PI;
     }
 
-    // fit phase to 1st-order polynomial (2 coefficients)
-    polyf_fit(x_phase, y_phase, _q->M_pilot, p_phase, 2);
+    // fit phase to line, theta(x) = p0 + p1*x; the abscissae are fixed
+    // so only the sums involving y are computed here
+    float sy  = 0.0f;
+    float sxy = 0.0f;
+    for (i=0; i<N; i++) {
+        sy  += y_phase[i];
+        sxy += _q->pilot_fx[i]*y_phase[i];
+    }
+    float p_phase[2];
+    p_phase[1] = ((float)N*sxy - _q->pilot_sx*sy) / _q->pilot_den;
+    p_phase[0] = (sy - p_phase[1]*_q->pilot_sx) / (float)N;
 
     // filter slope estimate (timing offset)
     float alpha = 0.3f;
@@ -1052,8 +1813,8 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
 #if DEBUG_OFDMFRAMESYNC
     if (_q->debug_enabled) {
         // save pilots
-        memmove(_q->px, x_phase, _q->M_pilot*sizeof(float));
-        memmove(_q->py, y_phase, _q->M_pilot*sizeof(float));
+        memmove(_q->px, _q->pilot_fx, N*sizeof(float));
+        memmove(_q->py, y_phase,      N*sizeof(float));
 
         // NOTE : swapping values for octave
         _q->p_phase[0] = p_phase[1];
@@ -1064,19 +1825,30 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     }
 #endif
 
-    // compensate for phase offset
-    // TODO : find more computationally efficient way to do this
+    // compensate for phase offset: the correction is linear in the
+    // subcarrier index, so rotate a phasor across each half of the
+    // spectrum rather than evaluating exp(-j*theta) per subcarrier
+    float complex dphasor = liquid_cexpjf(-p_phase[1]);
+    float complex phasor  = liquid_cexpjf(-p_phase[0]);
+    for (i=0; i<=_q->M2; i++) {
+        _q->X[i] *= phasor;
+        phasor   *= dphasor;
+    }
+    phasor = liquid_cexpjf(-p_phase[0] - p_phase[1]*((float)(_q->M2+1) - (float)(_q->M)));
+    for (i=_q->M2+1; i<_q->M; i++) {
+        _q->X[i] *= phasor;
+        phasor   *= dphasor;
+    }
     for (i=0; i<_q->M; i++) {
         // only apply to data/pilot subcarriers
-        if (_q->p[i] == OFDMFRAME_SCTYPE_NULL) {
+        if (_q->p[i] == OFDMFRAME_SCTYPE_NULL)
             _q->X[i] = 0.0f;
-        } else {
-            float fx    = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
-            float theta = polyf_val(p_phase, 2, fx);
-            _q->X[i] *= liquid_cexpjf(-theta);
-        }
     }
 
+    // track subcarrier gains
+    if (_q->eq_mu > 0.0f)
+        ofdmframesync_track_eqgain(_q);
+
     // adjust NCO frequency based on differential phase
     if (_q->num_symbols > 0) {
         // compute phase error (unwrapped)
@@ -1095,13 +1867,46 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     _q->num_symbols++;
 
 #if 0
-    for (i=0; i<_q->M_pilot; i++)
-        printf("x_phase(%3u) = %12.8f; y_phase(%3u) = %12.8f;\n", i+1, x_phase[i], i+1, y_phase[i]);
+    for (i=0; i<N; i++)
+        printf("x_phase(%3u) = %12.8f; y_phase(%3u) = %12.8f;\n", i+1, _q->pilot_fx[i], i+1, y_phase[i]);
     printf("poly : p0=%12.8f, p1=%12.8f\n", p_phase[0], p_phase[1]);
 #endif
 }
 
-// enable debugging
+// decision-directed per-subcarrier gain tracking; with the equalized,
+// phase-corrected symbol Y = R*X and decision D, the one-tap normalized
+// LMS update R += mu*(D-Y)/X is applied in the form
+// R += mu*R*(D-Y)*conj(Y)/|Y|^2 so that the raw symbol is not needed
+void ofdmframesync_track_eqgain(ofdmframesync _q)
+{
+    unsigned int i;
+
+    // default decision is the symbol itself (no update)
+    memmove(_q->D, _q->X, (_q->M)*sizeof(float complex));
+
+    // pilots are known
+    for (i=0; i<_q->M_pilot; i++)
+        _q->D[_q->pilot_idx[i]] = _q->pilot_val[i];
+
+    // data decisions from block slicer
+    if (_q->mod_eq != NULL) {
+        for (i=0; i<_q->M_data; i++)
+            _q->X_data[i] = _q->X[_q->data_idx[i]];
+        modem_demodulate_block(_q->mod_eq, _q->X_data, _q->M_data, _q->s_data);
+        modem_modulate_block  (_q->mod_eq, _q->s_data, _q->M_data, _q->X_data);
+        for (i=0; i<_q->M_data; i++)
+            _q->D[_q->data_idx[i]] = _q->X_data[i];
+    }
+
+    // update all subcarriers at once; null subcarriers have Y = D = 0
+    float mu = _q->eq_mu;
+    for (i=0; i<_q->M; i++) {
+        float complex y = _q->X[i];
+        float e2 = crealf(y)*crealf(y) + cimagf(y)*cimagf(y) + 1e-12f;
+        _q->R[i] += mu * _q->R[i] * (_q->D[i] - y) * conjf(y) / e2;
+    }
+}
+
 void ofdmframesync_debug_enable(ofdmframesync _q)
 {
     // create debugging objects if necessary
@@ -1112,10 +1917,10 @@ void ofdmframesync_debug_enable(ofdmframesync _q)
     _q->debug_x         = windowcf_create(DEBUG_OFDMFRAMESYNC_BUFFER_LEN);
     _q->debug_rssi      = windowf_create(DEBUG_OFDMFRAMESYNC_BUFFER_LEN);
     _q->debug_framesyms = windowcf_create(DEBUG_OFDMFRAMESYNC_BUFFER_LEN);
-    _q->G_hat           = (float complex*) malloc((_q->M)*sizeof(float complex));
+    _q->G_hat           = (float complex*) liquid_malloc((_q->M)*sizeof(float complex));
 
-    _q->px = (float*) malloc((_q->M_pilot)*sizeof(float));
-    _q->py = (float*) malloc((_q->M_pilot)*sizeof(float));
+    _q->px = (float*) liquid_malloc((_q->M_pilot)*sizeof(float));
+    _q->py = (float*) liquid_malloc((_q->M_pilot)*sizeof(float));
 
     _q->debug_pilot_0 = windowf_create(DEBUG_OFDMFRAMESYNC_BUFFER_LEN);
     _q->debug_pilot_1 = windowf_create(DEBUG_OFDMFRAMESYNC_BUFFER_LEN);
@@ -21,6 +21,8 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -97,3 +99,141 @@ void autotest_firpfbch2_crcf_n16()   { firpfbch2_crcf_runtest(  16, 5, 60.0f); }
 void autotest_firpfbch2_crcf_n32()   { firpfbch2_crcf_runtest(  32, 5, 60.0f); }
 void autotest_firpfbch2_crcf_n64()   { firpfbch2_crcf_runtest(  64, 5, 60.0f); }
 
+
+// channel mask: active outputs match the unmasked analyzer, inactive
+// outputs are zero, for both sparse (direct) and dense (transform)
+// channel sets
+//  _M          :   number of channels
+//  _num_active :   number of active channels
+void firpfbch2_crcf_mask_test(unsigned int _M,
+                              unsigned int _num_active)
+{
+    float tol = 1e-5f;
+    unsigned int m = 4;
+    unsigned int num_blocks = 4*m;
+    unsigned int i, j;
+
+    firpfbch2_crcf q0 = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, _M, m, 60.0f);
+    firpfbch2_crcf q1 = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, _M, m, 60.0f);
+
+    // spread active channels across the band
+    unsigned char mask[_M];
+    memset(mask, 0x00, _M*sizeof(unsigned char));
+    for (i=0; i<_num_active; i++)
+        mask[(i*_M/_num_active + i) % _M] = 1;
+    firpfbch2_crcf_set_channel_mask(q1, mask);
+
+    float complex x[_M/2];
+    float complex y0[_M];
+    float complex y1[_M];
+    for (i=0; i<num_blocks; i++) {
+        for (j=0; j<_M/2; j++)
+            x[j] = randnf() + _Complex_I*randnf();
+        firpfbch2_crcf_execute(q0, x, y0);
+        firpfbch2_crcf_execute(q1, x, y1);
+
+        for (j=0; j<_M; j++) {
+            float complex v = mask[j] ? y0[j] : 0.0f;
+            CONTEND_DELTA( crealf(y1[j]), crealf(v), tol );
+            CONTEND_DELTA( cimagf(y1[j]), cimagf(v), tol );
+        }
+    }
+
+    firpfbch2_crcf_destroy(q0);
+    firpfbch2_crcf_destroy(q1);
+}
+
+void autotest_firpfbch2_crcf_mask_n16_k1()  { firpfbch2_crcf_mask_test(16,  1); }
+void autotest_firpfbch2_crcf_mask_n64_k4()  { firpfbch2_crcf_mask_test(64,  4); }
+void autotest_firpfbch2_crcf_mask_n64_k48() { firpfbch2_crcf_mask_test(64, 48); }
+
+// block execution matches successive single transforms, across chunk
+// boundaries of the history matrix and for odd block lengths
+//  _type   :   channelizer type
+//  _M      :   number of channels
+void firpfbch2_crcf_block_test(int          _type,
+                               unsigned int _M)
+{
+    float tol = 1e-6f;
+    unsigned int m = 3;
+    unsigned int block_len[4] = {1, 7, 100, 33};
+    unsigned int nx = _type == LIQUID_ANALYZER ? _M/2 : _M;    // input per transform
+    unsigned int ny = _type == LIQUID_ANALYZER ? _M : _M/2;    // output per transform
+    unsigned int num = 141;
+    unsigned int i, j;
+
+    firpfbch2_crcf q0 = firpfbch2_crcf_create_kaiser(_type, _M, m, 60.0f);
+    firpfbch2_crcf q1 = firpfbch2_crcf_create_kaiser(_type, _M, m, 60.0f);
+
+    float complex * x  = (float complex*) malloc(num*nx*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(num*ny*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(num*ny*sizeof(float complex));
+    for (i=0; i<num*nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    for (i=0; i<num; i++)
+        firpfbch2_crcf_execute(q0, &x[i*nx], &y0[i*ny]);
+
+    for (i=0, j=0; i<num; j++) {
+        unsigned int n = block_len[j % 4] < num - i ? block_len[j % 4] : num - i;
+        firpfbch2_crcf_execute_block(q1, &x[i*nx], n, &y1[i*ny]);
+        i += n;
+    }
+
+    for (i=0; i<num*ny; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    free(x);
+    free(y0);
+    free(y1);
+    firpfbch2_crcf_destroy(q0);
+    firpfbch2_crcf_destroy(q1);
+}
+
+void autotest_firpfbch2_crcf_block_analyzer()    { firpfbch2_crcf_block_test(LIQUID_ANALYZER,    16); }
+void autotest_firpfbch2_crcf_block_synthesizer() { firpfbch2_crcf_block_test(LIQUID_SYNTHESIZER, 16); }
+
+// half-precision sub-filter coefficients track the single-precision
+// channelizer output closely
+//  _type   :   channelizer type
+//  _M      :   number of channels
+void firpfbch2_crcf_fp16_test(int          _type,
+                              unsigned int _M)
+{
+    unsigned int m = 5;
+    unsigned int nx = _type == LIQUID_ANALYZER ? _M/2 : _M;    // input per transform
+    unsigned int ny = _type == LIQUID_ANALYZER ? _M : _M/2;    // output per transform
+    unsigned int num = 40;
+    unsigned int i;
+
+    firpfbch2_crcf q0 = firpfbch2_crcf_create_kaiser(_type, _M, m, 60.0f);
+    firpfbch2_crcf q1 = firpfbch2_crcf_create_kaiser(_type, _M, m, 60.0f);
+    firpfbch2_crcf_set_coeff_fp16(q1, 1);
+
+    float complex * x  = (float complex*) malloc(num*nx*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(num*ny*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(num*ny*sizeof(float complex));
+    for (i=0; i<num*nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    firpfbch2_crcf_execute_block(q0, x, num, y0);
+    firpfbch2_crcf_execute_block(q1, x, num, y1);
+
+    float e2 = 0.0f, y2 = 0.0f;
+    for (i=0; i<num*ny; i++) {
+        e2 += crealf((y0[i]-y1[i])*conjf(y0[i]-y1[i]));
+        y2 += crealf(y0[i]*conjf(y0[i]));
+    }
+    CONTEND_LESS_THAN(10*log10f(e2/y2), -50.0f);
+
+    free(x);
+    free(y0);
+    free(y1);
+    firpfbch2_crcf_destroy(q0);
+    firpfbch2_crcf_destroy(q1);
+}
+
+void autotest_firpfbch2_crcf_fp16_analyzer()    { firpfbch2_crcf_fp16_test(LIQUID_ANALYZER,    32); }
+void autotest_firpfbch2_crcf_fp16_synthesizer() { firpfbch2_crcf_fp16_test(LIQUID_SYNTHESIZER, 32); }
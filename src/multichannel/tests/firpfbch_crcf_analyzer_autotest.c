@@ -62,6 +62,7 @@ void autotest_firpfbch_crcf_analysis()
     float complex y[num_samples];                   // time-domain input
     float complex Y0[num_symbols][num_channels];    // channelized output
     float complex Y1[num_symbols][num_channels];    // channelized output
+    float complex Y2[num_symbols][num_channels];    // channelized output (block)
 
     // generate input sequence (complex noise)
     ms = msequence_create_default(7);
@@ -78,6 +79,10 @@ void autotest_firpfbch_crcf_analysis()
     for (i=0; i<num_symbols; i++)
         firpfbch_crcf_analyzer_execute(q, &y[i*num_channels], &Y0[i][0]);
 
+    // run again on entire block
+    firpfbch_crcf_reset(q);
+    firpfbch_crcf_analyzer_execute_block(q, y, num_symbols, &Y2[0][0]);
+
 
     // 
     // run traditional down-converter (inefficient)
@@ -144,6 +149,8 @@ void autotest_firpfbch_crcf_analysis()
         for (j=0; j<num_channels; j++) {
             CONTEND_DELTA( crealf(Y0[i][j]), crealf(Y1[i][j]), tol );
             CONTEND_DELTA( cimagf(Y0[i][j]), cimagf(Y1[i][j]), tol );
+            CONTEND_DELTA( crealf(Y2[i][j]), crealf(Y1[i][j]), tol );
+            CONTEND_DELTA( cimagf(Y2[i][j]), cimagf(Y1[i][j]), tol );
         }
     }
 
@@ -62,6 +62,7 @@ void autotest_firpfbch_crcf_synthesis()
     float complex Y[num_symbols][num_channels];     // channelized input
     float complex y0[num_samples];                  // time-domain output
     float complex y1[num_samples];                  // time-domain output
+    float complex y2[num_samples];                  // time-domain output (block)
 
     // generate input sequence (complex noise)
     ms = msequence_create_default(7);
@@ -80,6 +81,10 @@ void autotest_firpfbch_crcf_synthesis()
     for (i=0; i<num_symbols; i++)
         firpfbch_crcf_synthesizer_execute(q, &Y[i][0], &y0[i*num_channels]);
 
+    // run again on entire block
+    firpfbch_crcf_reset(q);
+    firpfbch_crcf_synthesizer_execute_block(q, &Y[0][0], num_symbols, y2);
+
     // 
     // run traditional up-converter (inefficient)
     //
@@ -140,6 +145,8 @@ void autotest_firpfbch_crcf_synthesis()
 
         CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
         CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+        CONTEND_DELTA( crealf(y2[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y2[i]), cimagf(y1[i]), tol );
     }
 }
 
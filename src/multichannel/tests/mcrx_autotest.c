@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// per-channel record of received samples
+struct mcrx_autotest_s {
+    unsigned int channel;       // expected channel index
+    unsigned int num_samples;   // number of samples received
+    int          mismatch;      // sample out of order or on wrong channel?
+    int          busy;          // callback currently executing?
+    int          overlap;       // callbacks for channel overlapped?
+};
+
+static int mcrx_autotest_callback(unsigned int    _channel,
+                                  float complex * _x,
+                                  unsigned int    _n,
+                                  void *          _userdata)
+{
+    struct mcrx_autotest_s * r = (struct mcrx_autotest_s*) _userdata;
+    if (r->busy)
+        r->overlap = 1;
+    r->busy = 1;
+
+    // samples encode channel (real) and transform index (imag)
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        if (_channel != r->channel ||
+            crealf(_x[i]) != (float)r->channel ||
+            cimagf(_x[i]) != (float)r->num_samples)
+        {
+            r->mismatch = 1;
+        }
+        r->num_samples++;
+    }
+    r->busy = 0;
+    return 0;
+}
+
+// helper function: push varying-length blocks of tagged channelizer
+// outputs and check that each channel receives every sample in order
+//  _num_channels   :   number of channels
+//  _num_threads    :   number of worker threads
+//  _ring_len       :   ring buffer length
+void mcrx_autotest_run(unsigned int _num_channels,
+                       unsigned int _num_threads,
+                       unsigned int _ring_len)
+{
+    unsigned int i, t;
+    unsigned int num_blocks = 40;
+
+    // recorders, indexed by channel
+    struct mcrx_autotest_s r[_num_channels];
+    void * userdata[_num_channels];
+    for (i=0; i<_num_channels; i++) {
+        r[i].channel     = i;
+        r[i].num_samples = 0;
+        r[i].mismatch    = 0;
+        r[i].busy        = 0;
+        r[i].overlap     = 0;
+        userdata[i]      = &r[i];
+    }
+
+    mcrx q = mcrx_create(_num_channels, _num_threads, _ring_len,
+                         mcrx_autotest_callback, userdata);
+    CONTEND_EQUALITY( mcrx_get_num_channels(q), _num_channels );
+
+    // blocks shorter and longer than ring
+    unsigned int max_len = 3*_ring_len + 1;
+    float complex * y = (float complex*) malloc(max_len*_num_channels*sizeof(float complex));
+    unsigned int num_transforms = 0;
+    unsigned int b;
+    for (b=0; b<num_blocks; b++) {
+        unsigned int n = 1 + (b*7) % max_len;
+        for (t=0; t<n; t++) {
+            for (i=0; i<_num_channels; i++)
+                y[t*_num_channels + i] = (float)i + _Complex_I*(float)(num_transforms + t);
+        }
+        mcrx_execute(q, y, n);
+        num_transforms += n;
+    }
+    mcrx_flush(q);
+
+    // each channel received every sample, in order, one callback at a time
+    for (i=0; i<_num_channels; i++) {
+        CONTEND_EQUALITY( r[i].num_samples, num_transforms );
+        CONTEND_EQUALITY( r[i].mismatch,    0 );
+        CONTEND_EQUALITY( r[i].overlap,     0 );
+    }
+
+    if (liquid_autotest_verbose)
+        mcrx_print(q);
+    mcrx_destroy(q);
+    free(y);
+}
+
+void autotest_mcrx_c1_t0()  { mcrx_autotest_run( 1, 0,  16); }
+void autotest_mcrx_c8_t0()  { mcrx_autotest_run( 8, 0,  16); }
+void autotest_mcrx_c8_t1()  { mcrx_autotest_run( 8, 1,  16); }
+void autotest_mcrx_c8_t3()  { mcrx_autotest_run( 8, 3,   4); }
+void autotest_mcrx_c16_t4() { mcrx_autotest_run(16, 4,  64); }
+void autotest_mcrx_c3_t8()  { mcrx_autotest_run( 3, 8,  32); }
@@ -28,7 +28,7 @@
 #include <assert.h>
 
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 
 // internal callback
@@ -58,9 +58,11 @@ int ofdmframesync_autotest_callback(float complex * _X,
 //  _num_subcarriers    :   number of subcarriers
 //  _cp_len             :   cyclic prefix lenght
 //  _taper_len          :   taper length
-void ofdmframesync_acquire_test(unsigned int _num_subcarriers,
-                                unsigned int _cp_len,
-                                unsigned int _taper_len)
+//  _p                  :   subcarrier allocation (NULL for default)
+void ofdmframesync_acquire_test(unsigned int    _num_subcarriers,
+                                unsigned int    _cp_len,
+                                unsigned int    _taper_len,
+                                unsigned char * _p)
 {
     // options
     unsigned int M         = _num_subcarriers;  // number of subcarriers
@@ -73,7 +75,10 @@ void ofdmframesync_acquire_test(unsigned int _num_subcarriers,
 
     // subcarrier allocation (initialize to default)
     unsigned char p[M];
-    ofdmframe_init_default_sctype(M, p);
+    if (_p == NULL)
+        ofdmframe_init_default_sctype(M, p);
+    else
+        memmove(p, _p, M*sizeof(unsigned char));
 
     // derived values
     unsigned int num_samples = (3 + 1)*(M + cp_len);
@@ -138,8 +143,378 @@ void ofdmframesync_acquire_test(unsigned int _num_subcarriers,
 }
 
 //
-void autotest_ofdmframesync_acquire_n64()   { ofdmframesync_acquire_test(64,  8,  0); }
-void autotest_ofdmframesync_acquire_n128()  { ofdmframesync_acquire_test(128, 16, 0); }
-void autotest_ofdmframesync_acquire_n256()  { ofdmframesync_acquire_test(256, 32, 0); }
-void autotest_ofdmframesync_acquire_n512()  { ofdmframesync_acquire_test(512, 64, 0); }
+void autotest_ofdmframesync_acquire_n64()   { ofdmframesync_acquire_test(64,  8,  0, NULL); }
+void autotest_ofdmframesync_acquire_n128()  { ofdmframesync_acquire_test(128, 16, 0, NULL); }
+void autotest_ofdmframesync_acquire_n256()  { ofdmframesync_acquire_test(256, 32, 0, NULL); }
+void autotest_ofdmframesync_acquire_n512()  { ofdmframesync_acquire_test(512, 64, 0, NULL); }
+
+// narrow allocation, most of the band null (pruned transforms)
+void autotest_ofdmframesync_acquire_narrowband()
+{
+    unsigned int M = 256;
+    unsigned char p[M];
+    unsigned int i;
+    for (i=0; i<M; i++)
+        p[i] = OFDMFRAME_SCTYPE_NULL;
+    for (i=1; i<13; i++)
+        p[i] = ((i-1)%4 == 0) ? OFDMFRAME_SCTYPE_PILOT : OFDMFRAME_SCTYPE_DATA;
+
+    ofdmframesync_acquire_test(M, 32, 0, p);
+}
+
+
+// callback for gain tracking test: keep most recent symbol
+int ofdmframesync_autotest_eqtrack_callback(float complex * _X,
+                                            unsigned char * _p,
+                                            unsigned int    _M,
+                                            void * _userdata)
+{
+    memmove((float complex *)_userdata, _X, _M*sizeof(float complex));
+    return 0;
+}
+
+// payload gain changes after acquisition; decision-directed subcarrier
+// gain tracking should remove the resulting error
+//  _mu     :   tracking gain (0 disables tracking)
+//  _ms     :   slicer modulation scheme
+float ofdmframesync_eqtrack_test(float             _mu,
+                                 modulation_scheme _ms)
+{
+    unsigned int M          = 64;
+    unsigned int cp_len     = 16;
+    unsigned int num_symbols= 40;
+    float        g          = 1.4f;     // gain step after preamble
+    unsigned int i, j;
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    ofdmframegen  fg = ofdmframegen_create(M, cp_len, 0, p);
+    float complex X_test[M];
+    ofdmframesync fs = ofdmframesync_create(M, cp_len, 0, p,
+            ofdmframesync_autotest_eqtrack_callback, (void*)X_test);
+    ofdmframesync_set_eq_tracking(fs, _mu, _ms);
+
+    modem mod = modem_create(LIQUID_MODEM_QPSK);
+    float complex X[M];
+    float complex y[M+cp_len];
+
+    ofdmframegen_write_S0a(fg, y); ofdmframesync_execute(fs, y, M+cp_len);
+    ofdmframegen_write_S0b(fg, y); ofdmframesync_execute(fs, y, M+cp_len);
+    ofdmframegen_write_S1 (fg, y); ofdmframesync_execute(fs, y, M+cp_len);
+
+    for (i=0; i<num_symbols; i++) {
+        for (j=0; j<M; j++)
+            modem_modulate(mod, modem_gen_rand_sym(mod), &X[j]);
+        ofdmframegen_writesymbol(fg, X, y);
+        for (j=0; j<M+cp_len; j++)
+            y[j] *= g;
+        ofdmframesync_execute(fs, y, M+cp_len);
+    }
+
+    // rms error of data subcarriers in final symbol
+    float e2 = 0.0f;
+    unsigned int n = 0;
+    for (j=0; j<M; j++) {
+        if (p[j] == OFDMFRAME_SCTYPE_DATA) {
+            float complex e = X_test[j] - X[j];
+            e2 += crealf(e*conjf(e));
+            n++;
+        }
+    }
+    float rmse = sqrtf(e2 / (float)n);
+    if (liquid_autotest_verbose)
+        printf("  eq tracking mu=%5.3f : rmse = %12.4e\n", _mu, rmse);
+
+    modem_destroy(mod);
+    ofdmframegen_destroy(fg);
+    ofdmframesync_destroy(fs);
+    return rmse;
+}
+
+void autotest_ofdmframesync_eqtrack()
+{
+    float rmse_off    = ofdmframesync_eqtrack_test(0.0f, LIQUID_MODEM_QPSK);
+    float rmse_pilots = ofdmframesync_eqtrack_test(0.2f, LIQUID_MODEM_UNKNOWN);
+    float rmse_dd     = ofdmframesync_eqtrack_test(0.2f, LIQUID_MODEM_QPSK);
+
+    // untracked gain step leaves (g-1) error on every subcarrier
+    CONTEND_GREATER_THAN(rmse_off, 0.3f);
+
+    // pilots-only tracking leaves data subcarriers untouched
+    CONTEND_DELTA(rmse_pilots, rmse_off, 1e-3f);
+
+    // decision-directed tracking removes the gain step
+    CONTEND_LESS_THAN(rmse_dd, 1e-2f);
+}
+
+// running-autocorrelation seek: on noise the transform-based detector
+// is (almost) never evaluated, and a frame following the noise with a
+// carrier offset is still acquired
+//  _M      :   number of subcarriers
+//  _cp_len :   cyclic prefix length
+void ofdmframesync_autocorr_test(unsigned int _M,
+                                 unsigned int _cp_len)
+{
+    unsigned int M         = _M;
+    unsigned int cp_len    = _cp_len;
+    unsigned int taper_len = 0;
+    unsigned int num_noise = 64*M;          // noise-only samples
+    float        nstd      = 0.1f;          // noise standard deviation
+    float        dphi      = 1.0f/(float)M; // carrier frequency offset
+    float        tol       = 1e-2f;         // error tolerance
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    float complex X[M];         // original data sequence
+    float complex X_test[M];    // recovered data sequence
+    ofdmframegen  fg = ofdmframegen_create(M, cp_len, taper_len, p);
+    ofdmframesync fs = ofdmframesync_create(M, cp_len, taper_len, p,
+                                            ofdmframesync_autotest_callback,
+                                            (void*)X_test);
+    ofdmframesync_perf_enable(fs, 1);
+
+    unsigned int i;
+    unsigned int n0 = M + cp_len;
+    unsigned int num_samples = num_noise + 4*n0;
+    float complex * y = (float complex*) calloc(num_samples, sizeof(float complex));
+    for (i=0; i<num_noise; i++)
+        y[i] = nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+
+    unsigned int n = num_noise;
+    ofdmframegen_write_S0a(fg, &y[n]); n += n0;
+    ofdmframegen_write_S0b(fg, &y[n]); n += n0;
+    ofdmframegen_write_S1 (fg, &y[n]); n += n0;
+    for (i=0; i<M; i++) {
+        X[i]      = cexpf(_Complex_I*2*M_PI*randf());
+        X_test[i] = 0.0f;
+    }
+    ofdmframegen_writesymbol(fg, X, &y[n]);
+    for (i=num_noise; i<num_samples; i++)
+        y[i] *= cexpf(_Complex_I*dphi*i);
+
+    unsigned long int samples[3];
+    unsigned long int passes_ref;
+    unsigned long int passes;
+
+    // reference: detector evaluated every M samples
+    ofdmframesync_execute(fs, y, num_noise);
+    ofdmframesync_get_perfcounts(fs, samples, &passes_ref);
+
+    // autocorrelation seek
+    ofdmframesync_set_seek_autocorr(fs, 0.5f);
+    ofdmframesync_reset_perfcounts(fs);
+    ofdmframesync_execute(fs, y, num_samples);
+    ofdmframesync_get_perfcounts(fs, samples, &passes);
+
+    if (liquid_autotest_verbose)
+        printf("  detector passes : %lu (reference %lu)\n", passes, passes_ref);
+    CONTEND_EQUALITY(passes_ref, num_noise/M);
+    CONTEND_LESS_THAN(passes, passes_ref/8);
+
+    for (i=0; i<M; i++) {
+        if (p[i] == OFDMFRAME_SCTYPE_DATA) {
+            float e = crealf( (X[i] - X_test[i])*conjf(X[i] - X_test[i]) );
+            CONTEND_DELTA( cabsf(e), 0.0f, tol );
+        }
+    }
+
+    free(y);
+    ofdmframegen_destroy(fg);
+    ofdmframesync_destroy(fs);
+}
+
+void autotest_ofdmframesync_autocorr_n64()  { ofdmframesync_autocorr_test( 64,  8); }
+void autotest_ofdmframesync_autocorr_n256() { ofdmframesync_autocorr_test(256, 32); }
+
+// squelch: on noise the transform-based detector is (almost) never
+// evaluated, the noise floor is estimated, and a frame following the
+// noise is still acquired
+//  _M      :   number of subcarriers
+//  _ac     :   autocorrelation seek threshold (0: disabled)
+void ofdmframesync_squelch_test(unsigned int _M,
+                                float        _ac)
+{
+    unsigned int M         = _M;
+    unsigned int cp_len    = M/8;
+    unsigned int taper_len = 0;
+    unsigned int num_noise = 64*M;          // noise-only samples
+    float        nstd      = 0.01f;         // noise standard deviation (-40 dB)
+    float        dphi      = 1.0f/(float)M; // carrier frequency offset
+    float        tol       = 1e-2f;         // error tolerance
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    float complex X[M];         // original data sequence
+    float complex X_test[M];    // recovered data sequence
+    ofdmframegen  fg = ofdmframegen_create(M, cp_len, taper_len, p);
+    ofdmframesync fs = ofdmframesync_create(M, cp_len, taper_len, p,
+                                            ofdmframesync_autotest_callback,
+                                            (void*)X_test);
+    ofdmframesync_set_seek_autocorr(fs, _ac);
+    ofdmframesync_squelch_enable(fs);
+    CONTEND_EQUALITY(ofdmframesync_squelch_is_enabled(fs), 1);
+    ofdmframesync_perf_enable(fs, 1);
+
+    unsigned int i;
+    unsigned int n0 = M + cp_len;
+    unsigned int num_samples = num_noise + 4*n0;
+    float complex * y = (float complex*) calloc(num_samples, sizeof(float complex));
+
+    unsigned int n = num_noise;
+    ofdmframegen_write_S0a(fg, &y[n]); n += n0;
+    ofdmframegen_write_S0b(fg, &y[n]); n += n0;
+    ofdmframegen_write_S1 (fg, &y[n]); n += n0;
+    for (i=0; i<M; i++) {
+        X[i]      = cexpf(_Complex_I*2*M_PI*randf());
+        X_test[i] = 0.0f;
+    }
+    ofdmframegen_writesymbol(fg, X, &y[n]);
+    for (i=0; i<num_samples; i++) {
+        y[i] *= cexpf(_Complex_I*dphi*i);
+        y[i] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+    }
+
+    // run noise, then frame
+    unsigned long int samples[3];
+    unsigned long int passes;
+    ofdmframesync_execute(fs, y, num_noise);
+    ofdmframesync_get_perfcounts(fs, samples, &passes);
+    float noise_floor = ofdmframesync_squelch_get_noise_floor(fs);
+    ofdmframesync_execute(fs, &y[num_noise], num_samples - num_noise);
+
+    if (liquid_autotest_verbose)
+        printf("  detector passes : %lu / %u blocks, noise floor %.2f dB\n",
+                passes, num_noise/M, noise_floor);
+    CONTEND_LESS_THAN(passes, num_noise/M/8);
+    CONTEND_DELTA(noise_floor, -40.0f, 1.0f);
+
+    for (i=0; i<M; i++) {
+        if (p[i] == OFDMFRAME_SCTYPE_DATA) {
+            float e = crealf( (X[i] - X_test[i])*conjf(X[i] - X_test[i]) );
+            CONTEND_DELTA( cabsf(e), 0.0f, tol );
+        }
+    }
+
+    free(y);
+    ofdmframegen_destroy(fg);
+    ofdmframesync_destroy(fs);
+}
+
+void autotest_ofdmframesync_squelch_n64()   { ofdmframesync_squelch_test( 64, 0.0f); }
+void autotest_ofdmframesync_squelch_n256()  { ofdmframesync_squelch_test(256, 0.0f); }
+void autotest_ofdmframesync_squelch_ac()    { ofdmframesync_squelch_test(128, 0.5f); }
+
+// cached PLCP symbols are identical across frames, and S1 written
+// out of sequence differs only within the tapering window
+void autotest_ofdmframegen_plcp_cache()
+{
+    unsigned int M         = 64;
+    unsigned int cp_len    = 16;
+    unsigned int taper_len = 4;
+    unsigned int n         = M + cp_len;
+    unsigned int i;
+
+    ofdmframegen fg = ofdmframegen_create(M, cp_len, taper_len, NULL);
+
+    float complex X[M];
+    for (i=0; i<M; i++)
+        X[i] = (i % 2) ? 1.0f : -1.0f;
+
+    float complex y0[3*n];  // first frame
+    float complex y1[3*n];  // second frame
+    float complex y2[n];    // data symbol
+    float complex y3[n];    // S1 following data symbol
+
+    ofdmframegen_write_S0a(fg, &y0[0]);
+    ofdmframegen_write_S0b(fg, &y0[n]);
+    ofdmframegen_write_S1 (fg, &y0[2*n]);
+    ofdmframegen_writesymbol(fg, X, y2);
+
+    ofdmframegen_reset(fg);
+    ofdmframegen_write_S0a(fg, &y1[0]);
+    ofdmframegen_write_S0b(fg, &y1[n]);
+    ofdmframegen_write_S1 (fg, &y1[2*n]);
+    CONTEND_SAME_DATA(y0, y1, 3*n*sizeof(float complex));
+
+    ofdmframegen_writesymbol(fg, X, y2);
+    ofdmframegen_write_S1(fg, y3);
+    CONTEND_SAME_DATA(&y0[2*n+taper_len], &y3[taper_len], (n-taper_len)*sizeof(float complex));
+
+    ofdmframegen_destroy(fg);
+}
+
+// real passband frame: generator renders real samples from a
+// Hermitian-symmetric transform, synchronizer analyzes them directly;
+// input is delayed by a fraction of a baseband sample and fed to the
+// receiver in odd-length blocks
+//  _M      :   number of subcarriers
+//  _D      :   real samples per baseband sample
+//  _fc     :   center frequency
+//  _ac     :   autocorrelation seek threshold (0: disabled)
+void ofdmframesync_passband_test(unsigned int _M,
+                                 unsigned int _D,
+                                 float        _fc,
+                                 float        _ac)
+{
+    unsigned int M         = _M;
+    unsigned int cp_len    = M/4;
+    unsigned int taper_len = 4;
+    unsigned int D         = _D;
+    unsigned int delay     = 3;         // real samples
+    float        gain      = 0.3f;      // channel gain
+    float tol              = 1e-2f;     // error tolerance
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    ofdmframegen  fg = ofdmframegen_create_passband(M, cp_len, taper_len, p, D, _fc);
+    float complex X[M];         // original data sequence
+    float complex X_test[M];    // recovered data sequence
+    ofdmframesync fs = ofdmframesync_create_passband(M, cp_len, taper_len, p, D, _fc,
+                                                     ofdmframesync_autotest_callback,
+                                                     (void*)X_test);
+    ofdmframesync_set_seek_autocorr(fs, _ac);
+
+    unsigned int i;
+    unsigned int n0 = D*(M + cp_len);
+    unsigned int num_samples = delay + 4*n0 + D*taper_len;
+    float * y = (float*) calloc(num_samples, sizeof(float));
+
+    unsigned int n = delay;
+    ofdmframegen_write_S0a_real(fg, &y[n]); n += n0;
+    ofdmframegen_write_S0b_real(fg, &y[n]); n += n0;
+    ofdmframegen_write_S1_real (fg, &y[n]); n += n0;
+
+    for (i=0; i<M; i++) {
+        X[i]      = cexpf(_Complex_I*2*M_PI*randf());
+        X_test[i] = 0.0f;
+    }
+    ofdmframegen_writesymbol_real(fg, X, &y[n]); n += n0;
+    ofdmframegen_writetail_real(fg, &y[n]);
+
+    for (i=0; i<num_samples; i++)
+        y[i] *= gain;
+
+    // run receiver in odd-length blocks
+    unsigned int block_len = 37;
+    for (i=0; i<num_samples; i+=block_len)
+        ofdmframesync_execute_real(fs, &y[i], i + block_len < num_samples ? block_len : num_samples - i);
+
+    for (i=0; i<M; i++) {
+        if (p[i] == OFDMFRAME_SCTYPE_DATA) {
+            float e = crealf( (X[i] - X_test[i])*conjf(X[i] - X_test[i]) );
+            CONTEND_DELTA( cabsf(e), 0.0f, tol );
+        }
+    }
+
+    free(y);
+    ofdmframegen_destroy(fg);
+    ofdmframesync_destroy(fs);
+}
 
+void autotest_ofdmframesync_passband_n64()  { ofdmframesync_passband_test( 64, 4, 0.25f, 0.0f); }
+void autotest_ofdmframesync_passband_n256() { ofdmframesync_passband_test(256, 3, 0.20f, 0.0f); }
+void autotest_ofdmframesync_passband_ac()   { ofdmframesync_passband_test(128, 4, 0.30f, 0.5f); }
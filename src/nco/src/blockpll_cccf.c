@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+//
+// blockpll_cccf.c
+//
+// block carrier-tracking loop: the input is mixed down with the block
+// mixer, the phase error is estimated over each sub-block, and the
+// second-order loop filter is updated once per sub-block
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+struct blockpll_cccf_s {
+    int             ms;             // modulation scheme
+    unsigned int    block_len;      // sub-block length
+    float           bandwidth;      // loop bandwidth (per sample)
+    nco_crcf        nco;            // oscillator
+    modem           demod;          // decision-directed detector
+
+    float complex * ref;            // reference points [size: block_len x 1]
+    unsigned int  * sym;            // decisions [size: block_len x 1]
+    float           dphi;           // phase error of last sub-block
+};
+
+// create block carrier-tracking loop
+blockpll_cccf blockpll_cccf_create(int          _ms,
+                                   unsigned int _block_len)
+{
+    // validate input
+    if (_ms == LIQUID_MODEM_UNKNOWN || _ms >= LIQUID_MODEM_NUM_SCHEMES) {
+        fprintf(stderr,"error: blockpll_cccf_create(), invalid modulation scheme\n");
+        exit(1);
+    } else if (liquid_modem_is_dpsk(_ms)) {
+        fprintf(stderr,"error: blockpll_cccf_create(), differential schemes carry no absolute phase\n");
+        exit(1);
+    } else if (_block_len == 0) {
+        fprintf(stderr,"error: blockpll_cccf_create(), sub-block length must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate memory for main object
+    blockpll_cccf q = (blockpll_cccf) liquid_malloc(sizeof(struct blockpll_cccf_s));
+    q->ms        = _ms;
+    q->block_len = _block_len;
+
+    // create objects, buffers
+    q->nco   = nco_crcf_create(LIQUID_VCO);
+    q->demod = modem_create(_ms);
+    q->ref   = (float complex*) liquid_malloc(q->block_len*sizeof(float complex));
+    q->sym   = (unsigned int *) liquid_malloc(q->block_len*sizeof(unsigned int));
+
+    // set default bandwidth, reset and return
+    blockpll_cccf_set_bandwidth(q, 0.001f);
+    blockpll_cccf_reset(q);
+    return q;
+}
+
+// destroy block carrier-tracking loop
+void blockpll_cccf_destroy(blockpll_cccf _q)
+{
+    nco_crcf_destroy(_q->nco);
+    modem_destroy(_q->demod);
+    liquid_free(_q->ref);
+    liquid_free(_q->sym);
+    liquid_free(_q);
+}
+
+// reset loop state (phase, frequency)
+void blockpll_cccf_reset(blockpll_cccf _q)
+{
+    nco_crcf_reset(_q->nco);
+    _q->dphi = 0.0f;
+}
+
+// print loop parameters
+void blockpll_cccf_print(blockpll_cccf _q)
+{
+    printf("blockpll_cccf:\n");
+    printf("    scheme      :   %s\n", modulation_types[_q->ms].name);
+    printf("    block len   :   %u\n", _q->block_len);
+    printf("    bandwidth   :   %12.4e\n", _q->bandwidth);
+}
+
+// set loop bandwidth
+void blockpll_cccf_set_bandwidth(blockpll_cccf _q,
+                                 float         _bw)
+{
+    if (_bw < 0.0f) {
+        fprintf(stderr,"error: blockpll_cccf_set_bandwidth(), bandwidth must be positive\n");
+        exit(1);
+    }
+    _q->bandwidth = _bw;
+    nco_crcf_pll_set_bandwidth(_q->nco, _bw);
+}
+
+void blockpll_cccf_set_frequency(blockpll_cccf _q, float _dtheta) { nco_crcf_set_frequency(_q->nco, _dtheta); }
+void blockpll_cccf_set_phase    (blockpll_cccf _q, float _theta)  { nco_crcf_set_phase    (_q->nco, _theta);  }
+float blockpll_cccf_get_frequency  (blockpll_cccf _q) { return nco_crcf_get_frequency(_q->nco); }
+float blockpll_cccf_get_phase      (blockpll_cccf _q) { return nco_crcf_get_phase    (_q->nco); }
+float blockpll_cccf_get_phase_error(blockpll_cccf _q) { return _q->dphi; }
+
+// mix block down by the loop oscillator without updating the loop
+void blockpll_cccf_mix_down(blockpll_cccf   _q,
+                            float complex * _x,
+                            float complex * _y,
+                            unsigned int    _n)
+{
+    nco_crcf_mix_block_down(_q->nco, _x, _y, _n);
+}
+
+// update loop filter with phase error averaged over _n samples
+void blockpll_cccf_update(blockpll_cccf _q,
+                          float         _dphi,
+                          unsigned int  _n)
+{
+    _q->dphi = _dphi;
+    nco_crcf_pll_step_block(_q->nco, _dphi, _n);
+}
+
+// track carrier over block of samples with reference points _ref
+// known (pilots) or NULL (decision-directed)
+static void blockpll_cccf_track(blockpll_cccf         _q,
+                                float complex *       _x,
+                                const float complex * _ref,
+                                float complex *       _y,
+                                unsigned int          _n)
+{
+    unsigned int i, j;
+    for (i=0; i<_n; i+=_q->block_len) {
+        unsigned int    n = _n - i < _q->block_len ? _n - i : _q->block_len;
+        float complex * y = &_y[i];
+
+        // mix down with current estimate
+        nco_crcf_mix_block_down(_q->nco, &_x[i], y, n);
+
+        // correlate against reference points
+        const float complex * ref = _ref != NULL ? &_ref[i] : _q->ref;
+        if (_ref == NULL) {
+            modem_demodulate_block(_q->demod, y, n, _q->sym);
+            modem_modulate_block  (_q->demod, _q->sym, n, _q->ref);
+        }
+        float complex acc = 0.0f;
+        for (j=0; j<n; j++)
+            acc += conjf(ref[j]) * y[j];
+
+        // update loop once per sub-block
+        blockpll_cccf_update(_q, acc != 0.0f ? cargf(acc) : 0.0f, n);
+    }
+}
+
+// track carrier over block of samples (decision-directed)
+void blockpll_cccf_execute(blockpll_cccf   _q,
+                           float complex * _x,
+                           float complex * _y,
+                           unsigned int    _n)
+{
+    blockpll_cccf_track(_q, _x, NULL, _y, _n);
+}
+
+// track carrier over block of samples with known symbols
+void blockpll_cccf_execute_pilots(blockpll_cccf   _q,
+                                  float complex * _x,
+                                  float complex * _pilots,
+                                  float complex * _y,
+                                  unsigned int    _n)
+{
+    blockpll_cccf_track(_q, _x, _pilots, _y, _n);
+}
@@ -28,13 +28,26 @@
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <assert.h>
 
 #define NCO_PLL_BANDWIDTH_DEFAULT   (0.1)
+#define NCO_PLL_BLOCK_MAX_GAIN      (0.5f)  // max. phase gain of block update
 #define NCO_PLL_GAIN_DEFAULT        (1000)
 
 #define LIQUID_DEBUG_NCO            (0)
 
+// interpolated table size (log2) for LIQUID_NCO_INTERP
+#define NCO_INTERP_BITS_DEFAULT     (10)
+#define NCO_INTERP_BITS_MIN         (4)
+#define NCO_INTERP_BITS_MAX         (16)
+
+// radians per unit of the 32-bit phase accumulator
+#define NCO_INTERP_SCALE            (2*M_PI/4294967296.0)
+
+// samples per liquid_sincosf_block() call in NCO(_cexpf_block)
+#define NCO_CEXPF_BLOCK_LEN         (64)
+
 struct NCO(_s) {
     liquid_ncotype type;
     T theta;            // NCO phase
@@ -45,6 +58,13 @@ struct NCO(_s) {
     T cosine;
     void (*compute_sincos)(NCO() _q);
 
+    // LIQUID_NCO_INTERP: 32-bit phase accumulator, wrapping naturally,
+    // and sine table of 2^tab_bits entries
+    uint32_t     phase;     // phase (2 pi / 2^32 units)
+    uint32_t     d_phase;   // phase step (frequency)
+    unsigned int tab_bits;  // log2 of table size
+    T *          tab;       // sine table [size: 2^tab_bits x 1]
+
     // phase-locked loop
     T alpha;
     T beta;
@@ -53,8 +73,12 @@ struct NCO(_s) {
 // create nco/vco object
 NCO() NCO(_create)(liquid_ncotype _type)
 {
-    NCO() q = (NCO()) malloc(sizeof(struct NCO(_s)));
+    if (_type == LIQUID_NCO_INTERP)
+        return NCO(_create_interp)(NCO_INTERP_BITS_DEFAULT);
+
+    NCO() q = (NCO()) liquid_malloc(sizeof(struct NCO(_s)));
     q->type = _type;
+    q->tab  = NULL;
 
     // initialize sine table
     unsigned int i;
@@ -79,10 +103,51 @@ NCO() NCO(_create)(liquid_ncotype _type)
     return q;
 }
 
+// create interpolated-table nco object (LIQUID_NCO_INTERP)
+//  _table_bits :   log2 of sine table size, in [4,16]
+NCO() NCO(_create_interp)(unsigned int _table_bits)
+{
+    if (_table_bits < NCO_INTERP_BITS_MIN || _table_bits > NCO_INTERP_BITS_MAX) {
+        fprintf(stderr,"error: nco_create_interp(), table size must be 2^%u to 2^%u\n",
+                NCO_INTERP_BITS_MIN, NCO_INTERP_BITS_MAX);
+        exit(1);
+    }
+
+    NCO() q = (NCO()) liquid_malloc(sizeof(struct NCO(_s)));
+    q->type = LIQUID_NCO_INTERP;
+
+    // initialize sine table
+    unsigned int i;
+    unsigned int n = 1 << _table_bits;
+    q->tab_bits = _table_bits;
+    q->tab = (T*) liquid_malloc(n*sizeof(T));
+    for (i=0; i<n; i++)
+        q->tab[i] = SIN(2.0*M_PI*(double)(i)/(double)n);
+
+    // set default pll bandwidth
+    NCO(_pll_set_bandwidth)(q, NCO_PLL_BANDWIDTH_DEFAULT);
+
+    q->compute_sincos = &NCO(_compute_sincos_interp);
+
+    // reset object and return
+    NCO(_reset)(q);
+    return q;
+}
+
 // destroy nco object
 void NCO(_destroy)(NCO() _q)
 {
-    free(_q);
+    liquid_free(_q->tab);
+    liquid_free(_q);
+}
+
+// get memory footprint of object and its sine table [bytes]
+unsigned long int NCO(_get_memory_usage)(NCO() _q)
+{
+    unsigned long int n = sizeof(struct NCO(_s));
+    if (_q->tab != NULL)
+        n += (1UL << _q->tab_bits)*sizeof(T);
+    return n;
 }
 
 // reset internal state of nco object
@@ -90,6 +155,8 @@ void NCO(_reset)(NCO() _q)
 {
     _q->theta = 0;
     _q->d_theta = 0;
+    _q->phase = 0;
+    _q->d_phase = 0;
 
     // reset sine table index
     _q->index = 0;
@@ -106,19 +173,29 @@ void NCO(_reset)(NCO() _q)
 void NCO(_set_frequency)(NCO() _q,
                          T _f)
 {
-    _q->d_theta = _f;
+    if (_q->type == LIQUID_NCO_INTERP)
+        _q->d_phase = NCO(_rad2phase)(_f);
+    else
+        _q->d_theta = _f;
 }
 
 // adjust frequency of nco object
 void NCO(_adjust_frequency)(NCO() _q,
                             T _df)
 {
-    _q->d_theta += _df;
+    if (_q->type == LIQUID_NCO_INTERP)
+        _q->d_phase += NCO(_rad2phase)(_df);
+    else
+        _q->d_theta += _df;
 }
 
 // set phase of nco object, constraining phase
 void NCO(_set_phase)(NCO() _q, T _phi)
 {
+    if (_q->type == LIQUID_NCO_INTERP) {
+        _q->phase = NCO(_rad2phase)(_phi);
+        return;
+    }
     _q->theta = _phi;
     NCO(_constrain_phase)(_q);
 }
@@ -126,6 +203,10 @@ void NCO(_set_phase)(NCO() _q, T _phi)
 // adjust phase of nco object, constraining phase
 void NCO(_adjust_phase)(NCO() _q, T _dphi)
 {
+    if (_q->type == LIQUID_NCO_INTERP) {
+        _q->phase += NCO(_rad2phase)(_dphi);
+        return;
+    }
     _q->theta += _dphi;
     NCO(_constrain_phase)(_q);
 }
@@ -133,6 +214,10 @@ void NCO(_adjust_phase)(NCO() _q, T _dphi)
 // increment internal phase of nco object
 void NCO(_step)(NCO() _q)
 {
+    if (_q->type == LIQUID_NCO_INTERP) {
+        _q->phase += _q->d_phase;
+        return;
+    }
     _q->theta += _q->d_theta;
     NCO(_constrain_phase)(_q);
 }
@@ -140,12 +225,16 @@ void NCO(_step)(NCO() _q)
 // get phase
 T NCO(_get_phase)(NCO() _q)
 {
+    if (_q->type == LIQUID_NCO_INTERP)
+        return NCO(_phase2rad)(_q->phase);
     return _q->theta;
 }
 
 // ge frequency
 T NCO(_get_frequency)(NCO() _q)
 {
+    if (_q->type == LIQUID_NCO_INTERP)
+        return NCO(_phase2rad)(_q->d_phase);
     return _q->d_theta;
 }
 
@@ -193,6 +282,41 @@ void NCO(_cexpf)(NCO() _q,
     *_y = _q->cosine + _Complex_I*(_q->sine);
 }
 
+// compute complex exponential for _n samples, stepping the phase
+// after each; the VCO phases follow NCO(_step) exactly while their
+// sine and cosine are evaluated in blocks (see liquid_sincosf_block),
+// table-based oscillators step sample by sample
+//  _q      :   nco object
+//  _y      :   output array [size: _n x 1]
+//  _n      :   number of output samples
+void NCO(_cexpf_block)(NCO()        _q,
+                       TC *         _y,
+                       unsigned int _n)
+{
+    unsigned int i0, i;
+    if (_q->type != LIQUID_VCO) {
+        for (i=0; i<_n; i++) {
+            NCO(_cexpf)(_q, &_y[i]);
+            NCO(_step)(_q);
+        }
+        return;
+    }
+
+    T theta[NCO_CEXPF_BLOCK_LEN];
+    T s[NCO_CEXPF_BLOCK_LEN];
+    T c[NCO_CEXPF_BLOCK_LEN];
+    for (i0=0; i0<_n; i0+=NCO_CEXPF_BLOCK_LEN) {
+        unsigned int n = _n - i0 < NCO_CEXPF_BLOCK_LEN ? _n - i0 : NCO_CEXPF_BLOCK_LEN;
+        for (i=0; i<n; i++) {
+            theta[i] = _q->theta;
+            NCO(_step)(_q);
+        }
+        liquid_sincosf_block(theta, n, s, c, LIQUID_TRIG_FAST);
+        for (i=0; i<n; i++)
+            _y[i0+i] = c[i] + _Complex_I*s[i];
+    }
+}
+
 // pll methods
 
 // reset pll state, retaining base frequency
@@ -230,6 +354,26 @@ void NCO(_pll_step)(NCO() _q,
     //NCO(_constrain_frequency)(_q);
 }
 
+// advance pll once for a block of samples
+//  _q      :   nco object
+//  _dphi   :   phase error averaged over block
+//  _n      :   number of samples in block
+void NCO(_pll_step_block)(NCO()        _q,
+                          T            _dphi,
+                          unsigned int _n)
+{
+    T alpha = (T)_n * _q->alpha;
+    T beta  = (T)_n * _q->beta;
+    if (beta > NCO_PLL_BLOCK_MAX_GAIN) {
+        // keep ratio alpha = beta^2/_n of the unlimited loop
+        beta  = NCO_PLL_BLOCK_MAX_GAIN;
+        alpha = beta*beta / (T)_n;
+    }
+
+    NCO(_adjust_frequency)(_q, _dphi*alpha);
+    NCO(_adjust_phase)(_q, _dphi*beta);
+}
+
 // mixing functions
 
 // Rotate input vector up by NCO angle, y = x exp{+j theta}
@@ -264,9 +408,48 @@ void NCO(_mix_down)(NCO() _q,
 }
 
 
+// Rotate input vector array by NCO angle, stepping the phase:
+//      y(t) = x(t) exp{+/-j (f*t + theta)}
+// The exponential is generated by recursive phasor rotation with
+// periodic re-anchoring to the exact phase (see nco_kernels.c), so
+// the output follows the ideal (VCO) phase for all oscillator
+// types to within floating-point rounding.
+//  _q      :   nco object
+//  _x      :   input array [size: _n x 1]
+//  _y      :   output sample [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _dir    :   direction (+1: up, -1: down)
+void NCO(_mix_block)(NCO() _q,
+                     TC *_x,
+                     TC *_y,
+                     unsigned int _n,
+                     int _dir)
+{
+    T theta   = NCO(_get_phase)(_q);
+    T d_theta = NCO(_get_frequency)(_q);
+    if (_dir < 0) {
+        theta   = -theta;
+        d_theta = -d_theta;
+    }
+
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_NCO) == LIQUID_SIMD_AVX2)
+        liquid_nco_mix_block_avx2(_x, _y, _n, theta, d_theta);
+    else
+#endif
+    liquid_nco_mix_block(_x, _y, _n, theta, d_theta);
+
+    // advance phase by _n steps
+    if (_q->type == LIQUID_NCO_INTERP) {
+        _q->phase += (uint32_t)_n * _q->d_phase;
+        return;
+    }
+    _q->theta = fmod((double)_q->theta + (double)_n*(double)_q->d_theta, 2*M_PI);
+    NCO(_constrain_phase)(_q);
+}
+
 // Rotate input vector array up by NCO angle:
 //      y(t) = x(t) exp{+j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -276,34 +459,11 @@ void NCO(_mix_block_up)(NCO() _q,
                         TC *_y,
                         unsigned int _n)
 {
-    unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(theta) + _Complex_I*sin(theta)]
-        _y[i] = _x[i] * liquid_cexpjf(theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample up
-        NCO(_mix_up)(_q, _x[i], &_y[i]);
-
-        // step NCO phase
-        NCO(_step)(_q);
-    }
-#endif
+    NCO(_mix_block)(_q, _x, _y, _n, 1);
 }
 
 // Rotate input vector array down by NCO angle:
 //      y(t) = x(t) exp{-j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -313,29 +473,7 @@ void NCO(_mix_block_down)(NCO() _q,
                           TC *_y,
                           unsigned int _n)
 {
-    unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(-theta) + _Complex_I*sin(-theta)]
-        _y[i] = _x[i] * liquid_cexpjf(-theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample down
-        NCO(_mix_down)(_q, _x[i], &_y[i]);
-
-        // step NCO phase
-        NCO(_step)(_q);
-    }
-#endif
+    NCO(_mix_block)(_q, _x, _y, _n, -1);
 }
 
 //
@@ -383,3 +521,38 @@ void NCO(_compute_sincos_vco)(NCO() _q)
     _q->cosine = COS(_q->theta);
 }
 
+// compute sin, cos of internal phase of interpolated-table nco: the
+// nearest table entry is rotated by the residual phase b, with
+//      sin(a+b) ~ sin(a) (1 - b^2/2) + cos(a) b
+//      cos(a+b) ~ cos(a) (1 - b^2/2) - sin(a) b
+// for an error below |b|^3/6 <= (pi/2^tab_bits)^3/6
+void NCO(_compute_sincos_interp)(NCO() _q)
+{
+    unsigned int shift = 32 - _q->tab_bits;
+    unsigned int mask  = (1u << _q->tab_bits) - 1;
+
+    // nearest entry, residual in [-1/2,1/2) of table spacing
+    unsigned int i = (_q->phase + (1u << (shift-1))) >> shift;
+    int32_t      r = (int32_t)(_q->phase - ((uint32_t)i << shift));
+    T b = (T)r * (T)NCO_INTERP_SCALE;
+    T g = 1.0f - 0.5f*b*b;
+
+    T s = _q->tab[i & mask];
+    T c = _q->tab[(i + (mask >> 2) + 1) & mask];
+    _q->sine   = s*g + c*b;
+    _q->cosine = c*g - s*b;
+}
+
+// convert phase in radians to 32-bit phase accumulator units
+uint32_t NCO(_rad2phase)(T _theta)
+{
+    double v = fmod((double)_theta, 2*M_PI) / NCO_INTERP_SCALE;
+    return (uint32_t)(int64_t)llrint(v);
+}
+
+// convert 32-bit phase accumulator units to phase in [-pi,pi)
+T NCO(_phase2rad)(uint32_t _phase)
+{
+    return (T)((double)(int32_t)_phase * NCO_INTERP_SCALE);
+}
+
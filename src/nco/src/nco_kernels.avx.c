@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// nco_kernels.avx.c : block mixing kernels for nco (x86 AVX2)
+//
+// The eight phasors of the portable kernel in nco_kernels.c are held
+// interleaved (re,im) in two vectors so that input samples need no
+// shuffling; anchoring and rotation are identical, and results agree
+// to within floating-point rounding. These kernels are compiled with
+// per-function target attributes and are selected at run time.
+//
+
+#include <immintrin.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// complex multiply of four interleaved values
+__attribute__((target("avx2,fma")))
+static inline __m256 liquid_nco_cmul4(__m256 _a, __m256 _b)
+{
+    __m256 br = _mm256_moveldup_ps(_b);
+    __m256 bi = _mm256_movehdup_ps(_b);
+    __m256 as = _mm256_permute_ps(_a, 0xb1);
+    return _mm256_fmaddsub_ps(_a, br, _mm256_mul_ps(as, bi));
+}
+
+// mix block (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_nco_mix_block_avx2(const float complex * _x,
+                               float complex *       _y,
+                               unsigned int          _n,
+                               float                 _theta,
+                               float                 _dtheta)
+{
+    struct liquid_nco_mix_s m;
+    liquid_nco_mix_init(&m, _theta, _dtheta);
+    __m256 r = _mm256_setr_ps(m.r[0],m.r[1],m.r[0],m.r[1],m.r[0],m.r[1],m.r[0],m.r[1]);
+
+    const float * x = (const float *)_x;
+    float *       y = (float *)      _y;
+    unsigned int i0, i, k;
+    for (i0=0; i0<_n; i0+=LIQUID_NCO_MIX_SEGMENT) {
+        unsigned int n = _n - i0 < LIQUID_NCO_MIX_SEGMENT ? _n - i0 : LIQUID_NCO_MIX_SEGMENT;
+
+        float p[2*LIQUID_NCO_MIX_LANES];
+        liquid_nco_mix_segment(&m, p);
+        __m256 p0 = _mm256_loadu_ps(p);
+        __m256 p1 = _mm256_loadu_ps(p + 8);
+
+        for (i=i0; i+8<=i0+n; i+=8) {
+            __m256 x0 = _mm256_loadu_ps(x + 2*i);
+            __m256 x1 = _mm256_loadu_ps(x + 2*i + 8);
+            _mm256_storeu_ps(y + 2*i,     liquid_nco_cmul4(x0, p0));
+            _mm256_storeu_ps(y + 2*i + 8, liquid_nco_cmul4(x1, p1));
+            p0 = liquid_nco_cmul4(p0, r);
+            p1 = liquid_nco_cmul4(p1, r);
+        }
+
+        // remaining samples in segment
+        _mm256_storeu_ps(p,     p0);
+        _mm256_storeu_ps(p + 8, p1);
+        for (k=0; i<i0+n; i++, k++) {
+            float xr = x[2*i  ];
+            float xi = x[2*i+1];
+            y[2*i  ] = xr*p[2*k] - xi*p[2*k+1];
+            y[2*i+1] = xr*p[2*k+1] + xi*p[2*k];
+        }
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// nco_kernels.c : block mixing kernels for nco (portable C)
+//
+// The complex exponential is generated by recursive phasor rotation:
+// eight phasors offset by the phase step are each rotated by eight
+// steps per iteration. Every LIQUID_NCO_MIX_SEGMENT samples the phasors
+// are re-derived from a double-precision anchor, so that the rounding
+// error accumulated in phase and magnitude is bounded independently
+// of the block length.
+//
+
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// initialize block mixing state (see liquid.internal.h)
+void liquid_nco_mix_init(struct liquid_nco_mix_s * _m,
+                         float                     _theta,
+                         float                     _dtheta)
+{
+    _m->a[0] = cos((double)_theta);
+    _m->a[1] = sin((double)_theta);
+
+    // lane offsets and rotation per iteration by recursion
+    double c1 = cos((double)_dtheta);
+    double s1 = sin((double)_dtheta);
+    double cr = 1.0;
+    double ci = 0.0;
+    unsigned int k;
+    for (k=0; k<LIQUID_NCO_MIX_LANES; k++) {
+        _m->o[2*k  ] = cr;
+        _m->o[2*k+1] = ci;
+        double t = cr*c1 - ci*s1;
+        ci = cr*s1 + ci*c1;
+        cr = t;
+    }
+    _m->r[0] = (float)cr;
+    _m->r[1] = (float)ci;
+
+    // rotation per segment by repeated squaring
+    for (k=LIQUID_NCO_MIX_LANES; k<LIQUID_NCO_MIX_SEGMENT; k*=2) {
+        double t = cr*cr - ci*ci;
+        ci = 2*cr*ci;
+        cr = t;
+    }
+    _m->s[0] = cr;
+    _m->s[1] = ci;
+}
+
+// lane phasors for current segment (see liquid.internal.h)
+void liquid_nco_mix_segment(struct liquid_nco_mix_s * _m,
+                            float *                   _p)
+{
+    double ar = _m->a[0];
+    double ai = _m->a[1];
+    unsigned int k;
+    for (k=0; k<LIQUID_NCO_MIX_LANES; k++) {
+        _p[2*k  ] = (float)(ar*_m->o[2*k] - ai*_m->o[2*k+1]);
+        _p[2*k+1] = (float)(ar*_m->o[2*k+1] + ai*_m->o[2*k]);
+    }
+
+    // advance anchor and renormalize (first-order correction)
+    double t = ar*_m->s[0] - ai*_m->s[1];
+    ai = ar*_m->s[1] + ai*_m->s[0];
+    ar = t;
+    double g = 1.5 - 0.5*(ar*ar + ai*ai);
+    _m->a[0] = ar*g;
+    _m->a[1] = ai*g;
+}
+
+// mix block (see liquid.internal.h)
+void liquid_nco_mix_block(const float complex * _x,
+                          float complex *       _y,
+                          unsigned int          _n,
+                          float                 _theta,
+                          float                 _dtheta)
+{
+    const unsigned int L = LIQUID_NCO_MIX_LANES;
+    struct liquid_nco_mix_s m;
+    liquid_nco_mix_init(&m, _theta, _dtheta);
+    float rr = m.r[0];
+    float ri = m.r[1];
+
+    const float * x = (const float *)_x;
+    float *       y = (float *)      _y;
+    unsigned int i0, i, k;
+    for (i0=0; i0<_n; i0+=LIQUID_NCO_MIX_SEGMENT) {
+        unsigned int n = _n - i0 < LIQUID_NCO_MIX_SEGMENT ? _n - i0 : LIQUID_NCO_MIX_SEGMENT;
+
+        float p[2*LIQUID_NCO_MIX_LANES];
+        float pr[LIQUID_NCO_MIX_LANES], pi[LIQUID_NCO_MIX_LANES];
+        liquid_nco_mix_segment(&m, p);
+        for (k=0; k<L; k++) {
+            pr[k] = p[2*k  ];
+            pi[k] = p[2*k+1];
+        }
+
+        for (i=i0; i+L<=i0+n; i+=L) {
+            for (k=0; k<L; k++) {
+                float xr = x[2*(i+k)  ];
+                float xi = x[2*(i+k)+1];
+                y[2*(i+k)  ] = xr*pr[k] - xi*pi[k];
+                y[2*(i+k)+1] = xr*pi[k] + xi*pr[k];
+
+                float t = pr[k]*rr - pi[k]*ri;
+                pi[k]   = pr[k]*ri + pi[k]*rr;
+                pr[k]   = t;
+            }
+        }
+
+        // remaining samples in segment
+        for (k=0; i<i0+n; i++, k++) {
+            float xr = x[2*i  ];
+            float xi = x[2*i+1];
+            y[2*i  ] = xr*pr[k] - xi*pi[k];
+            y[2*i+1] = xr*pi[k] + xi*pr[k];
+        }
+    }
+}
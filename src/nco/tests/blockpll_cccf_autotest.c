@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <stdlib.h>
+#include <complex.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// test block carrier-tracking loop
+//  _ms             :   modulation scheme
+//  _block_len      :   sub-block length
+//  _pilots         :   use known symbols rather than decisions
+//  _phase_offset   :   initial phase offset
+//  _freq_offset    :   frequency offset
+//  _bw             :   loop bandwidth
+//  _tol            :   error tolerance
+void blockpll_cccf_test(int          _ms,
+                        unsigned int _block_len,
+                        int          _pilots,
+                        float        _phase_offset,
+                        float        _freq_offset,
+                        float        _bw,
+                        float        _tol)
+{
+    unsigned int n = 4000;  // number of symbols
+    unsigned int i;
+
+    // generate symbols with carrier offset
+    float complex * s = (float complex*) malloc(n*sizeof(float complex));
+    float complex * x = (float complex*) malloc(n*sizeof(float complex));
+    modem mod = modem_create(_ms);
+    unsigned int M = 1 << modem_get_bps(mod);
+    for (i=0; i<n; i++) {
+        modem_modulate(mod, rand() % M, &s[i]);
+        x[i] = s[i] * cexpf(_Complex_I*(_phase_offset + _freq_offset*i));
+    }
+
+    // run loop in place, in calls of odd length
+    blockpll_cccf q = blockpll_cccf_create(_ms, _block_len);
+    blockpll_cccf_set_bandwidth(q, _bw);
+    for (i=0; i<n; i+=97) {
+        unsigned int len = n - i < 97 ? n - i : 97;
+        if (_pilots) blockpll_cccf_execute_pilots(q, &x[i], &s[i], &x[i], len);
+        else         blockpll_cccf_execute       (q, &x[i],        &x[i], len);
+    }
+
+    // ensure loop has locked to frequency, and output to symbols
+    CONTEND_DELTA(blockpll_cccf_get_frequency(q), _freq_offset, _tol);
+    for (i=n-200; i<n; i++)
+        CONTEND_DELTA(cabsf(x[i] - s[i]), 0.0f, _tol);
+
+    if (liquid_autotest_verbose) {
+        printf("  frequency error : %12.4e, phase error : %12.4e\n",
+                blockpll_cccf_get_frequency(q) - _freq_offset,
+                blockpll_cccf_get_phase_error(q));
+    }
+
+    // clean it up
+    blockpll_cccf_destroy(q);
+    modem_destroy(mod);
+    free(s);
+    free(x);
+}
+
+void autotest_blockpll_cccf_qpsk()       { blockpll_cccf_test(LIQUID_MODEM_QPSK,  16, 0,  0.5f,   0.002f, 0.01f, 1e-3f); }
+void autotest_blockpll_cccf_qpsk_neg()   { blockpll_cccf_test(LIQUID_MODEM_QPSK,  32, 0, -0.5f,  -0.001f, 0.01f, 1e-3f); }
+void autotest_blockpll_cccf_qam16()      { blockpll_cccf_test(LIQUID_MODEM_QAM16,  8, 0,  0.2f,   0.001f, 0.01f, 1e-3f); }
+void autotest_blockpll_cccf_pilots()     { blockpll_cccf_test(LIQUID_MODEM_QPSK,  16, 1,  2.5f,   0.01f,  0.01f, 1e-3f); }
+void autotest_blockpll_cccf_long_block() { blockpll_cccf_test(LIQUID_MODEM_QPSK, 256, 1, -2.5f,   0.001f, 0.01f, 1e-3f); }
@@ -112,6 +112,96 @@ void autotest_vco_crcf_phase()
     nco_crcf_phase_test( 6.283185307f,  1.000000000f, -0.000000000f, LIQUID_VCO, tol);
 }
 
+// test interpolated-table nco phase
+void autotest_nco_interp_crcf_phase()
+{
+    // error tolerance
+    float tol = 1e-6f;
+
+    nco_crcf_phase_test(-6.283185307f,  1.000000000f,  0.000000000f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-6.195739393f,  0.996179042f,  0.087334510f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-5.951041106f,  0.945345356f,  0.326070787f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-5.131745978f,  0.407173250f,  0.913350943f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-4.748043551f,  0.035647016f,  0.999364443f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-3.041191113f, -0.994963998f, -0.100232943f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-1.947799864f, -0.368136099f, -0.929771914f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-1.143752030f,  0.414182352f, -0.910193924f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-1.029377689f,  0.515352252f, -0.856978446f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-0.174356887f,  0.984838307f, -0.173474811f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test(-0.114520496f,  0.993449692f, -0.114270338f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 0.000000000f,  1.000000000f,  0.000000000f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 1.436080000f,  0.134309213f,  0.990939471f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 2.016119855f, -0.430749878f,  0.902471353f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 2.996498473f, -0.989492293f,  0.144585621f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 3.403689755f, -0.965848729f, -0.259106603f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 3.591162483f, -0.900634128f, -0.434578148f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 5.111428476f,  0.388533479f, -0.921434607f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 5.727585681f,  0.849584319f, -0.527452828f, LIQUID_NCO_INTERP, tol);
+    nco_crcf_phase_test( 6.283185307f,  1.000000000f, -0.000000000f, LIQUID_NCO_INTERP, tol);
+}
+
+// sine/cosine of interpolated-table nco against double precision
+// over the full phase range; error is bounded by (pi/N)^3/6 for a
+// table of N entries, plus float rounding
+void nco_crcf_test_interp_sincos(unsigned int _table_bits,
+                                 float        _tol)
+{
+    nco_crcf q = nco_crcf_create_interp(_table_bits);
+
+    unsigned int i, n = 10000;
+    for (i=0; i<n; i++) {
+        double theta = 2*M_PI*((double)i/(double)n - 0.5) + 1e-4;
+        nco_crcf_set_phase(q, theta);
+
+        float s, c;
+        nco_crcf_sincos(q, &s, &c);
+        CONTEND_DELTA(c, cos(theta), _tol);
+        CONTEND_DELTA(s, sin(theta), _tol);
+    }
+
+    nco_crcf_destroy(q);
+}
+void autotest_nco_interp_sincos_b6()  { nco_crcf_test_interp_sincos( 6, 3e-5f); }
+void autotest_nco_interp_sincos_b10() { nco_crcf_test_interp_sincos(10, 1e-6f); }
+void autotest_nco_interp_sincos_b16() { nco_crcf_test_interp_sincos(16, 1e-6f); }
+
+// 32-bit phase accumulator wraps naturally: stepping and block
+// mixing advance the phase identically, and the accumulated phase
+// is off by at most half a phase unit per step
+void autotest_nco_interp_phase_wrap()
+{
+    float f   = 2.9f;
+    float phi = -1.0f;
+    unsigned int i, n = 100003;
+    float complex * x = (float complex*)malloc(n*sizeof(float complex));
+    for (i=0; i<n; i++)
+        x[i] = 1.0f;
+
+    nco_crcf q0 = nco_crcf_create(LIQUID_NCO_INTERP);
+    nco_crcf q1 = nco_crcf_create(LIQUID_NCO_INTERP);
+    nco_crcf_set_frequency(q0, f);
+    nco_crcf_set_frequency(q1, f);
+    nco_crcf_set_phase(q0, phi);
+    nco_crcf_set_phase(q1, phi);
+
+    for (i=0; i<n; i++)
+        nco_crcf_step(q0);
+    nco_crcf_mix_block_up(q1, x, x, n);
+
+    float theta = nco_crcf_get_phase(q0);
+    CONTEND_EQUALITY(theta, nco_crcf_get_phase(q1));
+    CONTEND_GREATER_THAN(theta, -M_PI - 1e-6f);
+    CONTEND_LESS_THAN   (theta,  M_PI + 1e-6f);
+
+    double dphi = theta - ((double)phi + (double)n*(double)f);
+    dphi -= 2*M_PI*round(dphi/(2*M_PI));
+    CONTEND_DELTA(dphi, 0.0, (n+1)*M_PI/4294967296.0);
+
+    nco_crcf_destroy(q0);
+    nco_crcf_destroy(q1);
+    free(x);
+}
+
 //
 // test floating point precision nco
 //
@@ -203,6 +293,40 @@ void autotest_nco_mixing() {
     nco_crcf_destroy(p);
 }
 
+//
+// test block complex exponential against stepping oscillator
+//
+void autotest_nco_cexpf_block()
+{
+    unsigned int n = 150;
+    int types[2] = {LIQUID_VCO, LIQUID_NCO};
+    unsigned int t, i;
+    for (t=0; t<2; t++) {
+        nco_crcf q0 = nco_crcf_create(types[t]);
+        nco_crcf q1 = nco_crcf_create(types[t]);
+        nco_crcf_set_frequency(q0, 0.9f);
+        nco_crcf_set_frequency(q1, 0.9f);
+        nco_crcf_set_phase    (q0, 2.0f);
+        nco_crcf_set_phase    (q1, 2.0f);
+
+        float complex y[n];
+        nco_crcf_cexpf_block(q1, y, n);
+        for (i=0; i<n; i++) {
+            float complex v;
+            nco_crcf_cexpf(q0, &v);
+            nco_crcf_step(q0);
+            CONTEND_DELTA(crealf(y[i]), crealf(v), 1e-6f);
+            CONTEND_DELTA(cimagf(y[i]), cimagf(v), 1e-6f);
+        }
+
+        // phase is advanced as by single steps
+        CONTEND_EQUALITY(nco_crcf_get_phase(q1), nco_crcf_get_phase(q0));
+
+        nco_crcf_destroy(q0);
+        nco_crcf_destroy(q1);
+    }
+}
+
 //
 // test nco block mixing
 //
@@ -258,3 +382,76 @@ void autotest_nco_block_mixing()
     nco_crcf_destroy(p);
 }
 
+
+// block mixing against ideal (double-precision) phase, for lengths
+// around the kernel lane and re-anchoring boundaries, in both
+// directions, at every SIMD level available on this host
+void nco_crcf_test_block_mixing(liquid_ncotype _type,
+                                float          _f,
+                                float          _phi)
+{
+    unsigned int lengths[] = {1, 7, 8, 9, 255, 256, 257, 5003};
+    unsigned int num_lengths = sizeof(lengths)/sizeof(lengths[0]);
+    unsigned int n_max = 5003;
+    float tol = 1e-5f;
+
+    float complex * x = (float complex*)malloc(n_max*sizeof(float complex));
+    float complex * y = (float complex*)malloc(n_max*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<n_max; i++)
+        x[i] = cexpf(_Complex_I*0.01f*i);
+
+    nco_crcf q = nco_crcf_create(_type);
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level, j, dir;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        for (j=0; j<num_lengths; j++) {
+            unsigned int n = lengths[j];
+            for (dir=0; dir<2; dir++) {
+                nco_crcf_set_frequency(q, _f);
+                nco_crcf_set_phase(q, _phi);
+                if (dir == 0) nco_crcf_mix_block_up  (q, x, y, n);
+                else          nco_crcf_mix_block_down(q, x, y, n);
+
+                double s = dir == 0 ? 1.0 : -1.0;
+                for (i=0; i<n; i++) {
+                    double theta = 0.01*i + s*((double)_phi + (double)i*(double)_f);
+                    CONTEND_DELTA(crealf(y[i]), cos(theta), tol);
+                    CONTEND_DELTA(cimagf(y[i]), sin(theta), tol);
+                }
+
+                // phase advanced by n steps (modulo 2 pi)
+                double dphi = nco_crcf_get_phase(q) - ((double)_phi + (double)n*(double)_f);
+                dphi -= 2*M_PI*round(dphi/(2*M_PI));
+                CONTEND_DELTA(dphi, 0.0, 1e-5);
+            }
+        }
+
+        // in place
+        for (i=0; i<n_max; i++)
+            y[i] = x[i];
+        nco_crcf_set_phase(q, _phi);
+        nco_crcf_mix_block_up(q, y, y, n_max);
+        for (i=0; i<n_max; i++) {
+            double theta = 0.01*i + (double)_phi + (double)i*(double)_f;
+            CONTEND_DELTA(crealf(y[i]), cos(theta), tol);
+            CONTEND_DELTA(cimagf(y[i]), sin(theta), tol);
+        }
+    }
+    liquid_simd_set_level(host);
+
+    nco_crcf_destroy(q);
+    free(x);
+    free(y);
+}
+
+void autotest_nco_block_mixing_nco()      { nco_crcf_test_block_mixing(LIQUID_NCO,  0.1f,    M_PI);  }
+void autotest_nco_block_mixing_vco()      { nco_crcf_test_block_mixing(LIQUID_VCO,  0.0123f, 2.5f);  }
+void autotest_nco_block_mixing_vco_neg()  { nco_crcf_test_block_mixing(LIQUID_VCO, -2.9f,   -1.0f);  }
+void autotest_nco_block_mixing_interp()   { nco_crcf_test_block_mixing(LIQUID_NCO_INTERP, 0.0123f, 2.5f); }
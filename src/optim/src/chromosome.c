@@ -40,7 +40,7 @@ chromosome chromosome_create(unsigned int * _bits_per_trait,
                              unsigned int _num_traits)
 {
     chromosome q;
-    q = (chromosome) malloc( sizeof(struct chromosome_s) );
+    q = (chromosome) liquid_malloc( sizeof(struct chromosome_s) );
     q->num_traits = _num_traits;
 
     // validate input
@@ -50,9 +50,9 @@ chromosome chromosome_create(unsigned int * _bits_per_trait,
     }
 
     // initialize internal arrays
-    q->bits_per_trait = (unsigned int *) malloc(q->num_traits*sizeof(unsigned int));
-    q->max_value =      (unsigned long*) malloc(q->num_traits*sizeof(unsigned long));
-    q->traits =         (unsigned long*) malloc(q->num_traits*sizeof(unsigned long));
+    q->bits_per_trait = (unsigned int *) liquid_malloc(q->num_traits*sizeof(unsigned int));
+    q->max_value =      (unsigned long*) liquid_malloc(q->num_traits*sizeof(unsigned long));
+    q->traits =         (unsigned long*) liquid_malloc(q->num_traits*sizeof(unsigned long));
 
     // copy/initialize values
     unsigned int i;
@@ -86,7 +86,7 @@ chromosome chromosome_create_basic(unsigned int _num_traits,
         exit(1);
     }
 
-    unsigned int * bpt = (unsigned int *) malloc(_num_traits*sizeof(unsigned int));
+    unsigned int * bpt = (unsigned int *) liquid_malloc(_num_traits*sizeof(unsigned int));
     unsigned int i;
     for (i=0; i<_num_traits; i++)
         bpt[i] = _bits_per_trait;
@@ -95,7 +95,7 @@ chromosome chromosome_create_basic(unsigned int _num_traits,
     chromosome q = chromosome_create(bpt, _num_traits);
 
     // free bits/trait array
-    free(bpt);
+    liquid_free(bpt);
 
     return q;
 }
@@ -125,11 +125,11 @@ void chromosome_copy(chromosome _parent,
 
 void chromosome_destroy(chromosome _q)
 {
-    free(_q->bits_per_trait);
-    free(_q->max_value);
-    free(_q->traits);
+    liquid_free(_q->bits_per_trait);
+    liquid_free(_q->max_value);
+    liquid_free(_q->traits);
 
-    free(_q);
+    liquid_free(_q);
 }
 
 unsigned int chromosome_get_num_traits(chromosome _q)
@@ -295,7 +295,7 @@ void chromosome_init_random(chromosome _q)
 {
     unsigned int i;
     for (i=0; i<_q->num_traits; i++)
-        _q->traits[i] = rand() & (_q->max_value[i]-1);
+        _q->traits[i] = randu64_r(liquid_rand_state()) & (_q->max_value[i]-1);
 }
 
 float chromosome_valuef(chromosome _q,
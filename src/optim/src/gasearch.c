@@ -36,6 +36,40 @@
 
 #define LIQUID_DEBUG_GA_SEARCH 0
 
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define GASEARCH_THREADS (1)
+#else
+#define GASEARCH_THREADS (0)
+#endif
+
+#if GASEARCH_THREADS
+// worker pool evaluating slices of the population
+struct gasearch_pool_s {
+    gasearch            q;              // parent search object
+    pthread_t *         threads;        // worker threads [num_threads-1]
+    pthread_mutex_t     mutex;          // protects batch state
+    pthread_cond_t      cv_work;        // signalled when batch is posted
+    pthread_cond_t      cv_done;        // signalled when batch completes
+    unsigned long int   batch;          // batch counter
+    unsigned int        slice_len;      // chromosomes per slice
+    unsigned int        num_slices;     // number of slices in batch
+    unsigned int        next;           // next slice to evaluate in batch
+    unsigned int        num_done;       // number of slices completed in batch
+    int                 stop;           // worker shutdown flag
+};
+
+// create/destroy worker pool for search object
+void gasearch_pool_create(gasearch _q);
+void gasearch_pool_destroy(gasearch _q);
+
+// evaluate remaining slices of current batch (mutex held on entry/exit)
+void gasearch_pool_run_batch(struct gasearch_pool_s * _p);
+
+// worker thread main loop
+void * gasearch_pool_worker(void * _arg);
+#endif
+
 // Create a simple gasearch object; parameters are specified internally
 //  _utility            :   chromosome fitness utility function
 //  _userdata           :   user data, void pointer passed to _utility() callback
@@ -69,7 +103,7 @@ gasearch gasearch_create_advanced(gasearch_utility _utility,
                                   float _mutation_rate)
 {
     gasearch ga;
-    ga = (gasearch) malloc( sizeof(struct gasearch_s) );
+    ga = (gasearch) liquid_malloc( sizeof(struct gasearch_s) );
 
     if (_population_size > LIQUID_GA_SEARCH_MAX_POPULATION_SIZE) {
         fprintf(stderr,"error: gasearch_create(), population size exceeds maximum\n");
@@ -85,7 +119,11 @@ gasearch gasearch_create_advanced(gasearch_utility _utility,
     ga->population_size = _population_size;
     ga->mutation_rate   = _mutation_rate;
     ga->get_utility     = _utility;
+    ga->get_utility_batch = NULL;
     ga->minimize        = ( _minmax==LIQUID_OPTIM_MINIMIZE ) ? 1 : 0;
+    ga->num_threads     = 1;
+    ga->pool            = NULL;
+    liquid_rand_seed_object(&ga->rng);
 
     ga->bits_per_chromosome = _parent->num_bits;
 
@@ -93,8 +131,8 @@ gasearch gasearch_create_advanced(gasearch_utility _utility,
     ga->selection_size = ( ga->population_size >> 2 ) < 2 ? 2 : ga->population_size >> 2;
 
     // allocate internal arrays
-    ga->population = (chromosome*) malloc( sizeof(chromosome)*(ga->population_size) );
-    ga->utility = (float*) calloc( sizeof(float), ga->population_size );
+    ga->population = (chromosome*) liquid_malloc( sizeof(chromosome)*(ga->population_size) );
+    ga->utility = (float*) liquid_calloc( sizeof(float), ga->population_size );
 
     // create optimum chromosome (clone)
     ga->c = chromosome_create_clone(_parent);
@@ -128,16 +166,20 @@ gasearch gasearch_create_advanced(gasearch_utility _utility,
 // destroy a gasearch object
 void gasearch_destroy(gasearch _g)
 {
+#if GASEARCH_THREADS
+    gasearch_pool_destroy(_g);
+#endif
+
     unsigned int i;
     for (i=0; i<_g->population_size; i++)
         chromosome_destroy( _g->population[i] );
-    free(_g->population);
+    liquid_free(_g->population);
 
     // destroy optimum chromosome
     chromosome_destroy(_g->c);
 
-    free(_g->utility);
-    free(_g);
+    liquid_free(_g->utility);
+    liquid_free(_g);
 }
 
 // print search parameter internals
@@ -149,6 +191,7 @@ void gasearch_print(gasearch _g)
     printf("    population size :   %u\n", _g->population_size);
     printf("    selection size  :   %u\n", _g->selection_size);
     printf("    mutation rate   :   %12.8f\n", _g->mutation_rate);
+    printf("    num threads     :   %u\n", _g->num_threads);
     printf("population:\n");
     unsigned int i;
     for (i=0; i<_g->population_size; i++) {
@@ -178,8 +221,8 @@ void gasearch_set_population_size(gasearch _g,
     }
 
     // re-size arrays
-    _g->population = (chromosome*) realloc( _g->population, _population_size*sizeof(chromosome) );
-    _g->utility = (float*) realloc( _g->utility, _population_size*sizeof(float) );
+    _g->population = (chromosome*) liquid_realloc( _g->population, _population_size*sizeof(chromosome) );
+    _g->utility = (float*) liquid_realloc( _g->utility, _population_size*sizeof(float) );
 
     // initialize new chromosomes (copies)
     if (_population_size > _g->population_size) {
@@ -201,6 +244,35 @@ void gasearch_set_population_size(gasearch _g,
     _g->selection_size  = _selection_size;
 }
 
+// set batched utility callback used to evaluate the population in
+// place of the per-chromosome utility (NULL reverts to per-chromosome)
+void gasearch_set_utility_batch(gasearch               _g,
+                                gasearch_utility_batch _utility)
+{
+    _g->get_utility_batch = _utility;
+}
+
+// set number of threads evaluating the population, including the caller
+void gasearch_set_num_threads(gasearch     _g,
+                              unsigned int _num_threads)
+{
+    if (_num_threads == 0) {
+        fprintf(stderr,"error: gasearch_set_num_threads(), number of threads must be greater than zero\n");
+        exit(1);
+    }
+
+#if GASEARCH_THREADS
+    gasearch_pool_destroy(_g);
+    _g->num_threads = _num_threads;
+    if (_g->num_threads > 1)
+        gasearch_pool_create(_g);
+#else
+    if (_num_threads > 1)
+        fprintf(stderr,"warning: gasearch_set_num_threads(), built without pthreads; evaluating serially\n");
+    _g->num_threads = 1;
+#endif
+}
+
 // set mutation rate
 void gasearch_set_mutation_rate(gasearch _g,
                                 float _mutation_rate)
@@ -286,8 +358,48 @@ void gasearch_getopt(gasearch _g,
 // evaluate fitness of entire population
 void gasearch_evaluate(gasearch _g)
 {
+#if GASEARCH_THREADS
+    if (_g->pool != NULL) {
+        struct gasearch_pool_s * p = _g->pool;
+        pthread_mutex_lock(&p->mutex);
+
+        // single chromosomes balance uneven evaluation times; batched
+        // callbacks receive one contiguous slice per thread
+        if (_g->get_utility_batch == NULL)
+            p->slice_len = 1;
+        else
+            p->slice_len = (_g->population_size + _g->num_threads - 1) / _g->num_threads;
+        p->num_slices = (_g->population_size + p->slice_len - 1) / p->slice_len;
+        p->next       = 0;
+        p->num_done   = 0;
+        p->batch++;
+        pthread_cond_broadcast(&p->cv_work);
+
+        // evaluate alongside worker threads, then wait for batch
+        gasearch_pool_run_batch(p);
+        while (p->num_done < p->num_slices)
+            pthread_cond_wait(&p->cv_done, &p->mutex);
+        pthread_mutex_unlock(&p->mutex);
+        return;
+    }
+#endif
+
+    gasearch_evaluate_range(_g, 0, _g->population_size);
+}
+
+// evaluate fitness of population slice [_i0, _i1)
+void gasearch_evaluate_range(gasearch     _g,
+                             unsigned int _i0,
+                             unsigned int _i1)
+{
+    if (_g->get_utility_batch != NULL) {
+        _g->get_utility_batch(_g->userdata, &_g->population[_i0],
+                              &_g->utility[_i0], _i1 - _i0);
+        return;
+    }
+
     unsigned int i;
-    for (i=0; i<_g->population_size; i++)
+    for (i=_i0; i<_i1; i++)
         _g->utility[i] = _g->get_utility(_g->userdata, _g->population[i]);
 }
 
@@ -301,9 +413,9 @@ void gasearch_crossover(gasearch _g)
     unsigned int i;
     for (i=_g->selection_size; i<_g->population_size; i++) {
         // ensure fittest member is used at least once as parent
-        p1 = (i==_g->selection_size) ? _g->population[0] : _g->population[rand() % _g->selection_size];
-        p2 = _g->population[rand() % _g->selection_size];
-        threshold = rand() % _g->bits_per_chromosome;
+        p1 = (i==_g->selection_size) ? _g->population[0] : _g->population[randu64_r(&_g->rng) % _g->selection_size];
+        p2 = _g->population[randu64_r(&_g->rng) % _g->selection_size];
+        threshold = randu64_r(&_g->rng) % _g->bits_per_chromosome;
 
         c = _g->population[i];
 
@@ -324,9 +436,9 @@ void gasearch_mutate(gasearch _g)
         // generate random number and mutate if within mutation_rate range
         unsigned int num_mutations = 0;
         // force at least one mutation (otherwise nothing has changed)
-        while ( randf() < _g->mutation_rate || num_mutations == 0) {
+        while ( randf_r(&_g->rng) < _g->mutation_rate || num_mutations == 0) {
             // generate random mutation index
-            index = rand() % _g->bits_per_chromosome;
+            index = randu64_r(&_g->rng) % _g->bits_per_chromosome;
 
             // mutate chromosome at index
             chromosome_mutate( _g->population[i], index );
@@ -364,3 +476,93 @@ void gasearch_rank(gasearch _g)
     }
 }
 
+
+#if GASEARCH_THREADS
+// create worker pool for search object (num_threads-1 workers)
+void gasearch_pool_create(gasearch _g)
+{
+    struct gasearch_pool_s * p = (struct gasearch_pool_s*) liquid_malloc(sizeof(struct gasearch_pool_s));
+    p->q          = _g;
+    p->batch      = 0;
+    p->slice_len  = 1;
+    p->num_slices = 0;
+    p->next       = 0;
+    p->num_done   = 0;
+    p->stop       = 0;
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->cv_work, NULL);
+    pthread_cond_init(&p->cv_done, NULL);
+
+    // the calling thread evaluates slices as well
+    p->threads = (pthread_t*) liquid_malloc((_g->num_threads-1)*sizeof(pthread_t));
+    unsigned int i;
+    for (i=0; i<_g->num_threads-1; i++) {
+        if (pthread_create(&p->threads[i], NULL, gasearch_pool_worker, p) != 0) {
+            fprintf(stderr,"error: gasearch_set_num_threads(), could not create thread\n");
+            exit(1);
+        }
+    }
+    _g->pool = p;
+}
+
+// stop and join worker threads, freeing pool (if any)
+void gasearch_pool_destroy(gasearch _g)
+{
+    struct gasearch_pool_s * p = _g->pool;
+    if (p == NULL)
+        return;
+
+    pthread_mutex_lock(&p->mutex);
+    p->stop = 1;
+    pthread_cond_broadcast(&p->cv_work);
+    pthread_mutex_unlock(&p->mutex);
+    unsigned int i;
+    for (i=0; i<_g->num_threads-1; i++)
+        pthread_join(p->threads[i], NULL);
+
+    pthread_mutex_destroy(&p->mutex);
+    pthread_cond_destroy(&p->cv_work);
+    pthread_cond_destroy(&p->cv_done);
+    liquid_free(p->threads);
+    liquid_free(p);
+    _g->pool = NULL;
+}
+
+// evaluate remaining slices of current batch (mutex held on entry/exit)
+void gasearch_pool_run_batch(struct gasearch_pool_s * _p)
+{
+    gasearch q = _p->q;
+    while (_p->next < _p->num_slices) {
+        unsigned int i0 = _p->next++ * _p->slice_len;
+        unsigned int i1 = i0 + _p->slice_len;
+        if (i1 > q->population_size)
+            i1 = q->population_size;
+        pthread_mutex_unlock(&_p->mutex);
+
+        gasearch_evaluate_range(q, i0, i1);
+
+        pthread_mutex_lock(&_p->mutex);
+        if (++_p->num_done == _p->num_slices)
+            pthread_cond_signal(&_p->cv_done);
+    }
+}
+
+// worker thread main loop
+void * gasearch_pool_worker(void * _arg)
+{
+    struct gasearch_pool_s * p = (struct gasearch_pool_s*) _arg;
+    unsigned long int batch = 0;
+
+    pthread_mutex_lock(&p->mutex);
+    while (1) {
+        while (p->batch == batch && !p->stop)
+            pthread_cond_wait(&p->cv_work, &p->mutex);
+        if (p->stop)
+            break;
+        batch = p->batch;
+        gasearch_pool_run_batch(p);
+    }
+    pthread_mutex_unlock(&p->mutex);
+    return NULL;
+}
+#endif
@@ -40,6 +40,8 @@ struct gradsearch_s {
     float pnorm;                // L2-norm of gradient estimate
 
     utility_function utility;   // utility function pointer
+    gradient_function gradient; // analytic gradient (optional)
+    utility_function_batch utility_batch; // batched utility (optional)
     void * userdata;            // object to optimize (user data)
     int direction;              // search direction (minimize/maximimze utility)
 };
@@ -56,13 +58,15 @@ gradsearch gradsearch_create(void *           _userdata,
                              utility_function _utility,
                              int              _direction)
 {
-    gradsearch q = (gradsearch) malloc( sizeof(struct gradsearch_s) );
+    gradsearch q = (gradsearch) liquid_malloc( sizeof(struct gradsearch_s) );
 
     // set user-defined properties
     q->userdata       = _userdata;
     q->v              = _v;
     q->num_parameters = _num_parameters;
     q->utility        = _utility;
+    q->gradient       = NULL;
+    q->utility_batch  = NULL;
     q->direction      = _direction;
 
     // set internal properties
@@ -71,7 +75,7 @@ gradsearch gradsearch_create(void *           _userdata,
     q->alpha = q->delta;    // line search step size
 
     // allocate array for gradient estimate
-    q->p = (float*) malloc(q->num_parameters*sizeof(float));
+    q->p = (float*) liquid_malloc(q->num_parameters*sizeof(float));
     q->pnorm = 0.0f;
     q->u = 0.0f;
 
@@ -81,10 +85,10 @@ gradsearch gradsearch_create(void *           _userdata,
 void gradsearch_destroy(gradsearch _q)
 {
     // free gradient estimate array
-    free(_q->p);
+    liquid_free(_q->p);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 // print status
@@ -106,15 +110,44 @@ void gradsearch_print(gradsearch _q)
     printf("}\n");
 }
 
+// set analytic gradient callback (NULL reverts to finite differences)
+void gradsearch_set_gradient(gradsearch        _q,
+                             gradient_function _gradient)
+{
+    _q->gradient = _gradient;
+}
+
+// set batched utility callback for finite-difference gradient points
+void gradsearch_set_utility_batch(gradsearch             _q,
+                                  utility_function_batch _utility)
+{
+    _q->utility_batch = _utility;
+}
+
 float gradsearch_step(gradsearch _q)
 {
     unsigned int i;
 
+    // analytic gradient needs no step size adaptation
+    if (_q->gradient != NULL) {
+        _q->gradient(_q->userdata, _q->v, _q->num_parameters, _q->p);
+        _q->pnorm = gradsearch_norm(_q->p, _q->num_parameters);
+
+        // stationary point: nothing to do
+        if (_q->pnorm == 0.0f) {
+            _q->u = _q->utility(_q->userdata, _q->v, _q->num_parameters);
+            return _q->u;
+        }
+    }
+
     // ensure norm(p) > 0, otherwise increase delta
-    unsigned int n=20;
+    unsigned int n = _q->gradient != NULL ? 0 : 20;
     for (i=0; i<n; i++) {
         // compute gradient
-        gradsearch_gradient(_q->utility, _q->userdata, _q->v, _q->num_parameters, _q->delta, _q->p);
+        if (_q->utility_batch != NULL)
+            gradsearch_gradient_batch(_q->utility_batch, _q->userdata, _q->v, _q->num_parameters, _q->delta, _q->p);
+        else
+            gradsearch_gradient(_q->utility, _q->userdata, _q->v, _q->num_parameters, _q->delta, _q->p);
 
         // normalize gradient vector
         _q->pnorm = gradsearch_norm(_q->p, _q->num_parameters);
@@ -133,7 +166,7 @@ float gradsearch_step(gradsearch _q)
         }
     }
     
-    if (i == n) {
+    if (n > 0 && i == n) {
         fprintf(stderr,"warning: gradsearch_step(), function ill-conditioned\n");
         return _q->utility(_q->userdata, _q->v, _q->num_parameters);
     }
@@ -235,6 +268,44 @@ void gradsearch_gradient(utility_function _utility,
     }
 }
 
+// compute the gradient of a function at a particular point, evaluating
+// all _n+1 points with a single call to the batched utility
+//  _utility    :   user-defined batched function
+//  _userdata   :   user-defined data object
+//  _x          :   operating point, [size: _n x 1]
+//  _n          :   dimensionality of search
+//  _delta      :   step value for which to compute gradient
+//  _gradient   :   resulting gradient
+void gradsearch_gradient_batch(utility_function_batch _utility,
+                               void  *                _userdata,
+                               float *                _x,
+                               unsigned int           _n,
+                               float                  _delta,
+                               float *                _gradient)
+{
+    // evaluation points: operating point followed by one step along
+    // each dimension
+    float * x_prime = (float*) liquid_malloc((_n+1)*_n*sizeof(float));
+    float * u       = (float*) liquid_malloc((_n+1)*sizeof(float));
+
+    unsigned int i;
+    for (i=0; i<=_n; i++) {
+        memmove(&x_prime[i*_n], _x, _n*sizeof(float));
+        if (i > 0)
+            x_prime[i*_n + i-1] += _delta;
+    }
+
+    // evaluate all points at once
+    _utility(_userdata, x_prime, _n, u, _n+1);
+
+    // compute gradient estimate
+    for (i=0; i<_n; i++)
+        _gradient[i] = (u[i+1] - u[0]) / _delta;
+
+    liquid_free(x_prime);
+    liquid_free(u);
+}
+
 // execute line search; loosely solve:
 //
 //    min|max phi(alpha) := f(_x - alpha*_p)
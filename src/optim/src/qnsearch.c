@@ -34,7 +34,7 @@ qnsearch qnsearch_create(void * _userdata,
                          utility_function _u,
                          int _minmax)
 {
-    qnsearch q = (qnsearch) malloc( sizeof(struct qnsearch_s) );
+    qnsearch q = (qnsearch) liquid_malloc( sizeof(struct qnsearch_s) );
 
     // initialize public values
     q->delta = 1e-6f;   //_delta;
@@ -46,16 +46,20 @@ qnsearch qnsearch_create(void * _userdata,
     q->v = _v;
     q->num_parameters = _num_parameters;
     q->get_utility = _u;
+    q->get_gradient = NULL;
+    q->get_utility_batch = NULL;
     q->minimize = ( _minmax == LIQUID_OPTIM_MINIMIZE ) ? 1 : 0;
 
     // initialize internal memory arrays
-    q->B        = (float*) calloc( q->num_parameters*q->num_parameters, sizeof(float));
-    q->H        = (float*) calloc( q->num_parameters*q->num_parameters, sizeof(float));
-    q->p        = (float*) calloc( q->num_parameters, sizeof(float) );
-    q->gradient = (float*) calloc( q->num_parameters, sizeof(float) );
-    q->gradient0= (float*) calloc( q->num_parameters, sizeof(float) );
-    q->v_prime  = (float*) calloc( q->num_parameters, sizeof(float) );
-    q->dv       = (float*) calloc( q->num_parameters, sizeof(float) );
+    q->B        = (float*) liquid_calloc( q->num_parameters*q->num_parameters, sizeof(float));
+    q->H        = (float*) liquid_calloc( q->num_parameters*q->num_parameters, sizeof(float));
+    q->p        = (float*) liquid_calloc( q->num_parameters, sizeof(float) );
+    q->gradient = (float*) liquid_calloc( q->num_parameters, sizeof(float) );
+    q->gradient0= (float*) liquid_calloc( q->num_parameters, sizeof(float) );
+    q->v_prime  = (float*) liquid_calloc( q->num_parameters, sizeof(float) );
+    q->dv       = (float*) liquid_calloc( q->num_parameters, sizeof(float) );
+    q->v_batch  = NULL;
+    q->u_batch  = NULL;
     q->utility = q->get_utility(q->userdata, q->v, q->num_parameters);
 
     qnsearch_reset(q);
@@ -65,15 +69,17 @@ qnsearch qnsearch_create(void * _userdata,
 
 void qnsearch_destroy(qnsearch _q)
 {
-    free(_q->B);
-    free(_q->H);
-
-    free(_q->p);
-    free(_q->gradient);
-    free(_q->gradient0);
-    free(_q->v_prime);
-    free(_q->dv);
-    free(_q);
+    liquid_free(_q->B);
+    liquid_free(_q->H);
+
+    liquid_free(_q->p);
+    liquid_free(_q->gradient);
+    liquid_free(_q->gradient0);
+    liquid_free(_q->v_prime);
+    liquid_free(_q->dv);
+    liquid_free(_q->v_batch);
+    liquid_free(_q->u_batch);
+    liquid_free(_q);
 }
 
 void qnsearch_print(qnsearch _q)
@@ -85,6 +91,30 @@ void qnsearch_print(qnsearch _q)
     printf("\n");
 }
 
+// set analytic gradient callback (NULL reverts to finite differences)
+void qnsearch_set_gradient(qnsearch          _q,
+                           gradient_function _gradient)
+{
+    _q->get_gradient = _gradient;
+}
+
+// set batched utility callback for finite-difference gradient and
+// Hessian points
+void qnsearch_set_utility_batch(qnsearch               _q,
+                                utility_function_batch _utility)
+{
+    _q->get_utility_batch = _utility;
+
+    // size buffers for the Hessian estimate, the largest batch: three
+    // points per diagonal and four per off-diagonal element
+    unsigned int n = _q->num_parameters;
+    unsigned int k = 2*n*n + n;
+    if (_q->get_utility_batch != NULL && _q->v_batch == NULL) {
+        _q->v_batch = (float*) liquid_malloc(k*n*sizeof(float));
+        _q->u_batch = (float*) liquid_malloc(k*sizeof(float));
+    }
+}
+
 void qnsearch_reset(qnsearch _q)
 {
     _q->gamma_hat = _q->gamma;
@@ -179,6 +209,24 @@ void qnsearch_compute_gradient(qnsearch _q)
     unsigned int i;
     float f_prime;
 
+    if (_q->get_gradient != NULL) {
+        _q->get_gradient(_q->userdata, _q->v, _q->num_parameters, _q->gradient);
+        return;
+    }
+
+    if (_q->get_utility_batch != NULL) {
+        // evaluate one step along each dimension in a single call
+        unsigned int n = _q->num_parameters;
+        for (i=0; i<n; i++) {
+            memmove(&_q->v_batch[i*n], _q->v, n*sizeof(float));
+            _q->v_batch[i*n + i] += _q->delta;
+        }
+        _q->get_utility_batch(_q->userdata, _q->v_batch, n, _q->u_batch, n);
+        for (i=0; i<n; i++)
+            _q->gradient[i] = (_q->u_batch[i] - _q->utility) / _q->delta;
+        return;
+    }
+
     // reset v_prime
     memmove(_q->v_prime, _q->v, (_q->num_parameters)*sizeof(float));
 
@@ -215,6 +263,11 @@ void qnsearch_compute_Hessian(qnsearch _q)
     float m0, m1;
     float delta = 1e-2f;
 
+    if (_q->get_utility_batch != NULL) {
+        qnsearch_compute_Hessian_batch(_q, delta);
+        return;
+    }
+
     // reset v_prime
     memmove(_q->v_prime, _q->v, (_q->num_parameters)*sizeof(float));
 
@@ -265,10 +318,64 @@ void qnsearch_compute_Hessian(qnsearch _q)
                 matrix_access(_q->H, n, n, i, j) = (m1 - m0) / (2.0f*delta);
                 matrix_access(_q->H, n, n, j, i) = (m1 - m0) / (2.0f*delta);
             }
+
+            // restore operating point
+            _q->v_prime[i] = _q->v[i];
+            _q->v_prime[j] = _q->v[j];
         }
     }
     //matrixf_print(_q->H, n, n);
     //exit(1);
 }
 
+// compute Hessian, evaluating all points with a single call to the
+// batched utility; matches qnsearch_compute_Hessian() point for point
+void qnsearch_compute_Hessian_batch(qnsearch _q,
+                                    float    _delta)
+{
+    unsigned int i, j;
+    unsigned int n = _q->num_parameters;
+    unsigned int k = 0;
+    float * v;
+
+    // three points per diagonal element, four per off-diagonal element
+    for (i=0; i<n; i++) {
+        for (j=0; j<=i; j++) {
+            unsigned int num_points = (i==j) ? 3 : 4;
+            unsigned int m;
+            for (m=0; m<num_points; m++) {
+                v = &_q->v_batch[(k+m)*n];
+                memmove(v, _q->v, n*sizeof(float));
+                if (i==j) {
+                    v[i] += (float)((int)m - 1) * _delta;
+                } else {
+                    v[i] += (m & 2) ? _delta : -_delta;
+                    v[j] += (m & 1) ? _delta : -_delta;
+                }
+            }
+            k += num_points;
+        }
+    }
+
+    // evaluate all points at once
+    _q->get_utility_batch(_q->userdata, _q->v_batch, n, _q->u_batch, k);
 
+    float m0, m1;
+    float * u = _q->u_batch;
+    for (i=0; i<n; i++) {
+        for (j=0; j<=i; j++) {
+            if (i==j) {
+                m0 = (u[1] - u[0]) / _delta;
+                m1 = (u[2] - u[1]) / _delta;
+                matrix_access(_q->H, n, n, i, j) = (m1 - m0) / _delta;
+                u += 3;
+            } else {
+                m0 = (u[1] - u[0]) / (2.0f*_delta);
+                m1 = (u[3] - u[2]) / (2.0f*_delta);
+                matrix_access(_q->H, n, n, i, j) = (m1 - m0) / (2.0f*_delta);
+                matrix_access(_q->H, n, n, j, i) = (m1 - m0) / (2.0f*_delta);
+                u += 4;
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// utility: negative squared distance of traits from 0.3 (maximum at 0.3)
+float gasearch_autotest_utility(void * _userdata, chromosome _c)
+{
+    unsigned int i;
+    float u = 0.0f;
+    for (i=0; i<chromosome_get_num_traits(_c); i++) {
+        float e = chromosome_valuef(_c,i) - 0.3f;
+        u -= e*e;
+    }
+    return u;
+}
+
+// batched utility wrapping the per-chromosome utility above
+void gasearch_autotest_utility_batch(void *       _userdata,
+                                     chromosome * _c,
+                                     float *      _u,
+                                     unsigned int _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _u[i] = gasearch_autotest_utility(_userdata, _c[i]);
+}
+
+// run search with a fixed seed, returning optimum utility and traits
+void gasearch_autotest_run(unsigned int _num_threads,
+                           int          _batch,
+                           float *      _u_opt,
+                           float *      _v_opt)
+{
+    unsigned int num_traits = 4;
+    chromosome prototype = chromosome_create_basic(num_traits, 12);
+    chromosome c_opt     = chromosome_create_basic(num_traits, 12);
+
+    randf_seed(42);
+    gasearch ga = gasearch_create_advanced(gasearch_autotest_utility, NULL,
+                                           prototype, LIQUID_OPTIM_MAXIMIZE,
+                                           24, 0.05f);
+    gasearch_set_num_threads(ga, _num_threads);
+    if (_batch)
+        gasearch_set_utility_batch(ga, gasearch_autotest_utility_batch);
+
+    gasearch_run(ga, 200, 0.0f);
+    gasearch_getopt(ga, c_opt, _u_opt);
+
+    unsigned int i;
+    for (i=0; i<num_traits; i++)
+        _v_opt[i] = chromosome_valuef(c_opt, i);
+
+    gasearch_destroy(ga);
+    chromosome_destroy(prototype);
+    chromosome_destroy(c_opt);
+}
+
+//
+// AUTOTEST: threaded and batched evaluation match serial search exactly
+//
+void autotest_gasearch_threads()
+{
+    float u0, v0[4];
+    float u1, v1[4];
+    float u2, v2[4];
+    float u3, v3[4];
+    gasearch_autotest_run(1, 0, &u0, v0);   // serial, per-chromosome
+    gasearch_autotest_run(4, 0, &u1, v1);   // threaded, per-chromosome
+    gasearch_autotest_run(1, 1, &u2, v2);   // serial, batched
+    gasearch_autotest_run(3, 1, &u3, v3);   // threaded, batched
+
+    if (liquid_autotest_verbose)
+        printf("gasearch: u_opt = %12.8f, %12.8f, %12.8f, %12.8f\n", u0, u1, u2, u3);
+
+    // search should converge near optimum
+    CONTEND_DELTA(u0, 0.0f, 1e-3f);
+
+    CONTEND_EQUALITY(u1, u0);
+    CONTEND_EQUALITY(u2, u0);
+    CONTEND_EQUALITY(u3, u0);
+    CONTEND_SAME_DATA(v1, v0, sizeof(v0));
+    CONTEND_SAME_DATA(v2, v0, sizeof(v0));
+    CONTEND_SAME_DATA(v3, v0, sizeof(v0));
+}
+
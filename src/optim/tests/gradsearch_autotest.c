@@ -158,3 +158,100 @@ void autotest_gradsearch_maxutility()
     CONTEND_DELTA( utility_max_autotest(NULL, v_opt, num_parameters), 1.0f, tol );
 }
 
+
+// analytic gradient of utility_max_autotest()
+void gradient_max_autotest(void *       _userdata,
+                           float *      _v,
+                           unsigned int _n,
+                           float *      _gradient)
+{
+    float u = utility_max_autotest(_userdata, _v, _n);
+    float sigma = 1.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _gradient[i] = -2.0f*(_v[i]-1.0f) / (sigma*sigma) * u;
+        sigma *= 1.5f;
+    }
+}
+
+//
+// AUTOTEST: maximum search using analytic gradient
+//
+void autotest_gradsearch_gradient()
+{
+    float tol = 1e-2f;                  // error tolerance
+    unsigned int num_parameters = 6;    // dimensionality of search (minimum 2)
+    unsigned int num_iterations = 4000; // number of iterations to run
+
+    // initialize vector for optimization
+    float v_opt[num_parameters];
+    unsigned int i;
+    for (i=0; i<num_parameters; i++)
+        v_opt[i] = 0.0f;
+
+    // create gradsearch object with analytic gradient
+    gradsearch gs = gradsearch_create(NULL,
+                                      v_opt,
+                                      num_parameters,
+                                      utility_max_autotest,
+                                      LIQUID_OPTIM_MAXIMIZE);
+    gradsearch_set_gradient(gs, gradient_max_autotest);
+
+    for (i=0; i<num_iterations; i++)
+        gradsearch_step(gs);
+
+    if (liquid_autotest_verbose)
+        gradsearch_print(gs);
+
+    gradsearch_destroy(gs);
+
+    // test results, optimum at [1, 1, 1, ... 1];
+    for (i=0; i<num_parameters; i++)
+        CONTEND_DELTA(v_opt[i], 1.0f, tol);
+}
+
+// batched Rosenbrock utility
+void rosenbrock_batch_autotest(void *       _userdata,
+                               float *      _v,
+                               unsigned int _n,
+                               float *      _u,
+                               unsigned int _k)
+{
+    unsigned int i;
+    for (i=0; i<_k; i++)
+        _u[i] = liquid_rosenbrock(_userdata, &_v[i*_n], _n);
+}
+
+//
+// AUTOTEST: batched gradient evaluation follows serial search exactly
+//
+void autotest_gradsearch_batch()
+{
+    unsigned int num_parameters = 6;    // dimensionality of search
+    unsigned int num_iterations = 400;  // number of iterations to run
+
+    float v0[num_parameters];
+    float v1[num_parameters];
+    unsigned int i;
+    for (i=0; i<num_parameters; i++) {
+        v0[i] = 0.0f;
+        v1[i] = 0.0f;
+    }
+
+    gradsearch gs0 = gradsearch_create(NULL, v0, num_parameters,
+                                       liquid_rosenbrock, LIQUID_OPTIM_MINIMIZE);
+    gradsearch gs1 = gradsearch_create(NULL, v1, num_parameters,
+                                       liquid_rosenbrock, LIQUID_OPTIM_MINIMIZE);
+    gradsearch_set_utility_batch(gs1, rosenbrock_batch_autotest);
+
+    for (i=0; i<num_iterations; i++) {
+        gradsearch_step(gs0);
+        gradsearch_step(gs1);
+    }
+
+    gradsearch_destroy(gs0);
+    gradsearch_destroy(gs1);
+
+    CONTEND_SAME_DATA(v0, v1, sizeof(v0));
+}
+
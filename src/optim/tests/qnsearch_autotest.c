@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// quadratic utility with minimum at [1, 1, 1, ...]
+float qnsearch_utility_autotest(void *       _userdata,
+                                float *      _v,
+                                unsigned int _n)
+{
+    float u = 0.0f;
+    float w = 1.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        u += w*(_v[i]-1.0f)*(_v[i]-1.0f);
+        w *= 1.5f;
+    }
+    return u;
+}
+
+// analytic gradient of qnsearch_utility_autotest()
+void qnsearch_gradient_autotest(void *       _userdata,
+                                float *      _v,
+                                unsigned int _n,
+                                float *      _gradient)
+{
+    float w = 1.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _gradient[i] = 2.0f*w*(_v[i]-1.0f);
+        w *= 1.5f;
+    }
+}
+
+// batched utility
+void qnsearch_utility_batch_autotest(void *       _userdata,
+                                     float *      _v,
+                                     unsigned int _n,
+                                     float *      _u,
+                                     unsigned int _k)
+{
+    unsigned int i;
+    for (i=0; i<_k; i++)
+        _u[i] = qnsearch_utility_autotest(_userdata, &_v[i*_n], _n);
+}
+
+//
+// AUTOTEST: batched evaluation follows serial search exactly
+//
+void autotest_qnsearch_batch()
+{
+    unsigned int num_parameters = 4;    // dimensionality of search
+    unsigned int num_iterations = 100;  // number of iterations to run
+
+    float v0[num_parameters];
+    float v1[num_parameters];
+    unsigned int i;
+    for (i=0; i<num_parameters; i++) {
+        v0[i] = 0.0f;
+        v1[i] = 0.0f;
+    }
+
+    qnsearch q0 = qnsearch_create(NULL, v0, num_parameters,
+                                  qnsearch_utility_autotest, LIQUID_OPTIM_MINIMIZE);
+    qnsearch q1 = qnsearch_create(NULL, v1, num_parameters,
+                                  qnsearch_utility_autotest, LIQUID_OPTIM_MINIMIZE);
+    qnsearch_set_utility_batch(q1, qnsearch_utility_batch_autotest);
+
+    for (i=0; i<num_iterations; i++) {
+        qnsearch_step(q0);
+        qnsearch_step(q1);
+    }
+
+    if (liquid_autotest_verbose) {
+        qnsearch_print(q0);
+        qnsearch_print(q1);
+    }
+
+    qnsearch_destroy(q0);
+    qnsearch_destroy(q1);
+
+    CONTEND_SAME_DATA(v0, v1, sizeof(v0));
+}
+
+//
+// AUTOTEST: search with analytic gradient reduces utility
+//
+void autotest_qnsearch_gradient()
+{
+    unsigned int num_parameters = 4;    // dimensionality of search
+    unsigned int num_iterations = 100;  // number of iterations to run
+
+    float v[num_parameters];
+    unsigned int i;
+    for (i=0; i<num_parameters; i++)
+        v[i] = 0.0f;
+    float u0 = qnsearch_utility_autotest(NULL, v, num_parameters);
+
+    qnsearch q = qnsearch_create(NULL, v, num_parameters,
+                                 qnsearch_utility_autotest, LIQUID_OPTIM_MINIMIZE);
+    qnsearch_set_gradient(q, qnsearch_gradient_autotest);
+
+    for (i=0; i<num_iterations; i++)
+        qnsearch_step(q);
+
+    if (liquid_autotest_verbose)
+        qnsearch_print(q);
+
+    qnsearch_destroy(q);
+
+    float u1 = qnsearch_utility_autotest(NULL, v, num_parameters);
+    CONTEND_LESS_THAN(u1, u0);
+}
+
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <math.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -71,3 +72,41 @@ void benchmark_expand_mulaw(
     *_num_iterations *= 4;
 }
 
+
+// block companding benchmark helper
+void compand_block_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         int                 _alaw,
+                         int                 _expand)
+{
+    unsigned long int i;
+    unsigned int n = 256;
+    float x[n], y[n];
+    for (i=0; i<n; i++)
+        x[i] = 0.9f*sinf(0.1f*i);
+
+    // start trials
+    *_num_iterations /= n/16;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_alaw && _expand) expand_alaw_block   (x, n, 87.6f,  y);
+        else if (_alaw)       compress_alaw_block (x, n, 87.6f,  y);
+        else if (_expand)     expand_mulaw_block  (x, n, 255.0f, y);
+        else                  compress_mulaw_block(x, n, 255.0f, y);
+        x[i%n] += 1e-6f*y[(i+1)%n];
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+}
+
+#define COMPAND_BLOCK_BENCHMARK_API(A,E)    \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ compand_block_bench(_start, _finish, _num_iterations, A, E); }
+
+void benchmark_compress_mulaw_block COMPAND_BLOCK_BENCHMARK_API(0, 0)
+void benchmark_expand_mulaw_block   COMPAND_BLOCK_BENCHMARK_API(0, 1)
+void benchmark_compress_alaw_block  COMPAND_BLOCK_BENCHMARK_API(1, 0)
+void benchmark_expand_alaw_block    COMPAND_BLOCK_BENCHMARK_API(1, 1)
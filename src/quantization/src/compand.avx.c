@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// compand.avx.c : block mu-law/A-law companding kernels (x86 AVX2)
+//
+// Eight samples are processed per iteration with the same logarithm
+// and exponential approximations as the portable kernel in compand.c;
+// results agree to within floating-point rounding. These kernels are
+// compiled with per-function target attributes and are selected at
+// run time.
+//
+
+#include <immintrin.h>
+#include <float.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// natural logarithm approximation for _x >= FLT_MIN (see compand.c)
+__attribute__((target("avx2")))
+static inline __m256 liquid_compand_log8(__m256 _x)
+{
+    __m256  one = _mm256_set1_ps(1.0f);
+    __m256i b   = _mm256_castps_si256(_x);
+    __m256i e   = _mm256_sub_epi32(_mm256_srli_epi32(b, 23), _mm256_set1_epi32(127));
+    __m256  m   = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(b, _mm256_set1_epi32(0x007fffff)),
+                                                      _mm256_set1_epi32(0x3f800000)));
+
+    // reduce mantissa to [sqrt(1/2),sqrt(2))
+    __m256 h = _mm256_cmp_ps(m, _mm256_set1_ps((float)M_SQRT2), _CMP_GT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), h);
+    e = _mm256_sub_epi32(e, _mm256_castps_si256(h));
+
+    __m256 t  = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 p  = _mm256_set1_ps(1.0f/9.0f);
+    p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f/7.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f/5.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f/3.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, t2), one);
+    return _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(e), _mm256_set1_ps((float)M_LN2)),
+                         _mm256_mul_ps(_mm256_add_ps(t, t), p));
+}
+
+// exponential approximation for _x in [-87,87] (see compand.c)
+__attribute__((target("avx2")))
+static inline __m256 liquid_compand_exp8(__m256 _x)
+{
+    _x = _mm256_min_ps(_x, _mm256_set1_ps( 87.0f));
+    _x = _mm256_max_ps(_x, _mm256_set1_ps(-87.0f));
+    __m256 k = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(_x, _mm256_set1_ps((float)M_LOG2E)),
+                                             _mm256_set1_ps(0.5f)));
+    __m256 r = _mm256_sub_ps(_x, _mm256_mul_ps(k, _mm256_set1_ps((float)M_LN2)));
+    __m256 p = _mm256_set1_ps(1.0f/5040.0f);
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f/720.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f/120.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f/24.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f/6.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(0.5f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f));
+    __m256i s = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(k), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(s));
+}
+
+// compress or expand block of samples (see liquid.internal.h)
+__attribute__((target("avx2")))
+void liquid_compand_block_avx2(const struct liquid_compand_s * _c,
+                               const float *                   _x,
+                               unsigned int                    _n,
+                               float *                         _y)
+{
+    if (_c->ctype != LIQUID_COMPANDER_MULAW && _c->ctype != LIQUID_COMPANDER_ALAW) {
+        liquid_compand_block_kernel(_c, _x, _n, _y);
+        return;
+    }
+
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 one  = _mm256_set1_ps(1.0f);
+    __m256 tiny = _mm256_set1_ps(FLT_MIN);
+    __m256 g0   = _mm256_set1_ps(_c->g0);
+    __m256 g1   = _mm256_set1_ps(_c->g1);
+    __m256 g2   = _mm256_set1_ps(_c->g2);
+    __m256 t    = _mm256_set1_ps(_c->t);
+    int mulaw   = _c->ctype == LIQUID_COMPANDER_MULAW;
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 x = _mm256_loadu_ps(&_x[i]);
+        __m256 v = _mm256_andnot_ps(sign, x);
+        __m256 u = _mm256_mul_ps(g0, v);
+        __m256 y;
+        if (mulaw && !_c->expand) {
+            y = _mm256_mul_ps(g1, liquid_compand_log8(_mm256_add_ps(one, u)));
+        } else if (mulaw) {
+            y = _mm256_mul_ps(g1, _mm256_sub_ps(liquid_compand_exp8(u), one));
+        } else if (!_c->expand) {
+            y = _mm256_mul_ps(g1, _mm256_add_ps(one, liquid_compand_log8(_mm256_max_ps(tiny, u))));
+            y = _mm256_blendv_ps(y, _mm256_mul_ps(g2, v), _mm256_cmp_ps(v, t, _CMP_LT_OQ));
+        } else {
+            y = _mm256_mul_ps(g1, liquid_compand_exp8(_mm256_sub_ps(u, one)));
+            y = _mm256_blendv_ps(y, _mm256_mul_ps(g2, v), _mm256_cmp_ps(v, t, _CMP_LT_OQ));
+        }
+
+        // restore sign of input
+        _mm256_storeu_ps(&_y[i], _mm256_or_ps(y, _mm256_and_ps(sign, x)));
+    }
+
+    // scalar tail
+    liquid_compand_block_kernel(_c, _x+i, _n-i, _y+i);
+}
@@ -26,6 +26,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <float.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -78,15 +81,245 @@ void expand_cf_mulaw(float complex _y, float _mu, float complex * _x)
     *_x = cexpf(_Complex_I*cargf(_y)) * (1/_mu)*( powf(1+_mu,cabsf(_y)) - 1);
 }
 
-/*
 float compress_alaw(float _x, float _a)
 {
+#ifdef LIQUID_VALIDATE_INPUT
+    if ( _a < 1.0f ) {
+        printf("error: compress_alaw(), a out of range\n");
+        exit(1);
+    }
+#endif
+    float v = fabsf(_x);
+    float y = v < 1/_a ? _a*v / (1 + logf(_a)) :
+                         (1 + logf(_a*v)) / (1 + logf(_a));
+    return copysignf(y, _x);
+}
+
+float expand_alaw(float _y, float _a)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if ( _a < 1.0f ) {
+        printf("error: expand_alaw(), a out of range\n");
+        exit(1);
+    }
+#endif
+    float v = fabsf(_y);
+    float c = 1 + logf(_a);
+    float x = v < 1/c ? v*c / _a :
+                        expf(v*c - 1) / _a;
+    return copysignf(x, _y);
+}
 
+// compress block of samples using mu-law (see liquid.h)
+void compress_mulaw_block(const float * _x,
+                          unsigned int  _n,
+                          float         _mu,
+                          float *       _y)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if ( _mu <= 0.0f ) {
+        printf("error: compress_mulaw_block(), mu out of range\n");
+        exit(1);
+    }
+#endif
+    liquid_compand_block(LIQUID_COMPANDER_MULAW, 0, _mu, _x, _n, _y);
 }
 
-float expand_alaw(float _x, float _a)
+// expand block of samples using mu-law (see liquid.h)
+void expand_mulaw_block(const float * _y,
+                        unsigned int  _n,
+                        float         _mu,
+                        float *       _x)
 {
+#ifdef LIQUID_VALIDATE_INPUT
+    if ( _mu <= 0.0f ) {
+        printf("error: expand_mulaw_block(), mu out of range\n");
+        exit(1);
+    }
+#endif
+    liquid_compand_block(LIQUID_COMPANDER_MULAW, 1, _mu, _y, _n, _x);
+}
 
+// compress block of samples using A-law (see liquid.h)
+void compress_alaw_block(const float * _x,
+                         unsigned int  _n,
+                         float         _a,
+                         float *       _y)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if ( _a < 1.0f ) {
+        printf("error: compress_alaw_block(), a out of range\n");
+        exit(1);
+    }
+#endif
+    liquid_compand_block(LIQUID_COMPANDER_ALAW, 0, _a, _x, _n, _y);
 }
-*/
 
+// expand block of samples using A-law (see liquid.h)
+void expand_alaw_block(const float * _y,
+                       unsigned int  _n,
+                       float         _a,
+                       float *       _x)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if ( _a < 1.0f ) {
+        printf("error: expand_alaw_block(), a out of range\n");
+        exit(1);
+    }
+#endif
+    liquid_compand_block(LIQUID_COMPANDER_ALAW, 1, _a, _y, _n, _x);
+}
+
+// 
+// internal methods
+//
+
+// set up constants for block companding kernels
+void liquid_compand_init(struct liquid_compand_s * _c,
+                         liquid_compander_type     _ctype,
+                         int                       _expand,
+                         float                     _p)
+{
+    _c->ctype  = _ctype;
+    _c->expand = _expand;
+    switch (_ctype) {
+    case LIQUID_COMPANDER_MULAW:
+        // compress: ln(1 + mu v) / ln(1 + mu)
+        // expand:   (exp(ln(1 + mu) v) - 1) / mu
+        _c->g0 = _expand ? logf(1 + _p) : _p;
+        _c->g1 = _expand ? 1 / _p       : 1 / logf(1 + _p);
+        _c->t  = 0.0f;
+        _c->g2 = 0.0f;
+        break;
+    case LIQUID_COMPANDER_ALAW:
+        // compress: A v / (1 + ln A)           v <  1/A
+        //           (1 + ln(A v)) / (1 + ln A) v >= 1/A
+        // expand:   v (1 + ln A) / A           v <  1/(1 + ln A)
+        //           exp(v (1 + ln A) - 1) / A  v >= 1/(1 + ln A)
+        _c->g0 = _expand ? 1 + logf(_p)        : _p;
+        _c->g1 = _expand ? 1 / _p              : 1 / (1 + logf(_p));
+        _c->t  = _expand ? 1 / (1 + logf(_p))  : 1 / _p;
+        _c->g2 = _expand ? (1 + logf(_p)) / _p : _p / (1 + logf(_p));
+        break;
+    default:
+        // linear
+        _c->g0 = 1.0f;
+        _c->g1 = 1.0f;
+        _c->t  = 0.0f;
+        _c->g2 = 1.0f;
+    }
+}
+
+// reinterpret float bits as integer and back
+static inline int32_t liquid_compand_f2i(float _x)
+{
+    union { float f; int32_t i; } u = { _x };
+    return u.i;
+}
+static inline float liquid_compand_i2f(int32_t _x)
+{
+    union { int32_t i; float f; } u = { _x };
+    return u.f;
+}
+
+// natural logarithm approximation for _x >= FLT_MIN: _x = 2^e m with
+// m in [sqrt(1/2),sqrt(2)), ln(m) = 2 atanh(t), t = (m-1)/(m+1), |t| < 0.172
+static inline float liquid_compand_logf(float _x)
+{
+    int32_t b = liquid_compand_f2i(_x);
+    int32_t e = ((b >> 23) & 0xff) - 127;
+    float   m = liquid_compand_i2f((b & 0x007fffff) | 0x3f800000);
+    int     h = m > (float)M_SQRT2;
+    m = h ? 0.5f*m : m;
+    e = e + h;
+    float t  = (m - 1.0f) / (m + 1.0f);
+    float t2 = t*t;
+    float p  = 1.0f/9.0f;
+    p = p*t2 + 1.0f/7.0f;
+    p = p*t2 + 1.0f/5.0f;
+    p = p*t2 + 1.0f/3.0f;
+    p = p*t2 + 1.0f;
+    return (float)e*(float)M_LN2 + 2.0f*t*p;
+}
+
+// exponential approximation for _x in [-87,87]: exp(_x) = 2^k exp(r),
+// r = _x - k ln(2) in [-ln(2)/2, ln(2)/2]
+static inline float liquid_compand_expf(float _x)
+{
+    _x = _x >  87.0f ?  87.0f : _x;
+    _x = _x < -87.0f ? -87.0f : _x;
+    float k = floorf(_x*(float)M_LOG2E + 0.5f);
+    float r = _x - k*(float)M_LN2;
+    float p = 1.0f/5040.0f;
+    p = p*r + 1.0f/720.0f;
+    p = p*r + 1.0f/120.0f;
+    p = p*r + 1.0f/24.0f;
+    p = p*r + 1.0f/6.0f;
+    p = p*r + 0.5f;
+    p = p*r + 1.0f;
+    p = p*r + 1.0f;
+    return p * liquid_compand_i2f(((int32_t)k + 127) << 23);
+}
+
+// compress or expand block of samples with constants set up by
+// liquid_compand_init(); the loops are branch free
+void liquid_compand_block_kernel(const struct liquid_compand_s * _c,
+                                 const float *                   _x,
+                                 unsigned int                    _n,
+                                 float *                         _y)
+{
+    unsigned int i;
+    float g0 = _c->g0, g1 = _c->g1, t = _c->t, g2 = _c->g2;
+    if (_c->ctype == LIQUID_COMPANDER_MULAW && !_c->expand) {
+        for (i=0; i<_n; i++) {
+            float v = fabsf(_x[i]);
+            _y[i] = copysignf(g1*liquid_compand_logf(1.0f + g0*v), _x[i]);
+        }
+    } else if (_c->ctype == LIQUID_COMPANDER_MULAW) {
+        for (i=0; i<_n; i++) {
+            float v = fabsf(_x[i]);
+            _y[i] = copysignf(g1*(liquid_compand_expf(g0*v) - 1.0f), _x[i]);
+        }
+    } else if (_c->ctype == LIQUID_COMPANDER_ALAW && !_c->expand) {
+        for (i=0; i<_n; i++) {
+            float v = fabsf(_x[i]);
+            float u = g0*v > FLT_MIN ? g0*v : FLT_MIN;
+            float y = v < t ? g2*v : g1*(1.0f + liquid_compand_logf(u));
+            _y[i] = copysignf(y, _x[i]);
+        }
+    } else if (_c->ctype == LIQUID_COMPANDER_ALAW) {
+        for (i=0; i<_n; i++) {
+            float v = fabsf(_x[i]);
+            float y = v < t ? g2*v : g1*liquid_compand_expf(g0*v - 1.0f);
+            _y[i] = copysignf(y, _x[i]);
+        }
+    } else {
+        if (_x != _y)
+            memmove(_y, _x, _n*sizeof(float));
+    }
+}
+
+// compress (_expand=0) or expand (_expand=1) block of samples
+//  _ctype  :   compander type
+//  _expand :   expand (1) or compress (0)
+//  _p      :   companding parameter (mu or A)
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of samples
+//  _y      :   output samples [size: _n x 1], may equal _x
+void liquid_compand_block(liquid_compander_type _ctype,
+                          int                   _expand,
+                          float                 _p,
+                          const float *         _x,
+                          unsigned int          _n,
+                          float *               _y)
+{
+    struct liquid_compand_s c;
+    liquid_compand_init(&c, _ctype, _expand, _p);
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_AUDIO) == LIQUID_SIMD_AVX2) {
+        liquid_compand_block_avx2(&c, _x, _n, _y);
+        return;
+    }
+#endif
+    liquid_compand_block_kernel(&c, _x, _n, _y);
+}
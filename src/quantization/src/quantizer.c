@@ -23,16 +23,54 @@
 //
 // structured quantizer
 //
+// Samples are normalized by the range, companded, and quantized to
+// num_bits with quantize_adc(); complex samples carry the in-phase
+// code in the upper num_bits and the quadrature code in the lower
+// num_bits of each output. Block methods process samples in chunks
+// using the vectorized companding kernels; the dac of quantizers with
+// up to QUANTIZER_TABLE_MAX_BITS bits is a table look-up.
+//
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
+
+#define QUANTIZER_TABLE_MAX_BITS    (12)    // largest dac look-up table
+#define QUANTIZER_CHUNK             (256)   // real values per block chunk
+
+#if T_COMPLEX
+#   define QUANTIZER_NUM_COMPONENTS (2)
+#else
+#   define QUANTIZER_NUM_COMPONENTS (1)
+#endif
 
 struct QUANTIZER(_s) {
     int ctype;          // compander type
     unsigned int n;     // number of bits
-                        // table?
+    float range;        // maximum absolute input
+    float param;        // companding parameter (mu or A)
+
+    // dac look-up tables [size: 2^n x 1], or NULL
+    float * table;      // normalized output
+    q16_t * table_q16;  // normalized output, Q15
 };
 
+// compress/expand normalized values in place
+void QUANTIZER(_compress)(QUANTIZER() _q, float * _v, unsigned int _n);
+void QUANTIZER(_expand)(QUANTIZER() _q, float * _v, unsigned int _n);
+
+// quantize companded values and pack components into samples
+void QUANTIZER(_pack)(QUANTIZER()    _q,
+                      const float *  _v,
+                      unsigned int   _n,
+                      unsigned int * _sample);
+
+// unpack samples and reconstruct companded values
+void QUANTIZER(_unpack)(QUANTIZER()          _q,
+                        const unsigned int * _sample,
+                        unsigned int         _n,
+                        float *              _v);
+
 // create quantizer object
 //  _ctype      :   compander type (e.g. LIQUID_COMPANDER_LINEAR)
 //  _range      :   maximum absolute input
@@ -45,14 +83,40 @@ QUANTIZER() QUANTIZER(_create)(liquid_compander_type _ctype,
     if (_num_bits == 0) {
         fprintf(stderr,"error: quantizer_create(), must have at least one bit/sample\n");
         exit(1);
+    } else if (_num_bits*QUANTIZER_NUM_COMPONENTS > 32) {
+        fprintf(stderr,"error: quantizer_create(), bits/sample exceeds maximum\n");
+        exit(1);
+    } else if (_range <= 0.0f) {
+        fprintf(stderr,"error: quantizer_create(), range must be greater than zero\n");
+        exit(1);
     }
 
     // create quantizer object
-    QUANTIZER() q = (QUANTIZER()) malloc(sizeof(struct QUANTIZER(_s)));
+    QUANTIZER() q = (QUANTIZER()) liquid_malloc(sizeof(struct QUANTIZER(_s)));
 
     // initialize values
     q->ctype = _ctype;
     q->n     = _num_bits;
+    q->range = _range;
+    switch (q->ctype) {
+    case LIQUID_COMPANDER_MULAW: q->param = 255.0f; break;
+    case LIQUID_COMPANDER_ALAW:  q->param = 87.6f;  break;
+    default:                     q->param = 0.0f;
+    }
+
+    // compute dac tables
+    q->table     = NULL;
+    q->table_q16 = NULL;
+    if (q->n <= QUANTIZER_TABLE_MAX_BITS) {
+        unsigned int i, N = 1 << q->n;
+        q->table     = (float*) liquid_malloc(N*sizeof(float));
+        q->table_q16 = (q16_t*) liquid_malloc(N*sizeof(q16_t));
+        for (i=0; i<N; i++)
+            q->table[i] = quantize_dac(i, q->n);
+        QUANTIZER(_expand)(q, q->table, N);
+        for (i=0; i<N; i++)
+            q->table_q16[i] = q16_float_to_fixed(q->table[i]);
+    }
 
     // return object
     return q;
@@ -60,8 +124,12 @@ QUANTIZER() QUANTIZER(_create)(liquid_compander_type _ctype,
 
 void QUANTIZER(_destroy)(QUANTIZER() _q)
 {
+    // free look-up tables
+    liquid_free(_q->table);
+    liquid_free(_q->table_q16);
+
     // free main object memory
-    free(_q);
+    liquid_free(_q);
 }
 
 void QUANTIZER(_print)(QUANTIZER() _q)
@@ -77,26 +145,206 @@ void QUANTIZER(_print)(QUANTIZER() _q)
         printf("unknown\n");
     }
     printf("  num bits  :   %u\n", _q->n);
+    printf("  range     :   %g\n", _q->range);
 }
 
 void QUANTIZER(_execute_adc)(QUANTIZER() _q,
                              T _x,
                              unsigned int * _sample)
 {
-#if T_COMPLEX
-#else
-#endif
-    *_sample = 0;
+    QUANTIZER(_execute_adc_block)(_q, &_x, 1, _sample);
 }
 
 void QUANTIZER(_execute_dac)(QUANTIZER() _q,
                              unsigned int _sample,
                              T * _x)
 {
+    QUANTIZER(_execute_dac_block)(_q, &_sample, 1, _x);
+}
+
+// quantize block of samples
+//  _q      :   quantizer object
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of samples
+//  _sample :   output samples [size: _n x 1]
+void QUANTIZER(_execute_adc_block)(QUANTIZER()    _q,
+                                   T *            _x,
+                                   unsigned int   _n,
+                                   unsigned int * _sample)
+{
+    const float * x = (const float*) _x;
+    float v[QUANTIZER_CHUNK];
+    float g = 1.0f / _q->range;
+    unsigned int i, k, m;
+    for (k=0; k<QUANTIZER_NUM_COMPONENTS*_n; k+=m) {
+        m = QUANTIZER_NUM_COMPONENTS*_n - k;
+        m = m < QUANTIZER_CHUNK ? m : QUANTIZER_CHUNK;
+        for (i=0; i<m; i++)
+            v[i] = g*x[k+i];
+        QUANTIZER(_compress)(_q, v, m);
+        QUANTIZER(_pack)(_q, v, m, &_sample[k/QUANTIZER_NUM_COMPONENTS]);
+    }
+}
+
+// reconstruct block of samples
+//  _q      :   quantizer object
+//  _sample :   input samples [size: _n x 1]
+//  _n      :   number of samples
+//  _x      :   output samples [size: _n x 1]
+void QUANTIZER(_execute_dac_block)(QUANTIZER()    _q,
+                                   unsigned int * _sample,
+                                   unsigned int   _n,
+                                   T *            _x)
+{
+    float * x = (float*) _x;
+    unsigned int i;
+    if (_q->table != NULL) {
+        unsigned int mask = (1 << _q->n) - 1;
 #if T_COMPLEX
+        for (i=0; i<_n; i++) {
+            x[2*i+0] = _q->range * _q->table[(_sample[i] >> _q->n) & mask];
+            x[2*i+1] = _q->range * _q->table[ _sample[i]           & mask];
+        }
 #else
+        for (i=0; i<_n; i++)
+            x[i] = _q->range * _q->table[_sample[i] & mask];
 #endif
-    *_x = 0.0;
+        return;
+    }
+
+    // no table: unpack, expand and scale in chunks
+    unsigned int k, m;
+    for (k=0; k<QUANTIZER_NUM_COMPONENTS*_n; k+=m) {
+        m = QUANTIZER_NUM_COMPONENTS*_n - k;
+        m = m < QUANTIZER_CHUNK ? m : QUANTIZER_CHUNK;
+        QUANTIZER(_unpack)(_q, &_sample[k/QUANTIZER_NUM_COMPONENTS], m, &x[k]);
+        QUANTIZER(_expand)(_q, &x[k], m);
+        for (i=0; i<m; i++)
+            x[k+i] *= _q->range;
+    }
 }
 
+// quantize block of fixed-point samples, full scale corresponding to
+// the range of the quantizer
+//  _q      :   quantizer object
+//  _x      :   input samples, Q15 [size: _n x 1]
+//  _n      :   number of samples
+//  _sample :   output samples [size: _n x 1]
+void QUANTIZER(_execute_adc_block_q16)(QUANTIZER()    _q,
+                                       TQ *           _x,
+                                       unsigned int   _n,
+                                       unsigned int * _sample)
+{
+    const q16_t * x = (const q16_t*) _x;
+    float v[QUANTIZER_CHUNK];
+    unsigned int i, k, m;
+    for (k=0; k<QUANTIZER_NUM_COMPONENTS*_n; k+=m) {
+        m = QUANTIZER_NUM_COMPONENTS*_n - k;
+        m = m < QUANTIZER_CHUNK ? m : QUANTIZER_CHUNK;
+        for (i=0; i<m; i++)
+            v[i] = (float)x[k+i] * (1.0f/32768.0f);
+        QUANTIZER(_compress)(_q, v, m);
+        QUANTIZER(_pack)(_q, v, m, &_sample[k/QUANTIZER_NUM_COMPONENTS]);
+    }
+}
+
+// reconstruct block of fixed-point samples, full scale corresponding
+// to the range of the quantizer
+//  _q      :   quantizer object
+//  _sample :   input samples [size: _n x 1]
+//  _n      :   number of samples
+//  _x      :   output samples, Q15 [size: _n x 1]
+void QUANTIZER(_execute_dac_block_q16)(QUANTIZER()    _q,
+                                       unsigned int * _sample,
+                                       unsigned int   _n,
+                                       TQ *           _x)
+{
+    q16_t * x = (q16_t*) _x;
+    unsigned int i;
+    if (_q->table_q16 != NULL) {
+        unsigned int mask = (1 << _q->n) - 1;
+#if T_COMPLEX
+        for (i=0; i<_n; i++) {
+            x[2*i+0] = _q->table_q16[(_sample[i] >> _q->n) & mask];
+            x[2*i+1] = _q->table_q16[ _sample[i]           & mask];
+        }
+#else
+        for (i=0; i<_n; i++)
+            x[i] = _q->table_q16[_sample[i] & mask];
+#endif
+        return;
+    }
+
+    // no table: unpack, expand and convert in chunks
+    float v[QUANTIZER_CHUNK];
+    unsigned int k, m;
+    for (k=0; k<QUANTIZER_NUM_COMPONENTS*_n; k+=m) {
+        m = QUANTIZER_NUM_COMPONENTS*_n - k;
+        m = m < QUANTIZER_CHUNK ? m : QUANTIZER_CHUNK;
+        QUANTIZER(_unpack)(_q, &_sample[k/QUANTIZER_NUM_COMPONENTS], m, v);
+        QUANTIZER(_expand)(_q, v, m);
+        for (i=0; i<m; i++)
+            x[k+i] = q16_float_to_fixed(v[i]);
+    }
+}
+
+// 
+// internal methods
+//
+
+// compress normalized values in place
+void QUANTIZER(_compress)(QUANTIZER()  _q,
+                          float *      _v,
+                          unsigned int _n)
+{
+    if (_q->ctype == LIQUID_COMPANDER_MULAW || _q->ctype == LIQUID_COMPANDER_ALAW)
+        liquid_compand_block(_q->ctype, 0, _q->param, _v, _n, _v);
+}
 
+// expand normalized values in place
+void QUANTIZER(_expand)(QUANTIZER()  _q,
+                        float *      _v,
+                        unsigned int _n)
+{
+    if (_q->ctype == LIQUID_COMPANDER_MULAW || _q->ctype == LIQUID_COMPANDER_ALAW)
+        liquid_compand_block(_q->ctype, 1, _q->param, _v, _n, _v);
+}
+
+// quantize companded values and pack components into samples
+//  _v      :   companded values [size: _n x 1]
+//  _n      :   number of values (multiple of the component count)
+//  _sample :   output samples [size: _n/QUANTIZER_NUM_COMPONENTS x 1]
+void QUANTIZER(_pack)(QUANTIZER()    _q,
+                      const float *  _v,
+                      unsigned int   _n,
+                      unsigned int * _sample)
+{
+#if T_COMPLEX
+    unsigned int i;
+    for (i=0; i<_n; i+=2)
+        _sample[i/2] = (quantize_adc(_v[i], _q->n) << _q->n) | quantize_adc(_v[i+1], _q->n);
+#else
+    quantize_adc_block(_v, _n, _q->n, _sample);
+#endif
+}
+
+// unpack samples and reconstruct companded values
+//  _sample :   input samples [size: _n/QUANTIZER_NUM_COMPONENTS x 1]
+//  _n      :   number of values (multiple of the component count)
+//  _v      :   companded values [size: _n x 1]
+void QUANTIZER(_unpack)(QUANTIZER()          _q,
+                        const unsigned int * _sample,
+                        unsigned int         _n,
+                        float *              _v)
+{
+#if T_COMPLEX
+    unsigned int i;
+    unsigned int mask = (1 << _q->n) - 1;
+    for (i=0; i<_n; i+=2) {
+        _v[i+0] = quantize_dac((_sample[i/2] >> _q->n) & mask, _q->n);
+        _v[i+1] = quantize_dac( _sample[i/2]           & mask, _q->n);
+    }
+#else
+    quantize_dac_block(_sample, _n, _q->n, _v);
+#endif
+}
@@ -35,6 +35,31 @@
 
 // inline quantizer: 'analog' signal in [-1, 1]
 
+// quantize single value; _num_bits in [1,QUANTIZER_MAX_BITS]
+static inline unsigned int quantize_adc_one(float _x, unsigned int _num_bits)
+{
+    unsigned int n = _num_bits-1;   // 
+    unsigned int N = 1<<n;          // 2^n
+
+    // scale and clip
+    float r = floorf(fabsf(_x)*(float)N);
+    unsigned int s = r >= (float)N ? N-1 : (unsigned int)r;
+
+    // if negative set MSB to 1
+    return _x < 0 ? s | N : s;
+}
+
+// reconstruct single value; _num_bits in [1,QUANTIZER_MAX_BITS]
+static inline float quantize_dac_one(unsigned int _s, unsigned int _num_bits)
+{
+    unsigned int n = _num_bits-1;   //
+    unsigned int N = 1<<n;          // 2^n
+    float r = ((float)(_s & (N-1))+0.5f) / (float) (N);
+
+    // check MSB, return negative if 1
+    return (_s & N) ? -r : r;
+}
+
 unsigned int quantize_adc(float _x, unsigned int _num_bits)
 {
 #ifdef LIQUID_VALIDATE_INPUT
@@ -47,22 +72,7 @@ unsigned int quantize_adc(float _x, unsigned int _num_bits)
     if (_num_bits == 0)
         return 0;
 
-    unsigned int n = _num_bits-1;   // 
-    unsigned int N = 1<<n;          // 2^n
-
-    // scale
-    int neg = (_x < 0);
-    unsigned int r = floorf(fabsf(_x)*N);
-
-    // clip
-    if (r >= N)
-        r = N-1;
-
-    // if negative set MSB to 1
-    if (neg)
-        r |= N;
-
-    return r;
+    return quantize_adc_one(_x, _num_bits);
 }
 
 float quantize_dac(unsigned int _s, unsigned int _num_bits)
@@ -76,11 +86,51 @@ float quantize_dac(unsigned int _s, unsigned int _num_bits)
     if (_num_bits == 0)
         return 0.0f;
 
-    unsigned int n = _num_bits-1;   //
-    unsigned int N = 1<<n;          // 2^n
-    float r = ((float)(_s & (N-1))+0.5f) / (float) (N);
+    return quantize_dac_one(_s, _num_bits);
+}
 
-    // check MSB, return negative if 1
-    return (_s & N) ? -r : r;
+// quantize block of values (see liquid.h)
+void quantize_adc_block(const float *  _x,
+                        unsigned int   _n,
+                        unsigned int   _num_bits,
+                        unsigned int * _s)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if (_num_bits > QUANTIZER_MAX_BITS) {
+        printf("error: quantize_adc_block(), maximum bits exceeded\n");
+        exit(1);
+    }
+#endif
+    unsigned int i;
+    if (_num_bits == 0) {
+        for (i=0; i<_n; i++)
+            _s[i] = 0;
+        return;
+    }
+
+    for (i=0; i<_n; i++)
+        _s[i] = quantize_adc_one(_x[i], _num_bits);
 }
 
+// reconstruct block of values (see liquid.h)
+void quantize_dac_block(const unsigned int * _s,
+                        unsigned int         _n,
+                        unsigned int         _num_bits,
+                        float *              _x)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if (_num_bits > QUANTIZER_MAX_BITS) {
+        printf("error: quantize_dac_block(), maximum bits exceeded\n");
+        exit(1);
+    }
+#endif
+    unsigned int i;
+    if (_num_bits == 0) {
+        for (i=0; i<_n; i++)
+            _x[i] = 0.0f;
+        return;
+    }
+
+    for (i=0; i<_n; i++)
+        _x[i] = quantize_dac_one(_s[i], _num_bits);
+}
@@ -30,6 +30,7 @@
 #define QUANTIZER(name)     LIQUID_CONCAT(quantizercf,name)
 
 #define T                   float complex   // general
+#define TQ                  cq16_t          // fixed-point
 
 #define T_COMPLEX           1
 
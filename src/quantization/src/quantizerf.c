@@ -30,6 +30,7 @@
 #define QUANTIZER(name)     LIQUID_CONCAT(quantizerf,name)
 
 #define T                   float   // general
+#define TQ                  q16_t   // fixed-point
 
 #define T_COMPLEX           0
 
@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "autotest/autotest.h"
 #include "liquid.internal.h"
 
@@ -78,3 +80,63 @@ void autotest_compand_cfloat() {
     }
 }
 
+
+void autotest_compand_alaw() {
+    float a = 87.6f;
+    float tol = 1e-5f;
+    unsigned int i;
+    for (i=0; i<=40; i++) {
+        float x = -1.0f + 0.05f*i;
+        float y = compress_alaw(x,a);
+        CONTEND_DELTA(x, expand_alaw(y,a), tol);
+    }
+
+    // continuous at the segment boundary, mapped onto [-1,1]
+    CONTEND_DELTA(compress_alaw(1/a - 1e-6f,a), compress_alaw(1/a + 1e-6f,a), 1e-4f);
+    CONTEND_DELTA(compress_alaw( 1.0f,a),  1.0f, 1e-6f);
+    CONTEND_DELTA(compress_alaw(-1.0f,a), -1.0f, 1e-6f);
+}
+
+// check block companding against single-sample methods at every SIMD
+// level available on this host
+void autotest_compand_block() {
+    unsigned int n = 203;   // not a multiple of the vector width
+    float x[n], y[n], z[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = 1.2f*sinf(0.37f*i) * (i % 5 ? 1.0f : 1e-3f);
+    x[0] = 0.0f;
+    x[1] = -0.0f;
+
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        compress_mulaw_block(x, n, 255.0f, y);
+        expand_mulaw_block(y, n, 255.0f, z);
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA(y[i], compress_mulaw(x[i],255.0f), 2e-6f);
+            CONTEND_DELTA(z[i], expand_mulaw(y[i],255.0f),   2e-6f*(1+fabsf(z[i])));
+            CONTEND_DELTA(z[i], x[i],                        1e-5f*(1+fabsf(x[i])));
+        }
+
+        compress_alaw_block(x, n, 87.6f, y);
+        expand_alaw_block(y, n, 87.6f, z);
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA(y[i], compress_alaw(x[i],87.6f), 2e-6f);
+            CONTEND_DELTA(z[i], expand_alaw(y[i],87.6f),   2e-6f*(1+fabsf(z[i])));
+            CONTEND_DELTA(z[i], x[i],                      1e-5f*(1+fabsf(x[i])));
+        }
+
+        // in place
+        memmove(z, x, sizeof(x));
+        compress_mulaw_block(z, n, 255.0f, z);
+        compress_mulaw_block(x, n, 255.0f, y);
+        CONTEND_SAME_DATA(y, z, sizeof(y));
+    }
+    liquid_simd_set_level(host);
+}
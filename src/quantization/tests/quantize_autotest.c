@@ -53,3 +53,69 @@ void autotest_quantize_float_n8() {
     }
 }
 
+
+void autotest_quantize_block() {
+    unsigned int n = 100;
+    float x[n], x_hat[n];
+    unsigned int s[n], i;
+    for (i=0; i<n; i++)
+        x[i] = 1.1f*sinf(0.21f*i);
+    quantize_adc_block(x, n, 8, s);
+    quantize_dac_block(s, n, 8, x_hat);
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(s[i], quantize_adc(x[i],8));
+        CONTEND_EQUALITY(x_hat[i], quantize_dac(s[i],8));
+    }
+}
+
+// quantizer objects: single-sample, block and fixed-point methods
+void quantizer_test(liquid_compander_type _ctype, unsigned int _num_bits)
+{
+    unsigned int n = 300;
+    float range = 2.0f;
+    float tol = range * (_ctype == LIQUID_COMPANDER_LINEAR ? 1.0f : 8.0f) / (float)(1<<_num_bits);
+    unsigned int i;
+
+    quantizerf  qf = quantizerf_create (_ctype, range, _num_bits);
+    quantizercf qc = quantizercf_create(_ctype, range, _num_bits);
+
+    float         x[n], y[n];
+    float complex xc[n], yc[n];
+    q16_t         xq[n], yq[n];
+    unsigned int  s[n], sc[n], sq[n], v;
+    for (i=0; i<n; i++) {
+        x[i]  = 0.95f*range*sinf(0.13f*i);
+        xc[i] = x[i] + _Complex_I*0.95f*range*cosf(0.29f*i);
+        xq[i] = q16_float_to_fixed(x[i] / range);
+    }
+
+    quantizerf_execute_adc_block(qf, x, n, s);
+    quantizerf_execute_dac_block(qf, s, n, y);
+    quantizercf_execute_adc_block(qc, xc, n, sc);
+    quantizercf_execute_dac_block(qc, sc, n, yc);
+    quantizerf_execute_adc_block_q16(qf, xq, n, sq);
+    quantizerf_execute_dac_block_q16(qf, sq, n, yq);
+    for (i=0; i<n; i++) {
+        // block agrees with single-sample methods
+        quantizerf_execute_adc(qf, x[i], &v);
+        CONTEND_EQUALITY(s[i], v);
+        float yi;
+        quantizerf_execute_dac(qf, s[i], &yi);
+        CONTEND_EQUALITY(y[i], yi);
+
+        // reconstruction error
+        CONTEND_LESS_THAN(s[i] >> _num_bits, 1);
+        CONTEND_DELTA(y[i], x[i], tol);
+        CONTEND_DELTA(crealf(yc[i]), crealf(xc[i]), tol);
+        CONTEND_DELTA(cimagf(yc[i]), cimagf(xc[i]), tol);
+        CONTEND_DELTA((float)yq[i]/32768.0f*range, x[i], tol + 1e-4f);
+    }
+
+    quantizerf_destroy(qf);
+    quantizercf_destroy(qc);
+}
+
+void autotest_quantizer_linear_n8()  { quantizer_test(LIQUID_COMPANDER_LINEAR,  8); }
+void autotest_quantizer_mulaw_n8()   { quantizer_test(LIQUID_COMPANDER_MULAW,   8); }
+void autotest_quantizer_alaw_n8()    { quantizer_test(LIQUID_COMPANDER_ALAW,    8); }
+void autotest_quantizer_mulaw_n14()  { quantizer_test(LIQUID_COMPANDER_MULAW,  14); }
@@ -73,6 +73,30 @@ void benchmark_random_normal(struct rusage *_start,
     *_num_iterations *= 4;
 }
 
+// 
+// BENCHMARK: normal (block, reentrant generator)
+//
+void benchmark_random_normal_block(struct rusage *_start,
+                                   struct rusage *_finish,
+                                   unsigned long int *_num_iterations)
+{
+    // normalize number of iterations
+    *_num_iterations /= 64;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    float x[256];
+    uint64_t state;
+    randf_seed_r(&state, 0);
+    unsigned long int i;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        randnf_block_r(&state, x, 256);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 256;
+}
+
 // 
 // BENCHMARK: complex normal
 //
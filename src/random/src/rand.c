@@ -30,9 +30,93 @@
 
 #include "liquid.internal.h"
 
-// uniform random number generator
+// calling thread's generator state; threads which never call
+// randf_seed() are seeded in order of first use (0, 1, 2, ...)
+static LIQUID_THREAD_LOCAL uint64_t liquid_rand_tls_state  = 0;
+static LIQUID_THREAD_LOCAL int      liquid_rand_tls_seeded = 0;
+static unsigned int                 liquid_rand_num_threads = 0;
+
+// get calling thread's generator state, seeding it on first use
+uint64_t * liquid_rand_state(void)
+{
+    if (!liquid_rand_tls_seeded) {
+        unsigned int id = __atomic_fetch_add(&liquid_rand_num_threads, 1, __ATOMIC_RELAXED);
+        randf_seed_r(&liquid_rand_tls_state, id);
+        liquid_rand_tls_seeded = 1;
+    }
+    return &liquid_rand_tls_state;
+}
+
+// seed calling thread's generator
+//  _seed   :   seed value
+void randf_seed(uint64_t _seed)
+{
+    randf_seed_r(&liquid_rand_tls_state, _seed);
+    liquid_rand_tls_seeded = 1;
+}
+
+// uniform random number generator, (0,1], drawing from the calling
+// thread's generator
 float randf() {
-    return randf_inline();
+    return randf_r(liquid_rand_state());
+}
+
+// reentrant 64-bit random word; xorshift64* generator with state held
+// by the caller so that independent streams (e.g. one per thread) can be
+// run without sharing rand()
+//  _state  :   generator state, updated in place
+uint64_t randu64_r(uint64_t * _state)
+{
+    // a zero state is a fixed point of xorshift; remap it
+    uint64_t x = (*_state != 0) ? *_state : 0x9e3779b97f4a7c15ULL;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *_state = x;
+
+    // scramble output
+    return x * 0x2545f4914f6cdd1dULL;
+}
+
+// reentrant block of 64-bit random words; equivalent to calling
+// randu64_r() _n times, with the state kept in a register
+//  _state  :   generator state, updated in place
+//  _y      :   output array [size: _n x 1]
+//  _n      :   number of words
+void randu64_block_r(uint64_t *   _state,
+                     uint64_t *   _y,
+                     unsigned int _n)
+{
+    uint64_t x = (*_state != 0) ? *_state : 0x9e3779b97f4a7c15ULL;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        x ^= x >> 12;
+        x ^= x << 25;
+        x ^= x >> 27;
+        _y[i] = x * 0x2545f4914f6cdd1dULL;
+    }
+    *_state = x;
+}
+
+// reentrant uniform random number generator, (0,1]
+//  _state  :   generator state, updated in place
+float randf_r(uint64_t * _state)
+{
+    // top 24 bits of random word, offset to exclude zero
+    return (float)((randu64_r(_state) >> 40) + 1) * (1.0f / 16777216.0f);
+}
+
+// seed reentrant generator state; nearby seeds (e.g. 0,1,2,...) are
+// scrambled (splitmix64) so their streams are uncorrelated
+//  _state  :   generator state
+//  _seed   :   seed value
+void randf_seed_r(uint64_t * _state,
+                  uint64_t   _seed)
+{
+    uint64_t z = _seed + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    *_state = z ^ (z >> 31);
 }
 
 // uniform random number probability distribution function
@@ -47,6 +47,225 @@ float randnf()
     //return sqrtf(-2*logf(u1)) * cosf(2*M_PI*u2);
 }
 
+// map pairs of uniform variates in (0,1] to pairs of Gauss variates
+// (Box-Muller, using both the sine and cosine outputs)
+//  _y  :   uniform input, Gauss output [size: 2*_n x 1]
+//  _n  :   number of pairs
+static void randnf_boxmuller(float *      _y,
+                             unsigned int _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float r     = sqrtf(-2.0f*logf(_y[2*i]));
+        float theta = 2.0f*M_PI*_y[2*i+1];
+        _y[2*i  ] = r * cosf(theta);
+        _y[2*i+1] = r * sinf(theta);
+    }
+}
+
+// Gauss block: generate uniform pairs first, then transform them in a
+// single pass, yielding two variates per logarithm
+//  _y  :   output array [size: _n x 1]
+//  _n  :   number of samples
+void randnf_block(float *      _y,
+                  unsigned int _n)
+{
+    unsigned int i;
+    for (i=0; i<2*(_n/2); i+=2) {
+        // ensure u1 does not equal zero
+        do {
+            _y[i] = randf();
+        } while (_y[i] == 0.0f);
+        _y[i+1] = randf();
+    }
+    randnf_boxmuller(_y, _n/2);
+
+    if (_n % 2)
+        _y[_n-1] = randnf();
+}
+
+// Ziggurat tables (Marsaglia & Tsang, 128 layers, tail at r=3.4426):
+// for layer i, k[i] is the 31-bit acceptance threshold for the fast
+// path (about 99% of samples: one comparison, one multiply), w[i]
+// scales a 31-bit integer to abscissa, and f[i] is the (unnormalized)
+// density at the layer edge
+#define RANDNF_ZIG_R (3.442619855899f)
+
+static const uint32_t randnf_zig_k[128] = {
+    1991057938u,          0u, 1611602771u, 1826899878u, 1918584482u, 1969227037u,
+    2001281515u, 2023368125u, 2039498179u, 2051788381u, 2061460127u, 2069267110u,
+    2075699398u, 2081089314u, 2085670119u, 2089610331u, 2093034710u, 2096037586u,
+    2098691595u, 2101053571u, 2103168620u, 2105072996u, 2106796166u, 2108362327u,
+    2109791536u, 2111100552u, 2112303493u, 2113412330u, 2114437283u, 2115387130u,
+    2116269447u, 2117090813u, 2117856962u, 2118572919u, 2119243101u, 2119871411u,
+    2120461303u, 2121015852u, 2121537798u, 2122029592u, 2122493434u, 2122931299u,
+    2123344971u, 2123736059u, 2124106020u, 2124456175u, 2124787725u, 2125101763u,
+    2125399283u, 2125681194u, 2125948325u, 2126201433u, 2126441213u, 2126668298u,
+    2126883268u, 2127086657u, 2127278949u, 2127460589u, 2127631985u, 2127793506u,
+    2127945490u, 2128088244u, 2128222044u, 2128347141u, 2128463758u, 2128572095u,
+    2128672327u, 2128764606u, 2128849065u, 2128925811u, 2128994934u, 2129056501u,
+    2129110560u, 2129157136u, 2129196237u, 2129227847u, 2129251929u, 2129268426u,
+    2129277255u, 2129278312u, 2129271467u, 2129256561u, 2129233410u, 2129201800u,
+    2129161480u, 2129112170u, 2129053545u, 2128985244u, 2128906855u, 2128817916u,
+    2128717911u, 2128606255u, 2128482298u, 2128345305u, 2128194452u, 2128028813u,
+    2127847342u, 2127648860u, 2127432031u, 2127195339u, 2126937058u, 2126655214u,
+    2126347546u, 2126011445u, 2125643893u, 2125241376u, 2124799783u, 2124314271u,
+    2123779094u, 2123187386u, 2122530867u, 2121799464u, 2120980787u, 2120059418u,
+    2119015917u, 2117825402u, 2116455471u, 2114863093u, 2112989789u, 2110753906u,
+    2108037662u, 2104664315u, 2100355223u, 2094642347u, 2086670106u, 2074676188u,
+    2054300022u, 2010539237u
+};
+
+static const float randnf_zig_w[128] = {
+    1.72904052e-09, 1.26809284e-10, 1.68975178e-10, 1.98626884e-10,
+    2.22324318e-10, 2.42449361e-10, 2.60161319e-10, 2.76119887e-10,
+    2.90739628e-10, 3.04299704e-10, 3.16997952e-10, 3.28980205e-10,
+    3.40357381e-10, 3.51216022e-10, 3.61625100e-10, 3.71640576e-10,
+    3.81308564e-10, 3.90667568e-10, 3.99750119e-10, 4.08583986e-10,
+    4.17193096e-10, 4.25598235e-10, 4.33817597e-10, 4.41867218e-10,
+    4.49761320e-10, 4.57512589e-10, 4.65132405e-10, 4.72631024e-10,
+    4.80017735e-10, 4.87300987e-10, 4.94488498e-10, 5.01587347e-10,
+    5.08604048e-10, 5.15544623e-10, 5.22414652e-10, 5.29219328e-10,
+    5.35963495e-10, 5.42651692e-10, 5.49288180e-10, 5.55876972e-10,
+    5.62421861e-10, 5.68926442e-10, 5.75394129e-10, 5.81828179e-10,
+    5.88231702e-10, 5.94607682e-10, 6.00958984e-10, 6.07288373e-10,
+    6.13598518e-10, 6.19892008e-10, 6.26171358e-10, 6.32439020e-10,
+    6.38697391e-10, 6.44948817e-10, 6.51195605e-10, 6.57440029e-10,
+    6.63684334e-10, 6.69930743e-10, 6.76181467e-10, 6.82438704e-10,
+    6.88704651e-10, 6.94981508e-10, 7.01271480e-10, 7.07576789e-10,
+    7.13899675e-10, 7.20242402e-10, 7.26607266e-10, 7.32996602e-10,
+    7.39412785e-10, 7.45858243e-10, 7.52335459e-10, 7.58846979e-10,
+    7.65395424e-10, 7.71983490e-10, 7.78613963e-10, 7.85289727e-10,
+    7.92013769e-10, 7.98789198e-10, 8.05619248e-10, 8.12507294e-10,
+    8.19456868e-10, 8.26471669e-10, 8.33555582e-10, 8.40712695e-10,
+    8.47947317e-10, 8.55264003e-10, 8.62667575e-10, 8.70163152e-10,
+    8.77756176e-10, 8.85452448e-10, 8.93258164e-10, 9.01179960e-10,
+    9.09224958e-10, 9.17400821e-10, 9.25715814e-10, 9.34178880e-10,
+    9.42799716e-10, 9.51588869e-10, 9.60557849e-10, 9.69719253e-10,
+    9.79086913e-10, 9.88676077e-10, 9.98503613e-10, 1.00858826e-09,
+    1.01895092e-09, 1.02961502e-09, 1.04060694e-09, 1.05195659e-09,
+    1.06369800e-09, 1.07587021e-09, 1.08851830e-09, 1.10169471e-09,
+    1.11546101e-09, 1.12989016e-09, 1.14506957e-09, 1.16110524e-09,
+    1.17812756e-09, 1.19629951e-09, 1.21582870e-09, 1.23698563e-09,
+    1.26013233e-09, 1.28576968e-09, 1.31462018e-09, 1.34778396e-09,
+    1.38706353e-09, 1.43574032e-09, 1.50086590e-09, 1.60309479e-09
+};
+
+static const float randnf_zig_f[128] = {
+    1.00000000e+00, 9.63599693e-01, 9.36282682e-01, 9.13043648e-01,
+    8.92281651e-01, 8.73243049e-01, 8.55500608e-01, 8.38783605e-01,
+    8.22907211e-01, 8.07738295e-01, 7.93177012e-01, 7.79146086e-01,
+    7.65584174e-01, 7.52441559e-01, 7.39677244e-01, 7.27256918e-01,
+    7.15151507e-01, 7.03336099e-01, 6.91789143e-01, 6.80491841e-01,
+    6.69427667e-01, 6.58582000e-01, 6.47941821e-01, 6.37495477e-01,
+    6.27232485e-01, 6.17143371e-01, 6.07219537e-01, 5.97453151e-01,
+    5.87837054e-01, 5.78364681e-01, 5.69029991e-01, 5.59827413e-01,
+    5.50751793e-01, 5.41798355e-01, 5.32962659e-01, 5.24240573e-01,
+    5.15628238e-01, 5.07122051e-01, 4.98718635e-01, 4.90414825e-01,
+    4.82207646e-01, 4.74094301e-01, 4.66072153e-01, 4.58138716e-01,
+    4.50291644e-01, 4.42528715e-01, 4.34847830e-01, 4.27246998e-01,
+    4.19724332e-01, 4.12278040e-01, 4.04906421e-01, 3.97607856e-01,
+    3.90380808e-01, 3.83223811e-01, 3.76135470e-01, 3.69114454e-01,
+    3.62159495e-01, 3.55269385e-01, 3.48442968e-01, 3.41679141e-01,
+    3.34976853e-01, 3.28335098e-01, 3.21752916e-01, 3.15229388e-01,
+    3.08763638e-01, 3.02354828e-01, 2.96002157e-01, 2.89704860e-01,
+    2.83462208e-01, 2.77273503e-01, 2.71138079e-01, 2.65055302e-01,
+    2.59024567e-01, 2.53045299e-01, 2.47116948e-01, 2.41238994e-01,
+    2.35410942e-01, 2.29632325e-01, 2.23902699e-01, 2.18221647e-01,
+    2.12588773e-01, 2.07003709e-01, 2.01466110e-01, 1.95975653e-01,
+    1.90532040e-01, 1.85134997e-01, 1.79784272e-01, 1.74479638e-01,
+    1.69220892e-01, 1.64007855e-01, 1.58840371e-01, 1.53718312e-01,
+    1.48641574e-01, 1.43610080e-01, 1.38623780e-01, 1.33682653e-01,
+    1.28786706e-01, 1.23935980e-01, 1.19130547e-01, 1.14370512e-01,
+    1.09656021e-01, 1.04987255e-01, 1.00364441e-01, 9.57878491e-02,
+    9.12578008e-02, 8.67746719e-02, 8.23388982e-02, 7.79509825e-02,
+    7.36115019e-02, 6.93211174e-02, 6.50805852e-02, 6.08907703e-02,
+    5.67526635e-02, 5.26674019e-02, 4.86362959e-02, 4.46608622e-02,
+    4.07428681e-02, 3.68843888e-02, 3.30878861e-02, 2.93563174e-02,
+    2.56932919e-02, 2.21033046e-02, 1.85921027e-02, 1.51672980e-02,
+    1.18394787e-02, 8.62448441e-03, 5.54899522e-03, 2.66962908e-03
+};
+
+// Ziggurat: map 64-bit random word to Gauss variate, drawing further
+// values from the generator only when the fast path rejects
+//  _state  :   generator state (see randf_r())
+//  _u      :   random word
+static float randnf_zig(uint64_t * _state,
+                        uint64_t   _u)
+{
+    while (1) {
+        // layer index from low bits; signed 32-bit abscissa from high bits
+        unsigned int i = (unsigned int)(_u & 0x7f);
+        int32_t      h = (int32_t)(_u >> 32);
+        uint32_t     a = h < 0 ? -(uint32_t)h : (uint32_t)h;
+        float        x = (float)h * randnf_zig_w[i];
+
+        // fast path: sample lies entirely within rectangle
+        if (a < randnf_zig_k[i])
+            return x;
+
+        if (i == 0) {
+            // base layer: sample from tail beyond r
+            float xt, yt;
+            do {
+                xt = -logf(randf_r(_state)) / RANDNF_ZIG_R;
+                yt = -logf(randf_r(_state));
+            } while (2.0f*yt < xt*xt);
+            return h < 0 ? -RANDNF_ZIG_R - xt : RANDNF_ZIG_R + xt;
+        }
+
+        // wedge: accept if point lies under density
+        float f0 = randnf_zig_f[i];
+        float f1 = randnf_zig_f[i-1];
+        if (f0 + randf_r(_state)*(f1 - f0) < expf(-0.5f*x*x))
+            return x;
+
+        // reject; try again with new word
+        _u = randu64_r(_state);
+    }
+}
+
+// reentrant Gauss random variate, N(0,1), using the Ziggurat method
+//  _state  :   generator state (see randf_r())
+float randnf_r(uint64_t * _state)
+{
+    return randnf_zig(_state, randu64_r(_state));
+}
+
+// reentrant Gauss block (Ziggurat): random words are generated in
+// chunks and mapped with the branch-free fast path; the few samples
+// which fall outside their rectangle are then redone individually
+//  _state  :   generator state (see randf_r())
+//  _y      :   output array [size: _n x 1]
+//  _n      :   number of samples
+void randnf_block_r(uint64_t *   _state,
+                    float *      _y,
+                    unsigned int _n)
+{
+    uint64_t     u[64];
+    unsigned int reject[64];
+    unsigned int i, k;
+    for (i=0; i<_n; i+=64) {
+        unsigned int num = _n - i < 64 ? _n - i : 64;
+        randu64_block_r(_state, u, num);
+
+        // fast path, recording rejected indices without branching
+        unsigned int num_reject = 0;
+        for (k=0; k<num; k++) {
+            unsigned int l = (unsigned int)(u[k] & 0x7f);
+            int32_t      h = (int32_t)(u[k] >> 32);
+            uint32_t     a = h < 0 ? -(uint32_t)h : (uint32_t)h;
+            _y[i+k] = (float)h * randnf_zig_w[l];
+            reject[num_reject] = k;
+            num_reject += a >= randnf_zig_k[l];
+        }
+
+        // redo rejected samples (about 1%)
+        for (k=0; k<num_reject; k++)
+            _y[i+reject[k]] = randnf_zig(_state, u[reject[k]]);
+    }
+}
+
 void awgn(float *_x, float _nstd)
 {
     *_x += randnf()*_nstd;
@@ -81,6 +300,27 @@ void cawgn(float complex *_x, float _nstd)
     *_x += icrandnf()*_nstd*0.707106781186547f;
 }
 
+// complex Gauss block; real and imaginary parts are each N(0,1), as
+// with crandnf()
+//  _y  :   output array [size: _n x 1]
+//  _n  :   number of samples
+void crandnf_block(float complex * _y,
+                   unsigned int    _n)
+{
+    randnf_block((float*)_y, 2*_n);
+}
+
+// reentrant complex Gauss block
+//  _state  :   generator state (see randf_r())
+//  _y      :   output array [size: _n x 1]
+//  _n      :   number of samples
+void crandnf_block_r(uint64_t *      _state,
+                     float complex * _y,
+                     unsigned int    _n)
+{
+    randnf_block_r(_state, (float*)_y, 2*_n);
+}
+
 // Gauss random number probability distribution function
 float randnf_pdf(float _x,
                  float _eta,
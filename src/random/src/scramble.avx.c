@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// scramble.avx.c : data scrambler keystream kernel (x86 AVX2)
+//
+// The 32-byte keystream period fills one register exactly, so each
+// iteration xors 64 bytes of data with the same key register. This
+// kernel is compiled with a per-function target attribute and is
+// selected at run time.
+//
+
+#include <immintrin.h>
+
+#include "liquid.internal.h"
+
+// xor the leading multiple of 32 bytes of _x with the keystream,
+// returning the number of bytes processed
+__attribute__((target("avx2")))
+unsigned int liquid_scramble_xor_avx2(unsigned char *       _x,
+                                      unsigned int          _n,
+                                      const unsigned char * _key)
+{
+    __m256i k = _mm256_loadu_si256((const __m256i*)_key);
+
+    unsigned int i;
+    for (i=0; i+64<=_n; i+=64) {
+        __m256i x0 = _mm256_loadu_si256((const __m256i*)&_x[i]);
+        __m256i x1 = _mm256_loadu_si256((const __m256i*)&_x[i+32]);
+        _mm256_storeu_si256((__m256i*)&_x[i],    _mm256_xor_si256(x0, k));
+        _mm256_storeu_si256((__m256i*)&_x[i+32], _mm256_xor_si256(x1, k));
+    }
+    if (i+32 <= _n) {
+        __m256i x0 = _mm256_loadu_si256((const __m256i*)&_x[i]);
+        _mm256_storeu_si256((__m256i*)&_x[i], _mm256_xor_si256(x0, k));
+        i += 32;
+    }
+    return i;
+}
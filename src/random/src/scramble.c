@@ -21,35 +21,77 @@
  */
 
 //
-// Finite impulse response filter design
+// Data scrambler
+//
+// Data are whitened with a static mask repeating every four bytes. Hard
+// and soft scrambling both xor the data with a keystream repeating
+// every 32 bytes: the mask itself for packed bytes, and 0xff for each
+// set mask bit for soft bits (x^0xff = 255-x for unsigned bytes).
 //
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <math.h>
 
 #include "liquid.internal.h"
 
-void scramble_data(unsigned char * _x,
-                   unsigned int _n)
+#define LIQUID_SCRAMBLE_KEY                                     \
+    LIQUID_SCRAMBLE_MASK0, LIQUID_SCRAMBLE_MASK1,               \
+    LIQUID_SCRAMBLE_MASK2, LIQUID_SCRAMBLE_MASK3
+
+#define LIQUID_SCRAMBLE_SOFT(M)                                 \
+    ((M) & 0x80 ? 0xff : 0), ((M) & 0x40 ? 0xff : 0),           \
+    ((M) & 0x20 ? 0xff : 0), ((M) & 0x10 ? 0xff : 0),           \
+    ((M) & 0x08 ? 0xff : 0), ((M) & 0x04 ? 0xff : 0),           \
+    ((M) & 0x02 ? 0xff : 0), ((M) & 0x01 ? 0xff : 0)
+
+// keystream for packed bytes
+static const unsigned char liquid_scramble_key[32] = {
+    LIQUID_SCRAMBLE_KEY, LIQUID_SCRAMBLE_KEY, LIQUID_SCRAMBLE_KEY, LIQUID_SCRAMBLE_KEY,
+    LIQUID_SCRAMBLE_KEY, LIQUID_SCRAMBLE_KEY, LIQUID_SCRAMBLE_KEY, LIQUID_SCRAMBLE_KEY};
+
+// keystream for soft bits, one byte per bit of each mask
+static const unsigned char liquid_scramble_key_soft[32] = {
+    LIQUID_SCRAMBLE_SOFT(LIQUID_SCRAMBLE_MASK0),
+    LIQUID_SCRAMBLE_SOFT(LIQUID_SCRAMBLE_MASK1),
+    LIQUID_SCRAMBLE_SOFT(LIQUID_SCRAMBLE_MASK2),
+    LIQUID_SCRAMBLE_SOFT(LIQUID_SCRAMBLE_MASK3)};
+
+// xor _n bytes with a keystream repeating every 32 bytes
+void liquid_scramble_xor(unsigned char *       _x,
+                         unsigned int          _n,
+                         const unsigned char * _key)
 {
-    // t = 4*(floor(_n/4))
-    unsigned int t = (_n>>2)<<2;
+    unsigned int i = 0;
+#if HAVE_DOTPROD_AVX
+    if (_n >= 32 && liquid_simd_get_kernel(LIQUID_SIMD_SCRAMBLE) == LIQUID_SIMD_AVX2)
+        i = liquid_scramble_xor_avx2(_x, _n, _key);
+#endif
 
-    // apply static masks
-    unsigned int i;
-    for (i=0; i<t; i+=4) {
-        _x[i  ] ^= LIQUID_SCRAMBLE_MASK0;
-        _x[i+1] ^= LIQUID_SCRAMBLE_MASK1;
-        _x[i+2] ^= LIQUID_SCRAMBLE_MASK2;
-        _x[i+3] ^= LIQUID_SCRAMBLE_MASK3;
+    // 64-bit words, four per keystream period
+    uint64_t k[4];
+    memmove(k, _key, 32);
+    for ( ; i+32<=_n; i+=32) {
+        uint64_t w[4];
+        memmove(w, &_x[i], 32);
+        w[0] ^= k[0];
+        w[1] ^= k[1];
+        w[2] ^= k[2];
+        w[3] ^= k[3];
+        memmove(&_x[i], w, 32);
     }
 
     // clean up remainder of elements
-    if ( (i+0) < _n ) _x[i+0] ^= LIQUID_SCRAMBLE_MASK0;
-    if ( (i+1) < _n ) _x[i+1] ^= LIQUID_SCRAMBLE_MASK1;
-    if ( (i+2) < _n ) _x[i+2] ^= LIQUID_SCRAMBLE_MASK2;
-    if ( (i+3) < _n ) _x[i+3] ^= LIQUID_SCRAMBLE_MASK3;
+    for ( ; i<_n; i++)
+        _x[i] ^= _key[i & 31];
+}
+
+void scramble_data(unsigned char * _x,
+                   unsigned int _n)
+{
+    liquid_scramble_xor(_x, _n, liquid_scramble_key);
 }
 
 void unscramble_data(unsigned char * _x,
@@ -65,36 +107,5 @@ void unscramble_data(unsigned char * _x,
 void unscramble_data_soft(unsigned char * _x,
                           unsigned int _n)
 {
-    // bit mask
-    unsigned char mask = 0x00;
-
-    // apply static masks
-    unsigned int i;
-    for (i=0; i<_n; i++) {
-        switch ( i % 4 ) {
-        case 0: mask = LIQUID_SCRAMBLE_MASK0; break;
-        case 1: mask = LIQUID_SCRAMBLE_MASK1; break;
-        case 2: mask = LIQUID_SCRAMBLE_MASK2; break;
-        case 3: mask = LIQUID_SCRAMBLE_MASK3; break;
-        default:;
-        }
-
-#if 0
-        unsigned int j;
-        for (j=0; j<8; j++) {
-            if ( (mask >> (8-j-1)) & 0x01 )
-                _x[8*i+j] = 255 - _x[8*i+j];
-        }
-#else
-        if ( mask & 0x80 ) _x[8*i+0] = 255 - _x[8*i+0];
-        if ( mask & 0x40 ) _x[8*i+1] = 255 - _x[8*i+1];
-        if ( mask & 0x20 ) _x[8*i+2] = 255 - _x[8*i+2];
-        if ( mask & 0x10 ) _x[8*i+3] = 255 - _x[8*i+3];
-        if ( mask & 0x08 ) _x[8*i+4] = 255 - _x[8*i+4];
-        if ( mask & 0x04 ) _x[8*i+5] = 255 - _x[8*i+5];
-        if ( mask & 0x02 ) _x[8*i+6] = 255 - _x[8*i+6];
-        if ( mask & 0x01 ) _x[8*i+7] = 255 - _x[8*i+7];
-#endif
-    }
+    liquid_scramble_xor(_x, 8*_n, liquid_scramble_key_soft);
 }
-
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compute sample mean and variance of block
+void randn_block_autotest_stats(float *      _x,
+                                unsigned int _n,
+                                float *      _m,
+                                float *      _v)
+{
+    unsigned int i;
+    float m1 = 0.0f;
+    float m2 = 0.0f;
+    for (i=0; i<_n; i++) {
+        m1 += _x[i];
+        m2 += _x[i]*_x[i];
+    }
+    m1 /= (float)_n;
+    *_m = m1;
+    *_v = m2/(float)_n - m1*m1;
+}
+
+// block Gauss generators have zero mean and unit variance
+void autotest_randnf_block()
+{
+    unsigned int n = 100001;    // odd length exercises final sample
+    float x[n];
+    float m, v;
+
+    randnf_block(x, n);
+    randn_block_autotest_stats(x, n, &m, &v);
+    CONTEND_DELTA(m, 0.0f, 0.02f);
+    CONTEND_DELTA(v, 1.0f, 0.02f);
+
+    uint64_t state;
+    randf_seed_r(&state, 7);
+    randnf_block_r(&state, x, n);
+    randn_block_autotest_stats(x, n, &m, &v);
+    CONTEND_DELTA(m, 0.0f, 0.02f);
+    CONTEND_DELTA(v, 1.0f, 0.02f);
+}
+
+// reentrant generator: repeatable for a given seed, uniform in (0,1],
+// and independent across consecutive seeds
+void autotest_randf_r()
+{
+    unsigned int n = 4096;
+    unsigned int i;
+    float x0[n], x1[n], x2[n];
+    uint64_t s0, s1, s2;
+    randf_seed_r(&s0, 1);
+    randf_seed_r(&s1, 1);
+    randf_seed_r(&s2, 2);
+    float m = 0.0f;
+    float c = 0.0f;
+    for (i=0; i<n; i++) {
+        x0[i] = randf_r(&s0);
+        x1[i] = randf_r(&s1);
+        x2[i] = randf_r(&s2);
+        CONTEND_EXPRESSION(x0[i] > 0.0f && x0[i] <= 1.0f);
+        m += x0[i];
+        c += (x0[i]-0.5f)*(x2[i]-0.5f);
+    }
+    CONTEND_SAME_DATA(x0, x1, n*sizeof(float));
+    CONTEND_DELTA(m/(float)n, 0.5f, 0.02f);
+
+    // correlation between streams of consecutive seeds (variance 1/12)
+    CONTEND_DELTA(12.0f*c/(float)n, 0.0f, 0.1f);
+}
+
+// fill buffer from calling thread's generator after seeding it
+static void * randf_seed_autotest_worker(void * _x)
+{
+    float * x = (float*)_x;
+    unsigned int i;
+    randf_seed(11);
+    for (i=0; i<1024; i++)
+        x[i] = randf();
+    return NULL;
+}
+
+// randf_seed() repeats sequence of calling thread only; other threads
+// keep their own generator state
+void autotest_randf_seed()
+{
+    unsigned int i;
+    float x0[1024], x1[1024], x2[1024];
+    randf_seed(11);
+    for (i=0; i<1024; i++) x0[i] = randf();
+
+    // worker seeds its own generator identically; drawing from it
+    // must not disturb this thread's sequence
+    randf_seed(11);
+    for (i=0; i<512; i++) x1[i] = randf();
+    pthread_t worker;
+    pthread_create(&worker, NULL, randf_seed_autotest_worker, x2);
+    pthread_join(worker, NULL);
+    for (i=512; i<1024; i++) x1[i] = randf();
+
+    CONTEND_SAME_DATA(x0, x1, sizeof(x0));
+    CONTEND_SAME_DATA(x0, x2, sizeof(x0));
+}
+
+
+// Ziggurat generator matches the Gauss distribution across layers,
+// wedges and the tail beyond the base layer
+void autotest_randnf_r_cdf()
+{
+    unsigned int n = 1000000;
+    float t[6] = {-3.8f, -2.0f, -0.5f, 0.3f, 1.7f, 3.6f};
+    unsigned int c[6] = {0,0,0,0,0,0};
+    unsigned int i, k;
+
+    uint64_t state;
+    randf_seed_r(&state, 11);
+    for (i=0; i<n; i++) {
+        float x = randnf_r(&state);
+        for (k=0; k<6; k++)
+            c[k] += x < t[k] ? 1 : 0;
+    }
+
+    // compare to expected CDF within ~5 standard deviations of the
+    // binomial count
+    for (k=0; k<6; k++) {
+        float p   = randnf_cdf(t[k], 0.0f, 1.0f);
+        float tol = 5.0f*sqrtf(p*(1-p)/(float)n);
+        if (liquid_autotest_verbose)
+            printf("  P(x < %5.2f) : %12.8f (expected %12.8f)\n", t[k], (float)c[k]/(float)n, p);
+        CONTEND_DELTA((float)c[k]/(float)n, p, tol);
+    }
+}
+
+// complex Gauss block: real and imaginary parts each have zero mean and
+// unit variance, and are uncorrelated
+void autotest_crandnf_block_r()
+{
+    unsigned int n = 50000;
+    float complex x[n];
+    unsigned int i;
+
+    uint64_t state;
+    randf_seed_r(&state, 3);
+    crandnf_block_r(&state, x, n);
+
+    float complex m = 0.0f;
+    float vi = 0.0f;
+    float vq = 0.0f;
+    float c  = 0.0f;
+    for (i=0; i<n; i++) {
+        m  += x[i];
+        vi += crealf(x[i])*crealf(x[i]);
+        vq += cimagf(x[i])*cimagf(x[i]);
+        c  += crealf(x[i])*cimagf(x[i]);
+    }
+    CONTEND_DELTA(crealf(m)/(float)n, 0.0f, 0.02f);
+    CONTEND_DELTA(cimagf(m)/(float)n, 0.0f, 0.02f);
+    CONTEND_DELTA(vi/(float)n, 1.0f, 0.03f);
+    CONTEND_DELTA(vq/(float)n, 1.0f, 0.03f);
+    CONTEND_DELTA( c/(float)n, 0.0f, 0.03f);
+}
@@ -134,3 +134,46 @@ void autotest_scramble_soft_n33()     { liquid_scramble_soft_test(33);  };
 void autotest_scramble_soft_n277()    { liquid_scramble_soft_test(277); };
 
 
+
+// compare hard and soft scrambling against a byte-at-a-time reference
+// at every SIMD level available, including unaligned buffers and
+// lengths not a multiple of the keystream period
+void autotest_scramble_levels()
+{
+    unsigned char mask[4] = {LIQUID_SCRAMBLE_MASK0, LIQUID_SCRAMBLE_MASK1,
+                             LIQUID_SCRAMBLE_MASK2, LIQUID_SCRAMBLE_MASK3};
+    unsigned int n_max = 301;
+    unsigned char x[n_max+1];       // hard input (offset by one byte)
+    unsigned char y[n_max];         // hard reference
+    unsigned char xs[8*n_max+1];    // soft input (offset by one byte)
+    unsigned char ys[8*n_max];      // soft reference
+
+    unsigned int i, j;
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    unsigned int level;
+    for (level=0; level<LIQUID_SIMD_NUM_LEVELS; level++) {
+        if (level != LIQUID_SIMD_PORTABLE && level != host && !(x86 && level < host))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)level);
+
+        unsigned int n;
+        for (n=1; n<=n_max; n+=n<40 ? 1 : 37) {
+            for (i=0; i<n; i++) {
+                x[i+1] = rand() & 0xff;
+                y[i]   = x[i+1] ^ mask[i % 4];
+            }
+            scramble_data(&x[1], n);
+            CONTEND_SAME_DATA(&x[1], y, n);
+
+            for (i=0; i<8*n; i++) {
+                xs[i+1] = rand() & 0xff;
+                j = 7 - (i % 8);
+                ys[i] = (mask[(i/8) % 4] >> j) & 1 ? 255 - xs[i+1] : xs[i+1];
+            }
+            unscramble_data_soft(&xs[1], n);
+            CONTEND_SAME_DATA(&xs[1], ys, 8*n);
+        }
+    }
+    liquid_simd_set_level(host);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void msequence_generate_bench(struct rusage *_start,
+                              struct rusage *_finish,
+                              unsigned long int *_num_iterations,
+                              unsigned int _bps)
+{
+    // normalize number of iterations
+    *_num_iterations *= 10;
+
+    msequence ms = msequence_create_default(12);
+
+    unsigned long int i;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        msequence_generate_symbol(ms, _bps);
+        msequence_generate_symbol(ms, _bps);
+        msequence_generate_symbol(ms, _bps);
+        msequence_generate_symbol(ms, _bps);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    msequence_destroy(ms);
+}
+
+#define MSEQUENCE_BENCHMARK_API(BPS)        \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ msequence_generate_bench(_start, _finish, _num_iterations, BPS); }
+
+void benchmark_msequence_generate_bps1      MSEQUENCE_BENCHMARK_API(1)
+void benchmark_msequence_generate_bps8      MSEQUENCE_BENCHMARK_API(8)
+void benchmark_msequence_generate_bps32     MSEQUENCE_BENCHMARK_API(32)
+
+// generate a block of bytes
+void benchmark_msequence_generate_block(struct rusage *_start,
+                                        struct rusage *_finish,
+                                        unsigned long int *_num_iterations)
+{
+    // normalize number of iterations
+    *_num_iterations /= 10;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    msequence ms = msequence_create_default(12);
+    unsigned char buf[1024];
+
+    unsigned long int i;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        msequence_generate_block(ms, buf, 1024);
+    getrusage(RUSAGE_SELF, _finish);
+
+    msequence_destroy(ms);
+}
@@ -48,7 +48,7 @@ bsequence bsequence_create(unsigned int _num_bits)
     bsequence bs;
 
     // allocate memory for binary sequence
-    bs = (bsequence) malloc( sizeof(struct bsequence_s) );
+    bs = (bsequence) liquid_malloc( sizeof(struct bsequence_s) );
 
     // initialize variables
     bs->s_len = 0;
@@ -72,7 +72,7 @@ bsequence bsequence_create(unsigned int _num_bits)
     }
 
     // initialze array with zeros
-    bs->s = (unsigned int*) malloc( bs->s_len * sizeof(unsigned int) );
+    bs->s = (unsigned int*) liquid_malloc( bs->s_len * sizeof(unsigned int) );
     bsequence_clear(bs);
 
     return bs;
@@ -81,8 +81,8 @@ bsequence bsequence_create(unsigned int _num_bits)
 // Free memory in a binary sequence
 void bsequence_destroy(bsequence _bs)
 {
-    free( _bs->s );
-    free( _bs );
+    liquid_free( _bs->s );
+    liquid_free( _bs );
 }
 
 void bsequence_clear(bsequence _bs)
@@ -90,10 +90,36 @@ void bsequence_clear(bsequence _bs)
     memset( _bs->s, 0x00, (_bs->s_len)*sizeof(unsigned int) );
 }
 
+#if SIZEOF_INT == 4
+// read _w <= 32 bits starting at bit offset _o of a byte array,
+// most-significant bit first
+static unsigned int bsequence_read_bits(unsigned char * _v,
+                                        unsigned int    _o,
+                                        unsigned int    _w)
+{
+    unsigned int i0 = _o >> 3;
+    unsigned int i1 = (_o + _w - 1) >> 3;
+    uint64_t r = 0;
+    unsigned int i;
+    for (i=i0; i<=i1; i++)
+        r = (r << 8) | _v[i];
+    r >>= 8*(i1 - i0 + 1) - (_o & 7) - _w;
+    return (unsigned int)(r & ((((uint64_t)1) << _w) - 1));
+}
+#endif
+
 // initialize sequence on external array
 void bsequence_init(bsequence _bs,
                     unsigned char * _v)
 {
+#if SIZEOF_INT == 4
+    // load whole blocks: the first num_bits_msb bits fill the
+    // most-significant block and each following 32 bits fill the next
+    unsigned int i;
+    _bs->s[0] = bsequence_read_bits(_v, 0, _bs->num_bits_msb);
+    for (i=1; i<_bs->s_len; i++)
+        _bs->s[i] = bsequence_read_bits(_v, _bs->num_bits_msb + 32*(i-1), 32);
+#else
     // push single bit at a time
     unsigned int i;
     unsigned int k=0;
@@ -108,6 +134,7 @@ void bsequence_init(bsequence _bs,
         bsequence_push(_bs, byte & mask ? 1 : 0);
         mask >>= 1;
     }
+#endif
 }
 
 // Print sequence to the screen
@@ -185,15 +212,25 @@ signed int bsequence_correlate(bsequence _bs1,
         exit(-1);
     }
     
+#if SIZEOF_INT == 4
+    // count matching bits over pairs of blocks packed into 64-bit words
+    uint64_t chunk;
+    for (i=0; i+2<=_bs1->s_len; i+=2) {
+        chunk = ((uint64_t)(_bs1->s[i] ^ _bs2->s[i]) << 32) | (_bs1->s[i+1] ^ _bs2->s[i+1]);
+        rxy += liquid_count_ones_uint64(~chunk);
+    }
+    if (i < _bs1->s_len)
+        rxy += liquid_count_ones_uint32(~(_bs1->s[i] ^ _bs2->s[i]));
+#else
     unsigned int chunk;
 
     for (i=0; i<_bs1->s_len; i++) {
         //
         chunk = _bs1->s[i] ^ _bs2->s[i];
         chunk = ~chunk;
-
         rxy += liquid_count_ones(chunk);
     }
+#endif
 
     // compensate for most-significant block and return
     rxy -= 8*sizeof(unsigned int) - _bs1->num_bits_msb;
@@ -251,7 +288,11 @@ unsigned int bsequence_accumulate(bsequence _bs)
     unsigned int r=0;
 
     for (i=0; i<_bs->s_len; i++)
+#if SIZEOF_INT == 4
+        r += liquid_count_ones_uint32(_bs->s[i]);
+#else
         r += liquid_count_ones(_bs->s[i]);
+#endif
 
     return r;
 }
@@ -74,7 +74,7 @@ msequence msequence_create(unsigned int _m,
     }
     
     // allocate memory for msequence object
-    msequence ms = (msequence) malloc(sizeof(struct msequence_s));
+    msequence ms = (msequence) liquid_malloc(sizeof(struct msequence_s));
 
     // set internal values
     ms->m = _m;         // generator polynomial length
@@ -93,6 +93,7 @@ msequence msequence_create(unsigned int _m,
     ms->n = (1<<_m)-1;  // sequence length, (2^m)-1
     ms->v = ms->a;      // shift register
     ms->b = 0;          // return bit
+    ms->t = NULL;       // word-parallel output table
 
     return ms;
 }
@@ -127,10 +128,11 @@ msequence msequence_create_default(unsigned int _m)
     }
     
     // allocate memory for msequence object
-    msequence ms = (msequence) malloc(sizeof(struct msequence_s));
+    msequence ms = (msequence) liquid_malloc(sizeof(struct msequence_s));
 
     // copy default sequence
     memmove(ms, &msequence_default[_m], sizeof(struct msequence_s));
+    ms->t = NULL;
 
     // return
     return ms;
@@ -139,7 +141,8 @@ msequence msequence_create_default(unsigned int _m)
 // destroy an msequence object, freeing all internal memory
 void msequence_destroy(msequence _ms)
 {
-    free(_ms);
+    liquid_free(_ms->t);
+    liquid_free(_ms);
 }
 
 // prints the sequence's internal state to the screen
@@ -167,7 +170,7 @@ unsigned int msequence_advance(msequence _ms)
 {
     // compute return bit as binary dot product between the
     // internal shift register and the generator polynomial
-    _ms->b = liquid_bdotprod( _ms->v, _ms->g );
+    _ms->b = liquid_count_ones_uint32( _ms->v & _ms->g ) & 1;
 
     _ms->v <<= 1;       // shift internal register
     _ms->v |= _ms->b;   // push bit onto register
@@ -177,6 +180,37 @@ unsigned int msequence_advance(msequence _ms)
 }
 
 
+// build word-parallel output table; the register output is linear
+// in its state so the 32 bits following state v are the xor of the
+// responses to each set bit of v, tabulated a byte at a time (m <= 15)
+static void msequence_init_table(msequence _ms)
+{
+    _ms->t = (unsigned int*) liquid_malloc(2*256*sizeof(unsigned int));
+
+    // response of 32 steps to each single-bit state
+    unsigned int r[16] = {0};
+    unsigned int i, j;
+    for (i=0; i<_ms->m; i++) {
+        unsigned int v = 1 << i;
+        for (j=0; j<32; j++) {
+            unsigned int b = liquid_count_ones_uint32(v & _ms->g) & 1;
+            v = ((v << 1) | b) & _ms->n;
+            r[i] = (r[i] << 1) | b;
+        }
+    }
+
+    // t[k] = t[k with lowest set bit cleared] ^ r[lowest set bit]
+    _ms->t[0]   = 0;
+    _ms->t[256] = 0;
+    for (i=1; i<256; i++) {
+        unsigned int k = 0;
+        while ( ((i >> k) & 1) == 0 )
+            k++;
+        _ms->t[i]     = _ms->t[i & (i-1)]     ^ r[k];
+        _ms->t[256+i] = _ms->t[256 + (i & (i-1))] ^ r[k+8];
+    }
+}
+
 // generate pseudo-random symbol from shift register
 //  _ms     :   m-sequence object
 //  _bps    :   bits per symbol of output
@@ -185,13 +219,56 @@ unsigned int msequence_generate_symbol(msequence _ms,
 {
     unsigned int i;
     unsigned int s = 0;
-    for (i=0; i<_bps; i++) {
-        s <<= 1;
-        s |= msequence_advance(_ms);
+    if (_bps < 2 || _bps > 32) {
+        for (i=0; i<_bps; i++) {
+            s <<= 1;
+            s |= msequence_advance(_ms);
+        }
+        return s;
     }
+
+    // step _bps bits at once; output bits are shifted into the register
+    if (_ms->t == NULL)
+        msequence_init_table(_ms);
+    unsigned int w = _ms->t[_ms->v & 0xff] ^ _ms->t[256 + (_ms->v >> 8)];
+    s = w >> (32 - _bps);
+    _ms->v = (_bps >= _ms->m) ? s & _ms->n : ((_ms->v << _bps) | s) & _ms->n;
+    _ms->b = s & 1;
     return s;
 }
 
+// generate _n bytes of the sequence, most-significant bit first; equivalent
+// to _n calls to msequence_generate_symbol(_ms,8)
+//  _ms     :   m-sequence object
+//  _buf    :   output buffer, [size: _n x 1]
+//  _n      :   number of bytes to generate
+void msequence_generate_block(msequence       _ms,
+                              unsigned char * _buf,
+                              unsigned int    _n)
+{
+    if (_ms->t == NULL)
+        msequence_init_table(_ms);
+
+    // 32 bits per step; m <= 15 so the new state is the output's tail
+    const unsigned int * t = _ms->t;
+    unsigned int v = _ms->v;
+    unsigned int i;
+    for (i=0; i+4<=_n; i+=4) {
+        unsigned int w = t[v & 0xff] ^ t[256 + (v >> 8)];
+        _buf[i  ] = (w >> 24) & 0xff;
+        _buf[i+1] = (w >> 16) & 0xff;
+        _buf[i+2] = (w >>  8) & 0xff;
+        _buf[i+3] = (w      ) & 0xff;
+        v = w & _ms->n;
+        _ms->b = w & 1;
+    }
+    _ms->v = v;
+
+    // remaining bytes
+    for ( ; i<_n; i++)
+        _buf[i] = msequence_generate_symbol(_ms, 8);
+}
+
 // reset msequence shift register to original state, typically '1'
 void msequence_reset(msequence _ms)
 {
@@ -215,8 +292,21 @@ void bsequence_init_msequence(bsequence _bs,
     bsequence_clear(_bs);
 
     unsigned int i;
-    for (i=0; i<(_ms->n); i++)
-        bsequence_push(_bs, msequence_advance(_ms));
+    if (bsequence_get_length(_bs) != _ms->n) {
+        for (i=0; i<(_ms->n); i++)
+            bsequence_push(_bs, msequence_advance(_ms));
+        return;
+    }
+
+    // sequence fills the object exactly: generate packed bits and load
+    // them at once rather than pushing one at a time
+    unsigned int num_bytes = (_ms->n + 7) / 8;
+    unsigned char * v = (unsigned char*) liquid_malloc(num_bytes*sizeof(unsigned char));
+    msequence_generate_block(_ms, v, _ms->n / 8);
+    if (_ms->n % 8)
+        v[num_bytes-1] = msequence_generate_symbol(_ms, _ms->n % 8) << (8 - _ms->n % 8);
+    bsequence_init(_bs, v);
+    liquid_free(v);
 }
 
 // get the length of the sequence
@@ -92,3 +92,68 @@ void autotest_msequence_m10()   {   msequence_test_autocorrelation(10); }   // n
 void autotest_msequence_m11()   {   msequence_test_autocorrelation(11); }   // n = 2047
 void autotest_msequence_m12()   {   msequence_test_autocorrelation(12); }   // n = 4095
 
+
+// helper function to test word-parallel generation against advancing
+// the shift register one bit at a time
+void msequence_test_generate(unsigned int _m)
+{
+    msequence ms0 = msequence_create_default(_m);
+    msequence ms1 = msequence_create_default(_m);
+
+    // symbols of all widths
+    unsigned int i, j, bps;
+    for (bps=1; bps<=32; bps++) {
+        for (i=0; i<3; i++) {
+            unsigned int s0 = 0;
+            for (j=0; j<bps; j++)
+                s0 = (s0 << 1) | msequence_advance(ms0);
+            unsigned int s1 = msequence_generate_symbol(ms1, bps);
+            CONTEND_EQUALITY( s1, s0 );
+            CONTEND_EQUALITY( msequence_get_state(ms1), msequence_get_state(ms0) );
+        }
+    }
+
+    // block of bytes, including a partial word at the end
+    unsigned char buf[47];
+    msequence_generate_block(ms1, buf, 47);
+    for (i=0; i<47; i++)
+        CONTEND_EQUALITY( buf[i], msequence_generate_symbol(ms0, 8) );
+    CONTEND_EQUALITY( msequence_get_state(ms1), msequence_get_state(ms0) );
+
+    // state continues after block generation
+    CONTEND_EQUALITY( msequence_advance(ms1), msequence_advance(ms0) );
+
+    msequence_destroy(ms0);
+    msequence_destroy(ms1);
+}
+
+void autotest_msequence_generate_m2()   { msequence_test_generate(2);  }
+void autotest_msequence_generate_m5()   { msequence_test_generate(5);  }
+void autotest_msequence_generate_m8()   { msequence_test_generate(8);  }
+void autotest_msequence_generate_m9()   { msequence_test_generate(9);  }
+void autotest_msequence_generate_m15()  { msequence_test_generate(15); }
+
+// binary sequence initialized from packed bits matches pushing them
+void autotest_bsequence_init_msequence_push()
+{
+    unsigned int m;
+    for (m=2; m<=12; m++) {
+        msequence ms = msequence_create_default(m);
+        unsigned int n = msequence_get_length(ms);
+
+        bsequence bs0 = bsequence_create(n);
+        bsequence bs1 = bsequence_create(n);
+        unsigned int i;
+        for (i=0; i<n; i++)
+            bsequence_push(bs0, msequence_advance(ms));
+        bsequence_init_msequence(bs1, ms);
+
+        for (i=0; i<n; i++)
+            CONTEND_EQUALITY( bsequence_index(bs1,i), bsequence_index(bs0,i) );
+        CONTEND_EQUALITY( bsequence_correlate(bs0,bs1), n );
+
+        bsequence_destroy(bs0);
+        bsequence_destroy(bs1);
+        msequence_destroy(ms);
+    }
+}
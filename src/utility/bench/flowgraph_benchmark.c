@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define FLOWGRAPH_BENCH_API(NUM_THREADS)                    \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ flowgraph_bench(_start, _finish, _num_iterations, NUM_THREADS); }
+
+// source: emit a fixed number of noise samples
+struct flowgraph_bench_source_s {
+    float complex *   x;        // noise block
+    unsigned int      x_len;    // noise block length
+    unsigned long int n;        // samples left to emit
+};
+
+static int flowgraph_bench_source(void *         _userdata,
+                                  void **        _x,
+                                  unsigned int * _nx,
+                                  void **        _y,
+                                  unsigned int * _ny)
+{
+    struct flowgraph_bench_source_s * s = (struct flowgraph_bench_source_s*) _userdata;
+    unsigned int n = _ny[0] < s->x_len ? _ny[0] : s->x_len;
+    if (n > s->n)
+        n = s->n;
+    memmove(_y[0], s->x, n*sizeof(float complex));
+    s->n -= n;
+    _ny[0] = n;
+    return s->n == 0 ? LIQUID_FLOWGRAPH_DONE : 0;
+}
+
+static int flowgraph_bench_sink(void *         _userdata,
+                                void **        _x,
+                                unsigned int * _nx,
+                                void **        _y,
+                                unsigned int * _ny)
+{
+    return 0;
+}
+
+// Helper function to keep code base small
+void flowgraph_bench(struct rusage *     _start,
+                     struct rusage *     _finish,
+                     unsigned long int * _num_iterations,
+                     unsigned int        _num_threads)
+{
+    unsigned long int i;
+    unsigned int block_len = 1024;
+
+    // receive chain: mix down, filter, gain control, filter
+    nco_crcf     nco = nco_crcf_create(LIQUID_VCO);
+    firfilt_crcf f0  = firfilt_crcf_create_kaiser(33, 0.2f, 60.0f, 0.0f);
+    agc_crcf     agc = agc_crcf_create();
+    firfilt_crcf f1  = firfilt_crcf_create_kaiser(33, 0.1f, 60.0f, 0.0f);
+    nco_crcf_set_frequency(nco, 0.1f);
+
+    struct flowgraph_bench_source_s s;
+    s.x_len = block_len;
+    s.x = (float complex*) malloc(block_len*sizeof(float complex));
+    for (i=0; i<block_len; i++)
+        s.x[i] = randnf() + _Complex_I*randnf();
+
+    *_num_iterations /= 10;
+    s.n = *_num_iterations;
+
+    flowgraph g = flowgraph_create(_num_threads);
+    unsigned int b_src  = flowgraph_add_block(g, "source", 0, 0, 1, sizeof(float complex), flowgraph_bench_source, &s);
+    unsigned int b_nco  = flowgraph_add_nco_crcf_mix_down(g, nco);
+    unsigned int b_f0   = flowgraph_add_firfilt_crcf(g, f0);
+    unsigned int b_agc  = flowgraph_add_agc_crcf(g, agc);
+    unsigned int b_f1   = flowgraph_add_firfilt_crcf(g, f1);
+    unsigned int b_sink = flowgraph_add_block(g, "sink", 1, sizeof(float complex), 0, 0, flowgraph_bench_sink, NULL);
+    flowgraph_connect(g, b_src, 0, b_nco,  0, 4*block_len);
+    flowgraph_connect(g, b_nco, 0, b_f0,   0, 4*block_len);
+    flowgraph_connect(g, b_f0,  0, b_agc,  0, 4*block_len);
+    flowgraph_connect(g, b_agc, 0, b_f1,   0, 4*block_len);
+    flowgraph_connect(g, b_f1,  0, b_sink, 0, 4*block_len);
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    flowgraph_run(g);
+    getrusage(RUSAGE_SELF, _finish);
+
+    flowgraph_destroy(g);
+    nco_crcf_destroy(nco);
+    firfilt_crcf_destroy(f0);
+    agc_crcf_destroy(agc);
+    firfilt_crcf_destroy(f1);
+    free(s.x);
+}
+
+// serial execution in calling thread
+void benchmark_flowgraph_t0 FLOWGRAPH_BENCH_API(0)
+
+// worker pool
+void benchmark_flowgraph_t1 FLOWGRAPH_BENCH_API(1)
+void benchmark_flowgraph_t3 FLOWGRAPH_BENCH_API(3)
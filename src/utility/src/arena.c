@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Arena allocator
+//
+// Objects holding many arrays of fixed size allocate them as regions of
+// a single block rather than with independent malloc() calls: regions
+// are contiguous and cache-line aligned, and the whole block is freed
+// in one operation. Regions are handed out in order and cannot be
+// freed individually.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+struct liquid_arena_s {
+    unsigned char * block;      // memory block, aligned to LIQUID_ARENA_ALIGNMENT
+    unsigned long   size;       // capacity (bytes)
+    unsigned long   used;       // offset of next region (bytes)
+};
+
+// create arena with capacity of _size bytes
+liquid_arena liquid_arena_create(unsigned long _size)
+{
+    liquid_arena a = (liquid_arena) liquid_malloc(sizeof(struct liquid_arena_s));
+    a->size = LIQUID_ARENA_SIZE(_size);
+    a->used = 0;
+    a->block = (unsigned char*) liquid_malloc_aligned(a->size);
+    return a;
+}
+
+// destroy arena, releasing all regions at once
+void liquid_arena_destroy(liquid_arena _a)
+{
+    liquid_free_aligned(_a->block);
+    liquid_free(_a);
+}
+
+// print arena object properties
+void liquid_arena_print(liquid_arena _a)
+{
+    printf("arena [used: %lu / %lu bytes]\n", _a->used, _a->size);
+}
+
+// release all regions, keeping the underlying block
+void liquid_arena_reset(liquid_arena _a)
+{
+    _a->used = 0;
+}
+
+// get next region of _size bytes (uninitialized)
+void * liquid_arena_alloc(liquid_arena  _a,
+                          unsigned long _size)
+{
+    unsigned long n = LIQUID_ARENA_SIZE(_size);
+    if (n > _a->size - _a->used) {
+        fprintf(stderr,"error: liquid_arena_alloc(), request of %lu bytes exceeds capacity (%lu of %lu bytes used)\n",
+                _size, _a->used, _a->size);
+        exit(1);
+    }
+    void * p = _a->block + _a->used;
+    _a->used += n;
+    return p;
+}
+
+// get next region for _num elements of _size bytes, set to zero
+void * liquid_arena_calloc(liquid_arena  _a,
+                           unsigned long _num,
+                           unsigned long _size)
+{
+    void * p = liquid_arena_alloc(_a, _num*_size);
+    memset(p, 0x00, _num*_size);
+    return p;
+}
+
+// get capacity of arena (bytes)
+unsigned long liquid_arena_get_size(liquid_arena _a)
+{
+    return _a->size;
+}
+
+// get number of bytes handed out, including alignment padding
+unsigned long liquid_arena_get_used(liquid_arena _a)
+{
+    return _a->used;
+}
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// autotune.c : host profile of implementation choices
+//
+// liquid_autotune() microbenchmarks alternatives whose crossovers
+// depend on the host (SIMD dispatch level of the dot products, the
+// direct-form/FFT filtering crossover, transform methods) and records
+// the winners in a profile consulted when objects select their
+// implementation. Profiles are stored as plain text, one parameter per
+// line, followed by the fft wisdom of the tuned transform sizes:
+//
+//      # quiet-dsp autotune profile
+//      simd_level avx2
+//      fftfilt_cost 9.6
+//      fft 120 forward mixed-radix 8
+//
+// Blank lines and lines starting with '#' are ignored.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "liquid.internal.h"
+
+// minimum measurement time per candidate [seconds]
+#define LIQUID_AUTOTUNE_MEASURE_TIME    (2e-3)
+
+// transform sizes tuned by liquid_autotune(): common non-power-of-two
+// sizes, for which the method choice matters most
+static const unsigned int liquid_autotune_fft_sizes[] = {
+    48, 96, 120, 192, 240, 384, 480, 960, 1920,
+};
+#define LIQUID_AUTOTUNE_NUM_FFT_SIZES \
+    (sizeof(liquid_autotune_fft_sizes)/sizeof(liquid_autotune_fft_sizes[0]))
+
+// benchmark result sink, keeping measured loops from being removed
+static volatile float liquid_autotune_sink;
+
+// profile entry
+struct liquid_autotune_param_s {
+    const char * name;      // name in profile
+    float        value;     // current value
+    float        value_def; // built-in default
+    int          tuned;     // set by liquid_autotune() or imported?
+};
+
+// profile: process-wide, configured before other threads use the
+// library (as with the SIMD dispatch level)
+static struct liquid_autotune_param_s liquid_autotune_profile[LIQUID_AUTOTUNE_NUM_PARAMS] = {
+    {"simd_level",   -1.0f, -1.0f, 0},  // negative: host level
+    {"fftfilt_cost", 12.0f, 12.0f, 0},
+};
+
+// validate parameter
+static void liquid_autotune_validate(liquid_autotune_param _p, const char * _method)
+{
+    if ((int)_p < 0 || _p >= LIQUID_AUTOTUNE_NUM_PARAMS) {
+        fprintf(stderr,"error: %s(), invalid parameter\n", _method);
+        exit(1);
+    }
+}
+
+// get profile value of parameter
+float liquid_autotune_get(liquid_autotune_param _p)
+{
+    liquid_autotune_validate(_p, "liquid_autotune_get");
+    return liquid_autotune_profile[_p].value;
+}
+
+// set profile value of parameter, applying it where the library keeps
+// its own state (e.g. the SIMD dispatch level)
+void liquid_autotune_set(liquid_autotune_param _p,
+                         float                 _value)
+{
+    liquid_autotune_validate(_p, "liquid_autotune_set");
+    switch (_p) {
+    case LIQUID_AUTOTUNE_SIMD_LEVEL:
+        if (_value < 0.0f || _value >= (float)LIQUID_SIMD_NUM_LEVELS) {
+            fprintf(stderr,"error: liquid_autotune_set(), invalid simd level\n");
+            exit(1);
+        }
+        liquid_simd_set_level((liquid_simd_level)(int)_value);
+        break;
+    case LIQUID_AUTOTUNE_FFTFILT_COST:
+        if (_value <= 0.0f) {
+            fprintf(stderr,"error: liquid_autotune_set(), fftfilt cost must be greater than zero\n");
+            exit(1);
+        }
+        break;
+    default:;
+    }
+    liquid_autotune_profile[_p].value = _value;
+    liquid_autotune_profile[_p].tuned = 1;
+}
+
+// get monotonic time [seconds]
+static double liquid_autotune_clock(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + 1e-9*(double)t.tv_nsec;
+}
+
+// measure average time of one dot product of length _n [seconds]
+static double liquid_autotune_measure_dotprod(unsigned int _n)
+{
+    float         h[_n];
+    float complex x[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        h[i] = cosf(0.1f*i);
+        x[i] = sinf(0.3f*i) + _Complex_I*cosf(0.7f*i);
+    }
+    dotprod_crcf q = dotprod_crcf_create(h, _n);
+
+    float complex y = 0.0f;
+    double dt = 0.0;
+    unsigned long num_trials = 64;
+    while (1) {
+        unsigned long t;
+        double t0 = liquid_autotune_clock();
+        for (t=0; t<num_trials; t++) {
+            float complex v;
+            dotprod_crcf_execute(q, x, &v);
+            y += v;
+        }
+        dt = liquid_autotune_clock() - t0;
+        if (dt >= LIQUID_AUTOTUNE_MEASURE_TIME || num_trials >= (1UL<<24))
+            break;
+        num_trials <<= 1;
+    }
+    dotprod_crcf_destroy(q);
+
+    // keep result live
+    liquid_autotune_sink = crealf(y);
+    return dt / (double)num_trials;
+}
+
+// measure average time per output sample of direct-form (_fft=0) or
+// FFT-based (_fft=1) filtering [seconds]
+static double liquid_autotune_measure_filter(unsigned int _h_len,
+                                             unsigned int _nfft,
+                                             int          _fft)
+{
+    unsigned int n = _nfft - _h_len + 1;
+    float         h[_h_len];
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    for (i=0; i<_h_len; i++)
+        h[i] = cosf(0.1f*i);
+    for (i=0; i<n; i++)
+        x[i] = sinf(0.3f*i) + _Complex_I*cosf(0.7f*i);
+
+    firfilt_crcf f = _fft ? NULL : firfilt_crcf_create(h, _h_len);
+    fftfilt_crcf g = _fft ? fftfilt_crcf_create_nfft(h, _h_len, n, _nfft) : NULL;
+
+    double dt = 0.0;
+    unsigned long num_trials = 1;
+    while (1) {
+        unsigned long t;
+        double t0 = liquid_autotune_clock();
+        for (t=0; t<num_trials; t++) {
+            if (_fft) fftfilt_crcf_execute(g, x, y);
+            else      firfilt_crcf_execute_block(f, x, n, y);
+        }
+        dt = liquid_autotune_clock() - t0;
+        if (dt >= LIQUID_AUTOTUNE_MEASURE_TIME || num_trials >= (1UL<<20))
+            break;
+        num_trials <<= 1;
+    }
+    if (f != NULL) firfilt_crcf_destroy(f);
+    if (g != NULL) fftfilt_crcf_destroy(g);
+    return dt / (double)(num_trials * n);
+}
+
+// microbenchmark implementation alternatives on this host, storing the
+// fastest in the profile; returns 0 on success
+int liquid_autotune(void)
+{
+    // dot product kernels: fastest SIMD level available on the host;
+    // kernels are bound when objects are created, so each level is
+    // measured on a fresh object
+    liquid_simd_level level_old  = liquid_simd_get_level();
+    liquid_simd_level level_best = level_old;
+    double            t_best     = 0.0;
+    int l;
+    for (l=0; l<LIQUID_SIMD_NUM_LEVELS; l++) {
+        if (!liquid_simd_level_supported((liquid_simd_level)l))
+            continue;
+        liquid_simd_set_level((liquid_simd_level)l);
+        double t = liquid_autotune_measure_dotprod(64);
+        if (t_best == 0.0 || t < t_best) {
+            t_best     = t;
+            level_best = (liquid_simd_level)l;
+        }
+    }
+    liquid_simd_set_level(level_old);
+    liquid_autotune_set(LIQUID_AUTOTUNE_SIMD_LEVEL, (float)level_best);
+
+    // direct-form/FFT filtering crossover, as relative cost of one
+    // fftfilt transform point per stage in direct-form taps (see
+    // liquid_fftfilt_select())
+    unsigned int h_len = 64;
+    unsigned int nfft  = 256;
+    double t_fir = liquid_autotune_measure_filter(h_len, nfft, 0) / (double)h_len;
+    double t_fft = liquid_autotune_measure_filter(h_len, nfft, 1) * (double)(nfft - h_len + 1) /
+                   ((double)nfft * log2((double)nfft));
+    float cost = (float)(t_fft / t_fir);
+    cost = cost < 1.0f ? 1.0f : (cost > 100.0f ? 100.0f : cost);
+    liquid_autotune_set(LIQUID_AUTOTUNE_FFTFILT_COST, cost);
+
+    // transform methods: re-measure common sizes into fft wisdom
+    unsigned int i;
+    for (i=0; i<LIQUID_AUTOTUNE_NUM_FFT_SIZES; i++) {
+        unsigned int n = liquid_autotune_fft_sizes[i];
+        float complex x[n], y[n];
+        memset(x, 0x00, sizeof(x));
+        fftplan p0 = fft_create_plan(n, x, y, LIQUID_FFT_FORWARD,  LIQUID_FFT_MEASURE);
+        fftplan p1 = fft_create_plan(n, x, y, LIQUID_FFT_BACKWARD, LIQUID_FFT_MEASURE);
+        fft_destroy_plan(p0);
+        fft_destroy_plan(p1);
+    }
+    return 0;
+}
+
+// restore built-in defaults (fft wisdom is kept; see fft_wisdom_forget())
+void liquid_autotune_forget(void)
+{
+    if (liquid_autotune_profile[LIQUID_AUTOTUNE_SIMD_LEVEL].tuned)
+        liquid_simd_set_level(liquid_simd_get_host_level());
+
+    unsigned int i;
+    for (i=0; i<LIQUID_AUTOTUNE_NUM_PARAMS; i++) {
+        liquid_autotune_profile[i].value = liquid_autotune_profile[i].value_def;
+        liquid_autotune_profile[i].tuned = 0;
+    }
+}
+
+// test whether parameter has been tuned or imported
+int liquid_autotune_is_tuned(liquid_autotune_param _p)
+{
+    liquid_autotune_validate(_p, "liquid_autotune_is_tuned");
+    return liquid_autotune_profile[_p].tuned;
+}
+
+// print profile parameter to file
+static void liquid_autotune_print_param(FILE * _fid, unsigned int _i)
+{
+    const struct liquid_autotune_param_s * p = &liquid_autotune_profile[_i];
+    if (_i == LIQUID_AUTOTUNE_SIMD_LEVEL)
+        fprintf(_fid,"%s %s\n", p->name, liquid_simd_level_str((liquid_simd_level)(int)p->value));
+    else
+        fprintf(_fid,"%s %g\n", p->name, p->value);
+}
+
+// export profile to file, returning 0 on success
+int liquid_autotune_export(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"w");
+    if (fid == NULL) {
+        fprintf(stderr,"warning: liquid_autotune_export(), could not open '%s' for writing\n", _filename);
+        return -1;
+    }
+
+    fprintf(fid,"# quiet-dsp autotune profile\n");
+    unsigned int i;
+    for (i=0; i<LIQUID_AUTOTUNE_NUM_PARAMS; i++) {
+        if (liquid_autotune_profile[i].tuned)
+            liquid_autotune_print_param(fid, i);
+    }
+
+    // append wisdom, one entry per line prefixed with "fft" (allocation
+    // failure is reported by liquid_malloc())
+    int n = fft_wisdom_export_string(NULL, 0);
+    char * wisdom = (char*) liquid_malloc(n + 1);
+    fft_wisdom_export_string(wisdom, n + 1);
+    char * line = wisdom;
+    while (*line != '\0') {
+        size_t k = strcspn(line, "\n");
+        if (*line != '#')
+            fprintf(fid,"fft %.*s\n", (int)k, line);
+        line += k;
+        if (*line == '\n')
+            line++;
+    }
+    liquid_free(wisdom);
+
+    int rc = ferror(fid) ? -1 : 0;
+    if (fclose(fid) != 0)
+        rc = -1;
+    return rc;
+}
+
+// parse single line of profile; returns 1 if an entry was applied, 0
+// if the line is blank, a comment or does not apply to this host, -1
+// if invalid
+static int liquid_autotune_parse_line(const char * _line)
+{
+    // skip leading white space
+    while (*_line == ' ' || *_line == '\t')
+        _line++;
+    if (*_line == '\0' || *_line == '\n' || *_line == '\r' || *_line == '#')
+        return 0;
+
+    char name[32];
+    char value[32];
+    int  offset = 0;
+    if (sscanf(_line, "%31s %31s%n", name, value, &offset) != 2)
+        return -1;
+
+    // fft wisdom entry
+    if (strcmp(name,"fft") == 0)
+        return fft_wisdom_import_string(_line + 4) == 1 ? 1 : -1;
+
+    // simd level: kept only if available on this host
+    if (strcmp(name, liquid_autotune_profile[LIQUID_AUTOTUNE_SIMD_LEVEL].name) == 0) {
+        int l;
+        for (l=0; l<LIQUID_SIMD_NUM_LEVELS; l++) {
+            if (strcmp(value, liquid_simd_level_str((liquid_simd_level)l)) != 0)
+                continue;
+            if (!liquid_simd_level_supported((liquid_simd_level)l))
+                return 0;
+            liquid_autotune_set(LIQUID_AUTOTUNE_SIMD_LEVEL, (float)l);
+            return 1;
+        }
+        return -1;
+    }
+
+    unsigned int i;
+    for (i=0; i<LIQUID_AUTOTUNE_NUM_PARAMS; i++) {
+        if (strcmp(name, liquid_autotune_profile[i].name) != 0)
+            continue;
+        char * end = NULL;
+        float v = strtof(value, &end);
+        if (end == value || *end != '\0' || !(v > 0.0f))
+            return -1;
+        liquid_autotune_set((liquid_autotune_param)i, v);
+        return 1;
+    }
+    return -1;
+}
+
+// import profile from file, returning number of entries applied or -1
+// if the file could not be read
+int liquid_autotune_import(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"r");
+    if (fid == NULL) {
+        fprintf(stderr,"warning: liquid_autotune_import(), could not open '%s' for reading\n", _filename);
+        return -1;
+    }
+
+    char line[256];
+    unsigned int lineno = 0;
+    int num_imported = 0;
+    while (fgets(line, sizeof(line), fid) != NULL) {
+        lineno++;
+        line[strcspn(line, "\r\n")] = '\0';
+        int rc = liquid_autotune_parse_line(line);
+        if (rc < 0)
+            fprintf(stderr,"warning: liquid_autotune_import(), '%s' line %u invalid; ignoring\n", _filename, lineno);
+        else
+            num_imported += rc;
+    }
+    fclose(fid);
+    return num_imported;
+}
+
+// print profile to stdout
+void liquid_autotune_print(void)
+{
+    printf("autotune profile:\n");
+    unsigned int i;
+    for (i=0; i<LIQUID_AUTOTUNE_NUM_PARAMS; i++) {
+        printf("  %-8s", liquid_autotune_profile[i].tuned ? "(tuned)" : "(default)");
+        if (i == LIQUID_AUTOTUNE_SIMD_LEVEL && liquid_autotune_profile[i].value < 0.0f)
+            printf("%s host\n", liquid_autotune_profile[i].name);
+        else
+            liquid_autotune_print_param(stdout, i);
+    }
+}
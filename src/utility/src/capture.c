@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Sample capture files
+//
+// Source/sink for raw interleaved sample recordings in native byte
+// order. A source maps the whole file and hands out block views:
+// floating-point formats point directly into the mapping (no copy),
+// while 16-bit integer samples are converted into an internal block
+// buffer. The mapping is advised for sequential access; pages ahead of
+// the read position are requested early and pages behind it are
+// dropped so that the resident set stays bounded for very large
+// files. Systems without mmap() fall back to buffered reads.
+//
+// Sinks use buffered sequential writes.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SYS_MMAN_H && HAVE_FCNTL_H && HAVE_UNISTD_H && HAVE_SYS_STAT_H
+#  define LIQUID_CAPTURE_MMAP 1
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#else
+#  define LIQUID_CAPTURE_MMAP 0
+#endif
+
+// distance ahead of/behind the read position over which pages are
+// prefetched/released
+#define CAPTURE_READAHEAD   (1<<22)
+
+struct capture_s {
+    liquid_capture_format format;   // sample format
+    unsigned int sample_size;       // bytes per sample
+    int          sink;              // 1 for sink, 0 for source
+    unsigned long num_samples;      // total samples (source), written (sink)
+    unsigned long index;            // read position (samples)
+
+    // source: mapped file (or file handle when mmap is unavailable)
+    unsigned char * map;            // mapped file contents
+    size_t       map_len;           // mapped length (bytes)
+    size_t       advised;           // end of prefetched region (bytes)
+    size_t       released;          // end of released region (bytes)
+    FILE *       fid;               // file handle (sink, or source fallback)
+
+    // conversion buffer
+    unsigned char * buf;            // block buffer
+    unsigned int buf_len;           // block buffer size (bytes)
+};
+
+// format descriptors
+static const struct {
+    const char * name;
+    const char * description;
+    unsigned int sample_size;
+    int          is_complex;
+} capture_format_info[LIQUID_CAPTURE_NUM_FORMATS] = {
+    {"unknown", "unknown",                       0, 0},
+    {"cf32",    "complex 32-bit floating-point", 8, 1},
+    {"ci16",    "complex 16-bit integer",        4, 1},
+    {"f32",     "real 32-bit floating-point",    4, 0},
+};
+
+// ensure block buffer holds at least _n bytes
+static void capture_reserve_buf(capture _q, unsigned int _n)
+{
+    if (_n <= _q->buf_len)
+        return;
+    _q->buf = (unsigned char*) liquid_realloc(_q->buf, _n);
+    _q->buf_len = _n;
+}
+
+// validate format identifier
+static void capture_validate_format(liquid_capture_format _format,
+                                    const char *          _method)
+{
+    if (_format <= LIQUID_CAPTURE_UNKNOWN || _format >= LIQUID_CAPTURE_NUM_FORMATS) {
+        fprintf(stderr,"error: capture_%s(), invalid/unsupported format (%d)\n", _method, _format);
+        exit(1);
+    }
+}
+
+// convert string to capture format
+liquid_capture_format liquid_getopt_str2capture(const char * _str)
+{
+    unsigned int i;
+    for (i=1; i<LIQUID_CAPTURE_NUM_FORMATS; i++) {
+        if (strcmp(_str, capture_format_info[i].name)==0)
+            return (liquid_capture_format) i;
+    }
+    fprintf(stderr,"warning: liquid_getopt_str2capture(), unknown/unsupported format: %s\n", _str);
+    return LIQUID_CAPTURE_UNKNOWN;
+}
+
+// open existing capture file as a sample source
+//  _filename   :   path to file
+//  _format     :   sample format
+capture capture_open(const char *          _filename,
+                     liquid_capture_format _format)
+{
+    capture_validate_format(_format, "open");
+
+    capture q = (capture) liquid_malloc(sizeof(struct capture_s));
+    memset(q, 0, sizeof(struct capture_s));
+    q->format      = _format;
+    q->sample_size = capture_format_info[_format].sample_size;
+    q->sink        = 0;
+
+#if LIQUID_CAPTURE_MMAP
+    int fd = open(_filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr,"error: capture_open(), could not open '%s' for reading\n", _filename);
+        if (fd >= 0)
+            close(fd);
+        liquid_free(q);
+        return NULL;
+    }
+    q->num_samples = (unsigned long)st.st_size / q->sample_size;
+    q->map_len     = (size_t)q->num_samples * q->sample_size;
+    if (q->map_len > 0) {
+        void * map = mmap(NULL, q->map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr,"error: capture_open(), could not map '%s'\n", _filename);
+            close(fd);
+            liquid_free(q);
+            return NULL;
+        }
+        q->map = (unsigned char*) map;
+        madvise(q->map, q->map_len, MADV_SEQUENTIAL);
+    }
+    // mapping remains valid after the descriptor is closed
+    close(fd);
+#else
+    q->fid = fopen(_filename, "rb");
+    if (q->fid == NULL) {
+        fprintf(stderr,"error: capture_open(), could not open '%s' for reading\n", _filename);
+        liquid_free(q);
+        return NULL;
+    }
+    fseek(q->fid, 0, SEEK_END);
+    q->num_samples = (unsigned long)ftell(q->fid) / q->sample_size;
+    fseek(q->fid, 0, SEEK_SET);
+#endif
+
+    return q;
+}
+
+// create capture file as a sample sink, truncating any existing file
+//  _filename   :   path to file
+//  _format     :   sample format
+capture capture_create(const char *          _filename,
+                       liquid_capture_format _format)
+{
+    capture_validate_format(_format, "create");
+
+    capture q = (capture) liquid_malloc(sizeof(struct capture_s));
+    memset(q, 0, sizeof(struct capture_s));
+    q->format      = _format;
+    q->sample_size = capture_format_info[_format].sample_size;
+    q->sink        = 1;
+
+    q->fid = fopen(_filename, "wb");
+    if (q->fid == NULL) {
+        fprintf(stderr,"error: capture_create(), could not open '%s' for writing\n", _filename);
+        liquid_free(q);
+        return NULL;
+    }
+
+    return q;
+}
+
+// close capture file and free all internal memory
+void capture_destroy(capture _q)
+{
+#if LIQUID_CAPTURE_MMAP
+    if (_q->map != NULL)
+        munmap(_q->map, _q->map_len);
+#endif
+    if (_q->fid != NULL)
+        fclose(_q->fid);
+    liquid_free(_q->buf);
+    liquid_free(_q);
+}
+
+// print capture object properties
+void capture_print(capture _q)
+{
+    printf("capture [%s, %s, samples: %lu, position: %lu]\n",
+            _q->sink ? "sink" : "source",
+            capture_format_info[_q->format].description,
+            _q->num_samples,
+            _q->index);
+}
+
+// get total number of samples in source, or written to sink
+unsigned long capture_get_num_samples(capture _q)
+{
+    return _q->num_samples;
+}
+
+// get number of samples remaining to be read from source
+unsigned long capture_get_num_remaining(capture _q)
+{
+    return _q->sink ? 0 : _q->num_samples - _q->index;
+}
+
+// move source read position to sample _index
+void capture_seek(capture       _q,
+                  unsigned long _index)
+{
+    if (_q->sink) {
+        fprintf(stderr,"error: capture_seek(), cannot seek on sink\n");
+        exit(1);
+    }
+    _q->index = _index < _q->num_samples ? _index : _q->num_samples;
+    _q->advised  = 0;
+    _q->released = 0;
+#if !LIQUID_CAPTURE_MMAP
+    fseek(_q->fid, (long)(_q->index * _q->sample_size), SEEK_SET);
+#endif
+}
+
+// get raw bytes for the next _n samples of a source and advance;
+// returns number of samples available
+static unsigned int capture_next(capture          _q,
+                                 unsigned int     _n,
+                                 unsigned char ** _raw)
+{
+    if (_q->sink) {
+        fprintf(stderr,"error: capture_read(), cannot read from sink\n");
+        exit(1);
+    }
+    unsigned long remaining = _q->num_samples - _q->index;
+    if (_n > remaining)
+        _n = (unsigned int)remaining;
+    if (_n == 0) {
+        *_raw = NULL;
+        return 0;
+    }
+
+    size_t start = (size_t)_q->index * _q->sample_size;
+    size_t end   = start + (size_t)_n * _q->sample_size;
+#if LIQUID_CAPTURE_MMAP
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    // request pages ahead of the read position
+    if (end + CAPTURE_READAHEAD/2 > _q->advised) {
+        size_t a0 = start & ~(page-1);
+        size_t a1 = end + CAPTURE_READAHEAD;
+        if (a1 > _q->map_len)
+            a1 = _q->map_len;
+        madvise(_q->map + a0, a1 - a0, MADV_WILLNEED);
+        _q->advised = a1;
+    }
+
+    // release pages well behind the read position
+    if (start > _q->released + 2*CAPTURE_READAHEAD) {
+        size_t r1 = (start - CAPTURE_READAHEAD) & ~(page-1);
+        madvise(_q->map + _q->released, r1 - _q->released, MADV_DONTNEED);
+        _q->released = r1;
+    }
+    *_raw = _q->map + start;
+#else
+    capture_reserve_buf(_q, (unsigned int)(end - start));
+    _n = (unsigned int)(fread(_q->buf, _q->sample_size, _n, _q->fid));
+    *_raw = _q->buf;
+#endif
+    _q->index += _n;
+    return _n;
+}
+
+// read block of complex samples from source; for cf32 files the
+// returned view points directly into the mapped file, for ci16 files
+// into an internal buffer. The view is valid until the next read.
+//  _q      :   capture object
+//  _n      :   number of samples requested
+//  _v      :   output view pointer
+//  returns number of samples referenced by _v (0 at end of file)
+unsigned int capture_readcf(capture                 _q,
+                            unsigned int            _n,
+                            liquid_float_complex ** _v)
+{
+    if (!capture_format_info[_q->format].is_complex) {
+        fprintf(stderr,"error: capture_readcf(), source format is real\n");
+        exit(1);
+    }
+
+    unsigned char * raw;
+    unsigned int n = capture_next(_q, _n, &raw);
+    if (n == 0 || _q->format == LIQUID_CAPTURE_CF32) {
+        *_v = (liquid_float_complex*) raw;
+        return n;
+    }
+
+    // ci16: widen into block buffer (may alias raw in fallback path)
+    unsigned int len = n * sizeof(liquid_float_complex);
+    if (raw == _q->buf) {
+        // convert in place, back to front so that each input is read
+        // before its bytes are overwritten
+        capture_reserve_buf(_q, len);
+        const int16_t * x = (const int16_t*) _q->buf;
+        float * y = (float*) _q->buf;
+        unsigned int i;
+        for (i=2*n; i>0; i--)
+            y[i-1] = (float)x[i-1] * (1.0f / 32768.0f);
+    } else {
+        capture_reserve_buf(_q, len);
+        liquid_vectorf_from_s16((const int16_t*)raw, 2*n, 1.0f/32768.0f, (float*)_q->buf);
+    }
+    *_v = (liquid_float_complex*) _q->buf;
+    return n;
+}
+
+// read block of real samples from an f32 source; the returned view
+// points directly into the mapped file and is valid until the next read
+//  _q      :   capture object
+//  _n      :   number of samples requested
+//  _v      :   output view pointer
+//  returns number of samples referenced by _v (0 at end of file)
+unsigned int capture_readf(capture      _q,
+                           unsigned int _n,
+                           float **     _v)
+{
+    if (_q->format != LIQUID_CAPTURE_F32) {
+        fprintf(stderr,"error: capture_readf(), source format is complex\n");
+        exit(1);
+    }
+
+    unsigned char * raw;
+    unsigned int n = capture_next(_q, _n, &raw);
+    *_v = (float*) raw;
+    return n;
+}
+
+// write block of complex samples to a cf32 or ci16 sink; ci16 values
+// are scaled by 32767 and saturated
+void capture_writecf(capture                _q,
+                     liquid_float_complex * _v,
+                     unsigned int           _n)
+{
+    if (!_q->sink || !capture_format_info[_q->format].is_complex) {
+        fprintf(stderr,"error: capture_writecf(), object is not a complex sink\n");
+        exit(1);
+    }
+
+    if (_q->format == LIQUID_CAPTURE_CF32) {
+        fwrite(_v, sizeof(liquid_float_complex), _n, _q->fid);
+    } else {
+        capture_reserve_buf(_q, 4*_n);
+        int16_t * y = (int16_t*) _q->buf;
+        const float * x = (const float*) _v;
+        unsigned int i;
+        for (i=0; i<2*_n; i++) {
+            float s = x[i] * 32767.0f;
+            s = s >  32767.0f ?  32767.0f : s;
+            s = s < -32768.0f ? -32768.0f : s;
+            y[i] = (int16_t) lrintf(s);
+        }
+        fwrite(y, sizeof(int16_t), 2*_n, _q->fid);
+    }
+    _q->num_samples += _n;
+}
+
+// write block of real samples to an f32 sink
+void capture_writef(capture      _q,
+                    float *      _v,
+                    unsigned int _n)
+{
+    if (!_q->sink || _q->format != LIQUID_CAPTURE_F32) {
+        fprintf(stderr,"error: capture_writef(), object is not a real sink\n");
+        exit(1);
+    }
+    fwrite(_v, sizeof(float), _n, _q->fid);
+    _q->num_samples += _n;
+}
+
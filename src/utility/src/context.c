@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Execution contexts: CPU affinity and NUMA-local object memory
+//
+// A context names a CPU (and with it a NUMA node). A thread entering
+// a context is pinned to that CPU and, until it leaves, every object
+// it creates takes its memory (windows, transform buffers, coefficient
+// banks, ...) from a pool bound to the context's node through the
+// allocator hooks, so that a receiver and its buffers stay on one
+// node even when many receivers share a host.
+//
+// The pool carves small blocks from node-bound chunks by size class
+// and keeps released blocks on per-class free lists for reuse; large
+// blocks are mapped individually. Memory is placed with mbind() where
+// available; otherwise pages are placed by the kernel on first touch,
+// which still lands them on the node of a pinned thread.
+//
+
+#if !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_UNISTD_H
+#  include <unistd.h>
+#endif
+
+#if HAVE_SCHED_H
+#  include <sched.h>
+#endif
+#if HAVE_SCHED_H && defined(CPU_SET)
+#  define LIQUID_CONTEXT_AFFINITY 1
+#else
+#  define LIQUID_CONTEXT_AFFINITY 0
+#endif
+
+#if HAVE_SYS_MMAN_H && HAVE_UNISTD_H
+#  define LIQUID_CONTEXT_MMAP 1
+#  include <sys/mman.h>
+#else
+#  define LIQUID_CONTEXT_MMAP 0
+#endif
+
+#if LIQUID_CONTEXT_MMAP && HAVE_SYS_SYSCALL_H
+#  include <sys/syscall.h>
+#endif
+#if LIQUID_CONTEXT_MMAP && defined(SYS_mbind)
+#  define LIQUID_CONTEXT_MBIND 1
+#else
+#  define LIQUID_CONTEXT_MBIND 0
+#endif
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#  include <pthread.h>
+#  define LIQUID_CONTEXT_LOCK 1
+#else
+#  define LIQUID_CONTEXT_LOCK 0
+#endif
+
+// size classes of pooled blocks: 64 bytes to 64 KiB in powers of two;
+// larger blocks are mapped individually
+#define LIQUID_CONTEXT_MIN_SHIFT    (6)
+#define LIQUID_CONTEXT_NUM_CLASSES  (11)
+#define LIQUID_CONTEXT_MAX_BLOCK    (1UL << (LIQUID_CONTEXT_MIN_SHIFT + LIQUID_CONTEXT_NUM_CLASSES - 1))
+
+// size of node-bound chunks carved into pooled blocks
+#define LIQUID_CONTEXT_CHUNK        (1UL << 20)
+
+// block header, sized to keep the standard allocation alignment;
+// pooled blocks record their class, mapped blocks their length
+#define LIQUID_CONTEXT_HEADER       (16)
+#define LIQUID_CONTEXT_MAPPED       (LIQUID_CONTEXT_NUM_CLASSES)
+struct liquid_context_header_s {
+    unsigned long size_class;   // size class, or LIQUID_CONTEXT_MAPPED
+    unsigned long len;          // mapped length (mapped blocks only)
+};
+
+// chunk list node, stored at the start of each chunk
+struct liquid_context_chunk_s {
+    struct liquid_context_chunk_s * next;
+};
+
+struct liquid_context_s {
+    int cpu;                    // cpu threads are pinned to (-1: none)
+    int node;                   // numa node memory is bound to (-1: none)
+    liquid_allocator allocator; // allocator serving the pool
+
+    // pool
+    struct liquid_context_chunk_s * chunks; // chunks, most recent first
+    unsigned char * cur;        // next unused byte of current chunk
+    unsigned char * end;        // end of current chunk
+    void * free_list[LIQUID_CONTEXT_NUM_CLASSES]; // released blocks
+    unsigned long   num_blocks; // blocks outstanding
+    unsigned long   reserved;   // bytes mapped (chunks and large blocks)
+#if LIQUID_CONTEXT_LOCK
+    pthread_mutex_t lock;       // objects may be destroyed on any thread
+#endif
+};
+
+// state saved by liquid_context_enter() for the calling thread
+static LIQUID_THREAD_LOCAL liquid_context           liquid_context_current = NULL;
+static LIQUID_THREAD_LOCAL const liquid_allocator * liquid_context_saved_allocator = NULL;
+#if LIQUID_CONTEXT_AFFINITY
+static LIQUID_THREAD_LOCAL cpu_set_t                liquid_context_saved_mask;
+static LIQUID_THREAD_LOCAL int                      liquid_context_saved_valid = 0;
+#endif
+
+// pool allocator hooks
+void * liquid_context_allocate(unsigned long _size, void * _userdata);
+void   liquid_context_release (void * _ptr, void * _userdata);
+
+//
+// topology
+//
+
+// get number of configured cpus
+unsigned int liquid_get_num_cpus(void)
+{
+#if HAVE_UNISTD_H && defined(_SC_NPROCESSORS_CONF)
+    long n = sysconf(_SC_NPROCESSORS_CONF);
+    return n > 0 ? (unsigned int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+// test whether sysfs path exists
+static int liquid_context_sysfs_exists(const char * _path)
+{
+#if HAVE_UNISTD_H
+    return access(_path, F_OK) == 0;
+#else
+    return 0;
+#endif
+}
+
+// get number of NUMA nodes (1 when the topology is unavailable)
+unsigned int liquid_get_num_numa_nodes(void)
+{
+    char path[64];
+    unsigned int n = 0;
+    while (n < 1024) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%u", n);
+        if (!liquid_context_sysfs_exists(path))
+            break;
+        n++;
+    }
+    return n > 0 ? n : 1;
+}
+
+// get NUMA node of cpu _cpu (0 when the topology is unavailable)
+unsigned int liquid_get_cpu_numa_node(unsigned int _cpu)
+{
+    char path[96];
+    unsigned int num_nodes = liquid_get_num_numa_nodes();
+    unsigned int n;
+    for (n=0; n<num_nodes; n++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpu%u", n, _cpu);
+        if (liquid_context_sysfs_exists(path))
+            return n;
+    }
+    return 0;
+}
+
+// pin calling thread to cpu _cpu, returning 0 on success and -1 if the
+// cpu is not available to this process or affinity is unsupported
+int liquid_set_thread_cpu(unsigned int _cpu)
+{
+#if LIQUID_CONTEXT_AFFINITY
+    if (_cpu >= CPU_SETSIZE)
+        return -1;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(_cpu, &mask);
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0 ? 0 : -1;
+#else
+    return -1;
+#endif
+}
+
+//
+// node-bound memory
+//
+
+// map _len bytes bound to node _node (-1: default policy)
+static void * liquid_context_map(int _node, unsigned long _len)
+{
+#if LIQUID_CONTEXT_MMAP
+    void * p = mmap(NULL, _len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        return NULL;
+#  if LIQUID_CONTEXT_MBIND
+    if (_node >= 0 && _node < 256) {
+        // preferred rather than strict binding: fall back to other
+        // nodes instead of failing when the node is exhausted; failure
+        // (e.g. no NUMA support) leaves first-touch placement
+        unsigned long mask[256/(8*sizeof(unsigned long))];
+        memset(mask, 0x00, sizeof(mask));
+        mask[_node / (8*sizeof(unsigned long))] = 1UL << (_node % (8*sizeof(unsigned long)));
+        syscall(SYS_mbind, p, _len, 1 /* MPOL_PREFERRED */, mask, 8*sizeof(mask), 0);
+    }
+#  endif
+    return p;
+#else
+    return malloc(_len);
+#endif
+}
+
+static void liquid_context_unmap(void * _ptr, unsigned long _len)
+{
+#if LIQUID_CONTEXT_MMAP
+    munmap(_ptr, _len);
+#else
+    free(_ptr);
+#endif
+}
+
+//
+// context object
+//
+
+// create execution context for cpu _cpu; memory is bound to the NUMA
+// node of the cpu. A negative value creates a context which neither
+// pins threads nor binds memory (pooled allocation only).
+liquid_context liquid_context_create(int _cpu)
+{
+    if (_cpu >= (int)liquid_get_num_cpus()) {
+        fprintf(stderr,"error: liquid_context_create(), cpu %d exceeds number of cpus (%u)\n",
+                _cpu, liquid_get_num_cpus());
+        exit(1);
+    }
+
+    liquid_context q = (liquid_context) liquid_malloc(sizeof(struct liquid_context_s));
+    q->cpu  = _cpu < 0 ? -1 : _cpu;
+    q->node = _cpu < 0 ? -1 : (int)liquid_get_cpu_numa_node((unsigned int)_cpu);
+
+    q->allocator.allocate   = liquid_context_allocate;
+    q->allocator.reallocate = NULL;
+    q->allocator.release    = liquid_context_release;
+    q->allocator.userdata   = q;
+
+    q->chunks     = NULL;
+    q->cur        = NULL;
+    q->end        = NULL;
+    q->num_blocks = 0;
+    q->reserved   = 0;
+    memset(q->free_list, 0x00, sizeof(q->free_list));
+#if LIQUID_CONTEXT_LOCK
+    pthread_mutex_init(&q->lock, NULL);
+#endif
+    return q;
+}
+
+// destroy execution context, releasing its pool; all objects created
+// under the context must have been destroyed
+void liquid_context_destroy(liquid_context _q)
+{
+    if (liquid_context_current == _q) {
+        fprintf(stderr,"error: liquid_context_destroy(), context is entered by calling thread\n");
+        exit(1);
+    }
+    if (_q->num_blocks > 0) {
+        // blocks still refer to this allocator: keep the pool mapped
+        fprintf(stderr,"warning: liquid_context_destroy(), %lu blocks still in use; pool not released\n",
+                _q->num_blocks);
+        return;
+    }
+
+    struct liquid_context_chunk_s * c = _q->chunks;
+    while (c != NULL) {
+        struct liquid_context_chunk_s * next = c->next;
+        liquid_context_unmap(c, LIQUID_CONTEXT_CHUNK);
+        c = next;
+    }
+#if LIQUID_CONTEXT_LOCK
+    pthread_mutex_destroy(&_q->lock);
+#endif
+    liquid_free(_q);
+}
+
+// print execution context
+void liquid_context_print(liquid_context _q)
+{
+    printf("liquid_context [cpu: %d, node: %d, blocks: %lu, reserved: %lu bytes]\n",
+            _q->cpu, _q->node, _q->num_blocks, _q->reserved);
+}
+
+// get cpu of context (-1: none)
+int liquid_context_get_cpu(liquid_context _q)
+{
+    return _q->cpu;
+}
+
+// get NUMA node of context (-1: none)
+int liquid_context_get_node(liquid_context _q)
+{
+    return _q->node;
+}
+
+// get number of bytes reserved by the pool
+unsigned long liquid_context_get_memory_usage(liquid_context _q)
+{
+    return sizeof(struct liquid_context_s) + _q->reserved;
+}
+
+// get number of blocks currently allocated from the pool
+unsigned long liquid_context_get_num_blocks(liquid_context _q)
+{
+    return _q->num_blocks;
+}
+
+// enter context on the calling thread: pin the thread to the
+// context's cpu and route library allocations to its pool until
+// liquid_context_leave(); returns 0 if the thread was pinned (or the
+// context has no cpu) and -1 if pinning failed
+int liquid_context_enter(liquid_context _q)
+{
+    if (liquid_context_current != NULL) {
+        fprintf(stderr,"error: liquid_context_enter(), calling thread already entered a context\n");
+        exit(1);
+    }
+
+    int rc = 0;
+#if LIQUID_CONTEXT_AFFINITY
+    liquid_context_saved_valid = 0;
+    if (_q->cpu >= 0) {
+        liquid_context_saved_valid =
+            sched_getaffinity(0, sizeof(cpu_set_t), &liquid_context_saved_mask) == 0;
+        rc = liquid_set_thread_cpu((unsigned int)_q->cpu);
+    }
+#else
+    rc = _q->cpu >= 0 ? -1 : 0;
+#endif
+
+    liquid_context_saved_allocator = liquid_get_thread_allocator();
+    liquid_set_thread_allocator(&_q->allocator);
+    liquid_context_current = _q;
+    return rc;
+}
+
+// leave context entered by the calling thread, restoring its previous
+// cpu affinity and allocator
+void liquid_context_leave(void)
+{
+    if (liquid_context_current == NULL) {
+        fprintf(stderr,"error: liquid_context_leave(), calling thread has not entered a context\n");
+        exit(1);
+    }
+
+#if LIQUID_CONTEXT_AFFINITY
+    if (liquid_context_saved_valid)
+        sched_setaffinity(0, sizeof(cpu_set_t), &liquid_context_saved_mask);
+    liquid_context_saved_valid = 0;
+#endif
+    liquid_set_thread_allocator(liquid_context_saved_allocator);
+    liquid_context_saved_allocator = NULL;
+    liquid_context_current = NULL;
+}
+
+// get context entered by the calling thread (NULL if none)
+liquid_context liquid_context_get_current(void)
+{
+    return liquid_context_current;
+}
+
+//
+// pool allocator
+//
+
+// get size class for block of _size bytes (including header)
+static unsigned int liquid_context_size_class(unsigned long _size)
+{
+    unsigned int k = 0;
+    while ((1UL << (LIQUID_CONTEXT_MIN_SHIFT + k)) < _size)
+        k++;
+    return k;
+}
+
+void * liquid_context_allocate(unsigned long _size, void * _userdata)
+{
+    liquid_context q = (liquid_context) _userdata;
+    unsigned long size = _size + LIQUID_CONTEXT_HEADER;
+    struct liquid_context_header_s * h = NULL;
+
+    // large blocks are mapped individually
+    if (size > LIQUID_CONTEXT_MAX_BLOCK) {
+        unsigned long len = (size + 4095) & ~4095UL;
+        h = (struct liquid_context_header_s*) liquid_context_map(q->node, len);
+        if (h == NULL)
+            return NULL;
+        h->size_class = LIQUID_CONTEXT_MAPPED;
+        h->len        = len;
+#if LIQUID_CONTEXT_LOCK
+        pthread_mutex_lock(&q->lock);
+#endif
+        q->num_blocks++;
+        q->reserved += len;
+#if LIQUID_CONTEXT_LOCK
+        pthread_mutex_unlock(&q->lock);
+#endif
+        return (unsigned char*)h + LIQUID_CONTEXT_HEADER;
+    }
+
+    unsigned int k = liquid_context_size_class(size);
+    unsigned long block = 1UL << (LIQUID_CONTEXT_MIN_SHIFT + k);
+#if LIQUID_CONTEXT_LOCK
+    pthread_mutex_lock(&q->lock);
+#endif
+    if (q->free_list[k] != NULL) {
+        // reuse released block of the same class
+        h = (struct liquid_context_header_s*) q->free_list[k];
+        q->free_list[k] = *(void**)((unsigned char*)h + LIQUID_CONTEXT_HEADER);
+    } else {
+        // carve from current chunk, mapping a new one when exhausted
+        // (chunks start with their list node, padded to the largest
+        // block alignment used here)
+        if (q->cur == NULL || q->cur + block > q->end) {
+            struct liquid_context_chunk_s * c =
+                (struct liquid_context_chunk_s*) liquid_context_map(q->node, LIQUID_CONTEXT_CHUNK);
+            if (c != NULL) {
+                c->next   = q->chunks;
+                q->chunks = c;
+                q->cur    = (unsigned char*)c + 64;
+                q->end    = (unsigned char*)c + LIQUID_CONTEXT_CHUNK;
+                q->reserved += LIQUID_CONTEXT_CHUNK;
+            }
+        }
+        if (q->cur != NULL && q->cur + block <= q->end) {
+            h = (struct liquid_context_header_s*) q->cur;
+            q->cur += block;
+        }
+    }
+    if (h != NULL) {
+        h->size_class = k;
+        q->num_blocks++;
+    }
+#if LIQUID_CONTEXT_LOCK
+    pthread_mutex_unlock(&q->lock);
+#endif
+    return h == NULL ? NULL : (unsigned char*)h + LIQUID_CONTEXT_HEADER;
+}
+
+void liquid_context_release(void * _ptr, void * _userdata)
+{
+    liquid_context q = (liquid_context) _userdata;
+    struct liquid_context_header_s * h =
+        (struct liquid_context_header_s*) ((unsigned char*)_ptr - LIQUID_CONTEXT_HEADER);
+
+#if LIQUID_CONTEXT_LOCK
+    pthread_mutex_lock(&q->lock);
+#endif
+    q->num_blocks--;
+    if (h->size_class == LIQUID_CONTEXT_MAPPED) {
+        q->reserved -= h->len;
+#if LIQUID_CONTEXT_LOCK
+        pthread_mutex_unlock(&q->lock);
+#endif
+        liquid_context_unmap(h, h->len);
+        return;
+    }
+    *(void**)_ptr = q->free_list[h->size_class];
+    q->free_list[h->size_class] = h;
+#if LIQUID_CONTEXT_LOCK
+    pthread_mutex_unlock(&q->lock);
+#endif
+}
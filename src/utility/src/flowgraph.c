@@ -0,0 +1,617 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// flowgraph.c
+//
+// streaming dataflow runtime: blocks connected by bounded lock-free
+// single-producer/single-consumer edges, executed by a pool of worker
+// threads; a worker claims a block exclusively (compare-and-swap) for
+// each call, scanning from its home block and stealing the rest, so
+// stages of the graph run concurrently on different cores
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define FLOWGRAPH_THREADS (1)
+#else
+#define FLOWGRAPH_THREADS (0)
+#endif
+
+// flowgraph_execute() return values
+#define FLOWGRAPH_IDLE      (0) // block not run, or made no progress
+#define FLOWGRAPH_POLLED    (1) // source run without producing
+#define FLOWGRAPH_PROGRESS  (2) // items consumed/produced, or block finished
+
+// edge: bounded ring of fixed-size items; every item is stored twice,
+// at slots k and k+capacity, so that any run of up to capacity items
+// starting anywhere in the ring is contiguous for producer and consumer
+struct flowgraph_edge_s {
+    unsigned char *     buf;        // mirrored storage [2*capacity*item_size]
+    unsigned int        capacity;   // capacity [items], power of 2
+    unsigned int        mask;       // capacity - 1
+    unsigned int        item_size;  // item size [bytes]
+    unsigned long int   head;       // items written (producing block only)
+    unsigned long int   tail;       // items read (consuming block only)
+    unsigned int        src;        // producing block id
+    unsigned int        src_port;   // producing block output port
+    unsigned int        dst;        // consuming block id
+    unsigned int        dst_port;   // consuming block input port
+};
+
+struct flowgraph_block_s {
+    char                name[32];       // block name
+    unsigned int        num_inputs;     // number of input ports
+    unsigned int        in_size;        // input item size [bytes]
+    unsigned int        num_outputs;    // number of output ports
+    unsigned int        out_size;       // output item size [bytes]
+    flowgraph_callback  callback;       // work callback
+    void *              userdata;       // user-defined data
+    void             (* destroy)(void *); // adapter state destructor, or NULL
+
+    struct flowgraph_edge_s ** inputs;  // input edges  [num_inputs]
+    struct flowgraph_edge_s ** outputs; // output edges [num_outputs]
+    void **             x;              // callback input arrays  [num_inputs]
+    unsigned int *      nx;             // callback input counts  [num_inputs]
+    void **             y;              // callback output arrays [num_outputs]
+    unsigned int *      ny;             // callback output counts [num_outputs]
+    unsigned int *      n0;             // counts before call [num_inputs+num_outputs]
+
+    int                 owned;          // claimed by a worker?
+    int                 done;           // finished?
+    int                 stalled;        // last call made no progress?
+    unsigned long int   stamp;          // edge state at last stalled call
+
+    flowgraph_blockstats_s stats;       // execution statistics
+};
+
+// worker thread context
+struct flowgraph_worker_s {
+    struct flowgraph_s * g;             // parent object
+    unsigned int         start;         // first (home) block to scan
+};
+
+struct flowgraph_s {
+    unsigned int                num_threads;    // number of worker threads
+    unsigned int                num_blocks;     // number of blocks
+    struct flowgraph_block_s ** blocks;         // blocks [num_blocks]
+    unsigned int                num_edges;      // number of edges
+    struct flowgraph_edge_s **  edges;          // edges [num_edges]
+    unsigned int                num_done;       // number of finished blocks
+
+#if FLOWGRAPH_THREADS
+    pthread_mutex_t             mutex;          // protects sleeping/waking
+    pthread_cond_t              cv_work;        // signalled on progress
+    unsigned long int           work_seq;       // progress counter
+    unsigned int                num_sleeping;   // workers waiting on cv_work
+#endif
+};
+
+// try to claim block and execute it once, returning FLOWGRAPH_IDLE,
+// FLOWGRAPH_POLLED or FLOWGRAPH_PROGRESS
+int flowgraph_execute(flowgraph    _g,
+                      unsigned int _id);
+
+// execute claimed block once
+int flowgraph_execute_owned(flowgraph                  _g,
+                            struct flowgraph_block_s * _b);
+
+// mirror _n items just written at the edge head into the other half
+// of its storage
+void flowgraph_edge_mirror(struct flowgraph_edge_s * _e,
+                           unsigned int              _n);
+
+// try to execute each block once, starting at _start; returns 1 if any
+// block made progress or a source was polled, 0 otherwise
+int flowgraph_scan(flowgraph    _g,
+                   unsigned int _start);
+
+#if FLOWGRAPH_THREADS
+// worker thread main loop
+void * flowgraph_worker(void * _arg);
+#endif
+
+// create flowgraph
+//  _num_threads    :   number of worker threads; 0 executes blocks in
+//                      the thread calling flowgraph_run()
+flowgraph flowgraph_create(unsigned int _num_threads)
+{
+    flowgraph g = (flowgraph) liquid_malloc(sizeof(struct flowgraph_s));
+    g->num_threads = _num_threads;
+#if !FLOWGRAPH_THREADS
+    if (g->num_threads > 0)
+        fprintf(stderr,"warning: flowgraph_create(), built without pthreads; executing blocks serially\n");
+    g->num_threads = 0;
+#endif
+    g->num_blocks = 0;
+    g->blocks     = NULL;
+    g->num_edges  = 0;
+    g->edges      = NULL;
+    g->num_done   = 0;
+
+#if FLOWGRAPH_THREADS
+    pthread_mutex_init(&g->mutex, NULL);
+    pthread_cond_init(&g->cv_work, NULL);
+    g->work_seq     = 0;
+    g->num_sleeping = 0;
+#endif
+    return g;
+}
+
+// destroy flowgraph, its edges and any adapter state
+void flowgraph_destroy(flowgraph _g)
+{
+    unsigned int i;
+    for (i=0; i<_g->num_blocks; i++) {
+        struct flowgraph_block_s * b = _g->blocks[i];
+        if (b->destroy != NULL)
+            b->destroy(b->userdata);
+        liquid_free(b->inputs);
+        liquid_free(b->outputs);
+        liquid_free(b->x);
+        liquid_free(b->nx);
+        liquid_free(b->y);
+        liquid_free(b->ny);
+        liquid_free(b->n0);
+        liquid_free(b);
+    }
+    for (i=0; i<_g->num_edges; i++) {
+        liquid_free(_g->edges[i]->buf);
+        liquid_free(_g->edges[i]);
+    }
+    liquid_free(_g->blocks);
+    liquid_free(_g->edges);
+
+#if FLOWGRAPH_THREADS
+    pthread_mutex_destroy(&_g->mutex);
+    pthread_cond_destroy(&_g->cv_work);
+#endif
+    liquid_free(_g);
+}
+
+// print flowgraph blocks, edges and block statistics
+void flowgraph_print(flowgraph _g)
+{
+    unsigned int i;
+    printf("flowgraph:\n");
+    printf("    num threads         :   %-u\n", _g->num_threads);
+    printf("    blocks              :   %-u\n", _g->num_blocks);
+    for (i=0; i<_g->num_blocks; i++) {
+        struct flowgraph_block_s * b = _g->blocks[i];
+        printf("    [%3u] %-20s in:%-3u out:%-3u calls:%-10lu consumed:%-12lu produced:%-12lu blocked:%-8lu time:%10.6f s\n",
+                i, b->name, b->num_inputs, b->num_outputs,
+                b->stats.num_calls, b->stats.num_consumed, b->stats.num_produced,
+                b->stats.num_blocked, b->stats.time);
+    }
+    printf("    edges               :   %-u\n", _g->num_edges);
+    for (i=0; i<_g->num_edges; i++) {
+        struct flowgraph_edge_s * e = _g->edges[i];
+        printf("    [%3u] %s:%u -> %s:%u, capacity %u x %u bytes\n",
+                i, _g->blocks[e->src]->name, e->src_port,
+                   _g->blocks[e->dst]->name, e->dst_port,
+                e->capacity, e->item_size);
+    }
+}
+
+// add block with user-defined work callback, returning block id
+//  _g          :   flowgraph
+//  _name       :   block name (for printing)
+//  _num_inputs :   number of input ports
+//  _in_size    :   input item size [bytes]
+//  _num_outputs:   number of output ports
+//  _out_size   :   output item size [bytes]
+//  _callback   :   work callback
+//  _userdata   :   user-defined data passed to callback
+unsigned int flowgraph_add_block(flowgraph          _g,
+                                 const char *       _name,
+                                 unsigned int       _num_inputs,
+                                 unsigned int       _in_size,
+                                 unsigned int       _num_outputs,
+                                 unsigned int       _out_size,
+                                 flowgraph_callback _callback,
+                                 void *             _userdata)
+{
+    // validate input
+    if (_callback == NULL) {
+        fprintf(stderr,"error: flowgraph_add_block(), callback must not be NULL\n");
+        exit(1);
+    } else if ((_num_inputs > 0 && _in_size == 0) || (_num_outputs > 0 && _out_size == 0)) {
+        fprintf(stderr,"error: flowgraph_add_block(), item size must be greater than zero\n");
+        exit(1);
+    }
+
+    struct flowgraph_block_s * b = (struct flowgraph_block_s*) liquid_calloc(1, sizeof(struct flowgraph_block_s));
+    strncpy(b->name, _name == NULL ? "block" : _name, sizeof(b->name)-1);
+    b->num_inputs  = _num_inputs;
+    b->in_size     = _in_size;
+    b->num_outputs = _num_outputs;
+    b->out_size    = _out_size;
+    b->callback    = _callback;
+    b->userdata    = _userdata;
+    b->destroy     = NULL;
+    b->inputs  = (struct flowgraph_edge_s**) liquid_calloc(_num_inputs,  sizeof(struct flowgraph_edge_s*));
+    b->outputs = (struct flowgraph_edge_s**) liquid_calloc(_num_outputs, sizeof(struct flowgraph_edge_s*));
+    b->x  = (void**)        liquid_malloc(_num_inputs *sizeof(void*));
+    b->nx = (unsigned int*) liquid_malloc(_num_inputs *sizeof(unsigned int));
+    b->y  = (void**)        liquid_malloc(_num_outputs*sizeof(void*));
+    b->ny = (unsigned int*) liquid_malloc(_num_outputs*sizeof(unsigned int));
+    b->n0 = (unsigned int*) liquid_malloc((_num_inputs+_num_outputs)*sizeof(unsigned int));
+
+    _g->blocks = (struct flowgraph_block_s**) liquid_realloc(_g->blocks,
+                        (_g->num_blocks+1)*sizeof(struct flowgraph_block_s*));
+    _g->blocks[_g->num_blocks] = b;
+    return _g->num_blocks++;
+}
+
+// attach adapter state to block, released with _destroy() when the
+// graph is destroyed
+void flowgraph_set_block_state(flowgraph    _g,
+                               unsigned int _id,
+                               void (*_destroy)(void *))
+{
+    _g->blocks[_id]->destroy = _destroy;
+}
+
+// connect output port of one block to input port of another
+//  _g          :   flowgraph
+//  _src        :   producing block id
+//  _src_port   :   producing block output port
+//  _dst        :   consuming block id
+//  _dst_port   :   consuming block input port
+//  _capacity   :   edge capacity [items] (rounded up to power of 2)
+void flowgraph_connect(flowgraph    _g,
+                       unsigned int _src,
+                       unsigned int _src_port,
+                       unsigned int _dst,
+                       unsigned int _dst_port,
+                       unsigned int _capacity)
+{
+    // validate input
+    if (_src >= _g->num_blocks || _dst >= _g->num_blocks) {
+        fprintf(stderr,"error: flowgraph_connect(), block id out of range\n");
+        exit(1);
+    }
+    struct flowgraph_block_s * bs = _g->blocks[_src];
+    struct flowgraph_block_s * bd = _g->blocks[_dst];
+    if (_src_port >= bs->num_outputs || _dst_port >= bd->num_inputs) {
+        fprintf(stderr,"error: flowgraph_connect(), port out of range\n");
+        exit(1);
+    } else if (bs->outputs[_src_port] != NULL || bd->inputs[_dst_port] != NULL) {
+        fprintf(stderr,"error: flowgraph_connect(), port already connected\n");
+        exit(1);
+    } else if (bs->out_size != bd->in_size) {
+        fprintf(stderr,"error: flowgraph_connect(), item size mismatch (%u, %u) between '%s' and '%s'\n",
+                bs->out_size, bd->in_size, bs->name, bd->name);
+        exit(1);
+    } else if (_capacity == 0) {
+        fprintf(stderr,"error: flowgraph_connect(), capacity must be greater than zero\n");
+        exit(1);
+    }
+
+    struct flowgraph_edge_s * e = (struct flowgraph_edge_s*) liquid_malloc(sizeof(struct flowgraph_edge_s));
+    e->capacity  = 1 << liquid_nextpow2(_capacity);
+    e->mask      = e->capacity - 1;
+    e->item_size = bs->out_size;
+    e->buf       = (unsigned char*) liquid_malloc(2*e->capacity*e->item_size);
+    e->head      = 0;
+    e->tail      = 0;
+    e->src       = _src;
+    e->src_port  = _src_port;
+    e->dst       = _dst;
+    e->dst_port  = _dst_port;
+    bs->outputs[_src_port] = e;
+    bd->inputs [_dst_port] = e;
+
+    _g->edges = (struct flowgraph_edge_s**) liquid_realloc(_g->edges,
+                        (_g->num_edges+1)*sizeof(struct flowgraph_edge_s*));
+    _g->edges[_g->num_edges++] = e;
+}
+
+// get number of blocks
+unsigned int flowgraph_get_num_blocks(flowgraph _g)
+{
+    return _g->num_blocks;
+}
+
+// get number of worker threads
+unsigned int flowgraph_get_num_threads(flowgraph _g)
+{
+    return _g->num_threads;
+}
+
+// run graph until every block has finished
+void flowgraph_run(flowgraph _g)
+{
+    // every port must be connected
+    unsigned int i, j;
+    for (i=0; i<_g->num_blocks; i++) {
+        struct flowgraph_block_s * b = _g->blocks[i];
+        for (j=0; j<b->num_inputs; j++) {
+            if (b->inputs[j] == NULL) {
+                fprintf(stderr,"error: flowgraph_run(), input %u of block '%s' not connected\n", j, b->name);
+                exit(1);
+            }
+        }
+        for (j=0; j<b->num_outputs; j++) {
+            if (b->outputs[j] == NULL) {
+                fprintf(stderr,"error: flowgraph_run(), output %u of block '%s' not connected\n", j, b->name);
+                exit(1);
+            }
+        }
+    }
+
+    unsigned int num_threads = _g->num_threads < _g->num_blocks ? _g->num_threads : _g->num_blocks;
+    if (num_threads == 0) {
+        // execute blocks in calling thread
+        while (_g->num_done < _g->num_blocks) {
+            if (!flowgraph_scan(_g, 0)) {
+                fprintf(stderr,"error: flowgraph_run(), deadlock: no block can make progress\n");
+                exit(1);
+            }
+        }
+        return;
+    }
+
+#if FLOWGRAPH_THREADS
+    // spread workers' home blocks evenly; each steals from the rest
+    pthread_t threads[num_threads];
+    struct flowgraph_worker_s w[num_threads];
+    _g->num_threads = num_threads;
+    for (i=0; i<num_threads; i++) {
+        w[i].g     = _g;
+        w[i].start = (i*_g->num_blocks) / num_threads;
+        if (pthread_create(&threads[i], NULL, flowgraph_worker, &w[i]) != 0) {
+            fprintf(stderr,"error: flowgraph_run(), could not create thread\n");
+            exit(1);
+        }
+    }
+    for (i=0; i<num_threads; i++)
+        pthread_join(threads[i], NULL);
+#endif
+}
+
+// get block execution statistics
+void flowgraph_get_blockstats(flowgraph                _g,
+                              unsigned int             _id,
+                              flowgraph_blockstats_s * _stats)
+{
+    if (_id >= _g->num_blocks) {
+        fprintf(stderr,"error: flowgraph_get_blockstats(), block id out of range\n");
+        exit(1);
+    }
+    *_stats = _g->blocks[_id]->stats;
+}
+
+//
+// internal methods
+//
+
+// try to claim block and execute it once, returning FLOWGRAPH_IDLE,
+// FLOWGRAPH_POLLED or FLOWGRAPH_PROGRESS
+int flowgraph_execute(flowgraph    _g,
+                      unsigned int _id)
+{
+    struct flowgraph_block_s * b = _g->blocks[_id];
+    int expected = 0;
+    if (__atomic_load_n(&b->done,  __ATOMIC_RELAXED) ||
+        __atomic_load_n(&b->owned, __ATOMIC_RELAXED) ||
+        !__atomic_compare_exchange_n(&b->owned, &expected, 1, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return FLOWGRAPH_IDLE;
+    }
+
+    int rc = b->done ? FLOWGRAPH_IDLE : flowgraph_execute_owned(_g, b);
+    __atomic_store_n(&b->owned, 0, __ATOMIC_RELEASE);
+
+#if FLOWGRAPH_THREADS
+    // wake sleeping workers
+    if (rc == FLOWGRAPH_PROGRESS) {
+        __atomic_add_fetch(&_g->work_seq, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&_g->num_sleeping, __ATOMIC_SEQ_CST) > 0) {
+            pthread_mutex_lock(&_g->mutex);
+            pthread_cond_broadcast(&_g->cv_work);
+            pthread_mutex_unlock(&_g->mutex);
+        }
+    }
+#endif
+    return rc;
+}
+
+// execute claimed block once
+int flowgraph_execute_owned(flowgraph                  _g,
+                            struct flowgraph_block_s * _b)
+{
+    unsigned int i;
+
+    // snapshot inputs; a producer's done flag is read before its edge
+    // head so that its final items are seen
+    unsigned long int stamp = 0;
+    unsigned int num_finished = 0;
+    unsigned int num_avail = 0;
+    for (i=0; i<_b->num_inputs; i++) {
+        struct flowgraph_edge_s * e = _b->inputs[i];
+        if (__atomic_load_n(&_g->blocks[e->src]->done, __ATOMIC_ACQUIRE))
+            num_finished++;
+        unsigned long int head = __atomic_load_n(&e->head, __ATOMIC_ACQUIRE);
+        _b->nx[i] = _b->n0[i] = head - e->tail;
+        _b->x[i]  = e->buf + (e->tail & e->mask)*e->item_size;
+        num_avail += _b->nx[i];
+        stamp += head;
+    }
+    int finished = _b->num_inputs > 0 && num_finished == _b->num_inputs;
+    stamp += num_finished;
+
+    // snapshot outputs; edges whose consumer has finished are drained
+    // here so they never hold back the producer
+    int full = 0;
+    for (i=0; i<_b->num_outputs; i++) {
+        struct flowgraph_edge_s * e = _b->outputs[i];
+        if (__atomic_load_n(&_g->blocks[e->dst]->done, __ATOMIC_ACQUIRE))
+            __atomic_store_n(&e->tail, e->head, __ATOMIC_RELAXED);
+        unsigned long int tail = __atomic_load_n(&e->tail, __ATOMIC_ACQUIRE);
+        _b->ny[i] = _b->n0[_b->num_inputs+i] = e->capacity - (e->head - tail);
+        _b->y[i]  = e->buf + (e->head & e->mask)*e->item_size;
+        full |= _b->ny[i] == 0;
+        stamp += tail;
+    }
+
+    // nothing to consume yet
+    if (_b->num_inputs > 0 && num_avail == 0 && !finished)
+        return FLOWGRAPH_IDLE;
+
+    // backpressure: wait for every output to have space
+    if (full) {
+        _b->stats.num_blocked++;
+        return FLOWGRAPH_IDLE;
+    }
+
+    // last call made no progress and nothing has changed since
+    if (_b->stalled && _b->stamp == stamp && _b->num_inputs > 0)
+        return FLOWGRAPH_IDLE;
+
+    double t0 = frameperfstats_time();
+    int rc = _b->callback(_b->userdata, _b->x, _b->nx, _b->y, _b->ny);
+    _b->stats.time += frameperfstats_time() - t0;
+    _b->stats.num_calls++;
+
+    // release consumed items, publish produced items
+    unsigned long int num_consumed = 0;
+    unsigned long int num_produced = 0;
+    for (i=0; i<_b->num_inputs; i++) {
+        if (_b->nx[i] > _b->n0[i]) {
+            fprintf(stderr,"error: flowgraph_run(), block '%s' consumed more than available\n", _b->name);
+            exit(1);
+        }
+        struct flowgraph_edge_s * e = _b->inputs[i];
+        __atomic_store_n(&e->tail, e->tail + _b->nx[i], __ATOMIC_RELEASE);
+        num_consumed += _b->nx[i];
+    }
+    for (i=0; i<_b->num_outputs; i++) {
+        if (_b->ny[i] > _b->n0[_b->num_inputs+i]) {
+            fprintf(stderr,"error: flowgraph_run(), block '%s' produced more than space available\n", _b->name);
+            exit(1);
+        }
+        // output filled: block was held back by its consumer
+        full |= _b->ny[i] == _b->n0[_b->num_inputs+i];
+        struct flowgraph_edge_s * e = _b->outputs[i];
+        if (_b->ny[i] == 0)
+            continue;
+        flowgraph_edge_mirror(e, _b->ny[i]);
+        __atomic_store_n(&e->head, e->head + _b->ny[i], __ATOMIC_RELEASE);
+        num_produced += _b->ny[i];
+    }
+    _b->stats.num_consumed += num_consumed;
+    _b->stats.num_produced += num_produced;
+    _b->stats.num_blocked  += full;
+    int progress = num_consumed + num_produced > 0;
+
+    // finished: source/sink requested it, or producers have finished
+    // and the block no longer consumes
+    if (rc == LIQUID_FLOWGRAPH_DONE || (finished && !progress)) {
+        __atomic_store_n(&_b->done, 1, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&_g->num_done, 1, __ATOMIC_SEQ_CST);
+        return FLOWGRAPH_PROGRESS;
+    }
+
+    _b->stalled = !progress;
+    _b->stamp   = stamp;
+    if (progress)
+        return FLOWGRAPH_PROGRESS;
+    return _b->num_inputs == 0 ? FLOWGRAPH_POLLED : FLOWGRAPH_IDLE;
+}
+
+// mirror _n items just written at the edge head into the other half
+// of its storage
+void flowgraph_edge_mirror(struct flowgraph_edge_s * _e,
+                           unsigned int              _n)
+{
+    unsigned int k = _e->head & _e->mask;
+    unsigned int c = _e->capacity;
+    unsigned int s = _e->item_size;
+
+    // items written below capacity are copied up, the rest copied down
+    unsigned int n0 = k + _n <= c ? _n : c - k;
+    memcpy(_e->buf + (k+c)*s, _e->buf + k*s, n0*s);
+    if (n0 < _n)
+        memcpy(_e->buf, _e->buf + c*s, (_n-n0)*s);
+}
+
+// try to execute each block once, starting at _start; returns 1 if any
+// block made progress or a source was polled, 0 otherwise
+int flowgraph_scan(flowgraph    _g,
+                   unsigned int _start)
+{
+    int rc = 0;
+    unsigned int i;
+    unsigned int id = _start;
+    for (i=0; i<_g->num_blocks; i++) {
+        if (flowgraph_execute(_g, id) != FLOWGRAPH_IDLE)
+            rc = 1;
+        id = (id + 1 == _g->num_blocks) ? 0 : id + 1;
+    }
+    return rc;
+}
+
+#if FLOWGRAPH_THREADS
+// worker thread main loop: execute blocks starting from home block,
+// stealing from the others, and sleep when nothing changed; if every
+// worker is asleep with no progress since, no block can ever run
+void * flowgraph_worker(void * _arg)
+{
+    struct flowgraph_worker_s * w = (struct flowgraph_worker_s*) _arg;
+    flowgraph g = w->g;
+
+    while (__atomic_load_n(&g->num_done, __ATOMIC_SEQ_CST) < g->num_blocks) {
+        unsigned long int seq = __atomic_load_n(&g->work_seq, __ATOMIC_SEQ_CST);
+        if (flowgraph_scan(g, w->start))
+            continue;
+
+        pthread_mutex_lock(&g->mutex);
+        __atomic_add_fetch(&g->num_sleeping, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&g->work_seq, __ATOMIC_SEQ_CST) == seq &&
+               __atomic_load_n(&g->num_done, __ATOMIC_SEQ_CST) < g->num_blocks)
+        {
+            if (__atomic_load_n(&g->num_sleeping, __ATOMIC_SEQ_CST) == g->num_threads) {
+                fprintf(stderr,"error: flowgraph_run(), deadlock: no block can make progress\n");
+                exit(1);
+            }
+            pthread_cond_wait(&g->cv_work, &g->mutex);
+        }
+        __atomic_sub_fetch(&g->num_sleeping, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&g->mutex);
+    }
+
+    // wake remaining workers so they can exit
+    pthread_mutex_lock(&g->mutex);
+    pthread_cond_broadcast(&g->cv_work);
+    pthread_mutex_unlock(&g->mutex);
+    return NULL;
+}
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// flowgraph_blocks.c
+//
+// flowgraph block adapters around the *_execute_block() methods of
+// existing objects; each adapter processes as many items as the input
+// and output edges allow in a single call
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// number of channelizer transforms per firpfbch2 adapter call
+#define FLOWGRAPH_FIRPFBCH2_CHUNK (64)
+
+// channelizer adapter state
+struct flowgraph_firpfbch2_s {
+    firpfbch2_crcf  q;          // analysis channelizer
+    unsigned int    M;          // number of channels
+    float complex * buf;        // interleaved output [CHUNK x M]
+};
+
+static void flowgraph_firpfbch2_destroy(void * _userdata)
+{
+    struct flowgraph_firpfbch2_s * s = (struct flowgraph_firpfbch2_s*) _userdata;
+    liquid_free(s->buf);
+    liquid_free(s);
+}
+
+static int flowgraph_agc_crcf_callback(void *         _userdata,
+                                       void **        _x,
+                                       unsigned int * _nx,
+                                       void **        _y,
+                                       unsigned int * _ny)
+{
+    unsigned int n = _nx[0] < _ny[0] ? _nx[0] : _ny[0];
+    agc_crcf_execute_block((agc_crcf)_userdata, (float complex*)_x[0], n, (float complex*)_y[0]);
+    _nx[0] = _ny[0] = n;
+    return 0;
+}
+
+static int flowgraph_nco_crcf_mix_up_callback(void *         _userdata,
+                                              void **        _x,
+                                              unsigned int * _nx,
+                                              void **        _y,
+                                              unsigned int * _ny)
+{
+    unsigned int n = _nx[0] < _ny[0] ? _nx[0] : _ny[0];
+    nco_crcf_mix_block_up((nco_crcf)_userdata, (float complex*)_x[0], (float complex*)_y[0], n);
+    _nx[0] = _ny[0] = n;
+    return 0;
+}
+
+static int flowgraph_nco_crcf_mix_down_callback(void *         _userdata,
+                                                void **        _x,
+                                                unsigned int * _nx,
+                                                void **        _y,
+                                                unsigned int * _ny)
+{
+    unsigned int n = _nx[0] < _ny[0] ? _nx[0] : _ny[0];
+    nco_crcf_mix_block_down((nco_crcf)_userdata, (float complex*)_x[0], (float complex*)_y[0], n);
+    _nx[0] = _ny[0] = n;
+    return 0;
+}
+
+static int flowgraph_firfilt_crcf_callback(void *         _userdata,
+                                           void **        _x,
+                                           unsigned int * _nx,
+                                           void **        _y,
+                                           unsigned int * _ny)
+{
+    unsigned int n = _nx[0] < _ny[0] ? _nx[0] : _ny[0];
+    firfilt_crcf_execute_block((firfilt_crcf)_userdata, (float complex*)_x[0], n, (float complex*)_y[0]);
+    _nx[0] = _ny[0] = n;
+    return 0;
+}
+
+// resampler output is bounded by 2*rate*n + 2 samples for n inputs
+// (each half-band stage and the arbitrary stage emit at most twice
+// their nominal rate, plus one sample held in the stage buffers)
+static int flowgraph_msresamp_crcf_callback(void *         _userdata,
+                                            void **        _x,
+                                            unsigned int * _nx,
+                                            void **        _y,
+                                            unsigned int * _ny)
+{
+    msresamp_crcf q = (msresamp_crcf)_userdata;
+    float r = msresamp_crcf_get_rate(q);
+    unsigned int n = _ny[0] <= 2 ? 0 : (unsigned int)((float)(_ny[0] - 2) / (2.0f*r));
+    if (n > _nx[0])
+        n = _nx[0];
+    unsigned int num_written = 0;
+    if (n > 0)
+        msresamp_crcf_execute(q, (float complex*)_x[0], n, (float complex*)_y[0], &num_written);
+    _nx[0] = n;
+    _ny[0] = num_written;
+    return 0;
+}
+
+static int flowgraph_flexframesync_callback(void *         _userdata,
+                                            void **        _x,
+                                            unsigned int * _nx,
+                                            void **        _y,
+                                            unsigned int * _ny)
+{
+    if (_nx[0] > 0)
+        flexframesync_execute((flexframesync)_userdata, (float complex*)_x[0], _nx[0]);
+    return 0;
+}
+
+// analysis channelizer: M/2 input samples per transform, one sample to
+// each of the M channel outputs
+static int flowgraph_firpfbch2_callback(void *         _userdata,
+                                        void **        _x,
+                                        unsigned int * _nx,
+                                        void **        _y,
+                                        unsigned int * _ny)
+{
+    struct flowgraph_firpfbch2_s * s = (struct flowgraph_firpfbch2_s*) _userdata;
+    unsigned int M = s->M;
+    unsigned int i, c;
+
+    // number of transforms limited by input, every output, and buffer
+    unsigned int n = _nx[0] / (M/2);
+    for (c=0; c<M; c++)
+        n = _ny[c] < n ? _ny[c] : n;
+    if (n > FLOWGRAPH_FIRPFBCH2_CHUNK)
+        n = FLOWGRAPH_FIRPFBCH2_CHUNK;
+
+    firpfbch2_crcf_execute_block(s->q, (float complex*)_x[0], n, s->buf);
+
+    // de-interleave channels
+    for (c=0; c<M; c++) {
+        float complex * y = (float complex*) _y[c];
+        for (i=0; i<n; i++)
+            y[i] = s->buf[i*M + c];
+        _ny[c] = n;
+    }
+    _nx[0] = n*(M/2);
+    return 0;
+}
+
+// add automatic gain control block
+unsigned int flowgraph_add_agc_crcf(flowgraph _g,
+                                    agc_crcf  _q)
+{
+    return flowgraph_add_block(_g, "agc_crcf", 1, sizeof(float complex), 1, sizeof(float complex),
+                               flowgraph_agc_crcf_callback, _q);
+}
+
+// add oscillator block mixing samples up by the NCO phase
+unsigned int flowgraph_add_nco_crcf_mix_up(flowgraph _g,
+                                           nco_crcf  _q)
+{
+    return flowgraph_add_block(_g, "nco_crcf_mix_up", 1, sizeof(float complex), 1, sizeof(float complex),
+                               flowgraph_nco_crcf_mix_up_callback, _q);
+}
+
+// add oscillator block mixing samples down by the NCO phase
+unsigned int flowgraph_add_nco_crcf_mix_down(flowgraph _g,
+                                             nco_crcf  _q)
+{
+    return flowgraph_add_block(_g, "nco_crcf_mix_down", 1, sizeof(float complex), 1, sizeof(float complex),
+                               flowgraph_nco_crcf_mix_down_callback, _q);
+}
+
+// add filter block
+unsigned int flowgraph_add_firfilt_crcf(flowgraph    _g,
+                                        firfilt_crcf _q)
+{
+    return flowgraph_add_block(_g, "firfilt_crcf", 1, sizeof(float complex), 1, sizeof(float complex),
+                               flowgraph_firfilt_crcf_callback, _q);
+}
+
+// add multi-stage resampler block; output edge capacity must exceed
+// 2*rate + 2 samples
+unsigned int flowgraph_add_msresamp_crcf(flowgraph     _g,
+                                         msresamp_crcf _q)
+{
+    return flowgraph_add_block(_g, "msresamp_crcf", 1, sizeof(float complex), 1, sizeof(float complex),
+                               flowgraph_msresamp_crcf_callback, _q);
+}
+
+// add frame synchronizer sink block
+unsigned int flowgraph_add_flexframesync(flowgraph     _g,
+                                         flexframesync _q)
+{
+    return flowgraph_add_block(_g, "flexframesync", 1, sizeof(float complex), 0, 0,
+                               flowgraph_flexframesync_callback, _q);
+}
+
+// add analysis channelizer block: input edge capacity must be at least
+// M/2 samples
+unsigned int flowgraph_add_firpfbch2_crcf(flowgraph      _g,
+                                          firpfbch2_crcf _q)
+{
+    if (firpfbch2_crcf_get_type(_q) != LIQUID_ANALYZER) {
+        fprintf(stderr,"error: flowgraph_add_firpfbch2_crcf(), channelizer must be an analyzer\n");
+        exit(1);
+    }
+    struct flowgraph_firpfbch2_s * s = (struct flowgraph_firpfbch2_s*) liquid_malloc(sizeof(struct flowgraph_firpfbch2_s));
+    s->q   = _q;
+    s->M   = firpfbch2_crcf_get_M(_q);
+    s->buf = (float complex*) liquid_malloc(FLOWGRAPH_FIRPFBCH2_CHUNK*s->M*sizeof(float complex));
+
+    unsigned int id = flowgraph_add_block(_g, "firpfbch2_crcf", 1, sizeof(float complex), s->M, sizeof(float complex),
+                                          flowgraph_firpfbch2_callback, s);
+    flowgraph_set_block_state(_g, id, flowgraph_firpfbch2_destroy);
+    return id;
+}
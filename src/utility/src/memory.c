@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Library memory allocation
+//
+// All library allocations are made through liquid_malloc() and
+// friends, which route them to a user-defined allocator: the allocator
+// set for the calling thread if any, otherwise the global allocator
+// (the standard library by default). Each block records the allocator
+// it came from and its size in a small header, so memory is always
+// returned to the allocator that provided it regardless of the thread
+// or allocator in effect when it is released, and allocators need not
+// implement reallocation.
+//
+// An audit mode counts (and optionally reports) every allocation and
+// release made by the calling thread, e.g. to verify that real-time processing loops do
+// not touch the allocator.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// block header, sized to keep the standard allocation alignment
+#define LIQUID_MEMORY_HEADER (16)
+struct liquid_memory_header_s {
+    const liquid_allocator * a;     // allocator providing the block
+    unsigned long size;             // capacity of the block (bytes)
+};
+
+// standard library allocator
+static void * liquid_memory_std_allocate(unsigned long _size, void * _userdata)
+{
+    return malloc(_size);
+}
+static void * liquid_memory_std_reallocate(void * _ptr, unsigned long _size, void * _userdata)
+{
+    return realloc(_ptr, _size);
+}
+static void liquid_memory_std_release(void * _ptr, void * _userdata)
+{
+    free(_ptr);
+}
+static const liquid_allocator liquid_memory_std = {
+    liquid_memory_std_allocate,
+    liquid_memory_std_reallocate,
+    liquid_memory_std_release,
+    NULL
+};
+
+static const liquid_allocator * volatile liquid_memory_global = &liquid_memory_std;
+
+static LIQUID_THREAD_LOCAL const liquid_allocator * liquid_memory_thread = NULL;
+static LIQUID_THREAD_LOCAL int           liquid_memory_audit_enabled = 0;
+static LIQUID_THREAD_LOCAL int           liquid_memory_audit_report  = 0;
+static LIQUID_THREAD_LOCAL unsigned long liquid_memory_audit_count   = 0;
+
+// set global allocator for all library allocations, or restore the
+// standard library allocator if _a is NULL
+void liquid_set_allocator(const liquid_allocator * _a)
+{
+    if (_a != NULL && (_a->allocate == NULL || _a->release == NULL)) {
+        fprintf(stderr,"error: liquid_set_allocator(), allocate and release functions required\n");
+        exit(1);
+    }
+    liquid_memory_global = _a == NULL ? &liquid_memory_std : _a;
+}
+
+// set allocator for library allocations made by the calling thread,
+// overriding the global allocator, or clear it if _a is NULL
+void liquid_set_thread_allocator(const liquid_allocator * _a)
+{
+    if (_a != NULL && (_a->allocate == NULL || _a->release == NULL)) {
+        fprintf(stderr,"error: liquid_set_thread_allocator(), allocate and release functions required\n");
+        exit(1);
+    }
+    liquid_memory_thread = _a;
+}
+
+// get allocator set for the calling thread (NULL if none)
+const liquid_allocator * liquid_get_thread_allocator(void)
+{
+    return liquid_memory_thread;
+}
+
+// start counting allocations made by the calling thread, reporting
+// each one if _report is set
+void liquid_allocator_audit_begin(int _report)
+{
+    liquid_memory_audit_enabled = 1;
+    liquid_memory_audit_report  = _report;
+    liquid_memory_audit_count   = 0;
+}
+
+// stop counting allocations made by the calling thread, returning
+// the number of allocations and releases since the audit began
+unsigned long liquid_allocator_audit_end(void)
+{
+    liquid_memory_audit_enabled = 0;
+    return liquid_memory_audit_count;
+}
+
+// report call made during an audit
+static void liquid_memory_audit(const char * _method, unsigned long _size)
+{
+    liquid_memory_audit_count++;
+    if (liquid_memory_audit_report)
+        fprintf(stderr,"warning: liquid allocator audit, %s(%lu) called\n", _method, _size);
+}
+
+// allocate block of _size bytes through the current allocator
+void * liquid_malloc(size_t _size)
+{
+    if (liquid_memory_audit_enabled)
+        liquid_memory_audit("liquid_malloc", _size);
+
+    const liquid_allocator * a = liquid_memory_thread != NULL ? liquid_memory_thread : liquid_memory_global;
+    unsigned char * p = (unsigned char*) a->allocate(LIQUID_MEMORY_HEADER + _size, a->userdata);
+    if (p == NULL) {
+        fprintf(stderr,"error: liquid_malloc(), could not allocate %zu bytes\n", _size);
+        exit(1);
+    }
+    struct liquid_memory_header_s * h = (struct liquid_memory_header_s*) p;
+    h->a    = a;
+    h->size = _size;
+    return p + LIQUID_MEMORY_HEADER;
+}
+
+// allocate zeroed block of _num elements of _size bytes
+void * liquid_calloc(size_t _num,
+                     size_t _size)
+{
+    void * p = liquid_malloc(_num*_size);
+    memset(p, 0x00, _num*_size);
+    return p;
+}
+
+// resize block, preserving its contents and its allocator; blocks
+// keep their capacity when shrunk, so buffers resized on each
+// reconfiguration stop allocating once they reach their largest size
+void * liquid_realloc(void * _ptr,
+                      size_t _size)
+{
+    if (_ptr == NULL)
+        return liquid_malloc(_size);
+
+    unsigned char * p = (unsigned char*)_ptr - LIQUID_MEMORY_HEADER;
+    struct liquid_memory_header_s * h = (struct liquid_memory_header_s*) p;
+    unsigned long size = h->size;
+    if (_size <= size)
+        return _ptr;
+
+    if (liquid_memory_audit_enabled)
+        liquid_memory_audit("liquid_realloc", _size);
+
+    const liquid_allocator * a = h->a;
+    if (a->reallocate != NULL) {
+        p = (unsigned char*) a->reallocate(p, LIQUID_MEMORY_HEADER + _size, a->userdata);
+    } else {
+        unsigned char * q = (unsigned char*) a->allocate(LIQUID_MEMORY_HEADER + _size, a->userdata);
+        if (q != NULL) {
+            memmove(q, p, LIQUID_MEMORY_HEADER + size);
+            a->release(p, a->userdata);
+        }
+        p = q;
+    }
+    if (p == NULL) {
+        fprintf(stderr,"error: liquid_realloc(), could not allocate %zu bytes\n", _size);
+        exit(1);
+    }
+    ((struct liquid_memory_header_s*) p)->size = _size;
+    return p + LIQUID_MEMORY_HEADER;
+}
+
+// release block to the allocator that provided it
+void liquid_free(void * _ptr)
+{
+    if (_ptr == NULL)
+        return;
+
+    unsigned char * p = (unsigned char*)_ptr - LIQUID_MEMORY_HEADER;
+    struct liquid_memory_header_s * h = (struct liquid_memory_header_s*) p;
+    if (liquid_memory_audit_enabled)
+        liquid_memory_audit("liquid_free", h->size);
+    h->a->release(p, h->a->userdata);
+}
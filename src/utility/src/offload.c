@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Accelerator offload queue
+//
+// Batched kernels which dominate wideband receivers (batched FFTs,
+// polyphase filtering as a matrix product, multi-hypothesis frequency
+// domain correlation) are submitted to a queue and executed
+// asynchronously by a backend, so that the caller can continue with
+// demodulation and decoding while they run. A backend is a table of
+// kernel entry points and host buffer allocators: an accelerator
+// implementation provides pinned or zero-copy host memory and enqueues
+// device work; the built-in backend runs the kernels on the host.
+//
+// Jobs are executed in submission order by a single worker thread
+// (synchronously at submission when threads are unavailable); job
+// tickets increase monotonically so waiting for a ticket also waits for
+// every job submitted before it.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define OFFLOAD_THREAD (1)
+#else
+#define OFFLOAD_THREAD (0)
+#endif
+
+// maximum number of jobs queued at once; submission blocks when full
+#define OFFLOAD_QUEUE_LEN   (64)
+
+// job types
+enum {
+    OFFLOAD_JOB_FFT=0,      // batched transform
+    OFFLOAD_JOB_PFB,        // polyphase filter matrix product
+    OFFLOAD_JOB_XCORR,      // multi-hypothesis correlation
+};
+
+struct offload_job_s {
+    int type;               // job type
+    int dir;                // transform direction
+    unsigned int n;         // transform/correlation length, or rows (pfb)
+    unsigned int num;       // number of transforms/hypotheses, or columns (pfb)
+    unsigned int k;         // inner dimension (pfb)
+    const void * a;         // input: x (fft), H (pfb), X (xcorr)
+    const void * b;         // input: X (pfb), S (xcorr)
+    const int *  offsets;   // hypotheses (xcorr)
+    liquid_float_complex * y; // output
+};
+
+struct liquid_offload_s {
+    liquid_offload_backend backend; // kernel table
+    struct offload_job_s jobs[OFFLOAD_QUEUE_LEN]; // job ring
+    unsigned long submitted;        // jobs submitted (tickets issued)
+    unsigned long completed;        // jobs completed
+    int           thread;           // worker thread running?
+#if OFFLOAD_THREAD
+    pthread_t       worker;         // worker thread
+    pthread_mutex_t mutex;          // protects counters
+    pthread_cond_t  cv_submit;      // signalled on submit/stop
+    pthread_cond_t  cv_complete;    // signalled on job completion
+    int             stop;           // thread exit request
+#endif
+};
+
+#if OFFLOAD_THREAD
+void * liquid_offload_worker(void * _arg);
+#endif
+
+//
+// built-in (host) backend
+//
+
+// host backend state: single-entry plan caches so that repeated jobs
+// of one shape (the common case) do not re-plan; plans are created and
+// destroyed on the worker thread, which is safe as the shared FFT
+// tables and wisdom are locked
+struct offload_host_s {
+    fftplan      fft;       // batched transform plan
+    unsigned int fft_n, fft_num;
+    int          fft_dir;
+    const void * fft_x;
+    void *       fft_y;
+    fftplan      ifft;      // correlation inverse transform plan
+    unsigned int ifft_n, ifft_num;
+    void *       ifft_y;
+};
+
+static void * offload_host_alloc(unsigned long _size, void * _userdata)
+{
+    return liquid_malloc_aligned(_size);
+}
+
+static void offload_host_free(void * _ptr, void * _userdata)
+{
+    liquid_free_aligned(_ptr);
+}
+
+static int offload_host_fft_batch(void *                       _userdata,
+                                  int                          _dir,
+                                  unsigned int                 _n,
+                                  unsigned int                 _num,
+                                  const liquid_float_complex * _x,
+                                  liquid_float_complex *       _y)
+{
+    struct offload_host_s * h = (struct offload_host_s*) _userdata;
+    if (h->fft == NULL || h->fft_n != _n || h->fft_num != _num || h->fft_dir != _dir ||
+        h->fft_x != _x || h->fft_y != _y)
+    {
+        if (h->fft != NULL)
+            fft_destroy_plan(h->fft);
+        h->fft = fft_create_plan_many(_n, _num, (liquid_float_complex*)_x, 1, _n, _y, 1, _n, _dir, 0);
+        h->fft_n   = _n;
+        h->fft_num = _num;
+        h->fft_dir = _dir;
+        h->fft_x   = _x;
+        h->fft_y   = _y;
+    }
+    fft_execute(h->fft);
+    return 0;
+}
+
+static int offload_host_pfb(void *                       _userdata,
+                            unsigned int                 _m,
+                            unsigned int                 _k,
+                            unsigned int                 _n,
+                            const float *                _h,
+                            const liquid_float_complex * _x,
+                            liquid_float_complex *       _y)
+{
+    // Y = H X, accumulated row by row so the inner loop streams over
+    // contiguous rows of X
+    unsigned int i, j, c;
+    for (i=0; i<_m; i++) {
+        liquid_float_complex * y = &_y[i*_n];
+        memset(y, 0x00, _n*sizeof(liquid_float_complex));
+        for (j=0; j<_k; j++) {
+            float h = _h[i*_k + j];
+            const liquid_float_complex * x = &_x[j*_n];
+            for (c=0; c<_n; c++)
+                y[c] += h * x[c];
+        }
+    }
+    return 0;
+}
+
+static int offload_host_xcorr(void *                       _userdata,
+                              unsigned int                 _n,
+                              const liquid_float_complex * _x,
+                              const liquid_float_complex * _s,
+                              unsigned int                 _num,
+                              const int *                  _offsets,
+                              liquid_float_complex *       _y)
+{
+    struct offload_host_s * h = (struct offload_host_s*) _userdata;
+
+    // cross-multiply with template rotated by each offset
+    unsigned int k, i;
+    for (k=0; k<_num; k++) {
+        unsigned int o = (unsigned int)(_offsets[k] % (int)_n + (int)_n) % _n;
+        liquid_float_complex * y = &_y[k*_n];
+        for (i=0; i<o; i++)
+            y[i] = _x[i] * _s[_n - o + i];
+        for (i=o; i<_n; i++)
+            y[i] = _x[i] * _s[i - o];
+    }
+
+    // inverse transforms in place, all hypotheses at once
+    if (h->ifft == NULL || h->ifft_n != _n || h->ifft_num != _num || h->ifft_y != _y) {
+        if (h->ifft != NULL)
+            fft_destroy_plan(h->ifft);
+        h->ifft = fft_create_plan_many(_n, _num, _y, 1, _n, _y, 1, _n, LIQUID_FFT_BACKWARD, 0);
+        h->ifft_n   = _n;
+        h->ifft_num = _num;
+        h->ifft_y   = _y;
+    }
+    fft_execute(h->ifft);
+    return 0;
+}
+
+//
+// queue
+//
+
+// create offload queue
+//  _backend    :   kernel table (copied), or NULL for the built-in
+//                  host backend
+liquid_offload liquid_offload_create(const liquid_offload_backend * _backend)
+{
+    if (_backend != NULL && (_backend->fft_batch == NULL || _backend->pfb == NULL ||
+                             _backend->xcorr == NULL))
+    {
+        fprintf(stderr,"error: liquid_offload_create(), backend must provide all kernels\n");
+        exit(1);
+    }
+
+    liquid_offload q = (liquid_offload) liquid_malloc(sizeof(struct liquid_offload_s));
+    if (_backend != NULL) {
+        q->backend = *_backend;
+    } else {
+        struct offload_host_s * h = (struct offload_host_s*) liquid_calloc(1, sizeof(struct offload_host_s));
+        q->backend.name       = "host";
+        q->backend.alloc_host = offload_host_alloc;
+        q->backend.free_host  = offload_host_free;
+        q->backend.fft_batch  = offload_host_fft_batch;
+        q->backend.pfb        = offload_host_pfb;
+        q->backend.xcorr      = offload_host_xcorr;
+        q->backend.userdata   = h;
+    }
+    q->submitted = 0;
+    q->completed = 0;
+    q->thread    = OFFLOAD_THREAD;
+
+#if OFFLOAD_THREAD
+    q->stop = 0;
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init(&q->cv_submit, NULL);
+    pthread_cond_init(&q->cv_complete, NULL);
+    if (pthread_create(&q->worker, NULL, liquid_offload_worker, q) != 0) {
+        fprintf(stderr,"error: liquid_offload_create(), could not create worker thread\n");
+        exit(1);
+    }
+#endif
+    return q;
+}
+
+// destroy offload queue, completing jobs still queued
+void liquid_offload_destroy(liquid_offload _q)
+{
+    liquid_offload_wait(_q, 0);
+#if OFFLOAD_THREAD
+    pthread_mutex_lock(&_q->mutex);
+    _q->stop = 1;
+    pthread_cond_signal(&_q->cv_submit);
+    pthread_mutex_unlock(&_q->mutex);
+    pthread_join(_q->worker, NULL);
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy(&_q->cv_submit);
+    pthread_cond_destroy(&_q->cv_complete);
+#endif
+
+    // release host backend state
+    if (_q->backend.fft_batch == offload_host_fft_batch) {
+        struct offload_host_s * h = (struct offload_host_s*) _q->backend.userdata;
+        if (h->fft  != NULL) fft_destroy_plan(h->fft);
+        if (h->ifft != NULL) fft_destroy_plan(h->ifft);
+        liquid_free(h);
+    }
+    liquid_free(_q);
+}
+
+// print offload queue
+void liquid_offload_print(liquid_offload _q)
+{
+    printf("liquid_offload [backend: %s, submitted: %lu, completed: %lu]\n",
+            _q->backend.name == NULL ? "(unnamed)" : _q->backend.name,
+            _q->submitted, liquid_offload_get_num_completed(_q));
+}
+
+// get backend name
+const char * liquid_offload_get_backend_name(liquid_offload _q)
+{
+    return _q->backend.name;
+}
+
+// allocate host buffer for use with the queue (pinned or zero-copy
+// memory for accelerator backends)
+void * liquid_offload_alloc(liquid_offload _q,
+                            unsigned long  _size)
+{
+    void * p = _q->backend.alloc_host != NULL ?
+                    _q->backend.alloc_host(_size, _q->backend.userdata) :
+                    liquid_malloc_aligned(_size);
+    if (p == NULL) {
+        fprintf(stderr,"error: liquid_offload_alloc(), could not allocate %lu bytes\n", _size);
+        exit(1);
+    }
+    return p;
+}
+
+// release host buffer allocated with liquid_offload_alloc()
+void liquid_offload_free(liquid_offload _q,
+                         void *         _ptr)
+{
+    if (_ptr == NULL)
+        return;
+    if (_q->backend.free_host != NULL)
+        _q->backend.free_host(_ptr, _q->backend.userdata);
+    else
+        liquid_free_aligned(_ptr);
+}
+
+// run job on backend
+static void liquid_offload_run(liquid_offload _q, struct offload_job_s * _j)
+{
+    const liquid_offload_backend * b = &_q->backend;
+    int rc = 0;
+    switch (_j->type) {
+    case OFFLOAD_JOB_FFT:
+        rc = b->fft_batch(b->userdata, _j->dir, _j->n, _j->num, (const liquid_float_complex*)_j->a, _j->y);
+        break;
+    case OFFLOAD_JOB_PFB:
+        rc = b->pfb(b->userdata, _j->n, _j->k, _j->num, (const float*)_j->a, (const liquid_float_complex*)_j->b, _j->y);
+        break;
+    case OFFLOAD_JOB_XCORR:
+        rc = b->xcorr(b->userdata, _j->n, (const liquid_float_complex*)_j->a, (const liquid_float_complex*)_j->b,
+                      _j->num, _j->offsets, _j->y);
+        break;
+    default:;
+    }
+    if (rc != 0) {
+        fprintf(stderr,"error: liquid_offload, backend '%s' failed with code %d\n",
+                b->name == NULL ? "(unnamed)" : b->name, rc);
+        exit(1);
+    }
+}
+
+// queue job, returning its ticket
+static unsigned long liquid_offload_submit(liquid_offload _q, struct offload_job_s * _j)
+{
+#if OFFLOAD_THREAD
+    pthread_mutex_lock(&_q->mutex);
+    while (_q->submitted - _q->completed >= OFFLOAD_QUEUE_LEN)
+        pthread_cond_wait(&_q->cv_complete, &_q->mutex);
+    _q->jobs[_q->submitted % OFFLOAD_QUEUE_LEN] = *_j;
+    unsigned long ticket = ++_q->submitted;
+    pthread_cond_signal(&_q->cv_submit);
+    pthread_mutex_unlock(&_q->mutex);
+    return ticket;
+#else
+    liquid_offload_run(_q, _j);
+    _q->completed++;
+    return ++_q->submitted;
+#endif
+}
+
+#if OFFLOAD_THREAD
+// worker thread: run queued jobs in order
+void * liquid_offload_worker(void * _arg)
+{
+    liquid_offload q = (liquid_offload) _arg;
+    pthread_mutex_lock(&q->mutex);
+    while (1) {
+        while (!q->stop && q->completed == q->submitted)
+            pthread_cond_wait(&q->cv_submit, &q->mutex);
+        if (q->completed == q->submitted)
+            break;
+
+        // run job with the lock released; the slot is not reused
+        // until the job is marked complete
+        struct offload_job_s * j = &q->jobs[q->completed % OFFLOAD_QUEUE_LEN];
+        pthread_mutex_unlock(&q->mutex);
+        liquid_offload_run(q, j);
+        pthread_mutex_lock(&q->mutex);
+        q->completed++;
+        pthread_cond_broadcast(&q->cv_complete);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+#endif
+
+// submit batched transform: _num transforms of length _n, stored back
+// to back; may run in place
+//  _q      :   offload queue
+//  _dir    :   direction (e.g. LIQUID_FFT_FORWARD)
+//  _n      :   transform length
+//  _num    :   number of transforms
+//  _x      :   input [size: _num*_n x 1]
+//  _y      :   output [size: _num*_n x 1]
+unsigned long liquid_offload_fft_batch(liquid_offload               _q,
+                                       int                          _dir,
+                                       unsigned int                 _n,
+                                       unsigned int                 _num,
+                                       const liquid_float_complex * _x,
+                                       liquid_float_complex *       _y)
+{
+    if (_n == 0 || _num == 0) {
+        fprintf(stderr,"error: liquid_offload_fft_batch(), transform length and count must be greater than zero\n");
+        exit(1);
+    }
+    struct offload_job_s j = {OFFLOAD_JOB_FFT, _dir, _n, _num, 0, _x, NULL, NULL, _y};
+    return liquid_offload_submit(_q, &j);
+}
+
+// submit polyphase filter matrix product Y = H X (row-major): each of
+// the _m rows of H is a sub-filter, each of the _n columns of X holds
+// the _k most recent inputs of one output instant
+//  _q      :   offload queue
+//  _m      :   number of sub-filters (rows of Y)
+//  _k      :   sub-filter length
+//  _n      :   number of output instants (columns of Y)
+//  _h      :   coefficients [size: _m*_k x 1]
+//  _x      :   input matrix [size: _k*_n x 1]
+//  _y      :   output matrix [size: _m*_n x 1]
+unsigned long liquid_offload_pfb(liquid_offload               _q,
+                                 unsigned int                 _m,
+                                 unsigned int                 _k,
+                                 unsigned int                 _n,
+                                 const float *                _h,
+                                 const liquid_float_complex * _x,
+                                 liquid_float_complex *       _y)
+{
+    if (_m == 0 || _k == 0 || _n == 0) {
+        fprintf(stderr,"error: liquid_offload_pfb(), matrix dimensions must be greater than zero\n");
+        exit(1);
+    }
+    struct offload_job_s j = {OFFLOAD_JOB_PFB, 0, _m, _n, _k, _h, _x, NULL, _y};
+    return liquid_offload_submit(_q, &j);
+}
+
+// submit multi-hypothesis correlation: for each carrier offset
+// hypothesis o (bins), y_o = ifft( X[i] S[(i-o) mod n] ), unscaled
+//  _q      :   offload queue
+//  _n      :   transform length
+//  _x      :   received spectrum [size: _n x 1]
+//  _s      :   template spectrum, conjugated [size: _n x 1]
+//  _num    :   number of hypotheses
+//  _offsets:   carrier offset of each hypothesis [size: _num x 1]
+//  _y      :   correlation outputs [size: _num*_n x 1]
+unsigned long liquid_offload_xcorr(liquid_offload               _q,
+                                   unsigned int                 _n,
+                                   const liquid_float_complex * _x,
+                                   const liquid_float_complex * _s,
+                                   unsigned int                 _num,
+                                   const int *                  _offsets,
+                                   liquid_float_complex *       _y)
+{
+    if (_n == 0 || _num == 0) {
+        fprintf(stderr,"error: liquid_offload_xcorr(), length and number of hypotheses must be greater than zero\n");
+        exit(1);
+    }
+    struct offload_job_s j = {OFFLOAD_JOB_XCORR, 0, _n, _num, 0, _x, _s, _offsets, _y};
+    return liquid_offload_submit(_q, &j);
+}
+
+// get number of jobs completed
+unsigned long liquid_offload_get_num_completed(liquid_offload _q)
+{
+#if OFFLOAD_THREAD
+    pthread_mutex_lock(&_q->mutex);
+    unsigned long n = _q->completed;
+    pthread_mutex_unlock(&_q->mutex);
+    return n;
+#else
+    return _q->completed;
+#endif
+}
+
+// test whether job _ticket (and all jobs before it) completed
+int liquid_offload_is_done(liquid_offload _q,
+                           unsigned long  _ticket)
+{
+    return liquid_offload_get_num_completed(_q) >= _ticket;
+}
+
+// wait for job _ticket and all jobs before it (0: all jobs submitted)
+void liquid_offload_wait(liquid_offload _q,
+                         unsigned long  _ticket)
+{
+#if OFFLOAD_THREAD
+    pthread_mutex_lock(&_q->mutex);
+    unsigned long t = _ticket == 0 ? _q->submitted : _ticket;
+    while (_q->completed < t)
+        pthread_cond_wait(&_q->cv_complete, &_q->mutex);
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+}
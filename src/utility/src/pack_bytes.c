@@ -175,6 +175,188 @@ void liquid_unpack_array(unsigned char * _src,
 }
 
 
+// pack whole bytes of _b-bit symbols, _b in {1,2,4,8}, starting on a
+// byte boundary; returns number of symbols consumed
+static inline unsigned int liquid_pack_array_aligned(unsigned char * _dst,
+                                                     unsigned int    _num_bytes,
+                                                     unsigned int    _b,
+                                                     unsigned int *  _syms)
+{
+    unsigned int spb  = 8 / _b;             // symbols per byte
+    unsigned int mask = (1u << _b) - 1;
+    unsigned int i, j;
+    for (i=0; i<_num_bytes; i++) {
+        unsigned int byte = 0;
+        for (j=0; j<spb; j++)
+            byte = (byte << _b) | (_syms[i*spb + j] & mask);
+        _dst[i] = (unsigned char) byte;
+    }
+    return _num_bytes * spb;
+}
+
+// unpack whole bytes into _b-bit symbols, _b in {1,2,4,8}, starting
+// on a byte boundary; returns number of symbols written
+static inline unsigned int liquid_unpack_array_aligned(unsigned char * _src,
+                                                       unsigned int    _num_bytes,
+                                                       unsigned int    _b,
+                                                       unsigned int *  _syms)
+{
+    unsigned int spb  = 8 / _b;             // symbols per byte
+    unsigned int mask = (1u << _b) - 1;
+    unsigned int i, j;
+    for (i=0; i<_num_bytes; i++) {
+        unsigned int byte = _src[i];
+        for (j=0; j<spb; j++)
+            _syms[i*spb + j] = (byte >> (8 - _b*(j+1))) & mask;
+    }
+    return _num_bytes * spb;
+}
+
+// pack block of symbols into binary array, equivalent to calling
+// liquid_pack_array() for each symbol in turn at bit indices _k,
+// _k+_b, _k+2*_b, ...; bits falling past the end of the array are
+// dropped
+//  _src        :   destination array [size: _n x 1]
+//  _n          :   destination array length
+//  _k          :   bit index of first symbol
+//  _b          :   number of bits per symbol, _b <= 8
+//  _syms       :   input symbols [size: _num_symbols x 1]
+//  _num_symbols:   number of input symbols
+void liquid_pack_array_block(unsigned char * _src,
+                             unsigned int    _n,
+                             unsigned int    _k,
+                             unsigned int    _b,
+                             unsigned int *  _syms,
+                             unsigned int    _num_symbols)
+{
+    if (_num_symbols == 0 || _b == 0)
+        return;
+
+    // validate input once for the whole block
+    if (_b > 8) {
+        fprintf(stderr,"error: liquid_pack_array_block(), symbol size cannot exceed 8 bits\n");
+        exit(1);
+    } else if (_k + _b*(_num_symbols-1) >= 8*_n) {
+        fprintf(stderr,"error: liquid_pack_array_block(), bit index exceeds array length\n");
+        exit(1);
+    }
+
+    unsigned int i = _k >> 3;   // output byte index
+    unsigned int s = 0;         // input symbol index
+
+    // symbol sizes dividing a byte: fill whole bytes directly
+    if ((_k & 7) == 0 && (8 % _b) == 0) {
+        unsigned int num_bytes = _num_symbols / (8/_b);
+        if (num_bytes > _n - i)
+            num_bytes = _n - i;
+        switch (_b) {
+        case 1: s = liquid_pack_array_aligned(&_src[i], num_bytes, 1, _syms); break;
+        case 2: s = liquid_pack_array_aligned(&_src[i], num_bytes, 2, _syms); break;
+        case 4: s = liquid_pack_array_aligned(&_src[i], num_bytes, 4, _syms); break;
+        default:s = liquid_pack_array_aligned(&_src[i], num_bytes, 8, _syms);
+        }
+        i += num_bytes;
+    }
+
+    // general case: shift symbols through accumulator, seeded with the
+    // bits of the first byte preceding the bit index
+    unsigned int nbits = (_k + s*_b) & 7;   // bits held in accumulator
+    unsigned long long int acc = nbits ? (_src[i] >> (8-nbits)) : 0;
+    unsigned int mask = (1u << _b) - 1;
+    for ( ; s<_num_symbols; s++) {
+        acc = (acc << _b) | (_syms[s] & mask);
+        nbits += _b;
+        if (nbits < 32)
+            continue;
+
+        // flush whole bytes
+        while (nbits >= 8) {
+            nbits -= 8;
+            if (i < _n) _src[i] = (unsigned char)(acc >> nbits);
+            i++;
+        }
+    }
+    while (nbits >= 8) {
+        nbits -= 8;
+        if (i < _n) _src[i] = (unsigned char)(acc >> nbits);
+        i++;
+    }
+
+    // merge trailing bits, preserving remainder of final byte
+    if (nbits > 0 && i < _n) {
+        unsigned char m = 0xff >> nbits;
+        _src[i] = (_src[i] & m) | ((unsigned char)(acc << (8-nbits)) & ~m);
+    }
+}
+
+// unpack block of symbols from binary array, equivalent to calling
+// liquid_unpack_array() for each symbol in turn at bit indices _k,
+// _k+_b, _k+2*_b, ...; bits past the end of the array are read as 0
+//  _src        :   source array [size: _n x 1]
+//  _n          :   source array length
+//  _k          :   bit index of first symbol
+//  _b          :   number of bits per symbol, _b <= 8
+//  _syms       :   output symbols [size: _num_symbols x 1]
+//  _num_symbols:   number of output symbols
+void liquid_unpack_array_block(unsigned char * _src,
+                               unsigned int    _n,
+                               unsigned int    _k,
+                               unsigned int    _b,
+                               unsigned int *  _syms,
+                               unsigned int    _num_symbols)
+{
+    if (_num_symbols == 0)
+        return;
+
+    // validate input once for the whole block
+    if (_b > 8) {
+        fprintf(stderr,"error: liquid_unpack_array_block(), symbol size cannot exceed 8 bits\n");
+        exit(1);
+    } else if (_k + _b*(_num_symbols-1) >= 8*_n) {
+        fprintf(stderr,"error: liquid_unpack_array_block(), bit index exceeds array length\n");
+        exit(1);
+    }
+
+    unsigned int i = _k >> 3;   // input byte index
+    unsigned int s = 0;         // output symbol index
+
+    // symbol sizes dividing a byte: read whole bytes directly
+    if (_b > 0 && (_k & 7) == 0 && (8 % _b) == 0) {
+        unsigned int num_bytes = _num_symbols / (8/_b);
+        if (num_bytes > _n - i)
+            num_bytes = _n - i;
+        switch (_b) {
+        case 1: s = liquid_unpack_array_aligned(&_src[i], num_bytes, 1, _syms); break;
+        case 2: s = liquid_unpack_array_aligned(&_src[i], num_bytes, 2, _syms); break;
+        case 4: s = liquid_unpack_array_aligned(&_src[i], num_bytes, 4, _syms); break;
+        default:s = liquid_unpack_array_aligned(&_src[i], num_bytes, 8, _syms);
+        }
+        i += num_bytes;
+    }
+
+    // general case: shift bytes through accumulator, discarding the
+    // bits of the first byte preceding the bit index
+    unsigned int b0 = (_k + s*_b) & 7;
+    unsigned long long int acc = 0;
+    unsigned int nbits = 0;                 // bits held in accumulator
+    unsigned int mask = (1u << _b) - 1;
+    if (b0 && s < _num_symbols) {
+        acc   = _src[i++] & (0xff >> b0);
+        nbits = 8 - b0;
+    }
+    for ( ; s<_num_symbols; s++) {
+        // refill accumulator with whole bytes
+        if (nbits < _b) {
+            while (nbits <= 48) {
+                acc = (acc << 8) | (i < _n ? _src[i] : 0);
+                nbits += 8;
+                i++;
+            }
+        }
+        nbits -= _b;
+        _syms[s] = (acc >> nbits) & mask;
+    }
+}
 
 
 // pack one-bit symbols into bytes (8-bit symbols)
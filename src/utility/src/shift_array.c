@@ -98,7 +98,7 @@ void liquid_lcircshift(unsigned char * _src,
     }
 
     // allocate memory for temporary array
-    unsigned char * tmp = (unsigned char*) malloc(_b*sizeof(unsigned char));
+    unsigned char * tmp = (unsigned char*) liquid_malloc(_b*sizeof(unsigned char));
 
     // copy to temporary array
     memmove(tmp, _src, _b*sizeof(unsigned char));
@@ -110,7 +110,7 @@ void liquid_lcircshift(unsigned char * _src,
     memmove(&_src[_n-_b], tmp, _b*sizeof(unsigned char));
 
     // free temporary array
-    free(tmp);
+    liquid_free(tmp);
 }
 
 
@@ -136,7 +136,7 @@ void liquid_rcircshift(unsigned char * _src,
     }
 
     // allocate memory for temporary array
-    unsigned char * tmp = (unsigned char*) malloc(_b*sizeof(unsigned char));
+    unsigned char * tmp = (unsigned char*) liquid_malloc(_b*sizeof(unsigned char));
 
     // copy to temporary array
     memmove(tmp, &_src[_n-_b], _b*sizeof(unsigned char));
@@ -148,6 +148,6 @@ void liquid_rcircshift(unsigned char * _src,
     memmove(_src, tmp, _b*sizeof(unsigned char));
 
     // free temporary array
-    free(tmp);
+    liquid_free(tmp);
 }
  
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : arena regions are aligned, disjoint and fill capacity
+//
+void autotest_arena_alloc()
+{
+    unsigned long sizes[5] = {1, 64, 65, 200, 7};
+    unsigned long total = 0;
+    unsigned int i;
+    for (i=0; i<5; i++)
+        total += LIQUID_ARENA_SIZE(sizes[i]);
+    CONTEND_EQUALITY( total, 64+64+128+256+64 );
+
+    liquid_arena a = liquid_arena_create(total);
+    CONTEND_EQUALITY( liquid_arena_get_size(a), total );
+
+    unsigned char * p[5];
+    for (i=0; i<5; i++) {
+        p[i] = (unsigned char*) liquid_arena_alloc(a, sizes[i]);
+        CONTEND_EQUALITY( (uintptr_t)p[i] % LIQUID_ARENA_ALIGNMENT, 0 );
+        memset(p[i], i+1, sizes[i]);
+    }
+    CONTEND_EQUALITY( liquid_arena_get_used(a), total );
+
+    // regions are contiguous and do not overlap
+    for (i=1; i<5; i++)
+        CONTEND_EQUALITY( (unsigned long)(p[i] - p[i-1]), LIQUID_ARENA_SIZE(sizes[i-1]) );
+    for (i=0; i<5; i++)
+        CONTEND_EQUALITY( p[i][sizes[i]-1], i+1 );
+
+    // reset hands out the same regions again; calloc clears them
+    liquid_arena_reset(a);
+    CONTEND_EQUALITY( liquid_arena_get_used(a), 0 );
+    unsigned char * q = (unsigned char*) liquid_arena_calloc(a, 16, 4);
+    CONTEND_EXPRESSION( q == p[0] );
+    for (i=0; i<64; i++)
+        CONTEND_EQUALITY( q[i], 0 );
+
+    liquid_arena_destroy(a);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// tuning selects available implementations and survives export and
+// import through a profile file
+void autotest_autotune_profile()
+{
+    const char * filename = "autotune_autotest.txt";
+    liquid_simd_level level = liquid_simd_get_level();
+
+    fft_wisdom_forget();
+    liquid_autotune_forget();
+    CONTEND_EQUALITY( liquid_autotune_is_tuned(LIQUID_AUTOTUNE_FFTFILT_COST), 0 );
+    CONTEND_EQUALITY( liquid_autotune(), 0 );
+
+    // tuned values are sane and the SIMD level is applied
+    float simd = liquid_autotune_get(LIQUID_AUTOTUNE_SIMD_LEVEL);
+    float cost = liquid_autotune_get(LIQUID_AUTOTUNE_FFTFILT_COST);
+    CONTEND_EQUALITY( liquid_autotune_is_tuned(LIQUID_AUTOTUNE_SIMD_LEVEL),   1 );
+    CONTEND_EQUALITY( liquid_autotune_is_tuned(LIQUID_AUTOTUNE_FFTFILT_COST), 1 );
+    CONTEND_EQUALITY( (int)liquid_simd_get_level(), (int)simd );
+    CONTEND_GREATER_THAN( cost, 0.99f );
+    CONTEND_LESS_THAN   ( cost, 100.01f );
+    if (liquid_autotest_verbose)
+        liquid_autotune_print();
+
+    // round trip through file
+    char wisdom[4096];
+    int wisdom_len = fft_wisdom_export_string(wisdom, sizeof(wisdom));
+    CONTEND_EQUALITY( liquid_autotune_export(filename), 0 );
+    liquid_autotune_forget();
+    fft_wisdom_forget();
+    CONTEND_EQUALITY( liquid_autotune_is_tuned(LIQUID_AUTOTUNE_FFTFILT_COST), 0 );
+    CONTEND_GREATER_THAN( liquid_autotune_import(filename), 2 );
+    CONTEND_EQUALITY( liquid_autotune_get(LIQUID_AUTOTUNE_SIMD_LEVEL), simd );
+    CONTEND_DELTA   ( liquid_autotune_get(LIQUID_AUTOTUNE_FFTFILT_COST), cost, 1e-4f*cost );
+    char wisdom2[4096];
+    CONTEND_EQUALITY( fft_wisdom_export_string(wisdom2, sizeof(wisdom2)), wisdom_len );
+    CONTEND_SAME_DATA( wisdom, wisdom2, wisdom_len );
+    remove(filename);
+
+    // restore state
+    liquid_autotune_forget();
+    fft_wisdom_forget();
+    liquid_simd_set_level(level);
+}
+
+// fftfilt selection follows the profile
+void autotest_autotune_fftfilt_select()
+{
+    unsigned int nfft;
+    liquid_autotune_set(LIQUID_AUTOTUNE_FFTFILT_COST, 1000.0f);
+    CONTEND_EQUALITY( liquid_fftfilt_select(256, 1<<16, &nfft), 0 );
+    liquid_autotune_set(LIQUID_AUTOTUNE_FFTFILT_COST, 1.0f);
+    CONTEND_GREATER_THAN( liquid_fftfilt_select(256, 1<<16, &nfft), 0 );
+    liquid_autotune_forget();
+    CONTEND_EQUALITY( liquid_autotune_get(LIQUID_AUTOTUNE_FFTFILT_COST), 12.0f );
+}
+
+// invalid and foreign entries are skipped
+void autotest_autotune_import_invalid()
+{
+    const char * filename = "autotune_invalid_autotest.txt";
+    FILE * fid = fopen(filename,"w");
+    if (fid == NULL) {
+        AUTOTEST_WARN("could not open file for writing");
+        return;
+    }
+    fprintf(fid,"# comment\n\n");
+    fprintf(fid,"fftfilt_cost 7.5\n");
+    fprintf(fid,"fftfilt_cost -1\n");
+    fprintf(fid,"unknown_param 3\n");
+    fprintf(fid,"simd_level no-such-level\n");
+    fclose(fid);
+
+    CONTEND_EQUALITY( liquid_autotune_import(filename), 1 );
+    remove(filename);
+    CONTEND_EQUALITY( liquid_autotune_get(LIQUID_AUTOTUNE_FFTFILT_COST), 7.5f );
+    CONTEND_EQUALITY( liquid_autotune_is_tuned(LIQUID_AUTOTUNE_SIMD_LEVEL), 0 );
+    liquid_autotune_forget();
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// write samples to a sink, read them back from a source in blocks
+void capture_test_roundtrip(liquid_capture_format _format,
+                            float                 _tol)
+{
+    const char * filename = "capture_autotest.dat";
+    unsigned int i, n = 1000;
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = 0.7f*cexpf(_Complex_I*0.01f*i*i);
+
+    capture q = capture_create(filename, _format);
+    CONTEND_EXPRESSION(q != NULL);
+    if (q == NULL)
+        return;
+    capture_writecf(q, x, 300);
+    capture_writecf(q, x+300, n-300);
+    CONTEND_EQUALITY(capture_get_num_samples(q), n);
+    capture_destroy(q);
+
+    q = capture_open(filename, _format);
+    CONTEND_EXPRESSION(q != NULL);
+    if (q == NULL)
+        return;
+    CONTEND_EQUALITY(capture_get_num_samples(q), n);
+
+    // read in odd-sized blocks until exhausted
+    unsigned int num_read = 0, num_errors = 0, k;
+    float complex * v;
+    while ( (k = capture_readcf(q, 77, &v)) > 0 ) {
+        for (i=0; i<k; i++)
+            num_errors += cabsf(v[i] - x[num_read+i]) > _tol;
+        num_read += k;
+    }
+    CONTEND_EQUALITY(num_read, n);
+    CONTEND_EQUALITY(num_errors, 0);
+    CONTEND_EQUALITY(capture_get_num_remaining(q), 0);
+
+    // seek and read again
+    capture_seek(q, n-5);
+    CONTEND_EQUALITY(capture_readcf(q, 16, &v), 5);
+    CONTEND_DELTA(crealf(v[4]), crealf(x[n-1]), _tol);
+
+    // floating-point blocks are views into the file: consecutive
+    // blocks are contiguous
+    if (_format == LIQUID_CAPTURE_CF32) {
+        float complex * v0;
+        float complex * v1;
+        capture_seek(q, 0);
+        capture_readcf(q, 10, &v0);
+        capture_readcf(q, 10, &v1);
+        CONTEND_EXPRESSION(v1 == v0 + 10);
+    }
+    capture_destroy(q);
+    remove(filename);
+}
+
+void autotest_capture_cf32() { capture_test_roundtrip(LIQUID_CAPTURE_CF32, 0.0f);     }
+void autotest_capture_ci16() { capture_test_roundtrip(LIQUID_CAPTURE_CI16, 1.0f/16384); }
+
+// real samples
+void autotest_capture_f32()
+{
+    const char * filename = "capture_autotest_f32.dat";
+    unsigned int i, n = 500;
+    float x[n];
+    for (i=0; i<n; i++)
+        x[i] = (float)i - 250.0f;
+
+    capture q = capture_create(filename, LIQUID_CAPTURE_F32);
+    capture_writef(q, x, n);
+    capture_destroy(q);
+
+    q = capture_open(filename, LIQUID_CAPTURE_F32);
+    float * v;
+    CONTEND_EQUALITY(capture_readf(q, n+10, &v), n);
+    CONTEND_SAME_DATA(v, x, n*sizeof(float));
+    CONTEND_EQUALITY(capture_readf(q, 1, &v), 0);
+    capture_destroy(q);
+    remove(filename);
+
+    // format names
+    CONTEND_EQUALITY(liquid_getopt_str2capture("ci16"), LIQUID_CAPTURE_CI16);
+    CONTEND_EQUALITY(liquid_getopt_str2capture("f32"),  LIQUID_CAPTURE_F32);
+}
+
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// topology queries are consistent
+void autotest_context_topology()
+{
+    unsigned int num_cpus  = liquid_get_num_cpus();
+    unsigned int num_nodes = liquid_get_num_numa_nodes();
+    CONTEND_GREATER_THAN(num_cpus,  0);
+    CONTEND_GREATER_THAN(num_nodes, 0);
+
+    unsigned int i;
+    for (i=0; i<num_cpus; i++)
+        CONTEND_LESS_THAN(liquid_get_cpu_numa_node(i), num_nodes);
+
+    liquid_context q = liquid_context_create(num_cpus-1);
+    CONTEND_EQUALITY(liquid_context_get_cpu(q),  (int)num_cpus-1);
+    CONTEND_EQUALITY(liquid_context_get_node(q), (int)liquid_get_cpu_numa_node(num_cpus-1));
+    liquid_context_destroy(q);
+}
+
+// objects created under a context take their memory from its pool,
+// including blocks too large to be pooled, and return it on destroy;
+// released blocks are reused
+void autotest_context_pool()
+{
+    liquid_context q = liquid_context_create(0);
+    CONTEND_EXPRESSION(liquid_context_get_current() == NULL);
+
+    liquid_context_enter(q);
+    CONTEND_EXPRESSION(liquid_context_get_current() == q);
+    firfilt_crcf f = firfilt_crcf_create_kaiser(51, 0.2f, 60.0f, 0.0f);
+    windowcf     w = windowcf_create(20000);
+    liquid_context_leave();
+    CONTEND_EXPRESSION(liquid_context_get_current() == NULL);
+
+    unsigned long num_blocks = liquid_context_get_num_blocks(q);
+    unsigned long usage      = liquid_context_get_memory_usage(q);
+    CONTEND_GREATER_THAN(num_blocks, 2);
+    CONTEND_GREATER_THAN(usage, 20000*sizeof(float complex));
+
+    // objects run and are released outside the context
+    float complex x[256];
+    unsigned int i;
+    for (i=0; i<256; i++) {
+        x[i] = (i % 7) - 3.0f;
+        windowcf_push(w, x[i]);
+    }
+    firfilt_crcf_execute_block(f, x, 256, x);
+    firfilt_crcf_destroy(f);
+    windowcf_destroy(w);
+    CONTEND_EQUALITY(liquid_context_get_num_blocks(q), 0);
+
+    // re-creating the filter reuses pooled blocks
+    unsigned long reserved = liquid_context_get_memory_usage(q);
+    liquid_context_enter(q);
+    f = firfilt_crcf_create_kaiser(51, 0.2f, 60.0f, 0.0f);
+    liquid_context_leave();
+    CONTEND_LESS_THAN(liquid_context_get_memory_usage(q), reserved + 1);
+    firfilt_crcf_destroy(f);
+
+    liquid_context_destroy(q);
+}
+
+// worker thread creating and running a receiver under a context
+void * context_autotest_worker(void * _arg)
+{
+    liquid_context q = (liquid_context) _arg;
+    int * rc = (int*) malloc(sizeof(int));
+    *rc = liquid_context_enter(q);
+
+    ofdmflexframesync fs = ofdmflexframesync_create(64, 16, 4, NULL, NULL, NULL);
+    float complex x[64];
+    unsigned int i;
+    for (i=0; i<64; i++)
+        x[i] = 0.01f*i;
+    ofdmflexframesync_execute(fs, x, 64);
+    ofdmflexframesync_destroy(fs);
+
+    liquid_context_leave();
+    return rc;
+}
+
+// contexts on worker threads pin them and leave the caller untouched
+void autotest_context_threads()
+{
+    unsigned int num = liquid_get_num_cpus() < 4 ? liquid_get_num_cpus() : 4;
+    liquid_context q[4];
+    pthread_t      t[4];
+    unsigned int i;
+    for (i=0; i<num; i++) {
+        q[i] = liquid_context_create(i);
+        pthread_create(&t[i], NULL, context_autotest_worker, q[i]);
+    }
+    for (i=0; i<num; i++) {
+        void * rc;
+        pthread_join(t[i], &rc);
+        // pinning may be refused in restricted environments
+        if (*(int*)rc != 0)
+            AUTOTEST_WARN("context_threads: could not pin worker thread");
+        free(rc);
+        CONTEND_EQUALITY(liquid_context_get_num_blocks(q[i]), 0);
+        CONTEND_GREATER_THAN(liquid_context_get_memory_usage(q[i]), 0);
+        liquid_context_destroy(q[i]);
+    }
+    CONTEND_EXPRESSION(liquid_context_get_current() == NULL);
+}
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// source emitting samples from an array in varying-length runs
+struct flowgraph_autotest_source_s {
+    float complex * x;          // samples
+    unsigned int    n;          // number of samples
+    unsigned int    index;      // next sample to emit
+    unsigned int    call;       // number of calls
+};
+
+static int flowgraph_autotest_source(void *         _userdata,
+                                     void **        _x,
+                                     unsigned int * _nx,
+                                     void **        _y,
+                                     unsigned int * _ny)
+{
+    struct flowgraph_autotest_source_s * s = (struct flowgraph_autotest_source_s*) _userdata;
+    unsigned int n = 1 + (s->call++ * 13) % 97;
+    if (n > _ny[0])           n = _ny[0];
+    if (n > s->n - s->index)  n = s->n - s->index;
+    memmove(_y[0], s->x + s->index, n*sizeof(float complex));
+    s->index += n;
+    _ny[0] = n;
+    return s->index == s->n ? LIQUID_FLOWGRAPH_DONE : 0;
+}
+
+// sink appending samples to an array, checking for concurrent calls
+struct flowgraph_autotest_sink_s {
+    float complex * x;          // received samples
+    unsigned int    n;          // number of samples received
+    unsigned int    max;        // consume at most this many per call
+    int             busy;       // callback currently executing?
+    int             overlap;    // callbacks overlapped?
+};
+
+static int flowgraph_autotest_sink(void *         _userdata,
+                                   void **        _x,
+                                   unsigned int * _nx,
+                                   void **        _y,
+                                   unsigned int * _ny)
+{
+    struct flowgraph_autotest_sink_s * s = (struct flowgraph_autotest_sink_s*) _userdata;
+    if (s->busy)
+        s->overlap = 1;
+    s->busy = 1;
+    unsigned int n = _nx[0] < s->max ? _nx[0] : s->max;
+    memmove(s->x + s->n, _x[0], n*sizeof(float complex));
+    s->n += n;
+    _nx[0] = n;
+    s->busy = 0;
+    return 0;
+}
+
+// adder: two inputs, consumed in lock step
+static int flowgraph_autotest_add(void *         _userdata,
+                                  void **        _x,
+                                  unsigned int * _nx,
+                                  void **        _y,
+                                  unsigned int * _ny)
+{
+    unsigned int n = _nx[0];
+    if (n > _nx[1]) n = _nx[1];
+    if (n > _ny[0]) n = _ny[0];
+    float complex * x0 = (float complex*)_x[0];
+    float complex * x1 = (float complex*)_x[1];
+    float complex * y  = (float complex*)_y[0];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        y[i] = x0[i] + x1[i];
+    _nx[0] = _nx[1] = _ny[0] = n;
+    return 0;
+}
+
+// helper function: run source -> nco -> firfilt -> agc, split to an
+// adder alongside a second source, and check the sink against the same
+// objects executed directly
+//  _num_threads    :   number of worker threads
+//  _capacity       :   edge capacity
+void flowgraph_autotest_chain(unsigned int _num_threads,
+                              unsigned int _capacity)
+{
+    unsigned int i;
+    unsigned int n = 5000;
+
+    float complex * x0 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * x1 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y  = (float complex*) malloc(n*sizeof(float complex));
+    for (i=0; i<n; i++) {
+        x0[i] = randnf() + _Complex_I*randnf();
+        x1[i] = randnf() + _Complex_I*randnf();
+    }
+
+    // reference: objects executed directly
+    nco_crcf     nco = nco_crcf_create(LIQUID_VCO);
+    firfilt_crcf f   = firfilt_crcf_create_kaiser(21, 0.2f, 60.0f, 0.0f);
+    agc_crcf     agc = agc_crcf_create();
+    nco_crcf_set_frequency(nco, 0.1f);
+    float complex * y_ref = (float complex*) malloc(n*sizeof(float complex));
+    nco_crcf_mix_block_down(nco, x0, y_ref, n);
+    firfilt_crcf_execute_block(f, y_ref, n, y_ref);
+    agc_crcf_execute_block(agc, y_ref, n, y_ref);
+    for (i=0; i<n; i++)
+        y_ref[i] += x1[i];
+
+    // same chain as a flowgraph
+    nco_crcf_reset(nco);
+    nco_crcf_set_frequency(nco, 0.1f);
+    firfilt_crcf_reset(f);
+    agc_crcf_reset(agc);
+    struct flowgraph_autotest_source_s s0 = {x0, n, 0, 0};
+    struct flowgraph_autotest_source_s s1 = {x1, n, 0, 7};
+    struct flowgraph_autotest_sink_s   k  = {y,  0, 33, 0, 0};
+
+    flowgraph g = flowgraph_create(_num_threads);
+    unsigned int b_src0 = flowgraph_add_block(g, "source0", 0, 0, 1, sizeof(float complex), flowgraph_autotest_source, &s0);
+    unsigned int b_src1 = flowgraph_add_block(g, "source1", 0, 0, 1, sizeof(float complex), flowgraph_autotest_source, &s1);
+    unsigned int b_nco  = flowgraph_add_nco_crcf_mix_down(g, nco);
+    unsigned int b_fir  = flowgraph_add_firfilt_crcf(g, f);
+    unsigned int b_agc  = flowgraph_add_agc_crcf(g, agc);
+    unsigned int b_add  = flowgraph_add_block(g, "add", 2, sizeof(float complex), 1, sizeof(float complex), flowgraph_autotest_add, NULL);
+    unsigned int b_sink = flowgraph_add_block(g, "sink", 1, sizeof(float complex), 0, 0, flowgraph_autotest_sink, &k);
+    flowgraph_connect(g, b_src0, 0, b_nco,  0, _capacity);
+    flowgraph_connect(g, b_nco,  0, b_fir,  0, _capacity);
+    flowgraph_connect(g, b_fir,  0, b_agc,  0, _capacity);
+    flowgraph_connect(g, b_agc,  0, b_add,  0, _capacity);
+    flowgraph_connect(g, b_src1, 0, b_add,  1, _capacity);
+    flowgraph_connect(g, b_add,  0, b_sink, 0, _capacity);
+    CONTEND_EQUALITY( flowgraph_get_num_blocks(g), 7 );
+    flowgraph_run(g);
+
+    if (liquid_autotest_verbose)
+        flowgraph_print(g);
+
+    // every sample arrived, in order, one sink call at a time
+    CONTEND_EQUALITY( k.n,       n );
+    CONTEND_EQUALITY( k.overlap, 0 );
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y[i]), crealf(y_ref[i]), 1e-4f );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(y_ref[i]), 1e-4f );
+    }
+
+    // statistics account for every item
+    flowgraph_blockstats_s stats;
+    flowgraph_get_blockstats(g, b_add, &stats);
+    CONTEND_EQUALITY( stats.num_consumed, 2*n );
+    CONTEND_EQUALITY( stats.num_produced, n );
+    CONTEND_EXPRESSION( stats.num_calls > 0 );
+    flowgraph_get_blockstats(g, b_sink, &stats);
+    CONTEND_EQUALITY( stats.num_consumed, n );
+
+    flowgraph_destroy(g);
+    nco_crcf_destroy(nco);
+    firfilt_crcf_destroy(f);
+    agc_crcf_destroy(agc);
+    free(x0);
+    free(x1);
+    free(y);
+    free(y_ref);
+}
+
+void autotest_flowgraph_chain_t0()  { flowgraph_autotest_chain(0,   64); }
+void autotest_flowgraph_chain_t1()  { flowgraph_autotest_chain(1,   64); }
+void autotest_flowgraph_chain_t3()  { flowgraph_autotest_chain(3,   16); }
+void autotest_flowgraph_chain_t4()  { flowgraph_autotest_chain(4, 1024); }
+void autotest_flowgraph_chain_t16() { flowgraph_autotest_chain(16,   8); }
+
+// full edges hold back the source
+void autotest_flowgraph_backpressure()
+{
+    unsigned int n = 1000;
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = i;
+
+    struct flowgraph_autotest_source_s s = {x, n, 0, 0};
+    struct flowgraph_autotest_sink_s   k = {y, 0, 3, 0, 0};
+    flowgraph g = flowgraph_create(0);
+    unsigned int b_src  = flowgraph_add_block(g, "source", 0, 0, 1, sizeof(float complex), flowgraph_autotest_source, &s);
+    unsigned int b_sink = flowgraph_add_block(g, "sink",   1, sizeof(float complex), 0, 0, flowgraph_autotest_sink, &k);
+    flowgraph_connect(g, b_src, 0, b_sink, 0, 8);
+    flowgraph_run(g);
+
+    CONTEND_EQUALITY( k.n, n );
+    CONTEND_SAME_DATA( x, y, sizeof(x) );
+
+    flowgraph_blockstats_s stats;
+    flowgraph_get_blockstats(g, b_src, &stats);
+    CONTEND_EQUALITY( stats.num_produced, n );
+    CONTEND_EXPRESSION( stats.num_blocked > 0 );
+    flowgraph_destroy(g);
+}
+
+// channelizer fan-out: each channel output matches direct execution
+void flowgraph_autotest_firpfbch2(unsigned int _num_threads)
+{
+    unsigned int M = 8;
+    unsigned int num_transforms = 300;
+    unsigned int n = num_transforms*M/2;
+    unsigned int i, c;
+
+    float complex * x = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y_ref = (float complex*) malloc(num_transforms*M*sizeof(float complex));
+    for (i=0; i<n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    firpfbch2_crcf q = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, M, 4, 60.0f);
+    firpfbch2_crcf_execute_block(q, x, num_transforms, y_ref);
+    firpfbch2_crcf_reset(q);
+
+    float complex * y[M];
+    struct flowgraph_autotest_sink_s k[M];
+    struct flowgraph_autotest_source_s s = {x, n, 0, 0};
+    flowgraph g = flowgraph_create(_num_threads);
+    unsigned int b_src = flowgraph_add_block(g, "source", 0, 0, 1, sizeof(float complex), flowgraph_autotest_source, &s);
+    unsigned int b_ch  = flowgraph_add_firpfbch2_crcf(g, q);
+    flowgraph_connect(g, b_src, 0, b_ch, 0, 64);
+    for (c=0; c<M; c++) {
+        y[c] = (float complex*) malloc(num_transforms*sizeof(float complex));
+        k[c].x = y[c]; k[c].n = 0; k[c].max = 5 + c; k[c].busy = 0; k[c].overlap = 0;
+        unsigned int b = flowgraph_add_block(g, "channel", 1, sizeof(float complex), 0, 0, flowgraph_autotest_sink, &k[c]);
+        flowgraph_connect(g, b_ch, c, b, 0, 16);
+    }
+    flowgraph_run(g);
+
+    for (c=0; c<M; c++) {
+        CONTEND_EQUALITY( k[c].n, num_transforms );
+        for (i=0; i<num_transforms; i++) {
+            CONTEND_DELTA( crealf(y[c][i]), crealf(y_ref[i*M+c]), 1e-4f );
+            CONTEND_DELTA( cimagf(y[c][i]), cimagf(y_ref[i*M+c]), 1e-4f );
+        }
+        free(y[c]);
+    }
+
+    flowgraph_destroy(g);
+    firpfbch2_crcf_destroy(q);
+    free(x);
+    free(y_ref);
+}
+void autotest_flowgraph_firpfbch2_t0() { flowgraph_autotest_firpfbch2(0); }
+void autotest_flowgraph_firpfbch2_t4() { flowgraph_autotest_firpfbch2(4); }
+
+static int flowgraph_autotest_framesync_callback(unsigned char *  _header,
+                                                 int              _header_valid,
+                                                 unsigned char *  _payload,
+                                                 unsigned int     _payload_len,
+                                                 int              _payload_valid,
+                                                 framesyncstats_s _stats,
+                                                 void *           _userdata)
+{
+    if (_header_valid && _payload_valid)
+        (*(unsigned int*)_userdata)++;
+    return 0;
+}
+
+// frames pass through interpolating and decimating resamplers into a
+// frame synchronizer sink
+void autotest_flowgraph_flexframesync()
+{
+    unsigned int num_frames = 4;
+    unsigned int payload_len = 64;
+    unsigned int gap_len = 200;
+    unsigned int i;
+
+    // generate frames
+    flexframegen fg = flexframegen_create(NULL);
+    unsigned int frame_len = 0;
+    unsigned char header[14] = {0};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+    flexframegen_assemble(fg, header, payload, payload_len);
+    frame_len = flexframegen_getframelen(fg);
+    unsigned int n = num_frames*(frame_len + gap_len) + gap_len;
+    float complex * x = (float complex*) calloc(n, sizeof(float complex));
+    for (i=0; i<num_frames; i++) {
+        flexframegen_assemble(fg, header, payload, payload_len);
+        unsigned int num_written;
+        flexframegen_write_block(fg, x + gap_len + i*(frame_len + gap_len), frame_len, &num_written);
+    }
+    flexframegen_destroy(fg);
+
+    unsigned int num_decoded = 0;
+    flexframesync fs = flexframesync_create(flowgraph_autotest_framesync_callback, &num_decoded);
+    msresamp_crcf up   = msresamp_crcf_create(2.0f, 60.0f);
+    msresamp_crcf down = msresamp_crcf_create(0.5f, 60.0f);
+
+    struct flowgraph_autotest_source_s s = {x, n, 0, 0};
+    flowgraph g = flowgraph_create(2);
+    unsigned int b_src  = flowgraph_add_block(g, "source", 0, 0, 1, sizeof(float complex), flowgraph_autotest_source, &s);
+    unsigned int b_up   = flowgraph_add_msresamp_crcf(g, up);
+    unsigned int b_down = flowgraph_add_msresamp_crcf(g, down);
+    unsigned int b_sync = flowgraph_add_flexframesync(g, fs);
+    flowgraph_connect(g, b_src,  0, b_up,   0, 256);
+    flowgraph_connect(g, b_up,   0, b_down, 0, 256);
+    flowgraph_connect(g, b_down, 0, b_sync, 0, 256);
+    flowgraph_run(g);
+
+    if (liquid_autotest_verbose)
+        flowgraph_print(g);
+    CONTEND_EQUALITY( num_decoded, num_frames );
+
+    flowgraph_destroy(g);
+    flexframesync_destroy(fs);
+    msresamp_crcf_destroy(up);
+    msresamp_crcf_destroy(down);
+    free(x);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// counting allocator
+struct memory_test_counter {
+    long num_blocks;    // blocks outstanding
+    long num_calls;     // allocate calls
+};
+
+static void * memory_test_allocate(unsigned long _size, void * _userdata)
+{
+    struct memory_test_counter * c = (struct memory_test_counter*)_userdata;
+    c->num_blocks++;
+    c->num_calls++;
+    return malloc(_size);
+}
+
+static void memory_test_release(void * _ptr, void * _userdata)
+{
+    struct memory_test_counter * c = (struct memory_test_counter*)_userdata;
+    c->num_blocks--;
+    free(_ptr);
+}
+
+//
+// AUTOTEST : objects created under a thread allocator take all their
+// memory from it and return it on destroy
+//
+void autotest_memory_thread_allocator()
+{
+    struct memory_test_counter c = {0, 0};
+    liquid_allocator a = {memory_test_allocate, NULL, memory_test_release, &c};
+
+    liquid_set_thread_allocator(&a);
+    firfilt_crcf q = firfilt_crcf_create_kaiser(51, 0.2f, 60.0f, 0.0f);
+    ofdmflexframesync fs = ofdmflexframesync_create(64, 16, 4, NULL, NULL, NULL);
+    liquid_set_thread_allocator(NULL);
+
+    CONTEND_EXPRESSION( c.num_calls > 10 );
+    CONTEND_EXPRESSION( c.num_blocks > 0 );
+
+    // resizing without a reallocate function preserves contents and
+    // keeps the block with its allocator
+    float complex x[64];
+    unsigned int i;
+    for (i=0; i<64; i++)
+        x[i] = 0.01f*i;
+    ofdmflexframesync_execute(fs, x, 64);
+    firfilt_crcf_execute_block(q, x, 64, x);
+
+    // objects are released to the allocator that provided their memory
+    firfilt_crcf_destroy(q);
+    ofdmflexframesync_destroy(fs);
+    CONTEND_EQUALITY( c.num_blocks, 0 );
+}
+
+//
+// AUTOTEST : audit reports allocations on the calling thread
+//
+void autotest_memory_audit()
+{
+    firfilt_rrrf q = firfilt_rrrf_create_kaiser(21, 0.2f, 60.0f, 0.0f);
+    float x[32], y[32];
+    memset(x, 0x00, sizeof(x));
+
+    // filtering makes no allocations
+    liquid_allocator_audit_begin(1);
+    firfilt_rrrf_execute_block(q, x, 32, y);
+    CONTEND_EQUALITY( liquid_allocator_audit_end(), 0 );
+
+    // destroying an object releases memory
+    liquid_allocator_audit_begin(liquid_autotest_verbose);
+    firfilt_rrrf_destroy(q);
+    CONTEND_EXPRESSION( liquid_allocator_audit_end() > 0 );
+}
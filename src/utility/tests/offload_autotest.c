@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// batched transforms match individual transforms
+void autotest_offload_fft_batch()
+{
+    unsigned int n   = 64;
+    unsigned int num = 5;
+    liquid_offload q = liquid_offload_create(NULL);
+    CONTEND_EXPRESSION( strcmp(liquid_offload_get_backend_name(q), "host") == 0 );
+
+    float complex * x = (float complex*) liquid_offload_alloc(q, n*num*sizeof(float complex));
+    float complex * y = (float complex*) liquid_offload_alloc(q, n*num*sizeof(float complex));
+    unsigned int i, k;
+    for (i=0; i<n*num; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // submit twice, reusing the cached plan
+    unsigned long t0 = liquid_offload_fft_batch(q, LIQUID_FFT_FORWARD, n, num, x, y);
+    unsigned long t1 = liquid_offload_fft_batch(q, LIQUID_FFT_FORWARD, n, num, x, y);
+    CONTEND_LESS_THAN(t0, t1);
+    liquid_offload_wait(q, t1);
+    CONTEND_EXPRESSION( liquid_offload_is_done(q, t0) );
+    CONTEND_EQUALITY( liquid_offload_get_num_completed(q), 2 );
+
+    float complex z[n];
+    for (k=0; k<num; k++) {
+        fft_run(n, &x[k*n], z, LIQUID_FFT_FORWARD, 0);
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA( crealf(y[k*n+i]), crealf(z[i]), 1e-3f );
+            CONTEND_DELTA( cimagf(y[k*n+i]), cimagf(z[i]), 1e-3f );
+        }
+    }
+    liquid_offload_free(q, x);
+    liquid_offload_free(q, y);
+    liquid_offload_destroy(q);
+}
+
+// polyphase filter matrix product
+void autotest_offload_pfb()
+{
+    unsigned int M = 4, K = 7, N = 9;
+    liquid_offload q = liquid_offload_create(NULL);
+    float         h[M*K];
+    float complex x[K*N];
+    float complex y[M*N];
+    unsigned int i, j, c;
+    for (i=0; i<M*K; i++) h[i] = randnf();
+    for (i=0; i<K*N; i++) x[i] = randnf() + _Complex_I*randnf();
+
+    liquid_offload_wait(q, liquid_offload_pfb(q, M, K, N, h, x, y));
+    for (i=0; i<M; i++) {
+        for (c=0; c<N; c++) {
+            float complex v = 0.0f;
+            for (j=0; j<K; j++)
+                v += h[i*K+j] * x[j*N+c];
+            CONTEND_DELTA( crealf(y[i*N+c]), crealf(v), 1e-4f );
+            CONTEND_DELTA( cimagf(y[i*N+c]), cimagf(v), 1e-4f );
+        }
+    }
+    liquid_offload_destroy(q);
+}
+
+// multi-hypothesis correlation peaks at the applied delay and offset
+void autotest_offload_xcorr()
+{
+    unsigned int n = 128;
+    unsigned int d = 17;    // delay [samples]
+    int          o = -3;    // carrier offset [bins]
+    liquid_offload q = liquid_offload_create(NULL);
+
+    float complex s[n], x[n], S[n], X[n];
+    unsigned int i, k;
+    for (i=0; i<n; i++)
+        s[i] = i < n/2 ? randnf() + _Complex_I*randnf() : 0.0f;
+    for (i=0; i<n; i++)
+        x[(i+d)%n] = s[i] * cexpf(_Complex_I*2*M_PI*o*(float)i/(float)n);
+    fft_run(n, s, S, LIQUID_FFT_FORWARD, 0);
+    fft_run(n, x, X, LIQUID_FFT_FORWARD, 0);
+    for (i=0; i<n; i++)
+        S[i] = conjf(S[i]);
+
+    int offsets[7] = {-3, -2, -1, 0, 1, 2, 3};
+    float complex y[7*n];
+    liquid_offload_wait(q, liquid_offload_xcorr(q, n, X, S, 7, offsets, y));
+    liquid_offload_destroy(q);
+
+    float        peak   = 0.0f;
+    unsigned int index  = 0;
+    int          offset = 0;
+    for (k=0; k<7; k++) {
+        for (i=0; i<n; i++) {
+            if (cabsf(y[k*n+i]) > peak) {
+                peak   = cabsf(y[k*n+i]);
+                index  = i;
+                offset = offsets[k];
+            }
+        }
+    }
+    CONTEND_EQUALITY( index,  d );
+    CONTEND_EQUALITY( offset, o );
+}
+
+// user backend receives all jobs, in order
+static int offload_test_log[16];
+static int offload_test_num = 0;
+static int offload_test_fft(void * _ud, int _dir, unsigned int _n, unsigned int _num,
+                            const liquid_float_complex * _x, liquid_float_complex * _y)
+{ offload_test_log[offload_test_num++] = 1; return 0; }
+static int offload_test_pfb(void * _ud, unsigned int _m, unsigned int _k, unsigned int _n,
+                            const float * _h, const liquid_float_complex * _x, liquid_float_complex * _y)
+{ offload_test_log[offload_test_num++] = 2; return 0; }
+static int offload_test_xcorr(void * _ud, unsigned int _n, const liquid_float_complex * _x,
+                              const liquid_float_complex * _s, unsigned int _num, const int * _offsets,
+                              liquid_float_complex * _y)
+{ offload_test_log[offload_test_num++] = 3; return 0; }
+
+void autotest_offload_backend()
+{
+    liquid_offload_backend b = {"test", NULL, NULL, offload_test_fft, offload_test_pfb, offload_test_xcorr, NULL};
+    liquid_offload q = liquid_offload_create(&b);
+    CONTEND_EXPRESSION( strcmp(liquid_offload_get_backend_name(q), "test") == 0 );
+
+    float complex * buf = (float complex*) liquid_offload_alloc(q, 16*sizeof(float complex));
+    float h[1] = {1.0f};
+    int offsets[1] = {0};
+    unsigned int i;
+    offload_test_num = 0;
+    for (i=0; i<4; i++) {
+        liquid_offload_fft_batch(q, LIQUID_FFT_FORWARD, 16, 1, buf, buf);
+        liquid_offload_pfb(q, 1, 1, 16, h, buf, buf);
+        liquid_offload_xcorr(q, 16, buf, buf, 1, offsets, buf);
+    }
+    liquid_offload_wait(q, 0);
+    CONTEND_EQUALITY( offload_test_num, 12 );
+    for (i=0; i<12; i++)
+        CONTEND_EQUALITY( offload_test_log[i], (int)(i%3)+1 );
+    liquid_offload_free(q, buf);
+    liquid_offload_destroy(q);
+}
@@ -293,3 +293,54 @@ void autotest_repack_bytes_04_uneven() {
 
 
 
+
+//
+// AUTOTEST : block pack/unpack matches per-symbol pack/unpack for
+//            all symbol sizes and bit offsets, including symbols
+//            extending past the end of the array
+//
+void autotest_pack_array_block()
+{
+    unsigned int n = 37;    // array size [bytes]
+    unsigned char src[n];
+    unsigned char dst0[n];
+    unsigned char dst1[n];
+    unsigned int  syms0[8*n];
+    unsigned int  syms1[8*n];
+
+    unsigned int i, b, k;
+    for (b=1; b<=8; b++) {
+        for (k=0; k<19; k++) {
+            for (i=0; i<n; i++) {
+                src[i]  = rand() & 0xff;
+                dst0[i] = rand() & 0xff;
+                dst1[i] = dst0[i];
+            }
+            // all symbols starting within the array
+            unsigned int num_symbols = (8*n - k + b - 1) / b;
+
+            // unpack
+            for (i=0; i<num_symbols; i++) {
+                unsigned char sym;
+                liquid_unpack_array(src, n, k + i*b, b, &sym);
+                syms0[i] = sym;
+            }
+            liquid_unpack_array_block(src, n, k, b, syms1, num_symbols);
+            CONTEND_SAME_DATA( syms0, syms1, num_symbols*sizeof(unsigned int) );
+
+            // pack (symbols with bits set above _b are masked)
+            for (i=0; i<num_symbols; i++) {
+                syms0[i] = rand() & 0xff;
+                liquid_pack_array(dst0, n, k + i*b, b, syms0[i]);
+            }
+            liquid_pack_array_block(dst1, n, k, b, syms0, num_symbols);
+            CONTEND_SAME_DATA( dst0, dst1, n );
+
+            // partial block leaves trailing bits untouched
+            liquid_pack_array_block(dst1, n, k, b, syms1, num_symbols/3);
+            for (i=0; i<num_symbols/3; i++)
+                liquid_pack_array(dst0, n, k + i*b, b, syms1[i]);
+            CONTEND_SAME_DATA( dst0, dst1, n );
+        }
+    }
+}
@@ -28,6 +28,31 @@
 #include <string.h>
 #include <stdio.h>
 
+// initialize vector with scalar, unrolling loop
+//  _c      :   scalar
+//  _x      :   output array pointer [size: _n x 1]
+//  _n      :   array length
+void VECTOR(_init)(T            _c,
+                   T *          _x,
+                   unsigned int _n)
+{
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2; 
+
+    // compute in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        _x[i  ] = _c;
+        _x[i+1] = _c;
+        _x[i+2] = _c;
+        _x[i+3] = _c;
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _x[i] = _c;
+}
+
 // basic vector addition, unrolling loop
 //  _x      :   first array  [size: _n x 1]
 //  _y      :   second array [size: _n x 1]
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+//
+// vector_convert.c : conversion of interleaved 16-bit integer samples
+//                    to floating-point
+//
+// Front ends typically deliver interleaved signed 16-bit samples. The
+// block methods taking such inputs (e.g. firfilt_crcf_execute_block_ci16)
+// widen them with these kernels directly into their first-stage
+// buffers rather than through a separate full-length conversion pass.
+// The x86 kernels use widening loads and are selected at run time; all
+// versions compute the same single rounding of x[i]*scale.
+//
+
+#include "liquid.internal.h"
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_DOTPROD_AVX
+#include <immintrin.h>
+
+// convert _n values, eight per iteration (AVX2 sign-extending loads)
+__attribute__((target("avx2")))
+static void liquid_vectorf_from_s16_avx2(const int16_t * _x,
+                                         unsigned int    _n,
+                                         float           _scale,
+                                         float *         _y)
+{
+    __m256 g = _mm256_set1_ps(_scale);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)&_x[i]));
+        _mm256_storeu_ps(&_y[i], _mm256_mul_ps(_mm256_cvtepi32_ps(v), g));
+    }
+    for ( ; i<_n; i++)
+        _y[i] = (float)_x[i] * _scale;
+}
+#endif
+
+#if HAVE_EMMINTRIN_H
+// convert _n values, eight per iteration (SSE2 unpack and shift)
+static void liquid_vectorf_from_s16_sse(const int16_t * _x,
+                                        unsigned int    _n,
+                                        float           _scale,
+                                        float *         _y)
+{
+    __m128 g = _mm_set1_ps(_scale);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m128i v  = _mm_loadu_si128((const __m128i*)&_x[i]);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(&_y[i  ], _mm_mul_ps(_mm_cvtepi32_ps(lo), g));
+        _mm_storeu_ps(&_y[i+4], _mm_mul_ps(_mm_cvtepi32_ps(hi), g));
+    }
+    for ( ; i<_n; i++)
+        _y[i] = (float)_x[i] * _scale;
+}
+#endif
+
+// convert 16-bit integers to floating-point: y[i] = x[i] * scale
+void liquid_vectorf_from_s16(const int16_t * _x,
+                             unsigned int    _n,
+                             float           _scale,
+                             float *         _y)
+{
+#if HAVE_DOTPROD_AVX || HAVE_EMMINTRIN_H
+    liquid_simd_level level = liquid_simd_get_kernel(LIQUID_SIMD_VECTOR);
+#endif
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2) {
+        liquid_vectorf_from_s16_avx2(_x, _n, _scale, _y);
+        return;
+    }
+#endif
+#if HAVE_EMMINTRIN_H
+    if (level == LIQUID_SIMD_SSE) {
+        liquid_vectorf_from_s16_sse(_x, _n, _scale, _y);
+        return;
+    }
+#endif
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = (float)_x[i] * _scale;
+}
+
+// convert interleaved 16-bit in-phase/quadrature pairs to complex
+// floating-point: y[i] = (x[2i] + j x[2i+1]) * scale
+void liquid_vectorcf_from_ci16(const int16_t * _x,
+                               unsigned int    _n,
+                               float           _scale,
+                               float complex * _y)
+{
+    liquid_vectorf_from_s16(_x, 2*_n, _scale, (float*)_y);
+}
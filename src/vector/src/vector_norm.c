@@ -29,6 +29,34 @@
 #include <stdio.h>
 #include <math.h>
 
+// compute sum of squares on vector
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+TP VECTOR(_sumsq)(T *          _x,
+                  unsigned int _n)
+{
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2; 
+
+    // initialize accumulator
+    TP sumsq = 0;
+
+    // compute in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        sumsq += crealf( _x[i  ]*conjf(_x[i  ]) );
+        sumsq += crealf( _x[i+1]*conjf(_x[i+1]) );
+        sumsq += crealf( _x[i+2]*conjf(_x[i+2]) );
+        sumsq += crealf( _x[i+3]*conjf(_x[i+3]) );
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        sumsq += crealf( _x[i]*conjf(_x[i]) );
+
+    return sumsq;
+}
+
 // compute l2-norm on vector
 //  _x      :   input array [size: _n x 1]
 //  _n      :   array length
@@ -61,6 +89,36 @@ TP VECTOR(_norm)(T *          _x,
     return sqrtf(norm);
 }
 
+// compute l-p norm on vector
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _p      :   norm order, _p > 0
+TP VECTOR(_pnorm)(T *          _x,
+                  unsigned int _n,
+                  TP           _p)
+{
+    // validate input
+    if (_p <= 0) {
+        fprintf(stderr,"error: liquid_vector_pnorm(), norm order must be greater than zero\n");
+        exit(1);
+    }
+
+    // initialize accumulator
+    TP norm = 0;
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+#if T_COMPLEX
+        norm += powf(cabsf(_x[i]), _p);
+#else
+        norm += powf(fabsf(_x[i]), _p);
+#endif
+    }
+
+    // return root of accumulation
+    return powf(norm, 1.0f/_p);
+}
+
 // scale vector to its l2-norm
 //  _x      :   input array [size: _n x 1]
 //  _n      :   array length
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vector_split.c : split-complex (structure-of-arrays) vectors
+//
+// Split-complex arrays keep the real and imaginary parts of a complex
+// vector in two separate float arrays, so that complex arithmetic maps
+// onto plain element-wise vector operations without shuffling real and
+// imaginary parts apart. Pipelines can convert once at their ends and
+// keep the intermediate results split (see also dotprod_cccf_run_split
+// and fft_create_plan_split). The x86 kernels are selected at run time.
+//
+
+#include "liquid.internal.h"
+
+#if HAVE_DOTPROD_AVX
+#include <immintrin.h>
+
+// de-interleave _n values, eight per iteration (AVX2)
+__attribute__((target("avx2")))
+static void liquid_vectorcf_split_avx2(const float * _x,
+                                       unsigned int  _n,
+                                       float *       _xr,
+                                       float *       _xi)
+{
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 a = _mm256_loadu_ps(&_x[2*i  ]);   // r0 i0 r1 i1 r2 i2 r3 i3
+        __m256 b = _mm256_loadu_ps(&_x[2*i+8]);   // r4 i4 r5 i5 r6 i6 r7 i7
+        __m256 r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+        __m256 q = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+        _mm256_storeu_ps(&_xr[i], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), _MM_SHUFFLE(3,1,2,0))));
+        _mm256_storeu_ps(&_xi[i], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(q), _MM_SHUFFLE(3,1,2,0))));
+    }
+    for ( ; i<_n; i++) {
+        _xr[i] = _x[2*i  ];
+        _xi[i] = _x[2*i+1];
+    }
+}
+
+// interleave _n values, eight per iteration (AVX2)
+__attribute__((target("avx2")))
+static void liquid_vectorcf_merge_avx2(const float * _xr,
+                                       const float * _xi,
+                                       unsigned int  _n,
+                                       float *       _y)
+{
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 r  = _mm256_loadu_ps(&_xr[i]);
+        __m256 q  = _mm256_loadu_ps(&_xi[i]);
+        __m256 lo = _mm256_unpacklo_ps(r, q);   // r0 i0 r1 i1 r4 i4 r5 i5
+        __m256 hi = _mm256_unpackhi_ps(r, q);   // r2 i2 r3 i3 r6 i6 r7 i7
+        _mm256_storeu_ps(&_y[2*i  ], _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(&_y[2*i+8], _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    for ( ; i<_n; i++) {
+        _y[2*i  ] = _xr[i];
+        _y[2*i+1] = _xi[i];
+    }
+}
+
+// multiply _n values, eight per iteration (AVX2/FMA)
+__attribute__((target("avx2,fma")))
+static void liquid_vectorcf_mul_split_avx2(const float * _xr,
+                                           const float * _xi,
+                                           const float * _yr,
+                                           const float * _yi,
+                                           unsigned int  _n,
+                                           float *       _zr,
+                                           float *       _zi)
+{
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 ar = _mm256_loadu_ps(&_xr[i]);
+        __m256 ai = _mm256_loadu_ps(&_xi[i]);
+        __m256 br = _mm256_loadu_ps(&_yr[i]);
+        __m256 bi = _mm256_loadu_ps(&_yi[i]);
+        __m256 cr = _mm256_fmsub_ps(ar, br, _mm256_mul_ps(ai, bi));
+        __m256 ci = _mm256_fmadd_ps(ar, bi, _mm256_mul_ps(ai, br));
+        _mm256_storeu_ps(&_zr[i], cr);
+        _mm256_storeu_ps(&_zi[i], ci);
+    }
+    for ( ; i<_n; i++) {
+        float ar = _xr[i], ai = _xi[i];
+        float br = _yr[i], bi = _yi[i];
+        _zr[i] = ar*br - ai*bi;
+        _zi[i] = ar*bi + ai*br;
+    }
+}
+#endif
+
+// split complex array into real and imaginary parts
+void liquid_vectorcf_split(const float complex * _x,
+                           unsigned int          _n,
+                           float *               _xr,
+                           float *               _xi)
+{
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_VECTOR) == LIQUID_SIMD_AVX2) {
+        liquid_vectorcf_split_avx2((const float*)_x, _n, _xr, _xi);
+        return;
+    }
+#endif
+    const float * x = (const float*)_x;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _xr[i] = x[2*i  ];
+        _xi[i] = x[2*i+1];
+    }
+}
+
+// merge real and imaginary parts into complex array
+void liquid_vectorcf_merge(const float *   _xr,
+                           const float *   _xi,
+                           unsigned int    _n,
+                           float complex * _y)
+{
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_VECTOR) == LIQUID_SIMD_AVX2) {
+        liquid_vectorcf_merge_avx2(_xr, _xi, _n, (float*)_y);
+        return;
+    }
+#endif
+    float * y = (float*)_y;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        y[2*i  ] = _xr[i];
+        y[2*i+1] = _xi[i];
+    }
+}
+
+// multiply each element of split-complex arrays: z[i] = x[i] * y[i]
+void liquid_vectorcf_mul_split(const float * _xr,
+                               const float * _xi,
+                               const float * _yr,
+                               const float * _yi,
+                               unsigned int  _n,
+                               float *       _zr,
+                               float *       _zi)
+{
+#if HAVE_DOTPROD_AVX
+    if (liquid_simd_get_kernel(LIQUID_SIMD_VECTOR) == LIQUID_SIMD_AVX2) {
+        liquid_vectorcf_mul_split_avx2(_xr, _xi, _yr, _yi, _n, _zr, _zi);
+        return;
+    }
+#endif
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float ar = _xr[i], ai = _xi[i];
+        float br = _yr[i], bi = _yi[i];
+        _zr[i] = ar*br - ai*bi;
+        _zi[i] = ar*bi + ai*br;
+    }
+}
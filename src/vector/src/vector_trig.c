@@ -38,33 +38,34 @@ void VECTOR(_cexpj)(TP *         _theta,
                     unsigned int _n,
                     T *          _x)
 {
+#if T_COMPLEX
+    // evaluate sine and cosine in blocks (see liquid_sincosf_block)
+    TP s[64];
+    TP c[64];
+    unsigned int i0, i;
+    for (i0=0; i0<_n; i0+=64) {
+        unsigned int n = _n - i0 < 64 ? _n - i0 : 64;
+        liquid_sincosf_block(_theta + i0, n, s, c, LIQUID_TRIG_FAST);
+        for (i=0; i<n; i++)
+            _x[i0+i] = c[i] + _Complex_I*s[i];
+    }
+#else
     // t = 4*(floor(_n/4))
     unsigned int t=(_n>>2)<<2; 
 
     // compute in groups of 4
     unsigned int i;
     for (i=0; i<t; i+=4) {
-#if T_COMPLEX
-        _x[i  ] = cexpf(_Complex_I*_theta[i  ]);
-        _x[i+1] = cexpf(_Complex_I*_theta[i+1]);
-        _x[i+2] = cexpf(_Complex_I*_theta[i+2]);
-        _x[i+3] = cexpf(_Complex_I*_theta[i+3]);
-#else
         _x[i  ] = _theta[i  ] > 0 ? 1.0 : -1.0;
         _x[i+1] = _theta[i+1] > 0 ? 1.0 : -1.0;
         _x[i+2] = _theta[i+2] > 0 ? 1.0 : -1.0;
         _x[i+3] = _theta[i+3] > 0 ? 1.0 : -1.0;
-#endif
     }
 
     // clean up remaining
-    for ( ; i<_n; i++) {
-#if T_COMPLEX
-        _x[i] = cexpf(_Complex_I*_theta[i]);
-#else
+    for ( ; i<_n; i++)
         _x[i] = _theta[i] > 0 ? 1.0 : -1.0;
 #endif
-    }
 }
 
 // compute complex phase rotation: x[i] = exp{ j theta[i] }
@@ -124,10 +125,10 @@ void VECTOR(_abs)(T *          _x,
         _y[i+2] = cabsf(_x[i+2]);
         _y[i+3] = cabsf(_x[i+3]);
 #else
-        _x[i  ] = fabsf(_x[i  ]);
-        _x[i+1] = fabsf(_x[i+1]);
-        _x[i+2] = fabsf(_x[i+2]);
-        _x[i+3] = fabsf(_x[i+3]);
+        _y[i  ] = fabsf(_x[i  ]);
+        _y[i+1] = fabsf(_x[i+1]);
+        _y[i+2] = fabsf(_x[i+2]);
+        _y[i+3] = fabsf(_x[i+3]);
 #endif
     }
 
@@ -136,7 +137,7 @@ void VECTOR(_abs)(T *          _x,
 #if T_COMPLEX
         _y[i] = cabsf(_x[i]);
 #else
-        _x[i] = fabsf(_x[i]);
+        _y[i] = fabsf(_x[i]);
 #endif
     }
 }
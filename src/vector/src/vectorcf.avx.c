@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorcf.avx.c : complex floating-point element-wise vector kernels
+//                  (x86 AVX2/FMA)
+//
+// These kernels are compiled with per-function target attributes and
+// are selected at run time by the dispatch in vectorcf.mmx.c. The
+// phase rotation and angle kernels evaluate minimax polynomials after
+// range reduction and agree with cexpf() and cargf() to within a few
+// units in the last place; blocks containing non-finite or very large
+// arguments are handed to the C library.
+//
+
+#include <immintrin.h>
+#include <float.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// range reduction limit for phase rotation
+#define LIQUID_VECTOR_SINCOS_MAX    (8192.0f)
+
+// complex multiply of four interleaved values
+__attribute__((target("avx2,fma")))
+static inline __m256 liquid_vectorcf_cmul4(__m256 _a, __m256 _b)
+{
+    __m256 br = _mm256_moveldup_ps(_b);
+    __m256 bi = _mm256_movehdup_ps(_b);
+    __m256 as = _mm256_permute_ps(_a, 0xb1);
+    return _mm256_fmaddsub_ps(_a, br, _mm256_mul_ps(as, bi));
+}
+
+// load eight complex samples as in-phase and quadrature vectors
+__attribute__((target("avx2,fma")))
+static inline void liquid_vectorcf_load8(float *  _x,
+                                         __m256 * _re,
+                                         __m256 * _im)
+{
+    __m256 a = _mm256_loadu_ps(_x    );
+    __m256 b = _mm256_loadu_ps(_x + 8);
+
+    // [a0 a2 b0 b2 | a4 a6 b4 b6] -> [0 2 4 6 8 10 12 14]
+    __m256 re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+    __m256 im = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+    *_re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re), _MM_SHUFFLE(3,1,2,0)));
+    *_im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im), _MM_SHUFFLE(3,1,2,0)));
+}
+
+// sine and cosine of eight values with |_x| <= LIQUID_VECTOR_SINCOS_MAX:
+// reduce by the nearest multiple of pi/2 (three-part Cody-Waite) and
+// select/negate the polynomials on [-pi/4,pi/4] by quadrant
+__attribute__((target("avx2,fma")))
+static inline void liquid_vectorcf_sincos8(__m256   _x,
+                                           __m256 * _s,
+                                           __m256 * _c)
+{
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i two = _mm256_set1_epi32(2);
+    __m256i q   = _mm256_cvtps_epi32(_mm256_mul_ps(_x, _mm256_set1_ps((float)M_2_PI)));
+    __m256  qf  = _mm256_cvtepi32_ps(q);
+    __m256  r   = _mm256_fnmadd_ps(qf, _mm256_set1_ps(1.5703125f), _x);
+    r = _mm256_fnmadd_ps(qf, _mm256_set1_ps(4.837512969970703125e-4f), r);
+    r = _mm256_fnmadd_ps(qf, _mm256_set1_ps(7.54978995489188216e-8f),  r);
+    __m256  z   = _mm256_mul_ps(r, r);
+
+    // sin(r) and cos(r)
+    __m256 ps = _mm256_set1_ps(-1.9515295891e-4f);
+    ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps( 8.3321608736e-3f));
+    ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps(-1.6666654611e-1f));
+    ps = _mm256_fmadd_ps(ps, _mm256_mul_ps(z, r), r);
+    __m256 pc = _mm256_set1_ps( 2.443315711809948e-5f);
+    pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps(-1.388731625493765e-3f));
+    pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps( 4.166664568298827e-2f));
+    pc = _mm256_fmadd_ps(pc, _mm256_mul_ps(z, z),
+                         _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, _mm256_set1_ps(1.0f)));
+
+    // odd quadrants swap sine and cosine; negate sine in quadrants
+    // 2,3 and cosine in quadrants 1,2
+    __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+    __m256 s = _mm256_blendv_ps(ps, pc, swap);
+    __m256 c = _mm256_blendv_ps(pc, ps, swap);
+    __m256i sn = _mm256_slli_epi32(_mm256_and_si256(q, two), 30);
+    __m256i cn = _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, one), two), 30);
+    *_s = _mm256_xor_ps(s, _mm256_castsi256_ps(sn));
+    *_c = _mm256_xor_ps(c, _mm256_castsi256_ps(cn));
+}
+
+// four-quadrant arc tangent of eight finite values: reflect into
+// [0,pi/4], fold [tan(pi/8),1] about pi/4, evaluate polynomial
+__attribute__((target("avx2,fma")))
+static inline __m256 liquid_vectorcf_atan2_8(__m256 _y,
+                                             __m256 _x)
+{
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 one  = _mm256_set1_ps(1.0f);
+    __m256 a    = _mm256_andnot_ps(sign, _y);
+    __m256 b    = _mm256_andnot_ps(sign, _x);
+    __m256 t    = _mm256_div_ps(_mm256_min_ps(a,b),
+                                _mm256_max_ps(_mm256_max_ps(a,b), _mm256_set1_ps(FLT_MIN)));
+    __m256 fold = _mm256_cmp_ps(t, _mm256_set1_ps(0.414213562373095f), _CMP_GT_OQ);
+    t = _mm256_blendv_ps(t, _mm256_div_ps(_mm256_sub_ps(t, one), _mm256_add_ps(t, one)), fold);
+    __m256 z = _mm256_mul_ps(t, t);
+
+    __m256 p = _mm256_set1_ps(8.05374449538e-2f);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-1.38776856032e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps( 1.99777106478e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33329491539e-1f));
+    p = _mm256_fmadd_ps(p, _mm256_mul_ps(z, t), t);
+    p = _mm256_add_ps(p, _mm256_and_ps(fold, _mm256_set1_ps((float)M_PI_4)));
+
+    // reflect into proper octant, quadrant and half plane
+    p = _mm256_blendv_ps(p, _mm256_sub_ps(_mm256_set1_ps((float)M_PI_2), p), _mm256_cmp_ps(a, b, _CMP_GT_OQ));
+    p = _mm256_blendv_ps(p, _mm256_sub_ps(_mm256_set1_ps((float)M_PI),   p), _x);
+    return _mm256_or_ps(p, _mm256_and_ps(sign, _y));
+}
+
+// initialize vector with scalar (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorcf_init_avx2(float complex   _c,
+                               float complex * _x,
+                               unsigned int    _n)
+{
+    float * x = (float*) _x;
+    __m256 c = _mm256_setr_ps(crealf(_c), cimagf(_c), crealf(_c), cimagf(_c),
+                              crealf(_c), cimagf(_c), crealf(_c), cimagf(_c));
+    unsigned int i;
+    for (i=0; i+4<=_n; i+=4)
+        _mm256_storeu_ps(x + 2*i, c);
+    for ( ; i<_n; i++)
+        _x[i] = _c;
+}
+
+// add scalar to each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorcf_addscalar_avx2(float complex * _x,
+                                    unsigned int    _n,
+                                    float complex   _c,
+                                    float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m256 c = _mm256_setr_ps(crealf(_c), cimagf(_c), crealf(_c), cimagf(_c),
+                              crealf(_c), cimagf(_c), crealf(_c), cimagf(_c));
+    unsigned int i;
+    for (i=0; i+4<=_n; i+=4)
+        _mm256_storeu_ps(y + 2*i, _mm256_add_ps(_mm256_loadu_ps(x + 2*i), c));
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _c;
+}
+
+// multiply each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorcf_mul_avx2(float complex * _x,
+                              float complex * _y,
+                              unsigned int    _n,
+                              float complex * _z)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+    unsigned int i;
+    for (i=0; i+4<=_n; i+=4)
+        _mm256_storeu_ps(z + 2*i, liquid_vectorcf_cmul4(_mm256_loadu_ps(x + 2*i),
+                                                        _mm256_loadu_ps(y + 2*i)));
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// multiply each element with scalar (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorcf_mulscalar_avx2(float complex * _x,
+                                    unsigned int    _n,
+                                    float complex   _c,
+                                    float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m256 cr = _mm256_set1_ps(crealf(_c));
+    __m256 ci = _mm256_set1_ps(cimagf(_c));
+    unsigned int i;
+    for (i=0; i+4<=_n; i+=4) {
+        __m256 v = _mm256_loadu_ps(x + 2*i);
+        __m256 s = _mm256_mul_ps(_mm256_permute_ps(v, 0xb1), ci);
+        _mm256_storeu_ps(y + 2*i, _mm256_fmaddsub_ps(v, cr, s));
+    }
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _c;
+}
+
+// compute complex phase rotation (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorcf_cexpj_avx2(float *         _theta,
+                                unsigned int    _n,
+                                float complex * _x)
+{
+    float * x = (float*) _x;
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 lim  = _mm256_set1_ps(LIQUID_VECTOR_SINCOS_MAX);
+    unsigned int i, k;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 theta = _mm256_loadu_ps(_theta + i);
+        if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign, theta), lim, _CMP_NLE_UQ))) {
+            for (k=i; k<i+8; k++)
+                _x[k] = cexpf(_Complex_I*_theta[k]);
+            continue;
+        }
+
+        // interleave cosine (real) and sine (imaginary) parts
+        __m256 s, c;
+        liquid_vectorcf_sincos8(theta, &s, &c);
+        __m256 lo = _mm256_unpacklo_ps(c, s);
+        __m256 hi = _mm256_unpackhi_ps(c, s);
+        _mm256_storeu_ps(x + 2*i,     _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(x + 2*i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    for ( ; i<_n; i++)
+        _x[i] = cexpf(_Complex_I*_theta[i]);
+}
+
+// compute angle of each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorcf_carg_avx2(float complex * _x,
+                               unsigned int    _n,
+                               float *         _theta)
+{
+    __m256 zero = _mm256_setzero_ps();
+    unsigned int i, k;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 re, im;
+        liquid_vectorcf_load8((float*)(_x + i), &re, &im);
+        if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_mul_ps(re, zero), _mm256_mul_ps(im, zero), _CMP_UNORD_Q))) {
+            for (k=i; k<i+8; k++)
+                _theta[k] = cargf(_x[k]);
+            continue;
+        }
+        _mm256_storeu_ps(_theta + i, liquid_vectorcf_atan2_8(im, re));
+    }
+    for ( ; i<_n; i++)
+        _theta[i] = cargf(_x[i]);
+}
+
+// compute absolute value of each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorcf_abs_avx2(float complex * _x,
+                              unsigned int    _n,
+                              float *         _y)
+{
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 re, im;
+        liquid_vectorcf_load8((float*)(_x + i), &re, &im);
+        _mm256_storeu_ps(_y + i, _mm256_sqrt_ps(_mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im))));
+    }
+    for ( ; i<_n; i++)
+        _y[i] = cabsf(_x[i]);
+}
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorcf.mmx.c : complex floating-point element-wise vector
+//                  operations (SSE3 with AVX2 dispatch)
+//
+// The phase rotation and angle kernels evaluate minimax polynomials
+// after range reduction and agree with cexpf() and cargf() to within a
+// few units in the last place; blocks containing non-finite or very
+// large arguments are handed to the C library.
+//
+
+#include <float.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
+//
+// portable kernels (dispatch fallback and SIMD tails)
+//
+
+#define VECTOR(name)    liquid_vectorcf ## name ## _portable
+#define T               float complex
+#define TP              float
+#define T_COMPLEX       1
+
+#include "vector_add.c"
+#include "vector_mul.c"
+#include "vector_norm.c"
+#include "vector_trig.c"
+
+#undef VECTOR
+#undef T
+#undef TP
+#undef T_COMPLEX
+
+#if HAVE_PMMINTRIN_H
+//
+// SSE kernels
+//
+
+// range reduction limit for phase rotation
+#define LIQUID_VECTOR_SINCOS_MAX    (8192.0f)
+
+// select _a where mask is set, _b otherwise
+static inline __m128 liquid_vectorcf_select4(__m128 _mask,
+                                             __m128 _a,
+                                             __m128 _b)
+{
+    return _mm_or_ps(_mm_and_ps(_mask, _a), _mm_andnot_ps(_mask, _b));
+}
+
+// complex multiply of two interleaved values
+static inline __m128 liquid_vectorcf_cmul2(__m128 _a,
+                                           __m128 _b)
+{
+    __m128 br = _mm_moveldup_ps(_b);
+    __m128 bi = _mm_movehdup_ps(_b);
+    __m128 as = _mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1));
+    return _mm_addsub_ps(_mm_mul_ps(_a, br), _mm_mul_ps(as, bi));
+}
+
+// load four complex samples as in-phase and quadrature vectors
+static inline void liquid_vectorcf_load4(float *  _x,
+                                         __m128 * _re,
+                                         __m128 * _im)
+{
+    __m128 a = _mm_loadu_ps(_x    );
+    __m128 b = _mm_loadu_ps(_x + 4);
+    *_re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+    *_im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+}
+
+// sine and cosine of four values with |_x| <= LIQUID_VECTOR_SINCOS_MAX:
+// reduce by the nearest multiple of pi/2 (three-part Cody-Waite) and
+// select/negate the polynomials on [-pi/4,pi/4] by quadrant
+static inline void liquid_vectorcf_sincos4(__m128   _x,
+                                           __m128 * _s,
+                                           __m128 * _c)
+{
+    __m128i one = _mm_set1_epi32(1);
+    __m128i two = _mm_set1_epi32(2);
+    __m128i q   = _mm_cvtps_epi32(_mm_mul_ps(_x, _mm_set1_ps((float)M_2_PI)));
+    __m128  qf  = _mm_cvtepi32_ps(q);
+    __m128  r   = _mm_sub_ps(_x, _mm_mul_ps(qf, _mm_set1_ps(1.5703125f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(4.837512969970703125e-4f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(7.54978995489188216e-8f)));
+    __m128  z   = _mm_mul_ps(r, r);
+
+    // sin(r) and cos(r)
+    __m128 ps = _mm_set1_ps(-1.9515295891e-4f);
+    ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps( 8.3321608736e-3f));
+    ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(-1.6666654611e-1f));
+    ps = _mm_add_ps(_mm_mul_ps(ps, _mm_mul_ps(z, r)), r);
+    __m128 pc = _mm_set1_ps( 2.443315711809948e-5f);
+    pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(-1.388731625493765e-3f));
+    pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps( 4.166664568298827e-2f));
+    pc = _mm_add_ps(_mm_mul_ps(pc, _mm_mul_ps(z, z)),
+                    _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)));
+
+    // odd quadrants swap sine and cosine; negate sine in quadrants
+    // 2,3 and cosine in quadrants 1,2
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+    __m128 s = liquid_vectorcf_select4(swap, pc, ps);
+    __m128 c = liquid_vectorcf_select4(swap, ps, pc);
+    __m128i sn = _mm_slli_epi32(_mm_and_si128(q, two), 30);
+    __m128i cn = _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30);
+    *_s = _mm_xor_ps(s, _mm_castsi128_ps(sn));
+    *_c = _mm_xor_ps(c, _mm_castsi128_ps(cn));
+}
+
+// four-quadrant arc tangent of four finite values: reflect into
+// [0,pi/4], fold [tan(pi/8),1] about pi/4, evaluate polynomial
+static inline __m128 liquid_vectorcf_atan2_4(__m128 _y,
+                                             __m128 _x)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 one  = _mm_set1_ps(1.0f);
+    __m128 a    = _mm_andnot_ps(sign, _y);
+    __m128 b    = _mm_andnot_ps(sign, _x);
+    __m128 t    = _mm_div_ps(_mm_min_ps(a,b), _mm_max_ps(_mm_max_ps(a,b), _mm_set1_ps(FLT_MIN)));
+    __m128 fold = _mm_cmpgt_ps(t, _mm_set1_ps(0.414213562373095f));
+    t = liquid_vectorcf_select4(fold, _mm_div_ps(_mm_sub_ps(t, one), _mm_add_ps(t, one)), t);
+    __m128 z = _mm_mul_ps(t, t);
+
+    __m128 p = _mm_set1_ps(8.05374449538e-2f);
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-1.38776856032e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps( 1.99777106478e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-3.33329491539e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, _mm_mul_ps(z, t)), t);
+    p = _mm_add_ps(p, _mm_and_ps(fold, _mm_set1_ps((float)M_PI_4)));
+
+    // reflect into proper octant, quadrant and half plane
+    __m128 xneg = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(_x), 31));
+    p = liquid_vectorcf_select4(_mm_cmpgt_ps(a, b), _mm_sub_ps(_mm_set1_ps((float)M_PI_2), p), p);
+    p = liquid_vectorcf_select4(xneg,               _mm_sub_ps(_mm_set1_ps((float)M_PI),   p), p);
+    return _mm_or_ps(p, _mm_and_ps(sign, _y));
+}
+
+static void liquid_vectorcf_init_sse(float complex   _c,
+                                     float complex * _x,
+                                     unsigned int    _n)
+{
+    float * x = (float*) _x;
+    __m128 c = _mm_setr_ps(crealf(_c), cimagf(_c), crealf(_c), cimagf(_c));
+    unsigned int t = _n & ~1u;
+    unsigned int i;
+    for (i=0; i<t; i+=2)
+        _mm_storeu_ps(x + 2*i, c);
+    liquid_vectorcf_init_portable(_c, _x + t, _n - t);
+}
+
+static void liquid_vectorcf_addscalar_sse(float complex * _x,
+                                          unsigned int    _n,
+                                          float complex   _c,
+                                          float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m128 c = _mm_setr_ps(crealf(_c), cimagf(_c), crealf(_c), cimagf(_c));
+    unsigned int t = _n & ~1u;
+    unsigned int i;
+    for (i=0; i<t; i+=2)
+        _mm_storeu_ps(y + 2*i, _mm_add_ps(_mm_loadu_ps(x + 2*i), c));
+    liquid_vectorcf_addscalar_portable(_x + t, _n - t, _c, _y + t);
+}
+
+static void liquid_vectorcf_mul_sse(float complex * _x,
+                                    float complex * _y,
+                                    unsigned int    _n,
+                                    float complex * _z)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+    unsigned int t = _n & ~1u;
+    unsigned int i;
+    for (i=0; i<t; i+=2)
+        _mm_storeu_ps(z + 2*i, liquid_vectorcf_cmul2(_mm_loadu_ps(x + 2*i), _mm_loadu_ps(y + 2*i)));
+    liquid_vectorcf_mul_portable(_x + t, _y + t, _n - t, _z + t);
+}
+
+static void liquid_vectorcf_mulscalar_sse(float complex * _x,
+                                          unsigned int    _n,
+                                          float complex   _c,
+                                          float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m128 cr = _mm_set1_ps(crealf(_c));
+    __m128 ci = _mm_set1_ps(cimagf(_c));
+    unsigned int t = _n & ~1u;
+    unsigned int i;
+    for (i=0; i<t; i+=2) {
+        __m128 v = _mm_loadu_ps(x + 2*i);
+        __m128 s = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2,3,0,1)), ci);
+        _mm_storeu_ps(y + 2*i, _mm_addsub_ps(_mm_mul_ps(v, cr), s));
+    }
+    liquid_vectorcf_mulscalar_portable(_x + t, _n - t, _c, _y + t);
+}
+
+static void liquid_vectorcf_cexpj_sse(float *         _theta,
+                                      unsigned int    _n,
+                                      float complex * _x)
+{
+    float * x = (float*) _x;
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 lim  = _mm_set1_ps(LIQUID_VECTOR_SINCOS_MAX);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 theta = _mm_loadu_ps(_theta + i);
+        if (_mm_movemask_ps(_mm_cmpnle_ps(_mm_andnot_ps(sign, theta), lim))) {
+            liquid_vectorcf_cexpj_portable(_theta + i, 4, _x + i);
+            continue;
+        }
+
+        // interleave cosine (real) and sine (imaginary) parts
+        __m128 s, c;
+        liquid_vectorcf_sincos4(theta, &s, &c);
+        _mm_storeu_ps(x + 2*i,     _mm_unpacklo_ps(c, s));
+        _mm_storeu_ps(x + 2*i + 4, _mm_unpackhi_ps(c, s));
+    }
+    liquid_vectorcf_cexpj_portable(_theta + t, _n - t, _x + t);
+}
+
+static void liquid_vectorcf_carg_sse(float complex * _x,
+                                     unsigned int    _n,
+                                     float *         _theta)
+{
+    __m128 zero = _mm_setzero_ps();
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 re, im;
+        liquid_vectorcf_load4((float*)(_x + i), &re, &im);
+        if (_mm_movemask_ps(_mm_cmpunord_ps(_mm_mul_ps(re, zero), _mm_mul_ps(im, zero)))) {
+            liquid_vectorcf_carg_portable(_x + i, 4, _theta + i);
+            continue;
+        }
+        _mm_storeu_ps(_theta + i, liquid_vectorcf_atan2_4(im, re));
+    }
+    liquid_vectorcf_carg_portable(_x + t, _n - t, _theta + t);
+}
+
+static void liquid_vectorcf_abs_sse(float complex * _x,
+                                    unsigned int    _n,
+                                    float *         _y)
+{
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 re, im;
+        liquid_vectorcf_load4((float*)(_x + i), &re, &im);
+        _mm_storeu_ps(_y + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im))));
+    }
+    liquid_vectorcf_abs_portable(_x + t, _n - t, _y + t);
+}
+#endif
+
+//
+// run-time dispatch
+//
+
+// initialize vector with scalar: x[i] = c
+void liquid_vectorcf_init(float complex   _c,
+                          float complex * _x,
+                          unsigned int    _n)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorcf_init_avx2(_c, _x, _n);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorcf_init_sse(_c, _x, _n);
+        return;
+    }
+#endif
+    liquid_vectorcf_init_portable(_c, _x, _n);
+}
+
+// add each element: z[i] = x[i] + y[i]; same as the real operation
+// on the interleaved components
+void liquid_vectorcf_add(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    liquid_vectorf_add((float*)_x, (float*)_y, 2*_n, (float*)_z);
+}
+
+// add scalar to each element: y[i] = x[i] + c
+void liquid_vectorcf_addscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _c,
+                               float complex * _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorcf_addscalar_avx2(_x, _n, _c, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorcf_addscalar_sse(_x, _n, _c, _y);
+        return;
+    }
+#endif
+    liquid_vectorcf_addscalar_portable(_x, _n, _c, _y);
+}
+
+// multiply each element: z[i] = x[i] * y[i]
+void liquid_vectorcf_mul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorcf_mul_avx2(_x, _y, _n, _z);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorcf_mul_sse(_x, _y, _n, _z);
+        return;
+    }
+#endif
+    liquid_vectorcf_mul_portable(_x, _y, _n, _z);
+}
+
+// multiply each element with scalar: y[i] = x[i] * c
+void liquid_vectorcf_mulscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _c,
+                               float complex * _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorcf_mulscalar_avx2(_x, _n, _c, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorcf_mulscalar_sse(_x, _n, _c, _y);
+        return;
+    }
+#endif
+    liquid_vectorcf_mulscalar_portable(_x, _n, _c, _y);
+}
+
+// compute complex phase rotation: x[i] = exp{j theta[i]}
+void liquid_vectorcf_cexpj(float *         _theta,
+                           unsigned int    _n,
+                           float complex * _x)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorcf_cexpj_avx2(_theta, _n, _x);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorcf_cexpj_sse(_theta, _n, _x);
+        return;
+    }
+#endif
+    liquid_vectorcf_cexpj_portable(_theta, _n, _x);
+}
+
+// compute angle of each element: theta[i] = arg{ x[i] }
+void liquid_vectorcf_carg(float complex * _x,
+                          unsigned int    _n,
+                          float *         _theta)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorcf_carg_avx2(_x, _n, _theta);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorcf_carg_sse(_x, _n, _theta);
+        return;
+    }
+#endif
+    liquid_vectorcf_carg_portable(_x, _n, _theta);
+}
+
+// compute absolute value of each element: y[i] = |x[i]|
+void liquid_vectorcf_abs(float complex * _x,
+                         unsigned int    _n,
+                         float *         _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorcf_abs_avx2(_x, _n, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorcf_abs_sse(_x, _n, _y);
+        return;
+    }
+#endif
+    liquid_vectorcf_abs_portable(_x, _n, _y);
+}
+
+// sum of squares; the SIMD levels share the dispatched sumsq kernels
+float liquid_vectorcf_sumsq(float complex * _x,
+                            unsigned int    _n)
+{
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE)
+        return liquid_sumsqcf(_x, _n);
+    return liquid_vectorcf_sumsq_portable(_x, _n);
+}
+
+// l-2 norm: sqrt{ sum{ |x|^2 } }
+float liquid_vectorcf_norm(float complex * _x,
+                           unsigned int    _n)
+{
+    return sqrtf(liquid_vectorcf_sumsq(_x, _n));
+}
+
+// l-p norm: { sum{ |x|^p } }^(1/p); powf() dominates, portable only
+float liquid_vectorcf_pnorm(float complex * _x,
+                            unsigned int    _n,
+                            float           _p)
+{
+    return liquid_vectorcf_pnorm_portable(_x, _n, _p);
+}
+
+// scale vector elements by l-2 norm: y[i] = x[i]/norm(x); the scale
+// is real so the interleaved components are scaled as real values
+void liquid_vectorcf_normalize(float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    liquid_vectorf_mulscalar((float*)_x, 2*_n, 1.0f / liquid_vectorcf_norm(_x, _n), (float*)_y);
+}
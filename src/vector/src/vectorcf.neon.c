@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorcf.neon.c : complex floating-point element-wise vector
+//                   operations (ARM Neon)
+//
+// The phase rotation (and, on AArch64, the angle) kernels evaluate
+// minimax polynomials after range reduction and agree with cexpf() and
+// cargf() to within a few units in the last place; blocks containing
+// non-finite or very large arguments are handed to the C library. The
+// angle and magnitude kernels need vector division and square root, so
+// 32-bit ARM uses the portable versions.
+//
+
+#include <float.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+//
+// portable kernels (dispatch fallback and SIMD tails)
+//
+
+#define VECTOR(name)    liquid_vectorcf ## name ## _portable
+#define T               float complex
+#define TP              float
+#define T_COMPLEX       1
+
+#include "vector_add.c"
+#include "vector_mul.c"
+#include "vector_norm.c"
+#include "vector_trig.c"
+
+#undef VECTOR
+#undef T
+#undef TP
+#undef T_COMPLEX
+
+// range reduction limit for phase rotation
+#define LIQUID_VECTOR_SINCOS_MAX    (8192.0f)
+
+// are all lanes of mask set?
+static inline int liquid_vectorcf_all4(uint32x4_t _m)
+{
+    uint32x2_t m = vand_u32(vget_low_u32(_m), vget_high_u32(_m));
+    return (vget_lane_u32(m, 0) & vget_lane_u32(m, 1)) != 0;
+}
+
+// sine and cosine of four values with |_x| <= LIQUID_VECTOR_SINCOS_MAX:
+// reduce by the nearest multiple of pi/2 (three-part Cody-Waite) and
+// select/negate the polynomials on [-pi/4,pi/4] by quadrant
+static inline void liquid_vectorcf_sincos4(float32x4_t   _x,
+                                           float32x4_t * _s,
+                                           float32x4_t * _c)
+{
+    // round to nearest: truncate after adding 0.5 with the sign of _x
+    uint32x4_t  sign = vdupq_n_u32(0x80000000);
+    uint32x4_t  one  = vdupq_n_u32(1);
+    uint32x4_t  two  = vdupq_n_u32(2);
+    float32x4_t y    = vmulq_n_f32(_x, (float)M_2_PI);
+    uint32x4_t  h    = vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(0.5f)),
+                                 vandq_u32(vreinterpretq_u32_f32(y), sign));
+    int32x4_t   q    = vcvtq_s32_f32(vaddq_f32(y, vreinterpretq_f32_u32(h)));
+    float32x4_t qf   = vcvtq_f32_s32(q);
+    float32x4_t r    = vmlsq_n_f32(_x, qf, 1.5703125f);
+    r = vmlsq_n_f32(r, qf, 4.837512969970703125e-4f);
+    r = vmlsq_n_f32(r, qf, 7.54978995489188216e-8f);
+    float32x4_t z    = vmulq_f32(r, r);
+
+    // sin(r) and cos(r)
+    float32x4_t ps = vmlaq_n_f32(vdupq_n_f32( 8.3321608736e-3f), z, -1.9515295891e-4f);
+    ps = vmlaq_f32(vdupq_n_f32(-1.6666654611e-1f), ps, z);
+    ps = vmlaq_f32(r, ps, vmulq_f32(z, r));
+    float32x4_t pc = vmlaq_n_f32(vdupq_n_f32(-1.388731625493765e-3f), z, 2.443315711809948e-5f);
+    pc = vmlaq_f32(vdupq_n_f32( 4.166664568298827e-2f), pc, z);
+    pc = vmlaq_f32(vmlsq_n_f32(vdupq_n_f32(1.0f), z, 0.5f), pc, vmulq_f32(z, z));
+
+    // odd quadrants swap sine and cosine; negate sine in quadrants
+    // 2,3 and cosine in quadrants 1,2
+    uint32x4_t  qu   = vreinterpretq_u32_s32(q);
+    uint32x4_t  swap = vtstq_u32(qu, one);
+    float32x4_t s    = vbslq_f32(swap, pc, ps);
+    float32x4_t c    = vbslq_f32(swap, ps, pc);
+    uint32x4_t  sn   = vshlq_n_u32(vandq_u32(qu, two), 30);
+    uint32x4_t  cn   = vshlq_n_u32(vandq_u32(vaddq_u32(qu, one), two), 30);
+    *_s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(s), sn));
+    *_c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(c), cn));
+}
+
+#if defined(__aarch64__)
+// four-quadrant arc tangent of four finite values: reflect into
+// [0,pi/4], fold [tan(pi/8),1] about pi/4, evaluate polynomial
+static inline float32x4_t liquid_vectorcf_atan2_4(float32x4_t _y,
+                                                  float32x4_t _x)
+{
+    float32x4_t one  = vdupq_n_f32(1.0f);
+    float32x4_t a    = vabsq_f32(_y);
+    float32x4_t b    = vabsq_f32(_x);
+    float32x4_t t    = vdivq_f32(vminq_f32(a,b), vmaxq_f32(vmaxq_f32(a,b), vdupq_n_f32(FLT_MIN)));
+    uint32x4_t  fold = vcgtq_f32(t, vdupq_n_f32(0.414213562373095f));
+    t = vbslq_f32(fold, vdivq_f32(vsubq_f32(t, one), vaddq_f32(t, one)), t);
+    float32x4_t z    = vmulq_f32(t, t);
+
+    float32x4_t p = vmlaq_n_f32(vdupq_n_f32(-1.38776856032e-1f), z, 8.05374449538e-2f);
+    p = vmlaq_f32(vdupq_n_f32( 1.99777106478e-1f), p, z);
+    p = vmlaq_f32(vdupq_n_f32(-3.33329491539e-1f), p, z);
+    p = vmlaq_f32(t, p, vmulq_f32(z, t));
+    p = vaddq_f32(p, vbslq_f32(fold, vdupq_n_f32((float)M_PI_4), vdupq_n_f32(0.0f)));
+
+    // reflect into proper octant, quadrant and half plane
+    uint32x4_t xneg = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_f32(_x), 31));
+    p = vbslq_f32(vcgtq_f32(a, b), vsubq_f32(vdupq_n_f32((float)M_PI_2), p), p);
+    p = vbslq_f32(xneg,            vsubq_f32(vdupq_n_f32((float)M_PI),   p), p);
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(p),
+                                           vandq_u32(vreinterpretq_u32_f32(_y), vdupq_n_u32(0x80000000))));
+}
+#endif
+
+//
+// Neon kernels with run-time dispatch
+//
+
+// initialize vector with scalar: x[i] = c
+void liquid_vectorcf_init(float complex   _c,
+                          float complex * _x,
+                          unsigned int    _n)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4x2_t c;
+        c.val[0] = vdupq_n_f32(crealf(_c));
+        c.val[1] = vdupq_n_f32(cimagf(_c));
+        for (; i+4<=_n; i+=4)
+            vst2q_f32((float*)(_x + i), c);
+    }
+    liquid_vectorcf_init_portable(_c, _x + i, _n - i);
+}
+
+// add each element: z[i] = x[i] + y[i]; same as the real operation
+// on the interleaved components
+void liquid_vectorcf_add(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    liquid_vectorf_add((float*)_x, (float*)_y, 2*_n, (float*)_z);
+}
+
+// add scalar to each element: y[i] = x[i] + c
+void liquid_vectorcf_addscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _c,
+                               float complex * _y)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t cr = vdupq_n_f32(crealf(_c));
+        float32x4_t ci = vdupq_n_f32(cimagf(_c));
+        for (; i+4<=_n; i+=4) {
+            float32x4x2_t v = vld2q_f32((float*)(_x + i));
+            v.val[0] = vaddq_f32(v.val[0], cr);
+            v.val[1] = vaddq_f32(v.val[1], ci);
+            vst2q_f32((float*)(_y + i), v);
+        }
+    }
+    liquid_vectorcf_addscalar_portable(_x + i, _n - i, _c, _y + i);
+}
+
+// multiply each element: z[i] = x[i] * y[i]
+void liquid_vectorcf_mul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4) {
+            float32x4x2_t a = vld2q_f32((float*)(_x + i));
+            float32x4x2_t b = vld2q_f32((float*)(_y + i));
+            float32x4x2_t v;
+            v.val[0] = vmlsq_f32(vmulq_f32(a.val[0], b.val[0]), a.val[1], b.val[1]);
+            v.val[1] = vmlaq_f32(vmulq_f32(a.val[0], b.val[1]), a.val[1], b.val[0]);
+            vst2q_f32((float*)(_z + i), v);
+        }
+    }
+    liquid_vectorcf_mul_portable(_x + i, _y + i, _n - i, _z + i);
+}
+
+// multiply each element with scalar: y[i] = x[i] * c
+void liquid_vectorcf_mulscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _c,
+                               float complex * _y)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float cr = crealf(_c);
+        float ci = cimagf(_c);
+        for (; i+4<=_n; i+=4) {
+            float32x4x2_t a = vld2q_f32((float*)(_x + i));
+            float32x4x2_t v;
+            v.val[0] = vmlsq_n_f32(vmulq_n_f32(a.val[0], cr), a.val[1], ci);
+            v.val[1] = vmlaq_n_f32(vmulq_n_f32(a.val[0], ci), a.val[1], cr);
+            vst2q_f32((float*)(_y + i), v);
+        }
+    }
+    liquid_vectorcf_mulscalar_portable(_x + i, _n - i, _c, _y + i);
+}
+
+// compute complex phase rotation: x[i] = exp{j theta[i]}
+void liquid_vectorcf_cexpj(float *         _theta,
+                           unsigned int    _n,
+                           float complex * _x)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4) {
+            float32x4_t theta = vld1q_f32(_theta + i);
+            if (!liquid_vectorcf_all4(vcaleq_f32(theta, vdupq_n_f32(LIQUID_VECTOR_SINCOS_MAX)))) {
+                liquid_vectorcf_cexpj_portable(_theta + i, 4, _x + i);
+                continue;
+            }
+
+            // interleave cosine (real) and sine (imaginary) parts
+            float32x4x2_t v;
+            liquid_vectorcf_sincos4(theta, &v.val[1], &v.val[0]);
+            vst2q_f32((float*)(_x + i), v);
+        }
+    }
+    liquid_vectorcf_cexpj_portable(_theta + i, _n - i, _x + i);
+}
+
+// compute angle of each element: theta[i] = arg{ x[i] }
+void liquid_vectorcf_carg(float complex * _x,
+                          unsigned int    _n,
+                          float *         _theta)
+{
+    unsigned int i = 0;
+#if defined(__aarch64__)
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4) {
+            float32x4x2_t v  = vld2q_f32((float*)(_x + i));
+            float32x4_t   r0 = vmulq_n_f32(v.val[0], 0.0f);
+            float32x4_t   i0 = vmulq_n_f32(v.val[1], 0.0f);
+            if (!liquid_vectorcf_all4(vandq_u32(vceqq_f32(r0, r0), vceqq_f32(i0, i0)))) {
+                liquid_vectorcf_carg_portable(_x + i, 4, _theta + i);
+                continue;
+            }
+            vst1q_f32(_theta + i, liquid_vectorcf_atan2_4(v.val[1], v.val[0]));
+        }
+    }
+#endif
+    liquid_vectorcf_carg_portable(_x + i, _n - i, _theta + i);
+}
+
+// compute absolute value of each element: y[i] = |x[i]|
+void liquid_vectorcf_abs(float complex * _x,
+                         unsigned int    _n,
+                         float *         _y)
+{
+    unsigned int i = 0;
+#if defined(__aarch64__)
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4) {
+            float32x4x2_t v = vld2q_f32((float*)(_x + i));
+            float32x4_t   m = vmlaq_f32(vmulq_f32(v.val[0], v.val[0]), v.val[1], v.val[1]);
+            vst1q_f32(_y + i, vsqrtq_f32(m));
+        }
+    }
+#endif
+    liquid_vectorcf_abs_portable(_x + i, _n - i, _y + i);
+}
+
+// sum of squares; the SIMD level shares the Neon sumsq kernel
+float liquid_vectorcf_sumsq(float complex * _x,
+                            unsigned int    _n)
+{
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE)
+        return liquid_sumsqcf(_x, _n);
+    return liquid_vectorcf_sumsq_portable(_x, _n);
+}
+
+// l-2 norm: sqrt{ sum{ |x|^2 } }
+float liquid_vectorcf_norm(float complex * _x,
+                           unsigned int    _n)
+{
+    return sqrtf(liquid_vectorcf_sumsq(_x, _n));
+}
+
+// l-p norm: { sum{ |x|^p } }^(1/p); powf() dominates, portable only
+float liquid_vectorcf_pnorm(float complex * _x,
+                            unsigned int    _n,
+                            float           _p)
+{
+    return liquid_vectorcf_pnorm_portable(_x, _n, _p);
+}
+
+// scale vector elements by l-2 norm: y[i] = x[i]/norm(x); the scale
+// is real so the interleaved components are scaled as real values
+void liquid_vectorcf_normalize(float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    liquid_vectorf_mulscalar((float*)_x, 2*_n, 1.0f / liquid_vectorcf_norm(_x, _n), (float*)_y);
+}
@@ -30,5 +30,7 @@
 #define T               float complex
 #define TP              float
 
+#define T_COMPLEX       1
+
 #include "vector_norm.c"
 
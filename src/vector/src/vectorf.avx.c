@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorf.avx.c : real floating-point element-wise vector kernels
+//                 (x86 AVX2/FMA)
+//
+// These kernels are compiled with per-function target attributes and
+// are selected at run time by the dispatch in vectorf.mmx.c.
+//
+
+#include <immintrin.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// initialize vector with scalar (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_init_avx2(float        _c,
+                              float *      _x,
+                              unsigned int _n)
+{
+    __m256 c = _mm256_set1_ps(_c);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8)
+        _mm256_storeu_ps(_x + i, c);
+    for ( ; i<_n; i++)
+        _x[i] = _c;
+}
+
+// add each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_add_avx2(float *      _x,
+                             float *      _y,
+                             unsigned int _n,
+                             float *      _z)
+{
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8)
+        _mm256_storeu_ps(_z + i, _mm256_add_ps(_mm256_loadu_ps(_x + i), _mm256_loadu_ps(_y + i)));
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] + _y[i];
+}
+
+// add scalar to each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_addscalar_avx2(float *      _x,
+                                   unsigned int _n,
+                                   float        _c,
+                                   float *      _y)
+{
+    __m256 c = _mm256_set1_ps(_c);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8)
+        _mm256_storeu_ps(_y + i, _mm256_add_ps(_mm256_loadu_ps(_x + i), c));
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _c;
+}
+
+// multiply each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_mul_avx2(float *      _x,
+                             float *      _y,
+                             unsigned int _n,
+                             float *      _z)
+{
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8)
+        _mm256_storeu_ps(_z + i, _mm256_mul_ps(_mm256_loadu_ps(_x + i), _mm256_loadu_ps(_y + i)));
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// multiply each element with scalar (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_mulscalar_avx2(float *      _x,
+                                   unsigned int _n,
+                                   float        _c,
+                                   float *      _y)
+{
+    __m256 c = _mm256_set1_ps(_c);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8)
+        _mm256_storeu_ps(_y + i, _mm256_mul_ps(_mm256_loadu_ps(_x + i), c));
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _c;
+}
+
+// real 'phase rotation': x[i] = theta[i] > 0 ? 1 : -1 (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_cexpj_avx2(float *      _theta,
+                               unsigned int _n,
+                               float *      _x)
+{
+    __m256 zero = _mm256_setzero_ps();
+    __m256 pos  = _mm256_set1_ps( 1.0f);
+    __m256 neg  = _mm256_set1_ps(-1.0f);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 gt = _mm256_cmp_ps(_mm256_loadu_ps(_theta + i), zero, _CMP_GT_OQ);
+        _mm256_storeu_ps(_x + i, _mm256_blendv_ps(neg, pos, gt));
+    }
+    for ( ; i<_n; i++)
+        _x[i] = _theta[i] > 0 ? 1.0f : -1.0f;
+}
+
+// real 'angle': theta[i] = x[i] > 0 ? 0 : pi (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_carg_avx2(float *      _x,
+                              unsigned int _n,
+                              float *      _theta)
+{
+    __m256 zero = _mm256_setzero_ps();
+    __m256 pi   = _mm256_set1_ps((float)M_PI);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        __m256 gt = _mm256_cmp_ps(_mm256_loadu_ps(_x + i), zero, _CMP_GT_OQ);
+        _mm256_storeu_ps(_theta + i, _mm256_andnot_ps(gt, pi));
+    }
+    for ( ; i<_n; i++)
+        _theta[i] = _x[i] > 0 ? 0.0f : (float)M_PI;
+}
+
+// absolute value of each element (see liquid.internal.h)
+__attribute__((target("avx2,fma")))
+void liquid_vectorf_abs_avx2(float *      _x,
+                             unsigned int _n,
+                             float *      _y)
+{
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8)
+        _mm256_storeu_ps(_y + i, _mm256_andnot_ps(sign, _mm256_loadu_ps(_x + i)));
+    for ( ; i<_n; i++)
+        _y[i] = fabsf(_x[i]);
+}
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorf.mmx.c : real floating-point element-wise vector operations
+//                 (SSE3 with AVX2 dispatch)
+//
+
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
+//
+// portable kernels (dispatch fallback and SIMD tails)
+//
+
+#define VECTOR(name)    liquid_vectorf ## name ## _portable
+#define T               float
+#define TP              float
+
+#include "vector_add.c"
+#include "vector_mul.c"
+#include "vector_norm.c"
+#include "vector_trig.c"
+
+#undef VECTOR
+#undef T
+#undef TP
+
+#if HAVE_PMMINTRIN_H
+//
+// SSE kernels
+//
+
+static void liquid_vectorf_init_sse(float        _c,
+                                    float *      _x,
+                                    unsigned int _n)
+{
+    __m128 c = _mm_set1_ps(_c);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_x + i, c);
+    liquid_vectorf_init_portable(_c, _x + t, _n - t);
+}
+
+static void liquid_vectorf_add_sse(float *      _x,
+                                   float *      _y,
+                                   unsigned int _n,
+                                   float *      _z)
+{
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_z + i, _mm_add_ps(_mm_loadu_ps(_x + i), _mm_loadu_ps(_y + i)));
+    liquid_vectorf_add_portable(_x + t, _y + t, _n - t, _z + t);
+}
+
+static void liquid_vectorf_addscalar_sse(float *      _x,
+                                         unsigned int _n,
+                                         float        _c,
+                                         float *      _y)
+{
+    __m128 c = _mm_set1_ps(_c);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_y + i, _mm_add_ps(_mm_loadu_ps(_x + i), c));
+    liquid_vectorf_addscalar_portable(_x + t, _n - t, _c, _y + t);
+}
+
+static void liquid_vectorf_mul_sse(float *      _x,
+                                   float *      _y,
+                                   unsigned int _n,
+                                   float *      _z)
+{
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_z + i, _mm_mul_ps(_mm_loadu_ps(_x + i), _mm_loadu_ps(_y + i)));
+    liquid_vectorf_mul_portable(_x + t, _y + t, _n - t, _z + t);
+}
+
+static void liquid_vectorf_mulscalar_sse(float *      _x,
+                                         unsigned int _n,
+                                         float        _c,
+                                         float *      _y)
+{
+    __m128 c = _mm_set1_ps(_c);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_y + i, _mm_mul_ps(_mm_loadu_ps(_x + i), c));
+    liquid_vectorf_mulscalar_portable(_x + t, _n - t, _c, _y + t);
+}
+
+// x[i] = theta[i] > 0 ? 1 : -1
+static void liquid_vectorf_cexpj_sse(float *      _theta,
+                                     unsigned int _n,
+                                     float *      _x)
+{
+    __m128 zero = _mm_setzero_ps();
+    __m128 pos  = _mm_set1_ps( 1.0f);
+    __m128 neg  = _mm_set1_ps(-1.0f);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 gt = _mm_cmpgt_ps(_mm_loadu_ps(_theta + i), zero);
+        _mm_storeu_ps(_x + i, _mm_or_ps(_mm_and_ps(gt, pos), _mm_andnot_ps(gt, neg)));
+    }
+    liquid_vectorf_cexpj_portable(_theta + t, _n - t, _x + t);
+}
+
+// theta[i] = x[i] > 0 ? 0 : pi
+static void liquid_vectorf_carg_sse(float *      _x,
+                                    unsigned int _n,
+                                    float *      _theta)
+{
+    __m128 zero = _mm_setzero_ps();
+    __m128 pi   = _mm_set1_ps((float)M_PI);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_theta + i, _mm_andnot_ps(_mm_cmpgt_ps(_mm_loadu_ps(_x + i), zero), pi));
+    liquid_vectorf_carg_portable(_x + t, _n - t, _theta + t);
+}
+
+static void liquid_vectorf_abs_sse(float *      _x,
+                                   unsigned int _n,
+                                   float *      _y)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    unsigned int t = _n & ~3u;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(_y + i, _mm_andnot_ps(sign, _mm_loadu_ps(_x + i)));
+    liquid_vectorf_abs_portable(_x + t, _n - t, _y + t);
+}
+#endif
+
+//
+// run-time dispatch
+//
+
+// initialize vector with scalar: x[i] = c
+void liquid_vectorf_init(float        _c,
+                         float *      _x,
+                         unsigned int _n)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_init_avx2(_c, _x, _n);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_init_sse(_c, _x, _n);
+        return;
+    }
+#endif
+    liquid_vectorf_init_portable(_c, _x, _n);
+}
+
+// add each element: z[i] = x[i] + y[i]
+void liquid_vectorf_add(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_add_avx2(_x, _y, _n, _z);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_add_sse(_x, _y, _n, _z);
+        return;
+    }
+#endif
+    liquid_vectorf_add_portable(_x, _y, _n, _z);
+}
+
+// add scalar to each element: y[i] = x[i] + c
+void liquid_vectorf_addscalar(float *      _x,
+                              unsigned int _n,
+                              float        _c,
+                              float *      _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_addscalar_avx2(_x, _n, _c, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_addscalar_sse(_x, _n, _c, _y);
+        return;
+    }
+#endif
+    liquid_vectorf_addscalar_portable(_x, _n, _c, _y);
+}
+
+// multiply each element: z[i] = x[i] * y[i]
+void liquid_vectorf_mul(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_mul_avx2(_x, _y, _n, _z);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_mul_sse(_x, _y, _n, _z);
+        return;
+    }
+#endif
+    liquid_vectorf_mul_portable(_x, _y, _n, _z);
+}
+
+// multiply each element with scalar: y[i] = x[i] * c
+void liquid_vectorf_mulscalar(float *      _x,
+                              unsigned int _n,
+                              float        _c,
+                              float *      _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_mulscalar_avx2(_x, _n, _c, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_mulscalar_sse(_x, _n, _c, _y);
+        return;
+    }
+#endif
+    liquid_vectorf_mulscalar_portable(_x, _n, _c, _y);
+}
+
+// real 'phase rotation': x[i] = theta[i] > 0 ? 1 : -1
+void liquid_vectorf_cexpj(float *      _theta,
+                          unsigned int _n,
+                          float *      _x)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_cexpj_avx2(_theta, _n, _x);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_cexpj_sse(_theta, _n, _x);
+        return;
+    }
+#endif
+    liquid_vectorf_cexpj_portable(_theta, _n, _x);
+}
+
+// real 'angle': theta[i] = x[i] > 0 ? 0 : pi
+void liquid_vectorf_carg(float *      _x,
+                         unsigned int _n,
+                         float *      _theta)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_carg_avx2(_x, _n, _theta);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_carg_sse(_x, _n, _theta);
+        return;
+    }
+#endif
+    liquid_vectorf_carg_portable(_x, _n, _theta);
+}
+
+// absolute value of each element: y[i] = |x[i]|
+void liquid_vectorf_abs(float *      _x,
+                        unsigned int _n,
+                        float *      _y)
+{
+    liquid_simd_level level = liquid_simd_get_level();
+#if HAVE_DOTPROD_AVX
+    if (level == LIQUID_SIMD_AVX2 || level == LIQUID_SIMD_AVX512F) {
+        liquid_vectorf_abs_avx2(_x, _n, _y);
+        return;
+    }
+#endif
+#if HAVE_PMMINTRIN_H
+    if (level != LIQUID_SIMD_PORTABLE) {
+        liquid_vectorf_abs_sse(_x, _n, _y);
+        return;
+    }
+#endif
+    liquid_vectorf_abs_portable(_x, _n, _y);
+}
+
+// sum of squares; the SIMD levels share the dispatched sumsq kernels
+float liquid_vectorf_sumsq(float *      _x,
+                           unsigned int _n)
+{
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE)
+        return liquid_sumsqf(_x, _n);
+    return liquid_vectorf_sumsq_portable(_x, _n);
+}
+
+// l-2 norm: sqrt{ sum{ |x|^2 } }
+float liquid_vectorf_norm(float *      _x,
+                          unsigned int _n)
+{
+    return sqrtf(liquid_vectorf_sumsq(_x, _n));
+}
+
+// l-p norm: { sum{ |x|^p } }^(1/p); powf() dominates, portable only
+float liquid_vectorf_pnorm(float *      _x,
+                           unsigned int _n,
+                           float        _p)
+{
+    return liquid_vectorf_pnorm_portable(_x, _n, _p);
+}
+
+// scale vector elements by l-2 norm: y[i] = x[i]/norm(x)
+void liquid_vectorf_normalize(float *      _x,
+                              unsigned int _n,
+                              float *      _y)
+{
+    liquid_vectorf_mulscalar(_x, _n, 1.0f / liquid_vectorf_norm(_x, _n), _y);
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorf.neon.c : real floating-point element-wise vector operations
+//                  (ARM Neon)
+//
+
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+//
+// portable kernels (dispatch fallback and SIMD tails)
+//
+
+#define VECTOR(name)    liquid_vectorf ## name ## _portable
+#define T               float
+#define TP              float
+
+#include "vector_add.c"
+#include "vector_mul.c"
+#include "vector_norm.c"
+#include "vector_trig.c"
+
+#undef VECTOR
+#undef T
+#undef TP
+
+//
+// Neon kernels with run-time dispatch
+//
+
+// initialize vector with scalar: x[i] = c
+void liquid_vectorf_init(float        _c,
+                         float *      _x,
+                         unsigned int _n)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t c = vdupq_n_f32(_c);
+        for (; i+4<=_n; i+=4)
+            vst1q_f32(_x + i, c);
+    }
+    liquid_vectorf_init_portable(_c, _x + i, _n - i);
+}
+
+// add each element: z[i] = x[i] + y[i]
+void liquid_vectorf_add(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4)
+            vst1q_f32(_z + i, vaddq_f32(vld1q_f32(_x + i), vld1q_f32(_y + i)));
+    }
+    liquid_vectorf_add_portable(_x + i, _y + i, _n - i, _z + i);
+}
+
+// add scalar to each element: y[i] = x[i] + c
+void liquid_vectorf_addscalar(float *      _x,
+                              unsigned int _n,
+                              float        _c,
+                              float *      _y)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t c = vdupq_n_f32(_c);
+        for (; i+4<=_n; i+=4)
+            vst1q_f32(_y + i, vaddq_f32(vld1q_f32(_x + i), c));
+    }
+    liquid_vectorf_addscalar_portable(_x + i, _n - i, _c, _y + i);
+}
+
+// multiply each element: z[i] = x[i] * y[i]
+void liquid_vectorf_mul(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4)
+            vst1q_f32(_z + i, vmulq_f32(vld1q_f32(_x + i), vld1q_f32(_y + i)));
+    }
+    liquid_vectorf_mul_portable(_x + i, _y + i, _n - i, _z + i);
+}
+
+// multiply each element with scalar: y[i] = x[i] * c
+void liquid_vectorf_mulscalar(float *      _x,
+                              unsigned int _n,
+                              float        _c,
+                              float *      _y)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4)
+            vst1q_f32(_y + i, vmulq_n_f32(vld1q_f32(_x + i), _c));
+    }
+    liquid_vectorf_mulscalar_portable(_x + i, _n - i, _c, _y + i);
+}
+
+// real 'phase rotation': x[i] = theta[i] > 0 ? 1 : -1
+void liquid_vectorf_cexpj(float *      _theta,
+                          unsigned int _n,
+                          float *      _x)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t zero = vdupq_n_f32( 0.0f);
+        float32x4_t pos  = vdupq_n_f32( 1.0f);
+        float32x4_t neg  = vdupq_n_f32(-1.0f);
+        for (; i+4<=_n; i+=4)
+            vst1q_f32(_x + i, vbslq_f32(vcgtq_f32(vld1q_f32(_theta + i), zero), pos, neg));
+    }
+    liquid_vectorf_cexpj_portable(_theta + i, _n - i, _x + i);
+}
+
+// real 'angle': theta[i] = x[i] > 0 ? 0 : pi
+void liquid_vectorf_carg(float *      _x,
+                         unsigned int _n,
+                         float *      _theta)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        float32x4_t zero = vdupq_n_f32(0.0f);
+        uint32x4_t  pi   = vreinterpretq_u32_f32(vdupq_n_f32((float)M_PI));
+        for (; i+4<=_n; i+=4) {
+            uint32x4_t gt = vcgtq_f32(vld1q_f32(_x + i), zero);
+            vst1q_f32(_theta + i, vreinterpretq_f32_u32(vbicq_u32(pi, gt)));
+        }
+    }
+    liquid_vectorf_carg_portable(_x + i, _n - i, _theta + i);
+}
+
+// absolute value of each element: y[i] = |x[i]|
+void liquid_vectorf_abs(float *      _x,
+                        unsigned int _n,
+                        float *      _y)
+{
+    unsigned int i = 0;
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE) {
+        for (; i+4<=_n; i+=4)
+            vst1q_f32(_y + i, vabsq_f32(vld1q_f32(_x + i)));
+    }
+    liquid_vectorf_abs_portable(_x + i, _n - i, _y + i);
+}
+
+// sum of squares; the SIMD level shares the Neon sumsq kernel
+float liquid_vectorf_sumsq(float *      _x,
+                           unsigned int _n)
+{
+    if (liquid_simd_get_level() != LIQUID_SIMD_PORTABLE)
+        return liquid_sumsqf(_x, _n);
+    return liquid_vectorf_sumsq_portable(_x, _n);
+}
+
+// l-2 norm: sqrt{ sum{ |x|^2 } }
+float liquid_vectorf_norm(float *      _x,
+                          unsigned int _n)
+{
+    return sqrtf(liquid_vectorf_sumsq(_x, _n));
+}
+
+// l-p norm: { sum{ |x|^p } }^(1/p); powf() dominates, portable only
+float liquid_vectorf_pnorm(float *      _x,
+                           unsigned int _n,
+                           float        _p)
+{
+    return liquid_vectorf_pnorm_portable(_x, _n, _p);
+}
+
+// scale vector elements by l-2 norm: y[i] = x[i]/norm(x)
+void liquid_vectorf_normalize(float *      _x,
+                              unsigned int _n,
+                              float *      _y)
+{
+    liquid_vectorf_mulscalar(_x, _n, 1.0f / liquid_vectorf_norm(_x, _n), _y);
+}
@@ -30,5 +30,7 @@
 #define T               float
 #define TP              float
 
+#define T_COMPLEX       0
+
 #include "vector_norm.c"
 
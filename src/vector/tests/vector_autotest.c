@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// lengths covering empty input, SIMD tails and full blocks
+static const unsigned int vector_autotest_len[] = {0, 1, 3, 4, 5, 8, 13, 16, 31, 64};
+#define VECTOR_AUTOTEST_NUM_LEN (sizeof(vector_autotest_len)/sizeof(unsigned int))
+
+// check whether SIMD level can be selected on this host/build
+static int vector_autotest_supported(liquid_simd_level _level)
+{
+    liquid_simd_level host = liquid_simd_get_host_level();
+    int x86 = host == LIQUID_SIMD_SSE || host == LIQUID_SIMD_AVX2 || host == LIQUID_SIMD_AVX512F;
+    return _level == LIQUID_SIMD_PORTABLE || _level == host || (x86 && _level < host);
+}
+
+// run real vector operations against direct computation
+static void vectorf_autotest_run(unsigned int _n)
+{
+    float tol = 1e-6f;
+    float x[_n], y[_n], z[_n], theta[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        x[i] = randnf();
+        y[i] = randnf();
+    }
+    if (_n > 2) {
+        x[0] = 0.0f;    // sign decisions at zero
+        x[1] = -0.0f;
+    }
+
+    liquid_vectorf_init(0.25f, z, _n);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], 0.25f);
+
+    liquid_vectorf_add(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] + y[i]);
+
+    liquid_vectorf_addscalar(x, _n, -0.7f, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] - 0.7f);
+
+    liquid_vectorf_mul(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] * y[i]);
+
+    liquid_vectorf_mulscalar(x, _n, 1.3f, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] * 1.3f);
+
+    liquid_vectorf_cexpj(x, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] > 0 ? 1.0f : -1.0f);
+
+    liquid_vectorf_carg(x, _n, theta);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(theta[i], x[i] > 0 ? 0.0f : (float)M_PI);
+
+    liquid_vectorf_abs(x, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], fabsf(x[i]));
+
+    // norms
+    float sumsq = 0.0f;
+    for (i=0; i<_n; i++) sumsq += x[i]*x[i];
+    CONTEND_DELTA(liquid_vectorf_sumsq(x, _n), sumsq,        tol*(1+sumsq));
+    CONTEND_DELTA(liquid_vectorf_norm (x, _n), sqrtf(sumsq), tol*(1+sumsq));
+    CONTEND_DELTA(liquid_vectorf_pnorm(x, _n, 2.0f), sqrtf(sumsq), 4*tol*(1+sumsq));
+    if (_n > 2) {
+        liquid_vectorf_normalize(x, _n, z);
+        CONTEND_DELTA(liquid_vectorf_norm(z, _n), 1.0f, 4*tol*_n);
+    }
+
+    // in-place operation
+    memmove(z, x, _n*sizeof(float));
+    liquid_vectorf_mul(z, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] * y[i]);
+}
+
+// run complex vector operations against direct computation
+static void vectorcf_autotest_run(unsigned int _n)
+{
+    float tol = 1e-6f;
+    float complex c = 0.3f - 1.1f*_Complex_I;
+    float complex x[_n], y[_n], z[_n];
+    float         theta[_n], v[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        y[i] = randnf() + _Complex_I*randnf();
+        theta[i] = 20.0f*randnf();
+    }
+    if (_n > 8) {
+        // axes, signed zeros and arguments beyond the reduction range
+        x[0] = 0.0f;
+        x[1] = -1.0f;
+        x[2] = -1.0f - 0.0f*_Complex_I;
+        x[3] = conjf(-1.0f);
+        x[4] = _Complex_I;
+        x[5] = -2.0f*_Complex_I;
+        x[6] = -0.0f;
+        theta[0] = 0.0f;
+        theta[1] = (float)M_PI;
+        theta[2] = -(float)M_PI_2;
+        theta[3] = 1e5f;
+    }
+
+    liquid_vectorcf_init(c, z, _n);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], c);
+
+    liquid_vectorcf_add(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] + y[i]);
+
+    liquid_vectorcf_addscalar(x, _n, c, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] + c);
+
+    // products may be contracted (fused multiply-add)
+    liquid_vectorcf_mul(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*y[i]), 0.0f, tol*(1+cabsf(z[i])));
+
+    liquid_vectorcf_mulscalar(x, _n, c, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*c), 0.0f, tol*(1+cabsf(z[i])));
+
+    liquid_vectorcf_cexpj(theta, _n, z);
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA(crealf(z[i]), cosf(theta[i]), 2*tol);
+        CONTEND_DELTA(cimagf(z[i]), sinf(theta[i]), 2*tol);
+    }
+
+    liquid_vectorcf_carg(x, _n, v);
+    for (i=0; i<_n; i++) CONTEND_DELTA(v[i], cargf(x[i]), 2*tol);
+
+    liquid_vectorcf_abs(x, _n, v);
+    for (i=0; i<_n; i++) CONTEND_DELTA(v[i], cabsf(x[i]), tol*(1+v[i]));
+
+    // norms
+    float sumsq = 0.0f;
+    for (i=0; i<_n; i++) sumsq += crealf(x[i]*conjf(x[i]));
+    CONTEND_DELTA(liquid_vectorcf_sumsq(x, _n), sumsq,        tol*(1+sumsq));
+    CONTEND_DELTA(liquid_vectorcf_norm (x, _n), sqrtf(sumsq), tol*(1+sumsq));
+    CONTEND_DELTA(liquid_vectorcf_pnorm(x, _n, 2.0f), sqrtf(sumsq), 4*tol*(1+sumsq));
+    if (_n > 2) {
+        liquid_vectorcf_normalize(x, _n, z);
+        CONTEND_DELTA(liquid_vectorcf_norm(z, _n), 1.0f, 4*tol*_n);
+    }
+
+    // in-place operation (as in fftfilt)
+    memmove(z, x, _n*sizeof(float complex));
+    liquid_vectorcf_mul(z, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*y[i]), 0.0f, tol*(1+cabsf(z[i])));
+}
+
+// run all lengths at every SIMD level available on this host
+static void vector_autotest_levels(void (*_run)(unsigned int))
+{
+    liquid_simd_level level = liquid_simd_get_level();
+    unsigned int i, k;
+    for (i=0; i<LIQUID_SIMD_NUM_LEVELS; i++) {
+        if (!vector_autotest_supported((liquid_simd_level)i))
+            continue;
+        if (liquid_autotest_verbose)
+            printf("  level: %s\n", liquid_simd_level_str((liquid_simd_level)i));
+        CONTEND_EQUALITY(liquid_simd_set_level((liquid_simd_level)i), (liquid_simd_level)i);
+        for (k=0; k<VECTOR_AUTOTEST_NUM_LEN; k++)
+            _run(vector_autotest_len[k]);
+    }
+    liquid_simd_set_level(level);
+}
+
+void autotest_vectorf_ops()  { vector_autotest_levels(vectorf_autotest_run);  }
+void autotest_vectorcf_ops() { vector_autotest_levels(vectorcf_autotest_run); }
+
+// run 16-bit integer conversions against direct computation
+static void vector_from_i16_autotest_run(unsigned int _n)
+{
+    float g = 1.0f / 32768.0f;
+    int16_t x[2*_n+1];
+    float y[2*_n+1];
+    unsigned int i;
+    for (i=0; i<2*_n; i++)
+        x[i] = (int16_t)((rand() & 0xffff) - 32768);
+    if (_n > 2) {
+        x[0] = -32768;  // extremes of range
+        x[1] =  32767;
+    }
+
+    // guard value past end of output
+    y[_n] = -1.0f;
+    liquid_vectorf_from_s16(x, _n, g, y);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(y[i], (float)x[i] * g);
+    CONTEND_EQUALITY(y[_n], -1.0f);
+
+    float complex z[_n];
+    liquid_vectorcf_from_ci16(x, _n, 2.0f, z);
+    for (i=0; i<_n; i++) {
+        CONTEND_EQUALITY(crealf(z[i]), 2.0f*(float)x[2*i  ]);
+        CONTEND_EQUALITY(cimagf(z[i]), 2.0f*(float)x[2*i+1]);
+    }
+}
+
+void autotest_vector_from_i16() { vector_autotest_levels(vector_from_i16_autotest_run); }
+
+// split-complex conversions and element-wise multiply
+void autotest_vectorcf_split()
+{
+    unsigned int n = 37;
+    float complex x[n], y[n], z[n];
+    float xr[n], xi[n], yr[n], yi[n], zr[n], zi[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        y[i] = randnf() + _Complex_I*randnf();
+    }
+    liquid_vectorcf_split(x, n, xr, xi);
+    liquid_vectorcf_split(y, n, yr, yi);
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(xr[i], crealf(x[i]));
+        CONTEND_EQUALITY(xi[i], cimagf(x[i]));
+    }
+
+    // multiply in place, then merge
+    liquid_vectorcf_mul_split(xr, xi, yr, yi, n, xr, xi);
+    liquid_vectorcf_merge(xr, xi, n, z);
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA(crealf(z[i]), crealf(x[i]*y[i]), 1e-5f);
+        CONTEND_DELTA(cimagf(z[i]), cimagf(x[i]*y[i]), 1e-5f);
+    }
+
+    // round trip is exact
+    liquid_vectorcf_split(y, n, zr, zi);
+    liquid_vectorcf_merge(zr, zi, n, z);
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(crealf(z[i]), crealf(y[i]));
+        CONTEND_EQUALITY(cimagf(z[i]), cimagf(y[i]));
+    }
+}